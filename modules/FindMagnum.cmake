@@ -41,10 +41,13 @@
 #  Audio                        - Audio library
 #  DebugTools                   - DebugTools library
 #  MeshTools                    - MeshTools library
+#  Particles                    - Particles library
 #  Primitives                   - Primitives library
 #  SceneGraph                   - SceneGraph library
 #  Shaders                      - Shaders library
 #  Shapes                       - Shapes library
+#  Sprites                      - Sprites library
+#  Terrain                      - Terrain library
 #  Text                         - Text library
 #  TextureTools                 - TextureTools library
 #  GlfwApplication              - GLFW application
@@ -65,8 +68,12 @@
 #  GlxContext                   - GLX context
 #  WglContext                   - WGL context
 #  OpenGLTester                 - OpenGLTester class
+#  BlockCompressionImageConverter - BC1-BC7 and ETC2 encoder plugin
+#  DdsImporter                  - DDS importer plugin
+#  KtxImporter                  - KTX importer plugin
 #  MagnumFont                   - Magnum bitmap font plugin
 #  MagnumFontConverter          - Magnum bitmap font converter plugin
+#  MeshBlobImporter             - Binary mesh blob importer plugin
 #  ObjImporter                  - OBJ importer plugin
 #  TgaImageConverter            - TGA image converter plugin
 #  TgaImporter                  - TGA importer plugin
@@ -74,6 +81,10 @@
 #  distancefieldconverter       - magnum-distancefieldconverter executable
 #  fontconverter                - magnum-fontconverter executable
 #  imageconverter               - magnum-imageconverter executable
+#  batchimageconverter          - magnum-batchimageconverter executable
+#  imagecompare                 - magnum-imagecompare executable
+#  bench                        - magnum-bench executable
+#  replay                       - magnum-replay executable
 #  info                         - magnum-info executable
 #  al-info                      - magnum-al-info executable
 #
@@ -110,6 +121,10 @@
 #  MAGNUM_BUILD_STATIC          - Defined if compiled as static libraries
 #  MAGNUM_BUILD_MULTITHREADED   - Defined if compiled in a way that allows
 #   having multiple thread-local Magnum contexts
+#  MAGNUM_BUILD_INSTRUMENTATION - Defined if compiled with instrumentation
+#   zones and counters in hot paths
+#  MAGNUM_BUILD_MATH_SIMD       - Defined if compiled with SIMD implementation
+#   of 4x4 float matrix operations
 #  MAGNUM_TARGET_GLES           - Defined if compiled for OpenGL ES
 #  MAGNUM_TARGET_GLES2          - Defined if compiled for OpenGL ES 2.0
 #  MAGNUM_TARGET_GLES3          - Defined if compiled for OpenGL ES 3.0
@@ -226,6 +241,8 @@ set(_magnumFlags
     BUILD_DEPRECATED
     BUILD_STATIC
     BUILD_MULTITHREADED
+    BUILD_INSTRUMENTATION
+    BUILD_MATH_SIMD
     TARGET_GLES
     TARGET_GLES2
     TARGET_GLES3
@@ -296,6 +313,11 @@ if(NOT TARGET Magnum::Magnum)
     set_property(TARGET Magnum::Magnum APPEND PROPERTY INTERFACE_LINK_LIBRARIES
          Corrade::Utility
          Corrade::PluginManager)
+    if(NOT CORRADE_TARGET_EMSCRIPTEN)
+        find_package(Threads)
+        set_property(TARGET Magnum::Magnum APPEND PROPERTY
+            INTERFACE_LINK_LIBRARIES ${CMAKE_THREAD_LIBS_INIT})
+    endif()
 
     # Dependent libraries and includes
     if(NOT MAGNUM_TARGET_GLES OR MAGNUM_TARGET_DESKTOP_GLES)
@@ -328,6 +350,12 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
 
     if(_component STREQUAL Shapes)
         set(_MAGNUM_${_COMPONENT}_DEPENDENCIES SceneGraph)
+    elseif(_component STREQUAL Particles)
+        set(_MAGNUM_${_COMPONENT}_DEPENDENCIES SceneGraph Shaders)
+    elseif(_component STREQUAL Sprites)
+        set(_MAGNUM_${_COMPONENT}_DEPENDENCIES SceneGraph Shaders)
+    elseif(_component STREQUAL Terrain)
+        set(_MAGNUM_${_COMPONENT}_DEPENDENCIES MeshTools)
     elseif(_component STREQUAL Text)
         set(_MAGNUM_${_COMPONENT}_DEPENDENCIES TextureTools)
     elseif(_component STREQUAL DebugTools)
@@ -356,6 +384,8 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
         set(_MAGNUM_${_COMPONENT}_DEPENDENCIES TgaImporter) # and below
     elseif(_component STREQUAL MagnumFontConverter)
         set(_MAGNUM_${_COMPONENT}_DEPENDENCIES TgaImageConverter) # and below
+    elseif(_component STREQUAL MeshBlobImporter)
+        set(_MAGNUM_${_COMPONENT}_DEPENDENCIES MeshTools)
     elseif(_component STREQUAL ObjImporter)
         set(_MAGNUM_${_COMPONENT}_DEPENDENCIES MeshTools)
     endif()
@@ -386,9 +416,9 @@ endif()
 
 # Component distinction (listing them explicitly to avoid mistakes with finding
 # components from other repositories)
-set(_MAGNUM_LIBRARY_COMPONENTS "^(Audio|DebugTools|MeshTools|Primitives|SceneGraph|Shaders|Shapes|Text|TextureTools|AndroidApplication|GlfwApplication|GlutApplication|GlxApplication|NaClApplication|Sdl2Application|XEglApplication|WindowlessCglApplication|WindowlessEglApplication|WindowlessGlxApplication|WindowlessIosApplication|WindowlessNaClApplication|WindowlessWglApplication|WindowlessWindowsEglApplication|CglContext|EglContext|GlxContext|WglContext|OpenGLTester)$")
-set(_MAGNUM_PLUGIN_COMPONENTS "^(MagnumFont|MagnumFontConverter|ObjImporter|TgaImageConverter|TgaImporter|WavAudioImporter)$")
-set(_MAGNUM_EXECUTABLE_COMPONENTS "^(distancefieldconverter|fontconverter|imageconverter|info|al-info)$")
+set(_MAGNUM_LIBRARY_COMPONENTS "^(Audio|DebugTools|MeshTools|Particles|Primitives|SceneGraph|Shaders|Shapes|Sprites|Terrain|Text|TextureTools|AndroidApplication|GlfwApplication|GlutApplication|GlxApplication|NaClApplication|Sdl2Application|XEglApplication|WindowlessCglApplication|WindowlessEglApplication|WindowlessGlxApplication|WindowlessIosApplication|WindowlessNaClApplication|WindowlessWglApplication|WindowlessWindowsEglApplication|CglContext|EglContext|GlxContext|WglContext|OpenGLTester)$")
+set(_MAGNUM_PLUGIN_COMPONENTS "^(BlockCompressionImageConverter|DdsImporter|KtxImporter|MagnumFont|MagnumFontConverter|MeshBlobImporter|ObjImporter|TgaImageConverter|TgaImporter|WavAudioImporter)$")
+set(_MAGNUM_EXECUTABLE_COMPONENTS "^(distancefieldconverter|fontconverter|imageconverter|batchimageconverter|imagecompare|bench|replay|info|al-info)$")
 
 # Find all components
 foreach(_component ${Magnum_FIND_COMPONENTS})
@@ -618,23 +648,52 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
         # MeshTools library
         elseif(_component STREQUAL MeshTools)
             set(_MAGNUM_${_COMPONENT}_INCLUDE_PATH_NAMES CompressIndices.h)
+            if(NOT CORRADE_TARGET_EMSCRIPTEN)
+                find_package(Threads)
+                set_property(TARGET Magnum::${_component} APPEND PROPERTY
+                    INTERFACE_LINK_LIBRARIES ${CMAKE_THREAD_LIBS_INIT})
+            endif()
 
         # OpenGLTester library
         elseif(_component STREQUAL OpenGLTester)
             set(_MAGNUM_${_COMPONENT}_INCLUDE_PATH_SUFFIX Magnum)
 
+        # No special setup for Particles library
+
         # Primitives library
         elseif(_component STREQUAL Primitives)
             set(_MAGNUM_${_COMPONENT}_INCLUDE_PATH_NAMES Cube.h)
 
-        # No special setup for SceneGraph library
+        # SceneGraph library
+        elseif(_component STREQUAL SceneGraph)
+            if(NOT CORRADE_TARGET_EMSCRIPTEN)
+                find_package(Threads)
+                set_property(TARGET Magnum::${_component} APPEND PROPERTY
+                    INTERFACE_LINK_LIBRARIES ${CMAKE_THREAD_LIBS_INIT})
+            endif()
+
         # No special setup for Shaders library
         # No special setup for Shapes library
+        # No special setup for Sprites library
+        # No special setup for Terrain library
         # No special setup for Text library
 
         # TextureTools library
         elseif(_component STREQUAL TextureTools)
             set(_MAGNUM_${_COMPONENT}_INCLUDE_PATH_NAMES Atlas.h)
+            if(NOT CORRADE_TARGET_EMSCRIPTEN)
+                find_package(Threads)
+                set_property(TARGET Magnum::${_component} APPEND PROPERTY
+                    INTERFACE_LINK_LIBRARIES ${CMAKE_THREAD_LIBS_INIT})
+            endif()
+
+        # BlockCompressionImageConverter plugin
+        elseif(_component STREQUAL BlockCompressionImageConverter)
+            if(NOT CORRADE_TARGET_EMSCRIPTEN)
+                find_package(Threads)
+                set_property(TARGET Magnum::${_component} APPEND PROPERTY
+                    INTERFACE_LINK_LIBRARIES ${CMAKE_THREAD_LIBS_INIT})
+            endif()
         endif()
 
         # Find library/plugin includes
@@ -62,8 +62,12 @@ cmake .. ^
     -DSDL2_INCLUDE_DIR=%APPVEYOR_BUILD_FOLDER%/SDL/include ^
     -DWITH_AUDIO=OFF ^
     -DWITH_SDL2APPLICATION=ON ^
+    -DWITH_BLOCKCOMPRESSIONIMAGECONVERTER=ON ^
+    -DWITH_DDSIMPORTER=ON ^
+    -DWITH_KTXIMPORTER=ON ^
     -DWITH_MAGNUMFONT=ON ^
     -DWITH_MAGNUMFONTCONVERTER=ON ^
+    -DWITH_MESHBLOBIMPORTER=ON ^
     -DWITH_OBJIMPORTER=ON ^
     -DWITH_TGAIMAGECONVERTER=ON ^
     -DWITH_TGAIMPORTER=ON ^
@@ -44,8 +44,12 @@ ANDROID_NDK=$TRAVIS_BUILD_DIR/android-ndk-r10e cmake .. \
     -DWITH_AUDIO=OFF \
     -DWITH_ANDROIDAPPLICATION=ON \
     -DWITH_EGLCONTEXT=ON \
+    -DWITH_BLOCKCOMPRESSIONIMAGECONVERTER=ON \
+    -DWITH_DDSIMPORTER=ON \
+    -DWITH_KTXIMPORTER=ON \
     -DWITH_MAGNUMFONT=ON \
     -DWITH_MAGNUMFONTCONVERTER=ON \
+    -DWITH_MESHBLOBIMPORTER=ON \
     -DWITH_OBJIMPORTER=ON \
     -DWITH_TGAIMAGECONVERTER=ON \
     -DWITH_TGAIMPORTER=ON \
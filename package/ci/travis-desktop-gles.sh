@@ -26,8 +26,12 @@ cmake .. \
     -DWITH_WINDOWLESS${PLATFORM_GL_API}APPLICATION=ON \
     -DWITH_${PLATFORM_GL_API}CONTEXT=ON \
     -DWITH_OPENGLTESTER=ON \
+    -DWITH_BLOCKCOMPRESSIONIMAGECONVERTER=ON \
+    -DWITH_DDSIMPORTER=ON \
+    -DWITH_KTXIMPORTER=ON \
     -DWITH_MAGNUMFONT=ON \
     -DWITH_MAGNUMFONTCONVERTER=ON \
+    -DWITH_MESHBLOBIMPORTER=ON \
     -DWITH_OBJIMPORTER=ON \
     -DWITH_TGAIMAGECONVERTER=ON \
     -DWITH_TGAIMPORTER=ON \
@@ -48,8 +48,12 @@ cmake .. \
     -DWITH_WINDOWLESSIOSAPPLICATION=ON \
     -DWITH_EGLCONTEXT=ON \
     -DWITH_OPENGLTESTER=ON \
+    -DWITH_BLOCKCOMPRESSIONIMAGECONVERTER=ON \
+    -DWITH_DDSIMPORTER=ON \
+    -DWITH_KTXIMPORTER=ON \
     -DWITH_MAGNUMFONT=ON \
     -DWITH_MAGNUMFONTCONVERTER=ON \
+    -DWITH_MESHBLOBIMPORTER=ON \
     -DWITH_OBJIMPORTER=ON \
     -DWITH_TGAIMAGECONVERTER=ON \
     -DWITH_TGAIMPORTER=ON \
@@ -31,6 +31,7 @@
 #ifndef MAGNUM_TARGET_WEBGL
 #include "Magnum/Implementation/DebugState.h"
 #endif
+#include "Magnum/Implementation/DeletionState.h"
 #include "Magnum/Implementation/QueryState.h"
 #include "Magnum/Implementation/State.h"
 
@@ -50,14 +51,41 @@ AbstractQuery::~AbstractQuery() {
     /* Moved out or not deleting on destruction, nothing to do */
     if(!_id || !(_flags & ObjectFlag::DeleteOnDestruction)) return;
 
+    Implementation::DeletionState& deletion = *Context::current().state().deletion;
+    if(deletion.deferred) deletion.queries.push_back(_id);
+    else deleteInternal({&_id, 1});
+}
+
+void AbstractQuery::deleteInternal(const Containers::ArrayView<const GLuint> ids) {
+    #ifndef MAGNUM_TARGET_GLES2
+    glDeleteQueries(ids.size(), ids.data());
+    #elif !defined(CORRADE_TARGET_EMSCRIPTEN)
+    glDeleteQueriesEXT(ids.size(), ids.data());
+    #else
+    static_cast<void>(ids);
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+    #endif
+}
+
+ObjectFlags AbstractQuery::createInternal(const GLenum target, const Containers::ArrayView<GLuint> ids) {
+    #ifndef MAGNUM_TARGET_GLES
+    if(Context::current().state().query->createImplementation == &AbstractQuery::createImplementationDSA) {
+        glCreateQueries(target, ids.size(), ids.data());
+        return ObjectFlag::DeleteOnDestruction|ObjectFlag::Created;
+    }
+    #else
+    static_cast<void>(target);
+    #endif
+
     #ifndef MAGNUM_TARGET_GLES2
-    glDeleteQueries(1, &_id);
+    glGenQueries(ids.size(), ids.data());
     #elif !defined(CORRADE_TARGET_EMSCRIPTEN)
-    glDeleteQueriesEXT(1, &_id);
+    glGenQueriesEXT(ids.size(), ids.data());
     #else
+    static_cast<void>(ids);
     CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
     #endif
-    _flags |= ObjectFlag::Created;
+    return ObjectFlag::DeleteOnDestruction;
 }
 
 void AbstractQuery::createImplementationDefault() {
@@ -31,6 +31,7 @@
  */
 #endif
 
+#include <vector>
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Utility/Assert.h>
 
@@ -183,10 +184,25 @@ class MAGNUM_EXPORT AbstractQuery: public AbstractObject {
         void begin(GLenum target);
         #endif
 
+        /* Used by createArray() of the subclasses */
+        static ObjectFlags createInternal(GLenum target, Containers::ArrayView<GLuint> ids);
+        template<class T> static std::vector<T> createArrayInternal(std::size_t count, typename T::Target target) {
+            std::vector<GLuint> ids(count);
+            const ObjectFlags flags = createInternal(GLenum(target), {ids.data(), ids.size()});
+            std::vector<T> out;
+            out.reserve(count);
+            for(GLuint id: ids) out.push_back(T::wrap(id, target, flags));
+            return out;
+        }
+
         GLuint _id;
         GLenum _target;
 
     private:
+        friend Context;
+
+        static void MAGNUM_LOCAL deleteInternal(Containers::ArrayView<const GLuint> ids);
+
         #ifndef MAGNUM_TARGET_WEBGL
         AbstractQuery& setLabelInternal(Containers::ArrayView<const char> label);
         #endif
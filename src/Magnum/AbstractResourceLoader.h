@@ -29,6 +29,7 @@
  * @brief Class @ref Magnum::AbstractResourceLoader
  */
 
+#include <atomic>
 #include <string>
 
 #include "Magnum/ResourceManager.h"
@@ -63,6 +64,9 @@ indicate that the resource was not found.
 You can also implement @ref doName() to provide meaningful names for resource
 keys.
 
+For loading that decodes the data on worker threads and uploads them on the
+OpenGL context thread see @ref AbstractThreadedResourceLoader.
+
 Example implementation for synchronous mesh loader:
 @code
 class MeshResourceLoader: public AbstractResourceLoader<Mesh> {
@@ -158,15 +162,16 @@ template<class T> class AbstractResourceLoader {
          *
          * Also increments count of loaded resources. Parameter @p state must
          * be either @ref ResourceDataState::Mutable or
-         * @ref ResourceDataState::Final. See @ref ResourceManager::set() for
-         * more information.
+         * @ref ResourceDataState::Final. The @p size is used only by
+         * @ref ResourcePolicy::Cached resources. See @ref ResourceManager::set()
+         * for more information.
          * @see @ref loadedCount()
          */
-        void set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy);
+        void set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy, std::size_t size = 0);
 
         /** @overload */
-        template<class U> void set(ResourceKey key, U&& data, ResourceDataState state, ResourcePolicy policy) {
-            set(key, new typename std::decay<U>::type(std::forward<U>(data)), state, policy);
+        template<class U> void set(ResourceKey key, U&& data, ResourceDataState state, ResourcePolicy policy, std::size_t size = 0) {
+            set(key, new typename std::decay<U>::type(std::forward<U>(data)), state, policy, size);
         }
 
         /**
@@ -214,7 +219,7 @@ template<class T> class AbstractResourceLoader {
 
     private:
         Implementation::ResourceManagerData<T>* manager;
-        std::size_t _requestedCount,
+        std::atomic<std::size_t> _requestedCount,
             _loadedCount,
             _notFoundCount;
 };
@@ -228,22 +233,22 @@ template<class T> std::string AbstractResourceLoader<T>::doName(ResourceKey) con
 template<class T> void AbstractResourceLoader<T>::load(ResourceKey key) {
     ++_requestedCount;
     /** @todo What policy for loading resources? */
-    manager->set(key, nullptr, ResourceDataState::Loading, ResourcePolicy::Resident);
+    manager->set(key, nullptr, ResourceDataState::Loading, ResourcePolicy::Resident, 0);
 
     doLoad(key);
 }
 
-template<class T> void AbstractResourceLoader<T>::set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy) {
+template<class T> void AbstractResourceLoader<T>::set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy, const std::size_t size) {
     CORRADE_ASSERT(state == ResourceDataState::Mutable || state == ResourceDataState::Final,
         "AbstractResourceLoader::set(): state must be either Mutable or Final", );
     ++_loadedCount;
-    manager->set(key, data, state, policy);
+    manager->set(key, data, state, policy, size);
 }
 
 template<class T> inline void AbstractResourceLoader<T>::setNotFound(ResourceKey key) {
     ++_notFoundCount;
     /** @todo What policy for notfound resources? */
-    manager->set(key, nullptr, ResourceDataState::NotFound, ResourcePolicy::Resident);
+    manager->set(key, nullptr, ResourceDataState::NotFound, ResourcePolicy::Resident, 0);
 }
 
 }
@@ -27,9 +27,14 @@
 
 #include <Corrade/Containers/Array.h>
 
+#include "Magnum/Buffer.h"
 #include "Magnum/Context.h"
 #include "Magnum/Extensions.h"
+#include "Magnum/Instrumentation.h"
 #include "Magnum/Shader.h"
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/ShaderProgramBinaryCache.h"
+#endif
 #include "Magnum/Math/RectangularMatrix.h"
 
 #ifndef MAGNUM_TARGET_WEBGL
@@ -42,6 +47,11 @@
 #include <sstream>
 #endif
 
+/* Not in flextGL headers yet */
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
 namespace Magnum {
 
 namespace Implementation {
@@ -337,16 +347,31 @@ std::pair<bool, std::string> AbstractShaderProgram::validate() {
 }
 
 #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+Vector3i AbstractShaderProgram::computeWorkGroupSize() {
+    Vector3i value;
+    glGetProgramiv(_id, GL_COMPUTE_WORK_GROUP_SIZE, value.data());
+    return value;
+}
+
 void AbstractShaderProgram::dispatchCompute(const Vector3ui& workgroupCount) {
     use();
     glDispatchCompute(workgroupCount.x(), workgroupCount.y(), workgroupCount.z());
 }
+
+void AbstractShaderProgram::dispatchComputeIndirect(Buffer& buffer, const GLintptr offset) {
+    use();
+    buffer.bindInternal(Buffer::TargetHint::DispatchIndirect);
+    glDispatchComputeIndirect(offset);
+}
 #endif
 
 void AbstractShaderProgram::use() {
     /* Use only if the program isn't already in use */
     GLuint& current = Context::current().state().shaderProgram->current;
-    if(current != _id) glUseProgram(current = _id);
+    if(current == _id) return;
+
+    MAGNUM_INSTRUMENT_COUNT(Instrumentation::Counter::ShaderSwitches, 1);
+    glUseProgram(current = _id);
 }
 
 void AbstractShaderProgram::attachShader(Shader& shader) {
@@ -400,12 +425,19 @@ void AbstractShaderProgram::transformFeedbackVaryingsImplementationDanglingWorka
 #endif
 
 bool AbstractShaderProgram::link(std::initializer_list<std::reference_wrapper<AbstractShaderProgram>> shaders) {
-    bool allSuccess = true;
+    submitLink(shaders);
+    return checkLink(shaders);
+}
 
+void AbstractShaderProgram::submitLink(std::initializer_list<std::reference_wrapper<AbstractShaderProgram>> shaders) {
     /* Invoke (possibly parallel) linking on all shaders */
     for(AbstractShaderProgram& shader: shaders) glLinkProgram(shader._id);
+}
+
+bool AbstractShaderProgram::checkLink(std::initializer_list<std::reference_wrapper<AbstractShaderProgram>> shaders) {
+    bool allSuccess = true;
 
-    /* After linking phase, check status of all shaders */
+    /* Check status of all shaders, waiting for the linking to finish */
     Int i = 1;
     for(AbstractShaderProgram& shader: shaders) {
         GLint success, logLength;
@@ -460,6 +492,80 @@ bool AbstractShaderProgram::link(std::initializer_list<std::reference_wrapper<Ab
     return allSuccess;
 }
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+std::pair<GLenum, Containers::Array<char>> AbstractShaderProgram::binary() {
+    GLint size = 0;
+    glGetProgramiv(_id, GL_PROGRAM_BINARY_LENGTH, &size);
+    if(!size) return {};
+
+    GLenum format;
+    Containers::Array<char> data{std::size_t(size)};
+    glGetProgramBinary(_id, size, nullptr, &format, data);
+    return {format, std::move(data)};
+}
+
+bool AbstractShaderProgram::setBinary(const GLenum format, const Containers::ArrayView<const void> data) {
+    glProgramBinary(_id, format, data.data(), data.size());
+
+    GLint success;
+    glGetProgramiv(_id, GL_LINK_STATUS, &success);
+    return success;
+}
+#endif
+
+bool AbstractShaderProgram::compileAndLink(const std::initializer_list<std::reference_wrapper<Shader>> shaders, const std::function<void()>& beforeLink) {
+    return submitCompileAndLink(shaders, beforeLink) || checkCompileAndLink(shaders);
+}
+
+bool AbstractShaderProgram::submitCompileAndLink(const std::initializer_list<std::reference_wrapper<Shader>> shaders, const std::function<void()>& beforeLink) {
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    /* Try to load the binary first */
+    ShaderProgramBinaryCache* const cache = ShaderProgramBinaryCache::current();
+    const bool useCache = cache && cache->isSupported();
+    if(useCache && cache->load(*this, cache->key(shaders))) return true;
+    #endif
+
+    /* Otherwise submit compilation and linking the usual way. The compile
+       status is checked only afterwards, if any shader failed to compile,
+       the linking fails too. */
+    if(!Shader::submitCompile(shaders)) return false;
+    attachShaders(shaders);
+    if(beforeLink) beforeLink();
+
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(useCache) setRetrievableBinary(true);
+    #endif
+
+    submitLink({*this});
+    return false;
+}
+
+bool AbstractShaderProgram::checkCompileAndLink(const std::initializer_list<std::reference_wrapper<Shader>> shaders) {
+    /* Check compilation first so the compiler messages are printed before
+       the (inevitable) link failure */
+    if(!Shader::checkCompile(shaders) || !checkLink({*this})) return false;
+
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    ShaderProgramBinaryCache* const cache = ShaderProgramBinaryCache::current();
+    if(cache && cache->isSupported()) cache->save(*this, cache->key(shaders));
+    #endif
+
+    return true;
+}
+
+bool AbstractShaderProgram::isLinkFinished() {
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(!Context::current().isExtensionSupported<Extensions::GL::KHR::parallel_shader_compile>())
+        return true;
+
+    GLint finished;
+    glGetProgramiv(_id, GL_COMPLETION_STATUS_KHR, &finished);
+    return finished == GL_TRUE;
+    #else
+    return true;
+    #endif
+}
+
 Int AbstractShaderProgram::uniformLocationInternal(const Containers::ArrayView<const char> name) {
     const GLint location = glGetUniformLocation(_id, name);
     if(location == -1)
@@ -848,6 +954,12 @@ void AbstractShaderProgram::uniformImplementationDSAEXT(const GLint location, co
 }
 #endif
 
+#ifndef MAGNUM_TARGET_GLES
+void AbstractShaderProgram::setUniformHandle(const Int location, const Containers::ArrayView<const UnsignedLong> handles) {
+    glProgramUniformHandleui64vARB(_id, location, handles.size(), reinterpret_cast<const GLuint64*>(handles.data()));
+}
+#endif
+
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::RectangularMatrix<2, 2, Float>> values) {
     (this->*Context::current().state().shaderProgram->uniformMatrix2fvImplementation)(location, values.size(), values);
 }
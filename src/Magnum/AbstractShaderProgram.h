@@ -484,6 +484,10 @@ class MAGNUM_EXPORT AbstractShaderProgram: public AbstractObject {
     friend MeshView;
     friend TransformFeedback;
     friend Implementation::ShaderProgramState;
+    friend CommandBuffer;
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    friend ShaderProgramBinaryCache;
+    #endif
 
     public:
         #ifndef MAGNUM_TARGET_GLES2
@@ -781,19 +785,68 @@ class MAGNUM_EXPORT AbstractShaderProgram: public AbstractObject {
          */
         std::pair<bool, std::string> validate();
 
+        /**
+         * @brief Whether linking has finished
+         *
+         * Doesn't block. If @extension{KHR,parallel_shader_compile} is not
+         * available, always returns `true`, in which case checking the link
+         * status may block until the linking finishes. Always returns `true`
+         * in WebGL. Note that this doesn't say whether the linking succeeded.
+         * @see @ref Shader::isCompileFinished(), @fn_gl{GetProgram} with
+         *      @def_gl{COMPLETION_STATUS_KHR}
+         */
+        bool isLinkFinished();
+
         #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        /**
+         * @brief Compute work group size
+         *
+         * Local work group size the linked compute shader was compiled with,
+         * i.e. the @glsl local_size_x @ce, @glsl local_size_y @ce and
+         * @glsl local_size_z @ce layout qualifiers. Useful for calculating
+         * workgroup count for @ref dispatchCompute(). Valid only on linked
+         * programs with compute shader attached.
+         * @see @ref maxComputeWorkGroupSize(), @fn_gl{GetProgram} with
+         *      @def_gl{COMPUTE_WORK_GROUP_SIZE}
+         * @requires_gl43 Extension @extension{ARB,compute_shader}
+         * @requires_gles31 Compute shaders are not available in OpenGL ES 3.0
+         *      and older.
+         * @requires_gles Compute shaders are not available in WebGL.
+         */
+        Vector3i computeWorkGroupSize();
+
         /**
          * @brief Dispatch compute
          * @param workgroupCount    Workgroup count in given dimension
          *
          * Valid only on programs with compute shader attached.
-         * @see @fn_gl{DispatchCompute}
+         * @see @ref computeWorkGroupSize(), @ref dispatchComputeIndirect(),
+         *      @ref Renderer::setMemoryBarrier(), @fn_gl{DispatchCompute}
          * @requires_gl43 Extension @extension{ARB,compute_shader}
          * @requires_gles31 Compute shaders are not available in OpenGL ES 3.0
          *      and older.
          * @requires_gles Compute shaders are not available in WebGL.
          */
         void dispatchCompute(const Vector3ui& workgroupCount);
+
+        /**
+         * @brief Dispatch compute with workgroup count taken from a buffer
+         * @param buffer    Buffer containing three @ref UnsignedInt values
+         *      with workgroup count in each dimension
+         * @param offset    Offset of the values in the buffer
+         *
+         * Useful for dispatching work produced by a previous compute shader
+         * without reading anything back to the CPU. Valid only on programs
+         * with compute shader attached.
+         * @see @ref dispatchCompute(const Vector3ui&),
+         *      @fn_gl{BindBuffer} with @def_gl{DISPATCH_INDIRECT_BUFFER},
+         *      @fn_gl{DispatchComputeIndirect}
+         * @requires_gl43 Extension @extension{ARB,compute_shader}
+         * @requires_gles31 Compute shaders are not available in OpenGL ES 3.0
+         *      and older.
+         * @requires_gles Compute shaders are not available in WebGL.
+         */
+        void dispatchComputeIndirect(Buffer& buffer, GLintptr offset = 0);
         #endif
 
         #ifdef MAGNUM_BUILD_DEPRECATED
@@ -820,6 +873,32 @@ class MAGNUM_EXPORT AbstractShaderProgram: public AbstractObject {
          */
         static bool link(std::initializer_list<std::reference_wrapper<AbstractShaderProgram>> shaders);
 
+        /**
+         * @brief Submit linking of multiple shaders
+         *
+         * Starts linking of all @p shaders, but doesn't wait for the result.
+         * Use @ref checkLink() later to get the result and print linker
+         * messages, in the meantime the driver can link the shaders in the
+         * background. Together with @ref checkLink() equivalent to
+         * @ref link(std::initializer_list<std::reference_wrapper<AbstractShaderProgram>>).
+         * @see @ref isLinkFinished(), @ref Shader::submitCompile(),
+         *      @fn_gl{LinkProgram}
+         */
+        static void submitLink(std::initializer_list<std::reference_wrapper<AbstractShaderProgram>> shaders);
+
+        /**
+         * @brief Check link status of multiple shaders
+         *
+         * Waits for linking submitted with @ref submitLink() to finish.
+         * Returns `false` if linking of any shader failed, `true` if
+         * everything succeeded. Linker message (if any) is printed to error
+         * output.
+         * @see @ref isLinkFinished(), @fn_gl{GetProgram} with
+         *      @def_gl{LINK_STATUS} and @def_gl{INFO_LOG_LENGTH},
+         *      @fn_gl{GetProgramInfoLog}
+         */
+        static bool checkLink(std::initializer_list<std::reference_wrapper<AbstractShaderProgram>> shaders);
+
         #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
         /**
          * @brief Allow retrieving program binary
@@ -834,6 +913,43 @@ class MAGNUM_EXPORT AbstractShaderProgram: public AbstractObject {
         void setRetrievableBinary(bool enabled) {
             glProgramParameteri(_id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, enabled ? GL_TRUE : GL_FALSE);
         }
+
+        /**
+         * @brief Program binary
+         *
+         * Returns binary format and binary representation of linked program.
+         * The binary can be later passed to @ref setBinary() to avoid
+         * compilation and linking, see @ref ShaderProgramBinaryCache for a
+         * convenient way to do that. It is advised to call
+         * @ref setRetrievableBinary() before linking. If the program is not
+         * linked, returns zero format and empty array.
+         * @see @fn_gl{GetProgram} with @def_gl{PROGRAM_BINARY_LENGTH},
+         *      @fn_gl{GetProgramBinary}
+         * @requires_gl41 Extension @extension{ARB,get_program_binary}
+         * @requires_gles30 Not available in OpenGL ES 2.0.
+         * @requires_gles Binary program representations are not supported in
+         *      WebGL.
+         */
+        std::pair<GLenum, Containers::Array<char>> binary();
+
+        /**
+         * @brief Set program binary
+         * @return `true` if the binary was accepted and the program is
+         *      linked, `false` otherwise
+         *
+         * Replaces compilation, attaching of shaders and linking with binary
+         * previously retrieved using @ref binary(). The driver might reject
+         * the binary e.g. after a driver update, in that case the program
+         * needs to be compiled and linked the usual way. Unlike @ref link(),
+         * no message is printed on failure.
+         * @see @fn_gl{ProgramBinary}, @fn_gl{GetProgram} with
+         *      @def_gl{LINK_STATUS}
+         * @requires_gl41 Extension @extension{ARB,get_program_binary}
+         * @requires_gles30 Not available in OpenGL ES 2.0.
+         * @requires_gles Binary program representations are not supported in
+         *      WebGL.
+         */
+        bool setBinary(GLenum format, Containers::ArrayView<const void> data);
         #endif
 
         #ifndef MAGNUM_TARGET_WEBGL
@@ -994,6 +1110,49 @@ class MAGNUM_EXPORT AbstractShaderProgram: public AbstractObject {
          */
         bool link() { return link({*this}); }
 
+        /**
+         * @brief Compile shaders, attach them and link the program
+         * @param shaders       Shaders to compile and attach
+         * @param beforeLink    Function called after the shaders are
+         *      attached and before the program is linked, e.g. for binding
+         *      attribute locations
+         * @return `true` if the program was either loaded from a cache or
+         *      successfully compiled and linked, `false` otherwise
+         *
+         * Equivalent to calling @ref Shader::compile() on @p shaders,
+         * @ref attachShaders(), @p beforeLink and @ref link(). If there is a
+         * current @ref ShaderProgramBinaryCache and it contains a matching
+         * binary, the binary is loaded instead and neither the shaders are
+         * compiled nor @p beforeLink is called. Otherwise the binary of the
+         * newly linked program is saved to the cache.
+         * @see @ref ShaderProgramBinaryCache::current()
+         */
+        bool compileAndLink(std::initializer_list<std::reference_wrapper<Shader>> shaders, const std::function<void()>& beforeLink = {});
+
+        /**
+         * @brief Submit compilation and linking of the program
+         * @return `true` if the program was loaded from a cache and is
+         *      ready, `false` if compilation and linking was submitted
+         *
+         * Like @ref compileAndLink(), but uses @ref Shader::submitCompile()
+         * and @ref submitLink() so the driver can do the work in the
+         * background. If this function returns `false`, call
+         * @ref checkCompileAndLink() with the same @p shaders before using
+         * the program. The shaders need to be kept alive until then.
+         */
+        bool submitCompileAndLink(std::initializer_list<std::reference_wrapper<Shader>> shaders, const std::function<void()>& beforeLink = {});
+
+        /**
+         * @brief Check compilation and link status of the program
+         * @return `true` if all shaders compiled and the program linked
+         *      successfully, `false` otherwise
+         *
+         * Finishes work started with @ref submitCompileAndLink(), printing
+         * compiler and linker messages, if any. If there is a current
+         * @ref ShaderProgramBinaryCache, the binary is saved to it.
+         */
+        bool checkCompileAndLink(std::initializer_list<std::reference_wrapper<Shader>> shaders);
+
         /**
          * @brief Get uniform location
          * @param name          Uniform name
@@ -1164,6 +1323,30 @@ class MAGNUM_EXPORT AbstractShaderProgram: public AbstractObject {
         void setUniform(Int location, Containers::ArrayView<const Math::RectangularMatrix<4, 3, Double>> values); /**< @overload */
         #endif
 
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Set bindless texture handle uniform
+         * @param location      Uniform location
+         * @param handle        Texture handle
+         *
+         * Sets a sampler uniform to a handle returned from
+         * @ref AbstractTexture::handle() "*Texture::handle()" instead of a
+         * texture unit. The texture has to be made resident using
+         * @ref AbstractTexture::makeResident() "*Texture::makeResident()"
+         * before drawing. The shader doesn't need to be marked for use.
+         * @see @fn_gl_extension{ProgramUniformHandle,ARB,bindless_texture}
+         * @requires_extension Extension @extension{ARB,bindless_texture}
+         * @requires_gl Bindless textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        void setUniformHandle(Int location, UnsignedLong handle) {
+            setUniformHandle(location, {&handle, 1});
+        }
+
+        /** @overload */
+        void setUniformHandle(Int location, Containers::ArrayView<const UnsignedLong> handles);
+        #endif
+
         #ifdef MAGNUM_BUILD_DEPRECATED
         /**
          * @brief Set uniform values
@@ -34,6 +34,7 @@
 #include "Magnum/Context.h"
 #include "Magnum/Extensions.h"
 #include "Magnum/Image.h"
+#include "Magnum/Instrumentation.h"
 #include "Magnum/PixelFormat.h"
 #include "Magnum/TextureFormat.h"
 #include "Magnum/Math/Color.h"
@@ -42,6 +43,8 @@
 #ifndef MAGNUM_TARGET_WEBGL
 #include "Implementation/DebugState.h"
 #endif
+#include "Implementation/DeletionState.h"
+#include "Implementation/MemoryState.h"
 #include "Implementation/State.h"
 #include "Implementation/TextureState.h"
 
@@ -162,6 +165,8 @@ void AbstractTexture::unbind(const Int firstTextureUnit, const std::size_t count
 
 /** @todoc const std::initializer_list makes Doxygen grumpy */
 void AbstractTexture::bind(const Int firstTextureUnit, std::initializer_list<AbstractTexture*> textures) {
+    MAGNUM_INSTRUMENT_ZONE(Instrumentation::Zone::TextureBind);
+
     /* State tracker is updated in the implementations */
     Context::current().state().texture->bindMultiImplementation(firstTextureUnit, {textures.begin(), textures.size()});
 }
@@ -191,6 +196,7 @@ void AbstractTexture::bindImplementationMulti(const GLint firstTextureUnit, Cont
         if(textureState.bindings[firstTextureUnit + i].second != id) {
             different = true;
             textureState.bindings[firstTextureUnit + i].second = id;
+            if(id) MAGNUM_INSTRUMENT_COUNT(Instrumentation::Counter::TextureBinds, 1);
         }
     }
 
@@ -216,7 +222,11 @@ Int AbstractTexture::compressedBlockDataSizeImplementationBitsWorkaround(const G
 }
 #endif
 
-AbstractTexture::AbstractTexture(GLenum target): _target{target}, _flags{ObjectFlag::DeleteOnDestruction} {
+AbstractTexture::AbstractTexture(GLenum target): _target{target}, _flags{ObjectFlag::DeleteOnDestruction}
+    #ifndef MAGNUM_TARGET_GLES
+    , _handle{}, _resident{}
+    #endif
+{
     (this->*Context::current().state().texture->createImplementation)();
     CORRADE_INTERNAL_ASSERT(_id != Implementation::State::DisengagedBinding);
 }
@@ -232,27 +242,60 @@ void AbstractTexture::createImplementationDSA() {
 }
 #endif
 
+ObjectFlags AbstractTexture::createInternal(const GLenum target, const Containers::ArrayView<GLuint> ids) {
+    #ifndef MAGNUM_TARGET_GLES
+    if(Context::current().state().texture->createImplementation == &AbstractTexture::createImplementationDSA) {
+        glCreateTextures(target, ids.size(), ids.data());
+        return ObjectFlag::DeleteOnDestruction|ObjectFlag::Created;
+    }
+    #else
+    static_cast<void>(target);
+    #endif
+
+    glGenTextures(ids.size(), ids.data());
+    return ObjectFlag::DeleteOnDestruction;
+}
+
 AbstractTexture::~AbstractTexture() {
     /* Moved out or not deleting on destruction, nothing to do */
     if(!_id || !(_flags & ObjectFlag::DeleteOnDestruction)) return;
 
-    /* Remove all bindings */
-    for(auto& binding: Context::current().state().texture->bindings) {
-        /* MSVC 2015 needs the parentheses around */
-        /* libstdc++ since GCC 6.3 can't handle just = {} (ambiguous overload
-           of operator=) */
-        if(binding.second == _id) binding = std::pair<GLenum, GLuint>{};
-    }
+    /* The handle is known only to this instance, so it has to be made
+       non-resident right away even if the deletion is deferred */
+    #ifndef MAGNUM_TARGET_GLES
+    if(_resident) glMakeTextureHandleNonResidentARB(_handle);
+    #endif
+
+    Implementation::DeletionState& deletion = *Context::current().state().deletion;
+    if(deletion.deferred) deletion.textures.push_back(_id);
+    else deleteInternal({&_id, 1});
+}
+
+void AbstractTexture::deleteInternal(const Containers::ArrayView<const GLuint> ids) {
+    Implementation::TextureState& state = *Context::current().state().texture;
+    Implementation::MemoryState& memory = *Context::current().state().memory;
+
+    for(const GLuint id: ids) {
+        /* Remove all bindings */
+        for(auto& binding: state.bindings) {
+            /* MSVC 2015 needs the parentheses around */
+            /* libstdc++ since GCC 6.3 can't handle just = {} (ambiguous
+               overload of operator=) */
+            if(binding.second == id) binding = std::pair<GLenum, GLuint>{};
+        }
 
-    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
-    /* Remove all image bindings */
-    for(auto& binding: Context::current().state().texture->imageBindings) {
-        /* MSVC 2015 needs the parentheses around */
-        if(std::get<0>(binding) == _id) binding = {};
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        /* Remove all image bindings */
+        for(auto& binding: state.imageBindings) {
+            /* MSVC 2015 needs the parentheses around */
+            if(std::get<0>(binding) == id) binding = {};
+        }
+        #endif
+
+        memory.remove(Implementation::MemoryState::Type::Texture, id);
     }
-    #endif
 
-    glDeleteTextures(1, &_id);
+    glDeleteTextures(ids.size(), ids.data());
 }
 
 void AbstractTexture::createIfNotAlready() {
@@ -276,6 +319,7 @@ std::string AbstractTexture::label() {
 AbstractTexture& AbstractTexture::setLabelInternal(const Containers::ArrayView<const char> label) {
     createIfNotAlready();
     Context::current().state().debug->labelImplementation(GL_TEXTURE, _id, label);
+    Context::current().state().memory->setLabel(Implementation::MemoryState::Type::Texture, _id, label);
     return *this;
 }
 #endif
@@ -342,11 +386,40 @@ void AbstractTexture::bind(Int textureUnit) {
     /* If already bound in given texture unit, nothing to do */
     if(textureState.bindings[textureUnit].second == _id) return;
 
+    MAGNUM_INSTRUMENT_ZONE(Instrumentation::Zone::TextureBind);
+    MAGNUM_INSTRUMENT_COUNT(Instrumentation::Counter::TextureBinds, 1);
+
     /* Update state tracker, bind the texture to the unit */
     textureState.bindings[textureUnit] = {_target, _id};
     (this->*textureState.bindImplementation)(textureUnit);
 }
 
+#ifndef MAGNUM_TARGET_GLES
+UnsignedLong AbstractTexture::handle() {
+    if(!_handle) {
+        /* The texture has to exist */
+        createIfNotAlready();
+        _handle = glGetTextureHandleARB(_id);
+    }
+
+    return _handle;
+}
+
+void AbstractTexture::makeResident() {
+    if(_resident) return;
+
+    glMakeTextureHandleResidentARB(handle());
+    _resident = true;
+}
+
+void AbstractTexture::makeNonResident() {
+    if(!_resident) return;
+
+    glMakeTextureHandleNonResidentARB(_handle);
+    _resident = false;
+}
+#endif
+
 void AbstractTexture::bindImplementationDefault(GLint textureUnit) {
     Implementation::TextureState& textureState = *Context::current().state().texture;
 
@@ -512,6 +585,32 @@ void AbstractTexture::generateMipmap() {
     (this->*Context::current().state().texture->mipmapImplementation)();
 }
 
+#ifndef MAGNUM_TARGET_GLES
+Int AbstractTexture::pageSizeCount(const GLenum target, const TextureFormat format) {
+    GLint value;
+    glGetInternalformativ(target, GLenum(format), GL_NUM_VIRTUAL_PAGE_SIZES_ARB, 1, &value);
+    return value;
+}
+
+void AbstractTexture::setSparse(const bool enabled) {
+    (this->*Context::current().state().texture->parameteriImplementation)(GL_TEXTURE_SPARSE_ARB, enabled ? GL_TRUE : GL_FALSE);
+}
+
+void AbstractTexture::setVirtualPageSizeIndex(const Int index) {
+    (this->*Context::current().state().texture->parameteriImplementation)(GL_VIRTUAL_PAGE_SIZE_INDEX_ARB, index);
+}
+
+Int AbstractTexture::sparseLevelCount() {
+    GLint value = 0;
+    (this->*Context::current().state().texture->getParameterivImplementation)(GL_NUM_SPARSE_LEVELS_ARB, &value);
+    return value;
+}
+
+void AbstractTexture::commitPagesInternal(const GLint level, const Vector3i& offset, const Vector3i& size, const bool commit) {
+    (this->*Context::current().state().texture->pageCommitmentImplementation)(level, offset, size, commit ? GL_TRUE : GL_FALSE);
+}
+#endif
+
 void AbstractTexture::mipmapImplementationDefault() {
     bindInternal();
     glGenerateMipmap(_target);
@@ -1192,6 +1291,30 @@ void AbstractTexture::getLevelParameterImplementationDSAEXT(const GLint level, c
     _flags |= ObjectFlag::Created;
     glGetTextureLevelParameterivEXT(_id, _target, level, parameter, values);
 }
+
+void AbstractTexture::getParameterImplementationDefault(const GLenum parameter, GLint* const values) {
+    bindInternal();
+    glGetTexParameteriv(_target, parameter, values);
+}
+
+void AbstractTexture::getParameterImplementationDSA(const GLenum parameter, GLint* const values) {
+    glGetTextureParameteriv(_id, parameter, values);
+}
+
+void AbstractTexture::getParameterImplementationDSAEXT(const GLenum parameter, GLint* const values) {
+    _flags |= ObjectFlag::Created;
+    glGetTextureParameterivEXT(_id, _target, parameter, values);
+}
+
+void AbstractTexture::pageCommitmentImplementationDefault(const GLint level, const Vector3i& offset, const Vector3i& size, const GLboolean commit) {
+    bindInternal();
+    glTexPageCommitmentARB(_target, level, offset.x(), offset.y(), offset.z(), size.x(), size.y(), size.z(), commit);
+}
+
+void AbstractTexture::pageCommitmentImplementationDSAEXT(const GLint level, const Vector3i& offset, const Vector3i& size, const GLboolean commit) {
+    _flags |= ObjectFlag::Created;
+    glTexturePageCommitmentEXT(_id, level, offset.x(), offset.y(), offset.z(), size.x(), size.y(), size.z(), commit);
+}
 #endif
 #endif
 
@@ -1929,6 +2052,26 @@ Vector3i AbstractTexture::DataHelper<3>::compressedBlockSize(const GLenum target
     /** @todo use real value when OpenGL has proper queries for 3D compression formats */
     return Vector3i{DataHelper<2>::compressedBlockSize(target, format), 1};
 }
+
+Math::Vector<1, GLint> AbstractTexture::DataHelper<1>::pageSize(const GLenum target, const TextureFormat format, const Int index) {
+    return Math::Vector<1, GLint>::pad(DataHelper<3>::pageSize(target, format, index));
+}
+
+Vector2i AbstractTexture::DataHelper<2>::pageSize(const GLenum target, const TextureFormat format, const Int index) {
+    return DataHelper<3>::pageSize(target, format, index).xy();
+}
+
+Vector3i AbstractTexture::DataHelper<3>::pageSize(const GLenum target, const TextureFormat format, const Int index) {
+    const Int count = pageSizeCount(target, format);
+    CORRADE_ASSERT(index < count,
+        "Texture::pageSize(): index" << index << "out of range for" << count << "page sizes", {});
+
+    Containers::Array<GLint> x{std::size_t(count)}, y{std::size_t(count)}, z{std::size_t(count)};
+    glGetInternalformativ(target, GLenum(format), GL_VIRTUAL_PAGE_SIZE_X_ARB, count, x);
+    glGetInternalformativ(target, GLenum(format), GL_VIRTUAL_PAGE_SIZE_Y_ARB, count, y);
+    glGetInternalformativ(target, GLenum(format), GL_VIRTUAL_PAGE_SIZE_Z_ARB, count, z);
+    return {x[index], y[index], z[index]};
+}
 #endif
 
 #ifndef MAGNUM_TARGET_GLES
@@ -1960,29 +2103,70 @@ Vector3i AbstractTexture::DataHelper<3>::imageSize(AbstractTexture& texture, con
 }
 #endif
 
+namespace {
+
+/* Array textures are not scaled in the "layer" dimension */
+bool isLayered(const GLenum target) {
+    #ifndef MAGNUM_TARGET_GLES
+    if(target == GL_TEXTURE_1D_ARRAY || target == GL_TEXTURE_CUBE_MAP_ARRAY)
+        return true;
+    #endif
+    #ifndef MAGNUM_TARGET_GLES2
+    if(target == GL_TEXTURE_2D_ARRAY) return true;
+    #endif
+    static_cast<void>(target);
+    return false;
+}
+
+/* Estimated size of all levels of an immutable storage */
+template<UnsignedInt dimensions> std::size_t storageDataSize(const GLenum target, const GLsizei levels, const TextureFormat internalFormat, const Math::Vector<dimensions, GLsizei>& size) {
+    const bool layered = isLayered(target);
+    std::size_t dataSize = 0;
+    for(GLsizei level = 0; level != levels; ++level) {
+        Math::Vector<dimensions, GLsizei> levelSize = Math::max(Math::Vector<dimensions, GLsizei>(1), size >> level);
+        if(layered) levelSize[dimensions - 1] = size[dimensions - 1];
+        dataSize += Implementation::textureFormatDataSize(internalFormat, levelSize.product());
+    }
+
+    return target == GL_TEXTURE_CUBE_MAP ? dataSize*6 : dataSize;
+}
+
+/* Each level of each cube map face is tracked separately */
+void setImageMemory(AbstractTexture& texture, const GLenum target, const GLint level, const std::size_t size) {
+    const std::size_t face = target >= GL_TEXTURE_CUBE_MAP_POSITIVE_X && target <= GL_TEXTURE_CUBE_MAP_NEGATIVE_Z ? target - GL_TEXTURE_CUBE_MAP_POSITIVE_X : 0;
+    Context::current().state().memory->setPartSize(Implementation::MemoryState::Type::Texture, texture.id(), level*6 + face, size);
+}
+
+}
+
 #ifndef MAGNUM_TARGET_GLES
 void AbstractTexture::DataHelper<1>::setStorage(AbstractTexture& texture, const GLsizei levels, const TextureFormat internalFormat, const Math::Vector< 1, GLsizei >& size) {
     (texture.*Context::current().state().texture->storage1DImplementation)(levels, internalFormat, size);
+    Context::current().state().memory->setSize(Implementation::MemoryState::Type::Texture, texture._id, storageDataSize<1>(texture._target, levels, internalFormat, size));
 }
 #endif
 
 void AbstractTexture::DataHelper<2>::setStorage(AbstractTexture& texture, const GLsizei levels, const TextureFormat internalFormat, const Vector2i& size) {
     (texture.*Context::current().state().texture->storage2DImplementation)(levels, internalFormat, size);
+    Context::current().state().memory->setSize(Implementation::MemoryState::Type::Texture, texture._id, storageDataSize<2>(texture._target, levels, internalFormat, size));
 }
 
 #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
 void AbstractTexture::DataHelper<3>::setStorage(AbstractTexture& texture, const GLsizei levels, const TextureFormat internalFormat, const Vector3i& size) {
     (texture.*Context::current().state().texture->storage3DImplementation)(levels, internalFormat, size);
+    Context::current().state().memory->setSize(Implementation::MemoryState::Type::Texture, texture._id, storageDataSize<3>(texture._target, levels, internalFormat, size));
 }
 #endif
 
 #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
 void AbstractTexture::DataHelper<2>::setStorageMultisample(AbstractTexture& texture, const GLsizei samples, const TextureFormat internalFormat, const Vector2i& size, const GLboolean fixedSampleLocations) {
     (texture.*Context::current().state().texture->storage2DMultisampleImplementation)(samples, internalFormat, size, fixedSampleLocations);
+    Context::current().state().memory->setSize(Implementation::MemoryState::Type::Texture, texture._id, Implementation::textureFormatDataSize(internalFormat, size.product()*samples));
 }
 
 void AbstractTexture::DataHelper<3>::setStorageMultisample(AbstractTexture& texture, const GLsizei samples, const TextureFormat internalFormat, const Vector3i& size, const GLboolean fixedSampleLocations) {
     (texture.*Context::current().state().texture->storage3DMultisampleImplementation)(samples, internalFormat, size, fixedSampleLocations);
+    Context::current().state().memory->setSize(Implementation::MemoryState::Type::Texture, texture._id, Implementation::textureFormatDataSize(internalFormat, size.product()*samples));
 }
 #endif
 
@@ -1992,6 +2176,7 @@ void AbstractTexture::DataHelper<1>::setImage(AbstractTexture& texture, const GL
     image.storage().applyUnpack();
     texture.bindInternal();
     glTexImage1D(texture._target, level, GLint(internalFormat), image.size()[0], 0, GLenum(image.format()), GLenum(image.type()), image.data());
+    setImageMemory(texture, texture._target, level, Implementation::textureFormatDataSize(internalFormat, image.size().product()));
 }
 
 void AbstractTexture::DataHelper<1>::setCompressedImage(AbstractTexture& texture, const GLint level, const CompressedImageView1D& image) {
@@ -1999,6 +2184,7 @@ void AbstractTexture::DataHelper<1>::setCompressedImage(AbstractTexture& texture
     image.storage().applyUnpack();
     texture.bindInternal();
     glCompressedTexImage1D(texture._target, level, GLenum(image.format()), image.size()[0], 0, Implementation::occupiedCompressedImageDataSize(image, image.data().size()), image.data());
+    setImageMemory(texture, texture._target, level, image.data().size());
 }
 
 void AbstractTexture::DataHelper<1>::setImage(AbstractTexture& texture, const GLint level, const TextureFormat internalFormat, BufferImage1D& image) {
@@ -2006,6 +2192,7 @@ void AbstractTexture::DataHelper<1>::setImage(AbstractTexture& texture, const GL
     image.storage().applyUnpack();
     texture.bindInternal();
     glTexImage1D(texture._target, level, GLint(internalFormat), image.size()[0], 0, GLenum(image.format()), GLenum(image.type()), nullptr);
+    setImageMemory(texture, texture._target, level, Implementation::textureFormatDataSize(internalFormat, image.size().product()));
 }
 
 void AbstractTexture::DataHelper<1>::setCompressedImage(AbstractTexture& texture, const GLint level, CompressedBufferImage1D& image) {
@@ -2013,6 +2200,7 @@ void AbstractTexture::DataHelper<1>::setCompressedImage(AbstractTexture& texture
     image.storage().applyUnpack();
     texture.bindInternal();
     glCompressedTexImage1D(texture._target, level, GLenum(image.format()), image.size()[0], 0, Implementation::occupiedCompressedImageDataSize(image, image.dataSize()), nullptr);
+    setImageMemory(texture, texture._target, level, image.dataSize());
 }
 
 void AbstractTexture::DataHelper<1>::setSubImage(AbstractTexture& texture, const GLint level, const Math::Vector<1, GLint>& offset, const ImageView1D& image) {
@@ -2050,6 +2238,7 @@ void AbstractTexture::DataHelper<2>::setImage(AbstractTexture& texture, const GL
         + Implementation::pixelStorageSkipOffset(image)
         #endif
         , image.storage());
+    setImageMemory(texture, target, level, Implementation::textureFormatDataSize(internalFormat, image.size().product()));
 }
 
 void AbstractTexture::DataHelper<2>::setCompressedImage(AbstractTexture& texture, const GLenum target, const GLint level, const CompressedImageView2D& image) {
@@ -2063,6 +2252,7 @@ void AbstractTexture::DataHelper<2>::setCompressedImage(AbstractTexture& texture
     #endif
     texture.bindInternal();
     glCompressedTexImage2D(target, level, GLenum(image.format()), image.size().x(), image.size().y(), 0, Implementation::occupiedCompressedImageDataSize(image, image.data().size()), image.data());
+    setImageMemory(texture, target, level, image.data().size());
 }
 
 #ifndef MAGNUM_TARGET_GLES2
@@ -2071,6 +2261,7 @@ void AbstractTexture::DataHelper<2>::setImage(AbstractTexture& texture, const GL
     image.storage().applyUnpack();
     texture.bindInternal();
     glTexImage2D(target, level, GLint(internalFormat), image.size().x(), image.size().y(), 0, GLenum(image.format()), GLenum(image.type()), nullptr);
+    setImageMemory(texture, target, level, Implementation::textureFormatDataSize(internalFormat, image.size().product()));
 }
 
 void AbstractTexture::DataHelper<2>::setCompressedImage(AbstractTexture& texture, const GLenum target, const GLint level, CompressedBufferImage2D& image) {
@@ -2082,6 +2273,7 @@ void AbstractTexture::DataHelper<2>::setCompressedImage(AbstractTexture& texture
     #endif
     texture.bindInternal();
     glCompressedTexImage2D(target, level, GLenum(image.format()), image.size().x(), image.size().y(), 0, Implementation::occupiedCompressedImageDataSize(image, image.dataSize()), nullptr);
+    setImageMemory(texture, target, level, image.dataSize());
 }
 #endif
 
@@ -2125,6 +2317,10 @@ void AbstractTexture::DataHelper<2>::setCompressedSubImage(AbstractTexture& text
     #endif
     (texture.*Context::current().state().texture->compressedSubImage2DImplementation)(level, offset, image.size(), image.format(), nullptr, Implementation::occupiedCompressedImageDataSize(image, image.dataSize()));
 }
+
+void AbstractTexture::DataHelper<2>::setSubImageFromBoundBuffer(AbstractTexture& texture, const GLint level, const Vector2i& offset, const Vector2i& size, const PixelFormat format, const PixelType type, const PixelStorage& storage, const GLintptr bufferOffset) {
+    (texture.*Context::current().state().texture->subImage2DImplementation)(level, offset, size, format, type, reinterpret_cast<const GLvoid*>(bufferOffset), storage);
+}
 #endif
 
 #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
@@ -2138,6 +2334,7 @@ void AbstractTexture::DataHelper<3>::setImage(AbstractTexture& texture, const GL
         + Implementation::pixelStorageSkipOffset(image)
         #endif
         , image.storage());
+    setImageMemory(texture, texture._target, level, Implementation::textureFormatDataSize(internalFormat, image.size().product()));
 }
 
 void AbstractTexture::DataHelper<3>::setCompressedImage(AbstractTexture& texture, const GLint level, const CompressedImageView3D& image) {
@@ -2150,6 +2347,7 @@ void AbstractTexture::DataHelper<3>::setCompressedImage(AbstractTexture& texture
     image.storage().applyUnpack();
     #endif
     texture.bindInternal();
+    setImageMemory(texture, texture._target, level, image.data().size());
     #ifndef MAGNUM_TARGET_GLES2
     glCompressedTexImage3D(texture._target, level, GLenum(image.format()), image.size().x(), image.size().y(), image.size().z(), 0, Implementation::occupiedCompressedImageDataSize(image, image.data().size()), image.data());
     #elif !defined(CORRADE_TARGET_NACL)
@@ -2168,6 +2366,7 @@ void AbstractTexture::DataHelper<3>::setImage(AbstractTexture& texture, const GL
     image.storage().applyUnpack();
     texture.bindInternal();
     glTexImage3D(texture._target, level, GLint(internalFormat), image.size().x(), image.size().y(), image.size().z(), 0, GLenum(image.format()), GLenum(image.type()), nullptr);
+    setImageMemory(texture, texture._target, level, Implementation::textureFormatDataSize(internalFormat, image.size().product()));
 }
 
 void AbstractTexture::DataHelper<3>::setCompressedImage(AbstractTexture& texture, const GLint level, CompressedBufferImage3D& image) {
@@ -2179,6 +2378,7 @@ void AbstractTexture::DataHelper<3>::setCompressedImage(AbstractTexture& texture
     #endif
     texture.bindInternal();
     glCompressedTexImage3D(texture._target, level, GLenum(image.format()), image.size().x(), image.size().y(), image.size().z(), 0, Implementation::occupiedCompressedImageDataSize(image, image.dataSize()), nullptr);
+    setImageMemory(texture, texture._target, level, image.dataSize());
 }
 #endif
 
@@ -2224,6 +2424,10 @@ void AbstractTexture::DataHelper<3>::setCompressedSubImage(AbstractTexture& text
     #endif
     (texture.*Context::current().state().texture->compressedSubImage3DImplementation)(level, offset, image.size(), image.format(), nullptr, Implementation::occupiedCompressedImageDataSize(image, image.dataSize()));
 }
+
+void AbstractTexture::DataHelper<3>::setSubImageFromBoundBuffer(AbstractTexture& texture, const GLint level, const Vector3i& offset, const Vector3i& size, const PixelFormat format, const PixelType type, const PixelStorage& storage, const GLintptr bufferOffset) {
+    (texture.*Context::current().state().texture->subImage3DImplementation)(level, offset, size, format, type, reinterpret_cast<const GLvoid*>(bufferOffset), storage);
+}
 #endif
 
 #ifndef MAGNUM_TARGET_GLES
@@ -2240,6 +2444,20 @@ void AbstractTexture::DataHelper<3>::invalidateSubImage(AbstractTexture& texture
     (texture.*Context::current().state().texture->invalidateSubImageImplementation)(level, offset, size);
 }
 
+#ifndef MAGNUM_TARGET_GLES
+void AbstractTexture::DataHelper<1>::commitPages(AbstractTexture& texture, const GLint level, const Math::Vector<1, GLint>& offset, const Math::Vector<1, GLint>& size, const bool commit) {
+    texture.commitPagesInternal(level, {offset[0], 0, 0}, {size[0], 1, 1}, commit);
+}
+
+void AbstractTexture::DataHelper<2>::commitPages(AbstractTexture& texture, const GLint level, const Vector2i& offset, const Vector2i& size, const bool commit) {
+    texture.commitPagesInternal(level, {offset, 0}, {size, 1}, commit);
+}
+
+void AbstractTexture::DataHelper<3>::commitPages(AbstractTexture& texture, const GLint level, const Vector3i& offset, const Vector3i& size, const bool commit) {
+    texture.commitPagesInternal(level, offset, size, commit);
+}
+#endif
+
 #ifndef MAGNUM_TARGET_GLES
 void AbstractTexture::DataHelper<1>::setWrapping(AbstractTexture& texture, const Array1D<Sampler::Wrapping>& wrapping) {
     (texture.*Context::current().state().texture->parameteriImplementation)(GL_TEXTURE_WRAP_S, GLint(wrapping.x()));
@@ -134,6 +134,7 @@ functions do nothing.
 class MAGNUM_EXPORT AbstractTexture: public AbstractObject {
     friend Implementation::TextureState;
     friend AbstractFramebuffer;
+    friend Context;
     friend CubeMapTexture;
 
     public:
@@ -310,7 +311,9 @@ class MAGNUM_EXPORT AbstractTexture: public AbstractObject {
         /**
          * @brief Destructor
          *
-         * Deletes associated OpenGL texture.
+         * Deletes associated OpenGL texture. If
+         * @ref Context::setDeletionDeferred() "deferred deletion" is
+         * enabled, the object is only queued for deletion.
          * @see @ref BufferTexture::wrap(), @ref CubeMapTexture::wrap(),
          *      @ref CubeMapTextureArray::wrap(),
          *      @ref MultisampleTexture::wrap(), @ref RectangleTexture::wrap(),
@@ -398,6 +401,64 @@ class MAGNUM_EXPORT AbstractTexture: public AbstractObject {
          */
         void bind(Int textureUnit);
 
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Bindless texture handle
+         *
+         * Creates the handle on first call, repeated calls return the cached
+         * value. Once the handle is created, texture parameters and storage
+         * can't be changed anymore. The handle has to be made resident using
+         * @ref makeResident() before it's used by a shader. Pass it to the
+         * shader using @ref AbstractShaderProgram::setUniformHandle() or
+         * through a uniform buffer instead of binding the texture to a texture
+         * unit --- switching between textures then doesn't cost any binds.
+         * @see @fn_gl_extension{GetTextureHandle,ARB,bindless_texture}
+         * @requires_extension Extension @extension{ARB,bindless_texture}
+         * @requires_gl Bindless textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        UnsignedLong handle();
+
+        /**
+         * @brief Whether the bindless texture handle is resident
+         *
+         * The value is tracked internally, no OpenGL call is made. Returns
+         * `false` if @ref makeResident() wasn't called yet.
+         * @see @ref makeNonResident()
+         * @requires_extension Extension @extension{ARB,bindless_texture}
+         * @requires_gl Bindless textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        bool isResident() const { return _resident; }
+
+        /**
+         * @brief Make the bindless texture handle resident
+         *
+         * Creates the handle using @ref handle(), if not already, and makes it
+         * accessible to shaders. If the handle is already resident, the
+         * function does nothing. The handle is made non-resident
+         * automatically on destruction.
+         * @see @ref isResident(), @ref makeNonResident(),
+         *      @fn_gl_extension{MakeTextureHandleResident,ARB,bindless_texture}
+         * @requires_extension Extension @extension{ARB,bindless_texture}
+         * @requires_gl Bindless textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        void makeResident();
+
+        /**
+         * @brief Make the bindless texture handle non-resident
+         *
+         * If the handle is not resident, the function does nothing.
+         * @see @ref isResident(), @ref makeResident(),
+         *      @fn_gl_extension{MakeTextureHandleNonResident,ARB,bindless_texture}
+         * @requires_extension Extension @extension{ARB,bindless_texture}
+         * @requires_gl Bindless textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        void makeNonResident();
+        #endif
+
     #ifdef DOXYGEN_GENERATING_OUTPUT
     private:
     #else
@@ -413,9 +474,21 @@ class MAGNUM_EXPORT AbstractTexture: public AbstractObject {
         static void bindImagesInternal(Int firstImageUnit, Containers::ArrayView<AbstractTexture* const> textures);
         #endif
 
+        /* Creates multiple textures with a single call, returns flags to
+           wrap them with */
+        static ObjectFlags createInternal(GLenum target, Containers::ArrayView<GLuint> ids);
+
         explicit AbstractTexture(GLenum target);
-        explicit AbstractTexture(NoCreateT, GLenum target) noexcept: _target{target}, _id{0}, _flags{ObjectFlag::DeleteOnDestruction} {}
-        explicit AbstractTexture(GLuint id, GLenum target, ObjectFlags flags) noexcept: _target{target}, _id{id}, _flags{flags} {}
+        explicit AbstractTexture(NoCreateT, GLenum target) noexcept: _target{target}, _id{0}, _flags{ObjectFlag::DeleteOnDestruction}
+            #ifndef MAGNUM_TARGET_GLES
+            , _handle{}, _resident{}
+            #endif
+            {}
+        explicit AbstractTexture(GLuint id, GLenum target, ObjectFlags flags) noexcept: _target{target}, _id{id}, _flags{flags}
+            #ifndef MAGNUM_TARGET_GLES
+            , _handle{}, _resident{}
+            #endif
+            {}
 
         #ifndef MAGNUM_TARGET_WEBGL
         AbstractTexture& setLabelInternal(Containers::ArrayView<const char> label);
@@ -477,6 +550,14 @@ class MAGNUM_EXPORT AbstractTexture: public AbstractObject {
         void invalidateImage(Int level);
         void generateMipmap();
 
+        #ifndef MAGNUM_TARGET_GLES
+        static Int pageSizeCount(GLenum target, TextureFormat format);
+        void setSparse(bool enabled);
+        void setVirtualPageSizeIndex(Int index);
+        Int sparseLevelCount();
+        void commitPagesInternal(GLint level, const Vector3i& offset, const Vector3i& size, bool commit);
+        #endif
+
         #ifndef MAGNUM_TARGET_GLES
         template<UnsignedInt dimensions> void image(GLint level, Image<dimensions>& image);
         template<UnsignedInt dimensions> void image(GLint level, BufferImage<dimensions>& image, BufferUsage usage);
@@ -513,6 +594,10 @@ class MAGNUM_EXPORT AbstractTexture: public AbstractObject {
         void MAGNUM_LOCAL createImplementationDSA();
         #endif
 
+        /* Removes the textures from the state tracker and deletes them, used
+           by the destructor and Context::flushDeletions() */
+        static void MAGNUM_LOCAL deleteInternal(Containers::ArrayView<const GLuint> ids);
+
         #ifndef MAGNUM_TARGET_GLES
         template<UnsignedInt dimensions> std::size_t MAGNUM_LOCAL compressedSubImageSize(TextureFormat format, const Math::Vector<dimensions, Int>& size);
         #endif
@@ -557,6 +642,13 @@ class MAGNUM_EXPORT AbstractTexture: public AbstractObject {
         #ifndef MAGNUM_TARGET_GLES
         void MAGNUM_LOCAL getLevelParameterImplementationDSA(GLint level, GLenum parameter, GLint* values);
         void MAGNUM_LOCAL getLevelParameterImplementationDSAEXT(GLint level, GLenum parameter, GLint* values);
+
+        void MAGNUM_LOCAL getParameterImplementationDefault(GLenum parameter, GLint* values);
+        void MAGNUM_LOCAL getParameterImplementationDSA(GLenum parameter, GLint* values);
+        void MAGNUM_LOCAL getParameterImplementationDSAEXT(GLenum parameter, GLint* values);
+
+        void MAGNUM_LOCAL pageCommitmentImplementationDefault(GLint level, const Vector3i& offset, const Vector3i& size, GLboolean commit);
+        void MAGNUM_LOCAL pageCommitmentImplementationDSAEXT(GLint level, const Vector3i& offset, const Vector3i& size, GLboolean commit);
         #endif
         #endif
 
@@ -693,12 +785,17 @@ class MAGNUM_EXPORT AbstractTexture: public AbstractObject {
 
         GLuint _id;
         ObjectFlags _flags;
+        #ifndef MAGNUM_TARGET_GLES
+        UnsignedLong _handle;
+        bool _resident;
+        #endif
 };
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
 #ifndef MAGNUM_TARGET_GLES
 template<> struct MAGNUM_EXPORT AbstractTexture::DataHelper<1> {
     static Math::Vector<1, GLint> compressedBlockSize(GLenum target, TextureFormat format);
+    static Math::Vector<1, GLint> pageSize(GLenum target, TextureFormat format, Int index);
     static Math::Vector<1, GLint> imageSize(AbstractTexture& texture, GLint level);
 
     static void setWrapping(AbstractTexture& texture, const Array1D<Sampler::Wrapping>& wrapping);
@@ -716,11 +813,14 @@ template<> struct MAGNUM_EXPORT AbstractTexture::DataHelper<1> {
     static void setCompressedSubImage(AbstractTexture& texture, GLint level, const Math::Vector<1, GLint>& offset, CompressedBufferImage1D& image);
 
     static void invalidateSubImage(AbstractTexture& texture, GLint level, const Math::Vector<1, GLint>& offset, const Math::Vector<1, GLint>& size);
+
+    static void commitPages(AbstractTexture& texture, GLint level, const Math::Vector<1, GLint>& offset, const Math::Vector<1, GLint>& size, bool commit);
 };
 #endif
 template<> struct MAGNUM_EXPORT AbstractTexture::DataHelper<2> {
     #ifndef MAGNUM_TARGET_GLES
     static Vector2i compressedBlockSize(GLenum target, TextureFormat format);
+    static Vector2i pageSize(GLenum target, TextureFormat format, Int index);
     #endif
     #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
     static Vector2i imageSize(AbstractTexture& texture, GLint level);
@@ -758,14 +858,21 @@ template<> struct MAGNUM_EXPORT AbstractTexture::DataHelper<2> {
     #ifndef MAGNUM_TARGET_GLES2
     static void setSubImage(AbstractTexture& texture, GLint level, const Vector2i& offset, BufferImage2D& image);
     static void setCompressedSubImage(AbstractTexture& texture, GLint level, const Vector2i& offset, CompressedBufferImage2D& image);
+    /* Expects the buffer to be bound and storage applied already */
+    static void setSubImageFromBoundBuffer(AbstractTexture& texture, GLint level, const Vector2i& offset, const Vector2i& size, PixelFormat format, PixelType type, const PixelStorage& storage, GLintptr bufferOffset);
     #endif
 
     static void invalidateSubImage(AbstractTexture& texture, GLint level, const Vector2i& offset, const Vector2i& size);
+
+    #ifndef MAGNUM_TARGET_GLES
+    static void commitPages(AbstractTexture& texture, GLint level, const Vector2i& offset, const Vector2i& size, bool commit);
+    #endif
 };
 template<> struct MAGNUM_EXPORT AbstractTexture::DataHelper<3> {
     #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
     #ifndef MAGNUM_TARGET_GLES
     static Vector3i compressedBlockSize(GLenum target, TextureFormat format);
+    static Vector3i pageSize(GLenum target, TextureFormat format, Int index);
     #endif
     #ifndef MAGNUM_TARGET_GLES2
     static Vector3i imageSize(AbstractTexture& texture, GLint level);
@@ -791,15 +898,29 @@ template<> struct MAGNUM_EXPORT AbstractTexture::DataHelper<3> {
     #ifndef MAGNUM_TARGET_GLES2
     static void setSubImage(AbstractTexture& texture, GLint level, const Vector3i& offset, BufferImage3D& image);
     static void setCompressedSubImage(AbstractTexture& texture, GLint level, const Vector3i& offset, CompressedBufferImage3D& image);
+    /* Expects the buffer to be bound and storage applied already */
+    static void setSubImageFromBoundBuffer(AbstractTexture& texture, GLint level, const Vector3i& offset, const Vector3i& size, PixelFormat format, PixelType type, const PixelStorage& storage, GLintptr bufferOffset);
     #endif
     #endif
 
     static void invalidateSubImage(AbstractTexture& texture, GLint level, const Vector3i& offset, const Vector3i& size);
+
+    #ifndef MAGNUM_TARGET_GLES
+    static void commitPages(AbstractTexture& texture, GLint level, const Vector3i& offset, const Vector3i& size, bool commit);
+    #endif
 };
 #endif
 
-inline AbstractTexture::AbstractTexture(AbstractTexture&& other) noexcept: _target{other._target}, _id{other._id}, _flags{other._flags} {
+inline AbstractTexture::AbstractTexture(AbstractTexture&& other) noexcept: _target{other._target}, _id{other._id}, _flags{other._flags}
+    #ifndef MAGNUM_TARGET_GLES
+    , _handle{other._handle}, _resident{other._resident}
+    #endif
+{
     other._id = 0;
+    #ifndef MAGNUM_TARGET_GLES
+    other._handle = 0;
+    other._resident = false;
+    #endif
 }
 
 inline AbstractTexture& AbstractTexture::operator=(AbstractTexture&& other) noexcept {
@@ -807,12 +928,20 @@ inline AbstractTexture& AbstractTexture::operator=(AbstractTexture&& other) noex
     swap(_target, other._target);
     swap(_id, other._id);
     swap(_flags, other._flags);
+    #ifndef MAGNUM_TARGET_GLES
+    swap(_handle, other._handle);
+    swap(_resident, other._resident);
+    #endif
     return *this;
 }
 
 inline GLuint AbstractTexture::release() {
     const GLuint id = _id;
     _id = 0;
+    #ifndef MAGNUM_TARGET_GLES
+    _handle = 0;
+    _resident = false;
+    #endif
     return id;
 }
 
@@ -0,0 +1,267 @@
+#ifndef Magnum_AbstractThreadedResourceLoader_h
+#define Magnum_AbstractThreadedResourceLoader_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::AbstractThreadedResourceLoader
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <Corrade/configure.h>
+
+#include "Magnum/AbstractResourceLoader.h"
+#include "MagnumExternal/Optional/optional.hpp"
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+namespace Magnum {
+
+/**
+@brief Base for threaded resource loaders
+@tparam T   Resource type
+@tparam U   Intermediate decoded type, e.g. @ref Trade::ImageData2D
+
+Splits the loading into two parts. The expensive decoding, such as calling
+@ref Trade::AbstractImporter::image2D(), is done in @ref doDecode() on a fixed
+set of worker threads. The decoded data are then queued and passed to
+@ref doUpload() from @ref update(), which is meant to be called on the thread
+owning the OpenGL context once per frame. The resources stay in
+@ref ResourceState::Loading until uploaded, so requesting them never blocks.
+
+## Subclassing
+
+Implement @ref doDecode() and @ref doUpload(). The first must not touch any
+OpenGL state nor the resource manager, as it runs on worker thread, and it
+returns @ref std::nullopt if the resource was not found. The second is
+called on the thread calling @ref update() and should call @ref set() to pass
+the resource to @ref ResourceManager, just like @ref doLoad() in
+@ref AbstractResourceLoader does.
+@code
+class TextureLoader: public AbstractThreadedResourceLoader<Texture2D, Trade::ImageData2D> {
+    public:
+        ~TextureLoader() { stop(); }
+
+    private:
+        std::optional<Trade::ImageData2D> doDecode(ResourceKey key) override {
+            // Open the file in a thread-local importer, import the image...
+        }
+
+        void doUpload(ResourceKey key, Trade::ImageData2D&& image) override {
+            Texture2D texture;
+            texture.setStorage(1, TextureFormat::RGBA8, image.size())
+                .setSubImage(0, {}, image);
+            set(key, std::move(texture));
+        }
+};
+
+MyResourceManager manager;
+manager.setLoader(new TextureLoader);
+
+void MyApplication::drawEvent() {
+    // Upload at most four textures each frame
+    manager.loader<Texture2D>()->update(4);
+
+    // ...
+}
+@endcode
+
+@attention The subclass destructor has to call @ref stop() so the worker
+    threads are not calling @ref doDecode() on a partially destructed object.
+
+Using this class requires linking to the `Threads` CMake package.
+@partialsupport Not available on @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten".
+*/
+template<class T, class U> class AbstractThreadedResourceLoader: public AbstractResourceLoader<T> {
+    public:
+        /**
+         * @brief Constructor
+         * @param threadCount   Count of worker threads
+         *
+         * If @p threadCount is `0`, decoding is done on the thread calling
+         * @ref update().
+         */
+        explicit AbstractThreadedResourceLoader(std::size_t threadCount = 1);
+
+        /**
+         * @brief Destructor
+         *
+         * Calls @ref stop(), if not already.
+         */
+        ~AbstractThreadedResourceLoader();
+
+        /** @brief Count of worker threads */
+        std::size_t threadCount() const { return _threads.size(); }
+
+        /**
+         * @brief Count of resources being decoded or waiting for upload
+         *
+         * @see @ref update()
+         */
+        std::size_t pendingCount() const { return _pendingCount; }
+
+        /**
+         * @brief Upload decoded resources
+         * @param budget    Max count of resources to upload
+         * @return Count of resources uploaded or marked as not found
+         *
+         * Calls @ref doUpload() for at most @p budget decoded resources,
+         * marks resources that failed to decode as not found. Should be called
+         * on the thread owning the OpenGL context.
+         */
+        std::size_t update(std::size_t budget = ~std::size_t{});
+
+    protected:
+        /**
+         * @brief Stop worker threads
+         *
+         * Waits for the decoding that's currently in progress and joins the
+         * threads. Resources waiting for decoding are discarded.
+         */
+        void stop();
+
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    private:
+    #else
+    protected:
+    #endif
+        /**
+         * @brief Decode resource
+         *
+         * Called on a worker thread. Return @ref std::nullopt if the resource
+         * was not found.
+         */
+        virtual std::optional<U> doDecode(ResourceKey key) = 0;
+
+        /**
+         * @brief Upload decoded resource
+         *
+         * Called from @ref update(). Call @ref set() to pass the resource to
+         * the manager.
+         */
+        virtual void doUpload(ResourceKey key, U&& decoded) = 0;
+
+    private:
+        void doLoad(ResourceKey key) override final;
+
+        void work();
+
+        std::vector<std::thread> _threads;
+        std::mutex _mutex;
+        std::condition_variable _wake;
+        std::deque<ResourceKey> _requests;
+        std::deque<std::pair<ResourceKey, std::optional<U>>> _decoded;
+        std::atomic<std::size_t> _pendingCount;
+        bool _quit;
+};
+
+template<class T, class U> AbstractThreadedResourceLoader<T, U>::AbstractThreadedResourceLoader(const std::size_t threadCount): _pendingCount{}, _quit{} {
+    _threads.reserve(threadCount);
+    for(std::size_t i = 0; i != threadCount; ++i)
+        _threads.emplace_back(&AbstractThreadedResourceLoader<T, U>::work, this);
+}
+
+template<class T, class U> AbstractThreadedResourceLoader<T, U>::~AbstractThreadedResourceLoader() { stop(); }
+
+template<class T, class U> void AbstractThreadedResourceLoader<T, U>::stop() {
+    {
+        std::unique_lock<std::mutex> lock{_mutex};
+        _quit = true;
+        _pendingCount -= _requests.size();
+        _requests.clear();
+    }
+    _wake.notify_all();
+
+    for(std::thread& thread: _threads) thread.join();
+    _threads.clear();
+}
+
+template<class T, class U> void AbstractThreadedResourceLoader<T, U>::doLoad(const ResourceKey key) {
+    ++_pendingCount;
+    {
+        std::unique_lock<std::mutex> lock{_mutex};
+        _requests.push_back(key);
+    }
+    _wake.notify_one();
+}
+
+template<class T, class U> void AbstractThreadedResourceLoader<T, U>::work() {
+    for(;;) {
+        ResourceKey key;
+        {
+            std::unique_lock<std::mutex> lock{_mutex};
+            _wake.wait(lock, [this]() { return _quit || !_requests.empty(); });
+            if(_quit) return;
+            key = _requests.front();
+            _requests.pop_front();
+        }
+
+        /* Decode outside of the lock */
+        std::optional<U> decoded = doDecode(key);
+
+        std::unique_lock<std::mutex> lock{_mutex};
+        _decoded.emplace_back(key, std::move(decoded));
+    }
+}
+
+template<class T, class U> std::size_t AbstractThreadedResourceLoader<T, U>::update(const std::size_t budget) {
+    /* Without worker threads decode here, at most as many as the budget */
+    if(_threads.empty() && !_quit) {
+        std::unique_lock<std::mutex> lock{_mutex};
+        while(!_requests.empty() && _decoded.size() < budget) {
+            const ResourceKey key = _requests.front();
+            _requests.pop_front();
+            _decoded.emplace_back(key, doDecode(key));
+        }
+    }
+
+    std::size_t count = 0;
+    for(; count != budget; ++count) {
+        std::pair<ResourceKey, std::optional<U>> decoded;
+        {
+            std::unique_lock<std::mutex> lock{_mutex};
+            if(_decoded.empty()) break;
+            decoded = std::move(_decoded.front());
+            _decoded.pop_front();
+        }
+
+        --_pendingCount;
+        if(decoded.second) doUpload(decoded.first, std::move(*decoded.second));
+        else this->setNotFound(decoded.first);
+    }
+
+    return count;
+}
+
+}
+#else
+#error this header is not available in Emscripten build
+#endif
+
+#endif
@@ -0,0 +1,125 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ArrayPool.h"
+
+#include <new>
+#include <Corrade/Utility/Assert.h>
+
+namespace Magnum {
+
+/* Placed in front of the array data, padded so the data stay aligned */
+struct alignas(alignof(std::max_align_t)) ArrayPool::Header {
+    ArrayPool* pool;
+    std::size_t capacity;
+};
+
+ArrayPool::ArrayPool(const std::size_t maxFreeSize): _maxFreeSize{maxFreeSize} {}
+
+ArrayPool::~ArrayPool() {
+    CORRADE_ASSERT(!_usedCount, "ArrayPool: destroyed with" << _usedCount << "arrays still in use", );
+    clear();
+}
+
+ArrayPool& ArrayPool::setMaxFreeSize(const std::size_t size) {
+    std::lock_guard<std::mutex> lock{_mutex};
+    _maxFreeSize = size;
+    return *this;
+}
+
+std::size_t ArrayPool::usedCount() const {
+    std::lock_guard<std::mutex> lock{_mutex};
+    return _usedCount;
+}
+
+std::size_t ArrayPool::freeCount() const {
+    std::lock_guard<std::mutex> lock{_mutex};
+    return _free.size();
+}
+
+std::size_t ArrayPool::freeSize() const {
+    std::lock_guard<std::mutex> lock{_mutex};
+    return _freeSize;
+}
+
+Containers::Array<char> ArrayPool::allocate(const std::size_t size) {
+    Header* header = nullptr;
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+
+        /* Pick the smallest free array that fits and isn't wastefully large */
+        auto found = _free.end();
+        for(auto it = _free.begin(); it != _free.end(); ++it) {
+            const std::size_t capacity = (*it)->capacity;
+            if(capacity < size || capacity/2 > size) continue;
+            if(found == _free.end() || capacity < (*found)->capacity) found = it;
+        }
+        if(found != _free.end()) {
+            header = *found;
+            _freeSize -= header->capacity;
+            *found = _free.back();
+            _free.pop_back();
+        }
+
+        ++_usedCount;
+    }
+
+    /* Allocate a new one outside of the lock */
+    if(!header) {
+        header = new(new char[sizeof(Header) + size]) Header{this, size};
+    }
+
+    return Containers::Array<char>{reinterpret_cast<char*>(header + 1), size, deleter};
+}
+
+void ArrayPool::clear() {
+    std::lock_guard<std::mutex> lock{_mutex};
+    for(Header* header: _free) delete[] reinterpret_cast<char*>(header);
+    _free.clear();
+    _freeSize = 0;
+}
+
+void ArrayPool::deleter(char* const data, std::size_t) {
+    /* Null arrays don't get here, but be safe */
+    if(!data) return;
+    Header* const header = reinterpret_cast<Header*>(data) - 1;
+    header->pool->release(header);
+}
+
+void ArrayPool::release(Header* const header) {
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        --_usedCount;
+        if(!_maxFreeSize || _freeSize + header->capacity <= _maxFreeSize) {
+            _free.push_back(header);
+            _freeSize += header->capacity;
+            return;
+        }
+    }
+
+    delete[] reinterpret_cast<char*>(header);
+}
+
+}
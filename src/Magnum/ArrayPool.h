@@ -0,0 +1,152 @@
+#ifndef Magnum_ArrayPool_h
+#define Magnum_ArrayPool_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::ArrayPool
+ */
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum {
+
+/**
+@brief Pool of recyclable data arrays
+
+Hands out @ref Corrade::Containers::Array instances that return their memory
+to the pool on destruction instead of freeing it, so repeated decoding of
+similarly-sized payloads (e.g. when streaming textures or audio) settles on a
+fixed set of allocations. Importers can decode into the pool when set with
+@ref Trade::AbstractImporter::setArrayPool() or
+@ref Audio::AbstractImporter::setArrayPool().
+@code
+ArrayPool pool;
+importer->setArrayPool(&pool);
+
+for(const std::string& file: files) {
+    importer->openFile(file);
+    std::optional<Trade::ImageData2D> image = importer->image2D(0);
+    texture.setSubImage(0, {}, *image);
+    // the image data go back to the pool here
+}
+@endcode
+
+A free array is reused if it is at least as large as requested and at most
+twice as large, otherwise a new one is allocated. Use
+@ref setMaxFreeSize() to limit how much memory the pool keeps around.
+
+The pool has to outlive all arrays allocated from it. The arrays use a
+deleter implemented in the library, so they can be safely used even after
+the plugin that allocated them is unloaded.
+
+## Thread safety
+
+Allocation and deallocation is guarded by a mutex, so the arrays can be
+allocated on a loader thread and destroyed on another.
+*/
+class MAGNUM_EXPORT ArrayPool {
+    public:
+        /**
+         * @brief Constructor
+         * @param maxFreeSize   Max size of free arrays kept in the pool, in
+         *      bytes. `0` means unlimited.
+         */
+        explicit ArrayPool(std::size_t maxFreeSize = 0);
+
+        /** @brief Copying is not allowed */
+        ArrayPool(const ArrayPool&) = delete;
+
+        /** @brief Moving is not allowed */
+        ArrayPool(ArrayPool&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Expects that all arrays allocated from the pool were destroyed.
+         */
+        ~ArrayPool();
+
+        /** @brief Copying is not allowed */
+        ArrayPool& operator=(const ArrayPool&) = delete;
+
+        /** @brief Moving is not allowed */
+        ArrayPool& operator=(ArrayPool&&) = delete;
+
+        /** @brief Max size of free arrays kept in the pool */
+        std::size_t maxFreeSize() const { return _maxFreeSize; }
+
+        /**
+         * @brief Set max size of free arrays kept in the pool
+         * @return Reference to self (for method chaining)
+         *
+         * Arrays that would make the free size exceed the limit are freed on
+         * destruction instead of returning to the pool. `0` means unlimited.
+         * Free arrays already in the pool are not affected, use @ref clear()
+         * to free them.
+         */
+        ArrayPool& setMaxFreeSize(std::size_t size);
+
+        /** @brief Count of arrays currently in use */
+        std::size_t usedCount() const;
+
+        /** @brief Count of free arrays in the pool */
+        std::size_t freeCount() const;
+
+        /** @brief Total capacity of free arrays in the pool, in bytes */
+        std::size_t freeSize() const;
+
+        /**
+         * @brief Allocate an array
+         *
+         * Reuses a free array, if there's a suitable one, allocates a new
+         * one otherwise. The contents are not initialized. The memory is
+         * aligned to `alignof(std::max_align_t)`.
+         */
+        Containers::Array<char> allocate(std::size_t size);
+
+        /** @brief Free all free arrays in the pool */
+        void clear();
+
+    private:
+        struct Header;
+
+        static void deleter(char* data, std::size_t);
+        void release(Header* header);
+
+        mutable std::mutex _mutex;
+        std::size_t _maxFreeSize, _freeSize{}, _usedCount{};
+        std::vector<Header*> _free;
+};
+
+}
+
+#endif
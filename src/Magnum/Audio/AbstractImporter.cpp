@@ -29,6 +29,8 @@
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/Directory.h>
 
+#include "Magnum/ArrayPool.h"
+
 namespace Magnum { namespace Audio {
 
 AbstractImporter::AbstractImporter() = default;
@@ -50,6 +52,31 @@ void AbstractImporter::doOpenData(Containers::ArrayView<const char>) {
     CORRADE_ASSERT(false, "Audio::AbstractImporter::openData(): feature advertised but not implemented", );
 }
 
+bool AbstractImporter::openMemory(Containers::ArrayView<const char> memory) {
+    CORRADE_ASSERT(features() & Feature::OpenMemory,
+        "Audio::AbstractImporter::openMemory(): feature not supported", {});
+
+    close();
+    doOpenMemory(memory);
+    return isOpened();
+}
+
+void AbstractImporter::doOpenMemory(Containers::ArrayView<const char>) {
+    CORRADE_ASSERT(false, "Audio::AbstractImporter::openMemory(): feature advertised but not implemented", );
+}
+
+namespace {
+    void nonOwningDeleter(char*, std::size_t) {}
+}
+
+Containers::Array<char> AbstractImporter::nonOwningArray(const Containers::ArrayView<const char> memory) {
+    return Containers::Array<char>{const_cast<char*>(memory.data()), memory.size(), nonOwningDeleter};
+}
+
+Containers::Array<char> AbstractImporter::allocateData(const std::size_t size) {
+    return _arrayPool ? _arrayPool->allocate(size) : Containers::Array<char>{size};
+}
+
 bool AbstractImporter::openFile(const std::string& filename) {
     close();
     doOpenFile(filename);
@@ -90,4 +117,28 @@ Containers::Array<char> AbstractImporter::data() {
     return doData();
 }
 
+std::size_t AbstractImporter::streamData(const Containers::ArrayView<char> buffer) {
+    CORRADE_ASSERT(features() & Feature::Streaming,
+        "Audio::AbstractImporter::streamData(): feature not supported", {});
+    CORRADE_ASSERT(isOpened(), "Audio::AbstractImporter::streamData(): no file opened", {});
+    if(buffer.empty()) return 0;
+    return doStreamData(buffer);
+}
+
+std::size_t AbstractImporter::doStreamData(Containers::ArrayView<char>) {
+    CORRADE_ASSERT(false, "Audio::AbstractImporter::streamData(): feature advertised but not implemented", {});
+    return {};
+}
+
+void AbstractImporter::resetStream() {
+    CORRADE_ASSERT(features() & Feature::Streaming,
+        "Audio::AbstractImporter::resetStream(): feature not supported", );
+    CORRADE_ASSERT(isOpened(), "Audio::AbstractImporter::resetStream(): no file opened", );
+    doResetStream();
+}
+
+void AbstractImporter::doResetStream() {
+    CORRADE_ASSERT(false, "Audio::AbstractImporter::resetStream(): feature advertised but not implemented", );
+}
+
 }}
@@ -29,6 +29,7 @@
  * @brief Class @ref Magnum::Audio::AbstractImporter
  */
 
+#include <Corrade/Containers/EnumSet.h>
 #include <Corrade/PluginManager/AbstractManagingPlugin.h>
 
 #include "Magnum/Magnum.h"
@@ -45,9 +46,12 @@ importer plugins.
 
 ## Subclassing
 
-Plugin implements function @ref doFeatures(), @ref doIsOpened(), one of or both
-@ref doOpenData() and @ref doOpenFile() functions, function @ref doClose() and
+Plugin implements function @ref doFeatures(), @ref doIsOpened(), one or more
+of @ref doOpenData(), @ref doOpenMemory() and @ref doOpenFile() functions,
+function @ref doClose() and
 data access functions @ref doFormat(), @ref doFrequency() and @ref doData().
+Importers advertising @ref Feature::Streaming additionally implement
+@ref doStreamData() and @ref doResetStream().
 
 You don't need to do most of the redundant sanity checks, these things are
 checked by the implementation:
@@ -56,16 +60,25 @@ checked by the implementation:
     previous file was closed, function @ref doClose() is called only if there
     is any file opened.
 -   Function @ref doOpenData() is called only if @ref Feature::OpenData is
-    supported.
+    supported, function @ref doOpenMemory() is called only if
+    @ref Feature::OpenMemory is supported.
+-   Functions @ref doStreamData() and @ref doResetStream() are called only
+    if @ref Feature::Streaming is supported. Function @ref doStreamData() is
+    never called with an empty view.
 -   All `do*()` implementations working on opened file are called only if
     there is any file opened.
 
 Plugin interface string is `"cz.mosra.magnum.Audio.AbstractImporter/0.1"`.
 
+Plugins should allocate decoded sample data using @ref allocateData(), which
+takes the memory from the pool set using @ref setArrayPool(), if any.
+
 @attention @ref Corrade::Containers::Array instances returned from the plugin
     should *not* use anything else than the default deleter, otherwise this can
     cause dangling function pointer call on array destruction if the plugin
-    gets unloaded before the array is destroyed.
+    gets unloaded before the array is destroyed. Arrays referencing memory
+    passed to @ref openMemory() can be created using @ref nonOwningArray(),
+    arrays returned from @ref allocateData() are safe in this regard as well.
 */
 class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagingPlugin<AbstractImporter> {
     CORRADE_PLUGIN_INTERFACE("cz.mosra.magnum.Audio.AbstractImporter/0.1")
@@ -78,7 +91,19 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagi
          */
         enum class Feature: UnsignedByte {
             /** Opening files from raw data using @ref openData() */
-            OpenData = 1 << 0
+            OpenData = 1 << 0,
+
+            /**
+             * Opening files from memory which is kept in scope by the caller
+             * using @ref openMemory()
+             */
+            OpenMemory = 1 << 1,
+
+            /**
+             * Decoding the sample data in chunks using @ref streamData()
+             * instead of all at once
+             */
+            Streaming = 1 << 2
         };
 
         /**
@@ -113,6 +138,22 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagi
          */
         bool openData(Containers::ArrayView<const char> data);
 
+        /**
+         * @brief Open memory
+         *
+         * Closes previous file, if it was opened, and tries to open given
+         * memory. Available only if @ref Feature::OpenMemory is supported.
+         * Returns `true` on success, `false` otherwise.
+         *
+         * Unlike @ref openData(), the importer is allowed to reference the
+         * memory instead of copying it and imported data can reference it as
+         * well. The caller has to ensure the memory stays in scope and is not
+         * modified until the importer is closed and all data imported from it
+         * are destroyed.
+         * @see @ref features(), @ref openFile()
+         */
+        bool openMemory(Containers::ArrayView<const char> memory);
+
         /**
          * @brief Open file
          *
@@ -125,6 +166,24 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagi
         /** @brief Close file */
         void close();
 
+        /** @brief Array pool used for sample data */
+        ArrayPool* arrayPool() const { return _arrayPool; }
+
+        /**
+         * @brief Set array pool used for sample data
+         * @return Reference to self (for method chaining)
+         *
+         * If set, plugins decode data returned from @ref data() into arrays
+         * allocated from given pool, so the memory gets reused when the data
+         * are destroyed instead of being allocated anew for each file. The
+         * pool has to outlive all data imported with it. Default is
+         * `nullptr`, meaning the data are allocated on the heap.
+         */
+        AbstractImporter& setArrayPool(ArrayPool* pool) {
+            _arrayPool = pool;
+            return *this;
+        }
+
         /** @{ @name Data access */
 
         /** @brief Sample format */
@@ -133,11 +192,61 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagi
         /** @brief Sample frequency */
         UnsignedInt frequency() const;
 
-        /** @brief Sample data */
+        /**
+         * @brief Sample data
+         *
+         * If the file was opened using @ref openMemory(), the returned array
+         * may reference the memory passed to it instead of being a copy.
+         */
         Containers::Array<char> data();
 
+        /**
+         * @brief Stream sample data
+         * @param buffer    Buffer to decode the data into
+         * @return Count of bytes written into @p buffer, `0` at the end of
+         *      the stream
+         *
+         * Decodes next chunk of the sample data into @p buffer. Only whole
+         * sample frames are written, so the returned size is a multiple of
+         * the frame size for given @ref format() and is `0` also if the
+         * buffer is too small to contain a single frame. Unlike @ref data(),
+         * the importer doesn't need to keep the whole decoded stream in
+         * memory. Available only if @ref Feature::Streaming is supported. The
+         * stream starts at the beginning after opening a file.
+         * @see @ref features(), @ref resetStream(), @ref Stream
+         */
+        std::size_t streamData(Containers::ArrayView<char> buffer);
+
+        /**
+         * @brief Reset the stream
+         *
+         * Next call to @ref streamData() will return data from the beginning
+         * again. Available only if @ref Feature::Streaming is supported.
+         * @see @ref features()
+         */
+        void resetStream();
+
         /*@}*/
 
+    protected:
+        /**
+         * @brief Create a non-owning array
+         *
+         * Returns an array referencing given memory, which doesn't delete it
+         * on destruction. Meant for returning data referencing memory passed
+         * to @ref doOpenMemory(). The deleter is implemented in the library,
+         * so the array can be safely used even after the plugin is unloaded.
+         */
+        static Containers::Array<char> nonOwningArray(Containers::ArrayView<const char> memory);
+
+        /**
+         * @brief Allocate an array for sample data
+         *
+         * Allocates from @ref arrayPool(), if set, otherwise on the heap. The
+         * contents are not initialized.
+         */
+        Containers::Array<char> allocateData(std::size_t size);
+
     #ifndef DOXYGEN_GENERATING_OUTPUT
     private:
     #else
@@ -152,6 +261,9 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagi
         /** @brief Implementation for @ref openData() */
         virtual void doOpenData(Containers::ArrayView<const char> data);
 
+        /** @brief Implementation for @ref openMemory() */
+        virtual void doOpenMemory(Containers::ArrayView<const char> memory);
+
         /**
          * @brief Implementation for @ref openFile()
          *
@@ -171,8 +283,19 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagi
 
         /** @brief Implementation for @ref data() */
         virtual Containers::Array<char> doData() = 0;
+
+        /** @brief Implementation for @ref streamData() */
+        virtual std::size_t doStreamData(Containers::ArrayView<char> buffer);
+
+        /** @brief Implementation for @ref resetStream() */
+        virtual void doResetStream();
+
+    private:
+        ArrayPool* _arrayPool{};
 };
 
+CORRADE_ENUMSET_OPERATORS(AbstractImporter::Features)
+
 }}
 
 #endif
@@ -29,6 +29,13 @@
 
 namespace Magnum { namespace Audio {
 
+Float Buffer::duration() const {
+    const Int frameSize = channelCount()*bitsPerSample()/8;
+    const Int frequency = this->frequency();
+    if(!frameSize || !frequency) return 0.0f;
+    return Float(size()/frameSize)/Float(frequency);
+}
+
 Debug& operator<<(Debug& debug, const Buffer::Format value) {
     switch(value) {
         /* LCOV_EXCL_START */
@@ -264,6 +264,43 @@ class Buffer {
             return *this;
         }
 
+        /**
+         * @brief Data size in bytes
+         *
+         * @see @ref duration(), @fn_al{GetBufferi} with @def_al{SIZE}
+         */
+        Int size() const;
+
+        /**
+         * @brief Frequency
+         *
+         * @see @fn_al{GetBufferi} with @def_al{FREQUENCY}
+         */
+        Int frequency() const;
+
+        /**
+         * @brief Channel count
+         *
+         * @see @fn_al{GetBufferi} with @def_al{CHANNELS}
+         */
+        Int channelCount() const;
+
+        /**
+         * @brief Bits per sample of one channel
+         *
+         * @see @fn_al{GetBufferi} with @def_al{BITS}
+         */
+        Int bitsPerSample() const;
+
+        /**
+         * @brief Duration in seconds
+         *
+         * Computed from @ref size(), @ref channelCount(),
+         * @ref bitsPerSample() and @ref frequency(). Returns `0.0f` for an
+         * empty buffer.
+         */
+        Float duration() const;
+
     private:
         ALuint _id;
 };
@@ -281,6 +318,30 @@ inline Buffer& Buffer::operator=(Buffer&& other) {
     return *this;
 }
 
+inline Int Buffer::size() const {
+    ALint size;
+    alGetBufferi(_id, AL_SIZE, &size);
+    return size;
+}
+
+inline Int Buffer::frequency() const {
+    ALint frequency;
+    alGetBufferi(_id, AL_FREQUENCY, &frequency);
+    return frequency;
+}
+
+inline Int Buffer::channelCount() const {
+    ALint channels;
+    alGetBufferi(_id, AL_CHANNELS, &channels);
+    return channels;
+}
+
+inline Int Buffer::bitsPerSample() const {
+    ALint bits;
+    alGetBufferi(_id, AL_BITS, &bits);
+    return bits;
+}
+
 }}
 
 #endif
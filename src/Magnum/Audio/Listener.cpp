@@ -56,7 +56,8 @@ template<UnsignedInt dimensions> void Listener<dimensions>::clean(const MatrixTy
         return;
     }
 
-    Renderer::setListenerPosition(soundTransformation().transformVector(Vector3::pad(absoluteTransformationMatrix.translation())));
+    _position = soundTransformation().transformVector(Vector3::pad(absoluteTransformationMatrix.translation()));
+    Renderer::setListenerPosition(_position);
 
     const Vector3 fwd = soundTransformation().transformVector(-padMatrix4(absoluteTransformationMatrix).backward());
     const Vector3 up = soundTransformation().transformVector(padMatrix4(absoluteTransformationMatrix).up());
@@ -88,6 +89,7 @@ template<UnsignedInt dimensions> void Listener<dimensions>::update(std::initiali
 
     objects.push_back(this->object());
     for(PlayableGroup<dimensions>& group : groups) {
+        group._batchUpdate = true;
         for(UnsignedInt i = 0; i < group.size(); ++i) {
             objects.push_back(group[i].object());
         }
@@ -95,6 +97,13 @@ template<UnsignedInt dimensions> void Listener<dimensions>::update(std::initiali
 
     /* Use the more performant way to set multiple objects clean */
     AbstractObject<dimensions, Float>::setClean(objects);
+
+    /* Update the sources afterwards, culling them against the listener
+       position computed above */
+    for(PlayableGroup<dimensions>& group : groups) {
+        group._batchUpdate = false;
+        group.updateSources(_position);
+    }
 }
 
 /* On non-MinGW Windows the instantiations are already marked with extern
@@ -157,6 +157,9 @@ template <UnsignedInt dimensions> class Listener: public SceneGraph::AbstractFea
          * @ref SceneGraph::AbstractObject::setClean() on its parent object and
          * all objects of the @ref Playable s in the group. Updates listene
          * related configuration for @ref Renderer (position, orientation, gain).
+         * The sources of all playables are then updated in a single pass,
+         * culled against the listener position. See
+         * @ref PlayableGroup::setCullDistance() for more information.
          */
         void update(std::initializer_list<std::reference_wrapper<PlayableGroup<dimensions>>> groups);
 
@@ -188,6 +191,7 @@ template <UnsignedInt dimensions> class Listener: public SceneGraph::AbstractFea
         virtual void clean(const MatrixTypeFor<dimensions, Float>& absoluteTransformationMatrix) override;
 
         Matrix4 _soundTransformation;
+        Vector3 _position;
         Float _gain;
 };
 
@@ -34,6 +34,7 @@
 #include <al.h>
 
 #include <Magnum/SceneGraph/AbstractGroupedFeature.h>
+#include <Magnum/Math/Constants.h>
 #include <Magnum/Math/Matrix3.h>
 #include <Magnum/Math/Matrix4.h>
 
@@ -70,6 +71,16 @@ Position of the source will be updated to the translation of `object` when
 
 To manage multiple Playables at once, use @ref PlayableGroup.
 
+## Source updates
+
+The playable remembers the position, direction and gain it last passed to the
+@ref Source and doesn't call OpenAL again if they didn't change. Because of
+that, position, direction and gain of the source shouldn't be modified
+directly. When cleaned as a part of @ref PlayableGroup::setClean() or
+@ref Listener::update(), the sources are updated in a single pass after all
+transformations are computed, which allows the group to cull inaudible
+sources, see @ref PlayableGroup::setCullDistance().
+
 -   @ref Playable2D
 -   @ref Playable3D
 
@@ -96,7 +107,13 @@ template<UnsignedInt dimensions> class Playable: public SceneGraph::AbstractGrou
             SceneGraph::AbstractGroupedFeature<dimensions, Playable<dimensions>, Float>(object, group),
             _fwd(0.0f),
             _gain(1.0f),
-            _source()
+            _source(),
+            /* NaN never compares equal, so the first update is always done */
+            _sourcePosition{Constants::nan()},
+            _sourceDirection{Constants::nan()},
+            _sourceGain{1.0f},
+            _pending{},
+            _culled{}
         {
             SceneGraph::AbstractFeature<dimensions, Float>::setCachedTransformations(SceneGraph::CachedTransformation::Absolute);
             _fwd[dimensions - 1] = -1;
@@ -139,32 +156,72 @@ template<UnsignedInt dimensions> class Playable: public SceneGraph::AbstractGrou
             return static_cast<const PlayableGroup<dimensions>*>(this->group());
         }
 
+        /**
+         * @brief Whether the playable is culled
+         *
+         * Culled playables have their source gain set to `0.0f` and their
+         * position isn't updated.
+         * @see @ref PlayableGroup::setCullDistance()
+         */
+        bool isCulled() const { return _culled; }
+
     private:
 
         void clean(const MatrixTypeFor<dimensions, Float>& absoluteTransformationMatrix) override {
-            Vector3 position = Vector3::pad(absoluteTransformationMatrix.translation(), 0);
+            _position = Vector3::pad(absoluteTransformationMatrix.translation(), 0);
             if(playables()) {
-                position = playables()->soundTransformation().transformVector(position);
+                _position = playables()->soundTransformation().transformVector(_position);
             }
-            _source.setPosition(position);
-            _source.setDirection(Vector3::pad(absoluteTransformationMatrix.rotation()*_fwd));
+            _direction = Vector3::pad(absoluteTransformationMatrix.rotation()*_fwd);
+
+            /* When cleaned in a batch, the group updates the source later */
+            if(playables() && playables()->_batchUpdate) _pending = true;
+            else cleanSource();
 
             /** @todo velocity */
         }
 
+        /* Update source position and direction, if they changed since last
+           time. Called from clean() and PlayableGroup::updateSources(). */
+        void cleanSource() {
+            _pending = false;
+            if(_culled) return;
+
+            if(_position != _sourcePosition) {
+                _source.setPosition(_position);
+                _sourcePosition = _position;
+            }
+            if(_direction != _sourceDirection) {
+                _source.setDirection(_direction);
+                _sourceDirection = _direction;
+            }
+        }
+
         /* Update the gain of the underlying source to reflect changes in _group and/or _gain.
            Called in Playable::setGain() and PlayableGroup::setGain() */
         void cleanGain() {
-            if(playables()) {
-                _source.setGain(_gain*playables()->gain());
+            Float gain;
+            if(_culled) {
+                gain = 0.0f;
+            } else if(playables()) {
+                gain = _gain*playables()->gain();
             } else {
-                _source.setGain(_gain);
+                gain = _gain;
             }
+
+            if(gain == _sourceGain) return;
+            _source.setGain(gain);
+            _sourceGain = gain;
         }
 
         VectorTypeFor<dimensions, Float> _fwd;
         Float _gain;
         Source _source;
+
+        /* Last computed values and values last passed to the source */
+        Vector3 _position, _direction, _sourcePosition, _sourceDirection;
+        Float _sourceGain;
+        bool _pending, _culled;
 };
 
 /**
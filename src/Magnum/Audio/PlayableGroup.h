@@ -40,6 +40,7 @@
 
 #include "Magnum/Audio/Audio.h"
 #include "Magnum/Audio/Playable.h"
+#include "Magnum/Audio/Renderer.h"
 #include "Magnum/Audio/Source.h"
 #include "Magnum/Audio/visibility.h"
 
@@ -72,6 +73,22 @@ For two dimensional scenes simply replace `3D` with `2D`. When using a
 @ref Listener, prefer @ref Listener::update() over
 @ref PlayableGroup::setClean().
 
+## Batched updates and culling
+
+@ref setClean() computes absolute transformations of all playables in a
+single batch using @ref SceneGraph::AbstractObject::setClean(), then updates
+the sources in one pass. Sources of playables that didn't move aren't touched
+at all. With @ref setCullDistance() the pass additionally mutes playables
+that are too far from the listener and skips their position updates
+completely, so only the audible sources cost OpenAL calls each frame:
+
+@code
+group.setCullDistance(50.0f);
+
+// ... every frame:
+listener.update({group});
+@endcode
+
 -   @ref PlayableGroup2D
 -   @ref PlayableGroup3D
 
@@ -79,13 +96,17 @@ For two dimensional scenes simply replace `3D` with `2D`. When using a
 */
 template<UnsignedInt dimensions> class PlayableGroup: public SceneGraph::FeatureGroup<dimensions, Playable<dimensions>, Float> {
     friend Playable<dimensions>;
+    friend Listener<dimensions>;
 
     public:
 
         /** @brief Constructor */
         explicit PlayableGroup():
             SceneGraph::FeatureGroup<dimensions, Playable<dimensions>, Float>(),
-            _gain{1.0f}
+            _gain{1.0f},
+            _cullDistance{Constants::inf()},
+            _culledCount{},
+            _batchUpdate{}
         {}
 
         /**
@@ -141,6 +162,32 @@ template<UnsignedInt dimensions> class PlayableGroup: public SceneGraph::Feature
             return *this;
         }
 
+        /** @brief Cull distance */
+        Float cullDistance() const { return _cullDistance; }
+
+        /**
+         * @brief Set cull distance
+         * @return Reference to self (for method chaining)
+         *
+         * Playables farther than @p distance from the listener are culled on
+         * next @ref setClean() or @ref Listener::update() --- their source
+         * gain is set to `0.0f` and their position is not updated until they
+         * get in range again. The distance is measured after applying
+         * @ref soundTransformation(). Default is infinity, i.e. no culling.
+         * @see @ref Playable::isCulled(), @ref culledCount()
+         */
+        PlayableGroup& setCullDistance(Float distance) {
+            _cullDistance = distance;
+            return *this;
+        }
+
+        /**
+         * @brief Count of playables culled in last update
+         *
+         * @see @ref setCullDistance()
+         */
+        std::size_t culledCount() const { return _culledCount; }
+
         /** @brief Sound transformation */
         const Matrix4& soundTransformation() const {
             return _soundTransform;
@@ -154,11 +201,18 @@ template<UnsignedInt dimensions> class PlayableGroup: public SceneGraph::Feature
 
         /**
          * @brief Set all contained Playables clean
-         * @see @ref AbstractObject::setClean()
+         *
+         * Cleans all objects in a batch and then updates the sources. If
+         * culling is enabled, the listener position is queried using
+         * @ref Renderer::listenerPosition().
+         * @see @ref AbstractObject::setClean(), @ref setCullDistance()
          */
         void setClean();
 
     private:
+        /* Update sources of all playables cleaned since last call and cull
+           them against given listener position */
+        void updateSources(const Vector3& listenerPosition);
 
         /* @brief Sources of all Playables in this group */
         std::vector<std::reference_wrapper<Source>> sources() {
@@ -170,7 +224,9 @@ template<UnsignedInt dimensions> class PlayableGroup: public SceneGraph::Feature
         }
 
         Matrix4 _soundTransform;
-        Float _gain;
+        Float _gain, _cullDistance;
+        std::size_t _culledCount;
+        bool _batchUpdate;
 };
 
 template<UnsignedInt dimensions> inline PlayableGroup<dimensions>& PlayableGroup<dimensions>::setSoundTransformation(const Matrix4& matrix) {
@@ -192,7 +248,33 @@ template<UnsignedInt dimensions> inline void PlayableGroup<dimensions>::setClean
     for(UnsignedInt i = 0; i < this->size(); ++i)
         objects.push_back((*this)[i].object());
 
+    _batchUpdate = true;
     SceneGraph::AbstractObject<dimensions, Float>::setClean(objects);
+    _batchUpdate = false;
+
+    /* Query the listener only if it's needed */
+    updateSources(_cullDistance == Constants::inf() ? Vector3{} : Renderer::listenerPosition());
+}
+
+template<UnsignedInt dimensions> void PlayableGroup<dimensions>::updateSources(const Vector3& listenerPosition) {
+    const bool cull = _cullDistance != Constants::inf();
+    const Float cullDistanceSquared = _cullDistance*_cullDistance;
+
+    _culledCount = 0;
+    for(UnsignedInt i = 0; i < this->size(); ++i) {
+        Playable<dimensions>& playable = (*this)[i];
+
+        /* Cull first so culled sources don't get their position updated */
+        const bool culled = cull && (playable._position - listenerPosition).dot() > cullDistanceSquared;
+        if(culled != playable._culled) {
+            playable._culled = culled;
+            if(!culled) playable._pending = true;
+            playable.cleanGain();
+        }
+        if(culled) ++_culledCount;
+
+        if(playable._pending) playable.cleanSource();
+    }
 }
 
 /**
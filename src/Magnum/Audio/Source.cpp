@@ -25,7 +25,9 @@
 
 #include "Source.h"
 
+#include <algorithm>
 #include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Assert.h>
 
 #include "Magnum/Audio/Buffer.h"
 
@@ -54,6 +56,52 @@ Containers::Array<ALuint> sourceIds(const std::vector<std::reference_wrapper<Sou
     return ids;
 }
 
+template<class T> Containers::Array<ALuint> bufferIds(const T& buffers) {
+    Containers::Array<ALuint> ids(buffers.size());
+    for(auto it = buffers.begin(); it != buffers.end(); ++it)
+        ids[it-buffers.begin()] = it->get().id();
+    return ids;
+}
+
+#ifndef CORRADE_NO_ASSERT
+bool unqueueBuffersInternal(const ALuint source, Containers::Array<ALuint>&& ids) {
+    Containers::Array<ALuint> unqueued(ids.size());
+    alSourceUnqueueBuffers(source, unqueued.size(), unqueued);
+    return std::equal(ids.begin(), ids.end(), unqueued.begin());
+}
+#else
+bool unqueueBuffersInternal(const ALuint source, Containers::Array<ALuint>&& ids) {
+    alSourceUnqueueBuffers(source, ids.size(), ids);
+    return true;
+}
+#endif
+
+}
+
+Source& Source::queueBuffers(std::initializer_list<std::reference_wrapper<Buffer>> buffers) {
+    const auto ids = bufferIds(buffers);
+    alSourceQueueBuffers(_id, ids.size(), ids);
+    return *this;
+}
+
+Source& Source::queueBuffers(const std::vector<std::reference_wrapper<Buffer>>& buffers) {
+    const auto ids = bufferIds(buffers);
+    alSourceQueueBuffers(_id, ids.size(), ids);
+    return *this;
+}
+
+Source& Source::unqueueBuffers(std::initializer_list<std::reference_wrapper<Buffer>> buffers) {
+    const bool inOrder = unqueueBuffersInternal(_id, bufferIds(buffers));
+    CORRADE_ASSERT(inOrder, "Audio::Source::unqueueBuffers(): buffers were not unqueued in the order they were queued", *this);
+    static_cast<void>(inOrder);
+    return *this;
+}
+
+Source& Source::unqueueBuffers(const std::vector<std::reference_wrapper<Buffer>>& buffers) {
+    const bool inOrder = unqueueBuffersInternal(_id, bufferIds(buffers));
+    CORRADE_ASSERT(inOrder, "Audio::Source::unqueueBuffers(): buffers were not unqueued in the order they were queued", *this);
+    static_cast<void>(inOrder);
+    return *this;
 }
 
 void Source::play(std::initializer_list<std::reference_wrapper<Source>> sources) {
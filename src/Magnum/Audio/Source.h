@@ -46,7 +46,15 @@ namespace Magnum { namespace Audio {
 @brief Source
 
 Manages positional audio source.
-@todo Expose convenient API for buffer queuing
+
+## Buffer queueing
+
+Instead of attaching a single buffer using @ref setBuffer(), it's possible to
+queue more buffers using @ref queueBuffers(), which are then played one after
+another. Buffers which were already played (see @ref buffersProcessed()) can be
+removed from the queue using @ref unqueueBuffers(), filled with new data and
+queued again. The @ref Stream class builds on this to play long sounds from
+a small, constant amount of memory.
 */
 class MAGNUM_AUDIO_EXPORT Source {
     public:
@@ -502,6 +510,50 @@ class MAGNUM_AUDIO_EXPORT Source {
          */
         Source& setBuffer(Buffer* buffer);
 
+        /**
+         * @brief Queue buffers
+         * @return Reference to self (for method chaining)
+         *
+         * Appends given buffers to the end of the queue, changes source type
+         * to @ref Type::Streaming. All buffers in the queue must have the
+         * same format.
+         * @see @ref unqueueBuffers(), @ref buffersQueued(),
+         *      @fn_al{SourceQueueBuffers}
+         */
+        Source& queueBuffers(std::initializer_list<std::reference_wrapper<Buffer>> buffers);
+        Source& queueBuffers(const std::vector<std::reference_wrapper<Buffer>>& buffers); /**< @overload */
+
+        /**
+         * @brief Unqueue buffers
+         * @return Reference to self (for method chaining)
+         *
+         * Removes given buffers from the front of the queue. The buffers must
+         * be already processed (see @ref buffersProcessed()) and have to be
+         * passed in the same order in which they were queued.
+         * @see @ref queueBuffers(), @fn_al{SourceUnqueueBuffers}
+         */
+        Source& unqueueBuffers(std::initializer_list<std::reference_wrapper<Buffer>> buffers);
+        Source& unqueueBuffers(const std::vector<std::reference_wrapper<Buffer>>& buffers); /**< @overload */
+
+        /**
+         * @brief Count of queued buffers
+         *
+         * Includes also buffers which were already processed.
+         * @see @ref buffersProcessed(), @fn_al{GetSourcei} with
+         *      @def_al{BUFFERS_QUEUED}
+         */
+        Int buffersQueued() const;
+
+        /**
+         * @brief Count of processed buffers
+         *
+         * Count of buffers at the front of the queue which were already
+         * played and can be unqueued using @ref unqueueBuffers().
+         * @see @ref buffersQueued(), @fn_al{GetSourcei} with
+         *      @def_al{BUFFERS_PROCESSED}
+         */
+        Int buffersProcessed() const;
+
         /*@}*/
 
         /** @{ @name State management */
@@ -725,6 +777,24 @@ inline bool Source::isLooping() const {
     return looping;
 }
 
+inline auto Source::type() const -> Type {
+    ALint type;
+    alGetSourcei(_id, AL_SOURCE_TYPE, &type);
+    return Type(type);
+}
+
+inline Int Source::buffersQueued() const {
+    ALint count;
+    alGetSourcei(_id, AL_BUFFERS_QUEUED, &count);
+    return count;
+}
+
+inline Int Source::buffersProcessed() const {
+    ALint count;
+    alGetSourcei(_id, AL_BUFFERS_PROCESSED, &count);
+    return count;
+}
+
 inline Float Source::offsetInSeconds() const {
     Float offset;
     alGetSourcef(_id, AL_SEC_OFFSET, &offset);
@@ -0,0 +1,186 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Stream.h"
+
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Audio/AbstractImporter.h"
+#include "Magnum/Audio/Source.h"
+
+namespace Magnum { namespace Audio {
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#define LOCK std::unique_lock<std::mutex> lock{_mutex}
+#else
+#define LOCK
+#endif
+
+Stream::Stream(Source& source, AbstractImporter& importer, const std::size_t bufferCount, const std::size_t bufferSize): _source(source), _importer(importer), _buffers{bufferCount}, _data{bufferSize}, _front{}, _queued{}, _looping{}, _ended{true}
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    , _quit{}
+    #endif
+{
+    CORRADE_ASSERT(importer.features() & AbstractImporter::Feature::Streaming,
+        "Audio::Stream: the importer doesn't support streaming", );
+    CORRADE_ASSERT(importer.isOpened(), "Audio::Stream: no file opened", );
+    CORRADE_ASSERT(bufferCount && bufferSize, "Audio::Stream: expected non-zero buffer count and size", );
+
+    _format = importer.format();
+    _frequency = importer.frequency();
+}
+
+Stream::~Stream() {
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    stopBackgroundUpdate();
+    #endif
+    stopInternal();
+}
+
+Stream& Stream::setLooping(const bool looping) {
+    LOCK;
+    _looping = looping;
+    return *this;
+}
+
+bool Stream::isFinished() {
+    LOCK;
+    return _ended && (!_queued || _source.buffersProcessed() == Int(_queued));
+}
+
+void Stream::play() {
+    LOCK;
+    stopInternal();
+
+    _importer.resetStream();
+    _ended = false;
+    _front = 0;
+
+    /* Fill as many buffers as there are data for */
+    std::vector<std::reference_wrapper<Buffer>> buffers;
+    for(Buffer& buffer: _buffers) {
+        if(!fill(buffer)) break;
+        buffers.push_back(buffer);
+    }
+
+    _queued = buffers.size();
+    if(_queued) {
+        _source.queueBuffers(buffers);
+        _source.play();
+    }
+}
+
+void Stream::stop() {
+    LOCK;
+    stopInternal();
+}
+
+void Stream::stopInternal() {
+    if(!_queued) return;
+
+    /* Detaching the buffer removes the whole queue */
+    _source.stop();
+    _source.setBuffer(nullptr);
+    _queued = 0;
+    _ended = true;
+}
+
+std::size_t Stream::update() {
+    LOCK;
+    return updateInternal();
+}
+
+std::size_t Stream::updateInternal() {
+    if(!_queued) return 0;
+
+    const std::size_t processed = _source.buffersProcessed();
+    std::size_t refilled = 0;
+    for(std::size_t i = 0; i != processed; ++i) {
+        Buffer& buffer = _buffers[_front];
+        _source.unqueueBuffers({buffer});
+        --_queued;
+        _front = (_front + 1) % _buffers.size();
+
+        /* The buffer goes to the back of the ring */
+        if(!_ended && fill(buffer)) {
+            _source.queueBuffers({buffer});
+            ++_queued;
+            ++refilled;
+        }
+    }
+
+    /* The source ran out of data before we refilled the buffers, resume */
+    if(refilled && _source.state() == Source::State::Stopped)
+        _source.play();
+
+    return refilled;
+}
+
+bool Stream::fill(Buffer& buffer) {
+    std::size_t size = _importer.streamData(_data);
+
+    /* Restart from the beginning if looping. If the stream is empty even
+       after that, there's nothing to loop. */
+    if(!size && _looping) {
+        _importer.resetStream();
+        size = _importer.streamData(_data);
+    }
+
+    if(!size) {
+        _ended = true;
+        return false;
+    }
+
+    buffer.setData(_format, _data.prefix(size), _frequency);
+    return true;
+}
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+void Stream::startBackgroundUpdate(const std::chrono::milliseconds interval) {
+    stopBackgroundUpdate();
+
+    _quit = false;
+    _thread = std::thread{[this, interval]() {
+        std::unique_lock<std::mutex> lock{_mutex};
+        while(!_wake.wait_for(lock, interval, [this]() { return _quit; }))
+            updateInternal();
+    }};
+}
+
+void Stream::stopBackgroundUpdate() {
+    if(!_thread.joinable()) return;
+
+    {
+        std::unique_lock<std::mutex> lock{_mutex};
+        _quit = true;
+    }
+    _wake.notify_all();
+    _thread.join();
+}
+#endif
+
+#undef LOCK
+
+}}
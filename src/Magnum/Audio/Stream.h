@@ -0,0 +1,234 @@
+#ifndef Magnum_Audio_Stream_h
+#define Magnum_Audio_Stream_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+    Copyright © 2015 Jonathan Hale <squareys@googlemail.com>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Audio::Stream
+ */
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/configure.h>
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+#include "Magnum/Audio/Audio.h"
+#include "Magnum/Audio/Buffer.h"
+#include "Magnum/Audio/visibility.h"
+
+namespace Magnum { namespace Audio {
+
+/**
+@brief Streaming playback
+
+Plays a sound of arbitrary length from a fixed-size ring of buffers, queued
+on a @ref Source using @ref Source::queueBuffers(). The buffers are refilled
+with data from @ref AbstractImporter::streamData() as soon as they are
+played, so the memory use depends only on the buffer count and size, not on
+the length of the sound. The importer must support
+@ref AbstractImporter::Feature::Streaming and have a file opened. Example
+usage:
+@code
+std::unique_ptr<Audio::AbstractImporter> importer = manager.instance("WavAudioImporter");
+importer->openFile("music.wav");
+
+Audio::Source source;
+Audio::Stream stream{source, *importer};
+stream.setLooping(true)
+    .play();
+stream.startBackgroundUpdate();
+@endcode
+
+Either call @ref update() periodically, for example once per frame, or let a
+background thread refill the buffers using @ref startBackgroundUpdate(). If
+the buffers aren't refilled in time, the source stops and @ref update()
+resumes the playback once new data are queued. OpenAL calls are thread-safe,
+so the source can be manipulated while the background thread is running.
+The importer must not be used from elsewhere until the stream is destroyed.
+
+Background updates are not available on @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten".
+*/
+class MAGNUM_AUDIO_EXPORT Stream {
+    public:
+        /**
+         * @brief Constructor
+         * @param source        Source to play the stream on
+         * @param importer      Importer to stream the data from
+         * @param bufferCount   Count of buffers in the ring
+         * @param bufferSize    Size of each buffer in bytes
+         *
+         * The source and importer are expected to stay in scope until the
+         * stream is destroyed. Longer ring gives more time for the refill,
+         * at the cost of higher memory use and latency of @ref stop().
+         */
+        explicit Stream(Source& source, AbstractImporter& importer, std::size_t bufferCount = 4, std::size_t bufferSize = 32768);
+
+        /** @brief Copying is not allowed */
+        Stream(const Stream&) = delete;
+
+        /** @brief Moving is not allowed */
+        Stream(Stream&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Stops the background update, if running, and stops the playback.
+         */
+        ~Stream();
+
+        /** @brief Copying is not allowed */
+        Stream& operator=(const Stream&) = delete;
+
+        /** @brief Moving is not allowed */
+        Stream& operator=(Stream&&) = delete;
+
+        /** @brief Source the stream is played on */
+        Source& source() { return _source; }
+
+        /** @brief Importer the data are streamed from */
+        AbstractImporter& importer() { return _importer; }
+
+        /** @brief Count of buffers in the ring */
+        std::size_t bufferCount() const { return _buffers.size(); }
+
+        /** @brief Size of each buffer in bytes */
+        std::size_t bufferSize() const { return _data.size(); }
+
+        /** @brief Whether the stream is looping */
+        bool isLooping() const { return _looping; }
+
+        /**
+         * @brief Set stream looping
+         * @return Reference to self (for method chaining)
+         *
+         * If enabled, the stream is restarted using
+         * @ref AbstractImporter::resetStream() when it reaches the end.
+         * Default is `false`. Don't use @ref Source::setLooping() on streamed
+         * sources, as it would loop only the currently queued buffers.
+         */
+        Stream& setLooping(bool looping);
+
+        /**
+         * @brief Whether the stream was played until the end
+         *
+         * Returns `true` if all data were streamed and all queued buffers
+         * were played or the playback was stopped using @ref stop(), `false`
+         * otherwise. Always `false` for looping streams that are playing.
+         */
+        bool isFinished();
+
+        /**
+         * @brief Play the stream from the beginning
+         *
+         * Stops current playback, if any, resets the importer stream, fills
+         * all buffers and starts playing them.
+         * @see @ref Source::play()
+         */
+        void play();
+
+        /**
+         * @brief Stop the playback
+         *
+         * Stops the source and removes all buffers from its queue.
+         * @see @ref Source::stop()
+         */
+        void stop();
+
+        /**
+         * @brief Refill played buffers
+         * @return Count of buffers that were refilled and queued again
+         *
+         * Unqueues all processed buffers from the source, fills them with new
+         * data and queues them again. Resumes the playback if the source ran
+         * out of data in the meantime.
+         * @see @ref Source::buffersProcessed()
+         */
+        std::size_t update();
+
+        #if !defined(CORRADE_TARGET_EMSCRIPTEN) || defined(DOXYGEN_GENERATING_OUTPUT)
+        /**
+         * @brief Start refilling the buffers from a background thread
+         * @param interval  Interval between calls to @ref update()
+         *
+         * If the background update is already running, it's restarted with
+         * the new interval. The interval should be shorter than the playback
+         * duration of a single buffer.
+         * @note Not available on @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten".
+         * @see @ref stopBackgroundUpdate()
+         */
+        void startBackgroundUpdate(std::chrono::milliseconds interval = std::chrono::milliseconds{20});
+
+        /**
+         * @brief Stop refilling the buffers from a background thread
+         *
+         * Waits for the thread to finish. Doesn't affect the playback, so the
+         * source stops once it plays all queued buffers. Does nothing if
+         * background update is not running.
+         * @note Not available on @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten".
+         * @see @ref startBackgroundUpdate()
+         */
+        void stopBackgroundUpdate();
+
+        /**
+         * @brief Whether the buffers are refilled from a background thread
+         *
+         * @note Not available on @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten".
+         */
+        bool isUpdatingInBackground() const { return _thread.joinable(); }
+        #endif
+
+    private:
+        MAGNUM_AUDIO_LOCAL bool fill(Buffer& buffer);
+        MAGNUM_AUDIO_LOCAL void stopInternal();
+        MAGNUM_AUDIO_LOCAL std::size_t updateInternal();
+
+        Source& _source;
+        AbstractImporter& _importer;
+        Buffer::Format _format;
+        UnsignedInt _frequency;
+        Containers::Array<Buffer> _buffers;
+        Containers::Array<char> _data;
+        /* Index of the buffer at the front of the queue and count of queued
+           buffers following it in the ring */
+        std::size_t _front, _queued;
+        bool _looping, _ended;
+
+        #ifndef CORRADE_TARGET_EMSCRIPTEN
+        std::mutex _mutex;
+        std::condition_variable _wake;
+        std::thread _thread;
+        bool _quit;
+        #endif
+};
+
+}}
+
+#endif
@@ -37,10 +37,14 @@ struct AbstractImporterTest: TestSuite::Tester {
     explicit AbstractImporterTest();
 
     void openFile();
+
+    void streamData();
 };
 
 AbstractImporterTest::AbstractImporterTest() {
-    addTests({&AbstractImporterTest::openFile});
+    addTests({&AbstractImporterTest::openFile,
+
+              &AbstractImporterTest::streamData});
 }
 
 void AbstractImporterTest::openFile() {
@@ -71,6 +75,42 @@ void AbstractImporterTest::openFile() {
     CORRADE_VERIFY(importer.isOpened());
 }
 
+void AbstractImporterTest::streamData() {
+    class StreamingImporter: public Audio::AbstractImporter {
+        public:
+            explicit StreamingImporter(): calls{} {}
+
+            std::size_t calls;
+
+        private:
+            Features doFeatures() const override { return Feature::Streaming; }
+            bool doIsOpened() const override { return true; }
+            void doClose() override {}
+
+            Buffer::Format doFormat() const override { return {}; }
+            UnsignedInt doFrequency() const override { return {}; }
+            Corrade::Containers::Array<char> doData() override { return nullptr; }
+
+            std::size_t doStreamData(Containers::ArrayView<char> buffer) override {
+                ++calls;
+                return buffer.size()/2;
+            }
+            void doResetStream() override { calls = 0; }
+    };
+
+    StreamingImporter importer;
+    char buffer[8];
+    CORRADE_COMPARE(importer.streamData(buffer), 4);
+    CORRADE_COMPARE(importer.calls, 1);
+
+    /* Empty buffer doesn't get to the implementation */
+    CORRADE_COMPARE(importer.streamData(nullptr), 0);
+    CORRADE_COMPARE(importer.calls, 1);
+
+    importer.resetStream();
+    CORRADE_COMPARE(importer.calls, 0);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Audio::Test::AbstractImporterTest)
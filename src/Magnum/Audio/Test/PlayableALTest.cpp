@@ -27,7 +27,9 @@
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/Audio/Context.h"
+#include "Magnum/Audio/Listener.h"
 #include "Magnum/Audio/Playable.h"
+#include "Magnum/Audio/Renderer.h"
 #include "Magnum/SceneGraph/Scene.h"
 #include "Magnum/SceneGraph/Object.h"
 #include "Magnum/SceneGraph/MatrixTransformation3D.h"
@@ -42,13 +44,19 @@ struct PlayableALTest: TestSuite::Tester {
 
     void feature();
     void group();
+    void groupUnchanged();
+    void groupCull();
+    void listenerCull();
 
     Context _context;
 };
 
 PlayableALTest::PlayableALTest() {
     addTests({&PlayableALTest::feature,
-              &PlayableALTest::group});
+              &PlayableALTest::group,
+              &PlayableALTest::groupUnchanged,
+              &PlayableALTest::groupCull,
+              &PlayableALTest::listenerCull});
 }
 
 void PlayableALTest::feature() {
@@ -91,6 +99,88 @@ void PlayableALTest::group() {
     group.stop();
 }
 
+void PlayableALTest::groupUnchanged() {
+    Scene3D scene;
+    Object3D object{&scene};
+    PlayableGroup3D group;
+    Playable3D playable{object, &group};
+
+    object.translate({1.0f, 2.0f, 3.0f});
+    group.setClean();
+    CORRADE_COMPARE(playable.source().position(), (Vector3{1.0f, 2.0f, 3.0f}));
+
+    /* The object is dirty but didn't move, so the source shouldn't be
+       touched. Verify that by changing the position behind its back. */
+    playable.source().setPosition(Vector3{});
+    object.setDirty();
+    group.setClean();
+    CORRADE_COMPARE(playable.source().position(), Vector3{});
+
+    /* Moving it updates the source again */
+    object.translate({1.0f, 0.0f, 0.0f});
+    group.setClean();
+    CORRADE_COMPARE(playable.source().position(), (Vector3{2.0f, 2.0f, 3.0f}));
+}
+
+void PlayableALTest::groupCull() {
+    Scene3D scene;
+    Object3D near{&scene}, far{&scene};
+    PlayableGroup3D group;
+    Playable3D nearPlayable{near, &group};
+    Playable3D farPlayable{far, &group};
+    CORRADE_COMPARE(group.cullDistance(), Constants::inf());
+
+    Renderer::setListenerPosition(Vector3{});
+    near.translate({1.0f, 0.0f, 0.0f});
+    far.translate({0.0f, 0.0f, 10.0f});
+    farPlayable.setGain(0.5f);
+    group.setCullDistance(5.0f)
+        .setClean();
+    CORRADE_COMPARE(group.culledCount(), 1);
+    CORRADE_VERIFY(!nearPlayable.isCulled());
+    CORRADE_VERIFY(farPlayable.isCulled());
+    CORRADE_COMPARE(nearPlayable.source().position(), (Vector3{1.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(nearPlayable.source().gain(), 1.0f);
+
+    /* The culled source is muted and its position is not updated */
+    CORRADE_COMPARE(farPlayable.source().position(), Vector3{});
+    CORRADE_COMPARE(farPlayable.source().gain(), 0.0f);
+
+    /* Group gain doesn't unmute culled sources */
+    group.setGain(0.5f);
+    CORRADE_COMPARE(nearPlayable.source().gain(), 0.5f);
+    CORRADE_COMPARE(farPlayable.source().gain(), 0.0f);
+
+    /* Getting in range restores both gain and position */
+    far.translate({0.0f, 0.0f, -6.0f});
+    group.setClean();
+    CORRADE_COMPARE(group.culledCount(), 0);
+    CORRADE_VERIFY(!farPlayable.isCulled());
+    CORRADE_COMPARE(farPlayable.source().position(), (Vector3{0.0f, 0.0f, 4.0f}));
+    CORRADE_COMPARE(farPlayable.source().gain(), 0.25f);
+}
+
+void PlayableALTest::listenerCull() {
+    Scene3D scene;
+    Object3D listenerObject{&scene}, object{&scene};
+    Listener3D listener{listenerObject};
+    PlayableGroup3D group;
+    Playable3D playable{object, &group};
+    group.setCullDistance(5.0f);
+
+    object.translate({0.0f, 0.0f, 10.0f});
+    listener.update({group});
+    CORRADE_VERIFY(playable.isCulled());
+
+    /* Moving the listener closer un-culls the playable even though the
+       playable itself didn't move */
+    listenerObject.translate({0.0f, 0.0f, 8.0f});
+    listener.update({group});
+    CORRADE_VERIFY(!playable.isCulled());
+    CORRADE_COMPARE(playable.source().position(), (Vector3{0.0f, 0.0f, 10.0f}));
+    CORRADE_COMPARE(playable.source().gain(), 1.0f);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Audio::Test::PlayableALTest)
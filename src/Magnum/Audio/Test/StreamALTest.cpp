@@ -0,0 +1,213 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <thread>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Audio/AbstractImporter.h"
+#include "Magnum/Audio/Context.h"
+#include "Magnum/Audio/Source.h"
+#include "Magnum/Audio/Stream.h"
+
+namespace Magnum { namespace Audio { namespace Test {
+
+struct StreamALTest: TestSuite::Tester {
+    explicit StreamALTest();
+
+    void construct();
+    void play();
+    void playShort();
+    void looping();
+    void stop();
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    void backgroundUpdate();
+    #endif
+
+    Context _context;
+};
+
+StreamALTest::StreamALTest() {
+    addTests({&StreamALTest::construct,
+              &StreamALTest::play,
+              &StreamALTest::playShort,
+              &StreamALTest::looping,
+              &StreamALTest::stop,
+              #ifndef CORRADE_TARGET_EMSCRIPTEN
+              &StreamALTest::backgroundUpdate
+              #endif
+              });
+}
+
+namespace {
+
+class MemoryImporter: public AbstractImporter {
+    public:
+        explicit MemoryImporter(std::size_t size): streamed{}, resets{}, _data{Containers::ValueInit, size}, _offset{} {}
+
+        std::size_t streamed, resets;
+
+    private:
+        Features doFeatures() const override { return Feature::Streaming; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        Buffer::Format doFormat() const override { return Buffer::Format::Mono8; }
+        UnsignedInt doFrequency() const override { return 44100; }
+        Containers::Array<char> doData() override { return nullptr; }
+
+        std::size_t doStreamData(Containers::ArrayView<char> buffer) override {
+            const std::size_t size = std::min(buffer.size(), _data.size() - _offset);
+            std::copy(_data.begin() + _offset, _data.begin() + _offset + size, buffer.begin());
+            _offset += size;
+            streamed += size;
+            return size;
+        }
+
+        void doResetStream() override {
+            _offset = 0;
+            ++resets;
+        }
+
+        Containers::Array<char> _data;
+        std::size_t _offset;
+};
+
+template<class F> bool waitFor(F condition) {
+    for(std::size_t i = 0; i != 1000; ++i) {
+        if(condition()) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds{5});
+    }
+    return false;
+}
+
+}
+
+void StreamALTest::construct() {
+    MemoryImporter importer{10000};
+    Source source;
+    Stream stream{source, importer, 3, 1024};
+
+    CORRADE_COMPARE(&stream.source(), &source);
+    CORRADE_COMPARE(&stream.importer(), &importer);
+    CORRADE_COMPARE(stream.bufferCount(), 3);
+    CORRADE_COMPARE(stream.bufferSize(), 1024);
+    CORRADE_VERIFY(!stream.isLooping());
+    CORRADE_VERIFY(stream.isFinished());
+}
+
+void StreamALTest::play() {
+    MemoryImporter importer{10000};
+    Source source;
+    Stream stream{source, importer, 3, 1024};
+
+    /* All buffers are filled upfront */
+    stream.play();
+    CORRADE_COMPARE(importer.streamed, 3*1024);
+    CORRADE_COMPARE(source.buffersQueued(), 3);
+    CORRADE_VERIFY(!stream.isFinished());
+
+    /* The whole stream gets played through the ring */
+    CORRADE_VERIFY(waitFor([&stream]() {
+        stream.update();
+        return stream.isFinished();
+    }));
+    CORRADE_COMPARE(importer.streamed, 10000);
+    CORRADE_COMPARE(importer.resets, 1);
+}
+
+void StreamALTest::playShort() {
+    MemoryImporter importer{1500};
+    Source source;
+    Stream stream{source, importer, 4, 1024};
+
+    /* Only as many buffers as needed are queued */
+    stream.play();
+    CORRADE_COMPARE(source.buffersQueued(), 2);
+
+    CORRADE_VERIFY(waitFor([&stream]() {
+        stream.update();
+        return stream.isFinished();
+    }));
+    CORRADE_COMPARE(importer.streamed, 1500);
+}
+
+void StreamALTest::looping() {
+    MemoryImporter importer{2000};
+    Source source;
+    Stream stream{source, importer, 3, 1024};
+    stream.setLooping(true);
+    CORRADE_VERIFY(stream.isLooping());
+
+    /* Plays until the stream gets restarted a few times */
+    stream.play();
+    CORRADE_VERIFY(waitFor([&stream, &importer]() {
+        stream.update();
+        return importer.resets > 3;
+    }));
+    CORRADE_VERIFY(!stream.isFinished());
+    CORRADE_COMPARE(source.buffersQueued(), 3);
+}
+
+void StreamALTest::stop() {
+    MemoryImporter importer{100000};
+    Source source;
+    Stream stream{source, importer, 3, 1024};
+
+    stream.play();
+    stream.stop();
+    CORRADE_VERIFY(stream.isFinished());
+    CORRADE_COMPARE(source.buffersQueued(), 0);
+    CORRADE_COMPARE(stream.update(), 0);
+
+    /* Playing again starts from the beginning */
+    stream.play();
+    CORRADE_COMPARE(importer.resets, 2);
+    CORRADE_COMPARE(source.buffersQueued(), 3);
+}
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+void StreamALTest::backgroundUpdate() {
+    MemoryImporter importer{10000};
+    Source source;
+    Stream stream{source, importer, 3, 1024};
+    CORRADE_VERIFY(!stream.isUpdatingInBackground());
+
+    stream.play();
+    stream.startBackgroundUpdate(std::chrono::milliseconds{1});
+    CORRADE_VERIFY(stream.isUpdatingInBackground());
+
+    CORRADE_VERIFY(waitFor([&stream]() { return stream.isFinished(); }));
+    CORRADE_COMPARE(importer.streamed, 10000);
+
+    stream.stopBackgroundUpdate();
+    CORRADE_VERIFY(!stream.isUpdatingInBackground());
+}
+#endif
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Audio::Test::StreamALTest)
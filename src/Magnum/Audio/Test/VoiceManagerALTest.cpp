@@ -0,0 +1,222 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Audio/Buffer.h"
+#include "Magnum/Audio/Context.h"
+#include "Magnum/Audio/VoiceManager.h"
+
+namespace Magnum { namespace Audio { namespace Test {
+
+struct VoiceManagerALTest: TestSuite::Tester {
+    explicit VoiceManagerALTest();
+
+    void construct();
+    void play();
+    void stop();
+    void staleHandle();
+    void virtualize();
+    void priority();
+    void virtualVoiceFinished();
+    void virtualVoiceLooping();
+
+    Context _context;
+};
+
+VoiceManagerALTest::VoiceManagerALTest() {
+    addTests({&VoiceManagerALTest::construct,
+              &VoiceManagerALTest::play,
+              &VoiceManagerALTest::stop,
+              &VoiceManagerALTest::staleHandle,
+              &VoiceManagerALTest::virtualize,
+              &VoiceManagerALTest::priority,
+              &VoiceManagerALTest::virtualVoiceFinished,
+              &VoiceManagerALTest::virtualVoiceLooping});
+}
+
+namespace {
+    /* One second of 8-bit mono at 22.05 kHz */
+    void setOneSecond(Buffer& buffer) {
+        std::vector<char> data(22050);
+        buffer.setData(Buffer::Format::Mono8, {data.data(), data.size()}, 22050);
+    }
+}
+
+void VoiceManagerALTest::construct() {
+    VoiceManager voices{4};
+    CORRADE_COMPARE(voices.sourceCount(), 4);
+    CORRADE_COMPARE(voices.voiceCount(), 0);
+    CORRADE_COMPARE(voices.realVoiceCount(), 0);
+}
+
+void VoiceManagerALTest::play() {
+    Buffer buffer;
+    setOneSecond(buffer);
+
+    VoiceManager voices{2};
+    const UnsignedInt voice = voices.play(buffer);
+    CORRADE_VERIFY(voice);
+    CORRADE_VERIFY(voices.isPlaying(voice));
+    CORRADE_COMPARE(voices.voiceCount(), 1);
+
+    /* Sources are assigned only on update */
+    CORRADE_VERIFY(voices.isVirtual(voice));
+    voices.update(0.0f);
+    CORRADE_VERIFY(!voices.isVirtual(voice));
+    CORRADE_COMPARE(voices.realVoiceCount(), 1);
+    CORRADE_COMPARE(voices.audibility(voice), 1.0f);
+}
+
+void VoiceManagerALTest::stop() {
+    Buffer buffer;
+    setOneSecond(buffer);
+
+    VoiceManager voices{2};
+    const UnsignedInt a = voices.play(buffer);
+    const UnsignedInt b = voices.play(buffer);
+    voices.update(0.0f);
+    CORRADE_COMPARE(voices.realVoiceCount(), 2);
+
+    voices.stop(a);
+    CORRADE_VERIFY(!voices.isPlaying(a));
+    CORRADE_COMPARE(voices.voiceCount(), 1);
+    CORRADE_COMPARE(voices.realVoiceCount(), 1);
+
+    voices.stopAll();
+    CORRADE_VERIFY(!voices.isPlaying(b));
+    CORRADE_COMPARE(voices.voiceCount(), 0);
+    CORRADE_COMPARE(voices.realVoiceCount(), 0);
+}
+
+void VoiceManagerALTest::staleHandle() {
+    Buffer buffer;
+    setOneSecond(buffer);
+
+    VoiceManager voices{1};
+    const UnsignedInt a = voices.play(buffer);
+    voices.stop(a);
+
+    /* The slot is reused, but the old handle doesn't refer to the new voice */
+    const UnsignedInt b = voices.play(buffer);
+    CORRADE_VERIFY(a != b);
+    CORRADE_VERIFY(!voices.isPlaying(a));
+    CORRADE_VERIFY(voices.isPlaying(b));
+
+    /* Operations on stale handles are no-ops */
+    voices.setGain(a, 0.5f).stop(a);
+    CORRADE_VERIFY(voices.isPlaying(b));
+}
+
+void VoiceManagerALTest::virtualize() {
+    Buffer buffer;
+    setOneSecond(buffer);
+
+    VoiceManager voices{1};
+    const UnsignedInt near = voices.play(buffer);
+    const UnsignedInt far = voices.play(buffer);
+    voices.setPosition(near, {0.0f, 0.0f, 1.0f})
+          .setPosition(far, {0.0f, 0.0f, 9.0f});
+    voices.update(0.0f);
+
+    CORRADE_COMPARE(voices.voiceCount(), 2);
+    CORRADE_COMPARE(voices.realVoiceCount(), 1);
+    CORRADE_VERIFY(!voices.isVirtual(near));
+    CORRADE_VERIFY(voices.isVirtual(far));
+    CORRADE_COMPARE(voices.audibility(far), 1.0f/9.0f);
+
+    /* Swap the positions, the source moves to the other voice and the
+       virtual voice keeps its advanced offset */
+    voices.setPosition(near, {0.0f, 0.0f, 9.0f})
+          .setPosition(far, {0.0f, 0.0f, 1.0f});
+    voices.update(0.25f);
+    CORRADE_VERIFY(voices.isVirtual(near));
+    CORRADE_VERIFY(!voices.isVirtual(far));
+    CORRADE_COMPARE(voices.realVoiceCount(), 1);
+}
+
+void VoiceManagerALTest::priority() {
+    Buffer buffer;
+    setOneSecond(buffer);
+
+    VoiceManager voices{1};
+    const UnsignedInt loud = voices.play(buffer, 0);
+    const UnsignedInt important = voices.play(buffer, 5);
+    voices.setGain(important, 0.1f);
+    voices.update(0.0f);
+
+    /* Higher priority wins even if quieter */
+    CORRADE_VERIFY(voices.isVirtual(loud));
+    CORRADE_VERIFY(!voices.isVirtual(important));
+
+    voices.setPriority(loud, 10);
+    voices.update(0.0f);
+    CORRADE_VERIFY(!voices.isVirtual(loud));
+    CORRADE_VERIFY(voices.isVirtual(important));
+}
+
+void VoiceManagerALTest::virtualVoiceFinished() {
+    Buffer buffer;
+    setOneSecond(buffer);
+
+    VoiceManager voices{1};
+    const UnsignedInt a = voices.play(buffer, 1);
+    const UnsignedInt b = voices.play(buffer);
+    voices.update(0.0f);
+    CORRADE_VERIFY(voices.isVirtual(b));
+
+    voices.update(0.5f);
+    CORRADE_VERIFY(voices.isPlaying(b));
+    CORRADE_COMPARE(voices.offsetInSeconds(b), 0.5f);
+
+    /* Virtual voice reaching the end is removed */
+    voices.stop(a);
+    voices.update(0.6f);
+    CORRADE_VERIFY(!voices.isPlaying(b));
+    CORRADE_COMPARE(voices.voiceCount(), 0);
+}
+
+void VoiceManagerALTest::virtualVoiceLooping() {
+    Buffer buffer;
+    setOneSecond(buffer);
+
+    VoiceManager voices{1};
+    voices.play(buffer, 1);
+    const UnsignedInt b = voices.play(buffer);
+    voices.setLooping(b, true)
+          .setPitch(b, 2.0f);
+    voices.update(0.0f);
+    CORRADE_VERIFY(voices.isVirtual(b));
+
+    /* Offset advances by pitch and wraps around */
+    voices.update(0.75f);
+    CORRADE_VERIFY(voices.isPlaying(b));
+    CORRADE_COMPARE(voices.offsetInSeconds(b), 0.5f);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Audio::Test::VoiceManagerALTest)
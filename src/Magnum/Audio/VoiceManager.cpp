@@ -0,0 +1,271 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "VoiceManager.h"
+
+#include <algorithm>
+#include <cmath>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Audio/Buffer.h"
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace Audio {
+
+namespace {
+    /* Lower 16 bits are index plus one, upper 16 bits are generation of the
+       slot, so the handle is never zero and handles of removed voices are not
+       reused until the generation wraps around */
+    constexpr UnsignedInt MaxVoiceCount = 0xffff;
+
+    inline UnsignedInt voiceHandle(const std::size_t index, const UnsignedShort generation) {
+        return (UnsignedInt(generation) << 16)|UnsignedInt(index + 1);
+    }
+}
+
+VoiceManager::VoiceManager(const UnsignedInt sourceCount): _sourceVoices(sourceCount, -1) {
+    _sources.reserve(sourceCount);
+    for(UnsignedInt i = 0; i != sourceCount; ++i) _sources.emplace_back();
+}
+
+VoiceManager::VoiceManager(VoiceManager&&) noexcept = default;
+
+VoiceManager::~VoiceManager() { stopAll(); }
+
+VoiceManager& VoiceManager::operator=(VoiceManager&&) noexcept = default;
+
+UnsignedInt VoiceManager::realVoiceCount() const {
+    return std::count_if(_sourceVoices.begin(), _sourceVoices.end(), [](Int voice) { return voice != -1; });
+}
+
+auto VoiceManager::find(const UnsignedInt voice) -> Voice* {
+    const std::size_t index = (voice & 0xffff) - 1;
+    if(index >= _voices.size()) return nullptr;
+    Voice& v = _voices[index];
+    return v.playing && v.generation == voice >> 16 ? &v : nullptr;
+}
+
+auto VoiceManager::find(const UnsignedInt voice) const -> const Voice* {
+    return const_cast<VoiceManager&>(*this).find(voice);
+}
+
+UnsignedInt VoiceManager::play(Buffer& buffer, const Int priority) {
+    std::size_t index;
+    if(!_free.empty()) {
+        index = _free.back();
+        _free.pop_back();
+    } else {
+        CORRADE_ASSERT(_voices.size() < MaxVoiceCount,
+            "Audio::VoiceManager::play(): can't have more than" << MaxVoiceCount << "voices", 0);
+        index = _voices.size();
+        _voices.push_back(Voice{});
+    }
+
+    Voice& v = _voices[index];
+    const UnsignedShort generation = v.generation;
+    v = Voice{&buffer, priority, 1.0f, 1.0f, 1.0f, 1.0f, Constants::inf(), {}, buffer.duration(), 0.0f, 0.0f, -1, generation, true, false, false};
+    ++_voiceCount;
+    return voiceHandle(index, generation);
+}
+
+void VoiceManager::detach(Voice& voice) {
+    Source& source = _sources[voice.source];
+    voice.offset = source.offsetInSeconds();
+    source.stop();
+    source.setBuffer(nullptr);
+    _sourceVoices[voice.source] = -1;
+    voice.source = -1;
+}
+
+void VoiceManager::attach(Voice& voice, const Int source) {
+    _sources[source].setBuffer(voice.buffer)
+        .setGain(voice.gain)
+        .setPitch(voice.pitch)
+        .setPosition(voice.position)
+        .setRelative(voice.relative)
+        .setLooping(voice.looping)
+        .setReferenceDistance(voice.referenceDistance)
+        .setRolloffFactor(voice.rolloffFactor)
+        .setMaxDistance(voice.maxDistance)
+        .setOffsetInSeconds(voice.offset)
+        .play();
+    _sourceVoices[source] = &voice - _voices.data();
+    voice.source = source;
+}
+
+void VoiceManager::release(Voice& voice) {
+    if(voice.source != -1) detach(voice);
+    voice.playing = false;
+    ++voice.generation;
+    _free.push_back(&voice - _voices.data());
+    --_voiceCount;
+}
+
+void VoiceManager::stop(const UnsignedInt voice) {
+    if(Voice* v = find(voice)) release(*v);
+}
+
+void VoiceManager::stopAll() {
+    for(Voice& voice: _voices) if(voice.playing) release(voice);
+}
+
+bool VoiceManager::isPlaying(const UnsignedInt voice) const {
+    return find(voice);
+}
+
+bool VoiceManager::isVirtual(const UnsignedInt voice) const {
+    const Voice* v = find(voice);
+    return v && v->source == -1;
+}
+
+Float VoiceManager::offsetInSeconds(const UnsignedInt voice) const {
+    const Voice* v = find(voice);
+    if(!v) return 0.0f;
+    return v->source == -1 ? v->offset : _sources[v->source].offsetInSeconds();
+}
+
+Float VoiceManager::audibility(const UnsignedInt voice) const {
+    const Voice* v = find(voice);
+    return v ? v->audibility : 0.0f;
+}
+
+VoiceManager& VoiceManager::setPriority(const UnsignedInt voice, const Int priority) {
+    if(Voice* v = find(voice)) v->priority = priority;
+    return *this;
+}
+
+VoiceManager& VoiceManager::setPosition(const UnsignedInt voice, const Vector3& position) {
+    if(Voice* v = find(voice)) {
+        v->position = position;
+        if(v->source != -1) _sources[v->source].setPosition(position);
+    }
+    return *this;
+}
+
+VoiceManager& VoiceManager::setRelative(const UnsignedInt voice, const bool relative) {
+    if(Voice* v = find(voice)) {
+        v->relative = relative;
+        if(v->source != -1) _sources[v->source].setRelative(relative);
+    }
+    return *this;
+}
+
+VoiceManager& VoiceManager::setGain(const UnsignedInt voice, const Float gain) {
+    if(Voice* v = find(voice)) {
+        v->gain = gain;
+        if(v->source != -1) _sources[v->source].setGain(gain);
+    }
+    return *this;
+}
+
+VoiceManager& VoiceManager::setPitch(const UnsignedInt voice, const Float pitch) {
+    if(Voice* v = find(voice)) {
+        v->pitch = pitch;
+        if(v->source != -1) _sources[v->source].setPitch(pitch);
+    }
+    return *this;
+}
+
+VoiceManager& VoiceManager::setLooping(const UnsignedInt voice, const bool looping) {
+    if(Voice* v = find(voice)) {
+        v->looping = looping;
+        if(v->source != -1) _sources[v->source].setLooping(looping);
+    }
+    return *this;
+}
+
+VoiceManager& VoiceManager::setAttenuation(const UnsignedInt voice, const Float referenceDistance, const Float rolloffFactor, const Float maxDistance) {
+    if(Voice* v = find(voice)) {
+        v->referenceDistance = referenceDistance;
+        v->rolloffFactor = rolloffFactor;
+        v->maxDistance = maxDistance;
+        if(v->source != -1) _sources[v->source]
+            .setReferenceDistance(referenceDistance)
+            .setRolloffFactor(rolloffFactor)
+            .setMaxDistance(maxDistance);
+    }
+    return *this;
+}
+
+void VoiceManager::update(const Float timeDelta, const Vector3& listenerPosition) {
+    _order.clear();
+
+    for(Voice& voice: _voices) {
+        if(!voice.playing) continue;
+
+        /* Remove finished voices. Real voices are finished when the source
+           stops, virtual ones when the advanced offset reaches the end */
+        if(voice.source != -1) {
+            if(_sources[voice.source].state() == Source::State::Stopped) {
+                release(voice);
+                continue;
+            }
+        } else {
+            voice.offset += timeDelta*voice.pitch;
+            if(voice.offset >= voice.duration) {
+                if(!voice.looping || voice.duration <= 0.0f) {
+                    release(voice);
+                    continue;
+                }
+                voice.offset = std::fmod(voice.offset, voice.duration);
+            }
+        }
+
+        /* Inverse clamped distance attenuation */
+        const Float distance = (voice.relative ? voice.position : voice.position - listenerPosition).length();
+        const Float clamped = Math::clamp(distance, voice.referenceDistance, voice.maxDistance);
+        const Float denominator = voice.referenceDistance + voice.rolloffFactor*(clamped - voice.referenceDistance);
+        voice.audibility = voice.gain*(denominator > 0.0f ? voice.referenceDistance/denominator : 1.0f);
+
+        /* Inaudible voices never get a source */
+        if(voice.audibility > 0.0f) _order.push_back(&voice - _voices.data());
+        else if(voice.source != -1) detach(voice);
+    }
+
+    /* Select the most important voices, higher priority first, louder
+       first */
+    const std::size_t realCount = std::min(_order.size(), _sources.size());
+    std::nth_element(_order.begin(), _order.begin() + realCount, _order.end(), [this](UnsignedInt a, UnsignedInt b) {
+        const Voice& va = _voices[a];
+        const Voice& vb = _voices[b];
+        return va.priority > vb.priority || (va.priority == vb.priority && va.audibility > vb.audibility);
+    });
+
+    /* First take sources away from voices that aren't selected anymore, then
+       give the freed sources to newly selected voices */
+    for(std::size_t i = realCount; i < _order.size(); ++i) {
+        Voice& voice = _voices[_order[i]];
+        if(voice.source != -1) detach(voice);
+    }
+    std::size_t freeSource = 0;
+    for(std::size_t i = 0; i != realCount; ++i) {
+        Voice& voice = _voices[_order[i]];
+        if(voice.source != -1) continue;
+        while(_sourceVoices[freeSource] != -1) ++freeSource;
+        attach(voice, freeSource);
+    }
+}
+
+}}
@@ -0,0 +1,288 @@
+#ifndef Magnum_Audio_VoiceManager_h
+#define Magnum_Audio_VoiceManager_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+    Copyright © 2015 Jonathan Hale <squareys@googlemail.com>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Audio::VoiceManager
+ */
+
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Audio/Audio.h"
+#include "Magnum/Audio/Source.h"
+#include "Magnum/Audio/visibility.h"
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace Audio {
+
+/**
+@brief Voice manager
+
+OpenAL implementations support only a limited number of simultaneously
+playing sources, often as low as 32, and @ref Source::play() silently fails
+after the limit is exceeded. The voice manager owns a fixed pool of sources
+and lets the application play any number of *voices* on top of them. Only the
+most important voices get a real source, the others are *virtual* --- they
+aren't mixed, but their playback position is still advanced, so when they
+become important again, they are resumed at the right place.
+@code
+Audio::VoiceManager voices{32};
+
+// Each emitter gets its own voice
+UnsignedInt voice = voices.play(explosionBuffer, 10);
+voices.setPosition(voice, explosion.translation());
+
+// Every frame
+voices.update(timeDelta, listener.translation());
+@endcode
+
+## Voice selection
+
+In each @ref update(), the voices are ordered by priority given to
+@ref play() and then by audibility, which is the voice gain multiplied by
+distance attenuation. The attenuation follows
+@ref Renderer::DistanceModel::InverseClamped, the default OpenAL distance
+model, using the reference distance, rolloff factor and max distance set for
+each voice. The first @ref sourceCount() voices with non-zero audibility get
+a source, the others are virtualized.
+
+A voice that loses its source remembers the playback offset and stops the
+source, a voice that gets a source has the source set up with its buffer,
+properties and playback offset and is started. Finished non-looping voices
+are removed in @ref update() and their handles become invalid.
+
+## Voice handles
+
+@ref play() returns a non-zero handle that identifies the voice until it's
+stopped or finishes. Handles of removed voices are not reused for a long
+time, so it's safe to call any function with a handle of a removed voice ---
+setters do nothing and @ref isPlaying() returns `false`.
+*/
+class MAGNUM_AUDIO_EXPORT VoiceManager {
+    public:
+        /**
+         * @brief Constructor
+         * @param sourceCount   Count of OpenAL sources to create
+         *
+         * The sources are created upfront. The count should not exceed count
+         * of sources supported by the implementation, see
+         * @ref Context::Configuration::setMonoSourceCount().
+         */
+        explicit VoiceManager(UnsignedInt sourceCount);
+
+        /** @brief Copying is not allowed */
+        VoiceManager(const VoiceManager&) = delete;
+
+        /** @brief Move constructor */
+        VoiceManager(VoiceManager&&) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Stops all voices and deletes the sources.
+         */
+        ~VoiceManager();
+
+        /** @brief Copying is not allowed */
+        VoiceManager& operator=(const VoiceManager&) = delete;
+
+        /** @brief Move assignment */
+        VoiceManager& operator=(VoiceManager&&) noexcept;
+
+        /** @brief Count of OpenAL sources */
+        UnsignedInt sourceCount() const { return _sources.size(); }
+
+        /** @brief Count of playing voices */
+        UnsignedInt voiceCount() const { return _voiceCount; }
+
+        /**
+         * @brief Count of voices that have a source
+         *
+         * Updated in @ref update().
+         */
+        UnsignedInt realVoiceCount() const;
+
+        /**
+         * @brief Play a voice
+         * @param buffer    Buffer to play
+         * @param priority  Voice priority. Voices with higher priority get a
+         *      source before voices with lower priority, regardless of
+         *      audibility.
+         * @return Handle of the voice
+         *
+         * The voice has gain of `1.0f`, pitch of `1.0f`, reference distance
+         * of `1.0f`, rolloff factor of `1.0f`, infinite max distance and
+         * position at origin. It competes for a source on the next
+         * @ref update(). The buffer is expected to stay alive until the voice
+         * finishes or is stopped.
+         */
+        UnsignedInt play(Buffer& buffer, Int priority = 0);
+
+        /**
+         * @brief Stop a voice
+         *
+         * Stops the source, if any, and removes the voice. Does nothing if
+         * the handle is not valid.
+         */
+        void stop(UnsignedInt voice);
+
+        /** @brief Stop all voices */
+        void stopAll();
+
+        /**
+         * @brief Whether a voice is playing
+         *
+         * Returns `false` if the voice finished or was stopped.
+         */
+        bool isPlaying(UnsignedInt voice) const;
+
+        /**
+         * @brief Whether a voice is virtual
+         *
+         * Returns `true` if the voice doesn't have a source, `false` if it
+         * isn't playing.
+         */
+        bool isVirtual(UnsignedInt voice) const;
+
+        /**
+         * @brief Playback offset in seconds
+         *
+         * Returns `0.0f` if the voice isn't playing.
+         */
+        Float offsetInSeconds(UnsignedInt voice) const;
+
+        /**
+         * @brief Set voice priority
+         * @return Reference to self (for method chaining)
+         */
+        VoiceManager& setPriority(UnsignedInt voice, Int priority);
+
+        /**
+         * @brief Set voice position
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Source::setPosition()
+         */
+        VoiceManager& setPosition(UnsignedInt voice, const Vector3& position);
+
+        /**
+         * @brief Set whether voice position is relative to the listener
+         * @return Reference to self (for method chaining)
+         *
+         * Default is `false`.
+         * @see @ref Source::setRelative()
+         */
+        VoiceManager& setRelative(UnsignedInt voice, bool relative);
+
+        /**
+         * @brief Set voice gain
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Source::setGain()
+         */
+        VoiceManager& setGain(UnsignedInt voice, Float gain);
+
+        /**
+         * @brief Set voice pitch
+         * @return Reference to self (for method chaining)
+         *
+         * Affects also the speed at which playback position of virtual voices
+         * advances.
+         * @see @ref Source::setPitch()
+         */
+        VoiceManager& setPitch(UnsignedInt voice, Float pitch);
+
+        /**
+         * @brief Set whether the voice is looping
+         * @return Reference to self (for method chaining)
+         *
+         * Default is `false`.
+         * @see @ref Source::setLooping()
+         */
+        VoiceManager& setLooping(UnsignedInt voice, bool looping);
+
+        /**
+         * @brief Set voice distance attenuation
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Source::setReferenceDistance(),
+         *      @ref Source::setRolloffFactor(), @ref Source::setMaxDistance()
+         */
+        VoiceManager& setAttenuation(UnsignedInt voice, Float referenceDistance, Float rolloffFactor, Float maxDistance);
+
+        /**
+         * @brief Voice audibility
+         *
+         * Gain multiplied by distance attenuation, computed in the last
+         * @ref update(). Returns `0.0f` if the voice isn't playing.
+         */
+        Float audibility(UnsignedInt voice) const;
+
+        /**
+         * @brief Update the voices
+         * @param timeDelta         Time since last update in seconds
+         * @param listenerPosition  Listener position
+         *
+         * Advances playback position of virtual voices, removes finished
+         * voices and redistributes the sources, see the class documentation
+         * for details. Call once per frame.
+         */
+        void update(Float timeDelta, const Vector3& listenerPosition = {});
+
+    private:
+        struct Voice {
+            Buffer* buffer;
+            Int priority;
+            Float gain, pitch, referenceDistance, rolloffFactor, maxDistance;
+            Vector3 position;
+            Float duration, offset, audibility;
+            /* Index into _sources or -1 if virtual */
+            Int source;
+            UnsignedShort generation;
+            bool playing, looping, relative;
+        };
+
+        Voice* find(UnsignedInt voice);
+        const Voice* find(UnsignedInt voice) const;
+        void release(Voice& voice);
+        void detach(Voice& voice);
+        void attach(Voice& voice, Int source);
+
+        std::vector<Source> _sources;
+        /* Voice using given source or -1 */
+        std::vector<Int> _sourceVoices;
+        std::vector<Voice> _voices;
+        std::vector<UnsignedInt> _free;
+        /* Scratch array for voice selection */
+        std::vector<UnsignedInt> _order;
+        UnsignedInt _voiceCount{};
+};
+
+}}
+
+#endif
@@ -30,12 +30,15 @@
 
 #include "Magnum/Context.h"
 #include "Magnum/Extensions.h"
+#include "Magnum/Instrumentation.h"
 
 #include "Implementation/State.h"
 #include "Implementation/BufferState.h"
+#include "Implementation/DeletionState.h"
 #ifndef MAGNUM_TARGET_WEBGL
 #include "Implementation/DebugState.h"
 #endif
+#include "Implementation/MemoryState.h"
 #include "Implementation/MeshState.h"
 
 namespace Magnum {
@@ -206,17 +209,47 @@ void Buffer::createImplementationDSA() {
 }
 #endif
 
+std::vector<Buffer> Buffer::createArray(const std::size_t count, const TargetHint targetHint) {
+    std::vector<GLuint> ids(count);
+    ObjectFlags flags = ObjectFlag::DeleteOnDestruction;
+    #ifndef MAGNUM_TARGET_GLES
+    if(Context::current().state().buffer->createImplementation == &Buffer::createImplementationDSA) {
+        glCreateBuffers(count, ids.data());
+        flags |= ObjectFlag::Created;
+    } else
+    #endif
+    {
+        glGenBuffers(count, ids.data());
+    }
+
+    std::vector<Buffer> buffers;
+    buffers.reserve(count);
+    for(const GLuint id: ids) buffers.push_back(Buffer{id, targetHint, flags});
+    return buffers;
+}
+
 Buffer::~Buffer() {
     /* Moved out or not deleting on destruction, nothing to do */
     if(!_id || !(_flags & ObjectFlag::DeleteOnDestruction)) return;
 
+    Implementation::DeletionState& deletion = *Context::current().state().deletion;
+    if(deletion.deferred) deletion.buffers.push_back(_id);
+    else deleteInternal({&_id, 1});
+}
+
+void Buffer::deleteInternal(const Containers::ArrayView<const GLuint> ids) {
     GLuint* bindings = Context::current().state().buffer->bindings;
+    Implementation::MemoryState& memory = *Context::current().state().memory;
 
     /* Remove all current bindings from the state */
-    for(std::size_t i = 1; i != Implementation::BufferState::TargetCount; ++i)
-        if(bindings[i] == _id) bindings[i] = 0;
+    for(const GLuint id: ids) {
+        for(std::size_t i = 1; i != Implementation::BufferState::TargetCount; ++i)
+            if(bindings[i] == id) bindings[i] = 0;
+
+        memory.remove(Implementation::MemoryState::Type::Buffer, id);
+    }
 
-    glDeleteBuffers(1, &_id);
+    glDeleteBuffers(ids.size(), ids.data());
 }
 
 inline void Buffer::createIfNotAlready() {
@@ -248,6 +281,7 @@ Buffer& Buffer::setLabelInternal(const Containers::ArrayView<const char> label)
     #else
     Context::current().state().debug->labelImplementation(GL_BUFFER_KHR, _id, label);
     #endif
+    Context::current().state().memory->setLabel(Implementation::MemoryState::Type::Buffer, _id, label);
     return *this;
 }
 #endif
@@ -341,12 +375,23 @@ Int Buffer::size() {
     return size;
 }
 
+#ifndef MAGNUM_TARGET_GLES
+Buffer& Buffer::setStorage(const Containers::ArrayView<const void> data, const StorageFlags flags) {
+    (this->*Context::current().state().buffer->storageImplementation)(data.size(), data, flags);
+    Context::current().state().memory->setSize(Implementation::MemoryState::Type::Buffer, _id, data.size());
+    return *this;
+}
+#endif
+
 Buffer& Buffer::setData(const Containers::ArrayView<const void> data, const BufferUsage usage) {
+    MAGNUM_INSTRUMENT_COUNT(Instrumentation::Counter::BufferUploadBytes, data.data() ? data.size() : 0);
     (this->*Context::current().state().buffer->dataImplementation)(data.size(), data, usage);
+    Context::current().state().memory->setSize(Implementation::MemoryState::Type::Buffer, _id, data.size());
     return *this;
 }
 
 Buffer& Buffer::setSubData(const GLintptr offset, const Containers::ArrayView<const void> data) {
+    MAGNUM_INSTRUMENT_COUNT(Instrumentation::Counter::BufferUploadBytes, data.size());
     (this->*Context::current().state().buffer->subDataImplementation)(offset, data.size(), data);
     return *this;
 }
@@ -503,6 +548,21 @@ void Buffer::getSubDataImplementationDSAEXT(const GLintptr offset, const GLsizei
 }
 #endif
 
+#ifndef MAGNUM_TARGET_GLES
+void Buffer::storageImplementationDefault(GLsizeiptr size, const GLvoid* data, StorageFlags flags) {
+    glBufferStorage(GLenum(bindSomewhereInternal(_targetHint)), size, data, GLbitfield(flags));
+}
+
+void Buffer::storageImplementationDSA(const GLsizeiptr size, const GLvoid* const data, const StorageFlags flags) {
+    glNamedBufferStorage(_id, size, data, GLbitfield(flags));
+}
+
+void Buffer::storageImplementationDSAEXT(GLsizeiptr size, const GLvoid* data, StorageFlags flags) {
+    _flags |= ObjectFlag::Created;
+    glNamedBufferStorageEXT(_id, size, data, GLbitfield(flags));
+}
+#endif
+
 void Buffer::dataImplementationDefault(GLsizeiptr size, const GLvoid* data, BufferUsage usage) {
     glBufferData(GLenum(bindSomewhereInternal(_targetHint)), size, data, GLenum(usage));
 }
@@ -227,6 +227,7 @@ by OpenGL in order to preserve the data. If running on OpenGL ES or extension
 functions do nothing.
  */
 class MAGNUM_EXPORT Buffer: public AbstractObject {
+    friend Context;
     friend Implementation::BufferState;
 
     public:
@@ -590,9 +591,32 @@ class MAGNUM_EXPORT Buffer: public AbstractObject {
              * before mapping.
              */
             #ifndef MAGNUM_TARGET_GLES2
-            Unsynchronized = GL_MAP_UNSYNCHRONIZED_BIT
+            Unsynchronized = GL_MAP_UNSYNCHRONIZED_BIT,
             #else
-            Unsynchronized = GL_MAP_UNSYNCHRONIZED_BIT_EXT
+            Unsynchronized = GL_MAP_UNSYNCHRONIZED_BIT_EXT,
+            #endif
+
+            #ifndef MAGNUM_TARGET_GLES
+            /**
+             * Allow the buffer to stay mapped while being used by OpenGL. The
+             * buffer storage must be created with @ref setStorage() and
+             * @ref StorageFlag::MapPersistent.
+             * @requires_gl44 Extension @extension{ARB,buffer_storage}
+             * @requires_gl Persistent mapping is not available in OpenGL ES
+             *      and WebGL.
+             */
+            Persistent = GL_MAP_PERSISTENT_BIT,
+
+            /**
+             * Make writes to persistently mapped range visible to OpenGL
+             * without explicit flush or memory barrier. The buffer storage
+             * must be created with @ref setStorage() and
+             * @ref StorageFlag::MapCoherent.
+             * @requires_gl44 Extension @extension{ARB,buffer_storage}
+             * @requires_gl Coherent mapping is not available in OpenGL ES
+             *      and WebGL.
+             */
+            Coherent = GL_MAP_COHERENT_BIT
             #endif
         };
 
@@ -608,6 +632,49 @@ class MAGNUM_EXPORT Buffer: public AbstractObject {
         typedef Containers::EnumSet<MapFlag> MapFlags;
         #endif
 
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Immutable storage flag
+         *
+         * @see @ref StorageFlags, @ref setStorage()
+         * @requires_gl44 Extension @extension{ARB,buffer_storage}
+         * @requires_gl Immutable buffer storage is not available in OpenGL ES
+         *      and WebGL.
+         */
+        enum class StorageFlag: GLbitfield {
+            /** Allow mapping the buffer with @ref MapFlag::Read. */
+            MapRead = GL_MAP_READ_BIT,
+
+            /** Allow mapping the buffer with @ref MapFlag::Write. */
+            MapWrite = GL_MAP_WRITE_BIT,
+
+            /** Allow mapping the buffer with @ref MapFlag::Persistent. */
+            MapPersistent = GL_MAP_PERSISTENT_BIT,
+
+            /** Allow mapping the buffer with @ref MapFlag::Coherent. */
+            MapCoherent = GL_MAP_COHERENT_BIT,
+
+            /**
+             * Allow updating the buffer contents using @ref setSubData().
+             * The contents can be always changed through mapping or copying.
+             */
+            DynamicStorage = GL_DYNAMIC_STORAGE_BIT,
+
+            /** Prefer to allocate the storage in client memory. */
+            ClientStorage = GL_CLIENT_STORAGE_BIT
+        };
+
+        /**
+         * @brief Immutable storage flags
+         *
+         * @see @ref setStorage()
+         * @requires_gl44 Extension @extension{ARB,buffer_storage}
+         * @requires_gl Immutable buffer storage is not available in OpenGL ES
+         *      and WebGL.
+         */
+        typedef Containers::EnumSet<StorageFlag> StorageFlags;
+        #endif
+
         #ifndef MAGNUM_TARGET_GLES
         /**
          * @brief Minimal supported mapping alignment
@@ -844,6 +911,20 @@ class MAGNUM_EXPORT Buffer: public AbstractObject {
             return Buffer(id, TargetHint::Array, flags);
         }
 
+        /**
+         * @brief Create multiple buffers at once
+         * @param count         Buffer count
+         * @param targetHint    Target hint, see @ref setTargetHint() for more
+         *      information
+         *
+         * Equivalent to calling @ref Buffer(TargetHint) @p count times, but
+         * all OpenGL objects are created with a single call, which is faster
+         * when creating a lot of buffers at once, for example when loading a
+         * scene.
+         * @see @fn_gl{CreateBuffers}, eventually @fn_gl{GenBuffers}
+         */
+        static std::vector<Buffer> createArray(std::size_t count, TargetHint targetHint = TargetHint::Array);
+
         /**
          * @brief Constructor
          * @param targetHint    Target hint, see @ref setTargetHint() for more
@@ -888,7 +969,9 @@ class MAGNUM_EXPORT Buffer: public AbstractObject {
         /**
          * @brief Destructor
          *
-         * Deletes associated OpenGL buffer object.
+         * Deletes associated OpenGL buffer object. If
+         * @ref Context::setDeletionDeferred() "deferred deletion" is
+         * enabled, the object is only queued for deletion.
          * @see @ref wrap(), @ref release(), @fn_gl{DeleteBuffers}
          */
         ~Buffer();
@@ -1096,6 +1179,47 @@ class MAGNUM_EXPORT Buffer: public AbstractObject {
         template<class T = char> inline Containers::Array<T> subData(GLintptr offset, GLsizeiptr size);
         #endif
 
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Set immutable buffer storage
+         * @param data      Data. Pass `nullptr` with desired size to only
+         *      allocate the storage.
+         * @param flags     Storage flags
+         * @return Reference to self (for method chaining)
+         *
+         * After calling this function the buffer size and flags can't be
+         * changed anymore and calling @ref setData() or calling
+         * @ref setStorage() again is an error. Unlike with @ref setData(),
+         * the driver isn't allowed to reallocate the storage behind your
+         * back, which together with @ref StorageFlag::MapPersistent and
+         * @ref StorageFlag::MapCoherent allows the buffer to stay mapped for
+         * its whole lifetime. If neither @extension{ARB,direct_state_access}
+         * (part of OpenGL 4.5) nor @extension{EXT,direct_state_access}
+         * desktop extension is available, the buffer is bound to hinted
+         * target before the operation (if not already).
+         * @see @ref setTargetHint(), @ref map(GLintptr, GLsizeiptr, MapFlags),
+         *      @ref BufferRing, @fn_gl2{NamedBufferStorage,BufferStorage},
+         *      @fn_gl_extension{NamedBufferStorage,EXT,direct_state_access},
+         *      eventually @fn_gl{BindBuffer} and @fn_gl{BufferStorage}
+         * @requires_gl44 Extension @extension{ARB,buffer_storage}
+         * @requires_gl Immutable buffer storage is not available in OpenGL ES
+         *      and WebGL, use @ref setData() instead.
+         */
+        Buffer& setStorage(Containers::ArrayView<const void> data, StorageFlags flags);
+
+        /** @overload */
+        template<class T> Buffer& setStorage(const std::vector<T>& data, StorageFlags flags) {
+            setStorage({data.data(), data.size()}, flags);
+            return *this;
+        }
+
+        /** @overload */
+        template<std::size_t size, class T> Buffer& setStorage(const std::array<T, size>& data, StorageFlags flags) {
+            setStorage({data.data(), data.size()}, flags);
+            return *this;
+        }
+        #endif
+
         /**
          * @brief Set buffer data
          * @param data      Data
@@ -1358,6 +1482,10 @@ class MAGNUM_EXPORT Buffer: public AbstractObject {
         void MAGNUM_LOCAL createImplementationDSA();
         #endif
 
+        /* Removes the buffers from the state tracker and deletes them, used
+           by the destructor and Context::flushDeletions() */
+        static void MAGNUM_LOCAL deleteInternal(Containers::ArrayView<const GLuint> ids);
+
         void MAGNUM_LOCAL createIfNotAlready();
 
         #ifndef MAGNUM_TARGET_WEBGL
@@ -1380,6 +1508,12 @@ class MAGNUM_EXPORT Buffer: public AbstractObject {
         void MAGNUM_LOCAL getSubDataImplementationDSAEXT(GLintptr offset, GLsizeiptr size, GLvoid* data);
         #endif
 
+        #ifndef MAGNUM_TARGET_GLES
+        void MAGNUM_LOCAL storageImplementationDefault(GLsizeiptr size, const GLvoid* data, StorageFlags flags);
+        void MAGNUM_LOCAL storageImplementationDSA(GLsizeiptr size, const GLvoid* data, StorageFlags flags);
+        void MAGNUM_LOCAL storageImplementationDSAEXT(GLsizeiptr size, const GLvoid* data, StorageFlags flags);
+        #endif
+
         void MAGNUM_LOCAL dataImplementationDefault(GLsizeiptr size, const GLvoid* data, BufferUsage usage);
         #ifndef MAGNUM_TARGET_GLES
         void MAGNUM_LOCAL dataImplementationDSA(GLsizeiptr size, const GLvoid* data, BufferUsage usage);
@@ -1439,6 +1573,9 @@ class MAGNUM_EXPORT Buffer: public AbstractObject {
 #ifndef MAGNUM_TARGET_WEBGL
 CORRADE_ENUMSET_OPERATORS(Buffer::MapFlags)
 #endif
+#ifndef MAGNUM_TARGET_GLES
+CORRADE_ENUMSET_OPERATORS(Buffer::StorageFlags)
+#endif
 
 /** @debugoperatorclassenum{Magnum::Buffer,Magnum::Buffer::TargetHint} */
 MAGNUM_EXPORT Debug& operator<<(Debug& debug, Buffer::TargetHint value);
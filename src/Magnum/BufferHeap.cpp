@@ -0,0 +1,136 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BufferHeap.h"
+
+#include <Corrade/Utility/Assert.h>
+
+namespace Magnum {
+
+BufferHeap::Page::Page(const Buffer::TargetHint targetHint, const GLsizeiptr size, const BufferUsage usage): buffer{targetHint}, allocator{std::size_t(size)} {
+    buffer.setData({nullptr, std::size_t(size)}, usage);
+}
+
+BufferHeap::BufferHeap(const Buffer::TargetHint targetHint, const GLsizeiptr pageSize, const BufferUsage usage): _targetHint{targetHint}, _pageSize{pageSize}, _usage{usage}
+    #ifndef MAGNUM_TARGET_GLES2
+    , _scratch{NoCreate}, _scratchSize{}
+    #endif
+{
+    CORRADE_ASSERT(pageSize > 0,
+        "BufferHeap: expected non-zero page size", );
+}
+
+Buffer& BufferHeap::buffer(const UnsignedInt page) {
+    CORRADE_ASSERT(page < _pages.size(),
+        "BufferHeap::buffer(): index" << page << "out of range for" << _pages.size() << "pages", _pages[0]->buffer);
+    return _pages[page]->buffer;
+}
+
+const RangeAllocator& BufferHeap::allocator(const UnsignedInt page) const {
+    CORRADE_ASSERT(page < _pages.size(),
+        "BufferHeap::allocator(): index" << page << "out of range for" << _pages.size() << "pages", _pages[0]->allocator);
+    return _pages[page]->allocator;
+}
+
+std::size_t BufferHeap::allocationCount() const {
+    std::size_t count = 0;
+    for(const std::unique_ptr<Page>& page: _pages)
+        count += page->allocator.allocationCount();
+    return count;
+}
+
+BufferHeap::Allocation BufferHeap::allocate(const GLsizeiptr size, const GLsizeiptr alignment) {
+    CORRADE_ASSERT(size > 0 && alignment > 0,
+        "BufferHeap::allocate(): expected non-zero size and alignment", {});
+
+    /* Existing pages first */
+    for(std::size_t i = 0; i != _pages.size(); ++i) {
+        const std::size_t offset = _pages[i]->allocator.allocate(size, alignment);
+        if(offset != RangeAllocator::NotFound)
+            return {UnsignedInt(i), GLintptr(offset), size};
+    }
+
+    /* Allocations larger than a page get a dedicated one. Offset of the first
+       allocation is zero, so it's always aligned. */
+    _pages.emplace_back(new Page{_targetHint, size > _pageSize ? size : _pageSize, _usage});
+    const std::size_t offset = _pages.back()->allocator.allocate(size, alignment);
+    CORRADE_INTERNAL_ASSERT(offset == 0);
+    return {UnsignedInt(_pages.size() - 1), GLintptr(offset), size};
+}
+
+BufferHeap::Allocation BufferHeap::allocate(const Containers::ArrayView<const void> data, const GLsizeiptr alignment) {
+    const Allocation allocation = allocate(data.size(), alignment);
+    if(allocation.size)
+        _pages[allocation.page]->buffer.setSubData(allocation.offset, data);
+    return allocation;
+}
+
+void BufferHeap::deallocate(const Allocation& allocation) {
+    CORRADE_ASSERT(allocation.page < _pages.size(),
+        "BufferHeap::deallocate(): index" << allocation.page << "out of range for" << _pages.size() << "pages", );
+    _pages[allocation.page]->allocator.deallocate(allocation.offset);
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+std::vector<std::pair<BufferHeap::Allocation, BufferHeap::Allocation>> BufferHeap::defragment() {
+    std::vector<std::pair<Allocation, Allocation>> moved;
+    for(std::size_t i = 0; i != _pages.size(); ++i) {
+        Page& page = *_pages[i];
+        const std::vector<RangeAllocator::Move> moves = page.allocator.defragment();
+        if(moves.empty()) continue;
+
+        std::size_t size = 0;
+        for(const RangeAllocator::Move& move: moves) size += move.size;
+
+        /* Enlarge the scratch buffer, if needed */
+        if(GLsizeiptr(size) > _scratchSize) {
+            _scratch = Buffer{Buffer::TargetHint::Array};
+            _scratch.setData({nullptr, size}, BufferUsage::StreamCopy);
+            _scratchSize = size;
+        }
+
+        /* Copy everything out first, as the new ranges may overlap the
+           original ones, then back to the new locations */
+        std::size_t scratchOffset = 0;
+        for(const RangeAllocator::Move& move: moves) {
+            Buffer::copy(page.buffer, _scratch, move.oldOffset, scratchOffset, move.size);
+            scratchOffset += move.size;
+        }
+        scratchOffset = 0;
+        for(const RangeAllocator::Move& move: moves) {
+            Buffer::copy(_scratch, page.buffer, scratchOffset, move.newOffset, move.size);
+            scratchOffset += move.size;
+
+            moved.push_back({
+                Allocation{UnsignedInt(i), GLintptr(move.oldOffset), GLsizeiptr(move.size)},
+                Allocation{UnsignedInt(i), GLintptr(move.newOffset), GLsizeiptr(move.size)}});
+        }
+    }
+
+    return moved;
+}
+#endif
+
+}
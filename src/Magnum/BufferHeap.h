@@ -0,0 +1,212 @@
+#ifndef Magnum_BufferHeap_h
+#define Magnum_BufferHeap_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::BufferHeap
+ */
+
+#include <memory>
+#include <utility>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/RangeAllocator.h"
+
+namespace Magnum {
+
+/**
+@brief Buffer heap
+
+Sub-allocator for geometry that is streamed in and out often, such as terrain
+chunks or procedurally generated objects. Instead of creating and destroying a
+@ref Buffer for each of them, which causes allocation hitches in the driver,
+the heap keeps a few large buffers (pages) and hands out offset ranges in
+them using a @ref RangeAllocator. A new page is created only when an
+allocation doesn't fit into any existing one; allocations larger than
+@ref pageSize() get a dedicated page.
+
+The allocations are used with @ref Mesh and @ref MeshView directly, by
+passing @ref buffer() and the allocation offset to
+@ref Mesh::addVertexBuffer() or @ref Mesh::setIndexBuffer():
+@code
+BufferHeap heap{Buffer::TargetHint::Array, 16*1024*1024};
+
+BufferHeap::Allocation vertices = heap.allocate(vertexData, sizeof(Vertex));
+BufferHeap::Allocation indices = heap.allocate(indexData, sizeof(UnsignedShort));
+
+Mesh mesh;
+mesh.setCount(indexCount)
+    .addVertexBuffer(heap.buffer(vertices.page), vertices.offset,
+        Shaders::Generic3D::Position{}, Shaders::Generic3D::Normal{})
+    .setIndexBuffer(heap.buffer(indices.page), indices.offset,
+        Mesh::IndexType::UnsignedShort);
+
+// when the chunk is streamed out
+heap.deallocate(vertices);
+heap.deallocate(indices);
+@endcode
+
+If all vertex allocations use the same layout and are aligned to its stride,
+the meshes in one page can share a single @ref Mesh and be drawn as
+@ref MeshView "MeshViews" with @ref MeshView::setBaseVertex() set to
+@cpp vertices.offset/sizeof(Vertex) @ce and @ref MeshView::setIndexRange()
+to @cpp indices.offset/sizeof(UnsignedShort) @ce, which allows submitting
+them together with @ref MeshView::draw(AbstractShaderProgram&, Containers::ArrayView<const std::reference_wrapper<MeshView>>).
+
+## Defragmentation
+
+After a lot of churn the free space can become fragmented so large
+allocations no longer fit. @ref defragment() compacts the allocations in each
+page on the GPU using @ref Buffer::copy() and returns the moved ones, their
+meshes then need to be updated with the new offsets.
+*/
+class MAGNUM_EXPORT BufferHeap {
+    public:
+        /**
+         * @brief Allocation
+         *
+         * @see @ref allocate()
+         */
+        struct Allocation {
+            UnsignedInt page;   /**< @brief Page index, see @ref buffer() */
+            GLintptr offset;    /**< @brief Offset in the page buffer */
+            GLsizeiptr size;    /**< @brief Size */
+        };
+
+        /**
+         * @brief Constructor
+         * @param targetHint    Target hint for the page buffers
+         * @param pageSize      Size of one page in bytes
+         * @param usage         Usage of the page buffers
+         *
+         * No pages are created until the first allocation.
+         */
+        explicit BufferHeap(Buffer::TargetHint targetHint, GLsizeiptr pageSize, BufferUsage usage = BufferUsage::DynamicDraw);
+
+        /** @brief Copying is not allowed */
+        BufferHeap(const BufferHeap&) = delete;
+
+        /** @brief Move constructor */
+        BufferHeap(BufferHeap&&) = default;
+
+        /** @brief Copying is not allowed */
+        BufferHeap& operator=(const BufferHeap&) = delete;
+
+        /** @brief Move assignment */
+        BufferHeap& operator=(BufferHeap&&) = default;
+
+        /** @brief Page size */
+        GLsizeiptr pageSize() const { return _pageSize; }
+
+        /** @brief Page count */
+        UnsignedInt pageCount() const { return _pages.size(); }
+
+        /**
+         * @brief Page buffer
+         *
+         * The reference stays valid for the whole lifetime of the heap.
+         * Don't modify the buffer storage.
+         */
+        Buffer& buffer(UnsignedInt page);
+
+        /**
+         * @brief Page allocator
+         *
+         * Useful for querying fragmentation of given page.
+         */
+        const RangeAllocator& allocator(UnsignedInt page) const;
+
+        /** @brief Count of live allocations in all pages */
+        std::size_t allocationCount() const;
+
+        /**
+         * @brief Allocate a range
+         * @param size      Size in bytes, expected to be non-zero
+         * @param alignment Alignment of the offset
+         *
+         * Tries the existing pages in order, creating a new one if the
+         * allocation doesn't fit in any of them. The contents are
+         * undefined.
+         */
+        Allocation allocate(GLsizeiptr size, GLsizeiptr alignment = 1);
+
+        /**
+         * @brief Allocate a range and fill it with data
+         *
+         * Equivalent to calling @ref allocate(GLsizeiptr, GLsizeiptr) and
+         * @ref Buffer::setSubData() on the returned range.
+         */
+        Allocation allocate(Containers::ArrayView<const void> data, GLsizeiptr alignment = 1);
+
+        /**
+         * @brief Deallocate a range
+         *
+         * The page buffer itself is kept for subsequent allocations.
+         */
+        void deallocate(const Allocation& allocation);
+
+        #if !defined(MAGNUM_TARGET_GLES2) || defined(DOXYGEN_GENERATING_OUTPUT)
+        /**
+         * @brief Defragment all pages
+         * @return Pairs of old and new allocation for all moved ranges
+         *
+         * Compacts the allocations in each page to its beginning. As
+         * @ref Buffer::copy() can't copy between overlapping ranges of the
+         * same buffer, the moved data go through a temporary buffer, which
+         * is kept for subsequent defragmentations. Buffer IDs don't
+         * change, only the offsets. Allocation alignment is preserved.
+         * @see @ref RangeAllocator::defragment()
+         * @requires_gl31 Extension @extension{ARB,copy_buffer}
+         * @requires_gles30 Buffer copying is not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Buffer copying is not available in WebGL 1.0.
+         */
+        std::vector<std::pair<Allocation, Allocation>> defragment();
+        #endif
+
+    private:
+        struct Page {
+            explicit Page(Buffer::TargetHint targetHint, GLsizeiptr size, BufferUsage usage);
+
+            Buffer buffer;
+            RangeAllocator allocator;
+        };
+
+        Buffer::TargetHint _targetHint;
+        GLsizeiptr _pageSize;
+        BufferUsage _usage;
+        std::vector<std::unique_ptr<Page>> _pages;
+        #ifndef MAGNUM_TARGET_GLES2
+        Buffer _scratch;
+        GLsizeiptr _scratchSize;
+        #endif
+};
+
+}
+
+#endif
@@ -0,0 +1,69 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BufferRing.h"
+
+namespace Magnum {
+
+BufferRing::BufferRing(const Buffer::TargetHint targetHint, const GLsizeiptr regionSize, const UnsignedInt regionCount): _buffer{targetHint}, _regionSize{regionSize}, _regionOffset{0}, _currentRegion{0}, _fences{regionCount} {
+    CORRADE_ASSERT(regionSize && regionCount, "BufferRing: region size and count must be non-zero", );
+
+    const GLsizeiptr size = regionSize*regionCount;
+    _buffer.setStorage({nullptr, std::size_t(size)}, Buffer::StorageFlag::MapWrite|Buffer::StorageFlag::MapPersistent|Buffer::StorageFlag::MapCoherent);
+    _data = _buffer.map<char>(0, size, Buffer::MapFlag::Write|Buffer::MapFlag::Persistent|Buffer::MapFlag::Coherent);
+}
+
+BufferRing::~BufferRing() {
+    /* Wait for all pending commands so the buffer isn't deleted while still
+       being used */
+    for(Fence& fence: _fences) fence.clientWait();
+
+    _buffer.unmap();
+}
+
+std::pair<GLintptr, Containers::ArrayView<char>> BufferRing::allocate(const GLsizeiptr size, const GLsizeiptr alignment) {
+    CORRADE_ASSERT(alignment,
+        "BufferRing::allocate(): alignment can't be zero", {});
+
+    const GLintptr regionStart = _currentRegion*_regionSize;
+    const GLintptr offset = (regionStart + _regionOffset + alignment - 1)/alignment*alignment;
+    CORRADE_ASSERT(offset + size <= regionStart + _regionSize,
+        "BufferRing::allocate(): can't allocate" << size << "bytes with alignment" << alignment << Debug::nospace << ", only" << available() << "bytes left in current region", {});
+
+    _regionOffset = offset + size - regionStart;
+    return {offset, {_data + offset, std::size_t(size)}};
+}
+
+BufferRing& BufferRing::nextFrame() {
+    _fences[_currentRegion].insert();
+
+    _currentRegion = (_currentRegion + 1) % _fences.size();
+    _regionOffset = 0;
+    _fences[_currentRegion].clientWait();
+
+    return *this;
+}
+
+}
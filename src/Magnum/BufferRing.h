@@ -0,0 +1,170 @@
+#ifndef Magnum_BufferRing_h
+#define Magnum_BufferRing_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MAGNUM_TARGET_GLES
+/** @file
+ * @brief Class @ref Magnum::BufferRing
+ */
+#endif
+
+#include <utility>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/Fence.h"
+
+#ifndef MAGNUM_TARGET_GLES
+namespace Magnum {
+
+/**
+@brief Persistently mapped ring buffer
+
+Streaming allocator for per-frame data such as uniforms or dynamic vertices.
+The underlying @ref Buffer has immutable storage split into @ref regionCount()
+equally sized regions and is mapped with @ref Buffer::MapFlag::Persistent and
+@ref Buffer::MapFlag::Coherent for its whole lifetime, so there are no map /
+unmap round trips and the driver can't reallocate the storage behind your
+back.
+
+Each frame, sub-allocations are handed out from the current region using
+@ref allocate(). Calling @ref nextFrame() inserts a @ref Fence after the
+commands that consumed the current region and advances to the next one,
+waiting until OpenGL is done with its previous contents. With the default of
+three regions the CPU can be up to two frames ahead of the GPU before it
+needs to wait.
+@code
+BufferRing ring{Buffer::TargetHint::Uniform, 64*1024};
+
+// each frame
+std::pair<GLintptr, Containers::ArrayView<char>> uniforms = ring.allocate(sizeof(Matrix4), Buffer::uniformOffsetAlignment());
+*reinterpret_cast<Matrix4*>(uniforms.second.data()) = transformation;
+ring.buffer().bind(Buffer::Target::Uniform, 0, uniforms.first, sizeof(Matrix4));
+// draw...
+ring.nextFrame();
+@endcode
+
+@requires_gl44 Extension @extension{ARB,buffer_storage}
+@requires_gl Persistent buffer mapping is not available in OpenGL ES and
+    WebGL.
+*/
+class MAGNUM_EXPORT BufferRing {
+    public:
+        /**
+         * @brief Constructor
+         * @param targetHint    Target hint for the underlying buffer
+         * @param regionSize    Size of one region in bytes
+         * @param regionCount   Region count
+         *
+         * Creates the buffer storage with size @p regionSize * @p regionCount
+         * and maps it persistently for writing.
+         * @see @ref Buffer::setStorage(), @ref Buffer::map()
+         */
+        explicit BufferRing(Buffer::TargetHint targetHint, GLsizeiptr regionSize, UnsignedInt regionCount = 3);
+
+        /** @brief Copying is not allowed */
+        BufferRing(const BufferRing&) = delete;
+
+        /** @brief Moving is not allowed */
+        BufferRing(BufferRing&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Unmaps and deletes the buffer.
+         */
+        ~BufferRing();
+
+        /** @brief Copying is not allowed */
+        BufferRing& operator=(const BufferRing&) = delete;
+
+        /** @brief Moving is not allowed */
+        BufferRing& operator=(BufferRing&&) = delete;
+
+        /**
+         * @brief Underlying buffer
+         *
+         * Don't unmap the buffer or modify its storage.
+         */
+        Buffer& buffer() { return _buffer; }
+
+        /** @brief Size of one region in bytes */
+        GLsizeiptr regionSize() const { return _regionSize; }
+
+        /** @brief Region count */
+        UnsignedInt regionCount() const { return _fences.size(); }
+
+        /** @brief Index of current region */
+        UnsignedInt currentRegion() const { return _currentRegion; }
+
+        /**
+         * @brief Count of bytes available in current region
+         *
+         * Doesn't take alignment of subsequent allocations into account.
+         */
+        GLsizeiptr available() const { return _regionSize - _regionOffset; }
+
+        /**
+         * @brief Allocate memory from current region
+         * @param size      Size in bytes
+         * @param alignment Alignment of the returned offset, relative to
+         *      the start of the buffer
+         * @return Pair of offset into @ref buffer() and mapped memory of
+         *      size @p size
+         *
+         * Expects that @p alignment is not zero and that the allocation fits
+         * into the current region. The memory is coherent, so the writes are
+         * visible to commands submitted afterwards without any explicit
+         * flush.
+         */
+        std::pair<GLintptr, Containers::ArrayView<char>> allocate(GLsizeiptr size, GLsizeiptr alignment = 1);
+
+        /**
+         * @brief Advance to next region
+         * @return Reference to self (for method chaining)
+         *
+         * Inserts a fence after all commands that used the current region
+         * and switches to the next one. If the fence guarding the next region
+         * wasn't signaled yet, blocks until it is.
+         * @see @ref Fence::insert(), @ref Fence::clientWait()
+         */
+        BufferRing& nextFrame();
+
+    private:
+        Buffer _buffer;
+        char* _data;
+        GLsizeiptr _regionSize, _regionOffset;
+        UnsignedInt _currentRegion;
+        Containers::Array<Fence> _fences;
+};
+
+}
+#else
+#error this header is not available in OpenGL ES build
+#endif
+
+#endif
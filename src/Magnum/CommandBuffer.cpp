@@ -0,0 +1,153 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "CommandBuffer.h"
+
+#include <cstring>
+
+#include "Magnum/AbstractFramebuffer.h"
+#include "Magnum/AbstractTexture.h"
+#include "Magnum/Buffer.h"
+#include "Magnum/Mesh.h"
+
+namespace Magnum {
+
+CommandBuffer::CommandBuffer(const std::size_t chunkSize): _chunkSize{chunkSize}, _currentChunk{0}, _commandCount{0} {
+    CORRADE_ASSERT(chunkSize, "CommandBuffer: chunk size can't be zero", );
+}
+
+CommandBuffer::CommandBuffer(CommandBuffer&& other) noexcept: _chunkSize{other._chunkSize}, _currentChunk{other._currentChunk}, _commandCount{other._commandCount}, _chunks{std::move(other._chunks)} {
+    other._chunks.clear();
+    other._currentChunk = 0;
+    other._commandCount = 0;
+}
+
+CommandBuffer::~CommandBuffer() { clear(); }
+
+CommandBuffer& CommandBuffer::operator=(CommandBuffer&& other) noexcept {
+    using std::swap;
+    swap(_chunkSize, other._chunkSize);
+    swap(_currentChunk, other._currentChunk);
+    swap(_commandCount, other._commandCount);
+    swap(_chunks, other._chunks);
+    return *this;
+}
+
+std::size_t CommandBuffer::allocatedSize() const {
+    std::size_t size = 0;
+    for(const Chunk& chunk: _chunks) size += chunk.data.size();
+    return size;
+}
+
+void* CommandBuffer::allocate(const std::size_t size) {
+    /* Find a chunk with enough space, starting from the current one. Chunks
+       kept from before clear() are reused if they are large enough, otherwise
+       a new one is inserted in front of them to keep the recording order */
+    while(_currentChunk < _chunks.size() && _chunks[_currentChunk].data.size() - _chunks[_currentChunk].used < size) {
+        if(_chunks[_currentChunk].used) {
+            ++_currentChunk;
+            continue;
+        }
+
+        _chunks.insert(_chunks.begin() + _currentChunk, Chunk{Containers::Array<char>{Containers::NoInit, std::max(size, _chunkSize)}, 0});
+    }
+
+    if(_currentChunk == _chunks.size())
+        _chunks.push_back(Chunk{Containers::Array<char>{Containers::NoInit, std::max(size, _chunkSize)}, 0});
+
+    Chunk& chunk = _chunks[_currentChunk];
+    void* const memory = chunk.data + chunk.used;
+    chunk.used += size;
+    return memory;
+}
+
+template<class F> void CommandBuffer::forEach(F&& f) {
+    for(std::size_t i = 0; i < _chunks.size() && i <= _currentChunk; ++i) {
+        Chunk& chunk = _chunks[i];
+        for(std::size_t offset = 0; offset < chunk.used; ) {
+            auto& header = *reinterpret_cast<Implementation::CommandHeader*>(chunk.data + offset);
+            offset += header.size;
+            f(header);
+        }
+    }
+}
+
+CommandBuffer& CommandBuffer::draw(Mesh& mesh, AbstractShaderProgram& shader) {
+    return record([&mesh, &shader]() { mesh.draw(shader); });
+}
+
+CommandBuffer& CommandBuffer::draw(const MeshView& mesh, AbstractShaderProgram& shader) {
+    MeshView view = mesh;
+    return record([view, &shader]() mutable { view.draw(shader); });
+}
+
+CommandBuffer& CommandBuffer::bindTexture(AbstractTexture& texture, const Int textureUnit) {
+    return record([&texture, textureUnit]() { texture.bind(textureUnit); });
+}
+
+CommandBuffer& CommandBuffer::bindFramebuffer(AbstractFramebuffer& framebuffer) {
+    return record([&framebuffer]() { framebuffer.bind(); });
+}
+
+CommandBuffer& CommandBuffer::setBufferData(Buffer& buffer, const Containers::ArrayView<const void> data, const BufferUsage usage) {
+    const Containers::ArrayView<char> copy = allocateData(data.size());
+    if(data.size()) std::memcpy(copy.data(), data.data(), data.size());
+    return record([&buffer, copy, usage]() { buffer.setData(copy, usage); });
+}
+
+CommandBuffer& CommandBuffer::setBufferSubData(Buffer& buffer, const GLintptr offset, const Containers::ArrayView<const void> data) {
+    const Containers::ArrayView<char> copy = allocateData(data.size());
+    if(data.size()) std::memcpy(copy.data(), data.data(), data.size());
+    return record([&buffer, offset, copy]() { buffer.setSubData(offset, copy); });
+}
+
+Containers::ArrayView<char> CommandBuffer::allocateData(const std::size_t size) {
+    /* Data are stored as a command without any callbacks so the chunks can
+       be still walked through */
+    const std::size_t headerSize = alignedSize(sizeof(Implementation::CommandHeader));
+    const std::size_t totalSize = headerSize + alignedSize(size);
+    char* const memory = static_cast<char*>(allocate(totalSize));
+    new(memory) Implementation::CommandHeader{nullptr, nullptr, totalSize};
+    return {memory + headerSize, size};
+}
+
+void CommandBuffer::execute() {
+    forEach([](Implementation::CommandHeader& header) {
+        if(header.execute) header.execute(header);
+    });
+}
+
+CommandBuffer& CommandBuffer::clear() {
+    forEach([](Implementation::CommandHeader& header) {
+        if(header.destruct) header.destruct(header);
+    });
+
+    for(Chunk& chunk: _chunks) chunk.used = 0;
+    _currentChunk = 0;
+    _commandCount = 0;
+    return *this;
+}
+
+}
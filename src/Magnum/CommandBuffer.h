@@ -0,0 +1,306 @@
+#ifndef Magnum_CommandBuffer_h
+#define Magnum_CommandBuffer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::CommandBuffer
+ */
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/MeshView.h"
+
+namespace Magnum {
+
+namespace Implementation {
+    struct CommandHeader {
+        void(*execute)(CommandHeader&);
+        void(*destruct)(CommandHeader&);
+        std::size_t size;
+    };
+
+    template<class Callable> struct Command: CommandHeader {
+        template<class F> explicit Command(std::size_t size, F&& callable): CommandHeader{execute, destruct, size}, callable{std::forward<F>(callable)} {}
+
+        static void execute(CommandHeader& header) {
+            static_cast<Command<Callable>&>(header).callable();
+        }
+
+        static void destruct(CommandHeader& header) {
+            static_cast<Command<Callable>&>(header).~Command<Callable>();
+        }
+
+        Callable callable;
+    };
+}
+
+/**
+@brief Command buffer
+
+All GL wrappers have to be used only on the thread where the GL context is
+current, as they go through global state tracker. Command buffer allows other
+threads to *record* draws, uniform setting, texture and framebuffer binding and
+buffer updates without touching GL at all. The commands are then executed in
+order on the context thread through the usual wrappers, so the state tracking
+works the same as if the calls were made directly.
+@code
+// each worker thread, with its own command buffer
+commands.setUniform(shader, transformationUniform, transformation)
+    .bindTexture(texture, 0)
+    .draw(mesh, shader);
+
+// context thread, after the workers are done
+for(CommandBuffer& commands: perThreadCommands) commands.execute();
+for(CommandBuffer& commands: perThreadCommands) commands.clear();
+@endcode
+
+The commands are stored in a linear allocator --- memory chunks of size given
+in the constructor, which are filled one after another. Recording a command is
+thus just a pointer bump and a copy, @ref clear() destroys the commands but
+keeps the chunks for recording the next frame, so in a steady state the buffer
+doesn't allocate at all.
+
+Anything not covered by the builtin commands can be recorded as an arbitrary
+callable using @ref record(). Data the callables need can be copied into
+memory owned by the buffer using @ref allocateData().
+
+## Thread safety
+
+The command buffer itself is not thread-safe, use one instance per thread.
+Recording doesn't access GL or @ref Context, but it stores *references* to the
+objects, so they have to be alive and not moved until the commands are
+executed and you have to synchronize the recording threads with the context
+thread before calling @ref execute(). Data passed to @ref setBufferData() and
+@ref setBufferSubData() are copied, values passed to @ref setUniform() are
+stored by value.
+*/
+class MAGNUM_EXPORT CommandBuffer {
+    public:
+        /**
+         * @brief Constructor
+         * @param chunkSize     Size of one memory chunk in bytes
+         *
+         * No memory is allocated until the first command is recorded.
+         * Commands larger than @p chunkSize get a dedicated chunk.
+         */
+        explicit CommandBuffer(std::size_t chunkSize = 64*1024);
+
+        /** @brief Copying is not allowed */
+        CommandBuffer(const CommandBuffer&) = delete;
+
+        /** @brief Move constructor */
+        CommandBuffer(CommandBuffer&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Destroys all recorded commands without executing them.
+         */
+        ~CommandBuffer();
+
+        /** @brief Copying is not allowed */
+        CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+        /** @brief Move assignment */
+        CommandBuffer& operator=(CommandBuffer&& other) noexcept;
+
+        /** @brief Size of one memory chunk */
+        std::size_t chunkSize() const { return _chunkSize; }
+
+        /** @brief Count of recorded commands */
+        std::size_t commandCount() const { return _commandCount; }
+
+        /** @brief Whether the buffer has no commands recorded */
+        bool isEmpty() const { return !_commandCount; }
+
+        /**
+         * @brief Allocated memory
+         *
+         * Total size of all allocated chunks in bytes, including the ones
+         * kept after @ref clear().
+         */
+        std::size_t allocatedSize() const;
+
+        /**
+         * @brief Record a mesh draw
+         * @return Reference to self (for method chaining)
+         *
+         * Calls @ref Mesh::draw() with @p shader on execution.
+         */
+        CommandBuffer& draw(Mesh& mesh, AbstractShaderProgram& shader);
+
+        /**
+         * @brief Record a mesh view draw
+         * @return Reference to self (for method chaining)
+         *
+         * The view is copied, so it can be modified after recording. Calls
+         * @ref MeshView::draw() with @p shader on execution.
+         */
+        CommandBuffer& draw(const MeshView& mesh, AbstractShaderProgram& shader);
+
+        /**
+         * @brief Record setting an uniform value
+         * @return Reference to self (for method chaining)
+         *
+         * The @p value is stored by value and passed to
+         * @ref AbstractShaderProgram::setUniform() on execution. Get the
+         * uniform location beforehand on the context thread, e.g. in shader
+         * constructor.
+         */
+        template<class T> CommandBuffer& setUniform(AbstractShaderProgram& shader, Int location, const T& value) {
+            return record([&shader, location, value]() {
+                shader.setUniform(location, value);
+            });
+        }
+
+        /**
+         * @brief Record setting an uniform array
+         * @return Reference to self (for method chaining)
+         *
+         * The @p values are copied into the buffer.
+         */
+        template<class T> CommandBuffer& setUniform(AbstractShaderProgram& shader, Int location, Containers::ArrayView<const T> values);
+
+        /**
+         * @brief Record binding a texture to given texture unit
+         * @return Reference to self (for method chaining)
+         *
+         * Calls @ref AbstractTexture::bind() on execution.
+         */
+        CommandBuffer& bindTexture(AbstractTexture& texture, Int textureUnit);
+
+        /**
+         * @brief Record binding a framebuffer for drawing
+         * @return Reference to self (for method chaining)
+         *
+         * Calls @ref AbstractFramebuffer::bind() on execution.
+         */
+        CommandBuffer& bindFramebuffer(AbstractFramebuffer& framebuffer);
+
+        /**
+         * @brief Record setting buffer data
+         * @return Reference to self (for method chaining)
+         *
+         * The @p data are copied into the buffer and passed to
+         * @ref Buffer::setData() on execution.
+         */
+        CommandBuffer& setBufferData(Buffer& buffer, Containers::ArrayView<const void> data, BufferUsage usage);
+
+        /**
+         * @brief Record setting buffer subdata
+         * @return Reference to self (for method chaining)
+         *
+         * The @p data are copied into the buffer and passed to
+         * @ref Buffer::setSubData() on execution.
+         */
+        CommandBuffer& setBufferSubData(Buffer& buffer, GLintptr offset, Containers::ArrayView<const void> data);
+
+        /**
+         * @brief Record an arbitrary callable
+         * @return Reference to self (for method chaining)
+         *
+         * The callable is moved or copied into the buffer, called without
+         * arguments on execution and destroyed in @ref clear() or in the
+         * destructor. Its alignment can't be larger than
+         * `alignof(std::max_align_t)`.
+         */
+        template<class F> CommandBuffer& record(F&& callable);
+
+        /**
+         * @brief Allocate data owned by the buffer
+         *
+         * Returns uninitialized memory aligned to `alignof(std::max_align_t)`
+         * that stays valid until @ref clear() is called or the buffer is
+         * destroyed. Use it to pass larger data to callables recorded with
+         * @ref record().
+         */
+        Containers::ArrayView<char> allocateData(std::size_t size);
+
+        /**
+         * @brief Execute recorded commands
+         *
+         * Has to be called on the thread where the GL context is current.
+         * Executes all commands in the order they were recorded. The
+         * commands are kept, so the buffer can be executed again. Call
+         * @ref clear() to record a new set of commands.
+         */
+        void execute();
+
+        /**
+         * @brief Clear recorded commands
+         * @return Reference to self (for method chaining)
+         *
+         * Destroys all commands and data, allocated chunks are kept for
+         * reuse.
+         */
+        CommandBuffer& clear();
+
+    private:
+        struct Chunk {
+            Containers::Array<char> data;
+            std::size_t used;
+        };
+
+        static std::size_t alignedSize(std::size_t size) {
+            return (size + alignof(std::max_align_t) - 1)/alignof(std::max_align_t)*alignof(std::max_align_t);
+        }
+
+        void* allocate(std::size_t size);
+        template<class F> void forEach(F&& f);
+
+        std::size_t _chunkSize, _currentChunk, _commandCount;
+        std::vector<Chunk> _chunks;
+};
+
+template<class F> CommandBuffer& CommandBuffer::record(F&& callable) {
+    typedef Implementation::Command<typename std::decay<F>::type> Command;
+    static_assert(alignof(Command) <= alignof(std::max_align_t),
+        "over-aligned callables are not supported");
+
+    const std::size_t size = alignedSize(sizeof(Command));
+    new(allocate(size)) Command{size, std::forward<F>(callable)};
+    ++_commandCount;
+    return *this;
+}
+
+template<class T> CommandBuffer& CommandBuffer::setUniform(AbstractShaderProgram& shader, const Int location, const Containers::ArrayView<const T> values) {
+    const Containers::ArrayView<char> data = allocateData(values.size()*sizeof(T));
+    T* const copy = reinterpret_cast<T*>(data.data());
+    const std::size_t count = values.size();
+    for(std::size_t i = 0; i != count; ++i) new(copy + i) T{values[i]};
+    return record([&shader, location, copy, count]() {
+        shader.setUniform(location, Containers::ArrayView<const T>{copy, count});
+    });
+}
+
+}
+
+#endif
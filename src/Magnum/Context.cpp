@@ -25,18 +25,21 @@
 
 #include "Context.h"
 
-#ifndef MAGNUM_TARGET_GLES
-#include <algorithm> /* std::find in isCoreProfileImplementationNV() */
-#endif
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <iostream> /* for initialization log redirection */
+#include <map>
 #include <string>
-#include <unordered_map>
 #include <Corrade/Containers/EnumSet.hpp>
 #include <Corrade/Utility/Arguments.h>
 #include <Corrade/Utility/Debug.h>
 #include <Corrade/Utility/String.h>
 
 #include "Magnum/AbstractFramebuffer.h"
+#if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+#include "Magnum/AbstractQuery.h"
+#endif
 #include "Magnum/AbstractShaderProgram.h"
 #include "Magnum/AbstractTexture.h"
 #include "Magnum/Buffer.h"
@@ -52,8 +55,10 @@
 
 #include "Implementation/State.h"
 #include "Implementation/ContextState.h"
+#include "Implementation/DeletionState.h"
 #include "Implementation/BufferState.h"
 #include "Implementation/FramebufferState.h"
+#include "Implementation/MemoryState.h"
 #include "Implementation/MeshState.h"
 #include "Implementation/RendererState.h"
 #include "Implementation/ShaderProgramState.h"
@@ -87,7 +92,9 @@ const std::vector<Extension>& Extension::extensions(Version version) {
         _extension(GL,ARB,pipeline_statistics_query),
         _extension(GL,ARB,sparse_buffer),
         _extension(GL,ARB,transform_feedback_overflow_query),
+        _extension(GL,ARB,gl_spirv),
         _extension(GL,ATI,texture_mirror_once),
+        _extension(GL,ATI,meminfo),
         _extension(GL,EXT,texture_filter_anisotropic),
         _extension(GL,EXT,texture_compression_s3tc),
         _extension(GL,EXT,texture_mirror_clamp),
@@ -101,7 +108,11 @@ const std::vector<Extension>& Extension::extensions(Version version) {
         _extension(GL,KHR,texture_compression_astc_hdr),
         _extension(GL,KHR,blend_equation_advanced),
         _extension(GL,KHR,blend_equation_advanced_coherent),
-        _extension(GL,KHR,no_error)};
+        _extension(GL,KHR,no_error),
+        _extension(GL,KHR,parallel_shader_compile),
+        _extension(GL,NVX,gpu_memory_info),
+        _extension(GL,OVR,multiview),
+        _extension(GL,OVR,multiview2)};
     static const std::vector<Extension> extensions300{
         _extension(GL,ARB,map_buffer_range),
         _extension(GL,ARB,color_buffer_float),
@@ -304,6 +315,7 @@ const std::vector<Extension>& Extension::extensions(Version version) {
         _extension(GL,KHR,robust_buffer_access_behavior),
         _extension(GL,KHR,context_flush_control),
         _extension(GL,KHR,no_error),
+        _extension(GL,KHR,parallel_shader_compile),
         _extension(GL,NV,read_buffer_front),
         _extension(GL,NV,read_depth),
         _extension(GL,NV,read_stencil),
@@ -325,7 +337,9 @@ const std::vector<Extension>& Extension::extensions(Version version) {
         #endif
         _extension(GL,OES,texture_stencil8),
         #ifndef MAGNUM_TARGET_GLES2
-        _extension(GL,OES,texture_storage_multisample_2d_array)
+        _extension(GL,OES,texture_storage_multisample_2d_array),
+        _extension(GL,OVR,multiview),
+        _extension(GL,OVR,multiview2)
         #endif
         };
     #ifdef MAGNUM_TARGET_GLES2
@@ -425,6 +439,29 @@ namespace {
     #endif
     #endif
     Context* currentContext = nullptr;
+
+    /* Compares a possibly non-null-terminated extension name with a known
+       extension string */
+    int compareExtensionString(const char* const known, const char* const name, const std::size_t length) {
+        const int result = std::strncmp(known, name, length);
+        if(result) return result;
+        return known[length] ? 1 : 0;
+    }
+
+    Float millisecondsSince(const std::chrono::high_resolution_clock::time_point& start) {
+        return std::chrono::duration<Float, std::milli>{std::chrono::high_resolution_clock::now() - start}.count();
+    }
+}
+
+/* Binary search in extensions sorted by their string, used to look up
+   extensions directly from the driver-owned strings without allocating */
+const Extension* Context::findExtension(const std::vector<Extension>& sorted, const char* const name, const std::size_t length) {
+    const auto found = std::lower_bound(sorted.begin(), sorted.end(), name, [length](const Extension& extension, const char* name) {
+        return compareExtensionString(extension._string, name, length) < 0;
+    });
+    if(found == sorted.end() || compareExtensionString(found->_string, name, length) != 0)
+        return nullptr;
+    return &*found;
 }
 
 bool Context::hasCurrent() { return currentContext; }
@@ -440,7 +477,7 @@ Context::Context(NoCreateT, Int argc, const char** argv, void functionLoader()):
     args.addOption("disable-workarounds")
         .setHelp("disable-workarounds", "driver workarounds to disable\n      (see src/Magnum/Implementation/driverSpecific.cpp for detailed info)", "LIST")
         .addOption("disable-extensions").setHelp("disable-extensions", "OpenGL extensions to disable", "LIST")
-        .addOption("log", "default").setHelp("log", "Console logging", "default|quiet")
+        .addOption("log", "default").setHelp("log", "Console logging", "default|quiet|verbose")
         .setFromEnvironment("disable-workarounds")
         .setFromEnvironment("disable-extensions")
         .setFromEnvironment("log")
@@ -448,6 +485,7 @@ Context::Context(NoCreateT, Int argc, const char** argv, void functionLoader()):
 
     /* Decide whether to display initialization log */
     _displayInitializationLog = !(args.value("log") == "quiet" || args.value("log") == "QUIET");
+    _displayVerboseInitializationLog = args.value("log") == "verbose" || args.value("log") == "VERBOSE";
 
     /* Disable driver workarounds */
     for(auto&& workaround: Utility::String::splitWithoutEmptyParts(args.value("disable-workarounds")))
@@ -473,6 +511,7 @@ Context::Context(Context&& other): _version{other._version},
 }
 
 Context::~Context() {
+    if(_state && currentContext == this) flushDeletions();
     delete _state;
 
     if(currentContext == this) currentContext = nullptr;
@@ -487,8 +526,14 @@ bool Context::tryCreate() {
     CORRADE_ASSERT(_version == Version::None,
         "Platform::Context::tryCreate(): context already created", false);
 
+    /* Startup timing, printed with --magnum-log verbose */
+    auto timer = std::chrono::high_resolution_clock::now();
+    Float functionLoadingTime, versionTime, extensionTime, stateTime;
+
     /* Load GL function pointers */
     if(_functionLoader) _functionLoader();
+    functionLoadingTime = millisecondsSince(timer);
+    timer = std::chrono::high_resolution_clock::now();
 
     /* Initialize to something predictable to avoid crashes on improperly
        created contexts */
@@ -598,6 +643,9 @@ bool Context::tryCreate() {
         glGetIntegerv(GL_CONTEXT_FLAGS, reinterpret_cast<GLint*>(&_flags));
     #endif
 
+    versionTime = millisecondsSince(timer);
+    timer = std::chrono::high_resolution_clock::now();
+
     std::vector<Version> versions{
         #ifndef MAGNUM_TARGET_GLES
         Version::GL300,
@@ -632,21 +680,55 @@ bool Context::tryCreate() {
 
     /* List of extensions from future versions (extensions from current and
        previous versions should be supported automatically, so we don't need
-       to check for them) */
-    std::unordered_map<std::string, Extension> futureExtensions;
-    for(std::size_t i = future; i != versions.size(); ++i)
-        for(const Extension& extension: Extension::extensions(versions[i]))
-            futureExtensions.emplace(extension._string, extension);
-
-    /* Check for presence of future and vendor extensions */
-    const std::vector<std::string> extensions = extensionStrings();
-    for(const std::string& extension: extensions) {
-        const auto found = futureExtensions.find(extension);
-        if(found != futureExtensions.end()) {
-            _supportedExtensions.push_back(found->second);
-            _extensionStatus.set(found->second._index);
+       to check for them), sorted by name for binary search */
+    std::vector<Extension> futureExtensions;
+    for(std::size_t i = future; i != versions.size(); ++i) {
+        const std::vector<Extension>& extensions = Extension::extensions(versions[i]);
+        futureExtensions.insert(futureExtensions.end(), extensions.begin(), extensions.end());
+    }
+    std::sort(futureExtensions.begin(), futureExtensions.end(), [](const Extension& a, const Extension& b) {
+        return std::strcmp(a._string, b._string) < 0;
+    });
+
+    /* Check for presence of future and vendor extensions. The names are
+       looked up directly in the driver-owned strings, without copying them
+       anywhere. */
+    const auto markSupported = [&](const char* const name, const std::size_t length) {
+        if(const Extension* const found = findExtension(futureExtensions, name, length)) {
+            _supportedExtensions.push_back(*found);
+            _extensionStatus.set(found->_index);
+        }
+    };
+    #ifndef MAGNUM_TARGET_GLES2
+    GLint extensionCount = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+    #ifndef MAGNUM_TARGET_GLES3
+    if(extensionCount || isVersionSupported(Version::GL300))
+    #endif
+    {
+        for(GLint i = 0; i != extensionCount; ++i) {
+            const char* const extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+            markSupported(extension, std::strlen(extension));
         }
     }
+    #ifndef MAGNUM_TARGET_GLES3
+    else
+    #endif
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES3
+    /* OpenGL 2.1 / OpenGL ES 2.0 doesn't have glGetStringi(), walk the
+       space-separated list instead. Don't crash when glGetString() returns
+       nullptr (i.e. don't trust the old implementations). */
+    if(const char* extensions = reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS))) {
+        while(*extensions) {
+            const std::size_t length = std::strcspn(extensions, " ");
+            if(length) markSupported(extensions, length);
+            extensions += length;
+            if(*extensions) ++extensions;
+        }
+    }
+    #endif
 
     /* Reset minimal required version to Version::None for whole array */
     for(auto& i: _extensionRequiredVersion) i = Version::None;
@@ -660,6 +742,8 @@ bool Context::tryCreate() {
        extensions), see Implementation/driverWorkarounds.cpp */
     setupDriverWorkarounds();
 
+    extensionTime = millisecondsSince(timer);
+
     /* Set this context as current */
     CORRADE_ASSERT(!currentContext, "Context: Another context currently active", false);
     currentContext = this;
@@ -676,24 +760,29 @@ bool Context::tryCreate() {
     if(!_disabledExtensions.empty()) {
         Debug{output} << "Disabling extensions:";
 
-        /* Put remaining extensions into the hashmap for faster lookup */
-        std::unordered_map<std::string, Extension> allExtensions{std::move(futureExtensions)};
-        for(std::size_t i = 0; i != future; ++i)
-            for(const Extension& extension: Extension::extensions(versions[i]))
-                allExtensions.emplace(extension._string, extension);
+        /* Add extensions from past versions to the sorted list */
+        std::vector<Extension> allExtensions{std::move(futureExtensions)};
+        for(std::size_t i = 0; i != future; ++i) {
+            const std::vector<Extension>& extensions = Extension::extensions(versions[i]);
+            allExtensions.insert(allExtensions.end(), extensions.begin(), extensions.end());
+        }
+        std::sort(allExtensions.begin(), allExtensions.end(), [](const Extension& a, const Extension& b) {
+            return std::strcmp(a._string, b._string) < 0;
+        });
 
         /* Disable extensions that are known and supported and print a message
            for each */
         for(auto&& extension: _disabledExtensions) {
-            auto found = allExtensions.find(extension);
+            const Extension* const found = findExtension(allExtensions, extension.data(), extension.size());
             /** @todo Error message here? I should not clutter the output at this point */
-            if(found == allExtensions.end()) continue;
+            if(!found) continue;
 
-            _extensionRequiredVersion[found->second._index] = Version::None;
+            _extensionRequiredVersion[found->_index] = Version::None;
             Debug{output} << "   " << extension;
         }
     }
 
+    timer = std::chrono::high_resolution_clock::now();
     _state = new Implementation::State{*this, output};
 
     /* Print a list of used workarounds */
@@ -708,6 +797,15 @@ bool Context::tryCreate() {
     DefaultFramebuffer::initializeContextBasedFunctionality(*this);
     Renderer::initializeContextBasedFunctionality();
 
+    stateTime = millisecondsSince(timer);
+    if(_displayVerboseInitializationLog) {
+        Debug{output} << "Context startup took" << functionLoadingTime + versionTime + extensionTime + stateTime << "ms:";
+        Debug{output} << "    function loading:" << functionLoadingTime << "ms";
+        Debug{output} << "    version query:" << versionTime << "ms";
+        Debug{output} << "    extension detection:" << extensionTime << "ms";
+        Debug{output} << "    state initialization:" << stateTime << "ms";
+    }
+
     /* Everything okay */
     return true;
 }
@@ -832,6 +930,128 @@ Version Context::supportedVersion(std::initializer_list<Version> versions) const
     #endif
 }
 
+Context::StateStatistics Context::stateStatistics() const {
+    return _state->renderer->statistics;
+}
+
+void Context::resetStateStatistics() {
+    _state->renderer->statistics = {0, 0};
+}
+
+bool Context::isDeletionDeferred() const {
+    return _state->deletion->deferred;
+}
+
+void Context::setDeletionDeferred(const bool deferred) {
+    if(!deferred) flushDeletions();
+    _state->deletion->deferred = deferred;
+}
+
+std::size_t Context::deferredDeletionCount() const {
+    const Implementation::DeletionState& state = *_state->deletion;
+    return state.buffers.size() + state.textures.size() +
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        state.queries.size() +
+        #endif
+        state.vertexArrays.size();
+}
+
+void Context::flushDeletions() {
+    Implementation::DeletionState& state = *_state->deletion;
+
+    if(!state.buffers.empty()) {
+        Buffer::deleteInternal({state.buffers.data(), state.buffers.size()});
+        state.buffers.clear();
+    }
+    if(!state.textures.empty()) {
+        AbstractTexture::deleteInternal({state.textures.data(), state.textures.size()});
+        state.textures.clear();
+    }
+    if(!state.vertexArrays.empty()) {
+        Mesh::deleteInternal({state.vertexArrays.data(), state.vertexArrays.size()});
+        state.vertexArrays.clear();
+    }
+    #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+    if(!state.queries.empty()) {
+        AbstractQuery::deleteInternal({state.queries.data(), state.queries.size()});
+        state.queries.clear();
+    }
+    #endif
+}
+
+bool Context::isMemoryAccountingEnabled() const {
+    return _state->memory->enabled;
+}
+
+void Context::setMemoryAccountingEnabled(const bool enabled) {
+    _state->memory->enabled = enabled;
+    if(!enabled) _state->memory->allocations.clear();
+}
+
+namespace {
+    void addAllocation(Context::MemoryUsage& usage, const Implementation::MemoryState::Allocation& allocation) {
+        std::size_t size = 0;
+        for(const std::size_t part: allocation.parts) size += part;
+
+        switch(allocation.type) {
+            case Implementation::MemoryState::Type::Buffer:
+                usage.buffers += size;
+                break;
+            case Implementation::MemoryState::Type::Texture:
+                usage.textures += size;
+                break;
+            case Implementation::MemoryState::Type::Renderbuffer:
+                usage.renderbuffers += size;
+                break;
+        }
+    }
+}
+
+Context::MemoryUsage Context::memoryUsage() const {
+    MemoryUsage usage{0, 0, 0};
+    for(const auto& allocation: _state->memory->allocations)
+        addAllocation(usage, allocation.second);
+    return usage;
+}
+
+std::vector<std::pair<std::string, Context::MemoryUsage>> Context::memoryUsageByLabel() const {
+    std::map<std::string, MemoryUsage> usages;
+    for(const auto& allocation: _state->memory->allocations)
+        addAllocation(usages.emplace(allocation.second.label, MemoryUsage{0, 0, 0}).first->second, allocation.second);
+    return {usages.begin(), usages.end()};
+}
+
+#ifndef MAGNUM_TARGET_GLES
+Long Context::availableMemory() {
+    /* The queries return the values in kB */
+    if(isExtensionSupported<Extensions::GL::NVX::gpu_memory_info>()) {
+        GLint value;
+        glGetIntegerv(GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX, &value);
+        return Long(value)*1024;
+    }
+
+    /* First value is total free memory in the pool, the rest is the largest
+       free block and auxiliary memory */
+    if(isExtensionSupported<Extensions::GL::ATI::meminfo>()) {
+        GLint values[4];
+        glGetIntegerv(GL_TEXTURE_FREE_MEMORY_ATI, values);
+        return Long(values[0])*1024;
+    }
+
+    return -1;
+}
+
+Long Context::totalMemory() {
+    if(isExtensionSupported<Extensions::GL::NVX::gpu_memory_info>()) {
+        GLint value;
+        glGetIntegerv(GL_GPU_MEMORY_INFO_DEDICATED_VIDMEM_NVX, &value);
+        return Long(value)*1024;
+    }
+
+    return -1;
+}
+#endif
+
 void Context::resetState(const States states) {
     if(states & State::Buffers)
         _state->buffer->reset();
@@ -845,7 +1065,8 @@ void Context::resetState(const States states) {
         _state->renderer->packPixelStorage.reset();
     }
 
-    /* Nothing to reset for renderer yet */
+    if(states & State::Renderer)
+        _state->renderer->shadow.reset();
 
     if(states & State::Shaders) {
         /* Nothing to reset for shaders */
@@ -29,9 +29,12 @@
  * @brief Class @ref Magnum::Context, @ref Magnum::Extension, macro @ref MAGNUM_ASSERT_VERSION_SUPPORTED(), @ref MAGNUM_ASSERT_EXTENSION_SUPPORTED()
  */
 
+#include <cstdint>
 #include <cstdlib>
 #include <array>
 #include <bitset>
+#include <string>
+#include <utility>
 #include <vector>
 #include <Corrade/Containers/EnumSet.h>
 
@@ -112,6 +115,10 @@ Arguments:
     (environment: `MAGNUM_DISABLE_WORKAROUNDS`)
 -   `--magnum-disable-extensions LIST` -- OpenGL extensions to disable
     (environment: `MAGNUM_DISABLE_EXTENSIONS`)
+-   `--magnum-log default|quiet|verbose` -- console logging (environment:
+    `MAGNUM_LOG`) (default: `default`). With `verbose`, a breakdown of
+    context startup time into function loading, version query, extension
+    detection and state initialization is printed as well.
 
 */
 class MAGNUM_EXPORT Context {
@@ -208,6 +215,39 @@ class MAGNUM_EXPORT Context {
          */
         typedef Containers::EnumSet<State> States;
 
+        /**
+         * @brief State tracker statistics
+         *
+         * @see @ref stateStatistics(), @ref resetStateStatistics()
+         */
+        struct StateStatistics {
+            /** @brief Count of state-changing calls passed to OpenGL */
+            std::uint64_t issuedCalls;
+
+            /** @brief Count of redundant state-changing calls skipped */
+            std::uint64_t skippedCalls;
+        };
+
+        /**
+         * @brief GPU memory usage
+         *
+         * All sizes are in bytes.
+         * @see @ref memoryUsage(), @ref memoryUsageByLabel()
+         */
+        struct MemoryUsage {
+            /** @brief Memory allocated by @ref Buffer "Buffers" */
+            std::size_t buffers;
+
+            /** @brief Memory allocated by textures */
+            std::size_t textures;
+
+            /** @brief Memory allocated by @ref Renderbuffer "Renderbuffers" */
+            std::size_t renderbuffers;
+
+            /** @brief Total allocated memory */
+            std::size_t total() const { return buffers + textures + renderbuffers; }
+        };
+
         /**
          * @brief Detected driver
          *
@@ -551,6 +591,136 @@ class MAGNUM_EXPORT Context {
          */
         void resetState(States states = ~States{});
 
+        /**
+         * @brief State tracker statistics
+         *
+         * Counts calls to @ref Renderer feature, blending, depth and stencil
+         * setters since context creation or since last call to
+         * @ref resetStateStatistics(), split into the calls that were passed
+         * to OpenGL and the calls that were skipped because they would not
+         * change the tracked state. Calling @ref resetState() with
+         * @ref State::Renderer makes the next call to each setter always
+         * pass through.
+         */
+        StateStatistics stateStatistics() const;
+
+        /**
+         * @brief Reset state tracker statistics
+         *
+         * Usually called once per frame to get per-frame counts.
+         * @see @ref stateStatistics()
+         */
+        void resetStateStatistics();
+
+        /**
+         * @brief Whether GPU memory accounting is enabled
+         *
+         * @see @ref setMemoryAccountingEnabled()
+         */
+        bool isMemoryAccountingEnabled() const;
+
+        /**
+         * @brief Enable or disable GPU memory accounting
+         *
+         * When enabled, sizes of data and storage allocations of
+         * @ref Buffer "Buffers", textures and @ref Renderbuffer "Renderbuffers"
+         * are recorded together with their debug labels and can be queried
+         * through @ref memoryUsage() and @ref memoryUsageByLabel().
+         * Allocations made before enabling the accounting are not counted,
+         * disabling it discards all records. Disabled by default.
+         *
+         * The sizes are computed from the requested formats and dimensions,
+         * the driver may allocate more due to alignment, padding or
+         * additional internal data. Sizes of compressed formats with unknown
+         * block size and of formats not understood by Magnum are estimated
+         * as four bytes per pixel.
+         */
+        void setMemoryAccountingEnabled(bool enabled);
+
+        /**
+         * @brief GPU memory usage
+         *
+         * Sum of all allocations recorded since
+         * @ref setMemoryAccountingEnabled() "enabling the memory accounting".
+         * Returns zero usage if the accounting is not enabled.
+         * @see @ref memoryUsageByLabel(), @ref availableMemory()
+         */
+        MemoryUsage memoryUsage() const;
+
+        /**
+         * @brief GPU memory usage aggregated by object label
+         *
+         * Same as @ref memoryUsage(), but split by labels set using
+         * @ref Buffer::setLabel(), @ref Texture::setLabel() etc., sorted by
+         * label. Usage of objects without a label is under an empty string.
+         */
+        std::vector<std::pair<std::string, MemoryUsage>> memoryUsageByLabel() const;
+
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Available GPU memory
+         *
+         * Available dedicated video memory in bytes, as reported by the
+         * driver. If neither @extension{NVX,gpu_memory_info} nor
+         * @extension{ATI,meminfo} is available, returns `-1`. In the latter
+         * case the returned value is free memory in the texture memory pool.
+         * @see @ref totalMemory(), @ref memoryUsage()
+         * @requires_gl Memory information queries are not available in
+         *      OpenGL ES or WebGL.
+         */
+        Long availableMemory();
+
+        /**
+         * @brief Total GPU memory
+         *
+         * Total dedicated video memory in bytes, as reported by the driver.
+         * If @extension{NVX,gpu_memory_info} is not available, returns `-1`.
+         * @see @ref availableMemory()
+         * @requires_gl Memory information queries are not available in
+         *      OpenGL ES or WebGL.
+         */
+        Long totalMemory();
+        #endif
+
+        /**
+         * @brief Whether deletion of OpenGL objects is deferred
+         *
+         * @see @ref setDeletionDeferred()
+         */
+        bool isDeletionDeferred() const;
+
+        /**
+         * @brief Enable or disable deferred deletion of OpenGL objects
+         *
+         * When enabled, destructors of @ref Buffer "Buffers", textures,
+         * @ref Mesh "Meshes" and queries don't delete the underlying OpenGL
+         * objects but only put their IDs into a queue. The queue is emptied
+         * by @ref flushDeletions(), which deletes all queued objects of the
+         * same type using a single @fn_gl{DeleteBuffers},
+         * @fn_gl{DeleteTextures}, @fn_gl{DeleteVertexArrays} or
+         * @fn_gl{DeleteQueries} call. Usually called once at the end of a
+         * frame. Disabling the deferred deletion flushes the queue. Disabled
+         * by default.
+         * @see @ref Buffer::createArray(), @ref Texture::createArray()
+         */
+        void setDeletionDeferred(bool deferred);
+
+        /**
+         * @brief Count of objects waiting for deletion
+         *
+         * @see @ref setDeletionDeferred(), @ref flushDeletions()
+         */
+        std::size_t deferredDeletionCount() const;
+
+        /**
+         * @brief Delete all queued objects
+         *
+         * Deletes all objects queued since the last call, see
+         * @ref setDeletionDeferred() for more information. Called also
+         * automatically on context destruction.
+         */
+        void flushDeletions();
+
         /**
          * @brief Detect driver
          *
@@ -581,6 +751,8 @@ class MAGNUM_EXPORT Context {
         /* Defined in Implementation/driverSpecific.cpp */
         MAGNUM_LOCAL void setupDriverWorkarounds();
 
+        MAGNUM_LOCAL static const Extension* findExtension(const std::vector<Extension>& sorted, const char* name, std::size_t length);
+
         #ifndef MAGNUM_TARGET_GLES
         MAGNUM_LOCAL bool isCoreProfileImplementationDefault();
         MAGNUM_LOCAL bool isCoreProfileImplementationNV();
@@ -603,7 +775,7 @@ class MAGNUM_EXPORT Context {
         /* True means known and disabled, false means known */
         std::vector<std::pair<std::string, bool>> _driverWorkarounds;
         std::vector<std::string> _disabledExtensions;
-        bool _displayInitializationLog;
+        bool _displayInitializationLog, _displayVerboseInitializationLog;
 };
 
 #ifndef MAGNUM_TARGET_WEBGL
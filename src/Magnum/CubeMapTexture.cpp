@@ -25,12 +25,17 @@
 
 #include "CubeMapTexture.h"
 
+#include <Corrade/Containers/Array.h>
+
 #ifndef MAGNUM_TARGET_GLES2
 #include "Magnum/BufferImage.h"
 #endif
 #include "Magnum/Context.h"
 #include "Magnum/Image.h"
 
+#ifndef MAGNUM_TARGET_GLES2
+#include "Implementation/imageStaging.h"
+#endif
 #include "Implementation/maxTextureSize.h"
 #include "Implementation/State.h"
 #include "Implementation/TextureState.h"
@@ -343,6 +348,41 @@ CubeMapTexture& CubeMapTexture::setSubImage(const CubeMapCoordinate coordinate,
     return *this;
 }
 
+CubeMapTexture& CubeMapTexture::setSubImages(const Containers::ArrayView<const FaceSubImage> images) {
+    if(images.empty()) return *this;
+
+    const ImageView2D& first = images.front().image;
+    #ifndef MAGNUM_TARGET_GLES2
+    Containers::Array<Containers::ArrayView<const char>> data{images.size()};
+    #endif
+    for(std::size_t i = 0; i != images.size(); ++i) {
+        const ImageView2D& image = images[i].image;
+        CORRADE_ASSERT(image.format() == first.format() && image.type() == first.type() && image.storage() == first.storage(),
+            "CubeMapTexture::setSubImages(): expected all images to have the same format, type and pixel storage but image" << i << "differs", *this);
+        #ifndef MAGNUM_TARGET_GLES2
+        data[i] = image.data();
+        #endif
+    }
+
+    #ifndef MAGNUM_TARGET_GLES2
+    Buffer staging{Buffer::TargetHint::PixelUnpack};
+    const Containers::Array<GLintptr> offsets = Implementation::stageImageData(staging, data);
+    #endif
+    first.storage().applyUnpack();
+    for(std::size_t i = 0; i != images.size(); ++i) {
+        const FaceSubImage& image = images[i];
+        (this->*Context::current().state().texture->cubeSubImageImplementation)(image.coordinate, image.level, image.offset, image.image.size(), first.format(), first.type(),
+            #ifndef MAGNUM_TARGET_GLES2
+            reinterpret_cast<const GLvoid*>(offsets[i])
+            #else
+            image.image.data() + Implementation::pixelStorageSkipOffset(image.image)
+            #endif
+            );
+    }
+
+    return *this;
+}
+
 #ifndef MAGNUM_TARGET_GLES2
 CubeMapTexture& CubeMapTexture::setSubImage(const CubeMapCoordinate coordinate, const Int level, const Vector2i& offset, BufferImage2D& image) {
     image.buffer().bindInternal(Buffer::TargetHint::PixelUnpack);
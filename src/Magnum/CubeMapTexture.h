@@ -31,6 +31,7 @@
 
 #include "Magnum/AbstractTexture.h"
 #include "Magnum/Array.h"
+#include "Magnum/ImageView.h"
 #include "Magnum/Math/Vector2.h"
 
 namespace Magnum {
@@ -83,6 +84,17 @@ texture.setMagnificationFilter(Sampler::Filter::Linear)
     // ...
 @endcode
 
+Alternatively all faces can be uploaded at once using @ref setSubImages(),
+which applies pixel storage only once and, if pixel buffer objects are
+available, uploads all data through a single staging buffer:
+@code
+texture.setSubImages({
+    {CubeMapCoordinate::PositiveX, 0, {}, positiveX},
+    {CubeMapCoordinate::NegativeX, 0, {}, negativeX},
+    // ...
+});
+@endcode
+
 In shader, the texture is used via `samplerCube`, `samplerCubeShadow`,
 `isamplerCube` or `usamplerCube`. Unlike in classic textures, coordinates for
 cube map textures is signed three-part vector from the center of the cube,
@@ -105,6 +117,18 @@ class MAGNUM_EXPORT CubeMapTexture: public AbstractTexture {
         typedef CORRADE_DEPRECATED("use CubeMapCoordinate instead") CubeMapCoordinate Coordinate;
         #endif
 
+        /**
+         * @brief Face subimage
+         *
+         * @see @ref setSubImages()
+         */
+        struct FaceSubImage {
+            CubeMapCoordinate coordinate;   /**< @brief Face */
+            Int level;                      /**< @brief Mip level */
+            Vector2i offset;                /**< @brief Offset in the face */
+            ImageView2D image;              /**< @brief Image */
+        };
+
         /**
          * @brief Max supported size of one side of cube map texture
          *
@@ -1013,6 +1037,28 @@ class MAGNUM_EXPORT CubeMapTexture: public AbstractTexture {
         }
         #endif
 
+        /**
+         * @brief Set subdata of multiple faces
+         * @return Reference to self (for method chaining)
+         *
+         * Equivalent to calling @ref setSubImage(CubeMapCoordinate, Int, const Vector2i&, const ImageView2D&)
+         * for each item, but pixel storage is applied only once and, except
+         * for OpenGL ES 2.0 and WebGL 1.0, the data of all images are copied
+         * into a single temporary pixel unpack buffer. Expects that all
+         * images have the same format, type and pixel storage.
+         * @see @ref setStorage(), @fn_gl{BufferData}, @fn_gl{BufferSubData},
+         *      @fn_gl{PixelStore}, then @fn_gl2{TextureSubImage3D,TexSubImage3D},
+         *      @fn_gl_extension{TextureSubImage2D,EXT,direct_state_access},
+         *      eventually @fn_gl{ActiveTexture}, @fn_gl{BindTexture} and
+         *      @fn_gl{TexSubImage2D}
+         */
+        CubeMapTexture& setSubImages(Containers::ArrayView<const FaceSubImage> images);
+
+        /** @overload */
+        CubeMapTexture& setSubImages(std::initializer_list<FaceSubImage> images) {
+            return setSubImages({images.begin(), images.size()});
+        }
+
         /**
          * @copybrief Texture::setCompressedSubImage()
          * @return Reference to self (for method chaining)
@@ -0,0 +1,94 @@
+#ifndef Magnum_DebugTools_AllocationHooks_h
+#define Magnum_DebugTools_AllocationHooks_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Global allocation hooks for @ref Magnum::DebugTools::Profiler
+ *
+ * Replaces the global `operator new` and `operator delete` with
+ * implementations that count the allocations for
+ * @ref Magnum::DebugTools::Profiler::setAllocationTrackingEnabled() "Profiler allocation tracking".
+ * Include this file in exactly one source file of the application, never in
+ * a header or a library.
+ */
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include "Magnum/DebugTools/visibility.h"
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+namespace Magnum { namespace DebugTools { namespace Implementation {
+    MAGNUM_DEBUGTOOLS_EXPORT void recordAllocation(std::size_t size) noexcept;
+}}}
+
+void* operator new(const std::size_t size) {
+    Magnum::DebugTools::Implementation::recordAllocation(size);
+    void* const memory = std::malloc(size ? size : 1);
+    if(!memory) throw std::bad_alloc{};
+    return memory;
+}
+
+void* operator new[](const std::size_t size) {
+    return operator new(size);
+}
+
+void* operator new(const std::size_t size, const std::nothrow_t&) noexcept {
+    Magnum::DebugTools::Implementation::recordAllocation(size);
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](const std::size_t size, const std::nothrow_t& tag) noexcept {
+    return operator new(size, tag);
+}
+
+void operator delete(void* const memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* const memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* const memory, const std::nothrow_t&) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* const memory, const std::nothrow_t&) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* const memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* const memory, std::size_t) noexcept {
+    std::free(memory);
+}
+#endif
+
+#endif
@@ -0,0 +1,185 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "AsyncReadback.h"
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/BufferImage.h"
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Texture.h"
+#include "Magnum/DebugTools/BufferData.h"
+#include "Magnum/DebugTools/TextureImage.h"
+#include "Magnum/Math/Range.h"
+
+namespace Magnum { namespace DebugTools {
+
+AsyncReadback::AsyncReadback() noexcept: _buffer{NoCreate}, _size{}, _capacity{}, _format{PixelFormat::RGBA}, _type{PixelType::UnsignedByte}, _isImage{} {}
+
+AsyncReadback::AsyncReadback(Buffer& buffer, const GLintptr offset, const GLsizeiptr size): AsyncReadback{buffer, offset, size, Buffer{NoCreate}, 0} {}
+
+AsyncReadback::AsyncReadback(Buffer& buffer, const GLintptr offset, const GLsizeiptr size, Buffer&& staging, std::size_t capacity): _buffer{std::move(staging)}, _size{std::size_t(size)}, _capacity{capacity}, _format{PixelFormat::RGBA}, _type{PixelType::UnsignedByte}, _isImage{} {
+    if(!_buffer.id()) {
+        _buffer = Buffer{Buffer::TargetHint::CopyWrite};
+        _capacity = 0;
+    }
+
+    /* Reallocate only if needed */
+    if(_capacity < _size) {
+        _buffer.setData({nullptr, _size}, BufferUsage::StreamRead);
+        _capacity = _size;
+    }
+
+    if(_size) Buffer::copy(buffer, _buffer, offset, 0, size);
+    _fence.insert();
+}
+
+AsyncReadback::AsyncReadback(Texture2D& texture, const Int level, const Range2Di& range, const PixelStorage& storage, const PixelFormat format, const PixelType type): AsyncReadback{texture, level, range, storage, format, type, Buffer{NoCreate}, 0} {}
+
+AsyncReadback::AsyncReadback(Texture2D& texture, const Int level, const Range2Di& range, const PixelStorage& storage, const PixelFormat format, const PixelType type, Buffer&& staging, std::size_t capacity): _buffer{NoCreate}, _storage{storage}, _format{format}, _type{type}, _imageSize{range.size()}, _isImage{true} {
+    if(!staging.id()) {
+        staging = Buffer{Buffer::TargetHint::PixelPack};
+        capacity = 0;
+    }
+
+    /* The buffer is reallocated by the read only if too small */
+    BufferImage2D image{storage, format, type, {}, std::move(staging), capacity};
+    textureSubImage(texture, level, range, image, BufferUsage::StreamRead);
+
+    _size = Magnum::Implementation::imageDataSize(image);
+    _capacity = image.dataSize();
+    _buffer = image.release();
+    _fence.insert();
+}
+
+AsyncReadback::AsyncReadback(AsyncReadback&&) noexcept = default;
+
+AsyncReadback::~AsyncReadback() = default;
+
+AsyncReadback& AsyncReadback::operator=(AsyncReadback&&) noexcept = default;
+
+bool AsyncReadback::isReady() { return _fence.isSignaled(); }
+
+void AsyncReadback::wait() {
+    if(_fence.isInserted()) _fence.clientWait();
+}
+
+Containers::Array<char> AsyncReadback::data() {
+    wait();
+
+    Containers::Array<char> data{_size};
+    if(_size) Implementation::bufferSubData(_buffer, 0, _size, data);
+    return data;
+}
+
+Image2D AsyncReadback::image() {
+    CORRADE_ASSERT(_isImage, "DebugTools::AsyncReadback::image(): not an image readback",
+        (Image2D{_storage, _format, _type, {}, Containers::Array<char>{}}));
+
+    return Image2D{_storage, _format, _type, _imageSize, data()};
+}
+
+template<class F> void AsyncReadback::map(F f) {
+    wait();
+
+    if(!_size) {
+        f(Containers::ArrayView<const char>{});
+        return;
+    }
+
+    const char* data = _buffer.map<const char>(0, _size, Buffer::MapFlag::Read);
+    f(Containers::ArrayView<const char>{data, _size});
+    _buffer.unmap();
+}
+
+ReadbackQueue::ReadbackQueue() = default;
+
+ReadbackQueue::~ReadbackQueue() = default;
+
+std::pair<Buffer, std::size_t> ReadbackQueue::staging() {
+    if(_staging.empty()) return {Buffer{NoCreate}, 0};
+
+    std::pair<Buffer, std::size_t> staging = std::move(_staging.back());
+    _staging.pop_back();
+    return staging;
+}
+
+ReadbackQueue& ReadbackQueue::bufferSubData(Buffer& buffer, const GLintptr offset, const GLsizeiptr size, DataCallback callback) {
+    std::pair<Buffer, std::size_t> staging = this->staging();
+    _pending.push_back(Pending{AsyncReadback{buffer, offset, size, std::move(staging.first), staging.second}, std::move(callback), nullptr});
+    return *this;
+}
+
+ReadbackQueue& ReadbackQueue::bufferData(Buffer& buffer, DataCallback callback) {
+    return bufferSubData(buffer, 0, buffer.size(), std::move(callback));
+}
+
+ReadbackQueue& ReadbackQueue::textureSubImage(Texture2D& texture, const Int level, const Range2Di& range, const PixelStorage& storage, const PixelFormat format, const PixelType type, ImageCallback callback) {
+    std::pair<Buffer, std::size_t> staging = this->staging();
+    _pending.push_back(Pending{AsyncReadback{texture, level, range, storage, format, type, std::move(staging.first), staging.second}, nullptr, std::move(callback)});
+    return *this;
+}
+
+void ReadbackQueue::complete(Pending& pending) {
+    AsyncReadback& readback = pending.readback;
+    readback.map([&pending, &readback](const Containers::ArrayView<const char> data) {
+        if(readback.isImage()) {
+            if(pending.imageCallback)
+                pending.imageCallback(ImageView2D{readback._storage, readback._format, readback._type, readback._imageSize, data});
+        } else if(pending.dataCallback) pending.dataCallback(data);
+    });
+
+    _staging.emplace_back(std::move(readback._buffer), readback._capacity);
+}
+
+std::size_t ReadbackQueue::poll() {
+    std::size_t count = 0;
+    while(!_pending.empty() && _pending.front().readback.isReady()) {
+        /* Remove from the queue first so the callback can issue new
+           readbacks */
+        Pending pending = std::move(_pending.front());
+        _pending.pop_front();
+        complete(pending);
+        ++count;
+    }
+
+    return count;
+}
+
+void ReadbackQueue::finish() {
+    while(!_pending.empty()) {
+        Pending pending = std::move(_pending.front());
+        _pending.pop_front();
+        complete(pending);
+    }
+}
+
+void ReadbackQueue::releaseStagingBuffers() {
+    _staging.clear();
+}
+
+}}
+#endif
@@ -0,0 +1,377 @@
+#ifndef Magnum_DebugTools_AsyncReadback_h
+#define Magnum_DebugTools_AsyncReadback_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+/** @file
+ * @brief Class @ref Magnum::DebugTools::AsyncReadback, @ref Magnum::DebugTools::ReadbackQueue, function @ref Magnum::DebugTools::bufferSubDataAsync(), @ref Magnum::DebugTools::bufferDataAsync(), @ref Magnum::DebugTools::textureSubImageAsync()
+ */
+#endif
+
+#include <deque>
+#include <functional>
+#include <utility>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/Fence.h"
+#include "Magnum/PixelStorage.h"
+#include "Magnum/DebugTools/DebugTools.h"
+#include "Magnum/DebugTools/visibility.h"
+#include "Magnum/Math/Vector2.h"
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+namespace Magnum { namespace DebugTools {
+
+/**
+@brief Pending GPU readback
+
+Returned by @ref bufferSubDataAsync(), @ref bufferDataAsync() and
+@ref textureSubImageAsync(). Unlike @ref bufferSubData() and
+@ref textureSubImage(), which wait for the GPU to finish all previous commands,
+the data are first copied into a staging buffer on the GPU and a @ref Fence is
+inserted after the copy. The data can be fetched without stalling once
+@ref isReady() returns `true`, usually a frame or two later:
+@code
+DebugTools::AsyncReadback readback = DebugTools::bufferDataAsync(buffer);
+
+// later, e.g. in the next frame
+if(readback.isReady()) {
+    Containers::Array<char> data = readback.data();
+    // ...
+}
+@endcode
+
+For readbacks issued every frame, consider using @ref ReadbackQueue, which
+polls all pending readbacks at once and reuses the staging buffers.
+@requires_gl32 Extension @extension{ARB,sync}
+@requires_gles30 Sync objects and pixel buffer objects are not available in
+    OpenGL ES 2.0.
+@requires_gles Buffer mapping is not available in WebGL.
+*/
+class MAGNUM_DEBUGTOOLS_EXPORT AsyncReadback {
+    friend class ReadbackQueue;
+
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Creates an empty readback without any staging buffer, which is
+         * always ready and has no data. Use @ref bufferSubDataAsync(),
+         * @ref bufferDataAsync() or @ref textureSubImageAsync() to create a
+         * real one.
+         */
+        explicit AsyncReadback() noexcept;
+
+        /**
+         * @brief Read buffer subdata
+         *
+         * Copies @p size bytes at @p offset of @p buffer into a staging
+         * buffer and inserts a fence. Returns immediately.
+         * @see @ref bufferSubDataAsync(), @ref Buffer::copy(),
+         *      @ref Fence::insert()
+         */
+        explicit AsyncReadback(Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Read texture subimage
+         *
+         * Reads given range of a texture mip level into a pixel pack buffer
+         * using the buffer image overload of @ref textureSubImage() and
+         * inserts a fence. Returns immediately.
+         * @see @ref textureSubImageAsync(), @ref Fence::insert()
+         */
+        explicit AsyncReadback(Texture2D& texture, Int level, const Range2Di& range, const PixelStorage& storage, PixelFormat format, PixelType type);
+
+        /** @brief Copying is not allowed */
+        AsyncReadback(const AsyncReadback&) = delete;
+
+        /** @brief Move constructor */
+        AsyncReadback(AsyncReadback&&) noexcept;
+
+        ~AsyncReadback();
+
+        /** @brief Copying is not allowed */
+        AsyncReadback& operator=(const AsyncReadback&) = delete;
+
+        /** @brief Move assignment */
+        AsyncReadback& operator=(AsyncReadback&&) noexcept;
+
+        /** @brief Whether this is an image readback */
+        bool isImage() const { return _isImage; }
+
+        /** @brief Size of the read data in bytes */
+        std::size_t size() const { return _size; }
+
+        /**
+         * @brief Whether the data are available
+         *
+         * Doesn't block. Returns `true` also for an empty readback.
+         * @see @ref Fence::isSignaled()
+         */
+        bool isReady();
+
+        /**
+         * @brief Wait until the data are available
+         *
+         * Blocks until the GPU finishes the copy. Does nothing if the data
+         * are already available.
+         * @see @ref Fence::clientWait()
+         */
+        void wait();
+
+        /**
+         * @brief Read data
+         *
+         * Calls @ref wait(), maps the staging buffer and copies its contents
+         * to client memory. Can be called repeatedly.
+         */
+        Containers::Array<char> data();
+
+        /**
+         * @brief Read image
+         *
+         * Like @ref data(), but returns the data wrapped in an image with the
+         * storage, format, type and size given to @ref textureSubImageAsync().
+         * Expects that this is an image readback.
+         */
+        Image2D image();
+
+    private:
+        /* Used by ReadbackQueue, reads into given staging buffer with given
+           capacity, reallocating it if too small */
+        explicit AsyncReadback(Buffer& buffer, GLintptr offset, GLsizeiptr size, Buffer&& staging, std::size_t capacity);
+        explicit AsyncReadback(Texture2D& texture, Int level, const Range2Di& range, const PixelStorage& storage, PixelFormat format, PixelType type, Buffer&& staging, std::size_t capacity);
+
+        template<class F> void map(F f);
+
+        Buffer _buffer;
+        Fence _fence;
+        std::size_t _size, _capacity;
+        PixelStorage _storage;
+        PixelFormat _format;
+        PixelType _type;
+        Vector2i _imageSize;
+        bool _isImage;
+};
+
+/**
+@brief Non-blocking buffer subdata
+
+Non-blocking alternative to @ref bufferSubData(). Copies @p size bytes at
+@p offset of @p buffer into a staging buffer and returns immediately. See
+@ref AsyncReadback for details.
+@see @ref bufferSubData(), @ref Buffer::copy()
+@requires_gl31 Extension @extension{ARB,copy_buffer}
+@requires_gl32 Extension @extension{ARB,sync}
+@requires_gles30 Buffer copying and sync objects are not available in OpenGL
+    ES 2.0.
+@requires_gles Buffer mapping is not available in WebGL.
+*/
+inline AsyncReadback bufferSubDataAsync(Buffer& buffer, GLintptr offset, GLsizeiptr size) {
+    return AsyncReadback{buffer, offset, size};
+}
+
+/**
+@brief Non-blocking buffer data
+
+Equivalent to calling @ref bufferSubDataAsync() with the whole buffer size.
+@see @ref bufferData()
+@requires_gl31 Extension @extension{ARB,copy_buffer}
+@requires_gl32 Extension @extension{ARB,sync}
+@requires_gles30 Buffer copying and sync objects are not available in OpenGL
+    ES 2.0.
+@requires_gles Buffer mapping is not available in WebGL.
+*/
+MAGNUM_DEBUGTOOLS_EXPORT AsyncReadback bufferDataAsync(Buffer& buffer);
+
+/**
+@brief Non-blocking texture subimage
+
+Non-blocking alternative to @ref textureSubImage(). Reads given range of a
+texture mip level into a pixel pack buffer and returns immediately. The
+data can be then retrieved using @ref AsyncReadback::image(). See
+@ref AsyncReadback for details.
+@requires_gl32 Extension @extension{ARB,sync}
+@requires_gles30 Pixel buffer objects and sync objects are not available in
+    OpenGL ES 2.0.
+@requires_gles Buffer mapping is not available in WebGL.
+*/
+inline AsyncReadback textureSubImageAsync(Texture2D& texture, Int level, const Range2Di& range, const PixelStorage& storage, PixelFormat format, PixelType type) {
+    return AsyncReadback{texture, level, range, storage, format, type};
+}
+
+/**
+@brief Non-blocking texture subimage
+
+Equivalent to calling @ref textureSubImageAsync(Texture2D&, Int, const Range2Di&, const PixelStorage&, PixelFormat, PixelType)
+with default @ref PixelStorage.
+*/
+inline AsyncReadback textureSubImageAsync(Texture2D& texture, Int level, const Range2Di& range, PixelFormat format, PixelType type) {
+    return textureSubImageAsync(texture, level, range, {}, format, type);
+}
+
+/**
+@brief Per-frame readback polling service
+
+Issues readbacks the same way as @ref bufferSubDataAsync() and
+@ref textureSubImageAsync() and calls given callback once the data are
+available, directly with the mapped staging memory, so no additional copy is
+made. Call @ref poll() once per frame; staging buffers of completed readbacks
+are reused for new ones, so a steady stream of readbacks doesn't allocate.
+@code
+DebugTools::ReadbackQueue readbacks;
+
+void MyApplication::drawEvent() {
+    // ...
+
+    readbacks.textureSubImage(histogram, 0, {{}, {256, 1}}, PixelFormat::RedInteger, PixelType::UnsignedInt,
+        [this](const ImageView2D& image) { updateExposure(image); });
+    readbacks.poll();
+
+    swapBuffers();
+}
+@endcode
+
+The callbacks are called from @ref poll() or @ref finish() in the order the
+readbacks were issued.
+@requires_gl32 Extension @extension{ARB,sync}
+@requires_gles30 Pixel buffer objects and sync objects are not available in
+    OpenGL ES 2.0.
+@requires_gles Buffer mapping is not available in WebGL.
+*/
+class MAGNUM_DEBUGTOOLS_EXPORT ReadbackQueue {
+    public:
+        /** @brief Buffer readback callback */
+        typedef std::function<void(Containers::ArrayView<const char>)> DataCallback;
+
+        /** @brief Image readback callback */
+        typedef std::function<void(const ImageView2D&)> ImageCallback;
+
+        /** @brief Constructor */
+        explicit ReadbackQueue();
+
+        /** @brief Copying is not allowed */
+        ReadbackQueue(const ReadbackQueue&) = delete;
+
+        /** @brief Moving is not allowed */
+        ReadbackQueue(ReadbackQueue&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Pending readbacks are discarded without calling their callbacks.
+         */
+        ~ReadbackQueue();
+
+        /** @brief Copying is not allowed */
+        ReadbackQueue& operator=(const ReadbackQueue&) = delete;
+
+        /** @brief Moving is not allowed */
+        ReadbackQueue& operator=(ReadbackQueue&&) = delete;
+
+        /** @brief Count of readbacks that weren't completed yet */
+        std::size_t pendingCount() const { return _pending.size(); }
+
+        /**
+         * @brief Count of staging buffers available for reuse
+         *
+         * Staging buffers of completed readbacks are kept for subsequent
+         * ones. Use @ref releaseStagingBuffers() to free them.
+         */
+        std::size_t stagingBufferCount() const { return _staging.size(); }
+
+        /**
+         * @brief Read buffer subdata
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref bufferSubDataAsync()
+         */
+        ReadbackQueue& bufferSubData(Buffer& buffer, GLintptr offset, GLsizeiptr size, DataCallback callback);
+
+        /**
+         * @brief Read buffer data
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref bufferDataAsync()
+         */
+        ReadbackQueue& bufferData(Buffer& buffer, DataCallback callback);
+
+        /**
+         * @brief Read texture subimage
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref textureSubImageAsync()
+         */
+        ReadbackQueue& textureSubImage(Texture2D& texture, Int level, const Range2Di& range, const PixelStorage& storage, PixelFormat format, PixelType type, ImageCallback callback);
+
+        /** @overload */
+        ReadbackQueue& textureSubImage(Texture2D& texture, Int level, const Range2Di& range, PixelFormat format, PixelType type, ImageCallback callback) {
+            return textureSubImage(texture, level, range, {}, format, type, std::move(callback));
+        }
+
+        /**
+         * @brief Process completed readbacks
+         * @return Count of completed readbacks
+         *
+         * Doesn't block. Calls callbacks of all readbacks that are available,
+         * stopping at the first that isn't, as the GPU completes them in
+         * order.
+         */
+        std::size_t poll();
+
+        /**
+         * @brief Wait for all pending readbacks
+         *
+         * Blocks until all readbacks are available and calls their
+         * callbacks.
+         */
+        void finish();
+
+        /** @brief Free staging buffers kept for reuse */
+        void releaseStagingBuffers();
+
+    private:
+        struct Pending {
+            AsyncReadback readback;
+            DataCallback dataCallback;
+            ImageCallback imageCallback;
+        };
+
+        std::pair<Buffer, std::size_t> staging();
+        void complete(Pending& pending);
+
+        std::deque<Pending> _pending;
+        std::vector<std::pair<Buffer, std::size_t>> _staging;
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 and WebGL build
+#endif
+
+#endif
@@ -47,7 +47,9 @@ namespace Implementation {
 @brief Buffer subdata
 
 Emulates @ref Buffer::subData() call on platforms that don't support it (such
-as OpenGL ES) by using @ref Buffer::map().
+as OpenGL ES) by using @ref Buffer::map(). The call waits until all previous
+commands writing to the buffer are finished, see @ref bufferSubDataAsync() for
+a non-blocking alternative.
 @requires_gles30 Extension @extension{EXT,map_buffer_range} in OpenGL ES
     2.0.
 @requires_gles Buffer mapping is not available in WebGL.
@@ -62,7 +64,9 @@ template<class T> Containers::Array<T> inline bufferSubData(Buffer& buffer, GLin
 @brief Buffer data
 
 Emulates @ref Buffer::data() call on platforms that don't support it (such as
-OpenGL ES) by using @ref Buffer::map().
+OpenGL ES) by using @ref Buffer::map(). The call waits until all previous
+commands writing to the buffer are finished, see @ref bufferDataAsync() for a
+non-blocking alternative.
 @requires_gles30 Extension @extension{EXT,map_buffer_range} in OpenGL ES
     2.0.
 @requires_gles Buffer mapping is not available in WebGL.
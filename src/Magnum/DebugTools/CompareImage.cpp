@@ -25,14 +25,23 @@
 
 #include "CompareImage.h"
 
+#include <atomic>
 #include <map>
 #include <sstream>
 #include <vector>
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#endif
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
+#include "Magnum/Image.h"
 #include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
 #include "Magnum/Math/Functions.h"
 #include "Magnum/Math/Color.h"
+#include "Magnum/Math/Constants.h"
 #include "Magnum/Math/Algorithms/KahanSum.h"
 
 namespace Magnum { namespace DebugTools { namespace Implementation {
@@ -43,7 +52,157 @@ template<std::size_t size, class T> Math::Vector<size, T> pixelAt(const char* co
     return reinterpret_cast<const Math::Vector<size, T>*>(pixels + stride*pos.y())[pos.x()];
 }
 
-template<std::size_t size, class T> Float calculateImageDelta(const ImageView2D& actual, const ImageView2D& expected, std::vector<Float>& output) {
+/* Calculates deltas of one row of pixels, returns max delta in the row. The
+   common formats have specialized implementations below. */
+template<std::size_t size, class T> struct RowDelta {
+    static Float calculate(const char* const actual, const char* const expected, Float* const output, const std::size_t width) {
+        Float max{};
+        for(std::size_t x = 0; x != width; ++x) {
+            Math::Vector<size, Float> actualPixel{reinterpret_cast<const Math::Vector<size, T>*>(actual)[x]};
+            Math::Vector<size, Float> expectedPixel{reinterpret_cast<const Math::Vector<size, T>*>(expected)[x]};
+
+            const Float value = (Math::abs(actualPixel - expectedPixel)).sum()/size;
+            output[x] = value;
+            max = Math::max(max, value);
+        }
+
+        return max;
+    }
+};
+
+/* The specializations give bit-identical results to the generic version --
+   for 8-bit types the channel sums are exact integers and the division is
+   done in the same precision, for floats the subtraction and abs are the
+   same operations, just four at a time. */
+template<> struct RowDelta<4, UnsignedByte> {
+    static Float calculate(const char* const actual, const char* const expected, Float* const output, const std::size_t width) {
+        std::size_t x = 0;
+        Float max{};
+
+        #ifdef __SSE2__
+        /* Four pixels at a time. Absolute byte difference is the saturated
+           difference in both directions ORed together, the per-pixel sums
+           are then done via 16-bit multiply-add and adding even and odd
+           lanes together. */
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i ones = _mm_set1_epi16(1);
+        const __m128 four = _mm_set1_ps(4.0f);
+        __m128 max4 = _mm_setzero_ps();
+        for(; x + 4 <= width; x += 4) {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(actual + x*4));
+            const __m128i e = _mm_loadu_si128(reinterpret_cast<const __m128i*>(expected + x*4));
+            const __m128i d = _mm_or_si128(_mm_subs_epu8(a, e), _mm_subs_epu8(e, a));
+            const __m128 lo = _mm_castsi128_ps(_mm_madd_epi16(_mm_unpacklo_epi8(d, zero), ones));
+            const __m128 hi = _mm_castsi128_ps(_mm_madd_epi16(_mm_unpackhi_epi8(d, zero), ones));
+            const __m128i sum = _mm_add_epi32(
+                _mm_castps_si128(_mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0))),
+                _mm_castps_si128(_mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1))));
+            const __m128 value = _mm_div_ps(_mm_cvtepi32_ps(sum), four);
+            _mm_storeu_ps(output + x, value);
+            max4 = _mm_max_ps(value, max4);
+        }
+
+        alignas(16) Float maxs[4];
+        _mm_store_ps(maxs, max4);
+        for(Float m: maxs) max = Math::max(max, m);
+        #endif
+
+        for(; x != width; ++x) {
+            const UnsignedByte* const a = reinterpret_cast<const UnsignedByte*>(actual) + x*4;
+            const UnsignedByte* const e = reinterpret_cast<const UnsignedByte*>(expected) + x*4;
+            const Int sum = Math::abs(Int(a[0]) - Int(e[0])) +
+                            Math::abs(Int(a[1]) - Int(e[1])) +
+                            Math::abs(Int(a[2]) - Int(e[2])) +
+                            Math::abs(Int(a[3]) - Int(e[3]));
+            const Float value = Float(sum)/4.0f;
+            output[x] = value;
+            max = Math::max(max, value);
+        }
+
+        return max;
+    }
+};
+
+template<> struct RowDelta<3, UnsignedByte> {
+    /* Three-byte pixels don't map well to SSE2 without a byte shuffle, but
+       staying in integers instead of going through float vectors already
+       gives most of the speedup */
+    static Float calculate(const char* const actual, const char* const expected, Float* const output, const std::size_t width) {
+        Float max{};
+        for(std::size_t x = 0; x != width; ++x) {
+            const UnsignedByte* const a = reinterpret_cast<const UnsignedByte*>(actual) + x*3;
+            const UnsignedByte* const e = reinterpret_cast<const UnsignedByte*>(expected) + x*3;
+            const Int sum = Math::abs(Int(a[0]) - Int(e[0])) +
+                            Math::abs(Int(a[1]) - Int(e[1])) +
+                            Math::abs(Int(a[2]) - Int(e[2]));
+            const Float value = Float(sum)/3.0f;
+            output[x] = value;
+            max = Math::max(max, value);
+        }
+
+        return max;
+    }
+};
+
+template<> struct RowDelta<1, Float> {
+    static Float calculate(const char* const actual, const char* const expected, Float* const output, const std::size_t width) {
+        const Float* const a = reinterpret_cast<const Float*>(actual);
+        const Float* const e = reinterpret_cast<const Float*>(expected);
+        std::size_t x = 0;
+        Float max{};
+
+        #ifdef __SSE2__
+        /* Abs is clearing the sign bit. The max has the new value first so
+           NaNs get ignored the same way as with Math::max() below. */
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+        __m128 max4 = _mm_setzero_ps();
+        for(; x + 4 <= width; x += 4) {
+            const __m128 value = _mm_andnot_ps(signMask, _mm_sub_ps(_mm_loadu_ps(a + x), _mm_loadu_ps(e + x)));
+            _mm_storeu_ps(output + x, value);
+            max4 = _mm_max_ps(value, max4);
+        }
+
+        alignas(16) Float maxs[4];
+        _mm_store_ps(maxs, max4);
+        for(Float m: maxs) max = Math::max(max, m);
+        #endif
+
+        for(; x != width; ++x) {
+            const Float value = Math::abs(a[x] - e[x]);
+            output[x] = value;
+            max = Math::max(max, value);
+        }
+
+        return max;
+    }
+};
+
+/* Calls function(part, begin, end) on evenly split parts of [0, count) range
+   in parallel */
+template<class F> void parallelFor(const std::size_t count, const std::size_t partCount, const F& function) {
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    if(partCount > 1) {
+        std::vector<std::thread> threads;
+        threads.reserve(partCount - 1);
+        for(std::size_t i = 1; i != partCount; ++i)
+            threads.emplace_back(function, i, count*i/partCount, count*(i + 1)/partCount);
+        function(std::size_t{0}, std::size_t{0}, count/partCount);
+        for(std::thread& thread: threads) thread.join();
+        return;
+    }
+    #else
+    static_cast<void>(partCount);
+    #endif
+
+    function(std::size_t{0}, std::size_t{0}, count);
+}
+
+/* Images smaller than this many pixels per thread are not worth splitting */
+constexpr std::size_t MinPixelsPerThread = 65536;
+
+/* Returns max delta. If there's a delta above earlyOutThreshold, stops and
+   saves position of the first such pixel to earlyOutPosition. */
+template<std::size_t size, class T> Float calculateImageDelta(const ImageView2D& actual, const ImageView2D& expected, std::vector<Float>& output, UnsignedInt threadCount, const Float earlyOutThreshold, Vector2i& earlyOutPosition) {
     CORRADE_INTERNAL_ASSERT(output.size() == std::size_t(expected.size().product()));
 
     /* Precalculate parameters for pixel access */
@@ -57,23 +216,67 @@ template<std::size_t size, class T> Float calculateImageDelta(const ImageView2D&
     const char* const expectedPixels = expected.data() + dataOffset.sum();
     const std::size_t expectedStride = dataSize.x();
 
-    /* Calculate deltas and maximal value of them */
-    Float max{};
-    for(std::int_fast32_t y = 0; y != expected.size().y(); ++y) {
-        for(std::int_fast32_t x = 0; x != expected.size().x(); ++x) {
-            Math::Vector<size, Float> actualPixel{pixelAt<size, T>(actualPixels, actualStride, {Int(x), Int(y)})};
-            Math::Vector<size, Float> expectedPixel{pixelAt<size, T>(expectedPixels, expectedStride, {Int(x), Int(y)})};
+    const std::size_t width = expected.size().x();
+    const std::size_t height = expected.size().y();
+
+    /* Split the rows between threads. If the thread count is not specified,
+       use all cores but only if the image is large enough. */
+    std::size_t partCount = 1;
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    if(!threadCount) threadCount = std::min(std::max(std::thread::hardware_concurrency(), 1u),
+        UnsignedInt(std::max(width*height/MinPixelsPerThread, std::size_t{1})));
+    partCount = std::max(std::min(std::size_t{threadCount}, height), std::size_t{1});
+    #else
+    static_cast<void>(threadCount);
+    #endif
 
-            const Float value = (Math::abs(actualPixel - expectedPixel)).sum()/size;
-            output[y*expected.size().x() + x] = value;
-            max = Math::max(max, value);
+    /* Calculate deltas and maximal value of them. With early out, each part
+       stops once it's past the first row containing a delta above the
+       threshold found so far, so the earliest such row is always found
+       regardless of how the work got scheduled. */
+    std::vector<Float> maxs(partCount);
+    std::atomic<std::size_t> earlyOutRow{height};
+    parallelFor(height, partCount, [&](const std::size_t part, const std::size_t begin, const std::size_t end) {
+        Float max{};
+        for(std::size_t y = begin; y != end; ++y) {
+            if(y > earlyOutRow.load(std::memory_order_relaxed)) break;
+
+            const Float rowMax = RowDelta<size, T>::calculate(
+                actualPixels + y*actualStride,
+                expectedPixels + y*expectedStride,
+                output.data() + y*width, width);
+            max = Math::max(max, rowMax);
+
+            if(rowMax > earlyOutThreshold) {
+                std::size_t current = earlyOutRow.load();
+                while(y < current && !earlyOutRow.compare_exchange_weak(current, y)) {}
+                break;
+            }
+        }
+
+        maxs[part] = max;
+    });
+
+    /* Find the first offending pixel in the row, report its delta as the max
+       as the rest of the image is not complete */
+    if(earlyOutRow != height) {
+        const std::size_t y = earlyOutRow;
+        for(std::size_t x = 0; x != width; ++x) {
+            if(output[y*width + x] > earlyOutThreshold) {
+                earlyOutPosition = {Int(x), Int(y)};
+                return output[y*width + x];
+            }
         }
+
+        CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
     }
 
+    Float max{};
+    for(Float m: maxs) max = Math::max(max, m);
     return max;
 }
 
-template<class T> Float calculateIntegerImageDelta(const ImageView2D& actual, const ImageView2D& expected, std::vector<Float>& output) {
+template<class T> Float calculateIntegerImageDelta(const ImageView2D& actual, const ImageView2D& expected, std::vector<Float>& output, const UnsignedInt threadCount, const Float earlyOutThreshold, Vector2i& earlyOutPosition) {
     if(
         #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
         expected.format() == PixelFormat::Red
@@ -87,7 +290,7 @@ template<class T> Float calculateIntegerImageDelta(const ImageView2D& actual, co
         expected.format() == PixelFormat::Luminance
         #endif
         )
-        return calculateImageDelta<1, T>(actual, expected, output);
+        return calculateImageDelta<1, T>(actual, expected, output, threadCount, earlyOutThreshold, earlyOutPosition);
     else if(
         #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
         expected.format() == PixelFormat::RG
@@ -101,24 +304,24 @@ template<class T> Float calculateIntegerImageDelta(const ImageView2D& actual, co
         expected.format() == PixelFormat::LuminanceAlpha
         #endif
         )
-        return calculateImageDelta<2, T>(actual, expected, output);
+        return calculateImageDelta<2, T>(actual, expected, output, threadCount, earlyOutThreshold, earlyOutPosition);
     else if(expected.format() == PixelFormat::RGB
         #ifndef MAGNUM_TARGET_GLES2
         || expected.format() == PixelFormat::RGBInteger
         #endif
         )
-        return calculateImageDelta<3, T>(actual, expected, output);
+        return calculateImageDelta<3, T>(actual, expected, output, threadCount, earlyOutThreshold, earlyOutPosition);
     else if(expected.format() == PixelFormat::RGBA
         #ifndef MAGNUM_TARGET_GLES2
         || expected.format() == PixelFormat::RGBAInteger
         #endif
         )
-        return calculateImageDelta<4, T>(actual, expected, output);
+        return calculateImageDelta<4, T>(actual, expected, output, threadCount, earlyOutThreshold, earlyOutPosition);
 
     CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
 }
 
-template<class T> Float calculateImageDelta(const ImageView2D& actual, const ImageView2D& expected, std::vector<Float>& output) {
+template<class T> Float calculateImageDelta(const ImageView2D& actual, const ImageView2D& expected, std::vector<Float>& output, const UnsignedInt threadCount, const Float earlyOutThreshold, Vector2i& earlyOutPosition) {
     if(
         #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
         expected.format() == PixelFormat::Red
@@ -130,7 +333,7 @@ template<class T> Float calculateImageDelta(const ImageView2D& actual, const Ima
         expected.format() == PixelFormat::Luminance
         #endif
         )
-        return calculateImageDelta<1, T>(actual, expected, output);
+        return calculateImageDelta<1, T>(actual, expected, output, threadCount, earlyOutThreshold, earlyOutPosition);
     else if(
         #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
         expected.format() == PixelFormat::RG
@@ -142,39 +345,88 @@ template<class T> Float calculateImageDelta(const ImageView2D& actual, const Ima
         expected.format() == PixelFormat::LuminanceAlpha
         #endif
         )
-        return calculateImageDelta<2, T>(actual, expected, output);
+        return calculateImageDelta<2, T>(actual, expected, output, threadCount, earlyOutThreshold, earlyOutPosition);
     else if(expected.format() == PixelFormat::RGB)
-        return calculateImageDelta<3, T>(actual, expected, output);
+        return calculateImageDelta<3, T>(actual, expected, output, threadCount, earlyOutThreshold, earlyOutPosition);
     else if(expected.format() == PixelFormat::RGBA)
-        return calculateImageDelta<4, T>(actual, expected, output);
+        return calculateImageDelta<4, T>(actual, expected, output, threadCount, earlyOutThreshold, earlyOutPosition);
 
     CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
 }
 
 }
 
-std::tuple<std::vector<Float>, Float, Float> calculateImageDelta(const ImageView2D& actual, const ImageView2D& expected) {
-    /* Calculate a delta image */
-    std::vector<Float> delta(expected.size().product());
+namespace {
 
-    Float max;
+Float calculateImageDelta(const ImageView2D& actual, const ImageView2D& expected, std::vector<Float>& delta, const UnsignedInt threadCount, const Float earlyOutThreshold, Vector2i& earlyOutPosition) {
     if(expected.type() == PixelType::UnsignedByte)
-        max = calculateIntegerImageDelta<UnsignedByte>(actual, expected, delta);
+        return calculateIntegerImageDelta<UnsignedByte>(actual, expected, delta, threadCount, earlyOutThreshold, earlyOutPosition);
     else if(expected.type() == PixelType::UnsignedShort)
-        max = calculateIntegerImageDelta<UnsignedShort>(actual, expected, delta);
+        return calculateIntegerImageDelta<UnsignedShort>(actual, expected, delta, threadCount, earlyOutThreshold, earlyOutPosition);
     else if(expected.type() == PixelType::UnsignedInt)
-        max = calculateIntegerImageDelta<UnsignedInt>(actual, expected, delta);
+        return calculateIntegerImageDelta<UnsignedInt>(actual, expected, delta, threadCount, earlyOutThreshold, earlyOutPosition);
     #ifndef MAGNUM_TARGET_GLES2
     else if(expected.type() == PixelType::Byte)
-        max = calculateIntegerImageDelta<Byte>(actual, expected, delta);
+        return calculateIntegerImageDelta<Byte>(actual, expected, delta, threadCount, earlyOutThreshold, earlyOutPosition);
     else if(expected.type() == PixelType::Short)
-        max = calculateIntegerImageDelta<Short>(actual, expected, delta);
+        return calculateIntegerImageDelta<Short>(actual, expected, delta, threadCount, earlyOutThreshold, earlyOutPosition);
     else if(expected.type() == PixelType::Int)
-        max = calculateIntegerImageDelta<Int>(actual, expected, delta);
+        return calculateIntegerImageDelta<Int>(actual, expected, delta, threadCount, earlyOutThreshold, earlyOutPosition);
     #endif
     else if(expected.type() == PixelType::Float)
-        max = calculateImageDelta<Float>(actual, expected, delta);
-    else CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+        return calculateImageDelta<Float>(actual, expected, delta, threadCount, earlyOutThreshold, earlyOutPosition);
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+}
+
+bool isPixelFormatSupported(const PixelFormat format, const PixelType type) {
+    return (
+        (
+            #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+            format == PixelFormat::Red ||
+            format == PixelFormat::RG ||
+            #endif
+            #ifndef MAGNUM_TARGET_GLES2
+            format == PixelFormat::RedInteger ||
+            format == PixelFormat::RGInteger ||
+            format == PixelFormat::RGBInteger ||
+            format == PixelFormat::RGBAInteger ||
+            #else
+            format == PixelFormat::Luminance ||
+            format == PixelFormat::LuminanceAlpha ||
+            #endif
+            format == PixelFormat::RGB ||
+            format == PixelFormat::RGBA
+        ) && (
+            #ifndef MAGNUM_TARGET_GLES2
+            type == PixelType::Byte ||
+            type == PixelType::Short ||
+            type == PixelType::Int ||
+            #endif
+            type == PixelType::UnsignedByte ||
+            type == PixelType::UnsignedShort ||
+            type == PixelType::UnsignedInt
+        )) || ((
+            #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+            format == PixelFormat::Red ||
+            format == PixelFormat::RG ||
+            #endif
+            #ifdef MAGNUM_TARGET_GLES2
+            format == PixelFormat::Luminance ||
+            format == PixelFormat::LuminanceAlpha ||
+            #endif
+            format == PixelFormat::RGB ||
+            format == PixelFormat::RGBA
+        ) && type == PixelType::Float);
+}
+
+std::tuple<std::vector<Float>, Float, Float> calculateImageDelta(const ImageView2D& actual, const ImageView2D& expected, const UnsignedInt threadCount) {
+    /* Calculate a delta image */
+    std::vector<Float> delta(expected.size().product());
+    Vector2i earlyOutPosition;
+    const Float max = calculateImageDelta(actual, expected, delta, threadCount, Constants::inf(), earlyOutPosition);
 
     /* Calculate mean delta. Do it the special way so we don't lose
        precision -- that would result in having false negatives! */
@@ -183,6 +435,40 @@ std::tuple<std::vector<Float>, Float, Float> calculateImageDelta(const ImageView
     return std::make_tuple(delta, max, mean);
 }
 
+std::tuple<std::vector<Float>, Float, Float, Vector2i> calculateImageDeltaEarlyOut(const ImageView2D& actual, const ImageView2D& expected, const Float maxThreshold, const UnsignedInt threadCount) {
+    std::vector<Float> delta(expected.size().product());
+    Vector2i earlyOutPosition{-1};
+    const Float max = calculateImageDelta(actual, expected, delta, threadCount, maxThreshold, earlyOutPosition);
+
+    /* The delta image is incomplete if we stopped early, don't calculate
+       the mean in that case */
+    const Float mean = earlyOutPosition == Vector2i{-1} ?
+        Math::Algorithms::kahanSum(delta.begin(), delta.end())/delta.size() : 0.0f;
+
+    return std::make_tuple(delta, max, mean, earlyOutPosition);
+}
+
+Image2D deltaHeatmap(const std::vector<Float>& delta, const Vector2i& size, const Float max, const Float maxThreshold, const Float meanThreshold) {
+    CORRADE_INTERNAL_ASSERT(delta.size() == std::size_t(size.product()));
+
+    Containers::Array<char> data{std::size_t(size.product()*3)};
+    for(std::size_t i = 0; i != delta.size(); ++i) {
+        /* Nonzero deltas are always at least a bit visible */
+        const UnsignedByte value = delta[i] > 0.0f ?
+            UnsignedByte(64 + Math::round(Math::min(delta[i]/max, 1.0f)*191.0f)) : 0;
+
+        Math::Color3<UnsignedByte>& pixel = Math::Color3<UnsignedByte>::from(reinterpret_cast<UnsignedByte*>(data.data()) + i*3);
+        if(delta[i] > maxThreshold)
+            pixel = {value, 0, 0};
+        else if(delta[i] > meanThreshold)
+            pixel = {value, value, 0};
+        else
+            pixel = Math::Color3<UnsignedByte>{value};
+    }
+
+    return Image2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB, PixelType::UnsignedByte, size, std::move(data)};
+}
+
 namespace {
     /* Done by printing an white to black gradient using one of the online
        ASCII converters. Yes, I'm lazy. Another one could be " .,:;ox%#@". */
@@ -322,6 +608,22 @@ void printPixelAt(Debug& out, const char* const pixels, const std::size_t stride
     else CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
 }
 
+void printPixelDelta(Debug& out, const char* const actualPixels, const std::size_t actualStride, const char* const expectedPixels, const std::size_t expectedStride, const Vector2i& pos, const PixelFormat format, const PixelType type, const Float delta, const Float maxThreshold) {
+    out << "          [" << Debug::nospace << pos.x()
+        << Debug::nospace << "," << Debug::nospace << pos.y()
+        << Debug::nospace << "]";
+
+    printPixelAt(out, actualPixels, actualStride, pos, format, type);
+
+    out << Debug::nospace << ", expected";
+
+    printPixelAt(out, expectedPixels, expectedStride, pos, format, type);
+
+    out << "(Δ =" << Debug::boldColor(delta > maxThreshold ?
+        Debug::Color::Red : Debug::Color::Yellow) << delta
+        << Debug::nospace << Debug::resetColor << ")";
+}
+
 }
 
 void printPixelDeltas(Debug& out, const std::vector<Float>& delta, const ImageView2D& actual, const ImageView2D& expected, const Float maxThreshold, const Float meanThreshold, std::size_t maxCount) {
@@ -359,20 +661,23 @@ void printPixelDeltas(Debug& out, const std::vector<Float>& delta, const ImageVi
 
         Vector2i pos;
         std::tie(pos.y(), pos.x()) = Math::div(Int(it->second), expected.size().x());
-        out << Debug::newline << "          [" << Debug::nospace << pos.x()
-            << Debug::nospace << "," << Debug::nospace << pos.y()
-            << Debug::nospace << "]";
+        out << Debug::newline;
+        printPixelDelta(out, actualPixels, actualStride, expectedPixels, expectedStride, pos, expected.format(), expected.type(), delta[it->second], maxThreshold);
+    }
+}
 
-        printPixelAt(out, actualPixels, actualStride, pos, expected.format(), expected.type());
+void printPixelDelta(Debug& out, const ImageView2D& actual, const ImageView2D& expected, const Vector2i& pos, const Float delta, const Float maxThreshold) {
+    Math::Vector2<std::size_t> offset, size;
 
-        out << Debug::nospace << ", expected";
+    std::tie(offset, size, std::ignore) = actual.dataProperties();
+    const char* const actualPixels = actual.data() + offset.sum();
+    const std::size_t actualStride = size.x();
 
-        printPixelAt(out, expectedPixels, expectedStride, pos, expected.format(), expected.type());
+    std::tie(offset, size, std::ignore) = expected.dataProperties();
+    const char* const expectedPixels = expected.data() + offset.sum();
+    const std::size_t expectedStride = size.x();
 
-        out << "(Δ =" << Debug::boldColor(delta[it->second] > maxThreshold ?
-            Debug::Color::Red : Debug::Color::Yellow) << delta[it->second]
-            << Debug::nospace << Debug::resetColor << ")";
-    }
+    printPixelDelta(out, actualPixels, actualStride, expectedPixels, expectedStride, pos, expected.format(), expected.type(), delta, maxThreshold);
 }
 
 }}}
@@ -404,56 +709,25 @@ bool Comparator<DebugTools::CompareImage>::operator()(const ImageView2D& actual,
     }
 
     /* Assert on unsupported format/storage */
-    #ifndef CORRADE_NO_DEBUG
-    const bool formatSupported = (
-        (
-            #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
-            expected.format() == PixelFormat::Red ||
-            expected.format() == PixelFormat::RG ||
-            #endif
-            #ifndef MAGNUM_TARGET_GLES2
-            expected.format() == PixelFormat::RedInteger ||
-            expected.format() == PixelFormat::RGInteger ||
-            expected.format() == PixelFormat::RGBInteger ||
-            expected.format() == PixelFormat::RGBAInteger ||
-            #else
-            expected.format() == PixelFormat::Luminance ||
-            expected.format() == PixelFormat::LuminanceAlpha ||
-            #endif
-            expected.format() == PixelFormat::RGB ||
-            expected.format() == PixelFormat::RGBA
-        ) && (
-            #ifndef MAGNUM_TARGET_GLES2
-            expected.type() == PixelType::Byte ||
-            expected.type() == PixelType::Short ||
-            expected.type() == PixelType::Int ||
-            #endif
-            expected.type() == PixelType::UnsignedByte ||
-            expected.type() == PixelType::UnsignedShort ||
-            expected.type() == PixelType::UnsignedInt
-        )) || ((
-            #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
-            expected.format() == PixelFormat::Red ||
-            expected.format() == PixelFormat::RG ||
-            #endif
-            #ifdef MAGNUM_TARGET_GLES2
-            expected.format() == PixelFormat::Luminance ||
-            expected.format() == PixelFormat::LuminanceAlpha ||
-            #endif
-            expected.format() == PixelFormat::RGB ||
-            expected.format() == PixelFormat::RGBA
-        ) && expected.type() == PixelType::Float);
     CORRADE_ASSERT(
-        formatSupported,
+        DebugTools::Implementation::isPixelFormatSupported(expected.format(), expected.type()),
         "DebugTools::CompareImage: format" << expected.format() << Debug::nospace << "/" << expected.type() << "is not supported", {});
-    #endif
     #ifndef MAGNUM_TARGET_GLES
     CORRADE_ASSERT(!actual.storage().swapBytes() && !expected.storage().swapBytes(),
         "DebugTools::CompareImage: pixel storage with byte swap is not supported", {});
     #endif
 
     std::vector<Float> delta;
-    std::tie(delta, _max, _mean) = DebugTools::Implementation::calculateImageDelta(actual, expected);
+    if(_earlyOut) {
+        std::tie(delta, _max, _mean, _earlyOutPosition) = DebugTools::Implementation::calculateImageDeltaEarlyOut(actual, expected, _maxThreshold);
+
+        /* Stopped on a pixel above max threshold, the rest of the delta
+           image is not calculated so there's nothing more to save */
+        if(_earlyOutPosition != Vector2i{-1}) {
+            _state = State::AboveMaxThresholdEarlyOut;
+            return false;
+        }
+    } else std::tie(delta, _max, _mean) = DebugTools::Implementation::calculateImageDelta(actual, expected);
 
     /* If both values are not above threshold, success */
     if(_max > _maxThreshold && _mean > _meanThreshold)
@@ -479,7 +753,14 @@ void Comparator<DebugTools::CompareImage>::printErrorMessage(Debug& out, const s
             << Debug::nospace << "/" << Debug::nospace << _actualImage->type()
             << "but" << _expectedImage->format() << Debug::nospace << "/"
             << Debug::nospace << _expectedImage->type() << "expected.";
-    else {
+    else if(_state == State::AboveMaxThresholdEarlyOut) {
+        out << "max delta above threshold, actual" << _max << "at ["
+            << Debug::nospace << _earlyOutPosition.x() << Debug::nospace
+            << "," << Debug::nospace << _earlyOutPosition.y() << Debug::nospace
+            << "] but at most" << _maxThreshold
+            << "expected. Stopped at first such pixel:" << Debug::newline;
+        DebugTools::Implementation::printPixelDelta(out, *_actualImage, *_expectedImage, _earlyOutPosition, _max, _maxThreshold);
+    } else {
         if(_state == State::AboveThresholds)
             out << "both max and mean delta above threshold, actual"
                 << _max << Debug::nospace << "/" << Debug::nospace << _mean
@@ -39,11 +39,27 @@
 namespace Magnum { namespace DebugTools {
 
 namespace Implementation {
-    MAGNUM_DEBUGTOOLS_EXPORT std::tuple<std::vector<Float>, Float, Float> calculateImageDelta(const ImageView2D& actual, const ImageView2D& expected);
+    MAGNUM_DEBUGTOOLS_EXPORT bool isPixelFormatSupported(PixelFormat format, PixelType type);
+
+    /* If threadCount is 0, the rows are split between all cores for large
+       enough images */
+    MAGNUM_DEBUGTOOLS_EXPORT std::tuple<std::vector<Float>, Float, Float> calculateImageDelta(const ImageView2D& actual, const ImageView2D& expected, UnsignedInt threadCount = 0);
+
+    /* Stops on the first row containing a delta above maxThreshold and
+       returns position of the first such pixel, with its delta as the max
+       and zero mean. Otherwise the position is -1 and the rest is the same
+       as above. */
+    MAGNUM_DEBUGTOOLS_EXPORT std::tuple<std::vector<Float>, Float, Float, Vector2i> calculateImageDeltaEarlyOut(const ImageView2D& actual, const ImageView2D& expected, Float maxThreshold, UnsignedInt threadCount = 0);
+
+    /* RGB8 visualization of the delta image, gray below mean threshold,
+       yellow above it and red above max threshold */
+    MAGNUM_DEBUGTOOLS_EXPORT Image2D deltaHeatmap(const std::vector<Float>& delta, const Vector2i& size, Float max, Float maxThreshold, Float meanThreshold);
 
     MAGNUM_DEBUGTOOLS_EXPORT void printDeltaImage(Debug& out, const std::vector<Float>& delta, const Vector2i& size, Float max, Float maxThreshold, Float meanThreshold);
 
     MAGNUM_DEBUGTOOLS_EXPORT void printPixelDeltas(Debug& out, const std::vector<Float>& delta, const ImageView2D& actual, const ImageView2D& expected, Float maxThreshold, Float meanThreshold, std::size_t maxCount);
+
+    MAGNUM_DEBUGTOOLS_EXPORT void printPixelDelta(Debug& out, const ImageView2D& actual, const ImageView2D& expected, const Vector2i& pos, Float delta, Float maxThreshold);
 }
 
 class CompareImage;
@@ -61,6 +77,8 @@ template<> class MAGNUM_DEBUGTOOLS_EXPORT Comparator<Magnum::DebugTools::Compare
 
         /*implicit*/ Comparator(): Comparator{0.0f, 0.0f} {}
 
+        void setEarlyOut(bool enabled) { _earlyOut = enabled; }
+
         bool operator()(const Magnum::ImageView2D& actual, const Magnum::ImageView2D& expected);
 
         void printErrorMessage(Utility::Debug& out, const std::string& actual, const std::string& expected) const;
@@ -71,14 +89,17 @@ template<> class MAGNUM_DEBUGTOOLS_EXPORT Comparator<Magnum::DebugTools::Compare
             DifferentFormat,
             AboveThresholds,
             AboveMeanThreshold,
-            AboveMaxThreshold
+            AboveMaxThreshold,
+            AboveMaxThresholdEarlyOut
         };
 
         Magnum::Float _maxThreshold, _meanThreshold;
+        bool _earlyOut{};
 
         State _state{};
         const Magnum::ImageView2D *_actualImage, *_expectedImage;
         Magnum::Float _max, _mean;
+        Magnum::Vector2i _earlyOutPosition;
         std::vector<Magnum::Float> _delta;
 };
 
@@ -139,6 +160,11 @@ printed as characters of different perceived brightness. Blocks with delta over
 the max threshold are colored red, blocks with delta over the mean threshold
 are colored yellow. The delta list contains X,Y pixel position (with origin at
 bottom left), actual and expected pixel value and calculated delta.
+
+If you only care whether the images match, enable @ref setEarlyOut(). The
+comparison then stops on the first row containing a pixel above the max
+threshold and the diagnostic output contains just that pixel. Large images are
+compared in multiple threads, with rows split evenly between them.
 */
 class CompareImage {
     public:
@@ -158,6 +184,20 @@ class CompareImage {
          */
         explicit CompareImage(): CompareImage{0.0f, 0.0f} {}
 
+        /**
+         * @brief Enable or disable early out
+         * @return Reference to self (for method chaining)
+         *
+         * If enabled, the comparison stops on the first pixel with delta
+         * above the max threshold and reports its position instead of the
+         * full delta image. The mean threshold is checked only if all
+         * pixels are below the max threshold. Disabled by default.
+         */
+        CompareImage& setEarlyOut(bool enabled) {
+            _c.setEarlyOut(enabled);
+            return *this;
+        }
+
         #ifndef DOXYGEN_GENERATING_OUTPUT
         Corrade::TestSuite::Comparator<CompareImage>& comparator() {
             return _c;
@@ -34,6 +34,14 @@
 namespace Magnum { namespace DebugTools {
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+class AsyncReadback;
+#endif
+
+#ifndef MAGNUM_TARGET_WEBGL
+class DynamicResolution;
+#endif
+
 template<UnsignedInt> class ForceRenderer;
 typedef ForceRenderer<2> ForceRenderer2D;
 typedef ForceRenderer<3> ForceRenderer3D;
@@ -44,7 +52,16 @@ typedef ObjectRenderer<2> ObjectRenderer2D;
 typedef ObjectRenderer<3> ObjectRenderer3D;
 class ObjectRendererOptions;
 
+#ifndef MAGNUM_TARGET_GLES
+class GLTrace;
+class GLTraceReplay;
+#endif
+
+class PerformanceWarnings;
 class Profiler;
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+class ReadbackQueue;
+#endif
 class ResourceManager;
 
 template<UnsignedInt> class ShapeRenderer;
@@ -0,0 +1,177 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DynamicResolution.h"
+
+#include <algorithm>
+#include <cmath>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Range.h"
+
+namespace Magnum { namespace DebugTools {
+
+namespace {
+    /* Weight of a new sample in the moving average */
+    constexpr Float CostSmoothing = 0.2f;
+}
+
+DynamicResolution::DynamicResolution(const Vector2i& size, const Float targetTime, const RenderbufferFormat colorFormat, const RenderbufferFormat depthStencilFormat): _framebuffer{{{}, size}}, _colorFormat{colorFormat}, _depthStencilFormat{depthStencilFormat}, _size{size}, _targetTime{targetTime} {
+    allocate();
+    setLatency(3);
+}
+
+DynamicResolution::~DynamicResolution() = default;
+
+void DynamicResolution::allocate() {
+    const Vector2i size = Math::max(Vector2i{Vector2{_size}*_maxScale}, Vector2i{1});
+    _color.setStorage(_colorFormat, size);
+    _depthStencil.setStorage(_depthStencilFormat, size);
+
+    _framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment{0}, _color);
+    #if !defined(MAGNUM_TARGET_GLES2) || defined(MAGNUM_TARGET_WEBGL)
+    _framebuffer.attachRenderbuffer(Framebuffer::BufferAttachment::DepthStencil, _depthStencil);
+    #else
+    _framebuffer.attachRenderbuffer(Framebuffer::BufferAttachment::Depth, _depthStencil)
+        .attachRenderbuffer(Framebuffer::BufferAttachment::Stencil, _depthStencil);
+    #endif
+}
+
+DynamicResolution& DynamicResolution::setSize(const Vector2i& size) {
+    _size = size;
+    allocate();
+    return *this;
+}
+
+DynamicResolution& DynamicResolution::setTargetTime(const Float milliseconds) {
+    _targetTime = milliseconds;
+    return *this;
+}
+
+DynamicResolution& DynamicResolution::setScaleBounds(const Float min, const Float max) {
+    CORRADE_ASSERT(min > 0.0f && min <= max,
+        "DebugTools::DynamicResolution::setScaleBounds(): invalid bounds" << min << max, *this);
+
+    const bool reallocate = max != _maxScale;
+    _minScale = min;
+    _maxScale = max;
+    _scale = Math::clamp(_scale, _minScale, _maxScale);
+    if(reallocate) allocate();
+    return *this;
+}
+
+DynamicResolution& DynamicResolution::setHysteresis(const Float hysteresis) {
+    _hysteresis = hysteresis;
+    return *this;
+}
+
+DynamicResolution& DynamicResolution::setLatency(const UnsignedInt frames) {
+    CORRADE_ASSERT(!_running,
+        "DebugTools::DynamicResolution::setLatency(): can't be called during scene rendering", *this);
+
+    /* Queries are created lazily in begin() only if GPU timing is enabled */
+    _queries.clear();
+    _queryScales.assign(frames + 1, 0.0f);
+    _currentQuery = 0;
+    return *this;
+}
+
+DynamicResolution& DynamicResolution::setGpuTimingEnabled(const bool enabled) {
+    CORRADE_ASSERT(!_running,
+        "DebugTools::DynamicResolution::setGpuTimingEnabled(): can't be called during scene rendering", *this);
+
+    _gpuTimingEnabled = enabled;
+    std::fill(_queryScales.begin(), _queryScales.end(), 0.0f);
+    return *this;
+}
+
+DynamicResolution& DynamicResolution::setScale(const Float scale) {
+    _scale = Math::clamp(scale, _minScale, _maxScale);
+    return *this;
+}
+
+Vector2i DynamicResolution::scaledSize() const {
+    return Math::max(Vector2i{Vector2{_size}*_scale}, Vector2i{1});
+}
+
+Float DynamicResolution::predictedTime() const {
+    return _cost*_scale*_scale;
+}
+
+void DynamicResolution::addTimeSample(const Float time, const Float scale) {
+    /* GPU time of the scene is roughly proportional to the pixel count, so
+       normalize the sample to scale 1 */
+    const Float cost = time/(scale*scale);
+    _cost = _cost ? _cost + (cost - _cost)*CostSmoothing : cost;
+
+    /* Change the scale only if the prediction is far enough from the target,
+       to the scale at which the prediction matches it */
+    const Float predicted = predictedTime();
+    if(predicted > _targetTime*(1.0f + _hysteresis) || predicted < _targetTime*(1.0f - _hysteresis))
+        setScale(std::sqrt(_targetTime/_cost));
+}
+
+Framebuffer& DynamicResolution::begin() {
+    CORRADE_ASSERT(!_running,
+        "DebugTools::DynamicResolution::begin(): end() was not called", _framebuffer);
+
+    if(_gpuTimingEnabled) {
+        if(_queries.empty()) {
+            _queries.reserve(_queryScales.size());
+            for(std::size_t i = 0; i != _queryScales.size(); ++i)
+                _queries.emplace_back(TimeQuery::Target::TimeElapsed);
+        }
+
+        /* Read back the query issued latency() frames ago. If it's not
+           available yet, skip it instead of stalling. */
+        Float& queryScale = _queryScales[_currentQuery];
+        if(queryScale != 0.0f && _queries[_currentQuery].resultAvailable())
+            addTimeSample(_queries[_currentQuery].result<UnsignedLong>()/1.0e6f, queryScale);
+        queryScale = _scale;
+        _queries[_currentQuery].begin();
+    }
+
+    _running = true;
+    _framebuffer.setViewport({{}, scaledSize()})
+        .bind();
+    return _framebuffer;
+}
+
+void DynamicResolution::end(AbstractFramebuffer& destination) {
+    CORRADE_ASSERT(_running,
+        "DebugTools::DynamicResolution::end(): begin() was not called", );
+
+    if(_gpuTimingEnabled) {
+        _queries[_currentQuery].end();
+        _currentQuery = (_currentQuery + 1) % _queries.size();
+    }
+
+    _running = false;
+    AbstractFramebuffer::blit(_framebuffer, destination, _framebuffer.viewport(), destination.viewport(), FramebufferBlit::Color, FramebufferBlitFilter::Linear);
+    destination.bind();
+}
+
+}}
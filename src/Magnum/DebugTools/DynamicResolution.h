@@ -0,0 +1,303 @@
+#ifndef Magnum_DebugTools_DynamicResolution_h
+#define Magnum_DebugTools_DynamicResolution_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MAGNUM_TARGET_WEBGL
+/** @file
+ * @brief Class @ref Magnum::DebugTools::DynamicResolution
+ */
+#endif
+
+#include <vector>
+
+#include "Magnum/DefaultFramebuffer.h"
+#include "Magnum/Framebuffer.h"
+#include "Magnum/Renderbuffer.h"
+#include "Magnum/RenderbufferFormat.h"
+#include "Magnum/TimeQuery.h"
+#include "Magnum/DebugTools/DebugTools.h"
+#include "Magnum/DebugTools/visibility.h"
+#include "Magnum/Math/Vector2.h"
+
+#ifndef MAGNUM_TARGET_WEBGL
+namespace Magnum { namespace DebugTools {
+
+/**
+@brief Dynamic resolution scaling
+
+Renders the scene into an offscreen framebuffer. Its viewport scales with the
+GPU time spent rendering the scene, so the scene keeps within a frame time
+budget under heavy load. The result is upscaled into the default framebuffer
+with a filtered @ref AbstractFramebuffer::blit(), and anything drawn after
+that, such as the UI, renders at native resolution.
+@code
+DebugTools::DynamicResolution resolution{defaultFramebuffer.viewport().size(), 12.0f};
+resolution.setScaleBounds(0.5f, 1.0f);
+
+void MyApplication::drawEvent() {
+    resolution.begin().clear(FramebufferClear::Color|FramebufferClear::Depth);
+    camera.setViewport(resolution.scaledSize());
+    camera.draw(drawables);
+    resolution.end();
+
+    // The default framebuffer is bound again, draw the UI
+    ui.draw();
+
+    swapBuffers();
+    redraw();
+}
+
+void MyApplication::viewportEvent(const Vector2i& size) {
+    defaultFramebuffer.setViewport({{}, size});
+    resolution.setSize(size);
+}
+@endcode
+
+## Scale selection
+
+GPU time between @ref begin() and @ref end() is measured with a
+@ref TimeQuery. The results are read back with a latency of a few frames
+(see @ref setLatency()), which avoids stalling the pipeline. Each
+measurement is divided by the pixel count it was rendered with. An
+exponential moving average of that per-pixel cost predicts the time at the
+current scale. If the prediction is outside the target time by more than
+the relative @ref setHysteresis() "hysteresis", the scale is set to the one
+whose predicted time matches the target. It is clamped to the
+@ref setScaleBounds() "scale bounds". The hysteresis prevents the
+resolution from changing every frame when the load is close to the target.
+
+Only the scene rendering between @ref begin() and @ref end() is measured, so
+the target time should be the budget for the scene alone. If the time
+queries aren't available, disable them with @ref setGpuTimingEnabled() and
+feed the times measured some other way using @ref addTimeSample().
+
+The offscreen framebuffer has a color and a depth/stencil renderbuffer. Its
+size is the @ref size() multiplied by the maximal scale. The scale applies to
+both dimensions, so the pixel count changes with its square.
+@requires_gl33 Extension @extension{ARB,timer_query} for the GPU time
+    measurement
+@requires_es_extension Extension @extension{EXT,disjoint_timer_query} for the
+    GPU time measurement
+@requires_gles30 Extension @extension{ANGLE,framebuffer_blit} or
+    @extension{NV,framebuffer_blit} in OpenGL ES 2.0
+@requires_gles Time queries are not available in WebGL.
+*/
+class MAGNUM_DEBUGTOOLS_EXPORT DynamicResolution {
+    public:
+        /**
+         * @brief Constructor
+         * @param size                  Native size
+         * @param targetTime            Target GPU time in milliseconds
+         * @param colorFormat           Color renderbuffer format
+         * @param depthStencilFormat    Depth/stencil renderbuffer format
+         *
+         * The scale is initially `1.0f`, scale bounds are `0.5f` and
+         * `1.0f`, hysteresis is `0.1f` and latency is `3` frames.
+         */
+        explicit DynamicResolution(const Vector2i& size, Float targetTime, RenderbufferFormat colorFormat = RenderbufferFormat::RGBA8, RenderbufferFormat depthStencilFormat = RenderbufferFormat::Depth24Stencil8);
+
+        /** @brief Copying is not allowed */
+        DynamicResolution(const DynamicResolution&) = delete;
+
+        /** @brief Moving is not allowed */
+        DynamicResolution(DynamicResolution&&) = delete;
+
+        ~DynamicResolution();
+
+        /** @brief Copying is not allowed */
+        DynamicResolution& operator=(const DynamicResolution&) = delete;
+
+        /** @brief Moving is not allowed */
+        DynamicResolution& operator=(DynamicResolution&&) = delete;
+
+        /** @brief Offscreen framebuffer */
+        Framebuffer& framebuffer() { return _framebuffer; }
+
+        /** @brief Native size */
+        Vector2i size() const { return _size; }
+
+        /**
+         * @brief Set native size
+         * @return Reference to self (for method chaining)
+         *
+         * Call when the window is resized. Reallocates the renderbuffers.
+         */
+        DynamicResolution& setSize(const Vector2i& size);
+
+        /** @brief Target GPU time in milliseconds */
+        Float targetTime() const { return _targetTime; }
+
+        /**
+         * @brief Set target GPU time
+         * @return Reference to self (for method chaining)
+         */
+        DynamicResolution& setTargetTime(Float milliseconds);
+
+        /** @brief Minimal scale */
+        Float minScale() const { return _minScale; }
+
+        /** @brief Maximal scale */
+        Float maxScale() const { return _maxScale; }
+
+        /**
+         * @brief Set scale bounds
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p min is positive and not larger than @p max.
+         * Reallocates the renderbuffers if the maximal scale changed. The
+         * current scale is clamped to the new bounds.
+         */
+        DynamicResolution& setScaleBounds(Float min, Float max);
+
+        /** @brief Hysteresis */
+        Float hysteresis() const { return _hysteresis; }
+
+        /**
+         * @brief Set hysteresis
+         * @return Reference to self (for method chaining)
+         *
+         * The scale is changed only if the predicted GPU time differs from
+         * the target time by more than @p hysteresis times the target time.
+         * See @ref DebugTools-DynamicResolution-scale-selection for more
+         * information.
+         */
+        DynamicResolution& setHysteresis(Float hysteresis);
+
+        /** @brief Time query latency */
+        UnsignedInt latency() const { return _queryScales.size() - 1; }
+
+        /**
+         * @brief Set time query latency
+         * @return Reference to self (for method chaining)
+         *
+         * Count of frames after which the time query results are read back.
+         * Can't be called between @ref begin() and @ref end(). Discards any
+         * pending measurements.
+         */
+        DynamicResolution& setLatency(UnsignedInt frames);
+
+        /** @brief Whether GPU time is measured using time queries */
+        bool isGpuTimingEnabled() const { return _gpuTimingEnabled; }
+
+        /**
+         * @brief Enable or disable GPU time measurement
+         * @return Reference to self (for method chaining)
+         *
+         * Enabled by default. If disabled, the scale changes only with
+         * @ref addTimeSample() and @ref setScale(). Can't be called between
+         * @ref begin() and @ref end().
+         */
+        DynamicResolution& setGpuTimingEnabled(bool enabled);
+
+        /** @brief Current scale */
+        Float scale() const { return _scale; }
+
+        /**
+         * @brief Set scale
+         * @return Reference to self (for method chaining)
+         *
+         * The value is clamped to the scale bounds. Applied at the next
+         * @ref begin().
+         */
+        DynamicResolution& setScale(Float scale);
+
+        /**
+         * @brief Scaled size
+         *
+         * @ref size() multiplied by @ref scale(), at least one pixel in each
+         * dimension.
+         */
+        Vector2i scaledSize() const;
+
+        /**
+         * @brief Predicted GPU time at current scale in milliseconds
+         *
+         * Returns `0.0f` if no time was measured yet.
+         */
+        Float predictedTime() const;
+
+        /**
+         * @brief Add time sample
+         * @param time      Time in milliseconds
+         * @param scale     Scale at which the sample was rendered
+         *
+         * Updates the time prediction and the scale, if needed. Called
+         * internally with the time query results.
+         */
+        void addTimeSample(Float time, Float scale);
+
+        /** @overload
+         *
+         * Assumes the sample was rendered at current @ref scale().
+         */
+        void addTimeSample(Float time) { addTimeSample(time, _scale); }
+
+        /**
+         * @brief Begin rendering the scene
+         *
+         * Reads back the oldest time query if available, sets the offscreen
+         * framebuffer viewport to @ref scaledSize(), binds it, starts the
+         * time query and returns the framebuffer.
+         */
+        Framebuffer& begin();
+
+        /**
+         * @brief End rendering the scene
+         *
+         * Ends the time query, upscales the offscreen framebuffer color
+         * contents into whole viewport of @p destination using a linear
+         * filter and binds @p destination.
+         */
+        void end(AbstractFramebuffer& destination = defaultFramebuffer);
+
+    private:
+        void allocate();
+
+        Framebuffer _framebuffer;
+        Renderbuffer _color, _depthStencil;
+        RenderbufferFormat _colorFormat, _depthStencilFormat;
+
+        Vector2i _size;
+        Float _targetTime, _minScale{0.5f}, _maxScale{1.0f}, _hysteresis{0.1f}, _scale{1.0f};
+
+        /* Moving average of the time for one pixel at scale 1, zero if
+           nothing was measured yet */
+        Float _cost{};
+
+        /* Ring of time queries together with scale each of them was
+           rendered at, zero if the query wasn't used yet */
+        std::vector<TimeQuery> _queries;
+        std::vector<Float> _queryScales;
+        std::size_t _currentQuery{};
+        bool _gpuTimingEnabled{true}, _running{};
+};
+
+}}
+#else
+#error this header is not available in WebGL build
+#endif
+
+#endif
@@ -0,0 +1,983 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "GLTrace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <tuple>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/Context.h"
+#include "Magnum/OpenGL.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/PixelStorage.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/Math/BoolVector.h"
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace DebugTools {
+
+/* Trace layout. All integers except single bytes are variable-length encoded,
+   seven bits per byte, lowest first, highest bit set if more bytes follow.
+
+    magic         "MAGNUMGLTRACE\0"
+    version       byte
+    count         of functions, followed by for each function:
+      length      of the name followed by the name
+      arguments   byte, count of arguments
+      flags       byte, 1 if the function returns a value, the upper bits
+                  contain object namespace of the returned value
+    calls         until the end of the data, each call is:
+      function    one-based index into the function list, zero marks end of
+                  a frame, followed by for each argument:
+        tag       byte, lower two bits are argument kind, upper bits the
+                  object namespace
+        value     for Kind::Value, raw bits of the argument
+        data      for other kinds, size followed by the data
+      return      recorded return value, if the function returns any */
+
+namespace {
+
+constexpr const char Magic[] = "MAGNUMGLTRACE";
+enum: UnsignedByte { Version = 1 };
+
+enum: std::size_t {
+    MaxArgumentCount = 12,
+    ReturnValue = ~std::size_t{}
+};
+
+enum class Kind: UnsignedByte {
+    Value = 0,  /* Value or offset into a bound buffer */
+    Data = 1,   /* Client memory read by the call */
+    Output = 2, /* Client memory written by the call */
+    Strings = 3 /* Array of strings joined into one */
+};
+
+/* Object namespace of an argument. Must fit into six bits, values other than
+   None are indices into GLTraceReplay::_names offset by one. */
+enum class Name: UnsignedByte {
+    None, Buffer, VertexArray, Program, Texture, Framebuffer, Renderbuffer,
+    Sampler, Query
+};
+
+struct Payload {
+    Kind kind;
+    Name name;
+    std::size_t size;
+};
+
+/* Returns payload description of given argument or of the return value if
+   index is ReturnValue */
+typedef Payload(*Sizer)(const UnsignedLong*, std::size_t);
+
+struct Slot {
+    UnsignedLong value;
+    const char* data;
+    const char* string;
+};
+
+struct Entry {
+    const char* name;
+    void* variable;
+    void(*install)(UnsignedShort, void*);
+    void(*uninstall)(void*);
+    UnsignedLong(*replay)(void*, const Slot*);
+    Sizer sizer;
+    UnsignedByte argumentCount;
+    bool hasReturnValue;
+};
+
+GLTrace* currentTrace = nullptr;
+
+template<class T> inline typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value, UnsignedLong>::type toValue(const T value) {
+    return UnsignedLong(value);
+}
+inline UnsignedLong toValue(const Float value) {
+    UnsignedInt bits;
+    std::memcpy(&bits, &value, sizeof(Float));
+    return bits;
+}
+inline UnsignedLong toValue(const Double value) {
+    UnsignedLong bits;
+    std::memcpy(&bits, &value, sizeof(Double));
+    return bits;
+}
+template<class T> inline UnsignedLong toValue(T* const value) {
+    return reinterpret_cast<std::uintptr_t>(value);
+}
+
+template<class T> inline typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value, T>::type fromSlot(const Slot& slot) {
+    return T(slot.value);
+}
+template<class T> inline typename std::enable_if<std::is_same<T, Float>::value, T>::type fromSlot(const Slot& slot) {
+    const UnsignedInt bits = UnsignedInt(slot.value);
+    Float value;
+    std::memcpy(&value, &bits, sizeof(Float));
+    return value;
+}
+template<class T> inline typename std::enable_if<std::is_same<T, Double>::value, T>::type fromSlot(const Slot& slot) {
+    Double value;
+    std::memcpy(&value, &slot.value, sizeof(Double));
+    return value;
+}
+template<class T> inline typename std::enable_if<std::is_pointer<T>::value, T>::type fromSlot(const Slot& slot) {
+    return slot.data ? reinterpret_cast<T>(const_cast<char*>(slot.data)) :
+        reinterpret_cast<T>(std::uintptr_t(slot.value));
+}
+
+/* Calls the original function and records the call afterwards, so output
+   arguments are already filled */
+template<class R> struct Call {
+    template<class ...Args> static R record(R(APIENTRY* const function)(Args...), const UnsignedShort index, const Args... args) {
+        const R result = function(args...);
+        const UnsignedLong arguments[]{toValue(args)..., 0};
+        const UnsignedLong returnValue = toValue(result);
+        currentTrace->record(index, arguments, sizeof...(Args), &returnValue);
+        return result;
+    }
+
+    template<class ...Args> static UnsignedLong replay(R(APIENTRY* const function)(Args...), const Args... args) {
+        return toValue(function(args...));
+    }
+};
+
+template<> struct Call<void> {
+    template<class ...Args> static void record(void(APIENTRY* const function)(Args...), const UnsignedShort index, const Args... args) {
+        function(args...);
+        const UnsignedLong arguments[]{toValue(args)..., 0};
+        currentTrace->record(index, arguments, sizeof...(Args), nullptr);
+    }
+
+    template<class ...Args> static UnsignedLong replay(void(APIENTRY* const function)(Args...), const Args... args) {
+        function(args...);
+        return 0;
+    }
+};
+
+/* Each traced function gets its own instantiation, distinguished by the
+   line it's listed on */
+template<class, std::size_t> struct Traced;
+template<class R, class ...Args, std::size_t id> struct Traced<R(APIENTRY*)(Args...), id> {
+    typedef R(APIENTRY* Function)(Args...);
+
+    static Function& original() {
+        static Function function;
+        return function;
+    }
+
+    static UnsignedShort& index() {
+        static UnsignedShort index;
+        return index;
+    }
+
+    static R APIENTRY call(Args... args) {
+        return Call<R>::record(original(), index(), args...);
+    }
+
+    static void install(const UnsignedShort i, void* const variable) {
+        Function& function = *static_cast<Function*>(variable);
+        /* Leave functions not supported by the driver alone */
+        if(!function) return;
+        index() = i;
+        original() = function;
+        function = call;
+    }
+
+    static void uninstall(void* const variable) {
+        if(!original()) return;
+        *static_cast<Function*>(variable) = original();
+        original() = nullptr;
+    }
+
+    template<std::size_t ...sequence> static UnsignedLong invoke(const Function function, const Slot* const slots, Math::Implementation::Sequence<sequence...>) {
+        static_cast<void>(slots);
+        return Call<R>::replay(function, fromSlot<Args>(slots[sequence])...);
+    }
+
+    static UnsignedLong replay(void* const variable, const Slot* const slots) {
+        return invoke(*static_cast<Function*>(variable), slots, typename Math::Implementation::GenerateSequence<sizeof...(Args)>::Type{});
+    }
+
+    enum: UnsignedByte { ArgumentCount = sizeof...(Args) };
+    enum: bool { HasReturnValue = !std::is_void<R>::value };
+};
+
+template<class F, std::size_t id> Entry entry(F* const variable, const char* const name, const Sizer sizer) {
+    typedef Traced<F, id> T;
+    static_assert(std::size_t(T::ArgumentCount) <= MaxArgumentCount, "too many arguments");
+    return Entry{name, variable, T::install, T::uninstall, T::replay, sizer, T::ArgumentCount, T::HasReturnValue};
+}
+
+/* Entries used only during replay, for calls that have to be recorded
+   explicitly because they don't go through the function pointers */
+template<class F, std::size_t id> Entry replayOnlyEntry(F* const variable, const char* const name) {
+    typedef Traced<F, id> T;
+    return Entry{name, variable, nullptr, nullptr, T::replay, nullptr, T::ArgumentCount, T::HasReturnValue};
+}
+
+bool isUnpackBufferBound() {
+    GLint buffer;
+    glGetIntegerv(GL_PIXEL_UNPACK_BUFFER_BINDING, &buffer);
+    return buffer;
+}
+
+/* Payload sizers */
+
+template<Name ...names> Payload named(const UnsignedLong*, const std::size_t i) {
+    constexpr Name n[]{names...};
+    return {Kind::Value, i < sizeof...(names) ? n[i] : Name::None, 0};
+}
+
+template<Name name> Payload returned(const UnsignedLong*, const std::size_t i) {
+    return {Kind::Value, i == ReturnValue ? name : Name::None, 0};
+}
+
+template<Name name, std::size_t countIndex> Payload generated(const UnsignedLong* const a, const std::size_t i) {
+    if(i == countIndex + 1) return {Kind::Output, name, std::size_t(a[countIndex])*sizeof(GLuint)};
+    return {};
+}
+
+template<Name name, std::size_t countIndex, Name first = Name::None> Payload array(const UnsignedLong* const a, const std::size_t i) {
+    if(i == 0 && first != Name::None) return {Kind::Value, first, 0};
+    if(i == countIndex + 1) return {Kind::Data, name, std::size_t(a[countIndex])*sizeof(GLuint)};
+    return {};
+}
+
+template<std::size_t sizeIndex, std::size_t dataIndex, Name first = Name::None> Payload data(const UnsignedLong* const a, const std::size_t i) {
+    if(i == 0) return {Kind::Value, first, 0};
+    if(i == dataIndex) return {Kind::Data, Name::None, std::size_t(a[sizeIndex])};
+    return {};
+}
+
+template<std::size_t sizeIndex, std::size_t dataIndex, Name first = Name::None> Payload compressedPixels(const UnsignedLong* const a, const std::size_t i) {
+    if(i == 0) return {Kind::Value, first, 0};
+    if(i == dataIndex && !isUnpackBufferBound()) return {Kind::Data, Name::None, std::size_t(a[sizeIndex])};
+    return {};
+}
+
+template<std::size_t dataIndex, std::size_t widthIndex, UnsignedInt dimensions, Name first = Name::None> Payload pixels(const UnsignedLong* const a, const std::size_t i) {
+    if(i == 0) return {Kind::Value, first, 0};
+    if(i != dataIndex || !a[i] || isUnpackBufferBound()) return {};
+
+    /* Record the unpack state before the upload, as the calls setting it
+       don't go through the function pointers */
+    const Int* const s = currentTrace->recordPixelStorage();
+    const std::tuple<Math::Vector3<std::size_t>, Math::Vector3<std::size_t>, std::size_t> properties = PixelStorage{}
+        .setAlignment(s[0])
+        .setRowLength(s[1])
+        .setImageHeight(s[2])
+        .setSkip({s[3], s[4], s[5]})
+        .dataProperties(PixelFormat(a[dataIndex - 2]), PixelType(a[dataIndex - 1]),
+            {Int(a[widthIndex]), Int(a[widthIndex + 1]), dimensions == 3 ? Int(a[widthIndex + 2]) : 1});
+    return {Kind::Data, Name::None, std::get<0>(properties).sum() + std::get<1>(properties).product()};
+}
+
+template<std::size_t programIndex, std::size_t stringIndex> Payload string(const UnsignedLong* const a, const std::size_t i) {
+    if(i == programIndex) return {Kind::Value, Name::Program, 0};
+    if(i == stringIndex && a[i]) return {Kind::Data, Name::None, std::strlen(reinterpret_cast<const char*>(std::uintptr_t(a[i]))) + 1};
+    return {};
+}
+
+template<std::size_t countIndex, std::size_t componentCount, std::size_t dataIndex = countIndex + 1> Payload uniform(const UnsignedLong* const a, const std::size_t i) {
+    /* glProgramUniform*() has the program first */
+    if(i == 0 && countIndex == 2) return {Kind::Value, Name::Program, 0};
+    if(i == dataIndex) return {Kind::Data, Name::None, std::size_t(a[countIndex])*componentCount*4};
+    return {};
+}
+
+template<std::size_t bufferIndex, Name first = Name::None> Payload clearBuffer(const UnsignedLong* const a, const std::size_t i) {
+    if(i == 0) return {Kind::Value, first, 0};
+    if(i == bufferIndex + 2) return {Kind::Data, Name::None, std::size_t(a[bufferIndex] == GL_COLOR ? 4 : 1)*4};
+    return {};
+}
+
+Payload shaderSource(const UnsignedLong*, const std::size_t i) {
+    if(i == 0) return {Kind::Value, Name::Program, 0};
+    if(i == 2) return {Kind::Strings, Name::None, 0};
+    return {};
+}
+
+Payload multiDrawArrays(const UnsignedLong* const a, const std::size_t i) {
+    if(i == 1 || i == 2) return {Kind::Data, Name::None, std::size_t(a[3])*sizeof(GLint)};
+    return {};
+}
+
+Payload multiDrawElements(const UnsignedLong* const a, const std::size_t i) {
+    if(i == 1) return {Kind::Data, Name::None, std::size_t(a[4])*sizeof(GLsizei)};
+    /* The index offsets are recorded as raw pointer values */
+    if(i == 3) return {Kind::Data, Name::None, std::size_t(a[4])*sizeof(void*)};
+    return {};
+}
+
+void(APIENTRY* pixelStorei)(GLenum, GLint) = glPixelStorei;
+
+#define _c(function, sizer) entry<decltype(flextgl ## function), __LINE__>(&flextgl ## function, "gl" #function, sizer)
+
+const Entry Entries[]{
+    /* Has to be first, used by GLTrace::recordPixelStorage() */
+    replayOnlyEntry<decltype(pixelStorei), __LINE__>(&pixelStorei, "glPixelStorei"),
+
+    /* Buffers */
+    _c(GenBuffers, (generated<Name::Buffer, 0>)),
+    _c(CreateBuffers, (generated<Name::Buffer, 0>)),
+    _c(DeleteBuffers, (array<Name::Buffer, 0>)),
+    _c(BindBuffer, (named<Name::None, Name::Buffer>)),
+    _c(BindBufferBase, (named<Name::None, Name::None, Name::Buffer>)),
+    _c(BindBufferRange, (named<Name::None, Name::None, Name::Buffer>)),
+    _c(BufferData, (data<1, 2>)),
+    _c(BufferSubData, (data<2, 3>)),
+    _c(BufferStorage, (data<1, 2>)),
+    _c(NamedBufferData, (data<1, 2, Name::Buffer>)),
+    _c(NamedBufferSubData, (data<2, 3, Name::Buffer>)),
+    _c(NamedBufferStorage, (data<1, 2, Name::Buffer>)),
+    _c(CopyBufferSubData, nullptr),
+    _c(CopyNamedBufferSubData, (named<Name::Buffer, Name::Buffer>)),
+    _c(InvalidateBufferData, named<Name::Buffer>),
+    _c(InvalidateBufferSubData, named<Name::Buffer>),
+
+    /* Vertex arrays */
+    _c(GenVertexArrays, (generated<Name::VertexArray, 0>)),
+    _c(CreateVertexArrays, (generated<Name::VertexArray, 0>)),
+    _c(DeleteVertexArrays, (array<Name::VertexArray, 0>)),
+    _c(BindVertexArray, named<Name::VertexArray>),
+    _c(EnableVertexAttribArray, nullptr),
+    _c(DisableVertexAttribArray, nullptr),
+    _c(VertexAttribPointer, nullptr),
+    _c(VertexAttribIPointer, nullptr),
+    _c(VertexAttribLPointer, nullptr),
+    _c(VertexAttribDivisor, nullptr),
+    _c(EnableVertexArrayAttrib, named<Name::VertexArray>),
+    _c(VertexArrayVertexBuffer, (named<Name::VertexArray, Name::None, Name::Buffer>)),
+    _c(VertexArrayAttribFormat, named<Name::VertexArray>),
+    _c(VertexArrayAttribIFormat, named<Name::VertexArray>),
+    _c(VertexArrayAttribLFormat, named<Name::VertexArray>),
+    _c(VertexArrayAttribBinding, named<Name::VertexArray>),
+    _c(VertexArrayBindingDivisor, named<Name::VertexArray>),
+    _c(VertexArrayElementBuffer, (named<Name::VertexArray, Name::Buffer>)),
+
+    /* Shaders and programs, sharing one namespace */
+    _c(CreateShader, returned<Name::Program>),
+    _c(ShaderSource, shaderSource),
+    _c(CompileShader, named<Name::Program>),
+    _c(DeleteShader, named<Name::Program>),
+    _c(CreateProgram, returned<Name::Program>),
+    _c(AttachShader, (named<Name::Program, Name::Program>)),
+    _c(DetachShader, (named<Name::Program, Name::Program>)),
+    _c(LinkProgram, named<Name::Program>),
+    _c(UseProgram, named<Name::Program>),
+    _c(DeleteProgram, named<Name::Program>),
+    _c(ProgramParameteri, named<Name::Program>),
+    _c(BindAttribLocation, (string<0, 2>)),
+    _c(BindFragDataLocation, (string<0, 2>)),
+    _c(BindFragDataLocationIndexed, (string<0, 3>)),
+    _c(GetUniformLocation, (string<0, 1>)),
+    _c(GetUniformBlockIndex, (string<0, 1>)),
+    _c(UniformBlockBinding, named<Name::Program>),
+    _c(ShaderStorageBlockBinding, named<Name::Program>),
+
+    /* Uniforms */
+    _c(Uniform1i, nullptr),
+    _c(Uniform1f, nullptr),
+    _c(Uniform1fv, (uniform<1, 1>)),
+    _c(Uniform2fv, (uniform<1, 2>)),
+    _c(Uniform3fv, (uniform<1, 3>)),
+    _c(Uniform4fv, (uniform<1, 4>)),
+    _c(Uniform1iv, (uniform<1, 1>)),
+    _c(Uniform2iv, (uniform<1, 2>)),
+    _c(Uniform3iv, (uniform<1, 3>)),
+    _c(Uniform4iv, (uniform<1, 4>)),
+    _c(Uniform1uiv, (uniform<1, 1>)),
+    _c(Uniform2uiv, (uniform<1, 2>)),
+    _c(Uniform3uiv, (uniform<1, 3>)),
+    _c(Uniform4uiv, (uniform<1, 4>)),
+    _c(UniformMatrix2fv, (uniform<1, 4, 3>)),
+    _c(UniformMatrix3fv, (uniform<1, 9, 3>)),
+    _c(UniformMatrix4fv, (uniform<1, 16, 3>)),
+    _c(ProgramUniform1i, named<Name::Program>),
+    _c(ProgramUniform1f, named<Name::Program>),
+    _c(ProgramUniform1fv, (uniform<2, 1>)),
+    _c(ProgramUniform2fv, (uniform<2, 2>)),
+    _c(ProgramUniform3fv, (uniform<2, 3>)),
+    _c(ProgramUniform4fv, (uniform<2, 4>)),
+    _c(ProgramUniform1iv, (uniform<2, 1>)),
+    _c(ProgramUniform2iv, (uniform<2, 2>)),
+    _c(ProgramUniform3iv, (uniform<2, 3>)),
+    _c(ProgramUniform4iv, (uniform<2, 4>)),
+    _c(ProgramUniform1uiv, (uniform<2, 1>)),
+    _c(ProgramUniform2uiv, (uniform<2, 2>)),
+    _c(ProgramUniform3uiv, (uniform<2, 3>)),
+    _c(ProgramUniform4uiv, (uniform<2, 4>)),
+    _c(ProgramUniformMatrix2fv, (uniform<2, 4, 4>)),
+    _c(ProgramUniformMatrix3fv, (uniform<2, 9, 4>)),
+    _c(ProgramUniformMatrix4fv, (uniform<2, 16, 4>)),
+
+    /* Textures and samplers */
+    _c(CreateTextures, (generated<Name::Texture, 1>)),
+    _c(ActiveTexture, nullptr),
+    _c(BindTextures, (array<Name::Texture, 1>)),
+    _c(BindTextureUnit, (named<Name::None, Name::Texture>)),
+    _c(BindImageTexture, (named<Name::None, Name::Texture>)),
+    _c(GenerateMipmap, nullptr),
+    _c(GenerateTextureMipmap, named<Name::Texture>),
+    _c(TexStorage2D, nullptr),
+    _c(TexStorage3D, nullptr),
+    _c(TextureStorage2D, named<Name::Texture>),
+    _c(TextureStorage3D, named<Name::Texture>),
+    _c(TexImage3D, (pixels<9, 3, 3>)),
+    _c(TexSubImage3D, (pixels<10, 5, 3>)),
+    _c(TextureSubImage2D, (pixels<8, 4, 2, Name::Texture>)),
+    _c(TextureSubImage3D, (pixels<10, 5, 3, Name::Texture>)),
+    _c(CompressedTexImage2D, (compressedPixels<6, 7>)),
+    _c(CompressedTexSubImage2D, (compressedPixels<7, 8>)),
+    _c(CompressedTextureSubImage2D, (compressedPixels<7, 8, Name::Texture>)),
+    _c(TextureParameteri, named<Name::Texture>),
+    _c(TextureParameterf, named<Name::Texture>),
+    _c(TexBuffer, (named<Name::None, Name::None, Name::Buffer>)),
+    _c(TextureBuffer, (named<Name::Texture, Name::None, Name::Buffer>)),
+    _c(GenSamplers, (generated<Name::Sampler, 0>)),
+    _c(CreateSamplers, (generated<Name::Sampler, 0>)),
+    _c(DeleteSamplers, (array<Name::Sampler, 0>)),
+    _c(BindSampler, (named<Name::None, Name::Sampler>)),
+    _c(SamplerParameteri, named<Name::Sampler>),
+
+    /* Draws and compute */
+    _c(DrawArraysInstanced, nullptr),
+    _c(DrawElementsInstanced, nullptr),
+    _c(DrawRangeElements, nullptr),
+    _c(DrawElementsBaseVertex, nullptr),
+    _c(DrawRangeElementsBaseVertex, nullptr),
+    _c(DrawElementsInstancedBaseVertex, nullptr),
+    _c(DrawArraysInstancedBaseInstance, nullptr),
+    _c(DrawElementsInstancedBaseInstance, nullptr),
+    _c(DrawElementsInstancedBaseVertexBaseInstance, nullptr),
+    _c(MultiDrawArrays, multiDrawArrays),
+    _c(MultiDrawElements, multiDrawElements),
+    _c(DrawArraysIndirect, nullptr),
+    _c(DrawElementsIndirect, nullptr),
+    _c(DispatchCompute, nullptr),
+    _c(DispatchComputeIndirect, nullptr),
+    _c(MemoryBarrier, nullptr),
+
+    /* Framebuffers and renderbuffers */
+    _c(GenFramebuffers, (generated<Name::Framebuffer, 0>)),
+    _c(CreateFramebuffers, (generated<Name::Framebuffer, 0>)),
+    _c(DeleteFramebuffers, (array<Name::Framebuffer, 0>)),
+    _c(BindFramebuffer, (named<Name::None, Name::Framebuffer>)),
+    _c(FramebufferTexture, (named<Name::None, Name::None, Name::Texture>)),
+    _c(FramebufferTexture2D, (named<Name::None, Name::None, Name::None, Name::Texture>)),
+    _c(FramebufferTextureLayer, (named<Name::None, Name::None, Name::Texture>)),
+    _c(FramebufferRenderbuffer, (named<Name::None, Name::None, Name::None, Name::Renderbuffer>)),
+    _c(NamedFramebufferTexture, (named<Name::Framebuffer, Name::None, Name::Texture>)),
+    _c(NamedFramebufferTextureLayer, (named<Name::Framebuffer, Name::None, Name::Texture>)),
+    _c(NamedFramebufferRenderbuffer, (named<Name::Framebuffer, Name::None, Name::None, Name::Renderbuffer>)),
+    _c(DrawBuffers, (array<Name::None, 0>)),
+    _c(NamedFramebufferDrawBuffers, (array<Name::None, 1, Name::Framebuffer>)),
+    _c(NamedFramebufferDrawBuffer, named<Name::Framebuffer>),
+    _c(NamedFramebufferReadBuffer, named<Name::Framebuffer>),
+    _c(BlitFramebuffer, nullptr),
+    _c(BlitNamedFramebuffer, (named<Name::Framebuffer, Name::Framebuffer>)),
+    _c(ClearBufferfv, clearBuffer<0>),
+    _c(ClearBufferiv, clearBuffer<0>),
+    _c(ClearBufferuiv, clearBuffer<0>),
+    _c(ClearBufferfi, nullptr),
+    _c(ClearNamedFramebufferfv, (clearBuffer<1, Name::Framebuffer>)),
+    _c(ClearNamedFramebufferfi, named<Name::Framebuffer>),
+    _c(InvalidateFramebuffer, (array<Name::None, 1>)),
+    _c(InvalidateNamedFramebufferData, (array<Name::None, 1, Name::Framebuffer>)),
+    _c(GenRenderbuffers, (generated<Name::Renderbuffer, 0>)),
+    _c(CreateRenderbuffers, (generated<Name::Renderbuffer, 0>)),
+    _c(DeleteRenderbuffers, (array<Name::Renderbuffer, 0>)),
+    _c(BindRenderbuffer, (named<Name::None, Name::Renderbuffer>)),
+    _c(RenderbufferStorage, nullptr),
+    _c(RenderbufferStorageMultisample, nullptr),
+    _c(NamedRenderbufferStorage, named<Name::Renderbuffer>),
+    _c(NamedRenderbufferStorageMultisample, named<Name::Renderbuffer>),
+
+    /* Pipeline state */
+    _c(BlendEquation, nullptr),
+    _c(BlendEquationSeparate, nullptr),
+    _c(BlendFuncSeparate, nullptr),
+    _c(BlendColor, nullptr),
+    _c(StencilFuncSeparate, nullptr),
+    _c(StencilOpSeparate, nullptr),
+    _c(StencilMaskSeparate, nullptr),
+    _c(PatchParameteri, nullptr),
+    _c(PrimitiveRestartIndex, nullptr),
+    _c(ViewportIndexedf, nullptr),
+    _c(ScissorIndexed, nullptr),
+    _c(ColorMaski, nullptr),
+    _c(Enablei, nullptr),
+    _c(Disablei, nullptr),
+
+    /* Queries */
+    _c(GenQueries, (generated<Name::Query, 0>)),
+    _c(CreateQueries, (generated<Name::Query, 1>)),
+    _c(DeleteQueries, (array<Name::Query, 0>)),
+    _c(BeginQuery, (named<Name::None, Name::Query>)),
+    _c(EndQuery, nullptr),
+    _c(QueryCounter, named<Name::Query>)
+};
+
+#undef _c
+
+constexpr std::size_t EntryCount = sizeof(Entries)/sizeof(Entry);
+
+bool readValue(const char*& it, const char* const end, UnsignedLong& value) {
+    value = 0;
+    for(UnsignedInt shift = 0; it != end && shift < 64; shift += 7) {
+        const UnsignedByte byte = *it++;
+        value |= UnsignedLong(byte & 0x7f) << shift;
+        if(!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+}
+
+GLTrace::GLTrace() = default;
+
+GLTrace::~GLTrace() { stop(); }
+
+bool GLTrace::isCapturing() const { return _capturing; }
+
+void GLTrace::write(UnsignedLong value) {
+    while(value >= 0x80) {
+        _data.push_back(char((value & 0x7f)|0x80));
+        value >>= 7;
+    }
+    _data.push_back(char(value));
+}
+
+void GLTrace::start(const UnsignedInt frameCount) {
+    CORRADE_ASSERT(!currentTrace,
+        "DebugTools::GLTrace::start(): another trace is already capturing", );
+    CORRADE_ASSERT(Context::hasCurrent(),
+        "DebugTools::GLTrace::start(): no current context", );
+
+    _data.clear();
+    _frameCount = 0;
+    _frameLimit = frameCount;
+    _callCount = _frameCallCount = 0;
+    std::fill_n(_pixelStorage, 6, -1);
+
+    /* Header with the function list, so the trace can be replayed by a
+       different build */
+    _data.insert(_data.end(), Magic, Magic + sizeof(Magic));
+    _data.push_back(char(Version));
+    write(EntryCount);
+    for(const Entry& entry: Entries) {
+        const std::size_t length = std::strlen(entry.name);
+        write(length);
+        _data.insert(_data.end(), entry.name, entry.name + length);
+        _data.push_back(char(entry.argumentCount));
+        _data.push_back(char(UnsignedByte(entry.hasReturnValue)|(entry.sizer ? UnsignedByte(entry.sizer(nullptr, ReturnValue).name) << 1 : 0)));
+    }
+
+    currentTrace = this;
+    _capturing = true;
+    for(std::size_t i = 0; i != EntryCount; ++i)
+        if(Entries[i].install) Entries[i].install(i, Entries[i].variable);
+}
+
+void GLTrace::stop() {
+    if(!_capturing) return;
+
+    if(_frameCallCount) {
+        write(0);
+        ++_frameCount;
+        _frameCallCount = 0;
+    }
+
+    for(const Entry& entry: Entries)
+        if(entry.uninstall) entry.uninstall(entry.variable);
+    currentTrace = nullptr;
+    _capturing = false;
+}
+
+void GLTrace::nextFrame() {
+    if(!_capturing) return;
+
+    write(0);
+    ++_frameCount;
+    _frameCallCount = 0;
+    if(_frameLimit && _frameCount == _frameLimit) stop();
+}
+
+bool GLTrace::save(const std::string& filename) const {
+    if(!Utility::Directory::write(filename, data())) {
+        Error() << "DebugTools::GLTrace::save(): cannot write to" << filename;
+        return false;
+    }
+
+    return true;
+}
+
+void GLTrace::record(const UnsignedShort function, const UnsignedLong* const arguments, const std::size_t argumentCount, const UnsignedLong* const returnValue) {
+    const Entry& entry = Entries[function];
+    CORRADE_INTERNAL_ASSERT(argumentCount <= MaxArgumentCount);
+
+    /* Describe all arguments first, as describing texture uploads may record
+       additional calls */
+    Payload payloads[MaxArgumentCount]{};
+    for(std::size_t i = 0; i != argumentCount; ++i) {
+        if(entry.sizer) payloads[i] = entry.sizer(arguments, i);
+        if(payloads[i].kind != Kind::Value && !arguments[i])
+            payloads[i].kind = Kind::Value;
+    }
+
+    write(function + 1);
+    for(std::size_t i = 0; i != argumentCount; ++i) {
+        const Payload& payload = payloads[i];
+        _data.push_back(char(UnsignedByte(payload.kind)|(UnsignedByte(payload.name) << 2)));
+
+        if(payload.kind == Kind::Value) {
+            write(arguments[i]);
+            continue;
+        }
+
+        const char* const data = reinterpret_cast<const char*>(std::uintptr_t(arguments[i]));
+
+        /* glShaderSource() is the only function taking an array of strings,
+           the count and lengths are the surrounding arguments */
+        if(payload.kind == Kind::Strings) {
+            const auto strings = reinterpret_cast<const GLchar* const*>(data);
+            const auto lengths = reinterpret_cast<const GLint*>(std::uintptr_t(arguments[i + 1]));
+            std::string joined;
+            for(GLsizei j = 0, count = GLsizei(arguments[i - 1]); j != count; ++j)
+                joined.append(strings[j], lengths && lengths[j] >= 0 ? std::size_t(lengths[j]) : std::strlen(strings[j]));
+            write(joined.size() + 1);
+            _data.insert(_data.end(), joined.c_str(), joined.c_str() + joined.size() + 1);
+            continue;
+        }
+
+        write(payload.size);
+        _data.insert(_data.end(), data, data + payload.size);
+    }
+
+    if(returnValue) write(*returnValue);
+
+    ++_callCount;
+    ++_frameCallCount;
+}
+
+const Int* GLTrace::recordPixelStorage() {
+    constexpr GLenum Parameters[]{
+        GL_UNPACK_ALIGNMENT,
+        GL_UNPACK_ROW_LENGTH,
+        GL_UNPACK_IMAGE_HEIGHT,
+        GL_UNPACK_SKIP_PIXELS,
+        GL_UNPACK_SKIP_ROWS,
+        GL_UNPACK_SKIP_IMAGES
+    };
+
+    /* Record only parameters that changed since last upload */
+    for(std::size_t i = 0; i != 6; ++i) {
+        GLint value;
+        glGetIntegerv(Parameters[i], &value);
+        if(value == _pixelStorage[i]) continue;
+
+        _pixelStorage[i] = value;
+        const UnsignedLong arguments[]{Parameters[i], toValue(value)};
+        record(0, arguments, 2, nullptr);
+    }
+
+    return _pixelStorage;
+}
+
+GLTraceReplay::GLTraceReplay() = default;
+
+GLTraceReplay::GLTraceReplay(GLTraceReplay&&) noexcept = default;
+
+GLTraceReplay::~GLTraceReplay() = default;
+
+GLTraceReplay& GLTraceReplay::operator=(GLTraceReplay&&) noexcept = default;
+
+bool GLTraceReplay::openFile(const std::string& filename) {
+    if(!Utility::Directory::fileExists(filename)) {
+        Error() << "DebugTools::GLTraceReplay::openFile(): cannot open file" << filename;
+        return false;
+    }
+
+    const Containers::Array<char> data = Utility::Directory::read(filename);
+    return openData(data);
+}
+
+bool GLTraceReplay::openData(const Containers::ArrayView<const char> data) {
+    _data.assign(data.begin(), data.end());
+    _functions.clear();
+    _frames.clear();
+    for(auto& names: _names) names.clear();
+    _skippedCount = 0;
+
+    const char* it = _data.data();
+    const char* const end = _data.data() + _data.size();
+
+    if(_data.size() < sizeof(Magic) + 1 || std::memcmp(it, Magic, sizeof(Magic)) != 0) {
+        Error() << "DebugTools::GLTraceReplay::openData(): invalid signature";
+        return false;
+    }
+    it += sizeof(Magic);
+    if(UnsignedByte(*it) != Version) {
+        Error() << "DebugTools::GLTraceReplay::openData(): unsupported version" << UnsignedInt(UnsignedByte(*it));
+        return false;
+    }
+    ++it;
+
+    /* Function list, matched against functions known to this build */
+    UnsignedLong functionCount;
+    if(!readValue(it, end, functionCount) || functionCount > std::size_t(end - it)) {
+        Error() << "DebugTools::GLTraceReplay::openData(): invalid function list";
+        return false;
+    }
+    for(UnsignedLong i = 0; i != functionCount; ++i) {
+        UnsignedLong length;
+        if(!readValue(it, end, length) || length + 2 > std::size_t(end - it)) {
+            Error() << "DebugTools::GLTraceReplay::openData(): invalid function list";
+            return false;
+        }
+
+        Function function{{it, std::size_t(length)}, -1, UnsignedByte(it[length]), UnsignedByte(it[length + 1]), 0, 0.0};
+        it += length + 2;
+        if(function.argumentCount > MaxArgumentCount) {
+            Error() << "DebugTools::GLTraceReplay::openData(): too many arguments of" << function.name;
+            return false;
+        }
+
+        for(std::size_t j = 0; j != EntryCount; ++j) {
+            if(Entries[j].name != function.name) continue;
+            if(Entries[j].argumentCount == function.argumentCount && Entries[j].hasReturnValue == bool(function.flags & 1))
+                function.entry = j;
+            break;
+        }
+
+        _functions.push_back(std::move(function));
+    }
+
+    /* Validate all calls and find frame boundaries */
+    std::size_t frameBegin = it - _data.data(), frameCallCount = 0;
+    while(it != end) {
+        UnsignedLong index;
+        if(!readValue(it, end, index) || index > _functions.size()) {
+            Error() << "DebugTools::GLTraceReplay::openData(): invalid call at offset" << (it - _data.data());
+            return false;
+        }
+
+        if(!index) {
+            _frames.emplace_back(frameBegin, frameCallCount);
+            frameBegin = it - _data.data();
+            frameCallCount = 0;
+            continue;
+        }
+
+        const Function& function = _functions[index - 1];
+        for(std::size_t i = 0; i != function.argumentCount; ++i) {
+            if(it == end) {
+                Error() << "DebugTools::GLTraceReplay::openData(): arguments of" << function.name << "are truncated";
+                return false;
+            }
+
+            const Kind kind = Kind(*it++ & 0x03);
+            UnsignedLong value;
+            if(!readValue(it, end, value) || (kind != Kind::Value && value > std::size_t(end - it))) {
+                Error() << "DebugTools::GLTraceReplay::openData(): arguments of" << function.name << "are truncated";
+                return false;
+            }
+            if(kind != Kind::Value) it += value;
+        }
+
+        UnsignedLong returnValue;
+        if((function.flags & 1) && !readValue(it, end, returnValue)) {
+            Error() << "DebugTools::GLTraceReplay::openData(): return value of" << function.name << "is truncated";
+            return false;
+        }
+
+        ++frameCallCount;
+    }
+
+    /* Calls after the last frame end are not part of any frame, GLTrace
+       always finishes the frame, so this is a truncated file */
+    if(frameCallCount)
+        Warning() << "DebugTools::GLTraceReplay::openData(): ignoring" << frameCallCount << "calls after the last frame";
+
+    return true;
+}
+
+std::size_t GLTraceReplay::callCount(const UnsignedInt frame) const {
+    CORRADE_ASSERT(frame < _frames.size(),
+        "DebugTools::GLTraceReplay::callCount(): frame" << frame << "out of range for" << _frames.size() << "frames", {});
+    return _frames[frame].second;
+}
+
+GLTraceReplay& GLTraceReplay::setDefaultFramebuffer(const UnsignedInt id) {
+    _defaultFramebuffer = id;
+    return *this;
+}
+
+Double GLTraceReplay::playFrame(const UnsignedInt frame) {
+    CORRADE_ASSERT(frame < _frames.size(),
+        "DebugTools::GLTraceReplay::playFrame(): frame" << frame << "out of range for" << _frames.size() << "frames", {});
+    CORRADE_ASSERT(!currentTrace,
+        "DebugTools::GLTraceReplay::playFrame(): can't replay while a trace is capturing", {});
+
+    const auto map = [this](const Name name, const UnsignedLong value) -> UnsignedLong {
+        if(name == Name::None) return value;
+        if(name == Name::Framebuffer && value == 0) return _defaultFramebuffer;
+        const auto& names = _names[UnsignedByte(name) - 1];
+        const auto found = names.find(value);
+        return found == names.end() ? value : found->second;
+    };
+
+    /* Scratch memory for arguments that need to be modified before the
+       call */
+    std::vector<char> scratch[MaxArgumentCount];
+
+    const auto frameBegin = std::chrono::high_resolution_clock::now();
+
+    const char* it = _data.data() + _frames[frame].first;
+    const char* const end = _data.data() + _data.size();
+    /* The data were validated in openData(), so no bounds checks here */
+    for(;;) {
+        UnsignedLong index;
+        readValue(it, end, index);
+        if(!index) break;
+
+        Function& function = _functions[index - 1];
+        Slot slots[MaxArgumentCount];
+        Name names[MaxArgumentCount];
+        const char* recorded[MaxArgumentCount];
+        for(std::size_t i = 0; i != function.argumentCount; ++i) {
+            const UnsignedByte tag = *it++;
+            const Kind kind = Kind(tag & 0x03);
+            names[i] = Name(tag >> 2);
+            slots[i] = Slot{0, nullptr, nullptr};
+            recorded[i] = nullptr;
+
+            UnsignedLong value;
+            readValue(it, end, value);
+            if(kind == Kind::Value) {
+                slots[i].value = map(names[i], value);
+                continue;
+            }
+
+            const char* const data = it;
+            it += value;
+
+            /* Single joined string, the count and lengths are fixed up
+               below */
+            if(kind == Kind::Strings) {
+                slots[i].string = data;
+                slots[i].data = reinterpret_cast<const char*>(&slots[i].string);
+                continue;
+            }
+
+            /* Name arrays are remapped, output names are filled by the
+               call and remembered afterwards */
+            if(names[i] != Name::None) {
+                scratch[i].assign(data, data + value);
+                if(kind == Kind::Output) recorded[i] = data;
+                else for(std::size_t j = 0; j + sizeof(GLuint) <= value; j += sizeof(GLuint)) {
+                    GLuint name;
+                    std::memcpy(&name, scratch[i].data() + j, sizeof(GLuint));
+                    name = GLuint(map(names[i], name));
+                    std::memcpy(scratch[i].data() + j, &name, sizeof(GLuint));
+                }
+                slots[i].value = value;
+                slots[i].data = scratch[i].data();
+                continue;
+            }
+
+            /* Plain data are passed directly, output buffers get a copy to
+               not overwrite the trace */
+            if(kind == Kind::Output) {
+                scratch[i].assign(data, data + value);
+                slots[i].data = scratch[i].data();
+            } else slots[i].data = data;
+        }
+
+        UnsignedLong recordedReturnValue = 0;
+        if(function.flags & 1) readValue(it, end, recordedReturnValue);
+
+        if(function.entry < 0) {
+            ++_skippedCount;
+            continue;
+        }
+
+        /* glShaderSource() gets count of one and no lengths */
+        for(std::size_t i = 0; i != function.argumentCount; ++i) {
+            if(!slots[i].string) continue;
+            slots[i - 1].value = 1;
+            slots[i + 1] = Slot{0, nullptr, nullptr};
+        }
+
+        const Entry& entry = Entries[function.entry];
+        const auto callBegin = std::chrono::high_resolution_clock::now();
+        const UnsignedLong returnValue = entry.replay(entry.variable, slots);
+        function.time += std::chrono::duration<Double, std::milli>(std::chrono::high_resolution_clock::now() - callBegin).count();
+        ++function.count;
+
+        /* Remember names of created objects */
+        for(std::size_t i = 0; i != function.argumentCount; ++i) {
+            if(!recorded[i]) continue;
+            auto& table = _names[UnsignedByte(names[i]) - 1];
+            for(std::size_t j = 0; j + sizeof(GLuint) <= std::size_t(slots[i].value); j += sizeof(GLuint)) {
+                GLuint recordedName, actualName;
+                std::memcpy(&recordedName, recorded[i] + j, sizeof(GLuint));
+                std::memcpy(&actualName, slots[i].data + j, sizeof(GLuint));
+                table[recordedName] = actualName;
+            }
+        }
+        if(function.flags >> 1)
+            _names[(function.flags >> 1) - 1][recordedReturnValue] = returnValue;
+    }
+
+    Renderer::finish();
+
+    return std::chrono::duration<Double, std::milli>(std::chrono::high_resolution_clock::now() - frameBegin).count();
+}
+
+std::vector<GLTraceReplay::FunctionStatistics> GLTraceReplay::statistics() const {
+    std::vector<FunctionStatistics> out;
+    for(const Function& function: _functions)
+        if(function.count) out.push_back({function.name, function.count, function.time});
+
+    std::sort(out.begin(), out.end(), [](const FunctionStatistics& a, const FunctionStatistics& b) {
+        return a.time > b.time;
+    });
+    return out;
+}
+
+void GLTraceReplay::resetStatistics() {
+    for(Function& function: _functions) {
+        function.count = 0;
+        function.time = 0.0;
+    }
+}
+
+}}
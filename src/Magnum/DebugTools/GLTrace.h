@@ -0,0 +1,328 @@
+#ifndef Magnum_DebugTools_GLTrace_h
+#define Magnum_DebugTools_GLTrace_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MAGNUM_TARGET_GLES
+/** @file
+ * @brief Class @ref Magnum::DebugTools::GLTrace, @ref Magnum::DebugTools::GLTraceReplay
+ */
+#endif
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/DebugTools/DebugTools.h"
+#include "Magnum/DebugTools/visibility.h"
+
+#ifndef MAGNUM_TARGET_GLES
+namespace Magnum { namespace DebugTools {
+
+/**
+@brief OpenGL call trace capture
+
+Records OpenGL calls issued through the function pointers loaded by the
+engine into a compact binary trace, together with buffer, uniform, shader
+source and texture payloads, so the exact workload of a few frames can be
+reproduced elsewhere using @ref GLTraceReplay or the
+@ref magnum-replay "magnum-replay" utility.
+@code
+DebugTools::GLTrace trace;
+
+MyApplication::MyApplication(const Arguments& arguments): Platform::Application{arguments} {
+    // Start right after the context is created so all GL objects are captured
+    trace.start(10);
+
+    // ...
+}
+
+void MyApplication::drawEvent() {
+    // ...
+
+    swapBuffers();
+    trace.nextFrame();
+
+    if(!trace.isCapturing() && trace.frameCount())
+        trace.save("frames.trace");
+}
+@endcode
+
+Calls issued before @ref start() are not part of the trace, so objects
+created before are unknown to the replay. Ideally, start the capture right
+after the context is created and let it run for a few frames after the scene
+is set up. Names of objects created by the traced calls are remapped during
+replay, uniform locations are expected to be the same as during the capture.
+
+Only calls going through the function pointers can be recorded. Entry points
+exported directly from the GL library (the OpenGL 1.1 subset, e.g.
+@fn_gl{DrawArrays}, @fn_gl{DrawElements}, @fn_gl{Clear}, @fn_gl{Viewport},
+@fn_gl{BindTexture} or @fn_gl{GenTextures}) bypass the capture. As the
+engine prefers @extension{ARB,direct_state_access} and instanced, ranged or
+base-vertex draw entry points where available, the trace is most complete on
+drivers supporting OpenGL 4.5. Pixel unpack state needed for texture uploads
+is queried and recorded together with the upload. Mapped buffer writes
+and sync objects are not recorded.
+
+The capture replaces global function pointers, so only one trace can be
+capturing at a time and all traced calls have to come from the thread owning
+the context.
+@requires_gl OpenGL call tracing is available only on desktop OpenGL.
+*/
+class MAGNUM_DEBUGTOOLS_EXPORT GLTrace {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * The capture is not started. Use @ref start() to start it.
+         */
+        explicit GLTrace();
+
+        /** @brief Copying is not allowed */
+        GLTrace(const GLTrace&) = delete;
+
+        /** @brief Moving is not allowed */
+        GLTrace(GLTrace&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Calls @ref stop() if the capture is running.
+         */
+        ~GLTrace();
+
+        /** @brief Copying is not allowed */
+        GLTrace& operator=(const GLTrace&) = delete;
+
+        /** @brief Moving is not allowed */
+        GLTrace& operator=(GLTrace&&) = delete;
+
+        /** @brief Whether the capture is running */
+        bool isCapturing() const;
+
+        /**
+         * @brief Start the capture
+         *
+         * Discards any previously captured data and starts recording. The
+         * capture stops automatically after @p frameCount calls to
+         * @ref nextFrame(), zero means it runs until @ref stop() is called.
+         * Expects that there's a current context and no other trace is
+         * capturing.
+         */
+        void start(UnsignedInt frameCount = 1);
+
+        /**
+         * @brief Stop the capture
+         *
+         * Restores the original function pointers. If the current frame is
+         * not empty, it's finished as if @ref nextFrame() was called. Does
+         * nothing if the capture is not running.
+         */
+        void stop();
+
+        /**
+         * @brief Mark end of a frame
+         *
+         * Call after each buffer swap. Does nothing if the capture is not
+         * running.
+         */
+        void nextFrame();
+
+        /** @brief Count of captured frames */
+        UnsignedInt frameCount() const { return _frameCount; }
+
+        /** @brief Count of captured calls */
+        std::size_t callCount() const { return _callCount; }
+
+        /**
+         * @brief Captured trace data
+         *
+         * The data are complete only if the capture is not running.
+         */
+        Containers::ArrayView<const char> data() const {
+            return {_data.data(), _data.size()};
+        }
+
+        /**
+         * @brief Save captured trace to a file
+         *
+         * Returns `false` if the file can't be written.
+         */
+        bool save(const std::string& filename) const;
+
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        /* Used by the recording wrappers */
+        void record(UnsignedShort function, const UnsignedLong* arguments, std::size_t argumentCount, const UnsignedLong* returnValue);
+        const Int* recordPixelStorage();
+        #endif
+
+    private:
+        void write(UnsignedLong value);
+
+        std::vector<char> _data;
+        UnsignedInt _frameCount{}, _frameLimit{};
+        std::size_t _callCount{}, _frameCallCount{};
+        bool _capturing{};
+        Int _pixelStorage[6];
+};
+
+/**
+@brief OpenGL call trace replay
+
+Plays back traces captured with @ref GLTrace on the current context, measuring
+time spent in each call and in each frame.
+@code
+DebugTools::GLTraceReplay replay;
+if(!replay.openFile("frames.trace")) return;
+
+replay.setDefaultFramebuffer(framebuffer.id());
+for(UnsignedInt i = 0; i != replay.frameCount(); ++i)
+    Debug() << "Frame" << i << "took" << replay.playFrame(i) << "ms";
+@endcode
+
+Frames are expected to be played in order, as the first frame usually
+creates the objects used by the following ones. Frames after the first can be
+played repeatedly to get stable timings.
+@requires_gl OpenGL call tracing is available only on desktop OpenGL.
+*/
+class MAGNUM_DEBUGTOOLS_EXPORT GLTraceReplay {
+    public:
+        /**
+         * @brief Per-function statistics
+         *
+         * @see @ref statistics()
+         */
+        struct FunctionStatistics {
+            /** @brief Function name */
+            std::string name;
+
+            /** @brief Count of replayed calls */
+            std::size_t count;
+
+            /** @brief Total CPU time spent in the calls, in milliseconds */
+            Double time;
+        };
+
+        /** @brief Constructor */
+        explicit GLTraceReplay();
+
+        /** @brief Copying is not allowed */
+        GLTraceReplay(const GLTraceReplay&) = delete;
+
+        /** @brief Move constructor */
+        GLTraceReplay(GLTraceReplay&&) noexcept;
+
+        ~GLTraceReplay();
+
+        /** @brief Copying is not allowed */
+        GLTraceReplay& operator=(const GLTraceReplay&) = delete;
+
+        /** @brief Move assignment */
+        GLTraceReplay& operator=(GLTraceReplay&&) noexcept;
+
+        /**
+         * @brief Open trace data
+         *
+         * The data are copied. Prints message to error output and returns
+         * `false` if the data are not a valid trace. Calls of functions not
+         * known to this version of the engine are skipped during replay.
+         */
+        bool openData(Containers::ArrayView<const char> data);
+
+        /**
+         * @brief Open trace file
+         *
+         * Prints message to error output and returns `false` if the file
+         * can't be read or is not a valid trace.
+         */
+        bool openFile(const std::string& filename);
+
+        /** @brief Count of frames in the trace */
+        UnsignedInt frameCount() const { return _frames.size(); }
+
+        /** @brief Count of calls in given frame */
+        std::size_t callCount(UnsignedInt frame) const;
+
+        /**
+         * @brief Count of calls that were skipped
+         *
+         * Calls of functions not known to this version of the engine.
+         */
+        std::size_t skippedCount() const { return _skippedCount; }
+
+        /**
+         * @brief Set framebuffer used in place of the default framebuffer
+         *
+         * Useful for replaying traces on a windowless context. Default is
+         * `0`, i.e. the default framebuffer.
+         */
+        GLTraceReplay& setDefaultFramebuffer(UnsignedInt id);
+
+        /**
+         * @brief Play a frame
+         *
+         * Executes all calls of given frame on the current context, waits for
+         * the GPU to finish using @ref Renderer::finish() and returns the
+         * whole elapsed time in milliseconds. Time spent in each call is
+         * accumulated into @ref statistics().
+         */
+        Double playFrame(UnsignedInt frame);
+
+        /**
+         * @brief Per-function statistics
+         *
+         * Functions that weren't called are omitted, the list is sorted by
+         * total time, longest first.
+         */
+        std::vector<FunctionStatistics> statistics() const;
+
+        /** @brief Reset per-function statistics */
+        void resetStatistics();
+
+    private:
+        struct Function {
+            std::string name;
+            Int entry;
+            UnsignedByte argumentCount, flags;
+            std::size_t count;
+            Double time;
+        };
+
+        std::vector<char> _data;
+        std::vector<Function> _functions;
+        /* Offset and call count of each frame */
+        std::vector<std::pair<std::size_t, std::size_t>> _frames;
+        /* Recorded -> actual names for each object namespace */
+        std::unordered_map<UnsignedLong, UnsignedLong> _names[8];
+        std::size_t _skippedCount{};
+        UnsignedInt _defaultFramebuffer{};
+};
+
+}}
+#endif
+
+#endif
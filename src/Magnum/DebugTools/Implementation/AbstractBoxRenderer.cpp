@@ -33,11 +33,11 @@
 
 namespace Magnum { namespace DebugTools { namespace Implementation {
 
-AbstractBoxRenderer<2>::AbstractBoxRenderer(): AbstractShapeRenderer<2>("box2d", "box2d-vertices", {}) {
+AbstractBoxRenderer<2>::AbstractBoxRenderer(): AbstractShapeRenderer<2>(primitiveKey("Primitives::Square::wireframe")) {
     if(!wireframeMesh) AbstractShapeRenderer<2>::createResources(Primitives::Square::wireframe());
 }
 
-AbstractBoxRenderer<3>::AbstractBoxRenderer(): AbstractShapeRenderer<3>("box3d", "box3d-vertices", "box3d-indices") {
+AbstractBoxRenderer<3>::AbstractBoxRenderer(): AbstractShapeRenderer<3>(primitiveKey("Primitives::Cube::wireframe")) {
     if(!wireframeMesh) AbstractShapeRenderer<3>::createResources(Primitives::Cube::wireframe());
 }
 
@@ -25,9 +25,12 @@
 
 #include "AbstractShapeRenderer.h"
 
+#include <algorithm>
+
 #include "Magnum/AbstractShaderProgram.h"
 #include "Magnum/Buffer.h"
 #include "Magnum/Mesh.h"
+#include "Magnum/MeshView.h"
 #include "Magnum/DebugTools/ResourceManager.h"
 #include "Magnum/MeshTools/CompressIndices.h"
 #include "Magnum/Shaders/Flat.h"
@@ -42,6 +45,10 @@ template<UnsignedInt dimensions> ResourceKey shaderKey();
 template<> inline ResourceKey shaderKey<2>() { return ResourceKey("FlatShader2D"); }
 template<> inline ResourceKey shaderKey<3>() { return ResourceKey("FlatShader3D"); }
 
+template<UnsignedInt dimensions> ResourceKey instancedShaderKey();
+template<> inline ResourceKey instancedShaderKey<2>() { return ResourceKey("FlatShader2DInstanced"); }
+template<> inline ResourceKey instancedShaderKey<3>() { return ResourceKey("FlatShader3DInstanced"); }
+
 template<UnsignedInt dimensions> void create(typename MeshData<dimensions>::Type&, Resource<Mesh>&, Resource<Buffer>&, Resource<Buffer>&);
 
 template<> void create<2>(Trade::MeshData2D& data, Resource<Mesh>& meshResource, Resource<Buffer>& vertexBufferResource, Resource<Buffer>& indexBufferResource) {
@@ -58,8 +65,6 @@ template<> void create<2>(Trade::MeshData2D& data, Resource<Mesh>& meshResource,
 
     /* Index buffer, if needed, if not, resource key doesn't have to be set */
     if(data.isIndexed()) {
-        CORRADE_INTERNAL_ASSERT(indexBufferResource.key() != ResourceKey());
-
         Containers::Array<char> indexData;
         Mesh::IndexType indexType;
         UnsignedInt indexStart, indexEnd;
@@ -90,8 +95,6 @@ template<> void create<3>(Trade::MeshData3D& data, Resource<Mesh>& meshResource,
 
     /* Index buffer, if needed, if not, resource key doesn't have to be set */
     if(data.isIndexed()) {
-        CORRADE_INTERNAL_ASSERT(indexBufferResource.key() != ResourceKey());
-
         Containers::Array<char> indexData;
         Mesh::IndexType indexType;
         UnsignedInt indexStart, indexEnd;
@@ -110,11 +113,12 @@ template<> void create<3>(Trade::MeshData3D& data, Resource<Mesh>& meshResource,
 
 }
 
-template<UnsignedInt dimensions> AbstractShapeRenderer<dimensions>::AbstractShapeRenderer(ResourceKey meshKey, ResourceKey vertexBufferKey, ResourceKey indexBufferKey) {
+template<UnsignedInt dimensions> AbstractShapeRenderer<dimensions>::AbstractShapeRenderer(const std::string& primitive) {
     wireframeShader = ResourceManager::instance().get<AbstractShaderProgram, Shaders::Flat<dimensions>>(shaderKey<dimensions>());
-    wireframeMesh = ResourceManager::instance().get<Mesh>(meshKey);
-    vertexBuffer = ResourceManager::instance().get<Buffer>(vertexBufferKey);
-    indexBuffer = ResourceManager::instance().get<Buffer>(indexBufferKey);
+    wireframeMesh = ResourceManager::instance().get<Mesh>(primitive);
+    vertexBuffer = ResourceManager::instance().get<Buffer>(primitive + "-vertices");
+    indexBuffer = ResourceManager::instance().get<Buffer>(primitive + "-indices");
+    instanceBuffer = ResourceManager::instance().get<Buffer>(primitive + "-instances");
 
     if(!wireframeShader) ResourceManager::instance().set<AbstractShaderProgram>(shaderKey<dimensions>(),
         new Shaders::Flat<dimensions>, ResourceDataState::Final, ResourcePolicy::Resident);
@@ -126,6 +130,92 @@ template<UnsignedInt dimensions> void AbstractShapeRenderer<dimensions>::createR
     create<dimensions>(data, wireframeMesh, vertexBuffer, indexBuffer);
 }
 
+template<UnsignedInt dimensions> Buffer& AbstractShapeRenderer<dimensions>::instanceBufferForMesh() {
+    if(!instanceBuffer) {
+        Buffer* buffer = new Buffer{Buffer::TargetHint::Array};
+        wireframeMesh->addVertexBufferInstanced(*buffer, 1, 0,
+            typename Shaders::Flat<dimensions>::TransformationMatrix{},
+            typename Shaders::Flat<dimensions>::Color{Shaders::Flat<dimensions>::Color::Components::Four});
+        ResourceManager::instance().set(instanceBuffer.key(), buffer, ResourceDataState::Final, ResourcePolicy::Manual);
+    }
+
+    return *instanceBuffer;
+}
+
+template<UnsignedInt dimensions> Shaders::Flat<dimensions>& AbstractShapeRenderer<dimensions>::instancedShaderForMesh() {
+    if(!instancedShader) {
+        instancedShader = ResourceManager::instance().get<AbstractShaderProgram, Shaders::Flat<dimensions>>(instancedShaderKey<dimensions>());
+        if(!instancedShader) ResourceManager::instance().set<AbstractShaderProgram>(instancedShaderKey<dimensions>(),
+            new Shaders::Flat<dimensions>{typename Shaders::Flat<dimensions>::Flags{Shaders::Flat<dimensions>::Flag::InstancedTransformation}|Shaders::Flat<dimensions>::Flag::VertexColor},
+            ResourceDataState::Final, ResourcePolicy::Resident);
+    }
+
+    return *instancedShader;
+}
+
+template<UnsignedInt dimensions> void ShapeInstances<dimensions>::add(AbstractShapeRenderer<dimensions>& renderer, MeshView* const view, const MatrixTypeFor<dimensions, Float>& transformation, const Color4& color) {
+    Mesh* const mesh = &*renderer.wireframeMesh;
+
+    /* There's just a handful of distinct primitives, linear search is fine */
+    auto found = std::find_if(_batches.begin(), _batches.end(), [mesh, view](const Batch& batch) {
+        return batch.mesh == mesh && batch.view == view;
+    });
+    if(found == _batches.end()) {
+        _batches.push_back(Batch{&renderer, mesh, view, {}});
+        found = _batches.end() - 1;
+
+    /* Renderers come and go but the batches are kept between frames, update
+       the renderer to one that's surely alive */
+    } else found->renderer = &renderer;
+
+    found->instances.push_back({transformation, color});
+}
+
+template<UnsignedInt dimensions> void ShapeInstances<dimensions>::draw(const MatrixTypeFor<dimensions, Float>& projectionMatrix) {
+    for(Batch& batch: _batches) {
+        Shaders::Flat<dimensions>& shader = *batch.renderer->wireframeShader;
+        for(const ShapeInstance<dimensions>& instance: batch.instances) {
+            shader.setTransformationProjectionMatrix(projectionMatrix*instance.transformation)
+                .setColor(instance.color);
+            if(batch.view) batch.view->draw(shader);
+            else batch.mesh->draw(shader);
+        }
+    }
+}
+
+template<UnsignedInt dimensions> void ShapeInstances<dimensions>::drawInstanced(const MatrixTypeFor<dimensions, Float>& projectionMatrix) {
+    for(Batch& batch: _batches) {
+        if(batch.instances.empty()) continue;
+
+        /* Mesh views share the instance buffer of the original mesh, so the
+           data have to be uploaded right before each draw */
+        batch.renderer->instanceBufferForMesh().setData(batch.instances, BufferUsage::StreamDraw);
+
+        Shaders::Flat<dimensions>& shader = batch.renderer->instancedShaderForMesh();
+        shader.setTransformationProjectionMatrix(projectionMatrix)
+            .setColor(Color4{1.0f});
+
+        /* The mesh is shared with non-instanced drawing, reset the instance
+           count back afterwards */
+        const Int count = batch.instances.size();
+        if(batch.view) {
+            batch.view->setInstanceCount(count)
+                .draw(shader);
+            batch.view->setInstanceCount(1);
+        } else {
+            batch.mesh->setInstanceCount(count)
+                .draw(shader);
+            batch.mesh->setInstanceCount(1);
+        }
+    }
+}
+
+template<UnsignedInt dimensions> void ShapeInstances<dimensions>::clear() {
+    for(Batch& batch: _batches) batch.instances.clear();
+}
+
+template class ShapeInstances<2>;
+template class ShapeInstances<3>;
 template class AbstractShapeRenderer<2>;
 template class AbstractShapeRenderer<3>;
 
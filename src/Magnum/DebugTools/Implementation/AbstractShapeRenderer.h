@@ -25,13 +25,19 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <string>
+#include <vector>
+
 #include "Magnum/DimensionTraits.h"
 #include "Magnum/Resource.h"
+#include "Magnum/Math/Color.h"
 #include "Magnum/DebugTools/DebugTools.h"
 #include "Magnum/SceneGraph/SceneGraph.h"
 #include "Magnum/Shaders/Shaders.h"
 #include "Magnum/Trade/Trade.h"
 
+#include "PrimitiveKey.h"
+
 namespace Magnum {
 
 namespace Shapes { namespace Implementation {
@@ -45,12 +51,54 @@ template<UnsignedInt> struct MeshData;
 template<> struct MeshData<2> { typedef Trade::MeshData2D Type; };
 template<> struct MeshData<3> { typedef Trade::MeshData3D Type; };
 
+template<UnsignedInt> class AbstractShapeRenderer;
+
+/* Layout matches the instanced Flat shader attributes */
+template<UnsignedInt dimensions> struct ShapeInstance {
+    MatrixTypeFor<dimensions, Float> transformation;
+    Color4 color;
+};
+
+/* Shape instances gathered from shape renderers, grouped by the mesh (or
+   mesh view) they are drawn with. Renderers sharing a primitive share the
+   mesh, so all shapes of one kind end up in a single batch. */
+template<UnsignedInt dimensions> class ShapeInstances {
+    public:
+        void add(AbstractShapeRenderer<dimensions>& renderer, MeshView* view, const MatrixTypeFor<dimensions, Float>& transformation, const Color4& color);
+
+        /* Draws every instance with a separate draw call */
+        void draw(const MatrixTypeFor<dimensions, Float>& projectionMatrix);
+
+        /* Uploads instances of each batch into the batch mesh instance
+           buffer and draws them with a single instanced draw call */
+        void drawInstanced(const MatrixTypeFor<dimensions, Float>& projectionMatrix);
+
+        /* Removes all instances, but keeps the allocated memory for the next
+           frame */
+        void clear();
+
+    private:
+        struct Batch {
+            AbstractShapeRenderer<dimensions>* renderer;
+            Mesh* mesh;
+            MeshView* view;
+            std::vector<ShapeInstance<dimensions>> instances;
+        };
+
+        std::vector<Batch> _batches;
+};
+
 template<UnsignedInt dimensions> class AbstractShapeRenderer {
+    friend ShapeInstances<dimensions>;
+
     public:
-        AbstractShapeRenderer(ResourceKey mesh, ResourceKey vertexBuffer, ResourceKey indexBuffer);
+        /* The mesh and buffer resource keys are derived from @p primitive,
+           which is expected to be created with primitiveKey() */
+        explicit AbstractShapeRenderer(const std::string& primitive);
         virtual ~AbstractShapeRenderer();
 
-        virtual void draw(Resource<ShapeRendererOptions>& options, const MatrixTypeFor<dimensions, Float>& projectionMatrix) = 0;
+        /* Adds instances of the visualized shape */
+        virtual void collect(Resource<ShapeRendererOptions>& options, ShapeInstances<dimensions>& instances) = 0;
 
     protected:
         /* Call only if the mesh resource isn't already present */
@@ -60,7 +108,12 @@ template<UnsignedInt dimensions> class AbstractShapeRenderer {
         Resource<Mesh> wireframeMesh;
 
     private:
-        Resource<Buffer> indexBuffer, vertexBuffer;
+        /* Creates the instance buffer and adds it to the mesh on first use */
+        Buffer& instanceBufferForMesh();
+        Shaders::Flat<dimensions>& instancedShaderForMesh();
+
+        Resource<Buffer> indexBuffer, vertexBuffer, instanceBuffer;
+        Resource<AbstractShaderProgram, Shaders::Flat<dimensions>> instancedShader;
 };
 
 }}}
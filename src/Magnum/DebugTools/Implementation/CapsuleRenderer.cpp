@@ -39,12 +39,20 @@
 
 namespace Magnum { namespace DebugTools { namespace Implementation {
 
-AbstractCapsuleRenderer<2>::AbstractCapsuleRenderer(): AbstractShapeRenderer<2>("capsule2d", "capsule2d-vertices", "capsule2d-indices") {
+namespace {
     constexpr UnsignedInt rings = 10;
+    constexpr UnsignedInt segments = 40;
+
+    inline std::string capsuleKey2D() { return primitiveKey("Primitives::Capsule2D::wireframe", rings, 1, 1.0f); }
+    inline std::string capsuleKey3D() { return primitiveKey("Primitives::Capsule3D::wireframe", rings, 1, segments, 1.0f); }
+}
+
+AbstractCapsuleRenderer<2>::AbstractCapsuleRenderer(): AbstractShapeRenderer<2>(capsuleKey2D()) {
+    const std::string key = capsuleKey2D();
     if(!wireframeMesh) createResources(Primitives::Capsule2D::wireframe(rings, 1, 1.0f));
 
     /* Bottom hemisphere */
-    if(!(bottom = ResourceManager::instance().get<MeshView>("capsule2d-bottom"))) {
+    if(!(bottom = ResourceManager::instance().get<MeshView>(key + "-bottom"))) {
         auto view = new MeshView(*wireframeMesh);
         view->setCount(rings*4)
             .setIndexRange(0, 0, rings*2+1);
@@ -52,7 +60,7 @@ AbstractCapsuleRenderer<2>::AbstractCapsuleRenderer(): AbstractShapeRenderer<2>(
     }
 
     /* Cylinder */
-    if(!(cylinder = ResourceManager::instance().get<MeshView>("capsule2d-cylinder"))) {
+    if(!(cylinder = ResourceManager::instance().get<MeshView>(key + "-cylinder"))) {
         auto view = new MeshView(*wireframeMesh);
         view->setCount(4)
             .setIndexRange(rings*4, rings*2+1, rings*2+3);
@@ -60,7 +68,7 @@ AbstractCapsuleRenderer<2>::AbstractCapsuleRenderer(): AbstractShapeRenderer<2>(
     }
 
     /* Top hemisphere */
-    if(!(top = ResourceManager::instance().get<MeshView>("capsule2d-top"))) {
+    if(!(top = ResourceManager::instance().get<MeshView>(key + "-top"))) {
         auto view = new MeshView(*wireframeMesh);
         view->setCount(rings*4)
             .setIndexRange(rings*4+4, rings*2+3, rings*4+4);
@@ -68,13 +76,12 @@ AbstractCapsuleRenderer<2>::AbstractCapsuleRenderer(): AbstractShapeRenderer<2>(
     }
 }
 
-AbstractCapsuleRenderer<3>::AbstractCapsuleRenderer(): AbstractShapeRenderer<3>("capsule3d", "capsule3d-vertices", "capsule3d-indices") {
-    constexpr UnsignedInt rings = 10;
-    constexpr UnsignedInt segments = 40;
+AbstractCapsuleRenderer<3>::AbstractCapsuleRenderer(): AbstractShapeRenderer<3>(capsuleKey3D()) {
+    const std::string key = capsuleKey3D();
     if(!wireframeMesh) createResources(Primitives::Capsule3D::wireframe(rings, 1, segments, 1.0f));
 
     /* Bottom hemisphere */
-    if(!(bottom = ResourceManager::instance().get<MeshView>("capsule3d-bottom"))) {
+    if(!(bottom = ResourceManager::instance().get<MeshView>(key + "-bottom"))) {
         auto view = new MeshView(*wireframeMesh);
         view->setCount(rings*8)
             .setIndexRange(0, 0, rings*4+1);
@@ -82,7 +89,7 @@ AbstractCapsuleRenderer<3>::AbstractCapsuleRenderer(): AbstractShapeRenderer<3>(
     }
 
     /* Cylinder */
-    if(!(cylinder = ResourceManager::instance().get<MeshView>("capsule3d-cylinder"))) {
+    if(!(cylinder = ResourceManager::instance().get<MeshView>(key + "-cylinder"))) {
         auto view = new MeshView(*wireframeMesh);
         view->setCount(segments*4+8)
             .setIndexRange(rings*8, rings*4+1, rings*4+segments*2+5);
@@ -90,7 +97,7 @@ AbstractCapsuleRenderer<3>::AbstractCapsuleRenderer(): AbstractShapeRenderer<3>(
     }
 
     /* Top */
-    if(!(top = ResourceManager::instance().get<MeshView>("capsule3d-top"))) {
+    if(!(top = ResourceManager::instance().get<MeshView>(key + "-top"))) {
         auto view = new MeshView(*wireframeMesh);
         view->setCount(rings*8)
             .setIndexRange(rings*8+segments*4+8, rings*4+segments*2+5, rings*8+segments*2+6);
@@ -104,21 +111,17 @@ AbstractCapsuleRenderer<3>::~AbstractCapsuleRenderer() = default;
 
 template<UnsignedInt dimensions> CapsuleRenderer<dimensions>::CapsuleRenderer(const Shapes::Implementation::AbstractShape<dimensions>& capsule): capsule(static_cast<const Shapes::Implementation::Shape<Shapes::Capsule<dimensions>>&>(capsule).shape) {}
 
-template<UnsignedInt dimensions> void CapsuleRenderer<dimensions>::draw(Resource<ShapeRendererOptions>& options, const MatrixTypeFor<dimensions, Float>& projectionMatrix) {
+template<UnsignedInt dimensions> void CapsuleRenderer<dimensions>::collect(Resource<ShapeRendererOptions>& options, ShapeInstances<dimensions>& instances) {
     std::array<MatrixTypeFor<dimensions, Float>, 3> transformations = Implementation::capsuleRendererTransformation<dimensions>(capsule.a(), capsule.b(), capsule.radius());
-    AbstractShapeRenderer<dimensions>::wireframeShader->setColor(options->color());
 
     /* Bottom */
-    AbstractShapeRenderer<dimensions>::wireframeShader->setTransformationProjectionMatrix(projectionMatrix*transformations[0]);
-    AbstractCapsuleRenderer<dimensions>::bottom->draw(*AbstractShapeRenderer<dimensions>::wireframeShader);
+    instances.add(*this, &*AbstractCapsuleRenderer<dimensions>::bottom, transformations[0], options->color());
 
     /* Cylinder */
-    AbstractShapeRenderer<dimensions>::wireframeShader->setTransformationProjectionMatrix(projectionMatrix*transformations[1]);
-    AbstractCapsuleRenderer<dimensions>::cylinder->draw(*AbstractShapeRenderer<dimensions>::wireframeShader);
+    instances.add(*this, &*AbstractCapsuleRenderer<dimensions>::cylinder, transformations[1], options->color());
 
     /* Top */
-    AbstractShapeRenderer<dimensions>::wireframeShader->setTransformationProjectionMatrix(projectionMatrix*transformations[2]);
-    AbstractCapsuleRenderer<dimensions>::top->draw(*AbstractShapeRenderer<dimensions>::wireframeShader);
+    instances.add(*this, &*AbstractCapsuleRenderer<dimensions>::top, transformations[2], options->color());
 }
 
 template class CapsuleRenderer<2>;
@@ -56,7 +56,7 @@ template<UnsignedInt dimensions> class CapsuleRenderer: public AbstractCapsuleRe
         explicit CapsuleRenderer(const Shapes::Implementation::AbstractShape<dimensions>& capsule);
         CapsuleRenderer(const Shapes::Implementation::AbstractShape<dimensions>&&) = delete;
 
-        void draw(Resource<ShapeRendererOptions>& options, const MatrixTypeFor<dimensions, Float>& projectionMatrix) override;
+        void collect(Resource<ShapeRendererOptions>& options, ShapeInstances<dimensions>& instances) override;
 
     private:
         const Shapes::Capsule<dimensions>& capsule;
@@ -38,21 +38,20 @@
 
 namespace Magnum { namespace DebugTools { namespace Implementation {
 
-AbstractCylinderRenderer<2>::AbstractCylinderRenderer(): AbstractShapeRenderer<2>("cylinder2d", "cylinder2d-vertices", {}) {
+AbstractCylinderRenderer<2>::AbstractCylinderRenderer(): AbstractShapeRenderer<2>(primitiveKey("Primitives::Square::wireframe")) {
     if(!wireframeMesh) createResources(Primitives::Square::wireframe());
 }
 
-AbstractCylinderRenderer<3>::AbstractCylinderRenderer(): AbstractShapeRenderer<3>("cylinder3d", "cylinder3d-vertices", "cylinder3d-indices") {
+AbstractCylinderRenderer<3>::AbstractCylinderRenderer(): AbstractShapeRenderer<3>(primitiveKey("Primitives::Cylinder::wireframe", 1, 40, 1.0f)) {
     if(!wireframeMesh) createResources(Primitives::Cylinder::wireframe(1, 40, 1.0f));
 }
 
 template<UnsignedInt dimensions> CylinderRenderer<dimensions>::CylinderRenderer(const Shapes::Implementation::AbstractShape<dimensions>& cylinder): cylinder(static_cast<const Shapes::Implementation::Shape<Shapes::Cylinder<dimensions>>&>(cylinder).shape) {}
 
-template<UnsignedInt dimensions> void CylinderRenderer<dimensions>::draw(Resource<ShapeRendererOptions>& options, const MatrixTypeFor<dimensions, Float>& projectionMatrix) {
-    AbstractShapeRenderer<dimensions>::wireframeShader->setTransformationProjectionMatrix(projectionMatrix*
-        Implementation::cylinderRendererTransformation<dimensions>(cylinder.a(), cylinder.b(), cylinder.radius()))
-        .setColor(options->color());
-    AbstractShapeRenderer<dimensions>::wireframeMesh->draw(*AbstractShapeRenderer<dimensions>::wireframeShader);
+template<UnsignedInt dimensions> void CylinderRenderer<dimensions>::collect(Resource<ShapeRendererOptions>& options, ShapeInstances<dimensions>& instances) {
+    instances.add(*this, nullptr,
+        Implementation::cylinderRendererTransformation<dimensions>(cylinder.a(), cylinder.b(), cylinder.radius()),
+        options->color());
 }
 
 template class CylinderRenderer<2>;
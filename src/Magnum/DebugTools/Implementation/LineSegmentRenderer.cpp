@@ -38,28 +38,23 @@
 namespace Magnum { namespace DebugTools { namespace Implementation {
 
 namespace {
-    template<UnsignedInt dimensions> ResourceKey meshKey();
-    template<> inline ResourceKey meshKey<2>() { return ResourceKey("line2d"); }
-    template<> inline ResourceKey meshKey<3>() { return ResourceKey("line3d"); }
-
-    template<UnsignedInt dimensions> ResourceKey vertexBufferKey();
-    template<> inline ResourceKey vertexBufferKey<2>() { return ResourceKey("line2d-vertices"); }
-    template<> inline ResourceKey vertexBufferKey<3>() { return ResourceKey("line3d-vertices"); }
+    template<UnsignedInt dimensions> std::string meshKey();
+    template<> inline std::string meshKey<2>() { return primitiveKey("Primitives::Line2D::wireframe"); }
+    template<> inline std::string meshKey<3>() { return primitiveKey("Primitives::Line3D::wireframe"); }
 
     template<UnsignedInt dimensions> typename MeshData<dimensions>::Type meshData();
     template<> inline Trade::MeshData2D meshData<2>() { return Primitives::Line2D::wireframe(); }
     template<> inline Trade::MeshData3D meshData<3>() { return Primitives::Line3D::wireframe(); }
 }
 
-template<UnsignedInt dimensions> LineSegmentRenderer<dimensions>::LineSegmentRenderer(const Shapes::Implementation::AbstractShape<dimensions>& line): AbstractShapeRenderer<dimensions>(meshKey<dimensions>(), vertexBufferKey<dimensions>(), {}), line(static_cast<const Shapes::Implementation::Shape<Shapes::LineSegment<dimensions>>&>(line).shape) {
+template<UnsignedInt dimensions> LineSegmentRenderer<dimensions>::LineSegmentRenderer(const Shapes::Implementation::AbstractShape<dimensions>& line): AbstractShapeRenderer<dimensions>(meshKey<dimensions>()), line(static_cast<const Shapes::Implementation::Shape<Shapes::LineSegment<dimensions>>&>(line).shape) {
     if(!AbstractShapeRenderer<dimensions>::wireframeMesh) AbstractShapeRenderer<dimensions>::createResources(meshData<dimensions>());
 }
 
-template<UnsignedInt dimensions> void LineSegmentRenderer<dimensions>::draw(Resource<ShapeRendererOptions>& options, const MatrixTypeFor<dimensions, Float>& projectionMatrix) {
-    AbstractShapeRenderer<dimensions>::wireframeShader->setTransformationProjectionMatrix(projectionMatrix*
-        Implementation::lineSegmentRendererTransformation<dimensions>(line.a(), line.b()))
-        .setColor(options->color());
-    AbstractShapeRenderer<dimensions>::wireframeMesh->draw(*AbstractShapeRenderer<dimensions>::wireframeShader);
+template<UnsignedInt dimensions> void LineSegmentRenderer<dimensions>::collect(Resource<ShapeRendererOptions>& options, ShapeInstances<dimensions>& instances) {
+    instances.add(*this, nullptr,
+        Implementation::lineSegmentRendererTransformation<dimensions>(line.a(), line.b()),
+        options->color());
 }
 
 template class LineSegmentRenderer<2>;
@@ -36,30 +36,25 @@
 namespace Magnum { namespace DebugTools { namespace Implementation {
 
 namespace {
-    template<UnsignedInt dimensions> ResourceKey meshKey();
-    template<> inline ResourceKey meshKey<2>() { return ResourceKey("point2d"); }
-    template<> inline ResourceKey meshKey<3>() { return ResourceKey("point3d"); }
-
-    template<UnsignedInt dimensions> ResourceKey vertexBufferKey();
-    template<> inline ResourceKey vertexBufferKey<2>() { return ResourceKey("point2d-vertices"); }
-    template<> inline ResourceKey vertexBufferKey<3>() { return ResourceKey("point3d-vertices"); }
+    template<UnsignedInt dimensions> std::string meshKey();
+    template<> inline std::string meshKey<2>() { return primitiveKey("Primitives::Crosshair2D::wireframe"); }
+    template<> inline std::string meshKey<3>() { return primitiveKey("Primitives::Crosshair3D::wireframe"); }
 
     template<UnsignedInt dimensions> typename MeshData<dimensions>::Type meshData();
     template<> inline Trade::MeshData2D meshData<2>() { return Primitives::Crosshair2D::wireframe(); }
     template<> inline Trade::MeshData3D meshData<3>() { return Primitives::Crosshair3D::wireframe(); }
 }
 
-template<UnsignedInt dimensions> PointRenderer<dimensions>::PointRenderer(const Shapes::Implementation::AbstractShape<dimensions>& point): AbstractShapeRenderer<dimensions>(meshKey<dimensions>(), vertexBufferKey<dimensions>(), {}), point(static_cast<const Shapes::Implementation::Shape<Shapes::Point<dimensions>>&>(point).shape) {
+template<UnsignedInt dimensions> PointRenderer<dimensions>::PointRenderer(const Shapes::Implementation::AbstractShape<dimensions>& point): AbstractShapeRenderer<dimensions>(meshKey<dimensions>()), point(static_cast<const Shapes::Implementation::Shape<Shapes::Point<dimensions>>&>(point).shape) {
     if(!AbstractShapeRenderer<dimensions>::wireframeMesh) AbstractShapeRenderer<dimensions>::createResources(meshData<dimensions>());
 }
 
-template<UnsignedInt dimensions> void PointRenderer<dimensions>::draw(Resource<ShapeRendererOptions>& options, const MatrixTypeFor<dimensions, Float>& projectionMatrix) {
+template<UnsignedInt dimensions> void PointRenderer<dimensions>::collect(Resource<ShapeRendererOptions>& options, ShapeInstances<dimensions>& instances) {
     /* Half scale, because the point is 2x2(x2) */
-    AbstractShapeRenderer<dimensions>::wireframeShader->setTransformationProjectionMatrix(projectionMatrix*
+    instances.add(*this, nullptr,
         MatrixTypeFor<dimensions, Float>::translation(point.position())*
-        MatrixTypeFor<dimensions, Float>::scaling(VectorTypeFor<dimensions, Float>{options->pointSize()/2}))
-        .setColor(options->color());
-    AbstractShapeRenderer<dimensions>::wireframeMesh->draw(*AbstractShapeRenderer<dimensions>::wireframeShader);
+        MatrixTypeFor<dimensions, Float>::scaling(VectorTypeFor<dimensions, Float>{options->pointSize()/2}),
+        options->color());
 }
 
 template class PointRenderer<2>;
@@ -0,0 +1,59 @@
+#ifndef Magnum_DebugTools_Implementation_PrimitiveKey_h
+#define Magnum_DebugTools_Implementation_PrimitiveKey_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <string>
+
+namespace Magnum { namespace DebugTools { namespace Implementation {
+
+inline void primitiveKeyParameters(std::ostringstream&) {}
+
+template<class T> void primitiveKeyParameters(std::ostringstream& out, const T& first) {
+    out << first;
+}
+
+template<class T, class ...Args> void primitiveKeyParameters(std::ostringstream& out, const T& first, const Args&... next) {
+    out << first << ", ";
+    primitiveKeyParameters(out, next...);
+}
+
+/* Name of a primitive generated by given generator with given parameters,
+   e.g. `Primitives::UVSphere::wireframe(20, 40)`. Used as a base for
+   resource keys of compiled meshes so renderers using the same generator
+   with the same parameters share one mesh and its buffers, no matter which
+   shape they visualize. */
+template<class ...Args> std::string primitiveKey(const char* generator, const Args&... parameters) {
+    std::ostringstream out;
+    out << generator << '(';
+    primitiveKeyParameters(out, parameters...);
+    out << ')';
+    return out.str();
+}
+
+}}}
+
+#endif
@@ -36,22 +36,21 @@
 
 namespace Magnum { namespace DebugTools { namespace Implementation {
 
-AbstractSphereRenderer<2>::AbstractSphereRenderer(): AbstractShapeRenderer<2>("sphere2d", "sphere2d-vertices", {}) {
+AbstractSphereRenderer<2>::AbstractSphereRenderer(): AbstractShapeRenderer<2>(primitiveKey("Primitives::Circle::wireframe", 40)) {
     if(!wireframeMesh) createResources(Primitives::Circle::wireframe(40));
 }
 
-AbstractSphereRenderer<3>::AbstractSphereRenderer(): AbstractShapeRenderer<3>("sphere3d", "sphere3d-vertices", "sphere3d-indices") {
+AbstractSphereRenderer<3>::AbstractSphereRenderer(): AbstractShapeRenderer<3>(primitiveKey("Primitives::UVSphere::wireframe", 20, 40)) {
     if(!wireframeMesh) createResources(Primitives::UVSphere::wireframe(20, 40));
 }
 
 template<UnsignedInt dimensions> SphereRenderer<dimensions>::SphereRenderer(const Shapes::Implementation::AbstractShape<dimensions>& sphere): sphere(static_cast<const Shapes::Implementation::Shape<Shapes::Sphere<dimensions>>&>(sphere).shape) {}
 
-template<UnsignedInt dimensions> void SphereRenderer<dimensions>::draw(Resource<ShapeRendererOptions>& options, const MatrixTypeFor<dimensions, Float>& projectionMatrix) {
-    AbstractShapeRenderer<dimensions>::wireframeShader->setTransformationProjectionMatrix(projectionMatrix*
+template<UnsignedInt dimensions> void SphereRenderer<dimensions>::collect(Resource<ShapeRendererOptions>& options, ShapeInstances<dimensions>& instances) {
+    instances.add(*this, nullptr,
         MatrixTypeFor<dimensions, Float>::translation(sphere.position())*
-        MatrixTypeFor<dimensions, Float>::scaling(VectorTypeFor<dimensions, Float>{sphere.radius()}))
-        .setColor(options->color());
-    AbstractShapeRenderer<dimensions>::wireframeMesh->draw(*AbstractShapeRenderer<dimensions>::wireframeShader);
+        MatrixTypeFor<dimensions, Float>::scaling(VectorTypeFor<dimensions, Float>{sphere.radius()}),
+        options->color());
 }
 
 template class SphereRenderer<2>;
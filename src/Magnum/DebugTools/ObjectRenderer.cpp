@@ -31,7 +31,9 @@
 #include "Magnum/MeshTools/CompressIndices.h"
 #include "Magnum/MeshTools/Interleave.h"
 #include "Magnum/Primitives/Axis.h"
+#include "Magnum/SceneGraph/AbstractObject.h"
 #include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/Shaders/Flat.h"
 #include "Magnum/Shaders/VertexColor.h"
 #include "Magnum/Trade/MeshData2D.h"
 #include "Magnum/Trade/MeshData3D.h"
@@ -46,6 +48,8 @@ template<> struct Renderer<2> {
     static ResourceKey shader() { return {"VertexColorShader2D"}; }
     static ResourceKey vertexBuffer() { return {"object2d-vertices"}; }
     static ResourceKey indexBuffer() { return {"object2d-indices"}; }
+    static ResourceKey instanceBuffer() { return {"object2d-instances"}; }
+    static ResourceKey instancedShader() { return {"FlatShader2DInstanced"}; }
     static ResourceKey mesh() { return {"object2d"}; }
     static Trade::MeshData2D meshData() { return Primitives::axis2D(); }
 };
@@ -54,6 +58,8 @@ template<> struct Renderer<3> {
     static ResourceKey shader() { return {"VertexColorShader3D"}; }
     static ResourceKey vertexBuffer() { return {"object3d-vertices"}; }
     static ResourceKey indexBuffer() { return {"object3d-indices"}; }
+    static ResourceKey instanceBuffer() { return {"object3d-instances"}; }
+    static ResourceKey instancedShader() { return {"FlatShader3DInstanced"}; }
     static ResourceKey mesh() { return {"object3d"}; }
     static Trade::MeshData3D meshData() { return Primitives::axis3D(); }
 };
@@ -69,6 +75,7 @@ template<UnsignedInt dimensions> ObjectRenderer<dimensions>::ObjectRenderer(Scen
     _mesh = ResourceManager::instance().get<Mesh>(Renderer<dimensions>::mesh());
     _vertexBuffer = ResourceManager::instance().get<Buffer>(Renderer<dimensions>::vertexBuffer());
     _indexBuffer = ResourceManager::instance().get<Buffer>(Renderer<dimensions>::indexBuffer());
+    _instanceBuffer = ResourceManager::instance().get<Buffer>(Renderer<dimensions>::instanceBuffer());
     if(_mesh) return;
 
     /* Create the mesh */
@@ -96,6 +103,57 @@ template<UnsignedInt dimensions> ObjectRenderer<dimensions>::ObjectRenderer(Scen
 /* To avoid deleting pointers to incomplete type on destruction of Resource members */
 template<UnsignedInt dimensions> ObjectRenderer<dimensions>::~ObjectRenderer() = default;
 
+template<UnsignedInt dimensions> void ObjectRenderer<dimensions>::drawInstanced(SceneGraph::DrawableGroup<dimensions, Float>& drawables, SceneGraph::Camera<dimensions, Float>& camera) {
+    SceneGraph::AbstractObject<dimensions, Float>* scene = camera.object().scene();
+    CORRADE_ASSERT(scene, "DebugTools::ObjectRenderer::drawInstanced(): cannot draw when camera is not part of any scene", );
+
+    /* Compute camera matrix */
+    camera.object().setClean();
+
+    std::vector<std::reference_wrapper<SceneGraph::AbstractObject<dimensions, Float>>> objects;
+    std::vector<Float> sizes;
+    ObjectRenderer<dimensions>* first = nullptr;
+    for(std::size_t i = 0; i != drawables.size(); ++i) {
+        auto renderer = dynamic_cast<ObjectRenderer<dimensions>*>(&drawables[i]);
+        if(!renderer) continue;
+
+        if(!first) first = renderer;
+        objects.push_back(renderer->object());
+        sizes.push_back(renderer->_options->size());
+    }
+    if(!first) return;
+
+    /* Compute transformations of all objects relative to the camera */
+    std::vector<MatrixTypeFor<dimensions, Float>> transformations =
+        scene->transformationMatrices(objects, camera.cameraMatrix());
+    for(std::size_t i = 0; i != transformations.size(); ++i)
+        transformations[i] = transformations[i]*MatrixTypeFor<dimensions, Float>::scaling(VectorTypeFor<dimensions, Float>{sizes[i]});
+
+    /* Add the instance buffer to the mesh on first use */
+    if(!first->_instanceBuffer) {
+        Buffer* instanceBuffer = new Buffer{Buffer::TargetHint::Array};
+        first->_mesh->addVertexBufferInstanced(*instanceBuffer, 1, 0,
+            typename Shaders::Flat<dimensions>::TransformationMatrix{});
+        ResourceManager::instance().set(first->_instanceBuffer.key(), instanceBuffer, ResourceDataState::Final, ResourcePolicy::Manual);
+    }
+    first->_instanceBuffer->setData(transformations, BufferUsage::StreamDraw);
+
+    /* The per-vertex axis colors are multiplied with the (white) uniform
+       color */
+    Resource<AbstractShaderProgram, Shaders::Flat<dimensions>> shader = ResourceManager::instance().get<AbstractShaderProgram, Shaders::Flat<dimensions>>(Renderer<dimensions>::instancedShader());
+    if(!shader) ResourceManager::instance().set<AbstractShaderProgram>(shader.key(),
+        new Shaders::Flat<dimensions>{typename Shaders::Flat<dimensions>::Flags{Shaders::Flat<dimensions>::Flag::InstancedTransformation}|Shaders::Flat<dimensions>::Flag::VertexColor},
+        ResourceDataState::Final, ResourcePolicy::Resident);
+    shader->setTransformationProjectionMatrix(camera.projectionMatrix())
+        .setColor(Color4{1.0f});
+
+    /* The mesh is shared with non-instanced drawing, reset the instance
+       count back afterwards */
+    first->_mesh->setInstanceCount(transformations.size())
+        .draw(*shader);
+    first->_mesh->setInstanceCount(1);
+}
+
 template<UnsignedInt dimensions> void ObjectRenderer<dimensions>::draw(const MatrixTypeFor<dimensions, Float>& transformationMatrix, SceneGraph::Camera<dimensions, Float>& camera) {
     _shader->setTransformationProjectionMatrix(camera.projectionMatrix()*transformationMatrix*MatrixTypeFor<dimensions, Float>::scaling(VectorTypeFor<dimensions, Float>{_options->size()}));
     _mesh->draw(*_shader);
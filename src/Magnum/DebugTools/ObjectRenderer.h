@@ -82,6 +82,17 @@ Object3D* object;
 new DebugTools::ObjectRenderer2D(object, "my", debugDrawables);
 @endcode
 
+@anchor DebugTools-ObjectRenderer-instancing
+## Instanced drawing
+
+Drawing the group with @ref SceneGraph::Camera::draw() issues a separate
+draw call for every object. With many objects it's better to draw the group
+with @ref drawInstanced() instead, which draws axes of all objects using a
+single instanced draw call:
+@code
+DebugTools::ObjectRenderer3D::drawInstanced(debugDrawables, camera);
+@endcode
+
 @see @ref ObjectRenderer2D, @ref ObjectRenderer3D, @ref ObjectRendererOptions
 */
 template<UnsignedInt dimensions> class MAGNUM_DEBUGTOOLS_EXPORT ObjectRenderer: public SceneGraph::Drawable<dimensions, Float> {
@@ -100,13 +111,32 @@ template<UnsignedInt dimensions> class MAGNUM_DEBUGTOOLS_EXPORT ObjectRenderer:
 
         ~ObjectRenderer();
 
+        /**
+         * @brief Draw object renderers in given group using instancing
+         *
+         * Gathers transformations of all object renderers in @p drawables
+         * into an instance buffer and draws them with a single instanced
+         * draw call. Drawables that aren't object renderers are ignored, so
+         * it's best to have the object renderers in a dedicated group.
+         * Expects that the camera is part of a scene. See
+         * @ref DebugTools-ObjectRenderer-instancing "class documentation" for
+         * more information.
+         * @requires_gl33 Extension @extension{ARB,instanced_arrays}
+         * @requires_gles30 Extension @es_extension{ANGLE,instanced_arrays},
+         *      @es_extension{EXT,instanced_arrays} or
+         *      @es_extension{NV,instanced_arrays} in OpenGL ES 2.0.
+         * @requires_webgl20 Extension @webgl_extension{ANGLE,instanced_arrays}
+         *      in WebGL 1.0.
+         */
+        static void drawInstanced(SceneGraph::DrawableGroup<dimensions, Float>& drawables, SceneGraph::Camera<dimensions, Float>& camera);
+
     private:
         void draw(const MatrixTypeFor<dimensions, Float>& transformationMatrix, SceneGraph::Camera<dimensions, Float>& camera) override;
 
         Resource<ObjectRendererOptions> _options;
         Resource<AbstractShaderProgram, Shaders::VertexColor<dimensions>> _shader;
         Resource<Mesh> _mesh;
-        Resource<Buffer> _vertexBuffer, _indexBuffer;
+        Resource<Buffer> _vertexBuffer, _indexBuffer, _instanceBuffer;
 };
 
 /** @brief Two-dimensional object renderer */
@@ -0,0 +1,138 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "PerformanceWarnings.h"
+
+#ifndef MAGNUM_TARGET_WEBGL
+#include <algorithm>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/DebugTools/Profiler.h"
+
+namespace Magnum { namespace DebugTools {
+
+PerformanceWarnings::PerformanceWarnings(const std::size_t capacity): _capacity{capacity} {}
+
+PerformanceWarnings::~PerformanceWarnings() {
+    if(_installed) uninstall();
+}
+
+void PerformanceWarnings::install() {
+    DebugOutput::setEnabled(DebugOutput::Type::Performance, true);
+    DebugOutput::setEnabled(DebugOutput::Type::PushGroup, true);
+    DebugOutput::setEnabled(DebugOutput::Type::PopGroup, true);
+    DebugOutput::setCallback(callback, this);
+    _installed = true;
+}
+
+void PerformanceWarnings::uninstall() {
+    DebugOutput::setCallback(nullptr);
+    _installed = false;
+}
+
+void PerformanceWarnings::callback(const DebugOutput::Source source, const DebugOutput::Type type, const UnsignedInt id, const DebugOutput::Severity severity, const std::string& message, const void* const userParam) {
+    static_cast<PerformanceWarnings*>(const_cast<void*>(userParam))->handle(source, type, id, severity, message);
+}
+
+void PerformanceWarnings::handle(const DebugOutput::Source source, const DebugOutput::Type type, const UnsignedInt id, const DebugOutput::Severity severity, const std::string& message) {
+    /* Track the debug group stack. Unbalanced pops (e.g. groups pushed
+       before installing) are ignored. */
+    if(type == DebugOutput::Type::PushGroup) {
+        _groups.push_back(message);
+        return;
+    }
+    if(type == DebugOutput::Type::PopGroup) {
+        if(!_groups.empty()) _groups.pop_back();
+        return;
+    }
+
+    if(type != DebugOutput::Type::Performance) {
+        if(_forwardCallback) _forwardCallback(source, type, id, severity, message, _forwardUserParam);
+        return;
+    }
+
+    ++_frameCount;
+
+    /* Existing warning, just count it */
+    const UnsignedLong key = UnsignedLong(GLenum(source)) << 32 | id;
+    const auto found = _warningIndex.find(key);
+    if(found != _warningIndex.end()) {
+        Warning& warning = _warnings[found->second];
+        warning.lastFrame = _frame;
+        ++warning.count;
+        ++warning.frameCount;
+        return;
+    }
+
+    if(_warnings.size() >= _capacity) {
+        ++_droppedCount;
+        return;
+    }
+
+    _warningIndex.emplace(key, _warnings.size());
+    _warnings.push_back(Warning{source, severity, id, message,
+        _profiler ? _profiler->sectionName(_profiler->currentSection()) : std::string{},
+        _groups.empty() ? std::string{} : _groups.back(),
+        _frame, _frame, 1, 1, 0});
+}
+
+void PerformanceWarnings::nextFrame() {
+    for(Warning& warning: _warnings) {
+        warning.previousFrameCount = warning.frameCount;
+        warning.frameCount = 0;
+    }
+
+    _frameCount = 0;
+    ++_frame;
+}
+
+void PerformanceWarnings::clear() {
+    _warnings.clear();
+    _warningIndex.clear();
+    _frameCount = _droppedCount = 0;
+}
+
+void PerformanceWarnings::printStatistics() const {
+    std::vector<const Warning*> sorted;
+    sorted.reserve(_warnings.size());
+    for(const Warning& warning: _warnings) sorted.push_back(&warning);
+    std::stable_sort(sorted.begin(), sorted.end(), [](const Warning* a, const Warning* b) {
+        return a->count > b->count;
+    });
+
+    Debug() << "Performance warnings collected over" << _frame + 1 << "frames:";
+    for(const Warning* warning: sorted) {
+        Debug d;
+        d << " " << warning->count << Debug::nospace << "x, last frame" << warning->previousFrameCount << Debug::nospace << "x, ID" << warning->id;
+        if(!warning->section.empty()) d << "in section" << warning->section;
+        if(!warning->group.empty()) d << "in group" << warning->group;
+        d << Debug::nospace << ":" << warning->message;
+    }
+    if(_droppedCount)
+        Debug() << " " << _droppedCount << "occurrences of further warnings were dropped";
+}
+
+}}
+#endif
@@ -0,0 +1,290 @@
+#ifndef Magnum_DebugTools_PerformanceWarnings_h
+#define Magnum_DebugTools_PerformanceWarnings_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MAGNUM_TARGET_WEBGL
+/** @file
+ * @brief Class @ref Magnum::DebugTools::PerformanceWarnings
+ */
+#endif
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Magnum/DebugOutput.h"
+#include "Magnum/DebugTools/DebugTools.h"
+#include "Magnum/DebugTools/visibility.h"
+
+#ifndef MAGNUM_TARGET_WEBGL
+namespace Magnum { namespace DebugTools {
+
+/**
+@brief Performance warning collector
+
+Collects @ref DebugOutput::Type::Performance messages reported by the driver,
+such as shader recompiles, pipeline stalls or buffer ghosting, in a form that
+is usable also in production builds. Instead of printing every message, the
+warnings are deduplicated by their source and ID, counted per frame and
+annotated with the @ref Profiler section and @ref DebugGroup that were active
+when the warning first occurred.
+@code
+DebugTools::Profiler profiler;
+DebugTools::PerformanceWarnings warnings;
+warnings.setProfiler(&profiler)
+    .install();
+
+// each frame
+{
+    DebugGroup group{DebugGroup::Source::Application, 0, "Shadow pass"};
+    // ...
+}
+warnings.nextFrame();
+
+// occasionally
+warnings.printStatistics();
+@endcode
+
+@ref install() replaces the @ref DebugOutput::setCallback() "debug output callback"
+and enables performance, debug group push and debug group pop messages.
+Messages of other types are passed to @ref setForwardCallback() "forward callback",
+if any. Debug group labels are tracked through the push and pop messages, so
+they are available only for groups pushed using @ref DebugGroup. GPU drivers
+may call the callback from a different thread unless
+@ref Renderer::Feature::DebugOutputSynchronous is enabled, in which case
+the reported sections and groups might not correspond to what caused the
+warning.
+
+The messages can be also passed manually using @ref handle(), for example
+when you already have a custom debug output callback.
+
+At most @ref capacity() unique warnings is kept, occurrences of new warnings
+past that limit are only counted in @ref droppedCount().
+@requires_gles Debug output is not available in WebGL.
+*/
+class MAGNUM_DEBUGTOOLS_EXPORT PerformanceWarnings {
+    public:
+        /**
+         * @brief Collected warning
+         *
+         * @see @ref warnings()
+         */
+        struct Warning {
+            /** @brief Message source */
+            DebugOutput::Source source;
+
+            /** @brief Message severity */
+            DebugOutput::Severity severity;
+
+            /** @brief Message ID */
+            UnsignedInt id;
+
+            /** @brief Message text of the first occurrence */
+            std::string message;
+
+            /**
+             * @brief Profiler section of the first occurrence
+             *
+             * Empty if no profiler is set.
+             * @see @ref setProfiler()
+             */
+            std::string section;
+
+            /**
+             * @brief Innermost debug group of the first occurrence
+             *
+             * Empty if the warning occurred outside of any debug group.
+             */
+            std::string group;
+
+            /** @brief Frame of the first occurrence */
+            UnsignedLong firstFrame;
+
+            /** @brief Frame of the last occurrence */
+            UnsignedLong lastFrame;
+
+            /** @brief Total count of occurrences */
+            std::size_t count;
+
+            /** @brief Count of occurrences in current frame */
+            std::size_t frameCount;
+
+            /** @brief Count of occurrences in previous frame */
+            std::size_t previousFrameCount;
+        };
+
+        /**
+         * @brief Constructor
+         * @param capacity  Max count of unique warnings
+         *
+         * Doesn't install the callback, call @ref install() for that.
+         */
+        explicit PerformanceWarnings(std::size_t capacity = 256);
+
+        /** @brief Copying is not allowed */
+        PerformanceWarnings(const PerformanceWarnings&) = delete;
+
+        /** @brief Moving is not allowed */
+        PerformanceWarnings(PerformanceWarnings&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Calls @ref uninstall() if the collector is installed.
+         */
+        ~PerformanceWarnings();
+
+        /** @brief Copying is not allowed */
+        PerformanceWarnings& operator=(const PerformanceWarnings&) = delete;
+
+        /** @brief Moving is not allowed */
+        PerformanceWarnings& operator=(PerformanceWarnings&&) = delete;
+
+        /** @brief Max count of unique warnings */
+        std::size_t capacity() const { return _capacity; }
+
+        /** @brief Profiler used for section annotation */
+        Profiler* profiler() const { return _profiler; }
+
+        /**
+         * @brief Set profiler used for section annotation
+         * @return Reference to self (for method chaining)
+         *
+         * The warnings are annotated with @ref Profiler::currentSection() of
+         * given profiler. Set to `nullptr` to disable the annotation, which
+         * is the default.
+         */
+        PerformanceWarnings& setProfiler(Profiler* profiler) {
+            _profiler = profiler;
+            return *this;
+        }
+
+        /**
+         * @brief Set forward callback
+         * @return Reference to self (for method chaining)
+         *
+         * Called for all messages that are not performance warnings or debug
+         * group notifications. Default is `nullptr`, which drops them.
+         */
+        PerformanceWarnings& setForwardCallback(DebugOutput::Callback callback, const void* userParam = nullptr) {
+            _forwardCallback = callback;
+            _forwardUserParam = userParam;
+            return *this;
+        }
+
+        /** @brief Whether the collector is installed */
+        bool isInstalled() const { return _installed; }
+
+        /**
+         * @brief Install the collector
+         *
+         * Sets itself as the debug output callback and enables
+         * @ref DebugOutput::Type::Performance, @ref DebugOutput::Type::PushGroup
+         * and @ref DebugOutput::Type::PopGroup messages. Requires an active
+         * context.
+         * @see @ref DebugOutput::setCallback(), @ref DebugOutput::setEnabled()
+         */
+        void install();
+
+        /**
+         * @brief Uninstall the collector
+         *
+         * Resets the debug output callback. Collected warnings are kept.
+         */
+        void uninstall();
+
+        /**
+         * @brief Handle a debug message
+         *
+         * Called from the debug output callback if installed, can be also
+         * called manually. Signature matches @ref DebugOutput::Callback
+         * except for the user pointer.
+         */
+        void handle(DebugOutput::Source source, DebugOutput::Type type, UnsignedInt id, DebugOutput::Severity severity, const std::string& message);
+
+        /**
+         * @brief Advance to next frame
+         *
+         * Moves per-frame occurrence counts of all warnings to
+         * @ref Warning::previousFrameCount. Call at the end of each frame.
+         */
+        void nextFrame();
+
+        /** @brief Index of current frame */
+        UnsignedLong frame() const { return _frame; }
+
+        /**
+         * @brief Collected warnings
+         *
+         * In order of their first occurrence.
+         */
+        const std::vector<Warning>& warnings() const { return _warnings; }
+
+        /** @brief Count of warning occurrences in current frame */
+        std::size_t frameCount() const { return _frameCount; }
+
+        /**
+         * @brief Count of dropped occurrences
+         *
+         * Occurrences of new unique warnings after @ref capacity() was
+         * reached.
+         */
+        std::size_t droppedCount() const { return _droppedCount; }
+
+        /**
+         * @brief Clear collected warnings
+         *
+         * Doesn't affect the frame counter and the debug group stack.
+         */
+        void clear();
+
+        /**
+         * @brief Print statistics
+         *
+         * Prints collected warnings ordered by total occurrence count.
+         */
+        void printStatistics() const;
+
+    private:
+        static void callback(DebugOutput::Source source, DebugOutput::Type type, UnsignedInt id, DebugOutput::Severity severity, const std::string& message, const void* userParam);
+
+        std::size_t _capacity;
+        Profiler* _profiler{};
+        DebugOutput::Callback _forwardCallback{};
+        const void* _forwardUserParam{};
+        bool _installed{};
+
+        UnsignedLong _frame{};
+        std::size_t _frameCount{}, _droppedCount{};
+        std::vector<Warning> _warnings;
+        std::unordered_map<UnsignedLong, std::size_t> _warningIndex;
+        std::vector<std::string> _groups;
+};
+
+}}
+#endif
+
+#endif
@@ -26,7 +26,12 @@
 #include "Profiler.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iomanip>
+#include <iterator>
 #include <numeric>
+#include <sstream>
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/Debug.h>
 
@@ -36,25 +41,277 @@ using namespace std::chrono;
 
 namespace Magnum { namespace DebugTools {
 
+namespace {
+    void writeJsonString(std::ostream& out, const std::string& string) {
+        out << '"';
+        for(const char c: string) {
+            if(c == '"' || c == '\\') out << '\\' << c;
+            else if(UnsignedByte(c) < 0x20)
+                out << "\\u00" << std::hex << std::setw(2) << std::setfill('0') << Int(c) << std::dec;
+            else out << c;
+        }
+        out << '"';
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    const char* pipelineStatisticName(const PipelineStatisticsQuery::Target target) {
+        switch(target) {
+            case PipelineStatisticsQuery::Target::VerticesSubmitted: return "vertices";
+            case PipelineStatisticsQuery::Target::PrimitivesSubmitted: return "primitives";
+            case PipelineStatisticsQuery::Target::VertexShaderInvocations: return "VS invocations";
+            case PipelineStatisticsQuery::Target::TessellationControlShaderPatches: return "TCS patches";
+            case PipelineStatisticsQuery::Target::TessellationEvaluationShaderInvocations: return "TES invocations";
+            case PipelineStatisticsQuery::Target::GeometryShaderInvocations: return "GS invocations";
+            case PipelineStatisticsQuery::Target::GeometryShaderPrimitivesEmitted: return "GS primitives";
+            case PipelineStatisticsQuery::Target::FragmentShaderInvocations: return "FS invocations";
+            case PipelineStatisticsQuery::Target::ComputeShaderInvocations: return "CS invocations";
+            case PipelineStatisticsQuery::Target::ClippingInputPrimitives: return "clipping input";
+            case PipelineStatisticsQuery::Target::ClippingOutputPrimitives: return "clipping output";
+        }
+
+        CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+    }
+    #endif
+
+    void writeCsvString(std::ostream& out, const std::string& string) {
+        if(string.find_first_of(",\"\n") == std::string::npos) {
+            out << string;
+            return;
+        }
+
+        out << '"';
+        for(const char c: string) {
+            if(c == '"') out << '"';
+            out << c;
+        }
+        out << '"';
+    }
+
+    /* Microseconds with three decimal places, as expected by the trace
+       format */
+    void writeMicroseconds(std::ostream& out, const nanoseconds time) {
+        out << time.count()/1000 << '.' << std::setw(3) << std::setfill('0') << time.count()%1000;
+    }
+
+    const char* const InstrumentationZoneNames[]{
+        "Mesh::draw()",
+        "AbstractTexture::bind()",
+        "SceneGraph::Camera::draw()",
+        "Text::Renderer::render()",
+        "SceneGraph::DepthPrepass"
+    };
+
+    const char* const InstrumentationCounterNames[]{
+        "draw calls",
+        "buffer upload bytes",
+        "texture binds",
+        "shader switches",
+        "framebuffer bytes avoided"
+    };
+
+    static_assert(sizeof(InstrumentationZoneNames)/sizeof(InstrumentationZoneNames[0]) == Instrumentation::ZoneCount, "update the zone names");
+    static_assert(sizeof(InstrumentationCounterNames)/sizeof(InstrumentationCounterNames[0]) == Instrumentation::CounterCount, "update the counter names");
+
+    /* Log-linear histogram of nanoseconds. Values below 64 ns have a bucket
+       each, every following power of two is split into 32 buckets, giving
+       a worst-case error of about 3 %. Values above 2^36 ns (~68 seconds)
+       are clamped. */
+    enum: std::size_t {
+        HistogramSubBucketBits = 5,
+        HistogramMaxBits = 36,
+        HistogramBucketCount = (2 << HistogramSubBucketBits) + (HistogramMaxBits - HistogramSubBucketBits - 1)*(1 << HistogramSubBucketBits)
+    };
+
+    std::size_t histogramBucket(std::uint64_t value) {
+        value = std::min(value, (std::uint64_t(1) << HistogramMaxBits) - 1);
+        if(value < (2 << HistogramSubBucketBits)) return value;
+
+        std::size_t shift = 1;
+        while(value >> (shift + HistogramSubBucketBits + 1)) ++shift;
+        return (2 << HistogramSubBucketBits) + ((shift - 1) << HistogramSubBucketBits) + ((value >> shift) - (1 << HistogramSubBucketBits));
+    }
+
+    /* Highest value that falls into given bucket */
+    std::uint64_t histogramBucketMax(const std::size_t bucket) {
+        if(bucket < (2 << HistogramSubBucketBits)) return bucket;
+
+        const std::size_t shift = ((bucket - (2 << HistogramSubBucketBits)) >> HistogramSubBucketBits) + 1;
+        const std::uint64_t top = (bucket & ((1 << HistogramSubBucketBits) - 1)) + (1 << HistogramSubBucketBits);
+        return ((top + 1) << shift) - 1;
+    }
+
+    static_assert(HistogramBucketCount == 1024, "histogram bucket count mismatch");
+
+    /* Updated from any thread by the allocation hooks, only ever growing so
+       the profilers just sample the difference */
+    std::atomic<std::uint64_t> globalAllocationCount{0};
+    std::atomic<std::uint64_t> globalAllocatedBytes{0};
+}
+
+void Implementation::recordAllocation(const std::size_t size) noexcept {
+    globalAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    globalAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+Profiler::~Profiler() {
+    if(Instrumentation::listener() == &_instrumentationListener)
+        Instrumentation::setListener(nullptr);
+}
+
 Profiler::Section Profiler::addSection(const std::string& name) {
     CORRADE_ASSERT(!_enabled, "Profiler: cannot add section when profiling is enabled", 0);
     _sections.push_back(name);
     return _sections.size()-1;
 }
 
+const std::string& Profiler::sectionName(const Section section) const {
+    CORRADE_ASSERT(section < _sections.size(), "Profiler: unknown section passed to sectionName()", _sections[otherSection]);
+    return _sections[section];
+}
+
+Profiler::Section Profiler::currentSection() const {
+    if(!_enabled) return otherSection;
+
+    if(_captureCapacity) {
+        const std::thread::id id = std::this_thread::get_id();
+        std::lock_guard<std::mutex> lock{_captureMutex};
+        for(const Track& t: _tracks)
+            if(t.id == id && !t.stack.empty()) return t.stack.back().first;
+    }
+
+    return _currentSection;
+}
+
 void Profiler::setMeasureDuration(std::size_t frames) {
     CORRADE_ASSERT(!_enabled, "Profiler: cannot set measure duration when profiling is enabled", );
     _measureDuration = frames;
 }
 
+#ifndef MAGNUM_TARGET_WEBGL
+void Profiler::setGpuProfilingEnabled(const bool enabled) {
+    CORRADE_ASSERT(!_enabled, "Profiler: cannot enable GPU profiling when profiling is enabled", );
+    _gpuEnabled = enabled;
+}
+
+void Profiler::setGpuLatency(const std::size_t frames) {
+    CORRADE_ASSERT(!_enabled, "Profiler: cannot set GPU latency when profiling is enabled", );
+    _gpuLatency = frames;
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES
+void Profiler::setPipelineStatistics(std::vector<PipelineStatisticsQuery::Target> targets) {
+    CORRADE_ASSERT(!_enabled, "Profiler: cannot set pipeline statistics when profiling is enabled", );
+    _pipelineStatistics = std::move(targets);
+}
+#endif
+
+void Profiler::setInstrumentationEnabled(const bool enabled) {
+    CORRADE_ASSERT(!_enabled, "Profiler: cannot enable instrumentation when profiling is enabled", );
+    _instrumentationEnabled = enabled;
+}
+
+void Profiler::setAllocationTrackingEnabled(const bool enabled) {
+    CORRADE_ASSERT(!_enabled, "Profiler: cannot enable allocation tracking when profiling is enabled", );
+    _allocationTrackingEnabled = enabled;
+}
+
+Profiler::Section Profiler::instrumentationSection(const Instrumentation::Zone zone) const {
+    CORRADE_ASSERT(_instrumentationSections, "Profiler: instrumentation was not enabled", 0);
+    return _instrumentationSections + UnsignedByte(zone);
+}
+
+void Profiler::setSpikeCapacity(const std::size_t count) {
+    CORRADE_ASSERT(!_enabled, "Profiler: cannot set spike capacity when profiling is enabled", );
+    _spikeCapacity = count;
+}
+
+void Profiler::setCaptureCapacity(const std::size_t samples) {
+    CORRADE_ASSERT(!_enabled, "Profiler: cannot set capture capacity when profiling is enabled", );
+    _captureCapacity = samples;
+}
+
 void Profiler::enable() {
+    /* Add sections for instrumentation zones on first use */
+    if(_instrumentationEnabled && !_instrumentationSections) {
+        _instrumentationSections = _sections.size();
+        _sections.insert(_sections.end(), std::begin(InstrumentationZoneNames), std::end(InstrumentationZoneNames));
+    }
+
+    if(_captureCapacity) {
+        std::lock_guard<std::mutex> lock{_captureMutex};
+        _samples.clear();
+        _samples.reserve(_captureCapacity);
+        _captureNext = 0;
+        _captureFrame = 0;
+        _tracks.clear();
+        _captureStart = high_resolution_clock::now();
+    }
+
     _enabled = true;
     _frameData.assign(_measureDuration*_sections.size(), high_resolution_clock::duration::zero());
     _totalData.assign(_sections.size(), high_resolution_clock::duration::zero());
     _frameCount = 0;
+
+    /* One histogram more for the whole frame */
+    _histogramData.assign((_sections.size() + 1)*HistogramBucketCount, 0);
+    _histogramMax.assign(_sections.size() + 1, 0);
+    _histogramCount = 0;
+
+    /* Preallocate the spike snapshots so recording doesn't allocate */
+    _spikes.resize(_spikeCapacity);
+    for(Spike& spike: _spikes) {
+        spike.frame = 0;
+        spike.duration = high_resolution_clock::duration::zero();
+        spike.sections.assign(_sections.size(), high_resolution_clock::duration::zero());
+    }
+
+    if(_instrumentationEnabled) {
+        _counterFrameData.assign(_measureDuration*Instrumentation::CounterCount, 0);
+        _counterTotalData.assign(Instrumentation::CounterCount, 0);
+        Instrumentation::resetCounters();
+        Instrumentation::setListener(&_instrumentationListener);
+    }
+
+    if(_allocationTrackingEnabled) {
+        _allocationFrameData.assign(_measureDuration*_sections.size()*2, 0);
+        _allocationTotalData.assign(_sections.size()*2, 0);
+        _previousAllocationCount = globalAllocationCount.load(std::memory_order_relaxed);
+        _previousAllocatedBytes = globalAllocatedBytes.load(std::memory_order_relaxed);
+    }
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    /* Queries from already allocated frames are reused */
+    if(_gpuEnabled) {
+        _gpuFrames.resize(_gpuLatency + 1);
+        for(GpuFrame& frame: _gpuFrames) {
+            frame.count = 0;
+            #ifndef MAGNUM_TARGET_GLES
+            frame.statisticsQueries.clear();
+            #endif
+        }
+        _gpuFrameData.assign(_measureDuration*_sections.size(), high_resolution_clock::duration::zero());
+        _gpuTotalData.assign(_sections.size(), high_resolution_clock::duration::zero());
+        #ifndef MAGNUM_TARGET_GLES
+        _statisticsFrameData.assign(_measureDuration*_sections.size()*_pipelineStatistics.size(), 0);
+        _statisticsTotalData.assign(_sections.size()*_pipelineStatistics.size(), 0);
+        #endif
+        _currentGpuFrame = 0;
+        _currentGpuResultFrame = 0;
+        _gpuResultFrameCount = 0;
+    }
+    #endif
 }
 
 void Profiler::disable() {
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(_enabled && _gpuEnabled) endGpuQuery();
+    #endif
+
+    /* Don't reset the listener if somebody else replaced it in the meantime */
+    if(Instrumentation::listener() == &_instrumentationListener)
+        Instrumentation::setListener(nullptr);
+
     _enabled = false;
 }
 
@@ -64,7 +321,15 @@ void Profiler::start(Section section) {
 
     save();
 
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(_gpuEnabled) endGpuQuery();
+    #endif
+
     _currentSection = section;
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(_gpuEnabled) beginGpuQuery();
+    #endif
 }
 
 void Profiler::stop() {
@@ -72,16 +337,44 @@ void Profiler::stop() {
 
     save();
 
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(_gpuEnabled) endGpuQuery();
+    #endif
+
     _previousTime = high_resolution_clock::time_point();
 }
 
 void Profiler::save() {
     auto now = high_resolution_clock::now();
 
-    /* If the profiler is already running, add time to given section */
-    if(_previousTime != high_resolution_clock::time_point())
+    /* Allocations since the previous save */
+    std::uint64_t allocationCount = 0, allocatedBytes = 0;
+    if(_allocationTrackingEnabled) {
+        const std::uint64_t count = globalAllocationCount.load(std::memory_order_relaxed);
+        const std::uint64_t bytes = globalAllocatedBytes.load(std::memory_order_relaxed);
+        allocationCount = count - _previousAllocationCount;
+        allocatedBytes = bytes - _previousAllocatedBytes;
+        _previousAllocationCount = count;
+        _previousAllocatedBytes = bytes;
+    }
+
+    /* If the profiler is already running, add time and allocations to given
+       section */
+    if(_previousTime != high_resolution_clock::time_point()) {
         _frameData[_currentFrame*_sections.size()+_currentSection] += now-_previousTime;
 
+        if(_allocationTrackingEnabled) {
+            const std::size_t i = (_currentFrame*_sections.size()+_currentSection)*2;
+            _allocationFrameData[i] += allocationCount;
+            _allocationFrameData[i + 1] += allocatedBytes;
+        }
+
+        if(_captureCapacity) {
+            std::lock_guard<std::mutex> lock{_captureMutex};
+            record(_currentSection, &track() - _tracks.data(), 0, _previousTime, now, allocationCount, allocatedBytes);
+        }
+    }
+
     /* Set current time as previous for next section */
     _previousTime = now;
 }
@@ -92,6 +385,22 @@ void Profiler::nextFrame() {
     /* Next frame index */
     std::size_t nextFrame = (_currentFrame+1) % _measureDuration;
 
+    /* Add counters of current frame to total, subtract counters of next frame
+       from total and erase them */
+    if(_instrumentationEnabled) {
+        for(std::size_t i = 0; i != Instrumentation::CounterCount; ++i) {
+            const std::uint64_t value = Instrumentation::counter(Instrumentation::Counter(i));
+            _counterFrameData[_currentFrame*Instrumentation::CounterCount+i] = value;
+            _counterTotalData[i] += value;
+            _counterTotalData[i] -= _counterFrameData[nextFrame*Instrumentation::CounterCount+i];
+            _counterFrameData[nextFrame*Instrumentation::CounterCount+i] = 0;
+        }
+
+        Instrumentation::resetCounters();
+    }
+
+    recordFrame();
+
     /* Add times of current frame to total */
     for(std::size_t i = 0; i != _sections.size(); ++i)
         _totalData[i] += _frameData[_currentFrame*_sections.size()+i];
@@ -102,10 +411,368 @@ void Profiler::nextFrame() {
         _frameData[nextFrame*_sections.size()+i] = high_resolution_clock::duration::zero();
     }
 
+    /* Same for allocations */
+    if(_allocationTrackingEnabled) {
+        for(std::size_t i = 0; i != _sections.size()*2; ++i) {
+            _allocationTotalData[i] += _allocationFrameData[_currentFrame*_sections.size()*2+i];
+            _allocationTotalData[i] -= _allocationFrameData[nextFrame*_sections.size()*2+i];
+            _allocationFrameData[nextFrame*_sections.size()*2+i] = 0;
+        }
+    }
+
     /* Advance to next frame */
     _currentFrame = nextFrame;
 
     if(_frameCount < _measureDuration) ++_frameCount;
+
+    if(_captureCapacity) {
+        std::lock_guard<std::mutex> lock{_captureMutex};
+        ++_captureFrame;
+    }
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(_gpuEnabled) {
+        /* Close the query of currently running section so all queries of the
+           frame can be read back together */
+        const bool running = _gpuQueryRunning;
+        endGpuQuery();
+
+        /* Advance to the next frame and read back results of the frame that
+           was previously submitted in it */
+        _currentGpuFrame = (_currentGpuFrame + 1) % _gpuFrames.size();
+        readGpuFrame(_gpuFrames[_currentGpuFrame]);
+
+        /* Continue measuring the section in the new frame */
+        if(running) beginGpuQuery();
+    }
+    #endif
+}
+
+void Profiler::recordFrame() {
+    const high_resolution_clock::duration* const frame = _frameData.data() + _currentFrame*_sections.size();
+
+    /* Per-section histograms */
+    high_resolution_clock::duration frameTime = high_resolution_clock::duration::zero();
+    for(std::size_t i = 0; i <= _sections.size(); ++i) {
+        high_resolution_clock::duration time;
+        if(i == _sections.size()) time = frameTime;
+        else {
+            time = frame[i];
+            frameTime += time;
+        }
+
+        const std::uint64_t value = duration_cast<nanoseconds>(time).count();
+        ++_histogramData[i*HistogramBucketCount + histogramBucket(value)];
+        _histogramMax[i] = std::max(_histogramMax[i], value);
+    }
+
+    const std::uint64_t frameIndex = _histogramCount++;
+
+    /* Fill the spike storage first, then replace the fastest kept frame if
+       this one is slower. The frames are not kept sorted, as the capacity is
+       expected to be small. */
+    if(_spikes.empty()) return;
+    Spike* spike;
+    if(frameIndex < _spikes.size()) spike = &_spikes[frameIndex];
+    else {
+        spike = &*std::min_element(_spikes.begin(), _spikes.end(), [](const Spike& a, const Spike& b) {
+            return a.duration < b.duration;
+        });
+        if(frameTime <= spike->duration) return;
+    }
+
+    spike->frame = frameIndex;
+    spike->duration = frameTime;
+    std::copy(frame, frame + _sections.size(), spike->sections.begin());
+}
+
+#ifndef MAGNUM_TARGET_WEBGL
+void Profiler::beginGpuQuery() {
+    GpuFrame& frame = _gpuFrames[_currentGpuFrame];
+
+    /* Grow the query pool, if needed */
+    if(frame.count == frame.queries.size()) {
+        frame.queries.emplace_back(TimeQuery::Target::TimeElapsed);
+        frame.sections.emplace_back();
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    /* The statistics pool is grown separately, as it's cleared in enable()
+       in case the set of gathered statistics changed. Each query target can
+       have only one query active, but different targets can be active
+       together. */
+    const std::size_t statisticsCount = _pipelineStatistics.size();
+    if(frame.statisticsQueries.size() == frame.count*statisticsCount)
+        for(const PipelineStatisticsQuery::Target target: _pipelineStatistics)
+            frame.statisticsQueries.emplace_back(target);
+    for(std::size_t i = 0; i != statisticsCount; ++i)
+        frame.statisticsQueries[frame.count*statisticsCount + i].begin();
+    #endif
+
+    frame.queries[frame.count].begin();
+    frame.sections[frame.count] = _currentSection;
+    ++frame.count;
+    _gpuQueryRunning = true;
+}
+
+void Profiler::endGpuQuery() {
+    if(!_gpuQueryRunning) return;
+
+    GpuFrame& frame = _gpuFrames[_currentGpuFrame];
+    frame.queries[frame.count - 1].end();
+
+    #ifndef MAGNUM_TARGET_GLES
+    const std::size_t statisticsCount = _pipelineStatistics.size();
+    for(std::size_t i = 0; i != statisticsCount; ++i)
+        frame.statisticsQueries[(frame.count - 1)*statisticsCount + i].end();
+    #endif
+
+    _gpuQueryRunning = false;
+}
+
+void Profiler::readGpuFrame(GpuFrame& frame) {
+    if(!frame.count) return;
+
+    /* Add times of the frame to its slot. If the results are not available
+       yet, this blocks. */
+    const std::size_t offset = _currentGpuResultFrame*_sections.size();
+    for(std::size_t i = 0; i != frame.count; ++i)
+        _gpuFrameData[offset + frame.sections[i]] += duration_cast<high_resolution_clock::duration>(nanoseconds{frame.queries[i].result<UnsignedLong>()});
+
+    #ifndef MAGNUM_TARGET_GLES
+    /* Pipeline statistics are laid out as statistics of all sections for
+       each frame */
+    const std::size_t statisticsCount = _pipelineStatistics.size();
+    const std::size_t statisticsOffset = offset*statisticsCount;
+    for(std::size_t i = 0; i != frame.count; ++i)
+        for(std::size_t j = 0; j != statisticsCount; ++j)
+            _statisticsFrameData[statisticsOffset + frame.sections[i]*statisticsCount + j] += frame.statisticsQueries[i*statisticsCount + j].result<UnsignedLong>();
+    #endif
+
+    frame.count = 0;
+
+    /* Same as in nextFrame() */
+    std::size_t nextFrame = (_currentGpuResultFrame+1) % _measureDuration;
+    for(std::size_t i = 0; i != _sections.size(); ++i)
+        _gpuTotalData[i] += _gpuFrameData[offset+i];
+    for(std::size_t i = 0; i != _sections.size(); ++i) {
+        _gpuTotalData[i] -= _gpuFrameData[nextFrame*_sections.size()+i];
+        _gpuFrameData[nextFrame*_sections.size()+i] = high_resolution_clock::duration::zero();
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    const std::size_t statisticsSize = _sections.size()*statisticsCount;
+    for(std::size_t i = 0; i != statisticsSize; ++i)
+        _statisticsTotalData[i] += _statisticsFrameData[statisticsOffset + i];
+    for(std::size_t i = 0; i != statisticsSize; ++i) {
+        _statisticsTotalData[i] -= _statisticsFrameData[nextFrame*statisticsSize + i];
+        _statisticsFrameData[nextFrame*statisticsSize + i] = 0;
+    }
+    #endif
+
+    _currentGpuResultFrame = nextFrame;
+
+    if(_gpuResultFrameCount < _measureDuration) ++_gpuResultFrameCount;
+}
+#endif
+
+void Profiler::push(const Section section) {
+    if(!_enabled || !_captureCapacity) return;
+    CORRADE_ASSERT(section < _sections.size(), "Profiler: unknown section passed to push()", );
+
+    const auto now = high_resolution_clock::now();
+    std::lock_guard<std::mutex> lock{_captureMutex};
+    track().stack.emplace_back(section, now);
+}
+
+void Profiler::pop() {
+    if(!_enabled || !_captureCapacity) return;
+
+    const auto now = high_resolution_clock::now();
+    std::lock_guard<std::mutex> lock{_captureMutex};
+    Track& t = track();
+    CORRADE_ASSERT(!t.stack.empty(), "Profiler: pop() called without matching push()", );
+
+    const std::pair<Section, high_resolution_clock::time_point> scope = t.stack.back();
+    t.stack.pop_back();
+    record(scope.first, &t - _tracks.data(), t.stack.size() + 1, scope.second, now);
+}
+
+Profiler::Track& Profiler::track() {
+    const std::thread::id id = std::this_thread::get_id();
+    for(Track& t: _tracks) if(t.id == id) return t;
+
+    _tracks.push_back(Track{id, {}});
+    return _tracks.back();
+}
+
+void Profiler::record(const Section section, const UnsignedInt thread, const UnsignedInt depth, const high_resolution_clock::time_point begin, const high_resolution_clock::time_point end, const std::uint64_t allocationCount, const std::uint64_t allocatedBytes) {
+    const Sample sample{section, thread, depth, _captureFrame,
+        duration_cast<nanoseconds>(begin - _captureStart),
+        duration_cast<nanoseconds>(end - begin),
+        allocationCount, allocatedBytes};
+
+    /* Fill the buffer first, then overwrite the oldest samples */
+    if(_samples.size() < _captureCapacity) _samples.push_back(sample);
+    else {
+        _samples[_captureNext] = sample;
+        _captureNext = (_captureNext + 1) % _captureCapacity;
+    }
+}
+
+std::vector<Profiler::Sample> Profiler::capturedSamples() const {
+    std::lock_guard<std::mutex> lock{_captureMutex};
+
+    std::vector<Sample> samples;
+    samples.reserve(_samples.size());
+    samples.insert(samples.end(), _samples.begin() + _captureNext, _samples.end());
+    samples.insert(samples.end(), _samples.begin(), _samples.begin() + _captureNext);
+    return samples;
+}
+
+std::string Profiler::chromeTrace() const {
+    const std::vector<Sample> samples = capturedSamples();
+    std::size_t threadCount = 0;
+    for(const Sample& sample: samples)
+        threadCount = std::max(threadCount, std::size_t(sample.thread) + 1);
+
+    std::ostringstream out;
+    out << "{\"traceEvents\":[";
+
+    /* Thread names */
+    for(std::size_t i = 0; i != threadCount; ++i) {
+        if(i) out << ',';
+        out << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << i << ",\"args\":{\"name\":\"Thread " << i << "\"}}";
+    }
+
+    /* One complete event per sample */
+    for(const Sample& sample: samples) {
+        out << ",\n{\"name\":";
+        writeJsonString(out, _sections[sample.section]);
+        out << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << sample.thread << ",\"ts\":";
+        writeMicroseconds(out, sample.begin);
+        out << ",\"dur\":";
+        writeMicroseconds(out, sample.duration);
+        out << ",\"args\":{\"frame\":" << sample.frame << ",\"depth\":" << sample.depth;
+        if(_allocationTrackingEnabled)
+            out << ",\"allocations\":" << sample.allocationCount << ",\"allocatedBytes\":" << sample.allocatedBytes;
+        out << "}}";
+    }
+
+    out << "\n]}\n";
+    return out.str();
+}
+
+std::string Profiler::csv() const {
+    std::ostringstream out;
+    out << "frame,thread,depth,section,begin,duration";
+    if(_allocationTrackingEnabled) out << ",allocations,allocatedBytes";
+    out << '\n';
+    for(const Sample& sample: capturedSamples()) {
+        out << sample.frame << ',' << sample.thread << ',' << sample.depth << ',';
+        writeCsvString(out, _sections[sample.section]);
+        out << ',' << sample.begin.count() << ',' << sample.duration.count();
+        if(_allocationTrackingEnabled)
+            out << ',' << sample.allocationCount << ',' << sample.allocatedBytes;
+        out << '\n';
+    }
+
+    return out.str();
+}
+
+high_resolution_clock::duration Profiler::time(const Section section) const {
+    CORRADE_ASSERT(section < _sections.size(), "Profiler: unknown section passed to time()", {});
+    if(!_frameCount || _totalData.empty()) return high_resolution_clock::duration::zero();
+    return _totalData[section]/_frameCount;
+}
+
+high_resolution_clock::duration Profiler::histogramPercentile(const std::size_t histogram, const Double percentile) const {
+    if(!_histogramCount || _histogramData.empty()) return high_resolution_clock::duration::zero();
+
+    /* Smallest value that has at least given percentage of the values below
+       or equal to it */
+    const std::uint64_t target = std::max(std::uint64_t(1), std::uint64_t(std::ceil(percentile/100.0*_histogramCount)));
+    const UnsignedInt* const counts = _histogramData.data() + histogram*HistogramBucketCount;
+    std::uint64_t sum = 0;
+    std::size_t bucket = 0;
+    for(; bucket != HistogramBucketCount - 1; ++bucket) {
+        sum += counts[bucket];
+        if(sum >= target) break;
+    }
+
+    return duration_cast<high_resolution_clock::duration>(nanoseconds{std::min(histogramBucketMax(bucket), _histogramMax[histogram])});
+}
+
+high_resolution_clock::duration Profiler::percentile(const Section section, const Double percentile) const {
+    CORRADE_ASSERT(section < _sections.size(), "Profiler: unknown section passed to percentile()", {});
+    CORRADE_ASSERT(percentile >= 0.0 && percentile <= 100.0, "Profiler::percentile(): expected percentile in range [0, 100], got" << percentile, {});
+    return histogramPercentile(section, percentile);
+}
+
+high_resolution_clock::duration Profiler::maxTime(const Section section) const {
+    CORRADE_ASSERT(section < _sections.size(), "Profiler: unknown section passed to maxTime()", {});
+    if(_histogramMax.empty()) return high_resolution_clock::duration::zero();
+    return duration_cast<high_resolution_clock::duration>(nanoseconds{_histogramMax[section]});
+}
+
+high_resolution_clock::duration Profiler::framePercentile(const Double percentile) const {
+    CORRADE_ASSERT(percentile >= 0.0 && percentile <= 100.0, "Profiler::framePercentile(): expected percentile in range [0, 100], got" << percentile, {});
+    return histogramPercentile(_sections.size(), percentile);
+}
+
+high_resolution_clock::duration Profiler::maxFrameTime() const {
+    if(_histogramMax.empty()) return high_resolution_clock::duration::zero();
+    return duration_cast<high_resolution_clock::duration>(nanoseconds{_histogramMax.back()});
+}
+
+std::vector<Profiler::Spike> Profiler::spikes() const {
+    std::vector<Spike> spikes{_spikes.begin(), _spikes.begin() + std::min(std::uint64_t(_spikes.size()), _histogramCount)};
+    std::sort(spikes.begin(), spikes.end(), [](const Spike& a, const Spike& b) {
+        return a.duration > b.duration;
+    });
+    return spikes;
+}
+
+#ifndef MAGNUM_TARGET_WEBGL
+high_resolution_clock::duration Profiler::gpuTime(const Section section) const {
+    CORRADE_ASSERT(section < _sections.size(), "Profiler: unknown section passed to gpuTime()", {});
+    if(!_gpuResultFrameCount || _gpuTotalData.empty()) return high_resolution_clock::duration::zero();
+    return _gpuTotalData[section]/_gpuResultFrameCount;
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES
+Double Profiler::pipelineStatistic(const Section section, const PipelineStatisticsQuery::Target target) const {
+    CORRADE_ASSERT(section < _sections.size(), "Profiler: unknown section passed to pipelineStatistic()", {});
+    const auto found = std::find(_pipelineStatistics.begin(), _pipelineStatistics.end(), target);
+    if(!_gpuResultFrameCount || _statisticsTotalData.empty() || found == _pipelineStatistics.end()) return 0.0;
+    return Double(_statisticsTotalData[section*_pipelineStatistics.size() + (found - _pipelineStatistics.begin())])/_gpuResultFrameCount;
+}
+#endif
+
+Double Profiler::counter(const Instrumentation::Counter counter) const {
+    if(!_frameCount || _counterTotalData.empty()) return 0.0;
+    return Double(_counterTotalData[UnsignedByte(counter)])/_frameCount;
+}
+
+Double Profiler::allocationCount(const Section section) const {
+    CORRADE_ASSERT(section < _sections.size(), "Profiler: unknown section passed to allocationCount()", {});
+    if(!_frameCount || _allocationTotalData.empty()) return 0.0;
+    return Double(_allocationTotalData[section*2])/_frameCount;
+}
+
+Double Profiler::allocatedBytes(const Section section) const {
+    CORRADE_ASSERT(section < _sections.size(), "Profiler: unknown section passed to allocatedBytes()", {});
+    if(!_frameCount || _allocationTotalData.empty()) return 0.0;
+    return Double(_allocationTotalData[section*2 + 1])/_frameCount;
+}
+
+void Profiler::InstrumentationListener::zoneBegin(const Instrumentation::Zone zone) {
+    _profiler.push(_profiler._instrumentationSections + UnsignedByte(zone));
+}
+
+void Profiler::InstrumentationListener::zoneEnd(Instrumentation::Zone) {
+    _profiler.pop();
 }
 
 void Profiler::printStatistics() {
@@ -117,8 +784,44 @@ void Profiler::printStatistics() {
     std::sort(totalSorted.begin(), totalSorted.end(), [this](std::size_t i, std::size_t j){return _totalData[i] > _totalData[j];});
 
     Debug() << "Statistics for last" << _measureDuration << "frames:";
-    for(std::size_t i = 0; i != _sections.size(); ++i)
-        Debug() << " " << _sections[totalSorted[i]] << duration_cast<microseconds>(_totalData[totalSorted[i]]).count()/_frameCount << u8"µs";
+    for(std::size_t i = 0; i != _sections.size(); ++i) {
+        Debug d;
+        d << " " << _sections[totalSorted[i]] << duration_cast<microseconds>(time(totalSorted[i])).count() << u8"µs";
+        d << Debug::nospace << ", p50" << duration_cast<microseconds>(percentile(totalSorted[i], 50.0)).count() << Debug::nospace << u8"µs, p90" << duration_cast<microseconds>(percentile(totalSorted[i], 90.0)).count() << Debug::nospace << u8"µs, p99" << duration_cast<microseconds>(percentile(totalSorted[i], 99.0)).count() << Debug::nospace << u8"µs, max" << duration_cast<microseconds>(maxTime(totalSorted[i])).count() << u8"µs";
+
+        #ifndef MAGNUM_TARGET_WEBGL
+        if(_gpuEnabled)
+            d << Debug::nospace << ", GPU" << duration_cast<microseconds>(gpuTime(totalSorted[i])).count() << u8"µs";
+        #endif
+
+        #ifndef MAGNUM_TARGET_GLES
+        if(_gpuEnabled) for(const PipelineStatisticsQuery::Target target: _pipelineStatistics)
+            d << Debug::nospace << "," << pipelineStatisticName(target) << pipelineStatistic(totalSorted[i], target);
+        #endif
+
+        if(_allocationTrackingEnabled)
+            d << Debug::nospace << "," << allocationCount(totalSorted[i]) << "allocations," << allocatedBytes(totalSorted[i]) << "bytes";
+    }
+
+    Debug() << "Frame time since enabled: p50" << duration_cast<microseconds>(framePercentile(50.0)).count() << Debug::nospace << u8"µs, p90" << duration_cast<microseconds>(framePercentile(90.0)).count() << Debug::nospace << u8"µs, p99" << duration_cast<microseconds>(framePercentile(99.0)).count() << Debug::nospace << u8"µs, max" << duration_cast<microseconds>(maxFrameTime()).count() << u8"µs";
+
+    if(!_spikes.empty()) {
+        Debug() << "Slowest frames:";
+        for(const Spike& spike: spikes()) {
+            Debug d;
+            d << "  frame" << spike.frame << Debug::nospace << ":" << duration_cast<microseconds>(spike.duration).count() << u8"µs";
+            for(std::size_t i = 0; i != _sections.size(); ++i) {
+                if(spike.sections[i] == high_resolution_clock::duration::zero()) continue;
+                d << Debug::nospace << "," << _sections[i] << duration_cast<microseconds>(spike.sections[i]).count() << u8"µs";
+            }
+        }
+    }
+
+    if(_instrumentationEnabled) {
+        Debug() << "Average per frame:";
+        for(std::size_t i = 0; i != Instrumentation::CounterCount; ++i)
+            Debug() << " " << InstrumentationCounterNames[i] << counter(Instrumentation::Counter(i));
+    }
 }
 
 }}
@@ -30,13 +30,24 @@
  */
 
 #include <chrono>
+#include <cstdint>
 #include <initializer_list>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include "Magnum/Instrumentation.h"
 #include "Magnum/Types.h"
 #include "Magnum/DebugTools/visibility.h"
 
+#ifndef MAGNUM_TARGET_WEBGL
+#include "Magnum/TimeQuery.h"
+#endif
+#ifndef MAGNUM_TARGET_GLES
+#include "Magnum/PipelineStatisticsQuery.h"
+#endif
+
 namespace Magnum { namespace DebugTools {
 
 /**
@@ -96,7 +107,123 @@ p.printStatistics();
 It's possible to start profiler only for certain parts of the code and then
 stop it again using @ref stop(), if you are not interested in profiling the rest.
 
-@todo Some unit testing
+@section DebugTools-Profiler-gpu GPU profiling
+
+The CPU time doesn't tell whether the frame is limited by the CPU or by the
+GPU, as most OpenGL calls only queue the commands. Calling
+@ref setGpuProfilingEnabled() before enabling the profiler makes it
+additionally measure GPU time spent by commands issued in each section using
+a pool of @ref TimeQuery objects. The query results are read back with a
+latency of a few frames (see @ref setGpuLatency()) to avoid stalling the
+pipeline and are printed next to the CPU times in @ref printStatistics().
+@code
+p.setGpuProfilingEnabled(true);
+p.enable();
+@endcode
+
+On desktop GL with @extension{ARB,pipeline_statistics_query}, the GPU
+profiling can additionally gather @ref PipelineStatisticsQuery counts for
+each section, such as vertex and fragment shader invocations or primitives
+culled by clipping. They are read back with the same latency as the GPU
+times and printed next to them:
+@code
+p.setGpuProfilingEnabled(true);
+p.setPipelineStatistics({PipelineStatisticsQuery::Target::VerticesSubmitted,
+                         PipelineStatisticsQuery::Target::FragmentShaderInvocations});
+p.enable();
+@endcode
+
+@section DebugTools-Profiler-capture Capturing and exporting raw samples
+
+Calling @ref setCaptureCapacity() before enabling the profiler makes it keep
+individual samples of the last few thousand section runs in a ring buffer, in
+addition to the averaged statistics. Besides the sections marked with
+@ref start(), the capture can contain also nested scopes marked with
+@ref push() and @ref pop() (or the @ref ScopedSection helper), which can be
+used from any thread. Each thread gets its own track. The captured samples can
+be exported using @ref chromeTrace() to a format understood by
+`chrome://tracing` and Perfetto or using @ref csv() for further processing:
+@code
+p.setCaptureCapacity(100000);
+p.enable();
+
+// on a worker thread
+{
+    DebugTools::Profiler::ScopedSection scope{p, sections.physics};
+    // ...
+}
+
+// ...
+
+Utility::Directory::writeString("trace.json", p.chromeTrace());
+@endcode
+
+Nested scopes contribute only to the captured samples, not to the averaged
+statistics printed by @ref printStatistics(), as they can overlap each other.
+
+@section DebugTools-Profiler-instrumentation Library instrumentation
+
+If the library is built with @ref MAGNUM_BUILD_INSTRUMENTATION, calling
+@ref setInstrumentationEnabled() before enabling the profiler makes it listen
+to @ref Instrumentation zones in library hot paths such as @ref Mesh::draw()
+and record them as nested scopes on the captured tracks. Besides that, the
+per-frame @ref Instrumentation::Counter "instrumentation counters" such as draw
+call count or count of uploaded bytes are averaged over the measured frames
+and printed by @ref printStatistics():
+@code
+p.setCaptureCapacity(100000);
+p.setInstrumentationEnabled(true);
+p.enable();
+@endcode
+
+@section DebugTools-Profiler-percentiles Percentiles and spikes
+
+Averages hide occasional stutters. Besides them, the profiler keeps a
+histogram of per-frame times of each section and of whole frames since the
+profiling was enabled, which can be queried using @ref percentile(),
+@ref framePercentile(), @ref maxTime() and @ref maxFrameTime(). The
+histograms have a fixed size of a few kilobytes per section with a
+resolution of about 3 %, so recording them is cheap enough to be left on in
+production builds. The 50th, 90th and 99th percentile and the max is printed
+by @ref printStatistics().
+
+Calling @ref setSpikeCapacity() before enabling the profiler makes it
+additionally keep the per-section breakdown of given count of the slowest
+frames, available through @ref spikes():
+@code
+p.setSpikeCapacity(5);
+p.enable();
+
+// ...
+
+for(const DebugTools::Profiler::Spike& spike: p.spikes())
+    Debug() << "Frame" << spike.frame << "took" << spike.duration.count();
+@endcode
+
+@section DebugTools-Profiler-allocations Allocation tracking
+
+To find frame spikes caused by heap allocations, include
+@ref Magnum/DebugTools/AllocationHooks.h in exactly one source file of the
+application. It replaces the global `operator new` and `operator delete`
+with implementations that count the allocations. Calling
+@ref setAllocationTrackingEnabled() before enabling the profiler then makes
+it attribute count and size of the allocations to the sections marked with
+@ref start(). The per-frame averages are printed by @ref printStatistics()
+and captured samples of these sections contain the allocations made during
+them:
+@code
+// in main.cpp
+#include <Magnum/DebugTools/AllocationHooks.h>
+
+// ...
+p.setAllocationTrackingEnabled(true);
+p.enable();
+@endcode
+
+Allocations from all threads are attributed to the current section. Nested
+scopes marked with @ref push() don't contribute to allocation statistics,
+same as with times.
+
 @todo More time intervals
 */
 class MAGNUM_DEBUGTOOLS_EXPORT Profiler {
@@ -115,7 +242,232 @@ class MAGNUM_DEBUGTOOLS_EXPORT Profiler {
          */
         static const Section otherSection = 0;
 
-        explicit Profiler(): _enabled(false), _measureDuration(60), _currentFrame(0), _frameCount(0), _sections{"Other"}, _currentSection(otherSection) {}
+        /**
+         * @brief Captured sample
+         *
+         * @see @ref setCaptureCapacity(), @ref capturedSamples()
+         */
+        struct Sample {
+            /** @brief Section */
+            Section section;
+
+            /**
+             * @brief Thread track
+             *
+             * Threads are numbered in order of their first captured sample.
+             */
+            UnsignedInt thread;
+
+            /**
+             * @brief Nesting depth
+             *
+             * `0` for sections marked with @ref start(), `1` and more for
+             * scopes marked with @ref push().
+             */
+            UnsignedInt depth;
+
+            /** @brief Frame index since profiling was enabled */
+            std::uint64_t frame;
+
+            /** @brief Begin time since profiling was enabled */
+            std::chrono::nanoseconds begin;
+
+            /** @brief Duration */
+            std::chrono::nanoseconds duration;
+
+            /**
+             * @brief Count of heap allocations during the sample
+             *
+             * Non-zero only for sections marked with @ref start() if
+             * allocation tracking is enabled.
+             * @see @ref setAllocationTrackingEnabled()
+             */
+            std::uint64_t allocationCount;
+
+            /**
+             * @brief Bytes allocated on heap during the sample
+             *
+             * Non-zero only for sections marked with @ref start() if
+             * allocation tracking is enabled.
+             * @see @ref setAllocationTrackingEnabled()
+             */
+            std::uint64_t allocatedBytes;
+        };
+
+        /**
+         * @brief Slow frame snapshot
+         *
+         * @see @ref setSpikeCapacity(), @ref spikes()
+         */
+        struct Spike {
+            /** @brief Frame index since profiling was enabled */
+            std::uint64_t frame;
+
+            /** @brief Frame duration */
+            std::chrono::high_resolution_clock::duration duration;
+
+            /** @brief Time spent in each section during the frame */
+            std::vector<std::chrono::high_resolution_clock::duration> sections;
+        };
+
+        /**
+         * @brief Scoped nested section
+         *
+         * Calls @ref push() on construction and @ref pop() on destruction.
+         */
+        class ScopedSection {
+            public:
+                /** @brief Constructor */
+                explicit ScopedSection(Profiler& profiler, Section section): _profiler(profiler) {
+                    _profiler.push(section);
+                }
+
+                /** @brief Copying is not allowed */
+                ScopedSection(const ScopedSection&) = delete;
+
+                /** @brief Destructor */
+                ~ScopedSection() { _profiler.pop(); }
+
+                /** @brief Copying is not allowed */
+                ScopedSection& operator=(const ScopedSection&) = delete;
+
+            private:
+                Profiler& _profiler;
+        };
+
+        explicit Profiler(): _enabled(false), _measureDuration(60), _currentFrame(0), _frameCount(0), _sections{"Other"}, _currentSection(otherSection), _instrumentationListener{*this} {}
+
+        /**
+         * @brief Destructor
+         *
+         * Resets the current @ref Instrumentation::listener() if it's this
+         * profiler.
+         */
+        ~Profiler();
+
+        #ifndef MAGNUM_TARGET_WEBGL
+        /**
+         * @brief Whether GPU profiling is enabled
+         *
+         * @see @ref setGpuProfilingEnabled()
+         */
+        bool isGpuProfilingEnabled() const { return _gpuEnabled; }
+
+        /**
+         * @brief Enable or disable GPU profiling
+         *
+         * If enabled, GPU time spent in each section is measured using
+         * @ref TimeQuery::Target::TimeElapsed queries in addition to CPU
+         * time. Requires an active OpenGL context. Disabled by default.
+         * @attention This function cannot be called if profiling is enabled.
+         * @see @ref setGpuLatency(), @ref gpuTime()
+         * @requires_gl33 Extension @extension{ARB,timer_query}
+         * @requires_es_extension Extension @extension{EXT,disjoint_timer_query}
+         * @requires_gles Time queries are not available in WebGL.
+         */
+        void setGpuProfilingEnabled(bool enabled);
+
+        /** @brief GPU query latency */
+        std::size_t gpuLatency() const { return _gpuLatency; }
+
+        /**
+         * @brief Set GPU query latency
+         *
+         * Query results of a frame are read back after given count of
+         * frames. If they aren't available at that point, the profiler waits
+         * for them. Default value is 3.
+         * @attention This function cannot be called if profiling is enabled.
+         */
+        void setGpuLatency(std::size_t frames);
+        #endif
+
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Gathered pipeline statistics
+         *
+         * @see @ref setPipelineStatistics()
+         */
+        const std::vector<PipelineStatisticsQuery::Target>& pipelineStatistics() const { return _pipelineStatistics; }
+
+        /**
+         * @brief Set pipeline statistics to gather
+         *
+         * If non-empty and GPU profiling is enabled, given statistics are
+         * measured for each section using @ref PipelineStatisticsQuery
+         * objects alongside the GPU time. Empty by default.
+         * @attention This function cannot be called if profiling is enabled.
+         * @see @ref setGpuProfilingEnabled(), @ref pipelineStatistic()
+         * @requires_extension Extension @extension{ARB,pipeline_statistics_query}
+         * @requires_gl Pipeline statistics queries are not available in
+         *      OpenGL ES and WebGL.
+         */
+        void setPipelineStatistics(std::vector<PipelineStatisticsQuery::Target> targets);
+        #endif
+
+        /**
+         * @brief Whether library instrumentation is enabled
+         *
+         * @see @ref setInstrumentationEnabled()
+         */
+        bool isInstrumentationEnabled() const { return _instrumentationEnabled; }
+
+        /**
+         * @brief Enable or disable library instrumentation
+         *
+         * If enabled, the profiler adds one section for each
+         * @ref Instrumentation::Zone, becomes the current
+         * @ref Instrumentation::listener() while profiling is enabled and
+         * averages the @ref Instrumentation::counter() "instrumentation counters"
+         * over the measured frames. The zones are recorded as nested scopes,
+         * see @ref setCaptureCapacity(). Disabled by default. Has no effect
+         * if the library is not built with @ref MAGNUM_BUILD_INSTRUMENTATION.
+         * @attention This function cannot be called if profiling is enabled.
+         * @see @ref instrumentationSection(), @ref counter()
+         */
+        void setInstrumentationEnabled(bool enabled);
+
+        /**
+         * @brief Section for given instrumentation zone
+         *
+         * Expects that library instrumentation is enabled and profiling was
+         * enabled at least once.
+         * @see @ref setInstrumentationEnabled()
+         */
+        Section instrumentationSection(Instrumentation::Zone zone) const;
+
+        /**
+         * @brief Whether allocation tracking is enabled
+         *
+         * @see @ref setAllocationTrackingEnabled()
+         */
+        bool isAllocationTrackingEnabled() const { return _allocationTrackingEnabled; }
+
+        /**
+         * @brief Enable or disable allocation tracking
+         *
+         * If enabled, count and size of heap allocations is attributed to
+         * the sections marked with @ref start() and averaged over the
+         * measured frames. Disabled by default. Has effect only if
+         * @ref Magnum/DebugTools/AllocationHooks.h is included in the
+         * application, otherwise no allocations are counted.
+         * @attention This function cannot be called if profiling is enabled.
+         * @see @ref allocationCount(), @ref allocatedBytes()
+         */
+        void setAllocationTrackingEnabled(bool enabled);
+
+        /** @brief Count of slowest frames to keep */
+        std::size_t spikeCapacity() const { return _spikeCapacity; }
+
+        /**
+         * @brief Set count of slowest frames to keep
+         *
+         * If non-zero, the per-section breakdown of given count of slowest
+         * frames since the profiling was enabled is kept in a preallocated
+         * storage. Default is `0`, i.e. no spike snapshots.
+         * @attention This function cannot be called if profiling is enabled.
+         * @see @ref spikes()
+         */
+        void setSpikeCapacity(std::size_t count);
 
         /**
          * @brief Set measure duration
@@ -134,6 +486,23 @@ class MAGNUM_DEBUGTOOLS_EXPORT Profiler {
          */
         Section addSection(const std::string& name);
 
+        /**
+         * @brief Section name
+         *
+         * Expects that the section exists.
+         * @see @ref addSection()
+         */
+        const std::string& sectionName(Section section) const;
+
+        /**
+         * @brief Current section
+         *
+         * Innermost scope entered with @ref push() on the calling thread if
+         * there is any, the section marked with last @ref start() otherwise.
+         * If profiling is disabled, returns @ref otherSection.
+         */
+        Section currentSection() const;
+
         /**
          * @brief Whether profiling is enabled
          *
@@ -198,8 +567,213 @@ class MAGNUM_DEBUGTOOLS_EXPORT Profiler {
          */
         void printStatistics();
 
+        /** @brief Capacity of the sample capture */
+        std::size_t captureCapacity() const { return _captureCapacity; }
+
+        /**
+         * @brief Set capacity of the sample capture
+         *
+         * If non-zero, individual samples are captured in a ring buffer of
+         * given size, discarding the oldest ones when full. Default is `0`,
+         * i.e. no capture.
+         * @attention This function cannot be called if profiling is enabled.
+         * @see @ref capturedSamples(), @ref chromeTrace(), @ref csv()
+         */
+        void setCaptureCapacity(std::size_t samples);
+
+        /**
+         * @brief Begin a nested scope
+         *
+         * Begins a scope on the calling thread, which ends with a matching
+         * @ref pop() call. Scopes can be nested and this function can be
+         * called from any thread. The scope is recorded only if the
+         * capture is enabled.
+         * @note Does nothing if profiling is disabled.
+         * @see @ref ScopedSection, @ref setCaptureCapacity()
+         */
+        void push(Section section);
+
+        /**
+         * @brief End a nested scope
+         *
+         * Expects a matching @ref push() call on the same thread.
+         * @note Does nothing if profiling is disabled.
+         */
+        void pop();
+
+        /**
+         * @brief Captured samples
+         *
+         * Returns samples currently in the capture ring buffer, ordered by
+         * time of their end. Empty if the capture is disabled.
+         */
+        std::vector<Sample> capturedSamples() const;
+
+        /**
+         * @brief Captured samples as Chrome trace
+         *
+         * Returns the samples in Trace Event JSON format, with one complete
+         * event per sample and one track per thread. Can be opened in
+         * `chrome://tracing` and Perfetto.
+         * @see @ref capturedSamples(), @ref csv()
+         */
+        std::string chromeTrace() const;
+
+        /**
+         * @brief Captured samples as CSV
+         *
+         * Returns the samples with a header row and columns `frame`,
+         * `thread`, `depth`, `section`, `begin` and `duration`, times in
+         * nanoseconds.
+         * @see @ref capturedSamples(), @ref chromeTrace()
+         */
+        std::string csv() const;
+
+        /**
+         * @brief Average CPU time spent in given section
+         *
+         * Averaged over the last @ref setMeasureDuration() "measured" frames.
+         * @see @ref gpuTime()
+         */
+        std::chrono::high_resolution_clock::duration time(Section section) const;
+
+        #ifndef MAGNUM_TARGET_WEBGL
+        /**
+         * @brief Average GPU time spent in given section
+         *
+         * Averaged over the last @ref setMeasureDuration() "measured" frames
+         * for which the GPU query results were already read back. Zero if
+         * GPU profiling is not enabled.
+         * @see @ref setGpuProfilingEnabled(), @ref time()
+         */
+        std::chrono::high_resolution_clock::duration gpuTime(Section section) const;
+        #endif
+
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Average per-frame pipeline statistic in given section
+         *
+         * Averaged over the same frames as @ref gpuTime(). Zero if GPU
+         * profiling is not enabled or @p target is not in the
+         * @ref setPipelineStatistics() "gathered statistics".
+         */
+        Double pipelineStatistic(Section section, PipelineStatisticsQuery::Target target) const;
+        #endif
+
+        /**
+         * @brief Percentile of per-frame CPU time spent in given section
+         * @param section       Section
+         * @param percentile    Percentile in range @f$ [0, 100] @f$
+         *
+         * Calculated over all frames since profiling was enabled with a
+         * resolution of about 3 %. Zero if no frame was finished yet.
+         * @see @ref maxTime(), @ref framePercentile(), @ref time()
+         */
+        std::chrono::high_resolution_clock::duration percentile(Section section, Double percentile) const;
+
+        /**
+         * @brief Max per-frame CPU time spent in given section
+         *
+         * Since profiling was enabled. Zero if no frame was finished yet.
+         * @see @ref percentile()
+         */
+        std::chrono::high_resolution_clock::duration maxTime(Section section) const;
+
+        /**
+         * @brief Percentile of frame time
+         * @param percentile    Percentile in range @f$ [0, 100] @f$
+         *
+         * Frame time is the sum of all sections in the frame. Calculated
+         * over all frames since profiling was enabled with a resolution of
+         * about 3 %. Zero if no frame was finished yet.
+         * @see @ref maxFrameTime(), @ref percentile()
+         */
+        std::chrono::high_resolution_clock::duration framePercentile(Double percentile) const;
+
+        /**
+         * @brief Max frame time
+         *
+         * Since profiling was enabled. Zero if no frame was finished yet.
+         * @see @ref framePercentile()
+         */
+        std::chrono::high_resolution_clock::duration maxFrameTime() const;
+
+        /**
+         * @brief Snapshots of slowest frames
+         *
+         * Ordered from the slowest. Contains at most @ref spikeCapacity()
+         * frames, empty if spike snapshots are disabled.
+         * @see @ref setSpikeCapacity()
+         */
+        std::vector<Spike> spikes() const;
+
+        /**
+         * @brief Average per-frame value of given instrumentation counter
+         *
+         * Averaged over the last @ref setMeasureDuration() "measured" frames.
+         * Zero if library instrumentation is not enabled.
+         * @see @ref setInstrumentationEnabled()
+         */
+        Double counter(Instrumentation::Counter counter) const;
+
+        /**
+         * @brief Average per-frame count of heap allocations in given section
+         *
+         * Averaged over the last @ref setMeasureDuration() "measured" frames.
+         * Zero if allocation tracking is not enabled.
+         * @see @ref setAllocationTrackingEnabled(), @ref allocatedBytes()
+         */
+        Double allocationCount(Section section) const;
+
+        /**
+         * @brief Average per-frame count of bytes allocated on heap in given section
+         *
+         * Averaged over the last @ref setMeasureDuration() "measured" frames.
+         * Zero if allocation tracking is not enabled.
+         * @see @ref setAllocationTrackingEnabled(), @ref allocationCount()
+         */
+        Double allocatedBytes(Section section) const;
+
     private:
+        #ifndef MAGNUM_TARGET_WEBGL
+        struct GpuFrame {
+            std::vector<TimeQuery> queries;
+            #ifndef MAGNUM_TARGET_GLES
+            /* Pipeline statistics queries for each time query, one for each
+               gathered statistic */
+            std::vector<PipelineStatisticsQuery> statisticsQueries;
+            #endif
+            std::vector<Section> sections;
+            std::size_t count;
+        };
+        #endif
+
+        class InstrumentationListener: public Instrumentation::AbstractListener {
+            public:
+                explicit InstrumentationListener(Profiler& profiler): _profiler(profiler) {}
+
+                void zoneBegin(Instrumentation::Zone zone) override;
+                void zoneEnd(Instrumentation::Zone zone) override;
+
+            private:
+                Profiler& _profiler;
+        };
+
+        struct Track {
+            std::thread::id id;
+            std::vector<std::pair<Section, std::chrono::high_resolution_clock::time_point>> stack;
+        };
+
         void save();
+        void recordFrame();
+        std::chrono::high_resolution_clock::duration histogramPercentile(std::size_t histogram, Double percentile) const;
+        Track& track();
+        void record(Section section, UnsignedInt thread, UnsignedInt depth, std::chrono::high_resolution_clock::time_point begin, std::chrono::high_resolution_clock::time_point end, std::uint64_t allocationCount = 0, std::uint64_t allocatedBytes = 0);
+        #ifndef MAGNUM_TARGET_WEBGL
+        void beginGpuQuery();
+        void endGpuQuery();
+        void readGpuFrame(GpuFrame& frame);
+        #endif
 
         bool _enabled;
         std::size_t _measureDuration, _currentFrame, _frameCount;
@@ -208,8 +782,59 @@ class MAGNUM_DEBUGTOOLS_EXPORT Profiler {
         std::vector<std::chrono::high_resolution_clock::duration> _totalData;
         std::chrono::high_resolution_clock::time_point _previousTime;
         Section _currentSection;
+
+        /* Capture state is guarded by the mutex, as nested scopes can be
+           used from any thread */
+        mutable std::mutex _captureMutex;
+        std::size_t _captureCapacity{0}, _captureNext{0};
+        std::uint64_t _captureFrame{0};
+        std::chrono::high_resolution_clock::time_point _captureStart;
+        std::vector<Sample> _samples;
+        std::vector<Track> _tracks;
+
+        bool _instrumentationEnabled{false};
+        Section _instrumentationSections{0};
+        InstrumentationListener _instrumentationListener;
+        std::vector<std::uint64_t> _counterFrameData;
+        std::vector<std::uint64_t> _counterTotalData;
+
+        /* Histogram of per-frame nanoseconds for each section plus one for
+           the whole frame, with max and count of recorded values */
+        std::vector<UnsignedInt> _histogramData;
+        std::vector<std::uint64_t> _histogramMax;
+        std::uint64_t _histogramCount{0};
+
+        /* Slowest frames, in no particular order */
+        std::size_t _spikeCapacity{0};
+        std::vector<Spike> _spikes;
+
+        /* Allocation count and bytes for each section, interleaved */
+        bool _allocationTrackingEnabled{false};
+        std::uint64_t _previousAllocationCount{0}, _previousAllocatedBytes{0};
+        std::vector<std::uint64_t> _allocationFrameData;
+        std::vector<std::uint64_t> _allocationTotalData;
+
+        #ifndef MAGNUM_TARGET_WEBGL
+        bool _gpuEnabled{false}, _gpuQueryRunning{false};
+        std::size_t _gpuLatency{3}, _currentGpuFrame{0}, _currentGpuResultFrame{0}, _gpuResultFrameCount{0};
+        std::vector<GpuFrame> _gpuFrames;
+        std::vector<std::chrono::high_resolution_clock::duration> _gpuFrameData;
+        std::vector<std::chrono::high_resolution_clock::duration> _gpuTotalData;
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        std::vector<PipelineStatisticsQuery::Target> _pipelineStatistics;
+        std::vector<UnsignedLong> _statisticsFrameData;
+        std::vector<UnsignedLong> _statisticsTotalData;
+        #endif
 };
 
+#ifndef DOXYGEN_GENERATING_OUTPUT
+namespace Implementation {
+    /* Called by the hooks in AllocationHooks.h */
+    MAGNUM_DEBUGTOOLS_EXPORT void recordAllocation(std::size_t size) noexcept;
+}
+#endif
+
 }}
 
 #endif
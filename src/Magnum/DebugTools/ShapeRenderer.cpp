@@ -42,6 +42,15 @@ namespace Magnum { namespace DebugTools {
 
 namespace Implementation {
 
+namespace {
+    /* Shared by all renderers to avoid reallocating the batches every
+       frame */
+    template<UnsignedInt dimensions> ShapeInstances<dimensions>& shapeInstances() {
+        static ShapeInstances<dimensions> instances;
+        return instances;
+    }
+}
+
 template<> void createDebugMesh(ShapeRenderer<2>& renderer, const Shapes::Implementation::AbstractShape<2>& shape) {
     switch(shape.type()) {
         case Shapes::AbstractShape2D::Type::AxisAlignedBox:
@@ -122,9 +131,28 @@ template<UnsignedInt dimensions> ShapeRenderer<dimensions>::~ShapeRenderer() {
     for(auto i: _renderers) delete i;
 }
 
+template<UnsignedInt dimensions> void ShapeRenderer<dimensions>::drawInstanced(SceneGraph::DrawableGroup<dimensions, Float>& drawables, SceneGraph::Camera<dimensions, Float>& camera) {
+    /* Compute camera matrix */
+    camera.object().setClean();
+
+    Implementation::ShapeInstances<dimensions>& instances = Implementation::shapeInstances<dimensions>();
+    for(std::size_t i = 0; i != drawables.size(); ++i) {
+        auto renderer = dynamic_cast<ShapeRenderer<dimensions>*>(&drawables[i]);
+        if(!renderer) continue;
+
+        for(auto r: renderer->_renderers) r->collect(renderer->_options, instances);
+    }
+
+    instances.drawInstanced(camera.projectionMatrix()*camera.cameraMatrix());
+    instances.clear();
+}
+
 template<UnsignedInt dimensions> void ShapeRenderer<dimensions>::draw(const MatrixTypeFor<dimensions, Float>&, SceneGraph::Camera<dimensions, Float>& camera) {
-    const MatrixTypeFor<dimensions, Float> projectionMatrix = camera.projectionMatrix()*camera.cameraMatrix();
-    for(auto i: _renderers) i->draw(_options, projectionMatrix);
+    Implementation::ShapeInstances<dimensions>& instances = Implementation::shapeInstances<dimensions>();
+    for(auto i: _renderers) i->collect(_options, instances);
+
+    instances.draw(camera.projectionMatrix()*camera.cameraMatrix());
+    instances.clear();
 }
 
 template class ShapeRenderer<2>;
@@ -134,6 +134,18 @@ Shapes::AbstractShape2D* shape;
 new DebugTools::ShapeRenderer2D(shape, "red", debugDrawables);
 @endcode
 
+@anchor DebugTools-ShapeRenderer-instancing
+## Instanced drawing
+
+Drawing the group with @ref SceneGraph::Camera::draw() issues a separate
+draw call for every visualized shape. With many shapes it's better to draw
+the group with @ref drawInstanced() instead, which gathers transformations and
+colors of all shapes and draws all shapes of the same kind using a single
+instanced draw call:
+@code
+DebugTools::ShapeRenderer3D::drawInstanced(debugDrawables, camera);
+@endcode
+
 @see @ref ShapeRenderer2D, @ref ShapeRenderer3D, @ref ShapeRendererOptions
 
 @todo Different drawing style for inverted shapes? (marking the "inside" somehow)
@@ -160,6 +172,25 @@ template<UnsignedInt dimensions> class MAGNUM_DEBUGTOOLS_EXPORT ShapeRenderer: p
 
         ~ShapeRenderer();
 
+        /**
+         * @brief Draw shape renderers in given group using instancing
+         *
+         * Gathers transformations and colors of all shape renderers in
+         * @p drawables into one instance buffer per primitive and draws each
+         * primitive with a single instanced draw call. Drawables that aren't
+         * shape renderers are ignored, so it's best to have the shape
+         * renderers in a dedicated group. See
+         * @ref DebugTools-ShapeRenderer-instancing "class documentation" for
+         * more information.
+         * @requires_gl33 Extension @extension{ARB,instanced_arrays}
+         * @requires_gles30 Extension @es_extension{ANGLE,instanced_arrays},
+         *      @es_extension{EXT,instanced_arrays} or
+         *      @es_extension{NV,instanced_arrays} in OpenGL ES 2.0.
+         * @requires_webgl20 Extension @webgl_extension{ANGLE,instanced_arrays}
+         *      in WebGL 1.0.
+         */
+        static void drawInstanced(SceneGraph::DrawableGroup<dimensions, Float>& drawables, SceneGraph::Camera<dimensions, Float>& camera);
+
     private:
         void draw(const MatrixTypeFor<dimensions, Float>& transformationMatrix, SceneGraph::Camera<dimensions, Float>& camera) override;
 
@@ -0,0 +1,212 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Texture.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/DebugTools/AsyncReadback.h"
+#include "Magnum/Math/Range.h"
+
+namespace Magnum { namespace DebugTools { namespace Test {
+
+struct AsyncReadbackGLTest: Magnum::OpenGLTester {
+    explicit AsyncReadbackGLTest();
+
+    void constructEmpty();
+    void data();
+    void subData();
+    void subImage2D();
+
+    void queue();
+    void queueReuseStaging();
+};
+
+AsyncReadbackGLTest::AsyncReadbackGLTest() {
+    addTests({&AsyncReadbackGLTest::constructEmpty,
+              &AsyncReadbackGLTest::data,
+              &AsyncReadbackGLTest::subData,
+              &AsyncReadbackGLTest::subImage2D,
+
+              &AsyncReadbackGLTest::queue,
+              &AsyncReadbackGLTest::queueReuseStaging});
+}
+
+namespace {
+    constexpr Int Data[] = {2, 7, 5, 13, 25};
+
+    constexpr UnsignedByte Data2D[] = { 0x00, 0x01, 0x02, 0x03,
+                                        0x04, 0x05, 0x06, 0x07,
+                                        0x08, 0x09, 0x0a, 0x0b,
+                                        0x0c, 0x0d, 0x0e, 0x0f };
+}
+
+void AsyncReadbackGLTest::constructEmpty() {
+    AsyncReadback readback;
+    CORRADE_VERIFY(readback.isReady());
+    CORRADE_VERIFY(!readback.isImage());
+    CORRADE_COMPARE(readback.size(), 0);
+    CORRADE_VERIFY(readback.data().empty());
+}
+
+void AsyncReadbackGLTest::data() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sync>())
+        CORRADE_SKIP(Extensions::GL::ARB::sync::string() + std::string(" is not available"));
+    #endif
+
+    Buffer buffer;
+    buffer.setData(Data, BufferUsage::StaticDraw);
+    AsyncReadback readback = bufferDataAsync(buffer);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(readback.size(), sizeof(Data));
+
+    /* Overwriting the source doesn't affect the readback */
+    buffer.setData({nullptr, sizeof(Data)}, BufferUsage::StaticDraw);
+
+    readback.wait();
+    CORRADE_VERIFY(readback.isReady());
+    const Containers::Array<char> contents = readback.data();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Int>(contents), Containers::arrayView(Data),
+        TestSuite::Compare::Container);
+}
+
+void AsyncReadbackGLTest::subData() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sync>())
+        CORRADE_SKIP(Extensions::GL::ARB::sync::string() + std::string(" is not available"));
+    #endif
+
+    Buffer buffer;
+    buffer.setData(Data, BufferUsage::StaticDraw);
+    AsyncReadback readback = bufferSubDataAsync(buffer, 4, 12);
+    const Containers::Array<char> contents = readback.data();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Int>(contents), Containers::arrayView(Data).slice(1, 4),
+        TestSuite::Compare::Container);
+}
+
+void AsyncReadbackGLTest::subImage2D() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sync>())
+        CORRADE_SKIP(Extensions::GL::ARB::sync::string() + std::string(" is not available"));
+    #endif
+
+    Texture2D texture;
+    texture.setImage(0, TextureFormat::RGBA8, ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, Vector2i{2}, Data2D});
+
+    AsyncReadback readback = textureSubImageAsync(texture, 0, {{}, Vector2i{2}}, PixelFormat::RGBA, PixelType::UnsignedByte);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(readback.isImage());
+
+    Image2D image = readback.image();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(image.size(), Vector2i{2});
+    CORRADE_COMPARE_AS(Containers::arrayCast<UnsignedByte>(image.data()),
+        Containers::arrayView(Data2D), TestSuite::Compare::Container);
+}
+
+void AsyncReadbackGLTest::queue() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sync>())
+        CORRADE_SKIP(Extensions::GL::ARB::sync::string() + std::string(" is not available"));
+    #endif
+
+    Buffer buffer;
+    buffer.setData(Data, BufferUsage::StaticDraw);
+    Texture2D texture;
+    texture.setImage(0, TextureFormat::RGBA8, ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, Vector2i{2}, Data2D});
+
+    std::vector<Int> order;
+    Containers::Array<Int> bufferContents{Containers::arrayView(Data).size()};
+    Containers::Array<UnsignedByte> imageContents{Containers::arrayView(Data2D).size()};
+
+    ReadbackQueue queue;
+    queue.bufferData(buffer, [&](Containers::ArrayView<const char> data) {
+            order.push_back(0);
+            CORRADE_COMPARE(data.size(), sizeof(Data));
+            std::copy(data.begin(), data.end(), reinterpret_cast<char*>(bufferContents.data()));
+        })
+        .textureSubImage(texture, 0, {{}, Vector2i{2}}, PixelFormat::RGBA, PixelType::UnsignedByte, [&](const ImageView2D& image) {
+            order.push_back(1);
+            CORRADE_COMPARE(image.size(), Vector2i{2});
+            std::copy(image.data().begin(), image.data().end(), reinterpret_cast<char*>(imageContents.data()));
+        });
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(queue.pendingCount(), 2);
+
+    queue.finish();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(queue.pendingCount(), 0);
+    CORRADE_COMPARE(order, (std::vector<Int>{0, 1}));
+    CORRADE_COMPARE_AS(bufferContents, Containers::arrayView(Data),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(imageContents, Containers::arrayView(Data2D),
+        TestSuite::Compare::Container);
+
+    /* Nothing left to poll */
+    CORRADE_COMPARE(queue.poll(), 0);
+}
+
+void AsyncReadbackGLTest::queueReuseStaging() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sync>())
+        CORRADE_SKIP(Extensions::GL::ARB::sync::string() + std::string(" is not available"));
+    #endif
+
+    Buffer buffer;
+    buffer.setData(Data, BufferUsage::StaticDraw);
+
+    ReadbackQueue queue;
+    Int sum = 0;
+    const auto callback = [&](Containers::ArrayView<const char> data) {
+        for(Int i: Containers::arrayCast<const Int>(data)) sum += i;
+    };
+
+    /* Staging buffer of the first readback is reused by the second */
+    queue.bufferData(buffer, callback);
+    queue.finish();
+    CORRADE_COMPARE(queue.stagingBufferCount(), 1);
+    queue.bufferSubData(buffer, 4, 8, callback);
+    CORRADE_COMPARE(queue.stagingBufferCount(), 0);
+    queue.finish();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(queue.stagingBufferCount(), 1);
+    CORRADE_COMPARE(sum, 52 + 12);
+
+    queue.releaseStagingBuffers();
+    CORRADE_COMPARE(queue.stagingBufferCount(), 0);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::DebugTools::Test::AsyncReadbackGLTest)
@@ -24,10 +24,12 @@
 */
 
 #include <sstream>
+#include <algorithm>
 #include <numeric>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
 
+#include "Magnum/Image.h"
 #include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
 #include "Magnum/DebugTools/CompareImage.h"
@@ -41,10 +43,17 @@ struct CompareImageTest: TestSuite::Tester {
 
     void calculateDelta();
     void calculateDeltaStorage();
+    void calculateDeltaRgba8();
+    void calculateDeltaRgb8();
+    void calculateDeltaFloat();
+    void calculateDeltaThreads();
+    void calculateDeltaEarlyOut();
+    void calculateDeltaEarlyOutThreads();
 
     void deltaImage();
     void deltaImageScaling();
     void deltaImageColors();
+    void deltaHeatmap();
 
     void pixelDelta();
     void pixelDeltaOverflow();
@@ -56,15 +65,24 @@ struct CompareImageTest: TestSuite::Tester {
     void compareAboveThresholds();
     void compareAboveMaxThreshold();
     void compareAboveMeanThreshold();
+    void compareEarlyOut();
+    void compareEarlyOutBelowMaxThreshold();
 };
 
 CompareImageTest::CompareImageTest() {
     addTests({&CompareImageTest::calculateDelta,
               &CompareImageTest::calculateDeltaStorage,
+              &CompareImageTest::calculateDeltaRgba8,
+              &CompareImageTest::calculateDeltaRgb8,
+              &CompareImageTest::calculateDeltaFloat,
+              &CompareImageTest::calculateDeltaThreads,
+              &CompareImageTest::calculateDeltaEarlyOut,
+              &CompareImageTest::calculateDeltaEarlyOutThreads,
 
               &CompareImageTest::deltaImage,
               &CompareImageTest::deltaImageScaling,
               &CompareImageTest::deltaImageColors,
+              &CompareImageTest::deltaHeatmap,
 
               &CompareImageTest::pixelDelta,
               &CompareImageTest::pixelDeltaOverflow,
@@ -75,7 +93,9 @@ CompareImageTest::CompareImageTest() {
               &CompareImageTest::compareSameZeroThreshold,
               &CompareImageTest::compareAboveThresholds,
               &CompareImageTest::compareAboveMaxThreshold,
-              &CompareImageTest::compareAboveMeanThreshold});
+              &CompareImageTest::compareAboveMeanThreshold,
+              &CompareImageTest::compareEarlyOut,
+              &CompareImageTest::compareEarlyOutBelowMaxThreshold});
 }
 
 namespace {
@@ -162,6 +182,152 @@ void CompareImageTest::calculateDeltaStorage() {
     CORRADE_COMPARE(mean, 18.5f);
 }
 
+namespace {
+    /* Pseudo-random but deterministic pixel data */
+    template<class T> std::vector<T> generateData(std::size_t size, UnsignedInt seed) {
+        std::vector<T> data(size);
+        for(T& i: data) {
+            seed = seed*1103515245u + 12345u;
+            i = T(seed >> 16);
+        }
+        return data;
+    }
+
+    template<std::size_t size, class T> std::vector<Float> referenceDelta(const std::vector<T>& actual, const std::vector<T>& expected) {
+        std::vector<Float> delta(actual.size()/size);
+        for(std::size_t i = 0; i != delta.size(); ++i) {
+            const Math::Vector<size, Float> a{Math::Vector<size, T>::from(actual.data() + i*size)};
+            const Math::Vector<size, Float> e{Math::Vector<size, T>::from(expected.data() + i*size)};
+            delta[i] = (Math::abs(a - e)).sum()/size;
+        }
+        return delta;
+    }
+}
+
+void CompareImageTest::calculateDeltaRgba8() {
+    /* 7 pixels wide to have both the four-pixel loop and the remainder */
+    const std::vector<UnsignedByte> actualData = generateData<UnsignedByte>(7*3*4, 5);
+    const std::vector<UnsignedByte> expectedData = generateData<UnsignedByte>(7*3*4, 17);
+    const ImageView2D actual{PixelFormat::RGBA, PixelType::UnsignedByte, {7, 3}, {actualData.data(), actualData.size()}};
+    const ImageView2D expected{PixelFormat::RGBA, PixelType::UnsignedByte, {7, 3}, {expectedData.data(), expectedData.size()}};
+
+    std::vector<Float> delta;
+    Float max, mean;
+    std::tie(delta, max, mean) = Implementation::calculateImageDelta(actual, expected);
+
+    const std::vector<Float> reference = referenceDelta<4>(actualData, expectedData);
+    CORRADE_COMPARE_AS(delta, reference, TestSuite::Compare::Container);
+    CORRADE_COMPARE(max, *std::max_element(reference.begin(), reference.end()));
+}
+
+void CompareImageTest::calculateDeltaRgb8() {
+    const std::vector<UnsignedByte> actualData = generateData<UnsignedByte>(8*3*3, 5);
+    const std::vector<UnsignedByte> expectedData = generateData<UnsignedByte>(8*3*3, 17);
+    const ImageView2D actual{PixelStorage{}.setAlignment(1), PixelFormat::RGB, PixelType::UnsignedByte, {8, 3}, {actualData.data(), actualData.size()}};
+    const ImageView2D expected{PixelStorage{}.setAlignment(1), PixelFormat::RGB, PixelType::UnsignedByte, {8, 3}, {expectedData.data(), expectedData.size()}};
+
+    std::vector<Float> delta;
+    Float max, mean;
+    std::tie(delta, max, mean) = Implementation::calculateImageDelta(actual, expected);
+
+    const std::vector<Float> reference = referenceDelta<3>(actualData, expectedData);
+    CORRADE_COMPARE_AS(delta, reference, TestSuite::Compare::Container);
+    CORRADE_COMPARE(max, *std::max_element(reference.begin(), reference.end()));
+}
+
+void CompareImageTest::calculateDeltaFloat() {
+    const Float actualData[] = {
+        0.3f, 1.0f, 0.9f, -0.5f, 0.25f, 0.0f, 0.7f
+    };
+    const Float expectedData[] = {
+        0.65f, 1.0f, 0.6f, 0.5f, 0.125f, 0.75f, 0.6f
+    };
+    const Float reference[] = {
+        0.35f, 0.0f, 0.3f, 1.0f, 0.125f, 0.75f, 0.1f
+    };
+
+    const ImageView2D actual{
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        PixelFormat::Red
+        #else
+        PixelFormat::Luminance
+        #endif
+        , PixelType::Float, {7, 1}, actualData};
+    const ImageView2D expected{
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        PixelFormat::Red
+        #else
+        PixelFormat::Luminance
+        #endif
+        , PixelType::Float, {7, 1}, expectedData};
+
+    std::vector<Float> delta;
+    Float max, mean;
+    std::tie(delta, max, mean) = Implementation::calculateImageDelta(actual, expected);
+
+    CORRADE_COMPARE_AS(delta, (std::vector<Float>{std::begin(reference), std::end(reference)}), TestSuite::Compare::Container);
+    CORRADE_COMPARE(max, 1.0f);
+}
+
+void CompareImageTest::calculateDeltaThreads() {
+    const std::vector<UnsignedByte> actualData = generateData<UnsignedByte>(67*31*4, 5);
+    const std::vector<UnsignedByte> expectedData = generateData<UnsignedByte>(67*31*4, 17);
+    const ImageView2D actual{PixelFormat::RGBA, PixelType::UnsignedByte, {67, 31}, {actualData.data(), actualData.size()}};
+    const ImageView2D expected{PixelFormat::RGBA, PixelType::UnsignedByte, {67, 31}, {expectedData.data(), expectedData.size()}};
+
+    std::vector<Float> delta, deltaThreaded;
+    Float max, maxThreaded, mean, meanThreaded;
+    std::tie(delta, max, mean) = Implementation::calculateImageDelta(actual, expected, 1);
+    std::tie(deltaThreaded, maxThreaded, meanThreaded) = Implementation::calculateImageDelta(actual, expected, 4);
+
+    CORRADE_COMPARE_AS(deltaThreaded, delta, TestSuite::Compare::Container);
+    CORRADE_COMPARE(maxThreaded, max);
+    CORRADE_COMPARE(meanThreaded, mean);
+}
+
+void CompareImageTest::calculateDeltaEarlyOut() {
+    std::vector<Float> delta;
+    Float max, mean;
+    Vector2i position;
+
+    /* Stops on the first pixel above the threshold */
+    std::tie(delta, max, mean, position) = Implementation::calculateImageDeltaEarlyOut(ActualRgb, ExpectedRgb, 17.0f);
+    CORRADE_COMPARE(position, (Vector2i{1, 0}));
+    CORRADE_COMPARE(max, 56.0f/3.0f);
+    CORRADE_COMPARE(mean, 0.0f);
+
+    /* Nothing above the threshold, same as without early out */
+    std::tie(delta, max, mean, position) = Implementation::calculateImageDeltaEarlyOut(ActualRgb, ExpectedRgb, 50.0f);
+    CORRADE_COMPARE(position, Vector2i{-1});
+    CORRADE_COMPARE_AS(delta, (std::vector<Float>{
+        1.0f/3.0f, (55.0f + 1.0f)/3.0f,
+        48.0f/3.0f, 117.0f/3.0f
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(max, 117.0f/3.0f);
+    CORRADE_COMPARE(mean, 18.5f);
+}
+
+void CompareImageTest::calculateDeltaEarlyOutThreads() {
+    std::vector<UnsignedByte> actualData(67*31*4);
+    std::vector<UnsignedByte> expectedData(67*31*4);
+
+    /* Offending pixels in the second and the last part of the image. The
+       earliest one should be always reported, regardless of scheduling. */
+    actualData[(12*67 + 40)*4 + 2] = 100;
+    actualData[(12*67 + 41)*4 + 3] = 200;
+    actualData[(29*67 + 3)*4] = 255;
+
+    const ImageView2D actual{PixelFormat::RGBA, PixelType::UnsignedByte, {67, 31}, {actualData.data(), actualData.size()}};
+    const ImageView2D expected{PixelFormat::RGBA, PixelType::UnsignedByte, {67, 31}, {expectedData.data(), expectedData.size()}};
+
+    std::vector<Float> delta;
+    Float max, mean;
+    Vector2i position;
+    std::tie(delta, max, mean, position) = Implementation::calculateImageDeltaEarlyOut(actual, expected, 10.0f, 4);
+    CORRADE_COMPARE(position, (Vector2i{40, 12}));
+    CORRADE_COMPARE(max, 25.0f);
+}
+
 void CompareImageTest::deltaImage() {
     std::ostringstream out;
     Debug d{&out, Debug::Flag::DisableColors};
@@ -233,6 +399,22 @@ void CompareImageTest::deltaImageColors() {
         "          |: ,|\n");
 }
 
+void CompareImageTest::deltaHeatmap() {
+    const Image2D heatmap = Implementation::deltaHeatmap(DeltaRed, {3, 3}, 1.0f, 0.5f, 0.1f);
+    CORRADE_COMPARE(heatmap.size(), (Vector2i{3, 3}));
+    CORRADE_COMPARE(heatmap.format(), PixelFormat::RGB);
+    CORRADE_COMPARE(heatmap.type(), PixelType::UnsignedByte);
+
+    const Color3ub* pixels = heatmap.data<Color3ub>();
+    /* Below mean threshold, zero delta is black */
+    CORRADE_COMPARE(pixels[1], Color3ub{});
+    CORRADE_COMPARE(pixels[3], Color3ub{66});
+    /* Above mean threshold */
+    CORRADE_COMPARE(pixels[0], (Color3ub{131, 131, 0}));
+    /* Above max threshold */
+    CORRADE_COMPARE(pixels[7], (Color3ub{255, 0, 0}));
+}
+
 void CompareImageTest::pixelDelta() {
     {
         Debug() << "Visual verification -- some lines should be yellow, some red:";
@@ -390,6 +572,46 @@ void CompareImageTest::compareAboveMeanThreshold() {
         "          [1,0] #5647ec, expected #5610ed (Δ = 18.6667)\n");
 }
 
+void CompareImageTest::compareEarlyOut() {
+    std::stringstream out;
+
+    {
+        TestSuite::Comparator<CompareImage> compare{17.0f, 10.0f};
+        compare.setEarlyOut(true);
+        CORRADE_VERIFY(!compare(ActualRgb, ExpectedRgb));
+        Debug d{&out, Debug::Flag::DisableColors};
+        compare.printErrorMessage(d, "a", "b");
+    }
+
+    CORRADE_COMPARE(out.str(),
+        "Images a and b have max delta above threshold, actual 18.6667 at [1,0] but at most 17 expected. Stopped at first such pixel:\n"
+        "          [1,0] #5647ec, expected #5610ed (Δ = 18.6667)\n");
+}
+
+void CompareImageTest::compareEarlyOutBelowMaxThreshold() {
+    std::stringstream out;
+
+    /* The mean threshold is still checked if nothing is above max */
+    {
+        TestSuite::Comparator<CompareImage> compare{50.0f, 18.0f};
+        compare.setEarlyOut(true);
+        CORRADE_VERIFY(!compare(ActualRgb, ExpectedRgb));
+        Debug d{&out, Debug::Flag::DisableColors};
+        compare.printErrorMessage(d, "a", "b");
+    }
+
+    CORRADE_COMPARE(out.str(),
+        "Images a and b have mean delta above threshold, actual 18.5 but at most 18 expected. Max delta 39 is below threshold 50. Delta image:\n"
+        "          |?M|\n"
+        "        Pixels above max/mean threshold:\n"
+        "          [1,1] #abcd85, expected #abcdfa (Δ = 39)\n"
+        "          [1,0] #5647ec, expected #5610ed (Δ = 18.6667)\n");
+
+    TestSuite::Comparator<CompareImage> compare{50.0f, 20.0f};
+    compare.setEarlyOut(true);
+    CORRADE_VERIFY(compare(ActualRgb, ExpectedRgb));
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::DebugTools::Test::CompareImageTest)
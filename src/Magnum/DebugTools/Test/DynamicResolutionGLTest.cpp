@@ -0,0 +1,205 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+#include <cmath>
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Image.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/DebugTools/DynamicResolution.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Range.h"
+
+namespace Magnum { namespace DebugTools { namespace Test {
+
+struct DynamicResolutionGLTest: Magnum::OpenGLTester {
+    explicit DynamicResolutionGLTest();
+
+    void construct();
+    void setScaleBounds();
+    void addTimeSample();
+    void addTimeSampleHysteresis();
+    void addTimeSampleDifferentScale();
+
+    void render();
+    void gpuTiming();
+};
+
+DynamicResolutionGLTest::DynamicResolutionGLTest() {
+    addTests({&DynamicResolutionGLTest::construct,
+              &DynamicResolutionGLTest::setScaleBounds,
+              &DynamicResolutionGLTest::addTimeSample,
+              &DynamicResolutionGLTest::addTimeSampleHysteresis,
+              &DynamicResolutionGLTest::addTimeSampleDifferentScale,
+
+              &DynamicResolutionGLTest::render,
+              &DynamicResolutionGLTest::gpuTiming});
+}
+
+namespace {
+    #ifndef MAGNUM_TARGET_GLES2
+    constexpr RenderbufferFormat ColorFormat = RenderbufferFormat::RGBA8;
+    #else
+    constexpr RenderbufferFormat ColorFormat = RenderbufferFormat::RGBA4;
+    #endif
+}
+
+void DynamicResolutionGLTest::construct() {
+    DynamicResolution resolution{{640, 480}, 10.0f, ColorFormat};
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE(resolution.size(), (Vector2i{640, 480}));
+    CORRADE_COMPARE(resolution.targetTime(), 10.0f);
+    CORRADE_COMPARE(resolution.scale(), 1.0f);
+    CORRADE_COMPARE(resolution.scaledSize(), (Vector2i{640, 480}));
+    CORRADE_COMPARE(resolution.minScale(), 0.5f);
+    CORRADE_COMPARE(resolution.maxScale(), 1.0f);
+    CORRADE_COMPARE(resolution.hysteresis(), 0.1f);
+    CORRADE_COMPARE(resolution.latency(), 3);
+    CORRADE_VERIFY(resolution.isGpuTimingEnabled());
+    CORRADE_COMPARE(resolution.predictedTime(), 0.0f);
+}
+
+void DynamicResolutionGLTest::setScaleBounds() {
+    DynamicResolution resolution{{640, 480}, 10.0f, ColorFormat};
+    resolution.setScale(0.8f)
+        .setScaleBounds(0.25f, 0.75f);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Current scale is clamped to the new bounds */
+    CORRADE_COMPARE(resolution.scale(), 0.75f);
+    CORRADE_COMPARE(resolution.scaledSize(), (Vector2i{480, 360}));
+
+    resolution.setScale(0.1f);
+    CORRADE_COMPARE(resolution.scale(), 0.25f);
+    CORRADE_COMPARE(resolution.scaledSize(), (Vector2i{160, 120}));
+}
+
+void DynamicResolutionGLTest::addTimeSample() {
+    DynamicResolution resolution{{640, 480}, 10.0f, ColorFormat};
+
+    /* Twice as long as the target at full scale, the pixel count needs to be
+       halved */
+    resolution.addTimeSample(20.0f);
+    CORRADE_COMPARE(resolution.scale(), std::sqrt(0.5f));
+    CORRADE_COMPARE(resolution.predictedTime(), 10.0f);
+
+    /* Way too much, clamped to the minimal scale */
+    resolution.addTimeSample(500.0f);
+    CORRADE_COMPARE(resolution.scale(), 0.5f);
+
+    /* Way below the target, clamped to the maximal scale */
+    for(std::size_t i = 0; i != 50; ++i) resolution.addTimeSample(0.1f);
+    CORRADE_COMPARE(resolution.scale(), 1.0f);
+}
+
+void DynamicResolutionGLTest::addTimeSampleHysteresis() {
+    DynamicResolution resolution{{640, 480}, 10.0f, ColorFormat};
+    resolution.setHysteresis(0.2f)
+        .setScale(0.5f);
+
+    /* Within 20% of the target, nothing changes */
+    resolution.addTimeSample(11.5f);
+    CORRADE_COMPARE(resolution.scale(), 0.5f);
+    resolution.addTimeSample(8.5f);
+    CORRADE_COMPARE(resolution.scale(), 0.5f);
+
+    /* The moving average gets outside after a few samples and the scale goes
+       up */
+    for(std::size_t i = 0; i != 3; ++i) resolution.addTimeSample(1.0f);
+    CORRADE_VERIFY(resolution.scale() > 0.5f);
+}
+
+void DynamicResolutionGLTest::addTimeSampleDifferentScale() {
+    DynamicResolution resolution{{640, 480}, 10.0f, ColorFormat};
+    resolution.setScale(0.5f);
+
+    /* Sample measured at full scale (i.e., issued before the scale change)
+       is normalized to the current scale */
+    resolution.addTimeSample(10.0f, 1.0f);
+    CORRADE_COMPARE(resolution.predictedTime(), 10.0f);
+    CORRADE_COMPARE(resolution.scale(), 1.0f);
+}
+
+void DynamicResolutionGLTest::render() {
+    #ifdef MAGNUM_TARGET_GLES2
+    if(!Context::current().isExtensionSupported<Extensions::GL::ANGLE::framebuffer_blit>() &&
+       !Context::current().isExtensionSupported<Extensions::GL::NV::framebuffer_blit>())
+        CORRADE_SKIP("Required extension is not available.");
+    #endif
+
+    Renderbuffer color;
+    color.setStorage(ColorFormat, {64, 64});
+    Framebuffer destination{{{}, {64, 64}}};
+    destination.attachRenderbuffer(Framebuffer::ColorAttachment{0}, color);
+
+    DynamicResolution resolution{{64, 64}, 10.0f, ColorFormat};
+    resolution.setGpuTimingEnabled(false)
+        .setScale(0.5f);
+
+    Renderer::setClearColor(Math::unpack<Color4>(Color4ub(0x33, 0x66, 0xff, 0xff)));
+    Framebuffer& framebuffer = resolution.begin();
+    CORRADE_COMPARE(framebuffer.viewport(), (Range2Di{{}, {32, 32}}));
+    framebuffer.clear(FramebufferClear::Color);
+    resolution.end(destination);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* The whole destination is filled with the upscaled contents */
+    Image2D image = destination.read({{}, {64, 64}}, {PixelFormat::RGBA, PixelType::UnsignedByte});
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(image.data<Color4ub>()[0], Color4ub(0x33, 0x66, 0xff, 0xff));
+    CORRADE_COMPARE(image.data<Color4ub>()[64*64 - 1], Color4ub(0x33, 0x66, 0xff, 0xff));
+}
+
+void DynamicResolutionGLTest::gpuTiming() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::timer_query>())
+        CORRADE_SKIP(Extensions::GL::ARB::timer_query::string() + std::string(" is not available"));
+    #else
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::disjoint_timer_query>())
+        CORRADE_SKIP(Extensions::GL::EXT::disjoint_timer_query::string() + std::string(" is not available"));
+    #endif
+
+    DynamicResolution resolution{{1024, 1024}, 1000.0f, ColorFormat};
+    resolution.setLatency(1);
+
+    /* After latency() + 1 frames there's a measurement */
+    for(std::size_t i = 0; i != 3; ++i) {
+        resolution.begin().clear(FramebufferClear::Color);
+        resolution.end();
+        Renderer::finish();
+    }
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(resolution.predictedTime() > 0.0f);
+
+    /* Way below the target, so the scale stays at maximum */
+    CORRADE_COMPARE(resolution.scale(), 1.0f);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::DebugTools::Test::DynamicResolutionGLTest)
@@ -0,0 +1,143 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/DebugTools/GLTrace.h"
+
+namespace Magnum { namespace DebugTools { namespace Test {
+
+struct GLTraceTest: TestSuite::Tester {
+    explicit GLTraceTest();
+
+    void construct();
+
+    void replayOpen();
+    void replayOpenInvalidSignature();
+    void replayOpenUnsupportedVersion();
+    void replayOpenTruncated();
+    void replayOpenTrailingCalls();
+};
+
+GLTraceTest::GLTraceTest() {
+    addTests({&GLTraceTest::construct,
+
+              &GLTraceTest::replayOpen,
+              &GLTraceTest::replayOpenInvalidSignature,
+              &GLTraceTest::replayOpenUnsupportedVersion,
+              &GLTraceTest::replayOpenTruncated,
+              &GLTraceTest::replayOpenTrailingCalls});
+}
+
+namespace {
+    /* Header with one function not known to the engine, a frame with one
+       call and a frame with two calls */
+    constexpr const char Trace[]{
+        'M', 'A', 'G', 'N', 'U', 'M', 'G', 'L', 'T', 'R', 'A', 'C', 'E', '\0',
+        1, 1,
+            5, 'g', 'l', 'F', 'o', 'o', 1, 0,
+        1, 0, 5,
+        0,
+        1, 0, 3,
+        1, 1, 2, 'a', 'b',
+        0
+    };
+}
+
+void GLTraceTest::construct() {
+    GLTrace trace;
+    CORRADE_VERIFY(!trace.isCapturing());
+    CORRADE_COMPARE(trace.frameCount(), 0);
+    CORRADE_COMPARE(trace.callCount(), 0);
+    CORRADE_VERIFY(trace.data().empty());
+
+    /* Does nothing if not capturing */
+    trace.nextFrame();
+    trace.stop();
+    CORRADE_COMPARE(trace.frameCount(), 0);
+}
+
+void GLTraceTest::replayOpen() {
+    GLTraceReplay replay;
+    CORRADE_VERIFY(replay.openData(Trace));
+    CORRADE_COMPARE(replay.frameCount(), 2);
+    CORRADE_COMPARE(replay.callCount(0), 1);
+    CORRADE_COMPARE(replay.callCount(1), 2);
+    CORRADE_COMPARE(replay.skippedCount(), 0);
+    CORRADE_VERIFY(replay.statistics().empty());
+}
+
+void GLTraceTest::replayOpenInvalidSignature() {
+    char data[sizeof(Trace)];
+    std::copy(Trace, Trace + sizeof(Trace), data);
+    data[1] = 'G';
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    GLTraceReplay replay;
+    CORRADE_VERIFY(!replay.openData(data));
+    CORRADE_COMPARE(replay.frameCount(), 0);
+    CORRADE_COMPARE(out.str(), "DebugTools::GLTraceReplay::openData(): invalid signature\n");
+}
+
+void GLTraceTest::replayOpenUnsupportedVersion() {
+    char data[sizeof(Trace)];
+    std::copy(Trace, Trace + sizeof(Trace), data);
+    data[14] = 2;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    GLTraceReplay replay;
+    CORRADE_VERIFY(!replay.openData(data));
+    CORRADE_COMPARE(out.str(), "DebugTools::GLTraceReplay::openData(): unsupported version 2\n");
+}
+
+void GLTraceTest::replayOpenTruncated() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    /* Data of the last call cut in half */
+    GLTraceReplay replay;
+    CORRADE_VERIFY(!replay.openData({Trace, sizeof(Trace) - 3}));
+    CORRADE_COMPARE(out.str(), "DebugTools::GLTraceReplay::openData(): arguments of glFoo are truncated\n");
+}
+
+void GLTraceTest::replayOpenTrailingCalls() {
+    std::ostringstream out;
+    Warning redirectWarning{&out};
+
+    /* Missing the last frame end */
+    GLTraceReplay replay;
+    CORRADE_VERIFY(replay.openData({Trace, sizeof(Trace) - 1}));
+    CORRADE_COMPARE(replay.frameCount(), 1);
+    CORRADE_COMPARE(out.str(), "DebugTools::GLTraceReplay::openData(): ignoring 2 calls after the last frame\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::DebugTools::Test::GLTraceTest)
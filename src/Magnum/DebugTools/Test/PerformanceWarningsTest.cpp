@@ -0,0 +1,284 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/DebugTools/PerformanceWarnings.h"
+#include "Magnum/DebugTools/Profiler.h"
+
+namespace Magnum { namespace DebugTools { namespace Test {
+
+struct PerformanceWarningsTest: TestSuite::Tester {
+    explicit PerformanceWarningsTest();
+
+    void construct();
+    void deduplicate();
+    void differentSource();
+    void frames();
+    void groups();
+    void groupsUnbalanced();
+    void section();
+    void forward();
+    void capacity();
+    void clear();
+    void printStatistics();
+};
+
+PerformanceWarningsTest::PerformanceWarningsTest() {
+    addTests({&PerformanceWarningsTest::construct,
+              &PerformanceWarningsTest::deduplicate,
+              &PerformanceWarningsTest::differentSource,
+              &PerformanceWarningsTest::frames,
+              &PerformanceWarningsTest::groups,
+              &PerformanceWarningsTest::groupsUnbalanced,
+              &PerformanceWarningsTest::section,
+              &PerformanceWarningsTest::forward,
+              &PerformanceWarningsTest::capacity,
+              &PerformanceWarningsTest::clear,
+              &PerformanceWarningsTest::printStatistics});
+}
+
+namespace {
+    void performance(PerformanceWarnings& warnings, UnsignedInt id, const std::string& message) {
+        warnings.handle(DebugOutput::Source::Api, DebugOutput::Type::Performance, id, DebugOutput::Severity::Medium, message);
+    }
+
+    void pushGroup(PerformanceWarnings& warnings, const std::string& label) {
+        warnings.handle(DebugOutput::Source::Application, DebugOutput::Type::PushGroup, 0, DebugOutput::Severity::Notification, label);
+    }
+
+    void popGroup(PerformanceWarnings& warnings) {
+        warnings.handle(DebugOutput::Source::Application, DebugOutput::Type::PopGroup, 0, DebugOutput::Severity::Notification, {});
+    }
+}
+
+void PerformanceWarningsTest::construct() {
+    PerformanceWarnings warnings{16};
+    CORRADE_COMPARE(warnings.capacity(), 16);
+    CORRADE_VERIFY(!warnings.profiler());
+    CORRADE_VERIFY(!warnings.isInstalled());
+    CORRADE_COMPARE(warnings.frame(), 0);
+    CORRADE_VERIFY(warnings.warnings().empty());
+    CORRADE_COMPARE(warnings.frameCount(), 0);
+    CORRADE_COMPARE(warnings.droppedCount(), 0);
+}
+
+void PerformanceWarningsTest::deduplicate() {
+    PerformanceWarnings warnings;
+    performance(warnings, 131218, "Program/shader state performance warning: recompiled");
+    performance(warnings, 131186, "Buffer performance warning: copying from VIDEO to HOST");
+    performance(warnings, 131218, "Program/shader state performance warning: recompiled again");
+
+    CORRADE_COMPARE(warnings.warnings().size(), 2);
+    CORRADE_COMPARE(warnings.frameCount(), 3);
+
+    const PerformanceWarnings::Warning& first = warnings.warnings()[0];
+    CORRADE_COMPARE(first.source, DebugOutput::Source::Api);
+    CORRADE_COMPARE(first.severity, DebugOutput::Severity::Medium);
+    CORRADE_COMPARE(first.id, 131218);
+    /* Message of the first occurrence is kept */
+    CORRADE_COMPARE(first.message, "Program/shader state performance warning: recompiled");
+    CORRADE_COMPARE(first.count, 2);
+    CORRADE_COMPARE(first.frameCount, 2);
+
+    CORRADE_COMPARE(warnings.warnings()[1].id, 131186);
+    CORRADE_COMPARE(warnings.warnings()[1].count, 1);
+}
+
+void PerformanceWarningsTest::differentSource() {
+    PerformanceWarnings warnings;
+    performance(warnings, 7, "a");
+    warnings.handle(DebugOutput::Source::ShaderCompiler, DebugOutput::Type::Performance, 7, DebugOutput::Severity::Low, "b");
+
+    CORRADE_COMPARE(warnings.warnings().size(), 2);
+    CORRADE_COMPARE(warnings.warnings()[1].source, DebugOutput::Source::ShaderCompiler);
+}
+
+void PerformanceWarningsTest::frames() {
+    PerformanceWarnings warnings;
+    performance(warnings, 1, "a");
+    performance(warnings, 1, "a");
+    warnings.nextFrame();
+
+    CORRADE_COMPARE(warnings.frame(), 1);
+    CORRADE_COMPARE(warnings.frameCount(), 0);
+    CORRADE_COMPARE(warnings.warnings()[0].frameCount, 0);
+    CORRADE_COMPARE(warnings.warnings()[0].previousFrameCount, 2);
+
+    performance(warnings, 2, "b");
+    warnings.nextFrame();
+    performance(warnings, 1, "a");
+
+    const PerformanceWarnings::Warning& a = warnings.warnings()[0];
+    CORRADE_COMPARE(a.firstFrame, 0);
+    CORRADE_COMPARE(a.lastFrame, 2);
+    CORRADE_COMPARE(a.count, 3);
+    CORRADE_COMPARE(a.frameCount, 1);
+    CORRADE_COMPARE(a.previousFrameCount, 0);
+
+    const PerformanceWarnings::Warning& b = warnings.warnings()[1];
+    CORRADE_COMPARE(b.firstFrame, 1);
+    CORRADE_COMPARE(b.lastFrame, 1);
+    CORRADE_COMPARE(b.previousFrameCount, 1);
+    CORRADE_COMPARE(warnings.frameCount(), 1);
+}
+
+void PerformanceWarningsTest::groups() {
+    PerformanceWarnings warnings;
+    performance(warnings, 1, "outside");
+    pushGroup(warnings, "Scene");
+    pushGroup(warnings, "Shadows");
+    performance(warnings, 2, "inside");
+    popGroup(warnings);
+    performance(warnings, 3, "scene");
+    popGroup(warnings);
+
+    /* Group notifications themselves are not counted */
+    CORRADE_COMPARE(warnings.frameCount(), 3);
+    CORRADE_COMPARE(warnings.warnings()[0].group, "");
+    CORRADE_COMPARE(warnings.warnings()[1].group, "Shadows");
+    CORRADE_COMPARE(warnings.warnings()[2].group, "Scene");
+}
+
+void PerformanceWarningsTest::groupsUnbalanced() {
+    PerformanceWarnings warnings;
+
+    /* Group pushed before the collector was installed */
+    popGroup(warnings);
+    performance(warnings, 1, "a");
+    CORRADE_COMPARE(warnings.warnings()[0].group, "");
+}
+
+void PerformanceWarningsTest::section() {
+    Profiler profiler;
+    const Profiler::Section draw = profiler.addSection("Draw");
+    profiler.setCaptureCapacity(16);
+    profiler.enable();
+
+    PerformanceWarnings warnings;
+    CORRADE_COMPARE(&warnings.setProfiler(&profiler), &warnings);
+    CORRADE_COMPARE(warnings.profiler(), &profiler);
+
+    performance(warnings, 1, "a");
+    profiler.start(draw);
+    performance(warnings, 2, "b");
+    /* The section of the first occurrence is kept */
+    profiler.start();
+    performance(warnings, 2, "b");
+
+    CORRADE_COMPARE(warnings.warnings()[0].section, "Other");
+    CORRADE_COMPARE(warnings.warnings()[1].section, "Draw");
+}
+
+namespace {
+    struct Forwarded {
+        std::size_t count;
+        DebugOutput::Type type;
+        std::string message;
+    };
+
+    void forwardCallback(DebugOutput::Source, DebugOutput::Type type, UnsignedInt, DebugOutput::Severity, const std::string& message, const void* userParam) {
+        Forwarded& forwarded = *static_cast<Forwarded*>(const_cast<void*>(userParam));
+        ++forwarded.count;
+        forwarded.type = type;
+        forwarded.message = message;
+    }
+}
+
+void PerformanceWarningsTest::forward() {
+    PerformanceWarnings warnings;
+
+    /* Dropped without forward callback */
+    warnings.handle(DebugOutput::Source::Api, DebugOutput::Type::Error, 1, DebugOutput::Severity::High, "error");
+    CORRADE_VERIFY(warnings.warnings().empty());
+
+    Forwarded forwarded{};
+    warnings.setForwardCallback(forwardCallback, &forwarded);
+    warnings.handle(DebugOutput::Source::Api, DebugOutput::Type::Error, 1, DebugOutput::Severity::High, "error");
+    performance(warnings, 2, "slow");
+    pushGroup(warnings, "group");
+
+    CORRADE_COMPARE(forwarded.count, 1);
+    CORRADE_COMPARE(forwarded.type, DebugOutput::Type::Error);
+    CORRADE_COMPARE(forwarded.message, "error");
+    CORRADE_COMPARE(warnings.warnings().size(), 1);
+}
+
+void PerformanceWarningsTest::capacity() {
+    PerformanceWarnings warnings{2};
+    performance(warnings, 1, "a");
+    performance(warnings, 2, "b");
+    performance(warnings, 3, "c");
+    performance(warnings, 3, "c");
+    /* Already known warnings are still counted */
+    performance(warnings, 1, "a");
+
+    CORRADE_COMPARE(warnings.warnings().size(), 2);
+    CORRADE_COMPARE(warnings.droppedCount(), 2);
+    CORRADE_COMPARE(warnings.warnings()[0].count, 2);
+    CORRADE_COMPARE(warnings.frameCount(), 5);
+}
+
+void PerformanceWarningsTest::clear() {
+    PerformanceWarnings warnings{1};
+    pushGroup(warnings, "Scene");
+    performance(warnings, 1, "a");
+    performance(warnings, 2, "b");
+    warnings.nextFrame();
+
+    warnings.clear();
+    CORRADE_VERIFY(warnings.warnings().empty());
+    CORRADE_COMPARE(warnings.droppedCount(), 0);
+    CORRADE_COMPARE(warnings.frame(), 1);
+
+    /* Group stack is kept */
+    performance(warnings, 1, "a");
+    CORRADE_COMPARE(warnings.warnings()[0].count, 1);
+    CORRADE_COMPARE(warnings.warnings()[0].group, "Scene");
+}
+
+void PerformanceWarningsTest::printStatistics() {
+    PerformanceWarnings warnings{2};
+    performance(warnings, 1, "rare");
+    pushGroup(warnings, "UI");
+    performance(warnings, 2, "frequent");
+    performance(warnings, 2, "frequent");
+    performance(warnings, 3, "dropped");
+    warnings.nextFrame();
+
+    std::ostringstream out;
+    Debug redirectOutput{&out};
+    warnings.printStatistics();
+    CORRADE_COMPARE(out.str(),
+        "Performance warnings collected over 2 frames:\n"
+        "  2x, last frame 2x, ID 2 in group UI: frequent\n"
+        "  1x, last frame 1x, ID 1: rare\n"
+        "  1 occurrences of further warnings were dropped\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::DebugTools::Test::PerformanceWarningsTest)
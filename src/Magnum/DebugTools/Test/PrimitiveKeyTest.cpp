@@ -0,0 +1,71 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Magnum.h"
+
+#include "../Implementation/PrimitiveKey.h"
+
+namespace Magnum { namespace DebugTools { namespace Test {
+
+struct PrimitiveKeyTest: TestSuite::Tester {
+    explicit PrimitiveKeyTest();
+
+    void noParameters();
+    void parameters();
+    void shared();
+};
+
+PrimitiveKeyTest::PrimitiveKeyTest() {
+    addTests({&PrimitiveKeyTest::noParameters,
+              &PrimitiveKeyTest::parameters,
+              &PrimitiveKeyTest::shared});
+}
+
+void PrimitiveKeyTest::noParameters() {
+    CORRADE_COMPARE(Implementation::primitiveKey("Primitives::Cube::wireframe"),
+        "Primitives::Cube::wireframe()");
+}
+
+void PrimitiveKeyTest::parameters() {
+    CORRADE_COMPARE(Implementation::primitiveKey("Primitives::Capsule3D::wireframe", 10u, 1, 40, 1.5f),
+        "Primitives::Capsule3D::wireframe(10, 1, 40, 1.5)");
+}
+
+void PrimitiveKeyTest::shared() {
+    /* Same generator with same parameters gives the same key regardless of
+       parameter types, different parameters don't */
+    CORRADE_COMPARE(Implementation::primitiveKey("Primitives::UVSphere::wireframe", 20u, 40u),
+        Implementation::primitiveKey("Primitives::UVSphere::wireframe", 20, 40));
+    CORRADE_VERIFY(Implementation::primitiveKey("Primitives::UVSphere::wireframe", 20, 40) !=
+        Implementation::primitiveKey("Primitives::UVSphere::wireframe", 40, 20));
+    CORRADE_VERIFY(Implementation::primitiveKey("Primitives::Circle::wireframe", 40) !=
+        Implementation::primitiveKey("Primitives::UVSphere::wireframe", 40));
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::DebugTools::Test::PrimitiveKeyTest)
@@ -0,0 +1,204 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Framebuffer.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/Renderbuffer.h"
+#include "Magnum/RenderbufferFormat.h"
+#include "Magnum/DebugTools/Profiler.h"
+
+namespace Magnum { namespace DebugTools { namespace Test {
+
+struct ProfilerGLTest: Magnum::OpenGLTester {
+    explicit ProfilerGLTest();
+
+    void gpuDisabled();
+    void gpu();
+    void gpuLatency();
+    #ifndef MAGNUM_TARGET_GLES
+    void pipelineStatistics();
+    #endif
+};
+
+ProfilerGLTest::ProfilerGLTest() {
+    addTests({&ProfilerGLTest::gpuDisabled,
+              &ProfilerGLTest::gpu,
+              &ProfilerGLTest::gpuLatency,
+              #ifndef MAGNUM_TARGET_GLES
+              &ProfilerGLTest::pipelineStatistics
+              #endif
+              });
+}
+
+namespace {
+    /* Clearing a large framebuffer takes measurable GPU time */
+    struct ClearTarget {
+        explicit ClearTarget(): framebuffer{{{}, {1024, 1024}}} {
+            #ifndef MAGNUM_TARGET_GLES2
+            color.setStorage(RenderbufferFormat::RGBA8, {1024, 1024});
+            #else
+            color.setStorage(RenderbufferFormat::RGBA4, {1024, 1024});
+            #endif
+            framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment{0}, color);
+        }
+
+        void clear() {
+            for(std::size_t i = 0; i != 10; ++i)
+                framebuffer.clear(FramebufferClear::Color);
+        }
+
+        Renderbuffer color;
+        Framebuffer framebuffer;
+    };
+}
+
+void ProfilerGLTest::gpuDisabled() {
+    Profiler p;
+    const Profiler::Section section = p.addSection("Clear");
+    CORRADE_VERIFY(!p.isGpuProfilingEnabled());
+
+    p.enable();
+    p.start(section);
+    p.stop();
+    p.nextFrame();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(p.gpuTime(section).count(), 0);
+}
+
+void ProfilerGLTest::gpu() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::timer_query>())
+        CORRADE_SKIP(Extensions::GL::ARB::timer_query::string() + std::string(" is not available"));
+    #else
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::disjoint_timer_query>())
+        CORRADE_SKIP(Extensions::GL::EXT::disjoint_timer_query::string() + std::string(" is not available"));
+    #endif
+
+    ClearTarget target;
+
+    Profiler p;
+    const Profiler::Section clear = p.addSection("Clear");
+    p.setGpuProfilingEnabled(true);
+    p.setGpuLatency(1);
+    CORRADE_VERIFY(p.isGpuProfilingEnabled());
+    CORRADE_COMPARE(p.gpuLatency(), 1);
+
+    p.enable();
+    for(std::size_t i = 0; i != 3; ++i) {
+        p.start(clear);
+        target.clear();
+        p.start();
+        p.nextFrame();
+    }
+    p.stop();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(p.time(clear).count() > 0);
+    CORRADE_VERIFY(p.gpuTime(clear).count() > 0);
+}
+
+void ProfilerGLTest::gpuLatency() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::timer_query>())
+        CORRADE_SKIP(Extensions::GL::ARB::timer_query::string() + std::string(" is not available"));
+    #else
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::disjoint_timer_query>())
+        CORRADE_SKIP(Extensions::GL::EXT::disjoint_timer_query::string() + std::string(" is not available"));
+    #endif
+
+    ClearTarget target;
+
+    Profiler p;
+    const Profiler::Section section = p.addSection("Section");
+    p.setGpuProfilingEnabled(true);
+    p.setGpuLatency(3);
+    p.enable();
+
+    /* The results are read back only after three frames, so there's nothing
+       before that, even though the section runs across frame boundaries */
+    p.start(section);
+    for(std::size_t i = 0; i != 3; ++i) {
+        target.clear();
+        p.nextFrame();
+        MAGNUM_VERIFY_NO_ERROR();
+        CORRADE_COMPARE(p.gpuTime(section).count(), 0);
+    }
+
+    target.clear();
+    p.nextFrame();
+    p.stop();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(p.gpuTime(section).count() > 0);
+}
+
+#ifndef MAGNUM_TARGET_GLES
+void ProfilerGLTest::pipelineStatistics() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::timer_query>())
+        CORRADE_SKIP(Extensions::GL::ARB::timer_query::string() + std::string(" is not available"));
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::pipeline_statistics_query>())
+        CORRADE_SKIP(Extensions::GL::ARB::pipeline_statistics_query::string() + std::string(" is not available"));
+
+    ClearTarget target;
+
+    Profiler p;
+    const Profiler::Section clear = p.addSection("Clear");
+    p.setGpuProfilingEnabled(true);
+    p.setGpuLatency(1);
+    p.setPipelineStatistics({PipelineStatisticsQuery::Target::VerticesSubmitted,
+                             PipelineStatisticsQuery::Target::FragmentShaderInvocations});
+    CORRADE_COMPARE(p.pipelineStatistics().size(), 2);
+
+    /* Enabling the profiler again reallocates the statistics queries */
+    for(std::size_t j = 0; j != 2; ++j) {
+        p.enable();
+        for(std::size_t i = 0; i != 3; ++i) {
+            p.start(clear);
+            target.clear();
+            p.start();
+            p.nextFrame();
+        }
+        p.stop();
+        p.disable();
+
+        MAGNUM_VERIFY_NO_ERROR();
+        CORRADE_VERIFY(p.gpuTime(clear).count() > 0);
+
+        /* Clearing doesn't go through the pipeline, so there's nothing to
+           count */
+        CORRADE_COMPARE(p.pipelineStatistic(clear, PipelineStatisticsQuery::Target::VerticesSubmitted), 0.0);
+        CORRADE_COMPARE(p.pipelineStatistic(clear, PipelineStatisticsQuery::Target::FragmentShaderInvocations), 0.0);
+
+        /* Statistic that's not gathered */
+        CORRADE_COMPARE(p.pipelineStatistic(clear, PipelineStatisticsQuery::Target::ClippingInputPrimitives), 0.0);
+    }
+}
+#endif
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::DebugTools::Test::ProfilerGLTest)
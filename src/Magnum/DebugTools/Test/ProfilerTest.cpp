@@ -0,0 +1,442 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/DebugTools/AllocationHooks.h"
+#include "Magnum/DebugTools/Profiler.h"
+
+namespace Magnum { namespace DebugTools { namespace Test {
+
+struct ProfilerTest: TestSuite::Tester {
+    explicit ProfilerTest();
+
+    void time();
+    void currentSection();
+    void percentile();
+    void spikes();
+
+    void captureDisabled();
+    void capture();
+    void captureNested();
+    void captureOverflow();
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    void captureThreads();
+    #endif
+
+    void chromeTrace();
+    void csv();
+
+    void instrumentation();
+
+    void allocationTracking();
+    void allocationTrackingCapture();
+};
+
+ProfilerTest::ProfilerTest() {
+    addTests({&ProfilerTest::time,
+              &ProfilerTest::currentSection,
+              &ProfilerTest::percentile,
+              &ProfilerTest::spikes,
+
+              &ProfilerTest::captureDisabled,
+              &ProfilerTest::capture,
+              &ProfilerTest::captureNested,
+              &ProfilerTest::captureOverflow,
+              #ifndef CORRADE_TARGET_EMSCRIPTEN
+              &ProfilerTest::captureThreads,
+              #endif
+
+              &ProfilerTest::chromeTrace,
+              &ProfilerTest::csv,
+
+              &ProfilerTest::instrumentation,
+
+              &ProfilerTest::allocationTracking,
+              &ProfilerTest::allocationTrackingCapture});
+}
+
+namespace {
+    void spin(std::chrono::microseconds duration) {
+        const auto end = std::chrono::high_resolution_clock::now() + duration;
+        while(std::chrono::high_resolution_clock::now() < end);
+    }
+}
+
+void ProfilerTest::time() {
+    Profiler p;
+    const Profiler::Section a = p.addSection("A");
+
+    p.enable();
+    CORRADE_COMPARE(p.time(a).count(), 0);
+
+    p.start(a);
+    spin(std::chrono::microseconds{100});
+    p.stop();
+    p.nextFrame();
+
+    CORRADE_VERIFY(p.time(a) >= std::chrono::microseconds{100});
+    CORRADE_COMPARE(p.time(Profiler::otherSection).count(), 0);
+}
+
+void ProfilerTest::currentSection() {
+    Profiler p;
+    const Profiler::Section a = p.addSection("A");
+    const Profiler::Section b = p.addSection("B");
+    CORRADE_COMPARE(p.sectionName(Profiler::otherSection), "Other");
+    CORRADE_COMPARE(p.sectionName(b), "B");
+
+    /* Disabled profiler is always in the other section */
+    p.start(a);
+    CORRADE_COMPARE(p.currentSection(), Profiler::otherSection);
+
+    p.setCaptureCapacity(16);
+    p.enable();
+    p.start(a);
+    CORRADE_COMPARE(p.currentSection(), a);
+
+    p.push(b);
+    CORRADE_COMPARE(p.currentSection(), b);
+    p.pop();
+    CORRADE_COMPARE(p.currentSection(), a);
+
+    p.start();
+    CORRADE_COMPARE(p.currentSection(), Profiler::otherSection);
+}
+
+void ProfilerTest::percentile() {
+    Profiler p;
+    const Profiler::Section a = p.addSection("A");
+
+    p.enable();
+    CORRADE_COMPARE(p.percentile(a, 50.0).count(), 0);
+    CORRADE_COMPARE(p.maxTime(a).count(), 0);
+    CORRADE_COMPARE(p.framePercentile(99.0).count(), 0);
+
+    /* One slow frame out of hundred */
+    for(std::size_t i = 0; i != 100; ++i) {
+        p.start(a);
+        spin(std::chrono::microseconds{i == 50 ? 5000 : 100});
+        p.stop();
+        p.nextFrame();
+    }
+
+    CORRADE_VERIFY(p.percentile(a, 50.0) >= std::chrono::microseconds{100});
+    CORRADE_VERIFY(p.percentile(a, 99.0) < std::chrono::microseconds{5000});
+    CORRADE_VERIFY(p.maxTime(a) >= std::chrono::microseconds{5000});
+    CORRADE_VERIFY(p.percentile(a, 100.0) == p.maxTime(a));
+    CORRADE_VERIFY(p.maxFrameTime() >= std::chrono::microseconds{5000});
+    CORRADE_VERIFY(p.framePercentile(50.0) < std::chrono::microseconds{5000});
+    CORRADE_COMPARE(p.percentile(Profiler::otherSection, 99.0).count(), 0);
+
+    /* Enabling again resets the histograms */
+    p.enable();
+    CORRADE_COMPARE(p.maxTime(a).count(), 0);
+}
+
+void ProfilerTest::spikes() {
+    Profiler p;
+    const Profiler::Section a = p.addSection("A");
+    const Profiler::Section b = p.addSection("B");
+    CORRADE_COMPARE(p.spikeCapacity(), 0);
+
+    p.enable();
+    p.nextFrame();
+    CORRADE_VERIFY(p.spikes().empty());
+
+    p.disable();
+    p.setSpikeCapacity(2);
+    p.enable();
+    CORRADE_COMPARE(p.spikeCapacity(), 2);
+    CORRADE_VERIFY(p.spikes().empty());
+
+    for(std::size_t i = 0; i != 10; ++i) {
+        p.start(a);
+        spin(std::chrono::microseconds{i == 3 ? 3000 : 100});
+        p.start(b);
+        spin(std::chrono::microseconds{i == 7 ? 2000 : 100});
+        p.stop();
+        p.nextFrame();
+    }
+
+    const std::vector<Profiler::Spike> spikes = p.spikes();
+    CORRADE_COMPARE(spikes.size(), 2);
+    CORRADE_COMPARE(spikes[0].frame, 3);
+    CORRADE_VERIFY(spikes[0].duration >= std::chrono::microseconds{3100});
+    CORRADE_COMPARE(spikes[0].sections.size(), 3);
+    CORRADE_VERIFY(spikes[0].sections[a] >= std::chrono::microseconds{3000});
+    CORRADE_VERIFY(spikes[0].sections[b] < std::chrono::microseconds{2000});
+    CORRADE_COMPARE(spikes[1].frame, 7);
+    CORRADE_VERIFY(spikes[1].sections[b] >= std::chrono::microseconds{2000});
+}
+
+void ProfilerTest::captureDisabled() {
+    Profiler p;
+    const Profiler::Section a = p.addSection("A");
+    CORRADE_COMPARE(p.captureCapacity(), 0);
+
+    p.enable();
+    p.start(a);
+    p.push(a);
+    p.pop();
+    p.stop();
+    p.nextFrame();
+
+    CORRADE_VERIFY(p.capturedSamples().empty());
+}
+
+void ProfilerTest::capture() {
+    Profiler p;
+    const Profiler::Section a = p.addSection("A");
+    const Profiler::Section b = p.addSection("B");
+    p.setCaptureCapacity(16);
+    CORRADE_COMPARE(p.captureCapacity(), 16);
+
+    p.enable();
+    p.start(a);
+    p.start(b);
+    p.stop();
+    p.nextFrame();
+    p.start(b);
+    p.stop();
+    p.nextFrame();
+
+    const std::vector<Profiler::Sample> samples = p.capturedSamples();
+    CORRADE_COMPARE(samples.size(), 3);
+    CORRADE_COMPARE(samples[0].section, a);
+    CORRADE_COMPARE(samples[0].frame, 0);
+    CORRADE_COMPARE(samples[0].thread, 0);
+    CORRADE_COMPARE(samples[0].depth, 0);
+    CORRADE_COMPARE(samples[1].section, b);
+    CORRADE_COMPARE(samples[1].frame, 0);
+    CORRADE_VERIFY(samples[1].begin >= samples[0].begin + samples[0].duration);
+    CORRADE_COMPARE(samples[2].section, b);
+    CORRADE_COMPARE(samples[2].frame, 1);
+
+    /* Enabling again clears the capture */
+    p.disable();
+    p.enable();
+    CORRADE_VERIFY(p.capturedSamples().empty());
+}
+
+void ProfilerTest::captureNested() {
+    Profiler p;
+    const Profiler::Section a = p.addSection("A");
+    const Profiler::Section b = p.addSection("B");
+    p.setCaptureCapacity(16);
+
+    p.enable();
+    p.start(a);
+    {
+        Profiler::ScopedSection outer{p, b};
+        Profiler::ScopedSection inner{p, a};
+    }
+    p.stop();
+
+    /* Samples are ordered by their end */
+    const std::vector<Profiler::Sample> samples = p.capturedSamples();
+    CORRADE_COMPARE(samples.size(), 3);
+    CORRADE_COMPARE(samples[0].section, a);
+    CORRADE_COMPARE(samples[0].depth, 2);
+    CORRADE_COMPARE(samples[1].section, b);
+    CORRADE_COMPARE(samples[1].depth, 1);
+    CORRADE_COMPARE(samples[2].section, a);
+    CORRADE_COMPARE(samples[2].depth, 0);
+    CORRADE_VERIFY(samples[1].begin <= samples[0].begin);
+    CORRADE_VERIFY(samples[2].begin <= samples[1].begin);
+    CORRADE_VERIFY(samples[1].duration >= samples[0].duration);
+
+    /* Nested scopes don't affect the statistics */
+    p.nextFrame();
+    CORRADE_COMPARE(p.time(b).count(), 0);
+}
+
+void ProfilerTest::captureOverflow() {
+    Profiler p;
+    const Profiler::Section a = p.addSection("A");
+    p.setCaptureCapacity(3);
+
+    p.enable();
+    for(std::size_t i = 0; i != 5; ++i) {
+        p.push(a);
+        p.pop();
+        p.nextFrame();
+    }
+
+    /* Only the last three are kept, oldest first */
+    const std::vector<Profiler::Sample> samples = p.capturedSamples();
+    CORRADE_COMPARE(samples.size(), 3);
+    CORRADE_COMPARE(samples[0].frame, 2);
+    CORRADE_COMPARE(samples[1].frame, 3);
+    CORRADE_COMPARE(samples[2].frame, 4);
+}
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+void ProfilerTest::captureThreads() {
+    Profiler p;
+    const Profiler::Section a = p.addSection("A");
+    p.setCaptureCapacity(1024);
+
+    p.enable();
+    p.push(a);
+    std::thread worker{[&p, a]() {
+        for(std::size_t i = 0; i != 100; ++i) {
+            Profiler::ScopedSection scope{p, a};
+        }
+    }};
+    worker.join();
+    p.pop();
+
+    const std::vector<Profiler::Sample> samples = p.capturedSamples();
+    CORRADE_COMPARE(samples.size(), 101);
+    for(std::size_t i = 0; i != 100; ++i) {
+        CORRADE_COMPARE(samples[i].thread, 1);
+        CORRADE_COMPARE(samples[i].depth, 1);
+    }
+    CORRADE_COMPARE(samples[100].thread, 0);
+}
+#endif
+
+void ProfilerTest::chromeTrace() {
+    Profiler p;
+    const Profiler::Section a = p.addSection("Draw \"main\"");
+    p.setCaptureCapacity(16);
+
+    p.enable();
+    p.push(a);
+    p.pop();
+
+    const std::string trace = p.chromeTrace();
+    CORRADE_COMPARE(trace.find("{\"traceEvents\":[\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"Thread 0\"}},\n{\"name\":\"Draw \\\"main\\\"\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":"), 0);
+    CORRADE_VERIFY(trace.find(",\"args\":{\"frame\":0,\"depth\":1}}\n]}\n") != std::string::npos);
+}
+
+void ProfilerTest::csv() {
+    Profiler p;
+    const Profiler::Section a = p.addSection("A, \"B\"");
+    p.setCaptureCapacity(16);
+
+    p.enable();
+    p.nextFrame();
+    p.push(a);
+    p.pop();
+
+    const Profiler::Sample sample = p.capturedSamples()[0];
+    std::ostringstream expected;
+    expected << "frame,thread,depth,section,begin,duration\n"
+             << "1,0,1,\"A, \"\"B\"\"\"," << sample.begin.count() << ',' << sample.duration.count() << '\n';
+    CORRADE_COMPARE(p.csv(), expected.str());
+}
+
+void ProfilerTest::instrumentation() {
+    Profiler p;
+    p.setCaptureCapacity(16);
+    p.setInstrumentationEnabled(true);
+    CORRADE_VERIFY(p.isInstrumentationEnabled());
+
+    p.enable();
+    CORRADE_VERIFY(Instrumentation::listener());
+
+    const Profiler::Section meshDraw = p.instrumentationSection(Instrumentation::Zone::MeshDraw);
+    const Profiler::Section cameraDraw = p.instrumentationSection(Instrumentation::Zone::CameraDraw);
+
+    {
+        Instrumentation::ScopedZone a{Instrumentation::Zone::CameraDraw};
+        Instrumentation::ScopedZone b{Instrumentation::Zone::MeshDraw};
+        Instrumentation::count(Instrumentation::Counter::DrawCalls, 3);
+    }
+    p.nextFrame();
+    Instrumentation::count(Instrumentation::Counter::DrawCalls, 1);
+    p.nextFrame();
+
+    const std::vector<Profiler::Sample> samples = p.capturedSamples();
+    CORRADE_COMPARE(samples.size(), 2);
+    CORRADE_COMPARE(samples[0].section, meshDraw);
+    CORRADE_COMPARE(samples[0].depth, 2);
+    CORRADE_COMPARE(samples[1].section, cameraDraw);
+    CORRADE_COMPARE(samples[1].depth, 1);
+
+    CORRADE_COMPARE(p.counter(Instrumentation::Counter::DrawCalls), 2.0);
+    CORRADE_COMPARE(p.counter(Instrumentation::Counter::TextureBinds), 0.0);
+
+    p.disable();
+    CORRADE_VERIFY(!Instrumentation::listener());
+}
+
+void ProfilerTest::allocationTracking() {
+    Profiler p;
+    const Profiler::Section a = p.addSection("A");
+    const Profiler::Section b = p.addSection("B");
+    p.setAllocationTrackingEnabled(true);
+    CORRADE_VERIFY(p.isAllocationTrackingEnabled());
+
+    p.enable();
+    for(std::size_t i = 0; i != 2; ++i) {
+        p.start(a);
+        /* Calling the operators directly, new expressions can be optimized
+           out */
+        ::operator delete(::operator new(1000));
+        ::operator delete(::operator new(sizeof(int)));
+        p.start(b);
+        p.start();
+        p.nextFrame();
+    }
+
+    CORRADE_COMPARE(p.allocationCount(a), 2.0);
+    CORRADE_COMPARE(p.allocatedBytes(a), Double(1000 + sizeof(int)));
+    CORRADE_COMPARE(p.allocationCount(b), 0.0);
+    CORRADE_COMPARE(p.allocatedBytes(b), 0.0);
+}
+
+void ProfilerTest::allocationTrackingCapture() {
+    Profiler p;
+    const Profiler::Section a = p.addSection("A");
+    p.setCaptureCapacity(16);
+    p.setAllocationTrackingEnabled(true);
+
+    /* Reserve the track so its allocation isn't counted */
+    p.enable();
+    p.start();
+    p.stop();
+
+    p.start(a);
+    ::operator delete(::operator new(100));
+    p.stop();
+
+    const std::vector<Profiler::Sample> samples = p.capturedSamples();
+    CORRADE_COMPARE(samples.size(), 2);
+    CORRADE_COMPARE(samples[1].section, a);
+    CORRADE_COMPARE(samples[1].allocationCount, 1);
+    CORRADE_COMPARE(samples[1].allocatedBytes, 100);
+
+    const std::string trace = p.chromeTrace();
+    CORRADE_VERIFY(trace.find(",\"args\":{\"frame\":0,\"depth\":0,\"allocations\":1,\"allocatedBytes\":100}}\n]}\n") != std::string::npos);
+    CORRADE_COMPARE(p.csv().substr(0, p.csv().find('\n')), "frame,thread,depth,section,begin,duration,allocations,allocatedBytes");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::DebugTools::Test::ProfilerTest)
@@ -0,0 +1,472 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <tuple>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/Utility/Arguments.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Framebuffer.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/Renderbuffer.h"
+#include "Magnum/RenderbufferFormat.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/TimeQuery.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/MeshTools/Compile.h"
+#include "Magnum/Primitives/Cube.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/Shaders/Phong.h"
+#include "Magnum/Shaders/Vector.h"
+#include "Magnum/Shapes/Shape.h"
+#include "Magnum/Shapes/ShapeGroup.h"
+#include "Magnum/Shapes/Sphere.h"
+#include "Magnum/Text/AbstractFont.h"
+#include "Magnum/Text/GlyphCache.h"
+#include "Magnum/Text/Renderer.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+#ifdef MAGNUM_TARGET_HEADLESS
+#include "Magnum/Platform/WindowlessEglApplication.h"
+#elif defined(CORRADE_TARGET_APPLE)
+#include "Magnum/Platform/WindowlessCglApplication.h"
+#elif defined(CORRADE_TARGET_UNIX)
+#if defined(MAGNUM_TARGET_GLES) && !defined(MAGNUM_TARGET_DESKTOP_GLES)
+#include "Magnum/Platform/WindowlessEglApplication.h"
+#else
+#include "Magnum/Platform/WindowlessGlxApplication.h"
+#endif
+#elif defined(CORRADE_TARGET_WINDOWS)
+#if defined(MAGNUM_TARGET_GLES) && !defined(MAGNUM_TARGET_DESKTOP_GLES)
+#include "Magnum/Platform/WindowlessWindowsEglApplication.h"
+#else
+#include "Magnum/Platform/WindowlessWglApplication.h"
+#endif
+#else
+#error no windowless application available on this platform
+#endif
+
+#include "benchConfigure.h"
+
+namespace Magnum {
+
+/** @page magnum-bench Synthetic scene benchmark
+@brief Measures time spent in all engine subsystems on a generated scene
+
+@section magnum-bench-usage Usage
+
+    magnum-bench [--magnum-...] [-h|--help] [--objects N] [--depth N] [--drawables N] [--labels N] [--shapes N] [--frames N] [--warmup N] [--size "X Y"] [--flat-hierarchy] [--lazy-dirty] [--font FONT] [--font-file FILE] [--plugin-dir DIR] [--output FILE]
+
+Arguments:
+
+-   `-h`, `--help` -- display help message and exit
+-   `--objects N` -- count of objects in the scene (default: `1000`)
+-   `--depth N` -- depth of the object hierarchy (default: `4`)
+-   `--drawables N` -- count of objects with a drawable (default: `1000`)
+-   `--labels N` -- count of text labels rendered every frame (default: `0`)
+-   `--shapes N` -- count of objects with a collision shape (default: `0`)
+-   `--frames N` -- count of measured frames (default: `100`)
+-   `--warmup N` -- count of frames rendered before the measurement starts
+    (default: `10`)
+-   `--size "X Y"` -- framebuffer size (default: `1024 768`)
+-   `--flat-hierarchy` -- enable @ref SceneGraph-Scene-flat-hierarchy "flat transformation hierarchy"
+-   `--lazy-dirty` -- enable @ref SceneGraph-Scene-lazy-dirty "lazy dirty propagation"
+-   `--font FONT` -- font plugin used for text labels (default:
+    `FreeTypeFont`)
+-   `--font-file FILE` -- font file used for text labels, required if
+    `--labels` is not zero
+-   `--plugin-dir DIR` -- base plugin dir (defaults to plugin directory in
+    Magnum install location)
+-   `--output FILE` -- write the results into given file instead of standard
+    output
+-   `--magnum-...` -- engine-specific options (see @ref Context for details)
+
+The utility generates a scene with given count of objects organized into
+chains of given depth, rotates roots of all chains every frame and then
+measures these subsystems separately:
+
+-   `transformations` -- computing absolute transformations of all objects
+    using @ref SceneGraph::Object::setClean(std::vector<std::reference_wrapper<Object<Transformation>>>)
+-   `draw` -- @ref SceneGraph::Camera3D::draw() of all drawables, each using
+    @ref Shaders::Phong
+-   `text` -- updating all labels with @ref Text::Renderer2D::render() and
+    drawing them using @ref Shaders::Vector2D
+-   `collisions` -- @ref Shapes::ShapeGroup3D::setClean() and
+    @ref Shapes::ShapeGroup3D::collisionPairs() on all shapes
+-   `frame` -- sum of all of the above
+
+For each subsystem, average, minimal and maximal CPU time over all measured
+frames is reported in milliseconds. For `draw`, `text` and `frame`, GPU time
+measured with @ref TimeQuery is reported as well, if the driver supports
+timer queries. The results are printed as JSON, suitable for consumption by
+CI dashboards.
+
+@section magnum-bench-example Example usage
+
+    magnum-bench --objects 10000 --depth 8 --drawables 2000 --shapes 500 --frames 300 --output bench.json
+
+*/
+
+namespace DebugTools {
+
+namespace {
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+class PhongDrawable: public SceneGraph::Drawable3D {
+    public:
+        explicit PhongDrawable(Object3D& object, Shaders::Phong& shader, Mesh& mesh, const Color4& color, SceneGraph::DrawableGroup3D& drawables): SceneGraph::Drawable3D{object, &drawables}, _shader(shader), _mesh(mesh), _color{color} {}
+
+    private:
+        void draw(const Matrix4& transformationMatrix, SceneGraph::Camera3D& camera) override {
+            _shader.setDiffuseColor(_color)
+                .setTransformationMatrix(transformationMatrix)
+                .setNormalMatrix(transformationMatrix.rotationScaling())
+                .setProjectionMatrix(camera.projectionMatrix());
+            _mesh.draw(_shader);
+        }
+
+        Shaders::Phong& _shader;
+        Mesh& _mesh;
+        Color4 _color;
+};
+
+/* Times of one subsystem over all measured frames, in milliseconds */
+struct Timing {
+    void add(Double time) {
+        total += time;
+        min = std::min(min, time);
+        max = std::max(max, time);
+        ++count;
+    }
+
+    Double total{}, min{Constantsd::inf()}, max{};
+    UnsignedInt count{};
+};
+
+std::string jsonString(const std::string& string) {
+    std::string out = "\"";
+    for(const char c: string) {
+        if(c == '"' || c == '\\') out += '\\';
+        if(c == '\n') out += "\\n";
+        else if(std::size_t(c) >= ' ') out += c;
+    }
+    return out + '"';
+}
+
+void printTiming(std::ostream& out, const Timing& timing) {
+    if(!timing.count) {
+        out << "null";
+        return;
+    }
+
+    out << "{\"average\": " << timing.total/timing.count
+        << ", \"min\": " << timing.min
+        << ", \"max\": " << timing.max << "}";
+}
+
+Double millisecondsSince(const std::chrono::high_resolution_clock::time_point& start) {
+    return std::chrono::duration<Double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+}
+
+class Bench: public Platform::WindowlessApplication {
+    public:
+        explicit Bench(const Arguments& arguments);
+
+        int exec() override;
+
+    private:
+        Utility::Arguments args;
+};
+
+Bench::Bench(const Arguments& arguments): Platform::WindowlessApplication{arguments, NoCreate} {
+    args.addOption("objects", "1000").setHelp("objects", "count of objects in the scene", "N")
+        .addOption("depth", "4").setHelp("depth", "depth of the object hierarchy", "N")
+        .addOption("drawables", "1000").setHelp("drawables", "count of objects with a drawable", "N")
+        .addOption("labels", "0").setHelp("labels", "count of text labels rendered every frame", "N")
+        .addOption("shapes", "0").setHelp("shapes", "count of objects with a collision shape", "N")
+        .addOption("frames", "100").setHelp("frames", "count of measured frames", "N")
+        .addOption("warmup", "10").setHelp("warmup", "count of frames rendered before the measurement starts", "N")
+        .addOption("size", "1024 768").setHelp("size", "framebuffer size", "\"X Y\"")
+        .addBooleanOption("flat-hierarchy").setHelp("flat-hierarchy", "enable flat transformation hierarchy")
+        .addBooleanOption("lazy-dirty").setHelp("lazy-dirty", "enable lazy dirty propagation")
+        .addOption("font", "FreeTypeFont").setHelp("font", "font plugin used for text labels")
+        .addOption("font-file").setHelp("font-file", "font file used for text labels", "FILE")
+        .addOption("plugin-dir", Utility::Directory::join(Utility::Directory::path(Utility::Directory::executableLocation()), MAGNUM_PLUGINS_DIR)).setHelp("plugin-dir", "base plugin dir", "DIR")
+        .addOption("output").setHelp("output", "write the results into given file instead of standard output", "FILE")
+        .addSkippedPrefix("magnum", "engine-specific options")
+        .setHelp("Measures time spent in all engine subsystems on a generated scene.")
+        .parse(arguments.argc, arguments.argv);
+
+    createContext();
+}
+
+int Bench::exec() {
+    const UnsignedInt objectCount = args.value<UnsignedInt>("objects");
+    const UnsignedInt depth = std::max(args.value<UnsignedInt>("depth"), 1u);
+    const UnsignedInt drawableCount = std::min(args.value<UnsignedInt>("drawables"), objectCount);
+    const UnsignedInt labelCount = args.value<UnsignedInt>("labels");
+    const UnsignedInt shapeCount = std::min(args.value<UnsignedInt>("shapes"), objectCount);
+    const UnsignedInt frameCount = args.value<UnsignedInt>("frames");
+    const UnsignedInt warmupCount = args.value<UnsignedInt>("warmup");
+    const Vector2i size = args.value<Vector2i>("size");
+
+    /* Load the font, if there are any labels */
+    PluginManager::Manager<Text::AbstractFont> fontManager(Utility::Directory::join(args.value("plugin-dir"), "fonts/"));
+    std::unique_ptr<Text::AbstractFont> font;
+    std::unique_ptr<Text::GlyphCache> glyphCache;
+    if(labelCount) {
+        if(args.value("font-file").empty()) {
+            Error() << "The --font-file option is required for text labels";
+            return 1;
+        }
+
+        if(!(fontManager.load(args.value("font")) & PluginManager::LoadState::Loaded))
+            return 1;
+        font = fontManager.instance(args.value("font"));
+        if(!font->openFile(args.value("font-file"), 32.0f)) {
+            Error() << "Cannot open font" << args.value("font-file");
+            return 1;
+        }
+
+        if(font->features() & Text::AbstractFont::Feature::PreparedGlyphCache)
+            glyphCache = font->createGlyphCache();
+        else {
+            glyphCache.reset(new Text::GlyphCache{Vector2i{512}});
+            font->fillGlyphCache(*glyphCache, "abcdefghijklmnopqrstuvwxyz0123456789: ");
+        }
+    }
+
+    /* Render target */
+    Renderbuffer color, depthStencil;
+    #ifndef MAGNUM_TARGET_GLES2
+    color.setStorage(RenderbufferFormat::RGBA8, size);
+    #else
+    color.setStorage(RenderbufferFormat::RGBA4, size);
+    #endif
+    depthStencil.setStorage(RenderbufferFormat::DepthComponent16, size);
+    Framebuffer framebuffer{{{}, size}};
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment(0), color)
+        .attachRenderbuffer(Framebuffer::BufferAttachment::Depth, depthStencil)
+        .bind();
+    Renderer::enable(Renderer::Feature::DepthTest);
+
+    /* Scene with chains of objects, roots laid out on a grid */
+    Scene3D scene;
+    scene.setFlatHierarchyEnabled(args.isSet("flat-hierarchy"))
+        .setLazyDirtyEnabled(args.isSet("lazy-dirty"));
+    std::vector<std::reference_wrapper<Object3D>> objects;
+    std::vector<Object3D*> roots;
+    objects.reserve(objectCount);
+    const Int gridSize = Int(std::ceil(std::sqrt(Float(objectCount/depth + 1))));
+    for(UnsignedInt i = 0; i != objectCount; ++i) {
+        Object3D* object;
+        if(i % depth == 0) {
+            const Int root = i/depth;
+            object = new Object3D{&scene};
+            object->translate({Float(root % gridSize - gridSize/2)*2.0f, 0.0f, -Float(root/gridSize)*2.0f});
+            roots.push_back(object);
+        } else {
+            object = new Object3D{&objects.back().get()};
+            object->scale(Vector3{0.8f})
+                .translate(Vector3::yAxis(1.0f));
+        }
+        objects.push_back(*object);
+    }
+
+    Object3D cameraObject{&scene};
+    cameraObject.setTransformation(Matrix4::lookAt({0.0f, Float(gridSize), Float(gridSize)}, {0.0f, 0.0f, -Float(gridSize)}, Vector3::yAxis()));
+    SceneGraph::Camera3D camera{cameraObject};
+    camera.setAspectRatioPolicy(SceneGraph::AspectRatioPolicy::Extend)
+        .setProjectionMatrix(Matrix4::perspectiveProjection(Deg(60.0f), Vector2{size}.aspectRatio(), 0.1f, 1000.0f))
+        .setViewport(size);
+
+    /* Drawables */
+    Mesh cube{NoCreate};
+    std::unique_ptr<Buffer> cubeVertices, cubeIndices;
+    std::tie(cube, cubeVertices, cubeIndices) = MeshTools::compile(Primitives::Cube::solid(), BufferUsage::StaticDraw);
+    Shaders::Phong phong;
+    phong.setLightPosition({0.0f, 100.0f, 100.0f});
+    SceneGraph::DrawableGroup3D drawables;
+    for(UnsignedInt i = 0; i != drawableCount; ++i)
+        new PhongDrawable{objects[i], phong, cube, Color4::fromHsv(Deg(Float(i % 360)), 0.75f, 0.9f), drawables};
+
+    /* Collision shapes */
+    Shapes::ShapeGroup3D shapes;
+    for(UnsignedInt i = 0; i != shapeCount; ++i)
+        new Shapes::Shape<Shapes::Sphere3D>{objects[i], Shapes::Sphere3D{{}, 0.75f}, &shapes};
+
+    /* Text labels */
+    std::vector<std::unique_ptr<Text::Renderer2D>> labels;
+    Shaders::Vector2D vectorShader;
+    if(labelCount) {
+        vectorShader.setColor(Color4{1.0f})
+            .setVectorTexture(glyphCache->texture());
+        for(UnsignedInt i = 0; i != labelCount; ++i) {
+            labels.emplace_back(new Text::Renderer2D{*font, *glyphCache, 0.05f});
+            labels.back()->reserve(32, BufferUsage::DynamicDraw, BufferUsage::StaticDraw);
+        }
+    }
+
+    /* GPU timing, if supported */
+    #ifndef MAGNUM_TARGET_GLES
+    const bool gpuTiming = Context::current().isExtensionSupported<Extensions::GL::ARB::timer_query>();
+    #else
+    const bool gpuTiming = Context::current().isExtensionSupported<Extensions::GL::EXT::disjoint_timer_query>();
+    #endif
+    TimeQuery drawQuery{NoCreate}, textQuery{NoCreate};
+    if(gpuTiming) {
+        drawQuery = TimeQuery{TimeQuery::Target::TimeElapsed};
+        textQuery = TimeQuery{TimeQuery::Target::TimeElapsed};
+    }
+
+    Timing transformationsCpu, drawCpu, drawGpu, textCpu, textGpu, collisionsCpu, frameCpu, frameGpu;
+    std::size_t collisionPairCount = 0;
+    for(UnsignedInt frame = 0; frame != warmupCount + frameCount; ++frame) {
+        const bool measure = frame >= warmupCount;
+
+        /* Animation and transformation computation */
+        const auto frameStart = std::chrono::high_resolution_clock::now();
+        for(Object3D* root: roots) root->rotateYLocal(Deg(1.0f));
+        Object3D::setClean(objects);
+        const Double transformationsTime = millisecondsSince(frameStart);
+
+        /* Drawing */
+        auto start = std::chrono::high_resolution_clock::now();
+        framebuffer.clear(FramebufferClear::Color|FramebufferClear::Depth);
+        if(gpuTiming) drawQuery.begin();
+        camera.draw(drawables);
+        if(gpuTiming) drawQuery.end();
+        const Double drawTime = millisecondsSince(start);
+
+        /* Text */
+        start = std::chrono::high_resolution_clock::now();
+        const std::string text = "frame " + std::to_string(frame);
+        for(std::unique_ptr<Text::Renderer2D>& label: labels)
+            label->render(text);
+        if(gpuTiming) textQuery.begin();
+        for(std::size_t i = 0; i != labels.size(); ++i) {
+            vectorShader.setTransformationProjectionMatrix(Matrix3::translation({-0.9f, 0.9f - Float(i % 32)*0.05f}));
+            labels[i]->mesh().draw(vectorShader);
+        }
+        if(gpuTiming) textQuery.end();
+        const Double textTime = millisecondsSince(start);
+
+        /* Collisions */
+        start = std::chrono::high_resolution_clock::now();
+        shapes.setClean();
+        const std::size_t pairs = shapes.collisionPairs().size();
+        const Double collisionsTime = millisecondsSince(start);
+
+        const Double frameTime = millisecondsSince(frameStart);
+
+        if(!measure) continue;
+
+        transformationsCpu.add(transformationsTime);
+        drawCpu.add(drawTime);
+        textCpu.add(textTime);
+        collisionsCpu.add(collisionsTime);
+        frameCpu.add(frameTime);
+        collisionPairCount += pairs;
+
+        /* Waits for the GPU, outside of the measured CPU time */
+        if(gpuTiming) {
+            const Double drawGpuTime = drawQuery.result<UnsignedLong>()/1.0e6;
+            const Double textGpuTime = textQuery.result<UnsignedLong>()/1.0e6;
+            drawGpu.add(drawGpuTime);
+            textGpu.add(textGpuTime);
+            frameGpu.add(drawGpuTime + textGpuTime);
+        }
+    }
+
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(4)
+        << "{\n"
+        << "  \"renderer\": " << jsonString(Context::current().rendererString()) << ",\n"
+        << "  \"version\": " << jsonString(Context::current().versionString()) << ",\n"
+        << "  \"configuration\": {\"objects\": " << objectCount
+            << ", \"depth\": " << depth
+            << ", \"drawables\": " << drawableCount
+            << ", \"labels\": " << labelCount
+            << ", \"shapes\": " << shapeCount
+            << ", \"frames\": " << frameCount
+            << ", \"size\": [" << size.x() << ", " << size.y() << "]"
+            << ", \"flatHierarchy\": " << (args.isSet("flat-hierarchy") ? "true" : "false")
+            << ", \"lazyDirty\": " << (args.isSet("lazy-dirty") ? "true" : "false") << "},\n"
+        << "  \"collisionPairsPerFrame\": " << (frameCount ? Double(collisionPairCount)/frameCount : 0.0) << ",\n"
+        << "  \"subsystems\": {\n";
+
+    constexpr std::size_t SubsystemCount = 5;
+    const std::tuple<const char*, const Timing*, const Timing*> subsystems[SubsystemCount]{
+        std::make_tuple("transformations", &transformationsCpu, nullptr),
+        std::make_tuple("draw", &drawCpu, &drawGpu),
+        std::make_tuple("text", &textCpu, &textGpu),
+        std::make_tuple("collisions", &collisionsCpu, nullptr),
+        std::make_tuple("frame", &frameCpu, &frameGpu)
+    };
+    for(std::size_t i = 0; i != SubsystemCount; ++i) {
+        out << "    \"" << std::get<0>(subsystems[i]) << "\": {\"cpu\": ";
+        printTiming(out, *std::get<1>(subsystems[i]));
+        if(std::get<2>(subsystems[i])) {
+            out << ", \"gpu\": ";
+            printTiming(out, *std::get<2>(subsystems[i]));
+        }
+        out << "}" << (i + 1 != SubsystemCount ? ",\n" : "\n");
+    }
+    out << "  }\n}\n";
+
+    if(args.value("output").empty()) {
+        std::cout << out.str();
+        return 0;
+    }
+
+    std::ofstream file{args.value("output")};
+    if(!file.good()) {
+        Error() << "Cannot write to" << args.value("output");
+        return 2;
+    }
+    file << out.str();
+    return 0;
+}
+
+}}
+
+MAGNUM_WINDOWLESSAPPLICATION_MAIN(Magnum::DebugTools::Bench)
@@ -0,0 +1,342 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <atomic>
+#include <thread>
+#endif
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/Utility/Arguments.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/DebugTools/CompareImage.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/AbstractImageConverter.h"
+#include "Magnum/Trade/ImageData.h"
+
+#include "imagecompareConfigure.h"
+
+namespace Magnum {
+
+/**
+@page magnum-imagecompare Image comparison utility
+@brief Compares images and reports differences between them
+
+@section magnum-imagecompare-usage Usage
+
+    magnum-imagecompare [-h|--help] [--importer IMPORTER] [--converter CONVERTER] [--plugin-dir DIR] [--max-threshold T] [--mean-threshold T] [--delta DELTA] [--directories] [--threads N] [--early-out] [--] actual expected
+
+Arguments:
+
+-   `actual` -- actual image or directory with actual images
+-   `expected` -- expected image or directory with expected images
+-   `-h`, `--help` -- display this help message and exit
+-   `--importer IMPORTER` -- image importer plugin (default:
+    @ref Trade::AnyImageImporter "AnyImageImporter")
+-   `--converter CONVERTER` -- image converter plugin for the delta image
+    (default: @ref Trade::AnyImageConverter "AnyImageConverter")
+-   `--plugin-dir DIR` -- base plugin dir (defaults to plugin directory in
+    Magnum install location)
+-   `--max-threshold T` -- max delta threshold (default: `0.0`)
+-   `--mean-threshold T` -- mean delta threshold (default: `0.0`)
+-   `--delta DELTA` -- save a delta image visualization to given file or,
+    with `--directories`, to given directory
+-   `--directories` -- compare all images in the `actual` directory with
+    images of the same name in the `expected` directory
+-   `--threads N` -- max count of worker threads used for comparing
+    directories (default: `0`, i.e. one thread per CPU core)
+-   `--early-out` -- stop comparing an image on the first pixel above max
+    threshold
+
+The comparison is done the same way as in @ref DebugTools::CompareImage, see
+its documentation for more information about how the delta is calculated and
+what formats are supported. For each image the max and mean delta is
+printed together with count of pixels above the thresholds. The delta image
+visualization is of the same size as compared images, pixels with delta above
+max threshold are red, pixels with delta above mean threshold yellow and the
+rest is grayscale, with brightness corresponding to delta value. With
+`--early-out` the delta image contains only the part that was compared before
+stopping.
+
+When comparing directories, the images are processed in parallel, each thread
+having its own importer and converter instance. The `AnyImageImporter` and
+`AnyImageConverter` plugins load other plugins while processing, which is not
+thread-safe, so a concrete plugin needs to be specified when comparing on more
+than one thread. Large images compared one by one are processed in multiple
+threads instead.
+
+The utility returns non-zero exit code if any of the images is above the
+thresholds or failed to load.
+
+@section magnum-imagecompare-example Example usage
+
+Comparing all rendered images to golden images, allowing small differences,
+and saving delta images to `delta/`:
+
+    mkdir delta
+    magnum-imagecompare --importer TgaImporter --converter TgaImageConverter \
+        --max-threshold 2.5 --mean-threshold 0.1 --directories --delta delta \
+        rendered/ golden/
+
+*/
+
+}
+
+using namespace Magnum;
+
+namespace {
+
+enum class Status {
+    Passed,
+    AboveThresholds,
+    ImportFailed,
+    DifferentSize,
+    DifferentFormat,
+    UnsupportedFormat,
+    ExportFailed
+};
+
+struct Job {
+    std::string actual, expected, delta;
+    Status status;
+    Float max, mean;
+    std::size_t aboveMaxCount, aboveMeanCount;
+    Vector2i earlyOutPosition{-1};
+};
+
+struct Options {
+    Float maxThreshold, meanThreshold;
+    bool earlyOut;
+    UnsignedInt threadCount;
+};
+
+std::optional<Trade::ImageData2D> import(Trade::AbstractImporter& importer, const std::string& filename) {
+    std::optional<Trade::ImageData2D> image;
+    if(!importer.openFile(filename) || !(image = importer.image2D(0))) return {};
+    importer.close();
+    return image;
+}
+
+void compare(Trade::AbstractImporter& importer, Trade::AbstractImageConverter* const converter, const Options& options, Job& job) {
+    std::optional<Trade::ImageData2D> actual = import(importer, job.actual);
+    std::optional<Trade::ImageData2D> expected = import(importer, job.expected);
+    if(!actual || !expected) {
+        job.status = Status::ImportFailed;
+        return;
+    }
+
+    if(actual->isCompressed() || expected->isCompressed() || !DebugTools::Implementation::isPixelFormatSupported(expected->format(), expected->type())) {
+        job.status = Status::UnsupportedFormat;
+        return;
+    }
+    if(actual->size() != expected->size()) {
+        job.status = Status::DifferentSize;
+        return;
+    }
+    if(actual->format() != expected->format() || actual->type() != expected->type()) {
+        job.status = Status::DifferentFormat;
+        return;
+    }
+
+    std::vector<Float> delta;
+    if(options.earlyOut)
+        std::tie(delta, job.max, job.mean, job.earlyOutPosition) = DebugTools::Implementation::calculateImageDeltaEarlyOut(*actual, *expected, options.maxThreshold, options.threadCount);
+    else
+        std::tie(delta, job.max, job.mean) = DebugTools::Implementation::calculateImageDelta(*actual, *expected, options.threadCount);
+
+    job.aboveMaxCount = std::count_if(delta.begin(), delta.end(), [&](Float value) { return value > options.maxThreshold; });
+    job.aboveMeanCount = std::count_if(delta.begin(), delta.end(), [&](Float value) { return value > options.meanThreshold; });
+    job.status = job.earlyOutPosition != Vector2i{-1} || job.max > options.maxThreshold || job.mean > options.meanThreshold ?
+        Status::AboveThresholds : Status::Passed;
+
+    if(converter && !job.delta.empty() && !converter->exportToFile(DebugTools::Implementation::deltaHeatmap(delta, expected->size(), job.max, options.maxThreshold, options.meanThreshold), job.delta))
+        job.status = Status::ExportFailed;
+}
+
+std::string value(const Float value) {
+    std::ostringstream out;
+    out << std::setprecision(4) << value;
+    return out.str();
+}
+
+void print(const Options& options, const Job& job) {
+    Debug d;
+    d << job.actual << "vs" << job.expected << Debug::nospace << ":";
+    switch(job.status) {
+        case Status::ImportFailed:
+            d << "import failed";
+            return;
+        case Status::DifferentSize:
+            d << "different size";
+            return;
+        case Status::DifferentFormat:
+            d << "different format";
+            return;
+        case Status::UnsupportedFormat:
+            d << "unsupported format";
+            return;
+        case Status::Passed:
+        case Status::AboveThresholds:
+        case Status::ExportFailed:
+            break;
+    }
+
+    if(job.earlyOutPosition != Vector2i{-1}) {
+        d << "FAILED, delta" << value(job.max) << "at" << job.earlyOutPosition << "above max threshold" << value(options.maxThreshold);
+        return;
+    }
+
+    d << (job.status == Status::Passed ? "ok" : "FAILED") << Debug::nospace
+        << ", max" << value(job.max) << Debug::nospace << "/" << Debug::nospace << value(options.maxThreshold)
+        << Debug::nospace << ", mean" << value(job.mean) << Debug::nospace << "/" << Debug::nospace << value(options.meanThreshold)
+        << Debug::nospace << "," << job.aboveMaxCount << "pixels above max and"
+        << job.aboveMeanCount << "above mean threshold";
+    if(job.status == Status::ExportFailed)
+        d << Debug::nospace << ", cannot save delta image" << job.delta;
+}
+
+}
+
+int main(int argc, char** argv) {
+    Utility::Arguments args;
+    args.addArgument("actual").setHelp("actual", "actual image or directory with actual images")
+        .addArgument("expected").setHelp("expected", "expected image or directory with expected images")
+        .addOption("importer", "AnyImageImporter").setHelp("importer", "image importer plugin")
+        .addOption("converter", "AnyImageConverter").setHelp("converter", "image converter plugin for the delta image")
+        .addOption("plugin-dir", Utility::Directory::join(Utility::Directory::path(Utility::Directory::executableLocation()), MAGNUM_PLUGINS_DIR)).setHelp("plugin-dir", "base plugin dir", "DIR")
+        .addOption("max-threshold", "0.0").setHelp("max-threshold", "max delta threshold", "T")
+        .addOption("mean-threshold", "0.0").setHelp("mean-threshold", "mean delta threshold", "T")
+        .addOption("delta").setHelp("delta", "save a delta image visualization to given file or directory", "DELTA")
+        .addBooleanOption("directories").setHelp("directories", "compare all images of the same name in given directories")
+        .addOption("threads", "0").setHelp("threads", "max count of worker threads used for comparing directories", "N")
+        .addBooleanOption("early-out").setHelp("early-out", "stop comparing an image on the first pixel above max threshold")
+        .setHelp("Compares images and reports differences between them.")
+        .parse(argc, argv);
+
+    Options options{
+        args.value<Float>("max-threshold"),
+        args.value<Float>("mean-threshold"),
+        args.isSet("early-out"), 0};
+    if(options.meanThreshold > options.maxThreshold) {
+        Error() << "Max threshold can't be smaller than mean threshold";
+        return 1;
+    }
+
+    /* Gather the images to compare */
+    std::vector<Job> jobs;
+    if(args.isSet("directories")) {
+        for(const std::string& filename: Utility::Directory::list(args.value("actual"), Utility::Directory::Flag::SkipDotAndDotDot|Utility::Directory::Flag::SkipDirectories|Utility::Directory::Flag::SkipSpecial|Utility::Directory::Flag::SortAscending)) {
+            const std::string expected = Utility::Directory::join(args.value("expected"), filename);
+            if(!Utility::Directory::fileExists(expected)) {
+                Warning() << "Skipping" << filename << "not present in" << args.value("expected");
+                continue;
+            }
+
+            Job job;
+            job.actual = Utility::Directory::join(args.value("actual"), filename);
+            job.expected = expected;
+            if(!args.value("delta").empty())
+                job.delta = Utility::Directory::join(args.value("delta"), filename);
+            jobs.push_back(job);
+        }
+    } else {
+        Job job;
+        job.actual = args.value("actual");
+        job.expected = args.value("expected");
+        job.delta = args.value("delta");
+        jobs.push_back(job);
+    }
+
+    if(jobs.empty()) {
+        Error() << "No images to compare in" << args.value("actual");
+        return 1;
+    }
+
+    /* With more than one image, parallelize over the images and calculate
+       each delta on a single thread. Otherwise let the delta calculation
+       split the image itself. */
+    std::size_t threadCount = 1;
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    if(jobs.size() > 1) {
+        threadCount = args.value<std::size_t>("threads");
+        if(!threadCount) threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+        threadCount = std::min(threadCount, jobs.size());
+        options.threadCount = 1;
+    }
+    #endif
+
+    /* Load importer plugin and create all instances upfront, as the manager
+       is not thread-safe */
+    PluginManager::Manager<Trade::AbstractImporter> importerManager(Utility::Directory::join(args.value("plugin-dir"), "importers/"));
+    if(!(importerManager.load(args.value("importer")) & PluginManager::LoadState::Loaded))
+        return 1;
+    std::vector<std::unique_ptr<Trade::AbstractImporter>> importers;
+    for(std::size_t i = 0; i != threadCount; ++i)
+        importers.push_back(importerManager.instance(args.value("importer")));
+
+    /* Load converter plugin, if needed */
+    PluginManager::Manager<Trade::AbstractImageConverter> converterManager(Utility::Directory::join(args.value("plugin-dir"), "imageconverters/"));
+    std::vector<std::unique_ptr<Trade::AbstractImageConverter>> converters(threadCount);
+    if(!args.value("delta").empty()) {
+        if(!(converterManager.load(args.value("converter")) & PluginManager::LoadState::Loaded))
+            return 1;
+        for(std::unique_ptr<Trade::AbstractImageConverter>& converter: converters)
+            converter = converterManager.instance(args.value("converter"));
+    }
+
+    /* Each thread takes the next unprocessed image until there's none left */
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    std::atomic<std::size_t> next{0};
+    auto worker = [&](const std::size_t thread) {
+        for(std::size_t i; (i = next++) < jobs.size(); )
+            compare(*importers[thread], converters[thread].get(), options, jobs[i]);
+    };
+    std::vector<std::thread> threads;
+    for(std::size_t i = 1; i < threadCount; ++i)
+        threads.emplace_back(worker, i);
+    worker(0);
+    for(std::thread& thread: threads) thread.join();
+    #else
+    for(Job& job: jobs)
+        compare(*importers[0], converters[0].get(), options, job);
+    #endif
+
+    std::size_t failed = 0;
+    for(const Job& job: jobs) {
+        print(options, job);
+        if(job.status != Status::Passed) ++failed;
+    }
+
+    if(jobs.size() > 1)
+        Debug() << failed << "of" << jobs.size() << "images failed the comparison";
+
+    return failed ? 1 : 0;
+}
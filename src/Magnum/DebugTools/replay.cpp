@@ -0,0 +1,219 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <Corrade/Utility/Arguments.h>
+
+#include "Magnum/Context.h"
+#include "Magnum/Framebuffer.h"
+#include "Magnum/Renderbuffer.h"
+#include "Magnum/RenderbufferFormat.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/DebugTools/GLTrace.h"
+
+#ifdef MAGNUM_TARGET_HEADLESS
+#include "Magnum/Platform/WindowlessEglApplication.h"
+#elif defined(CORRADE_TARGET_APPLE)
+#include "Magnum/Platform/WindowlessCglApplication.h"
+#elif defined(CORRADE_TARGET_UNIX)
+#include "Magnum/Platform/WindowlessGlxApplication.h"
+#elif defined(CORRADE_TARGET_WINDOWS)
+#include "Magnum/Platform/WindowlessWglApplication.h"
+#else
+#error no windowless application available on this platform
+#endif
+
+namespace Magnum {
+
+/** @page magnum-replay OpenGL call trace replay
+@brief Replays traces captured with @ref DebugTools::GLTrace and measures them
+
+@section magnum-replay-usage Usage
+
+    magnum-replay [--magnum-...] [-h|--help] [--repeat N] [--top N] [--size "X Y"] [--output FILE] trace
+
+Arguments:
+
+-   `trace` -- trace file captured with @ref DebugTools::GLTrace
+-   `-h`, `--help` -- display help message and exit
+-   `--repeat N` -- how many times to replay each frame after the first one
+    (default: `10`)
+-   `--top N` -- count of most expensive functions to report (default: `10`)
+-   `--size "X Y"` -- size of the framebuffer used in place of the default
+    framebuffer (default: `1024 768`)
+-   `--output FILE` -- write the results into given file instead of standard
+    output
+-   `--magnum-...` -- engine-specific options (see @ref Context for details)
+
+The utility replays the trace on a windowless context, rendering into an
+offscreen framebuffer with RGBA8 color and 24-bit depth with 8-bit stencil
+attachments. The first frame is played once, as it usually creates the
+objects used by the following frames, all other frames are then played
+repeatedly. For each frame count of calls and average, minimal and maximal
+time including @ref Renderer::finish() is reported in milliseconds, together
+with the functions taking most CPU time in the repeated frames. The results
+are printed as JSON, suitable for comparing against a baseline on CI.
+
+Calls of functions not known to this version of the engine are skipped and
+their count is reported. As the trace doesn't include calls that bypass the
+engine function pointers, the numbers are useful mainly for comparing
+different drivers or engine versions on the same trace, not as an absolute
+measure. See @ref DebugTools::GLTrace for details.
+
+@section magnum-replay-example Example usage
+
+Replaying each frame of a trace hundred times and saving the report:
+
+    magnum-replay --repeat 100 --output replay.json frames.trace
+
+@requires_gl OpenGL call trace replay is available only on desktop OpenGL.
+*/
+
+namespace DebugTools {
+
+namespace {
+
+/* Times of one frame over all repetitions, in milliseconds */
+struct Timing {
+    void add(Double time) {
+        total += time;
+        min = std::min(min, time);
+        max = std::max(max, time);
+        ++count;
+    }
+
+    Double total{}, min{Constantsd::inf()}, max{};
+    UnsignedInt count{};
+};
+
+std::string jsonString(const std::string& string) {
+    std::string out = "\"";
+    for(const char c: string) {
+        if(c == '"' || c == '\\') out += '\\';
+        if(c == '\n') out += "\\n";
+        else if(std::size_t(c) >= ' ') out += c;
+    }
+    return out + '"';
+}
+
+}
+
+class Replay: public Platform::WindowlessApplication {
+    public:
+        explicit Replay(const Arguments& arguments);
+
+        int exec() override;
+
+    private:
+        Utility::Arguments args;
+};
+
+Replay::Replay(const Arguments& arguments): Platform::WindowlessApplication{arguments, NoCreate} {
+    args.addArgument("trace").setHelp("trace", "trace file captured with DebugTools::GLTrace")
+        .addOption("repeat", "10").setHelp("repeat", "how many times to replay each frame after the first one", "N")
+        .addOption("top", "10").setHelp("top", "count of most expensive functions to report", "N")
+        .addOption("size", "1024 768").setHelp("size", "size of the framebuffer used in place of the default framebuffer", "\"X Y\"")
+        .addOption("output").setHelp("output", "write the results into given file instead of standard output", "FILE")
+        .addSkippedPrefix("magnum", "engine-specific options")
+        .setHelp("Replays OpenGL call traces and measures time spent in each frame.")
+        .parse(arguments.argc, arguments.argv);
+
+    createContext();
+}
+
+int Replay::exec() {
+    const UnsignedInt repeatCount = std::max(args.value<UnsignedInt>("repeat"), 1u);
+    const std::size_t topCount = args.value<std::size_t>("top");
+    const Vector2i size = args.value<Vector2i>("size");
+
+    GLTraceReplay replay;
+    if(!replay.openFile(args.value("trace"))) return 1;
+
+    /* Render target in place of the default framebuffer */
+    Renderbuffer color, depthStencil;
+    color.setStorage(RenderbufferFormat::RGBA8, size);
+    depthStencil.setStorage(RenderbufferFormat::Depth24Stencil8, size);
+    Framebuffer framebuffer{{{}, size}};
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment(0), color)
+        .attachRenderbuffer(Framebuffer::BufferAttachment::DepthStencil, depthStencil)
+        .bind();
+    replay.setDefaultFramebuffer(framebuffer.id());
+
+    /* The first frame creates the objects, so it's not repeated and isn't
+       part of the per-function statistics unless it's the only one */
+    std::vector<Timing> frames(replay.frameCount());
+    for(UnsignedInt i = 0; i != replay.frameCount(); ++i) {
+        for(UnsignedInt j = 0, count = i ? repeatCount : 1; j != count; ++j)
+            frames[i].add(replay.playFrame(i));
+        if(i == 0 && replay.frameCount() > 1) replay.resetStatistics();
+    }
+
+    std::vector<GLTraceReplay::FunctionStatistics> statistics = replay.statistics();
+    if(statistics.size() > topCount) statistics.resize(topCount);
+
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(4)
+        << "{\n"
+        << "  \"renderer\": " << jsonString(Context::current().rendererString()) << ",\n"
+        << "  \"version\": " << jsonString(Context::current().versionString()) << ",\n"
+        << "  \"configuration\": {\"trace\": " << jsonString(args.value("trace"))
+            << ", \"repeat\": " << repeatCount
+            << ", \"size\": [" << size.x() << ", " << size.y() << "]},\n"
+        << "  \"skippedCalls\": " << replay.skippedCount() << ",\n"
+        << "  \"frames\": [";
+    for(UnsignedInt i = 0; i != frames.size(); ++i)
+        out << (i ? ",\n" : "\n") << "    {\"calls\": " << replay.callCount(i)
+            << ", \"average\": " << frames[i].total/frames[i].count
+            << ", \"min\": " << frames[i].min
+            << ", \"max\": " << frames[i].max << "}";
+    out << (frames.empty() ? "],\n" : "\n  ],\n")
+        << "  \"functions\": [";
+    for(std::size_t i = 0; i != statistics.size(); ++i)
+        out << (i ? ",\n" : "\n") << "    {\"name\": " << jsonString(statistics[i].name)
+            << ", \"calls\": " << statistics[i].count
+            << ", \"time\": " << statistics[i].time << "}";
+    out << (statistics.empty() ? "]\n" : "\n  ]\n") << "}\n";
+
+    if(args.value("output").empty()) {
+        std::cout << out.str();
+        return 0;
+    }
+
+    std::ofstream file{args.value("output")};
+    if(!file.good()) {
+        Error() << "Cannot write to" << args.value("output");
+        return 2;
+    }
+    file << out.str();
+    return 0;
+}
+
+}}
+
+MAGNUM_WINDOWLESSAPPLICATION_MAIN(Magnum::DebugTools::Replay)
@@ -0,0 +1,174 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DirtyRegion.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <Corrade/Utility/Assert.h>
+
+namespace Magnum {
+
+DirtyRanges& DirtyRanges::add(const std::size_t offset, const std::size_t size) {
+    if(!size) return *this;
+
+    /* Sequential writes just extend the last range in place, keeping the
+       list coalesced */
+    if(_coalesced && !_ranges.empty()) {
+        std::pair<std::size_t, std::size_t>& last = _ranges.back();
+        const std::size_t end = last.first + last.second;
+        if(offset >= last.first && offset <= end + _mergeDistance) {
+            last.second = std::max(end, offset + size) - last.first;
+            return *this;
+        }
+
+        if(offset < last.first) _coalesced = false;
+    }
+
+    _ranges.emplace_back(offset, size);
+    return *this;
+}
+
+void DirtyRanges::coalesce() {
+    if(_coalesced) return;
+    _coalesced = true;
+    if(_ranges.empty()) return;
+
+    std::sort(_ranges.begin(), _ranges.end());
+
+    std::size_t out = 0;
+    for(std::size_t i = 1; i != _ranges.size(); ++i) {
+        std::pair<std::size_t, std::size_t>& last = _ranges[out];
+        const std::pair<std::size_t, std::size_t>& range = _ranges[i];
+        if(range.first <= last.first + last.second + _mergeDistance)
+            last.second = std::max(last.first + last.second, range.first + range.second) - last.first;
+        else _ranges[++out] = range;
+    }
+
+    _ranges.resize(out + 1);
+}
+
+Containers::ArrayView<const std::pair<std::size_t, std::size_t>> DirtyRanges::ranges() {
+    coalesce();
+    return {_ranges.data(), _ranges.size()};
+}
+
+std::size_t DirtyRanges::size() {
+    coalesce();
+    std::size_t size = 0;
+    for(const std::pair<std::size_t, std::size_t>& range: _ranges)
+        size += range.second;
+    return size;
+}
+
+namespace {
+
+inline std::size_t rectangleArea(const Range2Di& rectangle) {
+    return std::size_t(rectangle.sizeX())*std::size_t(rectangle.sizeY());
+}
+
+/* Area wasted by replacing the two rectangles with their bounding rectangle,
+   negative if they overlap enough that merging saves uploads */
+inline std::int64_t mergeWaste(const Range2Di& a, const Range2Di& b) {
+    return std::int64_t(rectangleArea(Math::join(a, b))) - std::int64_t(rectangleArea(a)) - std::int64_t(rectangleArea(b));
+}
+
+}
+
+DirtyRectangles::DirtyRectangles(const std::size_t maxCount, const std::size_t mergeArea): _maxCount{maxCount}, _mergeArea{mergeArea}, _coalesced{true} {
+    CORRADE_ASSERT(maxCount, "DirtyRectangles: expected non-zero max count", );
+}
+
+DirtyRectangles& DirtyRectangles::setMaxCount(const std::size_t count) {
+    CORRADE_ASSERT(count, "DirtyRectangles::setMaxCount(): expected non-zero max count", *this);
+    _maxCount = count;
+    _coalesced = false;
+    return *this;
+}
+
+DirtyRectangles& DirtyRectangles::add(const Range2Di& rectangle) {
+    if(rectangle.sizeX() <= 0 || rectangle.sizeY() <= 0) return *this;
+
+    _rectangles.push_back(rectangle);
+    _coalesced = false;
+    return *this;
+}
+
+void DirtyRectangles::coalesce() {
+    if(_coalesced) return;
+    _coalesced = true;
+
+    /* First merge everything that doesn't waste more than the allowed area,
+       repeat until nothing changes as a merge can enable further merges */
+    for(bool merged = true; merged; ) {
+        merged = false;
+        for(std::size_t i = 0; i < _rectangles.size(); ++i) {
+            for(std::size_t j = i + 1; j < _rectangles.size(); ) {
+                if(mergeWaste(_rectangles[i], _rectangles[j]) <= std::int64_t(_mergeArea)) {
+                    _rectangles[i] = Math::join(_rectangles[i], _rectangles[j]);
+                    _rectangles[j] = _rectangles.back();
+                    _rectangles.pop_back();
+                    merged = true;
+                } else ++j;
+            }
+        }
+    }
+
+    /* Then merge the cheapest pairs until the count fits */
+    while(_rectangles.size() > _maxCount) {
+        std::size_t bestI = 0, bestJ = 1;
+        std::int64_t bestWaste = std::numeric_limits<std::int64_t>::max();
+        for(std::size_t i = 0; i != _rectangles.size(); ++i) {
+            for(std::size_t j = i + 1; j != _rectangles.size(); ++j) {
+                const std::int64_t waste = mergeWaste(_rectangles[i], _rectangles[j]);
+                if(waste < bestWaste) {
+                    bestWaste = waste;
+                    bestI = i;
+                    bestJ = j;
+                }
+            }
+        }
+
+        _rectangles[bestI] = Math::join(_rectangles[bestI], _rectangles[bestJ]);
+        _rectangles[bestJ] = _rectangles.back();
+        _rectangles.pop_back();
+    }
+}
+
+Containers::ArrayView<const Range2Di> DirtyRectangles::rectangles() {
+    coalesce();
+    return {_rectangles.data(), _rectangles.size()};
+}
+
+std::size_t DirtyRectangles::area() {
+    coalesce();
+    std::size_t area = 0;
+    for(const Range2Di& rectangle: _rectangles)
+        area += rectangleArea(rectangle);
+    return area;
+}
+
+}
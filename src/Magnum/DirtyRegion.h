@@ -0,0 +1,231 @@
+#ifndef Magnum_DirtyRegion_h
+#define Magnum_DirtyRegion_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::DirtyRanges, @ref Magnum::DirtyRectangles
+ */
+
+#include <utility>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum {
+
+/**
+@brief Dirty byte range tracker
+
+Collects byte ranges modified since last upload and coalesces them into a
+minimal sorted set of disjoint ranges. Ranges that overlap, touch or are
+closer to each other than @ref mergeDistance() are merged, as uploading a few
+unchanged bytes is usually cheaper than issuing another upload call.
+@code
+DirtyRanges ranges;
+ranges.add(16, 8);
+ranges.add(24, 4);
+ranges.add(100, 10);
+
+// ranges.ranges() is now {{16, 12}, {100, 10}}
+@endcode
+
+Used by @ref MirroredBuffer, but usable also standalone.
+@see @ref DirtyRectangles
+*/
+class MAGNUM_EXPORT DirtyRanges {
+    public:
+        /**
+         * @brief Constructor
+         * @param mergeDistance     Largest gap in bytes between two ranges
+         *      that still gets merged
+         */
+        explicit DirtyRanges(std::size_t mergeDistance = 0): _mergeDistance{mergeDistance}, _coalesced{true} {}
+
+        /** @brief Largest gap between ranges that still gets merged */
+        std::size_t mergeDistance() const { return _mergeDistance; }
+
+        /**
+         * @brief Set largest gap between ranges that still gets merged
+         * @return Reference to self (for method chaining)
+         *
+         * Default is `0`, which merges only overlapping and adjacent ranges.
+         */
+        DirtyRanges& setMergeDistance(std::size_t distance) {
+            _mergeDistance = distance;
+            _coalesced = false;
+            return *this;
+        }
+
+        /** @brief Whether there are no dirty ranges */
+        bool isEmpty() const { return _ranges.empty(); }
+
+        /**
+         * @brief Mark a range as dirty
+         * @return Reference to self (for method chaining)
+         *
+         * Empty ranges are ignored.
+         */
+        DirtyRanges& add(std::size_t offset, std::size_t size);
+
+        /**
+         * @brief Coalesced dirty ranges
+         *
+         * Pairs of offset and size, sorted by offset and not overlapping each
+         * other.
+         */
+        Containers::ArrayView<const std::pair<std::size_t, std::size_t>> ranges();
+
+        /**
+         * @brief Dirty size in bytes
+         *
+         * Sum of sizes of all coalesced ranges, including gaps merged because
+         * of @ref mergeDistance().
+         */
+        std::size_t size();
+
+        /**
+         * @brief Clear all ranges
+         * @return Reference to self (for method chaining)
+         */
+        DirtyRanges& clear() {
+            _ranges.clear();
+            _coalesced = true;
+            return *this;
+        }
+
+    private:
+        void coalesce();
+
+        std::size_t _mergeDistance;
+        bool _coalesced;
+        std::vector<std::pair<std::size_t, std::size_t>> _ranges;
+};
+
+/**
+@brief Dirty rectangle tracker
+
+Collects rectangles modified since last upload and coalesces them. Two
+rectangles are merged if their bounding rectangle is not larger than
+their areas together plus @ref mergeArea(), so overlapping and adjacent
+rectangles become a single one while distant rectangles stay separate. If
+there are still more than @ref maxCount() rectangles after that, the pairs
+that waste the least area are merged until the count fits.
+@code
+DirtyRectangles rectangles;
+rectangles.add({{0, 0}, {16, 8}});
+rectangles.add({{0, 8}, {16, 16}});
+rectangles.add({{100, 100}, {110, 110}});
+
+// rectangles.rectangles() is now {{{0, 0}, {16, 16}}, {{100, 100}, {110, 110}}}
+@endcode
+
+Used by @ref MirroredTexture2D, but usable also standalone.
+@see @ref DirtyRanges
+*/
+class MAGNUM_EXPORT DirtyRectangles {
+    public:
+        /**
+         * @brief Constructor
+         * @param maxCount      Max count of rectangles after coalescing.
+         *      Expected to be non-zero.
+         * @param mergeArea     Area in pixels that is allowed to be wasted by
+         *      merging two rectangles
+         */
+        explicit DirtyRectangles(std::size_t maxCount = 16, std::size_t mergeArea = 0);
+
+        /** @brief Max count of rectangles after coalescing */
+        std::size_t maxCount() const { return _maxCount; }
+
+        /**
+         * @brief Set max count of rectangles after coalescing
+         * @return Reference to self (for method chaining)
+         *
+         * Expected to be non-zero. Default is `16`.
+         */
+        DirtyRectangles& setMaxCount(std::size_t count);
+
+        /** @brief Area allowed to be wasted by merging two rectangles */
+        std::size_t mergeArea() const { return _mergeArea; }
+
+        /**
+         * @brief Set area allowed to be wasted by merging two rectangles
+         * @return Reference to self (for method chaining)
+         *
+         * Default is `0`.
+         */
+        DirtyRectangles& setMergeArea(std::size_t area) {
+            _mergeArea = area;
+            _coalesced = false;
+            return *this;
+        }
+
+        /** @brief Whether there are no dirty rectangles */
+        bool isEmpty() const { return _rectangles.empty(); }
+
+        /**
+         * @brief Mark a rectangle as dirty
+         * @return Reference to self (for method chaining)
+         *
+         * Empty rectangles are ignored.
+         */
+        DirtyRectangles& add(const Range2Di& rectangle);
+
+        /** @brief Coalesced dirty rectangles */
+        Containers::ArrayView<const Range2Di> rectangles();
+
+        /**
+         * @brief Dirty area in pixels
+         *
+         * Sum of areas of all coalesced rectangles. Pixels covered by
+         * multiple rectangles are counted multiple times, as they are
+         * uploaded multiple times.
+         */
+        std::size_t area();
+
+        /**
+         * @brief Clear all rectangles
+         * @return Reference to self (for method chaining)
+         */
+        DirtyRectangles& clear() {
+            _rectangles.clear();
+            _coalesced = true;
+            return *this;
+        }
+
+    private:
+        void coalesce();
+
+        std::size_t _maxCount, _mergeArea;
+        bool _coalesced;
+        std::vector<Range2Di> _rectangles;
+};
+
+}
+
+#endif
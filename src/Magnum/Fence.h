@@ -0,0 +1,183 @@
+#ifndef Magnum_Fence_h
+#define Magnum_Fence_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MAGNUM_TARGET_GLES2
+/** @file
+ * @brief Class @ref Magnum::Fence
+ */
+#endif
+
+#include <cstdint>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/OpenGL.h"
+#include "Magnum/visibility.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+namespace Magnum {
+
+/**
+@brief Fence sync object
+
+Allows the application to find out whether OpenGL finished processing all
+commands submitted before the fence was inserted. Useful mainly for
+synchronizing access to persistently mapped buffers, see @ref BufferRing for
+an example. Basic usage:
+@code
+Fence fence;
+// submit commands reading from a mapped buffer...
+fence.insert();
+
+// later, before overwriting the buffer contents
+fence.clientWait();
+@endcode
+
+Unlike other OpenGL objects, the sync object is created only when the fence
+is inserted (and deleted on subsequent insertion or on destruction), a
+default-constructed instance doesn't have any OpenGL object associated.
+@requires_gl32 Extension @extension{ARB,sync}
+@requires_gles30 Sync objects are not available in OpenGL ES 2.0.
+@requires_webgl20 Sync objects are not available in WebGL 1.0.
+*/
+class MAGNUM_EXPORT Fence {
+    public:
+        /**
+         * @brief Wait result
+         *
+         * @see @ref clientWait()
+         */
+        enum class WaitResult: GLenum {
+            /** The fence was already signaled when the wait was started. */
+            AlreadySignaled = GL_ALREADY_SIGNALED,
+
+            /** The fence was signaled before the timeout expired. */
+            ConditionSatisfied = GL_CONDITION_SATISFIED,
+
+            /** The fence wasn't signaled before the timeout expired. */
+            TimeoutExpired = GL_TIMEOUT_EXPIRED,
+
+            /** An error occured. */
+            WaitFailed = GL_WAIT_FAILED
+        };
+
+        /**
+         * @brief Constructor
+         *
+         * Doesn't create any OpenGL object, the sync object is created on
+         * @ref insert().
+         */
+        explicit Fence() noexcept: _sync{} {}
+
+        /** @brief Copying is not allowed */
+        Fence(const Fence&) = delete;
+
+        /** @brief Move constructor */
+        Fence(Fence&& other) noexcept: _sync{other._sync} {
+            other._sync = {};
+        }
+
+        /**
+         * @brief Destructor
+         *
+         * Deletes associated OpenGL sync object, if any.
+         * @see @fn_gl{DeleteSync}
+         */
+        ~Fence();
+
+        /** @brief Copying is not allowed */
+        Fence& operator=(const Fence&) = delete;
+
+        /** @brief Move assignment */
+        Fence& operator=(Fence&& other) noexcept;
+
+        /** @brief OpenGL sync object */
+        GLsync sync() const { return _sync; }
+
+        /**
+         * @brief Whether the fence was inserted
+         *
+         * @see @ref insert()
+         */
+        bool isInserted() const { return _sync != nullptr; }
+
+        /**
+         * @brief Insert the fence into command stream
+         * @return Reference to self (for method chaining)
+         *
+         * Deletes previously inserted sync object, if any, and creates a new
+         * one which gets signaled once all commands submitted before it are
+         * completed.
+         * @see @fn_gl{DeleteSync}, @fn_gl{FenceSync} with
+         *      @def_gl{SYNC_GPU_COMMANDS_COMPLETE}
+         */
+        Fence& insert();
+
+        /**
+         * @brief Whether the fence is signaled
+         *
+         * Doesn't block. Returns `true` also if the fence wasn't
+         * inserted at all.
+         * @see @fn_gl{GetSync} with @def_gl{SYNC_STATUS}
+         */
+        bool isSignaled();
+
+        /**
+         * @brief Wait on the client for the fence to be signaled
+         * @param timeout   Timeout in nanoseconds
+         *
+         * Flushes the command stream so the wait can't deadlock and blocks
+         * until the fence is signaled or the timeout expires. If the fence
+         * wasn't inserted, returns @ref WaitResult::AlreadySignaled.
+         * @note In WebGL 2.0 the timeout must be `0`.
+         * @see @ref wait(), @fn_gl{ClientWaitSync} with
+         *      @def_gl{SYNC_FLUSH_COMMANDS_BIT}
+         */
+        WaitResult clientWait(std::uint64_t timeout = GL_TIMEOUT_IGNORED);
+
+        /**
+         * @brief Wait on the server for the fence to be signaled
+         *
+         * Doesn't block the client, only makes OpenGL not process further
+         * commands until the fence is signaled. Does nothing if the fence
+         * wasn't inserted.
+         * @see @ref clientWait(), @fn_gl{WaitSync}
+         */
+        void wait();
+
+    private:
+        GLsync _sync;
+};
+
+/** @debugoperatorclassenum{Magnum::Fence,Magnum::Fence::WaitResult} */
+MAGNUM_EXPORT Debug& operator<<(Debug& debug, Fence::WaitResult value);
+
+}
+#else
+#error this header is not available in OpenGL ES 2.0 build
+#endif
+
+#endif
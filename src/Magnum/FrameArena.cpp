@@ -0,0 +1,91 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FrameArena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <Corrade/Utility/Assert.h>
+
+namespace Magnum {
+
+FrameArena::FrameArena(const std::size_t capacity): _data{Containers::NoInit, capacity}, _used{0}, _overflowSize{0} {}
+
+FrameArena::FrameArena(FrameArena&& other) noexcept: _data{std::move(other._data)}, _used{other._used}, _overflowSize{other._overflowSize}, _overflow{std::move(other._overflow)} {
+    other._used = 0;
+    other._overflowSize = 0;
+    other._overflow.clear();
+}
+
+FrameArena::~FrameArena() = default;
+
+FrameArena& FrameArena::operator=(FrameArena&& other) noexcept {
+    using std::swap;
+    swap(_data, other._data);
+    swap(_used, other._used);
+    swap(_overflowSize, other._overflowSize);
+    swap(_overflow, other._overflow);
+    return *this;
+}
+
+void* FrameArena::allocate(const std::size_t size, const std::size_t alignment) {
+    CORRADE_ASSERT(alignment && !(alignment & (alignment - 1)),
+        "FrameArena::allocate(): alignment" << alignment << "is not a power of two", nullptr);
+
+    /* Fits into the preallocated block */
+    const std::size_t offset = (reinterpret_cast<std::uintptr_t>(_data.data()) + _used + alignment - 1)/alignment*alignment - reinterpret_cast<std::uintptr_t>(_data.data());
+    if(offset + size <= _data.size()) {
+        _used = offset + size;
+        return _data + offset;
+    }
+
+    /* Otherwise allocate from the heap, with enough padding for the
+       alignment. The block is enlarged on next reset(). */
+    _overflow.emplace_back(Containers::NoInit, size + alignment - 1);
+    _overflowSize += size + alignment - 1;
+    const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(_overflow.back().data());
+    return reinterpret_cast<void*>((address + alignment - 1)/alignment*alignment);
+}
+
+void FrameArena::deallocate(void* const memory, const std::size_t size) {
+    /* Roll back the last allocation from the block, otherwise nothing */
+    char* const data = static_cast<char*>(memory);
+    if(data && data + size == _data + _used && data >= _data.data())
+        _used = data - _data.data();
+}
+
+void FrameArena::reset() {
+    /* The frame didn't fit, enlarge the block so the next one does */
+    if(!_overflow.empty()) {
+        const std::size_t capacity = std::max(_data.size()*2, _used + _overflowSize);
+        _overflow.clear();
+        _data = Containers::Array<char>{Containers::NoInit, capacity};
+    }
+
+    _used = 0;
+    _overflowSize = 0;
+}
+
+}
@@ -0,0 +1,213 @@
+#ifndef Magnum_FrameArena_h
+#define Magnum_FrameArena_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::FrameArena, @ref Magnum::FrameArenaAllocator, alias @ref Magnum::FrameArenaVector
+ */
+
+#include <cstddef>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum {
+
+/**
+@brief Frame arena
+
+Linear allocator for short-lived data that are needed only during one frame.
+Allocation is just a pointer bump in a preallocated block, deallocation does
+nothing (except for the last allocation, which is rolled back) and all memory
+is released at once with @ref reset(), usually at the end of a frame.
+@code
+FrameArena arena;
+
+// each frame
+camera.draw(drawables, arena);
+shapes.setClean(arena);
+arena.reset();
+@endcode
+
+If the block is exhausted, additional memory is allocated from the heap. On
+the next @ref reset() the block is enlarged to fit all memory used during the
+frame, so after a few frames the arena settles on a size that needs no heap
+allocations at all.
+
+Use @ref FrameArenaAllocator to put STL containers into the arena, the
+@ref FrameArenaVector alias is provided for convenience. The containers
+must be destroyed before the arena is reset.
+
+## Thread safety
+
+The arena is not thread-safe, use one instance per thread. Because the
+threads don't share any allocator state, there is no lock contention.
+*/
+class MAGNUM_EXPORT FrameArena {
+    public:
+        /**
+         * @brief Constructor
+         * @param capacity      Initial capacity in bytes
+         */
+        explicit FrameArena(std::size_t capacity = 1024*1024);
+
+        /** @brief Copying is not allowed */
+        FrameArena(const FrameArena&) = delete;
+
+        /** @brief Move constructor */
+        FrameArena(FrameArena&& other) noexcept;
+
+        ~FrameArena();
+
+        /** @brief Copying is not allowed */
+        FrameArena& operator=(const FrameArena&) = delete;
+
+        /** @brief Move assignment */
+        FrameArena& operator=(FrameArena&& other) noexcept;
+
+        /**
+         * @brief Capacity
+         *
+         * Size of the preallocated block, not including memory allocated from
+         * the heap after the block was exhausted.
+         */
+        std::size_t capacity() const { return _data.size(); }
+
+        /**
+         * @brief Used size
+         *
+         * Memory allocated since last @ref reset(), including the memory
+         * that didn't fit into the preallocated block and alignment padding.
+         */
+        std::size_t usedSize() const { return _used + _overflowSize; }
+
+        /**
+         * @brief Count of heap allocations since last @ref reset()
+         *
+         * Zero if everything fit into the preallocated block.
+         */
+        std::size_t overflowCount() const { return _overflow.size(); }
+
+        /**
+         * @brief Allocate memory
+         * @param size          Size in bytes
+         * @param alignment     Alignment, has to be a power of two
+         *
+         * The memory is valid until @ref reset() is called or the arena is
+         * destroyed.
+         */
+        void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+        /**
+         * @brief Deallocate memory
+         *
+         * If @p memory is the last allocation made from the preallocated
+         * block, the memory is reused by next allocation, otherwise the
+         * function does nothing.
+         */
+        void deallocate(void* memory, std::size_t size);
+
+        /**
+         * @brief Reset the arena
+         *
+         * Releases all allocated memory. If the frame needed more memory
+         * than the capacity, the preallocated block is enlarged to fit it.
+         */
+        void reset();
+
+    private:
+        Containers::Array<char> _data;
+        std::size_t _used, _overflowSize;
+        std::vector<Containers::Array<char>> _overflow;
+};
+
+/**
+@brief Frame arena allocator
+
+STL-compatible allocator allocating from a @ref FrameArena. The allocator is
+not default-constructible, pass the arena to the container constructor:
+@code
+FrameArenaVector<Matrix4> matrices{arena};
+matrices.reserve(count);
+@endcode
+
+Because only the last allocation can be rolled back, call `reserve()` when the
+final size is known to avoid wasting arena memory on growing.
+@see @ref FrameArenaVector
+*/
+template<class T> class FrameArenaAllocator {
+    public:
+        typedef T value_type; /**< @brief Value type */
+
+        /** @brief Constructor */
+        /*implicit*/ FrameArenaAllocator(FrameArena& arena) noexcept: _arena{&arena} {}
+
+        /** @brief Construct from allocator of another type */
+        template<class U> /*implicit*/ FrameArenaAllocator(const FrameArenaAllocator<U>& other) noexcept: _arena{&other.arena()} {}
+
+        /** @brief Arena */
+        FrameArena& arena() const { return *_arena; }
+
+        /** @brief Allocate memory for @p count items */
+        T* allocate(std::size_t count) {
+            return static_cast<T*>(_arena->allocate(count*sizeof(T), alignof(T)));
+        }
+
+        /** @brief Deallocate memory for @p count items */
+        void deallocate(T* memory, std::size_t count) noexcept {
+            _arena->deallocate(memory, count*sizeof(T));
+        }
+
+    private:
+        FrameArena* _arena;
+};
+
+/** @relates FrameArenaAllocator
+@brief Whether the allocators use the same arena
+*/
+template<class T, class U> bool operator==(const FrameArenaAllocator<T>& a, const FrameArenaAllocator<U>& b) {
+    return &a.arena() == &b.arena();
+}
+
+/** @relates FrameArenaAllocator
+@brief Whether the allocators use a different arena
+*/
+template<class T, class U> bool operator!=(const FrameArenaAllocator<T>& a, const FrameArenaAllocator<U>& b) {
+    return &a.arena() != &b.arena();
+}
+
+/**
+@brief Vector allocated from a frame arena
+
+@see @ref FrameArenaAllocator
+*/
+template<class T> using FrameArenaVector = std::vector<T, FrameArenaAllocator<T>>;
+
+}
+
+#endif
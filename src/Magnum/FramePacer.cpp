@@ -0,0 +1,135 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FramePacer.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace Magnum {
+
+namespace {
+    inline Float seconds(const std::chrono::steady_clock::duration duration) {
+        return std::chrono::duration<Float>(duration).count();
+    }
+}
+
+FramePacer::FramePacer(): _targetFramePeriod{}, _justInTimeInput{}, _frameStarted{}, _sleepMargin{std::chrono::milliseconds{1}}, _workEstimate{}, _statistics{} {}
+
+FramePacer& FramePacer::setTargetFramePeriod(const Float seconds) {
+    _targetFramePeriod = seconds;
+    /* Start pacing from the next frame on */
+    _nextFrameStart = _nextFrameEnd = {};
+    return *this;
+}
+
+void FramePacer::waitUntil(const Clock::time_point time) {
+    /* Sleep for most of the time, the OS usually oversleeps by a fraction of
+       a millisecond up to a few milliseconds. Spin for the rest. */
+    for(Clock::time_point now = Clock::now(); now < time; now = Clock::now()) {
+        const Clock::duration remaining = time - now;
+        if(remaining <= _sleepMargin) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        const Clock::duration sleep = remaining - _sleepMargin;
+        std::this_thread::sleep_for(sleep);
+
+        /* Grow the margin immediately if the OS overslept more than that,
+           shrink it slowly otherwise */
+        const Clock::duration overslept = Clock::now() - now - sleep;
+        _sleepMargin = std::min<Clock::duration>(std::chrono::milliseconds{4},
+            overslept > _sleepMargin ? overslept : _sleepMargin - (_sleepMargin - std::max(overslept, Clock::duration::zero()))/16);
+    }
+}
+
+void FramePacer::beginFrame() {
+    const Clock::time_point before = Clock::now();
+    if(_targetFramePeriod > 0.0f && _nextFrameStart != Clock::time_point{})
+        waitUntil(_nextFrameStart);
+
+    _frameStart = Clock::now();
+    _frameStarted = true;
+    _statistics.waitTime = seconds(_frameStart - before);
+}
+
+void FramePacer::endFrame() {
+    const Clock::time_point now = Clock::now();
+
+    /* Work time. The estimate used for just-in-time input jumps up on spikes
+       and decays slowly so a single slow frame doesn't cause a miss */
+    if(_frameStarted) {
+        const Clock::duration work = now - _frameStart;
+        _statistics.workTime = seconds(work);
+        _workEstimate = work > _workEstimate ? work : _workEstimate - (_workEstimate - work)/16;
+    }
+
+    /* Frame time statistics, skipping the first frame */
+    if(_frameEnd != Clock::time_point{}) {
+        const Float frameTime = seconds(now - _frameEnd);
+        _statistics.frameTime = frameTime;
+        _statistics.averageFrameTime = _statistics.averageFrameTime == 0.0f ?
+            frameTime : _statistics.averageFrameTime + (frameTime - _statistics.averageFrameTime)/16.0f;
+        _statistics.maxFrameTime = std::max(_statistics.maxFrameTime, frameTime);
+        if(_targetFramePeriod > 0.0f && frameTime > _targetFramePeriod*1.5f)
+            ++_statistics.missedFrameCount;
+    }
+    ++_statistics.frameCount;
+    _frameEnd = now;
+
+    /* Schedule next frame */
+    if(_targetFramePeriod > 0.0f) {
+        const auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<Float>{_targetFramePeriod});
+
+        /* Start the next frame just early enough to finish the work by the
+           time the frame is presented, with a bit of reserve */
+        if(_justInTimeInput) {
+            /* Keep the expected present times at regular intervals, resync
+               if this frame ended more than half a period off */
+            const Clock::duration drift = now > _nextFrameEnd ? now - _nextFrameEnd : _nextFrameEnd - now;
+            _nextFrameEnd = (_nextFrameEnd == Clock::time_point{} || drift > period/2 ? now : _nextFrameEnd) + period;
+            _nextFrameStart = _nextFrameEnd - std::min<Clock::duration>(period, _workEstimate + _workEstimate/4 + _sleepMargin);
+        }
+
+        /* Start frames at regular intervals. If we're late by more than a
+           period, don't try to catch up but resynchronize instead. */
+        else {
+            const Clock::time_point start = _nextFrameStart != Clock::time_point{} ? _nextFrameStart : _frameStarted ? _frameStart : now;
+            _nextFrameStart = start + period;
+            if(_nextFrameStart + period < now) _nextFrameStart = now;
+        }
+    }
+
+    _frameStarted = false;
+}
+
+void FramePacer::resetStatistics() {
+    const Float averageFrameTime = _statistics.averageFrameTime;
+    _statistics = Statistics{};
+    _statistics.averageFrameTime = averageFrameTime;
+}
+
+}
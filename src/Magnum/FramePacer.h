@@ -0,0 +1,200 @@
+#ifndef Magnum_FramePacer_h
+#define Magnum_FramePacer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::FramePacer
+ */
+
+#include <chrono>
+
+#include "Magnum/Types.h"
+#include "Magnum/visibility.h"
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+namespace Magnum {
+
+/**
+@brief Frame pacer
+
+Keeps the main loop at a steady frame rate with sub-millisecond precision.
+Unlike @ref Platform::Sdl2Application::setMinimalLoopPeriod() "Platform::*Application::setMinimalLoopPeriod()",
+which sleeps for whole milliseconds after the frame is drawn, the pacer sleeps
+most of the remaining time and then spins for the rest, adapting the spin
+margin to how much the OS oversleeps.
+
+The time of a frame is measured between two consecutive @ref endFrame() calls,
+which should happen right after the buffer swap. With VSync enabled the swap
+blocks until the frame is presented, so it's the actual present time.
+
+## Just-in-time input
+
+By default the next frame starts one frame period after the previous one
+started. With @ref setJustInTimeInput() enabled, the pacer instead measures
+how long processing input and drawing takes and starts the next frame only
+that long before the expected present time. Input is then sampled as late as
+possible, cutting the latency between input and its effect on screen by up to
+a whole frame.
+
+## Basic usage
+
+@ref Platform::Sdl2Application and @ref Platform::GlfwApplication have the
+pacer integrated and it's accessible through
+@ref Platform::Sdl2Application::framePacer() "framePacer()". It's disabled by
+default, enable it by setting a target frame period:
+
+@code
+framePacer()
+    .setTargetFramePeriod(1.0f/120.0f)
+    .setJustInTimeInput(true);
+@endcode
+
+Elsewhere, call @ref beginFrame() before polling input and @ref endFrame()
+after the buffer swap. Statistics about frame times are available through
+@ref statistics().
+
+@note Not available on @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten", the
+    browser is managing the frequency instead.
+*/
+class MAGNUM_EXPORT FramePacer {
+    public:
+        /**
+         * @brief Frame statistics
+         *
+         * All times are in seconds.
+         * @see @ref statistics(), @ref resetStatistics()
+         */
+        struct Statistics {
+            /** @brief Count of frames since last statistics reset */
+            UnsignedInt frameCount;
+
+            /**
+             * @brief Count of missed frames since last statistics reset
+             *
+             * Frames that took more than one and a half of the target frame
+             * period.
+             */
+            UnsignedInt missedFrameCount;
+
+            /** @brief Duration of the last frame */
+            Float frameTime;
+
+            /** @brief Exponential moving average of frame duration */
+            Float averageFrameTime;
+
+            /** @brief Longest frame since last statistics reset */
+            Float maxFrameTime;
+
+            /**
+             * @brief Work time of the last frame
+             *
+             * Time between @ref beginFrame() and @ref endFrame().
+             */
+            Float workTime;
+
+            /** @brief Time spent waiting in the last @ref beginFrame() */
+            Float waitTime;
+        };
+
+        /**
+         * @brief Constructor
+         *
+         * Creates disabled frame pacer.
+         */
+        explicit FramePacer();
+
+        /** @brief Target frame period (in seconds) */
+        Float targetFramePeriod() const { return _targetFramePeriod; }
+
+        /**
+         * @brief Set target frame period
+         * @return Reference to self (for method chaining)
+         *
+         * Set to `0.0f` to disable pacing, in which case @ref beginFrame()
+         * doesn't wait, but statistics are still gathered. Default is
+         * `0.0f`.
+         */
+        FramePacer& setTargetFramePeriod(Float seconds);
+
+        /** @brief Whether just-in-time input is enabled */
+        bool isJustInTimeInput() const { return _justInTimeInput; }
+
+        /**
+         * @brief Enable or disable just-in-time input
+         * @return Reference to self (for method chaining)
+         *
+         * See @ref FramePacer "class documentation" for more
+         * information. Disabled by default.
+         */
+        FramePacer& setJustInTimeInput(bool enabled) {
+            _justInTimeInput = enabled;
+            return *this;
+        }
+
+        /**
+         * @brief Begin frame
+         *
+         * Waits until the next frame should start and records the frame
+         * start time. Call before polling input.
+         */
+        void beginFrame();
+
+        /**
+         * @brief End frame
+         *
+         * Call after the buffer swap. Updates statistics and schedules the
+         * next frame.
+         */
+        void endFrame();
+
+        /** @brief Frame statistics */
+        const Statistics& statistics() const { return _statistics; }
+
+        /**
+         * @brief Reset statistics
+         *
+         * Resets all values except for the average frame time to zero.
+         */
+        void resetStatistics();
+
+    private:
+        typedef std::chrono::steady_clock Clock;
+
+        void waitUntil(Clock::time_point time);
+
+        Float _targetFramePeriod;
+        bool _justInTimeInput, _frameStarted;
+        Clock::duration _sleepMargin, _workEstimate;
+        Clock::time_point _frameStart, _frameEnd, _nextFrameStart, _nextFrameEnd;
+        Statistics _statistics;
+};
+
+}
+#else
+#error this header is not available in Emscripten build
+#endif
+
+#endif
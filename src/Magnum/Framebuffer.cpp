@@ -96,6 +96,21 @@ Int Framebuffer::maxColorAttachments() {
     return value;
 }
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+Int Framebuffer::maxViews() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::OVR::multiview>())
+        return 0;
+
+    GLint& value = Context::current().state().framebuffer->maxViews;
+
+    /* Get the value, if not already cached */
+    if(value == 0)
+        glGetIntegerv(GL_MAX_VIEWS_OVR, &value);
+
+    return value;
+}
+#endif
+
 Framebuffer::Framebuffer(const Range2Di& viewport) {
     CORRADE_INTERNAL_ASSERT(viewport != Implementation::FramebufferState::DisengagedViewport);
     _viewport = viewport;
@@ -307,6 +322,13 @@ Framebuffer& Framebuffer::attachLayeredTexture(const BufferAttachment attachment
     (this->*Context::current().state().framebuffer->textureImplementation)(attachment, texture.id(), 0);
     return *this;
 }
+
+Framebuffer& Framebuffer::attachTextureMultiview(const BufferAttachment attachment, Texture2DArray& texture, const Int level, const Int baseViewIndex, const Int viewCount) {
+    CORRADE_ASSERT(viewCount > 0 && viewCount <= maxViews(),
+        "Framebuffer::attachTextureMultiview(): expected 1 to" << maxViews() << "views, got" << viewCount, *this);
+    glFramebufferTextureMultiviewOVR(GLenum(bindInternal()), GLenum(attachment), texture.id(), level, baseViewIndex, viewCount);
+    return *this;
+}
 #endif
 
 Framebuffer& Framebuffer::detach(const BufferAttachment attachment) {
@@ -424,6 +446,9 @@ Debug& operator<<(Debug& debug, const Framebuffer::Status value) {
         #ifndef MAGNUM_TARGET_GLES
         _c(IncompleteLayerTargets)
         #endif
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        _c(IncompleteViewTargets)
+        #endif
         #undef _c
         /* LCOV_EXCL_STOP */
     }
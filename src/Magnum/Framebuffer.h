@@ -302,7 +302,18 @@ class MAGNUM_EXPORT Framebuffer: public AbstractFramebuffer, public AbstractObje
              * @requires_gl Geometry shaders are not available in OpenGL ES or
              *      WebGL.
              */
-            IncompleteLayerTargets = GL_FRAMEBUFFER_INCOMPLETE_LAYER_TARGETS
+            IncompleteLayerTargets = GL_FRAMEBUFFER_INCOMPLETE_LAYER_TARGETS,
+            #endif
+
+            #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+            /**
+             * Multiview attachments with mismatched view count or base view
+             * index
+             * @requires_extension Extension @extension{OVR,multiview}
+             * @requires_es_extension Extension @extension{OVR,multiview}
+             * @requires_gles Multiview is not available in WebGL.
+             */
+            IncompleteViewTargets = GL_FRAMEBUFFER_INCOMPLETE_VIEW_TARGETS_OVR
             #endif
         };
 
@@ -320,6 +331,21 @@ class MAGNUM_EXPORT Framebuffer: public AbstractFramebuffer, public AbstractObje
          */
         static Int maxColorAttachments();
 
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        /**
+         * @brief Max supported multiview view count
+         *
+         * The result is cached, repeated queries don't result in repeated
+         * OpenGL calls. If @extension{OVR,multiview} is not available,
+         * returns `0`.
+         * @see @ref attachTextureMultiview(), @fn_gl{Get} with
+         *      @def_gl{MAX_VIEWS_OVR}
+         * @requires_gles30 Multiview is not available in OpenGL ES 2.0.
+         * @requires_gles Multiview is not available in WebGL.
+         */
+        static Int maxViews();
+        #endif
+
         /**
          * @brief Wrap existing OpenGL framebuffer object
          * @param id            OpenGL framebuffer ID
@@ -812,6 +838,35 @@ class MAGNUM_EXPORT Framebuffer: public AbstractFramebuffer, public AbstractObje
          * @requires_gles Geometry shaders are not available in WebGL.
          */
         Framebuffer& attachLayeredTexture(BufferAttachment attachment, MultisampleTexture2DArray& texture);
+
+        /**
+         * @brief Attach multiview texture to given buffer
+         * @param attachment        Buffer attachment
+         * @param texture           Texture
+         * @param level             Mip level
+         * @param baseViewIndex     First layer used as a view
+         * @param viewCount         Count of views
+         * @return Reference to self (for method chaining)
+         *
+         * Attaches @p viewCount consecutive layers starting at
+         * @p baseViewIndex as separate views. Each draw call is then
+         * broadcast to all views, with `gl_ViewID_OVR` in the shader telling
+         * which view is being rendered to, see
+         * @ref SceneGraph::BasicStereoCamera3D for an example. All attachments of
+         * the framebuffer have to use the same @p baseViewIndex and
+         * @p viewCount, otherwise the framebuffer is
+         * @ref Status::IncompleteViewTargets. Expects that @p viewCount is
+         * not larger than @ref maxViews(). The framebuffer is bound before
+         * the operation (if not already), as there is no direct state access
+         * variant of the function.
+         * @see @ref detach(), @ref attachTextureLayer(),
+         *      @fn_gl{BindFramebuffer} and
+         *      @fn_gl_extension{FramebufferTextureMultiview,OVR,multiview}
+         * @requires_extension Extension @extension{OVR,multiview}
+         * @requires_es_extension Extension @extension{OVR,multiview}
+         * @requires_gles Multiview is not available in WebGL.
+         */
+        Framebuffer& attachTextureMultiview(BufferAttachment attachment, Texture2DArray& texture, Int level, Int baseViewIndex, Int viewCount);
         #endif
 
         /**
@@ -0,0 +1,159 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FramebufferReadback.h"
+
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/AbstractFramebuffer.h"
+#include "Magnum/PixelFormat.h"
+
+namespace Magnum {
+
+FramebufferReadback::Slot::Slot(): image{PixelFormat::RGBA, PixelType::UnsignedByte}, frame{}, state{SlotState::Free} {}
+
+FramebufferReadback::FramebufferReadback(const std::size_t depth) {
+    CORRADE_ASSERT(depth, "FramebufferReadback: expected non-zero depth", );
+
+    _slots.reserve(depth);
+    for(std::size_t i = 0; i != depth; ++i) _slots.emplace_back();
+}
+
+FramebufferReadback::~FramebufferReadback() {
+    /* The worker threads might still be accessing the mapped memory */
+    for(Slot& slot: _slots) if(slot.state == SlotState::Converting) {
+        slot.conversion.wait();
+        slot.image.buffer().unmap();
+    }
+}
+
+std::uint64_t FramebufferReadback::read(AbstractFramebuffer& framebuffer, const Range2Di& rectangle, const ImageView2D& image) {
+    /* The ring is full, wait for the oldest read to be delivered */
+    if(_pendingCount == _slots.size()) {
+        Slot& oldest = _slots[_oldest];
+        if(oldest.state == SlotState::Reading) {
+            oldest.fence.clientWait();
+            deliver(oldest);
+        }
+        release(oldest, true);
+        _oldest = (_oldest + 1) % _slots.size();
+        --_pendingCount;
+    }
+
+    Slot& slot = _slots[(_oldest + _pendingCount) % _slots.size()];
+    CORRADE_INTERNAL_ASSERT(slot.state == SlotState::Free);
+
+    /* Update the pixel format while keeping the buffer storage, read()
+       reallocates it only if it's too small */
+    slot.image.setData(image.storage(), image.format(), image.type(), {}, nullptr, BufferUsage::StreamRead);
+    framebuffer.read(rectangle, slot.image, BufferUsage::StreamRead);
+    slot.fence.insert();
+    slot.frame = _frame;
+    slot.state = SlotState::Reading;
+    ++_pendingCount;
+
+    return _frame++;
+}
+
+std::size_t FramebufferReadback::poll() {
+    /* Deliver finished reads in order, stopping at the first one that's not
+       done on the GPU yet */
+    std::size_t delivered = 0;
+    for(std::size_t i = 0; i != _pendingCount; ++i) {
+        Slot& slot = _slots[(_oldest + i) % _slots.size()];
+        if(slot.state != SlotState::Reading) continue;
+        if(!slot.fence.isSignaled()) break;
+        deliver(slot);
+        ++delivered;
+    }
+
+    /* Release the buffers from the front of the ring */
+    while(_pendingCount && release(_slots[_oldest], false)) {
+        _oldest = (_oldest + 1) % _slots.size();
+        --_pendingCount;
+    }
+
+    return delivered;
+}
+
+std::size_t FramebufferReadback::finish() {
+    std::size_t delivered = 0;
+    while(_pendingCount) {
+        Slot& slot = _slots[_oldest];
+        if(slot.state == SlotState::Reading) {
+            slot.fence.clientWait();
+            deliver(slot);
+            ++delivered;
+        }
+        release(slot, true);
+        _oldest = (_oldest + 1) % _slots.size();
+        --_pendingCount;
+    }
+
+    return delivered;
+}
+
+void FramebufferReadback::deliver(Slot& slot) {
+    /* Nobody is interested, don't bother mapping */
+    if(!_callback) {
+        slot.state = SlotState::Done;
+        return;
+    }
+
+    const std::size_t dataSize = slot.image.dataSize();
+    const char* const data = slot.image.buffer().map<char>(0, dataSize, Buffer::MapFlag::Read);
+    CORRADE_INTERNAL_ASSERT(data);
+    const ImageView2D image{slot.image.storage(), slot.image.format(), slot.image.type(), slot.image.size(), {data, dataSize}};
+
+    if(_threaded) {
+        /* Buffer gets unmapped in release() once the worker finishes. The
+           callback is copied so it can be replaced in the meantime. */
+        slot.conversion = std::async(std::launch::async, [](Callback callback, ImageView2D image, std::uint64_t frame) {
+            callback(image, frame);
+        }, _callback, image, slot.frame);
+        slot.state = SlotState::Converting;
+    } else {
+        _callback(image, slot.frame);
+        slot.image.buffer().unmap();
+        slot.state = SlotState::Done;
+    }
+}
+
+bool FramebufferReadback::release(Slot& slot, const bool wait) {
+    if(slot.state == SlotState::Reading) return false;
+
+    if(slot.state == SlotState::Converting) {
+        if(!wait && slot.conversion.wait_for(std::chrono::seconds{0}) != std::future_status::ready)
+            return false;
+
+        slot.conversion.get();
+        slot.image.buffer().unmap();
+    }
+
+    slot.state = SlotState::Free;
+    return true;
+}
+
+}
@@ -0,0 +1,233 @@
+#ifndef Magnum_FramebufferReadback_h
+#define Magnum_FramebufferReadback_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+/** @file
+ * @brief Class @ref Magnum::FramebufferReadback
+ */
+#endif
+
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <vector>
+
+#include "Magnum/BufferImage.h"
+#include "Magnum/Fence.h"
+#include "Magnum/ImageView.h"
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+namespace Magnum {
+
+/**
+@brief Asynchronous framebuffer readback
+
+Reading a framebuffer into an @ref Image2D using
+@ref AbstractFramebuffer::read() stalls the pipeline until the GPU finishes
+all rendering. This class instead reads into a ring of @ref BufferImage2D
+instances used as pixel pack buffers, inserts a @ref Fence after each read
+and delivers the pixels to a callback only once the GPU is done, usually a
+few frames later:
+@code
+FramebufferReadback readback{3};
+readback.setCallback([](const ImageView2D& image, std::uint64_t frame) {
+    encoder.addFrame(frame, image.data());
+});
+
+// each frame
+drawScene();
+readback.read(framebuffer, framebuffer.viewport(), {PixelFormat::RGBA, PixelType::UnsignedByte});
+readback.poll();
+
+// at the end
+readback.finish();
+@endcode
+
+The callback receives a view on the mapped buffer memory, valid only until the
+callback returns. The frames are delivered in the order they were read. If
+all buffers in the ring are still in use when @ref read() is called, it
+blocks until the oldest one is delivered, so size the ring according to the
+expected GPU latency.
+
+## Converting on a worker thread
+
+With @ref setThreaded() enabled the callback is called on a worker thread
+instead, so expensive conversions such as color space conversion or encoding
+don't block the rendering thread. The buffer stays mapped until the callback
+finishes and is unmapped in a subsequent @ref poll(), @ref read() or
+@ref finish() call. The callbacks for different frames may run concurrently,
+use the frame index to order the results. No OpenGL calls are allowed in the
+callback in this case.
+
+@requires_gl32 Extension @extension{ARB,sync}
+@requires_gl30 Extension @extension{ARB,map_buffer_range}
+@requires_gles30 Pixel buffer objects and sync objects are not available in
+    OpenGL ES 2.0.
+@requires_gles Buffer mapping is not available in WebGL.
+*/
+class MAGNUM_EXPORT FramebufferReadback {
+    public:
+        /**
+         * @brief Callback
+         *
+         * Called with a view on the pixel data and index of the frame
+         * returned from @ref read().
+         */
+        typedef std::function<void(const ImageView2D&, std::uint64_t)> Callback;
+
+        /**
+         * @brief Constructor
+         * @param depth     Count of buffers in the ring
+         *
+         * Expects that @p depth is not zero.
+         */
+        explicit FramebufferReadback(std::size_t depth = 3);
+
+        /** @brief Copying is not allowed */
+        FramebufferReadback(const FramebufferReadback&) = delete;
+
+        /** @brief Moving is not allowed */
+        FramebufferReadback(FramebufferReadback&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Waits for callbacks running on the worker thread, reads that were
+         * not delivered yet are discarded. Call @ref finish() before to
+         * deliver them.
+         */
+        ~FramebufferReadback();
+
+        /** @brief Copying is not allowed */
+        FramebufferReadback& operator=(const FramebufferReadback&) = delete;
+
+        /** @brief Moving is not allowed */
+        FramebufferReadback& operator=(FramebufferReadback&&) = delete;
+
+        /** @brief Count of buffers in the ring */
+        std::size_t depth() const { return _slots.size(); }
+
+        /**
+         * @brief Count of pending reads
+         *
+         * Reads which were not delivered yet or whose buffers are still
+         * used by a callback on the worker thread.
+         */
+        std::size_t pendingCount() const { return _pendingCount; }
+
+        /**
+         * @brief Set callback
+         * @return Reference to self (for method chaining)
+         *
+         * If no callback is set, the reads are just discarded.
+         */
+        FramebufferReadback& setCallback(Callback callback) {
+            _callback = std::move(callback);
+            return *this;
+        }
+
+        /** @brief Whether the callback is called on a worker thread */
+        bool isThreaded() const { return _threaded; }
+
+        /**
+         * @brief Call the callback on a worker thread
+         * @return Reference to self (for method chaining)
+         *
+         * Default is `false`. See @ref FramebufferReadback "class documentation"
+         * for more information.
+         */
+        FramebufferReadback& setThreaded(bool threaded) {
+            _threaded = threaded;
+            return *this;
+        }
+
+        /**
+         * @brief Read framebuffer asynchronously
+         * @return Index of the frame, passed to the callback
+         *
+         * Reads given rectangle of @p framebuffer into the next buffer in
+         * the ring using @ref AbstractFramebuffer::read(const Range2Di&, BufferImage2D&, BufferUsage)
+         * and inserts a fence after it. Pixel storage parameters of @p image
+         * are used, its size is ignored. If the next buffer is still pending,
+         * waits until it is delivered first. Frame indices start at `0`.
+         */
+        std::uint64_t read(AbstractFramebuffer& framebuffer, const Range2Di& rectangle, const ImageView2D& image);
+
+        /** @overload */
+        std::uint64_t read(AbstractFramebuffer& framebuffer, const Range2Di& rectangle, PixelFormat format, PixelType type) {
+            return read(framebuffer, rectangle, ImageView2D{format, type, {}});
+        }
+
+        /**
+         * @brief Deliver finished reads
+         * @return Count of reads delivered to the callback
+         *
+         * Doesn't block. Calls the callback for all reads in order until the
+         * first one which the GPU didn't finish yet and releases buffers
+         * whose callbacks finished on the worker thread.
+         */
+        std::size_t poll();
+
+        /**
+         * @brief Deliver all pending reads
+         * @return Count of reads delivered to the callback
+         *
+         * Blocks until all pending reads are delivered and all callbacks on
+         * the worker thread are finished.
+         */
+        std::size_t finish();
+
+    private:
+        enum class SlotState: UnsignedByte {
+            Free, Reading, Converting, Done
+        };
+
+        struct Slot {
+            explicit Slot();
+
+            BufferImage2D image;
+            Fence fence;
+            std::future<void> conversion;
+            std::uint64_t frame;
+            SlotState state;
+        };
+
+        MAGNUM_LOCAL void deliver(Slot& slot);
+        MAGNUM_LOCAL bool release(Slot& slot, bool wait);
+
+        std::vector<Slot> _slots;
+        std::size_t _oldest{}, _pendingCount{};
+        std::uint64_t _frame{};
+        Callback _callback;
+        bool _threaded{};
+};
+
+}
+#else
+#error this header is not available in OpenGL ES 2.0 and WebGL build
+#endif
+
+#endif
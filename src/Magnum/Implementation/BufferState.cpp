@@ -112,6 +112,7 @@ BufferState::BufferState(Context& context, std::vector<std::string>& extensions)
         copyImplementation = &Buffer::copyImplementationDSA;
         getParameterImplementation = &Buffer::getParameterImplementationDSA;
         getSubDataImplementation = &Buffer::getSubDataImplementationDSA;
+        storageImplementation = &Buffer::storageImplementationDSA;
         dataImplementation = &Buffer::dataImplementationDSA;
         subDataImplementation = &Buffer::subDataImplementationDSA;
         mapImplementation = &Buffer::mapImplementationDSA;
@@ -124,6 +125,7 @@ BufferState::BufferState(Context& context, std::vector<std::string>& extensions)
         copyImplementation = &Buffer::copyImplementationDSAEXT;
         getParameterImplementation = &Buffer::getParameterImplementationDSAEXT;
         getSubDataImplementation = &Buffer::getSubDataImplementationDSAEXT;
+        storageImplementation = &Buffer::storageImplementationDSAEXT;
         dataImplementation = &Buffer::dataImplementationDSAEXT;
         subDataImplementation = &Buffer::subDataImplementationDSAEXT;
         mapImplementation = &Buffer::mapImplementationDSAEXT;
@@ -139,6 +141,7 @@ BufferState::BufferState(Context& context, std::vector<std::string>& extensions)
         getParameterImplementation = &Buffer::getParameterImplementationDefault;
         #ifndef MAGNUM_TARGET_GLES
         getSubDataImplementation = &Buffer::getSubDataImplementationDefault;
+        storageImplementation = &Buffer::storageImplementationDefault;
         #endif
         dataImplementation = &Buffer::dataImplementationDefault;
         subDataImplementation = &Buffer::subDataImplementationDefault;
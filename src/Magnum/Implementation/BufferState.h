@@ -60,6 +60,9 @@ struct BufferState {
     #ifndef MAGNUM_TARGET_GLES2
     void(Buffer::*getSubDataImplementation)(GLintptr, GLsizeiptr, GLvoid*);
     #endif
+    #ifndef MAGNUM_TARGET_GLES
+    void(Buffer::*storageImplementation)(GLsizeiptr, const GLvoid*, Buffer::StorageFlags);
+    #endif
     void(Buffer::*dataImplementation)(GLsizeiptr, const GLvoid*, BufferUsage);
     void(Buffer::*subDataImplementation)(GLintptr, GLsizeiptr, const GLvoid*);
     void(Buffer::*invalidateImplementation)();
@@ -42,6 +42,9 @@ FramebufferState::FramebufferState(Context& context, std::vector<std::string>& e
     #ifndef MAGNUM_TARGET_GLES
     maxDualSourceDrawBuffers{0},
     #endif
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    maxViews{0},
+    #endif
     viewport{DisengagedViewport}
 {
     /* Create implementation */
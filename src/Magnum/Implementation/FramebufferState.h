@@ -106,6 +106,9 @@ struct FramebufferState {
     #ifndef MAGNUM_TARGET_GLES
     GLint maxDualSourceDrawBuffers;
     #endif
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    GLint maxViews;
+    #endif
     Range2Di viewport;
     Vector2i maxViewportSize;
 };
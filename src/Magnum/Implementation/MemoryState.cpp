@@ -0,0 +1,317 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MemoryState.h"
+
+#include <utility>
+
+#include "Magnum/TextureFormat.h"
+
+namespace Magnum { namespace Implementation {
+
+namespace {
+    inline MemoryState::Allocation& allocationFor(std::unordered_map<std::uint64_t, MemoryState::Allocation>& allocations, const MemoryState::Type type, const GLuint id) {
+        MemoryState::Allocation& allocation = allocations[std::uint64_t(type) << 32 | id];
+        allocation.type = type;
+        return allocation;
+    }
+}
+
+void MemoryState::setSize(const Type type, const GLuint id, const std::size_t size) {
+    if(!enabled) return;
+
+    std::vector<std::size_t>& parts = allocationFor(allocations, type, id).parts;
+    parts.assign(1, size);
+}
+
+void MemoryState::setPartSize(const Type type, const GLuint id, const std::size_t part, const std::size_t size) {
+    if(!enabled) return;
+
+    std::vector<std::size_t>& parts = allocationFor(allocations, type, id).parts;
+    if(parts.size() <= part) parts.resize(part + 1);
+    parts[part] = size;
+}
+
+void MemoryState::setLabel(const Type type, const GLuint id, const Containers::ArrayView<const char> label) {
+    if(!enabled) return;
+
+    allocationFor(allocations, type, id).label.assign(label.data(), label.size());
+}
+
+void MemoryState::remove(const Type type, const GLuint id) {
+    if(!enabled) return;
+
+    allocations.erase(std::uint64_t(type) << 32 | id);
+}
+
+namespace {
+
+/* Count of bits per given count of pixels, so block-compressed formats can be
+   expressed as well */
+std::pair<UnsignedInt, UnsignedInt> textureFormatBits(const TextureFormat format) {
+    switch(format) {
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        case TextureFormat::Red:
+        case TextureFormat::R8:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        case TextureFormat::R8Snorm:
+        case TextureFormat::R8UI:
+        case TextureFormat::R8I:
+        #endif
+        #ifdef MAGNUM_TARGET_GLES2
+        case TextureFormat::Luminance:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        case TextureFormat::R3B3G2:
+        case TextureFormat::RGBA2:
+        #endif
+        #ifndef MAGNUM_TARGET_WEBGL
+        case TextureFormat::StencilIndex8:
+        #endif
+            return {8, 1};
+
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        case TextureFormat::RG:
+        case TextureFormat::RG8:
+        case TextureFormat::DepthComponent16:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        case TextureFormat::RG8Snorm:
+        case TextureFormat::RG8UI:
+        case TextureFormat::RG8I:
+        case TextureFormat::R16UI:
+        case TextureFormat::R16I:
+        case TextureFormat::R16F:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        case TextureFormat::R16:
+        case TextureFormat::R16Snorm:
+        case TextureFormat::RGB4:
+        case TextureFormat::RGB5:
+        #endif
+        #ifdef MAGNUM_TARGET_GLES2
+        case TextureFormat::LuminanceAlpha:
+        #endif
+        case TextureFormat::RGB565:
+        case TextureFormat::RGBA4:
+        case TextureFormat::RGB5A1:
+            return {16, 1};
+
+        case TextureFormat::RGB:
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        case TextureFormat::RGB8:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        case TextureFormat::RGB8Snorm:
+        case TextureFormat::RGB8UI:
+        case TextureFormat::RGB8I:
+        case TextureFormat::SRGB8:
+        #endif
+        #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
+        case TextureFormat::SRGB:
+        #endif
+            return {24, 1};
+
+        /* 24-bit depth is usually padded to 32 bits */
+        case TextureFormat::RGBA:
+        case TextureFormat::DepthComponent:
+        case TextureFormat::DepthStencil:
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        case TextureFormat::RGBA8:
+        case TextureFormat::RGB10A2:
+        case TextureFormat::DepthComponent24:
+        case TextureFormat::Depth24Stencil8:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        case TextureFormat::RGBA8Snorm:
+        case TextureFormat::RGBA8UI:
+        case TextureFormat::RGBA8I:
+        case TextureFormat::RG16UI:
+        case TextureFormat::RG16I:
+        case TextureFormat::RG16F:
+        case TextureFormat::R32UI:
+        case TextureFormat::R32I:
+        case TextureFormat::R32F:
+        case TextureFormat::RGB10A2UI:
+        case TextureFormat::R11FG11FB10F:
+        case TextureFormat::RGB9E5:
+        case TextureFormat::SRGB8Alpha8:
+        case TextureFormat::DepthComponent32F:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        case TextureFormat::RG16:
+        case TextureFormat::RG16Snorm:
+        #endif
+        #if !defined(MAGNUM_TARGET_GLES) || (defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL))
+        case TextureFormat::RGB10:
+        #endif
+        #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
+        case TextureFormat::SRGBAlpha:
+        #endif
+        #ifndef MAGNUM_TARGET_WEBGL
+        case TextureFormat::DepthComponent32:
+        #endif
+            return {32, 1};
+
+        #ifndef MAGNUM_TARGET_GLES2
+        case TextureFormat::RGB16UI:
+        case TextureFormat::RGB16I:
+        case TextureFormat::RGB16F:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        case TextureFormat::RGB16:
+        case TextureFormat::RGB16Snorm:
+        case TextureFormat::RGB12:
+        case TextureFormat::RGBA12:
+        #endif
+            return {48, 1};
+
+        #ifndef MAGNUM_TARGET_GLES2
+        case TextureFormat::RGBA16UI:
+        case TextureFormat::RGBA16I:
+        case TextureFormat::RGBA16F:
+        case TextureFormat::RG32UI:
+        case TextureFormat::RG32I:
+        case TextureFormat::RG32F:
+        case TextureFormat::Depth32FStencil8:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        case TextureFormat::RGBA16:
+        case TextureFormat::RGBA16Snorm:
+        #endif
+            return {64, 1};
+
+        #ifndef MAGNUM_TARGET_GLES2
+        case TextureFormat::RGB32UI:
+        case TextureFormat::RGB32I:
+        case TextureFormat::RGB32F:
+            return {96, 1};
+
+        case TextureFormat::RGBA32UI:
+        case TextureFormat::RGBA32I:
+        case TextureFormat::RGBA32F:
+            return {128, 1};
+        #endif
+
+        /* 4x4 blocks of 64 bits */
+        #ifndef MAGNUM_TARGET_GLES
+        case TextureFormat::CompressedRed:
+        case TextureFormat::CompressedRGB:
+        case TextureFormat::CompressedRedRgtc1:
+        case TextureFormat::CompressedSignedRedRgtc1:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        case TextureFormat::CompressedRGB8Etc2:
+        case TextureFormat::CompressedSRGB8Etc2:
+        case TextureFormat::CompressedRGB8PunchthroughAlpha1Etc2:
+        case TextureFormat::CompressedSRGB8PunchthroughAlpha1Etc2:
+        case TextureFormat::CompressedR11Eac:
+        case TextureFormat::CompressedSignedR11Eac:
+        #endif
+        case TextureFormat::CompressedRGBS3tcDxt1:
+        case TextureFormat::CompressedRGBAS3tcDxt1:
+            return {64, 16};
+
+        /* 4x4 blocks of 128 bits */
+        #ifndef MAGNUM_TARGET_GLES
+        case TextureFormat::CompressedRG:
+        case TextureFormat::CompressedRGBA:
+        case TextureFormat::CompressedRGRgtc2:
+        case TextureFormat::CompressedSignedRGRgtc2:
+        case TextureFormat::CompressedRGBBptcUnsignedFloat:
+        case TextureFormat::CompressedRGBBptcSignedFloat:
+        case TextureFormat::CompressedRGBABptcUnorm:
+        case TextureFormat::CompressedSRGBAlphaBptcUnorm:
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        case TextureFormat::CompressedRGBA8Etc2Eac:
+        case TextureFormat::CompressedSRGB8Alpha8Etc2Eac:
+        case TextureFormat::CompressedRG11Eac:
+        case TextureFormat::CompressedSignedRG11Eac:
+        #endif
+        case TextureFormat::CompressedRGBAS3tcDxt3:
+        case TextureFormat::CompressedRGBAS3tcDxt5:
+            return {128, 16};
+
+        /* ASTC blocks are always 128 bits */
+        #ifndef MAGNUM_TARGET_WEBGL
+        case TextureFormat::CompressedRGBAAstc4x4:
+        case TextureFormat::CompressedSRGB8Alpha8Astc4x4:
+            return {128, 4*4};
+        case TextureFormat::CompressedRGBAAstc5x4:
+        case TextureFormat::CompressedSRGB8Alpha8Astc5x4:
+            return {128, 5*4};
+        case TextureFormat::CompressedRGBAAstc5x5:
+        case TextureFormat::CompressedSRGB8Alpha8Astc5x5:
+            return {128, 5*5};
+        case TextureFormat::CompressedRGBAAstc6x5:
+        case TextureFormat::CompressedSRGB8Alpha8Astc6x5:
+            return {128, 6*5};
+        case TextureFormat::CompressedRGBAAstc6x6:
+        case TextureFormat::CompressedSRGB8Alpha8Astc6x6:
+            return {128, 6*6};
+        case TextureFormat::CompressedRGBAAstc8x5:
+        case TextureFormat::CompressedSRGB8Alpha8Astc8x5:
+            return {128, 8*5};
+        case TextureFormat::CompressedRGBAAstc8x6:
+        case TextureFormat::CompressedSRGB8Alpha8Astc8x6:
+            return {128, 8*6};
+        case TextureFormat::CompressedRGBAAstc8x8:
+        case TextureFormat::CompressedSRGB8Alpha8Astc8x8:
+            return {128, 8*8};
+        case TextureFormat::CompressedRGBAAstc10x5:
+        case TextureFormat::CompressedSRGB8Alpha8Astc10x5:
+            return {128, 10*5};
+        case TextureFormat::CompressedRGBAAstc10x6:
+        case TextureFormat::CompressedSRGB8Alpha8Astc10x6:
+            return {128, 10*6};
+        case TextureFormat::CompressedRGBAAstc10x8:
+        case TextureFormat::CompressedSRGB8Alpha8Astc10x8:
+            return {128, 10*8};
+        case TextureFormat::CompressedRGBAAstc10x10:
+        case TextureFormat::CompressedSRGB8Alpha8Astc10x10:
+            return {128, 10*10};
+        case TextureFormat::CompressedRGBAAstc12x10:
+        case TextureFormat::CompressedSRGB8Alpha8Astc12x10:
+            return {128, 12*10};
+        case TextureFormat::CompressedRGBAAstc12x12:
+        case TextureFormat::CompressedSRGB8Alpha8Astc12x12:
+            return {128, 12*12};
+        #endif
+
+        default:
+            return {32, 1};
+    }
+}
+
+}
+
+std::size_t textureFormatDataSize(const TextureFormat format, const std::size_t pixelCount) {
+    const std::pair<UnsignedInt, UnsignedInt> bits = textureFormatBits(format);
+    return (pixelCount*bits.first/bits.second + 7)/8;
+}
+
+}}
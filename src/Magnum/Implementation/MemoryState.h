@@ -0,0 +1,73 @@
+#ifndef Magnum_Implementation_MemoryState_h
+#define Magnum_Implementation_MemoryState_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/OpenGL.h"
+
+namespace Magnum { namespace Implementation {
+
+struct MemoryState {
+    enum class Type: UnsignedByte {
+        Buffer,
+        Texture,
+        Renderbuffer
+    };
+
+    struct Allocation {
+        Type type;
+        std::string label;
+
+        /* Sizes of separately specified parts of the allocation, such as
+           texture mip levels or cube map faces. Storage allocations have just
+           one part. */
+        std::vector<std::size_t> parts;
+    };
+
+    /* All of these are no-ops if the accounting is not enabled */
+    void setSize(Type type, GLuint id, std::size_t size);
+    void setPartSize(Type type, GLuint id, std::size_t part, std::size_t size);
+    void setLabel(Type type, GLuint id, Containers::ArrayView<const char> label);
+    void remove(Type type, GLuint id);
+
+    bool enabled{};
+    std::unordered_map<std::uint64_t, Allocation> allocations;
+};
+
+/* Estimated size of given count of pixels in given internal format. Sizes of
+   compressed formats are approximate as partial blocks are not taken into
+   account; formats not known go with four bytes per pixel. */
+std::size_t textureFormatDataSize(TextureFormat format, std::size_t pixelCount);
+
+}}
+
+#endif
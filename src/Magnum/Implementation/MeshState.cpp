@@ -70,6 +70,18 @@ MeshState::MeshState(Context& context, ContextState& contextState, std::vector<s
         bindIndexBufferImplementation = &Mesh::bindIndexBufferImplementationVAO;
         bindImplementation = &Mesh::bindImplementationVAO;
         unbindImplementation = &Mesh::unbindImplementationVAO;
+
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        /* Shared VAOs for meshes with the same vertex format */
+        #ifndef MAGNUM_TARGET_GLES
+        if(context.isExtensionSupported<Extensions::GL::ARB::vertex_attrib_binding>()) {
+            extensions.emplace_back(Extensions::GL::ARB::vertex_attrib_binding::string());
+        #else
+        if(context.isVersionSupported(Version::GLES310)) {
+        #endif
+            vertexBufferImplementation = &Mesh::vertexBufferImplementationVertexAttribBinding;
+        } else vertexBufferImplementation = &Mesh::vertexBufferImplementationFallback;
+        #endif
     }
     #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
     else {
@@ -79,6 +91,9 @@ MeshState::MeshState(Context& context, ContextState& contextState, std::vector<s
         bindIndexBufferImplementation = &Mesh::bindIndexBufferImplementationDefault;
         bindImplementation = &Mesh::bindImplementationDefault;
         unbindImplementation = &Mesh::unbindImplementationDefault;
+        #ifndef MAGNUM_TARGET_GLES
+        vertexBufferImplementation = &Mesh::vertexBufferImplementationFallback;
+        #endif
     }
     #endif
 
@@ -90,6 +105,19 @@ MeshState::MeshState(Context& context, ContextState& contextState, std::vector<s
     }
     #endif
 
+    #ifndef MAGNUM_TARGET_GLES
+    /* Multi draw implementation on desktop */
+    if(context.isExtensionSupported<Extensions::GL::ARB::multi_draw_indirect>()) {
+        extensions.emplace_back(Extensions::GL::ARB::multi_draw_indirect::string());
+
+        multiDrawImplementation = &MeshView::multiDrawImplementationIndirect;
+        multiDrawIndirectImplementation = &Mesh::multiDrawIndirectImplementationDefault;
+    } else {
+        multiDrawImplementation = &MeshView::multiDrawImplementationDefault;
+        multiDrawIndirectImplementation = &Mesh::multiDrawIndirectImplementationFallback;
+    }
+    #endif
+
     #ifdef MAGNUM_TARGET_GLES
     #ifndef MAGNUM_TARGET_WEBGL
     /* Multi draw implementation on ES */
@@ -176,6 +204,9 @@ MeshState::~MeshState() {
     #ifndef MAGNUM_TARGET_GLES
     /* If the default VAO was created, we need to delete it to avoid leaks */
     if(defaultVAO) glDeleteVertexArrays(1, &defaultVAO);
+
+    /* The same for the scratch buffer used by indirect multi-draw */
+    if(multiDrawIndirectBuffer) glDeleteBuffers(1, &multiDrawIndirectBuffer);
     #endif
 }
 
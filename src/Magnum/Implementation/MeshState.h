@@ -46,6 +46,9 @@ struct MeshState {
     #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
     void(Mesh::*vertexAttribDivisorImplementation)(GLuint, GLuint);
     #endif
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    void(Mesh::*vertexBufferImplementation)(UnsignedInt, Buffer&, GLintptr);
+    #endif
     void(Mesh::*bindIndexBufferImplementation)(Buffer&);
     void(Mesh::*bindImplementation)();
     void(Mesh::*unbindImplementation)();
@@ -55,12 +58,15 @@ struct MeshState {
     void(Mesh::*drawElementsInstancedImplementation)(GLsizei, GLintptr, GLsizei);
     #endif
 
-    #ifdef MAGNUM_TARGET_GLES
-    void(*multiDrawImplementation)(std::initializer_list<std::reference_wrapper<MeshView>>);
+    void(*multiDrawImplementation)(Containers::ArrayView<const std::reference_wrapper<MeshView>>);
+
+    #ifndef MAGNUM_TARGET_GLES
+    void(Mesh::*multiDrawIndirectImplementation)(GLintptr, GLsizei, GLsizei);
     #endif
 
     #ifndef MAGNUM_TARGET_GLES
     GLuint defaultVAO{}; /* Used on core profile in case ARB_VAO is disabled */
+    GLuint multiDrawIndirectBuffer{}; /* Scratch buffer for MeshView::draw() */
     #endif
 
     GLuint currentVAO;
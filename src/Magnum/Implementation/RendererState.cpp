@@ -30,10 +30,11 @@
 
 namespace Magnum { namespace Implementation {
 
-RendererState::RendererState(Context& context, std::vector<std::string>& extensions)
+RendererState::RendererState(Context& context, std::vector<std::string>& extensions):
     #ifndef MAGNUM_TARGET_WEBGL
-    : resetNotificationStrategy()
+    resetNotificationStrategy(),
     #endif
+    statistics{0, 0}
 {
     /* Float depth clear value implementation */
     #ifndef MAGNUM_TARGET_GLES
@@ -85,6 +86,21 @@ RendererState::RendererState(Context& context, std::vector<std::string>& extensi
     #endif
 }
 
+void RendererState::Shadow::reset() {
+    features.clear();
+    blendEquation = std::nullopt;
+    blendFunction = std::nullopt;
+    blendColor = std::nullopt;
+    depthFunction = std::nullopt;
+    depthMask = std::nullopt;
+    colorMask = std::nullopt;
+    for(std::size_t i = 0; i != 2; ++i) {
+        stencilFunction[i] = std::nullopt;
+        stencilOperation[i] = std::nullopt;
+        stencilMask[i] = std::nullopt;
+    }
+}
+
 RendererState::PixelStorage::PixelStorage():
     #ifndef MAGNUM_TARGET_GLES
     swapBytes{false},
@@ -25,9 +25,12 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <array>
 #include <string>
+#include <tuple>
 #include <vector>
 
+#include "Magnum/Context.h"
 #include "Magnum/Renderer.h"
 #include "Magnum/Math/Vector3.h"
 #include "MagnumExternal/Optional/optional.hpp"
@@ -73,6 +76,27 @@ struct RendererState {
     };
 
     PixelStorage packPixelStorage, unpackPixelStorage;
+
+    /* Shadowed state to avoid redundant calls. Empty optionals mean the
+       value is unknown and the next call will always hit GL. */
+    struct Shadow {
+        void reset();
+
+        std::vector<std::pair<GLenum, bool>> features;
+        std::optional<std::pair<GLenum, GLenum>> blendEquation;
+        std::optional<std::array<GLenum, 4>> blendFunction;
+        std::optional<std::array<GLfloat, 4>> blendColor;
+        std::optional<GLenum> depthFunction;
+        std::optional<GLboolean> depthMask;
+        std::optional<std::array<GLboolean, 4>> colorMask;
+
+        /* Front and back */
+        std::optional<std::tuple<GLenum, Int, UnsignedInt>> stencilFunction[2];
+        std::optional<std::array<GLenum, 3>> stencilOperation[2];
+        std::optional<UnsignedInt> stencilMask[2];
+    } shadow;
+
+    Context::StateStatistics statistics;
 };
 
 }}
@@ -32,10 +32,12 @@
 
 #include "BufferState.h"
 #include "ContextState.h"
+#include "DeletionState.h"
 #ifndef MAGNUM_TARGET_WEBGL
 #include "DebugState.h"
 #endif
 #include "FramebufferState.h"
+#include "MemoryState.h"
 #include "MeshState.h"
 #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
 #include "QueryState.h"
@@ -62,10 +64,12 @@ State::State(Context& context, std::ostream* const out) {
 
     buffer.reset(new BufferState{context, extensions});
     this->context.reset(new ContextState{context, extensions});
+    deletion.reset(new DeletionState);
     #ifndef MAGNUM_TARGET_WEBGL
     debug.reset(new DebugState{context, extensions});
     #endif
     framebuffer.reset(new FramebufferState{context, extensions});
+    memory.reset(new MemoryState);
     mesh.reset(new MeshState{context, *this->context, extensions});
     #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
     query.reset(new QueryState{context, extensions});
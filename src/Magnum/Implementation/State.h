@@ -34,10 +34,12 @@ namespace Magnum { namespace Implementation {
 
 struct BufferState;
 struct ContextState;
+struct DeletionState;
 #ifndef MAGNUM_TARGET_WEBGL
 struct DebugState;
 #endif
 struct FramebufferState;
+struct MemoryState;
 struct MeshState;
 #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
 struct QueryState;
@@ -60,10 +62,12 @@ struct State {
 
     std::unique_ptr<BufferState> buffer;
     std::unique_ptr<ContextState> context;
+    std::unique_ptr<DeletionState> deletion;
     #ifndef MAGNUM_TARGET_WEBGL
     std::unique_ptr<DebugState> debug;
     #endif
     std::unique_ptr<FramebufferState> framebuffer;
+    std::unique_ptr<MemoryState> memory;
     std::unique_ptr<MeshState> mesh;
     #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
     std::unique_ptr<QueryState> query;
@@ -34,6 +34,7 @@
 #endif
 #include "Magnum/Context.h"
 #include "Magnum/Extensions.h"
+#include "Magnum/Sampler.h"
 
 #include "State.h"
 
@@ -113,6 +114,21 @@ TextureState::TextureState(Context& context, std::vector<std::string>& extension
         bindMultiImplementation = &AbstractTexture::bindImplementationFallback;
     }
 
+    #ifndef MAGNUM_TARGET_GLES2
+    /* Sampler multi bind implementation */
+    #ifndef MAGNUM_TARGET_GLES
+    if(context.isExtensionSupported<Extensions::GL::ARB::multi_bind>()) {
+        /* Extension name added above */
+
+        bindSamplersImplementation = &Sampler::bindImplementationMulti;
+
+    } else
+    #endif
+    {
+        bindSamplersImplementation = &Sampler::bindImplementationFallback;
+    }
+    #endif
+
     /* DSA/non-DSA implementation */
     #ifndef MAGNUM_TARGET_GLES
     if(context.isExtensionSupported<Extensions::GL::ARB::direct_state_access>()) {
@@ -125,6 +141,7 @@ TextureState::TextureState(Context& context, std::vector<std::string>& extension
         parameterIuivImplementation = &AbstractTexture::parameterIImplementationDSA;
         parameterIivImplementation = &AbstractTexture::parameterIImplementationDSA;
         getLevelParameterivImplementation = &AbstractTexture::getLevelParameterImplementationDSA;
+        getParameterivImplementation = &AbstractTexture::getParameterImplementationDSA;
         mipmapImplementation = &AbstractTexture::mipmapImplementationDSA;
         subImage1DImplementation = &AbstractTexture::subImageImplementationDSA;
         subImage2DImplementation = &AbstractTexture::subImage2DImplementationDSA;
@@ -150,6 +167,7 @@ TextureState::TextureState(Context& context, std::vector<std::string>& extension
         parameterIuivImplementation = &AbstractTexture::parameterIImplementationDSAEXT;
         parameterIivImplementation = &AbstractTexture::parameterIImplementationDSAEXT;
         getLevelParameterivImplementation = &AbstractTexture::getLevelParameterImplementationDSAEXT;
+        getParameterivImplementation = &AbstractTexture::getParameterImplementationDSAEXT;
         mipmapImplementation = &AbstractTexture::mipmapImplementationDSAEXT;
         subImage1DImplementation = &AbstractTexture::subImageImplementationDSAEXT;
         subImage2DImplementation = &AbstractTexture::subImageImplementationDSAEXT;
@@ -181,6 +199,9 @@ TextureState::TextureState(Context& context, std::vector<std::string>& extension
         #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
         getLevelParameterivImplementation = &AbstractTexture::getLevelParameterImplementationDefault;
         #endif
+        #ifndef MAGNUM_TARGET_GLES
+        getParameterivImplementation = &AbstractTexture::getParameterImplementationDefault;
+        #endif
         mipmapImplementation = &AbstractTexture::mipmapImplementationDefault;
         #ifndef MAGNUM_TARGET_GLES
         subImage1DImplementation = &AbstractTexture::subImageImplementationDefault;
@@ -205,6 +226,18 @@ TextureState::TextureState(Context& context, std::vector<std::string>& extension
         cubeCompressedSubImageImplementation = &CubeMapTexture::compressedSubImageImplementationDefault;
     }
 
+    #ifndef MAGNUM_TARGET_GLES
+    /* Sparse texture page commitment implementation. ARB_sparse_texture has
+       only the EXT_DSA variant, ARB_DSA uses the bind-based one. */
+    if(context.isExtensionSupported<Extensions::GL::ARB::sparse_texture>()) {
+        extensions.emplace_back(Extensions::GL::ARB::sparse_texture::string());
+
+        if(context.isExtensionSupported<Extensions::GL::EXT::direct_state_access>())
+            pageCommitmentImplementation = &AbstractTexture::pageCommitmentImplementationDSAEXT;
+        else pageCommitmentImplementation = &AbstractTexture::pageCommitmentImplementationDefault;
+    } else pageCommitmentImplementation = &AbstractTexture::pageCommitmentImplementationDefault;
+    #endif
+
     /* Data invalidation implementation */
     #ifndef MAGNUM_TARGET_GLES
     if(context.isExtensionSupported<Extensions::GL::ARB::invalidate_subdata>()) {
@@ -430,6 +463,16 @@ TextureState::TextureState(Context& context, std::vector<std::string>& extension
     CORRADE_INTERNAL_ASSERT(maxTextureUnits > 0);
     bindings = Containers::Array<std::pair<GLenum, GLuint>>{Containers::ValueInit, std::size_t(maxTextureUnits)};
 
+    #ifndef MAGNUM_TARGET_GLES2
+    /* Allocate sampler bindings array to hold all possible texture units */
+    #ifndef MAGNUM_TARGET_GLES
+    if(context.isExtensionSupported<Extensions::GL::ARB::sampler_objects>())
+    #endif
+    {
+        samplerBindings = Containers::Array<GLuint>{Containers::ValueInit, std::size_t(maxTextureUnits)};
+    }
+    #endif
+
     #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
     /* Allocate image bindings array to hold all possible image units */
     #ifndef MAGNUM_TARGET_GLES
@@ -449,6 +492,9 @@ TextureState::~TextureState() = default;
 
 void TextureState::reset() {
     std::fill_n(bindings.begin(), bindings.size(), std::pair<GLenum, GLuint>{{}, State::DisengagedBinding});
+    #ifndef MAGNUM_TARGET_GLES2
+    std::fill_n(samplerBindings.begin(), samplerBindings.size(), State::DisengagedBinding);
+    #endif
     #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
     std::fill_n(imageBindings.begin(), imageBindings.size(), std::tuple<GLuint, GLint, GLboolean, GLint, GLenum>{State::DisengagedBinding, 0, false, 0, 0});
     #endif
@@ -55,6 +55,9 @@ struct TextureState {
     Int(*compressedBlockDataSizeImplementation)(GLenum, TextureFormat);
     void(*unbindImplementation)(GLint);
     void(*bindMultiImplementation)(GLint, Containers::ArrayView<AbstractTexture* const>);
+    #ifndef MAGNUM_TARGET_GLES2
+    void(*bindSamplersImplementation)(GLint, Containers::ArrayView<Sampler* const>);
+    #endif
     void(AbstractTexture::*createImplementation)();
     void(AbstractTexture::*bindImplementation)(GLint);
     void(AbstractTexture::*parameteriImplementation)(GLenum, GLint);
@@ -70,6 +73,10 @@ struct TextureState {
     void(AbstractTexture::*setMaxAnisotropyImplementation)(GLfloat);
     #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
     void(AbstractTexture::*getLevelParameterivImplementation)(GLint, GLenum, GLint*);
+    #ifndef MAGNUM_TARGET_GLES
+    void(AbstractTexture::*getParameterivImplementation)(GLenum, GLint*);
+    void(AbstractTexture::*pageCommitmentImplementation)(GLint, const Vector3i&, const Vector3i&, GLboolean);
+    #endif
     #endif
     void(AbstractTexture::*mipmapImplementation)();
     #ifndef MAGNUM_TARGET_GLES
@@ -150,6 +157,9 @@ struct TextureState {
     #endif
 
     Containers::Array<std::pair<GLenum, GLuint>> bindings;
+    #ifndef MAGNUM_TARGET_GLES2
+    Containers::Array<GLuint> samplerBindings;
+    #endif
     #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
     /* Texture object ID, level, layered, layer, access */
     Containers::Array<std::tuple<GLuint, GLint, GLboolean, GLint, GLenum>> imageBindings;
@@ -0,0 +1,54 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "imageStaging.h"
+
+#include "Magnum/Buffer.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+namespace Magnum { namespace Implementation {
+
+Containers::Array<GLintptr> stageImageData(Buffer& buffer, const Containers::ArrayView<const Containers::ArrayView<const char>> data) {
+    /* 16 bytes is enough for any pixel type incl. four-component doubles
+       on the row start */
+    constexpr GLintptr Alignment = 16;
+
+    Containers::Array<GLintptr> offsets{data.size()};
+    GLintptr size = 0;
+    for(std::size_t i = 0; i != data.size(); ++i) {
+        offsets[i] = size;
+        size += (data[i].size() + Alignment - 1)/Alignment*Alignment;
+    }
+
+    buffer.setData({nullptr, std::size_t(size)}, BufferUsage::StreamDraw);
+    for(std::size_t i = 0; i != data.size(); ++i)
+        buffer.setSubData(offsets[i], data[i]);
+
+    buffer.bindInternal(Buffer::TargetHint::PixelUnpack);
+    return offsets;
+}
+
+}}
+#endif
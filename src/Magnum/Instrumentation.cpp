@@ -0,0 +1,102 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Instrumentation.h"
+
+#include <Corrade/Utility/Debug.h>
+
+namespace Magnum { namespace Instrumentation {
+
+namespace {
+    #ifdef MAGNUM_BUILD_MULTITHREADED
+    #if !defined(CORRADE_GCC47_COMPATIBILITY) && !defined(CORRADE_TARGET_APPLE)
+    thread_local
+    #else
+    __thread
+    #endif
+    #endif
+    AbstractListener* currentListener = nullptr;
+
+    #ifdef MAGNUM_BUILD_MULTITHREADED
+    #if !defined(CORRADE_GCC47_COMPATIBILITY) && !defined(CORRADE_TARGET_APPLE)
+    thread_local
+    #else
+    __thread
+    #endif
+    #endif
+    std::uint64_t counters[CounterCount]{};
+}
+
+AbstractListener::~AbstractListener() = default;
+
+AbstractListener* listener() { return currentListener; }
+
+void setListener(AbstractListener* const listener) { currentListener = listener; }
+
+std::uint64_t counter(const Counter counter) { return counters[UnsignedByte(counter)]; }
+
+void resetCounters() {
+    for(std::uint64_t& counter: counters) counter = 0;
+}
+
+void count(const Counter counter, const std::uint64_t value) {
+    counters[UnsignedByte(counter)] += value;
+}
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+Debug& operator<<(Debug& debug, const Zone value) {
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case Zone::value: return debug << "Instrumentation::Zone::" #value;
+        _c(MeshDraw)
+        _c(TextureBind)
+        _c(CameraDraw)
+        _c(TextRendererRender)
+        _c(DepthPrepass)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "Instrumentation::Zone(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const Counter value) {
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case Counter::value: return debug << "Instrumentation::Counter::" #value;
+        _c(DrawCalls)
+        _c(BufferUploadBytes)
+        _c(TextureBinds)
+        _c(ShaderSwitches)
+        _c(FramebufferBytesAvoided)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "Instrumentation::Counter(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+#endif
+
+}}
@@ -0,0 +1,244 @@
+#ifndef Magnum_Instrumentation_h
+#define Magnum_Instrumentation_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Namespace @ref Magnum::Instrumentation, class @ref Magnum::Instrumentation::AbstractListener, @ref Magnum::Instrumentation::ScopedZone, enum @ref Magnum::Instrumentation::Zone, @ref Magnum::Instrumentation::Counter, macro @ref MAGNUM_INSTRUMENT_ZONE(), @ref MAGNUM_INSTRUMENT_COUNT()
+ */
+
+#include <cstdint>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum {
+
+/**
+@brief Instrumentation of library hot paths
+
+If the library is built with @ref MAGNUM_BUILD_INSTRUMENTATION enabled, hot
+paths such as @ref Mesh::draw(), @ref AbstractTexture::bind(),
+@ref SceneGraph::Camera::draw() or @ref Text::Renderer::render() are marked
+with scoped zones that are reported to the currently set
+@ref AbstractListener and the library updates per-thread counters of draw
+calls, uploaded buffer bytes, texture binds and shader switches. Otherwise the
+@ref MAGNUM_INSTRUMENT_ZONE() and @ref MAGNUM_INSTRUMENT_COUNT() macros
+compile to nothing and the counters stay at zero.
+
+@ref DebugTools::Profiler can act as a listener, see
+@ref DebugTools::Profiler::setInstrumentationEnabled() for more information.
+
+Both the listener and the counters are thread-local if the library is built
+with @ref MAGNUM_BUILD_MULTITHREADED, similarly to the current
+@ref Context.
+*/
+namespace Instrumentation {
+
+/**
+@brief Instrumented zone
+
+@see @ref AbstractListener, @ref MAGNUM_INSTRUMENT_ZONE()
+*/
+enum class Zone: UnsignedByte {
+    /** @ref Mesh::draw() and @ref MeshView::draw() */
+    MeshDraw,
+
+    /** @ref AbstractTexture::bind() */
+    TextureBind,
+
+    /**
+     * @ref SceneGraph::Camera::draw() and
+     * @ref SceneGraph::Camera::drawCulled()
+     */
+    CameraDraw,
+
+    /** @ref Text::Renderer::render() */
+    TextRendererRender,
+
+    /**
+     * Depth-only pass of @ref SceneGraph::DepthPrepass::draw(), nested in
+     * @ref Zone::CameraDraw
+     */
+    DepthPrepass
+};
+
+/** @brief Count of instrumented zones */
+enum: std::size_t { ZoneCount = std::size_t(Zone::DepthPrepass) + 1 };
+
+/** @debugoperatorenum{Magnum::Instrumentation::Zone} */
+MAGNUM_EXPORT Debug& operator<<(Debug& debug, Zone value);
+
+/**
+@brief Instrumentation counter
+
+@see @ref counter(), @ref MAGNUM_INSTRUMENT_COUNT()
+*/
+enum class Counter: UnsignedByte {
+    /**
+     * Draws submitted to the driver. Multi-draw and indirect draw calls
+     * count each contained draw separately.
+     */
+    DrawCalls,
+
+    /** Bytes uploaded with @ref Buffer::setData() and @ref Buffer::setSubData() */
+    BufferUploadBytes,
+
+    /** Textures actually bound, i.e. not counting redundant binds */
+    TextureBinds,
+
+    /** Shader programs actually switched in @ref AbstractShaderProgram::use() */
+    ShaderSwitches,
+
+    /**
+     * Framebuffer bytes that a tile-based GPU doesn't need to load or store
+     * thanks to clears and invalidation in @ref RenderPass
+     */
+    FramebufferBytesAvoided
+};
+
+/** @brief Count of instrumentation counters */
+enum: std::size_t { CounterCount = std::size_t(Counter::FramebufferBytesAvoided) + 1 };
+
+/** @debugoperatorenum{Magnum::Instrumentation::Counter} */
+MAGNUM_EXPORT Debug& operator<<(Debug& debug, Counter value);
+
+/**
+@brief Base for instrumentation listeners
+
+@see @ref setListener()
+*/
+class MAGNUM_EXPORT AbstractListener {
+    public:
+        virtual ~AbstractListener();
+
+        /** @brief Zone was entered */
+        virtual void zoneBegin(Zone zone) = 0;
+
+        /**
+         * @brief Zone was left
+         *
+         * Always paired with a preceding @ref zoneBegin() call, zones are
+         * properly nested.
+         */
+        virtual void zoneEnd(Zone zone) = 0;
+};
+
+/**
+@brief Current listener
+
+@see @ref setListener()
+*/
+MAGNUM_EXPORT AbstractListener* listener();
+
+/**
+@brief Set current listener
+
+Pass `nullptr` to remove the listener. Zones that are already entered are
+reported to the listener that was current when entering them.
+*/
+MAGNUM_EXPORT void setListener(AbstractListener* listener);
+
+/**
+@brief Counter value
+
+Accumulated since the last call to @ref resetCounters().
+*/
+MAGNUM_EXPORT std::uint64_t counter(Counter counter);
+
+/** @brief Reset all counters to zero */
+MAGNUM_EXPORT void resetCounters();
+
+/**
+@brief Increment a counter
+
+Called by the library through @ref MAGNUM_INSTRUMENT_COUNT(), can be called
+also directly.
+*/
+MAGNUM_EXPORT void count(Counter counter, std::uint64_t value);
+
+/**
+@brief Scoped instrumentation zone
+
+Reports @ref AbstractListener::zoneBegin() on construction and
+@ref AbstractListener::zoneEnd() on destruction, if there is a listener set.
+Used by the library through @ref MAGNUM_INSTRUMENT_ZONE().
+*/
+class ScopedZone {
+    public:
+        /** @brief Constructor */
+        explicit ScopedZone(Zone zone): _listener{listener()}, _zone{zone} {
+            if(_listener) _listener->zoneBegin(_zone);
+        }
+
+        /** @brief Copying is not allowed */
+        ScopedZone(const ScopedZone&) = delete;
+
+        /** @brief Destructor */
+        ~ScopedZone() {
+            if(_listener) _listener->zoneEnd(_zone);
+        }
+
+        /** @brief Copying is not allowed */
+        ScopedZone& operator=(const ScopedZone&) = delete;
+
+    private:
+        AbstractListener* _listener;
+        Zone _zone;
+};
+
+}
+
+}
+
+/** @hideinitializer
+@brief Mark the rest of the enclosing scope as an instrumented zone
+
+Expands to a @ref Magnum::Instrumentation::ScopedZone "Instrumentation::ScopedZone"
+instance if @ref MAGNUM_BUILD_INSTRUMENTATION is defined, to nothing
+otherwise. Can be used at most once per scope.
+*/
+#if defined(MAGNUM_BUILD_INSTRUMENTATION) || defined(DOXYGEN_GENERATING_OUTPUT)
+#define MAGNUM_INSTRUMENT_ZONE(zone)                                        \
+    Magnum::Instrumentation::ScopedZone _magnumInstrumentationZone{zone}
+#else
+#define MAGNUM_INSTRUMENT_ZONE(zone) do {} while(false)
+#endif
+
+/** @hideinitializer
+@brief Increment an instrumentation counter
+
+Calls @ref Magnum::Instrumentation::count() "Instrumentation::count()" if
+@ref MAGNUM_BUILD_INSTRUMENTATION is defined, expands to nothing otherwise
+and the arguments are not evaluated.
+*/
+#if defined(MAGNUM_BUILD_INSTRUMENTATION) || defined(DOXYGEN_GENERATING_OUTPUT)
+#define MAGNUM_INSTRUMENT_COUNT(counter, value)                             \
+    Magnum::Instrumentation::count(counter, value)
+#else
+#define MAGNUM_INSTRUMENT_COUNT(counter, value) do {} while(false)
+#endif
+
+#endif
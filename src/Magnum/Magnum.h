@@ -99,6 +99,30 @@ Magnum contexts. Enabled by default.
 #define MAGNUM_BUILD_MULTITHREADED
 #undef MAGNUM_BUILD_MULTITHREADED
 
+/**
+@brief Instrumented build
+
+Defined if the library is built with instrumentation zones and counters in
+hot paths. Disabled by default.
+@see @ref building, @ref cmake, @ref Magnum/Instrumentation.h
+*/
+#define MAGNUM_BUILD_INSTRUMENTATION
+#undef MAGNUM_BUILD_INSTRUMENTATION
+
+/**
+@brief SIMD math build
+
+Defined if the library is built with SSE, AVX, NEON or WebAssembly SIMD128
+implementation of multiplication, transposition and inversion of 4x4 float
+matrices and of 4x4 float matrix and vector multiplication. The SIMD
+implementation is used only if the compiler targets given instruction set,
+e.g. with `-msse2`, `-mavx`, `-mfpu=neon` or `-msimd128`, otherwise the
+generic implementation is used. Disabled by default.
+@see @ref building, @ref cmake
+*/
+#define MAGNUM_BUILD_MATH_SIMD
+#undef MAGNUM_BUILD_MATH_SIMD
+
 /**
 @brief OpenGL ES target
 
@@ -512,6 +536,7 @@ template<UnsignedInt, class T> class Array;
 template<class T> class Array1D;
 template<class T> class Array2D;
 template<class T> class Array3D;
+class ArrayPool;
 
 template<UnsignedInt, class> class Attribute;
 
@@ -530,6 +555,11 @@ typedef CompressedBufferImage<2> CompressedBufferImage2D;
 typedef CompressedBufferImage<3> CompressedBufferImage3D;
 #endif
 
+class BufferHeap;
+#ifndef MAGNUM_TARGET_GLES
+class BufferRing;
+#endif
+
 #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
 class BufferTexture;
 enum class BufferTextureFormat: GLenum;
@@ -540,6 +570,7 @@ template<class T> using BasicColor3 CORRADE_DEPRECATED_ALIAS("use Math::Color3 i
 template<class T> using BasicColor4 CORRADE_DEPRECATED_ALIAS("use Math::Color4 instead") = Math::Color4<T>;
 #endif
 
+class CommandBuffer;
 class Context;
 
 class CubeMapTexture;
@@ -551,9 +582,23 @@ class CubeMapTextureArray;
 /* DebugOutput, DebugMessage, DebugGroup used only statically */
 /* DefaultFramebuffer is available only through global instance */
 /* DimensionTraits forward declaration is not needed */
+class DirtyRanges;
+class DirtyRectangles;
 
 class Extension;
+#ifndef MAGNUM_TARGET_GLES2
+class Fence;
+#endif
 class Framebuffer;
+class FrameArena;
+template<class> class FrameArenaAllocator;
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+class FramebufferReadback;
+#endif
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+class FramePacer;
+#endif
 
 #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
 enum class ImageFormat: GLenum;
@@ -592,6 +637,9 @@ enum class MeshPrimitive: GLenum;
 class Mesh;
 class MeshView;
 
+class MirroredBuffer;
+class MirroredTexture2D;
+
 #ifndef MAGNUM_TARGET_GLES2
 /* MultisampleTextureSampleLocations enum used only in the function */
 template<UnsignedInt> class MultisampleTexture;
@@ -615,15 +663,25 @@ class CompressedPixelStorage;
 
 /* ObjectFlag, ObjectFlags are used only in conjunction with *::wrap() function */
 
+#ifndef MAGNUM_TARGET_GLES
+class PipelineStatisticsQuery;
+#endif
 class PrimitiveQuery;
 class SampleQuery;
 class TimeQuery;
 
+class RangeAllocator;
 class RectangleTexture;
 
 class Renderbuffer;
 enum class RenderbufferFormat: GLenum;
 
+class RenderPass;
+enum class RenderPassLoadAction: UnsignedByte;
+enum class RenderPassStoreAction: UnsignedByte;
+
+class RenderTargetPool;
+
 enum class ResourceState: UnsignedByte;
 enum class ResourceDataState: UnsignedByte;
 enum class ResourcePolicy: UnsignedByte;
@@ -633,6 +691,9 @@ template<class...> class ResourceManager;
 
 class Sampler;
 class Shader;
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+class ShaderProgramBinaryCache;
+#endif
 
 template<UnsignedInt> class Texture;
 #ifndef MAGNUM_TARGET_GLES
@@ -653,10 +714,22 @@ typedef TextureArray<2> Texture2DArray;
 
 enum class TextureFormat: GLenum;
 
+#ifndef MAGNUM_TARGET_GLES2
+class TextureStreamer;
+#endif
+
 class TransformFeedback;
 class Timeline;
 
 enum class Version: Int;
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+class VertexFormat;
+#endif
+
+#ifndef MAGNUM_TARGET_GLES
+class VirtualTexture;
+#endif
 #endif
 
 }
@@ -0,0 +1,466 @@
+#ifndef Magnum_Math_Algorithms_Batch_h
+#define Magnum_Math_Algorithms_Batch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Math::Algorithms::svdBatch(), @ref Magnum::Math::Algorithms::qrBatch(), @ref Magnum::Math::Algorithms::gaussJordanBatch(), @ref Magnum::Math::Algorithms::invertedBatch()
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <tuple>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/Assert.h>
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#include <vector>
+#endif
+
+#include "Magnum/Math/Algorithms/GaussJordan.h"
+#include "Magnum/Math/Algorithms/Qr.h"
+
+namespace Magnum { namespace Math { namespace Algorithms {
+
+namespace Implementation {
+
+/* Count of matrices processed together in the structure-of-arrays kernels.
+   Each lane loop is a plain loop over arrays of this size, which the
+   compiler turns into SIMD code for any vector width up to 16 floats. */
+enum: std::size_t { BatchLaneCount = 16 };
+
+/* Below this matrix count the thread startup overhead outweighs the gains */
+enum: std::size_t { BatchMinItemCount = 8192 };
+
+/* Calls function(begin, end) on contiguous chunks of [0, count), each chunk
+   on a separate thread. If threadCount is 0, the count is
+   std::thread::hardware_concurrency(). For small counts and on Emscripten
+   the function is called just once for the whole range on the calling
+   thread. */
+template<class F> void batchParallelFor(const std::size_t count, unsigned int threadCount, F function) {
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    if(!threadCount) threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    const std::size_t chunkCount = std::min(std::size_t(threadCount), count/BatchMinItemCount);
+    if(chunkCount > 1) {
+        /* Keep the chunks aligned to whole lane blocks */
+        const std::size_t chunkSize = ((count + chunkCount - 1)/chunkCount + BatchLaneCount - 1)/BatchLaneCount*BatchLaneCount;
+        std::vector<std::thread> threads;
+        threads.reserve(chunkCount - 1);
+        for(std::size_t i = 1; i != chunkCount && i*chunkSize < count; ++i)
+            threads.emplace_back(function, i*chunkSize, std::min((i + 1)*chunkSize, count));
+        function(std::size_t{0}, std::min(chunkSize, count));
+        for(std::thread& thread: threads) thread.join();
+        return;
+    }
+    #else
+    static_cast<void>(threadCount);
+    #endif
+
+    function(std::size_t{0}, count);
+}
+
+/* std::sqrt() may set errno, which prevents vectorization unless
+   -fno-math-errno is used. This is a fast inverse square root estimate refined
+   with Newton iterations to full precision, which consists of only bit
+   operations and arithmetic and thus vectorizes everywhere. */
+inline Float batchInverseSqrt(const Float x) {
+    std::int32_t i;
+    std::memcpy(&i, &x, sizeof(Float));
+    i = 0x5f3759df - (i >> 1);
+    Float y;
+    std::memcpy(&y, &i, sizeof(Float));
+    for(std::size_t k = 0; k != 3; ++k) y = y*(1.5f - 0.5f*x*y*y);
+    return y;
+}
+
+inline Double batchInverseSqrt(const Double x) {
+    std::int64_t i;
+    std::memcpy(&i, &x, sizeof(Double));
+    i = 0x5fe6eb50c7b537a9ll - (i >> 1);
+    Double y;
+    std::memcpy(&y, &i, sizeof(Double));
+    for(std::size_t k = 0; k != 4; ++k) y = y*(1.5 - 0.5*x*y*y);
+    return y;
+}
+
+template<class T> inline T batchInverseSqrt(const T x) {
+    return T(1)/std::sqrt(x);
+}
+
+/* One Jacobi rotation of a symmetric 3x3 matrix s (stored as the upper
+   triangle) zeroing the (p, q) element, accumulated into v. All lanes take
+   the same path, a zero element results in an identity rotation. */
+template<std::size_t p, std::size_t q, std::size_t r, class T> inline void svdJacobiRotation(T(&s)[3][3][BatchLaneCount], T(&v)[3][3][BatchLaneCount]) {
+    for(std::size_t l = 0; l != BatchLaneCount; ++l) {
+        const T spq = s[p][q][l];
+        const bool rotate = spq != T(0);
+        const T theta = (s[q][q][l] - s[p][p][l])/(rotate ? T(2)*spq : T(1));
+
+        /* For large theta the square would overflow, t is 1/(2 theta) in
+           that case */
+        const bool large = std::abs(theta) > T(1)/std::numeric_limits<T>::epsilon();
+        const T thetaSquared1 = (large ? T(1) : theta*theta) + T(1);
+        const T t = large ? T(0.5)/theta :
+            (theta < T(0) ? T(-1) : T(1))/(std::abs(theta) + thetaSquared1*batchInverseSqrt(thetaSquared1));
+        const T tr = rotate ? t : T(0);
+        const T c = batchInverseSqrt(tr*tr + T(1));
+        const T sn = tr*c;
+
+        s[p][p][l] -= tr*spq;
+        s[q][q][l] += tr*spq;
+        s[p][q][l] = T(0);
+
+        /* The remaining off-diagonal elements, stored as (min, max) */
+        const T srp = s[std::min(r, p)][std::max(r, p)][l];
+        const T srq = s[std::min(r, q)][std::max(r, q)][l];
+        s[std::min(r, p)][std::max(r, p)][l] = c*srp - sn*srq;
+        s[std::min(r, q)][std::max(r, q)][l] = sn*srp + c*srq;
+
+        for(std::size_t k = 0; k != 3; ++k) {
+            const T vkp = v[p][k][l];
+            const T vkq = v[q][k][l];
+            v[p][k][l] = c*vkp - sn*vkq;
+            v[q][k][l] = sn*vkp + c*vkq;
+        }
+    }
+}
+
+/* Swaps columns i and j of b and v in lanes where column j has larger
+   norm */
+template<std::size_t i, std::size_t j, class T> inline void svdSortColumns(T(&b)[3][3][BatchLaneCount], T(&v)[3][3][BatchLaneCount], T(&norm)[3][BatchLaneCount]) {
+    for(std::size_t l = 0; l != BatchLaneCount; ++l) {
+        const bool swap = norm[j][l] > norm[i][l];
+        const T ni = norm[i][l], nj = norm[j][l];
+        norm[i][l] = swap ? nj : ni;
+        norm[j][l] = swap ? ni : nj;
+        for(std::size_t k = 0; k != 3; ++k) {
+            const T bi = b[i][k][l], bj = b[j][k][l];
+            b[i][k][l] = swap ? bj : bi;
+            b[j][k][l] = swap ? bi : bj;
+            const T vi = v[i][k][l], vj = v[j][k][l];
+            v[i][k][l] = swap ? vj : vi;
+            v[j][k][l] = swap ? vi : vj;
+        }
+    }
+}
+
+/* Givens rotation of rows p, q of b zeroing b(q, col), accumulated into
+   columns of u */
+template<std::size_t col, std::size_t p, std::size_t q, class T> inline void svdGivensRotation(T(&b)[3][3][BatchLaneCount], T(&u)[3][3][BatchLaneCount]) {
+    for(std::size_t l = 0; l != BatchLaneCount; ++l) {
+        const T x = b[col][p][l];
+        const T y = b[col][q][l];
+        const T lengthSquared = x*x + y*y;
+        const bool rotate = lengthSquared != T(0);
+        const T invLength = batchInverseSqrt(rotate ? lengthSquared : T(1));
+        const T c = rotate ? x*invLength : T(1);
+        const T s = rotate ? y*invLength : T(0);
+
+        for(std::size_t k = 0; k != 3; ++k) {
+            const T bp = b[k][p][l], bq = b[k][q][l];
+            b[k][p][l] = c*bp + s*bq;
+            b[k][q][l] = -s*bp + c*bq;
+            const T up = u[p][k][l], uq = u[q][k][l];
+            u[p][k][l] = c*up + s*uq;
+            u[q][k][l] = -s*up + c*uq;
+        }
+    }
+}
+
+template<class T> constexpr std::size_t svdJacobiSweepCount() {
+    return sizeof(T) <= 4 ? 5 : 8;
+}
+
+}
+
+/**
+@brief Batch SVD of 3x3 matrices
+@param matrices     Input matrices
+@param u            Where to put the @f$ U @f$ matrices
+@param w            Where to put diagonals of the @f$ \Sigma @f$ matrices
+@param v            Where to put the @f$ V @f$ matrices
+@param threadCount  Count of threads to use. If `0`,
+    `std::thread::hardware_concurrency()` is used.
+
+Equivalent to calling @ref svd() on each matrix, but the matrices are
+processed in structure-of-arrays blocks of several matrices at once with no
+data-dependent branches, which allows the compiler to vectorize the code, and
+the blocks are distributed over @p threadCount threads. Expects that all views
+have the same size.
+
+Instead of the iterative Golub-Reinsch algorithm, a fixed number of cyclic
+Jacobi sweeps diagonalizes @f$ M^T M @f$ to get @f$ V @f$. The @f$ U @f$
+matrix and singular values are then taken from Givens QR decomposition of
+@f$ M V @f$ with columns sorted by their length, following *McAdams, A.;
+Selle, A.; Tamstorf, R.; Teran, J.; Sifakis, E. (2011). "Computing the
+Singular Value Decomposition of 3x3 matrices with minimal branching and
+elementary floating point operations"*. Unlike with @ref svd(), the singular
+values are always sorted in descending order and @f$ U @f$ is orthonormal
+even for singular matrices, so @f$ M = U \Sigma V^T @f$ holds exactly up to
+floating-point precision.
+
+Except on Emscripten, code using this header needs to be linked to the
+platform thread library.
+@see @ref invertedBatch(), @ref qrBatch(), @ref gaussJordanBatch()
+*/
+template<class T> void svdBatch(Corrade::Containers::ArrayView<const Matrix<3, T>> matrices, Corrade::Containers::ArrayView<Matrix<3, T>> u, Corrade::Containers::ArrayView<Vector<3, T>> w, Corrade::Containers::ArrayView<Matrix<3, T>> v, unsigned int threadCount = 0) {
+    CORRADE_ASSERT(u.size() == matrices.size() && w.size() == matrices.size() && v.size() == matrices.size(),
+        "Math::Algorithms::svdBatch(): expected" << matrices.size() << "outputs but got" << u.size() << Corrade::Utility::Debug::nospace << "," << w.size() << "and" << v.size(), );
+
+    using Implementation::BatchLaneCount;
+    Implementation::batchParallelFor(matrices.size(), threadCount, [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t block = begin; block < end; block += BatchLaneCount) {
+            const std::size_t count = std::min(std::size_t(BatchLaneCount), end - block);
+
+            /* Gather the matrices, pad the last block with zero matrices */
+            T a[3][3][BatchLaneCount];
+            for(std::size_t l = 0; l != BatchLaneCount; ++l)
+                for(std::size_t i = 0; i != 3; ++i)
+                    for(std::size_t j = 0; j != 3; ++j)
+                        a[i][j][l] = l < count ? matrices[block + l][i][j] : T(0);
+
+            /* Upper triangle of M^T M, V is identity */
+            T s[3][3][BatchLaneCount];
+            T vl[3][3][BatchLaneCount];
+            for(std::size_t i = 0; i != 3; ++i) for(std::size_t j = 0; j != 3; ++j) {
+                for(std::size_t l = 0; l != BatchLaneCount; ++l) {
+                    s[i][j][l] = a[i][0][l]*a[j][0][l] + a[i][1][l]*a[j][1][l] + a[i][2][l]*a[j][2][l];
+                    vl[i][j][l] = i == j ? T(1) : T(0);
+                }
+            }
+
+            /* Cyclic Jacobi sweeps, each zeroing all off-diagonal elements
+               once. Convergence is quadratic, so a fixed small count is
+               enough for full precision. */
+            for(std::size_t sweep = 0; sweep != Implementation::svdJacobiSweepCount<T>(); ++sweep) {
+                Implementation::svdJacobiRotation<0, 1, 2>(s, vl);
+                Implementation::svdJacobiRotation<0, 2, 1>(s, vl);
+                Implementation::svdJacobiRotation<1, 2, 0>(s, vl);
+            }
+
+            /* B = M V, with columns sorted by length */
+            T b[3][3][BatchLaneCount];
+            T norm[3][BatchLaneCount];
+            for(std::size_t i = 0; i != 3; ++i) {
+                for(std::size_t j = 0; j != 3; ++j)
+                    for(std::size_t l = 0; l != BatchLaneCount; ++l)
+                        b[i][j][l] = a[0][j][l]*vl[i][0][l] + a[1][j][l]*vl[i][1][l] + a[2][j][l]*vl[i][2][l];
+                for(std::size_t l = 0; l != BatchLaneCount; ++l)
+                    norm[i][l] = b[i][0][l]*b[i][0][l] + b[i][1][l]*b[i][1][l] + b[i][2][l]*b[i][2][l];
+            }
+            Implementation::svdSortColumns<0, 1>(b, vl, norm);
+            Implementation::svdSortColumns<0, 2>(b, vl, norm);
+            Implementation::svdSortColumns<1, 2>(b, vl, norm);
+
+            /* QR decomposition of B, which has orthogonal columns and thus R
+               is diagonal */
+            T ul[3][3][BatchLaneCount];
+            for(std::size_t i = 0; i != 3; ++i)
+                for(std::size_t j = 0; j != 3; ++j)
+                    for(std::size_t l = 0; l != BatchLaneCount; ++l)
+                        ul[i][j][l] = i == j ? T(1) : T(0);
+            Implementation::svdGivensRotation<0, 0, 1>(b, ul);
+            Implementation::svdGivensRotation<0, 0, 2>(b, ul);
+            Implementation::svdGivensRotation<1, 1, 2>(b, ul);
+
+            /* Only the last diagonal element can be negative, flip the
+               corresponding U column in that case */
+            for(std::size_t l = 0; l != BatchLaneCount; ++l) {
+                const T sign = b[2][2][l] < T(0) ? T(-1) : T(1);
+                b[2][2][l] *= sign;
+                for(std::size_t k = 0; k != 3; ++k) ul[2][k][l] *= sign;
+            }
+
+            /* Scatter the results */
+            for(std::size_t l = 0; l != count; ++l) {
+                for(std::size_t i = 0; i != 3; ++i) {
+                    for(std::size_t j = 0; j != 3; ++j) {
+                        u[block + l][i][j] = ul[i][j][l];
+                        v[block + l][i][j] = vl[i][j][l];
+                    }
+                    w[block + l][i] = b[i][i][l];
+                }
+            }
+        }
+    });
+}
+
+/**
+@brief Batch 4x4 matrix inversion
+@param matrices     Input matrices
+@param inverted     Where to put the inverted matrices
+@param threadCount  Count of threads to use. If `0`,
+    `std::thread::hardware_concurrency()` is used.
+
+Equivalent to calling @ref Matrix::inverted() on each matrix, but uses a
+closed-form cofactor expansion computed in structure-of-arrays blocks of
+several matrices at once, which allows the compiler to vectorize the code, and
+distributes the blocks over @p threadCount threads. Expects that both views
+have the same size and that the matrices are invertible, otherwise the
+result contains infinities or NaNs. The views can alias each other for
+in-place inversion.
+@see @ref svdBatch(), @ref gaussJordanBatch()
+*/
+template<class T> void invertedBatch(Corrade::Containers::ArrayView<const Matrix<4, T>> matrices, Corrade::Containers::ArrayView<Matrix<4, T>> inverted, unsigned int threadCount = 0) {
+    CORRADE_ASSERT(inverted.size() == matrices.size(),
+        "Math::Algorithms::invertedBatch(): expected" << matrices.size() << "outputs but got" << inverted.size(), );
+
+    using Implementation::BatchLaneCount;
+    Implementation::batchParallelFor(matrices.size(), threadCount, [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t block = begin; block < end; block += BatchLaneCount) {
+            const std::size_t count = std::min(std::size_t(BatchLaneCount), end - block);
+
+            /* Gather the matrices, pad the last block with identities */
+            T a[4][4][BatchLaneCount];
+            for(std::size_t l = 0; l != BatchLaneCount; ++l)
+                for(std::size_t i = 0; i != 4; ++i)
+                    for(std::size_t j = 0; j != 4; ++j)
+                        a[i][j][l] = l < count ? matrices[block + l][i][j] : T(i == j ? 1 : 0);
+
+            /* As (A^T)^-1 = (A^-1)^T, the expansion gives correct result
+               regardless of whether a[i][j] is treated as row or column
+               major, as long as the output is indexed the same way */
+            T b[4][4][BatchLaneCount];
+            for(std::size_t l = 0; l != BatchLaneCount; ++l) {
+                const T s0 = a[0][0][l]*a[1][1][l] - a[1][0][l]*a[0][1][l];
+                const T s1 = a[0][0][l]*a[1][2][l] - a[1][0][l]*a[0][2][l];
+                const T s2 = a[0][0][l]*a[1][3][l] - a[1][0][l]*a[0][3][l];
+                const T s3 = a[0][1][l]*a[1][2][l] - a[1][1][l]*a[0][2][l];
+                const T s4 = a[0][1][l]*a[1][3][l] - a[1][1][l]*a[0][3][l];
+                const T s5 = a[0][2][l]*a[1][3][l] - a[1][2][l]*a[0][3][l];
+
+                const T c5 = a[2][2][l]*a[3][3][l] - a[3][2][l]*a[2][3][l];
+                const T c4 = a[2][1][l]*a[3][3][l] - a[3][1][l]*a[2][3][l];
+                const T c3 = a[2][1][l]*a[3][2][l] - a[3][1][l]*a[2][2][l];
+                const T c2 = a[2][0][l]*a[3][3][l] - a[3][0][l]*a[2][3][l];
+                const T c1 = a[2][0][l]*a[3][2][l] - a[3][0][l]*a[2][2][l];
+                const T c0 = a[2][0][l]*a[3][1][l] - a[3][0][l]*a[2][1][l];
+
+                const T invDet = T(1)/(s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0);
+
+                b[0][0][l] = ( a[1][1][l]*c5 - a[1][2][l]*c4 + a[1][3][l]*c3)*invDet;
+                b[0][1][l] = (-a[0][1][l]*c5 + a[0][2][l]*c4 - a[0][3][l]*c3)*invDet;
+                b[0][2][l] = ( a[3][1][l]*s5 - a[3][2][l]*s4 + a[3][3][l]*s3)*invDet;
+                b[0][3][l] = (-a[2][1][l]*s5 + a[2][2][l]*s4 - a[2][3][l]*s3)*invDet;
+
+                b[1][0][l] = (-a[1][0][l]*c5 + a[1][2][l]*c2 - a[1][3][l]*c1)*invDet;
+                b[1][1][l] = ( a[0][0][l]*c5 - a[0][2][l]*c2 + a[0][3][l]*c1)*invDet;
+                b[1][2][l] = (-a[3][0][l]*s5 + a[3][2][l]*s2 - a[3][3][l]*s1)*invDet;
+                b[1][3][l] = ( a[2][0][l]*s5 - a[2][2][l]*s2 + a[2][3][l]*s1)*invDet;
+
+                b[2][0][l] = ( a[1][0][l]*c4 - a[1][1][l]*c2 + a[1][3][l]*c0)*invDet;
+                b[2][1][l] = (-a[0][0][l]*c4 + a[0][1][l]*c2 - a[0][3][l]*c0)*invDet;
+                b[2][2][l] = ( a[3][0][l]*s4 - a[3][1][l]*s2 + a[3][3][l]*s0)*invDet;
+                b[2][3][l] = (-a[2][0][l]*s4 + a[2][1][l]*s2 - a[2][3][l]*s0)*invDet;
+
+                b[3][0][l] = (-a[1][0][l]*c3 + a[1][1][l]*c1 - a[1][2][l]*c0)*invDet;
+                b[3][1][l] = ( a[0][0][l]*c3 - a[0][1][l]*c1 + a[0][2][l]*c0)*invDet;
+                b[3][2][l] = (-a[3][0][l]*s3 + a[3][1][l]*s1 - a[3][2][l]*s0)*invDet;
+                b[3][3][l] = ( a[2][0][l]*s3 - a[2][1][l]*s1 + a[2][2][l]*s0)*invDet;
+            }
+
+            /* Scatter the results */
+            for(std::size_t l = 0; l != count; ++l)
+                for(std::size_t i = 0; i != 4; ++i)
+                    for(std::size_t j = 0; j != 4; ++j)
+                        inverted[block + l][i][j] = b[i][j][l];
+        }
+    });
+}
+
+/**
+@brief Batch QR decomposition
+@param matrices     Input matrices
+@param q            Where to put the @f$ Q @f$ matrices
+@param r            Where to put the @f$ R @f$ matrices
+@param threadCount  Count of threads to use. If `0`,
+    `std::thread::hardware_concurrency()` is used.
+
+Calls @ref qr() on each matrix, distributing the work over @p threadCount
+threads. Expects that all views have the same size.
+@see @ref svdBatch()
+*/
+template<std::size_t size, class T> void qrBatch(Corrade::Containers::ArrayView<const Matrix<size, T>> matrices, Corrade::Containers::ArrayView<Matrix<size, T>> q, Corrade::Containers::ArrayView<Matrix<size, T>> r, unsigned int threadCount = 0) {
+    CORRADE_ASSERT(q.size() == matrices.size() && r.size() == matrices.size(),
+        "Math::Algorithms::qrBatch(): expected" << matrices.size() << "outputs but got" << q.size() << "and" << r.size(), );
+
+    Implementation::batchParallelFor(matrices.size(), threadCount, [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i)
+            std::tie(q[i], r[i]) = qr(matrices[i]);
+    });
+}
+
+/**
+@brief Batch Gauss-Jordan solver
+@param a            Left sides of the systems
+@param b            Right sides of the systems
+@param x            Where to put the solutions
+@param threadCount  Count of threads to use. If `0`,
+    `std::thread::hardware_concurrency()` is used.
+@return True if all systems are regular, false if any of them is singular
+
+Solves @f$ A_i x_i = b_i @f$ for each system using
+@ref gaussJordanInPlaceTransposed(), distributing the work over
+@p threadCount threads. Solutions of singular systems are filled with NaNs,
+so these can be detected individually. Expects that all views have the same
+size.
+@see @ref invertedBatch()
+*/
+template<std::size_t size, class T> bool gaussJordanBatch(Corrade::Containers::ArrayView<const Matrix<size, T>> a, Corrade::Containers::ArrayView<const Vector<size, T>> b, Corrade::Containers::ArrayView<Vector<size, T>> x, unsigned int threadCount = 0) {
+    CORRADE_ASSERT(b.size() == a.size() && x.size() == a.size(),
+        "Math::Algorithms::gaussJordanBatch(): expected" << a.size() << "right sides and solutions but got" << b.size() << "and" << x.size(), {});
+
+    std::atomic<bool> regular{true};
+    Implementation::batchParallelFor(a.size(), threadCount, [&](const std::size_t begin, const std::size_t end) {
+        bool chunkRegular = true;
+        for(std::size_t i = begin; i != end; ++i) {
+            /* Transposed A of a system with one right side is just A^T and b
+               as a single row */
+            Matrix<size, T> transposed = a[i].transposed();
+            RectangularMatrix<size, 1, T> solution;
+            for(std::size_t j = 0; j != size; ++j) solution[j][0] = b[i][j];
+
+            if(!gaussJordanInPlaceTransposed(transposed, solution)) {
+                x[i] = Vector<size, T>{std::numeric_limits<T>::quiet_NaN()};
+                chunkRegular = false;
+                continue;
+            }
+
+            for(std::size_t j = 0; j != size; ++j) x[i][j] = solution[j][0];
+        }
+
+        if(!chunkRegular) regular = false;
+    });
+
+    return regular;
+}
+
+}}}
+
+#endif
@@ -0,0 +1,403 @@
+#ifndef Magnum_Math_Algorithms_Reduce_h
+#define Magnum_Math_Algorithms_Reduce_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Math::Algorithms::minmax(), @ref Magnum::Math::Algorithms::bounds(), @ref Magnum::Math::Algorithms::pairwiseSum(), @ref Magnum::Math::Algorithms::compensatedSum(), @ref Magnum::Math::Algorithms::mean()
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#endif
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Math/Algorithms/KahanSum.h"
+
+namespace Magnum { namespace Math { namespace Algorithms {
+
+namespace Implementation {
+
+/* Count of items processed together. Each lane loop is a plain loop over
+   arrays of this size, which the compiler turns into SIMD code. */
+enum: std::size_t { ReduceLaneCount = 16 };
+
+/* The input is split into blocks of this size independently of the thread
+   count, so the result is always the same regardless of how many threads
+   were used */
+enum: std::size_t { ReduceBlockSize = 4096 };
+
+/* Below this item count the thread startup overhead outweighs the gains */
+enum: std::size_t { ReduceMinItemCount = 65536 };
+
+/* Largest range summed directly in the pairwise summation */
+enum: std::size_t { ReducePairwiseBaseSize = 256 };
+
+/* Uniform component access for scalars and vectors */
+template<class T, bool = std::is_arithmetic<T>::value> struct ReduceTraits;
+template<class T> struct ReduceTraits<T, true> {
+    typedef T Type;
+    enum: std::size_t { Size = 1 };
+    static T get(const T& value, std::size_t) { return value; }
+    static T& ref(T& value, std::size_t) { return value; }
+};
+template<class T> struct ReduceTraits<T, false> {
+    typedef typename T::Type Type;
+    enum: std::size_t { Size = T::Size };
+    static Type get(const T& value, std::size_t i) { return value[i]; }
+    static Type& ref(T& value, std::size_t i) { return value[i]; }
+};
+
+template<class T> inline const T& reduceAt(const T* const data, const std::size_t stride, const std::size_t i) {
+    return *reinterpret_cast<const T*>(reinterpret_cast<const char*>(data) + i*stride);
+}
+
+/* Calls function(begin, end) for each block of [0, count) and returns the
+   partial results. Contiguous ranges of blocks are distributed over
+   threadCount threads, if 0, the count is std::thread::hardware_concurrency().
+   For small counts and on Emscripten everything is done on the calling
+   thread. */
+template<class R, class F> std::vector<R> reduceBlocks(const std::size_t count, unsigned int threadCount, F function) {
+    const std::size_t blockCount = (count + ReduceBlockSize - 1)/ReduceBlockSize;
+    std::vector<R> partials(blockCount);
+    const auto run = [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t block = begin; block != end; ++block)
+            partials[block] = function(block*ReduceBlockSize, std::min((block + 1)*ReduceBlockSize, count));
+    };
+
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    if(!threadCount) threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    const std::size_t chunkCount = std::min(std::size_t(threadCount), count/ReduceMinItemCount);
+    if(chunkCount > 1) {
+        const std::size_t chunkSize = (blockCount + chunkCount - 1)/chunkCount;
+        std::vector<std::thread> threads;
+        threads.reserve(chunkCount - 1);
+        for(std::size_t i = 1; i != chunkCount && i*chunkSize < blockCount; ++i)
+            threads.emplace_back(run, i*chunkSize, std::min((i + 1)*chunkSize, blockCount));
+        run(0, std::min(chunkSize, blockCount));
+        for(std::thread& thread: threads) thread.join();
+        return partials;
+    }
+    #else
+    static_cast<void>(threadCount);
+    #endif
+
+    run(0, blockCount);
+    return partials;
+}
+
+template<class T> std::pair<T, T> minmaxBlock(const T* const data, const std::size_t stride, const std::size_t begin, const std::size_t end) {
+    typedef ReduceTraits<T> Traits;
+    typedef typename Traits::Type U;
+    enum: std::size_t { Size = Traits::Size };
+
+    /* Structure-of-arrays lanes, initialized with the first item */
+    const T& first = reduceAt(data, stride, begin);
+    U min[Size][ReduceLaneCount], max[Size][ReduceLaneCount];
+    for(std::size_t c = 0; c != Size; ++c) for(std::size_t l = 0; l != ReduceLaneCount; ++l)
+        min[c][l] = max[c][l] = Traits::get(first, c);
+
+    std::size_t i = begin;
+    for(; i + ReduceLaneCount <= end; i += ReduceLaneCount) {
+        for(std::size_t c = 0; c != Size; ++c) for(std::size_t l = 0; l != ReduceLaneCount; ++l) {
+            const U value = Traits::get(reduceAt(data, stride, i + l), c);
+            min[c][l] = value < min[c][l] ? value : min[c][l];
+            max[c][l] = value > max[c][l] ? value : max[c][l];
+        }
+    }
+    for(; i != end; ++i) for(std::size_t c = 0; c != Size; ++c) {
+        const U value = Traits::get(reduceAt(data, stride, i), c);
+        min[c][0] = value < min[c][0] ? value : min[c][0];
+        max[c][0] = value > max[c][0] ? value : max[c][0];
+    }
+
+    std::pair<T, T> out{first, first};
+    for(std::size_t c = 0; c != Size; ++c) {
+        U& outMin = Traits::ref(out.first, c);
+        U& outMax = Traits::ref(out.second, c);
+        outMin = *std::min_element(min[c], min[c] + ReduceLaneCount);
+        outMax = *std::max_element(max[c], max[c] + ReduceLaneCount);
+    }
+    return out;
+}
+
+template<class T> T pairwiseSumBlock(const T* const data, const std::size_t stride, const std::size_t begin, const std::size_t end) {
+    /* Split in halves until the range is small enough */
+    if(end - begin > ReducePairwiseBaseSize) {
+        const std::size_t middle = begin + (end - begin)/2;
+        return pairwiseSumBlock(data, stride, begin, middle) + pairwiseSumBlock(data, stride, middle, end);
+    }
+
+    typedef ReduceTraits<T> Traits;
+    typedef typename Traits::Type U;
+    enum: std::size_t { Size = Traits::Size };
+
+    U sum[Size][ReduceLaneCount]{};
+    std::size_t i = begin;
+    for(; i + ReduceLaneCount <= end; i += ReduceLaneCount)
+        for(std::size_t c = 0; c != Size; ++c) for(std::size_t l = 0; l != ReduceLaneCount; ++l)
+            sum[c][l] += Traits::get(reduceAt(data, stride, i + l), c);
+    for(; i != end; ++i) for(std::size_t c = 0; c != Size; ++c)
+        sum[c][0] += Traits::get(reduceAt(data, stride, i), c);
+
+    /* Sum the lanes pairwise as well */
+    T out{};
+    for(std::size_t c = 0; c != Size; ++c) {
+        for(std::size_t n = ReduceLaneCount/2; n; n /= 2)
+            for(std::size_t l = 0; l != n; ++l) sum[c][l] += sum[c][l + n];
+        Traits::ref(out, c) = sum[c][0];
+    }
+    return out;
+}
+
+template<class T> T pairwiseSumPartials(const T* const partials, const std::size_t count) {
+    if(count == 1) return partials[0];
+    const std::size_t half = count/2;
+    return pairwiseSumPartials(partials, half) + pairwiseSumPartials(partials + half, count - half);
+}
+
+template<class T> T compensatedSumBlock(const T* const data, const std::size_t stride, const std::size_t begin, const std::size_t end, T& compensation) {
+    typedef ReduceTraits<T> Traits;
+    typedef typename Traits::Type U;
+    enum: std::size_t { Size = Traits::Size };
+
+    /* Kahan summation in each lane */
+    U sum[Size][ReduceLaneCount]{}, c[Size][ReduceLaneCount]{};
+    const auto add = [&](const std::size_t component, const std::size_t l, const U value) {
+        const U y = value - c[component][l];
+        const U t = sum[component][l] + y;
+        c[component][l] = (t - sum[component][l]) - y;
+        sum[component][l] = t;
+    };
+    std::size_t i = begin;
+    for(; i + ReduceLaneCount <= end; i += ReduceLaneCount)
+        for(std::size_t k = 0; k != Size; ++k) for(std::size_t l = 0; l != ReduceLaneCount; ++l)
+            add(k, l, Traits::get(reduceAt(data, stride, i + l), k));
+    for(; i != end; ++i) for(std::size_t k = 0; k != Size; ++k)
+        add(k, 0, Traits::get(reduceAt(data, stride, i), k));
+
+    /* Combine the lanes, keeping the compensation */
+    T out{};
+    compensation = T{};
+    for(std::size_t k = 0; k != Size; ++k) {
+        U laneCompensation{};
+        for(std::size_t l = 0; l != ReduceLaneCount; ++l) laneCompensation += c[k][l];
+        U& outSum = Traits::ref(out, k);
+        outSum = kahanSum(sum[k], sum[k] + ReduceLaneCount, U(0), &Traits::ref(compensation, k));
+        Traits::ref(compensation, k) += laneCompensation;
+    }
+    return out;
+}
+
+}
+
+/**
+@brief Minimum and maximum of a strided array
+@param data         Pointer to the first item
+@param count        Item count
+@param stride       Byte distance between consecutive items
+@param threadCount  Count of threads to use. If `0`,
+    `std::thread::hardware_concurrency()` is used.
+
+Equivalent to @ref Math::minmax(Corrade::Containers::ArrayView<const T>),
+but the items are processed in blocks of several items at once with no
+data-dependent branches, which allows the compiler to vectorize the code,
+and large arrays are distributed over @p threadCount threads. Vectors are
+compared component-wise. The @p stride can be used to process a single
+attribute of interleaved vertex data:
+@code
+struct Vertex {
+    Vector3 position;
+    Vector3 normal;
+};
+std::vector<Vertex> vertices;
+
+std::pair<Vector3, Vector3> minmax = Math::Algorithms::minmax(
+    &vertices[0].position, vertices.size(), sizeof(Vertex));
+@endcode
+
+`NaN` items are ignored unless they are first in the array. If @p count is
+zero, returns value-initialized pair. Except on Emscripten, code using this
+header needs to be linked to the platform thread library.
+@see @ref bounds()
+*/
+template<class T> std::pair<T, T> minmax(const T* data, std::size_t count, std::size_t stride, unsigned int threadCount = 0) {
+    if(!count) return {};
+
+    const std::vector<std::pair<T, T>> partials = Implementation::reduceBlocks<std::pair<T, T>>(count, threadCount, [&](const std::size_t begin, const std::size_t end) {
+        return Implementation::minmaxBlock(data, stride, begin, end);
+    });
+
+    std::pair<T, T> out = partials[0];
+    for(std::size_t i = 1; i != partials.size(); ++i) {
+        out.first = Math::min(partials[i].first, out.first);
+        out.second = Math::max(partials[i].second, out.second);
+    }
+    return out;
+}
+
+/** @overload */
+template<class T> inline std::pair<T, T> minmax(Corrade::Containers::ArrayView<const T> data, unsigned int threadCount = 0) {
+    return minmax(data.data(), data.size(), sizeof(T), threadCount);
+}
+
+/**
+@brief Bounds of a strided array of vectors
+@param data         Pointer to the first item
+@param count        Item count
+@param stride       Byte distance between consecutive items
+@param threadCount  Count of threads to use. If `0`,
+    `std::thread::hardware_concurrency()` is used.
+
+Same as @ref minmax(), but returns the result as a @ref Range, e.g.
+@ref Range3D for an array of @ref Vector3 positions. If @p count is zero,
+returns a zero range.
+*/
+template<class T> Range<T::Size, typename T::Type> bounds(const T* data, std::size_t count, std::size_t stride, unsigned int threadCount = 0) {
+    const std::pair<T, T> out = minmax(data, count, stride, threadCount);
+    return {out.first, out.second};
+}
+
+/** @overload */
+template<class T> inline Range<T::Size, typename T::Type> bounds(Corrade::Containers::ArrayView<const T> data, unsigned int threadCount = 0) {
+    return bounds(data.data(), data.size(), sizeof(T), threadCount);
+}
+
+/**
+@brief Pairwise sum of a strided array
+@param data         Pointer to the first item
+@param count        Item count
+@param stride       Byte distance between consecutive items
+@param threadCount  Count of threads to use. If `0`,
+    `std::thread::hardware_concurrency()` is used.
+
+The array is recursively split in halves and the halves summed together,
+which keeps the roundoff error growing only with a logarithm of @p count
+instead of linearly as with `std::accumulate()`. The smallest ranges are
+summed in several interleaved lanes at once, so the cost is comparable to a
+vectorized naive summation. Vectors are summed component-wise.
+
+The result doesn't depend on @p threadCount. If @p count is zero, returns
+value-initialized value. Except on Emscripten, code using this header needs
+to be linked to the platform thread library.
+@see @ref compensatedSum(), @ref mean()
+*/
+template<class T> T pairwiseSum(const T* data, std::size_t count, std::size_t stride, unsigned int threadCount = 0) {
+    if(!count) return T{};
+
+    const std::vector<T> partials = Implementation::reduceBlocks<T>(count, threadCount, [&](const std::size_t begin, const std::size_t end) {
+        return Implementation::pairwiseSumBlock(data, stride, begin, end);
+    });
+    return Implementation::pairwiseSumPartials(partials.data(), partials.size());
+}
+
+/** @overload */
+template<class T> inline T pairwiseSum(Corrade::Containers::ArrayView<const T> data, unsigned int threadCount = 0) {
+    return pairwiseSum(data.data(), data.size(), sizeof(T), threadCount);
+}
+
+/**
+@brief Compensated sum of a strided array
+@param data         Pointer to the first item
+@param count        Item count
+@param stride       Byte distance between consecutive items
+@param threadCount  Count of threads to use. If `0`,
+    `std::thread::hardware_concurrency()` is used.
+
+Uses the same algorithm as @ref kahanSum(), the roundoff error is thus
+independent of @p count, but the array is summed in several interleaved
+lanes and the partial sums together with their compensations are combined
+afterwards, which allows the compiler to vectorize the code. Large arrays
+are distributed over @p threadCount threads. Slower than
+@ref pairwiseSum(), use when the precision matters more. Similarly to
+@ref kahanSum(), the compensation is optimized out if the code is compiled
+with `-ffast-math` or equivalent. Available only for floating-point types.
+
+The result doesn't depend on @p threadCount. If @p count is zero, returns
+zero. Except on Emscripten, code using this header needs to be linked to
+the platform thread library.
+@see @ref mean()
+*/
+template<class T> T compensatedSum(const T* data, std::size_t count, std::size_t stride, unsigned int threadCount = 0) {
+    static_assert(std::is_floating_point<typename Implementation::ReduceTraits<T>::Type>::value,
+        "compensated sum is available only for floating-point types");
+    if(!count) return T{};
+
+    typedef std::pair<T, T> SumCompensation;
+    const std::vector<SumCompensation> partials = Implementation::reduceBlocks<SumCompensation>(count, threadCount, [&](const std::size_t begin, const std::size_t end) {
+        SumCompensation out;
+        out.first = Implementation::compensatedSumBlock(data, stride, begin, end, out.second);
+        return out;
+    });
+
+    /* Kahan summation of the partial sums, with the compensations of all
+       blocks subtracted at the end */
+    T sum{}, c{}, compensation{};
+    for(const SumCompensation& partial: partials) {
+        sum = kahanSum(&partial.first, &partial.first + 1, sum, &c);
+        compensation += partial.second;
+    }
+    return sum - (c + compensation);
+}
+
+/** @overload */
+template<class T> inline T compensatedSum(Corrade::Containers::ArrayView<const T> data, unsigned int threadCount = 0) {
+    return compensatedSum(data.data(), data.size(), sizeof(T), threadCount);
+}
+
+/**
+@brief Arithmetic mean of a strided array
+@param data         Pointer to the first item
+@param count        Item count
+@param stride       Byte distance between consecutive items
+@param threadCount  Count of threads to use. If `0`,
+    `std::thread::hardware_concurrency()` is used.
+
+Calculated as @ref pairwiseSum() divided by @p count, available only for
+floating-point types. If @p count is zero, returns value-initialized value.
+*/
+template<class T> T mean(const T* data, std::size_t count, std::size_t stride, unsigned int threadCount = 0) {
+    typedef typename Implementation::ReduceTraits<T>::Type U;
+    static_assert(std::is_floating_point<U>::value,
+        "mean is available only for floating-point types");
+    if(!count) return T{};
+    return pairwiseSum(data, count, stride, threadCount)/U(count);
+}
+
+/** @overload */
+template<class T> inline T mean(Corrade::Containers::ArrayView<const T> data, unsigned int threadCount = 0) {
+    return mean(data.data(), data.size(), sizeof(T), threadCount);
+}
+
+}}}
+
+#endif
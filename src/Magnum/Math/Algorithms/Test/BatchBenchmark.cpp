@@ -0,0 +1,196 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Algorithms/Batch.h"
+#include "Magnum/Math/Algorithms/Svd.h"
+
+namespace Magnum { namespace Math { namespace Algorithms { namespace Test {
+
+struct BatchBenchmark: Corrade::TestSuite::Tester {
+    explicit BatchBenchmark();
+
+    void svd();
+    void svdBatch();
+    void svdBatchMultithreaded();
+
+    void inverted();
+    void gaussJordanInverted();
+    void invertedBatch();
+    void invertedBatchMultithreaded();
+
+    void gaussJordan();
+    void gaussJordanBatch();
+};
+
+typedef Matrix<3, Float> Matrix3x3;
+typedef Matrix<4, Float> Matrix4x4;
+typedef Vector<3, Float> Vector3;
+typedef Vector<4, Float> Vector4;
+
+BatchBenchmark::BatchBenchmark() {
+    addBenchmarks({&BatchBenchmark::svd,
+                   &BatchBenchmark::svdBatch,
+                   &BatchBenchmark::svdBatchMultithreaded,
+
+                   &BatchBenchmark::inverted,
+                   &BatchBenchmark::gaussJordanInverted,
+                   &BatchBenchmark::invertedBatch,
+                   &BatchBenchmark::invertedBatchMultithreaded,
+
+                   &BatchBenchmark::gaussJordan,
+                   &BatchBenchmark::gaussJordanBatch}, 5);
+}
+
+namespace {
+
+enum: std::size_t { MatrixCount = 100000 };
+
+/* Diagonally dominant pseudo-random matrices, like quadrics of a typical
+   mesh */
+template<std::size_t size> const std::vector<Matrix<size, Float>>& matrices() {
+    static const std::vector<Matrix<size, Float>> data = [] {
+        std::vector<Matrix<size, Float>> out(MatrixCount);
+        UnsignedInt state = 1;
+        for(Matrix<size, Float>& m: out)
+            for(std::size_t i = 0; i != size; ++i)
+                for(std::size_t j = 0; j != size; ++j) {
+                    state = state*1664525u + 1013904223u;
+                    m[i][j] = Float(state >> 8)/Float(1u << 24) + (i == j ? 4.0f : 0.0f);
+                }
+        return out;
+    }();
+    return data;
+}
+
+}
+
+void BatchBenchmark::svd() {
+    const std::vector<Matrix3x3>& in = matrices<3>();
+    std::vector<Vector3> w(in.size());
+
+    CORRADE_BENCHMARK(1)
+        for(std::size_t i = 0; i != in.size(); ++i)
+            w[i] = std::get<1>(Algorithms::svd(in[i]));
+
+    CORRADE_VERIFY(w.back().max() > 0.0f);
+}
+
+void BatchBenchmark::svdBatch() {
+    const std::vector<Matrix3x3>& in = matrices<3>();
+    std::vector<Matrix3x3> u(in.size()), v(in.size());
+    std::vector<Vector3> w(in.size());
+
+    CORRADE_BENCHMARK(1)
+        Algorithms::svdBatch<Float>({in.data(), in.size()}, {u.data(), u.size()}, {w.data(), w.size()}, {v.data(), v.size()}, 1);
+
+    CORRADE_VERIFY(w.back().max() > 0.0f);
+}
+
+void BatchBenchmark::svdBatchMultithreaded() {
+    const std::vector<Matrix3x3>& in = matrices<3>();
+    std::vector<Matrix3x3> u(in.size()), v(in.size());
+    std::vector<Vector3> w(in.size());
+
+    CORRADE_BENCHMARK(1)
+        Algorithms::svdBatch<Float>({in.data(), in.size()}, {u.data(), u.size()}, {w.data(), w.size()}, {v.data(), v.size()});
+
+    CORRADE_VERIFY(w.back().max() > 0.0f);
+}
+
+void BatchBenchmark::inverted() {
+    const std::vector<Matrix4x4>& in = matrices<4>();
+    std::vector<Matrix4x4> out(in.size());
+
+    CORRADE_BENCHMARK(1)
+        for(std::size_t i = 0; i != in.size(); ++i)
+            out[i] = in[i].inverted();
+
+    CORRADE_VERIFY(out.back() != Matrix4x4{});
+}
+
+void BatchBenchmark::gaussJordanInverted() {
+    const std::vector<Matrix4x4>& in = matrices<4>();
+    std::vector<Matrix4x4> out(in.size());
+
+    CORRADE_BENCHMARK(1)
+        for(std::size_t i = 0; i != in.size(); ++i)
+            out[i] = Algorithms::gaussJordanInverted(in[i]);
+
+    CORRADE_VERIFY(out.back() != Matrix4x4{});
+}
+
+void BatchBenchmark::invertedBatch() {
+    const std::vector<Matrix4x4>& in = matrices<4>();
+    std::vector<Matrix4x4> out(in.size());
+
+    CORRADE_BENCHMARK(1)
+        Algorithms::invertedBatch<Float>({in.data(), in.size()}, {out.data(), out.size()}, 1);
+
+    CORRADE_VERIFY(out.back() != Matrix4x4{});
+}
+
+void BatchBenchmark::invertedBatchMultithreaded() {
+    const std::vector<Matrix4x4>& in = matrices<4>();
+    std::vector<Matrix4x4> out(in.size());
+
+    CORRADE_BENCHMARK(1)
+        Algorithms::invertedBatch<Float>({in.data(), in.size()}, {out.data(), out.size()});
+
+    CORRADE_VERIFY(out.back() != Matrix4x4{});
+}
+
+void BatchBenchmark::gaussJordan() {
+    const std::vector<Matrix4x4>& in = matrices<4>();
+    std::vector<Vector4> x(in.size());
+
+    CORRADE_BENCHMARK(1)
+        for(std::size_t i = 0; i != in.size(); ++i) {
+            Matrix4x4 a = in[i].transposed();
+            RectangularMatrix<4, 1, Float> t{Vector<1, Float>{1.0f}, Vector<1, Float>{}, Vector<1, Float>{}, Vector<1, Float>{}};
+            Algorithms::gaussJordanInPlaceTransposed(a, t);
+            x[i] = Vector4{t[0][0], t[1][0], t[2][0], t[3][0]};
+        }
+
+    CORRADE_VERIFY(x.back() != Vector4{});
+}
+
+void BatchBenchmark::gaussJordanBatch() {
+    const std::vector<Matrix4x4>& in = matrices<4>();
+    const std::vector<Vector4> b(in.size(), Vector4{1.0f, 0.0f, 0.0f, 0.0f});
+    std::vector<Vector4> x(in.size());
+
+    CORRADE_BENCHMARK(1)
+        Algorithms::gaussJordanBatch<4, Float>({in.data(), in.size()}, {b.data(), b.size()}, {x.data(), x.size()});
+
+    CORRADE_VERIFY(x.back() != Vector4{});
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Algorithms::Test::BatchBenchmark)
@@ -0,0 +1,309 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Algorithms/Batch.h"
+#include "Magnum/Math/Algorithms/Svd.h"
+
+namespace Magnum { namespace Math { namespace Algorithms { namespace Test {
+
+struct BatchTest: Corrade::TestSuite::Tester {
+    explicit BatchTest();
+
+    template<class T> void svd();
+    void svdSingular();
+    void svdMultithreaded();
+    void svdInvalidSize();
+
+    void inverted();
+    void invertedInPlace();
+    void invertedMultithreaded();
+    void invertedInvalidSize();
+
+    void qr();
+    void qrInvalidSize();
+
+    void gaussJordan();
+    void gaussJordanSingular();
+    void gaussJordanInvalidSize();
+};
+
+typedef Matrix<3, Float> Matrix3x3;
+typedef Matrix<3, Double> Matrix3x3d;
+typedef Matrix<4, Float> Matrix4x4;
+typedef Vector<3, Float> Vector3;
+typedef Vector<4, Float> Vector4;
+
+BatchTest::BatchTest() {
+    addTests<BatchTest>({&BatchTest::svd<Float>,
+                         &BatchTest::svd<Double>,
+                         &BatchTest::svdSingular,
+                         &BatchTest::svdMultithreaded,
+                         &BatchTest::svdInvalidSize,
+
+                         &BatchTest::inverted,
+                         &BatchTest::invertedInPlace,
+                         &BatchTest::invertedMultithreaded,
+                         &BatchTest::invertedInvalidSize,
+
+                         &BatchTest::qr,
+                         &BatchTest::qrInvalidSize,
+
+                         &BatchTest::gaussJordan,
+                         &BatchTest::gaussJordanSingular,
+                         &BatchTest::gaussJordanInvalidSize});
+}
+
+namespace {
+
+/* Deterministic pseudo-random numbers in [-1, 1) */
+template<class T> class Random {
+    public:
+        T operator()() {
+            _state = _state*6364136223846793005ull + 1442695040888963407ull;
+            return T(_state >> 40)/T(1ull << 23) - T(1);
+        }
+
+    private:
+        unsigned long long _state = 1;
+};
+
+template<std::size_t size, class T> std::vector<Matrix<size, T>> randomMatrices(const std::size_t count, const T diagonal = T(0)) {
+    Random<T> random;
+    std::vector<Matrix<size, T>> out(count);
+    for(Matrix<size, T>& m: out)
+        for(std::size_t i = 0; i != size; ++i)
+            for(std::size_t j = 0; j != size; ++j)
+                m[i][j] = random()*T(10) + (i == j ? diagonal : T(0));
+    return out;
+}
+
+template<class T> Corrade::Containers::ArrayView<const T> constView(const std::vector<T>& data) {
+    return {data.data(), data.size()};
+}
+
+template<class T> Corrade::Containers::ArrayView<T> view(std::vector<T>& data) {
+    return {data.data(), data.size()};
+}
+
+}
+
+template<class T> void BatchTest::svd() {
+    setTestCaseName(std::is_same<T, Double>::value ? "svd<Double>" : "svd<Float>");
+
+    typedef Matrix<3, T> Matrix3x3t;
+
+    /* Not a multiple of the lane count to test the remainder handling */
+    const std::vector<Matrix<3, T>> matrices = randomMatrices<3, T>(37);
+    std::vector<Matrix<3, T>> u(matrices.size()), v(matrices.size());
+    std::vector<Vector<3, T>> w(matrices.size());
+    svdBatch(constView(matrices), view(u), view(w), view(v), 1);
+
+    for(std::size_t i = 0; i != matrices.size(); ++i) {
+
+        /* Reconstructs the original matrix */
+        CORRADE_COMPARE(u[i]*Matrix3x3t::fromDiagonal(w[i])*v[i].transposed(), matrices[i]);
+
+        /* U and V are orthonormal */
+        CORRADE_COMPARE(u[i].transposed()*u[i], Matrix3x3t{IdentityInit});
+        CORRADE_COMPARE(v[i].transposed()*v[i], Matrix3x3t{IdentityInit});
+
+        /* Singular values are sorted and the same as from svd() */
+        CORRADE_VERIFY(w[i][0] >= w[i][1]);
+        CORRADE_VERIFY(w[i][1] >= w[i][2]);
+        CORRADE_VERIFY(w[i][2] >= T(0));
+        Vector<3, T> expected = std::get<1>(Algorithms::svd(matrices[i]));
+        std::sort(expected.data(), expected.data() + 3, [](T a, T b) { return a > b; });
+        CORRADE_COMPARE(w[i], expected);
+    }
+}
+
+void BatchTest::svdSingular() {
+    const std::vector<Matrix3x3> matrices{
+        /* Zero matrix */
+        Matrix3x3{ZeroInit},
+        /* Rank one */
+        Matrix3x3{Vector3{1.0f, 2.0f, 3.0f},
+                         Vector3{2.0f, 4.0f, 6.0f},
+                         Vector3{-1.0f, -2.0f, -3.0f}},
+        /* Rank two */
+        Matrix3x3{Vector3{1.0f, 0.0f, 0.0f},
+                         Vector3{0.0f, 2.0f, 0.0f},
+                         Vector3{1.0f, 2.0f, 0.0f}},
+        /* Reflection */
+        Matrix3x3::fromDiagonal({1.0f, -3.0f, 2.0f})};
+    std::vector<Matrix3x3> u(matrices.size()), v(matrices.size());
+    std::vector<Vector3> w(matrices.size());
+    svdBatch(constView(matrices), view(u), view(w), view(v));
+
+    CORRADE_COMPARE(w[0], (Vector3{}));
+    CORRADE_COMPARE(w[1], (Vector3{std::sqrt(84.0f), 0.0f, 0.0f}));
+    CORRADE_COMPARE(w[2][2], 0.0f);
+    CORRADE_COMPARE(w[3], (Vector3{3.0f, 2.0f, 1.0f}));
+
+    /* U is orthonormal even for singular matrices */
+    for(std::size_t i = 0; i != matrices.size(); ++i) {
+        CORRADE_COMPARE(u[i]*Matrix3x3::fromDiagonal(w[i])*v[i].transposed(), matrices[i]);
+        CORRADE_COMPARE(u[i].transposed()*u[i], Matrix3x3{IdentityInit});
+        CORRADE_COMPARE(v[i].transposed()*v[i], Matrix3x3{IdentityInit});
+    }
+}
+
+void BatchTest::svdMultithreaded() {
+    const std::vector<Matrix3x3> matrices = randomMatrices<3, Float>(Implementation::BatchMinItemCount*4 + 5);
+    std::vector<Matrix3x3> u(matrices.size()), v(matrices.size()), u4(matrices.size()), v4(matrices.size());
+    std::vector<Vector3> w(matrices.size()), w4(matrices.size());
+    svdBatch(constView(matrices), view(u), view(w), view(v), 1);
+    svdBatch(constView(matrices), view(u4), view(w4), view(v4), 4);
+
+    /* The results should be bit-exact */
+    for(std::size_t i = 0; i != matrices.size(); ++i) {
+        CORRADE_VERIFY(u4[i] == u[i]);
+        CORRADE_VERIFY(w4[i] == w[i]);
+        CORRADE_VERIFY(v4[i] == v[i]);
+    }
+}
+
+void BatchTest::svdInvalidSize() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    std::vector<Matrix3x3> matrices(3), u(3), v(2);
+    std::vector<Vector3> w(3);
+    svdBatch(constView(matrices), view(u), view(w), view(v));
+    CORRADE_COMPARE(out.str(), "Math::Algorithms::svdBatch(): expected 3 outputs but got 3, 3 and 2\n");
+}
+
+void BatchTest::inverted() {
+    /* Diagonally dominant so the matrices are well-conditioned and the
+       results comparable with fuzzy compare */
+    const std::vector<Matrix4x4> matrices = randomMatrices<4, Float>(37, 30.0f);
+    std::vector<Matrix4x4> inverted(matrices.size());
+    invertedBatch(constView(matrices), view(inverted), 1);
+
+    for(std::size_t i = 0; i != matrices.size(); ++i) {
+        CORRADE_COMPARE(inverted[i], matrices[i].inverted());
+        CORRADE_COMPARE(inverted[i]*matrices[i], Matrix4x4{IdentityInit});
+    }
+}
+
+void BatchTest::invertedInPlace() {
+    std::vector<Matrix4x4> matrices = randomMatrices<4, Float>(5, 30.0f);
+    const std::vector<Matrix4x4> original = matrices;
+    invertedBatch(constView(matrices), view(matrices));
+
+    for(std::size_t i = 0; i != matrices.size(); ++i) {
+        CORRADE_COMPARE(matrices[i], original[i].inverted());
+    }
+}
+
+void BatchTest::invertedMultithreaded() {
+    const std::vector<Matrix4x4> matrices = randomMatrices<4, Float>(Implementation::BatchMinItemCount*3 + 7);
+    std::vector<Matrix4x4> inverted(matrices.size()), inverted3(matrices.size());
+    invertedBatch(constView(matrices), view(inverted), 1);
+    invertedBatch(constView(matrices), view(inverted3), 3);
+
+    for(std::size_t i = 0; i != matrices.size(); ++i) {
+        CORRADE_VERIFY(inverted3[i] == inverted[i]);
+    }
+}
+
+void BatchTest::invertedInvalidSize() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    std::vector<Matrix4x4> matrices(3), inverted(4);
+    invertedBatch(constView(matrices), view(inverted));
+    CORRADE_COMPARE(out.str(), "Math::Algorithms::invertedBatch(): expected 3 outputs but got 4\n");
+}
+
+void BatchTest::qr() {
+    const std::vector<Matrix3x3d> matrices = randomMatrices<3, Double>(Implementation::BatchMinItemCount*2);
+    std::vector<Matrix3x3d> q(matrices.size()), r(matrices.size());
+    qrBatch(constView(matrices), view(q), view(r), 2);
+
+    for(std::size_t i = 0; i < matrices.size(); i += 97) {
+        const std::pair<Matrix3x3d, Matrix3x3d> expected = Algorithms::qr(matrices[i]);
+        CORRADE_COMPARE(q[i], expected.first);
+        CORRADE_COMPARE(r[i], expected.second);
+    }
+}
+
+void BatchTest::qrInvalidSize() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    std::vector<Matrix3x3> matrices(3), q(3), r(1);
+    qrBatch(constView(matrices), view(q), view(r));
+    CORRADE_COMPARE(out.str(), "Math::Algorithms::qrBatch(): expected 3 outputs but got 3 and 1\n");
+}
+
+void BatchTest::gaussJordan() {
+    const std::vector<Matrix4x4> a = randomMatrices<4, Float>(Implementation::BatchMinItemCount*2 + 3, 30.0f);
+    std::vector<Vector4> b(a.size());
+    for(std::size_t i = 0; i != a.size(); ++i)
+        b[i] = Vector4{Float(i % 7), 1.0f, -2.0f, 0.5f};
+    std::vector<Vector4> x(a.size());
+    CORRADE_VERIFY(gaussJordanBatch(constView(a), constView(b), view(x), 2));
+
+    for(std::size_t i = 0; i < a.size(); i += 89) {
+        CORRADE_COMPARE(a[i]*x[i], b[i]);
+    }
+}
+
+void BatchTest::gaussJordanSingular() {
+    const std::vector<Matrix3x3> a{
+        Matrix3x3{IdentityInit, 2.0f},
+        Matrix3x3{Vector3{1.0f, 2.0f, 3.0f},
+                         Vector3{2.0f, 4.0f, 6.0f},
+                         Vector3{0.0f, 1.0f, 0.0f}}};
+    const std::vector<Vector3> b{
+        Vector3{2.0f, 4.0f, 6.0f},
+        Vector3{1.0f, 1.0f, 1.0f}};
+    std::vector<Vector3> x(a.size());
+    CORRADE_VERIFY(!gaussJordanBatch(constView(a), constView(b), view(x)));
+
+    /* The regular system is solved, the singular one is NaN */
+    CORRADE_COMPARE(x[0], (Vector3{1.0f, 2.0f, 3.0f}));
+    CORRADE_VERIFY(x[1][0] != x[1][0]);
+}
+
+void BatchTest::gaussJordanInvalidSize() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    std::vector<Matrix3x3> a(3);
+    std::vector<Vector3> b(3), x(2);
+    gaussJordanBatch(constView(a), constView(b), view(x));
+    CORRADE_COMPARE(out.str(), "Math::Algorithms::gaussJordanBatch(): expected 3 right sides and solutions but got 3 and 2\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Algorithms::Test::BatchTest)
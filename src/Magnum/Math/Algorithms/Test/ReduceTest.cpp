@@ -0,0 +1,174 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Math/Algorithms/Reduce.h"
+
+namespace Magnum { namespace Math { namespace Algorithms { namespace Test {
+
+struct ReduceTest: TestSuite::Tester {
+    explicit ReduceTest();
+
+    void minmax();
+    void minmaxStrided();
+    void minmaxEmpty();
+    void bounds();
+    void pairwiseSum();
+    void compensatedSum();
+    void mean();
+    void multithreaded();
+};
+
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Range3D<Float> Range3D;
+
+namespace {
+
+template<class T> Corrade::Containers::ArrayView<const T> constView(const std::vector<T>& data) {
+    return {data.data(), data.size()};
+}
+
+}
+
+ReduceTest::ReduceTest() {
+    addTests({&ReduceTest::minmax,
+              &ReduceTest::minmaxStrided,
+              &ReduceTest::minmaxEmpty,
+              &ReduceTest::bounds,
+              &ReduceTest::pairwiseSum,
+              &ReduceTest::compensatedSum,
+              &ReduceTest::mean,
+              &ReduceTest::multithreaded});
+}
+
+void ReduceTest::minmax() {
+    /* Count not divisible by the lane count to test the remainder */
+    std::vector<Int> data(1000);
+    for(std::size_t i = 0; i != data.size(); ++i)
+        data[i] = (Int(i)*37)%1001 - 300;
+
+    const std::pair<Int, Int> out = Algorithms::minmax<Int>(constView(data));
+    CORRADE_COMPARE(out.first, -300);
+    CORRADE_COMPARE(out.second, 700);
+}
+
+void ReduceTest::minmaxStrided() {
+    struct Vertex {
+        Vector3 position;
+        Float weight;
+    };
+
+    const Vertex data[]{
+        {{1.0f, -2.0f, 3.0f}, 100.0f},
+        {{-5.0f, 0.5f, 2.0f}, -100.0f},
+        {{0.0f, 4.0f, -1.0f}, 1000.0f}
+    };
+
+    const std::pair<Vector3, Vector3> out = Algorithms::minmax(&data[0].position, 3, sizeof(Vertex));
+    CORRADE_COMPARE(out.first, (Vector3{-5.0f, -2.0f, -1.0f}));
+    CORRADE_COMPARE(out.second, (Vector3{1.0f, 4.0f, 3.0f}));
+}
+
+void ReduceTest::minmaxEmpty() {
+    const std::pair<Float, Float> out = Algorithms::minmax<Float>(nullptr);
+    CORRADE_COMPARE(out.first, 0.0f);
+    CORRADE_COMPARE(out.second, 0.0f);
+    CORRADE_COMPARE(Algorithms::pairwiseSum<Float>(nullptr), 0.0f);
+    CORRADE_COMPARE(Algorithms::compensatedSum<Float>(nullptr), 0.0f);
+    CORRADE_COMPARE(Algorithms::mean<Float>(nullptr), 0.0f);
+}
+
+void ReduceTest::bounds() {
+    const Vector3 data[]{
+        {1.0f, -2.0f, 3.0f},
+        {-5.0f, 0.5f, 2.0f},
+        {0.0f, 4.0f, -1.0f}
+    };
+
+    const Range3D out = Algorithms::bounds<Vector3>(data);
+    CORRADE_COMPARE(out.min(), (Vector3{-5.0f, -2.0f, -1.0f}));
+    CORRADE_COMPARE(out.max(), (Vector3{1.0f, 4.0f, 3.0f}));
+}
+
+void ReduceTest::pairwiseSum() {
+    std::vector<Int> data(10001);
+    for(std::size_t i = 0; i != data.size(); ++i) data[i] = Int(i);
+
+    CORRADE_COMPARE(Algorithms::pairwiseSum<Int>(constView(data)), 50005000);
+}
+
+void ReduceTest::compensatedSum() {
+    /* Naive summation of a hundred thousand 1.0e-3f would be off by a few
+       percent */
+    std::vector<Float> data(100000, 1.0e-3f);
+    std::vector<Vector3> vectors(100000, Vector3{1.0e-3f, 1.0f, 0.0f});
+
+    CORRADE_COMPARE(Algorithms::compensatedSum<Float>(constView(data)), 100.0f);
+    CORRADE_COMPARE(Algorithms::compensatedSum<Vector3>(constView(vectors)), (Vector3{100.0f, 100000.0f, 0.0f}));
+    CORRADE_COMPARE(Algorithms::pairwiseSum<Float>(constView(data)), 100.0f);
+}
+
+void ReduceTest::mean() {
+    const Vector3 data[]{
+        {1.0f, -2.0f, 3.0f},
+        {-5.0f, 0.5f, 2.0f},
+        {1.0f, 4.0f, -2.0f}
+    };
+
+    CORRADE_COMPARE(Algorithms::mean<Vector3>(data), (Vector3{-1.0f, 0.833333f, 1.0f}));
+}
+
+void ReduceTest::multithreaded() {
+    /* Large enough to be split across threads */
+    std::vector<Vector3> data(300001);
+    for(std::size_t i = 0; i != data.size(); ++i)
+        data[i] = Vector3{Float(i%1013), -Float(i%877), Float(i)*0.001f};
+
+    const std::pair<Vector3, Vector3> minmax1 = Algorithms::minmax<Vector3>(constView(data), 1);
+    const std::pair<Vector3, Vector3> minmax4 = Algorithms::minmax<Vector3>(constView(data), 4);
+    CORRADE_COMPARE(minmax1.first, (Vector3{0.0f, -876.0f, 0.0f}));
+    CORRADE_COMPARE(minmax1.second, (Vector3{1012.0f, 0.0f, 300.001f}));
+    CORRADE_COMPARE(minmax4.first, minmax1.first);
+    CORRADE_COMPARE(minmax4.second, minmax1.second);
+
+    /* The result should be bit-exact regardless of thread count */
+    const Vector3 pairwise1 = Algorithms::pairwiseSum<Vector3>(constView(data), 1);
+    const Vector3 pairwise4 = Algorithms::pairwiseSum<Vector3>(constView(data), 4);
+    const Vector3 compensated1 = Algorithms::compensatedSum<Vector3>(constView(data), 1);
+    const Vector3 compensated4 = Algorithms::compensatedSum<Vector3>(constView(data), 4);
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_VERIFY(pairwise1[i] == pairwise4[i]);
+        CORRADE_VERIFY(compensated1[i] == compensated4[i]);
+    }
+    CORRADE_COMPARE(compensated1, pairwise1);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Algorithms::Test::ReduceTest)
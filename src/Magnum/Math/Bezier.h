@@ -31,6 +31,8 @@
  */
 
 #include <array>
+#include <type_traits>
+#include <Corrade/Containers/ArrayView.h>
 
 #include "Magnum/Math/Vector.h"
 
@@ -154,6 +156,55 @@ template<UnsignedInt order, UnsignedInt dimensions, class T> class Bezier {
             return {left, right};
         }
 
+        /**
+         * @brief Interpolate the curve at uniformly spaced positions
+         *
+         * Fills @p out with points on the curve for interpolation factors
+         * uniformly spaced between `0.0f` and `1.0f`, including
+         * both end points. Equivalent to calling @ref value() for each of
+         * them, but uses [forward differencing](https://en.wikipedia.org/wiki/Finite_difference#Newton.27s_series)
+         * so each point costs just @ref Order vector additions. The error
+         * accumulates with the point count, but for usual tessellation
+         * densities it stays within floating-point precision of the
+         * control points.
+         * @see @ref tessellate()
+         */
+        void values(Corrade::Containers::ArrayView<Vector<dimensions, T>> out) const;
+
+        /**
+         * @brief Interpolate the curve at given positions
+         *
+         * Equivalent to calling @ref value() for each item of @p t, but the
+         * curve is converted to a polynomial only once and each point is
+         * then evaluated using the Horner's scheme, with no dependencies
+         * between the points. Expects that @p t and @p out have the same
+         * size.
+         */
+        void values(Corrade::Containers::ArrayView<const Float> t, Corrade::Containers::ArrayView<Vector<dimensions, T>> out) const;
+
+        /**
+         * @brief Adaptively tessellate the curve
+         * @param tolerance Maximal allowed distance of the polyline from
+         *      the curve
+         * @param out       Where to put the polyline points
+         * @return Point count of the whole polyline
+         *
+         * Recursively subdivides the curve in half until the control points
+         * of each part are closer than @p tolerance to its chord, so flat
+         * parts of the curve get only a few points and sharp turns many.
+         * With control points in screen space and tolerance set to a
+         * fraction of a pixel the result is indistinguishable from the
+         * curve itself. The subdivision is limited to @f$ 2^{16} @f$ parts.
+         *
+         * The points, including both end points, are written directly to
+         * @p out, which can for example be a mapped @ref Buffer. If
+         * @p out is too small, only the first `out.size()` points are
+         * written, the returned count is always the count of the whole
+         * polyline. Passing an empty view thus queries the size needed.
+         * @see @ref subdivide(), @ref values()
+         */
+        std::size_t tessellate(T tolerance, Corrade::Containers::ArrayView<Vector<dimensions, T>> out) const;
+
     private:
         /* Implementation for Bezier<order, dimensions, T>::Bezier(const Bezier<order, dimensions, U>&) */
         template<class U, std::size_t ...sequence> constexpr explicit Bezier(Implementation::Sequence<sequence...>, const Bezier<order, dimensions, U>& other) noexcept: _data{Vector<dimensions, T>(other._data[sequence])...} {}
@@ -176,9 +227,121 @@ template<UnsignedInt order, UnsignedInt dimensions, class T> class Bezier {
             return iPoints;
         }
 
+        /* Coefficients of the curve in the power basis, i.e. the curve is
+           sum of coefficients[k]*t^k */
+        std::array<Vector<dimensions, T>, order + 1> polynomial() const {
+            std::array<Vector<dimensions, T>, order + 1> coefficients;
+            T binomial = T(1);
+            for(std::size_t k = 0; k <= order; ++k) {
+                /* Coefficient k is n!/(n - k)! times k-th forward
+                   difference of the control points */
+                Vector<dimensions, T> difference;
+                T innerBinomial = T(1);
+                for(std::size_t i = 0; i <= k; ++i) {
+                    difference += (i % 2 ? T(-1) : T(1))*innerBinomial*_data[k - i];
+                    innerBinomial = innerBinomial*T(k - i)/T(i + 1);
+                }
+                coefficients[k] = binomial*difference;
+                binomial = binomial*T(order - k)/T(k + 1);
+            }
+            return coefficients;
+        }
+
+        /* Whether the control points are closer than given (squared)
+           tolerance to the chord, in which case the whole curve is */
+        bool isFlat(T toleranceSquared) const {
+            for(std::size_t i = 1; i != order; ++i) {
+                const Vector<dimensions, T> chordPoint = _data[0] + (_data[order] - _data[0])*(T(i)/T(order));
+                if((_data[i] - chordPoint).dot() > toleranceSquared) return false;
+            }
+            return true;
+        }
+
         Vector<dimensions, T> _data[order + 1];
 };
 
+template<UnsignedInt order, UnsignedInt dimensions, class T> void Bezier<order, dimensions, T>::values(const Corrade::Containers::ArrayView<Vector<dimensions, T>> out) const {
+    if(out.empty()) return;
+    if(out.size() == 1) {
+        out[0] = _data[0];
+        return;
+    }
+
+    /* Initial values of the difference table from polynomial values at
+       the first order + 1 positions. Float curves use doubles for the
+       table, as the differences get very small compared to the values. */
+    typedef typename std::conditional<std::is_same<T, Float>::value, Double, T>::type U;
+    const std::array<Vector<dimensions, T>, order + 1> coefficients = polynomial();
+    const U step = U(1)/U(out.size() - 1);
+    Vector<dimensions, U> differences[order + 1];
+    for(std::size_t i = 0; i <= order; ++i) {
+        const U t = U(i)*step;
+        differences[i] = Vector<dimensions, U>{coefficients[order]};
+        for(std::size_t k = order; k != 0; --k)
+            differences[i] = differences[i]*t + Vector<dimensions, U>{coefficients[k - 1]};
+    }
+    for(std::size_t j = 1; j <= order; ++j)
+        for(std::size_t i = order; i >= j; --i)
+            differences[i] -= differences[i - 1];
+
+    /* Each point is the previous one plus the first difference, which is
+       incremented by the second and so on */
+    for(std::size_t i = 0; i != out.size(); ++i) {
+        out[i] = Vector<dimensions, T>{differences[0]};
+        for(std::size_t j = 0; j != order; ++j)
+            differences[j] += differences[j + 1];
+    }
+
+    /* Make the end point exact */
+    out[out.size() - 1] = _data[order];
+}
+
+template<UnsignedInt order, UnsignedInt dimensions, class T> void Bezier<order, dimensions, T>::values(const Corrade::Containers::ArrayView<const Float> t, const Corrade::Containers::ArrayView<Vector<dimensions, T>> out) const {
+    CORRADE_ASSERT(t.size() == out.size(),
+        "Math::Bezier::values(): expected" << t.size() << "output points but got" << out.size(), );
+
+    const std::array<Vector<dimensions, T>, order + 1> coefficients = polynomial();
+    for(std::size_t i = 0; i != t.size(); ++i) {
+        Vector<dimensions, T> value = coefficients[order];
+        for(std::size_t k = order; k != 0; --k)
+            value = value*T(t[i]) + coefficients[k - 1];
+        out[i] = value;
+    }
+}
+
+template<UnsignedInt order, UnsignedInt dimensions, class T> std::size_t Bezier<order, dimensions, T>::tessellate(const T tolerance, const Corrade::Containers::ArrayView<Vector<dimensions, T>> out) const {
+    /* Depth-first traversal of the subdivision tree, left halves first so
+       the points are emitted in order. With the depth limited, the stack
+       never has more than one pending right half per level. */
+    enum: std::size_t { MaxDepth = 16 };
+    std::pair<Bezier<order, dimensions, T>, std::size_t> stack[MaxDepth + 1];
+    std::size_t stackSize = 0;
+    stack[stackSize++] = {*this, 0};
+
+    const T toleranceSquared = tolerance*tolerance;
+    std::size_t count = 0;
+    if(count < out.size()) out[count] = _data[0];
+    ++count;
+
+    while(stackSize) {
+        const Bezier<order, dimensions, T> curve = stack[stackSize - 1].first;
+        const std::size_t depth = stack[stackSize - 1].second;
+        --stackSize;
+
+        if(depth == MaxDepth || curve.isFlat(toleranceSquared)) {
+            if(count < out.size()) out[count] = curve[order];
+            ++count;
+            continue;
+        }
+
+        const std::pair<Bezier<order, dimensions, T>, Bezier<order, dimensions, T>> halves = curve.subdivide(0.5f);
+        stack[stackSize++] = {halves.second, depth + 1};
+        stack[stackSize++] = {halves.first, depth + 1};
+    }
+
+    return count;
+}
+
 /**
 @brief Quadratic Bézier curve
 
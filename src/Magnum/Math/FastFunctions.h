@@ -0,0 +1,155 @@
+#ifndef Magnum_Math_FastFunctions_h
+#define Magnum_Math_FastFunctions_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Namespace @ref Magnum::Math::Fast, function @ref Magnum::Math::Fast::sqrtInverted(), @ref Magnum::Math::Fast::sqrt(), @ref Magnum::Math::Fast::sincos(), @ref Magnum::Math::Fast::normalized()
+ */
+
+#include <utility>
+
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace Math { namespace Fast {
+
+namespace Implementation {
+    union FloatBits {
+        UnsignedInt u;
+        Float f;
+    };
+}
+
+/**
+@brief Fast approximate inverse square root
+
+Initial approximation obtained from the floating-point bit representation
+refined with one Newton-Raphson iteration, using optimized constants from
+http://rrrola.wz.cz/inv_sqrt.html. The maximal relative error compared to
+@ref Math::sqrtInverted() is less than @f$ 6.6 \cdot 10^{-4} @f$ for all
+positive normalized values. The result is undefined for negative values,
+denormals and infinity.
+@see @ref sqrt(), @ref normalized()
+*/
+inline Float sqrtInverted(Float value) {
+    Implementation::FloatBits bits;
+    bits.f = value;
+    bits.u = 0x5f1ffff9u - (bits.u >> 1);
+    return 0.703952253f*bits.f*(2.38924456f - value*bits.f*bits.f);
+}
+
+/** @overload */
+template<std::size_t size> Vector<size, Float> sqrtInverted(const Vector<size, Float>& value) {
+    Vector<size, Float> out{NoInit};
+    for(std::size_t i = 0; i != size; ++i)
+        out[i] = sqrtInverted(value[i]);
+    return out;
+}
+
+/**
+@brief Fast approximate square root
+
+Calculated as `value*Fast::sqrtInverted(value)`, thus having the same
+relative error bound as @ref sqrtInverted(). Unlike @ref sqrtInverted(),
+returns zero for zero input.
+@see @ref Math::sqrt()
+*/
+inline Float sqrt(Float value) {
+    return value*sqrtInverted(value);
+}
+
+/** @overload */
+template<std::size_t size> Vector<size, Float> sqrt(const Vector<size, Float>& value) {
+    return value*sqrtInverted(value);
+}
+
+/**
+@brief Fast approximate sine and cosine
+
+Calculates both values at once. The angle is reduced to range
+@f$ [-\frac{\pi}{2}, \frac{\pi}{2}] @f$ and the sine and cosine are then
+approximated with polynomials of degree 9 and 10. The maximal absolute error
+compared to @ref Math::sincos() is less than @f$ 4 \cdot 10^{-6} @f$ for
+angles in range @f$ [-200 \pi, 200 \pi] @f$; with larger angles the error
+grows with precision loss of the input value. The result is undefined for
+angles larger than @f$ 10^5 @f$ radians in absolute value.
+@see @ref Math::sin(), @ref Math::cos()
+*/
+#ifdef DOXYGEN_GENERATING_OUTPUT
+inline std::pair<Float, Float> sincos(Rad<Float> angle);
+#else
+inline std::pair<Float, Float> sincos(Unit<Rad, Float> angle) {
+    /* Cody-Waite range reduction with pi split into an exactly multipliable
+       high part and a low part */
+    const Float x = Float(angle);
+    const Int k = Int(x*0.318309886f + (x < 0.0f ? -0.5f : 0.5f));
+    const Float kf = Float(k);
+    const Float r = (x - kf*3.140625f) - kf*9.67653589793e-4f;
+    const Float r2 = r*r;
+
+    /* Taylor polynomials, sign flipped for odd multiples of pi */
+    const Float sign = (k & 1) ? -1.0f : 1.0f;
+    const Float sin = r + r*r2*(-1.66666667e-1f + r2*(8.33333333e-3f + r2*(-1.98412698e-4f + r2*2.75573192e-6f)));
+    const Float cos = 1.0f + r2*(-0.5f + r2*(4.16666667e-2f + r2*(-1.38888889e-3f + r2*(2.48015873e-5f + r2*-2.75573192e-7f))));
+    return {sign*sin, sign*cos};
+}
+inline std::pair<Float, Float> sincos(Unit<Deg, Float> angle) { return sincos(Rad<Float>(angle)); }
+#endif
+
+/**
+@brief Fast approximate sine and cosine of a vector of angles
+
+Angles are in radians. Returns a vector of sines and a vector of cosines, see
+@ref sincos(Rad<Float>) for more information about the error bounds.
+*/
+template<std::size_t size> std::pair<Vector<size, Float>, Vector<size, Float>> sincos(const Vector<size, Float>& angles) {
+    std::pair<Vector<size, Float>, Vector<size, Float>> out{NoInit, NoInit};
+    for(std::size_t i = 0; i != size; ++i) {
+        const std::pair<Float, Float> value = Fast::sincos(Rad<Float>(angles[i]));
+        out.first[i] = value.first;
+        out.second[i] = value.second;
+    }
+    return out;
+}
+
+/**
+@brief Fast approximate vector normalization
+
+Multiplies the vector with @ref sqrtInverted() of its length squared, the
+resulting vector length thus has the same relative error bound as
+@ref sqrtInverted(). Works with all @ref Vector subclasses and also with
+@ref VectorBlock, in which case all vectors in the block are normalized.
+The vector is expected to be non-zero.
+@see @ref Vector::normalized(), @ref VectorBlock::normalized()
+*/
+template<class T> inline T normalized(const T& vector) {
+    static_assert(std::is_same<typename T::Type, Float>::value,
+        "fast normalization is implemented only for floats");
+    return vector*sqrtInverted(vector.dot());
+}
+
+}}}
+
+#endif
@@ -31,6 +31,7 @@
  */
 
 #include "Magnum/Math/Frustum.h"
+#include "Magnum/Math/Functions.h"
 #include "Magnum/Math/Geometry/Distance.h"
 #include "Magnum/Math/Range.h"
 #include "Magnum/Math/Vector3.h"
@@ -155,6 +156,23 @@ of the frustum, since checking the corners is less efficient.
 */
 template<class T> bool boxFrustum(const Range3D<T>& box, const Frustum<T>& frustum);
 
+/**
+@brief Intersection of an axis-aligned box and a camera frustum
+@param aabbCenter   Center of the box
+@param aabbExtents  Half-sizes of the box
+@param frustum      Frustum planes with normals pointing outwards
+
+Returns `true` if the box intersects with the camera frustum.
+
+Faster alternative to @ref boxFrustum(const Range3D<T>&, const Frustum<T>&)
+which, instead of checking all eight corners, computes for each plane the
+distance of the box center and the projected radius of the box onto the plane
+normal. The box is outside if the center lies further in front of any plane
+than the radius. Same as with @ref boxFrustum(), boxes overlapping only the
+corners of the frustum are considered as intersecting.
+*/
+template<class T> bool aabbFrustum(const Vector3<T>& aabbCenter, const Vector3<T>& aabbExtents, const Frustum<T>& frustum);
+
 template<class T> bool pointFrustum(const Vector3<T>& point, const Frustum<T>& frustum) {
     for(const Vector4<T>& plane: frustum.planes()) {
         /* The point is in front of one of the frustum planes (normals point
@@ -188,6 +206,19 @@ template<class T> bool boxFrustum(const Range3D<T>& box, const Frustum<T>& frust
     return true;
 }
 
+template<class T> bool aabbFrustum(const Vector3<T>& aabbCenter, const Vector3<T>& aabbExtents, const Frustum<T>& frustum) {
+    for(const Vector4<T>& plane: frustum.planes()) {
+        const Vector3<T> normal = plane.xyz();
+
+        /* The whole box is in front of one of the frustum planes (normals
+           point outwards) */
+        if(Distance::pointPlaneScaled<T>(aabbCenter, plane) + dot(aabbExtents, Math::abs(normal)) < T(0))
+            return false;
+    }
+
+    return true;
+}
+
 }}}}
 
 #endif
@@ -38,6 +38,7 @@ struct IntersectionTest: Corrade::TestSuite::Tester {
 
     void pointFrustum();
     void boxFrustum();
+    void aabbFrustum();
 };
 
 typedef Math::Vector2<Float> Vector2;
@@ -52,7 +53,8 @@ IntersectionTest::IntersectionTest() {
               &IntersectionTest::lineLine,
 
               &IntersectionTest::pointFrustum,
-              &IntersectionTest::boxFrustum});
+              &IntersectionTest::boxFrustum,
+              &IntersectionTest::aabbFrustum});
 }
 
 void IntersectionTest::planeLine() {
@@ -140,6 +142,25 @@ void IntersectionTest::boxFrustum() {
     CORRADE_VERIFY(!Intersection::boxFrustum(Range3D{Vector3{-10.0f}, Vector3{-5.0f}}, frustum));
 }
 
+void IntersectionTest::aabbFrustum() {
+    const Frustum frustum{
+        {1.0f, 0.0f, 0.0f, 0.0f},
+        {-1.0f, 0.0f, 0.0f, 10.0f},
+        {0.0f, 1.0f, 0.0f, 0.0f},
+        {0.0f, -1.0f, 0.0f, 10.0f},
+        {0.0f, 0.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, -1.0f, 10.0f}};
+
+    CORRADE_VERIFY(Intersection::aabbFrustum(Vector3{1.5f}, Vector3{0.5f}, frustum));
+    /* Bigger than frustum, but still intersects */
+    CORRADE_VERIFY(Intersection::aabbFrustum(Vector3{}, Vector3{100.0f}, frustum));
+    /* Center outside, but the box still overlaps */
+    CORRADE_VERIFY(Intersection::aabbFrustum(Vector3{-1.0f, 5.0f, 5.0f}, Vector3{1.5f}, frustum));
+    /* Outside of frustum */
+    CORRADE_VERIFY(!Intersection::aabbFrustum(Vector3{-7.5f}, Vector3{2.5f}, frustum));
+    CORRADE_VERIFY(!Intersection::aabbFrustum(Vector3{5.0f, 5.0f, 12.0f}, Vector3{1.0f}, frustum));
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Math::Geometry::Test::IntersectionTest)
@@ -0,0 +1,268 @@
+#ifndef Magnum_Math_Implementation_simd_h
+#define Magnum_Math_Implementation_simd_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstddef>
+
+#include "Magnum/configure.h"
+
+/* SIMD kernels used by the RectangularMatrix and Matrix specializations for
+   4x4 float matrices. Used only if the library is built with
+   MAGNUM_BUILD_MATH_SIMD and the compiler targets SSE, NEON or WebAssembly
+   SIMD128 (e.g. with -msse2, -mavx, -mfpu=neon or -msimd128), otherwise the
+   generic implementation is used. Emscripten defines __SSE__ when targeting
+   its SSE emulation, in that case the SSE code is used. */
+#ifdef MAGNUM_BUILD_MATH_SIMD
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define MAGNUM_MATH_IMPLEMENTATION_SIMD
+#include <xmmintrin.h>
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define MAGNUM_MATH_IMPLEMENTATION_SIMD
+#include <arm_neon.h>
+#elif defined(__wasm_simd128__)
+#define MAGNUM_MATH_IMPLEMENTATION_SIMD
+#define MAGNUM_MATH_IMPLEMENTATION_SIMD128
+#include <wasm_simd128.h>
+#endif
+#endif
+
+namespace Magnum { namespace Math { namespace Implementation {
+
+/* Name of the SIMD instruction set used for 4x4 float matrix operations or
+   nullptr if the generic implementation is used */
+#if !defined(MAGNUM_MATH_IMPLEMENTATION_SIMD)
+constexpr const char* MatrixSimd = nullptr;
+#elif defined(__AVX__)
+constexpr const char* MatrixSimd = "AVX";
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+constexpr const char* MatrixSimd = "NEON";
+#elif defined(MAGNUM_MATH_IMPLEMENTATION_SIMD128)
+constexpr const char* MatrixSimd = "SIMD128";
+#else
+constexpr const char* MatrixSimd = "SSE";
+#endif
+
+#ifdef MAGNUM_MATH_IMPLEMENTATION_SIMD
+/* Thin wrappers so the kernels below are written only once. All loads and
+   stores are unaligned, as the matrices don't have any alignment guarantees. */
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+typedef float32x4_t Simd4;
+inline Simd4 simdLoad(const float* const data) { return vld1q_f32(data); }
+inline void simdStore(float* const data, const Simd4 a) { vst1q_f32(data, a); }
+inline Simd4 simdSplat(const float a) { return vdupq_n_f32(a); }
+inline float simdFirst(const Simd4 a) { return vgetq_lane_f32(a, 0); }
+inline Simd4 simdAdd(const Simd4 a, const Simd4 b) { return vaddq_f32(a, b); }
+inline Simd4 simdSub(const Simd4 a, const Simd4 b) { return vsubq_f32(a, b); }
+inline Simd4 simdMul(const Simd4 a, const Simd4 b) { return vmulq_f32(a, b); }
+/* (a0 a1 a2 a3) -> (a2 a3 a0 a1) */
+inline Simd4 simdSwapHalves(const Simd4 a) { return vextq_f32(a, a, 2); }
+/* (a0 a1 a2 a3) -> (a1 a0 a3 a2) */
+inline Simd4 simdSwapPairs(const Simd4 a) { return vrev64q_f32(a); }
+/* Loads a column-major 4x4 matrix as its rows */
+inline void simdLoadTransposed(const float* const data, Simd4* const rows) {
+    const float32x4x4_t t = vld4q_f32(data);
+    rows[0] = t.val[0];
+    rows[1] = t.val[1];
+    rows[2] = t.val[2];
+    rows[3] = t.val[3];
+}
+#elif defined(MAGNUM_MATH_IMPLEMENTATION_SIMD128)
+typedef v128_t Simd4;
+inline Simd4 simdLoad(const float* const data) { return wasm_v128_load(data); }
+inline void simdStore(float* const data, const Simd4 a) { wasm_v128_store(data, a); }
+inline Simd4 simdSplat(const float a) { return wasm_f32x4_splat(a); }
+inline float simdFirst(const Simd4 a) { return wasm_f32x4_extract_lane(a, 0); }
+inline Simd4 simdAdd(const Simd4 a, const Simd4 b) { return wasm_f32x4_add(a, b); }
+inline Simd4 simdSub(const Simd4 a, const Simd4 b) { return wasm_f32x4_sub(a, b); }
+inline Simd4 simdMul(const Simd4 a, const Simd4 b) { return wasm_f32x4_mul(a, b); }
+inline Simd4 simdSwapHalves(const Simd4 a) { return wasm_i32x4_shuffle(a, a, 2, 3, 0, 1); }
+inline Simd4 simdSwapPairs(const Simd4 a) { return wasm_i32x4_shuffle(a, a, 1, 0, 3, 2); }
+/* Same unpack sequence as _MM_TRANSPOSE4_PS */
+inline void simdLoadTransposed(const float* const data, Simd4* const rows) {
+    const v128_t c0 = wasm_v128_load(data);
+    const v128_t c1 = wasm_v128_load(data + 4);
+    const v128_t c2 = wasm_v128_load(data + 8);
+    const v128_t c3 = wasm_v128_load(data + 12);
+    const v128_t t0 = wasm_i32x4_shuffle(c0, c1, 0, 4, 1, 5);
+    const v128_t t1 = wasm_i32x4_shuffle(c2, c3, 0, 4, 1, 5);
+    const v128_t t2 = wasm_i32x4_shuffle(c0, c1, 2, 6, 3, 7);
+    const v128_t t3 = wasm_i32x4_shuffle(c2, c3, 2, 6, 3, 7);
+    rows[0] = wasm_i64x2_shuffle(t0, t1, 0, 2);
+    rows[1] = wasm_i64x2_shuffle(t0, t1, 1, 3);
+    rows[2] = wasm_i64x2_shuffle(t2, t3, 0, 2);
+    rows[3] = wasm_i64x2_shuffle(t2, t3, 1, 3);
+}
+#else
+typedef __m128 Simd4;
+inline Simd4 simdLoad(const float* const data) { return _mm_loadu_ps(data); }
+inline void simdStore(float* const data, const Simd4 a) { _mm_storeu_ps(data, a); }
+inline Simd4 simdSplat(const float a) { return _mm_set1_ps(a); }
+inline float simdFirst(const Simd4 a) { return _mm_cvtss_f32(a); }
+inline Simd4 simdAdd(const Simd4 a, const Simd4 b) { return _mm_add_ps(a, b); }
+inline Simd4 simdSub(const Simd4 a, const Simd4 b) { return _mm_sub_ps(a, b); }
+inline Simd4 simdMul(const Simd4 a, const Simd4 b) { return _mm_mul_ps(a, b); }
+inline Simd4 simdSwapHalves(const Simd4 a) { return _mm_shuffle_ps(a, a, 0x4e); }
+inline Simd4 simdSwapPairs(const Simd4 a) { return _mm_shuffle_ps(a, a, 0xb1); }
+inline void simdLoadTransposed(const float* const data, Simd4* const rows) {
+    rows[0] = _mm_loadu_ps(data);
+    rows[1] = _mm_loadu_ps(data + 4);
+    rows[2] = _mm_loadu_ps(data + 8);
+    rows[3] = _mm_loadu_ps(data + 12);
+    _MM_TRANSPOSE4_PS(rows[0], rows[1], rows[2], rows[3]);
+}
+#endif
+
+/* Column-major 4x4 matrix `a` times `size` columns in `b`. Each output column
+   is a linear combination of columns of `a`, the summation order is the same
+   as in the generic implementation. */
+template<std::size_t size> inline void simdMultiply4(const float* const a, const float* const b, float* const out) {
+    const Simd4 a0 = simdLoad(a);
+    const Simd4 a1 = simdLoad(a + 4);
+    const Simd4 a2 = simdLoad(a + 8);
+    const Simd4 a3 = simdLoad(a + 12);
+
+    for(std::size_t col = 0; col != size; ++col) {
+        const float* const bcol = b + col*4;
+        Simd4 o = simdMul(a0, simdSplat(bcol[0]));
+        o = simdAdd(o, simdMul(a1, simdSplat(bcol[1])));
+        o = simdAdd(o, simdMul(a2, simdSplat(bcol[2])));
+        o = simdAdd(o, simdMul(a3, simdSplat(bcol[3])));
+        simdStore(out + col*4, o);
+    }
+}
+
+#ifdef __AVX__
+/* Two output columns at once */
+template<> inline void simdMultiply4<4>(const float* const a, const float* const b, float* const out) {
+    const __m128 a0 = _mm_loadu_ps(a);
+    const __m128 a1 = _mm_loadu_ps(a + 4);
+    const __m128 a2 = _mm_loadu_ps(a + 8);
+    const __m128 a3 = _mm_loadu_ps(a + 12);
+    const __m256 aa0 = _mm256_insertf128_ps(_mm256_castps128_ps256(a0), a0, 1);
+    const __m256 aa1 = _mm256_insertf128_ps(_mm256_castps128_ps256(a1), a1, 1);
+    const __m256 aa2 = _mm256_insertf128_ps(_mm256_castps128_ps256(a2), a2, 1);
+    const __m256 aa3 = _mm256_insertf128_ps(_mm256_castps128_ps256(a3), a3, 1);
+
+    for(std::size_t col = 0; col != 4; col += 2) {
+        const float* const b0 = b + col*4;
+        const float* const b1 = b0 + 4;
+        __m256 o = _mm256_mul_ps(aa0, _mm256_setr_ps(b0[0], b0[0], b0[0], b0[0], b1[0], b1[0], b1[0], b1[0]));
+        o = _mm256_add_ps(o, _mm256_mul_ps(aa1, _mm256_setr_ps(b0[1], b0[1], b0[1], b0[1], b1[1], b1[1], b1[1], b1[1])));
+        o = _mm256_add_ps(o, _mm256_mul_ps(aa2, _mm256_setr_ps(b0[2], b0[2], b0[2], b0[2], b1[2], b1[2], b1[2], b1[2])));
+        o = _mm256_add_ps(o, _mm256_mul_ps(aa3, _mm256_setr_ps(b0[3], b0[3], b0[3], b0[3], b1[3], b1[3], b1[3], b1[3])));
+        _mm256_storeu_ps(out + col*4, o);
+    }
+}
+#endif
+
+inline void simdTranspose4(const float* const a, float* const out) {
+    Simd4 rows[4];
+    simdLoadTransposed(a, rows);
+    simdStore(out, rows[0]);
+    simdStore(out + 4, rows[1]);
+    simdStore(out + 8, rows[2]);
+    simdStore(out + 12, rows[3]);
+}
+
+/* Cramer's rule with the cofactors computed four at a time, based on the
+   Intel "Streaming SIMD Extensions -- Inverse of 4x4 Matrix" application
+   note. Inverting the transposed matrix and storing the rows gives the
+   column-major inverse. */
+inline void simdInverted4(const float* const a, float* const out) {
+    Simd4 rows[4];
+    simdLoadTransposed(a, rows);
+    const Simd4 row0 = rows[0];
+    const Simd4 row1 = simdSwapHalves(rows[1]);
+    Simd4 row2 = rows[2];
+    const Simd4 row3 = simdSwapHalves(rows[3]);
+
+    Simd4 tmp, minor0, minor1, minor2, minor3;
+
+    tmp = simdSwapPairs(simdMul(row2, row3));
+    minor0 = simdMul(row1, tmp);
+    minor1 = simdMul(row0, tmp);
+    tmp = simdSwapHalves(tmp);
+    minor0 = simdSub(simdMul(row1, tmp), minor0);
+    minor1 = simdSub(simdMul(row0, tmp), minor1);
+    minor1 = simdSwapHalves(minor1);
+
+    tmp = simdSwapPairs(simdMul(row1, row2));
+    minor0 = simdAdd(simdMul(row3, tmp), minor0);
+    minor3 = simdMul(row0, tmp);
+    tmp = simdSwapHalves(tmp);
+    minor0 = simdSub(minor0, simdMul(row3, tmp));
+    minor3 = simdSub(simdMul(row0, tmp), minor3);
+    minor3 = simdSwapHalves(minor3);
+
+    tmp = simdSwapPairs(simdMul(simdSwapHalves(row1), row3));
+    row2 = simdSwapHalves(row2);
+    minor0 = simdAdd(simdMul(row2, tmp), minor0);
+    minor2 = simdMul(row0, tmp);
+    tmp = simdSwapHalves(tmp);
+    minor0 = simdSub(minor0, simdMul(row2, tmp));
+    minor2 = simdSub(simdMul(row0, tmp), minor2);
+    minor2 = simdSwapHalves(minor2);
+
+    tmp = simdSwapPairs(simdMul(row0, row1));
+    minor2 = simdAdd(simdMul(row3, tmp), minor2);
+    minor3 = simdSub(simdMul(row2, tmp), minor3);
+    tmp = simdSwapHalves(tmp);
+    minor2 = simdSub(simdMul(row3, tmp), minor2);
+    minor3 = simdSub(minor3, simdMul(row2, tmp));
+
+    tmp = simdSwapPairs(simdMul(row0, row3));
+    minor1 = simdSub(minor1, simdMul(row2, tmp));
+    minor2 = simdAdd(simdMul(row1, tmp), minor2);
+    tmp = simdSwapHalves(tmp);
+    minor1 = simdAdd(simdMul(row2, tmp), minor1);
+    minor2 = simdSub(minor2, simdMul(row1, tmp));
+
+    tmp = simdSwapPairs(simdMul(row0, row2));
+    minor1 = simdAdd(simdMul(row3, tmp), minor1);
+    minor3 = simdSub(minor3, simdMul(row1, tmp));
+    tmp = simdSwapHalves(tmp);
+    minor1 = simdSub(minor1, simdMul(row3, tmp));
+    minor3 = simdAdd(simdMul(row1, tmp), minor3);
+
+    /* Horizontal sum of the first row times its cofactors */
+    Simd4 determinant = simdMul(row0, minor0);
+    determinant = simdAdd(simdSwapHalves(determinant), determinant);
+    determinant = simdAdd(simdSwapPairs(determinant), determinant);
+    const Simd4 invDeterminant = simdSplat(1.0f/simdFirst(determinant));
+
+    simdStore(out, simdMul(minor0, invDeterminant));
+    simdStore(out + 4, simdMul(minor1, invDeterminant));
+    simdStore(out + 8, simdMul(minor2, invDeterminant));
+    simdStore(out + 12, simdMul(minor3, invDeterminant));
+}
+#endif
+
+}}}
+
+#endif
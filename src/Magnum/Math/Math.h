@@ -85,6 +85,11 @@ template<class> class Vector2;
 template<class> class Vector3;
 template<class> class Vector4;
 
+template<std::size_t, std::size_t, class> class VectorBlock;
+template<std::size_t lanes, class T> using Vector2Block = VectorBlock<2, lanes, T>;
+template<std::size_t lanes, class T> using Vector3Block = VectorBlock<3, lanes, T>;
+template<std::size_t lanes, class T> using Vector4Block = VectorBlock<4, lanes, T>;
+
 template<class> class Color3;
 template<class> class Color4;
 
@@ -35,6 +35,7 @@ namespace Magnum { namespace Math {
 
 namespace Implementation {
     template<std::size_t, class> struct MatrixDeterminant;
+    template<std::size_t, class> struct MatrixInverse;
 }
 
 /**
@@ -207,16 +208,16 @@ template<std::size_t size, class T> class Matrix: public RectangularMatrix<size,
 
         #ifndef DOXYGEN_GENERATING_OUTPUT
         /* Reimplementation of functions to return correct type */
-        Matrix<size, T> operator*(const Matrix<size, T>& other) const {
+        constexpr Matrix<size, T> operator*(const Matrix<size, T>& other) const {
             return RectangularMatrix<size, size, T>::operator*(other);
         }
-        template<std::size_t otherCols> RectangularMatrix<otherCols, size, T> operator*(const RectangularMatrix<otherCols, size, T>& other) const {
+        template<std::size_t otherCols> constexpr RectangularMatrix<otherCols, size, T> operator*(const RectangularMatrix<otherCols, size, T>& other) const {
             return RectangularMatrix<size, size, T>::operator*(other);
         }
-        Vector<size, T> operator*(const Vector<size, T>& other) const {
+        constexpr Vector<size, T> operator*(const Vector<size, T>& other) const {
             return RectangularMatrix<size, size, T>::operator*(other);
         }
-        Matrix<size, T> transposed() const {
+        constexpr Matrix<size, T> transposed() const {
             return RectangularMatrix<size, size, T>::transposed();
         }
         MAGNUM_RECTANGULARMATRIX_SUBCLASS_IMPLEMENTATION(size, size, Matrix<size, T>)
@@ -272,17 +273,17 @@ MAGNUM_MATRIX_OPERATOR_IMPLEMENTATION(Matrix<size, T>)
         return VectorType<T>(Matrix<size, T>::row(row));                    \
     }                                                                       \
                                                                             \
-    Type<T> operator*(const Matrix<size, T>& other) const {                 \
+    constexpr Type<T> operator*(const Matrix<size, T>& other) const {       \
         return Matrix<size, T>::operator*(other);                           \
     }                                                                       \
-    template<std::size_t otherCols> RectangularMatrix<otherCols, size, T> operator*(const RectangularMatrix<otherCols, size, T>& other) const { \
+    template<std::size_t otherCols> constexpr RectangularMatrix<otherCols, size, T> operator*(const RectangularMatrix<otherCols, size, T>& other) const { \
         return Matrix<size, T>::operator*(other);                           \
     }                                                                       \
-    VectorType<T> operator*(const Vector<size, T>& other) const {           \
+    constexpr VectorType<T> operator*(const Vector<size, T>& other) const { \
         return Matrix<size, T>::operator*(other);                           \
     }                                                                       \
                                                                             \
-    Type<T> transposed() const { return Matrix<size, T>::transposed(); }    \
+    constexpr Type<T> transposed() const { return Matrix<size, T>::transposed(); } \
     constexpr VectorType<T> diagonal() const { return Matrix<size, T>::diagonal(); } \
     Type<T> inverted() const { return Matrix<size, T>::inverted(); }        \
     Type<T> invertedOrthogonal() const {                                    \
@@ -344,16 +345,36 @@ template<std::size_t size, class T> Matrix<size-1, T> Matrix<size, T>::ij(const
     return out;
 }
 
-template<std::size_t size, class T> Matrix<size, T> Matrix<size, T>::inverted() const {
-    Matrix<size, T> out{NoInit};
+namespace Implementation {
 
-    const T _determinant = determinant();
+template<std::size_t size, class T> struct MatrixInverse {
+    Matrix<size, T> operator()(const Matrix<size, T>& m) const {
+        Matrix<size, T> out{NoInit};
 
-    for(std::size_t col = 0; col != size; ++col)
-        for(std::size_t row = 0; row != size; ++row)
-            out[col][row] = (((row+col) & 1) ? -1 : 1)*ij(row, col).determinant()/_determinant;
+        const T determinant = m.determinant();
 
-    return out;
+        for(std::size_t col = 0; col != size; ++col)
+            for(std::size_t row = 0; row != size; ++row)
+                out[col][row] = (((row+col) & 1) ? -1 : 1)*m.ij(row, col).determinant()/determinant;
+
+        return out;
+    }
+};
+
+#ifdef MAGNUM_MATH_IMPLEMENTATION_SIMD
+template<> struct MatrixInverse<4, float> {
+    Matrix<4, float> operator()(const Matrix<4, float>& m) const {
+        Matrix<4, float> out{NoInit};
+        simdInverted4(m.data(), out.data());
+        return out;
+    }
+};
+#endif
+
+}
+
+template<std::size_t size, class T> Matrix<size, T> Matrix<size, T>::inverted() const {
+    return Implementation::MatrixInverse<size, T>{}(*this);
 }
 
 }}
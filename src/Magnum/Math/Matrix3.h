@@ -386,8 +386,8 @@ template<class T> class Matrix3: public Matrix3x3<T> {
          *      @ref Matrix4::transformVector()
          * @todo extract 2x2 matrix and multiply directly? (benchmark that)
          */
-        Vector2<T> transformVector(const Vector2<T>& vector) const {
-            return ((*this)*Vector3<T>(vector, T(0))).xy();
+        constexpr Vector2<T> transformVector(const Vector2<T>& vector) const {
+            return Vector2<T>::pad((*this)*Vector3<T>(vector, T(0)));
         }
 
         /**
@@ -400,8 +400,8 @@ template<class T> class Matrix3: public Matrix3x3<T> {
          * @see @ref DualComplex::transformPoint(),
          *      @ref Matrix4::transformPoint()
          */
-        Vector2<T> transformPoint(const Vector2<T>& vector) const {
-            return ((*this)*Vector3<T>(vector, T(1))).xy();
+        constexpr Vector2<T> transformPoint(const Vector2<T>& vector) const {
+            return Vector2<T>::pad((*this)*Vector3<T>(vector, T(1)));
         }
 
         MAGNUM_RECTANGULARMATRIX_SUBCLASS_IMPLEMENTATION(3, 3, Matrix3<T>)
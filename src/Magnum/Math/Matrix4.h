@@ -560,8 +560,8 @@ template<class T> class Matrix4: public Matrix4x4<T> {
          *      @ref Matrix3::transformVector()
          * @todo extract 3x3 matrix and multiply directly? (benchmark that)
          */
-        Vector3<T> transformVector(const Vector3<T>& vector) const {
-            return ((*this)*Vector4<T>(vector, T(0))).xyz();
+        constexpr Vector3<T> transformVector(const Vector3<T>& vector) const {
+            return Vector3<T>::pad((*this)*Vector4<T>(vector, T(0)));
         }
 
         /**
@@ -574,13 +574,17 @@ template<class T> class Matrix4: public Matrix4x4<T> {
          * @see @ref DualQuaternion::transformPoint(),
          *      @ref Matrix3::transformPoint()
          */
-        Vector3<T> transformPoint(const Vector3<T>& vector) const {
-            const Vector4<T> transformed{(*this)*Vector4<T>(vector, T(1))};
-            return transformed.xyz()/transformed.w();
+        constexpr Vector3<T> transformPoint(const Vector3<T>& vector) const {
+            return projectedPoint((*this)*Vector4<T>(vector, T(1)));
         }
 
         MAGNUM_RECTANGULARMATRIX_SUBCLASS_IMPLEMENTATION(4, 4, Matrix4<T>)
         MAGNUM_MATRIX_SUBCLASS_IMPLEMENTATION(4, Matrix4, Vector4)
+
+    private:
+        constexpr static Vector3<T> projectedPoint(const Vector4<T>& transformed) {
+            return transformed.xyz()/transformed.w();
+        }
 };
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
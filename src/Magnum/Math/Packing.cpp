@@ -25,6 +25,18 @@
 
 #include "Packing.h"
 
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#elif defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#endif
+#ifdef __F16C__
+#include <immintrin.h>
+#endif
+
 namespace Magnum { namespace Math {
 
 namespace {
@@ -101,4 +113,271 @@ UnsignedShort packHalf(const Float value) {
     return h;
 }
 
+namespace {
+
+template<class T> void unpackIntoScalar(const T* const src, Float* const dst, std::size_t i, const std::size_t size) {
+    for(; i != size; ++i) dst[i] = unpack<Float, T>(src[i]);
+}
+
+template<class T> void packIntoScalar(const Float* const src, T* const dst, std::size_t i, const std::size_t size) {
+    for(; i != size; ++i) dst[i] = pack<T, Float>(src[i]);
+}
+
+#ifdef __SSE2__
+/* Same operation order as in the scalar unpack() to have bit-exact results */
+inline void unpackStore(Float* const dst, const __m128i value, const __m128 max) {
+    _mm_storeu_ps(dst, _mm_div_ps(_mm_cvtepi32_ps(value), max));
+}
+
+inline void unpackStoreSigned(Float* const dst, const __m128i value, const __m128 max) {
+    _mm_storeu_ps(dst, _mm_max_ps(_mm_div_ps(_mm_cvtepi32_ps(value), max), _mm_set1_ps(-1.0f)));
+}
+
+/* The conversion truncates, same as the Integral(value*max) cast in pack() */
+inline __m128i packLoad(const Float* const src, const __m128 max) {
+    return _mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(src), max));
+}
+#elif defined(__wasm_simd128__)
+/* Same as the SSE2 variants above */
+inline void unpackStore(Float* const dst, const v128_t value, const v128_t max) {
+    wasm_v128_store(dst, wasm_f32x4_div(wasm_f32x4_convert_i32x4(value), max));
+}
+
+inline void unpackStoreSigned(Float* const dst, const v128_t value, const v128_t max) {
+    wasm_v128_store(dst, wasm_f32x4_max(wasm_f32x4_div(wasm_f32x4_convert_i32x4(value), max), wasm_f32x4_splat(-1.0f)));
+}
+
+inline v128_t packLoad(const Float* const src, const v128_t max) {
+    return wasm_i32x4_trunc_sat_f32x4(wasm_f32x4_mul(wasm_v128_load(src), max));
+}
+#endif
+
+}
+
+void unpackInto(const Corrade::Containers::ArrayView<const UnsignedByte> src, const Corrade::Containers::ArrayView<Float> dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::unpackInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    std::size_t i = 0;
+    #ifdef __SSE2__
+    const __m128 max = _mm_set1_ps(Float(Implementation::bitMax<UnsignedByte>()));
+    const __m128i zero = _mm_setzero_si128();
+    for(; i + 16 <= src.size(); i += 16) {
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src.data() + i));
+        const __m128i lo = _mm_unpacklo_epi8(in, zero);
+        const __m128i hi = _mm_unpackhi_epi8(in, zero);
+        unpackStore(dst.data() + i +  0, _mm_unpacklo_epi16(lo, zero), max);
+        unpackStore(dst.data() + i +  4, _mm_unpackhi_epi16(lo, zero), max);
+        unpackStore(dst.data() + i +  8, _mm_unpacklo_epi16(hi, zero), max);
+        unpackStore(dst.data() + i + 12, _mm_unpackhi_epi16(hi, zero), max);
+    }
+    #elif defined(__wasm_simd128__)
+    const v128_t max = wasm_f32x4_splat(Float(Implementation::bitMax<UnsignedByte>()));
+    for(; i + 16 <= src.size(); i += 16) {
+        const v128_t in = wasm_v128_load(src.data() + i);
+        const v128_t lo = wasm_u16x8_extend_low_u8x16(in);
+        const v128_t hi = wasm_u16x8_extend_high_u8x16(in);
+        unpackStore(dst.data() + i +  0, wasm_u32x4_extend_low_u16x8(lo), max);
+        unpackStore(dst.data() + i +  4, wasm_u32x4_extend_high_u16x8(lo), max);
+        unpackStore(dst.data() + i +  8, wasm_u32x4_extend_low_u16x8(hi), max);
+        unpackStore(dst.data() + i + 12, wasm_u32x4_extend_high_u16x8(hi), max);
+    }
+    #endif
+    unpackIntoScalar(src.data(), dst.data(), i, src.size());
+}
+
+void unpackInto(const Corrade::Containers::ArrayView<const Byte> src, const Corrade::Containers::ArrayView<Float> dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::unpackInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    std::size_t i = 0;
+    #ifdef __SSE2__
+    const __m128 max = _mm_set1_ps(Float(Implementation::bitMax<Byte>()));
+    for(; i + 16 <= src.size(); i += 16) {
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src.data() + i));
+        /* Sign extension by putting the value into the high half and then
+           shifting arithmetically back */
+        const __m128i lo = _mm_srai_epi16(_mm_unpacklo_epi8(in, in), 8);
+        const __m128i hi = _mm_srai_epi16(_mm_unpackhi_epi8(in, in), 8);
+        unpackStoreSigned(dst.data() + i +  0, _mm_srai_epi32(_mm_unpacklo_epi16(lo, lo), 16), max);
+        unpackStoreSigned(dst.data() + i +  4, _mm_srai_epi32(_mm_unpackhi_epi16(lo, lo), 16), max);
+        unpackStoreSigned(dst.data() + i +  8, _mm_srai_epi32(_mm_unpacklo_epi16(hi, hi), 16), max);
+        unpackStoreSigned(dst.data() + i + 12, _mm_srai_epi32(_mm_unpackhi_epi16(hi, hi), 16), max);
+    }
+    #elif defined(__wasm_simd128__)
+    const v128_t max = wasm_f32x4_splat(Float(Implementation::bitMax<Byte>()));
+    for(; i + 16 <= src.size(); i += 16) {
+        const v128_t in = wasm_v128_load(src.data() + i);
+        const v128_t lo = wasm_i16x8_extend_low_i8x16(in);
+        const v128_t hi = wasm_i16x8_extend_high_i8x16(in);
+        unpackStoreSigned(dst.data() + i +  0, wasm_i32x4_extend_low_i16x8(lo), max);
+        unpackStoreSigned(dst.data() + i +  4, wasm_i32x4_extend_high_i16x8(lo), max);
+        unpackStoreSigned(dst.data() + i +  8, wasm_i32x4_extend_low_i16x8(hi), max);
+        unpackStoreSigned(dst.data() + i + 12, wasm_i32x4_extend_high_i16x8(hi), max);
+    }
+    #endif
+    unpackIntoScalar(src.data(), dst.data(), i, src.size());
+}
+
+void unpackInto(const Corrade::Containers::ArrayView<const UnsignedShort> src, const Corrade::Containers::ArrayView<Float> dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::unpackInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    std::size_t i = 0;
+    #ifdef __SSE2__
+    const __m128 max = _mm_set1_ps(Float(Implementation::bitMax<UnsignedShort>()));
+    const __m128i zero = _mm_setzero_si128();
+    for(; i + 8 <= src.size(); i += 8) {
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src.data() + i));
+        unpackStore(dst.data() + i + 0, _mm_unpacklo_epi16(in, zero), max);
+        unpackStore(dst.data() + i + 4, _mm_unpackhi_epi16(in, zero), max);
+    }
+    #elif defined(__wasm_simd128__)
+    const v128_t max = wasm_f32x4_splat(Float(Implementation::bitMax<UnsignedShort>()));
+    for(; i + 8 <= src.size(); i += 8) {
+        const v128_t in = wasm_v128_load(src.data() + i);
+        unpackStore(dst.data() + i + 0, wasm_u32x4_extend_low_u16x8(in), max);
+        unpackStore(dst.data() + i + 4, wasm_u32x4_extend_high_u16x8(in), max);
+    }
+    #endif
+    unpackIntoScalar(src.data(), dst.data(), i, src.size());
+}
+
+void unpackInto(const Corrade::Containers::ArrayView<const Short> src, const Corrade::Containers::ArrayView<Float> dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::unpackInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    std::size_t i = 0;
+    #ifdef __SSE2__
+    const __m128 max = _mm_set1_ps(Float(Implementation::bitMax<Short>()));
+    for(; i + 8 <= src.size(); i += 8) {
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src.data() + i));
+        unpackStoreSigned(dst.data() + i + 0, _mm_srai_epi32(_mm_unpacklo_epi16(in, in), 16), max);
+        unpackStoreSigned(dst.data() + i + 4, _mm_srai_epi32(_mm_unpackhi_epi16(in, in), 16), max);
+    }
+    #elif defined(__wasm_simd128__)
+    const v128_t max = wasm_f32x4_splat(Float(Implementation::bitMax<Short>()));
+    for(; i + 8 <= src.size(); i += 8) {
+        const v128_t in = wasm_v128_load(src.data() + i);
+        unpackStoreSigned(dst.data() + i + 0, wasm_i32x4_extend_low_i16x8(in), max);
+        unpackStoreSigned(dst.data() + i + 4, wasm_i32x4_extend_high_i16x8(in), max);
+    }
+    #endif
+    unpackIntoScalar(src.data(), dst.data(), i, src.size());
+}
+
+void packInto(const Corrade::Containers::ArrayView<const Float> src, const Corrade::Containers::ArrayView<UnsignedByte> dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::packInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    std::size_t i = 0;
+    #ifdef __SSE2__
+    const __m128 max = _mm_set1_ps(Float(Implementation::bitMax<UnsignedByte>()));
+    for(; i + 16 <= src.size(); i += 16) {
+        /* Values are in range [0, 255] so the intermediate signed saturation
+           doesn't clip anything */
+        const __m128i lo = _mm_packs_epi32(packLoad(src.data() + i + 0, max), packLoad(src.data() + i + 4, max));
+        const __m128i hi = _mm_packs_epi32(packLoad(src.data() + i + 8, max), packLoad(src.data() + i + 12, max));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst.data() + i), _mm_packus_epi16(lo, hi));
+    }
+    #elif defined(__wasm_simd128__)
+    const v128_t max = wasm_f32x4_splat(Float(Implementation::bitMax<UnsignedByte>()));
+    for(; i + 16 <= src.size(); i += 16) {
+        const v128_t lo = wasm_i16x8_narrow_i32x4(packLoad(src.data() + i + 0, max), packLoad(src.data() + i + 4, max));
+        const v128_t hi = wasm_i16x8_narrow_i32x4(packLoad(src.data() + i + 8, max), packLoad(src.data() + i + 12, max));
+        wasm_v128_store(dst.data() + i, wasm_u8x16_narrow_i16x8(lo, hi));
+    }
+    #endif
+    packIntoScalar(src.data(), dst.data(), i, src.size());
+}
+
+void packInto(const Corrade::Containers::ArrayView<const Float> src, const Corrade::Containers::ArrayView<Byte> dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::packInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    std::size_t i = 0;
+    #ifdef __SSE2__
+    const __m128 max = _mm_set1_ps(Float(Implementation::bitMax<Byte>()));
+    for(; i + 16 <= src.size(); i += 16) {
+        const __m128i lo = _mm_packs_epi32(packLoad(src.data() + i + 0, max), packLoad(src.data() + i + 4, max));
+        const __m128i hi = _mm_packs_epi32(packLoad(src.data() + i + 8, max), packLoad(src.data() + i + 12, max));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst.data() + i), _mm_packs_epi16(lo, hi));
+    }
+    #elif defined(__wasm_simd128__)
+    const v128_t max = wasm_f32x4_splat(Float(Implementation::bitMax<Byte>()));
+    for(; i + 16 <= src.size(); i += 16) {
+        const v128_t lo = wasm_i16x8_narrow_i32x4(packLoad(src.data() + i + 0, max), packLoad(src.data() + i + 4, max));
+        const v128_t hi = wasm_i16x8_narrow_i32x4(packLoad(src.data() + i + 8, max), packLoad(src.data() + i + 12, max));
+        wasm_v128_store(dst.data() + i, wasm_i8x16_narrow_i16x8(lo, hi));
+    }
+    #endif
+    packIntoScalar(src.data(), dst.data(), i, src.size());
+}
+
+void packInto(const Corrade::Containers::ArrayView<const Float> src, const Corrade::Containers::ArrayView<UnsignedShort> dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::packInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    std::size_t i = 0;
+    #ifdef __SSE2__
+    const __m128 max = _mm_set1_ps(Float(Implementation::bitMax<UnsignedShort>()));
+    /* SSE2 has no unsigned 32-to-16 bit pack, so the values are shifted into
+       signed range, packed and the sign bit is then flipped back */
+    const __m128i bias32 = _mm_set1_epi32(0x8000);
+    const __m128i bias16 = _mm_set1_epi16(Short(0x8000));
+    for(; i + 8 <= src.size(); i += 8) {
+        const __m128i a = _mm_sub_epi32(packLoad(src.data() + i + 0, max), bias32);
+        const __m128i b = _mm_sub_epi32(packLoad(src.data() + i + 4, max), bias32);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst.data() + i), _mm_xor_si128(_mm_packs_epi32(a, b), bias16));
+    }
+    #elif defined(__wasm_simd128__)
+    /* Unlike SSE2, SIMD128 has an unsigned 32-to-16 bit pack */
+    const v128_t max = wasm_f32x4_splat(Float(Implementation::bitMax<UnsignedShort>()));
+    for(; i + 8 <= src.size(); i += 8)
+        wasm_v128_store(dst.data() + i, wasm_u16x8_narrow_i32x4(packLoad(src.data() + i + 0, max), packLoad(src.data() + i + 4, max)));
+    #endif
+    packIntoScalar(src.data(), dst.data(), i, src.size());
+}
+
+void packInto(const Corrade::Containers::ArrayView<const Float> src, const Corrade::Containers::ArrayView<Short> dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::packInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    std::size_t i = 0;
+    #ifdef __SSE2__
+    const __m128 max = _mm_set1_ps(Float(Implementation::bitMax<Short>()));
+    for(; i + 8 <= src.size(); i += 8)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst.data() + i), _mm_packs_epi32(packLoad(src.data() + i + 0, max), packLoad(src.data() + i + 4, max)));
+    #elif defined(__wasm_simd128__)
+    const v128_t max = wasm_f32x4_splat(Float(Implementation::bitMax<Short>()));
+    for(; i + 8 <= src.size(); i += 8)
+        wasm_v128_store(dst.data() + i, wasm_i16x8_narrow_i32x4(packLoad(src.data() + i + 0, max), packLoad(src.data() + i + 4, max)));
+    #endif
+    packIntoScalar(src.data(), dst.data(), i, src.size());
+}
+
+void packHalfInto(const Corrade::Containers::ArrayView<const Float> src, const Corrade::Containers::ArrayView<UnsignedShort> dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::packHalfInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    std::size_t i = 0;
+    #ifdef __F16C__
+    for(; i + 4 <= src.size(); i += 4)
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst.data() + i), _mm_cvtps_ph(_mm_loadu_ps(src.data() + i), _MM_FROUND_TO_NEAREST_INT));
+    #endif
+    for(; i != src.size(); ++i) dst[i] = packHalf(src[i]);
+}
+
+void unpackHalfInto(const Corrade::Containers::ArrayView<const UnsignedShort> src, const Corrade::Containers::ArrayView<Float> dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::unpackHalfInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    std::size_t i = 0;
+    #ifdef __F16C__
+    for(; i + 4 <= src.size(); i += 4)
+        _mm_storeu_ps(dst.data() + i, _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src.data() + i))));
+    #endif
+    for(; i != src.size(); ++i) dst[i] = unpackHalf(src[i]);
+}
+
 }}
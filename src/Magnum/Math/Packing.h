@@ -234,6 +234,76 @@ template<std::size_t size> Vector<size, Float> unpackHalf(const Vector<size, Uns
     return out;
 }
 
+/**
+@brief Unpack an array of integral values into a floating-point representation
+
+Equivalent to calling @ref unpack() on each element of @p src and storing the
+result in @p dst, but processes several values at once if the library is
+compiled with SSE2 or WebAssembly SIMD128 support. Expects that @p src and
+@p dst have the same size. Example usage:
+@code
+Containers::ArrayView<const UnsignedByte> colors;
+Containers::Array<Float> normalized{colors.size()};
+Math::unpackInto(colors, normalized);
+@endcode
+@see @ref packInto(), @ref unpackHalfInto()
+*/
+MAGNUM_EXPORT void unpackInto(Corrade::Containers::ArrayView<const UnsignedByte> src, Corrade::Containers::ArrayView<Float> dst);
+
+/** @overload */
+MAGNUM_EXPORT void unpackInto(Corrade::Containers::ArrayView<const Byte> src, Corrade::Containers::ArrayView<Float> dst);
+
+/** @overload */
+MAGNUM_EXPORT void unpackInto(Corrade::Containers::ArrayView<const UnsignedShort> src, Corrade::Containers::ArrayView<Float> dst);
+
+/** @overload */
+MAGNUM_EXPORT void unpackInto(Corrade::Containers::ArrayView<const Short> src, Corrade::Containers::ArrayView<Float> dst);
+
+/**
+@brief Pack an array of floating-point values into an integral representation
+
+Equivalent to calling @ref pack() on each element of @p src and storing the
+result in @p dst, but processes several values at once if the library is
+compiled with SSE2 or WebAssembly SIMD128 support. Expects that @p src and
+@p dst have the same size. Similarly to @ref pack(), the input values are expected to be in range
+@f$ [0, 1] @f$ for unsigned and @f$ [-1, 1] @f$ for signed types, the
+result is undefined otherwise.
+@see @ref unpackInto(), @ref packHalfInto()
+*/
+MAGNUM_EXPORT void packInto(Corrade::Containers::ArrayView<const Float> src, Corrade::Containers::ArrayView<UnsignedByte> dst);
+
+/** @overload */
+MAGNUM_EXPORT void packInto(Corrade::Containers::ArrayView<const Float> src, Corrade::Containers::ArrayView<Byte> dst);
+
+/** @overload */
+MAGNUM_EXPORT void packInto(Corrade::Containers::ArrayView<const Float> src, Corrade::Containers::ArrayView<UnsignedShort> dst);
+
+/** @overload */
+MAGNUM_EXPORT void packInto(Corrade::Containers::ArrayView<const Float> src, Corrade::Containers::ArrayView<Short> dst);
+
+/**
+@brief Pack an array of 32-bit float values into 16-bit half-float representation
+
+Equivalent to calling @ref packHalf() on each element of @p src and storing
+the result in @p dst. If the library is compiled with F16C support, the
+conversion is done in hardware four values at a time with round-to-nearest
+rounding mode, thus the results may differ from @ref packHalf() in the last
+bit. Expects that @p src and @p dst have the same size.
+@see @ref unpackHalfInto(), @ref packInto()
+*/
+MAGNUM_EXPORT void packHalfInto(Corrade::Containers::ArrayView<const Float> src, Corrade::Containers::ArrayView<UnsignedShort> dst);
+
+/**
+@brief Unpack an array of 16-bit half-float values into 32-bit float representation
+
+Equivalent to calling @ref unpackHalf() on each element of @p src and
+storing the result in @p dst. If the library is compiled with F16C support,
+the conversion is done in hardware four values at a time. Expects that @p src
+and @p dst have the same size.
+@see @ref packHalfInto(), @ref unpackInto()
+*/
+MAGNUM_EXPORT void unpackHalfInto(Corrade::Containers::ArrayView<const UnsignedShort> src, Corrade::Containers::ArrayView<Float> dst);
+
 }}
 
 #endif
@@ -30,11 +30,14 @@
  */
 
 #include "Magnum/Math/Vector.h"
+#include "Magnum/Math/Implementation/simd.h"
 
 namespace Magnum { namespace Math {
 
 namespace Implementation {
     template<std::size_t, std::size_t, class, class> struct RectangularMatrixConverter;
+    template<std::size_t, std::size_t, std::size_t, class> struct RectangularMatrixMultiply;
+    template<std::size_t, std::size_t, class> struct RectangularMatrixTranspose;
 }
 
 /**
@@ -267,7 +270,9 @@ template<std::size_t cols, std::size_t rows, class T> class RectangularMatrix {
          *      \boldsymbol B_j = -\boldsymbol A_j
          * @f]
          */
-        RectangularMatrix<cols, rows, T> operator-() const;
+        constexpr RectangularMatrix<cols, rows, T> operator-() const {
+            return negatedInternal(typename Implementation::GenerateSequence<cols>::Type{});
+        }
 
         /**
          * @brief Add and assign matrix
@@ -288,8 +293,8 @@ template<std::size_t cols, std::size_t rows, class T> class RectangularMatrix {
          *
          * @see @ref operator+=()
          */
-        RectangularMatrix<cols, rows, T> operator+(const RectangularMatrix<cols, rows, T>& other) const {
-            return RectangularMatrix<cols, rows, T>(*this)+=other;
+        constexpr RectangularMatrix<cols, rows, T> operator+(const RectangularMatrix<cols, rows, T>& other) const {
+            return addInternal(typename Implementation::GenerateSequence<cols>::Type{}, other);
         }
 
         /**
@@ -311,8 +316,8 @@ template<std::size_t cols, std::size_t rows, class T> class RectangularMatrix {
          *
          * @see @ref operator-=()
          */
-        RectangularMatrix<cols, rows, T> operator-(const RectangularMatrix<cols, rows, T>& other) const {
-            return RectangularMatrix<cols, rows, T>(*this)-=other;
+        constexpr RectangularMatrix<cols, rows, T> operator-(const RectangularMatrix<cols, rows, T>& other) const {
+            return subtractInternal(typename Implementation::GenerateSequence<cols>::Type{}, other);
         }
 
         /**
@@ -334,8 +339,8 @@ template<std::size_t cols, std::size_t rows, class T> class RectangularMatrix {
          *
          * @see @ref operator*=(T), @ref operator*(T, const RectangularMatrix<cols, rows, T>&)
          */
-        RectangularMatrix<cols, rows, T> operator*(T number) const {
-            return RectangularMatrix<cols, rows, T>(*this) *= number;
+        constexpr RectangularMatrix<cols, rows, T> operator*(T number) const {
+            return multiplyInternal(typename Implementation::GenerateSequence<cols>::Type{}, number);
         }
 
         /**
@@ -358,8 +363,8 @@ template<std::size_t cols, std::size_t rows, class T> class RectangularMatrix {
          * @see @ref operator/=(T),
          *      @ref operator/(T, const RectangularMatrix<cols, rows, T>&)
          */
-        RectangularMatrix<cols, rows, T> operator/(T number) const {
-            return RectangularMatrix<cols, rows, T>(*this) /= number;
+        constexpr RectangularMatrix<cols, rows, T> operator/(T number) const {
+            return divideInternal(typename Implementation::GenerateSequence<cols>::Type{}, number);
         }
 
         /**
@@ -369,7 +374,7 @@ template<std::size_t cols, std::size_t rows, class T> class RectangularMatrix {
          *      (\boldsymbol {AB})_{ji} = \sum_{k=0}^{m-1} \boldsymbol A_{ki} \boldsymbol B_{jk}
          * @f]
          */
-        template<std::size_t size> RectangularMatrix<size, rows, T> operator*(const RectangularMatrix<size, cols, T>& other) const;
+        template<std::size_t size> constexpr RectangularMatrix<size, rows, T> operator*(const RectangularMatrix<size, cols, T>& other) const;
 
         /**
          * @brief Multiply vector
@@ -379,8 +384,10 @@ template<std::size_t cols, std::size_t rows, class T> class RectangularMatrix {
          *      (\boldsymbol {Aa})_i = \sum_{k=0}^{m-1} \boldsymbol A_{ki} \boldsymbol a_k
          * @f]
          */
-        Vector<rows, T> operator*(const Vector<cols, T>& other) const {
-            return operator*(RectangularMatrix<1, cols, T>(other))[0];
+        constexpr Vector<rows, T> operator*(const Vector<cols, T>& other) const {
+            /* Casting to const so the constexpr overload of operator[] is
+               picked */
+            return static_cast<const RectangularMatrix<1, rows, T>&>(operator*(RectangularMatrix<1, cols, T>(other)))[0];
         }
 
         /**
@@ -391,7 +398,7 @@ template<std::size_t cols, std::size_t rows, class T> class RectangularMatrix {
          * @f]
          * @see @ref row(), @ref flippedCols(), @ref flippedRows()
          */
-        RectangularMatrix<rows, cols, T> transposed() const;
+        constexpr RectangularMatrix<rows, cols, T> transposed() const;
 
         /**
          * @brief Matrix with flipped cols
@@ -463,6 +470,24 @@ template<std::size_t cols, std::size_t rows, class T> class RectangularMatrix {
 
         template<std::size_t ...sequence> constexpr Vector<DiagonalSize, T> diagonalInternal(Implementation::Sequence<sequence...>) const;
 
+        /* Implementation of the arithmetic operators, single expressions so
+           they can be used in constant expressions */
+        template<std::size_t ...sequence> constexpr RectangularMatrix<cols, rows, T> negatedInternal(Implementation::Sequence<sequence...>) const {
+            return {-_data[sequence]...};
+        }
+        template<std::size_t ...sequence> constexpr RectangularMatrix<cols, rows, T> addInternal(Implementation::Sequence<sequence...>, const RectangularMatrix<cols, rows, T>& other) const {
+            return {(_data[sequence] + other._data[sequence])...};
+        }
+        template<std::size_t ...sequence> constexpr RectangularMatrix<cols, rows, T> subtractInternal(Implementation::Sequence<sequence...>, const RectangularMatrix<cols, rows, T>& other) const {
+            return {(_data[sequence] - other._data[sequence])...};
+        }
+        template<std::size_t ...sequence> constexpr RectangularMatrix<cols, rows, T> multiplyInternal(Implementation::Sequence<sequence...>, T number) const {
+            return {(_data[sequence]*number)...};
+        }
+        template<std::size_t ...sequence> constexpr RectangularMatrix<cols, rows, T> divideInternal(Implementation::Sequence<sequence...>, T number) const {
+            return {(_data[sequence]/number)...};
+        }
+
         Vector<rows, T> _data[cols];
 };
 
@@ -537,7 +562,7 @@ template<class T> using Matrix4x3 = RectangularMatrix<4, 3, T>;
 
 Same as @ref RectangularMatrix::operator*(T) const.
 */
-template<std::size_t cols, std::size_t rows, class T> inline RectangularMatrix<cols, rows, T> operator*(
+template<std::size_t cols, std::size_t rows, class T> constexpr RectangularMatrix<cols, rows, T> operator*(
     #ifdef DOXYGEN_GENERATING_OUTPUT
     T
     #else
@@ -632,35 +657,35 @@ extern template MAGNUM_EXPORT Corrade::Utility::Debug& operator<<(Corrade::Utili
         return Math::RectangularMatrix<cols, rows, T>::fromDiagonal(diagonal); \
     }                                                                       \
                                                                             \
-    __VA_ARGS__ operator-() const {                                         \
+    constexpr __VA_ARGS__ operator-() const {                               \
         return Math::RectangularMatrix<cols, rows, T>::operator-();         \
     }                                                                       \
     __VA_ARGS__& operator+=(const Math::RectangularMatrix<cols, rows, T>& other) { \
         Math::RectangularMatrix<cols, rows, T>::operator+=(other);          \
         return *this;                                                       \
     }                                                                       \
-    __VA_ARGS__ operator+(const Math::RectangularMatrix<cols, rows, T>& other) const { \
+    constexpr __VA_ARGS__ operator+(const Math::RectangularMatrix<cols, rows, T>& other) const { \
         return Math::RectangularMatrix<cols, rows, T>::operator+(other);    \
     }                                                                       \
     __VA_ARGS__& operator-=(const Math::RectangularMatrix<cols, rows, T>& other) { \
         Math::RectangularMatrix<cols, rows, T>::operator-=(other);          \
         return *this;                                                       \
     }                                                                       \
-    __VA_ARGS__ operator-(const Math::RectangularMatrix<cols, rows, T>& other) const { \
+    constexpr __VA_ARGS__ operator-(const Math::RectangularMatrix<cols, rows, T>& other) const { \
         return Math::RectangularMatrix<cols, rows, T>::operator-(other);    \
     }                                                                       \
     __VA_ARGS__& operator*=(T number) {                                     \
         Math::RectangularMatrix<cols, rows, T>::operator*=(number);         \
         return *this;                                                       \
     }                                                                       \
-    __VA_ARGS__ operator*(T number) const {                                 \
+    constexpr __VA_ARGS__ operator*(T number) const {                       \
         return Math::RectangularMatrix<cols, rows, T>::operator*(number);   \
     }                                                                       \
     __VA_ARGS__& operator/=(T number) {                                     \
         Math::RectangularMatrix<cols, rows, T>::operator/=(number);         \
         return *this;                                                       \
     }                                                                       \
-    __VA_ARGS__ operator/(T number) const {                                 \
+    constexpr __VA_ARGS__ operator/(T number) const {                       \
         return Math::RectangularMatrix<cols, rows, T>::operator/(number);   \
     }                                                                       \
     constexpr __VA_ARGS__ flippedCols() const {                             \
@@ -671,7 +696,7 @@ extern template MAGNUM_EXPORT Corrade::Utility::Debug& operator<<(Corrade::Utili
     }                                                                       \
 
 #define MAGNUM_MATRIX_OPERATOR_IMPLEMENTATION(...)                          \
-    template<std::size_t size, class T> inline __VA_ARGS__ operator*(typename std::common_type<T>::type number, const __VA_ARGS__& matrix) { \
+    template<std::size_t size, class T> constexpr __VA_ARGS__ operator*(typename std::common_type<T>::type number, const __VA_ARGS__& matrix) { \
         return number*static_cast<const Math::RectangularMatrix<size, size, T>&>(matrix); \
     }                                                                       \
     template<std::size_t size, class T> inline __VA_ARGS__ operator/(typename std::common_type<T>::type number, const __VA_ARGS__& matrix) { \
@@ -682,7 +707,7 @@ extern template MAGNUM_EXPORT Corrade::Utility::Debug& operator<<(Corrade::Utili
     }
 
 #define MAGNUM_MATRIXn_OPERATOR_IMPLEMENTATION(size, Type)                  \
-    template<class T> inline Type<T> operator*(typename std::common_type<T>::type number, const Type<T>& matrix) { \
+    template<class T> constexpr Type<T> operator*(typename std::common_type<T>::type number, const Type<T>& matrix) { \
         return number*static_cast<const Math::RectangularMatrix<size, size, T>&>(matrix); \
     }                                                                       \
     template<class T> inline Type<T> operator/(typename std::common_type<T>::type number, const Type<T>& matrix) { \
@@ -718,34 +743,72 @@ template<std::size_t cols, std::size_t rows, class T> inline void RectangularMat
         _data[i][row] = data[i];
 }
 
-template<std::size_t cols, std::size_t rows, class T> inline RectangularMatrix<cols, rows, T> RectangularMatrix<cols, rows, T>::operator-() const {
-    RectangularMatrix<cols, rows, T> out;
 
-    for(std::size_t i = 0; i != cols; ++i)
-        out._data[i] = -_data[i];
+namespace Implementation {
 
-    return out;
-}
+/* The generic implementations are written as single expressions so they can
+   be used in constant expressions. Elements of the product are accumulated in
+   the same order as in a loop. */
+template<std::size_t cols, std::size_t rows, std::size_t size, class T> struct RectangularMatrixMultiply {
+    constexpr RectangularMatrix<size, rows, T> operator()(const RectangularMatrix<cols, rows, T>& a, const RectangularMatrix<size, cols, T>& b) const {
+        return multiply(typename GenerateSequence<size>::Type{}, a, b);
+    }
 
-template<std::size_t cols, std::size_t rows, class T> template<std::size_t size> inline RectangularMatrix<size, rows, T> RectangularMatrix<cols, rows, T>::operator*(const RectangularMatrix<size, cols, T>& other) const {
-    RectangularMatrix<size, rows, T> out{ZeroInit};
+    private:
+        template<std::size_t ...sequence> constexpr static RectangularMatrix<size, rows, T> multiply(Sequence<sequence...>, const RectangularMatrix<cols, rows, T>& a, const RectangularMatrix<size, cols, T>& b) {
+            return {column(typename GenerateSequence<rows>::Type{}, a, b[sequence])...};
+        }
 
-    for(std::size_t col = 0; col != size; ++col)
-        for(std::size_t row = 0; row != rows; ++row)
-            for(std::size_t pos = 0; pos != cols; ++pos)
-                out[col][row] += _data[pos][row]*other._data[col][pos];
+        template<std::size_t ...sequence> constexpr static Vector<rows, T> column(Sequence<sequence...>, const RectangularMatrix<cols, rows, T>& a, const Vector<cols, T>& b) {
+            return {element(a, b, sequence, 0, T(0))...};
+        }
 
-    return out;
-}
+        constexpr static T element(const RectangularMatrix<cols, rows, T>& a, const Vector<cols, T>& b, std::size_t row, std::size_t pos, T sum) {
+            return pos == cols ? sum : element(a, b, row, pos + 1, T(sum + a[pos][row]*b[pos]));
+        }
+};
 
-template<std::size_t cols, std::size_t rows, class T> inline RectangularMatrix<rows, cols, T> RectangularMatrix<cols, rows, T>::transposed() const {
-    RectangularMatrix<rows, cols, T> out{NoInit};
+template<std::size_t cols, std::size_t rows, class T> struct RectangularMatrixTranspose {
+    constexpr RectangularMatrix<rows, cols, T> operator()(const RectangularMatrix<cols, rows, T>& a) const {
+        return transpose(typename GenerateSequence<rows>::Type{}, a);
+    }
 
-    for(std::size_t col = 0; col != cols; ++col)
-        for(std::size_t row = 0; row != rows; ++row)
-            out[row][col] = _data[col][row];
+    private:
+        template<std::size_t ...sequence> constexpr static RectangularMatrix<rows, cols, T> transpose(Sequence<sequence...>, const RectangularMatrix<cols, rows, T>& a) {
+            return {row(typename GenerateSequence<cols>::Type{}, a, sequence)...};
+        }
 
-    return out;
+        template<std::size_t ...sequence> constexpr static Vector<cols, T> row(Sequence<sequence...>, const RectangularMatrix<cols, rows, T>& a, std::size_t row) {
+            return {a[sequence][row]...};
+        }
+};
+
+#ifdef MAGNUM_MATH_IMPLEMENTATION_SIMD
+template<std::size_t size> struct RectangularMatrixMultiply<4, 4, size, float> {
+    RectangularMatrix<size, 4, float> operator()(const RectangularMatrix<4, 4, float>& a, const RectangularMatrix<size, 4, float>& b) const {
+        RectangularMatrix<size, 4, float> out{NoInit};
+        simdMultiply4<size>(a.data(), b.data(), out.data());
+        return out;
+    }
+};
+
+template<> struct RectangularMatrixTranspose<4, 4, float> {
+    RectangularMatrix<4, 4, float> operator()(const RectangularMatrix<4, 4, float>& a) const {
+        RectangularMatrix<4, 4, float> out{NoInit};
+        simdTranspose4(a.data(), out.data());
+        return out;
+    }
+};
+#endif
+
+}
+
+template<std::size_t cols, std::size_t rows, class T> template<std::size_t size> constexpr RectangularMatrix<size, rows, T> RectangularMatrix<cols, rows, T>::operator*(const RectangularMatrix<size, cols, T>& other) const {
+    return Implementation::RectangularMatrixMultiply<cols, rows, size, T>{}(*this, other);
+}
+
+template<std::size_t cols, std::size_t rows, class T> constexpr RectangularMatrix<rows, cols, T> RectangularMatrix<cols, rows, T>::transposed() const {
+    return Implementation::RectangularMatrixTranspose<cols, rows, T>{}(*this);
 }
 
 template<std::size_t cols, std::size_t rows, class T> constexpr auto RectangularMatrix<cols, rows, T>::diagonal() const -> Vector<DiagonalSize, T> { return diagonalInternal(typename Implementation::GenerateSequence<DiagonalSize>::Type()); }
@@ -0,0 +1,345 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/DualQuaternion.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Packing.h"
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/Math/VectorBlock.h"
+
+namespace Magnum { namespace Math { namespace Test {
+
+/* Each benchmark processes an array of values, similarly to how skinning and
+   scene code does it. When built with MAGNUM_BUILD_MATH_SIMD, the Vector4 and
+   Matrix4 benchmarks measure the SIMD implementation. The packing benchmarks
+   compare the scalar functions to their batch variants, the vector block
+   benchmarks compare the same operation done on AoS and SoA data. */
+struct Benchmark: Corrade::TestSuite::Tester {
+    explicit Benchmark();
+
+    void vector4Add();
+    void vector4Dot();
+    void vector4Normalized();
+
+    void vector3Normalized();
+    void vector3BlockNormalized();
+    void vector3Cross();
+    void vector3BlockCross();
+
+    void matrix4Multiply();
+    void matrix4MultiplyVector();
+    void matrix4Transposed();
+    void matrix4Inverted();
+    void matrix4InvertedRigid();
+
+    void quaternionMultiply();
+    void quaternionTransformVector();
+    void quaternionToMatrix();
+
+    void dualQuaternionMultiply();
+    void dualQuaternionTransformPoint();
+
+    void packUnsignedByte();
+    void packUnsignedByteBatch();
+    void unpackUnsignedByte();
+    void unpackUnsignedByteBatch();
+
+    private:
+        std::vector<Vector4<Float>> _vectors, _vectorsOut;
+        std::vector<Matrix4<Float>> _matrices, _matricesOut;
+        std::vector<Quaternion<Float>> _quaternions, _quaternionsOut;
+        std::vector<DualQuaternion<Float>> _dualQuaternions, _dualQuaternionsOut;
+        std::vector<Vector3<Float>> _vectors3, _vectors3Out;
+        std::vector<Vector3Block<8, Float>> _blocks, _blocksOut;
+        std::vector<Float> _floats, _floatsOut;
+        std::vector<UnsignedByte> _bytes, _bytesOut;
+};
+
+typedef Math::Deg<Float> Deg;
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Vector4<Float> Vector4;
+typedef Math::Matrix4<Float> Matrix4;
+typedef Math::Quaternion<Float> Quaternion;
+typedef Math::DualQuaternion<Float> DualQuaternion;
+
+namespace {
+    enum: std::size_t { Size = 1024 };
+}
+
+Benchmark::Benchmark(): _vectorsOut(Size), _matricesOut(Size), _quaternionsOut(Size), _dualQuaternionsOut(Size), _vectors3Out(Size), _blocks(Size/8), _blocksOut(Size/8), _floatsOut(Size*4), _bytesOut(Size*4) {
+    addBenchmarks({&Benchmark::vector4Add,
+                   &Benchmark::vector4Dot,
+                   &Benchmark::vector4Normalized,
+
+                   &Benchmark::vector3Normalized,
+                   &Benchmark::vector3BlockNormalized,
+                   &Benchmark::vector3Cross,
+                   &Benchmark::vector3BlockCross,
+
+                   &Benchmark::matrix4Multiply,
+                   &Benchmark::matrix4MultiplyVector,
+                   &Benchmark::matrix4Transposed,
+                   &Benchmark::matrix4Inverted,
+                   &Benchmark::matrix4InvertedRigid,
+
+                   &Benchmark::quaternionMultiply,
+                   &Benchmark::quaternionTransformVector,
+                   &Benchmark::quaternionToMatrix,
+
+                   &Benchmark::dualQuaternionMultiply,
+                   &Benchmark::dualQuaternionTransformPoint,
+
+                   &Benchmark::packUnsignedByte,
+                   &Benchmark::packUnsignedByteBatch,
+                   &Benchmark::unpackUnsignedByte,
+                   &Benchmark::unpackUnsignedByteBatch}, 10);
+
+    /* Rigid transformations, so the inverses are well-defined and the
+       rigid-only operations can be used */
+    const Vector3 axis = Vector3{1.0f, -3.0f, 2.0f}.normalized();
+    for(std::size_t i = 0; i != Size; ++i) {
+        const Float f = Float(i);
+        const Vector3 translation{f*0.5f, -f, 3.0f - f*0.25f};
+        _vectors.emplace_back(translation, 1.0f);
+        _vectors3.push_back(translation + Vector3::xAxis());
+        _matrices.push_back(Matrix4::translation(translation)*Matrix4::rotation(Deg(f), axis));
+        _quaternions.push_back(Quaternion::rotation(Deg(f), axis));
+        _dualQuaternions.push_back(DualQuaternion::translation(translation)*DualQuaternion::rotation(Deg(f), axis));
+    }
+
+    Math::blocksFromVectors<8, Vector3>({_vectors3.data(), _vectors3.size()}, {_blocks.data(), _blocks.size()});
+
+    /* Same amount of scalar values as there is components in the vectors */
+    for(std::size_t i = 0; i != Size*4; ++i) {
+        _floats.push_back(Float(i % 256)/255.0f);
+        _bytes.push_back(UnsignedByte(i));
+    }
+}
+
+void Benchmark::vector4Add() {
+    const Vector4 b{0.5f, -1.0f, 2.0f, 0.0f};
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != Size; ++i)
+            _vectorsOut[i] = _vectors[i] + b;
+    }
+
+    CORRADE_COMPARE(_vectorsOut[1], (Vector4{1.0f, -2.0f, 4.75f, 1.0f}));
+}
+
+void Benchmark::vector4Dot() {
+    const Vector4 b{0.5f, -1.0f, 2.0f, 0.0f};
+    Float sum{};
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != Size; ++i)
+            sum += Math::dot(_vectors[i], b);
+    }
+
+    CORRADE_VERIFY(sum != 0.0f);
+}
+
+void Benchmark::vector4Normalized() {
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != Size; ++i)
+            _vectorsOut[i] = _vectors[i].normalized();
+    }
+
+    CORRADE_VERIFY(_vectorsOut[Size - 1].isNormalized());
+}
+
+void Benchmark::vector3Normalized() {
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != Size; ++i)
+            _vectors3Out[i] = _vectors3[i].normalized();
+    }
+
+    CORRADE_VERIFY(_vectors3Out[Size - 1].isNormalized());
+}
+
+void Benchmark::vector3BlockNormalized() {
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != Size/8; ++i)
+            _blocksOut[i] = _blocks[i].normalized();
+    }
+
+    CORRADE_VERIFY(_blocksOut[Size/8 - 1].get(7).isNormalized());
+}
+
+void Benchmark::vector3Cross() {
+    const Vector3 b{0.5f, -1.0f, 2.0f};
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != Size; ++i)
+            _vectors3Out[i] = Math::cross(_vectors3[i], b);
+    }
+
+    CORRADE_COMPARE(_vectors3Out[0], (Vector3{3.0f, -0.5f, -1.0f}));
+}
+
+void Benchmark::vector3BlockCross() {
+    const Vector3Block<8, Float> b{Vector3{0.5f, -1.0f, 2.0f}};
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != Size/8; ++i)
+            _blocksOut[i] = Math::cross(_blocks[i], b);
+    }
+
+    CORRADE_COMPARE(_blocksOut[0].get(0), (Vector3{3.0f, -0.5f, -1.0f}));
+}
+
+void Benchmark::matrix4Multiply() {
+    const Matrix4 parent = Matrix4::translation({1.0f, 2.0f, 3.0f})*Matrix4::rotationZ(Deg(15.0f));
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != Size; ++i)
+            _matricesOut[i] = parent*_matrices[i];
+    }
+
+    CORRADE_VERIFY(_matricesOut[Size - 1].isRigidTransformation());
+}
+
+void Benchmark::matrix4MultiplyVector() {
+    const Matrix4 transformation = Matrix4::translation({1.0f, 2.0f, 3.0f})*Matrix4::rotationZ(Deg(15.0f));
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != Size; ++i)
+            _vectorsOut[i] = transformation*_vectors[i];
+    }
+
+    CORRADE_COMPARE(_vectorsOut[0], (Vector4{1.0f, 2.0f, 6.0f, 1.0f}));
+}
+
+void Benchmark::matrix4Transposed() {
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != Size; ++i)
+            _matricesOut[i] = _matrices[i].transposed();
+    }
+
+    CORRADE_COMPARE(_matricesOut[Size - 1].row(3), _matrices[Size - 1][3]);
+}
+
+void Benchmark::matrix4Inverted() {
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != Size; ++i)
+            _matricesOut[i] = _matrices[i].inverted();
+    }
+
+    CORRADE_COMPARE(_matricesOut[1]*_matrices[1], Matrix4{});
+}
+
+void Benchmark::matrix4InvertedRigid() {
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != Size; ++i)
+            _matricesOut[i] = _matrices[i].invertedRigid();
+    }
+
+    CORRADE_COMPARE(_matricesOut[1]*_matrices[1], Matrix4{});
+}
+
+void Benchmark::quaternionMultiply() {
+    const Quaternion parent = Quaternion::rotation(Deg(15.0f), Vector3::zAxis());
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != Size; ++i)
+            _quaternionsOut[i] = parent*_quaternions[i];
+    }
+
+    CORRADE_VERIFY(_quaternionsOut[Size - 1].isNormalized());
+}
+
+void Benchmark::quaternionTransformVector() {
+    const Vector3 vector{1.0f, 2.0f, 3.0f};
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != Size; ++i)
+            _vectors3Out[i] = _quaternions[i].transformVectorNormalized(vector);
+    }
+
+    CORRADE_COMPARE(_vectors3Out[0], vector);
+}
+
+void Benchmark::quaternionToMatrix() {
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != Size; ++i)
+            _matricesOut[i] = Matrix4::from(_quaternions[i].toMatrix(), {});
+    }
+
+    CORRADE_COMPARE(_matricesOut[0], Matrix4{});
+}
+
+void Benchmark::dualQuaternionMultiply() {
+    const DualQuaternion parent = DualQuaternion::translation({1.0f, 2.0f, 3.0f})*DualQuaternion::rotation(Deg(15.0f), Vector3::zAxis());
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != Size; ++i)
+            _dualQuaternionsOut[i] = parent*_dualQuaternions[i];
+    }
+
+    CORRADE_VERIFY(_dualQuaternionsOut[Size - 1].isNormalized());
+}
+
+void Benchmark::dualQuaternionTransformPoint() {
+    const Vector3 point{1.0f, 2.0f, 3.0f};
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != Size; ++i)
+            _vectors3Out[i] = _dualQuaternions[i].transformPointNormalized(point);
+    }
+
+    CORRADE_COMPARE(_vectors3Out[0], (Vector3{1.0f, 2.0f, 6.0f}));
+}
+
+void Benchmark::packUnsignedByte() {
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != Size*4; ++i)
+            _bytesOut[i] = Math::pack<UnsignedByte>(_floats[i]);
+    }
+
+    CORRADE_COMPARE(_bytesOut[255], 255);
+}
+
+void Benchmark::packUnsignedByteBatch() {
+    CORRADE_BENCHMARK(10) {
+        Math::packInto(Corrade::Containers::ArrayView<const Float>{_floats.data(), _floats.size()}, Corrade::Containers::ArrayView<UnsignedByte>{_bytesOut.data(), _bytesOut.size()});
+    }
+
+    CORRADE_COMPARE(_bytesOut[255], 255);
+}
+
+void Benchmark::unpackUnsignedByte() {
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != Size*4; ++i)
+            _floatsOut[i] = Math::unpack<Float, UnsignedByte>(_bytes[i]);
+    }
+
+    CORRADE_COMPARE(_floatsOut[255], 1.0f);
+}
+
+void Benchmark::unpackUnsignedByteBatch() {
+    CORRADE_BENCHMARK(10) {
+        Math::unpackInto(Corrade::Containers::ArrayView<const UnsignedByte>{_bytes.data(), _bytes.size()}, {_floatsOut.data(), _floatsOut.size()});
+    }
+
+    CORRADE_COMPARE(_floatsOut[255], 1.0f);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::Benchmark)
@@ -25,6 +25,7 @@
 */
 
 #include <sstream>
+#include <vector>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/Configuration.h>
 
@@ -82,6 +83,14 @@ struct BezierTest : Corrade::TestSuite::Tester {
     void subdivideQuadratic();
     void subdivideCubic();
 
+    void valuesUniform();
+    void valuesUniformFewPoints();
+    void valuesUniformDouble();
+    void valuesAt();
+    void tessellate();
+    void tessellateStraight();
+    void tessellateNotEnoughSpace();
+
     void debug();
     void configuration();
 };
@@ -105,6 +114,14 @@ BezierTest::BezierTest() {
               &BezierTest::subdivideQuadratic,
               &BezierTest::subdivideCubic,
 
+              &BezierTest::valuesUniform,
+              &BezierTest::valuesUniformFewPoints,
+              &BezierTest::valuesUniformDouble,
+              &BezierTest::valuesAt,
+              &BezierTest::tessellate,
+              &BezierTest::tessellateStraight,
+              &BezierTest::tessellateNotEnoughSpace,
+
               &BezierTest::debug,
               &BezierTest::configuration});
 }
@@ -274,6 +291,113 @@ void BezierTest::subdivideCubic() {
     CORRADE_COMPARE(right, (CubicBezier2D{Vector2{7.10938f, 6.57812f}, Vector2{13.4375f, 8.6875f}, Vector2{16.25f, -2.0f}, Vector2{5.0f, -20.0f}}));
 }
 
+void BezierTest::valuesUniform() {
+    CubicBezier2D bezier{Vector2{0.0f, 0.0f}, Vector2{10.0f, 15.0f}, Vector2{20.0f, 4.0f}, Vector2{5.0f, -20.0f}};
+
+    Math::Vector<2, Float> values[11];
+    bezier.values(values);
+    for(std::size_t i = 0; i != 11; ++i)
+        CORRADE_COMPARE(values[i], bezier.value(i/10.0f));
+
+    /* The end points are exact */
+    CORRADE_VERIFY(values[0] == bezier[0]);
+    CORRADE_VERIFY(values[10] == bezier[3]);
+}
+
+void BezierTest::valuesUniformFewPoints() {
+    QuadraticBezier2D bezier{Vector2{0.0f, 0.0f}, Vector2{10.0f, 15.0f}, Vector2{20.0f, 4.0f}};
+
+    /* Empty view is a no-op */
+    bezier.values(nullptr);
+
+    Math::Vector<2, Float> one[1];
+    bezier.values(one);
+    CORRADE_COMPARE(one[0], bezier[0]);
+
+    Math::Vector<2, Float> two[2];
+    bezier.values(two);
+    CORRADE_COMPARE(two[0], bezier[0]);
+    CORRADE_COMPARE(two[1], bezier[2]);
+}
+
+void BezierTest::valuesUniformDouble() {
+    /* The error doesn't accumulate even with many points */
+    QuadraticBezier2Dd bezier{Vector2d{0.0, 0.0}, Vector2d{10.0, 15.0}, Vector2d{20.0, 4.0}};
+
+    std::vector<Math::Vector<2, Double>> values(16385);
+    bezier.values({values.data(), values.size()});
+    for(std::size_t i = 0; i < values.size(); i += 1024)
+        CORRADE_COMPARE(values[i], bezier.value(i/16384.0f));
+}
+
+void BezierTest::valuesAt() {
+    CubicBezier2D bezier{Vector2{0.0f, 0.0f}, Vector2{10.0f, 15.0f}, Vector2{20.0f, 4.0f}, Vector2{5.0f, -20.0f}};
+
+    const Float t[]{0.0f, 0.25f, 0.3f, 0.9f, 1.0f};
+    Math::Vector<2, Float> values[5];
+    bezier.values(t, values);
+    for(std::size_t i = 0; i != 5; ++i)
+        CORRADE_COMPARE(values[i], bezier.value(t[i]));
+}
+
+void BezierTest::tessellate() {
+    CubicBezier2D bezier{Vector2{0.0f, 0.0f}, Vector2{10.0f, 15.0f}, Vector2{20.0f, 4.0f}, Vector2{5.0f, -20.0f}};
+
+    /* Query the size first */
+    const std::size_t count = bezier.tessellate(0.1f, nullptr);
+    CORRADE_VERIFY(count > 2);
+
+    std::vector<Math::Vector<2, Float>> points(count);
+    CORRADE_COMPARE(bezier.tessellate(0.1f, {points.data(), points.size()}), count);
+    CORRADE_COMPARE(points.front(), bezier[0]);
+    CORRADE_COMPARE(points.back(), bezier[3]);
+
+    /* The curve between polyline points is closer than the tolerance to the
+       polyline segment. The points are from uniform subdivision of the
+       curve, so find the parameter range of each segment by walking along
+       the curve. */
+    Float t = 0.0f;
+    for(std::size_t i = 1; i != count; ++i) {
+        const Math::Vector<2, Float> a = points[i - 1];
+        const Math::Vector<2, Float> direction = (points[i] - a).normalized();
+        const Float length = (points[i] - a).length();
+        for(; t <= 1.0f; t += 1.0f/1024.0f) {
+            const Math::Vector<2, Float> p = bezier.value(t);
+            const Float along = Math::dot(p - a, direction);
+            if(along > length + 0.001f) break;
+            const Float distance = (p - a - direction*along).length();
+            CORRADE_VERIFY(distance < 0.1f);
+        }
+    }
+
+    /* Smaller tolerance gives more points */
+    CORRADE_VERIFY(bezier.tessellate(0.01f, nullptr) > count);
+}
+
+void BezierTest::tessellateStraight() {
+    CubicBezier2D bezier{Vector2{0.0f, 0.0f}, Vector2{1.0f, 1.0f}, Vector2{2.0f, 2.0f}, Vector2{3.0f, 3.0f}};
+
+    Math::Vector<2, Float> points[2];
+    CORRADE_COMPARE(bezier.tessellate(0.001f, points), 2);
+    CORRADE_COMPARE(points[0], bezier[0]);
+    CORRADE_COMPARE(points[1], bezier[3]);
+}
+
+void BezierTest::tessellateNotEnoughSpace() {
+    QuadraticBezier2D bezier{Vector2{0.0f, 0.0f}, Vector2{10.0f, 15.0f}, Vector2{20.0f, 4.0f}};
+
+    std::vector<Math::Vector<2, Float>> all(bezier.tessellate(0.05f, nullptr));
+    bezier.tessellate(0.05f, {all.data(), all.size()});
+    CORRADE_VERIFY(all.size() > 4);
+
+    /* Only the first three points are written, the full count is returned */
+    Math::Vector<2, Float> points[3];
+    CORRADE_COMPARE(bezier.tessellate(0.05f, points), all.size());
+    CORRADE_COMPARE(points[0], all[0]);
+    CORRADE_COMPARE(points[1], all[1]);
+    CORRADE_COMPARE(points[2], all[2]);
+}
+
 void BezierTest::debug() {
     std::ostringstream out;
     Debug(&out) << CubicBezier2D{Vector2{0.0f, 1.0f}, Vector2{1.5f, -0.3f}, Vector2{2.1f, 0.5f}, Vector2{0.0f, 2.0f}};
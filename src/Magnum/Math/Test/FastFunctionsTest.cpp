@@ -0,0 +1,223 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cmath>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/FastFunctions.h"
+#include "Magnum/Math/Vector4.h"
+#include "Magnum/Math/VectorBlock.h"
+
+namespace Magnum { namespace Math { namespace Test {
+
+struct FastFunctionsTest: Corrade::TestSuite::Tester {
+    explicit FastFunctionsTest();
+
+    void sqrtInverted();
+    void sqrtInvertedAccuracy();
+    void sqrt();
+    void sincos();
+    void sincosAccuracy();
+    void sincosVector();
+    void normalized();
+    void normalizedBlock();
+
+    void sqrtInverted1k();
+    void sqrtInverted1kExact();
+    void sincos1k();
+    void sincos1kExact();
+};
+
+typedef Math::Rad<Float> Rad;
+typedef Math::Deg<Float> Deg;
+typedef Math::Constants<Float> Constants;
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Vector4<Float> Vector4;
+
+FastFunctionsTest::FastFunctionsTest() {
+    addTests({&FastFunctionsTest::sqrtInverted,
+              &FastFunctionsTest::sqrtInvertedAccuracy,
+              &FastFunctionsTest::sqrt,
+              &FastFunctionsTest::sincos,
+              &FastFunctionsTest::sincosAccuracy,
+              &FastFunctionsTest::sincosVector,
+              &FastFunctionsTest::normalized,
+              &FastFunctionsTest::normalizedBlock});
+
+    addBenchmarks({&FastFunctionsTest::sqrtInverted1k,
+                   &FastFunctionsTest::sqrtInverted1kExact,
+                   &FastFunctionsTest::sincos1k,
+                   &FastFunctionsTest::sincos1kExact}, 100);
+}
+
+void FastFunctionsTest::sqrtInverted() {
+    CORRADE_VERIFY(std::abs(Fast::sqrtInverted(16.0f) - 0.25f) < 0.25f*6.6e-4f);
+    CORRADE_VERIFY(std::abs(Fast::sqrtInverted(2.0f) - 0.707107f) < 0.707107f*6.6e-4f);
+
+    const Vector3 result = Vector3{Fast::sqrtInverted(Vector3{1.0f, 4.0f, 100.0f})};
+    CORRADE_VERIFY(std::abs(result[0] - 1.0f) < 6.6e-4f);
+    CORRADE_VERIFY(std::abs(result[1] - 0.5f) < 0.5f*6.6e-4f);
+    CORRADE_VERIFY(std::abs(result[2] - 0.1f) < 0.1f*6.6e-4f);
+}
+
+void FastFunctionsTest::sqrtInvertedAccuracy() {
+    /* Go through all mantissas of two consecutive exponents, which covers
+       the whole error range of the approximation */
+    Float maxError = 0.0f;
+    for(UnsignedInt i = 0x3f000000u; i < 0x40000000u; i += 7) {
+        Fast::Implementation::FloatBits bits;
+        bits.u = i;
+        const Float exact = Math::sqrtInverted(Double(bits.f));
+        maxError = Math::max(maxError, std::abs(Fast::sqrtInverted(bits.f) - exact)/exact);
+    }
+
+    CORRADE_VERIFY(maxError < 6.6e-4f);
+
+    /* Large and small values */
+    for(Float value: {1.0e-30f, 3.5e-10f, 7.0e+16f, 1.0e+35f}) {
+        const Float exact = Math::sqrtInverted(value);
+        CORRADE_VERIFY(std::abs(Fast::sqrtInverted(value) - exact)/exact < 6.6e-4f);
+    }
+}
+
+void FastFunctionsTest::sqrt() {
+    CORRADE_COMPARE(Fast::sqrt(0.0f), 0.0f);
+    CORRADE_VERIFY(std::abs(Fast::sqrt(16.0f) - 4.0f) < 4.0f*6.6e-4f);
+    CORRADE_VERIFY(std::abs(Fast::sqrt(Vector3{9.0f, 0.0f, 2.0f})[2] - 1.414214f) < 1.414214f*6.6e-4f);
+    CORRADE_COMPARE(Fast::sqrt(Vector3{9.0f, 0.0f, 2.0f})[1], 0.0f);
+}
+
+void FastFunctionsTest::sincos() {
+    std::pair<Float, Float> a = Fast::sincos(Rad{0.0f});
+    CORRADE_COMPARE(a.first, 0.0f);
+    CORRADE_COMPARE(a.second, 1.0f);
+
+    std::pair<Float, Float> b = Fast::sincos(Deg{30.0f});
+    CORRADE_COMPARE(b.first, 0.5f);
+    CORRADE_COMPARE(b.second, 0.866025f);
+
+    std::pair<Float, Float> c = Fast::sincos(Deg{-135.0f});
+    CORRADE_COMPARE(c.first, -0.707107f);
+    CORRADE_COMPARE(c.second, -0.707107f);
+
+    /* Unit products */
+    std::pair<Float, Float> d = Fast::sincos(2*Deg{45.0f});
+    CORRADE_VERIFY(std::abs(d.first - 1.0f) < 4.0e-6f);
+    CORRADE_VERIFY(std::abs(d.second) < 4.0e-6f);
+}
+
+void FastFunctionsTest::sincosAccuracy() {
+    Float maxError = 0.0f;
+    for(Int i = -100000; i <= 100000; ++i) {
+        const Float angle = Float(i)*200.0f*Constants::pi()/100000.0f;
+        const std::pair<Float, Float> fast = Fast::sincos(Rad{angle});
+        maxError = Math::max({maxError,
+            Float(std::abs(fast.first - std::sin(Double(angle)))),
+            Float(std::abs(fast.second - std::cos(Double(angle))))});
+    }
+
+    CORRADE_VERIFY(maxError < 4.0e-6f);
+}
+
+void FastFunctionsTest::sincosVector() {
+    const Vector3 angles{0.0f, Constants::piHalf(), -Constants::pi()/6.0f};
+    const std::pair<Vector3, Vector3> result = Fast::sincos(angles);
+    for(std::size_t i = 0; i != 3; ++i) {
+        const std::pair<Float, Float> expected = Math::sincos(Rad{angles[i]});
+        CORRADE_VERIFY(std::abs(result.first[i] - expected.first) < 4.0e-6f);
+        CORRADE_VERIFY(std::abs(result.second[i] - expected.second) < 4.0e-6f);
+    }
+}
+
+void FastFunctionsTest::normalized() {
+    const Vector3 a = Fast::normalized(Vector3{1.0f, -2.0f, 2.0f});
+    CORRADE_VERIFY(std::abs(a.length() - 1.0f) < 6.6e-4f);
+    CORRADE_VERIFY((Math::abs(a - (Vector3{1.0f, -2.0f, 2.0f}/3.0f)) < Vector3{6.6e-4f}).all());
+}
+
+void FastFunctionsTest::normalizedBlock() {
+    const Vector3Block<4, Float> a{Vector4{1.0f, 0.0f, 3.0f, 1.0f},
+                                   Vector4{2.0f, 1.0f, 4.0f, -2.0f},
+                                   Vector4{2.0f, 0.0f, 0.0f, 5.0f}};
+    const Vector3Block<4, Float> normalized = Fast::normalized(a);
+    for(std::size_t i = 0; i != 4; ++i)
+        CORRADE_VERIFY((Math::abs(normalized.get(i) - a.get(i).normalized()) < Vector3{6.6e-4f}).all());
+}
+
+void FastFunctionsTest::sqrtInverted1k() {
+    Float in[1000], out[1000];
+    for(std::size_t i = 0; i != 1000; ++i) in[i] = Float(i + 1);
+
+    CORRADE_BENCHMARK(100)
+        for(std::size_t i = 0; i != 1000; ++i)
+            out[i] = Fast::sqrtInverted(in[i]);
+
+    CORRADE_VERIFY(std::abs(out[3] - 0.5f) < 0.5f*6.6e-4f);
+}
+
+void FastFunctionsTest::sqrtInverted1kExact() {
+    Float in[1000], out[1000];
+    for(std::size_t i = 0; i != 1000; ++i) in[i] = Float(i + 1);
+
+    CORRADE_BENCHMARK(100)
+        for(std::size_t i = 0; i != 1000; ++i)
+            out[i] = Math::sqrtInverted(in[i]);
+
+    CORRADE_COMPARE(out[3], 0.5f);
+}
+
+void FastFunctionsTest::sincos1k() {
+    Float in[1000], sin[1000], cos[1000];
+    for(std::size_t i = 0; i != 1000; ++i) in[i] = Float(i)*0.01f;
+
+    CORRADE_BENCHMARK(100)
+        for(std::size_t i = 0; i != 1000; ++i) {
+            const std::pair<Float, Float> value = Fast::sincos(Rad{in[i]});
+            sin[i] = value.first;
+            cos[i] = value.second;
+        }
+
+    CORRADE_VERIFY(std::abs(sin[100] - 0.841471f) < 4.0e-6f);
+    CORRADE_VERIFY(std::abs(cos[100] - 0.540302f) < 4.0e-6f);
+}
+
+void FastFunctionsTest::sincos1kExact() {
+    Float in[1000], sin[1000], cos[1000];
+    for(std::size_t i = 0; i != 1000; ++i) in[i] = Float(i)*0.01f;
+
+    CORRADE_BENCHMARK(100)
+        for(std::size_t i = 0; i != 1000; ++i) {
+            const std::pair<Float, Float> value = Math::sincos(Rad{in[i]});
+            sin[i] = value.first;
+            cos[i] = value.second;
+        }
+
+    CORRADE_COMPARE(sin[100], 0.841471f);
+    CORRADE_COMPARE(cos[100], 0.540302f);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::FastFunctionsTest)
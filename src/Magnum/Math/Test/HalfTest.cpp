@@ -24,6 +24,8 @@
 */
 
 #include <sstream>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/Math/Half.h"
@@ -37,6 +39,8 @@ struct HalfTest: Corrade::TestSuite::Tester {
     void unpack();
     void pack();
     void repack();
+    void unpackBatch();
+    void packBatch();
 
     void unpack1k();
     void unpack1kNaive();
@@ -44,6 +48,8 @@ struct HalfTest: Corrade::TestSuite::Tester {
     void pack1k();
     void pack1kNaive();
     void pack1kTable();
+    void unpack1kBatch();
+    void pack1kBatch();
 
     void constructDefault();
     void constructValue();
@@ -85,13 +91,18 @@ HalfTest::HalfTest() {
 
     addRepeatedTests({&HalfTest::repack}, 65536);
 
+    addTests({&HalfTest::unpackBatch,
+              &HalfTest::packBatch});
+
     addBenchmarks({
         &HalfTest::unpack1k,
         &HalfTest::unpack1kNaive,
         &HalfTest::unpack1kTable,
         &HalfTest::pack1k,
         &HalfTest::pack1kNaive,
-        &HalfTest::pack1kTable}, 100);
+        &HalfTest::pack1kTable,
+        &HalfTest::unpack1kBatch,
+        &HalfTest::pack1kBatch}, 100);
 
     addTests({&HalfTest::constructDefault,
               &HalfTest::constructValue,
@@ -438,6 +449,54 @@ void HalfTest::repack() {
     }
 }
 
+void HalfTest::unpackBatch() {
+    /* One more than 65536 to test the remainder handling as well */
+    std::vector<UnsignedShort> in;
+    for(UnsignedInt i = 0; i != 65537; ++i) in.push_back(i & 0xffff);
+
+    std::vector<Float> out(in.size());
+    Math::unpackHalfInto(Corrade::Containers::ArrayView<const UnsignedShort>{in.data(), in.size()}, {out.data(), out.size()});
+
+    for(std::size_t i = 0; i != in.size(); ++i) {
+        const Float expected = Math::unpackHalf(in[i]);
+        if(expected != expected) {
+            CORRADE_VERIFY(out[i] != out[i]);
+        } else {
+            /* Bitwise comparison, fuzzy compare would hide denormal issues */
+            CORRADE_COMPARE(reinterpret_cast<const UnsignedInt&>(out[i]), reinterpret_cast<const UnsignedInt&>(expected));
+        }
+    }
+}
+
+void HalfTest::packBatch() {
+    /* All values representable as half floats need to roundtrip, regardless
+       of rounding mode used */
+    std::vector<UnsignedShort> expected;
+    std::vector<Float> in;
+    for(UnsignedInt i = 0; i != 65536; ++i) {
+        const Float value = Math::unpackHalf(i);
+        if(value != value) continue;
+        expected.push_back(i);
+        in.push_back(value);
+    }
+
+    std::vector<UnsignedShort> out(in.size());
+    Math::packHalfInto(Corrade::Containers::ArrayView<const Float>{in.data(), in.size()}, {out.data(), out.size()});
+    for(std::size_t i = 0; i != in.size(); ++i)
+        CORRADE_COMPARE(out[i], expected[i]);
+
+    /* Specials */
+    const Float specials[]{-Constants::inf(), +Constants::inf(), Constants::nan(), 1.0f, -0.000351512f};
+    UnsignedShort outSpecials[5];
+    Math::packHalfInto(specials, outSpecials);
+    CORRADE_COMPARE(outSpecials[0], 0xfc00);
+    CORRADE_COMPARE(outSpecials[1], 0x7c00);
+    CORRADE_COMPARE(outSpecials[2] & 0x7c00, 0x7c00);
+    CORRADE_VERIFY(outSpecials[2] & 0x03ff);
+    CORRADE_COMPARE(outSpecials[3], 0x3c00);
+    CORRADE_COMPARE(outSpecials[4], 0x8dc2);
+}
+
 void HalfTest::pack1k() {
     UnsignedInt out = 0;
     CORRADE_BENCHMARK(100)
@@ -498,6 +557,36 @@ void HalfTest::unpack1kTable() {
     CORRADE_VERIFY(out);
 }
 
+void HalfTest::unpack1kBatch() {
+    std::vector<UnsignedShort> in;
+    for(std::uint_fast16_t i = 0; i != 1000; ++i) in.push_back(i*65);
+    std::vector<Float> out(in.size());
+
+    Float sum = 0.0f;
+    CORRADE_BENCHMARK(100) {
+        Math::unpackHalfInto(Corrade::Containers::ArrayView<const UnsignedShort>{in.data(), in.size()}, {out.data(), out.size()});
+        sum += out[999];
+    }
+
+    /* To avoid optimizing things out */
+    CORRADE_VERIFY(sum);
+}
+
+void HalfTest::pack1kBatch() {
+    std::vector<Float> in;
+    for(std::uint_fast16_t i = 0; i != 1000; ++i) in.push_back(Float(i)*65);
+    std::vector<UnsignedShort> out(in.size());
+
+    UnsignedInt sum = 0;
+    CORRADE_BENCHMARK(100) {
+        Math::packHalfInto(Corrade::Containers::ArrayView<const Float>{in.data(), in.size()}, {out.data(), out.size()});
+        sum += out[999];
+    }
+
+    /* To avoid optimizing things out */
+    CORRADE_VERIFY(sum);
+}
+
 void HalfTest::constructDefault() {
     constexpr Half a;
     CORRADE_COMPARE(Float(a), 0.0f);
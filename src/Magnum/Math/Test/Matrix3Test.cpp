@@ -464,11 +464,19 @@ void Matrix3Test::invertedRigid() {
 }
 
 void Matrix3Test::transform() {
-    Matrix3 a = Matrix3::translation({1.0f, -5.0f})*Matrix3::rotation(Deg(90.0f));
-    Vector2 v(1.0f, -2.0f);
-
-    CORRADE_COMPARE(a.transformVector(v), Vector2(2.0f, 1.0f));
-    CORRADE_COMPARE(a.transformPoint(v), Vector2(3.0f, -4.0f));
+    /* Rotation by 90° written explicitly to test usage in constant
+       expressions */
+    constexpr Matrix3 a = Matrix3::translation({1.0f, -5.0f})*
+        Matrix3{{ 0.0f, 1.0f, 0.0f},
+                {-1.0f, 0.0f, 0.0f},
+                { 0.0f, 0.0f, 1.0f}};
+    constexpr Vector2 v(1.0f, -2.0f);
+    constexpr Vector2 transformedVector = a.transformVector(v);
+    constexpr Vector2 transformedPoint = a.transformPoint(v);
+
+    CORRADE_COMPARE(a, Matrix3::translation({1.0f, -5.0f})*Matrix3::rotation(Deg(90.0f)));
+    CORRADE_COMPARE(transformedVector, Vector2(2.0f, 1.0f));
+    CORRADE_COMPARE(transformedPoint, Vector2(3.0f, -4.0f));
 }
 
 void Matrix3Test::debug() {
@@ -24,7 +24,11 @@
 */
 
 #include <limits>
+#include <sstream>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
 
 #include "Magnum/Math/Packing.h"
 #include "Magnum/Math/Vector3.h"
@@ -44,6 +48,12 @@ struct PackingTest: Corrade::TestSuite::Tester {
     void reunpackSinged();
     void unpackTypeDeduction();
 
+    void unpackIntoUnsigned();
+    void unpackIntoSigned();
+    void packIntoUnsigned();
+    void packIntoSigned();
+    void packIntoWrongSize();
+
     /* Half (un)pack functions are tested and benchmarked in HalfTest.cpp,
        because there's involved comparison and benchmarks to ground truth */
 };
@@ -61,7 +71,13 @@ PackingTest::PackingTest() {
               &PackingTest::packSigned,
               &PackingTest::reunpackUnsinged,
               &PackingTest::reunpackSinged,
-              &PackingTest::unpackTypeDeduction});
+              &PackingTest::unpackTypeDeduction,
+
+              &PackingTest::unpackIntoUnsigned,
+              &PackingTest::unpackIntoSigned,
+              &PackingTest::packIntoUnsigned,
+              &PackingTest::packIntoSigned,
+              &PackingTest::packIntoWrongSize});
 }
 
 void PackingTest::bitMax() {
@@ -279,6 +295,130 @@ void PackingTest::unpackTypeDeduction() {
     CORRADE_COMPARE((Math::unpack<Float, Byte>('\x7F')), 1.0f);
 }
 
+namespace {
+
+/* The batch functions are compared against the scalar ones, with sizes not
+   divisible by the vector width to test the remainder handling as well */
+
+template<class T> std::vector<T> integralRange() {
+    std::vector<T> out;
+    for(Int i = std::numeric_limits<T>::min(); i <= std::numeric_limits<T>::max(); ++i)
+        out.push_back(T(i));
+    out.push_back(T(3));
+    return out;
+}
+
+std::vector<Float> floatRange(const Float min) {
+    std::vector<Float> out;
+    for(std::size_t i = 0; i != 4099; ++i)
+        out.push_back(min + (1.0f - min)*Float(i)/4098.0f);
+    return out;
+}
+
+template<class T> std::vector<Float> unpackScalar(const std::vector<T>& src) {
+    std::vector<Float> out;
+    for(T i: src) out.push_back(Math::unpack<Float, T>(i));
+    return out;
+}
+
+template<class T> std::vector<T> packScalar(const std::vector<Float>& src) {
+    std::vector<T> out;
+    for(Float i: src) out.push_back(Math::pack<T, Float>(i));
+    return out;
+}
+
+template<class T> std::vector<Float> unpackBatch(const std::vector<T>& src) {
+    std::vector<Float> out(src.size());
+    Math::unpackInto(Corrade::Containers::ArrayView<const T>{src.data(), src.size()}, {out.data(), out.size()});
+    return out;
+}
+
+template<class T> std::vector<T> packBatch(const std::vector<Float>& src) {
+    std::vector<T> out(src.size());
+    Math::packInto(Corrade::Containers::ArrayView<const Float>{src.data(), src.size()}, Corrade::Containers::ArrayView<T>{out.data(), out.size()});
+    return out;
+}
+
+}
+
+void PackingTest::unpackIntoUnsigned() {
+    const auto bytes = integralRange<UnsignedByte>();
+    CORRADE_COMPARE_AS(unpackBatch(bytes), unpackScalar(bytes),
+        Corrade::TestSuite::Compare::Container);
+
+    const auto shorts = integralRange<UnsignedShort>();
+    CORRADE_COMPARE_AS(unpackBatch(shorts), unpackScalar(shorts),
+        Corrade::TestSuite::Compare::Container);
+
+    const UnsignedByte src[]{0, 149, 255};
+    Float out[3];
+    Math::unpackInto(Corrade::Containers::arrayView(src), Corrade::Containers::arrayView(out));
+    CORRADE_COMPARE(out[0], 0.0f);
+    CORRADE_COMPARE(out[1], 0.584314f);
+    CORRADE_COMPARE(out[2], 1.0f);
+}
+
+void PackingTest::unpackIntoSigned() {
+    const auto bytes = integralRange<Byte>();
+    CORRADE_COMPARE_AS(unpackBatch(bytes), unpackScalar(bytes),
+        Corrade::TestSuite::Compare::Container);
+
+    const auto shorts = integralRange<Short>();
+    CORRADE_COMPARE_AS(unpackBatch(shorts), unpackScalar(shorts),
+        Corrade::TestSuite::Compare::Container);
+
+    const Byte src[]{127, -72, -128};
+    Float out[3];
+    Math::unpackInto(Corrade::Containers::arrayView(src), Corrade::Containers::arrayView(out));
+    CORRADE_COMPARE(out[0], 1.0f);
+    CORRADE_COMPARE(out[1], -0.566929f);
+    CORRADE_COMPARE(out[2], -1.0f);
+}
+
+void PackingTest::packIntoUnsigned() {
+    const auto floats = floatRange(0.0f);
+    CORRADE_COMPARE_AS(packBatch<UnsignedByte>(floats), packScalar<UnsignedByte>(floats),
+        Corrade::TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(packBatch<UnsignedShort>(floats), packScalar<UnsignedShort>(floats),
+        Corrade::TestSuite::Compare::Container);
+
+    const Float src[]{0.0f, 0.4357f, 1.0f};
+    UnsignedShort out[3];
+    Math::packInto(Corrade::Containers::arrayView(src), Corrade::Containers::arrayView(out));
+    CORRADE_COMPARE(out[0], 0);
+    CORRADE_COMPARE(out[1], 28553);
+    CORRADE_COMPARE(out[2], 65535);
+}
+
+void PackingTest::packIntoSigned() {
+    const auto floats = floatRange(-1.0f);
+    CORRADE_COMPARE_AS(packBatch<Byte>(floats), packScalar<Byte>(floats),
+        Corrade::TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(packBatch<Short>(floats), packScalar<Short>(floats),
+        Corrade::TestSuite::Compare::Container);
+
+    const Float src[]{-1.0f, -0.33f, 1.0f};
+    Byte out[3];
+    Math::packInto(Corrade::Containers::arrayView(src), Corrade::Containers::arrayView(out));
+    CORRADE_COMPARE(out[0], -127);
+    CORRADE_COMPARE(out[1], -41);
+    CORRADE_COMPARE(out[2], 127);
+}
+
+void PackingTest::packIntoWrongSize() {
+    const Float src[3]{};
+    UnsignedByte out[2]{};
+    Float unpacked[3];
+
+    std::ostringstream o;
+    Error redirectError{&o};
+    Math::packInto(Corrade::Containers::arrayView(src), Corrade::Containers::arrayView(out));
+    Math::unpackInto(Corrade::Containers::ArrayView<const UnsignedByte>{out}, Corrade::Containers::arrayView(unpacked));
+    CORRADE_COMPARE(o.str(),
+        "Math::packInto(): wrong destination size, got 2 but expected 3\n"
+        "Math::unpackInto(): wrong destination size, got 3 but expected 2\n");
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Math::Test::PackingTest)
@@ -418,14 +418,14 @@ void RectangularMatrixTest::multiplyDivide() {
 }
 
 void RectangularMatrixTest::multiply() {
-    RectangularMatrix<4, 6, Int> left(
+    constexpr RectangularMatrix<4, 6, Int> left(
         Vector<6, Int>(-5,   27, 10,  33, 0, -15),
         Vector<6, Int>( 7,   56, 66,   1, 0, -24),
         Vector<6, Int>( 4,   41,  4,   0, 1,  -4),
         Vector<6, Int>( 9, -100, 19, -49, 1,   9)
     );
 
-    RectangularMatrix<5, 4, Int> right(
+    constexpr RectangularMatrix<5, 4, Int> right(
         Vector<4, Int>(1,  -7,  0,  158),
         Vector<4, Int>(2,  24, -3,   40),
         Vector<4, Int>(3, -15, -2,  -50),
@@ -441,7 +441,8 @@ void RectangularMatrixTest::multiply() {
        Vector<6, Int>(  363,    179,  2388,  -687,   22,  -649)
     );
 
-    CORRADE_COMPARE(left*right, expected);
+    constexpr RectangularMatrix<5, 6, Int> product = left*right;
+    CORRADE_COMPARE(product, expected);
 }
 
 void RectangularMatrixTest::multiplyVector() {
@@ -453,24 +454,26 @@ void RectangularMatrixTest::multiplyVector() {
        Vector4i(-15,  81, 30,  99)
     ));
 
-    Matrix3x4i c(Vector4i(0, 4,  8, 12),
-                 Vector4i(1, 5,  9, 13),
-                 Vector4i(3, 7, 11, 15));
-    Vector3i d(2, -2, 3);
-    CORRADE_COMPARE(c*d, Vector4i(7, 19, 31, 43));
+    constexpr Matrix3x4i c(Vector4i(0, 4,  8, 12),
+                           Vector4i(1, 5,  9, 13),
+                           Vector4i(3, 7, 11, 15));
+    constexpr Vector3i d(2, -2, 3);
+    constexpr Vector4i e = c*d;
+    CORRADE_COMPARE(e, Vector4i(7, 19, 31, 43));
 }
 
 void RectangularMatrixTest::transposed() {
-    Matrix4x3 original(Vector3( 0.0f,  1.0f,  3.0f),
-                       Vector3( 4.0f,  5.0f,  7.0f),
-                       Vector3( 8.0f,  9.0f, 11.0f),
-                       Vector3(12.0f, 13.0f, 15.0f));
+    constexpr Matrix4x3 original(Vector3( 0.0f,  1.0f,  3.0f),
+                                 Vector3( 4.0f,  5.0f,  7.0f),
+                                 Vector3( 8.0f,  9.0f, 11.0f),
+                                 Vector3(12.0f, 13.0f, 15.0f));
+    constexpr Matrix3x4 transposed = original.transposed();
 
-    Matrix3x4 transposed(Vector4(0.0f, 4.0f,  8.0f, 12.0f),
-                         Vector4(1.0f, 5.0f,  9.0f, 13.0f),
-                         Vector4(3.0f, 7.0f, 11.0f, 15.0f));
+    Matrix3x4 expected(Vector4(0.0f, 4.0f,  8.0f, 12.0f),
+                       Vector4(1.0f, 5.0f,  9.0f, 13.0f),
+                       Vector4(3.0f, 7.0f, 11.0f, 15.0f));
 
-    CORRADE_COMPARE(original.transposed(), transposed);
+    CORRADE_COMPARE(transposed, expected);
 }
 
 void RectangularMatrixTest::flippedCols() {
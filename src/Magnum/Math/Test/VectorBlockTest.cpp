@@ -0,0 +1,362 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Vector4.h"
+#include "Magnum/Math/VectorBlock.h"
+
+namespace Magnum { namespace Math { namespace Test {
+
+struct VectorBlockTest: Corrade::TestSuite::Tester {
+    explicit VectorBlockTest();
+
+    void construct();
+    void constructDefault();
+    void constructNoInit();
+    void constructVector();
+    void constructCopy();
+
+    void access();
+    void compare();
+
+    void negative();
+    void addSubtract();
+    void multiplyDivide();
+    void multiplyDivideLanes();
+    void multiplyDivideComponentWise();
+
+    void dot();
+    void length();
+    void normalized();
+    void cross();
+    void minMax();
+    void lerp();
+
+    void fromToVectors();
+    void fromToVectorsRemainder();
+    void fromToVectorsWrongSize();
+
+    void debug();
+};
+
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Vector4<Float> Vector4;
+typedef Math::Vector3Block<4, Float> Vector3Block;
+
+VectorBlockTest::VectorBlockTest() {
+    addTests({&VectorBlockTest::construct,
+              &VectorBlockTest::constructDefault,
+              &VectorBlockTest::constructNoInit,
+              &VectorBlockTest::constructVector,
+              &VectorBlockTest::constructCopy,
+
+              &VectorBlockTest::access,
+              &VectorBlockTest::compare,
+
+              &VectorBlockTest::negative,
+              &VectorBlockTest::addSubtract,
+              &VectorBlockTest::multiplyDivide,
+              &VectorBlockTest::multiplyDivideLanes,
+              &VectorBlockTest::multiplyDivideComponentWise,
+
+              &VectorBlockTest::dot,
+              &VectorBlockTest::length,
+              &VectorBlockTest::normalized,
+              &VectorBlockTest::cross,
+              &VectorBlockTest::minMax,
+              &VectorBlockTest::lerp,
+
+              &VectorBlockTest::fromToVectors,
+              &VectorBlockTest::fromToVectorsRemainder,
+              &VectorBlockTest::fromToVectorsWrongSize,
+
+              &VectorBlockTest::debug});
+}
+
+void VectorBlockTest::construct() {
+    constexpr Vector3Block a{Vector4{1.0f, 2.0f, 3.0f, 4.0f},
+                             Vector4{5.0f, 6.0f, 7.0f, 8.0f},
+                             Vector4{9.0f, 10.0f, 11.0f, 12.0f}};
+    constexpr Vector4 y = a[1];
+    CORRADE_COMPARE(y, (Vector4{5.0f, 6.0f, 7.0f, 8.0f}));
+    CORRADE_COMPARE(a.get(2), (Vector3{3.0f, 7.0f, 11.0f}));
+
+    CORRADE_VERIFY((std::is_nothrow_constructible<Vector3Block, Vector4, Vector4, Vector4>::value));
+}
+
+void VectorBlockTest::constructDefault() {
+    constexpr Vector3Block a;
+    constexpr Vector3Block b{ZeroInit};
+    CORRADE_COMPARE(a, (Vector3Block{Vector4{}, Vector4{}, Vector4{}}));
+    CORRADE_COMPARE(b, (Vector3Block{Vector4{}, Vector4{}, Vector4{}}));
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<Vector3Block>::value);
+    CORRADE_VERIFY((std::is_nothrow_constructible<Vector3Block, ZeroInitT>::value));
+}
+
+void VectorBlockTest::constructNoInit() {
+    Vector3Block a{Vector4{1.0f}, Vector4{2.0f}, Vector4{3.0f}};
+    new(&a) Vector3Block{NoInit};
+    {
+        #if defined(__GNUC__) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a, (Vector3Block{Vector4{1.0f}, Vector4{2.0f}, Vector4{3.0f}}));
+    }
+
+    CORRADE_VERIFY((std::is_nothrow_constructible<Vector3Block, NoInitT>::value));
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!(std::is_convertible<NoInitT, Vector3Block>::value));
+}
+
+void VectorBlockTest::constructVector() {
+    constexpr Vector3Block a{Vector3{1.0f, 2.0f, 3.0f}};
+    CORRADE_COMPARE(a, (Vector3Block{Vector4{1.0f}, Vector4{2.0f}, Vector4{3.0f}}));
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!(std::is_convertible<Vector3, Vector3Block>::value));
+
+    CORRADE_VERIFY((std::is_nothrow_constructible<Vector3Block, Vector3>::value));
+}
+
+void VectorBlockTest::constructCopy() {
+    constexpr Vector3Block a{Vector4{1.0f}, Vector4{2.0f}, Vector4{3.0f}};
+    constexpr Vector3Block b{a};
+    CORRADE_COMPARE(b, (Vector3Block{Vector4{1.0f}, Vector4{2.0f}, Vector4{3.0f}}));
+
+    CORRADE_VERIFY(std::is_nothrow_copy_constructible<Vector3Block>::value);
+    CORRADE_VERIFY(std::is_nothrow_copy_assignable<Vector3Block>::value);
+}
+
+void VectorBlockTest::access() {
+    Vector3Block a;
+    a.set(1, {1.0f, 2.0f, 3.0f});
+    a.set(3, {4.0f, 5.0f, 6.0f});
+    a[2][0] = 7.0f;
+
+    CORRADE_COMPARE(a.get(0), (Vector3{0.0f, 0.0f, 7.0f}));
+    CORRADE_COMPARE(a.get(1), (Vector3{1.0f, 2.0f, 3.0f}));
+    CORRADE_COMPARE(a.get(3), (Vector3{4.0f, 5.0f, 6.0f}));
+    CORRADE_COMPARE(a[0], (Vector4{0.0f, 1.0f, 0.0f, 4.0f}));
+    CORRADE_COMPARE(a[2], (Vector4{7.0f, 3.0f, 0.0f, 6.0f}));
+}
+
+void VectorBlockTest::compare() {
+    const Vector3Block a{Vector3{1.0f, 2.0f, 3.0f}};
+    Vector3Block b = a;
+    CORRADE_VERIFY(a == b);
+    CORRADE_VERIFY(!(a != b));
+
+    b[2][3] = 3.0f + TypeTraits<Float>::epsilon()/2.0f;
+    CORRADE_VERIFY(a == b);
+
+    b[2][3] = 3.1f;
+    CORRADE_VERIFY(a != b);
+    CORRADE_VERIFY(!(a == b));
+}
+
+void VectorBlockTest::negative() {
+    const Vector3Block a{Vector4{1.0f, -2.0f, 0.0f, 4.0f}, Vector4{2.0f}, Vector4{-3.0f}};
+    CORRADE_COMPARE(-a, (Vector3Block{Vector4{-1.0f, 2.0f, 0.0f, -4.0f}, Vector4{-2.0f}, Vector4{3.0f}}));
+}
+
+void VectorBlockTest::addSubtract() {
+    const Vector3Block a{Vector4{1.0f, 2.0f, 3.0f, 4.0f}, Vector4{2.0f}, Vector4{3.0f}};
+    const Vector3Block b{Vector3{0.5f, -1.0f, 2.0f}};
+    const Vector3Block c{Vector4{1.5f, 2.5f, 3.5f, 4.5f}, Vector4{1.0f}, Vector4{5.0f}};
+
+    CORRADE_COMPARE(a + b, c);
+    CORRADE_COMPARE(c - b, a);
+}
+
+void VectorBlockTest::multiplyDivide() {
+    const Vector3Block a{Vector4{1.0f, 2.0f, 3.0f, 4.0f}, Vector4{2.0f}, Vector4{-3.0f}};
+    const Vector3Block b{Vector4{0.5f, 1.0f, 1.5f, 2.0f}, Vector4{1.0f}, Vector4{-1.5f}};
+
+    CORRADE_COMPARE(a*0.5f, b);
+    CORRADE_COMPARE(0.5f*a, b);
+    CORRADE_COMPARE(b/0.5f, a);
+}
+
+void VectorBlockTest::multiplyDivideLanes() {
+    const Vector3Block a{Vector4{1.0f, 2.0f, 3.0f, 4.0f}, Vector4{2.0f}, Vector4{-3.0f}};
+    const Vector4 scalars{2.0f, 1.0f, 0.5f, -1.0f};
+    const Vector3Block b{Vector4{2.0f, 2.0f, 1.5f, -4.0f},
+                         Vector4{4.0f, 2.0f, 1.0f, -2.0f},
+                         Vector4{-6.0f, -3.0f, -1.5f, 3.0f}};
+
+    CORRADE_COMPARE(a*scalars, b);
+    CORRADE_COMPARE(scalars*a, b);
+    CORRADE_COMPARE(b/scalars, a);
+}
+
+void VectorBlockTest::multiplyDivideComponentWise() {
+    const Vector3Block a{Vector4{1.0f, 2.0f, 3.0f, 4.0f}, Vector4{2.0f}, Vector4{-3.0f}};
+    const Vector3Block b{Vector3{2.0f, 0.5f, -1.0f}};
+    const Vector3Block c{Vector4{2.0f, 4.0f, 6.0f, 8.0f}, Vector4{1.0f}, Vector4{3.0f}};
+
+    CORRADE_COMPARE(a*b, c);
+    CORRADE_COMPARE(c/b, a);
+}
+
+void VectorBlockTest::dot() {
+    const Vector3Block a{Vector4{1.0f, 0.0f, 3.0f, -1.0f},
+                         Vector4{2.0f, 1.0f, 0.5f, 2.0f},
+                         Vector4{3.0f, 0.0f, -2.0f, 0.0f}};
+    const Vector3Block b{Vector3{-1.0f, 2.0f, 4.0f}};
+
+    CORRADE_COMPARE(Math::dot(a, b), (Vector4{
+        Math::dot(a.get(0), b.get(0)),
+        Math::dot(a.get(1), b.get(1)),
+        Math::dot(a.get(2), b.get(2)),
+        Math::dot(a.get(3), b.get(3))}));
+    CORRADE_COMPARE(Math::dot(a, b), (Vector4{15.0f, 2.0f, -10.0f, 5.0f}));
+    CORRADE_COMPARE(a.dot(), (Vector4{14.0f, 1.0f, 13.25f, 5.0f}));
+}
+
+void VectorBlockTest::length() {
+    const Vector3Block a{Vector4{1.0f, 0.0f, 3.0f, 0.0f},
+                         Vector4{2.0f, 1.0f, 4.0f, 0.0f},
+                         Vector4{2.0f, 0.0f, 0.0f, -2.0f}};
+    CORRADE_COMPARE(a.length(), (Vector4{3.0f, 1.0f, 5.0f, 2.0f}));
+    CORRADE_COMPARE(a.lengthInverted(), (Vector4{1.0f/3.0f, 1.0f, 0.2f, 0.5f}));
+}
+
+void VectorBlockTest::normalized() {
+    const Vector3Block a{Vector4{1.0f, 0.0f, 3.0f, 1.0f},
+                         Vector4{2.0f, 1.0f, 4.0f, -2.0f},
+                         Vector4{2.0f, 0.0f, 0.0f, 5.0f}};
+    const Vector3Block normalized = a.normalized();
+    for(std::size_t i = 0; i != 4; ++i)
+        CORRADE_COMPARE(normalized.get(i), a.get(i).normalized());
+}
+
+void VectorBlockTest::cross() {
+    Vector3Block a, b;
+    a.set(0, {1.0f, -1.0f, 1.0f});
+    b.set(0, {4.0f, 3.0f, 7.0f});
+    a.set(2, {0.5f, 2.0f, -3.0f});
+    b.set(2, {1.0f, 0.0f, 2.0f});
+
+    const Vector3Block c = Math::cross(a, b);
+    CORRADE_COMPARE(c.get(0), Math::cross(Vector3{1.0f, -1.0f, 1.0f}, Vector3{4.0f, 3.0f, 7.0f}));
+    CORRADE_COMPARE(c.get(1), Vector3{});
+    CORRADE_COMPARE(c.get(2), Math::cross(Vector3{0.5f, 2.0f, -3.0f}, Vector3{1.0f, 0.0f, 2.0f}));
+}
+
+void VectorBlockTest::minMax() {
+    const Vector3Block a{Vector4{1.0f, -2.0f, 3.0f, 4.0f}, Vector4{2.0f}, Vector4{-3.0f}};
+    const Vector3Block b{Vector3{0.0f, 5.0f, -4.0f}};
+
+    CORRADE_COMPARE(Math::min(a, b), (Vector3Block{Vector4{0.0f, -2.0f, 0.0f, 0.0f}, Vector4{2.0f}, Vector4{-4.0f}}));
+    CORRADE_COMPARE(Math::max(a, b), (Vector3Block{Vector4{1.0f, 0.0f, 3.0f, 4.0f}, Vector4{5.0f}, Vector4{-3.0f}}));
+}
+
+void VectorBlockTest::lerp() {
+    const Vector3Block a{Vector4{1.0f, 2.0f, 3.0f, 4.0f}, Vector4{2.0f}, Vector4{-3.0f}};
+    const Vector3Block b{Vector3{3.0f, 4.0f, 1.0f}};
+
+    CORRADE_COMPARE(Math::lerp(a, b, 0.25f), (Vector3Block{Vector4{1.5f, 2.25f, 3.0f, 3.75f}, Vector4{2.5f}, Vector4{-2.0f}}));
+    CORRADE_COMPARE(Math::lerp(a, b, Vector4{0.0f, 0.5f, 1.0f, 0.25f}), (Vector3Block{
+        Vector4{1.0f, 2.5f, 3.0f, 3.75f},
+        Vector4{2.0f, 3.0f, 4.0f, 2.5f},
+        Vector4{-3.0f, -1.0f, 1.0f, -2.0f}}));
+}
+
+void VectorBlockTest::fromToVectors() {
+    const Vector3 vectors[]{
+        {1.0f, 2.0f, 3.0f},
+        {4.0f, 5.0f, 6.0f},
+        {7.0f, 8.0f, 9.0f},
+        {10.0f, 11.0f, 12.0f},
+        {13.0f, 14.0f, 15.0f},
+        {16.0f, 17.0f, 18.0f},
+        {19.0f, 20.0f, 21.0f},
+        {22.0f, 23.0f, 24.0f}
+    };
+
+    Vector3Block blocks[2];
+    Math::blocksFromVectors<4, Vector3>(vectors, blocks);
+    CORRADE_COMPARE(blocks[0], (Vector3Block{
+        Vector4{1.0f, 4.0f, 7.0f, 10.0f},
+        Vector4{2.0f, 5.0f, 8.0f, 11.0f},
+        Vector4{3.0f, 6.0f, 9.0f, 12.0f}}));
+    CORRADE_COMPARE(blocks[1].get(3), (Vector3{22.0f, 23.0f, 24.0f}));
+
+    Vector3 out[8];
+    Math::vectorsFromBlocks<4, Vector3>(blocks, out);
+    for(std::size_t i = 0; i != 8; ++i)
+        CORRADE_COMPARE(out[i], vectors[i]);
+}
+
+void VectorBlockTest::fromToVectorsRemainder() {
+    const Vector3 vectors[]{
+        {1.0f, 2.0f, 3.0f},
+        {4.0f, 5.0f, 6.0f},
+        {7.0f, 8.0f, 9.0f},
+        {10.0f, 11.0f, 12.0f},
+        {13.0f, 14.0f, 15.0f}
+    };
+
+    Vector3Block blocks[2];
+    blocks[1] = Vector3Block{Vector3{1.0f}};
+    Math::blocksFromVectors<4, Vector3>(vectors, blocks);
+    CORRADE_COMPARE(blocks[1], (Vector3Block{
+        Vector4{13.0f, 0.0f, 0.0f, 0.0f},
+        Vector4{14.0f, 0.0f, 0.0f, 0.0f},
+        Vector4{15.0f, 0.0f, 0.0f, 0.0f}}));
+
+    Vector3 out[5];
+    Math::vectorsFromBlocks<4, Vector3>(blocks, out);
+    for(std::size_t i = 0; i != 5; ++i)
+        CORRADE_COMPARE(out[i], vectors[i]);
+}
+
+void VectorBlockTest::fromToVectorsWrongSize() {
+    Vector3 vectors[5];
+    Vector3Block blocks[1];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Math::blocksFromVectors<4, Vector3>(vectors, blocks);
+    Math::vectorsFromBlocks<4, Vector3>(blocks, vectors);
+    CORRADE_COMPARE(out.str(),
+        "Math::blocksFromVectors(): expected 2 blocks but got 1\n"
+        "Math::vectorsFromBlocks(): expected 2 blocks but got 1\n");
+}
+
+void VectorBlockTest::debug() {
+    std::ostringstream o;
+    Debug(&o) << Math::Vector2Block<3, Float>{Math::Vector<3, Float>{1.0f, 2.0f, 3.0f}, Math::Vector<3, Float>{4.0f, 5.0f, 6.0f}};
+    CORRADE_COMPARE(o.str(), "VectorBlock({1, 2, 3}, {4, 5, 6})\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::VectorBlockTest)
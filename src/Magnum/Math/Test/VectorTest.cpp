@@ -337,12 +337,18 @@ void VectorTest::negative() {
 }
 
 void VectorTest::addSubtract() {
-    Vector4 a(1.0f, -3.0f, 5.0f, -10.0f);
-    Vector4 b(7.5f, 33.0f, -15.0f, 0.0f);
-    Vector4 c(8.5f, 30.0f, -10.0f, -10.0f);
+    constexpr Vector4 a(1.0f, -3.0f, 5.0f, -10.0f);
+    constexpr Vector4 b(7.5f, 33.0f, -15.0f, 0.0f);
+    constexpr Vector4 c(8.5f, 30.0f, -10.0f, -10.0f);
 
     CORRADE_COMPARE(a + b, c);
     CORRADE_COMPARE(c - b, a);
+
+    /* The operations are usable in constant expressions */
+    constexpr Vector4 sum = a + b;
+    constexpr Vector4 difference = c - b;
+    CORRADE_COMPARE(sum, c);
+    CORRADE_COMPARE(difference, a);
 }
 
 void VectorTest::multiplyDivide() {
@@ -416,7 +422,8 @@ void VectorTest::bitwise() {
 }
 
 void VectorTest::dot() {
-    CORRADE_COMPARE(Math::dot(Vector4{1.0f, 0.5f, 0.75f, 1.5f}, {2.0f, 4.0f, 1.0f, 7.0f}), 15.25f);
+    constexpr Float dot = Math::dot(Vector4{1.0f, 0.5f, 0.75f, 1.5f}, {2.0f, 4.0f, 1.0f, 7.0f});
+    CORRADE_COMPARE(dot, 15.25f);
 }
 
 void VectorTest::dotSelf() {
@@ -444,7 +451,8 @@ void VectorTest::resized() {
 }
 
 void VectorTest::sum() {
-    CORRADE_COMPARE(Vector3(1.0f, 2.0f, 4.0f).sum(), 7.0f);
+    constexpr Float sum = Vector3(1.0f, 2.0f, 4.0f).sum();
+    CORRADE_COMPARE(sum, 7.0f);
 }
 
 void VectorTest::product() {
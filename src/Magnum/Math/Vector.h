@@ -68,6 +68,16 @@ namespace Implementation {
             return vec == Vector<size, T>{};
         }
     };
+
+    /* Left fold, so the result is the same as when summing in a loop */
+    template<class T> constexpr T sum(T value) { return value; }
+    template<class T, class ...U> constexpr T sum(T first, T second, U... next) {
+        return sum(T(first + second), next...);
+    }
+
+    template<std::size_t size, class T, std::size_t ...sequence> constexpr T dot(Sequence<sequence...>, const Vector<size, T>& a, const Vector<size, T>& b) {
+        return sum(T(a[sequence]*b[sequence])...);
+    }
 }
 
 /** @relatesalso Vector
@@ -81,8 +91,8 @@ the same general direction, `1` when two *normalized* vectors are parallel,
 @f]
 @see @ref Vector::dot() const, @ref Vector::operator-(), @ref Vector2::perpendicular()
 */
-template<std::size_t size, class T> inline T dot(const Vector<size, T>& a, const Vector<size, T>& b) {
-    return (a*b).sum();
+template<std::size_t size, class T> constexpr T dot(const Vector<size, T>& a, const Vector<size, T>& b) {
+    return Implementation::dot(typename Implementation::GenerateSequence<size>::Type{}, a, b);
 }
 
 /** @relatesalso Vector
@@ -292,7 +302,9 @@ template<std::size_t size, class T> class Vector {
          * @f]
          * @see @ref Vector2::perpendicular()
          */
-        Vector<size, T> operator-() const;
+        constexpr Vector<size, T> operator-() const {
+            return negatedInternal(typename Implementation::GenerateSequence<size>::Type{});
+        }
 
         /**
          * @brief Add and assign vector
@@ -313,8 +325,8 @@ template<std::size_t size, class T> class Vector {
          *
          * @see @ref operator+=(), @ref sum()
          */
-        Vector<size, T> operator+(const Vector<size, T>& other) const {
-            return Vector<size, T>(*this) += other;
+        constexpr Vector<size, T> operator+(const Vector<size, T>& other) const {
+            return addInternal(typename Implementation::GenerateSequence<size>::Type{}, other);
         }
 
         /**
@@ -336,8 +348,8 @@ template<std::size_t size, class T> class Vector {
          *
          * @see @ref operator-=()
          */
-        Vector<size, T> operator-(const Vector<size, T>& other) const {
-            return Vector<size, T>(*this) -= other;
+        constexpr Vector<size, T> operator-(const Vector<size, T>& other) const {
+            return subtractInternal(typename Implementation::GenerateSequence<size>::Type{}, other);
         }
 
         /**
@@ -363,8 +375,8 @@ template<std::size_t size, class T> class Vector {
          *      @ref operator*=(T), @ref operator*(T, const Vector<size, T>&),
          *      @ref operator*(const Vector<size, Integral>&, FloatingPoint)
          */
-        Vector<size, T> operator*(T number) const {
-            return Vector<size, T>(*this) *= number;
+        constexpr Vector<size, T> operator*(T number) const {
+            return multiplyInternal(typename Implementation::GenerateSequence<size>::Type{}, number);
         }
 
         /**
@@ -390,8 +402,8 @@ template<std::size_t size, class T> class Vector {
          *      @ref operator/=(T), @ref operator/(T, const Vector<size, T>&),
          *      @ref operator/(const Vector<size, Integral>&, FloatingPoint)
          */
-        Vector<size, T> operator/(T number) const {
-            return Vector<size, T>(*this) /= number;
+        constexpr Vector<size, T> operator/(T number) const {
+            return divideInternal(typename Implementation::GenerateSequence<size>::Type{}, number);
         }
 
         /**
@@ -417,8 +429,8 @@ template<std::size_t size, class T> class Vector {
          *      @ref operator*(const Vector<size, Integral>&, const Vector<size, FloatingPoint>&),
          *      @ref product()
          */
-        Vector<size, T> operator*(const Vector<size, T>& other) const {
-            return Vector<size, T>(*this) *= other;
+        constexpr Vector<size, T> operator*(const Vector<size, T>& other) const {
+            return multiplyInternal(typename Implementation::GenerateSequence<size>::Type{}, other);
         }
 
         /**
@@ -443,8 +455,8 @@ template<std::size_t size, class T> class Vector {
          * @see @ref operator/(T) const, @ref operator/=(const Vector<size, T>&),
          *      @ref operator/(const Vector<size, Integral>&, const Vector<size, FloatingPoint>&)
          */
-        Vector<size, T> operator/(const Vector<size, T>& other) const {
-            return Vector<size, T>(*this) /= other;
+        constexpr Vector<size, T> operator/(const Vector<size, T>& other) const {
+            return divideInternal(typename Implementation::GenerateSequence<size>::Type{}, other);
         }
 
         /**
@@ -457,7 +469,7 @@ template<std::size_t size, class T> class Vector {
          * @see @ref dot(const Vector<size, T>&, const Vector<size, T>&),
          *      @ref isNormalized()
          */
-        T dot() const { return Math::dot(*this, *this); }
+        constexpr T dot() const { return Math::dot(*this, *this); }
 
         /**
          * @brief Vector length
@@ -545,7 +557,9 @@ template<std::size_t size, class T> class Vector {
          *
          * @see @ref operator+()
          */
-        T sum() const;
+        constexpr T sum() const {
+            return sumInternal(typename Implementation::GenerateSequence<size>::Type{});
+        }
 
         /**
          * @brief Product of values in the vector
@@ -590,6 +604,33 @@ template<std::size_t size, class T> class Vector {
             return {(*this)[sequence]...};
         }
 
+        /* Implementation of the arithmetic operators, single expressions so
+           they can be used in constant expressions */
+        template<std::size_t ...sequence> constexpr Vector<size, T> negatedInternal(Implementation::Sequence<sequence...>) const {
+            return {T(-_data[sequence])...};
+        }
+        template<std::size_t ...sequence> constexpr Vector<size, T> addInternal(Implementation::Sequence<sequence...>, const Vector<size, T>& other) const {
+            return {T(_data[sequence] + other._data[sequence])...};
+        }
+        template<std::size_t ...sequence> constexpr Vector<size, T> subtractInternal(Implementation::Sequence<sequence...>, const Vector<size, T>& other) const {
+            return {T(_data[sequence] - other._data[sequence])...};
+        }
+        template<std::size_t ...sequence> constexpr Vector<size, T> multiplyInternal(Implementation::Sequence<sequence...>, T number) const {
+            return {T(_data[sequence]*number)...};
+        }
+        template<std::size_t ...sequence> constexpr Vector<size, T> divideInternal(Implementation::Sequence<sequence...>, T number) const {
+            return {T(_data[sequence]/number)...};
+        }
+        template<std::size_t ...sequence> constexpr Vector<size, T> multiplyInternal(Implementation::Sequence<sequence...>, const Vector<size, T>& other) const {
+            return {T(_data[sequence]*other._data[sequence])...};
+        }
+        template<std::size_t ...sequence> constexpr Vector<size, T> divideInternal(Implementation::Sequence<sequence...>, const Vector<size, T>& other) const {
+            return {T(_data[sequence]/other._data[sequence])...};
+        }
+        template<std::size_t ...sequence> constexpr T sumInternal(Implementation::Sequence<sequence...>) const {
+            return Implementation::sum(_data[sequence]...);
+        }
+
         T _data[size];
 };
 
@@ -598,7 +639,7 @@ template<std::size_t size, class T> class Vector {
 
 Same as @ref Vector::operator*(T) const.
 */
-template<std::size_t size, class T> inline Vector<size, T> operator*(
+template<std::size_t size, class T> constexpr Vector<size, T> operator*(
     #ifdef DOXYGEN_GENERATING_OUTPUT
     T
     #else
@@ -1117,49 +1158,49 @@ extern template MAGNUM_EXPORT Corrade::Utility::Debug& operator<<(Corrade::Utili
         return Math::Vector<size, T>::pad(a, value);                        \
     }                                                                       \
                                                                             \
-    Type<T> operator-() const {                                             \
+    constexpr Type<T> operator-() const {                                   \
         return Math::Vector<size, T>::operator-();                          \
     }                                                                       \
     Type<T>& operator+=(const Math::Vector<size, T>& other) {               \
         Math::Vector<size, T>::operator+=(other);                           \
         return *this;                                                       \
     }                                                                       \
-    Type<T> operator+(const Math::Vector<size, T>& other) const {           \
+    constexpr Type<T> operator+(const Math::Vector<size, T>& other) const { \
         return Math::Vector<size, T>::operator+(other);                     \
     }                                                                       \
     Type<T>& operator-=(const Math::Vector<size, T>& other) {               \
         Math::Vector<size, T>::operator-=(other);                           \
         return *this;                                                       \
     }                                                                       \
-    Type<T> operator-(const Math::Vector<size, T>& other) const {           \
+    constexpr Type<T> operator-(const Math::Vector<size, T>& other) const { \
         return Math::Vector<size, T>::operator-(other);                     \
     }                                                                       \
     Type<T>& operator*=(T number) {                                         \
         Math::Vector<size, T>::operator*=(number);                          \
         return *this;                                                       \
     }                                                                       \
-    Type<T> operator*(T number) const {                                     \
+    constexpr Type<T> operator*(T number) const {                           \
         return Math::Vector<size, T>::operator*(number);                    \
     }                                                                       \
     Type<T>& operator/=(T number) {                                         \
         Math::Vector<size, T>::operator/=(number);                          \
         return *this;                                                       \
     }                                                                       \
-    Type<T> operator/(T number) const {                                     \
+    constexpr Type<T> operator/(T number) const {                           \
         return Math::Vector<size, T>::operator/(number);                    \
     }                                                                       \
     Type<T>& operator*=(const Math::Vector<size, T>& other) {               \
         Math::Vector<size, T>::operator*=(other);                           \
         return *this;                                                       \
     }                                                                       \
-    Type<T> operator*(const Math::Vector<size, T>& other) const {           \
+    constexpr Type<T> operator*(const Math::Vector<size, T>& other) const { \
         return Math::Vector<size, T>::operator*(other);                     \
     }                                                                       \
     Type<T>& operator/=(const Math::Vector<size, T>& other) {               \
         Math::Vector<size, T>::operator/=(other);                           \
         return *this;                                                       \
     }                                                                       \
-    Type<T> operator/(const Math::Vector<size, T>& other) const {           \
+    constexpr Type<T> operator/(const Math::Vector<size, T>& other) const { \
         return Math::Vector<size, T>::operator/(other);                     \
     }                                                                       \
                                                                             \
@@ -1180,7 +1221,7 @@ extern template MAGNUM_EXPORT Corrade::Utility::Debug& operator<<(Corrade::Utili
     }
 
 #define MAGNUM_VECTORn_OPERATOR_IMPLEMENTATION(size, Type)                  \
-    template<class T> inline Type<T> operator*(typename std::common_type<T>::type number, const Type<T>& vector) { \
+    template<class T> constexpr Type<T> operator*(typename std::common_type<T>::type number, const Type<T>& vector) { \
         return number*static_cast<const Math::Vector<size, T>&>(vector);    \
     }                                                                       \
     template<class T> inline Type<T> operator/(typename std::common_type<T>::type number, const Type<T>& vector) { \
@@ -1313,29 +1354,11 @@ template<std::size_t size, class T> inline BoolVector<size> Vector<size, T>::ope
     return out;
 }
 
-template<std::size_t size, class T> inline Vector<size, T> Vector<size, T>::operator-() const {
-    Vector<size, T> out;
-
-    for(std::size_t i = 0; i != size; ++i)
-        out._data[i] = -_data[i];
-
-    return out;
-}
-
 template<std::size_t size, class T> inline Vector<size, T> Vector<size, T>::projectedOntoNormalized(const Vector<size, T>& line) const {
     CORRADE_ASSERT(line.isNormalized(), "Math::Vector::projectedOntoNormalized(): line must be normalized", {});
     return line*Math::dot(*this, line);
 }
 
-template<std::size_t size, class T> inline T Vector<size, T>::sum() const {
-    T out(_data[0]);
-
-    for(std::size_t i = 1; i != size; ++i)
-        out += _data[i];
-
-    return out;
-}
-
 template<std::size_t size, class T> inline T Vector<size, T>::product() const {
     T out(_data[0]);
 
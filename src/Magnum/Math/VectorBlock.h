@@ -0,0 +1,470 @@
+#ifndef Magnum_Math_VectorBlock_h
+#define Magnum_Math_VectorBlock_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Math::VectorBlock, alias @ref Magnum::Math::Vector2Block, @ref Magnum::Math::Vector3Block, @ref Magnum::Math::Vector4Block, function @ref Magnum::Math::blocksFromVectors(), @ref Magnum::Math::vectorsFromBlocks()
+ */
+
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace Math {
+
+/**
+@brief Block of vectors in structure-of-arrays layout
+@tparam size    Vector size
+@tparam lanes   Count of vectors in the block
+@tparam T       Underlying data type
+
+Stores @p lanes vectors of @p size components with each component in a
+separate @ref Vector "Vector<lanes, T>", i.e. all X components together,
+then all Y components etc. Operations on the block are done on whole
+component rows, which allows the compiler to autovectorize them to full SIMD
+width without any hand-written intrinsics, unlike operations on arrays of
+e.g. @ref Vector3 where the X, Y and Z components are interleaved. The lane
+count should match the target SIMD width, i.e. `4` for SSE or NEON and
+`8` for AVX with @ref Magnum::Float "Float".
+
+Functions that return a scalar for a single vector, such as @ref dot() or
+@ref length(), return a @ref LaneType for the block, with one value for each
+lane. Example usage, normalizing and offsetting an array of particle
+velocities:
+@code
+Containers::ArrayView<Vector3> velocities;
+Containers::Array<Math::Vector3Block<4, Float>> blocks{(velocities.size() + 3)/4};
+Math::blocksFromVectors<4, Vector3>(velocities, blocks);
+
+for(auto& block: blocks)
+    block = block.normalized()*0.5f + Math::Vector3Block<4, Float>{Vector3::yAxis()};
+
+Math::vectorsFromBlocks<4, Vector3>(blocks, velocities);
+@endcode
+@see @ref Vector2Block, @ref Vector3Block, @ref Vector4Block
+*/
+template<std::size_t size, std::size_t lanes, class T> class VectorBlock {
+    static_assert(size != 0 && lanes != 0, "VectorBlock cannot have zero elements");
+
+    public:
+        typedef T Type;                     /**< @brief Underlying data type */
+        typedef Vector<lanes, T> LaneType;  /**< @brief Type holding one value for each lane */
+
+        enum: std::size_t {
+            Size = size,    /**< Vector size */
+            Lanes = lanes   /**< Count of vectors in the block */
+        };
+
+        /**
+         * @brief Default constructor
+         *
+         * All vectors in the block are zero.
+         */
+        constexpr /*implicit*/ VectorBlock(ZeroInitT = ZeroInit) noexcept
+            /** @todoc remove workaround when doxygen is sane */
+            #ifndef DOXYGEN_GENERATING_OUTPUT
+            : VectorBlock<size, lanes, T>{typename Implementation::GenerateSequence<size>::Type{}, ZeroInit}
+            #endif
+            {}
+
+        /** @brief Construct the block without initializing the contents */
+        explicit VectorBlock(NoInitT) noexcept
+            /** @todoc remove workaround when doxygen is sane */
+            #ifndef DOXYGEN_GENERATING_OUTPUT
+            : VectorBlock<size, lanes, T>{typename Implementation::GenerateSequence<size>::Type{}, NoInit}
+            #endif
+            {}
+
+        /** @brief Construct the block from component rows */
+        template<class ...U> constexpr /*implicit*/ VectorBlock(const LaneType& first, const U&... next) noexcept: _data{first, next...} {
+            static_assert(sizeof...(U) + 1 == size, "Wrong number of arguments");
+        }
+
+        /** @brief Construct the block with all lanes set to given vector */
+        constexpr explicit VectorBlock(const Vector<size, T>& value) noexcept: VectorBlock<size, lanes, T>{typename Implementation::GenerateSequence<size>::Type{}, value} {}
+
+        /** @brief Equality comparison */
+        bool operator==(const VectorBlock<size, lanes, T>& other) const {
+            for(std::size_t i = 0; i != size; ++i)
+                if(_data[i] != other._data[i]) return false;
+            return true;
+        }
+
+        /** @brief Non-equality comparison */
+        bool operator!=(const VectorBlock<size, lanes, T>& other) const {
+            return !operator==(other);
+        }
+
+        /**
+         * @brief Component row
+         *
+         * Returns given component of all vectors in the block. @p i
+         * should be less than @ref Size.
+         */
+        LaneType& operator[](std::size_t i) { return _data[i]; }
+        /* returns const& so [][] operations are also constexpr */
+        constexpr const LaneType& operator[](std::size_t i) const { return _data[i]; } /**< @overload */
+
+        /**
+         * @brief Vector in given lane
+         *
+         * @p lane should be less than @ref Lanes.
+         * @see @ref set()
+         */
+        Vector<size, T> get(std::size_t lane) const {
+            Vector<size, T> out{NoInit};
+            for(std::size_t i = 0; i != size; ++i) out[i] = _data[i][lane];
+            return out;
+        }
+
+        /**
+         * @brief Set vector in given lane
+         *
+         * @p lane should be less than @ref Lanes.
+         * @see @ref get()
+         */
+        void set(std::size_t lane, const Vector<size, T>& value) {
+            for(std::size_t i = 0; i != size; ++i) _data[i][lane] = value[i];
+        }
+
+        /** @brief Negated block */
+        VectorBlock<size, lanes, T> operator-() const {
+            VectorBlock<size, lanes, T> out{NoInit};
+            for(std::size_t i = 0; i != size; ++i) out._data[i] = -_data[i];
+            return out;
+        }
+
+        /** @brief Add and assign a block */
+        VectorBlock<size, lanes, T>& operator+=(const VectorBlock<size, lanes, T>& other) {
+            for(std::size_t i = 0; i != size; ++i) _data[i] += other._data[i];
+            return *this;
+        }
+
+        /** @brief Add a block */
+        VectorBlock<size, lanes, T> operator+(const VectorBlock<size, lanes, T>& other) const {
+            return VectorBlock<size, lanes, T>(*this) += other;
+        }
+
+        /** @brief Subtract and assign a block */
+        VectorBlock<size, lanes, T>& operator-=(const VectorBlock<size, lanes, T>& other) {
+            for(std::size_t i = 0; i != size; ++i) _data[i] -= other._data[i];
+            return *this;
+        }
+
+        /** @brief Subtract a block */
+        VectorBlock<size, lanes, T> operator-(const VectorBlock<size, lanes, T>& other) const {
+            return VectorBlock<size, lanes, T>(*this) -= other;
+        }
+
+        /**
+         * @brief Multiply with a block component-wise and assign
+         *
+         * Multiplies each vector with the vector in the same lane of
+         * @p other component-wise.
+         */
+        VectorBlock<size, lanes, T>& operator*=(const VectorBlock<size, lanes, T>& other) {
+            for(std::size_t i = 0; i != size; ++i) _data[i] *= other._data[i];
+            return *this;
+        }
+
+        /** @brief Multiply with a block component-wise */
+        VectorBlock<size, lanes, T> operator*(const VectorBlock<size, lanes, T>& other) const {
+            return VectorBlock<size, lanes, T>(*this) *= other;
+        }
+
+        /**
+         * @brief Multiply with per-lane scalars and assign
+         *
+         * Multiplies each vector with the scalar in the same lane of
+         * @p scalars.
+         */
+        VectorBlock<size, lanes, T>& operator*=(const LaneType& scalars) {
+            for(std::size_t i = 0; i != size; ++i) _data[i] *= scalars;
+            return *this;
+        }
+
+        /** @brief Multiply with per-lane scalars */
+        VectorBlock<size, lanes, T> operator*(const LaneType& scalars) const {
+            return VectorBlock<size, lanes, T>(*this) *= scalars;
+        }
+
+        /** @brief Multiply with a scalar and assign */
+        VectorBlock<size, lanes, T>& operator*=(T scalar) {
+            for(std::size_t i = 0; i != size; ++i) _data[i] *= scalar;
+            return *this;
+        }
+
+        /** @brief Multiply with a scalar */
+        VectorBlock<size, lanes, T> operator*(T scalar) const {
+            return VectorBlock<size, lanes, T>(*this) *= scalar;
+        }
+
+        /** @brief Divide with a block component-wise and assign */
+        VectorBlock<size, lanes, T>& operator/=(const VectorBlock<size, lanes, T>& other) {
+            for(std::size_t i = 0; i != size; ++i) _data[i] /= other._data[i];
+            return *this;
+        }
+
+        /** @brief Divide with a block component-wise */
+        VectorBlock<size, lanes, T> operator/(const VectorBlock<size, lanes, T>& other) const {
+            return VectorBlock<size, lanes, T>(*this) /= other;
+        }
+
+        /** @brief Divide with per-lane scalars and assign */
+        VectorBlock<size, lanes, T>& operator/=(const LaneType& scalars) {
+            for(std::size_t i = 0; i != size; ++i) _data[i] /= scalars;
+            return *this;
+        }
+
+        /** @brief Divide with per-lane scalars */
+        VectorBlock<size, lanes, T> operator/(const LaneType& scalars) const {
+            return VectorBlock<size, lanes, T>(*this) /= scalars;
+        }
+
+        /** @brief Divide with a scalar and assign */
+        VectorBlock<size, lanes, T>& operator/=(T scalar) {
+            for(std::size_t i = 0; i != size; ++i) _data[i] /= scalar;
+            return *this;
+        }
+
+        /** @brief Divide with a scalar */
+        VectorBlock<size, lanes, T> operator/(T scalar) const {
+            return VectorBlock<size, lanes, T>(*this) /= scalar;
+        }
+
+        /**
+         * @brief Dot product of all vectors with themselves
+         *
+         * Faster alternative to @ref length() for comparison purposes.
+         * @see @ref Vector::dot()
+         */
+        LaneType dot() const {
+            LaneType out = _data[0]*_data[0];
+            for(std::size_t i = 1; i != size; ++i) out += _data[i]*_data[i];
+            return out;
+        }
+
+        /**
+         * @brief Length of all vectors
+         *
+         * @see @ref Vector::length()
+         */
+        LaneType length() const { return Math::sqrt(dot()); }
+
+        /**
+         * @brief Inverse length of all vectors
+         *
+         * @see @ref Vector::lengthInverted()
+         */
+        LaneType lengthInverted() const { return Math::sqrtInverted(dot()); }
+
+        /**
+         * @brief Normalized block
+         *
+         * All vectors are expected to be non-zero.
+         * @see @ref Vector::normalized()
+         */
+        VectorBlock<size, lanes, T> normalized() const { return *this*lengthInverted(); }
+
+    private:
+        /* Implementation for VectorBlock<size, lanes, T>::VectorBlock(ZeroInitT) and VectorBlock<size, lanes, T>::VectorBlock(NoInitT) */
+        /* MSVC 2015 can't handle {} here */
+        template<class U, std::size_t ...sequence> constexpr explicit VectorBlock(Implementation::Sequence<sequence...>, U): _data{LaneType((static_cast<void>(sequence), U{typename U::Init{}}))...} {}
+
+        /* Implementation for VectorBlock<size, lanes, T>::VectorBlock(const Vector<size, T>&) */
+        template<std::size_t ...sequence> constexpr explicit VectorBlock(Implementation::Sequence<sequence...>, const Vector<size, T>& value) noexcept: _data{LaneType(value[sequence])...} {}
+
+        LaneType _data[size];
+};
+
+/**
+@brief Two-component vector block
+
+Convenience alternative to `VectorBlock<2, lanes, T>`. See @ref VectorBlock
+for more information.
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<std::size_t lanes, class T> using Vector2Block = VectorBlock<2, lanes, T>;
+#endif
+
+/**
+@brief Three-component vector block
+
+Convenience alternative to `VectorBlock<3, lanes, T>`. See @ref VectorBlock
+for more information.
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<std::size_t lanes, class T> using Vector3Block = VectorBlock<3, lanes, T>;
+#endif
+
+/**
+@brief Four-component vector block
+
+Convenience alternative to `VectorBlock<4, lanes, T>`. See @ref VectorBlock
+for more information.
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<std::size_t lanes, class T> using Vector4Block = VectorBlock<4, lanes, T>;
+#endif
+
+/** @relates VectorBlock
+@brief Multiply scalar with a block
+
+Same as @ref VectorBlock::operator*(T) const.
+*/
+template<std::size_t size, std::size_t lanes, class T> inline VectorBlock<size, lanes, T> operator*(T scalar, const VectorBlock<size, lanes, T>& block) {
+    return block*scalar;
+}
+
+/** @relates VectorBlock
+@brief Multiply per-lane scalars with a block
+
+Same as @ref VectorBlock::operator*(const LaneType&) const.
+*/
+template<std::size_t size, std::size_t lanes, class T> inline VectorBlock<size, lanes, T> operator*(const Vector<lanes, T>& scalars, const VectorBlock<size, lanes, T>& block) {
+    return block*scalars;
+}
+
+/** @relatesalso VectorBlock
+@brief Dot product of vectors in the same lanes
+
+Returns @ref Vector::dot() of each pair of vectors.
+*/
+template<std::size_t size, std::size_t lanes, class T> inline Vector<lanes, T> dot(const VectorBlock<size, lanes, T>& a, const VectorBlock<size, lanes, T>& b) {
+    Vector<lanes, T> out = a[0]*b[0];
+    for(std::size_t i = 1; i != size; ++i) out += a[i]*b[i];
+    return out;
+}
+
+/** @relatesalso VectorBlock
+@brief Cross product of vectors in the same lanes
+
+Returns @ref cross(const Vector3<T>&, const Vector3<T>&) of each pair of
+vectors.
+*/
+template<std::size_t lanes, class T> inline VectorBlock<3, lanes, T> cross(const VectorBlock<3, lanes, T>& a, const VectorBlock<3, lanes, T>& b) {
+    return {a[1]*b[2] - b[1]*a[2],
+            a[2]*b[0] - b[2]*a[0],
+            a[0]*b[1] - b[0]*a[1]};
+}
+
+/** @relatesalso VectorBlock
+@brief Component-wise minimum of two blocks
+
+@see @ref min(const Vector<size, T>&, const Vector<size, T>&)
+*/
+template<std::size_t size, std::size_t lanes, class T> inline VectorBlock<size, lanes, T> min(const VectorBlock<size, lanes, T>& a, const VectorBlock<size, lanes, T>& b) {
+    VectorBlock<size, lanes, T> out{NoInit};
+    for(std::size_t i = 0; i != size; ++i) out[i] = Math::min(a[i], b[i]);
+    return out;
+}
+
+/** @relatesalso VectorBlock
+@brief Component-wise maximum of two blocks
+
+@see @ref max(const Vector<size, T>&, const Vector<size, T>&)
+*/
+template<std::size_t size, std::size_t lanes, class T> inline VectorBlock<size, lanes, T> max(const VectorBlock<size, lanes, T>& a, const VectorBlock<size, lanes, T>& b) {
+    VectorBlock<size, lanes, T> out{NoInit};
+    for(std::size_t i = 0; i != size; ++i) out[i] = Math::max(a[i], b[i]);
+    return out;
+}
+
+/** @relatesalso VectorBlock
+@brief Linear interpolation of two blocks
+
+Interpolates all lanes with the same factor @p t.
+@see @ref lerp(const T&, const T&, U)
+*/
+template<std::size_t size, std::size_t lanes, class T> inline VectorBlock<size, lanes, T> lerp(const VectorBlock<size, lanes, T>& a, const VectorBlock<size, lanes, T>& b, T t) {
+    VectorBlock<size, lanes, T> out{NoInit};
+    for(std::size_t i = 0; i != size; ++i) out[i] = Math::lerp(a[i], b[i], t);
+    return out;
+}
+
+/** @relatesalso VectorBlock
+@brief Linear interpolation of two blocks with per-lane factors
+
+Interpolates each lane with a factor in the same lane of @p t.
+*/
+template<std::size_t size, std::size_t lanes, class T> inline VectorBlock<size, lanes, T> lerp(const VectorBlock<size, lanes, T>& a, const VectorBlock<size, lanes, T>& b, const Vector<lanes, T>& t) {
+    VectorBlock<size, lanes, T> out{NoInit};
+    for(std::size_t i = 0; i != size; ++i) out[i] = (Vector<lanes, T>(T(1)) - t)*a[i] + t*b[i];
+    return out;
+}
+
+/** @relatesalso VectorBlock
+@brief Convert an array of vectors to an array of blocks
+
+The template parameters are expected to be specified explicitly, e.g.
+`blocksFromVectors<4, Vector3>()`. Expects that @p blocks has exactly as many
+items as is needed to store all @p vectors, i.e. `(vectors.size() + lanes - 1)/lanes`. If the vector
+count is not divisible by @p lanes, the remaining lanes of the last block
+are set to zero.
+@see @ref vectorsFromBlocks()
+*/
+template<std::size_t lanes, class VectorType> void blocksFromVectors(Corrade::Containers::ArrayView<const VectorType> vectors, Corrade::Containers::ArrayView<VectorBlock<VectorType::Size, lanes, typename VectorType::Type>> blocks) {
+    CORRADE_ASSERT((vectors.size() + lanes - 1)/lanes == blocks.size(),
+        "Math::blocksFromVectors(): expected" << (vectors.size() + lanes - 1)/lanes << "blocks but got" << blocks.size(), );
+
+    for(std::size_t b = 0; b != blocks.size(); ++b) {
+        const std::size_t offset = b*lanes;
+        for(std::size_t i = 0; i != VectorType::Size; ++i) for(std::size_t l = 0; l != lanes; ++l)
+            blocks[b][i][l] = offset + l < vectors.size() ? vectors[offset + l][i] : typename VectorType::Type(0);
+    }
+}
+
+/** @relatesalso VectorBlock
+@brief Convert an array of blocks to an array of vectors
+
+Expects that @p blocks has exactly as many items as is needed to store all
+@p vectors, i.e. `(vectors.size() + lanes - 1)/lanes`. If the vector
+count is not divisible by @p lanes, the remaining lanes of the last block are
+ignored.
+@see @ref blocksFromVectors()
+*/
+template<std::size_t lanes, class VectorType> void vectorsFromBlocks(Corrade::Containers::ArrayView<const VectorBlock<VectorType::Size, lanes, typename VectorType::Type>> blocks, Corrade::Containers::ArrayView<VectorType> vectors) {
+    CORRADE_ASSERT((vectors.size() + lanes - 1)/lanes == blocks.size(),
+        "Math::vectorsFromBlocks(): expected" << (vectors.size() + lanes - 1)/lanes << "blocks but got" << blocks.size(), );
+
+    for(std::size_t v = 0; v != vectors.size(); ++v)
+        for(std::size_t i = 0; i != VectorType::Size; ++i)
+            vectors[v][i] = blocks[v/lanes][i][v%lanes];
+}
+
+/** @debugoperator{Magnum::Math::VectorBlock} */
+template<std::size_t size, std::size_t lanes, class T> Corrade::Utility::Debug& operator<<(Corrade::Utility::Debug& debug, const VectorBlock<size, lanes, T>& value) {
+    debug << "VectorBlock(" << Corrade::Utility::Debug::nospace;
+    for(std::size_t i = 0; i != size; ++i) {
+        debug << (i ? ", {" : "{") << Corrade::Utility::Debug::nospace << value[i][0] << Corrade::Utility::Debug::nospace;
+        for(std::size_t l = 1; l != lanes; ++l)
+            debug << "," << value[i][l] << Corrade::Utility::Debug::nospace;
+        debug << "}" << Corrade::Utility::Debug::nospace;
+    }
+    return debug << ")";
+}
+
+}}
+
+#endif
@@ -31,14 +31,19 @@
 #include "Magnum/Buffer.h"
 #include "Magnum/Context.h"
 #include "Magnum/Extensions.h"
+#include "Magnum/Instrumentation.h"
 #ifndef MAGNUM_TARGET_GLES
 #include "Magnum/TransformFeedback.h"
 #endif
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/VertexFormat.h"
+#endif
 
 #ifndef MAGNUM_TARGET_WEBGL
 #include "Implementation/DebugState.h"
 #endif
 #include "Implementation/BufferState.h"
+#include "Implementation/DeletionState.h"
 #include "Implementation/MeshState.h"
 #include "Implementation/State.h"
 
@@ -125,6 +130,16 @@ std::size_t Mesh::indexSize(IndexType type) {
     CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
 }
 
+UnsignedInt Mesh::primitiveRestartIndex(IndexType type) {
+    switch(type) {
+        case IndexType::UnsignedByte: return 0xff;
+        case IndexType::UnsignedShort: return 0xffff;
+        case IndexType::UnsignedInt: return 0xffffffffu;
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
 Mesh::Mesh(const MeshPrimitive primitive): _primitive{primitive}, _flags{ObjectFlag::DeleteOnDestruction}, _count{0}, _baseVertex{0}, _instanceCount{1},
     #ifndef MAGNUM_TARGET_GLES
     _baseInstance{0},
@@ -150,10 +165,6 @@ Mesh::~Mesh() {
     /* Moved out or not deleting on destruction, nothing to do */
     if(!_id || !(_flags & ObjectFlag::DeleteOnDestruction)) return;
 
-    /* Remove current vao from the state */
-    GLuint& current = Context::current().state().mesh->currentVAO;
-    if(current == _id) current = 0;
-
     (this->*Context::current().state().mesh->destroyImplementation)();
 }
 
@@ -165,6 +176,9 @@ Mesh::Mesh(Mesh&& other) noexcept: _id(other._id), _primitive(other._primitive),
     _indexStart(other._indexStart), _indexEnd(other._indexEnd),
     #endif
     _indexOffset(other._indexOffset), _indexType(other._indexType), _indexBuffer(other._indexBuffer), _attributes(std::move(other._attributes))
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    , _vertexFormat{other._vertexFormat}, _vertexBuffers{std::move(other._vertexBuffers)}
+    #endif
 {
     other._id = 0;
 }
@@ -188,6 +202,10 @@ Mesh& Mesh::operator=(Mesh&& other) noexcept {
     swap(_indexType, other._indexType);
     swap(_indexBuffer, other._indexBuffer);
     swap(_attributes, other._attributes);
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    swap(_vertexFormat, other._vertexFormat);
+    swap(_vertexBuffers, other._vertexBuffers);
+    #endif
 
     return *this;
 }
@@ -251,6 +269,8 @@ void Mesh::draw(AbstractShaderProgram& shader) {
     /* Nothing to draw, exit without touching any state */
     if(!_count || !_instanceCount) return;
 
+    MAGNUM_INSTRUMENT_ZONE(Instrumentation::Zone::MeshDraw);
+
     shader.use();
 
     #ifndef MAGNUM_TARGET_GLES
@@ -272,6 +292,8 @@ void Mesh::drawInternal(Int count, Int baseVertex, Int instanceCount, GLintptr i
 {
     const Implementation::MeshState& state = *Context::current().state().mesh;
 
+    MAGNUM_INSTRUMENT_COUNT(Instrumentation::Counter::DrawCalls, 1);
+
     (this->*state.bindImplementation)();
 
     /* Non-instanced mesh */
@@ -373,6 +395,8 @@ void Mesh::drawInternal(Int count, Int baseVertex, Int instanceCount, GLintptr i
 void Mesh::drawInternal(TransformFeedback& xfb, const UnsignedInt stream, const Int instanceCount) {
     const Implementation::MeshState& state = *Context::current().state().mesh;
 
+    MAGNUM_INSTRUMENT_COUNT(Instrumentation::Counter::DrawCalls, 1);
+
     (this->*state.bindImplementation)();
 
     /* Default stream */
@@ -399,10 +423,63 @@ void Mesh::draw(AbstractShaderProgram& shader, TransformFeedback& xfb, UnsignedI
     /* Nothing to draw, exit without touching any state */
     if(!_instanceCount) return;
 
+    MAGNUM_INSTRUMENT_ZONE(Instrumentation::Zone::MeshDraw);
+
     shader.use();
 
     drawInternal(xfb, stream, _instanceCount);
 }
+
+void Mesh::drawIndirect(AbstractShaderProgram& shader, Buffer& buffer, const GLintptr offset, const Int drawCount, const GLsizei stride) {
+    /* Nothing to draw, exit without touching any state */
+    if(!drawCount) return;
+
+    MAGNUM_INSTRUMENT_ZONE(Instrumentation::Zone::MeshDraw);
+
+    shader.use();
+
+    drawIndirectInternal(buffer, offset, drawCount, stride);
+}
+
+void Mesh::drawIndirectInternal(Buffer& buffer, const GLintptr offset, const Int drawCount, const GLsizei stride) {
+    const Implementation::MeshState& state = *Context::current().state().mesh;
+
+    MAGNUM_INSTRUMENT_COUNT(Instrumentation::Counter::DrawCalls, drawCount);
+
+    (this->*state.bindImplementation)();
+
+    /* The indirect buffer binding is not part of VAO state */
+    buffer.bindInternal(Buffer::TargetHint::DrawIndirect);
+    (this->*state.multiDrawIndirectImplementation)(offset, drawCount, stride);
+
+    (this->*state.unbindImplementation)();
+}
+
+void Mesh::multiDrawIndirectImplementationDefault(const GLintptr offset, const GLsizei drawCount, const GLsizei stride) {
+    /* Non-indexed mesh */
+    if(!_indexBuffer)
+        glMultiDrawArraysIndirect(GLenum(_primitive), reinterpret_cast<GLvoid*>(offset), drawCount, stride);
+
+    /* Indexed mesh */
+    else
+        glMultiDrawElementsIndirect(GLenum(_primitive), GLenum(_indexType), reinterpret_cast<GLvoid*>(offset), drawCount, stride);
+}
+
+void Mesh::multiDrawIndirectImplementationFallback(const GLintptr offset, const GLsizei drawCount, GLsizei stride) {
+    if(!stride) stride = _indexBuffer ? sizeof(DrawElementsIndirectCommand) : sizeof(DrawArraysIndirectCommand);
+
+    for(GLsizei i = 0; i != drawCount; ++i) {
+        const GLvoid* const indirect = reinterpret_cast<GLvoid*>(offset + i*stride);
+
+        /* Non-indexed mesh */
+        if(!_indexBuffer)
+            glDrawArraysIndirect(GLenum(_primitive), indirect);
+
+        /* Indexed mesh */
+        else
+            glDrawElementsIndirect(GLenum(_primitive), GLenum(_indexType), indirect);
+    }
+}
 #endif
 
 void Mesh::bindVAO() {
@@ -446,11 +523,22 @@ void Mesh::createImplementationVAODSA() {
 void Mesh::destroyImplementationDefault() {}
 
 void Mesh::destroyImplementationVAO() {
+    Implementation::DeletionState& deletion = *Context::current().state().deletion;
+    if(deletion.deferred) deletion.vertexArrays.push_back(_id);
+    else deleteInternal({&_id, 1});
+}
+
+void Mesh::deleteInternal(const Containers::ArrayView<const GLuint> ids) {
+    /* Remove current vao from the state */
+    GLuint& current = Context::current().state().mesh->currentVAO;
+    for(const GLuint id: ids) if(current == id) current = 0;
+
     #ifndef MAGNUM_TARGET_GLES2
-    glDeleteVertexArrays(1, &_id);
+    glDeleteVertexArrays(ids.size(), ids.data());
     #elif !defined(CORRADE_TARGET_NACL)
-    glDeleteVertexArraysOES(1, &_id);
+    glDeleteVertexArraysOES(ids.size(), ids.data());
     #else
+    static_cast<void>(ids);
     CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
     #endif
 }
@@ -572,6 +660,51 @@ void Mesh::vertexAttribDivisorImplementationNV(const GLuint index, const GLuint
 #endif
 #endif
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+Mesh& Mesh::setVertexFormat(VertexFormat& format) {
+    CORRADE_ASSERT(_vertexBuffers.empty(),
+        "Mesh::setVertexFormat(): the format can't be changed after setting vertex buffers", *this);
+
+    _vertexFormat = &format;
+    return *this;
+}
+
+Mesh& Mesh::setVertexBuffer(const UnsignedInt binding, Buffer& buffer, const GLintptr offset) {
+    CORRADE_ASSERT(_vertexFormat,
+        "Mesh::setVertexBuffer(): no vertex format set", *this);
+    CORRADE_ASSERT(binding < _vertexFormat->bindingCount(),
+        "Mesh::setVertexBuffer(): binding" << binding << "out of range for" << _vertexFormat->bindingCount() << "bindings", *this);
+
+    (this->*Context::current().state().mesh->vertexBufferImplementation)(binding, buffer, offset);
+    return *this;
+}
+
+void Mesh::vertexBufferImplementationFallback(const UnsignedInt binding, Buffer& buffer, const GLintptr offset) {
+    const VertexFormat::Binding& b = _vertexFormat->_bindings[binding];
+    for(const VertexFormat::AttributeFormat& attribute: _vertexFormat->_attributes) {
+        if(attribute.binding != binding) continue;
+
+        attributePointerInternal(buffer, attribute.location, attribute.size, attribute.type, attribute.kind, offset + attribute.relativeOffset, b.stride, b.divisor);
+    }
+}
+
+void Mesh::vertexBufferImplementationVertexAttribBinding(const UnsignedInt binding, Buffer& buffer, const GLintptr offset) {
+    if(binding >= _vertexBuffers.size())
+        _vertexBuffers.resize(binding + 1, {0, 0});
+    _vertexBuffers[binding] = {buffer.id(), offset};
+}
+
+void Mesh::bindVertexFormat() {
+    VertexFormat& format = *_vertexFormat;
+    format.bindInternal();
+
+    for(std::size_t i = 0; i != _vertexBuffers.size(); ++i)
+        format.bindVertexBufferInternal(i, _vertexBuffers[i].first, _vertexBuffers[i].second);
+
+    if(_indexBuffer) format.bindIndexBufferInternal(*_indexBuffer);
+}
+#endif
+
 void Mesh::bindIndexBufferImplementationDefault(Buffer&) {}
 
 void Mesh::bindIndexBufferImplementationVAO(Buffer& buffer) {
@@ -594,6 +727,14 @@ void Mesh::bindImplementationDefault() {
 }
 
 void Mesh::bindImplementationVAO() {
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    /* Mesh using shared vertex format, its own VAO is not used */
+    if(!_vertexBuffers.empty()) {
+        bindVertexFormat();
+        return;
+    }
+    #endif
+
     bindVAO();
 }
 
@@ -29,6 +29,7 @@
  * @brief Class @ref Magnum::Mesh
  */
 
+#include <utility>
 #include <vector>
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Utility/ConfigurationValue.h>
@@ -338,13 +339,23 @@ available, DSA functions are used for specifying attribute locations to avoid
 unnecessary calls to @fn_gl{BindBuffer} and @fn_gl{BindVertexArray}. See
 documentation of @ref addVertexBuffer() for more information.
 
+Meshes with the same vertex layout can share a @ref VertexFormat instead of
+specifying the attributes separately. If @extension{ARB,vertex_attrib_binding}
+or OpenGL ES 3.1 is available, all such meshes are drawn with one shared VAO
+and switching between them only rebinds buffer ranges that differ. See
+@ref setVertexFormat() for more information.
+
 If index range is specified in @ref setIndexBuffer(), range-based version of
 drawing commands are used on desktop OpenGL and OpenGL ES 3.0. See also
 @ref draw() for more information.
  */
 class MAGNUM_EXPORT Mesh: public AbstractObject {
+    friend Context;
     friend MeshView;
     friend Implementation::MeshState;
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    friend VertexFormat;
+    #endif
 
     public:
         /**
@@ -366,6 +377,46 @@ class MAGNUM_EXPORT Mesh: public AbstractObject {
             UnsignedInt = GL_UNSIGNED_INT
         };
 
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Indirect draw command for non-indexed meshes
+         *
+         * Memory layout matches the one expected by
+         * @fn_gl{DrawArraysIndirect} and @fn_gl{MultiDrawArraysIndirect}.
+         * @see @ref drawIndirect(), @ref DrawElementsIndirectCommand
+         * @requires_gl40 Extension @extension{ARB,draw_indirect}
+         * @requires_gl Indirect drawing is not available in OpenGL ES or
+         *      WebGL.
+         */
+        struct DrawArraysIndirectCommand {
+            UnsignedInt count;          /**< @brief Vertex count */
+            UnsignedInt instanceCount;  /**< @brief Instance count */
+            UnsignedInt first;          /**< @brief First vertex */
+            UnsignedInt baseInstance;   /**< @brief Base instance */
+        };
+
+        /**
+         * @brief Indirect draw command for indexed meshes
+         *
+         * Memory layout matches the one expected by
+         * @fn_gl{DrawElementsIndirect} and @fn_gl{MultiDrawElementsIndirect}.
+         * Note that @ref firstIndex is counted from the beginning of the index
+         * buffer, the index buffer offset specified in @ref setIndexBuffer()
+         * is *not* taken into account.
+         * @see @ref drawIndirect(), @ref DrawArraysIndirectCommand
+         * @requires_gl40 Extension @extension{ARB,draw_indirect}
+         * @requires_gl Indirect drawing is not available in OpenGL ES or
+         *      WebGL.
+         */
+        struct DrawElementsIndirectCommand {
+            UnsignedInt count;          /**< @brief Index count */
+            UnsignedInt instanceCount;  /**< @brief Instance count */
+            UnsignedInt firstIndex;     /**< @brief First index */
+            Int baseVertex;             /**< @brief Base vertex */
+            UnsignedInt baseInstance;   /**< @brief Base instance */
+        };
+        #endif
+
         #ifdef MAGNUM_BUILD_DEPRECATED
         /**
          * @copybrief AbstractShaderProgram::maxVertexAttributes()
@@ -426,6 +477,16 @@ class MAGNUM_EXPORT Mesh: public AbstractObject {
          */
         static std::size_t indexSize(IndexType type);
 
+        /**
+         * @brief Fixed primitive restart index for given index type
+         *
+         * The maximal value representable by given type, used for
+         * @ref Renderer::Feature::PrimitiveRestartFixedIndex and always in
+         * WebGL 2.0.
+         * @see @ref MeshTools::stripify()
+         */
+        static UnsignedInt primitiveRestartIndex(IndexType type);
+
         /**
          * @brief Wrap existing OpenGL vertex array object
          * @param id            OpenGL vertex array ID
@@ -493,7 +554,9 @@ class MAGNUM_EXPORT Mesh: public AbstractObject {
          * If @extension{ARB,vertex_array_object} (part of OpenGL 3.0), OpenGL
          * ES 3.0, WebGL 2.0, @extension{OES,vertex_array_object} in OpenGL
          * ES 2.0 or @webgl_extension{OES,vertex_array_object} in WebGL 1.0 is
-         * available, associated vertex array object is deleted.
+         * available, associated vertex array object is deleted. If
+         * @ref Context::setDeletionDeferred() "deferred deletion" is
+         * enabled, the object is only queued for deletion.
          * @see @ref wrap(), @ref release(), @fn_gl{DeleteVertexArrays}
          */
         ~Mesh();
@@ -794,6 +857,61 @@ class MAGNUM_EXPORT Mesh: public AbstractObject {
             return *this;
         }
 
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        /**
+         * @brief Vertex format
+         *
+         * If no format is set, returns `nullptr`.
+         * @see @ref setVertexFormat()
+         * @requires_gles30 Not available in OpenGL ES 2.0.
+         * @requires_webgl20 Not available in WebGL.
+         */
+        VertexFormat* vertexFormat() const { return _vertexFormat; }
+
+        /**
+         * @brief Set vertex format
+         * @return Reference to self (for method chaining)
+         *
+         * Sets vertex attribute layout shared with other meshes, the buffers
+         * are then specified using @ref setVertexBuffer(). The format must
+         * be kept alive for as long as the mesh uses it. Mixing the format
+         * with attributes added using @ref addVertexBuffer() is not
+         * supported. Expects that the format is set before any vertex buffer.
+         *
+         * If @extension{ARB,vertex_attrib_binding} (part of OpenGL 4.3) or
+         * OpenGL ES 3.1 is available, the mesh is drawn with a vertex array
+         * object shared by all meshes using @p format and its own VAO is not
+         * used. Otherwise the format is expanded into per-mesh attribute
+         * specification in @ref setVertexBuffer().
+         * @requires_gles30 Not available in OpenGL ES 2.0.
+         * @requires_webgl20 Not available in WebGL.
+         */
+        Mesh& setVertexFormat(VertexFormat& format);
+
+        /**
+         * @brief Set vertex buffer for given format binding
+         * @param binding       Binding index in the vertex format
+         * @param buffer        Buffer with vertex data
+         * @param offset        Offset of first vertex in the buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that vertex format is set and @p binding is less than
+         * @ref VertexFormat::bindingCount(). Stride and divisor are taken
+         * from the format. The buffer must be kept alive for as long as the
+         * mesh uses it.
+         *
+         * If @extension{ARB,vertex_attrib_binding} (part of OpenGL 4.3) or
+         * OpenGL ES 3.1 is available, only the buffer and offset are
+         * remembered and bound with @fn_gl{BindVertexBuffer} in @ref draw()
+         * if they differ from the previously drawn mesh using the same
+         * format. Otherwise the binding is expanded into calls equivalent to
+         * @ref addVertexBuffer().
+         * @requires_gles30 Not available in OpenGL ES 2.0.
+         * @requires_webgl20 Not available in WebGL.
+         */
+        Mesh& setVertexBuffer(UnsignedInt binding, Buffer& buffer, GLintptr offset);
+        #endif
+
         /**
          * @brief Set index buffer
          * @param buffer        Index buffer
@@ -919,6 +1037,47 @@ class MAGNUM_EXPORT Mesh: public AbstractObject {
         void draw(AbstractShaderProgram&& shader, TransformFeedback& xfb, UnsignedInt stream = 0) {
             draw(shader, xfb, stream);
         }
+
+        /**
+         * @brief Draw the mesh using commands from indirect buffer
+         * @param shader    Shader to use for drawing
+         * @param buffer    Buffer with @ref DrawArraysIndirectCommand (for
+         *      non-indexed meshes) or @ref DrawElementsIndirectCommand (for
+         *      indexed meshes) structures
+         * @param offset    Offset of the first command in the buffer
+         * @param drawCount Count of commands to execute
+         * @param stride    Distance between two consecutive commands. If `0`,
+         *      the commands are treated as tightly packed.
+         *
+         * Everything set by @ref setCount(), @ref setBaseVertex(),
+         * @ref setInstanceCount(), @ref setBaseInstance() and the index
+         * offset and range passed to @ref setIndexBuffer() is ignored, all
+         * these parameters are taken from the commands. Primitive, attribute
+         * bindings and the index buffer are taken from the mesh. If
+         * @p drawCount is `0`, no draw commands are issued.
+         *
+         * If @extension{ARB,multi_draw_indirect} (part of OpenGL 4.3) is
+         * available, all commands are executed in a single call, otherwise
+         * one @fn_gl{DrawArraysIndirect} / @fn_gl{DrawElementsIndirect} call
+         * is issued per command. If @extension{ARB,vertex_array_object} (part
+         * of OpenGL 3.0) is available, the associated vertex array object is
+         * bound instead of setting up the mesh from scratch.
+         * @see @ref draw(AbstractShaderProgram&),
+         *      @ref MeshView::draw(AbstractShaderProgram&, Containers::ArrayView<const std::reference_wrapper<MeshView>>),
+         *      @fn_gl{UseProgram}, @fn_gl{BindBuffer} with
+         *      @def_gl{DRAW_INDIRECT_BUFFER}, @fn_gl{MultiDrawArraysIndirect}/
+         *      @fn_gl{MultiDrawElementsIndirect} or
+         *      @fn_gl{DrawArraysIndirect}/@fn_gl{DrawElementsIndirect}
+         * @requires_gl40 Extension @extension{ARB,draw_indirect}
+         * @requires_gl Indirect drawing is not available in OpenGL ES or
+         *      WebGL.
+         */
+        void drawIndirect(AbstractShaderProgram& shader, Buffer& buffer, GLintptr offset, Int drawCount, GLsizei stride = 0);
+
+        /** @overload */
+        void drawIndirect(AbstractShaderProgram&& shader, Buffer& buffer, GLintptr offset, Int drawCount, GLsizei stride = 0) {
+            drawIndirect(shader, buffer, offset, drawCount, stride);
+        }
         #endif
 
     private:
@@ -1016,6 +1175,7 @@ class MAGNUM_EXPORT Mesh: public AbstractObject {
 
         #ifndef MAGNUM_TARGET_GLES
         void drawInternal(TransformFeedback& xfb, UnsignedInt stream, Int instanceCount);
+        void drawIndirectInternal(Buffer& buffer, GLintptr offset, Int drawCount, GLsizei stride);
         #endif
 
         void MAGNUM_LOCAL createImplementationDefault();
@@ -1027,6 +1187,10 @@ class MAGNUM_EXPORT Mesh: public AbstractObject {
         void MAGNUM_LOCAL destroyImplementationDefault();
         void MAGNUM_LOCAL destroyImplementationVAO();
 
+        /* Removes the vertex arrays from the state tracker and deletes them,
+           used by the destructor and Context::flushDeletions() */
+        static void MAGNUM_LOCAL deleteInternal(Containers::ArrayView<const GLuint> ids);
+
         void attributePointerInternal(const Buffer& buffer, GLuint location, GLint size, GLenum type, AttributeKind kind, GLintptr offset, GLsizei stride, GLuint divisor);
         void MAGNUM_LOCAL attributePointerInternal(AttributeLayout& attribute);
         void MAGNUM_LOCAL attributePointerImplementationDefault(AttributeLayout& attribute);
@@ -1050,12 +1214,23 @@ class MAGNUM_EXPORT Mesh: public AbstractObject {
         void MAGNUM_LOCAL bindIndexBufferImplementationDefault(Buffer&);
         void MAGNUM_LOCAL bindIndexBufferImplementationVAO(Buffer& buffer);
 
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        void MAGNUM_LOCAL vertexBufferImplementationFallback(UnsignedInt binding, Buffer& buffer, GLintptr offset);
+        void MAGNUM_LOCAL vertexBufferImplementationVertexAttribBinding(UnsignedInt binding, Buffer& buffer, GLintptr offset);
+        void MAGNUM_LOCAL bindVertexFormat();
+        #endif
+
         void MAGNUM_LOCAL bindImplementationDefault();
         void MAGNUM_LOCAL bindImplementationVAO();
 
         void MAGNUM_LOCAL unbindImplementationDefault();
         void MAGNUM_LOCAL unbindImplementationVAO();
 
+        #ifndef MAGNUM_TARGET_GLES
+        void MAGNUM_LOCAL multiDrawIndirectImplementationDefault(GLintptr offset, GLsizei drawCount, GLsizei stride);
+        void MAGNUM_LOCAL multiDrawIndirectImplementationFallback(GLintptr offset, GLsizei drawCount, GLsizei stride);
+        #endif
+
         #ifdef MAGNUM_TARGET_GLES2
         void MAGNUM_LOCAL drawArraysInstancedImplementationANGLE(GLint baseVertex, GLsizei count, GLsizei instanceCount);
         #ifndef MAGNUM_TARGET_WEBGL
@@ -1085,6 +1260,10 @@ class MAGNUM_EXPORT Mesh: public AbstractObject {
         Buffer* _indexBuffer;
 
         std::vector<AttributeLayout> _attributes;
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        VertexFormat* _vertexFormat{};
+        std::vector<std::pair<GLuint, GLintptr>> _vertexBuffers;
+        #endif
 };
 
 /** @debugoperatorenum{Magnum::MeshPrimitive} */
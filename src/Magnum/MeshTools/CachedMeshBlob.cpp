@@ -0,0 +1,68 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "CachedMeshBlob.h"
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/MeshTools/MeshBlob.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/AssetCache.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools {
+
+Containers::Array<char> cachedMeshBlob(const std::string& key, const std::function<std::optional<Trade::MeshData3D>()>& produce) {
+    Trade::AssetCache* const cache = Trade::AssetCache::current();
+    if(cache) {
+        Containers::Array<char> data = cache->load(key);
+        if(data) return data;
+    }
+
+    std::optional<Trade::MeshData3D> meshData = produce();
+    if(!meshData) return nullptr;
+
+    Containers::Array<char> data = MeshBlob::serialize(*meshData);
+    if(cache) cache->save(key, data);
+    return data;
+}
+
+Containers::Array<char> cachedMeshBlob(Trade::AbstractImporter& importer, const UnsignedInt id, const std::string& pipeline, const std::function<void(Trade::MeshData3D&)>& process) {
+    const auto produce = [&importer, id, &process]() {
+        std::optional<Trade::MeshData3D> meshData = importer.mesh3D(id);
+        if(meshData) process(*meshData);
+        return meshData;
+    };
+
+    /* No caching if the file wasn't opened with a cache set */
+    if(importer.cacheKey().empty()) {
+        std::optional<Trade::MeshData3D> meshData = produce();
+        return meshData ? MeshBlob::serialize(*meshData) : nullptr;
+    }
+
+    return cachedMeshBlob(Trade::AssetCache::key({importer.cacheKey().data(), importer.cacheKey().size()}, "mesh3D/" + std::to_string(id) + '/' + pipeline), produce);
+}
+
+}}
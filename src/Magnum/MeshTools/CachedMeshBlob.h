@@ -0,0 +1,85 @@
+#ifndef Magnum_MeshTools_CachedMeshBlob_h
+#define Magnum_MeshTools_CachedMeshBlob_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::cachedMeshBlob()
+ */
+
+#include <functional>
+#include <string>
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Trade/Trade.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "MagnumExternal/Optional/optional.hpp"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Cached mesh blob
+@param key      Cache key, see @ref Trade::AssetCache::key()
+@param produce  Function producing the mesh data
+
+If @ref Trade::AssetCache::current() is set and contains an entry for @p key,
+returns it. Otherwise calls @p produce, serializes its output using
+@ref MeshBlob::serialize() and saves it to the cache, if there is any. Returns
+empty array if @p produce returned @ref std::nullopt. The returned data can be
+passed to @ref MeshBlob::open(). Note that only the data stored by
+@ref MeshBlob survive the round trip.
+@see @ref cachedMeshBlob(Trade::AbstractImporter&, UnsignedInt, const std::string&, const std::function<void(Trade::MeshData3D&)>&)
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<char> cachedMeshBlob(const std::string& key, const std::function<std::optional<Trade::MeshData3D>()>& produce);
+
+/**
+@brief Cached mesh blob of an imported mesh
+@param importer Importer with an opened file
+@param id       Mesh ID, from range [0, @ref Trade::AbstractImporter::mesh3DCount()).
+@param pipeline Name uniquely describing the processing done in @p process
+@param process  Function processing the imported mesh data
+
+Imports given mesh, processes it with @p process and returns it serialized
+using @ref MeshBlob::serialize(). If @ref Trade::AssetCache::current() is set,
+the result is keyed by @ref Trade::AbstractImporter::cacheKey(), @p id and
+@p pipeline, so on a cache hit neither the import nor the processing is done.
+Returns empty array if the import failed. Example:
+@code
+importer->openFile("level.obj");
+Containers::Array<char> data = MeshTools::cachedMeshBlob(*importer, 0, "dedup-tipsify",
+    [](Trade::MeshData3D& meshData) {
+        meshData.indices() = MeshTools::duplicate(meshData.indices(),
+            MeshTools::removeDuplicates(meshData.positions(0)));
+        MeshTools::tipsify(meshData.indices(), meshData.positions(0).size(), 24);
+    });
+std::optional<MeshTools::MeshBlob> blob = MeshTools::MeshBlob::open(data);
+@endcode
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<char> cachedMeshBlob(Trade::AbstractImporter& importer, UnsignedInt id, const std::string& pipeline, const std::function<void(Trade::MeshData3D&)>& process);
+
+}}
+
+#endif
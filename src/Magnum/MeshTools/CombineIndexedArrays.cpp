@@ -25,10 +25,8 @@
 
 #include "CombineIndexedArrays.h"
 
-#include <cstring>
-#include <unordered_map>
+#include <cstdint>
 #include <Corrade/Utility/Assert.h>
-#include <Corrade/Utility/MurmurHash2.h>
 
 #include "Magnum/Magnum.h"
 
@@ -87,31 +85,69 @@ std::vector<UnsignedInt> combineIndexArrays(const std::reference_wrapper<std::ve
 
 namespace {
 
-class IndexHash {
-    public:
-        explicit IndexHash(const std::vector<UnsignedInt>& indices, UnsignedInt stride): indices(indices), stride(stride) {}
-
-        std::size_t operator()(UnsignedInt key) const {
-            return *reinterpret_cast<const std::size_t*>(Utility::MurmurHash2()(reinterpret_cast<const char*>(indices.data()+key*stride), sizeof(UnsignedInt)*stride).byteArray());
-        }
+/* Indices are mostly small and sequential, so each is mixed in with a
+   multiplication to spread the tuples over the whole table */
+inline std::size_t hashIndexTuple(const UnsignedInt* const tuple, const UnsignedInt stride) {
+    std::uint64_t hash = 0;
+    for(UnsignedInt i = 0; i != stride; ++i)
+        hash = (hash ^ tuple[i])*0x9e3779b97f4a7c15ull;
+    return std::size_t(hash ^ (hash >> 32));
+}
 
-    private:
-        const std::vector<UnsignedInt>& indices;
-        UnsignedInt stride;
-};
+inline bool equalIndexTuple(const UnsignedInt* const a, const UnsignedInt* const b, const UnsignedInt stride) {
+    for(UnsignedInt i = 0; i != stride; ++i)
+        if(a[i] != b[i]) return false;
+    return true;
+}
 
-class IndexEqual {
-    public:
-        explicit IndexEqual(const std::vector<UnsignedInt>& indices, UnsignedInt stride): indices(indices), stride(stride) {}
+/* If the stride is known at compile time, the hashing and comparison loops
+   get unrolled. Zero means the stride is known only at runtime. */
+template<UnsignedInt fixedStride> std::pair<std::vector<UnsignedInt>, std::vector<UnsignedInt>> combineIndexTuples(const std::vector<UnsignedInt>& interleavedArrays, const UnsignedInt runtimeStride) {
+    const UnsignedInt stride = fixedStride ? fixedStride : runtimeStride;
+    const std::size_t count = interleavedArrays.size()/stride;
+
+    /* Open-addressing hash table with index combinations, containing indices
+       into the output array or ~0 for empty slots. Sized for load factor at
+       most 0.5 as if each combination was unique, so the probe sequences
+       stay short. */
+    std::size_t capacity = 16;
+    while(capacity < count*2) capacity <<= 1;
+    const std::size_t mask = capacity - 1;
+    std::vector<UnsignedInt> table(capacity, ~UnsignedInt{});
 
-        bool operator()(UnsignedInt a, UnsignedInt b) const {
-            return std::memcmp(indices.data()+a*stride, indices.data()+b*stride, sizeof(UnsignedInt)*stride) == 0;
+    /* Make the index combinations unique. Original indices into original
+       `interleavedArrays` array were 0, 1, 2, 3, ..., `combinedIndices`
+       contains new ones into new (shorter) `newInterleavedArrays` array. */
+    std::vector<UnsignedInt> combinedIndices(count);
+    std::vector<UnsignedInt> newInterleavedArrays;
+    UnsignedInt uniqueCount = 0;
+    for(std::size_t oldIndex = 0; oldIndex != count; ++oldIndex) {
+        const UnsignedInt* const tuple = interleavedArrays.data() + oldIndex*stride;
+
+        /* Linear probing until either the same combination or an empty slot
+           is found */
+        std::size_t slot = hashIndexTuple(tuple, stride) & mask;
+        for(;;) {
+            const UnsignedInt index = table[slot];
+            if(index == ~UnsignedInt{}) {
+                /* New combination, copy it to new interleaved arrays */
+                table[slot] = uniqueCount;
+                combinedIndices[oldIndex] = uniqueCount++;
+                newInterleavedArrays.insert(newInterleavedArrays.end(), tuple, tuple + stride);
+                break;
+            }
+
+            if(equalIndexTuple(newInterleavedArrays.data() + std::size_t(index)*stride, tuple, stride)) {
+                combinedIndices[oldIndex] = index;
+                break;
+            }
+
+            slot = (slot + 1) & mask;
         }
+    }
 
-    private:
-        const std::vector<UnsignedInt>& indices;
-        UnsignedInt stride;
-};
+    return {std::move(combinedIndices), std::move(newInterleavedArrays)};
+}
 
 }
 
@@ -119,38 +155,21 @@ std::pair<std::vector<UnsignedInt>, std::vector<UnsignedInt>> combineIndexArrays
     CORRADE_ASSERT(stride != 0, "MeshTools::combineIndexArrays(): stride can't be zero", {});
     CORRADE_ASSERT(interleavedArrays.size() % stride == 0, "MeshTools::combineIndexArrays(): array size is not divisible by stride", {});
 
-    /* Hash map with index combinations, containing just indices into
-       interleavedArrays vector, hashing and comparison is done using IndexHash
-       and IndexEqual functors. Reserving more buckets than necessary (i.e. as
-       if each combination was unique). */
-    std::unordered_map<UnsignedInt, UnsignedInt, IndexHash, IndexEqual> indexCombinations(
-        interleavedArrays.size()/stride,
-        IndexHash(interleavedArrays, stride),
-        IndexEqual(interleavedArrays, stride));
-
-    /* Make the index combinations unique. Original indices into original
-       `interleavedArrays` array were 0, 1, 2, 3, ..., `combinedIndices`
-       contains new ones into new (shorter) `newInterleavedArrays` array. */
-    std::vector<UnsignedInt> combinedIndices;
-    combinedIndices.reserve(interleavedArrays.size()/stride);
-    std::vector<UnsignedInt> newInterleavedArrays;
-    for(std::size_t oldIndex = 0, end = interleavedArrays.size()/stride; oldIndex != end; ++oldIndex) {
-        /* Try to insert new index combination to the map */
-        const auto result = indexCombinations.emplace(oldIndex, indexCombinations.size());
-
-        /* Add the (either new or already existing) index to resulting index array */
-        combinedIndices.push_back(result.first->second);
-
-        /* If this is new combination, copy it to new interleaved arrays */
-        if(result.second) newInterleavedArrays.insert(newInterleavedArrays.end(),
-            interleavedArrays.begin()+oldIndex*stride,
-            interleavedArrays.begin()+(oldIndex+1)*stride);
+    /* Specializations for the most common cases -- positions with normals
+       and/or texture coordinates */
+    std::pair<std::vector<UnsignedInt>, std::vector<UnsignedInt>> out;
+    switch(stride) {
+        case 1: out = combineIndexTuples<1>(interleavedArrays, stride); break;
+        case 2: out = combineIndexTuples<2>(interleavedArrays, stride); break;
+        case 3: out = combineIndexTuples<3>(interleavedArrays, stride); break;
+        case 4: out = combineIndexTuples<4>(interleavedArrays, stride); break;
+        default: out = combineIndexTuples<0>(interleavedArrays, stride);
     }
 
-    CORRADE_INTERNAL_ASSERT(combinedIndices.size() == interleavedArrays.size()/stride &&
-                            newInterleavedArrays.size() <= interleavedArrays.size());
+    CORRADE_INTERNAL_ASSERT(out.first.size() == interleavedArrays.size()/stride &&
+                            out.second.size() <= interleavedArrays.size());
 
-    return {std::move(combinedIndices), std::move(newInterleavedArrays)};
+    return out;
 }
 
 }}
@@ -113,6 +113,10 @@ And second pair value is the cleaned up interleaved array:
 
     0 1 2 3 5 4 0 4 1 6 3 1 2 1
 
+The combinations are made unique using an open-addressing hash table, the
+operation is done in @f$ \mathcal{O}(n) @f$ time and memory, with
+specialized code paths for strides up to 4.
+
 @see @ref combineIndexedArrays()
 */
 MAGNUM_MESHTOOLS_EXPORT std::pair<std::vector<UnsignedInt>, std::vector<UnsignedInt>> combineIndexArrays(const std::vector<UnsignedInt>& interleavedArrays, UnsignedInt stride);
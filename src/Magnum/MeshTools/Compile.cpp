@@ -25,10 +25,14 @@
 
 #include "Compile.h"
 
+#include <algorithm>
+
 #include "Magnum/Buffer.h"
 #include "Magnum/Math/Vector3.h"
 #include "Magnum/MeshTools/CompressIndices.h"
 #include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/MeshTools/Quantize.h"
+#include "Magnum/Trade/MeshData.h"
 #include "Magnum/Trade/MeshData2D.h"
 #include "Magnum/Trade/MeshData3D.h"
 
@@ -38,6 +42,86 @@
 
 namespace Magnum { namespace MeshTools {
 
+namespace {
+
+/* Fills index buffer and configures indexed mesh, if indexed, otherwise sets
+   vertex count */
+template<class MeshData> std::unique_ptr<Buffer> compileIndices(Mesh& mesh, const MeshData& meshData, const std::size_t vertexCount, const BufferUsage usage) {
+    std::unique_ptr<Buffer> indexBuffer;
+    if(meshData.isIndexed()) {
+        const std::vector<UnsignedInt>& indices = meshData.indices();
+        Containers::Array<char> indexData;
+        Mesh::IndexType indexType;
+        UnsignedInt indexStart, indexEnd;
+        std::tie(indexData, indexType, indexStart, indexEnd) = MeshTools::compressIndices(indices);
+
+        indexBuffer.reset(new Buffer{Buffer::TargetHint::ElementArray});
+        indexBuffer->setData(indexData, usage);
+        mesh.setCount(indices.size())
+            .setIndexBuffer(*indexBuffer, 0, indexType, indexStart, indexEnd);
+    } else mesh.setCount(vertexCount);
+
+    return indexBuffer;
+}
+
+bool isNormalizedRange(const std::vector<Vector2>& textureCoordinates) {
+    for(const Vector2& textureCoordinate: textureCoordinates)
+        if(textureCoordinate.x() < 0.0f || textureCoordinate.x() > 1.0f ||
+           textureCoordinate.y() < 0.0f || textureCoordinate.y() > 1.0f)
+            return false;
+    return true;
+}
+
+/* Interleaves texture coordinates at given offset and binds them */
+template<class Attribute> void compileTextureCoordinates(Mesh& mesh, Buffer& vertexBuffer, Containers::Array<char>& data, const std::vector<Vector2>& textureCoordinates, const bool quantize, const UnsignedInt offset, const UnsignedInt stride) {
+    if(quantize) {
+        MeshTools::interleaveInto(data, offset,
+            quantizeTextureCoordinates(textureCoordinates),
+            stride - offset - sizeof(Math::Vector2<UnsignedShort>));
+        mesh.addVertexBuffer(vertexBuffer, 0, offset,
+            Attribute{Attribute::Components::Two, Attribute::DataType::UnsignedShort, Attribute::DataOption::Normalized},
+            stride - offset - sizeof(Math::Vector2<UnsignedShort>));
+    } else {
+        MeshTools::interleaveInto(data, offset,
+            textureCoordinates,
+            stride - offset - sizeof(Vector2));
+        mesh.addVertexBuffer(vertexBuffer, 0, offset,
+            Attribute{},
+            stride - offset - sizeof(Vector2));
+    }
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+/* Joint indices packed to 16 bits followed by float weights */
+constexpr UnsignedInt JointsSize = sizeof(Math::Vector4<UnsignedShort>) + sizeof(Vector4);
+
+/* Interleaves joint indices and weights at given offset and binds them */
+void compileJoints(Mesh& mesh, Buffer& vertexBuffer, Containers::Array<char>& data, const Trade::MeshData3D& meshData, const UnsignedInt offset, const UnsignedInt stride) {
+    const std::vector<Vector4ui>& jointIds = meshData.jointIds(0);
+    std::vector<Math::Vector4<UnsignedShort>> packedJointIds;
+    packedJointIds.reserve(jointIds.size());
+    for(const Vector4ui& id: jointIds) {
+        CORRADE_ASSERT(id.max() <= 65535,
+            "MeshTools::compile(): joint index" << id.max() << "doesn't fit into 16 bits", );
+        packedJointIds.emplace_back(id);
+    }
+
+    const UnsignedInt weightsOffset = offset + sizeof(Math::Vector4<UnsignedShort>);
+    MeshTools::interleaveInto(data, offset, packedJointIds,
+        stride - weightsOffset);
+    mesh.addVertexBuffer(vertexBuffer, 0, offset,
+        Shaders::Generic3D::JointIds{Shaders::Generic3D::JointIds::Components::Four, Shaders::Generic3D::JointIds::DataType::UnsignedShort},
+        stride - weightsOffset);
+    MeshTools::interleaveInto(data, weightsOffset, meshData.jointWeights(0),
+        stride - weightsOffset - sizeof(Vector4));
+    mesh.addVertexBuffer(vertexBuffer, 0, weightsOffset,
+        Shaders::Generic3D::JointWeights{},
+        stride - weightsOffset - sizeof(Vector4));
+}
+#endif
+
+}
+
 std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>> compile(const Trade::MeshData2D& meshData, const BufferUsage usage) {
     Mesh mesh;
     mesh.setPrimitive(meshData.primitive());
@@ -93,6 +177,52 @@ std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>> compile(const
     return std::make_tuple(std::move(mesh), std::move(vertexBuffer), std::move(indexBuffer));
 }
 
+std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>, Matrix3> compile(const Trade::MeshData2D& meshData, const BufferUsage usage, const CompileFlags flags) {
+    Mesh mesh;
+    mesh.setPrimitive(meshData.primitive());
+
+    const std::vector<Vector2>& positions = meshData.positions(0);
+    const bool quantizePositions = !!(flags & CompileFlag::QuantizePositions);
+    const bool quantizeTextureCoordinates = meshData.hasTextureCoords2D() &&
+        (flags & CompileFlag::QuantizeTextureCoordinates) &&
+        isNormalizedRange(meshData.textureCoords2D(0));
+
+    /* Decide about stride and offsets */
+    const UnsignedInt positionSize = quantizePositions ? sizeof(Math::Vector2<Short>) : sizeof(Vector2);
+    UnsignedInt stride = positionSize;
+    if(meshData.hasTextureCoords2D())
+        stride += quantizeTextureCoordinates ? sizeof(Math::Vector2<UnsignedShort>) : sizeof(Vector2);
+
+    std::unique_ptr<Buffer> vertexBuffer{new Buffer{Buffer::TargetHint::Array}};
+    Containers::Array<char> data{Containers::ValueInit, stride*positions.size()};
+
+    /* Positions */
+    Matrix3 dequantization;
+    if(quantizePositions) {
+        std::vector<Math::Vector2<Short>> quantized;
+        std::tie(quantized, dequantization) = MeshTools::quantizePositions(positions);
+        MeshTools::interleaveInto(data, quantized, stride - positionSize);
+        mesh.addVertexBuffer(*vertexBuffer, 0,
+            Shaders::Generic2D::Position{Shaders::Generic2D::Position::Components::Two, Shaders::Generic2D::Position::DataType::Short, Shaders::Generic2D::Position::DataOption::Normalized},
+            stride - positionSize);
+    } else {
+        MeshTools::interleaveInto(data, positions, stride - positionSize);
+        mesh.addVertexBuffer(*vertexBuffer, 0,
+            Shaders::Generic2D::Position(),
+            stride - positionSize);
+    }
+
+    /* Texture coordinates, if present */
+    if(meshData.hasTextureCoords2D())
+        compileTextureCoordinates<Shaders::Generic2D::TextureCoordinates>(mesh, *vertexBuffer, data, meshData.textureCoords2D(0), quantizeTextureCoordinates, positionSize, stride);
+
+    vertexBuffer->setData(data, usage);
+
+    std::unique_ptr<Buffer> indexBuffer = compileIndices(mesh, meshData, positions.size(), usage);
+
+    return std::make_tuple(std::move(mesh), std::move(vertexBuffer), std::move(indexBuffer), dequantization);
+}
+
 std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>> compile(const Trade::MeshData3D& meshData, const BufferUsage usage) {
     Mesh mesh;
     mesh.setPrimitive(meshData.primitive());
@@ -107,6 +237,10 @@ std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>> compile(const
     }
     if(meshData.hasTextureCoords2D())
         stride += sizeof(Shaders::Generic3D::TextureCoordinates::Type);
+    #ifndef MAGNUM_TARGET_GLES2
+    const UnsignedInt jointsOffset = stride;
+    if(meshData.hasJoints()) stride += JointsSize;
+    #endif
 
     /* Create vertex buffer */
     std::unique_ptr<Buffer> vertexBuffer{new Buffer{Buffer::TargetHint::Array}};
@@ -143,6 +277,12 @@ std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>> compile(const
             stride - textureCoordsOffset - sizeof(Shaders::Generic3D::TextureCoordinates::Type));
     }
 
+    /* Add also joints, if present */
+    #ifndef MAGNUM_TARGET_GLES2
+    if(meshData.hasJoints())
+        compileJoints(mesh, *vertexBuffer, data, meshData, jointsOffset, stride);
+    #endif
+
     /* Fill vertex buffer with interleaved data */
     vertexBuffer->setData(data, usage);
 
@@ -165,4 +305,162 @@ std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>> compile(const
     return std::make_tuple(std::move(mesh), std::move(vertexBuffer), std::move(indexBuffer));
 }
 
+std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>, Matrix4> compile(const Trade::MeshData3D& meshData, const BufferUsage usage, const CompileFlags flags) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(flags & CompileFlag::QuantizeNormals) || !(flags & CompileFlag::OctahedralNormals),
+        "MeshTools::compile(): packed and octahedral normals can't be used together",
+        std::make_tuple(Mesh{}, std::unique_ptr<Buffer>{}, std::unique_ptr<Buffer>{}, Matrix4{}));
+    #endif
+
+    Mesh mesh;
+    mesh.setPrimitive(meshData.primitive());
+
+    const std::vector<Vector3>& positions = meshData.positions(0);
+    const bool quantizePositions = !!(flags & CompileFlag::QuantizePositions);
+    const bool quantizeTextureCoordinates = meshData.hasTextureCoords2D() &&
+        (flags & CompileFlag::QuantizeTextureCoordinates) &&
+        isNormalizedRange(meshData.textureCoords2D(0));
+
+    /* Decide about stride and offsets. Quantized positions are padded to
+       keep the following attributes four-byte aligned. */
+    const UnsignedInt positionSize = quantizePositions ? sizeof(Math::Vector3<Short>) : sizeof(Vector3);
+    const UnsignedInt normalOffset = quantizePositions ? sizeof(Math::Vector4<Short>) : sizeof(Vector3);
+    UnsignedInt normalSize = 0;
+    if(meshData.hasNormals()) {
+        if(flags & CompileFlag::OctahedralNormals)
+            normalSize = sizeof(Math::Vector2<Short>);
+        #ifndef MAGNUM_TARGET_GLES2
+        else if(flags & CompileFlag::QuantizeNormals)
+            normalSize = sizeof(UnsignedInt);
+        #endif
+        else normalSize = sizeof(Vector3);
+    }
+    const UnsignedInt textureCoordsOffset = normalOffset + normalSize;
+    UnsignedInt stride = textureCoordsOffset;
+    if(meshData.hasTextureCoords2D())
+        stride += quantizeTextureCoordinates ? sizeof(Math::Vector2<UnsignedShort>) : sizeof(Vector2);
+    #ifndef MAGNUM_TARGET_GLES2
+    const UnsignedInt jointsOffset = stride;
+    if(meshData.hasJoints()) stride += JointsSize;
+    #endif
+
+    std::unique_ptr<Buffer> vertexBuffer{new Buffer{Buffer::TargetHint::Array}};
+    Containers::Array<char> data{Containers::ValueInit, stride*positions.size()};
+
+    /* Positions */
+    Matrix4 dequantization;
+    if(quantizePositions) {
+        std::vector<Math::Vector3<Short>> quantized;
+        std::tie(quantized, dequantization) = MeshTools::quantizePositions(positions);
+        MeshTools::interleaveInto(data, quantized, stride - positionSize);
+        mesh.addVertexBuffer(*vertexBuffer, 0,
+            Shaders::Generic3D::Position{Shaders::Generic3D::Position::Components::Three, Shaders::Generic3D::Position::DataType::Short, Shaders::Generic3D::Position::DataOption::Normalized},
+            stride - positionSize);
+    } else {
+        MeshTools::interleaveInto(data, positions, stride - positionSize);
+        mesh.addVertexBuffer(*vertexBuffer, 0,
+            Shaders::Generic3D::Position(),
+            stride - positionSize);
+    }
+
+    /* Normals, if present */
+    if(meshData.hasNormals()) {
+        const UnsignedInt gap = stride - normalOffset - normalSize;
+        if(flags & CompileFlag::OctahedralNormals) {
+            MeshTools::interleaveInto(data, normalOffset,
+                quantizeNormalsOctahedral(meshData.normals(0)), gap);
+            mesh.addVertexBuffer(*vertexBuffer, 0, normalOffset,
+                Shaders::Generic3D::OctahedralNormal{Shaders::Generic3D::OctahedralNormal::Components::Two, Shaders::Generic3D::OctahedralNormal::DataType::Short, Shaders::Generic3D::OctahedralNormal::DataOption::Normalized},
+                gap);
+        }
+        #ifndef MAGNUM_TARGET_GLES2
+        else if(flags & CompileFlag::QuantizeNormals) {
+            MeshTools::interleaveInto(data, normalOffset,
+                quantizeNormalsPacked(meshData.normals(0)), gap);
+            mesh.addVertexBuffer(*vertexBuffer, 0, normalOffset,
+                Shaders::Generic3D::PackedNormal{Shaders::Generic3D::PackedNormal::Components::Four, Shaders::Generic3D::PackedNormal::DataType::Int2101010Rev, Shaders::Generic3D::PackedNormal::DataOption::Normalized},
+                gap);
+        }
+        #endif
+        else {
+            MeshTools::interleaveInto(data, normalOffset,
+                meshData.normals(0), gap);
+            mesh.addVertexBuffer(*vertexBuffer, 0, normalOffset,
+                Shaders::Generic3D::Normal(),
+                gap);
+        }
+    }
+
+    /* Texture coordinates, if present */
+    if(meshData.hasTextureCoords2D())
+        compileTextureCoordinates<Shaders::Generic3D::TextureCoordinates>(mesh, *vertexBuffer, data, meshData.textureCoords2D(0), quantizeTextureCoordinates, textureCoordsOffset, stride);
+
+    /* Joints, if present */
+    #ifndef MAGNUM_TARGET_GLES2
+    if(meshData.hasJoints())
+        compileJoints(mesh, *vertexBuffer, data, meshData, jointsOffset, stride);
+    #endif
+
+    vertexBuffer->setData(data, usage);
+
+    std::unique_ptr<Buffer> indexBuffer = compileIndices(mesh, meshData, positions.size(), usage);
+
+    return std::make_tuple(std::move(mesh), std::move(vertexBuffer), std::move(indexBuffer), dequantization);
+}
+
+std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>> compile(const Trade::MeshData& meshData, const BufferUsage usage) {
+    Mesh mesh;
+    mesh.setPrimitive(meshData.primitive());
+
+    /* Upload all vertex data at once */
+    std::unique_ptr<Buffer> vertexBuffer{new Buffer{Buffer::TargetHint::Array}};
+    vertexBuffer->setData(meshData.vertexData(), usage);
+
+    /* Bind positions, 2D or 3D based on their type */
+    const Int positionId = meshData.attributeFor(Trade::MeshAttribute::Position);
+    if(positionId != -1) {
+        const Trade::MeshAttributeData& position = meshData.attribute(positionId);
+        if(position.type == Trade::MeshAttributeType::Vector2) mesh.addVertexBuffer(*vertexBuffer, position.offset,
+            Shaders::Generic2D::Position(),
+            position.stride - sizeof(Shaders::Generic2D::Position::Type));
+        else if(position.type == Trade::MeshAttributeType::Vector3) mesh.addVertexBuffer(*vertexBuffer, position.offset,
+            Shaders::Generic3D::Position(),
+            position.stride - sizeof(Shaders::Generic3D::Position::Type));
+    }
+
+    /* Add also normals, if present */
+    const Int normalId = meshData.attributeFor(Trade::MeshAttribute::Normal);
+    if(normalId != -1 && meshData.attribute(normalId).type == Trade::MeshAttributeType::Vector3) {
+        const Trade::MeshAttributeData& normal = meshData.attribute(normalId);
+        mesh.addVertexBuffer(*vertexBuffer, normal.offset,
+            Shaders::Generic3D::Normal(),
+            normal.stride - sizeof(Shaders::Generic3D::Normal::Type));
+    }
+
+    /* Add also texture coordinates, if present */
+    const Int textureCoordsId = meshData.attributeFor(Trade::MeshAttribute::TextureCoordinates);
+    if(textureCoordsId != -1 && meshData.attribute(textureCoordsId).type == Trade::MeshAttributeType::Vector2) {
+        const Trade::MeshAttributeData& textureCoords = meshData.attribute(textureCoordsId);
+        mesh.addVertexBuffer(*vertexBuffer, textureCoords.offset,
+            Shaders::Generic3D::TextureCoordinates(),
+            textureCoords.stride - sizeof(Shaders::Generic3D::TextureCoordinates::Type));
+    }
+
+    /* If indexed, fill index buffer and configure indexed mesh */
+    std::unique_ptr<Buffer> indexBuffer;
+    if(meshData.isIndexed()) {
+        const std::vector<UnsignedInt> indices = meshData.indices();
+        const auto minmax = std::minmax_element(indices.begin(), indices.end());
+
+        indexBuffer.reset(new Buffer{Buffer::TargetHint::ElementArray});
+        indexBuffer->setData(meshData.indexData(), usage);
+        mesh.setCount(meshData.indexCount())
+            .setIndexBuffer(*indexBuffer, 0, meshData.indexType(), *minmax.first, *minmax.second);
+
+    /* Else set vertex count */
+    } else mesh.setCount(meshData.vertexCount());
+
+    return std::make_tuple(std::move(mesh), std::move(vertexBuffer), std::move(indexBuffer));
+}
+
 }}
@@ -26,18 +26,77 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::compile()
+ * @brief Function @ref Magnum::MeshTools::compile(), enum @ref Magnum::MeshTools::CompileFlag, enum set @ref Magnum::MeshTools::CompileFlags
  */
 
 #include <tuple>
 #include <memory>
+#include <Corrade/Containers/EnumSet.h>
 
 #include "Magnum/Magnum.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
 #include "Magnum/Trade/Trade.h"
 #include "Magnum/MeshTools/visibility.h"
 
 namespace Magnum { namespace MeshTools {
 
+/**
+@brief Mesh compilation flag
+
+@see @ref CompileFlags, @ref compile(const Trade::MeshData2D&, BufferUsage, CompileFlags),
+    @ref compile(const Trade::MeshData3D&, BufferUsage, CompileFlags)
+*/
+enum class CompileFlag: UnsignedByte {
+    /**
+     * Quantize positions to normalized 16-bit integers using
+     * @ref quantizePositions(). The dequantization matrix is returned
+     * together with the mesh.
+     */
+    QuantizePositions = 1 << 0,
+
+    #if !defined(MAGNUM_TARGET_GLES2) || defined(DOXYGEN_GENERATING_OUTPUT)
+    /**
+     * Quantize normals to packed 10.10.10.2 integers using
+     * @ref quantizeNormalsPacked() and bind them to
+     * @ref Shaders::Generic3D::PackedNormal. Works with all shaders without
+     * any changes. Can't be used together with
+     * @ref CompileFlag::OctahedralNormals.
+     * @requires_gl33 Extension @extension{ARB,vertex_type_2_10_10_10_rev}
+     * @requires_gles30 Packed attributes are not available in OpenGL ES
+     *      2.0.
+     * @requires_webgl20 Packed attributes are not available in WebGL 1.0.
+     */
+    QuantizeNormals = 1 << 1,
+    #endif
+
+    /**
+     * Quantize normals to octahedral 2x16-bit representation using
+     * @ref quantizeNormalsOctahedral() and bind them to
+     * @ref Shaders::Generic3D::OctahedralNormal. The shader has to decode
+     * them, see for example @ref Shaders::Phong::Flag::OctahedralNormal.
+     */
+    OctahedralNormals = 1 << 2,
+
+    /**
+     * Quantize texture coordinates to normalized 16-bit integers using
+     * @ref quantizeTextureCoordinates(). Done only if all texture
+     * coordinates are in the @f$ [0, 1] @f$ range, otherwise they are kept
+     * as floats.
+     */
+    QuantizeTextureCoordinates = 1 << 3
+};
+
+/**
+@brief Mesh compilation flags
+
+@see @ref compile(const Trade::MeshData2D&, BufferUsage, CompileFlags),
+    @ref compile(const Trade::MeshData3D&, BufferUsage, CompileFlags)
+*/
+typedef Containers::EnumSet<CompileFlag> CompileFlags;
+
+CORRADE_ENUMSET_OPERATORS(CompileFlags)
+
 /**
 @brief Compile 2D mesh data
 
@@ -59,6 +118,20 @@ greater flexibility.
 */
 MAGNUM_MESHTOOLS_EXPORT std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>> compile(const Trade::MeshData2D& meshData, BufferUsage usage);
 
+/**
+@brief Compile 2D mesh data with quantized attributes
+@return Mesh, vertex buffer, index buffer and position dequantization matrix
+
+Like @ref compile(const Trade::MeshData2D&, BufferUsage), but the attributes
+are quantized according to @p flags. With
+@ref CompileFlag::QuantizePositions a position takes four bytes instead of
+eight and the returned matrix has to be multiplied to the transformation
+matrix on the right. Otherwise the returned matrix is identity.
+@ref CompileFlag::QuantizeTextureCoordinates halves the texture coordinate
+size as well. Normal quantization flags are ignored.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>, Matrix3> compile(const Trade::MeshData2D& meshData, BufferUsage usage, CompileFlags flags);
+
 /**
 @brief Compile 3D mesh data
 
@@ -66,8 +139,12 @@ Configures mesh for @ref Shaders::Generic3D shader with vertex buffer and
 possibly also index buffer, if the mesh is indexed. Positions are bound to
 @ref Shaders::Generic3D::Position attribute. If the mesh contains normals, they
 are bound to @ref Shaders::Generic3D::Normal attribute, texture coordinates are
-bound to @ref Shaders::Generic2D::TextureCoordinates attribute. No data
-compression or index optimization (except for index buffer packing) is done.
+bound to @ref Shaders::Generic2D::TextureCoordinates attribute. Joint indices,
+if present, are packed to 16-bit integers and bound to
+@ref Shaders::Generic3D::JointIds together with
+@ref Shaders::Generic3D::JointWeights; this is not done on OpenGL ES 2.0 and
+WebGL 1.0. No data compression or index optimization (except for index buffer
+packing) is done.
 The @p usage parameter is used for both vertex and index buffer.
 
 The second returned buffer may be `nullptr` if the mesh is not indexed.
@@ -80,6 +157,58 @@ greater flexibility.
 */
 MAGNUM_MESHTOOLS_EXPORT std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>> compile(const Trade::MeshData3D& meshData, BufferUsage usage);
 
+/**
+@brief Compile 3D mesh data with quantized attributes
+@return Mesh, vertex buffer, index buffer and position dequantization matrix
+
+Like @ref compile(const Trade::MeshData3D&, BufferUsage), but the attributes
+are quantized according to @p flags. With all flags enabled, the vertex
+stride goes down from 32 to 16 bytes. With
+@ref CompileFlag::QuantizePositions the returned matrix has to be multiplied
+to the transformation matrix on the right, while the normal matrix is still
+calculated from the original transformation. Otherwise the returned matrix is
+identity. Example usage:
+@code
+Mesh mesh;
+std::unique_ptr<Buffer> vertices, indices;
+Matrix4 dequantization;
+std::tie(mesh, vertices, indices, dequantization) = MeshTools::compile(data, BufferUsage::StaticDraw,
+    MeshTools::CompileFlag::QuantizePositions|MeshTools::CompileFlag::OctahedralNormals);
+
+Shaders::Phong shader{Shaders::Phong::Flag::OctahedralNormal};
+shader.setTransformationMatrix(transformation*dequantization)
+    .setNormalMatrix(transformation.rotationScaling())
+    .setProjectionMatrix(projection);
+mesh.draw(shader);
+@endcode
+
+@see @ref quantizePositions(), @ref quantizeNormalsOctahedral(),
+    @ref quantizeNormalsPacked(), @ref quantizeTextureCoordinates()
+*/
+MAGNUM_MESHTOOLS_EXPORT std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>, Matrix4> compile(const Trade::MeshData3D& meshData, BufferUsage usage, CompileFlags flags);
+
+/**
+@brief Compile interleaved mesh data
+
+Configures mesh for @ref Shaders::Generic2D or @ref Shaders::Generic3D shader.
+Unlike the above, the vertex data are already interleaved, so they are
+uploaded as-is with a single @ref Buffer::setData() call and the attributes
+are bound using offsets and strides from @ref Trade::MeshData::attribute().
+The first @ref Trade::MeshAttribute::Position is bound to either
+@ref Shaders::Generic2D::Position or @ref Shaders::Generic3D::Position based on
+its type, the first @ref Trade::MeshAttribute::Normal to
+@ref Shaders::Generic3D::Normal and the first
+@ref Trade::MeshAttribute::TextureCoordinates to
+@ref Shaders::Generic2D::TextureCoordinates. Other attributes are ignored. The
+index data are uploaded as-is as well, without any compression. The @p usage
+parameter is used for both vertex and index buffer.
+
+The second returned buffer may be `nullptr` if the mesh is not indexed.
+
+@see @ref shaders-generic
+*/
+MAGNUM_MESHTOOLS_EXPORT std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>> compile(const Trade::MeshData& meshData, BufferUsage usage);
+
 }}
 
 #endif
@@ -25,6 +25,8 @@
 
 #include "GenerateFlatNormals.h"
 
+#include <algorithm>
+
 #include "Magnum/Math/Vector3.h"
 #include "Magnum/MeshTools/Duplicate.h"
 #include "Magnum/MeshTools/RemoveDuplicates.h"
@@ -55,4 +57,66 @@ std::tuple<std::vector<UnsignedInt>, std::vector<Vector3>> generateFlatNormals(c
     return std::make_tuple(std::move(normalIndices), std::move(normals));
 }
 
+std::tuple<std::vector<UnsignedInt>, std::vector<Vector3>> generateProvokingFlatNormals(std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::generateProvokingFlatNormals(): index count is not divisible by 3!", (std::tuple<std::vector<UnsignedInt>, std::vector<Vector3>>()));
+
+    /* Face for which given vertex is provoking and which corner of given face
+       is provoking, ~0 if none */
+    const std::size_t faceCount = indices.size()/3;
+    std::vector<UnsignedInt> owner(positions.size(), ~UnsignedInt{});
+    std::vector<UnsignedByte> provoking(faceCount, 0xff);
+    for(std::size_t face = 0; face != faceCount; ++face) {
+        const UnsignedInt* const corners = indices.data() + face*3;
+
+        /* Prefer the last corner, so the index order stays the same where
+           possible */
+        for(Int i: {2, 0, 1}) if(owner[corners[i]] == ~UnsignedInt{}) {
+            owner[corners[i]] = face;
+            provoking[face] = i;
+            break;
+        }
+        if(provoking[face] != 0xff) continue;
+
+        /* All corners are taken, try to move one of the owners to another
+           free corner of its own */
+        for(Int i: {2, 0, 1}) {
+            const UnsignedInt other = owner[corners[i]];
+            const UnsignedInt* const otherCorners = indices.data() + other*3;
+            for(Int j = 0; j != 3; ++j) if(owner[otherCorners[j]] == ~UnsignedInt{}) {
+                owner[otherCorners[j]] = other;
+                provoking[other] = j;
+                owner[corners[i]] = face;
+                provoking[face] = i;
+                break;
+            }
+            if(provoking[face] != 0xff) break;
+        }
+    }
+
+    std::vector<UnsignedInt> vertices(positions.size());
+    for(std::size_t i = 0; i != vertices.size(); ++i) vertices[i] = i;
+    std::vector<Vector3> normals(positions.size());
+    for(std::size_t face = 0; face != faceCount; ++face) {
+        UnsignedInt* const corners = indices.data() + face*3;
+
+        /* Assuming counterclockwise winding */
+        const Vector3 normal = Math::cross(positions[corners[2]]-positions[corners[1]],
+                                           positions[corners[0]]-positions[corners[1]]).normalized();
+
+        /* Rotate the provoking vertex to the end, keeping the winding */
+        if(provoking[face] != 0xff) {
+            std::rotate(corners, corners + provoking[face] + 1, corners + 3);
+            normals[corners[2]] = normal;
+
+        /* Duplicate the last vertex if no corner could be made provoking */
+        } else {
+            vertices.push_back(corners[2]);
+            normals.push_back(normal);
+            corners[2] = vertices.size() - 1;
+        }
+    }
+
+    return std::make_tuple(std::move(vertices), std::move(normals));
+}
+
 }}
@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::generateFlatNormals()
+ * @brief Function @ref Magnum::MeshTools::generateFlatNormals(), @ref Magnum::MeshTools::generateProvokingFlatNormals()
  */
 
 #include <tuple>
@@ -61,6 +61,39 @@ to use the same indices.
 */
 std::tuple<std::vector<UnsignedInt>, std::vector<Vector3>> MAGNUM_MESHTOOLS_EXPORT generateFlatNormals(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions);
 
+/**
+@brief Generate flat normals stored in provoking vertices
+@param[in,out] indices  Array of triangle face indices
+@param[in] positions    Array of vertex positions
+@return Original vertex for each new vertex and normal of each new vertex
+
+Rotates the indices of each face, keeping the winding, so that its last
+(provoking) vertex is not the last vertex of any other face, and stores the
+face normal in it. Vertices that can't be made provoking for any face without
+taking them from another face are duplicated, which for a closed mesh with
+@f$ V @f$ vertices and @f$ F \approx 2V @f$ faces results in roughly
+@f$ F @f$ vertices instead of @f$ 3F @f$ with @ref generateFlatNormals() and
+@ref duplicate(). Vertices that are not provoking for any face get a zero
+normal. Example usage:
+@code
+std::vector<UnsignedInt> indices;
+std::vector<Vector3> positions;
+
+std::vector<UnsignedInt> vertices;
+std::vector<Vector3> normals;
+std::tie(vertices, normals) = MeshTools::generateProvokingFlatNormals(indices, positions);
+positions = MeshTools::duplicate(vertices, positions);
+@endcode
+Other vertex attributes are expanded the same way using @ref duplicate(). The
+normals are meant to be used with @ref Shaders::Phong::Flag::FlatShading or a
+similar shader that doesn't interpolate them, with the default last vertex
+provoking convention.
+
+@attention The function requires the mesh to have triangle faces, thus index
+    count must be divisible by 3.
+*/
+std::tuple<std::vector<UnsignedInt>, std::vector<Vector3>> MAGNUM_MESHTOOLS_EXPORT generateProvokingFlatNormals(std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions);
+
 }}
 
 #endif
@@ -0,0 +1,160 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "GenerateSmoothNormals.h"
+
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/MeshTools/RemoveDuplicates.h"
+#include "Magnum/MeshTools/Implementation/parallelFor.h"
+#include "Magnum/MeshTools/Implementation/vertexCorners.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Calculates weighted face normal contribution for every corner and unit
+   normal for every face (zero for degenerate faces) */
+void faceNormals(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const NormalWeighting weighting, const UnsignedInt threadCount, std::vector<Vector3>& cornerNormals, std::vector<Vector3>& unitNormals) {
+    cornerNormals.resize(indices.size());
+    unitNormals.resize(indices.size()/3);
+    Implementation::parallelFor(indices.size()/3, threadCount, [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t face = begin; face != end; ++face) {
+            const Vector3& a = positions[indices[face*3 + 0]];
+            const Vector3& b = positions[indices[face*3 + 1]];
+            const Vector3& c = positions[indices[face*3 + 2]];
+
+            /* Length of the cross product is twice the face area */
+            const Vector3 normal = Math::cross(b - a, c - a);
+            const Float length = normal.length();
+            if(length == 0.0f) {
+                unitNormals[face] = {};
+                for(std::size_t i = 0; i != 3; ++i) cornerNormals[face*3 + i] = {};
+                continue;
+            }
+
+            const Vector3 unitNormal = normal/length;
+            unitNormals[face] = unitNormal;
+            switch(weighting) {
+                case NormalWeighting::Uniform:
+                    for(std::size_t i = 0; i != 3; ++i)
+                        cornerNormals[face*3 + i] = unitNormal;
+                    break;
+                case NormalWeighting::Area:
+                    for(std::size_t i = 0; i != 3; ++i)
+                        cornerNormals[face*3 + i] = normal;
+                    break;
+                case NormalWeighting::Angle:
+                    cornerNormals[face*3 + 0] = unitNormal*Implementation::cornerAngle(a, b, c);
+                    cornerNormals[face*3 + 1] = unitNormal*Implementation::cornerAngle(b, c, a);
+                    cornerNormals[face*3 + 2] = unitNormal*Implementation::cornerAngle(c, a, b);
+                    break;
+            }
+        }
+    });
+}
+
+}
+
+std::vector<Vector3> generateSmoothNormals(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const NormalWeighting weighting, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::generateSmoothNormals(): index count is not divisible by 3!", {});
+
+    std::vector<Vector3> cornerNormals, unitNormals;
+    faceNormals(indices, positions, weighting, threadCount, cornerNormals, unitNormals);
+
+    std::vector<UnsignedInt> offsets, corners;
+    Implementation::vertexCorners(indices, positions.size(), offsets, corners);
+
+    /* Sum the contributions in a fixed order so the result doesn't depend on
+       the thread count */
+    std::vector<Vector3> normals(positions.size());
+    Implementation::parallelFor(positions.size(), threadCount, [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t vertex = begin; vertex != end; ++vertex) {
+            Vector3 normal;
+            for(std::size_t i = offsets[vertex]; i != offsets[vertex + 1]; ++i)
+                normal += cornerNormals[corners[i]];
+
+            const Float length = normal.length();
+            if(length != 0.0f) normals[vertex] = normal/length;
+        }
+    });
+
+    return normals;
+}
+
+std::tuple<std::vector<UnsignedInt>, std::vector<Vector3>> generateSmoothNormals(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const Rad angleThreshold, const NormalWeighting weighting, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::generateSmoothNormals(): index count is not divisible by 3!", (std::tuple<std::vector<UnsignedInt>, std::vector<Vector3>>()));
+
+    std::vector<Vector3> cornerNormals, unitNormals;
+    faceNormals(indices, positions, weighting, threadCount, cornerNormals, unitNormals);
+
+    std::vector<UnsignedInt> offsets, corners;
+    Implementation::vertexCorners(indices, positions.size(), offsets, corners);
+
+    /* For every corner sum contributions of faces adjacent to the same vertex
+       that are within the threshold. Corners of degenerate faces take all
+       adjacent faces into account. */
+    const Float cosThreshold = Math::cos(angleThreshold);
+    std::vector<Vector3> normals(indices.size());
+    Implementation::parallelFor(indices.size(), threadCount, [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t corner = begin; corner != end; ++corner) {
+            const UnsignedInt vertex = indices[corner];
+            const Vector3& faceNormal = unitNormals[corner/3];
+            const bool degenerate = faceNormal.isZero();
+
+            Vector3 normal;
+            for(std::size_t i = offsets[vertex]; i != offsets[vertex + 1]; ++i) {
+                const UnsignedInt other = corners[i];
+                if(degenerate || Math::dot(faceNormal, unitNormals[other/3]) >= cosThreshold)
+                    normal += cornerNormals[other];
+            }
+
+            const Float length = normal.length();
+            if(length != 0.0f) normals[corner] = normal/length;
+        }
+    });
+
+    /* Remove duplicate normals and return */
+    std::vector<UnsignedInt> normalIndices = MeshTools::removeDuplicates(normals);
+    return std::make_tuple(std::move(normalIndices), std::move(normals));
+}
+
+Debug& operator<<(Debug& debug, const NormalWeighting value) {
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case NormalWeighting::value: return debug << "MeshTools::NormalWeighting::" #value;
+        _c(Uniform)
+        _c(Area)
+        _c(Angle)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "MeshTools::NormalWeighting(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+}}
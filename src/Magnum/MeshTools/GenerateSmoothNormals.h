@@ -0,0 +1,137 @@
+#ifndef Magnum_MeshTools_GenerateSmoothNormals_h
+#define Magnum_MeshTools_GenerateSmoothNormals_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Enum @ref Magnum::MeshTools::NormalWeighting, function @ref Magnum::MeshTools::generateSmoothNormals()
+ */
+
+#include <tuple>
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Angle.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Normal weighting
+
+Specifies how much each face contributes to normal of a vertex it is adjacent
+to.
+@see @ref generateSmoothNormals()
+*/
+enum class NormalWeighting: UnsignedByte {
+    /** All adjacent faces contribute the same */
+    Uniform,
+
+    /**
+     * Contribution of each face is proportional to its area. Large faces
+     * dominate, small faces resulting from e.g. tessellation of a curved
+     * surface don't skew the result.
+     */
+    Area,
+
+    /**
+     * Contribution of each face is proportional to its angle at given
+     * vertex. The result doesn't depend on how the adjacent surface is
+     * triangulated. This is the weighting used by most modeling tools.
+     */
+    Angle
+};
+
+/** @debugoperatorenum{Magnum::MeshTools::NormalWeighting} */
+MAGNUM_MESHTOOLS_EXPORT Debug& operator<<(Debug& debug, NormalWeighting value);
+
+/**
+@brief Generate smooth normals
+@param indices      Array of triangle face indices
+@param positions    Array of vertex positions
+@param weighting    Face contribution weighting
+@param threadCount  Count of worker threads. If `0`, the count is
+    `std::thread::hardware_concurrency()`.
+@return Normal for each vertex in @p positions
+
+For each vertex sums normals of all adjacent faces, weighted according to
+@p weighting, and normalizes the result. The normals are indexed by
+@p indices as well, so no vertex duplication is needed. Faces are assumed to
+be winded counterclockwise, degenerate faces don't contribute and normal of a
+vertex not referenced by any non-degenerate face is zero. Example usage:
+@code
+std::vector<UnsignedInt> indices;
+std::vector<Vector3> positions;
+std::vector<Vector3> normals = MeshTools::generateSmoothNormals(indices, positions);
+@endcode
+
+The operation is done in @f$ \mathcal{O}(n) @f$ time and memory. Large meshes
+are processed in parallel on @p threadCount threads, the output is independent
+of the thread count. On Emscripten the mesh is processed sequentially.
+
+@attention The function requires the mesh to have triangle faces, thus index
+    count must be divisible by 3.
+
+@see @ref generateFlatNormals(), @ref generateTangents()
+*/
+MAGNUM_MESHTOOLS_EXPORT std::vector<Vector3> generateSmoothNormals(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, NormalWeighting weighting = NormalWeighting::Angle, UnsignedInt threadCount = 0);
+
+/**
+@brief Generate smooth normals with hard edges
+@param indices          Array of triangle face indices
+@param positions        Array of vertex positions
+@param angleThreshold   Maximal angle between two faces for which the edge
+    between them is smoothed
+@param weighting        Face contribution weighting
+@param threadCount      Count of worker threads. If `0`, the count is
+    `std::thread::hardware_concurrency()`.
+@return Normal indices and vectors
+
+Like @ref generateSmoothNormals(const std::vector<UnsignedInt>&, const std::vector<Vector3>&, NormalWeighting, UnsignedInt),
+but normal at each face corner is averaged only from faces adjacent to the
+vertex whose normal differs from normal of given face by at most
+@p angleThreshold. Edges with larger angle stay hard. Because one vertex can
+then have more than one normal, the normals are returned in a separate
+indexed array with duplicates removed, similarly to
+@ref generateFlatNormals():
+@code
+std::vector<UnsignedInt> normalIndices;
+std::vector<Vector3> normals;
+std::tie(normalIndices, normals) = MeshTools::generateSmoothNormals(indices, positions, Deg(60.0f));
+@endcode
+You can then use @ref combineIndexedArrays() to combine normal and vertex array
+to use the same indices.
+
+The operation is done in time proportional to sum of squared vertex valences,
+which is @f$ \mathcal{O}(n) @f$ for meshes with bounded valence.
+
+@attention The function requires the mesh to have triangle faces, thus index
+    count must be divisible by 3.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::tuple<std::vector<UnsignedInt>, std::vector<Vector3>> generateSmoothNormals(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, Rad angleThreshold, NormalWeighting weighting = NormalWeighting::Angle, UnsignedInt threadCount = 0);
+
+}}
+
+#endif
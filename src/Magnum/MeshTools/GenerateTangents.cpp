@@ -0,0 +1,124 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "GenerateTangents.h"
+
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Vector4.h"
+#include "Magnum/MeshTools/Implementation/parallelFor.h"
+#include "Magnum/MeshTools/Implementation/vertexCorners.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Projects the vector to the plane perpendicular to the unit normal */
+inline Vector3 projectToPlane(const Vector3& vector, const Vector3& normal) {
+    return vector - normal*Math::dot(normal, vector);
+}
+
+}
+
+std::vector<Vector4> generateTangents(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const std::vector<Vector3>& normals, const std::vector<Vector2>& textureCoordinates, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::generateTangents(): index count is not divisible by 3!", {});
+    CORRADE_ASSERT(normals.size() == positions.size() && textureCoordinates.size() == positions.size(),
+        "MeshTools::generateTangents(): expected" << positions.size() << "normals and texture coordinates but got" << normals.size() << "and" << textureCoordinates.size(), {});
+
+    /* Angle-weighted tangent and bitangent contribution for every corner,
+       projected to the plane of the corner vertex normal */
+    std::vector<Vector3> cornerTangents(indices.size()), cornerBitangents(indices.size());
+    Implementation::parallelFor(indices.size()/3, threadCount, [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t face = begin; face != end; ++face) {
+            const UnsignedInt* const faceIndices = indices.data() + face*3;
+            const Vector3& a = positions[faceIndices[0]];
+            const Vector2& ta = textureCoordinates[faceIndices[0]];
+            const Vector3 dp1 = positions[faceIndices[1]] - a;
+            const Vector3 dp2 = positions[faceIndices[2]] - a;
+            const Vector2 duv1 = textureCoordinates[faceIndices[1]] - ta;
+            const Vector2 duv2 = textureCoordinates[faceIndices[2]] - ta;
+
+            /* Faces with degenerate texture mapping don't contribute */
+            const Float determinant = Math::cross(duv1, duv2);
+            if(determinant == 0.0f) continue;
+
+            /* Derivatives of the position with respect to U and V */
+            const Vector3 tangent = (dp1*duv2.y() - dp2*duv1.y())/determinant;
+            const Vector3 bitangent = (dp2*duv1.x() - dp1*duv2.x())/determinant;
+
+            for(std::size_t i = 0; i != 3; ++i) {
+                const UnsignedInt vertex = faceIndices[i];
+                const Float angle = Implementation::cornerAngle(positions[vertex],
+                    positions[faceIndices[(i + 1)%3]],
+                    positions[faceIndices[(i + 2)%3]]);
+
+                const Vector3 t = projectToPlane(tangent, normals[vertex]);
+                const Vector3 b = projectToPlane(bitangent, normals[vertex]);
+                const Float tLength = t.length();
+                const Float bLength = b.length();
+                if(tLength != 0.0f) cornerTangents[face*3 + i] = t*(angle/tLength);
+                if(bLength != 0.0f) cornerBitangents[face*3 + i] = b*(angle/bLength);
+            }
+        }
+    });
+
+    std::vector<UnsignedInt> offsets, corners;
+    Implementation::vertexCorners(indices, positions.size(), offsets, corners);
+
+    /* Sum the contributions in a fixed order so the result doesn't depend on
+       the thread count, orthogonalize and calculate handedness */
+    std::vector<Vector4> tangents(positions.size());
+    Implementation::parallelFor(positions.size(), threadCount, [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t vertex = begin; vertex != end; ++vertex) {
+            Vector3 tangent, bitangent;
+            for(std::size_t i = offsets[vertex]; i != offsets[vertex + 1]; ++i) {
+                tangent += cornerTangents[corners[i]];
+                bitangent += cornerBitangents[corners[i]];
+            }
+
+            const Vector3& normal = normals[vertex];
+            tangent = projectToPlane(tangent, normal);
+            Float length = tangent.length();
+
+            /* No texture mapping, pick any direction perpendicular to the
+               normal, starting from the axis least aligned with it */
+            if(length == 0.0f) {
+                const Vector3 absNormal = Math::abs(normal);
+                const Vector3 axis = absNormal.x() <= absNormal.y() && absNormal.x() <= absNormal.z() ? Vector3::xAxis() :
+                    absNormal.y() <= absNormal.z() ? Vector3::yAxis() : Vector3::zAxis();
+                tangent = projectToPlane(axis, normal);
+                length = tangent.length();
+            }
+
+            tangent /= length;
+            tangents[vertex] = {tangent, Math::dot(Math::cross(normal, tangent), bitangent) < 0.0f ? -1.0f : 1.0f};
+        }
+    });
+
+    return tangents;
+}
+
+}}
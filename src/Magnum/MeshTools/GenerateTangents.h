@@ -0,0 +1,84 @@
+#ifndef Magnum_MeshTools_GenerateTangents_h
+#define Magnum_MeshTools_GenerateTangents_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::generateTangents()
+ */
+
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Generate tangents
+@param indices              Array of triangle face indices
+@param positions            Array of vertex positions
+@param normals              Array of vertex normals
+@param textureCoordinates   Array of vertex texture coordinates
+@param threadCount          Count of worker threads. If `0`, the count is
+    `std::thread::hardware_concurrency()`.
+@return Tangent for each vertex
+
+Calculates tangent space for normal mapping. All arrays are indexed by
+@p indices, thus they need to have the same size, which is also the size of
+the returned array. XYZ of each tangent is a unit vector perpendicular to the
+normal and pointing in the direction of increasing U texture coordinate, W is
+either `1.0f` or `-1.0f` and gives handedness of the tangent space. Bitangent
+is calculated in the shader as `cross(normal, tangent.xyz)*tangent.w`.
+@code
+std::vector<UnsignedInt> indices;
+std::vector<Vector3> positions, normals;
+std::vector<Vector2> textureCoordinates;
+std::vector<Vector4> tangents = MeshTools::generateTangents(indices, positions, normals, textureCoordinates);
+@endcode
+
+Follows the conventions of MikkTSpace, which is used by most normal map
+bakers: face tangents and bitangents are projected to the plane of the vertex
+normal, weighted by the corner angle and then orthogonalized against the
+normal. Unlike MikkTSpace the function doesn't split vertices on mirrored
+texture seams --- a vertex shared by faces with opposite texture orientation
+gets one averaged tangent. Split such vertices beforehand if the result should
+match MikkTSpace output exactly. Vertices with no texture mapping get an
+arbitrary tangent perpendicular to the normal.
+
+The operation is done in @f$ \mathcal{O}(n) @f$ time and memory. Large meshes
+are processed in parallel on @p threadCount threads, the output is independent
+of the thread count. On Emscripten the mesh is processed sequentially.
+
+@attention The function requires the mesh to have triangle faces, thus index
+    count must be divisible by 3.
+
+@see @ref generateSmoothNormals()
+*/
+MAGNUM_MESHTOOLS_EXPORT std::vector<Vector4> generateTangents(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const std::vector<Vector3>& normals, const std::vector<Vector2>& textureCoordinates, UnsignedInt threadCount = 0);
+
+}}
+
+#endif
@@ -0,0 +1,125 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "GenerateWireframeCorners.h"
+
+#include <algorithm>
+#include <Corrade/Utility/Assert.h>
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* All possible assignments of corner indices to triangle vertices */
+constexpr UnsignedByte Permutations[6][3]{
+    {0, 1, 2}, {1, 2, 0}, {2, 0, 1},
+    {0, 2, 1}, {2, 1, 0}, {1, 0, 2}
+};
+
+constexpr UnsignedInt Unassigned = ~UnsignedInt{};
+
+}
+
+std::tuple<std::vector<UnsignedInt>, std::vector<UnsignedInt>, std::vector<UnsignedByte>> generateWireframeCorners(const std::vector<UnsignedInt>& indices) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::generateWireframeCorners(): index count is not divisible by 3!", (std::tuple<std::vector<UnsignedInt>, std::vector<UnsignedInt>, std::vector<UnsignedByte>>{}));
+
+    const std::size_t vertexCount = indices.empty() ? 0 : *std::max_element(indices.begin(), indices.end()) + 1;
+    const std::size_t triangleCount = indices.size()/3;
+
+    /* Triangles referencing each vertex, vertex i has them in
+       [vertexTriangleOffsets[i], vertexTriangleOffsets[i + 1]) */
+    std::vector<UnsignedInt> vertexTriangleOffsets(vertexCount + 1);
+    for(const UnsignedInt index: indices) ++vertexTriangleOffsets[index + 1];
+    for(std::size_t i = 0; i != vertexCount; ++i)
+        vertexTriangleOffsets[i + 1] += vertexTriangleOffsets[i];
+    std::vector<UnsignedInt> vertexTriangles(indices.size());
+    {
+        std::vector<UnsignedInt> position{vertexTriangleOffsets.begin(), vertexTriangleOffsets.end() - 1};
+        for(std::size_t i = 0; i != indices.size(); ++i)
+            vertexTriangles[position[indices[i]]++] = i/3;
+    }
+
+    /* ID of a new vertex for every original vertex and corner index */
+    std::vector<UnsignedInt> copies(vertexCount*3, Unassigned);
+
+    std::vector<UnsignedInt> outIndices(indices.size());
+    std::vector<UnsignedInt> vertexIds;
+    std::vector<UnsignedByte> corners;
+    vertexIds.reserve(vertexCount);
+    corners.reserve(vertexCount);
+
+    /* Breadth-first traversal over triangles sharing a vertex, so corner
+       indices already assigned to neighbors constrain the next triangles */
+    std::vector<bool> visited(triangleCount);
+    std::vector<UnsignedInt> queue;
+    queue.reserve(triangleCount);
+    for(std::size_t start = 0; start != triangleCount; ++start) {
+        if(visited[start]) continue;
+        visited[start] = true;
+        queue.push_back(start);
+
+        for(std::size_t next = queue.size() - 1; next != queue.size(); ++next) {
+            const UnsignedInt triangle = queue[next];
+            const UnsignedInt* const vertices = indices.data() + triangle*3;
+
+            /* Pick the assignment reusing the most already existing
+               vertices */
+            std::size_t best = 0, bestScore = 0;
+            for(std::size_t p = 0; p != 6; ++p) {
+                std::size_t score = 0;
+                for(std::size_t i = 0; i != 3; ++i)
+                    if(copies[vertices[i]*3 + Permutations[p][i]] != Unassigned) ++score;
+                if(score > bestScore) {
+                    best = p;
+                    bestScore = score;
+                }
+            }
+
+            for(std::size_t i = 0; i != 3; ++i) {
+                const UnsignedByte corner = Permutations[best][i];
+                UnsignedInt& copy = copies[vertices[i]*3 + corner];
+                if(copy == Unassigned) {
+                    copy = vertexIds.size();
+                    vertexIds.push_back(vertices[i]);
+                    corners.push_back(corner);
+                }
+                outIndices[triangle*3 + i] = copy;
+            }
+
+            for(std::size_t i = 0; i != 3; ++i) {
+                for(UnsignedInt j = vertexTriangleOffsets[vertices[i]]; j != vertexTriangleOffsets[vertices[i] + 1]; ++j) {
+                    const UnsignedInt neighbor = vertexTriangles[j];
+                    if(visited[neighbor]) continue;
+                    visited[neighbor] = true;
+                    queue.push_back(neighbor);
+                }
+            }
+        }
+    }
+
+    return std::make_tuple(std::move(outIndices), std::move(vertexIds), std::move(corners));
+}
+
+}}
@@ -0,0 +1,92 @@
+#ifndef Magnum_MeshTools_GenerateWireframeCorners_h
+#define Magnum_MeshTools_GenerateWireframeCorners_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::generateWireframeCorners()
+ */
+
+#include <tuple>
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Generate triangle corner indices for wireframe rendering
+@param indices      Array of triangle face indices
+@return New index array, original vertex ID for each new vertex and corner
+    index for each new vertex
+
+Assigns each vertex a corner index `0`, `1` or `2` so that all three
+vertices of every triangle have a different one, which is what
+@ref Shaders::MeshVisualizer needs to render wireframe without a geometry
+shader. Vertices shared by triangles that need a different corner index at
+that vertex are duplicated, each vertex at most three times. The triangles
+are processed in order of connectivity to keep the assignment consistent
+between neighbors --- for regular grids and most closed meshes only a small
+fraction of vertices gets duplicated, compared to three vertices per
+triangle of a non-indexed mesh created by @ref duplicate().
+
+Use @ref duplicate() with the second returned array to create the new vertex
+data and upload the corner indices as @ref Shaders::MeshVisualizer::VertexIndex
+attribute:
+@code
+std::vector<UnsignedInt> indices;
+std::vector<Vector3> positions;
+
+std::vector<UnsignedInt> vertexIds;
+std::vector<UnsignedByte> corners;
+std::tie(indices, vertexIds, corners) = MeshTools::generateWireframeCorners(indices);
+positions = MeshTools::duplicate(vertexIds, positions);
+
+Buffer vertices, cornerBuffer, indexBuffer;
+vertices.setData(positions, BufferUsage::StaticDraw);
+cornerBuffer.setData(corners, BufferUsage::StaticDraw);
+indexBuffer.setData(indices, BufferUsage::StaticDraw);
+
+Mesh mesh;
+mesh.setCount(indices.size())
+    .addVertexBuffer(vertices, 0, Shaders::MeshVisualizer::Position{})
+    .addVertexBuffer(cornerBuffer, 0, Shaders::MeshVisualizer::VertexIndex{
+        Shaders::MeshVisualizer::VertexIndex::DataType::UnsignedByte})
+    .setIndexBuffer(indexBuffer, 0, Mesh::IndexType::UnsignedInt);
+
+Shaders::MeshVisualizer shader{Shaders::MeshVisualizer::Flag::Wireframe|
+    Shaders::MeshVisualizer::Flag::NoGeometryShader|
+    Shaders::MeshVisualizer::Flag::VertexIndexAttribute};
+@endcode
+
+@attention The function requires the mesh to have triangle faces, thus index
+    count must be divisible by 3.
+*/
+std::tuple<std::vector<UnsignedInt>, std::vector<UnsignedInt>, std::vector<UnsignedByte>> MAGNUM_MESHTOOLS_EXPORT generateWireframeCorners(const std::vector<UnsignedInt>& indices);
+
+}}
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef Magnum_MeshTools_Implementation_parallelFor_h
+#define Magnum_MeshTools_Implementation_parallelFor_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <cstddef>
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#include <vector>
+#endif
+
+#include "Magnum/Types.h"
+
+namespace Magnum { namespace MeshTools { namespace Implementation {
+
+/* Below this item count the thread startup overhead outweighs the gains */
+enum: std::size_t { ParallelForMinItemCount = 16384 };
+
+/* Calls function(begin, end) on contiguous chunks of [0, count), each chunk
+   on a separate thread. If threadCount is 0, the count is
+   std::thread::hardware_concurrency(). For small counts and on Emscripten
+   the function is called just once for the whole range on the calling
+   thread. The function must not write to memory shared between chunks. */
+template<class F> void parallelFor(const std::size_t count, UnsignedInt threadCount, F function) {
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    if(!threadCount) threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    const std::size_t chunkCount = std::min(std::size_t(threadCount), count/ParallelForMinItemCount);
+    if(chunkCount > 1) {
+        const std::size_t chunkSize = (count + chunkCount - 1)/chunkCount;
+        std::vector<std::thread> threads;
+        threads.reserve(chunkCount - 1);
+        for(std::size_t i = 1; i != chunkCount; ++i)
+            threads.emplace_back(function, i*chunkSize, std::min((i + 1)*chunkSize, count));
+        function(std::size_t{0}, chunkSize);
+        for(std::thread& thread: threads) thread.join();
+        return;
+    }
+    #else
+    static_cast<void>(threadCount);
+    #endif
+
+    function(std::size_t{0}, count);
+}
+
+}}}
+
+#endif
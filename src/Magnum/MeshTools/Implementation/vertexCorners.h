@@ -0,0 +1,62 @@
+#ifndef Magnum_MeshTools_Implementation_vertexCorners_h
+#define Magnum_MeshTools_Implementation_vertexCorners_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cmath>
+#include <vector>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace MeshTools { namespace Implementation {
+
+/* Builds vertex-to-corner adjacency in compressed form. Corners (positions in
+   the index array) adjacent to vertex i are corners[offsets[i]] to
+   corners[offsets[i + 1]], in increasing order. */
+inline void vertexCorners(const std::vector<UnsignedInt>& indices, const std::size_t vertexCount, std::vector<UnsignedInt>& offsets, std::vector<UnsignedInt>& corners) {
+    offsets.assign(vertexCount + 1, 0);
+    for(const UnsignedInt index: indices) ++offsets[index + 1];
+    for(std::size_t i = 0; i != vertexCount; ++i) offsets[i + 1] += offsets[i];
+
+    corners.resize(indices.size());
+    std::vector<UnsignedInt> position{offsets.begin(), offsets.end() - 1};
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        corners[position[indices[i]]++] = i;
+}
+
+/* Angle at the first corner of a triangle, zero if any of the edges is
+   degenerate */
+inline Float cornerAngle(const Vector3& a, const Vector3& b, const Vector3& c) {
+    const Vector3 ab = b - a;
+    const Vector3 ac = c - a;
+    const Float lengths = std::sqrt(ab.dot()*ac.dot());
+    if(lengths == 0.0f) return 0.0f;
+    return std::acos(Math::clamp(Math::dot(ab, ac)/lengths, -1.0f, 1.0f));
+}
+
+}}}
+
+#endif
@@ -26,10 +26,13 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::interleave(), @ref Magnum::MeshTools::interleaveInto()
+ * @brief Function @ref Magnum::MeshTools::interleave(), @ref Magnum::MeshTools::interleaveInto(), @ref Magnum::MeshTools::converted()
  */
 
+#include <algorithm>
 #include <cstring>
+#include <type_traits>
+#include <utility>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Utility/Assert.h>
 
@@ -72,22 +75,88 @@ struct Stride {
     constexpr std::size_t operator()() const { return 0; }
 };
 
-/* Copy data to the buffer */
-template<class T> typename std::enable_if<!std::is_convertible<T, std::size_t>::value, std::size_t>::type writeOneInterleaved(std::size_t stride, char* startingOffset, const T& attributeList) {
-    auto it = attributeList.begin();
-    for(std::size_t i = 0; i != attributeList.size(); ++i, ++it)
-        std::memcpy(startingOffset + i*stride, reinterpret_cast<const char*>(&*it), sizeof(typename T::value_type));
+/* Attribute converted on the fly, see converted() */
+template<class T, class F> struct Converted {
+    typedef typename std::decay<decltype(std::declval<const F&>()(*std::declval<const T&>().begin()))>::type value_type;
 
-    return sizeof(typename T::value_type);
-}
+    std::size_t size() const { return attribute.size(); }
+
+    const T& attribute;
+    F converter;
+};
+
+/* Writes one attribute for a tile of vertices, remembering the position in
+   the attribute array for the next tile */
+template<class T, class = void> struct AttributeWriter {
+    explicit AttributeWriter(const T& attribute): it{attribute.begin()} {}
+
+    std::size_t operator()(char* startingOffset, std::size_t stride, std::size_t count) {
+        for(std::size_t i = 0; i != count; ++i, ++it)
+            std::memcpy(startingOffset + i*stride, reinterpret_cast<const char*>(&*it), sizeof(typename T::value_type));
+
+        return sizeof(typename T::value_type);
+    }
+
+    decltype(std::declval<const T&>().begin()) it;
+};
+
+/* Converts the data directly into the buffer */
+template<class T, class F> struct AttributeWriter<Converted<T, F>> {
+    explicit AttributeWriter(const Converted<T, F>& attribute): it{attribute.attribute.begin()}, converter(attribute.converter) {}
+
+    std::size_t operator()(char* startingOffset, std::size_t stride, std::size_t count) {
+        typedef typename Converted<T, F>::value_type Type;
+        for(std::size_t i = 0; i != count; ++i, ++it) {
+            const Type value = converter(*it);
+            std::memcpy(startingOffset + i*stride, reinterpret_cast<const char*>(&value), sizeof(Type));
+        }
+
+        return sizeof(Type);
+    }
+
+    decltype(std::declval<const T&>().begin()) it;
+    const F& converter;
+};
+
+/* Skips gap */
+template<class T> struct AttributeWriter<T, typename std::enable_if<std::is_convertible<T, std::size_t>::value>::type> {
+    explicit AttributeWriter(std::size_t gap): gap{gap} {}
+
+    std::size_t operator()(char*, std::size_t, std::size_t) const { return gap; }
+
+    std::size_t gap;
+};
 
-/* Skip gap */
-constexpr std::size_t writeOneInterleaved(std::size_t, char*, std::size_t gap) { return gap; }
+/* Writes all attributes for a tile of vertices */
+template<class ...T> struct InterleavedWriter;
+template<> struct InterleavedWriter<> {
+    void operator()(char*, std::size_t, std::size_t) {}
+};
+template<class T, class ...U> struct InterleavedWriter<T, U...> {
+    explicit InterleavedWriter(const T& first, const U&... next): _first(first), _next(next...) {}
 
-/* Write interleaved data */
-inline void writeInterleaved(std::size_t, char*) {}
-template<class T, class ...U> void writeInterleaved(std::size_t stride, char* startingOffset, const T& first, const U&... next) {
-    writeInterleaved(stride, startingOffset + writeOneInterleaved(stride, startingOffset, first), next...);
+    void operator()(char* startingOffset, std::size_t stride, std::size_t count) {
+        _next(startingOffset + _first(startingOffset, stride, count), stride, count);
+    }
+
+    AttributeWriter<T> _first;
+    InterleavedWriter<U...> _next;
+};
+
+/* Size of the output written for all attributes before moving to next
+   vertices. Small enough for the output to stay in L1 cache between the
+   attributes. */
+enum: std::size_t { InterleaveTileSize = 16*1024 };
+
+/* Write interleaved data, tile by tile */
+template<class ...T> void writeInterleaved(const std::size_t attributeCount, const std::size_t stride, char* const startingOffset, const T&... attributes) {
+    /* Nothing to do if there are just gaps */
+    if(!stride || attributeCount == ~std::size_t(0)) return;
+
+    InterleavedWriter<T...> writer{attributes...};
+    const std::size_t tileCount = std::max(std::size_t(InterleaveTileSize)/stride, std::size_t(1));
+    for(std::size_t i = 0; i < attributeCount; i += tileCount)
+        writer(startingOffset + i*stride, stride, std::min(tileCount, attributeCount - i));
 }
 
 }
@@ -125,6 +194,24 @@ auto data = MeshTools::interleave(positions, weights, 2, textureCoordinates, 1);
 All gap bytes are set zero. This way vertex stride is 24 bytes, without gaps it
 would be 21 bytes, causing possible performance loss.
 
+Attributes can be also converted to a different type during interleaving
+using @ref converted(), without any temporary arrays:
+@code
+std::vector<Vector3> positions, normals;
+std::vector<Vector2> textureCoordinates;
+
+auto data = MeshTools::interleave(positions,
+    MeshTools::converted(normals, [](const Vector3& normal) {
+        return Math::pack<Math::Vector3<Byte>>(normal);
+    }), 1,
+    MeshTools::converted(textureCoordinates, [](const Vector2& coordinates) {
+        return Math::packHalf(coordinates);
+    }));
+@endcode
+
+The data are written in tiles of a few kilobytes, all attributes of one tile
+at a time, so the output stays in cache while it's being filled.
+
 @attention The function expects that all arrays have the same size.
 
 @note The only requirements to attribute array type is that it must have
@@ -143,7 +230,7 @@ template<class T, class ...U> Containers::Array<char> interleave(const T& first,
     /* Create output buffer only if we have some attributes */
     if(attributeCount && attributeCount != ~std::size_t(0)) {
         Containers::Array<char> data{Containers::ValueInit, attributeCount*stride};
-        Implementation::writeInterleaved(stride, data.begin(), first, next...);
+        Implementation::writeInterleaved(attributeCount, stride, data.begin(), first, next...);
 
         return data;
 
@@ -165,14 +252,28 @@ parameters.
 */
 template<class T, class ...U> void interleaveInto(Containers::ArrayView<char> buffer, const T& first, const U&... next) {
     /* Verify expected buffer size */
-    #if !defined(CORRADE_NO_ASSERT) || defined(CORRADE_GRACEFUL_ASSERT)
     const std::size_t attributeCount = Implementation::AttributeCount{}(first, next...);
-    #endif
     const std::size_t stride = Implementation::Stride{}(first, next...);
     CORRADE_ASSERT(attributeCount*stride <= buffer.size(), "MeshTools::interleaveInto(): the data buffer is too small, expected" << attributeCount*stride << "but got" << buffer.size(), );
 
     /* Write data */
-    Implementation::writeInterleaved(stride, buffer.begin(), first, next...);
+    Implementation::writeInterleaved(attributeCount, stride, buffer.begin(), first, next...);
+}
+
+/**
+@brief Convert vertex attribute during interleaving
+@param attribute    Attribute array
+@param converter    Functor converting one attribute value
+
+Returns a lightweight wrapper that can be passed to @ref interleave() or
+@ref interleaveInto() in place of an attribute array. The @p converter is
+called for each value in @p attribute and its result is written directly into
+the interleaved buffer, its return type determines the attribute size. The
+wrapper only references @p attribute, so it must be used before the attribute
+array goes out of scope.
+*/
+template<class T, class F> Implementation::Converted<T, F> converted(const T& attribute, F converter) {
+    return Implementation::Converted<T, F>{attribute, std::move(converter)};
 }
 
 }}
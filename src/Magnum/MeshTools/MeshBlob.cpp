@@ -0,0 +1,351 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MeshBlob.h"
+
+#include <algorithm>
+#include <cstring>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+#include <Corrade/Utility/Endianness.h>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/MeshTools/CompressIndices.h"
+#include "Magnum/MeshTools/MeshCodec.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+/* This header is included only privately and doesn't introduce any linker
+   dependency, thus it's completely safe */
+#include "Magnum/Shaders/Generic.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+struct Header {
+    char magic[4];
+    UnsignedInt version;
+    UnsignedInt primitive;
+    UnsignedInt flags;
+    UnsignedInt vertexCount;
+    UnsignedInt stride;
+    UnsignedInt normalOffset;
+    UnsignedInt textureCoordsOffset;
+    UnsignedInt indexCount;
+    UnsignedInt indexType;
+    UnsignedInt indexStart;
+    UnsignedInt indexEnd;
+    UnsignedInt vertexDataOffset;
+    UnsignedInt vertexDataSize;
+    UnsignedInt indexDataOffset;
+    UnsignedInt indexDataSize;
+};
+
+static_assert(sizeof(Header) == MeshBlob::HeaderSize, "improper size of the header");
+
+enum: UnsignedInt {
+    HasNormals = 1 << 0,
+    HasTextureCoords2D = 1 << 1,
+    VertexDataEncoded = 1 << 2,
+    IndexDataEncoded = 1 << 3
+};
+
+constexpr const char Magic[]{'M', 'B', 'L', 'B'};
+
+inline std::size_t alignedSize(const std::size_t size) {
+    return (size + 3) & ~std::size_t{3};
+}
+
+/* Returns 0 for invalid types */
+std::size_t indexTypeSize(const Mesh::IndexType type) {
+    switch(type) {
+        case Mesh::IndexType::UnsignedByte: return 1;
+        case Mesh::IndexType::UnsignedShort: return 2;
+        case Mesh::IndexType::UnsignedInt: return 4;
+    }
+
+    return 0;
+}
+
+/* Checks that the range fits into the data without overflowing */
+inline bool rangeFits(const std::size_t dataSize, const UnsignedInt offset, const UnsignedInt size) {
+    return offset <= dataSize && size <= dataSize - offset;
+}
+
+}
+
+Containers::Array<char> MeshBlob::serialize(const Trade::MeshData3D& meshData, const Flags flags) {
+    CORRADE_ASSERT(meshData.positionArrayCount(),
+        "MeshTools::MeshBlob::serialize(): the mesh has no positions", {});
+
+    const std::vector<Vector3>& positions = meshData.positions(0);
+
+    Header header{};
+    std::memcpy(header.magic, Magic, 4);
+    header.version = Version;
+    header.primitive = UnsignedInt(meshData.primitive());
+    header.vertexCount = positions.size();
+
+    /* Vertex layout, the same as in compile() */
+    header.stride = sizeof(Vector3);
+    if(meshData.hasNormals()) {
+        CORRADE_ASSERT(meshData.normals(0).size() == positions.size(),
+            "MeshTools::MeshBlob::serialize(): expected" << positions.size() << "normals but got" << meshData.normals(0).size(), {});
+        header.flags |= HasNormals;
+        header.normalOffset = header.stride;
+        header.stride += sizeof(Vector3);
+    }
+    if(meshData.hasTextureCoords2D()) {
+        CORRADE_ASSERT(meshData.textureCoords2D(0).size() == positions.size(),
+            "MeshTools::MeshBlob::serialize(): expected" << positions.size() << "texture coordinates but got" << meshData.textureCoords2D(0).size(), {});
+        header.flags |= HasTextureCoords2D;
+        header.textureCoordsOffset = header.stride;
+        header.stride += sizeof(Vector2);
+    }
+
+    /* Interleave vertices */
+    Containers::Array<char> vertexData{Containers::ValueInit, std::size_t(header.vertexCount)*header.stride};
+    char* vertex = vertexData;
+    for(std::size_t i = 0; i != positions.size(); ++i, vertex += header.stride) {
+        std::memcpy(vertex, &positions[i], sizeof(Vector3));
+        if(header.normalOffset)
+            std::memcpy(vertex + header.normalOffset, &meshData.normals(0)[i], sizeof(Vector3));
+        if(header.textureCoordsOffset)
+            std::memcpy(vertex + header.textureCoordsOffset, &meshData.textureCoords2D(0)[i], sizeof(Vector2));
+    }
+    if(flags & Flag::EncodeVertices) {
+        vertexData = encodeVertices(vertexData, header.stride);
+        header.flags |= VertexDataEncoded;
+    }
+    header.vertexDataOffset = HeaderSize;
+    header.vertexDataSize = vertexData.size();
+
+    /* Compress indices. The encoded data are decoded to the compressed type,
+       so the type and range are needed in both cases. */
+    Containers::Array<char> indexData;
+    if(meshData.isIndexed()) {
+        Mesh::IndexType indexType;
+        std::tie(indexData, indexType, header.indexStart, header.indexEnd) = compressIndices(meshData.indices());
+        header.indexCount = meshData.indices().size();
+        header.indexType = UnsignedInt(indexType);
+
+        if((flags & Flag::EncodeIndices) && meshData.primitive() == MeshPrimitive::Triangles) {
+            indexData = encodeIndices({meshData.indices().data(), meshData.indices().size()});
+            header.flags |= IndexDataEncoded;
+        }
+    }
+    header.indexDataOffset = alignedSize(header.vertexDataOffset + header.vertexDataSize);
+    header.indexDataSize = indexData.size();
+
+    /* The header is a multiple of four bytes, so only the vertex data and the
+       end need padding */
+    Containers::Array<char> data{Containers::ValueInit, alignedSize(header.indexDataOffset + header.indexDataSize)};
+    std::memcpy(data, &header, sizeof(Header));
+    std::copy(vertexData.begin(), vertexData.end(), data + header.vertexDataOffset);
+    std::copy(indexData.begin(), indexData.end(), data + header.indexDataOffset);
+    return data;
+}
+
+std::optional<MeshBlob> MeshBlob::open(const Containers::ArrayView<const char> data) {
+    if(Utility::Endianness::isBigEndian()) {
+        Error() << "MeshTools::MeshBlob::open(): big-endian platforms are not supported";
+        return std::nullopt;
+    }
+
+    Header header;
+    if(data.size() < sizeof(Header)) {
+        Error() << "MeshTools::MeshBlob::open(): data too short, expected at least" << sizeof(Header) << "bytes but got" << data.size();
+        return std::nullopt;
+    }
+    std::memcpy(&header, data, sizeof(Header));
+
+    if(std::memcmp(header.magic, Magic, 4) != 0) {
+        Error() << "MeshTools::MeshBlob::open(): invalid file signature";
+        return std::nullopt;
+    }
+
+    if(header.version != Version) {
+        Error() << "MeshTools::MeshBlob::open(): unsupported version" << header.version << Debug::nospace << ", expected" << UnsignedInt(Version);
+        return std::nullopt;
+    }
+
+    /* The vertex layout has to match the flags exactly */
+    UnsignedInt stride = sizeof(Vector3), normalOffset = 0, textureCoordsOffset = 0;
+    if(header.flags & HasNormals) {
+        normalOffset = stride;
+        stride += sizeof(Vector3);
+    }
+    if(header.flags & HasTextureCoords2D) {
+        textureCoordsOffset = stride;
+        stride += sizeof(Vector2);
+    }
+    if((header.flags & ~(HasNormals|HasTextureCoords2D|VertexDataEncoded|IndexDataEncoded)) || header.stride != stride || header.normalOffset != normalOffset || header.textureCoordsOffset != textureCoordsOffset) {
+        Error() << "MeshTools::MeshBlob::open(): invalid vertex layout";
+        return std::nullopt;
+    }
+
+    /* Size of encoded data is validated only when decoding */
+    if((!(header.flags & VertexDataEncoded) && std::size_t(header.vertexCount)*header.stride != header.vertexDataSize) || !rangeFits(data.size(), header.vertexDataOffset, header.vertexDataSize)) {
+        Error() << "MeshTools::MeshBlob::open(): invalid vertex data range";
+        return std::nullopt;
+    }
+
+    if(header.indexCount) {
+        const std::size_t indexSize = indexTypeSize(Mesh::IndexType(header.indexType));
+        if(!indexSize) {
+            Error() << "MeshTools::MeshBlob::open(): invalid index type" << header.indexType;
+            return std::nullopt;
+        }
+
+        if((!(header.flags & IndexDataEncoded) && std::size_t(header.indexCount)*indexSize != header.indexDataSize) || !rangeFits(data.size(), header.indexDataOffset, header.indexDataSize) || header.indexStart > header.indexEnd || header.indexEnd >= header.vertexCount) {
+            Error() << "MeshTools::MeshBlob::open(): invalid index data range";
+            return std::nullopt;
+        }
+    } else if(header.indexType || header.indexDataSize || (header.flags & IndexDataEncoded)) {
+        Error() << "MeshTools::MeshBlob::open(): invalid index data range";
+        return std::nullopt;
+    }
+
+    MeshBlob blob;
+    blob._primitive = MeshPrimitive(header.primitive);
+    blob._indexType = Mesh::IndexType(header.indexType);
+    blob._vertexCount = header.vertexCount;
+    blob._stride = header.stride;
+    blob._normalOffset = header.normalOffset;
+    blob._textureCoordsOffset = header.textureCoordsOffset;
+    blob._indexCount = header.indexCount;
+    blob._indexStart = header.indexStart;
+    blob._indexEnd = header.indexEnd;
+    blob._vertexDataEncoded = header.flags & VertexDataEncoded;
+    blob._indexDataEncoded = header.flags & IndexDataEncoded;
+    blob._vertexData = data.slice(header.vertexDataOffset, header.vertexDataOffset + header.vertexDataSize);
+    blob._indexData = data.slice(header.indexDataOffset, header.indexDataOffset + header.indexDataSize);
+    return blob;
+}
+
+Mesh::IndexType MeshBlob::indexType() const {
+    CORRADE_ASSERT(_indexCount, "MeshTools::MeshBlob::indexType(): the mesh is not indexed", {});
+    return _indexType;
+}
+
+Containers::Array<char> MeshBlob::decodedVertexData() const {
+    Containers::Array<char> out{Containers::ValueInit, std::size_t(_vertexCount)*_stride};
+    if(!decodeVertices(_vertexData, out, _stride))
+        std::fill(out.begin(), out.end(), 0);
+    return out;
+}
+
+Containers::Array<char> MeshBlob::decodedIndexData() const {
+    Containers::Array<char> out{Containers::ValueInit, _indexCount*indexTypeSize(_indexType)};
+    bool decoded;
+    if(_indexType == Mesh::IndexType::UnsignedByte)
+        decoded = decodeIndices(_indexData, {reinterpret_cast<UnsignedByte*>(out.data()), _indexCount});
+    else if(_indexType == Mesh::IndexType::UnsignedShort)
+        decoded = decodeIndices(_indexData, {reinterpret_cast<UnsignedShort*>(out.data()), _indexCount});
+    else
+        decoded = decodeIndices(_indexData, {reinterpret_cast<UnsignedInt*>(out.data()), _indexCount});
+    if(!decoded) std::fill(out.begin(), out.end(), 0);
+    return out;
+}
+
+std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>> MeshBlob::compile(const BufferUsage usage) const {
+    Mesh mesh;
+    mesh.setPrimitive(_primitive);
+
+    /* The data are already interleaved, upload them as-is */
+    std::unique_ptr<Buffer> vertexBuffer{new Buffer{Buffer::TargetHint::Array}};
+    if(_vertexDataEncoded) vertexBuffer->setData(decodedVertexData(), usage);
+    else vertexBuffer->setData(_vertexData, usage);
+    mesh.addVertexBuffer(*vertexBuffer, 0,
+        Shaders::Generic3D::Position(),
+        _stride - sizeof(Shaders::Generic3D::Position::Type));
+    if(_normalOffset) mesh.addVertexBuffer(*vertexBuffer, 0,
+        _normalOffset,
+        Shaders::Generic3D::Normal(),
+        _stride - _normalOffset - sizeof(Shaders::Generic3D::Normal::Type));
+    if(_textureCoordsOffset) mesh.addVertexBuffer(*vertexBuffer, 0,
+        _textureCoordsOffset,
+        Shaders::Generic3D::TextureCoordinates(),
+        _stride - _textureCoordsOffset - sizeof(Shaders::Generic3D::TextureCoordinates::Type));
+
+    std::unique_ptr<Buffer> indexBuffer;
+    if(_indexCount) {
+        indexBuffer.reset(new Buffer{Buffer::TargetHint::ElementArray});
+        if(_indexDataEncoded) indexBuffer->setData(decodedIndexData(), usage);
+        else indexBuffer->setData(_indexData, usage);
+        mesh.setCount(_indexCount)
+            .setIndexBuffer(*indexBuffer, 0, _indexType, _indexStart, _indexEnd);
+    } else mesh.setCount(_vertexCount);
+
+    return std::make_tuple(std::move(mesh), std::move(vertexBuffer), std::move(indexBuffer));
+}
+
+Trade::MeshData3D MeshBlob::meshData(const void* const importerState) const {
+    Containers::Array<char> decodedIndices, decodedVertices;
+    Containers::ArrayView<const char> indexData = _indexData, vertexData = _vertexData;
+    if(_indexDataEncoded) {
+        decodedIndices = decodedIndexData();
+        indexData = decodedIndices;
+    }
+    if(_vertexDataEncoded) {
+        decodedVertices = decodedVertexData();
+        vertexData = decodedVertices;
+    }
+
+    std::vector<UnsignedInt> indices(_indexCount);
+    for(std::size_t i = 0; i != _indexCount; ++i) {
+        if(_indexType == Mesh::IndexType::UnsignedByte) {
+            UnsignedByte index;
+            std::memcpy(&index, indexData.data() + i, sizeof(UnsignedByte));
+            indices[i] = index;
+        } else if(_indexType == Mesh::IndexType::UnsignedShort) {
+            UnsignedShort index;
+            std::memcpy(&index, indexData.data() + i*sizeof(UnsignedShort), sizeof(UnsignedShort));
+            indices[i] = index;
+        } else std::memcpy(&indices[i], indexData.data() + i*sizeof(UnsignedInt), sizeof(UnsignedInt));
+    }
+
+    std::vector<Vector3> positions(_vertexCount), normals(_normalOffset ? _vertexCount : 0);
+    std::vector<Vector2> textureCoords2D(_textureCoordsOffset ? _vertexCount : 0);
+    const char* vertex = vertexData.data();
+    for(std::size_t i = 0; i != _vertexCount; ++i, vertex += _stride) {
+        std::memcpy(&positions[i], vertex, sizeof(Vector3));
+        if(_normalOffset)
+            std::memcpy(&normals[i], vertex + _normalOffset, sizeof(Vector3));
+        if(_textureCoordsOffset)
+            std::memcpy(&textureCoords2D[i], vertex + _textureCoordsOffset, sizeof(Vector2));
+    }
+
+    std::vector<std::vector<Vector3>> normalArrays;
+    if(_normalOffset) normalArrays.push_back(std::move(normals));
+    std::vector<std::vector<Vector2>> textureCoordArrays;
+    if(_textureCoordsOffset) textureCoordArrays.push_back(std::move(textureCoords2D));
+
+    return Trade::MeshData3D{_primitive, std::move(indices), {std::move(positions)}, std::move(normalArrays), std::move(textureCoordArrays), {}, importerState};
+}
+
+}}
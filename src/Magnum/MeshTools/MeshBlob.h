@@ -0,0 +1,265 @@
+#ifndef Magnum_MeshTools_MeshBlob_h
+#define Magnum_MeshTools_MeshBlob_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::MeshTools::MeshBlob
+ */
+
+#include <memory>
+#include <tuple>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/EnumSet.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/Trade/Trade.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "MagnumExternal/Optional/optional.hpp"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Binary mesh blob
+
+Compact, versioned binary representation of a 3D mesh that can be uploaded to
+the GPU without any parsing. Create it from @ref Trade::MeshData3D using
+@ref serialize(), save it to a file and then later @ref open() it, ideally
+from memory-mapped file data. The @ref MeshBlob instance is just a view on the
+data, @ref compile() passes the vertex and index bytes straight to
+@ref Buffer::setData(). Example:
+@code
+// Offline
+Utility::Directory::write("level.blob", MeshTools::MeshBlob::serialize(meshData));
+
+// At runtime
+Containers::Array<char> data = Utility::Directory::read("level.blob");
+std::optional<MeshTools::MeshBlob> blob = MeshTools::MeshBlob::open(data);
+Mesh mesh{NoCreate};
+std::unique_ptr<Buffer> vertices, indices;
+std::tie(mesh, vertices, indices) = blob->compile(BufferUsage::StaticDraw);
+@endcode
+
+The `MeshBlobImporter` plugin opens these files through the
+@ref Trade::AbstractImporter interface, memory-mapping them where possible.
+
+## File format
+
+All values are little-endian, opening the blob on big-endian platforms fails.
+The file starts with a 64-byte header consisting of sixteen 32-bit unsigned
+integers:
+
+-   magic `"MBLB"` (four ASCII characters)
+-   format version, currently @ref Version
+-   @ref MeshPrimitive value
+-   flags --- `1` if the mesh has normals, `2` if it has texture coordinates,
+    `4` if vertex data are encoded, `8` if index data are encoded
+-   vertex count
+-   vertex stride
+-   offset of normals in a vertex, `0` if there are none
+-   offset of texture coordinates in a vertex, `0` if there are none
+-   index count, `0` if the mesh is not indexed
+-   @ref Mesh::IndexType value, `0` if the mesh is not indexed
+-   index range start and end
+-   offset and size of vertex data in bytes, relative to file start
+-   offset and size of index data in bytes, relative to file start
+
+Vertices are interleaved, each consisting of a @ref Vector3 position,
+optionally followed by a @ref Vector3 normal and a @ref Vector2 texture
+coordinate. Indices are compressed with @ref compressIndices(). Both data
+blocks are four-byte aligned. Only the first position, normal and texture
+coordinate array of the mesh is stored, colors are not stored.
+
+If the vertex data are encoded, the vertex data block contains output of
+@ref encodeVertices() for the interleaved vertices and its size is the encoded
+size. If the index data are encoded, the index data block contains output of
+@ref encodeIndices() and the indices are decoded to the type stored in the
+header. The remaining header fields describe the decoded data in both cases.
+*/
+class MAGNUM_MESHTOOLS_EXPORT MeshBlob {
+    public:
+        enum: UnsignedInt {
+            Version = 1,    /**< Format version */
+            HeaderSize = 64 /**< Header size in bytes */
+        };
+
+        /**
+         * @brief Serialization flag
+         *
+         * @see @ref Flags, @ref serialize()
+         */
+        enum class Flag: UnsignedByte {
+            /**
+             * Encode the vertex data using @ref encodeVertices(). Makes
+             * the file smaller at the cost of decoding the data on
+             * @ref compile().
+             */
+            EncodeVertices = 1 << 0,
+
+            /**
+             * Encode the index data using @ref encodeIndices(). Applied only
+             * to @ref MeshPrimitive::Triangles meshes, ignored otherwise.
+             */
+            EncodeIndices = 1 << 1
+        };
+
+        /**
+         * @brief Serialization flags
+         *
+         * @see @ref serialize()
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+
+        /**
+         * @brief Serialize mesh data
+         *
+         * Interleaves the vertex data and compresses the indices, optionally
+         * encoding them based on @p flags. The returned data can be passed to
+         * @ref open().
+         */
+        static Containers::Array<char> serialize(const Trade::MeshData3D& meshData, Flags flags = {});
+
+        /**
+         * @brief Open mesh blob
+         *
+         * Validates just the header and doesn't copy anything, the data are
+         * expected to stay in scope for the whole lifetime of the returned
+         * instance. Prints a message to error output and returns
+         * @ref std::nullopt if the data are not a valid mesh blob.
+         */
+        static std::optional<MeshBlob> open(Containers::ArrayView<const char> data);
+
+        /** @brief Primitive */
+        MeshPrimitive primitive() const { return _primitive; }
+
+        /** @brief Vertex count */
+        UnsignedInt vertexCount() const { return _vertexCount; }
+
+        /** @brief Vertex stride */
+        UnsignedInt stride() const { return _stride; }
+
+        /** @brief Whether the mesh has normals */
+        bool hasNormals() const { return _normalOffset; }
+
+        /**
+         * @brief Offset of normals in a vertex
+         *
+         * Returns `0` if the mesh has no normals.
+         */
+        UnsignedInt normalOffset() const { return _normalOffset; }
+
+        /** @brief Whether the mesh has texture coordinates */
+        bool hasTextureCoords2D() const { return _textureCoordsOffset; }
+
+        /**
+         * @brief Offset of texture coordinates in a vertex
+         *
+         * Returns `0` if the mesh has no texture coordinates.
+         */
+        UnsignedInt textureCoords2DOffset() const { return _textureCoordsOffset; }
+
+        /** @brief Whether the mesh is indexed */
+        bool isIndexed() const { return _indexCount; }
+
+        /** @brief Index count */
+        UnsignedInt indexCount() const { return _indexCount; }
+
+        /**
+         * @brief Index type
+         *
+         * Expects that the mesh is indexed.
+         */
+        Mesh::IndexType indexType() const;
+
+        /** @brief Index range start */
+        UnsignedInt indexStart() const { return _indexStart; }
+
+        /** @brief Index range end */
+        UnsignedInt indexEnd() const { return _indexEnd; }
+
+        /** @brief Whether the vertex data are encoded */
+        bool isVertexDataEncoded() const { return _vertexDataEncoded; }
+
+        /** @brief Whether the index data are encoded */
+        bool isIndexDataEncoded() const { return _indexDataEncoded; }
+
+        /**
+         * @brief Interleaved vertex data
+         *
+         * Output of @ref encodeVertices() if @ref isVertexDataEncoded() is
+         * `true`.
+         */
+        Containers::ArrayView<const char> vertexData() const { return _vertexData; }
+
+        /**
+         * @brief Compressed index data
+         *
+         * Empty if the mesh is not indexed, output of @ref encodeIndices() if
+         * @ref isIndexDataEncoded() is `true`.
+         */
+        Containers::ArrayView<const char> indexData() const { return _indexData; }
+
+        /**
+         * @brief Compile the mesh
+         *
+         * Uploads the vertex and index data, decoding them first if they are
+         * encoded, and configures the mesh
+         * the same way as @ref MeshTools::compile(const Trade::MeshData3D&, BufferUsage)
+         * does. The second returned buffer is `nullptr` if the mesh is not
+         * indexed. If decoding fails, a message is printed to error output
+         * and zero-filled data are uploaded instead.
+         */
+        std::tuple<Mesh, std::unique_ptr<Buffer>, std::unique_ptr<Buffer>> compile(BufferUsage usage) const;
+
+        /**
+         * @brief Convert back to mesh data
+         *
+         * Decodes, deinterleaves the vertex data and decompresses the
+         * indices. Decoding failures are handled the same way as in
+         * @ref compile(). Meant mainly for CPU-side processing, use @ref compile() for
+         * rendering.
+         */
+        Trade::MeshData3D meshData(const void* importerState = nullptr) const;
+
+    private:
+        explicit MeshBlob() = default;
+
+        Containers::Array<char> decodedVertexData() const;
+        Containers::Array<char> decodedIndexData() const;
+
+        MeshPrimitive _primitive;
+        Mesh::IndexType _indexType;
+        UnsignedInt _vertexCount, _stride, _normalOffset, _textureCoordsOffset,
+            _indexCount, _indexStart, _indexEnd;
+        bool _vertexDataEncoded, _indexDataEncoded;
+        Containers::ArrayView<const char> _vertexData, _indexData;
+};
+
+CORRADE_ENUMSET_OPERATORS(MeshBlob::Flags)
+
+}}
+
+#endif
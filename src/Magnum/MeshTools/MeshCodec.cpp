@@ -0,0 +1,593 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MeshCodec.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* First byte of the encoded data, version in the low nibble */
+enum: UnsignedByte {
+    IndexHeader = 0xe1,
+    VertexHeader = 0xa1
+};
+
+/* Index codec. Both the encoder and decoder keep exactly the same state, so
+   the FIFOs can be initialized with anything. */
+struct IndexState {
+    explicit IndexState() {
+        for(std::size_t i = 0; i != 16; ++i) {
+            edges[i][0] = edges[i][1] = ~UnsignedInt{};
+            vertices[i] = ~UnsignedInt{};
+        }
+    }
+
+    void pushEdge(const UnsignedInt a, const UnsignedInt b) {
+        edges[edgeOffset][0] = a;
+        edges[edgeOffset][1] = b;
+        edgeOffset = (edgeOffset + 1) & 15;
+    }
+
+    void pushVertex(const UnsignedInt a) {
+        vertices[vertexOffset] = a;
+        vertexOffset = (vertexOffset + 1) & 15;
+    }
+
+    /* Reversed, so the edge shared with an adjacent triangle of the same
+       winding is found directly */
+    void pushTriangle(const UnsignedInt a, const UnsignedInt b, const UnsignedInt c) {
+        pushEdge(b, a);
+        pushEdge(c, b);
+        pushEdge(a, c);
+    }
+
+    const UnsignedInt* edge(const std::size_t distance) const {
+        return edges[(edgeOffset - 1 - distance) & 15];
+    }
+
+    UnsignedInt vertex(const std::size_t distance) const {
+        return vertices[(vertexOffset - 1 - distance) & 15];
+    }
+
+    UnsignedInt edges[16][2];
+    UnsignedInt vertices[16];
+    std::size_t edgeOffset{}, vertexOffset{};
+    UnsignedInt next{}, last{};
+};
+
+/* Code nibbles. Values of the high nibble below 15 are edge FIFO distances,
+   values of the low nibble between 1 and 14 are vertex FIFO distances plus
+   one. */
+enum: UnsignedByte {
+    NoEdge = 15,
+    NextVertex = 0,
+    ExplicitVertex = 15
+};
+
+/* Vertex tokens of triangles with no edge in the FIFO, stored in the extra
+   data. Values between 1 and 16 are vertex FIFO distances plus one, values
+   above are zig-zag encoded deltas plus 17. */
+enum: std::uint64_t {
+    NextVertexToken = 0,
+    ExplicitVertexToken = 17
+};
+
+void writeVarint(Containers::Array<char>& out, std::size_t& offset, std::uint64_t value) {
+    while(value >= 0x80) {
+        out[offset++] = char((value & 0x7f)|0x80);
+        value >>= 7;
+    }
+    out[offset++] = char(value);
+}
+
+inline UnsignedInt zigzag(const Int value) {
+    return (UnsignedInt(value) << 1) ^ UnsignedInt(value >> 31);
+}
+
+inline Int unzigzag(const UnsignedInt value) {
+    return Int(value >> 1) ^ -Int(value & 1);
+}
+
+template<class T> bool decodeIndicesInternal(const Containers::ArrayView<const char> data, const Containers::ArrayView<T> indices) {
+    const std::size_t triangleCount = indices.size()/3;
+    if(indices.size() % 3) {
+        Error() << "MeshTools::decodeIndices(): index count" << indices.size() << "not divisible by three";
+        return false;
+    }
+
+    if(data.size() < 1 + triangleCount || UnsignedByte(data[0]) != IndexHeader) {
+        Error() << "MeshTools::decodeIndices(): invalid header or data too short";
+        return false;
+    }
+
+    const UnsignedByte* codes = reinterpret_cast<const UnsignedByte*>(data.data()) + 1;
+    const UnsignedByte* extra = codes + triangleCount;
+    const UnsignedByte* const end = reinterpret_cast<const UnsignedByte*>(data.data()) + data.size();
+
+    IndexState state;
+    bool valid = true;
+    auto readVarint = [&]() -> std::uint64_t {
+        std::uint64_t value = 0;
+        for(UnsignedInt shift = 0; ; shift += 7) {
+            if(extra == end || shift > 35) {
+                valid = false;
+                return 0;
+            }
+            const UnsignedByte byte = *extra++;
+            value |= std::uint64_t(byte & 0x7f) << shift;
+            if(!(byte & 0x80)) break;
+        }
+        return value;
+    };
+    auto readExplicit = [&](const std::uint64_t value) -> UnsignedInt {
+        state.last += unzigzag(UnsignedInt(value));
+        state.pushVertex(state.last);
+        return state.last;
+    };
+    auto readNext = [&]() -> UnsignedInt {
+        state.pushVertex(state.next);
+        return state.next++;
+    };
+    auto readToken = [&]() -> UnsignedInt {
+        const std::uint64_t token = readVarint();
+        if(token == NextVertexToken) return readNext();
+        if(token < ExplicitVertexToken) return state.vertex(token - 1);
+        return readExplicit(token - ExplicitVertexToken);
+    };
+
+    UnsignedInt maxValue = 0;
+    for(std::size_t i = 0; i != triangleCount; ++i) {
+        const UnsignedByte code = codes[i];
+        const UnsignedByte edge = code >> 4;
+        const UnsignedByte vertex = code & 15;
+
+        UnsignedInt a{}, b{}, c{};
+        if(edge != NoEdge) {
+            const UnsignedInt* const e = state.edge(edge);
+            a = e[0];
+            b = e[1];
+            if(vertex == NextVertex) c = readNext();
+            else if(vertex == ExplicitVertex) c = readExplicit(readVarint());
+            else c = state.vertex(vertex - 1);
+
+            state.pushEdge(c, b);
+            state.pushEdge(a, c);
+        } else {
+            if(vertex == NextVertex) {
+                a = readNext();
+                b = readNext();
+                c = readNext();
+            } else if(vertex == ExplicitVertex) {
+                a = readToken();
+                b = readToken();
+                c = readToken();
+            } else valid = false;
+
+            if(!valid) break;
+            state.pushTriangle(a, b, c);
+        }
+
+        if(!valid) break;
+
+        indices[i*3 + 0] = T(a);
+        indices[i*3 + 1] = T(b);
+        indices[i*3 + 2] = T(c);
+        maxValue |= a|b|c;
+    }
+
+    if(!valid || extra != end) {
+        Error() << "MeshTools::decodeIndices(): invalid data";
+        return false;
+    }
+
+    if(maxValue > std::numeric_limits<T>::max()) {
+        Error() << "MeshTools::decodeIndices(): decoded values don't fit into" << sizeof(T)*8 << "bits";
+        return false;
+    }
+
+    return true;
+}
+
+/* Vertex codec. Vertices are processed in blocks, bytes of each vertex in
+   separate planes, the planes in groups of 16 bytes. */
+constexpr std::size_t BlockSize = 256;
+constexpr std::size_t GroupSize = 16;
+constexpr std::size_t GroupsPerBlock = BlockSize/GroupSize;
+
+/* Bits per value for each 2-bit group header value */
+constexpr UnsignedByte GroupBits[]{0, 2, 4, 8};
+
+inline UnsignedByte zigzag8(const UnsignedByte value) {
+    return UnsignedByte((value << 1) ^ UnsignedByte(Byte(value) >> 7));
+}
+
+/* Worst case is a full byte for each value plus the group headers */
+inline std::size_t maxEncodedVertexSize(const std::size_t vertexCount, const std::size_t stride) {
+    const std::size_t blockCount = (vertexCount + BlockSize - 1)/BlockSize;
+    return 1 + blockCount*stride*(GroupsPerBlock/4 + BlockSize);
+}
+
+/* Unpacks 16 bit-packed zig-zag deltas, applies them to the last value and
+   returns the group. Advances the data pointer. */
+#ifdef __SSE2__
+inline __m128i unpackGroup(const UnsignedByte*& data, const UnsignedByte bits) {
+    const __m128i mask2 = _mm_set1_epi8(3);
+    const __m128i mask4 = _mm_set1_epi8(15);
+
+    __m128i values;
+    if(bits == 0) values = _mm_setzero_si128();
+    else if(bits == 2) {
+        Int packed;
+        std::memcpy(&packed, data, 4);
+        const __m128i x = _mm_cvtsi32_si128(packed);
+        const __m128i v0 = _mm_and_si128(x, mask2);
+        const __m128i v1 = _mm_and_si128(_mm_srli_epi16(x, 2), mask2);
+        const __m128i v2 = _mm_and_si128(_mm_srli_epi16(x, 4), mask2);
+        const __m128i v3 = _mm_and_si128(_mm_srli_epi16(x, 6), mask2);
+        values = _mm_unpacklo_epi16(_mm_unpacklo_epi8(v0, v1), _mm_unpacklo_epi8(v2, v3));
+    } else if(bits == 4) {
+        const __m128i x = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(data));
+        values = _mm_unpacklo_epi8(_mm_and_si128(x, mask4), _mm_and_si128(_mm_srli_epi16(x, 4), mask4));
+    } else values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    data += bits*2;
+
+    /* Undo the zig-zag encoding, (v >> 1) ^ -(v & 1) */
+    const __m128i one = _mm_set1_epi8(1);
+    const __m128i sign = _mm_sub_epi8(_mm_setzero_si128(), _mm_and_si128(values, one));
+    const __m128i shifted = _mm_and_si128(_mm_srli_epi16(values, 1), _mm_set1_epi8(0x7f));
+    return _mm_xor_si128(shifted, sign);
+}
+
+inline void decodeGroup(const UnsignedByte*& data, const UnsignedByte bits, UnsignedByte& last, UnsignedByte* const out) {
+    __m128i x = unpackGroup(data, bits);
+
+    /* Prefix sum */
+    x = _mm_add_epi8(x, _mm_slli_si128(x, 1));
+    x = _mm_add_epi8(x, _mm_slli_si128(x, 2));
+    x = _mm_add_epi8(x, _mm_slli_si128(x, 4));
+    x = _mm_add_epi8(x, _mm_slli_si128(x, 8));
+    x = _mm_add_epi8(x, _mm_set1_epi8(char(last)));
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), x);
+    last = out[GroupSize - 1];
+}
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+inline uint8x16_t unpackGroup(const UnsignedByte*& data, const UnsignedByte bits) {
+    uint8x16_t values;
+    if(bits == 0) values = vdupq_n_u8(0);
+    else if(bits == 2) {
+        UnsignedByte packed[8]{};
+        std::memcpy(packed, data, 4);
+        const uint8x8_t x = vld1_u8(packed);
+        const uint8x8_t mask = vdup_n_u8(3);
+        const uint8x8x2_t v01 = vzip_u8(vand_u8(x, mask), vand_u8(vshr_n_u8(x, 2), mask));
+        const uint8x8x2_t v23 = vzip_u8(vand_u8(vshr_n_u8(x, 4), mask), vshr_n_u8(x, 6));
+        const uint16x4x2_t v = vzip_u16(vreinterpret_u16_u8(v01.val[0]), vreinterpret_u16_u8(v23.val[0]));
+        values = vcombine_u8(vreinterpret_u8_u16(v.val[0]), vreinterpret_u8_u16(v.val[1]));
+    } else if(bits == 4) {
+        const uint8x8_t x = vld1_u8(data);
+        const uint8x8x2_t v = vzip_u8(vand_u8(x, vdup_n_u8(15)), vshr_n_u8(x, 4));
+        values = vcombine_u8(v.val[0], v.val[1]);
+    } else values = vld1q_u8(data);
+    data += bits*2;
+
+    const uint8x16_t sign = vnegq_s8(vreinterpretq_s8_u8(vandq_u8(values, vdupq_n_u8(1))));
+    return veorq_u8(vshrq_n_u8(values, 1), vreinterpretq_u8_s8(sign));
+}
+
+inline void decodeGroup(const UnsignedByte*& data, const UnsignedByte bits, UnsignedByte& last, UnsignedByte* const out) {
+    const uint8x16_t zero = vdupq_n_u8(0);
+    uint8x16_t x = unpackGroup(data, bits);
+
+    x = vaddq_u8(x, vextq_u8(zero, x, 15));
+    x = vaddq_u8(x, vextq_u8(zero, x, 14));
+    x = vaddq_u8(x, vextq_u8(zero, x, 12));
+    x = vaddq_u8(x, vextq_u8(zero, x, 8));
+    x = vaddq_u8(x, vdupq_n_u8(last));
+
+    vst1q_u8(out, x);
+    last = out[GroupSize - 1];
+}
+#else
+inline void decodeGroup(const UnsignedByte*& data, const UnsignedByte bits, UnsignedByte& last, UnsignedByte* const out) {
+    const UnsignedByte mask = (1 << bits) - 1;
+    for(std::size_t i = 0; i != GroupSize; ++i) {
+        UnsignedByte value;
+        if(bits == 0) value = 0;
+        else if(bits == 8) value = data[i];
+        else {
+            const std::size_t bit = i*bits;
+            value = (data[bit/8] >> (bit % 8)) & mask;
+        }
+
+        last += UnsignedByte((value >> 1) ^ -(value & 1));
+        out[i] = last;
+    }
+    data += bits*2;
+}
+#endif
+
+}
+
+Containers::Array<char> encodeIndices(const Containers::ArrayView<const UnsignedInt> indices) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::encodeIndices(): index count" << indices.size() << "not divisible by three", {});
+
+    /* Worst case is a code byte and three five-byte variable-length integers
+       per triangle */
+    const std::size_t triangleCount = indices.size()/3;
+    Containers::Array<char> codes{1 + triangleCount};
+    Containers::Array<char> extra{triangleCount*15};
+    std::size_t extraSize = 0;
+    codes[0] = char(IndexHeader);
+
+    IndexState state;
+    auto writeExplicit = [&](const UnsignedInt value, const std::uint64_t offset) {
+        writeVarint(extra, extraSize, offset + zigzag(Int(value - state.last)));
+        state.last = value;
+        state.pushVertex(value);
+    };
+    auto writeToken = [&](const UnsignedInt value) {
+        if(value == state.next) {
+            writeVarint(extra, extraSize, NextVertexToken);
+            state.pushVertex(state.next++);
+            return;
+        }
+
+        for(std::size_t j = 0; j != ExplicitVertexToken - 1; ++j) {
+            if(state.vertex(j) != value) continue;
+            writeVarint(extra, extraSize, j + 1);
+            return;
+        }
+
+        writeExplicit(value, ExplicitVertexToken);
+    };
+
+    for(std::size_t i = 0; i != triangleCount; ++i) {
+        const UnsignedInt* const t = indices.data() + i*3;
+
+        /* Find the most recent edge shared with this triangle, rotate the
+           triangle so the shared edge goes first */
+        std::size_t edge = NoEdge;
+        UnsignedInt a{}, b{}, c{};
+        for(std::size_t j = 0; j != NoEdge && edge == NoEdge; ++j) {
+            const UnsignedInt* const e = state.edge(j);
+            for(std::size_t r = 0; r != 3; ++r) {
+                if(e[0] != t[r] || e[1] != t[(r + 1) % 3]) continue;
+                a = t[r];
+                b = t[(r + 1) % 3];
+                c = t[(r + 2) % 3];
+                edge = j;
+                break;
+            }
+        }
+
+        UnsignedByte vertex;
+        if(edge != NoEdge) {
+            if(c == state.next) {
+                vertex = NextVertex;
+                state.pushVertex(state.next++);
+            } else {
+                vertex = ExplicitVertex;
+                for(std::size_t j = 0; j != ExplicitVertex - 1; ++j) {
+                    if(state.vertex(j) != c) continue;
+                    vertex = UnsignedByte(j + 1);
+                    break;
+                }
+                if(vertex == ExplicitVertex) writeExplicit(c, 0);
+            }
+
+            state.pushEdge(c, b);
+            state.pushEdge(a, c);
+        } else {
+            a = t[0];
+            b = t[1];
+            c = t[2];
+            if(a == state.next && b == state.next + 1 && c == state.next + 2) {
+                vertex = NextVertex;
+                state.pushVertex(state.next++);
+                state.pushVertex(state.next++);
+                state.pushVertex(state.next++);
+            } else {
+                vertex = ExplicitVertex;
+                writeToken(a);
+                writeToken(b);
+                writeToken(c);
+            }
+
+            state.pushTriangle(a, b, c);
+        }
+
+        codes[1 + i] = char((edge << 4)|vertex);
+    }
+
+    Containers::Array<char> out{codes.size() + extraSize};
+    std::memcpy(out, codes, codes.size());
+    std::memcpy(out + codes.size(), extra, extraSize);
+    return out;
+}
+
+bool decodeIndices(const Containers::ArrayView<const char> data, const Containers::ArrayView<UnsignedInt> indices) {
+    return decodeIndicesInternal(data, indices);
+}
+
+bool decodeIndices(const Containers::ArrayView<const char> data, const Containers::ArrayView<UnsignedShort> indices) {
+    return decodeIndicesInternal(data, indices);
+}
+
+bool decodeIndices(const Containers::ArrayView<const char> data, const Containers::ArrayView<UnsignedByte> indices) {
+    return decodeIndicesInternal(data, indices);
+}
+
+Containers::Array<char> encodeVertices(const Containers::ArrayView<const char> vertices, const std::size_t stride) {
+    CORRADE_ASSERT(stride >= 1 && stride <= 256,
+        "MeshTools::encodeVertices(): expected stride between 1 and 256 but got" << stride, {});
+    CORRADE_ASSERT(vertices.size() % stride == 0,
+        "MeshTools::encodeVertices(): data size" << vertices.size() << "not divisible by stride" << stride, {});
+
+    const std::size_t vertexCount = vertices.size()/stride;
+    Containers::Array<char> out{maxEncodedVertexSize(vertexCount, stride)};
+    std::size_t size = 0;
+    out[size++] = char(VertexHeader);
+
+    const UnsignedByte* const data = reinterpret_cast<const UnsignedByte*>(vertices.data());
+    UnsignedByte last[256]{};
+    UnsignedByte deltas[BlockSize];
+    for(std::size_t block = 0; block < vertexCount; block += BlockSize) {
+        const std::size_t blockVertexCount = std::min(BlockSize, vertexCount - block);
+        const std::size_t groupCount = (blockVertexCount + GroupSize - 1)/GroupSize;
+
+        for(std::size_t k = 0; k != stride; ++k) {
+            /* Deltas, the padding of the last group is zero */
+            for(std::size_t i = 0; i != blockVertexCount; ++i) {
+                const UnsignedByte value = data[(block + i)*stride + k];
+                deltas[i] = zigzag8(UnsignedByte(value - last[k]));
+                last[k] = value;
+            }
+            std::fill(deltas + blockVertexCount, deltas + groupCount*GroupSize, UnsignedByte{});
+
+            /* Group headers, four in a byte */
+            const std::size_t headerOffset = size;
+            const std::size_t headerSize = (groupCount + 3)/4;
+            std::fill_n(out + size, headerSize, 0);
+            size += headerSize;
+
+            for(std::size_t g = 0; g != groupCount; ++g) {
+                const UnsignedByte* const group = deltas + g*GroupSize;
+                UnsignedByte combined = 0;
+                for(std::size_t i = 0; i != GroupSize; ++i) combined |= group[i];
+
+                UnsignedByte header = 3;
+                if(!combined) header = 0;
+                else if(combined < 4) header = 1;
+                else if(combined < 16) header = 2;
+                out[headerOffset + g/4] = char(UnsignedByte(out[headerOffset + g/4]) | (header << ((g % 4)*2)));
+
+                const UnsignedByte bits = GroupBits[header];
+                if(bits == 8) {
+                    std::memcpy(out + size, group, GroupSize);
+                } else if(bits) {
+                    std::fill_n(out + size, bits*2, 0);
+                    for(std::size_t i = 0; i != GroupSize; ++i) {
+                        const std::size_t bit = i*bits;
+                        out[size + bit/8] = char(UnsignedByte(out[size + bit/8]) | (group[i] << (bit % 8)));
+                    }
+                }
+                size += bits*2;
+            }
+        }
+    }
+
+    Containers::Array<char> result{size};
+    std::memcpy(result, out, size);
+    return result;
+}
+
+bool decodeVertices(const Containers::ArrayView<const char> data, const Containers::ArrayView<char> vertices, const std::size_t stride) {
+    CORRADE_ASSERT(stride >= 1 && stride <= 256,
+        "MeshTools::decodeVertices(): expected stride between 1 and 256 but got" << stride, false);
+    CORRADE_ASSERT(vertices.size() % stride == 0,
+        "MeshTools::decodeVertices(): data size" << vertices.size() << "not divisible by stride" << stride, false);
+
+    if(data.empty() || UnsignedByte(data[0]) != VertexHeader) {
+        Error() << "MeshTools::decodeVertices(): invalid header";
+        return false;
+    }
+
+    const std::size_t vertexCount = vertices.size()/stride;
+    const UnsignedByte* in = reinterpret_cast<const UnsignedByte*>(data.data()) + 1;
+    const UnsignedByte* const end = reinterpret_cast<const UnsignedByte*>(data.data()) + data.size();
+    UnsignedByte* const out = reinterpret_cast<UnsignedByte*>(vertices.data());
+
+    /* Decoded planes of one block, with space for the padding of the last
+       group */
+    UnsignedByte last[256]{};
+    Containers::Array<UnsignedByte> planes{stride*BlockSize};
+    for(std::size_t block = 0; block < vertexCount; block += BlockSize) {
+        const std::size_t blockVertexCount = std::min(BlockSize, vertexCount - block);
+        const std::size_t groupCount = (blockVertexCount + GroupSize - 1)/GroupSize;
+        const std::size_t headerSize = (groupCount + 3)/4;
+
+        for(std::size_t k = 0; k != stride; ++k) {
+            if(std::size_t(end - in) < headerSize) {
+                Error() << "MeshTools::decodeVertices(): data too short";
+                return false;
+            }
+
+            const UnsignedByte* const headers = in;
+            in += headerSize;
+
+            /* Check that all groups are there before decoding any of them,
+               so the decoding loop doesn't need to */
+            std::size_t groupDataSize = 0;
+            for(std::size_t g = 0; g != groupCount; ++g)
+                groupDataSize += GroupBits[(headers[g/4] >> ((g % 4)*2)) & 3]*2;
+            if(std::size_t(end - in) < groupDataSize) {
+                Error() << "MeshTools::decodeVertices(): data too short";
+                return false;
+            }
+
+            UnsignedByte* const plane = planes + k*BlockSize;
+            for(std::size_t g = 0; g != groupCount; ++g) {
+                const UnsignedByte bits = GroupBits[(headers[g/4] >> ((g % 4)*2)) & 3];
+                decodeGroup(in, bits, last[k], plane + g*GroupSize);
+            }
+
+            /* The padding deltas are zero, so the last value is correct
+               even after a partial group */
+        }
+
+        /* Interleave the planes back */
+        for(std::size_t i = 0; i != blockVertexCount; ++i) {
+            UnsignedByte* const vertex = out + (block + i)*stride;
+            for(std::size_t k = 0; k != stride; ++k)
+                vertex[k] = planes[k*BlockSize + i];
+        }
+    }
+
+    if(in != end) {
+        Error() << "MeshTools::decodeVertices(): invalid data";
+        return false;
+    }
+
+    return true;
+}
+
+}}
@@ -0,0 +1,155 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Meshletize.h"
+
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Calculates bounds and the normal cone of given meshlet */
+void meshletBounds(Meshlet& meshlet, const std::vector<UnsignedInt>& vertices, const std::vector<UnsignedInt>& localIndices, const std::vector<Vector3>& positions) {
+    /* Bounding sphere around the center of the bounding box */
+    Vector3 min{positions[vertices[meshlet.vertexOffset]]}, max = min;
+    for(std::size_t i = meshlet.vertexOffset + 1; i != meshlet.vertexOffset + meshlet.vertexCount; ++i) {
+        min = Math::min(min, positions[vertices[i]]);
+        max = Math::max(max, positions[vertices[i]]);
+    }
+    meshlet.center = (min + max)*0.5f;
+    Float radiusSquared = 0.0f;
+    for(std::size_t i = meshlet.vertexOffset; i != meshlet.vertexOffset + meshlet.vertexCount; ++i)
+        radiusSquared = Math::max(radiusSquared, (positions[vertices[i]] - meshlet.center).dot());
+    meshlet.radius = std::sqrt(radiusSquared);
+
+    /* Normal cone axis is the average normal, the cone angle is given by the
+       normal farthest from it */
+    std::vector<Vector3> normals;
+    normals.reserve(meshlet.indexCount/3);
+    Vector3 axis;
+    for(std::size_t i = meshlet.indexOffset; i != meshlet.indexOffset + meshlet.indexCount; i += 3) {
+        const Vector3& a = positions[vertices[meshlet.vertexOffset + localIndices[i]]];
+        const Vector3& b = positions[vertices[meshlet.vertexOffset + localIndices[i + 1]]];
+        const Vector3& c = positions[vertices[meshlet.vertexOffset + localIndices[i + 2]]];
+        const Vector3 normal = Math::cross(b - a, c - a);
+        const Float length = normal.length();
+        if(length == 0.0f) continue;
+
+        normals.push_back(normal/length);
+        axis += normals.back();
+    }
+
+    const Float axisLength = axis.length();
+    if(axisLength == 0.0f) {
+        meshlet.coneAxis = {};
+        meshlet.coneCutoff = 1.0f;
+        return;
+    }
+
+    meshlet.coneAxis = axis/axisLength;
+    Float minDot = 1.0f;
+    for(const Vector3& normal: normals)
+        minDot = Math::min(minDot, Math::dot(normal, meshlet.coneAxis));
+    meshlet.coneCutoff = minDot <= 0.0f ? 1.0f : std::sqrt(1.0f - minDot*minDot);
+}
+
+}
+
+std::tuple<std::vector<Meshlet>, std::vector<UnsignedInt>, std::vector<UnsignedInt>> meshletize(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const UnsignedInt maxVertexCount, const UnsignedInt maxTriangleCount) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::meshletize(): index count is not divisible by 3", {});
+    CORRADE_ASSERT(maxVertexCount >= 3 && maxTriangleCount >= 1,
+        "MeshTools::meshletize(): expected at least 3 vertices and 1 triangle per meshlet but got" << maxVertexCount << "and" << maxTriangleCount, {});
+
+    std::vector<Meshlet> meshlets;
+    std::vector<UnsignedInt> vertices;
+    std::vector<UnsignedInt> localIndices;
+    localIndices.reserve(indices.size());
+
+    /* Local index of each vertex in the current meshlet, ~UnsignedInt{} if it
+       isn't there yet */
+    std::vector<UnsignedInt> localIndex(positions.size(), ~UnsignedInt{});
+
+    Meshlet current{0, 0, 0, 0, {}, 0.0f, {}, 0.0f};
+    auto finish = [&]() {
+        meshletBounds(current, vertices, localIndices, positions);
+        meshlets.push_back(current);
+        for(std::size_t i = current.vertexOffset; i != vertices.size(); ++i)
+            localIndex[vertices[i]] = ~UnsignedInt{};
+        current = Meshlet{UnsignedInt(localIndices.size()), 0, UnsignedInt(vertices.size()), 0, {}, 0.0f, {}, 0.0f};
+    };
+
+    for(std::size_t i = 0; i != indices.size(); i += 3) {
+        const UnsignedInt* const triangle = indices.data() + i;
+        UnsignedInt newVertexCount = 0;
+        for(std::size_t j = 0; j != 3; ++j) {
+            CORRADE_ASSERT(triangle[j] < positions.size(),
+                "MeshTools::meshletize(): index" << triangle[j] << "out of bounds for" << positions.size() << "vertices", {});
+            if(localIndex[triangle[j]] == ~UnsignedInt{} &&
+               (j < 1 || triangle[j] != triangle[0]) &&
+               (j < 2 || triangle[j] != triangle[1]))
+                ++newVertexCount;
+        }
+
+        if(current.vertexCount + newVertexCount > maxVertexCount ||
+           current.indexCount/3 == maxTriangleCount)
+            finish();
+
+        for(std::size_t j = 0; j != 3; ++j) {
+            UnsignedInt& local = localIndex[triangle[j]];
+            if(local == ~UnsignedInt{}) {
+                local = current.vertexCount++;
+                vertices.push_back(triangle[j]);
+            }
+            localIndices.push_back(local);
+        }
+        current.indexCount += 3;
+    }
+
+    if(current.indexCount) finish();
+
+    return std::make_tuple(std::move(meshlets), std::move(vertices), std::move(localIndices));
+}
+
+bool isMeshletBackFacing(const Meshlet& meshlet, const Vector3& cameraPosition) {
+    const Vector3 direction = meshlet.center - cameraPosition;
+    return Math::dot(direction, meshlet.coneAxis) >= meshlet.coneCutoff*direction.length() + meshlet.radius;
+}
+
+#ifndef MAGNUM_TARGET_GLES
+std::vector<Mesh::DrawElementsIndirectCommand> meshletDrawCommands(const std::vector<Meshlet>& meshlets, const UnsignedInt indexOffset) {
+    std::vector<Mesh::DrawElementsIndirectCommand> commands;
+    commands.reserve(meshlets.size());
+    for(std::size_t i = 0; i != meshlets.size(); ++i) {
+        const Meshlet& meshlet = meshlets[i];
+        commands.push_back({meshlet.indexCount, 1, indexOffset + meshlet.indexOffset, Int(meshlet.vertexOffset), UnsignedInt(i)});
+    }
+    return commands;
+}
+#endif
+
+}}
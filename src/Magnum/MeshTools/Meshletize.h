@@ -0,0 +1,173 @@
+#ifndef Magnum_MeshTools_Meshletize_h
+#define Magnum_MeshTools_Meshletize_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::meshletize(), @ref Magnum::MeshTools::isMeshletBackFacing(), @ref Magnum::MeshTools::meshletDrawCommands(), struct @ref Magnum::MeshTools::Meshlet
+ */
+
+#include <tuple>
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/visibility.h"
+
+#ifndef MAGNUM_TARGET_GLES
+#include "Magnum/Mesh.h"
+#endif
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Meshlet
+
+A small cluster of triangles produced by @ref meshletize().
+*/
+struct Meshlet {
+    /**
+     * @brief Offset of the first meshlet index
+     *
+     * Points into the meshlet index array returned by @ref meshletize().
+     */
+    UnsignedInt indexOffset;
+
+    /** @brief Count of meshlet indices, three for each triangle */
+    UnsignedInt indexCount;
+
+    /**
+     * @brief Offset of the first meshlet vertex
+     *
+     * Points into the vertex remap array returned by @ref meshletize().
+     */
+    UnsignedInt vertexOffset;
+
+    /** @brief Count of meshlet vertices */
+    UnsignedInt vertexCount;
+
+    /** @brief Bounding sphere center */
+    Vector3 center;
+
+    /** @brief Bounding sphere radius */
+    Float radius;
+
+    /**
+     * @brief Normal cone axis
+     *
+     * Normalized average of normals of all meshlet triangles, zero if all
+     * triangles are degenerate.
+     */
+    Vector3 coneAxis;
+
+    /**
+     * @brief Normal cone cutoff
+     *
+     * Sine of the angle between @ref coneAxis and the farthest triangle
+     * normal. The value is @cpp 1.0f @ce if the normals span more than a
+     * hemisphere and the meshlet thus can't be culled. See
+     * @ref isMeshletBackFacing() for how to use it.
+     */
+    Float coneCutoff;
+};
+
+/**
+@brief Split a mesh into meshlets
+@param indices          Index array
+@param positions        Vertex positions
+@param maxVertexCount   Max count of vertices in one meshlet
+@param maxTriangleCount Max count of triangles in one meshlet
+@return Meshlets, vertex remap array and meshlet index array
+
+Goes through the triangles in order and adds them to the current meshlet until
+it would exceed either @p maxVertexCount or @p maxTriangleCount. Because of
+that, the quality of the split depends on locality of the index array, so
+it's recommended to call @ref tipsify() on it first. The defaults correspond
+to the recommended meshlet size on current GPUs.
+
+The vertex remap array contains original vertex index for each meshlet
+vertex and can be used with @ref duplicate() to create a vertex array in
+which vertices of each meshlet form consecutive range starting at
+@ref Meshlet::vertexOffset. The meshlet index array contains indices
+relative to that offset, so they are always lower than @p maxVertexCount and
+can be compressed using @ref compressIndicesAs(). For each meshlet a
+bounding sphere and a normal cone is calculated, usable for culling whole
+meshlets.
+@code
+std::vector<UnsignedInt> indices;
+std::vector<Vector3> positions;
+
+std::vector<MeshTools::Meshlet> meshlets;
+std::vector<UnsignedInt> vertexRemap, meshletIndices;
+std::tie(meshlets, vertexRemap, meshletIndices) = MeshTools::meshletize(indices, positions);
+
+std::vector<Vector3> meshletPositions = MeshTools::duplicate(vertexRemap, positions);
+@endcode
+
+On desktop the meshlets can be drawn using @ref Mesh::drawIndirect() with
+commands created by @ref meshletDrawCommands(). Their bounding spheres can
+be copied to @ref Shaders::InstanceCullingBounds with
+@ref Shaders::InstanceCullingBounds::command set to meshlet index for GPU
+culling with @ref Shaders::InstanceCulling.
+
+@attention The function requires the mesh to have triangle faces, thus index
+    count must be divisible by 3. @p maxVertexCount is expected to be at
+    least @cpp 3 @ce and @p maxTriangleCount at least @cpp 1 @ce.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::tuple<std::vector<Meshlet>, std::vector<UnsignedInt>, std::vector<UnsignedInt>> meshletize(const std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, UnsignedInt maxVertexCount = 64, UnsignedInt maxTriangleCount = 124);
+
+/**
+@brief Whether a meshlet is back-facing
+@param meshlet          Meshlet
+@param cameraPosition   Camera position in the same coordinate system as the
+    meshlet
+
+Returns @cpp true @ce if all triangles of the meshlet are facing away from the
+camera based on its normal cone and bounding sphere. Triangles are expected to
+have counterclockwise winding.
+*/
+MAGNUM_MESHTOOLS_EXPORT bool isMeshletBackFacing(const Meshlet& meshlet, const Vector3& cameraPosition);
+
+#ifndef MAGNUM_TARGET_GLES
+/**
+@brief Indirect draw commands for meshlets
+@param meshlets         Meshlets
+@param indexOffset      Offset of the meshlet index array in the index
+    buffer, in indices
+
+Creates one command per meshlet with @cpp instanceCount @ce set to
+@cpp 1 @ce and @cpp baseInstance @ce set to meshlet index. Upload the
+result to a buffer and draw with @ref Mesh::drawIndirect(). For culling on
+the GPU via @ref Shaders::InstanceCulling set @cpp instanceCount @ce to
+@cpp 0 @ce before the culling pass.
+@requires_gl40 Extension @extension{ARB,draw_indirect}
+@requires_gl Indirect drawing is not available in OpenGL ES or WebGL.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::vector<Mesh::DrawElementsIndirectCommand> meshletDrawCommands(const std::vector<Meshlet>& meshlets, UnsignedInt indexOffset = 0);
+#endif
+
+}}
+
+#endif
@@ -0,0 +1,159 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "OptimizeOverdraw.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* FIFO post-transform vertex cache simulation, the same as in tipsify() */
+class CacheSimulation {
+    public:
+        explicit CacheSimulation(std::size_t vertexCount, std::size_t cacheSize): _time{cacheSize + 1}, _cacheSize{cacheSize}, _timestamp(vertexCount) {}
+
+        /* Returns count of cache misses caused by the triangle */
+        UnsignedInt triangle(const UnsignedInt* const vertices) {
+            UnsignedInt misses = 0;
+            for(std::size_t i = 0; i != 3; ++i) {
+                std::size_t& timestamp = _timestamp[vertices[i]];
+                if(_time - timestamp > _cacheSize) {
+                    timestamp = _time++;
+                    ++misses;
+                }
+            }
+            return misses;
+        }
+
+    private:
+        std::size_t _time;
+        const std::size_t _cacheSize;
+        std::vector<std::size_t> _timestamp;
+};
+
+}
+
+void optimizeOverdraw(std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const std::size_t cacheSize, const Float threshold) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::optimizeOverdraw(): index count is not divisible by 3!", );
+
+    const std::size_t triangleCount = indices.size()/3;
+    if(!triangleCount) return;
+
+    #ifndef CORRADE_NO_ASSERT
+    for(const UnsignedInt index: indices)
+        CORRADE_ASSERT(index < positions.size(), "MeshTools::optimizeOverdraw(): index" << index << "out of bounds for" << positions.size() << "vertices", );
+    #endif
+
+    /* Cache miss ratio of the whole mesh */
+    std::size_t misses = 0;
+    {
+        CacheSimulation cache{positions.size(), cacheSize};
+        for(std::size_t i = 0; i != triangleCount; ++i)
+            misses += cache.triangle(indices.data() + i*3);
+    }
+    const Float maxClusterMissRatio = threshold*Float(misses)/Float(triangleCount);
+
+    /* Split the mesh into clusters at triangles which don't reuse anything
+       from the cache */
+    std::vector<std::size_t> clusterOffsets{0};
+    {
+        CacheSimulation cache{positions.size(), cacheSize};
+        std::size_t clusterMisses = 0;
+        for(std::size_t i = 0; i != triangleCount; ++i) {
+            const UnsignedInt triangleMisses = cache.triangle(indices.data() + i*3);
+            const std::size_t clusterTriangleCount = i - clusterOffsets.back();
+            if(triangleMisses == 3 && clusterTriangleCount && Float(clusterMisses) <= maxClusterMissRatio*Float(clusterTriangleCount)) {
+                clusterOffsets.push_back(i);
+                clusterMisses = 0;
+            }
+
+            clusterMisses += triangleMisses;
+        }
+    }
+    clusterOffsets.push_back(triangleCount);
+
+    /* Nothing to reorder */
+    const std::size_t clusterCount = clusterOffsets.size() - 1;
+    if(clusterCount == 1) return;
+
+    /* Area-weighted centroid and normal of each cluster and the whole mesh.
+       The cross product length is twice the triangle area, which is the same
+       factor for all triangles. */
+    std::vector<Vector3> clusterCentroids(clusterCount);
+    std::vector<Vector3> clusterNormals(clusterCount);
+    Vector3 meshCentroid;
+    Float meshArea{};
+    for(std::size_t i = 0; i != clusterCount; ++i) {
+        Float clusterArea{};
+        for(std::size_t t = clusterOffsets[i]; t != clusterOffsets[i + 1]; ++t) {
+            const Vector3& a = positions[indices[t*3]];
+            const Vector3& b = positions[indices[t*3 + 1]];
+            const Vector3& c = positions[indices[t*3 + 2]];
+            const Vector3 normal = Math::cross(b - a, c - a);
+            const Float area = normal.length();
+
+            clusterCentroids[i] += (a + b + c)*area;
+            clusterNormals[i] += normal;
+            clusterArea += area;
+        }
+
+        meshCentroid += clusterCentroids[i];
+        meshArea += clusterArea;
+        if(clusterArea != 0.0f) clusterCentroids[i] /= 3.0f*clusterArea;
+    }
+    if(meshArea != 0.0f) meshCentroid /= 3.0f*meshArea;
+
+    /* Occlusion potential of each cluster -- clusters facing outwards from
+       the mesh centroid are drawn first */
+    std::vector<Float> sortKeys(clusterCount);
+    for(std::size_t i = 0; i != clusterCount; ++i) {
+        const Float normalLength = clusterNormals[i].length();
+        sortKeys[i] = normalLength != 0.0f ?
+            Math::dot(clusterCentroids[i] - meshCentroid, clusterNormals[i])/normalLength : 0.0f;
+    }
+
+    std::vector<UnsignedInt> clusterOrder(clusterCount);
+    std::iota(clusterOrder.begin(), clusterOrder.end(), 0);
+    std::stable_sort(clusterOrder.begin(), clusterOrder.end(), [&sortKeys](UnsignedInt a, UnsignedInt b) {
+        return sortKeys[a] > sortKeys[b];
+    });
+
+    /* Output index buffer */
+    std::vector<UnsignedInt> outputIndices;
+    outputIndices.reserve(indices.size());
+    for(const UnsignedInt i: clusterOrder)
+        outputIndices.insert(outputIndices.end(), indices.begin() + clusterOffsets[i]*3, indices.begin() + clusterOffsets[i + 1]*3);
+
+    /* Swap original index buffer with optimized */
+    using std::swap;
+    swap(indices, outputIndices);
+}
+
+}}
@@ -0,0 +1,71 @@
+#ifndef Magnum_MeshTools_OptimizeOverdraw_h
+#define Magnum_MeshTools_OptimizeOverdraw_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::optimizeOverdraw()
+ */
+
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Reorder triangle clusters for reduced overdraw
+@param[in,out] indices  Index array to operate on
+@param[in] positions    Vertex positions
+@param[in] cacheSize    Post-transform vertex cache size
+@param[in] threshold    Maximal allowed cache miss ratio increase
+
+Splits the index array into clusters of triangles and reorders them so the
+clusters that are most likely to occlude the rest of the mesh are drawn first,
+independently of view direction. Triangle order inside the clusters is
+preserved, so the function is meant to be called on output of @ref tipsify()
+with the same @p cacheSize.
+
+Cluster boundaries are placed at triangles for which none of the vertices is
+in the post-transform vertex cache, thus moving the cluster elsewhere doesn't
+cause any additional cache misses inside of it. The boundary is accepted only
+if average cache miss ratio (see @ref VertexCacheStatistics) of the cluster is
+not larger than average cache miss ratio of the whole mesh multiplied by
+@p threshold, larger values give more clusters and better overdraw reduction
+with slightly worse vertex cache utilization. The clusters are then sorted by
+dot product of their normal and offset of their centroid from the mesh
+centroid. Algorithm used: *Pedro V. Sander, Diego Nehab, and Joshua
+Barczak - Fast Triangle Reordering for Vertex Locality and Reduced Overdraw,
+SIGGRAPH 2007, http://gfx.cs.princeton.edu/pubs/Sander_2007_%3ETR/index.php*.
+
+@attention The function requires the mesh to have triangle faces, thus index
+    count must be divisible by 3.
+*/
+MAGNUM_MESHTOOLS_EXPORT void optimizeOverdraw(std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, std::size_t cacheSize, Float threshold = 1.05f);
+
+}}
+
+#endif
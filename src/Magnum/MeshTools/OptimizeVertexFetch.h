@@ -0,0 +1,101 @@
+#ifndef Magnum_MeshTools_OptimizeVertexFetch_h
+#define Magnum_MeshTools_OptimizeVertexFetch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::optimizeVertexFetch()
+ */
+
+#include <initializer_list>
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/Duplicate.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Optimize index array for pre-transform vertex fetch
+@param[in,out] indices  Index array to operate on
+@param[in] vertexCount  Vertex count
+@return Original vertex index for each new vertex
+
+Renumbers the vertices in order in which they are first referenced by the
+index array, so vertex data are fetched from memory in mostly linear fashion.
+Vertices that are not referenced by the index array are dropped. The returned
+array can be used with @ref duplicate() to reorder the vertex data, see
+@ref optimizeVertexFetch(std::vector<UnsignedInt>&, std::vector<T>&, std::vector<U>&...)
+for a variant that does this for you.
+
+The triangle order is not changed, so the function is meant to be called after
+@ref tipsify() and @ref optimizeOverdraw().
+*/
+MAGNUM_MESHTOOLS_EXPORT std::vector<UnsignedInt> optimizeVertexFetch(std::vector<UnsignedInt>& indices, UnsignedInt vertexCount);
+
+namespace Implementation {
+    template<class T> void reorderVertices(const std::vector<UnsignedInt>& remap, std::vector<T>& data) {
+        data = duplicate(remap, data);
+    }
+
+    template<class T, class U, class ...V> void reorderVertices(const std::vector<UnsignedInt>& remap, std::vector<T>& first, std::vector<U>& second, std::vector<V>&... next) {
+        reorderVertices(remap, first);
+        reorderVertices(remap, second, next...);
+    }
+}
+
+/**
+@brief Optimize index and vertex arrays for pre-transform vertex fetch
+@param[in,out] indices  Index array to operate on
+@param[in,out] first    First vertex attribute array
+@param[in,out] next     Other vertex attribute arrays
+
+Calls @ref optimizeVertexFetch(std::vector<UnsignedInt>&, UnsignedInt) and
+reorders all attribute arrays accordingly. All arrays are expected to have the
+same size.
+@code
+std::vector<UnsignedInt> indices;
+std::vector<Vector3> positions;
+std::vector<Vector3> normals;
+
+MeshTools::tipsify(indices, positions.size(), 24);
+MeshTools::optimizeVertexFetch(indices, positions, normals);
+@endcode
+*/
+template<class T, class ...U> void optimizeVertexFetch(std::vector<UnsignedInt>& indices, std::vector<T>& first, std::vector<U>&... next) {
+    #ifndef CORRADE_NO_ASSERT
+    for(std::size_t size: std::initializer_list<std::size_t>{next.size()...})
+        CORRADE_ASSERT(size == first.size(),
+            "MeshTools::optimizeVertexFetch(): expected arrays of size" << first.size() << "but got" << size, );
+    #endif
+
+    const std::vector<UnsignedInt> remap = optimizeVertexFetch(indices, first.size());
+    Implementation::reorderVertices(remap, first, next...);
+}
+
+}}
+
+#endif
@@ -0,0 +1,161 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Quantize.h"
+
+#include <tuple>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Packing.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Math/Algorithms/Reduce.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+template<class T> inline Short quantizeSigned(const T value) {
+    return Short(Math::round(Math::clamp(value, T(-1.0), T(1.0))*T(32767.0)));
+}
+
+template<class Quantized, class T> std::vector<Quantized> quantizePositionsImplementation(const std::vector<T>& positions, T& center, T& halfSize) {
+    std::vector<Quantized> out;
+    out.reserve(positions.size());
+    if(positions.empty()) {
+        center = {};
+        halfSize = T{1.0f};
+        return out;
+    }
+
+    T min, max;
+    std::tie(min, max) = Math::Algorithms::minmax(positions.data(), positions.size(), sizeof(T));
+
+    /* Degenerate axes are mapped to zero with unit scale */
+    center = (min + max)*0.5f;
+    halfSize = (max - min)*0.5f;
+    for(std::size_t i = 0; i != T::Size; ++i)
+        if(halfSize[i] == 0.0f) halfSize[i] = 1.0f;
+
+    for(const T& position: positions) {
+        const T normalized = (position - center)/halfSize;
+        Quantized quantized;
+        for(std::size_t i = 0; i != T::Size; ++i)
+            quantized[i] = quantizeSigned(normalized[i]);
+        out.push_back(quantized);
+    }
+
+    return out;
+}
+
+/* Projects a normal onto octahedron and unfolds it into [-1, 1]^2 square */
+Vector2 octahedralEncode(const Vector3& normal) {
+    const Vector2 projected = normal.xy()/(std::abs(normal.x()) + std::abs(normal.y()) + std::abs(normal.z()));
+    if(normal.z() >= 0.0f) return projected;
+
+    return {(1.0f - std::abs(projected.y()))*(projected.x() >= 0.0f ? 1.0f : -1.0f),
+            (1.0f - std::abs(projected.x()))*(projected.y() >= 0.0f ? 1.0f : -1.0f)};
+}
+
+Vector3 octahedralDecode(const Vector2& value) {
+    Vector3 out{value, 1.0f - std::abs(value.x()) - std::abs(value.y())};
+    if(out.z() < 0.0f) out.xy() = {
+        (1.0f - std::abs(value.y()))*(value.x() >= 0.0f ? 1.0f : -1.0f),
+        (1.0f - std::abs(value.x()))*(value.y() >= 0.0f ? 1.0f : -1.0f)};
+    return out.normalized();
+}
+
+}
+
+std::pair<std::vector<Math::Vector3<Short>>, Matrix4> quantizePositions(const std::vector<Vector3>& positions) {
+    Vector3 center, halfSize;
+    std::vector<Math::Vector3<Short>> out = quantizePositionsImplementation<Math::Vector3<Short>>(positions, center, halfSize);
+    return {std::move(out), Matrix4::translation(center)*Matrix4::scaling(halfSize)};
+}
+
+std::pair<std::vector<Math::Vector2<Short>>, Matrix3> quantizePositions(const std::vector<Vector2>& positions) {
+    Vector2 center, halfSize;
+    std::vector<Math::Vector2<Short>> out = quantizePositionsImplementation<Math::Vector2<Short>>(positions, center, halfSize);
+    return {std::move(out), Matrix3::translation(center)*Matrix3::scaling(halfSize)};
+}
+
+std::vector<Math::Vector2<Short>> quantizeNormalsOctahedral(const std::vector<Vector3>& normals) {
+    std::vector<Math::Vector2<Short>> out;
+    out.reserve(normals.size());
+
+    for(const Vector3& normal: normals) {
+        const Vector2 encoded = octahedralEncode(normal)*32767.0f;
+
+        /* Pick the rounding direction that gives the smallest error */
+        Math::Vector2<Short> best;
+        Float bestDot = -2.0f;
+        for(Int i = 0; i != 4; ++i) {
+            const Vector2 rounded{
+                i & 1 ? std::ceil(encoded.x()) : std::floor(encoded.x()),
+                i & 2 ? std::ceil(encoded.y()) : std::floor(encoded.y())};
+            const Math::Vector2<Short> candidate{Math::clamp(rounded, -32767.0f, 32767.0f)};
+            const Float dot = Math::dot(dequantizeNormalOctahedral(candidate), normal);
+            if(dot > bestDot) {
+                bestDot = dot;
+                best = candidate;
+            }
+        }
+
+        out.push_back(best);
+    }
+
+    return out;
+}
+
+Vector3 dequantizeNormalOctahedral(const Math::Vector2<Short>& normal) {
+    return octahedralDecode(Math::unpack<Vector2>(normal));
+}
+
+std::vector<UnsignedInt> quantizeNormalsPacked(const std::vector<Vector3>& normals) {
+    std::vector<UnsignedInt> out;
+    out.reserve(normals.size());
+
+    for(const Vector3& normal: normals) {
+        UnsignedInt packed = 0;
+        for(std::size_t i = 0; i != 3; ++i) {
+            const Int value = Int(Math::round(Math::clamp(normal[i], -1.0f, 1.0f)*511.0f));
+            packed |= (UnsignedInt(value) & 0x3ff) << (10*i);
+        }
+        out.push_back(packed);
+    }
+
+    return out;
+}
+
+std::vector<Math::Vector2<UnsignedShort>> quantizeTextureCoordinates(const std::vector<Vector2>& textureCoordinates) {
+    std::vector<Math::Vector2<UnsignedShort>> out;
+    out.reserve(textureCoordinates.size());
+
+    for(const Vector2& textureCoordinate: textureCoordinates)
+        out.emplace_back(Math::round(Math::clamp(textureCoordinate, 0.0f, 1.0f)*65535.0f));
+
+    return out;
+}
+
+}}
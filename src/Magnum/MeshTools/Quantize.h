@@ -0,0 +1,127 @@
+#ifndef Magnum_MeshTools_Quantize_h
+#define Magnum_MeshTools_Quantize_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::quantizePositions(), @ref Magnum::MeshTools::quantizeNormalsOctahedral(), @ref Magnum::MeshTools::quantizeNormalsPacked(), @ref Magnum::MeshTools::quantizeTextureCoordinates(), @ref Magnum::MeshTools::dequantizeNormalOctahedral()
+ */
+
+#include <utility>
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Quantize 3D positions to 16-bit integers
+@return Quantized positions and dequantization matrix
+
+Maps the bounding box of @p positions to the full range of normalized
+@ref Short. Multiplying the normalized value with the returned matrix
+gives back the original position with error at most half of the quantization
+step, which is 1/65534 of the bounding box size in given axis. When the vertex buffer is configured with
+@ref Shaders::Generic3D::Position with @ref Attribute::DataType::Short and
+@ref Attribute::DataOption::Normalized, multiply the transformation matrix
+with the dequantization matrix on the right. The normal matrix has to be
+calculated from the original transformation matrix. The positions are
+three-component, pad them to eight bytes when interleaving to keep the
+attributes aligned. See @ref compile(const Trade::MeshData3D&, BufferUsage, CompileFlags)
+for a function that does all this for you.
+
+@note OpenGL before version 4.2 maps normalized signed integers with
+    @f$ (2c + 1) / (2^{16} - 1) @f$ instead of @f$ c / (2^{15} - 1) @f$,
+    which shifts the positions by half of the quantization step.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::pair<std::vector<Math::Vector3<Short>>, Matrix4> quantizePositions(const std::vector<Vector3>& positions);
+
+/**
+@brief Quantize 2D positions to 16-bit integers
+@return Quantized positions and dequantization matrix
+
+Same as @ref quantizePositions(const std::vector<Vector3>&), but for
+@ref Shaders::Generic2D::Position.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::pair<std::vector<Math::Vector2<Short>>, Matrix3> quantizePositions(const std::vector<Vector2>& positions);
+
+/**
+@brief Quantize normals to octahedral 2x16-bit representation
+
+Projects each normal onto an octahedron, unfolds it into a square and stores
+the result in two normalized @ref Short values. Of all four rounding
+combinations the one closest to the original direction is chosen, making the
+angular error under 0.01 degrees. The normals are expected to be
+normalized. The result is meant to be used with
+@ref Shaders::Generic3D::OctahedralNormal and a shader that decodes it, such
+as @ref Shaders::Phong with @ref Shaders::Phong::Flag::OctahedralNormal.
+@see @ref dequantizeNormalOctahedral(), @ref quantizeNormalsPacked()
+*/
+MAGNUM_MESHTOOLS_EXPORT std::vector<Math::Vector2<Short>> quantizeNormalsOctahedral(const std::vector<Vector3>& normals);
+
+/**
+@brief Decode octahedral normal
+
+Inverse of @ref quantizeNormalsOctahedral(), returns normalized vector. Does
+the same thing as shaders do on the GPU.
+*/
+MAGNUM_MESHTOOLS_EXPORT Vector3 dequantizeNormalOctahedral(const Math::Vector2<Short>& normal);
+
+/**
+@brief Quantize normals to packed 10.10.10.2 representation
+
+Stores each component in 10-bit signed normalized integer, the last two bits
+are set to zero. The result is meant to be used with
+@ref Shaders::Generic3D::PackedNormal and
+@ref Attribute::DataType::Int2101010Rev, which needs no decoding in the
+shader. The precision is about ten times lower than with
+@ref quantizeNormalsOctahedral().
+@requires_gl33 Extension @extension{ARB,vertex_type_2_10_10_10_rev} for
+    rendering
+@requires_gles30 Packed attributes are not available in OpenGL ES 2.0.
+@requires_webgl20 Packed attributes are not available in WebGL 1.0.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::vector<UnsignedInt> quantizeNormalsPacked(const std::vector<Vector3>& normals);
+
+/**
+@brief Quantize texture coordinates to 16-bit integers
+
+Maps the @f$ [0, 1] @f$ range to the full range of normalized
+@ref UnsignedShort, values outside are clamped. Use with
+@ref Shaders::Generic2D::TextureCoordinates or
+@ref Shaders::Generic3D::TextureCoordinates with
+@ref Attribute::DataType::UnsignedShort and
+@ref Attribute::DataOption::Normalized, the precision is enough for textures
+up to 16384 pixels large. Repeating texture coordinates outside of the range
+can't be represented this way.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::vector<Math::Vector2<UnsignedShort>> quantizeTextureCoordinates(const std::vector<Vector2>& textureCoordinates);
+
+}}
+
+#endif
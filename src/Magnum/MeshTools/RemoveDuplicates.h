@@ -29,24 +29,154 @@
  * @brief Function @ref Magnum::MeshTools::removeDuplicates()
  */
 
+#include <cstring>
 #include <limits>
 #include <numeric>
-#include <unordered_map>
+#include <tuple>
+#include <type_traits>
 #include <vector>
-#include <Corrade/Utility/MurmurHash2.h>
+#include <Corrade/Utility/Assert.h>
 
 #include "Magnum/Magnum.h"
 #include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Algorithms/Reduce.h"
 
 namespace Magnum { namespace MeshTools {
 
 namespace Implementation {
-    template<std::size_t size> class VectorHash {
+    inline std::size_t hashCombine(std::size_t seed, std::size_t value) {
+        return seed ^ (value + std::size_t(0x9e3779b97f4a7c15ull) + (seed << 6) + (seed >> 2));
+    }
+
+    /* Hashes the binary representation of given value, processing it in
+       32-bit words */
+    template<class T> std::size_t hashBits(const T& value) {
+        const char* const data = reinterpret_cast<const char*>(&value);
+        std::size_t hash = sizeof(T);
+        std::size_t i = 0;
+        for(; i + sizeof(UnsignedInt) <= sizeof(T); i += sizeof(UnsignedInt)) {
+            UnsignedInt word;
+            std::memcpy(&word, data + i, sizeof(UnsignedInt));
+            hash = hashCombine(hash, word*0x9e3779b1u);
+        }
+        for(; i != sizeof(T); ++i)
+            hash = hashCombine(hash, UnsignedByte(data[i]));
+        return hash;
+    }
+
+    template<std::size_t size> std::size_t hashVector(const Math::Vector<size, std::size_t>& data) {
+        std::size_t hash = size;
+        for(std::size_t i = 0; i != size; ++i)
+            hash = hashCombine(hash, data[i]*std::size_t(0x9e3779b97f4a7c15ull));
+        return hash;
+    }
+
+    /* Open-addressing hash table with linear probing, storing just indices
+       of unique items. The keys are not stored, the caller-supplied
+       comparator compares directly with the unique item data. */
+    class DuplicateTable {
         public:
-            std::size_t operator()(const Math::Vector<size, std::size_t>& data) const {
-                return *reinterpret_cast<const std::size_t*>(Utility::MurmurHash2()(reinterpret_cast<const char*>(&data), sizeof(data)).byteArray());
+            explicit DuplicateTable(std::size_t count) {
+                /* Keep the load factor below 2/3 */
+                std::size_t capacity = 16;
+                while(capacity < count + count/2) capacity <<= 1;
+                _slots.assign(capacity, Empty);
+                _mask = capacity - 1;
             }
+
+            /* Returns index of an existing equal item or inserts the
+               candidate if there's none. The candidate is always the number
+               of unique items inserted so far. */
+            template<class Equals> std::pair<UnsignedInt, bool> insert(std::size_t hash, UnsignedInt candidate, Equals equals) {
+                for(std::size_t i = hash & _mask; ; i = (i + 1) & _mask) {
+                    if(_slots[i] == Empty) {
+                        _slots[i] = candidate;
+                        return {candidate, true};
+                    }
+                    if(equals(_slots[i])) return {_slots[i], false};
+                }
+            }
+
+            void clear() {
+                std::fill(_slots.begin(), _slots.end(), Empty);
+            }
+
+        private:
+            enum: UnsignedInt { Empty = ~UnsignedInt{} };
+
+            std::vector<UnsignedInt> _slots;
+            std::size_t _mask;
     };
+
+    template<class T> std::size_t hashVertex(std::size_t i, const std::vector<T>& data) {
+        return hashBits(data[i]);
+    }
+
+    template<class T, class U, class ...V> std::size_t hashVertex(std::size_t i, const std::vector<T>& first, const std::vector<U>& second, const std::vector<V>&... next) {
+        return hashCombine(hashBits(first[i]), hashVertex(i, second, next...));
+    }
+
+    template<class T> bool equalVertex(std::size_t a, std::size_t b, const std::vector<T>& data) {
+        return std::memcmp(&data[a], &data[b], sizeof(T)) == 0;
+    }
+
+    template<class T, class U, class ...V> bool equalVertex(std::size_t a, std::size_t b, const std::vector<T>& first, const std::vector<U>& second, const std::vector<V>&... next) {
+        return equalVertex(a, b, first) && equalVertex(a, b, second, next...);
+    }
+
+    template<class T> void moveVertex(std::size_t from, std::size_t to, std::vector<T>& data) {
+        data[to] = data[from];
+    }
+
+    template<class T, class U, class ...V> void moveVertex(std::size_t from, std::size_t to, std::vector<T>& first, std::vector<U>& second, std::vector<V>&... next) {
+        moveVertex(from, to, first);
+        moveVertex(from, to, second, next...);
+    }
+
+    template<class T> void resizeVertices(std::size_t size, std::vector<T>& data) {
+        data.resize(size);
+    }
+
+    template<class T, class U, class ...V> void resizeVertices(std::size_t size, std::vector<T>& first, std::vector<U>& second, std::vector<V>&... next) {
+        resizeVertices(size, first);
+        resizeVertices(size, second, next...);
+    }
+
+    /* Single pass over all arrays, comparing binary representation of the
+       items */
+    template<class T, class ...U> std::vector<UnsignedInt> removeExactDuplicates(std::vector<T>& first, std::vector<U>&... next) {
+        const std::size_t size = first.size();
+        std::vector<UnsignedInt> indices;
+        indices.reserve(size);
+
+        DuplicateTable table{size};
+        UnsignedInt count = 0;
+        for(std::size_t i = 0; i != size; ++i) {
+            const auto result = table.insert(hashVertex(i, first, next...), count, [&](UnsignedInt unique) {
+                return equalVertex(unique, i, first, next...);
+            });
+
+            indices.push_back(result.first);
+
+            /* If this is new combination, copy the data to new (earlier)
+               position in the array */
+            if(result.second) {
+                if(i != count) moveVertex(i, count, first, next...);
+                ++count;
+            }
+        }
+
+        resizeVertices(count, first, next...);
+        return indices;
+    }
+
+    template<class T> constexpr bool isExactEpsilon(T epsilon, std::true_type) {
+        return epsilon <= T(1);
+    }
+
+    template<class T> constexpr bool isExactEpsilon(T epsilon, std::false_type) {
+        return epsilon == T(0);
+    }
 }
 
 /**
@@ -58,9 +188,14 @@ namespace Implementation {
 
 Removes duplicate data from the array by collapsing them into buckets of size
 @p epsilon. First vector in given bucket is used, other ones are thrown away,
-no interpolation is done. Note that this function is meant to be used for
-floating-point data (or generally with non-zero @p epsilon), for discrete data
-the usual sorting method is much more efficient.
+no interpolation is done. The buckets are looked up in an open-addressing hash
+table, the operation is done in `Vector::Size + 1` linear passes over the data
+to merge also vectors that end up in neighboring buckets.
+
+If @p epsilon is zero (or not larger than @cpp 1 @ce for integral types), the
+data are compared exactly and only a single pass is done. See also
+@ref removeDuplicates(std::vector<T>&, std::vector<U>&, std::vector<V>&...)
+for removing exact duplicates in more arrays at once.
 
 If you want to remove duplicate data from already indexed array, first remove
 duplicates as if the array wasn't indexed at all and then use @ref duplicate()
@@ -90,12 +225,15 @@ std::vector<UnsignedInt> indices = MeshTools::combineIndexedArrays(
 @endcode
 */
 template<class Vector> std::vector<UnsignedInt> removeDuplicates(std::vector<Vector>& data, typename Vector::Type epsilon = Math::TypeTraits<typename Vector::Type>::epsilon()) {
+    if(data.empty()) return {};
+
+    /* Discrete data, no need to do the bucketing */
+    if(Implementation::isExactEpsilon(epsilon, std::is_integral<typename Vector::Type>{}))
+        return Implementation::removeExactDuplicates(data);
+
     /* Get bounds */
-    Vector min = data[0], max = data[0];
-    for(const auto& v: data) {
-        min = Math::min(v, min);
-        max = Math::max(v, max);
-    }
+    Vector min, max;
+    std::tie(min, max) = Math::Algorithms::minmax(data.data(), data.size(), sizeof(Vector));
 
     /* Make epsilon so large that std::size_t can index all vectors inside the
        bounds. */
@@ -105,10 +243,10 @@ template<class Vector> std::vector<UnsignedInt> removeDuplicates(std::vector<Vec
     std::vector<UnsignedInt> resultIndices(data.size());
     std::iota(resultIndices.begin(), resultIndices.end(), 0);
 
-    /* Table containing original vector index for each discretized vector.
+    /* Table containing index of unique vector for each discretized vector.
        Reserving more buckets than necessary (i.e. as if each vector was
        unique). */
-    std::unordered_map<Math::Vector<Vector::Size, std::size_t>, UnsignedInt, Implementation::VectorHash<Vector::Size>> table(data.size());
+    Implementation::DuplicateTable table{data.size()};
 
     /* Index array for each pass, new data array */
     std::vector<UnsignedInt> indices;
@@ -118,23 +256,35 @@ template<class Vector> std::vector<UnsignedInt> removeDuplicates(std::vector<Vec
        direction. */
     Vector moved;
     for(std::size_t moving = 0; moving <= Vector::Size; ++moving) {
+        const auto discretize = [&](const Vector& v) {
+            return Math::Vector<Vector::Size, std::size_t>((v + moved - min)/epsilon);
+        };
+
         /* Go through all vectors */
+        UnsignedInt count = 0;
         for(std::size_t i = 0; i != data.size(); ++i) {
-            /* Try to insert new vertex to the table */
-            const Math::Vector<Vector::Size, std::size_t> v((data[i] + moved - min)/epsilon);
-            const auto result = table.emplace(v, table.size());
+            /* Try to insert new vertex to the table. The unique vectors are
+               already moved to the front of the array, so the key is
+               recalculated from there instead of being stored. */
+            const Math::Vector<Vector::Size, std::size_t> v = discretize(data[i]);
+            const auto result = table.insert(Implementation::hashVector(v), count, [&](UnsignedInt unique) {
+                return discretize(data[unique]) == v;
+            });
 
             /* Add the (either new or already existing) index to index array */
-            indices.push_back(result.first->second);
+            indices.push_back(result.first);
 
             /* If this is new combination, copy the data to new (earlier)
                possition in the array */
-            if(result.second && i != table.size()-1) data[table.size()-1] = data[i];
+            if(result.second) {
+                if(i != count) data[count] = data[i];
+                ++count;
+            }
         }
 
         /* Shrink the data array */
-        CORRADE_INTERNAL_ASSERT(data.size() >= table.size());
-        data.resize(table.size());
+        CORRADE_INTERNAL_ASSERT(data.size() >= count);
+        data.resize(count);
 
         /* Remap the resulting index array */
         for(auto& i: resultIndices) i = indices[i];
@@ -154,6 +304,43 @@ template<class Vector> std::vector<UnsignedInt> removeDuplicates(std::vector<Vec
     return resultIndices;
 }
 
+/**
+@brief Remove exact duplicate vertices from given set of arrays
+@param[in,out] first    First vertex attribute array
+@param[in,out] second   Second vertex attribute array
+@param[in,out] next     Other vertex attribute arrays
+@return Index array
+
+Treats items with the same index in all arrays as a single vertex and removes
+vertices that have all attributes bitwise equal in a single pass, compacting
+all arrays in-place. Unlike using @ref removeDuplicates(std::vector<Vector>&, typename Vector::Type)
+on each array separately and combining the index arrays with
+@ref combineIndexedArrays() afterwards, the returned index array can be used
+directly with the resulting arrays. All arrays are expected to have the same
+size.
+@code
+std::vector<Vector3> positions;
+std::vector<Vector3> normals;
+std::vector<Vector2> texCoords;
+
+std::vector<UnsignedInt> indices = MeshTools::removeDuplicates(positions, normals, texCoords);
+@endcode
+
+Note that the comparison is done on the binary representation, so e.g.
+@cpp 0.0f @ce and @cpp -0.0f @ce are treated as different values. If you need
+fuzzy comparison, remove the duplicates in each array with given epsilon first
+and then use the above.
+*/
+template<class T, class U, class ...V> std::vector<UnsignedInt> removeDuplicates(std::vector<T>& first, std::vector<U>& second, std::vector<V>&... next) {
+    #ifndef CORRADE_NO_ASSERT
+    for(std::size_t size: {second.size(), next.size()...})
+        CORRADE_ASSERT(size == first.size(),
+            "MeshTools::removeDuplicates(): expected arrays of size" << first.size() << "but got" << size, {});
+    #endif
+
+    return Implementation::removeExactDuplicates(first, second, next...);
+}
+
 }}
 
 #endif
@@ -0,0 +1,363 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Simplify.h"
+
+#include <cstring>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+typedef Math::Vector3<Double> Vector3d;
+
+/* Symmetric error quadric, the error for a point v is
+   vᵀAv + 2bᵀv + c. The weight is a sum of areas of all triangles that
+   contributed to it, used to turn the sum into a mean. */
+struct Quadric {
+    Double a00, a11, a22, a01, a02, a12, b0, b1, b2, c, weight;
+
+    Quadric& operator+=(const Quadric& other) {
+        a00 += other.a00; a11 += other.a11; a22 += other.a22;
+        a01 += other.a01; a02 += other.a02; a12 += other.a12;
+        b0 += other.b0; b1 += other.b1; b2 += other.b2;
+        c += other.c;
+        weight += other.weight;
+        return *this;
+    }
+};
+
+/* Adds a plane with given normal and passing through given point */
+void addPlane(Quadric& q, const Vector3d& n, const Vector3d& point, const Double weight) {
+    const Double d = -Math::dot(n, point);
+    q.a00 += weight*n.x()*n.x();
+    q.a11 += weight*n.y()*n.y();
+    q.a22 += weight*n.z()*n.z();
+    q.a01 += weight*n.x()*n.y();
+    q.a02 += weight*n.x()*n.z();
+    q.a12 += weight*n.y()*n.z();
+    q.b0 += weight*n.x()*d;
+    q.b1 += weight*n.y()*d;
+    q.b2 += weight*n.z()*d;
+    q.c += weight*d*d;
+}
+
+Double quadricError(const Quadric& a, const Quadric& b, const Vector3& position) {
+    const Double x = position.x(), y = position.y(), z = position.z();
+    const Double error =
+        (a.a00 + b.a00)*x*x + (a.a11 + b.a11)*y*y + (a.a22 + b.a22)*z*z +
+        2.0*((a.a01 + b.a01)*x*y + (a.a02 + b.a02)*x*z + (a.a12 + b.a12)*y*z) +
+        2.0*((a.b0 + b.b0)*x + (a.b1 + b.b1)*y + (a.b2 + b.b2)*z) +
+        (a.c + b.c);
+    const Double weight = a.weight + b.weight;
+    return weight > 0.0 ? Math::max(error, 0.0)/weight : Math::max(error, 0.0);
+}
+
+enum class VertexKind: UnsignedByte {
+    Interior,   /* can collapse anywhere */
+    Border,     /* can collapse only along the border */
+    Locked      /* can't collapse */
+};
+
+/* Triangles around each vertex in a compressed layout, triangles around
+   vertex i are in data[offsets[i]] to data[offsets[i + 1]] */
+struct Adjacency {
+    std::vector<UnsignedInt> offsets, data;
+};
+
+void buildAdjacency(Adjacency& adjacency, const std::vector<UnsignedInt>& indices, const std::size_t vertexCount) {
+    adjacency.offsets.assign(vertexCount + 1, 0);
+    for(const UnsignedInt index: indices) ++adjacency.offsets[index + 1];
+    for(std::size_t i = 0; i != vertexCount; ++i)
+        adjacency.offsets[i + 1] += adjacency.offsets[i];
+
+    adjacency.data.resize(indices.size());
+    std::vector<UnsignedInt> fill{adjacency.offsets.begin(), adjacency.offsets.end() - 1};
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        adjacency.data[fill[indices[i]]++] = i/3;
+}
+
+/* Whether there's another triangle than given one sharing edge a-b */
+bool hasTwin(const Adjacency& adjacency, const std::vector<UnsignedInt>& indices, const UnsignedInt a, const UnsignedInt b, const UnsignedInt triangle) {
+    for(UnsignedInt i = adjacency.offsets[a]; i != adjacency.offsets[a + 1]; ++i) {
+        const UnsignedInt other = adjacency.data[i];
+        if(other == triangle) continue;
+        const UnsignedInt* const t = indices.data() + other*3;
+        if(t[0] == b || t[1] == b || t[2] == b) return true;
+    }
+
+    return false;
+}
+
+struct Collapse {
+    Float error;
+    UnsignedInt from, to;
+};
+
+/* Counting sort by upper 16 bits of the error. Errors are non-negative, for
+   which the IEEE 754 bit representation is monotonic, and the coarse sort
+   order is good enough for the greedy collapse. */
+void sortCollapses(std::vector<Collapse>& collapses, std::vector<Collapse>& out) {
+    std::vector<UnsignedInt> histogram(65536 + 1);
+    const auto key = [](const Float error) {
+        UnsignedInt bits;
+        std::memcpy(&bits, &error, sizeof(bits));
+        return bits >> 16;
+    };
+    for(const Collapse& collapse: collapses) ++histogram[key(collapse.error) + 1];
+    for(std::size_t i = 0; i != 65536; ++i) histogram[i + 1] += histogram[i];
+
+    out.resize(collapses.size());
+    for(const Collapse& collapse: collapses)
+        out[histogram[key(collapse.error)]++] = collapse;
+}
+
+std::vector<UnsignedInt> simplifyImplementation(std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const std::vector<Vector3>& normals, const Float normalWeight, const std::vector<Vector2>& textureCoordinates, const Float textureCoordinateWeight, const std::size_t targetIndexCount, const Float targetError, const SimplifyFlags flags) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::simplify(): index count is not divisible by 3", {});
+    CORRADE_ASSERT(normals.empty() || normals.size() == positions.size(),
+        "MeshTools::simplify(): expected" << positions.size() << "normals but got" << normals.size(), {});
+    CORRADE_ASSERT(textureCoordinates.empty() || textureCoordinates.size() == positions.size(),
+        "MeshTools::simplify(): expected" << positions.size() << "texture coordinates but got" << textureCoordinates.size(), {});
+
+    const std::size_t vertexCount = positions.size();
+
+    /* Errors are relative to the largest bounding box dimension */
+    Vector3 min{Constants::inf()}, max{-Constants::inf()};
+    for(const UnsignedInt index: indices) {
+        min = Math::min(min, positions[index]);
+        max = Math::max(max, positions[index]);
+    }
+    const Double extent = indices.empty() ? 1.0 : Math::max(Double((max - min).max()), 1.0e-30);
+    const Double errorScale = 1.0/(extent*extent);
+    const Double errorLimit = Double(targetError)*Double(targetError);
+
+    Adjacency adjacency;
+    buildAdjacency(adjacency, indices, vertexCount);
+
+    /* Vertex quadrics from area-weighted planes of adjacent triangles. Find
+       boundary edges, their vertices can move only along the boundary, and add
+       planes perpendicular to them, weighted heavily so the boundary stays in
+       place. */
+    std::vector<Quadric> quadrics(vertexCount, Quadric{});
+    std::vector<VertexKind> kinds(vertexCount, VertexKind::Interior);
+    for(std::size_t i = 0; i != indices.size()/3; ++i) {
+        const UnsignedInt* const t = indices.data() + i*3;
+        const Vector3d a{positions[t[0]]}, b{positions[t[1]]}, c{positions[t[2]]};
+        const Vector3d cross = Math::cross(b - a, c - a);
+        const Double area = cross.length();
+        if(area == 0.0) continue;
+
+        const Vector3d normal = cross/area;
+        for(std::size_t j = 0; j != 3; ++j) {
+            addPlane(quadrics[t[j]], normal, a, area*0.5);
+            quadrics[t[j]].weight += area*0.5;
+        }
+
+        for(std::size_t j = 0; j != 3; ++j) {
+            const UnsignedInt from = t[j], to = t[(j + 1)%3];
+            if(hasTwin(adjacency, indices, from, to, i)) continue;
+
+            const VertexKind kind = flags & SimplifyFlag::LockBorder ? VertexKind::Locked : VertexKind::Border;
+            kinds[from] = kinds[to] = kind;
+
+            const Vector3d edge = Vector3d{positions[to]} - Vector3d{positions[from]};
+            const Double length = edge.length();
+            if(length == 0.0) continue;
+            const Vector3d edgeNormal = Math::cross(edge/length, normal);
+            addPlane(quadrics[from], edgeNormal, Vector3d{positions[from]}, 1000.0*length*length);
+            addPlane(quadrics[to], edgeNormal, Vector3d{positions[from]}, 1000.0*length*length);
+        }
+    }
+
+    const auto collapseError = [&](const UnsignedInt from, const UnsignedInt to) {
+        Double error = quadricError(quadrics[from], quadrics[to], positions[to])*errorScale;
+        if(!normals.empty())
+            error += normalWeight*(normals[from] - normals[to]).dot();
+        if(!textureCoordinates.empty())
+            error += textureCoordinateWeight*(textureCoordinates[from] - textureCoordinates[to]).dot();
+        return error;
+    };
+
+    const auto canCollapse = [&](const UnsignedInt from, const UnsignedInt to, const bool borderEdge) {
+        switch(kinds[from]) {
+            case VertexKind::Interior: return true;
+            case VertexKind::Border: return borderEdge && kinds[to] != VertexKind::Interior;
+            case VertexKind::Locked: return false;
+        }
+
+        CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+    };
+
+    std::vector<Collapse> collapses, sorted;
+    std::vector<UnsignedInt> remap(vertexCount);
+    std::vector<bool> collapsed(vertexCount);
+    for(;;) {
+        if(indices.size() <= targetIndexCount) break;
+
+        /* Gather the cheapest allowed direction for each edge. Edges shared by
+           two triangles are seen twice, take them only once. */
+        collapses.clear();
+        for(std::size_t i = 0; i != indices.size()/3; ++i) {
+            const UnsignedInt* const t = indices.data() + i*3;
+            for(std::size_t j = 0; j != 3; ++j) {
+                const UnsignedInt a = t[j], b = t[(j + 1)%3];
+                const bool borderEdge = !hasTwin(adjacency, indices, a, b, i);
+                if(!borderEdge && a > b) continue;
+
+                const bool ab = canCollapse(a, b, borderEdge);
+                const bool ba = canCollapse(b, a, borderEdge);
+                if(!ab && !ba) continue;
+
+                const Double errorAB = ab ? collapseError(a, b) : Constants::inf();
+                const Double errorBA = ba ? collapseError(b, a) : Constants::inf();
+                if(errorAB <= errorBA) collapses.push_back({Float(errorAB), a, b});
+                else collapses.push_back({Float(errorBA), b, a});
+            }
+        }
+        if(collapses.empty()) break;
+
+        sortCollapses(collapses, sorted);
+
+        /* Perform the collapses in order. Each vertex can take part in only
+           one collapse per pass, so the triangles around the collapsed vertex
+           are at most one remap step away from their current state. */
+        for(std::size_t i = 0; i != vertexCount; ++i) remap[i] = i;
+        std::fill(collapsed.begin(), collapsed.end(), false);
+        std::size_t indexCount = indices.size();
+        std::size_t collapseCount = 0;
+        bool errorReached = false;
+        for(const Collapse& collapse: sorted) {
+            if(indexCount <= targetIndexCount) break;
+            if(collapse.error > errorLimit) {
+                errorReached = true;
+                break;
+            }
+
+            const UnsignedInt from = collapse.from, to = collapse.to;
+            if(collapsed[from] || collapsed[to]) continue;
+
+            /* Reject the collapse if any of the remaining triangles would flip
+               or become degenerate or if there would be no triangles left */
+            bool valid = true;
+            std::size_t removed = 0, remaining = 0;
+            for(UnsignedInt k = adjacency.offsets[from]; k != adjacency.offsets[from + 1]; ++k) {
+                const UnsignedInt* const t = indices.data() + adjacency.data[k]*3;
+                const UnsignedInt r[]{remap[t[0]], remap[t[1]], remap[t[2]]};
+                if(r[0] == r[1] || r[0] == r[2] || r[1] == r[2]) continue;
+                if(r[0] == to || r[1] == to || r[2] == to) {
+                    ++removed;
+                    continue;
+                }
+
+                const Vector3 before[]{positions[r[0]], positions[r[1]], positions[r[2]]};
+                Vector3 after[3];
+                for(std::size_t j = 0; j != 3; ++j)
+                    after[j] = r[j] == from ? positions[to] : before[j];
+                const Vector3 normalBefore = Math::cross(before[1] - before[0], before[2] - before[0]);
+                const Vector3 normalAfter = Math::cross(after[1] - after[0], after[2] - after[0]);
+                if(Math::dot(normalBefore, normalAfter) <= 0.0f) {
+                    valid = false;
+                    break;
+                }
+
+                ++remaining;
+            }
+            if(!valid) continue;
+            if(!remaining) for(UnsignedInt k = adjacency.offsets[to]; k != adjacency.offsets[to + 1]; ++k) {
+                const UnsignedInt* const t = indices.data() + adjacency.data[k]*3;
+                const UnsignedInt r[]{remap[t[0]], remap[t[1]], remap[t[2]]};
+                if(r[0] == r[1] || r[0] == r[2] || r[1] == r[2]) continue;
+                if(r[0] == from || r[1] == from || r[2] == from) continue;
+                ++remaining;
+                break;
+            }
+            if(!remaining) continue;
+
+            remap[from] = to;
+            quadrics[to] += quadrics[from];
+            collapsed[from] = collapsed[to] = true;
+            indexCount -= removed*3;
+            ++collapseCount;
+        }
+
+        /* Apply the collapses and drop degenerate triangles */
+        std::size_t out = 0;
+        for(std::size_t i = 0; i != indices.size(); i += 3) {
+            const UnsignedInt a = remap[indices[i]], b = remap[indices[i + 1]], c = remap[indices[i + 2]];
+            if(a == b || a == c || b == c) continue;
+            indices[out++] = a;
+            indices[out++] = b;
+            indices[out++] = c;
+        }
+        indices.resize(out);
+
+        if(!collapseCount || errorReached) break;
+
+        buildAdjacency(adjacency, indices, vertexCount);
+    }
+
+    return optimizeVertexFetch(indices, vertexCount);
+}
+
+}
+
+std::vector<UnsignedInt> simplify(std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const std::size_t targetIndexCount, const Float targetError, const SimplifyFlags flags) {
+    return simplifyImplementation(indices, positions, {}, 0.0f, {}, 0.0f, targetIndexCount, targetError, flags);
+}
+
+std::vector<UnsignedInt> simplify(std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const std::vector<Vector3>& normals, const Float normalWeight, const std::vector<Vector2>& textureCoordinates, const Float textureCoordinateWeight, const std::size_t targetIndexCount, const Float targetError, const SimplifyFlags flags) {
+    return simplifyImplementation(indices, positions, normals, normalWeight, textureCoordinates, textureCoordinateWeight, targetIndexCount, targetError, flags);
+}
+
+Trade::MeshData3D simplify(const Trade::MeshData3D& meshData, const std::size_t targetIndexCount, const Float targetError, const SimplifyFlags flags) {
+    CORRADE_ASSERT(meshData.primitive() == MeshPrimitive::Triangles && meshData.isIndexed(),
+        "MeshTools::simplify(): expected indexed triangle mesh",
+        (Trade::MeshData3D{MeshPrimitive::Triangles, {}, {{}}, {}, {}, {}}));
+
+    std::vector<UnsignedInt> indices = meshData.indices();
+    const std::vector<UnsignedInt> remap = simplify(indices, meshData.positions(0), targetIndexCount, targetError, flags);
+
+    std::vector<std::vector<Vector3>> positions;
+    for(UnsignedInt i = 0; i != meshData.positionArrayCount(); ++i)
+        positions.push_back(duplicate(remap, meshData.positions(i)));
+    std::vector<std::vector<Vector3>> normals;
+    for(UnsignedInt i = 0; i != meshData.normalArrayCount(); ++i)
+        normals.push_back(duplicate(remap, meshData.normals(i)));
+    std::vector<std::vector<Vector2>> textureCoords2D;
+    for(UnsignedInt i = 0; i != meshData.textureCoords2DArrayCount(); ++i)
+        textureCoords2D.push_back(duplicate(remap, meshData.textureCoords2D(i)));
+    std::vector<std::vector<Color4>> colors;
+    for(UnsignedInt i = 0; i != meshData.colorArrayCount(); ++i)
+        colors.push_back(duplicate(remap, meshData.colors(i)));
+
+    return Trade::MeshData3D{MeshPrimitive::Triangles, std::move(indices), std::move(positions), std::move(normals), std::move(textureCoords2D), std::move(colors), meshData.importerState()};
+}
+
+}}
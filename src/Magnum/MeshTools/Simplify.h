@@ -0,0 +1,190 @@
+#ifndef Magnum_MeshTools_Simplify_h
+#define Magnum_MeshTools_Simplify_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::simplify(), enum @ref Magnum::MeshTools::SimplifyFlag, enum set @ref Magnum::MeshTools::SimplifyFlags
+ */
+
+#include <initializer_list>
+#include <vector>
+#include <Corrade/Containers/EnumSet.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/MeshTools/OptimizeVertexFetch.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Simplification flag
+
+@see @ref SimplifyFlags, @ref simplify()
+*/
+enum class SimplifyFlag: UnsignedByte {
+    /**
+     * Don't move vertices on the mesh boundary, including seams where
+     * vertices are split, at all. Useful for simplifying parts of a larger
+     * mesh independently without opening cracks between them. By default
+     * the boundary vertices can collapse along the boundary if they don't
+     * change its shape.
+     */
+    LockBorder = 1 << 0
+};
+
+/**
+@brief Simplification flags
+
+@see @ref simplify()
+*/
+typedef Containers::EnumSet<SimplifyFlag> SimplifyFlags;
+
+CORRADE_ENUMSET_OPERATORS(SimplifyFlags)
+
+/**
+@brief Simplify a triangle mesh
+@param[in,out] indices      Index array to operate on
+@param[in] positions        Vertex positions
+@param[in] targetIndexCount Index count to reduce the mesh to
+@param[in] targetError      Maximal error, relative to the mesh extent
+@param[in] flags            Flags
+@return Original vertex index for each new vertex
+
+Collapses edges with the lowest quadric error metric (Garland and Heckbert)
+until at most @p targetIndexCount indices are left, there's no collapse with
+error below @p targetError or no collapse that wouldn't flip any triangle or
+remove the last triangle around given vertex. The error is a root mean square
+distance to the planes of the original triangles around the collapsed
+vertices, relative to the largest dimension of the mesh bounding box, so for
+example @cpp 0.01f @ce allows roughly one percent deviation from the original
+surface.
+
+Edges are collapsed onto one of their vertices, so the simplified mesh
+references only a subset of the original vertices and all other attributes
+can be reused unchanged. Vertices on the mesh boundary, including seams where
+vertices are split, can collapse only along the boundary and the boundary
+shape is preserved by additional planes perpendicular to it. Use
+@ref SimplifyFlag::LockBorder to keep them in place.
+
+The collapses are done in passes. Each pass calculates the cost of all edges,
+sorts them and collapses as many of them in order as possible, with each
+vertex taking part in at most one collapse. This makes the time spent roughly
+linear to the triangle count, with meshes of millions of triangles being
+simplified in a few seconds.
+
+The vertices are renumbered using @ref optimizeVertexFetch(), unreferenced
+vertices are dropped. The returned array can be used with @ref duplicate() to
+reorder the vertex data, see
+@ref simplify(std::vector<UnsignedInt>&, std::size_t, std::vector<Vector3>&, std::vector<T>&...)
+for a variant that does this for you.
+
+The function is meant for offline generation of level-of-detail chains, see
+@ref SceneGraph::LevelOfDetail for selecting between them at runtime.
+
+@attention The function requires the mesh to have triangle faces, thus index
+    count must be divisible by 3.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::vector<UnsignedInt> simplify(std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, std::size_t targetIndexCount, Float targetError = Constants::inf(), SimplifyFlags flags = {});
+
+/**
+@brief Simplify a triangle mesh with respect to its attributes
+@param[in,out] indices      Index array to operate on
+@param[in] positions        Vertex positions
+@param[in] normals          Vertex normals or empty array
+@param[in] normalWeight     Weight of normal difference
+@param[in] textureCoordinates Vertex texture coordinates or empty array
+@param[in] textureCoordinateWeight Weight of texture coordinate difference
+@param[in] targetIndexCount Index count to reduce the mesh to
+@param[in] targetError      Maximal error, relative to the mesh extent
+@param[in] flags            Flags
+@return Original vertex index for each new vertex
+
+Same as @ref simplify(std::vector<UnsignedInt>&, const std::vector<Vector3>&, std::size_t, Float, SimplifyFlags),
+but the squared difference of normals and texture coordinates of the two
+vertices multiplied by given weight is added to the squared error of each
+collapse. For example with @p normalWeight set to @cpp 0.0001f @ce, replacing
+a normal with one that's 60° off costs as much as moving the vertex by one
+percent of the mesh extent. The attribute arrays are expected to be either
+empty or have the same size as @p positions.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::vector<UnsignedInt> simplify(std::vector<UnsignedInt>& indices, const std::vector<Vector3>& positions, const std::vector<Vector3>& normals, Float normalWeight, const std::vector<Vector2>& textureCoordinates, Float textureCoordinateWeight, std::size_t targetIndexCount, Float targetError = Constants::inf(), SimplifyFlags flags = {});
+
+/**
+@brief Simplify a triangle mesh and its vertex data
+@param[in,out] indices      Index array to operate on
+@param[in] targetIndexCount Index count to reduce the mesh to
+@param[in,out] positions    Vertex positions
+@param[in,out] next         Other vertex attribute arrays
+
+Calls @ref simplify(std::vector<UnsignedInt>&, const std::vector<Vector3>&, std::size_t, Float, SimplifyFlags)
+and reorders all attribute arrays accordingly. All arrays are expected to have
+the same size.
+@code
+std::vector<UnsignedInt> indices;
+std::vector<Vector3> positions;
+std::vector<Vector3> normals;
+
+MeshTools::simplify(indices, indices.size()/4, positions, normals);
+@endcode
+*/
+template<class ...T> void simplify(std::vector<UnsignedInt>& indices, std::size_t targetIndexCount, std::vector<Vector3>& positions, std::vector<T>&... next) {
+    #ifndef CORRADE_NO_ASSERT
+    for(std::size_t size: std::initializer_list<std::size_t>{next.size()...})
+        CORRADE_ASSERT(size == positions.size(),
+            "MeshTools::simplify(): expected arrays of size" << positions.size() << "but got" << size, );
+    #endif
+
+    const std::vector<UnsignedInt> remap = simplify(indices, positions, targetIndexCount);
+    Implementation::reorderVertices(remap, positions, next...);
+}
+
+/**
+@brief Simplify mesh data
+@param meshData         Indexed triangle mesh
+@param targetIndexCount Index count to reduce the mesh to
+@param targetError      Maximal error, relative to the mesh extent
+@param flags            Flags
+
+Simplifies the mesh based on its first position array and reorders all other
+vertex arrays accordingly. Generate a level-of-detail chain by repeatedly
+calling this function:
+@code
+std::vector<Trade::MeshData3D> levels;
+levels.push_back(*importer.mesh3D(0));
+for(std::size_t i = 1; i != 4; ++i)
+    levels.push_back(MeshTools::simplify(levels.back(), levels.back().indices().size()/2));
+@endcode
+
+@attention The mesh is expected to be indexed and have
+    @ref MeshPrimitive::Triangles primitive.
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData3D simplify(const Trade::MeshData3D& meshData, std::size_t targetIndexCount, Float targetError = Constants::inf(), SimplifyFlags flags = {});
+
+}}
+
+#endif
@@ -0,0 +1,227 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Skin.h"
+
+#include <cstring>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/DualQuaternion.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/MeshTools/Implementation/parallelFor.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Four floats processed at once, with a scalar fallback so the kernels are
+   written only once */
+#ifdef __SSE2__
+typedef __m128 Lane;
+inline Lane load(const Float* const data) { return _mm_loadu_ps(data); }
+inline void store(Float* const data, const Lane a) { _mm_storeu_ps(data, a); }
+inline Lane splat(const Float a) { return _mm_set1_ps(a); }
+inline Lane add(const Lane a, const Lane b) { return _mm_add_ps(a, b); }
+inline Lane mul(const Lane a, const Lane b) { return _mm_mul_ps(a, b); }
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+typedef float32x4_t Lane;
+inline Lane load(const Float* const data) { return vld1q_f32(data); }
+inline void store(Float* const data, const Lane a) { vst1q_f32(data, a); }
+inline Lane splat(const Float a) { return vdupq_n_f32(a); }
+inline Lane add(const Lane a, const Lane b) { return vaddq_f32(a, b); }
+inline Lane mul(const Lane a, const Lane b) { return vmulq_f32(a, b); }
+#else
+struct Lane { Float data[4]; };
+inline Lane load(const Float* const data) { return {{data[0], data[1], data[2], data[3]}}; }
+inline void store(Float* const data, const Lane a) { std::memcpy(data, a.data, sizeof(a.data)); }
+inline Lane splat(const Float a) { return {{a, a, a, a}}; }
+inline Lane add(const Lane a, const Lane b) { return {{a.data[0] + b.data[0], a.data[1] + b.data[1], a.data[2] + b.data[2], a.data[3] + b.data[3]}}; }
+inline Lane mul(const Lane a, const Lane b) { return {{a.data[0]*b.data[0], a.data[1]*b.data[1], a.data[2]*b.data[2], a.data[3]*b.data[3]}}; }
+#endif
+
+/* a*wa + b*wb + c*wc + d*wd */
+inline Lane blend(const Float* const a, const Float* const b, const Float* const c, const Float* const d, const Float wa, const Float wb, const Float wc, const Float wd) {
+    return add(add(mul(load(a), splat(wa)), mul(load(b), splat(wb))),
+               add(mul(load(c), splat(wc)), mul(load(d), splat(wd))));
+}
+
+inline Float dot4(const Float* const a, const Float* const b) {
+    return a[0]*b[0] + a[1]*b[1] + a[2]*b[2] + a[3]*b[3];
+}
+
+/* Transforms the position and normal with a matrix given by its columns.
+   The last row of the matrix is ignored. */
+inline void transform(const Lane* const columns, const Vector3& position, const Vector3* const normal, char* const outPosition, char* const outNormal) {
+    Float result[4];
+    store(result, add(add(mul(columns[0], splat(position.x())),
+                          mul(columns[1], splat(position.y()))),
+                      add(mul(columns[2], splat(position.z())), columns[3])));
+    std::memcpy(outPosition, result, sizeof(Vector3));
+
+    if(!normal) return;
+    store(result, add(add(mul(columns[0], splat(normal->x())),
+                          mul(columns[1], splat(normal->y()))),
+                          mul(columns[2], splat(normal->z()))));
+    Vector3 transformed{result[0], result[1], result[2]};
+    const Float length = transformed.length();
+    if(length != 0.0f) transformed /= length;
+    std::memcpy(outNormal, transformed.data(), sizeof(Vector3));
+}
+
+void skinLinear(const Containers::ArrayView<const Matrix4> jointMatrices, const Containers::ArrayView<const Vector4ui> jointIds, const Containers::ArrayView<const Vector4> jointWeights, const Containers::ArrayView<const Vector3> positions, const Containers::ArrayView<const Vector3> normals, char* const outPositions, char* const outNormals, const std::size_t stride, const std::size_t begin, const std::size_t end) {
+    for(std::size_t i = begin; i != end; ++i) {
+        const Vector4ui& ids = jointIds[i];
+        const Vector4& weights = jointWeights[i];
+        const Float* const a = jointMatrices[ids[0]].data();
+        const Float* const b = jointMatrices[ids[1]].data();
+        const Float* const c = jointMatrices[ids[2]].data();
+        const Float* const d = jointMatrices[ids[3]].data();
+
+        Lane columns[4];
+        for(std::size_t col = 0; col != 4; ++col)
+            columns[col] = blend(a + col*4, b + col*4, c + col*4, d + col*4, weights[0], weights[1], weights[2], weights[3]);
+
+        transform(columns, positions[i], normals.empty() ? nullptr : &normals[i], outPositions + i*stride, outNormals + i*stride);
+    }
+}
+
+void skinDualQuaternion(const Containers::ArrayView<const Vector4> real, const Containers::ArrayView<const Vector4> dual, const Containers::ArrayView<const Vector4ui> jointIds, const Containers::ArrayView<const Vector4> jointWeights, const Containers::ArrayView<const Vector3> positions, const Containers::ArrayView<const Vector3> normals, char* const outPositions, char* const outNormals, const std::size_t stride, const std::size_t begin, const std::size_t end) {
+    for(std::size_t i = begin; i != end; ++i) {
+        const Vector4ui& ids = jointIds[i];
+        const Vector4& weights = jointWeights[i];
+
+        /* Flip joints in the other hemisphere than the first one so the
+           blending goes along the shortest path */
+        const Float* const ra = real[ids[0]].data();
+        const Float* const rb = real[ids[1]].data();
+        const Float* const rc = real[ids[2]].data();
+        const Float* const rd = real[ids[3]].data();
+        const Float wa = weights[0];
+        const Float wb = dot4(ra, rb) < 0.0f ? -weights[1] : weights[1];
+        const Float wc = dot4(ra, rc) < 0.0f ? -weights[2] : weights[2];
+        const Float wd = dot4(ra, rd) < 0.0f ? -weights[3] : weights[3];
+
+        Float r[4], d[4];
+        store(r, blend(ra, rb, rc, rd, wa, wb, wc, wd));
+        store(d, blend(dual[ids[0]].data(), dual[ids[1]].data(), dual[ids[2]].data(), dual[ids[3]].data(), wa, wb, wc, wd));
+
+        /* Normalize and convert to a matrix, translation is
+           2*(dual*real^*).vector() */
+        const Float normInverted = 1.0f/std::sqrt(dot4(r, r));
+        const Float x = r[0]*normInverted, y = r[1]*normInverted,
+            z = r[2]*normInverted, w = r[3]*normInverted;
+        const Float dx = d[0]*normInverted, dy = d[1]*normInverted,
+            dz = d[2]*normInverted, dw = d[3]*normInverted;
+        const Float rotation[12]{
+            1.0f - 2.0f*(y*y + z*z), 2.0f*(x*y + z*w), 2.0f*(x*z - y*w), 0.0f,
+            2.0f*(x*y - z*w), 1.0f - 2.0f*(x*x + z*z), 2.0f*(y*z + x*w), 0.0f,
+            2.0f*(x*z + y*w), 2.0f*(y*z - x*w), 1.0f - 2.0f*(x*x + y*y), 0.0f};
+        const Float translation[4]{
+            2.0f*(w*dx - dw*x + y*dz - z*dy),
+            2.0f*(w*dy - dw*y + z*dx - x*dz),
+            2.0f*(w*dz - dw*z + x*dy - y*dx), 1.0f};
+        const Lane columns[4]{load(rotation), load(rotation + 4), load(rotation + 8), load(translation)};
+
+        transform(columns, positions[i], normals.empty() ? nullptr : &normals[i], outPositions + i*stride, outNormals + i*stride);
+    }
+}
+
+void skin(const SkinningMethod method, const Containers::ArrayView<const Matrix4> jointMatrices, const Containers::ArrayView<const Vector4ui> jointIds, const Containers::ArrayView<const Vector4> jointWeights, const Containers::ArrayView<const Vector3> positions, const Containers::ArrayView<const Vector3> normals, char* const outPositions, char* const outNormals, const std::size_t stride, const UnsignedInt threadCount) {
+    if(positions.empty()) return;
+
+    if(method == SkinningMethod::Linear) {
+        Implementation::parallelFor(positions.size(), threadCount, [&](const std::size_t begin, const std::size_t end) {
+            skinLinear(jointMatrices, jointIds, jointWeights, positions, normals, outPositions, outNormals, stride, begin, end);
+        });
+        return;
+    }
+
+    /* Convert the palette to dual quaternions, with real and dual parts in
+       separate arrays. Scaling is removed from the rotation part, the
+       conversion doesn't assert on non-orthogonal input. */
+    Containers::Array<Vector4> real{jointMatrices.size()}, dual{jointMatrices.size()};
+    for(std::size_t i = 0; i != jointMatrices.size(); ++i) {
+        const Matrix4& matrix = jointMatrices[i];
+        const Quaternion rotation = Math::Implementation::quaternionFromMatrix(Matrix3x3{
+            matrix[0].xyz().normalized(),
+            matrix[1].xyz().normalized(),
+            matrix[2].xyz().normalized()}).normalized();
+        const DualQuaternion transformation = DualQuaternion::translation(matrix.translation())*DualQuaternion{rotation};
+        real[i] = {transformation.real().vector(), transformation.real().scalar()};
+        dual[i] = {transformation.dual().vector(), transformation.dual().scalar()};
+    }
+
+    Implementation::parallelFor(positions.size(), threadCount, [&](const std::size_t begin, const std::size_t end) {
+        skinDualQuaternion(real, dual, jointIds, jointWeights, positions, normals, outPositions, outNormals, stride, begin, end);
+    });
+}
+
+}
+
+void skinInto(const SkinningMethod method, const Containers::ArrayView<const Matrix4> jointMatrices, const Containers::ArrayView<const Vector4ui> jointIds, const Containers::ArrayView<const Vector4> jointWeights, const Containers::ArrayView<const Vector3> positions, const Containers::ArrayView<const Vector3> normals, const Containers::ArrayView<Vector3> outPositions, const Containers::ArrayView<Vector3> outNormals, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(jointIds.size() == positions.size() && jointWeights.size() == positions.size() && outPositions.size() == positions.size(),
+        "MeshTools::skinInto(): expected" << positions.size() << "joint IDs, joint weights and output positions but got" << jointIds.size() << Debug::nospace << "," << jointWeights.size() << "and" << outPositions.size(), );
+    CORRADE_ASSERT((normals.empty() && outNormals.empty()) || (normals.size() == positions.size() && outNormals.size() == positions.size()),
+        "MeshTools::skinInto(): expected either no normals or" << positions.size() << "normals and output normals but got" << normals.size() << "and" << outNormals.size(), );
+
+    skin(method, jointMatrices, jointIds, jointWeights, positions, normals, reinterpret_cast<char*>(outPositions.data()), reinterpret_cast<char*>(outNormals.data()), sizeof(Vector3), threadCount);
+}
+
+void skinInterleavedInto(const SkinningMethod method, const Containers::ArrayView<const Matrix4> jointMatrices, const Containers::ArrayView<const Vector4ui> jointIds, const Containers::ArrayView<const Vector4> jointWeights, const Containers::ArrayView<const Vector3> positions, const Containers::ArrayView<const Vector3> normals, const Containers::ArrayView<char> out, const std::size_t stride, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(jointIds.size() == positions.size() && jointWeights.size() == positions.size(),
+        "MeshTools::skinInterleavedInto(): expected" << positions.size() << "joint IDs and joint weights but got" << jointIds.size() << "and" << jointWeights.size(), );
+    CORRADE_ASSERT(normals.empty() || normals.size() == positions.size(),
+        "MeshTools::skinInterleavedInto(): expected either no normals or" << positions.size() << "but got" << normals.size(), );
+    const std::size_t vertexSize = normals.empty() ? sizeof(Vector3) : sizeof(Vector3)*2;
+    CORRADE_ASSERT(stride >= vertexSize,
+        "MeshTools::skinInterleavedInto(): stride" << stride << "is too small for" << vertexSize << "bytes of vertex data", );
+    CORRADE_ASSERT(positions.empty() || out.size() >= stride*(positions.size() - 1) + vertexSize,
+        "MeshTools::skinInterleavedInto(): expected at least" << stride*(positions.size() - 1) + vertexSize << "bytes of output but got" << out.size(), );
+
+    skin(method, jointMatrices, jointIds, jointWeights, positions, normals, out.data(), out.data() + sizeof(Vector3), stride, threadCount);
+}
+
+Debug& operator<<(Debug& debug, const SkinningMethod value) {
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case SkinningMethod::value: return debug << "MeshTools::SkinningMethod::" #value;
+        _c(Linear)
+        _c(DualQuaternion)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "MeshTools::SkinningMethod(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+}}
@@ -0,0 +1,141 @@
+#ifndef Magnum_MeshTools_Skin_h
+#define Magnum_MeshTools_Skin_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/** @file
+ * @brief Enum @ref Magnum::MeshTools::SkinningMethod, function @ref Magnum::MeshTools::skinInto(), @ref Magnum::MeshTools::skinInterleavedInto()
+ */
+
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Skinning method
+
+@see @ref skinInto(), @ref skinInterleavedInto()
+*/
+enum class SkinningMethod: UnsignedByte {
+    /**
+     * Linear blend skinning. Joint matrices are blended with the vertex
+     * weights, same as in @ref Shaders::Phong::Flag::Skinned. Fastest, but
+     * the mesh loses volume around joints with large rotations.
+     */
+    Linear,
+
+    /**
+     * Dual quaternion skinning. Joint matrices are converted to dual
+     * quaternions, blended and normalized, which preserves the volume
+     * around joints. Expects the joint matrices to be rigid
+     * transformations, scaling is ignored.
+     */
+    DualQuaternion
+};
+
+/** @debugoperatorenum{Magnum::MeshTools::SkinningMethod} */
+MAGNUM_MESHTOOLS_EXPORT Debug& operator<<(Debug& debug, SkinningMethod value);
+
+/**
+@brief Skin a mesh on the CPU
+@param[in] method           Skinning method
+@param[in] jointMatrices    Joint matrix palette, e.g. from
+    @ref SceneGraph::Skeleton::jointMatrices()
+@param[in] jointIds         Indices of up to four joints influencing each
+    vertex
+@param[in] jointWeights     Weights of joints in @p jointIds. Expected to sum
+    up to `1.0f` for each vertex.
+@param[in] positions        Vertex positions in bind pose
+@param[in] normals          Vertex normals in bind pose. Can be empty.
+@param[out] outPositions    Where to put skinned positions
+@param[out] outNormals      Where to put skinned normals. Expected to be empty
+    if @p normals is empty.
+@param[in] threadCount      Count of worker threads. If `0`, the count is
+    `std::thread::hardware_concurrency()`.
+
+Fallback for targets that don't have enough uniform space for a joint
+palette, such as OpenGL ES 2.0. Expects that @p jointIds, @p jointWeights,
+@p positions and @p outPositions have the same size and that
+@p normals and @p outNormals have either the same size as well or are both
+empty. All joint indices are expected to be less than size of
+@p jointMatrices, unused joint slots should have a zero weight. The skinned
+normals are normalized.
+
+The joints of each vertex are blended four floats at a time if the library is
+compiled with SSE2 or NEON support. For @ref SkinningMethod::DualQuaternion
+the palette is first converted into separate arrays of real and dual parts.
+Large meshes are processed in parallel on @p threadCount threads, each thread
+on a contiguous range of vertices. On Emscripten the mesh is processed
+sequentially.
+@see @ref skinInterleavedInto(), @ref Shaders::Generic::JointIds,
+    @ref Shaders::Generic::JointWeights
+*/
+MAGNUM_MESHTOOLS_EXPORT void skinInto(SkinningMethod method, Containers::ArrayView<const Matrix4> jointMatrices, Containers::ArrayView<const Vector4ui> jointIds, Containers::ArrayView<const Vector4> jointWeights, Containers::ArrayView<const Vector3> positions, Containers::ArrayView<const Vector3> normals, Containers::ArrayView<Vector3> outPositions, Containers::ArrayView<Vector3> outNormals, UnsignedInt threadCount = 0);
+
+/**
+@brief Skin a mesh on the CPU into interleaved vertex data
+@param[in] method           Skinning method
+@param[in] jointMatrices    Joint matrix palette
+@param[in] jointIds         Indices of up to four joints influencing each
+    vertex
+@param[in] jointWeights     Weights of joints in @p jointIds
+@param[in] positions        Vertex positions in bind pose
+@param[in] normals          Vertex normals in bind pose. Can be empty.
+@param[out] out             Where to put the interleaved skinned vertices
+@param[in] stride           Stride of the interleaved vertices
+@param[in] threadCount      Count of worker threads. If `0`, the count is
+    `std::thread::hardware_concurrency()`.
+
+Like @ref skinInto(), but writes the position of each vertex at the
+beginning of each @p stride bytes of @p out, followed by the normal if
+@p normals is not empty. Other data in @p out are left untouched. Useful for
+skinning directly into a mapped @ref Buffer or @ref BufferRing slice
+containing the @ref Shaders::Generic::Position and
+@ref Shaders::Generic::Normal attributes:
+@code
+const std::size_t size = positions.size()*sizeof(Vector3)*2;
+Buffer vertices;
+vertices.setData({nullptr, size}, BufferUsage::StreamDraw);
+
+char* data = vertices.map<char>(0, size,
+    Buffer::MapFlag::Write|Buffer::MapFlag::InvalidateBuffer);
+MeshTools::skinInterleavedInto(MeshTools::SkinningMethod::DualQuaternion,
+    palette, jointIds, jointWeights, positions, normals,
+    {data, size}, sizeof(Vector3)*2);
+CORRADE_INTERNAL_ASSERT_OUTPUT(vertices.unmap());
+@endcode
+
+Expects that @p stride is large enough to contain the written attributes and
+that @p out is large enough for all vertices.
+*/
+MAGNUM_MESHTOOLS_EXPORT void skinInterleavedInto(SkinningMethod method, Containers::ArrayView<const Matrix4> jointMatrices, Containers::ArrayView<const Vector4ui> jointIds, Containers::ArrayView<const Vector4> jointWeights, Containers::ArrayView<const Vector3> positions, Containers::ArrayView<const Vector3> normals, Containers::ArrayView<char> out, std::size_t stride, UnsignedInt threadCount = 0);
+
+}}
+
+#endif
@@ -0,0 +1,193 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "StaticBatch.h"
+
+#include <cstring>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/MeshView.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/CompressIndices.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+/* This header is included only privately and doesn't introduce any linker
+   dependency, thus it's completely safe */
+#include "Magnum/Shaders/Generic.h"
+
+namespace Magnum { namespace MeshTools {
+
+StaticBatch::StaticBatch(const MeshPrimitive primitive, const Flags flags): _primitive{primitive}, _flags{flags}, _stride{sizeof(Shaders::Generic3D::Position::Type)} {
+    /* Base vertex is not available for indexed draws on ES */
+    #ifdef MAGNUM_TARGET_GLES
+    _flags |= Flag::OffsetIndices;
+    #endif
+
+    if(_flags & Flag::Normals)
+        _stride += sizeof(Shaders::Generic3D::Normal::Type);
+    if(_flags & Flag::TextureCoordinates)
+        _stride += sizeof(Shaders::Generic3D::TextureCoordinates::Type);
+    #ifndef MAGNUM_TARGET_GLES2
+    if(_flags & Flag::TransformationIds)
+        _stride += sizeof(Shaders::Generic3D::TransformationId::Type);
+    #endif
+}
+
+UnsignedInt StaticBatch::add(const Trade::MeshData3D& meshData, const Matrix4& transformation) {
+    return addInternal(meshData, transformation, 0);
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+UnsignedInt StaticBatch::add(const Trade::MeshData3D& meshData, const UnsignedInt transformationId) {
+    CORRADE_ASSERT(_flags & Flag::TransformationIds,
+        "MeshTools::StaticBatch::add(): transformation IDs not enabled", {});
+    return addInternal(meshData, Matrix4{}, transformationId);
+}
+#endif
+
+UnsignedInt StaticBatch::addInternal(const Trade::MeshData3D& meshData, const Matrix4& transformation, const UnsignedInt transformationId) {
+    CORRADE_ASSERT(meshData.primitive() == _primitive,
+        "MeshTools::StaticBatch::add(): expected" << _primitive << "but got" << meshData.primitive(), {});
+    CORRADE_ASSERT(!(_flags & Flag::Normals) || meshData.hasNormals(),
+        "MeshTools::StaticBatch::add(): the mesh has no normals", {});
+    CORRADE_ASSERT(!(_flags & Flag::TextureCoordinates) || meshData.hasTextureCoords2D(),
+        "MeshTools::StaticBatch::add(): the mesh has no texture coordinates", {});
+
+    const std::vector<Vector3>& positions = meshData.positions(0);
+    CORRADE_ASSERT(!positions.empty(),
+        "MeshTools::StaticBatch::add(): the mesh has no vertices", {});
+    const Range range{UnsignedInt(_indices.size()),
+        UnsignedInt(meshData.isIndexed() ? meshData.indices().size() : positions.size()),
+        vertexCount(), UnsignedInt(positions.size())};
+
+    /* Indices, offset by the vertex offset if requested. Non-indexed meshes
+       get a trivial index buffer. */
+    const UnsignedInt indexOffset = _flags & Flag::OffsetIndices ? range.vertexOffset : 0;
+    _indices.reserve(_indices.size() + range.indexCount);
+    if(meshData.isIndexed()) {
+        for(const UnsignedInt index: meshData.indices())
+            _indices.push_back(index + indexOffset);
+    } else for(UnsignedInt i = 0; i != range.vertexCount; ++i)
+        _indices.push_back(i + indexOffset);
+
+    /* Interleaved vertex data, transformed on the way */
+    _vertexData.resize(_vertexData.size() + range.vertexCount*_stride);
+    char* out = _vertexData.data() + range.vertexOffset*_stride;
+    const Matrix3x3 normalMatrix = transformation.rotationScaling().inverted().transposed();
+    for(std::size_t i = 0; i != range.vertexCount; ++i, out += _stride) {
+        std::size_t offset = 0;
+
+        const Vector3 position = transformation.transformPoint(positions[i]);
+        std::memcpy(out, &position, sizeof(Vector3));
+        offset += sizeof(Vector3);
+
+        if(_flags & Flag::Normals) {
+            const Vector3 normal = (normalMatrix*meshData.normals(0)[i]).normalized();
+            std::memcpy(out + offset, &normal, sizeof(Vector3));
+            offset += sizeof(Vector3);
+        }
+
+        if(_flags & Flag::TextureCoordinates) {
+            std::memcpy(out + offset, &meshData.textureCoords2D(0)[i], sizeof(Vector2));
+            offset += sizeof(Vector2);
+        }
+
+        #ifndef MAGNUM_TARGET_GLES2
+        if(_flags & Flag::TransformationIds)
+            std::memcpy(out + offset, &transformationId, sizeof(UnsignedInt));
+        #else
+        static_cast<void>(transformationId);
+        #endif
+    }
+
+    _ranges.push_back(range);
+    return _ranges.size() - 1;
+}
+
+void StaticBatch::compile(Mesh& mesh, Buffer& vertexBuffer, Buffer& indexBuffer, const BufferUsage usage) const {
+    vertexBuffer.setData(vertexData(), usage);
+
+    /* Bind the attributes, each with the rest of the stride as a gap */
+    UnsignedInt offset = 0;
+    mesh.setPrimitive(_primitive)
+        .addVertexBuffer(vertexBuffer, 0,
+            Shaders::Generic3D::Position{},
+            _stride - sizeof(Shaders::Generic3D::Position::Type));
+    offset += sizeof(Shaders::Generic3D::Position::Type);
+
+    if(_flags & Flag::Normals) {
+        mesh.addVertexBuffer(vertexBuffer, 0,
+            offset,
+            Shaders::Generic3D::Normal{},
+            _stride - offset - sizeof(Shaders::Generic3D::Normal::Type));
+        offset += sizeof(Shaders::Generic3D::Normal::Type);
+    }
+
+    if(_flags & Flag::TextureCoordinates) {
+        mesh.addVertexBuffer(vertexBuffer, 0,
+            offset,
+            Shaders::Generic3D::TextureCoordinates{},
+            _stride - offset - sizeof(Shaders::Generic3D::TextureCoordinates::Type));
+        offset += sizeof(Shaders::Generic3D::TextureCoordinates::Type);
+    }
+
+    #ifndef MAGNUM_TARGET_GLES2
+    if(_flags & Flag::TransformationIds)
+        mesh.addVertexBuffer(vertexBuffer, 0,
+            offset,
+            Shaders::Generic3D::TransformationId{});
+    #endif
+
+    /* Index buffer, compressed to the smallest type possible. With base
+       vertex the values are local to each mesh, so this is usually 16-bit
+       even for large batches. */
+    Containers::Array<char> indexData;
+    Mesh::IndexType indexType;
+    UnsignedInt indexStart, indexEnd;
+    std::tie(indexData, indexType, indexStart, indexEnd) = MeshTools::compressIndices(_indices);
+    indexBuffer.setData(indexData, usage);
+    mesh.setCount(_indices.size())
+        .setIndexBuffer(indexBuffer, 0, indexType, indexStart, indexEnd);
+}
+
+std::vector<MeshView> StaticBatch::views(Mesh& mesh) const {
+    std::vector<MeshView> views(_ranges.size(), MeshView{mesh});
+    for(std::size_t i = 0; i != _ranges.size(); ++i) {
+        const Range& range = _ranges[i];
+        views[i].setCount(range.indexCount);
+        if(_flags & Flag::OffsetIndices) {
+            views[i].setIndexRange(range.indexOffset, range.vertexOffset,
+                range.vertexOffset + range.vertexCount - 1);
+        } else {
+            views[i].setBaseVertex(range.vertexOffset)
+                .setIndexRange(range.indexOffset, 0, range.vertexCount - 1);
+        }
+    }
+
+    return views;
+}
+
+}}
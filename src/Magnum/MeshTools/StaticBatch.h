@@ -0,0 +1,270 @@
+#ifndef Magnum_MeshTools_StaticBatch_h
+#define Magnum_MeshTools_StaticBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::MeshTools::StaticBatch
+ */
+
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/EnumSet.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Trade/Trade.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Static mesh batch
+
+Concatenates many 3D meshes sharing the same primitive into a single
+interleaved vertex buffer and a single index buffer, so the whole batch can be
+submitted with one @ref MeshView::draw(AbstractShaderProgram&, std::initializer_list<std::reference_wrapper<MeshView>>)
+call instead of binding and drawing each mesh separately. Meant for static
+level geometry consisting of many small meshes.
+
+Each mesh is either transformed on the CPU when added, using
+@ref add(const Trade::MeshData3D&, const Matrix4&), or, with
+@ref Flag::TransformationIds, tagged with a per-vertex ID bound to
+@ref Shaders::Generic3D::TransformationId, which the shader then uses to fetch
+the transformation from an uniform array or a buffer texture. Only the first
+position, normal and texture coordinate array of each mesh is used.
+Non-indexed meshes get a trivial index buffer generated.
+
+The CPU-side data are accessible through @ref vertexData(), @ref indices() and
+@ref ranges(), @ref compile() uploads them and configures the mesh for
+@ref Shaders::Generic3D and @ref views() then returns one @ref MeshView per
+added mesh. Example usage:
+@code
+MeshTools::StaticBatch batch{MeshPrimitive::Triangles,
+    MeshTools::StaticBatch::Flag::Normals};
+for(const auto& object: staticObjects)
+    batch.add(*object.meshData, object.transformation);
+
+Mesh mesh;
+Buffer vertices, indices;
+batch.compile(mesh, vertices, indices, BufferUsage::StaticDraw);
+std::vector<MeshView> views = batch.views(mesh);
+
+std::vector<std::reference_wrapper<MeshView>> visible;
+// fill with views that passed culling...
+MeshView::draw(shader, visible);
+@endcode
+
+By default the views use @ref MeshView::setBaseVertex() to offset the
+vertices of each mesh, which keeps the index values local to each mesh and
+thus allows the index buffer to be compressed to 16-bit types even for large
+batches. Base vertex is not available for indexed meshes in OpenGL ES and
+WebGL, so there the vertex offset is baked into the index values instead, as
+if @ref Flag::OffsetIndices was specified.
+@see @ref compile(const Trade::MeshData3D&, BufferUsage)
+*/
+class MAGNUM_MESHTOOLS_EXPORT StaticBatch {
+    public:
+        /**
+         * @brief Batch flag
+         *
+         * @see @ref Flags, @ref StaticBatch()
+         */
+        enum class Flag: UnsignedByte {
+            /**
+             * Include normals, bound to @ref Shaders::Generic3D::Normal.
+             * All added meshes are expected to have them.
+             */
+            Normals = 1 << 0,
+
+            /**
+             * Include texture coordinates, bound to
+             * @ref Shaders::Generic3D::TextureCoordinates. All added meshes
+             * are expected to have them.
+             */
+            TextureCoordinates = 1 << 1,
+
+            #if !defined(MAGNUM_TARGET_GLES2) || defined(DOXYGEN_GENERATING_OUTPUT)
+            /**
+             * Include a per-vertex transformation ID, bound to
+             * @ref Shaders::Generic3D::TransformationId. Meshes are then
+             * added with @ref add(const Trade::MeshData3D&, UnsignedInt).
+             * @requires_gl30 Extension @extension{EXT,gpu_shader4}
+             * @requires_gles30 Integer attributes are not available in
+             *      OpenGL ES 2.0.
+             * @requires_webgl20 Integer attributes are not available in
+             *      WebGL 1.0.
+             */
+            TransformationIds = 1 << 2,
+            #endif
+
+            /**
+             * Bake the vertex offset of each mesh into its index values
+             * instead of using @ref MeshView::setBaseVertex(). Always
+             * enabled in OpenGL ES and WebGL.
+             */
+            OffsetIndices = 1 << 3
+        };
+
+        /**
+         * @brief Batch flags
+         *
+         * @see @ref StaticBatch()
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+
+        /**
+         * @brief Range of a mesh in the batch
+         *
+         * @see @ref ranges()
+         */
+        struct Range {
+            UnsignedInt indexOffset;    /**< @brief Offset of first index */
+            UnsignedInt indexCount;     /**< @brief Index count */
+            UnsignedInt vertexOffset;   /**< @brief Offset of first vertex */
+            UnsignedInt vertexCount;    /**< @brief Vertex count */
+        };
+
+        /**
+         * @brief Constructor
+         * @param primitive     Primitive shared by all meshes in the batch
+         * @param flags         Flags
+         */
+        explicit StaticBatch(MeshPrimitive primitive, Flags flags = {});
+
+        /** @brief Primitive */
+        MeshPrimitive primitive() const { return _primitive; }
+
+        /** @brief Flags */
+        Flags flags() const { return _flags; }
+
+        /**
+         * @brief Vertex stride
+         *
+         * 12 bytes for positions, plus 12 bytes for @ref Flag::Normals, 8
+         * bytes for @ref Flag::TextureCoordinates and 4 bytes for
+         * @ref Flag::TransformationIds.
+         */
+        UnsignedInt vertexStride() const { return _stride; }
+
+        /** @brief Count of meshes in the batch */
+        std::size_t size() const { return _ranges.size(); }
+
+        /** @brief Total vertex count */
+        UnsignedInt vertexCount() const { return _vertexData.size()/_stride; }
+
+        /** @brief Interleaved vertex data */
+        Containers::ArrayView<const char> vertexData() const {
+            return {_vertexData.data(), _vertexData.size()};
+        }
+
+        /**
+         * @brief Indices
+         *
+         * Local to each mesh unless @ref Flag::OffsetIndices is set.
+         */
+        const std::vector<UnsignedInt>& indices() const { return _indices; }
+
+        /** @brief Ranges of all added meshes */
+        const std::vector<Range>& ranges() const { return _ranges; }
+
+        /**
+         * @brief Add a mesh
+         * @param meshData          Mesh data
+         * @param transformation    Transformation applied to positions and
+         *      normals on the CPU
+         * @return ID of the mesh in @ref ranges() and @ref views()
+         *
+         * Expects that the mesh is not empty, its primitive matches
+         * @ref primitive() and it has all attributes enabled by
+         * @ref flags(). If @ref Flag::TransformationIds is set, the ID is
+         * `0`.
+         */
+        UnsignedInt add(const Trade::MeshData3D& meshData, const Matrix4& transformation = Matrix4{});
+
+        #if !defined(MAGNUM_TARGET_GLES2) || defined(DOXYGEN_GENERATING_OUTPUT)
+        /**
+         * @brief Add a mesh with a transformation ID
+         * @param meshData          Mesh data
+         * @param transformationId  Transformation ID written to all vertices
+         *      of the mesh
+         * @return ID of the mesh in @ref ranges() and @ref views()
+         *
+         * Expects that @ref Flag::TransformationIds is set, the positions
+         * and normals are copied untransformed.
+         * @requires_gl30 Extension @extension{EXT,gpu_shader4}
+         * @requires_gles30 Integer attributes are not available in OpenGL
+         *      ES 2.0.
+         * @requires_webgl20 Integer attributes are not available in WebGL
+         *      1.0.
+         */
+        UnsignedInt add(const Trade::MeshData3D& meshData, UnsignedInt transformationId);
+        #endif
+
+        /**
+         * @brief Compile the batch
+         * @param mesh          Mesh to configure
+         * @param vertexBuffer  Buffer to fill with @ref vertexData()
+         * @param indexBuffer   Buffer to fill with compressed
+         *      @ref indices()
+         * @param usage         Usage of both buffers
+         *
+         * Sets primitive, index count and index buffer of @p mesh and binds
+         * all enabled attributes to their @ref Shaders::Generic3D locations.
+         * The indices are compressed using @ref compressIndices(). The
+         * buffers have to stay alive for the whole lifetime of @p mesh.
+         */
+        void compile(Mesh& mesh, Buffer& vertexBuffer, Buffer& indexBuffer, BufferUsage usage) const;
+
+        /**
+         * @brief Mesh views
+         * @param mesh          Mesh configured with @ref compile()
+         *
+         * Returns one view for each added mesh, in the order they were
+         * added, with index range and base vertex set according to
+         * @ref ranges(). Pass a subset of them to
+         * @ref MeshView::draw(AbstractShaderProgram&, Containers::ArrayView<const std::reference_wrapper<MeshView>>)
+         * to draw the visible ones in a single call.
+         * @requires_gl32 Extension @extension{ARB,draw_elements_base_vertex}
+         *      unless @ref Flag::OffsetIndices is set.
+         */
+        std::vector<MeshView> views(Mesh& mesh) const;
+
+    private:
+        UnsignedInt addInternal(const Trade::MeshData3D& meshData, const Matrix4& transformation, UnsignedInt transformationId);
+
+        MeshPrimitive _primitive;
+        Flags _flags;
+        UnsignedInt _stride;
+        std::vector<char> _vertexData;
+        std::vector<UnsignedInt> _indices;
+        std::vector<Range> _ranges;
+};
+
+CORRADE_ENUMSET_OPERATORS(StaticBatch::Flags)
+
+}}
+
+#endif
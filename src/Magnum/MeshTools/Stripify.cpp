@@ -0,0 +1,169 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Stripify.h"
+
+#include <algorithm>
+#include <utility>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Count of upcoming triangles the strips are built from. Larger window gives
+   longer strips, but the triangle order drifts away from the original. */
+constexpr std::size_t WindowSize = 16;
+
+/* Returns position of the remaining vertex if the triangle contains ordered
+   edge a -> b, 3 otherwise */
+inline std::size_t findEdge(const UnsignedInt* const triangle, const UnsignedInt a, const UnsignedInt b) {
+    for(std::size_t i = 0; i != 3; ++i)
+        if(triangle[i] == a && triangle[(i + 1)%3] == b) return (i + 2)%3;
+    return 3;
+}
+
+/* Finds a triangle in the window that continues a strip ending with a, b.
+   Triangle i of a strip is (s[i], s[i + 1], s[i + 2]) for even i and
+   (s[i + 1], s[i], s[i + 2]) for odd i, so to keep the winding the next
+   triangle has to contain edge a -> b if it's even and b -> a if it's odd.
+   Returns window position and position of the remaining vertex in the
+   triangle, or WindowSize if there's no such triangle. */
+std::pair<std::size_t, std::size_t> findContinuation(const UnsignedInt* const indices, const std::size_t* const window, const std::size_t windowSize, const UnsignedInt used, const UnsignedInt a, const UnsignedInt b, const bool odd) {
+    const UnsignedInt from = odd ? b : a, to = odd ? a : b;
+    for(std::size_t i = 0; i != windowSize; ++i) {
+        if(used & (1u << i)) continue;
+        const std::size_t third = findEdge(indices + window[i], from, to);
+        if(third != 3) return {i, third};
+    }
+    return {WindowSize, 3};
+}
+
+/* Count of triangles a strip starting with given triangle and rotation can be
+   continued with, using just the current window */
+std::size_t stripLength(const UnsignedInt* const indices, const std::size_t* const window, const std::size_t windowSize, const std::size_t start, const std::size_t rotation) {
+    const UnsignedInt* const t = indices + window[start];
+    UnsignedInt used = 1u << start;
+    UnsignedInt a = t[(rotation + 1)%3], b = t[(rotation + 2)%3];
+    std::size_t length = 0;
+    for(;;) {
+        const std::pair<std::size_t, std::size_t> next = findContinuation(indices, window, windowSize, used, a, b, length % 2 == 0);
+        if(next.first == WindowSize) return length;
+        used |= 1u << next.first;
+        a = b;
+        b = indices[window[next.first] + next.second];
+        ++length;
+    }
+}
+
+}
+
+std::vector<UnsignedInt> stripify(const std::vector<UnsignedInt>& indices, const UnsignedInt vertexCount, const UnsignedInt restartIndex) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::stripify(): index count" << indices.size() << "not divisible by three", {});
+    CORRADE_ASSERT(restartIndex >= vertexCount,
+        "MeshTools::stripify(): restart index" << restartIndex << "collides with" << vertexCount << "vertices", {});
+
+    /* Count of not yet emitted triangles for each vertex */
+    std::vector<UnsignedInt> liveTriangleCount(vertexCount);
+    for(const UnsignedInt index: indices) {
+        CORRADE_ASSERT(index < vertexCount,
+            "MeshTools::stripify(): index" << index << "out of bounds for" << vertexCount << "vertices", {});
+        ++liveTriangleCount[index];
+    }
+
+    std::vector<UnsignedInt> strips;
+    strips.reserve(indices.size()*2/3);
+
+    /* Offsets of upcoming triangles in the index array, in original order */
+    std::size_t window[WindowSize];
+    std::size_t windowSize = 0, next = 0;
+
+    /* Vertex count of current strip and its last two vertices */
+    std::size_t stripSize = 0;
+    UnsignedInt a{}, b{};
+
+    for(;;) {
+        /* Refill the window, drop degenerate triangles on the way */
+        for(; windowSize != WindowSize && next != indices.size(); next += 3) {
+            const UnsignedInt* const t = indices.data() + next;
+            if(t[0] != t[1] && t[1] != t[2] && t[2] != t[0])
+                window[windowSize++] = next;
+            else for(std::size_t i = 0; i != 3; ++i) --liveTriangleCount[t[i]];
+        }
+        if(!windowSize) break;
+
+        /* Continue the current strip, if possible */
+        std::pair<std::size_t, std::size_t> found{WindowSize, 3};
+        if(stripSize)
+            found = findContinuation(indices.data(), window, windowSize, 0, a, b, stripSize % 2);
+
+        const UnsignedInt* t;
+        if(found.first != WindowSize) {
+            t = indices.data() + window[found.first];
+            a = b;
+            b = t[found.second];
+            strips.push_back(b);
+            ++stripSize;
+
+        /* Otherwise start a new strip with the triangle and rotation that can
+           be continued the longest. From those prefer triangles with the
+           least live neighbors, so lone triangles don't get left behind. */
+        } else {
+            std::size_t rotation = 0, bestLength = 0;
+            UnsignedInt bestScore = ~UnsignedInt{};
+            found.first = 0;
+            for(std::size_t i = 0; i != windowSize; ++i) {
+                const UnsignedInt* const candidate = indices.data() + window[i];
+                const UnsignedInt score = std::min({liveTriangleCount[candidate[0]], liveTriangleCount[candidate[1]], liveTriangleCount[candidate[2]]});
+                for(std::size_t r = 0; r != 3; ++r) {
+                    const std::size_t length = stripLength(indices.data(), window, windowSize, i, r);
+                    if(length < bestLength || (length == bestLength && score >= bestScore)) continue;
+                    bestLength = length;
+                    bestScore = score;
+                    found.first = i;
+                    rotation = r;
+                }
+            }
+            t = indices.data() + window[found.first];
+
+            if(stripSize) strips.push_back(restartIndex);
+            strips.insert(strips.end(), {t[rotation], t[(rotation + 1)%3], t[(rotation + 2)%3]});
+            a = t[(rotation + 1)%3];
+            b = t[(rotation + 2)%3];
+            stripSize = 3;
+        }
+
+        /* Remove the triangle from the window, keeping the order */
+        for(std::size_t i = 0; i != 3; ++i) --liveTriangleCount[t[i]];
+        std::copy(window + found.first + 1, window + windowSize, window + found.first);
+        --windowSize;
+    }
+
+    return strips;
+}
+
+}}
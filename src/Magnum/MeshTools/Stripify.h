@@ -0,0 +1,90 @@
+#ifndef Magnum_MeshTools_Stripify_h
+#define Magnum_MeshTools_Stripify_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::stripify()
+ */
+
+#include <vector>
+
+#include "Magnum/Types.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Convert triangle list to triangle strips
+@param indices      Index array of a @ref MeshPrimitive::Triangles mesh
+@param vertexCount  Vertex count
+@param restartIndex Primitive restart index separating the strips
+@return Index array of a @ref MeshPrimitive::TriangleStrip mesh
+
+Greedily builds strips from a small window of upcoming triangles, so the
+triangle order and thus post-transform vertex cache locality of the input is
+mostly preserved. Call it after @ref tipsify() and before
+@ref optimizeVertexFetch(). When a strip can't be continued, a new one is
+started from the triangle that gives the longest strip within the window, the
+strips are separated with @p restartIndex. Winding order of all triangles is preserved,
+degenerate triangles are dropped. Compared to the triangle list, the output
+is usually around 40% smaller for regular meshes.
+
+Expects that index count is divisible by three, all indices are smaller than
+@p vertexCount and @p restartIndex is not smaller than @p vertexCount. To
+make use of fixed-index primitive restart (the only variant available in
+OpenGL ES 3.0 and WebGL 2.0), the restart index has to be the maximal value
+of the index type, see @ref Mesh::primitiveRestartIndex(). Passing it to
+@ref compressIndices() then results in exactly that type:
+@code
+std::vector<UnsignedInt> indices;
+MeshTools::tipsify(indices, vertexCount, 24);
+std::vector<UnsignedInt> strips = MeshTools::stripify(indices, vertexCount,
+    Mesh::primitiveRestartIndex(Mesh::IndexType::UnsignedShort));
+
+Containers::Array<char> indexData;
+Mesh::IndexType indexType;
+std::tie(indexData, indexType, std::ignore, std::ignore) = MeshTools::compressIndices(strips);
+
+Buffer indexBuffer;
+indexBuffer.setData(indexData, BufferUsage::StaticDraw);
+
+Mesh mesh{MeshPrimitive::TriangleStrip};
+mesh.setCount(strips.size())
+    .setIndexBuffer(indexBuffer, 0, indexType, 0, vertexCount - 1);
+
+Renderer::enable(Renderer::Feature::PrimitiveRestartFixedIndex);
+@endcode
+
+The index range passed to @ref Mesh::setIndexBuffer() doesn't need to
+include the restart index.
+@see @ref Renderer::Feature::PrimitiveRestart,
+    @ref Renderer::setPrimitiveRestartIndex()
+*/
+MAGNUM_MESHTOOLS_EXPORT std::vector<UnsignedInt> stripify(const std::vector<UnsignedInt>& indices, UnsignedInt vertexCount, UnsignedInt restartIndex);
+
+}}
+
+#endif
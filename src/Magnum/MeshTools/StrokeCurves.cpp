@@ -0,0 +1,123 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "StrokeCurves.h"
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector2.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Miter length is at most this many times half of the stroke width */
+constexpr Float MiterLimit = 4.0f;
+
+/* Direction of a polyline segment, zero for degenerate ones */
+Vector2 direction(const Vector2& a, const Vector2& b) {
+    const Vector2 d = b - a;
+    const Float length = d.length();
+    return length > 0.0f ? d/length : Vector2{};
+}
+
+void strokePath(const std::vector<Vector2>& points, const std::size_t begin, const std::size_t end, const Float halfWidth, std::vector<Vector2>& out) {
+    /* A closed path wraps around at the join of its end point, which is the
+       same point as the start point */
+    const bool closed = end - begin > 2 && points[begin] == points[end - 1];
+
+    /* Join to the previous path using two degenerate triangles */
+    const bool joinToPrevious = !out.empty();
+    if(joinToPrevious) out.push_back(out.back());
+
+    for(std::size_t i = begin; i != end; ++i) {
+        Vector2 previous, next;
+        if(i != begin) previous = direction(points[i - 1], points[i]);
+        else if(closed) previous = direction(points[end - 2], points[i]);
+        if(i + 1 != end) next = direction(points[i], points[i + 1]);
+        else if(closed) next = direction(points[i], points[begin + 1]);
+
+        /* On path ends or degenerate segments there's only one direction,
+           otherwise extrude along the angle bisector, with the length
+           scaled so the stroke keeps its width along both segments */
+        Vector2 normal;
+        if(previous.isZero()) normal = next.perpendicular()*halfWidth;
+        else if(next.isZero()) normal = previous.perpendicular()*halfWidth;
+        else {
+            const Vector2 bisector = (previous + next).perpendicular();
+            const Float bisectorLength = bisector.length();
+            if(bisectorLength > 0.0f) {
+                const Vector2 miter = bisector/bisectorLength;
+                normal = miter*halfWidth/Math::max(Math::dot(miter, next.perpendicular()), 1.0f/MiterLimit);
+            } else normal = next.perpendicular()*halfWidth;
+        }
+
+        out.push_back(points[i] + normal);
+        if(joinToPrevious && i == begin) out.push_back(out.back());
+        out.push_back(points[i] - normal);
+    }
+}
+
+template<UnsignedInt order> std::vector<Vector2> strokeCurvesImplementation(const std::vector<Math::Bezier<order, 2, Float>>& curves, const Float width, const Float tolerance) {
+    /* Tessellate all curves into polyline paths, consecutive curves sharing
+       end points are put into the same path */
+    std::vector<Vector2> points;
+    std::vector<std::size_t> pathEnds;
+    std::vector<Math::Vector<2, Float>> curvePoints;
+    for(std::size_t i = 0; i != curves.size(); ++i) {
+        const Math::Bezier<order, 2, Float>& curve = curves[i];
+        if(i && curves[i - 1][order] != curve[0])
+            pathEnds.push_back(points.size());
+
+        curvePoints.resize(curve.tessellate(tolerance, nullptr));
+        curve.tessellate(tolerance, {curvePoints.data(), curvePoints.size()});
+
+        /* The start point of a continued curve is already there */
+        const std::size_t first = i && curves[i - 1][order] == curve[0] ? 1 : 0;
+        points.insert(points.end(), curvePoints.begin() + first, curvePoints.end());
+    }
+    pathEnds.push_back(points.size());
+
+    std::vector<Vector2> out;
+    out.reserve(points.size()*2 + pathEnds.size()*2);
+    std::size_t begin = 0;
+    for(const std::size_t end: pathEnds) {
+        if(end - begin > 1) strokePath(points, begin, end, width*0.5f, out);
+        begin = end;
+    }
+
+    return out;
+}
+
+}
+
+std::vector<Vector2> strokeCurves(const std::vector<CubicBezier2D>& curves, const Float width, const Float tolerance) {
+    return strokeCurvesImplementation(curves, width, tolerance);
+}
+
+std::vector<Vector2> strokeCurves(const std::vector<QuadraticBezier2D>& curves, const Float width, const Float tolerance) {
+    return strokeCurvesImplementation(curves, width, tolerance);
+}
+
+}}
@@ -0,0 +1,79 @@
+#ifndef Magnum_MeshTools_StrokeCurves_h
+#define Magnum_MeshTools_StrokeCurves_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::strokeCurves()
+ */
+
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Bezier.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Tessellate curve strokes into a triangle strip
+@param curves       Curves to stroke
+@param width        Stroke width
+@param tolerance    Maximal allowed distance of the tessellated stroke
+    centerline from the curve, see @ref Math::Bezier::tessellate()
+@return Vertex positions of a triangle strip
+
+Each curve is adaptively tessellated using @ref Math::Bezier::tessellate()
+and each point of the resulting polyline is extruded by half of @p width to
+both sides, giving two vertices per point. Curves where the start point is
+the same as end point of the previous curve are continued as a single path
+with mitered joins, the miter length being limited to four times the stroke
+width. A path that ends at its start point is closed. Separate paths are
+joined using degenerate triangles, so the whole output can be drawn with a
+single @ref MeshPrimitive::TriangleStrip draw call:
+@code
+std::vector<CubicBezier2D> curves;
+std::vector<Vector2> positions = MeshTools::strokeCurves(curves, 2.0f, 0.25f);
+
+Buffer buffer;
+buffer.setData(positions, BufferUsage::StreamDraw);
+Mesh mesh;
+mesh.setPrimitive(MeshPrimitive::TriangleStrip)
+    .setCount(positions.size())
+    .addVertexBuffer(buffer, 0, Shaders::Flat2D::Position{});
+@endcode
+
+With curves in screen space and @p tolerance set to a fraction of a pixel,
+the stroke looks smooth at any zoom level with the least vertex count
+possible.
+*/
+std::vector<Vector2> MAGNUM_MESHTOOLS_EXPORT strokeCurves(const std::vector<CubicBezier2D>& curves, Float width, Float tolerance);
+
+/** @overload */
+std::vector<Vector2> MAGNUM_MESHTOOLS_EXPORT strokeCurves(const std::vector<QuadraticBezier2D>& curves, Float width, Float tolerance);
+
+}}
+
+#endif
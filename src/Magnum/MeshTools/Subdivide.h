@@ -26,12 +26,16 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::subdivide()
+ * @brief Function @ref Magnum::MeshTools::subdivide(), @ref Magnum::MeshTools::subdivideUnique()
  */
 
+#include <cstdint>
+#include <utility>
 #include <vector>
 #include <Corrade/Utility/Debug.h>
 
+#include "Magnum/Magnum.h"
+
 namespace Magnum { namespace MeshTools {
 
 namespace Implementation {
@@ -58,6 +62,42 @@ template<class Vertex, class Interpolator> class Subdivide {
         }
 };
 
+/* Open-addressing hash table with linear probing, mapping sorted edge index
+   pairs to index of the vertex created in the middle of them */
+class SubdivideEdgeTable {
+    public:
+        explicit SubdivideEdgeTable(std::size_t edgeCount) {
+            /* Keep the load factor below 2/3 */
+            std::size_t capacity = 16;
+            while(capacity < edgeCount + edgeCount/2) capacity <<= 1;
+            _slots.assign(capacity, {Empty, 0});
+            _mask = capacity - 1;
+        }
+
+        /* Returns index of the vertex for given edge or inserts the
+           candidate if the edge is not there yet */
+        std::pair<UnsignedInt, bool> insert(UnsignedInt a, UnsignedInt b, UnsignedInt candidate) {
+            const std::uint64_t key = a < b ?
+                (std::uint64_t(a) << 32)|b : (std::uint64_t(b) << 32)|a;
+            std::uint64_t hash = key*0x9e3779b97f4a7c15ull;
+            hash ^= hash >> 32;
+            for(std::size_t i = std::size_t(hash) & _mask; ; i = (i + 1) & _mask) {
+                if(_slots[i].first == Empty) {
+                    _slots[i] = {key, candidate};
+                    return {candidate, true};
+                }
+                if(_slots[i].first == key) return {_slots[i].second, false};
+            }
+        }
+
+    private:
+        /* Can't collide with a real edge, as it has both indices the same */
+        enum: std::uint64_t { Empty = ~std::uint64_t{} };
+
+        std::vector<std::pair<std::uint64_t, UnsignedInt>> _slots;
+        std::size_t _mask;
+};
+
 }
 
 /**
@@ -71,11 +111,68 @@ template<class Vertex, class Interpolator> class Subdivide {
 
 Goes through all triangle faces and subdivides them into four new. Removing
 duplicate vertices in the mesh is up to user.
+@see @ref subdivideUnique()
 */
 template<class Vertex, class Interpolator> inline void subdivide(std::vector<UnsignedInt>& indices, std::vector<Vertex>& vertices, Interpolator interpolator) {
     Implementation::Subdivide<Vertex, Interpolator>(indices, vertices)(interpolator);
 }
 
+/**
+@brief Subdivide the mesh without creating duplicate vertices
+@tparam Vertex          Vertex data type
+@tparam Interpolator    See `interpolator` function parameter
+@param[in,out] indices  Index array to operate on
+@param[in,out] vertices Vertex array to operate on
+@param interpolator     Functor or function pointer which interpolates
+    two adjacent vertices: `Vertex interpolator(Vertex a, Vertex b)`
+
+Like @ref subdivide(), but the vertex in the middle of each edge is created
+only once and shared by all faces adjacent to that edge. Compared to calling
+@ref subdivide() and then @ref removeDuplicates(), the interpolator is called
+only once per edge and there's no weld pass. If the original mesh has no
+duplicate vertices, neither has the subdivided one. Faces are output in the
+same order as with @ref subdivide().
+*/
+template<class Vertex, class Interpolator> void subdivideUnique(std::vector<UnsignedInt>& indices, std::vector<Vertex>& vertices, Interpolator interpolator) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::subdivideUnique(): index count is not divisible by 3!", );
+
+    const std::size_t indexCount = indices.size();
+    indices.reserve(indexCount*4);
+    /* A closed mesh has 3/2 edges per face, an open mesh at most three */
+    vertices.reserve(vertices.size() + indexCount/2);
+
+    /* Each edge is present at most once per face */
+    Implementation::SubdivideEdgeTable edges{indexCount};
+
+    for(std::size_t i = 0; i != indexCount; i += 3) {
+        UnsignedInt newVertices[3];
+        for(std::size_t j = 0; j != 3; ++j) {
+            const UnsignedInt a = indices[i + j];
+            const UnsignedInt b = indices[i + (j + 1)%3];
+            const std::pair<UnsignedInt, bool> found = edges.insert(a, b, vertices.size());
+            if(found.second) {
+                /* Make a copy in case the push_back() reallocates */
+                const Vertex v = interpolator(vertices[a], vertices[b]);
+                vertices.push_back(v);
+            }
+            newVertices[j] = found.first;
+        }
+
+        /* Same face layout as in subdivide() */
+        indices.push_back(indices[i]);
+        indices.push_back(newVertices[0]);
+        indices.push_back(newVertices[2]);
+        indices.push_back(newVertices[0]);
+        indices.push_back(indices[i + 1]);
+        indices.push_back(newVertices[1]);
+        indices.push_back(newVertices[2]);
+        indices.push_back(newVertices[1]);
+        indices.push_back(indices[i + 2]);
+        for(std::size_t j = 0; j != 3; ++j)
+            indices[i + j] = newVertices[j];
+    }
+}
+
 namespace Implementation {
 
 template<class Vertex, class Interpolator> void Subdivide<Vertex, Interpolator>::operator()(Interpolator interpolator) {
@@ -0,0 +1,184 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/CachedMeshBlob.h"
+#include "Magnum/MeshTools/MeshBlob.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/AssetCache.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct CachedMeshBlobTest: TestSuite::Tester {
+    explicit CachedMeshBlobTest();
+
+    void setup();
+
+    void noCache();
+    void cache();
+    void produceFailed();
+    void importer();
+    void importerDifferentPipeline();
+
+    private:
+        std::string _directory;
+};
+
+CachedMeshBlobTest::CachedMeshBlobTest(): _directory{Utility::Directory::join(MESHTOOLS_TEST_OUTPUT_DIR, "cachedmeshblob")} {
+    addTests({&CachedMeshBlobTest::noCache,
+              &CachedMeshBlobTest::cache,
+              &CachedMeshBlobTest::produceFailed,
+              &CachedMeshBlobTest::importer,
+              &CachedMeshBlobTest::importerDifferentPipeline},
+        &CachedMeshBlobTest::setup, &CachedMeshBlobTest::setup);
+}
+
+void CachedMeshBlobTest::setup() {
+    Trade::AssetCache{_directory}.clear();
+}
+
+namespace {
+
+Trade::MeshData3D triangle() {
+    return Trade::MeshData3D{MeshPrimitive::Triangles,
+        {0, 1, 2},
+        {{{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}}},
+        {}, {}, {}};
+}
+
+class MeshImporter: public Trade::AbstractImporter {
+    public:
+        explicit MeshImporter(): importCount{}, _opened{} {}
+
+        Int importCount;
+
+    private:
+        Features doFeatures() const override { return Feature::OpenData; }
+        bool doIsOpened() const override { return _opened; }
+        void doClose() override { _opened = false; }
+        void doOpenData(Containers::ArrayView<const char>) override { _opened = true; }
+
+        UnsignedInt doMesh3DCount() const override { return 1; }
+        std::optional<Trade::MeshData3D> doMesh3D(UnsignedInt) override {
+            ++importCount;
+            return triangle();
+        }
+
+        bool _opened;
+};
+
+constexpr const char Data[]{'o', 'b', 'j'};
+
+}
+
+void CachedMeshBlobTest::noCache() {
+    Int produceCount = 0;
+    const auto produce = [&produceCount]() {
+        ++produceCount;
+        return std::optional<Trade::MeshData3D>{triangle()};
+    };
+
+    CORRADE_VERIFY(MeshBlob::open(cachedMeshBlob("a", produce)));
+    CORRADE_VERIFY(MeshBlob::open(cachedMeshBlob("a", produce)));
+    CORRADE_COMPARE(produceCount, 2);
+}
+
+void CachedMeshBlobTest::cache() {
+    Trade::AssetCache assetCache{_directory};
+    Trade::AssetCache::setCurrent(&assetCache);
+
+    Int produceCount = 0;
+    const auto produce = [&produceCount]() {
+        ++produceCount;
+        return std::optional<Trade::MeshData3D>{triangle()};
+    };
+
+    const Containers::Array<char> first = cachedMeshBlob("a", produce);
+    const Containers::Array<char> second = cachedMeshBlob("a", produce);
+    CORRADE_COMPARE(produceCount, 1);
+    CORRADE_COMPARE(assetCache.hitCount(), 1);
+
+    std::optional<MeshBlob> blob = MeshBlob::open(second);
+    CORRADE_VERIFY(blob);
+    CORRADE_COMPARE(blob->vertexCount(), 3);
+    CORRADE_COMPARE(blob->indexCount(), 3);
+    CORRADE_COMPARE(second.size(), first.size());
+}
+
+void CachedMeshBlobTest::produceFailed() {
+    Trade::AssetCache assetCache{_directory};
+    Trade::AssetCache::setCurrent(&assetCache);
+
+    CORRADE_VERIFY(!cachedMeshBlob("a", []() { return std::optional<Trade::MeshData3D>{}; }));
+    CORRADE_COMPARE(assetCache.count(), 0);
+}
+
+void CachedMeshBlobTest::importer() {
+    Trade::AssetCache assetCache{_directory};
+    Trade::AssetCache::setCurrent(&assetCache);
+
+    MeshImporter importer;
+    CORRADE_VERIFY(importer.openData(Data));
+
+    Int processCount = 0;
+    const auto process = [&processCount](Trade::MeshData3D& meshData) {
+        ++processCount;
+        meshData.positions(0)[2] = {0.0f, 2.0f, 0.0f};
+    };
+
+    CORRADE_VERIFY(cachedMeshBlob(importer, 0, "stretch", process));
+    const Containers::Array<char> data = cachedMeshBlob(importer, 0, "stretch", process);
+    CORRADE_COMPARE(importer.importCount, 1);
+    CORRADE_COMPARE(processCount, 1);
+
+    /* The processed data are cached */
+    std::optional<MeshBlob> blob = MeshBlob::open(data);
+    CORRADE_VERIFY(blob);
+    CORRADE_COMPARE(blob->meshData().positions(0)[2], (Vector3{0.0f, 2.0f, 0.0f}));
+}
+
+void CachedMeshBlobTest::importerDifferentPipeline() {
+    Trade::AssetCache assetCache{_directory};
+    Trade::AssetCache::setCurrent(&assetCache);
+
+    MeshImporter importer;
+    CORRADE_VERIFY(importer.openData(Data));
+
+    CORRADE_VERIFY(cachedMeshBlob(importer, 0, "a", [](Trade::MeshData3D&) {}));
+    CORRADE_VERIFY(cachedMeshBlob(importer, 0, "b", [](Trade::MeshData3D&) {}));
+    CORRADE_COMPARE(importer.importCount, 2);
+    CORRADE_COMPARE(assetCache.count(), 2);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::CachedMeshBlobTest)
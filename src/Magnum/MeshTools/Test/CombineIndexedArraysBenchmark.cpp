@@ -0,0 +1,157 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <unordered_map>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/MurmurHash2.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/CombineIndexedArrays.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct CombineIndexedArraysBenchmark: TestSuite::Tester {
+    explicit CombineIndexedArraysBenchmark();
+
+    void unorderedMap();
+    void combineIndexArrays();
+    void combineIndexArraysStride5();
+};
+
+CombineIndexedArraysBenchmark::CombineIndexedArraysBenchmark() {
+    addBenchmarks({&CombineIndexedArraysBenchmark::unorderedMap,
+                   &CombineIndexedArraysBenchmark::combineIndexArrays,
+                   &CombineIndexedArraysBenchmark::combineIndexArraysStride5}, 4);
+}
+
+namespace {
+
+/* Index tuples of a scanned-like grid mesh, each vertex referenced from six
+   triangles, with positions, normals and texture coordinates indexed
+   separately as in OBJ files */
+std::vector<UnsignedInt> gridIndexTuples(const UnsignedInt size, const UnsignedInt stride) {
+    std::vector<UnsignedInt> out;
+    out.reserve((size - 1)*(size - 1)*6*stride);
+    for(UnsignedInt y = 0; y != size - 1; ++y) for(UnsignedInt x = 0; x != size - 1; ++x) {
+        const UnsignedInt i = y*size + x;
+        for(const UnsignedInt vertex: {i, i + 1, i + size + 1, i, i + size + 1, i + size})
+            for(UnsignedInt j = 0; j != stride; ++j)
+                out.push_back(vertex + j*7);
+    }
+    return out;
+}
+
+const std::vector<UnsignedInt>& data() {
+    static const std::vector<UnsignedInt> data = gridIndexTuples(512, 3);
+    return data;
+}
+
+/* The original implementation, for comparison */
+class IndexHash {
+    public:
+        explicit IndexHash(const std::vector<UnsignedInt>& indices, UnsignedInt stride): indices(indices), stride(stride) {}
+
+        std::size_t operator()(UnsignedInt key) const {
+            return *reinterpret_cast<const std::size_t*>(Utility::MurmurHash2()(reinterpret_cast<const char*>(indices.data()+key*stride), sizeof(UnsignedInt)*stride).byteArray());
+        }
+
+    private:
+        const std::vector<UnsignedInt>& indices;
+        UnsignedInt stride;
+};
+
+class IndexEqual {
+    public:
+        explicit IndexEqual(const std::vector<UnsignedInt>& indices, UnsignedInt stride): indices(indices), stride(stride) {}
+
+        bool operator()(UnsignedInt a, UnsignedInt b) const {
+            return std::memcmp(indices.data()+a*stride, indices.data()+b*stride, sizeof(UnsignedInt)*stride) == 0;
+        }
+
+    private:
+        const std::vector<UnsignedInt>& indices;
+        UnsignedInt stride;
+};
+
+std::pair<std::vector<UnsignedInt>, std::vector<UnsignedInt>> combineUnorderedMap(const std::vector<UnsignedInt>& interleavedArrays, const UnsignedInt stride) {
+    std::unordered_map<UnsignedInt, UnsignedInt, IndexHash, IndexEqual> indexCombinations(
+        interleavedArrays.size()/stride,
+        IndexHash(interleavedArrays, stride),
+        IndexEqual(interleavedArrays, stride));
+
+    std::vector<UnsignedInt> combinedIndices;
+    combinedIndices.reserve(interleavedArrays.size()/stride);
+    std::vector<UnsignedInt> newInterleavedArrays;
+    for(std::size_t oldIndex = 0, end = interleavedArrays.size()/stride; oldIndex != end; ++oldIndex) {
+        const auto result = indexCombinations.emplace(oldIndex, indexCombinations.size());
+        combinedIndices.push_back(result.first->second);
+        if(result.second) newInterleavedArrays.insert(newInterleavedArrays.end(),
+            interleavedArrays.begin()+oldIndex*stride,
+            interleavedArrays.begin()+(oldIndex+1)*stride);
+    }
+
+    return {std::move(combinedIndices), std::move(newInterleavedArrays)};
+}
+
+}
+
+void CombineIndexedArraysBenchmark::unorderedMap() {
+    const std::vector<UnsignedInt>& tuples = data();
+
+    std::size_t size = 0;
+    CORRADE_BENCHMARK(1)
+        size += combineUnorderedMap(tuples, 3).second.size();
+
+    CORRADE_VERIFY(size);
+}
+
+void CombineIndexedArraysBenchmark::combineIndexArrays() {
+    const std::vector<UnsignedInt>& tuples = data();
+
+    std::size_t size = 0;
+    CORRADE_BENCHMARK(1)
+        size += MeshTools::combineIndexArrays(tuples, 3).second.size();
+
+    CORRADE_VERIFY(size);
+
+    /* The output is the same as with the original implementation */
+    CORRADE_VERIFY(MeshTools::combineIndexArrays(tuples, 3) == combineUnorderedMap(tuples, 3));
+}
+
+void CombineIndexedArraysBenchmark::combineIndexArraysStride5() {
+    /* Stride that doesn't have a specialized code path */
+    static const std::vector<UnsignedInt> tuples = gridIndexTuples(384, 5);
+
+    std::size_t size = 0;
+    CORRADE_BENCHMARK(1)
+        size += MeshTools::combineIndexArrays(tuples, 5).second.size();
+
+    CORRADE_VERIFY(size);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::CombineIndexedArraysBenchmark)
@@ -36,11 +36,17 @@ struct GenerateFlatNormalsTest: TestSuite::Tester {
 
     void wrongIndexCount();
     void generate();
+    void provokingWrongIndexCount();
+    void provoking();
+    void provokingDuplicate();
 };
 
 GenerateFlatNormalsTest::GenerateFlatNormalsTest() {
     addTests({&GenerateFlatNormalsTest::wrongIndexCount,
-              &GenerateFlatNormalsTest::generate});
+              &GenerateFlatNormalsTest::generate,
+              &GenerateFlatNormalsTest::provokingWrongIndexCount,
+              &GenerateFlatNormalsTest::provoking,
+              &GenerateFlatNormalsTest::provokingDuplicate});
 }
 
 void GenerateFlatNormalsTest::wrongIndexCount() {
@@ -81,6 +87,89 @@ void GenerateFlatNormalsTest::generate() {
     }));
 }
 
+void GenerateFlatNormalsTest::provokingWrongIndexCount() {
+    std::stringstream ss;
+    Error redirectError{&ss};
+    std::vector<UnsignedInt> indices{0, 1};
+    std::vector<UnsignedInt> vertices;
+    std::vector<Vector3> normals;
+    std::tie(vertices, normals) = MeshTools::generateProvokingFlatNormals(indices, {});
+
+    CORRADE_COMPARE(vertices.size(), 0);
+    CORRADE_COMPARE(normals.size(), 0);
+    CORRADE_COMPARE(ss.str(), "MeshTools::generateProvokingFlatNormals(): index count is not divisible by 3!\n");
+}
+
+void GenerateFlatNormalsTest::provoking() {
+    /* Same as above, both faces already end with a distinct vertex so
+       nothing needs to be changed */
+    std::vector<UnsignedInt> indices{
+        0, 1, 2,
+        1, 2, 3
+    };
+    std::vector<UnsignedInt> vertices;
+    std::vector<Vector3> normals;
+    std::tie(vertices, normals) = MeshTools::generateProvokingFlatNormals(indices, {
+        {-1.0f, 0.0f, 0.0f},
+        {0.0f, -1.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f}
+    });
+
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{
+        0, 1, 2,
+        1, 2, 3
+    }));
+    CORRADE_COMPARE(vertices, (std::vector<UnsignedInt>{0, 1, 2, 3}));
+    CORRADE_COMPARE(normals, (std::vector<Vector3>{
+        {},
+        {},
+        Vector3::zAxis(),
+        -Vector3::zAxis()
+    }));
+}
+
+void GenerateFlatNormalsTest::provokingDuplicate() {
+    /* Closed square pyramid, six faces and just five vertices */
+    std::vector<UnsignedInt> indices{
+        1, 2, 0,
+        2, 3, 0,
+        3, 4, 0,
+        4, 1, 0,
+        1, 4, 3,
+        3, 2, 1
+    };
+    const std::vector<Vector3> positions{
+        {0.0f, 0.0f, 1.0f},
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {-1.0f, 0.0f, 0.0f},
+        {0.0f, -1.0f, 0.0f}
+    };
+    std::vector<UnsignedInt> vertices;
+    std::vector<Vector3> normals;
+    std::tie(vertices, normals) = MeshTools::generateProvokingFlatNormals(indices, positions);
+
+    /* Only the last face needs a duplicate vertex */
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{
+        1, 2, 0,
+        3, 0, 2,
+        4, 0, 3,
+        1, 0, 4,
+        4, 3, 1,
+        3, 2, 5
+    }));
+    CORRADE_COMPARE(vertices, (std::vector<UnsignedInt>{0, 1, 2, 3, 4, 1}));
+    CORRADE_COMPARE(normals, (std::vector<Vector3>{
+        Vector3{1.0f, 1.0f, 1.0f}.normalized(),
+        -Vector3::zAxis(),
+        Vector3{-1.0f, 1.0f, 1.0f}.normalized(),
+        Vector3{-1.0f, -1.0f, 1.0f}.normalized(),
+        Vector3{1.0f, -1.0f, 1.0f}.normalized(),
+        -Vector3::zAxis()
+    }));
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::GenerateFlatNormalsTest)
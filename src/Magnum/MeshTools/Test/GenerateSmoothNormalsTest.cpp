@@ -0,0 +1,243 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/GenerateSmoothNormals.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct GenerateSmoothNormalsTest: TestSuite::Tester {
+    explicit GenerateSmoothNormalsTest();
+
+    void wrongIndexCount();
+    void flat();
+    void weightingArea();
+    void weightingAngle();
+    void degenerate();
+    void thresholdHard();
+    void thresholdSmooth();
+    void parallel();
+
+    void debugWeighting();
+};
+
+GenerateSmoothNormalsTest::GenerateSmoothNormalsTest() {
+    addTests({&GenerateSmoothNormalsTest::wrongIndexCount,
+              &GenerateSmoothNormalsTest::flat,
+              &GenerateSmoothNormalsTest::weightingArea,
+              &GenerateSmoothNormalsTest::weightingAngle,
+              &GenerateSmoothNormalsTest::degenerate,
+              &GenerateSmoothNormalsTest::thresholdHard,
+              &GenerateSmoothNormalsTest::thresholdSmooth,
+              &GenerateSmoothNormalsTest::parallel,
+
+              &GenerateSmoothNormalsTest::debugWeighting});
+}
+
+namespace {
+
+/* Roof with the ridge along Z, the left slope is one quad, the right slope
+   is one quad as well, but the ridge vertices are split unevenly between its
+   triangles. All triangles have the same area. */
+const std::vector<UnsignedInt> RoofIndices{
+    1, 3, 2,
+    1, 2, 0,
+    3, 5, 4,
+    3, 4, 2
+};
+
+const std::vector<Vector3> RoofPositions{
+    {-1.0f, 0.0f, -1.0f},
+    {-1.0f, 0.0f,  1.0f},
+    { 0.0f, 1.0f, -1.0f},
+    { 0.0f, 1.0f,  1.0f},
+    { 1.0f, 0.0f, -1.0f},
+    { 1.0f, 0.0f,  1.0f}
+};
+
+}
+
+void GenerateSmoothNormalsTest::wrongIndexCount() {
+    std::stringstream ss;
+    Error redirectError{&ss};
+    std::vector<Vector3> normals = MeshTools::generateSmoothNormals({0, 1}, {});
+
+    std::vector<UnsignedInt> normalIndices;
+    std::tie(normalIndices, normals) = MeshTools::generateSmoothNormals({0, 1}, {}, Deg(30.0f));
+
+    CORRADE_COMPARE(normals.size(), 0);
+    CORRADE_COMPARE(normalIndices.size(), 0);
+    CORRADE_COMPARE(ss.str(),
+        "MeshTools::generateSmoothNormals(): index count is not divisible by 3!\n"
+        "MeshTools::generateSmoothNormals(): index count is not divisible by 3!\n");
+}
+
+void GenerateSmoothNormalsTest::flat() {
+    /* Quad in the XY plane, all normals are the same for any weighting */
+    const std::vector<UnsignedInt> indices{0, 1, 2, 0, 2, 3};
+    const std::vector<Vector3> positions{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {1.0f, 1.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f}
+    };
+
+    for(NormalWeighting weighting: {NormalWeighting::Uniform, NormalWeighting::Area, NormalWeighting::Angle}) {
+        CORRADE_COMPARE(MeshTools::generateSmoothNormals(indices, positions, weighting), (std::vector<Vector3>{
+            Vector3::zAxis(), Vector3::zAxis(), Vector3::zAxis(), Vector3::zAxis()
+        }));
+    }
+}
+
+void GenerateSmoothNormalsTest::weightingArea() {
+    /* The right slope has two triangles adjacent to vertex 3 and the left
+       slope two triangles adjacent to vertex 2, skewing the ridge normals */
+    const std::vector<Vector3> normals = MeshTools::generateSmoothNormals(RoofIndices, RoofPositions, NormalWeighting::Area);
+
+    CORRADE_COMPARE(normals, (std::vector<Vector3>{
+        Vector3{-1.0f, 1.0f, 0.0f}.normalized(),
+        Vector3{-1.0f, 1.0f, 0.0f}.normalized(),
+        Vector3{-1.0f, 3.0f, 0.0f}.normalized(),
+        Vector3{ 1.0f, 3.0f, 0.0f}.normalized(),
+        Vector3{ 1.0f, 1.0f, 0.0f}.normalized(),
+        Vector3{ 1.0f, 1.0f, 0.0f}.normalized()
+    }));
+
+    /* All triangles have the same area, so uniform weighting is the same */
+    CORRADE_COMPARE(MeshTools::generateSmoothNormals(RoofIndices, RoofPositions, NormalWeighting::Uniform), normals);
+}
+
+void GenerateSmoothNormalsTest::weightingAngle() {
+    /* Both slopes have 90° at each ridge vertex, independently of the
+       triangulation */
+    CORRADE_COMPARE(MeshTools::generateSmoothNormals(RoofIndices, RoofPositions, NormalWeighting::Angle), (std::vector<Vector3>{
+        Vector3{-1.0f, 1.0f, 0.0f}.normalized(),
+        Vector3{-1.0f, 1.0f, 0.0f}.normalized(),
+        Vector3::yAxis(),
+        Vector3::yAxis(),
+        Vector3{ 1.0f, 1.0f, 0.0f}.normalized(),
+        Vector3{ 1.0f, 1.0f, 0.0f}.normalized()
+    }));
+}
+
+void GenerateSmoothNormalsTest::degenerate() {
+    /* Zero-area face doesn't contribute, vertex 4 is not referenced at all */
+    CORRADE_COMPARE(MeshTools::generateSmoothNormals({
+        0, 1, 2,
+        0, 1, 3
+    }, {
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {2.0f, 0.0f, 0.0f},
+        {5.0f, 5.0f, 5.0f}
+    }), (std::vector<Vector3>{
+        Vector3::zAxis(),
+        Vector3::zAxis(),
+        Vector3::zAxis(),
+        Vector3{},
+        Vector3{}
+    }));
+}
+
+void GenerateSmoothNormalsTest::thresholdHard() {
+    /* The slopes are 90° apart, so the ridge stays hard */
+    std::vector<UnsignedInt> normalIndices;
+    std::vector<Vector3> normals;
+    std::tie(normalIndices, normals) = MeshTools::generateSmoothNormals(RoofIndices, RoofPositions, Deg(45.0f));
+
+    CORRADE_COMPARE(normalIndices, (std::vector<UnsignedInt>{
+        0, 0, 0,
+        0, 0, 0,
+        1, 1, 1,
+        1, 1, 1
+    }));
+    CORRADE_COMPARE(normals, (std::vector<Vector3>{
+        Vector3{-1.0f, 1.0f, 0.0f}.normalized(),
+        Vector3{ 1.0f, 1.0f, 0.0f}.normalized()
+    }));
+}
+
+void GenerateSmoothNormalsTest::thresholdSmooth() {
+    /* Threshold above the angle, the same as without threshold */
+    std::vector<UnsignedInt> normalIndices;
+    std::vector<Vector3> normals;
+    std::tie(normalIndices, normals) = MeshTools::generateSmoothNormals(RoofIndices, RoofPositions, Deg(100.0f));
+
+    CORRADE_COMPARE(normalIndices, (std::vector<UnsignedInt>{
+        0, 1, 1,
+        0, 1, 0,
+        1, 2, 2,
+        1, 2, 1
+    }));
+    CORRADE_COMPARE(normals, (std::vector<Vector3>{
+        Vector3{-1.0f, 1.0f, 0.0f}.normalized(),
+        Vector3::yAxis(),
+        Vector3{ 1.0f, 1.0f, 0.0f}.normalized()
+    }));
+}
+
+void GenerateSmoothNormalsTest::parallel() {
+    /* Wavy grid large enough to trigger the parallel path */
+    constexpr UnsignedInt Size = 257;
+    std::vector<Vector3> positions;
+    positions.reserve(Size*Size);
+    for(UnsignedInt y = 0; y != Size; ++y) for(UnsignedInt x = 0; x != Size; ++x)
+        positions.emplace_back(Float(x), Float(y), Math::sin(Rad(x*0.3f))*Math::cos(Rad(y*0.2f)));
+
+    std::vector<UnsignedInt> indices;
+    indices.reserve((Size - 1)*(Size - 1)*6);
+    for(UnsignedInt y = 0; y != Size - 1; ++y) for(UnsignedInt x = 0; x != Size - 1; ++x) {
+        const UnsignedInt i = y*Size + x;
+        indices.insert(indices.end(), {i, i + 1, i + Size + 1, i, i + Size + 1, i + Size});
+    }
+
+    const std::vector<Vector3> serial = MeshTools::generateSmoothNormals(indices, positions, NormalWeighting::Angle, 1);
+    const std::vector<Vector3> parallel = MeshTools::generateSmoothNormals(indices, positions, NormalWeighting::Angle, 4);
+    CORRADE_VERIFY(serial == parallel);
+    CORRADE_COMPARE(serial[0].length(), 1.0f);
+
+    std::vector<UnsignedInt> serialIndices, parallelIndices;
+    std::vector<Vector3> serialNormals, parallelNormals;
+    std::tie(serialIndices, serialNormals) = MeshTools::generateSmoothNormals(indices, positions, Deg(30.0f), NormalWeighting::Area, 1);
+    std::tie(parallelIndices, parallelNormals) = MeshTools::generateSmoothNormals(indices, positions, Deg(30.0f), NormalWeighting::Area, 4);
+    CORRADE_VERIFY(serialIndices == parallelIndices);
+    CORRADE_VERIFY(serialNormals == parallelNormals);
+}
+
+void GenerateSmoothNormalsTest::debugWeighting() {
+    std::ostringstream out;
+
+    Debug(&out) << NormalWeighting::Area << NormalWeighting(0xde);
+    CORRADE_COMPARE(out.str(), "MeshTools::NormalWeighting::Area MeshTools::NormalWeighting(0xde)\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::GenerateSmoothNormalsTest)
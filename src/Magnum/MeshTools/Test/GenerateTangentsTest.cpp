@@ -0,0 +1,198 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Vector4.h"
+#include "Magnum/MeshTools/GenerateSmoothNormals.h"
+#include "Magnum/MeshTools/GenerateTangents.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct GenerateTangentsTest: TestSuite::Tester {
+    explicit GenerateTangentsTest();
+
+    void wrongIndexCount();
+    void wrongAttributeCount();
+    void generate();
+    void mirrored();
+    void orthogonalized();
+    void noTextureMapping();
+    void parallel();
+};
+
+GenerateTangentsTest::GenerateTangentsTest() {
+    addTests({&GenerateTangentsTest::wrongIndexCount,
+              &GenerateTangentsTest::wrongAttributeCount,
+              &GenerateTangentsTest::generate,
+              &GenerateTangentsTest::mirrored,
+              &GenerateTangentsTest::orthogonalized,
+              &GenerateTangentsTest::noTextureMapping,
+              &GenerateTangentsTest::parallel});
+}
+
+namespace {
+
+const std::vector<UnsignedInt> QuadIndices{0, 1, 2, 0, 2, 3};
+
+const std::vector<Vector3> QuadPositions{
+    {-1.0f, -1.0f, 0.0f},
+    { 1.0f, -1.0f, 0.0f},
+    { 1.0f,  1.0f, 0.0f},
+    {-1.0f,  1.0f, 0.0f}
+};
+
+const std::vector<Vector3> QuadNormals{
+    Vector3::zAxis(), Vector3::zAxis(), Vector3::zAxis(), Vector3::zAxis()
+};
+
+}
+
+void GenerateTangentsTest::wrongIndexCount() {
+    std::stringstream ss;
+    Error redirectError{&ss};
+    const std::vector<Vector4> tangents = MeshTools::generateTangents({0, 1}, {}, {}, {});
+
+    CORRADE_COMPARE(tangents.size(), 0);
+    CORRADE_COMPARE(ss.str(), "MeshTools::generateTangents(): index count is not divisible by 3!\n");
+}
+
+void GenerateTangentsTest::wrongAttributeCount() {
+    std::stringstream ss;
+    Error redirectError{&ss};
+    const std::vector<Vector4> tangents = MeshTools::generateTangents(QuadIndices, QuadPositions, QuadNormals, {{}, {}, {}});
+
+    CORRADE_COMPARE(tangents.size(), 0);
+    CORRADE_COMPARE(ss.str(), "MeshTools::generateTangents(): expected 4 normals and texture coordinates but got 4 and 3\n");
+}
+
+void GenerateTangentsTest::generate() {
+    /* U along X, V along Y, right-handed */
+    CORRADE_COMPARE(MeshTools::generateTangents(QuadIndices, QuadPositions, QuadNormals, {
+        {0.0f, 0.0f},
+        {1.0f, 0.0f},
+        {1.0f, 1.0f},
+        {0.0f, 1.0f}
+    }), (std::vector<Vector4>{
+        {1.0f, 0.0f, 0.0f, 1.0f},
+        {1.0f, 0.0f, 0.0f, 1.0f},
+        {1.0f, 0.0f, 0.0f, 1.0f},
+        {1.0f, 0.0f, 0.0f, 1.0f}
+    }));
+
+    /* U along Y, V along -X, still right-handed */
+    CORRADE_COMPARE(MeshTools::generateTangents(QuadIndices, QuadPositions, QuadNormals, {
+        {0.0f, 1.0f},
+        {0.0f, 0.0f},
+        {1.0f, 0.0f},
+        {1.0f, 1.0f}
+    }), (std::vector<Vector4>{
+        {0.0f, 1.0f, 0.0f, 1.0f},
+        {0.0f, 1.0f, 0.0f, 1.0f},
+        {0.0f, 1.0f, 0.0f, 1.0f},
+        {0.0f, 1.0f, 0.0f, 1.0f}
+    }));
+}
+
+void GenerateTangentsTest::mirrored() {
+    /* U along -X, V along Y, the tangent space is left-handed */
+    CORRADE_COMPARE(MeshTools::generateTangents(QuadIndices, QuadPositions, QuadNormals, {
+        {1.0f, 0.0f},
+        {0.0f, 0.0f},
+        {0.0f, 1.0f},
+        {1.0f, 1.0f}
+    }), (std::vector<Vector4>{
+        {-1.0f, 0.0f, 0.0f, -1.0f},
+        {-1.0f, 0.0f, 0.0f, -1.0f},
+        {-1.0f, 0.0f, 0.0f, -1.0f},
+        {-1.0f, 0.0f, 0.0f, -1.0f}
+    }));
+}
+
+void GenerateTangentsTest::orthogonalized() {
+    /* Vertex normals tilted in the direction of U, tangents are
+       perpendicular to them */
+    const Vector3 normal = Vector3{1.0f, 0.0f, 1.0f}.normalized();
+    const std::vector<Vector4> tangents = MeshTools::generateTangents(QuadIndices, QuadPositions, {normal, normal, normal, normal}, {
+        {0.0f, 0.0f},
+        {1.0f, 0.0f},
+        {1.0f, 1.0f},
+        {0.0f, 1.0f}
+    });
+
+    const Vector4 expected{Vector3{1.0f, 0.0f, -1.0f}.normalized(), 1.0f};
+    CORRADE_COMPARE(tangents, (std::vector<Vector4>{
+        expected, expected, expected, expected
+    }));
+}
+
+void GenerateTangentsTest::noTextureMapping() {
+    /* All texture coordinates the same, the tangent is just some vector
+       perpendicular to the normal */
+    const std::vector<Vector4> tangents = MeshTools::generateTangents(QuadIndices, QuadPositions, QuadNormals, {
+        {0.5f, 0.5f},
+        {0.5f, 0.5f},
+        {0.5f, 0.5f},
+        {0.5f, 0.5f}
+    });
+
+    CORRADE_COMPARE(tangents.size(), 4);
+    for(const Vector4& tangent: tangents) {
+        CORRADE_COMPARE(tangent.xyz().length(), 1.0f);
+        CORRADE_COMPARE(Math::dot(tangent.xyz(), Vector3::zAxis()), 0.0f);
+        CORRADE_COMPARE(tangent.w(), 1.0f);
+    }
+}
+
+void GenerateTangentsTest::parallel() {
+    /* Bumpy grid large enough to trigger the parallel path */
+    constexpr UnsignedInt Size = 257;
+    std::vector<Vector3> positions;
+    std::vector<Vector2> textureCoordinates;
+    positions.reserve(Size*Size);
+    textureCoordinates.reserve(Size*Size);
+    for(UnsignedInt y = 0; y != Size; ++y) for(UnsignedInt x = 0; x != Size; ++x) {
+        positions.emplace_back(Float(x), Float(y), Float((x*7 + y*3)%5)*0.1f);
+        textureCoordinates.emplace_back(Float(x)/Size, Float(y)/Size);
+    }
+
+    std::vector<UnsignedInt> indices;
+    indices.reserve((Size - 1)*(Size - 1)*6);
+    for(UnsignedInt y = 0; y != Size - 1; ++y) for(UnsignedInt x = 0; x != Size - 1; ++x) {
+        const UnsignedInt i = y*Size + x;
+        indices.insert(indices.end(), {i, i + 1, i + Size + 1, i, i + Size + 1, i + Size});
+    }
+
+    const std::vector<Vector3> normals = MeshTools::generateSmoothNormals(indices, positions);
+    const std::vector<Vector4> serial = MeshTools::generateTangents(indices, positions, normals, textureCoordinates, 1);
+    const std::vector<Vector4> parallel = MeshTools::generateTangents(indices, positions, normals, textureCoordinates, 4);
+    CORRADE_VERIFY(serial == parallel);
+    CORRADE_COMPARE(serial[Size + 1].w(), 1.0f);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::GenerateTangentsTest)
@@ -0,0 +1,141 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/MeshTools/GenerateWireframeCorners.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct GenerateWireframeCornersTest: TestSuite::Tester {
+    explicit GenerateWireframeCornersTest();
+
+    void wrongIndexCount();
+    void empty();
+    void triangle();
+    void grid();
+    void conflict();
+};
+
+GenerateWireframeCornersTest::GenerateWireframeCornersTest() {
+    addTests({&GenerateWireframeCornersTest::wrongIndexCount,
+              &GenerateWireframeCornersTest::empty,
+              &GenerateWireframeCornersTest::triangle,
+              &GenerateWireframeCornersTest::grid,
+              &GenerateWireframeCornersTest::conflict});
+}
+
+namespace {
+
+/* Verifies that the new mesh references the same vertices as the original
+   and that all triangle corners are different */
+bool isValid(const std::vector<UnsignedInt>& originalIndices, const std::vector<UnsignedInt>& indices, const std::vector<UnsignedInt>& vertexIds, const std::vector<UnsignedByte>& corners) {
+    if(indices.size() != originalIndices.size() || vertexIds.size() != corners.size()) return false;
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        if(indices[i] >= vertexIds.size() || vertexIds[indices[i]] != originalIndices[i]) return false;
+    for(std::size_t i = 0; i != indices.size(); i += 3) {
+        const UnsignedByte a = corners[indices[i]], b = corners[indices[i + 1]], c = corners[indices[i + 2]];
+        if(a > 2 || b > 2 || c > 2 || a == b || b == c || a == c) return false;
+    }
+    return true;
+}
+
+}
+
+void GenerateWireframeCornersTest::wrongIndexCount() {
+    std::stringstream ss;
+    Error redirectError{&ss};
+    std::vector<UnsignedInt> indices, vertexIds;
+    std::vector<UnsignedByte> corners;
+    std::tie(indices, vertexIds, corners) = MeshTools::generateWireframeCorners({0, 1});
+
+    CORRADE_VERIFY(indices.empty());
+    CORRADE_COMPARE(ss.str(), "MeshTools::generateWireframeCorners(): index count is not divisible by 3!\n");
+}
+
+void GenerateWireframeCornersTest::empty() {
+    std::vector<UnsignedInt> indices, vertexIds;
+    std::vector<UnsignedByte> corners;
+    std::tie(indices, vertexIds, corners) = MeshTools::generateWireframeCorners({});
+
+    CORRADE_VERIFY(indices.empty());
+    CORRADE_VERIFY(vertexIds.empty());
+    CORRADE_VERIFY(corners.empty());
+}
+
+void GenerateWireframeCornersTest::triangle() {
+    std::vector<UnsignedInt> indices, vertexIds;
+    std::vector<UnsignedByte> corners;
+    std::tie(indices, vertexIds, corners) = MeshTools::generateWireframeCorners({2, 0, 1});
+
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{0, 1, 2}));
+    CORRADE_COMPARE(vertexIds, (std::vector<UnsignedInt>{2, 0, 1}));
+    CORRADE_COMPARE(corners, (std::vector<UnsignedByte>{0, 1, 2}));
+}
+
+void GenerateWireframeCornersTest::grid() {
+    /* 32x32 quads, each split into two triangles along the same diagonal,
+       which is a 3-colorable triangulation, so no vertex needs to be
+       duplicated */
+    constexpr UnsignedInt Size = 32;
+    std::vector<UnsignedInt> original;
+    for(UnsignedInt y = 0; y != Size; ++y) for(UnsignedInt x = 0; x != Size; ++x) {
+        const UnsignedInt a = y*(Size + 1) + x, b = a + 1, c = a + Size + 1, d = c + 1;
+        original.insert(original.end(), {a, b, d, a, d, c});
+    }
+
+    std::vector<UnsignedInt> indices, vertexIds;
+    std::vector<UnsignedByte> corners;
+    std::tie(indices, vertexIds, corners) = MeshTools::generateWireframeCorners(original);
+
+    CORRADE_VERIFY(isValid(original, indices, vertexIds, corners));
+    CORRADE_COMPARE(vertexIds.size(), (Size + 1)*(Size + 1));
+}
+
+void GenerateWireframeCornersTest::conflict() {
+    /* A fan of five triangles around a vertex, where the outer vertices
+       form an odd cycle and thus can't alternate between two corners, and a
+       tetrahedron, where all four vertices are connected with each other */
+    const std::vector<UnsignedInt> original{
+        0, 1, 2,  0, 2, 3,  0, 3, 4,  0, 4, 5,  0, 5, 1,
+        6, 7, 8,  6, 8, 9,  6, 9, 7,  7, 9, 8
+    };
+
+    std::vector<UnsignedInt> indices, vertexIds;
+    std::vector<UnsignedByte> corners;
+    std::tie(indices, vertexIds, corners) = MeshTools::generateWireframeCorners(original);
+
+    CORRADE_VERIFY(isValid(original, indices, vertexIds, corners));
+
+    /* Some vertices needed to be duplicated, but far less than for a
+       non-indexed mesh */
+    CORRADE_VERIFY(vertexIds.size() > 10);
+    CORRADE_VERIFY(vertexIds.size() < original.size());
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::GenerateWireframeCornersTest)
@@ -23,6 +23,8 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <cstring>
+#include <list>
 #include <sstream>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/Endianness.h>
@@ -39,10 +41,14 @@ struct InterleaveTest: Corrade::TestSuite::Tester {
     void attributeCountGaps();
     void stride();
     void strideGaps();
+    void strideConverted();
     void write();
     void writeGaps();
+    void writeConverted();
+    void writeTiled();
 
     void interleaveInto();
+    void interleaveIntoConverted();
 };
 
 InterleaveTest::InterleaveTest() {
@@ -50,10 +56,14 @@ InterleaveTest::InterleaveTest() {
               &InterleaveTest::attributeCountGaps,
               &InterleaveTest::stride,
               &InterleaveTest::strideGaps,
+              &InterleaveTest::strideConverted,
               &InterleaveTest::write,
               &InterleaveTest::writeGaps,
+              &InterleaveTest::writeConverted,
+              &InterleaveTest::writeTiled,
 
-              &InterleaveTest::interleaveInto});
+              &InterleaveTest::interleaveInto,
+              &InterleaveTest::interleaveIntoConverted});
 }
 
 void InterleaveTest::attributeCount() {
@@ -85,6 +95,11 @@ void InterleaveTest::strideGaps() {
     CORRADE_COMPARE((Implementation::Stride{}(2, std::vector<Byte>(), 1, std::vector<Int>(), 12)), std::size_t(20));
 }
 
+void InterleaveTest::strideConverted() {
+    const std::vector<Int> a;
+    CORRADE_COMPARE((Implementation::Stride{}(MeshTools::converted(a, [](Int i) { return Byte(i); }), 1, a)), std::size_t(6));
+}
+
 void InterleaveTest::write() {
     const Containers::Array<char> data = MeshTools::interleave(
         std::vector<Byte>{0, 1, 2},
@@ -129,6 +144,57 @@ void InterleaveTest::writeGaps() {
     }
 }
 
+void InterleaveTest::writeConverted() {
+    const std::vector<Int> a{3, 4, 5};
+    const std::vector<Float> b{6.0f, 7.0f, 8.0f};
+    const Containers::Array<char> data = MeshTools::interleave(
+        std::vector<Byte>{0, 1, 2},
+        MeshTools::converted(a, [](Int i) { return Short(i*2); }), 1,
+        MeshTools::converted(b, [](Float f) { return Byte(f); }));
+
+    if(!Utility::Endianness::isBigEndian()) {
+        /*  byte, short_____, _gap, byte */
+        CORRADE_COMPARE(std::vector<char>(data.begin(), data.end()), (std::vector<char>{
+            0x00, 0x06, 0x00, 0x00, 0x06,
+            0x01, 0x08, 0x00, 0x00, 0x07,
+            0x02, 0x0a, 0x00, 0x00, 0x08
+        }));
+    } else {
+        /*  byte, _____short, _gap, byte */
+        CORRADE_COMPARE(std::vector<char>(data.begin(), data.end()), (std::vector<char>{
+            0x00, 0x00, 0x06, 0x00, 0x06,
+            0x01, 0x00, 0x08, 0x00, 0x07,
+            0x02, 0x00, 0x0a, 0x00, 0x08
+        }));
+    }
+}
+
+void InterleaveTest::writeTiled() {
+    /* More vertices than fits into one tile, the list has only a forward
+       iterator so the position has to be preserved across tiles */
+    constexpr std::size_t Count = Implementation::InterleaveTileSize/4 + 17;
+    std::vector<UnsignedShort> a(Count);
+    std::list<UnsignedByte> b;
+    for(std::size_t i = 0; i != Count; ++i) {
+        a[i] = UnsignedShort(i);
+        b.push_back(UnsignedByte(i*3));
+    }
+
+    const Containers::Array<char> data = MeshTools::interleave(a,
+        MeshTools::converted(b, [](UnsignedByte i) { return UnsignedByte(i + 1); }), 1);
+    CORRADE_COMPARE(data.size(), Count*4);
+
+    bool equal = true;
+    for(std::size_t i = 0; i != Count && equal; ++i) {
+        UnsignedShort first;
+        std::memcpy(&first, data + i*4, 2);
+        equal = first == UnsignedShort(i) &&
+            UnsignedByte(data[i*4 + 2]) == UnsignedByte(i*3 + 1) &&
+            data[i*4 + 3] == 0;
+    }
+    CORRADE_VERIFY(equal);
+}
+
 void InterleaveTest::interleaveInto() {
     Containers::Array<char> data{Containers::InPlaceInit, {
         0x11, 0x33, 0x55, 0x77, 0x11, 0x33, 0x55, 0x77, 0x11, 0x33, 0x55, 0x77,
@@ -157,6 +223,31 @@ void InterleaveTest::interleaveInto() {
     }
 }
 
+void InterleaveTest::interleaveIntoConverted() {
+    Containers::Array<char> data{Containers::InPlaceInit, {
+        0x11, 0x33, 0x55, 0x77, 0x11, 0x33,
+        0x11, 0x33, 0x55, 0x77, 0x11, 0x33}};
+
+    const std::vector<Float> a{4.0f, 5.0f};
+    MeshTools::interleaveInto(data, 2, MeshTools::converted(a, [](Float f) {
+        return Int(f);
+    }));
+
+    if(!Utility::Endianness::isBigEndian()) {
+        /*  _______gap, int___________________ */
+        CORRADE_COMPARE(std::vector<char>(data.begin(), data.end()), (std::vector<char>{
+            0x11, 0x33, 0x04, 0x00, 0x00, 0x00,
+            0x11, 0x33, 0x05, 0x00, 0x00, 0x00
+        }));
+    } else {
+        /*  _______gap, ___________________int */
+        CORRADE_COMPARE(std::vector<char>(data.begin(), data.end()), (std::vector<char>{
+            0x11, 0x33, 0x00, 0x00, 0x00, 0x04,
+            0x11, 0x33, 0x00, 0x00, 0x00, 0x05
+        }));
+    }
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::InterleaveTest)
@@ -0,0 +1,411 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/Math/Color.h"
+#include "Magnum/MeshTools/MeshBlob.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct MeshBlobTest: TestSuite::Tester {
+    explicit MeshBlobTest();
+
+    void serialize();
+    void serializeNotIndexed();
+    void serializeLargeIndices();
+    void roundtrip();
+    void serializeEncoded();
+    void serializeEncodedNotTriangles();
+    void roundtripEncoded();
+    void meshDataInvalidEncoded();
+
+    void openTooShort();
+    void openInvalidSignature();
+    void openInvalidVersion();
+    void openInvalidVertexLayout();
+    void openInvalidVertexRange();
+    void openInvalidIndexType();
+    void openInvalidIndexRange();
+};
+
+MeshBlobTest::MeshBlobTest() {
+    addTests({&MeshBlobTest::serialize,
+              &MeshBlobTest::serializeNotIndexed,
+              &MeshBlobTest::serializeLargeIndices,
+              &MeshBlobTest::roundtrip,
+              &MeshBlobTest::serializeEncoded,
+              &MeshBlobTest::serializeEncodedNotTriangles,
+              &MeshBlobTest::roundtripEncoded,
+              &MeshBlobTest::meshDataInvalidEncoded,
+
+              &MeshBlobTest::openTooShort,
+              &MeshBlobTest::openInvalidSignature,
+              &MeshBlobTest::openInvalidVersion,
+              &MeshBlobTest::openInvalidVertexLayout,
+              &MeshBlobTest::openInvalidVertexRange,
+              &MeshBlobTest::openInvalidIndexType,
+              &MeshBlobTest::openInvalidIndexRange});
+}
+
+namespace {
+
+Trade::MeshData3D texturedTriangles() {
+    return Trade::MeshData3D{MeshPrimitive::Triangles,
+        {0, 1, 2, 2, 1, 3},
+        {{{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {1.0f, 1.0f, 0.0f}}},
+        {{{0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, -1.0f}}},
+        {{{0.0f, 0.0f}, {1.0f, 0.0f}, {0.0f, 1.0f}, {1.0f, 1.0f}}},
+        {}, nullptr};
+}
+
+/* Patches a 32-bit header field */
+void patch(Containers::Array<char>& data, const std::size_t field, const UnsignedInt value) {
+    std::memcpy(data + field*4, &value, 4);
+}
+
+}
+
+void MeshBlobTest::serialize() {
+    const Containers::Array<char> data = MeshBlob::serialize(texturedTriangles());
+
+    /* Header, 4 vertices with 32 bytes each, 6 byte indices padded to 8 */
+    CORRADE_COMPARE(data.size(), 64 + 4*32 + 8);
+    CORRADE_COMPARE(std::string(data, 4), "MBLB");
+
+    std::optional<MeshBlob> blob = MeshBlob::open(data);
+    CORRADE_VERIFY(blob);
+    CORRADE_COMPARE(blob->primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(blob->vertexCount(), 4);
+    CORRADE_COMPARE(blob->stride(), 32);
+    CORRADE_VERIFY(blob->hasNormals());
+    CORRADE_COMPARE(blob->normalOffset(), 12);
+    CORRADE_VERIFY(blob->hasTextureCoords2D());
+    CORRADE_COMPARE(blob->textureCoords2DOffset(), 24);
+    CORRADE_VERIFY(blob->isIndexed());
+    CORRADE_COMPARE(blob->indexCount(), 6);
+    CORRADE_COMPARE(blob->indexType(), Mesh::IndexType::UnsignedByte);
+    CORRADE_COMPARE(blob->indexStart(), 0);
+    CORRADE_COMPARE(blob->indexEnd(), 3);
+
+    /* The data are not copied */
+    CORRADE_VERIFY(blob->vertexData().data() == data + 64);
+    CORRADE_COMPARE(blob->vertexData().size(), 4*32);
+    CORRADE_VERIFY(blob->indexData().data() == data + 64 + 4*32);
+    CORRADE_COMPARE_AS(blob->indexData(),
+        (Containers::Array<char>{Containers::InPlaceInit, {0, 1, 2, 2, 1, 3}}),
+        TestSuite::Compare::Container);
+
+    /* Interleaved position, normal and texture coordinates of 2nd vertex */
+    Float vertex[8];
+    std::memcpy(vertex, blob->vertexData().data() + 32, 32);
+    CORRADE_COMPARE(Vector3::from(vertex), (Vector3{1.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(Vector3::from(vertex + 3), (Vector3{0.0f, 0.0f, 1.0f}));
+    CORRADE_COMPARE(Vector2::from(vertex + 6), (Vector2{1.0f, 0.0f}));
+}
+
+void MeshBlobTest::serializeNotIndexed() {
+    const Containers::Array<char> data = MeshBlob::serialize(Trade::MeshData3D{MeshPrimitive::Points,
+        {}, {{{1.0f, 2.0f, 3.0f}, {4.0f, 5.0f, 6.0f}}}, {}, {}, {}, nullptr});
+    CORRADE_COMPARE(data.size(), 64 + 2*12);
+
+    std::optional<MeshBlob> blob = MeshBlob::open(data);
+    CORRADE_VERIFY(blob);
+    CORRADE_COMPARE(blob->primitive(), MeshPrimitive::Points);
+    CORRADE_COMPARE(blob->vertexCount(), 2);
+    CORRADE_COMPARE(blob->stride(), 12);
+    CORRADE_VERIFY(!blob->hasNormals());
+    CORRADE_VERIFY(!blob->hasTextureCoords2D());
+    CORRADE_VERIFY(!blob->isIndexed());
+    CORRADE_VERIFY(blob->indexData().empty());
+}
+
+void MeshBlobTest::serializeLargeIndices() {
+    std::vector<Vector3> positions(70000);
+    const Containers::Array<char> data = MeshBlob::serialize(Trade::MeshData3D{MeshPrimitive::Lines,
+        {69999, 3}, {positions}, {}, {}, {}, nullptr});
+
+    std::optional<MeshBlob> blob = MeshBlob::open(data);
+    CORRADE_VERIFY(blob);
+    CORRADE_COMPARE(blob->indexType(), Mesh::IndexType::UnsignedInt);
+    CORRADE_COMPARE(blob->indexStart(), 3);
+    CORRADE_COMPARE(blob->indexEnd(), 69999);
+    CORRADE_COMPARE(blob->indexData().size(), 8);
+    CORRADE_COMPARE(blob->meshData().indices(), (std::vector<UnsignedInt>{69999, 3}));
+}
+
+void MeshBlobTest::roundtrip() {
+    const Trade::MeshData3D original = texturedTriangles();
+    const Containers::Array<char> data = MeshBlob::serialize(original);
+    std::optional<MeshBlob> blob = MeshBlob::open(data);
+    CORRADE_VERIFY(blob);
+
+    int state;
+    const Trade::MeshData3D meshData = blob->meshData(&state);
+    CORRADE_COMPARE(meshData.primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(meshData.indices(), original.indices());
+    CORRADE_COMPARE(meshData.positionArrayCount(), 1);
+    CORRADE_COMPARE(meshData.positions(0), original.positions(0));
+    CORRADE_COMPARE(meshData.normalArrayCount(), 1);
+    CORRADE_COMPARE(meshData.normals(0), original.normals(0));
+    CORRADE_COMPARE(meshData.textureCoords2DArrayCount(), 1);
+    CORRADE_COMPARE(meshData.textureCoords2D(0), original.textureCoords2D(0));
+    CORRADE_COMPARE(meshData.importerState(), &state);
+}
+
+void MeshBlobTest::serializeEncoded() {
+    const Containers::Array<char> data = MeshBlob::serialize(texturedTriangles(),
+        MeshBlob::Flag::EncodeVertices|MeshBlob::Flag::EncodeIndices);
+
+    std::optional<MeshBlob> blob = MeshBlob::open(data);
+    CORRADE_VERIFY(blob);
+    CORRADE_VERIFY(blob->isVertexDataEncoded());
+    CORRADE_VERIFY(blob->isIndexDataEncoded());
+
+    /* The header describes the decoded data */
+    CORRADE_COMPARE(blob->vertexCount(), 4);
+    CORRADE_COMPARE(blob->stride(), 32);
+    CORRADE_COMPARE(blob->indexCount(), 6);
+    CORRADE_COMPARE(blob->indexType(), Mesh::IndexType::UnsignedByte);
+    CORRADE_COMPARE(blob->indexStart(), 0);
+    CORRADE_COMPARE(blob->indexEnd(), 3);
+
+    /* Index data are aligned even though the encoded vertex data aren't */
+    CORRADE_VERIFY(blob->vertexData().data() == data + 64);
+    CORRADE_VERIFY(blob->vertexData().size() != 4*32);
+    CORRADE_COMPARE(std::size_t(blob->indexData().data() - data.data()) % 4, 0);
+}
+
+void MeshBlobTest::serializeEncodedNotTriangles() {
+    const Containers::Array<char> data = MeshBlob::serialize(Trade::MeshData3D{MeshPrimitive::Lines,
+        {0, 1, 1, 2}, {{{}, {}, {}}}, {}, {}, {}, nullptr}, MeshBlob::Flag::EncodeIndices);
+
+    /* Only triangle indices can be encoded */
+    std::optional<MeshBlob> blob = MeshBlob::open(data);
+    CORRADE_VERIFY(blob);
+    CORRADE_VERIFY(!blob->isVertexDataEncoded());
+    CORRADE_VERIFY(!blob->isIndexDataEncoded());
+    CORRADE_COMPARE_AS(blob->indexData(),
+        (Containers::Array<char>{Containers::InPlaceInit, {0, 1, 1, 2}}),
+        TestSuite::Compare::Container);
+}
+
+void MeshBlobTest::roundtripEncoded() {
+    /* A grid large enough for 16-bit indices and several vertex blocks */
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions, normals;
+    std::vector<Vector2> textureCoords2D;
+    for(Int y = 0; y != 20; ++y) for(Int x = 0; x != 20; ++x) {
+        positions.emplace_back(x*0.5f, y*0.25f, Float(x*y)*0.01f);
+        normals.emplace_back(0.0f, 0.0f, 1.0f);
+        textureCoords2D.emplace_back(x/19.0f, y/19.0f);
+        if(x == 19 || y == 19) continue;
+        const UnsignedInt a = y*20 + x;
+        indices.insert(indices.end(), {a, a + 1, a + 21, a, a + 21, a + 20});
+    }
+    const Trade::MeshData3D original{MeshPrimitive::Triangles, indices, {positions}, {normals}, {textureCoords2D}, {}, nullptr};
+
+    const Containers::Array<char> data = MeshBlob::serialize(original,
+        MeshBlob::Flag::EncodeVertices|MeshBlob::Flag::EncodeIndices);
+    CORRADE_VERIFY(data.size() < MeshBlob::serialize(original).size());
+
+    std::optional<MeshBlob> blob = MeshBlob::open(data);
+    CORRADE_VERIFY(blob);
+    CORRADE_COMPARE(blob->indexType(), Mesh::IndexType::UnsignedShort);
+
+    /* The encoder may rotate vertices of a triangle, so compare just sorted
+       triangle rotations */
+    const Trade::MeshData3D meshData = blob->meshData();
+    std::vector<UnsignedInt> decodedIndices = meshData.indices();
+    CORRADE_COMPARE(decodedIndices.size(), indices.size());
+    for(std::vector<UnsignedInt>* list: {&indices, &decodedIndices})
+        for(auto it = list->begin(); it != list->end(); it += 3)
+            std::rotate(it, std::min_element(it, it + 3), it + 3);
+    CORRADE_COMPARE(decodedIndices, indices);
+    CORRADE_COMPARE(meshData.positions(0), positions);
+    CORRADE_COMPARE(meshData.normals(0), normals);
+    CORRADE_COMPARE(meshData.textureCoords2D(0), textureCoords2D);
+}
+
+void MeshBlobTest::meshDataInvalidEncoded() {
+    Containers::Array<char> data = MeshBlob::serialize(texturedTriangles(),
+        MeshBlob::Flag::EncodeVertices|MeshBlob::Flag::EncodeIndices);
+    std::optional<MeshBlob> blob = MeshBlob::open(data);
+    CORRADE_VERIFY(blob);
+
+    /* Corrupt the first byte of both data blocks */
+    data[blob->vertexData().data() - data.data()] = 0;
+    data[blob->indexData().data() - data.data()] = 0;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    const Trade::MeshData3D meshData = blob->meshData();
+    CORRADE_COMPARE(meshData.indices(), (std::vector<UnsignedInt>{0, 0, 0, 0, 0, 0}));
+    CORRADE_COMPARE(meshData.positions(0), (std::vector<Vector3>{{}, {}, {}, {}}));
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::decodeIndices(): invalid header or data too short\n"
+        "MeshTools::decodeVertices(): invalid header\n");
+}
+
+void MeshBlobTest::openTooShort() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const char data[12]{};
+    CORRADE_VERIFY(!MeshBlob::open(data));
+    CORRADE_COMPARE(out.str(), "MeshTools::MeshBlob::open(): data too short, expected at least 64 bytes but got 12\n");
+}
+
+void MeshBlobTest::openInvalidSignature() {
+    Containers::Array<char> data = MeshBlob::serialize(texturedTriangles());
+    data[3] = 'C';
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!MeshBlob::open(data));
+    CORRADE_COMPARE(out.str(), "MeshTools::MeshBlob::open(): invalid file signature\n");
+}
+
+void MeshBlobTest::openInvalidVersion() {
+    Containers::Array<char> data = MeshBlob::serialize(texturedTriangles());
+    patch(data, 1, 2);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!MeshBlob::open(data));
+    CORRADE_COMPARE(out.str(), "MeshTools::MeshBlob::open(): unsupported version 2, expected 1\n");
+}
+
+void MeshBlobTest::openInvalidVertexLayout() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    /* Unknown flag */
+    {
+        Containers::Array<char> data = MeshBlob::serialize(texturedTriangles());
+        patch(data, 3, 19);
+        CORRADE_VERIFY(!MeshBlob::open(data));
+    }
+
+    /* Normals without the flag */
+    {
+        Containers::Array<char> data = MeshBlob::serialize(texturedTriangles());
+        patch(data, 3, 2);
+        CORRADE_VERIFY(!MeshBlob::open(data));
+    }
+
+    /* Stride not matching the attributes */
+    {
+        Containers::Array<char> data = MeshBlob::serialize(texturedTriangles());
+        patch(data, 5, 36);
+        CORRADE_VERIFY(!MeshBlob::open(data));
+    }
+
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::MeshBlob::open(): invalid vertex layout\n"
+        "MeshTools::MeshBlob::open(): invalid vertex layout\n"
+        "MeshTools::MeshBlob::open(): invalid vertex layout\n");
+}
+
+void MeshBlobTest::openInvalidVertexRange() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    /* Vertex count not matching the data size */
+    {
+        Containers::Array<char> data = MeshBlob::serialize(texturedTriangles());
+        patch(data, 4, 5);
+        CORRADE_VERIFY(!MeshBlob::open(data));
+    }
+
+    /* Data out of bounds */
+    {
+        Containers::Array<char> data = MeshBlob::serialize(texturedTriangles());
+        patch(data, 12, 0xffffffffu);
+        CORRADE_VERIFY(!MeshBlob::open(data));
+    }
+
+    /* Truncated file */
+    {
+        Containers::Array<char> data = MeshBlob::serialize(texturedTriangles());
+        CORRADE_VERIFY(!MeshBlob::open(data.prefix(100)));
+    }
+
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::MeshBlob::open(): invalid vertex data range\n"
+        "MeshTools::MeshBlob::open(): invalid vertex data range\n"
+        "MeshTools::MeshBlob::open(): invalid vertex data range\n");
+}
+
+void MeshBlobTest::openInvalidIndexType() {
+    Containers::Array<char> data = MeshBlob::serialize(texturedTriangles());
+    patch(data, 9, 0xdead);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!MeshBlob::open(data));
+    CORRADE_COMPARE(out.str(), "MeshTools::MeshBlob::open(): invalid index type 57005\n");
+}
+
+void MeshBlobTest::openInvalidIndexRange() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    /* Index count not matching the data size */
+    {
+        Containers::Array<char> data = MeshBlob::serialize(texturedTriangles());
+        patch(data, 8, 7);
+        CORRADE_VERIFY(!MeshBlob::open(data));
+    }
+
+    /* Index range end out of vertex bounds */
+    {
+        Containers::Array<char> data = MeshBlob::serialize(texturedTriangles());
+        patch(data, 11, 4);
+        CORRADE_VERIFY(!MeshBlob::open(data));
+    }
+
+    /* Index data out of bounds */
+    {
+        Containers::Array<char> data = MeshBlob::serialize(texturedTriangles());
+        patch(data, 14, 0xfffffffeu);
+        CORRADE_VERIFY(!MeshBlob::open(data));
+    }
+
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::MeshBlob::open(): invalid index data range\n"
+        "MeshTools::MeshBlob::open(): invalid index data range\n"
+        "MeshTools::MeshBlob::open(): invalid index data range\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::MeshBlobTest)
@@ -0,0 +1,318 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/MeshCodec.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct MeshCodecTest: TestSuite::Tester {
+    explicit MeshCodecTest();
+
+    void indices();
+    void indicesGrid();
+    void indicesEmpty();
+    void indicesSmallTypes();
+    void indicesSmallTypesOverflow();
+    void indicesInvalid();
+    void indicesNotTriangles();
+
+    void vertices();
+    void verticesQuantized();
+    void verticesEmpty();
+    void verticesInvalid();
+    void verticesInvalidStride();
+};
+
+MeshCodecTest::MeshCodecTest() {
+    addTests({&MeshCodecTest::indices,
+              &MeshCodecTest::indicesGrid,
+              &MeshCodecTest::indicesEmpty,
+              &MeshCodecTest::indicesSmallTypes,
+              &MeshCodecTest::indicesSmallTypesOverflow,
+              &MeshCodecTest::indicesInvalid,
+              &MeshCodecTest::indicesNotTriangles,
+
+              &MeshCodecTest::vertices,
+              &MeshCodecTest::verticesQuantized,
+              &MeshCodecTest::verticesEmpty,
+              &MeshCodecTest::verticesInvalid,
+              &MeshCodecTest::verticesInvalidStride});
+}
+
+namespace {
+
+/* The encoder may rotate the triangles, rotate each so the smallest index is
+   first to be able to compare */
+template<class T> std::vector<UnsignedInt> normalizeTriangles(const std::vector<T>& indices) {
+    std::vector<UnsignedInt> out{indices.begin(), indices.end()};
+    for(std::size_t i = 0; i + 2 < out.size(); i += 3) {
+        while(out[i] > out[i + 1] || out[i] > out[i + 2]) {
+            const UnsignedInt first = out[i];
+            out[i] = out[i + 1];
+            out[i + 1] = out[i + 2];
+            out[i + 2] = first;
+        }
+    }
+    return out;
+}
+
+/* Quad grid with adjacent triangles sharing edges and vertices ordered by
+   first use, like after tipsify() and optimizeVertexFetch() */
+std::vector<UnsignedInt> grid(const UnsignedInt size) {
+    std::vector<UnsignedInt> indices;
+    for(UnsignedInt y = 0; y != size; ++y) for(UnsignedInt x = 0; x != size; ++x) {
+        const UnsignedInt a = y*(size + 1) + x;
+        const UnsignedInt b = a + 1;
+        const UnsignedInt c = a + size + 1;
+        const UnsignedInt d = c + 1;
+        indices.insert(indices.end(), {c, a, d, d, a, b});
+    }
+
+    std::vector<UnsignedInt> remap((size + 1)*(size + 1), ~UnsignedInt{});
+    UnsignedInt next = 0;
+    for(UnsignedInt& i: indices) {
+        if(remap[i] == ~UnsignedInt{}) remap[i] = next++;
+        i = remap[i];
+    }
+
+    return indices;
+}
+
+}
+
+void MeshCodecTest::indices() {
+    /* New vertices, shared edges, FIFO hits, degenerate triangles and large
+       explicit values in both directions */
+    const std::vector<UnsignedInt> indices{
+        0, 1, 2,
+        2, 1, 3,
+        3, 4, 2,
+        4, 3, 1,
+        100000, 5, 70000,
+        5, 100000, 2,
+        4000000000u, 4000000000u, 0,
+        6, 7, 8,
+        0, 1, 2
+    };
+
+    Containers::Array<char> data = encodeIndices({indices.data(), indices.size()});
+    CORRADE_VERIFY(data.size() < indices.size()*sizeof(UnsignedInt));
+
+    std::vector<UnsignedInt> decoded(indices.size());
+    CORRADE_VERIFY(decodeIndices(data, {decoded.data(), decoded.size()}));
+    CORRADE_COMPARE_AS(normalizeTriangles(decoded), normalizeTriangles(indices),
+        TestSuite::Compare::Container);
+}
+
+void MeshCodecTest::indicesGrid() {
+    const std::vector<UnsignedInt> indices = grid(32);
+
+    Containers::Array<char> data = encodeIndices({indices.data(), indices.size()});
+
+    /* Each triangle except the first in a row shares an edge with the
+       previous one, so most of them need just the code byte and maybe a
+       small delta */
+    CORRADE_VERIFY(data.size() < indices.size()/3*2);
+
+    std::vector<UnsignedInt> decoded(indices.size());
+    CORRADE_VERIFY(decodeIndices(data, {decoded.data(), decoded.size()}));
+    CORRADE_COMPARE_AS(normalizeTriangles(decoded), normalizeTriangles(indices),
+        TestSuite::Compare::Container);
+
+    /* Winding is kept */
+    for(std::size_t i = 0; i != decoded.size(); i += 3) {
+        bool found = false;
+        for(std::size_t r = 0; r != 3 && !found; ++r)
+            found = decoded[i + r] == indices[i] &&
+                    decoded[i + (r + 1) % 3] == indices[i + 1] &&
+                    decoded[i + (r + 2) % 3] == indices[i + 2];
+        CORRADE_VERIFY(found);
+    }
+}
+
+void MeshCodecTest::indicesEmpty() {
+    Containers::Array<char> data = encodeIndices(nullptr);
+    CORRADE_COMPARE(data.size(), 1);
+    CORRADE_VERIFY(decodeIndices(data, Containers::ArrayView<UnsignedInt>{}));
+}
+
+void MeshCodecTest::indicesSmallTypes() {
+    const std::vector<UnsignedInt> indices = grid(8);
+    Containers::Array<char> data = encodeIndices({indices.data(), indices.size()});
+
+    std::vector<UnsignedShort> decodedShort(indices.size());
+    CORRADE_VERIFY(decodeIndices(data, {decodedShort.data(), decodedShort.size()}));
+    CORRADE_COMPARE_AS(normalizeTriangles(decodedShort), normalizeTriangles(indices),
+        TestSuite::Compare::Container);
+
+    std::vector<UnsignedByte> decodedByte(indices.size());
+    CORRADE_VERIFY(decodeIndices(data, {decodedByte.data(), decodedByte.size()}));
+    CORRADE_COMPARE_AS(normalizeTriangles(decodedByte), normalizeTriangles(indices),
+        TestSuite::Compare::Container);
+}
+
+void MeshCodecTest::indicesSmallTypesOverflow() {
+    const std::vector<UnsignedInt> indices{0, 1, 256};
+    Containers::Array<char> data = encodeIndices({indices.data(), indices.size()});
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    UnsignedByte decoded[3];
+    CORRADE_VERIFY(!decodeIndices(data, decoded));
+    CORRADE_COMPARE(out.str(), "MeshTools::decodeIndices(): decoded values don't fit into 8 bits\n");
+}
+
+void MeshCodecTest::indicesInvalid() {
+    const std::vector<UnsignedInt> indices{0, 1, 2, 300, 200, 100};
+    Containers::Array<char> data = encodeIndices({indices.data(), indices.size()});
+    UnsignedInt decoded[6];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!decodeIndices(data, {decoded, 5}));
+    CORRADE_VERIFY(!decodeIndices(data.prefix(2), decoded));
+    CORRADE_VERIFY(!decodeIndices(data.prefix(data.size() - 1), decoded));
+
+    Containers::Array<char> longer{data.size() + 1};
+    std::copy(data.begin(), data.end(), longer.begin());
+    longer[data.size()] = 0;
+    CORRADE_VERIFY(!decodeIndices(longer, decoded));
+
+    data[0] = 'X';
+    CORRADE_VERIFY(!decodeIndices(data, decoded));
+
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::decodeIndices(): index count 5 not divisible by three\n"
+        "MeshTools::decodeIndices(): invalid header or data too short\n"
+        "MeshTools::decodeIndices(): invalid data\n"
+        "MeshTools::decodeIndices(): invalid data\n"
+        "MeshTools::decodeIndices(): invalid header or data too short\n");
+}
+
+void MeshCodecTest::indicesNotTriangles() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const UnsignedInt indices[]{0, 1, 2, 3};
+    encodeIndices(indices);
+    CORRADE_COMPARE(out.str(), "MeshTools::encodeIndices(): index count 4 not divisible by three\n");
+}
+
+void MeshCodecTest::vertices() {
+    /* Various strides, partial groups, partial blocks and more than one
+       block, with both slowly changing and pseudo-random bytes */
+    for(const std::size_t stride: {1, 3, 12, 20, 256}) {
+        for(const std::size_t count: {1, 15, 17, 256, 300, 1000}) {
+            std::vector<char> vertices(stride*count);
+            UnsignedInt seed = 17;
+            for(std::size_t i = 0; i != count; ++i) for(std::size_t k = 0; k != stride; ++k) {
+                seed = seed*1103515245u + 12345u;
+                vertices[i*stride + k] = char(k % 3 == 0 ? i*k/7 : k % 3 == 1 ? (seed >> 16) & 3 : seed >> 24);
+            }
+
+            Containers::Array<char> data = encodeVertices({vertices.data(), vertices.size()}, stride);
+
+            std::vector<char> decoded(vertices.size());
+            CORRADE_VERIFY(decodeVertices(data, {decoded.data(), decoded.size()}, stride));
+            CORRADE_COMPARE_AS(decoded, vertices, TestSuite::Compare::Container);
+        }
+    }
+}
+
+void MeshCodecTest::verticesQuantized() {
+    /* Smooth 16-bit positions padded to eight bytes, like from
+       quantizePositions() */
+    const std::size_t count = 1024;
+    std::vector<Short> vertices(count*4);
+    for(std::size_t i = 0; i != count; ++i) {
+        vertices[i*4 + 0] = Short(i*31 - 16000);
+        vertices[i*4 + 1] = Short((i % 32)*900);
+        vertices[i*4 + 2] = Short(-Int(i)*7);
+        vertices[i*4 + 3] = 0;
+    }
+
+    const Containers::ArrayView<const char> view{reinterpret_cast<const char*>(vertices.data()), vertices.size()*sizeof(Short)};
+    Containers::Array<char> data = encodeVertices(view, 8);
+    CORRADE_VERIFY(data.size() < view.size()/2);
+
+    std::vector<Short> decoded(vertices.size());
+    CORRADE_VERIFY(decodeVertices(data, {reinterpret_cast<char*>(decoded.data()), decoded.size()*sizeof(Short)}, 8));
+    CORRADE_COMPARE_AS(decoded, vertices, TestSuite::Compare::Container);
+}
+
+void MeshCodecTest::verticesEmpty() {
+    Containers::Array<char> data = encodeVertices(nullptr, 12);
+    CORRADE_COMPARE(data.size(), 1);
+    CORRADE_VERIFY(decodeVertices(data, nullptr, 12));
+}
+
+void MeshCodecTest::verticesInvalid() {
+    std::vector<char> vertices(12*40);
+    for(std::size_t i = 0; i != vertices.size(); ++i) vertices[i] = char(i*i);
+    Containers::Array<char> data = encodeVertices({vertices.data(), vertices.size()}, 12);
+    std::vector<char> decoded(vertices.size());
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!decodeVertices(data.prefix(data.size() - 1), {decoded.data(), decoded.size()}, 12));
+    CORRADE_VERIFY(!decodeVertices(data, {decoded.data(), decoded.size() - 12*10}, 12));
+
+    data[0] = 'X';
+    CORRADE_VERIFY(!decodeVertices(data, {decoded.data(), decoded.size()}, 12));
+
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::decodeVertices(): data too short\n"
+        "MeshTools::decodeVertices(): invalid data\n"
+        "MeshTools::decodeVertices(): invalid header\n");
+}
+
+void MeshCodecTest::verticesInvalidStride() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    char vertices[14]{};
+    encodeVertices(vertices, 0);
+    encodeVertices(vertices, 257);
+    encodeVertices(vertices, 4);
+    decodeVertices({}, vertices, 0);
+    decodeVertices({}, vertices, 4);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::encodeVertices(): expected stride between 1 and 256 but got 0\n"
+        "MeshTools::encodeVertices(): expected stride between 1 and 256 but got 257\n"
+        "MeshTools::encodeVertices(): data size 14 not divisible by stride 4\n"
+        "MeshTools::decodeVertices(): expected stride between 1 and 256 but got 0\n"
+        "MeshTools::decodeVertices(): data size 14 not divisible by stride 4\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::MeshCodecTest)
@@ -0,0 +1,204 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/MeshTools/Meshletize.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct MeshletizeTest: TestSuite::Tester {
+    explicit MeshletizeTest();
+
+    void grid();
+    void triangleLimit();
+    void bounds();
+    void backFacing();
+    void closedMesh();
+    void wrongIndexCount();
+    void wrongLimits();
+
+    #ifndef MAGNUM_TARGET_GLES
+    void drawCommands();
+    #endif
+};
+
+MeshletizeTest::MeshletizeTest() {
+    addTests({&MeshletizeTest::grid,
+              &MeshletizeTest::triangleLimit,
+              &MeshletizeTest::bounds,
+              &MeshletizeTest::backFacing,
+              &MeshletizeTest::closedMesh,
+              &MeshletizeTest::wrongIndexCount,
+              &MeshletizeTest::wrongLimits,
+
+              #ifndef MAGNUM_TARGET_GLES
+              &MeshletizeTest::drawCommands
+              #endif
+              });
+}
+
+void MeshletizeTest::grid() {
+    /* 16x16 quads in the XY plane */
+    std::vector<Vector3> positions;
+    for(UnsignedInt y = 0; y <= 16; ++y)
+        for(UnsignedInt x = 0; x <= 16; ++x)
+            positions.emplace_back(Float(x), Float(y), 0.0f);
+    std::vector<UnsignedInt> indices;
+    for(UnsignedInt y = 0; y != 16; ++y) for(UnsignedInt x = 0; x != 16; ++x) {
+        const UnsignedInt i = y*17 + x;
+        indices.insert(indices.end(), {i, i + 1, i + 18, i, i + 18, i + 17});
+    }
+
+    std::vector<Meshlet> meshlets;
+    std::vector<UnsignedInt> vertices, meshletIndices;
+    std::tie(meshlets, vertices, meshletIndices) = MeshTools::meshletize(indices, positions, 32, 40);
+
+    CORRADE_VERIFY(meshlets.size() >= 512/40 + 1);
+    CORRADE_COMPARE(meshletIndices.size(), indices.size());
+
+    /* The meshlets are consecutive, within limits and reference the original
+       triangles in the original order */
+    std::size_t indexOffset = 0, vertexOffset = 0;
+    for(const Meshlet& meshlet: meshlets) {
+        CORRADE_COMPARE(meshlet.indexOffset, indexOffset);
+        CORRADE_COMPARE(meshlet.vertexOffset, vertexOffset);
+        CORRADE_VERIFY(meshlet.vertexCount <= 32);
+        CORRADE_VERIFY(meshlet.indexCount <= 40*3);
+        for(std::size_t i = meshlet.indexOffset; i != meshlet.indexOffset + meshlet.indexCount; ++i) {
+            CORRADE_VERIFY(meshletIndices[i] < meshlet.vertexCount);
+            CORRADE_COMPARE(vertices[meshlet.vertexOffset + meshletIndices[i]], indices[i]);
+        }
+
+        /* All facing +Z */
+        CORRADE_COMPARE(meshlet.coneAxis, Vector3::zAxis());
+        CORRADE_COMPARE(meshlet.coneCutoff, 0.0f);
+
+        indexOffset += meshlet.indexCount;
+        vertexOffset += meshlet.vertexCount;
+    }
+    CORRADE_COMPARE(vertexOffset, vertices.size());
+}
+
+void MeshletizeTest::triangleLimit() {
+    const std::vector<Vector3> positions{{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 0.0f}, {0.0f, 1.0f, 0.0f}};
+
+    std::vector<Meshlet> meshlets;
+    std::vector<UnsignedInt> vertices, meshletIndices;
+    std::tie(meshlets, vertices, meshletIndices) = MeshTools::meshletize({0, 1, 2, 0, 2, 3}, positions, 64, 1);
+
+    /* Shared vertices are duplicated in each meshlet */
+    CORRADE_COMPARE(meshlets.size(), 2);
+    CORRADE_COMPARE(vertices, (std::vector<UnsignedInt>{0, 1, 2, 0, 2, 3}));
+    CORRADE_COMPARE(meshletIndices, (std::vector<UnsignedInt>{0, 1, 2, 0, 1, 2}));
+    CORRADE_COMPARE(meshlets[1].indexOffset, 3);
+    CORRADE_COMPARE(meshlets[1].indexCount, 3);
+    CORRADE_COMPARE(meshlets[1].vertexOffset, 3);
+    CORRADE_COMPARE(meshlets[1].vertexCount, 3);
+}
+
+void MeshletizeTest::bounds() {
+    const std::vector<Vector3> positions{{-1.0f, 0.0f, 2.0f}, {1.0f, 0.0f, 2.0f}, {1.0f, 2.0f, 2.0f}};
+
+    std::vector<Meshlet> meshlets;
+    std::tie(meshlets, std::ignore, std::ignore) = MeshTools::meshletize({0, 1, 2}, positions);
+
+    CORRADE_COMPARE(meshlets.size(), 1);
+    CORRADE_COMPARE(meshlets[0].center, (Vector3{0.0f, 1.0f, 2.0f}));
+    CORRADE_COMPARE(meshlets[0].radius, Constants::sqrt2());
+    CORRADE_COMPARE(meshlets[0].coneAxis, Vector3::zAxis());
+    CORRADE_COMPARE(meshlets[0].coneCutoff, 0.0f);
+}
+
+void MeshletizeTest::backFacing() {
+    const std::vector<Vector3> positions{{-1.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}};
+
+    std::vector<Meshlet> meshlets;
+    std::tie(meshlets, std::ignore, std::ignore) = MeshTools::meshletize({0, 1, 2}, positions);
+
+    CORRADE_VERIFY(!MeshTools::isMeshletBackFacing(meshlets[0], {0.0f, 0.0f, 5.0f}));
+    CORRADE_VERIFY(MeshTools::isMeshletBackFacing(meshlets[0], {0.0f, 0.0f, -5.0f}));
+
+    /* Looking from the side, the bounding sphere intersects the plane */
+    CORRADE_VERIFY(!MeshTools::isMeshletBackFacing(meshlets[0], {5.0f, 0.0f, -0.1f}));
+}
+
+void MeshletizeTest::closedMesh() {
+    /* Tetrahedron, normals span the whole sphere */
+    const std::vector<Vector3> positions{{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}};
+
+    std::vector<Meshlet> meshlets;
+    std::tie(meshlets, std::ignore, std::ignore) = MeshTools::meshletize({0, 2, 1, 0, 1, 3, 0, 3, 2, 1, 2, 3}, positions);
+
+    CORRADE_COMPARE(meshlets.size(), 1);
+    CORRADE_COMPARE(meshlets[0].vertexCount, 4);
+    CORRADE_COMPARE(meshlets[0].coneCutoff, 1.0f);
+    for(const Vector3& camera: {Vector3{5.0f}, Vector3{-5.0f}, Vector3::xAxis(-5.0f)})
+        CORRADE_VERIFY(!MeshTools::isMeshletBackFacing(meshlets[0], camera));
+}
+
+void MeshletizeTest::wrongIndexCount() {
+    std::stringstream ss;
+    Error redirectError{&ss};
+    MeshTools::meshletize({0, 1}, std::vector<Vector3>(2));
+    CORRADE_COMPARE(ss.str(), "MeshTools::meshletize(): index count is not divisible by 3\n");
+}
+
+void MeshletizeTest::wrongLimits() {
+    std::stringstream ss;
+    Error redirectError{&ss};
+    MeshTools::meshletize({0, 1, 2}, std::vector<Vector3>(3), 2, 1);
+    MeshTools::meshletize({0, 1, 2}, std::vector<Vector3>(3), 3, 0);
+    CORRADE_COMPARE(ss.str(),
+        "MeshTools::meshletize(): expected at least 3 vertices and 1 triangle per meshlet but got 2 and 1\n"
+        "MeshTools::meshletize(): expected at least 3 vertices and 1 triangle per meshlet but got 3 and 0\n");
+}
+
+#ifndef MAGNUM_TARGET_GLES
+void MeshletizeTest::drawCommands() {
+    const std::vector<Vector3> positions{{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 0.0f}, {0.0f, 1.0f, 0.0f}};
+
+    std::vector<Meshlet> meshlets;
+    std::tie(meshlets, std::ignore, std::ignore) = MeshTools::meshletize({0, 1, 2, 0, 2, 3}, positions, 64, 1);
+
+    const std::vector<Mesh::DrawElementsIndirectCommand> commands = MeshTools::meshletDrawCommands(meshlets, 12);
+    CORRADE_COMPARE(commands.size(), 2);
+    CORRADE_COMPARE(commands[0].count, 3);
+    CORRADE_COMPARE(commands[0].instanceCount, 1);
+    CORRADE_COMPARE(commands[0].firstIndex, 12);
+    CORRADE_COMPARE(commands[0].baseVertex, 0);
+    CORRADE_COMPARE(commands[0].baseInstance, 0);
+    CORRADE_COMPARE(commands[1].count, 3);
+    CORRADE_COMPARE(commands[1].instanceCount, 1);
+    CORRADE_COMPARE(commands[1].firstIndex, 15);
+    CORRADE_COMPARE(commands[1].baseVertex, 3);
+    CORRADE_COMPARE(commands[1].baseInstance, 1);
+}
+#endif
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::MeshletizeTest)
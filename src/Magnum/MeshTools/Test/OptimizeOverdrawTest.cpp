@@ -0,0 +1,111 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/OptimizeOverdraw.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct OptimizeOverdrawTest: TestSuite::Tester {
+    explicit OptimizeOverdrawTest();
+
+    void optimize();
+    void optimizeThreshold();
+    void optimizeEmpty();
+    void wrongIndexCount();
+};
+
+OptimizeOverdrawTest::OptimizeOverdrawTest() {
+    addTests({&OptimizeOverdrawTest::optimize,
+              &OptimizeOverdrawTest::optimizeThreshold,
+              &OptimizeOverdrawTest::optimizeEmpty,
+              &OptimizeOverdrawTest::wrongIndexCount});
+}
+
+namespace {
+    /* Quad with normal pointing inwards at Z = -1 and a triangle with normal
+       pointing outwards at Z = +1 */
+    const std::vector<Vector3> Positions{
+        {-1.0f, -1.0f, -1.0f},
+        { 1.0f, -1.0f, -1.0f},
+        {-1.0f,  1.0f, -1.0f},
+        { 1.0f,  1.0f, -1.0f},
+
+        {-1.0f, -1.0f,  1.0f},
+        { 1.0f, -1.0f,  1.0f},
+        { 0.0f,  1.0f,  1.0f}
+    };
+
+    const std::vector<UnsignedInt> Indices{
+        0, 1, 2,
+        2, 1, 3,
+
+        4, 5, 6
+    };
+}
+
+void OptimizeOverdrawTest::optimize() {
+    std::vector<UnsignedInt> indices = Indices;
+    MeshTools::optimizeOverdraw(indices, Positions, 3);
+
+    /* The outwards-facing cluster goes first, order of triangles inside
+       clusters is kept */
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{
+        4, 5, 6,
+
+        0, 1, 2,
+        2, 1, 3
+    }));
+}
+
+void OptimizeOverdrawTest::optimizeThreshold() {
+    /* The first cluster has cache miss ratio 2, the whole mesh 7/3, so the
+       split is not allowed with low threshold */
+    std::vector<UnsignedInt> indices = Indices;
+    MeshTools::optimizeOverdraw(indices, Positions, 3, 0.5f);
+    CORRADE_COMPARE(indices, Indices);
+}
+
+void OptimizeOverdrawTest::optimizeEmpty() {
+    std::vector<UnsignedInt> indices;
+    MeshTools::optimizeOverdraw(indices, Positions, 3);
+    CORRADE_VERIFY(indices.empty());
+}
+
+void OptimizeOverdrawTest::wrongIndexCount() {
+    std::vector<UnsignedInt> indices{0, 1};
+
+    std::stringstream ss;
+    Error redirectError{&ss};
+    MeshTools::optimizeOverdraw(indices, Positions, 3);
+    CORRADE_COMPARE(ss.str(), "MeshTools::optimizeOverdraw(): index count is not divisible by 3!\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::OptimizeOverdrawTest)
@@ -0,0 +1,92 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/MeshTools/OptimizeVertexFetch.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct OptimizeVertexFetchTest: TestSuite::Tester {
+    explicit OptimizeVertexFetchTest();
+
+    void optimize();
+    void optimizeOutOfBounds();
+    void optimizeAttributes();
+    void optimizeAttributesWrongSize();
+};
+
+OptimizeVertexFetchTest::OptimizeVertexFetchTest() {
+    addTests({&OptimizeVertexFetchTest::optimize,
+              &OptimizeVertexFetchTest::optimizeOutOfBounds,
+              &OptimizeVertexFetchTest::optimizeAttributes,
+              &OptimizeVertexFetchTest::optimizeAttributesWrongSize});
+}
+
+void OptimizeVertexFetchTest::optimize() {
+    /* Vertex 2 is not referenced */
+    std::vector<UnsignedInt> indices{4, 1, 3, 3, 1, 0};
+    const std::vector<UnsignedInt> remap = MeshTools::optimizeVertexFetch(indices, 5);
+
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{0, 1, 2, 2, 1, 3}));
+    CORRADE_COMPARE(remap, (std::vector<UnsignedInt>{4, 1, 3, 0}));
+}
+
+void OptimizeVertexFetchTest::optimizeOutOfBounds() {
+    std::vector<UnsignedInt> indices{0, 1, 3};
+
+    std::stringstream ss;
+    Error redirectError{&ss};
+    MeshTools::optimizeVertexFetch(indices, 3);
+    CORRADE_COMPARE(ss.str(), "MeshTools::optimizeVertexFetch(): index 3 out of bounds for 3 vertices\n");
+}
+
+void OptimizeVertexFetchTest::optimizeAttributes() {
+    std::vector<UnsignedInt> indices{2, 0, 3};
+    std::vector<Vector2> positions{{0.0f, 0.0f}, {1.0f, 0.0f}, {2.0f, 0.0f}, {3.0f, 0.0f}};
+    std::vector<UnsignedInt> ids{10, 11, 12, 13};
+    MeshTools::optimizeVertexFetch(indices, positions, ids);
+
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{0, 1, 2}));
+    CORRADE_COMPARE(positions, (std::vector<Vector2>{{2.0f, 0.0f}, {0.0f, 0.0f}, {3.0f, 0.0f}}));
+    CORRADE_COMPARE(ids, (std::vector<UnsignedInt>{12, 10, 13}));
+}
+
+void OptimizeVertexFetchTest::optimizeAttributesWrongSize() {
+    std::vector<UnsignedInt> indices{0, 1, 2};
+    std::vector<Vector2> positions(3);
+    std::vector<UnsignedInt> ids(2);
+
+    std::stringstream ss;
+    Error redirectError{&ss};
+    MeshTools::optimizeVertexFetch(indices, positions, ids);
+    CORRADE_COMPARE(ss.str(), "MeshTools::optimizeVertexFetch(): expected arrays of size 3 but got 2\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::OptimizeVertexFetchTest)
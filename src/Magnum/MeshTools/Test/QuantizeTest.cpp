@@ -0,0 +1,169 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Angle.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Packing.h"
+#include "Magnum/MeshTools/Quantize.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct QuantizeTest: TestSuite::Tester {
+    explicit QuantizeTest();
+
+    void positions3D();
+    void positions2D();
+    void positionsDegenerate();
+    void positionsEmpty();
+    void normalsOctahedral();
+    void normalsOctahedralPrecision();
+    void normalsPacked();
+    void textureCoordinates();
+};
+
+QuantizeTest::QuantizeTest() {
+    addTests({&QuantizeTest::positions3D,
+              &QuantizeTest::positions2D,
+              &QuantizeTest::positionsDegenerate,
+              &QuantizeTest::positionsEmpty,
+              &QuantizeTest::normalsOctahedral,
+              &QuantizeTest::normalsOctahedralPrecision,
+              &QuantizeTest::normalsPacked,
+              &QuantizeTest::textureCoordinates});
+}
+
+void QuantizeTest::positions3D() {
+    const std::vector<Vector3> positions{
+        {-1.0f, 2.0f, 10.0f},
+        {3.0f, 4.0f, 14.0f},
+        {1.0f, 2.5f, 12.5f},
+        {0.3f, 3.3f, 11.1f}};
+
+    std::vector<Math::Vector3<Short>> quantized;
+    Matrix4 dequantization;
+    std::tie(quantized, dequantization) = quantizePositions(positions);
+    CORRADE_COMPARE(quantized.size(), 4);
+
+    /* Bounding box corners map to the extremes */
+    CORRADE_COMPARE(quantized[0], (Math::Vector3<Short>{-32767, -32767, -32767}));
+    CORRADE_COMPARE(quantized[1], (Math::Vector3<Short>{32767, 32767, 32767}));
+    CORRADE_COMPARE(quantized[2], (Math::Vector3<Short>{0, -16384, 8192}));
+    CORRADE_COMPARE(dequantization, Matrix4::translation({1.0f, 3.0f, 12.0f})*Matrix4::scaling({2.0f, 1.0f, 2.0f}));
+
+    /* Roundtrip is within half of the quantization step */
+    for(std::size_t i = 0; i != positions.size(); ++i) {
+        const Vector3 dequantized = dequantization.transformPoint(Math::unpack<Vector3>(quantized[i]));
+        CORRADE_VERIFY((Math::abs(dequantized - positions[i]) <= Vector3{4.0f/65534.0f}).all());
+    }
+}
+
+void QuantizeTest::positions2D() {
+    const std::vector<Vector2> positions{{-3.0f, 1.0f}, {5.0f, 2.0f}};
+
+    std::vector<Math::Vector2<Short>> quantized;
+    Matrix3 dequantization;
+    std::tie(quantized, dequantization) = quantizePositions(positions);
+    CORRADE_COMPARE(quantized, (std::vector<Math::Vector2<Short>>{{-32767, -32767}, {32767, 32767}}));
+    CORRADE_COMPARE(dequantization, Matrix3::translation({1.0f, 1.5f})*Matrix3::scaling({4.0f, 0.5f}));
+}
+
+void QuantizeTest::positionsDegenerate() {
+    /* Flat mesh shouldn't cause division by zero */
+    const std::vector<Vector3> positions{{0.0f, 5.0f, -1.0f}, {2.0f, 5.0f, 1.0f}};
+
+    std::vector<Math::Vector3<Short>> quantized;
+    Matrix4 dequantization;
+    std::tie(quantized, dequantization) = quantizePositions(positions);
+    CORRADE_COMPARE(quantized, (std::vector<Math::Vector3<Short>>{{-32767, 0, -32767}, {32767, 0, 32767}}));
+    CORRADE_COMPARE(dequantization.transformPoint({}), (Vector3{1.0f, 5.0f, 0.0f}));
+}
+
+void QuantizeTest::positionsEmpty() {
+    std::vector<Math::Vector3<Short>> quantized;
+    Matrix4 dequantization;
+    std::tie(quantized, dequantization) = quantizePositions(std::vector<Vector3>{});
+    CORRADE_VERIFY(quantized.empty());
+    CORRADE_COMPARE(dequantization, Matrix4{});
+}
+
+void QuantizeTest::normalsOctahedral() {
+    const std::vector<Math::Vector2<Short>> quantized = quantizeNormalsOctahedral({
+        Vector3::zAxis(), -Vector3::zAxis(), Vector3::xAxis(), -Vector3::yAxis()});
+
+    CORRADE_COMPARE(quantized[0], (Math::Vector2<Short>{0, 0}));
+    CORRADE_COMPARE(quantized[2], (Math::Vector2<Short>{32767, 0}));
+    CORRADE_COMPARE(quantized[3], (Math::Vector2<Short>{0, -32767}));
+
+    /* The lower hemisphere is folded to the corners */
+    CORRADE_COMPARE(dequantizeNormalOctahedral(quantized[1]), -Vector3::zAxis());
+    CORRADE_COMPARE(Math::abs(Vector2{quantized[1]}), Vector2{32767.0f});
+}
+
+void QuantizeTest::normalsOctahedralPrecision() {
+    /* Spiral over the whole sphere */
+    std::vector<Vector3> normals;
+    for(Int i = 0; i != 1000; ++i) {
+        const Float z = 1.0f - 2.0f*(i + 0.5f)/1000.0f;
+        const Float r = std::sqrt(1.0f - z*z);
+        const Float angle = i*2.39996f;
+        normals.emplace_back(r*std::cos(angle), r*std::sin(angle), z);
+    }
+
+    const std::vector<Math::Vector2<Short>> quantized = quantizeNormalsOctahedral(normals);
+    Float maxAngle = 0.0f;
+    for(std::size_t i = 0; i != normals.size(); ++i) {
+        const Vector3 decoded = dequantizeNormalOctahedral(quantized[i]);
+        CORRADE_COMPARE(decoded.dot(), 1.0f);
+        /* Math::angle() is too imprecise for such small angles */
+        maxAngle = Math::max(maxAngle, Float(Deg(Rad(std::asin(Math::cross(decoded, normals[i].normalized()).length())))));
+    }
+
+    CORRADE_VERIFY(maxAngle < 0.01f);
+}
+
+void QuantizeTest::normalsPacked() {
+    const std::vector<UnsignedInt> quantized = quantizeNormalsPacked({
+        Vector3::xAxis(), -Vector3::yAxis(), Vector3{0.0f, 0.6f, -0.8f}});
+
+    CORRADE_COMPARE(quantized.size(), 3);
+    CORRADE_COMPARE(quantized[0], 511u);
+    CORRADE_COMPARE(quantized[1], (UnsignedInt(-511) & 0x3ff) << 10);
+    /* 0.6*511 = 306.6, -0.8*511 = -408.8 */
+    CORRADE_COMPARE(quantized[2], (307u << 10)|((UnsignedInt(-409) & 0x3ff) << 20));
+}
+
+void QuantizeTest::textureCoordinates() {
+    const std::vector<Math::Vector2<UnsignedShort>> quantized = quantizeTextureCoordinates({
+        {0.0f, 1.0f}, {0.5f, 0.25f}, {-0.5f, 1.5f}});
+
+    CORRADE_COMPARE(quantized, (std::vector<Math::Vector2<UnsignedShort>>{
+        {0, 65535}, {32768, 16384}, {0, 65535}}));
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::QuantizeTest)
@@ -23,9 +23,10 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <sstream>
 #include <Corrade/TestSuite/Tester.h>
 
-#include "Magnum/Math/Vector2.h"
+#include "Magnum/Math/Vector3.h"
 #include "Magnum/MeshTools/RemoveDuplicates.h"
 
 namespace Magnum { namespace MeshTools { namespace Test {
@@ -34,10 +35,22 @@ struct RemoveDuplicatesTest: TestSuite::Tester {
     explicit RemoveDuplicatesTest();
 
     void removeDuplicates();
+    void removeDuplicatesEmpty();
+    void removeDuplicatesFloat();
+    void removeDuplicatesExact();
+    void removeDuplicatesExactInteger();
+    void removeDuplicatesMultiple();
+    void removeDuplicatesMultipleWrongSize();
 };
 
 RemoveDuplicatesTest::RemoveDuplicatesTest() {
-    addTests({&RemoveDuplicatesTest::removeDuplicates});
+    addTests({&RemoveDuplicatesTest::removeDuplicates,
+              &RemoveDuplicatesTest::removeDuplicatesEmpty,
+              &RemoveDuplicatesTest::removeDuplicatesFloat,
+              &RemoveDuplicatesTest::removeDuplicatesExact,
+              &RemoveDuplicatesTest::removeDuplicatesExactInteger,
+              &RemoveDuplicatesTest::removeDuplicatesMultiple,
+              &RemoveDuplicatesTest::removeDuplicatesMultipleWrongSize});
 }
 
 void RemoveDuplicatesTest::removeDuplicates() {
@@ -59,6 +72,124 @@ void RemoveDuplicatesTest::removeDuplicates() {
     }));
 }
 
+void RemoveDuplicatesTest::removeDuplicatesEmpty() {
+    std::vector<Vector2> data;
+    CORRADE_VERIFY(MeshTools::removeDuplicates(data).empty());
+    CORRADE_VERIFY(data.empty());
+}
+
+void RemoveDuplicatesTest::removeDuplicatesFloat() {
+    std::vector<Vector2> data{
+        {1.0f, 0.0f},
+        {1.05f, 0.02f},
+        {-3.0f, 2.0f},
+        {1.0f, 0.0f},
+        {-2.98f, 2.01f}
+    };
+
+    const std::vector<UnsignedInt> indices = MeshTools::removeDuplicates(data, 0.1f);
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{0, 0, 1, 0, 1}));
+    CORRADE_COMPARE(data, (std::vector<Vector2>{
+        {1.0f, 0.0f},
+        {-3.0f, 2.0f}
+    }));
+}
+
+void RemoveDuplicatesTest::removeDuplicatesExact() {
+    /* Zero epsilon compares the values exactly */
+    std::vector<Vector2> data{
+        {1.0f, 0.0f},
+        {1.0f, 0.0001f},
+        {-3.0f, 2.0f},
+        {1.0f, 0.0f},
+        {1.0f, 0.0001f}
+    };
+
+    const std::vector<UnsignedInt> indices = MeshTools::removeDuplicates(data, 0.0f);
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{0, 1, 2, 0, 1}));
+    CORRADE_COMPARE(data, (std::vector<Vector2>{
+        {1.0f, 0.0f},
+        {1.0f, 0.0001f},
+        {-3.0f, 2.0f}
+    }));
+}
+
+void RemoveDuplicatesTest::removeDuplicatesExactInteger() {
+    /* Default epsilon for integers is 1, which is an exact comparison */
+    std::vector<Vector2i> data{
+        {1, 0},
+        {2, 1},
+        {1, 0},
+        {1, 1},
+        {2, 1}
+    };
+
+    const std::vector<UnsignedInt> indices = MeshTools::removeDuplicates(data);
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{0, 1, 0, 2, 1}));
+    CORRADE_COMPARE(data, (std::vector<Vector2i>{
+        {1, 0},
+        {2, 1},
+        {1, 1}
+    }));
+}
+
+void RemoveDuplicatesTest::removeDuplicatesMultiple() {
+    /* Vertices 0 and 2 have the same position but different normal, vertices
+       0 and 3 are the same */
+    std::vector<Vector3> positions{
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f}
+    };
+    std::vector<Vector3> normals{
+        {0.0f, 0.0f, 1.0f},
+        {0.0f, 0.0f, 1.0f},
+        {0.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f},
+        {0.0f, 0.0f, 1.0f}
+    };
+    std::vector<Vector2> textureCoordinates{
+        {0.0f, 0.0f},
+        {1.0f, 0.0f},
+        {0.0f, 0.0f},
+        {0.0f, 0.0f},
+        {0.5f, 0.0f}
+    };
+
+    const std::vector<UnsignedInt> indices = MeshTools::removeDuplicates(positions, normals, textureCoordinates);
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{0, 1, 2, 0, 3}));
+    CORRADE_COMPARE(positions, (std::vector<Vector3>{
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f}
+    }));
+    CORRADE_COMPARE(normals, (std::vector<Vector3>{
+        {0.0f, 0.0f, 1.0f},
+        {0.0f, 0.0f, 1.0f},
+        {0.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f}
+    }));
+    CORRADE_COMPARE(textureCoordinates, (std::vector<Vector2>{
+        {0.0f, 0.0f},
+        {1.0f, 0.0f},
+        {0.0f, 0.0f},
+        {0.5f, 0.0f}
+    }));
+}
+
+void RemoveDuplicatesTest::removeDuplicatesMultipleWrongSize() {
+    std::vector<Vector3> positions(3);
+    std::vector<Vector2> textureCoordinates(2);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::removeDuplicates(positions, textureCoordinates);
+    CORRADE_COMPARE(out.str(), "MeshTools::removeDuplicates(): expected arrays of size 3 but got 2\n");
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::RemoveDuplicatesTest)
@@ -0,0 +1,278 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/MeshTools/Simplify.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct SimplifyTest: TestSuite::Tester {
+    explicit SimplifyTest();
+
+    void planarGrid();
+    void targetReached();
+    void targetAboveCount();
+    void wrongIndexCount();
+    void targetError();
+    void lockBorder();
+    void textureCoordinates();
+    void textureCoordinatesWrongSize();
+
+    void attributes();
+    void attributesWrongSize();
+
+    void meshData();
+    void meshDataNotTriangles();
+
+    void benchmark();
+};
+
+SimplifyTest::SimplifyTest() {
+    addTests({&SimplifyTest::planarGrid,
+              &SimplifyTest::targetReached,
+              &SimplifyTest::targetAboveCount,
+              &SimplifyTest::wrongIndexCount,
+              &SimplifyTest::targetError,
+              &SimplifyTest::lockBorder,
+              &SimplifyTest::textureCoordinates,
+              &SimplifyTest::textureCoordinatesWrongSize,
+
+              &SimplifyTest::attributes,
+              &SimplifyTest::attributesWrongSize,
+
+              &SimplifyTest::meshData,
+              &SimplifyTest::meshDataNotTriangles});
+
+    addBenchmarks({&SimplifyTest::benchmark}, 5);
+}
+
+namespace {
+    /* Square grid of size x size quads in the XY plane spanning [0, size] */
+    void grid(const UnsignedInt size, std::vector<UnsignedInt>& indices, std::vector<Vector3>& positions) {
+        for(UnsignedInt y = 0; y <= size; ++y)
+            for(UnsignedInt x = 0; x <= size; ++x)
+                positions.emplace_back(Float(x), Float(y), 0.0f);
+
+        for(UnsignedInt y = 0; y != size; ++y) for(UnsignedInt x = 0; x != size; ++x) {
+            const UnsignedInt i = y*(size + 1) + x;
+            indices.insert(indices.end(), {i, i + 1, i + size + 2, i, i + size + 2, i + size + 1});
+        }
+    }
+}
+
+void SimplifyTest::planarGrid() {
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    grid(4, indices, positions);
+
+    /* All interior and straight boundary vertices can be removed without any
+       error, only the corners stay */
+    const std::vector<UnsignedInt> remap = MeshTools::simplify(indices, positions, 6);
+    CORRADE_COMPARE(indices.size(), 6);
+    CORRADE_COMPARE(remap.size(), 4);
+
+    std::vector<UnsignedInt> sorted = remap;
+    std::sort(sorted.begin(), sorted.end());
+    CORRADE_COMPARE(sorted, (std::vector<UnsignedInt>{0, 4, 20, 24}));
+}
+
+void SimplifyTest::targetReached() {
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    grid(4, indices, positions);
+
+    MeshTools::simplify(indices, positions, 48);
+    CORRADE_VERIFY(indices.size() <= 48);
+    CORRADE_VERIFY(indices.size() > 6);
+    CORRADE_COMPARE(indices.size()%3, 0);
+}
+
+void SimplifyTest::targetAboveCount() {
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    grid(2, indices, positions);
+    const std::vector<UnsignedInt> original = indices;
+
+    const std::vector<UnsignedInt> remap = MeshTools::simplify(indices, positions, 100);
+    CORRADE_COMPARE(indices.size(), original.size());
+    CORRADE_COMPARE(remap.size(), 9);
+}
+
+void SimplifyTest::wrongIndexCount() {
+    std::vector<UnsignedInt> indices{0, 1};
+
+    std::stringstream ss;
+    Error redirectError{&ss};
+    MeshTools::simplify(indices, std::vector<Vector3>(2), 0);
+    CORRADE_COMPARE(ss.str(), "MeshTools::simplify(): index count is not divisible by 3\n");
+}
+
+void SimplifyTest::targetError() {
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    grid(4, indices, positions);
+    positions[12].z() = 1.0f;
+    const std::vector<UnsignedInt> original = indices;
+    const std::vector<Vector3> originalPositions = positions;
+
+    /* The raised center vertex can't be removed without an error, the flat
+       parts can */
+    std::vector<UnsignedInt> remap = MeshTools::simplify(indices, positions, 0, 1.0e-4f);
+    CORRADE_VERIFY(indices.size() > 6);
+    CORRADE_VERIFY(indices.size() < original.size());
+    CORRADE_VERIFY(std::find(remap.begin(), remap.end(), 12) != remap.end());
+
+    /* Without the error limit it is removed */
+    indices = original;
+    remap = MeshTools::simplify(indices, originalPositions, 6);
+    CORRADE_COMPARE(indices.size(), 6);
+    CORRADE_VERIFY(std::find(remap.begin(), remap.end(), 12) == remap.end());
+}
+
+void SimplifyTest::lockBorder() {
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    grid(4, indices, positions);
+
+    /* Only the nine interior vertices can be removed */
+    const std::vector<UnsignedInt> remap = MeshTools::simplify(indices, positions, 0, Constants::inf(), SimplifyFlag::LockBorder);
+    CORRADE_COMPARE(remap.size(), 16);
+    for(const UnsignedInt i: remap) {
+        const Vector3& position = positions[i];
+        CORRADE_VERIFY(position.x() == 0.0f || position.x() == 4.0f || position.y() == 0.0f || position.y() == 4.0f);
+    }
+}
+
+void SimplifyTest::textureCoordinates() {
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    grid(2, indices, positions);
+    std::vector<Vector2> textureCoordinates;
+    for(const Vector3& position: positions) textureCoordinates.push_back(position.xy()/2.0f);
+    const std::vector<UnsignedInt> original = indices;
+
+    /* Each collapse would distort the texture coordinates */
+    MeshTools::simplify(indices, positions, {}, 0.0f, textureCoordinates, 1.0f, 0, 0.01f);
+    CORRADE_COMPARE(indices.size(), original.size());
+
+    /* With zero weight they are ignored */
+    indices = original;
+    MeshTools::simplify(indices, positions, {}, 0.0f, textureCoordinates, 0.0f, 0, 0.01f);
+    CORRADE_COMPARE(indices.size(), 6);
+}
+
+void SimplifyTest::textureCoordinatesWrongSize() {
+    std::vector<UnsignedInt> indices{0, 1, 2};
+
+    std::stringstream ss;
+    Error redirectError{&ss};
+    MeshTools::simplify(indices, std::vector<Vector3>(3), {}, 0.0f, std::vector<Vector2>(2), 1.0f, 0);
+    CORRADE_COMPARE(ss.str(), "MeshTools::simplify(): expected 3 texture coordinates but got 2\n");
+}
+
+void SimplifyTest::attributes() {
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    grid(2, indices, positions);
+    std::vector<UnsignedInt> ids(positions.size());
+    for(std::size_t i = 0; i != ids.size(); ++i) ids[i] = i;
+
+    MeshTools::simplify(indices, 6, positions, ids);
+    CORRADE_COMPARE(indices.size(), 6);
+    CORRADE_COMPARE(positions.size(), 4);
+    CORRADE_COMPARE(ids.size(), 4);
+    for(std::size_t i = 0; i != ids.size(); ++i)
+        CORRADE_COMPARE(positions[i], (Vector3{Float(ids[i]%3), Float(ids[i]/3), 0.0f}));
+}
+
+void SimplifyTest::attributesWrongSize() {
+    std::vector<UnsignedInt> indices{0, 1, 2};
+    std::vector<Vector3> positions(3);
+    std::vector<UnsignedInt> ids(2);
+
+    std::stringstream ss;
+    Error redirectError{&ss};
+    MeshTools::simplify(indices, 0, positions, ids);
+    CORRADE_COMPARE(ss.str(), "MeshTools::simplify(): expected arrays of size 3 but got 2\n");
+}
+
+void SimplifyTest::meshData() {
+    std::vector<UnsignedInt> indices;
+    std::vector<Vector3> positions;
+    grid(2, indices, positions);
+    std::vector<Vector2> textureCoords;
+    for(const Vector3& position: positions) textureCoords.push_back(position.xy()/2.0f);
+
+    const Trade::MeshData3D data{MeshPrimitive::Triangles, indices, {positions}, {std::vector<Vector3>(positions.size(), Vector3::zAxis())}, {textureCoords}, {}, nullptr};
+    const Trade::MeshData3D simplified = MeshTools::simplify(data, 6);
+
+    CORRADE_COMPARE(simplified.primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(simplified.indices().size(), 6);
+    CORRADE_COMPARE(simplified.positionArrayCount(), 1);
+    CORRADE_COMPARE(simplified.normalArrayCount(), 1);
+    CORRADE_COMPARE(simplified.textureCoords2DArrayCount(), 1);
+    CORRADE_COMPARE(simplified.colorArrayCount(), 0);
+    CORRADE_COMPARE(simplified.positions(0).size(), 4);
+    CORRADE_COMPARE(simplified.normals(0), std::vector<Vector3>(4, Vector3::zAxis()));
+    for(std::size_t i = 0; i != 4; ++i)
+        CORRADE_COMPARE(simplified.textureCoords2D(0)[i], simplified.positions(0)[i].xy()/2.0f);
+}
+
+void SimplifyTest::meshDataNotTriangles() {
+    const Trade::MeshData3D data{MeshPrimitive::Lines, {0, 1}, {{{}, {}}}, {}, {}, {}, nullptr};
+
+    std::stringstream ss;
+    Error redirectError{&ss};
+    MeshTools::simplify(data, 0);
+    CORRADE_COMPARE(ss.str(), "MeshTools::simplify(): expected indexed triangle mesh\n");
+}
+
+void SimplifyTest::benchmark() {
+    /* Wavy 128x128 quad height field */
+    std::vector<UnsignedInt> original;
+    std::vector<Vector3> positions;
+    grid(128, original, positions);
+    for(Vector3& position: positions)
+        position.z() = Math::sin(Rad(position.x()*0.1f))*Math::cos(Rad(position.y()*0.1f))*4.0f;
+
+    std::vector<UnsignedInt> indices;
+    CORRADE_BENCHMARK(1) {
+        indices = original;
+        MeshTools::simplify(indices, positions, original.size()/10);
+    }
+
+    CORRADE_VERIFY(indices.size() <= original.size()/10);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::SimplifyTest)
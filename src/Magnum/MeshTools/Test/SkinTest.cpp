@@ -0,0 +1,266 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/MeshTools/Skin.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct SkinTest: TestSuite::Tester {
+    explicit SkinTest();
+
+    void linear();
+    void dualQuaternion();
+    void dualQuaternionAntipodal();
+    void noNormals();
+    void interleaved();
+    void parallel();
+
+    void wrongSize();
+    void interleavedWrongSize();
+
+    void debugMethod();
+};
+
+SkinTest::SkinTest() {
+    addTests({&SkinTest::linear,
+              &SkinTest::dualQuaternion,
+              &SkinTest::dualQuaternionAntipodal,
+              &SkinTest::noNormals,
+              &SkinTest::interleaved,
+              &SkinTest::parallel,
+
+              &SkinTest::wrongSize,
+              &SkinTest::interleavedWrongSize,
+
+              &SkinTest::debugMethod});
+}
+
+namespace {
+
+const Matrix4 JointMatrices[]{
+    Matrix4{},
+    Matrix4::translation({2.0f, 0.0f, 0.0f}),
+    Matrix4::rotationZ(Deg(90.0f)),
+    Matrix4::translation({0.0f, 0.0f, 4.0f})*Matrix4::rotationZ(Deg(90.0f))
+};
+
+const Vector4ui JointIds[]{
+    {0, 0, 0, 0},
+    {1, 0, 0, 0},
+    {0, 1, 0, 0},
+    {3, 0, 0, 0},
+    {0, 2, 0, 0},
+    {0, 1, 2, 3}
+};
+
+const Vector4 JointWeights[]{
+    {1.0f, 0.0f, 0.0f, 0.0f},
+    {1.0f, 0.0f, 0.0f, 0.0f},
+    {0.5f, 0.5f, 0.0f, 0.0f},
+    {1.0f, 0.0f, 0.0f, 0.0f},
+    {0.5f, 0.5f, 0.0f, 0.0f},
+    {0.25f, 0.25f, 0.25f, 0.25f}
+};
+
+const Vector3 Positions[]{
+    {1.0f, 0.0f, 0.0f},
+    {1.0f, 0.0f, 0.0f},
+    {1.0f, 0.0f, 0.0f},
+    {1.0f, 0.0f, 0.0f},
+    {1.0f, 0.0f, 0.0f},
+    {1.0f, 0.0f, 0.0f}
+};
+
+const Vector3 Normals[]{
+    {0.0f, 1.0f, 0.0f},
+    {0.0f, 1.0f, 0.0f},
+    {0.0f, 1.0f, 0.0f},
+    {0.0f, 1.0f, 0.0f},
+    {0.0f, 1.0f, 0.0f},
+    {0.0f, 1.0f, 0.0f}
+};
+
+}
+
+void SkinTest::linear() {
+    Vector3 positions[6];
+    Vector3 normals[6];
+    MeshTools::skinInto(SkinningMethod::Linear, JointMatrices, JointIds, JointWeights, Positions, Normals, positions, normals);
+
+    const Float s = Constants::sqrt2()/2.0f;
+    CORRADE_COMPARE_AS(Containers::ArrayView<const Vector3>{positions}, (Containers::ArrayView<const Vector3>{std::vector<Vector3>{
+        {1.0f, 0.0f, 0.0f},
+        {3.0f, 0.0f, 0.0f},
+        {2.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 4.0f},
+        /* Linear blending shrinks the mesh */
+        {0.5f, 0.5f, 0.0f},
+        {1.0f, 0.5f, 1.0f}}.data(), 6}), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::ArrayView<const Vector3>{normals}, (Containers::ArrayView<const Vector3>{std::vector<Vector3>{
+        {0.0f, 1.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {-1.0f, 0.0f, 0.0f},
+        /* ... but the normals are normalized */
+        {-s, s, 0.0f},
+        {-s, s, 0.0f}}.data(), 6}), TestSuite::Compare::Container);
+}
+
+void SkinTest::dualQuaternion() {
+    Vector3 positions[6];
+    Vector3 normals[6];
+    MeshTools::skinInto(SkinningMethod::DualQuaternion, JointMatrices, JointIds, JointWeights, Positions, Normals, positions, normals);
+
+    /* Same as linear for single joints and pure translations, the rotations
+       are interpolated */
+    const Float s = Constants::sqrt2()/2.0f;
+    CORRADE_COMPARE(positions[0], (Vector3{1.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(positions[1], (Vector3{3.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(positions[2], (Vector3{2.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(positions[3], (Vector3{0.0f, 1.0f, 4.0f}));
+    CORRADE_COMPARE(positions[4], (Vector3{s, s, 0.0f}));
+    CORRADE_COMPARE(normals[0], (Vector3{0.0f, 1.0f, 0.0f}));
+    CORRADE_COMPARE(normals[3], (Vector3{-1.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(normals[4], (Vector3{-s, s, 0.0f}));
+}
+
+void SkinTest::dualQuaternionAntipodal() {
+    /* 350° rotation has the quaternion in the other hemisphere than
+       identity, blending with it should go the short way */
+    const Matrix4 jointMatrices[]{
+        Matrix4{},
+        Matrix4::rotationZ(Deg(350.0f))
+    };
+    const Vector4ui jointIds[]{{0, 1, 0, 0}};
+    const Vector4 jointWeights[]{{0.5f, 0.5f, 0.0f, 0.0f}};
+    const Vector3 input[]{{1.0f, 0.0f, 0.0f}};
+
+    Vector3 positions[1];
+    MeshTools::skinInto(SkinningMethod::DualQuaternion, jointMatrices, jointIds, jointWeights, input, nullptr, positions, nullptr);
+    CORRADE_COMPARE(positions[0], Quaternion::rotation(Deg(-5.0f), Vector3::zAxis()).transformVector(input[0]));
+}
+
+void SkinTest::noNormals() {
+    Vector3 positions[6];
+    MeshTools::skinInto(SkinningMethod::Linear, JointMatrices, JointIds, JointWeights, Positions, nullptr, positions, nullptr);
+    CORRADE_COMPARE(positions[1], (Vector3{3.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(positions[3], (Vector3{0.0f, 1.0f, 4.0f}));
+}
+
+void SkinTest::interleaved() {
+    struct Vertex {
+        Vector3 position;
+        Vector3 normal;
+        Float other;
+    };
+
+    Vertex out[6];
+    for(Vertex& vertex: out) vertex.other = 1337.0f;
+
+    MeshTools::skinInterleavedInto(SkinningMethod::Linear, JointMatrices, JointIds, JointWeights, Positions, Normals, {reinterpret_cast<char*>(out), sizeof(out)}, sizeof(Vertex));
+
+    Vector3 positions[6];
+    Vector3 normals[6];
+    MeshTools::skinInto(SkinningMethod::Linear, JointMatrices, JointIds, JointWeights, Positions, Normals, positions, normals);
+
+    for(std::size_t i = 0; i != 6; ++i) {
+        CORRADE_COMPARE(out[i].position, positions[i]);
+        CORRADE_COMPARE(out[i].normal, normals[i]);
+        CORRADE_COMPARE(out[i].other, 1337.0f);
+    }
+}
+
+void SkinTest::parallel() {
+    /* Large enough to be split into more threads */
+    const std::size_t count = 100000;
+    std::vector<Vector4ui> jointIds(count);
+    std::vector<Vector4> jointWeights(count);
+    std::vector<Vector3> positions(count);
+    std::vector<Vector3> normals(count);
+    for(std::size_t i = 0; i != count; ++i) {
+        jointIds[i] = JointIds[i%6];
+        jointWeights[i] = JointWeights[i%6];
+        positions[i] = {Float(i%7), Float(i%11), Float(i%13)};
+        normals[i] = Normals[i%6];
+    }
+
+    for(SkinningMethod method: {SkinningMethod::Linear, SkinningMethod::DualQuaternion}) {
+        std::vector<Vector3> serialPositions(count), serialNormals(count);
+        std::vector<Vector3> parallelPositions(count), parallelNormals(count);
+        MeshTools::skinInto(method, JointMatrices, {jointIds.data(), count}, {jointWeights.data(), count}, {positions.data(), count}, {normals.data(), count}, {serialPositions.data(), count}, {serialNormals.data(), count}, 1);
+        MeshTools::skinInto(method, JointMatrices, {jointIds.data(), count}, {jointWeights.data(), count}, {positions.data(), count}, {normals.data(), count}, {parallelPositions.data(), count}, {parallelNormals.data(), count}, 4);
+        CORRADE_VERIFY(serialPositions == parallelPositions);
+        CORRADE_VERIFY(serialNormals == parallelNormals);
+    }
+}
+
+void SkinTest::wrongSize() {
+    Vector3 positions[5];
+    Vector3 normals[5];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::skinInto(SkinningMethod::Linear, JointMatrices, JointIds, JointWeights, Positions, Normals, positions, normals);
+    MeshTools::skinInto(SkinningMethod::Linear, JointMatrices, JointIds, JointWeights, Containers::ArrayView<const Vector3>{Positions, 5}, Normals, positions, normals);
+    MeshTools::skinInto(SkinningMethod::Linear, JointMatrices, {JointIds, 5}, {JointWeights, 5}, {Positions, 5}, Normals, positions, nullptr);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::skinInto(): expected 6 joint IDs, joint weights and output positions but got 6, 6 and 5\n"
+        "MeshTools::skinInto(): expected 5 joint IDs, joint weights and output positions but got 6, 6 and 5\n"
+        "MeshTools::skinInto(): expected either no normals or 5 normals and output normals but got 6 and 0\n");
+}
+
+void SkinTest::interleavedWrongSize() {
+    char data[6*24 - 1];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::skinInterleavedInto(SkinningMethod::Linear, JointMatrices, {JointIds, 5}, JointWeights, Positions, Normals, data, 24);
+    MeshTools::skinInterleavedInto(SkinningMethod::Linear, JointMatrices, JointIds, JointWeights, Positions, {Normals, 5}, data, 24);
+    MeshTools::skinInterleavedInto(SkinningMethod::Linear, JointMatrices, JointIds, JointWeights, Positions, Normals, data, 20);
+    MeshTools::skinInterleavedInto(SkinningMethod::Linear, JointMatrices, JointIds, JointWeights, Positions, Normals, data, 24);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::skinInterleavedInto(): expected 6 joint IDs and joint weights but got 5 and 6\n"
+        "MeshTools::skinInterleavedInto(): expected either no normals or 6 but got 5\n"
+        "MeshTools::skinInterleavedInto(): stride 20 is too small for 24 bytes of vertex data\n"
+        "MeshTools::skinInterleavedInto(): expected at least 144 bytes of output but got 143\n");
+}
+
+void SkinTest::debugMethod() {
+    std::ostringstream out;
+
+    Debug(&out) << SkinningMethod::DualQuaternion << SkinningMethod(0xde);
+    CORRADE_COMPARE(out.str(), "MeshTools::SkinningMethod::DualQuaternion MeshTools::SkinningMethod(0xde)\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::SkinTest)
@@ -0,0 +1,260 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/StaticBatch.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct StaticBatchTest: TestSuite::Tester {
+    explicit StaticBatchTest();
+
+    void stride();
+    void add();
+    void addTransformed();
+    void addNonIndexed();
+    void addOffsetIndices();
+    #ifndef MAGNUM_TARGET_GLES2
+    void addTransformationId();
+    void addTransformationIdNotEnabled();
+    #endif
+    void addWrongPrimitive();
+    void addMissingAttributes();
+    void addEmpty();
+};
+
+StaticBatchTest::StaticBatchTest() {
+    addTests({&StaticBatchTest::stride,
+              &StaticBatchTest::add,
+              &StaticBatchTest::addTransformed,
+              &StaticBatchTest::addNonIndexed,
+              &StaticBatchTest::addOffsetIndices,
+              #ifndef MAGNUM_TARGET_GLES2
+              &StaticBatchTest::addTransformationId,
+              &StaticBatchTest::addTransformationIdNotEnabled,
+              #endif
+              &StaticBatchTest::addWrongPrimitive,
+              &StaticBatchTest::addMissingAttributes,
+              &StaticBatchTest::addEmpty});
+}
+
+namespace {
+    struct Vertex {
+        Vector3 position;
+        Vector3 normal;
+        Vector2 textureCoordinates;
+    };
+
+    Trade::MeshData3D triangle(const Float offset) {
+        return Trade::MeshData3D{MeshPrimitive::Triangles, {0, 2, 1, 1, 2, 0}, {{
+            {offset, 0.0f, 0.0f},
+            {offset, 1.0f, 0.0f},
+            {offset, 0.0f, 1.0f}
+        }}, {{
+            Vector3::zAxis(),
+            Vector3::zAxis(),
+            Vector3::zAxis()
+        }}, {{
+            {0.0f, 0.0f},
+            {1.0f, 0.0f},
+            {0.0f, 1.0f}
+        }}, {}, nullptr};
+    }
+}
+
+void StaticBatchTest::stride() {
+    CORRADE_COMPARE(StaticBatch{MeshPrimitive::Triangles}.vertexStride(), 12);
+    CORRADE_COMPARE((StaticBatch{MeshPrimitive::Triangles,
+        StaticBatch::Flag::Normals|StaticBatch::Flag::TextureCoordinates}.vertexStride()), 32);
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_COMPARE((StaticBatch{MeshPrimitive::Triangles,
+        StaticBatch::Flag::TextureCoordinates|StaticBatch::Flag::TransformationIds}.vertexStride()), 24);
+    #endif
+}
+
+void StaticBatchTest::add() {
+    StaticBatch batch{MeshPrimitive::Triangles,
+        StaticBatch::Flag::Normals|StaticBatch::Flag::TextureCoordinates};
+    CORRADE_COMPARE(batch.add(triangle(0.0f)), 0);
+    CORRADE_COMPARE(batch.add(triangle(5.0f)), 1);
+
+    CORRADE_COMPARE(batch.size(), 2);
+    CORRADE_COMPARE(batch.vertexCount(), 6);
+    CORRADE_COMPARE(batch.vertexData().size(), 6*sizeof(Vertex));
+    CORRADE_COMPARE(batch.ranges()[1].indexOffset, 6);
+    CORRADE_COMPARE(batch.ranges()[1].indexCount, 6);
+    CORRADE_COMPARE(batch.ranges()[1].vertexOffset, 3);
+    CORRADE_COMPARE(batch.ranges()[1].vertexCount, 3);
+
+    #ifndef MAGNUM_TARGET_GLES
+    /* Indices are local to each mesh, base vertex is used */
+    CORRADE_COMPARE_AS(batch.indices(), (std::vector<UnsignedInt>{
+        0, 2, 1, 1, 2, 0,
+        0, 2, 1, 1, 2, 0}), TestSuite::Compare::Container);
+    #else
+    CORRADE_VERIFY(batch.flags() & StaticBatch::Flag::OffsetIndices);
+    CORRADE_COMPARE_AS(batch.indices(), (std::vector<UnsignedInt>{
+        0, 2, 1, 1, 2, 0,
+        3, 5, 4, 4, 5, 3}), TestSuite::Compare::Container);
+    #endif
+
+    const auto vertices = Containers::arrayCast<const Vertex>(batch.vertexData());
+    CORRADE_COMPARE(vertices[4].position, (Vector3{5.0f, 1.0f, 0.0f}));
+    CORRADE_COMPARE(vertices[4].normal, Vector3::zAxis());
+    CORRADE_COMPARE(vertices[4].textureCoordinates, (Vector2{1.0f, 0.0f}));
+}
+
+void StaticBatchTest::addTransformed() {
+    StaticBatch batch{MeshPrimitive::Triangles, StaticBatch::Flag::Normals};
+    batch.add(triangle(0.0f), Matrix4::translation({0.0f, 0.0f, 3.0f})*
+        Matrix4::scaling({1.0f, 1.0f, 2.0f})*
+        Matrix4::rotationY(Deg(90.0f)));
+
+    struct PositionNormal {
+        Vector3 position;
+        Vector3 normal;
+    };
+    const auto vertices = Containers::arrayCast<const PositionNormal>(batch.vertexData());
+    CORRADE_COMPARE(vertices.size(), 3);
+    CORRADE_COMPARE(vertices[1].position, (Vector3{0.0f, 1.0f, 3.0f}));
+    CORRADE_COMPARE(vertices[2].position, (Vector3{1.0f, 0.0f, 3.0f}));
+
+    /* Normal is renormalized after the non-uniform scaling */
+    CORRADE_COMPARE(vertices[0].normal, Vector3::xAxis());
+}
+
+void StaticBatchTest::addNonIndexed() {
+    StaticBatch batch{MeshPrimitive::Lines};
+    batch.add(Trade::MeshData3D{MeshPrimitive::Lines, {}, {{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f}
+    }}, {}, {}, {}, nullptr});
+    batch.add(Trade::MeshData3D{MeshPrimitive::Lines, {}, {{
+        {0.0f, 1.0f, 0.0f},
+        {1.0f, 1.0f, 0.0f},
+        {0.0f, 2.0f, 0.0f},
+        {1.0f, 2.0f, 0.0f}
+    }}, {}, {}, {}, nullptr});
+
+    CORRADE_COMPARE(batch.ranges()[1].indexOffset, 2);
+    CORRADE_COMPARE(batch.ranges()[1].indexCount, 4);
+    CORRADE_COMPARE(batch.ranges()[1].vertexOffset, 2);
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_COMPARE_AS(batch.indices(), (std::vector<UnsignedInt>{
+        0, 1, 0, 1, 2, 3}), TestSuite::Compare::Container);
+    #else
+    CORRADE_COMPARE_AS(batch.indices(), (std::vector<UnsignedInt>{
+        0, 1, 2, 3, 4, 5}), TestSuite::Compare::Container);
+    #endif
+}
+
+void StaticBatchTest::addOffsetIndices() {
+    StaticBatch batch{MeshPrimitive::Triangles, StaticBatch::Flag::OffsetIndices};
+    batch.add(triangle(0.0f));
+    batch.add(triangle(1.0f));
+    batch.add(triangle(2.0f));
+
+    CORRADE_COMPARE_AS(batch.indices(), (std::vector<UnsignedInt>{
+        0, 2, 1, 1, 2, 0,
+        3, 5, 4, 4, 5, 3,
+        6, 8, 7, 7, 8, 6}), TestSuite::Compare::Container);
+    CORRADE_COMPARE(batch.ranges()[2].vertexOffset, 6);
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void StaticBatchTest::addTransformationId() {
+    StaticBatch batch{MeshPrimitive::Triangles, StaticBatch::Flag::TransformationIds};
+    batch.add(triangle(0.0f), 7);
+    batch.add(triangle(1.0f), 3);
+
+    struct PositionId {
+        Vector3 position;
+        UnsignedInt id;
+    };
+    const auto vertices = Containers::arrayCast<const PositionId>(batch.vertexData());
+    CORRADE_COMPARE(vertices.size(), 6);
+    CORRADE_COMPARE(vertices[2].id, 7);
+    CORRADE_COMPARE(vertices[3].id, 3);
+
+    /* Positions are not transformed */
+    CORRADE_COMPARE(vertices[4].position, (Vector3{1.0f, 1.0f, 0.0f}));
+}
+
+void StaticBatchTest::addTransformationIdNotEnabled() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    StaticBatch batch{MeshPrimitive::Triangles};
+    batch.add(triangle(0.0f), 7);
+    CORRADE_COMPARE(batch.size(), 0);
+    CORRADE_COMPARE(out.str(), "MeshTools::StaticBatch::add(): transformation IDs not enabled\n");
+}
+#endif
+
+void StaticBatchTest::addWrongPrimitive() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    StaticBatch batch{MeshPrimitive::Lines};
+    batch.add(triangle(0.0f));
+    CORRADE_COMPARE(batch.size(), 0);
+    CORRADE_COMPARE(out.str(), "MeshTools::StaticBatch::add(): expected MeshPrimitive::Lines but got MeshPrimitive::Triangles\n");
+}
+
+void StaticBatchTest::addMissingAttributes() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Trade::MeshData3D positionsOnly{MeshPrimitive::Triangles, {}, {{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f}
+    }}, {}, {}, {}, nullptr};
+    StaticBatch{MeshPrimitive::Triangles, StaticBatch::Flag::Normals}.add(positionsOnly);
+    StaticBatch{MeshPrimitive::Triangles, StaticBatch::Flag::TextureCoordinates}.add(positionsOnly);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::StaticBatch::add(): the mesh has no normals\n"
+        "MeshTools::StaticBatch::add(): the mesh has no texture coordinates\n");
+}
+
+void StaticBatchTest::addEmpty() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    StaticBatch batch{MeshPrimitive::Triangles};
+    batch.add(Trade::MeshData3D{MeshPrimitive::Triangles, {}, {{}}, {}, {}, {}, nullptr});
+    CORRADE_COMPARE(batch.size(), 0);
+    CORRADE_COMPARE(out.str(), "MeshTools::StaticBatch::add(): the mesh has no vertices\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::StaticBatchTest)
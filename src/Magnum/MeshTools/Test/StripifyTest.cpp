@@ -0,0 +1,165 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/MeshTools/Stripify.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct StripifyTest: TestSuite::Tester {
+    explicit StripifyTest();
+
+    void grid();
+    void disconnected();
+    void winding();
+    void degenerate();
+    void empty();
+
+    void notTriangles();
+    void restartIndexCollision();
+    void indexOutOfBounds();
+};
+
+StripifyTest::StripifyTest() {
+    addTests({&StripifyTest::grid,
+              &StripifyTest::disconnected,
+              &StripifyTest::winding,
+              &StripifyTest::degenerate,
+              &StripifyTest::empty,
+
+              &StripifyTest::notTriangles,
+              &StripifyTest::restartIndexCollision,
+              &StripifyTest::indexOutOfBounds});
+}
+
+namespace {
+
+constexpr UnsignedInt Restart = 0xffff;
+
+/* Converts strips back to a triangle list with each triangle rotated so the
+   smallest index is first, sorted to be comparable with the original */
+std::vector<UnsignedInt> unstripify(const std::vector<UnsignedInt>& strips) {
+    std::vector<UnsignedInt> triangles;
+    std::size_t begin = 0;
+    for(std::size_t i = 0; i <= strips.size(); ++i) {
+        if(i != strips.size() && strips[i] != Restart) continue;
+
+        for(std::size_t j = begin; j + 2 < i; ++j) {
+            if((j - begin) % 2) triangles.insert(triangles.end(), {strips[j + 1], strips[j], strips[j + 2]});
+            else triangles.insert(triangles.end(), {strips[j], strips[j + 1], strips[j + 2]});
+        }
+        begin = i + 1;
+    }
+
+    return triangles;
+}
+
+std::vector<UnsignedInt> normalize(std::vector<UnsignedInt> triangles) {
+    std::vector<std::vector<UnsignedInt>> sorted;
+    for(auto it = triangles.begin(); it != triangles.end(); it += 3) {
+        std::rotate(it, std::min_element(it, it + 3), it + 3);
+        sorted.push_back({it, it + 3});
+    }
+    std::sort(sorted.begin(), sorted.end());
+
+    std::vector<UnsignedInt> out;
+    for(const std::vector<UnsignedInt>& triangle: sorted)
+        out.insert(out.end(), triangle.begin(), triangle.end());
+    return out;
+}
+
+}
+
+void StripifyTest::grid() {
+    /* 16x16 quads, each split into two triangles with the same winding */
+    std::vector<UnsignedInt> indices;
+    for(UnsignedInt y = 0; y != 16; ++y) for(UnsignedInt x = 0; x != 16; ++x) {
+        const UnsignedInt a = y*17 + x;
+        indices.insert(indices.end(), {a, a + 1, a + 18, a, a + 18, a + 17});
+    }
+
+    const std::vector<UnsignedInt> strips = stripify(indices, 17*17, Restart);
+    CORRADE_COMPARE_AS(normalize(unstripify(strips)), normalize(indices),
+        TestSuite::Compare::Container);
+
+    /* Roughly one strip per row */
+    CORRADE_VERIFY(strips.size() < indices.size()*6/10);
+}
+
+void StripifyTest::disconnected() {
+    const std::vector<UnsignedInt> strips = stripify({0, 1, 2, 3, 4, 5}, 6, Restart);
+    CORRADE_COMPARE(strips, (std::vector<UnsignedInt>{0, 1, 2, Restart, 3, 4, 5}));
+}
+
+void StripifyTest::winding() {
+    /* A quad and a triangle attached to it, all counterclockwise */
+    const std::vector<UnsignedInt> indices{0, 1, 2, 2, 1, 3, 2, 3, 4};
+    const std::vector<UnsignedInt> strips = stripify(indices, 5, Restart);
+    CORRADE_COMPARE(strips.size(), 5);
+    CORRADE_COMPARE_AS(normalize(unstripify(strips)), normalize(indices),
+        TestSuite::Compare::Container);
+}
+
+void StripifyTest::degenerate() {
+    const std::vector<UnsignedInt> strips = stripify({0, 1, 1, 0, 1, 2, 2, 2, 2}, 3, Restart);
+    CORRADE_COMPARE(strips, (std::vector<UnsignedInt>{0, 1, 2}));
+}
+
+void StripifyTest::empty() {
+    CORRADE_VERIFY(stripify({}, 0, Restart).empty());
+}
+
+void StripifyTest::notTriangles() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    stripify({0, 1, 2, 3}, 4, Restart);
+    CORRADE_COMPARE(out.str(), "MeshTools::stripify(): index count 4 not divisible by three\n");
+}
+
+void StripifyTest::restartIndexCollision() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    stripify({0, 1, 2}, 256, Mesh::primitiveRestartIndex(Mesh::IndexType::UnsignedByte));
+    CORRADE_COMPARE(out.str(), "MeshTools::stripify(): restart index 255 collides with 256 vertices\n");
+}
+
+void StripifyTest::indexOutOfBounds() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    stripify({0, 1, 3}, 3, Restart);
+    CORRADE_COMPARE(out.str(), "MeshTools::stripify(): index 3 out of bounds for 3 vertices\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::StripifyTest)
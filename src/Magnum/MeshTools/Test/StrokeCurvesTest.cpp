@@ -0,0 +1,131 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/MeshTools/StrokeCurves.h"
+
+namespace Magnum { namespace MeshTools { namespace Test {
+
+struct StrokeCurvesTest: TestSuite::Tester {
+    explicit StrokeCurvesTest();
+
+    void empty();
+    void line();
+    void corner();
+    void closed();
+    void disjoint();
+    void curve();
+};
+
+StrokeCurvesTest::StrokeCurvesTest() {
+    addTests({&StrokeCurvesTest::empty,
+              &StrokeCurvesTest::line,
+              &StrokeCurvesTest::corner,
+              &StrokeCurvesTest::closed,
+              &StrokeCurvesTest::disjoint,
+              &StrokeCurvesTest::curve});
+}
+
+void StrokeCurvesTest::empty() {
+    CORRADE_VERIFY(strokeCurves(std::vector<CubicBezier2D>{}, 1.0f, 0.1f).empty());
+}
+
+void StrokeCurvesTest::line() {
+    const std::vector<Vector2> strip = strokeCurves(std::vector<QuadraticBezier2D>{
+        QuadraticBezier2D{Vector2{0.0f, 0.0f}, Vector2{1.0f, 0.0f}, Vector2{2.0f, 0.0f}}
+    }, 2.0f, 0.1f);
+
+    CORRADE_COMPARE(strip, (std::vector<Vector2>{
+        {0.0f, 1.0f}, {0.0f, -1.0f},
+        {2.0f, 1.0f}, {2.0f, -1.0f}
+    }));
+}
+
+void StrokeCurvesTest::corner() {
+    /* Two connected curves forming a sharp corner, the corner vertices are
+       mitered so the stroke keeps its width along both of them */
+    const std::vector<Vector2> strip = strokeCurves(std::vector<QuadraticBezier2D>{
+        QuadraticBezier2D{Vector2{0.0f, 0.0f}, Vector2{1.0f, 0.0f}, Vector2{2.0f, 0.0f}},
+        QuadraticBezier2D{Vector2{2.0f, 0.0f}, Vector2{2.0f, -1.0f}, Vector2{2.0f, -2.0f}}
+    }, 2.0f, 0.1f);
+
+    CORRADE_COMPARE(strip, (std::vector<Vector2>{
+        {0.0f, 1.0f}, {0.0f, -1.0f},
+        {3.0f, 1.0f}, {1.0f, -1.0f},
+        {3.0f, -2.0f}, {1.0f, -2.0f}
+    }));
+}
+
+void StrokeCurvesTest::closed() {
+    /* A triangle, the first and last point are mitered the same way */
+    const std::vector<Vector2> strip = strokeCurves(std::vector<QuadraticBezier2D>{
+        QuadraticBezier2D{Vector2{0.0f, 0.0f}, Vector2{1.0f, 0.0f}, Vector2{2.0f, 0.0f}},
+        QuadraticBezier2D{Vector2{2.0f, 0.0f}, Vector2{1.5f, 1.0f}, Vector2{1.0f, 2.0f}},
+        QuadraticBezier2D{Vector2{1.0f, 2.0f}, Vector2{0.5f, 1.0f}, Vector2{0.0f, 0.0f}}
+    }, 0.5f, 0.1f);
+
+    CORRADE_COMPARE(strip.size(), 8);
+    CORRADE_COMPARE(strip.front(), strip[6]);
+    CORRADE_COMPARE(strip[1], strip.back());
+}
+
+void StrokeCurvesTest::disjoint() {
+    /* Separate paths are joined with degenerate triangles */
+    const std::vector<Vector2> strip = strokeCurves(std::vector<QuadraticBezier2D>{
+        QuadraticBezier2D{Vector2{0.0f, 0.0f}, Vector2{1.0f, 0.0f}, Vector2{2.0f, 0.0f}},
+        QuadraticBezier2D{Vector2{0.0f, 4.0f}, Vector2{1.0f, 4.0f}, Vector2{2.0f, 4.0f}}
+    }, 2.0f, 0.1f);
+
+    CORRADE_COMPARE(strip, (std::vector<Vector2>{
+        {0.0f, 1.0f}, {0.0f, -1.0f},
+        {2.0f, 1.0f}, {2.0f, -1.0f},
+        {2.0f, -1.0f}, {0.0f, 5.0f},
+        {0.0f, 5.0f}, {0.0f, 3.0f},
+        {2.0f, 5.0f}, {2.0f, 3.0f}
+    }));
+}
+
+void StrokeCurvesTest::curve() {
+    const CubicBezier2D curve{Vector2{0.0f, 0.0f}, Vector2{10.0f, 20.0f}, Vector2{20.0f, -20.0f}, Vector2{30.0f, 0.0f}};
+    const std::vector<Vector2> strip = strokeCurves(std::vector<CubicBezier2D>{curve}, 1.0f, 0.01f);
+
+    std::vector<Math::Vector<2, Float>> points(curve.tessellate(0.01f, nullptr));
+    curve.tessellate(0.01f, {points.data(), points.size()});
+    CORRADE_COMPARE(strip.size(), points.size()*2);
+
+    /* Each vertex pair is symmetric around the curve point and, as the curve
+       is smooth, roughly half of the width away from it */
+    for(std::size_t i = 0; i != points.size(); ++i) {
+        CORRADE_COMPARE((strip[i*2] + strip[i*2 + 1])*0.5f, Vector2{points[i]});
+        CORRADE_VERIFY(Math::abs((strip[i*2] - Vector2{points[i]}).length() - 0.5f) < 0.025f);
+    }
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::StrokeCurvesTest)
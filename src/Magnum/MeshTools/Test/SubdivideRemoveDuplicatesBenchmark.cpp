@@ -40,12 +40,14 @@ struct SubdivideRemoveDuplicatesBenchmark: TestSuite::Tester {
     void subdivide();
     void subdivideAndRemoveDuplicatesAfter();
     void subdivideAndRemoveDuplicatesInBetween();
+    void subdivideUnique();
 };
 
 SubdivideRemoveDuplicatesBenchmark::SubdivideRemoveDuplicatesBenchmark() {
     addBenchmarks({&SubdivideRemoveDuplicatesBenchmark::subdivide,
                    &SubdivideRemoveDuplicatesBenchmark::subdivideAndRemoveDuplicatesAfter,
-                   &SubdivideRemoveDuplicatesBenchmark::subdivideAndRemoveDuplicatesInBetween}, 4);
+                   &SubdivideRemoveDuplicatesBenchmark::subdivideAndRemoveDuplicatesInBetween,
+                   &SubdivideRemoveDuplicatesBenchmark::subdivideUnique}, 4);
 }
 
 namespace {
@@ -89,6 +91,16 @@ void SubdivideRemoveDuplicatesBenchmark::subdivideAndRemoveDuplicatesInBetween()
     }
 }
 
+void SubdivideRemoveDuplicatesBenchmark::subdivideUnique() {
+    CORRADE_BENCHMARK(3) {
+        Trade::MeshData3D icosphere = Primitives::Icosphere::solid(0);
+
+        /* Subdivide 5 times, no duplicates are created */
+        for(std::size_t i = 0; i != 5; ++i)
+            MeshTools::subdivideUnique(icosphere.indices(), icosphere.positions(0), interpolator);
+    }
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::SubdivideRemoveDuplicatesBenchmark)
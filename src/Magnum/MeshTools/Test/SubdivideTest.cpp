@@ -26,6 +26,7 @@
 #include <sstream>
 #include <Corrade/TestSuite/Tester.h>
 
+#include "Magnum/Math/Vector3.h"
 #include "Magnum/MeshTools/RemoveDuplicates.h"
 #include "Magnum/MeshTools/Subdivide.h"
 
@@ -36,6 +37,10 @@ struct SubdivideTest: TestSuite::Tester {
 
     void wrongIndexCount();
     void subdivide();
+
+    void uniqueWrongIndexCount();
+    void unique();
+    void uniqueSameAsRemoveDuplicates();
 };
 
 namespace {
@@ -48,7 +53,11 @@ inline Vector1 interpolator(Vector1 a, Vector1 b) { return (a[0]+b[0])/2; }
 
 SubdivideTest::SubdivideTest() {
     addTests({&SubdivideTest::wrongIndexCount,
-              &SubdivideTest::subdivide});
+              &SubdivideTest::subdivide,
+
+              &SubdivideTest::uniqueWrongIndexCount,
+              &SubdivideTest::unique,
+              &SubdivideTest::uniqueSameAsRemoveDuplicates});
 }
 
 void SubdivideTest::wrongIndexCount() {
@@ -72,6 +81,58 @@ void SubdivideTest::subdivide() {
     CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{4, 5, 6, 7, 8, 9, 0, 4, 6, 4, 1, 5, 6, 5, 2, 1, 7, 9, 7, 2, 8, 9, 8, 3}));
 }
 
+void SubdivideTest::uniqueWrongIndexCount() {
+    std::stringstream ss;
+    Error redirectError{&ss};
+
+    std::vector<Vector1> positions;
+    std::vector<UnsignedInt> indices{0, 1};
+    MeshTools::subdivideUnique(indices, positions, interpolator);
+    CORRADE_COMPARE(ss.str(), "MeshTools::subdivideUnique(): index count is not divisible by 3!\n");
+}
+
+void SubdivideTest::unique() {
+    std::vector<Vector1> positions{0, 2, 6, 8};
+    std::vector<UnsignedInt> indices{0, 1, 2, 1, 2, 3};
+    MeshTools::subdivideUnique(indices, positions, interpolator);
+
+    CORRADE_COMPARE(indices.size(), 24);
+
+    /* The shared 1-2 edge has just one vertex in the middle */
+    CORRADE_VERIFY(positions == (std::vector<Vector1>{0, 2, 6, 8, 1, 4, 3, 7, 5}));
+    CORRADE_COMPARE(indices, (std::vector<UnsignedInt>{4, 5, 6, 5, 7, 8, 0, 4, 6, 4, 1, 5, 6, 5, 2, 1, 5, 8, 5, 2, 7, 8, 7, 3}));
+}
+
+void SubdivideTest::uniqueSameAsRemoveDuplicates() {
+    /* Tetrahedron, projecting the new vertices onto a sphere */
+    const std::vector<Vector3> originalPositions{
+        { 1.0f,  1.0f,  1.0f},
+        {-1.0f, -1.0f,  1.0f},
+        {-1.0f,  1.0f, -1.0f},
+        { 1.0f, -1.0f, -1.0f}};
+    const std::vector<UnsignedInt> originalIndices{0, 1, 2, 0, 3, 1, 1, 3, 2, 2, 3, 0};
+    auto sphereInterpolator = [](const Vector3& a, const Vector3& b) {
+        return (a + b).normalized()*Constants::sqrt3();
+    };
+
+    std::vector<Vector3> positions = originalPositions;
+    std::vector<UnsignedInt> indices = originalIndices;
+    std::vector<Vector3> positionsUnique = originalPositions;
+    std::vector<UnsignedInt> indicesUnique = originalIndices;
+    for(std::size_t i = 0; i != 3; ++i) {
+        MeshTools::subdivide(indices, positions, sphereInterpolator);
+        MeshTools::subdivideUnique(indicesUnique, positionsUnique, sphereInterpolator);
+    }
+
+    const std::vector<UnsignedInt> remap = MeshTools::removeDuplicates(positions);
+    CORRADE_COMPARE(positionsUnique.size(), positions.size());
+    CORRADE_COMPARE(indicesUnique.size(), indices.size());
+
+    /* Same faces made of the same vertices */
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        CORRADE_COMPARE(positionsUnique[indicesUnique[i]], positions[remap[indices[i]]]);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::SubdivideTest)
@@ -23,6 +23,8 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <algorithm>
+#include <sstream>
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/Magnum.h"
@@ -35,6 +37,15 @@ struct TipsifyTest: TestSuite::Tester {
 
     void buildAdjacency();
     void tipsify();
+    void tipsifyLru();
+    void tipsifyMultiple();
+    void tipsifyMultipleWrongIndexCount();
+
+    void vertexCacheStatistics();
+    void vertexCacheStatisticsLru();
+    void vertexCacheStatisticsEmpty();
+    void vertexCacheStatisticsWrongIndexCount();
+    void vertexCacheStatisticsTipsify();
 };
 
 /*
@@ -83,7 +94,17 @@ namespace {
 
 TipsifyTest::TipsifyTest() {
     addTests({&TipsifyTest::buildAdjacency,
-              &TipsifyTest::tipsify});
+              &TipsifyTest::tipsify,
+
+              &TipsifyTest::tipsifyLru,
+              &TipsifyTest::tipsifyMultiple,
+              &TipsifyTest::tipsifyMultipleWrongIndexCount,
+
+              &TipsifyTest::vertexCacheStatistics,
+              &TipsifyTest::vertexCacheStatisticsLru,
+              &TipsifyTest::vertexCacheStatisticsEmpty,
+              &TipsifyTest::vertexCacheStatisticsWrongIndexCount,
+              &TipsifyTest::vertexCacheStatisticsTipsify});
 }
 
 void TipsifyTest::buildAdjacency() {
@@ -159,6 +180,106 @@ void TipsifyTest::tipsify() {
     }));
 }
 
+void TipsifyTest::tipsifyLru() {
+    std::vector<UnsignedInt> indices = Indices;
+    const VertexCacheStatistics before = MeshTools::vertexCacheStatistics(indices, VertexCount, 3, VertexCacheModel::Lru);
+    MeshTools::tipsify(indices, VertexCount, 3, VertexCacheModel::Lru);
+    const VertexCacheStatistics after = MeshTools::vertexCacheStatistics(indices, VertexCount, 3, VertexCacheModel::Lru);
+
+    /* All triangles are still there, just reordered */
+    CORRADE_COMPARE(indices.size(), Indices.size());
+    std::vector<UnsignedInt> sorted = indices, expected = Indices;
+    std::sort(sorted.begin(), sorted.end());
+    std::sort(expected.begin(), expected.end());
+    CORRADE_COMPARE(sorted, expected);
+
+    CORRADE_VERIFY(after.averageCacheMissRatio < before.averageCacheMissRatio);
+}
+
+void TipsifyTest::tipsifyMultiple() {
+    std::vector<UnsignedInt> a = Indices, b = Indices, c{0, 1, 2};
+    const std::vector<TipsifyStatistics> statistics = MeshTools::tipsify({{a, VertexCount}, {b, VertexCount}, {c, 3}}, 3, VertexCacheModel::Fifo, 2);
+
+    /* Same result as for a single mesh */
+    std::vector<UnsignedInt> expected = Indices;
+    MeshTools::tipsify(expected, VertexCount, 3);
+    CORRADE_COMPARE(a, expected);
+    CORRADE_COMPARE(b, expected);
+    CORRADE_COMPARE(c, (std::vector<UnsignedInt>{0, 1, 2}));
+
+    CORRADE_COMPARE(statistics.size(), 3);
+    CORRADE_COMPARE(statistics[0].before.averageCacheMissRatio, 53.0f/19.0f);
+    CORRADE_COMPARE(statistics[0].after.averageCacheMissRatio, 38.0f/19.0f);
+    CORRADE_COMPARE(statistics[1].before.averageCacheMissRatio, 53.0f/19.0f);
+    CORRADE_COMPARE(statistics[1].after.averageCacheMissRatio, 38.0f/19.0f);
+    CORRADE_COMPARE(statistics[2].before.averageCacheMissRatio, 3.0f);
+    CORRADE_COMPARE(statistics[2].after.averageCacheMissRatio, 3.0f);
+}
+
+void TipsifyTest::tipsifyMultipleWrongIndexCount() {
+    std::vector<UnsignedInt> a{0, 1, 2}, b{0, 1};
+
+    std::stringstream ss;
+    Error redirectError{&ss};
+    MeshTools::tipsify({{a, 3}, {b, 2}}, 3);
+    CORRADE_COMPARE(ss.str(), "MeshTools::tipsify(): index count of mesh 1 is not divisible by 3\n");
+}
+
+void TipsifyTest::vertexCacheStatistics() {
+    /* Two triangles sharing an edge, vertex 4 is not referenced */
+    const std::vector<UnsignedInt> indices{0, 1, 2, 2, 1, 3};
+
+    /* Everything except the first transformation of each vertex hits */
+    const VertexCacheStatistics large = MeshTools::vertexCacheStatistics(indices, 5, 3);
+    CORRADE_COMPARE(large.averageCacheMissRatio, 2.0f);
+    CORRADE_COMPARE(large.averageTransformToVertexRatio, 1.0f);
+
+    /* Only vertex 2 is still in the cache for the second triangle */
+    const VertexCacheStatistics small = MeshTools::vertexCacheStatistics(indices, 5, 1);
+    CORRADE_COMPARE(small.averageCacheMissRatio, 2.5f);
+    CORRADE_COMPARE(small.averageTransformToVertexRatio, 1.25f);
+}
+
+void TipsifyTest::vertexCacheStatisticsLru() {
+    /* Vertex 0 is used in all three triangles */
+    const std::vector<UnsignedInt> indices{0, 1, 2, 0, 3, 4, 0, 1, 5};
+
+    /* FIFO cache evicts vertex 0 after the fourth transformation, even though
+       it was just used */
+    const VertexCacheStatistics fifo = MeshTools::vertexCacheStatistics(indices, 6, 3, VertexCacheModel::Fifo);
+    CORRADE_COMPARE(fifo.averageCacheMissRatio, 8.0f/3.0f);
+    CORRADE_COMPARE(fifo.averageTransformToVertexRatio, 8.0f/6.0f);
+
+    /* LRU cache keeps it */
+    const VertexCacheStatistics lru = MeshTools::vertexCacheStatistics(indices, 6, 3, VertexCacheModel::Lru);
+    CORRADE_COMPARE(lru.averageCacheMissRatio, 7.0f/3.0f);
+    CORRADE_COMPARE(lru.averageTransformToVertexRatio, 7.0f/6.0f);
+}
+
+void TipsifyTest::vertexCacheStatisticsEmpty() {
+    const VertexCacheStatistics statistics = MeshTools::vertexCacheStatistics({}, 5, 3);
+    CORRADE_COMPARE(statistics.averageCacheMissRatio, 0.0f);
+    CORRADE_COMPARE(statistics.averageTransformToVertexRatio, 0.0f);
+}
+
+void TipsifyTest::vertexCacheStatisticsWrongIndexCount() {
+    std::stringstream ss;
+    Error redirectError{&ss};
+    MeshTools::vertexCacheStatistics({0, 1}, 2, 3);
+    CORRADE_COMPARE(ss.str(), "MeshTools::vertexCacheStatistics(): index count is not divisible by 3!\n");
+}
+
+void TipsifyTest::vertexCacheStatisticsTipsify() {
+    std::vector<UnsignedInt> indices = Indices;
+    const VertexCacheStatistics before = MeshTools::vertexCacheStatistics(indices, VertexCount, 3);
+    MeshTools::tipsify(indices, VertexCount, 3);
+    const VertexCacheStatistics after = MeshTools::vertexCacheStatistics(indices, VertexCount, 3);
+
+    CORRADE_COMPARE(before.averageCacheMissRatio, 53.0f/19.0f);
+    CORRADE_COMPARE(after.averageCacheMissRatio, 38.0f/19.0f);
+    CORRADE_VERIFY(after.averageTransformToVertexRatio < before.averageTransformToVertexRatio);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::TipsifyTest)
@@ -24,7 +24,10 @@
 */
 
 #include <array>
+#include <sstream>
+#include <vector>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
 
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Magnum.h"
@@ -40,6 +43,14 @@ struct TransformTest: TestSuite::Tester {
 
     void transformPoints2D();
     void transformPoints3D();
+
+    void transformVectorsInto();
+    void transformPointsInto();
+    void transformIntoInPlace();
+    void transformIntoWrongSize();
+
+    void transformPoints1k();
+    void transformPoints1kBatch();
 };
 
 TransformTest::TransformTest() {
@@ -47,7 +58,15 @@ TransformTest::TransformTest() {
               &TransformTest::transformVectors3D,
 
               &TransformTest::transformPoints2D,
-              &TransformTest::transformPoints3D});
+              &TransformTest::transformPoints3D,
+
+              &TransformTest::transformVectorsInto,
+              &TransformTest::transformPointsInto,
+              &TransformTest::transformIntoInPlace,
+              &TransformTest::transformIntoWrongSize});
+
+    addBenchmarks({&TransformTest::transformPoints1k,
+                   &TransformTest::transformPoints1kBatch}, 100);
 }
 
 constexpr static std::array<Vector2, 2> points2D{{
@@ -116,6 +135,95 @@ void TransformTest::transformPoints3D() {
     CORRADE_COMPARE(quaternion, points3DRotatedTranslated);
 }
 
+namespace {
+
+/* Size not divisible by four to test the remainder handling as well */
+std::vector<Vector3> points(const std::size_t count = 1003) {
+    std::vector<Vector3> out;
+    for(std::size_t i = 0; i != count; ++i) {
+        const Float f = Float(i);
+        out.emplace_back(f*0.5f, 3.0f - f, f*0.25f - 7.0f);
+    }
+    return out;
+}
+
+const Matrix4 transformation = Matrix4::translation({1.0f, -2.0f, 0.5f})*
+    Matrix4::rotation(Deg(35.0f), Vector3{1.0f, 1.0f, -2.0f}.normalized())*
+    Matrix4::scaling({2.0f, 0.5f, 1.5f});
+
+}
+
+void TransformTest::transformVectorsInto() {
+    const std::vector<Vector3> in = points();
+    std::vector<Vector3> out(in.size());
+    MeshTools::transformVectorsInto(transformation, {in.data(), in.size()}, {out.data(), out.size()});
+
+    std::vector<Vector3> expected = in;
+    MeshTools::transformVectorsInPlace<Float>(transformation, expected);
+    CORRADE_COMPARE_AS(out, expected, TestSuite::Compare::Container);
+}
+
+void TransformTest::transformPointsInto() {
+    const std::vector<Vector3> in = points();
+    std::vector<Vector3> out(in.size());
+    MeshTools::transformPointsInto(transformation, {in.data(), in.size()}, {out.data(), out.size()});
+
+    std::vector<Vector3> expected = in;
+    MeshTools::transformPointsInPlace<Float>(transformation, expected);
+    CORRADE_COMPARE_AS(out, expected, TestSuite::Compare::Container);
+
+    /* Known values */
+    Vector3 data[]{points3D[0], points3D[1], points3D[0], points3D[1], points3D[0]};
+    MeshTools::transformPointsInPlace(
+        Matrix4::translation(Vector3::yAxis(-1.0f))*Matrix4::rotationZ(Deg(90.0f)), Containers::arrayView(data));
+    CORRADE_COMPARE(data[0], points3DRotatedTranslated[0]);
+    CORRADE_COMPARE(data[3], points3DRotatedTranslated[1]);
+    CORRADE_COMPARE(data[4], points3DRotatedTranslated[0]);
+}
+
+void TransformTest::transformIntoInPlace() {
+    std::vector<Vector3> data = points();
+    std::vector<Vector3> expected = data;
+    MeshTools::transformPointsInPlace<Float>(transformation, expected);
+
+    MeshTools::transformPointsInPlace(transformation, {data.data(), data.size()});
+    CORRADE_COMPARE_AS(data, expected, TestSuite::Compare::Container);
+}
+
+void TransformTest::transformIntoWrongSize() {
+    const Vector3 in[3];
+    Vector3 out[2];
+
+    std::ostringstream o;
+    Error redirectError{&o};
+    MeshTools::transformPointsInto(Matrix4{}, in, out);
+    MeshTools::transformVectorsInto(Matrix4{}, in, out);
+    CORRADE_COMPARE(o.str(),
+        "MeshTools::transformPointsInto(): wrong output size, got 2 but expected 3\n"
+        "MeshTools::transformVectorsInto(): wrong output size, got 2 but expected 3\n");
+}
+
+void TransformTest::transformPoints1k() {
+    const std::vector<Vector3> in = points(1000);
+    std::vector<Vector3> out(in.size());
+    CORRADE_BENCHMARK(100)
+        for(std::size_t i = 0; i != in.size(); ++i)
+            out[i] = transformation.transformPoint(in[i]);
+
+    /* To avoid optimizing things out */
+    CORRADE_VERIFY(out[999] != Vector3{});
+}
+
+void TransformTest::transformPoints1kBatch() {
+    const std::vector<Vector3> in = points(1000);
+    std::vector<Vector3> out(in.size());
+    CORRADE_BENCHMARK(100)
+        MeshTools::transformPointsInto(transformation, {in.data(), in.size()}, {out.data(), out.size()});
+
+    /* To avoid optimizing things out */
+    CORRADE_VERIFY(out[999] != Vector3{});
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::TransformTest)
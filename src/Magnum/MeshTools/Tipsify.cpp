@@ -25,11 +25,17 @@
 
 #include "Tipsify.h"
 
-#include <stack>
+#include <algorithm>
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <atomic>
+#include <thread>
+#endif
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
 
 namespace Magnum { namespace MeshTools { namespace Implementation {
 
-void Tipsify::operator()(std::size_t cacheSize) {
+void Tipsify::operator()(const std::size_t cacheSize, const VertexCacheModel model) {
     /* Neighboring triangles for each vertex, per-vertex live triangle count */
     std::vector<UnsignedInt> liveTriangleCount, neighborPosition, neighbors;
     buildAdjacency(liveTriangleCount, neighborPosition, neighbors);
@@ -39,8 +45,11 @@ void Tipsify::operator()(std::size_t cacheSize) {
     std::vector<UnsignedInt> timestamp(vertexCount);
     std::vector<bool> emitted(indices.size()/3);
 
-    /* Dead-end vertex stack */
-    std::stack<UnsignedInt> deadEndStack;
+    /* Dead-end vertex stack. Candidates for next fanning vertex (in 1-ring
+       around fanning vertex), reused across iterations to avoid
+       reallocations. */
+    std::vector<UnsignedInt> deadEndStack, candidates;
+    deadEndStack.reserve(indices.size());
 
     /* Output index buffer */
     std::vector<UnsignedInt> outputIndices;
@@ -50,12 +59,12 @@ void Tipsify::operator()(std::size_t cacheSize) {
     UnsignedInt fanningVertex = 0;
     UnsignedInt i = 0;
     while(fanningVertex != 0xFFFFFFFFu) {
-        /* Array with candidates for next fanning vertex (in 1-ring around
-           fanning vertex) */
-        std::vector<UnsignedInt> candidates;
+        candidates.clear();
 
         /* For all neighbors of fanning vertex */
-        for(UnsignedInt ti = neighborPosition[fanningVertex], t = neighbors[ti]; ti != neighborPosition[fanningVertex+1]; t = neighbors[++ti]) {
+        for(UnsignedInt ti = neighborPosition[fanningVertex]; ti != neighborPosition[fanningVertex+1]; ++ti) {
+            const UnsignedInt t = neighbors[ti];
+
             /* Continue if already emitted */
             if(emitted[t]) continue;
             emitted[t] = true;
@@ -68,14 +77,15 @@ void Tipsify::operator()(std::size_t cacheSize) {
 
                 /* Add to dead end stack and candidates array */
                 /** @todo Limit size of dead end stack to cache size */
-                deadEndStack.push(v);
+                deadEndStack.push_back(v);
                 candidates.push_back(v);
 
                 /* Decrease live triangle count */
                 --liveTriangleCount[v];
 
-                /* If not in cache, set timestamp */
-                if(time-timestamp[v] > cacheSize)
+                /* If not in cache, set timestamp. LRU cache refreshes the
+                   timestamp also on a hit. */
+                if(model == VertexCacheModel::Lru || time-timestamp[v] > cacheSize)
                     timestamp[v] = time++;
             }
         }
@@ -105,8 +115,8 @@ void Tipsify::operator()(std::size_t cacheSize) {
         if(fanningVertex == 0xFFFFFFFFu) {
             /* Find vertex with live triangles in dead-end stack */
             while(!deadEndStack.empty()) {
-                unsigned int d = deadEndStack.top();
-                deadEndStack.pop();
+                const UnsignedInt d = deadEndStack.back();
+                deadEndStack.pop_back();
 
                 if(!liveTriangleCount[d]) continue;
                 fanningVertex = d;
@@ -132,30 +142,126 @@ void Tipsify::operator()(std::size_t cacheSize) {
 void Tipsify::buildAdjacency(std::vector<UnsignedInt>& liveTriangleCount, std::vector<UnsignedInt>& neighborOffset, std::vector<UnsignedInt>& neighbors) const {
     /* How many times is each vertex referenced == count of neighboring
        triangles for each vertex */
-    liveTriangleCount.clear();
-    liveTriangleCount.resize(vertexCount);
-    for(std::size_t i = 0; i != indices.size(); ++i)
-        ++liveTriangleCount[indices[i]];
+    liveTriangleCount.assign(vertexCount, 0);
+    for(const UnsignedInt index: indices) ++liveTriangleCount[index];
 
     /* Building offset array from counts. Neighbors for i-th vertex will at
        the end be in interval neighbors[neighborOffset[i]] ;
        neighbors[neighborOffset[i+1]]. Currently the values are shifted to
        right, because the next loop will shift them back left. */
-    neighborOffset.clear();
-    neighborOffset.reserve(vertexCount+1);
-    neighborOffset.push_back(0);
+    neighborOffset.resize(vertexCount+1);
+    neighborOffset[0] = 0;
     UnsignedInt sum = 0;
     for(std::size_t i = 0; i != vertexCount; ++i) {
-        neighborOffset.push_back(sum);
+        neighborOffset[i+1] = sum;
         sum += liveTriangleCount[i];
     }
 
     /* Array of neighbors, using (and changing) neighborOffset array for
-       positioning */
-    neighbors.clear();
+       positioning. The neighbors are written without initializing the
+       array first. */
     neighbors.resize(sum);
+    UnsignedInt* const out = neighbors.data();
+    UnsignedInt* const offset = neighborOffset.data() + 1;
     for(std::size_t i = 0; i != indices.size(); ++i)
-        neighbors[neighborOffset[indices[i]+1]++] = i/3;
+        out[offset[indices[i]]++] = i/3;
+}
+
+}
+
+VertexCacheStatistics vertexCacheStatistics(const std::vector<UnsignedInt>& indices, const UnsignedInt vertexCount, const std::size_t cacheSize, const VertexCacheModel model) {
+    CORRADE_ASSERT(!(indices.size()%3), "MeshTools::vertexCacheStatistics(): index count is not divisible by 3!", {});
+
+    if(indices.empty()) return {0.0f, 0.0f};
+
+    std::size_t misses = 0;
+    std::size_t referencedVertexCount = 0;
+
+    /* Global time and per-vertex caching timestamps, the same as in
+       tipsify() */
+    if(model == VertexCacheModel::Fifo) {
+        std::size_t time = cacheSize + 1;
+        std::vector<std::size_t> timestamp(vertexCount);
+        for(const UnsignedInt v: indices) {
+            CORRADE_ASSERT(v < vertexCount, "MeshTools::vertexCacheStatistics(): index" << v << "out of bounds for" << vertexCount << "vertices", {});
+
+            if(!timestamp[v]) ++referencedVertexCount;
+            if(time - timestamp[v] > cacheSize) {
+                timestamp[v] = time++;
+                ++misses;
+            }
+        }
+
+    /* Cache contents ordered from the most recently used, move the vertex to
+       the front on a hit, drop the last on a miss. The caches are small so a
+       linear search is fine. */
+    } else {
+        std::vector<UnsignedInt> cache;
+        cache.reserve(cacheSize + 1);
+        std::vector<bool> referenced(vertexCount);
+        for(const UnsignedInt v: indices) {
+            CORRADE_ASSERT(v < vertexCount, "MeshTools::vertexCacheStatistics(): index" << v << "out of bounds for" << vertexCount << "vertices", {});
+
+            if(!referenced[v]) {
+                referenced[v] = true;
+                ++referencedVertexCount;
+            }
+
+            auto found = std::find(cache.begin(), cache.end(), v);
+            if(found == cache.end()) {
+                ++misses;
+                if(!cacheSize) continue;
+                if(cache.size() == cacheSize) cache.pop_back();
+                cache.insert(cache.begin(), v);
+            } else std::rotate(cache.begin(), found, found + 1);
+        }
+    }
+
+    return {Float(misses)/Float(indices.size()/3), Float(misses)/Float(referencedVertexCount)};
+}
+
+std::vector<TipsifyStatistics> tipsify(const std::vector<std::pair<std::reference_wrapper<std::vector<UnsignedInt>>, UnsignedInt>>& meshes, const std::size_t cacheSize, const VertexCacheModel model, UnsignedInt threadCount) {
+    std::vector<TipsifyStatistics> statistics(meshes.size());
+
+    #ifndef CORRADE_NO_ASSERT
+    for(std::size_t i = 0; i != meshes.size(); ++i)
+        CORRADE_ASSERT(!(meshes[i].first.get().size()%3),
+            "MeshTools::tipsify(): index count of mesh" << i << "is not divisible by 3", statistics);
+    #endif
+
+    /* Meshes can have wildly different sizes, so instead of splitting them
+       evenly, each thread picks the next unprocessed one */
+    auto process = [&](const std::size_t i) {
+        std::vector<UnsignedInt>& indices = meshes[i].first;
+        const UnsignedInt vertexCount = meshes[i].second;
+        statistics[i].before = vertexCacheStatistics(indices, vertexCount, cacheSize, model);
+        MeshTools::tipsify(indices, vertexCount, cacheSize, model);
+        statistics[i].after = vertexCacheStatistics(indices, vertexCount, cacheSize, model);
+    };
+
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    if(!threadCount) threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    const std::size_t workerCount = std::min(std::size_t(threadCount), meshes.size());
+    if(workerCount > 1) {
+        std::atomic<std::size_t> next{0};
+        auto worker = [&]() {
+            for(std::size_t i; (i = next++) < meshes.size(); ) process(i);
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(workerCount - 1);
+        for(std::size_t i = 1; i != workerCount; ++i)
+            threads.emplace_back(worker);
+        worker();
+        for(std::thread& thread: threads) thread.join();
+        return statistics;
+    }
+    #else
+    static_cast<void>(threadCount);
+    #endif
+
+    for(std::size_t i = 0; i != meshes.size(); ++i) process(i);
+    return statistics;
 }
 
-}}}
+}}
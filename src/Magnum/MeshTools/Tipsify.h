@@ -26,9 +26,11 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::tipsify()
+ * @brief Function @ref Magnum::MeshTools::tipsify(), @ref Magnum::MeshTools::vertexCacheStatistics(), struct @ref Magnum::MeshTools::VertexCacheStatistics, @ref Magnum::MeshTools::TipsifyStatistics, enum @ref Magnum::MeshTools::VertexCacheModel
  */
 
+#include <functional>
+#include <utility>
 #include <vector>
 
 #include "Magnum/Types.h"
@@ -36,13 +38,32 @@
 
 namespace Magnum { namespace MeshTools {
 
+/**
+@brief Post-transform vertex cache model
+
+@see @ref tipsify(), @ref vertexCacheStatistics()
+*/
+enum class VertexCacheModel: UnsignedByte {
+    /**
+     * First-in first-out cache. A cache hit doesn't change the order in
+     * which vertices are evicted. Matches most desktop GPUs.
+     */
+    Fifo,
+
+    /**
+     * Least-recently used cache. A cache hit moves the vertex to the front
+     * of the cache.
+     */
+    Lru
+};
+
 namespace Implementation {
 
 class MAGNUM_MESHTOOLS_EXPORT Tipsify {
     public:
         Tipsify(std::vector<UnsignedInt>& indices, UnsignedInt vertexCount): indices(indices), vertexCount(vertexCount) {}
 
-        void operator()(std::size_t cacheSize);
+        void operator()(std::size_t cacheSize, VertexCacheModel model = VertexCacheModel::Fifo);
 
         /**
          * @brief Build vertex-triangle adjacency
@@ -65,18 +86,101 @@ class MAGNUM_MESHTOOLS_EXPORT Tipsify {
 @param[in,out] indices  Indices array to operate on
 @param[in] vertexCount  Vertex count
 @param[in] cacheSize    Post-transform vertex cache size
+@param[in] model        Post-transform vertex cache model
 
 Optimizes the mesh for vertex-bound applications by rearranging its index
 array for beter usage of post-transform vertex cache. Algorithm used:
 *Pedro V. Sander, Diego Nehab, and Joshua Barczak - Fast Triangle Reordering
 for Vertex Locality and Reduced Overdraw, SIGGRAPH 2007,
 http://gfx.cs.princeton.edu/pubs/Sander_2007_%3ETR/index.php*.
+
+The reordering can be followed by @ref optimizeOverdraw() and
+@ref optimizeVertexFetch(), use @ref vertexCacheStatistics() to measure the
+result.
+
+The algorithm assumes a FIFO cache. For @ref VertexCacheModel::Lru the age of
+a vertex is refreshed on every cache hit, which is a conservative
+approximation of the LRU eviction order.
 @todo Ability to compute vertex count automatically
 */
-inline void tipsify(std::vector<UnsignedInt>& indices, UnsignedInt vertexCount, std::size_t cacheSize) {
-    Implementation::Tipsify(indices, vertexCount)(cacheSize);
+inline void tipsify(std::vector<UnsignedInt>& indices, UnsignedInt vertexCount, std::size_t cacheSize, VertexCacheModel model = VertexCacheModel::Fifo) {
+    Implementation::Tipsify(indices, vertexCount)(cacheSize, model);
 }
 
+/**
+@brief Post-transform vertex cache statistics
+
+@see @ref vertexCacheStatistics()
+*/
+struct VertexCacheStatistics {
+    /**
+     * @brief Average cache miss ratio
+     *
+     * Count of transformed vertices divided by triangle count. The value is
+     * between @cpp 0.5 @ce (ideal case for very large meshes) and
+     * @cpp 3.0 @ce (each vertex transformed for every triangle).
+     */
+    Float averageCacheMissRatio;
+
+    /**
+     * @brief Average transform to vertex ratio
+     *
+     * Count of transformed vertices divided by count of distinct vertices
+     * referenced by the index array. The value is @cpp 1.0 @ce in the ideal
+     * case, independently of mesh topology.
+     */
+    Float averageTransformToVertexRatio;
+};
+
+/**
+@brief Calculate post-transform vertex cache statistics
+@param indices      Index array
+@param vertexCount  Vertex count
+@param cacheSize    Post-transform vertex cache size
+@param model        Post-transform vertex cache model
+
+Simulates a post-transform vertex cache of given size and model. Returns zero
+ratios for an empty index array.
+
+@attention The function requires the mesh to have triangle faces, thus index
+    count must be divisible by 3.
+*/
+MAGNUM_MESHTOOLS_EXPORT VertexCacheStatistics vertexCacheStatistics(const std::vector<UnsignedInt>& indices, UnsignedInt vertexCount, std::size_t cacheSize, VertexCacheModel model = VertexCacheModel::Fifo);
+
+/**
+@brief Tipsify statistics
+
+@see @ref tipsify(const std::vector<std::pair<std::reference_wrapper<std::vector<UnsignedInt>>, UnsignedInt>>&, std::size_t, VertexCacheModel, UnsignedInt)
+*/
+struct TipsifyStatistics {
+    VertexCacheStatistics before;   /**< @brief Statistics before tipsifying */
+    VertexCacheStatistics after;    /**< @brief Statistics after tipsifying */
+};
+
+/**
+@brief Tipsify multiple meshes in parallel
+@param[in,out] meshes   Index arrays to operate on, each paired with its
+    vertex count
+@param[in] cacheSize    Post-transform vertex cache size
+@param[in] model        Post-transform vertex cache model
+@param[in] threadCount  Count of worker threads. If `0`, the count is
+    @cpp std::thread::hardware_concurrency() @ce.
+@return Cache statistics before and after for each mesh
+
+Calls @ref tipsify(std::vector<UnsignedInt>&, UnsignedInt, std::size_t, VertexCacheModel)
+and @ref vertexCacheStatistics() on each mesh, distributing the meshes
+between @p threadCount threads. The meshes can be also meshlets sharing the
+same vertex data. On Emscripten the meshes are processed sequentially.
+@code
+std::vector<UnsignedInt> a, b;
+std::vector<MeshTools::TipsifyStatistics> statistics = MeshTools::tipsify({{a, 1057}, {b, 283}}, 32);
+@endcode
+
+@attention The function requires the meshes to have triangle faces, thus
+    index count must be divisible by 3.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::vector<TipsifyStatistics> tipsify(const std::vector<std::pair<std::reference_wrapper<std::vector<UnsignedInt>>, UnsignedInt>>& meshes, std::size_t cacheSize, VertexCacheModel model = VertexCacheModel::Fifo, UnsignedInt threadCount = 0);
+
 }}
 
 #endif
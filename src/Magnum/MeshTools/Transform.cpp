@@ -0,0 +1,156 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Transform.h"
+
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Matrix4.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#elif defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#endif
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+#ifdef __SSE2__
+/* Transforms four tightly packed Vector3s at once. The data are converted
+   from x0y0z0x1 y1z1x2y2 z2x3y3z3 to xxxx yyyy zzzz, transformed with the
+   same operation order as Matrix4::transformPoint() and converted back. */
+template<bool translate> void transformSimd(const Matrix4& matrix, const Float* const in, Float* const out, const std::size_t count) {
+    const __m128 m00 = _mm_set1_ps(matrix[0][0]), m01 = _mm_set1_ps(matrix[0][1]), m02 = _mm_set1_ps(matrix[0][2]);
+    const __m128 m10 = _mm_set1_ps(matrix[1][0]), m11 = _mm_set1_ps(matrix[1][1]), m12 = _mm_set1_ps(matrix[1][2]);
+    const __m128 m20 = _mm_set1_ps(matrix[2][0]), m21 = _mm_set1_ps(matrix[2][1]), m22 = _mm_set1_ps(matrix[2][2]);
+    const __m128 m30 = _mm_set1_ps(matrix[3][0]), m31 = _mm_set1_ps(matrix[3][1]), m32 = _mm_set1_ps(matrix[3][2]);
+
+    for(std::size_t i = 0; i != count; i += 4) {
+        const Float* const src = in + i*3;
+        const __m128 v0 = _mm_loadu_ps(src + 0);
+        const __m128 v1 = _mm_loadu_ps(src + 4);
+        const __m128 v2 = _mm_loadu_ps(src + 8);
+
+        const __m128 t0 = _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(2, 1, 3, 2));
+        const __m128 t1 = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(1, 0, 2, 1));
+        const __m128 x = _mm_shuffle_ps(v0, t0, _MM_SHUFFLE(2, 0, 3, 0));
+        const __m128 y = _mm_shuffle_ps(t1, t0, _MM_SHUFFLE(3, 1, 2, 0));
+        const __m128 z = _mm_shuffle_ps(t1, v2, _MM_SHUFFLE(3, 0, 3, 1));
+
+        __m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m00), _mm_mul_ps(y, m10)), _mm_mul_ps(z, m20));
+        __m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m01), _mm_mul_ps(y, m11)), _mm_mul_ps(z, m21));
+        __m128 rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m02), _mm_mul_ps(y, m12)), _mm_mul_ps(z, m22));
+        if(translate) {
+            rx = _mm_add_ps(rx, m30);
+            ry = _mm_add_ps(ry, m31);
+            rz = _mm_add_ps(rz, m32);
+        }
+
+        const __m128 s0 = _mm_shuffle_ps(rx, ry, _MM_SHUFFLE(1, 0, 1, 0));
+        const __m128 s1 = _mm_shuffle_ps(rz, rx, _MM_SHUFFLE(3, 1, 2, 0));
+        const __m128 s2 = _mm_shuffle_ps(ry, rz, _MM_SHUFFLE(2, 1, 2, 1));
+        const __m128 s3 = _mm_shuffle_ps(rx, ry, _MM_SHUFFLE(2, 2, 2, 2));
+        const __m128 s4 = _mm_shuffle_ps(rz, rx, _MM_SHUFFLE(3, 3, 2, 2));
+        const __m128 s5 = _mm_shuffle_ps(ry, rz, _MM_SHUFFLE(3, 3, 3, 3));
+
+        Float* const dst = out + i*3;
+        _mm_storeu_ps(dst + 0, _mm_shuffle_ps(s0, s1, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(dst + 4, _mm_shuffle_ps(s2, s3, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(dst + 8, _mm_shuffle_ps(s4, s5, _MM_SHUFFLE(2, 0, 2, 0)));
+    }
+}
+#elif defined(__wasm_simd128__)
+/* Same as the SSE2 variant above, the two-input shuffles allow assembling
+   each of the deinterleaved and interleaved vectors in just two steps */
+template<bool translate> void transformSimd(const Matrix4& matrix, const Float* const in, Float* const out, const std::size_t count) {
+    const v128_t m00 = wasm_f32x4_splat(matrix[0][0]), m01 = wasm_f32x4_splat(matrix[0][1]), m02 = wasm_f32x4_splat(matrix[0][2]);
+    const v128_t m10 = wasm_f32x4_splat(matrix[1][0]), m11 = wasm_f32x4_splat(matrix[1][1]), m12 = wasm_f32x4_splat(matrix[1][2]);
+    const v128_t m20 = wasm_f32x4_splat(matrix[2][0]), m21 = wasm_f32x4_splat(matrix[2][1]), m22 = wasm_f32x4_splat(matrix[2][2]);
+    const v128_t m30 = wasm_f32x4_splat(matrix[3][0]), m31 = wasm_f32x4_splat(matrix[3][1]), m32 = wasm_f32x4_splat(matrix[3][2]);
+
+    for(std::size_t i = 0; i != count; i += 4) {
+        const Float* const src = in + i*3;
+        const v128_t v0 = wasm_v128_load(src + 0);
+        const v128_t v1 = wasm_v128_load(src + 4);
+        const v128_t v2 = wasm_v128_load(src + 8);
+
+        const v128_t x = wasm_i32x4_shuffle(wasm_i32x4_shuffle(v0, v1, 0, 3, 6, 0), v2, 0, 1, 2, 5);
+        const v128_t y = wasm_i32x4_shuffle(wasm_i32x4_shuffle(v0, v1, 1, 4, 7, 0), v2, 0, 1, 2, 6);
+        const v128_t z = wasm_i32x4_shuffle(wasm_i32x4_shuffle(v0, v1, 2, 5, 0, 0), v2, 0, 1, 4, 7);
+
+        v128_t rx = wasm_f32x4_add(wasm_f32x4_add(wasm_f32x4_mul(x, m00), wasm_f32x4_mul(y, m10)), wasm_f32x4_mul(z, m20));
+        v128_t ry = wasm_f32x4_add(wasm_f32x4_add(wasm_f32x4_mul(x, m01), wasm_f32x4_mul(y, m11)), wasm_f32x4_mul(z, m21));
+        v128_t rz = wasm_f32x4_add(wasm_f32x4_add(wasm_f32x4_mul(x, m02), wasm_f32x4_mul(y, m12)), wasm_f32x4_mul(z, m22));
+        if(translate) {
+            rx = wasm_f32x4_add(rx, m30);
+            ry = wasm_f32x4_add(ry, m31);
+            rz = wasm_f32x4_add(rz, m32);
+        }
+
+        Float* const dst = out + i*3;
+        wasm_v128_store(dst + 0, wasm_i32x4_shuffle(wasm_i32x4_shuffle(rx, ry, 0, 4, 1, 5), rz, 0, 1, 4, 2));
+        wasm_v128_store(dst + 4, wasm_i32x4_shuffle(wasm_i32x4_shuffle(ry, rz, 1, 5, 2, 6), rx, 0, 1, 6, 2));
+        wasm_v128_store(dst + 8, wasm_i32x4_shuffle(wasm_i32x4_shuffle(rz, rx, 2, 7, 3, 0), ry, 0, 1, 7, 2));
+    }
+}
+#endif
+
+}
+
+void transformVectorsInto(const Matrix4& matrix, const Containers::ArrayView<const Vector3> vectors, const Containers::ArrayView<Vector3> out) {
+    CORRADE_ASSERT(vectors.size() == out.size(),
+        "MeshTools::transformVectorsInto(): wrong output size, got" << out.size() << "but expected" << vectors.size(), );
+
+    std::size_t i = 0;
+    #if defined(__SSE2__) || defined(__wasm_simd128__)
+    i = vectors.size() & ~std::size_t(3);
+    transformSimd<false>(matrix, vectors.data()->data(), out.data()->data(), i);
+    #endif
+    for(; i != vectors.size(); ++i) out[i] = matrix.transformVector(vectors[i]);
+}
+
+void transformVectorsInPlace(const Matrix4& matrix, const Containers::ArrayView<Vector3> vectors) {
+    transformVectorsInto(matrix, vectors, vectors);
+}
+
+void transformPointsInto(const Matrix4& matrix, const Containers::ArrayView<const Vector3> points, const Containers::ArrayView<Vector3> out) {
+    CORRADE_ASSERT(points.size() == out.size(),
+        "MeshTools::transformPointsInto(): wrong output size, got" << out.size() << "but expected" << points.size(), );
+
+    std::size_t i = 0;
+    #if defined(__SSE2__) || defined(__wasm_simd128__)
+    i = points.size() & ~std::size_t(3);
+    transformSimd<true>(matrix, points.data()->data(), out.data()->data(), i);
+    #endif
+    for(; i != points.size(); ++i) out[i] = matrix.transformPoint(points[i]);
+}
+
+void transformPointsInPlace(const Matrix4& matrix, const Containers::ArrayView<Vector3> points) {
+    transformPointsInto(matrix, points, points);
+}
+
+}}
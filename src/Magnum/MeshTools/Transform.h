@@ -26,11 +26,15 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::transformVectorsInPlace(), @ref Magnum::MeshTools::transformVectors(), @ref Magnum::MeshTools::transformPointsInPlace(), @ref Magnum::MeshTools::transformPoints()
+ * @brief Function @ref Magnum::MeshTools::transformVectorsInPlace(), @ref Magnum::MeshTools::transformVectors(), @ref Magnum::MeshTools::transformVectorsInto(), @ref Magnum::MeshTools::transformPointsInPlace(), @ref Magnum::MeshTools::transformPoints(), @ref Magnum::MeshTools::transformPointsInto()
  */
 
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
 #include "Magnum/Math/DualQuaternion.h"
 #include "Magnum/Math/DualComplex.h"
+#include "Magnum/MeshTools/visibility.h"
 
 namespace Magnum { namespace MeshTools {
 
@@ -77,6 +81,26 @@ template<class T, class U> void transformVectorsInPlace(const Math::Matrix4<T>&
     for(auto& vector: vectors) vector = matrix.transformVector(vector);
 }
 
+/**
+@brief Transform an array of vectors using given matrix
+
+Equivalent to calling @ref Matrix4::transformVector() on each element of
+@p vectors and storing the result in @p out, but processes four vectors at a
+time if the library is compiled with SSE2 or WebAssembly SIMD128 support.
+Expects that @p vectors and @p out have the same size. The views are allowed to be the same, in which
+case the transformation is done in-place.
+@see @ref transformPointsInto()
+*/
+MAGNUM_MESHTOOLS_EXPORT void transformVectorsInto(const Matrix4& matrix, Containers::ArrayView<const Vector3> vectors, Containers::ArrayView<Vector3> out);
+
+/**
+@brief Transform an array of vectors in-place using given matrix
+
+Non-templated overload for contiguous arrays, implemented using
+@ref transformVectorsInto().
+*/
+MAGNUM_MESHTOOLS_EXPORT void transformVectorsInPlace(const Matrix4& matrix, Containers::ArrayView<Vector3> vectors);
+
 /**
 @brief Transform vectors using given transformation
 
@@ -132,6 +156,30 @@ template<class T, class U> void transformPointsInPlace(const Math::Matrix4<T>& m
     for(auto& point: points) point = matrix.transformPoint(point);
 }
 
+/**
+@brief Transform an array of points using given matrix
+
+Equivalent to calling @ref Matrix4::transformPoint() on each element of
+@p points and storing the result in @p out, but processes four points at a
+time if the library is compiled with SSE2 or WebAssembly SIMD128 support.
+Expects that @p points and @p out have the same size. The views are allowed to be the same, in which
+case the transformation is done in-place. Example usage:
+@code
+Containers::Array<Vector3> positions;
+MeshTools::transformPointsInto(Matrix4::scaling(Vector3{2.0f}), positions, positions);
+@endcode
+@see @ref transformVectorsInto()
+*/
+MAGNUM_MESHTOOLS_EXPORT void transformPointsInto(const Matrix4& matrix, Containers::ArrayView<const Vector3> points, Containers::ArrayView<Vector3> out);
+
+/**
+@brief Transform an array of points in-place using given matrix
+
+Non-templated overload for contiguous arrays, implemented using
+@ref transformPointsInto().
+*/
+MAGNUM_MESHTOOLS_EXPORT void transformPointsInPlace(const Matrix4& matrix, Containers::ArrayView<Vector3> points);
+
 /**
 @brief Transform points using given transformation
 
@@ -29,7 +29,9 @@
 #include <Corrade/Utility/Assert.h>
 
 #include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/Buffer.h"
 #include "Magnum/Context.h"
+#include "Magnum/Instrumentation.h"
 #include "Magnum/Mesh.h"
 
 #include "Implementation/State.h"
@@ -37,32 +39,77 @@
 
 namespace Magnum {
 
-void MeshView::draw(AbstractShaderProgram& shader, std::initializer_list<std::reference_wrapper<MeshView>> meshes) {
-    /* Why std::initializer_list doesn't have empty()? */
-    if(!meshes.size()) return;
+void MeshView::draw(AbstractShaderProgram& shader, Containers::ArrayView<const std::reference_wrapper<MeshView>> meshes) {
+    if(meshes.empty()) return;
+
+    MAGNUM_INSTRUMENT_ZONE(Instrumentation::Zone::MeshDraw);
 
     shader.use();
 
     #ifndef CORRADE_NO_ASSERT
-    const Mesh* original = &meshes.begin()->get()._original.get();
+    const Mesh* original = &meshes.front().get()._original.get();
     for(MeshView& mesh: meshes)
         CORRADE_ASSERT(&mesh._original.get() == original, "MeshView::draw(): all meshes must be views of the same original mesh", );
     #endif
 
-    #ifndef MAGNUM_TARGET_GLES
-    multiDrawImplementationDefault(meshes);
-    #else
     Context::current().state().mesh->multiDrawImplementation(meshes);
-    #endif
 }
 
+#ifndef MAGNUM_TARGET_GLES
+void MeshView::multiDrawImplementationIndirect(Containers::ArrayView<const std::reference_wrapper<MeshView>> meshes) {
+    CORRADE_INTERNAL_ASSERT(meshes.size());
+
+    Implementation::MeshState& state = *Context::current().state().mesh;
+
+    Mesh& original = meshes.front().get()._original;
+
+    /* Pack the views into indirect draw commands */
+    Containers::Array<char> commands;
+    if(original._indexBuffer) {
+        commands = Containers::Array<char>{meshes.size()*sizeof(Mesh::DrawElementsIndirectCommand)};
+        const auto elementCommands = Containers::arrayCast<Mesh::DrawElementsIndirectCommand>(commands);
+        const std::size_t indexSize = original.indexSize();
+        for(std::size_t i = 0; i != meshes.size(); ++i) {
+            const MeshView& mesh = meshes[i];
+            CORRADE_ASSERT(mesh._indexOffset % indexSize == 0, "MeshView::draw(): index offset must be a multiple of index type size", );
+
+            elementCommands[i].count = mesh._count;
+            elementCommands[i].instanceCount = mesh._instanceCount;
+            elementCommands[i].firstIndex = mesh._indexOffset/indexSize;
+            elementCommands[i].baseVertex = mesh._baseVertex;
+            elementCommands[i].baseInstance = mesh._baseInstance;
+        }
+    } else {
+        commands = Containers::Array<char>{meshes.size()*sizeof(Mesh::DrawArraysIndirectCommand)};
+        const auto arrayCommands = Containers::arrayCast<Mesh::DrawArraysIndirectCommand>(commands);
+        for(std::size_t i = 0; i != meshes.size(); ++i) {
+            const MeshView& mesh = meshes[i];
+            arrayCommands[i].count = mesh._count;
+            arrayCommands[i].instanceCount = mesh._instanceCount;
+            arrayCommands[i].first = mesh._baseVertex;
+            arrayCommands[i].baseInstance = mesh._baseInstance;
+        }
+    }
+
+    /* Upload the commands to a scratch buffer shared by all multi-draw calls
+       and submit them all at once. The buffer is owned by the state, so it
+       gets deleted together with the context. */
+    if(!state.multiDrawIndirectBuffer)
+        state.multiDrawIndirectBuffer = Buffer{Buffer::TargetHint::DrawIndirect}.release();
+    Buffer buffer = Buffer::wrap(state.multiDrawIndirectBuffer, Buffer::TargetHint::DrawIndirect, ObjectFlag::Created);
+    buffer.setData(commands, BufferUsage::StreamDraw);
+
+    original.drawIndirectInternal(buffer, 0, meshes.size(), 0);
+}
+#endif
+
 #ifndef MAGNUM_TARGET_WEBGL
-void MeshView::multiDrawImplementationDefault(std::initializer_list<std::reference_wrapper<MeshView>> meshes) {
+void MeshView::multiDrawImplementationDefault(Containers::ArrayView<const std::reference_wrapper<MeshView>> meshes) {
     CORRADE_INTERNAL_ASSERT(meshes.size());
 
     const Implementation::MeshState& state = *Context::current().state().mesh;
 
-    Mesh& original = meshes.begin()->get()._original;
+    Mesh& original = meshes.front().get()._original;
     Containers::Array<GLsizei> count{meshes.size()};
     Containers::Array<GLvoid*> indices{meshes.size()};
     Containers::Array<GLint> baseVertex{meshes.size()};
@@ -90,6 +137,8 @@ void MeshView::multiDrawImplementationDefault(std::initializer_list<std::referen
         ++i;
     }
 
+    MAGNUM_INSTRUMENT_COUNT(Instrumentation::Counter::DrawCalls, meshes.size());
+
     (original.*state.bindImplementation)();
 
     /* Non-indexed meshes */
@@ -128,7 +177,7 @@ void MeshView::multiDrawImplementationDefault(std::initializer_list<std::referen
 #endif
 
 #ifdef MAGNUM_TARGET_GLES
-void MeshView::multiDrawImplementationFallback(std::initializer_list<std::reference_wrapper<MeshView>> meshes) {
+void MeshView::multiDrawImplementationFallback(Containers::ArrayView<const std::reference_wrapper<MeshView>> meshes) {
     for(MeshView& mesh: meshes) {
         /* Nothing to draw in this mesh */
         if(!mesh._count) continue;
@@ -153,6 +202,8 @@ void MeshView::draw(AbstractShaderProgram& shader) {
     /* Nothing to draw, exit without touching any state */
     if(!_count || !_instanceCount) return;
 
+    MAGNUM_INSTRUMENT_ZONE(Instrumentation::Zone::MeshDraw);
+
     shader.use();
 
     #ifndef MAGNUM_TARGET_GLES
@@ -169,6 +220,8 @@ void MeshView::draw(AbstractShaderProgram& shader, TransformFeedback& xfb, Unsig
     /* Nothing to draw, exit without touching any state */
     if(!_instanceCount) return;
 
+    MAGNUM_INSTRUMENT_ZONE(Instrumentation::Zone::MeshDraw);
+
     shader.use();
 
     _original.get().drawInternal(xfb, stream, _instanceCount);
@@ -31,6 +31,7 @@
 
 #include <functional>
 #include <initializer_list>
+#include <Corrade/Containers/ArrayView.h>
 
 #include "Magnum/Magnum.h"
 #include "Magnum/OpenGL.h"
@@ -63,6 +64,16 @@ class MAGNUM_EXPORT MeshView {
         /**
          * @brief Draw multiple meshes at once
          *
+         * On desktop OpenGL, if @extension{ARB,multi_draw_indirect} (part of
+         * OpenGL 4.3) is available, the views are packed into a buffer of
+         * @ref Mesh::DrawArraysIndirectCommand or
+         * @ref Mesh::DrawElementsIndirectCommand structures and submitted in
+         * a single @fn_gl{MultiDrawArraysIndirect} or
+         * @fn_gl{MultiDrawElementsIndirect} call. In that case the views can
+         * also be instanced. Otherwise @fn_gl{MultiDrawArrays},
+         * @fn_gl{MultiDrawElements} or @fn_gl{MultiDrawElementsBaseVertex}
+         * is used.
+         *
          * In OpenGL ES, if @extension2{EXT,multi_draw_arrays,multi_draw_arrays}
          * is not present, the functionality is emulated using sequence of
          * @ref draw(AbstractShaderProgram&) calls.
@@ -73,18 +84,31 @@ class MAGNUM_EXPORT MeshView {
          * available, the associated vertex array object is bound instead of
          * setting up the mesh from scratch.
          * @attention All meshes must be views of the same original mesh and
-         *      must not be instanced.
-         * @see @ref draw(AbstractShaderProgram&), @fn_gl{UseProgram},
+         *      must not be instanced, unless @extension{ARB,multi_draw_indirect}
+         *      is available.
+         * @see @ref draw(AbstractShaderProgram&),
+         *      @ref Mesh::drawIndirect(), @fn_gl{UseProgram},
          *      @fn_gl{EnableVertexAttribArray}, @fn_gl{BindBuffer},
          *      @fn_gl{VertexAttribPointer}, @fn_gl{DisableVertexAttribArray}
-         *      or @fn_gl{BindVertexArray}, @fn_gl{MultiDrawArrays} or
+         *      or @fn_gl{BindVertexArray}, @fn_gl{MultiDrawArraysIndirect}/
+         *      @fn_gl{MultiDrawElementsIndirect}, @fn_gl{MultiDrawArrays} or
          *      @fn_gl{MultiDrawElements}/@fn_gl{MultiDrawElementsBaseVertex}
          * @requires_gl32 Extension @extension{ARB,draw_elements_base_vertex}
          *      if the mesh is indexed and @ref baseVertex() is not `0`.
          * @requires_gl Specifying base vertex for indexed meshes is not
          *      available in OpenGL ES or WebGL.
          */
-        static void draw(AbstractShaderProgram& shader, std::initializer_list<std::reference_wrapper<MeshView>> meshes);
+        static void draw(AbstractShaderProgram& shader, Containers::ArrayView<const std::reference_wrapper<MeshView>> meshes);
+
+        /** @overload */
+        static void draw(AbstractShaderProgram&& shader, Containers::ArrayView<const std::reference_wrapper<MeshView>> meshes) {
+            draw(shader, meshes);
+        }
+
+        /** @overload */
+        static void draw(AbstractShaderProgram& shader, std::initializer_list<std::reference_wrapper<MeshView>> meshes) {
+            draw(shader, Containers::arrayView(meshes.begin(), meshes.size()));
+        }
 
         /** @overload */
         static void draw(AbstractShaderProgram&& shader, std::initializer_list<std::reference_wrapper<MeshView>> meshes) {
@@ -221,7 +245,7 @@ class MAGNUM_EXPORT MeshView {
          * @brief Draw the mesh
          *
          * See @ref Mesh::draw(AbstractShaderProgram&) for more information.
-         * @see @ref draw(AbstractShaderProgram&, std::initializer_list<std::reference_wrapper<MeshView>>),
+         * @see @ref draw(AbstractShaderProgram&, Containers::ArrayView<const std::reference_wrapper<MeshView>>),
          *      @ref draw(AbstractShaderProgram&, TransformFeedback&, UnsignedInt)
          * @requires_gl32 Extension @extension{ARB,draw_elements_base_vertex}
          *      if the mesh is indexed and @ref baseVertex() is not `0`.
@@ -268,9 +292,12 @@ class MAGNUM_EXPORT MeshView {
 
     private:
         #ifndef MAGNUM_TARGET_WEBGL
-        static MAGNUM_LOCAL void multiDrawImplementationDefault(std::initializer_list<std::reference_wrapper<MeshView>> meshes);
+        static MAGNUM_LOCAL void multiDrawImplementationDefault(Containers::ArrayView<const std::reference_wrapper<MeshView>> meshes);
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        static MAGNUM_LOCAL void multiDrawImplementationIndirect(Containers::ArrayView<const std::reference_wrapper<MeshView>> meshes);
         #endif
-        static MAGNUM_LOCAL void multiDrawImplementationFallback(std::initializer_list<std::reference_wrapper<MeshView>> meshes);
+        static MAGNUM_LOCAL void multiDrawImplementationFallback(Containers::ArrayView<const std::reference_wrapper<MeshView>> meshes);
 
         std::reference_wrapper<Mesh> _original;
 
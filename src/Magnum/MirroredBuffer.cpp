@@ -0,0 +1,133 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MirroredBuffer.h"
+
+#include <cstring>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+namespace Magnum {
+
+MirroredBuffer::MirroredBuffer(const std::size_t size, const BufferUsage usage, const Buffer::TargetHint targetHint): _buffer{targetHint}, _data{Containers::ValueInit, size},
+    #ifndef MAGNUM_TARGET_WEBGL
+    _flushMode{FlushMode::SubData},
+    #else
+    _flushMode{FlushMode::Span},
+    #endif
+    _uploadedBytes{}, _uploadCount{} {
+    _buffer.setData({nullptr, size}, usage);
+}
+
+MirroredBuffer::MirroredBuffer(MirroredBuffer&&) noexcept = default;
+
+MirroredBuffer::~MirroredBuffer() = default;
+
+MirroredBuffer& MirroredBuffer::operator=(MirroredBuffer&&) noexcept = default;
+
+Containers::ArrayView<char> MirroredBuffer::data(const std::size_t offset, const std::size_t size) {
+    CORRADE_ASSERT(offset + size <= _data.size(),
+        "MirroredBuffer::data(): range" << offset << "+" << size << "out of bounds for size" << _data.size(), nullptr);
+    _dirty.add(offset, size);
+    return _data.slice(offset, offset + size);
+}
+
+MirroredBuffer& MirroredBuffer::setSubData(const std::size_t offset, const Containers::ArrayView<const void> data) {
+    CORRADE_ASSERT(offset + data.size() <= _data.size(),
+        "MirroredBuffer::setSubData(): range" << offset << "+" << data.size() << "out of bounds for size" << _data.size(), *this);
+    if(!data.size()) return *this;
+    std::memcpy(_data + offset, data.data(), data.size());
+    _dirty.add(offset, data.size());
+    return *this;
+}
+
+MirroredBuffer& MirroredBuffer::markDirty(const std::size_t offset, const std::size_t size) {
+    CORRADE_ASSERT(offset + size <= _data.size(),
+        "MirroredBuffer::markDirty(): range" << offset << "+" << size << "out of bounds for size" << _data.size(), *this);
+    _dirty.add(offset, size);
+    return *this;
+}
+
+std::size_t MirroredBuffer::flush() {
+    _uploadedBytes = _uploadCount = 0;
+    if(_dirty.isEmpty()) return 0;
+
+    const Containers::ArrayView<const std::pair<std::size_t, std::size_t>> ranges = _dirty.ranges();
+
+    if(_flushMode == FlushMode::Span) {
+        const std::size_t begin = ranges.front().first;
+        const std::size_t end = ranges.back().first + ranges.back().second;
+        _buffer.setSubData(begin, _data.slice(begin, end));
+        _uploadedBytes = end - begin;
+        _uploadCount = 1;
+        _dirty.clear();
+        return _uploadedBytes;
+    }
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(_flushMode == FlushMode::MapRange) {
+        const std::size_t begin = ranges.front().first;
+        const std::size_t end = ranges.back().first + ranges.back().second;
+        char* const mapped = _buffer.map<char>(begin, end - begin, Buffer::MapFlag::Write|Buffer::MapFlag::FlushExplicit);
+        CORRADE_INTERNAL_ASSERT(mapped);
+
+        for(const std::pair<std::size_t, std::size_t>& range: ranges) {
+            std::memcpy(mapped + range.first - begin, _data + range.first, range.second);
+            _buffer.flushMappedRange(range.first - begin, range.second);
+            _uploadedBytes += range.second;
+        }
+
+        CORRADE_INTERNAL_ASSERT_OUTPUT(_buffer.unmap());
+    } else
+    #endif
+    {
+        for(const std::pair<std::size_t, std::size_t>& range: ranges) {
+            _buffer.setSubData(range.first, _data.slice(range.first, range.first + range.second));
+            _uploadedBytes += range.second;
+        }
+    }
+
+    _uploadCount = ranges.size();
+    _dirty.clear();
+    return _uploadedBytes;
+}
+
+Debug& operator<<(Debug& debug, const MirroredBuffer::FlushMode value) {
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case MirroredBuffer::FlushMode::value: return debug << "MirroredBuffer::FlushMode::" #value;
+        _c(SubData)
+        _c(Span)
+        #ifndef MAGNUM_TARGET_WEBGL
+        _c(MapRange)
+        #endif
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "MirroredBuffer::FlushMode(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+}
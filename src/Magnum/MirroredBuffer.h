@@ -0,0 +1,229 @@
+#ifndef Magnum_MirroredBuffer_h
+#define Magnum_MirroredBuffer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::MirroredBuffer
+ */
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/DirtyRegion.h"
+
+namespace Magnum {
+
+/**
+@brief Buffer with a CPU-side mirror
+
+Keeps a copy of the whole @ref Buffer contents in memory and records which
+byte ranges were modified. @ref flush() then uploads only the coalesced
+dirty ranges instead of the whole buffer, which is useful for data that
+change a little every frame, such as UI vertex data.
+@code
+MirroredBuffer vertices{1024*sizeof(Vector2)};
+
+// each frame
+vertices.setSubData(quadOffset, quadVertices);
+Containers::ArrayView<char> color = vertices.data(colorOffset, sizeof(Color4));
+*reinterpret_cast<Color4*>(color.data()) = highlightColor;
+vertices.flush();
+@endcode
+
+Use @ref dirtyRanges() to configure how eagerly the ranges are merged and
+@ref uploadedBytes() to check how much data was actually transferred.
+
+@section MirroredBuffer-flush-mode Flush mode
+
+By default each dirty range is uploaded with a separate
+@ref Buffer::setSubData() call. With @ref FlushMode::MapRange the buffer is
+instead mapped once over the span of all dirty ranges using
+@ref Buffer::MapFlag::FlushExplicit, the ranges are copied in and flushed
+with @ref Buffer::flushMappedRange(). That is preferable when there are many
+small ranges.
+
+On WebGL, where every @ref Buffer::setSubData() call crosses from WebAssembly
+to JavaScript and creates a new heap view, @ref FlushMode::Span is used by
+default. It uploads the whole span from the first to the last dirty byte in a
+single call straight from the mirror, including the untouched bytes in
+between --- these are still valid, because the mirror holds the complete
+buffer contents.
+*/
+class MAGNUM_EXPORT MirroredBuffer {
+    public:
+        /**
+         * @brief Flush mode
+         *
+         * @see @ref setFlushMode()
+         */
+        enum class FlushMode: UnsignedByte {
+            /** Upload each dirty range with @ref Buffer::setSubData() */
+            SubData,
+
+            /**
+             * Upload the span of all dirty ranges, including the unmodified
+             * bytes between them, with a single @ref Buffer::setSubData()
+             * call. Default on WebGL.
+             */
+            Span,
+
+            #ifndef MAGNUM_TARGET_WEBGL
+            /**
+             * Map the span of all dirty ranges with
+             * @ref Buffer::MapFlag::FlushExplicit and flush each range with
+             * @ref Buffer::flushMappedRange()
+             * @requires_gl30 Extension @extension{ARB,map_buffer_range}
+             * @requires_gles30 Extension @extension{EXT,map_buffer_range} in
+             *      OpenGL ES 2.0.
+             * @requires_gles Buffer mapping is not available in WebGL.
+             */
+            MapRange
+            #endif
+        };
+
+        /**
+         * @brief Constructor
+         * @param size          Buffer size in bytes
+         * @param usage         Buffer usage
+         * @param targetHint    Target hint for the underlying buffer
+         *
+         * Allocates zero-initialized memory of given size and the buffer
+         * data with @ref Buffer::setData(). No upload is done.
+         */
+        explicit MirroredBuffer(std::size_t size, BufferUsage usage = BufferUsage::DynamicDraw, Buffer::TargetHint targetHint = Buffer::TargetHint::Array);
+
+        /** @brief Copying is not allowed */
+        MirroredBuffer(const MirroredBuffer&) = delete;
+
+        /** @brief Move constructor */
+        MirroredBuffer(MirroredBuffer&&) noexcept;
+
+        ~MirroredBuffer();
+
+        /** @brief Copying is not allowed */
+        MirroredBuffer& operator=(const MirroredBuffer&) = delete;
+
+        /** @brief Move assignment */
+        MirroredBuffer& operator=(MirroredBuffer&&) noexcept;
+
+        /**
+         * @brief Underlying buffer
+         *
+         * Don't modify the buffer contents directly, the changes would get
+         * overwritten by next @ref flush().
+         */
+        Buffer& buffer() { return _buffer; }
+
+        /** @brief Buffer size in bytes */
+        std::size_t size() const { return _data.size(); }
+
+        /** @brief Mirrored data */
+        Containers::ArrayView<const char> data() const { return _data; }
+
+        /**
+         * @brief Mirrored data range for modification
+         *
+         * Marks given range as dirty and returns a view on it. Expects that
+         * the range is in bounds.
+         */
+        Containers::ArrayView<char> data(std::size_t offset, std::size_t size);
+
+        /**
+         * @brief Set data subrange
+         * @return Reference to self (for method chaining)
+         *
+         * Copies @p data into the mirror at given offset and marks the range
+         * as dirty. Expects that the range is in bounds.
+         */
+        MirroredBuffer& setSubData(std::size_t offset, Containers::ArrayView<const void> data);
+
+        /**
+         * @brief Mark a range as dirty
+         * @return Reference to self (for method chaining)
+         *
+         * Use in case the mirror is modified through a view obtained earlier.
+         * Expects that the range is in bounds.
+         */
+        MirroredBuffer& markDirty(std::size_t offset, std::size_t size);
+
+        /**
+         * @brief Dirty ranges
+         *
+         * Ranges modified since last @ref flush().
+         */
+        DirtyRanges& dirtyRanges() { return _dirty; }
+
+        /** @brief Flush mode */
+        FlushMode flushMode() const { return _flushMode; }
+
+        /**
+         * @brief Set flush mode
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @ref FlushMode::Span on WebGL and
+         * @ref FlushMode::SubData elsewhere.
+         */
+        MirroredBuffer& setFlushMode(FlushMode mode) {
+            _flushMode = mode;
+            return *this;
+        }
+
+        /**
+         * @brief Upload the dirty ranges
+         * @return Count of bytes uploaded
+         *
+         * Does nothing if there are no dirty ranges. Clears the dirty ranges
+         * afterwards.
+         * @see @ref uploadedBytes(), @ref uploadCount()
+         */
+        std::size_t flush();
+
+        /** @brief Count of bytes uploaded by last @ref flush() */
+        std::size_t uploadedBytes() const { return _uploadedBytes; }
+
+        /**
+         * @brief Count of uploaded ranges in last @ref flush()
+         *
+         * With @ref FlushMode::SubData this is the count of
+         * @ref Buffer::setSubData() calls, with @ref FlushMode::Span it's
+         * always `1` if anything was uploaded.
+         */
+        std::size_t uploadCount() const { return _uploadCount; }
+
+    private:
+        Buffer _buffer;
+        Containers::Array<char> _data;
+        DirtyRanges _dirty;
+        FlushMode _flushMode;
+        std::size_t _uploadedBytes, _uploadCount;
+};
+
+/** @debugoperatorclassenum{Magnum::MirroredBuffer,Magnum::MirroredBuffer::FlushMode} */
+MAGNUM_EXPORT Debug& operator<<(Debug& debug, MirroredBuffer::FlushMode value);
+
+}
+
+#endif
@@ -0,0 +1,113 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MirroredTexture.h"
+
+#include <cstring>
+#include <tuple>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+
+namespace Magnum {
+
+MirroredTexture2D::MirroredTexture2D(const TextureFormat internalFormat, const PixelFormat format, const PixelType type, const Vector2i& size): _image{format, type, size, Containers::Array<char>{Containers::ValueInit, Implementation::imageDataSizeFor(format, type, size)}}, _uploadedBytes{}, _uploadCount{} {
+    _texture.setStorage(1, internalFormat, size);
+    _dirty.add({{}, size});
+}
+
+MirroredTexture2D::MirroredTexture2D(MirroredTexture2D&&) noexcept = default;
+
+MirroredTexture2D::~MirroredTexture2D() = default;
+
+MirroredTexture2D& MirroredTexture2D::operator=(MirroredTexture2D&&) noexcept = default;
+
+MirroredTexture2D& MirroredTexture2D::setSubImage(const Vector2i& offset, const ImageView2D& image) {
+    CORRADE_ASSERT(image.format() == _image.format() && image.type() == _image.type(),
+        "MirroredTexture2D::setSubImage(): expected" << _image.format() << _image.type() << "but got" << image.format() << image.type(), *this);
+    CORRADE_ASSERT((offset >= Vector2i{}).all() && (offset + image.size() <= _image.size()).all(),
+        "MirroredTexture2D::setSubImage(): image of size" << image.size() << "at offset" << offset << "out of bounds for size" << _image.size(), *this);
+    if(!image.size().product()) return *this;
+
+    const std::size_t pixelSize = _image.pixelSize();
+    const std::size_t rowSize = pixelSize*image.size().x();
+    const std::size_t dstStride = std::get<1>(_image.dataProperties()).x();
+    const std::tuple<Math::Vector2<std::size_t>, Math::Vector2<std::size_t>, std::size_t> srcProperties = image.dataProperties();
+    const std::size_t srcStride = std::get<1>(srcProperties).x();
+    const char* src = image.data() + std::get<0>(srcProperties).sum();
+    char* dst = _image.data() + offset.y()*dstStride + offset.x()*pixelSize;
+    for(Int y = 0; y != image.size().y(); ++y, src += srcStride, dst += dstStride)
+        std::memcpy(dst, src, rowSize);
+
+    _dirty.add({offset, offset + image.size()});
+    return *this;
+}
+
+MirroredTexture2D& MirroredTexture2D::markDirty(const Range2Di& rectangle) {
+    CORRADE_ASSERT((rectangle.min() >= Vector2i{}).all() && (rectangle.max() <= _image.size()).all(),
+        "MirroredTexture2D::markDirty(): rectangle" << rectangle << "out of bounds for size" << _image.size(), *this);
+    _dirty.add(rectangle);
+    return *this;
+}
+
+std::size_t MirroredTexture2D::flush() {
+    _uploadedBytes = _uploadCount = 0;
+    if(_dirty.isEmpty()) return 0;
+
+    /* Without row length the uploaded rows have to span the whole image
+       width. Re-adding the widened rectangles coalesces the ones that now
+       overlap. */
+    #ifdef MAGNUM_TARGET_GLES2
+    {
+        const std::vector<Range2Di> rectangles{_dirty.rectangles().begin(), _dirty.rectangles().end()};
+        _dirty.clear();
+        for(const Range2Di& rectangle: rectangles)
+            _dirty.add({{0, rectangle.bottom()}, {_image.size().x(), rectangle.top()}});
+    }
+    #endif
+
+    const std::size_t pixelSize = _image.pixelSize();
+    for(const Range2Di& rectangle: _dirty.rectangles()) {
+        PixelStorage storage;
+        storage.setAlignment(_image.storage().alignment())
+            #ifndef MAGNUM_TARGET_GLES2
+            .setRowLength(_image.size().x())
+            #endif
+            .setSkip({rectangle.min(), 0});
+
+        /* The view spans from the start of the mirror, as the skip is
+           applied on top of the data pointer */
+        _texture.setSubImage(0, rectangle.min(), ImageView2D{storage, _image.format(), _image.type(), rectangle.size(), _image.data()});
+        _uploadedBytes += rectangle.size().product()*pixelSize;
+        ++_uploadCount;
+    }
+
+    _dirty.clear();
+    return _uploadedBytes;
+}
+
+}
@@ -0,0 +1,168 @@
+#ifndef Magnum_MirroredTexture_h
+#define Magnum_MirroredTexture_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::MirroredTexture2D
+ */
+
+#include "Magnum/DirtyRegion.h"
+#include "Magnum/Image.h"
+#include "Magnum/Texture.h"
+
+namespace Magnum {
+
+/**
+@brief Two-dimensional texture with a CPU-side mirror
+
+Keeps a copy of the texture base level in an @ref Image2D and records which
+rectangles were modified. @ref flush() then uploads only the coalesced dirty
+rectangles with @ref Texture::setSubImage() instead of the whole image, which
+is useful for textures that change a little every frame, such as glyph
+caches or UI atlases.
+@code
+MirroredTexture2D atlas{TextureFormat::R8, PixelFormat::Red, PixelType::UnsignedByte, {1024, 1024}};
+atlas.texture().setMinificationFilter(Sampler::Filter::Linear);
+
+// each frame
+atlas.setSubImage(glyphOffset, glyphImage);
+atlas.flush();
+@endcode
+
+The rectangles are uploaded directly from the mirror using
+@ref PixelStorage::setRowLength() and @ref PixelStorage::setSkip(), so no
+intermediate copy is made. Row length specification is not available on
+OpenGL ES 2.0 and WebGL 1.0, there the dirty rectangles are extended to the
+full image width instead.
+
+Use @ref dirtyRectangles() to configure how eagerly the rectangles are merged
+and @ref uploadedBytes() to check how much data was actually transferred.
+@see @ref MirroredBuffer
+*/
+class MAGNUM_EXPORT MirroredTexture2D {
+    public:
+        /**
+         * @brief Constructor
+         * @param internalFormat    Internal texture format
+         * @param format            Format of pixel data in the mirror
+         * @param type              Data type of pixel data in the mirror
+         * @param size              Texture size
+         *
+         * Allocates zero-initialized mirror and texture storage with one
+         * level using @ref Texture::setStorage(). The whole texture is marked
+         * as dirty, so the first @ref flush() uploads the initial contents.
+         */
+        explicit MirroredTexture2D(TextureFormat internalFormat, PixelFormat format, PixelType type, const Vector2i& size);
+
+        /** @brief Copying is not allowed */
+        MirroredTexture2D(const MirroredTexture2D&) = delete;
+
+        /** @brief Move constructor */
+        MirroredTexture2D(MirroredTexture2D&&) noexcept;
+
+        ~MirroredTexture2D();
+
+        /** @brief Copying is not allowed */
+        MirroredTexture2D& operator=(const MirroredTexture2D&) = delete;
+
+        /** @brief Move assignment */
+        MirroredTexture2D& operator=(MirroredTexture2D&&) noexcept;
+
+        /**
+         * @brief Underlying texture
+         *
+         * Don't modify the texture contents directly, the changes would get
+         * overwritten by next @ref flush().
+         */
+        Texture2D& texture() { return _texture; }
+
+        /** @brief Texture size */
+        Vector2i size() const { return _image.size(); }
+
+        /** @brief Mirrored image */
+        const Image2D& image() const { return _image; }
+
+        /**
+         * @brief Mirrored pixel data for modification
+         *
+         * Doesn't mark anything as dirty, call @ref markDirty() after
+         * modifying the data. Rows are aligned to four bytes.
+         */
+        Containers::ArrayView<char> data() { return _image.data(); }
+
+        /**
+         * @brief Set image subdata
+         * @return Reference to self (for method chaining)
+         *
+         * Copies @p image into the mirror at given offset and marks the
+         * rectangle as dirty. Expects that the image has the same format and
+         * type as the mirror and that it fits into the texture.
+         */
+        MirroredTexture2D& setSubImage(const Vector2i& offset, const ImageView2D& image);
+
+        /**
+         * @brief Mark a rectangle as dirty
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that the rectangle is in bounds.
+         */
+        MirroredTexture2D& markDirty(const Range2Di& rectangle);
+
+        /**
+         * @brief Dirty rectangles
+         *
+         * Rectangles modified since last @ref flush().
+         */
+        DirtyRectangles& dirtyRectangles() { return _dirty; }
+
+        /**
+         * @brief Upload the dirty rectangles
+         * @return Count of bytes uploaded
+         *
+         * Does nothing if there are no dirty rectangles. Clears the dirty
+         * rectangles afterwards.
+         * @see @ref uploadedBytes(), @ref uploadCount()
+         */
+        std::size_t flush();
+
+        /** @brief Count of bytes uploaded by last @ref flush() */
+        std::size_t uploadedBytes() const { return _uploadedBytes; }
+
+        /**
+         * @brief Count of @ref Texture::setSubImage() calls in last @ref flush()
+         */
+        std::size_t uploadCount() const { return _uploadCount; }
+
+    private:
+        Texture2D _texture;
+        Image2D _image;
+        DirtyRectangles _dirty;
+        std::size_t _uploadedBytes, _uploadCount;
+};
+
+}
+
+#endif
@@ -0,0 +1,47 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ParticleEmitter.h"
+
+#include "Magnum/Particles/ParticleSystem.h"
+
+namespace Magnum { namespace Particles {
+
+ParticleEmitter::ParticleEmitter(SceneGraph::AbstractObject3D& object, ParticleSystem& system, const UnsignedInt count, const Float lifetime): SceneGraph::AbstractFeature3D{object}, _system{&system}, _count{count}, _enabled{true}, _lifetime{lifetime}, _radius{0.0f}, _velocitySpread{0.0f} {
+    _offset = system.add(*this, count, lifetime);
+}
+
+ParticleEmitter::~ParticleEmitter() {
+    if(_system) _system->remove(*this);
+}
+
+ParticleEmitter& ParticleEmitter::setLifetime(const Float min, const Float max) {
+    CORRADE_ASSERT(min > 0.0f && min <= max,
+        "Particles::ParticleEmitter::setLifetime(): expected positive lifetime range, got" << min << max, *this);
+    _lifetime = {min, max};
+    return *this;
+}
+
+}}
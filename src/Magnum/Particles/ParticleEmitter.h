@@ -0,0 +1,181 @@
+#ifndef Magnum_Particles_ParticleEmitter_h
+#define Magnum_Particles_ParticleEmitter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Particles::ParticleEmitter
+ */
+
+#include "Magnum/configure.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Particles/Particles.h"
+#include "Magnum/Particles/visibility.h"
+#include "Magnum/SceneGraph/AbstractFeature.h"
+
+namespace Magnum { namespace Particles {
+
+/**
+@brief Particle emitter
+
+Feature spawning particles of a @ref ParticleSystem at the position of its
+object. The emitter owns @ref count() particles of the system. Each is
+respawned right after it dies, so in a steady state the emitter spawns
+@ref count() divided by average lifetime particles per second. Particles
+get a random position in a sphere of @ref radius() around the object origin
+and velocity given by @ref velocity() with a random deviation of
+@ref velocitySpread(), both transformed by the absolute object
+transformation at the time of spawning. See @ref ParticleSystem for an
+usage example.
+
+The initial particles are spread over the first lifetime to avoid spawning
+them all at once.
+@requires_gl30 Extension @extension{EXT,transform_feedback}
+@requires_gles30 Transform feedback is not available in OpenGL ES 2.0.
+@requires_webgl20 Transform feedback is not available in WebGL 1.0.
+*/
+class MAGNUM_PARTICLES_EXPORT ParticleEmitter: public SceneGraph::AbstractFeature3D {
+    friend ParticleSystem;
+
+    public:
+        /**
+         * @brief Constructor
+         * @param object    Object to attach the emitter to
+         * @param system    Particle system
+         * @param count     Count of particles owned by the emitter
+         * @param lifetime  Particle lifetime in seconds
+         *
+         * Expects that the system has enough free capacity. The emitter is
+         * automatically added to object's features.
+         */
+        explicit ParticleEmitter(SceneGraph::AbstractObject3D& object, ParticleSystem& system, UnsignedInt count, Float lifetime = 1.0f);
+
+        /**
+         * @brief Destructor
+         *
+         * Kills all particles of the emitter and removes it from the
+         * system.
+         */
+        ~ParticleEmitter();
+
+        /** @brief Particle system */
+        ParticleSystem& system() { return *_system; }
+        const ParticleSystem& system() const { return *_system; } /**< @overload */
+
+        /** @brief Offset of the particle range in the system buffer */
+        UnsignedInt offset() const { return _offset; }
+
+        /** @brief Count of particles owned by the emitter */
+        UnsignedInt count() const { return _count; }
+
+        /** @brief Whether the emitter is enabled */
+        bool isEnabled() const { return _enabled; }
+
+        /**
+         * @brief Enable or disable the emitter
+         * @return Reference to self (for method chaining)
+         *
+         * Particles of disabled emitter are still simulated, but they are not
+         * respawned after they die. Enabled by default.
+         */
+        ParticleEmitter& setEnabled(bool enabled) {
+            _enabled = enabled;
+            return *this;
+        }
+
+        /** @brief Particle lifetime range */
+        Vector2 lifetime() const { return _lifetime; }
+
+        /**
+         * @brief Set particle lifetime range
+         * @return Reference to self (for method chaining)
+         *
+         * Each spawned particle gets a random lifetime between @p min and
+         * @p max seconds. Default is the lifetime passed to the constructor.
+         */
+        ParticleEmitter& setLifetime(Float min, Float max);
+
+        /** @brief Spawn radius */
+        Float radius() const { return _radius; }
+
+        /**
+         * @brief Set spawn radius
+         * @return Reference to self (for method chaining)
+         *
+         * Radius of a sphere in object local space. Default is `0.0f`.
+         */
+        ParticleEmitter& setRadius(Float radius) {
+            _radius = radius;
+            return *this;
+        }
+
+        /** @brief Initial particle velocity */
+        Vector3 velocity() const { return _velocity; }
+
+        /**
+         * @brief Set initial particle velocity
+         * @return Reference to self (for method chaining)
+         *
+         * In object local space. Default is zero vector.
+         */
+        ParticleEmitter& setVelocity(const Vector3& velocity) {
+            _velocity = velocity;
+            return *this;
+        }
+
+        /** @brief Initial particle velocity spread */
+        Float velocitySpread() const { return _velocitySpread; }
+
+        /**
+         * @brief Set initial particle velocity spread
+         * @return Reference to self (for method chaining)
+         *
+         * Max length of a random vector added to @ref velocity(). Default is
+         * `0.0f`.
+         */
+        ParticleEmitter& setVelocitySpread(Float spread) {
+            _velocitySpread = spread;
+            return *this;
+        }
+
+    private:
+        ParticleSystem* _system;
+        UnsignedInt _offset, _count;
+        bool _enabled;
+        Vector2 _lifetime;
+        Float _radius;
+        Vector3 _velocity;
+        Float _velocitySpread;
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 build
+#endif
+
+#endif
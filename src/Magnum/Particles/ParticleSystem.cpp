@@ -0,0 +1,283 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ParticleSystem.h"
+
+#include <algorithm>
+#include <Corrade/Utility/Resource.h>
+
+#include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/MeshView.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/Shader.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Particles/ParticleEmitter.h"
+#include "Magnum/SceneGraph/AbstractObject.h"
+#include "Magnum/Shaders/ParticleBillboard.h"
+#include "Magnum/Shaders/Implementation/CreateCompatibilityShader.h"
+
+#ifdef MAGNUM_BUILD_STATIC
+static void importParticleResources() {
+    CORRADE_RESOURCE_INITIALIZE(MagnumParticles_RCS)
+}
+#endif
+
+namespace Magnum { namespace Particles {
+
+namespace Implementation {
+
+class ParticleUpdateShader: public AbstractShaderProgram {
+    public:
+        typedef Attribute<0, Vector4> PositionAge;
+        typedef Attribute<1, Vector4> VelocityLifetime;
+
+        explicit ParticleUpdateShader();
+
+        ParticleUpdateShader& setEmitterTransformationMatrix(const Matrix4& matrix) {
+            setUniform(_emitterTransformationMatrixUniform, matrix);
+            return *this;
+        }
+
+        ParticleUpdateShader& setEmitterVelocity(const Vector3& velocity) {
+            setUniform(_emitterVelocityUniform, velocity);
+            return *this;
+        }
+
+        ParticleUpdateShader& setEmitterVelocitySpread(Float spread) {
+            setUniform(_emitterVelocitySpreadUniform, spread);
+            return *this;
+        }
+
+        ParticleUpdateShader& setEmitterRadius(Float radius) {
+            setUniform(_emitterRadiusUniform, radius);
+            return *this;
+        }
+
+        ParticleUpdateShader& setEmitterLifetime(const Vector2& lifetime) {
+            setUniform(_emitterLifetimeUniform, lifetime);
+            return *this;
+        }
+
+        ParticleUpdateShader& setEmitterEnabled(bool enabled) {
+            setUniform(_emitterEnabledUniform, Int(enabled));
+            return *this;
+        }
+
+        ParticleUpdateShader& setAcceleration(const Vector3& acceleration) {
+            setUniform(_accelerationUniform, acceleration);
+            return *this;
+        }
+
+        ParticleUpdateShader& setTimeDelta(Float timeDelta) {
+            setUniform(_timeDeltaUniform, timeDelta);
+            return *this;
+        }
+
+        ParticleUpdateShader& setSeed(UnsignedInt seed) {
+            setUniform(_seedUniform, seed);
+            return *this;
+        }
+
+    private:
+        Int _emitterTransformationMatrixUniform{0},
+            _emitterVelocityUniform{1},
+            _emitterVelocitySpreadUniform{2},
+            _emitterRadiusUniform{3},
+            _emitterLifetimeUniform{4},
+            _emitterEnabledUniform{5},
+            _accelerationUniform{6},
+            _timeDeltaUniform{7},
+            _seedUniform{8};
+};
+
+ParticleUpdateShader::ParticleUpdateShader() {
+    #ifndef MAGNUM_TARGET_GLES
+    MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::EXT::transform_feedback);
+    #endif
+
+    #ifdef MAGNUM_BUILD_STATIC
+    /* Import resources on static build, if not already */
+    if(!Utility::Resource::hasGroup("MagnumParticles"))
+        importParticleResources();
+    #endif
+    Utility::Resource rs("MagnumParticles");
+
+    #ifndef MAGNUM_TARGET_GLES
+    const Version version = Context::current().supportedVersion({Version::GL330, Version::GL300});
+    #else
+    const Version version = Context::current().supportedVersion({Version::GLES300});
+    #endif
+
+    Shader vert = Shaders::Implementation::createCompatibilityShader(rs, version, Shader::Type::Vertex);
+    vert.addSource(rs.get("ParticleUpdateShader.vert"));
+
+    /* In OpenGL ES a fragment shader is required even with rasterizer
+       discard */
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert}));
+    attachShader(vert);
+    #else
+    Shader frag = Shaders::Implementation::createCompatibilityShader(rs, version, Shader::Type::Fragment);
+    frag.addSource(rs.get("ParticleUpdateShader.frag"));
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, frag}));
+    attachShaders({vert, frag});
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_attrib_location>(version))
+    {
+        bindAttributeLocation(PositionAge::Location, "positionAge");
+        bindAttributeLocation(VelocityLifetime::Location, "velocityLifetime");
+    }
+    #endif
+
+    /* The outputs are interleaved in the same layout as the inputs */
+    setTransformFeedbackOutputs({"outPositionAge", "outVelocityLifetime"},
+        TransformFeedbackBufferMode::InterleavedAttributes);
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_uniform_location>(version))
+    #endif
+    {
+        _emitterTransformationMatrixUniform = uniformLocation("emitterTransformationMatrix");
+        _emitterVelocityUniform = uniformLocation("emitterVelocity");
+        _emitterVelocitySpreadUniform = uniformLocation("emitterVelocitySpread");
+        _emitterRadiusUniform = uniformLocation("emitterRadius");
+        _emitterLifetimeUniform = uniformLocation("emitterLifetime");
+        _emitterEnabledUniform = uniformLocation("emitterEnabled");
+        _accelerationUniform = uniformLocation("acceleration");
+        _timeDeltaUniform = uniformLocation("timeDelta");
+        _seedUniform = uniformLocation("seed");
+    }
+}
+
+}
+
+ParticleSystem::ParticleSystem(const UnsignedInt capacity): _capacity{capacity}, _count{0}, _current{0}, _seed{0}, _shader{new Implementation::ParticleUpdateShader} {
+    /* Zero-initialized particles have zero age and lifetime, i.e. are dead */
+    const std::vector<Particle> dead(capacity, Particle{});
+    for(std::size_t i = 0; i != 2; ++i) {
+        _buffers[i].setData(dead, BufferUsage::DynamicCopy);
+
+        _updateMeshes[i].setPrimitive(MeshPrimitive::Points)
+            .addVertexBuffer(_buffers[i], 0,
+                Implementation::ParticleUpdateShader::PositionAge{},
+                Implementation::ParticleUpdateShader::VelocityLifetime{});
+
+        _drawMeshes[i].setPrimitive(MeshPrimitive::Points)
+            .addVertexBuffer(_buffers[i], 0,
+                Shaders::ParticleBillboard::Position{},
+                Shaders::ParticleBillboard::Age{},
+                sizeof(Vector3),
+                Shaders::ParticleBillboard::Lifetime{});
+    }
+}
+
+ParticleSystem::ParticleSystem(NoCreateT) noexcept: _capacity{0}, _count{0}, _current{0}, _seed{0}, _buffers{Buffer{NoCreate}, Buffer{NoCreate}}, _updateMeshes{Mesh{NoCreate}, Mesh{NoCreate}}, _drawMeshes{Mesh{NoCreate}, Mesh{NoCreate}}, _feedback{NoCreate} {}
+
+ParticleSystem::~ParticleSystem() {
+    /* Detach remaining emitters so they don't access a dead system */
+    for(ParticleEmitter* emitter: _emitters) emitter->_system = nullptr;
+}
+
+ParticleSystem& ParticleSystem::update(const Float timeDelta) {
+    if(_emitters.empty()) return *this;
+
+    Buffer& destination = _buffers[_current ^ 1];
+
+    _shader->setAcceleration(_acceleration)
+        .setTimeDelta(timeDelta)
+        .setSeed(_seed++);
+
+    Renderer::enable(Renderer::Feature::RasterizerDiscard);
+
+    for(ParticleEmitter* emitter: _emitters) {
+        _shader->setEmitterTransformationMatrix(emitter->object().absoluteTransformationMatrix())
+            .setEmitterVelocity(emitter->_velocity)
+            .setEmitterVelocitySpread(emitter->_velocitySpread)
+            .setEmitterRadius(emitter->_radius)
+            .setEmitterLifetime(emitter->_lifetime)
+            .setEmitterEnabled(emitter->_enabled);
+
+        _feedback.attachBuffer(0, destination, emitter->_offset*sizeof(Particle), emitter->_count*sizeof(Particle));
+
+        MeshView view{_updateMeshes[_current]};
+        view.setCount(emitter->_count)
+            .setBaseVertex(emitter->_offset);
+
+        _feedback.begin(*_shader, TransformFeedback::PrimitiveMode::Points);
+        view.draw(*_shader);
+        _feedback.end();
+    }
+
+    Renderer::disable(Renderer::Feature::RasterizerDiscard);
+
+    _current ^= 1;
+    return *this;
+}
+
+ParticleSystem& ParticleSystem::draw(Shaders::ParticleBillboard& shader) {
+    _drawMeshes[_current].draw(shader);
+    return *this;
+}
+
+UnsignedInt ParticleSystem::add(ParticleEmitter& emitter, const UnsignedInt count, const Float lifetime) {
+    CORRADE_ASSERT(_count + count <= _capacity,
+        "Particles::ParticleEmitter: can't add" << count << "particles to a system with" << _capacity - _count << "free particles", 0);
+
+    /* Spread the initial spawns over the first lifetime, the particles have
+       zero lifetime so they get spawned right after their age gets
+       positive */
+    std::vector<Particle> pending(count, Particle{});
+    for(std::size_t i = 0; i != count; ++i)
+        pending[i].age = -lifetime*Float(i)/Float(count);
+
+    const UnsignedInt offset = _count;
+    fill(offset, pending);
+    _count += count;
+    _emitters.push_back(&emitter);
+    for(Mesh& mesh: _drawMeshes) mesh.setCount(_count);
+    return offset;
+}
+
+void ParticleSystem::remove(ParticleEmitter& emitter) {
+    /* The range is not reused, just kill the particles so they are not drawn */
+    const auto found = std::find(_emitters.begin(), _emitters.end(), &emitter);
+    if(found == _emitters.end()) return;
+
+    fill(emitter._offset, std::vector<Particle>(emitter._count, Particle{}));
+    _emitters.erase(found);
+}
+
+void ParticleSystem::fill(const UnsignedInt offset, const std::vector<Particle>& particles) {
+    for(Buffer& buffer: _buffers)
+        buffer.setSubData(offset*sizeof(Particle), particles);
+}
+
+}}
@@ -0,0 +1,240 @@
+#ifndef Magnum_Particles_ParticleSystem_h
+#define Magnum_Particles_ParticleSystem_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Particles::ParticleSystem, struct @ref Magnum::Particles::Particle
+ */
+
+#include "Magnum/configure.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+#include <memory>
+#include <vector>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/TransformFeedback.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Particles/Particles.h"
+#include "Magnum/Particles/visibility.h"
+#include "Magnum/Shaders/Shaders.h"
+
+namespace Magnum { namespace Particles {
+
+namespace Implementation { class ParticleUpdateShader; }
+
+/**
+@brief Particle
+
+Layout of a single particle in @ref ParticleSystem::buffer(). Particles with
+negative @ref age are waiting to be spawned, particles with @ref age larger or
+equal to @ref lifetime are dead.
+*/
+struct Particle {
+    /** @brief Position in world space */
+    Vector3 position;
+
+    /** @brief Age in seconds */
+    Float age;
+
+    /** @brief Velocity in world space */
+    Vector3 velocity;
+
+    /** @brief Lifetime in seconds */
+    Float lifetime;
+};
+
+/**
+@brief GPU particle system
+
+Stores particles in two vertex buffers and each @ref update() simulates them
+from one buffer to the other using @ref TransformFeedback. Particles are
+spawned by @ref ParticleEmitter features attached to scene objects --- each
+emitter owns a fixed range of particles and dead particles in the range are
+respawned at the emitter position directly in the update shader, so once
+the emitters are created, spawning, simulation and drawing are done without
+any data going through the CPU.
+
+## Example usage
+
+@code
+Particles::ParticleSystem particles{100000};
+particles.setAcceleration({0.0f, -9.81f, 0.0f});
+
+Object3D fountain{&scene};
+(new Particles::ParticleEmitter{fountain, particles, 50000, 2.0f})
+    ->setVelocity({0.0f, 8.0f, 0.0f})
+    .setVelocitySpread(1.5f);
+
+// each frame
+particles.update(timeline.previousFrameDuration());
+
+Shaders::ParticleBillboard shader;
+shader.setTransformationMatrix(camera.cameraMatrix())
+    .setProjectionMatrix(camera.projectionMatrix())
+    .setViewportSize(Vector2{camera.viewport()})
+    .setSize(0.05f);
+particles.draw(shader);
+@endcode
+
+See @ref Shaders::ParticleBillboard for required renderer setup.
+
+@anchor Particles-ParticleSystem-particle-ranges
+## Particle ranges
+
+Particles are assigned to emitters in order of their creation. Removing an
+emitter kills all its particles, but its range is not reused for emitters
+created later. The system is expected to outlive all its emitters.
+
+@requires_gl30 Extension @extension{EXT,transform_feedback}
+@requires_gles30 Transform feedback is not available in OpenGL ES 2.0.
+@requires_webgl20 Transform feedback is not available in WebGL 1.0.
+*/
+class MAGNUM_PARTICLES_EXPORT ParticleSystem {
+    friend ParticleEmitter;
+
+    public:
+        /**
+         * @brief Constructor
+         * @param capacity  Max count of particles in all emitters
+         */
+        explicit ParticleSystem(UnsignedInt capacity);
+
+        /**
+         * @brief Construct without creating the underlying OpenGL objects
+         *
+         * The constructed instance can't be used for anything. Useful in
+         * cases where you will overwrite the instance later anyway.
+         *
+         * This function can be safely used for constructing (and later
+         * destructing) objects even without any OpenGL context being active.
+         */
+        explicit ParticleSystem(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        ParticleSystem(const ParticleSystem&) = delete;
+
+        /** @brief Moving is not allowed, emitters reference the system */
+        ParticleSystem(ParticleSystem&&) = delete;
+
+        ~ParticleSystem();
+
+        /** @brief Copying is not allowed */
+        ParticleSystem& operator=(const ParticleSystem&) = delete;
+
+        /** @brief Moving is not allowed, emitters reference the system */
+        ParticleSystem& operator=(ParticleSystem&&) = delete;
+
+        /** @brief Max count of particles */
+        UnsignedInt capacity() const { return _capacity; }
+
+        /**
+         * @brief Count of particles assigned to emitters
+         *
+         * Includes also ranges of removed emitters, see
+         * @ref Particles-ParticleSystem-particle-ranges "class documentation" for more
+         * information.
+         */
+        UnsignedInt count() const { return _count; }
+
+        /** @brief Emitters */
+        const std::vector<ParticleEmitter*>& emitters() const { return _emitters; }
+
+        /** @brief Acceleration */
+        Vector3 acceleration() const { return _acceleration; }
+
+        /**
+         * @brief Set acceleration
+         * @return Reference to self (for method chaining)
+         *
+         * Applied to all particles, such as gravity. Default is zero vector.
+         */
+        ParticleSystem& setAcceleration(const Vector3& acceleration) {
+            _acceleration = acceleration;
+            return *this;
+        }
+
+        /**
+         * @brief Simulate the particles
+         * @param timeDelta Simulated time in seconds
+         * @return Reference to self (for method chaining)
+         *
+         * Ages all particles of all emitters by @p timeDelta, moves them and
+         * respawns dead particles of enabled emitters at current emitter
+         * transformation. Issues one transform feedback pass per emitter
+         * with @ref Renderer::Feature::RasterizerDiscard enabled, then swaps
+         * the vertex buffers.
+         */
+        ParticleSystem& update(Float timeDelta);
+
+        /**
+         * @brief Buffer with current particle data
+         *
+         * Contains @ref capacity() @ref Particle instances. The buffer
+         * changes after each @ref update().
+         */
+        Buffer& buffer() { return _buffers[_current]; }
+
+        /**
+         * @brief Mesh for drawing current particles
+         *
+         * @ref MeshPrimitive::Points mesh with @ref count() vertices,
+         * configured for @ref Shaders::ParticleBillboard. The mesh changes
+         * after each @ref update().
+         * @see @ref draw()
+         */
+        Mesh& mesh() { return _drawMeshes[_current]; }
+
+        /**
+         * @brief Draw the particles
+         * @return Reference to self (for method chaining)
+         *
+         * Equivalent to calling @ref Mesh::draw() on @ref mesh().
+         */
+        ParticleSystem& draw(Shaders::ParticleBillboard& shader);
+
+    private:
+        UnsignedInt add(ParticleEmitter& emitter, UnsignedInt count, Float lifetime);
+        void remove(ParticleEmitter& emitter);
+        void fill(UnsignedInt offset, const std::vector<Particle>& particles);
+
+        UnsignedInt _capacity, _count, _current, _seed;
+        Vector3 _acceleration;
+        std::vector<ParticleEmitter*> _emitters;
+
+        std::unique_ptr<Implementation::ParticleUpdateShader> _shader;
+        Buffer _buffers[2];
+        Mesh _updateMeshes[2], _drawMeshes[2];
+        TransformFeedback _feedback;
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 build
+#endif
+
+#endif
@@ -0,0 +1,134 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 0)
+#endif
+uniform highp mat4 emitterTransformationMatrix;
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 1)
+#endif
+uniform highp vec3 emitterVelocity;
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 2)
+#endif
+uniform highp float emitterVelocitySpread;
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 3)
+#endif
+uniform highp float emitterRadius;
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 4)
+#endif
+uniform highp vec2 emitterLifetime;
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 5)
+#endif
+uniform lowp int emitterEnabled;
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 6)
+#endif
+uniform highp vec3 acceleration;
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 7)
+#endif
+uniform highp float timeDelta;
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 8)
+#endif
+uniform highp uint seed;
+
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = 0) in highp vec4 positionAge;
+layout(location = 1) in highp vec4 velocityLifetime;
+#else
+in highp vec4 positionAge;
+in highp vec4 velocityLifetime;
+#endif
+
+out highp vec4 outPositionAge;
+out highp vec4 outVelocityLifetime;
+
+highp uint hash(highp uint x) {
+    x ^= x >> 16u;
+    x *= 0x7feb352du;
+    x ^= x >> 15u;
+    x *= 0x846ca68bu;
+    x ^= x >> 16u;
+    return x;
+}
+
+/* Random number in [0, 1) */
+highp float random(inout highp uint state) {
+    state = hash(state);
+    return float(state >> 8u)/16777216.0;
+}
+
+/* Random point in an unit sphere */
+highp vec3 randomInSphere(inout highp uint state) {
+    highp vec3 direction = vec3(random(state), random(state), random(state))*2.0 - vec3(1.0);
+    highp float directionLength = length(direction);
+    return directionLength > 1.0 ? direction/directionLength : direction;
+}
+
+void main() {
+    highp vec3 position = positionAge.xyz;
+    highp float age = positionAge.w + timeDelta;
+    highp vec3 velocity = velocityLifetime.xyz;
+    highp float lifetime = velocityLifetime.w;
+
+    /* Dead, respawn at the emitter if it's enabled */
+    if(age >= lifetime) {
+        if(emitterEnabled == 0) {
+            age = lifetime;
+        } else {
+            highp uint state = hash(uint(gl_VertexID) ^ hash(seed));
+
+            /* Keep the particles evenly spread in time, but don't let them
+               accumulate age while the emitter was disabled */
+            age = clamp(age - lifetime, 0.0, timeDelta);
+            lifetime = mix(emitterLifetime.x, emitterLifetime.y, random(state));
+            position = (emitterTransformationMatrix*vec4(randomInSphere(state)*emitterRadius, 1.0)).xyz;
+            velocity = mat3(emitterTransformationMatrix)*(emitterVelocity + randomInSphere(state)*emitterVelocitySpread);
+            position += velocity*age;
+        }
+
+    /* Alive, simulate */
+    } else if(age >= 0.0) {
+        velocity += acceleration*timeDelta;
+        position += velocity*timeDelta;
+    }
+
+    outPositionAge = vec4(position, age);
+    outVelocityLifetime = vec4(velocity, lifetime);
+}
@@ -0,0 +1,207 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Particles/ParticleEmitter.h"
+#include "Magnum/Particles/ParticleSystem.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Object.h"
+#include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/Shaders/ParticleBillboard.h"
+
+namespace Magnum { namespace Particles { namespace Test {
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+struct ParticleSystemGLTest: OpenGLTester {
+    explicit ParticleSystemGLTest();
+
+    void construct();
+    void addRemoveEmitter();
+
+    void spawn();
+    void simulate();
+    void disabled();
+
+    void draw();
+};
+
+namespace {
+
+/* Buffer::data() is not available on ES, map the buffer for reading instead */
+Containers::Array<Particle> particleData(Buffer& buffer) {
+    const std::size_t count = buffer.size()/sizeof(Particle);
+    Containers::Array<Particle> out{count};
+    const Particle* data = buffer.map<Particle>(0, count*sizeof(Particle), Buffer::MapFlag::Read);
+    std::copy(data, data + count, out.begin());
+    buffer.unmap();
+    return out;
+}
+
+}
+
+ParticleSystemGLTest::ParticleSystemGLTest() {
+    addTests({&ParticleSystemGLTest::construct,
+              &ParticleSystemGLTest::addRemoveEmitter,
+
+              &ParticleSystemGLTest::spawn,
+              &ParticleSystemGLTest::simulate,
+              &ParticleSystemGLTest::disabled,
+
+              &ParticleSystemGLTest::draw});
+}
+
+void ParticleSystemGLTest::construct() {
+    ParticleSystem system{16};
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(system.capacity(), 16);
+    CORRADE_COMPARE(system.count(), 0);
+    CORRADE_VERIFY(system.buffer().id() > 0);
+    CORRADE_COMPARE(system.buffer().size(), 16*sizeof(Particle));
+}
+
+void ParticleSystemGLTest::addRemoveEmitter() {
+    ParticleSystem system{16};
+    Scene3D scene;
+    Object3D object{&scene};
+
+    auto a = new ParticleEmitter{object, system, 4, 2.0f};
+    auto b = new ParticleEmitter{object, system, 8};
+
+    CORRADE_COMPARE(a->offset(), 0);
+    CORRADE_COMPARE(a->count(), 4);
+    CORRADE_COMPARE(a->lifetime(), Vector2{2.0f});
+    CORRADE_COMPARE(b->offset(), 4);
+    CORRADE_COMPARE(b->count(), 8);
+    CORRADE_COMPARE(system.count(), 12);
+    CORRADE_COMPARE(system.emitters().size(), 2);
+    CORRADE_COMPARE(system.mesh().count(), 12);
+
+    /* Initial particles are pending spawn, spread over the first lifetime */
+    const Containers::Array<Particle> particles = particleData(system.buffer());
+    CORRADE_COMPARE(particles[0].age, 0.0f);
+    CORRADE_COMPARE(particles[1].age, -0.5f);
+    CORRADE_COMPARE(particles[3].age, -1.5f);
+    CORRADE_COMPARE(particles[3].lifetime, 0.0f);
+
+    /* The range is not reused */
+    delete a;
+    CORRADE_COMPARE(system.emitters().size(), 1);
+    CORRADE_COMPARE(system.emitters()[0], b);
+    CORRADE_COMPARE(system.count(), 12);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void ParticleSystemGLTest::spawn() {
+    ParticleSystem system{4};
+    Scene3D scene;
+    Object3D object{&scene};
+    object.translate({1.0f, 2.0f, 3.0f});
+
+    (new ParticleEmitter{object, system, 4, 4.0f})
+        ->setVelocity({0.0f, 1.0f, 0.0f});
+
+    /* Spawns the first two particles, the other two are still pending */
+    system.update(1.5f);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    const Containers::Array<Particle> particles = particleData(system.buffer());
+    CORRADE_COMPARE(particles[0].lifetime, 4.0f);
+    CORRADE_COMPARE(particles[0].position, (Vector3{1.0f, 2.0f + particles[0].age, 3.0f}));
+    CORRADE_COMPARE(particles[0].velocity, (Vector3{0.0f, 1.0f, 0.0f}));
+    CORRADE_COMPARE(particles[1].lifetime, 4.0f);
+    CORRADE_COMPARE(particles[2].age, -0.5f);
+    CORRADE_COMPARE(particles[2].lifetime, 0.0f);
+    CORRADE_COMPARE(particles[3].age, -1.5f);
+}
+
+void ParticleSystemGLTest::simulate() {
+    ParticleSystem system{1};
+    system.setAcceleration({0.0f, -2.0f, 0.0f});
+    Scene3D scene;
+    Object3D object{&scene};
+
+    (new ParticleEmitter{object, system, 1, 10.0f})
+        ->setVelocity({1.0f, 0.0f, 0.0f});
+
+    /* The first update spawns, the second one only simulates */
+    system.update(0.0f)
+        .update(0.5f);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    const Containers::Array<Particle> particles = particleData(system.buffer());
+    CORRADE_COMPARE(particles[0].age, 0.5f);
+    CORRADE_COMPARE(particles[0].velocity, (Vector3{1.0f, -1.0f, 0.0f}));
+    CORRADE_COMPARE(particles[0].position, (Vector3{0.5f, -0.5f, 0.0f}));
+}
+
+void ParticleSystemGLTest::disabled() {
+    ParticleSystem system{2};
+    Scene3D scene;
+    Object3D object{&scene};
+
+    (new ParticleEmitter{object, system, 2, 1.0f})
+        ->setEnabled(false);
+
+    system.update(2.0f);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Nothing spawned */
+    const Containers::Array<Particle> particles = particleData(system.buffer());
+    CORRADE_COMPARE(particles[0].lifetime, 0.0f);
+    CORRADE_COMPARE(particles[0].age, 0.0f);
+    CORRADE_COMPARE(particles[1].age, 0.0f);
+}
+
+void ParticleSystemGLTest::draw() {
+    ParticleSystem system{16};
+    Scene3D scene;
+    Object3D object{&scene};
+    new ParticleEmitter{object, system, 16};
+    system.update(0.5f);
+
+    Shaders::ParticleBillboard shader;
+    shader.setViewportSize({16.0f, 16.0f})
+        .setSize(0.1f);
+    system.draw(shader);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Particles::Test::ParticleSystemGLTest)
@@ -0,0 +1,75 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Particles/ParticleSystem.h"
+
+namespace Magnum { namespace Particles { namespace Test {
+
+struct ParticleSystemTest: TestSuite::Tester {
+    explicit ParticleSystemTest();
+
+    void constructNoCreate();
+    void constructCopy();
+    void particleLayout();
+};
+
+ParticleSystemTest::ParticleSystemTest() {
+    addTests({&ParticleSystemTest::constructNoCreate,
+              &ParticleSystemTest::constructCopy,
+              &ParticleSystemTest::particleLayout});
+}
+
+void ParticleSystemTest::constructNoCreate() {
+    {
+        ParticleSystem system{NoCreate};
+        CORRADE_COMPARE(system.capacity(), 0);
+        CORRADE_COMPARE(system.count(), 0);
+        CORRADE_VERIFY(system.emitters().empty());
+        CORRADE_COMPARE(system.buffer().id(), 0);
+    }
+
+    CORRADE_VERIFY(true);
+}
+
+void ParticleSystemTest::constructCopy() {
+    CORRADE_VERIFY(!(std::is_constructible<ParticleSystem, const ParticleSystem&>{}));
+    CORRADE_VERIFY(!(std::is_assignable<ParticleSystem, const ParticleSystem&>{}));
+    CORRADE_VERIFY(!(std::is_constructible<ParticleSystem, ParticleSystem&&>{}));
+    CORRADE_VERIFY(!(std::is_assignable<ParticleSystem, ParticleSystem&&>{}));
+}
+
+void ParticleSystemTest::particleLayout() {
+    /* Interleaved vec4 pairs in the update shader */
+    CORRADE_COMPARE(sizeof(Particle), 32);
+    CORRADE_COMPARE(offsetof(Particle, age), 12);
+    CORRADE_COMPARE(offsetof(Particle, velocity), 16);
+    CORRADE_COMPARE(offsetof(Particle, lifetime), 28);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Particles::Test::ParticleSystemTest)
@@ -25,6 +25,8 @@
 
 #include "AndroidApplication.h"
 
+#include <unistd.h>
+
 #include <Corrade/Utility/AndroidStreamBuffer.h>
 #include <Corrade/Utility/Debug.h>
 
@@ -143,6 +145,54 @@ bool AndroidApplication::tryCreateContext(const Configuration& configuration) {
     return _context->tryCreate();
 }
 
+auto AndroidApplication::openAsset(const std::string& filename) -> Asset {
+    /* AASSET_MODE_BUFFER makes AAsset_getBuffer() mmap uncompressed assets
+       instead of reading them into an allocated copy */
+    AAsset* const asset = AAssetManager_open(_state->activity->assetManager, filename.data(), AASSET_MODE_BUFFER);
+    if(!asset) {
+        Error() << "Platform::AndroidApplication::openAsset(): cannot open" << filename;
+        return {};
+    }
+
+    return Asset{asset};
+}
+
+AndroidApplication::Asset::~Asset() {
+    if(_asset) AAsset_close(_asset);
+}
+
+std::size_t AndroidApplication::Asset::size() const {
+    return _asset ? AAsset_getLength(_asset) : 0;
+}
+
+bool AndroidApplication::Asset::isCompressed() const {
+    if(!_asset) return false;
+
+    /* Only uncompressed assets can be accessed through a file descriptor */
+    off_t start, length;
+    const int fd = AAsset_openFileDescriptor(_asset, &start, &length);
+    if(fd < 0) return true;
+    close(fd);
+    return false;
+}
+
+Containers::ArrayView<const char> AndroidApplication::Asset::data() {
+    if(!_asset) return nullptr;
+
+    const void* const data = AAsset_getBuffer(_asset);
+    if(!data) {
+        Error() << "Platform::AndroidApplication::Asset::data(): cannot get asset data";
+        return nullptr;
+    }
+
+    return {static_cast<const char*>(data), std::size_t(AAsset_getLength(_asset))};
+}
+
+std::ptrdiff_t AndroidApplication::Asset::read(const Containers::ArrayView<char> destination) {
+    CORRADE_ASSERT(_asset, "Platform::AndroidApplication::Asset::read(): the asset is not opened", -1);
+    return AAsset_read(_asset, destination.data(), destination.size());
+}
+
 void AndroidApplication::swapBuffers() {
     eglSwapBuffers(_display, _surface);
 }
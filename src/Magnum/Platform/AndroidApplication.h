@@ -30,8 +30,12 @@
  */
 
 #include <memory>
+#include <string>
+#include <utility>
 #include <EGL/egl.h>
+#include <android/asset_manager.h>
 #include <android_native_app_glue.h>
+#include <Corrade/Containers/ArrayView.h>
 
 #include "Magnum/Magnum.h"
 #include "Magnum/Tags.h"
@@ -169,6 +173,27 @@ The application by default redirects @ref Corrade::Utility::Debug "Debug",
 output to Android log buffer with tag `"magnum"`, which can be then accessed
 through `logcat` utility. See also @ref Corrade::Utility::AndroidLogStreamBuffer
 for more information.
+
+## Accessing APK assets
+
+Files packed in the `assets/` directory of the APK can be opened with
+@ref openAsset(). Assets stored in the APK without compression are
+memory-mapped directly from the package file, so their @ref Asset::data()
+can be passed to @ref Trade::AbstractImporter::openMemory() (or
+@ref Trade::AbstractImporter::openData()) without copying anything:
+
+@code
+std::unique_ptr<Trade::AbstractImporter> importer = manager.instance("AnySceneImporter");
+Asset asset = openAsset("scene.gltf");
+if(!asset || !importer->openMemory(asset.data())) std::exit(1);
+@endcode
+
+With @ref Trade::AbstractImporter::openMemory() the asset needs to be kept
+alive for the whole lifetime of the importer and all data imported from it.
+To prevent `aapt` from compressing large assets, list their extensions in the
+`-0` option (or `aaptOptions { noCompress }` in Gradle). Compressed assets
+are either decompressed into memory once on the first call to
+@ref Asset::data() or can be read in chunks using @ref Asset::read().
 */
 class AndroidApplication {
     public:
@@ -176,6 +201,7 @@ class AndroidApplication {
         typedef android_app* Arguments;
 
         class Configuration;
+        class Asset;
         class InputEvent;
         class MouseEvent;
         class MouseMoveEvent;
@@ -227,6 +253,15 @@ class AndroidApplication {
         /** @brief Moving is not allowed */
         AndroidApplication& operator=(AndroidApplication&&) = delete;
 
+        /**
+         * @brief Open an APK asset
+         *
+         * The @p filename is relative to the `assets/` directory of the APK.
+         * If the asset doesn't exist, prints a message to error output and
+         * returns an empty instance. See @ref Asset for more information.
+         */
+        Asset openAsset(const std::string& filename);
+
     protected:
         /** @copydoc Sdl2Application::createContext() */
         #ifdef DOXYGEN_GENERATING_OUTPUT
@@ -373,6 +408,94 @@ class AndroidApplication::Configuration {
         Vector2i _size;
 };
 
+/**
+@brief APK asset
+
+Move-only wrapper around `AAsset`. Obtained from @ref openAsset(), see
+@ref AndroidApplication "class documentation" for an example.
+*/
+class AndroidApplication::Asset {
+    friend AndroidApplication;
+
+    public:
+        /**
+         * @brief Default constructor
+         *
+         * Creates an empty instance.
+         */
+        constexpr /*implicit*/ Asset() noexcept: _asset{} {}
+
+        /** @brief Copying is not allowed */
+        Asset(const Asset&) = delete;
+
+        /** @brief Move constructor */
+        Asset(Asset&& other) noexcept: _asset{other._asset} {
+            other._asset = nullptr;
+        }
+
+        /**
+         * @brief Destructor
+         *
+         * Closes the asset, invalidating all views returned from
+         * @ref data().
+         */
+        ~Asset();
+
+        /** @brief Copying is not allowed */
+        Asset& operator=(const Asset&) = delete;
+
+        /** @brief Move assignment */
+        Asset& operator=(Asset&& other) noexcept {
+            std::swap(_asset, other._asset);
+            return *this;
+        }
+
+        /** @brief Whether the asset is opened */
+        explicit operator bool() const { return _asset; }
+
+        /** @brief Underlying `AAsset` handle */
+        AAsset* handle() { return _asset; }
+
+        /** @brief Asset size in bytes */
+        std::size_t size() const;
+
+        /**
+         * @brief Whether the asset is compressed in the APK
+         *
+         * Uncompressed assets are memory-mapped on @ref data() without any
+         * copy, compressed assets are decompressed into memory owned by the
+         * asset.
+         */
+        bool isCompressed() const;
+
+        /**
+         * @brief Asset data
+         *
+         * For uncompressed assets returns a view directly on the memory
+         * mapped from the APK, for compressed assets the whole contents are
+         * decompressed on the first call. The view is valid for the whole
+         * lifetime of the instance. Returns empty view if the instance is
+         * empty or the data cannot be retrieved.
+         * @see @ref isCompressed(), @ref read()
+         */
+        Containers::ArrayView<const char> data();
+
+        /**
+         * @brief Read next chunk of the asset
+         *
+         * Reads at most `destination.size()` bytes from current position,
+         * returns count of bytes actually read, zero at the end of the asset
+         * and `-1` on error. Useful for streaming compressed assets without
+         * keeping their whole decompressed contents in memory.
+         */
+        std::ptrdiff_t read(Containers::ArrayView<char> destination);
+
+    private:
+        explicit Asset(AAsset* asset) noexcept: _asset{asset} {}
+
+        AAsset* _asset;
+};
+
 /**
 @brief Base for input events
 
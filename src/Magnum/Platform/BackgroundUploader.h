@@ -0,0 +1,300 @@
+#ifndef Magnum_Platform_BackgroundUploader_h
+#define Magnum_Platform_BackgroundUploader_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Platform::BackgroundUploader
+ */
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Platform/Context.h"
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/Fence.h"
+#endif
+
+namespace Magnum { namespace Platform {
+
+/**
+@brief Background upload thread
+
+Executes texture and buffer uploads on a dedicated thread with its own OpenGL
+context sharing objects with the main one, so large uploads don't stall the
+rendering. The @p GLContext is expected to be one of the windowless context
+classes such as @ref WindowlessGlxContext, @ref WindowlessEglContext or
+@ref WindowlessWglContext. Requires Magnum to be built with
+@ref MAGNUM_BUILD_MULTITHREADED enabled (the default).
+
+The windowless context is created on the main thread (context creation is not
+thread-safe on all platforms), sharing objects with the current context, and
+then moved into the uploader. The uploader makes it current on its thread and
+creates a @ref Platform::Context there:
+
+@code
+Platform::BackgroundUploader<Platform::WindowlessGlxContext> uploader{
+    Platform::WindowlessGlxContext{Platform::WindowlessGlxContext::Configuration{}
+        .setSharedContext(glXGetCurrentContext())}};
+
+Texture2D texture;
+texture.setStorage(1, TextureFormat::RGBA8, image.size());
+uploader.enqueue([&]() {
+    texture.setSubImage(0, {}, image);
+}, [&]() {
+    // Called on the main thread from poll() once the data are on the GPU
+    textureReady = true;
+});
+
+// each frame
+uploader.poll();
+@endcode
+
+Each upload is followed by a @ref Fence and the thread waits for it to be
+signaled before reporting the upload as finished, so once the completion
+callback is called, the data are guaranteed to be visible in the main context.
+On OpenGL ES 2.0 and WebGL 1.0, where sync objects are not available,
+@fn_gl{Finish} is used instead. The uploads are processed in submission order.
+
+The objects passed to the uploads have to be created (and storage allocated)
+on the main thread, the upload functions should only fill them with data and
+must not change any state used by the main context, such as texture
+parameters. The objects, as well as the data being uploaded, have to stay
+alive until the upload finishes.
+*/
+template<class GLContext> class BackgroundUploader {
+    public:
+        /**
+         * @brief Constructor
+         * @param glContext     Created OpenGL context sharing objects with the
+         *      main context
+         *
+         * Starts the upload thread, makes @p glContext current in it and
+         * creates a @ref Platform::Context. Blocks until the context is
+         * created, use @ref isReady() to check for success.
+         */
+        explicit BackgroundUploader(GLContext&& glContext);
+
+        /** @brief Copying is not allowed */
+        BackgroundUploader(const BackgroundUploader<GLContext>&) = delete;
+
+        /** @brief Moving is not allowed */
+        BackgroundUploader(BackgroundUploader<GLContext>&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Waits until all queued uploads are finished and stops the thread.
+         * Completion callbacks that weren't executed through @ref poll() are
+         * discarded.
+         */
+        ~BackgroundUploader();
+
+        /** @brief Copying is not allowed */
+        BackgroundUploader<GLContext>& operator=(const BackgroundUploader<GLContext>&) = delete;
+
+        /** @brief Moving is not allowed */
+        BackgroundUploader<GLContext>& operator=(BackgroundUploader<GLContext>&&) = delete;
+
+        /**
+         * @brief Whether the upload thread is ready
+         *
+         * Returns `false` if the context couldn't be made current or the
+         * Magnum context creation in the upload thread failed.
+         */
+        bool isReady() const { return _ready; }
+
+        /**
+         * @brief Enqueue an upload
+         * @param upload        Function to execute on the upload thread
+         * @param completed     Function to execute on the main thread in
+         *      @ref poll() once the upload is finished. Optional.
+         * @return Upload ID, to be used with @ref isFinished()
+         *
+         * Expects that the upload thread is ready.
+         */
+        std::uint64_t enqueue(std::function<void()> upload, std::function<void()> completed = {});
+
+        /**
+         * @brief Whether given upload is finished
+         *
+         * Returns `true` once the data are on the GPU, even if the completion
+         * callback wasn't executed by @ref poll() yet.
+         */
+        bool isFinished(std::uint64_t id) const {
+            std::lock_guard<std::mutex> lock{_mutex};
+            return id <= _lastFinished;
+        }
+
+        /** @brief Count of uploads that are not finished yet */
+        std::size_t pendingCount() const {
+            std::lock_guard<std::mutex> lock{_mutex};
+            return _nextId - 1 - _lastFinished;
+        }
+
+        /**
+         * @brief Execute completion callbacks of finished uploads
+         * @return Count of executed callbacks
+         *
+         * Doesn't block. Call this periodically from the main thread, for
+         * example once per frame.
+         */
+        std::size_t poll();
+
+        /**
+         * @brief Wait for all queued uploads
+         *
+         * Blocks until all queued uploads are finished and then calls
+         * @ref poll().
+         */
+        std::size_t finish();
+
+    private:
+        void run();
+
+        GLContext _glContext;
+        bool _ready{};
+        bool _initialized{};
+        bool _quit{};
+        std::uint64_t _nextId{1};
+        std::uint64_t _lastFinished{};
+        std::deque<std::pair<std::function<void()>, std::function<void()>>> _queue;
+        std::vector<std::function<void()>> _completed;
+        mutable std::mutex _mutex;
+        std::condition_variable _queueCondition, _finishedCondition;
+        std::thread _thread;
+};
+
+template<class GLContext> BackgroundUploader<GLContext>::BackgroundUploader(GLContext&& glContext): _glContext{std::move(glContext)} {
+    _thread = std::thread{&BackgroundUploader<GLContext>::run, this};
+
+    std::unique_lock<std::mutex> lock{_mutex};
+    _finishedCondition.wait(lock, [this]() { return _initialized; });
+}
+
+template<class GLContext> BackgroundUploader<GLContext>::~BackgroundUploader() {
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _quit = true;
+    }
+    _queueCondition.notify_one();
+    _thread.join();
+}
+
+template<class GLContext> std::uint64_t BackgroundUploader<GLContext>::enqueue(std::function<void()> upload, std::function<void()> completed) {
+    CORRADE_ASSERT(_ready,
+        "Platform::BackgroundUploader::enqueue(): the upload thread is not ready", 0);
+
+    std::uint64_t id;
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _queue.emplace_back(std::move(upload), std::move(completed));
+        id = _nextId++;
+    }
+    _queueCondition.notify_one();
+    return id;
+}
+
+template<class GLContext> std::size_t BackgroundUploader<GLContext>::poll() {
+    std::vector<std::function<void()>> completed;
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        std::swap(completed, _completed);
+    }
+
+    /* Executing outside of the lock so the callbacks can enqueue more */
+    for(const std::function<void()>& f: completed) f();
+    return completed.size();
+}
+
+template<class GLContext> std::size_t BackgroundUploader<GLContext>::finish() {
+    {
+        std::unique_lock<std::mutex> lock{_mutex};
+        _finishedCondition.wait(lock, [this]() { return _lastFinished == _nextId - 1; });
+    }
+    return poll();
+}
+
+template<class GLContext> void BackgroundUploader<GLContext>::run() {
+    std::unique_ptr<Platform::Context> context;
+    if(_glContext.makeCurrent()) {
+        const char* argv[]{"", "--magnum-log", "quiet"};
+        context.reset(new Platform::Context{NoCreate, 3, argv});
+        if(!context->tryCreate()) context = nullptr;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _ready = !!context;
+        _initialized = true;
+    }
+    _finishedCondition.notify_all();
+    if(!context) {
+        Error() << "Platform::BackgroundUploader: cannot create OpenGL context in the upload thread";
+        return;
+    }
+
+    for(;;) {
+        std::pair<std::function<void()>, std::function<void()>> upload;
+        {
+            std::unique_lock<std::mutex> lock{_mutex};
+            _queueCondition.wait(lock, [this]() { return _quit || !_queue.empty(); });
+
+            /* Finish all queued uploads before quitting */
+            if(_queue.empty()) break;
+
+            upload = std::move(_queue.front());
+            _queue.pop_front();
+        }
+
+        upload.first();
+
+        /* Make sure the data are on the GPU before reporting completion */
+        #ifndef MAGNUM_TARGET_GLES2
+        Fence fence;
+        fence.insert().clientWait();
+        #else
+        glFinish();
+        #endif
+
+        {
+            std::lock_guard<std::mutex> lock{_mutex};
+            ++_lastFinished;
+            if(upload.second) _completed.push_back(std::move(upload.second));
+        }
+        _finishedCondition.notify_all();
+    }
+}
+
+}}
+
+#endif
@@ -30,6 +30,7 @@
 #include <Corrade/Utility/String.h>
 #include <Corrade/Utility/Unicode.h>
 
+#include "Magnum/DefaultFramebuffer.h"
 #include "Magnum/Version.h"
 #include "Magnum/Platform/Context.h"
 #include "Magnum/Platform/ScreenedApplication.hpp"
@@ -135,6 +136,7 @@ bool GlfwApplication::tryCreateContext(const Configuration& configuration) {
 
     /* Set callbacks */
     glfwSetFramebufferSizeCallback(_window, staticViewportEvent);
+    glfwSetWindowRefreshCallback(_window, staticRefreshEvent);
     glfwSetKeyCallback(_window, staticKeyEvent);
     glfwSetCursorPosCallback(_window, staticMouseMoveEvent);
     glfwSetMouseButtonCallback(_window, staticMouseEvent);
@@ -164,16 +166,47 @@ void GlfwApplication::setSwapInterval(const Int interval) {
 
 int GlfwApplication::exec() {
     while(!glfwWindowShouldClose(_window)) {
+        /* With frame pacing, wait for the next frame first and poll input
+           right before drawing so it's as fresh as possible */
+        const bool framePacing = _framePacer.targetFramePeriod() > 0.0f && (_flags & Flag::Redraw);
+        if(framePacing) {
+            _framePacer.beginFrame();
+            glfwPollEvents();
+            flushCoalescedInput();
+        }
+
+        /* Damage from redraws requested in the draw event itself goes to
+           the next frame */
         if(_flags & Flag::Redraw) {
-            _flags &= ~Flag::Redraw;
+            _redrawDamage = _flags & Flag::FullRedraw ? defaultFramebuffer.viewport() : _damage;
+            _damage = {};
+            _flags &= ~(Flag::Redraw|Flag::FullRedraw);
             drawEvent();
+            _framePacer.endFrame();
+        }
+
+        /* When rendering on demand and nothing requested a redraw, sleep
+           until the next event arrives */
+        if(!framePacing) {
+            if((_flags & Flag::OnDemand) && !(_flags & Flag::Redraw))
+                glfwWaitEvents();
+            else glfwPollEvents();
+            flushCoalescedInput();
         }
-        glfwPollEvents();
     }
     return 0;
 }
 
+void GlfwApplication::redraw(const Range2Di& rectangle) {
+    if(!(rectangle.size() > Vector2i{}).all()) return;
+
+    _damage = (_damage.size() > Vector2i{}).all() ? Range2Di{Math::join(_damage, rectangle)} : rectangle;
+    _flags |= Flag::Redraw;
+}
+
 void GlfwApplication::staticKeyEvent(GLFWwindow*, int key, int, int action, int mods) {
+    _instance->flushCoalescedInput();
+
     KeyEvent e(static_cast<KeyEvent::Key>(key), {static_cast<InputEvent::Modifier>(mods)}, action == GLFW_REPEAT);
 
     if(action == GLFW_PRESS) {
@@ -186,11 +219,21 @@ void GlfwApplication::staticKeyEvent(GLFWwindow*, int key, int, int action, int
 }
 
 void GlfwApplication::staticMouseMoveEvent(GLFWwindow* window, double x, double y) {
+    /* Consecutive moves are only recorded and dispatched together later */
+    if(_instance->_flags & Flag::InputCoalescing) {
+        if(_instance->_flags & Flag::MouseScrollPending)
+            _instance->flushCoalescedInput();
+        _instance->_coalescedMousePositions.emplace_back(Int(x), Int(y));
+        return;
+    }
+
     MouseMoveEvent e{Vector2i{Int(x), Int(y)}, KeyEvent::getCurrentGlfwModifiers(window)};
     _instance->mouseMoveEvent(e);
 }
 
 void GlfwApplication::staticMouseEvent(GLFWwindow*, int button, int action, int mods) {
+    _instance->flushCoalescedInput();
+
     double x, y;
     glfwGetCursorPos(_instance->_window, &x, &y);
     MouseEvent e(static_cast<MouseEvent::Button>(button), {Int(x), Int(y)}, {static_cast<InputEvent::Modifier>(mods)});
@@ -202,28 +245,61 @@ void GlfwApplication::staticMouseEvent(GLFWwindow*, int button, int action, int
     } /* we don't handle GLFW_REPEAT */
 }
 
-void GlfwApplication::staticMouseScrollEvent(GLFWwindow* window, double xoffset, double yoffset) {
-    MouseScrollEvent e(Vector2{Float(xoffset), Float(yoffset)}, KeyEvent::getCurrentGlfwModifiers(window));
-    _instance->mouseScrollEvent(e);
+void GlfwApplication::staticMouseScrollEvent(GLFWwindow*, double xoffset, double yoffset) {
+    /* Consecutive scrolls are only accumulated and dispatched together
+       later */
+    if(_instance->_flags & Flag::InputCoalescing) {
+        if(!_instance->_coalescedMousePositions.empty())
+            _instance->flushCoalescedInput();
+        _instance->_coalescedMouseScrollOffset += Vector2{Float(xoffset), Float(yoffset)};
+        _instance->_flags |= Flag::MouseScrollPending;
+        return;
+    }
+
+    _instance->callMouseScrollEvent({Float(xoffset), Float(yoffset)});
+}
+
+void GlfwApplication::callMouseScrollEvent(const Vector2& offset) {
+    MouseScrollEvent e(offset, KeyEvent::getCurrentGlfwModifiers(_window));
+    mouseScrollEvent(e);
 
     #ifdef MAGNUM_BUILD_DEPRECATED
-    if(yoffset != 0.0) {
+    if(offset.y() != 0.0f) {
         #ifdef __GNUC__
         #pragma GCC diagnostic push
         #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
         #endif
-        MouseEvent e1((yoffset > 0.0) ? MouseEvent::Button::WheelUp : MouseEvent::Button::WheelDown, {}, KeyEvent::getCurrentGlfwModifiers(window));
+        MouseEvent e1((offset.y() > 0.0f) ? MouseEvent::Button::WheelUp : MouseEvent::Button::WheelDown, {}, KeyEvent::getCurrentGlfwModifiers(_window));
         #ifdef __GNUC__
         #pragma GCC diagnostic pop
         #endif
-        _instance->mousePressEvent(e1);
+        mousePressEvent(e1);
     }
     #endif
 }
 
+void GlfwApplication::flushCoalescedInput() {
+    /* At most one of these is pending at a time, as each of them flushes the
+       other */
+    if(!_coalescedMousePositions.empty()) {
+        MouseMoveEvent e{_coalescedMousePositions.back(), KeyEvent::getCurrentGlfwModifiers(_window), {_coalescedMousePositions.data(), _coalescedMousePositions.size()}};
+        mouseMoveEvent(e);
+        _coalescedMousePositions.clear();
+    }
+
+    if(_flags & Flag::MouseScrollPending) {
+        const Vector2 offset = _coalescedMouseScrollOffset;
+        _coalescedMouseScrollOffset = {};
+        _flags &= ~Flag::MouseScrollPending;
+        callMouseScrollEvent(offset);
+    }
+}
+
 void GlfwApplication::staticTextInputEvent(GLFWwindow*, unsigned int codepoint) {
     if(!(_instance->_flags & Flag::TextInputActive)) return;
 
+    _instance->flushCoalescedInput();
+
     char utf8[4];
     const std::size_t size = Utility::Unicode::utf8(codepoint, utf8);
     TextInputEvent e{{utf8, size}};
@@ -32,10 +32,13 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 #include <Corrade/Containers/ArrayView.h>
 
+#include "Magnum/FramePacer.h"
 #include "Magnum/Magnum.h"
 #include "Magnum/Tags.h"
+#include "Magnum/Math/Range.h"
 #include "Magnum/Math/Vector2.h"
 #include "Magnum/Platform/Platform.h"
 
@@ -211,8 +214,51 @@ class GlfwApplication {
          */
         void setSwapInterval(Int interval);
 
+        /**
+         * @brief Frame pacer
+         *
+         * Disabled by default, enable it by setting
+         * @ref FramePacer::setTargetFramePeriod(). When enabled, the main
+         * loop waits for the next frame before processing input events.
+         * Frame statistics are gathered even if disabled.
+         */
+        FramePacer& framePacer() { return _framePacer; }
+
         /** @copydoc Sdl2Application::redraw() */
-        void redraw() { _flags |= Flag::Redraw; }
+        void redraw() { _flags |= Flag::Redraw|Flag::FullRedraw; }
+
+        /** @copydoc Sdl2Application::redraw(const Range2Di&) */
+        void redraw(const Range2Di& rectangle);
+
+        /** @copydoc Sdl2Application::redrawDamage() */
+        Range2Di redrawDamage() const { return _redrawDamage; }
+
+        /**
+         * @brief Whether on-demand rendering is enabled
+         *
+         * @see @ref setOnDemandRendering()
+         */
+        bool isOnDemandRendering() const {
+            return !!(_flags & Flag::OnDemand);
+        }
+
+        /**
+         * @brief Enable or disable on-demand rendering
+         *
+         * By default the main loop polls for events continuously. When
+         * on-demand rendering is enabled, the main loop blocks waiting for
+         * next event whenever there's no pending @ref redraw(). Event
+         * handlers are expected to call @ref redraw() or
+         * @ref redraw(const Range2Di&) when something changed, window
+         * resize and expose request a redraw automatically. For animations
+         * you can use @ref SceneGraph::AnimableGroup::setActivityCallback()
+         * to redraw while they are running. Disabled by default.
+         * @see @ref Sdl2Application::setOnDemandRendering()
+         */
+        void setOnDemandRendering(bool enabled) {
+            if(enabled) _flags |= Flag::OnDemand;
+            else _flags &= ~Flag::OnDemand;
+        }
 
     #ifdef DOXYGEN_GENERATING_OUTPUT
     protected:
@@ -245,6 +291,33 @@ class GlfwApplication {
             glfwSetCursorPos(_window, Double(position.x()), Double(position.y()));
         }
 
+        /**
+         * @brief Whether mouse input coalescing is enabled
+         *
+         * @see @ref setInputCoalescing()
+         */
+        bool isInputCoalescing() const {
+            return !!(_flags & Flag::InputCoalescing);
+        }
+
+        /**
+         * @brief Enable or disable mouse input coalescing
+         *
+         * When enabled, consecutive mouse move events received in one event
+         * poll are merged into a single @ref mouseMoveEvent() call with
+         * position of the last one and consecutive scroll events are merged
+         * into a single @ref mouseScrollEvent() call with the offsets
+         * summed. Any other event in between ends the merged run, so order
+         * of the moves relative to button presses or key events is
+         * preserved. Position of each merged move event is available through
+         * @ref MouseMoveEvent::positionHistory(). Disabled by default.
+         * @see @ref Sdl2Application::setInputCoalescing()
+         */
+        void setInputCoalescing(bool enabled) {
+            if(enabled) _flags |= Flag::InputCoalescing;
+            else _flags &= ~Flag::InputCoalescing;
+        }
+
     #ifdef DOXYGEN_GENERATING_OUTPUT
     protected:
     #else
@@ -315,7 +388,11 @@ class GlfwApplication {
     private:
         enum class Flag: UnsignedByte {
             Redraw = 1 << 0,
-            TextInputActive = 1 << 1
+            TextInputActive = 1 << 1,
+            InputCoalescing = 1 << 2,
+            MouseScrollPending = 1 << 3,
+            OnDemand = 1 << 4,
+            FullRedraw = 1 << 5
         };
 
         typedef Containers::EnumSet<Flag> Flags;
@@ -323,6 +400,11 @@ class GlfwApplication {
 
         static void staticViewportEvent(GLFWwindow*, int w, int h) {
             _instance->viewportEvent({w, h});
+            _instance->redraw();
+        }
+
+        static void staticRefreshEvent(GLFWwindow*) {
+            _instance->redraw();
         }
 
         static void staticKeyEvent(GLFWwindow* window, int key, int scancode, int action, int mod);
@@ -337,10 +419,17 @@ class GlfwApplication {
 
         static void staticTextInputEvent(GLFWwindow* window, unsigned int codepoint);
 
+        void callMouseScrollEvent(const Vector2& offset);
+        void flushCoalescedInput();
+
         static GlfwApplication* _instance;
 
         GLFWwindow* _window;
         std::unique_ptr<Platform::Context> _context;
+        FramePacer _framePacer;
+        std::vector<Vector2i> _coalescedMousePositions;
+        Vector2 _coalescedMouseScrollOffset;
+        Range2Di _damage, _redrawDamage;
         Flags _flags;
 };
 
@@ -954,13 +1043,27 @@ class GlfwApplication::MouseMoveEvent: public GlfwApplication::InputEvent {
         /** @brief Position */
         constexpr Vector2i position() const { return _position; }
 
+        /**
+         * @brief Positions of coalesced events
+         *
+         * If @ref GlfwApplication::setInputCoalescing() "input coalescing"
+         * is enabled, contains position of each mouse move event merged
+         * into this one, in order, the last being equal to @ref position().
+         * If input coalescing is disabled, the view is empty. The data are
+         * valid only for the duration of the event handler.
+         */
+        Containers::ArrayView<const Vector2i> positionHistory() const {
+            return _positionHistory;
+        }
+
         /** @brief Modifiers */
         constexpr Modifiers modifiers() const { return _modifiers; }
 
     private:
-        constexpr MouseMoveEvent(const Vector2i& position, Modifiers modifiers): _position(position), _modifiers(modifiers) {}
+        constexpr MouseMoveEvent(const Vector2i& position, Modifiers modifiers, Containers::ArrayView<const Vector2i> positionHistory = nullptr): _position(position), _positionHistory(positionHistory), _modifiers(modifiers) {}
 
         const Vector2i _position;
+        const Containers::ArrayView<const Vector2i> _positionHistory;
         const Modifiers _modifiers;
 };
 
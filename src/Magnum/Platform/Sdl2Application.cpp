@@ -32,7 +32,9 @@
 #include <emscripten/emscripten.h>
 #endif
 
+#include "Magnum/DefaultFramebuffer.h"
 #include "Magnum/Version.h"
+#include "Magnum/Math/Functions.h"
 #include "Magnum/Math/Range.h"
 #include "Magnum/Platform/Context.h"
 #include "Magnum/Platform/ScreenedApplication.hpp"
@@ -322,12 +324,40 @@ int Sdl2Application::exec() {
     while(!(_flags & Flag::Exit)) mainLoopIteration();
     #else
     emscripten_set_main_loop_arg([](void* arg) {
-        static_cast<Sdl2Application*>(arg)->mainLoopIteration();
+        static_cast<Sdl2Application*>(arg)->animationFrame();
     }, this, 0, true);
     #endif
     return 0;
 }
 
+#ifdef CORRADE_TARGET_EMSCRIPTEN
+void Sdl2Application::animationFrame() {
+    /* With zero FPS passed to emscripten_set_main_loop_arg() this is called
+       from requestAnimationFrame(), so the time between two calls is the
+       frame period the browser actually delivered */
+    const Double start = emscripten_get_now();
+    if(_lastAnimationFrame != 0.0) {
+        const Float frameTime = Float((start - _lastAnimationFrame)/1000.0);
+        _animationFrameStatistics.frameTime = frameTime;
+        _animationFrameStatistics.averageFrameTime = _animationFrameStatistics.averageFrameTime == 0.0f ?
+            frameTime : _animationFrameStatistics.averageFrameTime + (frameTime - _animationFrameStatistics.averageFrameTime)/16.0f;
+        _animationFrameStatistics.maxFrameTime = Math::max(_animationFrameStatistics.maxFrameTime, frameTime);
+        ++_animationFrameStatistics.frameCount;
+    }
+    _lastAnimationFrame = start;
+
+    mainLoopIteration();
+
+    _animationFrameStatistics.workTime = Float((emscripten_get_now() - start)/1000.0);
+}
+
+void Sdl2Application::resetAnimationFrameStatistics() {
+    const Float averageFrameTime = _animationFrameStatistics.averageFrameTime;
+    _animationFrameStatistics = {};
+    _animationFrameStatistics.averageFrameTime = averageFrameTime;
+}
+#endif
+
 void Sdl2Application::exit() {
     #ifndef CORRADE_TARGET_EMSCRIPTEN
     _flags |= Flag::Exit;
@@ -338,11 +368,67 @@ void Sdl2Application::exit() {
 
 void Sdl2Application::mainLoopIteration() {
     #ifndef CORRADE_TARGET_EMSCRIPTEN
+    /* If going to draw, wait for the next frame before polling input so the
+       input is as fresh as possible */
+    const bool framePacing = _framePacer.targetFramePeriod() > 0.0f;
+    if(framePacing && (_flags & Flag::Redraw)) _framePacer.beginFrame();
+
     const UnsignedInt timeBefore = _minimalLoopPeriod ? SDL_GetTicks() : 0;
     #endif
 
+    /* With input coalescing, runs of consecutive mouse move and scroll
+       events are accumulated here and dispatched once a different event
+       arrives or the queue is empty */
+    const bool coalesce = !!(_flags & Flag::InputCoalescing);
+    Vector2i motionPosition, motionRelativePosition;
+    Uint32 motionButtons{};
+    Vector2 scrollOffset;
+    bool scrollPending = false;
+    _relativePositionHistory.clear();
+
+    auto scrollEvent = [this](const Vector2& offset) {
+        MouseScrollEvent e{offset};
+        mouseScrollEvent(e);
+
+        #ifdef MAGNUM_BUILD_DEPRECATED
+        if(offset.y() != 0.0f) {
+            #ifdef __GNUC__
+            #pragma GCC diagnostic push
+            #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+            #endif
+            MouseEvent e(offset.y() > 0.0f ? MouseEvent::Button::WheelUp : MouseEvent::Button::WheelDown, Vector2i{offset}
+                #ifndef CORRADE_TARGET_EMSCRIPTEN
+                , 0
+                #endif
+                );
+            #ifdef __GNUC__
+            #pragma GCC diagnostic pop
+            #endif
+            mousePressEvent(e);
+        }
+        #endif
+    };
+    auto flushMotion = [&]() {
+        if(_relativePositionHistory.empty()) return;
+        MouseMoveEvent e{motionPosition, motionRelativePosition, static_cast<MouseMoveEvent::Button>(motionButtons), {_relativePositionHistory.data(), _relativePositionHistory.size()}};
+        mouseMoveEvent(e);
+        motionRelativePosition = {};
+        _relativePositionHistory.clear();
+    };
+    auto flushScroll = [&]() {
+        if(!scrollPending) return;
+        scrollEvent(scrollOffset);
+        scrollOffset = {};
+        scrollPending = false;
+    };
+
     SDL_Event event;
     while(SDL_PollEvent(&event)) {
+        if(coalesce) {
+            if(event.type != SDL_MOUSEMOTION) flushMotion();
+            if(event.type != SDL_MOUSEWHEEL) flushScroll();
+        }
+
         switch(event.type) {
             case SDL_WINDOWEVENT:
                 switch(event.window.event) {
@@ -356,10 +442,10 @@ void Sdl2Application::mainLoopIteration() {
                         SDL_GL_GetDrawableSize(_window, &drawableSize.x(), &drawableSize.y());
                         viewportEvent(drawableSize);
                         #endif
-                        _flags |= Flag::Redraw;
+                        redraw();
                     } break;
                     case SDL_WINDOWEVENT_EXPOSED:
-                        _flags |= Flag::Redraw;
+                        redraw();
                         break;
                 } break;
 
@@ -379,34 +465,24 @@ void Sdl2Application::mainLoopIteration() {
                 event.type == SDL_MOUSEBUTTONDOWN ? mousePressEvent(e) : mouseReleaseEvent(e);
             } break;
 
-            case SDL_MOUSEWHEEL: {
-                MouseScrollEvent e{{Float(event.wheel.x), Float(event.wheel.y)}};
-                mouseScrollEvent(e);
+            case SDL_MOUSEWHEEL:
+                if(coalesce) {
+                    scrollPending = true;
+                    scrollOffset += Vector2{Float(event.wheel.x), Float(event.wheel.y)};
+                } else scrollEvent({Float(event.wheel.x), Float(event.wheel.y)});
+                break;
 
-                #ifdef MAGNUM_BUILD_DEPRECATED
-                if(event.wheel.y != 0) {
-                    #ifdef __GNUC__
-                    #pragma GCC diagnostic push
-                    #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
-                    #endif
-                    MouseEvent e(event.wheel.y > 0 ? MouseEvent::Button::WheelUp : MouseEvent::Button::WheelDown, {event.wheel.x, event.wheel.y}
-                        #ifndef CORRADE_TARGET_EMSCRIPTEN
-                        , 0
-                        #endif
-                        );
-                    #ifdef __GNUC__
-                    #pragma GCC diagnostic pop
-                    #endif
-                    mousePressEvent(e);
+            case SDL_MOUSEMOTION:
+                if(coalesce) {
+                    _relativePositionHistory.emplace_back(event.motion.xrel, event.motion.yrel);
+                    motionPosition = {event.motion.x, event.motion.y};
+                    motionRelativePosition += _relativePositionHistory.back();
+                    motionButtons = event.motion.state;
+                } else {
+                    MouseMoveEvent e({event.motion.x, event.motion.y}, {event.motion.xrel, event.motion.yrel}, static_cast<MouseMoveEvent::Button>(event.motion.state));
+                    mouseMoveEvent(e);
                 }
-                #endif
-            } break;
-
-            case SDL_MOUSEMOTION: {
-                MouseMoveEvent e({event.motion.x, event.motion.y}, {event.motion.xrel, event.motion.yrel}, static_cast<MouseMoveEvent::Button>(event.motion.state));
-                mouseMoveEvent(e);
                 break;
-            }
 
             case SDL_MULTIGESTURE: {
                 MultiGestureEvent e({event.mgesture.x, event.mgesture.y}, event.mgesture.dTheta, event.mgesture.dDist, event.mgesture.numFingers);
@@ -434,17 +510,26 @@ void Sdl2Application::mainLoopIteration() {
         }
     }
 
+    flushMotion();
+    flushScroll();
+
     /* Tick event */
     if(!(_flags & Flag::NoTickEvent)) tickEvent();
 
-    /* Draw event */
+    /* Draw event. Damage from redraws requested in the draw event itself
+       goes to the next frame. */
     if(_flags & Flag::Redraw) {
-        _flags &= ~Flag::Redraw;
+        _redrawDamage = _flags & Flag::FullRedraw ? defaultFramebuffer.viewport() : _damage;
+        _damage = {};
+        _flags &= ~(Flag::Redraw|Flag::FullRedraw);
         drawEvent();
 
         #ifndef CORRADE_TARGET_EMSCRIPTEN
-        /* If VSync is not enabled, delay to prevent CPU hogging (if set) */
-        if(!(_flags & Flag::VSyncEnabled) && _minimalLoopPeriod) {
+        _framePacer.endFrame();
+
+        /* If VSync or frame pacing is not enabled, delay to prevent CPU
+           hogging (if set) */
+        if(!(_flags & Flag::VSyncEnabled) && !framePacing && _minimalLoopPeriod) {
             const UnsignedInt loopTime = SDL_GetTicks() - timeBefore;
             if(loopTime < _minimalLoopPeriod)
                 SDL_Delay(_minimalLoopPeriod - loopTime);
@@ -462,9 +547,9 @@ void Sdl2Application::mainLoopIteration() {
             SDL_Delay(_minimalLoopPeriod - loopTime);
     }
 
-    /* Then, if the tick event doesn't need to be called periodically, wait
-       indefinitely for next input event */
-    if(_flags & Flag::NoTickEvent) SDL_WaitEvent(nullptr);
+    /* Then, if the tick event doesn't need to be called periodically or
+       rendering on demand, wait indefinitely for next input event */
+    if(_flags & (Flag::NoTickEvent|Flag::OnDemand)) SDL_WaitEvent(nullptr);
     #endif
 }
 
@@ -506,6 +591,13 @@ void Sdl2Application::setTextInputRect(const Range2Di& rect) {
     SDL_SetTextInputRect(&r);
 }
 
+void Sdl2Application::redraw(const Range2Di& rectangle) {
+    if(!(rectangle.size() > Vector2i{}).all()) return;
+
+    _damage = (_damage.size() > Vector2i{}).all() ? Range2Di{Math::join(_damage, rectangle)} : rectangle;
+    _flags |= Flag::Redraw;
+}
+
 void Sdl2Application::tickEvent() {
     /* If this got called, the tick event is not implemented by user and thus
        we don't need to call it ever again */
@@ -30,15 +30,21 @@
  */
 
 #include <memory>
+#include <vector>
 #include <Corrade/Corrade.h>
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/EnumSet.h>
 
 #include "Magnum/Magnum.h"
 #include "Magnum/Tags.h"
+#include "Magnum/Math/Range.h"
 #include "Magnum/Math/Vector2.h"
 #include "Magnum/Platform/Platform.h"
 
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include "Magnum/FramePacer.h"
+#endif
+
 #ifdef CORRADE_TARGET_WINDOWS /* Windows version of SDL2 redefines main(), we don't want that */
 #define SDL_MAIN_HANDLED
 #endif
@@ -488,7 +494,7 @@ class Sdl2Application {
          * `-1` for late swap tearing. Prints error message and returns `false`
          * if swap interval cannot be set, `true` otherwise. Default is
          * driver-dependent, you can query the value with @ref swapInterval().
-         * @see @ref setMinimalLoopPeriod()
+         * @see @ref setMinimalLoopPeriod(), @ref framePacer()
          */
         bool setSwapInterval(Int interval);
 
@@ -506,6 +512,74 @@ class Sdl2Application {
         void setMinimalLoopPeriod(UnsignedInt milliseconds) {
             _minimalLoopPeriod = milliseconds;
         }
+
+        /**
+         * @brief Frame pacer
+         *
+         * Disabled by default, enable it by setting
+         * @ref FramePacer::setTargetFramePeriod(). When enabled, the main
+         * loop waits for the next frame before processing input events and
+         * @ref setMinimalLoopPeriod() is used only while not drawing
+         * anything. Frame statistics are gathered even if disabled.
+         * @note Not available in @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten",
+         *      the browser is managing the frequency instead.
+         */
+        FramePacer& framePacer() { return _framePacer; }
+        #else
+        /**
+         * @brief Animation frame statistics
+         *
+         * All times are in seconds.
+         * @see @ref animationFrameStatistics()
+         */
+        struct AnimationFrameStatistics {
+            /** @brief Count of frames since last statistics reset */
+            UnsignedInt frameCount;
+
+            /**
+             * @brief Duration of the last frame
+             *
+             * Time between two consecutive `requestAnimationFrame()`
+             * callbacks, i.e. the frame period the browser actually
+             * delivered.
+             */
+            Float frameTime;
+
+            /** @brief Exponential moving average of frame duration */
+            Float averageFrameTime;
+
+            /** @brief Longest frame since last statistics reset */
+            Float maxFrameTime;
+
+            /**
+             * @brief Work time of the last frame
+             *
+             * Time spent in @ref mainLoopIteration() in the last callback.
+             * If it gets close to @ref frameTime, the application is not
+             * able to keep up with the display refresh rate.
+             */
+            Float workTime;
+        };
+
+        /**
+         * @brief Animation frame statistics
+         *
+         * The main loop is driven by `requestAnimationFrame()`, the
+         * statistics are gathered in each of its callbacks.
+         * @note Available only in @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten",
+         *      elsewhere use statistics of @ref framePacer() instead.
+         */
+        const AnimationFrameStatistics& animationFrameStatistics() const {
+            return _animationFrameStatistics;
+        }
+
+        /**
+         * @brief Reset animation frame statistics
+         *
+         * Resets all values except for the average frame time to zero.
+         * @note Available only in @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten".
+         */
+        void resetAnimationFrameStatistics();
         #endif
 
         /**
@@ -514,8 +588,63 @@ class Sdl2Application {
          * Marks the window for redrawing, resulting in call to @ref drawEvent()
          * in the next iteration. You can call it from @ref drawEvent() itself
          * to redraw immediately without waiting for user input.
+         * @see @ref redraw(const Range2Di&), @ref setOnDemandRendering()
          */
-        void redraw() { _flags |= Flag::Redraw; }
+        void redraw() { _flags |= Flag::Redraw|Flag::FullRedraw; }
+
+        /**
+         * @brief Redraw a part of the window
+         *
+         * Same as @ref redraw(), but marks only given rectangle in
+         * framebuffer coordinates as damaged. Rectangles from all calls
+         * until the next @ref drawEvent() are joined together and available
+         * through @ref redrawDamage(), a call to @ref redraw() without a
+         * rectangle marks the whole window. Empty rectangles are ignored.
+         */
+        void redraw(const Range2Di& rectangle);
+
+        /**
+         * @brief Damaged area of the window
+         *
+         * Meant to be called from @ref drawEvent(). Returns the join of all
+         * rectangles passed to @ref redraw(const Range2Di&) since the
+         * previous draw event, or @ref DefaultFramebuffer::viewport() if
+         * the whole window was marked for redrawing. The rectangle can be
+         * passed directly to @ref Renderer::setScissor() to draw only the
+         * changed part, note that the previous frame contents are preserved
+         * only if the swap doesn't discard the back buffer.
+         */
+        Range2Di redrawDamage() const { return _redrawDamage; }
+
+        /**
+         * @brief Whether on-demand rendering is enabled
+         *
+         * @see @ref setOnDemandRendering()
+         */
+        bool isOnDemandRendering() const {
+            return !!(_flags & Flag::OnDemand);
+        }
+
+        /**
+         * @brief Enable or disable on-demand rendering
+         *
+         * By default, if @ref tickEvent() is implemented, the main loop runs
+         * continuously even if no redraw is requested. When on-demand
+         * rendering is enabled, the main loop blocks waiting for next input
+         * event whenever there's no pending @ref redraw(), calling
+         * @ref tickEvent() only after processing the events. Event handlers
+         * are expected to call @ref redraw() or
+         * @ref redraw(const Range2Di&) when something changed, for
+         * animations you can use
+         * @ref SceneGraph::AnimableGroup::setActivityCallback() to redraw
+         * automatically while they are running. Disabled by default, has no
+         * effect in @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten", where the
+         * main loop is driven by the browser.
+         */
+        void setOnDemandRendering(bool enabled) {
+            if(enabled) _flags |= Flag::OnDemand;
+            else _flags &= ~Flag::OnDemand;
+        }
 
     #ifdef DOXYGEN_GENERATING_OUTPUT
     protected:
@@ -595,6 +724,37 @@ class Sdl2Application {
          */
         void setMouseLocked(bool enabled);
 
+        /**
+         * @brief Whether mouse input coalescing is enabled
+         *
+         * @see @ref setInputCoalescing()
+         */
+        bool isInputCoalescing() const {
+            return !!(_flags & Flag::InputCoalescing);
+        }
+
+        /**
+         * @brief Enable or disable mouse input coalescing
+         *
+         * When enabled, consecutive mouse move events received in one main
+         * loop iteration are merged into a single @ref mouseMoveEvent() call
+         * with position of the last one and relative position accumulated
+         * over all of them. Consecutive scroll events are similarly merged
+         * into a single @ref mouseScrollEvent() call with the offsets
+         * summed. Any other event in between ends the merged run, so order
+         * of the moves relative to button presses or key events is
+         * preserved. Relative position of each merged move event is
+         * available through @ref MouseMoveEvent::relativePositionHistory().
+         *
+         * This bounds cost of the mouse handling per frame for devices with
+         * high polling rate, which can otherwise generate dozens of events
+         * for each frame. Disabled by default.
+         */
+        void setInputCoalescing(bool enabled) {
+            if(enabled) _flags |= Flag::InputCoalescing;
+            else _flags &= ~Flag::InputCoalescing;
+        }
+
     #ifdef DOXYGEN_GENERATING_OUTPUT
     protected:
     #else
@@ -716,25 +876,37 @@ class Sdl2Application {
             VSyncEnabled = 1 << 1,
             NoTickEvent = 1 << 2,
             #ifndef CORRADE_TARGET_EMSCRIPTEN
-            Exit = 1 << 3
+            Exit = 1 << 3,
             #endif
             #ifdef CORRADE_TARGET_EMSCRIPTEN
-            TextInputActive = 1 << 4
+            TextInputActive = 1 << 4,
             #endif
+            InputCoalescing = 1 << 5,
+            OnDemand = 1 << 6,
+            FullRedraw = 1 << 7
         };
 
         typedef Containers::EnumSet<Flag> Flags;
         CORRADE_ENUMSET_FRIEND_OPERATORS(Flags)
 
+        #ifdef CORRADE_TARGET_EMSCRIPTEN
+        void animationFrame();
+        #endif
+
         #ifndef CORRADE_TARGET_EMSCRIPTEN
         SDL_Window* _window;
         SDL_GLContext _glContext;
         UnsignedInt _minimalLoopPeriod;
+        FramePacer _framePacer;
         #else
         SDL_Surface* _glContext;
+        Double _lastAnimationFrame{};
+        AnimationFrameStatistics _animationFrameStatistics{};
         #endif
 
         std::unique_ptr<Platform::Context> _context;
+        std::vector<Vector2i> _relativePositionHistory;
+        Range2Di _damage, _redrawDamage;
 
         Flags _flags;
 };
@@ -1418,6 +1590,20 @@ class Sdl2Application::MouseMoveEvent: public Sdl2Application::InputEvent {
          */
         constexpr Vector2i relativePosition() const { return _relativePosition; }
 
+        /**
+         * @brief Relative positions of coalesced events
+         *
+         * If @ref Sdl2Application::setInputCoalescing() "input coalescing"
+         * is enabled, contains relative position of each mouse move event
+         * merged into this one, in order. Their sum is equal to
+         * @ref relativePosition(). If input coalescing is disabled, the
+         * view is empty. The data are valid only for the duration of the
+         * event handler.
+         */
+        Containers::ArrayView<const Vector2i> relativePositionHistory() const {
+            return _relativePositionHistory;
+        }
+
         /** @brief Mouse buttons */
         constexpr Buttons buttons() const { return _buttons; }
 
@@ -1429,9 +1615,10 @@ class Sdl2Application::MouseMoveEvent: public Sdl2Application::InputEvent {
         Modifiers modifiers();
 
     private:
-        constexpr MouseMoveEvent(const Vector2i& position, const Vector2i& relativePosition, Buttons buttons): _position{position}, _relativePosition{relativePosition}, _buttons{buttons}, _modifiersLoaded{false} {}
+        constexpr MouseMoveEvent(const Vector2i& position, const Vector2i& relativePosition, Buttons buttons, Containers::ArrayView<const Vector2i> relativePositionHistory = nullptr): _position{position}, _relativePosition{relativePosition}, _relativePositionHistory{relativePositionHistory}, _buttons{buttons}, _modifiersLoaded{false} {}
 
         const Vector2i _position, _relativePosition;
+        const Containers::ArrayView<const Vector2i> _relativePositionHistory;
         const Buttons _buttons;
         bool _modifiersLoaded;
         Modifiers _modifiers;
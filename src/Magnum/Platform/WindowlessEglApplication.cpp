@@ -25,6 +25,10 @@
 
 #include "WindowlessEglApplication.h"
 
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/Debug.h>
 
@@ -35,11 +39,99 @@
 
 namespace Magnum { namespace Platform {
 
+namespace {
+    /* eglTerminate() destroys all contexts on given display, so the
+       displays are reference-counted to allow more than one context on the
+       same device, possibly each living in a different thread */
+    std::mutex displayMutex;
+    std::unordered_map<EGLDisplay, UnsignedInt> displayReferences;
+
+    bool acquireDisplay(const EGLDisplay display) {
+        std::lock_guard<std::mutex> lock{displayMutex};
+        UnsignedInt& references = displayReferences[display];
+        if(!references && !eglInitialize(display, nullptr, nullptr)) {
+            displayReferences.erase(display);
+            return false;
+        }
+        ++references;
+        return true;
+    }
+
+    void releaseDisplay(const EGLDisplay display) {
+        std::lock_guard<std::mutex> lock{displayMutex};
+        const auto found = displayReferences.find(display);
+        if(found == displayReferences.end() || --found->second) return;
+        displayReferences.erase(found);
+        eglTerminate(display);
+    }
+
+    #if defined(EGL_EXT_device_base) && defined(EGL_EXT_platform_base)
+    bool hasClientExtension(const char* const extension) {
+        /* Returns nullptr if EGL_EXT_client_extensions isn't supported */
+        const char* extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+        if(!extensions) return false;
+
+        const std::size_t length = std::strlen(extension);
+        while((extensions = std::strstr(extensions, extension))) {
+            if(extensions[length] == ' ' || extensions[length] == '\0')
+                return true;
+            extensions += length;
+        }
+        return false;
+    }
+
+    std::vector<EGLDeviceEXT> queryDevices() {
+        if(!hasClientExtension("EGL_EXT_device_enumeration") && !hasClientExtension("EGL_EXT_device_base"))
+            return {};
+
+        auto eglQueryDevices = reinterpret_cast<PFNEGLQUERYDEVICESEXTPROC>(eglGetProcAddress("eglQueryDevicesEXT"));
+        if(!eglQueryDevices) return {};
+
+        EGLint count;
+        if(!eglQueryDevices(0, nullptr, &count) || !count) return {};
+        std::vector<EGLDeviceEXT> devices(count);
+        if(!eglQueryDevices(count, devices.data(), &count)) return {};
+        devices.resize(count);
+        return devices;
+    }
+    #endif
+}
+
+UnsignedInt WindowlessEglContext::deviceCount() {
+    #if defined(EGL_EXT_device_base) && defined(EGL_EXT_platform_base)
+    return queryDevices().size();
+    #else
+    return 0;
+    #endif
+}
+
 WindowlessEglContext::WindowlessEglContext(const Configuration& configuration, Context*) {
+    /* Get display for given device, if requested */
+    if(configuration.device() != ~UnsignedInt{}) {
+        #if defined(EGL_EXT_device_base) && defined(EGL_EXT_platform_base) && defined(EGL_PLATFORM_DEVICE_EXT)
+        const std::vector<EGLDeviceEXT> devices = queryDevices();
+        if(configuration.device() >= devices.size()) {
+            Error() << "Platform::WindowlessEglApplication::tryCreateContext(): requested EGL device" << configuration.device() << "but only" << devices.size() << "found";
+            return;
+        }
+
+        auto eglGetPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+        if(!eglGetPlatformDisplay || !hasClientExtension("EGL_EXT_platform_device")) {
+            Error() << "Platform::WindowlessEglApplication::tryCreateContext(): EGL_EXT_platform_device is not supported";
+            return;
+        }
+
+        _display = eglGetPlatformDisplay(EGL_PLATFORM_DEVICE_EXT, devices[configuration.device()], nullptr);
+        #else
+        Error() << "Platform::WindowlessEglApplication::tryCreateContext(): EGL device selection is not supported by the EGL headers";
+        return;
+        #endif
+    } else _display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
     /* Initialize */
-    _display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
-    if(!eglInitialize(_display, nullptr, nullptr)) {
+    if(!_display || !acquireDisplay(_display)) {
         Error() << "Platform::WindowlessEglApplication::tryCreateContext(): cannot initialize EGL:" << Implementation::eglErrorString(eglGetError());
+        _display = {};
         return;
     }
 
@@ -96,7 +188,7 @@ WindowlessEglContext::WindowlessEglContext(const Configuration& configuration, C
         EGL_NONE
     };
 
-    if(!(_context = eglCreateContext(_display, config, EGL_NO_CONTEXT, attributes))) {
+    if(!(_context = eglCreateContext(_display, config, configuration.sharedContext(), attributes))) {
         Error() << "Platform::WindowlessEglApplication::tryCreateContext(): cannot create EGL context:" << Implementation::eglErrorString(eglGetError());
         return;
     }
@@ -109,7 +201,7 @@ WindowlessEglContext::WindowlessEglContext(WindowlessEglContext&& other): _displ
 
 WindowlessEglContext::~WindowlessEglContext() {
     if(_context) eglDestroyContext(_display, _context);
-    if(_display) eglTerminate(_display);
+    if(_display) releaseDisplay(_display);
 }
 
 WindowlessEglContext& WindowlessEglContext::operator=(WindowlessEglContext && other) {
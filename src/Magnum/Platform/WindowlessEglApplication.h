@@ -57,11 +57,48 @@ Meant to be used when there is a need to manage (multiple) GL contexts
 manually. See @ref platform-windowless-contexts for more information. If no
 other application header is included, this class is also aliased to
 `Platform::WindowlessGLContext`.
+
+## Multiple GPUs
+
+If the driver supports `EGL_EXT_device_enumeration`
+and `EGL_EXT_platform_device`, the context can be
+created on a particular GPU using @ref Configuration::setDevice(), see
+@ref deviceCount() for the count of available devices. Contexts created on
+different threads are independent and, with @ref MAGNUM_BUILD_MULTITHREADED
+enabled (the default), each thread has its own @ref Context::current(), so a
+single process can render on all GPUs in parallel:
+
+@code
+std::vector<std::thread> threads;
+for(UnsignedInt i = 0; i != Platform::WindowlessEglContext::deviceCount(); ++i)
+    threads.emplace_back([i]() {
+        Platform::WindowlessEglContext glContext{
+            Platform::WindowlessEglContext::Configuration{}.setDevice(i)};
+        glContext.makeCurrent();
+        Platform::Context context{0, nullptr};
+
+        // render thumbnails on GPU i ...
+    });
+for(std::thread& thread: threads) thread.join();
+@endcode
+
+The EGL display of each device is reference-counted, so destroying one
+context doesn't affect other contexts on the same device.
 */
 class WindowlessEglContext {
     public:
         class Configuration;
 
+        /**
+         * @brief Count of available EGL devices
+         *
+         * Returns `0` if `EGL_EXT_device_enumeration`
+         * is not supported, in which case only the default display can be
+         * used.
+         * @see @ref Configuration::setDevice()
+         */
+        static UnsignedInt deviceCount();
+
         /**
          * @brief Constructor
          * @param configuration Context configuration
@@ -111,6 +148,14 @@ class WindowlessEglContext {
          */
         bool makeCurrent();
 
+        /**
+         * @brief Underlying OpenGL context
+         *
+         * Use in case you need to share the context with another one, see
+         * @ref Configuration::setSharedContext().
+         */
+        EGLContext glContext() { return _context; }
+
     private:
         EGLDisplay _display{};
         EGLContext _context{};
@@ -162,8 +207,54 @@ class WindowlessEglContext::Configuration {
             return *this;
         }
 
+        /**
+         * @brief Device ID
+         *
+         * @see @ref setDevice()
+         */
+        UnsignedInt device() const { return _device; }
+
+        /**
+         * @brief Set device ID
+         * @return Reference to self (for method chaining)
+         *
+         * Index of the EGL device to create the context on, expected to be
+         * less than @ref WindowlessEglContext::deviceCount(). The value
+         * `~UnsignedInt{}` (the default) means the default display.
+         */
+        Configuration& setDevice(UnsignedInt id) {
+            _device = id;
+            return *this;
+        }
+
+        /**
+         * @brief Shared context
+         *
+         * @see @ref setSharedContext()
+         */
+        EGLContext sharedContext() const { return _sharedContext; }
+
+        /**
+         * @brief Set shared context
+         * @return Reference to self (for method chaining)
+         *
+         * When set, the created context will share OpenGL objects such as
+         * textures and buffers with @p context. Get the context of the main
+         * application window using `eglGetCurrentContext()` or the context of another windowless
+         * context using @ref WindowlessEglContext::glContext(). Default is
+         * no sharing. The shared context is expected to be created on the
+         * same display, i.e. with the same @ref setDevice().
+         * @see @ref BackgroundUploader
+         */
+        Configuration& setSharedContext(EGLContext context) {
+            _sharedContext = context;
+            return *this;
+        }
+
     private:
         Flags _flags;
+        EGLContext _sharedContext{};
+        UnsignedInt _device{~UnsignedInt{}};
 };
 
 /**
@@ -123,6 +123,14 @@ class WindowlessGlxContext {
          */
         bool makeCurrent();
 
+        /**
+         * @brief Underlying OpenGL context
+         *
+         * Use in case you need to share the context with another one, see
+         * @ref Configuration::setSharedContext().
+         */
+        GLXContext glContext() { return _context; }
+
     private:
         Display* _display{};
         GLXPbuffer _pbuffer{};
@@ -175,8 +183,32 @@ class WindowlessGlxContext::Configuration {
             return *this;
         }
 
+        /**
+         * @brief Shared context
+         *
+         * @see @ref setSharedContext()
+         */
+        GLXContext sharedContext() const { return _sharedContext; }
+
+        /**
+         * @brief Set shared context
+         * @return Reference to self (for method chaining)
+         *
+         * When set, the created context will share OpenGL objects such as
+         * textures and buffers with @p context. Get the context of the main
+         * application window using `glXGetCurrentContext()` or the context of another windowless
+         * context using @ref WindowlessGlxContext::glContext(). Default is
+         * no sharing.
+         * @see @ref BackgroundUploader
+         */
+        Configuration& setSharedContext(GLXContext context) {
+            _sharedContext = context;
+            return *this;
+        }
+
     private:
         Flags _flags;
+        GLXContext _sharedContext{};
 };
 
 /**
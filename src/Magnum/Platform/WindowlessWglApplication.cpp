@@ -141,7 +141,7 @@ WindowlessWglContext::WindowlessWglContext(const Configuration& configuration, C
         #endif
         0
     };
-    _context = wglCreateContextAttribsARB(_deviceContext, nullptr, contextAttributes);
+    _context = wglCreateContextAttribsARB(_deviceContext, configuration.sharedContext(), contextAttributes);
 
     #ifndef MAGNUM_TARGET_GLES
     /* Fall back to (forward compatible) GL 2.1 if core context creation fails */
@@ -152,7 +152,7 @@ WindowlessWglContext::WindowlessWglContext(const Configuration& configuration, C
             WGL_CONTEXT_FLAGS_ARB, int(configuration.flags()),
             0
         };
-        _context = wglCreateContextAttribsARB(_deviceContext, nullptr, fallbackContextAttributes);
+        _context = wglCreateContextAttribsARB(_deviceContext, configuration.sharedContext(), fallbackContextAttributes);
 
     /* Fall back to (forward compatible) GL 2.1 if we are on binary
        NVidia/AMD/Intel drivers on Windows. Instead of creating forward-compatible
@@ -187,7 +187,7 @@ WindowlessWglContext::WindowlessWglContext(const Configuration& configuration, C
                 WGL_CONTEXT_FLAGS_ARB, int(configuration.flags()),
                 0
             };
-            _context = wglCreateContextAttribsARB(_deviceContext, nullptr, fallbackContextAttributes);
+            _context = wglCreateContextAttribsARB(_deviceContext, configuration.sharedContext(), fallbackContextAttributes);
         }
     }
     #endif
@@ -124,6 +124,14 @@ class WindowlessWglContext {
          */
         bool makeCurrent();
 
+        /**
+         * @brief Underlying OpenGL context
+         *
+         * Use in case you need to share the context with another one, see
+         * @ref Configuration::setSharedContext().
+         */
+        HGLRC glContext() { return _context; }
+
     private:
         HWND _window{};
         HDC _deviceContext{};
@@ -176,8 +184,32 @@ class WindowlessWglContext::Configuration {
             return *this;
         }
 
+        /**
+         * @brief Shared context
+         *
+         * @see @ref setSharedContext()
+         */
+        HGLRC sharedContext() const { return _sharedContext; }
+
+        /**
+         * @brief Set shared context
+         * @return Reference to self (for method chaining)
+         *
+         * When set, the created context will share OpenGL objects such as
+         * textures and buffers with @p context. Get the context of the main
+         * application window using `wglGetCurrentContext()` or the context of another windowless
+         * context using @ref WindowlessWglContext::glContext(). Default is
+         * no sharing.
+         * @see @ref BackgroundUploader
+         */
+        Configuration& setSharedContext(HGLRC context) {
+            _sharedContext = context;
+            return *this;
+        }
+
     private:
         Flags _flags;
+        HGLRC _sharedContext{};
 };
 
 /**
@@ -253,6 +253,12 @@ MagnumInfo::MagnumInfo(const Arguments& arguments): Platform::WindowlessApplicat
     #ifdef MAGNUM_BUILD_MULTITHREADED
     Debug() << "    MAGNUM_BUILD_MULTITHREADED";
     #endif
+    #ifdef MAGNUM_BUILD_INSTRUMENTATION
+    Debug() << "    MAGNUM_BUILD_INSTRUMENTATION";
+    #endif
+    #ifdef MAGNUM_BUILD_MATH_SIMD
+    Debug() << "    MAGNUM_BUILD_MATH_SIMD";
+    #endif
     #ifdef MAGNUM_TARGET_GLES
     Debug() << "    MAGNUM_TARGET_GLES";
     #endif
@@ -120,6 +120,19 @@ class MAGNUM_EXPORT PrimitiveQuery: public AbstractQuery {
             #endif
         };
 
+        /**
+         * @brief Create multiple primitive queries at once
+         * @param count         Query count
+         * @param target        Query target
+         *
+         * Equivalent to constructing @p count instances using
+         * @ref PrimitiveQuery(Target), but creates all OpenGL objects using a single
+         * @fn_gl{CreateQueries} (or @fn_gl{GenQueries}) call.
+         */
+        static std::vector<PrimitiveQuery> createArray(std::size_t count, Target target) {
+            return createArrayInternal<PrimitiveQuery>(count, target);
+        }
+
         /**
          * @brief Wrap existing OpenGL primitive query object
          * @param id            OpenGL primitive query ID
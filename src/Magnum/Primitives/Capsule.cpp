@@ -91,14 +91,15 @@ Trade::MeshData2D Capsule2D::wireframe(UnsignedInt hemisphereRings, UnsignedInt
     return Trade::MeshData2D{MeshPrimitive::Lines, std::move(indices), {std::move(positions)}, {}, {}, nullptr};
 }
 
-Trade::MeshData3D Capsule3D::solid(UnsignedInt hemisphereRings, UnsignedInt cylinderRings, UnsignedInt segments, Float halfLength, TextureCoords textureCoords) {
-    CORRADE_ASSERT(hemisphereRings >= 1 && cylinderRings >= 1 && segments >= 3, "Capsule must have at least one hemisphere ring, one cylinder ring and three segments",
-        (Trade::MeshData3D{MeshPrimitive::Triangles, {}, {}, {}, {}, {}, nullptr}));
+namespace {
 
-    Implementation::Spheroid capsule(segments, textureCoords == TextureCoords::Generate ?
+Implementation::Spheroid::TextureCoords spheroidTextureCoords(const Capsule3D::TextureCoords textureCoords) {
+    return textureCoords == Capsule3D::TextureCoords::Generate ?
         Implementation::Spheroid::TextureCoords::Generate :
-        Implementation::Spheroid::TextureCoords::DontGenerate);
+        Implementation::Spheroid::TextureCoords::DontGenerate;
+}
 
+void solidInternal(Implementation::Spheroid& capsule, const UnsignedInt hemisphereRings, const UnsignedInt cylinderRings, const Float halfLength) {
     Float height = 2.0f+2.0f*halfLength;
     Float hemisphereTextureCoordsVIncrement = 1.0f/(hemisphereRings*height);
     Rad hemisphereRingAngleIncrement(Constants::piHalf()/hemisphereRings);
@@ -122,8 +123,38 @@ Trade::MeshData3D Capsule3D::solid(UnsignedInt hemisphereRings, UnsignedInt cyli
     capsule.bottomFaceRing();
     capsule.faceRings(hemisphereRings*2-2+cylinderRings);
     capsule.topFaceRing();
+}
 
-    return capsule.finalize();
+}
+
+Trade::MeshData3D Capsule3D::solid(UnsignedInt hemisphereRings, UnsignedInt cylinderRings, UnsignedInt segments, Float halfLength, TextureCoords textureCoords) {
+    CORRADE_ASSERT(hemisphereRings >= 1 && cylinderRings >= 1 && segments >= 3, "Capsule must have at least one hemisphere ring, one cylinder ring and three segments",
+        (Trade::MeshData3D{MeshPrimitive::Triangles, {}, {}, {}, {}, {}, nullptr}));
+
+    return Implementation::meshData(segments, spheroidTextureCoords(textureCoords), solidLayout(hemisphereRings, cylinderRings, segments, textureCoords), [&](Implementation::Spheroid& capsule) {
+        solidInternal(capsule, hemisphereRings, cylinderRings, halfLength);
+    });
+}
+
+InterleavedLayout Capsule3D::solidLayout(const UnsignedInt hemisphereRings, const UnsignedInt cylinderRings, const UnsignedInt segments, const TextureCoords textureCoords) {
+    CORRADE_ASSERT(hemisphereRings >= 1 && cylinderRings >= 1 && segments >= 3, "Primitives::Capsule3D::solidLayout(): capsule must have at least one hemisphere ring, one cylinder ring and three segments", {});
+
+    const Implementation::Spheroid::TextureCoords spheroidCoords = spheroidTextureCoords(textureCoords);
+    return Implementation::interleavedLayout(
+        2 + (hemisphereRings*2 - 1 + cylinderRings)*Implementation::Spheroid::ringVertexCount(segments, spheroidCoords),
+        (hemisphereRings*2 - 1 + cylinderRings)*segments*6, spheroidCoords);
+}
+
+void Capsule3D::solidInto(const UnsignedInt hemisphereRings, const UnsignedInt cylinderRings, const UnsignedInt segments, const Float halfLength, const TextureCoords textureCoords, const Containers::ArrayView<char> vertices, const Containers::ArrayView<char> indices) {
+    CORRADE_ASSERT(hemisphereRings >= 1 && cylinderRings >= 1 && segments >= 3, "Primitives::Capsule3D::solidInto(): capsule must have at least one hemisphere ring, one cylinder ring and three segments", );
+
+    const InterleavedLayout layout = solidLayout(hemisphereRings, cylinderRings, segments, textureCoords);
+    CORRADE_ASSERT(vertices.size() >= layout.vertexDataSize() && indices.size() >= layout.indexDataSize(),
+        "Primitives::Capsule3D::solidInto(): expected at least" << layout.vertexDataSize() << "bytes of vertex data and" << layout.indexDataSize() << "bytes of index data but got" << vertices.size() << "and" << indices.size(), );
+
+    Implementation::interleavedInto(segments, spheroidTextureCoords(textureCoords), layout, vertices, indices, [&](Implementation::Spheroid& capsule) {
+        solidInternal(capsule, hemisphereRings, cylinderRings, halfLength);
+    });
 }
 
 Trade::MeshData3D Capsule3D::wireframe(const UnsignedInt hemisphereRings, const UnsignedInt cylinderRings, const UnsignedInt segments, const Float halfLength) {
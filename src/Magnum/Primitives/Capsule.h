@@ -29,6 +29,9 @@
  * @brief Class @ref Magnum::Primitives::Capsule2D, @ref Magnum::Primitives::Capsule3D
  */
 
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Primitives/InterleavedLayout.h"
 #include "Magnum/Primitives/visibility.h"
 #include "Magnum/Trade/Trade.h"
 
@@ -81,9 +84,39 @@ class MAGNUM_PRIMITIVES_EXPORT Capsule3D {
          * Indexed @ref MeshPrimitive::Triangles with normals and optional 2D
          * texture coordinates. If texture coordinates are generated, vertices
          * of one segment are duplicated for texture wrapping.
+         * @see @ref solidInto()
          */
         static Trade::MeshData3D solid(UnsignedInt hemisphereRings, UnsignedInt cylinderRings, UnsignedInt segments, Float halfLength, TextureCoords textureCoords = TextureCoords::DontGenerate);
 
+        /**
+         * @brief Layout of interleaved solid capsule data
+         *
+         * Exact vertex and index count, vertex stride and index type of
+         * data written by @ref solidInto() with the same parameters. See
+         * @ref solid() for the parameter requirements.
+         */
+        static InterleavedLayout solidLayout(UnsignedInt hemisphereRings, UnsignedInt cylinderRings, UnsignedInt segments, TextureCoords textureCoords = TextureCoords::DontGenerate);
+
+        /**
+         * @brief Solid capsule into interleaved data
+         * @param[in] hemisphereRings Number of (face) rings for each
+         *      hemisphere. Must be larger or equal to 1.
+         * @param[in] cylinderRings Number of (face) rings for cylinder. Must
+         *      be larger or equal to 1.
+         * @param[in] segments  Number of (face) segments. Must be larger or
+         *      equal to 3.
+         * @param[in] halfLength Half the length of cylinder part
+         * @param[in] textureCoords Whether to generate texture coordinates
+         * @param[out] vertices Where to put interleaved vertex data
+         * @param[out] indices  Where to put index data
+         *
+         * Same geometry as @ref solid(), but written directly into
+         * @p vertices and @p indices with the layout given by
+         * @ref solidLayout(), without any intermediate allocations. See
+         * @ref InterleavedLayout for more information.
+         */
+        static void solidInto(UnsignedInt hemisphereRings, UnsignedInt cylinderRings, UnsignedInt segments, Float halfLength, TextureCoords textureCoords, Containers::ArrayView<char> vertices, Containers::ArrayView<char> indices);
+
         /**
          * @brief Wireframe capsule
          * @param hemisphereRings Number of (line) rings for each hemisphere.
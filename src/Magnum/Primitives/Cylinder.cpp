@@ -33,36 +33,75 @@
 
 namespace Magnum { namespace Primitives {
 
-Trade::MeshData3D Cylinder::solid(const UnsignedInt rings, const UnsignedInt segments, const Float halfLength, const Flags flags) {
-    CORRADE_ASSERT(rings >= 1 && segments >= 3, "Primitives::Cylinder::solid(): cylinder must have at least one ring and three segments",
-        (Trade::MeshData3D{MeshPrimitive::Triangles, {}, {}, {}, {}, {}, nullptr}));
+namespace {
 
-    Implementation::Spheroid cylinder(segments, flags & Flag::GenerateTextureCoords ? Implementation::Spheroid::TextureCoords::Generate : Implementation::Spheroid::TextureCoords::DontGenerate);
+Implementation::Spheroid::TextureCoords spheroidTextureCoords(const Cylinder::Flags flags) {
+    return flags & Cylinder::Flag::GenerateTextureCoords ?
+        Implementation::Spheroid::TextureCoords::Generate :
+        Implementation::Spheroid::TextureCoords::DontGenerate;
+}
 
+void solidInternal(Implementation::Spheroid& cylinder, const UnsignedInt rings, const UnsignedInt segments, const Float halfLength, const Cylinder::Flags flags) {
     const Float length = 2.0f*halfLength;
-    const Float textureCoordsV = flags & Flag::CapEnds ? 1.0f/(length+2.0f) : 0.0f;
+    const Float textureCoordsV = flags & Cylinder::Flag::CapEnds ? 1.0f/(length+2.0f) : 0.0f;
 
     /* Bottom cap */
-    if(flags & Flag::CapEnds) {
+    if(flags & Cylinder::Flag::CapEnds) {
         cylinder.capVertex(-halfLength, -1.0f, 0.0f);
         cylinder.capVertexRing(-halfLength, textureCoordsV, Vector3::yAxis(-1.0f));
     }
 
     /* Vertex rings */
-    cylinder.cylinderVertexRings(rings+1, -halfLength, length/rings, textureCoordsV, length/(rings*(flags & Flag::CapEnds ? length + 2.0f : length)));
+    cylinder.cylinderVertexRings(rings+1, -halfLength, length/rings, textureCoordsV, length/(rings*(flags & Cylinder::Flag::CapEnds ? length + 2.0f : length)));
 
     /* Top cap */
-    if(flags & Flag::CapEnds) {
+    if(flags & Cylinder::Flag::CapEnds) {
         cylinder.capVertexRing(halfLength, 1.0f - textureCoordsV, Vector3::yAxis(1.0f));
         cylinder.capVertex(halfLength, 1.0f, 1.0f);
     }
 
     /* Faces */
-    if(flags & Flag::CapEnds) cylinder.bottomFaceRing();
-    cylinder.faceRings(rings, flags & Flag::CapEnds ? (1 + segments) : 0);
-    if(flags & Flag::CapEnds) cylinder.topFaceRing();
+    if(flags & Cylinder::Flag::CapEnds) cylinder.bottomFaceRing();
+    cylinder.faceRings(rings, flags & Cylinder::Flag::CapEnds ? (1 + segments) : 0);
+    if(flags & Cylinder::Flag::CapEnds) cylinder.topFaceRing();
+}
 
-    return cylinder.finalize();
+}
+
+Trade::MeshData3D Cylinder::solid(const UnsignedInt rings, const UnsignedInt segments, const Float halfLength, const Flags flags) {
+    CORRADE_ASSERT(rings >= 1 && segments >= 3, "Primitives::Cylinder::solid(): cylinder must have at least one ring and three segments",
+        (Trade::MeshData3D{MeshPrimitive::Triangles, {}, {}, {}, {}, {}, nullptr}));
+
+    return Implementation::meshData(segments, spheroidTextureCoords(flags), solidLayout(rings, segments, flags), [&](Implementation::Spheroid& cylinder) {
+        solidInternal(cylinder, rings, segments, halfLength, flags);
+    });
+}
+
+InterleavedLayout Cylinder::solidLayout(const UnsignedInt rings, const UnsignedInt segments, const Flags flags) {
+    CORRADE_ASSERT(rings >= 1 && segments >= 3, "Primitives::Cylinder::solidLayout(): cylinder must have at least one ring and three segments", {});
+
+    const Implementation::Spheroid::TextureCoords textureCoords = spheroidTextureCoords(flags);
+    const UnsignedInt ringVertexCount = Implementation::Spheroid::ringVertexCount(segments, textureCoords);
+    UnsignedInt vertexCount = (rings + 1)*ringVertexCount;
+    UnsignedInt indexCount = rings*segments*6;
+    if(flags & Flag::CapEnds) {
+        vertexCount += 2*(1 + ringVertexCount);
+        indexCount += segments*6;
+    }
+
+    return Implementation::interleavedLayout(vertexCount, indexCount, textureCoords);
+}
+
+void Cylinder::solidInto(const UnsignedInt rings, const UnsignedInt segments, const Float halfLength, const Flags flags, const Containers::ArrayView<char> vertices, const Containers::ArrayView<char> indices) {
+    CORRADE_ASSERT(rings >= 1 && segments >= 3, "Primitives::Cylinder::solidInto(): cylinder must have at least one ring and three segments", );
+
+    const InterleavedLayout layout = solidLayout(rings, segments, flags);
+    CORRADE_ASSERT(vertices.size() >= layout.vertexDataSize() && indices.size() >= layout.indexDataSize(),
+        "Primitives::Cylinder::solidInto(): expected at least" << layout.vertexDataSize() << "bytes of vertex data and" << layout.indexDataSize() << "bytes of index data but got" << vertices.size() << "and" << indices.size(), );
+
+    Implementation::interleavedInto(segments, spheroidTextureCoords(flags), layout, vertices, indices, [&](Implementation::Spheroid& cylinder) {
+        solidInternal(cylinder, rings, segments, halfLength, flags);
+    });
 }
 
 Trade::MeshData3D Cylinder::wireframe(const UnsignedInt rings, const UnsignedInt segments, const Float halfLength) {
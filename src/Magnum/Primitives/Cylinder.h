@@ -29,9 +29,11 @@
  * @brief Class @ref Magnum::Primitives::Cylinder
  */
 
+#include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/EnumSet.h>
 
 #include "Magnum/Magnum.h"
+#include "Magnum/Primitives/InterleavedLayout.h"
 #include "Magnum/Primitives/visibility.h"
 #include "Magnum/Trade/Trade.h"
 
@@ -74,9 +76,37 @@ class MAGNUM_PRIMITIVES_EXPORT Cylinder {
          * texture coordinates and optional capped ends. If texture coordinates
          * are generated, vertices of one segment are duplicated for texture
          * wrapping.
+         * @see @ref solidInto()
          */
         static Trade::MeshData3D solid(UnsignedInt rings, UnsignedInt segments, Float halfLength, Flags flags = Flags());
 
+        /**
+         * @brief Layout of interleaved solid cylinder data
+         *
+         * Exact vertex and index count, vertex stride and index type of
+         * data written by @ref solidInto() with the same parameters. See
+         * @ref solid() for the parameter requirements.
+         */
+        static InterleavedLayout solidLayout(UnsignedInt rings, UnsignedInt segments, Flags flags = Flags());
+
+        /**
+         * @brief Solid cylinder into interleaved data
+         * @param[in] rings     Number of (face) rings. Must be larger or
+         *      equal to 1.
+         * @param[in] segments  Number of (face) segments. Must be larger or
+         *      equal to 3.
+         * @param[in] halfLength Half the cylinder length
+         * @param[in] flags     Flags
+         * @param[out] vertices Where to put interleaved vertex data
+         * @param[out] indices  Where to put index data
+         *
+         * Same geometry as @ref solid(), but written directly into
+         * @p vertices and @p indices with the layout given by
+         * @ref solidLayout(), without any intermediate allocations. See
+         * @ref InterleavedLayout for more information.
+         */
+        static void solidInto(UnsignedInt rings, UnsignedInt segments, Float halfLength, Flags flags, Containers::ArrayView<char> vertices, Containers::ArrayView<char> indices);
+
         /**
          * @brief Wireframe cylinder
          * @param rings         Number of (line) rings. Must be larger or equal
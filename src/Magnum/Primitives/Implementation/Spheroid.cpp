@@ -25,21 +25,40 @@
 
 #include "Spheroid.h"
 
+#include <cstring>
+
 #include "Magnum/Math/Functions.h"
-#include "Magnum/Math/Color.h"
-#include "Magnum/Mesh.h"
-#include "Magnum/Trade/MeshData3D.h"
+#include "Magnum/Math/Vector3.h"
 
 namespace Magnum { namespace Primitives { namespace Implementation {
 
-Spheroid::Spheroid(UnsignedInt segments, TextureCoords textureCoords): segments(segments), textureCoords(textureCoords) {}
+Spheroid::Spheroid(UnsignedInt segments, TextureCoords textureCoords, char* positions, char* normals, char* textureCoords2D, std::size_t positionStride, std::size_t normalStride, std::size_t textureCoordsStride, void* indices, Mesh::IndexType indexType): segments(segments), textureCoords(textureCoords), _positions{positions}, _normals{normals}, _textureCoords2D{textureCoords2D}, _positionStride{positionStride}, _normalStride{normalStride}, _textureCoordsStride{textureCoordsStride}, _indices{indices}, _indexType{indexType} {}
 
-void Spheroid::capVertex(Float y, Float normalY, Float textureCoordsV) {
-    positions.emplace_back(0.0f, y, 0.0f);
-    normals.emplace_back(0.0f, normalY, 0.0f);
+void Spheroid::vertex(const Vector3& position, const Vector3& normal, const Vector2& textureCoords) {
+    std::memcpy(_positions + _vertexCount*_positionStride, position.data(), sizeof(Vector3));
+    std::memcpy(_normals + _vertexCount*_normalStride, normal.data(), sizeof(Vector3));
+    if(this->textureCoords == TextureCoords::Generate)
+        std::memcpy(_textureCoords2D + _vertexCount*_textureCoordsStride, textureCoords.data(), sizeof(Vector2));
+    ++_vertexCount;
+}
 
-    if(textureCoords == TextureCoords::Generate)
-        textureCoords2D.emplace_back(0.5, textureCoordsV);
+void Spheroid::index(const UnsignedInt index) {
+    switch(_indexType) {
+        case Mesh::IndexType::UnsignedByte:
+            static_cast<UnsignedByte*>(_indices)[_indexCount] = index;
+            break;
+        case Mesh::IndexType::UnsignedShort:
+            static_cast<UnsignedShort*>(_indices)[_indexCount] = index;
+            break;
+        case Mesh::IndexType::UnsignedInt:
+            static_cast<UnsignedInt*>(_indices)[_indexCount] = index;
+            break;
+    }
+    ++_indexCount;
+}
+
+void Spheroid::capVertex(Float y, Float normalY, Float textureCoordsV) {
+    vertex({0.0f, y, 0.0f}, {0.0f, normalY, 0.0f}, {0.5f, textureCoordsV});
 }
 
 void Spheroid::hemisphereVertexRings(UnsignedInt count, Float centerY, Rad startRingAngle, Rad ringAngleIncrement, Float startTextureCoordsV, Float textureCoordsVIncrement) {
@@ -52,18 +71,17 @@ void Spheroid::hemisphereVertexRings(UnsignedInt count, Float centerY, Rad start
 
         for(UnsignedInt j = 0; j != segments; ++j) {
             Rad segmentAngle = Float(j)*segmentAngleIncrement;
-            positions.emplace_back(x*Math::sin(segmentAngle), centerY+y, z*Math::cos(segmentAngle));
-            normals.emplace_back(x*Math::sin(segmentAngle), y, z*Math::cos(segmentAngle));
-
-            if(textureCoords == TextureCoords::Generate)
-                textureCoords2D.emplace_back(j*1.0f/segments, startTextureCoordsV + i*textureCoordsVIncrement);
+            vertex({x*Math::sin(segmentAngle), centerY+y, z*Math::cos(segmentAngle)},
+                   {x*Math::sin(segmentAngle), y, z*Math::cos(segmentAngle)},
+                   {j*1.0f/segments, startTextureCoordsV + i*textureCoordsVIncrement});
         }
 
         /* Duplicate first segment in the ring for additional vertex for texture coordinate */
         if(textureCoords == TextureCoords::Generate) {
-            positions.push_back(positions[positions.size()-segments]);
-            normals.push_back(normals[normals.size()-segments]);
-            textureCoords2D.emplace_back(1.0f, startTextureCoordsV + i*textureCoordsVIncrement);
+            const Rad segmentAngle{0.0f};
+            vertex({x*Math::sin(segmentAngle), centerY+y, z*Math::cos(segmentAngle)},
+                   {x*Math::sin(segmentAngle), y, z*Math::cos(segmentAngle)},
+                   {1.0f, startTextureCoordsV + i*textureCoordsVIncrement});
         }
     }
 }
@@ -73,18 +91,17 @@ void Spheroid::cylinderVertexRings(UnsignedInt count, Float startY, Float yIncre
     for(UnsignedInt i = 0; i != count; ++i) {
         for(UnsignedInt j = 0; j != segments; ++j) {
             Rad segmentAngle = Float(j)*segmentAngleIncrement;
-            positions.emplace_back(Math::sin(segmentAngle), startY, Math::cos(segmentAngle));
-            normals.emplace_back(Math::sin(segmentAngle), 0.0f, Math::cos(segmentAngle));
-
-            if(textureCoords == TextureCoords::Generate)
-                textureCoords2D.emplace_back(j*1.0f/segments, startTextureCoordsV + i*textureCoordsVIncrement);
+            vertex({Math::sin(segmentAngle), startY, Math::cos(segmentAngle)},
+                   {Math::sin(segmentAngle), 0.0f, Math::cos(segmentAngle)},
+                   {j*1.0f/segments, startTextureCoordsV + i*textureCoordsVIncrement});
         }
 
         /* Duplicate first segment in the ring for additional vertex for texture coordinate */
         if(textureCoords == TextureCoords::Generate) {
-            positions.push_back(positions[positions.size()-segments]);
-            normals.push_back(normals[normals.size()-segments]);
-            textureCoords2D.emplace_back(1.0f, startTextureCoordsV + i*textureCoordsVIncrement);
+            const Rad segmentAngle{0.0f};
+            vertex({Math::sin(segmentAngle), startY, Math::cos(segmentAngle)},
+                   {Math::sin(segmentAngle), 0.0f, Math::cos(segmentAngle)},
+                   {1.0f, startTextureCoordsV + i*textureCoordsVIncrement});
         }
 
         startY += yIncrement;
@@ -94,19 +111,19 @@ void Spheroid::cylinderVertexRings(UnsignedInt count, Float startY, Float yIncre
 void Spheroid::bottomFaceRing() {
     for(UnsignedInt j = 0; j != segments; ++j) {
         /* Bottom vertex */
-        indices.push_back(0);
+        index(0);
 
         /* Top right vertex */
-        indices.push_back((j != segments-1 || textureCoords == TextureCoords::Generate) ?
+        index((j != segments-1 || textureCoords == TextureCoords::Generate) ?
             j+2 : 1);
 
         /* Top left vertex */
-        indices.push_back(j+1);
+        index(j+1);
     }
 }
 
 void Spheroid::faceRings(UnsignedInt count, UnsignedInt offset) {
-    UnsignedInt vertexSegments = segments + (textureCoords == TextureCoords::Generate ? 1 : 0);
+    UnsignedInt vertexSegments = ringVertexCount(segments, textureCoords);
 
     for(UnsignedInt i = 0; i != count; ++i) {
         for(UnsignedInt j = 0; j != segments; ++j) {
@@ -116,29 +133,29 @@ void Spheroid::faceRings(UnsignedInt count, UnsignedInt offset) {
             UnsignedInt topLeft = bottomLeft+vertexSegments;
             UnsignedInt topRight = bottomRight+vertexSegments;
 
-            indices.push_back(bottomLeft);
-            indices.push_back(bottomRight);
-            indices.push_back(topRight);
-            indices.push_back(bottomLeft);
-            indices.push_back(topRight);
-            indices.push_back(topLeft);
+            index(bottomLeft);
+            index(bottomRight);
+            index(topRight);
+            index(bottomLeft);
+            index(topRight);
+            index(topLeft);
         }
     }
 }
 
 void Spheroid::topFaceRing() {
-    UnsignedInt vertexSegments = segments + (textureCoords == TextureCoords::Generate ? 1 : 0);
+    UnsignedInt vertexSegments = ringVertexCount(segments, textureCoords);
 
     for(UnsignedInt j = 0; j != segments; ++j) {
         /* Bottom left vertex */
-        indices.push_back(normals.size()-vertexSegments+j-1);
+        index(_vertexCount-vertexSegments+j-1);
 
         /* Bottom right vertex */
-        indices.push_back((j != segments-1 || textureCoords == TextureCoords::Generate) ?
-            normals.size()-vertexSegments+j : normals.size()-segments-1);
+        index((j != segments-1 || textureCoords == TextureCoords::Generate) ?
+            _vertexCount-vertexSegments+j : _vertexCount-segments-1);
 
         /* Top vertex */
-        indices.push_back(normals.size()-1);
+        index(_vertexCount-1);
     }
 }
 
@@ -147,24 +164,25 @@ void Spheroid::capVertexRing(Float y, Float textureCoordsV, const Vector3& norma
 
     for(UnsignedInt i = 0; i != segments; ++i) {
         Rad segmentAngle = Float(i)*segmentAngleIncrement;
-        positions.emplace_back(Math::sin(segmentAngle), y, Math::cos(segmentAngle));
-        normals.push_back(normal);
-
-        if(textureCoords == TextureCoords::Generate)
-            textureCoords2D.emplace_back(i*1.0f/segments, textureCoordsV);
+        vertex({Math::sin(segmentAngle), y, Math::cos(segmentAngle)}, normal,
+               {i*1.0f/segments, textureCoordsV});
     }
 
     /* Duplicate first segment in the ring for additional vertex for texture coordinate */
     if(textureCoords == TextureCoords::Generate) {
-        positions.push_back(positions[positions.size()-segments]);
-        normals.push_back(normal);
-        textureCoords2D.emplace_back(1.0f, textureCoordsV);
+        const Rad segmentAngle{0.0f};
+        vertex({Math::sin(segmentAngle), y, Math::cos(segmentAngle)}, normal,
+               {1.0f, textureCoordsV});
     }
 }
 
-Trade::MeshData3D Spheroid::finalize() {
-    return Trade::MeshData3D{MeshPrimitive::Triangles, std::move(indices), {std::move(positions)}, {std::move(normals)},
-        textureCoords == TextureCoords::Generate ? std::vector<std::vector<Vector2>>{std::move(textureCoords2D)} : std::vector<std::vector<Vector2>>(), {}, nullptr};
+InterleavedLayout interleavedLayout(const UnsignedInt vertexCount, const UnsignedInt indexCount, const Spheroid::TextureCoords textureCoords) {
+    Mesh::IndexType indexType;
+    if(vertexCount <= 256) indexType = Mesh::IndexType::UnsignedByte;
+    else if(vertexCount <= 65536) indexType = Mesh::IndexType::UnsignedShort;
+    else indexType = Mesh::IndexType::UnsignedInt;
+
+    return {vertexCount, indexCount, 2*sizeof(Vector3) + (textureCoords == Spheroid::TextureCoords::Generate ? sizeof(Vector2) : 0), indexType};
 }
 
 }}}
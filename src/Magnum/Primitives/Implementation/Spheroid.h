@@ -26,12 +26,21 @@
 */
 
 #include <vector>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/Assert.h>
 
 #include "Magnum/Magnum.h"
-#include "Magnum/Trade/Trade.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Primitives/InterleavedLayout.h"
+#include "Magnum/Trade/MeshData3D.h"
 
 namespace Magnum { namespace Primitives { namespace Implementation {
 
+/* Writes the vertices and indices directly to given memory, which is
+   expected to be large enough (see vertexCount() and indexCount()). Each
+   attribute has its own stride, so the same code is used for both separate
+   arrays and interleaved data. */
 class Spheroid {
     public:
         enum class TextureCoords: UnsignedByte {
@@ -39,7 +48,7 @@ class Spheroid {
             Generate
         };
 
-        Spheroid(UnsignedInt segments, TextureCoords textureCoords);
+        explicit Spheroid(UnsignedInt segments, TextureCoords textureCoords, char* positions, char* normals, char* textureCoords2D, std::size_t positionStride, std::size_t normalStride, std::size_t textureCoordsStride, void* indices, Mesh::IndexType indexType);
 
         void capVertex(Float y, Float normalY, Float textureCoordsV);
         void hemisphereVertexRings(UnsignedInt count, Float centerY, Rad startRingAngle, Rad ringAngleIncrement, Float startTextureCoordsV, Float textureCoordsVIncrement);
@@ -49,18 +58,67 @@ class Spheroid {
         void topFaceRing();
         void capVertexRing(Float y, Float textureCoordsV, const Vector3& normal);
 
-        Trade::MeshData3D finalize();
+        /* Count of vertices and indices written so far */
+        UnsignedInt vertexCount() const { return _vertexCount; }
+        UnsignedInt indexCount() const { return _indexCount; }
+
+        /* Count of vertices in one ring */
+        static UnsignedInt ringVertexCount(UnsignedInt segments, TextureCoords textureCoords) {
+            return segments + (textureCoords == TextureCoords::Generate ? 1 : 0);
+        }
 
     private:
+        void vertex(const Vector3& position, const Vector3& normal, const Vector2& textureCoords);
+        void index(UnsignedInt index);
+
         UnsignedInt segments;
         TextureCoords textureCoords;
 
-        std::vector<UnsignedInt> indices;
-        std::vector<Vector3> positions;
-        std::vector<Vector3> normals;
-        std::vector<Vector2> textureCoords2D;
+        char *_positions, *_normals, *_textureCoords2D;
+        std::size_t _positionStride, _normalStride, _textureCoordsStride;
+        void* _indices;
+        Mesh::IndexType _indexType;
+        UnsignedInt _vertexCount{}, _indexCount{};
 };
 
+/* Layout of interleaved position, normal and optional texture coordinates
+   with the smallest index type */
+InterleavedLayout interleavedLayout(UnsignedInt vertexCount, UnsignedInt indexCount, Spheroid::TextureCoords textureCoords);
+
+/* Generates the mesh using given function into separate arrays of exactly
+   the size given by the layout */
+template<class F> Trade::MeshData3D meshData(const UnsignedInt segments, const Spheroid::TextureCoords textureCoords, const InterleavedLayout& layout, F generate) {
+    std::vector<UnsignedInt> indices(layout.indexCount);
+    std::vector<Vector3> positions(layout.vertexCount);
+    std::vector<Vector3> normals(layout.vertexCount);
+    std::vector<Vector2> textureCoords2D(textureCoords == Spheroid::TextureCoords::Generate ? layout.vertexCount : 0);
+
+    Spheroid spheroid{segments, textureCoords,
+        reinterpret_cast<char*>(positions.data()),
+        reinterpret_cast<char*>(normals.data()),
+        reinterpret_cast<char*>(textureCoords2D.data()),
+        sizeof(Vector3), sizeof(Vector3), sizeof(Vector2),
+        indices.data(), Mesh::IndexType::UnsignedInt};
+    generate(spheroid);
+    CORRADE_INTERNAL_ASSERT(spheroid.vertexCount() == layout.vertexCount && spheroid.indexCount() == layout.indexCount);
+
+    return Trade::MeshData3D{MeshPrimitive::Triangles, std::move(indices), {std::move(positions)}, {std::move(normals)},
+        textureCoords == Spheroid::TextureCoords::Generate ? std::vector<std::vector<Vector2>>{std::move(textureCoords2D)} : std::vector<std::vector<Vector2>>(), {}, nullptr};
+}
+
+/* Generates the mesh using given function into interleaved data described
+   by the layout. The sizes are expected to be checked by the caller. */
+template<class F> void interleavedInto(const UnsignedInt segments, const Spheroid::TextureCoords textureCoords, const InterleavedLayout& layout, const Containers::ArrayView<char> vertices, const Containers::ArrayView<char> indices, F generate) {
+    Spheroid spheroid{segments, textureCoords,
+        vertices.data(),
+        vertices.data() + sizeof(Vector3),
+        vertices.data() + 2*sizeof(Vector3),
+        layout.stride, layout.stride, layout.stride,
+        indices.data(), layout.indexType};
+    generate(spheroid);
+    CORRADE_INTERNAL_ASSERT(spheroid.vertexCount() == layout.vertexCount && spheroid.indexCount() == layout.indexCount);
+}
+
 }}}
 
 #endif
@@ -0,0 +1,88 @@
+#ifndef Magnum_Primitives_InterleavedLayout_h
+#define Magnum_Primitives_InterleavedLayout_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/** @file
+ * @brief Struct @ref Magnum::Primitives::InterleavedLayout
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Mesh.h"
+
+namespace Magnum { namespace Primitives {
+
+/**
+@brief Layout of interleaved primitive data
+
+Returned by `solidLayout()` functions of primitives that can write their
+vertex and index data directly into caller-provided memory, such as
+@ref UVSphere::solidLayout(). The vertex data contain
+@ref Shaders::Generic::Position "position" and
+@ref Shaders::Generic::Normal "normal", both as @ref Vector3, followed by
+@ref Shaders::Generic::TextureCoordinates "texture coordinates" as
+@ref Vector2 if these are generated. The indices are of the smallest type
+that can index all vertices.
+@code
+const Primitives::InterleavedLayout layout = Primitives::UVSphere::solidLayout(16, 32);
+
+Buffer vertices, indices;
+vertices.setData({nullptr, layout.vertexDataSize()}, BufferUsage::StaticDraw);
+indices.setData({nullptr, layout.indexDataSize()}, BufferUsage::StaticDraw);
+Primitives::UVSphere::solidInto(16, 32, Primitives::UVSphere::TextureCoords::DontGenerate,
+    {vertices.map<char>(0, layout.vertexDataSize(), Buffer::MapFlag::Write), layout.vertexDataSize()},
+    {indices.map<char>(0, layout.indexDataSize(), Buffer::MapFlag::Write), layout.indexDataSize()});
+CORRADE_INTERNAL_ASSERT_OUTPUT(vertices.unmap() && indices.unmap());
+
+Mesh mesh;
+mesh.setCount(layout.indexCount)
+    .addVertexBuffer(vertices, 0, Shaders::Phong::Position{}, Shaders::Phong::Normal{})
+    .setIndexBuffer(indices, 0, layout.indexType, 0, layout.vertexCount - 1);
+@endcode
+*/
+struct InterleavedLayout {
+    /** @brief Vertex count */
+    UnsignedInt vertexCount;
+
+    /** @brief Index count */
+    UnsignedInt indexCount;
+
+    /** @brief Vertex stride */
+    std::size_t stride;
+
+    /** @brief Index type */
+    Mesh::IndexType indexType;
+
+    /** @brief Size of vertex data in bytes */
+    std::size_t vertexDataSize() const { return vertexCount*stride; }
+
+    /** @brief Size of index data in bytes */
+    std::size_t indexDataSize() const { return indexCount*Mesh::indexSize(indexType); }
+};
+
+}}
+
+#endif
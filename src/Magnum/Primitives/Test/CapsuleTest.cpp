@@ -23,9 +23,12 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <cstring>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
 
+#include "Magnum/Mesh.h"
 #include "Magnum/Math/Vector3.h"
 #include "Magnum/Trade/MeshData2D.h"
 #include "Magnum/Trade/MeshData3D.h"
@@ -33,6 +36,34 @@
 
 namespace Magnum { namespace Primitives { namespace Test {
 
+namespace {
+
+template<class T> std::vector<T> extract(const Containers::ArrayView<const char> data, const std::size_t count, const std::size_t stride, const std::size_t offset) {
+    std::vector<T> out(count);
+    for(std::size_t i = 0; i != count; ++i)
+        std::memcpy(&out[i], data.data() + i*stride + offset, sizeof(T));
+    return out;
+}
+
+std::vector<UnsignedInt> extractIndices(const Containers::ArrayView<const char> data, const std::size_t count, const Mesh::IndexType type) {
+    switch(type) {
+        case Mesh::IndexType::UnsignedByte: {
+            const std::vector<UnsignedByte> out = extract<UnsignedByte>(data, count, 1, 0);
+            return {out.begin(), out.end()};
+        }
+        case Mesh::IndexType::UnsignedShort: {
+            const std::vector<UnsignedShort> out = extract<UnsignedShort>(data, count, 2, 0);
+            return {out.begin(), out.end()};
+        }
+        case Mesh::IndexType::UnsignedInt:
+            return extract<UnsignedInt>(data, count, 4, 0);
+    }
+
+    CORRADE_ASSERT_UNREACHABLE();
+}
+
+}
+
 struct CapsuleTest: TestSuite::Tester {
     explicit CapsuleTest();
 
@@ -41,13 +72,18 @@ struct CapsuleTest: TestSuite::Tester {
     void solid3DWithoutTextureCoords();
     void solid3DWithTextureCoords();
     void wireframe3D();
+
+    void solid3DIntoWithoutTextureCoords();
+    void solid3DIntoWithTextureCoords();
 };
 
 CapsuleTest::CapsuleTest() {
     addTests({&CapsuleTest::wireframe2D,
               &CapsuleTest::solid3DWithoutTextureCoords,
               &CapsuleTest::solid3DWithTextureCoords,
-              &CapsuleTest::wireframe3D});
+              &CapsuleTest::wireframe3D,
+              &CapsuleTest::solid3DIntoWithoutTextureCoords,
+              &CapsuleTest::solid3DIntoWithTextureCoords});
 }
 
 void CapsuleTest::wireframe2D() {
@@ -320,6 +356,50 @@ void CapsuleTest::wireframe3D() {
     }), TestSuite::Compare::Container);
 }
 
+
+void CapsuleTest::solid3DIntoWithoutTextureCoords() {
+    const Trade::MeshData3D expected = Capsule3D::solid(2, 4, 3, 0.5f);
+    const InterleavedLayout layout = Capsule3D::solidLayout(2, 4, 3);
+    CORRADE_COMPARE(layout.vertexCount, expected.positions(0).size());
+    CORRADE_COMPARE(layout.indexCount, expected.indices().size());
+    CORRADE_COMPARE(layout.stride, 24);
+    CORRADE_COMPARE(layout.indexType, Mesh::IndexType::UnsignedByte);
+
+    Containers::Array<char> vertices{layout.vertexDataSize()};
+    Containers::Array<char> indices{layout.indexDataSize()};
+    Capsule3D::solidInto(2, 4, 3, 0.5f, Capsule3D::TextureCoords::DontGenerate, vertices, indices);
+
+    CORRADE_COMPARE_AS(extract<Vector3>(vertices, layout.vertexCount, layout.stride, 0),
+        expected.positions(0), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(extract<Vector3>(vertices, layout.vertexCount, layout.stride, 12),
+        expected.normals(0), TestSuite::Compare::Container);
+    CORRADE_VERIFY(!expected.hasTextureCoords2D());
+    CORRADE_COMPARE_AS(extractIndices(indices, layout.indexCount, layout.indexType),
+        expected.indices(), TestSuite::Compare::Container);
+}
+
+void CapsuleTest::solid3DIntoWithTextureCoords() {
+    const Trade::MeshData3D expected = Capsule3D::solid(2, 4, 3, 0.5f, Capsule3D::TextureCoords::Generate);
+    const InterleavedLayout layout = Capsule3D::solidLayout(2, 4, 3, Capsule3D::TextureCoords::Generate);
+    CORRADE_COMPARE(layout.vertexCount, expected.positions(0).size());
+    CORRADE_COMPARE(layout.indexCount, expected.indices().size());
+    CORRADE_COMPARE(layout.stride, 32);
+    CORRADE_COMPARE(layout.indexType, Mesh::IndexType::UnsignedByte);
+
+    Containers::Array<char> vertices{layout.vertexDataSize()};
+    Containers::Array<char> indices{layout.indexDataSize()};
+    Capsule3D::solidInto(2, 4, 3, 0.5f, Capsule3D::TextureCoords::Generate, vertices, indices);
+
+    CORRADE_COMPARE_AS(extract<Vector3>(vertices, layout.vertexCount, layout.stride, 0),
+        expected.positions(0), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(extract<Vector3>(vertices, layout.vertexCount, layout.stride, 12),
+        expected.normals(0), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(extract<Vector2>(vertices, layout.vertexCount, layout.stride, 24),
+        expected.textureCoords2D(0), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(extractIndices(indices, layout.indexCount, layout.indexType),
+        expected.indices(), TestSuite::Compare::Container);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Primitives::Test::CapsuleTest)
@@ -23,27 +23,63 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <cstring>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
 
+#include "Magnum/Mesh.h"
 #include "Magnum/Math/Vector3.h"
 #include "Magnum/Primitives/Cylinder.h"
 #include "Magnum/Trade/MeshData3D.h"
 
 namespace Magnum { namespace Primitives { namespace Test {
 
+namespace {
+
+template<class T> std::vector<T> extract(const Containers::ArrayView<const char> data, const std::size_t count, const std::size_t stride, const std::size_t offset) {
+    std::vector<T> out(count);
+    for(std::size_t i = 0; i != count; ++i)
+        std::memcpy(&out[i], data.data() + i*stride + offset, sizeof(T));
+    return out;
+}
+
+std::vector<UnsignedInt> extractIndices(const Containers::ArrayView<const char> data, const std::size_t count, const Mesh::IndexType type) {
+    switch(type) {
+        case Mesh::IndexType::UnsignedByte: {
+            const std::vector<UnsignedByte> out = extract<UnsignedByte>(data, count, 1, 0);
+            return {out.begin(), out.end()};
+        }
+        case Mesh::IndexType::UnsignedShort: {
+            const std::vector<UnsignedShort> out = extract<UnsignedShort>(data, count, 2, 0);
+            return {out.begin(), out.end()};
+        }
+        case Mesh::IndexType::UnsignedInt:
+            return extract<UnsignedInt>(data, count, 4, 0);
+    }
+
+    CORRADE_ASSERT_UNREACHABLE();
+}
+
+}
+
 struct CylinderTest: TestSuite::Tester {
     explicit CylinderTest();
 
     void solidWithoutAnything();
     void solidWithTextureCoordsAndCaps();
     void wireframe();
+
+    void solidIntoWithoutAnything();
+    void solidIntoWithTextureCoordsAndCaps();
 };
 
 CylinderTest::CylinderTest() {
     addTests({&CylinderTest::solidWithoutAnything,
               &CylinderTest::solidWithTextureCoordsAndCaps,
-              &CylinderTest::wireframe});
+              &CylinderTest::wireframe,
+              &CylinderTest::solidIntoWithoutAnything,
+              &CylinderTest::solidIntoWithTextureCoordsAndCaps});
 }
 
 void CylinderTest::solidWithoutAnything() {
@@ -240,6 +276,50 @@ void CylinderTest::wireframe() {
     }), TestSuite::Compare::Container);
 }
 
+
+void CylinderTest::solidIntoWithoutAnything() {
+    const Trade::MeshData3D expected = Cylinder::solid(2, 3, 1.5f);
+    const InterleavedLayout layout = Cylinder::solidLayout(2, 3);
+    CORRADE_COMPARE(layout.vertexCount, expected.positions(0).size());
+    CORRADE_COMPARE(layout.indexCount, expected.indices().size());
+    CORRADE_COMPARE(layout.stride, 24);
+    CORRADE_COMPARE(layout.indexType, Mesh::IndexType::UnsignedByte);
+
+    Containers::Array<char> vertices{layout.vertexDataSize()};
+    Containers::Array<char> indices{layout.indexDataSize()};
+    Cylinder::solidInto(2, 3, 1.5f, {}, vertices, indices);
+
+    CORRADE_COMPARE_AS(extract<Vector3>(vertices, layout.vertexCount, layout.stride, 0),
+        expected.positions(0), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(extract<Vector3>(vertices, layout.vertexCount, layout.stride, 12),
+        expected.normals(0), TestSuite::Compare::Container);
+    CORRADE_VERIFY(!expected.hasTextureCoords2D());
+    CORRADE_COMPARE_AS(extractIndices(indices, layout.indexCount, layout.indexType),
+        expected.indices(), TestSuite::Compare::Container);
+}
+
+void CylinderTest::solidIntoWithTextureCoordsAndCaps() {
+    const Trade::MeshData3D expected = Cylinder::solid(2, 3, 1.5f, Cylinder::Flag::GenerateTextureCoords|Cylinder::Flag::CapEnds);
+    const InterleavedLayout layout = Cylinder::solidLayout(2, 3, Cylinder::Flag::GenerateTextureCoords|Cylinder::Flag::CapEnds);
+    CORRADE_COMPARE(layout.vertexCount, expected.positions(0).size());
+    CORRADE_COMPARE(layout.indexCount, expected.indices().size());
+    CORRADE_COMPARE(layout.stride, 32);
+    CORRADE_COMPARE(layout.indexType, Mesh::IndexType::UnsignedByte);
+
+    Containers::Array<char> vertices{layout.vertexDataSize()};
+    Containers::Array<char> indices{layout.indexDataSize()};
+    Cylinder::solidInto(2, 3, 1.5f, Cylinder::Flag::GenerateTextureCoords|Cylinder::Flag::CapEnds, vertices, indices);
+
+    CORRADE_COMPARE_AS(extract<Vector3>(vertices, layout.vertexCount, layout.stride, 0),
+        expected.positions(0), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(extract<Vector3>(vertices, layout.vertexCount, layout.stride, 12),
+        expected.normals(0), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(extract<Vector2>(vertices, layout.vertexCount, layout.stride, 24),
+        expected.textureCoords2D(0), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(extractIndices(indices, layout.indexCount, layout.indexType),
+        expected.indices(), TestSuite::Compare::Container);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Primitives::Test::CylinderTest)
@@ -23,27 +23,65 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <cstring>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
 
+#include "Magnum/Mesh.h"
 #include "Magnum/Math/Vector3.h"
 #include "Magnum/Primitives/UVSphere.h"
 #include "Magnum/Trade/MeshData3D.h"
 
 namespace Magnum { namespace Primitives { namespace Test {
 
+namespace {
+
+template<class T> std::vector<T> extract(const Containers::ArrayView<const char> data, const std::size_t count, const std::size_t stride, const std::size_t offset) {
+    std::vector<T> out(count);
+    for(std::size_t i = 0; i != count; ++i)
+        std::memcpy(&out[i], data.data() + i*stride + offset, sizeof(T));
+    return out;
+}
+
+std::vector<UnsignedInt> extractIndices(const Containers::ArrayView<const char> data, const std::size_t count, const Mesh::IndexType type) {
+    switch(type) {
+        case Mesh::IndexType::UnsignedByte: {
+            const std::vector<UnsignedByte> out = extract<UnsignedByte>(data, count, 1, 0);
+            return {out.begin(), out.end()};
+        }
+        case Mesh::IndexType::UnsignedShort: {
+            const std::vector<UnsignedShort> out = extract<UnsignedShort>(data, count, 2, 0);
+            return {out.begin(), out.end()};
+        }
+        case Mesh::IndexType::UnsignedInt:
+            return extract<UnsignedInt>(data, count, 4, 0);
+    }
+
+    CORRADE_ASSERT_UNREACHABLE();
+}
+
+}
+
 struct UVSphereTest: TestSuite::Tester {
     explicit UVSphereTest();
 
     void solidWithoutTextureCoords();
     void solidWithTextureCoords();
     void wireframe();
+
+    void solidIntoWithoutTextureCoords();
+    void solidIntoWithTextureCoords();
+    void solidIntoLarge();
 };
 
 UVSphereTest::UVSphereTest() {
     addTests({&UVSphereTest::solidWithoutTextureCoords,
               &UVSphereTest::solidWithTextureCoords,
-              &UVSphereTest::wireframe});
+              &UVSphereTest::wireframe,
+              &UVSphereTest::solidIntoWithoutTextureCoords,
+              &UVSphereTest::solidIntoWithTextureCoords,
+              &UVSphereTest::solidIntoLarge});
 }
 
 void UVSphereTest::solidWithoutTextureCoords() {
@@ -168,6 +206,72 @@ void UVSphereTest::wireframe() {
     }), TestSuite::Compare::Container);
 }
 
+
+void UVSphereTest::solidIntoWithoutTextureCoords() {
+    const Trade::MeshData3D expected = UVSphere::solid(3, 3);
+    const InterleavedLayout layout = UVSphere::solidLayout(3, 3);
+    CORRADE_COMPARE(layout.vertexCount, expected.positions(0).size());
+    CORRADE_COMPARE(layout.indexCount, expected.indices().size());
+    CORRADE_COMPARE(layout.stride, 24);
+    CORRADE_COMPARE(layout.indexType, Mesh::IndexType::UnsignedByte);
+
+    Containers::Array<char> vertices{layout.vertexDataSize()};
+    Containers::Array<char> indices{layout.indexDataSize()};
+    UVSphere::solidInto(3, 3, UVSphere::TextureCoords::DontGenerate, vertices, indices);
+
+    CORRADE_COMPARE_AS(extract<Vector3>(vertices, layout.vertexCount, layout.stride, 0),
+        expected.positions(0), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(extract<Vector3>(vertices, layout.vertexCount, layout.stride, 12),
+        expected.normals(0), TestSuite::Compare::Container);
+    CORRADE_VERIFY(!expected.hasTextureCoords2D());
+    CORRADE_COMPARE_AS(extractIndices(indices, layout.indexCount, layout.indexType),
+        expected.indices(), TestSuite::Compare::Container);
+}
+
+void UVSphereTest::solidIntoWithTextureCoords() {
+    const Trade::MeshData3D expected = UVSphere::solid(3, 3, UVSphere::TextureCoords::Generate);
+    const InterleavedLayout layout = UVSphere::solidLayout(3, 3, UVSphere::TextureCoords::Generate);
+    CORRADE_COMPARE(layout.vertexCount, expected.positions(0).size());
+    CORRADE_COMPARE(layout.indexCount, expected.indices().size());
+    CORRADE_COMPARE(layout.stride, 32);
+    CORRADE_COMPARE(layout.indexType, Mesh::IndexType::UnsignedByte);
+
+    Containers::Array<char> vertices{layout.vertexDataSize()};
+    Containers::Array<char> indices{layout.indexDataSize()};
+    UVSphere::solidInto(3, 3, UVSphere::TextureCoords::Generate, vertices, indices);
+
+    CORRADE_COMPARE_AS(extract<Vector3>(vertices, layout.vertexCount, layout.stride, 0),
+        expected.positions(0), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(extract<Vector3>(vertices, layout.vertexCount, layout.stride, 12),
+        expected.normals(0), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(extract<Vector2>(vertices, layout.vertexCount, layout.stride, 24),
+        expected.textureCoords2D(0), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(extractIndices(indices, layout.indexCount, layout.indexType),
+        expected.indices(), TestSuite::Compare::Container);
+}
+
+void UVSphereTest::solidIntoLarge() {
+    const Trade::MeshData3D expected = UVSphere::solid(200, 100, UVSphere::TextureCoords::Generate);
+    const InterleavedLayout layout = UVSphere::solidLayout(200, 100, UVSphere::TextureCoords::Generate);
+    CORRADE_COMPARE(layout.vertexCount, expected.positions(0).size());
+    CORRADE_COMPARE(layout.indexCount, expected.indices().size());
+    CORRADE_COMPARE(layout.stride, 32);
+    CORRADE_COMPARE(layout.indexType, Mesh::IndexType::UnsignedShort);
+
+    Containers::Array<char> vertices{layout.vertexDataSize()};
+    Containers::Array<char> indices{layout.indexDataSize()};
+    UVSphere::solidInto(200, 100, UVSphere::TextureCoords::Generate, vertices, indices);
+
+    CORRADE_COMPARE_AS(extract<Vector3>(vertices, layout.vertexCount, layout.stride, 0),
+        expected.positions(0), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(extract<Vector3>(vertices, layout.vertexCount, layout.stride, 12),
+        expected.normals(0), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(extract<Vector2>(vertices, layout.vertexCount, layout.stride, 24),
+        expected.textureCoords2D(0), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(extractIndices(indices, layout.indexCount, layout.indexType),
+        expected.indices(), TestSuite::Compare::Container);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Primitives::Test::UVSphereTest)
@@ -33,14 +33,15 @@
 
 namespace Magnum { namespace Primitives {
 
-Trade::MeshData3D UVSphere::solid(UnsignedInt rings, UnsignedInt segments, TextureCoords textureCoords) {
-    CORRADE_ASSERT(rings >= 2 && segments >= 3, "UVSphere must have at least two rings and three segments",
-        (Trade::MeshData3D{MeshPrimitive::Triangles, {}, {}, {}, {}, {}, nullptr}));
+namespace {
 
-    Implementation::Spheroid sphere(segments, textureCoords == TextureCoords::Generate ?
+Implementation::Spheroid::TextureCoords spheroidTextureCoords(const UVSphere::TextureCoords textureCoords) {
+    return textureCoords == UVSphere::TextureCoords::Generate ?
         Implementation::Spheroid::TextureCoords::Generate :
-        Implementation::Spheroid::TextureCoords::DontGenerate);
+        Implementation::Spheroid::TextureCoords::DontGenerate;
+}
 
+void solidInternal(Implementation::Spheroid& sphere, const UnsignedInt rings) {
     Float textureCoordsVIncrement = 1.0f/rings;
     Rad ringAngleIncrement(Constants::pi()/rings);
 
@@ -57,8 +58,38 @@ Trade::MeshData3D UVSphere::solid(UnsignedInt rings, UnsignedInt segments, Textu
     sphere.bottomFaceRing();
     sphere.faceRings(rings-2);
     sphere.topFaceRing();
+}
 
-    return sphere.finalize();
+}
+
+Trade::MeshData3D UVSphere::solid(UnsignedInt rings, UnsignedInt segments, TextureCoords textureCoords) {
+    CORRADE_ASSERT(rings >= 2 && segments >= 3, "UVSphere must have at least two rings and three segments",
+        (Trade::MeshData3D{MeshPrimitive::Triangles, {}, {}, {}, {}, {}, nullptr}));
+
+    return Implementation::meshData(segments, spheroidTextureCoords(textureCoords), solidLayout(rings, segments, textureCoords), [&](Implementation::Spheroid& sphere) {
+        solidInternal(sphere, rings);
+    });
+}
+
+InterleavedLayout UVSphere::solidLayout(const UnsignedInt rings, const UnsignedInt segments, const TextureCoords textureCoords) {
+    CORRADE_ASSERT(rings >= 2 && segments >= 3, "Primitives::UVSphere::solidLayout(): UVSphere must have at least two rings and three segments", {});
+
+    const Implementation::Spheroid::TextureCoords spheroidCoords = spheroidTextureCoords(textureCoords);
+    return Implementation::interleavedLayout(
+        2 + (rings - 1)*Implementation::Spheroid::ringVertexCount(segments, spheroidCoords),
+        (rings - 1)*segments*6, spheroidCoords);
+}
+
+void UVSphere::solidInto(const UnsignedInt rings, const UnsignedInt segments, const TextureCoords textureCoords, const Containers::ArrayView<char> vertices, const Containers::ArrayView<char> indices) {
+    CORRADE_ASSERT(rings >= 2 && segments >= 3, "Primitives::UVSphere::solidInto(): UVSphere must have at least two rings and three segments", );
+
+    const InterleavedLayout layout = solidLayout(rings, segments, textureCoords);
+    CORRADE_ASSERT(vertices.size() >= layout.vertexDataSize() && indices.size() >= layout.indexDataSize(),
+        "Primitives::UVSphere::solidInto(): expected at least" << layout.vertexDataSize() << "bytes of vertex data and" << layout.indexDataSize() << "bytes of index data but got" << vertices.size() << "and" << indices.size(), );
+
+    Implementation::interleavedInto(segments, spheroidTextureCoords(textureCoords), layout, vertices, indices, [&](Implementation::Spheroid& sphere) {
+        solidInternal(sphere, rings);
+    });
 }
 
 Trade::MeshData3D UVSphere::wireframe(const UnsignedInt rings, const UnsignedInt segments) {
@@ -29,8 +29,11 @@
  * @brief Class @ref Magnum::Primitives::UVSphere
  */
 
-#include "Magnum/Trade/Trade.h"
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Primitives/InterleavedLayout.h"
 #include "Magnum/Primitives/visibility.h"
+#include "Magnum/Trade/Trade.h"
 
 namespace Magnum { namespace Primitives {
 
@@ -58,9 +61,39 @@ class MAGNUM_PRIMITIVES_EXPORT UVSphere {
          * Indexed @ref MeshPrimitive::Triangles with normals and optional 2D
          * texture coordinates. If texture coordinates are generated, vertices
          * of one segment are duplicated for texture wrapping.
+         * @see @ref solidInto()
          */
         static Trade::MeshData3D solid(UnsignedInt rings, UnsignedInt segments, TextureCoords textureCoords = TextureCoords::DontGenerate);
 
+        /**
+         * @brief Layout of interleaved solid UV sphere data
+         *
+         * Exact vertex and index count, vertex stride and index type of
+         * data written by @ref solidInto() with the same parameters. See
+         * @ref solid() for the parameter requirements.
+         */
+        static InterleavedLayout solidLayout(UnsignedInt rings, UnsignedInt segments, TextureCoords textureCoords = TextureCoords::DontGenerate);
+
+        /**
+         * @brief Solid UV sphere into interleaved data
+         * @param[in] rings     Number of (face) rings. Must be larger or
+         *      equal to 2.
+         * @param[in] segments  Number of (face) segments. Must be larger or
+         *      equal to 3.
+         * @param[in] textureCoords Whether to generate texture coordinates
+         * @param[out] vertices Where to put interleaved vertex data
+         * @param[out] indices  Where to put index data
+         *
+         * Same geometry as @ref solid(), but written directly into
+         * @p vertices and @p indices with the layout given by
+         * @ref solidLayout(), without any intermediate allocations. The
+         * views are expected to be at least
+         * @ref InterleavedLayout::vertexDataSize() and
+         * @ref InterleavedLayout::indexDataSize() bytes large, such as a
+         * mapped @ref Buffer.
+         */
+        static void solidInto(UnsignedInt rings, UnsignedInt segments, TextureCoords textureCoords, Containers::ArrayView<char> vertices, Containers::ArrayView<char> indices);
+
         /**
          * @brief Wireframe UV sphere
          * @param rings         Number of (line) rings. Must be larger or equal
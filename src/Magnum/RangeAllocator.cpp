@@ -0,0 +1,149 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "RangeAllocator.h"
+
+#include <Corrade/Utility/Assert.h>
+
+namespace Magnum {
+
+constexpr std::size_t RangeAllocator::NotFound;
+
+RangeAllocator::RangeAllocator(const std::size_t size): _size{size}, _available{size} {
+    if(size) _free.emplace(0, size);
+}
+
+std::size_t RangeAllocator::largestFreeRange() const {
+    std::size_t largest = 0;
+    for(const auto& range: _free) if(range.second > largest)
+        largest = range.second;
+    return largest;
+}
+
+std::size_t RangeAllocator::allocate(const std::size_t size, const std::size_t alignment) {
+    CORRADE_ASSERT(size && alignment,
+        "RangeAllocator::allocate(): expected non-zero size and alignment", NotFound);
+
+    /* Best fit -- the free range that leaves the least space after the
+       aligned allocation */
+    auto best = _free.end();
+    std::size_t bestOffset{}, bestLeftover{};
+    for(auto it = _free.begin(); it != _free.end(); ++it) {
+        const std::size_t offset = (it->first + alignment - 1)/alignment*alignment;
+        const std::size_t end = it->first + it->second;
+        if(offset + size > end) continue;
+
+        const std::size_t leftover = it->second - size;
+        if(best == _free.end() || leftover < bestLeftover) {
+            best = it;
+            bestOffset = offset;
+            bestLeftover = leftover;
+            if(!leftover) break;
+        }
+    }
+
+    if(best == _free.end()) return NotFound;
+
+    /* Split the free range, keeping the alignment padding and the rest
+       free */
+    const std::size_t freeOffset = best->first;
+    const std::size_t freeEnd = best->first + best->second;
+    _free.erase(best);
+    if(bestOffset != freeOffset)
+        _free.emplace(freeOffset, bestOffset - freeOffset);
+    if(bestOffset + size != freeEnd)
+        _free.emplace(bestOffset + size, freeEnd - bestOffset - size);
+
+    _allocations.emplace(bestOffset, Allocation{size, alignment});
+    _available -= size;
+    return bestOffset;
+}
+
+std::size_t RangeAllocator::allocationSize(const std::size_t offset) const {
+    const auto found = _allocations.find(offset);
+    CORRADE_ASSERT(found != _allocations.end(),
+        "RangeAllocator::allocationSize(): no allocation at offset" << offset, {});
+    return found->second.size;
+}
+
+void RangeAllocator::deallocate(const std::size_t offset) {
+    const auto found = _allocations.find(offset);
+    CORRADE_ASSERT(found != _allocations.end(),
+        "RangeAllocator::deallocate(): no allocation at offset" << offset, );
+
+    std::size_t freeOffset = offset;
+    std::size_t freeSize = found->second.size;
+    _available += freeSize;
+    _allocations.erase(found);
+
+    /* Merge with the following free range */
+    const auto next = _free.find(offset + freeSize);
+    if(next != _free.end()) {
+        freeSize += next->second;
+        _free.erase(next);
+    }
+
+    /* Merge with the preceding free range */
+    auto previous = _free.lower_bound(offset);
+    if(previous != _free.begin()) {
+        --previous;
+        if(previous->first + previous->second == offset) {
+            freeOffset = previous->first;
+            freeSize += previous->second;
+            _free.erase(previous);
+        }
+    }
+
+    _free.emplace(freeOffset, freeSize);
+}
+
+std::vector<RangeAllocator::Move> RangeAllocator::defragment() {
+    std::vector<Move> moves;
+    std::map<std::size_t, Allocation> allocations;
+    std::size_t offset = 0;
+    for(const auto& allocation: _allocations) {
+        offset = (offset + allocation.second.alignment - 1)/allocation.second.alignment*allocation.second.alignment;
+        if(offset != allocation.first)
+            moves.push_back({allocation.first, offset, allocation.second.size});
+        allocations.emplace_hint(allocations.end(), offset, allocation.second);
+        offset += allocation.second.size;
+    }
+
+    /* The alignment padding between allocations stays free as well */
+    _free.clear();
+    std::size_t previousEnd = 0;
+    for(const auto& allocation: allocations) {
+        if(allocation.first != previousEnd)
+            _free.emplace_hint(_free.end(), previousEnd, allocation.first - previousEnd);
+        previousEnd = allocation.first + allocation.second.size;
+    }
+    if(previousEnd != _size)
+        _free.emplace_hint(_free.end(), previousEnd, _size - previousEnd);
+
+    _allocations = std::move(allocations);
+    return moves;
+}
+
+}
@@ -0,0 +1,160 @@
+#ifndef Magnum_RangeAllocator_h
+#define Magnum_RangeAllocator_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::RangeAllocator
+ */
+
+#include <cstddef>
+#include <map>
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum {
+
+/**
+@brief Range allocator
+
+Sub-allocates offset ranges from a fixed-size address space, without touching
+any memory itself. Free ranges are kept sorted by offset, allocation picks the
+best-fitting one and freed ranges are immediately coalesced with their free
+neighbors, so the fragmentation stays low even with many allocations of
+varying size.
+@code
+RangeAllocator allocator{1024};
+std::size_t a = allocator.allocate(100);
+std::size_t b = allocator.allocate(200, 16);
+allocator.deallocate(a);
+
+// allocator.largestFreeRange() is now 724
+@endcode
+
+Used by @ref BufferHeap, but usable also standalone, for example for texture
+atlas rows.
+*/
+class MAGNUM_EXPORT RangeAllocator {
+    public:
+        /**
+         * @brief Value returned when allocation fails
+         *
+         * @see @ref allocate()
+         */
+        static constexpr std::size_t NotFound = ~std::size_t{};
+
+        /**
+         * @brief Range moved by @ref defragment()
+         */
+        struct Move {
+            std::size_t oldOffset;  /**< @brief Original offset */
+            std::size_t newOffset;  /**< @brief New offset */
+            std::size_t size;       /**< @brief Size */
+        };
+
+        /**
+         * @brief Constructor
+         * @param size      Size of the address space
+         */
+        explicit RangeAllocator(std::size_t size);
+
+        /** @brief Size of the address space */
+        std::size_t size() const { return _size; }
+
+        /** @brief Count of live allocations */
+        std::size_t allocationCount() const { return _allocations.size(); }
+
+        /**
+         * @brief Available size
+         *
+         * Sum of sizes of all free ranges. Doesn't say whether an allocation
+         * of that size would succeed, see @ref largestFreeRange() for that.
+         */
+        std::size_t available() const { return _available; }
+
+        /** @brief Size of the largest free range */
+        std::size_t largestFreeRange() const;
+
+        /**
+         * @brief Allocate a range
+         * @param size      Size, expected to be non-zero
+         * @param alignment Alignment of the returned offset, expected to be
+         *      non-zero
+         * @return Offset of the range or @ref NotFound if there's no free
+         *      range large enough
+         *
+         * Picks the smallest free range into which the aligned allocation
+         * fits. Padding needed for the alignment stays free.
+         */
+        std::size_t allocate(std::size_t size, std::size_t alignment = 1);
+
+        /**
+         * @brief Size of an allocation
+         *
+         * Expects that @p offset was returned from @ref allocate() and wasn't
+         * deallocated yet.
+         */
+        std::size_t allocationSize(std::size_t offset) const;
+
+        /**
+         * @brief Deallocate a range
+         *
+         * Expects that @p offset was returned from @ref allocate() and wasn't
+         * deallocated yet. The range is merged with all adjacent free
+         * ranges.
+         */
+        void deallocate(std::size_t offset);
+
+        /**
+         * @brief Defragment
+         * @return Ranges that were moved, sorted by their offset
+         *
+         * Moves all allocations towards the beginning of the address space,
+         * preserving their order and alignment, so the free space becomes a
+         * single range at the end. It's up to the caller to move data of the
+         * returned ranges accordingly. As a range can move over its own
+         * original location, the data either have to be moved in order with
+         * a @cpp std::memmove() @ce-like operation or copied through a
+         * temporary storage.
+         */
+        std::vector<Move> defragment();
+
+    private:
+        struct Allocation {
+            std::size_t size;
+            std::size_t alignment;
+        };
+
+        std::size_t _size, _available;
+        /* Offset -> size */
+        std::map<std::size_t, std::size_t> _free;
+        std::map<std::size_t, Allocation> _allocations;
+};
+
+}
+
+#endif
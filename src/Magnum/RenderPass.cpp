@@ -0,0 +1,204 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "RenderPass.h"
+
+#include "Magnum/Instrumentation.h"
+#include "Magnum/Renderer.h"
+
+namespace Magnum {
+
+namespace {
+    enum: std::size_t { Color, Depth, Stencil };
+}
+
+RenderPass::RenderPass(DefaultFramebuffer& framebuffer): _defaultFramebuffer{&framebuffer}, _framebuffer{}, _load{RenderPassLoadAction::Load, RenderPassLoadAction::Load, RenderPassLoadAction::Load}, _store{RenderPassStoreAction::Store, RenderPassStoreAction::Store, RenderPassStoreAction::Store}, _pixelSizes{4, 3, 1}, _clearColor{0.0f, 0.0f, 0.0f, 1.0f}, _clearDepth{1.0f}, _clearStencil{0}, _active{false}, _statistics{} {}
+
+RenderPass::RenderPass(Framebuffer& framebuffer, std::initializer_list<Framebuffer::ColorAttachment> colorAttachments): _defaultFramebuffer{}, _framebuffer{&framebuffer}, _colorAttachments{colorAttachments}, _load{RenderPassLoadAction::Load, RenderPassLoadAction::Load, RenderPassLoadAction::Load}, _store{RenderPassStoreAction::Store, RenderPassStoreAction::Store, RenderPassStoreAction::Store}, _pixelSizes{4, 3, 1}, _clearColor{0.0f, 0.0f, 0.0f, 1.0f}, _clearDepth{1.0f}, _clearStencil{0}, _active{false}, _statistics{} {}
+
+RenderPass::RenderPass(RenderPass&&) noexcept = default;
+
+RenderPass& RenderPass::operator=(RenderPass&&) noexcept = default;
+
+RenderPass& RenderPass::setColor(const RenderPassLoadAction load, const RenderPassStoreAction store) {
+    _load[Color] = load;
+    _store[Color] = store;
+    return *this;
+}
+
+RenderPass& RenderPass::setDepth(const RenderPassLoadAction load, const RenderPassStoreAction store) {
+    _load[Depth] = load;
+    _store[Depth] = store;
+    return *this;
+}
+
+RenderPass& RenderPass::setStencil(const RenderPassLoadAction load, const RenderPassStoreAction store) {
+    _load[Stencil] = load;
+    _store[Stencil] = store;
+    return *this;
+}
+
+RenderPass& RenderPass::setPixelSizes(const UnsignedInt color, const UnsignedInt depth, const UnsignedInt stencil) {
+    _pixelSizes[Color] = color;
+    _pixelSizes[Depth] = depth;
+    _pixelSizes[Stencil] = stencil;
+    return *this;
+}
+
+void RenderPass::begin() {
+    CORRADE_ASSERT(!_active, "RenderPass::begin(): the pass is already active", );
+    _active = true;
+
+    AbstractFramebuffer& framebuffer = this->framebuffer();
+    framebuffer.bind();
+
+    /* Attachments that don't need their previous contents and are not going
+       to be cleared are invalidated. Cleared attachments don't need the
+       invalidation, drivers for tiled GPUs recognize a full clear at the
+       beginning of the pass. */
+    const bool invalidated[]{
+        _load[Color] == RenderPassLoadAction::DontCare,
+        _load[Depth] == RenderPassLoadAction::DontCare,
+        _load[Stencil] == RenderPassLoadAction::DontCare};
+    invalidate(invalidated);
+
+    FramebufferClearMask clear;
+    if(_load[Color] == RenderPassLoadAction::Clear) {
+        Renderer::setClearColor(_clearColor);
+        clear |= FramebufferClear::Color;
+    }
+    if(_load[Depth] == RenderPassLoadAction::Clear) {
+        Renderer::setClearDepth(_clearDepth);
+        clear |= FramebufferClear::Depth;
+    }
+    if(_load[Stencil] == RenderPassLoadAction::Clear) {
+        Renderer::setClearStencil(_clearStencil);
+        clear |= FramebufferClear::Stencil;
+    }
+    if(clear) framebuffer.clear(clear);
+
+    /* Update the statistics */
+    std::uint64_t avoided = 0;
+    for(std::size_t i = 0; i != 3; ++i) {
+        const std::uint64_t bytes = attachmentSize(i);
+        if(_load[i] == RenderPassLoadAction::Load)
+            _statistics.loadedBytes += bytes;
+        else avoided += bytes;
+    }
+    _statistics.avoidedLoadBytes += avoided;
+    MAGNUM_INSTRUMENT_COUNT(Instrumentation::Counter::FramebufferBytesAvoided, avoided);
+}
+
+void RenderPass::end() {
+    CORRADE_ASSERT(_active, "RenderPass::end(): the pass is not active", );
+    _active = false;
+
+    const bool invalidated[]{
+        _store[Color] == RenderPassStoreAction::DontCare,
+        _store[Depth] == RenderPassStoreAction::DontCare,
+        _store[Stencil] == RenderPassStoreAction::DontCare};
+    invalidate(invalidated);
+
+    std::uint64_t avoided = 0;
+    for(std::size_t i = 0; i != 3; ++i) {
+        const std::uint64_t bytes = attachmentSize(i);
+        if(_store[i] == RenderPassStoreAction::Store)
+            _statistics.storedBytes += bytes;
+        else avoided += bytes;
+    }
+    _statistics.avoidedStoreBytes += avoided;
+    ++_statistics.passCount;
+    MAGNUM_INSTRUMENT_COUNT(Instrumentation::Counter::FramebufferBytesAvoided, avoided);
+}
+
+void RenderPass::resetStatistics() {
+    _statistics = {};
+}
+
+AbstractFramebuffer& RenderPass::framebuffer() const {
+    return _defaultFramebuffer ?
+        static_cast<AbstractFramebuffer&>(*_defaultFramebuffer) : *_framebuffer;
+}
+
+std::uint64_t RenderPass::attachmentSize(const std::size_t attachment) const {
+    /* The default framebuffer has just one color buffer */
+    const std::uint64_t count = attachment == Color && _framebuffer ? _colorAttachments.size() : 1;
+    return std::uint64_t(framebuffer().viewport().size().product())*_pixelSizes[attachment]*count;
+}
+
+void RenderPass::invalidate(const bool(&attachments)[3]) {
+    #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+    /* The invalidate() functions take an initializer list, so each
+       attachment is invalidated separately */
+    if(_defaultFramebuffer) {
+        if(attachments[Color])
+            _defaultFramebuffer->invalidate({DefaultFramebuffer::InvalidationAttachment::Color});
+        if(attachments[Depth])
+            _defaultFramebuffer->invalidate({DefaultFramebuffer::InvalidationAttachment::Depth});
+        if(attachments[Stencil])
+            _defaultFramebuffer->invalidate({DefaultFramebuffer::InvalidationAttachment::Stencil});
+    } else {
+        if(attachments[Color]) for(const Framebuffer::ColorAttachment attachment: _colorAttachments)
+            _framebuffer->invalidate({attachment});
+        if(attachments[Depth])
+            _framebuffer->invalidate({Framebuffer::InvalidationAttachment::Depth});
+        if(attachments[Stencil])
+            _framebuffer->invalidate({Framebuffer::InvalidationAttachment::Stencil});
+    }
+    #else
+    static_cast<void>(attachments);
+    #endif
+}
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+Debug& operator<<(Debug& debug, const RenderPassLoadAction value) {
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case RenderPassLoadAction::value: return debug << "RenderPassLoadAction::" #value;
+        _c(Load)
+        _c(Clear)
+        _c(DontCare)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "RenderPassLoadAction(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const RenderPassStoreAction value) {
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case RenderPassStoreAction::value: return debug << "RenderPassStoreAction::" #value;
+        _c(Store)
+        _c(DontCare)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "RenderPassStoreAction(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+#endif
+
+}
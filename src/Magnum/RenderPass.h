@@ -0,0 +1,333 @@
+#ifndef Magnum_RenderPass_h
+#define Magnum_RenderPass_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::RenderPass, enum @ref Magnum::RenderPassLoadAction, @ref Magnum::RenderPassStoreAction
+ */
+
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+#include "Magnum/DefaultFramebuffer.h"
+#include "Magnum/Framebuffer.h"
+#include "Magnum/Math/Color.h"
+
+namespace Magnum {
+
+/**
+@brief Render pass attachment load action
+
+@see @ref RenderPass
+*/
+enum class RenderPassLoadAction: UnsignedByte {
+    /** Previous contents are preserved */
+    Load,
+
+    /** Contents are cleared to a constant value */
+    Clear,
+
+    /**
+     * Previous contents are not needed, the attachment is invalidated
+     * without clearing
+     */
+    DontCare
+};
+
+/** @debugoperatorenum{Magnum::RenderPassLoadAction} */
+MAGNUM_EXPORT Debug& operator<<(Debug& debug, RenderPassLoadAction value);
+
+/**
+@brief Render pass attachment store action
+
+@see @ref RenderPass
+*/
+enum class RenderPassStoreAction: UnsignedByte {
+    /** Contents are kept after the pass */
+    Store,
+
+    /** Contents are not needed after the pass and are invalidated */
+    DontCare
+};
+
+/** @debugoperatorenum{Magnum::RenderPassStoreAction} */
+MAGNUM_EXPORT Debug& operator<<(Debug& debug, RenderPassStoreAction value);
+
+/**
+@brief Render pass
+
+Declares what happens with framebuffer attachments at the beginning and at
+the end of rendering and issues the matching @ref AbstractFramebuffer::clear()
+and @ref DefaultFramebuffer::invalidate() / @ref Framebuffer::invalidate()
+calls. Tile-based GPUs, common on Android and iOS, keep the framebuffer in
+on-chip memory while rendering a tile. Contents that aren't cleared or
+invalidated have to be loaded from main memory before the tile is rendered
+and all contents that aren't invalidated are written back after, which for
+depth and stencil buffers that are not needed after the frame is a
+significant waste of bandwidth.
+
+## Basic usage
+
+A typical main loop clears color and depth at the beginning and needs only
+the color buffer at the end:
+
+@code
+RenderPass pass{defaultFramebuffer};
+pass.setColor(RenderPassLoadAction::Clear, RenderPassStoreAction::Store)
+    .setDepth(RenderPassLoadAction::Clear, RenderPassStoreAction::DontCare)
+    .setStencil(RenderPassLoadAction::DontCare, RenderPassStoreAction::DontCare)
+    .setClearColor(0x1f1f1f_rgbf);
+
+// drawEvent()
+pass.begin();
+// draw the scene ...
+pass.end();
+swapBuffers();
+@endcode
+
+The default is to load and store all attachments, which corresponds to
+rendering without any render pass. Clearing depth or stencil needs the
+corresponding write mask enabled, see @ref Renderer::setDepthMask() and
+@ref Renderer::setStencilMask(). For a @ref Framebuffer, clearing color
+clears all buffers mapped for drawing, invalidation is done for the color
+attachments passed in the constructor.
+
+## Bandwidth statistics
+
+Based on viewport size and pixel sizes set using @ref setPixelSizes(), the
+pass counts bytes that a tile-based GPU doesn't need to transfer thanks to
+the declared actions, available through @ref statistics(). The same value is
+added to the @ref Instrumentation::Counter::FramebufferBytesAvoided counter,
+if the library is built with @ref MAGNUM_BUILD_INSTRUMENTATION. The value is
+just an estimate, the driver may compress the data or ignore the hints.
+
+If extension @extension{ARB,invalidate_subdata} (part of OpenGL 4.3),
+extension @extension{EXT,discard_framebuffer} in OpenGL ES 2.0 or OpenGL ES
+3.0 is not available, invalidation does nothing, the statistics are
+calculated regardless. In WebGL 1.0 the invalidation is not available at all.
+*/
+class MAGNUM_EXPORT RenderPass {
+    public:
+        /**
+         * @brief Bandwidth statistics
+         *
+         * @see @ref statistics(), @ref resetStatistics()
+         */
+        struct Statistics {
+            /** @brief Count of passes since last statistics reset */
+            UnsignedInt passCount;
+
+            /** @brief Bytes loaded at the beginning of passes */
+            std::uint64_t loadedBytes;
+
+            /** @brief Bytes stored at the end of passes */
+            std::uint64_t storedBytes;
+
+            /** @brief Bytes not loaded thanks to clear or invalidation */
+            std::uint64_t avoidedLoadBytes;
+
+            /** @brief Bytes not stored thanks to invalidation */
+            std::uint64_t avoidedStoreBytes;
+        };
+
+        /**
+         * @brief Construct for the default framebuffer
+         *
+         * The framebuffer is expected to exist for the whole lifetime of the
+         * pass.
+         */
+        explicit RenderPass(DefaultFramebuffer& framebuffer);
+
+        /**
+         * @brief Construct for a framebuffer
+         * @param framebuffer       Framebuffer
+         * @param colorAttachments  Color attachments affected by color load
+         *      and store actions
+         *
+         * The framebuffer is expected to exist for the whole lifetime of the
+         * pass.
+         */
+        explicit RenderPass(Framebuffer& framebuffer, std::initializer_list<Framebuffer::ColorAttachment> colorAttachments = {Framebuffer::ColorAttachment{0}});
+
+        /** @brief Copying is not allowed */
+        RenderPass(const RenderPass&) = delete;
+
+        /** @brief Move constructor */
+        RenderPass(RenderPass&&) noexcept;
+
+        /** @brief Copying is not allowed */
+        RenderPass& operator=(const RenderPass&) = delete;
+
+        /** @brief Move assignment */
+        RenderPass& operator=(RenderPass&&) noexcept;
+
+        /**
+         * @brief Set color load and store action
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @ref RenderPassLoadAction::Load and
+         * @ref RenderPassStoreAction::Store.
+         * @see @ref setClearColor()
+         */
+        RenderPass& setColor(RenderPassLoadAction load, RenderPassStoreAction store);
+
+        /**
+         * @brief Set depth load and store action
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @ref RenderPassLoadAction::Load and
+         * @ref RenderPassStoreAction::Store.
+         * @see @ref setClearDepth()
+         */
+        RenderPass& setDepth(RenderPassLoadAction load, RenderPassStoreAction store);
+
+        /**
+         * @brief Set stencil load and store action
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @ref RenderPassLoadAction::Load and
+         * @ref RenderPassStoreAction::Store.
+         * @see @ref setClearStencil()
+         */
+        RenderPass& setStencil(RenderPassLoadAction load, RenderPassStoreAction store);
+
+        /** @brief Color load action */
+        RenderPassLoadAction colorLoadAction() const { return _load[0]; }
+
+        /** @brief Color store action */
+        RenderPassStoreAction colorStoreAction() const { return _store[0]; }
+
+        /** @brief Depth load action */
+        RenderPassLoadAction depthLoadAction() const { return _load[1]; }
+
+        /** @brief Depth store action */
+        RenderPassStoreAction depthStoreAction() const { return _store[1]; }
+
+        /** @brief Stencil load action */
+        RenderPassLoadAction stencilLoadAction() const { return _load[2]; }
+
+        /** @brief Stencil store action */
+        RenderPassStoreAction stencilStoreAction() const { return _store[2]; }
+
+        /**
+         * @brief Set clear color
+         * @return Reference to self (for method chaining)
+         *
+         * Used with @ref RenderPassLoadAction::Clear. Default is
+         * `0x000000ff_rgbaf`.
+         * @see @ref Renderer::setClearColor()
+         */
+        RenderPass& setClearColor(const Color4& color) {
+            _clearColor = color;
+            return *this;
+        }
+
+        /**
+         * @brief Set clear depth
+         * @return Reference to self (for method chaining)
+         *
+         * Used with @ref RenderPassLoadAction::Clear. Default is `1.0f`.
+         * @see @ref Renderer::setClearDepth()
+         */
+        RenderPass& setClearDepth(Float depth) {
+            _clearDepth = depth;
+            return *this;
+        }
+
+        /**
+         * @brief Set clear stencil
+         * @return Reference to self (for method chaining)
+         *
+         * Used with @ref RenderPassLoadAction::Clear. Default is `0`.
+         * @see @ref Renderer::setClearStencil()
+         */
+        RenderPass& setClearStencil(Int stencil) {
+            _clearStencil = stencil;
+            return *this;
+        }
+
+        /**
+         * @brief Set pixel sizes for bandwidth statistics
+         * @return Reference to self (for method chaining)
+         *
+         * Size of one pixel of each color attachment, of the depth and of the
+         * stencil buffer in bytes. Default is `4`, `3` and `1`, which
+         * corresponds to @ref RenderbufferFormat::RGBA8 and
+         * @ref RenderbufferFormat::Depth24Stencil8. Set the size to `0` for
+         * attachments that don't exist.
+         */
+        RenderPass& setPixelSizes(UnsignedInt color, UnsignedInt depth, UnsignedInt stencil);
+
+        /**
+         * @brief Begin the pass
+         *
+         * Binds the framebuffer for drawing, invalidates attachments with
+         * @ref RenderPassLoadAction::DontCare and clears attachments with
+         * @ref RenderPassLoadAction::Clear. Expects that the pass isn't
+         * already begun.
+         * @see @ref AbstractFramebuffer::bind(), @ref AbstractFramebuffer::clear()
+         */
+        void begin();
+
+        /**
+         * @brief End the pass
+         *
+         * Invalidates attachments with @ref RenderPassStoreAction::DontCare
+         * and updates @ref statistics(). Expects that the pass was begun.
+         */
+        void end();
+
+        /** @brief Whether the pass is begun */
+        bool isActive() const { return _active; }
+
+        /** @brief Bandwidth statistics */
+        const Statistics& statistics() const { return _statistics; }
+
+        /** @brief Reset bandwidth statistics to zero */
+        void resetStatistics();
+
+    private:
+        AbstractFramebuffer& framebuffer() const;
+        std::uint64_t attachmentSize(std::size_t attachment) const;
+        void invalidate(const bool(&attachments)[3]);
+
+        DefaultFramebuffer* _defaultFramebuffer;
+        Framebuffer* _framebuffer;
+        std::vector<Framebuffer::ColorAttachment> _colorAttachments;
+        RenderPassLoadAction _load[3];
+        RenderPassStoreAction _store[3];
+        UnsignedInt _pixelSizes[3];
+        Color4 _clearColor;
+        Float _clearDepth;
+        Int _clearStencil;
+        bool _active;
+        Statistics _statistics;
+};
+
+}
+
+#endif
@@ -0,0 +1,153 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "RenderTargetPool.h"
+
+#include <algorithm>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/RenderbufferFormat.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/Math/Range.h"
+
+namespace Magnum {
+
+namespace {
+
+template<class T> T* findUnused(std::vector<std::unique_ptr<T>>& entries, const Vector2i& size, const GLenum format, const Int samples, const UnsignedInt frame) {
+    for(std::unique_ptr<T>& entry: entries) {
+        if(entry->used || entry->size != size || entry->format != format || entry->samples != samples)
+            continue;
+
+        entry->used = true;
+        entry->lastUsedFrame = frame;
+        return entry.get();
+    }
+
+    return nullptr;
+}
+
+template<class T, class U> T* findEntry(std::vector<std::unique_ptr<T>>& entries, U& object) {
+    for(std::unique_ptr<T>& entry: entries)
+        if(&entry->object == &object) return entry.get();
+
+    return nullptr;
+}
+
+template<class T> void removeUnused(std::vector<std::unique_ptr<T>>& entries, const UnsignedInt frame, const UnsignedInt maxUnusedFrames) {
+    entries.erase(std::remove_if(entries.begin(), entries.end(), [frame, maxUnusedFrames](const std::unique_ptr<T>& entry) {
+        return !entry->used && frame - entry->lastUsedFrame > maxUnusedFrames;
+    }), entries.end());
+}
+
+template<class T> void removeUnused(std::vector<std::unique_ptr<T>>& entries) {
+    entries.erase(std::remove_if(entries.begin(), entries.end(), [](const std::unique_ptr<T>& entry) {
+        return !entry->used;
+    }), entries.end());
+}
+
+template<class T> std::size_t countUsed(const std::vector<std::unique_ptr<T>>& entries) {
+    return std::count_if(entries.begin(), entries.end(), [](const std::unique_ptr<T>& entry) {
+        return entry->used;
+    });
+}
+
+}
+
+RenderTargetPool::RenderTargetPool(const UnsignedInt maxUnusedFrames): _maxUnusedFrames{maxUnusedFrames} {}
+
+std::size_t RenderTargetPool::usedCount() const {
+    return countUsed(_textures) + countUsed(_renderbuffers) + countUsed(_framebuffers);
+}
+
+Texture2D& RenderTargetPool::acquireTexture(const Vector2i& size, const TextureFormat format) {
+    if(Entry<Texture2D>* const entry = findUnused(_textures, size, GLenum(format), 0, _frame))
+        return entry->object;
+
+    Texture2D texture;
+    texture.setMinificationFilter(Sampler::Filter::Linear)
+        .setMagnificationFilter(Sampler::Filter::Linear)
+        .setWrapping(Sampler::Wrapping::ClampToEdge)
+        .setStorage(1, format, size);
+    _textures.emplace_back(new Entry<Texture2D>{std::move(texture), size, GLenum(format), 0, _frame});
+    return _textures.back()->object;
+}
+
+Renderbuffer& RenderTargetPool::acquireRenderbuffer(const Vector2i& size, const RenderbufferFormat format, const Int samples) {
+    if(Entry<Renderbuffer>* const entry = findUnused(_renderbuffers, size, GLenum(format), samples, _frame))
+        return entry->object;
+
+    Renderbuffer renderbuffer;
+    if(samples) renderbuffer.setStorageMultisample(samples, format, size);
+    else renderbuffer.setStorage(format, size);
+    _renderbuffers.emplace_back(new Entry<Renderbuffer>{std::move(renderbuffer), size, GLenum(format), samples, _frame});
+    return _renderbuffers.back()->object;
+}
+
+Framebuffer& RenderTargetPool::acquireFramebuffer(const Vector2i& size) {
+    if(Entry<Framebuffer>* const entry = findUnused(_framebuffers, size, 0, 0, _frame)) {
+        entry->object.setViewport({{}, size});
+        return entry->object;
+    }
+
+    _framebuffers.emplace_back(new Entry<Framebuffer>{Framebuffer{{{}, size}}, size, 0, 0, _frame});
+    return _framebuffers.back()->object;
+}
+
+void RenderTargetPool::release(Texture2D& texture) {
+    Entry<Texture2D>* const entry = findEntry(_textures, texture);
+    CORRADE_ASSERT(entry && entry->used,
+        "RenderTargetPool::release(): texture not acquired from this pool", );
+    entry->used = false;
+}
+
+void RenderTargetPool::release(Renderbuffer& renderbuffer) {
+    Entry<Renderbuffer>* const entry = findEntry(_renderbuffers, renderbuffer);
+    CORRADE_ASSERT(entry && entry->used,
+        "RenderTargetPool::release(): renderbuffer not acquired from this pool", );
+    entry->used = false;
+}
+
+void RenderTargetPool::release(Framebuffer& framebuffer) {
+    Entry<Framebuffer>* const entry = findEntry(_framebuffers, framebuffer);
+    CORRADE_ASSERT(entry && entry->used,
+        "RenderTargetPool::release(): framebuffer not acquired from this pool", );
+    entry->used = false;
+}
+
+void RenderTargetPool::nextFrame() {
+    ++_frame;
+    removeUnused(_textures, _frame, _maxUnusedFrames);
+    removeUnused(_renderbuffers, _frame, _maxUnusedFrames);
+    removeUnused(_framebuffers, _frame, _maxUnusedFrames);
+}
+
+void RenderTargetPool::clear() {
+    removeUnused(_textures);
+    removeUnused(_renderbuffers);
+    removeUnused(_framebuffers);
+}
+
+}
@@ -0,0 +1,218 @@
+#ifndef Magnum_RenderTargetPool_h
+#define Magnum_RenderTargetPool_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::RenderTargetPool
+ */
+
+#include <memory>
+#include <vector>
+
+#include "Magnum/Framebuffer.h"
+#include "Magnum/Renderbuffer.h"
+#include "Magnum/Texture.h"
+#include "Magnum/Math/Vector2.h"
+
+namespace Magnum {
+
+/**
+@brief Transient render target pool
+
+Post-processing chains and other multi-pass rendering need a lot of
+temporary textures, renderbuffers and framebuffers, which get recreated every
+time the resolution or effect configuration changes. Creating GL objects and
+allocating their storage in the middle of a frame causes hitches and keeping
+a dedicated set for each pass wastes video memory. The pool hands out
+objects matching given size, format and sample count and recycles them once
+they are released, so passes whose lifetimes don't overlap share the same
+memory:
+@code
+RenderTargetPool pool;
+
+void MyApplication::drawEvent() {
+    // Scene is rendered into a pooled color texture
+    Texture2D& scene = pool.acquireTexture(size, TextureFormat::RGBA8);
+    Renderbuffer& depth = pool.acquireRenderbuffer(size, RenderbufferFormat::DepthComponent24);
+    Framebuffer& sceneFramebuffer = pool.acquireFramebuffer(size);
+    sceneFramebuffer.attachTexture(Framebuffer::ColorAttachment{0}, scene, 0)
+        .attachRenderbuffer(Framebuffer::BufferAttachment::Depth, depth);
+    // ...
+    pool.release(depth);
+    pool.release(sceneFramebuffer);
+
+    // Half-resolution blur pass, reading from the scene texture
+    Texture2D& blurred = pool.acquireTexture(size/2, TextureFormat::RGBA8);
+    // ...
+    pool.release(scene);
+
+    // This gets the same memory as the scene texture above
+    Texture2D& composed = pool.acquireTexture(size, TextureFormat::RGBA8);
+    // ...
+    pool.release(blurred);
+    pool.release(composed);
+
+    swapBuffers();
+    pool.nextFrame();
+}
+@endcode
+
+Objects that were not used for @ref maxUnusedFrames() frames are deleted in
+@ref nextFrame(), so targets of previous resolution or effect configuration
+don't stay around. In a steady state, no GL objects are created or deleted
+during the frame.
+
+The pool doesn't track what the objects are used for. Pooled framebuffers
+keep the attachments from their previous use, so each user is expected to
+attach everything it needs. Contents of the pooled textures and
+renderbuffers are undefined on acquire. Textures are created with one mip
+level, linear filtering and @ref Sampler::Wrapping::ClampToEdge wrapping.
+Aliasing is done on whole objects, so only targets with the same size, format
+and sample count share memory.
+*/
+class MAGNUM_EXPORT RenderTargetPool {
+    public:
+        /**
+         * @brief Constructor
+         * @param maxUnusedFrames   Count of frames after which unused
+         *      objects are deleted
+         *
+         * No objects are created until the first acquire.
+         */
+        explicit RenderTargetPool(UnsignedInt maxUnusedFrames = 2);
+
+        /** @brief Copying is not allowed */
+        RenderTargetPool(const RenderTargetPool&) = delete;
+
+        /** @brief Move constructor */
+        RenderTargetPool(RenderTargetPool&&) = default;
+
+        /** @brief Copying is not allowed */
+        RenderTargetPool& operator=(const RenderTargetPool&) = delete;
+
+        /** @brief Move assignment */
+        RenderTargetPool& operator=(RenderTargetPool&&) = default;
+
+        /** @brief Count of frames after which unused objects are deleted */
+        UnsignedInt maxUnusedFrames() const { return _maxUnusedFrames; }
+
+        /** @brief Count of pooled textures, both used and unused */
+        std::size_t textureCount() const { return _textures.size(); }
+
+        /** @brief Count of pooled renderbuffers, both used and unused */
+        std::size_t renderbufferCount() const { return _renderbuffers.size(); }
+
+        /** @brief Count of pooled framebuffers, both used and unused */
+        std::size_t framebufferCount() const { return _framebuffers.size(); }
+
+        /** @brief Count of acquired objects that were not released yet */
+        std::size_t usedCount() const;
+
+        /**
+         * @brief Acquire a texture
+         *
+         * Returns an unused pooled texture with given size and format or
+         * creates a new one. The reference stays valid until the texture
+         * is deleted in @ref nextFrame() or @ref clear(). Call
+         * @ref release(Texture2D&) when the texture is no longer needed.
+         */
+        Texture2D& acquireTexture(const Vector2i& size, TextureFormat format);
+
+        /**
+         * @brief Acquire a renderbuffer
+         * @param size      Size
+         * @param format    Internal format
+         * @param samples   Sample count. If `0`, the renderbuffer is not
+         *      multisampled.
+         *
+         * Returns an unused pooled renderbuffer with given size, format and
+         * sample count or creates a new one. Call @ref release(Renderbuffer&)
+         * when the renderbuffer is no longer needed.
+         * @see @ref Renderbuffer::setStorageMultisample()
+         */
+        Renderbuffer& acquireRenderbuffer(const Vector2i& size, RenderbufferFormat format, Int samples = 0);
+
+        /**
+         * @brief Acquire a framebuffer
+         *
+         * Returns an unused pooled framebuffer with given size or creates a
+         * new one. The viewport is reset to cover the whole size, the
+         * attachments are kept from the previous use. Call
+         * @ref release(Framebuffer&) when the framebuffer is no longer
+         * needed.
+         */
+        Framebuffer& acquireFramebuffer(const Vector2i& size);
+
+        /**
+         * @brief Release a texture
+         *
+         * Expects that the texture was acquired from this pool and not
+         * released yet. The texture is kept for subsequent acquires.
+         */
+        void release(Texture2D& texture);
+
+        /** @overload */
+        void release(Renderbuffer& renderbuffer);
+
+        /** @overload */
+        void release(Framebuffer& framebuffer);
+
+        /**
+         * @brief Advance to next frame
+         *
+         * Deletes all unused objects that were not acquired during last
+         * @ref maxUnusedFrames() frames.
+         */
+        void nextFrame();
+
+        /**
+         * @brief Delete all unused objects
+         *
+         * Objects that are currently acquired are kept.
+         */
+        void clear();
+
+    private:
+        template<class T> struct Entry {
+            explicit Entry(T&& object, const Vector2i& size, GLenum format, Int samples, UnsignedInt frame): object{std::move(object)}, size{size}, format{format}, samples{samples}, lastUsedFrame{frame}, used{true} {}
+
+            T object;
+            Vector2i size;
+            GLenum format;
+            Int samples;
+            UnsignedInt lastUsedFrame;
+            bool used;
+        };
+
+        UnsignedInt _maxUnusedFrames, _frame{};
+        std::vector<std::unique_ptr<Entry<Texture2D>>> _textures;
+        std::vector<std::unique_ptr<Entry<Renderbuffer>>> _renderbuffers;
+        std::vector<std::unique_ptr<Entry<Framebuffer>>> _framebuffers;
+};
+
+}
+
+#endif
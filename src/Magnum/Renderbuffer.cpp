@@ -27,11 +27,13 @@
 
 #include "Magnum/Context.h"
 #include "Magnum/Extensions.h"
+#include "Magnum/TextureFormat.h"
 
 #ifndef MAGNUM_TARGET_WEBGL
 #include "Implementation/DebugState.h"
 #endif
 #include "Implementation/FramebufferState.h"
+#include "Implementation/MemoryState.h"
 #include "Implementation/State.h"
 
 namespace Magnum {
@@ -91,6 +93,7 @@ Renderbuffer::~Renderbuffer() {
     GLuint& binding = Context::current().state().framebuffer->renderbufferBinding;
     if(binding == _id) binding = 0;
 
+    Context::current().state().memory->remove(Implementation::MemoryState::Type::Renderbuffer, _id);
     glDeleteRenderbuffers(1, &_id);
 }
 
@@ -114,17 +117,22 @@ std::string Renderbuffer::label() {
 Renderbuffer& Renderbuffer::setLabelInternal(const Containers::ArrayView<const char> label) {
     createIfNotAlready();
     Context::current().state().debug->labelImplementation(GL_RENDERBUFFER, _id, label);
+    Context::current().state().memory->setLabel(Implementation::MemoryState::Type::Renderbuffer, _id, label);
     return *this;
 }
 #endif
 
 void Renderbuffer::setStorage(const RenderbufferFormat internalFormat, const Vector2i& size) {
     (this->*Context::current().state().framebuffer->renderbufferStorageImplementation)(internalFormat, size);
+    Context::current().state().memory->setSize(Implementation::MemoryState::Type::Renderbuffer, _id,
+        Implementation::textureFormatDataSize(TextureFormat(GLenum(internalFormat)), size.product()));
 }
 
 #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
 void Renderbuffer::setStorageMultisample(const Int samples, const RenderbufferFormat internalFormat, const Vector2i& size) {
     (this->*Context::current().state().framebuffer->renderbufferStorageMultisampleImplementation)(samples, internalFormat, size);
+    Context::current().state().memory->setSize(Implementation::MemoryState::Type::Renderbuffer, _id,
+        Implementation::textureFormatDataSize(TextureFormat(GLenum(internalFormat)), size.product()*samples));
 }
 #endif
 
@@ -25,6 +25,8 @@
 
 #include "Renderer.h"
 
+#include <algorithm>
+
 #include "Magnum/Context.h"
 #include "Magnum/Extensions.h"
 #include "Magnum/Math/Color.h"
@@ -35,16 +37,64 @@
 
 namespace Magnum {
 
+namespace {
+
+/* Returns true if the call needs to be passed to GL, updates the shadowed
+   value and call statistics */
+template<class T> bool updateShadow(Implementation::RendererState& state, std::optional<T>& shadow, const T& value) {
+    if(shadow && *shadow == value) {
+        ++state.statistics.skippedCalls;
+        return false;
+    }
+
+    shadow = value;
+    ++state.statistics.issuedCalls;
+    return true;
+}
+
+/* Same as above, but updates both front and back faces. Front and back state
+   has to be compared separately, as they can differ after a separate call. */
+template<class T> bool updateShadow(Implementation::RendererState& state, std::optional<T>(&shadow)[2], const Renderer::PolygonFacing facing, const T& value) {
+    bool changed = false;
+    if(facing != Renderer::PolygonFacing::Back && !(shadow[0] && *shadow[0] == value)) {
+        shadow[0] = value;
+        changed = true;
+    }
+    if(facing != Renderer::PolygonFacing::Front && !(shadow[1] && *shadow[1] == value)) {
+        shadow[1] = value;
+        changed = true;
+    }
+
+    ++(changed ? state.statistics.issuedCalls : state.statistics.skippedCalls);
+    return changed;
+}
+
+}
+
 void Renderer::enable(const Feature feature) {
-    glEnable(GLenum(feature));
+    setFeature(feature, true);
 }
 
 void Renderer::disable(const Feature feature) {
-    glDisable(GLenum(feature));
+    setFeature(feature, false);
 }
 
 void Renderer::setFeature(const Feature feature, const bool enabled) {
-    enabled ? enable(feature) : disable(feature);
+    Implementation::RendererState& state = *Context::current().state().renderer;
+
+    auto found = std::find_if(state.shadow.features.begin(), state.shadow.features.end(), [feature](const std::pair<GLenum, bool>& f) {
+        return f.first == GLenum(feature);
+    });
+    if(found != state.shadow.features.end()) {
+        if(found->second == enabled) {
+            ++state.statistics.skippedCalls;
+            return;
+        }
+        found->second = enabled;
+    } else state.shadow.features.emplace_back(GLenum(feature), enabled);
+
+    ++state.statistics.issuedCalls;
+    enabled ? glEnable(GLenum(feature)) : glDisable(GLenum(feature));
 }
 
 void Renderer::setHint(const Hint target, const HintMode mode) {
@@ -81,6 +131,10 @@ void Renderer::setFaceCullingMode(const PolygonFacing mode) {
 void Renderer::setProvokingVertex(const ProvokingVertex mode) {
     glProvokingVertex(GLenum(mode));
 }
+
+void Renderer::setPrimitiveRestartIndex(const UnsignedInt index) {
+    glPrimitiveRestartIndex(index);
+}
 #endif
 
 #ifndef MAGNUM_TARGET_WEBGL
@@ -118,59 +172,87 @@ void Renderer::setScissor(const Range2Di& rectangle) {
 }
 
 void Renderer::setStencilFunction(const PolygonFacing facing, const StencilFunction function, const Int referenceValue, const UnsignedInt mask) {
-    glStencilFuncSeparate(GLenum(facing), GLenum(function), referenceValue, mask);
+    Implementation::RendererState& state = *Context::current().state().renderer;
+    if(updateShadow(state, state.shadow.stencilFunction, facing, std::make_tuple(GLenum(function), referenceValue, mask)))
+        glStencilFuncSeparate(GLenum(facing), GLenum(function), referenceValue, mask);
 }
 
 void Renderer::setStencilFunction(const StencilFunction function, const Int referenceValue, const UnsignedInt mask) {
-    glStencilFunc(GLenum(function), referenceValue, mask);
+    Implementation::RendererState& state = *Context::current().state().renderer;
+    if(updateShadow(state, state.shadow.stencilFunction, PolygonFacing::FrontAndBack, std::make_tuple(GLenum(function), referenceValue, mask)))
+        glStencilFunc(GLenum(function), referenceValue, mask);
 }
 
 void Renderer::setStencilOperation(const PolygonFacing facing, const StencilOperation stencilFail, const StencilOperation depthFail, const StencilOperation depthPass) {
-    glStencilOpSeparate(GLenum(facing), GLenum(stencilFail), GLenum(depthFail), GLenum(depthPass));
+    Implementation::RendererState& state = *Context::current().state().renderer;
+    if(updateShadow(state, state.shadow.stencilOperation, facing, std::array<GLenum, 3>{{GLenum(stencilFail), GLenum(depthFail), GLenum(depthPass)}}))
+        glStencilOpSeparate(GLenum(facing), GLenum(stencilFail), GLenum(depthFail), GLenum(depthPass));
 }
 
 void Renderer::setStencilOperation(const StencilOperation stencilFail, const StencilOperation depthFail, const StencilOperation depthPass) {
-    glStencilOp(GLenum(stencilFail), GLenum(depthFail), GLenum(depthPass));
+    Implementation::RendererState& state = *Context::current().state().renderer;
+    if(updateShadow(state, state.shadow.stencilOperation, PolygonFacing::FrontAndBack, std::array<GLenum, 3>{{GLenum(stencilFail), GLenum(depthFail), GLenum(depthPass)}}))
+        glStencilOp(GLenum(stencilFail), GLenum(depthFail), GLenum(depthPass));
 }
 
 void Renderer::setDepthFunction(const DepthFunction function) {
-    glDepthFunc(GLenum(function));
+    Implementation::RendererState& state = *Context::current().state().renderer;
+    if(updateShadow(state, state.shadow.depthFunction, GLenum(function)))
+        glDepthFunc(GLenum(function));
 }
 
 void Renderer::setColorMask(const GLboolean allowRed, const GLboolean allowGreen, const GLboolean allowBlue, const GLboolean allowAlpha) {
-    glColorMask(allowRed, allowGreen, allowBlue, allowAlpha);
+    Implementation::RendererState& state = *Context::current().state().renderer;
+    if(updateShadow(state, state.shadow.colorMask, std::array<GLboolean, 4>{{allowRed, allowGreen, allowBlue, allowAlpha}}))
+        glColorMask(allowRed, allowGreen, allowBlue, allowAlpha);
 }
 
 void Renderer::setDepthMask(const GLboolean allow) {
-    glDepthMask(allow);
+    Implementation::RendererState& state = *Context::current().state().renderer;
+    if(updateShadow(state, state.shadow.depthMask, allow))
+        glDepthMask(allow);
 }
 
 void Renderer::setStencilMask(const PolygonFacing facing, const UnsignedInt allowBits) {
-    glStencilMaskSeparate(GLenum(facing), allowBits);
+    Implementation::RendererState& state = *Context::current().state().renderer;
+    if(updateShadow(state, state.shadow.stencilMask, facing, allowBits))
+        glStencilMaskSeparate(GLenum(facing), allowBits);
 }
 
 void Renderer::setStencilMask(const UnsignedInt allowBits) {
-    glStencilMask(allowBits);
+    Implementation::RendererState& state = *Context::current().state().renderer;
+    if(updateShadow(state, state.shadow.stencilMask, PolygonFacing::FrontAndBack, allowBits))
+        glStencilMask(allowBits);
 }
 
 void Renderer::setBlendEquation(const BlendEquation equation) {
-    glBlendEquation(GLenum(equation));
+    Implementation::RendererState& state = *Context::current().state().renderer;
+    if(updateShadow(state, state.shadow.blendEquation, std::make_pair(GLenum(equation), GLenum(equation))))
+        glBlendEquation(GLenum(equation));
 }
 
 void Renderer::setBlendEquation(const BlendEquation rgb, const BlendEquation alpha) {
-    glBlendEquationSeparate(GLenum(rgb), GLenum(alpha));
+    Implementation::RendererState& state = *Context::current().state().renderer;
+    if(updateShadow(state, state.shadow.blendEquation, std::make_pair(GLenum(rgb), GLenum(alpha))))
+        glBlendEquationSeparate(GLenum(rgb), GLenum(alpha));
 }
 
 void Renderer::setBlendFunction(const BlendFunction source, const BlendFunction destination) {
-    glBlendFunc(GLenum(source), GLenum(destination));
+    Implementation::RendererState& state = *Context::current().state().renderer;
+    if(updateShadow(state, state.shadow.blendFunction, std::array<GLenum, 4>{{GLenum(source), GLenum(destination), GLenum(source), GLenum(destination)}}))
+        glBlendFunc(GLenum(source), GLenum(destination));
 }
 
 void Renderer::setBlendFunction(const BlendFunction sourceRgb, const BlendFunction destinationRgb, const BlendFunction sourceAlpha, const BlendFunction destinationAlpha) {
-    glBlendFuncSeparate(GLenum(sourceRgb), GLenum(destinationRgb), GLenum(sourceAlpha), GLenum(destinationAlpha));
+    Implementation::RendererState& state = *Context::current().state().renderer;
+    if(updateShadow(state, state.shadow.blendFunction, std::array<GLenum, 4>{{GLenum(sourceRgb), GLenum(destinationRgb), GLenum(sourceAlpha), GLenum(destinationAlpha)}}))
+        glBlendFuncSeparate(GLenum(sourceRgb), GLenum(destinationRgb), GLenum(sourceAlpha), GLenum(destinationAlpha));
 }
 
 void Renderer::setBlendColor(const Color4& color) {
-    glBlendColor(color.r(), color.g(), color.b(), color.a());
+    Implementation::RendererState& state = *Context::current().state().renderer;
+    if(updateShadow(state, state.shadow.blendColor, std::array<GLfloat, 4>{{color.r(), color.g(), color.b(), color.a()}}))
+        glBlendColor(color.r(), color.g(), color.b(), color.a());
 }
 
 #ifndef MAGNUM_TARGET_GLES
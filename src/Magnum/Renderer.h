@@ -42,6 +42,15 @@ namespace Implementation { struct RendererState; }
 /** @nosubgrouping
 @brief Global renderer configuration.
 
+@section Renderer-state-tracking Performance optimizations
+
+Feature toggles, blending, depth and stencil state is tracked by the engine
+and setters which would not change the current state don't result in any GL
+call. Counts of issued and skipped calls are available through
+@ref Context::stateStatistics(). If non-Magnum code modifies the state, call
+@ref Context::resetState() with @ref Context::State::Renderer to make the
+tracker aware of it.
+
 @todo @extension{ARB,viewport_array}
 @todo `GL_POINT_SIZE_GRANULARITY`, `GL_POINT_SIZE_RANGE` (?)
 @todo `GL_STEREO`, `GL_DOUBLEBUFFER` (?)
@@ -236,6 +245,30 @@ class MAGNUM_EXPORT Renderer {
              * @requires_gl Always enabled on OpenGL ES and WebGL.
              */
             ProgramPointSize = GL_PROGRAM_POINT_SIZE,
+
+            /**
+             * Primitive restart with a custom index.
+             * @see @ref setPrimitiveRestartIndex(),
+             *      @ref MeshTools::stripify()
+             * @requires_gl31 Extension @extension{NV,primitive_restart}
+             * @requires_gl Only @ref Feature::PrimitiveRestartFixedIndex is
+             *      available in OpenGL ES 3.0.
+             */
+            PrimitiveRestart = GL_PRIMITIVE_RESTART,
+            #endif
+
+            #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+            /**
+             * Primitive restart with the maximal value of the index type,
+             * see @ref Mesh::primitiveRestartIndex().
+             * @see @ref MeshTools::stripify()
+             * @requires_gl43 Extension @extension{ARB,ES3_compatibility}
+             * @requires_gles30 Primitive restart is not available in OpenGL
+             *      ES 2.0.
+             * @requires_gles Always enabled in WebGL 2.0, not available in
+             *      WebGL 1.0.
+             */
+            PrimitiveRestartFixedIndex = GL_PRIMITIVE_RESTART_FIXED_INDEX,
             #endif
 
             #ifndef MAGNUM_TARGET_GLES2
@@ -455,6 +488,19 @@ class MAGNUM_EXPORT Renderer {
          * @requires_gl OpenGL ES and WebGL behave always like the default.
          */
         static void setProvokingVertex(ProvokingVertex mode);
+
+        /**
+         * @brief Set primitive restart index
+         *
+         * Used if @ref Feature::PrimitiveRestart is enabled. Initial value is
+         * `0`.
+         * @see @fn_gl{PrimitiveRestartIndex}
+         * @requires_gl31 Extension @extension{NV,primitive_restart}
+         * @requires_gl Only fixed restart index is available in OpenGL ES
+         *      3.0 and WebGL 2.0, see
+         *      @ref Feature::PrimitiveRestartFixedIndex.
+         */
+        static void setPrimitiveRestartIndex(UnsignedInt index);
         #endif
 
         #ifndef MAGNUM_TARGET_WEBGL
@@ -1281,7 +1327,7 @@ class MAGNUM_EXPORT Renderer {
              *      3.0 and older.
              * @requires_gles Shader storage is not available in WebGL.
              */
-            ShaderStorage = GL_ATOMIC_COUNTER_BARRIER_BIT
+            ShaderStorage = GL_SHADER_STORAGE_BARRIER_BIT
         };
 
         /**
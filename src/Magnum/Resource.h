@@ -29,6 +29,7 @@
  * @brief Class @ref Magnum::ResourceKey, @ref Magnum::Resource, enum @ref Magnum::ResourceState
  */
 
+#include <atomic>
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/MurmurHash2.h>
 
@@ -128,22 +129,33 @@ class Resource {
          * Creates empty resource. Resources are acquired from the manager by
          * calling @ref ResourceManager::get().
          */
-        explicit Resource(): manager(nullptr), lastCheck(0), _state(ResourceState::Final), data(nullptr) {}
+        explicit Resource(): manager(nullptr), _entry(nullptr), lastCheck(0), _state(ResourceState::Final), data(nullptr) {}
 
-        /** @brief Copy constructor */
-        Resource(const Resource<T, U>& other): manager(other.manager), _key(other._key), lastCheck(other.lastCheck), _state(other._state), data(other.data) {
-            if(manager) manager->incrementReferenceCount(_key);
+        /**
+         * @brief Copy constructor
+         *
+         * Only atomically increments the reference count, doesn't need to
+         * lock the manager.
+         */
+        Resource(const Resource<T, U>& other): manager(other.manager), _entry(other._entry), _key(other._key), lastCheck(other.lastCheck), _state(other._state), data(other.data) {
+            if(manager) Implementation::ResourceManagerData<T>::incrementReferenceCount(*_entry);
         }
 
         /** @brief Move constructor */
-        Resource(Resource<T, U>&& other): manager(other.manager), _key(other._key), lastCheck(other.lastCheck), _state(other._state), data(other.data) {
+        Resource(Resource<T, U>&& other): manager(other.manager), _entry(other._entry), _key(other._key), lastCheck(other.lastCheck), _state(other._state), data(other.data) {
             /** @brief Make other's state well-defined */
             other.manager = nullptr;
         }
 
-        /** @brief Destructor */
+        /**
+         * @brief Destructor
+         *
+         * Atomically decrements the reference count. The manager is locked
+         * only if this was the last reference to a
+         * @ref ResourcePolicy::ReferenceCounted resource.
+         */
         ~Resource() {
-            if(manager) manager->decrementReferenceCount(_key);
+            if(manager) manager->decrementReferenceCount(_key, *_entry);
         }
 
         /** @brief Copy assignment */
@@ -215,13 +227,13 @@ class Resource {
         }
 
     private:
-        Resource(Implementation::ResourceManagerData<T>* manager, ResourceKey key): manager(manager), _key(key), lastCheck(0), _state(ResourceState::NotLoaded), data(nullptr) {
-            manager->incrementReferenceCount(key);
-        }
+        Resource(Implementation::ResourceManagerData<T>* manager, ResourceKey key): manager(manager), _entry(&manager->acquireReference(key)), _key(key), lastCheck(0), _state(ResourceState::NotLoaded), data(nullptr) {}
 
         void acquire();
 
         Implementation::ResourceManagerData<T>* manager;
+        /* Stays valid as long as there is at least one reference */
+        typename Implementation::ResourceManagerData<T>::Data* _entry;
         ResourceKey _key;
         std::size_t lastCheck;
         ResourceState _state;
@@ -229,23 +241,27 @@ class Resource {
 };
 
 template<class T, class U> Resource<T, U>& Resource<T, U>::operator=(const Resource<T, U>& other) {
-    if(manager) manager->decrementReferenceCount(_key);
+    /* Reference the new data first so self-assignment of the last reference
+       doesn't free the entry */
+    if(other.manager) Implementation::ResourceManagerData<T>::incrementReferenceCount(*other._entry);
+    if(manager) manager->decrementReferenceCount(_key, *_entry);
 
     manager = other.manager;
+    _entry = other._entry;
     _key = other._key;
     lastCheck = other.lastCheck;
     _state = other._state;
     data = other.data;
 
-    if(manager) manager->incrementReferenceCount(_key);
     return *this;
 }
 
 template<class T, class U> Resource<T, U>& Resource<T, U>::operator=(Resource<T, U>&& other) {
     /** @todo Just swap the values */
-    if(manager) manager->decrementReferenceCount(_key);
+    if(manager) manager->decrementReferenceCount(_key, *_entry);
 
     manager = other.manager;
+    _entry = other._entry;
     _key = other._key;
     lastCheck = other.lastCheck;
     _state = other._state;
@@ -262,13 +278,13 @@ template<class T, class U> void Resource<T, U>::acquire() {
     /* Nothing changed since last check */
     if(manager->lastChange() < lastCheck) return;
 
-    /* Acquire new data and save last check time */
-    const typename Implementation::ResourceManagerData<T>::Data& d = manager->data(_key);
+    /* Acquire new data and save last check time. The entry is kept alive by
+       our reference, so no lookup (and no locking) is needed. */
     lastCheck = manager->lastChange();
 
     /* Try to get the data */
-    data = d.data;
-    _state = static_cast<ResourceState>(d.state);
+    data = _entry->data.load(std::memory_order_acquire);
+    _state = static_cast<ResourceState>(_entry->state.load(std::memory_order_relaxed));
 
     /* Data are not available */
     if(!data) {
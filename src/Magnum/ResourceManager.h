@@ -29,6 +29,9 @@
  * @brief Class @ref Magnum::ResourceManager, @ref Magnum::ResourceDataState, @ref Magnum::ResourcePolicy
  */
 
+#include <atomic>
+#include <list>
+#include <mutex>
 #include <unordered_map>
 
 #include "Magnum/Resource.h"
@@ -85,7 +88,17 @@ enum class ResourcePolicy: UnsignedByte {
     Manual,
 
     /** The resource will be unloaded when last reference to it is gone. */
-    ReferenceCounted
+    ReferenceCounted,
+
+    /**
+     * The resource will be kept around after the last reference to it is
+     * gone, until the total size of cached resources of given type exceeds
+     * the budget set with @ref ResourceManager::setCacheBudget(). Then the
+     * least recently used resources that are not referenced are unloaded.
+     * An unloaded resource is requested from the loader again on next
+     * @ref ResourceManager::get().
+     */
+    Cached
 };
 
 template<class> class AbstractResourceLoader;
@@ -107,9 +120,9 @@ template<class T> class ResourceManagerData {
         ResourceManagerData<T>& operator=(const ResourceManagerData<T>&) = delete;
         ResourceManagerData<T>& operator=(ResourceManagerData<T>&&) = delete;
 
-        std::size_t lastChange() const { return _lastChange; }
+        std::size_t lastChange() const { return _lastChange.load(std::memory_order_acquire); }
 
-        std::size_t count() const { return _data.size(); }
+        std::size_t count() const;
 
         std::size_t referenceCount(ResourceKey key) const;
 
@@ -117,7 +130,13 @@ template<class T> class ResourceManagerData {
 
         template<class U> Resource<T, U> get(ResourceKey key);
 
-        void set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy);
+        void set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy, std::size_t size);
+
+        std::size_t cacheBudget() const;
+
+        void setCacheBudget(std::size_t budget);
+
+        std::size_t cacheSize() const;
 
         T* fallback() { return _fallback; }
         const T* fallback() const { return _fallback; }
@@ -126,7 +145,7 @@ template<class T> class ResourceManagerData {
 
         void free();
 
-        void clear() { _data.clear(); }
+        void clear();
 
         AbstractResourceLoader<T>* loader() { return _loader; }
         const AbstractResourceLoader<T>* loader() const { return _loader; }
@@ -136,23 +155,59 @@ template<class T> class ResourceManagerData {
         void setLoader(AbstractResourceLoader<T>* loader);
 
     protected:
-        ResourceManagerData(): _fallback(nullptr), _loader(nullptr), _lastChange(0) {}
+        ResourceManagerData(): _fallback(nullptr), _loader(nullptr), _lastChange(0), _cacheBudget(0), _cacheSize(0) {}
 
     private:
         struct Data;
 
-        const Data& data(ResourceKey key) { return _data[key]; }
+        /* The table is split into shards, each with its own lock, to avoid
+           contention when resources are acquired from multiple threads. The
+           lock is needed only for lookup, insertion and removal, as map nodes
+           don't move in memory and the reference count is atomic, so copying
+           and destroying a Resource doesn't need any lock. */
+        enum: std::size_t { ShardCount = 16 };
+        struct Shard {
+            mutable std::mutex mutex;
+            std::unordered_map<ResourceKey, Data> data;
+        };
+
+        Shard& shard(ResourceKey key) {
+            return _shards[std::hash<ResourceKey>{}(key) % ShardCount];
+        }
+        const Shard& shard(ResourceKey key) const {
+            return _shards[std::hash<ResourceKey>{}(key) % ShardCount];
+        }
 
-        void incrementReferenceCount(ResourceKey key) {
-            ++_data[key].referenceCount;
+        /* Finds or inserts the data and increments its reference count */
+        Data& acquireReference(ResourceKey key);
+
+        static void incrementReferenceCount(Data& data) {
+            data.referenceCount.fetch_add(1, std::memory_order_relaxed);
         }
 
-        void decrementReferenceCount(ResourceKey key);
+        void decrementReferenceCount(ResourceKey key, Data& data);
+
+        /* Cached resources. The queue contains unreferenced ones, least
+           recently used first, the size is a sum over all of them,
+           including the referenced ones. Guarded by the cache mutex, which
+           is always locked after the shard mutex, never before. */
+        void enqueue(ResourceKey key, Data& data);
+        void dequeue(Data& data);
+        void uncache(Data& data);
 
-        std::unordered_map<ResourceKey, Data> _data;
+        /* Unloads unreferenced cached resources until the cache fits into
+           the budget. Expects that no shard lock is held. The resource
+           identified by @p keep is not unloaded. */
+        void evict(const ResourceKey* keep);
+
+        Shard _shards[ShardCount];
         T* _fallback;
         AbstractResourceLoader<T>* _loader;
-        std::size_t _lastChange;
+        std::atomic<std::size_t> _lastChange;
+
+        mutable std::mutex _cacheMutex;
+        std::list<ResourceKey> _cacheQueue;
+        std::size_t _cacheBudget, _cacheSize;
 };
 
 /* Helper class for defining which real types are in the type pack */
@@ -201,11 +256,12 @@ instead of failing on null pointer dereference. Availability and state of each
 resource can be queried through function @ref state() on the manager or
 @ref Resource::state() on each resource.
 
-The resources can be managed in three ways - resident resources, which stay in
+The resources can be managed in four ways - resident resources, which stay in
 memory for whole lifetime of the manager, manually managed resources, which
-can be deleted by calling @ref free() if nothing references them anymore, and
+can be deleted by calling @ref free() if nothing references them anymore,
 reference counted resources, which are deleted as soon as the last reference
-to them is removed.
+to them is removed, and cached resources, which are deleted only when they
+are not referenced and the cache runs out of its budget.
 
 Resource state and policy is configured when setting the resource data in
 @ref set() and can be changed each time the data are updated, although already
@@ -242,7 +298,46 @@ cube->draw(*shader);
 -   Destroying resource references and deleting manager instance when nothing
     references the resources anymore.
 
-@see @ref AbstractResourceLoader
+## Caching
+
+Resources that are repeatedly acquired and released, such as textures for
+objects that go in and out of view, would be unloaded and loaded again every
+time with @ref ResourcePolicy::ReferenceCounted. With
+@ref ResourcePolicy::Cached the unreferenced resources are kept until the
+total size of all cached resources of given type exceeds a budget set with
+@ref setCacheBudget(), least recently used resources are unloaded first. The
+size of each resource is passed to @ref set(), for GPU resources it can be
+obtained for example from a difference of @ref Context::memoryUsage() before
+and after the upload, with @ref Context::setMemoryAccountingEnabled() "memory accounting"
+enabled. Unloaded resources are requested from the @ref AbstractResourceLoader
+again when acquired next time.
+@code
+manager.setLoader(new MyTextureLoader)
+    .setCacheBudget<Texture2D>(256*1024*1024);
+
+// in MyTextureLoader::doLoad()
+set(key, std::move(texture), ResourceDataState::Final, ResourcePolicy::Cached, size);
+@endcode
+
+## Thread safety
+
+Resources can be acquired with @ref get(), set with @ref set() and queried
+with @ref state(), @ref referenceCount() and @ref count() from multiple
+threads at once. The resource table is split into independently locked shards
+so lookups of different keys rarely contend. Copying and destroying
+@ref Resource instances only atomically updates the reference count. The lock
+is taken only when the last reference to a
+@ref ResourcePolicy::ReferenceCounted or @ref ResourcePolicy::Cached resource
+goes away.
+
+Configuring the manager with @ref setFallback() or @ref setLoader(), calling
+@ref free() or @ref clear() while other threads access the manager and
+replacing @ref ResourceDataState::Mutable data while another thread
+dereferences them is not safe. Data of a particular @ref Resource instance
+are accessed without any synchronization. Share the instance by copying it,
+not by reference.
+
+@see @ref AbstractResourceLoader, @ref AbstractThreadedResourceLoader
 */
 /* Due to too much work involved with explicit template instantiation (all
    Resource combinations, all ResourceManagerData...), this class doesn't have
@@ -315,24 +410,33 @@ template<class... Types> class ResourceManager: private Implementation::Resource
 
         /**
          * @brief Set resource data
+         * @param key       Resource key
+         * @param data      Resource data
+         * @param state     Resource state
+         * @param policy    Resource policy
+         * @param size      Resource size in bytes, used only for
+         *      @ref ResourcePolicy::Cached resources
          * @return Reference to self (for method chaining)
          *
          * Resources with @ref ResourcePolicy::ReferenceCounted are added with
          * zero reference count. It means that all reference counted resources
          * which were only loaded but not used will stay loaded and you need to
-         * explicitly call @ref free() to delete them.
+         * explicitly call @ref free() to delete them. Resources with
+         * @ref ResourcePolicy::Cached are treated as unreferenced and can be
+         * unloaded to fit into @ref cacheBudget(), except for the resource
+         * being set.
          * @attention Subsequent updates are not possible if resource state is
          *      already @ref ResourceState::Final.
          * @see @ref referenceCount(), @ref state()
          */
-        template<class T> ResourceManager<Types...>& set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy) {
-            this->Implementation::ResourceManagerData<T>::set(key, data, state, policy);
+        template<class T> ResourceManager<Types...>& set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy, std::size_t size = 0) {
+            this->Implementation::ResourceManagerData<T>::set(key, data, state, policy, size);
             return *this;
         }
 
         /** @overload */
-        template<class U> ResourceManager<Types...>& set(ResourceKey key, U&& data, ResourceDataState state, ResourcePolicy policy) {
-            return set(key, new typename std::decay<U>::type(std::forward<U>(data)), state, policy);
+        template<class U> ResourceManager<Types...>& set(ResourceKey key, U&& data, ResourceDataState state, ResourcePolicy policy, std::size_t size = 0) {
+            return set(key, new typename std::decay<U>::type(std::forward<U>(data)), state, policy, size);
         }
 
         /**
@@ -351,6 +455,44 @@ template<class... Types> class ResourceManager: private Implementation::Resource
             return set(key, new typename std::decay<U>::type(std::forward<U>(data)));
         }
 
+        /**
+         * @brief Cache budget for given type of resources
+         *
+         * Default is `0`, meaning that @ref ResourcePolicy::Cached resources
+         * are unloaded as soon as they are not referenced.
+         * @see @ref cacheSize()
+         */
+        template<class T> std::size_t cacheBudget() const {
+            return this->Implementation::ResourceManagerData<T>::cacheBudget();
+        }
+
+        /**
+         * @brief Set cache budget for given type of resources
+         * @return Reference to self (for method chaining)
+         *
+         * Maximal total size of @ref ResourcePolicy::Cached resources of
+         * given type, in the same units as the size passed to @ref set().
+         * If the budget is exceeded, least recently used resources that are
+         * not referenced are unloaded, referenced resources are never
+         * unloaded. Unloads resources immediately if the new budget is
+         * smaller than @ref cacheSize().
+         */
+        template<class T> ResourceManager<Types...>& setCacheBudget(std::size_t budget) {
+            this->Implementation::ResourceManagerData<T>::setCacheBudget(budget);
+            return *this;
+        }
+
+        /**
+         * @brief Size of cached resources of given type
+         *
+         * Sum of sizes of all @ref ResourcePolicy::Cached resources of given
+         * type, both referenced and unreferenced. Can be larger than
+         * @ref cacheBudget() if too many of them are referenced.
+         */
+        template<class T> std::size_t cacheSize() const {
+            return this->Implementation::ResourceManagerData<T>::cacheSize();
+        }
+
         /** @brief Fallback for not found resources */
         template<class T> T* fallback() {
             return this->Implementation::ResourceManagerData<T>::fallback();
@@ -478,65 +620,185 @@ template<class T> ResourceManagerData<T>::~ResourceManagerData() {
     safeDelete(_fallback);
 }
 
+template<class T> std::size_t ResourceManagerData<T>::count() const {
+    std::size_t count = 0;
+    for(const Shard& shard: _shards) {
+        std::unique_lock<std::mutex> lock{shard.mutex};
+        count += shard.data.size();
+    }
+    return count;
+}
+
 template<class T> std::size_t ResourceManagerData<T>::referenceCount(const ResourceKey key) const {
-    auto it = _data.find(key);
-    if(it == _data.end()) return 0;
-    return it->second.referenceCount;
+    const Shard& shard = this->shard(key);
+    std::unique_lock<std::mutex> lock{shard.mutex};
+    auto it = shard.data.find(key);
+    if(it == shard.data.end()) return 0;
+    return it->second.referenceCount.load(std::memory_order_relaxed);
 }
 
 template<class T> ResourceState ResourceManagerData<T>::state(const ResourceKey key) const {
-    const auto it = _data.find(key);
+    const Shard& shard = this->shard(key);
+    std::unique_lock<std::mutex> lock{shard.mutex};
+    const auto it = shard.data.find(key);
+    const auto end = shard.data.end();
 
     /* Resource not loaded */
-    if(it == _data.end() || !it->second.data) {
+    if(it == end || !it->second.data) {
         /* Fallback found, add *Fallback to state */
         if(_fallback) {
-            if(it != _data.end() && it->second.state == ResourceDataState::Loading)
+            if(it != end && it->second.state == ResourceDataState::Loading)
                 return ResourceState::LoadingFallback;
-            else if(it != _data.end() && it->second.state == ResourceDataState::NotFound)
+            else if(it != end && it->second.state == ResourceDataState::NotFound)
                 return ResourceState::NotFoundFallback;
             else return ResourceState::NotLoadedFallback;
         }
 
         /* Fallback not found, loading didn't start yet */
-        if(it == _data.end() || (it->second.state != ResourceDataState::Loading && it->second.state != ResourceDataState::NotFound))
+        if(it == end || (it->second.state != ResourceDataState::Loading && it->second.state != ResourceDataState::NotFound))
             return ResourceState::NotLoaded;
     }
 
     /* Loading / NotFound without fallback, Mutable / Final */
-    return static_cast<ResourceState>(it->second.state);
+    return static_cast<ResourceState>(it->second.state.load(std::memory_order_relaxed));
 }
 
 template<class T> template<class U> Resource<T, U> ResourceManagerData<T>::get(ResourceKey key) {
-    /* Ask loader for the data, if they aren't there yet */
-    if(_loader && _data.find(key) == _data.end())
-        _loader->load(key);
+    /* Ask loader for the data, if they aren't there yet. The lock can't be
+       held while loading, as the loader calls set(). */
+    if(_loader) {
+        Shard& shard = this->shard(key);
+        bool found;
+        {
+            std::unique_lock<std::mutex> lock{shard.mutex};
+            found = shard.data.find(key) != shard.data.end();
+        }
+        if(!found) _loader->load(key);
+    }
 
     return Resource<T, U>(this, key);
 }
 
-template<class T> void ResourceManagerData<T>::set(const ResourceKey key, T* const data, const ResourceDataState state, const ResourcePolicy policy) {
-    auto it = _data.find(key);
+template<class T> auto ResourceManagerData<T>::acquireReference(const ResourceKey key) -> Data& {
+    Shard& shard = this->shard(key);
+    std::unique_lock<std::mutex> lock{shard.mutex};
+    Data& data = shard.data[key];
+
+    /* The count can go from zero only here, under the lock, so a cached
+       resource that's referenced again can be safely taken off the queue */
+    if(!data.referenceCount.fetch_add(1, std::memory_order_relaxed) && data.queued)
+        dequeue(data);
+    return data;
+}
+
+template<class T> void ResourceManagerData<T>::enqueue(const ResourceKey key, Data& data) {
+    std::unique_lock<std::mutex> lock{_cacheMutex};
+    data.queuePosition = _cacheQueue.insert(_cacheQueue.end(), key);
+    data.queued = true;
+}
+
+template<class T> void ResourceManagerData<T>::dequeue(Data& data) {
+    std::unique_lock<std::mutex> lock{_cacheMutex};
+    _cacheQueue.erase(data.queuePosition);
+    data.queued = false;
+}
+
+template<class T> void ResourceManagerData<T>::uncache(Data& data) {
+    std::unique_lock<std::mutex> lock{_cacheMutex};
+    _cacheSize -= data.size;
+    if(data.queued) {
+        _cacheQueue.erase(data.queuePosition);
+        data.queued = false;
+    }
+}
+
+template<class T> void ResourceManagerData<T>::evict(const ResourceKey* const keep) {
+    for(;;) {
+        /* Pick the least recently used resource */
+        ResourceKey key;
+        {
+            std::unique_lock<std::mutex> lock{_cacheMutex};
+            if(_cacheSize <= _cacheBudget || _cacheQueue.empty()) return;
+            key = _cacheQueue.front();
+        }
+
+        /* It's the only unreferenced one left */
+        if(keep && key == *keep) return;
+
+        /* The cache mutex had to be released to lock the shard, so check
+           that the resource wasn't referenced or removed in the meantime */
+        Shard& shard = this->shard(key);
+        std::unique_lock<std::mutex> lock{shard.mutex};
+        auto it = shard.data.find(key);
+        if(it == shard.data.end() || !it->second.queued) continue;
+
+        uncache(it->second);
+        shard.data.erase(it);
+    }
+}
+
+template<class T> void ResourceManagerData<T>::set(const ResourceKey key, T* const data, const ResourceDataState state, const ResourcePolicy policy, const std::size_t size) {
+    Shard& shard = this->shard(key);
+    std::unique_lock<std::mutex> lock{shard.mutex};
+    auto it = shard.data.find(key);
 
     /* NotFound / Loading state shouldn't have any data */
     CORRADE_ASSERT((data == nullptr) == (state == ResourceDataState::NotFound || state == ResourceDataState::Loading),
         "ResourceManager::set(): data should be null if and only if state is NotFound or Loading", );
 
     /* Cannot change resource with already final state */
-    CORRADE_ASSERT(it == _data.end() || it->second.state != ResourceDataState::Final,
+    CORRADE_ASSERT(it == shard.data.end() || it->second.state != ResourceDataState::Final,
         "ResourceManager::set(): cannot change already final resource" << key, );
 
     /* Insert the resource, if not already there */
-    if(it == _data.end())
-        it = _data.emplace(key, Data()).first;
+    if(it == shard.data.end())
+        it = shard.data.emplace(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple()).first;
 
     /* Otherwise delete previous data */
-    else safeDelete(it->second.data);
+    else {
+        safeDelete(it->second.data.load(std::memory_order_relaxed));
+        if(it->second.policy == ResourcePolicy::Cached) uncache(it->second);
+    }
 
-    it->second.data = data;
-    it->second.state = state;
+    /* Publish the state before the data so Resource::acquire() on another
+       thread sees a consistent pair for final resources */
+    it->second.state.store(state, std::memory_order_relaxed);
     it->second.policy = policy;
-    ++_lastChange;
+    it->second.size = size;
+    it->second.data.store(data, std::memory_order_release);
+    _lastChange.fetch_add(1, std::memory_order_acq_rel);
+
+    if(policy != ResourcePolicy::Cached) return;
+
+    {
+        std::unique_lock<std::mutex> cacheLock{_cacheMutex};
+        _cacheSize += size;
+    }
+    if(!it->second.referenceCount.load(std::memory_order_acquire))
+        enqueue(key, it->second);
+
+    /* Make room for the new resource, but don't throw it away right after it
+       was loaded */
+    lock.unlock();
+    evict(&key);
+}
+
+template<class T> std::size_t ResourceManagerData<T>::cacheBudget() const {
+    std::unique_lock<std::mutex> lock{_cacheMutex};
+    return _cacheBudget;
+}
+
+template<class T> void ResourceManagerData<T>::setCacheBudget(const std::size_t budget) {
+    {
+        std::unique_lock<std::mutex> lock{_cacheMutex};
+        _cacheBudget = budget;
+    }
+    evict(nullptr);
+}
+
+template<class T> std::size_t ResourceManagerData<T>::cacheSize() const {
+    std::unique_lock<std::mutex> lock{_cacheMutex};
+    return _cacheSize;
 }
 
 template<class T> void ResourceManagerData<T>::setFallback(T* const data) {
@@ -546,13 +808,29 @@ template<class T> void ResourceManagerData<T>::setFallback(T* const data) {
 
 template<class T> void ResourceManagerData<T>::free() {
     /* Delete all non-referenced non-resident resources */
-    for(auto it = _data.begin(); it != _data.end(); ) {
-        if(it->second.policy != ResourcePolicy::Resident && !it->second.referenceCount)
-            it = _data.erase(it);
-        else ++it;
+    for(Shard& shard: _shards) {
+        std::unique_lock<std::mutex> lock{shard.mutex};
+        for(auto it = shard.data.begin(); it != shard.data.end(); ) {
+            if(it->second.policy != ResourcePolicy::Resident && !it->second.referenceCount.load(std::memory_order_acquire)) {
+                if(it->second.policy == ResourcePolicy::Cached)
+                    uncache(it->second);
+                it = shard.data.erase(it);
+            } else ++it;
+        }
     }
 }
 
+template<class T> void ResourceManagerData<T>::clear() {
+    for(Shard& shard: _shards) {
+        std::unique_lock<std::mutex> lock{shard.mutex};
+        shard.data.clear();
+    }
+
+    std::unique_lock<std::mutex> lock{_cacheMutex};
+    _cacheQueue.clear();
+    _cacheSize = 0;
+}
+
 template<class T> void ResourceManagerData<T>::setLoader(AbstractResourceLoader<T>* const loader) {
     /* Delete previous loader */
     delete _loader;
@@ -568,40 +846,64 @@ template<class T> void ResourceManagerData<T>::freeLoader() {
     delete _loader;
 }
 
-template<class T> void ResourceManagerData<T>::decrementReferenceCount(ResourceKey key) {
-    auto it = _data.find(key);
-    CORRADE_INTERNAL_ASSERT(it != _data.end());
+template<class T> void ResourceManagerData<T>::decrementReferenceCount(const ResourceKey key, Data& data) {
+    /* Fast path, no lock needed unless this was the last reference */
+    if(data.referenceCount.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        return;
+
+    /* Free the resource if it is reference counted or put it into the cache
+       queue if it is cached. Another thread might have acquired a new
+       reference in the meantime (only possible through get(), which holds
+       the lock) or already removed the entry, so look it up again and check
+       the count under the lock. */
+    {
+        Shard& shard = this->shard(key);
+        std::unique_lock<std::mutex> lock{shard.mutex};
+        auto it = shard.data.find(key);
+        if(it == shard.data.end() || it->second.referenceCount.load(std::memory_order_acquire))
+            return;
+
+        if(it->second.policy == ResourcePolicy::ReferenceCounted) {
+            shard.data.erase(it);
+            return;
+        }
+
+        if(it->second.policy != ResourcePolicy::Cached || it->second.queued)
+            return;
 
-    /* Free the resource if it is reference counted */
-    if(--it->second.referenceCount == 0 && it->second.policy == ResourcePolicy::ReferenceCounted)
-        _data.erase(it);
+        enqueue(key, it->second);
+    }
+
+    evict(nullptr);
 }
 
 template<class T> struct ResourceManagerData<T>::Data {
-    Data(): data(nullptr), state(ResourceDataState::Mutable), policy(ResourcePolicy::Manual), referenceCount(0) {}
+    Data(): data(nullptr), state(ResourceDataState::Mutable), policy(ResourcePolicy::Manual), referenceCount(0), size(0), queued(false) {}
 
     Data(const Data&) = delete;
 
-    Data(Data&& other): data(other.data), state(other.state), policy(other.policy), referenceCount(other.referenceCount) {
-        other.data = nullptr;
-        other.referenceCount = 0;
-    }
+    Data(Data&&) = delete;
 
     ~Data();
 
     Data& operator=(const Data&) = delete;
     Data& operator=(Data&&) = delete;
 
-    T* data;
-    ResourceDataState state;
+    std::atomic<T*> data;
+    std::atomic<ResourceDataState> state;
     ResourcePolicy policy;
-    std::size_t referenceCount;
+    std::atomic<std::size_t> referenceCount;
+
+    /* Used only for ResourcePolicy::Cached */
+    std::size_t size;
+    typename std::list<ResourceKey>::iterator queuePosition;
+    bool queued;
 };
 
 template<class T> inline ResourceManagerData<T>::Data::~Data() {
-    CORRADE_ASSERT(referenceCount == 0,
+    CORRADE_ASSERT(referenceCount.load(std::memory_order_relaxed) == 0,
         "ResourceManager: cleared/destroyed while data are still referenced", );
-    safeDelete(data);
+    safeDelete(data.load(std::memory_order_relaxed));
 }
 
 }
@@ -185,6 +185,19 @@ class SampleQuery: public AbstractQuery {
         };
         #endif
 
+        /**
+         * @brief Create multiple sample queries at once
+         * @param count         Query count
+         * @param target        Query target
+         *
+         * Equivalent to constructing @p count instances using
+         * @ref SampleQuery(Target), but creates all OpenGL objects using a single
+         * @fn_gl{CreateQueries} (or @fn_gl{GenQueries}) call.
+         */
+        static std::vector<SampleQuery> createArray(std::size_t count, Target target) {
+            return createArrayInternal<SampleQuery>(count, target);
+        }
+
         /**
          * @brief Wrap existing OpenGL sample query object
          * @param id            OpenGL sample query ID
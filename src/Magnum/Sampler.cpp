@@ -25,12 +25,18 @@
 
 #include "Sampler.h"
 
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Utility/Debug.h>
 
 #include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Instrumentation.h"
+#include "Magnum/Math/Color.h"
+#ifndef MAGNUM_TARGET_WEBGL
+#include "Magnum/Implementation/DebugState.h"
+#endif
 #include "Magnum/Implementation/State.h"
 #include "Magnum/Implementation/TextureState.h"
-#include "Magnum/Extensions.h"
 
 namespace Magnum {
 
@@ -60,6 +66,169 @@ Float Sampler::maxMaxAnisotropy() {
     return value;
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void Sampler::unbind(const Int textureUnit) {
+    GLuint& binding = Context::current().state().texture->samplerBindings[textureUnit];
+
+    /* If given texture unit is already unbound, nothing to do */
+    if(binding == 0) return;
+
+    /* Unbind the sampler, reset state tracker */
+    binding = 0;
+    glBindSampler(textureUnit, 0);
+}
+
+void Sampler::unbind(const Int firstTextureUnit, const std::size_t count) {
+    /* State tracker is updated in the implementations */
+    Context::current().state().texture->bindSamplersImplementation(firstTextureUnit, {nullptr, count});
+}
+
+/** @todoc const std::initializer_list makes Doxygen grumpy */
+void Sampler::bind(const Int firstTextureUnit, std::initializer_list<Sampler*> samplers) {
+    /* State tracker is updated in the implementations */
+    Context::current().state().texture->bindSamplersImplementation(firstTextureUnit, {samplers.begin(), samplers.size()});
+}
+
+void Sampler::bindImplementationFallback(const GLint firstTextureUnit, const Containers::ArrayView<Sampler* const> samplers) {
+    for(std::size_t i = 0; i != samplers.size(); ++i)
+        samplers && samplers[i] ? samplers[i]->bind(firstTextureUnit + i) : unbind(firstTextureUnit + i);
+}
+
+#ifndef MAGNUM_TARGET_GLES
+/** @todoc const Containers::ArrayView makes Doxygen grumpy */
+void Sampler::bindImplementationMulti(const GLint firstTextureUnit, Containers::ArrayView<Sampler* const> samplers) {
+    Implementation::TextureState& textureState = *Context::current().state().texture;
+
+    /* Create array of IDs and also update bindings in state tracker */
+    Containers::Array<GLuint> ids{samplers ? samplers.size() : 0};
+    bool different = false;
+    for(std::size_t i = 0; i != samplers.size(); ++i) {
+        const GLuint id = samplers && samplers[i] ? samplers[i]->_id : 0;
+        if(samplers) ids[i] = id;
+
+        if(textureState.samplerBindings[firstTextureUnit + i] != id) {
+            different = true;
+            textureState.samplerBindings[firstTextureUnit + i] = id;
+        }
+    }
+
+    /* Avoid doing the binding if there is nothing different */
+    if(different) glBindSamplers(firstTextureUnit, samplers.size(), ids);
+}
+#endif
+
+Sampler::Sampler(): _flags{ObjectFlag::DeleteOnDestruction} {
+    /* Unlike with other objects, glGenSamplers() creates the object right
+       away, so glSamplerParameter() can be called on it directly */
+    glGenSamplers(1, &_id);
+    _flags |= ObjectFlag::Created;
+}
+
+Sampler::~Sampler() {
+    /* Moved out or not deleting on destruction, nothing to do */
+    if(!_id || !(_flags & ObjectFlag::DeleteOnDestruction)) return;
+
+    /* Remove all bindings */
+    for(GLuint& binding: Context::current().state().texture->samplerBindings)
+        if(binding == _id) binding = 0;
+
+    glDeleteSamplers(1, &_id);
+}
+
+#ifndef MAGNUM_TARGET_WEBGL
+std::string Sampler::label() const {
+    #ifndef MAGNUM_TARGET_GLES
+    return Context::current().state().debug->getLabelImplementation(GL_SAMPLER, _id);
+    #else
+    return Context::current().state().debug->getLabelImplementation(GL_SAMPLER_KHR, _id);
+    #endif
+}
+
+Sampler& Sampler::setLabelInternal(const Containers::ArrayView<const char> label) {
+    #ifndef MAGNUM_TARGET_GLES
+    Context::current().state().debug->labelImplementation(GL_SAMPLER, _id, label);
+    #else
+    Context::current().state().debug->labelImplementation(GL_SAMPLER_KHR, _id, label);
+    #endif
+    return *this;
+}
+#endif
+
+void Sampler::bind(const Int textureUnit) {
+    GLuint& binding = Context::current().state().texture->samplerBindings[textureUnit];
+
+    /* If already bound in given texture unit, nothing to do */
+    if(binding == _id) return;
+
+    /* Update state tracker, bind the sampler to the unit */
+    binding = _id;
+    glBindSampler(textureUnit, _id);
+}
+
+Sampler& Sampler::setMinificationFilter(const Filter filter, const Mipmap mipmap) {
+    glSamplerParameteri(_id, GL_TEXTURE_MIN_FILTER, GLint(filter)|GLint(mipmap));
+    return *this;
+}
+
+Sampler& Sampler::setMagnificationFilter(const Filter filter) {
+    glSamplerParameteri(_id, GL_TEXTURE_MAG_FILTER, GLint(filter));
+    return *this;
+}
+
+Sampler& Sampler::setMinLod(const Float lod) {
+    glSamplerParameterf(_id, GL_TEXTURE_MIN_LOD, lod);
+    return *this;
+}
+
+Sampler& Sampler::setMaxLod(const Float lod) {
+    glSamplerParameterf(_id, GL_TEXTURE_MAX_LOD, lod);
+    return *this;
+}
+
+#ifndef MAGNUM_TARGET_GLES
+Sampler& Sampler::setLodBias(const Float bias) {
+    glSamplerParameterf(_id, GL_TEXTURE_LOD_BIAS, bias);
+    return *this;
+}
+#endif
+
+Sampler& Sampler::setWrapping(const Array3D<Wrapping>& wrapping) {
+    glSamplerParameteri(_id, GL_TEXTURE_WRAP_S, GLint(wrapping.x()));
+    glSamplerParameteri(_id, GL_TEXTURE_WRAP_T, GLint(wrapping.y()));
+    glSamplerParameteri(_id, GL_TEXTURE_WRAP_R, GLint(wrapping.z()));
+    return *this;
+}
+
+#ifndef MAGNUM_TARGET_WEBGL
+Sampler& Sampler::setBorderColor(const Color4& color) {
+    glSamplerParameterfv(_id,
+        #ifndef MAGNUM_TARGET_GLES
+        GL_TEXTURE_BORDER_COLOR,
+        #else
+        GL_TEXTURE_BORDER_COLOR_EXT,
+        #endif
+        color.data());
+    return *this;
+}
+#endif
+
+Sampler& Sampler::setMaxAnisotropy(const Float anisotropy) {
+    if(Context::current().isExtensionSupported<Extensions::GL::EXT::texture_filter_anisotropic>())
+        glSamplerParameterf(_id, GL_TEXTURE_MAX_ANISOTROPY_EXT, anisotropy);
+    return *this;
+}
+
+Sampler& Sampler::setCompareMode(const CompareMode mode) {
+    glSamplerParameteri(_id, GL_TEXTURE_COMPARE_MODE, GLenum(mode));
+    return *this;
+}
+
+Sampler& Sampler::setCompareFunction(const CompareFunction function) {
+    glSamplerParameteri(_id, GL_TEXTURE_COMPARE_FUNC, GLenum(function));
+    return *this;
+}
+#endif
+
 #ifndef DOXYGEN_GENERATING_OUTPUT
 Debug& operator<<(Debug& debug, const Sampler::Filter value) {
     switch(value) {
@@ -29,19 +29,66 @@
  * @brief Class @ref Magnum::Sampler
  */
 
+#include <initializer_list>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/AbstractObject.h"
+#include "Magnum/Array.h"
 #include "Magnum/Magnum.h"
 #include "Magnum/OpenGL.h"
+#include "Magnum/Tags.h"
 #include "Magnum/visibility.h"
 
 namespace Magnum {
 
+namespace Implementation { struct TextureState; }
+
 /**
 @brief Texture sampler
 
+Contains enums describing texture sampling parameters and, on platforms that
+support it, wraps an OpenGL sampler object. A sampler object holds the
+filtering, wrapping, LOD and comparison state separately from the texture.
+When bound to a texture unit it overrides the sampling parameters of any
+texture bound to the same unit, which allows to sample one texture in many
+different ways without touching the texture itself:
+
+@code
+Sampler linear, nearest;
+linear.setMinificationFilter(Sampler::Filter::Linear, Sampler::Mipmap::Linear)
+    .setMagnificationFilter(Sampler::Filter::Linear);
+nearest.setMinificationFilter(Sampler::Filter::Nearest)
+    .setMagnificationFilter(Sampler::Filter::Nearest);
+
+texture.bind(0);
+linear.bind(0);
+// draw ...
+nearest.bind(0);
+// draw the same texture again, nearest-filtered ...
+@endcode
+
+To share samplers with the same state across materials, use
+@ref SamplerCache.
+
+## Performance optimizations
+
+The engine tracks currently bound samplers in all available texture units to
+avoid unnecessary calls to @fn_gl{BindSampler}. If @extension{ARB,multi_bind}
+(part of OpenGL 4.4) is available, @ref bind(Int, std::initializer_list<Sampler*>)
+binds all samplers in a single @fn_gl{BindSamplers} call. Sampler parameters
+are set directly on the object using @fn_gl{SamplerParameter}, so no
+@fn_gl{ActiveTexture} or @fn_gl{BindTexture} calls are needed.
+
+@requires_gl33 Extension @extension{ARB,sampler_objects} for sampler objects.
+@requires_gles30 Sampler objects are not available in OpenGL ES 2.0.
+@requires_webgl20 Sampler objects are not available in WebGL 1.0.
+
 @see @ref Texture, @ref TextureArray, @ref CubeMapTexture,
     @ref CubeMapTextureArray, @ref RectangleTexture
 */
-class MAGNUM_EXPORT Sampler {
+class MAGNUM_EXPORT Sampler: public AbstractObject {
+    friend Implementation::TextureState;
+
     public:
         /**
          * @brief Texture filtering
@@ -253,8 +300,338 @@ class MAGNUM_EXPORT Sampler {
          * @see @fn_gl{Get} with @def_gl{MAX_TEXTURE_MAX_ANISOTROPY_EXT}
          */
         static Float maxMaxAnisotropy();
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Unbind any sampler from given texture unit
+         *
+         * Textures bound to given unit are then sampled using their own
+         * parameters again. If there is no sampler bound, the function does
+         * nothing.
+         * @see @ref bind(), @fn_gl{BindSampler}
+         * @requires_gl33 Extension @extension{ARB,sampler_objects}
+         * @requires_gles30 Sampler objects are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Sampler objects are not available in WebGL 1.0.
+         */
+        static void unbind(Int textureUnit);
+
+        /**
+         * @brief Unbind samplers from consecutive texture units
+         *
+         * Unbinds all samplers from texture units @f$ [ firstTextureUnit ; firstTextureUnit + count ) @f$.
+         * If @extension{ARB,multi_bind} (part of OpenGL 4.4) is not
+         * available, the feature is emulated with sequence of
+         * @ref unbind(Int) calls.
+         * @see @fn_gl{BindSamplers} or @fn_gl{BindSampler}
+         * @requires_gl33 Extension @extension{ARB,sampler_objects}
+         * @requires_gles30 Sampler objects are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Sampler objects are not available in WebGL 1.0.
+         */
+        static void unbind(Int firstTextureUnit, std::size_t count);
+
+        /**
+         * @brief Bind samplers to given range of texture units
+         *
+         * Binds first sampler in the list to @p firstTextureUnit, second to
+         * `firstTextureUnit + 1` etc. If any sampler is `nullptr`, given
+         * texture unit is unbound. Units that already have given sampler
+         * bound are skipped. If @extension{ARB,multi_bind} (part of OpenGL
+         * 4.4) is not available, the feature is emulated with sequence of
+         * @ref bind(Int) / @ref unbind(Int) calls.
+         * @see @fn_gl{BindSamplers} or @fn_gl{BindSampler}
+         * @requires_gl33 Extension @extension{ARB,sampler_objects}
+         * @requires_gles30 Sampler objects are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Sampler objects are not available in WebGL 1.0.
+         */
+        static void bind(Int firstTextureUnit, std::initializer_list<Sampler*> samplers);
+
+        /**
+         * @brief Wrap existing OpenGL sampler object
+         * @param id        OpenGL sampler ID
+         * @param flags     Object creation flags
+         *
+         * The @p id is expected to be of an existing OpenGL sampler object.
+         * Unlike sampler created using constructor, the OpenGL object is by
+         * default not deleted on destruction, use @p flags for different
+         * behavior.
+         * @see @ref release()
+         */
+        static Sampler wrap(GLuint id, ObjectFlags flags = {}) {
+            return Sampler{id, flags};
+        }
+
+        /**
+         * @brief Constructor
+         *
+         * Creates new OpenGL sampler object with default parameters.
+         * @see @ref Sampler(NoCreateT), @ref wrap(), @fn_gl{GenSamplers}
+         * @requires_gl33 Extension @extension{ARB,sampler_objects}
+         * @requires_gles30 Sampler objects are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Sampler objects are not available in WebGL 1.0.
+         */
+        explicit Sampler();
+
+        /**
+         * @brief Construct without creating the underlying OpenGL object
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         *
+         * This function can be safely used for constructing (and later
+         * destructing) objects even without any OpenGL context being active.
+         * @see @ref Sampler(), @ref wrap()
+         */
+        explicit Sampler(NoCreateT) noexcept: _id{0}, _flags{ObjectFlag::DeleteOnDestruction} {}
+
+        /** @brief Copying is not allowed */
+        Sampler(const Sampler&) = delete;
+
+        /** @brief Move constructor */
+        /* MinGW complains loudly if the declaration doesn't also have inline */
+        inline Sampler(Sampler&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Deletes associated OpenGL sampler object and removes it from all
+         * texture units it was bound to.
+         * @see @ref wrap(), @ref release(), @fn_gl{DeleteSamplers}
+         */
+        ~Sampler();
+
+        /** @brief Copying is not allowed */
+        Sampler& operator=(const Sampler&) = delete;
+
+        /** @brief Move assignment */
+        /* MinGW complains loudly if the declaration doesn't also have inline */
+        inline Sampler& operator=(Sampler&& other) noexcept;
+
+        /** @brief OpenGL sampler ID */
+        GLuint id() const { return _id; }
+
+        /**
+         * @brief Release OpenGL object
+         *
+         * Releases ownership of OpenGL sampler object and returns its ID so
+         * it is not deleted on destruction. The internal state is then
+         * equivalent to moved-from state.
+         * @see @ref wrap()
+         */
+        /* MinGW complains loudly if the declaration doesn't also have inline */
+        inline GLuint release();
+
+        #ifndef MAGNUM_TARGET_WEBGL
+        /**
+         * @brief Sampler label
+         *
+         * The result is *not* cached, repeated queries will result in
+         * repeated OpenGL calls. If OpenGL 4.3 / OpenGL ES 3.2 is not
+         * supported and neither @extension{KHR,debug} (covered also by
+         * @extension{ANDROID,extension_pack_es31a}) nor
+         * @extension2{EXT,debug_label} desktop or ES extension is available,
+         * this function returns empty string.
+         * @see @fn_gl{GetObjectLabel} with @def_gl{SAMPLER} or
+         *      @fn_gl_extension{GetObjectLabel,EXT,debug_label} with
+         *      @def_gl{SAMPLER}
+         * @requires_gles Debug output is not available in WebGL.
+         */
+        std::string label() const;
+
+        /**
+         * @brief Set sampler label
+         * @return Reference to self (for method chaining)
+         *
+         * Default is empty string. If OpenGL 4.3 / OpenGL ES 3.2 is not
+         * supported and neither @extension{KHR,debug} (covered also by
+         * @extension{ANDROID,extension_pack_es31a}) nor
+         * @extension2{EXT,debug_label} desktop or ES extension is available,
+         * this function does nothing.
+         * @see @ref maxLabelLength(), @fn_gl{ObjectLabel} with
+         *      @def_gl{SAMPLER} or @fn_gl_extension{LabelObject,EXT,debug_label}
+         *      with @def_gl{SAMPLER}
+         * @requires_gles Debug output is not available in WebGL.
+         */
+        Sampler& setLabel(const std::string& label) {
+            return setLabelInternal({label.data(), label.size()});
+        }
+
+        /** @overload */
+        template<std::size_t size> Sampler& setLabel(const char(&label)[size]) {
+            return setLabelInternal({label, size - 1});
+        }
+        #endif
+
+        /**
+         * @brief Bind sampler to given texture unit
+         *
+         * If the sampler is already bound to given unit, the function does
+         * nothing.
+         * @see @ref bind(Int, std::initializer_list<Sampler*>),
+         *      @ref unbind(), @fn_gl{BindSampler}
+         */
+        void bind(Int textureUnit);
+
+        /**
+         * @brief Set minification filter
+         * @return Reference to self (for method chaining)
+         *
+         * Equivalent to @ref Texture::setMinificationFilter() "*Texture::setMinificationFilter()",
+         * but applied to all textures sampled through this sampler. Initial
+         * value is (@ref Filter::Nearest, @ref Mipmap::Linear).
+         * @see @fn_gl{SamplerParameter} with @def_gl{TEXTURE_MIN_FILTER}
+         */
+        Sampler& setMinificationFilter(Filter filter, Mipmap mipmap = Mipmap::Base);
+
+        /**
+         * @brief Set magnification filter
+         * @return Reference to self (for method chaining)
+         *
+         * Initial value is @ref Filter::Linear.
+         * @see @ref Texture::setMagnificationFilter() "*Texture::setMagnificationFilter()",
+         *      @fn_gl{SamplerParameter} with @def_gl{TEXTURE_MAG_FILTER}
+         */
+        Sampler& setMagnificationFilter(Filter filter);
+
+        /**
+         * @brief Set minimum level-of-detail parameter
+         * @return Reference to self (for method chaining)
+         *
+         * Initial value is `-1000.0f`.
+         * @see @ref Texture::setMinLod() "*Texture::setMinLod()",
+         *      @fn_gl{SamplerParameter} with @def_gl{TEXTURE_MIN_LOD}
+         */
+        Sampler& setMinLod(Float lod);
+
+        /**
+         * @brief Set maximum level-of-detail parameter
+         * @return Reference to self (for method chaining)
+         *
+         * Initial value is `1000.0f`.
+         * @see @ref Texture::setMaxLod() "*Texture::setMaxLod()",
+         *      @fn_gl{SamplerParameter} with @def_gl{TEXTURE_MAX_LOD}
+         */
+        Sampler& setMaxLod(Float lod);
+
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Set level-of-detail bias
+         * @return Reference to self (for method chaining)
+         *
+         * Initial value is `0.0f`.
+         * @see @ref Texture::setLodBias() "*Texture::setLodBias()",
+         *      @fn_gl{SamplerParameter} with @def_gl{TEXTURE_LOD_BIAS}
+         * @requires_gl Texture LOD bias can be specified only directly in
+         *      fragment shader in OpenGL ES and WebGL.
+         */
+        Sampler& setLodBias(Float bias);
+        #endif
+
+        /**
+         * @brief Set wrapping
+         * @return Reference to self (for method chaining)
+         *
+         * Sets wrapping type for coordinates out of @f$ [ 0.0, 1.0 ] @f$
+         * range in all three dimensions, the third dimension is ignored by
+         * 1D and 2D textures. Initial value is @ref Wrapping::Repeat.
+         * @see @ref Texture::setWrapping() "*Texture::setWrapping()",
+         *      @fn_gl{SamplerParameter} with @def_gl{TEXTURE_WRAP_S},
+         *      @def_gl{TEXTURE_WRAP_T}, @def_gl{TEXTURE_WRAP_R}
+         */
+        Sampler& setWrapping(const Array3D<Wrapping>& wrapping);
+
+        #ifndef MAGNUM_TARGET_WEBGL
+        /**
+         * @brief Set border color
+         * @return Reference to self (for method chaining)
+         *
+         * Border color when wrapping is set to @ref Wrapping::ClampToBorder.
+         * Initial value is `0x00000000_rgbaf`.
+         * @see @ref Texture::setBorderColor() "*Texture::setBorderColor()",
+         *      @fn_gl{SamplerParameter} with @def_gl{TEXTURE_BORDER_COLOR}
+         * @requires_es_extension Extension @extension{ANDROID,extension_pack_es31a} /
+         *      @extension{EXT,texture_border_clamp} or
+         *      @extension{NV,texture_border_clamp}
+         * @requires_gles Border clamp is not available in WebGL.
+         */
+        Sampler& setBorderColor(const Color4& color);
+        #endif
+
+        /**
+         * @brief Set max anisotropy
+         * @return Reference to self (for method chaining)
+         *
+         * Default value is `1.0f`, which means no anisotropy. Set to value
+         * greater than `1.0f` for anisotropic filtering. If extension
+         * @extension{EXT,texture_filter_anisotropic} (desktop or ES) is not
+         * available, this function does nothing.
+         * @see @ref maxMaxAnisotropy(), @fn_gl{SamplerParameter} with
+         *      @def_gl{TEXTURE_MAX_ANISOTROPY_EXT}
+         */
+        Sampler& setMaxAnisotropy(Float anisotropy);
+
+        /**
+         * @brief Set depth texture comparison mode
+         * @return Reference to self (for method chaining)
+         *
+         * Initial value is @ref CompareMode::None.
+         * @see @ref Texture::setCompareMode() "*Texture::setCompareMode()",
+         *      @fn_gl{SamplerParameter} with @def_gl{TEXTURE_COMPARE_MODE}
+         */
+        Sampler& setCompareMode(CompareMode mode);
+
+        /**
+         * @brief Set depth texture comparison function
+         * @return Reference to self (for method chaining)
+         *
+         * Comparison operator used when comparison mode is set to
+         * @ref CompareMode::CompareRefToTexture. Initial value is
+         * @ref CompareFunction::LessOrEqual.
+         * @see @ref Texture::setCompareFunction() "*Texture::setCompareFunction()",
+         *      @fn_gl{SamplerParameter} with @def_gl{TEXTURE_COMPARE_FUNC}
+         */
+        Sampler& setCompareFunction(CompareFunction function);
+
+    private:
+        explicit Sampler(GLuint id, ObjectFlags flags) noexcept: _id{id}, _flags{flags} {}
+
+        static void MAGNUM_LOCAL bindImplementationFallback(GLint firstTextureUnit, Containers::ArrayView<Sampler* const> samplers);
+        #ifndef MAGNUM_TARGET_GLES
+        static void MAGNUM_LOCAL bindImplementationMulti(GLint firstTextureUnit, Containers::ArrayView<Sampler* const> samplers);
+        #endif
+
+        #ifndef MAGNUM_TARGET_WEBGL
+        Sampler& setLabelInternal(Containers::ArrayView<const char> label);
+        #endif
+
+        GLuint _id;
+        ObjectFlags _flags;
+        #endif
 };
 
+#ifndef MAGNUM_TARGET_GLES2
+inline Sampler::Sampler(Sampler&& other) noexcept: _id{other._id}, _flags{other._flags} {
+    other._id = 0;
+}
+
+inline Sampler& Sampler::operator=(Sampler&& other) noexcept {
+    using std::swap;
+    swap(_id, other._id);
+    swap(_flags, other._flags);
+    return *this;
+}
+
+inline GLuint Sampler::release() {
+    const GLuint id = _id;
+    _id = 0;
+    return id;
+}
+#endif
+
 /** @debugoperatorclassenum{Magnum::Sampler,Magnum::Sampler::Filter} */
 MAGNUM_EXPORT Debug& operator<<(Debug& debug, Sampler::Filter value);
 
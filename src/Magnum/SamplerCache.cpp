@@ -0,0 +1,98 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SamplerCache.h"
+
+namespace Magnum {
+
+namespace {
+    template<class T> inline void hashCombine(std::size_t& seed, const T& value) {
+        seed ^= std::hash<T>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+}
+
+std::size_t SamplerParameters::hash() const {
+    std::size_t seed = 0;
+    hashCombine(seed, GLint(_minificationFilter));
+    hashCombine(seed, GLint(_minificationMipmap));
+    hashCombine(seed, GLint(_magnificationFilter));
+    hashCombine(seed, _minLod);
+    hashCombine(seed, _maxLod);
+    #ifndef MAGNUM_TARGET_GLES
+    hashCombine(seed, _lodBias);
+    #endif
+    for(std::size_t i = 0; i != 3; ++i)
+        hashCombine(seed, GLint(_wrapping[i]));
+    #ifndef MAGNUM_TARGET_WEBGL
+    for(std::size_t i = 0; i != 4; ++i)
+        hashCombine(seed, _borderColor[i]);
+    #endif
+    hashCombine(seed, _maxAnisotropy);
+    hashCombine(seed, GLenum(_compareMode));
+    hashCombine(seed, GLenum(_compareFunction));
+    return seed;
+}
+
+void SamplerParameters::applyTo(Sampler& sampler) const {
+    sampler.setMinificationFilter(_minificationFilter, _minificationMipmap)
+        .setMagnificationFilter(_magnificationFilter)
+        .setMinLod(_minLod)
+        .setMaxLod(_maxLod)
+        #ifndef MAGNUM_TARGET_GLES
+        .setLodBias(_lodBias)
+        #endif
+        .setWrapping(_wrapping)
+        #ifndef MAGNUM_TARGET_WEBGL
+        .setBorderColor(_borderColor)
+        #endif
+        .setMaxAnisotropy(_maxAnisotropy)
+        .setCompareMode(_compareMode)
+        .setCompareFunction(_compareFunction);
+}
+
+SamplerCache::SamplerCache() = default;
+
+SamplerCache::SamplerCache(SamplerCache&&) noexcept = default;
+
+SamplerCache::~SamplerCache() = default;
+
+SamplerCache& SamplerCache::operator=(SamplerCache&&) noexcept = default;
+
+Sampler& SamplerCache::get(const SamplerParameters& parameters) {
+    /* Already cached, return the existing sampler */
+    const auto found = _samplers.find(parameters);
+    if(found != _samplers.end()) return found->second;
+
+    /* Otherwise create a new sampler, set all parameters at once */
+    Sampler& sampler = _samplers.emplace(parameters, Sampler{}).first->second;
+    parameters.applyTo(sampler);
+    return sampler;
+}
+
+void SamplerCache::clear() {
+    _samplers.clear();
+}
+
+}
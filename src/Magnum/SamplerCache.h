@@ -0,0 +1,356 @@
+#ifndef Magnum_SamplerCache_h
+#define Magnum_SamplerCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MAGNUM_TARGET_GLES2
+/** @file
+ * @brief Class @ref Magnum::SamplerParameters, @ref Magnum::SamplerCache
+ */
+#endif
+
+#include <unordered_map>
+
+#include "Magnum/Sampler.h"
+#include "Magnum/Math/Color.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+namespace Magnum {
+
+/**
+@brief Sampler parameters
+
+Complete set of sampling state, used as a key in @ref SamplerCache. Default
+values match initial state of a newly created @ref Sampler.
+@requires_gl33 Extension @extension{ARB,sampler_objects}
+@requires_gles30 Sampler objects are not available in OpenGL ES 2.0.
+@requires_webgl20 Sampler objects are not available in WebGL 1.0.
+*/
+class SamplerParameters {
+    public:
+        /** @brief Minification filter */
+        Sampler::Filter minificationFilter() const { return _minificationFilter; }
+
+        /** @brief Minification mipmap selection */
+        Sampler::Mipmap minificationMipmap() const { return _minificationMipmap; }
+
+        /**
+         * @brief Set minification filter
+         * @return Reference to self (for method chaining)
+         *
+         * Default is (@ref Sampler::Filter::Nearest, @ref Sampler::Mipmap::Linear).
+         * @see @ref Sampler::setMinificationFilter()
+         */
+        SamplerParameters& setMinificationFilter(Sampler::Filter filter, Sampler::Mipmap mipmap = Sampler::Mipmap::Base) {
+            _minificationFilter = filter;
+            _minificationMipmap = mipmap;
+            return *this;
+        }
+
+        /** @brief Magnification filter */
+        Sampler::Filter magnificationFilter() const { return _magnificationFilter; }
+
+        /**
+         * @brief Set magnification filter
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @ref Sampler::Filter::Linear.
+         * @see @ref Sampler::setMagnificationFilter()
+         */
+        SamplerParameters& setMagnificationFilter(Sampler::Filter filter) {
+            _magnificationFilter = filter;
+            return *this;
+        }
+
+        /** @brief Minimum level-of-detail */
+        Float minLod() const { return _minLod; }
+
+        /**
+         * @brief Set minimum level-of-detail
+         * @return Reference to self (for method chaining)
+         *
+         * Default is `-1000.0f`.
+         * @see @ref Sampler::setMinLod()
+         */
+        SamplerParameters& setMinLod(Float lod) {
+            _minLod = lod;
+            return *this;
+        }
+
+        /** @brief Maximum level-of-detail */
+        Float maxLod() const { return _maxLod; }
+
+        /**
+         * @brief Set maximum level-of-detail
+         * @return Reference to self (for method chaining)
+         *
+         * Default is `1000.0f`.
+         * @see @ref Sampler::setMaxLod()
+         */
+        SamplerParameters& setMaxLod(Float lod) {
+            _maxLod = lod;
+            return *this;
+        }
+
+        #ifndef MAGNUM_TARGET_GLES
+        /** @brief Level-of-detail bias */
+        Float lodBias() const { return _lodBias; }
+
+        /**
+         * @brief Set level-of-detail bias
+         * @return Reference to self (for method chaining)
+         *
+         * Default is `0.0f`.
+         * @see @ref Sampler::setLodBias()
+         * @requires_gl Texture LOD bias can be specified only directly in
+         *      fragment shader in OpenGL ES and WebGL.
+         */
+        SamplerParameters& setLodBias(Float bias) {
+            _lodBias = bias;
+            return *this;
+        }
+        #endif
+
+        /** @brief Wrapping */
+        Array3D<Sampler::Wrapping> wrapping() const { return _wrapping; }
+
+        /**
+         * @brief Set wrapping
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @ref Sampler::Wrapping::Repeat in all dimensions.
+         * @see @ref Sampler::setWrapping()
+         */
+        SamplerParameters& setWrapping(const Array3D<Sampler::Wrapping>& wrapping) {
+            _wrapping = wrapping;
+            return *this;
+        }
+
+        #ifndef MAGNUM_TARGET_WEBGL
+        /** @brief Border color */
+        Color4 borderColor() const { return _borderColor; }
+
+        /**
+         * @brief Set border color
+         * @return Reference to self (for method chaining)
+         *
+         * Default is `0x00000000_rgbaf`.
+         * @see @ref Sampler::setBorderColor()
+         * @requires_gles Border clamp is not available in WebGL.
+         */
+        SamplerParameters& setBorderColor(const Color4& color) {
+            _borderColor = color;
+            return *this;
+        }
+        #endif
+
+        /** @brief Max anisotropy */
+        Float maxAnisotropy() const { return _maxAnisotropy; }
+
+        /**
+         * @brief Set max anisotropy
+         * @return Reference to self (for method chaining)
+         *
+         * Default is `1.0f`.
+         * @see @ref Sampler::setMaxAnisotropy()
+         */
+        SamplerParameters& setMaxAnisotropy(Float anisotropy) {
+            _maxAnisotropy = anisotropy;
+            return *this;
+        }
+
+        /** @brief Depth texture comparison mode */
+        Sampler::CompareMode compareMode() const { return _compareMode; }
+
+        /**
+         * @brief Set depth texture comparison mode
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @ref Sampler::CompareMode::None.
+         * @see @ref Sampler::setCompareMode()
+         */
+        SamplerParameters& setCompareMode(Sampler::CompareMode mode) {
+            _compareMode = mode;
+            return *this;
+        }
+
+        /** @brief Depth texture comparison function */
+        Sampler::CompareFunction compareFunction() const { return _compareFunction; }
+
+        /**
+         * @brief Set depth texture comparison function
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @ref Sampler::CompareFunction::LessOrEqual.
+         * @see @ref Sampler::setCompareFunction()
+         */
+        SamplerParameters& setCompareFunction(Sampler::CompareFunction function) {
+            _compareFunction = function;
+            return *this;
+        }
+
+        /** @brief Equality comparison */
+        bool operator==(const SamplerParameters& other) const {
+            return _minificationFilter == other._minificationFilter &&
+                _minificationMipmap == other._minificationMipmap &&
+                _magnificationFilter == other._magnificationFilter &&
+                _minLod == other._minLod && _maxLod == other._maxLod &&
+                #ifndef MAGNUM_TARGET_GLES
+                _lodBias == other._lodBias &&
+                #endif
+                _wrapping == other._wrapping &&
+                #ifndef MAGNUM_TARGET_WEBGL
+                _borderColor == other._borderColor &&
+                #endif
+                _maxAnisotropy == other._maxAnisotropy &&
+                _compareMode == other._compareMode &&
+                _compareFunction == other._compareFunction;
+        }
+
+        /** @brief Non-equality comparison */
+        bool operator!=(const SamplerParameters& other) const {
+            return !operator==(other);
+        }
+
+        /**
+         * @brief Hash of the parameters
+         *
+         * Equal parameters have equal hash.
+         */
+        MAGNUM_EXPORT std::size_t hash() const;
+
+        /**
+         * @brief Apply the parameters to a sampler
+         *
+         * Calls all setters of @p sampler with values stored in this
+         * instance.
+         */
+        MAGNUM_EXPORT void applyTo(Sampler& sampler) const;
+
+    private:
+        Sampler::Filter _minificationFilter{Sampler::Filter::Nearest};
+        Sampler::Mipmap _minificationMipmap{Sampler::Mipmap::Linear};
+        Sampler::Filter _magnificationFilter{Sampler::Filter::Linear};
+        Float _minLod{-1000.0f}, _maxLod{1000.0f};
+        #ifndef MAGNUM_TARGET_GLES
+        Float _lodBias{0.0f};
+        #endif
+        Array3D<Sampler::Wrapping> _wrapping{Sampler::Wrapping::Repeat};
+        #ifndef MAGNUM_TARGET_WEBGL
+        Color4 _borderColor{0.0f, 0.0f};
+        #endif
+        Float _maxAnisotropy{1.0f};
+        Sampler::CompareMode _compareMode{Sampler::CompareMode::None};
+        Sampler::CompareFunction _compareFunction{Sampler::CompareFunction::LessOrEqual};
+};
+
+/**
+@brief Sampler cache
+
+Keeps one @ref Sampler for each distinct set of @ref SamplerParameters, so
+materials that share sampling state share also the sampler object and
+textures can be shared between materials with different sampling without
+being duplicated or having their parameters re-set every draw:
+
+@code
+SamplerCache cache;
+
+Sampler& linear = cache.get(SamplerParameters{}
+    .setMinificationFilter(Sampler::Filter::Linear, Sampler::Mipmap::Linear)
+    .setMagnificationFilter(Sampler::Filter::Linear));
+Sampler& nearest = cache.get(SamplerParameters{}
+    .setMinificationFilter(Sampler::Filter::Nearest)
+    .setMagnificationFilter(Sampler::Filter::Nearest)
+    .setWrapping(Sampler::Wrapping::ClampToEdge));
+
+// Both units sample the same texture, each in a different way
+AbstractTexture::bind(0, {&texture, &texture});
+Sampler::bind(0, {&linear, &nearest});
+@endcode
+
+Returned references stay valid until the cache is cleared or destroyed.
+@requires_gl33 Extension @extension{ARB,sampler_objects}
+@requires_gles30 Sampler objects are not available in OpenGL ES 2.0.
+@requires_webgl20 Sampler objects are not available in WebGL 1.0.
+*/
+class MAGNUM_EXPORT SamplerCache {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Creates an empty cache, no OpenGL objects are created.
+         */
+        explicit SamplerCache();
+
+        /** @brief Copying is not allowed */
+        SamplerCache(const SamplerCache&) = delete;
+
+        /** @brief Move constructor */
+        SamplerCache(SamplerCache&&) noexcept;
+
+        ~SamplerCache();
+
+        /** @brief Copying is not allowed */
+        SamplerCache& operator=(const SamplerCache&) = delete;
+
+        /** @brief Move assignment */
+        SamplerCache& operator=(SamplerCache&&) noexcept;
+
+        /** @brief Count of samplers in the cache */
+        std::size_t size() const { return _samplers.size(); }
+
+        /**
+         * @brief Get sampler with given parameters
+         *
+         * If a sampler with the same parameters is already in the cache,
+         * returns it, otherwise creates a new one and applies the parameters
+         * to it using @ref SamplerParameters::applyTo().
+         */
+        Sampler& get(const SamplerParameters& parameters);
+
+        /**
+         * @brief Clear the cache
+         *
+         * Deletes all samplers. References returned by @ref get() are
+         * invalidated.
+         */
+        void clear();
+
+    private:
+        struct Hash {
+            std::size_t operator()(const SamplerParameters& parameters) const {
+                return parameters.hash();
+            }
+        };
+
+        std::unordered_map<SamplerParameters, Sampler, Hash> _samplers;
+};
+
+}
+#else
+#error this header is not available in OpenGL ES 2.0 build
+#endif
+
+#endif
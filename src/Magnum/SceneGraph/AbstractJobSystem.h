@@ -0,0 +1,105 @@
+#ifndef Magnum_SceneGraph_AbstractJobSystem_h
+#define Magnum_SceneGraph_AbstractJobSystem_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::AbstractJobSystem
+ */
+
+#include <cstddef>
+#include <functional>
+
+#include "Magnum/SceneGraph/SceneGraph.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Base for job systems
+
+Used by @ref Object::transformations(), @ref Object::setClean() and
+@ref Camera::draw() overloads to split the absolute transformation computation
+of large object groups into independent jobs. Implement this interface to
+schedule the jobs on your own job system, or use @ref ThreadPool.
+
+## Subclassing
+
+The subclass needs to implement @ref doWorkerCount() and @ref doRun(). The
+jobs can be executed in any order and on any thread, including the calling
+one, but @ref doRun() must not return until all of them are finished.
+*/
+class AbstractJobSystem {
+    public:
+        explicit AbstractJobSystem() = default;
+
+        /** @brief Copying is not allowed */
+        AbstractJobSystem(const AbstractJobSystem&) = delete;
+
+        /** @brief Moving is not allowed */
+        AbstractJobSystem(AbstractJobSystem&&) = delete;
+
+        virtual ~AbstractJobSystem() = default;
+
+        /** @brief Copying is not allowed */
+        AbstractJobSystem& operator=(const AbstractJobSystem&) = delete;
+
+        /** @brief Moving is not allowed */
+        AbstractJobSystem& operator=(AbstractJobSystem&&) = delete;
+
+        /**
+         * @brief Count of workers that execute the jobs in parallel
+         *
+         * Used as a hint for how many jobs to split the work into.
+         */
+        std::size_t workerCount() const { return doWorkerCount(); }
+
+        /**
+         * @brief Run jobs
+         * @param jobCount  Count of jobs
+         * @param job       Job function, called with job index in range
+         *      @f$ [ 0, jobCount ) @f$
+         *
+         * Blocks until all jobs are finished. The jobs are independent of each
+         * other and can be executed in parallel.
+         */
+        void run(std::size_t jobCount, const std::function<void(std::size_t)>& job) {
+            if(jobCount) doRun(jobCount, job);
+        }
+
+    private:
+        /** @brief Implementation for @ref workerCount() */
+        virtual std::size_t doWorkerCount() const = 0;
+
+        /**
+         * @brief Implementation for @ref run()
+         *
+         * Called only if @p jobCount is not zero.
+         */
+        virtual void doRun(std::size_t jobCount, const std::function<void(std::size_t)>& job) = 0;
+};
+
+}}
+
+#endif
@@ -31,9 +31,11 @@
 
 #include <functional>
 #include <vector>
+#include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/LinkedList.h>
 
 #include "Magnum/DimensionTraits.h"
+#include "Magnum/FrameArena.h"
 #include "Magnum/SceneGraph/SceneGraph.h"
 #include "Magnum/SceneGraph/visibility.h"
 
@@ -210,6 +212,35 @@ template<UnsignedInt dimensions, class T> class AbstractObject
             return doTransformationMatrices(objects, initialTransformationMatrix);
         }
 
+        /**
+         * @brief Transformation matrices of given set of objects relative to this object using given job system
+         *
+         * Same as @ref transformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>&, const MatrixType&) const,
+         * but the computation is split into jobs executed by @p jobSystem.
+         * See @ref Object::transformations() for more information.
+         * @warning This function cannot check if all objects are of the same
+         *      @ref Object type, use typesafe @ref Object::transformationMatrices()
+         *      when possible.
+         */
+        std::vector<MatrixType> transformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects, AbstractJobSystem& jobSystem, const MatrixType& initialTransformationMatrix = MatrixType()) const {
+            return doTransformationMatrices(objects, jobSystem, initialTransformationMatrix);
+        }
+
+        /**
+         * @brief Transformation matrices of given set of objects relative to this object using given frame arena
+         *
+         * Same as @ref transformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>&, const MatrixType&) const,
+         * but all temporary and returned data are allocated from @p arena,
+         * so the function doesn't allocate from the heap. See
+         * @ref FrameArena for more information.
+         * @warning This function cannot check if all objects are of the same
+         *      @ref Object type, use typesafe @ref Object::transformationMatrices()
+         *      when possible.
+         */
+        FrameArenaVector<MatrixType> transformationMatrices(Containers::ArrayView<const std::reference_wrapper<AbstractObject<dimensions, T>>> objects, FrameArena& arena, const MatrixType& initialTransformationMatrix = MatrixType()) const {
+            return doTransformationMatrices(objects, arena, initialTransformationMatrix);
+        }
+
         /*@}*/
 
         /**
@@ -231,6 +262,35 @@ template<UnsignedInt dimensions, class T> class AbstractObject
             objects.front().get().doSetClean(objects);
         }
 
+        /**
+         * @brief Clean absolute transformations of given set of objects using given job system
+         *
+         * Same as @ref setClean(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>&),
+         * but the absolute transformations are computed in jobs executed by
+         * @p jobSystem. The features are cleaned on the calling thread.
+         * @warning This function cannot check if all objects are of the same
+         *      @ref Object type, use typesafe @ref Object::setClean() when
+         *      possible.
+         */
+        static void setClean(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects, AbstractJobSystem& jobSystem) {
+            if(objects.empty()) return;
+            objects.front().get().doSetClean(objects, jobSystem);
+        }
+
+        /**
+         * @brief Clean absolute transformations of given set of objects using given frame arena
+         *
+         * Same as @ref setClean(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>&),
+         * but all temporary data are allocated from @p arena.
+         * @warning This function cannot check if all objects are of the same
+         *      @ref Object type, use typesafe @ref Object::setClean() when
+         *      possible.
+         */
+        static void setClean(Containers::ArrayView<const std::reference_wrapper<AbstractObject<dimensions, T>>> objects, FrameArena& arena) {
+            if(objects.empty()) return;
+            objects.front().get().doSetClean(objects, arena);
+        }
+
         /**
          * @brief Whether absolute transformation is dirty
          *
@@ -281,11 +341,15 @@ template<UnsignedInt dimensions, class T> class AbstractObject
         virtual MatrixType doTransformationMatrix() const = 0;
         virtual MatrixType doAbsoluteTransformationMatrix() const = 0;
         virtual std::vector<MatrixType> doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects, const MatrixType& initialTransformationMatrix) const = 0;
+        virtual std::vector<MatrixType> doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects, AbstractJobSystem& jobSystem, const MatrixType& initialTransformationMatrix) const = 0;
+        virtual FrameArenaVector<MatrixType> doTransformationMatrices(Containers::ArrayView<const std::reference_wrapper<AbstractObject<dimensions, T>>> objects, FrameArena& arena, const MatrixType& initialTransformationMatrix) const = 0;
 
         virtual bool doIsDirty() const = 0;
         virtual void doSetDirty() = 0;
         virtual void doSetClean() = 0;
         virtual void doSetClean(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects) = 0;
+        virtual void doSetClean(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects, AbstractJobSystem& jobSystem) = 0;
+        virtual void doSetClean(Containers::ArrayView<const std::reference_wrapper<AbstractObject<dimensions, T>>> objects, FrameArena& arena) = 0;
 };
 
 /**
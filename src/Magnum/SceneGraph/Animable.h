@@ -123,13 +123,37 @@ void MyApplication::drawEvent() {
 }
 @endcode
 
-## Using multiple animable groups to improve performance
+## Performance
+
+@ref AnimableGroup keeps running animations in a separate compact list and
+remembers which animations changed their state since the last step, so
+@ref AnimableGroup::step() touches only the running and recently changed
+animations. Stopped and paused animations cost nothing, no matter how many of
+them are in the group. Use @ref AnimableGroup::runningCount() and
+@ref AnimableGroup::stepCount() together with @ref AnimableGroup::size() to
+see how many of the animations are actually active.
+
+## Stepping in parallel
+
+If @ref animationStep() of your animable doesn't touch any state shared with
+other animables, mark it with @ref setThreadSafe() and step the group with
+@ref AnimableGroup::step(Float, Float, AbstractJobSystem&). The thread-safe
+animations are then stepped in parallel on the job system, while the state
+change callbacks and steps of other animations are still executed serially
+on the calling thread:
+@code
+SceneGraph::ThreadPool pool;
+
+(new AnimableObject(&scene, &animables))
+    ->setThreadSafe(true)
+    .setState(SceneGraph::AnimationState::Running);
+
+void MyApplication::drawEvent() {
+    animables.step(timeline.lastFrameTime(), timeline.lastFrameDuration(), pool);
 
-@ref AnimableGroup is optimized for case when no animation is running -- it
-just puts itself to rest and waits until some animation changes its state to
-@ref AnimationState::Running again. If you put animations which are not
-pernamently running into separate group, they will not be traversed every time
-the @ref AnimableGroup::step() gets called, saving precious frame time.
+    // ...
+}
+@endcode
 
 ## Explicit template specializations
 
@@ -220,6 +244,28 @@ template<UnsignedInt dimensions, class T> class Animable: public AbstractGrouped
             return *this;
         }
 
+        /**
+         * @brief Whether the animation step is thread-safe
+         *
+         * @see @ref setThreadSafe()
+         */
+        bool isThreadSafe() const { return _threadSafe; }
+
+        /**
+         * @brief Mark the animation step as thread-safe
+         * @return Reference to self (for method chaining)
+         *
+         * If set, @ref animationStep() can be called from a worker thread in
+         * parallel with steps of other animables when the group is stepped
+         * using @ref AnimableGroup::step(Float, Float, AbstractJobSystem&).
+         * The state change callbacks are always called from the thread
+         * calling @ref AnimableGroup::step(). Default is `false`.
+         */
+        Animable<dimensions, T>& setThreadSafe(bool threadSafe) {
+            _threadSafe = threadSafe;
+            return *this;
+        }
+
         /**
          * @brief Group containing this animable
          *
@@ -248,7 +294,9 @@ template<UnsignedInt dimensions, class T> class Animable: public AbstractGrouped
          * @param delta     Time delta for current frame
          *
          * This function is periodically called from @ref AnimableGroup::step()
-         * if the animation state is set to @ref AnimationState::Running. After
+         * if the animation state is set to @ref AnimationState::Running. If
+         * the animable is marked as thread-safe, it may be called from a
+         * worker thread, see @ref setThreadSafe() for more information. After
          * animation duration is exceeded and repeat is not enabled or repeat
          * count is exceeded, the animation state is set to @ref AnimationState::Stopped.
          *
@@ -321,6 +369,8 @@ template<UnsignedInt dimensions, class T> class Animable: public AbstractGrouped
         bool _repeated;
         UnsignedShort _repeatCount;
         UnsignedShort repeats;
+        bool _threadSafe, _pending;
+        std::size_t _activeIndex;
 };
 
 /**
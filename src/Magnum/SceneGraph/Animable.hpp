@@ -29,16 +29,25 @@
  * @brief @ref compilation-speedup-hpp "Template implementation" for @ref Animable.h and @ref AnimableGroup.h
  */
 
+#include <algorithm>
+
 #include "Magnum/Timeline.h"
 #include "Magnum/Math/Constants.h"
+#include "Magnum/SceneGraph/AbstractJobSystem.h"
 #include "Magnum/SceneGraph/AnimableGroup.h"
 #include "Magnum/SceneGraph/Animable.h"
+#include "Magnum/SceneGraph/FeatureGroup.hpp"
 
 namespace Magnum { namespace SceneGraph {
 
-template<UnsignedInt dimensions, class T> Animable<dimensions, T>::Animable(AbstractObject<dimensions, T>& object, AnimableGroup<dimensions, T>* group): AbstractGroupedFeature<dimensions, Animable<dimensions, T>, T>(object, group), _duration(0.0f), startTime(Constants::inf()), pauseTime(-Constants::inf()), previousState(AnimationState::Stopped), currentState(AnimationState::Stopped), _repeated(false), _repeatCount(0), repeats(0) {}
+template<UnsignedInt dimensions, class T> Animable<dimensions, T>::Animable(AbstractObject<dimensions, T>& object, AnimableGroup<dimensions, T>* group): AbstractGroupedFeature<dimensions, Animable<dimensions, T>, T>(object, group), _duration(0.0f), startTime(Constants::inf()), pauseTime(-Constants::inf()), previousState(AnimationState::Stopped), currentState(AnimationState::Stopped), _repeated(false), _repeatCount(0), repeats(0), _threadSafe(false), _pending(false), _activeIndex(~std::size_t{}) {}
 
-template<UnsignedInt dimensions, class T> Animable<dimensions, T>::~Animable() {}
+template<UnsignedInt dimensions, class T> Animable<dimensions, T>::~Animable() {
+    /* The grouped feature destructor removes the animable from the feature
+       list, but the group also references it from its internal lists */
+    if(AnimableGroup<dimensions, T>* group = animables())
+        group->removeFromLists(*this);
+}
 
 template<UnsignedInt dimensions, class T> Animable<dimensions, T>& Animable<dimensions, T>::setState(AnimationState state) {
     if(currentState == state) return *this;
@@ -47,9 +56,14 @@ template<UnsignedInt dimensions, class T> Animable<dimensions, T>& Animable<dime
     if(previousState == AnimationState::Stopped && state == AnimationState::Paused)
         return *this;
 
-    /* Wake up the group in case no animations are running */
-    animables()->wakeUp = true;
+    /* Let the group process the change in next step */
+    AnimableGroup<dimensions, T>* group = animables();
+    if(group && !_pending) {
+        group->_pending.push_back(this);
+        _pending = true;
+    }
     currentState = state;
+    if(group && group->_activityCallback) group->_activityCallback();
     return *this;
 }
 
@@ -61,61 +75,156 @@ template<UnsignedInt dimensions, class T> const AnimableGroup<dimensions, T>* An
     return static_cast<const AnimableGroup<dimensions, T>*>(AbstractGroupedFeature<dimensions, Animable<dimensions, T>, T>::group());
 }
 
+template<UnsignedInt dimensions, class T> AnimableGroup<dimensions, T>::~AnimableGroup() {
+    /* The animables survive the group, reset their references to it */
+    for(Animable<dimensions, T>* animable: _active)
+        animable->_activeIndex = ~std::size_t{};
+    for(Animable<dimensions, T>* animable: _pending)
+        if(animable) animable->_pending = false;
+}
+
+template<UnsignedInt dimensions, class T> AnimableGroup<dimensions, T>& AnimableGroup<dimensions, T>::add(Animable<dimensions, T>& animable) {
+    if(AnimableGroup<dimensions, T>* previous = animable.animables())
+        previous->removeFromLists(animable);
+
+    FeatureGroup<dimensions, Animable<dimensions, T>, T>::add(animable);
+
+    /* Running animation continues in this group, unprocessed state change
+       will be processed by this group */
+    if(animable.previousState == AnimationState::Running)
+        addActive(animable);
+    if(animable.previousState != animable.currentState) {
+        _pending.push_back(&animable);
+        animable._pending = true;
+    }
+    if(_activityCallback && (animable._activeIndex != ~std::size_t{} || animable._pending))
+        _activityCallback();
+
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> AnimableGroup<dimensions, T>& AnimableGroup<dimensions, T>::remove(Animable<dimensions, T>& animable) {
+    CORRADE_ASSERT(animable.animables() == this,
+        "SceneGraph::AnimableGroup::remove(): animable is not part of this group", *this);
+
+    removeFromLists(animable);
+    FeatureGroup<dimensions, Animable<dimensions, T>, T>::remove(animable);
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::addActive(Animable<dimensions, T>& animable) {
+    CORRADE_INTERNAL_ASSERT(animable._activeIndex == ~std::size_t{});
+    animable._activeIndex = _active.size();
+    _active.push_back(&animable);
+}
+
+template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::removeActive(Animable<dimensions, T>& animable) {
+    CORRADE_INTERNAL_ASSERT(animable._activeIndex < _active.size() && _active[animable._activeIndex] == &animable);
+
+    /* Move the last one in place of the removed one to keep the list
+       compact */
+    Animable<dimensions, T>* const last = _active.back();
+    _active[animable._activeIndex] = last;
+    last->_activeIndex = animable._activeIndex;
+    _active.pop_back();
+    animable._activeIndex = ~std::size_t{};
+}
+
+template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::removeFromLists(Animable<dimensions, T>& animable) {
+    if(animable._activeIndex != ~std::size_t{}) removeActive(animable);
+
+    /* The animable might be removed while the changes are processed, so
+       just clear the entries instead of erasing them */
+    if(animable._pending) {
+        for(Animable<dimensions, T>*& pending: _pending)
+            if(pending == &animable) pending = nullptr;
+        animable._pending = false;
+    }
+    for(Animable<dimensions, T>*& processing: _processing)
+        if(processing == &animable) processing = nullptr;
+}
+
 template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::step(const Float time, const Float delta) {
-    if(!_runningCount && !wakeUp) return;
-    wakeUp = false;
-
-    for(std::size_t i = 0; i != AnimableGroup<dimensions, T>::size(); ++i) {
-        Animable<dimensions, T>& animable = (*this)[i];
-
-        /* The animation was stopped recently, just decrease count of running
-           animations if the animation was running before */
-        if(animable.previousState != AnimationState::Stopped && animable.currentState == AnimationState::Stopped) {
-            if(animable.previousState == AnimationState::Running)
-                --_runningCount;
-            animable.previousState = AnimationState::Stopped;
-            animable.animationStopped();
-            continue;
+    stepInternal(time, delta, nullptr);
+}
 
-        /* The animation was paused recently, set pause time to previous frame time */
-        } else if(animable.previousState == AnimationState::Running && animable.currentState == AnimationState::Paused) {
-            animable.previousState = AnimationState::Paused;
-            animable.pauseTime = time;
-            --_runningCount;
-            animable.animationPaused();
-            continue;
+template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::step(const Float time, const Float delta, AbstractJobSystem& jobSystem) {
+    stepInternal(time, delta, &jobSystem);
+}
 
-        /* Skip the rest for not running animations */
-        } else if(animable.currentState != AnimationState::Running) {
-            CORRADE_INTERNAL_ASSERT(animable.previousState == animable.currentState);
-            continue;
+template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::stepInternal(const Float time, const Float delta, AbstractJobSystem* const jobSystem) {
+    _stepCount = 0;
+    if(_active.empty() && _pending.empty()) return;
+
+    CORRADE_ASSERT(delta >= 0.0f,
+        "SceneGraph::AnimableGroup::step(): negative delta passed", );
+
+    /* Process state changes since last step. Changes done from the callbacks
+       are processed in next step. */
+    std::swap(_pending, _processing);
+    for(std::size_t i = 0; i != _processing.size(); ++i) {
+        Animable<dimensions, T>* const animable = _processing[i];
+
+        /* Removed from the group in the meantime */
+        if(!animable) continue;
+        animable->_pending = false;
+
+        /* The animation was stopped recently, remove it from running
+           animations if it was running before */
+        if(animable->previousState != AnimationState::Stopped && animable->currentState == AnimationState::Stopped) {
+            if(animable->previousState == AnimationState::Running)
+                removeActive(*animable);
+            animable->previousState = AnimationState::Stopped;
+            animable->animationStopped();
+
+        /* The animation was paused recently, set pause time to previous frame time */
+        } else if(animable->previousState == AnimationState::Running && animable->currentState == AnimationState::Paused) {
+            animable->previousState = AnimationState::Paused;
+            animable->pauseTime = time;
+            removeActive(*animable);
+            animable->animationPaused();
 
         /* The animation was started recently, set start time to previous frame
            time, reset repeat count */
-        } else if(animable.previousState == AnimationState::Stopped) {
-            animable.previousState = AnimationState::Running;
-            animable.startTime = time;
-            animable.repeats = 0;
-            ++_runningCount;
-            animable.animationStarted();
+        } else if(animable->previousState == AnimationState::Stopped && animable->currentState == AnimationState::Running) {
+            animable->previousState = AnimationState::Running;
+            animable->startTime = time;
+            animable->repeats = 0;
+            addActive(*animable);
+            animable->animationStarted();
 
         /* The animation was resumed recently, add pause duration to start time */
-        } else if(animable.previousState == AnimationState::Paused) {
-            animable.previousState = AnimationState::Running;
-            animable.startTime += time - animable.pauseTime;
-            ++_runningCount;
-            animable.animationResumed();
+        } else if(animable->previousState == AnimationState::Paused && animable->currentState == AnimationState::Running) {
+            animable->previousState = AnimationState::Running;
+            animable->startTime += time - animable->pauseTime;
+            addActive(*animable);
+            animable->animationResumed();
         }
 
+        /* Otherwise the state was changed back and forth, nothing to do */
+    }
+    _processing.clear();
+
+    /* Step the running animations. Stopped ones are swapped with the last
+       one, so the index is not advanced in that case. */
+    for(std::size_t i = 0; i < _active.size(); ) {
+        Animable<dimensions, T>& animable = *_active[i];
         CORRADE_INTERNAL_ASSERT(animable.previousState == AnimationState::Running);
 
+        /* State changed since the processing above (e.g. from another
+           animation callback), it'll be processed in next step */
+        if(animable.currentState != AnimationState::Running) {
+            ++i;
+            continue;
+        }
+
         /* Animation time exceeded duration */
         if(animable._duration != 0.0f && time-animable.startTime > animable._duration) {
             /* Not repeated or repeat count exceeded, stop */
             if(!animable._repeated || animable.repeats+1 == animable._repeatCount) {
                 animable.previousState = AnimationState::Stopped;
                 animable.currentState = AnimationState::Stopped;
-                --_runningCount;
+                removeActive(animable);
                 animable.animationStopped();
                 continue;
             }
@@ -128,12 +237,30 @@ template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::ste
         /* Animation is still running, perform animation step */
         CORRADE_ASSERT(time-animable.startTime >= 0.0f,
             "SceneGraph::AnimableGroup::step(): animation was started in future - probably wrong time passed", );
-        CORRADE_ASSERT(delta >= 0.0f,
-            "SceneGraph::AnimableGroup::step(): negative delta passed", );
-        animable.animationStep(time - animable.startTime, delta);
+        if(jobSystem && animable._threadSafe)
+            _parallel.emplace_back(&animable, time - animable.startTime);
+        else animable.animationStep(time - animable.startTime, delta);
+        ++_stepCount;
+        ++i;
+    }
+
+    /* Step the thread-safe animations in parallel, with enough of them in
+       each job to make the scheduling worth it */
+    if(!_parallel.empty()) {
+        constexpr std::size_t MinAnimablesPerJob = 256;
+        const std::size_t jobCount = std::max(std::size_t{1}, std::min(jobSystem->workerCount()*4, (_parallel.size() + MinAnimablesPerJob - 1)/MinAnimablesPerJob));
+        const std::size_t animablesPerJob = (_parallel.size() + jobCount - 1)/jobCount;
+        jobSystem->run(jobCount, [this, delta, animablesPerJob](const std::size_t job) {
+            const std::size_t end = std::min(_parallel.size(), (job + 1)*animablesPerJob);
+            for(std::size_t i = job*animablesPerJob; i < end; ++i)
+                _parallel[i].first->animationStep(_parallel[i].second, delta);
+        });
+        _parallel.clear();
     }
 
-    CORRADE_INTERNAL_ASSERT((_runningCount <= AnimableGroup<dimensions, T>::size()));
+    /* Tell the application there's more to do in the next step */
+    if(_activityCallback && (!_active.empty() || !_pending.empty()))
+        _activityCallback();
 }
 
 }}
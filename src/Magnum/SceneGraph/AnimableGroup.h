@@ -29,6 +29,10 @@
  * @brief Class @ref Magnum::SceneGraph::AnimableGroup, alias @ref Magnum::SceneGraph::BasicAnimableGroup2D, @ref Magnum::SceneGraph::BasicAnimableGroup3D, typedef @ref Magnum::SceneGraph::AnimableGroup2D, @ref Magnum::SceneGraph::AnimableGroup3D
  */
 
+#include <functional>
+#include <utility>
+#include <vector>
+
 #include "Magnum/SceneGraph/FeatureGroup.h"
 #include "Magnum/SceneGraph/visibility.h"
 
@@ -45,31 +49,121 @@ template<UnsignedInt dimensions, class T> class AnimableGroup: public FeatureGro
     friend Animable<dimensions, T>;
 
     public:
+        /**
+         * @brief Activity callback
+         *
+         * @see @ref setActivityCallback()
+         */
+        typedef std::function<void()> ActivityCallback;
+
         /**
          * @brief Constructor
          */
-        explicit AnimableGroup(): _runningCount(0), wakeUp(false) {}
+        explicit AnimableGroup(): _stepCount{0} {}
+
+        ~AnimableGroup();
 
         /**
          * @brief Count of running animations
          *
-         * @see @ref step()
+         * Compare with @ref size() to see how many of the animations in the
+         * group are active.
+         * @see @ref step(), @ref stepCount()
          */
-        std::size_t runningCount() const { return _runningCount; }
+        std::size_t runningCount() const { return _active.size(); }
+
+        /**
+         * @brief Count of animation steps done in last @ref step() call
+         *
+         * Count of @ref Animable::animationStep() calls, i.e. running
+         * animations that didn't stop in the last step.
+         * @see @ref runningCount()
+         */
+        std::size_t stepCount() const { return _stepCount; }
+
+        /** @brief Activity callback */
+        const ActivityCallback& activityCallback() const { return _activityCallback; }
+
+        /**
+         * @brief Set activity callback
+         * @return Reference to self (for method chaining)
+         *
+         * The callback is called every time an animation in the group
+         * changes its state and at the end of each @ref step() that leaves
+         * some animations running, i.e. whenever the next @ref step() has
+         * something to do. Useful for applications that render on demand,
+         * which can request a redraw from the callback instead of drawing
+         * continuously:
+         * @code
+         * animables.setActivityCallback([this]() { redraw(); });
+         * @endcode
+         * @see @ref Platform::Sdl2Application::setOnDemandRendering()
+         */
+        AnimableGroup<dimensions, T>& setActivityCallback(ActivityCallback callback) {
+            _activityCallback = std::move(callback);
+            return *this;
+        }
+
+        /**
+         * @brief Add animable to the group
+         * @return Reference to self (for method chaining)
+         *
+         * If the animable is part of another group, it is removed from it
+         * first, keeping its state.
+         * @see @ref FeatureGroup::add()
+         */
+        AnimableGroup<dimensions, T>& add(Animable<dimensions, T>& animable);
+
+        /**
+         * @brief Remove animable from the group
+         * @return Reference to self (for method chaining)
+         *
+         * The animable must be part of the group.
+         * @see @ref FeatureGroup::remove()
+         */
+        AnimableGroup<dimensions, T>& remove(Animable<dimensions, T>& animable);
 
         /**
          * @brief Perform animation step
          * @param time      Absolute time (e.g. @ref Timeline::previousFrameTime())
          * @param delta     Time delta for current frame (e.g. @ref Timeline::previousFrameDuration())
          *
-         * If there are no running animations the function does nothing.
-         * @see @ref runningCount()
+         * Handles animations that changed their state since the last step and
+         * then steps all running animations. Stopped and paused animations
+         * are not touched at all, so if there are no running animations and
+         * no state changes, the function does nothing.
+         * @see @ref runningCount(), @ref stepCount()
          */
         void step(Float time, Float delta);
 
+        /**
+         * @brief Perform animation step using given job system
+         *
+         * Same as @ref step(Float, Float), but steps of animations marked as
+         * thread-safe using @ref Animable::setThreadSafe() are split into
+         * jobs and executed in parallel on @p jobSystem after all other
+         * animations were stepped. State change callbacks and steps of
+         * animations that aren't thread-safe are executed on the calling
+         * thread.
+         */
+        void step(Float time, Float delta, AbstractJobSystem& jobSystem);
+
     private:
-        std::size_t _runningCount;
-        bool wakeUp;
+        void addActive(Animable<dimensions, T>& animable);
+        void removeActive(Animable<dimensions, T>& animable);
+        void removeFromLists(Animable<dimensions, T>& animable);
+        void stepInternal(Float time, Float delta, AbstractJobSystem* jobSystem);
+
+        /* Running animables, each knows its own index for O(1) removal */
+        std::vector<Animable<dimensions, T>*> _active;
+        /* Animables with a state change since last step (and a scratch copy
+           so callbacks can change state while the changes are processed) */
+        std::vector<Animable<dimensions, T>*> _pending, _processing;
+        /* Thread-safe steps with their animation time, kept to avoid
+           reallocation */
+        std::vector<std::pair<Animable<dimensions, T>*, Float>> _parallel;
+        std::size_t _stepCount;
+        ActivityCallback _activityCallback;
 };
 
 /**
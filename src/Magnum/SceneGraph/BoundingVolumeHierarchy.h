@@ -0,0 +1,390 @@
+#ifndef Magnum_SceneGraph_BoundingVolumeHierarchy_h
+#define Magnum_SceneGraph_BoundingVolumeHierarchy_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::BoundingVolume, @ref Magnum::SceneGraph::BoundingVolumeHierarchy, alias @ref Magnum::SceneGraph::BasicBoundingVolume2D, @ref Magnum::SceneGraph::BasicBoundingVolume3D, @ref Magnum::SceneGraph::BasicBoundingVolumeHierarchy2D, @ref Magnum::SceneGraph::BasicBoundingVolumeHierarchy3D, typedef @ref Magnum::SceneGraph::BoundingVolume2D, @ref Magnum::SceneGraph::BoundingVolume3D, @ref Magnum::SceneGraph::BoundingVolumeHierarchy2D, @ref Magnum::SceneGraph::BoundingVolumeHierarchy3D
+ */
+
+#include <utility>
+#include <vector>
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/SceneGraph/AbstractGroupedFeature.h"
+#include "Magnum/SceneGraph/FeatureGroup.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Bounding volume
+
+Axis-aligned bounding box of an object, kept in a
+@ref BoundingVolumeHierarchy for spatial queries. The box is given in
+object-local coordinates, its absolute counterpart is recalculated each time
+the object is cleaned. See @ref BoundingVolumeHierarchy for more information.
+
+## Explicit template specializations
+
+The following specializations are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type) you have to use @ref BoundingVolumeHierarchy.hpp implementation file to
+avoid linker errors. See also @ref compilation-speedup-hpp for more
+information.
+
+-   @ref BoundingVolume2D
+-   @ref BoundingVolume3D
+
+@see @ref scenegraph, @ref BasicBoundingVolume2D, @ref BasicBoundingVolume3D,
+    @ref BoundingVolume2D, @ref BoundingVolume3D
+*/
+template<UnsignedInt dimensions, class T> class BoundingVolume: public AbstractGroupedFeature<dimensions, BoundingVolume<dimensions, T>, T> {
+    friend BoundingVolumeHierarchy<dimensions, T>;
+
+    public:
+        /**
+         * @brief Constructor
+         * @param object        Object holding this feature
+         * @param bounds        Bounding box in object-local coordinates
+         * @param hierarchy     Hierarchy this volume belongs to
+         *
+         * Adds the feature to the object and also to the hierarchy, if
+         * specified. Otherwise you can use
+         * @ref BoundingVolumeHierarchy::add().
+         */
+        explicit BoundingVolume(AbstractObject<dimensions, T>& object, const RangeTypeFor<dimensions, T>& bounds, BoundingVolumeHierarchy<dimensions, T>* hierarchy = nullptr);
+
+        /**
+         * @brief Hierarchy containing this volume
+         *
+         * If the volume doesn't belong to any hierarchy, returns `nullptr`.
+         */
+        BoundingVolumeHierarchy<dimensions, T>* hierarchy() {
+            return static_cast<BoundingVolumeHierarchy<dimensions, T>*>(AbstractGroupedFeature<dimensions, BoundingVolume<dimensions, T>, T>::group());
+        }
+
+        /** @overload */
+        const BoundingVolumeHierarchy<dimensions, T>* hierarchy() const {
+            return static_cast<const BoundingVolumeHierarchy<dimensions, T>*>(AbstractGroupedFeature<dimensions, BoundingVolume<dimensions, T>, T>::group());
+        }
+
+        /** @brief Bounding box in object-local coordinates */
+        RangeTypeFor<dimensions, T> bounds() const { return _bounds; }
+
+        /**
+         * @brief Set bounding box
+         * @return Reference to self (for method chaining)
+         *
+         * The box is in object-local coordinates, expected to be finite.
+         * Marks the object as dirty.
+         */
+        BoundingVolume<dimensions, T>& setBounds(const RangeTypeFor<dimensions, T>& bounds);
+
+        /**
+         * @brief Bounding box in absolute coordinates
+         *
+         * Cleans the object before returning the box.
+         */
+        RangeTypeFor<dimensions, T> absoluteBounds();
+
+    protected:
+        /** Marks also the volume and the hierarchy as dirty */
+        void markDirty() override;
+
+    private:
+        void clean(const MatrixTypeFor<dimensions, T>& absoluteTransformationMatrix) override;
+
+        RangeTypeFor<dimensions, T> _bounds, _absoluteBounds;
+        bool _dirty;
+};
+
+/**
+@brief Bounding volume for two-dimensional scenes
+
+Convenience alternative to `BoundingVolume<2, T>`. See @ref BoundingVolume
+for more information.
+@see @ref BoundingVolume2D, @ref BasicBoundingVolume3D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicBoundingVolume2D = BoundingVolume<2, T>;
+#endif
+
+/**
+@brief Bounding volume for two-dimensional float scenes
+
+@see @ref BoundingVolume3D
+*/
+typedef BasicBoundingVolume2D<Float> BoundingVolume2D;
+
+/**
+@brief Bounding volume for three-dimensional scenes
+
+Convenience alternative to `BoundingVolume<3, T>`. See @ref BoundingVolume
+for more information.
+@see @ref BoundingVolume3D, @ref BasicBoundingVolume2D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicBoundingVolume3D = BoundingVolume<3, T>;
+#endif
+
+/**
+@brief Bounding volume for three-dimensional float scenes
+
+@see @ref BoundingVolume2D
+*/
+typedef BasicBoundingVolume3D<Float> BoundingVolume3D;
+
+/**
+@brief Bounding volume hierarchy
+
+Binary tree of @ref BoundingVolume features, answering region, radius, ray
+and frustum queries over the whole scene without testing every object. It's
+opt-in --- attach a @ref BoundingVolume to the objects that should take part
+in the queries, for example alongside a @ref Drawable having the same
+bounding box:
+@code
+SceneGraph::BoundingVolumeHierarchy3D volumes;
+
+Object3D* lamp = new Object3D{&scene};
+new SceneGraph::BoundingVolume3D{*lamp, {Vector3{-0.5f}, Vector3{0.5f}}, &volumes};
+
+// ...
+
+// Lights affecting given object
+for(SceneGraph::BoundingVolume3D* volume: volumes.volumesInRadius(position, 10.0f)) {
+    // ...
+}
+
+// Objects under the mouse cursor, nearest first
+for(const auto& hit: volumes.raycast(origin, direction)) {
+    // ...
+}
+@endcode
+
+@anchor SceneGraph-BoundingVolumeHierarchy-incremental
+## Incremental updates
+
+All queries call @ref update() first, which cleans objects that were marked
+dirty and refits only their leaves and ancestors, leaving the rest of the
+tree untouched. Moving objects gradually degrade quality of the tree, which is
+measured as sum of surface areas of all inner nodes relative to surface area
+of the root (perimeters in 2D), i.e. the expected count of inner nodes visited
+by a random query. Once the cost exceeds the cost right after the last build
+multiplied by @ref rebuildThreshold(), the tree is built again from scratch.
+The tree is built again also if volumes are added to or removed from the
+hierarchy.
+@see @ref scenegraph, @ref BasicBoundingVolumeHierarchy2D,
+    @ref BasicBoundingVolumeHierarchy3D, @ref BoundingVolumeHierarchy2D,
+    @ref BoundingVolumeHierarchy3D
+*/
+template<UnsignedInt dimensions, class T> class BoundingVolumeHierarchy: public FeatureGroup<dimensions, BoundingVolume<dimensions, T>, T> {
+    friend BoundingVolume<dimensions, T>;
+
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Marks the hierarchy as dirty.
+         */
+        explicit BoundingVolumeHierarchy();
+
+        /**
+         * @brief Whether the hierarchy is dirty
+         *
+         * True if any volume in the hierarchy was marked dirty since the
+         * last @ref update(). Adding or removing volumes is detected only in
+         * @ref update().
+         */
+        bool isDirty() const { return _dirty; }
+
+        /** @brief Rebuild threshold */
+        T rebuildThreshold() const { return _rebuildThreshold; }
+
+        /**
+         * @brief Set rebuild threshold
+         * @return Reference to self (for method chaining)
+         *
+         * Relative to the tree cost right after the last build, see
+         * @ref SceneGraph-BoundingVolumeHierarchy-incremental "above" for more
+         * information. Default is @cpp 1.5 @ce, set to
+         * @ref Constants::inf() to only refit the tree.
+         */
+        BoundingVolumeHierarchy<dimensions, T>& setRebuildThreshold(T threshold) {
+            _rebuildThreshold = threshold;
+            return *this;
+        }
+
+        /**
+         * @brief Tree cost
+         *
+         * Sum of surface areas of inner nodes relative to the root surface
+         * area as of the last @ref update(). Zero for trees with less than
+         * two volumes.
+         */
+        T cost() const;
+
+        /**
+         * @brief Count of volumes refitted in the last update
+         *
+         * @see @ref rebuildCount()
+         */
+        std::size_t refitCount() const { return _refitCount; }
+
+        /**
+         * @brief Count of tree builds
+         *
+         * Incremented each time the tree is built from scratch.
+         * @see @ref refitCount()
+         */
+        std::size_t rebuildCount() const { return _rebuildCount; }
+
+        /**
+         * @brief Update the hierarchy
+         *
+         * Cleans objects of all dirty volumes, refits the tree and builds it
+         * again if volumes were added or removed or the cost exceeded the
+         * threshold. Called implicitly by all queries. Does nothing if the
+         * hierarchy is not dirty and no volumes were added or removed.
+         */
+        void update();
+
+        /**
+         * @brief Volumes in given region
+         *
+         * Returns all volumes with absolute bounds intersecting given region,
+         * in the order they are in the hierarchy. Calls @ref update()
+         * before the operation.
+         */
+        std::vector<BoundingVolume<dimensions, T>*> volumesInRegion(const RangeTypeFor<dimensions, T>& region);
+
+        /**
+         * @brief Volumes in given radius
+         *
+         * Returns all volumes with absolute bounds closer than @p radius to
+         * @p center, in the order they are in the hierarchy. Calls
+         * @ref update() before the operation.
+         */
+        std::vector<BoundingVolume<dimensions, T>*> volumesInRadius(const VectorTypeFor<dimensions, T>& center, T radius);
+
+        /**
+         * @brief Volumes in given frustum
+         * @param projectionMatrix      Projection matrix multiplied with the
+         *      camera matrix, i.e. @ref Camera::projectionMatrix() times
+         *      @ref Camera::cameraMatrix()
+         *
+         * Returns all volumes with absolute bounds not completely outside of
+         * the frustum, in the order they are in the hierarchy. Calls
+         * @ref update() before the operation.
+         */
+        std::vector<BoundingVolume<dimensions, T>*> volumesInFrustum(const MatrixTypeFor<dimensions, T>& projectionMatrix);
+
+        /**
+         * @brief Volumes hit by a ray
+         * @param origin        Ray origin
+         * @param direction     Ray direction
+         * @param maxDistance   Max distance along the ray, in multiples of
+         *      direction length
+         *
+         * Returns all volumes with absolute bounds hit by the ray in range
+         * @f$ [ 0 ; maxDistance ] @f$ together with the distance at which
+         * the ray enters them, sorted by the distance. The distance is zero
+         * if the ray starts inside the bounds. Calls @ref update() before
+         * the operation.
+         */
+        std::vector<std::pair<BoundingVolume<dimensions, T>*, T>> raycast(const VectorTypeFor<dimensions, T>& origin, const VectorTypeFor<dimensions, T>& direction, T maxDistance = Math::Constants<T>::inf());
+
+    private:
+        struct Node {
+            RangeTypeFor<dimensions, T> bounds;
+            UnsignedInt parent;
+            /* For inner nodes the first child is right after the node,
+               for leaves index of the volume */
+            UnsignedInt second;
+            bool leaf;
+        };
+
+        void build();
+        UnsignedInt build(UnsignedInt* begin, UnsignedInt* end, UnsignedInt parent);
+        template<class Test, class Visit> void traverse(Test test, Visit visit) const;
+
+        std::vector<Node> _nodes;
+        /* Leaf node of each volume, indexed same as the features, and backup
+           of the feature list to detect changes in the hierarchy */
+        std::vector<UnsignedInt> _leaves;
+        std::vector<const BoundingVolume<dimensions, T>*> _volumes;
+        T _rebuildThreshold, _cost, _builtCost;
+        std::size_t _refitCount, _rebuildCount;
+        bool _dirty;
+};
+
+/**
+@brief Bounding volume hierarchy for two-dimensional scenes
+
+Convenience alternative to `BoundingVolumeHierarchy<2, T>`. See
+@ref BoundingVolumeHierarchy for more information.
+@see @ref BoundingVolumeHierarchy2D, @ref BasicBoundingVolumeHierarchy3D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicBoundingVolumeHierarchy2D = BoundingVolumeHierarchy<2, T>;
+#endif
+
+/**
+@brief Bounding volume hierarchy for two-dimensional float scenes
+
+@see @ref BoundingVolumeHierarchy3D
+*/
+typedef BasicBoundingVolumeHierarchy2D<Float> BoundingVolumeHierarchy2D;
+
+/**
+@brief Bounding volume hierarchy for three-dimensional scenes
+
+Convenience alternative to `BoundingVolumeHierarchy<3, T>`. See
+@ref BoundingVolumeHierarchy for more information.
+@see @ref BoundingVolumeHierarchy3D, @ref BasicBoundingVolumeHierarchy2D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicBoundingVolumeHierarchy3D = BoundingVolumeHierarchy<3, T>;
+#endif
+
+/**
+@brief Bounding volume hierarchy for three-dimensional float scenes
+
+@see @ref BoundingVolumeHierarchy2D
+*/
+typedef BasicBoundingVolumeHierarchy3D<Float> BoundingVolumeHierarchy3D;
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
+extern template class MAGNUM_SCENEGRAPH_EXPORT BoundingVolume<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT BoundingVolume<3, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT BoundingVolumeHierarchy<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT BoundingVolumeHierarchy<3, Float>;
+#endif
+
+}}
+
+#endif
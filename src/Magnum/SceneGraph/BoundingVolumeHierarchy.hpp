@@ -0,0 +1,337 @@
+#ifndef Magnum_SceneGraph_BoundingVolumeHierarchy_hpp
+#define Magnum_SceneGraph_BoundingVolumeHierarchy_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref BoundingVolumeHierarchy.h
+ */
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/SceneGraph/AbstractObject.h"
+#include "Magnum/SceneGraph/BoundingVolumeHierarchy.h"
+#include "Magnum/SceneGraph/Camera.hpp"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation {
+
+/* Surface area of the box, perimeter in 2D. Both are halved, which doesn't
+   matter as only relative values are used. */
+template<UnsignedInt dimensions, class T> T boundingVolumeArea(const RangeTypeFor<dimensions, T>& bounds) {
+    const VectorTypeFor<dimensions, T> size = bounds.size();
+    T area{};
+    for(UnsignedInt i = 0; i != dimensions; ++i) {
+        T face{1};
+        for(UnsignedInt j = 0; j != dimensions; ++j)
+            if(j != i) face *= size[j];
+        area += face;
+    }
+    return area;
+}
+
+/* Range comparison is fuzzy, the refit needs an exact one */
+template<UnsignedInt dimensions, class T> bool boundingVolumeEqual(const RangeTypeFor<dimensions, T>& a, const RangeTypeFor<dimensions, T>& b) {
+    for(UnsignedInt i = 0; i != dimensions; ++i)
+        if(a.min()[i] != b.min()[i] || a.max()[i] != b.max()[i]) return false;
+    return true;
+}
+
+/* Distance at which the ray enters the box or infinity if it misses it */
+template<UnsignedInt dimensions, class T> T boundingVolumeRaycast(const RangeTypeFor<dimensions, T>& bounds, const VectorTypeFor<dimensions, T>& origin, const VectorTypeFor<dimensions, T>& direction, const T maxDistance) {
+    T near{}, far = maxDistance;
+    for(UnsignedInt i = 0; i != dimensions; ++i) {
+        if(direction[i] == T(0)) {
+            if(origin[i] < bounds.min()[i] || origin[i] > bounds.max()[i])
+                return Math::Constants<T>::inf();
+            continue;
+        }
+
+        T a = (bounds.min()[i] - origin[i])/direction[i];
+        T b = (bounds.max()[i] - origin[i])/direction[i];
+        if(a > b) std::swap(a, b);
+        near = std::max(near, a);
+        far = std::min(far, b);
+        if(near > far) return Math::Constants<T>::inf();
+    }
+
+    return near;
+}
+
+}
+
+template<UnsignedInt dimensions, class T> BoundingVolume<dimensions, T>::BoundingVolume(AbstractObject<dimensions, T>& object, const RangeTypeFor<dimensions, T>& bounds, BoundingVolumeHierarchy<dimensions, T>* hierarchy): AbstractGroupedFeature<dimensions, BoundingVolume<dimensions, T>, T>(object, hierarchy), _bounds{bounds}, _dirty{true} {
+    AbstractFeature<dimensions, T>::setCachedTransformations(CachedTransformation::Absolute);
+
+    /* Make sure the absolute bounds get calculated */
+    object.setDirty();
+}
+
+template<UnsignedInt dimensions, class T> BoundingVolume<dimensions, T>& BoundingVolume<dimensions, T>::setBounds(const RangeTypeFor<dimensions, T>& bounds) {
+    _bounds = bounds;
+    markDirty();
+    this->object().setDirty();
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> RangeTypeFor<dimensions, T> BoundingVolume<dimensions, T>::absoluteBounds() {
+    this->object().setClean();
+    return _absoluteBounds;
+}
+
+template<UnsignedInt dimensions, class T> void BoundingVolume<dimensions, T>::markDirty() {
+    _dirty = true;
+    if(hierarchy()) hierarchy()->_dirty = true;
+}
+
+template<UnsignedInt dimensions, class T> void BoundingVolume<dimensions, T>::clean(const MatrixTypeFor<dimensions, T>& absoluteTransformationMatrix) {
+    /* Transform the center and project the extents on the absolute axes */
+    const VectorTypeFor<dimensions, T> center = absoluteTransformationMatrix.transformPoint(_bounds.center());
+    const VectorTypeFor<dimensions, T> extent = _bounds.size()/T(2);
+    VectorTypeFor<dimensions, T> absoluteExtent;
+    for(UnsignedInt row = 0; row != dimensions; ++row)
+        for(UnsignedInt col = 0; col != dimensions; ++col)
+            absoluteExtent[row] += Math::abs(absoluteTransformationMatrix[col][row])*extent[col];
+
+    _absoluteBounds = {center - absoluteExtent, center + absoluteExtent};
+}
+
+template<UnsignedInt dimensions, class T> BoundingVolumeHierarchy<dimensions, T>::BoundingVolumeHierarchy(): _rebuildThreshold{T(1.5)}, _cost{}, _builtCost{}, _refitCount{}, _rebuildCount{}, _dirty{true} {}
+
+template<UnsignedInt dimensions, class T> T BoundingVolumeHierarchy<dimensions, T>::cost() const {
+    if(_nodes.size() < 3) return T(0);
+    const T rootArea = Implementation::boundingVolumeArea<dimensions, T>(_nodes[0].bounds);
+    return rootArea == T(0) ? T(0) : _cost/rootArea;
+}
+
+template<UnsignedInt dimensions, class T> void BoundingVolumeHierarchy<dimensions, T>::update() {
+    /* Nothing changed since last time */
+    bool changed = !_rebuildCount || _volumes.size() != this->size();
+    for(std::size_t i = 0; !changed && i != this->size(); ++i)
+        changed = _volumes[i] != &(*this)[i];
+    if(!_dirty && !changed) return;
+
+    /* Clean objects of dirty volumes */
+    std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>> objects;
+    for(std::size_t i = 0; i != this->size(); ++i)
+        if((*this)[i]._dirty) objects.push_back((*this)[i].object());
+    if(!objects.empty()) AbstractObject<dimensions, T>::setClean(objects);
+
+    _refitCount = 0;
+
+    /* Volumes were added or removed, start from scratch */
+    if(changed) {
+        for(std::size_t i = 0; i != this->size(); ++i)
+            (*this)[i]._dirty = false;
+        build();
+
+    /* Otherwise refit leaves of the dirty volumes and their ancestors,
+       stopping at the first ancestor that didn't change */
+    } else {
+        for(std::size_t i = 0; i != this->size(); ++i) {
+            BoundingVolume<dimensions, T>& volume = (*this)[i];
+            if(!volume._dirty) continue;
+            volume._dirty = false;
+            ++_refitCount;
+
+            UnsignedInt node = _leaves[i];
+            _nodes[node].bounds = volume._absoluteBounds;
+            while(_nodes[node].parent != ~UnsignedInt{}) {
+                Node& parent = _nodes[_nodes[node].parent];
+                const RangeTypeFor<dimensions, T> bounds = Math::join(_nodes[_nodes[node].parent + 1].bounds, _nodes[parent.second].bounds);
+                if(Implementation::boundingVolumeEqual<dimensions, T>(bounds, parent.bounds)) break;
+
+                _cost += Implementation::boundingVolumeArea<dimensions, T>(bounds) - Implementation::boundingVolumeArea<dimensions, T>(parent.bounds);
+                parent.bounds = bounds;
+                node = _nodes[node].parent;
+            }
+        }
+
+        /* The tree degraded too much */
+        if(cost() > _builtCost*_rebuildThreshold) build();
+    }
+
+    _dirty = false;
+}
+
+template<UnsignedInt dimensions, class T> void BoundingVolumeHierarchy<dimensions, T>::build() {
+    _volumes.resize(this->size());
+    for(std::size_t i = 0; i != this->size(); ++i)
+        _volumes[i] = &(*this)[i];
+
+    _nodes.clear();
+    _leaves.resize(this->size());
+    _cost = T(0);
+    ++_rebuildCount;
+    if(this->isEmpty()) {
+        _builtCost = T(0);
+        return;
+    }
+
+    std::vector<UnsignedInt> indices(this->size());
+    std::iota(indices.begin(), indices.end(), 0);
+    _nodes.reserve(2*this->size() - 1);
+    build(indices.data(), indices.data() + indices.size(), ~UnsignedInt{});
+    _builtCost = cost();
+}
+
+template<UnsignedInt dimensions, class T> UnsignedInt BoundingVolumeHierarchy<dimensions, T>::build(UnsignedInt* const begin, UnsignedInt* const end, const UnsignedInt parent) {
+    const UnsignedInt index = _nodes.size();
+    _nodes.push_back({(*this)[*begin]._absoluteBounds, parent, *begin, true});
+    if(end - begin == 1) {
+        _leaves[*begin] = index;
+        return index;
+    }
+
+    /* Split in the median of centers along the axis where they are spread
+       the most */
+    VectorTypeFor<dimensions, T> min = (*this)[*begin]._absoluteBounds.center();
+    VectorTypeFor<dimensions, T> max = min;
+    for(UnsignedInt* it = begin + 1; it != end; ++it) {
+        const VectorTypeFor<dimensions, T> center = (*this)[*it]._absoluteBounds.center();
+        min = Math::min(min, center);
+        max = Math::max(max, center);
+    }
+    const VectorTypeFor<dimensions, T> spread = max - min;
+    UnsignedInt axis = 0;
+    for(UnsignedInt i = 1; i != dimensions; ++i)
+        if(spread[i] > spread[axis]) axis = i;
+
+    UnsignedInt* const middle = begin + (end - begin)/2;
+    std::nth_element(begin, middle, end, [this, axis](UnsignedInt a, UnsignedInt b) {
+        return (*this)[a]._absoluteBounds.center()[axis] < (*this)[b]._absoluteBounds.center()[axis];
+    });
+
+    build(begin, middle, index);
+    const UnsignedInt second = build(middle, end, index);
+
+    Node& node = _nodes[index];
+    node.bounds = Math::join(_nodes[index + 1].bounds, _nodes[second].bounds);
+    node.second = second;
+    node.leaf = false;
+    _cost += Implementation::boundingVolumeArea<dimensions, T>(node.bounds);
+    return index;
+}
+
+template<UnsignedInt dimensions, class T> template<class Test, class Visit> void BoundingVolumeHierarchy<dimensions, T>::traverse(Test test, Visit visit) const {
+    if(_nodes.empty()) return;
+
+    std::vector<UnsignedInt> stack{0};
+    while(!stack.empty()) {
+        const UnsignedInt index = stack.back();
+        stack.pop_back();
+
+        const Node& node = _nodes[index];
+        if(!test(node.bounds)) continue;
+        if(node.leaf) visit(node.second);
+        else {
+            stack.push_back(node.second);
+            stack.push_back(index + 1);
+        }
+    }
+}
+
+template<UnsignedInt dimensions, class T> std::vector<BoundingVolume<dimensions, T>*> BoundingVolumeHierarchy<dimensions, T>::volumesInRegion(const RangeTypeFor<dimensions, T>& region) {
+    update();
+
+    std::vector<UnsignedInt> found;
+    traverse([&region](const RangeTypeFor<dimensions, T>& bounds) {
+        return (bounds.min() <= region.max()).all() && (region.min() <= bounds.max()).all();
+    }, [&found](UnsignedInt i) { found.push_back(i); });
+
+    /* Keep the order of the hierarchy */
+    std::sort(found.begin(), found.end());
+    std::vector<BoundingVolume<dimensions, T>*> out;
+    out.reserve(found.size());
+    for(UnsignedInt i: found) out.push_back(&(*this)[i]);
+    return out;
+}
+
+template<UnsignedInt dimensions, class T> std::vector<BoundingVolume<dimensions, T>*> BoundingVolumeHierarchy<dimensions, T>::volumesInRadius(const VectorTypeFor<dimensions, T>& center, const T radius) {
+    update();
+
+    std::vector<UnsignedInt> found;
+    traverse([&center, radius](const RangeTypeFor<dimensions, T>& bounds) {
+        return (Math::clamp(center, bounds.min(), bounds.max()) - center).dot() <= radius*radius;
+    }, [&found](UnsignedInt i) { found.push_back(i); });
+
+    std::sort(found.begin(), found.end());
+    std::vector<BoundingVolume<dimensions, T>*> out;
+    out.reserve(found.size());
+    for(UnsignedInt i: found) out.push_back(&(*this)[i]);
+    return out;
+}
+
+template<UnsignedInt dimensions, class T> std::vector<BoundingVolume<dimensions, T>*> BoundingVolumeHierarchy<dimensions, T>::volumesInFrustum(const MatrixTypeFor<dimensions, T>& projectionMatrix) {
+    update();
+
+    /* The box is outside if its center is further behind any plane than its
+       projected radius, same as in Camera::drawCulled() */
+    const auto planes = Implementation::CullingPlanes<dimensions, T>::planes(projectionMatrix);
+    std::vector<UnsignedInt> found;
+    traverse([&planes](const RangeTypeFor<dimensions, T>& bounds) {
+        const VectorTypeFor<dimensions, T> center = bounds.center();
+        const VectorTypeFor<dimensions, T> extent = bounds.size()/T(2);
+        for(const auto& plane: planes) {
+            T distance = plane[dimensions];
+            for(UnsignedInt i = 0; i != dimensions; ++i)
+                distance += plane[i]*center[i] + Math::abs(plane[i])*extent[i];
+            if(distance < T(0)) return false;
+        }
+        return true;
+    }, [&found](UnsignedInt i) { found.push_back(i); });
+
+    std::sort(found.begin(), found.end());
+    std::vector<BoundingVolume<dimensions, T>*> out;
+    out.reserve(found.size());
+    for(UnsignedInt i: found) out.push_back(&(*this)[i]);
+    return out;
+}
+
+template<UnsignedInt dimensions, class T> std::vector<std::pair<BoundingVolume<dimensions, T>*, T>> BoundingVolumeHierarchy<dimensions, T>::raycast(const VectorTypeFor<dimensions, T>& origin, const VectorTypeFor<dimensions, T>& direction, const T maxDistance) {
+    update();
+
+    std::vector<std::pair<T, UnsignedInt>> found;
+    traverse([&](const RangeTypeFor<dimensions, T>& bounds) {
+        return Implementation::boundingVolumeRaycast<dimensions, T>(bounds, origin, direction, maxDistance) != Math::Constants<T>::inf();
+    }, [&](UnsignedInt i) {
+        found.emplace_back(Implementation::boundingVolumeRaycast<dimensions, T>(_nodes[_leaves[i]].bounds, origin, direction, maxDistance), i);
+    });
+
+    /* Nearest first, hits at the same distance in order of the hierarchy */
+    std::sort(found.begin(), found.end());
+    std::vector<std::pair<BoundingVolume<dimensions, T>*, T>> out;
+    out.reserve(found.size());
+    for(const auto& hit: found) out.emplace_back(&(*this)[hit.second], hit.first);
+    return out;
+}
+
+}}
+
+#endif
@@ -238,6 +238,48 @@ template<UnsignedInt dimensions, class T> class Camera: public AbstractFeature<d
          */
         virtual void draw(DrawableGroup<dimensions, T>& group);
 
+        /**
+         * @brief Draw using given job system
+         *
+         * Same as @ref draw(DrawableGroup<dimensions, T>&), but the
+         * transformations of all objects in the group are computed in jobs
+         * executed by @p jobSystem. The drawing itself is done on the calling
+         * thread. See @ref Object::transformations() for more information.
+         */
+        void draw(DrawableGroup<dimensions, T>& group, AbstractJobSystem& jobSystem);
+
+        /**
+         * @brief Draw using given frame arena
+         *
+         * Same as @ref draw(DrawableGroup<dimensions, T>&), but all
+         * temporary data are allocated from @p arena, so the function
+         * doesn't allocate from the heap. See @ref FrameArena for more
+         * information.
+         */
+        void draw(DrawableGroup<dimensions, T>& group, FrameArena& arena);
+
+        /**
+         * @brief Draw with frustum culling
+         * @return Count of drawables that were culled
+         *
+         * Similar to @ref draw(), but skips drawables that have a bounding
+         * box set using @ref Drawable::setBoundingBox() which lies completely
+         * outside of the frustum given by @ref projectionMatrix(). The
+         * bounding boxes are transformed to camera space and tested against
+         * all frustum planes in a single batch. Drawables without bounding
+         * box are always drawn.
+         * @see @ref Math::Geometry::Intersection::aabbFrustum()
+         */
+        std::size_t drawCulled(DrawableGroup<dimensions, T>& group);
+
+        /**
+         * @brief Draw with frustum culling using given frame arena
+         *
+         * Same as @ref drawCulled(DrawableGroup<dimensions, T>&), but all
+         * temporary data are allocated from @p arena.
+         */
+        std::size_t drawCulled(DrawableGroup<dimensions, T>& group, FrameArena& arena);
+
     private:
         /** Recalculates camera matrix */
         void cleanInverted(const MatrixTypeFor<dimensions, T>& invertedAbsoluteTransformationMatrix) override {
@@ -246,6 +288,8 @@ template<UnsignedInt dimensions, class T> class Camera: public AbstractFeature<d
 
         void fixAspectRatio();
 
+        template<class Allocator> std::size_t drawCulledInternal(DrawableGroup<dimensions, T>& group, Containers::ArrayView<const MatrixTypeFor<dimensions, T>> transformations, const Allocator& allocator);
+
         MatrixTypeFor<dimensions, T> _rawProjectionMatrix;
         AspectRatioPolicy _aspectRatioPolicy;
 
@@ -29,7 +29,10 @@
  * @brief @ref compilation-speedup-hpp "Template implementation" for @ref Camera.h
  */
 
+#include "Magnum/Instrumentation.h"
+#include "Magnum/Math/Frustum.h"
 #include "Magnum/Math/Functions.h"
+#include "Magnum/SceneGraph/AbstractJobSystem.h"
 #include "Magnum/SceneGraph/Camera.h"
 #include "Magnum/SceneGraph/Drawable.h"
 
@@ -53,6 +56,24 @@ template<UnsignedInt dimensions, class T> MatrixTypeFor<dimensions, T> aspectRat
         Math::Vector2<T>(T(1), relativeAspectRatio.x()/relativeAspectRatio.y()), T(1)));
 }
 
+template<UnsignedInt dimensions, class T> struct CullingPlanes;
+
+/* Clip space is [-1, 1] on all axes, so (row(3) ± row(i))·p >= 0 for all
+   points inside the frustum */
+template<class T> struct CullingPlanes<2, T> {
+    static std::vector<Math::Vector3<T>> planes(const Math::Matrix3<T>& m) {
+        return {m.row(2) + m.row(0), m.row(2) - m.row(0),
+                m.row(2) + m.row(1), m.row(2) - m.row(1)};
+    }
+};
+
+template<class T> struct CullingPlanes<3, T> {
+    static std::vector<Math::Vector4<T>> planes(const Math::Matrix4<T>& m) {
+        const Math::Frustum<T> frustum = Math::Frustum<T>::fromMatrix(m);
+        return {frustum.planes().begin(), frustum.planes().end()};
+    }
+};
+
 }
 
 template<UnsignedInt dimensions, class T> Camera<dimensions, T>::Camera(AbstractObject<dimensions, T>& object): AbstractFeature<dimensions, T>(object), _aspectRatioPolicy(AspectRatioPolicy::NotPreserved) {
@@ -86,6 +107,8 @@ template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::draw(Drawa
     AbstractObject<dimensions, T>* scene = AbstractFeature<dimensions, T>::object().scene();
     CORRADE_ASSERT(scene, "Camera::draw(): cannot draw when camera is not part of any scene", );
 
+    MAGNUM_INSTRUMENT_ZONE(Instrumentation::Zone::CameraDraw);
+
     /* Compute camera matrix */
     AbstractFeature<dimensions, T>::object().setClean();
 
@@ -102,6 +125,150 @@ template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::draw(Drawa
         group[i].draw(transformations[i], *this);
 }
 
+template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::draw(DrawableGroup<dimensions, T>& group, AbstractJobSystem& jobSystem) {
+    AbstractObject<dimensions, T>* scene = AbstractFeature<dimensions, T>::object().scene();
+    CORRADE_ASSERT(scene, "Camera::draw(): cannot draw when camera is not part of any scene", );
+
+    MAGNUM_INSTRUMENT_ZONE(Instrumentation::Zone::CameraDraw);
+
+    /* Compute camera matrix */
+    AbstractFeature<dimensions, T>::object().setClean();
+
+    /* Compute transformations of all objects in the group relative to the
+       camera, in parallel */
+    std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>> objects;
+    objects.reserve(group.size());
+    for(std::size_t i = 0; i != group.size(); ++i)
+        objects.push_back(group[i].object());
+    std::vector<MatrixTypeFor<dimensions, T>> transformations =
+        scene->transformationMatrices(objects, jobSystem, _cameraMatrix);
+
+    /* Perform the drawing */
+    for(std::size_t i = 0; i != transformations.size(); ++i)
+        group[i].draw(transformations[i], *this);
+}
+
+template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::draw(DrawableGroup<dimensions, T>& group, FrameArena& arena) {
+    AbstractObject<dimensions, T>* scene = AbstractFeature<dimensions, T>::object().scene();
+    CORRADE_ASSERT(scene, "Camera::draw(): cannot draw when camera is not part of any scene", );
+
+    MAGNUM_INSTRUMENT_ZONE(Instrumentation::Zone::CameraDraw);
+
+    /* Compute camera matrix */
+    AbstractFeature<dimensions, T>::object().setClean();
+
+    /* Compute transformations of all objects in the group relative to the
+       camera, everything allocated from the arena */
+    FrameArenaVector<std::reference_wrapper<AbstractObject<dimensions, T>>> objects{arena};
+    objects.reserve(group.size());
+    for(std::size_t i = 0; i != group.size(); ++i)
+        objects.push_back(group[i].object());
+    FrameArenaVector<MatrixTypeFor<dimensions, T>> transformations =
+        scene->transformationMatrices({objects.data(), objects.size()}, arena, _cameraMatrix);
+
+    /* Perform the drawing */
+    for(std::size_t i = 0; i != transformations.size(); ++i)
+        group[i].draw(transformations[i], *this);
+}
+
+template<UnsignedInt dimensions, class T> std::size_t Camera<dimensions, T>::drawCulled(DrawableGroup<dimensions, T>& group) {
+    AbstractObject<dimensions, T>* scene = AbstractFeature<dimensions, T>::object().scene();
+    CORRADE_ASSERT(scene, "Camera::drawCulled(): cannot draw when camera is not part of any scene", 0);
+
+    MAGNUM_INSTRUMENT_ZONE(Instrumentation::Zone::CameraDraw);
+
+    /* Compute camera matrix */
+    AbstractFeature<dimensions, T>::object().setClean();
+
+    /* Compute transformations of all objects in the group relative to the camera */
+    std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>> objects;
+    objects.reserve(group.size());
+    for(std::size_t i = 0; i != group.size(); ++i)
+        objects.push_back(group[i].object());
+    std::vector<MatrixTypeFor<dimensions, T>> transformations =
+        scene->transformationMatrices(objects, _cameraMatrix);
+
+    return drawCulledInternal(group, {transformations.data(), transformations.size()}, std::allocator<T>{});
+}
+
+template<UnsignedInt dimensions, class T> std::size_t Camera<dimensions, T>::drawCulled(DrawableGroup<dimensions, T>& group, FrameArena& arena) {
+    AbstractObject<dimensions, T>* scene = AbstractFeature<dimensions, T>::object().scene();
+    CORRADE_ASSERT(scene, "Camera::drawCulled(): cannot draw when camera is not part of any scene", 0);
+
+    MAGNUM_INSTRUMENT_ZONE(Instrumentation::Zone::CameraDraw);
+
+    /* Compute camera matrix */
+    AbstractFeature<dimensions, T>::object().setClean();
+
+    /* Compute transformations of all objects in the group relative to the
+       camera, everything allocated from the arena */
+    FrameArenaVector<std::reference_wrapper<AbstractObject<dimensions, T>>> objects{arena};
+    objects.reserve(group.size());
+    for(std::size_t i = 0; i != group.size(); ++i)
+        objects.push_back(group[i].object());
+    FrameArenaVector<MatrixTypeFor<dimensions, T>> transformations =
+        scene->transformationMatrices({objects.data(), objects.size()}, arena, _cameraMatrix);
+
+    return drawCulledInternal(group, {transformations.data(), transformations.size()}, FrameArenaAllocator<T>{arena});
+}
+
+template<UnsignedInt dimensions, class T> template<class Allocator> std::size_t Camera<dimensions, T>::drawCulledInternal(DrawableGroup<dimensions, T>& group, const Containers::ArrayView<const MatrixTypeFor<dimensions, T>> transformations, const Allocator& allocator) {
+    typedef typename std::allocator_traits<Allocator>::template rebind_alloc<UnsignedByte> ByteAllocator;
+
+    /* Transform the bounding boxes to camera space and store their centers
+       and extents in structure-of-arrays layout so the plane tests below are
+       simple loops over contiguous memory. Drawables without bounding box
+       are tested too (with zero center and extent) to keep the loops
+       branchless, but are drawn regardless of the result. */
+    const std::size_t count = transformations.size();
+    std::vector<T, Allocator> centers(dimensions*count, T{}, allocator);
+    std::vector<T, Allocator> extents(dimensions*count, T{}, allocator);
+    std::vector<UnsignedByte, ByteAllocator> visible(count, 1, ByteAllocator{allocator});
+    std::vector<UnsignedByte, ByteAllocator> alwaysVisible(count, 0, ByteAllocator{allocator});
+    for(std::size_t i = 0; i != count; ++i) {
+        const Drawable<dimensions, T>& drawable = group[i];
+        if(!drawable.hasBoundingBox()) {
+            alwaysVisible[i] = 1;
+            continue;
+        }
+
+        const MatrixTypeFor<dimensions, T>& m = transformations[i];
+        const VectorTypeFor<dimensions, T> center = m.transformPoint(drawable.boundingBox().center());
+        const VectorTypeFor<dimensions, T> extent = drawable.boundingBox().size()/T(2);
+        for(UnsignedInt row = 0; row != dimensions; ++row) {
+            T e{};
+            for(UnsignedInt col = 0; col != dimensions; ++col)
+                e += Math::abs(m[col][row])*extent[col];
+            centers[row*count + i] = center[row];
+            extents[row*count + i] = e;
+        }
+    }
+
+    /* Test all boxes against one plane at a time. The box is outside if its
+       center is further behind the plane than its projected radius. */
+    for(const auto& plane: Implementation::CullingPlanes<dimensions, T>::planes(_projectionMatrix)) {
+        for(std::size_t i = 0; i != count; ++i) {
+            T distance = plane[dimensions];
+            for(UnsignedInt d = 0; d != dimensions; ++d)
+                distance += plane[d]*centers[d*count + i] + Math::abs(plane[d])*extents[d*count + i];
+            visible[i] &= UnsignedByte(distance >= T(0));
+        }
+    }
+
+    /* Perform the drawing */
+    std::size_t culled = 0;
+    for(std::size_t i = 0; i != count; ++i) {
+        if(!visible[i] && !alwaysVisible[i]) {
+            ++culled;
+            continue;
+        }
+
+        group[i].draw(transformations[i], *this);
+    }
+
+    return culled;
+}
+
 }}
 
 #endif
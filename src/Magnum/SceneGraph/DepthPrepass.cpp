@@ -0,0 +1,181 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DepthPrepass.h"
+
+#include <Corrade/Utility/Resource.h>
+
+#include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Instrumentation.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/Shader.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/Shaders/Implementation/CreateCompatibilityShader.h"
+
+#ifdef MAGNUM_BUILD_STATIC
+static void importSceneGraphResources() {
+    CORRADE_RESOURCE_INITIALIZE(MagnumSceneGraph_RCS)
+}
+#endif
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation {
+
+class DepthPrepassShader: public AbstractShaderProgram {
+    public:
+        typedef Attribute<0, Vector3> Position;
+
+        explicit DepthPrepassShader();
+
+        DepthPrepassShader& setTransformationMatrix(const Matrix4& matrix) {
+            setUniform(_transformationMatrixUniform, matrix);
+            return *this;
+        }
+
+        DepthPrepassShader& setProjectionMatrix(const Matrix4& matrix) {
+            setUniform(_projectionMatrixUniform, matrix);
+            return *this;
+        }
+
+    private:
+        Int _transformationMatrixUniform{0},
+            _projectionMatrixUniform{1};
+};
+
+DepthPrepassShader::DepthPrepassShader() {
+    #ifdef MAGNUM_BUILD_STATIC
+    /* Import resources on static build, if not already */
+    if(!Utility::Resource::hasGroup("MagnumSceneGraph"))
+        importSceneGraphResources();
+    #endif
+    Utility::Resource rs("MagnumSceneGraph");
+
+    #ifndef MAGNUM_TARGET_GLES
+    const Version version = Context::current().supportedVersion({Version::GL320, Version::GL310, Version::GL300, Version::GL210});
+    #else
+    const Version version = Context::current().supportedVersion({Version::GLES300, Version::GLES200});
+    #endif
+
+    Shader vert = Shaders::Implementation::createCompatibilityShader(rs, version, Shader::Type::Vertex);
+    Shader frag = Shaders::Implementation::createCompatibilityShader(rs, version, Shader::Type::Fragment);
+    vert.addSource(rs.get("DepthPrepass.vert"));
+    frag.addSource(rs.get("DepthPrepass.frag"));
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(compileAndLink({vert, frag}, [&]() {
+        #ifndef MAGNUM_TARGET_GLES
+        if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_attrib_location>(version))
+        #else
+        if(!Context::current().isVersionSupported(Version::GLES300))
+        #endif
+        {
+            bindAttributeLocation(Position::Location, "position");
+        }
+    }));
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_uniform_location>(version))
+    #endif
+    {
+        _transformationMatrixUniform = uniformLocation("transformationMatrix");
+        _projectionMatrixUniform = uniformLocation("projectionMatrix");
+    }
+}
+
+}
+
+DepthPrepass::DepthPrepass(): _shader{new Implementation::DepthPrepassShader}, _depthFunction{Renderer::DepthFunction::Equal}, _enabled{true} {}
+
+DepthPrepass::DepthPrepass(DepthPrepass&&) noexcept = default;
+
+DepthPrepass::~DepthPrepass() = default;
+
+DepthPrepass& DepthPrepass::operator=(DepthPrepass&&) noexcept = default;
+
+std::size_t DepthPrepass::draw(Camera3D& camera, DrawableGroup3D& group) {
+    AbstractObject3D* scene = camera.object().scene();
+    CORRADE_ASSERT(scene, "SceneGraph::DepthPrepass::draw(): cannot draw when camera is not part of any scene", 0);
+
+    MAGNUM_INSTRUMENT_ZONE(Instrumentation::Zone::CameraDraw);
+
+    /* Compute transformations of all objects in the group relative to the
+       camera */
+    std::vector<std::reference_wrapper<AbstractObject3D>> objects;
+    objects.reserve(group.size());
+    for(std::size_t i = 0; i != group.size(); ++i)
+        objects.push_back(group[i].object());
+    const std::vector<Matrix4> transformations =
+        scene->transformationMatrices(objects, camera.cameraMatrix());
+
+    if(!_enabled) {
+        for(std::size_t i = 0; i != transformations.size(); ++i)
+            group[i].draw(transformations[i], camera);
+        return 0;
+    }
+
+    /* Fill the depth buffer using the depth meshes */
+    std::size_t count = 0;
+    {
+        MAGNUM_INSTRUMENT_ZONE(Instrumentation::Zone::DepthPrepass);
+
+        Renderer::setColorMask(false, false, false, false);
+        _shader->setProjectionMatrix(camera.projectionMatrix());
+        for(std::size_t i = 0; i != transformations.size(); ++i) {
+            Mesh* const mesh = group[i].depthMesh();
+            if(!mesh) continue;
+
+            _shader->setTransformationMatrix(transformations[i]);
+            mesh->draw(*_shader);
+            ++count;
+        }
+        Renderer::setColorMask(true, true, true, true);
+    }
+
+    /* Shade only the front-most fragments of the drawables above. The depth
+       is already there, so no need to write it again. */
+    if(count) {
+        Renderer::setDepthFunction(_depthFunction);
+        Renderer::setDepthMask(false);
+        for(std::size_t i = 0; i != transformations.size(); ++i)
+            if(group[i].depthMesh()) group[i].draw(transformations[i], camera);
+        Renderer::setDepthFunction(Renderer::DepthFunction::Less);
+        Renderer::setDepthMask(true);
+    }
+
+    /* Drawables without depth mesh are drawn the usual way, against the depth
+       buffer filled above */
+    if(count != transformations.size()) {
+        for(std::size_t i = 0; i != transformations.size(); ++i)
+            if(!group[i].depthMesh()) group[i].draw(transformations[i], camera);
+    }
+
+    return count;
+}
+
+}}
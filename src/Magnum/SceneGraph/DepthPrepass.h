@@ -0,0 +1,186 @@
+#ifndef Magnum_SceneGraph_DepthPrepass_h
+#define Magnum_SceneGraph_DepthPrepass_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::DepthPrepass
+ */
+
+#include "Magnum/configure.h"
+
+#if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+#include <cstddef>
+#include <memory>
+
+#include "Magnum/Renderer.h"
+#include "Magnum/SceneGraph/SceneGraph.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation { class DepthPrepassShader; }
+
+/**
+@brief Depth pre-pass
+
+Draws a group of drawables in two passes to avoid overdraw with expensive
+fragment shaders. Drawables that have a depth mesh set using
+@ref Drawable::setDepthMesh() are first drawn into the depth buffer only,
+using the depth mesh and a trivial position-only shader. The drawables are
+then drawn again using their own @ref Drawable::draw() with depth writes
+disabled and depth test set to @ref depthFunction(), so only the front-most
+fragment of each pixel is shaded.
+
+@code
+SceneGraph::DepthPrepass prepass;
+
+Mesh depthMesh;
+std::unique_ptr<Buffer> depthVertices, depthIndices;
+std::tie(depthMesh, depthVertices, depthIndices) = MeshTools::compile(
+    Trade::MeshData3D{data.primitive(), data.indices(), {data.positions(0)}, {}, {}, {}},
+    BufferUsage::StaticDraw);
+(new Statue(&scene, &opaqueDrawables))->setDepthMesh(&depthMesh);
+
+// ...
+
+void MyApplication::drawEvent() {
+    prepass.draw(*camera, opaqueDrawables);
+
+    Renderer::enable(Renderer::Feature::Blending);
+    camera->draw(transparentDrawables);
+    Renderer::disable(Renderer::Feature::Blending);
+
+    // ...
+}
+@endcode
+
+The depth shader reads only the @ref Shaders::Generic3D::Position attribute,
+so the drawable's own mesh can be used as well. A separate position-only mesh
+compiled from positions and indices, as above, is however more cache friendly.
+The pre-pass is meant for opaque drawables only, draw transparent drawables
+with @ref Camera::draw() afterwards. Whether a group is drawn with the
+pre-pass is decided by which groups are passed to @ref draw(), the pre-pass
+can also be temporarily turned off using @ref setEnabled() to compare
+performance.
+
+Drawables without a depth mesh are drawn after the color pass with depth
+writes enabled and @ref Renderer::DepthFunction::Less, which is also the
+state left after @ref draw() returns.
+
+The depth-only pass is marked with @ref Instrumentation::Zone::DepthPrepass,
+nested in @ref Instrumentation::Zone::CameraDraw, so with
+@ref DebugTools::Profiler::setInstrumentationEnabled() and
+@ref DebugTools::Profiler::setGpuProfilingEnabled() enabled the GPU time of
+both passes is measured separately.
+
+## Depth precision
+
+With the default @ref Renderer::DepthFunction::Equal the depth produced by
+the color pass has to be bit-exact with the pre-pass. The depth shader
+computes the position as `projectionMatrix*(transformationMatrix*position)`,
+the same way as @ref Shaders::Phong does. Shaders that use a combined
+transformation and projection matrix (such as @ref Shaders::Flat) may
+produce slightly different values on some drivers, use
+@ref Renderer::DepthFunction::LessOrEqual in that case.
+
+@requires_gles30 The depth pre-pass is not available in WebGL 1.0.
+*/
+class MAGNUM_SCENEGRAPH_EXPORT DepthPrepass {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Compiles the depth-only shader.
+         */
+        explicit DepthPrepass();
+
+        /** @brief Copying is not allowed */
+        DepthPrepass(const DepthPrepass&) = delete;
+
+        /** @brief Move constructor */
+        DepthPrepass(DepthPrepass&&) noexcept;
+
+        ~DepthPrepass();
+
+        /** @brief Copying is not allowed */
+        DepthPrepass& operator=(const DepthPrepass&) = delete;
+
+        /** @brief Move assignment */
+        DepthPrepass& operator=(DepthPrepass&&) noexcept;
+
+        /** @brief Whether the pre-pass is enabled */
+        bool isEnabled() const { return _enabled; }
+
+        /**
+         * @brief Enable or disable the pre-pass
+         * @return Reference to self (for method chaining)
+         *
+         * If disabled, @ref draw() draws the group in a single pass, the
+         * same as @ref Camera::draw(). Enabled by default.
+         */
+        DepthPrepass& setEnabled(bool enabled) {
+            _enabled = enabled;
+            return *this;
+        }
+
+        /** @brief Depth function used in the color pass */
+        Renderer::DepthFunction depthFunction() const { return _depthFunction; }
+
+        /**
+         * @brief Set depth function used in the color pass
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @ref Renderer::DepthFunction::Equal. See the
+         * @ref DepthPrepass "class documentation" for when
+         * @ref Renderer::DepthFunction::LessOrEqual is needed.
+         */
+        DepthPrepass& setDepthFunction(Renderer::DepthFunction function) {
+            _depthFunction = function;
+            return *this;
+        }
+
+        /**
+         * @brief Draw given group of drawables
+         * @return Count of drawables drawn in the depth pre-pass
+         *
+         * Expects that the camera is part of a scene and that depth test is
+         * enabled. See the @ref DepthPrepass "class documentation" for more
+         * information.
+         */
+        std::size_t draw(Camera3D& camera, DrawableGroup3D& group);
+
+    private:
+        std::unique_ptr<Implementation::DepthPrepassShader> _shader;
+        Renderer::DepthFunction _depthFunction;
+        bool _enabled;
+};
+
+}}
+#else
+#error this header is not available in WebGL 1.0 build
+#endif
+
+#endif
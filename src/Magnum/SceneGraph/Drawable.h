@@ -29,6 +29,8 @@
  * @brief Class @ref Magnum::SceneGraph::Drawable, @ref Magnum::SceneGraph::DrawableGroup, alias @ref Magnum::SceneGraph::BasicDrawable2D, @ref Magnum::SceneGraph::BasicDrawable3D, @ref Magnum::SceneGraph::BasicDrawableGroup2D, @ref Magnum::SceneGraph::BasicDrawableGroup3D, typedef @ref Magnum::SceneGraph::Drawable2D, @ref Magnum::SceneGraph::Drawable3D, @ref Magnum::SceneGraph::DrawableGroup2D, @ref Magnum::SceneGraph::DrawableGroup3D
  */
 
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Math/Range.h"
 #include "Magnum/SceneGraph/AbstractGroupedFeature.h"
 
 namespace Magnum { namespace SceneGraph {
@@ -155,6 +157,38 @@ void MyApplication::drawEvent() {
 }
 @endcode
 
+Alternatively, submit the drawables to a @ref RenderQueue, which sorts them
+by shader, material and mesh and draws the transparent ones back to front
+after all opaque ones.
+
+## Frustum culling
+
+Drawables can have an optional bounding box in object-local coordinates set
+using @ref setBoundingBox(). Drawing the group with @ref Camera::drawCulled()
+then skips all drawables whose bounding box lies completely outside of the
+camera frustum. Drawables without bounding box are always drawn. The bounding
+box is also used by @ref OcclusionCulling to skip drawables hidden behind other
+geometry.
+@code
+(new RedCube(&scene, &drawables))
+    ->setBoundingBox({Vector3{-1.0f}, Vector3{1.0f}});
+
+// ...
+
+void MyApplication::drawEvent() {
+    std::size_t culled = camera->drawCulled(drawables);
+
+    // ...
+}
+@endcode
+
+## Depth pre-pass
+
+Drawables with expensive fragment shading can have a position-only mesh set
+using @ref setDepthMesh(). Drawing the group with @ref DepthPrepass::draw()
+then first fills the depth buffer using just these meshes and a trivial
+shader, so the subsequent color pass shades each pixel only once.
+
 ## Explicit template specializations
 
 The following specializations are explicitly compiled into @ref SceneGraph
@@ -194,6 +228,72 @@ template<UnsignedInt dimensions, class T> class Drawable: public AbstractGrouped
             return AbstractGroupedFeature<dimensions, Drawable<dimensions, T>, T>::group();
         }
 
+        /**
+         * @brief Whether the drawable has a bounding box
+         *
+         * @see @ref setBoundingBox()
+         */
+        bool hasBoundingBox() const { return _hasBoundingBox; }
+
+        /**
+         * @brief Bounding box
+         *
+         * In object-local coordinates. If the drawable doesn't have any
+         * bounding box, returns empty range.
+         * @see @ref hasBoundingBox(), @ref setBoundingBox()
+         */
+        RangeTypeFor<dimensions, T> boundingBox() const { return _boundingBox; }
+
+        /**
+         * @brief Set bounding box
+         * @return Reference to self (for method chaining)
+         *
+         * The box is in object-local coordinates and is used for frustum
+         * culling in @ref Camera::drawCulled().
+         */
+        Drawable<dimensions, T>& setBoundingBox(const RangeTypeFor<dimensions, T>& box) {
+            _boundingBox = box;
+            _hasBoundingBox = true;
+            return *this;
+        }
+
+        /**
+         * @brief Reset bounding box
+         * @return Reference to self (for method chaining)
+         *
+         * The drawable will be always drawn by @ref Camera::drawCulled().
+         */
+        Drawable<dimensions, T>& resetBoundingBox() {
+            _boundingBox = {};
+            _hasBoundingBox = false;
+            return *this;
+        }
+
+        /**
+         * @brief Mesh used in the depth pre-pass
+         *
+         * If the drawable doesn't have any, returns `nullptr`.
+         * @see @ref setDepthMesh()
+         */
+        Mesh* depthMesh() const { return _depthMesh; }
+
+        /**
+         * @brief Set mesh used in the depth pre-pass
+         * @return Reference to self (for method chaining)
+         *
+         * The mesh is expected to have positions bound to
+         * @ref Shaders::Generic::Position and to produce exactly the same
+         * geometry as @ref draw(). It's used by @ref DepthPrepass::draw() to
+         * fill the depth buffer before the color pass. Drawables without a
+         * depth mesh are drawn after all others with the usual depth test.
+         * Pass `nullptr` to reset the mesh. The mesh is expected to stay
+         * alive for the whole lifetime of the drawable or until reset.
+         */
+        Drawable<dimensions, T>& setDepthMesh(Mesh* mesh) {
+            _depthMesh = mesh;
+            return *this;
+        }
+
         /**
          * @brief Draw the object using given camera
          * @param transformationMatrix  Object transformation relative to camera
@@ -203,6 +303,11 @@ template<UnsignedInt dimensions, class T> class Drawable: public AbstractGrouped
          * @ref SceneGraph::Camera::projectionMatrix() "Camera::projectionMatrix()".
          */
         virtual void draw(const MatrixTypeFor<dimensions, T>& transformationMatrix, Camera<dimensions, T>& camera) = 0;
+
+    private:
+        RangeTypeFor<dimensions, T> _boundingBox;
+        Mesh* _depthMesh;
+        bool _hasBoundingBox;
 };
 
 /**
@@ -273,6 +273,8 @@ template<class T> struct Transformation<BasicDualComplexTransformation<T>> {
     }
 };
 
+template<class T> struct TransformationMatrix<BasicDualComplexTransformation<T>>: AffineTransformationMatrix<BasicDualComplexTransformation<T>> {};
+
 }
 
 #if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
@@ -348,6 +348,8 @@ template<class T> struct Transformation<BasicDualQuaternionTransformation<T>> {
     }
 };
 
+template<class T> struct TransformationMatrix<BasicDualQuaternionTransformation<T>>: AffineTransformationMatrix<BasicDualQuaternionTransformation<T>> {};
+
 }
 
 #if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
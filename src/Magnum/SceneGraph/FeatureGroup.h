@@ -84,6 +84,20 @@ template<UnsignedInt dimensions, class Feature, class T> class FeatureGroup: pub
             return AbstractFeatureGroup<dimensions, T>::features.size();
         }
 
+        /**
+         * @brief Reserve memory for given count of features
+         * @return Reference to self (for method chaining)
+         *
+         * Features are stored in a contiguous array, reserving it upfront
+         * avoids reallocations when adding many features at once, for
+         * example when spawning a lot of objects in a single frame.
+         * @see @ref Pooled
+         */
+        FeatureGroup<dimensions, Feature, T>& reserve(std::size_t capacity) {
+            AbstractFeatureGroup<dimensions, T>::features.reserve(capacity);
+            return *this;
+        }
+
         /** @brief Feature at given index */
         Feature& operator[](std::size_t index) {
             return static_cast<Feature&>(AbstractFeatureGroup<dimensions, T>::features[index].get());
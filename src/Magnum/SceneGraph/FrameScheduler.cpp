@@ -0,0 +1,175 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FrameScheduler.h"
+
+#include <algorithm>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Timeline.h"
+#include "Magnum/SceneGraph/AbstractJobSystem.h"
+
+namespace Magnum { namespace SceneGraph {
+
+FrameScheduler::FrameScheduler(AbstractJobSystem& jobSystem): _jobSystem(jobSystem) {}
+
+FrameScheduler::~FrameScheduler() {
+    if(!_thread.joinable()) return;
+
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _quit = true;
+    }
+    _wake.notify_one();
+    _thread.join();
+}
+
+UnsignedInt FrameScheduler::addTask(const Stage stage, std::function<void(const Frame&)> task, const std::initializer_list<UnsignedInt> dependencies) {
+    /* Dependencies are always on earlier tasks, so the wave of each task is
+       known right away and there can't be any cycles */
+    UnsignedInt wave = 0;
+    for(const UnsignedInt dependency: dependencies) {
+        CORRADE_ASSERT(dependency < _tasks.size(),
+            "SceneGraph::FrameScheduler::addTask(): dependency" << dependency << "out of range for" << _tasks.size() << "tasks", {});
+        const Task& other = _tasks[dependency];
+        CORRADE_ASSERT(stage == Stage::Submit || other.stage == Stage::Update,
+            "SceneGraph::FrameScheduler::addTask(): update task can't depend on submit task" << dependency, {});
+        if(other.stage == stage) wave = std::max(wave, other.wave + 1);
+    }
+
+    _tasks.push_back(Task{std::move(task), stage, wave});
+    _dirty = true;
+    return _tasks.size() - 1;
+}
+
+FrameScheduler& FrameScheduler::setPipelined(const bool enabled) {
+    if(!enabled) flush();
+    _pipelined = enabled;
+    return *this;
+}
+
+void FrameScheduler::frame(const Timeline& timeline) {
+    frame(timeline.previousFrameTime(), timeline.previousFrameDuration());
+}
+
+void FrameScheduler::frame(const Float time, const Float duration) {
+    /* Sort the tasks into waves if they changed. Submit tasks are executed
+       in the order they were added, which satisfies the dependencies. */
+    if(_dirty) {
+        _updateTasks.clear();
+        _submitTasks.clear();
+        _waveOffsets.assign(1, 0);
+        for(std::size_t i = 0; i != _tasks.size(); ++i) {
+            const Task& task = _tasks[i];
+            if(task.stage == Stage::Submit) {
+                _submitTasks.push_back(i);
+                continue;
+            }
+
+            _updateTasks.push_back(i);
+            if(task.wave + 2 > _waveOffsets.size())
+                _waveOffsets.resize(task.wave + 2, 0);
+            ++_waveOffsets[task.wave + 1];
+        }
+
+        for(std::size_t i = 1; i != _waveOffsets.size(); ++i)
+            _waveOffsets[i] += _waveOffsets[i - 1];
+        std::stable_sort(_updateTasks.begin(), _updateTasks.end(), [this](UnsignedInt a, UnsignedInt b) {
+            return _tasks[a].wave < _tasks[b].wave;
+        });
+
+        _dirty = false;
+    }
+
+    const Frame current{_frameCount++, time, duration};
+
+    if(!_pipelined) {
+        update(current);
+        submit(current);
+        return;
+    }
+
+    /* Start the helper thread on first use */
+    if(!_thread.joinable()) _thread = std::thread{&FrameScheduler::work, this};
+
+    /* Update this frame on the helper thread while submitting the previous
+       one here */
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _pendingUpdate = current;
+        _hasPendingUpdate = true;
+    }
+    _wake.notify_one();
+
+    flush();
+
+    {
+        std::unique_lock<std::mutex> lock{_mutex};
+        _done.wait(lock, [this]() { return !_hasPendingUpdate; });
+    }
+
+    _pendingSubmit = current;
+    _hasPendingSubmit = true;
+}
+
+void FrameScheduler::flush() {
+    if(!_hasPendingSubmit) return;
+
+    _hasPendingSubmit = false;
+    submit(_pendingSubmit);
+}
+
+void FrameScheduler::update(const Frame& frame) {
+    for(std::size_t wave = 0; wave + 1 < _waveOffsets.size(); ++wave) {
+        const UnsignedInt* tasks = _updateTasks.data() + _waveOffsets[wave];
+        _jobSystem.run(_waveOffsets[wave + 1] - _waveOffsets[wave], [&](std::size_t i) {
+            _tasks[tasks[i]].function(frame);
+        });
+    }
+}
+
+void FrameScheduler::submit(const Frame& frame) {
+    for(const UnsignedInt task: _submitTasks)
+        _tasks[task].function(frame);
+}
+
+void FrameScheduler::work() {
+    std::unique_lock<std::mutex> lock{_mutex};
+    for(;;) {
+        _wake.wait(lock, [this]() { return _quit || _hasPendingUpdate; });
+        if(_quit) return;
+
+        /* The frame and the task list don't change until the update is
+           done, so they can be accessed without the lock */
+        lock.unlock();
+        update(_pendingUpdate);
+        lock.lock();
+
+        _hasPendingUpdate = false;
+        _done.notify_one();
+    }
+}
+
+}}
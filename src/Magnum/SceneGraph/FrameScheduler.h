@@ -0,0 +1,274 @@
+#ifndef Magnum_SceneGraph_FrameScheduler_h
+#define Magnum_SceneGraph_FrameScheduler_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::FrameScheduler
+ */
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <Corrade/configure.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/SceneGraph/SceneGraph.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Frame task scheduler
+
+Executes per-frame work registered as a graph of tasks with dependencies. The
+tasks are split into two stages. @ref Stage::Update tasks, such as animation,
+transformation computation, culling or render queue building, are executed on
+an @ref AbstractJobSystem. Tasks that don't depend on each other run in
+parallel. @ref Stage::Submit tasks, such as issuing the GL draw calls, are
+executed in order on the thread calling @ref frame(), which is expected to be
+the thread owning the GL context.
+@code
+SceneGraph::ThreadPool pool;
+SceneGraph::FrameScheduler scheduler{pool};
+
+MyApplication::MyApplication(const Arguments& arguments): Platform::Application{arguments} {
+    UnsignedInt animation = scheduler.addTask(SceneGraph::FrameScheduler::Stage::Update,
+        [&](const SceneGraph::FrameScheduler::Frame& frame) {
+            animables.step(frame.time, frame.duration);
+        });
+    UnsignedInt culling = scheduler.addTask(SceneGraph::FrameScheduler::Stage::Update,
+        [&](const SceneGraph::FrameScheduler::Frame& frame) {
+            renderQueues[frame.index % 2].clear();
+            // cull and fill the render queue
+        }, {animation});
+    scheduler.addTask(SceneGraph::FrameScheduler::Stage::Submit,
+        [&](const SceneGraph::FrameScheduler::Frame& frame) {
+            renderQueues[frame.index % 2].draw(camera);
+        }, {culling});
+
+    timeline.start();
+}
+
+void MyApplication::drawEvent() {
+    defaultFramebuffer.clear(FramebufferClear::Color|FramebufferClear::Depth);
+
+    scheduler.frame(timeline);
+
+    swapBuffers();
+    timeline.nextFrame();
+    redraw();
+}
+@endcode
+
+Each task gets a @ref Frame with the frame index and with time and frame
+duration captured when @ref frame() was called, so both stages of the same
+frame see consistent values even if they execute at different times.
+
+@anchor SceneGraph-FrameScheduler-pipelining
+## Pipelining
+
+By default, the update stage of frame @f$ N + 1 @f$ runs on a helper thread
+while the submit stage of frame @f$ N @f$ executes on the calling thread,
+adding one frame of latency. The first call to @ref frame() thus executes
+just the update stage and the last submit stage is executed by @ref flush().
+Data written by the update stage and consumed by the submit stage have to be
+double-buffered, for example indexed by @ref Frame::index modulo two as in
+the example above. Use @ref setPipelined() to execute both stages of the
+frame one after another instead.
+
+## Task dependencies
+
+A task can depend only on tasks added before it, which makes cycles
+impossible. @ref Stage::Submit tasks can depend on both stages,
+@ref Stage::Update tasks only on other @ref Stage::Update tasks. The update
+stage is executed in waves of tasks whose dependencies were already executed,
+each wave as one @ref AbstractJobSystem::run() call.
+
+@attention The job system is used from the helper thread while pipelining,
+    so it shouldn't be used from elsewhere during @ref frame().
+@partialsupport Not available on @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten".
+*/
+class MAGNUM_SCENEGRAPH_EXPORT FrameScheduler {
+    public:
+        /**
+         * @brief Task stage
+         *
+         * @see @ref addTask()
+         */
+        enum class Stage: UnsignedByte {
+            /** Executed on the job system, possibly in parallel */
+            Update,
+
+            /** Executed in order on the thread calling @ref frame() */
+            Submit
+        };
+
+        /**
+         * @brief Frame properties
+         *
+         * Passed to each task.
+         */
+        struct Frame {
+            /** @brief Frame index, starting from `0` */
+            std::uint64_t index;
+
+            /** @brief Frame time in seconds */
+            Float time;
+
+            /** @brief Frame duration in seconds */
+            Float duration;
+        };
+
+        /**
+         * @brief Constructor
+         *
+         * The job system is expected to be alive for whole scheduler
+         * lifetime. Pipelining is enabled by default.
+         */
+        explicit FrameScheduler(AbstractJobSystem& jobSystem);
+
+        /** @brief Copying is not allowed */
+        FrameScheduler(const FrameScheduler&) = delete;
+
+        /** @brief Moving is not allowed */
+        FrameScheduler(FrameScheduler&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Stops the helper thread. A pending submit stage is not executed,
+         * call @ref flush() before if needed.
+         */
+        ~FrameScheduler();
+
+        /** @brief Copying is not allowed */
+        FrameScheduler& operator=(const FrameScheduler&) = delete;
+
+        /** @brief Moving is not allowed */
+        FrameScheduler& operator=(FrameScheduler&&) = delete;
+
+        /** @brief Count of tasks */
+        std::size_t taskCount() const { return _tasks.size(); }
+
+        /**
+         * @brief Add task
+         * @param stage         Stage in which the task is executed
+         * @param task          Task function
+         * @param dependencies  IDs of tasks that need to finish before this
+         *      one
+         * @return Task ID
+         *
+         * Expects that all dependencies are IDs of already added tasks and
+         * that @ref Stage::Update tasks don't depend on @ref Stage::Submit
+         * tasks. Can't be called while @ref frame() is executing.
+         */
+        UnsignedInt addTask(Stage stage, std::function<void(const Frame&)> task, std::initializer_list<UnsignedInt> dependencies = {});
+
+        /** @brief Whether the stages are pipelined */
+        bool isPipelined() const { return _pipelined; }
+
+        /**
+         * @brief Enable or disable pipelining
+         * @return Reference to self (for method chaining)
+         *
+         * If a submit stage is pending when disabling pipelining, it's
+         * executed first. See @ref SceneGraph-FrameScheduler-pipelining for
+         * more information.
+         */
+        FrameScheduler& setPipelined(bool enabled);
+
+        /**
+         * @brief Execute a frame
+         * @param time      Frame time in seconds
+         * @param duration  Frame duration in seconds
+         *
+         * If pipelining is enabled, executes the update stage of this frame
+         * in parallel with the submit stage of the previous frame, otherwise
+         * executes both stages of this frame one after another. Returns after
+         * all executed tasks are finished.
+         */
+        void frame(Float time, Float duration);
+
+        /**
+         * @brief Execute a frame using timeline values
+         *
+         * Same as calling @ref frame(Float, Float) with
+         * @ref Timeline::previousFrameTime() and
+         * @ref Timeline::previousFrameDuration().
+         */
+        void frame(const Timeline& timeline);
+
+        /**
+         * @brief Execute pending submit stage
+         *
+         * If pipelining is enabled, executes the submit stage of the last
+         * frame. Does nothing if there's no stage pending.
+         */
+        void flush();
+
+        /** @brief Count of executed frames */
+        std::uint64_t frameCount() const { return _frameCount; }
+
+    private:
+        struct Task {
+            std::function<void(const Frame&)> function;
+            Stage stage;
+            UnsignedInt wave;
+        };
+
+        MAGNUM_SCENEGRAPH_LOCAL void update(const Frame& frame);
+        MAGNUM_SCENEGRAPH_LOCAL void submit(const Frame& frame);
+        MAGNUM_SCENEGRAPH_LOCAL void work();
+
+        AbstractJobSystem& _jobSystem;
+        std::vector<Task> _tasks;
+        /* Update tasks sorted by wave, with offsets of each wave */
+        std::vector<UnsignedInt> _updateTasks, _waveOffsets, _submitTasks;
+        bool _dirty{}, _pipelined{true};
+
+        std::uint64_t _frameCount{};
+        Frame _pendingSubmit;
+        bool _hasPendingSubmit{};
+
+        /* Helper thread executing the update stage while pipelining */
+        std::thread _thread;
+        std::mutex _mutex;
+        std::condition_variable _wake, _done;
+        Frame _pendingUpdate;
+        bool _hasPendingUpdate{}, _quit{};
+};
+
+}}
+#else
+#error this header is not available in Emscripten build
+#endif
+
+#endif
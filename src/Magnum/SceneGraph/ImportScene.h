@@ -0,0 +1,210 @@
+#ifndef Magnum_SceneGraph_ImportScene_h
+#define Magnum_SceneGraph_ImportScene_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::ImportedObject, function @ref Magnum::SceneGraph::importScene()
+ */
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/SceneGraph/Object.h"
+#include "Magnum/SceneGraph/Pool.h"
+#include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/ObjectData2D.h"
+#include "Magnum/Trade/ObjectData3D.h"
+#include "Magnum/Trade/SceneData.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Object created by @ref importScene()
+
+Remembers ID of the importer object it was created from and is allocated from
+a @ref Pooled "pool", so a whole imported hierarchy ends up in a few
+contiguous slabs of memory instead of one heap allocation per object.
+@see @ref importScene()
+*/
+template<class Transformation> class ImportedObject: public Object<Transformation>, public Pooled<ImportedObject<Transformation>> {
+    public:
+        /**
+         * @brief Constructor
+         * @param id        ID of the importer object
+         * @param parent    Parent object
+         */
+        explicit ImportedObject(UnsignedInt id, Object<Transformation>* parent = nullptr): Object<Transformation>{parent}, _id{id} {}
+
+        /** @brief ID of the importer object */
+        UnsignedInt id() const { return _id; }
+
+    private:
+        UnsignedInt _id;
+};
+
+namespace Implementation {
+    template<UnsignedInt> struct ImportedSceneTraits;
+    template<> struct ImportedSceneTraits<2> {
+        typedef Trade::ObjectData2D ObjectData;
+
+        static const std::vector<UnsignedInt>& children(const Trade::SceneData& scene) { return scene.children2D(); }
+        static UnsignedInt objectCount(const Trade::AbstractImporter& importer) { return importer.object2DCount(); }
+        static std::unique_ptr<ObjectData> object(Trade::AbstractImporter& importer, UnsignedInt id) { return importer.object2D(id); }
+    };
+    template<> struct ImportedSceneTraits<3> {
+        typedef Trade::ObjectData3D ObjectData;
+
+        static const std::vector<UnsignedInt>& children(const Trade::SceneData& scene) { return scene.children3D(); }
+        static UnsignedInt objectCount(const Trade::AbstractImporter& importer) { return importer.object3DCount(); }
+        static std::unique_ptr<ObjectData> object(Trade::AbstractImporter& importer, UnsignedInt id) { return importer.object3D(id); }
+    };
+
+    /* Not deducible, so lambdas can be passed directly */
+    template<class Transformation> struct ImportedSceneInstantiator {
+        typedef std::function<void(ImportedObject<Transformation>&, const typename ImportedSceneTraits<Transformation::Dimensions>::ObjectData&)> Type;
+    };
+}
+
+/**
+@brief Import a scene hierarchy
+@param importer         Opened importer
+@param scene            Scene data imported from @p importer
+@param parent           Parent object for top-level objects of the scene
+@param instantiator     Function called for each created object, for
+    example to attach drawables for @ref Trade::MeshObjectData3D "mesh objects".
+    Can be empty.
+@return Created objects, parents always preceding their children, or empty
+    vector if importing any of the objects failed
+
+Creates an @ref ImportedObject for each 2D or 3D object referenced by
+@p scene, depending on dimension count of @p Transformation, and sets its
+transformation from @ref Trade::ObjectData3D::transformation(). The whole
+hierarchy is loaded from the importer first and validated, so a failure
+doesn't leave a partially instantiated scene behind. After that, the object
+@ref Pooled "pool" is reserved for all objects at once, each object is
+created already marked as dirty, so neither setting its parent nor its
+transformation needs to propagate anything to children and features, and
+finally all objects are cleaned in a single
+@ref Object::setClean(std::vector<std::reference_wrapper<Object<Transformation>>>) "batch setClean()"
+call, if @p parent is part of a scene. Compared to creating the objects and
+setting their transformations one by one, the cost per object is just one
+pool slot and one pass over the hierarchy.
+
+@code
+std::optional<Trade::SceneData> sceneData = importer.scene(importer.defaultScene());
+std::vector<SceneGraph::ImportedObject<SceneGraph::MatrixTransformation3D>*> objects = SceneGraph::importScene(importer, *sceneData, scene,
+    [&](SceneGraph::ImportedObject<SceneGraph::MatrixTransformation3D>& object, const Trade::ObjectData3D& data) {
+        if(data.instanceType() == Trade::ObjectInstanceType3D::Mesh)
+            new ColoredDrawable{object, meshes[data.instance()], drawables};
+    });
+@endcode
+
+Objects referenced more than once in the hierarchy or with ID out of range
+are treated as an import failure. The objects are owned by @p parent as
+usual and are deleted together with it.
+*/
+template<class Transformation> std::vector<ImportedObject<Transformation>*> importScene(Trade::AbstractImporter& importer, const Trade::SceneData& scene, Object<Transformation>& parent, const typename Implementation::ImportedSceneInstantiator<Transformation>::Type& instantiator = nullptr) {
+    typedef Implementation::ImportedSceneTraits<Transformation::Dimensions> Traits;
+    typedef typename Traits::ObjectData ObjectData;
+
+    const UnsignedInt objectCount = Traits::objectCount(importer);
+
+    /* Load the whole hierarchy first, in depth-first order so parents are
+       always before their children. Each entry remembers its parent
+       position in the list, NoParent for top-level objects. */
+    constexpr std::size_t NoParent = ~std::size_t{};
+    std::vector<std::unique_ptr<ObjectData>> data;
+    std::vector<UnsignedInt> ids;
+    std::vector<std::size_t> parents;
+    std::vector<bool> visited(objectCount);
+    std::vector<std::pair<UnsignedInt, std::size_t>> stack;
+    for(auto it = Traits::children(scene).rbegin(); it != Traits::children(scene).rend(); ++it)
+        stack.emplace_back(*it, NoParent);
+    while(!stack.empty()) {
+        const UnsignedInt id = stack.back().first;
+        const std::size_t parentIndex = stack.back().second;
+        stack.pop_back();
+
+        if(id >= objectCount) {
+            Error() << "SceneGraph::importScene(): object ID" << id << "out of range for" << objectCount << "objects";
+            return {};
+        }
+        if(visited[id]) {
+            Error() << "SceneGraph::importScene(): object" << id << "is referenced more than once";
+            return {};
+        }
+        visited[id] = true;
+
+        std::unique_ptr<ObjectData> object = Traits::object(importer, id);
+        if(!object) {
+            Error() << "SceneGraph::importScene(): cannot import object" << id;
+            return {};
+        }
+
+        const std::size_t index = data.size();
+        for(auto child = object->children().rbegin(); child != object->children().rend(); ++child)
+            stack.emplace_back(*child, index);
+        data.push_back(std::move(object));
+        ids.push_back(id);
+        parents.push_back(parentIndex);
+    }
+
+    /* Reserve the pool for everything at once and create the objects. These
+       are marked as dirty on construction, so setting the parent and the
+       transformation doesn't propagate anything further. */
+    ImportedObject<Transformation>::pool().reserve(data.size());
+    std::vector<ImportedObject<Transformation>*> objects;
+    objects.reserve(data.size());
+    for(std::size_t i = 0; i != data.size(); ++i) {
+        Object<Transformation>* const objectParent = parents[i] == NoParent ? &parent : objects[parents[i]];
+        auto* const object = new ImportedObject<Transformation>{ids[i], objectParent};
+        object->Transformation::setTransformation(Implementation::Transformation<Transformation>::fromMatrix(MatrixTypeFor<Transformation::Dimensions, typename Transformation::Type>{data[i]->transformation()}));
+        objects.push_back(object);
+    }
+
+    /* Attach features only after the whole hierarchy is in place, so the
+       instantiator can look at parents */
+    if(instantiator) for(std::size_t i = 0; i != objects.size(); ++i)
+        instantiator(*objects[i], *data[i]);
+
+    /* Compute all absolute transformations in one go */
+    if(parent.scene()) {
+        std::vector<std::reference_wrapper<Object<Transformation>>> clean;
+        clean.reserve(objects.size());
+        for(ImportedObject<Transformation>* object: objects) clean.push_back(*object);
+        Object<Transformation>::setClean(std::move(clean));
+    }
+
+    return objects;
+}
+
+}}
+
+#endif
@@ -0,0 +1,370 @@
+#ifndef Magnum_SceneGraph_InstancedDrawable_h
+#define Magnum_SceneGraph_InstancedDrawable_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::InstancedDrawable, @ref Magnum::SceneGraph::InstancedDrawableGroup, alias @ref Magnum::SceneGraph::BasicInstancedDrawable2D, @ref Magnum::SceneGraph::BasicInstancedDrawable3D, @ref Magnum::SceneGraph::BasicInstancedDrawableGroup2D, @ref Magnum::SceneGraph::BasicInstancedDrawableGroup3D, typedef @ref Magnum::SceneGraph::InstancedDrawable2D, @ref Magnum::SceneGraph::InstancedDrawable3D, @ref Magnum::SceneGraph::InstancedDrawableGroup2D, @ref Magnum::SceneGraph::InstancedDrawableGroup3D
+ */
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/SceneGraph/AbstractGroupedFeature.h"
+#include "Magnum/SceneGraph/FeatureGroup.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation {
+    template<UnsignedInt> struct InstancedDrawableData;
+    template<> struct InstancedDrawableData<2> {
+        Matrix3 transformationMatrix;
+    };
+    template<> struct InstancedDrawableData<3> {
+        Matrix4 transformationMatrix;
+        Matrix3x3 normalMatrix;
+    };
+}
+
+/**
+@brief Instanced drawable
+
+Opt-in alternative to @ref Drawable for many objects that are drawn with the
+same mesh and shader. Instead of implementing a @ref Drawable::draw() function
+that sets the transformation and draws the mesh for every object separately,
+the feature only references the mesh, the shader and a material ID. All
+drawables in an @ref InstancedDrawableGroup that share the same mesh, shader
+and material are then drawn with a single instanced draw call.
+
+## Usage
+
+The shader is expected to read the per-instance transformation from the
+generic @ref Shaders::Generic::TransformationMatrix "TransformationMatrix"
+attribute and in 3D also the @ref Shaders::Generic::NormalMatrix "NormalMatrix"
+attribute, for example the builtin shaders with an `InstancedTransformation`
+flag. The matrices are relative to the camera, so the projection matrix is all
+that's needed to be set in the draw callback, together with any uniforms
+described by the material ID:
+@code
+Mesh cube;
+Shaders::Phong shader{Shaders::Phong::Flag::InstancedTransformation};
+
+SceneGraph::InstancedDrawableGroup3D drawables{
+    [&](AbstractShaderProgram& shader, UnsignedInt material, SceneGraph::Camera3D& camera) {
+        static_cast<Shaders::Phong&>(shader)
+            .setTransformationMatrix({})
+            .setNormalMatrix({})
+            .setProjectionMatrix(camera.projectionMatrix())
+            .setDiffuseColor(materials[material].color);
+    }};
+
+for(Object3D* crate: crates)
+    new SceneGraph::InstancedDrawable3D{*crate, cube, shader, crateMaterialId, &drawables};
+
+void MyApplication::drawEvent() {
+    drawables.draw(*camera);
+
+    // ...
+}
+@endcode
+
+The transformations of all drawables in the group are calculated at once, the
+same way as in @ref Camera::draw(). Existing per-object transformations of
+other features are not affected in any way, an object can have a
+@ref Drawable and an @ref InstancedDrawable at the same time.
+
+The feature doesn't own the mesh nor the shader, they are expected to stay
+alive for the whole lifetime of the feature. See @ref InstancedDrawableGroup
+for more information about the instance buffers.
+
+## Explicit template specializations
+
+The following specializations are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type) you have to use @ref InstancedDrawable.hpp implementation file to avoid
+linker errors. See also @ref compilation-speedup-hpp for more information.
+
+-   @ref InstancedDrawable2D
+-   @ref InstancedDrawable3D
+
+@see @ref scenegraph, @ref BasicInstancedDrawable2D,
+    @ref BasicInstancedDrawable3D, @ref InstancedDrawable2D,
+    @ref InstancedDrawable3D, @ref RenderQueue
+*/
+template<UnsignedInt dimensions, class T> class InstancedDrawable: public AbstractGroupedFeature<dimensions, InstancedDrawable<dimensions, T>, T> {
+    public:
+        /**
+         * @brief Constructor
+         * @param object    Object this drawable belongs to
+         * @param mesh      Mesh to draw
+         * @param shader    Shader to draw the mesh with
+         * @param material  Material ID, passed to the draw callback
+         * @param drawables Group this drawable belongs to
+         *
+         * Adds the feature to the object and also to the group, if specified.
+         * Otherwise you can use @ref InstancedDrawableGroup::add().
+         */
+        explicit InstancedDrawable(AbstractObject<dimensions, T>& object, Mesh& mesh, AbstractShaderProgram& shader, UnsignedInt material = 0, InstancedDrawableGroup<dimensions, T>* drawables = nullptr);
+
+        /**
+         * @brief Group containing this drawable
+         *
+         * If the drawable doesn't belong to any group, returns `nullptr`.
+         */
+        InstancedDrawableGroup<dimensions, T>* drawables() {
+            return static_cast<InstancedDrawableGroup<dimensions, T>*>(AbstractGroupedFeature<dimensions, InstancedDrawable<dimensions, T>, T>::group());
+        }
+
+        /** @overload */
+        const InstancedDrawableGroup<dimensions, T>* drawables() const {
+            return static_cast<const InstancedDrawableGroup<dimensions, T>*>(AbstractGroupedFeature<dimensions, InstancedDrawable<dimensions, T>, T>::group());
+        }
+
+        /** @brief Mesh */
+        Mesh& mesh() const { return _mesh; }
+
+        /** @brief Shader */
+        AbstractShaderProgram& shader() const { return _shader; }
+
+        /** @brief Material ID */
+        UnsignedInt material() const { return _material; }
+
+        /**
+         * @brief Set material ID
+         * @return Reference to self (for method chaining)
+         */
+        InstancedDrawable<dimensions, T>& setMaterial(UnsignedInt material) {
+            _material = material;
+            return *this;
+        }
+
+    private:
+        Mesh& _mesh;
+        AbstractShaderProgram& _shader;
+        UnsignedInt _material;
+};
+
+/**
+@brief Instanced drawable for two-dimensional scenes
+
+Convenience alternative to `InstancedDrawable<2, T>`. See
+@ref InstancedDrawable for more information.
+@see @ref InstancedDrawable2D, @ref BasicInstancedDrawable3D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicInstancedDrawable2D = InstancedDrawable<2, T>;
+#endif
+
+/**
+@brief Instanced drawable for two-dimensional float scenes
+
+@see @ref InstancedDrawable3D
+*/
+typedef BasicInstancedDrawable2D<Float> InstancedDrawable2D;
+
+/**
+@brief Instanced drawable for three-dimensional scenes
+
+Convenience alternative to `InstancedDrawable<3, T>`. See
+@ref InstancedDrawable for more information.
+@see @ref InstancedDrawable3D, @ref BasicInstancedDrawable2D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicInstancedDrawable3D = InstancedDrawable<3, T>;
+#endif
+
+/**
+@brief Instanced drawable for three-dimensional float scenes
+
+@see @ref InstancedDrawable2D
+*/
+typedef BasicInstancedDrawable3D<Float> InstancedDrawable3D;
+
+/**
+@brief Group of instanced drawables
+
+On every @ref draw() the drawables are sorted by mesh, shader and material,
+keeping the group order among drawables with the same key. For each key the
+camera-relative transformations are uploaded into an instance buffer, the
+draw callback is called to set up the shader and the mesh is drawn once with
+@ref Mesh::setInstanceCount() "instance count" equal to the count of
+drawables sharing the key.
+
+There is one instance buffer for each mesh, created and attached to the mesh
+using @ref Mesh::addVertexBufferInstanced() the first time the mesh is drawn
+by the group. The mesh thus shouldn't have any other attributes at the
+instanced locations and shouldn't be drawn outside of the group. The
+instance count is left at the value of the last draw. The buffer contains
+@ref Matrix3 transformations in 2D and @ref Matrix4 transformations
+followed by @ref Matrix3x3 normal matrices in 3D. The normal matrix is the
+@ref Matrix4::rotationScaling() "rotation and scaling part" of the
+transformation, so the shader is expected to normalize the transformed
+normals if non-uniform scaling is used. Call @ref releaseInstanceBuffers() if
+any of the meshes used by the group was destroyed.
+
+See @ref InstancedDrawable for an usage example.
+@requires_gl33 Extension @extension{ARB,instanced_arrays}
+@requires_gles30 Extension @extension{ANGLE,instanced_arrays},
+    @extension{EXT,instanced_arrays} or @extension{NV,instanced_arrays}
+    in OpenGL ES 2.0.
+@requires_webgl20 Extension @webgl_extension{ANGLE,instanced_arrays} in WebGL
+    1.0.
+@see @ref scenegraph, @ref BasicInstancedDrawableGroup2D,
+    @ref BasicInstancedDrawableGroup3D, @ref InstancedDrawableGroup2D,
+    @ref InstancedDrawableGroup3D
+*/
+template<UnsignedInt dimensions, class T> class InstancedDrawableGroup: public FeatureGroup<dimensions, InstancedDrawable<dimensions, T>, T> {
+    public:
+        /**
+         * @brief Draw callback
+         *
+         * Called before drawing each set of instances with the shader,
+         * material ID and camera of the drawables. Expected to set the
+         * projection matrix and any other uniforms the shader needs.
+         */
+        typedef std::function<void(AbstractShaderProgram&, UnsignedInt, Camera<dimensions, T>&)> DrawCallback;
+
+        /**
+         * @brief Constructor
+         * @param callback  Draw callback
+         *
+         * No OpenGL objects are created until the first @ref draw().
+         */
+        explicit InstancedDrawableGroup(DrawCallback callback = nullptr);
+
+        /** @brief Copying is not allowed */
+        InstancedDrawableGroup(const InstancedDrawableGroup<dimensions, T>&) = delete;
+
+        ~InstancedDrawableGroup();
+
+        /** @brief Copying is not allowed */
+        InstancedDrawableGroup<dimensions, T>& operator=(const InstancedDrawableGroup<dimensions, T>&) = delete;
+
+        /** @brief Draw callback */
+        const DrawCallback& drawCallback() const { return _callback; }
+
+        /**
+         * @brief Set draw callback
+         * @return Reference to self (for method chaining)
+         *
+         * If no callback is set, the shader is used with whatever uniforms
+         * were set on it before.
+         */
+        InstancedDrawableGroup<dimensions, T>& setDrawCallback(DrawCallback callback) {
+            _callback = std::move(callback);
+            return *this;
+        }
+
+        /**
+         * @brief Count of instance buffers
+         *
+         * Equal to count of distinct meshes drawn by the group since the
+         * last @ref releaseInstanceBuffers().
+         */
+        std::size_t instanceBufferCount() const { return _instanceBuffers.size(); }
+
+        /**
+         * @brief Release all instance buffers
+         * @return Reference to self (for method chaining)
+         *
+         * The buffers are recreated and attached to the meshes again on the
+         * next @ref draw().
+         */
+        InstancedDrawableGroup<dimensions, T>& releaseInstanceBuffers() {
+            _instanceBuffers.clear();
+            return *this;
+        }
+
+        /**
+         * @brief Draw the group
+         * @return Count of issued instanced draw calls
+         *
+         * Expects that the camera is part of a scene. See the
+         * @ref InstancedDrawableGroup "class documentation" for more
+         * information.
+         */
+        std::size_t draw(Camera<dimensions, T>& camera);
+
+    private:
+        DrawCallback _callback;
+        std::unordered_map<Mesh*, Buffer> _instanceBuffers;
+
+        /* Kept between frames to avoid reallocations */
+        std::vector<UnsignedInt> _indices;
+        std::vector<Implementation::InstancedDrawableData<dimensions>> _instanceData;
+};
+
+/**
+@brief Group of instanced drawables for two-dimensional scenes
+
+Convenience alternative to `InstancedDrawableGroup<2, T>`. See
+@ref InstancedDrawableGroup for more information.
+@see @ref InstancedDrawableGroup2D, @ref BasicInstancedDrawableGroup3D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicInstancedDrawableGroup2D = InstancedDrawableGroup<2, T>;
+#endif
+
+/**
+@brief Group of instanced drawables for two-dimensional float scenes
+
+@see @ref InstancedDrawableGroup3D
+*/
+typedef BasicInstancedDrawableGroup2D<Float> InstancedDrawableGroup2D;
+
+/**
+@brief Group of instanced drawables for three-dimensional scenes
+
+Convenience alternative to `InstancedDrawableGroup<3, T>`. See
+@ref InstancedDrawableGroup for more information.
+@see @ref InstancedDrawableGroup3D, @ref BasicInstancedDrawableGroup2D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicInstancedDrawableGroup3D = InstancedDrawableGroup<3, T>;
+#endif
+
+/**
+@brief Group of instanced drawables for three-dimensional float scenes
+
+@see @ref InstancedDrawableGroup2D
+*/
+typedef BasicInstancedDrawableGroup3D<Float> InstancedDrawableGroup3D;
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
+extern template class MAGNUM_SCENEGRAPH_EXPORT InstancedDrawable<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT InstancedDrawable<3, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT InstancedDrawableGroup<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT InstancedDrawableGroup<3, Float>;
+#endif
+
+}}
+
+#endif
@@ -0,0 +1,145 @@
+#ifndef Magnum_SceneGraph_InstancedDrawable_hpp
+#define Magnum_SceneGraph_InstancedDrawable_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref InstancedDrawable.h
+ */
+
+#include <algorithm>
+
+#include "Magnum/Attribute.h"
+#include "Magnum/Instrumentation.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/InstancedDrawable.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation {
+
+/* Locations matching Shaders::Generic::TransformationMatrix and
+   Shaders::Generic::NormalMatrix, the SceneGraph library doesn't depend on
+   Shaders */
+template<UnsignedInt dimensions> struct InstancedDrawableAttributes;
+template<> struct InstancedDrawableAttributes<2> {
+    template<class T> static void fill(InstancedDrawableData<2>& data, const Math::Matrix3<T>& transformation) {
+        data.transformationMatrix = Matrix3{transformation};
+    }
+
+    static void attach(Mesh& mesh, Buffer& buffer) {
+        mesh.addVertexBufferInstanced(buffer, 1, 0, Attribute<8, Matrix3>{});
+    }
+};
+template<> struct InstancedDrawableAttributes<3> {
+    template<class T> static void fill(InstancedDrawableData<3>& data, const Math::Matrix4<T>& transformation) {
+        data.transformationMatrix = Matrix4{transformation};
+        data.normalMatrix = data.transformationMatrix.rotationScaling();
+    }
+
+    static void attach(Mesh& mesh, Buffer& buffer) {
+        mesh.addVertexBufferInstanced(buffer, 1, 0, Attribute<8, Matrix4>{}, Attribute<12, Matrix3x3>{});
+    }
+};
+
+template<UnsignedInt dimensions, class T> inline bool instancedDrawableLess(const InstancedDrawable<dimensions, T>& a, const InstancedDrawable<dimensions, T>& b) {
+    if(&a.mesh() != &b.mesh()) return std::less<const Mesh*>{}(&a.mesh(), &b.mesh());
+    if(&a.shader() != &b.shader()) return std::less<const AbstractShaderProgram*>{}(&a.shader(), &b.shader());
+    return a.material() < b.material();
+}
+
+template<UnsignedInt dimensions, class T> inline bool instancedDrawableEqual(const InstancedDrawable<dimensions, T>& a, const InstancedDrawable<dimensions, T>& b) {
+    return &a.mesh() == &b.mesh() && &a.shader() == &b.shader() && a.material() == b.material();
+}
+
+}
+
+template<UnsignedInt dimensions, class T> InstancedDrawable<dimensions, T>::InstancedDrawable(AbstractObject<dimensions, T>& object, Mesh& mesh, AbstractShaderProgram& shader, const UnsignedInt material, InstancedDrawableGroup<dimensions, T>* const drawables): AbstractGroupedFeature<dimensions, InstancedDrawable<dimensions, T>, T>(object, drawables), _mesh(mesh), _shader(shader), _material{material} {}
+
+template<UnsignedInt dimensions, class T> InstancedDrawableGroup<dimensions, T>::InstancedDrawableGroup(DrawCallback callback): _callback{std::move(callback)} {}
+
+template<UnsignedInt dimensions, class T> InstancedDrawableGroup<dimensions, T>::~InstancedDrawableGroup() = default;
+
+template<UnsignedInt dimensions, class T> std::size_t InstancedDrawableGroup<dimensions, T>::draw(Camera<dimensions, T>& camera) {
+    AbstractObject<dimensions, T>* scene = camera.object().scene();
+    CORRADE_ASSERT(scene, "SceneGraph::InstancedDrawableGroup::draw(): cannot draw when camera is not part of any scene", {});
+
+    const std::size_t count = this->size();
+    if(!count) return 0;
+
+    MAGNUM_INSTRUMENT_ZONE(Instrumentation::Zone::CameraDraw);
+
+    /* Compute camera matrix */
+    camera.object().setClean();
+
+    /* Compute transformations of all drawables relative to the camera */
+    std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>> objects;
+    objects.reserve(count);
+    for(std::size_t i = 0; i != count; ++i)
+        objects.push_back((*this)[i].object());
+    std::vector<MatrixTypeFor<dimensions, T>> transformations =
+        scene->transformationMatrices(objects, camera.cameraMatrix());
+
+    /* Sort by mesh, shader and material, keeping the group order for
+       drawables with the same key */
+    _indices.resize(count);
+    for(std::size_t i = 0; i != count; ++i) _indices[i] = UnsignedInt(i);
+    std::stable_sort(_indices.begin(), _indices.end(), [this](UnsignedInt a, UnsignedInt b) {
+        return Implementation::instancedDrawableLess((*this)[a], (*this)[b]);
+    });
+
+    /* One instanced draw for each run of equal keys */
+    std::size_t drawCount = 0;
+    for(std::size_t begin = 0, end; begin != count; begin = end) {
+        InstancedDrawable<dimensions, T>& first = (*this)[_indices[begin]];
+        for(end = begin + 1; end != count && Implementation::instancedDrawableEqual(first, (*this)[_indices[end]]); ++end);
+
+        _instanceData.resize(end - begin);
+        for(std::size_t i = begin; i != end; ++i)
+            Implementation::InstancedDrawableAttributes<dimensions>::fill(_instanceData[i - begin], transformations[_indices[i]]);
+
+        /* Create the instance buffer and attach it to the mesh the first time
+           the mesh is drawn, orphan its previous contents every time */
+        Mesh& mesh = first.mesh();
+        auto found = _instanceBuffers.find(&mesh);
+        if(found == _instanceBuffers.end()) {
+            found = _instanceBuffers.emplace(&mesh, Buffer{}).first;
+            Implementation::InstancedDrawableAttributes<dimensions>::attach(mesh, found->second);
+        }
+        found->second.setData(_instanceData, BufferUsage::StreamDraw);
+
+        if(_callback) _callback(first.shader(), first.material(), camera);
+        mesh.setInstanceCount(Int(end - begin))
+            .draw(first.shader());
+        ++drawCount;
+    }
+
+    return drawCount;
+}
+
+}}
+
+#endif
@@ -0,0 +1,178 @@
+#ifndef Magnum_SceneGraph_KeyframeAnimable_h
+#define Magnum_SceneGraph_KeyframeAnimable_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::BasicKeyframeAnimable3D, typedef @ref Magnum::SceneGraph::KeyframeAnimable3D
+ */
+
+#include "Magnum/SceneGraph/AbstractTranslationRotationScaling3D.h"
+#include "Magnum/SceneGraph/Animable.h"
+#include "Magnum/SceneGraph/KeyframeTrack.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Keyframe-animated three-dimensional object
+
+@ref Animable driving transformation of an object using translation, rotation
+and scaling @ref KeyframeTrack "keyframe tracks". On every step the object
+transformation is reset and set to scaling, followed by rotation and
+translation evaluated at current animation time. Any of the tracks can be
+omitted, in which case the corresponding transformation is not applied.
+
+The tracks are only referenced, so they can be shared among any number of
+animables, and the animable itself stores just the track pointers and cursor
+hints. Animation duration is set to the longest of the tracks, use
+@ref setRepeated() to loop the animation.
+
+@code
+SceneGraph::KeyframeTrack3D walkTranslation{...};
+SceneGraph::KeyframeTrackQuaternion walkRotation{...};
+
+Object3D* character = new Object3D{&scene};
+auto* animable = new SceneGraph::KeyframeAnimable3D{*character, &animables};
+animable->setTracks(&walkTranslation, &walkRotation, nullptr)
+    .setRepeated(true)
+    .setState(SceneGraph::AnimationState::Running);
+@endcode
+
+The object is expected to have transformation implementing
+@ref AbstractBasicTranslationRotationScaling3D, such as
+@ref BasicMatrixTransformation3D "MatrixTransformation3D". Evaluating a step
+touches only the animable and its object, so it can be marked as thread-safe
+with @ref setThreadSafe() to be stepped in parallel.
+
+@see @ref KeyframeAnimable3D, @ref interpolate()
+*/
+template<class T> class BasicKeyframeAnimable3D: public Animable<3, T> {
+    public:
+        /**
+         * @brief Constructor
+         * @param object    Object this animable belongs to
+         * @param group     Group this animable belongs to
+         *
+         * Creates stopped animable without any tracks.
+         */
+        template<class Object> explicit BasicKeyframeAnimable3D(Object& object, AnimableGroup<3, T>* group = nullptr): Animable<3, T>{object, group}, _transformation(object) {}
+
+        /** @brief Translation track or `nullptr` if not set */
+        const KeyframeTrack<Math::Vector3<T>>* translationTrack() const { return _translation; }
+
+        /** @brief Rotation track or `nullptr` if not set */
+        const KeyframeTrack<Math::Quaternion<T>>* rotationTrack() const { return _rotation; }
+
+        /** @brief Scaling track or `nullptr` if not set */
+        const KeyframeTrack<Math::Vector3<T>>* scalingTrack() const { return _scaling; }
+
+        /**
+         * @brief Set tracks
+         * @return Reference to self (for method chaining)
+         *
+         * Any of the tracks can be `nullptr`. Resets cursor hints and sets
+         * animation duration to the longest of the tracks.
+         */
+        BasicKeyframeAnimable3D<T>& setTracks(const KeyframeTrack<Math::Vector3<T>>* translation, const KeyframeTrack<Math::Quaternion<T>>* rotation, const KeyframeTrack<Math::Vector3<T>>* scaling);
+
+        /* Overloads to remove WTF-factor from method chaining order */
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        BasicKeyframeAnimable3D<T>& setState(AnimationState state) {
+            Animable<3, T>::setState(state);
+            return *this;
+        }
+        BasicKeyframeAnimable3D<T>& setRepeated(bool repeated) {
+            Animable<3, T>::setRepeated(repeated);
+            return *this;
+        }
+        BasicKeyframeAnimable3D<T>& setRepeatCount(UnsignedShort count) {
+            Animable<3, T>::setRepeatCount(count);
+            return *this;
+        }
+        BasicKeyframeAnimable3D<T>& setThreadSafe(bool threadSafe) {
+            Animable<3, T>::setThreadSafe(threadSafe);
+            return *this;
+        }
+        #endif
+
+    protected:
+        /**
+         * @brief Evaluate the tracks
+         *
+         * Resets object transformation and applies scaling, rotation and
+         * translation evaluated at @p time.
+         */
+        void animationStep(Float time, Float delta) override;
+
+    private:
+        AbstractBasicTranslationRotationScaling3D<T>& _transformation;
+        const KeyframeTrack<Math::Vector3<T>>* _translation{};
+        const KeyframeTrack<Math::Quaternion<T>>* _rotation{};
+        const KeyframeTrack<Math::Vector3<T>>* _scaling{};
+        std::size_t _translationHint{}, _rotationHint{}, _scalingHint{};
+};
+
+/**
+@brief Keyframe-animated three-dimensional object with @ref Magnum::Float "Float" as underlying type
+
+@see @ref BasicKeyframeAnimable3D
+*/
+typedef BasicKeyframeAnimable3D<Float> KeyframeAnimable3D;
+
+template<class T> BasicKeyframeAnimable3D<T>& BasicKeyframeAnimable3D<T>::setTracks(const KeyframeTrack<Math::Vector3<T>>* translation, const KeyframeTrack<Math::Quaternion<T>>* rotation, const KeyframeTrack<Math::Vector3<T>>* scaling) {
+    _translation = translation;
+    _rotation = rotation;
+    _scaling = scaling;
+    _translationHint = _rotationHint = _scalingHint = 0;
+
+    Float duration = 0.0f;
+    if(translation) duration = Math::max(duration, translation->duration());
+    if(rotation) duration = Math::max(duration, rotation->duration());
+    if(scaling) duration = Math::max(duration, scaling->duration());
+    Animable<3, T>::setDuration(duration);
+    return *this;
+}
+
+template<class T> void BasicKeyframeAnimable3D<T>::animationStep(const Float time, Float) {
+    _transformation.resetTransformation();
+
+    if(_scaling && !_scaling->isEmpty())
+        _transformation.scale(_scaling->at(time, _scalingHint));
+
+    if(_rotation && !_rotation->isEmpty()) {
+        const Math::Quaternion<T> rotation = _rotation->at(time, _rotationHint).normalized();
+        /* Axis of identity rotation is undefined, skip it */
+        const Math::Rad<T> angle = rotation.angle();
+        if(angle != Math::Rad<T>{T(0)})
+            _transformation.rotate(angle, rotation.axis());
+    }
+
+    if(_translation && !_translation->isEmpty())
+        _transformation.translate(_translation->at(time, _translationHint));
+}
+
+}}
+
+#endif
@@ -0,0 +1,270 @@
+#ifndef Magnum_SceneGraph_KeyframeTrack_h
+#define Magnum_SceneGraph_KeyframeTrack_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::KeyframeTrack, function @ref Magnum::SceneGraph::interpolate()
+ */
+
+#include <algorithm>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/DualQuaternion.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Quaternion.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation {
+    template<class V> struct KeyframeInterpolator {
+        static V interpolate(const V& a, const V& b, Float t) {
+            return Math::lerp(a, b, t);
+        }
+    };
+
+    /* Shortest-path slerp -- q and -q describe the same rotation, so flip the
+       second keyframe if it lies in the opposite hemisphere */
+    template<class T> struct KeyframeInterpolator<Math::Quaternion<T>> {
+        static Math::Quaternion<T> interpolate(const Math::Quaternion<T>& a, const Math::Quaternion<T>& b, Float t) {
+            return Math::slerp(a, Math::dot(a, b) < T(0) ? -b : b, T(t));
+        }
+    };
+
+    template<class T> struct KeyframeInterpolator<Math::DualQuaternion<T>> {
+        static Math::DualQuaternion<T> interpolate(const Math::DualQuaternion<T>& a, const Math::DualQuaternion<T>& b, Float t) {
+            return Math::sclerp(a, b, T(t));
+        }
+    };
+}
+
+/**
+@brief Keyframe animation track
+
+Sequence of keyframe times and values, stored as two separate contiguous
+arrays so the key lookup touches only the times. Values between keyframes are
+interpolated using @ref Math::lerp() for vector types, shortest-path
+@ref Math::slerp() for @ref Math::Quaternion and @ref Math::sclerp() for
+@ref Math::DualQuaternion. Times before the first or after the last keyframe
+are clamped to the first or last value.
+
+The track itself is immutable and holds no playback state, so one track can be
+shared by any number of animated objects. Playback position is tracked by an
+external *hint* passed to @ref keyFor(Float, std::size_t&) const and
+@ref at(Float, std::size_t&) const --- when the time advances monotonically,
+the lookup is then constant instead of logarithmic. See
+@ref BasicKeyframeAnimable3D "KeyframeAnimable3D" for a ready-to-use
+@ref Animable driving object transformation and @ref interpolate() for
+evaluating many tracks at once.
+
+@see @ref KeyframeTrack3D
+*/
+template<class V> class KeyframeTrack {
+    public:
+        typedef V ValueType; /**< @brief Value type */
+
+        /**
+         * @brief Default constructor
+         *
+         * Creates a track with no keyframes. Such track can't be evaluated.
+         */
+        explicit KeyframeTrack() = default;
+
+        /**
+         * @brief Constructor
+         * @param keys      Keyframe times. Expected to be sorted.
+         * @param values    Keyframe values. Expected to have the same size
+         *      as @p keys.
+         */
+        explicit KeyframeTrack(std::vector<Float> keys, std::vector<V> values);
+
+        /** @brief Keyframe count */
+        std::size_t size() const { return _keys.size(); }
+
+        /** @brief Whether the track is empty */
+        bool isEmpty() const { return _keys.empty(); }
+
+        /** @brief Keyframe times */
+        const std::vector<Float>& keys() const { return _keys; }
+
+        /** @brief Keyframe values */
+        const std::vector<V>& values() const { return _values; }
+
+        /**
+         * @brief Track duration
+         *
+         * Time of the last keyframe or @cpp 0.0f @ce if the track is
+         * empty.
+         */
+        Float duration() const { return _keys.empty() ? 0.0f : _keys.back(); }
+
+        /**
+         * @brief Keyframe for given time
+         *
+         * Returns index of the keyframe which begins the interval
+         * containing @p time, clamped to the first and second-to-last
+         * keyframe. Uses binary search. Expects that the track is not
+         * empty.
+         */
+        std::size_t keyFor(Float time) const;
+
+        /**
+         * @brief Keyframe for given time using a cursor hint
+         *
+         * Same as above, but first checks whether @p time falls into the
+         * interval starting at @p hint or the one right after it and does
+         * the binary search only if not. The @p hint is updated to the
+         * returned value. Initialize it to @cpp 0 @ce.
+         */
+        std::size_t keyFor(Float time, std::size_t& hint) const;
+
+        /**
+         * @brief Interpolated value at given time
+         *
+         * Expects that the track is not empty.
+         */
+        V at(Float time) const {
+            std::size_t hint = 0;
+            return at(time, hint);
+        }
+
+        /**
+         * @brief Interpolated value at given time using a cursor hint
+         *
+         * See @ref keyFor(Float, std::size_t&) const for more information.
+         */
+        V at(Float time, std::size_t& hint) const;
+
+        /**
+         * @brief Interpolation factor between keyframes
+         *
+         * Returns position of @p time between keyframe @p key and the one
+         * following it in range @f$ [ 0 ; 1 ] @f$. Expects that @p key is
+         * a value returned from @ref keyFor().
+         */
+        Float factor(std::size_t key, Float time) const;
+
+    private:
+        std::vector<Float> _keys;
+        std::vector<V> _values;
+};
+
+/** @brief Three-dimensional translation or scaling track */
+typedef KeyframeTrack<Vector3> KeyframeTrack3D;
+
+/** @brief Rotation track */
+typedef KeyframeTrack<Quaternion> KeyframeTrackQuaternion;
+
+/** @brief Rigid transformation track */
+typedef KeyframeTrack<DualQuaternion> KeyframeTrackDualQuaternion;
+
+/** @relatesalso KeyframeTrack
+@brief Evaluate many tracks at once
+@param[in] tracks   Tracks to evaluate
+@param[in] time     Time at which to evaluate all tracks
+@param[in,out] hints Cursor hints for each track, see
+    @ref KeyframeTrack::keyFor(Float, std::size_t&) const
+@param[out] values  Where to put the interpolated values
+
+All views are expected to have the same size. The evaluation is done in two
+passes --- first a key and interpolation factor is found for all tracks, then
+all values are interpolated in a single tight loop over contiguous memory,
+which the compiler is able to vectorize for simple vector types. Useful when
+animating large crowds sharing the same time base.
+*/
+template<class V> void interpolate(Containers::ArrayView<const KeyframeTrack<V>* const> tracks, Float time, Containers::ArrayView<std::size_t> hints, Containers::ArrayView<V> values);
+
+template<class V> KeyframeTrack<V>::KeyframeTrack(std::vector<Float> keys, std::vector<V> values): _keys{std::move(keys)}, _values{std::move(values)} {
+    CORRADE_ASSERT(_keys.size() == _values.size(),
+        "SceneGraph::KeyframeTrack: expected the same count of keys and values, got" << _keys.size() << "and" << _values.size(), );
+    CORRADE_ASSERT(std::is_sorted(_keys.begin(), _keys.end()),
+        "SceneGraph::KeyframeTrack: keys are not sorted", );
+}
+
+template<class V> std::size_t KeyframeTrack<V>::keyFor(const Float time) const {
+    CORRADE_ASSERT(!_keys.empty(), "SceneGraph::KeyframeTrack::keyFor(): the track is empty", {});
+    if(_keys.size() < 2) return 0;
+
+    /* First key greater than time, the interval is the one before it */
+    const std::size_t upper = std::upper_bound(_keys.begin() + 1, _keys.end() - 1, time) - _keys.begin();
+    return upper - 1;
+}
+
+template<class V> std::size_t KeyframeTrack<V>::keyFor(const Float time, std::size_t& hint) const {
+    CORRADE_ASSERT(!_keys.empty(), "SceneGraph::KeyframeTrack::keyFor(): the track is empty", {});
+    if(_keys.size() < 2) return hint = 0;
+
+    /* Common case -- time advanced within the same or to the next interval */
+    const std::size_t last = _keys.size() - 2;
+    if(hint <= last) {
+        if((hint == 0 || time >= _keys[hint]) && (hint == last || time < _keys[hint + 1]))
+            return hint;
+        if(hint < last && time >= _keys[hint + 1] && (hint + 1 == last || time < _keys[hint + 2]))
+            return ++hint;
+    }
+
+    return hint = keyFor(time);
+}
+
+template<class V> Float KeyframeTrack<V>::factor(const std::size_t key, const Float time) const {
+    if(key + 1 >= _keys.size()) return 0.0f;
+    const Float begin = _keys[key];
+    const Float length = _keys[key + 1] - begin;
+    if(length <= 0.0f) return 0.0f;
+    return Math::clamp((time - begin)/length, 0.0f, 1.0f);
+}
+
+template<class V> V KeyframeTrack<V>::at(const Float time, std::size_t& hint) const {
+    const std::size_t key = keyFor(time, hint);
+    if(_keys.size() < 2) return _values.front();
+    return Implementation::KeyframeInterpolator<V>::interpolate(_values[key], _values[key + 1], factor(key, time));
+}
+
+template<class V> void interpolate(Containers::ArrayView<const KeyframeTrack<V>* const> tracks, const Float time, Containers::ArrayView<std::size_t> hints, Containers::ArrayView<V> values) {
+    CORRADE_ASSERT(tracks.size() == hints.size() && tracks.size() == values.size(),
+        "SceneGraph::interpolate(): expected views of the same size, got" << tracks.size() << hints.size() << "and" << values.size(), );
+
+    /* Key lookup. Single-key tracks are expressed as interpolating the only
+       value with itself, so the second pass has no special cases. */
+    std::vector<const V*> a(tracks.size()), b(tracks.size());
+    std::vector<Float> t(tracks.size());
+    for(std::size_t i = 0; i != tracks.size(); ++i) {
+        const KeyframeTrack<V>& track = *tracks[i];
+        const std::size_t key = track.keyFor(time, hints[i]);
+        a[i] = &track.values()[key];
+        b[i] = &track.values()[std::min(key + 1, track.size() - 1)];
+        t[i] = track.factor(key, time);
+    }
+
+    /* Branch-free interpolation over contiguous arrays */
+    for(std::size_t i = 0; i != tracks.size(); ++i)
+        values[i] = Implementation::KeyframeInterpolator<V>::interpolate(*a[i], *b[i], t[i]);
+}
+
+}}
+
+#endif
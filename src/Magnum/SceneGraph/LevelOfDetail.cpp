@@ -0,0 +1,121 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "LevelOfDetail.h"
+
+#include "Magnum/MeshView.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/SceneGraph/Camera.h"
+
+namespace Magnum { namespace SceneGraph {
+
+LevelOfDetail::LevelOfDetail(AbstractObject3D& object, const Float radius, const Vector3& center): AbstractFeature3D{object}, _center{center}, _radius{radius}, _hysteresis{0.1f}, _screenSize{}, _current{}, _previous{}, _crossFadeFrames{}, _crossFadeFrame{}, _selected{} {}
+
+LevelOfDetail& LevelOfDetail::addLevel(MeshView& mesh, const Float screenSize) {
+    CORRADE_ASSERT(_levels.empty() || screenSize < _levels.back().second,
+        "SceneGraph::LevelOfDetail::addLevel(): expected screen size smaller than" << _levels.back().second << "but got" << screenSize, *this);
+    _levels.emplace_back(mesh, screenSize);
+    return *this;
+}
+
+MeshView& LevelOfDetail::level(const std::size_t id) {
+    CORRADE_ASSERT(id < _levels.size(),
+        "SceneGraph::LevelOfDetail::level(): index" << id << "out of range for" << _levels.size() << "levels", _levels[0].first);
+    return _levels[id].first;
+}
+
+Float LevelOfDetail::levelScreenSize(const std::size_t id) const {
+    CORRADE_ASSERT(id < _levels.size(),
+        "SceneGraph::LevelOfDetail::levelScreenSize(): index" << id << "out of range for" << _levels.size() << "levels", {});
+    return _levels[id].second;
+}
+
+LevelOfDetail& LevelOfDetail::setHysteresis(const Float hysteresis) {
+    CORRADE_ASSERT(hysteresis >= 0.0f && hysteresis < 1.0f,
+        "SceneGraph::LevelOfDetail::setHysteresis(): expected value in range [0, 1) but got" << hysteresis, *this);
+    _hysteresis = hysteresis;
+    return *this;
+}
+
+Float LevelOfDetail::screenSize(const Matrix4& transformationMatrix, const Matrix4& projectionMatrix) const {
+    /* Sphere radius scaled by the largest object scale */
+    const Matrix3x3 rotationScaling = transformationMatrix.rotationScaling();
+    const Float radius = _radius*Math::max(Math::max(rotationScaling[0].length(), rotationScaling[1].length()), rotationScaling[2].length());
+
+    /* Perspective divide of the sphere center, the camera is inside (or
+       behind) the sphere if that's negative */
+    const Float w = (projectionMatrix*Vector4{transformationMatrix.transformPoint(_center), 1.0f}).w();
+    if(w <= 0.0f) return Constants::inf();
+
+    /* Projected radius relative to half the viewport height is the same as
+       projected diameter relative to the whole height */
+    return radius*projectionMatrix[1][1]/w;
+}
+
+std::size_t LevelOfDetail::selectLevel(const Float screenSize) const {
+    /* The last level is used for everything smaller */
+    const std::size_t last = _levels.size() - 1;
+    const auto firstLevelAbove = [&](const Float factor) {
+        for(std::size_t i = 0; i != last; ++i)
+            if(screenSize >= _levels[i].second*factor) return i;
+        return last;
+    };
+
+    if(!_selected) return firstLevelAbove(1.0f);
+
+    const std::size_t finer = firstLevelAbove(1.0f + _hysteresis);
+    if(finer < _current) return finer;
+
+    const std::size_t coarser = firstLevelAbove(1.0f - _hysteresis);
+    if(coarser > _current) return coarser;
+
+    return _current;
+}
+
+std::size_t LevelOfDetail::select(const Matrix4& transformationMatrix, Camera3D& camera) {
+    CORRADE_ASSERT(!_levels.empty(),
+        "SceneGraph::LevelOfDetail::select(): no levels added", {});
+
+    _screenSize = screenSize(transformationMatrix, camera.projectionMatrix());
+    const std::size_t next = selectLevel(_screenSize);
+    if(!_selected) {
+        _current = _previous = next;
+        _selected = true;
+    } else if(next != _current) {
+        _previous = _current;
+        _current = next;
+        _crossFadeFrame = 0;
+    } else if(_crossFadeFrame < _crossFadeFrames) ++_crossFadeFrame;
+
+    return _current;
+}
+
+Float LevelOfDetail::crossFade() const {
+    if(!isCrossFading()) return 1.0f;
+    return Float(_crossFadeFrame)/Float(_crossFadeFrames);
+}
+
+}}
@@ -0,0 +1,252 @@
+#ifndef Magnum_SceneGraph_LevelOfDetail_h
+#define Magnum_SceneGraph_LevelOfDetail_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::LevelOfDetail
+ */
+
+#include <functional>
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/SceneGraph/AbstractFeature.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Level of detail selection
+
+Attached to an object, holds meshes with decreasing amount of detail and picks
+one of them each frame based on how large the object appears on the screen.
+The feature doesn't own the meshes, they are expected to be kept in scope.
+The screen size is a fraction of viewport height covered by
+the object's bounding sphere, calculated from the transformation relative to
+the camera and the camera projection, so it's independent on the viewport
+resolution. Add the levels from the most detailed to the least detailed, each
+with a minimal screen size at which it's used. The last level is used also for
+objects smaller than its minimal size. Call @ref select() from
+@ref Drawable::draw() and draw the mesh of the returned level:
+
+@code
+class Building: public Object3D, public SceneGraph::Drawable3D {
+    public:
+        explicit Building(Object3D* parent, SceneGraph::DrawableGroup3D* group): Object3D{parent}, SceneGraph::Drawable3D{*this, group}, _lod{*this, 10.0f} {
+            _lod.addLevel(_full, 0.5f)
+                .addLevel(_half, 0.1f)
+                .addLevel(_quarter, 0.0f);
+        }
+
+    private:
+        void draw(const Matrix4& transformationMatrix, SceneGraph::Camera3D& camera) override {
+            _shader.setTransformationMatrix(transformationMatrix)
+                .setProjectionMatrix(camera.projectionMatrix());
+            _lod.level(_lod.select(transformationMatrix, camera)).draw(_shader);
+        }
+
+        MeshView _full, _half, _quarter;
+        SceneGraph::LevelOfDetail _lod;
+        // ...
+};
+@endcode
+
+Use @ref MeshTools::simplify() to generate the less detailed meshes offline.
+
+## Hysteresis
+
+To avoid rapid switching between two levels when the object stays around the
+threshold, a more detailed level is selected only if the screen size is larger
+than its threshold multiplied by `1 + h` and a less detailed level only if the
+screen size is smaller than the threshold multiplied by `1 - h`, where `h` is
+set via @ref setHysteresis(). Default is @cpp 0.1f @ce.
+
+## Cross-fade
+
+If enabled using @ref setCrossFadeFrames(), the previous level is kept for
+given number of frames after the switch, with @ref crossFade() going from
+@cpp 0.0f @ce to @cpp 1.0f @ce. Draw both @ref level() "levels" during that
+time with a dithered discard in a custom fragment shader, so the new level appears
+as the previous one disappears without any need for blending:
+
+@code
+const std::size_t level = _lod.select(transformationMatrix, camera);
+if(_lod.isCrossFading()) {
+    _shader.setDitherThreshold(1.0f - _lod.crossFade());
+    _lod.level(_lod.previousLevel()).draw(_shader);
+    _shader.setDitherThreshold(-_lod.crossFade());
+}
+_lod.level(level).draw(_shader);
+@endcode
+
+Where the shader discards fragments with
+@glsl threshold < 0.0 ? dither > -threshold : dither <= threshold @ce, with
+@glsl dither @ce in range @f$ [0, 1) @f$ being for example an ordered 4x4
+pattern indexed by @glsl gl_FragCoord.xy @ce.
+
+@see @ref Drawable::setBoundingBox()
+*/
+class MAGNUM_SCENEGRAPH_EXPORT LevelOfDetail: public AbstractFeature3D {
+    public:
+        /**
+         * @brief Constructor
+         * @param object    Object holding this feature
+         * @param radius    Bounding sphere radius in object-local
+         *      coordinates
+         * @param center    Bounding sphere center in object-local
+         *      coordinates
+         */
+        explicit LevelOfDetail(AbstractObject3D& object, Float radius, const Vector3& center = {});
+
+        /** @brief Bounding sphere radius */
+        Float radius() const { return _radius; }
+
+        /** @brief Bounding sphere center */
+        Vector3 center() const { return _center; }
+
+        /**
+         * @brief Add a level
+         * @param mesh          Mesh to draw
+         * @param screenSize    Minimal screen size at which the level is
+         *      used
+         * @return Reference to self (for method chaining)
+         *
+         * The mesh is expected to be kept in scope for the whole lifetime of
+         * the feature. The screen size is expected to be smaller than screen
+         * size of the previously added level.
+         */
+        LevelOfDetail& addLevel(MeshView& mesh, Float screenSize);
+
+        /** @brief Count of levels */
+        std::size_t levelCount() const { return _levels.size(); }
+
+        /** @brief Mesh of given level */
+        MeshView& level(std::size_t id);
+
+        /** @brief Minimal screen size of given level */
+        Float levelScreenSize(std::size_t id) const;
+
+        /** @brief Hysteresis */
+        Float hysteresis() const { return _hysteresis; }
+
+        /**
+         * @brief Set hysteresis
+         * @return Reference to self (for method chaining)
+         *
+         * Relative to the level threshold. Default is @cpp 0.1f @ce, set to
+         * @cpp 0.0f @ce to switch exactly at the threshold.
+         */
+        LevelOfDetail& setHysteresis(Float hysteresis);
+
+        /** @brief Cross-fade frame count */
+        UnsignedInt crossFadeFrames() const { return _crossFadeFrames; }
+
+        /**
+         * @brief Set cross-fade frame count
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @cpp 0 @ce, which means the levels are switched
+         * immediately.
+         */
+        LevelOfDetail& setCrossFadeFrames(UnsignedInt frames) {
+            _crossFadeFrames = frames;
+            return *this;
+        }
+
+        /**
+         * @brief Screen size
+         *
+         * Screen size calculated in the last @ref select() call.
+         */
+        Float screenSize() const { return _screenSize; }
+
+        /**
+         * @brief Calculate screen size
+         * @param transformationMatrix  Object transformation relative to
+         *      the camera
+         * @param projectionMatrix      Camera projection matrix
+         *
+         * Fraction of viewport height covered by the bounding sphere.
+         */
+        Float screenSize(const Matrix4& transformationMatrix, const Matrix4& projectionMatrix) const;
+
+        /**
+         * @brief Select a level
+         * @param transformationMatrix  Object transformation relative to
+         *      the camera
+         * @param camera                Camera
+         * @return Index of the selected level
+         *
+         * Expects that at least one level was added. Meant to be called
+         * exactly once per frame, as the cross-fade is advanced by one frame
+         * on each call.
+         * @see @ref level(), @ref crossFade()
+         */
+        std::size_t select(const Matrix4& transformationMatrix, Camera3D& camera);
+
+        /** @brief Level selected in the last @ref select() call */
+        std::size_t currentLevel() const { return _current; }
+
+        /**
+         * @brief Previous level
+         *
+         * Level that was selected before the last switch. Same as
+         * @ref currentLevel() if there was no switch yet.
+         */
+        std::size_t previousLevel() const { return _previous; }
+
+        /**
+         * @brief Whether the levels are being cross-faded
+         *
+         * True if the last switch happened less than
+         * @ref crossFadeFrames() frames ago.
+         */
+        bool isCrossFading() const { return _previous != _current && _crossFadeFrame < _crossFadeFrames; }
+
+        /**
+         * @brief Cross-fade progress
+         *
+         * Goes from @cpp 0.0f @ce right after the switch to @cpp 1.0f @ce
+         * after @ref crossFadeFrames() frames. Always @cpp 1.0f @ce if
+         * @ref isCrossFading() is @cpp false @ce.
+         */
+        Float crossFade() const;
+
+    private:
+        std::size_t selectLevel(Float screenSize) const;
+
+        std::vector<std::pair<std::reference_wrapper<MeshView>, Float>> _levels;
+        Vector3 _center;
+        Float _radius, _hysteresis, _screenSize;
+        std::size_t _current, _previous;
+        UnsignedInt _crossFadeFrames, _crossFadeFrame;
+        bool _selected;
+};
+
+}}
+
+#endif
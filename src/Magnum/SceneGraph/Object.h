@@ -29,6 +29,8 @@
  * @brief Class @ref Magnum::SceneGraph::Object
  */
 
+#include <cstdint>
+#include <memory>
 #include <Corrade/Containers/EnumSet.h>
 
 #include "Magnum/SceneGraph/AbstractFeature.h"
@@ -41,12 +43,77 @@ namespace Implementation {
     enum class ObjectFlag: UnsignedByte {
         Dirty = 1 << 0,
         Visited = 1 << 1,
-        Joint = 1 << 2
+        Joint = 1 << 2,
+        FlatDirty = 1 << 3,
+        LazyDirty = 1 << 4
     };
 
     typedef Containers::EnumSet<ObjectFlag> ObjectFlags;
 
     CORRADE_ENUMSET_OPERATORS(ObjectFlags)
+
+    /* Global dirty epoch counter for lazy dirty propagation, see
+       Scene::setLazyDirtyEnabled(). Not thread-safe, same as setDirty() and
+       setClean() aren't. */
+    MAGNUM_SCENEGRAPH_EXPORT std::uint64_t dirtyEpoch();
+    MAGNUM_SCENEGRAPH_EXPORT std::uint64_t nextDirtyEpoch();
+
+    template<class Allocator, class T> using ReboundAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+    /* Multiplication of two matrices assuming the last row of the second one
+       is (0, ..., 0, 1), i.e. it represents an affine transformation. Skips
+       the multiplications with the known zeros and one. */
+    template<class MatrixType> MatrixType multiplyAffine(const MatrixType& a, const MatrixType& b) {
+        constexpr std::size_t last = MatrixType::Cols - 1;
+        MatrixType out{a};
+        for(std::size_t col = 0; col != MatrixType::Cols; ++col) {
+            auto column = a[0]*b[col][0];
+            for(std::size_t k = 1; k != last; ++k)
+                column += a[k]*b[col][k];
+            out[col] = column;
+        }
+        out[last] += a[last];
+        return out;
+    }
+
+    /* Conversion of absolute transformations to matrices in
+       Object::transformationMatrices(). The generic implementation composes
+       the initial transformation natively and converts each result with a
+       full matrix conversion, specializations for particular transformation
+       implementations can pick a cheaper path, e.g. apply the camera matrix
+       only once per object instead of composing it into the hierarchy. */
+    template<class T> struct DefaultTransformationMatrix {
+        typedef typename DimensionTraits<T::Dimensions, typename T::Type>::MatrixType MatrixType;
+
+        /* Initial transformation passed to Object::transformations() */
+        static typename T::DataType initial(const MatrixType& matrix) {
+            return Transformation<T>::fromMatrix(matrix);
+        }
+
+        /* Final matrix from the initial matrix and transformation computed
+           with initial() as a base */
+        static MatrixType toMatrix(const MatrixType&, const typename T::DataType& transformation) {
+            return Transformation<T>::toMatrix(transformation);
+        }
+
+        /* Multiplication of the initial matrix with a cached absolute
+           transformation matrix in the flat hierarchy */
+        static MatrixType multiply(const MatrixType& initial, const MatrixType& matrix) {
+            return initial*matrix;
+        }
+    };
+
+    template<class T> struct TransformationMatrix: DefaultTransformationMatrix<T> {};
+
+    /* For transformations that can represent only rigid transformations, so
+       the cached absolute matrices are always affine */
+    template<class T> struct AffineTransformationMatrix: DefaultTransformationMatrix<T> {
+        typedef typename DefaultTransformationMatrix<T>::MatrixType MatrixType;
+
+        static MatrixType multiply(const MatrixType& initial, const MatrixType& matrix) {
+            return multiplyAffine(initial, matrix);
+        }
+    };
 }
 
 /**
@@ -113,6 +180,7 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
 {
     friend Containers::LinkedList<Object<Transformation>>;
     friend Containers::LinkedListItem<Object<Transformation>, Object<Transformation>>;
+    friend Scene<Transformation>;
 
     public:
         /** @brief Matrix type */
@@ -295,11 +363,33 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
          */
         std::vector<MatrixType> transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const MatrixType& initialTransformationMatrix = MatrixType()) const;
 
+        /**
+         * @brief Transformation matrices of given set of objects relative to this object using given job system
+         *
+         * Same as @ref transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>&, const MatrixType&) const,
+         * but the computation is split into jobs executed by @p jobSystem.
+         * See @ref transformations(const std::vector<std::reference_wrapper<Object<Transformation>>>&, AbstractJobSystem&, const typename Transformation::DataType&) const
+         * for more information.
+         */
+        std::vector<MatrixType> transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, AbstractJobSystem& jobSystem, const MatrixType& initialTransformationMatrix = MatrixType()) const;
+
+        /**
+         * @brief Transformation matrices of given set of objects relative to this object using given frame arena
+         *
+         * Same as @ref transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>&, const MatrixType&) const,
+         * but all temporary and returned data are allocated from @p arena,
+         * so the function doesn't allocate from the heap. See
+         * @ref FrameArena for more information.
+         */
+        FrameArenaVector<MatrixType> transformationMatrices(Containers::ArrayView<const std::reference_wrapper<Object<Transformation>>> objects, FrameArena& arena, const MatrixType& initialTransformationMatrix = MatrixType()) const;
+
         /**
          * @brief Transformations of given group of objects relative to this object
          *
          * All transformations can be premultiplied with @p initialTransformation,
-         * if specified.
+         * if specified. If called on a @ref Scene with flat hierarchy enabled,
+         * the transformations are taken from the flat hierarchy, see
+         * @ref Scene::setFlatHierarchyEnabled() for more information.
          * @see @ref transformationMatrices()
          */
         /* `objects` passed by copy intentionally (to allow move from
@@ -312,6 +402,40 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
             #endif
             ) const;
 
+        /**
+         * @brief Transformations of given group of objects relative to this object using given job system
+         *
+         * Same as @ref transformations(std::vector<std::reference_wrapper<Object<Transformation>>>, const typename Transformation::DataType&) const,
+         * but the objects are split into contiguous chunks, each processed
+         * by one job executed by @p jobSystem. Transformations of ancestors
+         * shared by objects in one chunk are computed only once, so it's
+         * good to have objects from the same subtree next to each other in
+         * the list. The jobs only read the hierarchy, which thus must not be
+         * modified during the call. Small groups and scenes with flat
+         * hierarchy enabled are processed on the calling thread.
+         */
+        std::vector<typename Transformation::DataType> transformations(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, AbstractJobSystem& jobSystem, const typename Transformation::DataType& initialTransformation =
+            #ifndef CORRADE_MSVC2015_COMPATIBILITY /* I hate this inconsistency */
+            typename Transformation::DataType()
+            #else
+            Transformation::DataType()
+            #endif
+            ) const;
+
+        /**
+         * @brief Transformations of given group of objects relative to this object using given frame arena
+         *
+         * Same as @ref transformations(std::vector<std::reference_wrapper<Object<Transformation>>>, const typename Transformation::DataType&) const,
+         * but all temporary and returned data are allocated from @p arena.
+         */
+        FrameArenaVector<typename Transformation::DataType> transformations(Containers::ArrayView<const std::reference_wrapper<Object<Transformation>>> objects, FrameArena& arena, const typename Transformation::DataType& initialTransformation =
+            #ifndef CORRADE_MSVC2015_COMPATIBILITY /* I hate this inconsistency */
+            typename Transformation::DataType()
+            #else
+            Transformation::DataType()
+            #endif
+            ) const;
+
         /*@}*/
 
         /**
@@ -329,10 +453,49 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
         /* `objects` passed by copy intentionally (to avoid copy internally) */
         static void setClean(std::vector<std::reference_wrapper<Object<Transformation>>> objects);
 
-        /** @copydoc AbstractObject::isDirty() */
-        bool isDirty() const { return !!(flags & Flag::Dirty); }
+        /**
+         * @brief Clean absolute transformations of given set of objects using given job system
+         *
+         * Same as @ref setClean(std::vector<std::reference_wrapper<Object<Transformation>>>),
+         * but the absolute transformations are computed using
+         * @ref transformations(const std::vector<std::reference_wrapper<Object<Transformation>>>&, AbstractJobSystem&, const typename Transformation::DataType&) const.
+         * The features are cleaned on the calling thread.
+         */
+        static void setClean(std::vector<std::reference_wrapper<Object<Transformation>>> objects, AbstractJobSystem& jobSystem);
 
-        /** @copydoc AbstractObject::setDirty() */
+        /**
+         * @brief Clean absolute transformations of given set of objects using given frame arena
+         *
+         * Same as @ref setClean(std::vector<std::reference_wrapper<Object<Transformation>>>),
+         * but all temporary data are allocated from @p arena.
+         */
+        static void setClean(Containers::ArrayView<const std::reference_wrapper<Object<Transformation>>> objects, FrameArena& arena);
+
+        /**
+         * @brief Whether absolute transformation is dirty
+         *
+         * If lazy dirty propagation is enabled in the scene, the parent chain
+         * is additionally checked for transformation changes made after this
+         * object was last cleaned. See @ref SceneGraph-Scene-lazy-dirty for
+         * more information.
+         * @see @ref AbstractObject::isDirty()
+         */
+        bool isDirty() const {
+            return (flags & Flag::Dirty) || ((flags & Flag::LazyDirty) && isParentChainNewer());
+        }
+
+        /**
+         * @brief Set object absolute transformation as dirty
+         *
+         * Calls @ref AbstractFeature::markDirty() on all object features and
+         * recursively calls @ref setDirty() on every child object which is not
+         * already dirty. If the object is already marked as dirty, the
+         * function does nothing. If lazy dirty propagation is enabled in the
+         * scene, the children are not touched and the change is recorded in
+         * constant time instead, see @ref SceneGraph-Scene-lazy-dirty.
+         * @see @ref scenegraph-features-caching, @ref setClean(),
+         *      @ref isDirty()
+         */
         void setDirty();
 
         /**
@@ -374,13 +537,32 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
         }
 
         std::vector<MatrixType> doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects, const MatrixType& initialTransformationMatrix) const override final;
+        std::vector<MatrixType> doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects, AbstractJobSystem& jobSystem, const MatrixType& initialTransformationMatrix) const override final;
+
+        FrameArenaVector<MatrixType> doTransformationMatrices(Containers::ArrayView<const std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>> objects, FrameArena& arena, const MatrixType& initialTransformationMatrix) const override final;
+
+        /* The implementations are templated on allocator so the same code can
+           be used for both heap and frame arena allocations */
+        template<class Allocator> std::vector<typename Transformation::DataType, Implementation::ReboundAllocator<Allocator, typename Transformation::DataType>> MAGNUM_SCENEGRAPH_LOCAL transformationsImplementation(std::vector<std::reference_wrapper<Object<Transformation>>, Allocator>& objects, const typename Transformation::DataType& initialTransformation) const;
 
-        typename Transformation::DataType MAGNUM_SCENEGRAPH_LOCAL computeJointTransformation(const std::vector<std::reference_wrapper<Object<Transformation>>>& jointObjects, std::vector<typename Transformation::DataType>& jointTransformations, const std::size_t joint, const typename Transformation::DataType& initialTransformation) const;
+        template<class DataVector, class ObjectVector> DataVector MAGNUM_SCENEGRAPH_LOCAL flatTransformations(const ObjectVector& objects, const typename Transformation::DataType& initialTransformation, const typename DataVector::allocator_type& allocator);
+        template<class MatrixVector, class ObjectVector> MatrixVector MAGNUM_SCENEGRAPH_LOCAL flatTransformationMatrices(const ObjectVector& objects, const MatrixType& initialTransformationMatrix, const typename MatrixVector::allocator_type& allocator);
+        void MAGNUM_SCENEGRAPH_LOCAL updateFlatHierarchy();
+        void MAGNUM_SCENEGRAPH_LOCAL invalidateFlatHierarchy();
+
+        bool MAGNUM_SCENEGRAPH_LOCAL isParentChainNewer() const;
+        void MAGNUM_SCENEGRAPH_LOCAL setLazyDirtyInternal(bool enabled);
+
+        template<class ObjectVector, class DataVector> typename Transformation::DataType MAGNUM_SCENEGRAPH_LOCAL computeJointTransformation(const ObjectVector& jointObjects, DataVector& jointTransformations, const std::size_t joint, const typename Transformation::DataType& initialTransformation) const;
 
         bool MAGNUM_SCENEGRAPH_LOCAL doIsDirty() const override final { return isDirty(); }
         void MAGNUM_SCENEGRAPH_LOCAL doSetDirty() override final { setDirty(); }
         void MAGNUM_SCENEGRAPH_LOCAL doSetClean() override final { setClean(); }
         void doSetClean(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects) override final;
+        void doSetClean(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects, AbstractJobSystem& jobSystem) override final;
+        void doSetClean(Containers::ArrayView<const std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>> objects, FrameArena& arena) override final;
+
+        template<class Allocator, class Compute> static void MAGNUM_SCENEGRAPH_LOCAL setCleanImplementation(std::vector<std::reference_wrapper<Object<Transformation>>, Allocator>& objects, Compute computeTransformations);
 
         void MAGNUM_SCENEGRAPH_LOCAL setCleanInternal(const typename Transformation::DataType& absoluteTransformation);
 
@@ -388,6 +570,8 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
         typedef Implementation::ObjectFlags Flags;
         UnsignedShort counter;
         Flags flags;
+        UnsignedInt flatIndex;
+        std::uint64_t dirtyEpoch, cleanEpoch;
 };
 
 }}
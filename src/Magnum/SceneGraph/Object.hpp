@@ -26,12 +26,14 @@
 */
 
 /** @file
- * @brief @ref compilation-speedup-hpp "Template implementation" for @ref AbstractObject.h, @ref AbstractTransformation.h and @ref Object.h
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref AbstractObject.h, @ref AbstractTransformation.h, @ref Object.h and @ref Scene.h
  */
 
 #include <algorithm>
 #include <stack>
+#include <unordered_map>
 
+#include "Magnum/SceneGraph/AbstractJobSystem.h"
 #include "Magnum/SceneGraph/AbstractTransformation.h"
 #include "Magnum/SceneGraph/Object.h"
 #include "Magnum/SceneGraph/Scene.h"
@@ -43,11 +45,17 @@ template<UnsignedInt dimensions, class T> AbstractObject<dimensions, T>::~Abstra
 
 template<UnsignedInt dimensions, class T> AbstractTransformation<dimensions, T>::AbstractTransformation() {}
 
-template<class Transformation> Object<Transformation>::Object(Object<Transformation>* parent): counter(0xFFFFu), flags(Flag::Dirty) {
+template<class Transformation> Object<Transformation>::Object(Object<Transformation>* parent): counter(0xFFFFu), flags(Flag::Dirty|Flag::FlatDirty), flatIndex(~UnsignedInt{}), dirtyEpoch(0), cleanEpoch(0) {
     setParent(parent);
 }
 
-template<class Transformation> Object<Transformation>::~Object() = default;
+template<class Transformation> Object<Transformation>::~Object() {
+    /* Destroy the children while this object is still alive, so they can
+       safely walk up the hierarchy */
+    children().clear();
+
+    invalidateFlatHierarchy();
+}
 
 template<class Transformation> Scene<Transformation>* Object<Transformation>::scene() {
     Object<Transformation>* p(this);
@@ -91,10 +99,18 @@ template<class Transformation> Object<Transformation>& Object<Transformation>::s
     }
 
     /* Remove the object from old parent children list */
+    invalidateFlatHierarchy();
     if(this->parent()) this->parent()->Containers::template LinkedList<Object<Transformation>>::cut(this);
 
     /* Add the object to list of new parent */
-    if(parent) parent->Containers::LinkedList<Object<Transformation>>::insert(this);
+    if(parent) {
+        parent->Containers::LinkedList<Object<Transformation>>::insert(this);
+        parent->invalidateFlatHierarchy();
+    }
+
+    /* Take over the dirty propagation mode of the new parent */
+    const bool lazy = parent && (parent->flags & Flag::LazyDirty);
+    if(!!(flags & Flag::LazyDirty) != lazy) setLazyDirtyInternal(lazy);
 
     setDirty();
     return *this;
@@ -117,6 +133,15 @@ template<class Transformation> typename Transformation::DataType Object<Transfor
 }
 
 template<class Transformation> void Object<Transformation>::setDirty() {
+    /* Mark the transformation as changed for the flat hierarchy. Children
+       are updated implicitly, so it's not needed to propagate this further.
+       Advancing the epoch tells the scene that its cached transformations
+       are out of date. */
+    if(!(flags & Flag::FlatDirty)) {
+        flags |= Flag::FlatDirty;
+        if(flatIndex != ~UnsignedInt{}) Implementation::nextDirtyEpoch();
+    }
+
     /* The transformation of this object (and all children) is already dirty,
        nothing to do */
     if(flags & Flag::Dirty) return;
@@ -125,6 +150,14 @@ template<class Transformation> void Object<Transformation>::setDirty() {
     for(AbstractFeature<Transformation::Dimensions, typename Transformation::Type>& feature: this->features())
         feature.markDirty();
 
+    /* With lazy propagation just record when the change happened, children
+       compare it to the time they were last cleaned in isDirty() */
+    if(flags & Flag::LazyDirty) {
+        dirtyEpoch = Implementation::nextDirtyEpoch();
+        flags |= Flag::Dirty;
+        return;
+    }
+
     /* Make all children dirty */
     for(Object<Transformation>& child: children())
         child.setDirty();
@@ -133,9 +166,36 @@ template<class Transformation> void Object<Transformation>::setDirty() {
     flags |= Flag::Dirty;
 }
 
+template<class Transformation> bool Object<Transformation>::isParentChainNewer() const {
+    /* A child can be clean only if all its parents were clean at that time,
+       so any parent changed later has a newer epoch */
+    for(const Object<Transformation>* p = parent(); p; p = p->parent())
+        if(p->dirtyEpoch > cleanEpoch) return true;
+    return false;
+}
+
+template<class Transformation> void Object<Transformation>::setLazyDirtyInternal(const bool enabled) {
+    if(enabled) flags |= Flag::LazyDirty;
+    else {
+        /* Materialize changes that were propagated lazily, so every child of
+           a dirty object is explicitly marked as dirty again. The parents
+           keep their epochs, so the children are still able to check them. */
+        if(!(flags & Flag::Dirty) && isDirty()) {
+            for(AbstractFeature<Transformation::Dimensions, typename Transformation::Type>& feature: this->features())
+                feature.markDirty();
+            flags |= Flag::Dirty;
+        }
+
+        flags &= ~Flag::LazyDirty;
+    }
+
+    for(Object<Transformation>& child: children())
+        child.setLazyDirtyInternal(enabled);
+}
+
 template<class Transformation> void Object<Transformation>::setClean() {
     /* The object (and all its parents) are already clean, nothing to do */
-    if(!(flags & Flag::Dirty)) return;
+    if(!isDirty()) return;
 
     /* Collect all parents, compute base transformation */
     std::stack<Object<Transformation>*> objects;
@@ -179,11 +239,61 @@ template<class Transformation> auto Object<Transformation>::doTransformationMatr
     return transformationMatrices(std::move(castObjects), initialTransformationMatrix);
 }
 
+template<class Transformation> auto Object<Transformation>::doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects, AbstractJobSystem& jobSystem, const MatrixType& initialTransformationMatrix) const -> std::vector<MatrixType> {
+    std::vector<std::reference_wrapper<Object<Transformation>>> castObjects;
+    castObjects.reserve(objects.size());
+    /** @todo Ensure this doesn't crash, somehow */
+    for(auto o: objects) castObjects.push_back(static_cast<Object<Transformation>&>(o.get()));
+
+    return transformationMatrices(castObjects, jobSystem, initialTransformationMatrix);
+}
+
+template<class Transformation> auto Object<Transformation>::doTransformationMatrices(const Containers::ArrayView<const std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>> objects, FrameArena& arena, const MatrixType& initialTransformationMatrix) const -> FrameArenaVector<MatrixType> {
+    FrameArenaVector<std::reference_wrapper<Object<Transformation>>> castObjects{arena};
+    castObjects.reserve(objects.size());
+    /** @todo Ensure this doesn't crash, somehow */
+    for(auto o: objects) castObjects.push_back(static_cast<Object<Transformation>&>(o.get()));
+
+    return transformationMatrices(Containers::ArrayView<const std::reference_wrapper<Object<Transformation>>>{castObjects.data(), castObjects.size()}, arena, initialTransformationMatrix);
+}
+
 template<class Transformation> auto Object<Transformation>::transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const MatrixType& initialTransformationMatrix) const -> std::vector<MatrixType> {
-    std::vector<typename Transformation::DataType> transformations = this->transformations(std::move(objects), Implementation::Transformation<Transformation>::fromMatrix(initialTransformationMatrix));
+    /* Flat hierarchy is enabled in the scene, use the cached matrices */
+    if(isScene() && static_cast<const Scene<Transformation>*>(this)->_flatHierarchyEnabled)
+        return const_cast<Object<Transformation>*>(this)->template flatTransformationMatrices<std::vector<MatrixType>>(objects, initialTransformationMatrix, {});
+
+    std::vector<typename Transformation::DataType> transformations = this->transformations(std::move(objects), Implementation::TransformationMatrix<Transformation>::initial(initialTransformationMatrix));
+    std::vector<MatrixType> transformationMatrices(transformations.size());
+    for(std::size_t i = 0; i != objects.size(); ++i)
+        transformationMatrices[i] = Implementation::TransformationMatrix<Transformation>::toMatrix(initialTransformationMatrix, transformations[i]);
+
+    return transformationMatrices;
+}
+
+template<class Transformation> auto Object<Transformation>::transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, AbstractJobSystem& jobSystem, const MatrixType& initialTransformationMatrix) const -> std::vector<MatrixType> {
+    /* Flat hierarchy is enabled in the scene, a single linear pass is cheaper
+       than distributing the work */
+    if(isScene() && static_cast<const Scene<Transformation>*>(this)->_flatHierarchyEnabled)
+        return const_cast<Object<Transformation>*>(this)->template flatTransformationMatrices<std::vector<MatrixType>>(objects, initialTransformationMatrix, {});
+
+    std::vector<typename Transformation::DataType> transformations = this->transformations(objects, jobSystem, Implementation::TransformationMatrix<Transformation>::initial(initialTransformationMatrix));
     std::vector<MatrixType> transformationMatrices(transformations.size());
     for(std::size_t i = 0; i != objects.size(); ++i)
-        transformationMatrices[i] = Implementation::Transformation<Transformation>::toMatrix(transformations[i]);
+        transformationMatrices[i] = Implementation::TransformationMatrix<Transformation>::toMatrix(initialTransformationMatrix, transformations[i]);
+
+    return transformationMatrices;
+}
+
+template<class Transformation> auto Object<Transformation>::transformationMatrices(const Containers::ArrayView<const std::reference_wrapper<Object<Transformation>>> objects, FrameArena& arena, const MatrixType& initialTransformationMatrix) const -> FrameArenaVector<MatrixType> {
+    /* Flat hierarchy is enabled in the scene, use the cached matrices */
+    if(isScene() && static_cast<const Scene<Transformation>*>(this)->_flatHierarchyEnabled)
+        return const_cast<Object<Transformation>*>(this)->template flatTransformationMatrices<FrameArenaVector<MatrixType>>(objects, initialTransformationMatrix, FrameArenaAllocator<MatrixType>{arena});
+
+    FrameArenaVector<typename Transformation::DataType> transformations = this->transformations(objects, arena, Implementation::TransformationMatrix<Transformation>::initial(initialTransformationMatrix));
+    FrameArenaVector<MatrixType> transformationMatrices{arena};
+    transformationMatrices.reserve(transformations.size());
+    for(std::size_t i = 0; i != objects.size(); ++i)
+        transformationMatrices.push_back(Implementation::TransformationMatrix<Transformation>::toMatrix(initialTransformationMatrix, transformations[i]));
 
     return transformationMatrices;
 }
@@ -203,7 +313,23 @@ computed and recursively concatenated together. Resulting transformations for
 joints which were originally in `object` list is then returned.
 */
 template<class Transformation> std::vector<typename Transformation::DataType> Object<Transformation>::transformations(std::vector<std::reference_wrapper<Object<Transformation>>> objects, const typename Transformation::DataType& initialTransformation) const {
-    CORRADE_ASSERT(objects.size() < 0xFFFFu, "SceneGraph::Object::transformations(): too large scene", {});
+    return transformationsImplementation(objects, initialTransformation);
+}
+
+template<class Transformation> FrameArenaVector<typename Transformation::DataType> Object<Transformation>::transformations(const Containers::ArrayView<const std::reference_wrapper<Object<Transformation>>> objects, FrameArena& arena, const typename Transformation::DataType& initialTransformation) const {
+    FrameArenaVector<std::reference_wrapper<Object<Transformation>>> copy{objects.begin(), objects.end(), arena};
+    return transformationsImplementation(copy, initialTransformation);
+}
+
+template<class Transformation> template<class Allocator> auto Object<Transformation>::transformationsImplementation(std::vector<std::reference_wrapper<Object<Transformation>>, Allocator>& objects, const typename Transformation::DataType& initialTransformation) const -> std::vector<typename Transformation::DataType, Implementation::ReboundAllocator<Allocator, typename Transformation::DataType>> {
+    typedef std::vector<typename Transformation::DataType, Implementation::ReboundAllocator<Allocator, typename Transformation::DataType>> DataVector;
+    const typename DataVector::allocator_type allocator{objects.get_allocator()};
+
+    /* Flat hierarchy is enabled in the scene, use it instead */
+    if(isScene() && static_cast<const Scene<Transformation>*>(this)->_flatHierarchyEnabled)
+        return const_cast<Object<Transformation>*>(this)->template flatTransformations<DataVector>(objects, initialTransformation, allocator);
+
+    CORRADE_ASSERT(objects.size() < 0xFFFFu, "SceneGraph::Object::transformations(): too large scene", DataVector(allocator));
 
     /* Remember object count for later */
     std::size_t objectCount = objects.size();
@@ -218,7 +344,7 @@ template<class Transformation> std::vector<typename Transformation::DataType> Ob
         objects[i].get().counter = UnsignedShort(i);
         objects[i].get().flags |= Flag::Joint;
     }
-    std::vector<std::reference_wrapper<Object<Transformation>>> jointObjects(objects);
+    std::vector<std::reference_wrapper<Object<Transformation>>, Allocator> jointObjects(objects);
 
     #if !defined(CORRADE_NO_ASSERT) || defined(CORRADE_GRACEFUL_ASSERT)
     /* Scene object */
@@ -226,7 +352,7 @@ template<class Transformation> std::vector<typename Transformation::DataType> Ob
     #endif
 
     /* Nearest common ancestor not yet implemented - assert this is done on scene */
-    CORRADE_ASSERT(scene == this, "SceneGraph::Object::transformationMatrices(): currently implemented only for Scene", {});
+    CORRADE_ASSERT(scene == this, "SceneGraph::Object::transformationMatrices(): currently implemented only for Scene", DataVector(allocator));
 
     /* Mark all objects up the hierarchy as visited */
     auto it = objects.begin();
@@ -244,7 +370,7 @@ template<class Transformation> std::vector<typename Transformation::DataType> Ob
 
         /* If this is root object, remove from list */
         if(!parent) {
-            CORRADE_ASSERT(&it->get() == scene, "SceneGraph::Object::transformations(): the objects are not part of the same tree", {});
+            CORRADE_ASSERT(&it->get() == scene, "SceneGraph::Object::transformations(): the objects are not part of the same tree", DataVector(allocator));
             it = objects.erase(it);
 
         /* Parent is an joint or already visited - remove current from list */
@@ -255,7 +381,7 @@ template<class Transformation> std::vector<typename Transformation::DataType> Ob
                list of joint objects */
             if(!(parent->flags & Flag::Joint)) {
                 CORRADE_ASSERT(jointObjects.size() < 0xFFFFu,
-                               "SceneGraph::Object::transformations(): too large scene", {});
+                               "SceneGraph::Object::transformations(): too large scene", DataVector(allocator));
                 CORRADE_INTERNAL_ASSERT(parent->counter == 0xFFFFu);
                 parent->counter = UnsignedShort(jointObjects.size());
                 parent->flags |= Flag::Joint;
@@ -270,7 +396,7 @@ template<class Transformation> std::vector<typename Transformation::DataType> Ob
     }
 
     /* Array of absolute transformations in joints */
-    std::vector<typename Transformation::DataType> jointTransformations(jointObjects.size());
+    DataVector jointTransformations(jointObjects.size(), typename Transformation::DataType(), allocator);
 
     /* Compute transformations for all joints */
     for(std::size_t i = 0; i != jointTransformations.size(); ++i)
@@ -297,7 +423,161 @@ template<class Transformation> std::vector<typename Transformation::DataType> Ob
     return jointTransformations;
 }
 
-template<class Transformation> typename Transformation::DataType Object<Transformation>::computeJointTransformation(const std::vector<std::reference_wrapper<Object<Transformation>>>& jointObjects, std::vector<typename Transformation::DataType>& jointTransformations, const std::size_t joint, const typename Transformation::DataType& initialTransformation) const {
+template<class Transformation> std::vector<typename Transformation::DataType> Object<Transformation>::transformations(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, AbstractJobSystem& jobSystem, const typename Transformation::DataType& initialTransformation) const {
+    /* Flat hierarchy is enabled in the scene, the transformations are
+       computed in a single linear pass anyway */
+    if(isScene() && static_cast<const Scene<Transformation>*>(this)->_flatHierarchyEnabled)
+        return const_cast<Object<Transformation>*>(this)->template flatTransformations<std::vector<typename Transformation::DataType>>(objects, initialTransformation, {});
+
+    /* Split the objects into a few chunks per worker, so the load is balanced
+       even if some subtrees are deeper than others. Small groups are not
+       worth the overhead, process them on the calling thread. */
+    constexpr std::size_t MinObjectsPerJob = 64;
+    const std::size_t jobCount = std::min(jobSystem.workerCount()*4, (objects.size() + MinObjectsPerJob - 1)/MinObjectsPerJob);
+    if(jobCount < 2) return transformations(objects, initialTransformation);
+
+    CORRADE_ASSERT(scene() == this, "SceneGraph::Object::transformations(): currently implemented only for Scene", {});
+
+    std::vector<typename Transformation::DataType> transformations(objects.size());
+    std::vector<UnsignedByte> failed(jobCount);
+    const std::size_t objectsPerJob = (objects.size() + jobCount - 1)/jobCount;
+    jobSystem.run(jobCount, [&](const std::size_t job) {
+        /* Unlike the serial version this doesn't touch any object state, the
+           absolute transformations of visited ancestors are cached locally */
+        std::unordered_map<const Object<Transformation>*, typename Transformation::DataType> cache;
+        std::vector<const Object<Transformation>*> path;
+
+        const std::size_t end = std::min(objects.size(), (job + 1)*objectsPerJob);
+        for(std::size_t i = job*objectsPerJob; i < end; ++i) {
+            /* Go up until an object with known transformation or the root */
+            typename Transformation::DataType transformation = initialTransformation;
+            path.clear();
+            for(const Object<Transformation>* o = &objects[i].get(); o; o = o->parent()) {
+                auto found = cache.find(o);
+                if(found != cache.end()) {
+                    transformation = found->second;
+                    break;
+                }
+
+                /* Root object, it has to be this one */
+                if(!o->parent() && o != this) {
+                    failed[job] = 1;
+                    return;
+                }
+
+                path.push_back(o);
+            }
+
+            /* Go back down, composing and caching the transformations */
+            for(auto it = path.rbegin(); it != path.rend(); ++it) {
+                transformation = Implementation::Transformation<Transformation>::compose(transformation, (*it)->transformation());
+                cache.emplace(*it, transformation);
+            }
+
+            transformations[i] = transformation;
+        }
+    });
+
+    CORRADE_ASSERT(std::find(failed.begin(), failed.end(), 1) == failed.end(), "SceneGraph::Object::transformations(): the objects are not part of the same tree", {});
+    return transformations;
+}
+
+template<class Transformation> template<class DataVector, class ObjectVector> DataVector Object<Transformation>::flatTransformations(const ObjectVector& objects, const typename Transformation::DataType& initialTransformation, const typename DataVector::allocator_type& allocator) {
+    Scene<Transformation>& scene = static_cast<Scene<Transformation>&>(*this);
+    updateFlatHierarchy();
+
+    /* The absolute transformations are already computed, just pick them */
+    DataVector transformations(allocator);
+    transformations.reserve(objects.size());
+    for(const Object<Transformation>& o: objects) {
+        CORRADE_ASSERT(o.flatIndex < scene._flatObjects.size() && scene._flatObjects[o.flatIndex] == &o,
+            "SceneGraph::Object::transformations(): the objects are not part of the same tree", DataVector(allocator));
+        transformations.push_back(Implementation::Transformation<Transformation>::compose(initialTransformation, scene._flatTransformations[o.flatIndex]));
+    }
+
+    return transformations;
+}
+
+template<class Transformation> template<class MatrixVector, class ObjectVector> MatrixVector Object<Transformation>::flatTransformationMatrices(const ObjectVector& objects, const MatrixType& initialTransformationMatrix, const typename MatrixVector::allocator_type& allocator) {
+    Scene<Transformation>& scene = static_cast<Scene<Transformation>&>(*this);
+    updateFlatHierarchy();
+
+    /* The absolute matrices are cached, so each camera only multiplies them
+       with its own matrix */
+    MatrixVector transformationMatrices(allocator);
+    transformationMatrices.reserve(objects.size());
+    for(const Object<Transformation>& o: objects) {
+        CORRADE_ASSERT(o.flatIndex < scene._flatObjects.size() && scene._flatObjects[o.flatIndex] == &o,
+            "SceneGraph::Object::transformationMatrices(): the objects are not part of the same tree", MatrixVector(allocator));
+        transformationMatrices.push_back(Implementation::TransformationMatrix<Transformation>::multiply(initialTransformationMatrix, scene._flatMatrices[o.flatIndex]));
+    }
+
+    return transformationMatrices;
+}
+
+template<class Transformation> void Object<Transformation>::updateFlatHierarchy() {
+    Scene<Transformation>& scene = static_cast<Scene<Transformation>&>(*this);
+    constexpr UnsignedInt NoParent = ~UnsignedInt{};
+
+    /* Nothing changed since the last update (for example when drawing the
+       same scene with multiple cameras in a frame), the cache is valid */
+    if(!scene._flatHierarchyDirty && scene._flatEpoch == Implementation::dirtyEpoch())
+        return;
+
+    /* The hierarchy changed, rebuild the arrays. Depth-first traversal puts
+       every parent before its children. */
+    const bool rebuilt = scene._flatHierarchyDirty;
+    if(rebuilt) {
+        scene._flatObjects.clear();
+        scene._flatParents.clear();
+
+        std::vector<Object<Transformation>*> stack{this};
+        while(!stack.empty()) {
+            Object<Transformation>* o = stack.back();
+            stack.pop_back();
+
+            o->flatIndex = scene._flatObjects.size();
+            scene._flatObjects.push_back(o);
+            scene._flatParents.push_back(o == this ? NoParent : o->parent()->flatIndex);
+
+            for(Object<Transformation>& child: o->children())
+                stack.push_back(&child);
+        }
+
+        scene._flatTransformations.resize(scene._flatObjects.size());
+        scene._flatMatrices.resize(scene._flatObjects.size());
+        scene._flatChanged.resize(scene._flatObjects.size());
+        scene._flatHierarchyDirty = false;
+    }
+
+    /* Recompute absolute transformations of changed objects and all their
+       descendants in one linear pass. The parent is always processed before
+       its children, so its absolute transformation is already up-to-date. */
+    for(std::size_t i = 0; i != scene._flatObjects.size(); ++i) {
+        Object<Transformation>& o = *scene._flatObjects[i];
+        const UnsignedInt parent = scene._flatParents[i];
+
+        const bool changed = rebuilt || (o.flags & Flag::FlatDirty) || (parent != NoParent && scene._flatChanged[parent]);
+        scene._flatChanged[i] = changed;
+        if(!changed) continue;
+
+        o.flags &= ~Flag::FlatDirty;
+        scene._flatTransformations[i] = parent == NoParent ? o.transformation() :
+            Implementation::Transformation<Transformation>::compose(scene._flatTransformations[parent], o.transformation());
+        scene._flatMatrices[i] = Implementation::Transformation<Transformation>::toMatrix(scene._flatTransformations[i]);
+    }
+
+    scene._flatEpoch = Implementation::dirtyEpoch();
+}
+
+template<class Transformation> void Object<Transformation>::invalidateFlatHierarchy() {
+    /* Not part of any flat hierarchy, nothing to do */
+    if(flatIndex == ~UnsignedInt{}) return;
+
+    if(Scene<Transformation>* s = scene()) s->_flatHierarchyDirty = true;
+}
+
+template<class Transformation> template<class ObjectVector, class DataVector> typename Transformation::DataType Object<Transformation>::computeJointTransformation(const ObjectVector& jointObjects, DataVector& jointTransformations, const std::size_t joint, const typename Transformation::DataType& initialTransformation) const {
     std::reference_wrapper<Object<Transformation>> o = jointObjects[joint];
 
     /* Transformation already computed ("unvisited" by this function before
@@ -343,7 +623,44 @@ template<class Transformation> void Object<Transformation>::doSetClean(const std
     setClean(std::move(castObjects));
 }
 
+template<class Transformation> void Object<Transformation>::doSetClean(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects, AbstractJobSystem& jobSystem) {
+    std::vector<std::reference_wrapper<Object<Transformation>>> castObjects;
+    castObjects.reserve(objects.size());
+    /** @todo Ensure this doesn't crash, somehow */
+    for(auto o: objects) castObjects.push_back(static_cast<Object<Transformation>&>(o.get()));
+
+    setClean(std::move(castObjects), jobSystem);
+}
+
+template<class Transformation> void Object<Transformation>::doSetClean(const Containers::ArrayView<const std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>> objects, FrameArena& arena) {
+    FrameArenaVector<std::reference_wrapper<Object<Transformation>>> castObjects{arena};
+    castObjects.reserve(objects.size());
+    /** @todo Ensure this doesn't crash, somehow */
+    for(auto o: objects) castObjects.push_back(static_cast<Object<Transformation>&>(o.get()));
+
+    setClean(Containers::ArrayView<const std::reference_wrapper<Object<Transformation>>>{castObjects.data(), castObjects.size()}, arena);
+}
+
 template<class Transformation> void Object<Transformation>::setClean(std::vector<std::reference_wrapper<Object<Transformation>>> objects) {
+    setCleanImplementation(objects, [](Scene<Transformation>& scene, std::vector<std::reference_wrapper<Object<Transformation>>>& dirtyObjects) {
+        return scene.transformations(dirtyObjects);
+    });
+}
+
+template<class Transformation> void Object<Transformation>::setClean(std::vector<std::reference_wrapper<Object<Transformation>>> objects, AbstractJobSystem& jobSystem) {
+    setCleanImplementation(objects, [&jobSystem](Scene<Transformation>& scene, std::vector<std::reference_wrapper<Object<Transformation>>>& dirtyObjects) {
+        return scene.transformations(dirtyObjects, jobSystem);
+    });
+}
+
+template<class Transformation> void Object<Transformation>::setClean(const Containers::ArrayView<const std::reference_wrapper<Object<Transformation>>> objects, FrameArena& arena) {
+    FrameArenaVector<std::reference_wrapper<Object<Transformation>>> copy{objects.begin(), objects.end(), arena};
+    setCleanImplementation(copy, [&arena](Scene<Transformation>& scene, FrameArenaVector<std::reference_wrapper<Object<Transformation>>>& dirtyObjects) {
+        return scene.transformations(Containers::ArrayView<const std::reference_wrapper<Object<Transformation>>>{dirtyObjects.data(), dirtyObjects.size()}, arena);
+    });
+}
+
+template<class Transformation> template<class Allocator, class Compute> void Object<Transformation>::setCleanImplementation(std::vector<std::reference_wrapper<Object<Transformation>>, Allocator>& objects, Compute computeTransformations) {
     /* Remove all clean objects from the list */
     auto firstClean = std::remove_if(objects.begin(), objects.end(), [](Object<Transformation>& o) { return !o.isDirty(); });
     objects.erase(firstClean, objects.end());
@@ -370,7 +687,7 @@ template<class Transformation> void Object<Transformation>::setClean(std::vector
     /* Compute absolute transformations */
     Scene<Transformation>* scene = objects[0].get().scene();
     CORRADE_ASSERT(scene, "Object::setClean(): objects must be part of some scene", );
-    std::vector<typename Transformation::DataType> transformations(scene->transformations(objects));
+    const auto transformations = computeTransformations(*scene, objects);
 
     /* Go through all objects and clean them */
     for(std::size_t i = 0; i != objects.size(); ++i) {
@@ -387,8 +704,14 @@ template<class Transformation> void Object<Transformation>::setCleanInternal(con
     CachedTransformations cached;
     MatrixType matrix, invertedMatrix;
 
+    /* The object got dirty only through one of its parents with lazy
+       propagation, the features weren't notified yet */
+    const bool notifyFeatures = (flags & Flag::LazyDirty) && !(flags & Flag::Dirty);
+
     /* Clean all features */
     for(AbstractFeature<Transformation::Dimensions, typename Transformation::Type>& feature: this->features()) {
+        if(notifyFeatures) feature.markDirty();
+
         /* Cached absolute transformation, compute it if it wasn't
             computed already */
         if(feature.cachedTransformations() & CachedTransformation::Absolute) {
@@ -415,6 +738,7 @@ template<class Transformation> void Object<Transformation>::setCleanInternal(con
 
     /* Mark object as clean */
     flags &= ~Flag::Dirty;
+    cleanEpoch = Implementation::dirtyEpoch();
 }
 
 }}
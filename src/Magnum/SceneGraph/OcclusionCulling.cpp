@@ -0,0 +1,252 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "OcclusionCulling.h"
+
+#include <Corrade/Utility/Resource.h>
+
+#include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/Shader.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/Shaders/Implementation/CreateCompatibilityShader.h"
+
+#ifdef MAGNUM_BUILD_STATIC
+static void importSceneGraphResources() {
+    CORRADE_RESOURCE_INITIALIZE(MagnumSceneGraph_RCS)
+}
+#endif
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation {
+
+class OcclusionProxyShader: public AbstractShaderProgram {
+    public:
+        typedef Attribute<0, Vector3> Position;
+
+        explicit OcclusionProxyShader();
+
+        OcclusionProxyShader& setTransformationProjectionMatrix(const Matrix4& matrix) {
+            setUniform(_transformationProjectionMatrixUniform, matrix);
+            return *this;
+        }
+
+    private:
+        Int _transformationProjectionMatrixUniform{0};
+};
+
+OcclusionProxyShader::OcclusionProxyShader() {
+    #ifdef MAGNUM_BUILD_STATIC
+    /* Import resources on static build, if not already */
+    if(!Utility::Resource::hasGroup("MagnumSceneGraph"))
+        importSceneGraphResources();
+    #endif
+    Utility::Resource rs("MagnumSceneGraph");
+
+    #ifndef MAGNUM_TARGET_GLES
+    const Version version = Context::current().supportedVersion({Version::GL320, Version::GL310, Version::GL300, Version::GL210});
+    #else
+    const Version version = Context::current().supportedVersion({Version::GLES300, Version::GLES200});
+    #endif
+
+    Shader vert = Shaders::Implementation::createCompatibilityShader(rs, version, Shader::Type::Vertex);
+    Shader frag = Shaders::Implementation::createCompatibilityShader(rs, version, Shader::Type::Fragment);
+    vert.addSource(rs.get("OcclusionProxy.vert"));
+    frag.addSource(rs.get("OcclusionProxy.frag"));
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(compileAndLink({vert, frag}, [&]() {
+        #ifndef MAGNUM_TARGET_GLES
+        if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_attrib_location>(version))
+        #else
+        if(!Context::current().isVersionSupported(Version::GLES300))
+        #endif
+        {
+            bindAttributeLocation(Position::Location, "position");
+        }
+    }));
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_uniform_location>(version))
+    #endif
+    {
+        _transformationProjectionMatrixUniform = uniformLocation("transformationProjectionMatrix");
+    }
+}
+
+}
+
+namespace {
+    /* Unit cube with corner index being x + 2y + 4z, faces wound
+       counterclockwise when looking from outside, so the proxies work with
+       face culling enabled */
+    constexpr Vector3 BoxVertices[]{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {1.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f},
+        {1.0f, 0.0f, 1.0f},
+        {0.0f, 1.0f, 1.0f},
+        {1.0f, 1.0f, 1.0f}
+    };
+
+    constexpr UnsignedByte BoxIndices[]{
+        0, 2, 3, 0, 3, 1,   /* -Z */
+        4, 5, 7, 4, 7, 6,   /* +Z */
+        0, 4, 6, 0, 6, 2,   /* -X */
+        1, 3, 7, 1, 7, 5,   /* +X */
+        0, 1, 5, 0, 5, 4,   /* -Y */
+        2, 6, 7, 2, 7, 3    /* +Y */
+    };
+
+    /* True if any corner of the box is in front of the near plane, i.e. the
+       proxy would be clipped and the query result can't be trusted */
+    bool intersectsNearPlane(const Matrix4& transformationProjection, const Range3D& box) {
+        for(UnsignedInt i = 0; i != 8; ++i) {
+            const Vector4 corner = transformationProjection*Vector4{
+                (i & 1) ? box.max().x() : box.min().x(),
+                (i & 2) ? box.max().y() : box.min().y(),
+                (i & 4) ? box.max().z() : box.min().z(), 1.0f};
+            if(corner.z() < -corner.w()) return true;
+        }
+
+        return false;
+    }
+}
+
+OcclusionCulling::OcclusionCulling(): _shader{new Implementation::OcclusionProxyShader},
+    #ifndef MAGNUM_TARGET_GLES
+    _conditionalRenderMode{SampleQuery::ConditionalRenderMode::Wait},
+    #endif
+    _frame{0}
+{
+    _vertices.setData(BoxVertices, BufferUsage::StaticDraw);
+    _indices.setData(BoxIndices, BufferUsage::StaticDraw);
+    _box.setPrimitive(MeshPrimitive::Triangles)
+        .setCount(36)
+        .addVertexBuffer(_vertices, 0, Implementation::OcclusionProxyShader::Position{})
+        .setIndexBuffer(_indices, 0, Mesh::IndexType::UnsignedByte, 0, 7);
+}
+
+OcclusionCulling::OcclusionCulling(OcclusionCulling&&) noexcept = default;
+
+OcclusionCulling::~OcclusionCulling() = default;
+
+OcclusionCulling& OcclusionCulling::operator=(OcclusionCulling&&) noexcept = default;
+
+std::size_t OcclusionCulling::draw(Camera3D& camera, DrawableGroup3D& group) {
+    AbstractObject3D* scene = camera.object().scene();
+    CORRADE_ASSERT(scene, "SceneGraph::OcclusionCulling::draw(): cannot draw when camera is not part of any scene", 0);
+
+    ++_frame;
+
+    /* Compute transformations of all objects in the group relative to the
+       camera */
+    std::vector<std::reference_wrapper<AbstractObject3D>> objects;
+    objects.reserve(group.size());
+    for(std::size_t i = 0; i != group.size(); ++i)
+        objects.push_back(group[i].object());
+    const std::vector<Matrix4> transformations =
+        scene->transformationMatrices(objects, camera.cameraMatrix());
+
+    /* Fetch results of finished queries without waiting for the others and
+       draw everything that was visible last time. These drawables are
+       queried using their own geometry. */
+    std::vector<std::pair<std::size_t, State*>> occluded;
+    for(std::size_t i = 0; i != transformations.size(); ++i) {
+        Drawable3D& drawable = group[i];
+        if(!drawable.hasBoundingBox()) {
+            drawable.draw(transformations[i], camera);
+            continue;
+        }
+
+        State& state = _states[&drawable];
+        state.frame = _frame;
+        if(state.pending && state.query.resultAvailable()) {
+            state.visible = state.query.result<bool>();
+            state.pending = false;
+        }
+
+        if(!state.visible && !intersectsNearPlane(camera.projectionMatrix()*transformations[i], drawable.boundingBox())) {
+            occluded.emplace_back(i, &state);
+            continue;
+        }
+
+        if(state.pending) {
+            drawable.draw(transformations[i], camera);
+        } else {
+            state.query.begin();
+            drawable.draw(transformations[i], camera);
+            state.query.end();
+            state.pending = true;
+        }
+    }
+
+    /* Query bounding boxes of the drawables that were occluded, against the
+       depth buffer filled above. Drawables that still have a query in flight
+       reuse it. */
+    if(!occluded.empty()) {
+        Renderer::setColorMask(false, false, false, false);
+        Renderer::setDepthMask(false);
+        for(const std::pair<std::size_t, State*>& o: occluded) {
+            if(o.second->pending) continue;
+
+            const Range3D box = group[o.first].boundingBox();
+            _shader->setTransformationProjectionMatrix(camera.projectionMatrix()*transformations[o.first]*Matrix4::translation(box.min())*Matrix4::scaling(box.size()));
+            o.second->query.begin();
+            _box.draw(*_shader);
+            o.second->query.end();
+            o.second->pending = true;
+        }
+        Renderer::setColorMask(true, true, true, true);
+        Renderer::setDepthMask(true);
+    }
+
+    /* Draw the occluded drawables only if their query passed. Without
+       conditional rendering they have to wait for the result to come back. */
+    #ifndef MAGNUM_TARGET_GLES
+    for(const std::pair<std::size_t, State*>& o: occluded) {
+        o.second->query.beginConditionalRender(_conditionalRenderMode);
+        group[o.first].draw(transformations[o.first], camera);
+        o.second->query.endConditionalRender();
+    }
+    #endif
+
+    /* Release queries of drawables that are not in the group anymore */
+    for(auto it = _states.begin(); it != _states.end(); ) {
+        if(it->second.frame != _frame) it = _states.erase(it);
+        else ++it;
+    }
+
+    return occluded.size();
+}
+
+}}
@@ -0,0 +1,192 @@
+#ifndef Magnum_SceneGraph_OcclusionCulling_h
+#define Magnum_SceneGraph_OcclusionCulling_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::OcclusionCulling
+ */
+
+#include "Magnum/configure.h"
+
+#if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/SampleQuery.h"
+#include "Magnum/SceneGraph/SceneGraph.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation { class OcclusionProxyShader; }
+
+/**
+@brief Occlusion culling
+
+Draws a group of drawables and skips the ones that are hidden behind other
+geometry. Visibility of each drawable that has a bounding box set using
+@ref Drawable::setBoundingBox() is tested with a
+@ref SampleQuery::Target::AnySamplesPassedConservative "conservative sample query".
+Drawables without bounding box are always drawn.
+
+@code
+SceneGraph::OcclusionCulling culling;
+
+(new City(&scene, &drawables))
+    ->setBoundingBox({{-50.0f, 0.0f, -50.0f}, {50.0f, 30.0f, 50.0f}});
+
+// ...
+
+void MyApplication::drawEvent() {
+    std::size_t occluded = culling.draw(*camera, drawables);
+
+    // ...
+}
+@endcode
+
+## Temporal coherence
+
+Query results are never waited for on the CPU. Instead, visibility from the
+last available result is reused and a new query for given drawable is issued
+only after the previous one finished. Each frame is drawn in two passes:
+
+1.  Drawables that were visible last time are drawn normally, in group order.
+    Their own geometry is used for the query, so no extra draw is needed.
+2.  For drawables that were occluded last time their bounding box is drawn
+    with color and depth writes disabled and then the drawable itself is drawn
+    under @ref SampleQuery::beginConditionalRender() "conditional render", so
+    the GPU skips it if no sample of the box passed the depth test. The
+    bounding boxes are all drawn first, against the depth buffer filled by the
+    first pass. Color and depth writes are enabled again afterwards.
+
+Drawables with camera located inside their bounding box are treated as
+visible, as their proxy would be clipped by the near plane. Drawables that
+haven't been seen before are treated as visible.
+
+Conditional rendering is not available in OpenGL ES, there the drawables that
+were occluded last time are drawn only after their bounding box query
+reports them visible again, which may cause one or more frames of popping when
+a large occluder moves away.
+
+@requires_gl43 Extension @extension{ARB,ES3_compatibility}
+@requires_gl30 Extension @extension{NV,conditional_render}
+@requires_gles30 Extension @extension{EXT,occlusion_query_boolean} in
+    OpenGL ES 2.0.
+@requires_webgl20 Queries are not available in WebGL 1.0.
+*/
+class MAGNUM_SCENEGRAPH_EXPORT OcclusionCulling {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Compiles the shader and creates the mesh used for drawing the
+         * bounding box proxies.
+         */
+        explicit OcclusionCulling();
+
+        /** @brief Copying is not allowed */
+        OcclusionCulling(const OcclusionCulling&) = delete;
+
+        /** @brief Move constructor */
+        OcclusionCulling(OcclusionCulling&&) noexcept;
+
+        ~OcclusionCulling();
+
+        /** @brief Copying is not allowed */
+        OcclusionCulling& operator=(const OcclusionCulling&) = delete;
+
+        /** @brief Move assignment */
+        OcclusionCulling& operator=(OcclusionCulling&&) noexcept;
+
+        #ifndef MAGNUM_TARGET_GLES
+        /** @brief Conditional render mode */
+        SampleQuery::ConditionalRenderMode conditionalRenderMode() const {
+            return _conditionalRenderMode;
+        }
+
+        /**
+         * @brief Set conditional render mode
+         * @return Reference to self (for method chaining)
+         *
+         * Mode used for drawing the drawables that were occluded the last
+         * time. Default is @ref SampleQuery::ConditionalRenderMode::Wait,
+         * which makes the GPU wait for the result of the bounding box query.
+         * @requires_gl Conditional rendering is not available in OpenGL ES.
+         */
+        OcclusionCulling& setConditionalRenderMode(SampleQuery::ConditionalRenderMode mode) {
+            _conditionalRenderMode = mode;
+            return *this;
+        }
+        #endif
+
+        /**
+         * @brief Draw given group of drawables
+         * @return Count of drawables that were considered occluded
+         *
+         * Drawables that were removed from the group since last time have
+         * their queries released. The returned count includes the
+         * drawables drawn under conditional render, which may still end up
+         * being drawn if they became visible again.
+         */
+        std::size_t draw(Camera3D& camera, DrawableGroup3D& group);
+
+        /**
+         * @brief Forget visibility state of all drawables
+         *
+         * All drawables are treated as visible the next time and all queries
+         * are released. Useful after camera cuts, where the temporal
+         * coherence doesn't hold anymore.
+         */
+        void reset() { _states.clear(); }
+
+    private:
+        struct State {
+            explicit State(): query{SampleQuery::Target::AnySamplesPassedConservative}, frame{0}, visible{true}, pending{false} {}
+
+            SampleQuery query;
+            UnsignedInt frame;
+            bool visible, pending;
+        };
+
+        std::unique_ptr<Implementation::OcclusionProxyShader> _shader;
+        Buffer _vertices, _indices;
+        Mesh _box;
+        std::unordered_map<const Drawable3D*, State> _states;
+        #ifndef MAGNUM_TARGET_GLES
+        SampleQuery::ConditionalRenderMode _conditionalRenderMode;
+        #endif
+        UnsignedInt _frame;
+};
+
+}}
+#else
+#error this header is not available in WebGL 1.0 build
+#endif
+
+#endif
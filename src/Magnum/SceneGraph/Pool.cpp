@@ -0,0 +1,117 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Pool.h"
+
+#include <algorithm>
+#include <Corrade/Utility/Assert.h>
+
+namespace Magnum { namespace SceneGraph {
+
+SlabPool::SlabPool(const std::size_t size, const std::size_t alignment, const std::size_t slotsPerSlab): _slotsPerSlab{slotsPerSlab} {
+    CORRADE_ASSERT(alignment && !(alignment & (alignment - 1)) && alignment <= alignof(std::max_align_t),
+        "SceneGraph::SlabPool: expected alignment to be a power of two not larger than" << alignof(std::max_align_t) << "but got" << alignment, );
+    CORRADE_ASSERT(slotsPerSlab, "SceneGraph::SlabPool: expected non-zero slot count", );
+
+    /* Each slot has to be able to hold the free list pointer and all slots
+       have to be aligned, slab memory itself is aligned to max_align_t */
+    const std::size_t slotAlignment = std::max(alignment, alignof(FreeSlot));
+    _slotSize = (std::max(size, sizeof(FreeSlot)) + slotAlignment - 1) & ~(slotAlignment - 1);
+}
+
+SlabPool::~SlabPool() {
+    CORRADE_ASSERT(!_usedCount,
+        "SceneGraph::SlabPool: destroying a pool with" << _usedCount << "slots still in use", );
+}
+
+std::size_t SlabPool::slabCount() const {
+    std::lock_guard<std::mutex> lock{_mutex};
+    return _slabs.size();
+}
+
+std::size_t SlabPool::usedCount() const {
+    std::lock_guard<std::mutex> lock{_mutex};
+    return _usedCount;
+}
+
+bool SlabPool::owns(const void* const memory) const {
+    const char* const data = static_cast<const char*>(memory);
+    for(const std::unique_ptr<char[]>& slab: _slabs)
+        if(data >= slab.get() && data < slab.get() + _slotSize*_slotsPerSlab)
+            return true;
+    return false;
+}
+
+void SlabPool::addSlab() {
+    /* Thread all slots of the new slab into the free list in address order so
+       consecutive allocations are adjacent */
+    _slabs.emplace_back(new char[_slotSize*_slotsPerSlab]);
+    char* const slab = _slabs.back().get();
+    for(std::size_t i = _slotsPerSlab; i != 0; --i) {
+        FreeSlot* const slot = reinterpret_cast<FreeSlot*>(slab + (i - 1)*_slotSize);
+        slot->next = _free;
+        _free = slot;
+    }
+}
+
+void* SlabPool::allocate() {
+    std::lock_guard<std::mutex> lock{_mutex};
+
+    /* No free slot, allocate a new slab */
+    if(!_free) addSlab();
+
+    FreeSlot* const slot = _free;
+    _free = slot->next;
+    ++_usedCount;
+    return slot;
+}
+
+void SlabPool::reserve(const std::size_t count) {
+    std::lock_guard<std::mutex> lock{_mutex};
+
+    const std::size_t freeCount = _slabs.size()*_slotsPerSlab - _usedCount;
+    if(count <= freeCount) return;
+
+    /* New slabs are put in front of the free list, so their slots are
+       handed out first and each slab gets filled up contiguously */
+    const std::size_t slabCount = (count - freeCount + _slotsPerSlab - 1)/_slotsPerSlab;
+    _slabs.reserve(_slabs.size() + slabCount);
+    for(std::size_t i = 0; i != slabCount; ++i) addSlab();
+}
+
+void SlabPool::deallocate(void* const memory) {
+    if(!memory) return;
+
+    std::lock_guard<std::mutex> lock{_mutex};
+    CORRADE_ASSERT(owns(memory),
+        "SceneGraph::SlabPool::deallocate(): memory not allocated from this pool", );
+
+    FreeSlot* const slot = static_cast<FreeSlot*>(memory);
+    slot->next = _free;
+    _free = slot;
+    --_usedCount;
+}
+
+}}
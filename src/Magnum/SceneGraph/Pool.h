@@ -0,0 +1,225 @@
+#ifndef Magnum_SceneGraph_Pool_h
+#define Magnum_SceneGraph_Pool_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::SlabPool, @ref Magnum::SceneGraph::Pooled
+ */
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/SceneGraph/SceneGraph.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Fixed-size slab allocator
+
+Hands out memory for objects of one fixed size from contiguous slabs, each
+holding @ref slotsPerSlab() slots. Released slots are put into an intrusive
+free list and reused by subsequent allocations, so spawning and destroying
+many objects of the same type doesn't fragment the heap and objects created
+together stay close to each other in memory. Slabs are never returned to the
+system until the pool itself is destroyed.
+
+All operations are guarded by a mutex, so objects can be allocated and
+released from different threads. Usually you don't need to use this class
+directly, see @ref Pooled for the intended use.
+*/
+class MAGNUM_SCENEGRAPH_EXPORT SlabPool {
+    public:
+        /**
+         * @brief Constructor
+         * @param size          Size of one slot
+         * @param alignment     Alignment of one slot. Expected to be a
+         *      power of two not larger than `alignof(std::max_align_t)`.
+         * @param slotsPerSlab  Count of slots in each slab. Expected to be
+         *      non-zero.
+         */
+        explicit SlabPool(std::size_t size, std::size_t alignment, std::size_t slotsPerSlab = 256);
+
+        /** @brief Copying is not allowed */
+        SlabPool(const SlabPool&) = delete;
+
+        /** @brief Moving is not allowed */
+        SlabPool(SlabPool&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Frees all slabs. All slots are expected to be released at this
+         * point.
+         */
+        ~SlabPool();
+
+        /** @brief Copying is not allowed */
+        SlabPool& operator=(const SlabPool&) = delete;
+
+        /** @brief Moving is not allowed */
+        SlabPool& operator=(SlabPool&&) = delete;
+
+        /** @brief Size of one slot */
+        std::size_t slotSize() const { return _slotSize; }
+
+        /** @brief Count of slots in each slab */
+        std::size_t slotsPerSlab() const { return _slotsPerSlab; }
+
+        /** @brief Count of allocated slabs */
+        std::size_t slabCount() const;
+
+        /** @brief Count of slots currently in use */
+        std::size_t usedCount() const;
+
+        /**
+         * @brief Allocate one slot
+         *
+         * Reuses a released slot if there is any, otherwise allocates a new
+         * slab.
+         */
+        void* allocate();
+
+        /**
+         * @brief Reserve free slots
+         *
+         * Allocates as many new slabs as needed for at least @p count
+         * subsequent @ref allocate() calls to not need any further slab
+         * allocation. Slots of new slabs are handed out before slots that
+         * were released earlier, so objects created right after this call
+         * are contiguous in memory.
+         */
+        void reserve(std::size_t count);
+
+        /**
+         * @brief Release a slot
+         *
+         * The memory is expected to be allocated from this pool. Passing
+         * `nullptr` is a no-op.
+         */
+        void deallocate(void* memory);
+
+    private:
+        struct FreeSlot {
+            FreeSlot* next;
+        };
+
+        bool owns(const void* memory) const;
+        void addSlab();
+
+        std::size_t _slotSize, _slotsPerSlab, _usedCount{};
+        FreeSlot* _free{};
+        std::vector<std::unique_ptr<char[]>> _slabs;
+        mutable std::mutex _mutex;
+};
+
+/**
+@brief Pooled allocation for scene graph objects and features
+
+Each @ref Object and each feature is by default a separate heap allocation,
+which with many objects being created and destroyed every frame fragments the
+heap and scatters the objects around so traversing them misses the cache.
+Deriving a class from @ref Pooled makes `new` and `delete` use
+a type-specific @ref SlabPool instead:
+@code
+class Bullet: public Object3D, public SceneGraph::Pooled<Bullet> {
+    public:
+        explicit Bullet(Object3D* parent): Object3D{parent} {}
+};
+
+class BulletDrawable: public SceneGraph::Drawable3D, public SceneGraph::Pooled<BulletDrawable> {
+    public:
+        explicit BulletDrawable(Object3D& object, SceneGraph::DrawableGroup3D& group): SceneGraph::Drawable3D{object, &group} {}
+
+    private:
+        void draw(const Matrix4& transformationMatrix, SceneGraph::Camera3D& camera) override;
+};
+
+auto bullet = new Bullet{&scene};
+new BulletDrawable{*bullet, drawables};
+@endcode
+
+Nothing else changes — objects and features are still owned by their parent
+and deleted together with it, as the scene graph deletes them through a
+virtual destructor and thus the deallocation function of the most derived
+class is used. Drawables of objects created together end up next to each
+other in memory, making @ref Camera::draw() traversal more cache-friendly.
+
+Classes derived further from @p T have a different size and are allocated
+from the global heap as usual. The pool for given type is created on first
+use and is never destroyed, so objects can be safely deleted also during
+static deinitialization; the memory is kept for reuse for the whole lifetime
+of the application.
+@see @ref SlabPool::reserve(), @ref FeatureGroup::reserve()
+*/
+template<class T, std::size_t slotsPerSlab> class Pooled {
+    public:
+        /** @brief Pool the objects are allocated from */
+        static SlabPool& pool() {
+            /* Intentionally leaked, see above */
+            static SlabPool* const instance = new SlabPool{sizeof(T), alignof(T), slotsPerSlab};
+            return *instance;
+        }
+
+        /**
+         * @brief Allocation function
+         *
+         * Allocates from @ref pool() if @p size equals to `sizeof(T)`,
+         * otherwise delegates to the global `operator new`.
+         */
+        static void* operator new(std::size_t size) {
+            return size == sizeof(T) ? pool().allocate() : ::operator new(size);
+        }
+
+        /**
+         * @brief Deallocation function
+         *
+         * Releases the memory back to @ref pool() if @p size equals to
+         * `sizeof(T)`, otherwise delegates to the global
+         * `operator delete`.
+         */
+        static void operator delete(void* memory, std::size_t size) {
+            if(size == sizeof(T)) pool().deallocate(memory);
+            else ::operator delete(memory);
+        }
+
+        /* Placement new has to be un-hidden explicitly */
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        static void* operator new(std::size_t, void* memory) noexcept { return memory; }
+        static void operator delete(void*, void*) noexcept {}
+        #endif
+
+    protected:
+        ~Pooled() = default;
+};
+
+}}
+
+#endif
@@ -0,0 +1,87 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "RenderQueue.h"
+
+#include <Corrade/Utility/Debug.h>
+
+namespace Magnum { namespace SceneGraph {
+
+Debug& operator<<(Debug& debug, const RenderLayer value) {
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case RenderLayer::value: return debug << "SceneGraph::RenderLayer::" #value;
+        _c(Opaque)
+        _c(Transparent)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "SceneGraph::RenderLayer(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+namespace Implementation {
+
+void radixSort(std::vector<std::uint64_t>& keys, std::vector<UnsignedInt>& indices, std::vector<std::uint64_t>& keysScratch, std::vector<UnsignedInt>& indicesScratch) {
+    const std::size_t count = keys.size();
+    if(count < 2) return;
+
+    keysScratch.resize(count);
+    indicesScratch.resize(count);
+
+    /* Histograms of all eight byte digits in a single pass */
+    std::size_t histograms[8][256]{};
+    for(const std::uint64_t key: keys)
+        for(std::size_t digit = 0; digit != 8; ++digit)
+            ++histograms[digit][(key >> (digit*8)) & 0xff];
+
+    for(std::size_t digit = 0; digit != 8; ++digit) {
+        std::size_t* const histogram = histograms[digit];
+
+        /* All keys have the same value of this digit, nothing to do */
+        if(histogram[(keys[0] >> (digit*8)) & 0xff] == count) continue;
+
+        /* Exclusive prefix sum gives the output offsets */
+        std::size_t offset = 0;
+        for(std::size_t i = 0; i != 256; ++i) {
+            const std::size_t size = histogram[i];
+            histogram[i] = offset;
+            offset += size;
+        }
+
+        for(std::size_t i = 0; i != count; ++i) {
+            const std::size_t position = histogram[(keys[i] >> (digit*8)) & 0xff]++;
+            keysScratch[position] = keys[i];
+            indicesScratch[position] = indices[i];
+        }
+
+        std::swap(keys, keysScratch);
+        std::swap(indices, indicesScratch);
+    }
+}
+
+}
+
+}}
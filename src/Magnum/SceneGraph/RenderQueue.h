@@ -0,0 +1,240 @@
+#ifndef Magnum_SceneGraph_RenderQueue_h
+#define Magnum_SceneGraph_RenderQueue_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::RenderQueue, enum @ref Magnum::SceneGraph::RenderLayer, alias @ref Magnum::SceneGraph::BasicRenderQueue2D, @ref Magnum::SceneGraph::BasicRenderQueue3D, typedef @ref Magnum::SceneGraph::RenderQueue2D, @ref Magnum::SceneGraph::RenderQueue3D
+ */
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/SceneGraph/SceneGraph.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Render layer
+
+@see @ref RenderQueue::add()
+*/
+enum class RenderLayer: UnsignedByte {
+    /**
+     * Opaque drawables. Drawn first, sorted by state and then front to back
+     * to make the best use of early depth test.
+     */
+    Opaque,
+
+    /**
+     * Transparent drawables. Drawn after all opaque drawables, sorted back to
+     * front so blending gives correct results and by state only in case of
+     * equal depth.
+     */
+    Transparent
+};
+
+/** @debugoperatorenum{Magnum::SceneGraph::RenderLayer} */
+MAGNUM_SCENEGRAPH_EXPORT Debug& operator<<(Debug& debug, RenderLayer value);
+
+/**
+@brief Render queue
+
+Alternative to drawing a @ref DrawableGroup directly with @ref Camera::draw().
+While a drawable group is drawn in insertion order, which means shader,
+texture and mesh switches happen in whatever order the objects were created,
+drawables submitted to the render queue are sorted by state before drawing.
+
+## Usage
+
+Instead of adding the drawables to a group, submit them to the queue together
+with IDs of the shader, material (textures and other uniform state shared by
+multiple drawables) and mesh they use. The IDs can be arbitrary, for example
+the OpenGL object IDs, as long as they fit into the ranges given by
+@ref MaxProgramId, @ref MaxMaterialId and @ref MaxMeshId:
+@code
+SceneGraph::RenderQueue3D queue;
+queue.add(*redCube, phong.id(), redMaterialId, cube.id())
+    .add(*glassSphere, phong.id(), glassMaterialId, sphere.id(),
+        SceneGraph::RenderLayer::Transparent);
+
+void MyApplication::drawEvent() {
+    queue.draw(*camera);
+
+    // ...
+}
+@endcode
+
+The submissions are kept until @ref clear() is called, so a static scene can
+be submitted just once. On every @ref draw() the transformations of all
+submitted drawables are calculated, sort keys are built from the IDs, layer and
+camera-space depth and the keys are sorted using a radix sort. Opaque
+drawables are then drawn first, sorted by shader, material, mesh and then
+front to back. Transparent drawables are drawn afterwards, sorted back to
+front. The drawables are drawn using their @ref Drawable::draw() function,
+which sets up the state as usual --- as consecutive drawables share the same
+state, redundant shader, texture, buffer and mesh bindings are skipped by the
+state tracker.
+
+The depth is taken from the center of drawable bounding box, if it has one
+(see @ref Drawable::setBoundingBox()), otherwise from the drawable object
+origin. In 2D there's no depth and drawables in the same layer and state are
+drawn in submission order.
+
+## Explicit template specializations
+
+The following specializations are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type) you have to use @ref RenderQueue.hpp implementation file to avoid
+linker errors. See also @ref compilation-speedup-hpp for more information.
+
+-   @ref RenderQueue2D
+-   @ref RenderQueue3D
+
+@see @ref scenegraph, @ref BasicRenderQueue2D, @ref BasicRenderQueue3D,
+    @ref RenderQueue2D, @ref RenderQueue3D, @ref Drawable, @ref Camera
+*/
+template<UnsignedInt dimensions, class T> class RenderQueue {
+    public:
+        enum: UnsignedInt {
+            MaxProgramId = (1 << 12) - 1,   /**< Max shader program ID */
+            MaxMaterialId = (1 << 16) - 1,  /**< Max material ID */
+            MaxMeshId = (1 << 12) - 1       /**< Max mesh ID */
+        };
+
+        /** @brief Constructor */
+        explicit RenderQueue();
+
+        /** @brief Copying is not allowed */
+        RenderQueue(const RenderQueue<dimensions, T>&) = delete;
+
+        /** @brief Move constructor */
+        RenderQueue(RenderQueue<dimensions, T>&&) noexcept;
+
+        ~RenderQueue();
+
+        /** @brief Copying is not allowed */
+        RenderQueue<dimensions, T>& operator=(const RenderQueue<dimensions, T>&) = delete;
+
+        /** @brief Move assignment */
+        RenderQueue<dimensions, T>& operator=(RenderQueue<dimensions, T>&&) noexcept;
+
+        /** @brief Whether the queue is empty */
+        bool isEmpty() const { return _drawables.empty(); }
+
+        /** @brief Count of submitted drawables */
+        std::size_t size() const { return _drawables.size(); }
+
+        /**
+         * @brief Submit a drawable
+         * @param drawable      Drawable
+         * @param program       Shader program ID, at most @ref MaxProgramId
+         * @param material      Material ID, at most @ref MaxMaterialId
+         * @param mesh          Mesh ID, at most @ref MaxMeshId
+         * @param layer         Render layer
+         * @return Reference to self (for method chaining)
+         *
+         * The drawable doesn't need to be part of any @ref DrawableGroup. It
+         * is expected to stay alive until @ref clear() is called or the queue
+         * is destroyed.
+         */
+        RenderQueue<dimensions, T>& add(Drawable<dimensions, T>& drawable, UnsignedInt program, UnsignedInt material, UnsignedInt mesh, RenderLayer layer = RenderLayer::Opaque);
+
+        /**
+         * @brief Clear the queue
+         * @return Reference to self (for method chaining)
+         */
+        RenderQueue<dimensions, T>& clear();
+
+        /**
+         * @brief Sort and draw the queue
+         *
+         * Expects that the camera is part of a scene. See the
+         * @ref RenderQueue "class documentation" for more information.
+         */
+        void draw(Camera<dimensions, T>& camera);
+
+    private:
+        std::vector<std::reference_wrapper<Drawable<dimensions, T>>> _drawables;
+        std::vector<std::uint64_t> _stateKeys;
+
+        /* Kept between frames to avoid reallocations */
+        std::vector<std::uint64_t> _keys, _keysScratch;
+        std::vector<UnsignedInt> _indices, _indicesScratch;
+};
+
+/**
+@brief Render queue for two-dimensional scenes
+
+Convenience alternative to `RenderQueue<2, T>`. See @ref RenderQueue for more
+information.
+@see @ref RenderQueue2D, @ref BasicRenderQueue3D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicRenderQueue2D = RenderQueue<2, T>;
+#endif
+
+/**
+@brief Render queue for two-dimensional float scenes
+
+@see @ref RenderQueue3D
+*/
+typedef BasicRenderQueue2D<Float> RenderQueue2D;
+
+/**
+@brief Render queue for three-dimensional scenes
+
+Convenience alternative to `RenderQueue<3, T>`. See @ref RenderQueue for more
+information.
+@see @ref RenderQueue3D, @ref BasicRenderQueue2D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicRenderQueue3D = RenderQueue<3, T>;
+#endif
+
+/**
+@brief Render queue for three-dimensional float scenes
+
+@see @ref RenderQueue2D
+*/
+typedef BasicRenderQueue3D<Float> RenderQueue3D;
+
+namespace Implementation {
+    /* Stable LSD radix sort of the keys, permuting the indices along. Digit
+       passes in which all keys are the same are skipped. */
+    MAGNUM_SCENEGRAPH_EXPORT void radixSort(std::vector<std::uint64_t>& keys, std::vector<UnsignedInt>& indices, std::vector<std::uint64_t>& keysScratch, std::vector<UnsignedInt>& indicesScratch);
+}
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
+extern template class MAGNUM_SCENEGRAPH_EXPORT RenderQueue<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT RenderQueue<3, Float>;
+#endif
+
+}}
+
+#endif
@@ -0,0 +1,155 @@
+#ifndef Magnum_SceneGraph_RenderQueue_hpp
+#define Magnum_SceneGraph_RenderQueue_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref RenderQueue.h
+ */
+
+#include <cstring>
+
+#include "Magnum/Instrumentation.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/RenderQueue.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation {
+
+/* Key layout for opaque drawables, from the most significant bit: 1 bit
+   layer, 12 bits program, 16 bits material, 12 bits mesh and 23 bits depth.
+   For transparent drawables the depth (inverted for back-to-front order) is
+   placed right after the layer bit. */
+enum: UnsignedInt {
+    RenderQueueMeshShift = 0,
+    RenderQueueMaterialShift = 12,
+    RenderQueueProgramShift = 28,
+    RenderQueueLayerShift = 40,
+    RenderQueueStateBits = 40,
+    RenderQueueDepthBits = 23
+};
+
+/* Non-negative floats compare the same as their bit patterns, so taking the
+   top bits gives a monotonic depth quantization without needing to know the
+   depth range. Anything behind the camera (or NaN) is at zero. */
+inline std::uint64_t renderQueueDepth(Float depth) {
+    if(!(depth > 0.0f)) return 0;
+    UnsignedInt bits;
+    std::memcpy(&bits, &depth, sizeof(bits));
+    return bits >> (32 - 1 - RenderQueueDepthBits);
+}
+
+template<UnsignedInt dimensions, class T> struct RenderQueueDepth;
+template<class T> struct RenderQueueDepth<2, T> {
+    static Float depth(const Math::Matrix3<T>&, const Drawable<2, T>&) { return 0.0f; }
+};
+template<class T> struct RenderQueueDepth<3, T> {
+    /* The camera is looking in the direction of -Z */
+    static Float depth(const Math::Matrix4<T>& transformation, const Drawable<3, T>& drawable) {
+        return Float(drawable.hasBoundingBox() ?
+            -transformation.transformPoint(drawable.boundingBox().center()).z() :
+            -transformation.translation().z());
+    }
+};
+
+}
+
+template<UnsignedInt dimensions, class T> RenderQueue<dimensions, T>::RenderQueue() = default;
+
+template<UnsignedInt dimensions, class T> RenderQueue<dimensions, T>::RenderQueue(RenderQueue<dimensions, T>&&) noexcept = default;
+
+template<UnsignedInt dimensions, class T> RenderQueue<dimensions, T>::~RenderQueue() = default;
+
+template<UnsignedInt dimensions, class T> RenderQueue<dimensions, T>& RenderQueue<dimensions, T>::operator=(RenderQueue<dimensions, T>&&) noexcept = default;
+
+template<UnsignedInt dimensions, class T> RenderQueue<dimensions, T>& RenderQueue<dimensions, T>::add(Drawable<dimensions, T>& drawable, const UnsignedInt program, const UnsignedInt material, const UnsignedInt mesh, const RenderLayer layer) {
+    CORRADE_ASSERT(program <= MaxProgramId && material <= MaxMaterialId && mesh <= MaxMeshId,
+        "SceneGraph::RenderQueue::add(): expected program, material and mesh ID to be at most" << MaxProgramId << Debug::nospace << "," << MaxMaterialId << "and" << MaxMeshId << "but got" << program << Debug::nospace << "," << material << "and" << mesh, *this);
+
+    _drawables.push_back(drawable);
+    _stateKeys.push_back(
+        (std::uint64_t(layer == RenderLayer::Transparent) << Implementation::RenderQueueLayerShift)|
+        (std::uint64_t(program) << Implementation::RenderQueueProgramShift)|
+        (std::uint64_t(material) << Implementation::RenderQueueMaterialShift)|
+        (std::uint64_t(mesh) << Implementation::RenderQueueMeshShift));
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> RenderQueue<dimensions, T>& RenderQueue<dimensions, T>::clear() {
+    _drawables.clear();
+    _stateKeys.clear();
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> void RenderQueue<dimensions, T>::draw(Camera<dimensions, T>& camera) {
+    AbstractObject<dimensions, T>* scene = camera.object().scene();
+    CORRADE_ASSERT(scene, "SceneGraph::RenderQueue::draw(): cannot draw when camera is not part of any scene", );
+
+    MAGNUM_INSTRUMENT_ZONE(Instrumentation::Zone::CameraDraw);
+
+    /* Compute camera matrix */
+    camera.object().setClean();
+
+    /* Compute transformations of all drawables relative to the camera */
+    std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>> objects;
+    objects.reserve(_drawables.size());
+    for(Drawable<dimensions, T>& drawable: _drawables)
+        objects.push_back(drawable.object());
+    std::vector<MatrixTypeFor<dimensions, T>> transformations =
+        scene->transformationMatrices(objects, camera.cameraMatrix());
+
+    /* Build the keys */
+    const std::size_t count = _drawables.size();
+    _keys.resize(count);
+    _indices.resize(count);
+    constexpr std::uint64_t maxDepth = (std::uint64_t(1) << Implementation::RenderQueueDepthBits) - 1;
+    for(std::size_t i = 0; i != count; ++i) {
+        const std::uint64_t depth = Implementation::renderQueueDepth(Implementation::RenderQueueDepth<dimensions, T>::depth(transformations[i], _drawables[i]));
+        const std::uint64_t state = _stateKeys[i];
+
+        /* Opaque: state, then front to back */
+        if(!(state >> Implementation::RenderQueueLayerShift))
+            _keys[i] = (state << Implementation::RenderQueueDepthBits)|depth;
+
+        /* Transparent: back to front, then state */
+        else _keys[i] = (std::uint64_t(1) << 63)|
+            ((maxDepth - depth) << Implementation::RenderQueueStateBits)|
+            (state & ((std::uint64_t(1) << Implementation::RenderQueueStateBits) - 1));
+
+        _indices[i] = UnsignedInt(i);
+    }
+
+    Implementation::radixSort(_keys, _indices, _keysScratch, _indicesScratch);
+
+    /* Perform the drawing */
+    for(const UnsignedInt i: _indices)
+        _drawables[i].get().draw(transformations[i], camera);
+}
+
+}}
+
+#endif
@@ -311,7 +311,7 @@ template<class T> struct Transformation<BasicRigidMatrixTransformation2D<T>> {
     }
 
     static Math::Matrix3<T> compose(const Math::Matrix3<T>& parent, const Math::Matrix3<T>& child) {
-        return parent*child;
+        return multiplyAffine(parent, child);
     }
 
     static Math::Matrix3<T> inverted(const Math::Matrix3<T>& transformation) {
@@ -319,6 +319,8 @@ template<class T> struct Transformation<BasicRigidMatrixTransformation2D<T>> {
     }
 };
 
+template<class T> struct TransformationMatrix<BasicRigidMatrixTransformation2D<T>>: AffineTransformationMatrix<BasicRigidMatrixTransformation2D<T>> {};
+
 }
 
 #if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
@@ -446,7 +446,7 @@ template<class T> struct Transformation<BasicRigidMatrixTransformation3D<T>> {
     }
 
     static Math::Matrix4<T> compose(const Math::Matrix4<T>& parent, const Math::Matrix4<T>& child) {
-        return parent*child;
+        return multiplyAffine(parent, child);
     }
 
     static Math::Matrix4<T> inverted(const Math::Matrix4<T>& transformation) {
@@ -454,6 +454,8 @@ template<class T> struct Transformation<BasicRigidMatrixTransformation3D<T>> {
     }
 };
 
+template<class T> struct TransformationMatrix<BasicRigidMatrixTransformation3D<T>>: AffineTransformationMatrix<BasicRigidMatrixTransformation3D<T>> {};
+
 }
 
 #if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
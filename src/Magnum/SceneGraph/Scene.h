@@ -29,6 +29,8 @@
  * @brief Class @ref Magnum::SceneGraph::Scene
  */
 
+#include <vector>
+
 #include "Magnum/SceneGraph/Object.h"
 
 namespace Magnum { namespace SceneGraph {
@@ -38,15 +40,135 @@ namespace Magnum { namespace SceneGraph {
 
 Basically @ref Object which cannot have parent or non-default transformation.
 See @ref scenegraph for introduction.
+
+@anchor SceneGraph-Scene-flat-hierarchy
+## Flat transformation hierarchy
+
+By default, @ref Object::transformations() (and thus also @ref Camera::draw()
+and @ref Object::setClean(std::vector<std::reference_wrapper<Object<Transformation>>>))
+walks the parent chain of all requested objects on every call. For large
+scenes with many drawables it's possible to enable a flat hierarchy using
+@ref setFlatHierarchyEnabled(). The scene then keeps all its objects sorted
+with parents before children in contiguous arrays, recomputes absolute
+transformations of changed objects and their descendants in one linear pass
+and the transformation queries are then just lookups. Changes in the object
+hierarchy cause the arrays to be rebuilt on next query, so this is beneficial
+mainly for scenes where the hierarchy doesn't change every frame. No other
+code needs to be changed.
+
+The absolute transformation matrices are cached together with an epoch of the
+last change. If no object transformation changed since the previous query,
+which is the case when drawing the same scene with multiple cameras (e.g. the
+main view, shadow cascades and a reflection probe), the linear pass is skipped
+completely and @ref Object::transformationMatrices() only multiplies the
+cached matrices by the camera matrix. With @ref Magnum::Matrix4 "Matrix4" and
+the library built with `MAGNUM_BUILD_MATH_SIMD`, the multiplication uses the
+SIMD kernels. Moving any object between the draws, including a camera,
+causes another linear pass, in which however only the changed objects are
+recomputed.
+@code
+Scene3D scene;
+scene.setFlatHierarchyEnabled(true);
+@endcode
+
+@anchor SceneGraph-Scene-lazy-dirty
+## Lazy dirty propagation
+
+By default, @ref Object::setDirty() recursively marks all children of the
+changed object as dirty and calls @ref AbstractFeature::markDirty() on all
+their features, which makes moving a root of a large hierarchy every frame an
+operation proportional to the size of the whole subtree. With lazy dirty
+propagation enabled using @ref setLazyDirtyEnabled(), a transformation change
+only records a global, monotonically increasing epoch in the changed object.
+@ref Object::isDirty() then compares epochs of all parents to the epoch at
+which the object was last cleaned, which makes the query proportional to the
+object depth instead. The @ref AbstractFeature::markDirty() function of
+features in children is called right before the features get cleaned in
+@ref Object::setClean(). Objects added to the scene take over the mode of
+their new parent.
+@code
+Scene3D scene;
+scene.setLazyDirtyEnabled(true);
+@endcode
 */
 template<class Transformation> class Scene: public Object<Transformation> {
+    friend Object<Transformation>;
+
     public:
         explicit Scene() = default;
 
+        /**
+         * @brief Destructor
+         *
+         * Destroys all children while the scene is still fully constructed.
+         */
+        ~Scene() {
+            Object<Transformation>::children().clear();
+        }
+
+        /**
+         * @brief Whether flat transformation hierarchy is enabled
+         *
+         * @see @ref setFlatHierarchyEnabled()
+         */
+        bool isFlatHierarchyEnabled() const { return _flatHierarchyEnabled; }
+
+        /**
+         * @brief Enable or disable flat transformation hierarchy
+         * @return Reference to self (for method chaining)
+         *
+         * Disabled by default. See @ref SceneGraph-Scene-flat-hierarchy for
+         * more information.
+         */
+        Scene<Transformation>& setFlatHierarchyEnabled(bool enabled);
+
+        /**
+         * @brief Whether lazy dirty propagation is enabled
+         *
+         * @see @ref setLazyDirtyEnabled()
+         */
+        bool isLazyDirtyEnabled() const {
+            return !!(Object<Transformation>::flags & Implementation::ObjectFlag::LazyDirty);
+        }
+
+        /**
+         * @brief Enable or disable lazy dirty propagation
+         * @return Reference to self (for method chaining)
+         *
+         * Disabled by default. Goes through all objects in the scene. When
+         * disabling, objects which are dirty only because of a lazily
+         * propagated change are explicitly marked as dirty again. See
+         * @ref SceneGraph-Scene-lazy-dirty for more information.
+         */
+        Scene<Transformation>& setLazyDirtyEnabled(bool enabled) {
+            Object<Transformation>::setLazyDirtyInternal(enabled);
+            return *this;
+        }
+
     private:
         bool isScene() const override final { return true; }
+
+        bool _flatHierarchyEnabled{false},
+            _flatHierarchyDirty{true};
+        std::vector<Object<Transformation>*> _flatObjects;
+        std::vector<UnsignedInt> _flatParents;
+        std::vector<typename Transformation::DataType> _flatTransformations;
+        std::vector<MatrixTypeFor<Transformation::Dimensions, typename Transformation::Type>> _flatMatrices;
+        std::vector<bool> _flatChanged;
+        std::uint64_t _flatEpoch{};
 };
 
+template<class Transformation> Scene<Transformation>& Scene<Transformation>::setFlatHierarchyEnabled(const bool enabled) {
+    _flatHierarchyEnabled = enabled;
+    _flatHierarchyDirty = true;
+    _flatObjects.clear();
+    _flatParents.clear();
+    _flatTransformations.clear();
+    _flatMatrices.clear();
+    _flatChanged.clear();
+    return *this;
+}
+
 }}
 
 #endif
@@ -56,6 +56,8 @@ template<class Derived, class T> using AbstractBasicGroupedFeature3D = AbstractG
 template<class Derived> using AbstractGroupedFeature2D = AbstractBasicGroupedFeature2D<Derived, Float>;
 template<class Derived> using AbstractGroupedFeature3D = AbstractBasicGroupedFeature3D<Derived, Float>;
 
+class AbstractJobSystem;
+
 template<UnsignedInt, class> class AbstractObject;
 template<class T> using AbstractBasicObject2D = AbstractObject<2, T>;
 template<class T> using AbstractBasicObject3D = AbstractObject<3, T>;
@@ -98,12 +100,34 @@ template<class T> using BasicAnimableGroup3D = AnimableGroup<3, T>;
 typedef BasicAnimableGroup2D<Float> AnimableGroup2D;
 typedef BasicAnimableGroup3D<Float> AnimableGroup3D;
 
+template<UnsignedInt, class> class BoundingVolume;
+template<class T> using BasicBoundingVolume2D = BoundingVolume<2, T>;
+template<class T> using BasicBoundingVolume3D = BoundingVolume<3, T>;
+typedef BasicBoundingVolume2D<Float> BoundingVolume2D;
+typedef BasicBoundingVolume3D<Float> BoundingVolume3D;
+
+template<UnsignedInt, class> class BoundingVolumeHierarchy;
+template<class T> using BasicBoundingVolumeHierarchy2D = BoundingVolumeHierarchy<2, T>;
+template<class T> using BasicBoundingVolumeHierarchy3D = BoundingVolumeHierarchy<3, T>;
+typedef BasicBoundingVolumeHierarchy2D<Float> BoundingVolumeHierarchy2D;
+typedef BasicBoundingVolumeHierarchy3D<Float> BoundingVolumeHierarchy3D;
+
+template<class> class BasicKeyframeAnimable3D;
+typedef BasicKeyframeAnimable3D<Float> KeyframeAnimable3D;
+
+template<class> class KeyframeTrack;
+
+class Skeleton;
+
 template<UnsignedInt, class> class Camera;
 template<class T> using BasicCamera2D = Camera<2, T>;
 template<class T> using BasicCamera3D = Camera<3, T>;
 typedef BasicCamera2D<Float> Camera2D;
 typedef BasicCamera3D<Float> Camera3D;
 
+template<class> class BasicStereoCamera3D;
+typedef BasicStereoCamera3D<Float> StereoCamera3D;
+
 #ifdef MAGNUM_BUILD_DEPRECATED
 template<UnsignedInt dimensions, class T> using AbstractCamera CORRADE_DEPRECATED_ALIAS("use BasicCamera2D instead") = Camera<dimensions, T>;
 template<class T> using AbstractBasicCamera2D CORRADE_DEPRECATED_ALIAS("use BasicCamera2D instead") = BasicCamera2D<T>;
@@ -112,6 +136,10 @@ template<class T> using AbstractBasicCamera3D CORRADE_DEPRECATED_ALIAS("use Basi
 CORRADE_DEPRECATED("use Camera3D instead") typedef Camera3D AbstractCamera3D;
 #endif
 
+#if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+class DepthPrepass;
+#endif
+
 template<UnsignedInt, class> class Drawable;
 template<class T> using BasicDrawable2D = Drawable<2, T>;
 template<class T> using BasicDrawable3D = Drawable<3, T>;
@@ -135,26 +163,69 @@ template<class T> using BasicDrawableGroup3D = DrawableGroup<3, T>;
 typedef BasicDrawableGroup2D<Float> DrawableGroup2D;
 typedef BasicDrawableGroup3D<Float> DrawableGroup3D;
 
+class FrameScheduler;
+
+template<UnsignedInt, class> class InstancedDrawable;
+template<class T> using BasicInstancedDrawable2D = InstancedDrawable<2, T>;
+template<class T> using BasicInstancedDrawable3D = InstancedDrawable<3, T>;
+typedef BasicInstancedDrawable2D<Float> InstancedDrawable2D;
+typedef BasicInstancedDrawable3D<Float> InstancedDrawable3D;
+
+template<UnsignedInt, class> class InstancedDrawableGroup;
+template<class T> using BasicInstancedDrawableGroup2D = InstancedDrawableGroup<2, T>;
+template<class T> using BasicInstancedDrawableGroup3D = InstancedDrawableGroup<3, T>;
+typedef BasicInstancedDrawableGroup2D<Float> InstancedDrawableGroup2D;
+typedef BasicInstancedDrawableGroup3D<Float> InstancedDrawableGroup3D;
+
+class LevelOfDetail;
+
 template<class> class BasicMatrixTransformation2D;
 template<class> class BasicMatrixTransformation3D;
 typedef BasicMatrixTransformation2D<Float> MatrixTransformation2D;
 typedef BasicMatrixTransformation3D<Float> MatrixTransformation3D;
 
+template<class Transformation> class ImportedObject;
+
 template<class Transformation> class Object;
 
+#if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+class OcclusionCulling;
+#endif
+
+template<class, std::size_t = 256> class Pooled;
+
 template<class> class BasicRigidMatrixTransformation2D;
 template<class> class BasicRigidMatrixTransformation3D;
 typedef BasicRigidMatrixTransformation2D<Float> RigidMatrixTransformation2D;
 typedef BasicRigidMatrixTransformation3D<Float> RigidMatrixTransformation3D;
 
+enum class RenderLayer: UnsignedByte;
+
+template<UnsignedInt, class> class RenderQueue;
+template<class T> using BasicRenderQueue2D = RenderQueue<2, T>;
+template<class T> using BasicRenderQueue3D = RenderQueue<3, T>;
+typedef BasicRenderQueue2D<Float> RenderQueue2D;
+typedef BasicRenderQueue3D<Float> RenderQueue3D;
+
 template<class Transformation> class Scene;
 
+#ifndef MAGNUM_TARGET_GLES2
+class ShadowMapCache;
+#endif
+
+class SlabPool;
+
+class ThreadPool;
+
 template<UnsignedInt, class T, class = T> class TranslationTransformation;
 template<class T, class TranslationType = T> using BasicTranslationTransformation2D = TranslationTransformation<2, T, TranslationType>;
 template<class T, class TranslationType = T> using BasicTranslationTransformation3D = TranslationTransformation<3, T, TranslationType>;
 typedef BasicTranslationTransformation2D<Float> TranslationTransformation2D;
 typedef BasicTranslationTransformation3D<Float> TranslationTransformation3D;
 
+enum class StreamedCellState: UnsignedByte;
+template<class Transformation> class WorldStreamer;
+
 namespace Implementation {
     template<class> struct Transformation;
 }
@@ -0,0 +1,113 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ShadowMapCache.h"
+
+#include "Magnum/Sampler.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/Drawable.h"
+
+namespace Magnum { namespace SceneGraph {
+
+ShadowMapCache::ShadowMapCache(const Vector2i& size, const Int layerCount, const TextureFormat format): _size{size} {
+    CORRADE_ASSERT(layerCount > 0,
+        "SceneGraph::ShadowMapCache: expected at least one layer", );
+
+    for(Texture2DArray* texture: {&_cache, &_texture}) {
+        texture->setMinificationFilter(Sampler::Filter::Nearest)
+            .setMagnificationFilter(Sampler::Filter::Nearest)
+            .setWrapping(Sampler::Wrapping::ClampToEdge)
+            .setStorage(1, format, {size, layerCount});
+    }
+    _texture.setCompareMode(Sampler::CompareMode::CompareRefToTexture)
+        .setCompareFunction(Sampler::CompareFunction::LessOrEqual);
+
+    _layers.reserve(layerCount);
+    for(Int i = 0; i != layerCount; ++i) {
+        _layers.emplace_back(Range2Di{{}, size});
+        Layer& layer = _layers.back();
+
+        /* Depth-only framebuffers, no draw or read color buffer */
+        layer.cache.attachTextureLayer(Framebuffer::BufferAttachment::Depth, _cache, 0, i)
+            .mapForDraw(Framebuffer::DrawAttachment::None);
+        layer.texture.attachTextureLayer(Framebuffer::BufferAttachment::Depth, _texture, 0, i)
+            .mapForDraw(Framebuffer::DrawAttachment::None);
+    }
+}
+
+ShadowMapCache::ShadowMapCache(ShadowMapCache&&) noexcept = default;
+
+ShadowMapCache::~ShadowMapCache() = default;
+
+ShadowMapCache& ShadowMapCache::operator=(ShadowMapCache&&) noexcept = default;
+
+bool ShadowMapCache::isCached(const Int layer) const {
+    CORRADE_ASSERT(std::size_t(layer) < _layers.size(),
+        "SceneGraph::ShadowMapCache::isCached(): index" << layer << "out of range for" << _layers.size() << "layers", false);
+    return _layers[layer].cached;
+}
+
+ShadowMapCache& ShadowMapCache::invalidate(const Int layer) {
+    CORRADE_ASSERT(std::size_t(layer) < _layers.size(),
+        "SceneGraph::ShadowMapCache::invalidate(): index" << layer << "out of range for" << _layers.size() << "layers", *this);
+    _layers[layer].cached = false;
+    return *this;
+}
+
+ShadowMapCache& ShadowMapCache::invalidate() {
+    for(Layer& layer: _layers) layer.cached = false;
+    return *this;
+}
+
+bool ShadowMapCache::draw(const Int layer, Camera3D& camera, DrawableGroup3D& staticCasters, DrawableGroup3D& dynamicCasters) {
+    CORRADE_ASSERT(std::size_t(layer) < _layers.size(),
+        "SceneGraph::ShadowMapCache::draw(): index" << layer << "out of range for" << _layers.size() << "layers", false);
+    CORRADE_ASSERT(camera.object().scene(),
+        "SceneGraph::ShadowMapCache::draw(): cannot draw when camera is not part of any scene", false);
+
+    Layer& l = _layers[layer];
+
+    /* Redraw the static casters if the layer was invalidated or the light
+       moved */
+    const Matrix4 matrix = camera.projectionMatrix()*camera.cameraMatrix();
+    const bool redraw = !l.cached || l.matrix != matrix;
+    if(redraw) {
+        l.cache.clear(FramebufferClear::Depth)
+            .bind();
+        camera.draw(staticCasters);
+        l.matrix = matrix;
+        l.cached = true;
+        ++_staticDrawCount;
+    }
+
+    /* Start from the cached depth and add the dynamic casters on top */
+    AbstractFramebuffer::blit(l.cache, l.texture, {{}, _size}, FramebufferBlit::Depth);
+    l.texture.bind();
+    camera.draw(dynamicCasters);
+
+    return redraw;
+}
+
+}}
@@ -0,0 +1,215 @@
+#ifndef Magnum_SceneGraph_ShadowMapCache_h
+#define Magnum_SceneGraph_ShadowMapCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::ShadowMapCache
+ */
+
+#include "Magnum/configure.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+#include <vector>
+
+#include "Magnum/Framebuffer.h"
+#include "Magnum/TextureArray.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/SceneGraph/SceneGraph.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Shadow map cache
+
+Keeps shadow maps of static geometry across frames so only dynamic shadow
+casters are drawn every frame. Each layer of the cache corresponds to one
+shadow map, e.g. one light or one cascade of a cascaded shadow map. Static
+casters are drawn into a cached depth layer only when needed, every call to
+@ref draw() then starts by copying the cached depth into @ref texture() using
+@ref Framebuffer::blit() and draws only the dynamic casters on top.
+@code
+SceneGraph::ShadowMapCache shadows{{1024, 1024}, 4};
+SceneGraph::DrawableGroup3D staticCasters, dynamicCasters;
+
+void MyApplication::drawEvent() {
+    for(Int i = 0; i != 4; ++i)
+        shadows.draw(i, *cascadeCameras[i], staticCasters, dynamicCasters);
+
+    defaultFramebuffer.bind();
+    shader.bindShadowTexture(shadows.texture());
+
+    // ...
+}
+
+void MyApplication::moveBuilding() {
+    building->translate({1.0f, 0.0f, 0.0f});
+
+    // The building is in the static group, the cached maps are now wrong
+    shadows.invalidate();
+}
+@endcode
+
+The cached layer is redrawn automatically if the projection or camera matrix
+of the light camera passed to @ref draw() changed since the last time, i.e.
+when the light moved or a cascade got refitted. Movement of static casters is
+not tracked, call @ref invalidate(Int) for affected layers or
+@ref invalidate() for all of them when it happens.
+
+Both the cache and @ref texture() are depth-only @ref Texture2DArray with
+nearest filtering, the resulting texture has
+@ref Sampler::CompareMode::CompareRefToTexture set, so it can be sampled
+directly with `sampler2DArrayShadow`. The casters are drawn with their own
+@ref Drawable::draw() using @ref Camera::draw(), the same way as when drawing
+the shadow maps from scratch. Color output of the shaders is discarded. Depth
+test has to be enabled and depth writes allowed when calling @ref draw().
+@requires_gl30 Extension @extension{EXT,texture_array} and
+    @extension{ARB,framebuffer_object}
+@requires_gles30 Texture arrays and framebuffer blit are not available in
+    OpenGL ES 2.0.
+@requires_webgl20 Texture arrays and framebuffer blit are not available in
+    WebGL 1.0.
+*/
+class MAGNUM_SCENEGRAPH_EXPORT ShadowMapCache {
+    public:
+        /**
+         * @brief Constructor
+         * @param size          Size of each shadow map
+         * @param layerCount    Count of shadow maps
+         * @param format        Depth texture format
+         *
+         * Allocates the cached and resulting texture and framebuffers for
+         * each layer. All layers are initially invalid.
+         */
+        explicit ShadowMapCache(const Vector2i& size, Int layerCount, TextureFormat format = TextureFormat::DepthComponent24);
+
+        /** @brief Copying is not allowed */
+        ShadowMapCache(const ShadowMapCache&) = delete;
+
+        /** @brief Move constructor */
+        ShadowMapCache(ShadowMapCache&&) noexcept;
+
+        ~ShadowMapCache();
+
+        /** @brief Copying is not allowed */
+        ShadowMapCache& operator=(const ShadowMapCache&) = delete;
+
+        /** @brief Move assignment */
+        ShadowMapCache& operator=(ShadowMapCache&&) noexcept;
+
+        /** @brief Size of each shadow map */
+        Vector2i size() const { return _size; }
+
+        /** @brief Count of shadow maps */
+        Int layerCount() const { return Int(_layers.size()); }
+
+        /**
+         * @brief Shadow map texture
+         *
+         * Contains both static and dynamic casters of each layer after
+         * @ref draw() was called for it.
+         */
+        Texture2DArray& texture() { return _texture; }
+
+        /**
+         * @brief Cached texture
+         *
+         * Contains only static casters.
+         */
+        Texture2DArray& cacheTexture() { return _cache; }
+
+        /**
+         * @brief Whether given layer is cached
+         *
+         * Returns `true` if static casters of given layer were drawn and the
+         * layer was not invalidated since. Expects that @p layer is less than
+         * @ref layerCount().
+         */
+        bool isCached(Int layer) const;
+
+        /**
+         * @brief Invalidate given layer
+         * @return Reference to self (for method chaining)
+         *
+         * Static casters of given layer are redrawn on next @ref draw().
+         * Expects that @p layer is less than @ref layerCount().
+         */
+        ShadowMapCache& invalidate(Int layer);
+
+        /**
+         * @brief Invalidate all layers
+         * @return Reference to self (for method chaining)
+         */
+        ShadowMapCache& invalidate();
+
+        /**
+         * @brief Count of static redraws
+         *
+         * How many times were static casters drawn since the cache was
+         * created. Useful for verifying that the cache is effective.
+         */
+        std::size_t staticDrawCount() const { return _staticDrawCount; }
+
+        /**
+         * @brief Draw shadow map of given layer
+         * @param layer             Layer index
+         * @param camera            Light camera
+         * @param staticCasters     Static shadow casters
+         * @param dynamicCasters    Dynamic shadow casters
+         * @return `true` if the static casters were redrawn, `false` if the
+         *      cached layer was used
+         *
+         * If the layer is not cached or the light camera changed, clears the
+         * cached layer and draws @p staticCasters into it. Then copies the
+         * cached layer into @ref texture() and draws @p dynamicCasters on
+         * top. Leaves the resulting layer framebuffer bound. Expects that
+         * @p layer is less than @ref layerCount() and that the camera is
+         * part of a scene.
+         */
+        bool draw(Int layer, Camera3D& camera, DrawableGroup3D& staticCasters, DrawableGroup3D& dynamicCasters);
+
+    private:
+        struct Layer {
+            explicit Layer(const Range2Di& viewport): cache{viewport}, texture{viewport} {}
+
+            Framebuffer cache, texture;
+            Matrix4 matrix;
+            bool cached{};
+        };
+
+        Vector2i _size;
+        Texture2DArray _cache, _texture;
+        std::vector<Layer> _layers;
+        std::size_t _staticDrawCount{};
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 build
+#endif
+
+#endif
@@ -0,0 +1,129 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Skeleton.h"
+
+#include <algorithm>
+
+namespace Magnum { namespace SceneGraph {
+
+Skeleton::Skeleton(std::vector<Int> parents, std::vector<Matrix4> inverseBindMatrices): _parents{std::move(parents)}, _inverseBindMatrices{std::move(inverseBindMatrices)}, _restTranslations(_parents.size()), _restScalings(_parents.size(), Vector3{1.0f}), _restRotations(_parents.size()) {
+    CORRADE_ASSERT(_parents.size() == _inverseBindMatrices.size(),
+        "SceneGraph::Skeleton: expected" << _parents.size() << "inverse bind matrices but got" << _inverseBindMatrices.size(), );
+    #ifndef CORRADE_NO_ASSERT
+    for(std::size_t i = 0; i != _parents.size(); ++i)
+        CORRADE_ASSERT(_parents[i] < Int(i),
+            "SceneGraph::Skeleton: parent of joint" << i << "is not listed before it", );
+    #endif
+}
+
+Skeleton& Skeleton::setRestPose(const UnsignedInt joint, const Vector3& translation, const Quaternion& rotation, const Vector3& scaling) {
+    CORRADE_ASSERT(joint < _parents.size(),
+        "SceneGraph::Skeleton::setRestPose(): joint" << joint << "out of range for" << _parents.size() << "joints", *this);
+    _restTranslations[joint] = translation;
+    _restRotations[joint] = rotation;
+    _restScalings[joint] = scaling;
+    return *this;
+}
+
+template<class V> void Skeleton::setTrack(Tracks<V>& tracks, const UnsignedInt joint, const KeyframeTrack<V>* const track) {
+    /* Keep the tracks sorted by joint so the evaluation walks memory
+       linearly */
+    const auto found = std::lower_bound(tracks.joints.begin(), tracks.joints.end(), joint);
+    const std::size_t index = found - tracks.joints.begin();
+    const bool exists = found != tracks.joints.end() && *found == joint;
+
+    if(track) {
+        CORRADE_ASSERT(!track->isEmpty(),
+            "SceneGraph::Skeleton::setTracks(): the tracks can't be empty", );
+        if(exists) tracks.tracks[index] = track;
+        else {
+            tracks.joints.insert(found, joint);
+            tracks.tracks.insert(tracks.tracks.begin() + index, track);
+        }
+    } else if(exists) {
+        tracks.joints.erase(found);
+        tracks.tracks.erase(tracks.tracks.begin() + index);
+    }
+}
+
+Skeleton& Skeleton::setTracks(const UnsignedInt joint, const KeyframeTrack3D* const translation, const KeyframeTrackQuaternion* const rotation, const KeyframeTrack3D* const scaling) {
+    CORRADE_ASSERT(joint < _parents.size(),
+        "SceneGraph::Skeleton::setTracks(): joint" << joint << "out of range for" << _parents.size() << "joints", *this);
+    setTrack(_translations, joint, translation);
+    setTrack(_rotations, joint, rotation);
+    setTrack(_scalings, joint, scaling);
+    return *this;
+}
+
+Float Skeleton::duration() const {
+    Float duration = 0.0f;
+    for(const KeyframeTrack3D* track: _translations.tracks)
+        duration = Math::max(duration, track->duration());
+    for(const KeyframeTrackQuaternion* track: _rotations.tracks)
+        duration = Math::max(duration, track->duration());
+    for(const KeyframeTrack3D* track: _scalings.tracks)
+        duration = Math::max(duration, track->duration());
+    return duration;
+}
+
+template<class V> void Skeleton::evaluate(const Tracks<V>& tracks, const Float time, const Containers::ArrayView<std::size_t> hints, std::vector<V>& values) {
+    std::vector<V> interpolated(tracks.tracks.size());
+    interpolate<V>({tracks.tracks.data(), tracks.tracks.size()}, time, hints, {interpolated.data(), interpolated.size()});
+    for(std::size_t i = 0; i != interpolated.size(); ++i)
+        values[tracks.joints[i]] = interpolated[i];
+}
+
+void Skeleton::jointMatrices(const Float time, const Containers::ArrayView<std::size_t> hints, const Containers::ArrayView<Matrix4> matrices) const {
+    CORRADE_ASSERT(hints.size() == hintCount(),
+        "SceneGraph::Skeleton::jointMatrices(): expected" << hintCount() << "hints but got" << hints.size(), );
+    CORRADE_ASSERT(matrices.size() == _parents.size(),
+        "SceneGraph::Skeleton::jointMatrices(): expected" << _parents.size() << "matrices but got" << matrices.size(), );
+
+    /* Evaluate all tracks of each kind in a single batch, starting from the
+       rest pose */
+    std::vector<Vector3> translations = _restTranslations;
+    std::vector<Quaternion> rotations = _restRotations;
+    std::vector<Vector3> scalings = _restScalings;
+    const std::size_t rotationHintOffset = _translations.tracks.size();
+    const std::size_t scalingHintOffset = rotationHintOffset + _rotations.tracks.size();
+    evaluate(_translations, time, hints.slice(0, rotationHintOffset), translations);
+    evaluate(_rotations, time, hints.slice(rotationHintOffset, scalingHintOffset), rotations);
+    evaluate(_scalings, time, hints.slice(scalingHintOffset, hints.size()), scalings);
+
+    /* Local transformations, accumulated into global ones. Parents are
+       always before children, so a single pass is enough. */
+    for(std::size_t i = 0; i != _parents.size(); ++i) {
+        const Matrix4 local = Matrix4::from(rotations[i].normalized().toMatrix(), translations[i])*Matrix4::scaling(scalings[i]);
+        matrices[i] = _parents[i] == -1 ? local : matrices[_parents[i]]*local;
+    }
+
+    /* Multiply with inverse bind matrices. Done in a separate pass as the
+       global transformations of parents are needed above. */
+    for(std::size_t i = 0; i != _parents.size(); ++i)
+        matrices[i] = matrices[i]*_inverseBindMatrices[i];
+}
+
+}}
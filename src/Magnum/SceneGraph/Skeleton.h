@@ -0,0 +1,158 @@
+#ifndef Magnum_SceneGraph_Skeleton_h
+#define Magnum_SceneGraph_Skeleton_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::Skeleton
+ */
+
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/SceneGraph/KeyframeTrack.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Skeleton for skeletal animation
+
+Joint hierarchy with inverse bind matrices and per-joint translation, rotation
+and scaling @ref KeyframeTrack "keyframe tracks". The @ref jointMatrices()
+function evaluates all tracks using the batched @ref interpolate(), composes
+local joint transformations, propagates them through the hierarchy and
+multiplies them with the inverse bind matrices. The result is a joint matrix
+palette to be uploaded for @ref Shaders::Phong::Flag::Skinned "skinning on the GPU"
+or passed to @ref MeshTools::skinInto() for skinning on the CPU.
+
+The skeleton holds no playback state and only references the tracks, so a
+single instance can be shared by any number of characters --- each of them
+needs only its own array of @ref hintCount() cursor hints.
+
+@code
+SceneGraph::Skeleton skeleton{parents, inverseBindMatrices};
+skeleton.setTracks(0, &hipTranslation, &hipRotation, nullptr)
+    .setTracks(1, nullptr, &spineRotation, nullptr);
+
+Containers::Array<std::size_t> hints{Containers::ValueInit, skeleton.hintCount()};
+Containers::Array<Matrix4> palette{skeleton.jointCount()};
+skeleton.jointMatrices(time, hints, palette);
+@endcode
+*/
+class MAGNUM_SCENEGRAPH_EXPORT Skeleton {
+    public:
+        /**
+         * @brief Constructor
+         * @param parents               Parent index for each joint or
+         *      @cpp -1 @ce for root joints. Parents are expected to be
+         *      listed before their children.
+         * @param inverseBindMatrices   Inverse bind matrix for each joint.
+         *      Expected to have the same size as @p parents.
+         *
+         * The rest pose of all joints is an identity, use
+         * @ref setRestPose() to change it.
+         */
+        explicit Skeleton(std::vector<Int> parents, std::vector<Matrix4> inverseBindMatrices);
+
+        /** @brief Joint count */
+        UnsignedInt jointCount() const { return _parents.size(); }
+
+        /** @brief Joint parents */
+        const std::vector<Int>& parents() const { return _parents; }
+
+        /** @brief Inverse bind matrices */
+        const std::vector<Matrix4>& inverseBindMatrices() const { return _inverseBindMatrices; }
+
+        /**
+         * @brief Set rest pose of a joint
+         * @return Reference to self (for method chaining)
+         *
+         * Used for the components that don't have any track assigned.
+         */
+        Skeleton& setRestPose(UnsignedInt joint, const Vector3& translation, const Quaternion& rotation, const Vector3& scaling);
+
+        /**
+         * @brief Set tracks of a joint
+         * @return Reference to self (for method chaining)
+         *
+         * Any of the tracks can be `nullptr`, in which case the rest pose
+         * is used for given component. The tracks are expected to be
+         * non-empty. Changes @ref hintCount(), so all hint arrays need to
+         * be recreated afterwards.
+         */
+        Skeleton& setTracks(UnsignedInt joint, const KeyframeTrack3D* translation, const KeyframeTrackQuaternion* rotation, const KeyframeTrack3D* scaling);
+
+        /**
+         * @brief Count of cursor hints
+         *
+         * Size of the hint array expected by @ref jointMatrices(), equal to
+         * the total count of assigned tracks.
+         */
+        std::size_t hintCount() const {
+            return _translations.tracks.size() + _rotations.tracks.size() + _scalings.tracks.size();
+        }
+
+        /**
+         * @brief Animation duration
+         *
+         * Duration of the longest track.
+         */
+        Float duration() const;
+
+        /**
+         * @brief Calculate joint matrices
+         * @param[in] time          Animation time
+         * @param[in,out] hints     Cursor hints, expected to have
+         *      @ref hintCount() items, initialized to zero before first use
+         * @param[out] matrices     Where to put joint matrices, expected to
+         *      have @ref jointCount() items
+         *
+         * The matrix of each joint is its global transformation at @p time
+         * multiplied by its inverse bind matrix.
+         */
+        void jointMatrices(Float time, Containers::ArrayView<std::size_t> hints, Containers::ArrayView<Matrix4> matrices) const;
+
+    private:
+        template<class V> struct Tracks {
+            std::vector<const KeyframeTrack<V>*> tracks;
+            std::vector<UnsignedInt> joints;
+        };
+
+        template<class V> static void setTrack(Tracks<V>& tracks, UnsignedInt joint, const KeyframeTrack<V>* track);
+        template<class V> static void evaluate(const Tracks<V>& tracks, Float time, Containers::ArrayView<std::size_t> hints, std::vector<V>& values);
+
+        std::vector<Int> _parents;
+        std::vector<Matrix4> _inverseBindMatrices;
+        std::vector<Vector3> _restTranslations, _restScalings;
+        std::vector<Quaternion> _restRotations;
+        Tracks<Vector3> _translations, _scalings;
+        Tracks<Quaternion> _rotations;
+};
+
+}}
+
+#endif
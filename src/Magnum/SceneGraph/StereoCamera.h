@@ -0,0 +1,188 @@
+#ifndef Magnum_SceneGraph_StereoCamera_h
+#define Magnum_SceneGraph_StereoCamera_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::BasicStereoCamera3D, typedef @ref Magnum::SceneGraph::StereoCamera3D
+ */
+
+#include "Magnum/SceneGraph/Camera.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Stereo camera for three-dimensional scenes
+
+Camera with separate projection and transformation for each eye, intended for
+single-pass stereo rendering with @ref Framebuffer::attachTextureMultiview()
+and @ref Shaders::Flat::Flag::Multiview "Shaders::*::Flag::Multiview". The
+scene is traversed only once --- the transformations passed to
+@ref Drawable::draw() are relative to the camera object (i.e., the head) and
+the per-eye view projection matrices are available through
+@ref viewProjectionMatrix():
+@code
+SceneGraph::StereoCamera3D camera{cameraObject};
+camera.setEye(SceneGraph::StereoCamera3D::Eye::Left, leftProjection, leftEyeTransformation)
+      .setEye(SceneGraph::StereoCamera3D::Eye::Right, rightProjection, rightEyeTransformation);
+
+camera.drawCulled(drawables);
+@endcode
+
+In the drawable, the camera can be cast back to @ref BasicStereoCamera3D "StereoCamera3D"
+to retrieve the matrices, see @ref Flat-multiview "Shaders::Flat" for an
+example.
+
+@anchor SceneGraph-StereoCamera-culling
+## Frustum culling
+
+Every time an eye is set up, @ref projectionMatrix() is replaced with a
+single frustum enclosing the frusta of both eyes, so @ref drawCulled() tests
+each bounding box only once for both eyes. The combined frustum is computed
+from the translation part of the eye transformations and assumes that the
+eyes have the same orientation as the camera object and are offset only in
+its XY plane, which is the case for usual head-mounted displays. Calling
+@ref setProjectionMatrix() directly overwrites the combined frustum until
+an eye is set up again. The aspect ratio policy is applied only to the
+combined frustum, not to the eye projections, so it's recommended to leave it
+at @ref AspectRatioPolicy::NotPreserved.
+
+@anchor SceneGraph-StereoCamera-explicit-specializations
+## Explicit template specializations
+
+The following specialization is explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type) you have to use @ref StereoCamera.hpp implementation file to avoid
+linker errors. See also @ref compilation-speedup-hpp for more information.
+
+-   @ref StereoCamera3D
+
+@see @ref scenegraph, @ref StereoCamera3D, @ref Camera, @ref Drawable
+*/
+template<class T> class BasicStereoCamera3D: public Camera<3, T> {
+    public:
+        /**
+         * @brief Eye
+         *
+         * @see @ref setEye(), @ref viewProjectionMatrix()
+         */
+        enum class Eye: UnsignedByte {
+            Left = 0,   /**< Left eye, rendered to view `0` */
+            Right = 1   /**< Right eye, rendered to view `1` */
+        };
+
+        /**
+         * @brief Constructor
+         * @param object        Object holding the camera
+         *
+         * Both eyes are placed at the camera origin with projection to the
+         * default OpenGL cube.
+         * @see @ref setEye()
+         */
+        explicit BasicStereoCamera3D(AbstractObject<3, T>& object);
+
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        /* This is here to avoid ambiguity with deleted copy constructor when
+           passing `*this` from class subclassing both BasicStereoCamera3D and
+           AbstractObject */
+        template<class U, class = typename std::enable_if<std::is_base_of<AbstractObject<3, T>, U>::value>::type> BasicStereoCamera3D(U& object): BasicStereoCamera3D<T>{static_cast<AbstractObject<3, T>&>(object)} {}
+        #endif
+
+        /**
+         * @brief Set up an eye
+         * @param eye               Eye to set up
+         * @param projection        Eye projection matrix
+         * @param transformation    Eye transformation relative to the camera
+         *      object
+         * @return Reference to self (for method chaining)
+         *
+         * Updates @ref viewProjectionMatrix() for given eye and recalculates
+         * the combined frustum used for culling. See
+         * @ref SceneGraph-StereoCamera-culling "above" for restrictions on
+         * @p transformation.
+         */
+        BasicStereoCamera3D<T>& setEye(Eye eye, const Math::Matrix4<T>& projection, const Math::Matrix4<T>& transformation);
+
+        /**
+         * @brief Set up both eyes
+         * @param interpupillaryDistance    Distance between the eyes
+         * @param projection                Projection matrix of both eyes
+         * @return Reference to self (for method chaining)
+         *
+         * Convenience alternative to @ref setEye() for eyes sharing the same
+         * projection, offset by half of @p interpupillaryDistance to the left
+         * and right of the camera object.
+         */
+        BasicStereoCamera3D<T>& setEyes(T interpupillaryDistance, const Math::Matrix4<T>& projection);
+
+        /** @brief Eye projection matrix */
+        Math::Matrix4<T> eyeProjectionMatrix(Eye eye) const {
+            return _eyes[UnsignedInt(eye)].projection;
+        }
+
+        /** @brief Eye transformation relative to the camera object */
+        Math::Matrix4<T> eyeTransformationMatrix(Eye eye) const {
+            return _eyes[UnsignedInt(eye)].transformation;
+        }
+
+        /**
+         * @brief Eye view projection matrix
+         *
+         * Eye projection matrix multiplied with inverted eye transformation.
+         * Transforms from camera object space to clip space of given eye,
+         * thus applied after the transformation passed to
+         * @ref Drawable::draw().
+         * @see @ref Shaders::Flat::setViewProjectionMatrices(),
+         *      @ref Shaders::Phong::setViewProjectionMatrices()
+         */
+        Math::Matrix4<T> viewProjectionMatrix(Eye eye) const {
+            return _eyes[UnsignedInt(eye)].viewProjection;
+        }
+
+    private:
+        struct EyeData {
+            Math::Matrix4<T> projection, transformation, viewProjection;
+        };
+
+        void updateCombinedFrustum();
+
+        EyeData _eyes[2];
+};
+
+/**
+@brief Stereo camera for three-dimensional float scenes
+
+@see @ref Camera3D
+*/
+typedef BasicStereoCamera3D<Float> StereoCamera3D;
+
+#if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
+extern template class MAGNUM_SCENEGRAPH_EXPORT BasicStereoCamera3D<Float>;
+#endif
+
+}}
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef Magnum_SceneGraph_StereoCamera_hpp
+#define Magnum_SceneGraph_StereoCamera_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref StereoCamera.h
+ */
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/SceneGraph/Camera.hpp"
+#include "Magnum/SceneGraph/StereoCamera.h"
+
+namespace Magnum { namespace SceneGraph {
+
+template<class T> BasicStereoCamera3D<T>::BasicStereoCamera3D(AbstractObject<3, T>& object): Camera<3, T>{object} {}
+
+template<class T> BasicStereoCamera3D<T>& BasicStereoCamera3D<T>::setEye(const Eye eye, const Math::Matrix4<T>& projection, const Math::Matrix4<T>& transformation) {
+    EyeData& data = _eyes[UnsignedInt(eye)];
+    data.projection = projection;
+    data.transformation = transformation;
+    data.viewProjection = projection*transformation.inverted();
+    updateCombinedFrustum();
+    return *this;
+}
+
+template<class T> BasicStereoCamera3D<T>& BasicStereoCamera3D<T>::setEyes(const T interpupillaryDistance, const Math::Matrix4<T>& projection) {
+    const Math::Vector3<T> offset = Math::Vector3<T>::xAxis(interpupillaryDistance/T(2));
+    setEye(Eye::Left, projection, Math::Matrix4<T>::translation(-offset));
+    return setEye(Eye::Right, projection, Math::Matrix4<T>::translation(offset));
+}
+
+template<class T> void BasicStereoCamera3D<T>::updateCombinedFrustum() {
+    /* Frustum of each eye as tangents of the left/right/bottom/top planes,
+       near and far distance and eye offset, combined into a frustum with
+       tangents enclosing both eyes */
+    T left = Math::Constants<T>::inf(), right = -Math::Constants<T>::inf(),
+      bottom = Math::Constants<T>::inf(), top = -Math::Constants<T>::inf(),
+      near = Math::Constants<T>::inf(), far = T(0);
+    Math::Vector2<T> min{Math::Constants<T>::inf()}, max{-Math::Constants<T>::inf()};
+    for(const EyeData& eye: _eyes) {
+        const Math::Matrix4<T>& m = eye.projection;
+
+        /* Orthographic projection, the combined frustum can't be expressed
+           as a perspective one. Use the first eye only. */
+        if(m[2][3] == T(0)) {
+            Camera<3, T>::setProjectionMatrix(_eyes[0].viewProjection);
+            return;
+        }
+
+        left = Math::min(left, (m[2][0] - T(1))/m[0][0]);
+        right = Math::max(right, (m[2][0] + T(1))/m[0][0]);
+        bottom = Math::min(bottom, (m[2][1] - T(1))/m[1][1]);
+        top = Math::max(top, (m[2][1] + T(1))/m[1][1]);
+        near = Math::min(near, m[3][2]/(m[2][2] - T(1)));
+        far = Math::max(far, m[2][2] == T(-1) ? Math::Constants<T>::inf() : m[3][2]/(m[2][2] + T(1)));
+
+        const Math::Vector2<T> offset = eye.transformation.translation().xy();
+        min = Math::min(min, offset);
+        max = Math::max(max, offset);
+    }
+
+    /* Move the apex back so the combined frustum contains both eye origins */
+    const T distance = Math::max((max.x() - min.x())/(right - left),
+                                 (max.y() - min.y())/(top - bottom));
+    const Math::Vector3<T> apex{min.x() - left*distance, min.y() - bottom*distance, distance};
+    near += distance;
+    far += distance;
+
+    /* Off-center perspective projection */
+    const T zScale = far == Math::Constants<T>::inf() ? T(-1) : (far + near)/(near - far);
+    const T zOffset = far == Math::Constants<T>::inf() ? T(-2)*near : T(2)*far*near/(near - far);
+    const Math::Matrix4<T> projection{
+        {T(2)/(right - left), T(0), T(0), T(0)},
+        {T(0), T(2)/(top - bottom), T(0), T(0)},
+        {(right + left)/(right - left), (top + bottom)/(top - bottom), zScale, T(-1)},
+        {T(0), T(0), zOffset, T(0)}};
+
+    Camera<3, T>::setProjectionMatrix(projection*Math::Matrix4<T>::translation(-apex));
+}
+
+}}
+
+#endif
@@ -23,12 +23,16 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <memory>
 #include <sstream>
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/SceneGraph/Animable.h"
 #include "Magnum/SceneGraph/AnimableGroup.h"
 #include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include "Magnum/SceneGraph/ThreadPool.h"
+#endif
 
 namespace Magnum { namespace SceneGraph { namespace Test {
 
@@ -42,6 +46,13 @@ struct AnimableTest: TestSuite::Tester {
     void stop();
     void pause();
 
+    void stepCount();
+    void activityCallback();
+    void removeRunning();
+    void destroyRunning();
+    void moveRunning();
+    void stepParallel();
+
     void debug();
 };
 
@@ -55,6 +66,13 @@ AnimableTest::AnimableTest() {
               &AnimableTest::stop,
               &AnimableTest::pause,
 
+              &AnimableTest::stepCount,
+              &AnimableTest::activityCallback,
+              &AnimableTest::removeRunning,
+              &AnimableTest::destroyRunning,
+              &AnimableTest::moveRunning,
+              &AnimableTest::stepParallel,
+
               &AnimableTest::debug});
 }
 
@@ -351,6 +369,189 @@ void AnimableTest::pause() {
     CORRADE_COMPARE(animable.time, 2.0f);
 }
 
+namespace {
+
+class CountingAnimable: public SceneGraph::Animable3D {
+    public:
+        CountingAnimable(AbstractObject3D& object, AnimableGroup3D* group = nullptr): SceneGraph::Animable3D(object, group), steps(0) {}
+
+        Int steps;
+
+    protected:
+        void animationStep(Float, Float) override { ++steps; }
+};
+
+}
+
+void AnimableTest::stepCount() {
+    Object3D object;
+    AnimableGroup3D group;
+    std::vector<std::unique_ptr<CountingAnimable>> animables;
+    for(std::size_t i = 0; i != 100; ++i)
+        animables.emplace_back(new CountingAnimable{object, &group});
+
+    /* Only every tenth is running */
+    for(std::size_t i = 0; i < animables.size(); i += 10)
+        animables[i]->setState(AnimationState::Running);
+    group.step(1.0f, 0.5f);
+    CORRADE_COMPARE(group.size(), 100);
+    CORRADE_COMPARE(group.runningCount(), 10);
+    CORRADE_COMPARE(group.stepCount(), 10);
+
+    /* Pausing removes it from the running list, others are still stepped */
+    animables[20]->setState(AnimationState::Paused);
+    group.step(1.5f, 0.5f);
+    CORRADE_COMPARE(group.runningCount(), 9);
+    CORRADE_COMPARE(group.stepCount(), 9);
+    CORRADE_COMPARE(animables[0]->steps, 2);
+    CORRADE_COMPARE(animables[20]->steps, 1);
+    CORRADE_COMPARE(animables[90]->steps, 2);
+    CORRADE_COMPARE(animables[1]->steps, 0);
+
+    /* Stopping all of them puts the group to rest */
+    for(std::size_t i = 0; i < animables.size(); i += 10)
+        animables[i]->setState(AnimationState::Stopped);
+    group.step(2.0f, 0.5f);
+    CORRADE_COMPARE(group.runningCount(), 0);
+    CORRADE_COMPARE(group.stepCount(), 0);
+}
+
+void AnimableTest::activityCallback() {
+    class OneSecondAnimable: public SceneGraph::Animable3D {
+        public:
+            OneSecondAnimable(AbstractObject3D& object, AnimableGroup3D* group = nullptr): SceneGraph::Animable3D(object, group) {
+                setDuration(1.0f);
+            }
+
+        protected:
+            void animationStep(Float, Float) override {}
+    };
+
+    Object3D object;
+    AnimableGroup3D group;
+    Int called = 0;
+    group.setActivityCallback([&called]() { ++called; });
+
+    /* Idle group doesn't call anything */
+    OneSecondAnimable a{object, &group};
+    group.step(1.0f, 0.5f);
+    CORRADE_COMPARE(called, 0);
+
+    /* Starting the animation calls it, as does each step while running */
+    a.setState(AnimationState::Running);
+    CORRADE_COMPARE(called, 1);
+    group.step(1.0f, 0.5f);
+    CORRADE_COMPARE(called, 2);
+    group.step(1.5f, 0.5f);
+    CORRADE_COMPARE(called, 3);
+
+    /* The step that stops the animation doesn't call it anymore */
+    group.step(2.5f, 0.5f);
+    CORRADE_COMPARE(group.runningCount(), 0);
+    CORRADE_COMPARE(called, 3);
+
+    /* Adding a running animation from another group calls it too */
+    AnimableGroup3D other;
+    CountingAnimable b{object, &other};
+    b.setState(AnimationState::Running);
+    other.step(1.0f, 0.5f);
+    group.add(b);
+    CORRADE_COMPARE(called, 4);
+}
+
+void AnimableTest::removeRunning() {
+    Object3D object;
+    AnimableGroup3D group;
+    CountingAnimable a{object, &group};
+    CountingAnimable b{object, &group};
+    a.setState(AnimationState::Running);
+    b.setState(AnimationState::Running);
+    group.step(1.0f, 0.5f);
+    CORRADE_COMPARE(group.runningCount(), 2);
+
+    group.remove(a);
+    CORRADE_COMPARE(group.runningCount(), 1);
+    group.step(1.5f, 0.5f);
+    CORRADE_COMPARE(a.steps, 1);
+    CORRADE_COMPARE(b.steps, 2);
+    CORRADE_COMPARE(a.state(), AnimationState::Running);
+}
+
+void AnimableTest::destroyRunning() {
+    Object3D object;
+    AnimableGroup3D group;
+    CountingAnimable a{object, &group};
+    {
+        CountingAnimable b{object, &group};
+        CountingAnimable c{object, &group};
+        a.setState(AnimationState::Running);
+        b.setState(AnimationState::Running);
+        group.step(1.0f, 0.5f);
+        CORRADE_COMPARE(group.runningCount(), 2);
+
+        /* Has a pending state change */
+        c.setState(AnimationState::Running);
+    }
+
+    CORRADE_COMPARE(group.size(), 1);
+    CORRADE_COMPARE(group.runningCount(), 1);
+    group.step(1.5f, 0.5f);
+    CORRADE_COMPARE(group.stepCount(), 1);
+    CORRADE_COMPARE(a.steps, 2);
+}
+
+void AnimableTest::moveRunning() {
+    Object3D object;
+    AnimableGroup3D group1, group2;
+    CountingAnimable animable{object, &group1};
+    animable.setState(AnimationState::Running);
+    group1.step(1.0f, 0.5f);
+    CORRADE_COMPARE(group1.runningCount(), 1);
+
+    /* Keeps running in the other group */
+    group2.add(animable);
+    CORRADE_COMPARE(group1.runningCount(), 0);
+    CORRADE_COMPARE(group2.runningCount(), 1);
+    group1.step(1.5f, 0.5f);
+    group2.step(1.5f, 0.5f);
+    CORRADE_COMPARE(animable.steps, 2);
+
+    /* Unprocessed state change is moved along */
+    animable.setState(AnimationState::Paused);
+    group1.add(animable);
+    group1.step(2.0f, 0.5f);
+    CORRADE_COMPARE(group1.runningCount(), 0);
+    CORRADE_COMPARE(group2.runningCount(), 0);
+    CORRADE_COMPARE(animable.steps, 2);
+}
+
+void AnimableTest::stepParallel() {
+    #ifdef CORRADE_TARGET_EMSCRIPTEN
+    CORRADE_SKIP("Threads are not available on Emscripten.");
+    #else
+    Object3D object;
+    AnimableGroup3D group;
+    std::vector<std::unique_ptr<CountingAnimable>> animables;
+    for(std::size_t i = 0; i != 2000; ++i) {
+        animables.emplace_back(new CountingAnimable{object, &group});
+        /* Every other is thread-safe */
+        animables.back()->setThreadSafe(i % 2 == 0)
+            .setState(AnimationState::Running);
+    }
+    CORRADE_VERIFY(animables[0]->isThreadSafe());
+    CORRADE_VERIFY(!animables[1]->isThreadSafe());
+
+    ThreadPool pool{3};
+    group.step(1.0f, 0.5f, pool);
+    group.step(1.5f, 0.5f, pool);
+    CORRADE_COMPARE(group.runningCount(), 2000);
+    CORRADE_COMPARE(group.stepCount(), 2000);
+    for(std::size_t i = 0; i != animables.size(); ++i) {
+        CORRADE_COMPARE(animables[i]->steps, 2);
+    }
+    #endif
+}
+
 void AnimableTest::debug() {
     std::ostringstream o;
     Debug(&o) << AnimationState::Running << AnimationState(0xbe);
@@ -0,0 +1,391 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/SceneGraph/BoundingVolumeHierarchy.h"
+#include "Magnum/SceneGraph/MatrixTransformation2D.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation2D> Scene2D;
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+struct BoundingVolumeHierarchyTest: TestSuite::Tester {
+    explicit BoundingVolumeHierarchyTest();
+
+    void construct();
+    void absoluteBounds();
+    void setBounds();
+
+    void volumesInRegion();
+    void volumesInRadius();
+    void volumesInFrustum();
+    void raycast();
+    void volumes2D();
+
+    void refit();
+    void refitParent();
+    void rebuild();
+    void addRemove();
+};
+
+BoundingVolumeHierarchyTest::BoundingVolumeHierarchyTest() {
+    addTests({&BoundingVolumeHierarchyTest::construct,
+              &BoundingVolumeHierarchyTest::absoluteBounds,
+              &BoundingVolumeHierarchyTest::setBounds,
+
+              &BoundingVolumeHierarchyTest::volumesInRegion,
+              &BoundingVolumeHierarchyTest::volumesInRadius,
+              &BoundingVolumeHierarchyTest::volumesInFrustum,
+              &BoundingVolumeHierarchyTest::raycast,
+              &BoundingVolumeHierarchyTest::volumes2D,
+
+              &BoundingVolumeHierarchyTest::refit,
+              &BoundingVolumeHierarchyTest::refitParent,
+              &BoundingVolumeHierarchyTest::rebuild,
+              &BoundingVolumeHierarchyTest::addRemove});
+}
+
+namespace {
+
+/* Deterministic pseudo-random positions in range [-50, 50] */
+struct Random {
+    Float operator()() {
+        state = state*1103515245u + 12345u;
+        return Float((state >> 8) & 0xffff)/Float(0xffff)*100.0f - 50.0f;
+    }
+
+    UnsignedInt state = 3;
+};
+
+/* Unit cubes scattered around the scene */
+struct Scattered {
+    explicit Scattered(std::size_t count) {
+        Random random;
+        for(std::size_t i = 0; i != count; ++i) {
+            objects.emplace_back(new Object3D{&scene});
+            objects.back()->translate({random(), random(), random()});
+            new BoundingVolume3D{*objects.back(), {Vector3{-0.5f}, Vector3{0.5f}}, &volumes};
+        }
+    }
+
+    Scene3D scene;
+    BoundingVolumeHierarchy3D volumes;
+    std::vector<Object3D*> objects;
+};
+
+bool intersects(const Range3D& a, const Range3D& b) {
+    return (a.min() <= b.max()).all() && (b.min() <= a.max()).all();
+}
+
+}
+
+void BoundingVolumeHierarchyTest::construct() {
+    BoundingVolumeHierarchy3D volumes;
+    CORRADE_VERIFY(volumes.isDirty());
+    CORRADE_COMPARE(volumes.rebuildThreshold(), 1.5f);
+    CORRADE_COMPARE(volumes.rebuildCount(), 0);
+
+    CORRADE_VERIFY(volumes.volumesInRegion({Vector3{-100.0f}, Vector3{100.0f}}).empty());
+    CORRADE_VERIFY(volumes.raycast({}, Vector3::zAxis()).empty());
+    CORRADE_VERIFY(!volumes.isDirty());
+    CORRADE_COMPARE(volumes.rebuildCount(), 1);
+    CORRADE_COMPARE(volumes.cost(), 0.0f);
+}
+
+void BoundingVolumeHierarchyTest::absoluteBounds() {
+    Scene3D scene;
+    Object3D parent{&scene};
+    Object3D object{&parent};
+    BoundingVolume3D volume{object, {{0.0f, -1.0f, -2.0f}, {2.0f, 1.0f, 2.0f}}};
+    CORRADE_VERIFY(!volume.hierarchy());
+    CORRADE_COMPARE(volume.bounds(), (Range3D{{0.0f, -1.0f, -2.0f}, {2.0f, 1.0f, 2.0f}}));
+
+    /* Rotation by 90° around Y swaps X and Z */
+    object.rotateY(Deg(90.0f));
+    parent.translate({10.0f, 0.0f, 0.0f})
+        .scale(Vector3{2.0f});
+    CORRADE_COMPARE(volume.absoluteBounds(), (Range3D{{16.0f, -2.0f, -4.0f}, {24.0f, 2.0f, 0.0f}}));
+}
+
+void BoundingVolumeHierarchyTest::setBounds() {
+    Scene3D scene;
+    Object3D object{&scene};
+    object.translate(Vector3::xAxis(5.0f));
+
+    BoundingVolumeHierarchy3D volumes;
+    BoundingVolume3D volume{object, {Vector3{-1.0f}, Vector3{1.0f}}, &volumes};
+    CORRADE_VERIFY(volume.hierarchy() == &volumes);
+    CORRADE_COMPARE(volumes.volumesInRegion({{5.5f, 0.5f, 0.5f}, {7.0f, 3.0f, 3.0f}}).size(), 1);
+
+    volume.setBounds({Vector3{-0.25f}, Vector3{0.25f}});
+    CORRADE_VERIFY(volumes.isDirty());
+    CORRADE_COMPARE(volumes.volumesInRegion({{5.5f, 0.5f, 0.5f}, {7.0f, 3.0f, 3.0f}}).size(), 0);
+    CORRADE_COMPARE(volume.absoluteBounds(), (Range3D{{4.75f, -0.25f, -0.25f}, {5.25f, 0.25f, 0.25f}}));
+    CORRADE_COMPARE(volumes.refitCount(), 1);
+}
+
+void BoundingVolumeHierarchyTest::volumesInRegion() {
+    Scattered s{300};
+
+    Random random;
+    for(std::size_t i = 0; i != 20; ++i) {
+        const Vector3 min{random(), random(), random()};
+        const Range3D region{min, min + Vector3{Float(i)}};
+
+        std::vector<BoundingVolume3D*> expected;
+        for(std::size_t j = 0; j != s.volumes.size(); ++j)
+            if(intersects(s.volumes[j].absoluteBounds(), region))
+                expected.push_back(&s.volumes[j]);
+
+        CORRADE_COMPARE_AS(s.volumes.volumesInRegion(region), expected, TestSuite::Compare::Container);
+    }
+
+    CORRADE_COMPARE(s.volumes.volumesInRegion({Vector3{-100.0f}, Vector3{100.0f}}).size(), 300);
+}
+
+void BoundingVolumeHierarchyTest::volumesInRadius() {
+    Scattered s{300};
+
+    Random random;
+    for(std::size_t i = 0; i != 20; ++i) {
+        const Vector3 center{random(), random(), random()};
+        const Float radius = i*1.5f;
+
+        std::vector<BoundingVolume3D*> expected;
+        for(std::size_t j = 0; j != s.volumes.size(); ++j) {
+            const Range3D bounds = s.volumes[j].absoluteBounds();
+            if((Math::clamp(center, bounds.min(), bounds.max()) - center).length() <= radius)
+                expected.push_back(&s.volumes[j]);
+        }
+
+        CORRADE_COMPARE_AS(s.volumes.volumesInRadius(center, radius), expected, TestSuite::Compare::Container);
+    }
+}
+
+void BoundingVolumeHierarchyTest::volumesInFrustum() {
+    Scene3D scene;
+    BoundingVolumeHierarchy3D volumes;
+
+    /* In front of the camera, behind it, off to the side and one crossing the
+       side plane */
+    Object3D a{&scene};
+    a.translate({0.0f, 0.0f, -10.0f});
+    BoundingVolume3D aVolume{a, {Vector3{-1.0f}, Vector3{1.0f}}, &volumes};
+    Object3D b{&scene};
+    b.translate({0.0f, 0.0f, 10.0f});
+    BoundingVolume3D bVolume{b, {Vector3{-1.0f}, Vector3{1.0f}}, &volumes};
+    Object3D c{&scene};
+    c.translate({30.0f, 0.0f, -10.0f});
+    BoundingVolume3D cVolume{c, {Vector3{-1.0f}, Vector3{1.0f}}, &volumes};
+    Object3D d{&scene};
+    d.translate({10.5f, 0.0f, -10.0f});
+    BoundingVolume3D dVolume{d, {Vector3{-1.0f}, Vector3{1.0f}}, &volumes};
+
+    /* 90° field of view, camera at origin looking down -Z */
+    const Matrix4 projection = Matrix4::perspectiveProjection(Deg(90.0f), 1.0f, 0.1f, 100.0f);
+    CORRADE_COMPARE(volumes.volumesInFrustum(projection),
+        (std::vector<BoundingVolume3D*>{&aVolume, &dVolume}));
+
+    /* Camera moved to the right, given as inverted transformation */
+    CORRADE_COMPARE(volumes.volumesInFrustum(projection*Matrix4::translation({-30.0f, 0.0f, 0.0f})),
+        (std::vector<BoundingVolume3D*>{&cVolume}));
+}
+
+void BoundingVolumeHierarchyTest::raycast() {
+    Scattered s{300};
+
+    Random random;
+    for(std::size_t i = 0; i != 20; ++i) {
+        const Vector3 origin{random(), random(), random()};
+        const Vector3 direction = Vector3{random(), random(), random()}.normalized();
+        const Float maxDistance = i == 0 ? Constants::inf() : i*5.0f;
+
+        std::vector<std::pair<Float, BoundingVolume3D*>> expected;
+        for(std::size_t j = 0; j != s.volumes.size(); ++j) {
+            /* Brute-force test stepping along the ray */
+            const Range3D bounds = s.volumes[j].absoluteBounds();
+            for(Float t = 0.0f; t < std::min(maxDistance, 200.0f); t += 0.01f) {
+                const Vector3 point = origin + direction*t;
+                if((bounds.min() <= point).all() && (point <= bounds.max()).all()) {
+                    expected.emplace_back(t, &s.volumes[j]);
+                    break;
+                }
+            }
+        }
+        std::sort(expected.begin(), expected.end());
+
+        const std::vector<std::pair<BoundingVolume3D*, Float>> hits = s.volumes.raycast(origin, direction, maxDistance);
+        CORRADE_COMPARE(hits.size(), expected.size());
+        for(std::size_t j = 0; j != std::min(hits.size(), expected.size()); ++j) {
+            CORRADE_VERIFY(hits[j].first == expected[j].second);
+            CORRADE_VERIFY(Math::abs(hits[j].second - expected[j].first) < 0.011f);
+        }
+    }
+
+    /* Origin inside a volume has zero distance */
+    const Vector3 inside = s.volumes[17].absoluteBounds().center();
+    const std::vector<std::pair<BoundingVolume3D*, Float>> hits = s.volumes.raycast(inside, Vector3::xAxis());
+    CORRADE_VERIFY(!hits.empty());
+    CORRADE_VERIFY(hits[0].first == &s.volumes[17]);
+    CORRADE_COMPARE(hits[0].second, 0.0f);
+}
+
+void BoundingVolumeHierarchyTest::volumes2D() {
+    Scene2D scene;
+    BoundingVolumeHierarchy2D volumes;
+
+    Object2D a{&scene};
+    a.translate({-5.0f, 0.0f});
+    BoundingVolume2D aVolume{a, {Vector2{-1.0f}, Vector2{1.0f}}, &volumes};
+    Object2D b{&scene};
+    b.rotate(Deg(45.0f))
+     .translate({5.0f, 0.0f});
+    BoundingVolume2D bVolume{b, {Vector2{-1.0f}, Vector2{1.0f}}, &volumes};
+    Object2D c{&scene};
+    c.translate({0.0f, 8.0f});
+    BoundingVolume2D cVolume{c, {Vector2{-1.0f}, Vector2{1.0f}}, &volumes};
+
+    CORRADE_COMPARE(volumes.volumesInRegion({{-4.5f, -0.5f}, {6.3f, 0.5f}}),
+        (std::vector<BoundingVolume2D*>{&aVolume, &bVolume}));
+    CORRADE_COMPARE(volumes.volumesInRadius({0.0f, 5.0f}, 2.5f),
+        (std::vector<BoundingVolume2D*>{&cVolume}));
+
+    const std::vector<std::pair<BoundingVolume2D*, Float>> hits = volumes.raycast({-10.0f, 0.0f}, Vector2::xAxis());
+    CORRADE_COMPARE(hits.size(), 2);
+    CORRADE_VERIFY(hits[0].first == &aVolume);
+    CORRADE_COMPARE(hits[0].second, 4.0f);
+    CORRADE_VERIFY(hits[1].first == &bVolume);
+    CORRADE_COMPARE(hits[1].second, 15.0f - Constants::sqrt2());
+
+    /* Everything inside the default [-1, 1] clip space */
+    CORRADE_COMPARE(volumes.volumesInFrustum(Matrix3::scaling(Vector2{0.2f})),
+        (std::vector<BoundingVolume2D*>{&aVolume, &bVolume}));
+}
+
+void BoundingVolumeHierarchyTest::refit() {
+    Scattered s{100};
+    s.volumes.update();
+    CORRADE_COMPARE(s.volumes.rebuildCount(), 1);
+    CORRADE_VERIFY(s.volumes.cost() > 1.0f);
+
+    /* Nothing changed, nothing is done */
+    s.volumes.update();
+    CORRADE_COMPARE(s.volumes.rebuildCount(), 1);
+    CORRADE_COMPARE(s.volumes.refitCount(), 0);
+
+    /* Moving one object refits only its leaf */
+    s.objects[42]->translate(Vector3::xAxis(0.5f));
+    CORRADE_VERIFY(s.volumes.isDirty());
+    const Range3D bounds = s.volumes[42].absoluteBounds();
+    CORRADE_VERIFY(s.volumes.volumesInRegion(bounds) == std::vector<BoundingVolume3D*>{&s.volumes[42]});
+    CORRADE_COMPARE(s.volumes.refitCount(), 1);
+    CORRADE_COMPARE(s.volumes.rebuildCount(), 1);
+}
+
+void BoundingVolumeHierarchyTest::refitParent() {
+    Scene3D scene;
+    BoundingVolumeHierarchy3D volumes;
+
+    Object3D parent{&scene};
+    Object3D a{&parent};
+    a.translate(Vector3::xAxis(1.0f));
+    BoundingVolume3D aVolume{a, {Vector3{-0.5f}, Vector3{0.5f}}, &volumes};
+    Object3D b{&parent};
+    b.translate(Vector3::xAxis(-1.0f));
+    BoundingVolume3D bVolume{b, {Vector3{-0.5f}, Vector3{0.5f}}, &volumes};
+    Object3D c{&scene};
+    BoundingVolume3D cVolume{c, {Vector3{-0.5f}, Vector3{0.5f}}, &volumes};
+    volumes.update();
+
+    /* Moving the parent marks both children dirty */
+    parent.translate(Vector3::yAxis(10.0f));
+    CORRADE_COMPARE(volumes.volumesInRadius({0.0f, 10.0f, 0.0f}, 2.0f),
+        (std::vector<BoundingVolume3D*>{&aVolume, &bVolume}));
+    CORRADE_COMPARE(volumes.refitCount(), 2);
+    CORRADE_COMPARE(volumes.volumesInRadius({}, 2.0f),
+        (std::vector<BoundingVolume3D*>{&cVolume}));
+}
+
+void BoundingVolumeHierarchyTest::rebuild() {
+    Scattered s{100};
+    s.volumes.update();
+    const Float cost = s.volumes.cost();
+
+    /* Swapping far away objects degrades the tree a lot */
+    for(std::size_t i = 0; i != 50; ++i) {
+        const Vector3 a = s.objects[i]->transformation().translation();
+        const Vector3 b = s.objects[99 - i]->transformation().translation();
+        s.objects[i]->setTransformation(Matrix4::translation(b));
+        s.objects[99 - i]->setTransformation(Matrix4::translation(a));
+    }
+
+    /* With infinite threshold the tree is only refitted */
+    s.volumes.setRebuildThreshold(Constants::inf());
+    CORRADE_COMPARE(s.volumes.rebuildThreshold(), Constants::inf());
+    s.volumes.update();
+    CORRADE_COMPARE(s.volumes.refitCount(), 100);
+    CORRADE_COMPARE(s.volumes.rebuildCount(), 1);
+    CORRADE_VERIFY(s.volumes.cost() > cost*1.5f);
+    CORRADE_COMPARE(s.volumes.volumesInRegion({Vector3{-100.0f}, Vector3{100.0f}}).size(), 100);
+
+    /* Moving anything with the default threshold triggers a rebuild */
+    s.volumes.setRebuildThreshold(1.5f);
+    s.objects[0]->translate(Vector3::xAxis(0.1f));
+    s.volumes.update();
+    CORRADE_COMPARE(s.volumes.rebuildCount(), 2);
+    CORRADE_COMPARE(s.volumes.cost(), cost);
+    CORRADE_COMPARE(s.volumes.volumesInRegion({Vector3{-100.0f}, Vector3{100.0f}}).size(), 100);
+}
+
+void BoundingVolumeHierarchyTest::addRemove() {
+    Scattered s{50};
+    s.volumes.update();
+    CORRADE_COMPARE(s.volumes.rebuildCount(), 1);
+
+    Object3D object{&s.scene};
+    object.translate(Vector3{200.0f});
+    BoundingVolume3D volume{object, {Vector3{-0.5f}, Vector3{0.5f}}, &s.volumes};
+    CORRADE_COMPARE(s.volumes.volumesInRadius(Vector3{200.0f}, 1.0f),
+        (std::vector<BoundingVolume3D*>{&volume}));
+    CORRADE_COMPARE(s.volumes.rebuildCount(), 2);
+
+    s.volumes.remove(volume);
+    CORRADE_VERIFY(s.volumes.volumesInRadius(Vector3{200.0f}, 1.0f).empty());
+    CORRADE_COMPARE(s.volumes.rebuildCount(), 3);
+    CORRADE_COMPARE(s.volumes.volumesInRegion({Vector3{-100.0f}, Vector3{100.0f}}).size(), 50);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::BoundingVolumeHierarchyTest)
@@ -26,6 +26,7 @@
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/SceneGraph/Camera.hpp" /* only for aspectRatioFix(), so it doesn't have to be exported */
+#include "Magnum/SceneGraph/AbstractJobSystem.h"
 #include "Magnum/SceneGraph/Camera.h"
 #include "Magnum/SceneGraph/Drawable.h"
 #include "Magnum/SceneGraph/MatrixTransformation2D.h"
@@ -46,10 +47,15 @@ struct CameraTest: TestSuite::Tester {
     void projectionSizePerspective();
     void projectionSizeViewport();
     void draw();
+    void drawJobSystem();
+    void drawArena();
+    void drawCulled2D();
+    void drawCulled3D();
 };
 
 typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
 typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation2D> Scene2D;
 typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
 
 CameraTest::CameraTest() {
@@ -61,7 +67,11 @@ CameraTest::CameraTest() {
               &CameraTest::projectionSizeOrthographic,
               &CameraTest::projectionSizePerspective,
               &CameraTest::projectionSizeViewport,
-              &CameraTest::draw});
+              &CameraTest::draw,
+              &CameraTest::drawJobSystem,
+              &CameraTest::drawArena,
+              &CameraTest::drawCulled2D,
+              &CameraTest::drawCulled3D});
 }
 
 void CameraTest::fixAspectRatio() {
@@ -210,6 +220,204 @@ void CameraTest::draw() {
     CORRADE_COMPARE(thirdTransformation, Matrix4());
 }
 
+void CameraTest::drawJobSystem() {
+    class Drawable: public SceneGraph::Drawable3D {
+        public:
+            Drawable(AbstractObject3D& object, DrawableGroup3D* group, std::vector<Matrix4>& result): SceneGraph::Drawable3D(object, group), result(result) {}
+
+        protected:
+            void draw(const Matrix4& transformationMatrix, Camera3D&) override {
+                result.push_back(transformationMatrix);
+            }
+
+        private:
+            std::vector<Matrix4>& result;
+    };
+
+    class JobSystem: public AbstractJobSystem {
+        public:
+            std::size_t jobCount = 0;
+
+        private:
+            std::size_t doWorkerCount() const override { return 2; }
+
+            void doRun(std::size_t jobCount, const std::function<void(std::size_t)>& job) override {
+                this->jobCount = jobCount;
+                for(std::size_t i = 0; i != jobCount; ++i) job(i);
+            }
+    };
+
+    DrawableGroup3D group;
+    Scene3D scene;
+    std::vector<Matrix4> result;
+    std::vector<Matrix4> expected;
+
+    for(Int i = 0; i != 150; ++i) {
+        Object3D* object = new Object3D{&scene};
+        object->translate(Vector3::xAxis(Float(i)));
+        new Drawable(*object, &group, result);
+        expected.push_back(Matrix4::translation({Float(i), 0.0f, -1.5f}));
+    }
+
+    Object3D cameraObject(&scene);
+    cameraObject.translate(Vector3::zAxis(1.5f));
+    Camera3D camera(cameraObject);
+
+    JobSystem jobSystem;
+    camera.draw(group, jobSystem);
+    CORRADE_COMPARE(jobSystem.jobCount, 3);
+    CORRADE_COMPARE(result, expected);
+}
+
+void CameraTest::drawArena() {
+    class Drawable: public SceneGraph::Drawable3D {
+        public:
+            Drawable(AbstractObject3D& object, DrawableGroup3D* group, std::vector<Matrix4>& result): SceneGraph::Drawable3D(object, group), result(result) {}
+
+        protected:
+            void draw(const Matrix4& transformationMatrix, Camera3D&) override {
+                result.push_back(transformationMatrix);
+            }
+
+        private:
+            std::vector<Matrix4>& result;
+    };
+
+    DrawableGroup3D group;
+    Scene3D scene;
+    std::vector<Matrix4> result;
+    std::vector<Matrix4> expected;
+
+    for(Int i = 0; i != 150; ++i) {
+        Object3D* object = new Object3D{&scene};
+        object->translate(Vector3::xAxis(Float(i)));
+        new Drawable(*object, &group, result);
+        expected.push_back(Matrix4::translation({Float(i), 0.0f, -1.5f}));
+    }
+
+    Object3D cameraObject(&scene);
+    cameraObject.translate(Vector3::zAxis(1.5f));
+    Camera3D camera(cameraObject);
+
+    /* Too small at first, the heap is used */
+    FrameArena arena{1024};
+    camera.draw(group, arena);
+    CORRADE_COMPARE(result, expected);
+    CORRADE_VERIFY(arena.overflowCount() > 0);
+
+    /* After reset the arena is large enough for the whole frame */
+    arena.reset();
+    result.clear();
+    camera.draw(group, arena);
+    CORRADE_COMPARE(result, expected);
+    CORRADE_COMPARE(arena.overflowCount(), 0);
+}
+
+void CameraTest::drawCulled2D() {
+    class Drawable: public SceneGraph::Drawable2D {
+        public:
+            Drawable(AbstractObject2D& object, DrawableGroup2D* group, Int& drawn): SceneGraph::Drawable2D(object, group), drawn(drawn) {}
+
+        protected:
+            void draw(const Matrix3&, Camera2D&) override {
+                ++drawn;
+            }
+
+        private:
+            Int& drawn;
+    };
+
+    DrawableGroup2D group;
+    Scene2D scene;
+    Int drawn = 0;
+
+    /* Inside */
+    Object2D inside(&scene);
+    (new Drawable(inside, &group, drawn))->setBoundingBox({Vector2{-0.5f}, Vector2{0.5f}});
+
+    /* Rotated box partially overlapping the right edge */
+    Object2D overlapping(&scene);
+    overlapping.rotate(Deg(45.0f))
+        .translate(Vector2::xAxis(2.5f));
+    (new Drawable(overlapping, &group, drawn))->setBoundingBox({Vector2{-0.5f}, Vector2{0.5f}});
+
+    /* Completely outside */
+    Object2D outside(&scene);
+    outside.translate(Vector2::yAxis(5.0f));
+    (new Drawable(outside, &group, drawn))->setBoundingBox({Vector2{-0.5f}, Vector2{0.5f}});
+
+    /* Outside, but without bounding box */
+    Object2D unbounded(&scene);
+    unbounded.translate(Vector2::yAxis(-5.0f));
+    new Drawable(unbounded, &group, drawn);
+
+    Object2D cameraObject(&scene);
+    Camera2D camera(cameraObject);
+    camera.setProjectionMatrix(Matrix3::projection({6.0f, 6.0f}));
+
+    CORRADE_COMPARE(camera.drawCulled(group), 1);
+    CORRADE_COMPARE(drawn, 3);
+}
+
+void CameraTest::drawCulled3D() {
+    class Drawable: public SceneGraph::Drawable3D {
+        public:
+            Drawable(AbstractObject3D& object, DrawableGroup3D* group, Int& drawn): SceneGraph::Drawable3D(object, group), drawn(drawn) {}
+
+        protected:
+            void draw(const Matrix4&, Camera3D&) override {
+                ++drawn;
+            }
+
+        private:
+            Int& drawn;
+    };
+
+    DrawableGroup3D group;
+    Scene3D scene;
+    Int drawn = 0;
+
+    /* In front of the camera */
+    Object3D inside(&scene);
+    inside.translate(Vector3::zAxis(-5.0f));
+    (new Drawable(inside, &group, drawn))->setBoundingBox({Vector3{-1.0f}, Vector3{1.0f}});
+
+    /* Behind the camera */
+    Object3D behind(&scene);
+    behind.translate(Vector3::zAxis(5.0f));
+    (new Drawable(behind, &group, drawn))->setBoundingBox({Vector3{-1.0f}, Vector3{1.0f}});
+
+    /* Beyond the far plane, scaled so it reaches inside the frustum */
+    Object3D scaled(&scene);
+    scaled.scale(Vector3{30.0f})
+        .translate(Vector3::zAxis(-120.0f));
+    (new Drawable(scaled, &group, drawn))->setBoundingBox({Vector3{-1.0f}, Vector3{1.0f}});
+
+    /* Far to the side */
+    Object3D side(&scene);
+    side.translate({50.0f, 0.0f, -5.0f});
+    (new Drawable(side, &group, drawn))->setBoundingBox({Vector3{-1.0f}, Vector3{1.0f}});
+
+    /* Behind the camera, but without bounding box */
+    Object3D unbounded(&scene);
+    unbounded.translate(Vector3::zAxis(5.0f));
+    new Drawable(unbounded, &group, drawn);
+
+    Object3D cameraObject(&scene);
+    Camera3D camera(cameraObject);
+    camera.setProjectionMatrix(Matrix4::perspectiveProjection(Deg(60.0f), 1.0f, 0.1f, 100.0f));
+
+    CORRADE_COMPARE(camera.drawCulled(group), 2);
+    CORRADE_COMPARE(drawn, 3);
+
+    /* Same with a frame arena */
+    FrameArena arena;
+    drawn = 0;
+    CORRADE_COMPARE(camera.drawCulled(group, arena), 2);
+    CORRADE_COMPARE(drawn, 3);
+    CORRADE_COMPARE(arena.overflowCount(), 0);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::CameraTest)
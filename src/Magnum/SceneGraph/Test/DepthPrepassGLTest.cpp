@@ -0,0 +1,184 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Buffer.h"
+#include "Magnum/Color.h"
+#include "Magnum/Framebuffer.h"
+#include "Magnum/Image.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Renderbuffer.h"
+#include "Magnum/RenderbufferFormat.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/DepthPrepass.h"
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+struct DepthPrepassGLTest: OpenGLTester {
+    explicit DepthPrepassGLTest();
+
+    void construct();
+
+    void noDepthMesh();
+    void depthMesh();
+    void disabled();
+};
+
+DepthPrepassGLTest::DepthPrepassGLTest() {
+    addTests({&DepthPrepassGLTest::construct,
+
+              &DepthPrepassGLTest::noDepthMesh,
+              &DepthPrepassGLTest::depthMesh,
+              &DepthPrepassGLTest::disabled});
+}
+
+namespace {
+    struct CountingDrawable: Drawable3D {
+        explicit CountingDrawable(Object3D& object, DrawableGroup3D& group): Drawable3D{object, &group} {}
+
+        void draw(const Matrix4&, Camera3D&) override { ++count; }
+
+        Int count{};
+    };
+
+    /* Fullscreen quad at the depth of the object */
+    constexpr Vector3 QuadVertices[]{
+        {-10.0f, -10.0f, 0.0f},
+        { 10.0f, -10.0f, 0.0f},
+        {-10.0f,  10.0f, 0.0f},
+        { 10.0f,  10.0f, 0.0f}
+    };
+
+    struct Setup {
+        explicit Setup(): framebuffer{{{}, Vector2i{32}}}, cameraObject{&scene}, camera{cameraObject} {
+            #ifndef MAGNUM_TARGET_GLES2
+            color.setStorage(RenderbufferFormat::RGBA8, Vector2i{32});
+            #else
+            color.setStorage(RenderbufferFormat::RGBA4, Vector2i{32});
+            #endif
+            depth.setStorage(RenderbufferFormat::DepthComponent16, Vector2i{32});
+            Renderer::setClearColor(Color4{});
+            framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment{0}, color)
+                .attachRenderbuffer(Framebuffer::BufferAttachment::Depth, depth)
+                .clear(FramebufferClear::Color|FramebufferClear::Depth)
+                .bind();
+
+            camera.setProjectionMatrix(Matrix4::perspectiveProjection(Deg(60.0f), 1.0f, 0.1f, 100.0f));
+
+            vertices.setData(QuadVertices, BufferUsage::StaticDraw);
+            quad.setPrimitive(MeshPrimitive::TriangleStrip)
+                .setCount(4)
+                .addVertexBuffer(vertices, 0, Attribute<0, Vector3>{});
+
+            Renderer::enable(Renderer::Feature::DepthTest);
+        }
+
+        ~Setup() {
+            Renderer::disable(Renderer::Feature::DepthTest);
+        }
+
+        Renderbuffer color, depth;
+        Framebuffer framebuffer;
+        Scene3D scene;
+        Object3D cameraObject;
+        Camera3D camera;
+        DrawableGroup3D drawables;
+        Buffer vertices;
+        Mesh quad;
+    };
+}
+
+void DepthPrepassGLTest::construct() {
+    DepthPrepass prepass;
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(prepass.isEnabled());
+    CORRADE_VERIFY(prepass.depthFunction() == Renderer::DepthFunction::Equal);
+}
+
+void DepthPrepassGLTest::noDepthMesh() {
+    Setup s;
+    Object3D object{&s.scene};
+    object.translate(Vector3::zAxis(-5.0f));
+    CountingDrawable drawable{object, s.drawables};
+
+    DepthPrepass prepass;
+    CORRADE_COMPARE(prepass.draw(s.camera, s.drawables), 0);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(drawable.count, 1);
+}
+
+void DepthPrepassGLTest::depthMesh() {
+    Setup s;
+    Object3D a{&s.scene};
+    a.translate(Vector3::zAxis(-5.0f));
+    CountingDrawable withMesh{a, s.drawables};
+    withMesh.setDepthMesh(&s.quad);
+
+    Object3D b{&s.scene};
+    b.translate(Vector3::zAxis(-3.0f));
+    CountingDrawable withoutMesh{b, s.drawables};
+
+    DepthPrepass prepass;
+    CORRADE_COMPARE(prepass.draw(s.camera, s.drawables), 1);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(withMesh.count, 1);
+    CORRADE_COMPARE(withoutMesh.count, 1);
+
+    /* The quad got into the depth buffer, but not into the color buffer */
+    Image2D image = s.framebuffer.read({{}, Vector2i{32}}, {PixelFormat::RGBA, PixelType::UnsignedByte});
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(image.data<Color4ub>()[16*32 + 16], Color4ub{});
+}
+
+void DepthPrepassGLTest::disabled() {
+    Setup s;
+    Object3D object{&s.scene};
+    object.translate(Vector3::zAxis(-5.0f));
+    CountingDrawable drawable{object, s.drawables};
+    drawable.setDepthMesh(&s.quad);
+
+    DepthPrepass prepass;
+    prepass.setEnabled(false);
+    CORRADE_VERIFY(!prepass.isEnabled());
+    CORRADE_COMPARE(prepass.draw(s.camera, s.drawables), 0);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(drawable.count, 1);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::DepthPrepassGLTest)
@@ -0,0 +1,225 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <atomic>
+#include <cstdint>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/SceneGraph/FrameScheduler.h"
+#include "Magnum/SceneGraph/ThreadPool.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct FrameSchedulerTest: TestSuite::Tester {
+    explicit FrameSchedulerTest();
+
+    void construct();
+    void addTaskInvalidDependency();
+    void addTaskUpdateDependsOnSubmit();
+
+    void notPipelined();
+    void pipelined();
+    void dependencies();
+    void frameValues();
+    void disablePipelining();
+};
+
+FrameSchedulerTest::FrameSchedulerTest() {
+    addTests({&FrameSchedulerTest::construct,
+              &FrameSchedulerTest::addTaskInvalidDependency,
+              &FrameSchedulerTest::addTaskUpdateDependsOnSubmit,
+
+              &FrameSchedulerTest::notPipelined,
+              &FrameSchedulerTest::pipelined,
+              &FrameSchedulerTest::dependencies,
+              &FrameSchedulerTest::frameValues,
+              &FrameSchedulerTest::disablePipelining});
+}
+
+typedef FrameScheduler::Stage Stage;
+typedef FrameScheduler::Frame Frame;
+
+void FrameSchedulerTest::construct() {
+    ThreadPool pool{2};
+    FrameScheduler scheduler{pool};
+    CORRADE_COMPARE(scheduler.taskCount(), 0);
+    CORRADE_VERIFY(scheduler.isPipelined());
+    CORRADE_COMPARE(scheduler.frameCount(), 0);
+
+    /* Executing with no tasks is fine */
+    scheduler.frame(0.0f, 0.0f);
+    scheduler.flush();
+    CORRADE_COMPARE(scheduler.frameCount(), 1);
+}
+
+void FrameSchedulerTest::addTaskInvalidDependency() {
+    ThreadPool pool{0};
+    FrameScheduler scheduler{pool};
+    scheduler.addTask(Stage::Update, [](const Frame&) {});
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    scheduler.addTask(Stage::Update, [](const Frame&) {}, {1});
+    CORRADE_COMPARE(out.str(), "SceneGraph::FrameScheduler::addTask(): dependency 1 out of range for 1 tasks\n");
+}
+
+void FrameSchedulerTest::addTaskUpdateDependsOnSubmit() {
+    ThreadPool pool{0};
+    FrameScheduler scheduler{pool};
+    scheduler.addTask(Stage::Submit, [](const Frame&) {});
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    scheduler.addTask(Stage::Update, [](const Frame&) {}, {0});
+    CORRADE_COMPARE(out.str(), "SceneGraph::FrameScheduler::addTask(): update task can't depend on submit task 0\n");
+}
+
+void FrameSchedulerTest::notPipelined() {
+    ThreadPool pool{2};
+    FrameScheduler scheduler{pool};
+    scheduler.setPipelined(false);
+
+    std::vector<std::uint64_t> updated, submitted;
+    const UnsignedInt update = scheduler.addTask(Stage::Update, [&](const Frame& frame) {
+        updated.push_back(frame.index);
+    });
+    scheduler.addTask(Stage::Submit, [&](const Frame& frame) {
+        submitted.push_back(frame.index);
+    }, {update});
+
+    /* Both stages of the frame are executed right away */
+    scheduler.frame(0.0f, 0.0f);
+    CORRADE_COMPARE(updated, std::vector<std::uint64_t>{0});
+    CORRADE_COMPARE(submitted, std::vector<std::uint64_t>{0});
+
+    scheduler.frame(0.0f, 0.0f);
+    CORRADE_COMPARE(updated, (std::vector<std::uint64_t>{0, 1}));
+    CORRADE_COMPARE(submitted, (std::vector<std::uint64_t>{0, 1}));
+}
+
+void FrameSchedulerTest::pipelined() {
+    ThreadPool pool{2};
+    FrameScheduler scheduler{pool};
+
+    /* The update writes into a double buffer, submit reads from it */
+    Int buffers[2]{};
+    std::vector<Int> submitted;
+    scheduler.addTask(Stage::Update, [&](const Frame& frame) {
+        buffers[frame.index % 2] = frame.index*10;
+    });
+    scheduler.addTask(Stage::Submit, [&](const Frame& frame) {
+        submitted.push_back(buffers[frame.index % 2]);
+    });
+
+    /* First frame only updates */
+    scheduler.frame(0.0f, 0.0f);
+    CORRADE_COMPARE(submitted, std::vector<Int>{});
+
+    /* Each next frame submits the previous one */
+    scheduler.frame(0.0f, 0.0f);
+    scheduler.frame(0.0f, 0.0f);
+    CORRADE_COMPARE(submitted, (std::vector<Int>{0, 10}));
+
+    /* Flush submits the last one, second flush does nothing */
+    scheduler.flush();
+    scheduler.flush();
+    CORRADE_COMPARE(submitted, (std::vector<Int>{0, 10, 20}));
+}
+
+void FrameSchedulerTest::dependencies() {
+    ThreadPool pool{3};
+    FrameScheduler scheduler{pool};
+    scheduler.setPipelined(false);
+
+    /* Diamond: a -> b, c -> d. Recording the order in which the tasks
+       finished. */
+    std::atomic<Int> counter{0};
+    Int a{}, b{}, c{}, d{}, submit{};
+    const UnsignedInt ta = scheduler.addTask(Stage::Update, [&](const Frame&) { a = ++counter; });
+    const UnsignedInt tb = scheduler.addTask(Stage::Update, [&](const Frame&) { b = ++counter; }, {ta});
+    const UnsignedInt tc = scheduler.addTask(Stage::Update, [&](const Frame&) { c = ++counter; }, {ta});
+    const UnsignedInt td = scheduler.addTask(Stage::Update, [&](const Frame&) { d = ++counter; }, {tb, tc});
+    scheduler.addTask(Stage::Submit, [&](const Frame&) { submit = ++counter; }, {td});
+    CORRADE_COMPARE(scheduler.taskCount(), 5);
+
+    for(Int i = 0; i != 10; ++i) {
+        counter = 0;
+        scheduler.frame(0.0f, 0.0f);
+        CORRADE_COMPARE(a, 1);
+        CORRADE_VERIFY(b > a && b < d);
+        CORRADE_VERIFY(c > a && c < d);
+        CORRADE_COMPARE(d, 4);
+        CORRADE_COMPARE(submit, 5);
+    }
+}
+
+void FrameSchedulerTest::frameValues() {
+    ThreadPool pool{1};
+    FrameScheduler scheduler{pool};
+
+    /* Both stages of the same frame see the same values */
+    std::vector<Float> updateTimes, submitTimes;
+    scheduler.addTask(Stage::Update, [&](const Frame& frame) {
+        updateTimes.push_back(frame.time + frame.duration);
+    });
+    scheduler.addTask(Stage::Submit, [&](const Frame& frame) {
+        submitTimes.push_back(frame.time + frame.duration);
+    });
+
+    scheduler.frame(1.0f, 0.5f);
+    scheduler.frame(1.5f, 0.25f);
+    scheduler.flush();
+    CORRADE_COMPARE(scheduler.frameCount(), 2);
+    CORRADE_COMPARE(updateTimes, (std::vector<Float>{1.5f, 1.75f}));
+    CORRADE_COMPARE(submitTimes, (std::vector<Float>{1.5f, 1.75f}));
+}
+
+void FrameSchedulerTest::disablePipelining() {
+    ThreadPool pool{1};
+    FrameScheduler scheduler{pool};
+
+    std::vector<std::uint64_t> submitted;
+    scheduler.addTask(Stage::Submit, [&](const Frame& frame) {
+        submitted.push_back(frame.index);
+    });
+
+    scheduler.frame(0.0f, 0.0f);
+    CORRADE_COMPARE(submitted, std::vector<std::uint64_t>{});
+
+    /* The pending submit is executed when disabling pipelining */
+    scheduler.setPipelined(false);
+    CORRADE_VERIFY(!scheduler.isPipelined());
+    CORRADE_COMPARE(submitted, std::vector<std::uint64_t>{0});
+
+    scheduler.frame(0.0f, 0.0f);
+    CORRADE_COMPARE(submitted, (std::vector<std::uint64_t>{0, 1}));
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::FrameSchedulerTest)
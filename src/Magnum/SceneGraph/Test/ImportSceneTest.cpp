@@ -0,0 +1,247 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/SceneGraph/ImportScene.h"
+#include "Magnum/SceneGraph/MatrixTransformation2D.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/Trade/MeshObjectData3D.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct ImportSceneTest: TestSuite::Tester {
+    explicit ImportSceneTest();
+
+    void import3D();
+    void import2D();
+    void instantiator();
+    void noScene();
+    void outOfRange();
+    void duplicate();
+    void importFailed();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation2D> Scene2D;
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+typedef SceneGraph::ImportedObject<SceneGraph::MatrixTransformation3D> ImportedObject3D;
+
+ImportSceneTest::ImportSceneTest() {
+    addTests({&ImportSceneTest::import3D,
+              &ImportSceneTest::import2D,
+              &ImportSceneTest::instantiator,
+              &ImportSceneTest::noScene,
+              &ImportSceneTest::outOfRange,
+              &ImportSceneTest::duplicate,
+              &ImportSceneTest::importFailed});
+}
+
+namespace {
+
+/* Scene with two top-level objects, 2 and 4:
+
+    2 (translated by X 1)
+        0 (translated by Y 2)
+            3 (mesh 7, rotated by 90° around Z)
+        1
+    4
+
+   Object with ID 5 is not referenced from the scene. */
+class Importer: public Trade::AbstractImporter {
+    public:
+        explicit Importer(std::vector<UnsignedInt> children = {2, 4}): children{std::move(children)} {}
+
+        bool failObject3 = false;
+        std::size_t object3DCalls = 0;
+
+    private:
+        Features doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doSceneCount() const override { return 1; }
+        std::optional<Trade::SceneData> doScene(UnsignedInt) override {
+            return Trade::SceneData{children, children};
+        }
+
+        UnsignedInt doObject2DCount() const override { return 6; }
+        std::unique_ptr<Trade::ObjectData2D> doObject2D(UnsignedInt id) override {
+            switch(id) {
+                case 0: return std::unique_ptr<Trade::ObjectData2D>{new Trade::ObjectData2D{{3}, Matrix3::translation(Vector2::yAxis(2.0f))}};
+                case 2: return std::unique_ptr<Trade::ObjectData2D>{new Trade::ObjectData2D{{0, 1}, Matrix3::translation(Vector2::xAxis(1.0f))}};
+                case 3: return std::unique_ptr<Trade::ObjectData2D>{new Trade::ObjectData2D{{}, Matrix3::rotation(Deg(90.0f))}};
+            }
+            return std::unique_ptr<Trade::ObjectData2D>{new Trade::ObjectData2D{{}, {}}};
+        }
+
+        UnsignedInt doObject3DCount() const override { return 6; }
+        std::unique_ptr<Trade::ObjectData3D> doObject3D(UnsignedInt id) override {
+            ++object3DCalls;
+            switch(id) {
+                case 0: return std::unique_ptr<Trade::ObjectData3D>{new Trade::ObjectData3D{{3}, Matrix4::translation(Vector3::yAxis(2.0f))}};
+                case 2: return std::unique_ptr<Trade::ObjectData3D>{new Trade::ObjectData3D{{0, 1}, Matrix4::translation(Vector3::xAxis(1.0f))}};
+                case 3:
+                    if(failObject3) return nullptr;
+                    return std::unique_ptr<Trade::ObjectData3D>{new Trade::MeshObjectData3D{{}, Matrix4::rotationZ(Deg(90.0f)), 7, -1}};
+                case 5: return std::unique_ptr<Trade::ObjectData3D>{new Trade::ObjectData3D{{1}, {}}};
+            }
+            return std::unique_ptr<Trade::ObjectData3D>{new Trade::ObjectData3D{{}, {}}};
+        }
+
+        std::vector<UnsignedInt> children;
+};
+
+}
+
+void ImportSceneTest::import3D() {
+    Importer importer;
+    std::optional<Trade::SceneData> data = importer.scene(0);
+    CORRADE_VERIFY(data);
+
+    Scene3D scene;
+    const std::size_t usedBefore = ImportedObject3D::pool().usedCount();
+    std::vector<ImportedObject3D*> objects = importScene(importer, *data, scene);
+    CORRADE_COMPARE(objects.size(), 5);
+    CORRADE_COMPARE(ImportedObject3D::pool().usedCount(), usedBefore + 5);
+
+    /* Depth-first order, parents before children */
+    CORRADE_COMPARE(objects[0]->id(), 2);
+    CORRADE_COMPARE(objects[1]->id(), 0);
+    CORRADE_COMPARE(objects[2]->id(), 3);
+    CORRADE_COMPARE(objects[3]->id(), 1);
+    CORRADE_COMPARE(objects[4]->id(), 4);
+    CORRADE_COMPARE(objects[0]->parent(), &scene);
+    CORRADE_COMPARE(objects[1]->parent(), objects[0]);
+    CORRADE_COMPARE(objects[2]->parent(), objects[1]);
+    CORRADE_COMPARE(objects[3]->parent(), objects[0]);
+    CORRADE_COMPARE(objects[4]->parent(), &scene);
+
+    /* Transformations are set and everything is clean already */
+    CORRADE_COMPARE(objects[1]->transformation(), Matrix4::translation(Vector3::yAxis(2.0f)));
+    for(ImportedObject3D* o: objects) CORRADE_VERIFY(!o->isDirty());
+    CORRADE_COMPARE(objects[2]->absoluteTransformation(),
+        Matrix4::translation({1.0f, 2.0f, 0.0f})*Matrix4::rotationZ(Deg(90.0f)));
+}
+
+void ImportSceneTest::import2D() {
+    Importer importer;
+    std::optional<Trade::SceneData> data = importer.scene(0);
+    CORRADE_VERIFY(data);
+
+    Scene2D scene;
+    std::vector<ImportedObject<MatrixTransformation2D>*> objects = importScene(importer, *data, scene);
+    CORRADE_COMPARE(objects.size(), 5);
+    CORRADE_COMPARE(objects[2]->id(), 3);
+    CORRADE_COMPARE(objects[2]->parent(), objects[1]);
+    CORRADE_VERIFY(!objects[2]->isDirty());
+    CORRADE_COMPARE(objects[2]->absoluteTransformation(),
+        Matrix3::translation({1.0f, 2.0f})*Matrix3::rotation(Deg(90.0f)));
+}
+
+void ImportSceneTest::instantiator() {
+    Importer importer;
+    std::optional<Trade::SceneData> data = importer.scene(0);
+    CORRADE_VERIFY(data);
+
+    Scene3D scene;
+    std::vector<UnsignedInt> ids;
+    std::vector<UnsignedInt> meshes;
+    std::vector<ImportedObject3D*> objects = importScene(importer, *data, scene, [&](ImportedObject3D& object, const Trade::ObjectData3D& objectData) {
+        /* The whole hierarchy is already in place */
+        CORRADE_VERIFY(object.scene() == &scene);
+        ids.push_back(object.id());
+        if(objectData.instanceType() == Trade::ObjectInstanceType3D::Mesh)
+            meshes.push_back(objectData.instance());
+    });
+    CORRADE_COMPARE(objects.size(), 5);
+    CORRADE_COMPARE(ids, (std::vector<UnsignedInt>{2, 0, 3, 1, 4}));
+    CORRADE_COMPARE(meshes, std::vector<UnsignedInt>{7});
+}
+
+void ImportSceneTest::noScene() {
+    Importer importer;
+    std::optional<Trade::SceneData> data = importer.scene(0);
+    CORRADE_VERIFY(data);
+
+    /* Transformations can't be cleaned without a scene, the objects are left
+       dirty */
+    Object3D root;
+    std::vector<ImportedObject3D*> objects = importScene(importer, *data, root);
+    CORRADE_COMPARE(objects.size(), 5);
+    CORRADE_COMPARE(objects[0]->parent(), &root);
+    CORRADE_VERIFY(objects[2]->isDirty());
+    CORRADE_COMPARE(objects[2]->absoluteTransformation(),
+        Matrix4::translation({1.0f, 2.0f, 0.0f})*Matrix4::rotationZ(Deg(90.0f)));
+}
+
+void ImportSceneTest::outOfRange() {
+    Importer importer{{2, 6}};
+    std::optional<Trade::SceneData> data = importer.scene(0);
+    CORRADE_VERIFY(data);
+
+    Scene3D scene;
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(importScene(importer, *data, scene).empty());
+    CORRADE_VERIFY(scene.children().isEmpty());
+    CORRADE_COMPARE(out.str(), "SceneGraph::importScene(): object ID 6 out of range for 6 objects\n");
+}
+
+void ImportSceneTest::duplicate() {
+    /* Object 5 has 1 as a child, which is also a child of 2 */
+    Importer importer{{2, 5}};
+    std::optional<Trade::SceneData> data = importer.scene(0);
+    CORRADE_VERIFY(data);
+
+    Scene3D scene;
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(importScene(importer, *data, scene).empty());
+    CORRADE_VERIFY(scene.children().isEmpty());
+    CORRADE_COMPARE(out.str(), "SceneGraph::importScene(): object 1 is referenced more than once\n");
+}
+
+void ImportSceneTest::importFailed() {
+    Importer importer;
+    importer.failObject3 = true;
+    std::optional<Trade::SceneData> data = importer.scene(0);
+    CORRADE_VERIFY(data);
+
+    Scene3D scene;
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(importScene(importer, *data, scene).empty());
+    CORRADE_VERIFY(scene.children().isEmpty());
+    CORRADE_COMPARE(importer.object3DCalls, 3);
+    CORRADE_COMPARE(out.str(), "SceneGraph::importScene(): cannot import object 3\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::ImportSceneTest)
@@ -0,0 +1,222 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Framebuffer.h"
+#include "Magnum/Image.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Renderbuffer.h"
+#include "Magnum/RenderbufferFormat.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/InstancedDrawable.h"
+#include "Magnum/SceneGraph/MatrixTransformation2D.h"
+#include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/Shaders/Flat.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation2D> Scene2D;
+
+struct InstancedDrawableGLTest: OpenGLTester {
+    explicit InstancedDrawableGLTest();
+
+    void draw();
+    void drawMultipleMeshes();
+
+    private:
+        void setup();
+        Containers::Array<Color4ub> read();
+
+        Renderbuffer _color{NoCreate};
+        Framebuffer _framebuffer{NoCreate};
+};
+
+InstancedDrawableGLTest::InstancedDrawableGLTest() {
+    addTests({&InstancedDrawableGLTest::draw,
+              &InstancedDrawableGLTest::drawMultipleMeshes});
+}
+
+namespace {
+    /* Quad covering one pixel of a 2x2 framebuffer when translated to its
+       center */
+    constexpr Vector2 Quad[]{
+        {-0.5f, -0.5f}, { 0.5f, -0.5f}, {-0.5f,  0.5f}, { 0.5f,  0.5f}
+    };
+
+    constexpr Color4 Materials[]{
+        {1.0f, 0.0f, 0.0f, 1.0f},
+        {0.0f, 1.0f, 0.0f, 1.0f}
+    };
+
+    struct QuadMesh {
+        explicit QuadMesh() {
+            vertices.setData(Quad, BufferUsage::StaticDraw);
+            mesh.setPrimitive(MeshPrimitive::TriangleStrip)
+                .setCount(4)
+                .addVertexBuffer(vertices, 0, Shaders::Flat2D::Position{});
+        }
+
+        Buffer vertices;
+        Mesh mesh;
+    };
+}
+
+void InstancedDrawableGLTest::setup() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::draw_instanced>())
+        CORRADE_SKIP(Extensions::GL::ARB::draw_instanced::string() + std::string(" is not available."));
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::instanced_arrays>())
+        CORRADE_SKIP(Extensions::GL::ARB::instanced_arrays::string() + std::string(" is not available."));
+    #elif defined(MAGNUM_TARGET_GLES2)
+    if(!Context::current().isExtensionSupported<Extensions::GL::ANGLE::instanced_arrays>() &&
+       !Context::current().isExtensionSupported<Extensions::GL::EXT::instanced_arrays>() &&
+       !Context::current().isExtensionSupported<Extensions::GL::NV::instanced_arrays>())
+        CORRADE_SKIP("Required instancing extension is not available.");
+    if(!Context::current().isExtensionSupported<Extensions::GL::ANGLE::instanced_arrays>() &&
+       !Context::current().isExtensionSupported<Extensions::GL::EXT::draw_instanced>() &&
+       !Context::current().isExtensionSupported<Extensions::GL::NV::draw_instanced>())
+        CORRADE_SKIP("Required drawing extension is not available.");
+    #endif
+
+    _color = Renderbuffer{};
+    #ifndef MAGNUM_TARGET_GLES2
+    _color.setStorage(RenderbufferFormat::RGBA8, {2, 2});
+    #else
+    _color.setStorage(RenderbufferFormat::RGBA4, {2, 2});
+    #endif
+    _framebuffer = Framebuffer{{{}, {2, 2}}};
+    _framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment(0), _color)
+        .bind();
+    Renderer::setClearColor(Color4{});
+    _framebuffer.clear(FramebufferClear::Color);
+}
+
+Containers::Array<Color4ub> InstancedDrawableGLTest::read() {
+    Image2D image = _framebuffer.read({{}, {2, 2}}, {PixelFormat::RGBA, PixelType::UnsignedByte});
+    Containers::Array<Color4ub> pixels{4};
+    for(std::size_t i = 0; i != 4; ++i)
+        pixels[i] = image.data<Color4ub>()[i];
+    return pixels;
+}
+
+void InstancedDrawableGLTest::draw() {
+    setup();
+
+    QuadMesh quad;
+    Shaders::Flat2D shader{Shaders::Flat2D::Flag::InstancedTransformation};
+
+    Scene2D scene;
+    Object2D cameraObject{&scene};
+    Camera2D camera{cameraObject};
+
+    Int called{};
+    InstancedDrawableGroup2D drawables{[&](AbstractShaderProgram& shader, UnsignedInt material, Camera2D& camera) {
+        static_cast<Shaders::Flat2D&>(shader)
+            .setTransformationProjectionMatrix(camera.projectionMatrix())
+            .setColor(Materials[material]);
+        ++called;
+    }};
+
+    /* Three red quads and a green one, interleaved in the group */
+    Object2D a{&scene}, b{&scene}, c{&scene}, d{&scene};
+    a.translate({-0.5f, -0.5f});
+    b.translate({ 0.5f, -0.5f});
+    c.translate({-0.5f,  0.5f});
+    d.translate({ 0.5f,  0.5f});
+    new InstancedDrawable2D{a, quad.mesh, shader, 0, &drawables};
+    new InstancedDrawable2D{b, quad.mesh, shader, 1, &drawables};
+    new InstancedDrawable2D{c, quad.mesh, shader, 0, &drawables};
+    new InstancedDrawable2D{d, quad.mesh, shader, 0, &drawables};
+
+    CORRADE_COMPARE(drawables.draw(camera), 2);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(called, 2);
+    CORRADE_COMPARE(drawables.instanceBufferCount(), 1);
+
+    Containers::Array<Color4ub> pixels = read();
+    CORRADE_COMPARE(pixels[0], (Color4ub{255, 0, 0, 255}));
+    CORRADE_COMPARE(pixels[1], (Color4ub{0, 255, 0, 255}));
+    CORRADE_COMPARE(pixels[2], (Color4ub{255, 0, 0, 255}));
+    CORRADE_COMPARE(pixels[3], (Color4ub{255, 0, 0, 255}));
+
+    /* Moving an object changes its instance transformation next frame. The
+       green quad has a higher material ID, so it's drawn over the moved red
+       one. */
+    _framebuffer.clear(FramebufferClear::Color);
+    d.translate({0.0f, -1.0f});
+    CORRADE_COMPARE(drawables.draw(camera), 2);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    pixels = read();
+    CORRADE_COMPARE(pixels[1], (Color4ub{0, 255, 0, 255}));
+    CORRADE_COMPARE(pixels[3], (Color4ub{}));
+}
+
+void InstancedDrawableGLTest::drawMultipleMeshes() {
+    setup();
+
+    QuadMesh first, second;
+    Shaders::Flat2D shader{Shaders::Flat2D::Flag::InstancedTransformation};
+    shader.setColor(Materials[1]);
+
+    Scene2D scene;
+    Object2D cameraObject{&scene};
+    Camera2D camera{cameraObject};
+
+    /* Without a callback the shader is used as-is, identity projection */
+    InstancedDrawableGroup2D drawables;
+
+    Object2D a{&scene}, b{&scene};
+    a.translate({-0.5f, -0.5f});
+    b.translate({ 0.5f,  0.5f});
+    new InstancedDrawable2D{a, first.mesh, shader, 0, &drawables};
+    new InstancedDrawable2D{b, second.mesh, shader, 0, &drawables};
+
+    CORRADE_COMPARE(drawables.draw(camera), 2);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(drawables.instanceBufferCount(), 2);
+
+    Containers::Array<Color4ub> pixels = read();
+    CORRADE_COMPARE(pixels[0], (Color4ub{0, 255, 0, 255}));
+    CORRADE_COMPARE(pixels[1], (Color4ub{}));
+    CORRADE_COMPARE(pixels[2], (Color4ub{}));
+    CORRADE_COMPARE(pixels[3], (Color4ub{0, 255, 0, 255}));
+
+    drawables.releaseInstanceBuffers();
+    CORRADE_COMPARE(drawables.instanceBufferCount(), 0);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::InstancedDrawableGLTest)
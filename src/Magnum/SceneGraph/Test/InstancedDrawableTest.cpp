@@ -0,0 +1,138 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/InstancedDrawable.h"
+#include "Magnum/SceneGraph/MatrixTransformation2D.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct InstancedDrawableTest: TestSuite::Tester {
+    explicit InstancedDrawableTest();
+
+    void construct();
+    void setMaterial();
+    void group();
+    void drawCallback();
+    void drawEmpty();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation2D> Scene2D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+InstancedDrawableTest::InstancedDrawableTest() {
+    addTests({&InstancedDrawableTest::construct,
+              &InstancedDrawableTest::setMaterial,
+              &InstancedDrawableTest::group,
+              &InstancedDrawableTest::drawCallback,
+              &InstancedDrawableTest::drawEmpty});
+}
+
+namespace {
+    struct Shader: AbstractShaderProgram {
+        explicit Shader(): AbstractShaderProgram{NoCreate} {}
+    };
+}
+
+void InstancedDrawableTest::construct() {
+    Mesh mesh{NoCreate};
+    Shader shader;
+    Object3D object;
+    InstancedDrawable3D drawable{object, mesh, shader, 7};
+
+    CORRADE_COMPARE(&drawable.object(), &object);
+    CORRADE_COMPARE(&drawable.mesh(), &mesh);
+    CORRADE_COMPARE(&drawable.shader(), &shader);
+    CORRADE_COMPARE(drawable.material(), 7);
+    CORRADE_VERIFY(!drawable.drawables());
+}
+
+void InstancedDrawableTest::setMaterial() {
+    Mesh mesh{NoCreate};
+    Shader shader;
+    Object2D object;
+    InstancedDrawable2D drawable{object, mesh, shader};
+    CORRADE_COMPARE(drawable.material(), 0);
+
+    drawable.setMaterial(3);
+    CORRADE_COMPARE(drawable.material(), 3);
+}
+
+void InstancedDrawableTest::group() {
+    Mesh mesh{NoCreate};
+    Shader shader;
+    Object3D object;
+    InstancedDrawableGroup3D drawables;
+    InstancedDrawable3D a{object, mesh, shader, 0, &drawables};
+    InstancedDrawable3D b{object, mesh, shader, 1};
+
+    CORRADE_COMPARE(drawables.size(), 1);
+    CORRADE_COMPARE(a.drawables(), &drawables);
+    CORRADE_VERIFY(!b.drawables());
+
+    drawables.add(b);
+    CORRADE_COMPARE(drawables.size(), 2);
+    CORRADE_COMPARE(&drawables[1], &b);
+    CORRADE_COMPARE(b.drawables(), &drawables);
+
+    /* No GL objects are created before the first draw */
+    CORRADE_COMPARE(drawables.instanceBufferCount(), 0);
+}
+
+void InstancedDrawableTest::drawCallback() {
+    Int called{};
+    InstancedDrawableGroup2D drawables{[&](AbstractShaderProgram&, UnsignedInt, Camera2D&) { ++called; }};
+    CORRADE_VERIFY(drawables.drawCallback());
+
+    drawables.setDrawCallback(nullptr);
+    CORRADE_VERIFY(!drawables.drawCallback());
+    CORRADE_COMPARE(called, 0);
+}
+
+void InstancedDrawableTest::drawEmpty() {
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+
+    Int called{};
+    InstancedDrawableGroup3D drawables{[&](AbstractShaderProgram&, UnsignedInt, Camera3D&) { ++called; }};
+
+    /* Nothing is drawn and no GL object is touched */
+    CORRADE_COMPARE(drawables.draw(camera), 0);
+    CORRADE_COMPARE(drawables.instanceBufferCount(), 0);
+    CORRADE_COMPARE(called, 0);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::InstancedDrawableTest)
@@ -0,0 +1,238 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/SceneGraph/AnimableGroup.h"
+#include "Magnum/SceneGraph/KeyframeAnimable.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct KeyframeTrackTest: TestSuite::Tester {
+    explicit KeyframeTrackTest();
+
+    void empty();
+    void keyFor();
+    void keyForHint();
+    void single();
+    void vector();
+    void quaternion();
+    void quaternionShortestPath();
+    void dualQuaternion();
+    void interpolateBatch();
+
+    void animable();
+    void animableNoTracks();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+
+KeyframeTrackTest::KeyframeTrackTest() {
+    addTests({&KeyframeTrackTest::empty,
+              &KeyframeTrackTest::keyFor,
+              &KeyframeTrackTest::keyForHint,
+              &KeyframeTrackTest::single,
+              &KeyframeTrackTest::vector,
+              &KeyframeTrackTest::quaternion,
+              &KeyframeTrackTest::quaternionShortestPath,
+              &KeyframeTrackTest::dualQuaternion,
+              &KeyframeTrackTest::interpolateBatch,
+
+              &KeyframeTrackTest::animable,
+              &KeyframeTrackTest::animableNoTracks});
+}
+
+void KeyframeTrackTest::empty() {
+    KeyframeTrack3D track;
+    CORRADE_VERIFY(track.isEmpty());
+    CORRADE_COMPARE(track.size(), 0);
+    CORRADE_COMPARE(track.duration(), 0.0f);
+}
+
+void KeyframeTrackTest::keyFor() {
+    KeyframeTrack3D track{{0.0f, 1.0f, 2.5f, 4.0f}, {{}, {}, {}, {}}};
+    CORRADE_COMPARE(track.size(), 4);
+    CORRADE_COMPARE(track.duration(), 4.0f);
+
+    /* Clamped on both sides */
+    CORRADE_COMPARE(track.keyFor(-1.0f), 0);
+    CORRADE_COMPARE(track.keyFor(0.0f), 0);
+    CORRADE_COMPARE(track.keyFor(0.5f), 0);
+    CORRADE_COMPARE(track.keyFor(1.0f), 1);
+    CORRADE_COMPARE(track.keyFor(3.0f), 2);
+    CORRADE_COMPARE(track.keyFor(4.0f), 2);
+    CORRADE_COMPARE(track.keyFor(100.0f), 2);
+}
+
+void KeyframeTrackTest::keyForHint() {
+    KeyframeTrack3D track{{0.0f, 1.0f, 2.5f, 4.0f}, {{}, {}, {}, {}}};
+
+    std::size_t hint = 0;
+    CORRADE_COMPARE(track.keyFor(0.5f, hint), 0);
+    CORRADE_COMPARE(hint, 0);
+
+    /* Advancing to the next interval */
+    CORRADE_COMPARE(track.keyFor(1.5f, hint), 1);
+    CORRADE_COMPARE(hint, 1);
+
+    /* Jumping forward */
+    CORRADE_COMPARE(track.keyFor(10.0f, hint), 2);
+    CORRADE_COMPARE(hint, 2);
+
+    /* Jumping back, e.g. when the animation loops */
+    CORRADE_COMPARE(track.keyFor(0.1f, hint), 0);
+    CORRADE_COMPARE(hint, 0);
+
+    /* Garbage hint is recovered from */
+    hint = 1337;
+    CORRADE_COMPARE(track.keyFor(3.0f, hint), 2);
+    CORRADE_COMPARE(hint, 2);
+}
+
+void KeyframeTrackTest::single() {
+    KeyframeTrack3D track{{1.0f}, {Vector3{1.0f, 2.0f, 3.0f}}};
+    CORRADE_COMPARE(track.keyFor(-1.0f), 0);
+    CORRADE_COMPARE(track.at(5.0f), (Vector3{1.0f, 2.0f, 3.0f}));
+}
+
+void KeyframeTrackTest::vector() {
+    KeyframeTrack3D track{{0.0f, 2.0f, 3.0f}, {
+        Vector3{0.0f}, Vector3{2.0f, 4.0f, 6.0f}, Vector3{}}};
+
+    CORRADE_COMPARE(track.at(-1.0f), Vector3{0.0f});
+    CORRADE_COMPARE(track.at(0.5f), (Vector3{0.5f, 1.0f, 1.5f}));
+    CORRADE_COMPARE(track.at(2.0f), (Vector3{2.0f, 4.0f, 6.0f}));
+    CORRADE_COMPARE(track.at(2.5f), (Vector3{1.0f, 2.0f, 3.0f}));
+    CORRADE_COMPARE(track.at(10.0f), Vector3{});
+}
+
+void KeyframeTrackTest::quaternion() {
+    KeyframeTrackQuaternion track{{0.0f, 1.0f}, {
+        Quaternion::rotation(Deg(0.0f), Vector3::zAxis()),
+        Quaternion::rotation(Deg(90.0f), Vector3::zAxis())}};
+
+    CORRADE_COMPARE(track.at(0.5f), Quaternion::rotation(Deg(45.0f), Vector3::zAxis()));
+    CORRADE_COMPARE(track.at(1.5f), Quaternion::rotation(Deg(90.0f), Vector3::zAxis()));
+}
+
+void KeyframeTrackTest::quaternionShortestPath() {
+    /* The second key is the same rotation as 90° but in the opposite
+       hemisphere, the interpolation should still go the short way */
+    KeyframeTrackQuaternion track{{0.0f, 1.0f}, {
+        Quaternion::rotation(Deg(0.0f), Vector3::zAxis()),
+        -Quaternion::rotation(Deg(90.0f), Vector3::zAxis())}};
+
+    CORRADE_COMPARE(track.at(0.5f), Quaternion::rotation(Deg(45.0f), Vector3::zAxis()));
+}
+
+void KeyframeTrackTest::dualQuaternion() {
+    KeyframeTrackDualQuaternion track{{0.0f, 1.0f}, {
+        DualQuaternion::translation(Vector3{0.0f}),
+        DualQuaternion::translation(Vector3{2.0f, 0.0f, 0.0f})}};
+
+    CORRADE_COMPARE(track.at(0.5f).translation(), (Vector3{1.0f, 0.0f, 0.0f}));
+}
+
+void KeyframeTrackTest::interpolateBatch() {
+    KeyframeTrack3D a{{0.0f, 1.0f}, {Vector3{0.0f}, Vector3{1.0f}}};
+    KeyframeTrack3D b{{0.0f, 1.0f, 2.0f}, {Vector3{0.0f}, Vector3{2.0f}, Vector3{4.0f}}};
+    KeyframeTrack3D c{{0.0f}, {Vector3{7.0f}}};
+
+    const KeyframeTrack3D* tracks[]{&a, &b, &c, &b};
+    std::size_t hints[4]{};
+    Vector3 values[4];
+
+    interpolate<Vector3>(tracks, 1.5f, hints, values);
+    CORRADE_COMPARE(values[0], Vector3{1.0f});
+    CORRADE_COMPARE(values[1], Vector3{3.0f});
+    CORRADE_COMPARE(values[2], Vector3{7.0f});
+    CORRADE_COMPARE(values[3], Vector3{3.0f});
+    CORRADE_COMPARE(hints[0], 0);
+    CORRADE_COMPARE(hints[1], 1);
+    CORRADE_COMPARE(hints[2], 0);
+    CORRADE_COMPARE(hints[3], 1);
+
+    /* Should give the same result as evaluating each track separately */
+    interpolate<Vector3>(tracks, 0.25f, hints, values);
+    CORRADE_COMPARE(values[0], a.at(0.25f));
+    CORRADE_COMPARE(values[1], b.at(0.25f));
+    CORRADE_COMPARE(values[2], c.at(0.25f));
+    CORRADE_COMPARE(values[3], b.at(0.25f));
+}
+
+void KeyframeTrackTest::animable() {
+    KeyframeTrack3D translation{{0.0f, 2.0f}, {Vector3{0.0f}, Vector3{2.0f, 0.0f, 0.0f}}};
+    KeyframeTrackQuaternion rotation{{0.0f, 1.0f}, {
+        Quaternion{}, Quaternion::rotation(Deg(90.0f), Vector3::zAxis())}};
+    KeyframeTrack3D scaling{{0.0f, 4.0f}, {Vector3{1.0f}, Vector3{3.0f}}};
+
+    Object3D object;
+    AnimableGroup3D group;
+    KeyframeAnimable3D animable{object, &group};
+    animable.setTracks(&translation, &rotation, &scaling)
+        .setState(AnimationState::Running);
+    CORRADE_VERIFY(animable.translationTrack() == &translation);
+    CORRADE_VERIFY(animable.rotationTrack() == &rotation);
+    CORRADE_VERIFY(animable.scalingTrack() == &scaling);
+    CORRADE_COMPARE(animable.duration(), 4.0f);
+
+    group.step(1.0f, 0.0f);
+    group.step(2.0f, 1.0f);
+    CORRADE_COMPARE(object.transformationMatrix(),
+        Matrix4::translation(Vector3{1.0f, 0.0f, 0.0f})*
+        Matrix4::rotationZ(Deg(90.0f))*
+        Matrix4::scaling(Vector3{1.5f}));
+
+    /* Track durations differ, shorter tracks are clamped */
+    group.step(4.0f, 2.0f);
+    CORRADE_COMPARE(object.transformationMatrix(),
+        Matrix4::translation(Vector3{2.0f, 0.0f, 0.0f})*
+        Matrix4::rotationZ(Deg(90.0f))*
+        Matrix4::scaling(Vector3{2.5f}));
+}
+
+void KeyframeTrackTest::animableNoTracks() {
+    KeyframeTrack3D translation{{0.0f, 1.0f}, {Vector3{0.0f}, Vector3{0.0f, 4.0f, 0.0f}}};
+
+    Object3D object;
+    object.scale(Vector3{5.0f});
+    AnimableGroup3D group;
+    KeyframeAnimable3D animable{object, &group};
+    animable.setTracks(&translation, nullptr, nullptr)
+        .setState(AnimationState::Running);
+    CORRADE_COMPARE(animable.duration(), 1.0f);
+
+    /* Existing transformation is replaced */
+    group.step(1.0f, 0.0f);
+    group.step(1.5f, 0.5f);
+    CORRADE_COMPARE(object.transformationMatrix(),
+        Matrix4::translation(Vector3{0.0f, 2.0f, 0.0f}));
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::KeyframeTrackTest)
@@ -0,0 +1,299 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/MeshView.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/LevelOfDetail.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+struct LevelOfDetailTest: TestSuite::Tester {
+    explicit LevelOfDetailTest();
+
+    void construct();
+    void addLevel();
+    void addLevelWrongOrder();
+    void levelOutOfRange();
+    void setHysteresisInvalid();
+
+    void screenSize();
+    void screenSizeScaled();
+    void screenSizeInside();
+
+    void select();
+    void selectHysteresis();
+    void selectNoLevels();
+    void crossFade();
+};
+
+LevelOfDetailTest::LevelOfDetailTest() {
+    addTests({&LevelOfDetailTest::construct,
+              &LevelOfDetailTest::addLevel,
+              &LevelOfDetailTest::addLevelWrongOrder,
+              &LevelOfDetailTest::levelOutOfRange,
+              &LevelOfDetailTest::setHysteresisInvalid,
+
+              &LevelOfDetailTest::screenSize,
+              &LevelOfDetailTest::screenSizeScaled,
+              &LevelOfDetailTest::screenSizeInside,
+
+              &LevelOfDetailTest::select,
+              &LevelOfDetailTest::selectHysteresis,
+              &LevelOfDetailTest::selectNoLevels,
+              &LevelOfDetailTest::crossFade});
+}
+
+namespace {
+    /* 90 degree field of view makes the screen size simply radius/distance */
+    const Matrix4 Projection = Matrix4::perspectiveProjection(Deg(90.0f), 1.0f, 0.1f, 1000.0f);
+
+    struct Levels {
+        explicit Levels(): mesh{NoCreate}, full{mesh}, half{mesh}, quarter{mesh} {}
+
+        Mesh mesh;
+        MeshView full, half, quarter;
+    };
+}
+
+void LevelOfDetailTest::construct() {
+    Scene3D scene;
+    Object3D object{&scene};
+    LevelOfDetail lod{object, 2.5f, {1.0f, 2.0f, 3.0f}};
+
+    CORRADE_COMPARE(lod.radius(), 2.5f);
+    CORRADE_COMPARE(lod.center(), (Vector3{1.0f, 2.0f, 3.0f}));
+    CORRADE_COMPARE(lod.levelCount(), 0);
+    CORRADE_COMPARE(lod.hysteresis(), 0.1f);
+    CORRADE_COMPARE(lod.crossFadeFrames(), 0);
+    CORRADE_VERIFY(!lod.isCrossFading());
+    CORRADE_COMPARE(lod.crossFade(), 1.0f);
+}
+
+void LevelOfDetailTest::addLevel() {
+    Scene3D scene;
+    Object3D object{&scene};
+    Levels levels;
+    LevelOfDetail lod{object, 1.0f};
+    lod.addLevel(levels.full, 0.5f)
+        .addLevel(levels.half, 0.1f);
+
+    CORRADE_COMPARE(lod.levelCount(), 2);
+    CORRADE_COMPARE(&lod.level(0), &levels.full);
+    CORRADE_COMPARE(&lod.level(1), &levels.half);
+    CORRADE_COMPARE(lod.levelScreenSize(0), 0.5f);
+    CORRADE_COMPARE(lod.levelScreenSize(1), 0.1f);
+}
+
+void LevelOfDetailTest::addLevelWrongOrder() {
+    Scene3D scene;
+    Object3D object{&scene};
+    Levels levels;
+    LevelOfDetail lod{object, 1.0f};
+    lod.addLevel(levels.full, 0.5f);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    lod.addLevel(levels.half, 0.5f);
+    CORRADE_COMPARE(lod.levelCount(), 1);
+    CORRADE_COMPARE(out.str(), "SceneGraph::LevelOfDetail::addLevel(): expected screen size smaller than 0.5 but got 0.5\n");
+}
+
+void LevelOfDetailTest::levelOutOfRange() {
+    Scene3D scene;
+    Object3D object{&scene};
+    Levels levels;
+    LevelOfDetail lod{object, 1.0f};
+    lod.addLevel(levels.full, 0.5f);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    lod.level(1);
+    lod.levelScreenSize(1);
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::LevelOfDetail::level(): index 1 out of range for 1 levels\n"
+        "SceneGraph::LevelOfDetail::levelScreenSize(): index 1 out of range for 1 levels\n");
+}
+
+void LevelOfDetailTest::setHysteresisInvalid() {
+    Scene3D scene;
+    Object3D object{&scene};
+    LevelOfDetail lod{object, 1.0f};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    lod.setHysteresis(1.0f);
+    CORRADE_COMPARE(lod.hysteresis(), 0.1f);
+    CORRADE_COMPARE(out.str(), "SceneGraph::LevelOfDetail::setHysteresis(): expected value in range [0, 1) but got 1\n");
+}
+
+void LevelOfDetailTest::screenSize() {
+    Scene3D scene;
+    Object3D object{&scene};
+    LevelOfDetail lod{object, 1.0f};
+
+    CORRADE_COMPARE(lod.screenSize(Matrix4::translation(Vector3::zAxis(-10.0f)), Projection), 0.1f);
+    CORRADE_COMPARE(lod.screenSize(Matrix4::translation({3.0f, 0.0f, -4.0f}), Projection), 0.25f);
+}
+
+void LevelOfDetailTest::screenSizeScaled() {
+    Scene3D scene;
+    Object3D object{&scene};
+    LevelOfDetail lod{object, 1.0f, Vector3::zAxis(1.0f)};
+
+    /* The center is scaled too */
+    CORRADE_COMPARE(lod.screenSize(Matrix4::translation(Vector3::zAxis(-12.0f))*Matrix4::scaling({1.0f, 2.0f, 0.5f}), Projection), 2.0f/11.5f);
+}
+
+void LevelOfDetailTest::screenSizeInside() {
+    Scene3D scene;
+    Object3D object{&scene};
+    LevelOfDetail lod{object, 1.0f};
+
+    CORRADE_COMPARE(lod.screenSize(Matrix4::translation(Vector3::zAxis(1.0f)), Projection), Constants::inf());
+}
+
+void LevelOfDetailTest::select() {
+    Scene3D scene;
+    Object3D object{&scene};
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Projection);
+    Levels levels;
+    LevelOfDetail lod{object, 1.0f};
+    lod.addLevel(levels.full, 0.5f)
+        .addLevel(levels.half, 0.1f)
+        .addLevel(levels.quarter, 0.01f)
+        .setHysteresis(0.0f);
+
+    CORRADE_COMPARE(lod.select(Matrix4::translation(Vector3::zAxis(-1.5f)), camera), 0);
+    CORRADE_COMPARE(lod.currentLevel(), 0);
+    CORRADE_COMPARE(lod.screenSize(), 1.0f/1.5f);
+
+    CORRADE_COMPARE(lod.select(Matrix4::translation(Vector3::zAxis(-5.0f)), camera), 1);
+    CORRADE_COMPARE(lod.currentLevel(), 1);
+    CORRADE_COMPARE(lod.previousLevel(), 0);
+
+    /* The last level is used also below its threshold */
+    CORRADE_COMPARE(lod.select(Matrix4::translation(Vector3::zAxis(-500.0f)), camera), 2);
+    CORRADE_COMPARE(lod.currentLevel(), 2);
+
+    /* Going back directly to the most detailed level */
+    CORRADE_COMPARE(lod.select(Matrix4::translation(Vector3::zAxis(-1.0f)), camera), 0);
+    CORRADE_COMPARE(lod.currentLevel(), 0);
+    CORRADE_COMPARE(lod.previousLevel(), 2);
+}
+
+void LevelOfDetailTest::selectHysteresis() {
+    Scene3D scene;
+    Object3D object{&scene};
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Projection);
+    Levels levels;
+    LevelOfDetail lod{object, 1.0f};
+    lod.addLevel(levels.full, 0.5f)
+        .addLevel(levels.half, 0.1f);
+
+    /* The first selection doesn't use the hysteresis */
+    lod.select(Matrix4::translation(Vector3::zAxis(-1.9f)), camera);
+    CORRADE_COMPARE(lod.currentLevel(), 0);
+
+    /* Size 0.4762, within the band */
+    lod.select(Matrix4::translation(Vector3::zAxis(-2.1f)), camera);
+    CORRADE_COMPARE(lod.currentLevel(), 0);
+
+    /* Size 0.4348, below 0.45 */
+    lod.select(Matrix4::translation(Vector3::zAxis(-2.3f)), camera);
+    CORRADE_COMPARE(lod.currentLevel(), 1);
+
+    /* Size 0.5263, within the band */
+    lod.select(Matrix4::translation(Vector3::zAxis(-1.9f)), camera);
+    CORRADE_COMPARE(lod.currentLevel(), 1);
+
+    /* Size 0.5882, above 0.55 */
+    lod.select(Matrix4::translation(Vector3::zAxis(-1.7f)), camera);
+    CORRADE_COMPARE(lod.currentLevel(), 0);
+}
+
+void LevelOfDetailTest::selectNoLevels() {
+    Scene3D scene;
+    Object3D object{&scene};
+    Camera3D camera{object};
+    LevelOfDetail lod{object, 1.0f};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    lod.select({}, camera);
+    CORRADE_COMPARE(out.str(), "SceneGraph::LevelOfDetail::select(): no levels added\n");
+}
+
+void LevelOfDetailTest::crossFade() {
+    Scene3D scene;
+    Object3D object{&scene};
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Projection);
+    Levels levels;
+    LevelOfDetail lod{object, 1.0f};
+    lod.addLevel(levels.full, 0.5f)
+        .addLevel(levels.half, 0.1f)
+        .setCrossFadeFrames(4);
+
+    /* No cross-fade on the first selection */
+    lod.select(Matrix4::translation(Vector3::zAxis(-1.0f)), camera);
+    CORRADE_VERIFY(!lod.isCrossFading());
+    CORRADE_COMPARE(lod.crossFade(), 1.0f);
+
+    lod.select(Matrix4::translation(Vector3::zAxis(-5.0f)), camera);
+    CORRADE_VERIFY(lod.isCrossFading());
+    CORRADE_COMPARE(lod.currentLevel(), 1);
+    CORRADE_COMPARE(lod.previousLevel(), 0);
+    CORRADE_COMPARE(lod.crossFade(), 0.0f);
+
+    lod.select(Matrix4::translation(Vector3::zAxis(-5.0f)), camera);
+    CORRADE_COMPARE(lod.crossFade(), 0.25f);
+    lod.select(Matrix4::translation(Vector3::zAxis(-5.0f)), camera);
+    lod.select(Matrix4::translation(Vector3::zAxis(-5.0f)), camera);
+    CORRADE_VERIFY(lod.isCrossFading());
+    CORRADE_COMPARE(lod.crossFade(), 0.75f);
+
+    lod.select(Matrix4::translation(Vector3::zAxis(-5.0f)), camera);
+    CORRADE_VERIFY(!lod.isCrossFading());
+    CORRADE_COMPARE(lod.crossFade(), 1.0f);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::LevelOfDetailTest)
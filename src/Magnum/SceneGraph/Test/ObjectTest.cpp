@@ -26,6 +26,8 @@
 #include <sstream>
 #include <Corrade/TestSuite/Tester.h>
 
+#include "Magnum/SceneGraph/AbstractJobSystem.h"
+#include "Magnum/SceneGraph/DualQuaternionTransformation.h"
 #include "Magnum/SceneGraph/MatrixTransformation3D.h"
 #include "Magnum/SceneGraph/Scene.h"
 
@@ -45,9 +47,25 @@ struct ObjectTest: TestSuite::Tester {
     void transformationsRelative();
     void transformationsOrphan();
     void transformationsDuplicate();
+    void transformationsFlat();
+    void transformationsFlatIncremental();
+    void transformationsFlatReparent();
+    void transformationsFlatOrphan();
+    void transformationMatricesFlatMultipleCameras();
+    void transformationMatricesFlatDualQuaternion();
+    void transformationsParallel();
+    void transformationsParallelOrphan();
+    void transformationsArena();
+    void transformationsArenaFlat();
     void setClean();
     void setCleanListHierarchy();
     void setCleanListBulk();
+    void setCleanListParallel();
+    void setCleanListArena();
+    void setCleanLazy();
+    void setCleanLazyList();
+    void setCleanLazyReparent();
+    void setCleanLazyDisable();
 
     void rangeBasedForChildren();
     void rangeBasedForFeatures();
@@ -70,6 +88,21 @@ class CachingObject: public Object3D, AbstractFeature3D {
         }
 };
 
+/* Runs the jobs serially in reverse order to verify they don't depend on
+   each other */
+class ReverseJobSystem: public AbstractJobSystem {
+    public:
+        std::size_t jobCount = 0;
+
+    private:
+        std::size_t doWorkerCount() const override { return 4; }
+
+        void doRun(std::size_t jobCount, const std::function<void(std::size_t)>& job) override {
+            this->jobCount = jobCount;
+            for(std::size_t i = jobCount; i != 0; --i) job(i - 1);
+        }
+};
+
 ObjectTest::ObjectTest() {
     addTests({&ObjectTest::addFeature,
 
@@ -82,9 +115,25 @@ ObjectTest::ObjectTest() {
               &ObjectTest::transformationsRelative,
               &ObjectTest::transformationsOrphan,
               &ObjectTest::transformationsDuplicate,
+              &ObjectTest::transformationsFlat,
+              &ObjectTest::transformationsFlatIncremental,
+              &ObjectTest::transformationsFlatReparent,
+              &ObjectTest::transformationsFlatOrphan,
+              &ObjectTest::transformationMatricesFlatMultipleCameras,
+              &ObjectTest::transformationMatricesFlatDualQuaternion,
+              &ObjectTest::transformationsParallel,
+              &ObjectTest::transformationsParallelOrphan,
+              &ObjectTest::transformationsArena,
+              &ObjectTest::transformationsArenaFlat,
               &ObjectTest::setClean,
               &ObjectTest::setCleanListHierarchy,
               &ObjectTest::setCleanListBulk,
+              &ObjectTest::setCleanListParallel,
+              &ObjectTest::setCleanListArena,
+              &ObjectTest::setCleanLazy,
+              &ObjectTest::setCleanLazyList,
+              &ObjectTest::setCleanLazyReparent,
+              &ObjectTest::setCleanLazyDisable,
 
               &ObjectTest::rangeBasedForChildren,
               &ObjectTest::rangeBasedForFeatures});
@@ -304,6 +353,285 @@ void ObjectTest::transformationsDuplicate() {
     }));
 }
 
+void ObjectTest::transformationsFlat() {
+    Scene3D s;
+    s.setFlatHierarchyEnabled(true);
+    CORRADE_VERIFY(s.isFlatHierarchyEnabled());
+
+    Matrix4 initial = Matrix4::rotationX(Deg(90.0f)).inverted();
+
+    /* Empty list, scene alone */
+    CORRADE_COMPARE(s.transformations({}, initial), std::vector<Matrix4>());
+    CORRADE_COMPARE(s.transformations({s}, initial), std::vector<Matrix4>{initial});
+
+    Object3D first(&s);
+    first.rotateZ(Deg(30.0f));
+    Object3D second(&first);
+    second.scale(Vector3(0.5f));
+    Object3D third(&first);
+    third.translate(Vector3::xAxis(5.0f));
+
+    /* Same results as with the default implementation, including
+       duplicates */
+    CORRADE_COMPARE(s.transformations({second, third, first, second, s}, initial), (std::vector<Matrix4>{
+        initial*Matrix4::rotationZ(Deg(30.0f))*Matrix4::scaling(Vector3(0.5f)),
+        initial*Matrix4::rotationZ(Deg(30.0f))*Matrix4::translation(Vector3::xAxis(5.0f)),
+        initial*Matrix4::rotationZ(Deg(30.0f)),
+        initial*Matrix4::rotationZ(Deg(30.0f))*Matrix4::scaling(Vector3(0.5f)),
+        initial
+    }));
+
+    /* Disabling goes back to the default implementation */
+    s.setFlatHierarchyEnabled(false);
+    CORRADE_VERIFY(!s.isFlatHierarchyEnabled());
+    CORRADE_COMPARE(s.transformations({third}), std::vector<Matrix4>{
+        Matrix4::rotationZ(Deg(30.0f))*Matrix4::translation(Vector3::xAxis(5.0f))
+    });
+}
+
+void ObjectTest::transformationsFlatIncremental() {
+    Scene3D s;
+    s.setFlatHierarchyEnabled(true);
+
+    Object3D first(&s);
+    Object3D second(&first);
+    second.translate(Vector3::xAxis(2.0f));
+    Object3D third(&s);
+    third.translate(Vector3::yAxis(3.0f));
+    CORRADE_COMPARE(s.transformations({second, third}), (std::vector<Matrix4>{
+        Matrix4::translation(Vector3::xAxis(2.0f)),
+        Matrix4::translation(Vector3::yAxis(3.0f))
+    }));
+
+    /* Changing parent transformation updates all children */
+    first.scale(Vector3(2.0f));
+    CORRADE_COMPARE(s.transformations({second, third}), (std::vector<Matrix4>{
+        Matrix4::scaling(Vector3(2.0f))*Matrix4::translation(Vector3::xAxis(2.0f)),
+        Matrix4::translation(Vector3::yAxis(3.0f))
+    }));
+
+    /* Changing the child also after the parent was already marked dirty (and
+       not cleaned) */
+    second.translate(Vector3::zAxis(1.0f));
+    CORRADE_COMPARE(s.transformations({second}), std::vector<Matrix4>{
+        Matrix4::scaling(Vector3(2.0f))*Matrix4::translation({2.0f, 0.0f, 1.0f})
+    });
+}
+
+void ObjectTest::transformationsFlatReparent() {
+    Scene3D s;
+    s.setFlatHierarchyEnabled(true);
+
+    Object3D first(&s);
+    first.translate(Vector3::xAxis(1.0f));
+    Object3D second(&s);
+    second.translate(Vector3::yAxis(1.0f));
+    Object3D third(&first);
+    third.translate(Vector3::zAxis(1.0f));
+    CORRADE_COMPARE(s.transformations({third}), std::vector<Matrix4>{
+        Matrix4::translation({1.0f, 0.0f, 1.0f})
+    });
+
+    /* Reparenting */
+    third.setParent(&second);
+    CORRADE_COMPARE(s.transformations({third}), std::vector<Matrix4>{
+        Matrix4::translation({0.0f, 1.0f, 1.0f})
+    });
+
+    /* Adding a new object */
+    Object3D fourth(&third);
+    fourth.translate(Vector3::xAxis(3.0f));
+    CORRADE_COMPARE(s.transformations({fourth}), std::vector<Matrix4>{
+        Matrix4::translation({3.0f, 1.0f, 1.0f})
+    });
+
+    /* Deleting an object */
+    Object3D* fifth = new Object3D{&first};
+    CORRADE_COMPARE(s.transformations({*fifth}), std::vector<Matrix4>{
+        Matrix4::translation(Vector3::xAxis(1.0f))
+    });
+    delete fifth;
+    CORRADE_COMPARE(s.transformations({fourth, first}), (std::vector<Matrix4>{
+        Matrix4::translation({3.0f, 1.0f, 1.0f}),
+        Matrix4::translation(Vector3::xAxis(1.0f))
+    }));
+}
+
+void ObjectTest::transformationsFlatOrphan() {
+    std::ostringstream o;
+    Error redirectError{&o};
+
+    Scene3D s;
+    s.setFlatHierarchyEnabled(true);
+    Object3D first(&s);
+    CORRADE_COMPARE(s.transformations({first}).size(), 1);
+
+    /* Object not part of the scene, also when it was before */
+    Object3D orphan;
+    first.setParent(nullptr);
+    CORRADE_COMPARE(s.transformations({orphan}), std::vector<Matrix4>());
+    CORRADE_COMPARE(s.transformations({first}), std::vector<Matrix4>());
+    CORRADE_COMPARE(o.str(),
+        "SceneGraph::Object::transformations(): the objects are not part of the same tree\n"
+        "SceneGraph::Object::transformations(): the objects are not part of the same tree\n");
+}
+
+void ObjectTest::transformationMatricesFlatMultipleCameras() {
+    Scene3D s;
+    s.setFlatHierarchyEnabled(true);
+
+    Object3D first(&s);
+    first.translate(Vector3::xAxis(1.0f));
+    Object3D second(&first);
+    second.rotateY(Deg(90.0f));
+
+    /* Two cameras in the same frame get the cached matrices multiplied by
+       their own matrix */
+    const Matrix4 a = Matrix4::translation(Vector3::zAxis(-5.0f));
+    const Matrix4 b = Matrix4::rotationX(Deg(45.0f));
+    CORRADE_COMPARE(s.transformationMatrices({second, first}, a), (std::vector<Matrix4>{
+        a*Matrix4::translation(Vector3::xAxis(1.0f))*Matrix4::rotationY(Deg(90.0f)),
+        a*Matrix4::translation(Vector3::xAxis(1.0f))
+    }));
+    CORRADE_COMPARE(s.transformationMatrices({second, first}, b), (std::vector<Matrix4>{
+        b*Matrix4::translation(Vector3::xAxis(1.0f))*Matrix4::rotationY(Deg(90.0f)),
+        b*Matrix4::translation(Vector3::xAxis(1.0f))
+    }));
+
+    /* A change between the two draws is picked up */
+    first.translate(Vector3::yAxis(2.0f));
+    CORRADE_COMPARE(s.transformationMatrices({second}, a), std::vector<Matrix4>{
+        a*Matrix4::translation({1.0f, 2.0f, 0.0f})*Matrix4::rotationY(Deg(90.0f))
+    });
+    CORRADE_COMPARE(s.transformationMatrices({second}, b), std::vector<Matrix4>{
+        b*Matrix4::translation({1.0f, 2.0f, 0.0f})*Matrix4::rotationY(Deg(90.0f))
+    });
+
+    /* Also a change of an object that's not queried but is already dirty */
+    second.resetTransformation();
+    CORRADE_COMPARE(s.transformationMatrices({second}, b), std::vector<Matrix4>{
+        b*Matrix4::translation({1.0f, 2.0f, 0.0f})
+    });
+}
+
+void ObjectTest::transformationMatricesFlatDualQuaternion() {
+    typedef SceneGraph::Object<SceneGraph::DualQuaternionTransformation> Object3DQ;
+    typedef SceneGraph::Scene<SceneGraph::DualQuaternionTransformation> Scene3DQ;
+
+    Scene3DQ flat, regular;
+    flat.setFlatHierarchyEnabled(true);
+
+    Object3DQ flatFirst{&flat}, regularFirst{&regular};
+    flatFirst.rotateZ(Deg(30.0f)).translate(Vector3::xAxis(3.0f));
+    regularFirst.rotateZ(Deg(30.0f)).translate(Vector3::xAxis(3.0f));
+    Object3DQ flatSecond{&flatFirst}, regularSecond{&regularFirst};
+    flatSecond.rotateX(Deg(60.0f));
+    regularSecond.rotateX(Deg(60.0f));
+
+    /* The cached matrices give the same result as composing dual
+       quaternions */
+    const Matrix4 camera = Matrix4::translation(Vector3::zAxis(-2.0f))*Matrix4::rotationY(Deg(15.0f));
+    const std::vector<Matrix4> expected = regular.transformationMatrices({regularSecond, regularFirst}, camera);
+    const std::vector<Matrix4> actual = flat.transformationMatrices({flatSecond, flatFirst}, camera);
+    CORRADE_COMPARE(actual.size(), 2);
+    CORRADE_COMPARE(actual[0], expected[0]);
+    CORRADE_COMPARE(actual[1], expected[1]);
+}
+
+void ObjectTest::transformationsParallel() {
+    Scene3D s;
+    Matrix4 initial = Matrix4::rotationX(Deg(90.0f)).inverted();
+
+    /* Few subtrees with many leaves, the objects listed subtree by subtree */
+    std::vector<std::reference_wrapper<Object3D>> objects;
+    for(Int i = 0; i != 8; ++i) {
+        Object3D* root = new Object3D{&s};
+        root->rotateY(Deg(10.0f*i));
+        Object3D* child = new Object3D{root};
+        child->translate(Vector3::xAxis(i));
+        for(Int j = 0; j != 40; ++j) {
+            Object3D* leaf = new Object3D{child};
+            leaf->scale(Vector3(1.0f + j));
+            objects.push_back(*leaf);
+        }
+        objects.push_back(*root);
+    }
+
+    /* Duplicates and the scene itself */
+    objects.push_back(objects[3]);
+    objects.push_back(s);
+
+    ReverseJobSystem jobSystem;
+    CORRADE_COMPARE(s.transformations(objects, jobSystem, initial), s.transformations(objects, initial));
+    CORRADE_COMPARE(jobSystem.jobCount, 6);
+
+    /* Small groups are processed serially */
+    jobSystem.jobCount = 0;
+    CORRADE_COMPARE(s.transformations({objects[0], objects[41]}, jobSystem, initial), s.transformations({objects[0], objects[41]}, initial));
+    CORRADE_COMPARE(jobSystem.jobCount, 0);
+}
+
+void ObjectTest::transformationsParallelOrphan() {
+    std::ostringstream o;
+    Error redirectError{&o};
+
+    Scene3D s;
+    std::vector<std::reference_wrapper<Object3D>> objects;
+    for(Int i = 0; i != 200; ++i)
+        objects.push_back(*new Object3D{&s});
+    Object3D orphan;
+    objects.push_back(orphan);
+
+    ReverseJobSystem jobSystem;
+    CORRADE_COMPARE(s.transformations(objects, jobSystem), std::vector<Matrix4>());
+    CORRADE_COMPARE(o.str(), "SceneGraph::Object::transformations(): the objects are not part of the same tree\n");
+}
+
+void ObjectTest::transformationsArena() {
+    Scene3D s;
+    Matrix4 initial = Matrix4::rotationX(Deg(90.0f)).inverted();
+
+    Object3D first(&s);
+    first.rotateZ(Deg(30.0f));
+    Object3D second(&first);
+    second.scale(Vector3(0.5f));
+    Object3D third(&first);
+    third.translate(Vector3::xAxis(5.0f));
+
+    const std::vector<std::reference_wrapper<Object3D>> objects{second, third, second, first, s};
+
+    FrameArena arena{4096};
+    const FrameArenaVector<Matrix4> transformations = s.transformations({objects.data(), objects.size()}, arena, initial);
+    CORRADE_COMPARE((std::vector<Matrix4>{transformations.begin(), transformations.end()}), s.transformations(objects, initial));
+    CORRADE_COMPARE(&transformations.get_allocator().arena(), &arena);
+    CORRADE_VERIFY(arena.usedSize() > 0);
+    CORRADE_COMPARE(arena.overflowCount(), 0);
+
+    const FrameArenaVector<Matrix4> matrices = s.transformationMatrices({objects.data(), objects.size()}, arena, initial);
+    CORRADE_COMPARE((std::vector<Matrix4>{matrices.begin(), matrices.end()}), s.transformationMatrices(objects, initial));
+    CORRADE_COMPARE(arena.overflowCount(), 0);
+}
+
+void ObjectTest::transformationsArenaFlat() {
+    Scene3D s;
+    s.setFlatHierarchyEnabled(true);
+
+    Object3D first(&s);
+    first.translate(Vector3::yAxis(2.0f));
+    Object3D second(&first);
+    second.rotateX(Deg(45.0f));
+
+    const std::vector<std::reference_wrapper<Object3D>> objects{second, first};
+
+    FrameArena arena{4096};
+    const FrameArenaVector<Matrix4> transformations = s.transformations({objects.data(), objects.size()}, arena);
+    CORRADE_COMPARE((std::vector<Matrix4>{transformations.begin(), transformations.end()}), (std::vector<Matrix4>{
+        Matrix4::translation(Vector3::yAxis(2.0f))*Matrix4::rotationX(Deg(45.0f)),
+        Matrix4::translation(Vector3::yAxis(2.0f))
+    }));
+    CORRADE_COMPARE(arena.overflowCount(), 0);
+}
+
 void ObjectTest::setClean() {
     Scene3D scene;
 
@@ -484,6 +812,225 @@ void ObjectTest::setCleanListBulk() {
     CORRADE_COMPARE(d.cleanedAbsoluteTransformation, Matrix4::translation(Vector3::zAxis(3.0f))*Matrix4::scaling(Vector3(-2.0f)));
 }
 
+void ObjectTest::setCleanListParallel() {
+    Scene3D scene;
+    Object3D a(&scene);
+    a.translate(Vector3::zAxis(3.0f));
+
+    std::vector<std::reference_wrapper<Object3D>> objects;
+    for(Int i = 0; i != 200; ++i) {
+        CachingObject* o = new CachingObject{&a};
+        o->scale(Vector3(1.0f + i));
+        objects.push_back(*o);
+    }
+
+    ReverseJobSystem jobSystem;
+    Object3D::setClean(objects, jobSystem);
+    CORRADE_VERIFY(jobSystem.jobCount > 1);
+    CORRADE_VERIFY(!a.isDirty());
+    for(Int i = 0; i != 200; ++i) {
+        CachingObject& o = static_cast<CachingObject&>(objects[i].get());
+        CORRADE_VERIFY(!o.isDirty());
+        CORRADE_COMPARE(o.cleanedAbsoluteTransformation, Matrix4::translation(Vector3::zAxis(3.0f))*Matrix4::scaling(Vector3(1.0f + i)));
+    }
+}
+
+void ObjectTest::setCleanListArena() {
+    FrameArena arena{4096};
+
+    /* Verify it doesn't crash when passed empty list */
+    Object3D::setClean(nullptr, arena);
+
+    Scene3D scene;
+    Object3D a(&scene);
+    a.translate(Vector3::zAxis(3.0f));
+    CachingObject b(&a);
+    b.scale(Vector3(-2.0f));
+    CachingObject c(&scene);
+    c.setClean();
+
+    const std::vector<std::reference_wrapper<Object3D>> objects{b, c};
+    Object3D::setClean({objects.data(), objects.size()}, arena);
+    CORRADE_VERIFY(!a.isDirty());
+    CORRADE_VERIFY(!b.isDirty());
+    CORRADE_COMPARE(b.cleanedAbsoluteTransformation, Matrix4::translation(Vector3::zAxis(3.0f))*Matrix4::scaling(Vector3(-2.0f)));
+    CORRADE_VERIFY(arena.usedSize() > 0);
+    CORRADE_COMPARE(arena.overflowCount(), 0);
+
+    /* Through the abstract interface */
+    b.translate(Vector3::xAxis(1.0f));
+    const std::vector<std::reference_wrapper<AbstractObject3D>> abstractObjects{b};
+    AbstractObject3D::setClean({abstractObjects.data(), abstractObjects.size()}, arena);
+    CORRADE_VERIFY(!b.isDirty());
+    CORRADE_COMPARE(b.cleanedAbsoluteTransformation, Matrix4::translation({1.0f, 0.0f, 3.0f})*Matrix4::scaling(Vector3(-2.0f)));
+}
+
+namespace {
+    class DirtyCountingObject: public CachingObject {
+        public:
+            DirtyCountingObject(Object3D* parent = nullptr): CachingObject{parent} {}
+
+            Int markedDirty{};
+
+        protected:
+            void markDirty() override { ++markedDirty; }
+    };
+}
+
+void ObjectTest::setCleanLazy() {
+    Scene3D scene;
+    CORRADE_VERIFY(!scene.isLazyDirtyEnabled());
+    scene.setLazyDirtyEnabled(true);
+    CORRADE_VERIFY(scene.isLazyDirtyEnabled());
+
+    DirtyCountingObject a{&scene};
+    a.translate(Vector3::xAxis(1.0f));
+    DirtyCountingObject b{&a};
+    b.translate(Vector3::yAxis(2.0f));
+    DirtyCountingObject c{&b};
+    c.scale(Vector3(3.0f));
+
+    CORRADE_VERIFY(a.isDirty());
+    CORRADE_VERIFY(b.isDirty());
+    CORRADE_VERIFY(c.isDirty());
+
+    c.setClean();
+    CORRADE_VERIFY(!a.isDirty());
+    CORRADE_VERIFY(!b.isDirty());
+    CORRADE_VERIFY(!c.isDirty());
+    CORRADE_COMPARE(c.cleanedAbsoluteTransformation, c.absoluteTransformationMatrix());
+
+    /* Moving the root doesn't touch the children, only the root features are
+       notified */
+    const Int bMarked = b.markedDirty;
+    const Int cMarked = c.markedDirty;
+    a.translate(Vector3::zAxis(5.0f));
+    CORRADE_VERIFY(a.isDirty());
+    CORRADE_COMPARE(b.markedDirty, bMarked);
+    CORRADE_COMPARE(c.markedDirty, cMarked);
+
+    /* But they report dirty lazily */
+    CORRADE_VERIFY(b.isDirty());
+    CORRADE_VERIFY(c.isDirty());
+
+    /* Cleaning the middle one cleans the parent too, but not the child. The
+       features are notified right before cleaning. */
+    b.setClean();
+    CORRADE_VERIFY(!a.isDirty());
+    CORRADE_VERIFY(!b.isDirty());
+    CORRADE_VERIFY(c.isDirty());
+    CORRADE_COMPARE(b.markedDirty, bMarked + 1);
+    CORRADE_COMPARE(c.markedDirty, cMarked);
+    CORRADE_COMPARE(b.cleanedAbsoluteTransformation, b.absoluteTransformationMatrix());
+
+    c.setClean();
+    CORRADE_VERIFY(!c.isDirty());
+    CORRADE_COMPARE(c.markedDirty, cMarked + 1);
+    CORRADE_COMPARE(c.cleanedAbsoluteTransformation, c.absoluteTransformationMatrix());
+
+    /* Changing a child doesn't affect the parent */
+    c.translate(Vector3::xAxis(1.0f));
+    CORRADE_VERIFY(!a.isDirty());
+    CORRADE_VERIFY(!b.isDirty());
+    CORRADE_VERIFY(c.isDirty());
+}
+
+void ObjectTest::setCleanLazyList() {
+    Scene3D scene;
+    scene.setLazyDirtyEnabled(true);
+
+    Object3D a{&scene};
+    std::vector<std::reference_wrapper<Object3D>> objects;
+    for(Int i = 0; i != 10; ++i) {
+        Object3D* parent = &a;
+        for(Int j = 0; j != 3; ++j) {
+            CachingObject* o = new CachingObject{parent};
+            o->translate(Vector3::xAxis(Float(i + j)));
+            objects.push_back(*o);
+            parent = o;
+        }
+    }
+
+    Object3D::setClean(objects);
+    for(Object3D& o: objects) CORRADE_VERIFY(!o.isDirty());
+
+    a.rotateY(Deg(90.0f));
+    for(Object3D& o: objects) CORRADE_VERIFY(o.isDirty());
+
+    Object3D::setClean(objects);
+    for(Object3D& o: objects) {
+        CORRADE_VERIFY(!o.isDirty());
+        CORRADE_COMPARE(static_cast<CachingObject&>(o).cleanedAbsoluteTransformation, o.absoluteTransformationMatrix());
+    }
+}
+
+void ObjectTest::setCleanLazyReparent() {
+    Scene3D scene;
+    scene.setLazyDirtyEnabled(true);
+
+    /* Objects created outside of the scene take over its mode when added */
+    Object3D a;
+    a.translate(Vector3::xAxis(1.0f));
+    CachingObject b{&a};
+    a.setParent(&scene);
+
+    b.setClean();
+    CORRADE_VERIFY(!a.isDirty());
+    CORRADE_VERIFY(!b.isDirty());
+
+    /* Moving the subtree under another object makes it dirty */
+    Object3D c{&scene};
+    c.translate(Vector3::yAxis(2.0f));
+    c.setClean();
+    a.setParent(&c);
+    CORRADE_VERIFY(a.isDirty());
+    CORRADE_VERIFY(b.isDirty());
+
+    b.setClean();
+    CORRADE_COMPARE(b.cleanedAbsoluteTransformation, Matrix4::translation({1.0f, 2.0f, 0.0f}));
+
+    /* Removing the subtree from the scene switches it back to eager
+       propagation */
+    a.setParent(nullptr);
+    CORRADE_VERIFY(a.isDirty());
+    CORRADE_VERIFY(b.isDirty());
+    b.setClean();
+    a.translate(Vector3::xAxis(1.0f));
+    CORRADE_VERIFY(b.isDirty());
+}
+
+void ObjectTest::setCleanLazyDisable() {
+    Scene3D scene;
+    scene.setLazyDirtyEnabled(true);
+
+    DirtyCountingObject a{&scene};
+    DirtyCountingObject b{&a};
+    DirtyCountingObject c{&b};
+    Object3D d{&scene};
+    Object3D::setClean({c, d});
+
+    a.translate(Vector3::xAxis(1.0f));
+    const Int cMarked = c.markedDirty;
+
+    /* The lazily propagated change gets materialized in the children */
+    scene.setLazyDirtyEnabled(false);
+    CORRADE_VERIFY(!scene.isLazyDirtyEnabled());
+    CORRADE_VERIFY(a.isDirty());
+    CORRADE_VERIFY(b.isDirty());
+    CORRADE_VERIFY(c.isDirty());
+    CORRADE_VERIFY(!d.isDirty());
+    CORRADE_COMPARE(c.markedDirty, cMarked + 1);
+
+    /* Eager propagation works again */
+    c.setClean();
+    CORRADE_VERIFY(!a.isDirty());
+    a.translate(Vector3::xAxis(1.0f));
+    CORRADE_COMPARE(c.markedDirty, cMarked + 2);
+    CORRADE_VERIFY(c.isDirty());
+    c.setClean();
+    CORRADE_COMPARE(c.cleanedAbsoluteTransformation, Matrix4::translation(Vector3::xAxis(2.0f)));
+}
+
 void ObjectTest::rangeBasedForChildren() {
     Scene3D scene;
     Object3D a(&scene);
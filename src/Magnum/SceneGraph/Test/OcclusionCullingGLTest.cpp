@@ -0,0 +1,189 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Framebuffer.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/Renderbuffer.h"
+#include "Magnum/RenderbufferFormat.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/OcclusionCulling.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+struct OcclusionCullingGLTest: OpenGLTester {
+    explicit OcclusionCullingGLTest();
+
+    void construct();
+
+    void noBoundingBox();
+    void occluded();
+    void nearPlane();
+};
+
+OcclusionCullingGLTest::OcclusionCullingGLTest() {
+    addTests({&OcclusionCullingGLTest::construct,
+
+              &OcclusionCullingGLTest::noBoundingBox,
+              &OcclusionCullingGLTest::occluded,
+              &OcclusionCullingGLTest::nearPlane});
+}
+
+namespace {
+    /* Doesn't produce any samples on its own, so its query always fails and
+       only the bounding box proxy can make it visible again */
+    struct CountingDrawable: Drawable3D {
+        explicit CountingDrawable(Object3D& object, DrawableGroup3D& group): Drawable3D{object, &group} {}
+
+        void draw(const Matrix4&, Camera3D&) override { ++count; }
+
+        Int count{};
+    };
+
+    struct Setup {
+        explicit Setup(): framebuffer{{{}, Vector2i{32}}}, cameraObject{&scene}, camera{cameraObject} {
+            #ifndef MAGNUM_TARGET_GLES2
+            color.setStorage(RenderbufferFormat::RGBA8, Vector2i{32});
+            #else
+            color.setStorage(RenderbufferFormat::RGBA4, Vector2i{32});
+            #endif
+            depth.setStorage(RenderbufferFormat::DepthComponent16, Vector2i{32});
+            framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment{0}, color)
+                .attachRenderbuffer(Framebuffer::BufferAttachment::Depth, depth)
+                .clear(FramebufferClear::Color|FramebufferClear::Depth)
+                .bind();
+
+            camera.setProjectionMatrix(Matrix4::perspectiveProjection(Deg(60.0f), 1.0f, 0.1f, 100.0f));
+        }
+
+        Renderbuffer color, depth;
+        Framebuffer framebuffer;
+        Scene3D scene;
+        Object3D cameraObject;
+        Camera3D camera;
+        DrawableGroup3D drawables;
+    };
+}
+
+void OcclusionCullingGLTest::construct() {
+    OcclusionCulling culling;
+
+    MAGNUM_VERIFY_NO_ERROR();
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_VERIFY(culling.conditionalRenderMode() == SampleQuery::ConditionalRenderMode::Wait);
+    #endif
+}
+
+void OcclusionCullingGLTest::noBoundingBox() {
+    Setup s;
+    Object3D object{&s.scene};
+    object.translate(Vector3::zAxis(-5.0f));
+    CountingDrawable drawable{object, s.drawables};
+
+    OcclusionCulling culling;
+    CORRADE_COMPARE(culling.draw(s.camera, s.drawables), 0);
+    Renderer::finish();
+    CORRADE_COMPARE(culling.draw(s.camera, s.drawables), 0);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(drawable.count, 2);
+}
+
+void OcclusionCullingGLTest::occluded() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::ES3_compatibility>())
+        CORRADE_SKIP(Extensions::GL::ARB::ES3_compatibility::string() + std::string(" is not available."));
+    #elif defined(MAGNUM_TARGET_GLES2)
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::occlusion_query_boolean>())
+        CORRADE_SKIP(Extensions::GL::EXT::occlusion_query_boolean::string() + std::string(" is not available."));
+    #endif
+
+    Setup s;
+    Object3D object{&s.scene};
+    object.translate(Vector3::zAxis(-5.0f));
+    CountingDrawable drawable{object, s.drawables};
+    drawable.setBoundingBox({Vector3{-1.0f}, Vector3{1.0f}});
+
+    OcclusionCulling culling;
+
+    /* Not seen before, drawn as visible, but the query fails */
+    CORRADE_COMPARE(culling.draw(s.camera, s.drawables), 0);
+    CORRADE_COMPARE(drawable.count, 1);
+    Renderer::finish();
+
+    /* Occluded now, the bounding box is queried instead. There's nothing in
+       the depth buffer, so the conditional render passes. */
+    CORRADE_COMPARE(culling.draw(s.camera, s.drawables), 1);
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_COMPARE(drawable.count, 2);
+    #else
+    CORRADE_COMPARE(drawable.count, 1);
+    #endif
+    Renderer::finish();
+
+    /* The bounding box query passed, visible again */
+    CORRADE_COMPARE(culling.draw(s.camera, s.drawables), 0);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void OcclusionCullingGLTest::nearPlane() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::ES3_compatibility>())
+        CORRADE_SKIP(Extensions::GL::ARB::ES3_compatibility::string() + std::string(" is not available."));
+    #elif defined(MAGNUM_TARGET_GLES2)
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::occlusion_query_boolean>())
+        CORRADE_SKIP(Extensions::GL::EXT::occlusion_query_boolean::string() + std::string(" is not available."));
+    #endif
+
+    Setup s;
+    Object3D object{&s.scene};
+    CountingDrawable drawable{object, s.drawables};
+    drawable.setBoundingBox({Vector3{-1.0f}, Vector3{1.0f}});
+
+    OcclusionCulling culling;
+    CORRADE_COMPARE(culling.draw(s.camera, s.drawables), 0);
+    Renderer::finish();
+
+    /* The query failed, but the camera is inside the box so it's drawn
+       anyway */
+    CORRADE_COMPARE(culling.draw(s.camera, s.drawables), 0);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(drawable.count, 2);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::OcclusionCullingGLTest)
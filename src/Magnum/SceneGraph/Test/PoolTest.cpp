@@ -0,0 +1,279 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <string>
+
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Object.h"
+#include "Magnum/SceneGraph/Pool.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct PoolTest: TestSuite::Tester {
+    explicit PoolTest();
+
+    void construct();
+    void constructInvalidAlignment();
+    void allocate();
+    void reuse();
+    void reserve();
+    void deallocateNull();
+    void deallocateForeign();
+
+    void pooledObject();
+    void pooledFeature();
+    void pooledDerived();
+
+    void featureGroupReserve();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+PoolTest::PoolTest() {
+    addTests({&PoolTest::construct,
+              &PoolTest::constructInvalidAlignment,
+              &PoolTest::allocate,
+              &PoolTest::reuse,
+              &PoolTest::reserve,
+              &PoolTest::deallocateNull,
+              &PoolTest::deallocateForeign,
+
+              &PoolTest::pooledObject,
+              &PoolTest::pooledFeature,
+              &PoolTest::pooledDerived,
+
+              &PoolTest::featureGroupReserve});
+}
+
+void PoolTest::construct() {
+    SlabPool pool{sizeof(Vector3), alignof(Vector3), 16};
+    CORRADE_COMPARE(pool.slotsPerSlab(), 16);
+    CORRADE_COMPARE(pool.slabCount(), 0);
+    CORRADE_COMPARE(pool.usedCount(), 0);
+
+    /* Slots are large enough for the free list pointer and aligned to it */
+    CORRADE_VERIFY(pool.slotSize() >= sizeof(Vector3));
+    CORRADE_VERIFY(pool.slotSize() >= sizeof(void*));
+    CORRADE_COMPARE(pool.slotSize() % alignof(void*), 0);
+
+    SlabPool small{1, 1, 4};
+    CORRADE_COMPARE(small.slotSize(), sizeof(void*));
+}
+
+void PoolTest::constructInvalidAlignment() {
+    std::ostringstream out;
+    Error redirectError{&out};
+    SlabPool pool{16, 3, 4};
+    CORRADE_COMPARE(out.str(), "SceneGraph::SlabPool: expected alignment to be a power of two not larger than " + std::to_string(alignof(std::max_align_t)) + " but got 3\n");
+}
+
+void PoolTest::allocate() {
+    SlabPool pool{32, 8, 4};
+
+    void* a = pool.allocate();
+    void* b = pool.allocate();
+    CORRADE_COMPARE(pool.slabCount(), 1);
+    CORRADE_COMPARE(pool.usedCount(), 2);
+
+    /* Consecutive allocations from a fresh slab are adjacent */
+    CORRADE_COMPARE(static_cast<char*>(b) - static_cast<char*>(a), std::ptrdiff_t(pool.slotSize()));
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(a) % 8, 0);
+
+    /* Exhausting the slab allocates a new one */
+    void* c = pool.allocate();
+    void* d = pool.allocate();
+    void* e = pool.allocate();
+    CORRADE_COMPARE(pool.slabCount(), 2);
+    CORRADE_COMPARE(pool.usedCount(), 5);
+
+    for(void* i: {a, b, c, d, e}) pool.deallocate(i);
+    CORRADE_COMPARE(pool.slabCount(), 2);
+    CORRADE_COMPARE(pool.usedCount(), 0);
+}
+
+void PoolTest::reuse() {
+    SlabPool pool{16, 4, 8};
+
+    void* a = pool.allocate();
+    void* b = pool.allocate();
+    pool.deallocate(a);
+
+    /* The most recently released slot is reused first */
+    CORRADE_COMPARE(pool.allocate(), a);
+    CORRADE_COMPARE(pool.slabCount(), 1);
+    CORRADE_COMPARE(pool.usedCount(), 2);
+
+    pool.deallocate(a);
+    pool.deallocate(b);
+}
+
+void PoolTest::reserve() {
+    SlabPool pool{16, 4, 4};
+
+    void* a = pool.allocate();
+    CORRADE_COMPARE(pool.slabCount(), 1);
+
+    /* Three slots are still free, so nothing needs to be allocated */
+    pool.reserve(3);
+    CORRADE_COMPARE(pool.slabCount(), 1);
+
+    /* Two more slabs are needed for ten slots */
+    pool.reserve(10);
+    CORRADE_COMPARE(pool.slabCount(), 3);
+    CORRADE_COMPARE(pool.usedCount(), 1);
+
+    /* Slots of the new slabs are handed out first, contiguously */
+    void* b = pool.allocate();
+    void* c = pool.allocate();
+    CORRADE_COMPARE(static_cast<char*>(c) - static_cast<char*>(b), std::ptrdiff_t(pool.slotSize()));
+
+    std::vector<void*> slots;
+    for(std::size_t i = 0; i != 8; ++i) slots.push_back(pool.allocate());
+    CORRADE_COMPARE(pool.slabCount(), 3);
+    CORRADE_COMPARE(pool.usedCount(), 11);
+
+    pool.deallocate(a);
+    pool.deallocate(b);
+    pool.deallocate(c);
+    for(void* i: slots) pool.deallocate(i);
+}
+
+void PoolTest::deallocateNull() {
+    SlabPool pool{16, 4, 8};
+    pool.deallocate(nullptr);
+    CORRADE_COMPARE(pool.usedCount(), 0);
+}
+
+void PoolTest::deallocateForeign() {
+    SlabPool pool{16, 4, 8};
+    void* a = pool.allocate();
+    int foreign;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    pool.deallocate(&foreign);
+    CORRADE_COMPARE(out.str(), "SceneGraph::SlabPool::deallocate(): memory not allocated from this pool\n");
+    CORRADE_COMPARE(pool.usedCount(), 1);
+
+    pool.deallocate(a);
+}
+
+namespace {
+
+class PooledObject: public Object3D, public Pooled<PooledObject, 8> {
+    public:
+        explicit PooledObject(Object3D* parent): Object3D{parent} {}
+};
+
+class PooledDrawable: public Drawable3D, public Pooled<PooledDrawable, 8> {
+    public:
+        explicit PooledDrawable(AbstractObject3D& object, DrawableGroup3D* group): Drawable3D{object, group} {}
+
+    private:
+        void draw(const Matrix4&, Camera3D&) override {}
+};
+
+class DerivedPooledObject: public PooledObject {
+    public:
+        explicit DerivedPooledObject(Object3D* parent): PooledObject{parent} {}
+
+        Vector3 velocity;
+};
+
+}
+
+void PoolTest::pooledObject() {
+    SlabPool& pool = PooledObject::pool();
+    const std::size_t usedBefore = pool.usedCount();
+
+    {
+        Scene3D scene;
+        auto a = new PooledObject{&scene};
+        auto b = new PooledObject{&scene};
+        CORRADE_COMPARE(pool.usedCount(), usedBefore + 2);
+        CORRADE_COMPARE(a->parent(), &scene);
+        CORRADE_COMPARE(b->parent(), &scene);
+
+        /* Deleting explicitly releases the slot */
+        delete b;
+        CORRADE_COMPARE(pool.usedCount(), usedBefore + 1);
+
+        /* Children are pooled too and get reused */
+        new PooledObject{a};
+        CORRADE_COMPARE(pool.usedCount(), usedBefore + 2);
+    }
+
+    /* The scene deleted its children through the base class, releasing the
+       slots back to the pool */
+    CORRADE_COMPARE(pool.usedCount(), usedBefore);
+}
+
+void PoolTest::pooledFeature() {
+    SlabPool& pool = PooledDrawable::pool();
+    const std::size_t usedBefore = pool.usedCount();
+
+    {
+        Scene3D scene;
+        DrawableGroup3D group;
+        for(std::size_t i = 0; i != 20; ++i)
+            new PooledDrawable{*new Object3D{&scene}, &group};
+        CORRADE_COMPARE(group.size(), 20);
+        CORRADE_COMPARE(pool.usedCount(), usedBefore + 20);
+        CORRADE_VERIFY(pool.slabCount() >= 3);
+
+        /* Features created in a row are adjacent in memory */
+        CORRADE_COMPARE(reinterpret_cast<char*>(&group[1]) - reinterpret_cast<char*>(&group[0]), std::ptrdiff_t(pool.slotSize()));
+    }
+
+    CORRADE_COMPARE(pool.usedCount(), usedBefore);
+}
+
+void PoolTest::pooledDerived() {
+    SlabPool& pool = PooledObject::pool();
+    const std::size_t usedBefore = pool.usedCount();
+
+    Scene3D scene;
+    auto a = new DerivedPooledObject{&scene};
+
+    /* Different size, goes to the global heap */
+    CORRADE_COMPARE(pool.usedCount(), usedBefore);
+    delete a;
+    CORRADE_COMPARE(pool.usedCount(), usedBefore);
+}
+
+void PoolTest::featureGroupReserve() {
+    DrawableGroup3D group;
+    CORRADE_COMPARE(&group.reserve(64), &group);
+    CORRADE_VERIFY(group.isEmpty());
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::PoolTest)
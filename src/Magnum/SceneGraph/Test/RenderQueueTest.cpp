@@ -0,0 +1,367 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/MatrixTransformation2D.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/RenderQueue.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+using namespace Math::Literals;
+
+struct RenderQueueTest: TestSuite::Tester {
+    explicit RenderQueueTest();
+
+    void radixSort();
+    void radixSortSameDigits();
+
+    void construct();
+    void clear();
+    void addOutOfRange();
+
+    void sortState();
+    void sortDepth();
+    void sortTransparent();
+    void sort2D();
+    void transformations();
+    void noScene();
+
+    void debugRenderLayer();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation2D> Scene2D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+RenderQueueTest::RenderQueueTest() {
+    addTests({&RenderQueueTest::radixSort,
+              &RenderQueueTest::radixSortSameDigits,
+
+              &RenderQueueTest::construct,
+              &RenderQueueTest::clear,
+              &RenderQueueTest::addOutOfRange,
+
+              &RenderQueueTest::sortState,
+              &RenderQueueTest::sortDepth,
+              &RenderQueueTest::sortTransparent,
+              &RenderQueueTest::sort2D,
+              &RenderQueueTest::transformations,
+              &RenderQueueTest::noScene,
+
+              &RenderQueueTest::debugRenderLayer});
+}
+
+namespace {
+
+template<UnsignedInt dimensions> class OrderDrawable: public Drawable<dimensions, Float> {
+    public:
+        explicit OrderDrawable(AbstractObject<dimensions, Float>& object, Int id, std::vector<Int>& order): Drawable<dimensions, Float>{object}, _id{id}, _order(order) {}
+
+    private:
+        void draw(const MatrixTypeFor<dimensions, Float>&, Camera<dimensions, Float>&) override {
+            _order.push_back(_id);
+        }
+
+        Int _id;
+        std::vector<Int>& _order;
+};
+
+typedef OrderDrawable<2> OrderDrawable2D;
+typedef OrderDrawable<3> OrderDrawable3D;
+
+}
+
+void RenderQueueTest::radixSort() {
+    std::vector<std::uint64_t> keys{0x0100000000000003ull, 0x0000000000000002ull,
+        0xff00000000000001ull, 0x0000000000000002ull, 0x0000000000010000ull};
+    std::vector<UnsignedInt> indices{0, 1, 2, 3, 4};
+    std::vector<std::uint64_t> keysScratch;
+    std::vector<UnsignedInt> indicesScratch;
+    Implementation::radixSort(keys, indices, keysScratch, indicesScratch);
+
+    CORRADE_COMPARE_AS(keys, (std::vector<std::uint64_t>{0x0000000000000002ull,
+        0x0000000000000002ull, 0x0000000000010000ull, 0x0100000000000003ull,
+        0xff00000000000001ull}), TestSuite::Compare::Container);
+    /* The sort is stable */
+    CORRADE_COMPARE_AS(indices, (std::vector<UnsignedInt>{1, 3, 4, 0, 2}),
+        TestSuite::Compare::Container);
+}
+
+void RenderQueueTest::radixSortSameDigits() {
+    /* All passes skipped, order kept */
+    std::vector<std::uint64_t> keys{0xabcdull, 0xabcdull, 0xabcdull};
+    std::vector<UnsignedInt> indices{2, 0, 1};
+    std::vector<std::uint64_t> keysScratch;
+    std::vector<UnsignedInt> indicesScratch;
+    Implementation::radixSort(keys, indices, keysScratch, indicesScratch);
+
+    CORRADE_COMPARE_AS(indices, (std::vector<UnsignedInt>{2, 0, 1}),
+        TestSuite::Compare::Container);
+}
+
+void RenderQueueTest::construct() {
+    RenderQueue3D queue;
+    CORRADE_VERIFY(queue.isEmpty());
+    CORRADE_COMPARE(queue.size(), 0);
+}
+
+void RenderQueueTest::clear() {
+    Scene3D scene;
+    Object3D object{&scene};
+    std::vector<Int> order;
+    OrderDrawable3D a{object, 0, order};
+
+    RenderQueue3D queue;
+    queue.add(a, 0, 0, 0)
+        .add(a, 1, 1, 1, RenderLayer::Transparent);
+    CORRADE_VERIFY(!queue.isEmpty());
+    CORRADE_COMPARE(queue.size(), 2);
+
+    queue.clear();
+    CORRADE_VERIFY(queue.isEmpty());
+}
+
+void RenderQueueTest::addOutOfRange() {
+    Scene3D scene;
+    Object3D object{&scene};
+    std::vector<Int> order;
+    OrderDrawable3D a{object, 0, order};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    RenderQueue3D queue;
+    queue.add(a, 4096, 0, 0)
+        .add(a, 0, 65536, 0)
+        .add(a, 0, 0, 4096);
+    CORRADE_COMPARE(queue.size(), 0);
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::RenderQueue::add(): expected program, material and mesh ID to be at most 4095, 65535 and 4095 but got 4096, 0 and 0\n"
+        "SceneGraph::RenderQueue::add(): expected program, material and mesh ID to be at most 4095, 65535 and 4095 but got 0, 65536 and 0\n"
+        "SceneGraph::RenderQueue::add(): expected program, material and mesh ID to be at most 4095, 65535 and 4095 but got 0, 0 and 4096\n");
+}
+
+void RenderQueueTest::sortState() {
+    Scene3D scene;
+    Object3D object{&scene};
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+
+    /* All at the same depth, the order is program, material, mesh and
+       submission order for equal state */
+    std::vector<Int> order;
+    OrderDrawable3D a{object, 0, order};
+    OrderDrawable3D b{object, 1, order};
+    OrderDrawable3D c{object, 2, order};
+    OrderDrawable3D d{object, 3, order};
+    OrderDrawable3D e{object, 4, order};
+    OrderDrawable3D f{object, 5, order};
+
+    RenderQueue3D queue;
+    queue.add(a, 2, 0, 0)
+        .add(b, 1, 7, 3)
+        .add(c, 1, 0, 5)
+        .add(d, 2, 0, 0)
+        .add(e, 1, 7, 1)
+        .add(f, 0, 65535, 4095);
+    queue.draw(camera);
+
+    CORRADE_COMPARE_AS(order, (std::vector<Int>{5, 2, 4, 1, 0, 3}),
+        TestSuite::Compare::Container);
+
+    /* Drawing again gives the same result */
+    order.clear();
+    queue.draw(camera);
+    CORRADE_COMPARE_AS(order, (std::vector<Int>{5, 2, 4, 1, 0, 3}),
+        TestSuite::Compare::Container);
+}
+
+void RenderQueueTest::sortDepth() {
+    Scene3D scene;
+    Object3D near{&scene};
+    near.translate(Vector3::zAxis(-1.0f));
+    Object3D far{&scene};
+    far.translate(Vector3::zAxis(-10.0f));
+    Object3D behind{&scene};
+    behind.translate(Vector3::zAxis(5.0f));
+    Object3D middle{&scene};
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+
+    std::vector<Int> order;
+    OrderDrawable3D a{far, 0, order};
+    OrderDrawable3D b{near, 1, order};
+    OrderDrawable3D c{behind, 2, order};
+    OrderDrawable3D d{far, 3, order};
+    /* Bounding box center is used if present */
+    OrderDrawable3D e{middle, 4, order};
+    e.setBoundingBox({{-1.0f, -1.0f, -6.0f}, {1.0f, 1.0f, -4.0f}});
+
+    /* Opaque drawables with the same state are drawn front to back, state
+       has precedence over depth */
+    RenderQueue3D queue;
+    queue.add(a, 0, 0, 0)
+        .add(b, 0, 0, 0)
+        .add(c, 0, 0, 0)
+        .add(d, 0, 0, 1)
+        .add(e, 0, 0, 0);
+    queue.draw(camera);
+
+    CORRADE_COMPARE_AS(order, (std::vector<Int>{2, 1, 4, 0, 3}),
+        TestSuite::Compare::Container);
+
+    /* Turning the camera around changes the order */
+    cameraObject.rotateY(180.0_degf)
+        .translate(Vector3::zAxis(-20.0f));
+    order.clear();
+    queue.draw(camera);
+    CORRADE_COMPARE_AS(order, (std::vector<Int>{0, 4, 1, 2, 3}),
+        TestSuite::Compare::Container);
+}
+
+void RenderQueueTest::sortTransparent() {
+    Scene3D scene;
+    Object3D near{&scene};
+    near.translate(Vector3::zAxis(-1.0f));
+    Object3D far{&scene};
+    far.translate(Vector3::zAxis(-10.0f));
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+
+    std::vector<Int> order;
+    OrderDrawable3D a{near, 0, order};
+    OrderDrawable3D b{far, 1, order};
+    OrderDrawable3D c{near, 2, order};
+    OrderDrawable3D d{far, 3, order};
+    OrderDrawable3D e{far, 4, order};
+
+    /* Transparent drawables after all opaque, back to front with state
+       having precedence only at equal depth */
+    RenderQueue3D queue;
+    queue.add(a, 0, 0, 0, RenderLayer::Transparent)
+        .add(b, 3, 0, 0, RenderLayer::Transparent)
+        .add(c, 4095, 0, 0)
+        .add(d, 1, 0, 0, RenderLayer::Transparent)
+        .add(e, 2, 0, 0);
+    queue.draw(camera);
+
+    CORRADE_COMPARE_AS(order, (std::vector<Int>{4, 2, 3, 1, 0}),
+        TestSuite::Compare::Container);
+}
+
+void RenderQueueTest::sort2D() {
+    Scene2D scene;
+    Object2D first{&scene};
+    first.translate(Vector2::xAxis(5.0f));
+    Object2D second{&scene};
+    Object2D cameraObject{&scene};
+    Camera2D camera{cameraObject};
+
+    /* No depth in 2D, submission order is kept in each layer */
+    std::vector<Int> order;
+    OrderDrawable2D a{first, 0, order};
+    OrderDrawable2D b{second, 1, order};
+    OrderDrawable2D c{first, 2, order};
+    OrderDrawable2D d{second, 3, order};
+
+    RenderQueue2D queue;
+    queue.add(a, 0, 0, 0, RenderLayer::Transparent)
+        .add(b, 1, 0, 0)
+        .add(c, 0, 0, 0, RenderLayer::Transparent)
+        .add(d, 1, 0, 0);
+    queue.draw(camera);
+
+    CORRADE_COMPARE_AS(order, (std::vector<Int>{1, 3, 0, 2}),
+        TestSuite::Compare::Container);
+}
+
+void RenderQueueTest::transformations() {
+    class Drawable: public SceneGraph::Drawable3D {
+        public:
+            Drawable(AbstractObject3D& object, Matrix4& result): SceneGraph::Drawable3D(object), result(result) {}
+
+        protected:
+            void draw(const Matrix4& transformationMatrix, Camera3D&) override {
+                result = transformationMatrix;
+            }
+
+        private:
+            Matrix4& result;
+    };
+
+    Scene3D scene;
+
+    Object3D first(&scene);
+    Matrix4 firstTransformation;
+    first.scale(Vector3(5.0f));
+    Drawable a{first, firstTransformation};
+
+    Object3D second(&scene);
+    Matrix4 secondTransformation;
+    second.translate(Vector3::yAxis(3.0f));
+    Drawable b{second, secondTransformation};
+
+    Object3D third(&second);
+    third.translate(Vector3::zAxis(-1.5f));
+
+    Camera3D camera(third);
+    RenderQueue3D queue;
+    queue.add(b, 0, 0, 0)
+        .add(a, 1, 0, 0);
+    queue.draw(camera);
+
+    CORRADE_COMPARE(firstTransformation, Matrix4::translation({0.0f, -3.0f, 1.5f})*Matrix4::scaling(Vector3(5.0f)));
+    CORRADE_COMPARE(secondTransformation, Matrix4::translation(Vector3::zAxis(1.5f)));
+}
+
+void RenderQueueTest::noScene() {
+    Object3D cameraObject;
+    Camera3D camera{cameraObject};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    RenderQueue3D queue;
+    queue.draw(camera);
+    CORRADE_COMPARE(out.str(), "SceneGraph::RenderQueue::draw(): cannot draw when camera is not part of any scene\n");
+}
+
+void RenderQueueTest::debugRenderLayer() {
+    std::ostringstream out;
+    Debug{&out} << RenderLayer::Transparent << RenderLayer(0xde);
+    CORRADE_COMPARE(out.str(), "SceneGraph::RenderLayer::Transparent SceneGraph::RenderLayer(0xde)\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::RenderQueueTest)
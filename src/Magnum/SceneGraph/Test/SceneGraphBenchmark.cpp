@@ -0,0 +1,279 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string>
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/SceneGraph/Animable.h"
+#include "Magnum/SceneGraph/AnimableGroup.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/DualComplexTransformation.h"
+#include "Magnum/SceneGraph/DualQuaternionTransformation.h"
+#include "Magnum/SceneGraph/MatrixTransformation2D.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/RigidMatrixTransformation2D.h"
+#include "Magnum/SceneGraph/RigidMatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/SceneGraph/TranslationTransformation.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+/* All hierarchies have a fixed shape and all objects a small translation so
+   the results are comparable between runs and between transformation
+   types. The Animable and FeatureGroup benchmarks don't depend on the
+   transformation, so they're done only for the 2D and 3D matrix one. */
+struct SceneGraphBenchmark: TestSuite::Tester {
+    explicit SceneGraphBenchmark();
+
+    template<class Transformation> void transformationsWide();
+    template<class Transformation> void transformationsDeep();
+    template<class Transformation> void transformationsMixed();
+    template<class Transformation> void setDirtyDeep();
+    template<class Transformation> void cameraDraw();
+    template<class Transformation> void animableGroupStep();
+    template<class Transformation> void featureGroupChurn();
+
+    private:
+        template<class Transformation> void addTransformationBenchmarks();
+};
+
+namespace {
+    template<class> struct TransformationName;
+    #define _c(type) template<> struct TransformationName<type> {          \
+        static const char* name() { return #type; }                         \
+    };
+    _c(DualComplexTransformation)
+    _c(DualQuaternionTransformation)
+    _c(MatrixTransformation2D)
+    _c(MatrixTransformation3D)
+    _c(RigidMatrixTransformation2D)
+    _c(RigidMatrixTransformation3D)
+    _c(TranslationTransformation2D)
+    _c(TranslationTransformation3D)
+    #undef _c
+
+    template<class Transformation> std::string caseName(const char* name) {
+        return std::string{name} + "<" + TransformationName<Transformation>::name() + ">";
+    }
+
+    template<class Transformation> Object<Transformation>* translatedObject(Object<Transformation>* parent) {
+        Object<Transformation>* object = new Object<Transformation>{parent};
+        object->translate(VectorTypeFor<Transformation::Dimensions, typename Transformation::Type>{typename Transformation::Type(0.5)});
+        return object;
+    }
+
+    /* One root with 4096 children */
+    template<class Transformation> std::vector<std::reference_wrapper<Object<Transformation>>> wideHierarchy(Scene<Transformation>& scene) {
+        Object<Transformation>* root = translatedObject<Transformation>(&scene);
+        std::vector<std::reference_wrapper<Object<Transformation>>> objects;
+        for(std::size_t i = 0; i != 4096; ++i)
+            objects.push_back(*translatedObject(root));
+        return objects;
+    }
+
+    /* Chain of 1024 objects */
+    template<class Transformation> std::vector<std::reference_wrapper<Object<Transformation>>> deepHierarchy(Scene<Transformation>& scene) {
+        Object<Transformation>* parent = &scene;
+        std::vector<std::reference_wrapper<Object<Transformation>>> objects;
+        for(std::size_t i = 0; i != 1024; ++i) {
+            parent = translatedObject(parent);
+            objects.push_back(*parent);
+        }
+        return objects;
+    }
+
+    /* Tree with eight children on each of four levels, 4096 leaves */
+    template<class Transformation> void mixedHierarchy(Object<Transformation>* parent, UnsignedInt depth, std::vector<std::reference_wrapper<Object<Transformation>>>& leaves) {
+        for(std::size_t i = 0; i != 8; ++i) {
+            Object<Transformation>* object = translatedObject(parent);
+            if(depth == 1) leaves.push_back(*object);
+            else mixedHierarchy(object, depth - 1, leaves);
+        }
+    }
+
+    template<UnsignedInt dimensions> class NoOpDrawable: public Drawable<dimensions, Float> {
+        public:
+            explicit NoOpDrawable(AbstractObject<dimensions, Float>& object, DrawableGroup<dimensions, Float>* drawables): Drawable<dimensions, Float>{object, drawables} {}
+
+        private:
+            void draw(const MatrixTypeFor<dimensions, Float>&, Camera<dimensions, Float>&) override {}
+    };
+
+    template<UnsignedInt dimensions> class NoOpAnimable: public Animable<dimensions, Float> {
+        public:
+            explicit NoOpAnimable(AbstractObject<dimensions, Float>& object, AnimableGroup<dimensions, Float>* animables): Animable<dimensions, Float>{object, animables} {}
+
+        private:
+            void animationStep(Float, Float) override {}
+    };
+}
+
+SceneGraphBenchmark::SceneGraphBenchmark() {
+    addTransformationBenchmarks<DualComplexTransformation>();
+    addTransformationBenchmarks<DualQuaternionTransformation>();
+    addTransformationBenchmarks<MatrixTransformation2D>();
+    addTransformationBenchmarks<MatrixTransformation3D>();
+    addTransformationBenchmarks<RigidMatrixTransformation2D>();
+    addTransformationBenchmarks<RigidMatrixTransformation3D>();
+    addTransformationBenchmarks<TranslationTransformation2D>();
+    addTransformationBenchmarks<TranslationTransformation3D>();
+
+    addBenchmarks<SceneGraphBenchmark>({&SceneGraphBenchmark::animableGroupStep<MatrixTransformation2D>,
+                                        &SceneGraphBenchmark::animableGroupStep<MatrixTransformation3D>,
+                                        &SceneGraphBenchmark::featureGroupChurn<MatrixTransformation2D>,
+                                        &SceneGraphBenchmark::featureGroupChurn<MatrixTransformation3D>}, 5);
+}
+
+template<class Transformation> void SceneGraphBenchmark::addTransformationBenchmarks() {
+    addBenchmarks<SceneGraphBenchmark>({&SceneGraphBenchmark::transformationsWide<Transformation>,
+                                        &SceneGraphBenchmark::transformationsDeep<Transformation>,
+                                        &SceneGraphBenchmark::transformationsMixed<Transformation>,
+                                        &SceneGraphBenchmark::setDirtyDeep<Transformation>,
+                                        &SceneGraphBenchmark::cameraDraw<Transformation>}, 5);
+}
+
+template<class Transformation> void SceneGraphBenchmark::transformationsWide() {
+    setTestCaseName(caseName<Transformation>("transformationsWide"));
+
+    Scene<Transformation> scene;
+    const std::vector<std::reference_wrapper<Object<Transformation>>> objects = wideHierarchy(scene);
+
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(10)
+        count += scene.transformations(objects).size();
+
+    CORRADE_VERIFY(count);
+}
+
+template<class Transformation> void SceneGraphBenchmark::transformationsDeep() {
+    setTestCaseName(caseName<Transformation>("transformationsDeep"));
+
+    Scene<Transformation> scene;
+    const std::vector<std::reference_wrapper<Object<Transformation>>> objects = deepHierarchy(scene);
+
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(10)
+        count += scene.transformations(objects).size();
+
+    CORRADE_VERIFY(count);
+}
+
+template<class Transformation> void SceneGraphBenchmark::transformationsMixed() {
+    setTestCaseName(caseName<Transformation>("transformationsMixed"));
+
+    Scene<Transformation> scene;
+    std::vector<std::reference_wrapper<Object<Transformation>>> leaves;
+    mixedHierarchy<Transformation>(&scene, 4, leaves);
+
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(10)
+        count += scene.transformations(leaves).size();
+
+    CORRADE_VERIFY(count);
+}
+
+template<class Transformation> void SceneGraphBenchmark::setDirtyDeep() {
+    setTestCaseName(caseName<Transformation>("setDirtyDeep"));
+
+    Scene<Transformation> scene;
+    const std::vector<std::reference_wrapper<Object<Transformation>>> objects = deepHierarchy(scene);
+    Object<Transformation>& root = objects.front();
+    Object<Transformation>& leaf = objects.back();
+
+    /* The whole chain needs to be cleaned again for the dirty flag to be
+       propagated, the cleaning is done from the leaf so it walks the same
+       objects */
+    CORRADE_BENCHMARK(10) {
+        leaf.setClean();
+        root.setDirty();
+    }
+
+    CORRADE_VERIFY(leaf.isDirty());
+}
+
+template<class Transformation> void SceneGraphBenchmark::cameraDraw() {
+    setTestCaseName(caseName<Transformation>("cameraDraw"));
+
+    constexpr UnsignedInt Dimensions = Transformation::Dimensions;
+    Scene<Transformation> scene;
+    DrawableGroup<Dimensions, Float> drawables;
+    for(Object<Transformation>& object: wideHierarchy(scene))
+        new NoOpDrawable<Dimensions>{object, &drawables};
+    Camera<Dimensions, Float> camera{*translatedObject<Transformation>(&scene)};
+
+    CORRADE_BENCHMARK(10)
+        camera.draw(drawables);
+
+    CORRADE_COMPARE(drawables.size(), 4096);
+}
+
+template<class Transformation> void SceneGraphBenchmark::animableGroupStep() {
+    setTestCaseName(caseName<Transformation>("animableGroupStep"));
+
+    /* Every third animable running, paused and stopped */
+    constexpr UnsignedInt Dimensions = Transformation::Dimensions;
+    Scene<Transformation> scene;
+    AnimableGroup<Dimensions, Float> animables;
+    std::size_t i = 0;
+    for(Object<Transformation>& object: wideHierarchy(scene))
+        (new NoOpAnimable<Dimensions>{object, &animables})->setState(
+            i++ % 3 == 0 ? AnimationState::Running :
+            i % 3 == 2 ? AnimationState::Paused : AnimationState::Stopped);
+
+    Float time = 0.0f;
+    CORRADE_BENCHMARK(10) {
+        animables.step(time, 1.0f/60.0f);
+        time += 1.0f/60.0f;
+    }
+
+    CORRADE_COMPARE(animables.size(), 4096);
+}
+
+template<class Transformation> void SceneGraphBenchmark::featureGroupChurn() {
+    setTestCaseName(caseName<Transformation>("featureGroupChurn"));
+
+    /* Removing and adding back every other drawable of 1024 */
+    constexpr UnsignedInt Dimensions = Transformation::Dimensions;
+    Scene<Transformation> scene;
+    DrawableGroup<Dimensions, Float> drawables;
+    std::vector<NoOpDrawable<Dimensions>*> features;
+    for(std::size_t i = 0; i != 1024; ++i)
+        features.push_back(new NoOpDrawable<Dimensions>{*translatedObject(&scene), &drawables});
+
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i < features.size(); i += 2)
+            drawables.remove(*features[i]);
+        for(std::size_t i = 0; i < features.size(); i += 2)
+            drawables.add(*features[i]);
+    }
+
+    CORRADE_COMPARE(drawables.size(), 1024);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::SceneGraphBenchmark)
@@ -0,0 +1,181 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/SceneGraph/ShadowMapCache.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+struct ShadowMapCacheGLTest: OpenGLTester {
+    explicit ShadowMapCacheGLTest();
+
+    void construct();
+
+    void draw();
+    void cameraChanged();
+    void invalidate();
+};
+
+ShadowMapCacheGLTest::ShadowMapCacheGLTest() {
+    addTests({&ShadowMapCacheGLTest::construct,
+
+              &ShadowMapCacheGLTest::draw,
+              &ShadowMapCacheGLTest::cameraChanged,
+              &ShadowMapCacheGLTest::invalidate});
+}
+
+namespace {
+    struct CountingDrawable: Drawable3D {
+        explicit CountingDrawable(Object3D& object, DrawableGroup3D& group): Drawable3D{object, &group} {}
+
+        void draw(const Matrix4&, Camera3D&) override { ++count; }
+
+        Int count{};
+    };
+
+    struct Setup {
+        explicit Setup(): cameraObject{&scene}, camera{cameraObject}, object{&scene}, staticDrawable{object, staticCasters}, dynamicDrawable{object, dynamicCasters} {
+            camera.setProjectionMatrix(Matrix4::orthographicProjection({10.0f, 10.0f}, 0.1f, 100.0f));
+            Renderer::enable(Renderer::Feature::DepthTest);
+        }
+
+        ~Setup() {
+            Renderer::disable(Renderer::Feature::DepthTest);
+        }
+
+        Scene3D scene;
+        Object3D cameraObject;
+        Camera3D camera;
+        Object3D object;
+        DrawableGroup3D staticCasters, dynamicCasters;
+        CountingDrawable staticDrawable, dynamicDrawable;
+    };
+}
+
+void ShadowMapCacheGLTest::construct() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::texture_array>())
+        CORRADE_SKIP(Extensions::GL::EXT::texture_array::string() + std::string(" is not supported."));
+    #endif
+
+    ShadowMapCache cache{{64, 32}, 3};
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(cache.size(), (Vector2i{64, 32}));
+    CORRADE_COMPARE(cache.layerCount(), 3);
+    CORRADE_VERIFY(cache.texture().id());
+    CORRADE_VERIFY(cache.cacheTexture().id());
+    CORRADE_VERIFY(!cache.isCached(0));
+    CORRADE_VERIFY(!cache.isCached(2));
+    CORRADE_COMPARE(cache.staticDrawCount(), 0);
+}
+
+void ShadowMapCacheGLTest::draw() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::texture_array>())
+        CORRADE_SKIP(Extensions::GL::EXT::texture_array::string() + std::string(" is not supported."));
+    #endif
+
+    Setup s;
+    ShadowMapCache cache{Vector2i{32}, 2};
+
+    CORRADE_VERIFY(cache.draw(1, s.camera, s.staticCasters, s.dynamicCasters));
+    CORRADE_VERIFY(!cache.draw(1, s.camera, s.staticCasters, s.dynamicCasters));
+    CORRADE_VERIFY(!cache.draw(1, s.camera, s.staticCasters, s.dynamicCasters));
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(!cache.isCached(0));
+    CORRADE_VERIFY(cache.isCached(1));
+    CORRADE_COMPARE(cache.staticDrawCount(), 1);
+    CORRADE_COMPARE(s.staticDrawable.count, 1);
+    CORRADE_COMPARE(s.dynamicDrawable.count, 3);
+}
+
+void ShadowMapCacheGLTest::cameraChanged() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::texture_array>())
+        CORRADE_SKIP(Extensions::GL::EXT::texture_array::string() + std::string(" is not supported."));
+    #endif
+
+    Setup s;
+    ShadowMapCache cache{Vector2i{32}, 1};
+
+    CORRADE_VERIFY(cache.draw(0, s.camera, s.staticCasters, s.dynamicCasters));
+
+    /* Moving the light redraws the static casters */
+    s.cameraObject.translate(Vector3::xAxis(1.0f));
+    CORRADE_VERIFY(cache.draw(0, s.camera, s.staticCasters, s.dynamicCasters));
+    CORRADE_VERIFY(!cache.draw(0, s.camera, s.staticCasters, s.dynamicCasters));
+
+    /* So does changing the projection */
+    s.camera.setProjectionMatrix(Matrix4::orthographicProjection({20.0f, 20.0f}, 0.1f, 100.0f));
+    CORRADE_VERIFY(cache.draw(0, s.camera, s.staticCasters, s.dynamicCasters));
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(s.staticDrawable.count, 3);
+    CORRADE_COMPARE(s.dynamicDrawable.count, 4);
+}
+
+void ShadowMapCacheGLTest::invalidate() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::texture_array>())
+        CORRADE_SKIP(Extensions::GL::EXT::texture_array::string() + std::string(" is not supported."));
+    #endif
+
+    Setup s;
+    ShadowMapCache cache{Vector2i{32}, 2};
+
+    cache.draw(0, s.camera, s.staticCasters, s.dynamicCasters);
+    cache.draw(1, s.camera, s.staticCasters, s.dynamicCasters);
+    CORRADE_VERIFY(cache.isCached(0));
+    CORRADE_VERIFY(cache.isCached(1));
+
+    cache.invalidate(1);
+    CORRADE_VERIFY(cache.isCached(0));
+    CORRADE_VERIFY(!cache.isCached(1));
+    CORRADE_VERIFY(!cache.draw(0, s.camera, s.staticCasters, s.dynamicCasters));
+    CORRADE_VERIFY(cache.draw(1, s.camera, s.staticCasters, s.dynamicCasters));
+
+    cache.invalidate();
+    CORRADE_VERIFY(!cache.isCached(0));
+    CORRADE_VERIFY(!cache.isCached(1));
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(cache.staticDrawCount(), 3);
+    CORRADE_COMPARE(s.staticDrawable.count, 3);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::ShadowMapCacheGLTest)
@@ -0,0 +1,147 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/SceneGraph/Skeleton.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct SkeletonTest: TestSuite::Tester {
+    explicit SkeletonTest();
+
+    void construct();
+    void restPose();
+    void tracks();
+    void hierarchy();
+    void inverseBind();
+    void removeTrack();
+};
+
+SkeletonTest::SkeletonTest() {
+    addTests({&SkeletonTest::construct,
+              &SkeletonTest::restPose,
+              &SkeletonTest::tracks,
+              &SkeletonTest::hierarchy,
+              &SkeletonTest::inverseBind,
+              &SkeletonTest::removeTrack});
+}
+
+void SkeletonTest::construct() {
+    Skeleton skeleton{{-1, 0, 1}, {Matrix4{}, Matrix4{}, Matrix4{}}};
+    CORRADE_COMPARE(skeleton.jointCount(), 3);
+    CORRADE_COMPARE(skeleton.hintCount(), 0);
+    CORRADE_COMPARE(skeleton.duration(), 0.0f);
+
+    Matrix4 matrices[3];
+    skeleton.jointMatrices(0.0f, nullptr, matrices);
+    CORRADE_COMPARE(matrices[0], Matrix4{});
+    CORRADE_COMPARE(matrices[1], Matrix4{});
+    CORRADE_COMPARE(matrices[2], Matrix4{});
+}
+
+void SkeletonTest::restPose() {
+    Skeleton skeleton{{-1}, {Matrix4{}}};
+    skeleton.setRestPose(0, Vector3::xAxis(2.0f), Quaternion::rotation(Deg(90.0f), Vector3::zAxis()), Vector3{3.0f});
+
+    Matrix4 matrices[1];
+    skeleton.jointMatrices(0.0f, nullptr, matrices);
+    CORRADE_COMPARE(matrices[0],
+        Matrix4::translation(Vector3::xAxis(2.0f))*
+        Matrix4::rotationZ(Deg(90.0f))*
+        Matrix4::scaling(Vector3{3.0f}));
+}
+
+void SkeletonTest::tracks() {
+    KeyframeTrack3D translation{{0.0f, 2.0f}, {Vector3{}, Vector3::yAxis(4.0f)}};
+    KeyframeTrackQuaternion rotation{{0.0f, 1.0f}, {
+        Quaternion{}, Quaternion::rotation(Deg(90.0f), Vector3::zAxis())}};
+
+    Skeleton skeleton{{-1, -1}, {Matrix4{}, Matrix4{}}};
+    skeleton.setRestPose(1, {}, {}, Vector3{2.0f})
+        .setTracks(0, &translation, nullptr, nullptr)
+        .setTracks(1, nullptr, &rotation, nullptr);
+    CORRADE_COMPARE(skeleton.hintCount(), 2);
+    CORRADE_COMPARE(skeleton.duration(), 2.0f);
+
+    std::size_t hints[2]{};
+    Matrix4 matrices[2];
+    skeleton.jointMatrices(0.5f, hints, matrices);
+    CORRADE_COMPARE(matrices[0], Matrix4::translation(Vector3::yAxis(1.0f)));
+    CORRADE_COMPARE(matrices[1],
+        Matrix4::rotationZ(Deg(45.0f))*
+        Matrix4::scaling(Vector3{2.0f}));
+}
+
+void SkeletonTest::hierarchy() {
+    KeyframeTrackQuaternion rotation{{0.0f, 1.0f}, {
+        Quaternion{}, Quaternion::rotation(Deg(90.0f), Vector3::zAxis())}};
+
+    Skeleton skeleton{{-1, 0, 1}, {Matrix4{}, Matrix4{}, Matrix4{}}};
+    skeleton.setRestPose(1, Vector3::xAxis(1.0f), {}, Vector3{1.0f})
+        .setRestPose(2, Vector3::xAxis(1.0f), {}, Vector3{1.0f})
+        .setTracks(0, nullptr, &rotation, nullptr);
+
+    std::size_t hints[1]{};
+    Matrix4 matrices[3];
+    skeleton.jointMatrices(1.0f, hints, matrices);
+    CORRADE_COMPARE(matrices[0], Matrix4::rotationZ(Deg(90.0f)));
+    CORRADE_COMPARE(matrices[1].translation(), Vector3::yAxis(1.0f));
+    CORRADE_COMPARE(matrices[2].translation(), Vector3::yAxis(2.0f));
+}
+
+void SkeletonTest::inverseBind() {
+    /* Joint in its bind pose gives identity */
+    const Matrix4 bind = Matrix4::translation(Vector3::zAxis(3.0f));
+    Skeleton skeleton{{-1}, {bind.inverted()}};
+    skeleton.setRestPose(0, Vector3::zAxis(3.0f), {}, Vector3{1.0f});
+
+    Matrix4 matrices[1];
+    skeleton.jointMatrices(0.0f, nullptr, matrices);
+    CORRADE_COMPARE(matrices[0], Matrix4{});
+}
+
+void SkeletonTest::removeTrack() {
+    KeyframeTrack3D translation{{0.0f, 1.0f}, {Vector3{}, Vector3::yAxis(4.0f)}};
+    KeyframeTrack3D scaling{{0.0f, 1.0f}, {Vector3{1.0f}, Vector3{2.0f}}};
+
+    Skeleton skeleton{{-1, -1}, {Matrix4{}, Matrix4{}}};
+    skeleton.setTracks(1, &translation, nullptr, &scaling)
+        .setTracks(0, &translation, nullptr, nullptr);
+    CORRADE_COMPARE(skeleton.hintCount(), 3);
+
+    skeleton.setTracks(1, nullptr, nullptr, &scaling);
+    CORRADE_COMPARE(skeleton.hintCount(), 2);
+
+    std::size_t hints[2]{};
+    Matrix4 matrices[2];
+    skeleton.jointMatrices(1.0f, hints, matrices);
+    CORRADE_COMPARE(matrices[0], Matrix4::translation(Vector3::yAxis(4.0f)));
+    CORRADE_COMPARE(matrices[1], Matrix4::scaling(Vector3{2.0f}));
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::SkeletonTest)
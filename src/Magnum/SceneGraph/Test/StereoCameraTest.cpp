@@ -0,0 +1,191 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/SceneGraph/StereoCamera.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct StereoCameraTest: TestSuite::Tester {
+    explicit StereoCameraTest();
+
+    void defaultProjection();
+    void viewProjectionMatrix();
+    void combinedFrustum();
+    void combinedFrustumInfinite();
+    void drawCulled();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+StereoCameraTest::StereoCameraTest() {
+    addTests({&StereoCameraTest::defaultProjection,
+              &StereoCameraTest::viewProjectionMatrix,
+              &StereoCameraTest::combinedFrustum,
+              &StereoCameraTest::combinedFrustumInfinite,
+              &StereoCameraTest::drawCulled});
+}
+
+void StereoCameraTest::defaultProjection() {
+    Object3D o;
+    StereoCamera3D camera(o);
+    CORRADE_COMPARE(camera.projectionMatrix(), Matrix4());
+    CORRADE_COMPARE(camera.viewProjectionMatrix(StereoCamera3D::Eye::Left), Matrix4());
+    CORRADE_COMPARE(camera.viewProjectionMatrix(StereoCamera3D::Eye::Right), Matrix4());
+}
+
+void StereoCameraTest::viewProjectionMatrix() {
+    Object3D o;
+    StereoCamera3D camera(o);
+
+    const Matrix4 projection = Matrix4::perspectiveProjection(Deg(90.0f), 1.0f, 0.1f, 100.0f);
+    camera.setEyes(0.064f, projection);
+
+    CORRADE_COMPARE(camera.eyeProjectionMatrix(StereoCamera3D::Eye::Left), projection);
+    CORRADE_COMPARE(camera.eyeTransformationMatrix(StereoCamera3D::Eye::Left), Matrix4::translation(Vector3::xAxis(-0.032f)));
+    CORRADE_COMPARE(camera.eyeTransformationMatrix(StereoCamera3D::Eye::Right), Matrix4::translation(Vector3::xAxis(0.032f)));
+    CORRADE_COMPARE(camera.viewProjectionMatrix(StereoCamera3D::Eye::Left), projection*Matrix4::translation(Vector3::xAxis(0.032f)));
+    CORRADE_COMPARE(camera.viewProjectionMatrix(StereoCamera3D::Eye::Right), projection*Matrix4::translation(Vector3::xAxis(-0.032f)));
+}
+
+namespace {
+
+/* Corners of the frustum given by a view projection matrix */
+std::vector<Vector3> frustumCorners(const Matrix4& viewProjection) {
+    const Matrix4 inverted = viewProjection.inverted();
+    std::vector<Vector3> corners;
+    for(Float z: {-1.0f, 1.0f})
+        for(Float y: {-1.0f, 1.0f})
+            for(Float x: {-1.0f, 1.0f})
+                corners.push_back(inverted.transformPoint({x, y, z}));
+    return corners;
+}
+
+bool inside(const Matrix4& viewProjection, const Vector3& point) {
+    const Vector4 clip = viewProjection*Vector4{point, 1.0f};
+    /* Small tolerance for points lying on the planes */
+    const Float w = clip.w()*1.0001f;
+    return clip.x() >= -w && clip.x() <= w &&
+           clip.y() >= -w && clip.y() <= w &&
+           clip.z() >= -w && clip.z() <= w;
+}
+
+}
+
+void StereoCameraTest::combinedFrustum() {
+    Object3D o;
+    StereoCamera3D camera(o);
+
+    /* Asymmetric projections as usual for HMDs, with the eyes at different
+       heights and a different near/far plane */
+    const Matrix4 left{
+        {1.2f, 0.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f, 0.0f},
+        {0.15f, -0.05f, -1.002f, -1.0f},
+        {0.0f, 0.0f, -0.2002f, 0.0f}};
+    const Matrix4 right = Matrix4::perspectiveProjection({0.18f, 0.2f}, 0.1f, 50.0f);
+    camera.setEye(StereoCamera3D::Eye::Left, left, Matrix4::translation({-0.03f, 0.01f, 0.0f}))
+          .setEye(StereoCamera3D::Eye::Right, right, Matrix4::translation({0.035f, 0.0f, 0.0f}));
+
+    /* The combined frustum contains both eye frusta */
+    for(StereoCamera3D::Eye eye: {StereoCamera3D::Eye::Left, StereoCamera3D::Eye::Right}) {
+        for(const Vector3& corner: frustumCorners(camera.viewProjectionMatrix(eye))) {
+            CORRADE_VERIFY(inside(camera.projectionMatrix(), corner));
+        }
+    }
+
+    /* ... but is not excessively large */
+    CORRADE_VERIFY(!inside(camera.projectionMatrix(), {0.0f, 0.0f, -0.05f}));
+    CORRADE_VERIFY(!inside(camera.projectionMatrix(), {0.0f, 0.0f, -150.0f}));
+    CORRADE_VERIFY(!inside(camera.projectionMatrix(), {60.0f, 0.0f, -50.0f}));
+}
+
+void StereoCameraTest::combinedFrustumInfinite() {
+    Object3D o;
+    StereoCamera3D camera(o);
+    camera.setEyes(0.064f, Matrix4::perspectiveProjection(Deg(90.0f), 1.0f, 0.1f, Constants::inf()));
+
+    const Matrix4 projection = camera.projectionMatrix();
+    CORRADE_COMPARE(projection[2][2], -1.0f);
+    CORRADE_VERIFY(inside(projection, {0.0f, 0.0f, -1000000.0f}));
+    CORRADE_VERIFY(inside(projection, {-0.132f, 0.0f, -0.1f}));
+    CORRADE_VERIFY(inside(projection, {0.132f, 0.0f, -0.1f}));
+    CORRADE_VERIFY(!inside(projection, {0.0f, 0.0f, -0.09f}));
+}
+
+void StereoCameraTest::drawCulled() {
+    class Drawable: public SceneGraph::Drawable3D {
+        public:
+            Drawable(AbstractObject3D& object, DrawableGroup3D* group, Int& drawn): SceneGraph::Drawable3D(object, group), drawn(drawn) {}
+
+        protected:
+            void draw(const Matrix4&, Camera3D&) override {
+                ++drawn;
+            }
+
+        private:
+            Int& drawn;
+    };
+
+    DrawableGroup3D group;
+    Scene3D scene;
+    Int drawn = 0;
+
+    /* Wide eye separation to make the difference between the eyes large
+       enough */
+    Object3D cameraObject(&scene);
+    StereoCamera3D camera(cameraObject);
+    camera.setEyes(4.0f, Matrix4::perspectiveProjection(Deg(60.0f), 1.0f, 0.1f, 100.0f));
+
+    /* Visible only to the left eye */
+    Object3D left(&scene);
+    left.translate({-2.5f, 0.0f, -2.0f});
+    (new Drawable(left, &group, drawn))->setBoundingBox({Vector3{-0.25f}, Vector3{0.25f}});
+    CORRADE_VERIFY(!inside(camera.viewProjectionMatrix(StereoCamera3D::Eye::Right), left.transformation().translation()));
+
+    /* Visible only to the right eye */
+    Object3D right(&scene);
+    right.translate({2.5f, 0.0f, -2.0f});
+    (new Drawable(right, &group, drawn))->setBoundingBox({Vector3{-0.25f}, Vector3{0.25f}});
+    CORRADE_VERIFY(!inside(camera.viewProjectionMatrix(StereoCamera3D::Eye::Left), right.transformation().translation()));
+
+    /* Outside of both */
+    Object3D outside(&scene);
+    outside.translate({0.0f, 10.0f, -2.0f});
+    (new Drawable(outside, &group, drawn))->setBoundingBox({Vector3{-0.25f}, Vector3{0.25f}});
+
+    CORRADE_COMPARE(camera.drawCulled(group), 1);
+    CORRADE_COMPARE(drawn, 2);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::StereoCameraTest)
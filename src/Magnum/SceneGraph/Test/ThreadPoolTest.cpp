@@ -0,0 +1,97 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <atomic>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/SceneGraph/ThreadPool.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct ThreadPoolTest: TestSuite::Tester {
+    explicit ThreadPoolTest();
+
+    void construct();
+    void constructNoThreads();
+    void run();
+    void runNoJobs();
+    void runRepeated();
+};
+
+ThreadPoolTest::ThreadPoolTest() {
+    addTests({&ThreadPoolTest::construct,
+              &ThreadPoolTest::constructNoThreads,
+              &ThreadPoolTest::run,
+              &ThreadPoolTest::runNoJobs,
+              &ThreadPoolTest::runRepeated});
+}
+
+void ThreadPoolTest::construct() {
+    ThreadPool pool{3};
+    CORRADE_COMPARE(pool.threadCount(), 3);
+    CORRADE_COMPARE(pool.workerCount(), 4);
+}
+
+void ThreadPoolTest::constructNoThreads() {
+    ThreadPool pool{0};
+    CORRADE_COMPARE(pool.threadCount(), 0);
+    CORRADE_COMPARE(pool.workerCount(), 1);
+
+    std::vector<Int> result(5);
+    pool.run(result.size(), [&](std::size_t i) { result[i] = i*i; });
+    CORRADE_COMPARE(result, (std::vector<Int>{0, 1, 4, 9, 16}));
+}
+
+void ThreadPoolTest::run() {
+    ThreadPool pool{3};
+
+    /* Each job executed exactly once */
+    std::vector<Int> result(1000);
+    pool.run(result.size(), [&](std::size_t i) { result[i] += i; });
+    for(std::size_t i = 0; i != result.size(); ++i)
+        CORRADE_COMPARE(result[i], Int(i));
+}
+
+void ThreadPoolTest::runNoJobs() {
+    ThreadPool pool{2};
+
+    bool called = false;
+    pool.run(0, [&](std::size_t) { called = true; });
+    CORRADE_VERIFY(!called);
+}
+
+void ThreadPoolTest::runRepeated() {
+    ThreadPool pool{3};
+
+    std::atomic<Int> sum{0};
+    for(Int i = 0; i != 100; ++i)
+        pool.run(10, [&](std::size_t i) { sum += Int(i); });
+    CORRADE_COMPARE(sum.load(), 4500);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::ThreadPoolTest)
@@ -48,6 +48,8 @@ struct TranslationTransformationTest: TestSuite::Tester {
     void transform();
     void translate();
 
+    void transformationMatrices();
+
     void integral();
 };
 
@@ -62,6 +64,8 @@ TranslationTransformationTest::TranslationTransformationTest() {
               &TranslationTransformationTest::transform,
               &TranslationTransformationTest::translate,
 
+              &TranslationTransformationTest::transformationMatrices,
+
               &TranslationTransformationTest::integral});
 }
 
@@ -131,6 +135,29 @@ void TranslationTransformationTest::translate() {
     CORRADE_COMPARE(o.transformationMatrix(), Matrix3::translation({1.0f, -0.3f})*Matrix3::translation({-0.5f, 2.0f}));
 }
 
+void TranslationTransformationTest::transformationMatrices() {
+    Scene2D s;
+    Object2D a{&s};
+    a.translate({1.0f, -0.3f});
+    Object2D b{&a};
+    b.translate({-0.5f, 2.0f});
+
+    /* The camera matrix doesn't need to be a pure translation, as it is
+       applied only to the resulting translations */
+    const Matrix3 camera = Matrix3::rotation(Deg(35.0f))*Matrix3::scaling(Vector2{2.0f});
+    std::vector<Matrix3> matrices = s.transformationMatrices({a, b}, camera);
+    CORRADE_COMPARE(matrices.size(), 2);
+    CORRADE_COMPARE(matrices[0], camera*Matrix3::translation({1.0f, -0.3f}));
+    CORRADE_COMPARE(matrices[1], camera*Matrix3::translation({0.5f, 1.7f}));
+
+    /* Same with the cached flat hierarchy */
+    s.setFlatHierarchyEnabled(true);
+    matrices = s.transformationMatrices({a, b}, camera);
+    CORRADE_COMPARE(matrices.size(), 2);
+    CORRADE_COMPARE(matrices[0], camera*Matrix3::translation({1.0f, -0.3f}));
+    CORRADE_COMPARE(matrices[1], camera*Matrix3::translation({0.5f, 1.7f}));
+}
+
 void TranslationTransformationTest::integral() {
     typedef Object<BasicTranslationTransformation2D<Float, Short>> Object2Di;
 
@@ -0,0 +1,366 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/AbstractResourceLoader.h"
+#include "Magnum/ResourceManager.h"
+#include "Magnum/SceneGraph/MatrixTransformation2D.h"
+#include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/SceneGraph/WorldStreamer.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test {
+
+struct WorldStreamerTest: TestSuite::Tester {
+    explicit WorldStreamerTest();
+
+    void construct();
+    void load();
+    void unloadHysteresis();
+    void prediction();
+    void instantiationBudget();
+    void memoryBudget();
+    void notFound();
+    void cached();
+    void destruct();
+    void outOfRange();
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation2D> Scene2D;
+typedef SceneGraph::WorldStreamer<SceneGraph::MatrixTransformation2D> WorldStreamer2D;
+typedef Magnum::ResourceManager<Int> ResourceManager;
+
+/* Loader finishing the requests only when asked to, like a threaded one */
+class DeferredLoader: public AbstractResourceLoader<Int> {
+    public:
+        void finish() {
+            for(ResourceKey key: pending)
+                set(key, 42, ResourceDataState::Final, ResourcePolicy::Cached, 10);
+            pending.clear();
+        }
+
+        void notFound() {
+            for(ResourceKey key: pending)
+                setNotFound(key);
+            pending.clear();
+        }
+
+        std::vector<ResourceKey> pending;
+
+    private:
+        void doLoad(ResourceKey key) override { pending.push_back(key); }
+};
+
+WorldStreamerTest::WorldStreamerTest() {
+    addTests({&WorldStreamerTest::construct,
+              &WorldStreamerTest::load,
+              &WorldStreamerTest::unloadHysteresis,
+              &WorldStreamerTest::prediction,
+              &WorldStreamerTest::instantiationBudget,
+              &WorldStreamerTest::memoryBudget,
+              &WorldStreamerTest::notFound,
+              &WorldStreamerTest::cached,
+              &WorldStreamerTest::destruct,
+              &WorldStreamerTest::outOfRange});
+}
+
+void WorldStreamerTest::construct() {
+    Scene2D scene;
+    ResourceManager manager;
+    WorldStreamer2D streamer{scene};
+    streamer.setLoadDistance(10.0f)
+        .setUnloadDistance(15.0f)
+        .setPredictionTime(0.5f)
+        .setMemoryBudget(1024);
+
+    CORRADE_COMPARE(streamer.loadDistance(), 10.0f);
+    CORRADE_COMPARE(streamer.unloadDistance(), 15.0f);
+    CORRADE_COMPARE(streamer.predictionTime(), 0.5f);
+    CORRADE_COMPARE(streamer.memoryBudget(), 1024);
+
+    const UnsignedInt cell = streamer.addCell({{0.0f, 0.0f}, {10.0f, 10.0f}}, nullptr);
+    streamer.addAsset<Int>(cell, manager, "a", 100)
+        .addAsset<Int>(cell, manager, "b", 200);
+
+    CORRADE_COMPARE(cell, 0);
+    CORRADE_COMPARE(streamer.cellCount(), 1);
+    CORRADE_COMPARE(streamer.cellBounds(0), (Range2D{{0.0f, 0.0f}, {10.0f, 10.0f}}));
+    CORRADE_COMPARE(streamer.cellAssetCount(0), 2);
+    CORRADE_VERIFY(streamer.cellState(0) == StreamedCellState::Unloaded);
+    CORRADE_VERIFY(!streamer.cellObject(0));
+    CORRADE_COMPARE(streamer.residentSize(), 0);
+
+    /* Nothing is requested before update() */
+    CORRADE_COMPARE(manager.count<Int>(), 0);
+}
+
+void WorldStreamerTest::load() {
+    Scene2D scene;
+    ResourceManager manager;
+    DeferredLoader* loader = new DeferredLoader;
+    manager.setLoader(loader);
+
+    std::vector<UnsignedInt> instantiated;
+    WorldStreamer2D streamer{scene};
+    streamer.setLoadDistance(5.0f)
+        .setUnloadDistance(10.0f);
+    auto instantiator = [&](Object2D& root, UnsignedInt cell) {
+        CORRADE_VERIFY(root.parent() == &scene);
+        new Object2D{&root};
+        instantiated.push_back(cell);
+    };
+    streamer.addAsset<Int>(streamer.addCell({{0.0f, 0.0f}, {10.0f, 10.0f}}, instantiator), manager, "a");
+    streamer.addAsset<Int>(streamer.addCell({{12.0f, 0.0f}, {22.0f, 10.0f}}, instantiator), manager, "b");
+    streamer.addAsset<Int>(streamer.addCell({{100.0f, 0.0f}, {110.0f, 10.0f}}, instantiator), manager, "c");
+
+    /* The first two cells are in load distance, the assets are requested */
+    streamer.update({9.0f, 5.0f});
+    CORRADE_VERIFY(streamer.cellState(0) == StreamedCellState::Loading);
+    CORRADE_VERIFY(streamer.cellState(1) == StreamedCellState::Loading);
+    CORRADE_VERIFY(streamer.cellState(2) == StreamedCellState::Unloaded);
+    CORRADE_COMPARE(loader->pending.size(), 2);
+    CORRADE_VERIFY(instantiated.empty());
+
+    /* Not instantiated until the loader finishes */
+    streamer.update({9.0f, 5.0f});
+    CORRADE_COMPARE(streamer.cellCount(StreamedCellState::Loading), 2);
+
+    /* The cells are instantiated nearest first */
+    loader->finish();
+    streamer.update({11.5f, 5.0f});
+    CORRADE_VERIFY(streamer.cellState(0) == StreamedCellState::Active);
+    CORRADE_VERIFY(streamer.cellState(1) == StreamedCellState::Active);
+    CORRADE_COMPARE(instantiated, (std::vector<UnsignedInt>{1, 0}));
+    CORRADE_VERIFY(streamer.cellObject(0));
+    CORRADE_VERIFY(streamer.cellObject(0)->parent() == &scene);
+    CORRADE_VERIFY(streamer.cellObject(0)->children().first());
+    CORRADE_VERIFY(streamer.cellObject(0)->children().first() == streamer.cellObject(0)->children().last());
+}
+
+void WorldStreamerTest::unloadHysteresis() {
+    Scene2D scene;
+    ResourceManager manager;
+    DeferredLoader* loader = new DeferredLoader;
+    manager.setLoader(loader);
+
+    WorldStreamer2D streamer{scene};
+    streamer.setLoadDistance(5.0f)
+        .setUnloadDistance(10.0f);
+    streamer.addAsset<Int>(streamer.addCell({{0.0f, 0.0f}, {10.0f, 10.0f}}, nullptr), manager, "a");
+
+    streamer.update({14.0f, 5.0f});
+    loader->finish();
+    streamer.update({14.0f, 5.0f});
+    CORRADE_VERIFY(streamer.cellState(0) == StreamedCellState::Active);
+
+    /* Outside of load distance, but still in unload distance */
+    streamer.update({18.0f, 5.0f});
+    CORRADE_VERIFY(streamer.cellState(0) == StreamedCellState::Active);
+
+    /* Outside of unload distance, the whole hierarchy is deleted */
+    streamer.update({21.0f, 5.0f});
+    CORRADE_VERIFY(streamer.cellState(0) == StreamedCellState::Unloaded);
+    CORRADE_VERIFY(!streamer.cellObject(0));
+    CORRADE_VERIFY(scene.children().isEmpty());
+
+    /* Not requested again until in load distance */
+    streamer.update({18.0f, 5.0f});
+    CORRADE_VERIFY(streamer.cellState(0) == StreamedCellState::Unloaded);
+}
+
+void WorldStreamerTest::prediction() {
+    Scene2D scene;
+    ResourceManager manager;
+    DeferredLoader* loader = new DeferredLoader;
+    manager.setLoader(loader);
+
+    WorldStreamer2D streamer{scene};
+    streamer.setLoadDistance(5.0f)
+        .setUnloadDistance(10.0f)
+        .setPredictionTime(2.0f);
+    streamer.addAsset<Int>(streamer.addCell({{0.0f, 0.0f}, {10.0f, 10.0f}}, nullptr), manager, "a");
+    streamer.addAsset<Int>(streamer.addCell({{40.0f, 0.0f}, {50.0f, 10.0f}}, nullptr), manager, "b");
+
+    /* Moving towards the second cell, which is requested in advance */
+    streamer.update({25.0f, 5.0f}, {6.0f, 0.0f});
+    CORRADE_VERIFY(streamer.cellState(0) == StreamedCellState::Unloaded);
+    CORRADE_VERIFY(streamer.cellState(1) == StreamedCellState::Loading);
+
+    /* Without velocity neither is in range */
+    streamer.unload(1);
+    streamer.update({25.0f, 5.0f});
+    CORRADE_COMPARE(streamer.cellCount(StreamedCellState::Unloaded), 2);
+}
+
+void WorldStreamerTest::instantiationBudget() {
+    Scene2D scene;
+    ResourceManager manager;
+    DeferredLoader* loader = new DeferredLoader;
+    manager.setLoader(loader);
+
+    WorldStreamer2D streamer{scene};
+    streamer.setLoadDistance(50.0f)
+        .setUnloadDistance(60.0f);
+    for(Int i = 0; i != 3; ++i)
+        streamer.addAsset<Int>(streamer.addCell({{i*10.0f, 0.0f}, {i*10.0f + 10.0f, 10.0f}}, nullptr), manager, std::to_string(i));
+
+    streamer.update({25.0f, 5.0f}, {}, 1);
+    loader->finish();
+
+    streamer.update({25.0f, 5.0f}, {}, 1);
+    CORRADE_VERIFY(streamer.cellState(2) == StreamedCellState::Active);
+    CORRADE_COMPARE(streamer.cellCount(StreamedCellState::Loaded), 2);
+
+    streamer.update({25.0f, 5.0f}, {}, 1);
+    CORRADE_VERIFY(streamer.cellState(1) == StreamedCellState::Active);
+    CORRADE_VERIFY(streamer.cellState(0) == StreamedCellState::Loaded);
+
+    streamer.update({25.0f, 5.0f}, {}, 1);
+    CORRADE_COMPARE(streamer.cellCount(StreamedCellState::Active), 3);
+}
+
+void WorldStreamerTest::memoryBudget() {
+    Scene2D scene;
+    ResourceManager manager;
+    DeferredLoader* loader = new DeferredLoader;
+    manager.setLoader(loader);
+
+    WorldStreamer2D streamer{scene};
+    streamer.setLoadDistance(50.0f)
+        .setUnloadDistance(60.0f)
+        .setMemoryBudget(250);
+    for(Int i = 0; i != 3; ++i)
+        streamer.addAsset<Int>(streamer.addCell({{i*10.0f, 0.0f}, {i*10.0f + 10.0f, 10.0f}}, nullptr), manager, std::to_string(i), 100);
+
+    /* Only the two nearest fit */
+    streamer.update({5.0f, 5.0f});
+    CORRADE_VERIFY(streamer.cellState(0) == StreamedCellState::Loading);
+    CORRADE_VERIFY(streamer.cellState(1) == StreamedCellState::Loading);
+    CORRADE_VERIFY(streamer.cellState(2) == StreamedCellState::Unloaded);
+    CORRADE_COMPARE(streamer.residentSize(), 200);
+
+    /* Moving to the other side evicts the farthest cell to make room */
+    loader->finish();
+    streamer.update({25.0f, 5.0f});
+    CORRADE_VERIFY(streamer.cellState(0) == StreamedCellState::Unloaded);
+    CORRADE_VERIFY(streamer.cellState(1) == StreamedCellState::Active);
+    CORRADE_VERIFY(streamer.cellState(2) == StreamedCellState::Loading);
+    CORRADE_COMPARE(streamer.residentSize(), 200);
+
+    /* A cell that is larger than the budget is never requested */
+    streamer.addAsset<Int>(streamer.addCell({{0.0f, 20.0f}, {10.0f, 30.0f}}, nullptr), manager, "big", 300);
+    streamer.update({25.0f, 5.0f});
+    CORRADE_VERIFY(streamer.cellState(3) == StreamedCellState::Unloaded);
+    CORRADE_VERIFY(streamer.cellState(1) == StreamedCellState::Active);
+}
+
+void WorldStreamerTest::notFound() {
+    Scene2D scene;
+    ResourceManager manager;
+    DeferredLoader* loader = new DeferredLoader;
+    manager.setLoader(loader);
+
+    bool found = true;
+    WorldStreamer2D streamer{scene};
+    streamer.setLoadDistance(5.0f);
+    streamer.addAsset<Int>(streamer.addCell({{0.0f, 0.0f}, {10.0f, 10.0f}}, [&](Object2D&, UnsignedInt) {
+        found = manager.state<Int>("a") != ResourceState::NotFound;
+    }), manager, "a");
+
+    streamer.update({5.0f, 5.0f});
+    loader->notFound();
+
+    /* Missing assets don't block the cell */
+    streamer.update({5.0f, 5.0f});
+    CORRADE_VERIFY(streamer.cellState(0) == StreamedCellState::Active);
+    CORRADE_VERIFY(!found);
+}
+
+void WorldStreamerTest::cached() {
+    Scene2D scene;
+    ResourceManager manager;
+    DeferredLoader* loader = new DeferredLoader;
+    manager.setLoader(loader)
+        .setCacheBudget<Int>(100);
+
+    WorldStreamer2D streamer{scene};
+    streamer.setLoadDistance(5.0f)
+        .setUnloadDistance(10.0f);
+    streamer.addAsset<Int>(streamer.addCell({{0.0f, 0.0f}, {10.0f, 10.0f}}, nullptr), manager, "a");
+
+    streamer.update({5.0f, 5.0f});
+    loader->finish();
+    streamer.update({5.0f, 5.0f});
+    CORRADE_COMPARE(loader->loadedCount(), 1);
+
+    /* The unloaded asset stays cached in the manager */
+    streamer.update({50.0f, 5.0f});
+    CORRADE_VERIFY(streamer.cellState(0) == StreamedCellState::Unloaded);
+    CORRADE_COMPARE(manager.cacheSize<Int>(), 10);
+
+    /* Coming back doesn't need the loader */
+    streamer.update({5.0f, 5.0f});
+    CORRADE_VERIFY(streamer.cellState(0) == StreamedCellState::Active);
+    CORRADE_COMPARE(loader->requestedCount(), 1);
+    CORRADE_VERIFY(loader->pending.empty());
+}
+
+void WorldStreamerTest::destruct() {
+    Scene2D scene;
+    ResourceManager manager;
+    {
+        WorldStreamer2D streamer{scene};
+        streamer.setLoadDistance(5.0f);
+        streamer.addCell({{0.0f, 0.0f}, {10.0f, 10.0f}}, nullptr);
+        streamer.update({5.0f, 5.0f});
+        CORRADE_VERIFY(streamer.cellState(0) == StreamedCellState::Active);
+        CORRADE_VERIFY(!scene.children().isEmpty());
+    }
+
+    CORRADE_VERIFY(scene.children().isEmpty());
+}
+
+void WorldStreamerTest::outOfRange() {
+    Scene2D scene;
+    ResourceManager manager;
+    WorldStreamer2D streamer{scene};
+    streamer.setLoadDistance(5.0f);
+    streamer.addCell({{0.0f, 0.0f}, {10.0f, 10.0f}}, nullptr);
+    streamer.update({5.0f, 5.0f});
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    streamer.cellState(1);
+    streamer.addAsset<Int>(0, manager, "a");
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::WorldStreamer::cellState(): cell 1 out of range for 1 cells\n"
+        "SceneGraph::WorldStreamer::addAsset(): cell 0 is not unloaded\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::WorldStreamerTest)
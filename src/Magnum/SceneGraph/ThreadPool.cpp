@@ -0,0 +1,98 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ThreadPool.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace {
+    std::size_t defaultThreadCount() {
+        /* The calling thread is doing the work too. Hardware concurrency
+           might be reported as zero if it can't be detected. */
+        const std::size_t concurrency = std::thread::hardware_concurrency();
+        return concurrency ? concurrency - 1 : 0;
+    }
+}
+
+ThreadPool::ThreadPool(): ThreadPool{defaultThreadCount()} {}
+
+ThreadPool::ThreadPool(const std::size_t threadCount): _job{}, _jobCount{}, _nextJob{}, _pendingJobs{}, _quit{} {
+    _threads.reserve(threadCount);
+    for(std::size_t i = 0; i != threadCount; ++i)
+        _threads.emplace_back(&ThreadPool::work, this);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _quit = true;
+    }
+    _wake.notify_all();
+
+    for(std::thread& thread: _threads) thread.join();
+}
+
+std::size_t ThreadPool::doWorkerCount() const { return _threads.size() + 1; }
+
+void ThreadPool::doRun(const std::size_t jobCount, const std::function<void(std::size_t)>& job) {
+    std::unique_lock<std::mutex> lock{_mutex};
+    _job = &job;
+    _jobCount = jobCount;
+    _nextJob = 0;
+    _pendingJobs = jobCount;
+    _wake.notify_all();
+
+    /* Help with the work, then wait for jobs picked up by other threads */
+    while(_nextJob < _jobCount) {
+        const std::size_t i = _nextJob++;
+        lock.unlock();
+        job(i);
+        lock.lock();
+        --_pendingJobs;
+    }
+    _done.wait(lock, [this]() { return _pendingJobs == 0; });
+
+    _job = nullptr;
+    _jobCount = _nextJob = 0;
+}
+
+void ThreadPool::work() {
+    std::unique_lock<std::mutex> lock{_mutex};
+    for(;;) {
+        _wake.wait(lock, [this]() { return _quit || _nextJob < _jobCount; });
+        if(_quit) return;
+
+        /* Jobs are handed out only while run() is waiting for them, so the
+           function pointer is valid until the job count drops to zero */
+        const std::size_t i = _nextJob++;
+        const std::function<void(std::size_t)>& job = *_job;
+        lock.unlock();
+        job(i);
+        lock.lock();
+        if(--_pendingJobs == 0) _done.notify_one();
+    }
+}
+
+}}
@@ -0,0 +1,120 @@
+#ifndef Magnum_SceneGraph_ThreadPool_h
+#define Magnum_SceneGraph_ThreadPool_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::ThreadPool
+ */
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <Corrade/configure.h>
+
+#include "Magnum/SceneGraph/AbstractJobSystem.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Thread pool
+
+Default @ref AbstractJobSystem implementation, executing the jobs on a fixed
+set of worker threads created on construction. The thread calling @ref run()
+takes part in the work as well. Example usage:
+@code
+SceneGraph::ThreadPool pool;
+
+// ...
+
+void MyApplication::drawEvent() {
+    camera->draw(drawables, pool);
+
+    // ...
+}
+@endcode
+
+@attention The @ref run() function is not reentrant, i.e. it can't be called
+    from inside the jobs or from more than one thread at a time.
+@partialsupport Not available on @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten".
+*/
+class MAGNUM_SCENEGRAPH_EXPORT ThreadPool: public AbstractJobSystem {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Creates one thread less than reported by
+         * `std::thread::hardware_concurrency()`, as the calling thread
+         * takes part in the work too.
+         */
+        explicit ThreadPool();
+
+        /**
+         * @brief Construct with given thread count
+         *
+         * Creates @p threadCount worker threads in addition to the calling
+         * thread. If @p threadCount is `0`, all jobs are executed on the
+         * calling thread.
+         */
+        explicit ThreadPool(std::size_t threadCount);
+
+        /**
+         * @brief Destructor
+         *
+         * Waits for all worker threads to finish.
+         */
+        ~ThreadPool();
+
+        /**
+         * @brief Count of worker threads
+         *
+         * Doesn't include the calling thread, i.e. is one less than
+         * @ref workerCount().
+         */
+        std::size_t threadCount() const { return _threads.size(); }
+
+    private:
+        MAGNUM_SCENEGRAPH_LOCAL std::size_t doWorkerCount() const override;
+        MAGNUM_SCENEGRAPH_LOCAL void doRun(std::size_t jobCount, const std::function<void(std::size_t)>& job) override;
+
+        MAGNUM_SCENEGRAPH_LOCAL void work();
+
+        std::vector<std::thread> _threads;
+        std::mutex _mutex;
+        std::condition_variable _wake, _done;
+        const std::function<void(std::size_t)>* _job;
+        std::size_t _jobCount, _nextJob, _pendingJobs;
+        bool _quit;
+};
+
+}}
+#else
+#error this header is not available in Emscripten build
+#endif
+
+#endif
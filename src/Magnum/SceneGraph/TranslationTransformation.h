@@ -227,6 +227,27 @@ template<UnsignedInt dimensions, class T, class TranslationType> struct Transfor
     }
 };
 
+/* Translations are composed starting from zero and the initial matrix is
+   applied only once to each final translation, which also allows arbitrary
+   camera matrices instead of pure translations */
+template<UnsignedInt dimensions, class T, class TranslationType> struct TransformationMatrix<TranslationTransformation<dimensions, T, TranslationType>> {
+    static VectorTypeFor<dimensions, TranslationType> initial(const MatrixTypeFor<dimensions, T>&) {
+        return {};
+    }
+
+    static MatrixTypeFor<dimensions, T> toMatrix(const MatrixTypeFor<dimensions, T>& initial, const VectorTypeFor<dimensions, TranslationType>& transformation) {
+        MatrixTypeFor<dimensions, T> out{initial};
+        out.translation() = initial.transformPoint(VectorTypeFor<dimensions, T>{transformation});
+        return out;
+    }
+
+    static MatrixTypeFor<dimensions, T> multiply(const MatrixTypeFor<dimensions, T>& initial, const MatrixTypeFor<dimensions, T>& matrix) {
+        MatrixTypeFor<dimensions, T> out{initial};
+        out.translation() = initial.transformPoint(matrix.translation());
+        return out;
+    }
+};
+
 }
 
 #if defined(CORRADE_TARGET_WINDOWS) && !defined(__MINGW32__)
@@ -0,0 +1,513 @@
+#ifndef Magnum_SceneGraph_WorldStreamer_h
+#define Magnum_SceneGraph_WorldStreamer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::WorldStreamer, enum @ref Magnum::SceneGraph::StreamedCellState
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Resource.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/SceneGraph/Object.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief State of a streamed cell
+
+@see @ref WorldStreamer::cellState()
+*/
+enum class StreamedCellState: UnsignedByte {
+    /** The cell assets are not requested and the cell is not instantiated */
+    Unloaded,
+
+    /** The cell assets are requested, but not all of them are loaded yet */
+    Loading,
+
+    /** All cell assets are loaded or not found, waiting for instantiation */
+    Loaded,
+
+    /** The cell is instantiated in the scene */
+    Active
+};
+
+namespace Implementation {
+    /* Type-erased reference to an asset in a ResourceManager */
+    struct StreamedAsset {
+        explicit StreamedAsset(ResourceKey key, std::size_t size): key{key}, size{size} {}
+        virtual ~StreamedAsset() = default;
+
+        virtual void acquire() = 0;
+        virtual void release() = 0;
+        virtual ResourceState state() = 0;
+
+        ResourceKey key;
+        std::size_t size;
+    };
+
+    template<class T, class Manager> struct ManagedStreamedAsset: StreamedAsset {
+        explicit ManagedStreamedAsset(Manager& manager, ResourceKey key, std::size_t size): StreamedAsset{key, size}, manager(manager) {}
+
+        /* Requesting the resource asks the loader for it, if it's not
+           already there */
+        void acquire() override { resource = manager.template get<T>(key); }
+        void release() override { resource = Resource<T>{}; }
+        ResourceState state() override { return resource.state(); }
+
+        Manager& manager;
+        Resource<T> resource;
+    };
+}
+
+/**
+@brief World streaming by spatial cells
+
+Splits a large world into cells, each with bounds and a manifest of assets in
+a @ref ResourceManager, requests the assets of cells the camera is
+approaching, instantiates the cells into the scene once all their assets are
+loaded and unloads the cells the camera moved away from.
+
+@code
+Scene3D scene;
+SceneGraph::WorldStreamer<SceneGraph::MatrixTransformation3D> streamer{scene};
+streamer.setLoadDistance(200.0f)
+    .setUnloadDistance(250.0f)
+    .setMemoryBudget(512*1024*1024);
+
+for(const CellDescription& cell: cells) {
+    const UnsignedInt id = streamer.addCell(cell.bounds,
+        [&](Object3D& root, UnsignedInt) {
+            std::optional<Trade::SceneData> data = importer.scene(cell.scene);
+            SceneGraph::importScene(importer, *data, root, instantiator);
+        });
+    for(const std::string& mesh: cell.meshes)
+        streamer.addAsset<Mesh>(id, manager, mesh, cell.meshSize);
+}
+
+void MyApplication::drawEvent() {
+    manager.loader<Mesh>()->update(4);
+
+    // Instantiate at most two cells each frame
+    streamer.update(camera.absoluteTransformation().translation(),
+                    cameraVelocity, 2);
+
+    // ...
+}
+@endcode
+
+## Prefetching
+
+The cells are requested by distance from both the current camera position
+and the position predicted from camera velocity after
+@ref setPredictionTime() seconds, so the assets of cells in the direction of
+camera movement start loading before the camera reaches them. Requesting an
+asset calls @ref ResourceManager::get(), so with a loader derived from
+@ref AbstractThreadedResourceLoader the assets are decoded on worker threads
+and the cell stays in @ref StreamedCellState::Loading until the loader
+uploads them. Assets that are not found don't block the cell, the
+instantiator is expected to check them.
+
+## Instantiation
+
+Once all assets of a cell are loaded, the cell is instantiated by creating
+a root object for it under the parent passed to the constructor and calling
+the instantiator function, which is expected to create the whole cell
+hierarchy at once, for example using @ref importScene(). The count of cells
+instantiated in one @ref update() call can be limited to spread the cost over
+multiple frames, the nearest cells are instantiated first.
+
+## Unloading and memory budget
+
+Cells farther than @ref unloadDistance() from both the current and predicted
+position are unloaded --- the root object is deleted together with all
+children and references to the assets are dropped. With the
+@ref ResourcePolicy::Cached policy the assets stay in the manager's
+least-recently-used cache, so returning to a recently unloaded cell doesn't
+need to load everything again.
+
+If @ref setMemoryBudget() is set, the sum of asset sizes declared in
+@ref addAsset() of all cells that are not @ref StreamedCellState::Unloaded is
+kept under it by unloading cells farther than the cell being requested,
+farthest first. A cell that doesn't fit even then is not requested. Assets
+shared by multiple cells are counted for each of them.
+
+@attention The root objects of active cells are owned by the parent object
+    and deleted by the streamer, so the streamer is expected to be destroyed
+    before the parent.
+*/
+template<class Transformation> class WorldStreamer {
+    public:
+        /** @brief Underlying floating-point type */
+        typedef typename Transformation::Type Type;
+
+        /** @brief Vector type */
+        typedef VectorTypeFor<Transformation::Dimensions, Type> VectorType;
+
+        /** @brief Cell bounds type */
+        typedef RangeTypeFor<Transformation::Dimensions, Type> RangeType;
+
+        /**
+         * @brief Cell instantiator
+         *
+         * Called with the cell root object and cell ID.
+         */
+        typedef std::function<void(Object<Transformation>&, UnsignedInt)> Instantiator;
+
+        /**
+         * @brief Constructor
+         * @param parent    Parent object for cell root objects
+         */
+        explicit WorldStreamer(Object<Transformation>& parent): _parent(parent), _loadDistance{100}, _unloadDistance{120}, _predictionTime{1.0f}, _memoryBudget{}, _residentSize{} {}
+
+        /** @brief Copying is not allowed */
+        WorldStreamer(const WorldStreamer<Transformation>&) = delete;
+
+        /** @brief Moving is not allowed */
+        WorldStreamer(WorldStreamer<Transformation>&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Unloads all cells.
+         */
+        ~WorldStreamer();
+
+        /** @brief Copying is not allowed */
+        WorldStreamer<Transformation>& operator=(const WorldStreamer<Transformation>&) = delete;
+
+        /** @brief Moving is not allowed */
+        WorldStreamer<Transformation>& operator=(WorldStreamer<Transformation>&&) = delete;
+
+        /** @brief Distance at which cells are requested */
+        Type loadDistance() const { return _loadDistance; }
+
+        /**
+         * @brief Set distance at which cells are requested
+         * @return Reference to self (for method chaining)
+         *
+         * Distance is measured from the camera position to the nearest point
+         * of cell bounds. Default is @cpp 100 @ce.
+         * @see @ref setUnloadDistance()
+         */
+        WorldStreamer<Transformation>& setLoadDistance(Type distance) {
+            _loadDistance = distance;
+            return *this;
+        }
+
+        /** @brief Distance at which cells are unloaded */
+        Type unloadDistance() const { return _unloadDistance; }
+
+        /**
+         * @brief Set distance at which cells are unloaded
+         * @return Reference to self (for method chaining)
+         *
+         * Expected to be larger than @ref loadDistance() so cells around the
+         * boundary are not loaded and unloaded repeatedly. Default is
+         * @cpp 120 @ce.
+         */
+        WorldStreamer<Transformation>& setUnloadDistance(Type distance) {
+            _unloadDistance = distance;
+            return *this;
+        }
+
+        /** @brief Prediction time */
+        Float predictionTime() const { return _predictionTime; }
+
+        /**
+         * @brief Set prediction time
+         * @return Reference to self (for method chaining)
+         *
+         * Time in seconds after which the camera position is predicted from
+         * velocity passed to @ref update(). Default is @cpp 1.0f @ce.
+         */
+        WorldStreamer<Transformation>& setPredictionTime(Float seconds) {
+            _predictionTime = seconds;
+            return *this;
+        }
+
+        /** @brief Memory budget */
+        std::size_t memoryBudget() const { return _memoryBudget; }
+
+        /**
+         * @brief Set memory budget
+         * @return Reference to self (for method chaining)
+         *
+         * Max total size of assets of cells that are not unloaded, in bytes.
+         * Default is @cpp 0 @ce, i.e. unlimited.
+         * @see @ref residentSize()
+         */
+        WorldStreamer<Transformation>& setMemoryBudget(std::size_t bytes) {
+            _memoryBudget = bytes;
+            return *this;
+        }
+
+        /**
+         * @brief Total size of assets of cells that are not unloaded
+         *
+         * @see @ref setMemoryBudget()
+         */
+        std::size_t residentSize() const { return _residentSize; }
+
+        /**
+         * @brief Add a cell
+         * @param bounds        Cell bounds in coordinates of the parent
+         * @param instantiator  Function creating the cell contents
+         * @return Cell ID
+         *
+         * The cell is in @ref StreamedCellState::Unloaded state.
+         */
+        UnsignedInt addCell(const RangeType& bounds, Instantiator instantiator);
+
+        /**
+         * @brief Add an asset to cell manifest
+         * @param cell      Cell ID
+         * @param manager   Resource manager
+         * @param key       Resource key
+         * @param size      Resource size in bytes, used for the
+         *      @ref setMemoryBudget() "memory budget"
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that the cell is @ref StreamedCellState::Unloaded. The
+         * resource of type @p T is requested from @p manager when the cell
+         * is being loaded.
+         */
+        template<class T, class Manager> WorldStreamer<Transformation>& addAsset(UnsignedInt cell, Manager& manager, ResourceKey key, std::size_t size = 0);
+
+        /** @brief Cell count */
+        std::size_t cellCount() const { return _cells.size(); }
+
+        /** @brief Cell bounds */
+        RangeType cellBounds(UnsignedInt cell) const;
+
+        /** @brief Count of assets in cell manifest */
+        std::size_t cellAssetCount(UnsignedInt cell) const;
+
+        /** @brief Cell state */
+        StreamedCellState cellState(UnsignedInt cell) const;
+
+        /**
+         * @brief Cell root object
+         *
+         * Returns `nullptr` if the cell is not
+         * @ref StreamedCellState::Active.
+         */
+        Object<Transformation>* cellObject(UnsignedInt cell);
+
+        /**
+         * @brief Count of cells in given state
+         *
+         * @see @ref cellState()
+         */
+        std::size_t cellCount(StreamedCellState state) const;
+
+        /**
+         * @brief Update the streaming
+         * @param position      Camera position in coordinates of the parent
+         * @param velocity      Camera velocity in units per second
+         * @param instantiationBudget   Max count of cells to instantiate
+         *
+         * Unloads cells that are too far, requests assets of cells that are
+         * near the current or predicted position, checks whether the assets
+         * of cells being loaded are available and instantiates the nearest
+         * loaded cells.
+         */
+        void update(const VectorType& position, const VectorType& velocity = {}, std::size_t instantiationBudget = ~std::size_t{});
+
+        /**
+         * @brief Unload a cell
+         *
+         * Deletes the cell root object, if the cell is active, and drops
+         * references to its assets. Does nothing if the cell is already
+         * unloaded.
+         */
+        void unload(UnsignedInt cell);
+
+    private:
+        struct Cell {
+            RangeType bounds;
+            Instantiator instantiator;
+            std::vector<std::unique_ptr<Implementation::StreamedAsset>> assets;
+            std::size_t size;
+            StreamedCellState state;
+            Object<Transformation>* object;
+            Type distance;
+        };
+
+        void request(Cell& cell);
+
+        Object<Transformation>& _parent;
+        std::vector<Cell> _cells;
+        Type _loadDistance, _unloadDistance;
+        Float _predictionTime;
+        std::size_t _memoryBudget, _residentSize;
+};
+
+template<class Transformation> WorldStreamer<Transformation>::~WorldStreamer() {
+    for(UnsignedInt i = 0; i != _cells.size(); ++i) unload(i);
+}
+
+template<class Transformation> UnsignedInt WorldStreamer<Transformation>::addCell(const RangeType& bounds, Instantiator instantiator) {
+    _cells.push_back(Cell{bounds, std::move(instantiator), {}, 0, StreamedCellState::Unloaded, nullptr, Type{}});
+    return _cells.size() - 1;
+}
+
+template<class Transformation> template<class T, class Manager> WorldStreamer<Transformation>& WorldStreamer<Transformation>::addAsset(const UnsignedInt cell, Manager& manager, const ResourceKey key, const std::size_t size) {
+    CORRADE_ASSERT(cell < _cells.size(),
+        "SceneGraph::WorldStreamer::addAsset(): cell" << cell << "out of range for" << _cells.size() << "cells", *this);
+    CORRADE_ASSERT(_cells[cell].state == StreamedCellState::Unloaded,
+        "SceneGraph::WorldStreamer::addAsset(): cell" << cell << "is not unloaded", *this);
+    _cells[cell].assets.emplace_back(new Implementation::ManagedStreamedAsset<T, Manager>{manager, key, size});
+    _cells[cell].size += size;
+    return *this;
+}
+
+template<class Transformation> auto WorldStreamer<Transformation>::cellBounds(const UnsignedInt cell) const -> RangeType {
+    CORRADE_ASSERT(cell < _cells.size(),
+        "SceneGraph::WorldStreamer::cellBounds(): cell" << cell << "out of range for" << _cells.size() << "cells", {});
+    return _cells[cell].bounds;
+}
+
+template<class Transformation> std::size_t WorldStreamer<Transformation>::cellAssetCount(const UnsignedInt cell) const {
+    CORRADE_ASSERT(cell < _cells.size(),
+        "SceneGraph::WorldStreamer::cellAssetCount(): cell" << cell << "out of range for" << _cells.size() << "cells", {});
+    return _cells[cell].assets.size();
+}
+
+template<class Transformation> StreamedCellState WorldStreamer<Transformation>::cellState(const UnsignedInt cell) const {
+    CORRADE_ASSERT(cell < _cells.size(),
+        "SceneGraph::WorldStreamer::cellState(): cell" << cell << "out of range for" << _cells.size() << "cells", {});
+    return _cells[cell].state;
+}
+
+template<class Transformation> Object<Transformation>* WorldStreamer<Transformation>::cellObject(const UnsignedInt cell) {
+    CORRADE_ASSERT(cell < _cells.size(),
+        "SceneGraph::WorldStreamer::cellObject(): cell" << cell << "out of range for" << _cells.size() << "cells", nullptr);
+    return _cells[cell].object;
+}
+
+template<class Transformation> std::size_t WorldStreamer<Transformation>::cellCount(const StreamedCellState state) const {
+    return std::count_if(_cells.begin(), _cells.end(), [state](const Cell& cell) {
+        return cell.state == state;
+    });
+}
+
+template<class Transformation> void WorldStreamer<Transformation>::unload(const UnsignedInt cell) {
+    CORRADE_ASSERT(cell < _cells.size(),
+        "SceneGraph::WorldStreamer::unload(): cell" << cell << "out of range for" << _cells.size() << "cells", );
+    Cell& c = _cells[cell];
+    if(c.state == StreamedCellState::Unloaded) return;
+
+    /* Deleting the root deletes the whole cell hierarchy */
+    delete c.object;
+    c.object = nullptr;
+
+    /* With the Cached policy the assets stay in the manager until its cache
+       budget is exceeded */
+    for(std::unique_ptr<Implementation::StreamedAsset>& asset: c.assets)
+        asset->release();
+
+    _residentSize -= c.size;
+    c.state = StreamedCellState::Unloaded;
+}
+
+template<class Transformation> void WorldStreamer<Transformation>::request(Cell& cell) {
+    for(std::unique_ptr<Implementation::StreamedAsset>& asset: cell.assets)
+        asset->acquire();
+
+    _residentSize += cell.size;
+    cell.state = StreamedCellState::Loading;
+}
+
+template<class Transformation> void WorldStreamer<Transformation>::update(const VectorType& position, const VectorType& velocity, const std::size_t instantiationBudget) {
+    const VectorType predicted = position + velocity*Type(_predictionTime);
+
+    /* Distance to the nearest point of each cell from either position */
+    for(Cell& cell: _cells) {
+        const VectorType a = Math::max(Math::max(cell.bounds.min() - position, position - cell.bounds.max()), VectorType{});
+        const VectorType b = Math::max(Math::max(cell.bounds.min() - predicted, predicted - cell.bounds.max()), VectorType{});
+        cell.distance = std::sqrt(std::min(a.dot(), b.dot()));
+    }
+
+    /* Unload cells that are too far */
+    for(UnsignedInt i = 0; i != _cells.size(); ++i)
+        if(_cells[i].state != StreamedCellState::Unloaded && _cells[i].distance > _unloadDistance)
+            unload(i);
+
+    /* All other cells, nearest first */
+    std::vector<UnsignedInt> order(_cells.size());
+    for(UnsignedInt i = 0; i != order.size(); ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [this](UnsignedInt a, UnsignedInt b) {
+        return _cells[a].distance < _cells[b].distance;
+    });
+
+    /* Request cells in load distance, making room in the memory budget by
+       unloading cells farther than them */
+    for(const UnsignedInt i: order) {
+        Cell& cell = _cells[i];
+        if(cell.distance > _loadDistance) break;
+        if(cell.state != StreamedCellState::Unloaded) continue;
+
+        if(_memoryBudget) {
+            for(auto farthest = order.rbegin(); *farthest != i && _residentSize + cell.size > _memoryBudget; ++farthest)
+                unload(*farthest);
+            if(_residentSize + cell.size > _memoryBudget) continue;
+        }
+
+        request(cell);
+    }
+
+    /* Check for loaded assets and instantiate the nearest loaded cells */
+    std::size_t instantiated = 0;
+    for(const UnsignedInt i: order) {
+        Cell& cell = _cells[i];
+
+        if(cell.state == StreamedCellState::Loading && std::all_of(cell.assets.begin(), cell.assets.end(), [](const std::unique_ptr<Implementation::StreamedAsset>& asset) {
+            const ResourceState state = asset->state();
+            return state != ResourceState::Loading && state != ResourceState::LoadingFallback;
+        }))
+            cell.state = StreamedCellState::Loaded;
+
+        if(cell.state != StreamedCellState::Loaded || instantiated == instantiationBudget) continue;
+
+        cell.object = new Object<Transformation>{&_parent};
+        if(cell.instantiator) cell.instantiator(*cell.object, i);
+        cell.state = StreamedCellState::Active;
+        ++instantiated;
+    }
+}
+
+}}
+
+#endif
@@ -25,6 +25,7 @@
 
 #include "Shader.h"
 
+#include <cstring>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/Debug.h>
@@ -43,6 +44,11 @@
 #include <sstream>
 #endif
 
+/* Not in flextGL headers yet */
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
 /* libgles-omap3-dev_4.03.00.02-r15.6 on BeagleBoard/Ångström linux 2011.3 doesn't have GLchar */
 #ifdef MAGNUM_TARGET_GLES
 typedef char GLchar;
@@ -777,6 +783,11 @@ Shader& Shader::setLabelInternal(const Containers::ArrayView<const char> label)
 std::vector<std::string> Shader::sources() const { return _sources; }
 
 Shader& Shader::addSource(std::string source) {
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_ASSERT(_spirv.empty(),
+        "Shader::addSource(): can't add GLSL sources to a SPIR-V shader", *this);
+    #endif
+
     if(!source.empty()) {
         /** @todo Remove when newlib has this fixed (also the include above) */
         #if defined(CORRADE_TARGET_NACL_NEWLIB) || defined(CORRADE_TARGET_ANDROID)
@@ -818,13 +829,61 @@ Shader& Shader::addFile(const std::string& filename) {
     return *this;
 }
 
+#ifndef MAGNUM_TARGET_GLES
+Shader& Shader::setSpirv(const Containers::ArrayView<const void> binary, std::string entryPoint) {
+    CORRADE_ASSERT(_sources.size() <= 1,
+        "Shader::setSpirv(): the shader already has GLSL sources", *this);
+    CORRADE_ASSERT(!binary.empty() && binary.size() % 4 == 0,
+        "Shader::setSpirv(): expected non-empty binary with size divisible by four, got" << binary.size() << "bytes", *this);
+
+    _spirv.assign(static_cast<const char*>(binary.data()), binary.size());
+    _spirvEntryPoint = std::move(entryPoint);
+    return *this;
+}
+
+Shader& Shader::setSpirvFile(const std::string& filename, std::string entryPoint) {
+    CORRADE_ASSERT(Utility::Directory::fileExists(filename),
+        "Shader file " << '\'' + filename + '\'' << " cannot be read.", *this);
+
+    const Containers::Array<char> data = Utility::Directory::read(filename);
+    return setSpirv(data, std::move(entryPoint));
+}
+
+Shader& Shader::setSpecializationConstant(const UnsignedInt id, const UnsignedInt value) {
+    for(std::size_t i = 0; i != _specializationIds.size(); ++i) {
+        if(_specializationIds[i] != id) continue;
+        _specializationValues[i] = value;
+        return *this;
+    }
+
+    _specializationIds.push_back(id);
+    _specializationValues.push_back(value);
+    return *this;
+}
+
+Shader& Shader::setSpecializationConstant(const UnsignedInt id, const Int value) {
+    return setSpecializationConstant(id, UnsignedInt(value));
+}
+
+Shader& Shader::setSpecializationConstant(const UnsignedInt id, const Float value) {
+    UnsignedInt bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return setSpecializationConstant(id, bits);
+}
+#endif
+
 bool Shader::compile(std::initializer_list<std::reference_wrapper<Shader>> shaders) {
-    bool allSuccess = true;
+    return submitCompile(shaders) && checkCompile(shaders);
+}
 
+bool Shader::submitCompile(std::initializer_list<std::reference_wrapper<Shader>> shaders) {
     /* Allocate large enough array for source pointers and sizes (to avoid
        reallocating it for each of them) */
     std::size_t maxSourceCount = 0;
     for(Shader& shader: shaders) {
+        #ifndef MAGNUM_TARGET_GLES
+        if(!shader._spirv.empty()) continue;
+        #endif
         CORRADE_ASSERT(shader._sources.size() > 1, "Shader::compile(): no files added", false);
         maxSourceCount = std::max(shader._sources.size(), maxSourceCount);
     }
@@ -834,6 +893,11 @@ bool Shader::compile(std::initializer_list<std::reference_wrapper<Shader>> shade
 
     /* Upload sources of all shaders */
     for(Shader& shader: shaders) {
+        #ifndef MAGNUM_TARGET_GLES
+        /* SPIR-V binaries are uploaded and specialized below */
+        if(!shader._spirv.empty()) continue;
+        #endif
+
         for(std::size_t i = 0; i != shader._sources.size(); ++i) {
             pointers[i] = static_cast<const GLchar*>(shader._sources[i].data());
             sizes[i] = shader._sources[i].size();
@@ -842,10 +906,28 @@ bool Shader::compile(std::initializer_list<std::reference_wrapper<Shader>> shade
         glShaderSource(shader._id, shader._sources.size(), pointers, sizes);
     }
 
-    /* Invoke (possibly parallel) compilation on all shaders */
-    for(Shader& shader: shaders) glCompileShader(shader._id);
+    /* Invoke (possibly parallel) compilation on all shaders. Specialization
+       of SPIR-V shaders is what compilation is for GLSL sources, the status
+       is then queried the same way. */
+    for(Shader& shader: shaders) {
+        #ifndef MAGNUM_TARGET_GLES
+        if(!shader._spirv.empty()) {
+            glShaderBinary(1, &shader._id, GL_SHADER_BINARY_FORMAT_SPIR_V_ARB, shader._spirv.data(), shader._spirv.size());
+            glSpecializeShaderARB(shader._id, shader._spirvEntryPoint.data(), shader._specializationIds.size(), shader._specializationIds.data(), shader._specializationValues.data());
+            continue;
+        }
+        #endif
+
+        glCompileShader(shader._id);
+    }
+
+    return true;
+}
+
+bool Shader::checkCompile(std::initializer_list<std::reference_wrapper<Shader>> shaders) {
+    bool allSuccess = true;
 
-    /* After compilation phase, check status of all shaders */
+    /* Check status of all shaders, waiting for the compilation to finish */
     Int i = 1;
     for(Shader& shader: shaders) {
         GLint success, logLength;
@@ -900,6 +982,19 @@ bool Shader::compile(std::initializer_list<std::reference_wrapper<Shader>> shade
     return allSuccess;
 }
 
+bool Shader::isCompileFinished() {
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(!Context::current().isExtensionSupported<Extensions::GL::KHR::parallel_shader_compile>())
+        return true;
+
+    GLint finished;
+    glGetShaderiv(_id, GL_COMPLETION_STATUS_KHR, &finished);
+    return finished == GL_TRUE;
+    #else
+    return true;
+    #endif
+}
+
 #ifndef DOXYGEN_GENERATING_OUTPUT
 Debug& operator<<(Debug& debug, const Shader::Type value) {
     switch(value) {
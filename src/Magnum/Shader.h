@@ -44,6 +44,30 @@ namespace Magnum {
 
 See @ref AbstractShaderProgram for usage information.
 
+@anchor Shader-spirv
+## SPIR-V shaders
+
+On desktop OpenGL with @extension{ARB,gl_spirv} the shader can be created from
+a precompiled SPIR-V binary instead of GLSL sources, which avoids the cost of
+the driver GLSL frontend on every startup. Supply the binary using
+@ref setSpirv() or @ref setSpirvFile() instead of adding sources (the
+@c \#version directive added in the constructor is ignored) and optionally select the shader variant with
+@ref setSpecializationConstant(). The shader is then compiled together with
+other shaders as usual:
+
+@code
+Shader frag{Version::None, Shader::Type::Fragment};
+frag.setSpirvFile("shader.frag.spv")
+    .setSpecializationConstant(0, 4); // e.g. light count
+CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, frag}));
+@endcode
+
+The binaries can be produced offline for example with `glslangValidator -G`
+from the Khronos reference compiler. Note that GLSL consumed through SPIR-V
+needs explicit locations for all uniforms and inputs / outputs, so shaders
+relying on @ref AbstractShaderProgram::uniformLocation() lookups need to be
+adapted first.
+
 ## Performance optimizations
 
 Shader limits and implementation-defined values (such as @ref maxUniformComponents())
@@ -507,6 +531,34 @@ class MAGNUM_EXPORT Shader: public AbstractObject {
          */
         static bool compile(std::initializer_list<std::reference_wrapper<Shader>> shaders);
 
+        /**
+         * @brief Submit compilation of multiple shaders
+         *
+         * Uploads sources and starts compilation of all @p shaders, but
+         * doesn't wait for the result. Use @ref checkCompile() later to get
+         * the result and print compiler messages, in the meantime the driver
+         * can compile the shaders in the background while the application
+         * does other work. Together with @ref checkCompile() equivalent to
+         * @ref compile(std::initializer_list<std::reference_wrapper<Shader>>).
+         * Returns `false` if any shader has no sources, `true` otherwise.
+         * @see @ref isCompileFinished(), @fn_gl{ShaderSource},
+         *      @fn_gl{CompileShader}
+         */
+        static bool submitCompile(std::initializer_list<std::reference_wrapper<Shader>> shaders);
+
+        /**
+         * @brief Check compilation status of multiple shaders
+         *
+         * Waits for compilation submitted with @ref submitCompile() to
+         * finish. Returns `false` if compilation of any shader failed, `true`
+         * if everything succeeded. Compiler messages (if any) are printed to
+         * error output.
+         * @see @ref isCompileFinished(), @fn_gl{GetShader} with
+         *      @def_gl{COMPILE_STATUS} and @def_gl{INFO_LOG_LENGTH},
+         *      @fn_gl{GetShaderInfoLog}
+         */
+        static bool checkCompile(std::initializer_list<std::reference_wrapper<Shader>> shaders);
+
         /**
          * @brief Constructor
          * @param version   Target version
@@ -588,6 +640,72 @@ class MAGNUM_EXPORT Shader: public AbstractObject {
         /** @brief Shader sources */
         std::vector<std::string> sources() const;
 
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Whether the shader is a SPIR-V shader
+         *
+         * @see @ref setSpirv(), @ref setSpirvFile()
+         * @requires_gl SPIR-V shaders are not available in OpenGL ES or
+         *      WebGL.
+         */
+        bool isSpirv() const { return !_spirv.empty(); }
+
+        /**
+         * @brief Set SPIR-V binary
+         * @param binary        SPIR-V module
+         * @param entryPoint    Name of the entry point
+         * @return Reference to self (for method chaining)
+         *
+         * The binary is uploaded with @fn_gl{ShaderBinary} and specialized
+         * with @fn_gl_extension{SpecializeShader,ARB,gl_spirv} in
+         * @ref compile(), using constants set with
+         * @ref setSpecializationConstant(). Expects that the binary is not
+         * empty, its size is a multiple of four bytes and no GLSL sources
+         * were added with @ref addSource() or @ref addFile(). Calling this
+         * function again replaces the previous binary. See
+         * @ref Shader-spirv "class documentation" for more information.
+         * @requires_extension Extension @extension{ARB,gl_spirv}
+         * @requires_gl SPIR-V shaders are not available in OpenGL ES or
+         *      WebGL.
+         */
+        Shader& setSpirv(Containers::ArrayView<const void> binary, std::string entryPoint = "main");
+
+        /**
+         * @brief Set SPIR-V binary from a file
+         * @return Reference to self (for method chaining)
+         *
+         * The file must exist and must be readable. Calls @ref setSpirv()
+         * with the contents.
+         * @requires_extension Extension @extension{ARB,gl_spirv}
+         * @requires_gl SPIR-V shaders are not available in OpenGL ES or
+         *      WebGL.
+         */
+        Shader& setSpirvFile(const std::string& filename, std::string entryPoint = "main");
+
+        /**
+         * @brief Set SPIR-V specialization constant
+         * @param id        Constant ID, specified with `layout(constant_id)`
+         *      in GLSL
+         * @param value     Constant value
+         * @return Reference to self (for method chaining)
+         *
+         * Constants not set keep the default value specified in the shader,
+         * setting the same constant again overwrites the previous value.
+         * Boolean constants take `0` or `1`. Has effect only for
+         * @ref isSpirv() "SPIR-V shaders".
+         * @requires_extension Extension @extension{ARB,gl_spirv}
+         * @requires_gl SPIR-V shaders are not available in OpenGL ES or
+         *      WebGL.
+         */
+        Shader& setSpecializationConstant(UnsignedInt id, UnsignedInt value);
+
+        /** @overload */
+        Shader& setSpecializationConstant(UnsignedInt id, Int value);
+
+        /** @overload */
+        Shader& setSpecializationConstant(UnsignedInt id, Float value);
+        #endif
+
         /**
          * @brief Add shader source
          * @param source    String with shader source
@@ -597,7 +715,7 @@ class MAGNUM_EXPORT Shader: public AbstractObject {
          * marking first line of the source as `n(1)` where n is number of
          * added source. The source number `0` is @c \#version directive added
          * in constructor, if any. If passed string is empty, the function does
-         * nothing.
+         * nothing. Can't be called on @ref isSpirv() "SPIR-V shaders".
          * @see @ref addFile()
          */
         Shader& addSource(std::string source);
@@ -622,6 +740,18 @@ class MAGNUM_EXPORT Shader: public AbstractObject {
          */
         bool compile() { return compile({*this}); }
 
+        /**
+         * @brief Whether compilation has finished
+         *
+         * Doesn't block. If @extension{KHR,parallel_shader_compile} is not
+         * available, always returns `true`, in which case @ref checkCompile()
+         * may block until the compilation finishes. Always returns `true` in
+         * WebGL. Note that this doesn't say whether the compilation succeeded,
+         * use @ref checkCompile() for that.
+         * @see @fn_gl{GetShader} with @def_gl{COMPLETION_STATUS_KHR}
+         */
+        bool isCompileFinished();
+
     private:
         Shader& setLabelInternal(Containers::ArrayView<const char> label);
 
@@ -629,12 +759,21 @@ class MAGNUM_EXPORT Shader: public AbstractObject {
         GLuint _id;
 
         std::vector<std::string> _sources;
+
+        #ifndef MAGNUM_TARGET_GLES
+        std::string _spirv, _spirvEntryPoint;
+        std::vector<GLuint> _specializationIds, _specializationValues;
+        #endif
 };
 
 /** @debugoperatorclassenum{Magnum::Shader,Magnum::Shader::Type} */
 MAGNUM_EXPORT Debug& operator<<(Debug& debug, Shader::Type value);
 
-inline Shader::Shader(Shader&& other) noexcept: _type(other._type), _id(other._id), _sources(std::move(other._sources)) {
+inline Shader::Shader(Shader&& other) noexcept: _type(other._type), _id(other._id), _sources(std::move(other._sources))
+    #ifndef MAGNUM_TARGET_GLES
+    , _spirv(std::move(other._spirv)), _spirvEntryPoint(std::move(other._spirvEntryPoint)), _specializationIds(std::move(other._specializationIds)), _specializationValues(std::move(other._specializationValues))
+    #endif
+{
     other._id = 0;
 }
 
@@ -643,6 +782,12 @@ inline Shader& Shader::operator=(Shader&& other) noexcept {
     swap(_type, other._type);
     swap(_id, other._id);
     swap(_sources, other._sources);
+    #ifndef MAGNUM_TARGET_GLES
+    swap(_spirv, other._spirv);
+    swap(_spirvEntryPoint, other._spirvEntryPoint);
+    swap(_specializationIds, other._specializationIds);
+    swap(_specializationValues, other._specializationValues);
+    #endif
     return *this;
 }
 
@@ -0,0 +1,138 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ShaderProgramBinaryCache.h"
+
+#include <cstring>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/MurmurHash2.h>
+
+#include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Shader.h"
+
+namespace Magnum {
+
+namespace {
+    ShaderProgramBinaryCache* currentCache = nullptr;
+}
+
+ShaderProgramBinaryCache* ShaderProgramBinaryCache::current() { return currentCache; }
+
+void ShaderProgramBinaryCache::setCurrent(ShaderProgramBinaryCache* const cache) {
+    currentCache = cache;
+}
+
+ShaderProgramBinaryCache::ShaderProgramBinaryCache(std::string directory): _directory{std::move(directory)}, _hitCount{}, _missCount{} {}
+
+ShaderProgramBinaryCache::~ShaderProgramBinaryCache() {
+    if(currentCache == this) currentCache = nullptr;
+}
+
+bool ShaderProgramBinaryCache::isSupported() const {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::get_program_binary>())
+        return false;
+    #endif
+
+    GLint formatCount = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    return formatCount > 0;
+}
+
+std::string ShaderProgramBinaryCache::key(const std::initializer_list<std::reference_wrapper<Shader>> shaders) const {
+    /* Everything that can affect the binary, with sizes to avoid ambiguities
+       when concatenating */
+    std::string data;
+    const auto append = [&data](const std::string& string) {
+        data += std::to_string(string.size());
+        data += ':';
+        data += string;
+    };
+
+    Context& context = Context::current();
+    append(context.vendorString());
+    append(context.rendererString());
+    append(context.versionString());
+    for(const Shader& shader: shaders) {
+        append(std::to_string(GLenum(shader.type())));
+        for(const std::string& source: shader.sources()) append(source);
+    }
+
+    /* Two differently seeded hashes to make collisions less probable */
+    std::ostringstream out;
+    out << std::hex;
+    for(const std::size_t seed: {std::size_t{0}, std::size_t{0x9e3779b9}}) {
+        const Utility::MurmurHash2::Digest digest = Utility::MurmurHash2{seed}(data.data(), data.size());
+        for(std::size_t i = 0; i != sizeof(std::size_t); ++i) {
+            const UnsignedByte byte = digest.byteArray()[i];
+            out << (byte >> 4) << (byte & 0x0f);
+        }
+    }
+    return out.str();
+}
+
+std::string ShaderProgramBinaryCache::filename(const std::string& key) const {
+    return Utility::Directory::join(_directory, key + ".bin");
+}
+
+bool ShaderProgramBinaryCache::load(AbstractShaderProgram& program, const std::string& key) {
+    /* The file contains binary format followed by the binary itself */
+    const std::string file = filename(key);
+    Containers::Array<char> data;
+    if(Utility::Directory::fileExists(file))
+        data = Utility::Directory::read(file);
+    if(data.size() <= sizeof(GLenum)) {
+        ++_missCount;
+        return false;
+    }
+
+    GLenum format;
+    std::memcpy(&format, data, sizeof(GLenum));
+    if(!program.setBinary(format, data.suffix(sizeof(GLenum)))) {
+        ++_missCount;
+        return false;
+    }
+
+    ++_hitCount;
+    return true;
+}
+
+bool ShaderProgramBinaryCache::save(AbstractShaderProgram& program, const std::string& key) {
+    const std::pair<GLenum, Containers::Array<char>> binary = program.binary();
+    if(binary.second.empty()) return false;
+
+    Containers::Array<char> data{sizeof(GLenum) + binary.second.size()};
+    std::memcpy(data, &binary.first, sizeof(GLenum));
+    std::copy(binary.second.begin(), binary.second.end(), data + sizeof(GLenum));
+
+    if(!Utility::Directory::mkpath(_directory)) return false;
+    return Utility::Directory::write(filename(key), data);
+}
+
+}
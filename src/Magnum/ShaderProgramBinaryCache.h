@@ -0,0 +1,186 @@
+#ifndef Magnum_ShaderProgramBinaryCache_h
+#define Magnum_ShaderProgramBinaryCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+/** @file
+ * @brief Class @ref Magnum::ShaderProgramBinaryCache
+ */
+#endif
+
+#include <initializer_list>
+#include <string>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/visibility.h"
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+namespace Magnum {
+
+/**
+@brief Disk cache of shader program binaries
+
+Stores binaries of linked shader programs in given directory, so they don't
+need to be compiled and linked again on next application start. The binaries
+are keyed by a hash of sources of all shaders in the program together with
+@ref Context::vendorString(), @ref Context::rendererString() and
+@ref Context::versionString(), so a driver update or a change in the shader
+sources results in a new binary being created.
+
+## Usage
+
+Create the cache and make it current, all builtin shaders in
+@ref Shaders namespace then use it automatically:
+@code
+ShaderProgramBinaryCache cache{Utility::Directory::join(Utility::Directory::configurationDir("MyApp"), "shaders")};
+ShaderProgramBinaryCache::setCurrent(&cache);
+
+Shaders::Phong phong; // loaded from the cache, if possible
+@endcode
+
+Custom shaders can use @ref AbstractShaderProgram::compileAndLink() in place
+of the usual @ref Shader::compile(), @ref AbstractShaderProgram::attachShaders()
+and @ref AbstractShaderProgram::link() sequence. Attribute and fragment data
+location bindings, which need to be done before linking, are done in the
+passed function:
+@code
+MyShader::MyShader() {
+    Shader vert{Version::GL330, Shader::Type::Vertex};
+    Shader frag{Version::GL330, Shader::Type::Fragment};
+    // add sources...
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(compileAndLink({vert, frag}, [this]() {
+        bindAttributeLocation(Position::Location, "position");
+    }));
+}
+@endcode
+
+If there is no current cache, program binaries are not supported by the driver
+or the driver rejects the stored binary, the program is transparently compiled
+and linked from sources and the binary is saved for next time.
+
+@requires_gl41 Extension @extension{ARB,get_program_binary}
+@requires_gles30 Not available in OpenGL ES 2.0.
+@requires_gles Binary program representations are not supported in WebGL.
+*/
+class MAGNUM_EXPORT ShaderProgramBinaryCache {
+    public:
+        /**
+         * @brief Current cache
+         *
+         * If no cache is current, returns `nullptr`.
+         * @see @ref setCurrent()
+         */
+        static ShaderProgramBinaryCache* current();
+
+        /**
+         * @brief Make a cache current
+         *
+         * Pass `nullptr` to disable caching. The cache is global, not
+         * specific to any particular @ref Context.
+         */
+        static void setCurrent(ShaderProgramBinaryCache* cache);
+
+        /**
+         * @brief Constructor
+         * @param directory     Directory where to store the binaries. Created
+         *      on first save, if it doesn't exist.
+         */
+        explicit ShaderProgramBinaryCache(std::string directory);
+
+        /** @brief Copying is not allowed */
+        ShaderProgramBinaryCache(const ShaderProgramBinaryCache&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * If the cache is current, the current cache is reset to `nullptr`.
+         */
+        ~ShaderProgramBinaryCache();
+
+        /** @brief Copying is not allowed */
+        ShaderProgramBinaryCache& operator=(const ShaderProgramBinaryCache&) = delete;
+
+        /** @brief Cache directory */
+        std::string directory() const { return _directory; }
+
+        /**
+         * @brief Whether program binaries are supported
+         *
+         * Returns `false` if @extension{ARB,get_program_binary} is not
+         * supported or if the driver doesn't provide any binary formats. In
+         * that case @ref load() and @ref save() always fail.
+         * @see @fn_gl{Get} with @def_gl{NUM_PROGRAM_BINARY_FORMATS}
+         */
+        bool isSupported() const;
+
+        /**
+         * @brief Cache key for given shaders
+         *
+         * Hash of type and sources of all @p shaders together with vendor,
+         * renderer and version string of current context.
+         */
+        std::string key(std::initializer_list<std::reference_wrapper<Shader>> shaders) const;
+
+        /**
+         * @brief Load program binary
+         * @return `true` if a binary for given key was found and accepted by
+         *      the driver, `false` otherwise
+         *
+         * @see @ref AbstractShaderProgram::setBinary()
+         */
+        bool load(AbstractShaderProgram& program, const std::string& key);
+
+        /**
+         * @brief Save program binary
+         * @return `true` if the binary was retrieved and saved, `false`
+         *      otherwise
+         *
+         * The program is expected to be linked. It is advised to call
+         * @ref AbstractShaderProgram::setRetrievableBinary() before linking.
+         * @see @ref AbstractShaderProgram::binary()
+         */
+        bool save(AbstractShaderProgram& program, const std::string& key);
+
+        /** @brief Count of successful loads */
+        UnsignedInt hitCount() const { return _hitCount; }
+
+        /** @brief Count of failed loads */
+        UnsignedInt missCount() const { return _missCount; }
+
+    private:
+        std::string MAGNUM_LOCAL filename(const std::string& key) const;
+
+        std::string _directory;
+        UnsignedInt _hitCount, _missCount;
+};
+
+}
+#else
+#error this header is not available in OpenGL ES 2.0 and WebGL build
+#endif
+
+#endif
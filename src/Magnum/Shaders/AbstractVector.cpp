@@ -26,6 +26,9 @@
 #include "AbstractVector.h"
 
 #include "Magnum/Texture.h"
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/TextureArray.h"
+#endif
 #include "Magnum/Shaders/visibility.h"
 
 namespace Magnum { namespace Shaders {
@@ -35,6 +38,13 @@ template<UnsignedInt dimensions> AbstractVector<dimensions>& AbstractVector<dime
     return *this;
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> AbstractVector<dimensions>& AbstractVector<dimensions>::setVectorTexture(Texture2DArray& texture) {
+    texture.bind(VectorTextureLayer);
+    return *this;
+}
+#endif
+
 #ifndef DOXYGEN_GENERATING_OUTPUT
 template class MAGNUM_SHADERS_EXPORT AbstractVector<2>;
 template class MAGNUM_SHADERS_EXPORT AbstractVector<3>;
@@ -57,12 +57,40 @@ template<UnsignedInt dimensions> class AbstractVector: public AbstractShaderProg
          */
         typedef typename Generic<dimensions>::TextureCoordinates TextureCoordinates;
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Texture array coordinates
+         *
+         * @ref shaders-generic "Generic attribute", @ref Vector3 with the
+         * texture layer in the last component. Used instead of
+         * @ref TextureCoordinates if the shader is created with texture array
+         * support, shares the same location.
+         * @requires_gl30 Extension @extension{EXT,texture_array}
+         * @requires_gles30 Array textures are not available in OpenGL ES 2.0.
+         * @requires_webgl20 Array textures are not available in WebGL 1.0.
+         */
+        typedef Attribute<Generic<dimensions>::TextureCoordinates::Location, Vector3> TextureArrayCoordinates;
+        #endif
+
         /**
          * @brief Set vector texture
          * @return Reference to self (for method chaining)
          */
         AbstractVector<dimensions>& setVectorTexture(Texture2D& texture);
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Set vector texture array
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that the shader was created with texture array support.
+         * @requires_gl30 Extension @extension{EXT,texture_array}
+         * @requires_gles30 Array textures are not available in OpenGL ES 2.0.
+         * @requires_webgl20 Array textures are not available in WebGL 1.0.
+         */
+        AbstractVector<dimensions>& setVectorTexture(Texture2DArray& texture);
+        #endif
+
     #ifndef DOXYGEN_GENERATING_OUTPUT
     protected:
     #else
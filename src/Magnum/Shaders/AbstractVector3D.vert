@@ -41,11 +41,34 @@ in highp vec4 position;
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = TEXTURECOORDINATES_ATTRIBUTE_LOCATION)
 #endif
+#ifndef TEXTURE_ARRAYS
 in mediump vec2 textureCoordinates;
+#else
+in mediump vec3 textureCoordinates;
+#endif
+
+#ifdef VERTEX_COLOR
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = 3)
+#endif
+in lowp vec4 vertexColor;
+#endif
 
+#ifndef TEXTURE_ARRAYS
 out mediump vec2 fragmentTextureCoordinates;
+#else
+out mediump vec3 fragmentTextureCoordinates;
+#endif
+
+#ifdef VERTEX_COLOR
+out lowp vec4 interpolatedVertexColor;
+#endif
 
 void main() {
     gl_Position = transformationProjectionMatrix*position;
     fragmentTextureCoordinates = textureCoordinates;
+
+    #ifdef VERTEX_COLOR
+    interpolatedVertexColor = vertexColor;
+    #endif
 }
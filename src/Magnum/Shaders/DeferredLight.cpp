@@ -0,0 +1,126 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DeferredLight.h"
+
+#include <Corrade/Utility/Resource.h>
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Shader.h"
+#include "Magnum/Texture.h"
+
+#include "Implementation/CreateCompatibilityShader.h"
+
+namespace Magnum { namespace Shaders {
+
+namespace {
+    enum: Int {
+        AlbedoTextureLayer = 0,
+        NormalTextureLayer = 1,
+        DepthTextureLayer = 2
+    };
+}
+
+DeferredLight::DeferredLight() {
+    #ifndef MAGNUM_TARGET_GLES
+    MAGNUM_ASSERT_VERSION_SUPPORTED(Version::GL300);
+    #endif
+
+    #ifdef MAGNUM_BUILD_STATIC
+    /* Import resources on static build, if not already */
+    if(!Utility::Resource::hasGroup("MagnumShaders"))
+        importShaderResources();
+    #endif
+    Utility::Resource rs("MagnumShaders");
+
+    #ifndef MAGNUM_TARGET_GLES
+    const Version version = Context::current().supportedVersion({Version::GL320, Version::GL310, Version::GL300});
+    #else
+    const Version version = Version::GLES300;
+    #endif
+
+    Shader vert = Implementation::createCompatibilityShader(rs, version, Shader::Type::Vertex);
+    Shader frag = Implementation::createCompatibilityShader(rs, version, Shader::Type::Fragment);
+
+    vert.addSource(rs.get("generic.glsl"))
+        .addSource(rs.get("DeferredLight.vert"));
+    frag.addSource(rs.get("DeferredLight.frag"));
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(compileAndLink({vert, frag}, [&]() {
+        #ifndef MAGNUM_TARGET_GLES
+        if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_attrib_location>(version)) {
+            bindAttributeLocation(Position::Location, "position");
+            bindFragmentDataLocation(ColorOutput, "color");
+        }
+        #endif
+    }));
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_uniform_location>(version))
+    #endif
+    {
+        _transformationProjectionMatrixUniform = uniformLocation("transformationProjectionMatrix");
+        _inverseProjectionMatrixUniform = uniformLocation("inverseProjectionMatrix");
+        _viewportScaleUniform = uniformLocation("viewportScale");
+        _lightPositionUniform = uniformLocation("lightPosition");
+        _lightRangeUniform = uniformLocation("lightRange");
+        _lightColorUniform = uniformLocation("lightColor");
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::shading_language_420pack>(version))
+    #endif
+    {
+        setUniform(uniformLocation("albedoTexture"), AlbedoTextureLayer);
+        setUniform(uniformLocation("normalTexture"), NormalTextureLayer);
+        setUniform(uniformLocation("depthTexture"), DepthTextureLayer);
+    }
+
+    /* Set defaults in OpenGL ES (for desktop they are set in shader code itself) */
+    #ifdef MAGNUM_TARGET_GLES
+    setTransformationProjectionMatrix({});
+    setProjectionMatrix({});
+    setLightRange(1.0f);
+    setLightColor(Color4{1.0f});
+    #endif
+}
+
+DeferredLight& DeferredLight::bindAlbedoTexture(Texture2D& texture) {
+    texture.bind(AlbedoTextureLayer);
+    return *this;
+}
+
+DeferredLight& DeferredLight::bindNormalTexture(Texture2D& texture) {
+    texture.bind(NormalTextureLayer);
+    return *this;
+}
+
+DeferredLight& DeferredLight::bindDepthTexture(Texture2D& texture) {
+    texture.bind(DepthTextureLayer);
+    return *this;
+}
+
+}}
@@ -0,0 +1,122 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 1)
+#endif
+uniform highp mat4 inverseProjectionMatrix
+    #ifndef GL_ES
+    = mat4(1.0)
+    #endif
+    ;
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 2)
+#endif
+uniform highp vec2 viewportScale;
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 3)
+#endif
+uniform highp vec3 lightPosition;
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 4)
+#endif
+uniform highp float lightRange
+    #ifndef GL_ES
+    = 1.0
+    #endif
+    ;
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 5)
+#endif
+uniform lowp vec4 lightColor
+    #ifndef GL_ES
+    = vec4(1.0)
+    #endif
+    ;
+
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 0)
+#endif
+uniform lowp sampler2D albedoTexture;
+
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 1)
+#endif
+uniform mediump sampler2D normalTexture;
+
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 2)
+#endif
+uniform highp sampler2D depthTexture;
+
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = 0)
+#endif
+out lowp vec4 color;
+
+/* Inverse of the octahedral encoding in Phong.frag */
+mediump vec3 decodeNormal(mediump vec2 encoded) {
+    encoded = encoded*2.0 - vec2(1.0);
+    mediump vec3 normal = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+    if(normal.z < 0.0)
+        normal.xy = (vec2(1.0) - abs(normal.yx))*vec2(normal.x >= 0.0 ? 1.0 : -1.0, normal.y >= 0.0 ? 1.0 : -1.0);
+    return normalize(normal);
+}
+
+void main() {
+    /* Reconstruct view-space position of the fragment from the depth */
+    highp vec2 coordinates = gl_FragCoord.xy*viewportScale;
+    highp float depth = texture(depthTexture, coordinates).r;
+    highp vec4 unprojected = inverseProjectionMatrix*vec4(vec3(coordinates, depth)*2.0 - vec3(1.0), 1.0);
+    highp vec3 position = unprojected.xyz/unprojected.w;
+
+    /* Same falloff as clustered lights in Phong.frag */
+    highp vec3 direction = lightPosition - position;
+    highp float distanceSquared = dot(direction, direction);
+    highp float rangeSquared = lightRange*lightRange;
+    if(distanceSquared >= rangeSquared) discard;
+
+    highp float falloff = 1.0 - distanceSquared/rangeSquared;
+    falloff *= falloff;
+
+    lowp vec4 albedo = texture(albedoTexture, coordinates);
+    mediump vec4 packedNormal = texture(normalTexture, coordinates);
+    mediump vec3 normal = decodeNormal(packedNormal.xy);
+    mediump float shininess = packedNormal.z*1023.0;
+
+    highp vec3 normalizedDirection = direction*inversesqrt(distanceSquared);
+    lowp float intensity = max(0.0, dot(normal, normalizedDirection));
+    color = vec4(albedo.rgb*lightColor.rgb*intensity*falloff, 0.0);
+
+    if(intensity > 0.001) {
+        highp vec3 reflection = reflect(-normalizedDirection, normal);
+        mediump float specularity = pow(max(0.0, dot(normalize(-position), reflection)), shininess);
+        color.rgb += albedo.a*lightColor.rgb*specularity*falloff;
+    }
+}
@@ -0,0 +1,203 @@
+#ifndef Magnum_Shaders_DeferredLight_h
+#define Magnum_Shaders_DeferredLight_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Shaders::DeferredLight
+ */
+
+#include "Magnum/configure.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shaders/Generic.h"
+#include "Magnum/Shaders/visibility.h"
+
+namespace Magnum { namespace Shaders {
+
+/**
+@brief Deferred point light shader
+
+Adds the contribution of a single point light to pixels of a @ref GBuffer
+filled by @ref Phong with @ref Phong::Flag::GBufferOutput. The shader is
+meant to be drawn on a light volume enclosing the light range, such as a
+@ref Primitives::Icosphere scaled to the range, with additive blending. The
+view-space position of each pixel is reconstructed from the depth buffer,
+the diffuse and specular terms and the smooth falloff reaching zero at the
+light range are the same as for @ref Phong::Flag::ClusteredLights. The G-buffer
+textures are bound and the volume is drawn with stencil culling by
+@ref GBuffer::drawLight(), see @ref GBuffer for an example.
+
+@requires_gl30 Extension @extension{EXT,gpu_shader4}
+@requires_gles30 Multiple fragment shader outputs are not available in OpenGL
+    ES 2.0.
+@requires_webgl20 Multiple fragment shader outputs are not available in WebGL
+    1.0.
+@see @ref shaders
+*/
+class MAGNUM_SHADERS_EXPORT DeferredLight: public AbstractShaderProgram {
+    public:
+        /**
+         * @brief Vertex position
+         *
+         * @ref shaders-generic "Generic attribute", @ref Vector3.
+         */
+        typedef Generic3D::Position Position;
+
+        enum: UnsignedInt {
+            /**
+             * Color shader output. Expects three- or four-component floating
+             * point or normalized buffer attachment with additive blending.
+             */
+            ColorOutput = 0
+        };
+
+        explicit DeferredLight();
+
+        /**
+         * @brief Construct without creating the underlying OpenGL object
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         *
+         * This function can be safely used for constructing (and later
+         * destructing) objects even without any OpenGL context being active.
+         */
+        explicit DeferredLight(NoCreateT) noexcept: AbstractShaderProgram{NoCreate} {}
+
+        /**
+         * @brief Set transformation and projection matrix of the light volume
+         * @return Reference to self (for method chaining)
+         *
+         * Initial value is an identity matrix.
+         */
+        DeferredLight& setTransformationProjectionMatrix(const Matrix4& matrix) {
+            setUniform(_transformationProjectionMatrixUniform, matrix);
+            return *this;
+        }
+
+        /**
+         * @brief Set projection matrix
+         * @return Reference to self (for method chaining)
+         *
+         * The same projection as used for filling the G-buffer, it's
+         * inverted and used to reconstruct view-space position from depth.
+         * Initial value is an identity matrix.
+         */
+        DeferredLight& setProjectionMatrix(const Matrix4& matrix) {
+            setUniform(_inverseProjectionMatrixUniform, matrix.inverted());
+            return *this;
+        }
+
+        /**
+         * @brief Set viewport size
+         * @return Reference to self (for method chaining)
+         *
+         * Size of the G-buffer, used to map fragment coordinates to texture
+         * coordinates.
+         */
+        DeferredLight& setViewportSize(const Vector2& size) {
+            setUniform(_viewportScaleUniform, Vector2{1.0f}/size);
+            return *this;
+        }
+
+        /**
+         * @brief Set light position
+         * @return Reference to self (for method chaining)
+         *
+         * In view space.
+         */
+        DeferredLight& setLightPosition(const Vector3& position) {
+            setUniform(_lightPositionUniform, position);
+            return *this;
+        }
+
+        /**
+         * @brief Set light range
+         * @return Reference to self (for method chaining)
+         *
+         * The contribution falls off to zero at this distance. The light
+         * volume is expected to enclose the sphere of this radius. Initial
+         * value is `1.0f`.
+         */
+        DeferredLight& setLightRange(Float range) {
+            setUniform(_lightRangeUniform, range);
+            return *this;
+        }
+
+        /**
+         * @brief Set light color
+         * @return Reference to self (for method chaining)
+         *
+         * Initial value is fully opaque white.
+         */
+        DeferredLight& setLightColor(const Color4& color) {
+            setUniform(_lightColorUniform, color);
+            return *this;
+        }
+
+        /**
+         * @brief Bind albedo texture
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref GBuffer::albedoTexture()
+         */
+        DeferredLight& bindAlbedoTexture(Texture2D& texture);
+
+        /**
+         * @brief Bind normal texture
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref GBuffer::normalTexture()
+         */
+        DeferredLight& bindNormalTexture(Texture2D& texture);
+
+        /**
+         * @brief Bind depth texture
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref GBuffer::depthStencilTexture()
+         */
+        DeferredLight& bindDepthTexture(Texture2D& texture);
+
+    private:
+        Int _transformationProjectionMatrixUniform{0},
+            _inverseProjectionMatrixUniform{1},
+            _viewportScaleUniform{2},
+            _lightPositionUniform{3},
+            _lightRangeUniform{4},
+            _lightColorUniform{5};
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 build
+#endif
+
+#endif
@@ -0,0 +1,102 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DepthPyramid.h"
+
+#include <Corrade/Utility/Resource.h>
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/ImageFormat.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/Shader.h"
+#include "Magnum/Texture.h"
+#include "Magnum/Math/Functions.h"
+
+#include "Implementation/CreateCompatibilityShader.h"
+
+namespace Magnum { namespace Shaders {
+
+namespace {
+    enum: Int {
+        DepthTextureLayer = 0,
+        SourceImageUnit = 0,
+        DestinationImageUnit = 1
+    };
+}
+
+DepthPyramid::DepthPyramid() {
+    MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::ARB::compute_shader);
+
+    #ifdef MAGNUM_BUILD_STATIC
+    /* Import resources on static build, if not already */
+    if(!Utility::Resource::hasGroup("MagnumShaders"))
+        importShaderResources();
+    #endif
+    Utility::Resource rs("MagnumShaders");
+
+    const Version version = Context::current().supportedVersion({Version::GL430, Version::GL420});
+
+    Shader comp = Implementation::createCompatibilityShader(rs, version, Shader::Type::Compute);
+    comp.addSource(version < Version::GL430 ?
+            "#extension GL_ARB_compute_shader: require\n" : "")
+        .addSource(rs.get("DepthPyramid.comp"));
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(compileAndLink({comp}));
+
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_uniform_location>(version)) {
+        _sourceLevelUniform = uniformLocation("sourceLevel");
+        _sourceSizeUniform = uniformLocation("sourceSize");
+    }
+
+    /* Texture and image bindings are set in the shader code itself, as GLSL
+       4.20 is guaranteed by ARB_compute_shader */
+}
+
+DepthPyramid& DepthPyramid::reduce(Texture2D& depthTexture, Texture2D& pyramid, const Vector2i& size, const Int levelCount) {
+    depthTexture.bind(DepthTextureLayer);
+
+    Vector2i sourceSize = size;
+    for(Int level = 0; level != levelCount; ++level) {
+        /* Level 0 is a copy of the depth texture, the others are reduced from
+           the previous level */
+        const Vector2i levelSize = level ? Vector2i{Math::max(sourceSize/2, Vector2i{1})} : size;
+        if(level) pyramid.bindImage(SourceImageUnit, level - 1, ImageAccess::ReadOnly, ImageFormat::R32F);
+        pyramid.bindImage(DestinationImageUnit, level, ImageAccess::WriteOnly, ImageFormat::R32F);
+
+        setUniform(_sourceLevelUniform, level);
+        setUniform(_sourceSizeUniform, sourceSize);
+        dispatchCompute({(Vector2ui{levelSize} + Vector2ui{WorkgroupSize - 1})/WorkgroupSize, 1});
+
+        Renderer::setMemoryBarrier(level + 1 == levelCount ?
+            Renderer::MemoryBarrier::TextureFetch :
+            Renderer::MemoryBarrier::ShaderImageAccess);
+        sourceSize = levelSize;
+    }
+
+    return *this;
+}
+
+}}
@@ -0,0 +1,114 @@
+#ifndef Magnum_Shaders_DepthPyramid_h
+#define Magnum_Shaders_DepthPyramid_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Shaders::DepthPyramid
+ */
+
+#include "Magnum/configure.h"
+
+#ifndef MAGNUM_TARGET_GLES
+#include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/Shaders/visibility.h"
+
+namespace Magnum { namespace Shaders {
+
+/**
+@brief Hierarchical depth buffer builder
+
+Compute shader building a mip chain where each texel contains the farthest
+depth of the texels it covers in the level below, for use with
+@ref InstanceCulling::Flag::HierarchicalZ. Level @cpp 0 @ce is a copy of the
+depth buffer, odd level sizes are handled by including the extra row and
+column in the last texel.
+@code
+Texture2D depthPyramid;
+depthPyramid.setMinificationFilter(Sampler::Filter::Nearest, Sampler::Mipmap::Nearest)
+    .setMagnificationFilter(Sampler::Filter::Nearest)
+    .setWrapping(Sampler::Wrapping::ClampToEdge)
+    .setStorage(Math::log2(size.max()) + 1, TextureFormat::R32F, size);
+
+Shaders::DepthPyramid pyramidShader;
+
+// render the scene to a framebuffer with depthTexture attached ...
+
+pyramidShader.reduce(depthTexture, depthPyramid, size, Math::log2(size.max()) + 1);
+@endcode
+
+The pyramid built from the current frame is then used to cull the next one.
+@requires_gl43 Extension @extension{ARB,compute_shader}
+@requires_gl Indirect drawing is not available in OpenGL ES or WebGL.
+*/
+class MAGNUM_SHADERS_EXPORT DepthPyramid: public AbstractShaderProgram {
+    public:
+        enum: UnsignedInt {
+            /** Workgroup size in each direction */
+            WorkgroupSize = 8
+        };
+
+        explicit DepthPyramid();
+
+        /**
+         * @brief Construct without creating the underlying OpenGL object
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         *
+         * This function can be safely used for constructing (and later
+         * destructing) objects even without any OpenGL context being active.
+         */
+        explicit DepthPyramid(NoCreateT) noexcept: AbstractShaderProgram{NoCreate} {}
+
+        /**
+         * @brief Build the pyramid
+         * @param depthTexture  Depth texture to build the pyramid from
+         * @param pyramid       Destination texture with
+         *      @ref TextureFormat::R32F storage of at least @p levelCount
+         *      levels
+         * @param size          Size of the depth texture and level
+         *      @cpp 0 @ce of @p pyramid
+         * @param levelCount    Count of levels to fill
+         * @return Reference to self (for method chaining)
+         *
+         * Issues one dispatch per level, separated by memory barriers.
+         * After the last level a @ref Renderer::MemoryBarrier::TextureFetch
+         * barrier is issued so the pyramid can be directly sampled.
+         */
+        DepthPyramid& reduce(Texture2D& depthTexture, Texture2D& pyramid, const Vector2i& size, Int levelCount);
+
+    private:
+        Int _sourceLevelUniform{0},
+            _sourceSizeUniform{1};
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES build
+#endif
+
+#endif
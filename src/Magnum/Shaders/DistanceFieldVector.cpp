@@ -41,7 +41,7 @@ namespace {
     template<> constexpr const char* vertexShaderName<3>() { return "AbstractVector3D.vert"; }
 }
 
-template<UnsignedInt dimensions> DistanceFieldVector<dimensions>::DistanceFieldVector() {
+template<UnsignedInt dimensions> DistanceFieldVector<dimensions>::DistanceFieldVector(const Flags flags): _flags{flags} {
     #ifdef MAGNUM_BUILD_STATIC
     /* Import resources on static build, if not already */
     if(!Utility::Resource::hasGroup("MagnumShaders"))
@@ -55,28 +55,44 @@ template<UnsignedInt dimensions> DistanceFieldVector<dimensions>::DistanceFieldV
     const Version version = Context::current().supportedVersion({Version::GLES300, Version::GLES200});
     #endif
 
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_GLES)
+    if(flags & Flag::TextureArrays) {
+        MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::EXT::texture_array);
+        CORRADE_ASSERT(version >= Version::GL300,
+            "Shaders::DistanceFieldVector: texture arrays require at least GLSL 1.30", );
+    }
+    #endif
+
     Shader frag = Implementation::createCompatibilityShader(rs, version, Shader::Type::Vertex);
     Shader vert = Implementation::createCompatibilityShader(rs, version, Shader::Type::Fragment);
 
-    frag.addSource(rs.get("generic.glsl"))
-        .addSource(rs.get(vertexShaderName<dimensions>()));
-    vert.addSource(rs.get("DistanceFieldVector.frag"));
-
-    CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({frag, vert}));
-
-    AbstractShaderProgram::attachShaders({frag, vert});
-
-    #ifndef MAGNUM_TARGET_GLES
-    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_attrib_location>(version))
+    #ifndef MAGNUM_TARGET_GLES2
+    const char* const textureArrays = flags & Flag::TextureArrays ? "#define TEXTURE_ARRAYS\n" : "";
     #else
-    if(!Context::current().isVersionSupported(Version::GLES300))
+    const char* const textureArrays = "";
     #endif
-    {
-        AbstractShaderProgram::bindAttributeLocation(AbstractVector<dimensions>::Position::Location, "position");
-        AbstractShaderProgram::bindAttributeLocation(AbstractVector<dimensions>::TextureCoordinates::Location, "textureCoordinates");
-    }
-
-    CORRADE_INTERNAL_ASSERT_OUTPUT(AbstractShaderProgram::link());
+    frag.addSource(flags & Flag::VertexColor ? "#define VERTEX_COLOR\n" : "")
+        .addSource(textureArrays)
+        .addSource(rs.get("generic.glsl"))
+        .addSource(rs.get(vertexShaderName<dimensions>()));
+    vert.addSource(flags & Flag::VertexColor ? "#define VERTEX_COLOR\n" : "")
+        .addSource(textureArrays)
+        .addSource(rs.get("DistanceFieldVector.frag"));
+
+    const auto bindAttributeLocations = [&]() {
+        #ifndef MAGNUM_TARGET_GLES
+        if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_attrib_location>(version))
+        #else
+        if(!Context::current().isVersionSupported(Version::GLES300))
+        #endif
+        {
+            AbstractShaderProgram::bindAttributeLocation(AbstractVector<dimensions>::Position::Location, "position");
+            AbstractShaderProgram::bindAttributeLocation(AbstractVector<dimensions>::TextureCoordinates::Location, "textureCoordinates");
+            if(flags & Flag::VertexColor)
+                AbstractShaderProgram::bindAttributeLocation(Color::Location, "vertexColor");
+        }
+    };
+    CORRADE_INTERNAL_ASSERT_OUTPUT(AbstractShaderProgram::compileAndLink({frag, vert}, bindAttributeLocations));
 
     #ifndef MAGNUM_TARGET_GLES
     if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_uniform_location>(version))
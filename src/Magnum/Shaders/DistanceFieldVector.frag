@@ -60,9 +60,21 @@ uniform lowp float smoothness
 #ifdef EXPLICIT_TEXTURE_LAYER
 layout(binding = 15)
 #endif
+#ifndef TEXTURE_ARRAYS
 uniform lowp sampler2D vectorTexture;
+#else
+uniform lowp sampler2DArray vectorTexture;
+#endif
 
+#ifndef TEXTURE_ARRAYS
 in mediump vec2 fragmentTextureCoordinates;
+#else
+in mediump vec3 fragmentTextureCoordinates;
+#endif
+
+#ifdef VERTEX_COLOR
+in lowp vec4 interpolatedVertexColor;
+#endif
 
 #ifdef NEW_GLSL
 out lowp vec4 fragmentColor;
@@ -71,8 +83,13 @@ out lowp vec4 fragmentColor;
 void main() {
     lowp float intensity = texture(vectorTexture, fragmentTextureCoordinates).r;
 
-    /* Fill color */
-    fragmentColor = smoothstep(outlineRange.x-smoothness, outlineRange.x+smoothness, intensity)*color;
+    /* Fill color, optionally modulated with per-vertex color */
+    #ifndef VERTEX_COLOR
+    lowp vec4 fillColor = color;
+    #else
+    lowp vec4 fillColor = color*interpolatedVertexColor;
+    #endif
+    fragmentColor = smoothstep(outlineRange.x-smoothness, outlineRange.x+smoothness, intensity)*fillColor;
 
     /* Outline */
     if(outlineRange.x > outlineRange.y) {
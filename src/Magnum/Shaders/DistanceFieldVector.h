@@ -38,6 +38,16 @@
 
 namespace Magnum { namespace Shaders {
 
+namespace Implementation {
+    enum class DistanceFieldVectorFlag: UnsignedByte {
+        VertexColor = 1 << 0,
+        #ifndef MAGNUM_TARGET_GLES2
+        TextureArrays = 1 << 1
+        #endif
+    };
+    typedef Containers::EnumSet<DistanceFieldVectorFlag> DistanceFieldVectorFlags;
+}
+
 /**
 @brief Distance field vector shader
 
@@ -86,6 +96,17 @@ shader.setColor(Color3::fromHSV(216.0_degf, 0.85f, 1.0f))
 mesh.draw(shader);
 @endcode
 
+If @ref Flag::VertexColor is passed to the constructor, the mesh can
+additionally provide a per-vertex @ref Color attribute that's multiplied with
+the fill color. That allows drawing many differently colored vector graphics
+(such as texts batched with @ref Text::BatchRenderer) in a single draw call.
+
+If @ref Flag::TextureArrays is passed to the constructor, the shader samples a
+@ref Texture2DArray instead and the mesh is expected to provide
+@ref TextureArrayCoordinates with the layer index in the last component, such
+as the vertex data produced by @ref Text::Renderer for a
+@ref Text::GlyphCacheArray.
+
 @see @ref shaders, @ref DistanceFieldVector2D, @ref DistanceFieldVector3D
 @todo Use fragment shader derivations to have proper smoothness in perspective/
     large zoom levels, make it optional as it might have negative performance
@@ -93,7 +114,51 @@ mesh.draw(shader);
 */
 template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT DistanceFieldVector: public AbstractVector<dimensions> {
     public:
-        explicit DistanceFieldVector();
+        /**
+         * @brief Vertex color
+         *
+         * @ref shaders-generic "Generic attribute", @ref Color4. Used only if
+         * @ref Flag::VertexColor is set.
+         */
+        typedef typename Generic<dimensions>::Color Color;
+
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        /**
+         * @brief Flag
+         *
+         * @see @ref Flags, @ref flags()
+         */
+        enum class Flag: UnsignedByte {
+            /** Multiply fill color with per-vertex @ref Color attribute */
+            VertexColor = 1 << 0,
+
+            /**
+             * Sample a @ref Texture2DArray using @ref TextureArrayCoordinates
+             * @requires_gl30 Extension @extension{EXT,texture_array}
+             * @requires_gles30 Array textures are not available in OpenGL ES
+             *      2.0.
+             * @requires_webgl20 Array textures are not available in WebGL
+             *      1.0.
+             */
+            TextureArrays = 1 << 1
+        };
+
+        /**
+         * @brief Flags
+         *
+         * @see @ref flags()
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+        #else
+        typedef Implementation::DistanceFieldVectorFlag Flag;
+        typedef Implementation::DistanceFieldVectorFlags Flags;
+        #endif
+
+        /**
+         * @brief Constructor
+         * @param flags     Flags
+         */
+        explicit DistanceFieldVector(Flags flags = {});
 
         /**
          * @brief Construct without creating the underlying OpenGL object
@@ -112,6 +177,9 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT DistanceFieldVector
             #endif
             {}
 
+        /** @brief Flags */
+        Flags flags() const { return _flags; }
+
         /**
          * @brief Set transformation and projection matrix
          * @return Reference to self (for method chaining)
@@ -125,6 +193,8 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT DistanceFieldVector
          * @brief Set fill color
          * @return Reference to self (for method chaining)
          *
+         * If @ref Flag::VertexColor is set, the color is multiplied with the
+         * per-vertex @ref Color attribute.
          * @see @ref setOutlineColor()
          */
         DistanceFieldVector& setColor(const Color4& color) {
@@ -181,9 +251,16 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT DistanceFieldVector
             AbstractVector<dimensions>::setVectorTexture(texture);
             return *this;
         }
+        #ifndef MAGNUM_TARGET_GLES2
+        DistanceFieldVector<dimensions>& setVectorTexture(Texture2DArray& texture) {
+            AbstractVector<dimensions>::setVectorTexture(texture);
+            return *this;
+        }
+        #endif
         #endif
 
     private:
+        Flags _flags;
         Int _transformationProjectionMatrixUniform{0},
             _colorUniform{1},
             _outlineColorUniform{2},
@@ -197,6 +274,8 @@ typedef DistanceFieldVector<2> DistanceFieldVector2D;
 /** @brief Three-dimensional distance field vector shader */
 typedef DistanceFieldVector<3> DistanceFieldVector3D;
 
+CORRADE_ENUMSET_OPERATORS(Implementation::DistanceFieldVectorFlags)
+
 }}
 
 #endif
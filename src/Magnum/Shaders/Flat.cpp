@@ -27,6 +27,7 @@
 
 #include <Corrade/Utility/Resource.h>
 
+#include "Magnum/Buffer.h"
 #include "Magnum/Context.h"
 #include "Magnum/Extensions.h"
 #include "Magnum/Shader.h"
@@ -39,12 +40,47 @@ namespace Magnum { namespace Shaders {
 namespace {
     enum: Int { TextureLayer = 0 };
 
+    #ifndef MAGNUM_TARGET_GLES2
+    enum: UnsignedInt { DrawBufferBinding = 0 };
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    enum: UnsignedInt {
+        VertexDataBinding = 0,
+        VertexLayoutBinding = 1
+    };
+    #endif
+
     template<UnsignedInt> constexpr const char* vertexShaderName();
     template<> constexpr const char* vertexShaderName<2>() { return "Flat2D.vert"; }
     template<> constexpr const char* vertexShaderName<3>() { return "Flat3D.vert"; }
 }
 
-template<UnsignedInt dimensions> Flat<dimensions>::Flat(const Flags flags): _flags(flags) {
+template<UnsignedInt dimensions> typename Flat<dimensions>::CompileState Flat<dimensions>::compile(const Flags flags, const UnsignedInt drawCount) {
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags & Flag::UniformBuffers) {
+        #ifndef MAGNUM_TARGET_GLES
+        MAGNUM_ASSERT_VERSION_SUPPORTED(Version::GL310);
+        #else
+        MAGNUM_ASSERT_VERSION_SUPPORTED(Version::GLES300);
+        #endif
+    }
+    #else
+    static_cast<void>(drawCount);
+    #endif
+    #ifndef MAGNUM_TARGET_GLES
+    if(flags & Flag::BindlessTexture)
+        MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::ARB::bindless_texture);
+    #endif
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(flags & Flag::Multiview)
+        MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::OVR::multiview);
+    #endif
+    #ifndef MAGNUM_TARGET_GLES
+    if(flags & Flag::VertexPulling)
+        MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::ARB::shader_storage_buffer_object);
+    #endif
+
     #ifdef MAGNUM_BUILD_STATIC
     /* Import resources on static build, if not already */
     if(!Utility::Resource::hasGroup("MagnumShaders"))
@@ -52,8 +88,12 @@ template<UnsignedInt dimensions> Flat<dimensions>::Flat(const Flags flags): _fla
     #endif
     Utility::Resource rs("MagnumShaders");
 
+    /* Vertex pulling needs storage buffers, explicit bindings and bit
+       manipulation functions, which are not in GLSL below 4.20 */
     #ifndef MAGNUM_TARGET_GLES
-    const Version version = Context::current().supportedVersion({Version::GL320, Version::GL310, Version::GL300, Version::GL210});
+    const Version version = flags & Flag::VertexPulling ?
+        Context::current().supportedVersion({Version::GL430, Version::GL420}) :
+        Context::current().supportedVersion({Version::GL320, Version::GL310, Version::GL300, Version::GL210});
     #else
     const Version version = Context::current().supportedVersion({Version::GLES300, Version::GLES200});
     #endif
@@ -61,55 +101,212 @@ template<UnsignedInt dimensions> Flat<dimensions>::Flat(const Flags flags): _fla
     Shader vert = Implementation::createCompatibilityShader(rs, version, Shader::Type::Vertex);
     Shader frag = Implementation::createCompatibilityShader(rs, version, Shader::Type::Fragment);
 
+    #ifndef MAGNUM_TARGET_GLES
+    if(flags & Flag::VertexPulling) vert.addSource(version < Version::GL430 ?
+        "#extension GL_ARB_shader_storage_buffer_object: require\n"
+        "#define VERTEX_PULLING\n" : "#define VERTEX_PULLING\n");
+    #endif
+
     vert.addSource(flags & Flag::Textured ? "#define TEXTURED\n" : "")
-        .addSource(rs.get("generic.glsl"))
+        .addSource(flags & Flag::VertexColor ? "#define VERTEX_COLOR\n" : "")
+        .addSource(flags & Flag::InstancedTransformation ? "#define INSTANCED_TRANSFORMATION\n" : "");
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags & Flag::UniformBuffers)
+        vert.addSource("#define UNIFORM_BUFFERS\n#define DRAW_COUNT " + std::to_string(drawCount) + "\n");
+    #endif
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(flags & Flag::Multiview)
+        vert.addSource("#define MULTIVIEW\n");
+    #endif
+    vert.addSource(rs.get("generic.glsl"))
         .addSource(rs.get(vertexShaderName<dimensions>()));
+    #ifndef MAGNUM_TARGET_GLES
+    /* Appended after the main source, which declares the fetch function, to
+       have all extension directives before any declarations */
+    if(flags & Flag::VertexPulling)
+        vert.addSource(rs.get("VertexPulling.glsl"));
+    #endif
     frag.addSource(flags & Flag::Textured ? "#define TEXTURED\n" : "")
-        .addSource(rs.get("Flat.frag"));
+        .addSource(flags & Flag::VertexColor ? "#define VERTEX_COLOR\n" : "");
+    #ifndef MAGNUM_TARGET_GLES
+    if(flags & Flag::BindlessTexture) {
+        vert.addSource("#define BINDLESS_TEXTURE\n");
+        frag.addSource("#define BINDLESS_TEXTURE\n");
+    }
+    #endif
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags & Flag::UniformBuffers)
+        frag.addSource("#define UNIFORM_BUFFERS\n");
+    #endif
+    frag.addSource(rs.get("Flat.frag"));
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, frag}));
+    Flat<dimensions> out{Math::NoInit};
+    out._flags = flags;
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags & Flag::UniformBuffers) out._drawCount = drawCount;
+    #endif
+
+    const auto bindAttributeLocations = [&]() {
+        #ifndef MAGNUM_TARGET_GLES
+        if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_attrib_location>(version))
+        #else
+        if(!Context::current().isVersionSupported(Version::GLES300))
+        #endif
+        {
+            #ifndef MAGNUM_TARGET_GLES
+            if(!(flags & Flag::VertexPulling))
+            #endif
+            {
+                out.bindAttributeLocation(Position::Location, "position");
+                if(flags & Flag::Textured) out.bindAttributeLocation(TextureCoordinates::Location, "textureCoordinates");
+                if(flags & Flag::VertexColor) out.bindAttributeLocation(Color::Location, "vertexColor");
+            }
+            if(flags & Flag::InstancedTransformation) out.bindAttributeLocation(TransformationMatrix::Location, "instancedTransformationMatrix");
+        }
+    };
+    const bool loaded = out.submitCompileAndLink({vert, frag}, bindAttributeLocations);
+
+    return CompileState{std::move(out), std::move(vert), std::move(frag), version, loaded};
+}
 
-    attachShaders({vert, frag});
+template<UnsignedInt dimensions> Flat<dimensions>::Flat(const Flags flags, const UnsignedInt drawCount): Flat{compile(flags, drawCount)} {}
 
+template<UnsignedInt dimensions> Flat<dimensions>::Flat(CompileState&& state): Flat{static_cast<Flat&&>(std::move(state))} {
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    CORRADE_ASSERT(!(_flags & Flag::Multiview) || (dimensions == 3 && !(_flags & Flag::UniformBuffers)),
+        "Shaders::Flat: multiview is available only in 3D and can't be combined with uniform buffers", );
+    #endif
     #ifndef MAGNUM_TARGET_GLES
-    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_attrib_location>(version))
-    #else
-    if(!Context::current().isVersionSupported(Version::GLES300))
+    CORRADE_ASSERT(!(_flags & Flag::VertexPulling) || (_flags & Flag::UniformBuffers),
+        "Shaders::Flat: vertex pulling has to be combined with uniform buffers", );
     #endif
-    {
-        bindAttributeLocation(Position::Location, "position");
-        if(flags & Flag::Textured) bindAttributeLocation(TextureCoordinates::Location, "textureCoordinates");
-    }
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+    if(!state._loaded)
+        CORRADE_INTERNAL_ASSERT_OUTPUT(checkCompileAndLink({state._vert, state._frag}));
+
+    #ifndef MAGNUM_TARGET_GLES
+    const Version version = state._version;
+    #endif
 
     #ifndef MAGNUM_TARGET_GLES
     if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_uniform_location>(version))
     #endif
     {
-        _transformationProjectionMatrixUniform = uniformLocation("transformationProjectionMatrix");
-        _colorUniform = uniformLocation("color");
+        #ifndef MAGNUM_TARGET_GLES2
+        if(_flags & Flag::UniformBuffers)
+            _drawOffsetUniform = uniformLocation("drawOffset");
+        else
+        #endif
+        {
+            #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+            if(_flags & Flag::Multiview) {
+                _transformationProjectionMatrixUniform = uniformLocation("transformationMatrix");
+                _viewProjectionMatricesUniform = uniformLocation("viewProjectionMatrices");
+            } else
+            #endif
+            {
+                _transformationProjectionMatrixUniform = uniformLocation("transformationProjectionMatrix");
+            }
+            _colorUniform = uniformLocation("color");
+            #ifndef MAGNUM_TARGET_GLES
+            if(_flags & Flag::BindlessTexture)
+                _textureUniform = uniformLocation("textureData");
+            #endif
+        }
     }
 
     #ifndef MAGNUM_TARGET_GLES
     if(!Context::current().isExtensionSupported<Extensions::GL::ARB::shading_language_420pack>(version))
     #endif
     {
-        if(flags & Flag::Textured) setUniform(uniformLocation("textureData"), TextureLayer);
+        if(_flags & Flag::Textured
+            #ifndef MAGNUM_TARGET_GLES
+            && !(_flags & Flag::BindlessTexture)
+            #endif
+        ) setUniform(uniformLocation("textureData"), TextureLayer);
+        #ifndef MAGNUM_TARGET_GLES2
+        if(_flags & Flag::UniformBuffers) setUniformBlockBinding(uniformBlockIndex("Draw"), DrawBufferBinding);
+        #endif
     }
 
     /* Set defaults in OpenGL ES (for desktop they are set in shader code itself) */
     #ifdef MAGNUM_TARGET_GLES
     /* Default to fully opaque white so we can see the texture */
-    if(flags & Flag::Textured) setColor(Color4(1.0f));
+    if(_flags & Flag::Textured
+        #ifndef MAGNUM_TARGET_GLES2
+        && !(_flags & Flag::UniformBuffers)
+        #endif
+    ) setColor(Color4(1.0f));
     #endif
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setDrawOffset(const UnsignedInt offset) {
+    CORRADE_ASSERT(_flags & Flag::UniformBuffers,
+        "Shaders::Flat::setDrawOffset(): the shader was not created with uniform buffers enabled", *this);
+    CORRADE_ASSERT(offset < _drawCount,
+        "Shaders::Flat::setDrawOffset(): draw offset" << offset << "is out of bounds for" << _drawCount << "draws", *this);
+    setUniform(_drawOffsetUniform, offset);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindDrawBuffer(Buffer& buffer) {
+    CORRADE_ASSERT(_flags & Flag::UniformBuffers,
+        "Shaders::Flat::bindDrawBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(Buffer::Target::Uniform, DrawBufferBinding);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindDrawBuffer(Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags & Flag::UniformBuffers,
+        "Shaders::Flat::bindDrawBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(Buffer::Target::Uniform, DrawBufferBinding, offset, size);
+    return *this;
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindVertexDataBuffer(Buffer& buffer) {
+    CORRADE_ASSERT(_flags & Flag::VertexPulling,
+        "Shaders::Flat::bindVertexDataBuffer(): the shader was not created with vertex pulling enabled", *this);
+    buffer.bind(Buffer::Target::ShaderStorage, VertexDataBinding);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindVertexLayoutBuffer(Buffer& buffer) {
+    CORRADE_ASSERT(_flags & Flag::VertexPulling,
+        "Shaders::Flat::bindVertexLayoutBuffer(): the shader was not created with vertex pulling enabled", *this);
+    buffer.bind(Buffer::Target::ShaderStorage, VertexLayoutBinding);
+    return *this;
+}
+#endif
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setViewProjectionMatrices(const MatrixTypeFor<dimensions, Float>& first, const MatrixTypeFor<dimensions, Float>& second) {
+    CORRADE_ASSERT(_flags & Flag::Multiview,
+        "Shaders::Flat::setViewProjectionMatrices(): the shader was not created with multiview enabled", *this);
+    const Math::RectangularMatrix<dimensions + 1, dimensions + 1, Float> matrices[]{first, second};
+    setUniform(_viewProjectionMatricesUniform, {matrices, 2});
+    return *this;
+}
+#endif
+
 template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setTexture(Texture2D& texture) {
     if(_flags & Flag::Textured)  texture.bind(TextureLayer);
     return *this;
 }
 
+#ifndef MAGNUM_TARGET_GLES
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setTextureHandle(const UnsignedLong handle) {
+    CORRADE_ASSERT(_flags & Flag::BindlessTexture,
+        "Shaders::Flat::setTextureHandle(): the shader was not created with bindless texture enabled", *this);
+    CORRADE_ASSERT(!(_flags & Flag::UniformBuffers),
+        "Shaders::Flat::setTextureHandle(): the shader was created with uniform buffers enabled", *this);
+    setUniformHandle(_textureUniform, handle);
+    return *this;
+}
+#endif
+
 template class Flat<2>;
 template class Flat<3>;
 
@@ -23,6 +23,10 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#ifdef BINDLESS_TEXTURE
+#extension GL_ARB_bindless_texture: require
+#endif
+
 #ifndef NEW_GLSL
 #define fragmentColor gl_FragColor
 #define texture texture2D
@@ -30,12 +34,25 @@
 #endif
 
 #ifdef TEXTURED
+#ifndef BINDLESS_TEXTURE
 #ifdef EXPLICIT_TEXTURE_LAYER
 layout(binding = 0)
 #endif
 uniform lowp sampler2D textureData;
+#elif defined(UNIFORM_BUFFERS)
+flat in highp uvec2 interpolatedTextureHandle;
+#define textureData sampler2D(interpolatedTextureHandle)
+#else
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 3, bindless_sampler)
+#else
+layout(bindless_sampler)
+#endif
+uniform lowp sampler2D textureData;
+#endif
 #endif
 
+#ifndef UNIFORM_BUFFERS
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 1)
 #endif
@@ -44,11 +61,19 @@ uniform lowp vec4 color
     = vec4(1.0)
     #endif
     ;
+#else
+flat in lowp vec4 interpolatedColor;
+#define color interpolatedColor
+#endif
 
 #ifdef TEXTURED
 in mediump vec2 interpolatedTextureCoordinates;
 #endif
 
+#ifdef VERTEX_COLOR
+in lowp vec4 interpolatedVertexColor;
+#endif
+
 #ifdef NEW_GLSL
 out lowp vec4 fragmentColor;
 #endif
@@ -58,5 +83,8 @@ void main() {
         #ifdef TEXTURED
         texture(textureData, interpolatedTextureCoordinates)*
         #endif
+        #ifdef VERTEX_COLOR
+        interpolatedVertexColor*
+        #endif
         color;
 }
@@ -34,16 +34,183 @@
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shader.h"
 #include "Magnum/Shaders/Generic.h"
 #include "Magnum/Shaders/visibility.h"
 
 namespace Magnum { namespace Shaders {
 
 namespace Implementation {
-    enum class FlatFlag: UnsignedByte { Textured = 1 << 0 };
+    enum class FlatFlag: UnsignedByte {
+        Textured = 1 << 0,
+        #ifndef MAGNUM_TARGET_GLES2
+        UniformBuffers = 1 << 1,
+        #endif
+        VertexColor = 1 << 2,
+        InstancedTransformation = 1 << 3,
+        #ifndef MAGNUM_TARGET_GLES
+        BindlessTexture = 1 << 4,
+        #endif
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        Multiview = 1 << 5,
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        VertexPulling = 1 << 6
+        #endif
+    };
     typedef Containers::EnumSet<FlatFlag> FlatFlags;
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+/**
+@brief Per-draw uniform structure for @ref Flat2D
+
+Matches the `std140` layout of the per-draw uniform block used by
+@ref Flat2D with @ref Flat2D::Flag::UniformBuffers enabled. The 3x3
+transformation matrix is stored with each column padded to four components.
+@see @ref FlatDrawUniform3D
+@requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+struct FlatDrawUniform2D {
+    /**
+     * @brief Set transformation and projection matrix
+     * @return Reference to self (for method chaining)
+     */
+    FlatDrawUniform2D& setTransformationProjectionMatrix(const Matrix3& matrix) {
+        for(std::size_t i = 0; i != 3; ++i)
+            transformationProjectionMatrix[i] = Vector4{matrix[i], 0.0f};
+        return *this;
+    }
+
+    /**
+     * @brief Set color
+     * @return Reference to self (for method chaining)
+     */
+    FlatDrawUniform2D& setColor(const Color4& color) {
+        this->color = color;
+        return *this;
+    }
+
+    #if !defined(MAGNUM_TARGET_GLES) || defined(DOXYGEN_GENERATING_OUTPUT)
+    /**
+     * @brief Set bindless texture handle
+     * @return Reference to self (for method chaining)
+     *
+     * Used only if @ref Flat::Flag::BindlessTexture is set.
+     * @requires_extension Extension @extension{ARB,bindless_texture}
+     * @requires_gl Bindless textures are not available in OpenGL ES and
+     *      WebGL.
+     */
+    FlatDrawUniform2D& setTextureHandle(UnsignedLong handle) {
+        textureHandle[0] = UnsignedInt(handle);
+        textureHandle[1] = UnsignedInt(handle >> 32);
+        return *this;
+    }
+    #endif
+
+    /** @brief Transformation and projection matrix columns */
+    Vector4 transformationProjectionMatrix[3]{
+        Vector4{1.0f, 0.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 1.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 0.0f, 1.0f, 0.0f}};
+
+    /** @brief Color */
+    Color4 color{1.0f};
+
+    /**
+     * @brief Bindless texture handle
+     *
+     * Lower and upper 32 bits. Used only if @ref Flat::Flag::BindlessTexture
+     * is set.
+     */
+    UnsignedInt textureHandle[2]{};
+
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    /* Padding to 16 bytes */
+    UnsignedInt:32;
+    UnsignedInt:32;
+    #endif
+};
+
+/**
+@brief Per-draw uniform structure for @ref Flat3D
+
+Matches the `std140` layout of the per-draw uniform block used by
+@ref Flat3D with @ref Flat3D::Flag::UniformBuffers enabled.
+@see @ref FlatDrawUniform2D
+@requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+struct FlatDrawUniform3D {
+    /**
+     * @brief Set transformation and projection matrix
+     * @return Reference to self (for method chaining)
+     */
+    FlatDrawUniform3D& setTransformationProjectionMatrix(const Matrix4& matrix) {
+        transformationProjectionMatrix = matrix;
+        return *this;
+    }
+
+    /**
+     * @brief Set color
+     * @return Reference to self (for method chaining)
+     */
+    FlatDrawUniform3D& setColor(const Color4& color) {
+        this->color = color;
+        return *this;
+    }
+
+    #if !defined(MAGNUM_TARGET_GLES) || defined(DOXYGEN_GENERATING_OUTPUT)
+    /**
+     * @brief Set bindless texture handle
+     * @return Reference to self (for method chaining)
+     *
+     * Used only if @ref Flat::Flag::BindlessTexture is set.
+     * @requires_extension Extension @extension{ARB,bindless_texture}
+     * @requires_gl Bindless textures are not available in OpenGL ES and
+     *      WebGL.
+     */
+    FlatDrawUniform3D& setTextureHandle(UnsignedLong handle) {
+        textureHandle[0] = UnsignedInt(handle);
+        textureHandle[1] = UnsignedInt(handle >> 32);
+        return *this;
+    }
+    #endif
+
+    /** @brief Transformation and projection matrix */
+    Matrix4 transformationProjectionMatrix;
+
+    /** @brief Color */
+    Color4 color{1.0f};
+
+    /**
+     * @brief Bindless texture handle
+     *
+     * Lower and upper 32 bits. Used only if @ref Flat::Flag::BindlessTexture
+     * is set.
+     */
+    UnsignedInt textureHandle[2]{};
+
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    /* Padding to 16 bytes */
+    UnsignedInt:32;
+    UnsignedInt:32;
+    #endif
+};
+
+static_assert(sizeof(FlatDrawUniform2D) == 80, "FlatDrawUniform2D doesn't match std140 layout");
+static_assert(sizeof(FlatDrawUniform3D) == 96, "FlatDrawUniform3D doesn't match std140 layout");
+
+namespace Implementation {
+    template<UnsignedInt> struct FlatDrawUniformFor;
+    template<> struct FlatDrawUniformFor<2> { typedef FlatDrawUniform2D Type; };
+    template<> struct FlatDrawUniformFor<3> { typedef FlatDrawUniform3D Type; };
+}
+#endif
+
 /**
 @brief Flat shader
 
@@ -123,6 +290,150 @@ shader.setTransformationProjectionMatrix(projectionMatrix*transformationMatrix)
 mesh.draw(shader);
 @endcode
 
+@anchor Flat-instancing
+### Instanced rendering
+
+With @ref Flag::InstancedTransformation the shader additionally reads a
+per-instance @ref TransformationMatrix attribute, which is multiplied with the
+matrix set via @ref setTransformationProjectionMatrix(). With
+@ref Flag::VertexColor the color is multiplied with the @ref Color attribute,
+which gives per-instance colors when the attribute is added as instanced:
+@code
+struct Instance {
+    Matrix4 transformation;
+    Color3 color;
+};
+Instance instanceData[] = { ... };
+
+Buffer instances;
+instances.setData(instanceData, BufferUsage::DynamicDraw);
+
+mesh.setInstanceCount(Containers::arraySize(instanceData))
+    .addVertexBufferInstanced(instances, 1, 0,
+        Shaders::Flat3D::TransformationMatrix{},
+        Shaders::Flat3D::Color{Shaders::Flat3D::Color::Components::Three});
+
+Shaders::Flat3D shader{Shaders::Flat3D::Flag::InstancedTransformation|
+                       Shaders::Flat3D::Flag::VertexColor};
+shader.setTransformationProjectionMatrix(projectionMatrix*cameraMatrix);
+
+mesh.draw(shader);
+@endcode
+
+@anchor Flat-uniform-buffers
+### Uniform buffers
+
+With @ref Flag::UniformBuffers the transformation and color are not set
+through individual uniforms but taken from an array of @ref DrawUniform
+structures in a uniform buffer, bound with @ref bindDrawBuffer(). The
+index into the array is set via @ref setDrawOffset(). If
+@extension{ARB,shader_draw_parameters} is supported, `gl_DrawIDARB` is
+added to the offset, so all meshes of a multi-draw call get their own data:
+@code
+std::vector<Shaders::FlatDrawUniform3D> draws(meshCount);
+for(std::size_t i = 0; i != meshCount; ++i) draws[i]
+    .setTransformationProjectionMatrix(projectionMatrix*transformations[i])
+    .setColor(colors[i]);
+
+Buffer drawBuffer{Buffer::TargetHint::Uniform};
+drawBuffer.setData(draws, BufferUsage::DynamicDraw);
+
+Shaders::Flat3D shader{Shaders::Flat3D::Flag::UniformBuffers, meshCount};
+shader.bindDrawBuffer(drawBuffer);
+MeshView::draw(shader, views);
+@endcode
+
+@anchor Flat-vertex-pulling
+### Programmable vertex pulling
+
+With @ref Flag::VertexPulling the shader doesn't read any vertex attributes
+from the mesh. Instead, vertex data of all meshes are put into a single
+buffer bound with @ref bindVertexDataBuffer() and the vertex shader fetches
+them using `gl_VertexID` based on a @ref VertexPullingLayout of given draw,
+bound with @ref bindVertexLayoutBuffer(). The layout is indexed the same way
+as the @ref DrawUniform, so meshes with completely different vertex layouts
+can be drawn in a single multi-draw call without switching vertex array
+objects. The mesh itself has no vertex buffers, only the count and
+optionally an index buffer:
+@code
+std::vector<Shaders::VertexPullingLayout> layouts(meshCount);
+// Interleaved position and texture coordinates
+layouts[0]
+    .setAttribute(Shaders::Flat3D::Position{}, 0, 20)
+    .setAttribute(Shaders::Flat3D::TextureCoordinates{}, 12, 20);
+// Half-float positions in a separate array after the first mesh
+layouts[1]
+    .setAttribute(Shaders::Flat3D::Position{Shaders::Flat3D::Position::DataType::HalfFloat}, firstMeshSize, 8);
+// ...
+
+Buffer vertexData{Buffer::TargetHint::ShaderStorage},
+    layoutBuffer{Buffer::TargetHint::ShaderStorage};
+vertexData.setData(data, BufferUsage::StaticDraw);
+layoutBuffer.setData(layouts, BufferUsage::StaticDraw);
+
+Mesh mesh;
+mesh.setCount(totalIndexCount)
+    .setIndexBuffer(indices, 0, Mesh::IndexType::UnsignedInt);
+std::vector<MeshView> views;
+// one view per mesh with index range and count ...
+
+Shaders::Flat3D shader{Shaders::Flat3D::Flag::UniformBuffers|
+    Shaders::Flat3D::Flag::VertexPulling|
+    Shaders::Flat3D::Flag::Textured, meshCount};
+shader.bindDrawBuffer(drawBuffer)
+    .bindVertexDataBuffer(vertexData)
+    .bindVertexLayoutBuffer(layoutBuffer);
+MeshView::draw(shader, views);
+@endcode
+
+Vertex index is taken from `gl_VertexID`, which already includes the base
+vertex of indexed draws. It's thus easiest to address each mesh using
+offsets in the layout and keep the base vertex of the views at zero. Per-draw
+data are indexed by the draw ID, so the vertex pulling needs
+@extension{ARB,shader_draw_parameters} to make use of multi-draw.
+@ref Flag::InstancedTransformation still takes the transformation from the
+mesh.
+
+@anchor Flat-bindless-textures
+### Bindless textures
+
+With @ref Flag::BindlessTexture the texture is not bound to a texture unit
+but referenced through its @ref AbstractTexture::handle() "handle", which has
+to be made resident first. Without uniform buffers the handle is set via
+@ref setTextureHandle(), with @ref Flag::UniformBuffers it's taken from
+@ref DrawUniform::textureHandle, so each draw of a multi-draw call can use a
+different texture without any binds in between:
+@code
+texture.makeResident();
+draws[i].setTextureHandle(texture.handle());
+
+Shaders::Flat3D shader{Shaders::Flat3D::Flag::Textured|
+    Shaders::Flat3D::Flag::UniformBuffers|
+    Shaders::Flat3D::Flag::BindlessTexture, meshCount};
+@endcode
+
+@anchor Flat-multiview
+### Multiview stereo rendering
+
+With @ref Flag::Multiview the shader renders to both views of a framebuffer
+with a texture array attached using @ref Framebuffer::attachTextureMultiview()
+in a single draw call. Instead of @ref setTransformationProjectionMatrix(),
+the object transformation is set via @ref setTransformationMatrix(), usually
+once per draw, and the view projection matrix of each eye via
+@ref setViewProjectionMatrices(), usually once per frame. The vertex shader
+then picks one of them based on `gl_ViewID_OVR`. Together with
+@ref SceneGraph::BasicStereoCamera3D "SceneGraph::StereoCamera3D" the transformations are relative to the head:
+@code
+void MyDrawable::draw(const Matrix4& transformationMatrix, SceneGraph::Camera3D& camera) {
+    auto& stereo = static_cast<SceneGraph::StereoCamera3D&>(camera);
+    _shader.setViewProjectionMatrices(
+            stereo.viewProjectionMatrix(SceneGraph::StereoCamera3D::Eye::Left),
+            stereo.viewProjectionMatrix(SceneGraph::StereoCamera3D::Eye::Right))
+        .setTransformationMatrix(transformationMatrix);
+    _mesh.draw(_shader);
+}
+@endcode
+
 @see @ref shaders, @ref Flat2D, @ref Flat3D
 */
 template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public AbstractShaderProgram {
@@ -143,6 +454,30 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public Abstra
          */
         typedef typename Generic<dimensions>::TextureCoordinates TextureCoordinates;
 
+        /**
+         * @brief Vertex color
+         *
+         * @ref shaders-generic "Generic attribute", @ref Color4. Used only if
+         * @ref Flag::VertexColor is set, can be either per-vertex or
+         * per-instance.
+         */
+        typedef typename Generic<dimensions>::Color Color;
+
+        /**
+         * @brief Instanced transformation matrix
+         *
+         * @ref shaders-generic "Generic attribute", @ref Matrix3 in 2D,
+         * @ref Matrix4 in 3D. Used only if @ref Flag::InstancedTransformation
+         * is set.
+         * @requires_gl33 Extension @extension{ARB,instanced_arrays}
+         * @requires_gles30 Extension @es_extension{ANGLE,instanced_arrays},
+         *      @es_extension{EXT,instanced_arrays} or
+         *      @es_extension{NV,instanced_arrays} in OpenGL ES 2.0.
+         * @requires_webgl20 Extension @webgl_extension{ANGLE,instanced_arrays}
+         *      in WebGL 1.0.
+         */
+        typedef typename Generic<dimensions>::TransformationMatrix TransformationMatrix;
+
         #ifdef DOXYGEN_GENERATING_OUTPUT
         /**
          * @brief Flag
@@ -150,7 +485,65 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public Abstra
          * @see @ref Flags, @ref flags()
          */
         enum class Flag: UnsignedByte {
-            Textured = 1 << 0   /**< The shader uses texture instead of color */
+            Textured = 1 << 0,  /**< The shader uses texture instead of color */
+
+            /**
+             * Take per-draw data from a uniform buffer instead of
+             * individual uniforms. See @ref Flat-uniform-buffers for more
+             * information.
+             * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+             * @requires_gles30 Uniform buffers are not available in OpenGL
+             *      ES 2.0.
+             * @requires_webgl20 Uniform buffers are not available in WebGL
+             *      1.0.
+             */
+            UniformBuffers = 1 << 1,
+
+            /**
+             * Multiply the color with the @ref Color attribute. See
+             * @ref Flat-instancing for more information.
+             */
+            VertexColor = 1 << 2,
+
+            /**
+             * Multiply the transformation with the per-instance
+             * @ref TransformationMatrix attribute. See @ref Flat-instancing
+             * for more information.
+             */
+            InstancedTransformation = 1 << 3,
+
+            /**
+             * Take the texture from a bindless texture handle instead of a
+             * texture unit. Has effect only if @ref Flag::Textured is set. See
+             * @ref Flat-bindless-textures for more information.
+             * @requires_extension Extension @extension{ARB,bindless_texture}
+             * @requires_gl Bindless textures are not available in OpenGL
+             *      ES and WebGL.
+             */
+            BindlessTexture = 1 << 4,
+
+            /**
+             * Render to two views at once, selecting the view projection
+             * matrix based on `gl_ViewID_OVR`. Available only in
+             * @ref Flat3D, can't be combined with @ref Flag::UniformBuffers.
+             * See @ref Flat-multiview for more information.
+             * @requires_extension Extension @extension{OVR,multiview}
+             * @requires_es_extension Extension @extension{OVR,multiview}
+             * @requires_gles Multiview is not available in WebGL.
+             */
+            Multiview = 1 << 5,
+
+            /**
+             * Fetch vertex attributes from a shader storage buffer based on
+             * a per-draw @ref VertexPullingLayout instead of taking them
+             * from the mesh. Has to be combined with
+             * @ref Flag::UniformBuffers. See @ref Flat-vertex-pulling for
+             * more information.
+             * @requires_gl43 Extension @extension{ARB,shader_storage_buffer_object}
+             * @requires_gl Vertex pulling is not available in OpenGL ES and
+             *      WebGL.
+             */
+            VertexPulling = 1 << 6
         };
 
         /**
@@ -164,11 +557,56 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public Abstra
         typedef Implementation::FlatFlags Flags;
         #endif
 
+        #if !defined(MAGNUM_TARGET_GLES2) || defined(DOXYGEN_GENERATING_OUTPUT)
+        /**
+         * @brief Per-draw uniform structure
+         *
+         * @ref FlatDrawUniform2D in 2D, @ref FlatDrawUniform3D in 3D.
+         * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        typedef typename Implementation::FlatDrawUniformFor<dimensions>::Type DrawUniform;
+        #endif
+
+        class CompileState;
+
+        /**
+         * @brief Submit compilation of the shader
+         * @param flags     Flags
+         * @param drawCount Size of the @ref DrawUniform array. Used only if
+         *      @ref Flag::UniformBuffers is set.
+         *
+         * Submits compilation and linking of the shader but doesn't wait for
+         * it to finish, so the driver can do the work in the background ---
+         * especially if @extension{KHR,parallel_shader_compile} is
+         * supported. Pass the returned value to
+         * @ref Flat(CompileState&&) to finish the construction. Use
+         * @ref AbstractShaderProgram::isLinkFinished() on the returned
+         * instance to check whether the construction would block.
+         */
+        static CompileState compile(Flags flags = {}, UnsignedInt drawCount = 1);
+
         /**
          * @brief Constructor
          * @param flags     Flags
+         * @param drawCount Size of the @ref DrawUniform array. Used only if
+         *      @ref Flag::UniformBuffers is set.
+         *
+         * Equivalent to calling @ref Flat(CompileState&&) on the result of
+         * @ref compile().
          */
-        explicit Flat(Flags flags = {});
+        explicit Flat(Flags flags = {}, UnsignedInt drawCount = 1);
+
+        /**
+         * @brief Finalize an asynchronous compilation
+         *
+         * Takes an instance returned from @ref compile(), waits for the
+         * compilation and linking to finish, if not already, and queries
+         * uniform locations.
+         */
+        explicit Flat(CompileState&& state);
 
         /**
          * @brief Construct without creating the underlying OpenGL object
@@ -185,24 +623,163 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public Abstra
         /** @brief Flags */
         Flags flags() const { return _flags; }
 
+        #if !defined(MAGNUM_TARGET_GLES2) || defined(DOXYGEN_GENERATING_OUTPUT)
+        /**
+         * @brief Draw count
+         *
+         * Size of the @ref DrawUniform array if @ref Flag::UniformBuffers
+         * is set, `1` otherwise.
+         * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        UnsignedInt drawCount() const { return _drawCount; }
+
+        /**
+         * @brief Set draw offset
+         * @return Reference to self (for method chaining)
+         *
+         * Index of the @ref DrawUniform used for the next draw. If
+         * @extension{ARB,shader_draw_parameters} is supported, the draw ID
+         * of the multi-draw is added to it. Initial value is `0`. Expects
+         * that @ref Flag::UniformBuffers is set.
+         * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Flat<dimensions>& setDrawOffset(UnsignedInt offset);
+
+        /**
+         * @brief Bind a draw uniform buffer
+         * @return Reference to self (for method chaining)
+         *
+         * The buffer is expected to contain @ref drawCount() instances of
+         * @ref DrawUniform. Expects that @ref Flag::UniformBuffers is set.
+         * @see @ref Buffer::bind(Buffer::Target, UnsignedInt)
+         * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Flat<dimensions>& bindDrawBuffer(Buffer& buffer);
+
+        /**
+         * @brief Bind a range of a draw uniform buffer
+         * @return Reference to self (for method chaining)
+         *
+         * The @p offset has to be aligned to @ref Buffer::uniformOffsetAlignment().
+         * Expects that @ref Flag::UniformBuffers is set.
+         * @see @ref Buffer::bind(Buffer::Target, UnsignedInt, GLintptr, GLsizeiptr)
+         * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Flat<dimensions>& bindDrawBuffer(Buffer& buffer, GLintptr offset, GLsizeiptr size);
+        #endif
+
+        #if !defined(MAGNUM_TARGET_GLES) || defined(DOXYGEN_GENERATING_OUTPUT)
+        /**
+         * @brief Bind a vertex data buffer
+         * @return Reference to self (for method chaining)
+         *
+         * The buffer contains vertex data of all meshes, addressed by
+         * offsets in the buffer bound with @ref bindVertexLayoutBuffer().
+         * Expects that @ref Flag::VertexPulling is set.
+         * @see @ref Buffer::bind(Buffer::Target, UnsignedInt)
+         * @requires_gl43 Extension @extension{ARB,shader_storage_buffer_object}
+         * @requires_gl Vertex pulling is not available in OpenGL ES and
+         *      WebGL.
+         */
+        Flat<dimensions>& bindVertexDataBuffer(Buffer& buffer);
+
+        /**
+         * @brief Bind a vertex layout buffer
+         * @return Reference to self (for method chaining)
+         *
+         * The buffer is expected to contain @ref drawCount() instances of
+         * @ref VertexPullingLayout, indexed the same way as the
+         * @ref DrawUniform buffer. Expects that @ref Flag::VertexPulling is
+         * set.
+         * @see @ref Buffer::bind(Buffer::Target, UnsignedInt)
+         * @requires_gl43 Extension @extension{ARB,shader_storage_buffer_object}
+         * @requires_gl Vertex pulling is not available in OpenGL ES and
+         *      WebGL.
+         */
+        Flat<dimensions>& bindVertexLayoutBuffer(Buffer& buffer);
+        #endif
+
         /**
          * @brief Set transformation and projection matrix
          * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::UniformBuffers is not set, fill
+         * @ref DrawUniform::transformationProjectionMatrix instead.
          */
         Flat<dimensions>& setTransformationProjectionMatrix(const MatrixTypeFor<dimensions, Float>& matrix) {
+            #ifndef MAGNUM_TARGET_GLES2
+            CORRADE_ASSERT(!(_flags & Flag::UniformBuffers),
+                "Shaders::Flat::setTransformationProjectionMatrix(): the shader was created with uniform buffers enabled", *this);
+            #endif
+            #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+            CORRADE_ASSERT(!(_flags & Flag::Multiview),
+                "Shaders::Flat::setTransformationProjectionMatrix(): the shader was created with multiview enabled", *this);
+            #endif
             setUniform(_transformationProjectionMatrixUniform, matrix);
             return *this;
         }
 
+        #if (!defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)) || defined(DOXYGEN_GENERATING_OUTPUT)
+        /**
+         * @brief Set transformation matrix
+         * @return Reference to self (for method chaining)
+         *
+         * Used in place of @ref setTransformationProjectionMatrix() if
+         * @ref Flag::Multiview is set, expects that the flag is set.
+         * @see @ref setViewProjectionMatrices()
+         * @requires_extension Extension @extension{OVR,multiview}
+         * @requires_es_extension Extension @extension{OVR,multiview}
+         * @requires_gles Multiview is not available in WebGL.
+         */
+        Flat<dimensions>& setTransformationMatrix(const MatrixTypeFor<dimensions, Float>& matrix) {
+            CORRADE_ASSERT(_flags & Flag::Multiview,
+                "Shaders::Flat::setTransformationMatrix(): the shader was not created with multiview enabled", *this);
+            setUniform(_transformationProjectionMatrixUniform, matrix);
+            return *this;
+        }
+
+        /**
+         * @brief Set view projection matrices of both views
+         * @return Reference to self (for method chaining)
+         *
+         * The @p first matrix is used for view `0`, the @p second for view
+         * `1`. Expects that @ref Flag::Multiview is set.
+         * @see @ref setTransformationMatrix(),
+         *      @ref SceneGraph::BasicStereoCamera3D::viewProjectionMatrix()
+         * @requires_extension Extension @extension{OVR,multiview}
+         * @requires_es_extension Extension @extension{OVR,multiview}
+         * @requires_gles Multiview is not available in WebGL.
+         */
+        Flat<dimensions>& setViewProjectionMatrices(const MatrixTypeFor<dimensions, Float>& first, const MatrixTypeFor<dimensions, Float>& second);
+        #endif
+
         /**
          * @brief Set color
          * @return Reference to self (for method chaining)
          *
          * If @ref Flag::Textured is set, default value is `{1.0f, 1.0f, 1.0f}`
-         * and the color will be multiplied with texture.
+         * and the color will be multiplied with texture. Expects that
+         * @ref Flag::UniformBuffers is not set, fill @ref DrawUniform::color
+         * instead.
          * @see @ref setTexture()
          */
         Flat<dimensions>& setColor(const Color4& color){
+            #ifndef MAGNUM_TARGET_GLES2
+            CORRADE_ASSERT(!(_flags & Flag::UniformBuffers),
+                "Shaders::Flat::setColor(): the shader was created with uniform buffers enabled", *this);
+            #endif
             setUniform(_colorUniform, color);
             return *this;
         }
@@ -216,10 +793,60 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public Abstra
          */
         Flat<dimensions>& setTexture(Texture2D& texture);
 
+        #if !defined(MAGNUM_TARGET_GLES) || defined(DOXYGEN_GENERATING_OUTPUT)
+        /**
+         * @brief Set bindless texture handle
+         * @return Reference to self (for method chaining)
+         *
+         * The texture is expected to be resident, see
+         * @ref AbstractTexture::makeResident(). Expects that
+         * @ref Flag::BindlessTexture is set and @ref Flag::UniformBuffers is
+         * not set, fill @ref DrawUniform::textureHandle instead.
+         * @requires_extension Extension @extension{ARB,bindless_texture}
+         * @requires_gl Bindless textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        Flat<dimensions>& setTextureHandle(UnsignedLong handle);
+        #endif
+
     private:
+        /* Creates the GL object but doesn't compile anything, used by
+           compile() */
+        explicit Flat(Math::NoInitT) {}
+
         Flags _flags;
+        #ifndef MAGNUM_TARGET_GLES2
+        UnsignedInt _drawCount{1};
+        #endif
         Int _transformationProjectionMatrixUniform{0},
             _colorUniform{1};
+        #ifndef MAGNUM_TARGET_GLES2
+        Int _drawOffsetUniform{2};
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        Int _textureUniform{3};
+        #endif
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        Int _viewProjectionMatricesUniform{4};
+        #endif
+};
+
+/**
+@brief Asynchronous compilation state
+
+Returned by @ref Flat::compile(), holds the shader sources until they're
+compiled and linked. Pass it to @ref Flat::Flat(CompileState&&) to finish the
+construction.
+*/
+template<UnsignedInt dimensions> class Flat<dimensions>::CompileState: public Flat<dimensions> {
+    private:
+        friend Flat;
+
+        explicit CompileState(Flat<dimensions>&& shader, Shader&& vert, Shader&& frag, Version version, bool loaded): Flat<dimensions>{std::move(shader)}, _vert{std::move(vert)}, _frag{std::move(frag)}, _version{version}, _loaded{loaded} {}
+
+        Shader _vert, _frag;
+        Version _version;
+        bool _loaded;
 };
 
 /** @brief 2D flat shader */
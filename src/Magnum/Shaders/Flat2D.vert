@@ -23,35 +23,132 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#if defined(UNIFORM_BUFFERS) && !defined(GL_ES) && defined(GL_ARB_shader_draw_parameters) && !defined(DISABLE_GL_ARB_shader_draw_parameters)
+#extension GL_ARB_shader_draw_parameters: enable
+#define SHADER_DRAW_PARAMETERS
+#endif
+
 #ifndef NEW_GLSL
 #define in attribute
 #define out varying
 #endif
 
+#ifndef UNIFORM_BUFFERS
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 0)
 #endif
 uniform highp mat3 transformationProjectionMatrix;
+#else
+struct DrawUniform {
+    highp mat3 transformationProjectionMatrix;
+    lowp vec4 color;
+    highp uvec2 textureHandle;
+};
 
+#ifdef EXPLICIT_BINDING
+layout(std140, binding = 0)
+#else
+layout(std140)
+#endif
+uniform Draw {
+    DrawUniform draws[DRAW_COUNT];
+};
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 2)
+#endif
+uniform highp uint drawOffset;
+
+flat out lowp vec4 interpolatedColor;
+
+#if defined(TEXTURED) && defined(BINDLESS_TEXTURE)
+flat out highp uvec2 interpolatedTextureHandle;
+#endif
+#endif
+
+#ifndef VERTEX_PULLING
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = POSITION_ATTRIBUTE_LOCATION)
 #endif
 in highp vec2 position;
+#else
+/* Defined in VertexPulling.glsl, which is appended after this file */
+highp vec4 fetchAttribute(highp uint drawId, int location, highp vec4 defaults);
+
+highp vec2 position;
+#endif
 
 #ifdef TEXTURED
+#ifndef VERTEX_PULLING
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = TEXTURECOORDINATES_ATTRIBUTE_LOCATION)
 #endif
 in mediump vec2 textureCoordinates;
+#else
+mediump vec2 textureCoordinates;
+#endif
 
 out mediump vec2 interpolatedTextureCoordinates;
 #endif
 
+#ifdef VERTEX_COLOR
+#ifndef VERTEX_PULLING
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = COLOR_ATTRIBUTE_LOCATION)
+#endif
+in lowp vec4 vertexColor;
+#else
+lowp vec4 vertexColor;
+#endif
+
+out lowp vec4 interpolatedVertexColor;
+#endif
+
+#ifdef INSTANCED_TRANSFORMATION
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = TRANSFORMATION_MATRIX_ATTRIBUTE_LOCATION)
+#endif
+in highp mat3 instancedTransformationMatrix;
+#endif
+
 void main() {
-    gl_Position.xywz = vec4(transformationProjectionMatrix*vec3(position, 1.0), 0.0);
+    #ifdef UNIFORM_BUFFERS
+    highp uint drawId = drawOffset
+        #ifdef SHADER_DRAW_PARAMETERS
+        + uint(gl_DrawIDARB)
+        #endif
+        ;
+    highp mat3 transformationProjectionMatrix = draws[drawId].transformationProjectionMatrix;
+    interpolatedColor = draws[drawId].color;
+    #if defined(TEXTURED) && defined(BINDLESS_TEXTURE)
+    interpolatedTextureHandle = draws[drawId].textureHandle;
+    #endif
+
+    #ifdef VERTEX_PULLING
+    /* Fetch the attributes based on the per-draw layout */
+    position = fetchAttribute(drawId, POSITION_ATTRIBUTE_LOCATION, vec4(0.0, 0.0, 0.0, 1.0)).xy;
+    #ifdef TEXTURED
+    textureCoordinates = fetchAttribute(drawId, TEXTURECOORDINATES_ATTRIBUTE_LOCATION, vec4(0.0, 0.0, 0.0, 1.0)).xy;
+    #endif
+    #ifdef VERTEX_COLOR
+    vertexColor = fetchAttribute(drawId, COLOR_ATTRIBUTE_LOCATION, vec4(0.0, 0.0, 0.0, 1.0));
+    #endif
+    #endif
+    #endif
+
+    gl_Position.xywz = vec4(transformationProjectionMatrix*
+        #ifdef INSTANCED_TRANSFORMATION
+        instancedTransformationMatrix*
+        #endif
+        vec3(position, 1.0), 0.0);
 
     #ifdef TEXTURED
     /* Texture coordinates, if needed */
     interpolatedTextureCoordinates = textureCoordinates;
     #endif
+
+    #ifdef VERTEX_COLOR
+    /* Vertex color, if needed */
+    interpolatedVertexColor = vertexColor;
+    #endif
 }
@@ -0,0 +1,133 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "GBuffer.h"
+
+#include "Magnum/Mesh.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/Shaders/DeferredLight.h"
+#include "Magnum/Shaders/Phong.h"
+
+namespace Magnum { namespace Shaders {
+
+namespace {
+    void setupTexture(Texture2D& texture, const TextureFormat format, const Vector2i& size) {
+        texture.setMinificationFilter(Sampler::Filter::Nearest)
+            .setMagnificationFilter(Sampler::Filter::Nearest)
+            .setWrapping(Sampler::Wrapping::ClampToEdge)
+            .setStorage(1, format, size);
+    }
+}
+
+GBuffer::GBuffer(const Vector2i& size): _size{size}, _framebuffer{{{}, size}} {
+    #ifndef MAGNUM_TARGET_GLES
+    setupTexture(_color, TextureFormat::R11FG11FB10F, size);
+    #else
+    setupTexture(_color, TextureFormat::RGBA8, size);
+    #endif
+    setupTexture(_albedo, TextureFormat::RGBA8, size);
+    setupTexture(_normal, TextureFormat::RGB10A2, size);
+    setupTexture(_depthStencil, TextureFormat::Depth24Stencil8, size);
+
+    _framebuffer.attachTexture(Framebuffer::ColorAttachment{0}, _color, 0)
+        .attachTexture(Framebuffer::ColorAttachment{1}, _albedo, 0)
+        .attachTexture(Framebuffer::ColorAttachment{2}, _normal, 0)
+        .attachTexture(Framebuffer::BufferAttachment::DepthStencil, _depthStencil, 0);
+}
+
+GBuffer::GBuffer(GBuffer&&) noexcept = default;
+
+GBuffer::~GBuffer() = default;
+
+GBuffer& GBuffer::operator=(GBuffer&&) noexcept = default;
+
+GBuffer& GBuffer::beginGeometryPass() {
+    _framebuffer.mapForDraw({{Phong::ColorOutput, Framebuffer::ColorAttachment{0}},
+                             {Phong::AlbedoOutput, Framebuffer::ColorAttachment{1}},
+                             {Phong::NormalOutput, Framebuffer::ColorAttachment{2}}})
+        .clear(FramebufferClear::Color|FramebufferClear::Depth|FramebufferClear::Stencil)
+        .bind();
+    return *this;
+}
+
+GBuffer& GBuffer::beginLightPass(DeferredLight& shader, const Matrix4& projectionMatrix) {
+    _framebuffer.mapForDraw({{DeferredLight::ColorOutput, Framebuffer::ColorAttachment{0}},
+                             {1, Framebuffer::DrawAttachment::None},
+                             {2, Framebuffer::DrawAttachment::None}})
+        .bind();
+
+    shader.setProjectionMatrix(projectionMatrix)
+        .setViewportSize(Vector2{_size})
+        .bindAlbedoTexture(_albedo)
+        .bindNormalTexture(_normal)
+        .bindDepthTexture(_depthStencil);
+
+    Renderer::setDepthMask(false);
+    Renderer::enable(Renderer::Feature::StencilTest);
+    Renderer::enable(Renderer::Feature::Blending);
+    Renderer::setBlendEquation(Renderer::BlendEquation::Add);
+    Renderer::setBlendFunction(Renderer::BlendFunction::One, Renderer::BlendFunction::One);
+    return *this;
+}
+
+GBuffer& GBuffer::drawLight(DeferredLight& shader, Mesh& volume, const Matrix4& transformationProjectionMatrix) {
+    /* Mark pixels with geometry inside the volume. Both faces have to be
+       rasterized. */
+    _framebuffer.clear(FramebufferClear::Stencil);
+    Renderer::setColorMask(false, false, false, false);
+    Renderer::enable(Renderer::Feature::DepthTest);
+    Renderer::disable(Renderer::Feature::FaceCulling);
+    Renderer::setStencilFunction(Renderer::StencilFunction::Always, 0, 0);
+    Renderer::setStencilOperation(Renderer::PolygonFacing::Back,
+        Renderer::StencilOperation::Keep, Renderer::StencilOperation::IncrementWrap, Renderer::StencilOperation::Keep);
+    Renderer::setStencilOperation(Renderer::PolygonFacing::Front,
+        Renderer::StencilOperation::Keep, Renderer::StencilOperation::DecrementWrap, Renderer::StencilOperation::Keep);
+    _stencilShader.setTransformationProjectionMatrix(transformationProjectionMatrix);
+    volume.draw(_stencilShader);
+
+    /* Shade the marked pixels. Drawing back faces without depth test makes
+       it work also with the camera inside the volume. */
+    Renderer::setColorMask(true, true, true, true);
+    Renderer::disable(Renderer::Feature::DepthTest);
+    Renderer::enable(Renderer::Feature::FaceCulling);
+    Renderer::setFaceCullingMode(Renderer::PolygonFacing::Front);
+    Renderer::setStencilFunction(Renderer::StencilFunction::NotEqual, 0, 0xff);
+    shader.setTransformationProjectionMatrix(transformationProjectionMatrix);
+    volume.draw(shader);
+    return *this;
+}
+
+GBuffer& GBuffer::endLightPass() {
+    Renderer::disable(Renderer::Feature::Blending);
+    Renderer::disable(Renderer::Feature::StencilTest);
+    Renderer::enable(Renderer::Feature::DepthTest);
+    Renderer::setDepthMask(true);
+    Renderer::enable(Renderer::Feature::FaceCulling);
+    Renderer::setFaceCullingMode(Renderer::PolygonFacing::Back);
+    return *this;
+}
+
+}}
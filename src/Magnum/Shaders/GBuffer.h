@@ -0,0 +1,227 @@
+#ifndef Magnum_Shaders_GBuffer_h
+#define Magnum_Shaders_GBuffer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Shaders::GBuffer
+ */
+
+#include "Magnum/configure.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/Framebuffer.h"
+#include "Magnum/Texture.h"
+#include "Magnum/Shaders/Flat.h"
+#include "Magnum/Shaders/Shaders.h"
+#include "Magnum/Shaders/visibility.h"
+
+namespace Magnum { namespace Shaders {
+
+/**
+@brief G-buffer for deferred shading
+
+Owns the textures and framebuffer for deferred shading with @ref Phong and
+@ref DeferredLight and sets up the state for the geometry and light passes.
+With deferred shading, the cost of lighting doesn't depend on overdraw and
+each light shades only the pixels inside its volume. The buffer consists of:
+
+-   @ref colorTexture() --- light accumulation, @ref TextureFormat::R11FG11FB10F
+    on desktop GL to allow values over @f$ 1.0 @f$ in 32 bits per pixel,
+    @ref TextureFormat::RGBA8 in OpenGL ES, as floating-point formats are not
+    renderable there without an extension. Filled with the ambient color in
+    the geometry pass.
+-   @ref albedoTexture() --- diffuse color and specular intensity in
+    @ref TextureFormat::RGBA8
+-   @ref normalTexture() --- octahedral-encoded view-space normal and
+    shininess in @ref TextureFormat::RGB10A2
+-   @ref depthStencilTexture() --- depth and stencil in
+    @ref TextureFormat::Depth24Stencil8, used for reconstructing the position
+    and for stencil culling of the light volumes
+
+I.e., 16 bytes per pixel with the depth. All textures have nearest filtering
+and are meant to be used only at the same size as the buffer.
+
+## Usage
+
+Draw all opaque geometry with @ref Phong created with
+@ref Phong::Flag::GBufferOutput after calling @ref beginGeometryPass(), then
+draw a light volume for each light with @ref drawLight() between
+@ref beginLightPass() and @ref endLightPass(). The light volume has to enclose
+the light range, for example a @ref Primitives::Icosphere with a few
+subdivisions scaled slightly above the range to compensate for the
+tessellation. Finally, blit the color to the default framebuffer or use it
+for post-processing.
+@code
+Shaders::GBuffer gbuffer{defaultFramebuffer.viewport().size()};
+Shaders::Phong phong{Shaders::Phong::Flag::GBufferOutput};
+Shaders::DeferredLight light;
+
+Mesh sphere;
+std::unique_ptr<Buffer> sphereVertices, sphereIndices;
+std::tie(sphere, sphereVertices, sphereIndices) = MeshTools::compile(Primitives::Icosphere::solid(2), BufferUsage::StaticDraw);
+
+void MyApplication::drawEvent() {
+    gbuffer.beginGeometryPass();
+    camera->draw(drawables);
+
+    gbuffer.beginLightPass(light, camera->projectionMatrix());
+    for(const PointLight& l: lights) {
+        light.setLightPosition(l.viewPosition)
+            .setLightRange(l.range)
+            .setLightColor(l.color);
+        gbuffer.drawLight(light, sphere, camera->projectionMatrix()*
+            Matrix4::translation(l.viewPosition)*Matrix4::scaling(Vector3{l.range*1.1f}));
+    }
+    gbuffer.endLightPass();
+
+    Framebuffer::blit(gbuffer.framebuffer(), defaultFramebuffer,
+        gbuffer.framebuffer().viewport(), FramebufferBlit::Color);
+
+    // ...
+}
+@endcode
+
+@anchor GBuffer-stencil-culling
+## Stencil culling
+
+Each light volume is first drawn into the stencil buffer with color writes
+disabled, incrementing the stencil value for back faces that fail the depth
+test and decrementing it for front faces that fail the depth test. Only
+pixels whose geometry lies inside the volume end up with non-zero stencil
+value, which works also when the camera is inside the volume. The volume is
+then drawn again with @ref DeferredLight, culling front faces and passing
+only the pixels with non-zero stencil value.
+
+The depth texture is sampled by @ref DeferredLight while attached to the
+framebuffer. Depth writes are disabled for the whole light pass, so the
+texture is never written while being read.
+
+@requires_gl30 Extension @extension{EXT,gpu_shader4},
+    @extension{ARB,framebuffer_object} and @extension{EXT,packed_float}
+@requires_gles30 Multiple fragment shader outputs are not available in OpenGL
+    ES 2.0.
+@requires_webgl20 Multiple fragment shader outputs are not available in WebGL
+    1.0.
+@see @ref Phong-gbuffer
+*/
+class MAGNUM_SHADERS_EXPORT GBuffer {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Allocates the textures and the framebuffer.
+         */
+        explicit GBuffer(const Vector2i& size);
+
+        /** @brief Copying is not allowed */
+        GBuffer(const GBuffer&) = delete;
+
+        /** @brief Move constructor */
+        GBuffer(GBuffer&&) noexcept;
+
+        ~GBuffer();
+
+        /** @brief Copying is not allowed */
+        GBuffer& operator=(const GBuffer&) = delete;
+
+        /** @brief Move assignment */
+        GBuffer& operator=(GBuffer&&) noexcept;
+
+        /** @brief Size */
+        Vector2i size() const { return _size; }
+
+        /** @brief Light accumulation texture */
+        Texture2D& colorTexture() { return _color; }
+
+        /** @brief Albedo texture */
+        Texture2D& albedoTexture() { return _albedo; }
+
+        /** @brief Normal texture */
+        Texture2D& normalTexture() { return _normal; }
+
+        /** @brief Depth and stencil texture */
+        Texture2D& depthStencilTexture() { return _depthStencil; }
+
+        /** @brief Framebuffer */
+        Framebuffer& framebuffer() { return _framebuffer; }
+
+        /**
+         * @brief Begin the geometry pass
+         * @return Reference to self (for method chaining)
+         *
+         * Maps @ref Phong::ColorOutput, @ref Phong::AlbedoOutput and
+         * @ref Phong::NormalOutput to the textures, clears all of them and
+         * binds the framebuffer for drawing. All color textures are cleared
+         * with the current clear color, albedo and normal of pixels without
+         * any geometry are never read.
+         */
+        GBuffer& beginGeometryPass();
+
+        /**
+         * @brief Begin the light pass
+         * @return Reference to self (for method chaining)
+         *
+         * Maps only the @ref colorTexture() for drawing, binds the G-buffer
+         * textures to @p shader, sets the projection matrix and viewport size
+         * on it, enables additive blending, stencil test and disables depth
+         * writes.
+         */
+        GBuffer& beginLightPass(DeferredLight& shader, const Matrix4& projectionMatrix);
+
+        /**
+         * @brief Draw a light volume
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref beginLightPass() was called with the same
+         * shader. The @p transformationProjectionMatrix transforms @p volume
+         * to enclose the light range, light properties are expected to be
+         * already set on @p shader. See @ref GBuffer-stencil-culling
+         * for more information.
+         */
+        GBuffer& drawLight(DeferredLight& shader, Mesh& volume, const Matrix4& transformationProjectionMatrix);
+
+        /**
+         * @brief End the light pass
+         * @return Reference to self (for method chaining)
+         *
+         * Disables blending and stencil test, enables depth test, depth
+         * writes and back face culling.
+         */
+        GBuffer& endLightPass();
+
+    private:
+        Vector2i _size;
+        Texture2D _color, _albedo, _normal, _depthStencil;
+        Framebuffer _framebuffer;
+        Flat3D _stencilShader;
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 build
+#endif
+
+#endif
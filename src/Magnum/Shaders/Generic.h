@@ -67,6 +67,32 @@ template<UnsignedInt dimensions> struct Generic {
      */
     typedef Attribute<2, Vector3> Normal;
 
+    /**
+     * @brief Octahedral vertex normal
+     *
+     * @ref Vector2, defined only in 3D. Occupies the same location as
+     * @ref Normal, meant for normals quantized with
+     * @ref MeshTools::quantizeNormalsOctahedral() and passed as normalized
+     * @ref Attribute::DataType::Short. Used by shaders with an
+     * `OctahedralNormal` flag, which decode them back to a direction.
+     */
+    typedef Attribute<2, Vector2> OctahedralNormal;
+
+    /**
+     * @brief Packed vertex normal
+     *
+     * @ref Vector4, defined only in 3D. Occupies the same location as
+     * @ref Normal, meant for normals quantized with
+     * @ref MeshTools::quantizeNormalsPacked() and passed as normalized
+     * @ref Attribute::DataType::Int2101010Rev. The shaders read only the
+     * first three components, so no special flag is needed.
+     * @requires_gl33 Extension @extension{ARB,vertex_type_2_10_10_10_rev}
+     * @requires_gles30 Packed attributes are not available in OpenGL ES
+     *      2.0.
+     * @requires_webgl20 Packed attributes are not available in WebGL 1.0.
+     */
+    typedef Attribute<2, Vector4> PackedNormal;
+
     /**
      * @brief Vertex color
      *
@@ -89,6 +115,63 @@ template<UnsignedInt dimensions> struct Generic {
         CORRADE_DEPRECATED("use Color(Components, DataType, DataOptions) instead") constexpr explicit Color(DataType dataType = DataType::Float, DataOptions dataOptions = {});
         #endif
     };
+
+    /**
+     * @brief Instanced transformation matrix
+     *
+     * @ref Matrix3 in 2D and @ref Matrix4 in 3D, occupies locations `8`
+     * to `10` in 2D and `8` to `11` in 3D. Meant to be added with
+     * @ref Mesh::addVertexBufferInstanced(), used by shaders with an
+     * `InstancedTransformation` flag.
+     */
+    typedef Attribute<8, T> TransformationMatrix;
+
+    /**
+     * @brief Instanced normal matrix
+     *
+     * @ref Matrix3x3, defined only in 3D, occupies locations `12` to `14`.
+     * Meant to be added with @ref Mesh::addVertexBufferInstanced(), used
+     * by shaders with an `InstancedTransformation` flag.
+     */
+    typedef Attribute<12, Matrix3x3> NormalMatrix;
+
+    /**
+     * @brief Joint indices
+     *
+     * @ref Vector4ui, defined only in 3D. Indices of up to four joints
+     * influencing the vertex, used by shaders with a `Skinned` flag.
+     * @requires_gl30 Extension @extension{EXT,gpu_shader4}
+     * @requires_gles30 Integer attributes are not available in OpenGL ES
+     *      2.0.
+     * @requires_webgl20 Integer attributes are not available in WebGL 1.0.
+     */
+    typedef Attribute<6, Vector4ui> JointIds;
+
+    /**
+     * @brief Transformation ID
+     *
+     * @ref Magnum::UnsignedInt "UnsignedInt", defined only in 3D. Index
+     * into an array of transformations, filled by
+     * @ref MeshTools::StaticBatch with
+     * @ref MeshTools::StaticBatch::Flag::TransformationIds so meshes
+     * merged into a single batch can still be moved independently. None of
+     * the builtin shaders use it, occupies the same location as
+     * shader-specific attributes such as
+     * @ref InstancedVector::GlyphPosition.
+     * @requires_gl30 Extension @extension{EXT,gpu_shader4}
+     * @requires_gles30 Integer attributes are not available in OpenGL ES
+     *      2.0.
+     * @requires_webgl20 Integer attributes are not available in WebGL 1.0.
+     */
+    typedef Attribute<4, UnsignedInt> TransformationId;
+
+    /**
+     * @brief Joint weights
+     *
+     * @ref Vector4, defined only in 3D. Weights of joints in @ref JointIds,
+     * used by shaders with a `Skinned` flag.
+     */
+    typedef Attribute<7, Vector4> JointWeights;
 };
 #endif
 
@@ -113,11 +196,21 @@ struct BaseGeneric {
 
 template<> struct Generic<2>: BaseGeneric {
     typedef Attribute<0, Vector2> Position;
+    typedef Attribute<8, Matrix3> TransformationMatrix;
 };
 
 template<> struct Generic<3>: BaseGeneric {
     typedef Attribute<0, Vector3> Position;
     typedef Attribute<2, Vector3> Normal;
+    typedef Attribute<2, Vector2> OctahedralNormal;
+    typedef Attribute<2, Vector4> PackedNormal;
+    typedef Attribute<8, Matrix4> TransformationMatrix;
+    typedef Attribute<12, Matrix3x3> NormalMatrix;
+    #ifndef MAGNUM_TARGET_GLES2
+    typedef Attribute<4, UnsignedInt> TransformationId;
+    typedef Attribute<6, Vector4ui> JointIds;
+    #endif
+    typedef Attribute<7, Vector4> JointWeights;
 };
 #endif
 
@@ -51,6 +51,8 @@ inline Shader createCompatibilityShader(const Utility::Resource& rs, Version ver
         shader.addSource("#define DISABLE_GL_ARB_shading_language_420pack\n");
     if(Context::current().isExtensionDisabled<Extensions::GL::ARB::explicit_uniform_location>(version))
         shader.addSource("#define DISABLE_GL_ARB_explicit_uniform_location\n");
+    if(Context::current().isExtensionDisabled<Extensions::GL::ARB::shader_draw_parameters>(version))
+        shader.addSource("#define DISABLE_GL_ARB_shader_draw_parameters\n");
     #endif
 
     /* My Android emulator (running on NVidia) doesn't define GL_ES
@@ -0,0 +1,130 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "InstanceCulling.h"
+
+#include <Corrade/Utility/Resource.h>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/Shader.h"
+#include "Magnum/Texture.h"
+#include "Magnum/Math/Frustum.h"
+
+#include "Implementation/CreateCompatibilityShader.h"
+
+namespace Magnum { namespace Shaders {
+
+namespace {
+    enum: Int {
+        HierarchicalZTextureLayer = 0
+    };
+
+    enum: UnsignedInt {
+        BoundsBinding = 0,
+        VisibleInstanceBinding = 1,
+        CommandBinding = 2
+    };
+}
+
+InstanceCulling::InstanceCulling(const Flags flags): _flags{flags} {
+    MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::ARB::compute_shader);
+    MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::ARB::shader_storage_buffer_object);
+
+    #ifdef MAGNUM_BUILD_STATIC
+    /* Import resources on static build, if not already */
+    if(!Utility::Resource::hasGroup("MagnumShaders"))
+        importShaderResources();
+    #endif
+    Utility::Resource rs("MagnumShaders");
+
+    const Version version = Context::current().supportedVersion({Version::GL430, Version::GL420});
+
+    Shader comp = Implementation::createCompatibilityShader(rs, version, Shader::Type::Compute);
+    comp.addSource(version < Version::GL430 ?
+            "#extension GL_ARB_compute_shader: require\n"
+            "#extension GL_ARB_shader_storage_buffer_object: require\n" : "")
+        .addSource(flags & Flag::HierarchicalZ ? "#define HIERARCHICAL_Z\n" : "")
+        .addSource(flags & Flag::DrawArraysCommands ? "#define COMMAND_SIZE 4\n" : "#define COMMAND_SIZE 5\n")
+        .addSource(rs.get("InstanceCulling.comp"));
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(compileAndLink({comp}));
+
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_uniform_location>(version)) {
+        _transformationProjectionMatrixUniform = uniformLocation("transformationProjectionMatrix");
+        _frustumPlanesUniform = uniformLocation("frustumPlanes");
+        _instanceCountUniform = uniformLocation("instanceCount");
+    }
+
+    /* Texture and storage buffer bindings are set in the shader code itself,
+       as GLSL 4.20 is guaranteed by ARB_compute_shader */
+}
+
+InstanceCulling& InstanceCulling::setTransformationProjectionMatrix(const Matrix4& matrix) {
+    /* Normalize the planes so the sphere test can use the distance directly */
+    const Frustum frustum = Frustum::fromMatrix(matrix);
+    Vector4 planes[6];
+    for(std::size_t i = 0; i != 6; ++i)
+        planes[i] = frustum[i]/frustum[i].xyz().length();
+
+    setUniform(_transformationProjectionMatrixUniform, matrix);
+    setUniform(_frustumPlanesUniform, Containers::ArrayView<const Vector4>{planes});
+    return *this;
+}
+
+InstanceCulling& InstanceCulling::bindBoundsBuffer(Buffer& buffer) {
+    buffer.bind(Buffer::Target::ShaderStorage, BoundsBinding);
+    return *this;
+}
+
+InstanceCulling& InstanceCulling::bindCommandBuffer(Buffer& buffer) {
+    buffer.bind(Buffer::Target::ShaderStorage, CommandBinding);
+    return *this;
+}
+
+InstanceCulling& InstanceCulling::bindVisibleInstanceBuffer(Buffer& buffer) {
+    buffer.bind(Buffer::Target::ShaderStorage, VisibleInstanceBinding);
+    return *this;
+}
+
+InstanceCulling& InstanceCulling::bindHierarchicalZTexture(Texture2D& texture) {
+    CORRADE_ASSERT(_flags & Flag::HierarchicalZ,
+        "Shaders::InstanceCulling::bindHierarchicalZTexture(): the shader was not created with hierarchical Z enabled", *this);
+    texture.bind(HierarchicalZTextureLayer);
+    return *this;
+}
+
+InstanceCulling& InstanceCulling::cull(const UnsignedInt instanceCount) {
+    setUniform(_instanceCountUniform, instanceCount);
+    dispatchCompute({(instanceCount + WorkgroupSize - 1)/WorkgroupSize, 1, 1});
+    Renderer::setMemoryBarrier(Renderer::MemoryBarrier::Command|
+                               Renderer::MemoryBarrier::VertexAttributeArray|
+                               Renderer::MemoryBarrier::ShaderStorage);
+    return *this;
+}
+
+}}
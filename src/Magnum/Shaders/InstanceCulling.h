@@ -0,0 +1,251 @@
+#ifndef Magnum_Shaders_InstanceCulling_h
+#define Magnum_Shaders_InstanceCulling_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Shaders::InstanceCulling, struct @ref Magnum::Shaders::InstanceCullingBounds
+ */
+
+#include "Magnum/configure.h"
+
+#ifndef MAGNUM_TARGET_GLES
+#include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Shaders/visibility.h"
+
+namespace Magnum { namespace Shaders {
+
+/**
+@brief Per-instance bounds for @ref InstanceCulling
+
+Matches the `std430` layout of the bounds buffer used by
+@ref InstanceCulling.
+@requires_gl43 Extension @extension{ARB,compute_shader} and
+    @extension{ARB,shader_storage_buffer_object}
+@requires_gl Indirect drawing is not available in OpenGL ES or WebGL.
+*/
+struct InstanceCullingBounds {
+    /** @brief Bounding sphere center in world space */
+    Vector3 center;
+
+    /** @brief Bounding sphere radius */
+    Float radius;
+
+    /** @brief Index of the indirect draw command drawing this instance */
+    UnsignedInt command;
+
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    /* Padding to 16 bytes */
+    UnsignedInt:32;
+    UnsignedInt:32;
+    UnsignedInt:32;
+    #endif
+};
+
+static_assert(sizeof(InstanceCullingBounds) == 32, "InstanceCullingBounds doesn't match std430 layout");
+
+/**
+@brief GPU instance culling
+
+Compute shader testing per-instance bounding spheres against the camera
+frustum and optionally against a hierarchical depth buffer built by
+@ref DepthPyramid. Indices of instances that passed are compacted into a
+buffer and the instance counts in an indirect draw command buffer are
+incremented atomically, so the result can be drawn with
+@ref Mesh::drawIndirect() without any readback to the CPU.
+
+## Example usage
+
+The shader uses three shader storage buffers:
+
+-   Array of @ref InstanceCullingBounds, one for each instance, bound with
+    @ref bindBoundsBuffer()
+-   Array of @ref Mesh::DrawElementsIndirectCommand (or
+    @ref Mesh::DrawArraysIndirectCommand with @ref Flag::DrawArraysCommands),
+    bound with @ref bindCommandBuffer(). Each instance is drawn by the
+    command given by @ref InstanceCullingBounds::command. The
+    @cpp instanceCount @ce fields are expected to be zero before culling
+    and each command gets its output range starting at its
+    @cpp baseInstance @ce.
+-   Array of @ref UnsignedInt, bound with @ref bindVisibleInstanceBuffer().
+    Large enough to contain the output ranges of all commands.
+
+Bind the visible instance buffer as an instanced vertex attribute with
+divisor @cpp 1 @ce --- as the base instance of each command is applied to
+instanced attributes, each instance then fetches index of the visible
+instance it should draw:
+@code
+Buffer bounds, commands, visibleInstances;
+// fill bounds and commands, allocate visibleInstances ...
+
+Shaders::InstanceCulling culling;
+culling.setTransformationProjectionMatrix(projectionMatrix*cameraMatrix)
+    .bindBoundsBuffer(bounds)
+    .bindCommandBuffer(commands)
+    .bindVisibleInstanceBuffer(visibleInstances)
+    .cull(instanceCount);
+
+mesh.drawIndirect(shader, commands, 0, commandCount);
+@endcode
+
+The @ref cull() function issues memory barriers making the results visible
+to subsequent indirect draws and vertex attribute fetches.
+
+## Occlusion culling
+
+With @ref Flag::HierarchicalZ the instances are also tested against a depth
+pyramid of a previous frame, passed via @ref bindHierarchicalZTexture(). The
+screen-space bounding rectangle of each instance is compared against four
+texels of the pyramid level at which the rectangle covers at most two texels
+in each direction. Instances closer to the camera than the farthest depth
+there are drawn. See @ref DepthPyramid for how to build the pyramid.
+
+@requires_gl43 Extension @extension{ARB,compute_shader} and
+    @extension{ARB,shader_storage_buffer_object}
+@requires_gl Indirect drawing is not available in OpenGL ES or WebGL.
+*/
+class MAGNUM_SHADERS_EXPORT InstanceCulling: public AbstractShaderProgram {
+    public:
+        enum: UnsignedInt {
+            /** Workgroup size. Each workgroup processes this many instances. */
+            WorkgroupSize = 64
+        };
+
+        /**
+         * @brief Flag
+         *
+         * @see @ref Flags, @ref flags()
+         */
+        enum class Flag: UnsignedByte {
+            /**
+             * Test the instances also against a hierarchical depth buffer.
+             * See the class documentation for more information.
+             */
+            HierarchicalZ = 1 << 0,
+
+            /**
+             * The command buffer contains
+             * @ref Mesh::DrawArraysIndirectCommand instead of
+             * @ref Mesh::DrawElementsIndirectCommand.
+             */
+            DrawArraysCommands = 1 << 1
+        };
+
+        /**
+         * @brief Flags
+         *
+         * @see @ref flags()
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+
+        /**
+         * @brief Constructor
+         * @param flags     Flags
+         */
+        explicit InstanceCulling(Flags flags = {});
+
+        /**
+         * @brief Construct without creating the underlying OpenGL object
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         *
+         * This function can be safely used for constructing (and later
+         * destructing) objects even without any OpenGL context being active.
+         */
+        explicit InstanceCulling(NoCreateT) noexcept: AbstractShaderProgram{NoCreate} {}
+
+        /** @brief Flags */
+        Flags flags() const { return _flags; }
+
+        /**
+         * @brief Set transformation and projection matrix
+         * @return Reference to self (for method chaining)
+         *
+         * Matrix transforming the instance bounds to clip space, usually
+         * projection matrix multiplied with the camera matrix. The frustum
+         * planes are extracted on the CPU.
+         */
+        InstanceCulling& setTransformationProjectionMatrix(const Matrix4& matrix);
+
+        /**
+         * @brief Bind a bounds buffer
+         * @return Reference to self (for method chaining)
+         *
+         * The buffer is expected to contain @ref InstanceCullingBounds for
+         * all instances.
+         */
+        InstanceCulling& bindBoundsBuffer(Buffer& buffer);
+
+        /**
+         * @brief Bind an indirect draw command buffer
+         * @return Reference to self (for method chaining)
+         */
+        InstanceCulling& bindCommandBuffer(Buffer& buffer);
+
+        /**
+         * @brief Bind a visible instance buffer
+         * @return Reference to self (for method chaining)
+         */
+        InstanceCulling& bindVisibleInstanceBuffer(Buffer& buffer);
+
+        /**
+         * @brief Bind a hierarchical depth texture
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::HierarchicalZ is set. The texture is
+         * expected to have nearest mipmap filtering, see @ref DepthPyramid
+         * for more information.
+         */
+        InstanceCulling& bindHierarchicalZTexture(Texture2D& texture);
+
+        /**
+         * @brief Cull instances
+         *
+         * Dispatches the culling for @p instanceCount instances and
+         * issues memory barriers for @ref Renderer::MemoryBarrier::Command,
+         * @ref Renderer::MemoryBarrier::VertexAttributeArray and
+         * @ref Renderer::MemoryBarrier::ShaderStorage.
+         * @see @ref dispatchCompute(), @ref Renderer::setMemoryBarrier()
+         */
+        InstanceCulling& cull(UnsignedInt instanceCount);
+
+    private:
+        Flags _flags;
+        Int _transformationProjectionMatrixUniform{0},
+            _frustumPlanesUniform{1},
+            _instanceCountUniform{7};
+};
+
+CORRADE_ENUMSET_OPERATORS(InstanceCulling::Flags)
+
+}}
+#else
+#error this header is not available in OpenGL ES build
+#endif
+
+#endif
@@ -0,0 +1,185 @@
+#ifndef Magnum_Shaders_InstancedVector_h
+#define Magnum_Shaders_InstancedVector_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Shaders::InstancedVector, typedef @ref Magnum::Shaders::InstancedVector2D, @ref Magnum::Shaders::InstancedVector3D
+ */
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shaders/AbstractVector.h"
+#include "Magnum/Shaders/visibility.h"
+
+namespace Magnum { namespace Shaders {
+
+/**
+@brief Instanced vector shader
+
+Similar to @ref Vector, but instead of a list of textured quads it expects a
+single unit quad with @ref Corner attribute and per-instance
+@ref GlyphPosition, @ref GlyphTextureCoordinates and @ref Color attributes,
+expanding the quad in the vertex shader. Used by @ref Text::InstancedRenderer,
+which greatly reduces amount of data generated and uploaded for each rendered
+glyph. You need to call at least @ref setTransformationProjectionMatrix() and
+@ref setVectorTexture().
+
+## Example usage
+
+@code
+struct Instance {
+    Range2D position, textureCoordinates;
+    Color4 color;
+};
+std::vector<Instance> data;
+
+Buffer corners, indices, instances;
+corners.setData({
+    Vector2{0.0f, 1.0f}, Vector2{0.0f, 0.0f}, Vector2{1.0f, 1.0f}, Vector2{1.0f, 0.0f}
+}, BufferUsage::StaticDraw);
+indices.setData({UnsignedByte(0), 1, 2, 1, 3, 2}, BufferUsage::StaticDraw);
+instances.setData(data, BufferUsage::DynamicDraw);
+
+Mesh mesh;
+mesh.setCount(6)
+    .setInstanceCount(data.size())
+    .setIndexBuffer(indices, 0, Mesh::IndexType::UnsignedByte)
+    .addVertexBuffer(corners, 0, Shaders::InstancedVector2D::Corner{})
+    .addVertexBufferInstanced(instances, 1, 0,
+        Shaders::InstancedVector2D::GlyphPosition{},
+        Shaders::InstancedVector2D::GlyphTextureCoordinates{},
+        Shaders::InstancedVector2D::Color{Shaders::InstancedVector2D::Color::Components::Four});
+
+Shaders::InstancedVector2D shader;
+shader.setTransformationProjectionMatrix(projectionMatrix*transformationMatrix)
+    .setVectorTexture(texture);
+mesh.draw(shader);
+@endcode
+
+@requires_gl33 Extension @extension{ARB,instanced_arrays}
+@requires_gles30 Extension @es_extension{ANGLE,instanced_arrays},
+    @es_extension{EXT,instanced_arrays} or
+    @es_extension{NV,instanced_arrays} in OpenGL ES 2.0.
+@requires_webgl20 Extension @webgl_extension{ANGLE,instanced_arrays} in
+    WebGL 1.0.
+
+@see @ref shaders, @ref InstancedVector2D, @ref InstancedVector3D
+*/
+template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT InstancedVector: public AbstractVector<dimensions> {
+    public:
+        /**
+         * @brief Quad corner
+         *
+         * @ref Vector2, per-vertex. Bottom left corner of the quad is
+         * @cpp {0.0f, 0.0f} @ce, top right @cpp {1.0f, 1.0f} @ce.
+         */
+        typedef Attribute<0, Vector2> Corner;
+
+        /**
+         * @brief Glyph position
+         *
+         * @ref Vector4, per-instance. Bottom left corner of the glyph quad in
+         * first two components, top right corner in the other two, i.e. the
+         * same layout as @ref Range2D.
+         */
+        typedef Attribute<4, Vector4> GlyphPosition;
+
+        /**
+         * @brief Glyph texture coordinates
+         *
+         * @ref Vector4, per-instance. Same layout as @ref GlyphPosition.
+         */
+        typedef Attribute<5, Vector4> GlyphTextureCoordinates;
+
+        /**
+         * @brief Glyph color
+         *
+         * @ref shaders-generic "Generic attribute", @ref Color4, per-instance.
+         */
+        typedef typename Generic<dimensions>::Color Color;
+
+        explicit InstancedVector();
+
+        /**
+         * @brief Construct without creating the underlying OpenGL object
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         *
+         * This function can be safely used for constructing (and later
+         * destructing) objects even without any OpenGL context being active.
+         */
+        explicit InstancedVector(NoCreateT) noexcept
+            #ifndef DOXYGEN_GENERATING_OUTPUT
+            : AbstractVector<dimensions>{NoCreate}
+            #endif
+            {}
+
+        /**
+         * @brief Set transformation and projection matrix
+         * @return Reference to self (for method chaining)
+         */
+        InstancedVector<dimensions>& setTransformationProjectionMatrix(const MatrixTypeFor<dimensions, Float>& matrix) {
+            AbstractShaderProgram::setUniform(_transformationProjectionMatrixUniform, matrix);
+            return *this;
+        }
+
+        /**
+         * @brief Set background color
+         * @return Reference to self (for method chaining)
+         *
+         * Default is transparent black.
+         */
+        InstancedVector<dimensions>& setBackgroundColor(const Color4& color) {
+            AbstractShaderProgram::setUniform(_backgroundColorUniform, color);
+            return *this;
+        }
+
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        /* Overloads to remove WTF-factor from method chaining order */
+        InstancedVector<dimensions>& setVectorTexture(Texture2D& texture) {
+            AbstractVector<dimensions>::setVectorTexture(texture);
+            return *this;
+        }
+        #endif
+
+    private:
+        Int _transformationProjectionMatrixUniform{0},
+            _backgroundColorUniform{1};
+};
+
+/** @brief Two-dimensional instanced vector shader */
+typedef InstancedVector<2> InstancedVector2D;
+
+/** @brief Three-dimensional instanced vector shader */
+typedef InstancedVector<3> InstancedVector3D;
+
+}}
+
+#endif
@@ -0,0 +1,70 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef NEW_GLSL
+#define in attribute
+#define out varying
+#endif
+
+#define CORNER_ATTRIBUTE_LOCATION 0
+#define GLYPH_POSITION_ATTRIBUTE_LOCATION 4
+#define GLYPH_TEXTURECOORDINATES_ATTRIBUTE_LOCATION 5
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 0)
+#endif
+uniform highp mat4 transformationProjectionMatrix;
+
+/* Per-vertex quad corner, (0, 0) is bottom left, (1, 1) is top right */
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = CORNER_ATTRIBUTE_LOCATION)
+#endif
+in highp vec2 corner;
+
+/* Per-instance glyph rectangle, bottom left corner in xy, top right in zw */
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = GLYPH_POSITION_ATTRIBUTE_LOCATION)
+#endif
+in highp vec4 glyphPosition;
+
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = GLYPH_TEXTURECOORDINATES_ATTRIBUTE_LOCATION)
+#endif
+in mediump vec4 glyphTextureCoordinates;
+
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = COLOR_ATTRIBUTE_LOCATION)
+#endif
+in lowp vec4 color;
+
+out mediump vec2 fragmentTextureCoordinates;
+out lowp vec4 interpolatedColor;
+
+void main() {
+    highp vec2 position = mix(glyphPosition.xy, glyphPosition.zw, corner);
+    gl_Position = transformationProjectionMatrix*vec4(position, 0.0, 1.0);
+    fragmentTextureCoordinates = mix(glyphTextureCoordinates.xy, glyphTextureCoordinates.zw, corner);
+    interpolatedColor = color;
+}
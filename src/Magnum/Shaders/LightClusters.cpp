@@ -0,0 +1,153 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "LightClusters.h"
+
+#include <cmath>
+#include <utility>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace Shaders {
+
+LightClusters::LightClusters(const Vector3ui& count): _count{count}, _near{}, _far{} {
+    CORRADE_ASSERT(count.product(),
+        "Shaders::LightClusters: expected non-zero cluster count, got" << count, );
+}
+
+LightClusters& LightClusters::setPerspective(const Rad fov, const Float aspectRatio, const Float near, const Float far) {
+    CORRADE_ASSERT(near > 0.0f && far > near,
+        "Shaders::LightClusters::setPerspective(): expected 0 < near < far, got" << near << "and" << far, *this);
+
+    _near = near;
+    _far = far;
+    _projection = Matrix4::perspectiveProjection(fov, aspectRatio, near, far);
+    return *this;
+}
+
+Vector2 LightClusters::depthSliceParameters() const {
+    const Float logRange = std::log(_far/_near);
+    return {Float(_count.z())/logRange, -Float(_count.z())*std::log(_near)/logRange};
+}
+
+namespace {
+
+/* Clamped cluster coordinate of given position in the [0, 1] range */
+inline UnsignedInt clusterCoordinate(const Float position, const UnsignedInt count) {
+    return UnsignedInt(Math::clamp(position*count, 0.0f, Float(count - 1)));
+}
+
+inline UnsignedInt depthSlice(const Float distance, const Vector2& parameters, const UnsignedInt count) {
+    return UnsignedInt(Math::clamp(std::log(distance)*parameters.x() + parameters.y(), 0.0f, Float(count - 1)));
+}
+
+}
+
+Vector3ui LightClusters::cluster(const Vector3& position) const {
+    const Vector2 ndc = _projection.transformPoint(position).xy()*0.5f + Vector2{0.5f};
+    return {clusterCoordinate(ndc.x(), _count.x()),
+            clusterCoordinate(ndc.y(), _count.y()),
+            depthSlice(Math::max(-position.z(), _near), depthSliceParameters(), _count.z())};
+}
+
+LightClusters& LightClusters::bin(const Containers::ArrayView<const ClusteredLight> lights) {
+    CORRADE_ASSERT(_far > 0.0f,
+        "Shaders::LightClusters::bin(): perspective not set", *this);
+
+    const Vector2 depthParameters = depthSliceParameters();
+
+    /* Cluster range affected by each light, empty if outside of the frustum */
+    std::vector<std::pair<Vector3ui, Vector3ui>> ranges;
+    ranges.reserve(lights.size());
+    _clusters.assign(_count.product(), Vector2ui{});
+
+    for(const ClusteredLight& light: lights) {
+        /* Depth range, clipped to the frustum */
+        const Float nearest = -(light.position.z() + light.range);
+        const Float farthest = -(light.position.z() - light.range);
+        if(farthest < _near || nearest > _far) {
+            ranges.emplace_back(Vector3ui{1}, Vector3ui{0});
+            continue;
+        }
+        const Float clippedNearest = Math::max(nearest, _near);
+        const Float clippedFarthest = Math::min(farthest, _far);
+
+        /* Screen-space extent of the bounding box clipped to the depth range.
+           The box is convex, so the extent of its projection is given by its
+           projected corners. */
+        Vector2 min{Constants::inf()}, max{-Constants::inf()};
+        for(const Float z: {-clippedNearest, -clippedFarthest})
+            for(const Float y: {light.position.y() - light.range, light.position.y() + light.range})
+                for(const Float x: {light.position.x() - light.range, light.position.x() + light.range}) {
+                    const Vector2 ndc = _projection.transformPoint({x, y, z}).xy();
+                    min = Math::min(min, ndc);
+                    max = Math::max(max, ndc);
+                }
+        if(max.x() < -1.0f || max.y() < -1.0f || min.x() > 1.0f || min.y() > 1.0f) {
+            ranges.emplace_back(Vector3ui{1}, Vector3ui{0});
+            continue;
+        }
+
+        min = min*0.5f + Vector2{0.5f};
+        max = max*0.5f + Vector2{0.5f};
+        ranges.emplace_back(
+            Vector3ui{clusterCoordinate(min.x(), _count.x()),
+                      clusterCoordinate(min.y(), _count.y()),
+                      depthSlice(clippedNearest, depthParameters, _count.z())},
+            Vector3ui{clusterCoordinate(max.x(), _count.x()),
+                      clusterCoordinate(max.y(), _count.y()),
+                      depthSlice(clippedFarthest, depthParameters, _count.z())});
+    }
+
+    /* Count lights in each cluster */
+    for(const auto& range: ranges)
+        for(UnsignedInt z = range.first.z(); z <= range.second.z(); ++z)
+            for(UnsignedInt y = range.first.y(); y <= range.second.y(); ++y)
+                for(UnsignedInt x = range.first.x(); x <= range.second.x(); ++x)
+                    ++_clusters[x + _count.x()*(y + _count.y()*z)].y();
+
+    /* Convert the counts to offsets */
+    UnsignedInt offset = 0;
+    for(Vector2ui& cluster: _clusters) {
+        cluster.x() = offset;
+        offset += cluster.y();
+        cluster.y() = 0;
+    }
+
+    /* Fill the indices, restoring the counts */
+    _lightIndices.resize(offset);
+    for(std::size_t i = 0; i != ranges.size(); ++i)
+        for(UnsignedInt z = ranges[i].first.z(); z <= ranges[i].second.z(); ++z)
+            for(UnsignedInt y = ranges[i].first.y(); y <= ranges[i].second.y(); ++y)
+                for(UnsignedInt x = ranges[i].first.x(); x <= ranges[i].second.x(); ++x) {
+                    Vector2ui& cluster = _clusters[x + _count.x()*(y + _count.y()*z)];
+                    _lightIndices[cluster.x() + cluster.y()++] = i;
+                }
+
+    return *this;
+}
+
+}}
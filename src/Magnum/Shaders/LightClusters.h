@@ -0,0 +1,201 @@
+#ifndef Magnum_Shaders_LightClusters_h
+#define Magnum_Shaders_LightClusters_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Shaders::LightClusters, struct @ref Magnum::Shaders::ClusteredLight
+ */
+
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shaders/visibility.h"
+
+namespace Magnum { namespace Shaders {
+
+/**
+@brief Point light for clustered shading
+
+Matches the `std430` layout of the light buffer used by @ref Phong with
+@ref Phong::Flag::ClusteredLights. The light intensity falls off smoothly to
+zero at @ref range, so the light affects only clusters intersecting the
+sphere given by @ref position and @ref range.
+@see @ref LightClusters
+*/
+struct ClusteredLight {
+    /** @brief Light position in view space */
+    Vector3 position;
+
+    /** @brief Light range */
+    Float range;
+
+    /** @brief Light color */
+    Color3 color;
+
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    /* Padding to 16 bytes */
+    UnsignedInt:32;
+    #endif
+};
+
+static_assert(sizeof(ClusteredLight) == 32, "ClusteredLight doesn't match std430 layout");
+
+/**
+@brief Light clusters
+
+Splits the view frustum into a grid of clusters --- tiles in screen space and
+slices exponentially distributed in depth --- and assigns every
+@ref ClusteredLight to all clusters its range intersects. The result is then
+consumed by @ref Phong with @ref Phong::Flag::ClusteredLights, which for every
+fragment loops only over lights of the cluster the fragment is in and thus has
+a roughly constant per-pixel cost regardless of total light count.
+
+## Example usage
+
+Set the same perspective parameters as used for the projection matrix, bin
+the lights transformed to view space each frame and upload the outputs to
+shader storage buffers:
+
+@code
+Shaders::LightClusters clusters{{16, 9, 24}};
+clusters.setPerspective(35.0_degf, aspectRatio, 0.1f, 100.0f);
+
+std::vector<Shaders::ClusteredLight> lights;
+// fill lights with view space positions ...
+clusters.bin(lights);
+
+Buffer lightBuffer, clusterBuffer, lightIndexBuffer;
+lightBuffer.setData(lights, BufferUsage::StreamDraw);
+clusterBuffer.setData(clusters.clusters(), BufferUsage::StreamDraw);
+lightIndexBuffer.setData(clusters.lightIndices(), BufferUsage::StreamDraw);
+
+shader.setLightClusters(clusters, defaultFramebuffer.viewport().size())
+    .bindLightBuffer(lightBuffer)
+    .bindLightClusterBuffer(clusterBuffer)
+    .bindLightIndexBuffer(lightIndexBuffer);
+@endcode
+
+The binning is conservative --- the screen-space extent of each light is
+computed from projected corners of its bounding box clipped to the depth range
+of the light, so a light may be assigned also to few clusters it doesn't
+affect.
+*/
+class MAGNUM_SHADERS_EXPORT LightClusters {
+    public:
+        /**
+         * @brief Constructor
+         * @param count     Cluster count in the horizontal, vertical and
+         *      depth direction
+         *
+         * Call @ref setPerspective() before binning the lights.
+         */
+        explicit LightClusters(const Vector3ui& count = {16, 9, 24});
+
+        /** @brief Cluster count in each direction */
+        Vector3ui count() const { return _count; }
+
+        /**
+         * @brief Set perspective parameters
+         * @return Reference to self (for method chaining)
+         *
+         * Expected to match the projection used for rendering, see
+         * @ref Matrix4::perspectiveProjection(Rad<T>, T, T, T). Expects that
+         * @p near is positive and @p far is larger than @p near.
+         */
+        LightClusters& setPerspective(Rad fov, Float aspectRatio, Float near, Float far);
+
+        /** @brief Near clipping plane distance */
+        Float near() const { return _near; }
+
+        /** @brief Far clipping plane distance */
+        Float far() const { return _far; }
+
+        /**
+         * @brief Depth slice parameters
+         *
+         * Depth slice of a view space position `z` is
+         * @f$ \lfloor \log(-z) s + b \rfloor @f$, where @f$ s @f$ is the
+         * first and @f$ b @f$ the second component of returned value.
+         */
+        Vector2 depthSliceParameters() const;
+
+        /**
+         * @brief Cluster containing given view space position
+         *
+         * Positions outside of the view frustum are clamped to the border
+         * clusters. Uses the same calculation as the shader.
+         */
+        Vector3ui cluster(const Vector3& position) const;
+
+        /**
+         * @brief Bin lights to clusters
+         * @return Reference to self (for method chaining)
+         *
+         * Replaces results of the previous call. Light positions are expected
+         * to be in view space.
+         * @see @ref clusters(), @ref lightIndices()
+         */
+        LightClusters& bin(Containers::ArrayView<const ClusteredLight> lights);
+
+        /** @overload */
+        LightClusters& bin(const std::vector<ClusteredLight>& lights) {
+            return bin(Containers::ArrayView<const ClusteredLight>{lights.data(), lights.size()});
+        }
+
+        /**
+         * @brief Per-cluster light ranges
+         *
+         * One item for each cluster, ordered by X, then Y, then depth slice.
+         * The first component is offset into @ref lightIndices(), the second
+         * is count of lights in the cluster.
+         */
+        Containers::ArrayView<const Vector2ui> clusters() const {
+            return {_clusters.data(), _clusters.size()};
+        }
+
+        /**
+         * @brief Light indices
+         *
+         * Indices into the array passed to @ref bin(), grouped by cluster.
+         */
+        Containers::ArrayView<const UnsignedInt> lightIndices() const {
+            return {_lightIndices.data(), _lightIndices.size()};
+        }
+
+    private:
+        Vector3ui _count;
+        Float _near, _far;
+        Matrix4 _projection;
+        std::vector<Vector2ui> _clusters;
+        std::vector<UnsignedInt> _lightIndices;
+};
+
+}}
+
+#endif
@@ -60,10 +60,10 @@ MeshVisualizer::MeshVisualizer(const Flags flags): _flags{flags} {
 
     #ifndef MAGNUM_TARGET_GLES
     const Version version = Context::current().supportedVersion({Version::GL320, Version::GL310, Version::GL300, Version::GL210});
-    CORRADE_INTERNAL_ASSERT(!flags || flags & Flag::NoGeometryShader || version >= Version::GL320);
+    CORRADE_INTERNAL_ASSERT(!(flags & Flag::Wireframe) || flags & Flag::NoGeometryShader || version >= Version::GL320);
     #elif !defined(MAGNUM_TARGET_WEBGL)
     const Version version = Context::current().supportedVersion({Version::GLES310, Version::GLES300, Version::GLES200});
-    CORRADE_INTERNAL_ASSERT(!flags || flags & Flag::NoGeometryShader || version >= Version::GLES310);
+    CORRADE_INTERNAL_ASSERT(!(flags & Flag::Wireframe) || flags & Flag::NoGeometryShader || version >= Version::GLES310);
     #else
     const Version version = Context::current().supportedVersion({Version::GLES300, Version::GLES200});
     #endif
@@ -73,6 +73,8 @@ MeshVisualizer::MeshVisualizer(const Flags flags): _flags{flags} {
 
     vert.addSource(flags & Flag::Wireframe ? "#define WIREFRAME_RENDERING\n" : "")
         .addSource(flags & Flag::NoGeometryShader ? "#define NO_GEOMETRY_SHADER\n" : "")
+        .addSource(flags & Flag::InstancedTransformation ? "#define INSTANCED_TRANSFORMATION\n" : "")
+        .addSource(flags & Flag::VertexIndexAttribute ? "#define VERTEX_INDEX_ATTRIBUTE\n" : "")
         #ifdef MAGNUM_TARGET_WEBGL
         .addSource("#define SUBSCRIPTING_WORKAROUND\n")
         #elif defined(MAGNUM_TARGET_GLES2)
@@ -93,36 +95,32 @@ MeshVisualizer::MeshVisualizer(const Flags flags): _flags{flags} {
     }
     #endif
 
-    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
-    if(geom) CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, *geom, frag}));
-    else
-    #endif
-        CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, frag}));
-
-    attachShaders({vert, frag});
-    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
-    if(geom) attachShader(*geom);
-    #endif
-
-    #ifndef MAGNUM_TARGET_GLES
-    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_attrib_location>(version))
-    #else
-    if(!Context::current().isVersionSupported(Version::GLES300))
-    #endif
-    {
-        bindAttributeLocation(Position::Location, "position");
-
-        #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
+    const auto bindAttributeLocations = [&]() {
         #ifndef MAGNUM_TARGET_GLES
-        if(!Context::current().isVersionSupported(Version::GL310))
+        if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_attrib_location>(version))
+        #else
+        if(!Context::current().isVersionSupported(Version::GLES300))
         #endif
         {
-            bindAttributeLocation(VertexIndex::Location, "vertexIndex");
+            bindAttributeLocation(Position::Location, "position");
+            if(flags & Flag::InstancedTransformation) bindAttributeLocation(TransformationMatrix::Location, "instancedTransformationMatrix");
+
+            #ifndef MAGNUM_TARGET_GLES
+            if(!Context::current().isVersionSupported(Version::GL310) || flags & Flag::VertexIndexAttribute)
+            #elif !defined(MAGNUM_TARGET_GLES2)
+            if(flags & Flag::VertexIndexAttribute)
+            #endif
+            {
+                bindAttributeLocation(VertexIndex::Location, "vertexIndex");
+            }
         }
-        #endif
-    }
+    };
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(geom) CORRADE_INTERNAL_ASSERT_OUTPUT(compileAndLink({vert, *geom, frag}, bindAttributeLocations));
+    else
+    #endif
+        CORRADE_INTERNAL_ASSERT_OUTPUT(compileAndLink({vert, frag}, bindAttributeLocations));
 
     #ifndef MAGNUM_TARGET_GLES
     if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_uniform_location>(version))
@@ -63,7 +63,10 @@ If you don't have geometry shaders, you need to set @ref Flag::NoGeometryShader
 (it's enabled by default in OpenGL ES 2.0) and use only **non-indexed** triangle
 meshes (see @ref MeshTools::duplicate() for possible solution). Additionaly, if
 you have OpenGL < 3.1 or OpenGL ES 2.0, you need to provide also
-@ref VertexIndex attribute.
+@ref VertexIndex attribute. Indexed meshes can be rendered if you provide
+per-vertex triangle corners in the @ref VertexIndex attribute and enable
+@ref Flag::VertexIndexAttribute, see @ref MeshTools::generateWireframeCorners()
+for a way to calculate them with only minimal vertex duplication.
 
 @requires_gles30 Extension @extension{OES,standard_derivatives} for
     wireframe rendering without geometry shaders.
@@ -148,6 +151,35 @@ mesh.addVertexBuffer(vertices, 0, Shaders::MeshVisualizer::Position{});
 
 Rendering setup the same as above.
 
+Alternatively, the indexing can be preserved by assigning a triangle corner
+to each vertex and duplicating only the vertices where neighboring triangles
+need a different corner. Mesh setup:
+@code
+std::vector<UnsignedInt> vertexIds;
+std::vector<UnsignedByte> corners;
+std::tie(indices, vertexIds, corners) = MeshTools::generateWireframeCorners(indices);
+
+Buffer vertices, cornerBuffer, indexBuffer;
+vertices.setData(MeshTools::duplicate(vertexIds, indexedPositions), BufferUsage::StaticDraw);
+cornerBuffer.setData(corners, BufferUsage::StaticDraw);
+indexBuffer.setData(indices, BufferUsage::StaticDraw);
+
+Mesh mesh;
+mesh.setCount(indices.size())
+    .addVertexBuffer(vertices, 0, Shaders::MeshVisualizer::Position{})
+    .addVertexBuffer(cornerBuffer, 0, Shaders::MeshVisualizer::VertexIndex{
+        Shaders::MeshVisualizer::VertexIndex::DataType::UnsignedByte})
+    .setIndexBuffer(indexBuffer, 0, Mesh::IndexType::UnsignedInt);
+@endcode
+
+Rendering setup:
+@code
+Shaders::MeshVisualizer shader{Shaders::MeshVisualizer::Flag::Wireframe|
+                               Shaders::MeshVisualizer::Flag::NoGeometryShader|
+                               Shaders::MeshVisualizer::Flag::VertexIndexAttribute};
+// ...
+@endcode
+
 @see @ref shaders
 @todo Understand and add support wireframe width/smoothness without GS
 */
@@ -168,10 +200,24 @@ class MAGNUM_SHADERS_EXPORT MeshVisualizer: public AbstractShaderProgram {
          * specifies index of given vertex in triangle, i.e. `0` for first, `1`
          * for second, `2` for third. In OpenGL 3.1, OpenGL ES 3.0 and newer
          * this value is provided by the shader itself, so the attribute is not
-         * needed.
+         * needed, unless @ref Flag::VertexIndexAttribute is set.
          */
         typedef Attribute<3, Float> VertexIndex;
 
+        /**
+         * @brief Instanced transformation matrix
+         *
+         * @ref shaders-generic "Generic attribute", @ref Matrix4. Used only
+         * if @ref Flag::InstancedTransformation is set.
+         * @requires_gl33 Extension @extension{ARB,instanced_arrays}
+         * @requires_gles30 Extension @es_extension{ANGLE,instanced_arrays},
+         *      @es_extension{EXT,instanced_arrays} or
+         *      @es_extension{NV,instanced_arrays} in OpenGL ES 2.0.
+         * @requires_webgl20 Extension @webgl_extension{ANGLE,instanced_arrays}
+         *      in WebGL 1.0.
+         */
+        typedef Attribute<8, Matrix4> TransformationMatrix;
+
         /**
          * @brief Flag
          *
@@ -194,7 +240,23 @@ class MAGNUM_SHADERS_EXPORT MeshVisualizer: public AbstractShaderProgram {
              * attribute in the mesh. In OpenGL ES enabled alongside
              * @ref Flag::Wireframe.
              */
-            NoGeometryShader = 1 << 1
+            NoGeometryShader = 1 << 1,
+
+            /**
+             * Multiply the transformation with the per-instance
+             * @ref TransformationMatrix attribute. See
+             * @ref Flat-instancing "Flat shader docs" for an example.
+             */
+            InstancedTransformation = 1 << 2,
+
+            /**
+             * Always take triangle corners from the @ref VertexIndex
+             * attribute, even if the shader could calculate them from
+             * `gl_VertexID`. Use together with @ref Flag::Wireframe and
+             * @ref Flag::NoGeometryShader to render indexed meshes, see
+             * @ref MeshTools::generateWireframeCorners().
+             */
+            VertexIndexAttribute = 1 << 3
         };
 
         /** @brief Flags */
@@ -38,8 +38,15 @@ layout(location = POSITION_ATTRIBUTE_LOCATION)
 #endif
 in highp vec4 position;
 
+#ifdef INSTANCED_TRANSFORMATION
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = TRANSFORMATION_MATRIX_ATTRIBUTE_LOCATION)
+#endif
+in highp mat4 instancedTransformationMatrix;
+#endif
+
 #if defined(WIREFRAME_RENDERING) && defined(NO_GEOMETRY_SHADER)
-#if (!defined(GL_ES) && __VERSION__ < 140) || (defined(GL_ES) && __VERSION__ < 300)
+#if (!defined(GL_ES) && __VERSION__ < 140) || (defined(GL_ES) && __VERSION__ < 300) || defined(VERTEX_INDEX_ATTRIBUTE)
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = 3)
 #endif
@@ -51,7 +58,11 @@ out vec3 barycentric;
 #endif
 
 void main() {
-    gl_Position = transformationProjectionMatrix*position;
+    gl_Position = transformationProjectionMatrix*
+        #ifdef INSTANCED_TRANSFORMATION
+        instancedTransformationMatrix*
+        #endif
+        position;
 
     #if defined(WIREFRAME_RENDERING) && defined(NO_GEOMETRY_SHADER)
     barycentric = vec3(0.0);
@@ -61,7 +72,7 @@ void main() {
          if(i == 0) barycentric.x = 1.0;
     else if(i == 1) barycentric.y = 1.0;
     else            barycentric.z = 1.0;
-    #elif !defined(NEW_GLSL)
+    #elif !defined(NEW_GLSL) || defined(VERTEX_INDEX_ATTRIBUTE)
     barycentric[int(mod(vertexIndex, 3.0))] = 1.0;
     #else
     barycentric[gl_VertexID % 3] = 1.0;
@@ -0,0 +1,209 @@
+#ifndef Magnum_Shaders_ParticleBillboard_h
+#define Magnum_Shaders_ParticleBillboard_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Shaders::ParticleBillboard
+ */
+
+#include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shaders/Generic.h"
+#include "Magnum/Shaders/visibility.h"
+
+namespace Magnum { namespace Shaders {
+
+/**
+@brief Particle billboard shader
+
+Draws each vertex of a @ref MeshPrimitive::Points mesh as a round
+camera-facing billboard of given world-space size. The particle color is
+interpolated between @ref setStartColor() and @ref setEndColor() based on the
+ratio of @ref Age and @ref Lifetime attributes, particles with negative age or
+age past their lifetime are not drawn. You need to provide all three
+attributes in your mesh and call at least @ref setTransformationMatrix(),
+@ref setProjectionMatrix() and @ref setViewportSize(). The shader is designed
+to draw the output of @ref Particles::ParticleSystem without any CPU
+intervention, but can be used for any point data.
+
+## Example usage
+
+The attributes can be interleaved with other data, which the shader skips:
+@code
+struct Particle {
+    Vector3 position;
+    Float age;
+    Vector3 velocity;
+    Float lifetime;
+};
+
+Mesh mesh{MeshPrimitive::Points};
+mesh.addVertexBuffer(particles, 0,
+        Shaders::ParticleBillboard::Position{},
+        Shaders::ParticleBillboard::Age{},
+        sizeof(Vector3),
+        Shaders::ParticleBillboard::Lifetime{})
+    .setCount(particleCount);
+
+Shaders::ParticleBillboard shader;
+shader.setTransformationMatrix(cameraMatrix)
+    .setProjectionMatrix(projectionMatrix)
+    .setViewportSize(Vector2{defaultFramebuffer.viewport().size()})
+    .setSize(0.1f)
+    .setStartColor(0xffcc33ff_rgbaf)
+    .setEndColor(0xff330000_rgbaf);
+
+Renderer::enable(Renderer::Feature::ProgramPointSize);
+Renderer::enable(Renderer::Feature::Blending);
+Renderer::setBlendFunction(Renderer::BlendFunction::SourceAlpha, Renderer::BlendFunction::OneMinusSourceAlpha);
+mesh.draw(shader);
+@endcode
+
+On desktop OpenGL the @ref Renderer::Feature::ProgramPointSize needs to be
+enabled for the billboards to have the correct size, it's always enabled in
+OpenGL ES and WebGL.
+
+@see @ref shaders
+*/
+class MAGNUM_SHADERS_EXPORT ParticleBillboard: public AbstractShaderProgram {
+    public:
+        /**
+         * @brief Particle position
+         *
+         * @ref shaders-generic "Generic attribute", @ref Vector3.
+         */
+        typedef Generic3D::Position Position;
+
+        /**
+         * @brief Particle age
+         *
+         * @ref Float. Particles with negative age are not drawn.
+         */
+        typedef Attribute<4, Float> Age;
+
+        /**
+         * @brief Particle lifetime
+         *
+         * @ref Float. Particles with @ref Age larger or equal to
+         * lifetime are not drawn.
+         */
+        typedef Attribute<5, Float> Lifetime;
+
+        explicit ParticleBillboard();
+
+        /**
+         * @brief Construct without creating the underlying OpenGL object
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         *
+         * This function can be safely used for constructing (and later
+         * destructing) objects even without any OpenGL context being active.
+         */
+        explicit ParticleBillboard(NoCreateT) noexcept: AbstractShaderProgram{NoCreate} {}
+
+        /**
+         * @brief Set transformation matrix
+         * @return Reference to self (for method chaining)
+         *
+         * Usually the camera matrix, as particle positions are in world
+         * space. Initial value is an identity matrix.
+         */
+        ParticleBillboard& setTransformationMatrix(const Matrix4& matrix) {
+            setUniform(_transformationMatrixUniform, matrix);
+            return *this;
+        }
+
+        /**
+         * @brief Set projection matrix
+         * @return Reference to self (for method chaining)
+         *
+         * Initial value is an identity matrix.
+         */
+        ParticleBillboard& setProjectionMatrix(const Matrix4& matrix) {
+            setUniform(_projectionMatrixUniform, matrix);
+            return *this;
+        }
+
+        /**
+         * @brief Set viewport size
+         * @return Reference to self (for method chaining)
+         *
+         * Used to calculate billboard size in pixels.
+         */
+        ParticleBillboard& setViewportSize(const Vector2& size) {
+            setUniform(_viewportSizeUniform, size);
+            return *this;
+        }
+
+        /**
+         * @brief Set billboard size
+         * @return Reference to self (for method chaining)
+         *
+         * Diameter of the billboard in world units. Initial value is
+         * `1.0f`.
+         */
+        ParticleBillboard& setSize(Float size) {
+            setUniform(_sizeUniform, size);
+            return *this;
+        }
+
+        /**
+         * @brief Set color of newly spawned particles
+         * @return Reference to self (for method chaining)
+         *
+         * Initial value is fully opaque white.
+         */
+        ParticleBillboard& setStartColor(const Color4& color) {
+            setUniform(_startColorUniform, color);
+            return *this;
+        }
+
+        /**
+         * @brief Set color of particles at the end of their lifetime
+         * @return Reference to self (for method chaining)
+         *
+         * Initial value is fully transparent white.
+         */
+        ParticleBillboard& setEndColor(const Color4& color) {
+            setUniform(_endColorUniform, color);
+            return *this;
+        }
+
+    private:
+        Int _transformationMatrixUniform{0},
+            _projectionMatrixUniform{1},
+            _viewportSizeUniform{2},
+            _sizeUniform{3},
+            _startColorUniform{4},
+            _endColorUniform{5};
+};
+
+}}
+
+#endif
@@ -27,10 +27,12 @@
 
 #include <Corrade/Utility/Resource.h>
 
+#include "Magnum/Buffer.h"
 #include "Magnum/Context.h"
 #include "Magnum/Extensions.h"
 #include "Magnum/Shader.h"
 #include "Magnum/Texture.h"
+#include "Magnum/Shaders/LightClusters.h"
 
 #include "Implementation/CreateCompatibilityShader.h"
 
@@ -42,9 +44,57 @@ namespace {
         DiffuseTextureLayer = 1,
         SpecularTextureLayer = 2
     };
+
+    #ifndef MAGNUM_TARGET_GLES2
+    enum: UnsignedInt {
+        DrawBufferBinding = 0,
+        JointBufferBinding = 1
+    };
+    #endif
+
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    enum: UnsignedInt {
+        LightBufferBinding = 0,
+        LightClusterBufferBinding = 1,
+        LightIndexBufferBinding = 2
+    };
+    #endif
 }
 
-Phong::Phong(const Flags flags): _flags(flags) {
+Phong::CompileState Phong::compile(const Flags flags, const UnsignedInt drawCount, const UnsignedInt jointCount) {
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags & (Flag::UniformBuffers|Flag::Skinned)) {
+        #ifndef MAGNUM_TARGET_GLES
+        MAGNUM_ASSERT_VERSION_SUPPORTED(Version::GL310);
+        #else
+        MAGNUM_ASSERT_VERSION_SUPPORTED(Version::GLES300);
+        #endif
+    }
+    #else
+    static_cast<void>(drawCount);
+    static_cast<void>(jointCount);
+    #endif
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(flags & Flag::ClusteredLights) {
+        #ifndef MAGNUM_TARGET_GLES
+        MAGNUM_ASSERT_VERSION_SUPPORTED(Version::GL430);
+        #else
+        MAGNUM_ASSERT_VERSION_SUPPORTED(Version::GLES310);
+        #endif
+    }
+    if(flags & Flag::Multiview)
+        MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::OVR::multiview);
+    #endif
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags & (Flag::GBufferOutput|Flag::FlatShading)) {
+        #ifndef MAGNUM_TARGET_GLES
+        MAGNUM_ASSERT_VERSION_SUPPORTED(Version::GL300);
+        #else
+        MAGNUM_ASSERT_VERSION_SUPPORTED(Version::GLES300);
+        #endif
+    }
+    #endif
+
     #ifdef MAGNUM_BUILD_STATIC
     /* Import resources on static build, if not already */
     if(!Utility::Resource::hasGroup("MagnumShaders"))
@@ -52,8 +102,13 @@ Phong::Phong(const Flags flags): _flags(flags) {
     #endif
     Utility::Resource rs("MagnumShaders");
 
+    /* Shader storage blocks need GLSL 4.30 / GLSL ES 3.10 */
     #ifndef MAGNUM_TARGET_GLES
-    const Version version = Context::current().supportedVersion({Version::GL320, Version::GL310, Version::GL300, Version::GL210});
+    const Version version = flags & Flag::ClusteredLights ? Version::GL430 :
+        Context::current().supportedVersion({Version::GL320, Version::GL310, Version::GL300, Version::GL210});
+    #elif !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    const Version version = flags & Flag::ClusteredLights ? Version::GLES310 :
+        Context::current().supportedVersion({Version::GLES300, Version::GLES200});
     #else
     const Version version = Context::current().supportedVersion({Version::GLES300, Version::GLES200});
     #endif
@@ -61,62 +116,160 @@ Phong::Phong(const Flags flags): _flags(flags) {
     Shader vert = Implementation::createCompatibilityShader(rs, version, Shader::Type::Vertex);
     Shader frag = Implementation::createCompatibilityShader(rs, version, Shader::Type::Fragment);
 
-    vert.addSource(flags ? "#define TEXTURED\n" : "")
-        .addSource(rs.get("generic.glsl"))
+    const bool textured = !!(flags & (Flag::AmbientTexture|Flag::DiffuseTexture|Flag::SpecularTexture));
+
+    vert.addSource(textured ? "#define TEXTURED\n" : "")
+        .addSource(flags & Flag::VertexColor ? "#define VERTEX_COLOR\n" : "")
+        .addSource(flags & Flag::InstancedTransformation ? "#define INSTANCED_TRANSFORMATION\n" : "")
+        .addSource(flags & Flag::OctahedralNormal ? "#define OCTAHEDRAL_NORMAL\n" : "");
+    frag.addSource(flags & Flag::VertexColor ? "#define VERTEX_COLOR\n" : "");
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags & Flag::UniformBuffers) {
+        vert.addSource("#define UNIFORM_BUFFERS\n#define DRAW_COUNT " + std::to_string(drawCount) + "\n");
+        frag.addSource("#define UNIFORM_BUFFERS\n");
+    }
+    if(flags & Flag::Skinned)
+        vert.addSource("#define SKINNED\n#define JOINT_COUNT " + std::to_string(jointCount) + "\n");
+    if(flags & Flag::GBufferOutput)
+        frag.addSource("#define GBUFFER_OUTPUT\n");
+    if(flags & Flag::FlatShading) {
+        vert.addSource("#define FLAT_SHADING\n");
+        frag.addSource("#define FLAT_SHADING\n");
+    }
+    #endif
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(flags & Flag::ClusteredLights)
+        frag.addSource("#define CLUSTERED_LIGHTS\n");
+    if(flags & Flag::Multiview)
+        vert.addSource("#define MULTIVIEW\n");
+    #endif
+    vert.addSource(rs.get("generic.glsl"))
         .addSource(rs.get("Phong.vert"));
     frag.addSource(flags & Flag::AmbientTexture ? "#define AMBIENT_TEXTURE\n" : "")
         .addSource(flags & Flag::DiffuseTexture ? "#define DIFFUSE_TEXTURE\n" : "")
         .addSource(flags & Flag::SpecularTexture ? "#define SPECULAR_TEXTURE\n" : "")
         .addSource(rs.get("Phong.frag"));
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, frag}));
+    Phong out{Math::NoInit};
+    out._flags = flags;
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags & Flag::UniformBuffers) out._drawCount = drawCount;
+    if(flags & Flag::Skinned) out._jointCount = jointCount;
+    #endif
 
-    attachShaders({vert, frag});
+    const auto bindAttributeLocations = [&]() {
+        #ifndef MAGNUM_TARGET_GLES
+        if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_attrib_location>(version))
+        #else
+        if(!Context::current().isVersionSupported(Version::GLES300))
+        #endif
+        {
+            out.bindAttributeLocation(Position::Location, "position");
+            out.bindAttributeLocation(Normal::Location, "normal");
+            if(textured) out.bindAttributeLocation(TextureCoordinates::Location, "textureCoordinates");
+            if(flags & Flag::VertexColor) out.bindAttributeLocation(Color::Location, "vertexColor");
+            if(flags & Flag::InstancedTransformation) {
+                out.bindAttributeLocation(TransformationMatrix::Location, "instancedTransformationMatrix");
+                out.bindAttributeLocation(NormalMatrix::Location, "instancedNormalMatrix");
+            }
+            #ifndef MAGNUM_TARGET_GLES2
+            if(flags & Flag::Skinned) {
+                out.bindAttributeLocation(JointIds::Location, "jointIds");
+                out.bindAttributeLocation(JointWeights::Location, "jointWeights");
+            }
+            #endif
+            #ifndef MAGNUM_TARGET_GLES
+            if(flags & Flag::GBufferOutput) {
+                out.bindFragmentDataLocation(ColorOutput, "color");
+                out.bindFragmentDataLocation(AlbedoOutput, "albedo");
+                out.bindFragmentDataLocation(NormalOutput, "packedNormal");
+            }
+            #endif
+        }
+    };
+    const bool loaded = out.submitCompileAndLink({vert, frag}, bindAttributeLocations);
 
-    #ifndef MAGNUM_TARGET_GLES
-    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_attrib_location>(version))
-    #else
-    if(!Context::current().isVersionSupported(Version::GLES300))
+    return CompileState{std::move(out), std::move(vert), std::move(frag), version, loaded};
+}
+
+Phong::Phong(const Flags flags, const UnsignedInt drawCount, const UnsignedInt jointCount): Phong{compile(flags, drawCount, jointCount)} {}
+
+Phong::Phong(CompileState&& state): Phong{static_cast<Phong&&>(std::move(state))} {
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    CORRADE_ASSERT(!(_flags & Flag::Multiview) || !(_flags & Flag::UniformBuffers),
+        "Shaders::Phong: multiview can't be combined with uniform buffers", );
+    CORRADE_ASSERT(!(_flags & Flag::GBufferOutput) || !(_flags & Flag::ClusteredLights),
+        "Shaders::Phong: G-buffer output can't be combined with clustered lights", );
     #endif
-    {
-        bindAttributeLocation(Position::Location, "position");
-        bindAttributeLocation(Normal::Location, "normal");
-        if(flags) bindAttributeLocation(TextureCoordinates::Location, "textureCoordinates");
-    }
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+    if(!state._loaded)
+        CORRADE_INTERNAL_ASSERT_OUTPUT(checkCompileAndLink({state._vert, state._frag}));
+
+    #ifndef MAGNUM_TARGET_GLES
+    const Version version = state._version;
+    #endif
 
     #ifndef MAGNUM_TARGET_GLES
     if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_uniform_location>(version))
     #endif
     {
-        _transformationMatrixUniform = uniformLocation("transformationMatrix");
-        _projectionMatrixUniform = uniformLocation("projectionMatrix");
-        _normalMatrixUniform = uniformLocation("normalMatrix");
-        _lightUniform = uniformLocation("light");
-        _ambientColorUniform = uniformLocation("ambientColor");
-        _diffuseColorUniform = uniformLocation("diffuseColor");
-        _specularColorUniform = uniformLocation("specularColor");
-        _lightColorUniform = uniformLocation("lightColor");
-        _shininessUniform = uniformLocation("shininess");
+        #ifndef MAGNUM_TARGET_GLES2
+        if(_flags & Flag::UniformBuffers)
+            _drawOffsetUniform = uniformLocation("drawOffset");
+        else
+        #endif
+        {
+            _transformationMatrixUniform = uniformLocation("transformationMatrix");
+            #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+            if(_flags & Flag::Multiview)
+                _viewProjectionMatricesUniform = uniformLocation("viewProjectionMatrices");
+            else
+            #endif
+            {
+                _projectionMatrixUniform = uniformLocation("projectionMatrix");
+            }
+            _normalMatrixUniform = uniformLocation("normalMatrix");
+            _lightUniform = uniformLocation("light");
+            _ambientColorUniform = uniformLocation("ambientColor");
+            _diffuseColorUniform = uniformLocation("diffuseColor");
+            _specularColorUniform = uniformLocation("specularColor");
+            _lightColorUniform = uniformLocation("lightColor");
+            _shininessUniform = uniformLocation("shininess");
+        }
+
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        if(_flags & Flag::ClusteredLights) {
+            _clusterCountUniform = uniformLocation("clusterCount");
+            _clusterScaleUniform = uniformLocation("clusterScale");
+        }
+        #endif
     }
 
     #ifndef MAGNUM_TARGET_GLES
-    if(flags && !Context::current().isExtensionSupported<Extensions::GL::ARB::shading_language_420pack>(version))
+    if(_flags && !Context::current().isExtensionSupported<Extensions::GL::ARB::shading_language_420pack>(version))
     #endif
     {
-        if(flags & Flag::AmbientTexture) setUniform(uniformLocation("ambientTexture"), AmbientTextureLayer);
-        if(flags & Flag::DiffuseTexture) setUniform(uniformLocation("diffuseTexture"), DiffuseTextureLayer);
-        if(flags & Flag::SpecularTexture) setUniform(uniformLocation("specularTexture"), SpecularTextureLayer);
+        if(_flags & Flag::AmbientTexture) setUniform(uniformLocation("ambientTexture"), AmbientTextureLayer);
+        if(_flags & Flag::DiffuseTexture) setUniform(uniformLocation("diffuseTexture"), DiffuseTextureLayer);
+        if(_flags & Flag::SpecularTexture) setUniform(uniformLocation("specularTexture"), SpecularTextureLayer);
+        #ifndef MAGNUM_TARGET_GLES2
+        if(_flags & Flag::UniformBuffers) setUniformBlockBinding(uniformBlockIndex("Draw"), DrawBufferBinding);
+        if(_flags & Flag::Skinned) setUniformBlockBinding(uniformBlockIndex("Joint"), JointBufferBinding);
+        #endif
     }
 
     /* Set defaults in OpenGL ES (for desktop they are set in shader code itself) */
     #ifdef MAGNUM_TARGET_GLES
+    #ifndef MAGNUM_TARGET_GLES2
+    /* With uniform buffers the defaults are in the DrawUniform structure */
+    if(_flags & Flag::UniformBuffers) return;
+    #endif
+
     /* Default to fully opaque white so we can see the textures */
-    if(flags & Flag::AmbientTexture) setAmbientColor(Color4{1.0f});
+    if(_flags & Flag::AmbientTexture) setAmbientColor(Color4{1.0f});
     else setAmbientColor(Color4{0.0f, 1.0f});
 
-    if(flags & Flag::DiffuseTexture) setDiffuseColor(Color4{1.0f});
+    if(_flags & Flag::DiffuseTexture) setDiffuseColor(Color4{1.0f});
 
     setSpecularColor(Color4{1.0f});
     setLightColor(Color4{1.0f});
@@ -124,6 +277,87 @@ Phong::Phong(const Flags flags): _flags(flags) {
     #endif
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+Phong& Phong::setDrawOffset(const UnsignedInt offset) {
+    CORRADE_ASSERT(_flags & Flag::UniformBuffers,
+        "Shaders::Phong::setDrawOffset(): the shader was not created with uniform buffers enabled", *this);
+    CORRADE_ASSERT(offset < _drawCount,
+        "Shaders::Phong::setDrawOffset(): draw offset" << offset << "is out of bounds for" << _drawCount << "draws", *this);
+    setUniform(_drawOffsetUniform, offset);
+    return *this;
+}
+
+Phong& Phong::bindDrawBuffer(Buffer& buffer) {
+    CORRADE_ASSERT(_flags & Flag::UniformBuffers,
+        "Shaders::Phong::bindDrawBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(Buffer::Target::Uniform, DrawBufferBinding);
+    return *this;
+}
+
+Phong& Phong::bindDrawBuffer(Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags & Flag::UniformBuffers,
+        "Shaders::Phong::bindDrawBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(Buffer::Target::Uniform, DrawBufferBinding, offset, size);
+    return *this;
+}
+
+Phong& Phong::bindJointBuffer(Buffer& buffer) {
+    CORRADE_ASSERT(_flags & Flag::Skinned,
+        "Shaders::Phong::bindJointBuffer(): the shader was not created with skinning enabled", *this);
+    buffer.bind(Buffer::Target::Uniform, JointBufferBinding);
+    return *this;
+}
+
+Phong& Phong::bindJointBuffer(Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags & Flag::Skinned,
+        "Shaders::Phong::bindJointBuffer(): the shader was not created with skinning enabled", *this);
+    buffer.bind(Buffer::Target::Uniform, JointBufferBinding, offset, size);
+    return *this;
+}
+#endif
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+Phong& Phong::setViewProjectionMatrices(const Matrix4& first, const Matrix4& second) {
+    CORRADE_ASSERT(_flags & Flag::Multiview,
+        "Shaders::Phong::setViewProjectionMatrices(): the shader was not created with multiview enabled", *this);
+    const Matrix4 matrices[]{first, second};
+    setUniform(_viewProjectionMatricesUniform, {matrices, 2});
+    return *this;
+}
+
+Phong& Phong::setLightClusters(const LightClusters& clusters, const Vector2i& viewportSize) {
+    CORRADE_ASSERT(_flags & Flag::ClusteredLights,
+        "Shaders::Phong::setLightClusters(): the shader was not created with clustered lights enabled", *this);
+    /* XY maps fragment coordinates to tiles, ZW is the log depth slicing */
+    const Vector2 tileScale = Vector2{clusters.count().xy()}/Vector2{viewportSize};
+    const Vector2 depthSlice = clusters.depthSliceParameters();
+    setUniform(_clusterCountUniform, clusters.count());
+    setUniform(_clusterScaleUniform, Vector4{tileScale.x(), tileScale.y(), depthSlice.x(), depthSlice.y()});
+    return *this;
+}
+
+Phong& Phong::bindLightBuffer(Buffer& buffer) {
+    CORRADE_ASSERT(_flags & Flag::ClusteredLights,
+        "Shaders::Phong::bindLightBuffer(): the shader was not created with clustered lights enabled", *this);
+    buffer.bind(Buffer::Target::ShaderStorage, LightBufferBinding);
+    return *this;
+}
+
+Phong& Phong::bindLightClusterBuffer(Buffer& buffer) {
+    CORRADE_ASSERT(_flags & Flag::ClusteredLights,
+        "Shaders::Phong::bindLightClusterBuffer(): the shader was not created with clustered lights enabled", *this);
+    buffer.bind(Buffer::Target::ShaderStorage, LightClusterBufferBinding);
+    return *this;
+}
+
+Phong& Phong::bindLightIndexBuffer(Buffer& buffer) {
+    CORRADE_ASSERT(_flags & Flag::ClusteredLights,
+        "Shaders::Phong::bindLightIndexBuffer(): the shader was not created with clustered lights enabled", *this);
+    buffer.bind(Buffer::Target::ShaderStorage, LightIndexBufferBinding);
+    return *this;
+}
+#endif
+
 Phong& Phong::setAmbientTexture(Texture2D& texture) {
     if(_flags & Flag::AmbientTexture) texture.bind(AmbientTextureLayer);
     return *this;
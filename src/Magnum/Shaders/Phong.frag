@@ -33,6 +33,20 @@
 #define const
 #endif
 
+#ifdef UNIFORM_BUFFERS
+flat in lowp vec4 interpolatedAmbientColor;
+flat in lowp vec4 interpolatedDiffuseColor;
+flat in lowp vec4 interpolatedSpecularColor;
+flat in lowp vec4 interpolatedLightColor;
+flat in mediump float interpolatedShininess;
+#define ambientColor interpolatedAmbientColor
+#define diffuseColor interpolatedDiffuseColor
+#define specularColor interpolatedSpecularColor
+#define lightColor interpolatedLightColor
+#define shininess interpolatedShininess
+#endif
+
+#ifndef UNIFORM_BUFFERS
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 7)
 #endif
@@ -41,7 +55,9 @@ uniform lowp vec4 lightColor
     = vec4(1.0)
     #endif
     ;
+#endif
 
+#ifndef UNIFORM_BUFFERS
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 8)
 #endif
@@ -50,6 +66,7 @@ uniform mediump float shininess
     = 80.0
     #endif
     ;
+#endif
 
 #ifdef AMBIENT_TEXTURE
 #ifdef EXPLICIT_TEXTURE_LAYER
@@ -58,6 +75,7 @@ layout(binding = 0)
 uniform lowp sampler2D ambientTexture;
 #endif
 
+#ifndef UNIFORM_BUFFERS
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 4)
 #endif
@@ -70,6 +88,7 @@ uniform lowp vec4 ambientColor
     #endif
     #endif
     ;
+#endif
 
 #ifdef DIFFUSE_TEXTURE
 #ifdef EXPLICIT_TEXTURE_LAYER
@@ -78,6 +97,7 @@ layout(binding = 1)
 uniform lowp sampler2D diffuseTexture;
 #endif
 
+#ifndef UNIFORM_BUFFERS
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 5)
 #endif
@@ -86,6 +106,7 @@ uniform lowp vec4 diffuseColor
     = vec4(1.0)
     #endif
     ;
+#endif
 
 #ifdef SPECULAR_TEXTURE
 #ifdef EXPLICIT_TEXTURE_LAYER
@@ -94,6 +115,7 @@ layout(binding = 2)
 uniform lowp sampler2D specularTexture;
 #endif
 
+#ifndef UNIFORM_BUFFERS
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 6)
 #endif
@@ -102,7 +124,40 @@ uniform lowp vec4 specularColor
     = vec4(1.0)
     #endif
     ;
+#endif
+
+#ifdef CLUSTERED_LIGHTS
+struct ClusteredLight {
+    highp vec4 positionRange;
+    lowp vec4 color;
+};
+
+layout(std430, binding = 0) readonly buffer Lights {
+    ClusteredLight lights[];
+};
+
+layout(std430, binding = 1) readonly buffer LightClusters {
+    highp uvec2 clusters[];
+};
 
+layout(std430, binding = 2) readonly buffer LightIndices {
+    highp uint lightIndices[];
+};
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 10)
+#endif
+uniform highp uvec3 clusterCount;
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 11)
+#endif
+uniform highp vec4 clusterScale;
+#endif
+
+#ifdef FLAT_SHADING
+flat
+#endif
 in mediump vec3 transformedNormal;
 in highp vec3 lightDirection;
 in highp vec3 cameraDirection;
@@ -111,20 +166,53 @@ in highp vec3 cameraDirection;
 in mediump vec2 interpolatedTextureCoords;
 #endif
 
+#ifdef VERTEX_COLOR
+in lowp vec4 interpolatedVertexColor;
+#endif
+
 #ifdef NEW_GLSL
+#if defined(GBUFFER_OUTPUT) && defined(EXPLICIT_ATTRIB_LOCATION)
+layout(location = 0)
+#endif
 out lowp vec4 color;
 #endif
 
+#ifdef GBUFFER_OUTPUT
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = 1)
+#endif
+out lowp vec4 albedo;
+
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = 2)
+#endif
+out mediump vec4 packedNormal;
+
+/* Octahedral encoding into [0, 1], the inverse is in DeferredLight.frag */
+mediump vec2 encodeNormal(mediump vec3 normal) {
+    normal /= abs(normal.x) + abs(normal.y) + abs(normal.z);
+    mediump vec2 encoded = normal.z >= 0.0 ? normal.xy :
+        (vec2(1.0) - abs(normal.yx))*vec2(normal.x >= 0.0 ? 1.0 : -1.0, normal.y >= 0.0 ? 1.0 : -1.0);
+    return encoded*0.5 + vec2(0.5);
+}
+#endif
+
 void main() {
     lowp const vec4 finalAmbientColor =
         #ifdef AMBIENT_TEXTURE
         texture(ambientTexture, interpolatedTextureCoords)*
         #endif
+        #ifdef VERTEX_COLOR
+        interpolatedVertexColor*
+        #endif
         ambientColor;
     lowp const vec4 finalDiffuseColor =
         #ifdef DIFFUSE_TEXTURE
         texture(diffuseTexture, interpolatedTextureCoords)*
         #endif
+        #ifdef VERTEX_COLOR
+        interpolatedVertexColor*
+        #endif
         diffuseColor;
     lowp const vec4 finalSpecularColor =
         #ifdef SPECULAR_TEXTURE
@@ -136,6 +224,13 @@ void main() {
     color = finalAmbientColor;
 
     mediump vec3 normalizedTransformedNormal = normalize(transformedNormal);
+
+    #ifdef GBUFFER_OUTPUT
+    /* Lighting is done later by DeferredLight */
+    albedo = vec4(finalDiffuseColor.rgb, dot(finalSpecularColor.rgb, vec3(1.0/3.0)));
+    packedNormal = vec4(encodeNormal(normalizedTransformedNormal), clamp(shininess/1023.0, 0.0, 1.0), 1.0);
+    return;
+    #endif
     highp vec3 normalizedLightDirection = normalize(lightDirection);
 
     /* Add diffuse color */
@@ -148,4 +243,39 @@ void main() {
         mediump float specularity = pow(max(0.0, dot(normalize(cameraDirection), reflection)), shininess);
         color += finalSpecularColor*specularity;
     }
+
+    #ifdef CLUSTERED_LIGHTS
+    /* Find the cluster containing this fragment, the depth slices are
+       logarithmic. The camera direction is the negated view-space position. */
+    highp vec3 position = -cameraDirection;
+    highp uvec3 cluster = min(uvec3(
+        uvec2(max(gl_FragCoord.xy*clusterScale.xy, vec2(0.0))),
+        uint(max(log(max(-position.z, 1.0e-6))*clusterScale.z + clusterScale.w, 0.0))),
+        clusterCount - uvec3(1u));
+    highp uvec2 offsetCount = clusters[cluster.x + clusterCount.x*(cluster.y + clusterCount.y*cluster.z)];
+
+    /* Add the diffuse and specular contribution of all lights in the cluster,
+       falling off smoothly to zero at the light range */
+    highp vec3 normalizedCameraDirection = normalize(cameraDirection);
+    for(highp uint i = 0u; i != offsetCount.y; ++i) {
+        ClusteredLight light = lights[lightIndices[offsetCount.x + i]];
+        highp vec3 direction = light.positionRange.xyz - position;
+        highp float distanceSquared = dot(direction, direction);
+        highp float rangeSquared = light.positionRange.w*light.positionRange.w;
+        if(distanceSquared >= rangeSquared) continue;
+
+        highp float falloff = 1.0 - distanceSquared/rangeSquared;
+        falloff *= falloff;
+
+        highp vec3 normalizedDirection = direction*inversesqrt(distanceSquared);
+        lowp float clusteredIntensity = max(0.0, dot(normalizedTransformedNormal, normalizedDirection));
+        color.rgb += finalDiffuseColor.rgb*light.color.rgb*clusteredIntensity*falloff;
+
+        if(clusteredIntensity > 0.001) {
+            highp vec3 reflection = reflect(-normalizedDirection, normalizedTransformedNormal);
+            mediump float specularity = pow(max(0.0, dot(normalizedCameraDirection, reflection)), shininess);
+            color.rgb += finalSpecularColor.rgb*light.color.rgb*specularity*falloff;
+        }
+    }
+    #endif
 }
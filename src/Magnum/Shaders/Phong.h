@@ -32,11 +32,149 @@
 #include "Magnum/AbstractShaderProgram.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shader.h"
 #include "Magnum/Shaders/Generic.h"
+#include "Magnum/Shaders/Shaders.h"
 #include "Magnum/Shaders/visibility.h"
 
 namespace Magnum { namespace Shaders {
 
+#ifndef MAGNUM_TARGET_GLES2
+/**
+@brief Per-draw uniform structure for @ref Phong
+
+Matches the `std140` layout of the per-draw uniform block used by @ref Phong
+with @ref Phong::Flag::UniformBuffers enabled. The normal matrix is stored
+with each column padded to four components. The structure is 256 bytes large,
+which is a multiple of @ref Buffer::uniformOffsetAlignment() on common
+implementations, so the instances can be also bound one-by-one using
+@ref Phong::bindDrawBuffer(Buffer&, GLintptr, GLsizeiptr).
+@requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+struct PhongDrawUniform {
+    /**
+     * @brief Set transformation matrix
+     * @return Reference to self (for method chaining)
+     */
+    PhongDrawUniform& setTransformationMatrix(const Matrix4& matrix) {
+        transformationMatrix = matrix;
+        return *this;
+    }
+
+    /**
+     * @brief Set projection matrix
+     * @return Reference to self (for method chaining)
+     */
+    PhongDrawUniform& setProjectionMatrix(const Matrix4& matrix) {
+        projectionMatrix = matrix;
+        return *this;
+    }
+
+    /**
+     * @brief Set normal matrix
+     * @return Reference to self (for method chaining)
+     */
+    PhongDrawUniform& setNormalMatrix(const Matrix3x3& matrix) {
+        for(std::size_t i = 0; i != 3; ++i)
+            normalMatrix[i] = Vector4{matrix[i], 0.0f};
+        return *this;
+    }
+
+    /**
+     * @brief Set ambient color
+     * @return Reference to self (for method chaining)
+     */
+    PhongDrawUniform& setAmbientColor(const Color4& color) {
+        ambientColor = color;
+        return *this;
+    }
+
+    /**
+     * @brief Set diffuse color
+     * @return Reference to self (for method chaining)
+     */
+    PhongDrawUniform& setDiffuseColor(const Color4& color) {
+        diffuseColor = color;
+        return *this;
+    }
+
+    /**
+     * @brief Set specular color
+     * @return Reference to self (for method chaining)
+     */
+    PhongDrawUniform& setSpecularColor(const Color4& color) {
+        specularColor = color;
+        return *this;
+    }
+
+    /**
+     * @brief Set light color
+     * @return Reference to self (for method chaining)
+     */
+    PhongDrawUniform& setLightColor(const Color4& color) {
+        lightColor = color;
+        return *this;
+    }
+
+    /**
+     * @brief Set light position
+     * @return Reference to self (for method chaining)
+     */
+    PhongDrawUniform& setLightPosition(const Vector3& position) {
+        light = position;
+        return *this;
+    }
+
+    /**
+     * @brief Set shininess
+     * @return Reference to self (for method chaining)
+     */
+    PhongDrawUniform& setShininess(Float shininess) {
+        this->shininess = shininess;
+        return *this;
+    }
+
+    /** @brief Transformation matrix */
+    Matrix4 transformationMatrix;
+
+    /** @brief Projection matrix */
+    Matrix4 projectionMatrix;
+
+    /** @brief Normal matrix columns */
+    Vector4 normalMatrix[3]{
+        Vector4{1.0f, 0.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 1.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 0.0f, 1.0f, 0.0f}};
+
+    /**
+     * @brief Ambient color
+     *
+     * Set it to `{1.0f, 1.0f, 1.0f, 1.0f}` if
+     * @ref Phong::Flag::AmbientTexture is used.
+     */
+    Color4 ambientColor{0.0f, 1.0f};
+
+    /** @brief Diffuse color */
+    Color4 diffuseColor{1.0f};
+
+    /** @brief Specular color */
+    Color4 specularColor{1.0f};
+
+    /** @brief Light color */
+    Color4 lightColor{1.0f};
+
+    /** @brief Light position */
+    Vector3 light;
+
+    /** @brief Shininess */
+    Float shininess{80.0f};
+};
+
+static_assert(sizeof(PhongDrawUniform) == 256, "PhongDrawUniform doesn't match std140 layout");
+#endif
+
 /**
 @brief Phong shader
 
@@ -145,6 +283,102 @@ shader.setTextures(&diffuseAlphaTexture, &diffuseAlphaTexture, nullptr)
     .setSpecularColor(Color4{specularRgb, 0.0f});
 @endcode
 
+### Uniform buffers
+
+With @ref Flag::UniformBuffers the transformation, light and material
+parameters are taken from an array of @ref PhongDrawUniform structures in a
+uniform buffer instead of individual uniforms, the uniform setters can't be
+used in that case. The buffer is bound with @ref bindDrawBuffer() and the
+array index is set via @ref setDrawOffset(), see
+@ref Flat-uniform-buffers "Flat shader docs" for an example.
+
+### Skinning
+
+With @ref Flag::Skinned each vertex is transformed by a weighted blend of up
+to four joint matrices before the transformation matrix is applied. The joint
+indices and weights are taken from the @ref JointIds and @ref JointWeights
+attributes, the joint matrices from an array of @ref Matrix4 in a uniform
+buffer bound with @ref bindJointBuffer(). The array size is given by the
+`jointCount` constructor parameter. When animating many characters, put the
+palettes of all of them into a single buffer and bind a range of it for each
+draw. The palettes can be computed from keyframe tracks using
+@ref SceneGraph::Skeleton::jointMatrices().
+
+@code
+Shaders::Phong shader{Shaders::Phong::Flag::Skinned, 1, 64};
+
+Buffer joints;
+Containers::Array<Matrix4> palette{skeleton.jointCount()};
+skeleton.jointMatrices(time, hints, palette);
+joints.setData(palette, BufferUsage::StreamDraw);
+
+shader.bindJointBuffer(joints)
+    .setTransformationMatrix(transformationMatrix)
+    ...;
+mesh.draw(shader);
+@endcode
+
+### Clustered lights
+
+With @ref Flag::ClusteredLights the shader additionally takes an arbitrary
+number of point lights from a shader storage buffer. The view frustum is
+divided into a grid of clusters, @ref LightClusters assigns the lights to them
+on the CPU and each fragment then loops only over the lights in its own
+cluster. The lights are in view space, each of them contributes a diffuse and
+specular term scaled by its color and a smooth falloff reaching zero at its
+range, in addition to the light set by @ref setLightPosition(). The cluster
+grid is passed via @ref setLightClusters() and the three buffers are bound with
+@ref bindLightBuffer(), @ref bindLightClusterBuffer() and
+@ref bindLightIndexBuffer(), see @ref LightClusters for an example.
+
+@anchor Phong-multiview
+### Multiview stereo rendering
+
+With @ref Flag::Multiview the shader renders to both views of a multiview
+framebuffer in a single draw call. The projection matrix is replaced with a
+pair of view projection matrices set via @ref setViewProjectionMatrices(),
+the vertex shader picks one of them based on `gl_ViewID_OVR`. The
+transformation matrix, normal matrix and light position are shared by both
+views and thus the lighting is calculated relative to the head and not to
+each eye, see @ref Flat-multiview "Flat shader docs" for an example.
+
+@anchor Phong-gbuffer
+### Deferred shading
+
+With @ref Flag::GBufferOutput the shader doesn't calculate any lighting.
+Instead, the ambient color is written to @ref ColorOutput and the diffuse
+color, specular intensity, view-space normal and shininess are written to
+@ref AlbedoOutput and @ref NormalOutput of a @ref GBuffer. The lights are then
+accumulated on top of the ambient color with @ref DeferredLight, which uses
+the same lighting equation, see @ref GBuffer for an example. The light
+position and color set on this shader are ignored in that case and the
+specular color is reduced to its average intensity.
+
+@anchor Phong-flat-shading
+### Flat shading
+
+Faceted look is usually achieved by generating per-face normals with
+@ref MeshTools::generateFlatNormals() and duplicating all vertices so no two
+faces share one, which triples the vertex count. With @ref Flag::FlatShading
+the normal is not interpolated and the whole triangle uses the normal of its
+last vertex, so it's enough to make each face end with a distinct vertex
+holding its normal:
+
+@code
+std::vector<UnsignedInt> indices;
+std::vector<Vector3> positions;
+
+std::vector<UnsignedInt> vertices;
+std::vector<Vector3> normals;
+std::tie(vertices, normals) = MeshTools::generateProvokingFlatNormals(indices, positions);
+positions = MeshTools::duplicate(vertices, positions);
+
+Shaders::Phong shader{Shaders::Phong::Flag::FlatShading};
+@endcode
+
+The mesh is expected to be drawn with the default last vertex provoking
+convention.
+
 @see @ref shaders
 */
 class MAGNUM_SHADERS_EXPORT Phong: public AbstractShaderProgram {
@@ -163,6 +397,14 @@ class MAGNUM_SHADERS_EXPORT Phong: public AbstractShaderProgram {
          */
         typedef Generic3D::Normal Normal;
 
+        /**
+         * @brief Octahedral normal direction
+         *
+         * @ref shaders-generic "Generic attribute", @ref Vector2. Used
+         * instead of @ref Normal if @ref Flag::OctahedralNormal is set.
+         */
+        typedef Generic3D::OctahedralNormal OctahedralNormal;
+
         /**
          * @brief 2D texture coordinates
          *
@@ -172,15 +414,221 @@ class MAGNUM_SHADERS_EXPORT Phong: public AbstractShaderProgram {
          */
         typedef Generic3D::TextureCoordinates TextureCoordinates;
 
+        /**
+         * @brief Vertex color
+         *
+         * @ref shaders-generic "Generic attribute", @ref Color4. Used only if
+         * @ref Flag::VertexColor is set, can be either per-vertex or
+         * per-instance.
+         */
+        typedef Generic3D::Color Color;
+
+        /**
+         * @brief Instanced transformation matrix
+         *
+         * @ref shaders-generic "Generic attribute", @ref Matrix4. Used only
+         * if @ref Flag::InstancedTransformation is set.
+         * @requires_gl33 Extension @extension{ARB,instanced_arrays}
+         * @requires_gles30 Extension @es_extension{ANGLE,instanced_arrays},
+         *      @es_extension{EXT,instanced_arrays} or
+         *      @es_extension{NV,instanced_arrays} in OpenGL ES 2.0.
+         * @requires_webgl20 Extension @webgl_extension{ANGLE,instanced_arrays}
+         *      in WebGL 1.0.
+         */
+        typedef Generic3D::TransformationMatrix TransformationMatrix;
+
+        /**
+         * @brief Instanced normal matrix
+         *
+         * @ref shaders-generic "Generic attribute", @ref Matrix3x3. Used only
+         * if @ref Flag::InstancedTransformation is set.
+         * @requires_gl33 Extension @extension{ARB,instanced_arrays}
+         * @requires_gles30 Extension @es_extension{ANGLE,instanced_arrays},
+         *      @es_extension{EXT,instanced_arrays} or
+         *      @es_extension{NV,instanced_arrays} in OpenGL ES 2.0.
+         * @requires_webgl20 Extension @webgl_extension{ANGLE,instanced_arrays}
+         *      in WebGL 1.0.
+         */
+        typedef Generic3D::NormalMatrix NormalMatrix;
+
+        #if !defined(MAGNUM_TARGET_GLES2) || defined(DOXYGEN_GENERATING_OUTPUT)
+        /**
+         * @brief Joint indices
+         *
+         * @ref shaders-generic "Generic attribute", @ref Vector4ui. Used
+         * only if @ref Flag::Skinned is set.
+         * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Integer attributes are not available in OpenGL
+         *      ES 2.0.
+         * @requires_webgl20 Integer attributes are not available in WebGL
+         *      1.0.
+         */
+        typedef Generic3D::JointIds JointIds;
+
+        /**
+         * @brief Joint weights
+         *
+         * @ref shaders-generic "Generic attribute", @ref Vector4. Used only
+         * if @ref Flag::Skinned is set.
+         * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Skinning is not available in OpenGL ES 2.0.
+         * @requires_webgl20 Skinning is not available in WebGL 1.0.
+         */
+        typedef Generic3D::JointWeights JointWeights;
+        #endif
+
+        enum: UnsignedInt {
+            /**
+             * Color shader output, present always. With
+             * @ref Flag::GBufferOutput contains just the ambient color.
+             * Expects three- or four-component floating point or normalized
+             * buffer attachment.
+             */
+            ColorOutput = 0,
+
+            #if !defined(MAGNUM_TARGET_GLES2) || defined(DOXYGEN_GENERATING_OUTPUT)
+            /**
+             * Diffuse color in RGB and specular intensity in alpha. Present
+             * only if @ref Flag::GBufferOutput is set. Expects a
+             * four-component normalized buffer attachment.
+             * @requires_gl30 Extension @extension{EXT,gpu_shader4}
+             * @requires_gles30 Multiple fragment shader outputs are not
+             *      available in OpenGL ES 2.0.
+             * @requires_webgl20 Multiple fragment shader outputs are not
+             *      available in WebGL 1.0.
+             */
+            AlbedoOutput = 1,
+
+            /**
+             * Octahedral-encoded view-space normal in RG and shininess
+             * divided by `1023.0` in B. Present only if
+             * @ref Flag::GBufferOutput is set. Expects a three- or
+             * four-component normalized buffer attachment with at least 10
+             * bits per channel, such as @ref TextureFormat::RGB10A2.
+             * @requires_gl30 Extension @extension{EXT,gpu_shader4}
+             * @requires_gles30 Multiple fragment shader outputs are not
+             *      available in OpenGL ES 2.0.
+             * @requires_webgl20 Multiple fragment shader outputs are not
+             *      available in WebGL 1.0.
+             */
+            NormalOutput = 2
+            #endif
+        };
+
         /**
          * @brief Flag
          *
          * @see @ref Flags, @ref flags()
          */
-        enum class Flag: UnsignedByte {
+        enum class Flag: UnsignedShort {
             AmbientTexture = 1 << 0,    /**< The shader uses ambient texture instead of color */
             DiffuseTexture = 1 << 1,    /**< The shader uses diffuse texture instead of color */
-            SpecularTexture = 1 << 2    /**< The shader uses specular texture instead of color */
+            SpecularTexture = 1 << 2,   /**< The shader uses specular texture instead of color */
+
+            #if !defined(MAGNUM_TARGET_GLES2) || defined(DOXYGEN_GENERATING_OUTPUT)
+            /**
+             * Take per-draw data from a uniform buffer instead of
+             * individual uniforms. See @ref Flat-uniform-buffers for more
+             * information, the per-draw structure is @ref PhongDrawUniform.
+             * Textures, if enabled, are shared by all draws.
+             * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+             * @requires_gles30 Uniform buffers are not available in OpenGL
+             *      ES 2.0.
+             * @requires_webgl20 Uniform buffers are not available in WebGL
+             *      1.0.
+             */
+            UniformBuffers = 1 << 3,
+            #endif
+
+            /**
+             * Multiply the ambient and diffuse color with the @ref Color
+             * attribute. Together with @ref Mesh::addVertexBufferInstanced()
+             * gives per-instance colors.
+             */
+            VertexColor = 1 << 4,
+
+            /**
+             * Multiply the transformation and normal matrix with the
+             * per-instance @ref TransformationMatrix and @ref NormalMatrix
+             * attributes. See @ref Flat-instancing for an example.
+             */
+            InstancedTransformation = 1 << 5,
+
+            /**
+             * Take normals from the two-component @ref OctahedralNormal
+             * attribute instead of @ref Normal and decode them in the
+             * vertex shader. See @ref MeshTools::quantizeNormalsOctahedral()
+             * for more information.
+             */
+            OctahedralNormal = 1 << 6,
+
+            #if !defined(MAGNUM_TARGET_GLES2) || defined(DOXYGEN_GENERATING_OUTPUT)
+            /**
+             * Blend the position and normal with joint matrices from a
+             * uniform buffer, weighted by the @ref JointIds and
+             * @ref JointWeights attributes. See @ref Phong-skinning for
+             * more information.
+             * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+             * @requires_gles30 Uniform buffers are not available in OpenGL
+             *      ES 2.0.
+             * @requires_webgl20 Uniform buffers are not available in WebGL
+             *      1.0.
+             */
+            Skinned = 1 << 7,
+            #endif
+
+            #if (!defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)) || defined(DOXYGEN_GENERATING_OUTPUT)
+            /**
+             * Add point lights binned into view-space clusters by
+             * @ref LightClusters. See @ref Phong-clustered-lights for more
+             * information.
+             * @requires_gl43 Extension @extension{ARB,shader_storage_buffer_object}
+             * @requires_gles31 Shader storage is not available in OpenGL
+             *      ES 3.0 and older.
+             * @requires_gles Shader storage is not available in WebGL.
+             */
+            ClusteredLights = 1 << 8,
+
+            /**
+             * Render to two views at once, selecting the view projection
+             * matrix based on `gl_ViewID_OVR`. Can't be combined with
+             * @ref Flag::UniformBuffers. See @ref Phong-multiview for more
+             * information.
+             * @requires_extension Extension @extension{OVR,multiview}
+             * @requires_es_extension Extension @extension{OVR,multiview}
+             * @requires_gles Multiview is not available in WebGL.
+             */
+            Multiview = 1 << 9,
+            #endif
+
+            #if !defined(MAGNUM_TARGET_GLES2) || defined(DOXYGEN_GENERATING_OUTPUT)
+            /**
+             * Write material properties into a G-buffer instead of
+             * calculating lighting. Can't be combined with
+             * @ref Flag::ClusteredLights. See @ref Phong-gbuffer for more
+             * information.
+             * @requires_gl30 Extension @extension{EXT,gpu_shader4}
+             * @requires_gles30 Multiple fragment shader outputs are not
+             *      available in OpenGL ES 2.0.
+             * @requires_webgl20 Multiple fragment shader outputs are not
+             *      available in WebGL 1.0.
+             */
+            GBufferOutput = 1 << 10,
+
+            /**
+             * Don't interpolate the normal, take it from the provoking
+             * (last) vertex of each triangle instead. Together with
+             * @ref MeshTools::generateProvokingFlatNormals() gives flat
+             * shading with little or no vertex duplication. See
+             * @ref Phong-flat-shading for more information.
+             * @requires_gl30 Extension @extension{EXT,gpu_shader4}
+             * @requires_gles30 Flat interpolation is not available in
+             *      OpenGL ES 2.0.
+             * @requires_webgl20 Flat interpolation is not available in
+             *      WebGL 1.0.
+             */
+            FlatShading = 1 << 11
+            #endif
         };
 
         /**
@@ -190,11 +638,58 @@ class MAGNUM_SHADERS_EXPORT Phong: public AbstractShaderProgram {
          */
         typedef Containers::EnumSet<Flag> Flags;
 
+        #if !defined(MAGNUM_TARGET_GLES2) || defined(DOXYGEN_GENERATING_OUTPUT)
+        /**
+         * @brief Per-draw uniform structure
+         *
+         * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        typedef PhongDrawUniform DrawUniform;
+        #endif
+
+        class CompileState;
+
+        /**
+         * @brief Submit compilation of the shader
+         * @param flags     Flags
+         * @param drawCount Size of the @ref DrawUniform array. Used only if
+         *      @ref Flag::UniformBuffers is set.
+         * @param jointCount Size of the joint matrix array. Used only if
+         *      @ref Flag::Skinned is set.
+         *
+         * Submits compilation and linking of the shader but doesn't wait for
+         * it to finish, so the driver can do the work in the background ---
+         * especially if @extension{KHR,parallel_shader_compile} is
+         * supported. Pass the returned value to @ref Phong(CompileState&&)
+         * to finish the construction.
+         * @see @ref Flat::compile()
+         */
+        static CompileState compile(Flags flags = {}, UnsignedInt drawCount = 1, UnsignedInt jointCount = 1);
+
         /**
          * @brief Constructor
          * @param flags     Flags
+         * @param drawCount Size of the @ref DrawUniform array. Used only if
+         *      @ref Flag::UniformBuffers is set.
+         * @param jointCount Size of the joint matrix array. Used only if
+         *      @ref Flag::Skinned is set.
+         *
+         * Equivalent to calling @ref Phong(CompileState&&) on the result of
+         * @ref compile().
+         */
+        explicit Phong(Flags flags = {}, UnsignedInt drawCount = 1, UnsignedInt jointCount = 1);
+
+        /**
+         * @brief Finalize an asynchronous compilation
+         *
+         * Takes an instance returned from @ref compile(), waits for the
+         * compilation and linking to finish, if not already, and queries
+         * uniform locations.
          */
-        explicit Phong(Flags flags = {});
+        explicit Phong(CompileState&& state);
 
         /**
          * @brief Construct without creating the underlying OpenGL object
@@ -211,6 +706,165 @@ class MAGNUM_SHADERS_EXPORT Phong: public AbstractShaderProgram {
         /** @brief Flags */
         Flags flags() const { return _flags; }
 
+        #if !defined(MAGNUM_TARGET_GLES2) || defined(DOXYGEN_GENERATING_OUTPUT)
+        /**
+         * @brief Draw count
+         *
+         * Size of the @ref DrawUniform array if @ref Flag::UniformBuffers
+         * is set, `1` otherwise.
+         * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        UnsignedInt drawCount() const { return _drawCount; }
+
+        /**
+         * @brief Set draw offset
+         * @return Reference to self (for method chaining)
+         *
+         * Index of the @ref DrawUniform used for the next draw. If
+         * @extension{ARB,shader_draw_parameters} is supported, the draw ID
+         * of the multi-draw is added to it. Initial value is `0`. Expects
+         * that @ref Flag::UniformBuffers is set.
+         * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Phong& setDrawOffset(UnsignedInt offset);
+
+        /**
+         * @brief Bind a draw uniform buffer
+         * @return Reference to self (for method chaining)
+         *
+         * The buffer is expected to contain @ref drawCount() instances of
+         * @ref DrawUniform. Expects that @ref Flag::UniformBuffers is set.
+         * @see @ref Buffer::bind(Buffer::Target, UnsignedInt)
+         * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Phong& bindDrawBuffer(Buffer& buffer);
+
+        /**
+         * @brief Bind a range of a draw uniform buffer
+         * @return Reference to self (for method chaining)
+         *
+         * The @p offset has to be aligned to @ref Buffer::uniformOffsetAlignment().
+         * Expects that @ref Flag::UniformBuffers is set.
+         * @see @ref Buffer::bind(Buffer::Target, UnsignedInt, GLintptr, GLsizeiptr)
+         * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Phong& bindDrawBuffer(Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Joint count
+         *
+         * Size of the joint matrix array if @ref Flag::Skinned is set, `0`
+         * otherwise.
+         * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        UnsignedInt jointCount() const { return _jointCount; }
+
+        /**
+         * @brief Bind a joint matrix uniform buffer
+         * @return Reference to self (for method chaining)
+         *
+         * The buffer is expected to contain @ref jointCount() instances of
+         * @ref Matrix4. Expects that @ref Flag::Skinned is set.
+         * @see @ref Buffer::bind(Buffer::Target, UnsignedInt)
+         * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Phong& bindJointBuffer(Buffer& buffer);
+
+        /**
+         * @brief Bind a range of a joint matrix uniform buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Useful for keeping palettes of many skinned meshes in a single
+         * buffer. The @p offset has to be aligned to
+         * @ref Buffer::uniformOffsetAlignment(). Expects that
+         * @ref Flag::Skinned is set.
+         * @see @ref Buffer::bind(Buffer::Target, UnsignedInt, GLintptr, GLsizeiptr)
+         * @requires_gl31 Extension @extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Phong& bindJointBuffer(Buffer& buffer, GLintptr offset, GLsizeiptr size);
+        #endif
+
+        #if (!defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)) || defined(DOXYGEN_GENERATING_OUTPUT)
+        /**
+         * @brief Set light cluster grid
+         * @return Reference to self (for method chaining)
+         *
+         * Takes the cluster count and depth slicing from @p clusters, the
+         * @p viewportSize is used to map fragment coordinates to cluster
+         * tiles. Has to be called again when the projection or viewport
+         * changes. Expects that @ref Flag::ClusteredLights is set.
+         * @requires_gl43 Extension @extension{ARB,shader_storage_buffer_object}
+         * @requires_gles31 Shader storage is not available in OpenGL ES
+         *      3.0 and older.
+         * @requires_gles Shader storage is not available in WebGL.
+         */
+        Phong& setLightClusters(const LightClusters& clusters, const Vector2i& viewportSize);
+
+        /**
+         * @brief Bind a light shader storage buffer
+         * @return Reference to self (for method chaining)
+         *
+         * The buffer is expected to contain the same array of
+         * @ref ClusteredLight that was passed to @ref LightClusters::bin().
+         * Expects that @ref Flag::ClusteredLights is set.
+         * @see @ref Buffer::bind(Buffer::Target, UnsignedInt)
+         * @requires_gl43 Extension @extension{ARB,shader_storage_buffer_object}
+         * @requires_gles31 Shader storage is not available in OpenGL ES
+         *      3.0 and older.
+         * @requires_gles Shader storage is not available in WebGL.
+         */
+        Phong& bindLightBuffer(Buffer& buffer);
+
+        /**
+         * @brief Bind a light cluster shader storage buffer
+         * @return Reference to self (for method chaining)
+         *
+         * The buffer is expected to contain @ref LightClusters::clusters().
+         * Expects that @ref Flag::ClusteredLights is set.
+         * @see @ref Buffer::bind(Buffer::Target, UnsignedInt)
+         * @requires_gl43 Extension @extension{ARB,shader_storage_buffer_object}
+         * @requires_gles31 Shader storage is not available in OpenGL ES
+         *      3.0 and older.
+         * @requires_gles Shader storage is not available in WebGL.
+         */
+        Phong& bindLightClusterBuffer(Buffer& buffer);
+
+        /**
+         * @brief Bind a light index shader storage buffer
+         * @return Reference to self (for method chaining)
+         *
+         * The buffer is expected to contain @ref LightClusters::lightIndices().
+         * Expects that @ref Flag::ClusteredLights is set.
+         * @see @ref Buffer::bind(Buffer::Target, UnsignedInt)
+         * @requires_gl43 Extension @extension{ARB,shader_storage_buffer_object}
+         * @requires_gles31 Shader storage is not available in OpenGL ES
+         *      3.0 and older.
+         * @requires_gles Shader storage is not available in WebGL.
+         */
+        Phong& bindLightIndexBuffer(Buffer& buffer);
+        #endif
+
         /**
          * @brief Set ambient color
          * @return Reference to self (for method chaining)
@@ -221,6 +875,10 @@ class MAGNUM_SHADERS_EXPORT Phong: public AbstractShaderProgram {
          * @see @ref setAmbientTexture()
          */
         Phong& setAmbientColor(const Color4& color) {
+            #ifndef MAGNUM_TARGET_GLES2
+            CORRADE_ASSERT(!(_flags & Flag::UniformBuffers),
+                "Shaders::Phong::setAmbientColor(): the shader was created with uniform buffers enabled", *this);
+            #endif
             setUniform(_ambientColorUniform, color);
             return *this;
         }
@@ -244,6 +902,10 @@ class MAGNUM_SHADERS_EXPORT Phong: public AbstractShaderProgram {
          * @see @ref setDiffuseTexture()
          */
         Phong& setDiffuseColor(const Color4& color) {
+            #ifndef MAGNUM_TARGET_GLES2
+            CORRADE_ASSERT(!(_flags & Flag::UniformBuffers),
+                "Shaders::Phong::setDiffuseColor(): the shader was created with uniform buffers enabled", *this);
+            #endif
             setUniform(_diffuseColorUniform, color);
             return *this;
         }
@@ -267,6 +929,10 @@ class MAGNUM_SHADERS_EXPORT Phong: public AbstractShaderProgram {
          * @see @ref setSpecularTexture()
          */
         Phong& setSpecularColor(const Color4& color) {
+            #ifndef MAGNUM_TARGET_GLES2
+            CORRADE_ASSERT(!(_flags & Flag::UniformBuffers),
+                "Shaders::Phong::setSpecularColor(): the shader was created with uniform buffers enabled", *this);
+            #endif
             setUniform(_specularColorUniform, color);
             return *this;
         }
@@ -300,6 +966,10 @@ class MAGNUM_SHADERS_EXPORT Phong: public AbstractShaderProgram {
          * If not set, default value is `80.0f`.
          */
         Phong& setShininess(Float shininess) {
+            #ifndef MAGNUM_TARGET_GLES2
+            CORRADE_ASSERT(!(_flags & Flag::UniformBuffers),
+                "Shaders::Phong::setShininess(): the shader was created with uniform buffers enabled", *this);
+            #endif
             setUniform(_shininessUniform, shininess);
             return *this;
         }
@@ -309,6 +979,10 @@ class MAGNUM_SHADERS_EXPORT Phong: public AbstractShaderProgram {
          * @return Reference to self (for method chaining)
          */
         Phong& setTransformationMatrix(const Matrix4& matrix) {
+            #ifndef MAGNUM_TARGET_GLES2
+            CORRADE_ASSERT(!(_flags & Flag::UniformBuffers),
+                "Shaders::Phong::setTransformationMatrix(): the shader was created with uniform buffers enabled", *this);
+            #endif
             setUniform(_transformationMatrixUniform, matrix);
             return *this;
         }
@@ -321,6 +995,10 @@ class MAGNUM_SHADERS_EXPORT Phong: public AbstractShaderProgram {
          * must be done in the shader anyway.
          */
         Phong& setNormalMatrix(const Matrix3x3& matrix) {
+            #ifndef MAGNUM_TARGET_GLES2
+            CORRADE_ASSERT(!(_flags & Flag::UniformBuffers),
+                "Shaders::Phong::setNormalMatrix(): the shader was created with uniform buffers enabled", *this);
+            #endif
             setUniform(_normalMatrixUniform, matrix);
             return *this;
         }
@@ -330,15 +1008,43 @@ class MAGNUM_SHADERS_EXPORT Phong: public AbstractShaderProgram {
          * @return Reference to self (for method chaining)
          */
         Phong& setProjectionMatrix(const Matrix4& matrix) {
+            #ifndef MAGNUM_TARGET_GLES2
+            CORRADE_ASSERT(!(_flags & Flag::UniformBuffers),
+                "Shaders::Phong::setProjectionMatrix(): the shader was created with uniform buffers enabled", *this);
+            #endif
+            #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+            CORRADE_ASSERT(!(_flags & Flag::Multiview),
+                "Shaders::Phong::setProjectionMatrix(): the shader was created with multiview enabled", *this);
+            #endif
             setUniform(_projectionMatrixUniform, matrix);
             return *this;
         }
 
+        #if (!defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)) || defined(DOXYGEN_GENERATING_OUTPUT)
+        /**
+         * @brief Set view projection matrices of both views
+         * @return Reference to self (for method chaining)
+         *
+         * Used in place of @ref setProjectionMatrix() if
+         * @ref Flag::Multiview is set, expects that the flag is set. The
+         * @p first matrix is used for view `0`, the @p second for view `1`.
+         * @see @ref SceneGraph::BasicStereoCamera3D::viewProjectionMatrix()
+         * @requires_extension Extension @extension{OVR,multiview}
+         * @requires_es_extension Extension @extension{OVR,multiview}
+         * @requires_gles Multiview is not available in WebGL.
+         */
+        Phong& setViewProjectionMatrices(const Matrix4& first, const Matrix4& second);
+        #endif
+
         /**
          * @brief Set light position
          * @return Reference to self (for method chaining)
          */
         Phong& setLightPosition(const Vector3& light) {
+            #ifndef MAGNUM_TARGET_GLES2
+            CORRADE_ASSERT(!(_flags & Flag::UniformBuffers),
+                "Shaders::Phong::setLightPosition(): the shader was created with uniform buffers enabled", *this);
+            #endif
             setUniform(_lightUniform, light);
             return *this;
         }
@@ -350,12 +1056,29 @@ class MAGNUM_SHADERS_EXPORT Phong: public AbstractShaderProgram {
          * If not set, default value is `{1.0f, 1.0f, 1.0f, 1.0f}`.
          */
         Phong& setLightColor(const Color4& color) {
+            #ifndef MAGNUM_TARGET_GLES2
+            CORRADE_ASSERT(!(_flags & Flag::UniformBuffers),
+                "Shaders::Phong::setLightColor(): the shader was created with uniform buffers enabled", *this);
+            #endif
             setUniform(_lightColorUniform, color);
             return *this;
         }
 
     private:
+        /* Creates the GL object but doesn't compile anything, used by
+           compile() */
+        explicit Phong(Math::NoInitT) {}
+
         Flags _flags;
+        #ifndef MAGNUM_TARGET_GLES2
+        UnsignedInt _drawCount{1}, _jointCount{0};
+        Int _drawOffsetUniform{9};
+        #endif
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        Int _clusterCountUniform{10},
+            _clusterScaleUniform{11},
+            _viewProjectionMatricesUniform{12};
+        #endif
         Int _transformationMatrixUniform{0},
             _projectionMatrixUniform{1},
             _normalMatrixUniform{2},
@@ -367,6 +1090,24 @@ class MAGNUM_SHADERS_EXPORT Phong: public AbstractShaderProgram {
             _shininessUniform{8};
 };
 
+/**
+@brief Asynchronous compilation state
+
+Returned by @ref Phong::compile(), holds the shader sources until they're
+compiled and linked. Pass it to @ref Phong::Phong(CompileState&&) to finish
+the construction.
+*/
+class Phong::CompileState: public Phong {
+    private:
+        friend Phong;
+
+        explicit CompileState(Phong&& shader, Shader&& vert, Shader&& frag, Version version, bool loaded): Phong{std::move(shader)}, _vert{std::move(vert)}, _frag{std::move(frag)}, _version{version}, _loaded{loaded} {}
+
+        Shader _vert, _frag;
+        Version _version;
+        bool _loaded;
+};
+
 CORRADE_ENUMSET_OPERATORS(Phong::Flags)
 
 }}
@@ -23,20 +23,38 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#if defined(UNIFORM_BUFFERS) && !defined(GL_ES) && defined(GL_ARB_shader_draw_parameters) && !defined(DISABLE_GL_ARB_shader_draw_parameters)
+#extension GL_ARB_shader_draw_parameters: enable
+#define SHADER_DRAW_PARAMETERS
+#endif
+
+#ifdef MULTIVIEW
+#extension GL_OVR_multiview: require
+layout(num_views = 2) in;
+#endif
+
 #ifndef NEW_GLSL
 #define in attribute
 #define out varying
 #endif
 
+#ifndef UNIFORM_BUFFERS
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 0)
 #endif
 uniform highp mat4 transformationMatrix;
 
+#ifdef MULTIVIEW
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 12)
+#endif
+uniform highp mat4 viewProjectionMatrices[2];
+#else
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 1)
 #endif
 uniform highp mat4 projectionMatrix;
+#endif
 
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 2)
@@ -47,6 +65,39 @@ uniform mediump mat3 normalMatrix;
 layout(location = 3)
 #endif
 uniform highp vec3 light;
+#else
+struct DrawUniform {
+    highp mat4 transformationMatrix;
+    highp mat4 projectionMatrix;
+    mediump mat3 normalMatrix;
+    lowp vec4 ambientColor;
+    lowp vec4 diffuseColor;
+    lowp vec4 specularColor;
+    lowp vec4 lightColor;
+    highp vec3 light;
+    mediump float shininess;
+};
+
+#ifdef EXPLICIT_BINDING
+layout(std140, binding = 0)
+#else
+layout(std140)
+#endif
+uniform Draw {
+    DrawUniform draws[DRAW_COUNT];
+};
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 9)
+#endif
+uniform highp uint drawOffset;
+
+flat out lowp vec4 interpolatedAmbientColor;
+flat out lowp vec4 interpolatedDiffuseColor;
+flat out lowp vec4 interpolatedSpecularColor;
+flat out lowp vec4 interpolatedLightColor;
+flat out mediump float interpolatedShininess;
+#endif
 
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = POSITION_ATTRIBUTE_LOCATION)
@@ -56,7 +107,11 @@ in highp vec4 position;
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = NORMAL_ATTRIBUTE_LOCATION)
 #endif
+#ifdef OCTAHEDRAL_NORMAL
+in mediump vec2 normal;
+#else
 in mediump vec3 normal;
+#endif
 
 #ifdef TEXTURED
 #ifdef EXPLICIT_ATTRIB_LOCATION
@@ -67,17 +122,112 @@ in mediump vec2 textureCoords;
 out mediump vec2 interpolatedTextureCoords;
 #endif
 
+#ifdef VERTEX_COLOR
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = COLOR_ATTRIBUTE_LOCATION)
+#endif
+in lowp vec4 vertexColor;
+
+out lowp vec4 interpolatedVertexColor;
+#endif
+
+#ifdef INSTANCED_TRANSFORMATION
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = TRANSFORMATION_MATRIX_ATTRIBUTE_LOCATION)
+#endif
+in highp mat4 instancedTransformationMatrix;
+
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = NORMAL_MATRIX_ATTRIBUTE_LOCATION)
+#endif
+in mediump mat3 instancedNormalMatrix;
+#endif
+
+#ifdef SKINNED
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = JOINTIDS_ATTRIBUTE_LOCATION)
+#endif
+in mediump uvec4 jointIds;
+
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = JOINTWEIGHTS_ATTRIBUTE_LOCATION)
+#endif
+in mediump vec4 jointWeights;
+
+#ifdef EXPLICIT_BINDING
+layout(std140, binding = 1)
+#else
+layout(std140)
+#endif
+uniform Joint {
+    highp mat4 jointMatrices[JOINT_COUNT];
+};
+#endif
+
+#ifdef FLAT_SHADING
+flat
+#endif
 out mediump vec3 transformedNormal;
 out highp vec3 lightDirection;
 out highp vec3 cameraDirection;
 
 void main() {
+    #ifdef UNIFORM_BUFFERS
+    highp uint drawId = drawOffset
+        #ifdef SHADER_DRAW_PARAMETERS
+        + uint(gl_DrawIDARB)
+        #endif
+        ;
+    highp mat4 transformationMatrix = draws[drawId].transformationMatrix;
+    highp mat4 projectionMatrix = draws[drawId].projectionMatrix;
+    mediump mat3 normalMatrix = draws[drawId].normalMatrix;
+    highp vec3 light = draws[drawId].light;
+    interpolatedAmbientColor = draws[drawId].ambientColor;
+    interpolatedDiffuseColor = draws[drawId].diffuseColor;
+    interpolatedSpecularColor = draws[drawId].specularColor;
+    interpolatedLightColor = draws[drawId].lightColor;
+    interpolatedShininess = draws[drawId].shininess;
+    #endif
+
+    #ifdef SKINNED
+    /* Blend of joint matrices influencing the vertex */
+    highp mat4 skinMatrix =
+        jointWeights.x*jointMatrices[jointIds.x] +
+        jointWeights.y*jointMatrices[jointIds.y] +
+        jointWeights.z*jointMatrices[jointIds.z] +
+        jointWeights.w*jointMatrices[jointIds.w];
+    #endif
+
     /* Transformed vertex position */
-    highp vec4 transformedPosition4 = transformationMatrix*position;
+    highp vec4 transformedPosition4 = transformationMatrix*
+        #ifdef INSTANCED_TRANSFORMATION
+        instancedTransformationMatrix*
+        #endif
+        #ifdef SKINNED
+        skinMatrix*
+        #endif
+        position;
     highp vec3 transformedPosition = transformedPosition4.xyz/transformedPosition4.w;
 
+    #ifdef OCTAHEDRAL_NORMAL
+    /* Unfold the octahedron, the result doesn't need to be normalized as
+       it's done in the fragment shader */
+    mediump vec3 decodedNormal = vec3(normal, 1.0 - abs(normal.x) - abs(normal.y));
+    if(decodedNormal.z < 0.0)
+        decodedNormal.xy = (1.0 - abs(normal.yx))*(step(0.0, normal)*2.0 - 1.0);
+    #else
+    mediump vec3 decodedNormal = normal;
+    #endif
+
     /* Transformed normal vector */
-    transformedNormal = normalMatrix*normal;
+    transformedNormal = normalMatrix*
+        #ifdef INSTANCED_TRANSFORMATION
+        instancedNormalMatrix*
+        #endif
+        #ifdef SKINNED
+        mat3(skinMatrix)*
+        #endif
+        decodedNormal;
 
     /* Direction to the light */
     lightDirection = normalize(light - transformedPosition);
@@ -85,11 +235,21 @@ void main() {
     /* Direction to the camera */
     cameraDirection = -transformedPosition;
 
-    /* Transform the position */
+    /* Transform the position, picking the view projection matrix for the
+       view being rendered in case of multiview */
+    #ifdef MULTIVIEW
+    gl_Position = viewProjectionMatrices[gl_ViewID_OVR]*transformedPosition4;
+    #else
     gl_Position = projectionMatrix*transformedPosition4;
+    #endif
 
     #ifdef TEXTURED
     /* Texture coordinates, if needed */
     interpolatedTextureCoords = textureCoords;
     #endif
+
+    #ifdef VERTEX_COLOR
+    /* Vertex color, if needed */
+    interpolatedVertexColor = vertexColor;
+    #endif
 }
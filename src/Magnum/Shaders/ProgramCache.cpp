@@ -0,0 +1,112 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ProgramCache.h"
+
+namespace Magnum { namespace Shaders {
+
+enum class ProgramCache::Type: UnsignedByte {
+    Flat2D,
+    Flat3D,
+    VertexColor2D,
+    VertexColor3D,
+    Phong,
+    MeshVisualizer
+};
+
+ProgramCache::ProgramCache() = default;
+
+ProgramCache::ProgramCache(ProgramCache&&) noexcept = default;
+
+ProgramCache::~ProgramCache() = default;
+
+ProgramCache& ProgramCache::operator=(ProgramCache&&) noexcept = default;
+
+template<class T, class Create> std::shared_ptr<T> ProgramCache::get(const Key& key, Create create) {
+    auto found = _programs.find(key);
+    if(found != _programs.end()) {
+        ++_hitCount;
+        return std::static_pointer_cast<T>(found->second);
+    }
+
+    ++_missCount;
+    std::shared_ptr<T> program = create();
+    _programs.emplace(key, program);
+    return program;
+}
+
+std::shared_ptr<Flat2D> ProgramCache::flat2D(const Flat2D::Flags flags, const UnsignedInt drawCount) {
+    return get<Flat2D>(Key{Type::Flat2D, std::uint64_t(Flat2D::Flags::UnderlyingType(flags)), drawCount, 0}, [&]() {
+        return std::make_shared<Flat2D>(flags, drawCount);
+    });
+}
+
+std::shared_ptr<Flat3D> ProgramCache::flat3D(const Flat3D::Flags flags, const UnsignedInt drawCount) {
+    return get<Flat3D>(Key{Type::Flat3D, std::uint64_t(Flat3D::Flags::UnderlyingType(flags)), drawCount, 0}, [&]() {
+        return std::make_shared<Flat3D>(flags, drawCount);
+    });
+}
+
+std::shared_ptr<VertexColor2D> ProgramCache::vertexColor2D(const VertexColor2D::Flags flags) {
+    return get<VertexColor2D>(Key{Type::VertexColor2D, std::uint64_t(VertexColor2D::Flags::UnderlyingType(flags)), 0, 0}, [&]() {
+        return std::make_shared<VertexColor2D>(flags);
+    });
+}
+
+std::shared_ptr<VertexColor3D> ProgramCache::vertexColor3D(const VertexColor3D::Flags flags) {
+    return get<VertexColor3D>(Key{Type::VertexColor3D, std::uint64_t(VertexColor3D::Flags::UnderlyingType(flags)), 0, 0}, [&]() {
+        return std::make_shared<VertexColor3D>(flags);
+    });
+}
+
+std::shared_ptr<Phong> ProgramCache::phong(const Phong::Flags flags, const UnsignedInt drawCount, const UnsignedInt jointCount) {
+    return get<Phong>(Key{Type::Phong, std::uint64_t(Phong::Flags::UnderlyingType(flags)), drawCount, jointCount}, [&]() {
+        return std::make_shared<Phong>(flags, drawCount, jointCount);
+    });
+}
+
+std::shared_ptr<MeshVisualizer> ProgramCache::meshVisualizer(const MeshVisualizer::Flags flags) {
+    return get<MeshVisualizer>(Key{Type::MeshVisualizer, std::uint64_t(MeshVisualizer::Flags::UnderlyingType(flags)), 0, 0}, [&]() {
+        return std::make_shared<MeshVisualizer>(flags);
+    });
+}
+
+std::size_t ProgramCache::free() {
+    std::size_t count = 0;
+    for(auto it = _programs.begin(); it != _programs.end(); ) {
+        if(it->second.use_count() == 1) {
+            it = _programs.erase(it);
+            ++count;
+        } else ++it;
+    }
+
+    return count;
+}
+
+void ProgramCache::clear() {
+    _programs.clear();
+}
+
+}}
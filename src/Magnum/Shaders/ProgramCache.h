@@ -0,0 +1,184 @@
+#ifndef Magnum_Shaders_ProgramCache_h
+#define Magnum_Shaders_ProgramCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Shaders::ProgramCache
+ */
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <tuple>
+
+#include "Magnum/Shaders/Flat.h"
+#include "Magnum/Shaders/MeshVisualizer.h"
+#include "Magnum/Shaders/Phong.h"
+#include "Magnum/Shaders/VertexColor.h"
+#include "Magnum/Shaders/visibility.h"
+
+namespace Magnum { namespace Shaders {
+
+/**
+@brief Shared cache of builtin shader programs
+
+Every instance of a builtin shader owns its own GL program, so constructing
+e.g. a @ref Phong shader for each material compiles and links the very same
+program over and over again. This class keeps one program per shader type and
+variant --- i.e., flags and array sizes passed to the constructor --- and
+hands out shared references to it:
+@code
+Shaders::ProgramCache cache;
+
+std::shared_ptr<Shaders::Phong> a = cache.phong(Shaders::Phong::Flag::DiffuseTexture);
+std::shared_ptr<Shaders::Phong> b = cache.phong(Shaders::Phong::Flag::DiffuseTexture);
+// a and b point to the same program, only one was compiled
+@endcode
+
+As the program is shared, all uniforms are shared as well. Set all uniforms
+the draw depends on right before each draw instead of relying on values set
+by previous users of the same program.
+
+The programs are created through the usual shader constructors, so if a
+@ref ShaderProgramBinaryCache is made current, the first request for a
+variant loads the linked binary from it instead of compiling and all other
+requests for the same variant in the session don't touch the driver at all.
+
+The cache holds a reference to every program it created, so programs stay
+alive until @ref free() or @ref clear() is called or the cache is destroyed.
+The shared handles may outlive the cache. The cache is not thread-safe and
+has to be used from the thread owning the GL context.
+*/
+class MAGNUM_SHADERS_EXPORT ProgramCache {
+    public:
+        /** @brief Constructor */
+        explicit ProgramCache();
+
+        /** @brief Copying is not allowed */
+        ProgramCache(const ProgramCache&) = delete;
+
+        /** @brief Move constructor */
+        ProgramCache(ProgramCache&&) noexcept;
+
+        ~ProgramCache();
+
+        /** @brief Copying is not allowed */
+        ProgramCache& operator=(const ProgramCache&) = delete;
+
+        /** @brief Move assignment */
+        ProgramCache& operator=(ProgramCache&&) noexcept;
+
+        /** @brief Count of cached program variants */
+        std::size_t size() const { return _programs.size(); }
+
+        /** @brief Count of requests served from the cache */
+        UnsignedInt hitCount() const { return _hitCount; }
+
+        /** @brief Count of requests that created a new program */
+        UnsignedInt missCount() const { return _missCount; }
+
+        /**
+         * @brief Shared @ref Flat2D program
+         *
+         * Creates the program with @ref Flat::Flat(Flags, UnsignedInt) if a
+         * program with the same parameters isn't cached yet.
+         */
+        std::shared_ptr<Flat2D> flat2D(Flat2D::Flags flags = {}, UnsignedInt drawCount = 1);
+
+        /**
+         * @brief Shared @ref Flat3D program
+         *
+         * Creates the program with @ref Flat::Flat(Flags, UnsignedInt) if a
+         * program with the same parameters isn't cached yet.
+         */
+        std::shared_ptr<Flat3D> flat3D(Flat3D::Flags flags = {}, UnsignedInt drawCount = 1);
+
+        /**
+         * @brief Shared @ref VertexColor2D program
+         *
+         * Creates the program with @ref VertexColor::VertexColor(Flags) if a
+         * program with the same flags isn't cached yet.
+         */
+        std::shared_ptr<VertexColor2D> vertexColor2D(VertexColor2D::Flags flags = {});
+
+        /**
+         * @brief Shared @ref VertexColor3D program
+         *
+         * Creates the program with @ref VertexColor::VertexColor(Flags) if a
+         * program with the same flags isn't cached yet.
+         */
+        std::shared_ptr<VertexColor3D> vertexColor3D(VertexColor3D::Flags flags = {});
+
+        /**
+         * @brief Shared @ref Phong program
+         *
+         * Creates the program with
+         * @ref Phong::Phong(Flags, UnsignedInt, UnsignedInt) if a program
+         * with the same parameters isn't cached yet.
+         */
+        std::shared_ptr<Phong> phong(Phong::Flags flags = {}, UnsignedInt drawCount = 1, UnsignedInt jointCount = 1);
+
+        /**
+         * @brief Shared @ref MeshVisualizer program
+         *
+         * Creates the program with @ref MeshVisualizer::MeshVisualizer(Flags)
+         * if a program with the same flags isn't cached yet.
+         */
+        std::shared_ptr<MeshVisualizer> meshVisualizer(MeshVisualizer::Flags flags = {});
+
+        /**
+         * @brief Free unused programs
+         * @return Count of freed programs
+         *
+         * Deletes all programs that are not referenced from outside of the
+         * cache.
+         */
+        std::size_t free();
+
+        /**
+         * @brief Clear the cache
+         *
+         * Releases references to all programs. Programs still referenced
+         * from outside of the cache are deleted once the last reference goes
+         * away. Hit and miss counts are not reset.
+         */
+        void clear();
+
+    private:
+        enum class Type: UnsignedByte;
+
+        /* Type, flags, draw count, joint count */
+        typedef std::tuple<Type, std::uint64_t, UnsignedInt, UnsignedInt> Key;
+
+        template<class T, class Create> std::shared_ptr<T> get(const Key& key, Create create);
+
+        std::map<Key, std::shared_ptr<AbstractShaderProgram>> _programs;
+        UnsignedInt _hitCount{}, _missCount{};
+};
+
+}}
+
+#endif
@@ -34,6 +34,14 @@
 namespace Magnum { namespace Shaders {
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
+#ifndef MAGNUM_TARGET_GLES2
+class DeferredLight;
+#endif
+
+#ifndef MAGNUM_TARGET_GLES
+class DepthPyramid;
+#endif
+
 template<UnsignedInt> class DistanceFieldVector;
 typedef DistanceFieldVector<2> DistanceFieldVector2D;
 typedef DistanceFieldVector<3> DistanceFieldVector3D;
@@ -46,10 +54,28 @@ template<UnsignedInt> class Flat;
 typedef Flat<2> Flat2D;
 typedef Flat<3> Flat3D;
 
+#ifndef MAGNUM_TARGET_GLES2
+class GBuffer;
+#endif
+
 /* Generic is used only statically */
 
+#ifndef MAGNUM_TARGET_GLES
+class InstanceCulling;
+struct InstanceCullingBounds;
+#endif
+
+template<UnsignedInt> class InstancedVector;
+typedef InstancedVector<2> InstancedVector2D;
+typedef InstancedVector<3> InstancedVector3D;
+
+struct ClusteredLight;
+class LightClusters;
+
 class MeshVisualizer;
+class ParticleBillboard;
 class Phong;
+class ProgramCache;
 
 template<UnsignedInt> class Vector;
 typedef Vector<2> Vector2D;
@@ -58,6 +84,10 @@ typedef Vector<3> Vector3D;
 template<UnsignedInt> class VertexColor;
 typedef VertexColor<2> VertexColor2D;
 typedef VertexColor<3> VertexColor3D;
+
+#ifndef MAGNUM_TARGET_GLES
+struct VertexPullingLayout;
+#endif
 #endif
 
 }}
@@ -0,0 +1,86 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+#include "Magnum/Context.h"
+#include "Magnum/Framebuffer.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/Texture.h"
+#include "Magnum/Version.h"
+#include "Magnum/Shaders/DeferredLight.h"
+#include "Magnum/Shaders/GBuffer.h"
+
+namespace Magnum { namespace Shaders { namespace Test {
+
+struct DeferredLightGLTest: OpenGLTester {
+    explicit DeferredLightGLTest();
+
+    void compile();
+    void constructGBuffer();
+};
+
+DeferredLightGLTest::DeferredLightGLTest() {
+    addTests({&DeferredLightGLTest::compile,
+              &DeferredLightGLTest::constructGBuffer});
+}
+
+void DeferredLightGLTest::compile() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isVersionSupported(Version::GL300))
+        CORRADE_SKIP("OpenGL 3.0 is not supported.");
+    #endif
+
+    Shaders::DeferredLight shader;
+
+    MAGNUM_VERIFY_NO_ERROR();
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void DeferredLightGLTest::constructGBuffer() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isVersionSupported(Version::GL300))
+        CORRADE_SKIP("OpenGL 3.0 is not supported.");
+    #endif
+
+    Shaders::GBuffer gbuffer{{64, 32}};
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(gbuffer.size(), (Vector2i{64, 32}));
+    CORRADE_VERIFY(gbuffer.colorTexture().id());
+    CORRADE_VERIFY(gbuffer.albedoTexture().id());
+    CORRADE_VERIFY(gbuffer.normalTexture().id());
+    CORRADE_VERIFY(gbuffer.depthStencilTexture().id());
+
+    gbuffer.beginGeometryPass();
+    CORRADE_COMPARE(gbuffer.framebuffer().checkStatus(FramebufferTarget::Draw), Framebuffer::Status::Complete);
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::DeferredLightGLTest)
@@ -0,0 +1,109 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Texture.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/Shaders/DepthPyramid.h"
+
+namespace Magnum { namespace Shaders { namespace Test {
+
+struct DepthPyramidGLTest: OpenGLTester {
+    explicit DepthPyramidGLTest();
+
+    void compile();
+    void reduce();
+};
+
+DepthPyramidGLTest::DepthPyramidGLTest() {
+    addTests({&DepthPyramidGLTest::compile,
+              &DepthPyramidGLTest::reduce});
+}
+
+void DepthPyramidGLTest::compile() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::compute_shader>())
+        CORRADE_SKIP(Extensions::GL::ARB::compute_shader::string() + std::string(" is not supported"));
+
+    Shaders::DepthPyramid shader;
+    CORRADE_VERIFY(shader.validate().first);
+}
+
+namespace {
+    /* Odd size in both directions, the last texel of each level gets the
+       extra row and column */
+    constexpr Float DepthData[]{
+        0.1f, 0.2f, 0.3f, 0.4f, 0.5f,
+        0.6f, 0.1f, 0.1f, 0.1f, 0.1f,
+        0.1f, 0.1f, 0.1f, 0.9f, 0.1f
+    };
+}
+
+void DepthPyramidGLTest::reduce() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::compute_shader>())
+        CORRADE_SKIP(Extensions::GL::ARB::compute_shader::string() + std::string(" is not supported"));
+
+    Texture2D depth;
+    depth.setMinificationFilter(Sampler::Filter::Nearest)
+        .setMagnificationFilter(Sampler::Filter::Nearest)
+        .setStorage(1, TextureFormat::DepthComponent32F, {5, 3})
+        .setSubImage(0, {}, ImageView2D{PixelFormat::DepthComponent, PixelType::Float, {5, 3}, DepthData});
+
+    Texture2D pyramid;
+    pyramid.setMinificationFilter(Sampler::Filter::Nearest, Sampler::Mipmap::Nearest)
+        .setMagnificationFilter(Sampler::Filter::Nearest)
+        .setStorage(3, TextureFormat::R32F, {5, 3});
+
+    Shaders::DepthPyramid shader;
+    shader.reduce(depth, pyramid, {5, 3}, 3);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    Image2D level0 = pyramid.image(0, {PixelFormat::Red, PixelType::Float});
+    Image2D level1 = pyramid.image(1, {PixelFormat::Red, PixelType::Float});
+    Image2D level2 = pyramid.image(2, {PixelFormat::Red, PixelType::Float});
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE(level1.size(), (Vector2i{2, 1}));
+    CORRADE_COMPARE(level2.size(), (Vector2i{1, 1}));
+    CORRADE_COMPARE_AS(Containers::arrayCast<Float>(level0.data()),
+        Containers::arrayView(DepthData),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayCast<Float>(level1.data()),
+        (Containers::Array<Float>{Containers::InPlaceInit, {0.6f, 0.9f}}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(Containers::arrayCast<Float>(level2.data())[0], 0.9f);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::DepthPyramidGLTest)
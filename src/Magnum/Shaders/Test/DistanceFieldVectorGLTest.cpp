@@ -23,6 +23,8 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
 #include "Magnum/OpenGLTester.h"
 #include "Magnum/Shaders/DistanceFieldVector.h"
 
@@ -33,11 +35,24 @@ struct DistanceFieldVectorGLTest: OpenGLTester {
 
     void compile2D();
     void compile3D();
+    void compile2DVertexColor();
+    void compile3DVertexColor();
+    #ifndef MAGNUM_TARGET_GLES2
+    void compile2DTextureArrays();
+    void compile3DTextureArrays();
+    #endif
 };
 
 DistanceFieldVectorGLTest::DistanceFieldVectorGLTest() {
     addTests({&DistanceFieldVectorGLTest::compile2D,
-              &DistanceFieldVectorGLTest::compile3D});
+              &DistanceFieldVectorGLTest::compile3D,
+              &DistanceFieldVectorGLTest::compile2DVertexColor,
+              &DistanceFieldVectorGLTest::compile3DVertexColor});
+
+    #ifndef MAGNUM_TARGET_GLES2
+    addTests({&DistanceFieldVectorGLTest::compile2DTextureArrays,
+              &DistanceFieldVectorGLTest::compile3DTextureArrays});
+    #endif
 }
 
 void DistanceFieldVectorGLTest::compile2D() {
@@ -60,6 +75,64 @@ void DistanceFieldVectorGLTest::compile3D() {
     }
 }
 
+void DistanceFieldVectorGLTest::compile2DVertexColor() {
+    Shaders::DistanceFieldVector2D shader{Shaders::DistanceFieldVector2D::Flag::VertexColor};
+    CORRADE_VERIFY(shader.flags() & Shaders::DistanceFieldVector2D::Flag::VertexColor);
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void DistanceFieldVectorGLTest::compile3DVertexColor() {
+    Shaders::DistanceFieldVector3D shader{Shaders::DistanceFieldVector3D::Flag::VertexColor};
+    CORRADE_VERIFY(shader.flags() & Shaders::DistanceFieldVector3D::Flag::VertexColor);
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void DistanceFieldVectorGLTest::compile2DTextureArrays() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::texture_array>())
+        CORRADE_SKIP(Extensions::GL::EXT::texture_array::string() + std::string(" is not supported."));
+    #endif
+
+    Shaders::DistanceFieldVector2D shader{Shaders::DistanceFieldVector2D::Flag::TextureArrays};
+    CORRADE_VERIFY(shader.flags() & Shaders::DistanceFieldVector2D::Flag::TextureArrays);
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES2
+void DistanceFieldVectorGLTest::compile3DTextureArrays() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::texture_array>())
+        CORRADE_SKIP(Extensions::GL::EXT::texture_array::string() + std::string(" is not supported."));
+    #endif
+
+    Shaders::DistanceFieldVector3D shader{Shaders::DistanceFieldVector3D::Flag::TextureArrays};
+    CORRADE_VERIFY(shader.flags() & Shaders::DistanceFieldVector3D::Flag::TextureArrays);
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+#endif
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Shaders::Test::DistanceFieldVectorGLTest)
@@ -23,9 +23,19 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include "Magnum/Buffer.h"
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
 #include "Magnum/OpenGLTester.h"
+#include "Magnum/Texture.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/Version.h"
 #include "Magnum/Shaders/Flat.h"
 
+#ifndef MAGNUM_TARGET_GLES
+#include "Magnum/Shaders/VertexPulling.h"
+#endif
+
 namespace Magnum { namespace Shaders { namespace Test {
 
 struct FlatGLTest: OpenGLTester {
@@ -35,13 +45,40 @@ struct FlatGLTest: OpenGLTester {
     void compile3D();
     void compile2DTextured();
     void compile3DTextured();
+    void compile2DInstanced();
+    void compile3DInstanced();
+    void compileAsync();
+
+    #ifndef MAGNUM_TARGET_GLES2
+    void compileUniformBuffers();
+    #endif
+    #ifndef MAGNUM_TARGET_GLES
+    void compileBindlessTexture();
+    void compileBindlessTextureUniformBuffers();
+    void compileVertexPulling2D();
+    void compileVertexPulling3D();
+    #endif
 };
 
 FlatGLTest::FlatGLTest() {
     addTests({&FlatGLTest::compile2D,
               &FlatGLTest::compile3D,
               &FlatGLTest::compile2DTextured,
-              &FlatGLTest::compile3DTextured});
+              &FlatGLTest::compile3DTextured,
+              &FlatGLTest::compile2DInstanced,
+              &FlatGLTest::compile3DInstanced,
+              &FlatGLTest::compileAsync});
+
+    #ifndef MAGNUM_TARGET_GLES2
+    addTests({&FlatGLTest::compileUniformBuffers});
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    addTests({&FlatGLTest::compileBindlessTexture,
+              &FlatGLTest::compileBindlessTextureUniformBuffers,
+              &FlatGLTest::compileVertexPulling2D,
+              &FlatGLTest::compileVertexPulling3D});
+    #endif
 }
 
 void FlatGLTest::compile2D() {
@@ -84,6 +121,159 @@ void FlatGLTest::compile3DTextured() {
     }
 }
 
+void FlatGLTest::compile2DInstanced() {
+    Shaders::Flat2D shader{Shaders::Flat2D::Flag::VertexColor|Shaders::Flat2D::Flag::InstancedTransformation};
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void FlatGLTest::compile3DInstanced() {
+    Shaders::Flat3D shader{Shaders::Flat3D::Flag::Textured|Shaders::Flat3D::Flag::VertexColor|Shaders::Flat3D::Flag::InstancedTransformation};
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void FlatGLTest::compileAsync() {
+    Shaders::Flat3D::CompileState state = Shaders::Flat3D::compile(Shaders::Flat3D::Flag::Textured);
+    CORRADE_VERIFY(state.flags() & Shaders::Flat3D::Flag::Textured);
+
+    /* Not blocking, so just verify it doesn't explode */
+    state.isLinkFinished();
+
+    Shaders::Flat3D shader{std::move(state)};
+    CORRADE_VERIFY(shader.id());
+    CORRADE_VERIFY(shader.isLinkFinished());
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void FlatGLTest::compileUniformBuffers() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isVersionSupported(Version::GL310))
+        CORRADE_SKIP("OpenGL 3.1 is not supported.");
+    #endif
+
+    Shaders::Flat3D shader{Shaders::Flat3D::Flag::UniformBuffers, 16};
+    CORRADE_COMPARE(shader.drawCount(), 16);
+
+    Shaders::Flat3D::DrawUniform draws[16];
+    draws[3].setColor(Color3{1.0f, 0.5f, 0.0f});
+    Buffer buffer{Buffer::TargetHint::Uniform};
+    buffer.setData(draws, BufferUsage::StaticDraw);
+
+    shader.bindDrawBuffer(buffer)
+        .setDrawOffset(3);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES
+void FlatGLTest::compileBindlessTexture() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::bindless_texture>())
+        CORRADE_SKIP(Extensions::GL::ARB::bindless_texture::string() + std::string(" is not supported."));
+
+    Texture2D texture;
+    texture.setMinificationFilter(Sampler::Filter::Linear)
+        .setMagnificationFilter(Sampler::Filter::Linear)
+        .setStorage(1, TextureFormat::RGBA8, {4, 4});
+    texture.makeResident();
+
+    Shaders::Flat3D shader{Shaders::Flat3D::Flag::Textured|Shaders::Flat3D::Flag::BindlessTexture};
+    shader.setTextureHandle(texture.handle());
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(shader.validate().first);
+}
+
+void FlatGLTest::compileBindlessTextureUniformBuffers() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::bindless_texture>())
+        CORRADE_SKIP(Extensions::GL::ARB::bindless_texture::string() + std::string(" is not supported."));
+
+    Texture2D texture;
+    texture.setMinificationFilter(Sampler::Filter::Linear)
+        .setMagnificationFilter(Sampler::Filter::Linear)
+        .setStorage(1, TextureFormat::RGBA8, {4, 4});
+    texture.makeResident();
+
+    Shaders::Flat3D shader{Shaders::Flat3D::Flag::Textured|Shaders::Flat3D::Flag::UniformBuffers|Shaders::Flat3D::Flag::BindlessTexture, 4};
+
+    Shaders::Flat3D::DrawUniform draws[4];
+    draws[2].setTextureHandle(texture.handle());
+    Buffer buffer{Buffer::TargetHint::Uniform};
+    buffer.setData(draws, BufferUsage::StaticDraw);
+
+    shader.bindDrawBuffer(buffer)
+        .setDrawOffset(2);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(shader.validate().first);
+}
+
+void FlatGLTest::compileVertexPulling2D() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::shader_storage_buffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::shader_storage_buffer_object::string() + std::string(" is not supported."));
+
+    Shaders::Flat2D shader{Shaders::Flat2D::Flag::UniformBuffers|Shaders::Flat2D::Flag::VertexPulling|Shaders::Flat2D::Flag::VertexColor, 4};
+
+    MAGNUM_VERIFY_NO_ERROR();
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void FlatGLTest::compileVertexPulling3D() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::shader_storage_buffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::shader_storage_buffer_object::string() + std::string(" is not supported."));
+
+    Shaders::Flat3D shader{Shaders::Flat3D::Flag::UniformBuffers|Shaders::Flat3D::Flag::VertexPulling|Shaders::Flat3D::Flag::Textured, 4};
+
+    Shaders::VertexPullingLayout layouts[4];
+    layouts[1]
+        .setAttribute(Shaders::Flat3D::Position{}, 0, 20)
+        .setAttribute(Shaders::Flat3D::TextureCoordinates{Shaders::Flat3D::TextureCoordinates::DataType::UnsignedShort, Shaders::Flat3D::TextureCoordinates::DataOption::Normalized}, 12, 20);
+    Buffer layoutBuffer{Buffer::TargetHint::ShaderStorage};
+    layoutBuffer.setData(layouts, BufferUsage::StaticDraw);
+
+    const Float data[20]{};
+    Buffer vertexData{Buffer::TargetHint::ShaderStorage};
+    vertexData.setData(data, BufferUsage::StaticDraw);
+
+    shader.bindVertexDataBuffer(vertexData)
+        .bindVertexLayoutBuffer(layoutBuffer);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+#endif
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Shaders::Test::FlatGLTest)
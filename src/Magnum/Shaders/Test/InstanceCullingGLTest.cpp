@@ -0,0 +1,123 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Buffer.h"
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shaders/InstanceCulling.h"
+
+namespace Magnum { namespace Shaders { namespace Test {
+
+struct InstanceCullingGLTest: OpenGLTester {
+    explicit InstanceCullingGLTest();
+
+    void compile();
+    void compileHierarchicalZ();
+    void compileDrawArraysCommands();
+
+    void cull();
+};
+
+InstanceCullingGLTest::InstanceCullingGLTest() {
+    addTests({&InstanceCullingGLTest::compile,
+              &InstanceCullingGLTest::compileHierarchicalZ,
+              &InstanceCullingGLTest::compileDrawArraysCommands,
+
+              &InstanceCullingGLTest::cull});
+}
+
+using namespace Math::Literals;
+
+void InstanceCullingGLTest::compile() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::compute_shader>())
+        CORRADE_SKIP(Extensions::GL::ARB::compute_shader::string() + std::string(" is not supported"));
+
+    Shaders::InstanceCulling shader;
+    CORRADE_VERIFY(shader.validate().first);
+}
+
+void InstanceCullingGLTest::compileHierarchicalZ() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::compute_shader>())
+        CORRADE_SKIP(Extensions::GL::ARB::compute_shader::string() + std::string(" is not supported"));
+
+    Shaders::InstanceCulling shader{Shaders::InstanceCulling::Flag::HierarchicalZ};
+    CORRADE_VERIFY(shader.validate().first);
+}
+
+void InstanceCullingGLTest::compileDrawArraysCommands() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::compute_shader>())
+        CORRADE_SKIP(Extensions::GL::ARB::compute_shader::string() + std::string(" is not supported"));
+
+    Shaders::InstanceCulling shader{Shaders::InstanceCulling::Flag::DrawArraysCommands};
+    CORRADE_VERIFY(shader.validate().first);
+}
+
+void InstanceCullingGLTest::cull() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::compute_shader>())
+        CORRADE_SKIP(Extensions::GL::ARB::compute_shader::string() + std::string(" is not supported"));
+
+    const InstanceCullingBounds boundsData[]{
+        {{0.0f, 0.0f, -5.0f}, 1.0f, 0},     /* visible */
+        {{0.0f, 0.0f, 5.0f}, 1.0f, 0},      /* behind the camera */
+        {{100.0f, 0.0f, -5.0f}, 1.0f, 1},   /* far to the right */
+        {{2.0f, 0.0f, -5.0f}, 1.0f, 1},     /* visible */
+        {{5.5f, 0.0f, -5.0f}, 1.0f, 1}      /* intersects the right plane */
+    };
+    const Mesh::DrawElementsIndirectCommand commandData[]{
+        {36, 0, 0, 0, 0},
+        {36, 0, 0, 0, 2}
+    };
+
+    Buffer bounds, commands, visibleInstances;
+    bounds.setData(boundsData, BufferUsage::StaticDraw);
+    commands.setData(commandData, BufferUsage::DynamicDraw);
+    visibleInstances.setData({nullptr, 5*sizeof(UnsignedInt)}, BufferUsage::DynamicDraw);
+
+    Shaders::InstanceCulling shader;
+    shader.setTransformationProjectionMatrix(Matrix4::perspectiveProjection(90.0_degf, 1.0f, 0.1f, 100.0f))
+        .bindBoundsBuffer(bounds)
+        .bindCommandBuffer(commands)
+        .bindVisibleInstanceBuffer(visibleInstances)
+        .cull(5);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    const Containers::Array<Mesh::DrawElementsIndirectCommand> commandResult = commands.data<Mesh::DrawElementsIndirectCommand>();
+    CORRADE_COMPARE(commandResult[0].instanceCount, 1);
+    CORRADE_COMPARE(commandResult[1].instanceCount, 2);
+
+    /* Order of the instances in a single command is unspecified */
+    const Containers::Array<UnsignedInt> visibleResult = visibleInstances.data<UnsignedInt>();
+    CORRADE_COMPARE(visibleResult[0], 0);
+    CORRADE_VERIFY((visibleResult[2] == 3 && visibleResult[3] == 4) ||
+                   (visibleResult[2] == 4 && visibleResult[3] == 3));
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::InstanceCullingGLTest)
@@ -0,0 +1,69 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Shaders/InstanceCulling.h"
+
+namespace Magnum { namespace Shaders { namespace Test {
+
+struct InstanceCullingTest: TestSuite::Tester {
+    explicit InstanceCullingTest();
+
+    void constructNoCreate();
+    void boundsLayout();
+};
+
+InstanceCullingTest::InstanceCullingTest() {
+    addTests({&InstanceCullingTest::constructNoCreate,
+              &InstanceCullingTest::boundsLayout});
+}
+
+void InstanceCullingTest::constructNoCreate() {
+    {
+        Shaders::InstanceCulling shader{NoCreate};
+        CORRADE_COMPARE(shader.id(), 0);
+    }
+
+    CORRADE_VERIFY(true);
+}
+
+void InstanceCullingTest::boundsLayout() {
+    const InstanceCullingBounds bounds[]{
+        {{1.0f, 2.0f, 3.0f}, 0.5f, 7},
+        {{4.0f, 5.0f, 6.0f}, 1.5f, 3}
+    };
+
+    /* Matches the std430 layout of the shader struct */
+    const char* data = reinterpret_cast<const char*>(bounds);
+    CORRADE_COMPARE(reinterpret_cast<const InstanceCullingBounds*>(data + 32)->center, (Vector3{4.0f, 5.0f, 6.0f}));
+    CORRADE_COMPARE(*reinterpret_cast<const Float*>(data + 12), 0.5f);
+    CORRADE_COMPARE(*reinterpret_cast<const UnsignedInt*>(data + 16), 7);
+    CORRADE_COMPARE(*reinterpret_cast<const UnsignedInt*>(data + 48), 3);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::InstanceCullingTest)
@@ -0,0 +1,241 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Shaders/LightClusters.h"
+
+namespace Magnum { namespace Shaders { namespace Test {
+
+struct LightClustersTest: TestSuite::Tester {
+    explicit LightClustersTest();
+
+    void lightLayout();
+    void construct();
+
+    void cluster();
+    void clusterOutside();
+
+    void bin();
+    void binOutside();
+    void binNearPlane();
+    void binRebin();
+
+    void setPerspectiveInvalid();
+    void binNoPerspective();
+};
+
+LightClustersTest::LightClustersTest() {
+    addTests({&LightClustersTest::lightLayout,
+              &LightClustersTest::construct,
+
+              &LightClustersTest::cluster,
+              &LightClustersTest::clusterOutside,
+
+              &LightClustersTest::bin,
+              &LightClustersTest::binOutside,
+              &LightClustersTest::binNearPlane,
+              &LightClustersTest::binRebin,
+
+              &LightClustersTest::setPerspectiveInvalid,
+              &LightClustersTest::binNoPerspective});
+}
+
+void LightClustersTest::lightLayout() {
+    const ClusteredLight lights[]{
+        {{1.0f, 2.0f, 3.0f}, 0.5f, {0.1f, 0.2f, 0.3f}},
+        {{4.0f, 5.0f, 6.0f}, 1.5f, {0.4f, 0.5f, 0.6f}}
+    };
+
+    /* Matches the std430 layout of the shader struct */
+    const char* data = reinterpret_cast<const char*>(lights);
+    CORRADE_COMPARE(*reinterpret_cast<const Float*>(data + 12), 0.5f);
+    CORRADE_COMPARE(*reinterpret_cast<const Color3*>(data + 16), (Color3{0.1f, 0.2f, 0.3f}));
+    CORRADE_COMPARE(*reinterpret_cast<const Vector3*>(data + 32), (Vector3{4.0f, 5.0f, 6.0f}));
+}
+
+void LightClustersTest::construct() {
+    LightClusters clusters{{4, 3, 8}};
+    clusters.setPerspective(Rad{Constants::piHalf()}, 4.0f/3.0f, 1.0f, 100.0f);
+
+    CORRADE_COMPARE(clusters.count(), (Vector3ui{4, 3, 8}));
+    CORRADE_COMPARE(clusters.near(), 1.0f);
+    CORRADE_COMPARE(clusters.far(), 100.0f);
+
+    /* Near plane maps to slice 0, far plane to slice 8 */
+    const Vector2 parameters = clusters.depthSliceParameters();
+    CORRADE_COMPARE(std::log(1.0f)*parameters.x() + parameters.y(), 0.0f);
+    CORRADE_COMPARE(std::log(100.0f)*parameters.x() + parameters.y(), 8.0f);
+    CORRADE_COMPARE(std::log(10.0f)*parameters.x() + parameters.y(), 4.0f);
+}
+
+void LightClustersTest::cluster() {
+    LightClusters clusters{{4, 4, 8}};
+    clusters.setPerspective(Rad{Constants::piHalf()}, 1.0f, 1.0f, 100.0f);
+
+    /* In the center, a bit farther than the middle of the log range */
+    CORRADE_COMPARE(clusters.cluster({0.5f, 0.5f, -14.0f}), (Vector3ui{2, 2, 4}));
+    CORRADE_COMPARE(clusters.cluster({-0.5f, -0.5f, -14.0f}), (Vector3ui{1, 1, 4}));
+
+    /* Left bottom corner close to the near plane */
+    CORRADE_COMPARE(clusters.cluster({-1.0f, -1.0f, -1.01f}), (Vector3ui{0, 0, 0}));
+
+    /* Right top corner close to the far plane */
+    CORRADE_COMPARE(clusters.cluster({98.0f, 98.0f, -99.0f}), (Vector3ui{3, 3, 7}));
+}
+
+void LightClustersTest::clusterOutside() {
+    LightClusters clusters{{4, 4, 8}};
+    clusters.setPerspective(Rad{Constants::piHalf()}, 1.0f, 1.0f, 100.0f);
+
+    /* Clamped to the border clusters */
+    CORRADE_COMPARE(clusters.cluster({-50.0f, 50.0f, -14.0f}), (Vector3ui{0, 3, 4}));
+    CORRADE_COMPARE(clusters.cluster({0.1f, 0.1f, -0.5f}), (Vector3ui{2, 2, 0}));
+    CORRADE_COMPARE(clusters.cluster({0.5f, 0.5f, -500.0f}), (Vector3ui{2, 2, 7}));
+}
+
+void LightClustersTest::bin() {
+    LightClusters clusters{{4, 4, 8}};
+    clusters.setPerspective(Rad{Constants::piHalf()}, 1.0f, 1.0f, 100.0f);
+
+    const ClusteredLight lights[]{
+        /* Small light in a single cluster */
+        {{0.5f, 0.5f, -14.0f}, 0.1f, {}},
+        /* Light spanning the whole center of the screen at that depth */
+        {{0.0f, 0.0f, -14.0f}, 1.0f, {}},
+        /* Another small light in a single cluster */
+        {{-0.5f, -0.5f, -14.0f}, 0.1f, {}}
+    };
+    clusters.bin(lights);
+
+    CORRADE_COMPARE(clusters.clusters().size(), 4*4*8);
+
+    /* The first and the second light in the right top cluster */
+    const Vector2ui rightTop = clusters.clusters()[2 + 4*(2 + 4*4)];
+    CORRADE_COMPARE(rightTop.y(), 2);
+    CORRADE_COMPARE(clusters.lightIndices()[rightTop.x()], 0);
+    CORRADE_COMPARE(clusters.lightIndices()[rightTop.x() + 1], 1);
+
+    /* The second and the third light in the left bottom cluster */
+    const Vector2ui leftBottom = clusters.clusters()[1 + 4*(1 + 4*4)];
+    CORRADE_COMPARE(leftBottom.y(), 2);
+    CORRADE_COMPARE(clusters.lightIndices()[leftBottom.x()], 1);
+    CORRADE_COMPARE(clusters.lightIndices()[leftBottom.x() + 1], 2);
+
+    /* Only the second light in the remaining two center clusters */
+    const Vector2ui rightBottom = clusters.clusters()[2 + 4*(1 + 4*4)];
+    CORRADE_COMPARE(rightBottom.y(), 1);
+    CORRADE_COMPARE(clusters.lightIndices()[rightBottom.x()], 1);
+
+    /* Nothing in the corners */
+    CORRADE_COMPARE(clusters.clusters()[0 + 4*(0 + 4*4)].y(), 0);
+    CORRADE_COMPARE(clusters.clusters()[3 + 4*(3 + 4*4)].y(), 0);
+
+    /* Nothing in the first slice */
+    UnsignedInt count = 0;
+    for(std::size_t i = 0; i != 4*4; ++i)
+        count += clusters.clusters()[i].y();
+    CORRADE_COMPARE(count, 0);
+}
+
+void LightClustersTest::binOutside() {
+    LightClusters clusters{{4, 4, 8}};
+    clusters.setPerspective(Rad{Constants::piHalf()}, 1.0f, 1.0f, 100.0f);
+
+    const ClusteredLight lights[]{
+        /* Behind the camera */
+        {{0.0f, 0.0f, 5.0f}, 1.0f, {}},
+        /* Behind the far plane */
+        {{0.0f, 0.0f, -150.0f}, 10.0f, {}},
+        /* Left of the frustum */
+        {{-50.0f, 0.0f, -10.0f}, 1.0f, {}}
+    };
+    clusters.bin(lights);
+
+    CORRADE_COMPARE(clusters.lightIndices().size(), 0);
+    for(const Vector2ui& cluster: clusters.clusters())
+        CORRADE_COMPARE(cluster.y(), 0);
+}
+
+void LightClustersTest::binNearPlane() {
+    LightClusters clusters{{4, 4, 8}};
+    clusters.setPerspective(Rad{Constants::piHalf()}, 1.0f, 1.0f, 100.0f);
+
+    /* Light around the camera affects all clusters of the first slice */
+    const ClusteredLight lights[]{
+        {{0.0f, 0.0f, 0.0f}, 1.5f, {}}
+    };
+    clusters.bin(lights);
+
+    for(std::size_t i = 0; i != 4*4; ++i)
+        CORRADE_COMPARE(clusters.clusters()[i].y(), 1);
+
+    /* But nothing farther away */
+    CORRADE_COMPARE(clusters.clusters()[4*4*2].y(), 0);
+}
+
+void LightClustersTest::binRebin() {
+    LightClusters clusters{{4, 4, 8}};
+    clusters.setPerspective(Rad{Constants::piHalf()}, 1.0f, 1.0f, 100.0f);
+
+    std::vector<ClusteredLight> lights{
+        {{0.0f, 0.0f, -14.0f}, 1.0f, {}},
+        {{0.0f, 0.0f, -14.0f}, 1.0f, {}}
+    };
+    clusters.bin(lights);
+    CORRADE_COMPARE(clusters.clusters()[2 + 4*(2 + 4*4)].y(), 2);
+
+    /* Previous results are discarded */
+    lights.pop_back();
+    clusters.bin(lights);
+    CORRADE_COMPARE(clusters.clusters()[2 + 4*(2 + 4*4)].y(), 1);
+    CORRADE_COMPARE(clusters.lightIndices().size(), 4);
+}
+
+void LightClustersTest::setPerspectiveInvalid() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    LightClusters clusters;
+    clusters.setPerspective(Rad{Constants::piHalf()}, 1.0f, 0.0f, 100.0f)
+        .setPerspective(Rad{Constants::piHalf()}, 1.0f, 10.0f, 1.0f);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::LightClusters::setPerspective(): expected 0 < near < far, got 0 and 100\n"
+        "Shaders::LightClusters::setPerspective(): expected 0 < near < far, got 10 and 1\n");
+}
+
+void LightClustersTest::binNoPerspective() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    LightClusters clusters;
+    clusters.bin(std::vector<ClusteredLight>{});
+    CORRADE_COMPARE(out.str(), "Shaders::LightClusters::bin(): perspective not set\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::LightClustersTest)
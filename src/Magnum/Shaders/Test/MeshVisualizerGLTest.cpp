@@ -34,6 +34,7 @@ struct MeshVisualizerGLTest: OpenGLTester {
     explicit MeshVisualizerGLTest();
 
     void compile();
+    void compileInstanced();
     #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
     void compileWireframeGeometryShader();
     #endif
@@ -42,6 +43,7 @@ struct MeshVisualizerGLTest: OpenGLTester {
 
 MeshVisualizerGLTest::MeshVisualizerGLTest() {
     addTests({&MeshVisualizerGLTest::compile,
+              &MeshVisualizerGLTest::compileInstanced,
               #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
               &MeshVisualizerGLTest::compileWireframeGeometryShader,
               #endif
@@ -58,6 +60,16 @@ void MeshVisualizerGLTest::compile() {
     }
 }
 
+void MeshVisualizerGLTest::compileInstanced() {
+    Shaders::MeshVisualizer shader{Shaders::MeshVisualizer::Flag::InstancedTransformation};
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
 #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
 void MeshVisualizerGLTest::compileWireframeGeometryShader() {
     #ifndef MAGNUM_TARGET_GLES
@@ -23,7 +23,11 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include "Magnum/Buffer.h"
+#include "Magnum/Context.h"
 #include "Magnum/OpenGLTester.h"
+#include "Magnum/Version.h"
+#include "Magnum/Shaders/LightClusters.h"
 #include "Magnum/Shaders/Phong.h"
 
 namespace Magnum { namespace Shaders { namespace Test {
@@ -39,6 +43,17 @@ struct PhongGLTest: OpenGLTester {
     void compileAmbientSpecularTexture();
     void compileDiffuseSpecularTexture();
     void compileAmbientDiffuseSpecularTexture();
+    void compileInstanced();
+    void compileOctahedralNormal();
+
+    #ifndef MAGNUM_TARGET_GLES2
+    void compileUniformBuffers();
+    void compileGBufferOutput();
+    void compileFlatShading();
+    #endif
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    void compileClusteredLights();
+    #endif
 };
 
 PhongGLTest::PhongGLTest() {
@@ -49,7 +64,18 @@ PhongGLTest::PhongGLTest() {
               &PhongGLTest::compileAmbientDiffuseTexture,
               &PhongGLTest::compileAmbientSpecularTexture,
               &PhongGLTest::compileDiffuseSpecularTexture,
-              &PhongGLTest::compileAmbientDiffuseSpecularTexture});
+              &PhongGLTest::compileAmbientDiffuseSpecularTexture,
+              &PhongGLTest::compileInstanced,
+              &PhongGLTest::compileOctahedralNormal});
+
+    #ifndef MAGNUM_TARGET_GLES2
+    addTests({&PhongGLTest::compileUniformBuffers,
+              &PhongGLTest::compileGBufferOutput,
+              &PhongGLTest::compileFlatShading});
+    #endif
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    addTests({&PhongGLTest::compileClusteredLights});
+    #endif
 }
 
 void PhongGLTest::compile() {
@@ -132,6 +158,129 @@ void PhongGLTest::compileAmbientDiffuseSpecularTexture() {
     }
 }
 
+void PhongGLTest::compileInstanced() {
+    Shaders::Phong shader{Shaders::Phong::Flag::DiffuseTexture|Shaders::Phong::Flag::VertexColor|Shaders::Phong::Flag::InstancedTransformation};
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void PhongGLTest::compileOctahedralNormal() {
+    Shaders::Phong shader{Shaders::Phong::Flag::OctahedralNormal};
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void PhongGLTest::compileUniformBuffers() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isVersionSupported(Version::GL310))
+        CORRADE_SKIP("OpenGL 3.1 is not supported.");
+    #endif
+
+    Shaders::Phong shader{Shaders::Phong::Flag::DiffuseTexture|Shaders::Phong::Flag::UniformBuffers, 4};
+    CORRADE_COMPARE(shader.drawCount(), 4);
+
+    Shaders::Phong::DrawUniform draws[4];
+    draws[1].setDiffuseColor(Color3{1.0f, 0.5f, 0.0f})
+        .setLightPosition({1.0f, 2.0f, 3.0f});
+    Buffer buffer{Buffer::TargetHint::Uniform};
+    buffer.setData(draws, BufferUsage::StaticDraw);
+
+    /* Bind just a single draw, each is 256 bytes */
+    shader.bindDrawBuffer(buffer, 256, 256);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void PhongGLTest::compileGBufferOutput() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isVersionSupported(Version::GL300))
+        CORRADE_SKIP("OpenGL 3.0 is not supported.");
+    #endif
+
+    Shaders::Phong shader{Shaders::Phong::Flag::DiffuseTexture|Shaders::Phong::Flag::GBufferOutput};
+
+    MAGNUM_VERIFY_NO_ERROR();
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void PhongGLTest::compileFlatShading() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isVersionSupported(Version::GL300))
+        CORRADE_SKIP("OpenGL 3.0 is not supported.");
+    #endif
+
+    Shaders::Phong shader{Shaders::Phong::Flag::FlatShading};
+
+    MAGNUM_VERIFY_NO_ERROR();
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+#endif
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+void PhongGLTest::compileClusteredLights() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isVersionSupported(Version::GL430))
+        CORRADE_SKIP("OpenGL 4.3 is not supported.");
+    #else
+    if(!Context::current().isVersionSupported(Version::GLES310))
+        CORRADE_SKIP("OpenGL ES 3.1 is not supported.");
+    #endif
+
+    Shaders::Phong shader{Shaders::Phong::Flag::ClusteredLights};
+
+    const Shaders::ClusteredLight lights[]{
+        {{1.0f, 0.0f, -5.0f}, 2.0f, {1.0f, 0.5f, 0.0f}},
+        {{-2.0f, 1.0f, -20.0f}, 5.0f, {0.0f, 0.5f, 1.0f}}
+    };
+    Shaders::LightClusters clusters{{4, 4, 8}};
+    clusters.setPerspective(Deg(35.0f), 4.0f/3.0f, 0.1f, 100.0f)
+        .bin(lights);
+
+    Buffer lightBuffer, clusterBuffer, lightIndexBuffer;
+    lightBuffer.setData(lights, BufferUsage::StaticDraw);
+    clusterBuffer.setData(clusters.clusters(), BufferUsage::StaticDraw);
+    lightIndexBuffer.setData(clusters.lightIndices(), BufferUsage::StaticDraw);
+
+    shader.setLightClusters(clusters, {640, 480})
+        .bindLightBuffer(lightBuffer)
+        .bindLightClusterBuffer(clusterBuffer)
+        .bindLightIndexBuffer(lightIndexBuffer);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+#endif
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Shaders::Test::PhongGLTest)
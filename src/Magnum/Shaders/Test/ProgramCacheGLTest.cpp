@@ -0,0 +1,133 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/Shaders/ProgramCache.h"
+
+namespace Magnum { namespace Shaders { namespace Test {
+
+struct ProgramCacheGLTest: OpenGLTester {
+    explicit ProgramCacheGLTest();
+
+    void same();
+    void differentFlags();
+    void differentType();
+    void free();
+    void clear();
+};
+
+ProgramCacheGLTest::ProgramCacheGLTest() {
+    addTests({&ProgramCacheGLTest::same,
+              &ProgramCacheGLTest::differentFlags,
+              &ProgramCacheGLTest::differentType,
+              &ProgramCacheGLTest::free,
+              &ProgramCacheGLTest::clear});
+}
+
+void ProgramCacheGLTest::same() {
+    ProgramCache cache;
+
+    std::shared_ptr<Phong> a = cache.phong(Phong::Flag::DiffuseTexture);
+    std::shared_ptr<Phong> b = cache.phong(Phong::Flag::DiffuseTexture);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(a);
+    CORRADE_VERIFY(a->id());
+    CORRADE_COMPARE(a.get(), b.get());
+    CORRADE_COMPARE(cache.size(), 1);
+    CORRADE_COMPARE(cache.missCount(), 1);
+    CORRADE_COMPARE(cache.hitCount(), 1);
+}
+
+void ProgramCacheGLTest::differentFlags() {
+    ProgramCache cache;
+
+    std::shared_ptr<Flat3D> a = cache.flat3D();
+    std::shared_ptr<Flat3D> b = cache.flat3D(Flat3D::Flag::Textured);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(a != b);
+    CORRADE_VERIFY(a->id() != b->id());
+    CORRADE_COMPARE(cache.size(), 2);
+    CORRADE_COMPARE(cache.missCount(), 2);
+    CORRADE_COMPARE(cache.hitCount(), 0);
+}
+
+void ProgramCacheGLTest::differentType() {
+    ProgramCache cache;
+
+    /* Same (empty) flags, but different shaders */
+    std::shared_ptr<Flat2D> a = cache.flat2D();
+    std::shared_ptr<Flat3D> b = cache.flat3D();
+    std::shared_ptr<VertexColor2D> c = cache.vertexColor2D();
+    std::shared_ptr<VertexColor3D> d = cache.vertexColor3D();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(a->id() != b->id());
+    CORRADE_VERIFY(c->id() != d->id());
+    CORRADE_VERIFY(a->id() != c->id());
+    CORRADE_COMPARE(cache.size(), 4);
+    CORRADE_COMPARE(cache.hitCount(), 0);
+}
+
+void ProgramCacheGLTest::free() {
+    ProgramCache cache;
+
+    std::shared_ptr<Flat3D> a = cache.flat3D();
+    cache.flat3D(Flat3D::Flag::Textured);
+    CORRADE_COMPARE(cache.size(), 2);
+
+    /* Only the unreferenced program gets freed */
+    CORRADE_COMPARE(cache.free(), 1);
+    CORRADE_COMPARE(cache.size(), 1);
+    CORRADE_COMPARE(cache.flat3D().get(), a.get());
+    CORRADE_COMPARE(cache.hitCount(), 1);
+
+    a = nullptr;
+    CORRADE_COMPARE(cache.free(), 1);
+    CORRADE_COMPARE(cache.size(), 0);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void ProgramCacheGLTest::clear() {
+    ProgramCache cache;
+
+    std::shared_ptr<Phong> a = cache.phong();
+    cache.clear();
+    CORRADE_COMPARE(cache.size(), 0);
+
+    /* The handle stays valid, new requests create a new program */
+    CORRADE_VERIFY(a->id());
+    std::shared_ptr<Phong> b = cache.phong();
+    CORRADE_VERIFY(a != b);
+    CORRADE_COMPARE(cache.missCount(), 2);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::ProgramCacheGLTest)
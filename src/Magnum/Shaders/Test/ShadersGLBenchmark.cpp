@@ -0,0 +1,283 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Buffer.h"
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Framebuffer.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/Renderbuffer.h"
+#include "Magnum/RenderbufferFormat.h"
+#include "Magnum/Texture.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shaders/DistanceFieldVector.h"
+#include "Magnum/Shaders/Flat.h"
+#include "Magnum/Shaders/MeshVisualizer.h"
+#include "Magnum/Shaders/Phong.h"
+#include "Magnum/Shaders/Vector.h"
+#include "Magnum/Shaders/VertexColor.h"
+
+namespace Magnum { namespace Shaders { namespace Test {
+
+/* Fill rate of builtin shaders, measured in GPU time of drawing a few
+   fullscreen quads into a large framebuffer */
+
+struct ShadersGLBenchmark: OpenGLTester {
+    explicit ShadersGLBenchmark();
+
+    void flat();
+    void flatTextured();
+    void vertexColor();
+    void vector();
+    void distanceFieldVector();
+    void phong();
+    void phongDiffuseTexture();
+    void meshVisualizer();
+
+    private:
+        void setup();
+        void teardown();
+        void skipIfNoTimeQuery();
+
+        Renderbuffer _color{NoCreate};
+        Framebuffer _framebuffer{NoCreate};
+        Texture2D _texture{NoCreate};
+        Buffer _vertices2D{NoCreate}, _vertices3D{NoCreate};
+        Mesh _mesh2D{NoCreate}, _mesh3D{NoCreate};
+};
+
+namespace {
+    enum: std::size_t { QuadCount = 10 };
+
+    const Vector2i FramebufferSize{2048};
+
+    constexpr struct {
+        Vector2 position;
+        Vector2 textureCoordinates;
+        Color4 color;
+    } Quad2D[]{
+        {{ 1.0f, -1.0f}, {1.0f, 0.0f}, {1.0f, 0.0f, 0.0f, 1.0f}},
+        {{ 1.0f,  1.0f}, {1.0f, 1.0f}, {0.0f, 1.0f, 0.0f, 1.0f}},
+        {{-1.0f, -1.0f}, {0.0f, 0.0f}, {0.0f, 0.0f, 1.0f, 1.0f}},
+        {{-1.0f,  1.0f}, {0.0f, 1.0f}, {1.0f, 1.0f, 1.0f, 1.0f}}
+    };
+
+    constexpr struct {
+        Vector3 position;
+        Vector3 normal;
+        Vector2 textureCoordinates;
+    } Quad3D[]{
+        {{ 1.0f, -1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {1.0f, 0.0f}},
+        {{ 1.0f,  1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {1.0f, 1.0f}},
+        {{-1.0f, -1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f}},
+        {{-1.0f,  1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 1.0f}}
+    };
+}
+
+ShadersGLBenchmark::ShadersGLBenchmark() {
+    addBenchmarks({&ShadersGLBenchmark::flat,
+                   &ShadersGLBenchmark::flatTextured,
+                   &ShadersGLBenchmark::vertexColor,
+                   &ShadersGLBenchmark::vector,
+                   &ShadersGLBenchmark::distanceFieldVector,
+                   &ShadersGLBenchmark::phong,
+                   &ShadersGLBenchmark::phongDiffuseTexture,
+                   &ShadersGLBenchmark::meshVisualizer}, 10,
+        &ShadersGLBenchmark::setup,
+        &ShadersGLBenchmark::teardown,
+        BenchmarkType::GpuTime);
+}
+
+void ShadersGLBenchmark::setup() {
+    _color = Renderbuffer{};
+    #ifndef MAGNUM_TARGET_GLES2
+    _color.setStorage(RenderbufferFormat::RGBA8, FramebufferSize);
+    #else
+    _color.setStorage(RenderbufferFormat::RGBA4, FramebufferSize);
+    #endif
+    _framebuffer = Framebuffer{{{}, FramebufferSize}};
+    _framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment(0), _color)
+        .bind();
+
+    _texture = Texture2D{};
+    _texture.setMinificationFilter(Sampler::Filter::Linear)
+        .setMagnificationFilter(Sampler::Filter::Linear)
+        #ifndef MAGNUM_TARGET_GLES2
+        .setStorage(1, TextureFormat::RGBA8, Vector2i{256});
+        #else
+        .setStorage(1, TextureFormat::RGBA, Vector2i{256});
+        #endif
+
+    _vertices2D = Buffer{};
+    _vertices2D.setData(Quad2D, BufferUsage::StaticDraw);
+    _mesh2D = Mesh{};
+    _mesh2D.setPrimitive(MeshPrimitive::TriangleStrip)
+        .setCount(4)
+        .addVertexBuffer(_vertices2D, 0,
+            Generic2D::Position{},
+            Generic2D::TextureCoordinates{},
+            Generic2D::Color{Generic2D::Color::Components::Four});
+
+    _vertices3D = Buffer{};
+    _vertices3D.setData(Quad3D, BufferUsage::StaticDraw);
+    _mesh3D = Mesh{};
+    _mesh3D.setPrimitive(MeshPrimitive::TriangleStrip)
+        .setCount(4)
+        .addVertexBuffer(_vertices3D, 0,
+            Generic3D::Position{},
+            Generic3D::Normal{},
+            Generic3D::TextureCoordinates{});
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void ShadersGLBenchmark::skipIfNoTimeQuery() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::timer_query>())
+        CORRADE_SKIP(Extensions::GL::ARB::timer_query::string() + std::string(" is not available"));
+    #else
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::disjoint_timer_query>())
+        CORRADE_SKIP(Extensions::GL::EXT::disjoint_timer_query::string() + std::string(" is not available"));
+    #endif
+}
+
+void ShadersGLBenchmark::teardown() {
+    _mesh2D = Mesh{NoCreate};
+    _mesh3D = Mesh{NoCreate};
+    _vertices2D = Buffer{NoCreate};
+    _vertices3D = Buffer{NoCreate};
+    _texture = Texture2D{NoCreate};
+    _framebuffer = Framebuffer{NoCreate};
+    _color = Renderbuffer{NoCreate};
+}
+
+void ShadersGLBenchmark::flat() {
+    skipIfNoTimeQuery();
+
+    Flat2D shader;
+    shader.setColor(Color4{0.5f});
+
+    CORRADE_BENCHMARK(QuadCount)
+        _mesh2D.draw(shader);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void ShadersGLBenchmark::flatTextured() {
+    skipIfNoTimeQuery();
+
+    Flat2D shader{Flat2D::Flag::Textured};
+    shader.setTexture(_texture);
+
+    CORRADE_BENCHMARK(QuadCount)
+        _mesh2D.draw(shader);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void ShadersGLBenchmark::vertexColor() {
+    skipIfNoTimeQuery();
+
+    VertexColor2D shader;
+
+    CORRADE_BENCHMARK(QuadCount)
+        _mesh2D.draw(shader);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void ShadersGLBenchmark::vector() {
+    skipIfNoTimeQuery();
+
+    Vector2D shader;
+    shader.setColor(Color4{1.0f})
+        .setVectorTexture(_texture);
+
+    CORRADE_BENCHMARK(QuadCount)
+        _mesh2D.draw(shader);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void ShadersGLBenchmark::distanceFieldVector() {
+    skipIfNoTimeQuery();
+
+    DistanceFieldVector2D shader;
+    shader.setColor(Color4{1.0f})
+        .setOutlineColor(Color4{0.0f, 0.0f, 0.0f, 1.0f})
+        .setOutlineRange(0.5f, 0.3f)
+        .setVectorTexture(_texture);
+
+    CORRADE_BENCHMARK(QuadCount)
+        _mesh2D.draw(shader);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void ShadersGLBenchmark::phong() {
+    skipIfNoTimeQuery();
+
+    Phong shader;
+    shader.setDiffuseColor(Color4{0.5f})
+        .setLightPosition({0.0f, 0.0f, 1.0f});
+
+    CORRADE_BENCHMARK(QuadCount)
+        _mesh3D.draw(shader);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void ShadersGLBenchmark::phongDiffuseTexture() {
+    skipIfNoTimeQuery();
+
+    Phong shader{Phong::Flag::DiffuseTexture};
+    shader.setDiffuseTexture(_texture)
+        .setLightPosition({0.0f, 0.0f, 1.0f});
+
+    CORRADE_BENCHMARK(QuadCount)
+        _mesh3D.draw(shader);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void ShadersGLBenchmark::meshVisualizer() {
+    skipIfNoTimeQuery();
+
+    MeshVisualizer shader;
+    shader.setColor(Color4{0.5f});
+
+    CORRADE_BENCHMARK(QuadCount)
+        _mesh3D.draw(shader);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::ShadersGLBenchmark)
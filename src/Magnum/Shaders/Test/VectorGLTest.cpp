@@ -23,6 +23,8 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
 #include "Magnum/OpenGLTester.h"
 #include "Magnum/Shaders/Vector.h"
 
@@ -33,11 +35,20 @@ struct VectorGLTest: OpenGLTester {
 
     void compile2D();
     void compile3D();
+    #ifndef MAGNUM_TARGET_GLES2
+    void compile2DTextureArrays();
+    void compile3DTextureArrays();
+    #endif
 };
 
 VectorGLTest::VectorGLTest() {
     addTests({&VectorGLTest::compile2D,
               &VectorGLTest::compile3D});
+
+    #ifndef MAGNUM_TARGET_GLES2
+    addTests({&VectorGLTest::compile2DTextureArrays,
+              &VectorGLTest::compile3DTextureArrays});
+    #endif
 }
 
 void VectorGLTest::compile2D() {
@@ -60,6 +71,42 @@ void VectorGLTest::compile3D() {
     }
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void VectorGLTest::compile2DTextureArrays() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::texture_array>())
+        CORRADE_SKIP(Extensions::GL::EXT::texture_array::string() + std::string(" is not supported."));
+    #endif
+
+    Shaders::Vector2D shader{Shaders::Vector2D::Flag::TextureArrays};
+    CORRADE_VERIFY(shader.flags() & Shaders::Vector2D::Flag::TextureArrays);
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES2
+void VectorGLTest::compile3DTextureArrays() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::texture_array>())
+        CORRADE_SKIP(Extensions::GL::EXT::texture_array::string() + std::string(" is not supported."));
+    #endif
+
+    Shaders::Vector3D shader{Shaders::Vector3D::Flag::TextureArrays};
+    CORRADE_VERIFY(shader.flags() & Shaders::Vector3D::Flag::TextureArrays);
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+#endif
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Shaders::Test::VectorGLTest)
@@ -33,11 +33,15 @@ struct VertexColorGLTest: OpenGLTester {
 
     void compile2D();
     void compile3D();
+    void compile2DInstanced();
+    void compile3DInstanced();
 };
 
 VertexColorGLTest::VertexColorGLTest() {
     addTests({&VertexColorGLTest::compile2D,
-              &VertexColorGLTest::compile3D});
+              &VertexColorGLTest::compile3D,
+              &VertexColorGLTest::compile2DInstanced,
+              &VertexColorGLTest::compile3DInstanced});
 }
 
 void VertexColorGLTest::compile2D() {
@@ -60,6 +64,26 @@ void VertexColorGLTest::compile3D() {
     }
 }
 
+void VertexColorGLTest::compile2DInstanced() {
+    Shaders::VertexColor2D shader{Shaders::VertexColor2D::Flag::InstancedTransformation};
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
+void VertexColorGLTest::compile3DInstanced() {
+    Shaders::VertexColor3D shader{Shaders::VertexColor3D::Flag::InstancedTransformation};
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("OSX drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Shaders::Test::VertexColorGLTest)
@@ -0,0 +1,122 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Shaders/Generic.h"
+#include "Magnum/Shaders/VertexPulling.h"
+
+namespace Magnum { namespace Shaders { namespace Test {
+
+struct VertexPullingTest: TestSuite::Tester {
+    explicit VertexPullingTest();
+
+    void layout();
+    void construct();
+
+    void setAttribute();
+    void setAttributeNormalized();
+    void setAttributeInvalidLocation();
+    void setAttributeInvalidType();
+    void setAttributeUnaligned();
+};
+
+VertexPullingTest::VertexPullingTest() {
+    addTests({&VertexPullingTest::layout,
+              &VertexPullingTest::construct,
+
+              &VertexPullingTest::setAttribute,
+              &VertexPullingTest::setAttributeNormalized,
+              &VertexPullingTest::setAttributeInvalidLocation,
+              &VertexPullingTest::setAttributeInvalidType,
+              &VertexPullingTest::setAttributeUnaligned});
+}
+
+void VertexPullingTest::layout() {
+    VertexPullingLayout layouts[2];
+    layouts[1].attributes[2] = {1, 2, 3, 4};
+
+    /* Matches the std430 layout of the shader struct */
+    const char* data = reinterpret_cast<const char*>(layouts);
+    CORRADE_COMPARE(*reinterpret_cast<const Vector4ui*>(data + 64 + 32), (Vector4ui{1, 2, 3, 4}));
+}
+
+void VertexPullingTest::construct() {
+    VertexPullingLayout layout;
+    for(std::size_t i = 0; i != VertexPullingLayout::AttributeCount; ++i)
+        CORRADE_COMPARE(layout.attributes[i], Vector4ui{});
+}
+
+void VertexPullingTest::setAttribute() {
+    VertexPullingLayout layout;
+    layout.setAttribute(Generic3D::Position{}, 1024, 20)
+        .setAttribute(Generic3D::TextureCoordinates{Generic3D::TextureCoordinates::DataType::HalfFloat}, 1036, 20);
+
+    CORRADE_COMPARE(layout.attributes[0], (Vector4ui{1024, 20, GL_FLOAT, 3}));
+    CORRADE_COMPARE(layout.attributes[1], (Vector4ui{1036, 20, GL_HALF_FLOAT, 2}));
+    CORRADE_COMPARE(layout.attributes[2], Vector4ui{});
+    CORRADE_COMPARE(layout.attributes[3], Vector4ui{});
+}
+
+void VertexPullingTest::setAttributeNormalized() {
+    VertexPullingLayout layout;
+    layout.setAttribute(Generic3D::Color{Generic3D::Color::Components::Four, Generic3D::Color::DataType::UnsignedByte, Generic3D::Color::DataOption::Normalized}, 13, 17);
+
+    CORRADE_COMPARE(layout.attributes[3], (Vector4ui{13, 17, GL_UNSIGNED_BYTE, 0x104}));
+}
+
+void VertexPullingTest::setAttributeInvalidLocation() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    VertexPullingLayout layout;
+    layout.setAttribute(Generic3D::JointWeights{}, 0, 16);
+
+    CORRADE_COMPARE(out.str(), "Shaders::VertexPullingLayout::setAttribute(): location 7 out of range for 4 attributes\n");
+}
+
+void VertexPullingTest::setAttributeInvalidType() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    VertexPullingLayout layout;
+    layout.setAttribute(Generic3D::Position{Generic3D::Position::DataType::Double}, 0, 24);
+
+    CORRADE_COMPARE(out.str(), "Shaders::VertexPullingLayout::setAttribute(): unsupported data type 0x140a\n");
+}
+
+void VertexPullingTest::setAttributeUnaligned() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    VertexPullingLayout layout;
+    layout.setAttribute(Generic3D::Position{Generic3D::Position::DataType::Short}, 2, 7);
+
+    CORRADE_COMPARE(out.str(), "Shaders::VertexPullingLayout::setAttribute(): offset 2 and stride 7 are not aligned to 2 bytes\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::VertexPullingTest)
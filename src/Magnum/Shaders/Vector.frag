@@ -42,9 +42,17 @@ uniform lowp vec4 color;
 #ifdef EXPLICIT_TEXTURE_LAYER
 layout(binding = 15)
 #endif
+#ifndef TEXTURE_ARRAYS
 uniform lowp sampler2D vectorTexture;
+#else
+uniform lowp sampler2DArray vectorTexture;
+#endif
 
+#ifndef TEXTURE_ARRAYS
 in mediump vec2 fragmentTextureCoordinates;
+#else
+in mediump vec3 fragmentTextureCoordinates;
+#endif
 
 #ifdef NEW_GLSL
 out lowp vec4 fragmentColor;
@@ -29,6 +29,8 @@
  * @brief Class @ref Magnum::Shaders::Vector, typedef @ref Magnum::Shaders::Vector2D, @ref Magnum::Shaders::Vector3D
  */
 
+#include <Corrade/Containers/EnumSet.h>
+
 #include "Magnum/DimensionTraits.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Matrix3.h"
@@ -38,6 +40,15 @@
 
 namespace Magnum { namespace Shaders {
 
+namespace Implementation {
+    enum class VectorFlag: UnsignedByte {
+        #ifndef MAGNUM_TARGET_GLES2
+        TextureArrays = 1 << 0
+        #endif
+    };
+    typedef Containers::EnumSet<VectorFlag> VectorFlags;
+}
+
 /**
 @brief Vector shader
 
@@ -83,11 +94,50 @@ shader.setColor(Color3::fromHSV(216.0_degf, 0.85f, 1.0f))
 mesh.draw(shader);
 @endcode
 
+If @ref Flag::TextureArrays is passed to the constructor, the shader samples a
+@ref Texture2DArray instead and the mesh is expected to provide
+@ref TextureArrayCoordinates with the layer index in the last component, such
+as the vertex data produced by @ref Text::Renderer for a
+@ref Text::GlyphCacheArray.
+
 @see @ref shaders, @ref Vector2D, @ref Vector3D
 */
 template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Vector: public AbstractVector<dimensions> {
     public:
-        explicit Vector();
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        /**
+         * @brief Flag
+         *
+         * @see @ref Flags, @ref flags()
+         */
+        enum class Flag: UnsignedByte {
+            /**
+             * Sample a @ref Texture2DArray using @ref TextureArrayCoordinates
+             * @requires_gl30 Extension @extension{EXT,texture_array}
+             * @requires_gles30 Array textures are not available in OpenGL ES
+             *      2.0.
+             * @requires_webgl20 Array textures are not available in WebGL
+             *      1.0.
+             */
+            TextureArrays = 1 << 0
+        };
+
+        /**
+         * @brief Flags
+         *
+         * @see @ref flags()
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+        #else
+        typedef Implementation::VectorFlag Flag;
+        typedef Implementation::VectorFlags Flags;
+        #endif
+
+        /**
+         * @brief Constructor
+         * @param flags     Flags
+         */
+        explicit Vector(Flags flags = {});
 
         /**
          * @brief Construct without creating the underlying OpenGL object
@@ -106,6 +156,9 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Vector: public Abst
             #endif
             {}
 
+        /** @brief Flags */
+        Flags flags() const { return _flags; }
+
         /**
          * @brief Set transformation and projection matrix
          * @return Reference to self (for method chaining)
@@ -144,9 +197,16 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Vector: public Abst
             AbstractVector<dimensions>::setVectorTexture(texture);
             return *this;
         }
+        #ifndef MAGNUM_TARGET_GLES2
+        Vector<dimensions>& setVectorTexture(Texture2DArray& texture) {
+            AbstractVector<dimensions>::setVectorTexture(texture);
+            return *this;
+        }
+        #endif
         #endif
 
     private:
+        Flags _flags;
         Int _transformationProjectionMatrixUniform{0},
             _backgroundColorUniform{1},
             _colorUniform{2};
@@ -158,6 +218,8 @@ typedef Vector<2> Vector2D;
 /** @brief Three-dimensional vector shader */
 typedef Vector<3> Vector3D;
 
+CORRADE_ENUMSET_OPERATORS(Implementation::VectorFlags)
+
 }}
 
 #endif
@@ -41,7 +41,7 @@ namespace {
     template<> constexpr const char* vertexShaderName<3>() { return "VertexColor3D.vert"; }
 }
 
-template<UnsignedInt dimensions> VertexColor<dimensions>::VertexColor() {
+template<UnsignedInt dimensions> typename VertexColor<dimensions>::CompileState VertexColor<dimensions>::compile(const Flags flags) {
     #ifdef MAGNUM_BUILD_STATIC
     /* Import resources on static build, if not already */
     if(!Utility::Resource::hasGroup("MagnumShaders"))
@@ -58,25 +58,40 @@ template<UnsignedInt dimensions> VertexColor<dimensions>::VertexColor() {
     Shader vert = Implementation::createCompatibilityShader(rs, version, Shader::Type::Vertex);
     Shader frag = Implementation::createCompatibilityShader(rs, version, Shader::Type::Fragment);
 
-    vert.addSource(rs.get("generic.glsl"))
+    vert.addSource(flags & Flag::InstancedTransformation ? "#define INSTANCED_TRANSFORMATION\n" : "")
+        .addSource(rs.get("generic.glsl"))
         .addSource(rs.get(vertexShaderName<dimensions>()));
     frag.addSource(rs.get("VertexColor.frag"));
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, frag}));
+    VertexColor<dimensions> out{Math::NoInit};
+    out._flags = flags;
+
+    const auto bindAttributeLocations = [&]() {
+        #ifndef MAGNUM_TARGET_GLES
+        if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_attrib_location>(version))
+        #else
+        if(!Context::current().isVersionSupported(Version::GLES300))
+        #endif
+        {
+            out.bindAttributeLocation(Position::Location, "position");
+            out.bindAttributeLocation(Color::Location, "color");
+            if(flags & Flag::InstancedTransformation) out.bindAttributeLocation(TransformationMatrix::Location, "instancedTransformationMatrix");
+        }
+    };
+    const bool loaded = out.submitCompileAndLink({vert, frag}, bindAttributeLocations);
+
+    return CompileState{std::move(out), std::move(vert), std::move(frag), version, loaded};
+}
+
+template<UnsignedInt dimensions> VertexColor<dimensions>::VertexColor(const Flags flags): VertexColor{compile(flags)} {}
 
-    attachShaders({vert, frag});
+template<UnsignedInt dimensions> VertexColor<dimensions>::VertexColor(CompileState&& state): VertexColor{static_cast<VertexColor&&>(std::move(state))} {
+    if(!state._loaded)
+        CORRADE_INTERNAL_ASSERT_OUTPUT(checkCompileAndLink({state._vert, state._frag}));
 
     #ifndef MAGNUM_TARGET_GLES
-    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_attrib_location>(version))
-    #else
-    if(!Context::current().isVersionSupported(Version::GLES300))
+    const Version version = state._version;
     #endif
-    {
-        bindAttributeLocation(Position::Location, "position");
-        bindAttributeLocation(Color::Location, "color");
-    }
-
-    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
 
     #ifndef MAGNUM_TARGET_GLES
     if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_uniform_location>(version))
@@ -34,11 +34,17 @@
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shader.h"
 #include "Magnum/Shaders/Generic.h"
 #include "Magnum/Shaders/visibility.h"
 
 namespace Magnum { namespace Shaders {
 
+namespace Implementation {
+    enum class VertexColorFlag: UnsignedByte { InstancedTransformation = 1 << 0 };
+    typedef Containers::EnumSet<VertexColorFlag> VertexColorFlags;
+}
+
 /**
 @brief Vertex color shader
 
@@ -82,6 +88,10 @@ shader.setTransformationProjectionMatrix(projectionMatrix*transformationMatrix);
 mesh.draw(shader);
 @endcode
 
+With @ref Flag::InstancedTransformation the shader additionally reads a
+per-instance @ref TransformationMatrix attribute, see
+@ref Flat-instancing "Flat shader docs" for an example.
+
 @see @ref shaders, @ref VertexColor2D, @ref VertexColor3D
 */
 template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT VertexColor: public AbstractShaderProgram {
@@ -103,7 +113,78 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT VertexColor: public
          */
         typedef typename Generic<dimensions>::Color Color;
 
-        explicit VertexColor();
+        /**
+         * @brief Instanced transformation matrix
+         *
+         * @ref shaders-generic "Generic attribute", @ref Matrix3 in 2D,
+         * @ref Matrix4 in 3D. Used only if @ref Flag::InstancedTransformation
+         * is set.
+         * @requires_gl33 Extension @extension{ARB,instanced_arrays}
+         * @requires_gles30 Extension @es_extension{ANGLE,instanced_arrays},
+         *      @es_extension{EXT,instanced_arrays} or
+         *      @es_extension{NV,instanced_arrays} in OpenGL ES 2.0.
+         * @requires_webgl20 Extension @webgl_extension{ANGLE,instanced_arrays}
+         *      in WebGL 1.0.
+         */
+        typedef typename Generic<dimensions>::TransformationMatrix TransformationMatrix;
+
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        /**
+         * @brief Flag
+         *
+         * @see @ref Flags, @ref flags()
+         */
+        enum class Flag: UnsignedByte {
+            /**
+             * Multiply the transformation with the per-instance
+             * @ref TransformationMatrix attribute.
+             */
+            InstancedTransformation = 1 << 0
+        };
+
+        /**
+         * @brief Flags
+         *
+         * @see @ref flags()
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+        #else
+        typedef Implementation::VertexColorFlag Flag;
+        typedef Implementation::VertexColorFlags Flags;
+        #endif
+
+        class CompileState;
+
+        /**
+         * @brief Submit compilation of the shader
+         * @param flags     Flags
+         *
+         * Submits compilation and linking of the shader but doesn't wait for
+         * it to finish, so the driver can do the work in the background ---
+         * especially if @extension{KHR,parallel_shader_compile} is
+         * supported. Pass the returned value to
+         * @ref VertexColor(CompileState&&) to finish the construction.
+         * @see @ref Flat::compile()
+         */
+        static CompileState compile(Flags flags = {});
+
+        /**
+         * @brief Constructor
+         * @param flags     Flags
+         *
+         * Equivalent to calling @ref VertexColor(CompileState&&) on the
+         * result of @ref compile().
+         */
+        explicit VertexColor(Flags flags = {});
+
+        /**
+         * @brief Finalize an asynchronous compilation
+         *
+         * Takes an instance returned from @ref compile(), waits for the
+         * compilation and linking to finish, if not already, and queries
+         * uniform locations.
+         */
+        explicit VertexColor(CompileState&& state);
 
         /**
          * @brief Construct without creating the underlying OpenGL object
@@ -117,6 +198,9 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT VertexColor: public
          */
         explicit VertexColor(NoCreateT) noexcept: AbstractShaderProgram{NoCreate} {}
 
+        /** @brief Flags */
+        Flags flags() const { return _flags; }
+
         /**
          * @brief Set transformation and projection matrix
          * @return Reference to self (for method chaining)
@@ -129,15 +213,40 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT VertexColor: public
         }
 
     private:
+        /* Creates the GL object but doesn't compile anything, used by
+           compile() */
+        explicit VertexColor(Math::NoInitT) {}
+
+        Flags _flags;
         Int _transformationProjectionMatrixUniform{0};
 };
 
+/**
+@brief Asynchronous compilation state
+
+Returned by @ref VertexColor::compile(), holds the shader sources until
+they're compiled and linked. Pass it to
+@ref VertexColor::VertexColor(CompileState&&) to finish the construction.
+*/
+template<UnsignedInt dimensions> class VertexColor<dimensions>::CompileState: public VertexColor<dimensions> {
+    private:
+        friend VertexColor;
+
+        explicit CompileState(VertexColor<dimensions>&& shader, Shader&& vert, Shader&& frag, Version version, bool loaded): VertexColor<dimensions>{std::move(shader)}, _vert{std::move(vert)}, _frag{std::move(frag)}, _version{version}, _loaded{loaded} {}
+
+        Shader _vert, _frag;
+        Version _version;
+        bool _loaded;
+};
+
 /** @brief 2D vertex color shader */
 typedef VertexColor<2> VertexColor2D;
 
 /** @brief 3D vertex color shader */
 typedef VertexColor<3> VertexColor3D;
 
+CORRADE_ENUMSET_OPERATORS(Implementation::VertexColorFlags)
+
 }}
 
 #endif
@@ -0,0 +1,68 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "VertexPulling.h"
+
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+namespace Magnum { namespace Shaders {
+
+VertexPullingLayout& VertexPullingLayout::setAttribute(const UnsignedInt location, const GLenum dataType, const UnsignedInt components, const bool normalized, const UnsignedInt offset, const UnsignedInt stride) {
+    CORRADE_ASSERT(location < AttributeCount,
+        "Shaders::VertexPullingLayout::setAttribute(): location" << location << "out of range for" << AttributeCount << "attributes", *this);
+    CORRADE_ASSERT(components >= 1 && components <= 4,
+        "Shaders::VertexPullingLayout::setAttribute(): unsupported component count" << components, *this);
+
+    UnsignedInt size;
+    switch(dataType) {
+        case GL_UNSIGNED_BYTE:
+        case GL_BYTE:
+            size = 1;
+            break;
+        case GL_UNSIGNED_SHORT:
+        case GL_SHORT:
+        case GL_HALF_FLOAT:
+            size = 2;
+            break;
+        case GL_UNSIGNED_INT:
+        case GL_INT:
+        case GL_FLOAT:
+            size = 4;
+            break;
+        default:
+            CORRADE_ASSERT(false,
+                "Shaders::VertexPullingLayout::setAttribute(): unsupported data type" << reinterpret_cast<void*>(dataType), *this);
+            return *this; /* LCOV_EXCL_LINE */
+    }
+
+    CORRADE_ASSERT(offset % size == 0 && stride % size == 0,
+        "Shaders::VertexPullingLayout::setAttribute(): offset" << offset << "and stride" << stride << "are not aligned to" << size << "bytes", *this);
+
+    attributes[location] = {offset, stride, dataType, components|(normalized ? 0x100 : 0)};
+    return *this;
+}
+
+}}
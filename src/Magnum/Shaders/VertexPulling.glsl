@@ -0,0 +1,94 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+/* Programmable vertex pulling. The vertex data are fetched from a raw
+   storage buffer based on per-draw layout matching the
+   Shaders::VertexPullingLayout struct. */
+
+layout(std430, binding = 0) readonly buffer VertexData {
+    highp uint vertexData[];
+};
+
+struct VertexPullingLayout {
+    /* offset, stride, data type, component count | normalized << 8 */
+    highp uvec4 attributes[4];
+};
+
+layout(std430, binding = 1) readonly buffer VertexLayout {
+    VertexPullingLayout vertexLayouts[];
+};
+
+highp float fetchComponent(highp uint address, highp uint type, bool normalized) {
+    highp uint word = vertexData[address >> 2u];
+    highp int shift = int(address & 3u)*8;
+
+    /* GL_FLOAT */
+    if(type == 0x1406u) return uintBitsToFloat(word);
+    /* GL_HALF_FLOAT */
+    if(type == 0x140Bu) return unpackHalf2x16(word >> uint(shift)).x;
+    /* GL_UNSIGNED_BYTE */
+    if(type == 0x1401u) {
+        highp float value = float(bitfieldExtract(word, shift, 8));
+        return normalized ? value/255.0 : value;
+    }
+    /* GL_BYTE */
+    if(type == 0x1400u) {
+        highp float value = float(bitfieldExtract(int(word), shift, 8));
+        return normalized ? max(value/127.0, -1.0) : value;
+    }
+    /* GL_UNSIGNED_SHORT */
+    if(type == 0x1403u) {
+        highp float value = float(bitfieldExtract(word, shift, 16));
+        return normalized ? value/65535.0 : value;
+    }
+    /* GL_SHORT */
+    if(type == 0x1402u) {
+        highp float value = float(bitfieldExtract(int(word), shift, 16));
+        return normalized ? max(value/32767.0, -1.0) : value;
+    }
+    /* GL_UNSIGNED_INT */
+    if(type == 0x1405u) {
+        highp float value = float(word);
+        return normalized ? value/4294967295.0 : value;
+    }
+    /* GL_INT */
+    highp float value = float(int(word));
+    return normalized ? max(value/2147483647.0, -1.0) : value;
+}
+
+highp vec4 fetchAttribute(highp uint drawId, int location, highp vec4 defaults) {
+    highp uvec4 description = vertexLayouts[drawId].attributes[location];
+    highp uint components = description.w & 0xffu;
+    bool normalized = (description.w & 0x100u) != 0u;
+
+    /* Component size, the offsets are guaranteed to be aligned to it */
+    highp uint size = description.z == 0x1400u || description.z == 0x1401u ? 1u :
+        description.z == 0x1402u || description.z == 0x1403u || description.z == 0x140Bu ? 2u : 4u;
+
+    highp uint address = description.x + uint(gl_VertexID)*description.y;
+    for(highp uint i = 0u; i < components; ++i)
+        defaults[i] = fetchComponent(address + i*size, description.z, normalized);
+
+    return defaults;
+}
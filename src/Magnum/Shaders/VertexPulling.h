@@ -0,0 +1,117 @@
+#ifndef Magnum_Shaders_VertexPulling_h
+#define Magnum_Shaders_VertexPulling_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Struct @ref Magnum::Shaders::VertexPullingLayout
+ */
+
+#include "Magnum/configure.h"
+
+#ifndef MAGNUM_TARGET_GLES
+#include "Magnum/Attribute.h"
+#include "Magnum/Math/Vector4.h"
+#include "Magnum/Shaders/visibility.h"
+
+namespace Magnum { namespace Shaders {
+
+/**
+@brief Per-draw vertex layout for programmable vertex pulling
+
+Matches the `std430` layout of the per-draw vertex layout buffer used by
+@ref Flat with @ref Flat::Flag::VertexPulling enabled. Describes where the
+shader fetches attributes of one draw from the vertex data buffer, so
+meshes with completely different vertex layouts can be drawn in a single
+multi-draw call without any vertex array object changes. See
+@ref Flat-vertex-pulling for an example.
+
+The layout is filled from the same @ref Attribute descriptions that would be
+otherwise passed to @ref Mesh::addVertexBuffer(). Only attributes with
+floating-point shader type can be fetched, the data can be in any of the
+@ref Attribute::DataType::Float, @ref Attribute::DataType::HalfFloat,
+@ref Attribute::DataType::UnsignedByte, @ref Attribute::DataType::Byte,
+@ref Attribute::DataType::UnsignedShort, @ref Attribute::DataType::Short,
+@ref Attribute::DataType::UnsignedInt and @ref Attribute::DataType::Int
+types, optionally normalized. Attributes not set use the same default value
+as a disabled vertex attribute.
+@requires_gl43 Extension @extension{ARB,shader_storage_buffer_object}
+@requires_gl Shader storage buffers are not used for vertex pulling in
+    OpenGL ES or WebGL.
+*/
+struct MAGNUM_SHADERS_EXPORT VertexPullingLayout {
+    enum: UnsignedInt {
+        /**
+         * Count of attribute locations, attributes with locations from `0`
+         * to @ref Generic::Color location can be specified
+         */
+        AttributeCount = 4
+    };
+
+    /**
+     * @brief Set attribute
+     * @param attribute Attribute description
+     * @param offset    Byte offset of the first vertex in the vertex data
+     *      buffer
+     * @param stride    Byte distance between consecutive vertices
+     * @return Reference to self (for method chaining)
+     *
+     * Expects that the attribute location is less than
+     * @ref AttributeCount, that the data type is one of the supported
+     * types and that both @p offset and @p stride are aligned to the
+     * component size.
+     */
+    template<UnsignedInt location, class T> VertexPullingLayout& setAttribute(const Attribute<location, T>& attribute, UnsignedInt offset, UnsignedInt stride) {
+        return setAttribute(location, GLenum(attribute.dataType()), UnsignedInt(attribute.components()), !!(attribute.dataOptions() & Attribute<location, T>::DataOption::Normalized), offset, stride);
+    }
+
+    /**
+     * @brief Set attribute using a runtime description
+     * @return Reference to self (for method chaining)
+     *
+     * Prefer to use @ref setAttribute(const Attribute<location, T>&, UnsignedInt, UnsignedInt)
+     * instead.
+     */
+    VertexPullingLayout& setAttribute(UnsignedInt location, GLenum dataType, UnsignedInt components, bool normalized, UnsignedInt offset, UnsignedInt stride);
+
+    /**
+     * @brief Attributes
+     *
+     * Byte offset, byte stride, data type and component count for each
+     * attribute location. The component count is in the lowest 8 bits of
+     * the last component, normalization flag in the 9th bit. Zero
+     * component count means the attribute is not present.
+     */
+    Vector4ui attributes[AttributeCount]{};
+};
+
+static_assert(sizeof(VertexPullingLayout) == 64, "VertexPullingLayout doesn't match std430 layout");
+
+}}
+#else
+#error this header is available only in desktop OpenGL build
+#endif
+
+#endif
@@ -29,6 +29,7 @@
 
 #include "Magnum/Shapes/Collision.h"
 #include "Magnum/Shapes/ShapeGroup.h"
+#include "Magnum/Shapes/Implementation/Bounds.h"
 #include "Magnum/Shapes/Implementation/CollisionDispatch.h"
 
 namespace Magnum { namespace Shapes {
@@ -57,7 +58,12 @@ template<UnsignedInt dimensions> Collision<dimensions> AbstractShape<dimensions>
     return Implementation::collision(abstractTransformedShape(), other.abstractTransformedShape());
 }
 
+template<UnsignedInt dimensions> RangeTypeFor<dimensions, Float> AbstractShape<dimensions>::bounds() const {
+    return Implementation::bounds(abstractTransformedShape());
+}
+
 template<UnsignedInt dimensions> void AbstractShape<dimensions>::markDirty() {
+    ++_dirtyCount;
     if(group()) group()->setDirty();
 }
 
@@ -31,6 +31,7 @@
 
 #include "Magnum/Magnum.h"
 #include "Magnum/DimensionTraits.h"
+#include "Magnum/Math/Range.h"
 #include "Magnum/SceneGraph/AbstractGroupedFeature.h"
 #include "Magnum/Shapes/shapeImplementation.h"
 #include "Magnum/Shapes/visibility.h"
@@ -112,12 +113,35 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT AbstractShape: publi
          */
         Collision<dimensions> collision(const AbstractShape<dimensions>& other) const;
 
+        /**
+         * @brief Axis-aligned bounds of the transformed shape
+         *
+         * The bounds are conservative, i.e. if two shapes collide, their
+         * bounds always intersect. Shapes extending to infinity, such as
+         * lines, planes, cylinders, inverted spheres or compositions with
+         * @ref CompositionOperation::Not, have infinite bounds. Used by the
+         * broad phase in @ref ShapeGroup.
+         */
+        RangeTypeFor<dimensions, Float> bounds() const;
+
+        /**
+         * @brief Dirty count
+         *
+         * Incremented every time the shape is marked as dirty, i.e. when its
+         * transformation or the shape itself changes. Lets broad phases such
+         * as @ref SpatialHash2D detect changed shapes without recalculating
+         * @ref bounds() of all of them.
+         */
+        UnsignedInt dirtyCount() const { return _dirtyCount; }
+
     protected:
-        /** Marks also the group as dirty */
+        /** Marks also the group as dirty and increments @ref dirtyCount() */
         void markDirty() override;
 
     private:
         virtual const Implementation::AbstractShape<dimensions> MAGNUM_SHAPES_LOCAL & abstractTransformedShape() const = 0;
+
+        UnsignedInt _dirtyCount{};
 };
 
 /** @brief Base class for two-dimensional object shapes */
@@ -0,0 +1,351 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BatchCollision.h"
+
+#include <Corrade/Utility/Assert.h>
+
+#if defined(__AVX__)
+#define MAGNUM_SHAPES_BATCH_SIMD
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#define MAGNUM_SHAPES_BATCH_SIMD
+#include <emmintrin.h>
+#elif (defined(__ARM_NEON) || defined(__ARM_NEON__)) && defined(__aarch64__)
+/* 32-bit NEON doesn't have vector division */
+#define MAGNUM_SHAPES_BATCH_SIMD
+#include <arm_neon.h>
+#endif
+
+namespace Magnum { namespace Shapes {
+
+namespace {
+
+/* Thin wrappers so the kernels below are written only once for all
+   instruction sets and the scalar remainder. The operation order is the same
+   as in the per-shape collision functions, so the results are identical. */
+struct Scalar {
+    typedef Float Type;
+    typedef bool Mask;
+    enum: std::size_t { Size = 1 };
+
+    static Type load(const Float* const data) { return *data; }
+    static Type splat(const Float a) { return a; }
+    static Type add(const Type a, const Type b) { return a + b; }
+    static Type sub(const Type a, const Type b) { return a - b; }
+    static Type mul(const Type a, const Type b) { return a*b; }
+    static Type div(const Type a, const Type b) { return a/b; }
+    static Mask lt(const Type a, const Type b) { return a < b; }
+    static Mask gt(const Type a, const Type b) { return a > b; }
+    static Mask ge(const Type a, const Type b) { return a >= b; }
+    static Mask and_(const Mask a, const Mask b) { return a && b; }
+    static Type select(const Mask mask, const Type a, const Type b) { return mask ? a : b; }
+    static void store(bool* const out, const Mask mask) { *out = mask; }
+};
+
+#if defined(__AVX__)
+struct Simd {
+    typedef __m256 Type;
+    typedef __m256 Mask;
+    enum: std::size_t { Size = 8 };
+
+    static Type load(const Float* const data) { return _mm256_loadu_ps(data); }
+    static Type splat(const Float a) { return _mm256_set1_ps(a); }
+    static Type add(const Type a, const Type b) { return _mm256_add_ps(a, b); }
+    static Type sub(const Type a, const Type b) { return _mm256_sub_ps(a, b); }
+    static Type mul(const Type a, const Type b) { return _mm256_mul_ps(a, b); }
+    static Type div(const Type a, const Type b) { return _mm256_div_ps(a, b); }
+    static Mask lt(const Type a, const Type b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static Mask gt(const Type a, const Type b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    static Mask ge(const Type a, const Type b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+    static Mask and_(const Mask a, const Mask b) { return _mm256_and_ps(a, b); }
+    static Type select(const Mask mask, const Type a, const Type b) { return _mm256_blendv_ps(b, a, mask); }
+    static void store(bool* const out, const Mask mask) {
+        const Int bits = _mm256_movemask_ps(mask);
+        for(std::size_t i = 0; i != Size; ++i) out[i] = (bits >> i) & 1;
+    }
+};
+#elif defined(__SSE2__)
+struct Simd {
+    typedef __m128 Type;
+    typedef __m128 Mask;
+    enum: std::size_t { Size = 4 };
+
+    static Type load(const Float* const data) { return _mm_loadu_ps(data); }
+    static Type splat(const Float a) { return _mm_set1_ps(a); }
+    static Type add(const Type a, const Type b) { return _mm_add_ps(a, b); }
+    static Type sub(const Type a, const Type b) { return _mm_sub_ps(a, b); }
+    static Type mul(const Type a, const Type b) { return _mm_mul_ps(a, b); }
+    static Type div(const Type a, const Type b) { return _mm_div_ps(a, b); }
+    static Mask lt(const Type a, const Type b) { return _mm_cmplt_ps(a, b); }
+    static Mask gt(const Type a, const Type b) { return _mm_cmpgt_ps(a, b); }
+    static Mask ge(const Type a, const Type b) { return _mm_cmpge_ps(a, b); }
+    static Mask and_(const Mask a, const Mask b) { return _mm_and_ps(a, b); }
+    static Type select(const Mask mask, const Type a, const Type b) {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+    static void store(bool* const out, const Mask mask) {
+        const Int bits = _mm_movemask_ps(mask);
+        for(std::size_t i = 0; i != Size; ++i) out[i] = (bits >> i) & 1;
+    }
+};
+#elif defined(MAGNUM_SHAPES_BATCH_SIMD)
+struct Simd {
+    typedef float32x4_t Type;
+    typedef uint32x4_t Mask;
+    enum: std::size_t { Size = 4 };
+
+    static Type load(const Float* const data) { return vld1q_f32(data); }
+    static Type splat(const Float a) { return vdupq_n_f32(a); }
+    static Type add(const Type a, const Type b) { return vaddq_f32(a, b); }
+    static Type sub(const Type a, const Type b) { return vsubq_f32(a, b); }
+    static Type mul(const Type a, const Type b) { return vmulq_f32(a, b); }
+    static Type div(const Type a, const Type b) { return vdivq_f32(a, b); }
+    static Mask lt(const Type a, const Type b) { return vcltq_f32(a, b); }
+    static Mask gt(const Type a, const Type b) { return vcgtq_f32(a, b); }
+    static Mask ge(const Type a, const Type b) { return vcgeq_f32(a, b); }
+    static Mask and_(const Mask a, const Mask b) { return vandq_u32(a, b); }
+    static Type select(const Mask mask, const Type a, const Type b) { return vbslq_f32(mask, a, b); }
+    static void store(bool* const out, const Mask mask) {
+        out[0] = vgetq_lane_u32(mask, 0);
+        out[1] = vgetq_lane_u32(mask, 1);
+        out[2] = vgetq_lane_u32(mask, 2);
+        out[3] = vgetq_lane_u32(mask, 3);
+    }
+};
+#endif
+
+/* The first operand is either one shape tested against all, or an array */
+template<class S, bool broadcast> inline typename S::Type loadFirst(const Float* const data, const std::size_t i) {
+    return broadcast ? S::splat(*data) : S::load(data + i);
+}
+
+/* Squared distance of the point from the sphere center or the capsule
+   segment, see Math::Geometry::Distance::lineSegmentPointSquared() */
+template<class S, bool broadcast, UnsignedInt dimensions> struct SegmentDistance;
+
+template<class S, bool broadcast> struct SegmentDistance<S, broadcast, 2> {
+    static typename S::Type squared(const CapsuleBatch<2>& a, const Float* const* const point, const std::size_t i, const std::size_t j) {
+        const typename S::Type ax = loadFirst<S, broadcast>(a.a(0), i);
+        const typename S::Type ay = loadFirst<S, broadcast>(a.a(1), i);
+        const typename S::Type bx = loadFirst<S, broadcast>(a.b(0), i);
+        const typename S::Type by = loadFirst<S, broadcast>(a.b(1), i);
+        const typename S::Type px = S::load(point[0] + j);
+        const typename S::Type py = S::load(point[1] + j);
+
+        const typename S::Type pointMinusAx = S::sub(px, ax), pointMinusAy = S::sub(py, ay);
+        const typename S::Type pointMinusBx = S::sub(px, bx), pointMinusBy = S::sub(py, by);
+        const typename S::Type bMinusAx = S::sub(bx, ax), bMinusAy = S::sub(by, ay);
+        const typename S::Type pointDistanceA = S::add(S::mul(pointMinusAx, pointMinusAx), S::mul(pointMinusAy, pointMinusAy));
+        const typename S::Type pointDistanceB = S::add(S::mul(pointMinusBx, pointMinusBx), S::mul(pointMinusBy, pointMinusBy));
+        const typename S::Type bDistanceA = S::add(S::mul(bMinusAx, bMinusAx), S::mul(bMinusAy, bMinusAy));
+
+        /* cross(bMinusA, -pointMinusA) */
+        const typename S::Type cross = S::sub(
+            S::mul(bMinusAx, S::sub(ay, py)),
+            S::mul(bMinusAy, S::sub(ax, px)));
+        const typename S::Type between = S::div(S::mul(cross, cross), bDistanceA);
+
+        return S::select(S::gt(pointDistanceB, S::add(bDistanceA, pointDistanceA)), pointDistanceA,
+               S::select(S::gt(pointDistanceA, S::add(bDistanceA, pointDistanceB)), pointDistanceB, between));
+    }
+};
+
+template<class S, bool broadcast> struct SegmentDistance<S, broadcast, 3> {
+    static typename S::Type squared(const CapsuleBatch<3>& a, const Float* const* const point, const std::size_t i, const std::size_t j) {
+        typename S::Type pointMinusA[3], pointMinusB[3], bMinusA[3];
+        for(UnsignedInt k = 0; k != 3; ++k) {
+            const typename S::Type ak = loadFirst<S, broadcast>(a.a(k), i);
+            const typename S::Type bk = loadFirst<S, broadcast>(a.b(k), i);
+            const typename S::Type pk = S::load(point[k] + j);
+            pointMinusA[k] = S::sub(pk, ak);
+            pointMinusB[k] = S::sub(pk, bk);
+            bMinusA[k] = S::sub(bk, ak);
+        }
+
+        const typename S::Type pointDistanceA = S::add(S::add(S::mul(pointMinusA[0], pointMinusA[0]), S::mul(pointMinusA[1], pointMinusA[1])), S::mul(pointMinusA[2], pointMinusA[2]));
+        const typename S::Type pointDistanceB = S::add(S::add(S::mul(pointMinusB[0], pointMinusB[0]), S::mul(pointMinusB[1], pointMinusB[1])), S::mul(pointMinusB[2], pointMinusB[2]));
+        const typename S::Type bDistanceA = S::add(S::add(S::mul(bMinusA[0], bMinusA[0]), S::mul(bMinusA[1], bMinusA[1])), S::mul(bMinusA[2], bMinusA[2]));
+
+        /* cross(pointMinusA, pointMinusB).dot() */
+        const typename S::Type cx = S::sub(S::mul(pointMinusA[1], pointMinusB[2]), S::mul(pointMinusA[2], pointMinusB[1]));
+        const typename S::Type cy = S::sub(S::mul(pointMinusA[2], pointMinusB[0]), S::mul(pointMinusA[0], pointMinusB[2]));
+        const typename S::Type cz = S::sub(S::mul(pointMinusA[0], pointMinusB[1]), S::mul(pointMinusA[1], pointMinusB[0]));
+        const typename S::Type between = S::div(S::add(S::add(S::mul(cx, cx), S::mul(cy, cy)), S::mul(cz, cz)), bDistanceA);
+
+        return S::select(S::gt(pointDistanceB, S::add(bDistanceA, pointDistanceA)), pointDistanceA,
+               S::select(S::gt(pointDistanceA, S::add(bDistanceA, pointDistanceB)), pointDistanceB, between));
+    }
+};
+
+template<UnsignedInt dimensions> struct SpherePoint {
+    typedef SphereBatch<dimensions> First;
+    typedef PointBatch<dimensions> Second;
+
+    template<class S, bool broadcast> static void run(const First& a, const Second& b, const std::size_t begin, const std::size_t end, bool* const out) {
+        for(std::size_t j = begin; j != end; j += S::Size) {
+            const std::size_t i = broadcast ? 0 : j;
+            typename S::Type distance = S::splat(0.0f);
+            for(UnsignedInt k = 0; k != dimensions; ++k) {
+                const typename S::Type d = S::sub(loadFirst<S, broadcast>(a.positions(k), i), S::load(b.positions(k) + j));
+                distance = S::add(distance, S::mul(d, d));
+            }
+            const typename S::Type radius = loadFirst<S, broadcast>(a.radii(), i);
+            S::store(out + j, S::lt(distance, S::mul(radius, radius)));
+        }
+    }
+};
+
+template<UnsignedInt dimensions> struct SphereSphere {
+    typedef SphereBatch<dimensions> First;
+    typedef SphereBatch<dimensions> Second;
+
+    template<class S, bool broadcast> static void run(const First& a, const Second& b, const std::size_t begin, const std::size_t end, bool* const out) {
+        for(std::size_t j = begin; j != end; j += S::Size) {
+            const std::size_t i = broadcast ? 0 : j;
+            typename S::Type distance = S::splat(0.0f);
+            for(UnsignedInt k = 0; k != dimensions; ++k) {
+                const typename S::Type d = S::sub(loadFirst<S, broadcast>(a.positions(k), i), S::load(b.positions(k) + j));
+                distance = S::add(distance, S::mul(d, d));
+            }
+            const typename S::Type radius = S::add(loadFirst<S, broadcast>(a.radii(), i), S::load(b.radii() + j));
+            S::store(out + j, S::lt(distance, S::mul(radius, radius)));
+        }
+    }
+};
+
+template<UnsignedInt dimensions> struct AxisAlignedBoxPoint {
+    typedef AxisAlignedBoxBatch<dimensions> First;
+    typedef PointBatch<dimensions> Second;
+
+    template<class S, bool broadcast> static void run(const First& a, const Second& b, const std::size_t begin, const std::size_t end, bool* const out) {
+        for(std::size_t j = begin; j != end; j += S::Size) {
+            const std::size_t i = broadcast ? 0 : j;
+            const typename S::Type p0 = S::load(b.positions(0) + j);
+            typename S::Mask inside = S::and_(
+                S::ge(p0, loadFirst<S, broadcast>(a.min(0), i)),
+                S::lt(p0, loadFirst<S, broadcast>(a.max(0), i)));
+            for(UnsignedInt k = 1; k != dimensions; ++k) {
+                const typename S::Type p = S::load(b.positions(k) + j);
+                inside = S::and_(inside, S::and_(
+                    S::ge(p, loadFirst<S, broadcast>(a.min(k), i)),
+                    S::lt(p, loadFirst<S, broadcast>(a.max(k), i))));
+            }
+            S::store(out + j, inside);
+        }
+    }
+};
+
+template<UnsignedInt dimensions> struct CapsulePoint {
+    typedef CapsuleBatch<dimensions> First;
+    typedef PointBatch<dimensions> Second;
+
+    template<class S, bool broadcast> static void run(const First& a, const Second& b, const std::size_t begin, const std::size_t end, bool* const out) {
+        const Float* positions[dimensions];
+        for(UnsignedInt k = 0; k != dimensions; ++k) positions[k] = b.positions(k);
+
+        for(std::size_t j = begin; j != end; j += S::Size) {
+            const std::size_t i = broadcast ? 0 : j;
+            const typename S::Type radius = loadFirst<S, broadcast>(a.radii(), i);
+            S::store(out + j, S::lt(SegmentDistance<S, broadcast, dimensions>::squared(a, positions, i, j), S::mul(radius, radius)));
+        }
+    }
+};
+
+template<UnsignedInt dimensions> struct CapsuleSphere {
+    typedef CapsuleBatch<dimensions> First;
+    typedef SphereBatch<dimensions> Second;
+
+    template<class S, bool broadcast> static void run(const First& a, const Second& b, const std::size_t begin, const std::size_t end, bool* const out) {
+        const Float* positions[dimensions];
+        for(UnsignedInt k = 0; k != dimensions; ++k) positions[k] = b.positions(k);
+
+        for(std::size_t j = begin; j != end; j += S::Size) {
+            const std::size_t i = broadcast ? 0 : j;
+            const typename S::Type radius = S::add(loadFirst<S, broadcast>(a.radii(), i), S::load(b.radii() + j));
+            S::store(out + j, S::lt(SegmentDistance<S, broadcast, dimensions>::squared(a, positions, i, j), S::mul(radius, radius)));
+        }
+    }
+};
+
+/* Picks the kernel variant once per batch, the SIMD one for whole vectors
+   and the scalar one for the remainder */
+template<class Kernel> void dispatch(const char* const function, const typename Kernel::First& a, const typename Kernel::Second& b, const Containers::ArrayView<bool> results) {
+    CORRADE_ASSERT(a.size() == 1 || a.size() == b.size(),
+        "Shapes::collides(): expected" << function << "of" << b.size() << "or one element but got" << a.size(), );
+    CORRADE_ASSERT(results.size() == b.size(),
+        "Shapes::collides(): expected" << b.size() << "results but got" << results.size(), );
+    static_cast<void>(function);
+
+    const bool broadcast = a.size() == 1;
+    std::size_t i = 0;
+
+    #ifdef MAGNUM_SHAPES_BATCH_SIMD
+    const std::size_t simdEnd = b.size() - b.size() % Simd::Size;
+    if(broadcast) Kernel::template run<Simd, true>(a, b, 0, simdEnd, results.data());
+    else Kernel::template run<Simd, false>(a, b, 0, simdEnd, results.data());
+    i = simdEnd;
+    #endif
+
+    if(broadcast) Kernel::template run<Scalar, true>(a, b, i, b.size(), results.data());
+    else Kernel::template run<Scalar, false>(a, b, i, b.size(), results.data());
+}
+
+}
+
+template<UnsignedInt dimensions> void collides(const SphereBatch<dimensions>& a, const PointBatch<dimensions>& b, const Containers::ArrayView<bool> results) {
+    dispatch<SpherePoint<dimensions>>("a sphere batch", a, b, results);
+}
+
+template<UnsignedInt dimensions> void collides(const SphereBatch<dimensions>& a, const SphereBatch<dimensions>& b, const Containers::ArrayView<bool> results) {
+    dispatch<SphereSphere<dimensions>>("a sphere batch", a, b, results);
+}
+
+template<UnsignedInt dimensions> void collides(const AxisAlignedBoxBatch<dimensions>& a, const PointBatch<dimensions>& b, const Containers::ArrayView<bool> results) {
+    dispatch<AxisAlignedBoxPoint<dimensions>>("an axis-aligned box batch", a, b, results);
+}
+
+template<UnsignedInt dimensions> void collides(const CapsuleBatch<dimensions>& a, const PointBatch<dimensions>& b, const Containers::ArrayView<bool> results) {
+    dispatch<CapsulePoint<dimensions>>("a capsule batch", a, b, results);
+}
+
+template<UnsignedInt dimensions> void collides(const CapsuleBatch<dimensions>& a, const SphereBatch<dimensions>& b, const Containers::ArrayView<bool> results) {
+    dispatch<CapsuleSphere<dimensions>>("a capsule batch", a, b, results);
+}
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+template MAGNUM_SHAPES_EXPORT void collides<2>(const SphereBatch<2>&, const PointBatch<2>&, Containers::ArrayView<bool>);
+template MAGNUM_SHAPES_EXPORT void collides<3>(const SphereBatch<3>&, const PointBatch<3>&, Containers::ArrayView<bool>);
+template MAGNUM_SHAPES_EXPORT void collides<2>(const SphereBatch<2>&, const SphereBatch<2>&, Containers::ArrayView<bool>);
+template MAGNUM_SHAPES_EXPORT void collides<3>(const SphereBatch<3>&, const SphereBatch<3>&, Containers::ArrayView<bool>);
+template MAGNUM_SHAPES_EXPORT void collides<2>(const AxisAlignedBoxBatch<2>&, const PointBatch<2>&, Containers::ArrayView<bool>);
+template MAGNUM_SHAPES_EXPORT void collides<3>(const AxisAlignedBoxBatch<3>&, const PointBatch<3>&, Containers::ArrayView<bool>);
+template MAGNUM_SHAPES_EXPORT void collides<2>(const CapsuleBatch<2>&, const PointBatch<2>&, Containers::ArrayView<bool>);
+template MAGNUM_SHAPES_EXPORT void collides<3>(const CapsuleBatch<3>&, const PointBatch<3>&, Containers::ArrayView<bool>);
+template MAGNUM_SHAPES_EXPORT void collides<2>(const CapsuleBatch<2>&, const SphereBatch<2>&, Containers::ArrayView<bool>);
+template MAGNUM_SHAPES_EXPORT void collides<3>(const CapsuleBatch<3>&, const SphereBatch<3>&, Containers::ArrayView<bool>);
+#endif
+
+}}
@@ -0,0 +1,374 @@
+#ifndef Magnum_Shapes_BatchCollision_h
+#define Magnum_Shapes_BatchCollision_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Shapes::PointBatch, @ref Magnum::Shapes::SphereBatch, @ref Magnum::Shapes::AxisAlignedBoxBatch, @ref Magnum::Shapes::CapsuleBatch, function @ref Magnum::Shapes::collides()
+ */
+
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Shapes/AxisAlignedBox.h"
+#include "Magnum/Shapes/Capsule.h"
+#include "Magnum/Shapes/Point.h"
+#include "Magnum/Shapes/Sphere.h"
+
+namespace Magnum { namespace Shapes {
+
+namespace Implementation {
+    /* Each shape property component in its own contiguous array */
+    template<std::size_t components> class BatchStorage {
+        public:
+            std::size_t size() const { return _data[0].size(); }
+
+            void reserve(std::size_t size) {
+                for(std::vector<Float>& data: _data) data.reserve(size);
+            }
+
+            void clear() {
+                for(std::vector<Float>& data: _data) data.clear();
+            }
+
+            const Float* data(std::size_t component) const { return _data[component].data(); }
+            Float get(std::size_t component, std::size_t i) const { return _data[component][i]; }
+
+            void append(std::size_t component, Float value) {
+                _data[component].push_back(value);
+            }
+
+        private:
+            std::vector<Float> _data[components];
+    };
+}
+
+/**
+@brief Batch of points
+
+Stores the point coordinates as a structure of arrays, for use with batched
+@ref collides() functions.
+@see @ref PointBatch2D, @ref PointBatch3D
+*/
+template<UnsignedInt dimensions> class PointBatch {
+    public:
+        /** @brief Constructor */
+        explicit PointBatch() = default;
+
+        /** @brief Construct from array of points */
+        explicit PointBatch(Containers::ArrayView<const Point<dimensions>> points) {
+            _storage.reserve(points.size());
+            for(const Point<dimensions>& point: points) add(point);
+        }
+
+        /** @brief Count of points */
+        std::size_t size() const { return _storage.size(); }
+
+        /** @brief Reserve memory for given count of points */
+        void reserve(std::size_t size) { _storage.reserve(size); }
+
+        /** @brief Remove all points */
+        void clear() { _storage.clear(); }
+
+        /**
+         * @brief Add a point
+         * @return Reference to self (for method chaining)
+         */
+        PointBatch<dimensions>& add(const Point<dimensions>& point) {
+            for(UnsignedInt i = 0; i != dimensions; ++i)
+                _storage.append(i, point.position()[i]);
+            return *this;
+        }
+
+        /** @brief Point at given index */
+        Point<dimensions> operator[](std::size_t i) const {
+            VectorTypeFor<dimensions, Float> position;
+            for(UnsignedInt j = 0; j != dimensions; ++j)
+                position[j] = _storage.get(j, i);
+            return Point<dimensions>{position};
+        }
+
+        /** @brief Coordinates of all points on given axis */
+        const Float* positions(UnsignedInt axis) const { return _storage.data(axis); }
+
+    private:
+        Implementation::BatchStorage<dimensions> _storage;
+};
+
+/**
+@brief Batch of spheres
+
+Stores the sphere centers and radii as a structure of arrays, for use with
+batched @ref collides() functions.
+@see @ref SphereBatch2D, @ref SphereBatch3D
+*/
+template<UnsignedInt dimensions> class SphereBatch {
+    public:
+        /** @brief Constructor */
+        explicit SphereBatch() = default;
+
+        /** @brief Construct from array of spheres */
+        explicit SphereBatch(Containers::ArrayView<const Sphere<dimensions>> spheres) {
+            _storage.reserve(spheres.size());
+            for(const Sphere<dimensions>& sphere: spheres) add(sphere);
+        }
+
+        /** @brief Count of spheres */
+        std::size_t size() const { return _storage.size(); }
+
+        /** @brief Reserve memory for given count of spheres */
+        void reserve(std::size_t size) { _storage.reserve(size); }
+
+        /** @brief Remove all spheres */
+        void clear() { _storage.clear(); }
+
+        /**
+         * @brief Add a sphere
+         * @return Reference to self (for method chaining)
+         */
+        SphereBatch<dimensions>& add(const Sphere<dimensions>& sphere) {
+            for(UnsignedInt i = 0; i != dimensions; ++i)
+                _storage.append(i, sphere.position()[i]);
+            _storage.append(dimensions, sphere.radius());
+            return *this;
+        }
+
+        /** @brief Sphere at given index */
+        Sphere<dimensions> operator[](std::size_t i) const {
+            VectorTypeFor<dimensions, Float> position;
+            for(UnsignedInt j = 0; j != dimensions; ++j)
+                position[j] = _storage.get(j, i);
+            return Sphere<dimensions>{position, _storage.get(dimensions, i)};
+        }
+
+        /** @brief Center coordinates of all spheres on given axis */
+        const Float* positions(UnsignedInt axis) const { return _storage.data(axis); }
+
+        /** @brief Radii of all spheres */
+        const Float* radii() const { return _storage.data(dimensions); }
+
+    private:
+        Implementation::BatchStorage<dimensions + 1> _storage;
+};
+
+/**
+@brief Batch of axis-aligned boxes
+
+Stores the box corners as a structure of arrays, for use with batched
+@ref collides() functions.
+@see @ref AxisAlignedBoxBatch2D, @ref AxisAlignedBoxBatch3D
+*/
+template<UnsignedInt dimensions> class AxisAlignedBoxBatch {
+    public:
+        /** @brief Constructor */
+        explicit AxisAlignedBoxBatch() = default;
+
+        /** @brief Construct from array of axis-aligned boxes */
+        explicit AxisAlignedBoxBatch(Containers::ArrayView<const AxisAlignedBox<dimensions>> boxes) {
+            _storage.reserve(boxes.size());
+            for(const AxisAlignedBox<dimensions>& box: boxes) add(box);
+        }
+
+        /** @brief Count of boxes */
+        std::size_t size() const { return _storage.size(); }
+
+        /** @brief Reserve memory for given count of boxes */
+        void reserve(std::size_t size) { _storage.reserve(size); }
+
+        /** @brief Remove all boxes */
+        void clear() { _storage.clear(); }
+
+        /**
+         * @brief Add a box
+         * @return Reference to self (for method chaining)
+         */
+        AxisAlignedBoxBatch<dimensions>& add(const AxisAlignedBox<dimensions>& box) {
+            for(UnsignedInt i = 0; i != dimensions; ++i) {
+                _storage.append(i, box.min()[i]);
+                _storage.append(dimensions + i, box.max()[i]);
+            }
+            return *this;
+        }
+
+        /** @brief Box at given index */
+        AxisAlignedBox<dimensions> operator[](std::size_t i) const {
+            VectorTypeFor<dimensions, Float> min, max;
+            for(UnsignedInt j = 0; j != dimensions; ++j) {
+                min[j] = _storage.get(j, i);
+                max[j] = _storage.get(dimensions + j, i);
+            }
+            return AxisAlignedBox<dimensions>{min, max};
+        }
+
+        /** @brief Minimal coordinates of all boxes on given axis */
+        const Float* min(UnsignedInt axis) const { return _storage.data(axis); }
+
+        /** @brief Maximal coordinates of all boxes on given axis */
+        const Float* max(UnsignedInt axis) const { return _storage.data(dimensions + axis); }
+
+    private:
+        Implementation::BatchStorage<dimensions*2> _storage;
+};
+
+/**
+@brief Batch of capsules
+
+Stores the capsule end points and radii as a structure of arrays, for use with
+batched @ref collides() functions.
+@see @ref CapsuleBatch2D, @ref CapsuleBatch3D
+*/
+template<UnsignedInt dimensions> class CapsuleBatch {
+    public:
+        /** @brief Constructor */
+        explicit CapsuleBatch() = default;
+
+        /** @brief Construct from array of capsules */
+        explicit CapsuleBatch(Containers::ArrayView<const Capsule<dimensions>> capsules) {
+            _storage.reserve(capsules.size());
+            for(const Capsule<dimensions>& capsule: capsules) add(capsule);
+        }
+
+        /** @brief Count of capsules */
+        std::size_t size() const { return _storage.size(); }
+
+        /** @brief Reserve memory for given count of capsules */
+        void reserve(std::size_t size) { _storage.reserve(size); }
+
+        /** @brief Remove all capsules */
+        void clear() { _storage.clear(); }
+
+        /**
+         * @brief Add a capsule
+         * @return Reference to self (for method chaining)
+         */
+        CapsuleBatch<dimensions>& add(const Capsule<dimensions>& capsule) {
+            for(UnsignedInt i = 0; i != dimensions; ++i) {
+                _storage.append(i, capsule.a()[i]);
+                _storage.append(dimensions + i, capsule.b()[i]);
+            }
+            _storage.append(dimensions*2, capsule.radius());
+            return *this;
+        }
+
+        /** @brief Capsule at given index */
+        Capsule<dimensions> operator[](std::size_t i) const {
+            VectorTypeFor<dimensions, Float> a, b;
+            for(UnsignedInt j = 0; j != dimensions; ++j) {
+                a[j] = _storage.get(j, i);
+                b[j] = _storage.get(dimensions + j, i);
+            }
+            return Capsule<dimensions>{a, b, _storage.get(dimensions*2, i)};
+        }
+
+        /** @brief Start point coordinates of all capsules on given axis */
+        const Float* a(UnsignedInt axis) const { return _storage.data(axis); }
+
+        /** @brief End point coordinates of all capsules on given axis */
+        const Float* b(UnsignedInt axis) const { return _storage.data(dimensions + axis); }
+
+        /** @brief Radii of all capsules */
+        const Float* radii() const { return _storage.data(dimensions*2); }
+
+    private:
+        Implementation::BatchStorage<dimensions*2 + 1> _storage;
+};
+
+/** @brief Two-dimensional point batch */
+typedef PointBatch<2> PointBatch2D;
+
+/** @brief Three-dimensional point batch */
+typedef PointBatch<3> PointBatch3D;
+
+/** @brief Two-dimensional sphere batch */
+typedef SphereBatch<2> SphereBatch2D;
+
+/** @brief Three-dimensional sphere batch */
+typedef SphereBatch<3> SphereBatch3D;
+
+/** @brief Two-dimensional axis-aligned box batch */
+typedef AxisAlignedBoxBatch<2> AxisAlignedBoxBatch2D;
+
+/** @brief Three-dimensional axis-aligned box batch */
+typedef AxisAlignedBoxBatch<3> AxisAlignedBoxBatch3D;
+
+/** @brief Two-dimensional capsule batch */
+typedef CapsuleBatch<2> CapsuleBatch2D;
+
+/** @brief Three-dimensional capsule batch */
+typedef CapsuleBatch<3> CapsuleBatch3D;
+
+/**
+@brief Batched collision occurence of spheres with points
+@param a        Spheres
+@param b        Points
+@param results  Where to put the results
+
+Sets `results[i]` to `a[i] % b[i]`. If @p a has just one sphere,
+it is tested against all points in @p b. Expects that @p a has either one
+element or the same count as @p b and that @p results has the same size as
+@p b.
+
+Evaluates several pairs at once using AVX, SSE2 or NEON (on AArch64)
+instructions if the library is compiled for them, the results are the same
+as with @ref Sphere::operator%(const Point<dimensions>&) const.
+*/
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT void collides(const SphereBatch<dimensions>& a, const PointBatch<dimensions>& b, Containers::ArrayView<bool> results);
+
+/**
+@brief Batched collision occurence of spheres with spheres
+
+See @ref collides(const SphereBatch<dimensions>&, const PointBatch<dimensions>&, Containers::ArrayView<bool>)
+for more information.
+*/
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT void collides(const SphereBatch<dimensions>& a, const SphereBatch<dimensions>& b, Containers::ArrayView<bool> results);
+
+/**
+@brief Batched collision occurence of axis-aligned boxes with points
+
+See @ref collides(const SphereBatch<dimensions>&, const PointBatch<dimensions>&, Containers::ArrayView<bool>)
+for more information.
+*/
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT void collides(const AxisAlignedBoxBatch<dimensions>& a, const PointBatch<dimensions>& b, Containers::ArrayView<bool> results);
+
+/**
+@brief Batched collision occurence of capsules with points
+
+See @ref collides(const SphereBatch<dimensions>&, const PointBatch<dimensions>&, Containers::ArrayView<bool>)
+for more information.
+*/
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT void collides(const CapsuleBatch<dimensions>& a, const PointBatch<dimensions>& b, Containers::ArrayView<bool> results);
+
+/**
+@brief Batched collision occurence of capsules with spheres
+
+See @ref collides(const SphereBatch<dimensions>&, const PointBatch<dimensions>&, Containers::ArrayView<bool>)
+for more information.
+*/
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT void collides(const CapsuleBatch<dimensions>& a, const SphereBatch<dimensions>& b, Containers::ArrayView<bool> results);
+
+}}
+
+#endif
@@ -0,0 +1,263 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "CompiledComposition.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <Corrade/Utility/Assert.h>
+
+namespace Magnum { namespace Shapes {
+
+/*
+Compiled composition implementation notes:
+
+The node tree of the composition (see Composition.cpp for its layout) is
+first parsed into temporary expression tree, for each subexpression it is
+then computed how deep the stack needs to be to evaluate it. The postfix
+program is emitted so the deeper operand of AND/OR is evaluated first, which
+keeps the stack depth logarithmic in shape count (the Sethi-Ullman
+numbering). The stack itself is then a fixed-size local array.
+*/
+
+namespace {
+    /* Enough for 2^31 shapes in a balanced tree */
+    constexpr std::size_t StackSize = 32;
+
+    /* One bit per query */
+    constexpr std::size_t BatchSize = 64;
+
+    template<class T, class U> std::uint64_t shapeMask(const T& shape, const U* const queries, const std::size_t count) {
+        std::uint64_t mask = 0;
+        for(std::size_t i = 0; i != count; ++i)
+            mask |= std::uint64_t(shape % queries[i]) << i;
+        return mask;
+    }
+}
+
+template<UnsignedInt dimensions> struct CompiledComposition<dimensions>::Expression {
+    Instruction instruction;
+    std::size_t left, right, depth;
+};
+
+template<UnsignedInt dimensions> CompiledComposition<dimensions>::CompiledComposition(const Composition<dimensions>& composition): _size{composition.size()} {
+    std::vector<Expression> expressions;
+    const std::size_t root = parse(composition, expressions, 0, 0, composition.size());
+    _stackDepth = expressions[root].depth;
+    CORRADE_ASSERT(_stackDepth <= StackSize,
+        "Shapes::CompiledComposition: composition is too deep, expected at most" << StackSize << "stack entries but got" << _stackDepth, );
+
+    _program.reserve(expressions.size());
+    emit(expressions, root);
+}
+
+template<UnsignedInt dimensions> std::size_t CompiledComposition<dimensions>::size(const Type type) const {
+    switch(type) {
+        case Type::Point: return _points.size();
+        case Type::Line: return _lines.size();
+        case Type::LineSegment: return _lineSegments.size();
+        case Type::Sphere: return _spheres.size();
+        case Type::InvertedSphere: return _invertedSpheres.size();
+        case Type::Cylinder: return _cylinders.size();
+        case Type::Capsule: return _capsules.size();
+        case Type::AxisAlignedBox: return _axisAlignedBoxes.size();
+        default: return 0;
+    }
+}
+
+template<UnsignedInt dimensions> std::size_t CompiledComposition<dimensions>::parse(const Composition<dimensions>& composition, std::vector<Expression>& expressions, const std::size_t node, const std::size_t shapeBegin, const std::size_t shapeEnd) {
+    /* Empty composition */
+    if(shapeBegin == shapeEnd) {
+        expressions.push_back({{Operation::False, {}, 0}, 0, 0, 1});
+        return expressions.size() - 1;
+    }
+
+    const typename Composition<dimensions>::Node& n = composition._nodes[node];
+
+    /* Left operand, either a leaf shape or a subtree, see
+       Composition::collides() for details */
+    const std::size_t left = (n.rightNode == 0 || n.rightNode == 2) ?
+        addShape(composition, expressions, shapeBegin) :
+        parse(composition, expressions, node + 1, shapeBegin, shapeBegin + n.rightShape);
+
+    /* NOT doesn't need any additional stack entry */
+    if(n.operation == CompositionOperation::Not) {
+        expressions.push_back({{Operation::Not, {}, 0}, left, 0, expressions[left].depth});
+        return expressions.size() - 1;
+    }
+
+    const std::size_t right = (n.rightNode < 2) ?
+        addShape(composition, expressions, shapeBegin + n.rightShape) :
+        parse(composition, expressions, node + n.rightNode - 1, shapeBegin + n.rightShape, shapeEnd);
+
+    /* If both operands need the same depth, one more entry is needed to hold
+       result of the first one while evaluating the second */
+    const std::size_t leftDepth = expressions[left].depth;
+    const std::size_t rightDepth = expressions[right].depth;
+    const std::size_t depth = leftDepth == rightDepth ? leftDepth + 1 : std::max(leftDepth, rightDepth);
+    expressions.push_back({{n.operation == CompositionOperation::And ? Operation::And : Operation::Or, {}, 0}, left, right, depth});
+    return expressions.size() - 1;
+}
+
+template<UnsignedInt dimensions> std::size_t CompiledComposition<dimensions>::addShape(const Composition<dimensions>& composition, std::vector<Expression>& expressions, const std::size_t shape) {
+    const Type type = composition.type(shape);
+    UnsignedInt index = 0;
+    switch(type) {
+        #define _c(type_, class_, array) case Type::type_:                  \
+            index = array.size();                                           \
+            array.push_back(composition.template get<class_<dimensions>>(shape)); \
+            break;
+        _c(Point, Point, _points)
+        _c(Line, Line, _lines)
+        _c(LineSegment, LineSegment, _lineSegments)
+        _c(Sphere, Sphere, _spheres)
+        _c(InvertedSphere, InvertedSphere, _invertedSpheres)
+        _c(Cylinder, Cylinder, _cylinders)
+        _c(Capsule, Capsule, _capsules)
+        _c(AxisAlignedBox, AxisAlignedBox, _axisAlignedBoxes)
+        #undef _c
+
+        /* Boxes and planes don't collide with points or spheres */
+        default: break;
+    }
+
+    expressions.push_back({{Operation::Shape, type, index}, 0, 0, 1});
+    return expressions.size() - 1;
+}
+
+template<UnsignedInt dimensions> void CompiledComposition<dimensions>::emit(const std::vector<Expression>& expressions, const std::size_t expression) {
+    const Expression& e = expressions[expression];
+    switch(e.instruction.operation) {
+        case Operation::Shape:
+        case Operation::False:
+            break;
+
+        case Operation::Not:
+            emit(expressions, e.left);
+            break;
+
+        /* The operations are commutative, evaluate the deeper operand first */
+        case Operation::And:
+        case Operation::Or:
+            if(expressions[e.left].depth >= expressions[e.right].depth) {
+                emit(expressions, e.left);
+                emit(expressions, e.right);
+            } else {
+                emit(expressions, e.right);
+                emit(expressions, e.left);
+            }
+            break;
+    }
+
+    _program.push_back(e.instruction);
+}
+
+template<UnsignedInt dimensions> bool CompiledComposition<dimensions>::operator%(const Point<dimensions>& other) const {
+    bool result;
+    evaluate<Point<dimensions>>({&other, 1}, {&result, 1});
+    return result;
+}
+
+template<UnsignedInt dimensions> bool CompiledComposition<dimensions>::operator%(const Sphere<dimensions>& other) const {
+    bool result;
+    evaluate<Sphere<dimensions>>({&other, 1}, {&result, 1});
+    return result;
+}
+
+template<UnsignedInt dimensions> void CompiledComposition<dimensions>::collidesPoints(const Containers::ArrayView<const Point<dimensions>> points, const Containers::ArrayView<bool> results) const {
+    CORRADE_ASSERT(points.size() == results.size(),
+        "Shapes::CompiledComposition::collidesPoints(): expected" << points.size() << "results but got" << results.size(), );
+    evaluate(points, results);
+}
+
+template<UnsignedInt dimensions> void CompiledComposition<dimensions>::collidesSpheres(const Containers::ArrayView<const Sphere<dimensions>> spheres, const Containers::ArrayView<bool> results) const {
+    CORRADE_ASSERT(spheres.size() == results.size(),
+        "Shapes::CompiledComposition::collidesSpheres(): expected" << spheres.size() << "results but got" << results.size(), );
+    evaluate(spheres, results);
+}
+
+template<UnsignedInt dimensions> std::uint64_t CompiledComposition<dimensions>::mask(const Instruction& instruction, const Point<dimensions>* const points, const std::size_t count) const {
+    switch(instruction.type) {
+        case Type::Sphere: return shapeMask(_spheres[instruction.index], points, count);
+        case Type::InvertedSphere: return shapeMask(_invertedSpheres[instruction.index], points, count);
+        case Type::Cylinder: return shapeMask(_cylinders[instruction.index], points, count);
+        case Type::Capsule: return shapeMask(_capsules[instruction.index], points, count);
+        case Type::AxisAlignedBox: return shapeMask(_axisAlignedBoxes[instruction.index], points, count);
+        default: return 0;
+    }
+}
+
+template<UnsignedInt dimensions> std::uint64_t CompiledComposition<dimensions>::mask(const Instruction& instruction, const Sphere<dimensions>* const spheres, const std::size_t count) const {
+    switch(instruction.type) {
+        case Type::Point: return shapeMask(_points[instruction.index], spheres, count);
+        case Type::Line: return shapeMask(_lines[instruction.index], spheres, count);
+        case Type::LineSegment: return shapeMask(_lineSegments[instruction.index], spheres, count);
+        case Type::Sphere: return shapeMask(_spheres[instruction.index], spheres, count);
+        case Type::InvertedSphere: return shapeMask(_invertedSpheres[instruction.index], spheres, count);
+        case Type::Cylinder: return shapeMask(_cylinders[instruction.index], spheres, count);
+        case Type::Capsule: return shapeMask(_capsules[instruction.index], spheres, count);
+        default: return 0;
+    }
+}
+
+template<UnsignedInt dimensions> template<class T> void CompiledComposition<dimensions>::evaluate(const Containers::ArrayView<const T> queries, const Containers::ArrayView<bool> results) const {
+    std::uint64_t stack[StackSize];
+
+    for(std::size_t offset = 0; offset < queries.size(); offset += BatchSize) {
+        const std::size_t count = std::min(BatchSize, queries.size() - offset);
+
+        std::size_t top = 0;
+        for(const Instruction& instruction: _program) switch(instruction.operation) {
+            case Operation::Shape:
+                stack[top++] = mask(instruction, queries.data() + offset, count);
+                break;
+            case Operation::False:
+                stack[top++] = 0;
+                break;
+            case Operation::Not:
+                stack[top - 1] = ~stack[top - 1];
+                break;
+            case Operation::And:
+                --top;
+                stack[top - 1] &= stack[top];
+                break;
+            case Operation::Or:
+                --top;
+                stack[top - 1] |= stack[top];
+                break;
+        }
+
+        CORRADE_INTERNAL_ASSERT(top == 1);
+        for(std::size_t i = 0; i != count; ++i)
+            results[offset + i] = (stack[0] >> i) & 1;
+    }
+}
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+template class MAGNUM_SHAPES_EXPORT CompiledComposition<2>;
+template class MAGNUM_SHAPES_EXPORT CompiledComposition<3>;
+#endif
+
+}}
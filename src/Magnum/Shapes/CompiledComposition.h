@@ -0,0 +1,178 @@
+#ifndef Magnum_Shapes_CompiledComposition_h
+#define Magnum_Shapes_CompiledComposition_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Shapes::CompiledComposition, typedef @ref Magnum::Shapes::CompiledComposition2D, @ref Magnum::Shapes::CompiledComposition3D
+ */
+
+#include <cstdint>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Shapes/AxisAlignedBox.h"
+#include "Magnum/Shapes/Capsule.h"
+#include "Magnum/Shapes/Composition.h"
+#include "Magnum/Shapes/Cylinder.h"
+#include "Magnum/Shapes/LineSegment.h"
+#include "Magnum/Shapes/Point.h"
+#include "Magnum/Shapes/Sphere.h"
+
+namespace Magnum { namespace Shapes {
+
+/**
+@brief Compiled composition of shapes
+
+Flattened version of @ref Composition for fast repeated evaluation against
+points and spheres. The shapes are copied into arrays sorted by shape type and
+the operation tree is converted to a postfix program evaluated with an
+explicit stack, so there is no virtual dispatch, recursion or allocation
+during evaluation:
+@code
+Shapes::Composition3D composition = ...;
+Shapes::CompiledComposition3D compiled{composition};
+
+Containers::Array<Shapes::Point3D> particles = ...;
+Containers::Array<bool> inside{particles.size()};
+compiled.collidesPoints(particles, inside);
+@endcode
+
+The queries are processed in batches of 64, with results of each batch stored
+as bits of one integer. Each shape is then tested against the whole batch at
+once and the @ref CompositionOperation::And "AND",
+@ref CompositionOperation::Or "OR" and @ref CompositionOperation::Not "NOT"
+operations are just bitwise operations on the masks. Unlike with
+@ref Composition, there is no short-circuit evaluation, all shapes are always
+tested. Operands of AND and OR are reordered so the stack stays shallow.
+
+Only collisions with @ref Point and @ref Sphere are supported, pairs that
+have no collision implemented (such as a point with @ref Box) never collide,
+the same as in @ref Composition. The compiled composition is a snapshot, it
+is not updated when the original composition changes.
+*/
+template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT CompiledComposition {
+    public:
+        enum: UnsignedInt {
+            Dimensions = dimensions /**< Dimension count */
+        };
+
+        /** @brief Shape type */
+        typedef typename Composition<dimensions>::Type Type;
+
+        /** @brief Compile given composition */
+        explicit CompiledComposition(const Composition<dimensions>& composition);
+
+        /** @brief Count of shapes */
+        std::size_t size() const { return _size; }
+
+        /**
+         * @brief Count of shapes of given type
+         *
+         * Always returns `0` for types that don't have collision with
+         * @ref Point or @ref Sphere implemented.
+         */
+        std::size_t size(Type type) const;
+
+        /** @brief Stack depth needed for evaluation */
+        std::size_t stackDepth() const { return _stackDepth; }
+
+        /** @brief Collision with a point */
+        bool operator%(const Point<dimensions>& other) const;
+
+        /** @brief Collision with a sphere */
+        bool operator%(const Sphere<dimensions>& other) const;
+
+        /**
+         * @brief Collision with an array of points
+         * @param points    Points to test
+         * @param results   Where to put results
+         *
+         * Expects that @p results has the same size as @p points.
+         */
+        void collidesPoints(Containers::ArrayView<const Point<dimensions>> points, Containers::ArrayView<bool> results) const;
+
+        /**
+         * @brief Collision with an array of spheres
+         * @param spheres   Spheres to test
+         * @param results   Where to put results
+         *
+         * Expects that @p results has the same size as @p spheres.
+         */
+        void collidesSpheres(Containers::ArrayView<const Sphere<dimensions>> spheres, Containers::ArrayView<bool> results) const;
+
+    private:
+        enum class Operation: UnsignedByte {
+            Shape, False, Not, And, Or
+        };
+
+        struct Instruction {
+            Operation operation;
+            Type type;
+            UnsignedInt index;
+        };
+
+        struct Expression;
+
+        MAGNUM_SHAPES_LOCAL std::size_t parse(const Composition<dimensions>& composition, std::vector<Expression>& expressions, std::size_t node, std::size_t shapeBegin, std::size_t shapeEnd);
+        MAGNUM_SHAPES_LOCAL std::size_t addShape(const Composition<dimensions>& composition, std::vector<Expression>& expressions, std::size_t shape);
+        MAGNUM_SHAPES_LOCAL void emit(const std::vector<Expression>& expressions, std::size_t expression);
+
+        MAGNUM_SHAPES_LOCAL std::uint64_t mask(const Instruction& instruction, const Point<dimensions>* points, std::size_t count) const;
+        MAGNUM_SHAPES_LOCAL std::uint64_t mask(const Instruction& instruction, const Sphere<dimensions>* spheres, std::size_t count) const;
+        template<class T> MAGNUM_SHAPES_LOCAL void evaluate(Containers::ArrayView<const T> queries, Containers::ArrayView<bool> results) const;
+
+        std::size_t _size, _stackDepth;
+        std::vector<Instruction> _program;
+
+        std::vector<Point<dimensions>> _points;
+        std::vector<Line<dimensions>> _lines;
+        std::vector<LineSegment<dimensions>> _lineSegments;
+        std::vector<Sphere<dimensions>> _spheres;
+        std::vector<InvertedSphere<dimensions>> _invertedSpheres;
+        std::vector<Cylinder<dimensions>> _cylinders;
+        std::vector<Capsule<dimensions>> _capsules;
+        std::vector<AxisAlignedBox<dimensions>> _axisAlignedBoxes;
+};
+
+/** @brief Two-dimensional compiled shape composition */
+typedef CompiledComposition<2> CompiledComposition2D;
+
+/** @brief Three-dimensional compiled shape composition */
+typedef CompiledComposition<3> CompiledComposition3D;
+
+/** @relates CompiledComposition
+@brief Collision occurence of point with compiled composition
+*/
+template<UnsignedInt dimensions> inline bool operator%(const Point<dimensions>& a, const CompiledComposition<dimensions>& b) { return b % a; }
+
+/** @relates CompiledComposition
+@brief Collision occurence of sphere with compiled composition
+*/
+template<UnsignedInt dimensions> inline bool operator%(const Sphere<dimensions>& a, const CompiledComposition<dimensions>& b) { return b % a; }
+
+}}
+
+#endif
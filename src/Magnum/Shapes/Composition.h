@@ -43,6 +43,8 @@ namespace Magnum { namespace Shapes {
 
 namespace Implementation {
     template<class> struct ShapeHelper;
+    template<UnsignedInt> struct CompositionBounds;
+    template<UnsignedInt> struct CompositionRaycast;
 
     template<UnsignedInt dimensions> inline AbstractShape<dimensions>& getAbstractShape(Composition<dimensions>& group, std::size_t i) {
         return *group._shapes[i];
@@ -68,6 +70,9 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT Composition {
     friend Implementation::AbstractShape<dimensions>& Implementation::getAbstractShape<>(Composition<dimensions>&, std::size_t);
     friend const Implementation::AbstractShape<dimensions>& Implementation::getAbstractShape<>(const Composition<dimensions>&, std::size_t);
     friend Implementation::ShapeHelper<Composition<dimensions>>;
+    friend Implementation::CompositionBounds<dimensions>;
+    friend Implementation::CompositionRaycast<dimensions>;
+    friend CompiledComposition<dimensions>;
 
     public:
         enum: UnsignedInt {
@@ -0,0 +1,97 @@
+#ifndef Magnum_Shapes_Contact_h
+#define Magnum_Shapes_Contact_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Shapes::Contact, enum @ref Magnum::Shapes::ContactState, typedef @ref Magnum::Shapes::Contact2D, @ref Magnum::Shapes::Contact3D
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Shapes/Shapes.h"
+#include "Magnum/Shapes/visibility.h"
+
+namespace Magnum { namespace Shapes {
+
+/**
+@brief Contact state
+
+@see @ref Contact::state(), @ref ShapeGroup::updateContacts()
+*/
+enum class ContactState: UnsignedByte {
+    Begin,  /**< The shapes started colliding */
+    Stay,   /**< The shapes were colliding already before */
+    End     /**< The shapes stopped colliding */
+};
+
+/** @debugoperatorenum{Magnum::Shapes::ContactState} */
+MAGNUM_SHAPES_EXPORT Debug& operator<<(Debug& debug, ContactState value);
+
+/**
+@brief Contact of two shapes
+
+Pair of colliding shapes and state of the contact. Returned from
+@ref ShapeGroup::updateContacts().
+@see @ref Contact2D, @ref Contact3D
+*/
+template<UnsignedInt dimensions> class Contact {
+    public:
+        /** @brief Constructor */
+        constexpr explicit Contact(AbstractShape<dimensions>* a, AbstractShape<dimensions>* b, ContactState state): _a{a}, _b{b}, _state{state} {}
+
+        /**
+         * @brief First shape
+         *
+         * For @ref ContactState::End contacts the shape might be already
+         * removed from the group or destroyed, see
+         * @ref ShapeGroup::updateContacts() for more information.
+         */
+        AbstractShape<dimensions>* a() const { return _a; }
+
+        /**
+         * @brief Second shape
+         *
+         * See @ref a() for more information.
+         */
+        AbstractShape<dimensions>* b() const { return _b; }
+
+        /** @brief Contact state */
+        ContactState state() const { return _state; }
+
+    private:
+        AbstractShape<dimensions>* _a;
+        AbstractShape<dimensions>* _b;
+        ContactState _state;
+};
+
+/** @brief Two-dimensional contact */
+typedef Contact<2> Contact2D;
+
+/** @brief Three-dimensional contact */
+typedef Contact<3> Contact3D;
+
+}}
+
+#endif
@@ -0,0 +1,150 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Bounds.h"
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Shapes/AxisAlignedBox.h"
+#include "Magnum/Shapes/Box.h"
+#include "Magnum/Shapes/Capsule.h"
+#include "Magnum/Shapes/Composition.h"
+#include "Magnum/Shapes/LineSegment.h"
+#include "Magnum/Shapes/Point.h"
+#include "Magnum/Shapes/Sphere.h"
+#include "Magnum/Shapes/shapeImplementation.h"
+
+namespace Magnum { namespace Shapes { namespace Implementation {
+
+namespace {
+
+template<UnsignedInt dimensions> RangeTypeFor<dimensions, Float> boundsOf(const Shapes::Point<dimensions>& point) {
+    return {point.position(), point.position()};
+}
+
+template<UnsignedInt dimensions> RangeTypeFor<dimensions, Float> boundsOf(const Shapes::LineSegment<dimensions>& segment) {
+    return {Math::min(segment.a(), segment.b()), Math::max(segment.a(), segment.b())};
+}
+
+template<UnsignedInt dimensions> RangeTypeFor<dimensions, Float> boundsOf(const Shapes::Sphere<dimensions>& sphere) {
+    return {sphere.position() - VectorTypeFor<dimensions, Float>{sphere.radius()},
+            sphere.position() + VectorTypeFor<dimensions, Float>{sphere.radius()}};
+}
+
+template<UnsignedInt dimensions> RangeTypeFor<dimensions, Float> boundsOf(const Shapes::Capsule<dimensions>& capsule) {
+    return {Math::min(capsule.a(), capsule.b()) - VectorTypeFor<dimensions, Float>{capsule.radius()},
+            Math::max(capsule.a(), capsule.b()) + VectorTypeFor<dimensions, Float>{capsule.radius()}};
+}
+
+template<UnsignedInt dimensions> RangeTypeFor<dimensions, Float> boundsOf(const Shapes::AxisAlignedBox<dimensions>& box) {
+    return {Math::min(box.min(), box.max()), Math::max(box.min(), box.max())};
+}
+
+template<UnsignedInt dimensions> RangeTypeFor<dimensions, Float> boundsOf(const Shapes::Box<dimensions>& box) {
+    /* Unit box, the half extent on each axis is sum of absolute values of
+       the corresponding row of the rotation/scaling part */
+    const MatrixTypeFor<dimensions, Float> transformation = box.transformation();
+    VectorTypeFor<dimensions, Float> extent;
+    for(UnsignedInt row = 0; row != dimensions; ++row)
+        for(UnsignedInt col = 0; col != dimensions; ++col)
+            extent[row] += Math::abs(transformation[col][row]);
+
+    return {transformation.translation() - extent, transformation.translation() + extent};
+}
+
+}
+
+template<UnsignedInt dimensions> RangeTypeFor<dimensions, Float> CompositionBounds<dimensions>::bounds(const Composition<dimensions>& composition) {
+    /* Complement of a finite shape is infinite. With AND and OR the result
+       is always inside the union of all operands. */
+    if(composition._shapes.empty()) return infiniteBounds<dimensions>();
+    for(const auto& node: composition._nodes)
+        if(node.operation == CompositionOperation::Not)
+            return infiniteBounds<dimensions>();
+
+    /* Not using Math::join(), as it ignores zero-size ranges (points) */
+    RangeTypeFor<dimensions, Float> out = Implementation::bounds(*composition._shapes[0]);
+    for(std::size_t i = 1; i != composition._shapes.size(); ++i) {
+        const RangeTypeFor<dimensions, Float> shapeBounds = Implementation::bounds(*composition._shapes[i]);
+        out = {Math::min(out.min(), shapeBounds.min()),
+               Math::max(out.max(), shapeBounds.max())};
+    }
+    return out;
+}
+
+template<> Range2D bounds(const AbstractShape<2>& shape) {
+    switch(shape.type()) {
+        #define _c(type, class) \
+            case ShapeDimensionTraits<2>::Type::type: \
+                return boundsOf(static_cast<const Shape<class>&>(shape).shape);
+        _c(Point, Point2D)
+        _c(LineSegment, LineSegment2D)
+        _c(Sphere, Sphere2D)
+        _c(Capsule, Capsule2D)
+        _c(AxisAlignedBox, AxisAlignedBox2D)
+        _c(Box, Box2D)
+        #undef _c
+
+        case ShapeDimensionTraits<2>::Type::Composition:
+            return CompositionBounds<2>::bounds(static_cast<const Shape<Composition2D>&>(shape).shape);
+
+        case ShapeDimensionTraits<2>::Type::Line:
+        case ShapeDimensionTraits<2>::Type::InvertedSphere:
+        case ShapeDimensionTraits<2>::Type::Cylinder:
+            break;
+    }
+
+    return infiniteBounds<2>();
+}
+
+template<> Range3D bounds(const AbstractShape<3>& shape) {
+    switch(shape.type()) {
+        #define _c(type, class) \
+            case ShapeDimensionTraits<3>::Type::type: \
+                return boundsOf(static_cast<const Shape<class>&>(shape).shape);
+        _c(Point, Point3D)
+        _c(LineSegment, LineSegment3D)
+        _c(Sphere, Sphere3D)
+        _c(Capsule, Capsule3D)
+        _c(AxisAlignedBox, AxisAlignedBox3D)
+        _c(Box, Box3D)
+        #undef _c
+
+        case ShapeDimensionTraits<3>::Type::Composition:
+            return CompositionBounds<3>::bounds(static_cast<const Shape<Composition3D>&>(shape).shape);
+
+        case ShapeDimensionTraits<3>::Type::Line:
+        case ShapeDimensionTraits<3>::Type::InvertedSphere:
+        case ShapeDimensionTraits<3>::Type::Cylinder:
+        case ShapeDimensionTraits<3>::Type::Plane:
+            break;
+    }
+
+    return infiniteBounds<3>();
+}
+
+template struct CompositionBounds<2>;
+template struct CompositionBounds<3>;
+
+}}}
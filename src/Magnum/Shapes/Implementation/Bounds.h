@@ -0,0 +1,71 @@
+#ifndef Magnum_Shapes_Implementation_Bounds_h
+#define Magnum_Shapes_Implementation_Bounds_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Shapes/Shapes.h"
+
+namespace Magnum { namespace Shapes { namespace Implementation {
+
+template<UnsignedInt> struct AbstractShape;
+
+/*
+Axis-aligned bounds of transformed shapes, used by the ShapeGroup broad phase:
+
+The bounds are conservative, i.e. if two shapes collide, their bounds always
+intersect. Shapes extending to infinity (lines, planes, infinite cylinders,
+inverted spheres and compositions with NOT operation) have infinite bounds.
+Dispatched on shape type similarly to collides().
+*/
+
+template<UnsignedInt dimensions> RangeTypeFor<dimensions, Float> bounds(const AbstractShape<dimensions>& shape);
+
+template<UnsignedInt dimensions> struct CompositionBounds {
+    static RangeTypeFor<dimensions, Float> bounds(const Composition<dimensions>& composition);
+};
+
+template<UnsignedInt dimensions> inline RangeTypeFor<dimensions, Float> infiniteBounds() {
+    return {VectorTypeFor<dimensions, Float>{-Constants::inf()},
+            VectorTypeFor<dimensions, Float>{Constants::inf()}};
+}
+
+template<UnsignedInt dimensions> inline bool isInfinite(const RangeTypeFor<dimensions, Float>& bounds) {
+    for(UnsignedInt i = 0; i != dimensions; ++i)
+        if(bounds.min()[i] == -Constants::inf() || bounds.max()[i] == Constants::inf())
+            return true;
+    return false;
+}
+
+template<UnsignedInt dimensions> inline bool intersects(const RangeTypeFor<dimensions, Float>& a, const RangeTypeFor<dimensions, Float>& b) {
+    return (a.min() <= b.max()).all() && (b.min() <= a.max()).all();
+}
+
+}}}
+
+#endif
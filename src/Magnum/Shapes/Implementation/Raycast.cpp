@@ -0,0 +1,240 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Raycast.h"
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Geometry/Intersection.h"
+#include "Magnum/Shapes/AxisAlignedBox.h"
+#include "Magnum/Shapes/Box.h"
+#include "Magnum/Shapes/Capsule.h"
+#include "Magnum/Shapes/Composition.h"
+#include "Magnum/Shapes/Cylinder.h"
+#include "Magnum/Shapes/LineSegment.h"
+#include "Magnum/Shapes/Plane.h"
+#include "Magnum/Shapes/Sphere.h"
+#include "Magnum/Shapes/shapeImplementation.h"
+
+namespace Magnum { namespace Shapes { namespace Implementation {
+
+namespace {
+
+template<UnsignedInt dimensions> bool intervalOf(const Shapes::Sphere<dimensions>& sphere, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, Interval& out) {
+    return sphereInterval<dimensions>(sphere.position(), sphere.radius(), origin, direction, out);
+}
+
+template<UnsignedInt dimensions> bool intervalOf(const Shapes::Cylinder<dimensions>& cylinder, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, Interval& out) {
+    return cylinderInterval<dimensions>(cylinder.a(), (cylinder.b() - cylinder.a()).normalized(), cylinder.radius(), origin, direction, out);
+}
+
+template<UnsignedInt dimensions> bool intervalOf(const Shapes::Capsule<dimensions>& capsule, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, Interval& out) {
+    return capsuleInterval<dimensions>(capsule.a(), capsule.b(), capsule.radius(), origin, direction, out);
+}
+
+template<UnsignedInt dimensions> bool intervalOf(const Shapes::AxisAlignedBox<dimensions>& box, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, Interval& out) {
+    return boxInterval<dimensions>(Math::min(box.min(), box.max()), Math::max(box.min(), box.max()), origin, direction, out);
+}
+
+template<UnsignedInt dimensions> bool intervalOf(const Shapes::Box<dimensions>& box, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, Interval& out) {
+    /* Transform the ray into the space of the unit box, the parameter `t`
+       stays the same */
+    const MatrixTypeFor<dimensions, Float> transformation = box.transformation();
+    if(transformation.rotationScaling().determinant() == 0.0f) return false;
+
+    const MatrixTypeFor<dimensions, Float> inverted = transformation.inverted();
+    return boxInterval<dimensions>(VectorTypeFor<dimensions, Float>{-1.0f}, VectorTypeFor<dimensions, Float>{1.0f}, inverted.transformPoint(origin), inverted.transformVector(direction), out);
+}
+
+bool intervalOf(const Shapes::Line2D& line, const Vector2& origin, const Vector2& direction, Interval& out) {
+    return crossingInterval(Math::Geometry::Intersection::lineSegmentLine(origin, direction, line.a(), line.b() - line.a()), out);
+}
+
+bool intervalOf(const Shapes::LineSegment2D& segment, const Vector2& origin, const Vector2& direction, Interval& out) {
+    const std::pair<Float, Float> t = Math::Geometry::Intersection::lineSegmentLineSegment(origin, direction, segment.a(), segment.b() - segment.a());
+    return t.second >= 0.0f && t.second <= 1.0f && crossingInterval(t.first, out);
+}
+
+bool intervalOf(const Shapes::Plane& plane, const Vector3& origin, const Vector3& direction, Interval& out) {
+    return crossingInterval(Math::Geometry::Intersection::planeLine(plane.position(), plane.normal(), origin, direction), out);
+}
+
+void complement(const RayIntervals& a, RayIntervals& out) {
+    out.clear();
+    Float begin = -Constants::inf();
+    for(const Interval& i: a) {
+        if(i.first > begin) out.emplace_back(begin, i.first);
+        begin = i.second;
+    }
+    if(begin < Constants::inf()) out.emplace_back(begin, Constants::inf());
+}
+
+void intersect(const RayIntervals& a, const RayIntervals& b, RayIntervals& out) {
+    out.clear();
+    for(std::size_t i = 0, j = 0; i != a.size() && j != b.size(); ) {
+        const Float begin = Math::max(a[i].first, b[j].first);
+        const Float end = Math::min(a[i].second, b[j].second);
+        if(begin <= end) out.emplace_back(begin, end);
+        if(a[i].second < b[j].second) ++i;
+        else ++j;
+    }
+}
+
+void unite(const RayIntervals& a, const RayIntervals& b, RayIntervals& out) {
+    out.clear();
+    for(std::size_t i = 0, j = 0; i != a.size() || j != b.size(); ) {
+        const Interval& next = (j == b.size() || (i != a.size() && a[i].first < b[j].first)) ? a[i++] : b[j++];
+        if(!out.empty() && next.first <= out.back().second)
+            out.back().second = Math::max(out.back().second, next.second);
+        else out.push_back(next);
+    }
+}
+
+}
+
+template<UnsignedInt dimensions> void CompositionRaycast<dimensions>::rayIntervals(const Composition<dimensions>& composition, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, RayIntervals& out) {
+    rayIntervals(composition, 0, 0, composition._shapes.size(), origin, direction, out);
+}
+
+template<UnsignedInt dimensions> void CompositionRaycast<dimensions>::rayIntervals(const Composition<dimensions>& composition, const std::size_t node, const std::size_t shapeBegin, const std::size_t shapeEnd, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, RayIntervals& out) {
+    /* Empty group doesn't collide with anything */
+    out.clear();
+    if(shapeBegin == shapeEnd) return;
+
+    CORRADE_INTERNAL_ASSERT(node < composition._nodes.size() && shapeBegin < shapeEnd);
+    const auto& n = composition._nodes[node];
+
+    /* Left child, traversed the same way as in Composition::collides() */
+    RayIntervals left;
+    if(n.rightNode == 0 || n.rightNode == 2)
+        Implementation::rayIntervals(*composition._shapes[shapeBegin], origin, direction, left);
+    else rayIntervals(composition, node+1, shapeBegin, shapeBegin+n.rightShape, origin, direction, left);
+
+    if(n.operation == CompositionOperation::Not) {
+        complement(left, out);
+        return;
+    }
+
+    /* Short-circuit for AND/OR similarly to Composition::collides() */
+    if(n.operation == CompositionOperation::And && left.empty()) return;
+
+    RayIntervals right;
+    if(n.rightNode < 2)
+        Implementation::rayIntervals(*composition._shapes[shapeBegin+n.rightShape], origin, direction, right);
+    else rayIntervals(composition, node+n.rightNode-1, shapeBegin+n.rightShape, shapeEnd, origin, direction, right);
+
+    if(n.operation == CompositionOperation::And)
+        intersect(left, right, out);
+    else unite(left, right, out);
+}
+
+template<> void rayIntervals(const AbstractShape<2>& shape, const Vector2& origin, const Vector2& direction, RayIntervals& out) {
+    out.clear();
+    Interval interval;
+    switch(shape.type()) {
+        #define _c(type, class) \
+            case ShapeDimensionTraits<2>::Type::type: \
+                if(intervalOf(static_cast<const Shape<class>&>(shape).shape, origin, direction, interval)) \
+                    out.push_back(interval); \
+                return;
+        _c(Line, Line2D)
+        _c(LineSegment, LineSegment2D)
+        _c(Sphere, Sphere2D)
+        _c(Cylinder, Cylinder2D)
+        _c(Capsule, Capsule2D)
+        _c(AxisAlignedBox, AxisAlignedBox2D)
+        _c(Box, Box2D)
+        #undef _c
+
+        case ShapeDimensionTraits<2>::Type::InvertedSphere: {
+            const Shapes::InvertedSphere2D& sphere = static_cast<const Shape<InvertedSphere2D>&>(shape).shape;
+            RayIntervals inside;
+            if(sphereInterval<2>(sphere.position(), sphere.radius(), origin, direction, interval))
+                inside.push_back(interval);
+            complement(inside, out);
+            return;
+        }
+
+        case ShapeDimensionTraits<2>::Type::Composition:
+            CompositionRaycast<2>::rayIntervals(static_cast<const Shape<Composition2D>&>(shape).shape, origin, direction, out);
+            return;
+
+        case ShapeDimensionTraits<2>::Type::Point:
+            return;
+    }
+}
+
+template<> void rayIntervals(const AbstractShape<3>& shape, const Vector3& origin, const Vector3& direction, RayIntervals& out) {
+    out.clear();
+    Interval interval;
+    switch(shape.type()) {
+        #define _c(type, class) \
+            case ShapeDimensionTraits<3>::Type::type: \
+                if(intervalOf(static_cast<const Shape<class>&>(shape).shape, origin, direction, interval)) \
+                    out.push_back(interval); \
+                return;
+        _c(Sphere, Sphere3D)
+        _c(Cylinder, Cylinder3D)
+        _c(Capsule, Capsule3D)
+        _c(AxisAlignedBox, AxisAlignedBox3D)
+        _c(Box, Box3D)
+        _c(Plane, Plane)
+        #undef _c
+
+        case ShapeDimensionTraits<3>::Type::InvertedSphere: {
+            const Shapes::InvertedSphere3D& sphere = static_cast<const Shape<InvertedSphere3D>&>(shape).shape;
+            RayIntervals inside;
+            if(sphereInterval<3>(sphere.position(), sphere.radius(), origin, direction, interval))
+                inside.push_back(interval);
+            complement(inside, out);
+            return;
+        }
+
+        case ShapeDimensionTraits<3>::Type::Composition:
+            CompositionRaycast<3>::rayIntervals(static_cast<const Shape<Composition3D>&>(shape).shape, origin, direction, out);
+            return;
+
+        case ShapeDimensionTraits<3>::Type::Point:
+        case ShapeDimensionTraits<3>::Type::Line:
+        case ShapeDimensionTraits<3>::Type::LineSegment:
+            return;
+    }
+}
+
+template<UnsignedInt dimensions> Float raycast(const AbstractShape<dimensions>& shape, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, RayIntervals& scratch) {
+    rayIntervals(shape, origin, direction, scratch);
+    for(const Interval& interval: scratch)
+        if(interval.second >= 0.0f) return Math::max(interval.first, 0.0f);
+
+    return Constants::inf();
+}
+
+template struct CompositionRaycast<2>;
+template struct CompositionRaycast<3>;
+template Float raycast(const AbstractShape<2>&, const Vector2&, const Vector2&, RayIntervals&);
+template Float raycast(const AbstractShape<3>&, const Vector3&, const Vector3&, RayIntervals&);
+
+}}}
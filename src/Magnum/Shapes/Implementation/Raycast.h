@@ -0,0 +1,218 @@
+#ifndef Magnum_Shapes_Implementation_Raycast_h
+#define Magnum_Shapes_Implementation_Raycast_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <utility>
+#include <vector>
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Shapes/Shapes.h"
+
+namespace Magnum { namespace Shapes { namespace Implementation {
+
+template<UnsignedInt> struct AbstractShape;
+
+/*
+Ray casting against transformed shapes, used by ShapeGroup::raycast():
+
+For ray `origin + t*direction` the shape is converted to a sorted list of
+disjoint ranges of `t` in which the ray is inside the shape. Compositions are
+then simple -- AND is intersection of the ranges, OR their union and NOT the
+complement. Solid shapes give ranges of non-zero length, 2D lines and line
+segments and 3D planes give zero-length ranges at the crossing point. Points
+and 3D lines and line segments can't be hit. Dispatched on shape type
+similarly to bounds().
+
+Swept shapes are a ray cast as well, the helpers below are shared with the
+sweep() functions.
+*/
+
+/* Helpers for shapes giving a single interval, return false if the ray misses
+   the shape */
+
+typedef std::pair<Float, Float> Interval;
+
+/* Range of `t` in which a*t^2 + 2*b*t + c < 0, with `a` non-negative */
+inline bool quadraticInterval(const Float a, const Float b, const Float c, Interval& out) {
+    /* Ray doesn't move in the relevant subspace, either always inside or
+       never */
+    if(a == 0.0f) {
+        if(c >= 0.0f) return false;
+        out = {-Constants::inf(), Constants::inf()};
+        return true;
+    }
+
+    const Float discriminant = b*b - a*c;
+    if(discriminant < 0.0f) return false;
+
+    const Float root = Math::sqrt(discriminant);
+    out = {(-b - root)/a, (-b + root)/a};
+    return true;
+}
+
+/* Range of `t` in which origin + t*direction projected on given axis is in
+   [min, max] */
+inline bool slabInterval(const Float origin, const Float direction, const Float min, const Float max, Interval& out) {
+    if(direction == 0.0f) {
+        if(origin < min || origin > max) return false;
+        out = {-Constants::inf(), Constants::inf()};
+        return true;
+    }
+
+    const Float t0 = (min - origin)/direction;
+    const Float t1 = (max - origin)/direction;
+    out = {Math::min(t0, t1), Math::max(t0, t1)};
+    return true;
+}
+
+inline bool intersectInterval(Interval& a, const Interval& b) {
+    a = {Math::max(a.first, b.first), Math::min(a.second, b.second)};
+    return a.first <= a.second;
+}
+
+template<UnsignedInt dimensions> bool sphereInterval(const VectorTypeFor<dimensions, Float>& position, const Float radius, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, Interval& out) {
+    const VectorTypeFor<dimensions, Float> o = origin - position;
+    return quadraticInterval(direction.dot(), Math::dot(direction, o), o.dot() - radius*radius, out);
+}
+
+/* Infinite cylinder, components along the axis don't matter */
+template<UnsignedInt dimensions> bool cylinderInterval(const VectorTypeFor<dimensions, Float>& a, const VectorTypeFor<dimensions, Float>& axis, const Float radius, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, Interval& out) {
+    const VectorTypeFor<dimensions, Float> o = origin - a;
+    const VectorTypeFor<dimensions, Float> oPerpendicular = o - Math::dot(o, axis)*axis;
+    const VectorTypeFor<dimensions, Float> directionPerpendicular = direction - Math::dot(direction, axis)*axis;
+    return quadraticInterval(directionPerpendicular.dot(), Math::dot(directionPerpendicular, oPerpendicular), oPerpendicular.dot() - radius*radius, out);
+}
+
+template<UnsignedInt dimensions> bool boxInterval(const VectorTypeFor<dimensions, Float>& min, const VectorTypeFor<dimensions, Float>& max, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, Interval& out) {
+    out = {-Constants::inf(), Constants::inf()};
+    for(UnsignedInt i = 0; i != dimensions; ++i) {
+        Interval slab;
+        if(!slabInterval(origin[i], direction[i], min[i], max[i], slab) || !intersectInterval(out, slab))
+            return false;
+    }
+
+    return true;
+}
+
+/* The capsule is convex, so the result is the hull of intervals of the two
+   end spheres and the cylinder clipped to the segment */
+template<UnsignedInt dimensions> bool capsuleInterval(const VectorTypeFor<dimensions, Float>& a, const VectorTypeFor<dimensions, Float>& b, const Float radius, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, Interval& out) {
+    bool hit = false;
+    out = {Constants::inf(), -Constants::inf()};
+    auto join = [&hit, &out](const Interval& part) {
+        hit = true;
+        out = {Math::min(out.first, part.first), Math::max(out.second, part.second)};
+    };
+
+    Interval part;
+    if(sphereInterval<dimensions>(a, radius, origin, direction, part)) join(part);
+    if(sphereInterval<dimensions>(b, radius, origin, direction, part)) join(part);
+
+    const VectorTypeFor<dimensions, Float> segment = b - a;
+    const Float length = segment.length();
+    if(length != 0.0f) {
+        const VectorTypeFor<dimensions, Float> axis = segment/length;
+        Interval slab;
+        if(cylinderInterval<dimensions>(a, axis, radius, origin, direction, part) &&
+           slabInterval(Math::dot(origin - a, axis), Math::dot(direction, axis), 0.0f, length, slab) &&
+           intersectInterval(part, slab))
+            join(part);
+    }
+
+    return hit;
+}
+
+/* Parallelepiped (parallelogram in 2D) given by a corner and edge vectors in
+   matrix columns, degenerate ones are never hit */
+template<UnsignedInt dimensions> bool parallelepipedInterval(const VectorTypeFor<dimensions, Float>& corner, const Math::Matrix<dimensions, Float>& edges, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, Interval& out) {
+    if(edges.determinant() == 0.0f) return false;
+
+    /* In coordinates relative to the edges it's a unit box */
+    const Math::Matrix<dimensions, Float> inverted = edges.inverted();
+    return boxInterval<dimensions>(VectorTypeFor<dimensions, Float>{0.0f}, VectorTypeFor<dimensions, Float>{1.0f}, VectorTypeFor<dimensions, Float>{inverted*(origin - corner)}, VectorTypeFor<dimensions, Float>{inverted*direction}, out);
+}
+
+/* Zero-length interval at a crossing with a plane or a 2D line, NaN and
+   infinity (ray lying in it or parallel with it) are treated as no hit */
+inline bool crossingInterval(const Float t, Interval& out) {
+    if(!(t > -Constants::inf() && t < Constants::inf())) return false;
+    out = {t, t};
+    return true;
+}
+
+typedef std::vector<Interval> RayIntervals;
+
+template<UnsignedInt dimensions> void rayIntervals(const AbstractShape<dimensions>& shape, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, RayIntervals& out);
+
+template<UnsignedInt dimensions> struct CompositionRaycast {
+    static void rayIntervals(const Composition<dimensions>& composition, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, RayIntervals& out);
+
+    private:
+        static void rayIntervals(const Composition<dimensions>& composition, std::size_t node, std::size_t shapeBegin, std::size_t shapeEnd, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, RayIntervals& out);
+};
+
+/* Smallest non-negative `t` inside the shape, infinity if the ray misses it.
+   The scratch array is reused between calls to avoid allocations. */
+template<UnsignedInt dimensions> Float raycast(const AbstractShape<dimensions>& shape, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, RayIntervals& scratch);
+
+/* Time of impact of moving sphere or capsule with given shape, infinity if
+   the shapes don't touch or the pair isn't supported. Implemented in
+   Sweep.cpp. */
+template<UnsignedInt dimensions> Float sweep(const Shapes::Sphere<dimensions>& sphere, const VectorTypeFor<dimensions, Float>& displacement, const AbstractShape<dimensions>& other);
+template<UnsignedInt dimensions> Float sweep(const Shapes::Capsule<dimensions>& capsule, const VectorTypeFor<dimensions, Float>& displacement, const AbstractShape<dimensions>& other);
+
+/* Smallest `t` in range [0, maxDistance] inside the bounds (slab test),
+   infinity if the ray misses them in that range */
+template<UnsignedInt dimensions> Float raycast(const RangeTypeFor<dimensions, Float>& bounds, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, const Float maxDistance) {
+    Float near = 0.0f;
+    Float far = maxDistance;
+    for(UnsignedInt i = 0; i != dimensions; ++i) {
+        /* Parallel with the slab, either always inside or never */
+        if(direction[i] == 0.0f) {
+            if(origin[i] < bounds.min()[i] || origin[i] > bounds.max()[i])
+                return Constants::inf();
+            continue;
+        }
+
+        Float t0 = (bounds.min()[i] - origin[i])/direction[i];
+        Float t1 = (bounds.max()[i] - origin[i])/direction[i];
+        if(t0 > t1) std::swap(t0, t1);
+        if(t0 > near) near = t0;
+        if(t1 < far) far = t1;
+        if(near > far) return Constants::inf();
+    }
+
+    return near;
+}
+
+}}}
+
+#endif
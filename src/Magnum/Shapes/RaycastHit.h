@@ -0,0 +1,94 @@
+#ifndef Magnum_Shapes_RaycastHit_h
+#define Magnum_Shapes_RaycastHit_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Shapes::RaycastHit, typedef @ref Magnum::Shapes::RaycastHit2D, @ref Magnum::Shapes::RaycastHit3D
+ */
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Shapes/Shapes.h"
+
+namespace Magnum { namespace Shapes {
+
+/**
+@brief Ray cast hit
+
+Shape hit by a ray, position of the hit and its distance along the ray.
+Returned from @ref ShapeGroup::raycast() and @ref ShapeGroup::raycastAll().
+The distance is in multiples of the ray direction length, thus it is the
+actual distance only if the direction is normalized. If the ray starts inside
+the shape, the distance is zero and position is equal to the ray origin.
+For @ref ShapeGroup::sweep() the distance is time of impact in range
+@f$ [ 0 ; 1 ] @f$ instead.
+@see @ref RaycastHit2D, @ref RaycastHit3D
+*/
+template<UnsignedInt dimensions> class RaycastHit {
+    public:
+        /**
+         * @brief Default constructor
+         *
+         * Sets shape to `nullptr` and distance to infinity, as if nothing
+         * was hit.
+         */
+        constexpr /*implicit*/ RaycastHit(): _shape{}, _distance{Constants::inf()} {}
+
+        /** @brief Constructor */
+        constexpr explicit RaycastHit(AbstractShape<dimensions>* shape, const VectorTypeFor<dimensions, Float>& position, Float distance): _shape{shape}, _position{position}, _distance{distance} {}
+
+        /**
+         * @brief Whether anything was hit
+         *
+         * @see @ref shape()
+         */
+        explicit operator bool() const { return _shape; }
+
+        /** @brief Hit shape or `nullptr` if nothing was hit */
+        AbstractShape<dimensions>* shape() const { return _shape; }
+
+        /** @brief Hit position */
+        VectorTypeFor<dimensions, Float> position() const { return _position; }
+
+        /** @brief Hit distance along the ray */
+        Float distance() const { return _distance; }
+
+    private:
+        AbstractShape<dimensions>* _shape;
+        VectorTypeFor<dimensions, Float> _position;
+        Float _distance;
+};
+
+/** @brief Two-dimensional ray cast hit */
+typedef RaycastHit<2> RaycastHit2D;
+
+/** @brief Three-dimensional ray cast hit */
+typedef RaycastHit<3> RaycastHit3D;
+
+}}
+
+#endif
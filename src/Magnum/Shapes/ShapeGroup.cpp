@@ -25,10 +25,90 @@
 
 #include "ShapeGroup.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <Corrade/Utility/Assert.h>
+
 #include "Magnum/Shapes/AbstractShape.h"
+#include "Magnum/Shapes/Capsule.h"
+#include "Magnum/Shapes/Sphere.h"
+#include "Magnum/Shapes/Implementation/Bounds.h"
+#include "Magnum/Shapes/Implementation/Raycast.h"
 
 namespace Magnum { namespace Shapes {
 
+namespace {
+
+/* Bounds of ray segment in range [0, maxDistance], components along which
+   the ray doesn't move stay finite */
+template<UnsignedInt dimensions> RangeTypeFor<dimensions, Float> rayBounds(const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, const Float maxDistance) {
+    VectorTypeFor<dimensions, Float> end;
+    for(UnsignedInt i = 0; i != dimensions; ++i)
+        end[i] = direction[i] == 0.0f ? origin[i] : origin[i] + direction[i]*maxDistance;
+    return {Math::min(origin, end), Math::max(origin, end)};
+}
+
+/* Candidates sorted by distance at which the ray enters their bounds, shared
+   by all raycast and sweep variants. For sweeps the bounds are expanded by
+   bounds of the moving shape relative to the ray origin. */
+template<UnsignedInt dimensions> void sortedByEntry(const std::vector<RangeTypeFor<dimensions, Float>>& bounds, const std::vector<UnsignedInt>& candidates, const RangeTypeFor<dimensions, Float>& padding, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, const Float maxDistance, std::vector<std::pair<Float, UnsignedInt>>& out) {
+    out.clear();
+    for(UnsignedInt i: candidates) {
+        const Float entry = Implementation::raycast<dimensions>({bounds[i].min() - padding.max(), bounds[i].max() - padding.min()}, origin, direction, maxDistance);
+        if(entry != Constants::inf()) out.emplace_back(entry, i);
+    }
+    std::sort(out.begin(), out.end());
+}
+
+/* The exact test returns infinity if the shape isn't hit */
+template<UnsignedInt dimensions, class Exact> RaycastHit<dimensions> nearestHit(ShapeGroup<dimensions>& group, const std::vector<RangeTypeFor<dimensions, Float>>& bounds, const std::vector<UnsignedInt>& candidates, const RangeTypeFor<dimensions, Float>& padding, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, const Float maxDistance, std::vector<std::pair<Float, UnsignedInt>>& entries, Exact exact) {
+    sortedByEntry<dimensions>(bounds, candidates, padding, origin, direction, maxDistance, entries);
+
+    Float nearest = maxDistance;
+    UnsignedInt nearestIndex = ~UnsignedInt{};
+    for(const auto& entry: entries) {
+        /* The remaining shapes can't be hit sooner */
+        if(entry.first > nearest) break;
+
+        const Float distance = exact(group[entry.second]);
+        if(distance == Constants::inf()) continue;
+        if(distance < nearest || (distance == nearest && entry.second < nearestIndex)) {
+            nearest = distance;
+            nearestIndex = entry.second;
+        }
+    }
+
+    if(nearestIndex == ~UnsignedInt{}) return {};
+    return RaycastHit<dimensions>{&group[nearestIndex], origin + direction*nearest, nearest};
+}
+
+template<UnsignedInt dimensions> RaycastHit<dimensions> nearestHit(ShapeGroup<dimensions>& group, const std::vector<RangeTypeFor<dimensions, Float>>& bounds, const std::vector<UnsignedInt>& candidates, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, const Float maxDistance, std::vector<std::pair<Float, UnsignedInt>>& entries, Implementation::RayIntervals& scratch) {
+    return nearestHit(group, bounds, candidates, {}, origin, direction, maxDistance, entries, [&](const AbstractShape<dimensions>& shape) {
+        return Implementation::raycast(Implementation::getAbstractShape(shape), origin, direction, scratch);
+    });
+}
+
+template<UnsignedInt dimensions, class T> RaycastHit<dimensions> sweepHit(ShapeGroup<dimensions>& group, const std::vector<RangeTypeFor<dimensions, Float>>& bounds, const std::vector<UnsignedInt>& candidates, const RangeTypeFor<dimensions, Float>& padding, const VectorTypeFor<dimensions, Float>& origin, const T& shape, const VectorTypeFor<dimensions, Float>& displacement) {
+    std::vector<std::pair<Float, UnsignedInt>> entries;
+    return nearestHit(group, bounds, candidates, padding, origin, displacement, 1.0f, entries, [&](const AbstractShape<dimensions>& other) {
+        return Implementation::sweep(shape, displacement, Implementation::getAbstractShape(other));
+    });
+}
+
+/* Contacts are looked up by shape addresses, regardless of which shape is
+   first */
+template<UnsignedInt dimensions> std::pair<std::uintptr_t, std::uintptr_t> contactKey(const std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>& contact) {
+    const std::uintptr_t a = reinterpret_cast<std::uintptr_t>(contact.first);
+    const std::uintptr_t b = reinterpret_cast<std::uintptr_t>(contact.second);
+    return {std::min(a, b), std::max(a, b)};
+}
+
+template<UnsignedInt dimensions> bool contactLess(const std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>& a, const std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>& b) {
+    return contactKey<dimensions>(a) < contactKey<dimensions>(b);
+}
+
+}
+
 template<UnsignedInt dimensions> void ShapeGroup<dimensions>::setClean() {
     /* Clean all objects */
     if(!this->isEmpty()) {
@@ -40,18 +120,336 @@ template<UnsignedInt dimensions> void ShapeGroup<dimensions>::setClean() {
         SceneGraph::AbstractObject<dimensions, Float>::setClean(objects);
     }
 
+    updateBroadPhase(dirty);
     dirty = false;
 }
 
+template<UnsignedInt dimensions> void ShapeGroup<dimensions>::setClean(SceneGraph::AbstractJobSystem& jobSystem) {
+    /* Clean all objects */
+    if(!this->isEmpty()) {
+        std::vector<std::reference_wrapper<SceneGraph::AbstractObject<dimensions, Float>>> objects;
+        objects.reserve(this->size());
+        for(std::size_t i = 0; i != this->size(); ++i)
+            objects.push_back((*this)[i].object());
+
+        SceneGraph::AbstractObject<dimensions, Float>::setClean(objects, jobSystem);
+    }
+
+    updateBroadPhase(dirty);
+    dirty = false;
+}
+
+template<UnsignedInt dimensions> void ShapeGroup<dimensions>::setClean(FrameArena& arena) {
+    /* Clean all objects */
+    if(!this->isEmpty()) {
+        FrameArenaVector<std::reference_wrapper<SceneGraph::AbstractObject<dimensions, Float>>> objects{arena};
+        objects.reserve(this->size());
+        for(std::size_t i = 0; i != this->size(); ++i)
+            objects.push_back((*this)[i].object());
+
+        SceneGraph::AbstractObject<dimensions, Float>::setClean({objects.data(), objects.size()}, arena);
+    }
+
+    updateBroadPhase(dirty);
+    dirty = false;
+}
+
+template<UnsignedInt dimensions> void ShapeGroup<dimensions>::updateBroadPhase(const bool force) {
+    /* Nothing changed since last time */
+    bool changed = force || _shapes.size() != this->size();
+    for(std::size_t i = 0; !changed && i != this->size(); ++i)
+        changed = _shapes[i] != &(*this)[i];
+    if(!changed) return;
+
+    /* Some shapes were added or removed, start from scratch. Otherwise reuse
+       the previous ordering, it'll be mostly sorted already. */
+    std::vector<UnsignedInt>& order = _order;
+    order.clear();
+    order.reserve(this->size());
+    if(_shapes.size() != this->size()) {
+        for(std::size_t i = 0; i != this->size(); ++i)
+            order.push_back(i);
+    } else {
+        order.insert(order.end(), _sorted.begin(), _sorted.end());
+        order.insert(order.end(), _unbounded.begin(), _unbounded.end());
+    }
+
+    _shapes.resize(this->size());
+    _bounds.resize(this->size());
+    _points.clear();
+    _spheres.clear();
+    _boxes.clear();
+    _capsules.clear();
+    _pointIndices.clear();
+    _sphereIndices.clear();
+    _boxIndices.clear();
+    _capsuleIndices.clear();
+    for(std::size_t i = 0; i != this->size(); ++i) {
+        _shapes[i] = &(*this)[i];
+        _bounds[i] = (*this)[i].bounds();
+
+        /* Copy shapes supported by the batched collisions into the SoA
+           storage */
+        const Implementation::AbstractShape<dimensions>& shape = Implementation::getAbstractShape((*this)[i]);
+        switch(shape.type()) {
+            case Implementation::ShapeDimensionTraits<dimensions>::Type::Point:
+                _points.add(static_cast<const Implementation::Shape<Point<dimensions>>&>(shape).shape);
+                _pointIndices.push_back(i);
+                break;
+            case Implementation::ShapeDimensionTraits<dimensions>::Type::Sphere:
+                _spheres.add(static_cast<const Implementation::Shape<Sphere<dimensions>>&>(shape).shape);
+                _sphereIndices.push_back(i);
+                break;
+            case Implementation::ShapeDimensionTraits<dimensions>::Type::AxisAlignedBox:
+                _boxes.add(static_cast<const Implementation::Shape<AxisAlignedBox<dimensions>>&>(shape).shape);
+                _boxIndices.push_back(i);
+                break;
+            case Implementation::ShapeDimensionTraits<dimensions>::Type::Capsule:
+                _capsules.add(static_cast<const Implementation::Shape<Capsule<dimensions>>&>(shape).shape);
+                _capsuleIndices.push_back(i);
+                break;
+            default: break;
+        }
+    }
+
+    /* Separate shapes with infinite extent along the sweep axis */
+    _sorted.clear();
+    _unbounded.clear();
+    _maxWidth = 0.0f;
+    for(UnsignedInt i: order) {
+        const Float min = _bounds[i].min()[0];
+        const Float max = _bounds[i].max()[0];
+        if(min == -Constants::inf() || max == Constants::inf()) {
+            _unbounded.push_back(i);
+            continue;
+        }
+
+        _sorted.push_back(i);
+        _maxWidth = std::max(_maxWidth, max - min);
+    }
+    std::sort(_unbounded.begin(), _unbounded.end());
+
+    /* Insertion sort, linear for shapes that moved only a little */
+    for(std::size_t i = 1; i < _sorted.size(); ++i) {
+        const UnsignedInt index = _sorted[i];
+        const Float key = _bounds[index].min()[0];
+        std::size_t j = i;
+        for(; j != 0 && _bounds[_sorted[j - 1]].min()[0] > key; --j)
+            _sorted[j] = _sorted[j - 1];
+        _sorted[j] = index;
+    }
+}
+
+template<UnsignedInt dimensions> std::vector<UnsignedInt> ShapeGroup<dimensions>::candidates(const RangeTypeFor<dimensions, Float>& region) const {
+    std::vector<UnsignedInt> out;
+
+    /* Shapes with minimal X in range [region.min - maxWidth, region.max] can
+       intersect the region along X, test the rest of the axes for them */
+    auto first = std::lower_bound(_sorted.begin(), _sorted.end(), region.min()[0] - _maxWidth,
+        [this](UnsignedInt i, Float value) { return _bounds[i].min()[0] < value; });
+    auto last = std::upper_bound(first, _sorted.end(), region.max()[0],
+        [this](Float value, UnsignedInt i) { return value < _bounds[i].min()[0]; });
+    for(auto it = first; it != last; ++it)
+        if(Implementation::intersects<dimensions>(_bounds[*it], region)) out.push_back(*it);
+
+    for(UnsignedInt i: _unbounded)
+        if(Implementation::intersects<dimensions>(_bounds[i], region)) out.push_back(i);
+
+    /* Keep the order of the group */
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
 template<UnsignedInt dimensions> AbstractShape<dimensions>* ShapeGroup<dimensions>::firstCollision(const AbstractShape<dimensions>& shape) {
     setClean();
-    for(std::size_t i = 0; i != this->size(); ++i)
+    for(UnsignedInt i: candidates(shape.bounds()))
         if(&(*this)[i] != &shape && (*this)[i].collides(shape))
             return &(*this)[i];
 
     return nullptr;
 }
 
+template<UnsignedInt dimensions> void ShapeGroup<dimensions>::overlappingPairs(std::vector<std::pair<UnsignedInt, UnsignedInt>>& out) const {
+    out.clear();
+
+    /* Sweep along X, each shape needs to be tested only with shapes that
+       start before it ends */
+    for(std::size_t a = 0; a != _sorted.size(); ++a) {
+        const UnsignedInt i = _sorted[a];
+        for(std::size_t b = a + 1; b != _sorted.size() && _bounds[_sorted[b]].min()[0] <= _bounds[i].max()[0]; ++b) {
+            const UnsignedInt j = _sorted[b];
+            if(Implementation::intersects<dimensions>(_bounds[i], _bounds[j]))
+                out.emplace_back(std::min(i, j), std::max(i, j));
+        }
+    }
+
+    /* Shapes with infinite extent need to be tested with everything */
+    for(UnsignedInt i: _unbounded) {
+        for(std::size_t j = 0; j != _bounds.size(); ++j) {
+            if(j == i || (j < i && std::binary_search(_unbounded.begin(), _unbounded.end(), j)))
+                continue;
+            if(Implementation::intersects<dimensions>(_bounds[i], _bounds[j]))
+                out.emplace_back(std::min<UnsignedInt>(i, j), std::max<UnsignedInt>(i, j));
+        }
+    }
+
+    std::sort(out.begin(), out.end());
+}
+
+template<UnsignedInt dimensions> std::vector<std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>> ShapeGroup<dimensions>::collisionPairs() {
+    setClean();
+
+    std::vector<std::pair<UnsignedInt, UnsignedInt>> pairs;
+    overlappingPairs(pairs);
+
+    std::vector<std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>> out;
+    for(const auto& pair: pairs)
+        if((*this)[pair.first].collides((*this)[pair.second]))
+            out.emplace_back(&(*this)[pair.first], &(*this)[pair.second]);
+    return out;
+}
+
+template<UnsignedInt dimensions> std::vector<Contact<dimensions>> ShapeGroup<dimensions>::updateContacts() {
+    setClean();
+
+    /* The shape didn't change if it's at the same position in the group and
+       wasn't marked dirty since the last update */
+    auto unchanged = [this](const UnsignedInt i) {
+        return i < _contactShapes.size() && _contactShapes[i] == &(*this)[i] && _contactDirtyCounts[i] == (*this)[i].dirtyCount();
+    };
+
+    std::vector<std::pair<UnsignedInt, UnsignedInt>> pairs;
+    overlappingPairs(pairs);
+
+    std::vector<Contact<dimensions>> out;
+    std::vector<std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>> contacts;
+    _contactTestCount = 0;
+    for(const auto& pair: pairs) {
+        const std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*> contact{&(*this)[pair.first], &(*this)[pair.second]};
+        const bool previous = std::binary_search(_contacts.begin(), _contacts.end(), contact, contactLess<dimensions>);
+
+        /* Reuse the previous result if neither of the shapes changed */
+        bool colliding;
+        if(unchanged(pair.first) && unchanged(pair.second))
+            colliding = previous;
+        else {
+            ++_contactTestCount;
+            colliding = contact.first->collides(*contact.second);
+        }
+        if(!colliding) continue;
+
+        contacts.push_back(contact);
+        out.emplace_back(contact.first, contact.second, previous ? ContactState::Stay : ContactState::Begin);
+    }
+    std::sort(contacts.begin(), contacts.end(), contactLess<dimensions>);
+
+    /* Contacts that ended, keep the original order of the shapes */
+    for(const auto& contact: _contacts)
+        if(!std::binary_search(contacts.begin(), contacts.end(), contact, contactLess<dimensions>))
+            out.emplace_back(contact.first, contact.second, ContactState::End);
+
+    /* Remember the state for next time */
+    _contacts = std::move(contacts);
+    _contactShapes.resize(this->size());
+    _contactDirtyCounts.resize(this->size());
+    for(std::size_t i = 0; i != this->size(); ++i) {
+        _contactShapes[i] = &(*this)[i];
+        _contactDirtyCounts[i] = (*this)[i].dirtyCount();
+    }
+
+    return out;
+}
+
+template<UnsignedInt dimensions> void ShapeGroup<dimensions>::resetContacts() {
+    _contactShapes.clear();
+    _contactDirtyCounts.clear();
+    _contacts.clear();
+    _contactTestCount = 0;
+}
+
+template<UnsignedInt dimensions> std::vector<AbstractShape<dimensions>*> ShapeGroup<dimensions>::shapesInRegion(const RangeTypeFor<dimensions, Float>& region) {
+    setClean();
+
+    std::vector<AbstractShape<dimensions>*> out;
+    for(UnsignedInt i: candidates(region))
+        out.push_back(&(*this)[i]);
+    return out;
+}
+
+template<UnsignedInt dimensions> RaycastHit<dimensions> ShapeGroup<dimensions>::raycast(const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, const Float maxDistance) {
+    setClean();
+
+    std::vector<std::pair<Float, UnsignedInt>> entries;
+    Implementation::RayIntervals scratch;
+    return nearestHit(*this, _bounds, candidates(rayBounds<dimensions>(origin, direction, maxDistance)), origin, direction, maxDistance, entries, scratch);
+}
+
+template<UnsignedInt dimensions> std::vector<RaycastHit<dimensions>> ShapeGroup<dimensions>::raycast(const Containers::ArrayView<const VectorTypeFor<dimensions, Float>> origins, const Containers::ArrayView<const VectorTypeFor<dimensions, Float>> directions, const Float maxDistance) {
+    CORRADE_ASSERT(origins.size() == directions.size(),
+        "Shapes::ShapeGroup::raycast(): expected the same count of origins and directions, got" << origins.size() << "and" << directions.size(), {});
+
+    setClean();
+
+    std::vector<RaycastHit<dimensions>> out;
+    if(origins.empty()) return out;
+
+    /* Single broad phase query for the whole packet */
+    RangeTypeFor<dimensions, Float> region = rayBounds<dimensions>(origins[0], directions[0], maxDistance);
+    for(std::size_t i = 1; i != origins.size(); ++i) {
+        const RangeTypeFor<dimensions, Float> ray = rayBounds<dimensions>(origins[i], directions[i], maxDistance);
+        region = {Math::min(region.min(), ray.min()), Math::max(region.max(), ray.max())};
+    }
+    const std::vector<UnsignedInt> packetCandidates = candidates(region);
+
+    /* Scratch memory is reused for all rays */
+    std::vector<std::pair<Float, UnsignedInt>> entries;
+    Implementation::RayIntervals scratch;
+    out.reserve(origins.size());
+    for(std::size_t i = 0; i != origins.size(); ++i)
+        out.push_back(nearestHit(*this, _bounds, packetCandidates, origins[i], directions[i], maxDistance, entries, scratch));
+    return out;
+}
+
+template<UnsignedInt dimensions> std::vector<RaycastHit<dimensions>> ShapeGroup<dimensions>::raycastAll(const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, const Float maxDistance) {
+    setClean();
+
+    std::vector<std::pair<Float, UnsignedInt>> entries;
+    sortedByEntry<dimensions>(_bounds, candidates(rayBounds<dimensions>(origin, direction, maxDistance)), {}, origin, direction, maxDistance, entries);
+
+    /* The exact hit distance can differ from the bounds entry, sort again */
+    Implementation::RayIntervals scratch;
+    std::vector<std::pair<Float, UnsignedInt>> hits;
+    for(const auto& entry: entries) {
+        const Float distance = Implementation::raycast(Implementation::getAbstractShape((*this)[entry.second]), origin, direction, scratch);
+        if(distance != Constants::inf() && distance <= maxDistance) hits.emplace_back(distance, entry.second);
+    }
+    std::sort(hits.begin(), hits.end());
+
+    std::vector<RaycastHit<dimensions>> out;
+    out.reserve(hits.size());
+    for(const auto& hit: hits)
+        out.emplace_back(&(*this)[hit.second], origin + direction*hit.first, hit.first);
+    return out;
+}
+
+template<UnsignedInt dimensions> RaycastHit<dimensions> ShapeGroup<dimensions>::sweep(const Sphere<dimensions>& sphere, const VectorTypeFor<dimensions, Float>& displacement) {
+    setClean();
+
+    /* Broad phase with bounds of the whole motion */
+    const RangeTypeFor<dimensions, Float> padding{VectorTypeFor<dimensions, Float>{-sphere.radius()}, VectorTypeFor<dimensions, Float>{sphere.radius()}};
+    const RangeTypeFor<dimensions, Float> motion = rayBounds<dimensions>(sphere.position(), displacement, 1.0f);
+    return sweepHit(*this, _bounds, candidates({motion.min() + padding.min(), motion.max() + padding.max()}), padding, sphere.position(), sphere, displacement);
+}
+
+template<UnsignedInt dimensions> RaycastHit<dimensions> ShapeGroup<dimensions>::sweep(const Capsule<dimensions>& capsule, const VectorTypeFor<dimensions, Float>& displacement) {
+    setClean();
+
+    const VectorTypeFor<dimensions, Float> axis = capsule.b() - capsule.a();
+    const RangeTypeFor<dimensions, Float> padding{Math::min(axis, VectorTypeFor<dimensions, Float>{}) - VectorTypeFor<dimensions, Float>{capsule.radius()}, Math::max(axis, VectorTypeFor<dimensions, Float>{}) + VectorTypeFor<dimensions, Float>{capsule.radius()}};
+    const RangeTypeFor<dimensions, Float> motion = rayBounds<dimensions>(capsule.a(), displacement, 1.0f);
+    return sweepHit(*this, _bounds, candidates({motion.min() + padding.min(), motion.max() + padding.max()}), padding, capsule.a(), capsule, displacement);
+}
+
 #ifndef DOXYGEN_GENERATING_OUTPUT
 template class MAGNUM_SHAPES_EXPORT ShapeGroup<2>;
 template class MAGNUM_SHAPES_EXPORT ShapeGroup<3>;
@@ -29,10 +29,18 @@
  * @brief Class @ref Magnum::Shapes::ShapeGroup, typedef @ref Magnum::Shapes::ShapeGroup2D, @ref Magnum::Shapes::ShapeGroup3D
  */
 
+#include <utility>
 #include <vector>
+#include <Corrade/Containers/ArrayView.h>
 
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Range.h"
 #include "Magnum/SceneGraph/FeatureGroup.h"
 #include "Magnum/Shapes/AbstractShape.h"
+#include "Magnum/Shapes/BatchCollision.h"
+#include "Magnum/Shapes/Contact.h"
+#include "Magnum/Shapes/RaycastHit.h"
 #include "Magnum/Shapes/visibility.h"
 
 namespace Magnum { namespace Shapes {
@@ -41,6 +49,78 @@ namespace Magnum { namespace Shapes {
 @brief Group of shapes
 
 See @ref Shape for more information. See @ref shapes for brief introduction.
+
+## Broad phase
+
+Collision queries first use @ref AbstractShape::bounds() of all shapes in the
+group to skip shapes which can't collide, the exact collision is then tested
+only for the remaining ones. The bounds are kept sorted along the X axis and
+are updated in @ref setClean() only if the group is dirty or shapes were added
+or removed, the previous ordering is reused so the update is close to linear
+for coherent motion. Shapes with infinite bounds along the X axis are tested
+against everything.
+
+## Transformed shape storage
+
+Besides the bounds, @ref setClean() copies transformed points, spheres,
+axis-aligned boxes and capsules in the group into contiguous structure of
+arrays, accessible through @ref points(), @ref spheres(), @ref boxes() and
+@ref capsules(). The @ref pointIndices(), @ref sphereIndices(),
+@ref boxIndices() and @ref capsuleIndices() arrays map them back to
+position of the shape in the group. The arrays can be passed directly to the
+batched @ref collides() functions without visiting each shape:
+@code
+Shapes::Sphere3D player;
+shapes.setClean();
+
+Containers::Array<bool> hits{shapes.spheres().size()};
+Shapes::collides(Shapes::SphereBatch3D{{&player, 1}}, shapes.spheres(), hits);
+for(std::size_t i = 0; i != hits.size(); ++i)
+    if(hits[i]) Debug() << "Player touched" << &shapes[shapes.sphereIndices()[i]];
+@endcode
+
+Like the bounds, the arrays are rebuilt only if the group is dirty or shapes
+were added or removed. They keep their capacity, so in a steady state the
+update doesn't allocate.
+
+## Contact tracking
+
+Instead of calling @ref collisionPairs() every frame and comparing the results
+with the previous frame, @ref updateContacts() keeps a persistent set of
+colliding pairs and reports which contacts began, which stayed and which
+ended since the last call. Exact collision is tested again only for pairs in
+which at least one shape was marked dirty since the last call, for the other
+pairs the previous result is reused.
+@code
+for(const Shapes::Contact3D& contact: shapes.updateContacts()) {
+    if(contact.state() == Shapes::ContactState::Begin)
+        Debug() << "Touched" << contact.a() << contact.b();
+}
+@endcode
+
+## Ray casting
+
+@ref raycast() and @ref raycastAll() cast a ray given by origin and direction
+against the shapes in the group. The broad phase first selects shapes with
+bounds intersecting bounds of the ray, the remaining shapes are sorted by
+distance at which the ray enters their bounds and the exact test is done in
+that order, stopping once the bounds are farther than the nearest hit so far.
+Solid shapes and compositions of them can be hit, as well as shapes
+dividing the space (2D lines and line segments, 3D planes). Points and 3D
+lines or line segments are never hit.
+
+If many rays are cast at once, for example for picking or line-of-sight
+queries from a single position, pass them all to
+@ref raycast(Containers::ArrayView<const VectorTypeFor<dimensions, Float>>, Containers::ArrayView<const VectorTypeFor<dimensions, Float>>, Float)
+instead of casting them one by one. The broad phase query is then done only
+once for the whole packet.
+@code
+Shapes::ShapeGroup3D shapes;
+// ...
+
+Shapes::RaycastHit3D hit = shapes.raycast(camera.position(), direction);
+if(hit) Debug() << "Hit at" << hit.position();
+@endcode
 @see @ref scenegraph, @ref ShapeGroup2D, @ref ShapeGroup3D
 */
 template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT ShapeGroup: public SceneGraph::FeatureGroup<dimensions, AbstractShape<dimensions>, Float> {
@@ -52,7 +132,7 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT ShapeGroup: public S
          *
          * Marks the group as dirty.
          */
-        explicit ShapeGroup(): dirty(true) {}
+        explicit ShapeGroup(): dirty(true), _maxWidth{}, _contactTestCount{} {}
 
         /**
          * @brief Whether the group is dirty
@@ -74,10 +154,28 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT ShapeGroup: public S
          * @brief Set the group and all bodies as clean
          *
          * This function is called before computing any collisions to ensure
-         * all objects are cleaned.
+         * all objects are cleaned. Also updates the broad phase, if needed.
          */
         void setClean();
 
+        /**
+         * @brief Set the group and all bodies as clean using given job system
+         *
+         * Same as @ref setClean(), but the absolute transformations are
+         * computed in jobs executed by @p jobSystem. See
+         * @ref SceneGraph::Object::transformations() for more information.
+         */
+        void setClean(SceneGraph::AbstractJobSystem& jobSystem);
+
+        /**
+         * @brief Set the group and all bodies as clean using given frame arena
+         *
+         * Same as @ref setClean(), but all temporary data are allocated from
+         * @p arena, so the function doesn't allocate from the heap. See
+         * @ref FrameArena for more information.
+         */
+        void setClean(FrameArena& arena);
+
         /**
          * @brief First collision of given shape with other shapes in the group
          *
@@ -87,8 +185,237 @@ template<UnsignedInt dimensions> class MAGNUM_SHAPES_EXPORT ShapeGroup: public S
          */
         AbstractShape<dimensions>* firstCollision(const AbstractShape<dimensions>& shape);
 
+        /**
+         * @brief All colliding pairs of shapes in the group
+         *
+         * Returns all pairs of colliding shapes, each pair only once, with
+         * the shape that's earlier in the group first. The pairs are ordered
+         * by position of the shapes in the group. Calls @ref setClean()
+         * before the operation.
+         * @see @ref AbstractShape::collides()
+         */
+        std::vector<std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>> collisionPairs();
+
+        /**
+         * @brief Update persistent contacts
+         *
+         * Finds all colliding pairs like @ref collisionPairs() and compares
+         * them with the result of the previous call. Pairs that didn't
+         * collide previously are reported with @ref ContactState::Begin,
+         * pairs that are still colliding with @ref ContactState::Stay, both
+         * in the same order as in @ref collisionPairs(). These are followed
+         * by pairs that stopped colliding, reported with
+         * @ref ContactState::End in unspecified order, with the shapes in
+         * the same order as when the contact began. That includes pairs with shapes that were removed from the group since
+         * the last call --- such shapes might be already destroyed, thus
+         * their pointers should only be compared and not dereferenced.
+         *
+         * Exact collision is tested only for pairs with bounds intersecting
+         * and at least one shape marked dirty (see
+         * @ref AbstractShape::dirtyCount()) or moved to a different position
+         * in the group since the last call. Calls @ref setClean() before the
+         * operation.
+         * @see @ref contactTestCount()
+         */
+        std::vector<Contact<dimensions>> updateContacts();
+
+        /**
+         * @brief Count of exact collision tests done in last contact update
+         *
+         * Useful for verifying that unchanged pairs were not tested again.
+         * @see @ref updateContacts()
+         */
+        std::size_t contactTestCount() const { return _contactTestCount; }
+
+        /** @brief Discard all persistent contacts */
+        void resetContacts();
+
+        /**
+         * @brief Shapes in given region
+         *
+         * Returns all shapes which have @ref AbstractShape::bounds()
+         * intersecting given region, in the order they are in the group. No
+         * exact collision test is done. Calls @ref setClean() before the
+         * operation.
+         */
+        std::vector<AbstractShape<dimensions>*> shapesInRegion(const RangeTypeFor<dimensions, Float>& region);
+
+        /**
+         * @brief Nearest shape hit by a ray
+         * @param origin        Ray origin
+         * @param direction     Ray direction
+         * @param maxDistance   Max distance along the ray, in multiples of
+         *      direction length
+         *
+         * Returns the shape with smallest hit distance in range
+         * @f$ [ 0 ; maxDistance ] @f$. If more shapes are hit at the same
+         * distance, returns the one that's earlier in the group. If nothing
+         * is hit, returns default-constructed @ref RaycastHit. Calls
+         * @ref setClean() before the operation.
+         * @see @ref raycastAll()
+         */
+        RaycastHit<dimensions> raycast(const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, Float maxDistance = Constants::inf());
+
+        /**
+         * @brief Nearest shapes hit by a packet of rays
+         * @param origins       Ray origins
+         * @param directions    Ray directions
+         * @param maxDistance   Max distance along the rays, in multiples of
+         *      direction length
+         *
+         * Same as calling @ref raycast(const VectorTypeFor<dimensions, Float>&, const VectorTypeFor<dimensions, Float>&, Float)
+         * for each ray, but the broad phase is queried only once for the
+         * bounds of the whole packet. Best suited for coherent rays, i.e. rays
+         * starting close to each other and pointing in similar directions.
+         * Expects that @p origins and @p directions have the same size.
+         */
+        std::vector<RaycastHit<dimensions>> raycast(Containers::ArrayView<const VectorTypeFor<dimensions, Float>> origins, Containers::ArrayView<const VectorTypeFor<dimensions, Float>> directions, Float maxDistance = Constants::inf());
+
+        /**
+         * @brief All shapes hit by a ray
+         *
+         * Returns all shapes hit by a ray in range @f$ [ 0 ; maxDistance ] @f$,
+         * each shape only once, sorted by hit distance. Hits at the same
+         * distance are ordered by position of the shapes in the group. Calls
+         * @ref setClean() before the operation.
+         * @see @ref raycast()
+         */
+        std::vector<RaycastHit<dimensions>> raycastAll(const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, Float maxDistance = Constants::inf());
+
+        /**
+         * @brief First shape hit by a moving sphere
+         * @param sphere        Sphere at the beginning of the motion
+         * @param displacement  Translation of the sphere during the motion
+         *
+         * Returns the shape touched first by @p sphere as it moves by
+         * @p displacement. The hit distance is time of impact in range
+         * @f$ [ 0 ; 1 ] @f$ and the hit position is sphere center at that
+         * time. See @ref Shapes::sweep() for details about the test itself and @ref raycast() for the
+         * tie-breaking rules. Inverted spheres and compositions are not
+         * supported and are never hit. The sphere itself shouldn't be in the
+         * group, otherwise it's hit at time `0`. Calls @ref setClean()
+         * before the operation.
+         *
+         * The broad phase tests only shapes with bounds intersecting bounds
+         * of the whole motion, in order of estimated time of impact, so the
+         * displacement can be arbitrarily long without the sphere tunneling
+         * through anything.
+         */
+        RaycastHit<dimensions> sweep(const Sphere<dimensions>& sphere, const VectorTypeFor<dimensions, Float>& displacement);
+
+        /**
+         * @brief First shape hit by a moving capsule
+         *
+         * Same as @ref sweep(const Sphere<dimensions>&, const VectorTypeFor<dimensions, Float>&),
+         * but for a capsule, the hit position is the first capsule point at
+         * time of impact. Additionally lines and cylinders are not supported
+         * and are never hit.
+         */
+        RaycastHit<dimensions> sweep(const Capsule<dimensions>& capsule, const VectorTypeFor<dimensions, Float>& displacement);
+
+        /**
+         * @brief Transformed points in the group
+         *
+         * Valid after @ref setClean(), in the same order as in the group.
+         * @see @ref pointIndices()
+         */
+        const PointBatch<dimensions>& points() const { return _points; }
+
+        /**
+         * @brief Group indices of transformed points
+         *
+         * Position of each item of @ref points() in the group.
+         */
+        Containers::ArrayView<const UnsignedInt> pointIndices() const {
+            return {_pointIndices.data(), _pointIndices.size()};
+        }
+
+        /**
+         * @brief Transformed spheres in the group
+         *
+         * Valid after @ref setClean(), in the same order as in the group.
+         * Inverted spheres are not included.
+         * @see @ref sphereIndices()
+         */
+        const SphereBatch<dimensions>& spheres() const { return _spheres; }
+
+        /**
+         * @brief Group indices of transformed spheres
+         *
+         * Position of each item of @ref spheres() in the group.
+         */
+        Containers::ArrayView<const UnsignedInt> sphereIndices() const {
+            return {_sphereIndices.data(), _sphereIndices.size()};
+        }
+
+        /**
+         * @brief Transformed axis-aligned boxes in the group
+         *
+         * Valid after @ref setClean(), in the same order as in the group.
+         * @see @ref boxIndices()
+         */
+        const AxisAlignedBoxBatch<dimensions>& boxes() const { return _boxes; }
+
+        /**
+         * @brief Group indices of transformed axis-aligned boxes
+         *
+         * Position of each item of @ref boxes() in the group.
+         */
+        Containers::ArrayView<const UnsignedInt> boxIndices() const {
+            return {_boxIndices.data(), _boxIndices.size()};
+        }
+
+        /**
+         * @brief Transformed capsules in the group
+         *
+         * Valid after @ref setClean(), in the same order as in the group.
+         * @see @ref capsuleIndices()
+         */
+        const CapsuleBatch<dimensions>& capsules() const { return _capsules; }
+
+        /**
+         * @brief Group indices of transformed capsules
+         *
+         * Position of each item of @ref capsules() in the group.
+         */
+        Containers::ArrayView<const UnsignedInt> capsuleIndices() const {
+            return {_capsuleIndices.data(), _capsuleIndices.size()};
+        }
+
     private:
+        void MAGNUM_SHAPES_LOCAL updateBroadPhase(bool force);
+        std::vector<UnsignedInt> MAGNUM_SHAPES_LOCAL candidates(const RangeTypeFor<dimensions, Float>& region) const;
+        void MAGNUM_SHAPES_LOCAL overlappingPairs(std::vector<std::pair<UnsignedInt, UnsignedInt>>& out) const;
+
         bool dirty;
+
+        /* Broad phase. Bounds of all shapes, indexed same as the features,
+           backup of feature list to detect changes in the group, group
+           indices sorted by minimal X coordinate of the bounds, shapes with
+           infinite X extent and largest finite X extent. The last is scratch
+           memory for the update, kept to avoid reallocation. */
+        std::vector<RangeTypeFor<dimensions, Float>> _bounds;
+        std::vector<const AbstractShape<dimensions>*> _shapes;
+        std::vector<UnsignedInt> _sorted;
+        std::vector<UnsignedInt> _unbounded;
+        Float _maxWidth;
+        std::vector<UnsignedInt> _order;
+
+        /* Transformed shapes of types supported by the batched collisions
+           and their indices in the group */
+        PointBatch<dimensions> _points;
+        SphereBatch<dimensions> _spheres;
+        AxisAlignedBoxBatch<dimensions> _boxes;
+        CapsuleBatch<dimensions> _capsules;
+        std::vector<UnsignedInt> _pointIndices, _sphereIndices, _boxIndices, _capsuleIndices;
+
+        /* Persistent contacts. Shapes and their dirty counts at the time of
+           the last update, indexed same as the features, and colliding
+           pairs sorted by address of the shapes. */
+        std::vector<const AbstractShape<dimensions>*> _contactShapes;
+        std::vector<UnsignedInt> _contactDirtyCounts;
+        std::vector<std::pair<AbstractShape<dimensions>*, AbstractShape<dimensions>*>> _contacts;
+        std::size_t _contactTestCount;
 };
 
 /**
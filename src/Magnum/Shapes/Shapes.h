@@ -42,6 +42,10 @@ template<UnsignedInt> class AxisAlignedBox;
 typedef AxisAlignedBox<2> AxisAlignedBox2D;
 typedef AxisAlignedBox<3> AxisAlignedBox3D;
 
+template<UnsignedInt> class AxisAlignedBoxBatch;
+typedef AxisAlignedBoxBatch<2> AxisAlignedBoxBatch2D;
+typedef AxisAlignedBoxBatch<3> AxisAlignedBoxBatch3D;
+
 template<UnsignedInt> class Box;
 typedef Box<2> Box2D;
 typedef Box<3> Box3D;
@@ -50,6 +54,14 @@ template<UnsignedInt> class Capsule;
 typedef Capsule<2> Capsule2D;
 typedef Capsule<3> Capsule3D;
 
+template<UnsignedInt> class CompiledComposition;
+typedef CompiledComposition<2> CompiledComposition2D;
+typedef CompiledComposition<3> CompiledComposition3D;
+
+template<UnsignedInt> class CapsuleBatch;
+typedef CapsuleBatch<2> CapsuleBatch2D;
+typedef CapsuleBatch<3> CapsuleBatch3D;
+
 template<UnsignedInt> class Collision;
 typedef Collision<2> Collision2D;
 typedef Collision<3> Collision3D;
@@ -58,6 +70,12 @@ template<UnsignedInt> class Composition;
 typedef Composition<2> Composition2D;
 typedef Composition<3> Composition3D;
 
+template<UnsignedInt> class Contact;
+typedef Contact<2> Contact2D;
+typedef Contact<3> Contact3D;
+
+enum class ContactState: UnsignedByte;
+
 template<UnsignedInt> class Cylinder;
 typedef Cylinder<2> Cylinder2D;
 typedef Cylinder<3> Cylinder3D;
@@ -76,10 +94,16 @@ template<UnsignedInt> class ShapeGroup;
 typedef ShapeGroup<2> ShapeGroup2D;
 typedef ShapeGroup<3> ShapeGroup3D;
 
+class SpatialHash2D;
+
 template<UnsignedInt> class Sphere;
 typedef Sphere<2> Sphere2D;
 typedef Sphere<3> Sphere3D;
 
+template<UnsignedInt> class SphereBatch;
+typedef SphereBatch<2> SphereBatch2D;
+typedef SphereBatch<3> SphereBatch3D;
+
 template<UnsignedInt> class InvertedSphere;
 typedef InvertedSphere<2> InvertedSphere2D;
 typedef InvertedSphere<3> InvertedSphere3D;
@@ -89,6 +113,14 @@ class Plane;
 template<UnsignedInt> class Point;
 typedef Point<2> Point2D;
 typedef Point<3> Point3D;
+
+template<UnsignedInt> class PointBatch;
+typedef PointBatch<2> PointBatch2D;
+typedef PointBatch<3> PointBatch3D;
+
+template<UnsignedInt> class RaycastHit;
+typedef RaycastHit<2> RaycastHit2D;
+typedef RaycastHit<3> RaycastHit3D;
 #endif
 
 }}
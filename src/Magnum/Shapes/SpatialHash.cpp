@@ -0,0 +1,348 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SpatialHash.h"
+
+#include <algorithm>
+#include <cmath>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Shapes/AbstractShape.h"
+#include "Magnum/Shapes/ShapeGroup.h"
+#include "Magnum/Shapes/Implementation/Bounds.h"
+
+namespace Magnum { namespace Shapes {
+
+namespace {
+
+/* Entries spanning more cells are tested in every query instead */
+constexpr Int MaxCellsPerEntry = 64;
+
+/* Cell coordinates are clamped so the packing doesn't overflow */
+constexpr Float MaxCellCoordinate = 1.0e9f;
+
+inline std::uint64_t key(const Int x, const Int y) {
+    return (std::uint64_t(UnsignedInt(x)) << 32)|UnsignedInt(y);
+}
+
+inline Float distanceSquared(const Range2D& bounds, const Vector2& point) {
+    const Vector2 delta = Math::max(Math::max(bounds.min() - point, point - bounds.max()), Vector2{});
+    return delta.dot();
+}
+
+}
+
+SpatialHash2D::SpatialHash2D(const Float cellSize): _cellSize{}, _size{}, _occupiedMin{1}, _occupiedMax{0} {
+    setCellSize(cellSize);
+}
+
+SpatialHash2D& SpatialHash2D::setCellSize(const Float cellSize) {
+    CORRADE_ASSERT(cellSize > 0.0f,
+        "Shapes::SpatialHash2D::setCellSize(): expected positive cell size, got" << cellSize, *this);
+
+    _cellSize = cellSize;
+    _cells.clear();
+    _oversized.clear();
+    _occupiedMin = Vector2i{1};
+    _occupiedMax = Vector2i{0};
+    for(std::size_t i = 0; i != _entries.size(); ++i)
+        if(_entries[i].used) insert(i);
+
+    return *this;
+}
+
+Range2D SpatialHash2D::bounds(const UnsignedInt id) const {
+    CORRADE_ASSERT(contains(id),
+        "Shapes::SpatialHash2D::bounds(): entry" << id << "doesn't exist", {});
+    return _entries[id].bounds;
+}
+
+Vector2i SpatialHash2D::cell(const Vector2& position) const {
+    const Vector2 scaled = position/_cellSize;
+    return {Int(Math::clamp(std::floor(scaled.x()), -MaxCellCoordinate, MaxCellCoordinate)),
+            Int(Math::clamp(std::floor(scaled.y()), -MaxCellCoordinate, MaxCellCoordinate))};
+}
+
+template<class F> void SpatialHash2D::forEachCell(const Vector2i& min, const Vector2i& max, F f) const {
+    /* Clip to the occupied range, go through all cells instead if there are
+       fewer occupied cells than the region has */
+    const Vector2i clippedMin = Math::max(min, _occupiedMin);
+    const Vector2i clippedMax = Math::min(max, _occupiedMax);
+    if(!(clippedMin <= clippedMax).all()) return;
+
+    const Vector2i size = clippedMax - clippedMin + Vector2i{1};
+    if(std::uint64_t(size.x())*std::uint64_t(size.y()) > _cells.size()) {
+        for(const auto& cell: _cells) {
+            const Vector2i position{Int(UnsignedInt(cell.first >> 32)), Int(UnsignedInt(cell.first & 0xffffffffu))};
+            if((position >= clippedMin).all() && (position <= clippedMax).all())
+                f(position, cell.second);
+        }
+        return;
+    }
+
+    for(Int y = clippedMin.y(); y <= clippedMax.y(); ++y) {
+        for(Int x = clippedMin.x(); x <= clippedMax.x(); ++x) {
+            const auto found = _cells.find(key(x, y));
+            if(found != _cells.end()) f(Vector2i{x, y}, found->second);
+        }
+    }
+}
+
+void SpatialHash2D::insert(const UnsignedInt id) {
+    Entry& entry = _entries[id];
+    entry.cellMin = cell(entry.bounds.min());
+    entry.cellMax = cell(entry.bounds.max());
+    const Vector2i size = entry.cellMax - entry.cellMin + Vector2i{1};
+    entry.oversized = Implementation::isInfinite<2>(entry.bounds) || size.x() > MaxCellsPerEntry || size.y() > MaxCellsPerEntry || size.product() > MaxCellsPerEntry;
+
+    if(entry.oversized) {
+        _oversized.insert(std::lower_bound(_oversized.begin(), _oversized.end(), id), id);
+        return;
+    }
+
+    for(Int y = entry.cellMin.y(); y <= entry.cellMax.y(); ++y)
+        for(Int x = entry.cellMin.x(); x <= entry.cellMax.x(); ++x)
+            _cells[key(x, y)].push_back(id);
+
+    if(_occupiedMin.x() > _occupiedMax.x()) {
+        _occupiedMin = entry.cellMin;
+        _occupiedMax = entry.cellMax;
+    } else {
+        _occupiedMin = Math::min(_occupiedMin, entry.cellMin);
+        _occupiedMax = Math::max(_occupiedMax, entry.cellMax);
+    }
+}
+
+void SpatialHash2D::erase(const UnsignedInt id) {
+    const Entry& entry = _entries[id];
+    if(entry.oversized) {
+        _oversized.erase(std::lower_bound(_oversized.begin(), _oversized.end(), id));
+        return;
+    }
+
+    for(Int y = entry.cellMin.y(); y <= entry.cellMax.y(); ++y) {
+        for(Int x = entry.cellMin.x(); x <= entry.cellMax.x(); ++x) {
+            const auto found = _cells.find(key(x, y));
+            std::vector<UnsignedInt>& ids = found->second;
+            *std::find(ids.begin(), ids.end(), id) = ids.back();
+            ids.pop_back();
+            if(ids.empty()) _cells.erase(found);
+        }
+    }
+}
+
+SpatialHash2D& SpatialHash2D::set(const UnsignedInt id, const Range2D& bounds) {
+    if(id >= _entries.size()) _entries.resize(id + 1, Entry{{}, {}, {}, nullptr, 0, false, false});
+
+    Entry& entry = _entries[id];
+    if(entry.used) {
+        /* Stays in the same cells, just update the bounds */
+        if(!entry.oversized && !Implementation::isInfinite<2>(bounds) && cell(bounds.min()) == entry.cellMin && cell(bounds.max()) == entry.cellMax) {
+            entry.bounds = bounds;
+            return *this;
+        }
+
+        erase(id);
+    } else {
+        entry.used = true;
+        ++_size;
+    }
+
+    entry.bounds = bounds;
+    insert(id);
+    return *this;
+}
+
+SpatialHash2D& SpatialHash2D::remove(const UnsignedInt id) {
+    CORRADE_ASSERT(contains(id),
+        "Shapes::SpatialHash2D::remove(): entry" << id << "doesn't exist", *this);
+
+    erase(id);
+    _entries[id].used = false;
+    _entries[id].shape = nullptr;
+    --_size;
+    return *this;
+}
+
+SpatialHash2D& SpatialHash2D::clear() {
+    _entries.clear();
+    _cells.clear();
+    _oversized.clear();
+    _size = 0;
+    _occupiedMin = Vector2i{1};
+    _occupiedMax = Vector2i{0};
+    return *this;
+}
+
+void SpatialHash2D::update(ShapeGroup2D& group) {
+    group.setClean();
+
+    for(std::size_t i = 0; i != group.size(); ++i) {
+        const AbstractShape2D& shape = group[i];
+        if(contains(i) && _entries[i].shape == &shape && _entries[i].dirtyCount == shape.dirtyCount())
+            continue;
+
+        set(i, shape.bounds());
+        _entries[i].shape = &shape;
+        _entries[i].dirtyCount = shape.dirtyCount();
+    }
+
+    for(std::size_t i = group.size(); i < _entries.size(); ++i)
+        if(_entries[i].used) remove(i);
+    _entries.resize(std::min(_entries.size(), group.size()));
+}
+
+std::vector<UnsignedInt> SpatialHash2D::query(const Range2D& region) const {
+    std::vector<UnsignedInt> out;
+    forEachCell(cell(region.min()), cell(region.max()), [&](const Vector2i&, const std::vector<UnsignedInt>& ids) {
+        for(const UnsignedInt id: ids)
+            if(Implementation::intersects<2>(_entries[id].bounds, region)) out.push_back(id);
+    });
+    for(const UnsignedInt id: _oversized)
+        if(Implementation::intersects<2>(_entries[id].bounds, region)) out.push_back(id);
+
+    /* Entries spanning more cells are found more than once */
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+    return out;
+}
+
+std::vector<UnsignedInt> SpatialHash2D::queryRadius(const Vector2& center, const Float radius) const {
+    std::vector<UnsignedInt> out = query({center - Vector2{radius}, center + Vector2{radius}});
+    out.erase(std::remove_if(out.begin(), out.end(), [&](const UnsignedInt id) {
+        return distanceSquared(_entries[id].bounds, center) > radius*radius;
+    }), out.end());
+    return out;
+}
+
+std::vector<UnsignedInt> SpatialHash2D::nearest(const Vector2& point, const std::size_t count, const Float maxDistance) const {
+    std::vector<UnsignedInt> out;
+    if(!count) return out;
+
+    /* Squared distances and IDs of found entries */
+    std::vector<std::pair<Float, UnsignedInt>> found;
+    const Float maxDistanceSquared = maxDistance*maxDistance;
+    for(const UnsignedInt id: _oversized) {
+        const Float distance = distanceSquared(_entries[id].bounds, point);
+        if(distance <= maxDistanceSquared) found.emplace_back(distance, id);
+    }
+
+    /* Search in rings of cells around the point, starting with the first ring
+       touching the occupied cells. An entry is taken only from the cell
+       containing its point nearest to the query point, so each is found just
+       once. Everything outside of ring r is farther than r cells from the
+       point. */
+    const Vector2i center = cell(point);
+    const Vector2i outside = Math::max(Math::max(_occupiedMin - center, center - _occupiedMax), Vector2i{});
+    for(Int r = _occupiedMin.x() > _occupiedMax.x() ? 0 : Math::max(outside.x(), outside.y()); ; ++r) {
+        const Vector2i min = center - Vector2i{r}, max = center + Vector2i{r};
+        auto visit = [&](const Vector2i& position, const std::vector<UnsignedInt>& ids) {
+            for(const UnsignedInt id: ids) {
+                const Range2D& bounds = _entries[id].bounds;
+                if(cell(Math::clamp(point, bounds.min(), bounds.max())) != position) continue;
+                const Float distance = distanceSquared(bounds, point);
+                if(distance <= maxDistanceSquared) found.emplace_back(distance, id);
+            }
+        };
+        if(r == 0) forEachCell(min, max, visit);
+        else {
+            forEachCell(min, {max.x(), min.y()}, visit);
+            forEachCell({min.x(), max.y()}, max, visit);
+            forEachCell({min.x(), min.y() + 1}, {min.x(), max.y() - 1}, visit);
+            forEachCell({max.x(), min.y() + 1}, {max.x(), max.y() - 1}, visit);
+        }
+
+        const Float searched = r*_cellSize;
+        if(found.size() >= count) {
+            std::partial_sort(found.begin(), found.begin() + count, found.end());
+            found.resize(count);
+            if(found.back().first < searched*searched) break;
+        }
+
+        /* Searched all occupied cells or farther than the max distance */
+        if(_occupiedMin.x() > _occupiedMax.x() || ((min <= _occupiedMin).all() && (max >= _occupiedMax).all())) break;
+        if(searched > maxDistance) break;
+    }
+
+    std::sort(found.begin(), found.end());
+    out.reserve(found.size());
+    for(const auto& entry: found) out.push_back(entry.second);
+    return out;
+}
+
+std::vector<std::pair<UnsignedInt, UnsignedInt>> SpatialHash2D::pairs() const {
+    std::vector<std::pair<UnsignedInt, UnsignedInt>> out;
+
+    /* Each pair is reported only in the cell containing minimum of the
+       intersection of the bounds, which both entries share */
+    for(const auto& cell: _cells) {
+        const std::vector<UnsignedInt>& ids = cell.second;
+        for(std::size_t a = 0; a != ids.size(); ++a) {
+            for(std::size_t b = a + 1; b != ids.size(); ++b) {
+                const Entry& first = _entries[ids[a]];
+                const Entry& second = _entries[ids[b]];
+                if(!Implementation::intersects<2>(first.bounds, second.bounds)) continue;
+                const Vector2i owner = Math::max(first.cellMin, second.cellMin);
+                if(key(owner[0], owner[1]) != cell.first) continue;
+                out.emplace_back(std::min(ids[a], ids[b]), std::max(ids[a], ids[b]));
+            }
+        }
+    }
+
+    /* Oversized entries need to be tested with everything */
+    for(const UnsignedInt i: _oversized) {
+        for(std::size_t j = 0; j != _entries.size(); ++j) {
+            if(j == i || !_entries[j].used || (_entries[j].oversized && j < i)) continue;
+            if(Implementation::intersects<2>(_entries[i].bounds, _entries[j].bounds))
+                out.emplace_back(std::min<UnsignedInt>(i, j), std::max<UnsignedInt>(i, j));
+        }
+    }
+
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+AbstractShape2D* SpatialHash2D::firstCollision(ShapeGroup2D& group, const AbstractShape2D& shape) {
+    update(group);
+    for(const UnsignedInt i: query(shape.bounds()))
+        if(&group[i] != &shape && group[i].collides(shape))
+            return &group[i];
+
+    return nullptr;
+}
+
+std::vector<std::pair<AbstractShape2D*, AbstractShape2D*>> SpatialHash2D::collisionPairs(ShapeGroup2D& group) {
+    update(group);
+
+    std::vector<std::pair<AbstractShape2D*, AbstractShape2D*>> out;
+    for(const auto& pair: pairs())
+        if(group[pair.first].collides(group[pair.second]))
+            out.emplace_back(&group[pair.first], &group[pair.second]);
+    return out;
+}
+
+}}
@@ -0,0 +1,254 @@
+#ifndef Magnum_Shapes_SpatialHash_h
+#define Magnum_Shapes_SpatialHash_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Shapes::SpatialHash2D
+ */
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Shapes/Shapes.h"
+#include "Magnum/Shapes/visibility.h"
+
+namespace Magnum { namespace Shapes {
+
+/**
+@brief Two-dimensional uniform grid spatial hash
+
+Alternative to the sorted broad phase in @ref ShapeGroup for 2D scenes with
+many similarly-sized entities, such as particles, flocking agents or sprites.
+Entries are identified by small consecutive IDs and have axis-aligned bounds,
+each entry is stored in all grid cells its bounds overlap. Only occupied cells
+are stored, so the grid is unbounded.
+
+The entries can be either set directly, for example from particle positions:
+@code
+Shapes::SpatialHash2D hash{2.0f};
+for(std::size_t i = 0; i != particles.size(); ++i)
+    hash.set(i, particles[i].position);
+
+// Neighbors for flocking
+for(UnsignedInt neighbor: hash.queryRadius(particles[0].position, 4.0f))
+    // ...
+@endcode
+
+Or synchronized with a @ref ShapeGroup2D, in which case the IDs are indices of
+the shapes in the group. The synchronization in @ref update() touches only
+shapes that were marked as dirty since the last time, see
+@ref AbstractShape::dirtyCount().
+@code
+Shapes::ShapeGroup2D shapes;
+Shapes::SpatialHash2D hash{1.0f};
+
+// Each frame
+Shapes::AbstractShape2D* hit = hash.firstCollision(shapes, player);
+@endcode
+
+## Cell size
+
+Queries are fastest when the cell size is close to the typical size of the
+entries and to the typical query radius. Much smaller cells make each entry
+span many cells, much larger cells make the queries test many entries. Entries
+with infinite bounds or bounds spanning more than 64 cells are kept in a
+separate list tested in every query. The cell size can be changed any time
+using @ref setCellSize(), which rebuilds the grid.
+@see @ref ShapeGroup::shapesInRegion()
+*/
+class MAGNUM_SHAPES_EXPORT SpatialHash2D {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Expects that @p cellSize is positive.
+         */
+        explicit SpatialHash2D(Float cellSize);
+
+        /** @brief Cell size */
+        Float cellSize() const { return _cellSize; }
+
+        /**
+         * @brief Set cell size
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p cellSize is positive. Rebuilds the grid.
+         */
+        SpatialHash2D& setCellSize(Float cellSize);
+
+        /** @brief Count of entries */
+        std::size_t size() const { return _size; }
+
+        /** @brief Whether there are no entries */
+        bool isEmpty() const { return !_size; }
+
+        /** @brief Whether there's an entry with given ID */
+        bool contains(UnsignedInt id) const {
+            return id < _entries.size() && _entries[id].used;
+        }
+
+        /**
+         * @brief Bounds of given entry
+         *
+         * Expects that the entry exists.
+         */
+        Range2D bounds(UnsignedInt id) const;
+
+        /**
+         * @brief Add or update an entry
+         * @return Reference to self (for method chaining)
+         *
+         * If the entry stays in the same cells, only its bounds are updated,
+         * so this is cheap for entries moving only a little. Memory used is
+         * proportional to the largest ID.
+         */
+        SpatialHash2D& set(UnsignedInt id, const Range2D& bounds);
+
+        /**
+         * @brief Add or update a point entry
+         * @return Reference to self (for method chaining)
+         *
+         * Equivalent to calling @ref set(UnsignedInt, const Range2D&) with
+         * zero-size bounds at @p point.
+         */
+        SpatialHash2D& set(UnsignedInt id, const Vector2& point) {
+            return set(id, Range2D{point, point});
+        }
+
+        /**
+         * @brief Remove an entry
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that the entry exists.
+         */
+        SpatialHash2D& remove(UnsignedInt id);
+
+        /**
+         * @brief Remove all entries
+         * @return Reference to self (for method chaining)
+         */
+        SpatialHash2D& clear();
+
+        /**
+         * @brief Synchronize with a shape group
+         *
+         * Calls @ref ShapeGroup::setClean() and updates bounds of shapes that
+         * were added or marked as dirty since the last call, entries of
+         * shapes no longer in the group are removed. Entry IDs are then
+         * indices of the shapes in the group. Don't mix with
+         * @ref set(UnsignedInt, const Range2D&) and @ref remove().
+         */
+        void update(ShapeGroup2D& group);
+
+        /**
+         * @brief Entries in given region
+         *
+         * Returns IDs of all entries with bounds intersecting the region,
+         * sorted.
+         */
+        std::vector<UnsignedInt> query(const Range2D& region) const;
+
+        /**
+         * @brief Entries in given radius
+         *
+         * Returns IDs of all entries with bounds closer to @p center than
+         * @p radius, sorted.
+         */
+        std::vector<UnsignedInt> queryRadius(const Vector2& center, Float radius) const;
+
+        /**
+         * @brief Nearest entries
+         * @param point         Query point
+         * @param count         Max count of entries to return
+         * @param maxDistance   Max distance of the entries
+         *
+         * Returns IDs of at most @p count entries with bounds nearest to
+         * @p point, in order of increasing distance. Entries at the same
+         * distance are ordered by ID. The cells are searched in rings around
+         * @p point, so the query is fastest when the entries are found close
+         * to it.
+         */
+        std::vector<UnsignedInt> nearest(const Vector2& point, std::size_t count, Float maxDistance = Constants::inf()) const;
+
+        /**
+         * @brief Pairs of entries with intersecting bounds
+         *
+         * Returns each pair only once, with smaller ID first, sorted.
+         */
+        std::vector<std::pair<UnsignedInt, UnsignedInt>> pairs() const;
+
+        /**
+         * @brief First collision of given shape with other shapes in the group
+         *
+         * Calls @ref update() and then does the same as
+         * @ref ShapeGroup::firstCollision(), using this hash for the broad
+         * phase.
+         */
+        AbstractShape2D* firstCollision(ShapeGroup2D& group, const AbstractShape2D& shape);
+
+        /**
+         * @brief All colliding pairs of shapes in the group
+         *
+         * Calls @ref update() and then does the same as
+         * @ref ShapeGroup::collisionPairs(), using this hash for the broad
+         * phase.
+         */
+        std::vector<std::pair<AbstractShape2D*, AbstractShape2D*>> collisionPairs(ShapeGroup2D& group);
+
+    private:
+        struct Entry {
+            Range2D bounds;
+            Vector2i cellMin, cellMax;
+            /* Shape and its dirty count for update() */
+            const AbstractShape2D* shape;
+            UnsignedInt dirtyCount;
+            bool used, oversized;
+        };
+
+        Vector2i MAGNUM_SHAPES_LOCAL cell(const Vector2& position) const;
+        void MAGNUM_SHAPES_LOCAL insert(UnsignedInt id);
+        void MAGNUM_SHAPES_LOCAL erase(UnsignedInt id);
+        template<class F> void MAGNUM_SHAPES_LOCAL forEachCell(const Vector2i& min, const Vector2i& max, F f) const;
+
+        Float _cellSize;
+        std::size_t _size;
+        std::vector<Entry> _entries;
+        /* Occupied cells, keyed by packed cell coordinates */
+        std::unordered_map<std::uint64_t, std::vector<UnsignedInt>> _cells;
+        /* Entries not stored in the cells, sorted */
+        std::vector<UnsignedInt> _oversized;
+        /* Cell range that was ever occupied since the last rebuild */
+        Vector2i _occupiedMin, _occupiedMax;
+};
+
+}}
+
+#endif
@@ -0,0 +1,413 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Sweep.h"
+
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shapes/AxisAlignedBox.h"
+#include "Magnum/Shapes/Box.h"
+#include "Magnum/Shapes/Capsule.h"
+#include "Magnum/Shapes/Cylinder.h"
+#include "Magnum/Shapes/LineSegment.h"
+#include "Magnum/Shapes/Plane.h"
+#include "Magnum/Shapes/Point.h"
+#include "Magnum/Shapes/Sphere.h"
+#include "Magnum/Shapes/shapeImplementation.h"
+#include "Magnum/Shapes/Implementation/Raycast.h"
+
+namespace Magnum { namespace Shapes {
+
+/*
+Sweep implementation notes:
+
+Point of the moving shape (sphere center or first capsule point) moving along
+the displacement is a ray with t in range [0, 1]. The moving shape touches
+the static one exactly when the ray is inside Minkowski sum of the static
+shape and the moving shape mirrored around the ray origin. For a sphere that
+means the static shape expanded by the radius, for a capsule additionally
+swept along the mirrored capsule axis. Both shapes are convex, so the sum is
+convex as well and it's enough to take hull of the ray intervals of parts
+covering it.
+*/
+
+namespace {
+
+using Implementation::Interval;
+
+/* Accumulates convex hull of ray intervals of the parts */
+struct Hull {
+    Hull(): hit{}, interval{Constants::inf(), -Constants::inf()} {}
+
+    void add(bool partHit, const Interval& part) {
+        if(!partHit) return;
+        hit = true;
+        interval = {Math::min(interval.first, part.first), Math::max(interval.second, part.second)};
+    }
+
+    bool hit;
+    Interval interval;
+};
+
+Float timeOfImpact(const bool hit, const Interval& interval) {
+    if(!hit || interval.second < 0.0f || interval.first > 1.0f)
+        return Constants::inf();
+    return Math::max(interval.first, 0.0f);
+}
+
+/* Interior of parallelogram given by point and two edges, in 3D thickened by
+   radius along its normal */
+void parallelogramInterior(const Vector2& corner, const Vector2& a, const Vector2& b, Float, const Vector2& origin, const Vector2& direction, Hull& hull) {
+    Interval part;
+    hull.add(Implementation::parallelepipedInterval<2>(corner, Matrix2x2{a, b}, origin, direction, part), part);
+}
+
+void parallelogramInterior(const Vector3& corner, const Vector3& a, const Vector3& b, const Float radius, const Vector3& origin, const Vector3& direction, Hull& hull) {
+    const Vector3 normal = Math::cross(a, b);
+    if(normal.dot() == 0.0f) return;
+
+    const Vector3 thickness = normal.normalized()*radius;
+    Interval part;
+    hull.add(Implementation::parallelepipedInterval<3>(corner - thickness, Matrix3x3{a, b, thickness*2.0f}, origin, direction, part), part);
+}
+
+/* Points closer than radius to parallelogram given by point and edges `edge`
+   and `-sweep`. Without the sweep it's just a capsule. */
+template<UnsignedInt dimensions> void roundedParallelogram(const VectorTypeFor<dimensions, Float>& point, const VectorTypeFor<dimensions, Float>& edge, const VectorTypeFor<dimensions, Float>& sweep, const Float radius, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction, Hull& hull) {
+    Interval part;
+    hull.add(Implementation::capsuleInterval<dimensions>(point, point + edge, radius, origin, direction, part), part);
+    if(sweep.dot() == 0.0f) return;
+
+    hull.add(Implementation::capsuleInterval<dimensions>(point - sweep, point + edge - sweep, radius, origin, direction, part), part);
+    hull.add(Implementation::capsuleInterval<dimensions>(point, point - sweep, radius, origin, direction, part), part);
+    hull.add(Implementation::capsuleInterval<dimensions>(point + edge, point + edge - sweep, radius, origin, direction, part), part);
+    parallelogramInterior(point - sweep, edge, sweep, radius, origin, direction, hull);
+}
+
+/* Box expanded by radius on all sides, swept along `-sweep`. It's a union of
+   boxes expanded along one axis and rounded corners (2D) or edges (3D), all
+   of them swept. */
+void roundedBoxCorners(const Vector2& min, const Vector2& max, const Float radius, const Vector2& sweep, const Vector2& origin, const Vector2& direction, Hull& hull) {
+    for(const Vector2& corner: {min, Vector2{max.x(), min.y()}, Vector2{min.x(), max.y()}, max})
+        roundedParallelogram<2>(corner, {}, sweep, radius, origin, direction, hull);
+}
+
+void roundedBoxCorners(const Vector3& min, const Vector3& max, const Float radius, const Vector3& sweep, const Vector3& origin, const Vector3& direction, Hull& hull) {
+    for(UnsignedInt axis = 0; axis != 3; ++axis) {
+        Vector3 edge;
+        edge[axis] = max[axis] - min[axis];
+        const UnsignedInt u = (axis + 1) % 3, v = (axis + 2) % 3;
+        for(UnsignedInt i = 0; i != 4; ++i) {
+            Vector3 point = min;
+            if(i & 1) point[u] = max[u];
+            if(i & 2) point[v] = max[v];
+            roundedParallelogram<3>(point, edge, sweep, radius, origin, direction, hull);
+        }
+    }
+}
+
+template<UnsignedInt dimensions> Float sweepRoundedBox(const VectorTypeFor<dimensions, Float>& min, const VectorTypeFor<dimensions, Float>& max, const Float radius, const VectorTypeFor<dimensions, Float>& sweep, const VectorTypeFor<dimensions, Float>& origin, const VectorTypeFor<dimensions, Float>& direction) {
+    Hull hull;
+    Interval part;
+    for(UnsignedInt axis = 0; axis != dimensions; ++axis) {
+        VectorTypeFor<dimensions, Float> boxMin = min, boxMax = max;
+        boxMin[axis] -= radius;
+        boxMax[axis] += radius;
+
+        /* Box at both ends of the sweep */
+        hull.add(Implementation::boxInterval<dimensions>(boxMin, boxMax, origin, direction, part), part);
+        if(sweep.dot() == 0.0f) continue;
+        hull.add(Implementation::boxInterval<dimensions>(boxMin - sweep, boxMax - sweep, origin, direction, part), part);
+
+        /* Faces swept along the sweep, only the ones facing the sweep
+           direction are needed */
+        for(UnsignedInt face = 0; face != dimensions; ++face) {
+            if(sweep[face] == 0.0f) continue;
+
+            VectorTypeFor<dimensions, Float> corner = boxMin;
+            if(sweep[face] < 0.0f) corner[face] = boxMax[face];
+            Math::Matrix<dimensions, Float> edges;
+            for(UnsignedInt i = 0; i != dimensions; ++i)
+                edges[i][i] = boxMax[i] - boxMin[i];
+            edges[face] = sweep;
+            hull.add(Implementation::parallelepipedInterval<dimensions>(corner - sweep, edges, origin, direction, part), part);
+        }
+    }
+
+    roundedBoxCorners(min, max, radius, sweep, origin, direction, hull);
+    return timeOfImpact(hull.hit, hull.interval);
+}
+
+/* Box space, the box is then from -size to +size */
+template<UnsignedInt dimensions> struct BoxSpace {
+    explicit BoxSpace(const MatrixTypeFor<dimensions, Float>& transformation): translation{transformation.translation()} {
+        const Math::Matrix<dimensions, Float> rotationScaling = transformation.rotationScaling();
+        for(UnsignedInt i = 0; i != dimensions; ++i) {
+            const VectorTypeFor<dimensions, Float> axis{rotationScaling[i]};
+            size[i] = axis.length();
+            rotation[i] = axis/size[i];
+        }
+        rotation = rotation.transposed();
+    }
+
+    VectorTypeFor<dimensions, Float> point(const VectorTypeFor<dimensions, Float>& point) const {
+        return vector(point - translation);
+    }
+
+    VectorTypeFor<dimensions, Float> vector(const VectorTypeFor<dimensions, Float>& vector) const {
+        return VectorTypeFor<dimensions, Float>{rotation*vector};
+    }
+
+    VectorTypeFor<dimensions, Float> translation, size;
+    Math::Matrix<dimensions, Float> rotation;
+};
+
+}
+
+template<UnsignedInt dimensions> Float sweep(const Sphere<dimensions>& sphere, const VectorTypeFor<dimensions, Float>& displacement, const Point<dimensions>& other) {
+    Interval interval;
+    const bool hit = Implementation::sphereInterval<dimensions>(other.position(), sphere.radius(), sphere.position(), displacement, interval);
+    return timeOfImpact(hit, interval);
+}
+
+template<UnsignedInt dimensions> Float sweep(const Sphere<dimensions>& sphere, const VectorTypeFor<dimensions, Float>& displacement, const Line<dimensions>& other) {
+    Interval interval;
+    const bool hit = Implementation::cylinderInterval<dimensions>(other.a(), (other.b() - other.a()).normalized(), sphere.radius(), sphere.position(), displacement, interval);
+    return timeOfImpact(hit, interval);
+}
+
+template<UnsignedInt dimensions> Float sweep(const Sphere<dimensions>& sphere, const VectorTypeFor<dimensions, Float>& displacement, const LineSegment<dimensions>& other) {
+    Interval interval;
+    const bool hit = Implementation::capsuleInterval<dimensions>(other.a(), other.b(), sphere.radius(), sphere.position(), displacement, interval);
+    return timeOfImpact(hit, interval);
+}
+
+template<UnsignedInt dimensions> Float sweep(const Sphere<dimensions>& sphere, const VectorTypeFor<dimensions, Float>& displacement, const Sphere<dimensions>& other) {
+    Interval interval;
+    const bool hit = Implementation::sphereInterval<dimensions>(other.position(), sphere.radius() + other.radius(), sphere.position(), displacement, interval);
+    return timeOfImpact(hit, interval);
+}
+
+template<UnsignedInt dimensions> Float sweep(const Sphere<dimensions>& sphere, const VectorTypeFor<dimensions, Float>& displacement, const Cylinder<dimensions>& other) {
+    Interval interval;
+    const bool hit = Implementation::cylinderInterval<dimensions>(other.a(), (other.b() - other.a()).normalized(), sphere.radius() + other.radius(), sphere.position(), displacement, interval);
+    return timeOfImpact(hit, interval);
+}
+
+template<UnsignedInt dimensions> Float sweep(const Sphere<dimensions>& sphere, const VectorTypeFor<dimensions, Float>& displacement, const Capsule<dimensions>& other) {
+    Interval interval;
+    const bool hit = Implementation::capsuleInterval<dimensions>(other.a(), other.b(), sphere.radius() + other.radius(), sphere.position(), displacement, interval);
+    return timeOfImpact(hit, interval);
+}
+
+template<UnsignedInt dimensions> Float sweep(const Sphere<dimensions>& sphere, const VectorTypeFor<dimensions, Float>& displacement, const AxisAlignedBox<dimensions>& other) {
+    return sweepRoundedBox<dimensions>(Math::min(other.min(), other.max()), Math::max(other.min(), other.max()), sphere.radius(), {}, sphere.position(), displacement);
+}
+
+template<UnsignedInt dimensions> Float sweep(const Sphere<dimensions>& sphere, const VectorTypeFor<dimensions, Float>& displacement, const Box<dimensions>& other) {
+    const BoxSpace<dimensions> space{other.transformation()};
+    return sweepRoundedBox<dimensions>(-space.size, space.size, sphere.radius(), {}, space.point(sphere.position()), space.vector(displacement));
+}
+
+Float sweep(const Sphere3D& sphere, const Vector3& displacement, const Plane& other) {
+    return sweep(Capsule3D{sphere.position(), sphere.position(), sphere.radius()}, displacement, other);
+}
+
+template<UnsignedInt dimensions> Float sweep(const Capsule<dimensions>& capsule, const VectorTypeFor<dimensions, Float>& displacement, const Point<dimensions>& other) {
+    /* Point moving in the opposite direction */
+    Interval interval;
+    const bool hit = Implementation::capsuleInterval<dimensions>(capsule.a(), capsule.b(), capsule.radius(), other.position(), -displacement, interval);
+    return timeOfImpact(hit, interval);
+}
+
+template<UnsignedInt dimensions> Float sweep(const Capsule<dimensions>& capsule, const VectorTypeFor<dimensions, Float>& displacement, const LineSegment<dimensions>& other) {
+    Hull hull;
+    roundedParallelogram<dimensions>(other.a(), other.b() - other.a(), capsule.b() - capsule.a(), capsule.radius(), capsule.a(), displacement, hull);
+    return timeOfImpact(hull.hit, hull.interval);
+}
+
+template<UnsignedInt dimensions> Float sweep(const Capsule<dimensions>& capsule, const VectorTypeFor<dimensions, Float>& displacement, const Sphere<dimensions>& other) {
+    /* Sphere center moving in the opposite direction */
+    Interval interval;
+    const bool hit = Implementation::capsuleInterval<dimensions>(capsule.a(), capsule.b(), capsule.radius() + other.radius(), other.position(), -displacement, interval);
+    return timeOfImpact(hit, interval);
+}
+
+template<UnsignedInt dimensions> Float sweep(const Capsule<dimensions>& capsule, const VectorTypeFor<dimensions, Float>& displacement, const Capsule<dimensions>& other) {
+    Hull hull;
+    roundedParallelogram<dimensions>(other.a(), other.b() - other.a(), capsule.b() - capsule.a(), capsule.radius() + other.radius(), capsule.a(), displacement, hull);
+    return timeOfImpact(hull.hit, hull.interval);
+}
+
+template<UnsignedInt dimensions> Float sweep(const Capsule<dimensions>& capsule, const VectorTypeFor<dimensions, Float>& displacement, const AxisAlignedBox<dimensions>& other) {
+    return sweepRoundedBox<dimensions>(Math::min(other.min(), other.max()), Math::max(other.min(), other.max()), capsule.radius(), capsule.b() - capsule.a(), capsule.a(), displacement);
+}
+
+template<UnsignedInt dimensions> Float sweep(const Capsule<dimensions>& capsule, const VectorTypeFor<dimensions, Float>& displacement, const Box<dimensions>& other) {
+    const BoxSpace<dimensions> space{other.transformation()};
+    return sweepRoundedBox<dimensions>(-space.size, space.size, capsule.radius(), space.vector(capsule.b() - capsule.a()), space.point(capsule.a()), space.vector(displacement));
+}
+
+Float sweep(const Capsule3D& capsule, const Vector3& displacement, const Plane& other) {
+    /* Signed distance of the first point from the plane. The capsule touches
+       the plane if the range of distances of the whole capsule includes
+       zero. */
+    const Vector3 normal = other.normal().normalized();
+    const Float axis = Math::dot(normal, capsule.b() - capsule.a());
+    Interval interval;
+    const bool hit = Implementation::slabInterval(Math::dot(normal, capsule.a() - other.position()), Math::dot(normal, displacement), Math::min(0.0f, -axis) - capsule.radius(), Math::max(0.0f, -axis) + capsule.radius(), interval);
+    return timeOfImpact(hit, interval);
+}
+
+namespace Implementation {
+
+template<> Float sweep(const Shapes::Sphere2D& sphere, const Vector2& displacement, const AbstractShape<2>& other) {
+    switch(other.type()) {
+        #define _c(type, class) \
+            case ShapeDimensionTraits<2>::Type::type: \
+                return Shapes::sweep(sphere, displacement, static_cast<const Shape<class>&>(other).shape);
+        _c(Point, Point2D)
+        _c(Line, Line2D)
+        _c(LineSegment, LineSegment2D)
+        _c(Sphere, Sphere2D)
+        _c(Cylinder, Cylinder2D)
+        _c(Capsule, Capsule2D)
+        _c(AxisAlignedBox, AxisAlignedBox2D)
+        _c(Box, Box2D)
+        #undef _c
+
+        case ShapeDimensionTraits<2>::Type::InvertedSphere:
+        case ShapeDimensionTraits<2>::Type::Composition:
+            break;
+    }
+
+    return Constants::inf();
+}
+
+template<> Float sweep(const Shapes::Sphere3D& sphere, const Vector3& displacement, const AbstractShape<3>& other) {
+    switch(other.type()) {
+        #define _c(type, class) \
+            case ShapeDimensionTraits<3>::Type::type: \
+                return Shapes::sweep(sphere, displacement, static_cast<const Shape<class>&>(other).shape);
+        _c(Point, Point3D)
+        _c(Line, Line3D)
+        _c(LineSegment, LineSegment3D)
+        _c(Sphere, Sphere3D)
+        _c(Cylinder, Cylinder3D)
+        _c(Capsule, Capsule3D)
+        _c(AxisAlignedBox, AxisAlignedBox3D)
+        _c(Box, Box3D)
+        _c(Plane, Plane)
+        #undef _c
+
+        case ShapeDimensionTraits<3>::Type::InvertedSphere:
+        case ShapeDimensionTraits<3>::Type::Composition:
+            break;
+    }
+
+    return Constants::inf();
+}
+
+template<> Float sweep(const Shapes::Capsule2D& capsule, const Vector2& displacement, const AbstractShape<2>& other) {
+    switch(other.type()) {
+        #define _c(type, class) \
+            case ShapeDimensionTraits<2>::Type::type: \
+                return Shapes::sweep(capsule, displacement, static_cast<const Shape<class>&>(other).shape);
+        _c(Point, Point2D)
+        _c(LineSegment, LineSegment2D)
+        _c(Sphere, Sphere2D)
+        _c(Capsule, Capsule2D)
+        _c(AxisAlignedBox, AxisAlignedBox2D)
+        _c(Box, Box2D)
+        #undef _c
+
+        case ShapeDimensionTraits<2>::Type::Line:
+        case ShapeDimensionTraits<2>::Type::InvertedSphere:
+        case ShapeDimensionTraits<2>::Type::Cylinder:
+        case ShapeDimensionTraits<2>::Type::Composition:
+            break;
+    }
+
+    return Constants::inf();
+}
+
+template<> Float sweep(const Shapes::Capsule3D& capsule, const Vector3& displacement, const AbstractShape<3>& other) {
+    switch(other.type()) {
+        #define _c(type, class) \
+            case ShapeDimensionTraits<3>::Type::type: \
+                return Shapes::sweep(capsule, displacement, static_cast<const Shape<class>&>(other).shape);
+        _c(Point, Point3D)
+        _c(LineSegment, LineSegment3D)
+        _c(Sphere, Sphere3D)
+        _c(Capsule, Capsule3D)
+        _c(AxisAlignedBox, AxisAlignedBox3D)
+        _c(Box, Box3D)
+        _c(Plane, Plane)
+        #undef _c
+
+        case ShapeDimensionTraits<3>::Type::Line:
+        case ShapeDimensionTraits<3>::Type::InvertedSphere:
+        case ShapeDimensionTraits<3>::Type::Cylinder:
+        case ShapeDimensionTraits<3>::Type::Composition:
+            break;
+    }
+
+    return Constants::inf();
+}
+
+}
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+template MAGNUM_SHAPES_EXPORT Float sweep<2>(const Sphere<2>&, const Math::Vector2<Float>&, const Point<2>&);
+template MAGNUM_SHAPES_EXPORT Float sweep<3>(const Sphere<3>&, const Math::Vector3<Float>&, const Point<3>&);
+template MAGNUM_SHAPES_EXPORT Float sweep<2>(const Sphere<2>&, const Math::Vector2<Float>&, const Line<2>&);
+template MAGNUM_SHAPES_EXPORT Float sweep<3>(const Sphere<3>&, const Math::Vector3<Float>&, const Line<3>&);
+template MAGNUM_SHAPES_EXPORT Float sweep<2>(const Sphere<2>&, const Math::Vector2<Float>&, const LineSegment<2>&);
+template MAGNUM_SHAPES_EXPORT Float sweep<3>(const Sphere<3>&, const Math::Vector3<Float>&, const LineSegment<3>&);
+template MAGNUM_SHAPES_EXPORT Float sweep<2>(const Sphere<2>&, const Math::Vector2<Float>&, const Sphere<2>&);
+template MAGNUM_SHAPES_EXPORT Float sweep<3>(const Sphere<3>&, const Math::Vector3<Float>&, const Sphere<3>&);
+template MAGNUM_SHAPES_EXPORT Float sweep<2>(const Sphere<2>&, const Math::Vector2<Float>&, const Cylinder<2>&);
+template MAGNUM_SHAPES_EXPORT Float sweep<3>(const Sphere<3>&, const Math::Vector3<Float>&, const Cylinder<3>&);
+template MAGNUM_SHAPES_EXPORT Float sweep<2>(const Sphere<2>&, const Math::Vector2<Float>&, const Capsule<2>&);
+template MAGNUM_SHAPES_EXPORT Float sweep<3>(const Sphere<3>&, const Math::Vector3<Float>&, const Capsule<3>&);
+template MAGNUM_SHAPES_EXPORT Float sweep<2>(const Sphere<2>&, const Math::Vector2<Float>&, const AxisAlignedBox<2>&);
+template MAGNUM_SHAPES_EXPORT Float sweep<3>(const Sphere<3>&, const Math::Vector3<Float>&, const AxisAlignedBox<3>&);
+template MAGNUM_SHAPES_EXPORT Float sweep<2>(const Sphere<2>&, const Math::Vector2<Float>&, const Box<2>&);
+template MAGNUM_SHAPES_EXPORT Float sweep<3>(const Sphere<3>&, const Math::Vector3<Float>&, const Box<3>&);
+template MAGNUM_SHAPES_EXPORT Float sweep<2>(const Capsule<2>&, const Math::Vector2<Float>&, const Point<2>&);
+template MAGNUM_SHAPES_EXPORT Float sweep<3>(const Capsule<3>&, const Math::Vector3<Float>&, const Point<3>&);
+template MAGNUM_SHAPES_EXPORT Float sweep<2>(const Capsule<2>&, const Math::Vector2<Float>&, const LineSegment<2>&);
+template MAGNUM_SHAPES_EXPORT Float sweep<3>(const Capsule<3>&, const Math::Vector3<Float>&, const LineSegment<3>&);
+template MAGNUM_SHAPES_EXPORT Float sweep<2>(const Capsule<2>&, const Math::Vector2<Float>&, const Sphere<2>&);
+template MAGNUM_SHAPES_EXPORT Float sweep<3>(const Capsule<3>&, const Math::Vector3<Float>&, const Sphere<3>&);
+template MAGNUM_SHAPES_EXPORT Float sweep<2>(const Capsule<2>&, const Math::Vector2<Float>&, const Capsule<2>&);
+template MAGNUM_SHAPES_EXPORT Float sweep<3>(const Capsule<3>&, const Math::Vector3<Float>&, const Capsule<3>&);
+template MAGNUM_SHAPES_EXPORT Float sweep<2>(const Capsule<2>&, const Math::Vector2<Float>&, const AxisAlignedBox<2>&);
+template MAGNUM_SHAPES_EXPORT Float sweep<3>(const Capsule<3>&, const Math::Vector3<Float>&, const AxisAlignedBox<3>&);
+template MAGNUM_SHAPES_EXPORT Float sweep<2>(const Capsule<2>&, const Math::Vector2<Float>&, const Box<2>&);
+template MAGNUM_SHAPES_EXPORT Float sweep<3>(const Capsule<3>&, const Math::Vector3<Float>&, const Box<3>&);
+#endif
+
+}}
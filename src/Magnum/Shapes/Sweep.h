@@ -0,0 +1,113 @@
+#ifndef Magnum_Shapes_Sweep_h
+#define Magnum_Shapes_Sweep_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Shapes::sweep()
+ */
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Magnum.h"
+#include "Magnum/Shapes/Shapes.h"
+#include "Magnum/Shapes/visibility.h"
+
+namespace Magnum { namespace Shapes {
+
+/**
+@brief Time of impact of moving sphere with a point
+@param sphere       Sphere at the beginning of the motion
+@param displacement Translation of the sphere during the motion
+@param other        Static shape
+
+Returns the first time @f$ t \in [ 0 ; 1 ] @f$ at which the sphere translated
+by @f$ t \cdot displacement @f$ touches @p other, or infinity if they don't
+touch during the whole motion. If the shapes collide already at the beginning,
+returns `0`. Unlike testing collision only at the end of each simulation step,
+thin or small shapes can't be skipped this way however long the step is.
+
+The test is exact and is done as a ray cast against @p other expanded by the
+moving shape. Boxes are expected to have no skew. See also
+@ref ShapeGroup::sweep() which uses this for all shapes in a group.
+*/
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT Float sweep(const Sphere<dimensions>& sphere, const VectorTypeFor<dimensions, Float>& displacement, const Point<dimensions>& other);
+
+/** @overload */
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT Float sweep(const Sphere<dimensions>& sphere, const VectorTypeFor<dimensions, Float>& displacement, const Line<dimensions>& other);
+
+/** @overload */
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT Float sweep(const Sphere<dimensions>& sphere, const VectorTypeFor<dimensions, Float>& displacement, const LineSegment<dimensions>& other);
+
+/** @overload */
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT Float sweep(const Sphere<dimensions>& sphere, const VectorTypeFor<dimensions, Float>& displacement, const Sphere<dimensions>& other);
+
+/** @overload */
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT Float sweep(const Sphere<dimensions>& sphere, const VectorTypeFor<dimensions, Float>& displacement, const Cylinder<dimensions>& other);
+
+/** @overload */
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT Float sweep(const Sphere<dimensions>& sphere, const VectorTypeFor<dimensions, Float>& displacement, const Capsule<dimensions>& other);
+
+/** @overload */
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT Float sweep(const Sphere<dimensions>& sphere, const VectorTypeFor<dimensions, Float>& displacement, const AxisAlignedBox<dimensions>& other);
+
+/** @overload */
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT Float sweep(const Sphere<dimensions>& sphere, const VectorTypeFor<dimensions, Float>& displacement, const Box<dimensions>& other);
+
+/** @overload */
+MAGNUM_SHAPES_EXPORT Float sweep(const Sphere3D& sphere, const Vector3& displacement, const Plane& other);
+
+/**
+@brief Time of impact of moving capsule with a point
+@param capsule      Capsule at the beginning of the motion
+@param displacement Translation of the capsule during the motion
+@param other        Static shape
+
+Same as @ref sweep(const Sphere<dimensions>&, const VectorTypeFor<dimensions, Float>&, const Point<dimensions>&),
+but for a capsule. The capsule is only translated, not rotated during the
+motion.
+*/
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT Float sweep(const Capsule<dimensions>& capsule, const VectorTypeFor<dimensions, Float>& displacement, const Point<dimensions>& other);
+
+/** @overload */
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT Float sweep(const Capsule<dimensions>& capsule, const VectorTypeFor<dimensions, Float>& displacement, const LineSegment<dimensions>& other);
+
+/** @overload */
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT Float sweep(const Capsule<dimensions>& capsule, const VectorTypeFor<dimensions, Float>& displacement, const Sphere<dimensions>& other);
+
+/** @overload */
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT Float sweep(const Capsule<dimensions>& capsule, const VectorTypeFor<dimensions, Float>& displacement, const Capsule<dimensions>& other);
+
+/** @overload */
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT Float sweep(const Capsule<dimensions>& capsule, const VectorTypeFor<dimensions, Float>& displacement, const AxisAlignedBox<dimensions>& other);
+
+/** @overload */
+template<UnsignedInt dimensions> MAGNUM_SHAPES_EXPORT Float sweep(const Capsule<dimensions>& capsule, const VectorTypeFor<dimensions, Float>& displacement, const Box<dimensions>& other);
+
+/** @overload */
+MAGNUM_SHAPES_EXPORT Float sweep(const Capsule3D& capsule, const Vector3& displacement, const Plane& other);
+
+}}
+
+#endif
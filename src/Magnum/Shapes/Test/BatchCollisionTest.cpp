@@ -0,0 +1,237 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Shapes/BatchCollision.h"
+
+namespace Magnum { namespace Shapes { namespace Test {
+
+struct BatchCollisionTest: TestSuite::Tester {
+    explicit BatchCollisionTest();
+
+    void batch();
+
+    template<UnsignedInt dimensions> void spherePoint();
+    template<UnsignedInt dimensions> void sphereSphere();
+    template<UnsignedInt dimensions> void axisAlignedBoxPoint();
+    template<UnsignedInt dimensions> void capsulePoint();
+    template<UnsignedInt dimensions> void capsuleSphere();
+    void broadcast();
+};
+
+BatchCollisionTest::BatchCollisionTest() {
+    addTests({&BatchCollisionTest::batch,
+
+              &BatchCollisionTest::spherePoint<2>,
+              &BatchCollisionTest::spherePoint<3>,
+              &BatchCollisionTest::sphereSphere<2>,
+              &BatchCollisionTest::sphereSphere<3>,
+              &BatchCollisionTest::axisAlignedBoxPoint<2>,
+              &BatchCollisionTest::axisAlignedBoxPoint<3>,
+              &BatchCollisionTest::capsulePoint<2>,
+              &BatchCollisionTest::capsulePoint<3>,
+              &BatchCollisionTest::capsuleSphere<2>,
+              &BatchCollisionTest::capsuleSphere<3>,
+              &BatchCollisionTest::broadcast});
+}
+
+namespace {
+    /* Not a multiple of any SIMD width, so the scalar remainder is tested
+       too */
+    constexpr std::size_t Count = 37;
+
+    /* Deterministic pseudo-random values in [-2, 2], spread enough for both
+       colliding and non-colliding pairs */
+    Float value(std::size_t i, std::size_t salt) {
+        UnsignedInt hash = UnsignedInt(i*2654435761u) ^ UnsignedInt(salt*40503u);
+        hash = (hash ^ (hash >> 15))*2246822519u;
+        hash ^= hash >> 13;
+        return Float(hash % 401)/100.0f - 2.0f;
+    }
+
+    template<UnsignedInt dimensions> VectorTypeFor<dimensions, Float> vector(std::size_t i, std::size_t salt) {
+        VectorTypeFor<dimensions, Float> out;
+        for(UnsignedInt j = 0; j != dimensions; ++j)
+            out[j] = value(i, salt*dimensions + j);
+        return out;
+    }
+
+    template<UnsignedInt dimensions> PointBatch<dimensions> points() {
+        PointBatch<dimensions> out;
+        for(std::size_t i = 0; i != Count; ++i)
+            out.add(Point<dimensions>{vector<dimensions>(i, 1)*0.5f});
+        return out;
+    }
+
+    template<UnsignedInt dimensions> SphereBatch<dimensions> spheres(std::size_t salt) {
+        SphereBatch<dimensions> out;
+        for(std::size_t i = 0; i != Count; ++i)
+            out.add(Sphere<dimensions>{vector<dimensions>(i, salt), 0.25f + (i % 5)*0.2f});
+        return out;
+    }
+
+    template<class A, class B> std::size_t countCollisions(const A& a, const B& b, bool* results) {
+        std::size_t collisions = 0;
+        for(std::size_t i = 0; i != b.size(); ++i) {
+            if(results[i] != (a[a.size() == 1 ? 0 : i] % b[i])) return ~std::size_t{};
+            collisions += results[i];
+        }
+        return collisions;
+    }
+}
+
+void BatchCollisionTest::batch() {
+    SphereBatch3D a;
+    a.reserve(2);
+    a.add(Sphere3D{{1.0f, 2.0f, 3.0f}, 0.5f})
+     .add(Sphere3D{{-1.0f, 0.0f, 4.0f}, 2.0f});
+
+    CORRADE_COMPARE(a.size(), 2);
+    CORRADE_COMPARE(a.positions(0)[1], -1.0f);
+    CORRADE_COMPARE(a.positions(2)[0], 3.0f);
+    CORRADE_COMPARE(a.radii()[1], 2.0f);
+    CORRADE_COMPARE(a[1].position(), (Vector3{-1.0f, 0.0f, 4.0f}));
+    CORRADE_COMPARE(a[0].radius(), 0.5f);
+
+    const Capsule2D capsules[]{
+        {{1.0f, 2.0f}, {3.0f, 4.0f}, 0.5f},
+        {{-1.0f, -2.0f}, {-3.0f, -4.0f}, 1.5f}};
+    const CapsuleBatch2D b{capsules};
+    CORRADE_COMPARE(b.size(), 2);
+    CORRADE_COMPARE(b.a(0)[1], -1.0f);
+    CORRADE_COMPARE(b.b(1)[1], -4.0f);
+    CORRADE_COMPARE(b.radii()[1], 1.5f);
+    CORRADE_COMPARE(b[1].b(), (Vector2{-3.0f, -4.0f}));
+
+    a.clear();
+    CORRADE_COMPARE(a.size(), 0);
+}
+
+template<UnsignedInt dimensions> void BatchCollisionTest::spherePoint() {
+    setTestCaseName(dimensions == 2 ? "spherePoint<2>" : "spherePoint<3>");
+
+    const SphereBatch<dimensions> a = spheres<dimensions>(2);
+    const PointBatch<dimensions> b = points<dimensions>();
+    bool results[Count];
+    collides(a, b, results);
+
+    const std::size_t collisions = countCollisions(a, b, results);
+    CORRADE_VERIFY(collisions != ~std::size_t{});
+    CORRADE_VERIFY(collisions > 0);
+    CORRADE_VERIFY(collisions < Count);
+}
+
+template<UnsignedInt dimensions> void BatchCollisionTest::sphereSphere() {
+    setTestCaseName(dimensions == 2 ? "sphereSphere<2>" : "sphereSphere<3>");
+
+    const SphereBatch<dimensions> a = spheres<dimensions>(2);
+    const SphereBatch<dimensions> b = spheres<dimensions>(3);
+    bool results[Count];
+    collides(a, b, results);
+
+    const std::size_t collisions = countCollisions(a, b, results);
+    CORRADE_VERIFY(collisions != ~std::size_t{});
+    CORRADE_VERIFY(collisions > 0);
+    CORRADE_VERIFY(collisions < Count);
+}
+
+template<UnsignedInt dimensions> void BatchCollisionTest::axisAlignedBoxPoint() {
+    setTestCaseName(dimensions == 2 ? "axisAlignedBoxPoint<2>" : "axisAlignedBoxPoint<3>");
+
+    AxisAlignedBoxBatch<dimensions> a;
+    for(std::size_t i = 0; i != Count; ++i) {
+        const VectorTypeFor<dimensions, Float> min = vector<dimensions>(i, 4);
+        a.add(AxisAlignedBox<dimensions>{min, min + VectorTypeFor<dimensions, Float>{1.0f + (i % 3)*0.5f}});
+    }
+    const PointBatch<dimensions> b = points<dimensions>();
+    bool results[Count];
+    collides(a, b, results);
+
+    const std::size_t collisions = countCollisions(a, b, results);
+    CORRADE_VERIFY(collisions != ~std::size_t{});
+    CORRADE_VERIFY(collisions > 0);
+    CORRADE_VERIFY(collisions < Count);
+}
+
+template<UnsignedInt dimensions> void BatchCollisionTest::capsulePoint() {
+    setTestCaseName(dimensions == 2 ? "capsulePoint<2>" : "capsulePoint<3>");
+
+    CapsuleBatch<dimensions> a;
+    for(std::size_t i = 0; i != Count; ++i)
+        a.add(Capsule<dimensions>{vector<dimensions>(i, 5), vector<dimensions>(i, 6), 0.2f + (i % 4)*0.15f});
+    const PointBatch<dimensions> b = points<dimensions>();
+    bool results[Count];
+    collides(a, b, results);
+
+    const std::size_t collisions = countCollisions(a, b, results);
+    CORRADE_VERIFY(collisions != ~std::size_t{});
+    CORRADE_VERIFY(collisions > 0);
+    CORRADE_VERIFY(collisions < Count);
+}
+
+template<UnsignedInt dimensions> void BatchCollisionTest::capsuleSphere() {
+    setTestCaseName(dimensions == 2 ? "capsuleSphere<2>" : "capsuleSphere<3>");
+
+    CapsuleBatch<dimensions> a;
+    for(std::size_t i = 0; i != Count; ++i)
+        a.add(Capsule<dimensions>{vector<dimensions>(i, 5), vector<dimensions>(i, 6), 0.1f + (i % 4)*0.1f});
+    const SphereBatch<dimensions> b = spheres<dimensions>(7);
+    bool results[Count];
+    collides(a, b, results);
+
+    const std::size_t collisions = countCollisions(a, b, results);
+    CORRADE_VERIFY(collisions != ~std::size_t{});
+    CORRADE_VERIFY(collisions > 0);
+    CORRADE_VERIFY(collisions < Count);
+}
+
+void BatchCollisionTest::broadcast() {
+    /* One shape against all */
+    SphereBatch3D a;
+    a.add(Sphere3D{{}, 1.5f});
+    const SphereBatch3D b = spheres<3>(3);
+    bool results[Count];
+    collides(a, b, results);
+
+    const std::size_t collisions = countCollisions(a, b, results);
+    CORRADE_VERIFY(collisions != ~std::size_t{});
+    CORRADE_VERIFY(collisions > 0);
+    CORRADE_VERIFY(collisions < Count);
+
+    CapsuleBatch3D c;
+    c.add(Capsule3D{{-1.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, 0.5f});
+    const PointBatch3D d = points<3>();
+    collides(c, d, results);
+
+    const std::size_t capsuleCollisions = countCollisions(c, d, results);
+    CORRADE_VERIFY(capsuleCollisions != ~std::size_t{});
+    CORRADE_VERIFY(capsuleCollisions > 0);
+    CORRADE_VERIFY(capsuleCollisions < Count);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Shapes::Test::BatchCollisionTest)
@@ -0,0 +1,202 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Shapes/Box.h"
+#include "Magnum/Shapes/CompiledComposition.h"
+
+#include "ShapeTestBase.h"
+
+namespace Magnum { namespace Shapes { namespace Test {
+
+struct CompiledCompositionTest: TestSuite::Tester {
+    explicit CompiledCompositionTest();
+
+    void negated();
+    void anded();
+    void ored();
+    void multipleUnary();
+    void hierarchy();
+    void empty();
+    void unsupportedShape();
+
+    void stackDepth();
+    void batchPoints();
+    void batchSpheres();
+};
+
+CompiledCompositionTest::CompiledCompositionTest() {
+    addTests({&CompiledCompositionTest::negated,
+              &CompiledCompositionTest::anded,
+              &CompiledCompositionTest::ored,
+              &CompiledCompositionTest::multipleUnary,
+              &CompiledCompositionTest::hierarchy,
+              &CompiledCompositionTest::empty,
+              &CompiledCompositionTest::unsupportedShape,
+
+              &CompiledCompositionTest::stackDepth,
+              &CompiledCompositionTest::batchPoints,
+              &CompiledCompositionTest::batchSpheres});
+}
+
+void CompiledCompositionTest::negated() {
+    const Shapes::CompiledComposition2D a{!Shapes::Point2D(Vector2::xAxis(0.5f))};
+
+    CORRADE_COMPARE(a.size(), 1);
+    CORRADE_COMPARE(a.size(CompiledComposition2D::Type::Point), 1);
+    CORRADE_COMPARE(a.stackDepth(), 1);
+
+    VERIFY_NOT_COLLIDES(a, Shapes::Sphere2D({}, 1.0f));
+}
+
+void CompiledCompositionTest::anded() {
+    const Shapes::CompiledComposition2D a{Shapes::Sphere2D({}, 1.0f) && Shapes::Point2D(Vector2::xAxis(0.5f))};
+
+    CORRADE_COMPARE(a.size(), 2);
+    CORRADE_COMPARE(a.size(CompiledComposition2D::Type::Sphere), 1);
+    CORRADE_COMPARE(a.size(CompiledComposition2D::Type::Point), 1);
+
+    VERIFY_NOT_COLLIDES(a, Shapes::Point2D());
+    VERIFY_COLLIDES(a, Shapes::Sphere2D(Vector2::xAxis(0.5f), 0.25f));
+}
+
+void CompiledCompositionTest::ored() {
+    const Shapes::CompiledComposition2D a{Shapes::Sphere2D({}, 1.0f) || Shapes::Point2D(Vector2::xAxis(1.5f))};
+
+    VERIFY_COLLIDES(a, Shapes::Point2D());
+    VERIFY_COLLIDES(a, Shapes::Sphere2D(Vector2::xAxis(1.5f), 0.25f));
+    VERIFY_NOT_COLLIDES(a, Shapes::Point2D(Vector2::xAxis(1.5f)));
+}
+
+void CompiledCompositionTest::multipleUnary() {
+    const Shapes::CompiledComposition2D a{!!!!Shapes::Point2D(Vector2::xAxis(0.5f))};
+
+    CORRADE_COMPARE(a.stackDepth(), 1);
+
+    VERIFY_COLLIDES(a, Shapes::Sphere2D({}, 1.0f));
+}
+
+void CompiledCompositionTest::hierarchy() {
+    const Shapes::CompiledComposition3D a{Shapes::Sphere3D({}, 1.0f) &&
+        (Shapes::Point3D(Vector3::xAxis(1.5f)) || !Shapes::AxisAlignedBox3D({}, Vector3(0.5f)))};
+
+    CORRADE_COMPARE(a.size(), 3);
+    CORRADE_COMPARE(a.size(CompiledComposition3D::Type::AxisAlignedBox), 1);
+
+    VERIFY_COLLIDES(a, Shapes::Sphere3D(Vector3::xAxis(1.5f), 0.6f));
+    VERIFY_NOT_COLLIDES(a, Shapes::Point3D(Vector3(0.25f)));
+    VERIFY_COLLIDES(a, Shapes::Point3D(Vector3(0.75f, 0.0f, 0.0f)));
+}
+
+void CompiledCompositionTest::empty() {
+    const Shapes::CompiledComposition2D a{Shapes::Composition2D{}};
+
+    CORRADE_COMPARE(a.size(), 0);
+    CORRADE_COMPARE(a.stackDepth(), 1);
+
+    VERIFY_NOT_COLLIDES(a, Shapes::Sphere2D({}, 1.0f));
+    VERIFY_NOT_COLLIDES(a, Shapes::Point2D());
+}
+
+void CompiledCompositionTest::unsupportedShape() {
+    /* Box doesn't collide with anything, the same as in Composition */
+    const Shapes::Composition3D composition = !Shapes::Box3D(Matrix4::scaling(Vector3(2.0f)));
+    const Shapes::CompiledComposition3D a{composition};
+
+    CORRADE_COMPARE(a.size(), 1);
+    CORRADE_COMPARE(a.size(CompiledComposition3D::Type::Box), 0);
+
+    CORRADE_COMPARE(a % Shapes::Point3D(), composition % Shapes::Point3D());
+    VERIFY_COLLIDES(a, Shapes::Point3D());
+}
+
+void CompiledCompositionTest::stackDepth() {
+    /* The operators accept only rvalues */
+    auto s = []() { return Shapes::Sphere2D{{}, 1.0f}; };
+
+    /* Left-leaning chain, the deeper operand is always evaluated first */
+    const Shapes::CompiledComposition2D chain{((((s() && s()) && s()) && s()) && s()) && s()};
+    CORRADE_COMPARE(chain.size(), 6);
+    CORRADE_COMPARE(chain.stackDepth(), 2);
+
+    /* Right-leaning chain, gets reordered */
+    const Shapes::CompiledComposition2D rightChain{s() && (s() && (s() && (s() && (s() && s()))))};
+    CORRADE_COMPARE(rightChain.stackDepth(), 2);
+
+    /* Balanced tree needs one more entry per level */
+    const Shapes::CompiledComposition2D balanced{((s() && s()) || (s() && s())) && ((s() || s()) && (s() || s()))};
+    CORRADE_COMPARE(balanced.stackDepth(), 4);
+}
+
+void CompiledCompositionTest::batchPoints() {
+    const Shapes::Composition2D composition =
+        (Shapes::Sphere2D({}, 2.0f) && !Shapes::AxisAlignedBox2D({-0.5f, -0.5f}, {0.5f, 0.5f})) ||
+        Shapes::Capsule2D({3.0f, 0.0f}, {5.0f, 0.0f}, 0.5f);
+    const Shapes::CompiledComposition2D compiled{composition};
+
+    /* More than one batch and not a multiple of the batch size */
+    Shapes::Point2D points[150];
+    for(std::size_t i = 0; i != 150; ++i)
+        points[i] = Shapes::Point2D{{-1.0f + i*0.05f, 0.2f*(i % 3)}};
+
+    bool results[150];
+    compiled.collidesPoints(points, results);
+
+    std::size_t collisions = 0;
+    for(std::size_t i = 0; i != 150; ++i) {
+        CORRADE_COMPARE(results[i], composition % points[i]);
+        collisions += results[i];
+    }
+
+    /* Verify that the test is not trivial */
+    CORRADE_VERIFY(collisions > 0);
+    CORRADE_VERIFY(collisions < 150);
+}
+
+void CompiledCompositionTest::batchSpheres() {
+    const Shapes::Composition3D composition =
+        Shapes::Cylinder3D({}, Vector3::yAxis(), 1.0f) &&
+        !(Shapes::InvertedSphere3D({}, 3.0f) || Shapes::Point3D(Vector3::xAxis(2.0f)));
+    const Shapes::CompiledComposition3D compiled{composition};
+
+    Shapes::Sphere3D spheres[100];
+    for(std::size_t i = 0; i != 100; ++i)
+        spheres[i] = Shapes::Sphere3D{Vector3::xAxis(-4.0f + i*0.08f), 0.1f + 0.05f*(i % 4)};
+
+    bool results[100];
+    compiled.collidesSpheres(spheres, results);
+
+    std::size_t collisions = 0;
+    for(std::size_t i = 0; i != 100; ++i) {
+        CORRADE_COMPARE(results[i], composition % spheres[i]);
+        collisions += results[i];
+    }
+
+    CORRADE_VERIFY(collisions > 0);
+    CORRADE_VERIFY(collisions < 100);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Shapes::Test::CompiledCompositionTest)
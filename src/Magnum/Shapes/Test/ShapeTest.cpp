@@ -23,9 +23,18 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <sstream>
 #include <Corrade/TestSuite/Tester.h>
 
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Shapes/AxisAlignedBox.h"
+#include "Magnum/Shapes/Box.h"
+#include "Magnum/Shapes/Capsule.h"
 #include "Magnum/Shapes/Composition.h"
+#include "Magnum/Shapes/Cylinder.h"
+#include "Magnum/Shapes/Line.h"
+#include "Magnum/Shapes/LineSegment.h"
+#include "Magnum/Shapes/Plane.h"
 #include "Magnum/Shapes/Point.h"
 #include "Magnum/Shapes/Shape.h"
 #include "Magnum/Shapes/ShapeGroup.h"
@@ -40,9 +49,27 @@ struct ShapeTest: TestSuite::Tester {
     explicit ShapeTest();
 
     void clean();
+    void cleanArena();
     void collides();
     void collision();
     void firstCollision();
+    void bounds();
+    void boundsComposition();
+    void transformedShapeStorage();
+    void collisionPairs();
+    void collisionPairsUnbounded();
+    void contacts();
+    void contactsRemoved();
+    void debugContactState();
+    void shapesInRegion();
+    void raycast();
+    void raycastShapes();
+    void raycastShapes2D();
+    void raycastComposition();
+    void raycastAll();
+    void raycastPacket();
+    void sweep();
+    void sweepCapsule();
     void shapeGroup();
 };
 
@@ -53,9 +80,27 @@ typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
 
 ShapeTest::ShapeTest() {
     addTests({&ShapeTest::clean,
+              &ShapeTest::cleanArena,
               &ShapeTest::collides,
               &ShapeTest::collision,
               &ShapeTest::firstCollision,
+              &ShapeTest::bounds,
+              &ShapeTest::boundsComposition,
+              &ShapeTest::transformedShapeStorage,
+              &ShapeTest::collisionPairs,
+              &ShapeTest::collisionPairsUnbounded,
+              &ShapeTest::contacts,
+              &ShapeTest::contactsRemoved,
+              &ShapeTest::debugContactState,
+              &ShapeTest::shapesInRegion,
+              &ShapeTest::raycast,
+              &ShapeTest::raycastShapes,
+              &ShapeTest::raycastShapes2D,
+              &ShapeTest::raycastComposition,
+              &ShapeTest::raycastAll,
+              &ShapeTest::raycastPacket,
+              &ShapeTest::sweep,
+              &ShapeTest::sweepCapsule,
               &ShapeTest::shapeGroup});
 }
 
@@ -99,6 +144,28 @@ void ShapeTest::clean() {
     CORRADE_VERIFY(b.isDirty());
 }
 
+void ShapeTest::cleanArena() {
+    Scene3D scene;
+    ShapeGroup3D shapes;
+
+    Object3D a(&scene);
+    auto shape = new Shapes::Shape<Shapes::Point3D>(a, {{1.0f, -2.0f, 3.0f}}, &shapes);
+    a.scale(Vector3(-2.0f));
+
+    Object3D b(&scene);
+    new Shapes::Shape<Shapes::Point3D>(b, &shapes);
+
+    FrameArena arena{4096};
+    shapes.setClean(arena);
+    CORRADE_VERIFY(!shapes.isDirty());
+    CORRADE_VERIFY(!a.isDirty());
+    CORRADE_VERIFY(!b.isDirty());
+    CORRADE_COMPARE(shape->transformedShape().position(),
+        Vector3(-2.0f, 4.0f, -6.0f));
+    CORRADE_VERIFY(arena.usedSize() > 0);
+    CORRADE_COMPARE(arena.overflowCount(), 0);
+}
+
 void ShapeTest::collides() {
     Scene3D scene;
     ShapeGroup3D shapes;
@@ -206,6 +273,547 @@ void ShapeTest::firstCollision() {
     CORRADE_VERIFY(!shapes.isDirty());
 }
 
+void ShapeTest::bounds() {
+    Scene2D scene;
+
+    Object2D a(&scene);
+    a.translate(Vector2::yAxis(1.0f));
+    Shape<Shapes::Sphere2D> sphere(a, {{1.0f, -2.0f}, 1.5f});
+    Shape<Shapes::LineSegment2D> segment(a, {{1.0f, 2.0f}, {-3.0f, 0.5f}});
+    Shape<Shapes::Box2D> box(a, {Matrix3::rotation(Deg(45.0f))});
+    Shape<Shapes::Line2D> line(a, {{0.0f, 0.0f}, {1.0f, 0.0f}});
+    a.setClean();
+
+    CORRADE_COMPARE(sphere.bounds(), (Range2D{{-0.5f, -2.5f}, {2.5f, 0.5f}}));
+    CORRADE_COMPARE(segment.bounds(), (Range2D{{-3.0f, 1.5f}, {1.0f, 3.0f}}));
+    CORRADE_COMPARE(box.bounds(), (Range2D{{-Constants::sqrt2(), 1.0f - Constants::sqrt2()}, {Constants::sqrt2(), 1.0f + Constants::sqrt2()}}));
+    CORRADE_COMPARE(line.bounds().min(), Vector2{-Constants::inf()});
+    CORRADE_COMPARE(line.bounds().max(), Vector2{Constants::inf()});
+}
+
+void ShapeTest::boundsComposition() {
+    Scene2D scene;
+
+    Object2D a(&scene);
+    Shape<Shapes::Composition2D> composition(a, Shapes::Sphere2D({}, 0.5f) || Shapes::Point2D({0.25f, -1.0f}));
+    Shape<Shapes::Composition2D> negated(a, !Shapes::Sphere2D({}, 0.5f));
+    a.setClean();
+
+    CORRADE_COMPARE(composition.bounds(), (Range2D{{-0.5f, -1.0f}, {0.5f, 0.5f}}));
+    CORRADE_COMPARE(negated.bounds().min(), Vector2{-Constants::inf()});
+    CORRADE_COMPARE(negated.bounds().max(), Vector2{Constants::inf()});
+}
+
+void ShapeTest::transformedShapeStorage() {
+    Scene3D scene;
+    ShapeGroup3D shapes;
+
+    Object3D a(&scene);
+    a.translate(Vector3::xAxis(2.0f));
+    Shape<Shapes::Point3D> point(a, {{1.0f, 0.0f, 0.0f}}, &shapes);
+    Shape<Shapes::Sphere3D> sphere(a, {{0.0f, 1.0f, 0.0f}, 0.5f}, &shapes);
+    Shape<Shapes::Line3D> line(a, {{}, Vector3::zAxis()}, &shapes);
+    Shape<Shapes::AxisAlignedBox3D> box(a, {{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}}, &shapes);
+    Shape<Shapes::InvertedSphere3D> inverted(a, {{}, 1.0f}, &shapes);
+    Shape<Shapes::Sphere3D> sphere2(a, {{0.0f, 0.0f, 3.0f}, 2.0f}, &shapes);
+    Shape<Shapes::Capsule3D> capsule(a, {{}, {0.0f, 1.0f, 0.0f}, 0.25f}, &shapes);
+    shapes.setClean();
+
+    CORRADE_COMPARE(shapes.points().size(), 1);
+    CORRADE_COMPARE(shapes.pointIndices().size(), 1);
+    CORRADE_COMPARE(shapes.pointIndices()[0], 0);
+    CORRADE_COMPARE(shapes.points()[0].position(), (Vector3{3.0f, 0.0f, 0.0f}));
+
+    /* Inverted sphere is not included */
+    CORRADE_COMPARE(shapes.spheres().size(), 2);
+    CORRADE_COMPARE(shapes.sphereIndices().size(), 2);
+    CORRADE_COMPARE(shapes.sphereIndices()[0], 1);
+    CORRADE_COMPARE(shapes.sphereIndices()[1], 5);
+    CORRADE_COMPARE(shapes.spheres().positions(0)[0], 2.0f);
+    CORRADE_COMPARE(shapes.spheres().positions(1)[0], 1.0f);
+    CORRADE_COMPARE(shapes.spheres().positions(2)[1], 3.0f);
+    CORRADE_COMPARE(shapes.spheres().radii()[1], 2.0f);
+
+    CORRADE_COMPARE(shapes.boxes().size(), 1);
+    CORRADE_COMPARE(shapes.boxIndices()[0], 3);
+    CORRADE_COMPARE(shapes.boxes().min(0)[0], 1.0f);
+    CORRADE_COMPARE(shapes.boxes().max(0)[0], 3.0f);
+
+    CORRADE_COMPARE(shapes.capsules().size(), 1);
+    CORRADE_COMPARE(shapes.capsuleIndices()[0], 6);
+    CORRADE_COMPARE(shapes.capsules()[0].b(), (Vector3{2.0f, 1.0f, 0.0f}));
+
+    /* Moving the object updates the storage on next clean */
+    a.translate(Vector3::yAxis(1.0f));
+    shapes.setClean();
+    CORRADE_COMPARE(shapes.spheres().size(), 2);
+    CORRADE_COMPARE(shapes.spheres().positions(1)[0], 2.0f);
+    CORRADE_COMPARE(shapes.boxes().max(1)[0], 2.0f);
+}
+
+void ShapeTest::collisionPairs() {
+    Scene3D scene;
+    ShapeGroup3D shapes;
+
+    /* Two clusters, far away from each other */
+    Object3D a(&scene);
+    Shape<Shapes::Sphere3D> aShape(a, {{}, 1.0f}, &shapes);
+    Object3D b(&scene);
+    Shape<Shapes::Point3D> bShape(b, {{20.0f, 0.0f, 0.0f}}, &shapes);
+    Object3D c(&scene);
+    Shape<Shapes::Point3D> cShape(c, {{0.5f, 0.0f, 0.0f}}, &shapes);
+    Object3D d(&scene);
+    Shape<Shapes::Sphere3D> dShape(d, {{20.0f, 0.5f, 0.0f}, 1.0f}, &shapes);
+
+    /* Overlapping in X, but not in Y */
+    Object3D e(&scene);
+    Shape<Shapes::Point3D> eShape(e, {{0.0f, 5.0f, 0.0f}}, &shapes);
+
+    {
+        auto pairs = shapes.collisionPairs();
+        CORRADE_COMPARE(pairs.size(), 2);
+        CORRADE_VERIFY(pairs[0].first == &aShape && pairs[0].second == &cShape);
+        CORRADE_VERIFY(pairs[1].first == &bShape && pairs[1].second == &dShape);
+    }
+
+    /* Move the point from one cluster to the other, broad phase is updated */
+    c.translate(Vector3::xAxis(20.0f));
+    {
+        auto pairs = shapes.collisionPairs();
+        CORRADE_COMPARE(pairs.size(), 2);
+        CORRADE_VERIFY(pairs[0].first == &bShape && pairs[0].second == &dShape);
+        CORRADE_VERIFY(pairs[1].first == &cShape && pairs[1].second == &dShape);
+        CORRADE_VERIFY(!shapes.firstCollision(aShape));
+        CORRADE_VERIFY(shapes.firstCollision(cShape) == &dShape);
+    }
+
+    /* Added shape is picked up by the broad phase */
+    Object3D f(&scene);
+    Shape<Shapes::Point3D> fShape(f, {{0.0f, 0.5f, 0.0f}}, &shapes);
+    {
+        auto pairs = shapes.collisionPairs();
+        CORRADE_COMPARE(pairs.size(), 3);
+        CORRADE_VERIFY(pairs[0].first == &aShape && pairs[0].second == &fShape);
+        CORRADE_VERIFY(pairs[1].first == &bShape && pairs[1].second == &dShape);
+        CORRADE_VERIFY(pairs[2].first == &cShape && pairs[2].second == &dShape);
+    }
+}
+
+void ShapeTest::collisionPairsUnbounded() {
+    Scene3D scene;
+    ShapeGroup3D shapes;
+
+    Object3D a(&scene);
+    Shape<Shapes::Sphere3D> aShape(a, {{0.0f, 0.0f, 0.0f}, 1.0f}, &shapes);
+    Object3D b(&scene);
+    Shape<Shapes::Line3D> bShape(b, {{-50.0f, 0.0f, 0.0f}, {50.0f, 0.0f, 0.0f}}, &shapes);
+    Object3D c(&scene);
+    Shape<Shapes::Sphere3D> cShape(c, {{100.0f, 0.0f, 0.0f}, 1.0f}, &shapes);
+    Object3D d(&scene);
+    Shape<Shapes::Sphere3D> dShape(d, {{0.0f, 10.0f, 0.0f}, 1.0f}, &shapes);
+
+    /* The line is infinite, thus colliding with both spheres on X */
+    auto pairs = shapes.collisionPairs();
+    CORRADE_COMPARE(pairs.size(), 2);
+    CORRADE_VERIFY(pairs[0].first == &aShape && pairs[0].second == &bShape);
+    CORRADE_VERIFY(pairs[1].first == &bShape && pairs[1].second == &cShape);
+
+    CORRADE_VERIFY(shapes.firstCollision(cShape) == &bShape);
+    CORRADE_VERIFY(!shapes.firstCollision(dShape));
+}
+
+void ShapeTest::contacts() {
+    Scene2D scene;
+    ShapeGroup2D shapes;
+
+    Object2D a(&scene);
+    Shape<Shapes::Sphere2D> aShape(a, {{}, 1.0f}, &shapes);
+    Object2D b(&scene);
+    Shape<Shapes::Point2D> bShape(b, {{0.5f, 0.0f}}, &shapes);
+    Object2D c(&scene);
+    Shape<Shapes::Sphere2D> cShape(c, {{10.0f, 0.0f}, 1.0f}, &shapes);
+    /* Overlapping bounds with the first sphere, but not colliding */
+    Object2D d(&scene);
+    Shape<Shapes::Point2D> dShape(d, {{0.9f, 0.9f}}, &shapes);
+
+    {
+        std::vector<Contact2D> contacts = shapes.updateContacts();
+        CORRADE_COMPARE(contacts.size(), 1);
+        CORRADE_VERIFY(contacts[0].a() == &aShape && contacts[0].b() == &bShape);
+        CORRADE_COMPARE(contacts[0].state(), ContactState::Begin);
+        /* Everything is new, so both overlapping pairs are tested */
+        CORRADE_COMPARE(shapes.contactTestCount(), 2);
+    }
+
+    /* Nothing moved, nothing is tested again */
+    {
+        std::vector<Contact2D> contacts = shapes.updateContacts();
+        CORRADE_COMPARE(contacts.size(), 1);
+        CORRADE_VERIFY(contacts[0].a() == &aShape && contacts[0].b() == &bShape);
+        CORRADE_COMPARE(contacts[0].state(), ContactState::Stay);
+        CORRADE_COMPARE(shapes.contactTestCount(), 0);
+    }
+
+    /* Move the point to the other sphere */
+    b.translate(Vector2::xAxis(10.0f));
+    {
+        std::vector<Contact2D> contacts = shapes.updateContacts();
+        CORRADE_COMPARE(contacts.size(), 2);
+        CORRADE_VERIFY(contacts[0].a() == &bShape && contacts[0].b() == &cShape);
+        CORRADE_COMPARE(contacts[0].state(), ContactState::Begin);
+        CORRADE_VERIFY(contacts[1].a() == &aShape && contacts[1].b() == &bShape);
+        CORRADE_COMPARE(contacts[1].state(), ContactState::End);
+        /* Only the pair with the moved point, the A-D pair isn't tested */
+        CORRADE_COMPARE(shapes.contactTestCount(), 1);
+    }
+
+    /* Move the sphere along with the point, contact stays */
+    c.translate(Vector2::yAxis(0.25f));
+    b.translate(Vector2::yAxis(0.25f));
+    {
+        std::vector<Contact2D> contacts = shapes.updateContacts();
+        CORRADE_COMPARE(contacts.size(), 1);
+        CORRADE_VERIFY(contacts[0].a() == &bShape && contacts[0].b() == &cShape);
+        CORRADE_COMPARE(contacts[0].state(), ContactState::Stay);
+        CORRADE_COMPARE(shapes.contactTestCount(), 1);
+    }
+
+    /* After reset everything is new again */
+    shapes.resetContacts();
+    {
+        std::vector<Contact2D> contacts = shapes.updateContacts();
+        CORRADE_COMPARE(contacts.size(), 1);
+        CORRADE_COMPARE(contacts[0].state(), ContactState::Begin);
+        CORRADE_COMPARE(shapes.contactTestCount(), 2);
+    }
+}
+
+void ShapeTest::contactsRemoved() {
+    Scene2D scene;
+    ShapeGroup2D shapes;
+
+    Object2D a(&scene);
+    Shape<Shapes::Sphere2D> aShape(a, {{}, 1.0f}, &shapes);
+    Object2D b(&scene);
+    Shape<Shapes::Point2D> bShape(b, {{0.5f, 0.0f}}, &shapes);
+    Object2D c(&scene);
+    Shape<Shapes::Point2D> cShape(c, {{-0.5f, 0.0f}}, &shapes);
+
+    CORRADE_COMPARE(shapes.updateContacts().size(), 2);
+
+    /* Removed shape ends the contact, the other shape moves to a different
+       position in the group so its pair is tested again */
+    shapes.remove(bShape);
+    std::vector<Contact2D> contacts = shapes.updateContacts();
+    CORRADE_COMPARE(contacts.size(), 2);
+    CORRADE_VERIFY(contacts[0].a() == &aShape && contacts[0].b() == &cShape);
+    CORRADE_COMPARE(contacts[0].state(), ContactState::Stay);
+    CORRADE_VERIFY(contacts[1].a() == &aShape && contacts[1].b() == &bShape);
+    CORRADE_COMPARE(contacts[1].state(), ContactState::End);
+    CORRADE_COMPARE(shapes.contactTestCount(), 1);
+}
+
+void ShapeTest::debugContactState() {
+    std::ostringstream out;
+    Debug(&out) << ContactState::Stay << ContactState(0xde);
+    CORRADE_COMPARE(out.str(), "Shapes::ContactState::Stay Shapes::ContactState(0xde)\n");
+}
+
+void ShapeTest::shapesInRegion() {
+    Scene2D scene;
+    ShapeGroup2D shapes;
+
+    Object2D a(&scene);
+    Shape<Shapes::Sphere2D> aShape(a, {{}, 1.0f}, &shapes);
+    Object2D b(&scene);
+    Shape<Shapes::Point2D> bShape(b, {{3.0f, 3.0f}}, &shapes);
+    Object2D c(&scene);
+    Shape<Shapes::Point2D> cShape(c, {{-3.0f, 1.5f}}, &shapes);
+    Object2D d(&scene);
+    Shape<Shapes::Line2D> dShape(d, {{0.0f, -5.0f}, {1.0f, -5.0f}}, &shapes);
+
+    CORRADE_COMPARE(shapes.shapesInRegion({{0.5f, 0.5f}, {4.0f, 4.0f}}),
+        (std::vector<AbstractShape2D*>{&aShape, &bShape, &dShape}));
+    CORRADE_COMPARE(shapes.shapesInRegion({{-4.0f, 1.0f}, {-2.0f, 2.0f}}),
+        (std::vector<AbstractShape2D*>{&cShape, &dShape}));
+}
+
+void ShapeTest::raycast() {
+    Scene3D scene;
+    ShapeGroup3D shapes;
+
+    Object3D a(&scene);
+    Shape<Shapes::Sphere3D> aShape(a, {{5.0f, 0.0f, 0.0f}, 1.0f}, &shapes);
+    Object3D b(&scene);
+    Shape<Shapes::AxisAlignedBox3D> bShape(b, {{8.0f, -2.0f, -1.0f}, {9.0f, -0.5f, 1.0f}}, &shapes);
+    Object3D c(&scene);
+    Shape<Shapes::Capsule3D> cShape(c, {{0.0f, 3.0f, -2.0f}, {0.0f, 3.0f, 2.0f}, 0.5f}, &shapes);
+    Object3D d(&scene);
+    Shape<Shapes::Point3D> dShape(d, {{2.0f, 0.0f, 0.0f}}, &shapes);
+
+    /* Nearest hit, the point can't be hit */
+    RaycastHit3D hit = shapes.raycast({}, Vector3::xAxis());
+    CORRADE_VERIFY(hit);
+    CORRADE_VERIFY(hit.shape() == &aShape);
+    CORRADE_COMPARE(hit.distance(), 4.0f);
+    CORRADE_COMPARE(hit.position(), (Vector3{4.0f, 0.0f, 0.0f}));
+    CORRADE_VERIFY(!shapes.isDirty());
+
+    /* Distance is in multiples of direction length */
+    CORRADE_COMPARE(shapes.raycast({}, Vector3::xAxis(2.0f)).distance(), 2.0f);
+
+    /* Too short or going the other way */
+    CORRADE_VERIFY(!shapes.raycast({}, Vector3::xAxis(), 3.5f));
+    CORRADE_VERIFY(!shapes.raycast({}, -Vector3::xAxis()));
+    CORRADE_VERIFY(!shapes.raycast({}, -Vector3::xAxis()).shape());
+    CORRADE_COMPARE(shapes.raycast({}, -Vector3::xAxis()).distance(), Constants::inf());
+
+    /* Passing below the sphere, hitting the box */
+    hit = shapes.raycast({0.0f, -1.5f, 0.0f}, Vector3::xAxis());
+    CORRADE_VERIFY(hit.shape() == &bShape);
+    CORRADE_COMPARE(hit.distance(), 8.0f);
+
+    /* Hitting the capsule from above */
+    hit = shapes.raycast({0.0f, 10.0f, 1.0f}, -Vector3::yAxis());
+    CORRADE_VERIFY(hit.shape() == &cShape);
+    CORRADE_COMPARE(hit.distance(), 6.5f);
+    CORRADE_COMPARE(hit.position(), (Vector3{0.0f, 3.5f, 1.0f}));
+
+    /* Starting inside the shape */
+    hit = shapes.raycast({5.5f, 0.0f, 0.0f}, Vector3::xAxis());
+    CORRADE_VERIFY(hit.shape() == &aShape);
+    CORRADE_COMPARE(hit.distance(), 0.0f);
+    CORRADE_COMPARE(hit.position(), (Vector3{5.5f, 0.0f, 0.0f}));
+
+    /* Moved shape is picked up by the broad phase */
+    a.translate(Vector3::xAxis(-2.0f));
+    CORRADE_VERIFY(shapes.isDirty());
+    CORRADE_COMPARE(shapes.raycast({}, Vector3::xAxis()).distance(), 2.0f);
+}
+
+void ShapeTest::raycastShapes() {
+    Scene3D scene;
+
+    {
+        ShapeGroup3D shapes;
+        Object3D a(&scene);
+        Shape<Shapes::Box3D> box(a, {Matrix4::translation(Vector3::xAxis(5.0f))*Matrix4::rotationZ(Deg(45.0f))}, &shapes);
+        CORRADE_COMPARE(shapes.raycast({}, Vector3::xAxis()).distance(), 5.0f - Constants::sqrt2());
+        CORRADE_VERIFY(!shapes.raycast({0.0f, 1.5f, 0.0f}, Vector3::xAxis()));
+    } {
+        ShapeGroup3D shapes;
+        Object3D a(&scene);
+        Shape<Shapes::Cylinder3D> cylinder(a, {{5.0f, 0.0f, 0.0f}, {5.0f, 1.0f, 0.0f}, 0.5f}, &shapes);
+        CORRADE_COMPARE(shapes.raycast({}, Vector3::xAxis()).distance(), 4.5f);
+        CORRADE_COMPARE(shapes.raycast({5.0f, -10.0f, 0.25f}, Vector3::yAxis()).distance(), 0.0f);
+        CORRADE_VERIFY(!shapes.raycast({5.0f, -10.0f, 0.75f}, Vector3::yAxis()));
+    } {
+        ShapeGroup3D shapes;
+        Object3D a(&scene);
+        Shape<Shapes::Plane> plane(a, {{3.0f, 0.0f, 0.0f}, Vector3::xAxis()}, &shapes);
+        CORRADE_COMPARE(shapes.raycast({}, Vector3::xAxis()).distance(), 3.0f);
+        CORRADE_COMPARE(shapes.raycast({6.0f, 1.0f, 0.0f}, -Vector3::xAxis()).distance(), 3.0f);
+        CORRADE_VERIFY(!shapes.raycast({}, -Vector3::xAxis()));
+        CORRADE_VERIFY(!shapes.raycast({}, Vector3::yAxis()));
+    } {
+        ShapeGroup3D shapes;
+        Object3D a(&scene);
+        Shape<Shapes::InvertedSphere3D> sphere(a, {{}, 2.0f}, &shapes);
+        CORRADE_COMPARE(shapes.raycast({}, Vector3::zAxis()).distance(), 2.0f);
+        CORRADE_COMPARE(shapes.raycast({5.0f, 0.0f, 0.0f}, -Vector3::xAxis()).distance(), 0.0f);
+    } {
+        ShapeGroup3D shapes;
+        Object3D a(&scene);
+        Shape<Shapes::Line3D> line(a, {{3.0f, -1.0f, 0.0f}, {3.0f, 1.0f, 0.0f}}, &shapes);
+        Shape<Shapes::LineSegment3D> segment(a, {{5.0f, -1.0f, 0.0f}, {5.0f, 1.0f, 0.0f}}, &shapes);
+        CORRADE_VERIFY(!shapes.raycast({}, Vector3::xAxis()));
+    }
+}
+
+void ShapeTest::raycastShapes2D() {
+    Scene2D scene;
+
+    {
+        ShapeGroup2D shapes;
+        Object2D a(&scene);
+        Shape<Shapes::Line2D> line(a, {{3.0f, -1.0f}, {3.0f, 1.0f}}, &shapes);
+        CORRADE_COMPARE(shapes.raycast({0.0f, 7.0f}, Vector2::xAxis()).distance(), 3.0f);
+        CORRADE_VERIFY(!shapes.raycast({}, Vector2::yAxis()));
+    } {
+        ShapeGroup2D shapes;
+        Object2D a(&scene);
+        Shape<Shapes::LineSegment2D> segment(a, {{3.0f, -1.0f}, {3.0f, 1.0f}}, &shapes);
+        CORRADE_COMPARE(shapes.raycast({0.0f, 0.5f}, Vector2::xAxis()).distance(), 3.0f);
+        CORRADE_VERIFY(!shapes.raycast({0.0f, 1.5f}, Vector2::xAxis()));
+    } {
+        ShapeGroup2D shapes;
+        Object2D a(&scene);
+        Shape<Shapes::Sphere2D> sphere(a, {{3.0f, 4.0f}, 1.0f}, &shapes);
+        Shape<Shapes::Point2D> point(a, {{1.5f, 2.0f}}, &shapes);
+        RaycastHit2D hit = shapes.raycast({}, Vector2{0.6f, 0.8f});
+        CORRADE_VERIFY(hit.shape() == &sphere);
+        CORRADE_COMPARE(hit.distance(), 4.0f);
+        CORRADE_COMPARE(hit.position(), (Vector2{2.4f, 3.2f}));
+    }
+}
+
+void ShapeTest::raycastComposition() {
+    Scene3D scene;
+
+    {
+        ShapeGroup3D shapes;
+        Object3D a(&scene);
+        Shape<Shapes::Composition3D> shell(a, Shapes::Sphere3D({}, 2.0f) && !Shapes::Sphere3D({}, 1.0f), &shapes);
+        CORRADE_COMPARE(shapes.raycast({}, Vector3::xAxis()).distance(), 1.0f);
+        CORRADE_COMPARE(shapes.raycast({-5.0f, 0.0f, 0.0f}, Vector3::xAxis()).distance(), 3.0f);
+        CORRADE_COMPARE(shapes.raycast({-5.0f, 1.5f, 0.0f}, Vector3::xAxis()).distance(), 5.0f - Math::sqrt(1.75f));
+    } {
+        ShapeGroup3D shapes;
+        Object3D a(&scene);
+        Shape<Shapes::Composition3D> intersection(a, Shapes::AxisAlignedBox3D({0.0f, -1.0f, -1.0f}, {10.0f, 1.0f, 1.0f}) && Shapes::Sphere3D({6.0f, 0.0f, 0.0f}, 2.0f), &shapes);
+        CORRADE_COMPARE(shapes.raycast({-5.0f, 0.0f, 0.0f}, Vector3::xAxis()).distance(), 9.0f);
+        CORRADE_VERIFY(!shapes.raycast({-5.0f, 0.0f, 0.0f}, Vector3::xAxis(), 8.0f));
+    } {
+        ShapeGroup3D shapes;
+        Object3D a(&scene);
+        Shape<Shapes::Composition3D> join(a, Shapes::Sphere3D({5.0f, 0.0f, 0.0f}, 1.0f) || Shapes::Point3D({2.0f, 0.0f, 0.0f}), &shapes);
+        CORRADE_COMPARE(shapes.raycast({}, Vector3::xAxis()).distance(), 4.0f);
+        CORRADE_VERIFY(!shapes.raycast({}, Vector3::yAxis()));
+    }
+}
+
+void ShapeTest::raycastAll() {
+    Scene3D scene;
+    ShapeGroup3D shapes;
+
+    Object3D a(&scene);
+    Shape<Shapes::AxisAlignedBox3D> aShape(a, {{8.0f, -2.0f, -1.0f}, {9.0f, -0.5f, 1.0f}}, &shapes);
+    Object3D b(&scene);
+    Shape<Shapes::Sphere3D> bShape(b, {{5.0f, 0.0f, 0.0f}, 1.0f}, &shapes);
+    Object3D c(&scene);
+    Shape<Shapes::Sphere3D> cShape(c, {{-5.0f, 0.0f, 0.0f}, 1.0f}, &shapes);
+    Object3D d(&scene);
+    Shape<Shapes::Sphere3D> dShape(d, {{5.0f, 0.0f, 0.0f}, 2.0f}, &shapes);
+
+    /* Ordered by distance, shapes behind the origin are not hit */
+    std::vector<RaycastHit3D> hits = shapes.raycastAll({0.0f, -0.8f, 0.0f}, Vector3::xAxis());
+    CORRADE_COMPARE(hits.size(), 3);
+    CORRADE_VERIFY(hits[0].shape() == &dShape);
+    CORRADE_VERIFY(hits[1].shape() == &bShape);
+    CORRADE_COMPARE(hits[1].distance(), 4.4f);
+    CORRADE_VERIFY(hits[2].shape() == &aShape);
+    CORRADE_COMPARE(hits[2].distance(), 8.0f);
+
+    /* Limited distance */
+    hits = shapes.raycastAll({0.0f, -0.8f, 0.0f}, Vector3::xAxis(), 5.0f);
+    CORRADE_COMPARE(hits.size(), 2);
+
+    /* Nothing hit */
+    CORRADE_VERIFY(shapes.raycastAll({}, Vector3::yAxis()).empty());
+}
+
+void ShapeTest::raycastPacket() {
+    Scene3D scene;
+    ShapeGroup3D shapes;
+
+    Object3D a(&scene);
+    Shape<Shapes::Sphere3D> aShape(a, {{5.0f, 0.0f, 0.0f}, 1.0f}, &shapes);
+    Object3D b(&scene);
+    Shape<Shapes::Box3D> bShape(b, {Matrix4::translation({7.0f, 2.0f, 0.0f})}, &shapes);
+    Object3D c(&scene);
+    Shape<Shapes::Line3D> cShape(c, {{}, Vector3::zAxis()}, &shapes);
+
+    const Vector3 origins[]{
+        {},
+        {0.0f, 2.5f, 0.0f},
+        {0.0f, 0.5f, 0.0f},
+        {0.0f, -5.0f, 0.0f}
+    };
+    const Vector3 directions[]{
+        Vector3::xAxis(),
+        Vector3::xAxis(),
+        Vector3::xAxis(2.0f),
+        Vector3::xAxis()
+    };
+
+    std::vector<RaycastHit3D> hits = shapes.raycast(origins, directions);
+    CORRADE_COMPARE(hits.size(), 4);
+    for(std::size_t i = 0; i != hits.size(); ++i) {
+        const RaycastHit3D expected = shapes.raycast(origins[i], directions[i]);
+        CORRADE_VERIFY(hits[i].shape() == expected.shape());
+        CORRADE_COMPARE(hits[i].distance(), expected.distance());
+    }
+
+    CORRADE_VERIFY(hits[0].shape() == &aShape);
+    CORRADE_VERIFY(hits[1].shape() == &bShape);
+    CORRADE_COMPARE(hits[1].distance(), 6.0f);
+    CORRADE_VERIFY(hits[2].shape() == &aShape);
+    CORRADE_VERIFY(!hits[3]);
+
+    CORRADE_VERIFY(shapes.raycast(nullptr, nullptr).empty());
+}
+
+void ShapeTest::sweep() {
+    Scene3D scene;
+    ShapeGroup3D shapes;
+
+    /* Thin wall and a sphere behind it */
+    Object3D a(&scene);
+    Shape<Shapes::AxisAlignedBox3D> aShape(a, {{5.0f, -5.0f, -5.0f}, {5.1f, 5.0f, 5.0f}}, &shapes);
+    Object3D b(&scene);
+    Shape<Shapes::Sphere3D> bShape(b, {{8.0f, 0.0f, 0.0f}, 1.0f}, &shapes);
+    Object3D c(&scene);
+    Shape<Shapes::Composition3D> cShape(c, Shapes::Sphere3D{{2.0f, 0.0f, 0.0f}, 1.0f} || Shapes::Point3D{}, &shapes);
+
+    /* The projectile would be past the wall at the end of the step, the
+       composition is not supported */
+    const Shapes::Sphere3D projectile{{}, 0.5f};
+    RaycastHit3D hit = shapes.sweep(projectile, {20.0f, 0.0f, 0.0f});
+    CORRADE_VERIFY(hit.shape() == &aShape);
+    CORRADE_COMPARE(hit.distance(), 0.225f);
+    CORRADE_COMPARE(hit.position(), (Vector3{4.5f, 0.0f, 0.0f}));
+    CORRADE_VERIFY(!shapes.isDirty());
+
+    /* Starting behind the wall */
+    hit = shapes.sweep(Shapes::Sphere3D{{6.0f, 0.0f, 0.0f}, 0.5f}, {20.0f, 0.0f, 0.0f});
+    CORRADE_VERIFY(hit.shape() == &bShape);
+    CORRADE_COMPARE(hit.distance(), 0.025f);
+
+    /* Not reaching anything */
+    CORRADE_VERIFY(!shapes.sweep(projectile, {4.0f, 0.0f, 0.0f}));
+
+    /* Moved wall is picked up by the broad phase */
+    a.translate(Vector3::yAxis(20.0f));
+    hit = shapes.sweep(projectile, {20.0f, 0.0f, 0.0f});
+    CORRADE_VERIFY(hit.shape() == &bShape);
+    CORRADE_COMPARE(hit.distance(), 0.325f);
+}
+
+void ShapeTest::sweepCapsule() {
+    Scene2D scene;
+    ShapeGroup2D shapes;
+
+    Object2D a(&scene);
+    Shape<Shapes::Sphere2D> aShape(a, {{5.0f, 2.0f}, 1.0f}, &shapes);
+    Object2D b(&scene);
+    Shape<Shapes::Point2D> bShape(b, {{7.0f, 0.0f}}, &shapes);
+    Object2D c(&scene);
+    Shape<Shapes::Line2D> cShape(c, {{-3.0f, 0.0f}, {-3.0f, 1.0f}}, &shapes);
+
+    /* Hitting the sphere with the top end, the point is farther and the line
+       is behind and not supported anyway */
+    const Shapes::Capsule2D capsule{{0.0f, -1.0f}, {0.0f, 1.0f}, 0.5f};
+    RaycastHit2D hit = shapes.sweep(capsule, {10.0f, 0.0f});
+    CORRADE_VERIFY(hit.shape() == &aShape);
+    CORRADE_COMPARE(hit.distance(), (5.0f - Math::sqrt(1.25f))/10.0f);
+    CORRADE_COMPARE(hit.position(), (Vector2{5.0f - Math::sqrt(1.25f), -1.0f}));
+
+    /* Lower, hitting the point */
+    hit = shapes.sweep(Shapes::Capsule2D{{0.0f, -2.0f}, {0.0f, 0.0f}, 0.5f}, {10.0f, 0.0f});
+    CORRADE_VERIFY(hit.shape() == &bShape);
+    CORRADE_COMPARE(hit.distance(), 0.65f);
+}
+
 void ShapeTest::shapeGroup() {
     Scene2D scene;
     ShapeGroup2D shapes;
@@ -0,0 +1,395 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Shapes/Line.h"
+#include "Magnum/Shapes/Point.h"
+#include "Magnum/Shapes/Shape.h"
+#include "Magnum/Shapes/ShapeGroup.h"
+#include "Magnum/Shapes/SpatialHash.h"
+#include "Magnum/Shapes/Sphere.h"
+#include "Magnum/SceneGraph/MatrixTransformation2D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace Shapes { namespace Test {
+
+struct SpatialHashTest: TestSuite::Tester {
+    explicit SpatialHashTest();
+
+    void construct();
+    void set();
+    void setMove();
+    void remove();
+    void oversized();
+    void setCellSize();
+
+    void query();
+    void queryRadius();
+    void nearest();
+    void nearestMaxDistance();
+    void nearestEmpty();
+    void pairs();
+
+    void shapeGroup();
+    void shapeGroupCollisions();
+};
+
+SpatialHashTest::SpatialHashTest() {
+    addTests({&SpatialHashTest::construct,
+              &SpatialHashTest::set,
+              &SpatialHashTest::setMove,
+              &SpatialHashTest::remove,
+              &SpatialHashTest::oversized,
+              &SpatialHashTest::setCellSize,
+
+              &SpatialHashTest::query,
+              &SpatialHashTest::queryRadius,
+              &SpatialHashTest::nearest,
+              &SpatialHashTest::nearestMaxDistance,
+              &SpatialHashTest::nearestEmpty,
+              &SpatialHashTest::pairs,
+
+              &SpatialHashTest::shapeGroup,
+              &SpatialHashTest::shapeGroupCollisions});
+}
+
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation2D> Scene2D;
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
+
+namespace {
+
+/* Deterministic pseudo-random boxes and points in range [-20, 20] */
+struct Random {
+    Float operator()() {
+        state = state*1103515245u + 12345u;
+        return Float((state >> 8) & 0xffff)/Float(0xffff)*40.0f - 20.0f;
+    }
+
+    UnsignedInt state = 7;
+};
+
+std::vector<Range2D> randomBoxes(const std::size_t count) {
+    Random random;
+    std::vector<Range2D> boxes;
+    for(std::size_t i = 0; i != count; ++i) {
+        const Vector2 min{random(), random()};
+        boxes.emplace_back(min, min + Vector2{random() + 20.0f, random() + 20.0f}/40.0f*3.0f);
+    }
+    return boxes;
+}
+
+Float distance(const Range2D& bounds, const Vector2& point) {
+    return (Math::clamp(point, bounds.min(), bounds.max()) - point).length();
+}
+
+}
+
+void SpatialHashTest::construct() {
+    SpatialHash2D hash{2.5f};
+    CORRADE_COMPARE(hash.cellSize(), 2.5f);
+    CORRADE_VERIFY(hash.isEmpty());
+    CORRADE_COMPARE(hash.size(), 0);
+    CORRADE_VERIFY(!hash.contains(0));
+    CORRADE_VERIFY(hash.query({{-100.0f, -100.0f}, {100.0f, 100.0f}}).empty());
+}
+
+void SpatialHashTest::set() {
+    SpatialHash2D hash{1.0f};
+    hash.set(3, {{0.5f, 0.5f}, {2.5f, 1.5f}})
+        .set(1, Vector2{-3.0f, 4.0f});
+
+    CORRADE_VERIFY(!hash.isEmpty());
+    CORRADE_COMPARE(hash.size(), 2);
+    CORRADE_VERIFY(hash.contains(3));
+    CORRADE_VERIFY(hash.contains(1));
+    CORRADE_VERIFY(!hash.contains(0));
+    CORRADE_VERIFY(!hash.contains(4));
+    CORRADE_COMPARE(hash.bounds(3), (Range2D{{0.5f, 0.5f}, {2.5f, 1.5f}}));
+    CORRADE_COMPARE(hash.bounds(1), (Range2D{{-3.0f, 4.0f}, {-3.0f, 4.0f}}));
+
+    CORRADE_COMPARE(hash.query({{2.0f, 1.0f}, {3.0f, 3.0f}}), (std::vector<UnsignedInt>{3}));
+    CORRADE_COMPARE(hash.query({{-3.0f, 0.0f}, {0.5f, 4.0f}}), (std::vector<UnsignedInt>{1, 3}));
+    CORRADE_COMPARE(hash.query({{-2.9f, 1.6f}, {0.4f, 4.0f}}), (std::vector<UnsignedInt>{}));
+}
+
+void SpatialHashTest::setMove() {
+    SpatialHash2D hash{1.0f};
+    hash.set(0, Vector2{0.25f, 0.25f});
+
+    /* Inside the same cell */
+    hash.set(0, Vector2{0.75f, 0.5f});
+    CORRADE_COMPARE(hash.size(), 1);
+    CORRADE_COMPARE(hash.bounds(0), (Range2D{{0.75f, 0.5f}, {0.75f, 0.5f}}));
+    CORRADE_COMPARE(hash.query({{0.7f, 0.4f}, {0.8f, 0.6f}}), (std::vector<UnsignedInt>{0}));
+    CORRADE_COMPARE(hash.query({{0.2f, 0.2f}, {0.3f, 0.3f}}), (std::vector<UnsignedInt>{}));
+
+    /* To another cell */
+    hash.set(0, Vector2{5.5f, -3.5f});
+    CORRADE_COMPARE(hash.size(), 1);
+    CORRADE_COMPARE(hash.query({{0.0f, 0.0f}, {1.0f, 1.0f}}), (std::vector<UnsignedInt>{}));
+    CORRADE_COMPARE(hash.query({{5.0f, -4.0f}, {6.0f, -3.0f}}), (std::vector<UnsignedInt>{0}));
+}
+
+void SpatialHashTest::remove() {
+    SpatialHash2D hash{1.0f};
+    hash.set(0, {{0.5f, 0.5f}, {2.5f, 1.5f}})
+        .set(1, Vector2{1.5f, 1.0f})
+        .remove(0);
+
+    CORRADE_COMPARE(hash.size(), 1);
+    CORRADE_VERIFY(!hash.contains(0));
+    CORRADE_VERIFY(hash.contains(1));
+    CORRADE_COMPARE(hash.query({{0.0f, 0.0f}, {3.0f, 3.0f}}), (std::vector<UnsignedInt>{1}));
+
+    /* Adding it back */
+    hash.set(0, Vector2{1.75f, 1.0f});
+    CORRADE_COMPARE(hash.size(), 2);
+    CORRADE_COMPARE(hash.query({{0.0f, 0.0f}, {3.0f, 3.0f}}), (std::vector<UnsignedInt>{0, 1}));
+
+    hash.clear();
+    CORRADE_VERIFY(hash.isEmpty());
+    CORRADE_VERIFY(!hash.contains(1));
+    CORRADE_COMPARE(hash.query({{0.0f, 0.0f}, {3.0f, 3.0f}}), (std::vector<UnsignedInt>{}));
+}
+
+void SpatialHashTest::oversized() {
+    SpatialHash2D hash{1.0f};
+    hash.set(0, Vector2{0.5f, 0.5f})
+        /* Infinite along one axis */
+        .set(1, {{-Constants::inf(), 2.0f}, {Constants::inf(), 3.0f}})
+        /* Spanning more than 64 cells */
+        .set(2, {{-5.0f, -5.0f}, {5.0f, 5.0f}});
+
+    CORRADE_COMPARE(hash.query({{100.0f, 2.5f}, {101.0f, 2.5f}}), (std::vector<UnsignedInt>{1}));
+    CORRADE_COMPARE(hash.query({{0.0f, 0.0f}, {1.0f, 1.0f}}), (std::vector<UnsignedInt>{0, 2}));
+    CORRADE_COMPARE(hash.query({{-1.0f, 1.0f}, {1.0f, 2.0f}}), (std::vector<UnsignedInt>{1, 2}));
+    CORRADE_COMPARE(hash.nearest({50.0f, 0.0f}, 2), (std::vector<UnsignedInt>{1, 2}));
+    CORRADE_COMPARE(hash.pairs(), (std::vector<std::pair<UnsignedInt, UnsignedInt>>{{0, 2}, {1, 2}}));
+
+    /* Shrinking it back to a regular entry */
+    hash.set(2, Vector2{0.25f, 0.75f});
+    CORRADE_COMPARE(hash.query({{0.0f, 0.0f}, {1.0f, 1.0f}}), (std::vector<UnsignedInt>{0, 2}));
+    CORRADE_COMPARE(hash.query({{-5.0f, -5.0f}, {-4.0f, -4.0f}}), (std::vector<UnsignedInt>{}));
+}
+
+void SpatialHashTest::setCellSize() {
+    const std::vector<Range2D> boxes = randomBoxes(200);
+    SpatialHash2D hash{0.5f};
+    for(std::size_t i = 0; i != boxes.size(); ++i) hash.set(i, boxes[i]);
+
+    const Range2D region{{-3.0f, -2.0f}, {4.0f, 1.0f}};
+    const std::vector<UnsignedInt> expected = hash.query(region);
+    CORRADE_VERIFY(!expected.empty());
+
+    hash.setCellSize(4.0f);
+    CORRADE_COMPARE(hash.cellSize(), 4.0f);
+    CORRADE_COMPARE(hash.size(), 200);
+    CORRADE_COMPARE(hash.query(region), expected);
+}
+
+void SpatialHashTest::query() {
+    const std::vector<Range2D> boxes = randomBoxes(500);
+    SpatialHash2D hash{1.5f};
+    for(std::size_t i = 0; i != boxes.size(); ++i) hash.set(i, boxes[i]);
+
+    Random random;
+    for(std::size_t i = 0; i != 20; ++i) {
+        const Vector2 min{random(), random()};
+        const Range2D region{min, min + Vector2{i*0.5f}};
+
+        std::vector<UnsignedInt> expected;
+        for(std::size_t j = 0; j != boxes.size(); ++j)
+            if((boxes[j].min() <= region.max()).all() && (region.min() <= boxes[j].max()).all())
+                expected.push_back(j);
+
+        CORRADE_COMPARE_AS(hash.query(region), expected, TestSuite::Compare::Container);
+    }
+
+    /* Region larger than the occupied cells */
+    CORRADE_COMPARE(hash.query({{-1000.0f, -1000.0f}, {1000.0f, 1000.0f}}).size(), 500);
+}
+
+void SpatialHashTest::queryRadius() {
+    const std::vector<Range2D> boxes = randomBoxes(500);
+    SpatialHash2D hash{1.5f};
+    for(std::size_t i = 0; i != boxes.size(); ++i) hash.set(i, boxes[i]);
+
+    Random random;
+    for(std::size_t i = 0; i != 20; ++i) {
+        const Vector2 center{random(), random()};
+        const Float radius = i*0.25f;
+
+        std::vector<UnsignedInt> expected;
+        for(std::size_t j = 0; j != boxes.size(); ++j)
+            if(distance(boxes[j], center) <= radius) expected.push_back(j);
+
+        CORRADE_COMPARE_AS(hash.queryRadius(center, radius), expected, TestSuite::Compare::Container);
+    }
+}
+
+void SpatialHashTest::nearest() {
+    const std::vector<Range2D> boxes = randomBoxes(300);
+    SpatialHash2D hash{1.0f};
+    for(std::size_t i = 0; i != boxes.size(); ++i) hash.set(i, boxes[i]);
+
+    Random random;
+    for(const std::size_t count: {1, 2, 5, 17, 300, 1000}) {
+        /* Also points far away from everything */
+        const Vector2 point = Vector2{random(), random()}*(count == 2 ? 10.0f : 1.0f);
+
+        std::vector<std::pair<Float, UnsignedInt>> distances;
+        for(std::size_t j = 0; j != boxes.size(); ++j)
+            distances.emplace_back(distance(boxes[j], point), j);
+        std::sort(distances.begin(), distances.end());
+
+        const std::vector<UnsignedInt> found = hash.nearest(point, count);
+        CORRADE_COMPARE(found.size(), std::min(count, boxes.size()));
+
+        /* Compare distances, there may be ties */
+        for(std::size_t j = 0; j != found.size(); ++j)
+            CORRADE_COMPARE(distance(boxes[found[j]], point), distances[j].first);
+    }
+
+    CORRADE_VERIFY(hash.nearest({}, 0).empty());
+}
+
+void SpatialHashTest::nearestMaxDistance() {
+    SpatialHash2D hash{1.0f};
+    hash.set(0, Vector2{1.0f, 0.0f})
+        .set(1, Vector2{0.0f, 3.0f})
+        .set(2, Vector2{-2.0f, 0.0f})
+        .set(3, Vector2{0.0f, -2.0f});
+
+    CORRADE_COMPARE(hash.nearest({}, 10), (std::vector<UnsignedInt>{0, 2, 3, 1}));
+    CORRADE_COMPARE(hash.nearest({}, 2), (std::vector<UnsignedInt>{0, 2}));
+    CORRADE_COMPARE(hash.nearest({}, 10, 2.5f), (std::vector<UnsignedInt>{0, 2, 3}));
+    CORRADE_COMPARE(hash.nearest({}, 10, 0.5f), (std::vector<UnsignedInt>{}));
+}
+
+void SpatialHashTest::nearestEmpty() {
+    SpatialHash2D hash{1.0f};
+    CORRADE_VERIFY(hash.nearest({1.0e6f, -1.0e6f}, 5).empty());
+
+    /* Everything removed */
+    hash.set(0, Vector2{1.0f, 2.0f}).remove(0);
+    CORRADE_VERIFY(hash.nearest({1.0e6f, -1.0e6f}, 5).empty());
+}
+
+void SpatialHashTest::pairs() {
+    const std::vector<Range2D> boxes = randomBoxes(300);
+    SpatialHash2D hash{0.75f};
+    for(std::size_t i = 0; i != boxes.size(); ++i) hash.set(i, boxes[i]);
+
+    std::vector<std::pair<UnsignedInt, UnsignedInt>> expected;
+    for(std::size_t i = 0; i != boxes.size(); ++i)
+        for(std::size_t j = i + 1; j != boxes.size(); ++j)
+            if((boxes[i].min() <= boxes[j].max()).all() && (boxes[j].min() <= boxes[i].max()).all())
+                expected.emplace_back(i, j);
+
+    CORRADE_VERIFY(!expected.empty());
+    CORRADE_VERIFY(hash.pairs() == expected);
+}
+
+void SpatialHashTest::shapeGroup() {
+    Scene2D scene;
+    ShapeGroup2D shapes;
+
+    Object2D a(&scene);
+    Shape<Shapes::Sphere2D> aShape(a, {{1.0f, -2.0f}, 1.5f}, &shapes);
+
+    Object2D b(&scene);
+    Shape<Shapes::Point2D> bShape(b, {{3.0f, -2.0f}}, &shapes);
+
+    SpatialHash2D hash{1.0f};
+    hash.update(shapes);
+    CORRADE_COMPARE(hash.size(), 2);
+    CORRADE_COMPARE(hash.bounds(0), aShape.bounds());
+    CORRADE_COMPARE(hash.bounds(1), (Range2D{{3.0f, -2.0f}, {3.0f, -2.0f}}));
+    CORRADE_VERIFY(!shapes.isDirty());
+
+    /* Only the moved shape is marked as dirty */
+    const UnsignedInt aDirtyCount = aShape.dirtyCount();
+    const UnsignedInt bDirtyCount = bShape.dirtyCount();
+    b.translate(Vector2::yAxis(2.0f));
+    CORRADE_COMPARE(aShape.dirtyCount(), aDirtyCount);
+    CORRADE_VERIFY(bShape.dirtyCount() > bDirtyCount);
+    hash.update(shapes);
+    CORRADE_COMPARE(hash.bounds(1), (Range2D{{3.0f, 0.0f}, {3.0f, 0.0f}}));
+    CORRADE_COMPARE(hash.query({{2.75f, -0.25f}, {3.25f, 0.25f}}), (std::vector<UnsignedInt>{1}));
+
+    /* Changing the shape itself is detected as well */
+    aShape.setShape({{-5.0f, 0.0f}, 0.5f});
+    hash.update(shapes);
+    CORRADE_COMPARE(hash.bounds(0), (Range2D{{-5.5f, -0.5f}, {-4.5f, 0.5f}}));
+
+    /* Removed shapes are removed from the hash */
+    shapes.remove(bShape);
+    hash.update(shapes);
+    CORRADE_COMPARE(hash.size(), 1);
+    CORRADE_VERIFY(!hash.contains(1));
+}
+
+void SpatialHashTest::shapeGroupCollisions() {
+    Scene2D scene;
+    ShapeGroup2D shapes;
+
+    Object2D a(&scene);
+    Shape<Shapes::Sphere2D> aShape(a, {{1.0f, -2.0f}, 1.5f}, &shapes);
+
+    Object2D b(&scene);
+    Shape<Shapes::Point2D> bShape(b, {{3.0f, -2.0f}}, &shapes);
+
+    Object2D c(&scene);
+    Shape<Shapes::Line2D> cShape(c, {{0.0f, -10.0f}, {1.0f, -10.0f}}, &shapes);
+
+    Object2D d(&scene);
+    Shape<Shapes::Sphere2D> dShape(d, {{-10.0f, 10.0f}, 0.5f}, &shapes);
+
+    SpatialHash2D hash{1.0f};
+    CORRADE_VERIFY(!hash.firstCollision(shapes, aShape));
+    CORRADE_VERIFY(hash.collisionPairs(shapes).empty());
+
+    /* Move the point into the sphere */
+    b.translate(Vector2::xAxis(-1.0f));
+    CORRADE_VERIFY(hash.firstCollision(shapes, aShape) == &bShape);
+    CORRADE_VERIFY(hash.firstCollision(shapes, bShape) == &aShape);
+
+    /* Move a sphere onto the line, which has infinite bounds */
+    d.translate(Vector2::yAxis(-20.0f));
+    CORRADE_VERIFY(hash.firstCollision(shapes, dShape) == &cShape);
+
+    const std::vector<std::pair<AbstractShape2D*, AbstractShape2D*>> pairs = hash.collisionPairs(shapes);
+    CORRADE_COMPARE(pairs.size(), 2);
+    CORRADE_VERIFY(pairs[0].first == &aShape && pairs[0].second == &bShape);
+    CORRADE_VERIFY(pairs[1].first == &cShape && pairs[1].second == &dShape);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Shapes::Test::SpatialHashTest)
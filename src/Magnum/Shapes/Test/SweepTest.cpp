@@ -0,0 +1,318 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shapes/AxisAlignedBox.h"
+#include "Magnum/Shapes/Box.h"
+#include "Magnum/Shapes/Capsule.h"
+#include "Magnum/Shapes/Cylinder.h"
+#include "Magnum/Shapes/LineSegment.h"
+#include "Magnum/Shapes/Plane.h"
+#include "Magnum/Shapes/Point.h"
+#include "Magnum/Shapes/Sphere.h"
+#include "Magnum/Shapes/Sweep.h"
+
+namespace Magnum { namespace Shapes { namespace Test {
+
+struct SweepTest: TestSuite::Tester {
+    explicit SweepTest();
+
+    void spherePoint();
+    void sphereLine();
+    void sphereSphere();
+    void sphereCapsule();
+    void sphereAxisAlignedBox2D();
+    void sphereAxisAlignedBox3D();
+    void sphereBox();
+    void spherePlane();
+
+    void capsulePoint();
+    void capsuleSphere();
+    void capsuleLineSegment();
+    void capsuleCapsule();
+    void capsuleAxisAlignedBox();
+    void capsuleAxisAlignedBoxBruteForce();
+    void capsuleBox();
+    void capsulePlane();
+};
+
+SweepTest::SweepTest() {
+    addTests({&SweepTest::spherePoint,
+              &SweepTest::sphereLine,
+              &SweepTest::sphereSphere,
+              &SweepTest::sphereCapsule,
+              &SweepTest::sphereAxisAlignedBox2D,
+              &SweepTest::sphereAxisAlignedBox3D,
+              &SweepTest::sphereBox,
+              &SweepTest::spherePlane,
+
+              &SweepTest::capsulePoint,
+              &SweepTest::capsuleSphere,
+              &SweepTest::capsuleLineSegment,
+              &SweepTest::capsuleCapsule,
+              &SweepTest::capsuleAxisAlignedBox,
+              &SweepTest::capsuleAxisAlignedBoxBruteForce,
+              &SweepTest::capsuleBox,
+              &SweepTest::capsulePlane});
+}
+
+void SweepTest::spherePoint() {
+    const Shapes::Sphere2D sphere{{}, 1.0f};
+    const Vector2 displacement{10.0f, 0.0f};
+
+    CORRADE_COMPARE(Shapes::sweep(sphere, displacement, Shapes::Point2D{{5.0f, 0.0f}}), 0.4f);
+    CORRADE_COMPARE(Shapes::sweep(sphere, displacement, Shapes::Point2D{{5.0f, 0.6f}}), 0.42f);
+
+    /* Colliding already at the beginning */
+    CORRADE_COMPARE(Shapes::sweep(sphere, displacement, Shapes::Point2D{{0.5f, 0.0f}}), 0.0f);
+
+    /* Missing, behind or too far */
+    CORRADE_COMPARE(Shapes::sweep(sphere, displacement, Shapes::Point2D{{5.0f, 2.0f}}), Constants::inf());
+    CORRADE_COMPARE(Shapes::sweep(sphere, displacement, Shapes::Point2D{{-5.0f, 0.0f}}), Constants::inf());
+    CORRADE_COMPARE(Shapes::sweep(sphere, displacement, Shapes::Point2D{{12.0f, 0.0f}}), Constants::inf());
+
+    /* Not moving at all */
+    CORRADE_COMPARE(Shapes::sweep(sphere, {}, Shapes::Point2D{{5.0f, 0.0f}}), Constants::inf());
+    CORRADE_COMPARE(Shapes::sweep(sphere, {}, Shapes::Point2D{{0.5f, 0.0f}}), 0.0f);
+}
+
+void SweepTest::sphereLine() {
+    const Shapes::Sphere3D sphere{{}, 1.0f};
+    const Vector3 displacement{10.0f, 0.0f, 0.0f};
+
+    CORRADE_COMPARE(Shapes::sweep(sphere, displacement, Shapes::Line3D{{5.0f, -1.0f, 0.0f}, {5.0f, 1.0f, 0.0f}}), 0.4f);
+    CORRADE_COMPARE(Shapes::sweep(sphere, displacement, Shapes::LineSegment3D{{5.0f, -1.0f, 0.0f}, {5.0f, 1.0f, 0.0f}}), 0.4f);
+    CORRADE_COMPARE(Shapes::sweep(sphere, displacement, Shapes::LineSegment3D{{5.0f, 2.0f, 0.0f}, {5.0f, 3.0f, 0.0f}}), Constants::inf());
+    CORRADE_COMPARE(Shapes::sweep(sphere, displacement, Shapes::Cylinder3D{{5.0f, 2.0f, 0.0f}, {5.0f, 3.0f, 0.0f}, 0.5f}), 0.35f);
+}
+
+void SweepTest::sphereSphere() {
+    const Shapes::Sphere3D sphere{{}, 1.0f};
+
+    CORRADE_COMPARE(Shapes::sweep(sphere, {10.0f, 0.0f, 0.0f}, Shapes::Sphere3D{{5.0f, 0.0f, 0.0f}, 1.0f}), 0.3f);
+    CORRADE_COMPARE(Shapes::sweep(sphere, {10.0f, 0.0f, 0.0f}, Shapes::Sphere3D{{5.0f, 2.5f, 0.0f}, 1.0f}), Constants::inf());
+
+    /* Thin and fast, would be skipped when testing only at the end */
+    const Shapes::Sphere3D other{{5.0f, 0.0f, 0.0f}, 0.1f};
+    CORRADE_VERIFY(!(Shapes::Sphere3D{{100.0f, 0.0f, 0.0f}, 1.0f} % other));
+    CORRADE_COMPARE(Shapes::sweep(sphere, {100.0f, 0.0f, 0.0f}, other), 0.039f);
+}
+
+void SweepTest::sphereCapsule() {
+    const Shapes::Sphere2D sphere{{}, 1.0f};
+    const Vector2 displacement{10.0f, 0.0f};
+
+    CORRADE_COMPARE(Shapes::sweep(sphere, displacement, Shapes::Capsule2D{{5.0f, -1.0f}, {5.0f, 1.0f}, 0.5f}), 0.35f);
+
+    /* Touching the end sphere */
+    CORRADE_COMPARE(Shapes::sweep(sphere, displacement, Shapes::Capsule2D{{5.0f, 1.5f}, {5.0f, 3.0f}, 0.5f}), 0.5f);
+}
+
+void SweepTest::sphereAxisAlignedBox2D() {
+    const Shapes::AxisAlignedBox2D box{{4.0f, -1.0f}, {6.0f, 1.0f}};
+    const Vector2 displacement{10.0f, 0.0f};
+
+    /* Face, corner, miss */
+    CORRADE_COMPARE(Shapes::sweep(Shapes::Sphere2D{{}, 1.0f}, displacement, box), 0.3f);
+    CORRADE_COMPARE(Shapes::sweep(Shapes::Sphere2D{{0.0f, 1.5f}, 1.0f}, displacement, box), (4.0f - Math::sqrt(0.75f))/10.0f);
+    CORRADE_COMPARE(Shapes::sweep(Shapes::Sphere2D{{0.0f, 2.5f}, 1.0f}, displacement, box), Constants::inf());
+
+    /* Inside */
+    CORRADE_COMPARE(Shapes::sweep(Shapes::Sphere2D{{5.0f, 0.0f}, 0.5f}, displacement, box), 0.0f);
+}
+
+void SweepTest::sphereAxisAlignedBox3D() {
+    const Shapes::AxisAlignedBox3D box{{4.0f, -1.0f, -1.0f}, {6.0f, 1.0f, 1.0f}};
+    const Vector3 displacement{10.0f, 0.0f, 0.0f};
+
+    /* Face, edge, vertex, miss */
+    CORRADE_COMPARE(Shapes::sweep(Shapes::Sphere3D{{}, 1.0f}, displacement, box), 0.3f);
+    CORRADE_COMPARE(Shapes::sweep(Shapes::Sphere3D{{0.0f, 1.5f, 0.0f}, 1.0f}, displacement, box), (4.0f - Math::sqrt(0.75f))/10.0f);
+    CORRADE_COMPARE(Shapes::sweep(Shapes::Sphere3D{{0.0f, 1.5f, 1.5f}, 1.0f}, displacement, box), (4.0f - Math::sqrt(0.5f))/10.0f);
+    CORRADE_COMPARE(Shapes::sweep(Shapes::Sphere3D{{0.0f, 1.8f, 1.8f}, 1.0f}, displacement, box), Constants::inf());
+
+    /* Moving away */
+    CORRADE_COMPARE(Shapes::sweep(Shapes::Sphere3D{{}, 1.0f}, -displacement, box), Constants::inf());
+}
+
+void SweepTest::sphereBox() {
+    /* Box rotated so the corner points to the sphere */
+    const Shapes::Box2D box{Matrix3::translation(Vector2::xAxis(5.0f))*Matrix3::rotation(Deg(45.0f))};
+    CORRADE_COMPARE(Shapes::sweep(Shapes::Sphere2D{{}, 1.0f}, {10.0f, 0.0f}, box), (4.0f - Constants::sqrt2())/10.0f);
+
+    /* Scaled box */
+    const Shapes::Box3D box3D{Matrix4::translation(Vector3::xAxis(5.0f))*Matrix4::scaling({2.0f, 0.5f, 0.5f})};
+    CORRADE_COMPARE(Shapes::sweep(Shapes::Sphere3D{{}, 1.0f}, {10.0f, 0.0f, 0.0f}, box3D), 0.2f);
+    CORRADE_COMPARE(Shapes::sweep(Shapes::Sphere3D{{5.0f, 2.0f, 0.0f}, 1.0f}, {0.0f, -10.0f, 0.0f}, box3D), 0.05f);
+}
+
+void SweepTest::spherePlane() {
+    const Shapes::Plane plane{{5.0f, 0.0f, 0.0f}, Vector3::xAxis()};
+
+    CORRADE_COMPARE(Shapes::sweep(Shapes::Sphere3D{{}, 1.0f}, {10.0f, 0.0f, 0.0f}, plane), 0.4f);
+    CORRADE_COMPARE(Shapes::sweep(Shapes::Sphere3D{{10.0f, 0.0f, 0.0f}, 1.0f}, {-10.0f, 0.0f, 0.0f}, plane), 0.4f);
+    CORRADE_COMPARE(Shapes::sweep(Shapes::Sphere3D{{5.5f, 0.0f, 0.0f}, 1.0f}, {0.0f, 10.0f, 0.0f}, plane), 0.0f);
+    CORRADE_COMPARE(Shapes::sweep(Shapes::Sphere3D{{}, 1.0f}, {0.0f, 10.0f, 0.0f}, plane), Constants::inf());
+}
+
+void SweepTest::capsulePoint() {
+    const Shapes::Capsule2D capsule{{0.0f, -1.0f}, {0.0f, 1.0f}, 0.5f};
+    const Vector2 displacement{10.0f, 0.0f};
+
+    CORRADE_COMPARE(Shapes::sweep(capsule, displacement, Shapes::Point2D{{5.0f, 0.5f}}), 0.45f);
+    CORRADE_COMPARE(Shapes::sweep(capsule, displacement, Shapes::Point2D{{5.0f, 1.3f}}), 0.46f);
+    CORRADE_COMPARE(Shapes::sweep(capsule, displacement, Shapes::Point2D{{5.0f, 1.6f}}), Constants::inf());
+    CORRADE_COMPARE(Shapes::sweep(capsule, displacement, Shapes::Point2D{{-5.0f, 0.0f}}), Constants::inf());
+}
+
+void SweepTest::capsuleSphere() {
+    const Shapes::Capsule3D capsule{{0.0f, -1.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, 0.5f};
+
+    CORRADE_COMPARE(Shapes::sweep(capsule, {10.0f, 0.0f, 0.0f}, Shapes::Sphere3D{{5.0f, 0.0f, 0.0f}, 1.0f}), 0.35f);
+    CORRADE_COMPARE(Shapes::sweep(capsule, {10.0f, 0.0f, 0.0f}, Shapes::Sphere3D{{5.0f, 3.0f, 0.0f}, 1.0f}), Constants::inf());
+}
+
+void SweepTest::capsuleLineSegment() {
+    /* Crossing segments, the closest points are inside both */
+    const Shapes::Capsule3D capsule{{0.0f, 0.0f, -1.0f}, {0.0f, 0.0f, 1.0f}, 0.5f};
+    const Vector3 displacement{10.0f, 0.0f, 0.0f};
+    CORRADE_COMPARE(Shapes::sweep(capsule, displacement, Shapes::LineSegment3D{{5.0f, -1.0f, 0.3f}, {5.0f, 1.0f, 0.3f}}), 0.45f);
+
+    /* Parallel segments */
+    CORRADE_COMPARE(Shapes::sweep(capsule, displacement, Shapes::LineSegment3D{{5.0f, 0.0f, -3.0f}, {5.0f, 0.0f, 3.0f}}), 0.45f);
+
+    /* End of the capsule */
+    CORRADE_COMPARE(Shapes::sweep(capsule, displacement, Shapes::LineSegment3D{{5.0f, -1.0f, 1.3f}, {5.0f, 1.0f, 1.3f}}), 0.46f);
+    CORRADE_COMPARE(Shapes::sweep(capsule, displacement, Shapes::LineSegment3D{{5.0f, -1.0f, 1.6f}, {5.0f, 1.0f, 1.6f}}), Constants::inf());
+
+    /* 2D */
+    CORRADE_COMPARE(Shapes::sweep(Shapes::Capsule2D{{0.0f, -1.0f}, {0.0f, 1.0f}, 0.5f}, {10.0f, 0.0f}, Shapes::LineSegment2D{{5.0f, 0.5f}, {8.0f, 3.5f}}), 0.45f);
+}
+
+void SweepTest::capsuleCapsule() {
+    const Shapes::Capsule3D capsule{{0.0f, 0.0f, -1.0f}, {0.0f, 0.0f, 1.0f}, 0.25f};
+    CORRADE_COMPARE(Shapes::sweep(capsule, {10.0f, 0.0f, 0.0f}, Shapes::Capsule3D{{5.0f, -1.0f, 0.0f}, {5.0f, 1.0f, 0.0f}, 0.25f}), 0.45f);
+    CORRADE_COMPARE(Shapes::sweep(capsule, {10.0f, 0.0f, 0.0f}, Shapes::Capsule3D{{5.0f, 2.0f, 0.0f}, {5.0f, 3.0f, 0.0f}, 0.25f}), Constants::inf());
+}
+
+void SweepTest::capsuleAxisAlignedBox() {
+    /* Capsule longer than the box, hitting the face with its side */
+    const Shapes::AxisAlignedBox2D box{{4.0f, -1.0f}, {6.0f, 1.0f}};
+    CORRADE_COMPARE(Shapes::sweep(Shapes::Capsule2D{{0.0f, -3.0f}, {0.0f, 3.0f}, 0.5f}, {10.0f, 0.0f}, box), 0.35f);
+
+    /* Hitting the corner with its side */
+    CORRADE_COMPARE(Shapes::sweep(Shapes::Capsule2D{{-2.0f, 2.0f}, {2.0f, -2.0f}, 0.5f}, {0.0f, -10.0f}, Shapes::AxisAlignedBox2D{{-3.0f, -9.0f}, {0.0f, -8.0f}}), (8.0f - 0.5f*Constants::sqrt2())/10.0f);
+
+    /* Parallel with box edge in 3D */
+    const Shapes::AxisAlignedBox3D box3D{{4.0f, -1.0f, -1.0f}, {6.0f, 1.0f, 1.0f}};
+    CORRADE_COMPARE(Shapes::sweep(Shapes::Capsule3D{{0.0f, 1.3f, -3.0f}, {0.0f, 1.3f, 3.0f}, 0.5f}, {10.0f, 0.0f, 0.0f}, box3D), 0.36f);
+    CORRADE_COMPARE(Shapes::sweep(Shapes::Capsule3D{{0.0f, 1.6f, -3.0f}, {0.0f, 1.6f, 3.0f}, 0.5f}, {10.0f, 0.0f, 0.0f}, box3D), Constants::inf());
+}
+
+namespace {
+    /* Poor man's random numbers, deterministic */
+    Float value(UnsignedInt i) {
+        UnsignedInt x = i*2654435761u;
+        x ^= x >> 13;
+        x *= 0x5bd1e995u;
+        x ^= x >> 15;
+        return Float(x & 0xffff)/Float(0xffff);
+    }
+
+    Vector3 vector(UnsignedInt i) {
+        return {value(3*i), value(3*i + 1), value(3*i + 2)};
+    }
+
+    /* Distance of a capsule axis to a box, by sampling the axis */
+    Float distance(const Vector3& a, const Vector3& b, const Shapes::AxisAlignedBox3D& box) {
+        Float out = Constants::inf();
+        for(Int i = 0; i <= 256; ++i) {
+            const Vector3 point = Math::lerp(a, b, i/256.0f);
+            out = Math::min(out, (point - Math::clamp(point, box.min(), box.max())).length());
+        }
+        return out;
+    }
+}
+
+void SweepTest::capsuleAxisAlignedBoxBruteForce() {
+    const Shapes::AxisAlignedBox3D box{{-1.0f, -0.5f, -0.25f}, {1.0f, 0.5f, 0.25f}};
+
+    for(UnsignedInt i = 0; i != 32; ++i) {
+        /* Capsules around the box, moving through its neighborhood */
+        const Vector3 a = vector(4*i)*6.0f - Vector3{3.0f};
+        const Vector3 b = a + vector(4*i + 1)*2.0f - Vector3{1.0f};
+        const Vector3 displacement = vector(4*i + 2)*2.0f - Vector3{1.0f} - a;
+        const Float radius = 0.1f + value(16*i + 3)*0.4f;
+
+        /* First time the capsule touches the box when stepping in small
+           increments */
+        Float expected = Constants::inf();
+        for(Int step = 0; step <= 2048; ++step) {
+            const Float t = step/2048.0f;
+            if(distance(a + displacement*t, b + displacement*t, box) <= radius) {
+                expected = t;
+                break;
+            }
+        }
+
+        const Float actual = Shapes::sweep(Shapes::Capsule3D{a, b, radius}, displacement, box);
+        if(expected == Constants::inf()) {
+            CORRADE_COMPARE(actual, Constants::inf());
+        } else {
+            CORRADE_VERIFY(actual <= expected);
+            CORRADE_VERIFY(actual > expected - 0.005f);
+        }
+    }
+}
+
+void SweepTest::capsuleBox() {
+    /* Rotated box, the capsule hits its corner */
+    const Shapes::Box3D box{Matrix4::translation(Vector3::xAxis(5.0f))*Matrix4::rotationZ(Deg(45.0f))};
+    CORRADE_COMPARE(Shapes::sweep(Shapes::Capsule3D{{0.0f, 0.0f, -3.0f}, {0.0f, 0.0f, 3.0f}, 0.5f}, {10.0f, 0.0f, 0.0f}, box), (4.5f - Constants::sqrt2())/10.0f);
+}
+
+void SweepTest::capsulePlane() {
+    const Shapes::Plane plane{{5.0f, 0.0f, 0.0f}, Vector3::xAxis()};
+    const Vector3 displacement{10.0f, 0.0f, 0.0f};
+
+    /* The nearer end touches first */
+    CORRADE_COMPARE(Shapes::sweep(Shapes::Capsule3D{{0.0f, 0.0f, 0.0f}, {2.0f, 0.0f, 0.0f}, 0.5f}, displacement, plane), 0.25f);
+    CORRADE_COMPARE(Shapes::sweep(Shapes::Capsule3D{{2.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, 0.5f}, displacement, plane), 0.25f);
+
+    /* Already crossing the plane */
+    CORRADE_COMPARE(Shapes::sweep(Shapes::Capsule3D{{0.0f, 0.0f, 0.0f}, {7.0f, 0.0f, 0.0f}, 0.5f}, displacement, plane), 0.0f);
+
+    /* Parallel */
+    CORRADE_COMPARE(Shapes::sweep(Shapes::Capsule3D{{0.0f, 0.0f, 0.0f}, {2.0f, 0.0f, 0.0f}, 0.5f}, {0.0f, 10.0f, 0.0f}, plane), Constants::inf());
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Shapes::Test::SweepTest)
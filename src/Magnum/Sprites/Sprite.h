@@ -0,0 +1,114 @@
+#ifndef Magnum_Sprites_Sprite_h
+#define Magnum_Sprites_Sprite_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Sprites::Sprite
+ */
+
+#include "Magnum/Math/Color.h"
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/Sprites/Sprites.h"
+#include "Magnum/Sprites/visibility.h"
+
+namespace Magnum { namespace Sprites {
+
+/**
+@brief Sprite drawable
+
+Adds a sprite with the camera-relative object transformation to a
+@ref SpriteBatch when drawn. See @ref Sprites-SpriteBatch-scenegraph for an
+usage example.
+*/
+class MAGNUM_SPRITES_EXPORT Sprite: public SceneGraph::Drawable2D {
+    public:
+        /**
+         * @brief Constructor
+         * @param object    Object to attach the sprite to
+         * @param batch     Sprite batch
+         * @param frame     Frame ID in the batch
+         * @param drawables Group in which the sprite will be drawn
+         *
+         * The sprite is added to object's features.
+         */
+        explicit Sprite(SceneGraph::AbstractObject2D& object, SpriteBatch& batch, UnsignedInt frame, SceneGraph::DrawableGroup2D* drawables = nullptr);
+
+        /** @brief Sprite batch */
+        SpriteBatch& batch() { return *_batch; }
+        const SpriteBatch& batch() const { return *_batch; } /**< @overload */
+
+        /** @brief Frame ID */
+        UnsignedInt frame() const { return _frame; }
+
+        /**
+         * @brief Set frame ID
+         * @return Reference to self (for method chaining)
+         */
+        Sprite& setFrame(UnsignedInt frame) {
+            _frame = frame;
+            return *this;
+        }
+
+        /** @brief Layer */
+        Int layer() const { return _layer; }
+
+        /**
+         * @brief Set layer
+         * @return Reference to self (for method chaining)
+         *
+         * Lower layers are drawn first. Default is `0`.
+         */
+        Sprite& setLayer(Int layer) {
+            _layer = layer;
+            return *this;
+        }
+
+        /** @brief Color */
+        Color4 color() const { return _color; }
+
+        /**
+         * @brief Set color
+         * @return Reference to self (for method chaining)
+         *
+         * Default is `{1.0f, 1.0f, 1.0f, 1.0f}`.
+         */
+        Sprite& setColor(const Color4& color) {
+            _color = color;
+            return *this;
+        }
+
+    private:
+        void draw(const Matrix3& transformationMatrix, SceneGraph::Camera2D& camera) override;
+
+        SpriteBatch* _batch;
+        UnsignedInt _frame;
+        Int _layer;
+        Color4 _color;
+};
+
+}}
+
+#endif
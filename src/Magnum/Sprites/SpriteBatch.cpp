@@ -0,0 +1,225 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SpriteBatch.h"
+
+#include <algorithm>
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/MeshView.h"
+#include "Magnum/Texture.h"
+#include "Magnum/Shaders/Flat.h"
+
+#ifndef MAGNUM_TARGET_GLES
+#include "Magnum/BufferRing.h"
+#endif
+
+namespace Magnum { namespace Sprites {
+
+namespace {
+    template<class T> Containers::Array<char> quadIndices(const UnsignedInt capacity) {
+        Containers::Array<char> data{capacity*6*sizeof(T)};
+        T* indices = reinterpret_cast<T*>(data.data());
+        for(UnsignedInt i = 0; i != capacity; ++i) {
+            const T vertex = i*4;
+            indices[i*6 + 0] = vertex + 0;
+            indices[i*6 + 1] = vertex + 1;
+            indices[i*6 + 2] = vertex + 2;
+            indices[i*6 + 3] = vertex + 0;
+            indices[i*6 + 4] = vertex + 2;
+            indices[i*6 + 5] = vertex + 3;
+        }
+        return data;
+    }
+
+    /* Layer in the upper half with the sign flipped so negative layers sort
+       before positive ones, texture ID in the lower half */
+    inline std::uint64_t sortKey(const Int layer, const UnsignedInt texture) {
+        return (std::uint64_t(UnsignedInt(layer)^0x80000000u) << 32)|texture;
+    }
+}
+
+SpriteBatch::SpriteBatch(NoCreateT, const UnsignedInt capacity): _capacity{capacity}, _indexBuffer{NoCreate}, _vertexBuffer{NoCreate}, _mesh{NoCreate} {
+    CORRADE_ASSERT(capacity, "Sprites::SpriteBatch: capacity can't be zero", );
+    _sprites.reserve(capacity);
+    _order.reserve(capacity);
+}
+
+SpriteBatch::SpriteBatch(const UnsignedInt capacity): SpriteBatch{NoCreate, capacity} {
+    _shader.reset(new Shaders::Flat2D{Shaders::Flat2D::Flags{Shaders::Flat2D::Flag::Textured}|Shaders::Flat2D::Flag::VertexColor});
+
+    /* With 16-bit indices all vertices of the capacity have to fit */
+    _indexBuffer = Buffer{Buffer::TargetHint::ElementArray};
+    Mesh::IndexType indexType;
+    if(std::uint64_t(capacity)*4 <= 65536) {
+        _indexBuffer.setData(quadIndices<UnsignedShort>(capacity), BufferUsage::StaticDraw);
+        indexType = Mesh::IndexType::UnsignedShort;
+    } else {
+        _indexBuffer.setData(quadIndices<UnsignedInt>(capacity), BufferUsage::StaticDraw);
+        indexType = Mesh::IndexType::UnsignedInt;
+    }
+
+    Buffer* vertexBuffer;
+    #ifndef MAGNUM_TARGET_GLES
+    if(Context::current().isExtensionSupported<Extensions::GL::ARB::buffer_storage>()) {
+        _ring.reset(new BufferRing{Buffer::TargetHint::Array, GLsizeiptr(capacity*4*sizeof(SpriteVertex))});
+        vertexBuffer = &_ring->buffer();
+    } else
+    #endif
+    {
+        _vertexBuffer = Buffer{Buffer::TargetHint::Array};
+        _vertices = Containers::Array<SpriteVertex>{capacity*4};
+        vertexBuffer = &_vertexBuffer;
+    }
+
+    _mesh = Mesh{};
+    _mesh.setPrimitive(MeshPrimitive::Triangles)
+        .addVertexBuffer(*vertexBuffer, 0,
+            Shaders::Flat2D::Position{},
+            Shaders::Flat2D::TextureCoordinates{},
+            Shaders::Flat2D::Color{Shaders::Flat2D::Color::Components::Four})
+        .setIndexBuffer(_indexBuffer, 0, indexType, 0, capacity*4 - 1);
+}
+
+SpriteBatch::~SpriteBatch() = default;
+
+UnsignedInt SpriteBatch::addTexture(Texture2D& texture) {
+    _textures.push_back(&texture);
+    return _textures.size() - 1;
+}
+
+UnsignedInt SpriteBatch::addFrame(const UnsignedInt texture, const Range2D& textureCoordinates, const Vector2& size) {
+    CORRADE_ASSERT(texture < _textures.size(),
+        "Sprites::SpriteBatch::addFrame(): texture ID" << texture << "out of range for" << _textures.size() << "textures", {});
+    _frames.push_back({textureCoordinates, size*0.5f, texture});
+    return _frames.size() - 1;
+}
+
+UnsignedInt SpriteBatch::addFrames(const UnsignedInt texture, const Vector2i& textureSize, const std::vector<Range2Di>& rectangles) {
+    CORRADE_ASSERT(texture < _textures.size(),
+        "Sprites::SpriteBatch::addFrames(): texture ID" << texture << "out of range for" << _textures.size() << "textures", {});
+    const UnsignedInt first = _frames.size();
+    const Vector2 scale = 1.0f/Vector2{textureSize};
+    _frames.reserve(_frames.size() + rectangles.size());
+    for(const Range2Di& rectangle: rectangles)
+        _frames.push_back({Range2D{rectangle}.scaled(scale), Vector2{rectangle.size()}*0.5f, texture});
+    return first;
+}
+
+SpriteBatch& SpriteBatch::add(const UnsignedInt frame, const Matrix3& transformation, const Int layer, const Color4& color) {
+    CORRADE_ASSERT(frame < _frames.size(),
+        "Sprites::SpriteBatch::add(): frame ID" << frame << "out of range for" << _frames.size() << "frames", *this);
+    CORRADE_ASSERT(_sprites.size() < _capacity,
+        "Sprites::SpriteBatch::add(): capacity of" << _capacity << "sprites exceeded", *this);
+
+    /* Save only the affine part, pre-scaled by the quad size */
+    const Vector2 halfSize = _frames[frame].halfSize;
+    _sprites.push_back({transformation.translation(),
+        transformation.right()*halfSize.x(),
+        transformation.up()*halfSize.y(), color, frame, layer});
+    return *this;
+}
+
+SpriteBatch& SpriteBatch::clear() {
+    _sprites.clear();
+    return *this;
+}
+
+UnsignedInt SpriteBatch::writeVertices(const Containers::ArrayView<SpriteVertex> vertices) {
+    CORRADE_ASSERT(vertices.size() >= _sprites.size()*4,
+        "Sprites::SpriteBatch::writeVertices(): expected at least" << _sprites.size()*4 << "vertices, got" << vertices.size(), {});
+
+    /* Sort by layer and texture. The index is part of the compared pair, so
+       the original order is kept inside each run. Sprites are usually added
+       in a coherent order, so check that first to avoid the sort. */
+    _order.clear();
+    for(std::size_t i = 0; i != _sprites.size(); ++i)
+        _order.emplace_back(sortKey(_sprites[i].layer, _frames[_sprites[i].frame].texture), i);
+    if(!std::is_sorted(_order.begin(), _order.end()))
+        std::sort(_order.begin(), _order.end());
+
+    _batches.clear();
+    for(std::size_t i = 0; i != _order.size(); ++i) {
+        const Instance& sprite = _sprites[_order[i].second];
+        const Frame& frame = _frames[sprite.frame];
+
+        if(_batches.empty() || (i && _order[i].first != _order[i - 1].first))
+            _batches.push_back({frame.texture, sprite.layer, UnsignedInt(i), 0});
+        ++_batches.back().count;
+
+        const Range2D& t = frame.textureCoordinates;
+        SpriteVertex* const v = vertices.data() + i*4;
+        v[0] = {sprite.center - sprite.xAxis - sprite.yAxis, t.bottomLeft(), sprite.color};
+        v[1] = {sprite.center + sprite.xAxis - sprite.yAxis, t.bottomRight(), sprite.color};
+        v[2] = {sprite.center + sprite.xAxis + sprite.yAxis, t.topRight(), sprite.color};
+        v[3] = {sprite.center - sprite.xAxis + sprite.yAxis, t.topLeft(), sprite.color};
+    }
+
+    return _sprites.size();
+}
+
+SpriteBatch& SpriteBatch::draw(const Matrix3& projectionMatrix) {
+    CORRADE_ASSERT(_shader,
+        "Sprites::SpriteBatch::draw(): the batch was created without OpenGL objects", *this);
+    if(_sprites.empty()) return *this;
+
+    Int baseVertex = 0;
+    #ifndef MAGNUM_TARGET_GLES
+    if(_ring) {
+        /* Aligning to vertex size makes the offset expressible in vertices */
+        const std::pair<GLintptr, Containers::ArrayView<char>> allocation = _ring->allocate(GLsizeiptr(_sprites.size())*4*sizeof(SpriteVertex), sizeof(SpriteVertex));
+        writeVertices(Containers::arrayCast<SpriteVertex>(allocation.second));
+        baseVertex = allocation.first/sizeof(SpriteVertex);
+    } else
+    #endif
+    {
+        const UnsignedInt count = writeVertices(_vertices);
+        _vertexBuffer.setData({_vertices.data(), count*4*sizeof(SpriteVertex)}, BufferUsage::StreamDraw);
+    }
+
+    _shader->setTransformationProjectionMatrix(projectionMatrix);
+
+    MeshView view{_mesh};
+    for(const Batch& batch: _batches) {
+        view.setCount(batch.count*6)
+            .setIndexRange(batch.offset*6);
+        #ifndef MAGNUM_TARGET_GLES
+        view.setBaseVertex(baseVertex);
+        #endif
+        _shader->setTexture(*_textures[batch.texture]);
+        view.draw(*_shader);
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(_ring) _ring->nextFrame();
+    #else
+    static_cast<void>(baseVertex);
+    #endif
+
+    return clear();
+}
+
+}}
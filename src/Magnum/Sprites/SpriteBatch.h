@@ -0,0 +1,297 @@
+#ifndef Magnum_Sprites_SpriteBatch_h
+#define Magnum_Sprites_SpriteBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Sprites::SpriteBatch, struct @ref Magnum::Sprites::SpriteVertex
+ */
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Shaders/Shaders.h"
+#include "Magnum/Sprites/Sprites.h"
+#include "Magnum/Sprites/visibility.h"
+
+namespace Magnum { namespace Sprites {
+
+/**
+@brief Sprite vertex
+
+Layout of a single vertex written by @ref SpriteBatch::writeVertices(). Each
+sprite is a quad of four vertices in counterclockwise order, starting at the
+bottom left corner.
+*/
+struct SpriteVertex {
+    /** @brief Position, transformed by the sprite transformation */
+    Vector2 position;
+
+    /** @brief Texture coordinates */
+    Vector2 textureCoordinates;
+
+    /** @brief Color */
+    Color4 color;
+};
+
+/**
+@brief Sprite batch
+
+Renders large amounts of textured 2D quads with a minimal number of draw
+calls. Textures are registered with @ref addTexture(), rectangles inside them
+(for example a result of @ref TextureTools::atlas()) with @ref addFrames().
+Each frame, sprites referencing these rectangles are added with @ref add()
+and then drawn at once with @ref draw(), which sorts them by layer and
+texture, streams their vertices to the GPU and issues one draw call for every
+run of sprites sharing the same layer and texture. Lower layers are drawn
+first, sprites in the same layer and texture are drawn in the order they were
+added.
+@code
+std::vector<Vector2i> sizes;
+// fill sizes of all images...
+std::vector<Range2Di> rectangles = TextureTools::atlas({1024, 1024}, sizes);
+
+Texture2D texture;
+// upload the images to positions given by rectangles...
+
+Sprites::SpriteBatch batch{100000};
+UnsignedInt firstFrame = batch.addFrames(batch.addTexture(texture), {1024, 1024}, rectangles);
+
+// each frame
+batch.add(firstFrame + 3, Matrix3::translation({16.0f, 32.0f}))
+     .add(firstFrame + 7, Matrix3::rotation(35.0_degf), 1);
+batch.draw(projection);
+@endcode
+
+The quad of each sprite has the pixel size of its frame, is centered at the
+origin and transformed by the matrix passed to @ref add(). Only the affine
+part of the matrix is used.
+
+@section Sprites-SpriteBatch-scenegraph Integration with SceneGraph
+
+For sprites attached to @ref SceneGraph objects, use the @ref Sprite drawable.
+Drawing a drawable group with @ref SceneGraph::Camera2D::draw() then only
+adds the sprites with their camera-relative transformation to the batch, the
+transformations are calculated in one batch by the scene graph:
+@code
+SceneGraph::DrawableGroup2D sprites;
+new Sprites::Sprite{object, batch, firstFrame, &sprites};
+
+// each frame
+camera.draw(sprites);
+batch.draw(camera.projectionMatrix());
+@endcode
+
+@section Sprites-SpriteBatch-streaming Vertex streaming
+
+If @extension{ARB,buffer_storage} is supported, vertices are written directly
+to a persistently mapped @ref BufferRing with three regions, each
+@ref draw() consumes one region. Otherwise the vertices are written to a
+temporary array and uploaded with @ref Buffer::setData(), letting the driver
+orphan the previous contents.
+
+The index buffer is created once for the whole capacity. If capacity is
+16384 sprites or less, 16-bit indices are used, otherwise 32-bit indices are
+needed, which require @extension{OES,element_index_uint} in OpenGL ES 2.0
+and @webgl_extension{OES,element_index_uint} in WebGL 1.0.
+*/
+class MAGNUM_SPRITES_EXPORT SpriteBatch {
+    public:
+        /**
+         * @brief Draw batch
+         *
+         * @see @ref batches()
+         */
+        struct Batch {
+            UnsignedInt texture;    /**< @brief Texture ID */
+            Int layer;              /**< @brief Layer */
+            UnsignedInt offset;     /**< @brief Offset of first sprite */
+            UnsignedInt count;      /**< @brief Sprite count */
+        };
+
+        /**
+         * @brief Constructor
+         * @param capacity  Max count of sprites drawn in a single @ref draw()
+         *
+         * Creates the shader, the index buffer and the vertex buffer.
+         */
+        explicit SpriteBatch(UnsignedInt capacity);
+
+        /**
+         * @brief Construct without creating the underlying OpenGL objects
+         *
+         * Sprites can be added, sorted and their vertices written using
+         * @ref writeVertices(), but calling @ref draw() on such batch is
+         * not allowed.
+         */
+        explicit SpriteBatch(NoCreateT, UnsignedInt capacity);
+
+        /** @brief Copying is not allowed */
+        SpriteBatch(const SpriteBatch&) = delete;
+
+        /** @brief Moving is not allowed */
+        SpriteBatch(SpriteBatch&&) = delete;
+
+        ~SpriteBatch();
+
+        /** @brief Copying is not allowed */
+        SpriteBatch& operator=(const SpriteBatch&) = delete;
+
+        /** @brief Moving is not allowed */
+        SpriteBatch& operator=(SpriteBatch&&) = delete;
+
+        /** @brief Max count of sprites drawn in a single @ref draw() */
+        UnsignedInt capacity() const { return _capacity; }
+
+        /** @brief Count of added textures */
+        UnsignedInt textureCount() const { return _textures.size(); }
+
+        /**
+         * @brief Add a texture
+         * @return ID of the texture
+         *
+         * The texture is referenced, not copied, it has to stay alive for
+         * the whole batch lifetime.
+         */
+        UnsignedInt addTexture(Texture2D& texture);
+
+        /** @brief Count of added frames */
+        UnsignedInt frameCount() const { return _frames.size(); }
+
+        /**
+         * @brief Add a frame
+         * @param texture               Texture ID
+         * @param textureCoordinates    Normalized texture coordinates
+         * @param size                  Quad size
+         * @return ID of the frame
+         */
+        UnsignedInt addFrame(UnsignedInt texture, const Range2D& textureCoordinates, const Vector2& size);
+
+        /**
+         * @brief Add frames from an atlas
+         * @param texture       Texture ID
+         * @param textureSize   Texture size in pixels
+         * @param rectangles    Rectangles in pixels, for example returned by
+         *      @ref TextureTools::atlas()
+         * @return ID of the first frame, the rest have consecutive IDs
+         *
+         * Quad size of every frame is size of its rectangle.
+         */
+        UnsignedInt addFrames(UnsignedInt texture, const Vector2i& textureSize, const std::vector<Range2Di>& rectangles);
+
+        /** @brief Count of sprites added since last @ref clear() */
+        UnsignedInt spriteCount() const { return _sprites.size(); }
+
+        /**
+         * @brief Add a sprite
+         * @param frame             Frame ID
+         * @param transformation    Sprite transformation
+         * @param layer             Layer, lower layers are drawn first
+         * @param color             Color to multiply the texture with
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that count of sprites doesn't exceed @ref capacity().
+         */
+        SpriteBatch& add(UnsignedInt frame, const Matrix3& transformation, Int layer = 0, const Color4& color = Color4{1.0f});
+
+        /**
+         * @brief Remove all sprites
+         * @return Reference to self (for method chaining)
+         *
+         * Called implicitly at the end of @ref draw().
+         */
+        SpriteBatch& clear();
+
+        /**
+         * @brief Sort the sprites and write their vertices
+         * @return Count of written sprites
+         *
+         * Sorts the sprites by layer and texture, writes four vertices for
+         * each sprite into @p vertices and updates @ref batches(). Expects
+         * that @p vertices is large enough for all sprites. Called
+         * implicitly by @ref draw().
+         */
+        UnsignedInt writeVertices(Containers::ArrayView<SpriteVertex> vertices);
+
+        /**
+         * @brief Draw batches
+         *
+         * Runs of sprites sharing the same layer and texture, filled by
+         * @ref writeVertices().
+         */
+        const std::vector<Batch>& batches() const { return _batches; }
+
+        /**
+         * @brief Draw the sprites
+         * @return Reference to self (for method chaining)
+         *
+         * Calls @ref writeVertices() into the streaming vertex buffer, draws
+         * each of @ref batches() with @p projectionMatrix and then
+         * @ref clear().
+         */
+        SpriteBatch& draw(const Matrix3& projectionMatrix);
+
+    private:
+        struct Frame {
+            Range2D textureCoordinates;
+            Vector2 halfSize;
+            UnsignedInt texture;
+        };
+
+        struct Instance {
+            Vector2 center, xAxis, yAxis;
+            Color4 color;
+            UnsignedInt frame;
+            Int layer;
+        };
+
+        UnsignedInt _capacity;
+        std::vector<Texture2D*> _textures;
+        std::vector<Frame> _frames;
+        std::vector<Instance> _sprites;
+        std::vector<std::pair<std::uint64_t, UnsignedInt>> _order;
+        std::vector<Batch> _batches;
+
+        std::unique_ptr<Shaders::Flat2D> _shader;
+        Buffer _indexBuffer, _vertexBuffer;
+        Mesh _mesh;
+        #ifndef MAGNUM_TARGET_GLES
+        std::unique_ptr<BufferRing> _ring;
+        #endif
+        Containers::Array<SpriteVertex> _vertices;
+};
+
+}}
+
+#endif
@@ -0,0 +1,205 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Framebuffer.h"
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Renderbuffer.h"
+#include "Magnum/RenderbufferFormat.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/Texture.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/SceneGraph/Camera2D.h"
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/MatrixTransformation2D.h"
+#include "Magnum/SceneGraph/Object.h"
+#include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/Sprites/Sprite.h"
+#include "Magnum/Sprites/SpriteBatch.h"
+
+namespace Magnum { namespace Sprites { namespace Test {
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation2D> Scene2D;
+
+struct SpriteBatchGLTest: OpenGLTester {
+    explicit SpriteBatchGLTest();
+
+    void construct();
+    void constructLarge();
+
+    void draw();
+    void drawEmpty();
+    void drawSceneGraph();
+
+    private:
+        void setupFramebuffer();
+        Containers::Array<Color4ub> read();
+
+        Renderbuffer _color{NoCreate};
+        Framebuffer _framebuffer{NoCreate};
+        Texture2D _texture{NoCreate};
+};
+
+SpriteBatchGLTest::SpriteBatchGLTest() {
+    addTests({&SpriteBatchGLTest::construct,
+              &SpriteBatchGLTest::constructLarge,
+
+              &SpriteBatchGLTest::draw,
+              &SpriteBatchGLTest::drawEmpty,
+              &SpriteBatchGLTest::drawSceneGraph});
+}
+
+void SpriteBatchGLTest::setupFramebuffer() {
+    _color = Renderbuffer{};
+    #ifndef MAGNUM_TARGET_GLES2
+    _color.setStorage(RenderbufferFormat::RGBA8, {4, 4});
+    #else
+    _color.setStorage(RenderbufferFormat::RGBA4, {4, 4});
+    #endif
+    _framebuffer = Framebuffer{{{}, {4, 4}}};
+    _framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment(0), _color)
+        .bind();
+    Renderer::setClearColor(Color4{});
+    _framebuffer.clear(FramebufferClear::Color);
+
+    /* White 2x2 texture, the sprite color is then the vertex color */
+    const Color4ub white[4]{Color4ub{255}, Color4ub{255}, Color4ub{255}, Color4ub{255}};
+    _texture = Texture2D{};
+    _texture.setMinificationFilter(Sampler::Filter::Nearest)
+        .setMagnificationFilter(Sampler::Filter::Nearest)
+        #ifndef MAGNUM_TARGET_GLES2
+        .setStorage(1, TextureFormat::RGBA8, {2, 2})
+        #else
+        .setStorage(1, TextureFormat::RGBA, {2, 2})
+        #endif
+        .setSubImage(0, {}, ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {2, 2}, white});
+}
+
+Containers::Array<Color4ub> SpriteBatchGLTest::read() {
+    Image2D image = _framebuffer.read({{}, {4, 4}}, {PixelFormat::RGBA, PixelType::UnsignedByte});
+    Containers::Array<Color4ub> pixels{16};
+    for(std::size_t i = 0; i != 16; ++i)
+        pixels[i] = image.data<Color4ub>()[i];
+    return pixels;
+}
+
+void SpriteBatchGLTest::construct() {
+    SpriteBatch batch{16};
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(batch.capacity(), 16);
+    CORRADE_COMPARE(batch.spriteCount(), 0);
+}
+
+void SpriteBatchGLTest::constructLarge() {
+    #ifdef MAGNUM_TARGET_GLES2
+    if(!Context::current().isExtensionSupported<Extensions::GL::OES::element_index_uint>())
+        CORRADE_SKIP(Extensions::GL::OES::element_index_uint::string() + std::string(" is not supported."));
+    #endif
+
+    /* Needs 32-bit indices */
+    SpriteBatch batch{20000};
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(batch.capacity(), 20000);
+}
+
+void SpriteBatchGLTest::draw() {
+    setupFramebuffer();
+
+    SpriteBatch batch{16};
+    const UnsignedInt frame = batch.addFrames(batch.addTexture(_texture), {2, 2}, {{{}, {2, 2}}});
+
+    /* The blue sprite is in a lower layer, so it gets overdrawn by red even
+       though it's added later */
+    batch.add(frame, Matrix3::translation({-1.0f, -1.0f}), 0, Color4{1.0f, 0.0f, 0.0f})
+         .add(frame, Matrix3::translation({1.0f, 1.0f}), 0, Color4{0.0f, 1.0f, 0.0f})
+         .add(frame, Matrix3::translation({-1.0f, -1.0f}), -1, Color4{0.0f, 0.0f, 1.0f})
+         .draw(Matrix3::projection({4.0f, 4.0f}));
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(batch.spriteCount(), 0);
+    CORRADE_COMPARE(batch.batches().size(), 2);
+
+    Containers::Array<Color4ub> pixels = read();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(pixels[0], (Color4ub{255, 0, 0, 255}));
+    CORRADE_COMPARE(pixels[1*4 + 1], (Color4ub{255, 0, 0, 255}));
+    CORRADE_COMPARE(pixels[3*4 + 3], (Color4ub{0, 255, 0, 255}));
+    CORRADE_COMPARE(pixels[3], (Color4ub{}));
+    CORRADE_COMPARE(pixels[3*4], (Color4ub{}));
+}
+
+void SpriteBatchGLTest::drawEmpty() {
+    SpriteBatch batch{16};
+    batch.draw(Matrix3{});
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void SpriteBatchGLTest::drawSceneGraph() {
+    setupFramebuffer();
+
+    SpriteBatch batch{16};
+    const UnsignedInt frame = batch.addFrames(batch.addTexture(_texture), {2, 2}, {{{}, {2, 2}}});
+
+    Scene2D scene;
+    Object2D cameraObject{&scene};
+    SceneGraph::Camera2D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix3::projection({4.0f, 4.0f}));
+
+    SceneGraph::DrawableGroup2D drawables;
+    Object2D a{&scene}, b{&scene};
+    a.translate({-1.0f, -1.0f});
+    b.translate({1.0f, 1.0f});
+    new Sprite{a, batch, frame, &drawables};
+    (new Sprite{b, batch, frame, &drawables})
+        ->setColor(Color4{0.0f, 1.0f, 0.0f});
+
+    /* The camera moves everything one pixel to the left */
+    cameraObject.translate({1.0f, 0.0f});
+
+    camera.draw(drawables);
+    CORRADE_COMPARE(batch.spriteCount(), 2);
+    batch.draw(camera.projectionMatrix());
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    Containers::Array<Color4ub> pixels = read();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(pixels[0], (Color4ub{255}));
+    CORRADE_COMPARE(pixels[1], (Color4ub{}));
+    CORRADE_COMPARE(pixels[3*4 + 2], (Color4ub{0, 255, 0, 255}));
+    CORRADE_COMPARE(pixels[3*4 + 3], (Color4ub{}));
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Sprites::Test::SpriteBatchGLTest)
@@ -0,0 +1,294 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Texture.h"
+#include "Magnum/Math/Angle.h"
+#include "Magnum/Sprites/SpriteBatch.h"
+
+namespace Magnum { namespace Sprites { namespace Test {
+
+struct SpriteBatchTest: TestSuite::Tester {
+    explicit SpriteBatchTest();
+
+    void constructNoCreate();
+    void constructCopy();
+    void vertexLayout();
+
+    void addFrames();
+    void addFrameInvalidTexture();
+
+    void writeVertices();
+    void writeVerticesTransformed();
+    void writeVerticesTooSmall();
+    void sort();
+    void sortStable();
+
+    void addCapacityExceeded();
+    void clear();
+    void drawNoCreate();
+};
+
+SpriteBatchTest::SpriteBatchTest() {
+    addTests({&SpriteBatchTest::constructNoCreate,
+              &SpriteBatchTest::constructCopy,
+              &SpriteBatchTest::vertexLayout,
+
+              &SpriteBatchTest::addFrames,
+              &SpriteBatchTest::addFrameInvalidTexture,
+
+              &SpriteBatchTest::writeVertices,
+              &SpriteBatchTest::writeVerticesTransformed,
+              &SpriteBatchTest::writeVerticesTooSmall,
+              &SpriteBatchTest::sort,
+              &SpriteBatchTest::sortStable,
+
+              &SpriteBatchTest::addCapacityExceeded,
+              &SpriteBatchTest::clear,
+              &SpriteBatchTest::drawNoCreate});
+}
+
+void SpriteBatchTest::constructNoCreate() {
+    SpriteBatch batch{NoCreate, 16};
+    CORRADE_COMPARE(batch.capacity(), 16);
+    CORRADE_COMPARE(batch.textureCount(), 0);
+    CORRADE_COMPARE(batch.frameCount(), 0);
+    CORRADE_COMPARE(batch.spriteCount(), 0);
+    CORRADE_VERIFY(batch.batches().empty());
+}
+
+void SpriteBatchTest::constructCopy() {
+    CORRADE_VERIFY(!(std::is_constructible<SpriteBatch, const SpriteBatch&>{}));
+    CORRADE_VERIFY(!(std::is_assignable<SpriteBatch, const SpriteBatch&>{}));
+    CORRADE_VERIFY(!(std::is_constructible<SpriteBatch, SpriteBatch&&>{}));
+    CORRADE_VERIFY(!(std::is_assignable<SpriteBatch, SpriteBatch&&>{}));
+}
+
+void SpriteBatchTest::vertexLayout() {
+    CORRADE_COMPARE(sizeof(SpriteVertex), 32);
+    CORRADE_COMPARE(offsetof(SpriteVertex, textureCoordinates), 8);
+    CORRADE_COMPARE(offsetof(SpriteVertex, color), 16);
+}
+
+void SpriteBatchTest::addFrames() {
+    Texture2D a{NoCreate}, b{NoCreate};
+    SpriteBatch batch{NoCreate, 16};
+    CORRADE_COMPARE(batch.addTexture(a), 0);
+    CORRADE_COMPARE(batch.addTexture(b), 1);
+    CORRADE_COMPARE(batch.textureCount(), 2);
+
+    CORRADE_COMPARE(batch.addFrame(1, {{0.0f, 0.0f}, {1.0f, 1.0f}}, {2.0f, 3.0f}), 0);
+    CORRADE_COMPARE(batch.addFrames(0, {64, 32}, {
+        {{0, 0}, {32, 16}},
+        {{32, 16}, {64, 32}}}), 1);
+    CORRADE_COMPARE(batch.frameCount(), 3);
+
+    /* Texture coordinates are normalized, size is in pixels */
+    batch.add(2, {});
+    SpriteVertex vertices[4];
+    batch.writeVertices(vertices);
+    CORRADE_COMPARE(batch.batches()[0].texture, 0);
+    CORRADE_COMPARE(vertices[0].position, (Vector2{-16.0f, -8.0f}));
+    CORRADE_COMPARE(vertices[2].position, (Vector2{16.0f, 8.0f}));
+    CORRADE_COMPARE(vertices[0].textureCoordinates, (Vector2{0.5f, 0.5f}));
+    CORRADE_COMPARE(vertices[2].textureCoordinates, (Vector2{1.0f, 1.0f}));
+}
+
+void SpriteBatchTest::addFrameInvalidTexture() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Texture2D texture{NoCreate};
+    SpriteBatch batch{NoCreate, 16};
+    batch.addTexture(texture);
+    batch.addFrame(1, {}, {});
+    batch.addFrames(3, {16, 16}, {});
+    batch.add(0, {});
+    CORRADE_COMPARE(out.str(),
+        "Sprites::SpriteBatch::addFrame(): texture ID 1 out of range for 1 textures\n"
+        "Sprites::SpriteBatch::addFrames(): texture ID 3 out of range for 1 textures\n"
+        "Sprites::SpriteBatch::add(): frame ID 0 out of range for 0 frames\n");
+}
+
+void SpriteBatchTest::writeVertices() {
+    Texture2D texture{NoCreate};
+    SpriteBatch batch{NoCreate, 16};
+    batch.addFrame(batch.addTexture(texture), {{0.25f, 0.5f}, {0.75f, 1.0f}}, {4.0f, 2.0f});
+
+    batch.add(0, Matrix3::translation({10.0f, 20.0f}), 0, Color4{0.5f, 1.0f});
+    CORRADE_COMPARE(batch.spriteCount(), 1);
+
+    SpriteVertex vertices[4];
+    CORRADE_COMPARE(batch.writeVertices(vertices), 1);
+
+    /* Counterclockwise from bottom left */
+    CORRADE_COMPARE(vertices[0].position, (Vector2{8.0f, 19.0f}));
+    CORRADE_COMPARE(vertices[1].position, (Vector2{12.0f, 19.0f}));
+    CORRADE_COMPARE(vertices[2].position, (Vector2{12.0f, 21.0f}));
+    CORRADE_COMPARE(vertices[3].position, (Vector2{8.0f, 21.0f}));
+    CORRADE_COMPARE(vertices[0].textureCoordinates, (Vector2{0.25f, 0.5f}));
+    CORRADE_COMPARE(vertices[1].textureCoordinates, (Vector2{0.75f, 0.5f}));
+    CORRADE_COMPARE(vertices[2].textureCoordinates, (Vector2{0.75f, 1.0f}));
+    CORRADE_COMPARE(vertices[3].textureCoordinates, (Vector2{0.25f, 1.0f}));
+    CORRADE_COMPARE(vertices[2].color, (Color4{0.5f, 1.0f}));
+
+    CORRADE_COMPARE(batch.batches().size(), 1);
+    CORRADE_COMPARE(batch.batches()[0].offset, 0);
+    CORRADE_COMPARE(batch.batches()[0].count, 1);
+}
+
+void SpriteBatchTest::writeVerticesTransformed() {
+    Texture2D texture{NoCreate};
+    SpriteBatch batch{NoCreate, 16};
+    batch.addFrame(batch.addTexture(texture), {}, {2.0f, 2.0f});
+
+    /* Rotation by 90° and scaling, the quad gets rotated around its center */
+    batch.add(0, Matrix3::translation({1.0f, 0.0f})*
+                 Matrix3::rotation(Deg(90.0f))*
+                 Matrix3::scaling({2.0f, 1.0f}));
+
+    SpriteVertex vertices[4];
+    batch.writeVertices(vertices);
+    CORRADE_COMPARE(vertices[0].position, (Vector2{2.0f, -2.0f}));
+    CORRADE_COMPARE(vertices[1].position, (Vector2{2.0f, 2.0f}));
+    CORRADE_COMPARE(vertices[2].position, (Vector2{0.0f, 2.0f}));
+    CORRADE_COMPARE(vertices[3].position, (Vector2{0.0f, -2.0f}));
+}
+
+void SpriteBatchTest::writeVerticesTooSmall() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Texture2D texture{NoCreate};
+    SpriteBatch batch{NoCreate, 16};
+    batch.addFrame(batch.addTexture(texture), {}, {1.0f, 1.0f});
+    batch.add(0, {}).add(0, {});
+
+    SpriteVertex vertices[7];
+    batch.writeVertices(vertices);
+    CORRADE_COMPARE(out.str(), "Sprites::SpriteBatch::writeVertices(): expected at least 8 vertices, got 7\n");
+}
+
+void SpriteBatchTest::sort() {
+    Texture2D a{NoCreate}, b{NoCreate};
+    SpriteBatch batch{NoCreate, 16};
+    const UnsignedInt frameA = batch.addFrame(batch.addTexture(a), {}, {1.0f, 1.0f});
+    const UnsignedInt frameB = batch.addFrame(batch.addTexture(b), {}, {1.0f, 1.0f});
+
+    /* Positions are used to identify the sprites */
+    batch.add(frameB, Matrix3::translation(Vector2::xAxis(0.0f)), 1)
+         .add(frameA, Matrix3::translation(Vector2::xAxis(1.0f)), 0)
+         .add(frameB, Matrix3::translation(Vector2::xAxis(2.0f)), 0)
+         .add(frameA, Matrix3::translation(Vector2::xAxis(3.0f)), -1)
+         .add(frameA, Matrix3::translation(Vector2::xAxis(4.0f)), 0);
+
+    SpriteVertex vertices[5*4];
+    CORRADE_COMPARE(batch.writeVertices(vertices), 5);
+
+    /* Sorted by layer first, then by texture */
+    CORRADE_COMPARE(batch.batches().size(), 4);
+    CORRADE_COMPARE(batch.batches()[0].layer, -1);
+    CORRADE_COMPARE(batch.batches()[0].texture, 0);
+    CORRADE_COMPARE(batch.batches()[0].offset, 0);
+    CORRADE_COMPARE(batch.batches()[0].count, 1);
+    CORRADE_COMPARE(batch.batches()[1].layer, 0);
+    CORRADE_COMPARE(batch.batches()[1].texture, 0);
+    CORRADE_COMPARE(batch.batches()[1].offset, 1);
+    CORRADE_COMPARE(batch.batches()[1].count, 2);
+    CORRADE_COMPARE(batch.batches()[2].layer, 0);
+    CORRADE_COMPARE(batch.batches()[2].texture, 1);
+    CORRADE_COMPARE(batch.batches()[2].offset, 3);
+    CORRADE_COMPARE(batch.batches()[2].count, 1);
+    CORRADE_COMPARE(batch.batches()[3].layer, 1);
+    CORRADE_COMPARE(batch.batches()[3].texture, 1);
+    CORRADE_COMPARE(batch.batches()[3].offset, 4);
+    CORRADE_COMPARE(batch.batches()[3].count, 1);
+
+    CORRADE_COMPARE(vertices[0*4].position.x(), 2.5f);
+    CORRADE_COMPARE(vertices[1*4].position.x(), 0.5f);
+    CORRADE_COMPARE(vertices[2*4].position.x(), 3.5f);
+    CORRADE_COMPARE(vertices[3*4].position.x(), 1.5f);
+    CORRADE_COMPARE(vertices[4*4].position.x(), -0.5f);
+}
+
+void SpriteBatchTest::sortStable() {
+    Texture2D a{NoCreate}, b{NoCreate};
+    SpriteBatch batch{NoCreate, 16};
+    const UnsignedInt frameA = batch.addFrame(batch.addTexture(a), {}, {1.0f, 1.0f});
+    const UnsignedInt frameB = batch.addFrame(batch.addTexture(b), {}, {1.0f, 1.0f});
+
+    /* Order of sprites with the same texture and layer is kept */
+    for(Int i = 0; i != 8; ++i)
+        batch.add(i % 2 ? frameA : frameB, Matrix3::translation(Vector2::xAxis(i)));
+
+    SpriteVertex vertices[8*4];
+    batch.writeVertices(vertices);
+    CORRADE_COMPARE(batch.batches().size(), 2);
+    for(Int i = 0; i != 4; ++i) {
+        CORRADE_COMPARE(vertices[i*4].position.x(), 2*i + 1 - 0.5f);
+        CORRADE_COMPARE(vertices[(i + 4)*4].position.x(), 2*i - 0.5f);
+    }
+}
+
+void SpriteBatchTest::addCapacityExceeded() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Texture2D texture{NoCreate};
+    SpriteBatch batch{NoCreate, 2};
+    batch.addFrame(batch.addTexture(texture), {}, {1.0f, 1.0f});
+    batch.add(0, {}).add(0, {}).add(0, {});
+    CORRADE_COMPARE(batch.spriteCount(), 2);
+    CORRADE_COMPARE(out.str(), "Sprites::SpriteBatch::add(): capacity of 2 sprites exceeded\n");
+}
+
+void SpriteBatchTest::clear() {
+    Texture2D texture{NoCreate};
+    SpriteBatch batch{NoCreate, 16};
+    batch.addFrame(batch.addTexture(texture), {}, {1.0f, 1.0f});
+    batch.add(0, {}).add(0, {});
+    CORRADE_COMPARE(batch.spriteCount(), 2);
+
+    /* Textures and frames are kept */
+    batch.clear();
+    CORRADE_COMPARE(batch.spriteCount(), 0);
+    CORRADE_COMPARE(batch.textureCount(), 1);
+    CORRADE_COMPARE(batch.frameCount(), 1);
+}
+
+void SpriteBatchTest::drawNoCreate() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    SpriteBatch batch{NoCreate, 16};
+    batch.draw({});
+    CORRADE_COMPARE(out.str(), "Sprites::SpriteBatch::draw(): the batch was created without OpenGL objects\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Sprites::Test::SpriteBatchTest)
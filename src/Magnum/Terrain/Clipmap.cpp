@@ -0,0 +1,335 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Clipmap.h"
+
+#include <utility>
+#include <Corrade/Utility/Resource.h>
+
+#include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/MeshView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Shader.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/Math/Frustum.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Geometry/Intersection.h"
+#include "Magnum/MeshTools/CompressIndices.h"
+#include "Magnum/Shaders/Implementation/CreateCompatibilityShader.h"
+
+#ifdef MAGNUM_BUILD_STATIC
+static void importTerrainResources() {
+    CORRADE_RESOURCE_INITIALIZE(MagnumTerrain_RCS)
+}
+#endif
+
+namespace Magnum { namespace Terrain {
+
+namespace Implementation {
+
+class ClipmapShader: public AbstractShaderProgram {
+    public:
+        typedef Attribute<0, Vector2> Position;
+
+        enum: Int { HeightmapLayer = 0 };
+
+        explicit ClipmapShader();
+
+        ClipmapShader& setTransformationProjectionMatrix(const Matrix4& matrix) {
+            setUniform(_transformationProjectionMatrixUniform, matrix);
+            return *this;
+        }
+
+        ClipmapShader& setOffset(const Vector2i& offset) {
+            setUniform(_offsetUniform, offset);
+            return *this;
+        }
+
+        ClipmapShader& setLevel(Int level) {
+            setUniform(_levelUniform, level);
+            return *this;
+        }
+
+        ClipmapShader& setLevelSpacing(Float spacing) {
+            setUniform(_levelSpacingUniform, spacing);
+            return *this;
+        }
+
+        ClipmapShader& setMorph(const Vector4& morph) {
+            setUniform(_morphUniform, morph);
+            return *this;
+        }
+
+        ClipmapShader& setLightDirection(const Vector3& direction) {
+            setUniform(_lightDirectionUniform, direction);
+            return *this;
+        }
+
+        ClipmapShader& setColor(const Color4& color) {
+            setUniform(_colorUniform, color);
+            return *this;
+        }
+
+        ClipmapShader& setAmbientColor(const Color4& color) {
+            setUniform(_ambientColorUniform, color);
+            return *this;
+        }
+
+    private:
+        Int _transformationProjectionMatrixUniform{0},
+            _offsetUniform{1},
+            _levelUniform{2},
+            _levelSpacingUniform{3},
+            _morphUniform{4},
+            _lightDirectionUniform{5},
+            _colorUniform{6},
+            _ambientColorUniform{7};
+};
+
+ClipmapShader::ClipmapShader() {
+    #ifndef MAGNUM_TARGET_GLES
+    MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::EXT::texture_array);
+    MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::EXT::gpu_shader4);
+    #endif
+
+    #ifdef MAGNUM_BUILD_STATIC
+    /* Import resources on static build, if not already */
+    if(!Utility::Resource::hasGroup("MagnumTerrain"))
+        importTerrainResources();
+    #endif
+    Utility::Resource rs("MagnumTerrain");
+
+    #ifndef MAGNUM_TARGET_GLES
+    const Version version = Context::current().supportedVersion({Version::GL330, Version::GL300});
+    #else
+    const Version version = Context::current().supportedVersion({Version::GLES300});
+    #endif
+
+    Shader vert = Shaders::Implementation::createCompatibilityShader(rs, version, Shader::Type::Vertex);
+    Shader frag = Shaders::Implementation::createCompatibilityShader(rs, version, Shader::Type::Fragment);
+    vert.addSource(rs.get("ClipmapShader.vert"));
+    frag.addSource(rs.get("ClipmapShader.frag"));
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, frag}));
+    attachShaders({vert, frag});
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_attrib_location>(version))
+    {
+        bindAttributeLocation(Position::Location, "position");
+        bindFragmentDataLocation(0, "fragmentColor");
+    }
+    #endif
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::explicit_uniform_location>(version))
+    #endif
+    {
+        _transformationProjectionMatrixUniform = uniformLocation("transformationProjectionMatrix");
+        _offsetUniform = uniformLocation("offset");
+        _levelUniform = uniformLocation("level");
+        _levelSpacingUniform = uniformLocation("levelSpacing");
+        _morphUniform = uniformLocation("morph");
+        _lightDirectionUniform = uniformLocation("lightDirection");
+        _colorUniform = uniformLocation("color");
+        _ambientColorUniform = uniformLocation("ambientColor");
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::shading_language_420pack>(version))
+    #endif
+    {
+        setUniform(uniformLocation("heightmap"), HeightmapLayer);
+    }
+}
+
+}
+
+namespace {
+
+/* Grid of (size + 1)^2 vertices, counterclockwise when seen from +Y with grid
+   X going to world X and grid Y to world Z */
+void addGrid(std::vector<Vector2>& positions, std::vector<UnsignedInt>& indices, const Vector2i& size) {
+    const UnsignedInt base = positions.size();
+    for(Int y = 0; y <= size.y(); ++y)
+        for(Int x = 0; x <= size.x(); ++x)
+            positions.emplace_back(Float(x), Float(y));
+
+    for(Int y = 0; y != size.y(); ++y) for(Int x = 0; x != size.x(); ++x) {
+        const UnsignedInt i00 = base + y*(size.x() + 1) + x;
+        const UnsignedInt i10 = i00 + 1;
+        const UnsignedInt i01 = i00 + size.x() + 1;
+        const UnsignedInt i11 = i01 + 1;
+        indices.insert(indices.end(), {i00, i01, i10, i10, i01, i11});
+    }
+}
+
+/* Zero-area triangles along the border of a size^2 grid, each spanning two
+   quads of the finer level, i.e. one quad of the coarser level. After the
+   odd vertices are blended to the coarser level they cover the T-junctions
+   between the levels. */
+void addEdge(std::vector<Vector2>& positions, std::vector<UnsignedInt>& indices, const Int size) {
+    const Vector2 corners[]{{0.0f, 0.0f}, {0.0f, Float(size)}, {Float(size), 0.0f}, {0.0f, 0.0f}};
+    const Vector2 directions[]{{1.0f, 0.0f}, {1.0f, 0.0f}, {0.0f, 1.0f}, {0.0f, 1.0f}};
+    for(std::size_t side = 0; side != 4; ++side) {
+        const UnsignedInt base = positions.size();
+        for(Int i = 0; i <= size; ++i)
+            positions.push_back(corners[side] + directions[side]*Float(i));
+        for(UnsignedInt i = 0; i + 2 <= UnsignedInt(size); i += 2)
+            indices.insert(indices.end(), {base + i, base + i + 1, base + i + 2});
+    }
+}
+
+}
+
+Clipmap::Clipmap(const Int size, const Int levelCount, const Float spacing, Loader loader): _layout{size, levelCount}, _spacing{spacing}, _loader{std::move(loader)}, _heightRanges(levelCount, Range1D{Constants::inf(), -Constants::inf()}), _shader{new Implementation::ClipmapShader} {
+    CORRADE_ASSERT(_loader, "Terrain::Clipmap: the loader is empty", );
+
+    const Int textureSize = _layout.textureSize();
+    _heightmap.setMinificationFilter(Sampler::Filter::Nearest)
+        .setMagnificationFilter(Sampler::Filter::Nearest)
+        .setWrapping(Sampler::Wrapping::Repeat)
+        .setStorage(1, TextureFormat::R32F, {textureSize, textureSize, levelCount});
+
+    /* All piece meshes in one vertex and index buffer */
+    std::vector<Vector2> positions;
+    std::vector<UnsignedInt> indices;
+    for(UnsignedByte i = 0; i != 7; ++i) {
+        const ClipmapPieceType type = ClipmapPieceType(i);
+        const UnsignedInt vertexStart = positions.size();
+        const std::size_t indexStart = indices.size();
+        if(type == ClipmapPieceType::Edge)
+            addEdge(positions, indices, _layout.size() - 1);
+        else addGrid(positions, indices, _layout.pieceSize(type));
+        _pieceMeshes[i] = {Int(indexStart), Int(indices.size() - indexStart), vertexStart, UnsignedInt(positions.size() - 1)};
+    }
+
+    Containers::Array<char> indexData;
+    Mesh::IndexType indexType;
+    UnsignedInt indexStart, indexEnd;
+    std::tie(indexData, indexType, indexStart, indexEnd) = MeshTools::compressIndices(indices);
+    _indices.setData(indexData, BufferUsage::StaticDraw);
+    _vertices.setData(positions, BufferUsage::StaticDraw);
+
+    _mesh.setPrimitive(MeshPrimitive::Triangles)
+        .addVertexBuffer(_vertices, 0, Implementation::ClipmapShader::Position{})
+        .setIndexBuffer(_indices, 0, indexType, indexStart, indexEnd);
+}
+
+Clipmap::~Clipmap() = default;
+
+Range1D Clipmap::heightRange(const Int level) const {
+    CORRADE_ASSERT(level >= 0 && level < _layout.levelCount(),
+        "Terrain::Clipmap::heightRange(): level" << level << "out of range for" << _layout.levelCount() << "levels", {});
+    const Range1D& range = _heightRanges[level];
+    return range.min()[0] <= range.max()[0] ? range : Range1D{};
+}
+
+Clipmap& Clipmap::update(const Vector3& position) {
+    if(!_layout.update(Vector2{position.x(), position.z()}/_spacing)) return *this;
+
+    const Int textureSize = _layout.textureSize();
+    for(Int level = 0; level != _layout.levelCount(); ++level) {
+        Range1D& range = _heightRanges[level];
+        for(const Range2Di& region: _layout.updateRegions(level)) {
+            const std::size_t count = region.size().product();
+            _scratch.resize(count);
+            _loader(level, region, {_scratch.data(), count});
+
+            for(const Float height: _scratch)
+                range = {Math::min(range.min()[0], height), Math::max(range.max()[0], height)};
+
+            /* Each region lies inside a single period of the texture */
+            const Vector2i texel{(region.min() % textureSize + Vector2i{textureSize}) % textureSize};
+            _heightmap.setSubImage(0, {texel, level}, ImageView3D{PixelFormat::Red, PixelType::Float, {region.size(), 1}, Containers::ArrayView<const Float>{_scratch.data(), count}});
+        }
+    }
+
+    return *this;
+}
+
+std::size_t Clipmap::draw(const Matrix4& transformationProjectionMatrix) {
+    CORRADE_ASSERT(_layout.isPlaced(), "Terrain::Clipmap::draw(): update() was not called yet", 0);
+
+    const Frustum frustum = Frustum::fromMatrix(transformationProjectionMatrix);
+    _shader->setTransformationProjectionMatrix(transformationProjectionMatrix)
+        .setLightDirection(_lightDirection)
+        .setColor(_color)
+        .setAmbientColor(_ambientColor);
+    _heightmap.bind(Implementation::ClipmapShader::HeightmapLayer);
+
+    /* Blend over the last tenth of each level toward the coarser one, fully
+       reaching it one sample before the edge. The coarsest level has nothing
+       to blend to. */
+    const Int half = (_layout.size() - 1)/2;
+    const Int morphWidth = Math::max((_layout.size() - 1)/10, 1);
+
+    std::size_t culled = 0;
+    for(Int level = 0; level != _layout.levelCount(); ++level) {
+        const bool coarsest = level + 1 == _layout.levelCount();
+        const Float levelSpacing = this->levelSpacing(level);
+        const Vector2 center = Vector2{_layout.origin(level)} + Vector2{Float(half)};
+        _shader->setLevel(level)
+            .setLevelSpacing(levelSpacing)
+            .setMorph(coarsest ?
+                Vector4{center.x(), center.y(), Float(_layout.size()), 1.0f} :
+                Vector4{center.x(), center.y(), Float(half - morphWidth - 1), 1.0f/Float(morphWidth)});
+
+        /* Blended vertices can reach also heights of the coarser level */
+        Range1D heights = heightRange(level);
+        if(!coarsest) {
+            const Range1D coarser = heightRange(level + 1);
+            heights = {Math::min(heights.min()[0], coarser.min()[0]), Math::max(heights.max()[0], coarser.max()[0])};
+        }
+
+        for(const ClipmapPiece& piece: _layout.pieces(level)) {
+            const Vector2 min = Vector2{piece.offset}*levelSpacing;
+            const Vector2 extents = Vector2{_layout.pieceSize(piece.type)}*levelSpacing*0.5f;
+            if(!Math::Geometry::Intersection::aabbFrustum(
+                Vector3{min.x() + extents.x(), heights.center()[0], min.y() + extents.y()},
+                Vector3{extents.x(), heights.size()[0]*0.5f, extents.y()}, frustum))
+            {
+                ++culled;
+                continue;
+            }
+
+            const PieceMesh& pieceMesh = _pieceMeshes[UnsignedByte(piece.type)];
+            _shader->setOffset(piece.offset);
+            MeshView view{_mesh};
+            view.setCount(pieceMesh.count)
+                .setIndexRange(pieceMesh.first, pieceMesh.start, pieceMesh.end);
+            view.draw(*_shader);
+        }
+    }
+
+    return culled;
+}
+
+}}
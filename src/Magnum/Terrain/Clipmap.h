@@ -0,0 +1,255 @@
+#ifndef Magnum_Terrain_Clipmap_h
+#define Magnum_Terrain_Clipmap_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Terrain::Clipmap
+ */
+
+#include "Magnum/configure.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/TextureArray.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Terrain/ClipmapLayout.h"
+#include "Magnum/Terrain/visibility.h"
+
+namespace Magnum { namespace Terrain {
+
+namespace Implementation { class ClipmapShader; }
+
+/**
+@brief Geometry clipmap terrain
+
+Renders a heightfield around a viewer using nested grids laid out by
+@ref ClipmapLayout. All levels are drawn with the same few index ranges of a
+single shared mesh containing only 2D grid positions, the heights are fetched
+in the vertex shader from @ref heightmap(), a @ref Texture2DArray with one
+layer per level. When the viewer moves, only the samples that got into the
+level windows are requested from the loader and uploaded with
+@ref Texture2DArray::setSubImage(), the rest of the texture stays in place and
+is addressed toroidally.
+
+Each piece of each level is tested against the view frustum before drawing,
+so the count of processed vertices per frame is bounded by
+@ref ClipmapLayout::vertexCount() regardless of the terrain size. Vertices
+near the outer edge of each level are blended toward the coarser level and
+the level edges are covered with zero-area triangles to avoid cracks.
+
+## Example usage
+
+@code
+Terrain::Clipmap terrain{255, 8, 1.0f, [](Int level, const Range2Di& samples, Containers::ArrayView<Float> heights) {
+    std::size_t i = 0;
+    for(Int y = samples.bottom(); y != samples.top(); ++y)
+        for(Int x = samples.left(); x != samples.right(); ++x)
+            heights[i++] = height(Vector2{Float(x), Float(y)}*Float(1 << level));
+}};
+
+// each frame
+terrain.update(camera.object().absoluteTransformation().translation())
+    .draw(camera.projectionMatrix()*camera.cameraMatrix());
+@endcode
+
+The terrain lies in the XZ plane with heights along positive Y, level `0`
+sample @f$ (x, y) @f$ is at @f$ (x, h, y) @f$ multiplied by @ref spacing().
+The mesh has counterclockwise front faces pointing up, depth test is
+expected to be enabled.
+
+@requires_gl30 Extension @extension{EXT,texture_array} and
+    @extension{EXT,gpu_shader4}
+@requires_gles30 Integer texture fetches and texture arrays are not
+    available in OpenGL ES 2.0.
+@requires_webgl20 Integer texture fetches and texture arrays are not
+    available in WebGL 1.0.
+*/
+class MAGNUM_TERRAIN_EXPORT Clipmap {
+    public:
+        /**
+         * @brief Height loader
+         *
+         * Called with level index, range of samples of given level and
+         * view of `samples.size().product()` heights to fill, row-major
+         * with X varying fastest. Level @f$ l @f$ sample @f$ \boldsymbol{p} @f$
+         * is at world position of level `0` sample @f$ 2^l \boldsymbol{p} @f$,
+         * the loader is expected to return heights filtered to given level
+         * for best results.
+         */
+        typedef std::function<void(Int, const Range2Di&, Containers::ArrayView<Float>)> Loader;
+
+        /**
+         * @brief Constructor
+         * @param size          Grid size of each level, in vertices
+         * @param levelCount    Level count
+         * @param spacing       Distance between level `0` samples
+         * @param loader        Height loader
+         *
+         * See @ref ClipmapLayout::ClipmapLayout() for requirements on
+         * @p size and @p levelCount. Nothing is loaded until the first
+         * @ref update().
+         */
+        explicit Clipmap(Int size, Int levelCount, Float spacing, Loader loader);
+
+        /** @brief Copying is not allowed */
+        Clipmap(const Clipmap&) = delete;
+
+        /** @brief Moving is not allowed */
+        Clipmap(Clipmap&&) = delete;
+
+        ~Clipmap();
+
+        /** @brief Copying is not allowed */
+        Clipmap& operator=(const Clipmap&) = delete;
+
+        /** @brief Moving is not allowed */
+        Clipmap& operator=(Clipmap&&) = delete;
+
+        /** @brief Layout */
+        const ClipmapLayout& layout() const { return _layout; }
+
+        /** @brief Distance between level `0` samples */
+        Float spacing() const { return _spacing; }
+
+        /** @brief Distance between samples of given level */
+        Float levelSpacing(Int level) const { return _spacing*Float(1 << level); }
+
+        /**
+         * @brief Heightmap texture
+         *
+         * @ref TextureFormat::R32F texture with
+         * @ref ClipmapLayout::textureSize() squared layers, one for each
+         * level.
+         */
+        Texture2DArray& heightmap() { return _heightmap; }
+
+        /**
+         * @brief Height range of given level
+         *
+         * Min and max of all heights loaded for given level so far, used
+         * for culling. Empty until the first @ref update().
+         */
+        Range1D heightRange(Int level) const;
+
+        /** @brief Color */
+        Color4 color() const { return _color; }
+
+        /**
+         * @brief Set color
+         * @return Reference to self (for method chaining)
+         *
+         * Default is `{1.0f, 1.0f, 1.0f, 1.0f}`.
+         */
+        Clipmap& setColor(const Color4& color) {
+            _color = color;
+            return *this;
+        }
+
+        /** @brief Ambient color */
+        Color4 ambientColor() const { return _ambientColor; }
+
+        /**
+         * @brief Set ambient color
+         * @return Reference to self (for method chaining)
+         *
+         * Added to the diffuse term. Default is `{0.0f, 0.0f, 0.0f, 1.0f}`.
+         */
+        Clipmap& setAmbientColor(const Color4& color) {
+            _ambientColor = color;
+            return *this;
+        }
+
+        /** @brief Light direction */
+        Vector3 lightDirection() const { return _lightDirection; }
+
+        /**
+         * @brief Set light direction
+         * @return Reference to self (for method chaining)
+         *
+         * Normalized direction toward the light. Default is
+         * `{0.0f, 1.0f, 0.0f}`.
+         */
+        Clipmap& setLightDirection(const Vector3& direction) {
+            _lightDirection = direction;
+            return *this;
+        }
+
+        /**
+         * @brief Update around a viewer
+         * @param position  Viewer position in world space
+         * @return Reference to self (for method chaining)
+         *
+         * Calls @ref ClipmapLayout::update() with the XZ position and calls
+         * the loader for each of the @ref ClipmapLayout::updateRegions(),
+         * uploading the result to given layer of @ref heightmap(). Does
+         * nothing if no level moved.
+         */
+        Clipmap& update(const Vector3& position);
+
+        /**
+         * @brief Draw the terrain
+         * @param transformationProjectionMatrix Transformation and projection
+         *      matrix of a camera
+         * @return Count of pieces culled away
+         *
+         * Draws all pieces of all levels that intersect the frustum. Expects
+         * that @ref update() was called at least once.
+         */
+        std::size_t draw(const Matrix4& transformationProjectionMatrix);
+
+    private:
+        struct PieceMesh {
+            Int first, count;
+            UnsignedInt start, end;
+        };
+
+        ClipmapLayout _layout;
+        Float _spacing;
+        Loader _loader;
+        Color4 _color{1.0f}, _ambientColor{0.0f, 1.0f};
+        Vector3 _lightDirection{0.0f, 1.0f, 0.0f};
+        std::vector<Range1D> _heightRanges;
+        std::vector<Float> _scratch;
+        PieceMesh _pieceMeshes[7];
+
+        std::unique_ptr<Implementation::ClipmapShader> _shader;
+        Texture2DArray _heightmap;
+        Buffer _vertices, _indices;
+        Mesh _mesh;
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 build
+#endif
+
+#endif
@@ -0,0 +1,244 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ClipmapLayout.h"
+
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace Terrain {
+
+namespace {
+
+/* Floor division, the sample coordinates can be negative */
+inline Int floorDiv(const Int a, const Int b) {
+    return a >= 0 ? a/b : -((-a + b - 1)/b);
+}
+
+/* Splits the range at texture period boundaries, the range is expected to be
+   at most one period large in each direction */
+void appendWrapped(std::vector<Range2Di>& out, const Range2Di& range, const Int period) {
+    Int xSplit[3]{range.min().x(), (floorDiv(range.min().x(), period) + 1)*period, range.max().x()};
+    Int ySplit[3]{range.min().y(), (floorDiv(range.min().y(), period) + 1)*period, range.max().y()};
+    if(xSplit[1] > xSplit[2]) xSplit[1] = xSplit[2];
+    if(ySplit[1] > ySplit[2]) ySplit[1] = ySplit[2];
+
+    for(std::size_t y = 0; y != 2; ++y) for(std::size_t x = 0; x != 2; ++x) {
+        const Range2Di part{{xSplit[x], ySplit[y]}, {xSplit[x + 1], ySplit[y + 1]}};
+        if(part.size().product()) out.push_back(part);
+    }
+}
+
+}
+
+ClipmapLayout::ClipmapLayout(const Int size, const Int levelCount): _size{size}, _levelCount{levelCount} {
+    CORRADE_ASSERT(size >= 7 && !((size + 1) & size),
+        "Terrain::ClipmapLayout: expected size to be one less than a power of two and at least 7, got" << size, );
+    CORRADE_ASSERT(levelCount >= 1 && levelCount <= 16,
+        "Terrain::ClipmapLayout: expected level count between 1 and 16, got" << levelCount, );
+
+    _origins.resize(levelCount);
+    _previousOrigins.resize(levelCount);
+    _pieceOffsets.resize(levelCount + 1);
+    _updateRegions.resize(levelCount);
+}
+
+Vector2i ClipmapLayout::pieceSize(const ClipmapPieceType type) const {
+    const Int m = blockSize();
+    switch(type) {
+        case ClipmapPieceType::Block: return Vector2i{m - 1};
+        case ClipmapPieceType::FixupVertical: return {2, m - 1};
+        case ClipmapPieceType::FixupHorizontal: return {m - 1, 2};
+        case ClipmapPieceType::TrimHorizontal: return {2*m, 1};
+        case ClipmapPieceType::TrimVertical: return {1, 2*m - 1};
+        case ClipmapPieceType::Center: return Vector2i{2*m};
+        case ClipmapPieceType::Edge: return Vector2i{_size - 1};
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+UnsignedInt ClipmapLayout::pieceVertexCount(const ClipmapPieceType type) const {
+    /* The edge has each side separate so the triangles don't need to turn
+       corners */
+    if(type == ClipmapPieceType::Edge) return 4*_size;
+    return (pieceSize(type) + Vector2i{1}).product();
+}
+
+UnsignedInt ClipmapLayout::vertexCount() const {
+    const UnsignedInt ring = 12*pieceVertexCount(ClipmapPieceType::Block) +
+        2*pieceVertexCount(ClipmapPieceType::FixupVertical) +
+        2*pieceVertexCount(ClipmapPieceType::FixupHorizontal);
+    const UnsignedInt trim = pieceVertexCount(ClipmapPieceType::TrimHorizontal) +
+        pieceVertexCount(ClipmapPieceType::TrimVertical);
+
+    return _levelCount*ring + (_levelCount - 1)*(trim + pieceVertexCount(ClipmapPieceType::Edge)) + pieceVertexCount(ClipmapPieceType::Center);
+}
+
+bool ClipmapLayout::update(const Vector2& position) {
+    const Int m = blockSize();
+    const Int period = textureSize();
+
+    std::swap(_origins, _previousOrigins);
+
+    /* The finest level is centered around the position, each coarser level
+       is placed so the finer level starts either m - 1 or m samples from its
+       origin, whichever keeps the origin even. As m is even, that depends
+       only on whether the finer origin divided by two is odd. */
+    _origins[0] = Vector2i{Math::floor(position/2.0f)}*2 - Vector2i{2*m};
+    for(Int level = 1; level != _levelCount; ++level) {
+        const Vector2i finer = _origins[level - 1]/2;
+        _origins[level] = finer - Vector2i{m} + Vector2i{finer.x() & 1, finer.y() & 1};
+    }
+
+    bool moved = false;
+    for(Int level = 0; level != _levelCount; ++level) {
+        std::vector<Range2Di>& regions = _updateRegions[level];
+        regions.clear();
+
+        const Vector2i origin = _origins[level];
+        const Vector2i previous = _previousOrigins[level];
+        if(_placed && origin == previous) continue;
+        moved = true;
+
+        const Vector2i delta = origin - previous;
+        if(!_placed || Math::abs(delta.x()) >= period || Math::abs(delta.y()) >= period) {
+            appendWrapped(regions, Range2Di::fromSize(origin, Vector2i{period}), period);
+            continue;
+        }
+
+        /* Columns that got exposed, in full height of the new window */
+        if(delta.x()) {
+            const Int min = delta.x() > 0 ? previous.x() + period : origin.x();
+            const Int max = delta.x() > 0 ? origin.x() + period : previous.x();
+            appendWrapped(regions, {{min, origin.y()}, {max, origin.y() + period}}, period);
+        }
+
+        /* Rows that got exposed, only in the part that was not covered by
+           the columns above */
+        if(delta.y()) {
+            const Int min = delta.y() > 0 ? previous.y() + period : origin.y();
+            const Int max = delta.y() > 0 ? origin.y() + period : previous.y();
+            const Int xMin = delta.x() > 0 ? origin.x() : previous.x();
+            const Int xMax = delta.x() > 0 ? previous.x() + period : origin.x() + period;
+            appendWrapped(regions, {{xMin, min}, {xMax, max}}, period);
+        }
+    }
+
+    _placed = true;
+    if(!moved) return false;
+
+    /* Block offsets in each direction, with the fix-up strip between the
+       second and third block */
+    const Int blocks[]{0, m - 1, 2*m, 3*m - 1};
+
+    _pieces.clear();
+    for(Int level = 0; level != _levelCount; ++level) {
+        _pieceOffsets[level] = _pieces.size();
+        const Vector2i origin = _origins[level];
+
+        for(Int y: blocks) for(Int x: blocks) {
+            if(x != blocks[0] && x != blocks[3] && y != blocks[0] && y != blocks[3])
+                continue;
+            _pieces.push_back({ClipmapPieceType::Block, origin + Vector2i{x, y}});
+        }
+
+        _pieces.push_back({ClipmapPieceType::FixupVertical, origin + Vector2i{2*m - 2, 0}});
+        _pieces.push_back({ClipmapPieceType::FixupVertical, origin + Vector2i{2*m - 2, 3*m - 1}});
+        _pieces.push_back({ClipmapPieceType::FixupHorizontal, origin + Vector2i{0, 2*m - 2}});
+        _pieces.push_back({ClipmapPieceType::FixupHorizontal, origin + Vector2i{3*m - 1, 2*m - 2}});
+
+        /* The trim is on the side where the finer level leaves a gap */
+        if(level == 0) {
+            _pieces.push_back({ClipmapPieceType::Center, origin + Vector2i{m - 1}});
+        } else {
+            const Vector2i finer = _origins[level - 1]/2 - origin;
+            const bool lowX = finer.x() == m;
+            const bool lowY = finer.y() == m;
+            _pieces.push_back({ClipmapPieceType::TrimHorizontal, origin + Vector2i{m - 1, lowY ? m - 1 : 3*m - 2}});
+            _pieces.push_back({ClipmapPieceType::TrimVertical, origin + Vector2i{lowX ? m - 1 : 3*m - 2, lowY ? m : m - 1}});
+        }
+
+        if(level != _levelCount - 1)
+            _pieces.push_back({ClipmapPieceType::Edge, origin});
+    }
+    _pieceOffsets[_levelCount] = _pieces.size();
+
+    return true;
+}
+
+Vector2i ClipmapLayout::origin(const Int level) const {
+    CORRADE_ASSERT(_placed,
+        "Terrain::ClipmapLayout::origin(): the layout is not placed yet", {});
+    CORRADE_ASSERT(level >= 0 && level < _levelCount,
+        "Terrain::ClipmapLayout::origin(): level" << level << "out of range for" << _levelCount << "levels", {});
+    return _origins[level];
+}
+
+Range2Di ClipmapLayout::window(const Int level) const {
+    CORRADE_ASSERT(_placed,
+        "Terrain::ClipmapLayout::window(): the layout is not placed yet", {});
+    CORRADE_ASSERT(level >= 0 && level < _levelCount,
+        "Terrain::ClipmapLayout::window(): level" << level << "out of range for" << _levelCount << "levels", {});
+    return Range2Di::fromSize(_origins[level], Vector2i{textureSize()});
+}
+
+Containers::ArrayView<const ClipmapPiece> ClipmapLayout::pieces(const Int level) const {
+    CORRADE_ASSERT(_placed,
+        "Terrain::ClipmapLayout::pieces(): the layout is not placed yet", nullptr);
+    CORRADE_ASSERT(level >= 0 && level < _levelCount,
+        "Terrain::ClipmapLayout::pieces(): level" << level << "out of range for" << _levelCount << "levels", nullptr);
+    return {_pieces.data() + _pieceOffsets[level], _pieceOffsets[level + 1] - _pieceOffsets[level]};
+}
+
+const std::vector<Range2Di>& ClipmapLayout::updateRegions(const Int level) const {
+    CORRADE_ASSERT(_placed,
+        "Terrain::ClipmapLayout::updateRegions(): the layout is not placed yet", _updateRegions[0]);
+    CORRADE_ASSERT(level >= 0 && level < _levelCount,
+        "Terrain::ClipmapLayout::updateRegions(): level" << level << "out of range for" << _levelCount << "levels", _updateRegions[0]);
+    return _updateRegions[level];
+}
+
+Debug& operator<<(Debug& debug, const ClipmapPieceType value) {
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case ClipmapPieceType::value: return debug << "Terrain::ClipmapPieceType::" #value;
+        _c(Block)
+        _c(FixupVertical)
+        _c(FixupHorizontal)
+        _c(TrimHorizontal)
+        _c(TrimVertical)
+        _c(Center)
+        _c(Edge)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "Terrain::ClipmapPieceType(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+}}
@@ -0,0 +1,245 @@
+#ifndef Magnum_Terrain_ClipmapLayout_h
+#define Magnum_Terrain_ClipmapLayout_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Terrain::ClipmapLayout, struct @ref Magnum::Terrain::ClipmapPiece, enum @ref Magnum::Terrain::ClipmapPieceType
+ */
+
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Terrain/Terrain.h"
+#include "Magnum/Terrain/visibility.h"
+
+namespace Magnum { namespace Terrain {
+
+/**
+@brief Clipmap piece type
+
+Shared grid meshes a clipmap level is assembled from. Sizes are in quads of
+given level, @f$ m @f$ is @ref ClipmapLayout::blockSize() and @f$ n @f$ is
+@ref ClipmapLayout::size().
+@see @ref ClipmapLayout::pieceSize()
+*/
+enum class ClipmapPieceType: UnsignedByte {
+    /** @f$ (m - 1) \times (m - 1) @f$ block, twelve in each ring */
+    Block,
+
+    /** @f$ 2 \times (m - 1) @f$ fix-up strip on the top and bottom of a ring */
+    FixupVertical,
+
+    /** @f$ (m - 1) \times 2 @f$ fix-up strip on the left and right of a ring */
+    FixupHorizontal,
+
+    /**
+     * @f$ 2m \times 1 @f$ horizontal part of the L-shaped interior trim,
+     * not present in the finest level
+     */
+    TrimHorizontal,
+
+    /**
+     * @f$ 1 \times (2m - 1) @f$ vertical part of the L-shaped interior trim,
+     * not present in the finest level
+     */
+    TrimVertical,
+
+    /** @f$ 2m \times 2m @f$ center of the finest level */
+    Center,
+
+    /**
+     * Zero-area triangles along the outer edge of a ring, hiding T-junctions
+     * with the next coarser level. Its size is @f$ (n - 1) \times (n - 1) @f$,
+     * not present in the coarsest level.
+     */
+    Edge
+};
+
+/** @debugoperatorenum{Magnum::Terrain::ClipmapPieceType} */
+MAGNUM_TERRAIN_EXPORT Debug& operator<<(Debug& debug, ClipmapPieceType value);
+
+/**
+@brief Clipmap piece
+
+@see @ref ClipmapLayout::pieces()
+*/
+struct ClipmapPiece {
+    /** @brief Piece type */
+    ClipmapPieceType type;
+
+    /** @brief Offset of the piece origin in samples of given level */
+    Vector2i offset;
+};
+
+/**
+@brief Geometry clipmap layout
+
+Places nested square grids of @ref size() vertices around a viewer, each level
+having twice the sample spacing of the previous one, and splits them into
+pieces drawn with a few shared meshes. All coordinates are integer sample
+positions of given level, level @f$ l @f$ sample @f$ \boldsymbol{p} @f$ is at
+the same place as level `0` sample @f$ 2^l \boldsymbol{p} @f$.
+
+Each level except the finest is a ring around the next finer level, built out
+of twelve @ref ClipmapPieceType::Block pieces, four fix-up strips and an
+L-shaped trim filling the space that remains because the finer level has to
+stay aligned to the coarser grid. The finest level has a
+@ref ClipmapPieceType::Center in place of the trim and the finer level. The
+piece count and thus the vertex count doesn't depend on the terrain size,
+only on @ref size() and @ref levelCount().
+
+This class contains only the placement logic and doesn't need any OpenGL
+context, see @ref Clipmap for the renderer built on top of it.
+
+## Toroidal updates
+
+Heights of each level are expected to be stored in a
+@ref textureSize() @f$ \times @f$ @ref textureSize() texture, with sample
+@f$ \boldsymbol{p} @f$ at texel @f$ \boldsymbol{p} \mod @f$ @ref textureSize().
+The level window thus covers one sample more on the positive side than the
+grid itself, which is used for calculating normals. When a level moves,
+@ref updateRegions() lists the samples that are new in the window, so only the
+strips along the edges need to be uploaded. Each region lies inside a single
+period of the texture, i.e. is contiguous in the texture.
+@see @ref Clipmap
+*/
+class MAGNUM_TERRAIN_EXPORT ClipmapLayout {
+    public:
+        /**
+         * @brief Constructor
+         * @param size          Grid size of each level, in vertices
+         * @param levelCount    Level count
+         *
+         * Expects that @p size is @f$ 2^k - 1 @f$ for @f$ k \ge 3 @f$ and
+         * that @p levelCount is between `1` and `16`. No level is placed
+         * until the first @ref update().
+         */
+        explicit ClipmapLayout(Int size, Int levelCount);
+
+        /** @brief Grid size of each level, in vertices */
+        Int size() const { return _size; }
+
+        /** @brief Level count */
+        Int levelCount() const { return _levelCount; }
+
+        /**
+         * @brief Block size
+         *
+         * @f$ m = (n + 1)/4 @f$ vertices, where @f$ n @f$ is @ref size().
+         */
+        Int blockSize() const { return (_size + 1)/4; }
+
+        /**
+         * @brief Texture size
+         *
+         * Size of the toroidally updated texture of each level, @ref size()
+         * plus one.
+         */
+        Int textureSize() const { return _size + 1; }
+
+        /** @brief Size of given piece, in quads */
+        Vector2i pieceSize(ClipmapPieceType type) const;
+
+        /** @brief Vertex count of given piece mesh */
+        UnsignedInt pieceVertexCount(ClipmapPieceType type) const;
+
+        /**
+         * @brief Total vertex count
+         *
+         * Sum of @ref pieceVertexCount() of all pieces of all levels, i.e.
+         * the max count of vertices processed in one frame.
+         */
+        UnsignedInt vertexCount() const;
+
+        /**
+         * @brief Update the placement
+         * @param position  Viewer position in samples of level `0`
+         * @return `true` if any level moved, `false` otherwise
+         *
+         * Centers the finest level around @p position and each coarser level
+         * around the finer one, snapped to even sample positions so the
+         * finer level is aligned to the coarser grid. The @ref updateRegions()
+         * are relative to the placement from the previous call, on the first
+         * call they cover whole windows of all levels.
+         */
+        bool update(const Vector2& position);
+
+        /**
+         * @brief Whether the layout was placed
+         *
+         * `false` until the first @ref update() is called.
+         */
+        bool isPlaced() const { return _placed; }
+
+        /**
+         * @brief Origin of given level
+         *
+         * Position of the lower-left grid vertex in samples of given level.
+         * Always even. Expects that the layout is placed.
+         */
+        Vector2i origin(Int level) const;
+
+        /**
+         * @brief Window of given level
+         *
+         * Samples stored in the texture of given level, i.e.
+         * @ref textureSize() samples in each direction starting at
+         * @ref origin(). Expects that the layout is placed.
+         */
+        Range2Di window(Int level) const;
+
+        /**
+         * @brief Pieces of given level
+         *
+         * The list is the same length for all levels except the finest and
+         * the coarsest, see @ref ClipmapPieceType for details. Expects that
+         * the layout is placed.
+         */
+        Containers::ArrayView<const ClipmapPiece> pieces(Int level) const;
+
+        /**
+         * @brief Regions to update for given level
+         *
+         * Sample ranges that got into @ref window() of given level in the
+         * last @ref update(). Empty if the level didn't move. Expects that
+         * the layout is placed.
+         */
+        const std::vector<Range2Di>& updateRegions(Int level) const;
+
+    private:
+        Int _size, _levelCount;
+        bool _placed{};
+        std::vector<Vector2i> _origins, _previousOrigins;
+        std::vector<ClipmapPiece> _pieces;
+        std::vector<std::size_t> _pieceOffsets;
+        std::vector<std::vector<Range2Di>> _updateRegions;
+};
+
+}}
+
+#endif
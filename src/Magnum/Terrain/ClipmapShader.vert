@@ -0,0 +1,95 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 0)
+#endif
+uniform highp mat4 transformationProjectionMatrix;
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 1)
+#endif
+uniform highp ivec2 offset;
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 2)
+#endif
+uniform highp int level;
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 3)
+#endif
+uniform highp float levelSpacing;
+
+/* Window center in samples of given level, distance where the blend toward
+   the coarser level starts and its reciprocal width */
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 4)
+#endif
+uniform highp vec4 morph;
+
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 0)
+#endif
+uniform highp sampler2DArray heightmap;
+
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = 0)
+#endif
+in highp vec2 position;
+
+out mediump vec3 normal;
+
+/* The texture is addressed toroidally, its size is a power of two */
+highp float height(highp ivec2 coords, highp int layer) {
+    highp ivec2 size = textureSize(heightmap, 0).xy;
+    return texelFetch(heightmap, ivec3(coords & (size - ivec2(1)), layer), 0).r;
+}
+
+void main() {
+    highp ivec2 coords = offset + ivec2(position);
+    highp float h = height(coords, level);
+
+    /* The window has one sample more on the positive side for this */
+    normal = vec3(h - height(coords + ivec2(1, 0), level), levelSpacing,
+                  h - height(coords + ivec2(0, 1), level));
+
+    /* Blend toward the coarser level near the outer edge, so the outermost
+       vertices match the coarser grid exactly */
+    highp vec2 fromCenter = abs(vec2(coords) - morph.xy);
+    highp float alpha = clamp((max(fromCenter.x, fromCenter.y) - morph.z)*morph.w, 0.0, 1.0);
+    if(alpha > 0.0) {
+        highp ivec2 coarse = coords >> 1;
+        highp ivec2 odd = coords & ivec2(1);
+        highp float coarseHeight = 0.25*(
+            height(coarse, level + 1) +
+            height(coarse + ivec2(odd.x, 0), level + 1) +
+            height(coarse + ivec2(0, odd.y), level + 1) +
+            height(coarse + odd, level + 1));
+        h = mix(h, coarseHeight, alpha);
+    }
+
+    gl_Position = transformationProjectionMatrix*vec4(vec2(coords).x*levelSpacing, h, vec2(coords).y*levelSpacing, 1.0);
+}
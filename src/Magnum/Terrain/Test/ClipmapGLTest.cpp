@@ -0,0 +1,153 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Terrain/Clipmap.h"
+
+namespace Magnum { namespace Terrain { namespace Test {
+
+struct ClipmapGLTest: OpenGLTester {
+    explicit ClipmapGLTest();
+
+    void construct();
+
+    void update();
+    void updateNoMove();
+
+    void draw();
+    void drawCulled();
+};
+
+ClipmapGLTest::ClipmapGLTest() {
+    addTests({&ClipmapGLTest::construct,
+
+              &ClipmapGLTest::update,
+              &ClipmapGLTest::updateNoMove,
+
+              &ClipmapGLTest::draw,
+              &ClipmapGLTest::drawCulled});
+}
+
+namespace {
+    /* Slope along X, scaled to given level */
+    void slope(Int level, const Range2Di& samples, Containers::ArrayView<Float> heights) {
+        std::size_t i = 0;
+        for(Int y = samples.bottom(); y != samples.top(); ++y)
+            for(Int x = samples.left(); x != samples.right(); ++x)
+                heights[i++] = Float(x*(1 << level))*0.5f;
+    }
+}
+
+void ClipmapGLTest::construct() {
+    Clipmap clipmap{31, 3, 2.0f, slope};
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(clipmap.heightmap().id() > 0);
+    CORRADE_COMPARE(clipmap.layout().size(), 31);
+    CORRADE_COMPARE(clipmap.layout().levelCount(), 3);
+    CORRADE_COMPARE(clipmap.spacing(), 2.0f);
+    CORRADE_COMPARE(clipmap.levelSpacing(2), 8.0f);
+    CORRADE_COMPARE(clipmap.heightRange(0), Range1D{});
+}
+
+void ClipmapGLTest::update() {
+    std::size_t sampleCount = 0;
+    Clipmap clipmap{31, 3, 1.0f, [&](Int level, const Range2Di& samples, Containers::ArrayView<Float> heights) {
+        sampleCount += heights.size();
+        slope(level, samples, heights);
+    }};
+
+    /* The first update loads whole windows */
+    clipmap.update({0.0f, 10.0f, 0.0f});
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(sampleCount, 3*32*32);
+
+    const Range2Di window = clipmap.layout().window(1);
+    CORRADE_COMPARE(clipmap.heightRange(1), (Range1D{
+        Float(window.left()*2)*0.5f, Float((window.right() - 1)*2)*0.5f}));
+
+    /* Moving loads only the new samples */
+    sampleCount = 0;
+    clipmap.update({2.0f, 10.0f, 0.0f});
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(sampleCount > 0);
+    CORRADE_VERIFY(sampleCount < 32*32);
+}
+
+void ClipmapGLTest::updateNoMove() {
+    std::size_t callCount = 0;
+    Clipmap clipmap{31, 3, 1.0f, [&](Int level, const Range2Di& samples, Containers::ArrayView<Float> heights) {
+        ++callCount;
+        slope(level, samples, heights);
+    }};
+
+    clipmap.update({});
+    callCount = 0;
+
+    /* Not enough to move any level */
+    clipmap.update({0.5f, 100.0f, 0.5f});
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(callCount, 0);
+}
+
+void ClipmapGLTest::draw() {
+    Clipmap clipmap{31, 3, 1.0f, slope};
+    clipmap.setColor({0.2f, 0.8f, 0.3f})
+        .setAmbientColor({0.1f, 0.1f, 0.1f})
+        .update({});
+
+    /* Looking straight down from above, everything is visible */
+    const Matrix4 transformationProjection =
+        Matrix4::orthographicProjection({512.0f, 512.0f}, 1.0f, 1000.0f)*
+        Matrix4::lookAt({0.0f, 500.0f, 0.0f}, {}, Vector3::zAxis()).inverted();
+    CORRADE_COMPARE(clipmap.draw(transformationProjection), 0);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void ClipmapGLTest::drawCulled() {
+    Clipmap clipmap{31, 3, 1.0f, slope};
+    clipmap.update({});
+
+    /* Looking up into the sky, nothing is visible */
+    const Matrix4 transformationProjection =
+        Matrix4::perspectiveProjection(Deg(60.0f), 1.0f, 0.1f, 100.0f)*
+        Matrix4::lookAt({0.0f, 1000.0f, 0.0f}, {0.0f, 2000.0f, 0.0f}, Vector3::zAxis()).inverted();
+
+    std::size_t pieceCount = 0;
+    for(Int level = 0; level != 3; ++level)
+        pieceCount += clipmap.layout().pieces(level).size();
+    CORRADE_COMPARE(clipmap.draw(transformationProjection), pieceCount);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Terrain::Test::ClipmapGLTest)
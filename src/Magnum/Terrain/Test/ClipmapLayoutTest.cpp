@@ -0,0 +1,408 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Terrain/ClipmapLayout.h"
+
+namespace Magnum { namespace Terrain { namespace Test {
+
+struct ClipmapLayoutTest: TestSuite::Tester {
+    explicit ClipmapLayoutTest();
+
+    void construct();
+    void constructInvalid();
+    void notPlaced();
+    void levelOutOfRange();
+
+    void pieceSize();
+    void vertexCount();
+
+    void origins();
+    void coverage();
+    void nesting();
+
+    void updateRegionsInitial();
+    void updateRegionsMove();
+    void updateRegionsJump();
+    void updateRegionsNoMove();
+
+    void debugPieceType();
+};
+
+ClipmapLayoutTest::ClipmapLayoutTest() {
+    addTests({&ClipmapLayoutTest::construct,
+              &ClipmapLayoutTest::constructInvalid,
+              &ClipmapLayoutTest::notPlaced,
+              &ClipmapLayoutTest::levelOutOfRange,
+
+              &ClipmapLayoutTest::pieceSize,
+              &ClipmapLayoutTest::vertexCount,
+
+              &ClipmapLayoutTest::origins,
+              &ClipmapLayoutTest::coverage,
+              &ClipmapLayoutTest::nesting,
+
+              &ClipmapLayoutTest::updateRegionsInitial,
+              &ClipmapLayoutTest::updateRegionsMove,
+              &ClipmapLayoutTest::updateRegionsJump,
+              &ClipmapLayoutTest::updateRegionsNoMove,
+
+              &ClipmapLayoutTest::debugPieceType});
+}
+
+namespace {
+
+/* Positions used for testing the placement, deliberately including negative
+   and odd ones */
+constexpr Vector2 Positions[]{
+    {0.0f, 0.0f},
+    {3.5f, 0.0f},
+    {-1.0f, 2.5f},
+    {-17.25f, -6.0f},
+    {123.0f, -321.75f}
+};
+
+/* Count of pieces covering each quad of given level window */
+std::vector<Int> coverageOf(const ClipmapLayout& layout, const Int level) {
+    const Int size = layout.size() - 1;
+    std::vector<Int> out(size*size);
+    for(const ClipmapPiece& piece: layout.pieces(level)) {
+        if(piece.type == ClipmapPieceType::Edge) continue;
+        const Vector2i min = piece.offset - layout.origin(level);
+        const Vector2i max = min + layout.pieceSize(piece.type);
+        for(Int y = min.y(); y != max.y(); ++y) for(Int x = min.x(); x != max.x(); ++x) {
+            if(x < 0 || y < 0 || x >= size || y >= size) {
+                ++out[0]; /* makes the test fail */
+                continue;
+            }
+            ++out[y*size + x];
+        }
+    }
+    return out;
+}
+
+/* Whether all samples of the window are covered exactly once by given
+   regions, optionally excluding samples that were already in given window */
+bool regionsCoverWindow(const std::vector<Range2Di>& regions, const Range2Di& window, const Range2Di& previous, const Int period) {
+    std::vector<Int> count(window.size().product());
+    for(const Range2Di& region: regions) {
+        /* Each region has to be contiguous in the texture */
+        if(Math::floor(Float(region.min().x())/period) != Math::floor(Float(region.max().x() - 1)/period) ||
+           Math::floor(Float(region.min().y())/period) != Math::floor(Float(region.max().y() - 1)/period))
+            return false;
+
+        for(Int y = region.min().y(); y != region.max().y(); ++y) for(Int x = region.min().x(); x != region.max().x(); ++x) {
+            if(x < window.min().x() || y < window.min().y() || x >= window.max().x() || y >= window.max().y()) return false;
+            ++count[(y - window.min().y())*window.sizeX() + x - window.min().x()];
+        }
+    }
+
+    for(Int y = window.min().y(); y != window.max().y(); ++y) for(Int x = window.min().x(); x != window.max().x(); ++x) {
+        const bool wasThere = x >= previous.min().x() && y >= previous.min().y() && x < previous.max().x() && y < previous.max().y();
+        if(count[(y - window.min().y())*window.sizeX() + x - window.min().x()] != (wasThere ? 0 : 1)) return false;
+    }
+
+    return true;
+}
+
+}
+
+void ClipmapLayoutTest::construct() {
+    ClipmapLayout layout{255, 4};
+
+    CORRADE_COMPARE(layout.size(), 255);
+    CORRADE_COMPARE(layout.levelCount(), 4);
+    CORRADE_COMPARE(layout.blockSize(), 64);
+    CORRADE_COMPARE(layout.textureSize(), 256);
+    CORRADE_VERIFY(!layout.isPlaced());
+}
+
+void ClipmapLayoutTest::constructInvalid() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    ClipmapLayout{3, 4};
+    ClipmapLayout{254, 4};
+    ClipmapLayout{255, 0};
+    ClipmapLayout{255, 17};
+    CORRADE_COMPARE(out.str(),
+        "Terrain::ClipmapLayout: expected size to be one less than a power of two and at least 7, got 3\n"
+        "Terrain::ClipmapLayout: expected size to be one less than a power of two and at least 7, got 254\n"
+        "Terrain::ClipmapLayout: expected level count between 1 and 16, got 0\n"
+        "Terrain::ClipmapLayout: expected level count between 1 and 16, got 17\n");
+}
+
+void ClipmapLayoutTest::notPlaced() {
+    ClipmapLayout layout{15, 2};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    layout.origin(0);
+    layout.window(0);
+    layout.pieces(0);
+    layout.updateRegions(0);
+    CORRADE_COMPARE(out.str(),
+        "Terrain::ClipmapLayout::origin(): the layout is not placed yet\n"
+        "Terrain::ClipmapLayout::window(): the layout is not placed yet\n"
+        "Terrain::ClipmapLayout::pieces(): the layout is not placed yet\n"
+        "Terrain::ClipmapLayout::updateRegions(): the layout is not placed yet\n");
+}
+
+void ClipmapLayoutTest::levelOutOfRange() {
+    ClipmapLayout layout{15, 2};
+    layout.update({});
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    layout.origin(2);
+    layout.window(-1);
+    layout.pieces(2);
+    layout.updateRegions(2);
+    CORRADE_COMPARE(out.str(),
+        "Terrain::ClipmapLayout::origin(): level 2 out of range for 2 levels\n"
+        "Terrain::ClipmapLayout::window(): level -1 out of range for 2 levels\n"
+        "Terrain::ClipmapLayout::pieces(): level 2 out of range for 2 levels\n"
+        "Terrain::ClipmapLayout::updateRegions(): level 2 out of range for 2 levels\n");
+}
+
+void ClipmapLayoutTest::pieceSize() {
+    ClipmapLayout layout{31, 3};
+
+    CORRADE_COMPARE(layout.pieceSize(ClipmapPieceType::Block), (Vector2i{7, 7}));
+    CORRADE_COMPARE(layout.pieceSize(ClipmapPieceType::FixupVertical), (Vector2i{2, 7}));
+    CORRADE_COMPARE(layout.pieceSize(ClipmapPieceType::FixupHorizontal), (Vector2i{7, 2}));
+    CORRADE_COMPARE(layout.pieceSize(ClipmapPieceType::TrimHorizontal), (Vector2i{16, 1}));
+    CORRADE_COMPARE(layout.pieceSize(ClipmapPieceType::TrimVertical), (Vector2i{1, 15}));
+    CORRADE_COMPARE(layout.pieceSize(ClipmapPieceType::Center), (Vector2i{16, 16}));
+    CORRADE_COMPARE(layout.pieceSize(ClipmapPieceType::Edge), (Vector2i{30, 30}));
+
+    CORRADE_COMPARE(layout.pieceVertexCount(ClipmapPieceType::Block), 64);
+    CORRADE_COMPARE(layout.pieceVertexCount(ClipmapPieceType::TrimVertical), 32);
+    CORRADE_COMPARE(layout.pieceVertexCount(ClipmapPieceType::Edge), 124);
+}
+
+void ClipmapLayoutTest::vertexCount() {
+    ClipmapLayout layout{7, 3};
+
+    /* 12 blocks of 2x2 vertices, 4 fix-ups of 3x2, trim of 5x2 + 2x4, center
+       of 5x5 and an edge of 4x7 */
+    CORRADE_COMPARE(layout.vertexCount(), 3*(12*4 + 4*6) + 2*(10 + 8 + 28) + 25);
+
+    /* Doesn't depend on the placement */
+    layout.update({1000.0f, -1000.0f});
+    UnsignedInt count = 0;
+    for(Int level = 0; level != layout.levelCount(); ++level)
+        for(const ClipmapPiece& piece: layout.pieces(level))
+            count += layout.pieceVertexCount(piece.type);
+    CORRADE_COMPARE(count, layout.vertexCount());
+}
+
+void ClipmapLayoutTest::origins() {
+    ClipmapLayout layout{7, 3};
+
+    /* Centered around the origin, the finer level starts m samples into the
+       coarser one */
+    CORRADE_VERIFY(layout.update({0.0f, 0.0f}));
+    CORRADE_VERIFY(layout.isPlaced());
+    CORRADE_COMPARE(layout.origin(0), (Vector2i{-4, -4}));
+    CORRADE_COMPARE(layout.origin(1), (Vector2i{-4, -4}));
+    CORRADE_COMPARE(layout.origin(2), (Vector2i{-4, -4}));
+    CORRADE_COMPARE(layout.window(1), Range2Di::fromSize({-4, -4}, {8, 8}));
+
+    /* The finer level is now m - 1 samples into the coarser one on X */
+    CORRADE_VERIFY(layout.update({3.5f, 0.0f}));
+    CORRADE_COMPARE(layout.origin(0), (Vector2i{-2, -4}));
+    CORRADE_COMPARE(layout.origin(1), (Vector2i{-2, -4}));
+    CORRADE_COMPARE(layout.origin(2), (Vector2i{-2, -4}));
+
+    for(const Vector2& position: Positions) {
+        layout.update(position);
+        for(Int level = 0; level != layout.levelCount(); ++level) {
+            CORRADE_COMPARE(layout.origin(level).x() % 2, 0);
+            CORRADE_COMPARE(layout.origin(level).y() % 2, 0);
+        }
+
+        /* The position is in the central quads of the finest level */
+        const Vector2 relative = position - Vector2{layout.origin(0)};
+        CORRADE_VERIFY(relative.x() >= 4.0f && relative.x() < 6.0f);
+        CORRADE_VERIFY(relative.y() >= 4.0f && relative.y() < 6.0f);
+    }
+}
+
+void ClipmapLayoutTest::coverage() {
+    ClipmapLayout layout{31, 4};
+    const Int size = layout.size() - 1;
+    const Int m = layout.blockSize();
+
+    for(const Vector2& position: Positions) {
+        layout.update(position);
+
+        for(Int level = 0; level != layout.levelCount(); ++level) {
+
+            /* The coarsest level has no edge, the finest has the center
+               instead of the two trim pieces */
+            CORRADE_COMPARE(layout.pieces(level).size(),
+                level == 0 || level == layout.levelCount() - 1 ? 18 : 19);
+
+            /* Everything except the finer level is covered exactly once */
+            Range2Di finer;
+            if(level) finer = Range2Di::fromSize(layout.origin(level - 1)/2 - layout.origin(level), Vector2i{2*m - 1});
+            const std::vector<Int> count = coverageOf(layout, level);
+            bool correct = true;
+            for(Int y = 0; y != size; ++y) for(Int x = 0; x != size; ++x) {
+                const bool inFiner = level && x >= finer.min().x() && y >= finer.min().y() && x < finer.max().x() && y < finer.max().y();
+                if(count[y*size + x] != (inFiner ? 0 : 1)) correct = false;
+            }
+            CORRADE_VERIFY(correct);
+        }
+    }
+}
+
+void ClipmapLayoutTest::nesting() {
+    ClipmapLayout layout{15, 5};
+    const Int m = layout.blockSize();
+
+    for(const Vector2& position: Positions) {
+        layout.update(position);
+
+        for(Int level = 1; level != layout.levelCount(); ++level) {
+
+            /* The finer grid starts either m - 1 or m quads from the coarser
+               origin, so there's space for the trim */
+            const Vector2i offset = layout.origin(level - 1)/2 - layout.origin(level);
+            CORRADE_VERIFY(offset.x() == m - 1 || offset.x() == m);
+            CORRADE_VERIFY(offset.y() == m - 1 || offset.y() == m);
+
+            /* The finer window including the extra sample for normals needs
+               only the coarser window for morphing */
+            const Range2Di finer = layout.window(level - 1);
+            const Range2Di coarser = layout.window(level);
+            CORRADE_VERIFY(finer.min().x()/2 >= coarser.min().x());
+            CORRADE_VERIFY((finer.max().x() + 1)/2 <= coarser.max().x());
+            CORRADE_VERIFY(finer.min().y()/2 >= coarser.min().y());
+            CORRADE_VERIFY((finer.max().y() + 1)/2 <= coarser.max().y());
+        }
+    }
+}
+
+void ClipmapLayoutTest::updateRegionsInitial() {
+    ClipmapLayout layout{7, 2};
+    layout.update({});
+
+    /* The window is split at the texture period */
+    CORRADE_COMPARE(layout.window(0), Range2Di::fromSize({-4, -4}, {8, 8}));
+    CORRADE_COMPARE(layout.updateRegions(0).size(), 4);
+    CORRADE_COMPARE(layout.updateRegions(0)[0], (Range2Di{{-4, -4}, {0, 0}}));
+    CORRADE_COMPARE(layout.updateRegions(0)[3], (Range2Di{{0, 0}, {4, 4}}));
+    CORRADE_VERIFY(regionsCoverWindow(layout.updateRegions(0), layout.window(0), {}, layout.textureSize()));
+    CORRADE_VERIFY(regionsCoverWindow(layout.updateRegions(1), layout.window(1), {}, layout.textureSize()));
+
+    /* A window aligned to the period is not split */
+    layout.update({1004.0f, 4.0f});
+    CORRADE_COMPARE(layout.window(0), Range2Di::fromSize({1000, 0}, {8, 8}));
+    CORRADE_COMPARE(layout.updateRegions(0).size(), 1);
+    CORRADE_VERIFY(regionsCoverWindow(layout.updateRegions(0), layout.window(0), {}, layout.textureSize()));
+}
+
+void ClipmapLayoutTest::updateRegionsMove() {
+    ClipmapLayout layout{31, 3};
+    layout.update(Positions[0]);
+
+    const Vector2 moves[]{
+        {2.0f, 0.0f},
+        {0.0f, -2.0f},
+        {6.0f, 10.0f},
+        {-14.0f, 4.0f},
+        {-30.0f, -30.0f}
+    };
+
+    Vector2 position = Positions[0];
+    for(const Vector2& move: moves) {
+
+        std::vector<Range2Di> previous;
+        for(Int level = 0; level != layout.levelCount(); ++level)
+            previous.push_back(layout.window(level));
+
+        position += move;
+        CORRADE_VERIFY(layout.update(position));
+
+        for(Int level = 0; level != layout.levelCount(); ++level) {
+            CORRADE_VERIFY(regionsCoverWindow(layout.updateRegions(level), layout.window(level), previous[level], layout.textureSize()));
+        }
+    }
+
+    /* Coarser levels move every other step of the finer level, the exposed
+       column is split at the texture period */
+    layout.update({0.0f, 0.0f});
+    layout.update({2.0f, 0.0f});
+    CORRADE_COMPARE(layout.origin(0), (Vector2i{-14, -16}));
+    CORRADE_COMPARE(layout.origin(1), (Vector2i{-14, -16}));
+    layout.update({4.0f, 0.0f});
+    CORRADE_COMPARE(layout.origin(0), (Vector2i{-12, -16}));
+    CORRADE_COMPARE(layout.origin(1), (Vector2i{-14, -16}));
+    CORRADE_COMPARE(layout.updateRegions(0).size(), 2);
+    CORRADE_COMPARE(layout.updateRegions(0)[0], (Range2Di{{18, -16}, {20, 0}}));
+    CORRADE_COMPARE(layout.updateRegions(0)[1], (Range2Di{{18, 0}, {20, 16}}));
+    CORRADE_VERIFY(layout.updateRegions(1).empty());
+    CORRADE_VERIFY(layout.updateRegions(2).empty());
+}
+
+void ClipmapLayoutTest::updateRegionsJump() {
+    ClipmapLayout layout{15, 2};
+    layout.update({});
+
+    /* Moving by more than the window reloads it whole */
+    layout.update({1000.0f, 0.0f});
+    CORRADE_VERIFY(regionsCoverWindow(layout.updateRegions(0), layout.window(0), {}, layout.textureSize()));
+    CORRADE_VERIFY(regionsCoverWindow(layout.updateRegions(1), layout.window(1), {}, layout.textureSize()));
+}
+
+void ClipmapLayoutTest::updateRegionsNoMove() {
+    ClipmapLayout layout{15, 2};
+    layout.update({0.5f, 0.5f});
+
+    /* Moving inside the central quads doesn't change anything */
+    CORRADE_VERIFY(!layout.update({1.5f, 1.0f}));
+    CORRADE_VERIFY(layout.updateRegions(0).empty());
+    CORRADE_VERIFY(layout.updateRegions(1).empty());
+    CORRADE_COMPARE(layout.pieces(0).size(), 18);
+}
+
+void ClipmapLayoutTest::debugPieceType() {
+    std::ostringstream out;
+
+    Debug{&out} << ClipmapPieceType::TrimVertical << ClipmapPieceType(0xde);
+    CORRADE_COMPARE(out.str(), "Terrain::ClipmapPieceType::TrimVertical Terrain::ClipmapPieceType(0xde)\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Terrain::Test::ClipmapLayoutTest)
@@ -28,6 +28,7 @@
 #include <Corrade/TestSuite/Compare/Container.h>
 
 #include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/Buffer.h"
 #include "Magnum/Context.h"
 #include "Magnum/Extensions.h"
 #include "Magnum/Image.h"
@@ -74,6 +75,7 @@ struct AbstractShaderProgramGLTest: OpenGLTester {
     #endif
 
     void compute();
+    void computeIndirect();
 };
 
 AbstractShaderProgramGLTest::AbstractShaderProgramGLTest() {
@@ -100,7 +102,8 @@ AbstractShaderProgramGLTest::AbstractShaderProgramGLTest() {
               &AbstractShaderProgramGLTest::uniformBlockIndexNotFound,
               &AbstractShaderProgramGLTest::uniformBlock,
 
-              &AbstractShaderProgramGLTest::compute
+              &AbstractShaderProgramGLTest::compute,
+              &AbstractShaderProgramGLTest::computeIndirect
               #endif
               });
 }
@@ -643,15 +646,7 @@ void AbstractShaderProgramGLTest::uniformBlock() {
     MAGNUM_VERIFY_NO_ERROR();
 }
 
-void AbstractShaderProgramGLTest::compute() {
-    #ifndef MAGNUM_TARGET_GLES
-    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::compute_shader>())
-        CORRADE_SKIP(Extensions::GL::ARB::compute_shader::string() + std::string(" is not supported."));
-    #else
-    if(!Context::current().isVersionSupported(Version::GLES310))
-        CORRADE_SKIP("OpenGL ES 3.1 is not supported.");
-    #endif
-
+namespace {
     struct ComputeShader: AbstractShaderProgram {
         explicit ComputeShader() {
             Utility::Resource rs("AbstractShaderProgramGLTest");
@@ -675,7 +670,19 @@ void AbstractShaderProgramGLTest::compute() {
             output.bindImage(1, 0, ImageAccess::WriteOnly, ImageFormat::RGBA8UI);
             return *this;
         }
-    } shader;
+    };
+}
+
+void AbstractShaderProgramGLTest::compute() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::compute_shader>())
+        CORRADE_SKIP(Extensions::GL::ARB::compute_shader::string() + std::string(" is not supported."));
+    #else
+    if(!Context::current().isVersionSupported(Version::GLES310))
+        CORRADE_SKIP("OpenGL ES 3.1 is not supported.");
+    #endif
+
+    ComputeShader shader;
 
     MAGNUM_VERIFY_NO_ERROR();
 
@@ -707,6 +714,66 @@ void AbstractShaderProgramGLTest::compute() {
     shader.setImages(in, out)
         .dispatchCompute({1, 1, 1});
 
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(shader.computeWorkGroupSize(), (Vector3i{2, 2, 1}));
+
+    /** @todo Test on ES */
+    #ifndef MAGNUM_TARGET_GLES
+    const auto data = out.image(0, {PixelFormat::RGBAInteger, PixelType::UnsignedByte}).release();
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Color4ub>(data),
+        Containers::arrayView(outData),
+        TestSuite::Compare::Container);
+    #endif
+}
+
+void AbstractShaderProgramGLTest::computeIndirect() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::compute_shader>())
+        CORRADE_SKIP(Extensions::GL::ARB::compute_shader::string() + std::string(" is not supported."));
+    #else
+    if(!Context::current().isVersionSupported(Version::GLES310))
+        CORRADE_SKIP("OpenGL ES 3.1 is not supported.");
+    #endif
+
+    ComputeShader shader;
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    const Color4ub inData[] = {
+        { 10,  20,  30,  40},
+        { 50,  60,  70,  80},
+        { 90, 100, 110, 120},
+        {130, 140, 150, 160}
+    };
+
+    #ifndef MAGNUM_TARGET_GLES
+    const Color4ub outData[] = {
+        { 15,  30,  45,  60},
+        { 75,  90, 105, 120},
+        {135, 150, 165, 180},
+        {195, 210, 225, 240}
+    };
+    #endif
+
+    Texture2D in;
+    in.setStorage(1, TextureFormat::RGBA8UI, {2, 2})
+        .setSubImage(0, {}, ImageView2D{PixelFormat::RGBAInteger, PixelType::UnsignedByte, {2, 2}, inData});
+
+    Texture2D out;
+    out.setStorage(1, TextureFormat::RGBA8UI, {2, 2});
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    const UnsignedInt workgroupCount[]{1, 1, 1};
+    Buffer workgroupCountBuffer;
+    workgroupCountBuffer.setData(workgroupCount, BufferUsage::StaticDraw);
+
+    shader.setImages(in, out)
+        .dispatchComputeIndirect(workgroupCountBuffer);
+
     MAGNUM_VERIFY_NO_ERROR();
 
     /** @todo Test on ES */
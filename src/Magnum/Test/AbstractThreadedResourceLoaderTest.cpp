@@ -0,0 +1,161 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <chrono>
+#include <string>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/AbstractThreadedResourceLoader.h"
+#include "Magnum/ResourceManager.h"
+
+namespace Magnum { namespace Test {
+
+struct AbstractThreadedResourceLoaderTest: TestSuite::Tester {
+    explicit AbstractThreadedResourceLoaderTest();
+
+    void threaded();
+    void noThreads();
+    void budget();
+    void stop();
+};
+
+typedef Magnum::ResourceManager<Int> ResourceManager;
+
+AbstractThreadedResourceLoaderTest::AbstractThreadedResourceLoaderTest() {
+    addTests({&AbstractThreadedResourceLoaderTest::threaded,
+              &AbstractThreadedResourceLoaderTest::noThreads,
+              &AbstractThreadedResourceLoaderTest::budget,
+              &AbstractThreadedResourceLoaderTest::stop});
+}
+
+namespace {
+
+class IntResourceLoader: public AbstractThreadedResourceLoader<Int, std::string> {
+    public:
+        explicit IntResourceLoader(std::size_t threadCount): AbstractThreadedResourceLoader<Int, std::string>{threadCount} {}
+
+        ~IntResourceLoader() { AbstractThreadedResourceLoader<Int, std::string>::stop(); }
+
+        using AbstractThreadedResourceLoader<Int, std::string>::stop;
+
+    private:
+        std::optional<std::string> doDecode(ResourceKey key) override {
+            if(key == ResourceKey("hello")) return std::string{"773"};
+            if(key == ResourceKey("again")) return std::string{"42"};
+            return std::nullopt;
+        }
+
+        void doUpload(ResourceKey key, std::string&& decoded) override {
+            set(key, std::stoi(decoded));
+        }
+};
+
+}
+
+void AbstractThreadedResourceLoaderTest::threaded() {
+    ResourceManager rm;
+    auto loader = new IntResourceLoader{2};
+    rm.setLoader(loader);
+    CORRADE_COMPARE(loader->threadCount(), 2);
+
+    Resource<Int> hello = rm.get<Int>("hello");
+    Resource<Int> world = rm.get<Int>("world");
+    CORRADE_COMPARE(hello.state(), ResourceState::Loading);
+    CORRADE_COMPARE(world.state(), ResourceState::Loading);
+    CORRADE_COMPARE(loader->requestedCount(), 2);
+
+    /* Wait until the workers are done, uploading on this thread */
+    const auto start = std::chrono::steady_clock::now();
+    while(loader->pendingCount() && std::chrono::steady_clock::now() - start < std::chrono::seconds{10}) {
+        loader->update();
+        std::this_thread::yield();
+    }
+
+    CORRADE_COMPARE(loader->pendingCount(), 0);
+    CORRADE_COMPARE(hello.state(), ResourceState::Final);
+    CORRADE_COMPARE(*hello, 773);
+    CORRADE_COMPARE(world.state(), ResourceState::NotFound);
+    CORRADE_COMPARE(loader->loadedCount(), 1);
+    CORRADE_COMPARE(loader->notFoundCount(), 1);
+}
+
+void AbstractThreadedResourceLoaderTest::noThreads() {
+    ResourceManager rm;
+    auto loader = new IntResourceLoader{0};
+    rm.setLoader(loader);
+    CORRADE_COMPARE(loader->threadCount(), 0);
+
+    Resource<Int> hello = rm.get<Int>("hello");
+    CORRADE_COMPARE(hello.state(), ResourceState::Loading);
+    CORRADE_COMPARE(loader->pendingCount(), 1);
+
+    /* Decoding and upload both happen here */
+    CORRADE_COMPARE(loader->update(), 1);
+    CORRADE_COMPARE(loader->pendingCount(), 0);
+    CORRADE_COMPARE(hello.state(), ResourceState::Final);
+    CORRADE_COMPARE(*hello, 773);
+}
+
+void AbstractThreadedResourceLoaderTest::budget() {
+    ResourceManager rm;
+    auto loader = new IntResourceLoader{0};
+    rm.setLoader(loader);
+
+    Resource<Int> hello = rm.get<Int>("hello");
+    Resource<Int> world = rm.get<Int>("world");
+    Resource<Int> again = rm.get<Int>("again");
+    CORRADE_COMPARE(loader->pendingCount(), 3);
+
+    CORRADE_COMPARE(loader->update(2), 2);
+    CORRADE_COMPARE(loader->pendingCount(), 1);
+    CORRADE_COMPARE(hello.state(), ResourceState::Final);
+    CORRADE_COMPARE(world.state(), ResourceState::NotFound);
+    CORRADE_COMPARE(again.state(), ResourceState::Loading);
+
+    CORRADE_COMPARE(loader->update(2), 1);
+    CORRADE_COMPARE(loader->pendingCount(), 0);
+    CORRADE_COMPARE(again.state(), ResourceState::Final);
+    CORRADE_COMPARE(*again, 42);
+}
+
+void AbstractThreadedResourceLoaderTest::stop() {
+    ResourceManager rm;
+    auto loader = new IntResourceLoader{0};
+    rm.setLoader(loader);
+
+    Resource<Int> hello = rm.get<Int>("hello");
+    CORRADE_COMPARE(loader->pendingCount(), 1);
+
+    /* Requests waiting for decoding are discarded */
+    loader->stop();
+    CORRADE_COMPARE(loader->pendingCount(), 0);
+    CORRADE_COMPARE(loader->update(), 0);
+    CORRADE_COMPARE(hello.state(), ResourceState::Loading);
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::AbstractThreadedResourceLoaderTest)
@@ -0,0 +1,183 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstdint>
+#include <Corrade/TestSuite/Tester.h>
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#endif
+
+#include "Magnum/ArrayPool.h"
+
+namespace Magnum { namespace Test {
+
+struct ArrayPoolTest: TestSuite::Tester {
+    explicit ArrayPoolTest();
+
+    void construct();
+
+    void allocate();
+    void allocateAlignment();
+    void reuse();
+    void reuseTooLarge();
+    void maxFreeSize();
+    void clear();
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    void releaseFromOtherThread();
+    #endif
+};
+
+ArrayPoolTest::ArrayPoolTest() {
+    addTests({&ArrayPoolTest::construct,
+
+              &ArrayPoolTest::allocate,
+              &ArrayPoolTest::allocateAlignment,
+              &ArrayPoolTest::reuse,
+              &ArrayPoolTest::reuseTooLarge,
+              &ArrayPoolTest::maxFreeSize,
+              &ArrayPoolTest::clear});
+
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    addTests({&ArrayPoolTest::releaseFromOtherThread});
+    #endif
+}
+
+void ArrayPoolTest::construct() {
+    ArrayPool pool{1024};
+    CORRADE_COMPARE(pool.maxFreeSize(), 1024);
+    CORRADE_COMPARE(pool.usedCount(), 0);
+    CORRADE_COMPARE(pool.freeCount(), 0);
+    CORRADE_COMPARE(pool.freeSize(), 0);
+}
+
+void ArrayPoolTest::allocate() {
+    ArrayPool pool;
+    {
+        Containers::Array<char> a = pool.allocate(100);
+        CORRADE_VERIFY(a);
+        CORRADE_COMPARE(a.size(), 100);
+        a[0] = 'a';
+        a[99] = 'z';
+        CORRADE_COMPARE(pool.usedCount(), 1);
+        CORRADE_COMPARE(pool.freeCount(), 0);
+    }
+
+    /* The memory went back to the pool */
+    CORRADE_COMPARE(pool.usedCount(), 0);
+    CORRADE_COMPARE(pool.freeCount(), 1);
+    CORRADE_COMPARE(pool.freeSize(), 100);
+}
+
+void ArrayPoolTest::allocateAlignment() {
+    ArrayPool pool;
+    Containers::Array<char> a = pool.allocate(3);
+    Containers::Array<char> b = pool.allocate(7);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(a.data()) % alignof(std::max_align_t), 0);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(b.data()) % alignof(std::max_align_t), 0);
+}
+
+void ArrayPoolTest::reuse() {
+    ArrayPool pool;
+    char* data;
+    {
+        Containers::Array<char> a = pool.allocate(1000);
+        data = a.data();
+    }
+
+    /* Smaller array fits into the free one */
+    Containers::Array<char> b = pool.allocate(800);
+    CORRADE_COMPARE(b.data(), data);
+    CORRADE_COMPARE(b.size(), 800);
+    CORRADE_COMPARE(pool.freeCount(), 0);
+
+    /* The full capacity is kept when returned */
+    b = nullptr;
+    CORRADE_COMPARE(pool.freeSize(), 1000);
+    Containers::Array<char> c = pool.allocate(1000);
+    CORRADE_COMPARE(c.data(), data);
+}
+
+void ArrayPoolTest::reuseTooLarge() {
+    ArrayPool pool;
+    {
+        Containers::Array<char> a = pool.allocate(1000);
+        Containers::Array<char> b = pool.allocate(300);
+    }
+    CORRADE_COMPARE(pool.freeCount(), 2);
+
+    /* 300 is the smallest that fits */
+    Containers::Array<char> c = pool.allocate(250);
+    CORRADE_COMPARE(pool.freeCount(), 1);
+    CORRADE_COMPARE(pool.freeSize(), 1000);
+
+    /* 1000 is more than twice as large, a new array is allocated */
+    Containers::Array<char> d = pool.allocate(200);
+    CORRADE_COMPARE(pool.freeCount(), 1);
+    CORRADE_COMPARE(pool.usedCount(), 2);
+}
+
+void ArrayPoolTest::maxFreeSize() {
+    ArrayPool pool;
+    pool.setMaxFreeSize(1500);
+    CORRADE_COMPARE(pool.maxFreeSize(), 1500);
+    {
+        Containers::Array<char> a = pool.allocate(1000);
+        Containers::Array<char> b = pool.allocate(1000);
+    }
+
+    /* Only one fits into the limit */
+    CORRADE_COMPARE(pool.usedCount(), 0);
+    CORRADE_COMPARE(pool.freeCount(), 1);
+    CORRADE_COMPARE(pool.freeSize(), 1000);
+}
+
+void ArrayPoolTest::clear() {
+    ArrayPool pool;
+    Containers::Array<char> a = pool.allocate(100);
+    {
+        Containers::Array<char> b = pool.allocate(200);
+    }
+    CORRADE_COMPARE(pool.freeCount(), 1);
+
+    pool.clear();
+    CORRADE_COMPARE(pool.freeCount(), 0);
+    CORRADE_COMPARE(pool.freeSize(), 0);
+    CORRADE_COMPARE(pool.usedCount(), 1);
+}
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+void ArrayPoolTest::releaseFromOtherThread() {
+    ArrayPool pool;
+    Containers::Array<char> a = pool.allocate(100);
+    std::thread{[&a]() { a = nullptr; }}.join();
+    CORRADE_COMPARE(pool.usedCount(), 0);
+    CORRADE_COMPARE(pool.freeCount(), 1);
+}
+#endif
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::ArrayPoolTest)
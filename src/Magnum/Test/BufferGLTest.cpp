@@ -32,6 +32,7 @@
 #include "Magnum/Context.h"
 #include "Magnum/Extensions.h"
 #include "Magnum/OpenGLTester.h"
+#include "Magnum/Renderer.h"
 
 namespace Magnum { namespace Test {
 
@@ -51,12 +52,18 @@ struct BufferGLTest: OpenGLTester {
     #endif
 
     void data();
+    #ifndef MAGNUM_TARGET_GLES
+    void storage();
+    #endif
     void map();
     #ifdef CORRADE_TARGET_NACL
     void mapSub();
     #endif
     void mapRange();
     void mapRangeExplicitFlush();
+    #ifndef MAGNUM_TARGET_GLES
+    void mapPersistent();
+    #endif
     #ifndef MAGNUM_TARGET_GLES2
     void copy();
     #endif
@@ -77,12 +84,18 @@ BufferGLTest::BufferGLTest() {
               #endif
 
               &BufferGLTest::data,
+              #ifndef MAGNUM_TARGET_GLES
+              &BufferGLTest::storage,
+              #endif
               &BufferGLTest::map,
               #ifdef CORRADE_TARGET_NACL
               &BufferGLTest::mapSub,
               #endif
               &BufferGLTest::mapRange,
               &BufferGLTest::mapRangeExplicitFlush,
+              #ifndef MAGNUM_TARGET_GLES
+              &BufferGLTest::mapPersistent,
+              #endif
               #ifndef MAGNUM_TARGET_GLES2
               &BufferGLTest::copy,
               #endif
@@ -266,6 +279,35 @@ void BufferGLTest::data() {
     #endif
 }
 
+#ifndef MAGNUM_TARGET_GLES
+void BufferGLTest::storage() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::buffer_storage>())
+        CORRADE_SKIP(Extensions::GL::ARB::buffer_storage::string() + std::string(" is not supported"));
+
+    Buffer buffer;
+
+    constexpr Int data[] = {2, 7, 5, 13, 25};
+    buffer.setStorage(data, Buffer::StorageFlag::DynamicStorage);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(buffer.size(), 5*4);
+
+    /* Dynamic storage allows updating the contents */
+    constexpr Int subData[] = {125, 3, 15};
+    buffer.setSubData(4, subData);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    constexpr Int expected[] = {2, 125, 3, 15, 25};
+    const Containers::Array<Int> contents = buffer.data<Int>();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE_AS(contents, Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+
+    /* Storage is immutable, reallocating it is an error */
+    buffer.setStorage(data, Buffer::StorageFlag::DynamicStorage);
+    CORRADE_COMPARE(Renderer::error(), Renderer::Error::InvalidOperation);
+}
+#endif
+
 void BufferGLTest::map() {
     #ifdef MAGNUM_TARGET_GLES
     if(!Context::current().isExtensionSupported<Extensions::GL::OES::mapbuffer>())
@@ -394,6 +436,39 @@ void BufferGLTest::mapRangeExplicitFlush() {
     #endif
 }
 
+#ifndef MAGNUM_TARGET_GLES
+void BufferGLTest::mapPersistent() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::buffer_storage>())
+        CORRADE_SKIP(Extensions::GL::ARB::buffer_storage::string() + std::string(" is not supported"));
+
+    Buffer buffer;
+
+    constexpr char data[] = {2, 7, 5, 13, 25};
+    buffer.setStorage(data, Buffer::StorageFlag::MapRead|Buffer::StorageFlag::MapWrite|Buffer::StorageFlag::MapPersistent|Buffer::StorageFlag::MapCoherent);
+
+    char* contents = buffer.map<char>(0, 5, Buffer::MapFlag::Read|Buffer::MapFlag::Write|Buffer::MapFlag::Persistent|Buffer::MapFlag::Coherent);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_VERIFY(contents);
+    CORRADE_COMPARE(contents[2], 5);
+    contents[3] = 107;
+
+    /* The buffer can be used while mapped, coherent mapping makes the write
+       visible without explicit flush */
+    Buffer copy;
+    copy.setData({nullptr, 5}, BufferUsage::StaticCopy);
+    Buffer::copy(buffer, copy, 0, 0, 5);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    const Containers::Array<char> changedContents = copy.data<char>();
+    CORRADE_COMPARE(changedContents.size(), 5);
+    CORRADE_COMPARE(changedContents[3], 107);
+
+    CORRADE_VERIFY(buffer.unmap());
+    MAGNUM_VERIFY_NO_ERROR();
+}
+#endif
+
 #ifndef MAGNUM_TARGET_GLES2
 void BufferGLTest::copy() {
     Buffer buffer1;
@@ -0,0 +1,202 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/BufferHeap.h"
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/OpenGLTester.h"
+
+namespace Magnum { namespace Test {
+
+struct BufferHeapGLTest: OpenGLTester {
+    explicit BufferHeapGLTest();
+
+    void construct();
+    void constructCopy();
+
+    void allocate();
+    void allocateData();
+    void allocateNewPage();
+    void allocateLargerThanPage();
+    void deallocate();
+    #ifndef MAGNUM_TARGET_GLES2
+    void defragment();
+    #endif
+};
+
+BufferHeapGLTest::BufferHeapGLTest() {
+    addTests({&BufferHeapGLTest::construct,
+              &BufferHeapGLTest::constructCopy,
+
+              &BufferHeapGLTest::allocate,
+              &BufferHeapGLTest::allocateData,
+              &BufferHeapGLTest::allocateNewPage,
+              &BufferHeapGLTest::allocateLargerThanPage,
+              &BufferHeapGLTest::deallocate,
+              #ifndef MAGNUM_TARGET_GLES2
+              &BufferHeapGLTest::defragment
+              #endif
+              });
+}
+
+void BufferHeapGLTest::construct() {
+    BufferHeap heap{Buffer::TargetHint::Array, 1024};
+    CORRADE_COMPARE(heap.pageSize(), 1024);
+    CORRADE_COMPARE(heap.pageCount(), 0);
+    CORRADE_COMPARE(heap.allocationCount(), 0);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void BufferHeapGLTest::constructCopy() {
+    CORRADE_VERIFY(!(std::is_constructible<BufferHeap, const BufferHeap&>{}));
+    CORRADE_VERIFY(!(std::is_assignable<BufferHeap, const BufferHeap&>{}));
+}
+
+void BufferHeapGLTest::allocate() {
+    BufferHeap heap{Buffer::TargetHint::Array, 1024};
+    BufferHeap::Allocation a = heap.allocate(100);
+    BufferHeap::Allocation b = heap.allocate(32, 16);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(heap.pageCount(), 1);
+    CORRADE_VERIFY(heap.buffer(0).id() > 0);
+    CORRADE_COMPARE(heap.buffer(0).size(), 1024);
+    CORRADE_COMPARE(heap.allocationCount(), 2);
+    CORRADE_COMPARE(a.page, 0);
+    CORRADE_COMPARE(a.offset, 0);
+    CORRADE_COMPARE(a.size, 100);
+    CORRADE_COMPARE(b.page, 0);
+    CORRADE_COMPARE(b.offset, 112);
+    CORRADE_COMPARE(b.size, 32);
+}
+
+void BufferHeapGLTest::allocateData() {
+    BufferHeap heap{Buffer::TargetHint::Array, 64};
+    heap.allocate(4);
+    constexpr Int data[]{3, 15, 42};
+    BufferHeap::Allocation a = heap.allocate(data, 8);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(a.offset, 8);
+    CORRADE_COMPARE(a.size, 12);
+
+    /** @todo How to verify the contents in ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    const Containers::Array<Int> contents = heap.buffer(a.page).subData<Int>(a.offset, 3);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE_AS(contents, Containers::arrayView(data),
+        TestSuite::Compare::Container);
+    #endif
+}
+
+void BufferHeapGLTest::allocateNewPage() {
+    BufferHeap heap{Buffer::TargetHint::Array, 64};
+    heap.allocate(48);
+    BufferHeap::Allocation b = heap.allocate(32);
+    BufferHeap::Allocation c = heap.allocate(16);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(heap.pageCount(), 2);
+    CORRADE_COMPARE(b.page, 1);
+    CORRADE_COMPARE(b.offset, 0);
+
+    /* The hole in the first page is used again */
+    CORRADE_COMPARE(c.page, 0);
+    CORRADE_COMPARE(c.offset, 48);
+}
+
+void BufferHeapGLTest::allocateLargerThanPage() {
+    BufferHeap heap{Buffer::TargetHint::Array, 64};
+    BufferHeap::Allocation a = heap.allocate(100);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(heap.pageCount(), 1);
+    CORRADE_COMPARE(a.offset, 0);
+    CORRADE_COMPARE(heap.buffer(0).size(), 100);
+    CORRADE_COMPARE(heap.allocator(0).available(), 0);
+}
+
+void BufferHeapGLTest::deallocate() {
+    BufferHeap heap{Buffer::TargetHint::Array, 64};
+    BufferHeap::Allocation a = heap.allocate(64);
+    const GLuint id = heap.buffer(0).id();
+    heap.deallocate(a);
+
+    CORRADE_COMPARE(heap.allocationCount(), 0);
+    CORRADE_COMPARE(heap.allocator(0).available(), 64);
+
+    /* The page buffer is reused */
+    BufferHeap::Allocation b = heap.allocate(64);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(heap.pageCount(), 1);
+    CORRADE_COMPARE(b.page, 0);
+    CORRADE_COMPARE(heap.buffer(0).id(), id);
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void BufferHeapGLTest::defragment() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::copy_buffer>())
+        CORRADE_SKIP(Extensions::GL::ARB::copy_buffer::string() + std::string(" is not supported."));
+    #endif
+
+    BufferHeap heap{Buffer::TargetHint::Array, 64};
+    constexpr Int first[]{1, 2, 3, 4};
+    constexpr Int second[]{5, 6, 7};
+    constexpr Int third[]{8, 9};
+    BufferHeap::Allocation a = heap.allocate(first);
+    BufferHeap::Allocation b = heap.allocate(second);
+    BufferHeap::Allocation c = heap.allocate(third);
+    heap.deallocate(a);
+    const GLuint id = heap.buffer(0).id();
+
+    const std::vector<std::pair<BufferHeap::Allocation, BufferHeap::Allocation>> moved = heap.defragment();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(heap.buffer(0).id(), id);
+    CORRADE_COMPARE(moved.size(), 2);
+    CORRADE_COMPARE(moved[0].first.offset, b.offset);
+    CORRADE_COMPARE(moved[0].second.offset, 0);
+    CORRADE_COMPARE(moved[1].first.offset, c.offset);
+    CORRADE_COMPARE(moved[1].second.offset, 12);
+    CORRADE_COMPARE(heap.allocator(0).largestFreeRange(), 44);
+
+    /** @todo How to verify the contents in ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    constexpr Int expected[]{5, 6, 7, 8, 9};
+    const Containers::Array<Int> contents = heap.buffer(0).subData<Int>(0, 5);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE_AS(contents, Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+    #endif
+}
+#endif
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::BufferHeapGLTest)
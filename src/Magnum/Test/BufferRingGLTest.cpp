@@ -0,0 +1,147 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/BufferRing.h"
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/OpenGLTester.h"
+
+namespace Magnum { namespace Test {
+
+struct BufferRingGLTest: OpenGLTester {
+    explicit BufferRingGLTest();
+
+    void construct();
+    void constructCopy();
+
+    void allocate();
+    void allocateAligned();
+    void nextFrame();
+};
+
+BufferRingGLTest::BufferRingGLTest() {
+    addTests({&BufferRingGLTest::construct,
+              &BufferRingGLTest::constructCopy,
+
+              &BufferRingGLTest::allocate,
+              &BufferRingGLTest::allocateAligned,
+              &BufferRingGLTest::nextFrame});
+}
+
+void BufferRingGLTest::construct() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::buffer_storage>())
+        CORRADE_SKIP(Extensions::GL::ARB::buffer_storage::string() + std::string(" is not available"));
+
+    {
+        BufferRing ring{Buffer::TargetHint::Uniform, 256};
+
+        MAGNUM_VERIFY_NO_ERROR();
+        CORRADE_VERIFY(ring.buffer().id() > 0);
+        CORRADE_COMPARE(ring.buffer().targetHint(), Buffer::TargetHint::Uniform);
+        CORRADE_COMPARE(ring.buffer().size(), 3*256);
+        CORRADE_COMPARE(ring.regionSize(), 256);
+        CORRADE_COMPARE(ring.regionCount(), 3);
+        CORRADE_COMPARE(ring.currentRegion(), 0);
+        CORRADE_COMPARE(ring.available(), 256);
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void BufferRingGLTest::constructCopy() {
+    CORRADE_VERIFY(!(std::is_constructible<BufferRing, const BufferRing&>{}));
+    CORRADE_VERIFY(!(std::is_assignable<BufferRing, const BufferRing&>{}));
+}
+
+void BufferRingGLTest::allocate() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::buffer_storage>())
+        CORRADE_SKIP(Extensions::GL::ARB::buffer_storage::string() + std::string(" is not available"));
+
+    BufferRing ring{Buffer::TargetHint::Array, 16, 2};
+
+    std::pair<GLintptr, Containers::ArrayView<char>> a = ring.allocate(5);
+    CORRADE_COMPARE(a.first, 0);
+    CORRADE_COMPARE(a.second.size(), 5);
+    CORRADE_COMPARE(ring.available(), 11);
+
+    std::pair<GLintptr, Containers::ArrayView<char>> b = ring.allocate(3);
+    CORRADE_COMPARE(b.first, 5);
+    CORRADE_COMPARE(b.second.size(), 3);
+    CORRADE_COMPARE(b.second.data(), a.second.data() + 5);
+    CORRADE_COMPARE(ring.available(), 8);
+
+    /* The writes are visible without explicit flush */
+    b.second[1] = 42;
+    Containers::Array<char> contents = ring.buffer().subData<char>(6, 1);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(contents[0], 42);
+}
+
+void BufferRingGLTest::allocateAligned() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::buffer_storage>())
+        CORRADE_SKIP(Extensions::GL::ARB::buffer_storage::string() + std::string(" is not available"));
+
+    BufferRing ring{Buffer::TargetHint::Array, 24, 2};
+
+    ring.allocate(3);
+    std::pair<GLintptr, Containers::ArrayView<char>> a = ring.allocate(4, 8);
+    CORRADE_COMPARE(a.first, 8);
+    CORRADE_COMPARE(ring.available(), 12);
+
+    /* Alignment is relative to the buffer start, not region start */
+    ring.nextFrame();
+    ring.allocate(1);
+    std::pair<GLintptr, Containers::ArrayView<char>> b = ring.allocate(4, 16);
+    CORRADE_COMPARE(b.first, 32);
+    CORRADE_COMPARE(ring.available(), 12);
+}
+
+void BufferRingGLTest::nextFrame() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::buffer_storage>())
+        CORRADE_SKIP(Extensions::GL::ARB::buffer_storage::string() + std::string(" is not available"));
+
+    BufferRing ring{Buffer::TargetHint::Array, 16};
+
+    ring.allocate(10);
+    ring.nextFrame();
+    CORRADE_COMPARE(ring.currentRegion(), 1);
+    CORRADE_COMPARE(ring.available(), 16);
+    CORRADE_COMPARE(ring.allocate(4).first, 16);
+
+    ring.nextFrame();
+    CORRADE_COMPARE(ring.allocate(4).first, 32);
+
+    /* Wraps around back to the first region */
+    ring.nextFrame();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(ring.currentRegion(), 0);
+    CORRADE_COMPARE(ring.allocate(4).first, 0);
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::BufferRingGLTest)
@@ -0,0 +1,254 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/CommandBuffer.h"
+
+namespace Magnum { namespace Test {
+
+struct CommandBufferTest: Corrade::TestSuite::Tester {
+    explicit CommandBufferTest();
+
+    void construct();
+    void constructMove();
+
+    void record();
+    void recordLarge();
+    void allocateData();
+    void executeTwice();
+    void clear();
+    void clearReuse();
+    void recordThreaded();
+};
+
+CommandBufferTest::CommandBufferTest() {
+    addTests({&CommandBufferTest::construct,
+              &CommandBufferTest::constructMove,
+
+              &CommandBufferTest::record,
+              &CommandBufferTest::recordLarge,
+              &CommandBufferTest::allocateData,
+              &CommandBufferTest::executeTwice,
+              &CommandBufferTest::clear,
+              &CommandBufferTest::clearReuse,
+              &CommandBufferTest::recordThreaded});
+}
+
+namespace {
+    struct Counted {
+        explicit Counted(int& counter): counter(&counter) { ++*this->counter; }
+        Counted(const Counted& other): counter{other.counter} { ++*counter; }
+        ~Counted() { --*counter; }
+
+        int* counter;
+    };
+}
+
+void CommandBufferTest::construct() {
+    CommandBuffer commands{1024};
+    CORRADE_COMPARE(commands.chunkSize(), 1024);
+    CORRADE_COMPARE(commands.commandCount(), 0);
+    CORRADE_VERIFY(commands.isEmpty());
+    CORRADE_COMPARE(commands.allocatedSize(), 0);
+}
+
+void CommandBufferTest::constructMove() {
+    std::vector<int> order;
+    CommandBuffer a{1024};
+    a.record([&order]() { order.push_back(1); });
+
+    CommandBuffer b{std::move(a)};
+    CORRADE_VERIFY(a.isEmpty());
+    CORRADE_COMPARE(a.allocatedSize(), 0);
+    CORRADE_COMPARE(b.commandCount(), 1);
+    CORRADE_COMPARE(b.chunkSize(), 1024);
+
+    CommandBuffer c{512};
+    c.record([&order]() { order.push_back(2); });
+    c = std::move(b);
+    CORRADE_COMPARE(c.commandCount(), 1);
+    CORRADE_COMPARE(c.chunkSize(), 1024);
+
+    c.execute();
+    b.execute();
+    CORRADE_COMPARE_AS(order, (std::vector<int>{1, 2}),
+        Corrade::TestSuite::Compare::Container);
+}
+
+void CommandBufferTest::record() {
+    std::vector<int> order;
+    CommandBuffer commands{1024};
+    for(int i = 0; i != 5; ++i)
+        commands.record([&order, i]() { order.push_back(i); });
+
+    CORRADE_COMPARE(commands.commandCount(), 5);
+    CORRADE_VERIFY(!commands.isEmpty());
+    CORRADE_COMPARE(commands.allocatedSize(), 1024);
+    CORRADE_VERIFY(order.empty());
+
+    commands.execute();
+    CORRADE_COMPARE_AS(order, (std::vector<int>{0, 1, 2, 3, 4}),
+        Corrade::TestSuite::Compare::Container);
+}
+
+void CommandBufferTest::recordLarge() {
+    std::vector<int> order;
+    CommandBuffer commands{128};
+
+    /* Spans many chunks */
+    for(int i = 0; i != 100; ++i)
+        commands.record([&order, i]() { order.push_back(i); });
+
+    /* Larger than a chunk, gets its own */
+    struct Large { char data[500]; };
+    Large large{};
+    large.data[499] = 7;
+    commands.record([&order, large]() { order.push_back(large.data[499]); });
+
+    CORRADE_COMPARE(commands.commandCount(), 101);
+    CORRADE_VERIFY(commands.allocatedSize() >= 100*sizeof(int*) + 500);
+
+    commands.execute();
+    CORRADE_COMPARE(order.size(), 101);
+    for(int i = 0; i != 100; ++i) CORRADE_COMPARE(order[i], i);
+    CORRADE_COMPARE(order[100], 7);
+}
+
+void CommandBufferTest::allocateData() {
+    std::vector<int> order;
+    CommandBuffer commands{64};
+
+    const Containers::ArrayView<char> data = commands.allocateData(200);
+    CORRADE_COMPARE(data.size(), 200);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(data.data()) % alignof(std::max_align_t), 0);
+    for(std::size_t i = 0; i != data.size(); ++i) data[i] = char(i);
+
+    commands.record([&order, data]() {
+        for(char c: data) order.push_back(c);
+    });
+
+    /* Data are not counted as commands and not executed */
+    CORRADE_COMPARE(commands.commandCount(), 1);
+
+    commands.execute();
+    CORRADE_COMPARE(order.size(), 200);
+    CORRADE_COMPARE(order[0], 0);
+    CORRADE_COMPARE(order[199], char(199));
+}
+
+void CommandBufferTest::executeTwice() {
+    int count = 0;
+    CommandBuffer commands;
+    commands.record([&count]() { ++count; });
+
+    commands.execute();
+    commands.execute();
+    CORRADE_COMPARE(count, 2);
+    CORRADE_COMPARE(commands.commandCount(), 1);
+}
+
+void CommandBufferTest::clear() {
+    int alive = 0;
+    int executed = 0;
+    {
+        CommandBuffer commands;
+        Counted counted{alive};
+        commands.record([counted, &executed]() { ++executed; })
+            .record([counted, &executed]() { ++executed; });
+        CORRADE_COMPARE(alive, 3);
+
+        commands.clear();
+        CORRADE_COMPARE(alive, 1);
+        CORRADE_VERIFY(commands.isEmpty());
+
+        /* Nothing to execute anymore */
+        commands.execute();
+        CORRADE_COMPARE(executed, 0);
+
+        /* Destructor destroys the commands as well */
+        commands.record([counted]() {});
+        CORRADE_COMPARE(alive, 2);
+    }
+
+    CORRADE_COMPARE(alive, 0);
+}
+
+void CommandBufferTest::clearReuse() {
+    std::vector<int> order;
+    CommandBuffer commands{128};
+    for(int i = 0; i != 50; ++i)
+        commands.record([&order, i]() { order.push_back(i); });
+
+    const std::size_t allocated = commands.allocatedSize();
+    commands.clear();
+    CORRADE_COMPARE(commands.allocatedSize(), allocated);
+
+    /* Recording the same amount again doesn't allocate anything */
+    for(int i = 0; i != 50; ++i)
+        commands.record([&order, i]() { order.push_back(100 + i); });
+    CORRADE_COMPARE(commands.allocatedSize(), allocated);
+
+    /* Something not fitting into the kept chunks is put in front of them so
+       the order is preserved */
+    commands.clear();
+    struct Large { char data[300]; };
+    Large large{};
+    commands.record([&order]() { order.push_back(0); })
+        .record([&order, large]() { order.push_back(1 + large.data[0]); })
+        .record([&order]() { order.push_back(2); });
+    CORRADE_VERIFY(commands.allocatedSize() > allocated);
+
+    order.clear();
+    commands.execute();
+    CORRADE_COMPARE_AS(order, (std::vector<int>{0, 1, 2}),
+        Corrade::TestSuite::Compare::Container);
+}
+
+void CommandBufferTest::recordThreaded() {
+    std::vector<int> order;
+    CommandBuffer commands[4];
+
+    /* Each thread records into its own buffer */
+    std::vector<std::thread> threads;
+    for(int t = 0; t != 4; ++t) threads.emplace_back([&order, &commands, t]() {
+        for(int i = 0; i != 100; ++i)
+            commands[t].record([&order, t, i]() { order.push_back(t*100 + i); });
+    });
+    for(std::thread& thread: threads) thread.join();
+
+    /* Played back in order on a single thread */
+    for(CommandBuffer& c: commands) c.execute();
+    CORRADE_COMPARE(order.size(), 400);
+    for(int i = 0; i != 400; ++i) CORRADE_COMPARE(order[i], i);
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::CommandBufferTest)
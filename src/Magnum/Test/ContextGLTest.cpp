@@ -25,9 +25,12 @@
 
 #include <algorithm>
 
+#include "Magnum/Buffer.h"
 #include "Magnum/Context.h"
 #include "Magnum/Extensions.h"
 #include "Magnum/OpenGLTester.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/Texture.h"
 
 namespace Magnum { namespace Test {
 
@@ -43,6 +46,9 @@ struct ContextGLTest: OpenGLTester {
     void supportedVersion();
     void isExtensionSupported();
     void isExtensionDisabled();
+
+    void stateStatistics();
+    void deferredDeletion();
 };
 
 ContextGLTest::ContextGLTest() {
@@ -54,7 +60,10 @@ ContextGLTest::ContextGLTest() {
               #endif
               &ContextGLTest::supportedVersion,
               &ContextGLTest::isExtensionSupported,
-              &ContextGLTest::isExtensionDisabled});
+              &ContextGLTest::isExtensionDisabled,
+
+              &ContextGLTest::stateStatistics,
+              &ContextGLTest::deferredDeletion});
 }
 
 void ContextGLTest::constructCopyMove() {
@@ -139,6 +148,87 @@ void ContextGLTest::isExtensionDisabled() {
     #endif
 }
 
+void ContextGLTest::stateStatistics() {
+    /* Make the tracker forget everything so the first calls always pass */
+    Context::current().resetState(Context::State::Renderer);
+    Context::current().resetStateStatistics();
+
+    Renderer::enable(Renderer::Feature::DepthTest);
+    Renderer::setDepthFunction(Renderer::DepthFunction::LessOrEqual);
+    Renderer::setStencilMask(0xff);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(Context::current().stateStatistics().issuedCalls, 3);
+    CORRADE_COMPARE(Context::current().stateStatistics().skippedCalls, 0);
+
+    /* Redundant calls are skipped */
+    Renderer::setFeature(Renderer::Feature::DepthTest, true);
+    Renderer::setDepthFunction(Renderer::DepthFunction::LessOrEqual);
+    Renderer::setStencilMask(Renderer::PolygonFacing::Back, 0xff);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(Context::current().stateStatistics().issuedCalls, 3);
+    CORRADE_COMPARE(Context::current().stateStatistics().skippedCalls, 3);
+
+    /* Changed state passes through, the tracked state is not forgotten by
+       resetting the statistics */
+    Context::current().resetStateStatistics();
+    Renderer::disable(Renderer::Feature::DepthTest);
+    Renderer::setStencilMask(Renderer::PolygonFacing::Front, 0xff);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(Context::current().stateStatistics().issuedCalls, 1);
+    CORRADE_COMPARE(Context::current().stateStatistics().skippedCalls, 1);
+
+    /* After a state reset everything passes through again */
+    Context::current().resetState(Context::State::Renderer);
+    Renderer::disable(Renderer::Feature::DepthTest);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(Context::current().stateStatistics().issuedCalls, 2);
+}
+
+void ContextGLTest::deferredDeletion() {
+    CORRADE_VERIFY(!Context::current().isDeletionDeferred());
+    Context::current().setDeletionDeferred(true);
+    CORRADE_VERIFY(Context::current().isDeletionDeferred());
+
+    GLuint bufferId, textureId;
+    {
+        std::vector<Buffer> buffers = Buffer::createArray(3);
+        Texture2D texture;
+        bufferId = buffers[1].id();
+        textureId = texture.id();
+
+        /* Force the objects to be created so glIs*() reports them */
+        buffers[1].setData({nullptr, 4}, BufferUsage::StaticDraw);
+        texture.bind(0);
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(Context::current().deferredDeletionCount(), 4);
+    CORRADE_VERIFY(glIsBuffer(bufferId));
+    CORRADE_VERIFY(glIsTexture(textureId));
+
+    Context::current().flushDeletions();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(Context::current().deferredDeletionCount(), 0);
+    CORRADE_VERIFY(!glIsBuffer(bufferId));
+    CORRADE_VERIFY(!glIsTexture(textureId));
+
+    /* Disabling flushes the queue */
+    {
+        Buffer buffer;
+    }
+    CORRADE_COMPARE(Context::current().deferredDeletionCount(), 1);
+    Context::current().setDeletionDeferred(false);
+    CORRADE_VERIFY(!Context::current().isDeletionDeferred());
+    CORRADE_COMPARE(Context::current().deferredDeletionCount(), 0);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
 }}
 
 CORRADE_TEST_MAIN(Magnum::Test::ContextGLTest)
@@ -82,6 +82,7 @@ struct CubeMapTextureGLTest: OpenGLTester {
     #ifndef MAGNUM_TARGET_GLES2
     void subImageBuffer();
     #endif
+    void subImages();
     #ifndef MAGNUM_TARGET_GLES
     void subImageQuery();
     void subImageQueryBuffer();
@@ -320,6 +321,7 @@ CubeMapTextureGLTest::CubeMapTextureGLTest() {
         #ifndef MAGNUM_TARGET_GLES2
         &CubeMapTextureGLTest::subImageBuffer,
         #endif
+        &CubeMapTextureGLTest::subImages,
         #ifndef MAGNUM_TARGET_GLES
         &CubeMapTextureGLTest::subImageQuery,
         &CubeMapTextureGLTest::subImageQueryBuffer
@@ -744,6 +746,45 @@ void CubeMapTextureGLTest::subImageBuffer() {
 }
 #endif
 
+void CubeMapTextureGLTest::subImages() {
+    setTestCaseDescription(PixelStorageData[testCaseInstanceId()].name);
+
+    #ifdef MAGNUM_TARGET_GLES2
+    if(PixelStorageData[testCaseInstanceId()].storage != PixelStorage{} && !Context::current().isExtensionSupported<Extensions::GL::EXT::unpack_subimage>())
+        CORRADE_SKIP(Extensions::GL::EXT::unpack_subimage::string() + std::string(" is not supported."));
+    #endif
+
+    CubeMapTexture texture;
+    texture.setImage(CubeMapCoordinate::PositiveX, 0, TextureFormat::RGBA8,
+        ImageView2D(PixelFormat::RGBA, PixelType::UnsignedByte, Vector2i(4), Zero));
+    texture.setImage(CubeMapCoordinate::NegativeZ, 0, TextureFormat::RGBA8,
+        ImageView2D(PixelFormat::RGBA, PixelType::UnsignedByte, Vector2i(4), Zero));
+    texture.setSubImages({
+        {CubeMapCoordinate::PositiveX, 0, Vector2i(1), ImageView2D{
+            PixelStorageData[testCaseInstanceId()].storage,
+            PixelFormat::RGBA, PixelType::UnsignedByte, Vector2i(2),
+            PixelStorageData[testCaseInstanceId()].dataSparse}},
+        {CubeMapCoordinate::NegativeZ, 0, Vector2i(1), ImageView2D{
+            PixelStorageData[testCaseInstanceId()].storage,
+            PixelFormat::RGBA, PixelType::UnsignedByte, Vector2i(2),
+            PixelStorageData[testCaseInstanceId()].dataSparse}}});
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /** @todo How to test this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    for(CubeMapCoordinate coordinate: {CubeMapCoordinate::PositiveX, CubeMapCoordinate::NegativeZ}) {
+        Image2D image = texture.image(coordinate, 0, {PixelFormat::RGBA, PixelType::UnsignedByte});
+
+        MAGNUM_VERIFY_NO_ERROR();
+
+        CORRADE_COMPARE(image.size(), Vector2i(4));
+        CORRADE_COMPARE_AS(Containers::arrayCast<UnsignedByte>(image.data()),
+            Containers::arrayView(SubDataComplete), TestSuite::Compare::Container);
+    }
+    #endif
+}
+
 #ifndef MAGNUM_TARGET_GLES
 void CubeMapTextureGLTest::subImageQuery() {
     setTestCaseDescription(PixelStorageData[testCaseInstanceId()].name);
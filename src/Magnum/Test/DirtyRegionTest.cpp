@@ -0,0 +1,237 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/DirtyRegion.h"
+
+namespace Magnum { namespace Test {
+
+struct DirtyRegionTest: TestSuite::Tester {
+    explicit DirtyRegionTest();
+
+    void rangesEmpty();
+    void rangesSequential();
+    void rangesUnsorted();
+    void rangesOverlapping();
+    void rangesMergeDistance();
+    void rangesClear();
+
+    void rectanglesEmpty();
+    void rectanglesAdjacent();
+    void rectanglesOverlapping();
+    void rectanglesDistant();
+    void rectanglesMergeArea();
+    void rectanglesMaxCount();
+    void rectanglesMaxCountInvalid();
+};
+
+typedef std::pair<std::size_t, std::size_t> Range;
+
+DirtyRegionTest::DirtyRegionTest() {
+    addTests({&DirtyRegionTest::rangesEmpty,
+              &DirtyRegionTest::rangesSequential,
+              &DirtyRegionTest::rangesUnsorted,
+              &DirtyRegionTest::rangesOverlapping,
+              &DirtyRegionTest::rangesMergeDistance,
+              &DirtyRegionTest::rangesClear,
+
+              &DirtyRegionTest::rectanglesEmpty,
+              &DirtyRegionTest::rectanglesAdjacent,
+              &DirtyRegionTest::rectanglesOverlapping,
+              &DirtyRegionTest::rectanglesDistant,
+              &DirtyRegionTest::rectanglesMergeArea,
+              &DirtyRegionTest::rectanglesMaxCount,
+              &DirtyRegionTest::rectanglesMaxCountInvalid});
+}
+
+void DirtyRegionTest::rangesEmpty() {
+    DirtyRanges ranges;
+    CORRADE_VERIFY(ranges.isEmpty());
+
+    /* Zero-sized ranges are ignored */
+    ranges.add(16, 0);
+    CORRADE_VERIFY(ranges.isEmpty());
+    CORRADE_COMPARE(ranges.ranges().size(), 0);
+    CORRADE_COMPARE(ranges.size(), 0);
+}
+
+void DirtyRegionTest::rangesSequential() {
+    DirtyRanges ranges;
+    ranges.add(0, 4)
+        .add(4, 4)
+        .add(6, 10)
+        .add(32, 8);
+
+    CORRADE_COMPARE_AS(ranges.ranges(), (std::vector<Range>{{0, 16}, {32, 8}}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(ranges.size(), 24);
+}
+
+void DirtyRegionTest::rangesUnsorted() {
+    DirtyRanges ranges;
+    ranges.add(100, 10)
+        .add(16, 8)
+        .add(24, 4)
+        .add(50, 1);
+
+    CORRADE_COMPARE_AS(ranges.ranges(), (std::vector<Range>{{16, 12}, {50, 1}, {100, 10}}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(ranges.size(), 23);
+}
+
+void DirtyRegionTest::rangesOverlapping() {
+    DirtyRanges ranges;
+    ranges.add(20, 10)
+        .add(10, 15)
+        .add(12, 2)
+        .add(28, 4);
+
+    CORRADE_COMPARE_AS(ranges.ranges(), (std::vector<Range>{{10, 22}}),
+        TestSuite::Compare::Container);
+}
+
+void DirtyRegionTest::rangesMergeDistance() {
+    DirtyRanges ranges{4};
+    CORRADE_COMPARE(ranges.mergeDistance(), 4);
+
+    ranges.add(0, 4)
+        .add(8, 4)
+        .add(17, 4);
+    CORRADE_COMPARE_AS(ranges.ranges(), (std::vector<Range>{{0, 12}, {17, 4}}),
+        TestSuite::Compare::Container);
+
+    /* Changing the distance applies to already coalesced ranges */
+    ranges.setMergeDistance(5);
+    CORRADE_COMPARE_AS(ranges.ranges(), (std::vector<Range>{{0, 21}}),
+        TestSuite::Compare::Container);
+}
+
+void DirtyRegionTest::rangesClear() {
+    DirtyRanges ranges;
+    ranges.add(10, 5);
+    CORRADE_VERIFY(!ranges.isEmpty());
+
+    ranges.clear();
+    CORRADE_VERIFY(ranges.isEmpty());
+    CORRADE_COMPARE(ranges.size(), 0);
+
+    ranges.add(0, 1);
+    CORRADE_COMPARE_AS(ranges.ranges(), (std::vector<Range>{{0, 1}}),
+        TestSuite::Compare::Container);
+}
+
+void DirtyRegionTest::rectanglesEmpty() {
+    DirtyRectangles rectangles;
+    rectangles.add({{5, 5}, {5, 10}})
+        .add({{5, 5}, {3, 10}});
+    CORRADE_VERIFY(rectangles.isEmpty());
+    CORRADE_COMPARE(rectangles.area(), 0);
+}
+
+void DirtyRegionTest::rectanglesAdjacent() {
+    DirtyRectangles rectangles;
+    rectangles.add({{0, 0}, {16, 8}})
+        .add({{0, 8}, {16, 16}})
+        .add({{16, 0}, {20, 16}});
+
+    CORRADE_COMPARE_AS(rectangles.rectangles(), (std::vector<Range2Di>{{{0, 0}, {20, 16}}}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(rectangles.area(), 320);
+}
+
+void DirtyRegionTest::rectanglesOverlapping() {
+    DirtyRectangles rectangles;
+    rectangles.add({{0, 0}, {10, 10}})
+        .add({{2, 2}, {8, 8}})
+        .add({{0, 1}, {10, 11}});
+
+    CORRADE_COMPARE_AS(rectangles.rectangles(), (std::vector<Range2Di>{{{0, 0}, {10, 11}}}),
+        TestSuite::Compare::Container);
+}
+
+void DirtyRegionTest::rectanglesDistant() {
+    DirtyRectangles rectangles;
+    rectangles.add({{0, 0}, {4, 4}})
+        .add({{100, 100}, {110, 110}});
+
+    CORRADE_COMPARE_AS(rectangles.rectangles(), (std::vector<Range2Di>{
+        {{0, 0}, {4, 4}},
+        {{100, 100}, {110, 110}}}), TestSuite::Compare::Container);
+    CORRADE_COMPARE(rectangles.area(), 116);
+}
+
+void DirtyRegionTest::rectanglesMergeArea() {
+    DirtyRectangles rectangles{16, 8};
+    CORRADE_COMPARE(rectangles.mergeArea(), 8);
+
+    /* Merging wastes 2x4 pixels, which is allowed */
+    rectangles.add({{0, 0}, {4, 4}})
+        .add({{6, 0}, {10, 4}});
+    CORRADE_COMPARE_AS(rectangles.rectangles(), (std::vector<Range2Di>{{{0, 0}, {10, 4}}}),
+        TestSuite::Compare::Container);
+
+    /* Merging this one wastes 60 pixels */
+    rectangles.add({{0, 10}, {10, 16}});
+    CORRADE_COMPARE(rectangles.rectangles().size(), 2);
+
+    rectangles.setMergeArea(60);
+    CORRADE_COMPARE_AS(rectangles.rectangles(), (std::vector<Range2Di>{{{0, 0}, {10, 16}}}),
+        TestSuite::Compare::Container);
+}
+
+void DirtyRegionTest::rectanglesMaxCount() {
+    DirtyRectangles rectangles{2};
+    CORRADE_COMPARE(rectangles.maxCount(), 2);
+
+    rectangles.add({{0, 0}, {2, 2}})
+        .add({{4, 0}, {6, 2}})
+        .add({{100, 100}, {102, 102}});
+
+    /* The two close rectangles get merged as that wastes the least area */
+    CORRADE_COMPARE_AS(rectangles.rectangles(), (std::vector<Range2Di>{
+        {{0, 0}, {6, 2}},
+        {{100, 100}, {102, 102}}}), TestSuite::Compare::Container);
+
+    rectangles.setMaxCount(1);
+    CORRADE_COMPARE_AS(rectangles.rectangles(), (std::vector<Range2Di>{{{0, 0}, {102, 102}}}),
+        TestSuite::Compare::Container);
+}
+
+void DirtyRegionTest::rectanglesMaxCountInvalid() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    DirtyRectangles rectangles;
+    rectangles.setMaxCount(0);
+    CORRADE_COMPARE(rectangles.maxCount(), 16);
+    CORRADE_COMPARE(out.str(), "DirtyRectangles::setMaxCount(): expected non-zero max count\n");
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::DirtyRegionTest)
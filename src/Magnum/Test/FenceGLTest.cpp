@@ -0,0 +1,165 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Fence.h"
+#include "Magnum/OpenGLTester.h"
+
+namespace Magnum { namespace Test {
+
+struct FenceGLTest: OpenGLTester {
+    explicit FenceGLTest();
+
+    void construct();
+    void constructCopy();
+    void constructMove();
+
+    void insertClientWait();
+    void insertWait();
+    void insertTwice();
+
+    void debugWaitResult();
+};
+
+FenceGLTest::FenceGLTest() {
+    addTests({&FenceGLTest::construct,
+              &FenceGLTest::constructCopy,
+              &FenceGLTest::constructMove,
+
+              &FenceGLTest::insertClientWait,
+              &FenceGLTest::insertWait,
+              &FenceGLTest::insertTwice,
+
+              &FenceGLTest::debugWaitResult});
+}
+
+void FenceGLTest::construct() {
+    {
+        Fence fence;
+
+        CORRADE_VERIFY(!fence.isInserted());
+        CORRADE_VERIFY(!fence.sync());
+        CORRADE_VERIFY(fence.isSignaled());
+        CORRADE_COMPARE(fence.clientWait(), Fence::WaitResult::AlreadySignaled);
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void FenceGLTest::constructCopy() {
+    CORRADE_VERIFY(!(std::is_constructible<Fence, const Fence&>{}));
+    CORRADE_VERIFY(!(std::is_assignable<Fence, const Fence&>{}));
+}
+
+void FenceGLTest::constructMove() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sync>())
+        CORRADE_SKIP(Extensions::GL::ARB::sync::string() + std::string(" is not available"));
+    #endif
+
+    Fence a;
+    a.insert();
+    const GLsync sync = a.sync();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(sync);
+
+    Fence b(std::move(a));
+
+    CORRADE_VERIFY(!a.sync());
+    CORRADE_COMPARE(b.sync(), sync);
+
+    Fence c;
+    c.insert();
+    const GLsync cSync = c.sync();
+    c = std::move(b);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(cSync);
+    CORRADE_COMPARE(b.sync(), cSync);
+    CORRADE_COMPARE(c.sync(), sync);
+}
+
+void FenceGLTest::insertClientWait() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sync>())
+        CORRADE_SKIP(Extensions::GL::ARB::sync::string() + std::string(" is not available"));
+    #endif
+
+    Fence fence;
+    fence.insert();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(fence.isInserted());
+
+    const Fence::WaitResult result = fence.clientWait();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(result == Fence::WaitResult::AlreadySignaled ||
+                   result == Fence::WaitResult::ConditionSatisfied);
+    CORRADE_VERIFY(fence.isSignaled());
+}
+
+void FenceGLTest::insertWait() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sync>())
+        CORRADE_SKIP(Extensions::GL::ARB::sync::string() + std::string(" is not available"));
+    #endif
+
+    Fence fence;
+    fence.insert().wait();
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void FenceGLTest::insertTwice() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sync>())
+        CORRADE_SKIP(Extensions::GL::ARB::sync::string() + std::string(" is not available"));
+    #endif
+
+    /* Inserting again should delete the previous sync object */
+    Fence fence;
+    fence.insert();
+    const GLsync first = fence.sync();
+    fence.insert();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(!glIsSync(first) || fence.sync() == first);
+    CORRADE_VERIFY(glIsSync(fence.sync()));
+}
+
+void FenceGLTest::debugWaitResult() {
+    std::ostringstream out;
+
+    Debug(&out) << Fence::WaitResult::TimeoutExpired << Fence::WaitResult(0xdead);
+    CORRADE_COMPARE(out.str(), "Fence::WaitResult::TimeoutExpired Fence::WaitResult(0xdead)\n");
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::FenceGLTest)
@@ -0,0 +1,220 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstdint>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/FrameArena.h"
+
+namespace Magnum { namespace Test {
+
+struct FrameArenaTest: TestSuite::Tester {
+    explicit FrameArenaTest();
+
+    void construct();
+    void constructMove();
+
+    void allocate();
+    void allocateAlignment();
+    void allocateInvalidAlignment();
+    void allocateOverflow();
+    void deallocate();
+    void reset();
+    void resetGrow();
+
+    void vector();
+    void vectorRebind();
+};
+
+FrameArenaTest::FrameArenaTest() {
+    addTests({&FrameArenaTest::construct,
+              &FrameArenaTest::constructMove,
+
+              &FrameArenaTest::allocate,
+              &FrameArenaTest::allocateAlignment,
+              &FrameArenaTest::allocateInvalidAlignment,
+              &FrameArenaTest::allocateOverflow,
+              &FrameArenaTest::deallocate,
+              &FrameArenaTest::reset,
+              &FrameArenaTest::resetGrow,
+
+              &FrameArenaTest::vector,
+              &FrameArenaTest::vectorRebind});
+}
+
+void FrameArenaTest::construct() {
+    FrameArena arena{256};
+    CORRADE_COMPARE(arena.capacity(), 256);
+    CORRADE_COMPARE(arena.usedSize(), 0);
+    CORRADE_COMPARE(arena.overflowCount(), 0);
+}
+
+void FrameArenaTest::constructMove() {
+    FrameArena a{256};
+    a.allocate(16);
+
+    FrameArena b{std::move(a)};
+    CORRADE_COMPARE(b.capacity(), 256);
+    CORRADE_COMPARE(b.usedSize(), 16);
+    CORRADE_COMPARE(a.capacity(), 0);
+    CORRADE_COMPARE(a.usedSize(), 0);
+
+    FrameArena c{64};
+    c = std::move(b);
+    CORRADE_COMPARE(c.capacity(), 256);
+    CORRADE_COMPARE(c.usedSize(), 16);
+}
+
+void FrameArenaTest::allocate() {
+    FrameArena arena{256};
+    char* a = static_cast<char*>(arena.allocate(3, 1));
+    char* b = static_cast<char*>(arena.allocate(5, 1));
+    CORRADE_VERIFY(a);
+    CORRADE_COMPARE(b, a + 3);
+    CORRADE_COMPARE(arena.usedSize(), 8);
+    CORRADE_COMPARE(arena.overflowCount(), 0);
+}
+
+void FrameArenaTest::allocateAlignment() {
+    FrameArena arena{256};
+    arena.allocate(1, 1);
+    void* a = arena.allocate(4, 16);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(a) % 16, 0);
+    void* b = arena.allocate(4);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(b) % alignof(std::max_align_t), 0);
+}
+
+void FrameArenaTest::allocateInvalidAlignment() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    FrameArena arena{256};
+    arena.allocate(4, 3);
+    CORRADE_COMPARE(out.str(), "FrameArena::allocate(): alignment 3 is not a power of two\n");
+}
+
+void FrameArenaTest::allocateOverflow() {
+    FrameArena arena{64};
+    arena.allocate(48, 1);
+
+    /* Doesn't fit, taken from heap */
+    void* a = arena.allocate(32, 16);
+    CORRADE_VERIFY(a);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(a) % 16, 0);
+    CORRADE_COMPARE(arena.overflowCount(), 1);
+    CORRADE_COMPARE(arena.capacity(), 64);
+
+    /* Still fits into the block */
+    arena.allocate(16, 1);
+    CORRADE_COMPARE(arena.overflowCount(), 1);
+    CORRADE_COMPARE(arena.usedSize(), 48 + 16 + 32 + 15);
+}
+
+void FrameArenaTest::deallocate() {
+    FrameArena arena{256};
+    void* a = arena.allocate(16, 1);
+    void* b = arena.allocate(16, 1);
+
+    /* Not the last one, nothing happens */
+    arena.deallocate(a, 16);
+    CORRADE_COMPARE(arena.usedSize(), 32);
+
+    /* Last one is rolled back and reused */
+    arena.deallocate(b, 16);
+    CORRADE_COMPARE(arena.usedSize(), 16);
+    CORRADE_COMPARE(arena.allocate(8, 1), b);
+}
+
+void FrameArenaTest::reset() {
+    FrameArena arena{256};
+    void* a = arena.allocate(16);
+    arena.allocate(100);
+    arena.reset();
+
+    CORRADE_COMPARE(arena.usedSize(), 0);
+    CORRADE_COMPARE(arena.capacity(), 256);
+    CORRADE_COMPARE(arena.allocate(16), a);
+}
+
+void FrameArenaTest::resetGrow() {
+    FrameArena arena{64};
+    arena.allocate(48, 1);
+    arena.allocate(100, 1);
+    arena.allocate(200, 1);
+    CORRADE_COMPARE(arena.overflowCount(), 2);
+
+    /* The block is enlarged to fit everything */
+    arena.reset();
+    CORRADE_COMPARE(arena.capacity(), 48 + 100 + 200);
+    CORRADE_COMPARE(arena.overflowCount(), 0);
+
+    arena.allocate(48, 1);
+    arena.allocate(100, 1);
+    arena.allocate(200, 1);
+    CORRADE_COMPARE(arena.overflowCount(), 0);
+
+    /* Reset without overflow doesn't change anything */
+    arena.reset();
+    CORRADE_COMPARE(arena.capacity(), 48 + 100 + 200);
+}
+
+void FrameArenaTest::vector() {
+    FrameArena arena{1024};
+    FrameArenaVector<Int> a{arena};
+    a.reserve(10);
+    for(Int i = 0; i != 10; ++i) a.push_back(i*i);
+
+    CORRADE_COMPARE(a[9], 81);
+    CORRADE_COMPARE(arena.usedSize(), 10*sizeof(Int));
+    CORRADE_COMPARE(arena.overflowCount(), 0);
+    CORRADE_COMPARE(&a.get_allocator().arena(), &arena);
+
+    /* Growing works too, the previous memory is wasted until reset */
+    a.push_back(100);
+    CORRADE_COMPARE(a[10], 100);
+    CORRADE_COMPARE(a[9], 81);
+    CORRADE_COMPARE(arena.overflowCount(), 0);
+}
+
+void FrameArenaTest::vectorRebind() {
+    FrameArena arena{1024};
+    FrameArena other{1024};
+
+    FrameArenaAllocator<Int> a{arena};
+    FrameArenaAllocator<Double> b{a};
+    FrameArenaAllocator<Int> c{other};
+    CORRADE_VERIFY(a == b);
+    CORRADE_VERIFY(a != c);
+
+    FrameArenaVector<Double> vector{b};
+    vector.push_back(1.5);
+    CORRADE_COMPARE(vector[0], 1.5);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(vector.data()) % alignof(Double), 0);
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::FrameArenaTest)
@@ -0,0 +1,157 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <thread>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/FramePacer.h"
+
+namespace Magnum { namespace Test {
+
+struct FramePacerTest: Corrade::TestSuite::Tester {
+    explicit FramePacerTest();
+
+    void construct();
+    void statistics();
+    void resetStatistics();
+    void pacing();
+    void pacingDisabled();
+    void justInTimeInput();
+};
+
+FramePacerTest::FramePacerTest() {
+    addTests({&FramePacerTest::construct,
+              &FramePacerTest::statistics,
+              &FramePacerTest::resetStatistics,
+              &FramePacerTest::pacing,
+              &FramePacerTest::pacingDisabled,
+              &FramePacerTest::justInTimeInput});
+}
+
+namespace {
+    typedef std::chrono::steady_clock Clock;
+
+    Float since(const Clock::time_point time) {
+        return std::chrono::duration<Float>(Clock::now() - time).count();
+    }
+}
+
+void FramePacerTest::construct() {
+    FramePacer pacer;
+    CORRADE_COMPARE(pacer.targetFramePeriod(), 0.0f);
+    CORRADE_VERIFY(!pacer.isJustInTimeInput());
+    CORRADE_COMPARE(pacer.statistics().frameCount, 0);
+    CORRADE_COMPARE(pacer.statistics().averageFrameTime, 0.0f);
+}
+
+void FramePacerTest::statistics() {
+    FramePacer pacer;
+    for(std::size_t i = 0; i != 3; ++i) {
+        pacer.beginFrame();
+        std::this_thread::sleep_for(std::chrono::milliseconds{2});
+        pacer.endFrame();
+    }
+
+    const FramePacer::Statistics& statistics = pacer.statistics();
+    CORRADE_COMPARE(statistics.frameCount, 3);
+    CORRADE_COMPARE(statistics.missedFrameCount, 0);
+    CORRADE_VERIFY(statistics.workTime >= 0.002f);
+    CORRADE_VERIFY(statistics.frameTime >= 0.002f);
+    CORRADE_VERIFY(statistics.averageFrameTime >= 0.002f);
+    CORRADE_VERIFY(statistics.maxFrameTime >= statistics.frameTime);
+}
+
+void FramePacerTest::resetStatistics() {
+    FramePacer pacer;
+    pacer.setTargetFramePeriod(0.001f);
+    for(std::size_t i = 0; i != 2; ++i) {
+        pacer.beginFrame();
+        std::this_thread::sleep_for(std::chrono::milliseconds{3});
+        pacer.endFrame();
+    }
+
+    CORRADE_COMPARE(pacer.statistics().frameCount, 2);
+    CORRADE_COMPARE(pacer.statistics().missedFrameCount, 1);
+
+    const Float averageFrameTime = pacer.statistics().averageFrameTime;
+    pacer.resetStatistics();
+    CORRADE_COMPARE(pacer.statistics().frameCount, 0);
+    CORRADE_COMPARE(pacer.statistics().missedFrameCount, 0);
+    CORRADE_COMPARE(pacer.statistics().maxFrameTime, 0.0f);
+    CORRADE_COMPARE(pacer.statistics().averageFrameTime, averageFrameTime);
+}
+
+void FramePacerTest::pacing() {
+    FramePacer pacer;
+    pacer.setTargetFramePeriod(0.005f);
+
+    /* The first frame starts immediately, the others are 5 ms apart */
+    const Clock::time_point start = Clock::now();
+    for(std::size_t i = 0; i != 10; ++i) {
+        pacer.beginFrame();
+        pacer.endFrame();
+    }
+
+    CORRADE_VERIFY(since(start) >= 0.045f);
+    CORRADE_VERIFY(pacer.statistics().averageFrameTime >= 0.0045f);
+}
+
+void FramePacerTest::pacingDisabled() {
+    FramePacer pacer;
+
+    const Clock::time_point start = Clock::now();
+    for(std::size_t i = 0; i != 10; ++i) {
+        pacer.beginFrame();
+        pacer.endFrame();
+    }
+
+    CORRADE_VERIFY(since(start) < 0.045f);
+    CORRADE_COMPARE(pacer.statistics().frameCount, 10);
+}
+
+void FramePacerTest::justInTimeInput() {
+    FramePacer pacer;
+    pacer.setTargetFramePeriod(0.01f)
+        .setJustInTimeInput(true);
+    CORRADE_VERIFY(pacer.isJustInTimeInput());
+
+    /* With 2 ms of work in a 10 ms frame, most of the frame should be spent
+       waiting before the work starts, not after. The bounds are loose to
+       account for scheduler noise. */
+    for(std::size_t i = 0; i != 5; ++i) {
+        pacer.beginFrame();
+        std::this_thread::sleep_for(std::chrono::milliseconds{2});
+        pacer.endFrame();
+    }
+
+    CORRADE_COMPARE(pacer.statistics().frameCount, 5);
+    CORRADE_VERIFY(pacer.statistics().waitTime > 0.0f);
+    CORRADE_VERIFY(pacer.statistics().averageFrameTime > 0.005f);
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::FramePacerTest)
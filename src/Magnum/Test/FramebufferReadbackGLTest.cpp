@@ -0,0 +1,220 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Framebuffer.h"
+#include "Magnum/FramebufferReadback.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Renderbuffer.h"
+#include "Magnum/RenderbufferFormat.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/Math/Color.h"
+
+namespace Magnum { namespace Test {
+
+struct FramebufferReadbackGLTest: OpenGLTester {
+    explicit FramebufferReadbackGLTest();
+
+    void construct();
+    void constructCopy();
+
+    void read();
+    void readRingFull();
+    void readNoCallback();
+    void threaded();
+};
+
+FramebufferReadbackGLTest::FramebufferReadbackGLTest() {
+    addTests({&FramebufferReadbackGLTest::construct,
+              &FramebufferReadbackGLTest::constructCopy,
+
+              &FramebufferReadbackGLTest::read,
+              &FramebufferReadbackGLTest::readRingFull,
+              &FramebufferReadbackGLTest::readNoCallback,
+              &FramebufferReadbackGLTest::threaded});
+}
+
+namespace {
+    struct Target {
+        explicit Target() {
+            color.setStorage(RenderbufferFormat::RGBA8, Vector2i{4});
+            framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment{0}, color);
+        }
+
+        /* Clears to a color derived from the frame index */
+        void clear(UnsignedInt frame) {
+            Renderer::setClearColor(Color4{frame/255.0f, 0.2f, 0.4f, 1.0f});
+            framebuffer.clear(FramebufferClear::Color);
+        }
+
+        Renderbuffer color;
+        Framebuffer framebuffer{{{}, Vector2i{4}}};
+    };
+}
+
+void FramebufferReadbackGLTest::construct() {
+    {
+        FramebufferReadback readback{4};
+
+        MAGNUM_VERIFY_NO_ERROR();
+        CORRADE_COMPARE(readback.depth(), 4);
+        CORRADE_COMPARE(readback.pendingCount(), 0);
+        CORRADE_VERIFY(!readback.isThreaded());
+        CORRADE_COMPARE(readback.poll(), 0);
+        CORRADE_COMPARE(readback.finish(), 0);
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void FramebufferReadbackGLTest::constructCopy() {
+    CORRADE_VERIFY(!(std::is_constructible<FramebufferReadback, const FramebufferReadback&>{}));
+    CORRADE_VERIFY(!(std::is_assignable<FramebufferReadback, const FramebufferReadback&>{}));
+}
+
+void FramebufferReadbackGLTest::read() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sync>())
+        CORRADE_SKIP(Extensions::GL::ARB::sync::string() + std::string(" is not available"));
+    #endif
+
+    Target target;
+    std::vector<std::uint64_t> frames;
+    std::vector<UnsignedByte> red;
+
+    FramebufferReadback readback{3};
+    readback.setCallback([&](const ImageView2D& image, std::uint64_t frame) {
+        frames.push_back(frame);
+        red.push_back(image.data()[0]);
+        CORRADE_COMPARE(image.size(), Vector2i{2});
+    });
+
+    target.clear(10);
+    CORRADE_COMPARE(readback.read(target.framebuffer, {{1, 1}, {3, 3}}, PixelFormat::RGBA, PixelType::UnsignedByte), 0);
+    target.clear(20);
+    CORRADE_COMPARE(readback.read(target.framebuffer, {{1, 1}, {3, 3}}, PixelFormat::RGBA, PixelType::UnsignedByte), 1);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(readback.pendingCount(), 2);
+
+    /* Polling doesn't block, so it's not known how many got delivered */
+    const std::size_t polled = readback.poll();
+    CORRADE_COMPARE(readback.pendingCount(), 2 - polled);
+    CORRADE_COMPARE(readback.finish() + polled, 2);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(readback.pendingCount(), 0);
+    CORRADE_COMPARE(frames, (std::vector<std::uint64_t>{0, 1}));
+    CORRADE_COMPARE(red, (std::vector<UnsignedByte>{10, 20}));
+}
+
+void FramebufferReadbackGLTest::readRingFull() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sync>())
+        CORRADE_SKIP(Extensions::GL::ARB::sync::string() + std::string(" is not available"));
+    #endif
+
+    Target target;
+    std::vector<UnsignedByte> red;
+
+    FramebufferReadback readback{2};
+    readback.setCallback([&](const ImageView2D& image, std::uint64_t) {
+        red.push_back(image.data()[0]);
+    });
+
+    /* The third read has to wait for the first one */
+    for(UnsignedInt i = 0; i != 3; ++i) {
+        target.clear(i + 1);
+        readback.read(target.framebuffer, target.framebuffer.viewport(), PixelFormat::RGBA, PixelType::UnsignedByte);
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(readback.pendingCount(), 2);
+    CORRADE_COMPARE(red, (std::vector<UnsignedByte>{1}));
+
+    readback.finish();
+    CORRADE_COMPARE(red, (std::vector<UnsignedByte>{1, 2, 3}));
+}
+
+void FramebufferReadbackGLTest::readNoCallback() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sync>())
+        CORRADE_SKIP(Extensions::GL::ARB::sync::string() + std::string(" is not available"));
+    #endif
+
+    Target target;
+    FramebufferReadback readback{2};
+    readback.read(target.framebuffer, target.framebuffer.viewport(), PixelFormat::RGBA, PixelType::UnsignedByte);
+    readback.read(target.framebuffer, target.framebuffer.viewport(), PixelFormat::RGBA, PixelType::UnsignedByte);
+    readback.read(target.framebuffer, target.framebuffer.viewport(), PixelFormat::RGBA, PixelType::UnsignedByte);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(readback.finish(), 2);
+    CORRADE_COMPARE(readback.pendingCount(), 0);
+}
+
+void FramebufferReadbackGLTest::threaded() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sync>())
+        CORRADE_SKIP(Extensions::GL::ARB::sync::string() + std::string(" is not available"));
+    #endif
+
+    Target target;
+    std::mutex mutex;
+    UnsignedByte red[4]{};
+
+    FramebufferReadback readback{2};
+    readback.setThreaded(true)
+        .setCallback([&](const ImageView2D& image, std::uint64_t frame) {
+            std::lock_guard<std::mutex> lock{mutex};
+            red[frame] = image.data()[0];
+        });
+    CORRADE_VERIFY(readback.isThreaded());
+
+    for(UnsignedInt i = 0; i != 4; ++i) {
+        target.clear(i + 5);
+        readback.read(target.framebuffer, target.framebuffer.viewport(), PixelFormat::RGBA, PixelType::UnsignedByte);
+        readback.poll();
+    }
+
+    readback.finish();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(readback.pendingCount(), 0);
+    CORRADE_COMPARE(red[0], 5);
+    CORRADE_COMPARE(red[1], 6);
+    CORRADE_COMPARE(red[2], 7);
+    CORRADE_COMPARE(red[3], 8);
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::FramebufferReadbackGLTest)
@@ -0,0 +1,454 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/Buffer.h"
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Framebuffer.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/MeshView.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Renderbuffer.h"
+#include "Magnum/RenderbufferFormat.h"
+#include "Magnum/Renderer.h"
+#include "Magnum/Shader.h"
+#include "Magnum/Texture.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/Version.h"
+#include "Magnum/Math/Vector2.h"
+
+namespace Magnum { namespace Test {
+
+/* Standing GPU and driver path benchmarks. Draw call and upload benchmarks
+   measure wall time spent submitting the work (the uploads wait for the GPU
+   to finish), blits are measured with GPU time. Shader fill rate is in
+   Shaders/Test/ShadersGLBenchmark.cpp. */
+
+struct GLBenchmark: OpenGLTester {
+    explicit GLBenchmark();
+
+    void draw();
+    void drawIndexed();
+    void drawInstanced();
+    #ifndef MAGNUM_TARGET_WEBGL
+    void drawMulti();
+    #endif
+
+    void bufferSetData();
+    void bufferSetSubData();
+    #ifndef MAGNUM_TARGET_WEBGL
+    void bufferMapRange();
+    #endif
+    #ifndef MAGNUM_TARGET_GLES
+    void bufferMapPersistent();
+    #endif
+
+    void textureSubImage();
+
+    void framebufferBlit();
+};
+
+namespace {
+    enum: std::size_t {
+        DrawCount = 1000,
+        MultiDrawViewCount = 16,
+        UploadCount = 100,
+        UploadSize = 64*1024,
+        BlitCount = 10
+    };
+
+    enum: std::size_t { TextureDataCount =
+        #ifndef MAGNUM_TARGET_GLES2
+        5
+        #else
+        2
+        #endif
+    };
+
+    struct {
+        const char* name;
+        TextureFormat textureFormat;
+        PixelFormat format;
+        PixelType type;
+        std::size_t pixelSize;
+    } TextureData[TextureDataCount]{
+        #ifndef MAGNUM_TARGET_GLES2
+        {"RGBA8", TextureFormat::RGBA8, PixelFormat::RGBA, PixelType::UnsignedByte, 4},
+        {"RGB8", TextureFormat::RGB8, PixelFormat::RGB, PixelType::UnsignedByte, 3},
+        {"R8", TextureFormat::R8, PixelFormat::Red, PixelType::UnsignedByte, 1},
+        {"RGBA16F", TextureFormat::RGBA16F, PixelFormat::RGBA, PixelType::HalfFloat, 8},
+        {"RGBA32F", TextureFormat::RGBA32F, PixelFormat::RGBA, PixelType::Float, 16}
+        #else
+        {"RGBA", TextureFormat::RGBA, PixelFormat::RGBA, PixelType::UnsignedByte, 4},
+        {"RGB", TextureFormat::RGB, PixelFormat::RGB, PixelType::UnsignedByte, 3}
+        #endif
+    };
+
+    struct DrawShader: AbstractShaderProgram {
+        typedef Attribute<0, Vector2> Position;
+
+        explicit DrawShader();
+    };
+
+    DrawShader::DrawShader() {
+        #ifndef MAGNUM_TARGET_GLES
+        Shader vert(
+            #ifndef CORRADE_TARGET_APPLE
+            Version::GL210
+            #else
+            Version::GL310
+            #endif
+            , Shader::Type::Vertex);
+        Shader frag(
+            #ifndef CORRADE_TARGET_APPLE
+            Version::GL210
+            #else
+            Version::GL310
+            #endif
+            , Shader::Type::Fragment);
+        #elif defined(MAGNUM_TARGET_GLES2)
+        Shader vert(Version::GLES200, Shader::Type::Vertex);
+        Shader frag(Version::GLES200, Shader::Type::Fragment);
+        #else
+        Shader vert(Version::GLES300, Shader::Type::Vertex);
+        Shader frag(Version::GLES300, Shader::Type::Fragment);
+        #endif
+
+        vert.addSource(
+            "#if defined(GL_ES) || __VERSION__ == 120\n"
+            "#define in attribute\n"
+            "#endif\n"
+            "in mediump vec2 position;\n"
+            "void main() {\n"
+            "    gl_Position = vec4(position, 0.0, 1.0);\n"
+            "}\n");
+        frag.addSource(
+            "#if !defined(GL_ES) && __VERSION__ == 120\n"
+            "#define mediump\n"
+            "#endif\n"
+            "#if defined(GL_ES) || __VERSION__ == 120\n"
+            "#define result gl_FragColor\n"
+            "#endif\n"
+            "#if !defined(GL_ES) && __VERSION__ >= 130\n"
+            "out mediump vec4 result;\n"
+            "#endif\n"
+            "void main() { result = vec4(1.0); }\n");
+
+        CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, frag}));
+
+        attachShaders({vert, frag});
+
+        bindAttributeLocation(Position::Location, "position");
+
+        CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+    }
+
+    struct RenderTarget {
+        explicit RenderTarget(const Vector2i& size);
+
+        Renderbuffer color;
+        Framebuffer framebuffer;
+    };
+
+    RenderTarget::RenderTarget(const Vector2i& size): framebuffer{{{}, size}} {
+        #ifndef MAGNUM_TARGET_GLES2
+        color.setStorage(RenderbufferFormat::RGBA8, size);
+        #else
+        color.setStorage(RenderbufferFormat::RGBA4, size);
+        #endif
+        framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment(0), color);
+    }
+
+    /* A small triangle, so the benchmarks measure the per-call overhead and
+       not the rasterization */
+    constexpr Vector2 Triangle[]{
+        {-0.1f, -0.1f},
+        { 0.1f, -0.1f},
+        { 0.0f,  0.1f}
+    };
+
+    constexpr UnsignedShort TriangleIndices[]{0, 1, 2};
+
+    bool isTimeQuerySupported() {
+        #ifndef MAGNUM_TARGET_GLES
+        return Context::current().isExtensionSupported<Extensions::GL::ARB::timer_query>();
+        #else
+        return Context::current().isExtensionSupported<Extensions::GL::EXT::disjoint_timer_query>();
+        #endif
+    }
+}
+
+GLBenchmark::GLBenchmark() {
+    addBenchmarks({&GLBenchmark::draw,
+                   &GLBenchmark::drawIndexed,
+                   &GLBenchmark::drawInstanced,
+                   #ifndef MAGNUM_TARGET_WEBGL
+                   &GLBenchmark::drawMulti,
+                   #endif
+
+                   &GLBenchmark::bufferSetData,
+                   &GLBenchmark::bufferSetSubData,
+                   #ifndef MAGNUM_TARGET_WEBGL
+                   &GLBenchmark::bufferMapRange,
+                   #endif
+                   #ifndef MAGNUM_TARGET_GLES
+                   &GLBenchmark::bufferMapPersistent
+                   #endif
+                   }, 10);
+
+    addInstancedBenchmarks({&GLBenchmark::textureSubImage}, 10, TextureDataCount);
+
+    addBenchmarks({&GLBenchmark::framebufferBlit}, 10, BenchmarkType::GpuTime);
+}
+
+void GLBenchmark::draw() {
+    RenderTarget target{Vector2i{4}};
+    target.framebuffer.bind();
+
+    Buffer vertices;
+    vertices.setData(Triangle, BufferUsage::StaticDraw);
+
+    Mesh mesh;
+    mesh.setCount(3)
+        .addVertexBuffer(vertices, 0, DrawShader::Position{});
+
+    DrawShader shader;
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_BENCHMARK(DrawCount)
+        mesh.draw(shader);
+
+    Renderer::finish();
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void GLBenchmark::drawIndexed() {
+    RenderTarget target{Vector2i{4}};
+    target.framebuffer.bind();
+
+    Buffer vertices, indices;
+    vertices.setData(Triangle, BufferUsage::StaticDraw);
+    indices.setData(TriangleIndices, BufferUsage::StaticDraw);
+
+    Mesh mesh;
+    mesh.setCount(3)
+        .addVertexBuffer(vertices, 0, DrawShader::Position{})
+        .setIndexBuffer(indices, 0, Mesh::IndexType::UnsignedShort);
+
+    DrawShader shader;
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_BENCHMARK(DrawCount)
+        mesh.draw(shader);
+
+    Renderer::finish();
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void GLBenchmark::drawInstanced() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::draw_instanced>())
+        CORRADE_SKIP(Extensions::GL::ARB::draw_instanced::string() + std::string(" is not available."));
+    #elif defined(MAGNUM_TARGET_GLES2)
+    if(!Context::current().isExtensionSupported<Extensions::GL::ANGLE::instanced_arrays>() &&
+       !Context::current().isExtensionSupported<Extensions::GL::EXT::draw_instanced>() &&
+       !Context::current().isExtensionSupported<Extensions::GL::NV::draw_instanced>())
+        CORRADE_SKIP("Required extension is not available.");
+    #endif
+
+    RenderTarget target{Vector2i{4}};
+    target.framebuffer.bind();
+
+    Buffer vertices;
+    vertices.setData(Triangle, BufferUsage::StaticDraw);
+
+    Mesh mesh;
+    mesh.setCount(3)
+        .setInstanceCount(16)
+        .addVertexBuffer(vertices, 0, DrawShader::Position{});
+
+    DrawShader shader;
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_BENCHMARK(DrawCount)
+        mesh.draw(shader);
+
+    Renderer::finish();
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+#ifndef MAGNUM_TARGET_WEBGL
+void GLBenchmark::drawMulti() {
+    RenderTarget target{Vector2i{4}};
+    target.framebuffer.bind();
+
+    Buffer vertices;
+    vertices.setData(Triangle, BufferUsage::StaticDraw);
+
+    Mesh mesh;
+    mesh.setCount(3)
+        .addVertexBuffer(vertices, 0, DrawShader::Position{});
+
+    std::vector<MeshView> views(MultiDrawViewCount, MeshView{mesh});
+    std::vector<std::reference_wrapper<MeshView>> viewReferences;
+    for(MeshView& view: views) {
+        view.setCount(3);
+        viewReferences.push_back(view);
+    }
+
+    DrawShader shader;
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Divided so the result is comparable to a single draw() call */
+    CORRADE_BENCHMARK(DrawCount/MultiDrawViewCount)
+        MeshView::draw(shader, {viewReferences.data(), viewReferences.size()});
+
+    Renderer::finish();
+    MAGNUM_VERIFY_NO_ERROR();
+}
+#endif
+
+void GLBenchmark::bufferSetData() {
+    Containers::Array<char> data{Containers::ValueInit, UploadSize};
+    Buffer buffer;
+
+    CORRADE_BENCHMARK(UploadCount)
+        buffer.setData(data, BufferUsage::StreamDraw);
+
+    Renderer::finish();
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void GLBenchmark::bufferSetSubData() {
+    Containers::Array<char> data{Containers::ValueInit, UploadSize};
+    Buffer buffer;
+    buffer.setData(data, BufferUsage::StreamDraw);
+
+    CORRADE_BENCHMARK(UploadCount)
+        buffer.setSubData(0, data);
+
+    Renderer::finish();
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+#ifndef MAGNUM_TARGET_WEBGL
+void GLBenchmark::bufferMapRange() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::map_buffer_range>())
+        CORRADE_SKIP(Extensions::GL::ARB::map_buffer_range::string() + std::string(" is not supported"));
+    #elif defined(MAGNUM_TARGET_GLES2)
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::map_buffer_range>())
+        CORRADE_SKIP(Extensions::GL::EXT::map_buffer_range::string() + std::string(" is not supported"));
+    #endif
+
+    Containers::Array<char> data{Containers::ValueInit, UploadSize};
+    Buffer buffer;
+    buffer.setData(data, BufferUsage::StreamDraw);
+
+    CORRADE_BENCHMARK(UploadCount) {
+        char* mapped = buffer.map<char>(0, UploadSize, Buffer::MapFlag::Write|Buffer::MapFlag::InvalidateBuffer);
+        CORRADE_INTERNAL_ASSERT(mapped);
+        std::copy(data.begin(), data.end(), mapped);
+        CORRADE_INTERNAL_ASSERT_OUTPUT(buffer.unmap());
+    }
+
+    Renderer::finish();
+    MAGNUM_VERIFY_NO_ERROR();
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES
+void GLBenchmark::bufferMapPersistent() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::buffer_storage>())
+        CORRADE_SKIP(Extensions::GL::ARB::buffer_storage::string() + std::string(" is not supported"));
+
+    Containers::Array<char> data{Containers::ValueInit, UploadSize};
+    Buffer buffer;
+    buffer.setStorage(data, Buffer::StorageFlag::MapWrite|Buffer::StorageFlag::MapPersistent|Buffer::StorageFlag::MapCoherent);
+
+    /* Mapped just once, the benchmark then measures only the copy */
+    char* mapped = buffer.map<char>(0, UploadSize, Buffer::MapFlag::Write|Buffer::MapFlag::Persistent|Buffer::MapFlag::Coherent);
+    CORRADE_VERIFY(mapped);
+
+    CORRADE_BENCHMARK(UploadCount)
+        std::copy(data.begin(), data.end(), mapped);
+
+    CORRADE_VERIFY(buffer.unmap());
+    Renderer::finish();
+    MAGNUM_VERIFY_NO_ERROR();
+}
+#endif
+
+void GLBenchmark::textureSubImage() {
+    auto&& data = TextureData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const Vector2i size{256};
+    Containers::Array<char> pixels{Containers::ValueInit, std::size_t(size.product())*data.pixelSize};
+
+    Texture2D texture;
+    texture.setStorage(1, data.textureFormat, size);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Waiting for the GPU inside, so the transfer is included */
+    CORRADE_BENCHMARK(UploadCount/10) {
+        texture.setSubImage(0, {}, ImageView2D{PixelStorage{}.setAlignment(1), data.format, data.type, size, pixels});
+        Renderer::finish();
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void GLBenchmark::framebufferBlit() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::framebuffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::framebuffer_object::string() + std::string(" is not available."));
+    #elif defined(MAGNUM_TARGET_GLES2)
+    if(!Context::current().isExtensionSupported<Extensions::GL::NV::framebuffer_blit>() &&
+       !Context::current().isExtensionSupported<Extensions::GL::ANGLE::framebuffer_blit>())
+        CORRADE_SKIP("Required extension is not available.");
+    #endif
+    if(!isTimeQuerySupported())
+        CORRADE_SKIP("Time queries are not supported.");
+
+    RenderTarget a{Vector2i{1024}}, b{Vector2i{1024}};
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_BENCHMARK(BlitCount)
+        Framebuffer::blit(a.framebuffer, b.framebuffer, a.framebuffer.viewport(), FramebufferBlit::Color);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::GLBenchmark)
@@ -0,0 +1,163 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <vector>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Instrumentation.h"
+
+namespace Magnum { namespace Test {
+
+struct InstrumentationTest: TestSuite::Tester {
+    explicit InstrumentationTest();
+
+    void counters();
+    void listener();
+    void listenerChangedInsideZone();
+    void macros();
+
+    void debugZone();
+    void debugCounter();
+};
+
+InstrumentationTest::InstrumentationTest() {
+    addTests({&InstrumentationTest::counters,
+              &InstrumentationTest::listener,
+              &InstrumentationTest::listenerChangedInsideZone,
+              &InstrumentationTest::macros,
+
+              &InstrumentationTest::debugZone,
+              &InstrumentationTest::debugCounter});
+}
+
+namespace {
+    struct Listener: Instrumentation::AbstractListener {
+        void zoneBegin(Instrumentation::Zone zone) override {
+            events.emplace_back(true, zone);
+        }
+
+        void zoneEnd(Instrumentation::Zone zone) override {
+            events.emplace_back(false, zone);
+        }
+
+        std::vector<std::pair<bool, Instrumentation::Zone>> events;
+    };
+}
+
+void InstrumentationTest::counters() {
+    Instrumentation::resetCounters();
+    CORRADE_COMPARE(Instrumentation::counter(Instrumentation::Counter::DrawCalls), 0);
+
+    Instrumentation::count(Instrumentation::Counter::DrawCalls, 1);
+    Instrumentation::count(Instrumentation::Counter::DrawCalls, 2);
+    Instrumentation::count(Instrumentation::Counter::BufferUploadBytes, 1024);
+    CORRADE_COMPARE(Instrumentation::counter(Instrumentation::Counter::DrawCalls), 3);
+    CORRADE_COMPARE(Instrumentation::counter(Instrumentation::Counter::BufferUploadBytes), 1024);
+    CORRADE_COMPARE(Instrumentation::counter(Instrumentation::Counter::TextureBinds), 0);
+
+    Instrumentation::resetCounters();
+    CORRADE_COMPARE(Instrumentation::counter(Instrumentation::Counter::DrawCalls), 0);
+    CORRADE_COMPARE(Instrumentation::counter(Instrumentation::Counter::BufferUploadBytes), 0);
+}
+
+void InstrumentationTest::listener() {
+    CORRADE_VERIFY(!Instrumentation::listener());
+
+    /* No listener, nothing happens */
+    {
+        Instrumentation::ScopedZone zone{Instrumentation::Zone::MeshDraw};
+    }
+
+    Listener listener;
+    Instrumentation::setListener(&listener);
+    CORRADE_VERIFY(Instrumentation::listener() == &listener);
+
+    {
+        Instrumentation::ScopedZone a{Instrumentation::Zone::CameraDraw};
+        Instrumentation::ScopedZone b{Instrumentation::Zone::MeshDraw};
+    }
+
+    Instrumentation::setListener(nullptr);
+
+    CORRADE_COMPARE(listener.events.size(), 4);
+    CORRADE_VERIFY(listener.events[0] == std::make_pair(true, Instrumentation::Zone::CameraDraw));
+    CORRADE_VERIFY(listener.events[1] == std::make_pair(true, Instrumentation::Zone::MeshDraw));
+    CORRADE_VERIFY(listener.events[2] == std::make_pair(false, Instrumentation::Zone::MeshDraw));
+    CORRADE_VERIFY(listener.events[3] == std::make_pair(false, Instrumentation::Zone::CameraDraw));
+}
+
+void InstrumentationTest::listenerChangedInsideZone() {
+    Listener a, b;
+    Instrumentation::setListener(&a);
+
+    {
+        Instrumentation::ScopedZone zone{Instrumentation::Zone::TextureBind};
+        Instrumentation::setListener(&b);
+    }
+
+    Instrumentation::setListener(nullptr);
+
+    /* The zone end goes to the listener that saw the zone begin */
+    CORRADE_COMPARE(a.events.size(), 2);
+    CORRADE_VERIFY(b.events.empty());
+}
+
+void InstrumentationTest::macros() {
+    Instrumentation::resetCounters();
+    Listener listener;
+    Instrumentation::setListener(&listener);
+
+    {
+        MAGNUM_INSTRUMENT_ZONE(Instrumentation::Zone::TextRendererRender);
+        MAGNUM_INSTRUMENT_COUNT(Instrumentation::Counter::ShaderSwitches, 1);
+    }
+
+    Instrumentation::setListener(nullptr);
+
+    #ifdef MAGNUM_BUILD_INSTRUMENTATION
+    CORRADE_COMPARE(listener.events.size(), 2);
+    CORRADE_COMPARE(Instrumentation::counter(Instrumentation::Counter::ShaderSwitches), 1);
+    #else
+    CORRADE_VERIFY(listener.events.empty());
+    CORRADE_COMPARE(Instrumentation::counter(Instrumentation::Counter::ShaderSwitches), 0);
+    #endif
+}
+
+void InstrumentationTest::debugZone() {
+    std::ostringstream out;
+    Debug(&out) << Instrumentation::Zone::CameraDraw << Instrumentation::Zone(0xde);
+    CORRADE_COMPARE(out.str(), "Instrumentation::Zone::CameraDraw Instrumentation::Zone(0xde)\n");
+}
+
+void InstrumentationTest::debugCounter() {
+    std::ostringstream out;
+    Debug(&out) << Instrumentation::Counter::TextureBinds << Instrumentation::Counter(0xde);
+    CORRADE_COMPARE(out.str(), "Instrumentation::Counter::TextureBinds Instrumentation::Counter(0xde)\n");
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::InstrumentationTest)
@@ -36,6 +36,9 @@
 #include "Magnum/Renderbuffer.h"
 #include "Magnum/RenderbufferFormat.h"
 #include "Magnum/Shader.h"
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/VertexFormat.h"
+#endif
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Matrix.h"
 #include "Magnum/Math/Vector4.h"
@@ -113,6 +116,12 @@ struct MeshGLTest: OpenGLTester {
 
     void unbindVAOWhenSettingIndexBufferData();
 
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    void setVertexFormat();
+    void setVertexFormatShared();
+    void setVertexFormatSharedIndexed();
+    #endif
+
     #ifndef MAGNUM_TARGET_GLES
     void setBaseVertex();
     #endif
@@ -137,6 +146,10 @@ struct MeshGLTest: OpenGLTester {
     void multiDrawIndexed();
     #ifndef MAGNUM_TARGET_GLES
     void multiDrawBaseVertex();
+    void multiDrawInstanced();
+
+    void drawIndirect();
+    void drawIndirectIndexed();
     #endif
 };
 
@@ -206,6 +219,12 @@ MeshGLTest::MeshGLTest() {
 
               &MeshGLTest::unbindVAOWhenSettingIndexBufferData,
 
+              #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+              &MeshGLTest::setVertexFormat,
+              &MeshGLTest::setVertexFormatShared,
+              &MeshGLTest::setVertexFormatSharedIndexed,
+              #endif
+
               #ifndef MAGNUM_TARGET_GLES
               &MeshGLTest::setBaseVertex,
               #endif
@@ -229,7 +248,11 @@ MeshGLTest::MeshGLTest() {
               &MeshGLTest::multiDraw,
               &MeshGLTest::multiDrawIndexed,
               #ifndef MAGNUM_TARGET_GLES
-              &MeshGLTest::multiDrawBaseVertex
+              &MeshGLTest::multiDrawBaseVertex,
+              &MeshGLTest::multiDrawInstanced,
+
+              &MeshGLTest::drawIndirect,
+              &MeshGLTest::drawIndirectIndexed
               #endif
               });
 }
@@ -1502,6 +1525,122 @@ void MeshGLTest::unbindVAOWhenSettingIndexBufferData() {
     CORRADE_COMPARE(value, 92);
 }
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+void MeshGLTest::setVertexFormat() {
+    const Float data[] = {
+        0.0f, /* Offset */
+
+        /* First vertex */
+        0.3f, 0.1f, 0.5f,
+            0.4f, 0.0f, -0.9f,
+                1.0f, -0.5f,
+
+        /* Second vertex */
+        Math::unpack<Float, UnsignedByte>(64),
+            Math::unpack<Float, UnsignedByte>(17),
+                Math::unpack<Float, UnsignedByte>(56),
+        Math::unpack<Float, UnsignedByte>(15),
+            Math::unpack<Float, UnsignedByte>(164),
+                Math::unpack<Float, UnsignedByte>(17),
+        Math::unpack<Float, UnsignedByte>(97),
+            Math::unpack<Float, UnsignedByte>(28)
+    };
+
+    Buffer buffer;
+    buffer.setData(data, BufferUsage::StaticDraw);
+
+    VertexFormat format;
+    format.addVertexBuffer(0, MultipleShader::Position(),
+        MultipleShader::Normal(), MultipleShader::TextureCoordinates());
+
+    Mesh mesh;
+    mesh.setBaseVertex(1)
+        .setVertexFormat(format)
+        .setVertexBuffer(0, buffer, 1*4);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(mesh.vertexFormat(), &format);
+
+    const auto value = Checker(MultipleShader(), RenderbufferFormat::RGBA8,
+        mesh).get<Color4ub>(PixelFormat::RGBA, PixelType::UnsignedByte);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(value, Color4ub(64 + 15 + 97, 17 + 164 + 28, 56 + 17, 255));
+}
+
+void MeshGLTest::setVertexFormatShared() {
+    Buffer buffer;
+    buffer.setData(indexedVertexData, BufferUsage::StaticDraw);
+
+    VertexFormat format;
+    format.addVertexBuffer(0, MultipleShader::Position(),
+        MultipleShader::Normal(), MultipleShader::TextureCoordinates());
+
+    /* Both meshes use the same format and buffer, the second one starts at
+       the second vertex */
+    Mesh a, b;
+    a.setVertexFormat(format)
+        .setVertexBuffer(0, buffer, 1*4);
+    b.setVertexFormat(format)
+        .setVertexBuffer(0, buffer, 1*4 + 8*4);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    const auto valueA = Checker(MultipleShader{}, RenderbufferFormat::RGBA8,
+        a).get<Color4ub>(PixelFormat::RGBA, PixelType::UnsignedByte);
+    const auto valueB = Checker(MultipleShader{}, RenderbufferFormat::RGBA8,
+        b).get<Color4ub>(PixelFormat::RGBA, PixelType::UnsignedByte);
+    /* Drawing the first one again should rebind the buffer range */
+    const auto valueA2 = Checker(MultipleShader{}, RenderbufferFormat::RGBA8,
+        a).get<Color4ub>(PixelFormat::RGBA, PixelType::UnsignedByte);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(valueA, indexedResult);
+    CORRADE_COMPARE(valueB, Color4ub(255, 0, 0, 255));
+    CORRADE_COMPARE(valueA2, indexedResult);
+}
+
+void MeshGLTest::setVertexFormatSharedIndexed() {
+    Buffer vertices;
+    vertices.setData(indexedVertexData, BufferUsage::StaticDraw);
+
+    constexpr UnsignedShort indexDataA[] = { 2, 1, 0 };
+    Buffer indicesA{Buffer::TargetHint::ElementArray};
+    indicesA.setData(indexDataA, BufferUsage::StaticDraw);
+
+    constexpr UnsignedShort indexDataB[] = { 0, 1 };
+    Buffer indicesB{Buffer::TargetHint::ElementArray};
+    indicesB.setData(indexDataB, BufferUsage::StaticDraw);
+
+    VertexFormat format;
+    format.addVertexBuffer(0, MultipleShader::Position(),
+        MultipleShader::Normal(), MultipleShader::TextureCoordinates());
+
+    /* Same vertex data, different index buffers */
+    Mesh a, b;
+    a.setVertexFormat(format)
+        .setVertexBuffer(0, vertices, 1*4)
+        .setIndexBuffer(indicesA, 2, Mesh::IndexType::UnsignedShort);
+    b.setVertexFormat(format)
+        .setVertexBuffer(0, vertices, 1*4)
+        .setIndexBuffer(indicesB, 0, Mesh::IndexType::UnsignedShort);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    const auto valueA = Checker(MultipleShader{}, RenderbufferFormat::RGBA8,
+        a).get<Color4ub>(PixelFormat::RGBA, PixelType::UnsignedByte);
+    const auto valueB = Checker(MultipleShader{}, RenderbufferFormat::RGBA8,
+        b).get<Color4ub>(PixelFormat::RGBA, PixelType::UnsignedByte);
+    const auto valueA2 = Checker(MultipleShader{}, RenderbufferFormat::RGBA8,
+        a).get<Color4ub>(PixelFormat::RGBA, PixelType::UnsignedByte);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(valueA, indexedResult);
+    CORRADE_COMPARE(valueB, Color4ub(255, 0, 0, 255));
+    CORRADE_COMPARE(valueA2, indexedResult);
+}
+#endif
+
 #ifndef MAGNUM_TARGET_GLES
 void MeshGLTest::setBaseVertex() {
     if(!Context::current().isExtensionSupported<Extensions::GL::ARB::draw_elements_base_vertex>())
@@ -1998,6 +2137,121 @@ void MeshGLTest::multiDrawBaseVertex() {
     MAGNUM_VERIFY_NO_ERROR();
     CORRADE_COMPARE(value, indexedResult);
 }
+
+void MeshGLTest::multiDrawInstanced() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::multi_draw_indirect>())
+        CORRADE_SKIP(Extensions::GL::ARB::multi_draw_indirect::string() + std::string(" is not available."));
+
+    typedef Attribute<0, Float> Attribute;
+
+    const Float data[] = { 0.0f, -0.7f, Math::unpack<Float, UnsignedByte>(96) };
+    Buffer buffer;
+    buffer.setData(data, BufferUsage::StaticDraw);
+
+    Mesh mesh;
+    mesh.addVertexBuffer(buffer, 4, Attribute());
+
+    Renderbuffer renderbuffer;
+    renderbuffer.setStorage(RenderbufferFormat::RGBA8, Vector2i(1));
+    Framebuffer framebuffer{{{}, Vector2i(1)}};
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment(0), renderbuffer);
+    framebuffer.bind();
+
+    mesh.setPrimitive(MeshPrimitive::Points);
+
+    /* Instanced views are allowed only with ARB_multi_draw_indirect */
+    MeshView a{mesh};
+    a.setCount(0)
+     .setInstanceCount(3);
+    MeshView b{mesh};
+    b.setCount(1)
+     .setBaseVertex(1)
+     .setInstanceCount(3);
+
+    MeshView::draw(FloatShader("float", "vec4(valueInterpolated, 0.0, 0.0, 0.0)"), {a, b});
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(framebuffer.read({{}, Vector2i{1}}, {PixelFormat::RGBA, PixelType::UnsignedByte}).data<UnsignedByte>()[0], 96);
+}
+
+void MeshGLTest::drawIndirect() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::draw_indirect>())
+        CORRADE_SKIP(Extensions::GL::ARB::draw_indirect::string() + std::string(" is not available."));
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::multi_draw_indirect>())
+        Debug() << Extensions::GL::ARB::multi_draw_indirect::string() << "not supported, using fallback implementation";
+
+    typedef Attribute<0, Float> Attribute;
+
+    const Float data[] = { 0.0f, -0.7f, Math::unpack<Float, UnsignedByte>(96) };
+    Buffer buffer;
+    buffer.setData(data, BufferUsage::StaticDraw);
+
+    Mesh mesh;
+    mesh.setPrimitive(MeshPrimitive::Points)
+        .addVertexBuffer(buffer, 4, Attribute());
+
+    /* First command is empty so we test skipping, second skips the first
+       vertex so we test also offsets */
+    const Mesh::DrawArraysIndirectCommand commandData[] = {
+        {0, 1, 0, 0},
+        {1, 1, 1, 0}
+    };
+    Buffer commands{Buffer::TargetHint::DrawIndirect};
+    commands.setData(commandData, BufferUsage::StaticDraw);
+
+    Renderbuffer renderbuffer;
+    renderbuffer.setStorage(RenderbufferFormat::RGBA8, Vector2i(1));
+    Framebuffer framebuffer{{{}, Vector2i(1)}};
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment(0), renderbuffer);
+    framebuffer.bind();
+
+    mesh.drawIndirect(FloatShader("float", "vec4(valueInterpolated, 0.0, 0.0, 0.0)"), commands, 0, 2);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(framebuffer.read({{}, Vector2i{1}}, {PixelFormat::RGBA, PixelType::UnsignedByte}).data<UnsignedByte>()[0], 96);
+}
+
+void MeshGLTest::drawIndirectIndexed() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::draw_indirect>())
+        CORRADE_SKIP(Extensions::GL::ARB::draw_indirect::string() + std::string(" is not available."));
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::multi_draw_indirect>())
+        Debug() << Extensions::GL::ARB::multi_draw_indirect::string() << "not supported, using fallback implementation";
+
+    Buffer vertices;
+    vertices.setData(indexedVertexData, BufferUsage::StaticDraw);
+
+    constexpr UnsignedShort indexData[] = { 2, 1, 0 };
+    Buffer indices{Buffer::TargetHint::ElementArray};
+    indices.setData(indexData, BufferUsage::StaticDraw);
+
+    Mesh mesh;
+    mesh.setPrimitive(MeshPrimitive::Points)
+        .addVertexBuffer(vertices, 1*4,  MultipleShader::Position(),
+                         MultipleShader::Normal(), MultipleShader::TextureCoordinates())
+        .setIndexBuffer(indices, 0, Mesh::IndexType::UnsignedShort);
+
+    /* Stride larger than the command size so we test also that */
+    struct Command {
+        Mesh::DrawElementsIndirectCommand command;
+        UnsignedInt padding;
+    } commandData[] = {
+        {{0, 1, 0, 0, 0}, 0},
+        {{1, 1, 1, 0, 0}, 0}
+    };
+    Buffer commands{Buffer::TargetHint::DrawIndirect};
+    commands.setData(commandData, BufferUsage::StaticDraw);
+
+    Renderbuffer renderbuffer;
+    renderbuffer.setStorage(RenderbufferFormat::RGBA8, Vector2i(1));
+    Framebuffer framebuffer{{{}, Vector2i(1)}};
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment(0), renderbuffer);
+    framebuffer.bind();
+
+    mesh.drawIndirect(MultipleShader{}, commands, 0, 2, sizeof(Command));
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(framebuffer.read({{}, Vector2i{1}}, {PixelFormat::RGBA, PixelType::UnsignedByte}).data<Color4ub>()[0], indexedResult);
+}
 #endif
 
 }}
@@ -37,6 +37,7 @@ struct MeshTest: TestSuite::Tester {
     void constructNoCreate();
 
     void indexSize();
+    void primitiveRestartIndex();
 
     void debugPrimitive();
     void debugIndexType();
@@ -48,6 +49,7 @@ MeshTest::MeshTest() {
     addTests({&MeshTest::constructNoCreate,
 
               &MeshTest::indexSize,
+              &MeshTest::primitiveRestartIndex,
 
               &MeshTest::debugPrimitive,
               &MeshTest::debugIndexType,
@@ -70,6 +72,12 @@ void MeshTest::indexSize() {
     CORRADE_COMPARE(Mesh::indexSize(Mesh::IndexType::UnsignedInt), 4);
 }
 
+void MeshTest::primitiveRestartIndex() {
+    CORRADE_COMPARE(Mesh::primitiveRestartIndex(Mesh::IndexType::UnsignedByte), 0xff);
+    CORRADE_COMPARE(Mesh::primitiveRestartIndex(Mesh::IndexType::UnsignedShort), 0xffff);
+    CORRADE_COMPARE(Mesh::primitiveRestartIndex(Mesh::IndexType::UnsignedInt), 0xffffffffu);
+}
+
 void MeshTest::debugPrimitive() {
     std::ostringstream o;
     Debug(&o) << MeshPrimitive::TriangleFan << MeshPrimitive(0xdead);
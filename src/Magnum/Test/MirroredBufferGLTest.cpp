@@ -0,0 +1,227 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/MirroredBuffer.h"
+#include "Magnum/OpenGLTester.h"
+
+namespace Magnum { namespace Test {
+
+struct MirroredBufferGLTest: OpenGLTester {
+    explicit MirroredBufferGLTest();
+
+    void construct();
+    void constructCopy();
+    void constructMove();
+
+    void flush();
+    void flushNothing();
+    void flushSpan();
+    #ifndef MAGNUM_TARGET_WEBGL
+    void flushMapRange();
+    #endif
+};
+
+MirroredBufferGLTest::MirroredBufferGLTest() {
+    addTests({&MirroredBufferGLTest::construct,
+              &MirroredBufferGLTest::constructCopy,
+              &MirroredBufferGLTest::constructMove,
+
+              &MirroredBufferGLTest::flush,
+              &MirroredBufferGLTest::flushNothing,
+              &MirroredBufferGLTest::flushSpan,
+              #ifndef MAGNUM_TARGET_WEBGL
+              &MirroredBufferGLTest::flushMapRange
+              #endif
+              });
+}
+
+void MirroredBufferGLTest::construct() {
+    /* Uniform buffers are not available on ES2 */
+    #ifndef MAGNUM_TARGET_GLES2
+    const Buffer::TargetHint targetHint = Buffer::TargetHint::Uniform;
+    #else
+    const Buffer::TargetHint targetHint = Buffer::TargetHint::ElementArray;
+    #endif
+
+    {
+        MirroredBuffer buffer{64, BufferUsage::DynamicDraw, targetHint};
+
+        MAGNUM_VERIFY_NO_ERROR();
+        CORRADE_VERIFY(buffer.buffer().id() > 0);
+        CORRADE_COMPARE(buffer.buffer().targetHint(), targetHint);
+        CORRADE_COMPARE(buffer.buffer().size(), 64);
+        CORRADE_COMPARE(buffer.size(), 64);
+        CORRADE_COMPARE(buffer.data()[17], 0);
+        CORRADE_VERIFY(buffer.dirtyRanges().isEmpty());
+        #ifndef MAGNUM_TARGET_WEBGL
+        CORRADE_COMPARE(buffer.flushMode(), MirroredBuffer::FlushMode::SubData);
+        #else
+        CORRADE_COMPARE(buffer.flushMode(), MirroredBuffer::FlushMode::Span);
+        #endif
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void MirroredBufferGLTest::constructCopy() {
+    CORRADE_VERIFY(!(std::is_constructible<MirroredBuffer, const MirroredBuffer&>{}));
+    CORRADE_VERIFY(!(std::is_assignable<MirroredBuffer, const MirroredBuffer&>{}));
+}
+
+void MirroredBufferGLTest::constructMove() {
+    MirroredBuffer a{16};
+    const GLuint id = a.buffer().id();
+    a.markDirty(4, 4);
+
+    MirroredBuffer b{std::move(a)};
+    CORRADE_COMPARE(b.buffer().id(), id);
+    CORRADE_COMPARE(b.size(), 16);
+    CORRADE_VERIFY(!b.dirtyRanges().isEmpty());
+
+    MirroredBuffer c{8};
+    c = std::move(b);
+    CORRADE_COMPARE(c.buffer().id(), id);
+    CORRADE_COMPARE(c.size(), 16);
+}
+
+void MirroredBufferGLTest::flush() {
+    MirroredBuffer buffer{8*4};
+    buffer.setFlushMode(MirroredBuffer::FlushMode::SubData);
+
+    constexpr Int data[]{125, 3, 15};
+    buffer.setSubData(4, data);
+    *reinterpret_cast<Int*>(buffer.data(16, 4).data()) = 42;
+    Containers::ArrayView<char> view = buffer.data(24, 8);
+    reinterpret_cast<Int*>(view.data())[1] = 7;
+
+    CORRADE_COMPARE(buffer.flush(), 24);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(buffer.uploadedBytes(), 24);
+    /* 4-20 and 24-32 are not adjacent */
+    CORRADE_COMPARE(buffer.uploadCount(), 2);
+    CORRADE_VERIFY(buffer.dirtyRanges().isEmpty());
+
+    /** @todo How to verify the contents in ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    constexpr Int expected[]{0, 125, 3, 15, 42, 0, 0, 7};
+    const Containers::Array<Int> contents = buffer.buffer().data<Int>();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE_AS(contents, Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+    #endif
+
+    /* Modification through an existing view needs explicit marking */
+    reinterpret_cast<Int*>(view.data())[0] = 1;
+    buffer.markDirty(24, 4);
+    CORRADE_COMPARE(buffer.flush(), 4);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(buffer.uploadCount(), 1);
+
+    #ifndef MAGNUM_TARGET_GLES
+    constexpr Int expectedSub[]{1, 7};
+    const Containers::Array<Int> subContents = buffer.buffer().subData<Int>(24, 2);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE_AS(subContents, Containers::arrayView(expectedSub),
+        TestSuite::Compare::Container);
+    #endif
+}
+
+void MirroredBufferGLTest::flushNothing() {
+    MirroredBuffer buffer{16};
+    buffer.markDirty(4, 4);
+    buffer.flush();
+
+    CORRADE_COMPARE(buffer.flush(), 0);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(buffer.uploadedBytes(), 0);
+    CORRADE_COMPARE(buffer.uploadCount(), 0);
+}
+
+void MirroredBufferGLTest::flushSpan() {
+    MirroredBuffer buffer{8*4};
+    buffer.setFlushMode(MirroredBuffer::FlushMode::Span);
+
+    constexpr Int a[]{3, 4};
+    constexpr Int b[]{9};
+    buffer.setSubData(1*4, a)
+        .setSubData(6*4, b);
+
+    /* The untouched bytes in between are uploaded as well */
+    CORRADE_COMPARE(buffer.flush(), 24);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(buffer.uploadedBytes(), 24);
+    CORRADE_COMPARE(buffer.uploadCount(), 1);
+    CORRADE_VERIFY(buffer.dirtyRanges().isEmpty());
+
+    /** @todo How to verify the contents in ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    constexpr Int expected[]{0, 3, 4, 0, 0, 0, 9, 0};
+    const Containers::Array<Int> contents = buffer.buffer().data<Int>();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE_AS(contents, Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+    #endif
+}
+
+#ifndef MAGNUM_TARGET_WEBGL
+void MirroredBufferGLTest::flushMapRange() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::map_buffer_range>())
+        CORRADE_SKIP(Extensions::GL::ARB::map_buffer_range::string() + std::string(" is not supported"));
+    #elif defined(MAGNUM_TARGET_GLES2)
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::map_buffer_range>())
+        CORRADE_SKIP(Extensions::GL::EXT::map_buffer_range::string() + std::string(" is not supported"));
+    #endif
+
+    MirroredBuffer buffer{8*4};
+    buffer.setFlushMode(MirroredBuffer::FlushMode::MapRange);
+
+    constexpr Int a[]{3, 4};
+    constexpr Int b[]{9};
+    buffer.setSubData(1*4, a)
+        .setSubData(6*4, b);
+
+    CORRADE_COMPARE(buffer.flush(), 12);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(buffer.uploadCount(), 2);
+
+    #ifndef MAGNUM_TARGET_GLES
+    constexpr Int expected[]{0, 3, 4, 0, 0, 0, 9, 0};
+    const Containers::Array<Int> contents = buffer.buffer().data<Int>();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE_AS(contents, Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+    #endif
+}
+#endif
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::MirroredBufferGLTest)
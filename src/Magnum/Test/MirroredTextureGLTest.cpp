@@ -0,0 +1,136 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/MirroredTexture.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/TextureFormat.h"
+
+namespace Magnum { namespace Test {
+
+struct MirroredTextureGLTest: OpenGLTester {
+    explicit MirroredTextureGLTest();
+
+    void construct();
+    void constructCopy();
+
+    void flush();
+    void flushCoalesced();
+};
+
+MirroredTextureGLTest::MirroredTextureGLTest() {
+    addTests({&MirroredTextureGLTest::construct,
+              &MirroredTextureGLTest::constructCopy,
+
+              &MirroredTextureGLTest::flush,
+              &MirroredTextureGLTest::flushCoalesced});
+}
+
+namespace {
+    constexpr TextureFormat Format =
+        #if !(defined(MAGNUM_TARGET_GLES2) && defined(MAGNUM_TARGET_WEBGL))
+        TextureFormat::RGBA8;
+        #else
+        TextureFormat::RGBA;
+        #endif
+}
+
+void MirroredTextureGLTest::construct() {
+    {
+        MirroredTexture2D texture{Format, PixelFormat::RGBA, PixelType::UnsignedByte, {8, 4}};
+
+        MAGNUM_VERIFY_NO_ERROR();
+        CORRADE_VERIFY(texture.texture().id() > 0);
+        CORRADE_COMPARE(texture.size(), (Vector2i{8, 4}));
+        CORRADE_COMPARE(texture.image().size(), (Vector2i{8, 4}));
+        CORRADE_COMPARE(texture.data().size(), 8*4*4);
+
+        /* Whole texture is dirty initially */
+        CORRADE_COMPARE(texture.flush(), 8*4*4);
+        MAGNUM_VERIFY_NO_ERROR();
+        CORRADE_COMPARE(texture.uploadCount(), 1);
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void MirroredTextureGLTest::constructCopy() {
+    CORRADE_VERIFY(!(std::is_constructible<MirroredTexture2D, const MirroredTexture2D&>{}));
+    CORRADE_VERIFY(!(std::is_assignable<MirroredTexture2D, const MirroredTexture2D&>{}));
+}
+
+void MirroredTextureGLTest::flush() {
+    MirroredTexture2D texture{Format, PixelFormat::RGBA, PixelType::UnsignedByte, {4, 4}};
+    texture.flush();
+
+    constexpr UnsignedByte data[]{
+        0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88,
+        0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff, 0x00
+    };
+    texture.setSubImage({1, 2}, ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {2, 2}, data});
+
+    /* The mirror is updated immediately */
+    CORRADE_COMPARE(UnsignedByte(texture.data()[2*16 + 1*4 + 1]), 0x22);
+    CORRADE_COMPARE(UnsignedByte(texture.data()[3*16 + 2*4 + 3]), 0x00);
+
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_COMPARE(texture.flush(), 2*2*4);
+    #else
+    /* Extended to whole rows on ES2 */
+    CORRADE_COMPARE(texture.flush(), 4*2*4);
+    #endif
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(texture.uploadCount(), 1);
+
+    /** @todo How to test this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    Image2D image = texture.texture().image(0, {PixelFormat::RGBA, PixelType::UnsignedByte});
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE_AS(image.data(), texture.image().data(),
+        TestSuite::Compare::Container);
+    #endif
+}
+
+void MirroredTextureGLTest::flushCoalesced() {
+    MirroredTexture2D texture{Format, PixelFormat::RGBA, PixelType::UnsignedByte, {64, 64}};
+    texture.flush();
+
+    texture.markDirty({{0, 0}, {8, 4}})
+        .markDirty({{0, 4}, {8, 8}})
+        .markDirty({{32, 32}, {40, 40}});
+
+    CORRADE_COMPARE(texture.flush(), 2*8*8*4);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(texture.uploadCount(), 2);
+    CORRADE_VERIFY(texture.dirtyRectangles().isEmpty());
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::MirroredTextureGLTest)
@@ -0,0 +1,205 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/RangeAllocator.h"
+
+namespace Magnum { namespace Test {
+
+struct RangeAllocatorTest: TestSuite::Tester {
+    explicit RangeAllocatorTest();
+
+    void construct();
+    void allocate();
+    void allocateAligned();
+    void allocateBestFit();
+    void allocateFull();
+    void allocateZero();
+    void deallocateCoalesce();
+    void deallocateInvalid();
+    void defragment();
+    void defragmentAligned();
+};
+
+RangeAllocatorTest::RangeAllocatorTest() {
+    addTests({&RangeAllocatorTest::construct,
+              &RangeAllocatorTest::allocate,
+              &RangeAllocatorTest::allocateAligned,
+              &RangeAllocatorTest::allocateBestFit,
+              &RangeAllocatorTest::allocateFull,
+              &RangeAllocatorTest::allocateZero,
+              &RangeAllocatorTest::deallocateCoalesce,
+              &RangeAllocatorTest::deallocateInvalid,
+              &RangeAllocatorTest::defragment,
+              &RangeAllocatorTest::defragmentAligned});
+}
+
+void RangeAllocatorTest::construct() {
+    RangeAllocator allocator{1024};
+    CORRADE_COMPARE(allocator.size(), 1024);
+    CORRADE_COMPARE(allocator.available(), 1024);
+    CORRADE_COMPARE(allocator.largestFreeRange(), 1024);
+    CORRADE_COMPARE(allocator.allocationCount(), 0);
+}
+
+void RangeAllocatorTest::allocate() {
+    RangeAllocator allocator{1024};
+    CORRADE_COMPARE(allocator.allocate(100), 0);
+    CORRADE_COMPARE(allocator.allocate(200), 100);
+    CORRADE_COMPARE(allocator.allocationCount(), 2);
+    CORRADE_COMPARE(allocator.allocationSize(100), 200);
+    CORRADE_COMPARE(allocator.available(), 724);
+    CORRADE_COMPARE(allocator.largestFreeRange(), 724);
+}
+
+void RangeAllocatorTest::allocateAligned() {
+    RangeAllocator allocator{1024};
+    CORRADE_COMPARE(allocator.allocate(10), 0);
+    CORRADE_COMPARE(allocator.allocate(16, 16), 16);
+
+    /* The padding stays free and can be used later */
+    CORRADE_COMPARE(allocator.available(), 1024 - 26);
+    CORRADE_COMPARE(allocator.allocate(6), 10);
+}
+
+void RangeAllocatorTest::allocateBestFit() {
+    RangeAllocator allocator{1024};
+    const std::size_t a = allocator.allocate(100);
+    allocator.allocate(8);
+    const std::size_t b = allocator.allocate(40);
+    allocator.allocate(8);
+    allocator.deallocate(a);
+    allocator.deallocate(b);
+
+    /* The 40-byte hole fits better than the 100-byte one */
+    CORRADE_COMPARE(allocator.allocate(32), b);
+    /* Exact fit of the rest */
+    CORRADE_COMPARE(allocator.allocate(100), a);
+}
+
+void RangeAllocatorTest::allocateFull() {
+    RangeAllocator allocator{64};
+    CORRADE_COMPARE(allocator.allocate(40), 0);
+    CORRADE_COMPARE(allocator.allocate(40), RangeAllocator::NotFound);
+    CORRADE_COMPARE(allocator.allocate(24), 40);
+    CORRADE_COMPARE(allocator.available(), 0);
+    CORRADE_COMPARE(allocator.largestFreeRange(), 0);
+    CORRADE_COMPARE(allocator.allocate(1), RangeAllocator::NotFound);
+}
+
+void RangeAllocatorTest::allocateZero() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    RangeAllocator allocator{64};
+    CORRADE_COMPARE(allocator.allocate(0), RangeAllocator::NotFound);
+    CORRADE_COMPARE(allocator.allocate(8, 0), RangeAllocator::NotFound);
+    CORRADE_COMPARE(out.str(),
+        "RangeAllocator::allocate(): expected non-zero size and alignment\n"
+        "RangeAllocator::allocate(): expected non-zero size and alignment\n");
+}
+
+void RangeAllocatorTest::deallocateCoalesce() {
+    RangeAllocator allocator{300};
+    const std::size_t a = allocator.allocate(100);
+    const std::size_t b = allocator.allocate(100);
+    const std::size_t c = allocator.allocate(100);
+
+    allocator.deallocate(a);
+    allocator.deallocate(c);
+    CORRADE_COMPARE(allocator.largestFreeRange(), 100);
+
+    /* Merged with both neighbors */
+    allocator.deallocate(b);
+    CORRADE_COMPARE(allocator.allocationCount(), 0);
+    CORRADE_COMPARE(allocator.largestFreeRange(), 300);
+    CORRADE_COMPARE(allocator.allocate(300), 0);
+}
+
+void RangeAllocatorTest::deallocateInvalid() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    RangeAllocator allocator{64};
+    allocator.allocate(16);
+    allocator.deallocate(8);
+    allocator.allocationSize(8);
+    CORRADE_COMPARE(allocator.allocationCount(), 1);
+    CORRADE_COMPARE(out.str(),
+        "RangeAllocator::deallocate(): no allocation at offset 8\n"
+        "RangeAllocator::allocationSize(): no allocation at offset 8\n");
+}
+
+void RangeAllocatorTest::defragment() {
+    RangeAllocator allocator{100};
+    const std::size_t a = allocator.allocate(10);
+    allocator.allocate(20);
+    const std::size_t c = allocator.allocate(30);
+    allocator.allocate(10);
+    allocator.deallocate(a);
+    allocator.deallocate(c);
+    CORRADE_COMPARE(allocator.largestFreeRange(), 30);
+
+    const std::vector<RangeAllocator::Move> moves = allocator.defragment();
+    CORRADE_COMPARE(moves.size(), 2);
+    CORRADE_COMPARE(moves[0].oldOffset, 10);
+    CORRADE_COMPARE(moves[0].newOffset, 0);
+    CORRADE_COMPARE(moves[0].size, 20);
+    CORRADE_COMPARE(moves[1].oldOffset, 60);
+    CORRADE_COMPARE(moves[1].newOffset, 20);
+    CORRADE_COMPARE(moves[1].size, 10);
+
+    CORRADE_COMPARE(allocator.largestFreeRange(), 70);
+    CORRADE_COMPARE(allocator.allocationSize(20), 10);
+    CORRADE_COMPARE(allocator.allocate(70), 30);
+
+    /* Nothing to do the second time */
+    CORRADE_VERIFY(allocator.defragment().empty());
+}
+
+void RangeAllocatorTest::defragmentAligned() {
+    RangeAllocator allocator{128};
+    const std::size_t a = allocator.allocate(20);
+    allocator.allocate(8);
+    allocator.allocate(16, 16);
+    allocator.deallocate(a);
+
+    const std::vector<RangeAllocator::Move> moves = allocator.defragment();
+    CORRADE_COMPARE(moves.size(), 2);
+    CORRADE_COMPARE(moves[0].newOffset, 0);
+    /* Aligned up from 8 */
+    CORRADE_COMPARE(moves[1].oldOffset, 32);
+    CORRADE_COMPARE(moves[1].newOffset, 16);
+
+    /* The padding is free */
+    CORRADE_COMPARE(allocator.available(), 128 - 24);
+    CORRADE_COMPARE(allocator.allocate(8), 8);
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::RangeAllocatorTest)
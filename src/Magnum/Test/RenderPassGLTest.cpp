@@ -0,0 +1,158 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Framebuffer.h"
+#include "Magnum/Image.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Renderbuffer.h"
+#include "Magnum/RenderbufferFormat.h"
+#include "Magnum/RenderPass.h"
+#include "Magnum/OpenGLTester.h"
+
+namespace Magnum { namespace Test {
+
+struct RenderPassGLTest: OpenGLTester {
+    explicit RenderPassGLTest();
+
+    void clear();
+    void invalidate();
+    void statistics();
+};
+
+RenderPassGLTest::RenderPassGLTest() {
+    addTests({&RenderPassGLTest::clear,
+              &RenderPassGLTest::invalidate,
+              &RenderPassGLTest::statistics});
+}
+
+void RenderPassGLTest::clear() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::framebuffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::framebuffer_object::string() + std::string(" is not available."));
+    #endif
+
+    Renderbuffer color;
+    #ifndef MAGNUM_TARGET_GLES2
+    color.setStorage(RenderbufferFormat::RGBA8, Vector2i(32));
+    #else
+    color.setStorage(RenderbufferFormat::RGBA4, Vector2i(32));
+    #endif
+
+    Framebuffer framebuffer({{}, Vector2i(32)});
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment(0), color);
+
+    RenderPass pass{framebuffer};
+    pass.setColor(RenderPassLoadAction::Clear, RenderPassStoreAction::Store)
+        .setClearColor(Color4{1.0f, 0.0f, 1.0f, 1.0f})
+        .setPixelSizes(4, 0, 0);
+    pass.begin();
+    CORRADE_VERIFY(pass.isActive());
+    pass.end();
+    CORRADE_VERIFY(!pass.isActive());
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    Image2D image = framebuffer.read({{}, Vector2i{1}}, {PixelFormat::RGBA, PixelType::UnsignedByte});
+    CORRADE_COMPARE(image.data<Color4ub>()[0], (Color4ub{255, 0, 255, 255}));
+}
+
+void RenderPassGLTest::invalidate() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::framebuffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::framebuffer_object::string() + std::string(" is not available."));
+    #endif
+
+    Renderbuffer color;
+    #ifndef MAGNUM_TARGET_GLES2
+    color.setStorage(RenderbufferFormat::RGBA8, Vector2i(32));
+    #else
+    color.setStorage(RenderbufferFormat::RGBA4, Vector2i(32));
+    #endif
+
+    Renderbuffer depth;
+    depth.setStorage(RenderbufferFormat::DepthComponent16, Vector2i(32));
+
+    Framebuffer framebuffer({{}, Vector2i(32)});
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment(0), color)
+               .attachRenderbuffer(Framebuffer::BufferAttachment::Depth, depth);
+
+    RenderPass pass{framebuffer};
+    pass.setColor(RenderPassLoadAction::DontCare, RenderPassStoreAction::Store)
+        .setDepth(RenderPassLoadAction::Clear, RenderPassStoreAction::DontCare)
+        .setStencil(RenderPassLoadAction::DontCare, RenderPassStoreAction::DontCare);
+    pass.begin();
+    pass.end();
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void RenderPassGLTest::statistics() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::framebuffer_object>())
+        CORRADE_SKIP(Extensions::GL::ARB::framebuffer_object::string() + std::string(" is not available."));
+    #endif
+
+    Renderbuffer color;
+    #ifndef MAGNUM_TARGET_GLES2
+    color.setStorage(RenderbufferFormat::RGBA8, Vector2i(32, 16));
+    #else
+    color.setStorage(RenderbufferFormat::RGBA4, Vector2i(32, 16));
+    #endif
+
+    Renderbuffer depth;
+    depth.setStorage(RenderbufferFormat::DepthComponent16, Vector2i(32, 16));
+
+    Framebuffer framebuffer({{}, Vector2i(32, 16)});
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment(0), color)
+               .attachRenderbuffer(Framebuffer::BufferAttachment::Depth, depth);
+
+    /* Color is loaded and stored, depth is cleared and not stored, there's
+       no stencil */
+    RenderPass pass{framebuffer};
+    pass.setDepth(RenderPassLoadAction::Clear, RenderPassStoreAction::DontCare)
+        .setPixelSizes(4, 2, 0);
+    for(std::size_t i = 0; i != 3; ++i) {
+        pass.begin();
+        pass.end();
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE(pass.statistics().passCount, 3);
+    CORRADE_COMPARE(pass.statistics().loadedBytes, 3*32*16*4);
+    CORRADE_COMPARE(pass.statistics().storedBytes, 3*32*16*4);
+    CORRADE_COMPARE(pass.statistics().avoidedLoadBytes, 3*32*16*2);
+    CORRADE_COMPARE(pass.statistics().avoidedStoreBytes, 3*32*16*2);
+
+    pass.resetStatistics();
+    CORRADE_COMPARE(pass.statistics().passCount, 0);
+    CORRADE_COMPARE(pass.statistics().avoidedLoadBytes, 0);
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::RenderPassGLTest)
@@ -0,0 +1,104 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/RenderPass.h"
+
+namespace Magnum { namespace Test {
+
+struct RenderPassTest: TestSuite::Tester {
+    explicit RenderPassTest();
+
+    void construct();
+    void setActions();
+    void endNotActive();
+
+    void debugLoadAction();
+    void debugStoreAction();
+};
+
+RenderPassTest::RenderPassTest() {
+    addTests({&RenderPassTest::construct,
+              &RenderPassTest::setActions,
+              &RenderPassTest::endNotActive,
+
+              &RenderPassTest::debugLoadAction,
+              &RenderPassTest::debugStoreAction});
+}
+
+void RenderPassTest::construct() {
+    RenderPass pass{defaultFramebuffer};
+    CORRADE_COMPARE(pass.colorLoadAction(), RenderPassLoadAction::Load);
+    CORRADE_COMPARE(pass.colorStoreAction(), RenderPassStoreAction::Store);
+    CORRADE_COMPARE(pass.depthLoadAction(), RenderPassLoadAction::Load);
+    CORRADE_COMPARE(pass.depthStoreAction(), RenderPassStoreAction::Store);
+    CORRADE_COMPARE(pass.stencilLoadAction(), RenderPassLoadAction::Load);
+    CORRADE_COMPARE(pass.stencilStoreAction(), RenderPassStoreAction::Store);
+    CORRADE_VERIFY(!pass.isActive());
+    CORRADE_COMPARE(pass.statistics().passCount, 0);
+    CORRADE_COMPARE(pass.statistics().avoidedLoadBytes, 0);
+    CORRADE_COMPARE(pass.statistics().avoidedStoreBytes, 0);
+}
+
+void RenderPassTest::setActions() {
+    RenderPass pass{defaultFramebuffer};
+    pass.setColor(RenderPassLoadAction::Clear, RenderPassStoreAction::Store)
+        .setDepth(RenderPassLoadAction::Clear, RenderPassStoreAction::DontCare)
+        .setStencil(RenderPassLoadAction::DontCare, RenderPassStoreAction::DontCare);
+    CORRADE_COMPARE(pass.colorLoadAction(), RenderPassLoadAction::Clear);
+    CORRADE_COMPARE(pass.colorStoreAction(), RenderPassStoreAction::Store);
+    CORRADE_COMPARE(pass.depthLoadAction(), RenderPassLoadAction::Clear);
+    CORRADE_COMPARE(pass.depthStoreAction(), RenderPassStoreAction::DontCare);
+    CORRADE_COMPARE(pass.stencilLoadAction(), RenderPassLoadAction::DontCare);
+    CORRADE_COMPARE(pass.stencilStoreAction(), RenderPassStoreAction::DontCare);
+}
+
+void RenderPassTest::endNotActive() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    RenderPass pass{defaultFramebuffer};
+    pass.end();
+    CORRADE_COMPARE(pass.statistics().passCount, 0);
+    CORRADE_COMPARE(out.str(), "RenderPass::end(): the pass is not active\n");
+}
+
+void RenderPassTest::debugLoadAction() {
+    std::ostringstream out;
+    Debug(&out) << RenderPassLoadAction::DontCare << RenderPassLoadAction(0xde);
+    CORRADE_COMPARE(out.str(), "RenderPassLoadAction::DontCare RenderPassLoadAction(0xde)\n");
+}
+
+void RenderPassTest::debugStoreAction() {
+    std::ostringstream out;
+    Debug(&out) << RenderPassStoreAction::DontCare << RenderPassStoreAction(0xde);
+    CORRADE_COMPARE(out.str(), "RenderPassStoreAction::DontCare RenderPassStoreAction(0xde)\n");
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::RenderPassTest)
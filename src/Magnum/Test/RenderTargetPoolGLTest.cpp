@@ -0,0 +1,196 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/RenderbufferFormat.h"
+#include "Magnum/RenderTargetPool.h"
+#include "Magnum/TextureFormat.h"
+
+namespace Magnum { namespace Test {
+
+struct RenderTargetPoolGLTest: OpenGLTester {
+    explicit RenderTargetPoolGLTest();
+
+    void construct();
+    void constructCopy();
+
+    void acquireTexture();
+    void acquireTextureReuse();
+    void acquireRenderbuffer();
+    void acquireFramebuffer();
+
+    void nextFrame();
+    void clear();
+};
+
+RenderTargetPoolGLTest::RenderTargetPoolGLTest() {
+    addTests({&RenderTargetPoolGLTest::construct,
+              &RenderTargetPoolGLTest::constructCopy,
+
+              &RenderTargetPoolGLTest::acquireTexture,
+              &RenderTargetPoolGLTest::acquireTextureReuse,
+              &RenderTargetPoolGLTest::acquireRenderbuffer,
+              &RenderTargetPoolGLTest::acquireFramebuffer,
+
+              &RenderTargetPoolGLTest::nextFrame,
+              &RenderTargetPoolGLTest::clear});
+}
+
+namespace {
+    #ifndef MAGNUM_TARGET_GLES2
+    constexpr TextureFormat ColorFormat = TextureFormat::RGBA8;
+    #else
+    constexpr TextureFormat ColorFormat = TextureFormat::RGBA;
+    #endif
+}
+
+void RenderTargetPoolGLTest::construct() {
+    RenderTargetPool pool{5};
+    CORRADE_COMPARE(pool.maxUnusedFrames(), 5);
+    CORRADE_COMPARE(pool.textureCount(), 0);
+    CORRADE_COMPARE(pool.renderbufferCount(), 0);
+    CORRADE_COMPARE(pool.framebufferCount(), 0);
+    CORRADE_COMPARE(pool.usedCount(), 0);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void RenderTargetPoolGLTest::constructCopy() {
+    CORRADE_VERIFY(!(std::is_constructible<RenderTargetPool, const RenderTargetPool&>{}));
+    CORRADE_VERIFY(!(std::is_assignable<RenderTargetPool, const RenderTargetPool&>{}));
+}
+
+void RenderTargetPoolGLTest::acquireTexture() {
+    RenderTargetPool pool;
+    Texture2D& a = pool.acquireTexture({64, 32}, ColorFormat);
+    Texture2D& b = pool.acquireTexture({64, 32}, ColorFormat);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(&a != &b);
+    CORRADE_VERIFY(a.id() > 0);
+    CORRADE_COMPARE(pool.textureCount(), 2);
+    CORRADE_COMPARE(pool.usedCount(), 2);
+
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_COMPARE(a.imageSize(0), (Vector2i{64, 32}));
+    #endif
+}
+
+void RenderTargetPoolGLTest::acquireTextureReuse() {
+    RenderTargetPool pool;
+    Texture2D& a = pool.acquireTexture({64, 32}, ColorFormat);
+    pool.release(a);
+
+    /* Different size and format gets a new texture */
+    Texture2D& b = pool.acquireTexture({32, 32}, ColorFormat);
+    #ifndef MAGNUM_TARGET_GLES2
+    Texture2D& c = pool.acquireTexture({64, 32}, TextureFormat::R8);
+    #endif
+
+    /* Same size and format gets the released one */
+    Texture2D& d = pool.acquireTexture({64, 32}, ColorFormat);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(&b != &a);
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_VERIFY(&c != &a);
+    CORRADE_COMPARE(pool.textureCount(), 3);
+    #else
+    CORRADE_COMPARE(pool.textureCount(), 2);
+    #endif
+    CORRADE_VERIFY(&d == &a);
+}
+
+void RenderTargetPoolGLTest::acquireRenderbuffer() {
+    RenderTargetPool pool;
+    Renderbuffer& a = pool.acquireRenderbuffer({64, 32}, RenderbufferFormat::DepthComponent16);
+    pool.release(a);
+    Renderbuffer& b = pool.acquireRenderbuffer({64, 32}, RenderbufferFormat::DepthComponent16);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(&b == &a);
+    CORRADE_COMPARE(pool.renderbufferCount(), 1);
+    CORRADE_COMPARE(pool.usedCount(), 1);
+}
+
+void RenderTargetPoolGLTest::acquireFramebuffer() {
+    RenderTargetPool pool;
+    Framebuffer& a = pool.acquireFramebuffer({64, 32});
+    a.setViewport({{16, 16}, {32, 32}});
+    pool.release(a);
+
+    /* The viewport is reset */
+    Framebuffer& b = pool.acquireFramebuffer({64, 32});
+    Framebuffer& c = pool.acquireFramebuffer({32, 32});
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(&b == &a);
+    CORRADE_VERIFY(&c != &a);
+    CORRADE_COMPARE(b.viewport(), (Range2Di{{}, {64, 32}}));
+    CORRADE_COMPARE(pool.framebufferCount(), 2);
+}
+
+void RenderTargetPoolGLTest::nextFrame() {
+    RenderTargetPool pool{2};
+    Texture2D& a = pool.acquireTexture({64, 32}, ColorFormat);
+    Texture2D& b = pool.acquireTexture({32, 32}, ColorFormat);
+    pool.acquireRenderbuffer({64, 32}, RenderbufferFormat::DepthComponent16);
+    pool.release(a);
+    pool.release(b);
+
+    /* Unused for one frame, kept */
+    pool.nextFrame();
+    CORRADE_COMPARE(pool.textureCount(), 2);
+
+    /* One of them is used again */
+    CORRADE_VERIFY(&pool.acquireTexture({32, 32}, ColorFormat) == &b);
+    pool.release(b);
+
+    /* The other one was unused for two frames, deleted. The renderbuffer is
+       still acquired, so it's kept. */
+    pool.nextFrame();
+    pool.nextFrame();
+    CORRADE_COMPARE(pool.textureCount(), 1);
+    CORRADE_COMPARE(pool.renderbufferCount(), 1);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void RenderTargetPoolGLTest::clear() {
+    RenderTargetPool pool;
+    Texture2D& a = pool.acquireTexture({64, 32}, ColorFormat);
+    pool.acquireTexture({64, 32}, ColorFormat);
+    pool.release(a);
+
+    pool.clear();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(pool.textureCount(), 1);
+    CORRADE_COMPARE(pool.usedCount(), 1);
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::RenderTargetPoolGLTest)
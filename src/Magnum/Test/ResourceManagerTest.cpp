@@ -25,6 +25,12 @@
 
 #include <sstream>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/configure.h>
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#include <vector>
+#endif
 
 #include "Magnum/AbstractResourceLoader.h"
 #include "Magnum/ResourceManager.h"
@@ -40,11 +46,17 @@ struct ResourceManagerTest: TestSuite::Tester {
     void basic();
     void residentPolicy();
     void referenceCountedPolicy();
+    void cachedPolicy();
+    void cachedPolicyLoader();
     void manualPolicy();
     void defaults();
     void clear();
     void clearWhileReferenced();
     void loader();
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    void concurrentAccess();
+    void concurrentReferenceCounted();
+    #endif
 
     void debugResourceState();
 };
@@ -67,11 +79,17 @@ ResourceManagerTest::ResourceManagerTest() {
               &ResourceManagerTest::basic,
               &ResourceManagerTest::residentPolicy,
               &ResourceManagerTest::referenceCountedPolicy,
+              &ResourceManagerTest::cachedPolicy,
+              &ResourceManagerTest::cachedPolicyLoader,
               &ResourceManagerTest::manualPolicy,
               &ResourceManagerTest::defaults,
               &ResourceManagerTest::clear,
               &ResourceManagerTest::clearWhileReferenced,
               &ResourceManagerTest::loader,
+              #ifndef CORRADE_TARGET_EMSCRIPTEN
+              &ResourceManagerTest::concurrentAccess,
+              &ResourceManagerTest::concurrentReferenceCounted,
+              #endif
 
               &ResourceManagerTest::debugResourceState});
 }
@@ -216,6 +234,112 @@ void ResourceManagerTest::referenceCountedPolicy() {
     CORRADE_COMPARE(rm.referenceCount<Data>(dataRefCountKey), 0);
 }
 
+void ResourceManagerTest::cachedPolicy() {
+    ResourceManager rm;
+    rm.setCacheBudget<Data>(100);
+    CORRADE_COMPARE(rm.cacheBudget<Data>(), 100);
+
+    /* Resources are kept after all references are removed */
+    rm.set("a", new Data, ResourceDataState::Final, ResourcePolicy::Cached, 40);
+    rm.set("b", new Data, ResourceDataState::Final, ResourcePolicy::Cached, 40);
+    {
+        Resource<Data> a = rm.get<Data>("a");
+        Resource<Data> b = rm.get<Data>("b");
+    }
+    CORRADE_COMPARE(rm.count<Data>(), 2);
+    CORRADE_COMPARE(rm.cacheSize<Data>(), 80);
+    CORRADE_COMPARE(Data::count, 2);
+
+    /* Touching the first makes the second least recently used, which then
+       gets unloaded when the budget is exceeded */
+    {
+        Resource<Data> a = rm.get<Data>("a");
+    }
+    rm.set("c", new Data, ResourceDataState::Final, ResourcePolicy::Cached, 40);
+    CORRADE_COMPARE(rm.count<Data>(), 2);
+    CORRADE_COMPARE(rm.cacheSize<Data>(), 80);
+    CORRADE_COMPARE(rm.state<Data>("a"), ResourceState::Final);
+    CORRADE_COMPARE(rm.state<Data>("b"), ResourceState::NotLoaded);
+    CORRADE_COMPARE(rm.state<Data>("c"), ResourceState::Final);
+    CORRADE_COMPARE(Data::count, 2);
+
+    /* Referenced resources are never unloaded, the cache can go over budget
+       if needed */
+    {
+        Resource<Data> a = rm.get<Data>("a");
+        Resource<Data> c = rm.get<Data>("c");
+        rm.set("d", new Data, ResourceDataState::Final, ResourcePolicy::Cached, 40);
+        CORRADE_COMPARE(rm.count<Data>(), 3);
+        CORRADE_COMPARE(rm.cacheSize<Data>(), 120);
+
+        /* The resource being set is kept even though it doesn't fit */
+        rm.setCacheBudget<Data>(0);
+        CORRADE_COMPARE(rm.count<Data>(), 2);
+        CORRADE_COMPARE(rm.cacheSize<Data>(), 80);
+    }
+
+    /* Releasing the references unloads them with zero budget */
+    CORRADE_COMPARE(rm.count<Data>(), 0);
+    CORRADE_COMPARE(rm.cacheSize<Data>(), 0);
+    CORRADE_COMPARE(Data::count, 0);
+
+    /* Resources that change policy are removed from the cache */
+    rm.setCacheBudget<Data>(100);
+    rm.set("a", new Data, ResourceDataState::Mutable, ResourcePolicy::Cached, 40);
+    CORRADE_COMPARE(rm.cacheSize<Data>(), 40);
+    rm.set("a", new Data, ResourceDataState::Mutable, ResourcePolicy::Manual, 40);
+    CORRADE_COMPARE(rm.cacheSize<Data>(), 0);
+
+    /* free() unloads all unreferenced cached resources */
+    rm.set("b", new Data, ResourceDataState::Final, ResourcePolicy::Cached, 40);
+    rm.free<Data>();
+    CORRADE_COMPARE(rm.count<Data>(), 0);
+    CORRADE_COMPARE(rm.cacheSize<Data>(), 0);
+    CORRADE_COMPARE(Data::count, 0);
+}
+
+void ResourceManagerTest::cachedPolicyLoader() {
+    class IntResourceLoader: public AbstractResourceLoader<Int> {
+        private:
+            void doLoad(ResourceKey key) override {
+                set(key, 42, ResourceDataState::Final, ResourcePolicy::Cached, 10);
+            }
+    };
+
+    ResourceManager rm;
+    IntResourceLoader* loader = new IntResourceLoader;
+    rm.setLoader(loader)
+      .setCacheBudget<Int>(10);
+
+    {
+        Resource<Int> a = rm.get<Int>("a");
+        CORRADE_COMPARE(*a, 42);
+    }
+    CORRADE_COMPARE(loader->loadedCount(), 1);
+
+    /* Still cached, no reload */
+    {
+        Resource<Int> a = rm.get<Int>("a");
+        CORRADE_COMPARE(*a, 42);
+    }
+    CORRADE_COMPARE(loader->loadedCount(), 1);
+
+    /* Pushed out of the cache by another resource, reloaded on next
+       access */
+    {
+        Resource<Int> b = rm.get<Int>("b");
+        CORRADE_COMPARE(*b, 42);
+    }
+    CORRADE_COMPARE(rm.state<Int>("a"), ResourceState::NotLoaded);
+    CORRADE_COMPARE(loader->loadedCount(), 2);
+    {
+        Resource<Int> a = rm.get<Int>("a");
+        CORRADE_COMPARE(*a, 42);
+    }
+    CORRADE_COMPARE(loader->loadedCount(), 3);
+    CORRADE_COMPARE(rm.count<Int>(), 1);
+}
+
 void ResourceManagerTest::manualPolicy() {
     ResourceManager rm;
 
@@ -333,6 +457,65 @@ void ResourceManagerTest::loader() {
     CORRADE_COMPARE(Data::count, 0);
 }
 
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+void ResourceManagerTest::concurrentAccess() {
+    ResourceManager rm;
+    for(Int i = 0; i != 64; ++i)
+        rm.set(ResourceKey(std::size_t(i)), new Int{i}, ResourceDataState::Final, ResourcePolicy::Resident);
+
+    /* Each thread acquires, copies and dereferences all resources, plus a few
+       that aren't there */
+    std::vector<std::thread> threads;
+    std::vector<Int> mismatches(4);
+    for(std::size_t t = 0; t != mismatches.size(); ++t) threads.emplace_back([&rm, &mismatches, t]() {
+        for(Int iteration = 0; iteration != 100; ++iteration) {
+            for(Int i = 0; i != 72; ++i) {
+                Resource<Int> a = rm.get<Int>(ResourceKey(std::size_t(i)));
+                Resource<Int> b = a;
+                if((i < 64) != bool(b) || (i < 64 && *b != i))
+                    ++mismatches[t];
+            }
+        }
+    });
+    for(std::thread& thread: threads) thread.join();
+
+    for(Int m: mismatches) CORRADE_COMPARE(m, 0);
+    CORRADE_COMPARE(rm.count<Int>(), 72);
+    for(Int i = 0; i != 72; ++i)
+        CORRADE_COMPARE(rm.referenceCount<Int>(ResourceKey(std::size_t(i))), 0);
+}
+
+void ResourceManagerTest::concurrentReferenceCounted() {
+    ResourceManager rm;
+
+    /* Threads keep acquiring and releasing the same reference counted
+       resource while the main thread replaces it, the entry has to be
+       removed exactly when the last reference goes away */
+    std::vector<std::thread> threads;
+    for(std::size_t t = 0; t != 4; ++t) threads.emplace_back([&rm]() {
+        for(Int iteration = 0; iteration != 1000; ++iteration) {
+            Resource<Int> a = rm.get<Int>("refcounted");
+            Resource<Int> b;
+            b = a;
+            b.state();
+        }
+    });
+    for(Int i = 0; i != 1000; ++i)
+        rm.set<Int>("refcounted", new Int{i}, ResourceDataState::Mutable, ResourcePolicy::ReferenceCounted);
+    for(std::thread& thread: threads) thread.join();
+
+    CORRADE_COMPARE(rm.referenceCount<Int>("refcounted"), 0);
+
+    /* Releasing the last reference still removes it */
+    rm.set<Int>("refcounted", new Int{}, ResourceDataState::Mutable, ResourcePolicy::ReferenceCounted);
+    {
+        Resource<Int> a = rm.get<Int>("refcounted");
+        CORRADE_COMPARE(rm.referenceCount<Int>("refcounted"), 1);
+    }
+    CORRADE_COMPARE(rm.count<Int>(), 0);
+}
+#endif
+
 void ResourceManagerTest::debugResourceState() {
     std::ostringstream out;
     Debug{&out} << ResourceState::Loading << ResourceState(0xbe);
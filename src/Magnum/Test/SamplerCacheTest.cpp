@@ -0,0 +1,126 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/SamplerCache.h"
+
+namespace Magnum { namespace Test {
+
+struct SamplerCacheTest: TestSuite::Tester {
+    explicit SamplerCacheTest();
+
+    void parametersDefault();
+    void parametersSetters();
+    void parametersCompare();
+
+    void construct();
+    void constructCopy();
+};
+
+SamplerCacheTest::SamplerCacheTest() {
+    addTests({&SamplerCacheTest::parametersDefault,
+              &SamplerCacheTest::parametersSetters,
+              &SamplerCacheTest::parametersCompare,
+
+              &SamplerCacheTest::construct,
+              &SamplerCacheTest::constructCopy});
+}
+
+void SamplerCacheTest::parametersDefault() {
+    const SamplerParameters parameters;
+    CORRADE_COMPARE(parameters.minificationFilter(), Sampler::Filter::Nearest);
+    CORRADE_COMPARE(parameters.minificationMipmap(), Sampler::Mipmap::Linear);
+    CORRADE_COMPARE(parameters.magnificationFilter(), Sampler::Filter::Linear);
+    CORRADE_COMPARE(parameters.minLod(), -1000.0f);
+    CORRADE_COMPARE(parameters.maxLod(), 1000.0f);
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_COMPARE(parameters.lodBias(), 0.0f);
+    #endif
+    CORRADE_VERIFY(parameters.wrapping() == Array3D<Sampler::Wrapping>{Sampler::Wrapping::Repeat});
+    #ifndef MAGNUM_TARGET_WEBGL
+    CORRADE_COMPARE(parameters.borderColor(), (Color4{0.0f, 0.0f}));
+    #endif
+    CORRADE_COMPARE(parameters.maxAnisotropy(), 1.0f);
+    CORRADE_COMPARE(parameters.compareMode(), Sampler::CompareMode::None);
+    CORRADE_COMPARE(parameters.compareFunction(), Sampler::CompareFunction::LessOrEqual);
+}
+
+void SamplerCacheTest::parametersSetters() {
+    SamplerParameters parameters;
+    parameters.setMinificationFilter(Sampler::Filter::Linear)
+        .setMagnificationFilter(Sampler::Filter::Nearest)
+        .setMinLod(-2.0f)
+        .setMaxLod(8.0f)
+        .setWrapping({Sampler::Wrapping::ClampToEdge, Sampler::Wrapping::MirroredRepeat, Sampler::Wrapping::Repeat})
+        .setMaxAnisotropy(16.0f)
+        .setCompareMode(Sampler::CompareMode::CompareRefToTexture)
+        .setCompareFunction(Sampler::CompareFunction::Greater);
+
+    CORRADE_COMPARE(parameters.minificationFilter(), Sampler::Filter::Linear);
+    CORRADE_COMPARE(parameters.minificationMipmap(), Sampler::Mipmap::Base);
+    CORRADE_COMPARE(parameters.magnificationFilter(), Sampler::Filter::Nearest);
+    CORRADE_COMPARE(parameters.minLod(), -2.0f);
+    CORRADE_COMPARE(parameters.maxLod(), 8.0f);
+    CORRADE_VERIFY(parameters.wrapping() == (Array3D<Sampler::Wrapping>{Sampler::Wrapping::ClampToEdge, Sampler::Wrapping::MirroredRepeat, Sampler::Wrapping::Repeat}));
+    CORRADE_COMPARE(parameters.maxAnisotropy(), 16.0f);
+    CORRADE_COMPARE(parameters.compareMode(), Sampler::CompareMode::CompareRefToTexture);
+    CORRADE_COMPARE(parameters.compareFunction(), Sampler::CompareFunction::Greater);
+}
+
+void SamplerCacheTest::parametersCompare() {
+    const SamplerParameters a = SamplerParameters{}
+        .setMinificationFilter(Sampler::Filter::Linear, Sampler::Mipmap::Linear)
+        .setWrapping(Sampler::Wrapping::ClampToEdge);
+    const SamplerParameters b = SamplerParameters{}
+        .setWrapping(Sampler::Wrapping::ClampToEdge)
+        .setMinificationFilter(Sampler::Filter::Linear, Sampler::Mipmap::Linear);
+    const SamplerParameters c = SamplerParameters{a}
+        .setMaxAnisotropy(4.0f);
+
+    CORRADE_VERIFY(a == b);
+    CORRADE_VERIFY(!(a != b));
+    CORRADE_COMPARE(a.hash(), b.hash());
+
+    CORRADE_VERIFY(a != c);
+    CORRADE_VERIFY(a.hash() != c.hash());
+    CORRADE_VERIFY(a != SamplerParameters{});
+}
+
+void SamplerCacheTest::construct() {
+    /* Doesn't create any GL objects, so this can be done without context */
+    const SamplerCache cache;
+    CORRADE_COMPARE(cache.size(), 0);
+}
+
+void SamplerCacheTest::constructCopy() {
+    CORRADE_VERIFY(!(std::is_constructible<SamplerCache, const SamplerCache&>{}));
+    CORRADE_VERIFY(!(std::is_assignable<SamplerCache, const SamplerCache&>{}));
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<SamplerCache>{});
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::SamplerCacheTest)
@@ -0,0 +1,256 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/SamplerCache.h"
+
+namespace Magnum { namespace Test {
+
+struct SamplerGLTest: OpenGLTester {
+    explicit SamplerGLTest();
+
+    void construct();
+    void constructCopy();
+    void constructMove();
+    void wrap();
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    void label();
+    #endif
+
+    void bind();
+    void bindMulti();
+
+    void parameters();
+
+    void cache();
+};
+
+SamplerGLTest::SamplerGLTest() {
+    addTests({&SamplerGLTest::construct,
+              &SamplerGLTest::constructCopy,
+              &SamplerGLTest::constructMove,
+              &SamplerGLTest::wrap,
+
+              #ifndef MAGNUM_TARGET_WEBGL
+              &SamplerGLTest::label,
+              #endif
+
+              &SamplerGLTest::bind,
+              &SamplerGLTest::bindMulti,
+
+              &SamplerGLTest::parameters,
+
+              &SamplerGLTest::cache});
+}
+
+#ifndef MAGNUM_TARGET_GLES
+#define SKIP_IF_NOT_SUPPORTED()                                             \
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sampler_objects>()) \
+        CORRADE_SKIP(Extensions::GL::ARB::sampler_objects::string() + std::string(" is not available."))
+#else
+#define SKIP_IF_NOT_SUPPORTED() do {} while(false)
+#endif
+
+void SamplerGLTest::construct() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    {
+        const Sampler sampler;
+
+        MAGNUM_VERIFY_NO_ERROR();
+        CORRADE_VERIFY(sampler.id() > 0);
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void SamplerGLTest::constructCopy() {
+    CORRADE_VERIFY(!(std::is_constructible<Sampler, const Sampler&>{}));
+    CORRADE_VERIFY(!(std::is_assignable<Sampler, const Sampler&>{}));
+}
+
+void SamplerGLTest::constructMove() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    Sampler a;
+    const Int id = a.id();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(id > 0);
+
+    Sampler b(std::move(a));
+
+    CORRADE_COMPARE(a.id(), 0);
+    CORRADE_COMPARE(b.id(), id);
+
+    Sampler c;
+    const Int cId = c.id();
+    c = std::move(b);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(cId > 0);
+    CORRADE_COMPARE(b.id(), cId);
+    CORRADE_COMPARE(c.id(), id);
+}
+
+void SamplerGLTest::wrap() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    GLuint id;
+    glGenSamplers(1, &id);
+
+    /* Releasing won't delete anything */
+    {
+        auto sampler = Sampler::wrap(id, ObjectFlag::DeleteOnDestruction);
+        CORRADE_COMPARE(sampler.release(), id);
+    }
+
+    /* ...so we can wrap it again */
+    Sampler::wrap(id);
+    glDeleteSamplers(1, &id);
+}
+
+#ifndef MAGNUM_TARGET_WEBGL
+void SamplerGLTest::label() {
+    SKIP_IF_NOT_SUPPORTED();
+    if(!Context::current().isExtensionSupported<Extensions::GL::KHR::debug>() &&
+       !Context::current().isExtensionSupported<Extensions::GL::EXT::debug_label>())
+        CORRADE_SKIP("Required extension is not available");
+
+    Sampler sampler;
+
+    CORRADE_COMPARE(sampler.label(), "");
+    MAGNUM_VERIFY_NO_ERROR();
+
+    sampler.setLabel("MySampler");
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE(sampler.label(), "MySampler");
+}
+#endif
+
+void SamplerGLTest::bind() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    Sampler sampler;
+    sampler.bind(15);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    GLint bound;
+    glActiveTexture(GL_TEXTURE15);
+    glGetIntegerv(GL_SAMPLER_BINDING, &bound);
+    CORRADE_COMPARE(bound, sampler.id());
+
+    Sampler::unbind(15);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    glGetIntegerv(GL_SAMPLER_BINDING, &bound);
+    CORRADE_COMPARE(bound, 0);
+}
+
+void SamplerGLTest::bindMulti() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    Sampler sampler1, sampler2;
+    Sampler::bind(7, {&sampler1, nullptr, &sampler2});
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    GLint bound;
+    glActiveTexture(GL_TEXTURE9);
+    glGetIntegerv(GL_SAMPLER_BINDING, &bound);
+    CORRADE_COMPARE(bound, sampler2.id());
+
+    Sampler::unbind(7, 3);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    glGetIntegerv(GL_SAMPLER_BINDING, &bound);
+    CORRADE_COMPARE(bound, 0);
+}
+
+void SamplerGLTest::parameters() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    Sampler sampler;
+    sampler.setMinificationFilter(Sampler::Filter::Linear, Sampler::Mipmap::Linear)
+        .setMagnificationFilter(Sampler::Filter::Linear)
+        .setMinLod(-750.0f)
+        .setMaxLod(750.0f)
+        #ifndef MAGNUM_TARGET_GLES
+        .setLodBias(0.5f)
+        #endif
+        .setWrapping(Sampler::Wrapping::ClampToEdge)
+        .setMaxAnisotropy(Sampler::maxMaxAnisotropy())
+        .setCompareMode(Sampler::CompareMode::CompareRefToTexture)
+        .setCompareFunction(Sampler::CompareFunction::GreaterOrEqual);
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    GLint value;
+    glGetSamplerParameteriv(sampler.id(), GL_TEXTURE_MIN_FILTER, &value);
+    CORRADE_COMPARE(value, GL_LINEAR_MIPMAP_LINEAR);
+    glGetSamplerParameteriv(sampler.id(), GL_TEXTURE_WRAP_R, &value);
+    CORRADE_COMPARE(value, GL_CLAMP_TO_EDGE);
+    glGetSamplerParameteriv(sampler.id(), GL_TEXTURE_COMPARE_FUNC, &value);
+    CORRADE_COMPARE(value, GL_GEQUAL);
+}
+
+void SamplerGLTest::cache() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    SamplerCache cache;
+    Sampler& a = cache.get(SamplerParameters{}
+        .setMinificationFilter(Sampler::Filter::Linear)
+        .setWrapping(Sampler::Wrapping::ClampToEdge));
+    Sampler& b = cache.get(SamplerParameters{}
+        .setMinificationFilter(Sampler::Filter::Nearest));
+    Sampler& c = cache.get(SamplerParameters{}
+        .setWrapping(Sampler::Wrapping::ClampToEdge)
+        .setMinificationFilter(Sampler::Filter::Linear));
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(cache.size(), 2);
+    CORRADE_COMPARE(&a, &c);
+    CORRADE_VERIFY(a.id() != b.id());
+
+    GLint value;
+    glGetSamplerParameteriv(a.id(), GL_TEXTURE_WRAP_S, &value);
+    CORRADE_COMPARE(value, GL_CLAMP_TO_EDGE);
+
+    cache.clear();
+    CORRADE_COMPARE(cache.size(), 0);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::SamplerGLTest)
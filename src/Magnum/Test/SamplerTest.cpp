@@ -33,6 +33,10 @@ namespace Magnum { namespace Test {
 struct SamplerTest: TestSuite::Tester {
     explicit SamplerTest();
 
+    #ifndef MAGNUM_TARGET_GLES2
+    void constructNoCreate();
+    #endif
+
     void debugFilter();
     void debugMipmap();
     void debugWrapping();
@@ -46,7 +50,12 @@ struct SamplerTest: TestSuite::Tester {
 };
 
 SamplerTest::SamplerTest() {
-    addTests({&SamplerTest::debugFilter,
+    addTests({
+              #ifndef MAGNUM_TARGET_GLES2
+              &SamplerTest::constructNoCreate,
+              #endif
+
+              &SamplerTest::debugFilter,
               &SamplerTest::debugMipmap,
               &SamplerTest::debugWrapping,
               #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
@@ -59,6 +68,17 @@ SamplerTest::SamplerTest() {
              });
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void SamplerTest::constructNoCreate() {
+    {
+        Sampler sampler{NoCreate};
+        CORRADE_COMPARE(sampler.id(), 0);
+    }
+
+    CORRADE_VERIFY(true);
+}
+#endif
+
 void SamplerTest::debugFilter() {
     std::ostringstream out;
 
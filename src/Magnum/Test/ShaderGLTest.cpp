@@ -49,6 +49,13 @@ struct ShaderGLTest: OpenGLTester {
     void addFile();
     void compile();
     void compileNoVersion();
+    void compileAsync();
+
+    #ifndef MAGNUM_TARGET_GLES
+    void spirv();
+    void spirvFile();
+    void spirvSpecializationConstant();
+    #endif
 };
 
 ShaderGLTest::ShaderGLTest() {
@@ -63,7 +70,15 @@ ShaderGLTest::ShaderGLTest() {
               &ShaderGLTest::addSourceNoVersion,
               &ShaderGLTest::addFile,
               &ShaderGLTest::compile,
-              &ShaderGLTest::compileNoVersion});
+              &ShaderGLTest::compileNoVersion,
+              &ShaderGLTest::compileAsync,
+
+              #ifndef MAGNUM_TARGET_GLES
+              &ShaderGLTest::spirv,
+              &ShaderGLTest::spirvFile,
+              &ShaderGLTest::spirvSpecializationConstant
+              #endif
+              });
 }
 
 void ShaderGLTest::construct() {
@@ -279,6 +294,117 @@ void ShaderGLTest::compileNoVersion() {
     CORRADE_VERIFY(shader.compile());
 }
 
+void ShaderGLTest::compileAsync() {
+    #ifndef MAGNUM_TARGET_GLES
+    constexpr Version v =
+        #ifndef CORRADE_TARGET_APPLE
+        Version::GL210
+        #else
+        Version::GL310
+        #endif
+        ;
+    #else
+    constexpr Version v = Version::GLES200;
+    #endif
+
+    Shader shader(v, Shader::Type::Fragment);
+    shader.addSource("void main() {}\n");
+    Shader shader2(v, Shader::Type::Fragment);
+    shader2.addSource("[fu] bleh error #:! stuff\n");
+
+    CORRADE_VERIFY(Shader::submitCompile({shader, shader2}));
+
+    /* Not blocking, so just verify it doesn't explode */
+    shader.isCompileFinished();
+
+    CORRADE_VERIFY(Shader::checkCompile({shader}));
+    CORRADE_VERIFY(shader.isCompileFinished());
+    CORRADE_VERIFY(!Shader::checkCompile({shader2}));
+}
+
+#ifndef MAGNUM_TARGET_GLES
+namespace {
+    /* Empty fragment shader entry point "main", the same as shader.spv */
+    constexpr UnsignedInt EmptyFragmentSpirv[]{
+        0x07230203, 0x00010000, 0, 5, 0,
+        0x00020011, 1,                          /* OpCapability Shader */
+        0x0003000e, 0, 1,                       /* OpMemoryModel Logical GLSL450 */
+        0x0005000f, 4, 1, 0x6e69616d, 0,        /* OpEntryPoint Fragment %1 "main" */
+        0x00030010, 1, 8,                       /* OpExecutionMode %1 OriginLowerLeft */
+        0x00020013, 2,                          /* %2 = OpTypeVoid */
+        0x00030021, 3, 2,                       /* %3 = OpTypeFunction %2 */
+        0x00050036, 2, 1, 0, 3,                 /* %1 = OpFunction %2 None %3 */
+        0x000200f8, 4,                          /* %4 = OpLabel */
+        0x000100fd,                             /* OpReturn */
+        0x00010038                              /* OpFunctionEnd */
+    };
+
+    /* Like above, but with an unused uint constant with ID 0 and a float
+       constant with ID 1 */
+    constexpr UnsignedInt SpecializationConstantFragmentSpirv[]{
+        0x07230203, 0x00010000, 0, 9, 0,
+        0x00020011, 1,                          /* OpCapability Shader */
+        0x0003000e, 0, 1,                       /* OpMemoryModel Logical GLSL450 */
+        0x0005000f, 4, 1, 0x6e69616d, 0,        /* OpEntryPoint Fragment %1 "main" */
+        0x00030010, 1, 8,                       /* OpExecutionMode %1 OriginLowerLeft */
+        0x00040047, 6, 1, 0,                    /* OpDecorate %6 SpecId 0 */
+        0x00040047, 8, 1, 1,                    /* OpDecorate %8 SpecId 1 */
+        0x00020013, 2,                          /* %2 = OpTypeVoid */
+        0x00030021, 3, 2,                       /* %3 = OpTypeFunction %2 */
+        0x00040015, 5, 32, 0,                   /* %5 = OpTypeInt 32 0 */
+        0x00040032, 5, 6, 3,                    /* %6 = OpSpecConstant %5 3 */
+        0x00030016, 7, 32,                      /* %7 = OpTypeFloat 32 */
+        0x00040032, 7, 8, 0x3f800000,           /* %8 = OpSpecConstant %7 1.0 */
+        0x00050036, 2, 1, 0, 3,                 /* %1 = OpFunction %2 None %3 */
+        0x000200f8, 4,                          /* %4 = OpLabel */
+        0x000100fd,                             /* OpReturn */
+        0x00010038                              /* OpFunctionEnd */
+    };
+}
+
+void ShaderGLTest::spirv() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::gl_spirv>())
+        CORRADE_SKIP(Extensions::GL::ARB::gl_spirv::string() + std::string(" is not supported."));
+
+    Shader shader(Version::GL330, Shader::Type::Fragment);
+    CORRADE_VERIFY(!shader.isSpirv());
+
+    shader.setSpirv(EmptyFragmentSpirv);
+    CORRADE_VERIFY(shader.isSpirv());
+    CORRADE_VERIFY(shader.compile());
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void ShaderGLTest::spirvFile() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::gl_spirv>())
+        CORRADE_SKIP(Extensions::GL::ARB::gl_spirv::string() + std::string(" is not supported."));
+
+    Shader shader(Version::None, Shader::Type::Fragment);
+    shader.setSpirvFile(Utility::Directory::join(SHADERGLTEST_FILES_DIR, "shader.spv"));
+    CORRADE_VERIFY(shader.isSpirv());
+    CORRADE_VERIFY(shader.compile());
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void ShaderGLTest::spirvSpecializationConstant() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::gl_spirv>())
+        CORRADE_SKIP(Extensions::GL::ARB::gl_spirv::string() + std::string(" is not supported."));
+
+    /* Setting the first constant again overwrites the previous value, so
+       it's passed to the driver just once */
+    Shader shader(Version::None, Shader::Type::Fragment);
+    shader.setSpirv(SpecializationConstantFragmentSpirv)
+        .setSpecializationConstant(0, 5u)
+        .setSpecializationConstant(1, 0.5f)
+        .setSpecializationConstant(0, 4u);
+    CORRADE_VERIFY(Shader::compile({shader}));
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+#endif
+
 }}
 
 CORRADE_TEST_MAIN(Magnum::Test::ShaderGLTest)
@@ -0,0 +1,226 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <ctime>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/Shader.h"
+#include "Magnum/ShaderProgramBinaryCache.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Test {
+
+struct ShaderProgramBinaryCacheGLTest: OpenGLTester {
+    explicit ShaderProgramBinaryCacheGLTest();
+
+    void construct();
+    void current();
+
+    void key();
+    void compileAndLink();
+    void compileAndLinkNoCache();
+    void loadInvalid();
+};
+
+ShaderProgramBinaryCacheGLTest::ShaderProgramBinaryCacheGLTest() {
+    addTests({&ShaderProgramBinaryCacheGLTest::construct,
+              &ShaderProgramBinaryCacheGLTest::current,
+
+              &ShaderProgramBinaryCacheGLTest::key,
+              &ShaderProgramBinaryCacheGLTest::compileAndLink,
+              &ShaderProgramBinaryCacheGLTest::compileAndLinkNoCache,
+              &ShaderProgramBinaryCacheGLTest::loadInvalid});
+}
+
+namespace {
+    #ifndef MAGNUM_TARGET_GLES
+    #ifndef CORRADE_TARGET_APPLE
+    constexpr Version ShaderVersion = Version::GL210;
+    #else
+    constexpr Version ShaderVersion = Version::GL310;
+    #endif
+    #else
+    constexpr Version ShaderVersion = Version::GLES300;
+    #endif
+
+    constexpr const char* VertexSource =
+        "#if defined(GL_ES) || __VERSION__ == 120\n"
+        "#define in attribute\n"
+        "#endif\n"
+        "in mediump vec4 position;\n"
+        "void main() { gl_Position = position; }\n";
+    constexpr const char* FragmentSource =
+        "#if !defined(GL_ES) && __VERSION__ == 120\n"
+        "#define lowp\n"
+        "#endif\n"
+        "#if defined(GL_ES) || __VERSION__ == 120\n"
+        "#define color gl_FragColor\n"
+        "#else\n"
+        "out lowp vec4 color;\n"
+        "#endif\n"
+        "void main() { color = vec4(1.0); }\n";
+
+    struct MyShader: AbstractShaderProgram {
+        explicit MyShader(const std::string& define = {}) {
+            Shader vert{ShaderVersion, Shader::Type::Vertex};
+            Shader frag{ShaderVersion, Shader::Type::Fragment};
+            vert.addSource(define).addSource(VertexSource);
+            frag.addSource(FragmentSource);
+
+            linked = compileAndLink({vert, frag}, [this]() {
+                bindAttributeLocation(0, "position");
+                ++beforeLinkCalls;
+            });
+        }
+
+        bool linked;
+        Int beforeLinkCalls{};
+    };
+
+    bool isSupported() {
+        #ifndef MAGNUM_TARGET_GLES
+        if(!Context::current().isExtensionSupported<Extensions::GL::ARB::get_program_binary>())
+            return false;
+        #endif
+
+        return ShaderProgramBinaryCache{{}}.isSupported();
+    }
+}
+
+void ShaderProgramBinaryCacheGLTest::construct() {
+    ShaderProgramBinaryCache cache{SHADERPROGRAMBINARYCACHEGLTEST_OUTPUT_DIR};
+    CORRADE_COMPARE(cache.directory(), SHADERPROGRAMBINARYCACHEGLTEST_OUTPUT_DIR);
+    CORRADE_COMPARE(cache.hitCount(), 0);
+    CORRADE_COMPARE(cache.missCount(), 0);
+}
+
+void ShaderProgramBinaryCacheGLTest::current() {
+    CORRADE_VERIFY(!ShaderProgramBinaryCache::current());
+
+    {
+        ShaderProgramBinaryCache cache{SHADERPROGRAMBINARYCACHEGLTEST_OUTPUT_DIR};
+        ShaderProgramBinaryCache::setCurrent(&cache);
+        CORRADE_COMPARE(ShaderProgramBinaryCache::current(), &cache);
+    }
+
+    /* Destroying the current cache resets it */
+    CORRADE_VERIFY(!ShaderProgramBinaryCache::current());
+}
+
+void ShaderProgramBinaryCacheGLTest::key() {
+    ShaderProgramBinaryCache cache{SHADERPROGRAMBINARYCACHEGLTEST_OUTPUT_DIR};
+
+    Shader vert{ShaderVersion, Shader::Type::Vertex};
+    Shader frag{ShaderVersion, Shader::Type::Fragment};
+    vert.addSource(VertexSource);
+    frag.addSource(FragmentSource);
+
+    Shader vertDifferent{ShaderVersion, Shader::Type::Vertex};
+    vertDifferent.addSource("#define A\n").addSource(VertexSource);
+
+    const std::string key = cache.key({vert, frag});
+    CORRADE_COMPARE(key.size(), 2*2*sizeof(std::size_t));
+    CORRADE_COMPARE(cache.key({vert, frag}), key);
+    CORRADE_VERIFY(cache.key({vertDifferent, frag}) != key);
+    CORRADE_VERIFY(cache.key({frag, vert}) != key);
+}
+
+void ShaderProgramBinaryCacheGLTest::compileAndLink() {
+    if(!isSupported())
+        CORRADE_SKIP("Program binaries are not supported.");
+
+    ShaderProgramBinaryCache cache{SHADERPROGRAMBINARYCACHEGLTEST_OUTPUT_DIR};
+    ShaderProgramBinaryCache::setCurrent(&cache);
+
+    /* Unique source so no binary from previous runs is found */
+    const std::string define = "#define RUN " + std::to_string(std::time(nullptr)) + "\n";
+
+    MyShader first{define};
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(first.linked);
+    CORRADE_COMPARE(first.beforeLinkCalls, 1);
+    CORRADE_COMPARE(cache.hitCount(), 0);
+    CORRADE_COMPARE(cache.missCount(), 1);
+
+    /* Second time it's loaded from the binary */
+    MyShader second{define};
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(second.linked);
+    CORRADE_COMPARE(second.beforeLinkCalls, 0);
+    CORRADE_COMPARE(cache.hitCount(), 1);
+    CORRADE_COMPARE(cache.missCount(), 1);
+
+    ShaderProgramBinaryCache::setCurrent(nullptr);
+}
+
+void ShaderProgramBinaryCacheGLTest::compileAndLinkNoCache() {
+    CORRADE_VERIFY(!ShaderProgramBinaryCache::current());
+
+    MyShader shader;
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(shader.linked);
+    CORRADE_COMPARE(shader.beforeLinkCalls, 1);
+}
+
+void ShaderProgramBinaryCacheGLTest::loadInvalid() {
+    if(!isSupported())
+        CORRADE_SKIP("Program binaries are not supported.");
+
+    ShaderProgramBinaryCache cache{SHADERPROGRAMBINARYCACHEGLTEST_OUTPUT_DIR};
+    ShaderProgramBinaryCache::setCurrent(&cache);
+
+    const std::string define = "#define INVALID " + std::to_string(std::time(nullptr)) + "\n";
+
+    /* Put garbage in place of the binary */
+    {
+        Shader vert{ShaderVersion, Shader::Type::Vertex};
+        Shader frag{ShaderVersion, Shader::Type::Fragment};
+        vert.addSource(define).addSource(VertexSource);
+        frag.addSource(FragmentSource);
+
+        const char garbage[]{"\x01\x00\x00\x00this is not a program binary"};
+        CORRADE_VERIFY(Utility::Directory::mkpath(SHADERPROGRAMBINARYCACHEGLTEST_OUTPUT_DIR));
+        CORRADE_VERIFY(Utility::Directory::write(Utility::Directory::join(SHADERPROGRAMBINARYCACHEGLTEST_OUTPUT_DIR, cache.key({vert, frag}) + ".bin"), garbage));
+    }
+
+    /* The binary is rejected and the shader compiled from sources instead */
+    MyShader shader{define};
+    CORRADE_VERIFY(shader.linked);
+    CORRADE_COMPARE(shader.beforeLinkCalls, 1);
+    CORRADE_COMPARE(cache.hitCount(), 0);
+    CORRADE_COMPARE(cache.missCount(), 1);
+
+    ShaderProgramBinaryCache::setCurrent(nullptr);
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::ShaderProgramBinaryCacheGLTest)
@@ -118,6 +118,7 @@ struct TextureArrayGLTest: OpenGLTester {
     void image2DBuffer();
     void subImage2D();
     void subImage2DBuffer();
+    void subImages2D();
     #ifndef MAGNUM_TARGET_GLES
     void subImage2DQuery();
     void subImage2DQueryBuffer();
@@ -331,6 +332,8 @@ TextureArrayGLTest::TextureArrayGLTest() {
         #endif
         }, PixelStorage2DDataCount);
 
+    addTests({&TextureArrayGLTest::subImages2D});
+
     addInstancedTests({
         &TextureArrayGLTest::compressedImage2D,
         &TextureArrayGLTest::compressedImage2DBuffer,
@@ -1149,6 +1152,46 @@ void TextureArrayGLTest::subImage2DBuffer() {
     #endif
 }
 
+namespace {
+    constexpr UnsignedByte SubImagesLayer1[]{
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+    };
+    constexpr UnsignedByte SubImagesLayer2[]{
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+        0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+    };
+}
+
+void TextureArrayGLTest::subImages2D() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::texture_array>())
+        CORRADE_SKIP(Extensions::GL::EXT::texture_array::string() + std::string(" is not supported."));
+    #endif
+
+    Texture2DArray texture;
+    texture.setImage(0, TextureFormat::RGBA8,
+        ImageView3D(PixelFormat::RGBA, PixelType::UnsignedByte, Vector3i(4), Zero2D));
+    texture.setSubImages({
+        {2, 0, Vector2i{1}, ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, Vector2i{2}, SubImagesLayer2}},
+        {1, 0, Vector2i{1}, ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, Vector2i{2}, SubImagesLayer1}}
+    });
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /** @todo How to test this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    Image3D image = texture.image(0, {PixelFormat::RGBA, PixelType::UnsignedByte});
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE(image.size(), Vector3i(4));
+    CORRADE_COMPARE_AS(Containers::arrayCast<UnsignedByte>(image.data()),
+        Containers::arrayView(SubData2DComplete),
+        TestSuite::Compare::Container);
+    #endif
+}
+
 #ifndef MAGNUM_TARGET_GLES
 void TextureArrayGLTest::subImage2DQuery() {
     setTestCaseDescription(PixelStorage2DData[testCaseInstanceId()].name);
@@ -64,6 +64,10 @@ struct TextureGLTest: OpenGLTester {
     void bind2D();
     void bind3D();
 
+    #ifndef MAGNUM_TARGET_GLES
+    void bindlessHandle2D();
+    #endif
+
     #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
     #ifndef MAGNUM_TARGET_GLES
     void bindImage1D();
@@ -414,6 +418,10 @@ TextureGLTest::TextureGLTest() {
         &TextureGLTest::bind2D,
         &TextureGLTest::bind3D,
 
+        #ifndef MAGNUM_TARGET_GLES
+        &TextureGLTest::bindlessHandle2D,
+        #endif
+
         #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
         #ifndef MAGNUM_TARGET_GLES
         &TextureGLTest::bindImage1D,
@@ -726,6 +734,32 @@ void TextureGLTest::bind3D() {
     MAGNUM_VERIFY_NO_ERROR();
 }
 
+#ifndef MAGNUM_TARGET_GLES
+void TextureGLTest::bindlessHandle2D() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::bindless_texture>())
+        CORRADE_SKIP(Extensions::GL::ARB::bindless_texture::string() + std::string(" is not supported."));
+
+    Texture2D texture;
+    texture.setStorage(1, TextureFormat::RGBA8, {4, 4});
+    CORRADE_VERIFY(!texture.isResident());
+
+    const UnsignedLong handle = texture.handle();
+    CORRADE_VERIFY(handle);
+    CORRADE_COMPARE(texture.handle(), handle);
+    CORRADE_VERIFY(!texture.isResident());
+
+    texture.makeResident();
+    CORRADE_VERIFY(texture.isResident());
+    CORRADE_VERIFY(glIsTextureHandleResidentARB(handle));
+
+    texture.makeNonResident();
+    CORRADE_VERIFY(!texture.isResident());
+    CORRADE_VERIFY(!glIsTextureHandleResidentARB(handle));
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+#endif
+
 #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
 #ifndef MAGNUM_TARGET_GLES
 void TextureGLTest::bindImage1D() {
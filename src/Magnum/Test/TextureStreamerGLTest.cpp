@@ -0,0 +1,253 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/TextureStreamer.h"
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace Test {
+
+struct TextureStreamerGLTest: OpenGLTester {
+    explicit TextureStreamerGLTest();
+
+    void construct();
+    void constructCopy();
+
+    void add();
+    void addLoaderFailed();
+    void streamIn();
+    void evictUnrequested();
+    void budget();
+    void budgetLowered();
+    void uploadBudget();
+};
+
+TextureStreamerGLTest::TextureStreamerGLTest() {
+    addTests({&TextureStreamerGLTest::construct,
+              &TextureStreamerGLTest::constructCopy,
+
+              &TextureStreamerGLTest::add,
+              &TextureStreamerGLTest::addLoaderFailed,
+              &TextureStreamerGLTest::streamIn,
+              &TextureStreamerGLTest::evictUnrequested,
+              &TextureStreamerGLTest::budget,
+              &TextureStreamerGLTest::budgetLowered,
+              &TextureStreamerGLTest::uploadBudget});
+}
+
+namespace {
+    /* 64x64 RGBA8 has seven levels, with tail size 8 the tail starts at level
+       3 and takes 8*8*4 + 4*4*4 + 2*2*4 + 1*1*4 bytes */
+    constexpr std::size_t TailBytes = 340;
+    constexpr std::size_t Level2Bytes = 16*16*4;
+    constexpr std::size_t Level1Bytes = 32*32*4;
+    constexpr std::size_t Level0Bytes = 64*64*4;
+
+    struct Loader {
+        explicit Loader(Int* loaded = nullptr, Int failingLevel = -1): loaded{loaded}, failingLevel{failingLevel} {}
+
+        Image2D operator()(Int level) const {
+            if(level == failingLevel) return Image2D{PixelFormat::RGBA, PixelType::UnsignedByte};
+            if(loaded) ++*loaded;
+
+            const Vector2i size = Math::max(Vector2i{64}/(1 << level), Vector2i{1});
+            return Image2D{PixelFormat::RGBA, PixelType::UnsignedByte, size, Containers::Array<char>{std::size_t(size.product()*4)}};
+        }
+
+        Int* loaded;
+        Int failingLevel;
+    };
+}
+
+void TextureStreamerGLTest::construct() {
+    {
+        TextureStreamer streamer{1024};
+
+        MAGNUM_VERIFY_NO_ERROR();
+        CORRADE_COMPARE(streamer.budget(), 1024);
+        CORRADE_COMPARE(streamer.uploadBudget(), 0);
+        CORRADE_COMPARE(streamer.fullResolutionDistance(), 1.0f);
+        CORRADE_COMPARE(streamer.textureCount(), 0);
+        CORRADE_COMPARE(streamer.residentBytes(), 0);
+        CORRADE_COMPARE(streamer.requestedBytes(), 0);
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void TextureStreamerGLTest::constructCopy() {
+    CORRADE_VERIFY(!(std::is_constructible<TextureStreamer, const TextureStreamer&>{}));
+    CORRADE_VERIFY(!(std::is_assignable<TextureStreamer, const TextureStreamer&>{}));
+}
+
+void TextureStreamerGLTest::add() {
+    TextureStreamer streamer{1024*1024};
+
+    Int loaded = 0;
+    const UnsignedInt id = streamer.add(TextureFormat::RGBA8, {64, 64}, Loader{&loaded}, 8);
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(id, 0);
+    CORRADE_COMPARE(streamer.textureCount(), 1);
+    CORRADE_VERIFY(streamer.texture(id).id() > 0);
+    CORRADE_COMPARE(streamer.levelCount(id), 7);
+    CORRADE_COMPARE(streamer.tailLevel(id), 3);
+    CORRADE_COMPARE(streamer.residentLevel(id), 3);
+    CORRADE_COMPARE(streamer.requestedLevel(id), 3);
+    CORRADE_COMPARE(loaded, 4);
+    CORRADE_COMPARE(streamer.residentBytes(), TailBytes);
+    CORRADE_COMPARE(streamer.requestedBytes(), TailBytes);
+
+    /* Nothing more is requested, so nothing gets loaded */
+    streamer.update();
+    CORRADE_COMPARE(loaded, 4);
+    CORRADE_COMPARE(streamer.residentLevel(id), 3);
+}
+
+void TextureStreamerGLTest::addLoaderFailed() {
+    TextureStreamer streamer{1024*1024};
+
+    Int loaded = 0;
+    const UnsignedInt id = streamer.add(TextureFormat::RGBA8, {64, 64}, Loader{&loaded, 4}, 8);
+
+    /* Only the two smallest levels got loaded */
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(loaded, 2);
+    CORRADE_COMPARE(streamer.residentLevel(id), 5);
+    CORRADE_COMPARE(streamer.residentBytes(), 2*2*4 + 1*1*4);
+}
+
+void TextureStreamerGLTest::streamIn() {
+    TextureStreamer streamer{1024*1024};
+    const UnsignedInt id = streamer.add(TextureFormat::RGBA8, {64, 64}, Loader{}, 8);
+
+    /* At distance 4 two levels are dropped */
+    streamer.setDistance(id, 4.0f);
+    CORRADE_COMPARE(streamer.requestedLevel(id), 2);
+    CORRADE_COMPARE(streamer.requestedBytes(), TailBytes + Level2Bytes);
+
+    streamer.update();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(streamer.residentLevel(id), 2);
+    CORRADE_COMPARE(streamer.residentBytes(), TailBytes + Level2Bytes);
+
+    /* Close enough to need everything */
+    streamer.setDistance(id, 0.5f).update();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(streamer.requestedLevel(id), 0);
+    CORRADE_COMPARE(streamer.residentLevel(id), 0);
+    CORRADE_COMPARE(streamer.residentBytes(), TailBytes + Level2Bytes + Level1Bytes + Level0Bytes);
+}
+
+void TextureStreamerGLTest::evictUnrequested() {
+    TextureStreamer streamer{1024*1024};
+    const UnsignedInt id = streamer.add(TextureFormat::RGBA8, {64, 64}, Loader{}, 8);
+
+    streamer.setDistance(id, 0.0f).update();
+    CORRADE_COMPARE(streamer.residentLevel(id), 0);
+
+    streamer.setDistance(id, 4.0f).update();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(streamer.residentLevel(id), 2);
+    CORRADE_COMPARE(streamer.residentBytes(), TailBytes + Level2Bytes);
+
+    /* The tail is never evicted */
+    streamer.setDistance(id, Constants::inf()).update();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(streamer.residentLevel(id), 3);
+    CORRADE_COMPARE(streamer.residentBytes(), TailBytes);
+}
+
+void TextureStreamerGLTest::budget() {
+    /* Enough for both tails and the first two levels of one texture */
+    TextureStreamer streamer{2*TailBytes + Level2Bytes + Level1Bytes};
+    const UnsignedInt a = streamer.add(TextureFormat::RGBA8, {64, 64}, Loader{}, 8);
+    const UnsignedInt b = streamer.add(TextureFormat::RGBA8, {64, 64}, Loader{}, 8);
+
+    /* The closer one gets the memory */
+    streamer.setDistance(a, 0.0f)
+        .setDistance(b, 2.0f)
+        .update();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(streamer.residentLevel(a), 1);
+    CORRADE_COMPARE(streamer.residentLevel(b), 3);
+    CORRADE_COMPARE(streamer.residentBytes(), 2*TailBytes + Level2Bytes + Level1Bytes);
+    CORRADE_COMPARE(streamer.requestedBytes(), 2*TailBytes + 2*Level2Bytes + 2*Level1Bytes + Level0Bytes);
+
+    /* Raising priority of the other one evicts levels from the first */
+    streamer.setPriority(b, 100.0f).update();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(streamer.residentLevel(a), 3);
+    CORRADE_COMPARE(streamer.residentLevel(b), 1);
+    CORRADE_COMPARE(streamer.residentBytes(), 2*TailBytes + Level2Bytes + Level1Bytes);
+}
+
+void TextureStreamerGLTest::budgetLowered() {
+    TextureStreamer streamer{1024*1024};
+    const UnsignedInt id = streamer.add(TextureFormat::RGBA8, {64, 64}, Loader{}, 8);
+
+    streamer.setDistance(id, 0.0f).update();
+    CORRADE_COMPARE(streamer.residentLevel(id), 0);
+
+    streamer.setBudget(TailBytes + Level2Bytes).update();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(streamer.residentLevel(id), 2);
+    CORRADE_COMPARE(streamer.residentBytes(), TailBytes + Level2Bytes);
+
+    /* Budget smaller than the tail, the tail stays */
+    streamer.setBudget(0).update();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(streamer.residentLevel(id), 3);
+    CORRADE_COMPARE(streamer.residentBytes(), TailBytes);
+}
+
+void TextureStreamerGLTest::uploadBudget() {
+    TextureStreamer streamer{1024*1024};
+    streamer.setUploadBudget(Level2Bytes + Level1Bytes);
+
+    Int loaded = 0;
+    const UnsignedInt id = streamer.add(TextureFormat::RGBA8, {64, 64}, Loader{&loaded}, 8);
+    streamer.setDistance(id, 0.0f);
+    loaded = 0;
+
+    streamer.update();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(loaded, 2);
+    CORRADE_COMPARE(streamer.residentLevel(id), 1);
+
+    /* The last level is larger than the budget but still gets uploaded */
+    streamer.update();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(loaded, 3);
+    CORRADE_COMPARE(streamer.residentLevel(id), 0);
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::TextureStreamerGLTest)
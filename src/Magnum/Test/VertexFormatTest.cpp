@@ -0,0 +1,108 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/VertexFormat.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Math/Matrix3.h"
+
+namespace Magnum { namespace Test {
+
+struct VertexFormatTest: TestSuite::Tester {
+    explicit VertexFormatTest();
+
+    void construct();
+    void addVertexBuffer();
+    void addVertexBufferGaps();
+    void addVertexBufferInstanced();
+    void addVertexBufferSparse();
+};
+
+VertexFormatTest::VertexFormatTest() {
+    addTests({&VertexFormatTest::construct,
+              &VertexFormatTest::addVertexBuffer,
+              &VertexFormatTest::addVertexBufferGaps,
+              &VertexFormatTest::addVertexBufferInstanced,
+              &VertexFormatTest::addVertexBufferSparse});
+}
+
+typedef Attribute<0, Vector3> Position;
+typedef Attribute<1, Vector2> TextureCoordinates;
+typedef Attribute<2, Matrix3> Transformation;
+
+void VertexFormatTest::construct() {
+    {
+        VertexFormat format;
+        CORRADE_COMPARE(format.id(), 0);
+        CORRADE_COMPARE(format.bindingCount(), 0);
+    }
+
+    CORRADE_VERIFY(true);
+}
+
+void VertexFormatTest::addVertexBuffer() {
+    VertexFormat format;
+    format.addVertexBuffer(0, Position{}, TextureCoordinates{});
+
+    CORRADE_COMPARE(format.id(), 0);
+    CORRADE_COMPARE(format.bindingCount(), 1);
+    CORRADE_COMPARE(format.stride(0), 20);
+    CORRADE_COMPARE(format.divisor(0), 0);
+}
+
+void VertexFormatTest::addVertexBufferGaps() {
+    VertexFormat format;
+    format.addVertexBuffer(0, 4, Position{}, 8, TextureCoordinates{}, 4);
+
+    CORRADE_COMPARE(format.bindingCount(), 1);
+    CORRADE_COMPARE(format.stride(0), 36);
+}
+
+void VertexFormatTest::addVertexBufferInstanced() {
+    VertexFormat format;
+    format.addVertexBuffer(0, Position{})
+        .addVertexBufferInstanced(1, 3, Transformation{});
+
+    CORRADE_COMPARE(format.bindingCount(), 2);
+    CORRADE_COMPARE(format.stride(0), 12);
+    CORRADE_COMPARE(format.divisor(0), 0);
+    CORRADE_COMPARE(format.stride(1), 36);
+    CORRADE_COMPARE(format.divisor(1), 3);
+}
+
+void VertexFormatTest::addVertexBufferSparse() {
+    VertexFormat format;
+    format.addVertexBuffer(2, TextureCoordinates{});
+
+    CORRADE_COMPARE(format.bindingCount(), 3);
+    CORRADE_COMPARE(format.stride(0), 0);
+    CORRADE_COMPARE(format.stride(1), 0);
+    CORRADE_COMPARE(format.stride(2), 8);
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::VertexFormatTest)
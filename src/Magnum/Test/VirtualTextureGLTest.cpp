@@ -0,0 +1,272 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Image.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/VirtualTexture.h"
+#include "Magnum/Math/Range.h"
+
+namespace Magnum { namespace Test {
+
+struct VirtualTextureGLTest: OpenGLTester {
+    explicit VirtualTextureGLTest();
+
+    void feedbackId();
+
+    void construct();
+    void request();
+    void requestOutOfRange();
+    void addFeedback();
+    void pageBudget();
+    void uploadBudget();
+    void loaderFailure();
+};
+
+VirtualTextureGLTest::VirtualTextureGLTest() {
+    addTests({&VirtualTextureGLTest::feedbackId,
+
+              &VirtualTextureGLTest::construct,
+              &VirtualTextureGLTest::request,
+              &VirtualTextureGLTest::requestOutOfRange,
+              &VirtualTextureGLTest::addFeedback,
+              &VirtualTextureGLTest::pageBudget,
+              &VirtualTextureGLTest::uploadBudget,
+              &VirtualTextureGLTest::loaderFailure});
+}
+
+namespace {
+    Image2D loadPage(Int, const Range2Di& range) {
+        return Image2D{PixelFormat::RGBA, PixelType::UnsignedByte, range.size(),
+            Containers::Array<char>{Containers::ValueInit, std::size_t(range.size().product()*4)}};
+    }
+}
+
+void VirtualTextureGLTest::feedbackId() {
+    CORRADE_COMPARE(VirtualTexture::feedbackId(0, {}), 0);
+    CORRADE_COMPARE(VirtualTexture::feedbackId(3, {5, 7}), (3u << 28)|(7u << 14)|5u);
+    CORRADE_COMPARE(VirtualTexture::feedbackId(14, {16383, 16383}), 0xefffffffu);
+}
+
+void VirtualTextureGLTest::construct() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sparse_texture>())
+        CORRADE_SKIP(Extensions::GL::ARB::sparse_texture::string() + std::string(" is not supported."));
+
+    const Vector2i pageSize = Texture2D::pageSize(TextureFormat::RGBA8);
+    std::vector<Int> loaded;
+    {
+        VirtualTexture texture{TextureFormat::RGBA8, pageSize*4, 3, [&loaded](Int level, const Range2Di& range) {
+            loaded.push_back(level);
+            return loadPage(level, range);
+        }, 16};
+
+        MAGNUM_VERIFY_NO_ERROR();
+        CORRADE_VERIFY(texture.texture().id() > 0);
+        CORRADE_VERIFY(texture.pageTable().id() > 0);
+        CORRADE_COMPARE(texture.size(), pageSize*4);
+        CORRADE_COMPARE(texture.pageSize(), pageSize);
+        CORRADE_COMPARE(texture.levelCount(), 3);
+        CORRADE_VERIFY(texture.tailLevel() <= 3);
+        CORRADE_COMPARE(texture.pageCount(0), Vector2i{4});
+        CORRADE_COMPARE(texture.pageCount(1), Vector2i{2});
+        CORRADE_COMPARE(texture.residentPageCount(), 0);
+        CORRADE_COMPARE(texture.pageTable().imageSize(0), Vector2i{4});
+
+        /* Only the mip tail is uploaded */
+        CORRADE_COMPARE(loaded.size(), std::size_t(3 - texture.tailLevel()));
+        if(texture.tailLevel() > 0)
+            CORRADE_VERIFY(!texture.isResident(0, {}));
+        CORRADE_VERIFY(texture.isResident(2, {}) || texture.tailLevel() > 2);
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void VirtualTextureGLTest::request() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sparse_texture>())
+        CORRADE_SKIP(Extensions::GL::ARB::sparse_texture::string() + std::string(" is not supported."));
+
+    const Vector2i pageSize = Texture2D::pageSize(TextureFormat::RGBA8);
+    VirtualTexture texture{TextureFormat::RGBA8, pageSize*4, 3, loadPage, 16};
+    if(texture.tailLevel() < 2)
+        CORRADE_SKIP("Mip tail starts too early to test requests.");
+
+    texture.request(0, {3, 2})
+        .update();
+
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Parents in coarser levels are requested as well */
+    CORRADE_VERIFY(texture.isResident(0, {3, 2}));
+    CORRADE_VERIFY(texture.isResident(1, {1, 1}));
+    CORRADE_VERIFY(!texture.isResident(0, {2, 2}));
+    CORRADE_VERIFY(!texture.isResident(1, {0, 0}));
+    CORRADE_COMPARE(texture.residentPageCount(), texture.tailLevel());
+
+    /* Requesting a resident page again doesn't upload anything */
+    texture.request(0, {3, 2})
+        .update();
+    CORRADE_COMPARE(texture.residentPageCount(), texture.tailLevel());
+}
+
+void VirtualTextureGLTest::requestOutOfRange() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sparse_texture>())
+        CORRADE_SKIP(Extensions::GL::ARB::sparse_texture::string() + std::string(" is not supported."));
+
+    const Vector2i pageSize = Texture2D::pageSize(TextureFormat::RGBA8);
+    VirtualTexture texture{TextureFormat::RGBA8, pageSize*4, 3, loadPage, 16};
+
+    texture.request(0, {4, 0})
+        .request(0, {-1, 0})
+        .request(-1, {})
+        .request(3, {})
+        .update();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(texture.residentPageCount(), 0);
+}
+
+void VirtualTextureGLTest::addFeedback() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sparse_texture>())
+        CORRADE_SKIP(Extensions::GL::ARB::sparse_texture::string() + std::string(" is not supported."));
+
+    const Vector2i pageSize = Texture2D::pageSize(TextureFormat::RGBA8);
+    VirtualTexture texture{TextureFormat::RGBA8, pageSize*4, 3, loadPage, 16};
+    if(texture.tailLevel() < 1)
+        CORRADE_SKIP("The whole texture is a mip tail.");
+
+    const UnsignedInt feedback[]{
+        0xffffffffu,
+        VirtualTexture::feedbackId(0, {1, 0}),
+        VirtualTexture::feedbackId(0, {1, 0}),
+        0xffffffffu,
+        VirtualTexture::feedbackId(0, {0, 3})
+    };
+    texture.addFeedback(feedback)
+        .update();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(texture.isResident(0, {1, 0}));
+    CORRADE_VERIFY(texture.isResident(0, {0, 3}));
+    CORRADE_VERIFY(!texture.isResident(0, {0, 0}));
+}
+
+void VirtualTextureGLTest::pageBudget() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sparse_texture>())
+        CORRADE_SKIP(Extensions::GL::ARB::sparse_texture::string() + std::string(" is not supported."));
+
+    const Vector2i pageSize = Texture2D::pageSize(TextureFormat::RGBA8);
+    VirtualTexture texture{TextureFormat::RGBA8, pageSize*4, 3, loadPage, 2};
+    if(texture.tailLevel() != 1)
+        CORRADE_SKIP("Expecting only the base level to be sparse.");
+
+    texture.request(0, {0, 0})
+        .request(0, {1, 0})
+        .update();
+    CORRADE_COMPARE(texture.residentPageCount(), 2);
+
+    /* Pages used in the current frame are not evicted, so the third page
+       doesn't fit */
+    texture.request(0, {0, 0})
+        .request(0, {1, 0})
+        .request(0, {2, 0})
+        .update();
+    CORRADE_COMPARE(texture.residentPageCount(), 2);
+    CORRADE_VERIFY(!texture.isResident(0, {2, 0}));
+
+    /* The least recently requested page gets evicted */
+    texture.request(0, {1, 0})
+        .update();
+    texture.request(0, {2, 0})
+        .update();
+    CORRADE_COMPARE(texture.residentPageCount(), 2);
+    CORRADE_VERIFY(!texture.isResident(0, {0, 0}));
+    CORRADE_VERIFY(texture.isResident(0, {1, 0}));
+    CORRADE_VERIFY(texture.isResident(0, {2, 0}));
+
+    /* Lowering the budget evicts on next update */
+    texture.setPageBudget(1)
+        .update();
+    CORRADE_COMPARE(texture.pageBudget(), 1);
+    CORRADE_COMPARE(texture.residentPageCount(), 1);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void VirtualTextureGLTest::uploadBudget() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sparse_texture>())
+        CORRADE_SKIP(Extensions::GL::ARB::sparse_texture::string() + std::string(" is not supported."));
+
+    const Vector2i pageSize = Texture2D::pageSize(TextureFormat::RGBA8);
+    VirtualTexture texture{TextureFormat::RGBA8, pageSize*4, 3, loadPage, 16};
+    if(texture.tailLevel() != 1)
+        CORRADE_SKIP("Expecting only the base level to be sparse.");
+
+    texture.setUploadBudget(2);
+    CORRADE_COMPARE(texture.uploadBudget(), 2);
+
+    texture.request(0, {0, 0})
+        .request(0, {1, 0})
+        .request(0, {2, 0})
+        .update();
+    CORRADE_COMPARE(texture.residentPageCount(), 2);
+
+    /* Pages not uploaded have to be requested again */
+    texture.update();
+    CORRADE_COMPARE(texture.residentPageCount(), 2);
+    texture.request(0, {2, 0})
+        .update();
+    CORRADE_COMPARE(texture.residentPageCount(), 3);
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void VirtualTextureGLTest::loaderFailure() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::sparse_texture>())
+        CORRADE_SKIP(Extensions::GL::ARB::sparse_texture::string() + std::string(" is not supported."));
+
+    const Vector2i pageSize = Texture2D::pageSize(TextureFormat::RGBA8);
+    VirtualTexture texture{TextureFormat::RGBA8, pageSize*4, 1, [](Int, const Range2Di&) {
+        return Image2D{PixelFormat::RGBA, PixelType::UnsignedByte};
+    }, 16};
+    if(texture.tailLevel() != 1)
+        CORRADE_SKIP("Expecting the base level to be sparse.");
+
+    texture.request(0, {})
+        .update();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(!texture.isResident(0, {}));
+    CORRADE_COMPARE(texture.residentPageCount(), 0);
+}
+
+}}
+
+CORRADE_TEST_MAIN(Magnum::Test::VirtualTextureGLTest)
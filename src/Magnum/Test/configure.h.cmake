@@ -24,3 +24,4 @@
 */
 
 #define SHADERGLTEST_FILES_DIR "${CMAKE_CURRENT_SOURCE_DIR}/ShaderGLTestFiles"
+#define SHADERPROGRAMBINARYCACHEGLTEST_OUTPUT_DIR "${CMAKE_CURRENT_BINARY_DIR}/ShaderProgramBinaryCacheGLTestOutput"
@@ -25,6 +25,9 @@
 
 #include "AbstractFont.h"
 
+#include <list>
+#include <unordered_map>
+#include <vector>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/Unicode.h>
@@ -34,10 +37,60 @@
 
 namespace Magnum { namespace Text {
 
+namespace {
+
+typedef std::tuple<Range2D, Range2D, Vector2> CachedGlyph;
+
+/* Replays glyph data recorded from a plugin layouter */
+class CachedLayouter: public AbstractLayouter {
+    public:
+        explicit CachedLayouter(std::shared_ptr<const std::vector<CachedGlyph>> glyphs): AbstractLayouter(glyphs->size()), _glyphs{std::move(glyphs)} {}
+
+    private:
+        std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(const UnsignedInt i) override {
+            return (*_glyphs)[i];
+        }
+
+        std::shared_ptr<const std::vector<CachedGlyph>> _glyphs;
+};
+
+struct LayoutCacheKey {
+    const GlyphCache* cache;
+    Float size;
+    std::string text;
+
+    bool operator==(const LayoutCacheKey& other) const {
+        return cache == other.cache && size == other.size && text == other.text;
+    }
+};
+
+struct LayoutCacheKeyHash {
+    std::size_t operator()(const LayoutCacheKey& key) const {
+        std::size_t hash = std::hash<std::string>{}(key.text);
+        hash ^= std::hash<const GlyphCache*>{}(key.cache) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        hash ^= std::hash<Float>{}(key.size) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        return hash;
+    }
+};
+
+}
+
+struct AbstractFont::LayoutCache {
+    typedef std::list<std::pair<LayoutCacheKey, std::shared_ptr<const std::vector<CachedGlyph>>>> List;
+
+    std::size_t capacity{}, hits{}, misses{};
+
+    /* Most recently used entries are at the front */
+    List entries;
+    std::unordered_map<LayoutCacheKey, List::iterator, LayoutCacheKeyHash> lookup;
+};
+
 AbstractFont::AbstractFont(): _size(0.0f) {}
 
 AbstractFont::AbstractFont(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractPlugin{manager, plugin}, _size{0.0f}, _lineHeight{0.0f} {}
 
+AbstractFont::~AbstractFont() = default;
+
 bool AbstractFont::openData(const std::vector<std::pair<std::string, Containers::ArrayView<const char>>>& data, const Float size) {
     CORRADE_ASSERT(features() & Feature::OpenData,
         "Text::AbstractFont::openData(): feature not supported", false);
@@ -110,6 +163,8 @@ auto AbstractFont::doOpenFile(const std::string& filename, const Float size) ->
 }
 
 void AbstractFont::close() {
+    clearLayoutCache();
+
     if(isOpened()) {
         doClose();
         _size = 0.0f;
@@ -130,12 +185,27 @@ Vector2 AbstractFont::glyphAdvance(const UnsignedInt glyph) {
     return doGlyphAdvance(glyph);
 }
 
+Vector2 AbstractFont::glyphKerning(const UnsignedInt left, const UnsignedInt right) {
+    CORRADE_ASSERT(isOpened(), "Text::AbstractFont::glyphKerning(): no font opened", {});
+
+    if(!(features() & Feature::Kerning)) return {};
+    return doGlyphKerning(left, right);
+}
+
+Vector2 AbstractFont::doGlyphKerning(UnsignedInt, UnsignedInt) {
+    CORRADE_ASSERT(false, "Text::AbstractFont::glyphKerning(): feature advertised but not implemented", {});
+    return {};
+}
+
 void AbstractFont::fillGlyphCache(GlyphCache& cache, const std::string& characters) {
     CORRADE_ASSERT(isOpened(),
         "Text::AbstractFont::createGlyphCache(): no font opened", );
     CORRADE_ASSERT(!(features() & Feature::PreparedGlyphCache),
         "Text::AbstractFont::fillGlyphCache(): feature not supported", );
 
+    /* Texture coordinates of cached layouts might change */
+    clearLayoutCache();
+
     doFillGlyphCache(cache, Utility::Unicode::utf32(characters));
 }
 
@@ -160,7 +230,74 @@ std::unique_ptr<GlyphCache> AbstractFont::doCreateGlyphCache() {
 std::unique_ptr<AbstractLayouter> AbstractFont::layout(const GlyphCache& cache, const Float size, const std::string& text) {
     CORRADE_ASSERT(isOpened(), "Text::AbstractFont::layout(): no font opened", nullptr);
 
-    return doLayout(cache, size, text);
+    if(!_layoutCache) return doLayout(cache, size, text);
+
+    /* Cache hit, move the entry to the front */
+    LayoutCacheKey key{&cache, size, text};
+    auto found = _layoutCache->lookup.find(key);
+    if(found != _layoutCache->lookup.end()) {
+        ++_layoutCache->hits;
+        _layoutCache->entries.splice(_layoutCache->entries.begin(), _layoutCache->entries, found->second);
+        return std::unique_ptr<AbstractLayouter>{new CachedLayouter{found->second->second}};
+    }
+
+    /* Cache miss, record all glyphs from the plugin layouter */
+    ++_layoutCache->misses;
+    std::unique_ptr<AbstractLayouter> layouter = doLayout(cache, size, text);
+    if(!layouter) return layouter;
+    std::shared_ptr<std::vector<CachedGlyph>> glyphs = std::make_shared<std::vector<CachedGlyph>>();
+    glyphs->reserve(layouter->glyphCount());
+    for(UnsignedInt i = 0; i != layouter->glyphCount(); ++i)
+        glyphs->push_back(layouter->doRenderGlyph(i));
+
+    /* Evict the least recently used entry if full */
+    if(_layoutCache->entries.size() == _layoutCache->capacity) {
+        _layoutCache->lookup.erase(_layoutCache->entries.back().first);
+        _layoutCache->entries.pop_back();
+    }
+
+    _layoutCache->entries.emplace_front(key, glyphs);
+    _layoutCache->lookup.emplace(std::move(key), _layoutCache->entries.begin());
+    return std::unique_ptr<AbstractLayouter>{new CachedLayouter{std::move(glyphs)}};
+}
+
+std::size_t AbstractFont::layoutCacheCapacity() const {
+    return _layoutCache ? _layoutCache->capacity : 0;
+}
+
+void AbstractFont::setLayoutCacheCapacity(const std::size_t capacity) {
+    if(!capacity) {
+        _layoutCache = nullptr;
+        return;
+    }
+
+    if(!_layoutCache) _layoutCache.reset(new LayoutCache);
+    _layoutCache->capacity = capacity;
+
+    /* Evict least recently used entries that don't fit anymore */
+    while(_layoutCache->entries.size() > capacity) {
+        _layoutCache->lookup.erase(_layoutCache->entries.back().first);
+        _layoutCache->entries.pop_back();
+    }
+}
+
+std::size_t AbstractFont::layoutCacheSize() const {
+    return _layoutCache ? _layoutCache->entries.size() : 0;
+}
+
+std::size_t AbstractFont::layoutCacheHits() const {
+    return _layoutCache ? _layoutCache->hits : 0;
+}
+
+std::size_t AbstractFont::layoutCacheMisses() const {
+    return _layoutCache ? _layoutCache->misses : 0;
+}
+
+void AbstractFont::clearLayoutCache() {
+    if(!_layoutCache) return;
+
+    _layoutCache->entries.clear();
+    _layoutCache->lookup.clear();
 }
 
 AbstractLayouter::AbstractLayouter(UnsignedInt glyphCount): _glyphCount(glyphCount) {}
@@ -53,13 +53,15 @@ namespace for available font plugins.
 First step is to open the font using @ref openData(), @ref openSingleData() or
 @ref openFile(). Next step is to prerender all the glyphs which will be used in
 text rendering later, see @ref GlyphCache for more information. See
-@ref Renderer for information about text rendering.
+@ref Renderer for information about text rendering and @ref TextLayout for
+multi-line text with line wrapping and multiple styles.
 
 ## Subclassing
 
 Plugin implements @ref doFeatures(), @ref doClose(), @ref doLayout(), either
 @ref doCreateGlyphCache() or @ref doFillGlyphCache() and one or more of
-`doOpen*()` functions. See also @ref AbstractLayouter for more information.
+`doOpen*()` functions. Fonts advertising @ref Feature::Kerning implement also
+@ref doGlyphKerning(). See also @ref AbstractLayouter for more information.
 
 You don't need to do most of the redundant sanity checks, these things are
 checked by the implementation:
@@ -72,10 +74,10 @@ checked by the implementation:
 -   All `do*()` implementations working on opened file are called only if
     there is any file opened.
 
-Plugin interface string is `"cz.mosra.magnum.Text.AbstractFont/0.2.4"`.
+Plugin interface string is `"cz.mosra.magnum.Text.AbstractFont/0.2.5"`.
 */
 class MAGNUM_TEXT_EXPORT AbstractFont: public PluginManager::AbstractPlugin {
-    CORRADE_PLUGIN_INTERFACE("cz.mosra.magnum.Text.AbstractFont/0.2.4")
+    CORRADE_PLUGIN_INTERFACE("cz.mosra.magnum.Text.AbstractFont/0.2.5")
 
     public:
         /**
@@ -98,7 +100,14 @@ class MAGNUM_TEXT_EXPORT AbstractFont: public PluginManager::AbstractPlugin {
              *
              * @see @ref fillGlyphCache(), @ref createGlyphCache()
              */
-            PreparedGlyphCache = 1 << 2
+            PreparedGlyphCache = 1 << 2,
+
+            /**
+             * The font provides kerning information.
+             *
+             * @see @ref glyphKerning()
+             */
+            Kerning = 1 << 3
         };
 
         /** @brief Set of features supported by this importer */
@@ -110,6 +119,8 @@ class MAGNUM_TEXT_EXPORT AbstractFont: public PluginManager::AbstractPlugin {
         /** @brief Plugin manager constructor */
         explicit AbstractFont(PluginManager::AbstractManager& manager, const std::string& plugin);
 
+        ~AbstractFont();
+
         /** @brief Features supported by this font */
         Features features() const { return doFeatures(); }
 
@@ -209,6 +220,18 @@ class MAGNUM_TEXT_EXPORT AbstractFont: public PluginManager::AbstractPlugin {
          */
         Vector2 glyphAdvance(UnsignedInt glyph);
 
+        /**
+         * @brief Kerning between two glyphs
+         * @param left      Glyph ID of the left glyph
+         * @param right     Glyph ID of the right glyph
+         *
+         * Returns adjustment of the advance between given pair of glyphs,
+         * scaled to font size, in the same way as @ref glyphAdvance(). If the
+         * font doesn't support @ref Feature::Kerning, returns zero vector.
+         * @see @ref glyphId(), @ref TextLayout
+         */
+        Vector2 glyphKerning(UnsignedInt left, UnsignedInt right);
+
         /**
          * @brief Fill glyph cache with given character set
          * @param cache         Glyph cache instance
@@ -238,10 +261,66 @@ class MAGNUM_TEXT_EXPORT AbstractFont: public PluginManager::AbstractPlugin {
          *
          * Note that the layouters support rendering of single-line text only.
          * See @ref Renderer class for more advanced text layouting.
+         *
+         * If layout cache is enabled using @ref setLayoutCacheCapacity() and
+         * the same text was laid out with the same @p cache and @p size
+         * before, the returned layouter replays the cached glyph data without
+         * calling into the plugin.
          * @see @ref fillGlyphCache(), @ref createGlyphCache()
          */
         std::unique_ptr<AbstractLayouter> layout(const GlyphCache& cache, Float size, const std::string& text);
 
+        /**
+         * @brief Layout cache capacity
+         *
+         * @see @ref setLayoutCacheCapacity(), @ref layoutCacheSize()
+         */
+        std::size_t layoutCacheCapacity() const;
+
+        /**
+         * @brief Set layout cache capacity
+         *
+         * Maximal count of distinct laid out texts remembered by @ref layout().
+         * When the capacity is exceeded, the least recently used layout is
+         * evicted. Setting the capacity to @cpp 0 @ce disables the cache,
+         * discards all cached layouts and resets the hit and miss counters.
+         * Initially the cache is disabled.
+         *
+         * The cache is keyed by the text, font size and glyph cache instance.
+         * It is cleared automatically in @ref fillGlyphCache() and
+         * @ref close(), but you need to call @ref clearLayoutCache() manually
+         * when modifying the glyph cache contents by other means.
+         */
+        void setLayoutCacheCapacity(std::size_t capacity);
+
+        /**
+         * @brief Count of layouts currently in the cache
+         *
+         * @see @ref layoutCacheCapacity()
+         */
+        std::size_t layoutCacheSize() const;
+
+        /**
+         * @brief Count of layout cache hits
+         *
+         * @see @ref layoutCacheMisses(), @ref setLayoutCacheCapacity()
+         */
+        std::size_t layoutCacheHits() const;
+
+        /**
+         * @brief Count of layout cache misses
+         *
+         * @see @ref layoutCacheHits(), @ref setLayoutCacheCapacity()
+         */
+        std::size_t layoutCacheMisses() const;
+
+        /**
+         * @brief Discard all cached layouts
+         *
+         * Hit and miss counters are kept.
+         */
+        void clearLayoutCache();
+
     protected:
         /**
          * @brief Font metrics
@@ -321,6 +400,13 @@ class MAGNUM_TEXT_EXPORT AbstractFont: public PluginManager::AbstractPlugin {
         /** @brief Implementation for @ref glyphAdvance() */
         virtual Vector2 doGlyphAdvance(UnsignedInt glyph) = 0;
 
+        /**
+         * @brief Implementation for @ref glyphKerning()
+         *
+         * Called only if @ref Feature::Kerning is supported.
+         */
+        virtual Vector2 doGlyphKerning(UnsignedInt left, UnsignedInt right);
+
         /**
          * @brief Implementation for @ref fillGlyphCache()
          *
@@ -338,7 +424,10 @@ class MAGNUM_TEXT_EXPORT AbstractFont: public PluginManager::AbstractPlugin {
     #ifdef DOXYGEN_GENERATING_OUTPUT
     private:
     #endif
+        struct LayoutCache;
+
         Float _size, _ascent, _descent, _lineHeight;
+        std::unique_ptr<LayoutCache> _layoutCache;
 };
 
 CORRADE_ENUMSET_OPERATORS(AbstractFont::Features)
@@ -409,6 +498,9 @@ class MAGNUM_TEXT_EXPORT AbstractLayouter {
     #ifdef DOXYGEN_GENERATING_OUTPUT
     private:
     #endif
+        /* Records the glyph data for the layout cache */
+        friend class AbstractFont;
+
         UnsignedInt _glyphCount;
 };
 
@@ -0,0 +1,286 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BatchRenderer.h"
+
+#include <algorithm>
+
+#include "Magnum/AbstractShaderProgram.h"
+#include "Magnum/Math/Packing.h"
+#include "Magnum/Shaders/DistanceFieldVector.h"
+#include "Magnum/Text/Implementation/GlyphQuads.h"
+
+namespace Magnum { namespace Text {
+
+namespace {
+
+inline Vector2 transformPosition(const Matrix3& transformation, const Vector2& position) {
+    return transformation.transformPoint(position);
+}
+
+inline Vector3 transformPosition(const Matrix4& transformation, const Vector2& position) {
+    return transformation.transformPoint(Vector3{position, 0.0f});
+}
+
+}
+
+template<UnsignedInt dimensions> struct BatchRenderer<dimensions>::Vertex {
+    VectorTypeFor<dimensions, Float> position;
+    Vector2 textureCoordinates;
+    Color4ub color;
+};
+
+template<UnsignedInt dimensions> struct BatchRenderer<dimensions>::Entry {
+    std::vector<Implementation::GlyphQuad> quads;
+    MatrixTypeFor<dimensions, Float> transformation;
+    Color4ub color;
+    Alignment alignment;
+    Range2D rectangle;
+
+    /* Range of glyph quads in the vertex data, capacity can be larger than
+       quad count */
+    UnsignedInt offset, capacity;
+    bool used;
+};
+
+template<UnsignedInt dimensions> BatchRenderer<dimensions>::BatchRenderer(AbstractFont& font, const GlyphCache& cache, const Float size): _font(font), _cache(cache), _size(size), _vertexBuffer{Buffer::TargetHint::Array}, _indexBuffer{Buffer::TargetHint::ElementArray} {
+    typedef Shaders::DistanceFieldVector<dimensions> Shader;
+    _mesh.setPrimitive(MeshPrimitive::Triangles)
+        .addVertexBuffer(_vertexBuffer, 0,
+            typename Shader::Position{},
+            typename Shader::TextureCoordinates{},
+            typename Shader::Color{Shader::Color::Components::Four, Shader::Color::DataType::UnsignedByte, Shader::Color::DataOption::Normalized});
+}
+
+template<UnsignedInt dimensions> BatchRenderer<dimensions>::~BatchRenderer() = default;
+
+template<UnsignedInt dimensions> std::size_t BatchRenderer<dimensions>::textCount() const {
+    return _texts.size() - _freeIds.size();
+}
+
+template<UnsignedInt dimensions> auto BatchRenderer<dimensions>::entry(const UnsignedInt id, const char* const function) -> Entry& {
+    CORRADE_ASSERT(id < _texts.size() && _texts[id].used,
+        "Text::BatchRenderer::" << Debug::nospace << function << Debug::nospace << "(): invalid text ID" << id, _texts.front());
+    #ifdef CORRADE_NO_ASSERT
+    static_cast<void>(function);
+    #endif
+    return _texts[id];
+}
+
+template<UnsignedInt dimensions> UnsignedInt BatchRenderer<dimensions>::add(const std::string& text, const MatrixTypeFor<dimensions, Float>& transformation, const Color4& color, const Alignment alignment) {
+    /* Reuse a free ID, if any */
+    UnsignedInt id;
+    if(!_freeIds.empty()) {
+        id = _freeIds.back();
+        _freeIds.pop_back();
+    } else {
+        id = _texts.size();
+        _texts.emplace_back();
+    }
+
+    Entry& e = _texts[id];
+    e.transformation = transformation;
+    e.color = Math::pack<Color4ub>(color);
+    e.alignment = alignment;
+    e.rectangle = Implementation::renderGlyphQuads(_font, _cache, _size, text, alignment, e.quads);
+    e.used = true;
+    _glyphCount += e.quads.size();
+
+    allocate(e);
+    fill(e);
+    return id;
+}
+
+template<UnsignedInt dimensions> void BatchRenderer<dimensions>::setText(const UnsignedInt id, const std::string& text) {
+    Entry& e = entry(id, "setText");
+    _glyphCount -= e.quads.size();
+    e.rectangle = Implementation::renderGlyphQuads(_font, _cache, _size, text, e.alignment, e.quads);
+    _glyphCount += e.quads.size();
+
+    /* Doesn't fit into the original range anymore, move it elsewhere */
+    if(e.quads.size() > e.capacity) {
+        release(e.offset, e.capacity);
+        allocate(e);
+    }
+
+    fill(e);
+}
+
+template<UnsignedInt dimensions> void BatchRenderer<dimensions>::setTransformation(const UnsignedInt id, const MatrixTypeFor<dimensions, Float>& transformation) {
+    Entry& e = entry(id, "setTransformation");
+    e.transformation = transformation;
+    fill(e);
+}
+
+template<UnsignedInt dimensions> void BatchRenderer<dimensions>::setColor(const UnsignedInt id, const Color4& color) {
+    Entry& e = entry(id, "setColor");
+    e.color = Math::pack<Color4ub>(color);
+    fill(e);
+}
+
+template<UnsignedInt dimensions> void BatchRenderer<dimensions>::remove(const UnsignedInt id) {
+    Entry& e = entry(id, "remove");
+    _glyphCount -= e.quads.size();
+    release(e.offset, e.capacity);
+    e.quads = {};
+    e.used = false;
+    _freeIds.push_back(id);
+}
+
+template<UnsignedInt dimensions> Range2D BatchRenderer<dimensions>::rectangle(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _texts.size() && _texts[id].used,
+        "Text::BatchRenderer::rectangle(): invalid text ID" << id, {});
+    return _texts[id].rectangle;
+}
+
+template<UnsignedInt dimensions> void BatchRenderer<dimensions>::allocate(Entry& e) {
+    const UnsignedInt count = e.quads.size();
+    e.capacity = count;
+    if(!count) {
+        e.offset = 0;
+        return;
+    }
+
+    /* First-fit in the free ranges */
+    for(auto it = _freeRanges.begin(); it != _freeRanges.end(); ++it) {
+        if(it->second < count) continue;
+
+        e.offset = it->first;
+        _freeQuadCount -= count;
+        if(it->second == count) _freeRanges.erase(it);
+        else {
+            it->first += count;
+            it->second -= count;
+        }
+        return;
+    }
+
+    /* Append to the end */
+    e.offset = _quadCount;
+    _quadCount += count;
+    _vertices.resize(_quadCount*4);
+}
+
+template<UnsignedInt dimensions> void BatchRenderer<dimensions>::release(const UnsignedInt offset, const UnsignedInt count) {
+    if(!count) return;
+
+    /* Make the quads degenerate so they're not rasterized */
+    std::fill(_vertices.begin() + offset*4, _vertices.begin() + (offset + count)*4, Vertex{});
+    markDirty(offset, count);
+
+    _freeRanges.emplace_back(offset, count);
+    _freeQuadCount += count;
+}
+
+template<UnsignedInt dimensions> void BatchRenderer<dimensions>::fill(const Entry& e) {
+    Vertex* out = _vertices.data() + e.offset*4;
+    for(const Implementation::GlyphQuad& quad: e.quads) {
+        /* 0---2
+           |   |
+           |   |
+           |   |
+           1---3 */
+        *out++ = {transformPosition(e.transformation, quad.position.topLeft()), quad.textureCoordinates.topLeft(), e.color};
+        *out++ = {transformPosition(e.transformation, quad.position.bottomLeft()), quad.textureCoordinates.bottomLeft(), e.color};
+        *out++ = {transformPosition(e.transformation, quad.position.topRight()), quad.textureCoordinates.topRight(), e.color};
+        *out++ = {transformPosition(e.transformation, quad.position.bottomRight()), quad.textureCoordinates.bottomRight(), e.color};
+    }
+
+    /* Quads not used by a shorter text are made degenerate */
+    std::fill(out, _vertices.data() + (e.offset + e.capacity)*4, Vertex{});
+    markDirty(e.offset, e.capacity);
+}
+
+template<UnsignedInt dimensions> void BatchRenderer<dimensions>::markDirty(const UnsignedInt offset, const UnsignedInt count) {
+    if(!count) return;
+
+    if(_dirtyBegin == _dirtyEnd) {
+        _dirtyBegin = offset;
+        _dirtyEnd = offset + count;
+    } else {
+        _dirtyBegin = std::min(_dirtyBegin, offset);
+        _dirtyEnd = std::max(_dirtyEnd, offset + count);
+    }
+}
+
+template<UnsignedInt dimensions> void BatchRenderer<dimensions>::compact() {
+    /* Put all texts tightly one after another, in order of their IDs */
+    _quadCount = 0;
+    for(Entry& e: _texts) {
+        if(!e.used) continue;
+        e.offset = _quadCount;
+        e.capacity = e.quads.size();
+        _quadCount += e.capacity;
+    }
+
+    _vertices.resize(_quadCount*4);
+    _freeRanges.clear();
+    _freeQuadCount = 0;
+    for(const Entry& e: _texts) if(e.used) fill(e);
+
+    /* Everything needs to be uploaded again */
+    _dirtyBegin = 0;
+    _dirtyEnd = _quadCount;
+}
+
+template<UnsignedInt dimensions> void BatchRenderer<dimensions>::upload() {
+    /* Compact the data if more than half of the quads is unused */
+    if(_freeQuadCount*2 > _quadCount) compact();
+
+    /* Reallocate the buffers with geometric growth if they are too small,
+       upload everything */
+    if(_quadCount > _bufferCapacity) {
+        _bufferCapacity = std::max(_quadCount, _bufferCapacity*2);
+
+        _vertexBuffer.setData({nullptr, _bufferCapacity*4*sizeof(Vertex)}, BufferUsage::DynamicDraw);
+        _vertexBuffer.setSubData(0, _vertices);
+
+        Containers::Array<char> indices;
+        Mesh::IndexType indexType;
+        std::tie(indices, indexType) = Implementation::renderGlyphQuadIndices(_bufferCapacity);
+        _indexBuffer.setData(indices, BufferUsage::StaticDraw);
+        _mesh.setIndexBuffer(_indexBuffer, 0, indexType, 0, _bufferCapacity*4);
+
+    /* Otherwise upload only the changed range */
+    } else if(_dirtyBegin != _dirtyEnd) {
+        _vertexBuffer.setSubData(_dirtyBegin*4*sizeof(Vertex),
+            Containers::ArrayView<const Vertex>{_vertices.data() + _dirtyBegin*4, (_dirtyEnd - _dirtyBegin)*4});
+    }
+
+    _dirtyBegin = _dirtyEnd = 0;
+    _mesh.setCount(_quadCount*6);
+}
+
+template<UnsignedInt dimensions> void BatchRenderer<dimensions>::draw(AbstractShaderProgram& shader) {
+    upload();
+    _mesh.draw(shader);
+}
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+template class MAGNUM_TEXT_EXPORT BatchRenderer<2>;
+template class MAGNUM_TEXT_EXPORT BatchRenderer<3>;
+#endif
+
+}}
@@ -0,0 +1,251 @@
+#ifndef Magnum_Text_BatchRenderer_h
+#define Magnum_Text_BatchRenderer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file Text/BatchRenderer.h
+ * @brief Class @ref Magnum::Text::BatchRenderer, typedef @ref Magnum::Text::BatchRenderer2D, @ref Magnum::Text::BatchRenderer3D
+ */
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Text/Text.h"
+#include "Magnum/Text/Alignment.h"
+#include "Magnum/Text/visibility.h"
+
+namespace Magnum { namespace Text {
+
+/**
+@brief Batched text renderer
+
+Lays out many independent texts, each with its own transformation, color and
+alignment, into a single shared vertex and index buffer, so all of them can be
+drawn with a single draw call. Compared to having one @ref Renderer instance
+per text, this saves two buffers and one draw call per text.
+
+Each text is identified by an ID returned from @ref add(). The text can be
+then changed with @ref setText(), @ref setTransformation() and
+@ref setColor() or removed with @ref remove(). All changes are done on a
+CPU-side copy of the vertex data and only the changed range is uploaded to the
+GPU on the next @ref upload() or @ref draw() call.
+
+## Usage
+
+@code
+std::unique_ptr<Text::AbstractFont> font;
+Text::DistanceFieldGlyphCache cache;
+Shaders::DistanceFieldVector2D shader{Shaders::DistanceFieldVector2D::Flag::VertexColor};
+
+Text::BatchRenderer2D batch{*font, cache, 0.15f};
+UnsignedInt hello = batch.add("Hello", Matrix3::translation({-0.5f, 0.0f}), Color4{1.0f, 0.0f, 0.0f});
+batch.add("World!", Matrix3::translation({0.5f, 0.0f}), Color4{0.0f, 0.0f, 1.0f}, Text::Alignment::LineRight);
+
+// Update one of the texts occasionally
+batch.setText(hello, "Bye");
+
+// Draw all texts at once
+shader.setTransformationProjectionMatrix(projection)
+    .setColor(Color4{1.0f})
+    .setVectorTexture(cache.texture());
+batch.draw(shader);
+@endcode
+
+The vertex data contain @ref Shaders::AbstractVector::Position "Position",
+@ref Shaders::AbstractVector::TextureCoordinates "TextureCoordinates" and
+@ref Shaders::DistanceFieldVector::Color "Color" attributes, so the mesh can be
+drawn with @ref Shaders::DistanceFieldVector with @ref Shaders::DistanceFieldVector::Flag::VertexColor
+set to make use of the per-text colors or with any other
+@ref Shaders::AbstractVector subclass, which ignores them.
+
+## Memory management
+
+Each text occupies a contiguous range of glyph quads in the buffer. When a
+text is changed to one with the same or smaller glyph count, it is updated in
+place and the unused quads are made degenerate. Longer texts and newly added
+texts are put into the first free range large enough or appended to the end.
+Once more than half of the quads are unused, the data are compacted on next
+@ref upload(). The GPU buffers grow geometrically, the index buffer is
+regenerated only when its capacity changes.
+
+@see @ref BatchRenderer2D, @ref BatchRenderer3D, @ref Renderer,
+    @ref InstancedRenderer
+*/
+template<UnsignedInt dimensions> class MAGNUM_TEXT_EXPORT BatchRenderer {
+    public:
+        /**
+         * @brief Constructor
+         * @param font          Font
+         * @param cache         Glyph cache
+         * @param size          Font size
+         */
+        explicit BatchRenderer(AbstractFont& font, const GlyphCache& cache, Float size);
+        BatchRenderer(AbstractFont&, GlyphCache&&, Float) = delete; /**< @overload */
+
+        ~BatchRenderer();
+
+        /** @brief Count of texts in the batch */
+        std::size_t textCount() const;
+
+        /** @brief Count of glyphs of all texts in the batch */
+        UnsignedInt glyphCount() const { return _glyphCount; }
+
+        /**
+         * @brief Count of glyph quads in the vertex data
+         *
+         * Including unused quads left over after text updates and removals.
+         * The mesh draws this many quads. Always at least @ref glyphCount().
+         */
+        UnsignedInt quadCount() const { return _quadCount; }
+
+        /** @brief Vertex buffer */
+        Buffer& vertexBuffer() { return _vertexBuffer; }
+
+        /** @brief Index buffer */
+        Buffer& indexBuffer() { return _indexBuffer; }
+
+        /**
+         * @brief Mesh
+         *
+         * Call @ref upload() to make the mesh reflect latest changes before
+         * drawing it.
+         */
+        Mesh& mesh() { return _mesh; }
+
+        /**
+         * @brief Add a text
+         * @param text              Text to render
+         * @param transformation    Transformation applied to the text
+         * @param color             Text color
+         * @param alignment         Text alignment
+         * @return ID of the text for use with other functions
+         *
+         * IDs of removed texts are reused.
+         */
+        UnsignedInt add(const std::string& text, const MatrixTypeFor<dimensions, Float>& transformation, const Color4& color = Color4{1.0f}, Alignment alignment = Alignment::LineLeft);
+
+        /**
+         * @brief Change contents of a text
+         *
+         * Keeps the original transformation, color and alignment.
+         */
+        void setText(UnsignedInt id, const std::string& text);
+
+        /**
+         * @brief Change transformation of a text
+         *
+         * The text is not laid out again.
+         */
+        void setTransformation(UnsignedInt id, const MatrixTypeFor<dimensions, Float>& transformation);
+
+        /**
+         * @brief Change color of a text
+         *
+         * The text is not laid out again.
+         */
+        void setColor(UnsignedInt id, const Color4& color);
+
+        /**
+         * @brief Remove a text
+         *
+         * The ID can be reused by subsequent @ref add() calls.
+         */
+        void remove(UnsignedInt id);
+
+        /**
+         * @brief Rectangle spanning given text
+         *
+         * In the text coordinate system, i.e. without the transformation
+         * applied.
+         */
+        Range2D rectangle(UnsignedInt id) const;
+
+        /**
+         * @brief Upload changed data to the GPU
+         *
+         * Compacts the vertex data if necessary, reallocates the buffers if
+         * they are too small and uploads the range of vertex data changed
+         * since last call.
+         * @see @ref draw()
+         */
+        void upload();
+
+        /**
+         * @brief Draw all texts
+         *
+         * Equivalent to calling @ref upload() and then drawing @ref mesh()
+         * with given @p shader.
+         */
+        void draw(AbstractShaderProgram& shader);
+
+    private:
+        struct Vertex;
+        struct Entry;
+
+        MAGNUM_TEXT_LOCAL Entry& entry(UnsignedInt id, const char* function);
+        MAGNUM_TEXT_LOCAL void allocate(Entry& entry);
+        MAGNUM_TEXT_LOCAL void release(UnsignedInt offset, UnsignedInt count);
+        MAGNUM_TEXT_LOCAL void fill(const Entry& entry);
+        MAGNUM_TEXT_LOCAL void markDirty(UnsignedInt offset, UnsignedInt count);
+        MAGNUM_TEXT_LOCAL void compact();
+
+        AbstractFont& _font;
+        const GlyphCache& _cache;
+        Float _size;
+
+        Buffer _vertexBuffer, _indexBuffer;
+        Mesh _mesh;
+
+        std::vector<Entry> _texts;
+        std::vector<UnsignedInt> _freeIds;
+        /* Free ranges of glyph quads (offset, count) */
+        std::vector<std::pair<UnsignedInt, UnsignedInt>> _freeRanges;
+        std::vector<Vertex> _vertices;
+
+        UnsignedInt _glyphCount{},
+            _quadCount{},
+            _freeQuadCount{},
+            _bufferCapacity{},
+            _dirtyBegin{},
+            _dirtyEnd{};
+};
+
+/** @brief Two-dimensional batched text renderer */
+typedef BatchRenderer<2> BatchRenderer2D;
+
+/** @brief Three-dimensional batched text renderer */
+typedef BatchRenderer<3> BatchRenderer3D;
+
+}}
+
+#endif
@@ -25,12 +25,13 @@
 
 #include "DistanceFieldGlyphCache.h"
 
+#include <Corrade/Containers/Array.h>
+
 #include "Magnum/Context.h"
 #include "Magnum/Extensions.h"
 #include "Magnum/ImageView.h"
-#ifndef CORRADE_NO_ASSERT
 #include "Magnum/PixelFormat.h"
-#endif
+#include "Magnum/Math/Functions.h"
 #include "Magnum/TextureFormat.h"
 #include "Magnum/TextureTools/DistanceField.h"
 
@@ -46,7 +47,7 @@ DistanceFieldGlyphCache::DistanceFieldGlyphCache(const Vector2i& originalSize, c
     #else
     GlyphCache(TextureFormat::RGB, originalSize, size, Vector2i(radius)),
     #endif
-    scale(Vector2(size)/Vector2(originalSize)), radius(radius)
+    scale(Vector2(size)/Vector2(originalSize)), radius(radius), _distanceFieldSize{size}, _inputInitialized{false}, _deferredUpdates{false}
 {
     #ifndef MAGNUM_TARGET_GLES
     MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::ARB::texture_rg);
@@ -80,14 +81,73 @@ void DistanceFieldGlyphCache::setImage(const Vector2i& offset, const ImageView2D
     }
     #endif
 
-    Texture2D input;
-    input.setWrapping(Sampler::Wrapping::ClampToEdge)
-        .setMinificationFilter(Sampler::Filter::Linear)
-        .setMagnificationFilter(Sampler::Filter::Linear)
-        .setImage(0, internalFormat, image);
+    /* Allocate the persistent input texture on first use, when the pixel
+       format is known. It's cleared so the parts not yet covered by any image
+       don't produce garbage in the distance field. */
+    if(!_inputInitialized) {
+        Containers::Array<char> zeros{Containers::ValueInit, image.pixelSize()*textureSize().product()};
+        _input.setWrapping(Sampler::Wrapping::ClampToEdge)
+            .setMinificationFilter(Sampler::Filter::Linear)
+            .setMagnificationFilter(Sampler::Filter::Linear)
+            .setImage(0, internalFormat, ImageView2D{PixelStorage{}.setAlignment(1), image.format(), image.type(), textureSize(), zeros});
+        _inputInitialized = true;
+        addDirtyRectangle({{}, textureSize()});
+    }
+
+    /* Upload the image and mark the area affected by it, including pixels
+       which have the image in their lookup radius */
+    _input.setSubImage(0, offset, image);
+    addDirtyRectangle(Range2Di::fromSize(offset, image.size()).padded(Vector2i(radius)));
+
+    if(!_deferredUpdates) flush();
+}
+
+void DistanceFieldGlyphCache::addDirtyRectangle(const Range2Di& rectangle) {
+    const Range2Di clamped{Math::max(rectangle.min(), Vector2i{}),
+                           Math::min(rectangle.max(), textureSize())};
+    if((clamped.max() <= clamped.min()).any()) return;
+
+    _dirtyRectangles.push_back(clamped);
+}
+
+DistanceFieldGlyphCache& DistanceFieldGlyphCache::setDeferredUpdates(const bool enabled) {
+    _deferredUpdates = enabled;
+    if(!enabled) flush();
+    return *this;
+}
+
+DistanceFieldGlyphCache& DistanceFieldGlyphCache::flush() {
+    if(_dirtyRectangles.empty()) return *this;
+
+    /* Merge overlapping rectangles until there's nothing left to merge, so no
+       pixel is processed more than once */
+    for(bool merged = true; merged; ) {
+        merged = false;
+        for(std::size_t i = 0; i != _dirtyRectangles.size(); ++i) {
+            for(std::size_t j = i + 1; j < _dirtyRectangles.size(); ) {
+                const Range2Di& a = _dirtyRectangles[i];
+                const Range2Di& b = _dirtyRectangles[j];
+                if((a.min() < b.max()).all() && (b.min() < a.max()).all()) {
+                    _dirtyRectangles[i] = Math::join(a, b);
+                    _dirtyRectangles[j] = _dirtyRectangles.back();
+                    _dirtyRectangles.pop_back();
+                    merged = true;
+                } else ++j;
+            }
+        }
+    }
+
+    /* Convert to distance field texture coordinates, rounding outwards */
+    std::vector<Range2Di> rectangles;
+    rectangles.reserve(_dirtyRectangles.size());
+    for(const Range2Di& rectangle: _dirtyRectangles)
+        rectangles.emplace_back(
+            Math::max(Vector2i{Math::floor(Vector2(rectangle.min())*scale)}, Vector2i{}),
+            Math::min(Vector2i{Math::ceil(Vector2(rectangle.max())*scale)}, _distanceFieldSize));
+    _dirtyRectangles.clear();
 
-    /* Create distance field from input texture */
-    TextureTools::distanceField(input, texture(), Range2Di::fromSize(offset*scale, image.size()*scale), radius, image.size());
+    TextureTools::distanceField(_input, texture(), rectangles, radius, textureSize(), _distanceFieldSize);
+    return *this;
 }
 
 void DistanceFieldGlyphCache::setDistanceFieldImage(const Vector2i& offset, const ImageView2D& image) {
@@ -52,6 +52,18 @@ font->createGlyphCache(cache, "abcdefghijklmnopqrstuvwxyz"
                               "0123456789?!:;,. ");
 @endcode
 
+## Incremental updates
+
+The cache keeps a copy of the original binary texture on the GPU, so when
+@ref setImage() is called with only a part of the cache, only pixels of the
+distance field texture affected by it (i.e. the updated area extended by
+distance field radius) are recalculated. When filling the cache with many
+small images (e.g. when glyphs are added on demand), enable
+@ref setDeferredUpdates() "deferred updates" --- the affected areas are then
+only collected, merged together and processed in a single pass on
+@ref flush(). The additional texture has the original cache size, which can be
+a significant memory cost for large caches.
+
 @see @ref TextureTools::distanceField()
 */
 class MAGNUM_TEXT_EXPORT DistanceFieldGlyphCache: public GlyphCache {
@@ -77,10 +89,49 @@ class MAGNUM_TEXT_EXPORT DistanceFieldGlyphCache: public GlyphCache {
          * @brief Set cache image
          *
          * Uploads image for one or more glyphs to given offset in original
-         * cache texture. The texture is then converted to distance field.
+         * cache texture. The affected part of the texture is then converted
+         * to distance field, either immediately or on next call to
+         * @ref flush() if @ref setDeferredUpdates() "deferred updates" are
+         * enabled.
          */
         void setImage(const Vector2i& offset, const ImageView2D& image) override;
 
+        /**
+         * @brief Whether distance field updates are deferred
+         *
+         * @see @ref setDeferredUpdates()
+         */
+        bool hasDeferredUpdates() const { return _deferredUpdates; }
+
+        /**
+         * @brief Enable or disable deferred distance field updates
+         * @return Reference to self (for method chaining)
+         *
+         * If enabled, @ref setImage() only uploads the image and records the
+         * affected area, the distance field is recalculated on @ref flush().
+         * Disabling deferred updates flushes all pending updates. Disabled by
+         * default.
+         */
+        DistanceFieldGlyphCache& setDeferredUpdates(bool enabled);
+
+        /**
+         * @brief Whether there are any pending distance field updates
+         *
+         * @see @ref flush()
+         */
+        bool hasPendingUpdates() const { return !_dirtyRectangles.empty(); }
+
+        /**
+         * @brief Process pending distance field updates
+         * @return Reference to self (for method chaining)
+         *
+         * Merges overlapping areas recorded by @ref setImage() and
+         * recalculates them using single call to
+         * @ref TextureTools::distanceField(Texture2D&, Texture2D&, const std::vector<Range2Di>&, Int, const Vector2i&, const Vector2i&).
+         * If there are no pending updates, the function is a no-op.
+         */
+        DistanceFieldGlyphCache& flush();
+
         /**
          * @brief Set distance field cache image
          *
@@ -90,8 +141,15 @@ class MAGNUM_TEXT_EXPORT DistanceFieldGlyphCache: public GlyphCache {
         void setDistanceFieldImage(const Vector2i& offset, const ImageView2D& image);
 
     private:
+        void MAGNUM_TEXT_LOCAL addDirtyRectangle(const Range2Di& rectangle);
+
         const Vector2 scale;
         const UnsignedInt radius;
+        const Vector2i _distanceFieldSize;
+
+        Texture2D _input;
+        bool _inputInitialized, _deferredUpdates;
+        std::vector<Range2Di> _dirtyRectangles;
 };
 
 }}
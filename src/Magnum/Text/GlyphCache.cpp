@@ -29,19 +29,18 @@
 #include "Magnum/Extensions.h"
 #include "Magnum/Image.h"
 #include "Magnum/TextureFormat.h"
-#include "Magnum/TextureTools/Atlas.h"
 
 namespace Magnum { namespace Text {
 
 GlyphCache::GlyphCache(const TextureFormat internalFormat, const Vector2i& size, const Vector2i& padding): GlyphCache{internalFormat, size, size, padding} {}
 
-GlyphCache::GlyphCache(const TextureFormat internalFormat, const Vector2i& originalSize, const Vector2i& size, const Vector2i& padding): _size(originalSize), _padding(padding) {
+GlyphCache::GlyphCache(const TextureFormat internalFormat, const Vector2i& originalSize, const Vector2i& size, const Vector2i& padding): _size(originalSize), _padding(padding), _packer{originalSize, padding} {
     initialize(internalFormat, size);
 }
 
 GlyphCache::GlyphCache(const Vector2i& size, const Vector2i& padding): GlyphCache{size, size, padding} {}
 
-GlyphCache::GlyphCache(const Vector2i& originalSize, const Vector2i& size, const Vector2i& padding): _size(originalSize), _padding(padding) {
+GlyphCache::GlyphCache(const Vector2i& originalSize, const Vector2i& size, const Vector2i& padding): _size(originalSize), _padding(padding), _packer{originalSize, padding} {
     #ifndef MAGNUM_TARGET_GLES
     MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::ARB::texture_rg);
     #endif
@@ -62,6 +61,12 @@ GlyphCache::GlyphCache(const Vector2i& originalSize, const Vector2i& size, const
     initialize(internalFormat, size);
 }
 
+GlyphCache::GlyphCache(NoCreateT, const Vector2i& size, const Vector2i& padding): _size(size), _padding(padding), _texture{NoCreate}, _packer{size, padding} {
+    /* Default "Not Found" glyph */
+    _glyphs.push_back({0, {}});
+    _glyphIndices.push_back(0);
+}
+
 GlyphCache::~GlyphCache() = default;
 
 void GlyphCache::initialize(const TextureFormat internalFormat, const Vector2i& size) {
@@ -72,24 +77,50 @@ void GlyphCache::initialize(const TextureFormat internalFormat, const Vector2i&
         .setStorage(1, internalFormat, size);
 
     /* Default "Not Found" glyph */
-    glyphs.insert({0, {}});
+    _glyphs.push_back({0, {}});
+    _glyphIndices.push_back(0);
 }
 
 std::vector<Range2Di> GlyphCache::reserve(const std::vector<Vector2i>& sizes) {
-    CORRADE_ASSERT((glyphs.size() == 1 && glyphs.at(0) == std::pair<Vector2i, Range2Di>()),
-        "Text::GlyphCache::reserve(): reserving space in non-empty cache is not yet implemented", {});
-    glyphs.reserve(glyphs.size() + sizes.size());
-    return TextureTools::atlas(_size, sizes, _padding);
+    /* Nothing was inserted since last reservation, make the space available
+       again */
+    if(_glyphs.size() == 1 && _glyphs[0].second == std::pair<Vector2i, Range2Di>())
+        _packer.clear();
+
+    _glyphs.reserve(_glyphs.size() + sizes.size());
+    return _packer.add(sizes);
 }
 
 void GlyphCache::insert(const UnsignedInt glyph, const Vector2i& position, const Range2Di& rectangle) {
     const std::pair<Vector2i, Range2Di> glyphData = {position-_padding, rectangle.padded(_padding)};
 
     /* Overwriting "Not Found" glyph */
-    if(glyph == 0) glyphs[0] = glyphData;
+    if(glyph == 0) {
+        _glyphs[0].second = glyphData;
+        return;
+    }
 
     /* Inserting new glyph */
-    else CORRADE_INTERNAL_ASSERT_OUTPUT(glyphs.insert({glyph, glyphData}).second);
+    if(glyph >= _glyphIndices.size()) _glyphIndices.resize(glyph + 1, 0);
+    CORRADE_INTERNAL_ASSERT(!_glyphIndices[glyph]);
+    _glyphIndices[glyph] = _glyphs.size();
+    _glyphs.push_back({glyph, glyphData});
+}
+
+void GlyphCache::erase(const UnsignedInt glyph) {
+    if(glyph == 0) {
+        _glyphs[0].second = {};
+        return;
+    }
+
+    if(glyph >= _glyphIndices.size() || !_glyphIndices[glyph]) return;
+
+    /* Move the last glyph into the freed slot to keep the data packed */
+    const UnsignedInt index = _glyphIndices[glyph];
+    _glyphs[index] = _glyphs.back();
+    _glyphIndices[_glyphs[index].first] = index;
+    _glyphs.pop_back();
+    _glyphIndices[glyph] = 0;
 }
 
 void GlyphCache::setImage(const Vector2i& offset, const ImageView2D& image) {
@@ -30,11 +30,11 @@
  */
 
 #include <vector>
-#include <unordered_map>
 
 #include "Magnum/Math/Range.h"
 #include "Magnum/Texture.h"
 #include "Magnum/Text/visibility.h"
+#include "Magnum/TextureTools/Atlas.h"
 
 namespace Magnum { namespace Text {
 
@@ -55,7 +55,9 @@ font->createGlyphCache(cache, "abcdefghijklmnopqrstuvwxyz"
                               "0123456789?!:;,. ");
 @endcode
 
-See @ref Renderer for information about text rendering.
+See @ref Renderer for information about text rendering. If the set of glyphs
+isn't known in advance and can grow without bounds (such as with CJK text),
+see @ref GlyphCacheArray.
 @todo Some way for Font to negotiate or check internal texture format
 @todo Default glyph 0 with rect 0 0 0 0 will result in negative dimensions when
     nonzero padding is removed
@@ -112,7 +114,7 @@ class MAGNUM_TEXT_EXPORT GlyphCache {
         Vector2i padding() const { return _padding; }
 
         /** @brief Count of glyphs in the cache */
-        std::size_t glyphCount() const { return glyphs.size(); }
+        std::size_t glyphCount() const { return _glyphs.size(); }
 
         /** @brief Cache texture */
         Texture2D& texture() { return _texture; }
@@ -129,21 +131,28 @@ class MAGNUM_TEXT_EXPORT GlyphCache {
          * If no glyph is found, glyph `0` is returned, which is by default on
          * zero position and has zero region in texture atlas. You can reset it
          * to some meaningful value in @ref insert().
+         *
+         * The lookup is a direct index into a flat table, so it's cheap
+         * enough to be done for every glyph in text layout.
          * @see @ref padding()
          */
         std::pair<Vector2i, Range2Di> operator[](UnsignedInt glyph) const {
-            auto it = glyphs.find(glyph);
-            return it == glyphs.end() ? glyphs.at(0) : it->second;
+            return _glyphs[glyph < _glyphIndices.size() ? _glyphIndices[glyph] : 0].second;
         }
 
-        /** @brief Iterator access to cache data */
-        std::unordered_map<UnsignedInt, std::pair<Vector2i, Range2Di>>::const_iterator begin() const {
-            return glyphs.begin();
+        /**
+         * @brief Iterator access to cache data
+         *
+         * Iterates over pairs of glyph ID and glyph parameters. Glyph `0` is
+         * always first, the order of the remaining glyphs is unspecified.
+         */
+        std::vector<std::pair<UnsignedInt, std::pair<Vector2i, Range2Di>>>::const_iterator begin() const {
+            return _glyphs.begin();
         }
 
         /** @brief Iterator access to cache data */
-        std::unordered_map<UnsignedInt, std::pair<Vector2i, Range2Di>>::const_iterator end() const {
-            return glyphs.end();
+        std::vector<std::pair<UnsignedInt, std::pair<Vector2i, Range2Di>>>::const_iterator end() const {
+            return _glyphs.end();
         }
 
         /**
@@ -151,16 +160,20 @@ class MAGNUM_TEXT_EXPORT GlyphCache {
          *
          * Returns non-overlapping regions in cache texture to store glyphs.
          * The reserved space is reused on next call to @ref reserve() if no
-         * glyph was stored there, use @ref insert() to store actual glyph on
-         * given position and @ref setImage() to upload glyph image.
+         * glyph was stored in the cache yet, use @ref insert() to store
+         * actual glyph on given position and @ref setImage() to upload glyph
+         * image. If the cache already contains some glyphs, the new regions
+         * are placed into the remaining free space without moving the
+         * existing ones, see @ref TextureTools::AtlasPacker for details.
          *
-         * Glyph @p sizes are expected to be without padding.
+         * Glyph @p sizes are expected to be without padding. If the glyphs
+         * don't fit into the remaining space, returns empty vector.
          *
          * @attention Cache size must be large enough to contain all rendered
          *      glyphs.
          * @see @ref padding()
          */
-        std::vector<Range2Di> reserve(const std::vector<Vector2i>& sizes);
+        virtual std::vector<Range2Di> reserve(const std::vector<Vector2i>& sizes);
 
         /**
          * @brief Insert glyph to cache
@@ -177,7 +190,7 @@ class MAGNUM_TEXT_EXPORT GlyphCache {
          * See also @ref setImage() to upload glyph image.
          * @see @ref padding()
          */
-        void insert(UnsignedInt glyph, const Vector2i& position, const Range2Di& rectangle);
+        virtual void insert(UnsignedInt glyph, const Vector2i& position, const Range2Di& rectangle);
 
         /**
          * @brief Set cache image
@@ -187,13 +200,32 @@ class MAGNUM_TEXT_EXPORT GlyphCache {
          */
         virtual void setImage(const Vector2i& offset, const ImageView2D& image);
 
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    protected:
+    #else
+    private:
+    #endif
+        /* Used by GlyphCacheArray, which manages its own texture and atlas
+           packing. Doesn't create the texture. */
+        explicit GlyphCache(NoCreateT, const Vector2i& size, const Vector2i& padding);
+
+        /* Removes a glyph from the cache, glyph 0 is reset to zero position
+           and zero region */
+        void erase(UnsignedInt glyph);
+
     private:
         void MAGNUM_LOCAL initialize(TextureFormat internalFormat, const Vector2i& size);
 
         Vector2i _size, _padding;
         Texture2D _texture;
-
-        std::unordered_map<UnsignedInt, std::pair<Vector2i, Range2Di>> glyphs;
+        TextureTools::AtlasPacker _packer;
+
+        /* Glyph data packed together, glyph 0 is always at the front.
+           Indices into it are stored in a table indexed by glyph ID, with
+           zero for glyphs not in the cache, so the lookup falls back to
+           glyph 0 without any extra branching. */
+        std::vector<std::pair<UnsignedInt, std::pair<Vector2i, Range2Di>>> _glyphs;
+        std::vector<UnsignedInt> _glyphIndices;
 };
 
 }}
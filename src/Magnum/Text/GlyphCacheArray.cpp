@@ -0,0 +1,174 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "GlyphCacheArray.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace Text {
+
+GlyphCacheArray::GlyphCacheArray(const TextureFormat internalFormat, const Vector2i& size, const Int maxLayers, const Int initialLayers, const Vector2i& padding): GlyphCache{NoCreate, size, padding}, _internalFormat{internalFormat}, _format{}, _type{}, _maxLayers{std::min(maxLayers, Texture2DArray::maxSize().z())} {
+    #ifndef MAGNUM_TARGET_GLES
+    MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::EXT::texture_array);
+    #endif
+    CORRADE_ASSERT(maxLayers > 0,
+        "Text::GlyphCacheArray: expected at least one layer", );
+
+    grow(Math::clamp(initialLayers, 1, _maxLayers));
+    _layers.emplace_back(size, padding);
+}
+
+GlyphCacheArray::GlyphCacheArray(const Vector2i& size, const Int maxLayers, const Int initialLayers, const Vector2i& padding): GlyphCacheArray{TextureFormat::R8, size, maxLayers, initialLayers, padding} {
+    #ifndef MAGNUM_TARGET_GLES
+    MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::ARB::texture_rg);
+    #endif
+}
+
+GlyphCacheArray::~GlyphCacheArray() = default;
+
+void GlyphCacheArray::grow(const Int capacity) {
+    Texture2DArray texture;
+    texture.setWrapping(Sampler::Wrapping::ClampToEdge)
+        .setMinificationFilter(Sampler::Filter::Linear)
+        .setMagnificationFilter(Sampler::Filter::Linear)
+        .setStorage(1, _internalFormat, {textureSize(), capacity});
+
+    /* Storage is immutable, reupload the existing layers from the CPU-side
+       copies */
+    for(std::size_t i = 0; i != _layers.size(); ++i) {
+        if(!_layers[i].data) continue;
+        texture.setSubImage(0, Vector3i::zAxis(i), ImageView3D{PixelStorage{}.setAlignment(1), _format, _type, {textureSize(), 1}, _layers[i].data});
+    }
+
+    _texture = std::move(texture);
+    _capacity = capacity;
+}
+
+Int GlyphCacheArray::nextLayer() {
+    /* Space for a new layer */
+    if(Int(_layers.size()) < _maxLayers) {
+        if(Int(_layers.size()) == _capacity)
+            grow(std::min(_capacity*2, _maxLayers));
+        _layers.emplace_back(textureSize(), padding());
+        return _layers.size() - 1;
+    }
+
+    /* Evict the least recently used layer */
+    const Int evicted = std::min_element(_layers.begin(), _layers.end(), [](const Layer& a, const Layer& b) {
+        return a.lastUse < b.lastUse;
+    }) - _layers.begin();
+    Layer& layer = _layers[evicted];
+    for(const UnsignedInt glyph: layer.glyphs) {
+        erase(glyph);
+        _glyphLayers.erase(glyph);
+    }
+    layer.glyphs.clear();
+    layer.packer.clear();
+    return evicted;
+}
+
+Int GlyphCacheArray::layer(const UnsignedInt glyph) const {
+    auto found = _glyphLayers.find(glyph);
+    if(found != _glyphLayers.end()) return found->second;
+    found = _glyphLayers.find(0);
+    return found != _glyphLayers.end() ? found->second : 0;
+}
+
+void GlyphCacheArray::markLayerUsed(const Int layer) const {
+    CORRADE_ASSERT(layer >= 0 && layer < Int(_layers.size()),
+        "Text::GlyphCacheArray::markLayerUsed(): layer" << layer << "out of range for" << _layers.size() << "layers", );
+    _layers[layer].lastUse = ++_useCounter;
+}
+
+std::vector<Range2Di> GlyphCacheArray::reserve(const std::vector<Vector2i>& sizes) {
+    /* Nothing was inserted into the current layer since last reservation,
+       make the space available again. If the glyphs don't fit into an empty
+       layer, they won't fit anywhere. */
+    Layer& current = _layers[_currentLayer];
+    if(current.glyphs.empty()) {
+        current.packer.clear();
+        return current.packer.add(sizes);
+    }
+
+    /* Try the remaining space in the current layer */
+    std::vector<Range2Di> ranges = current.packer.add(sizes);
+    if(!ranges.empty()) return ranges;
+
+    /* Continue in a new (or evicted) layer */
+    _currentLayer = nextLayer();
+    markLayerUsed(_currentLayer);
+    return _layers[_currentLayer].packer.add(sizes);
+}
+
+void GlyphCacheArray::insert(const UnsignedInt glyph, const Vector2i& position, const Range2Di& rectangle) {
+    /* Remove the previous occurence of the glyph */
+    auto found = _glyphLayers.find(glyph);
+    if(found != _glyphLayers.end()) {
+        std::vector<UnsignedInt>& glyphs = _layers[found->second].glyphs;
+        glyphs.erase(std::find(glyphs.begin(), glyphs.end(), glyph));
+        erase(glyph);
+    }
+
+    /* Place the glyph into the virtual atlas with layers stacked on top of
+       each other */
+    GlyphCache::insert(glyph, position, rectangle.translated(Vector2i::yAxis(_currentLayer*textureSize().y())));
+    _glyphLayers[glyph] = _currentLayer;
+    _layers[_currentLayer].glyphs.push_back(glyph);
+    markLayerUsed(_currentLayer);
+}
+
+void GlyphCacheArray::setImage(const Vector2i& offset, const ImageView2D& image) {
+    CORRADE_ASSERT((offset >= Vector2i{}).all() && (offset + image.size() <= textureSize()).all(),
+        "Text::GlyphCacheArray::setImage(): image of size" << image.size() << "at offset" << offset << "doesn't fit into layer of size" << textureSize(), );
+
+    Layer& layer = _layers[_currentLayer];
+
+    /* Remember the format on first upload, the CPU-side copies need it */
+    if(_type == PixelType{}) {
+        _format = image.format();
+        _type = image.type();
+    } else CORRADE_ASSERT(image.format() == _format && image.type() == _type,
+        "Text::GlyphCacheArray::setImage(): expected" << _format << "and" << _type << "but got" << image.format() << "and" << image.type(), );
+
+    _texture.setSubImage(0, {offset, _currentLayer}, ImageView3D{image.storage(), image.format(), image.type(), {image.size(), 1}, image.data()});
+
+    /* Update the tightly packed CPU-side copy of the layer */
+    const std::size_t pixelSize = image.pixelSize();
+    const std::size_t rowSize = textureSize().x()*pixelSize;
+    if(!layer.data) layer.data = Containers::Array<char>{Containers::ValueInit, rowSize*textureSize().y()};
+    const auto properties = image.dataProperties();
+    const char* const data = image.data() + std::get<0>(properties).sum();
+    for(Int y = 0; y != image.size().y(); ++y)
+        std::memcpy(layer.data + (offset.y() + y)*rowSize + offset.x()*pixelSize,
+            data + y*std::get<1>(properties).x(), image.size().x()*pixelSize);
+}
+
+}}
@@ -0,0 +1,241 @@
+#ifndef Magnum_Text_GlyphCacheArray_h
+#define Magnum_Text_GlyphCacheArray_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MAGNUM_TARGET_GLES2
+/** @file
+ * @brief Class @ref Magnum::Text::GlyphCacheArray
+ */
+#endif
+
+#include <cstdint>
+#include <unordered_map>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/PixelFormat.h"
+#include "Magnum/TextureArray.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/Text/GlyphCache.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+namespace Magnum { namespace Text {
+
+/**
+@brief Layered glyph cache
+
+Glyph cache backed by a @ref Texture2DArray, which gets new layers allocated
+on demand. Unlike @ref GlyphCache, which fails to accept new glyphs once its
+single texture is full, this cache continues in a new layer and, once
+@ref maxLayers() is reached, evicts the least recently used layer to make room,
+so the glyph capacity is effectively unbounded.
+
+## Usage
+
+The cache is filled the same way as @ref GlyphCache, using
+@ref AbstractFont::fillGlyphCache(). It can be filled incrementally, with only
+the characters that appeared since last time:
+@code
+std::unique_ptr<Text::AbstractFont> font;
+Text::GlyphCacheArray cache{Vector2i{1024}, 16};
+font->fillGlyphCache(cache, "abcdefghijklmnopqrstuvwxyz");
+
+// Later, when new characters appear in the chat
+font->fillGlyphCache(cache, newCharacters);
+@endcode
+
+Each call to @ref reserve() places all requested glyphs into a single layer
+--- if they don't fit into the remaining space of the current layer, a new one
+is started. The glyph rectangles returned by @ref operator[]() are placed into
+a virtual atlas with the layers stacked on top of each other, so layer `i`
+spans Y coordinates from `i*textureSize().y()` to
+`(i + 1)*textureSize().y()`. The integer part of the Y texture
+coordinate calculated by the font layouter is thus the layer index.
+@ref Renderer, when constructed with this cache, converts that into
+@ref Shaders::AbstractVector::TextureArrayCoordinates vertex data with the
+layer in the last component, to be rendered with the texture array variant of
+@ref Shaders::Vector or @ref Shaders::DistanceFieldVector:
+@code
+Shaders::Vector2D shader{Shaders::Vector2D::Flag::TextureArrays};
+Text::Renderer2D renderer{*font, cache, 0.15f};
+renderer.reserve(256, BufferUsage::DynamicDraw, BufferUsage::StaticDraw);
+renderer.render(message);
+
+shader.setVectorTexture(cache.texture());
+renderer.mesh().draw(shader);
+@endcode
+
+## Layer allocation and eviction
+
+The texture is initially allocated with one layer and its layer count is
+doubled every time it runs out, up to @ref maxLayers(). As texture storage is
+immutable, growing it means allocating a new texture and reuploading all
+layers, which are for that purpose kept also in a CPU-side copy. The growth
+happens only @f$ \log_2 n @f$ times for @f$ n @f$ layers, so the hitches are
+rare and can be avoided altogether by passing a nonzero @p initialLayers to
+the constructor.
+
+Once all @ref maxLayers() are in use, the layer that was least recently used is
+cleared and reused. A layer is marked as used every time a glyph is inserted
+into it and every time @ref Renderer renders a glyph from it, see
+@ref markLayerUsed(). Glyphs from the evicted layer are removed from the cache
+and fall back to glyph `0` until they're filled again.
+
+@attention As the cache is const in the renderers, the use counters are
+    updated through mutable state. Meshes that are rendered once and then
+    drawn for a long time without other text updates should have their layers
+    marked as used with @ref markLayerUsed() to prevent them from being
+    evicted.
+
+The glyph rectangles live in the virtual layered atlas, so this cache is not
+meant to be exported with @ref AbstractFontConverter.
+
+@requires_gl30 Extension @extension{EXT,texture_array}
+@requires_gles30 Array textures are not available in OpenGL ES 2.0.
+@requires_webgl20 Array textures are not available in WebGL 1.0.
+*/
+class MAGNUM_TEXT_EXPORT GlyphCacheArray: public GlyphCache {
+    public:
+        /**
+         * @brief Constructor
+         * @param internalFormat    Internal texture format
+         * @param size              Size of one layer
+         * @param maxLayers         Maximal count of layers
+         * @param initialLayers     Count of layers to allocate upfront
+         * @param padding           Padding around every glyph
+         *
+         * The @p maxLayers value is clamped to the value of
+         * @ref Texture2DArray::maxSize(). If @p initialLayers is zero, one
+         * layer is allocated.
+         */
+        explicit GlyphCacheArray(TextureFormat internalFormat, const Vector2i& size, Int maxLayers, Int initialLayers = 0, const Vector2i& padding = Vector2i());
+
+        /**
+         * @brief Constructor
+         *
+         * Sets internal texture format to @ref TextureFormat::R8. On desktop
+         * OpenGL requires @extension{ARB,texture_rg}.
+         */
+        explicit GlyphCacheArray(const Vector2i& size, Int maxLayers, Int initialLayers = 0, const Vector2i& padding = Vector2i());
+
+        ~GlyphCacheArray();
+
+        /** @brief Maximal count of layers */
+        Int maxLayers() const { return _maxLayers; }
+
+        /**
+         * @brief Count of layers containing glyphs
+         *
+         * @see @ref layerCapacity()
+         */
+        Int layerCount() const { return _layers.size(); }
+
+        /**
+         * @brief Count of layers allocated in the texture
+         *
+         * @see @ref layerCount()
+         */
+        Int layerCapacity() const { return _capacity; }
+
+        /**
+         * @brief Cache texture
+         *
+         * Hides @ref GlyphCache::texture(), which is not used by this class.
+         */
+        Texture2DArray& texture() { return _texture; }
+
+        /**
+         * @brief Layer in which given glyph is stored
+         *
+         * If no glyph is found, layer of glyph `0` is returned.
+         */
+        Int layer(UnsignedInt glyph) const;
+
+        /**
+         * @brief Mark layer as used
+         *
+         * Protects the layer from being evicted until other layers get used
+         * more recently. Called by @ref Renderer for every rendered glyph.
+         */
+        void markLayerUsed(Int layer) const;
+
+        /**
+         * @brief Layout glyphs with given sizes to the cache
+         *
+         * Places all glyphs into the current layer or, if they don't fit,
+         * into a new one, growing the texture or evicting the least
+         * recently used layer if needed. The returned rectangles are relative
+         * to the layer. If the glyphs don't fit even into an empty layer,
+         * returns empty vector.
+         */
+        std::vector<Range2Di> reserve(const std::vector<Vector2i>& sizes) override;
+
+        /**
+         * @brief Insert glyph to cache
+         *
+         * The @p rectangle is expected to be relative to the layer returned
+         * from last call to @ref reserve(). Unlike @ref GlyphCache::insert(),
+         * an already present glyph is replaced.
+         */
+        void insert(UnsignedInt glyph, const Vector2i& position, const Range2Di& rectangle) override;
+
+        /**
+         * @brief Set cache image
+         *
+         * Uploads image for one or more glyphs to given offset in the layer
+         * returned from last call to @ref reserve(). All images are expected
+         * to have the same format and type.
+         */
+        void setImage(const Vector2i& offset, const ImageView2D& image) override;
+
+    private:
+        struct Layer {
+            explicit Layer(const Vector2i& size, const Vector2i& padding): packer{size, padding} {}
+
+            TextureTools::AtlasPacker packer;
+            std::vector<UnsignedInt> glyphs;
+            Containers::Array<char> data;
+            mutable std::uint64_t lastUse{};
+        };
+
+        void MAGNUM_LOCAL grow(Int capacity);
+        Int MAGNUM_LOCAL nextLayer();
+
+        TextureFormat _internalFormat;
+        PixelFormat _format;
+        PixelType _type;
+        Int _maxLayers, _capacity{}, _currentLayer{};
+        mutable std::uint64_t _useCounter{};
+        Texture2DArray _texture;
+        std::vector<Layer> _layers;
+        std::unordered_map<UnsignedInt, Int> _glyphLayers;
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 build
+#endif
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef Magnum_Text_Implementation_GlyphQuads_h
+#define Magnum_Text_Implementation_GlyphQuads_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string>
+#include <utility>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Text/Text.h"
+
+namespace Magnum { namespace Text { namespace Implementation {
+
+struct GlyphQuad {
+    Range2D position, textureCoordinates;
+};
+
+/* Lays out and aligns all lines of the text into a list of glyph quads,
+   replacing previous contents of the list. Returns rectangle spanning the
+   rendered text. Shared by all renderers. */
+Range2D renderGlyphQuads(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, Alignment alignment, std::vector<GlyphQuad>& quads);
+
+/* Creates index data for given count of glyph quads, each consisting of four
+   consecutive vertices, using the smallest index type possible */
+std::pair<Containers::Array<char>, Mesh::IndexType> renderGlyphQuadIndices(UnsignedInt glyphCount);
+
+}}}
+
+#endif
@@ -0,0 +1,114 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "InstancedRenderer.h"
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Math/Packing.h"
+#include "Magnum/Shaders/InstancedVector.h"
+#include "Magnum/Text/Implementation/GlyphQuads.h"
+
+namespace Magnum { namespace Text {
+
+namespace {
+
+/* 0---2
+   |   |
+   |   |
+   |   |
+   1---3 */
+constexpr Vector2 Corners[]{
+    {0.0f, 1.0f},
+    {0.0f, 0.0f},
+    {1.0f, 1.0f},
+    {1.0f, 0.0f}
+};
+
+constexpr UnsignedByte Indices[]{0, 1, 2, 1, 3, 2};
+
+}
+
+template<UnsignedInt dimensions> InstancedRenderer<dimensions>::InstancedRenderer(AbstractFont& font, const GlyphCache& cache, const Float size, const Alignment alignment): _cornerBuffer{Buffer::TargetHint::Array}, _indexBuffer{Buffer::TargetHint::ElementArray}, _instanceBuffer{Buffer::TargetHint::Array}, _font(font), _cache(cache), _size(size), _alignment(alignment), _capacity(0) {
+    #ifndef MAGNUM_TARGET_GLES
+    MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::ARB::instanced_arrays);
+    #endif
+
+    static_assert(sizeof(Instance) == 9*4, "Improper size of instance data");
+
+    /* Static quad shared by all glyphs */
+    _cornerBuffer.setData(Corners, BufferUsage::StaticDraw);
+    _indexBuffer.setData(Indices, BufferUsage::StaticDraw);
+
+    typedef Shaders::InstancedVector<dimensions> Shader;
+    _mesh.setPrimitive(MeshPrimitive::Triangles)
+        .setCount(6)
+        .setInstanceCount(0)
+        .setIndexBuffer(_indexBuffer, 0, Mesh::IndexType::UnsignedByte, 0, 3)
+        .addVertexBuffer(_cornerBuffer, 0, typename Shader::Corner{})
+        .addVertexBufferInstanced(_instanceBuffer, 1, 0,
+            typename Shader::GlyphPosition{},
+            typename Shader::GlyphTextureCoordinates{},
+            typename Shader::Color{Shader::Color::Components::Four, Shader::Color::DataType::UnsignedByte, Shader::Color::DataOption::Normalized});
+}
+
+template<UnsignedInt dimensions> InstancedRenderer<dimensions>::~InstancedRenderer() = default;
+
+template<UnsignedInt dimensions> void InstancedRenderer<dimensions>::reserve(const UnsignedInt glyphCount, const BufferUsage usage) {
+    _capacity = glyphCount;
+
+    /* Allocate instance buffer, reset instance count */
+    _instanceBuffer.setData({nullptr, glyphCount*sizeof(Instance)}, usage);
+    _mesh.setInstanceCount(0);
+}
+
+template<UnsignedInt dimensions> void InstancedRenderer<dimensions>::render(const std::string& text, const Color4& color) {
+    /* Lay out the glyphs. The quad vector is a temporary, but the instance
+       vector is kept around to avoid reallocating on every text change. */
+    std::vector<Implementation::GlyphQuad> quads;
+    _rectangle = Implementation::renderGlyphQuads(_font, _cache, _size, text, _alignment, quads);
+
+    const UnsignedInt glyphCount = quads.size();
+    CORRADE_ASSERT(glyphCount <= _capacity,
+        "Text::InstancedRenderer::render(): capacity" << _capacity << "too small to render" << glyphCount << "glyphs", );
+
+    /* Convert the quads to instance data */
+    const Color4ub packedColor = Math::pack<Color4ub>(color);
+    _instances.clear();
+    _instances.reserve(glyphCount);
+    for(const Implementation::GlyphQuad& quad: quads)
+        _instances.push_back({quad.position, quad.textureCoordinates, packedColor});
+
+    /* Upload and update the instance count */
+    if(glyphCount) _instanceBuffer.setSubData(0, _instances);
+    _mesh.setInstanceCount(glyphCount);
+}
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+template class MAGNUM_TEXT_EXPORT InstancedRenderer<2>;
+template class MAGNUM_TEXT_EXPORT InstancedRenderer<3>;
+#endif
+
+}}
@@ -0,0 +1,177 @@
+#ifndef Magnum_Text_InstancedRenderer_h
+#define Magnum_Text_InstancedRenderer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file Text/InstancedRenderer.h
+ * @brief Class @ref Magnum::Text::InstancedRenderer, typedef @ref Magnum::Text::InstancedRenderer2D, @ref Magnum::Text::InstancedRenderer3D
+ */
+
+#include <string>
+#include <vector>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Text/Text.h"
+#include "Magnum/Text/Alignment.h"
+#include "Magnum/Text/visibility.h"
+
+namespace Magnum { namespace Text {
+
+/**
+@brief Instanced text renderer
+
+Similar to @ref Renderer, but instead of four vertices and six indices per
+glyph it generates just a single instance record containing glyph position,
+glyph texture coordinates and color. The quad is then expanded in the vertex
+shader from a static unit quad shared by all glyphs, so the index buffer
+doesn't need to be regenerated when the capacity changes and roughly half the
+data needs to be uploaded for each text change. Each @ref render() call can
+also specify a different text color, which is baked into the instance data.
+
+The mesh is meant to be drawn with @ref Shaders::InstancedVector.
+
+## Usage
+
+@code
+std::unique_ptr<Text::AbstractFont> font;
+Text::GlyphCache cache;
+Shaders::InstancedVector2D shader;
+
+// Initialize renderer and reserve memory for enough glyphs
+Text::InstancedRenderer2D renderer(*font, cache, 0.15f, Text::Alignment::LineCenter);
+renderer.reserve(32, BufferUsage::DynamicDraw);
+
+// Update the text occasionally
+renderer.render("Hello World Countdown: 10", Color4{1.0f, 0.5f, 0.0f});
+
+// Draw the text on the screen
+shader.setTransformationProjectionMatrix(projection)
+    .setVectorTexture(cache.texture());
+renderer.mesh().draw(shader);
+@endcode
+
+## Required OpenGL functionality
+
+Instanced text rendering requires @extension{ARB,instanced_arrays} on desktop
+OpenGL (also part of OpenGL 3.3). In OpenGL ES 2.0 one of
+@es_extension{ANGLE,instanced_arrays}, @es_extension{EXT,instanced_arrays} or
+@es_extension{NV,instanced_arrays} is required, in WebGL 1.0
+@webgl_extension{ANGLE,instanced_arrays}. Unlike @ref Renderer, buffer mapping
+is not needed.
+
+@requires_gl33 Extension @extension{ARB,instanced_arrays}
+@requires_gles30 Extension @es_extension{ANGLE,instanced_arrays},
+    @es_extension{EXT,instanced_arrays} or
+    @es_extension{NV,instanced_arrays} in OpenGL ES 2.0.
+@requires_webgl20 Extension @webgl_extension{ANGLE,instanced_arrays} in
+    WebGL 1.0.
+
+@see @ref InstancedRenderer2D, @ref InstancedRenderer3D
+*/
+template<UnsignedInt dimensions> class MAGNUM_TEXT_EXPORT InstancedRenderer {
+    public:
+        /**
+         * @brief Constructor
+         * @param font          Font
+         * @param cache         Glyph cache
+         * @param size          Font size
+         * @param alignment     Text alignment
+         */
+        explicit InstancedRenderer(AbstractFont& font, const GlyphCache& cache, Float size, Alignment alignment = Alignment::LineLeft);
+        InstancedRenderer(AbstractFont&, GlyphCache&&, Float, Alignment alignment = Alignment::LineLeft) = delete; /**< @overload */
+
+        ~InstancedRenderer();
+
+        /**
+         * @brief Capacity for rendered glyphs
+         *
+         * @see @ref reserve()
+         */
+        UnsignedInt capacity() const { return _capacity; }
+
+        /** @brief Rectangle spanning the rendered text */
+        Range2D rectangle() const { return _rectangle; }
+
+        /** @brief Per-glyph instance buffer */
+        Buffer& instanceBuffer() { return _instanceBuffer; }
+
+        /** @brief Mesh */
+        Mesh& mesh() { return _mesh; }
+
+        /**
+         * @brief Reserve capacity for rendered glyphs
+         *
+         * Reallocates the instance buffer to hold @p glyphCount glyphs.
+         * Consider using appropriate @p usage if the text will be changed
+         * frequently. Unlike @ref Renderer::reserve(), the index buffer is
+         * independent of the capacity and doesn't need to be refilled.
+         *
+         * Initially zero capacity is reserved.
+         * @see @ref capacity()
+         */
+        void reserve(UnsignedInt glyphCount, BufferUsage usage);
+
+        /**
+         * @brief Render text
+         *
+         * Renders the text to the instance buffer with given @p color.
+         * Rectangle spanning the rendered text is available through
+         * @ref rectangle().
+         *
+         * Initially no text is rendered.
+         * @attention The capacity must be large enough to contain all glyphs,
+         *      see @ref reserve() for more information.
+         */
+        void render(const std::string& text, const Color4& color = Color4{1.0f});
+
+    private:
+        struct Instance {
+            Range2D position, textureCoordinates;
+            Color4ub color;
+        };
+
+        Mesh _mesh;
+        Buffer _cornerBuffer, _indexBuffer, _instanceBuffer;
+        AbstractFont& _font;
+        const GlyphCache& _cache;
+        Float _size;
+        Alignment _alignment;
+        UnsignedInt _capacity;
+        Range2D _rectangle;
+        std::vector<Instance> _instances;
+};
+
+/** @brief Two-dimensional instanced text renderer */
+typedef InstancedRenderer<2> InstancedRenderer2D;
+
+/** @brief Three-dimensional instanced text renderer */
+typedef InstancedRenderer<3> InstancedRenderer3D;
+
+}}
+
+#endif
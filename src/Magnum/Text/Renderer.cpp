@@ -27,10 +27,15 @@
 
 #include "Magnum/Context.h"
 #include "Magnum/Extensions.h"
+#include "Magnum/Instrumentation.h"
 #include "Magnum/Mesh.h"
 #include "Magnum/Math/Functions.h"
 #include "Magnum/Shaders/AbstractVector.h"
 #include "Magnum/Text/AbstractFont.h"
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/Text/GlyphCacheArray.h"
+#endif
+#include "Magnum/Text/Implementation/GlyphQuads.h"
 
 namespace Magnum { namespace Text {
 
@@ -56,23 +61,24 @@ template<class T> void createIndices(void* output, const UnsignedInt glyphCount)
     }
 }
 
-struct Vertex {
-    Vector2 position, textureCoordinates;
-};
+}
 
-std::tuple<std::vector<Vertex>, Range2D> renderVerticesInternal(AbstractFont& font, const GlyphCache& cache, const Float size, const std::string& text, const Alignment alignment) {
+namespace Implementation {
+
+Range2D renderGlyphQuads(AbstractFont& font, const GlyphCache& cache, const Float size, const std::string& text, const Alignment alignment, std::vector<GlyphQuad>& quads) {
     /* Output data, reserve memory as when the text would be ASCII-only. In
-       reality the actual vertex count will be smaller, but allocating more at
-       once is better than reallocating many times later. */
-    std::vector<Vertex> vertices;
-    vertices.reserve(text.size()*4);
+       reality the actual glyph count will be smaller, but allocating more at
+       once is better than reallocating many times later. The vector might be
+       reused from previous calls, so the reservation is a no-op then. */
+    quads.clear();
+    quads.reserve(text.size());
 
     /* Total rendered bounds, intial line position, line increment, last+1
-       vertex on previous line */
+       quad on previous line */
     Range2D rectangle;
     Vector2 linePosition;
     const Vector2 lineAdvance = Vector2::yAxis(font.lineHeight()*size/font.size());
-    std::size_t lastLineLastVertex = 0;
+    std::size_t lastLineLastQuad = 0;
 
     /* Temp buffer so we don't allocate for each new line */
     /**
@@ -98,7 +104,7 @@ std::tuple<std::vector<Vertex>, Range2D> renderVerticesInternal(AbstractFont& fo
            arise when the layouter decides to compose one character from more
            than one glyph (i.e. accents). Will remove the assert when this
            issue arises. */
-        CORRADE_INTERNAL_ASSERT(vertices.size() + layouter->glyphCount()*4 <= vertices.capacity());
+        CORRADE_INTERNAL_ASSERT(quads.size() + layouter->glyphCount() <= quads.capacity());
 
         /* Bounds of rendered line */
         Range2D lineRectangle;
@@ -106,21 +112,9 @@ std::tuple<std::vector<Vertex>, Range2D> renderVerticesInternal(AbstractFont& fo
         /* Render all glyphs */
         Vector2 cursorPosition(linePosition);
         for(UnsignedInt i = 0; i != layouter->glyphCount(); ++i) {
-            Range2D quadPosition, textureCoordinates;
-            std::tie(quadPosition, textureCoordinates) = layouter->renderGlyph(i, cursorPosition, lineRectangle);
-
-            /* 0---2
-               |   |
-               |   |
-               |   |
-               1---3 */
-
-            vertices.insert(vertices.end(), {
-                {quadPosition.topLeft(), textureCoordinates.topLeft()},
-                {quadPosition.bottomLeft(), textureCoordinates.bottomLeft()},
-                {quadPosition.topRight(), textureCoordinates.topRight()},
-                {quadPosition.bottomRight(), textureCoordinates.bottomRight()}
-            });
+            GlyphQuad quad;
+            std::tie(quad.position, quad.textureCoordinates) = layouter->renderGlyph(i, cursorPosition, lineRectangle);
+            quads.push_back(quad);
         }
 
         /** @todo What about top-down text? */
@@ -138,8 +132,8 @@ std::tuple<std::vector<Vertex>, Range2D> renderVerticesInternal(AbstractFont& fo
 
         /* Align positions and bounds on current line */
         lineRectangle = lineRectangle.translated(Vector2::xAxis(alignmentOffsetX));
-        for(auto it = vertices.begin()+lastLineLastVertex; it != vertices.end(); ++it)
-            it->position.x() += alignmentOffsetX;
+        for(auto it = quads.begin()+lastLineLastQuad; it != quads.end(); ++it)
+            it->position = it->position.translated(Vector2::xAxis(alignmentOffsetX));
 
         /* Add final line bounds to total bounds, similarly to AbstractFont::renderGlyph() */
         if(!rectangle.size().isZero()) {
@@ -150,7 +144,7 @@ std::tuple<std::vector<Vertex>, Range2D> renderVerticesInternal(AbstractFont& fo
     /* Move to next line */
     } while(prevPos = pos+1,
             linePosition -= lineAdvance,
-            lastLineLastVertex = vertices.size(),
+            lastLineLastQuad = quads.size(),
             pos != std::string::npos);
 
     /* Vertically align the rendered text */
@@ -166,12 +160,13 @@ std::tuple<std::vector<Vertex>, Range2D> renderVerticesInternal(AbstractFont& fo
 
     /* Align positions and bounds */
     rectangle = rectangle.translated(Vector2::yAxis(alignmentOffsetY));
-    for(auto& v: vertices) v.position.y() += alignmentOffsetY;
+    for(GlyphQuad& quad: quads)
+        quad.position = quad.position.translated(Vector2::yAxis(alignmentOffsetY));
 
-    return std::make_tuple(std::move(vertices), rectangle);
+    return rectangle;
 }
 
-std::pair<Containers::Array<char>, Mesh::IndexType> renderIndicesInternal(const UnsignedInt glyphCount) {
+std::pair<Containers::Array<char>, Mesh::IndexType> renderGlyphQuadIndices(const UnsignedInt glyphCount) {
     const UnsignedInt vertexCount = glyphCount*4;
     const UnsignedInt indexCount = glyphCount*6;
 
@@ -194,11 +189,75 @@ std::pair<Containers::Array<char>, Mesh::IndexType> renderIndicesInternal(const
     return {std::move(indices), indexType};
 }
 
-std::tuple<Mesh, Range2D> renderInternal(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, Buffer& vertexBuffer, Buffer& indexBuffer, BufferUsage usage, Alignment alignment) {
-    /* Render vertices and upload them */
+}
+
+namespace {
+
+struct Vertex {
+    Vector2 position, textureCoordinates;
+};
+
+#ifndef MAGNUM_TARGET_GLES2
+struct LayeredVertex {
+    Vector2 position;
+    Vector3 textureCoordinates;
+};
+#endif
+
+std::tuple<std::vector<Vertex>, Range2D> renderVerticesInternal(AbstractFont& font, const GlyphCache& cache, const Float size, const std::string& text, const Alignment alignment) {
+    std::vector<Implementation::GlyphQuad> quads;
+    const Range2D rectangle = Implementation::renderGlyphQuads(font, cache, size, text, alignment, quads);
+
+    /* Expand each glyph quad into four vertices */
     std::vector<Vertex> vertices;
-    Range2D rectangle;
-    std::tie(vertices, rectangle) = renderVerticesInternal(font, cache, size, text, alignment);
+    vertices.reserve(quads.size()*4);
+    for(const Implementation::GlyphQuad& quad: quads) {
+        /* 0---2
+           |   |
+           |   |
+           |   |
+           1---3 */
+
+        vertices.insert(vertices.end(), {
+            {quad.position.topLeft(), quad.textureCoordinates.topLeft()},
+            {quad.position.bottomLeft(), quad.textureCoordinates.bottomLeft()},
+            {quad.position.topRight(), quad.textureCoordinates.topRight()},
+            {quad.position.bottomRight(), quad.textureCoordinates.bottomRight()}
+        });
+    }
+
+    return std::make_tuple(std::move(vertices), rectangle);
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+std::tuple<std::vector<LayeredVertex>, Range2D> renderLayeredVerticesInternal(AbstractFont& font, const GlyphCacheArray& cache, const Float size, const std::string& text, const Alignment alignment) {
+    std::vector<Implementation::GlyphQuad> quads;
+    const Range2D rectangle = Implementation::renderGlyphQuads(font, cache, size, text, alignment, quads);
+
+    /* Expand each glyph quad into four vertices. The cache has the layers
+       stacked on top of each other, so the integer part of the Y texture
+       coordinate is the layer. */
+    std::vector<LayeredVertex> vertices;
+    vertices.reserve(quads.size()*4);
+    for(const Implementation::GlyphQuad& quad: quads) {
+        const Float layer = Math::floor(quad.textureCoordinates.bottom());
+        cache.markLayerUsed(Int(layer));
+        const Range2D textureCoordinates = quad.textureCoordinates.translated(Vector2::yAxis(-layer));
+
+        vertices.insert(vertices.end(), {
+            {quad.position.topLeft(), {textureCoordinates.topLeft(), layer}},
+            {quad.position.bottomLeft(), {textureCoordinates.bottomLeft(), layer}},
+            {quad.position.topRight(), {textureCoordinates.topRight(), layer}},
+            {quad.position.bottomRight(), {textureCoordinates.bottomRight(), layer}}
+        });
+    }
+
+    return std::make_tuple(std::move(vertices), rectangle);
+}
+#endif
+
+template<class T> std::tuple<Mesh, Range2D> renderInternal(const std::vector<T>& vertices, const Range2D& rectangle, Buffer& vertexBuffer, Buffer& indexBuffer, BufferUsage usage) {
+    /* Upload the vertices */
     vertexBuffer.setData(vertices, usage);
 
     const UnsignedInt glyphCount = vertices.size()/4;
@@ -207,7 +266,7 @@ std::tuple<Mesh, Range2D> renderInternal(AbstractFont& font, const GlyphCache& c
     /* Render indices and upload them */
     Containers::Array<char> indices;
     Mesh::IndexType indexType;
-    std::tie(indices, indexType) = renderIndicesInternal(glyphCount);
+    std::tie(indices, indexType) = Implementation::renderGlyphQuadIndices(glyphCount);
     indexBuffer.setData(indices, usage);
 
     /* Configure mesh except for vertex buffer (depends on dimension count, done
@@ -220,19 +279,13 @@ std::tuple<Mesh, Range2D> renderInternal(AbstractFont& font, const GlyphCache& c
     return std::make_tuple(std::move(mesh), rectangle);
 }
 
-}
-
-std::tuple<std::vector<Vector2>, std::vector<Vector2>, std::vector<UnsignedInt>, Range2D> AbstractRenderer::render(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, Alignment alignment) {
-    /* Render vertices */
-    std::vector<Vertex> vertices;
-    Range2D rectangle;
-    std::tie(vertices, rectangle) = renderVerticesInternal(font, cache, size, text, alignment);
-
-    /* Deinterleave the vertices */
-    std::vector<Vector2> positions, textureCoordinates;
+/* Vertex data are laid out the same way for both cache types */
+template<class T> std::tuple<std::vector<Vector2>, std::vector<decltype(T::textureCoordinates)>, std::vector<UnsignedInt>, Range2D> deinterleave(const std::vector<T>& vertices, const Range2D& rectangle) {
+    std::vector<Vector2> positions;
+    std::vector<decltype(T::textureCoordinates)> textureCoordinates;
     positions.reserve(vertices.size());
-    positions.reserve(textureCoordinates.size());
-    for(const auto& v: vertices) {
+    textureCoordinates.reserve(vertices.size());
+    for(const T& v: vertices) {
         positions.push_back(v.position);
         textureCoordinates.push_back(v.textureCoordinates);
     }
@@ -245,9 +298,38 @@ std::tuple<std::vector<Vector2>, std::vector<Vector2>, std::vector<UnsignedInt>,
     return std::make_tuple(std::move(positions), std::move(textureCoordinates), std::move(indices), rectangle);
 }
 
+}
+
+std::tuple<std::vector<Vector2>, std::vector<Vector2>, std::vector<UnsignedInt>, Range2D> AbstractRenderer::render(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, Alignment alignment) {
+    /* Render vertices */
+    std::vector<Vertex> vertices;
+    Range2D rectangle;
+    std::tie(vertices, rectangle) = renderVerticesInternal(font, cache, size, text, alignment);
+
+    return deinterleave(vertices, rectangle);
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+std::tuple<std::vector<Vector2>, std::vector<Vector3>, std::vector<UnsignedInt>, Range2D> AbstractRenderer::render(AbstractFont& font, const GlyphCacheArray& cache, Float size, const std::string& text, Alignment alignment) {
+    /* Render vertices */
+    std::vector<LayeredVertex> vertices;
+    Range2D rectangle;
+    std::tie(vertices, rectangle) = renderLayeredVerticesInternal(font, cache, size, text, alignment);
+
+    return deinterleave(vertices, rectangle);
+}
+#endif
+
 template<UnsignedInt dimensions> std::tuple<Mesh, Range2D> Renderer<dimensions>::render(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, Buffer& vertexBuffer, Buffer& indexBuffer, BufferUsage usage, Alignment alignment) {
+    MAGNUM_INSTRUMENT_ZONE(Instrumentation::Zone::TextRendererRender);
+
+    /* Render vertices */
+    std::vector<Vertex> vertices;
+    Range2D rectangle;
+    std::tie(vertices, rectangle) = renderVerticesInternal(font, cache, size, text, alignment);
+
     /* Finalize mesh configuration and return the result */
-    auto r = renderInternal(font, cache, size, text, vertexBuffer, indexBuffer, usage, alignment);
+    auto r = renderInternal(vertices, rectangle, vertexBuffer, indexBuffer, usage);
     Mesh& mesh = std::get<0>(r);
     mesh.addVertexBuffer(vertexBuffer, 0,
             typename Shaders::AbstractVector<dimensions>::Position(
@@ -256,6 +338,26 @@ template<UnsignedInt dimensions> std::tuple<Mesh, Range2D> Renderer<dimensions>:
     return r;
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> std::tuple<Mesh, Range2D> Renderer<dimensions>::render(AbstractFont& font, const GlyphCacheArray& cache, Float size, const std::string& text, Buffer& vertexBuffer, Buffer& indexBuffer, BufferUsage usage, Alignment alignment) {
+    MAGNUM_INSTRUMENT_ZONE(Instrumentation::Zone::TextRendererRender);
+
+    /* Render vertices */
+    std::vector<LayeredVertex> vertices;
+    Range2D rectangle;
+    std::tie(vertices, rectangle) = renderLayeredVerticesInternal(font, cache, size, text, alignment);
+
+    /* Finalize mesh configuration and return the result */
+    auto r = renderInternal(vertices, rectangle, vertexBuffer, indexBuffer, usage);
+    Mesh& mesh = std::get<0>(r);
+    mesh.addVertexBuffer(vertexBuffer, 0,
+            typename Shaders::AbstractVector<dimensions>::Position(
+                Shaders::AbstractVector<dimensions>::Position::Components::Two),
+            typename Shaders::AbstractVector<dimensions>::TextureArrayCoordinates());
+    return r;
+}
+#endif
+
 #if defined(MAGNUM_TARGET_GLES2) && !defined(CORRADE_TARGET_EMSCRIPTEN)
 AbstractRenderer::BufferMapImplementation AbstractRenderer::bufferMapImplementation = &AbstractRenderer::bufferMapImplementationFull;
 AbstractRenderer::BufferUnmapImplementation AbstractRenderer::bufferUnmapImplementation = &AbstractRenderer::bufferUnmapImplementationDefault;
@@ -275,34 +377,32 @@ void AbstractRenderer::bufferUnmapImplementationSub(Buffer& buffer) {
 #endif
 #endif
 
-#if !defined(MAGNUM_TARGET_GLES2) || defined(CORRADE_TARGET_EMSCRIPTEN)
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#ifndef MAGNUM_TARGET_GLES2
 inline void* AbstractRenderer::bufferMapImplementation(Buffer& buffer, GLsizeiptr length)
 #else
 void* AbstractRenderer::bufferMapImplementationRange(Buffer& buffer, GLsizeiptr length)
 #endif
 {
-    #ifndef CORRADE_TARGET_EMSCRIPTEN
     return buffer.map(0, length, Buffer::MapFlag::InvalidateBuffer|Buffer::MapFlag::Write);
-    #else
-    static_cast<void>(length);
-    return &buffer == &_indexBuffer ? _indexBufferData : _vertexBufferData;
-    #endif
 }
 
-#if !defined(MAGNUM_TARGET_GLES2) || defined(CORRADE_TARGET_EMSCRIPTEN)
+#ifndef MAGNUM_TARGET_GLES2
 inline void AbstractRenderer::bufferUnmapImplementation(Buffer& buffer)
 #else
 void AbstractRenderer::bufferUnmapImplementationDefault(Buffer& buffer)
 #endif
 {
-    #ifndef CORRADE_TARGET_EMSCRIPTEN
     buffer.unmap();
-    #else
-    buffer.setSubData(0, &buffer == &_indexBuffer ? _indexBufferData : _vertexBufferData);
-    #endif
 }
+#endif
 
-AbstractRenderer::AbstractRenderer(AbstractFont& font, const GlyphCache& cache, const Float size, const Alignment alignment): _vertexBuffer{Buffer::TargetHint::Array}, _indexBuffer{Buffer::TargetHint::ElementArray}, font(font), cache(cache), size(size), _alignment(alignment), _capacity(0) {
+AbstractRenderer::AbstractRenderer(AbstractFont& font, const GlyphCache& cache, const Float size, const Alignment alignment): _vertexBuffer{Buffer::TargetHint::Array}, _indexBuffer{Buffer::TargetHint::ElementArray}, font(font), cache(cache),
+    #ifndef MAGNUM_TARGET_GLES2
+    cacheArray(nullptr),
+    #endif
+    size(size), _alignment(alignment), _capacity(0)
+{
     #ifndef MAGNUM_TARGET_GLES
     MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::ARB::map_buffer_range);
     #elif defined(MAGNUM_TARGET_GLES2) && !defined(CORRADE_TARGET_EMSCRIPTEN)
@@ -330,6 +430,12 @@ AbstractRenderer::AbstractRenderer(AbstractFont& font, const GlyphCache& cache,
     _mesh.setPrimitive(MeshPrimitive::Triangles);
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+AbstractRenderer::AbstractRenderer(AbstractFont& font, const GlyphCacheArray& cache, const Float size, const Alignment alignment): AbstractRenderer{font, static_cast<const GlyphCache&>(cache), size, alignment} {
+    cacheArray = &cache;
+}
+#endif
+
 AbstractRenderer::~AbstractRenderer() = default;
 
 template<UnsignedInt dimensions> Renderer<dimensions>::Renderer(AbstractFont& font, const GlyphCache& cache, const Float size, const Alignment alignment): AbstractRenderer(font, cache, size, alignment) {
@@ -339,61 +445,95 @@ template<UnsignedInt dimensions> Renderer<dimensions>::Renderer(AbstractFont& fo
             typename Shaders::AbstractVector<dimensions>::TextureCoordinates());
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> Renderer<dimensions>::Renderer(AbstractFont& font, const GlyphCacheArray& cache, const Float size, const Alignment alignment): AbstractRenderer(font, cache, size, alignment) {
+    /* Finalize mesh configuration */
+    _mesh.addVertexBuffer(_vertexBuffer, 0,
+            typename Shaders::AbstractVector<dimensions>::Position(Shaders::AbstractVector<dimensions>::Position::Components::Two),
+            typename Shaders::AbstractVector<dimensions>::TextureArrayCoordinates());
+}
+#endif
+
 void AbstractRenderer::reserve(const uint32_t glyphCount, const BufferUsage vertexBufferUsage, const BufferUsage indexBufferUsage) {
     _capacity = glyphCount;
 
     const UnsignedInt vertexCount = glyphCount*4;
+    #ifndef MAGNUM_TARGET_GLES2
+    const std::size_t vertexSize = cacheArray ? sizeof(LayeredVertex) : sizeof(Vertex);
+    #else
+    const std::size_t vertexSize = sizeof(Vertex);
+    #endif
 
     /* Allocate vertex buffer, reset vertex count */
-    _vertexBuffer.setData({nullptr, vertexCount*sizeof(Vertex)}, vertexBufferUsage);
-    #ifdef CORRADE_TARGET_EMSCRIPTEN
-    _vertexBufferData = Containers::Array<UnsignedByte>(vertexCount*sizeof(Vertex));
-    #endif
+    _vertexBuffer.setData({nullptr, vertexCount*vertexSize}, vertexBufferUsage);
     _mesh.setCount(0);
 
     /* Render indices */
     Containers::Array<char> indexData;
     Mesh::IndexType indexType;
-    std::tie(indexData, indexType) = renderIndicesInternal(glyphCount);
+    std::tie(indexData, indexType) = Implementation::renderGlyphQuadIndices(glyphCount);
 
-    /* Allocate index buffer, reset index count and reconfigure buffer binding */
+    /* Allocate and fill index buffer. On Emscripten there's no mapping, so
+       upload the data directly instead of copying them to a staging array
+       first. */
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
     _indexBuffer.setData({nullptr, indexData.size()}, indexBufferUsage);
-    #ifdef CORRADE_TARGET_EMSCRIPTEN
-    _indexBufferData = Containers::Array<UnsignedByte>(indexData.size());
-    #endif
-    _mesh.setCount(0)
-        .setIndexBuffer(_indexBuffer, 0, indexType, 0, vertexCount);
-
-    /* Prefill index buffer */
     char* const indices = static_cast<char*>(bufferMapImplementation(_indexBuffer, indexData.size()));
     CORRADE_INTERNAL_ASSERT(indices);
-    /** @todo Emscripten: it can be done without this copying altogether */
     std::copy(indexData.begin(), indexData.end(), indices);
     bufferUnmapImplementation(_indexBuffer);
+    #else
+    _indexBuffer.setData(indexData, indexBufferUsage);
+    #endif
+
+    /* Reset index count and reconfigure buffer binding */
+    _mesh.setCount(0)
+        .setIndexBuffer(_indexBuffer, 0, indexType, 0, vertexCount);
 }
 
 void AbstractRenderer::render(const std::string& text) {
-    /* Render vertex data */
-    std::vector<Vertex> vertexData;
+    MAGNUM_INSTRUMENT_ZONE(Instrumentation::Zone::TextRendererRender);
+
+    /* Render vertex data and copy it into the mapped buffer */
     _rectangle = {};
-    std::tie(vertexData, _rectangle) = renderVerticesInternal(font, cache, size, text, _alignment);
+    UnsignedInt glyphCount;
+    #ifndef MAGNUM_TARGET_GLES2
+    if(cacheArray) {
+        std::vector<LayeredVertex> vertexData;
+        std::tie(vertexData, _rectangle) = renderLayeredVerticesInternal(font, *cacheArray, size, text, _alignment);
+        glyphCount = vertexData.size()/4;
+        if(!uploadVertices({reinterpret_cast<const char*>(vertexData.data()), vertexData.size()*sizeof(LayeredVertex)}, glyphCount)) return;
+    } else
+    #endif
+    {
+        std::vector<Vertex> vertexData;
+        std::tie(vertexData, _rectangle) = renderVerticesInternal(font, cache, size, text, _alignment);
+        glyphCount = vertexData.size()/4;
+        if(!uploadVertices({reinterpret_cast<const char*>(vertexData.data()), vertexData.size()*sizeof(Vertex)}, glyphCount)) return;
+    }
 
-    const UnsignedInt glyphCount = vertexData.size()/4;
-    const UnsignedInt vertexCount = glyphCount*4;
     const UnsignedInt indexCount = glyphCount*6;
 
+    /* Update index count */
+    _mesh.setCount(indexCount);
+}
+
+bool AbstractRenderer::uploadVertices(const Containers::ArrayView<const char> vertexData, const UnsignedInt glyphCount) {
     CORRADE_ASSERT(glyphCount <= _capacity,
-        "Text::Renderer::render(): capacity" << _capacity << "too small to render" << glyphCount << "glyphs", );
+        "Text::Renderer::render(): capacity" << _capacity << "too small to render" << glyphCount << "glyphs", false);
 
-    /* Interleave the data into mapped buffer*/
-    Containers::ArrayView<Vertex> vertices(static_cast<Vertex*>(bufferMapImplementation(_vertexBuffer,
-        vertexCount*sizeof(Vertex))), vertexCount);
+    /* Copy the interleaved data into mapped buffer. On Emscripten upload
+       just the used part in a single call straight from the heap, as every
+       copy and every call crossing to JavaScript is expensive there. */
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    char* const vertices = static_cast<char*>(bufferMapImplementation(_vertexBuffer, vertexData.size()));
     CORRADE_INTERNAL_ASSERT_OUTPUT(vertices);
-    std::copy(vertexData.begin(), vertexData.end(), vertices.begin());
+    std::copy(vertexData.begin(), vertexData.end(), vertices);
     bufferUnmapImplementation(_vertexBuffer);
-
-    /* Update index count */
-    _mesh.setCount(indexCount);
+    #else
+    _vertexBuffer.setSubData(0, vertexData);
+    #endif
+    return true;
 }
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
@@ -64,6 +64,20 @@ class MAGNUM_TEXT_EXPORT AbstractRenderer {
          */
         static std::tuple<std::vector<Vector2>, std::vector<Vector2>, std::vector<UnsignedInt>, Range2D> render(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, Alignment alignment = Alignment::LineLeft);
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Render text using layered glyph cache
+         *
+         * Same as above, but the texture coordinates have the glyph cache
+         * layer in the last component. Marks all layers used by the text as
+         * used, see @ref GlyphCacheArray::markLayerUsed().
+         * @requires_gl30 Extension @extension{EXT,texture_array}
+         * @requires_gles30 Array textures are not available in OpenGL ES 2.0.
+         * @requires_webgl20 Array textures are not available in WebGL 1.0.
+         */
+        static std::tuple<std::vector<Vector2>, std::vector<Vector3>, std::vector<UnsignedInt>, Range2D> render(AbstractFont& font, const GlyphCacheArray& cache, Float size, const std::string& text, Alignment alignment = Alignment::LineLeft);
+        #endif
+
         /**
          * @brief Capacity for rendered glyphs
          *
@@ -116,18 +130,22 @@ class MAGNUM_TEXT_EXPORT AbstractRenderer {
     private:
     #endif
         explicit MAGNUM_TEXT_LOCAL AbstractRenderer(AbstractFont& font, const GlyphCache& cache, Float size, Alignment alignment);
+        #ifndef MAGNUM_TARGET_GLES2
+        explicit MAGNUM_TEXT_LOCAL AbstractRenderer(AbstractFont& font, const GlyphCacheArray& cache, Float size, Alignment alignment);
+        #endif
 
         ~AbstractRenderer();
 
         Mesh _mesh;
         Buffer _vertexBuffer, _indexBuffer;
-        #ifdef CORRADE_TARGET_EMSCRIPTEN
-        Containers::Array<UnsignedByte> _vertexBufferData, _indexBufferData;
-        #endif
 
     private:
         AbstractFont& font;
         const GlyphCache& cache;
+        #ifndef MAGNUM_TARGET_GLES2
+        /* Non-null if the cache is layered */
+        const GlyphCacheArray* cacheArray;
+        #endif
         Float size;
         Alignment _alignment;
         UnsignedInt _capacity;
@@ -141,15 +159,14 @@ class MAGNUM_TEXT_EXPORT AbstractRenderer {
         #endif
         static MAGNUM_TEXT_LOCAL void* bufferMapImplementationRange(Buffer& buffer, GLsizeiptr length);
         static BufferMapImplementation bufferMapImplementation;
-        #else
-        #ifndef CORRADE_TARGET_EMSCRIPTEN
-        static
-        #else
-        MAGNUM_TEXT_LOCAL
-        #endif
-        void* bufferMapImplementation(Buffer& buffer, GLsizeiptr length);
+        #elif !defined(CORRADE_TARGET_EMSCRIPTEN)
+        static void* bufferMapImplementation(Buffer& buffer, GLsizeiptr length);
         #endif
 
+        /* Copies interleaved vertex data into the mapped vertex buffer,
+           returns false if the capacity is too small */
+        MAGNUM_TEXT_LOCAL bool uploadVertices(Containers::ArrayView<const char> vertexData, UnsignedInt glyphCount);
+
         #if defined(MAGNUM_TARGET_GLES2) && !defined(CORRADE_TARGET_EMSCRIPTEN)
         typedef void(*BufferUnmapImplementation)(Buffer&);
         static MAGNUM_TEXT_LOCAL void bufferUnmapImplementationDefault(Buffer& buffer);
@@ -157,13 +174,8 @@ class MAGNUM_TEXT_EXPORT AbstractRenderer {
         static MAGNUM_TEXT_LOCAL void bufferUnmapImplementationSub(Buffer& buffer);
         #endif
         static MAGNUM_TEXT_LOCAL BufferUnmapImplementation bufferUnmapImplementation;
-        #else
-        #ifndef CORRADE_TARGET_EMSCRIPTEN
-        static
-        #else
-        MAGNUM_TEXT_LOCAL
-        #endif
-        void bufferUnmapImplementation(Buffer& buffer);
+        #elif !defined(CORRADE_TARGET_EMSCRIPTEN)
+        static void bufferUnmapImplementation(Buffer& buffer);
         #endif
 };
 
@@ -226,6 +238,14 @@ shader.setTransformationProjectionMatrix(projection)
 renderer.mesh().draw(shader);
 @endcode
 
+## Layered glyph caches
+
+If the renderer is given a @ref GlyphCacheArray, the vertex data contain
+@ref Shaders::AbstractVector::TextureArrayCoordinates with the glyph cache
+layer in the last component instead of 2D texture coordinates. Such a mesh is
+meant to be drawn with @ref Shaders::Vector or @ref Shaders::DistanceFieldVector
+created with the `TextureArrays` flag. See @ref GlyphCacheArray for an example.
+
 ## Required OpenGL functionality
 
 Mutable text rendering requires @extension{ARB,map_buffer_range} on desktop
@@ -256,6 +276,20 @@ template<UnsignedInt dimensions> class MAGNUM_TEXT_EXPORT Renderer: public Abstr
          */
         static std::tuple<Mesh, Range2D> render(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, Buffer& vertexBuffer, Buffer& indexBuffer, BufferUsage usage, Alignment alignment = Alignment::LineLeft);
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Render text using layered glyph cache
+         *
+         * Same as above, but the returned mesh has
+         * @ref Shaders::AbstractVector::TextureArrayCoordinates instead of
+         * @ref Shaders::AbstractVector::TextureCoordinates.
+         * @requires_gl30 Extension @extension{EXT,texture_array}
+         * @requires_gles30 Array textures are not available in OpenGL ES 2.0.
+         * @requires_webgl20 Array textures are not available in WebGL 1.0.
+         */
+        static std::tuple<Mesh, Range2D> render(AbstractFont& font, const GlyphCacheArray& cache, Float size, const std::string& text, Buffer& vertexBuffer, Buffer& indexBuffer, BufferUsage usage, Alignment alignment = Alignment::LineLeft);
+        #endif
+
         /**
          * @brief Constructor
          * @param font          Font
@@ -266,6 +300,21 @@ template<UnsignedInt dimensions> class MAGNUM_TEXT_EXPORT Renderer: public Abstr
         explicit Renderer(AbstractFont& font, const GlyphCache& cache, Float size, Alignment alignment = Alignment::LineLeft);
         Renderer(AbstractFont&, GlyphCache&&, Float, Alignment alignment = Alignment::LineLeft) = delete; /**< @overload */
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Construct with layered glyph cache
+         *
+         * The mesh is configured with
+         * @ref Shaders::AbstractVector::TextureArrayCoordinates, see
+         * @ref GlyphCacheArray for more information.
+         * @requires_gl30 Extension @extension{EXT,texture_array}
+         * @requires_gles30 Array textures are not available in OpenGL ES 2.0.
+         * @requires_webgl20 Array textures are not available in WebGL 1.0.
+         */
+        explicit Renderer(AbstractFont& font, const GlyphCacheArray& cache, Float size, Alignment alignment = Alignment::LineLeft);
+        Renderer(AbstractFont&, GlyphCacheArray&&, Float, Alignment alignment = Alignment::LineLeft) = delete; /**< @overload */
+        #endif
+
         using AbstractRenderer::render;
 };
 
@@ -27,6 +27,7 @@
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/Directory.h>
 
+#include "Magnum/Math/Range.h"
 #include "Magnum/Math/Vector2.h"
 #include "Magnum/Text/AbstractFont.h"
 
@@ -39,11 +40,23 @@ struct AbstractFontTest: TestSuite::Tester {
 
     void openSingleData();
     void openFile();
+
+    void layoutCacheDisabled();
+    void layoutCache();
+    void layoutCacheKey();
+    void layoutCacheEviction();
+    void layoutCacheClear();
 };
 
 AbstractFontTest::AbstractFontTest() {
     addTests({&AbstractFontTest::openSingleData,
-              &AbstractFontTest::openFile});
+              &AbstractFontTest::openFile,
+
+              &AbstractFontTest::layoutCacheDisabled,
+              &AbstractFontTest::layoutCache,
+              &AbstractFontTest::layoutCacheKey,
+              &AbstractFontTest::layoutCacheEviction,
+              &AbstractFontTest::layoutCacheClear});
 }
 
 namespace {
@@ -72,6 +85,46 @@ class SingleDataFont: public Text::AbstractFont {
         bool opened;
 };
 
+class CountingLayouter: public Text::AbstractLayouter {
+    public:
+        explicit CountingLayouter(Float size, std::size_t glyphCount): AbstractLayouter(glyphCount), _size(size) {}
+
+    private:
+        std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(UnsignedInt i) override {
+            return std::make_tuple(
+                Range2D({}, Vector2(3.0f, 2.0f)*((i+1)*_size)),
+                Range2D::fromSize({i*6.0f, 0.0f}, {6.0f, 10.0f}),
+                Vector2::xAxis((i+1)*3.0f*_size)
+            );
+        }
+
+        Float _size;
+};
+
+class CountingFont: public Text::AbstractFont {
+    public:
+        Features doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return opened; }
+        void doClose() override { opened = false; }
+
+        UnsignedInt doGlyphId(char32_t) override { return 0; }
+
+        Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+
+        std::unique_ptr<AbstractLayouter> doLayout(const GlyphCache&, Float size, const std::string& text) override {
+            ++layoutCount;
+            return std::unique_ptr<AbstractLayouter>(new CountingLayouter(size, text.size()));
+        }
+
+        bool opened = true;
+        Int layoutCount = 0;
+};
+
+/* The cache pointer is used only as a key */
+char glyphCacheData[2];
+GlyphCache& glyphCacheA = *reinterpret_cast<GlyphCache*>(glyphCacheData + 0);
+GlyphCache& glyphCacheB = *reinterpret_cast<GlyphCache*>(glyphCacheData + 1);
+
 }
 
 void AbstractFontTest::openSingleData() {
@@ -91,6 +144,114 @@ void AbstractFontTest::openFile() {
     CORRADE_VERIFY(font.isOpened());
 }
 
+void AbstractFontTest::layoutCacheDisabled() {
+    CountingFont font;
+    CORRADE_COMPARE(font.layoutCacheCapacity(), 0);
+
+    font.layout(glyphCacheA, 1.0f, "abc");
+    font.layout(glyphCacheA, 1.0f, "abc");
+    CORRADE_COMPARE(font.layoutCount, 2);
+    CORRADE_COMPARE(font.layoutCacheSize(), 0);
+    CORRADE_COMPARE(font.layoutCacheHits(), 0);
+    CORRADE_COMPARE(font.layoutCacheMisses(), 0);
+}
+
+void AbstractFontTest::layoutCache() {
+    CountingFont font;
+    font.setLayoutCacheCapacity(4);
+    CORRADE_COMPARE(font.layoutCacheCapacity(), 4);
+
+    std::unique_ptr<AbstractLayouter> first = font.layout(glyphCacheA, 0.5f, "abc");
+    std::unique_ptr<AbstractLayouter> second = font.layout(glyphCacheA, 0.5f, "abc");
+    CORRADE_COMPARE(font.layoutCount, 1);
+    CORRADE_COMPARE(font.layoutCacheSize(), 1);
+    CORRADE_COMPARE(font.layoutCacheHits(), 1);
+    CORRADE_COMPARE(font.layoutCacheMisses(), 1);
+
+    /* Both layouters produce the same output as the plugin would */
+    CORRADE_COMPARE(first->glyphCount(), 3);
+    CORRADE_COMPARE(second->glyphCount(), 3);
+    Vector2 cursorFirst, cursorSecond;
+    Range2D rectangleFirst, rectangleSecond;
+    for(UnsignedInt i = 0; i != 3; ++i) {
+        std::pair<Range2D, Range2D> a = first->renderGlyph(i, cursorFirst, rectangleFirst);
+        std::pair<Range2D, Range2D> b = second->renderGlyph(i, cursorSecond, rectangleSecond);
+        CORRADE_COMPARE(a.first, b.first);
+        CORRADE_COMPARE(a.second, b.second);
+    }
+    CORRADE_COMPARE(cursorFirst, (Vector2{9.0f, 0.0f}));
+    CORRADE_COMPARE(cursorSecond, (Vector2{9.0f, 0.0f}));
+    CORRADE_COMPARE(rectangleFirst, (Range2D{{0.0f, 0.0f}, {9.0f, 3.0f}}));
+    CORRADE_COMPARE(rectangleSecond, (Range2D{{0.0f, 0.0f}, {9.0f, 3.0f}}));
+}
+
+void AbstractFontTest::layoutCacheKey() {
+    CountingFont font;
+    font.setLayoutCacheCapacity(4);
+
+    /* Different text, size or glyph cache is a miss */
+    font.layout(glyphCacheA, 1.0f, "abc");
+    font.layout(glyphCacheA, 1.0f, "abd");
+    font.layout(glyphCacheA, 2.0f, "abc");
+    font.layout(glyphCacheB, 1.0f, "abc");
+    CORRADE_COMPARE(font.layoutCount, 4);
+    CORRADE_COMPARE(font.layoutCacheSize(), 4);
+    CORRADE_COMPARE(font.layoutCacheHits(), 0);
+    CORRADE_COMPARE(font.layoutCacheMisses(), 4);
+}
+
+void AbstractFontTest::layoutCacheEviction() {
+    CountingFont font;
+    font.setLayoutCacheCapacity(2);
+
+    font.layout(glyphCacheA, 1.0f, "a");
+    font.layout(glyphCacheA, 1.0f, "b");
+
+    /* Makes "a" most recently used, so "b" gets evicted by "c" */
+    font.layout(glyphCacheA, 1.0f, "a");
+    font.layout(glyphCacheA, 1.0f, "c");
+    CORRADE_COMPARE(font.layoutCount, 3);
+    CORRADE_COMPARE(font.layoutCacheSize(), 2);
+
+    font.layout(glyphCacheA, 1.0f, "a");
+    CORRADE_COMPARE(font.layoutCount, 3);
+    font.layout(glyphCacheA, 1.0f, "b");
+    CORRADE_COMPARE(font.layoutCount, 4);
+    CORRADE_COMPARE(font.layoutCacheHits(), 2);
+    CORRADE_COMPARE(font.layoutCacheMisses(), 4);
+
+    /* Shrinking the capacity evicts the least recently used */
+    font.setLayoutCacheCapacity(1);
+    CORRADE_COMPARE(font.layoutCacheSize(), 1);
+    font.layout(glyphCacheA, 1.0f, "b");
+    CORRADE_COMPARE(font.layoutCount, 4);
+
+    /* Disabling resets everything */
+    font.setLayoutCacheCapacity(0);
+    CORRADE_COMPARE(font.layoutCacheSize(), 0);
+    CORRADE_COMPARE(font.layoutCacheHits(), 0);
+    CORRADE_COMPARE(font.layoutCacheMisses(), 0);
+}
+
+void AbstractFontTest::layoutCacheClear() {
+    CountingFont font;
+    font.setLayoutCacheCapacity(4);
+
+    font.layout(glyphCacheA, 1.0f, "a");
+    font.clearLayoutCache();
+    CORRADE_COMPARE(font.layoutCacheSize(), 0);
+    CORRADE_COMPARE(font.layoutCacheMisses(), 1);
+
+    font.layout(glyphCacheA, 1.0f, "a");
+    CORRADE_COMPARE(font.layoutCount, 2);
+    CORRADE_COMPARE(font.layoutCacheSize(), 1);
+
+    /* Closing the font clears the cache as well */
+    font.close();
+    CORRADE_COMPARE(font.layoutCacheSize(), 0);
+    CORRADE_COMPARE(font.layoutCacheCapacity(), 4);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Text::Test::AbstractFontTest)
@@ -0,0 +1,303 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/Text/AbstractFont.h"
+#include "Magnum/Text/BatchRenderer.h"
+
+namespace Magnum { namespace Text { namespace Test {
+
+struct BatchRendererGLTest: OpenGLTester {
+    explicit BatchRendererGLTest();
+
+    void construct();
+    void add();
+    void setTextInPlace();
+    void setTextRelocate();
+    void setTransformationColor();
+    void removeReuse();
+    void compact();
+    void render3D();
+};
+
+BatchRendererGLTest::BatchRendererGLTest() {
+    addTests({&BatchRendererGLTest::construct,
+              &BatchRendererGLTest::add,
+              &BatchRendererGLTest::setTextInPlace,
+              &BatchRendererGLTest::setTextRelocate,
+              &BatchRendererGLTest::setTransformationColor,
+              &BatchRendererGLTest::removeReuse,
+              &BatchRendererGLTest::compact,
+              &BatchRendererGLTest::render3D});
+}
+
+namespace {
+
+class TestLayouter: public Text::AbstractLayouter {
+    public:
+        explicit TestLayouter(Float size, std::size_t glyphCount): AbstractLayouter(glyphCount), _size(size) {}
+
+    private:
+        std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(UnsignedInt i) override {
+            return std::make_tuple(
+                Range2D({}, Vector2(3.0f, 2.0f)*((i+1)*_size)),
+                Range2D::fromSize({i*6.0f, 0.0f}, {6.0f, 10.0f}),
+                (Vector2::xAxis((i+1)*3.0f)+Vector2(1.0f, -1.0f))*_size
+            );
+        }
+
+        Float _size;
+};
+
+class TestFont: public Text::AbstractFont {
+    Features doFeatures() const override { return Feature::OpenData; }
+
+    bool doIsOpened() const override { return true; }
+    void doClose() override {}
+
+    UnsignedInt doGlyphId(char32_t) override { return 0; }
+    Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+
+    std::unique_ptr<AbstractLayouter> doLayout(const GlyphCache&, const Float size, const std::string& text) override {
+        return std::unique_ptr<AbstractLayouter>(new TestLayouter(size, text.size()));
+    }
+};
+
+/* *static_cast<GlyphCache*>(nullptr) makes Clang Analyzer grumpy */
+char glyphCacheData;
+GlyphCache& nullGlyphCache = *reinterpret_cast<GlyphCache*>(&glyphCacheData);
+
+}
+
+void BatchRendererGLTest::construct() {
+    TestFont font;
+    Text::BatchRenderer2D batch{font, nullGlyphCache, 0.25f};
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE(batch.textCount(), 0);
+    CORRADE_COMPARE(batch.glyphCount(), 0);
+    CORRADE_COMPARE(batch.quadCount(), 0);
+
+    /* Nothing to upload */
+    batch.upload();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(batch.mesh().count(), 0);
+}
+
+void BatchRendererGLTest::add() {
+    TestFont font;
+    Text::BatchRenderer2D batch{font, nullGlyphCache, 0.25f};
+
+    CORRADE_COMPARE(batch.add("abc", Matrix3::translation({10.0f, 0.0f}), Color4{1.0f, 0.0f, 0.0f, 1.0f}), 0);
+    CORRADE_COMPARE(batch.add("ab", {}, Color4{1.0f}, Alignment::LineRight), 1);
+    CORRADE_COMPARE(batch.textCount(), 2);
+    CORRADE_COMPARE(batch.glyphCount(), 5);
+    CORRADE_COMPARE(batch.quadCount(), 5);
+
+    /* Rectangles are without the transformation, but with alignment */
+    CORRADE_COMPARE(batch.rectangle(0), Range2D({0.0f, -0.5f}, {5.0f, 1.0f}));
+    CORRADE_COMPARE(batch.rectangle(1), Range2D({-2.5f, -0.25f}, {0.0f, 0.75f}));
+
+    batch.upload();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(batch.mesh().count(), 30);
+
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    /* Position, texture coordinates and four color bytes for each vertex */
+    Containers::Array<Float> vertices = batch.vertexBuffer().subData<Float>(0, 25*5);
+
+    /* First vertex of the first text, translated */
+    CORRADE_COMPARE(Vector2(vertices[0], vertices[1]), (Vector2{10.0f, 0.5f}));
+    CORRADE_COMPARE(Vector2(vertices[2], vertices[3]), (Vector2{0.0f, 10.0f}));
+
+    /* Last vertex of the first text */
+    CORRADE_COMPARE(Vector2(vertices[11*5], vertices[11*5 + 1]), (Vector2{15.0f, -0.5f}));
+
+    /* First vertex of the second text, right-aligned */
+    CORRADE_COMPARE(Vector2(vertices[12*5], vertices[12*5 + 1]), (Vector2{-2.5f, 0.5f}));
+
+    /* Color of the first and of the second text */
+    Containers::Array<UnsignedByte> colors = batch.vertexBuffer().subData<UnsignedByte>(16, 4);
+    CORRADE_COMPARE(Color4ub(colors[0], colors[1], colors[2], colors[3]), (Color4ub{255, 0, 0, 255}));
+    colors = batch.vertexBuffer().subData<UnsignedByte>(12*20 + 16, 4);
+    CORRADE_COMPARE(Color4ub(colors[0], colors[1], colors[2], colors[3]), (Color4ub{255, 255, 255, 255}));
+    #endif
+}
+
+void BatchRendererGLTest::setTextInPlace() {
+    TestFont font;
+    Text::BatchRenderer2D batch{font, nullGlyphCache, 0.25f};
+
+    const UnsignedInt id = batch.add("abc", {});
+    batch.upload();
+
+    /* Shorter text is updated in place, the rest is made degenerate */
+    batch.setText(id, "a");
+    CORRADE_COMPARE(batch.glyphCount(), 1);
+    CORRADE_COMPARE(batch.quadCount(), 3);
+    CORRADE_COMPARE(batch.rectangle(id), Range2D({0.0f, 0.0f}, {0.75f, 0.5f}));
+
+    batch.upload();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(batch.mesh().count(), 18);
+
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    Containers::Array<Float> vertices = batch.vertexBuffer().subData<Float>(0, 12*5);
+    CORRADE_COMPARE(Vector2(vertices[3*5], vertices[3*5 + 1]), (Vector2{0.75f, 0.0f}));
+    for(std::size_t i = 4*5; i != 12*5; ++i)
+        CORRADE_COMPARE(vertices[i], 0.0f);
+    #endif
+}
+
+void BatchRendererGLTest::setTextRelocate() {
+    TestFont font;
+    Text::BatchRenderer2D batch{font, nullGlyphCache, 0.25f};
+
+    const UnsignedInt a = batch.add("a", {});
+    const UnsignedInt b = batch.add("b", Matrix3::translation({5.0f, 0.0f}));
+
+    /* Longer text doesn't fit, is moved to the end */
+    batch.setText(a, "abc");
+    CORRADE_COMPARE(batch.glyphCount(), 4);
+    CORRADE_COMPARE(batch.quadCount(), 5);
+
+    batch.upload();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(batch.mesh().count(), 30);
+
+    /* The other text is unaffected */
+    CORRADE_COMPARE(batch.rectangle(b), Range2D({0.0f, 0.0f}, {0.75f, 0.5f}));
+
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    Containers::Array<Float> vertices = batch.vertexBuffer().subData<Float>(0, 20*5);
+    CORRADE_COMPARE(vertices[0], 0.0f);
+    CORRADE_COMPARE(Vector2(vertices[4*5], vertices[4*5 + 1]), (Vector2{5.0f, 0.5f}));
+    CORRADE_COMPARE(Vector2(vertices[8*5], vertices[8*5 + 1]), (Vector2{0.0f, 0.5f}));
+    #endif
+}
+
+void BatchRendererGLTest::setTransformationColor() {
+    TestFont font;
+    Text::BatchRenderer2D batch{font, nullGlyphCache, 0.25f};
+
+    const UnsignedInt id = batch.add("a", {});
+    batch.upload();
+
+    batch.setTransformation(id, Matrix3::scaling(Vector2{2.0f}));
+    batch.setColor(id, Color4{0.0f, 1.0f, 0.0f, 1.0f});
+    CORRADE_COMPARE(batch.glyphCount(), 1);
+    CORRADE_COMPARE(batch.quadCount(), 1);
+
+    batch.upload();
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    Containers::Array<Float> vertices = batch.vertexBuffer().subData<Float>(0, 4*5);
+    CORRADE_COMPARE(Vector2(vertices[3*5], vertices[3*5 + 1]), (Vector2{1.5f, 0.0f}));
+
+    Containers::Array<UnsignedByte> colors = batch.vertexBuffer().subData<UnsignedByte>(16, 4);
+    CORRADE_COMPARE(Color4ub(colors[0], colors[1], colors[2], colors[3]), (Color4ub{0, 255, 0, 255}));
+    #endif
+}
+
+void BatchRendererGLTest::removeReuse() {
+    TestFont font;
+    Text::BatchRenderer2D batch{font, nullGlyphCache, 0.25f};
+
+    batch.add("abc", {});
+    batch.add("ab", {});
+    batch.remove(0);
+    CORRADE_COMPARE(batch.textCount(), 1);
+    CORRADE_COMPARE(batch.glyphCount(), 2);
+    CORRADE_COMPARE(batch.quadCount(), 5);
+
+    /* The ID and the free range get reused */
+    CORRADE_COMPARE(batch.add("x", Matrix3::translation({1.0f, 0.0f})), 0);
+    CORRADE_COMPARE(batch.textCount(), 2);
+    CORRADE_COMPARE(batch.glyphCount(), 3);
+    CORRADE_COMPARE(batch.quadCount(), 5);
+
+    batch.upload();
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    Containers::Array<Float> vertices = batch.vertexBuffer().subData<Float>(0, 12*5);
+    CORRADE_COMPARE(Vector2(vertices[0], vertices[1]), (Vector2{1.0f, 0.5f}));
+    for(std::size_t i = 4*5; i != 12*5; ++i)
+        CORRADE_COMPARE(vertices[i], 0.0f);
+    #endif
+}
+
+void BatchRendererGLTest::compact() {
+    TestFont font;
+    Text::BatchRenderer2D batch{font, nullGlyphCache, 0.25f};
+
+    batch.add("abc", {});
+    const UnsignedInt id = batch.add("a", Matrix3::translation({3.0f, 0.0f}));
+    batch.upload();
+    CORRADE_COMPARE(batch.mesh().count(), 24);
+
+    /* Three of four quads are unused now, compaction happens on upload */
+    batch.remove(0);
+    CORRADE_COMPARE(batch.quadCount(), 4);
+    batch.upload();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(batch.quadCount(), 1);
+    CORRADE_COMPARE(batch.mesh().count(), 6);
+    CORRADE_COMPARE(batch.rectangle(id), Range2D({0.0f, 0.0f}, {0.75f, 0.5f}));
+
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    Containers::Array<Float> vertices = batch.vertexBuffer().subData<Float>(0, 4*5);
+    CORRADE_COMPARE(Vector2(vertices[0], vertices[1]), (Vector2{3.0f, 0.5f}));
+    #endif
+}
+
+void BatchRendererGLTest::render3D() {
+    TestFont font;
+    Text::BatchRenderer3D batch{font, nullGlyphCache, 0.25f};
+
+    batch.add("a", Matrix4::translation({0.0f, 0.0f, -1.0f}));
+    batch.upload();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(batch.mesh().count(), 6);
+
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    /* Three position components, two texture coordinates and a color */
+    Containers::Array<Float> vertices = batch.vertexBuffer().subData<Float>(0, 4*6);
+    CORRADE_COMPARE(Vector3(vertices[0], vertices[1], vertices[2]), (Vector3{0.0f, 0.5f, -1.0f}));
+    CORRADE_COMPARE(Vector2(vertices[3], vertices[4]), (Vector2{0.0f, 10.0f}));
+    #endif
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Text::Test::BatchRendererGLTest)
@@ -0,0 +1,121 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Text/DistanceFieldGlyphCache.h"
+
+namespace Magnum { namespace Text { namespace Test {
+
+struct DistanceFieldGlyphCacheGLTest: OpenGLTester {
+    explicit DistanceFieldGlyphCacheGLTest();
+
+    void initialize();
+    void setImage();
+    void setImageDeferred();
+};
+
+DistanceFieldGlyphCacheGLTest::DistanceFieldGlyphCacheGLTest() {
+    addTests({&DistanceFieldGlyphCacheGLTest::initialize,
+              &DistanceFieldGlyphCacheGLTest::setImage,
+              &DistanceFieldGlyphCacheGLTest::setImageDeferred});
+}
+
+namespace {
+    PixelFormat inputFormat() {
+        #if defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        if(Context::current().isExtensionSupported<Extensions::GL::EXT::texture_rg>())
+            return PixelFormat::Red;
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        return PixelFormat::Red;
+        #else
+        return PixelFormat::Luminance;
+        #endif
+    }
+}
+
+void DistanceFieldGlyphCacheGLTest::initialize() {
+    DistanceFieldGlyphCache cache{Vector2i{1024}, Vector2i{256}, 16};
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_VERIFY(!cache.hasDeferredUpdates());
+    CORRADE_VERIFY(!cache.hasPendingUpdates());
+
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_COMPARE(cache.texture().imageSize(0), Vector2i(256));
+    #endif
+}
+
+void DistanceFieldGlyphCacheGLTest::setImage() {
+    DistanceFieldGlyphCache cache{Vector2i{128}, Vector2i{32}, 4};
+
+    Containers::Array<char> data{Containers::ValueInit, 16*16};
+    for(char& i: data) i = '\xff';
+
+    /* Immediate updates, nothing is pending afterwards */
+    cache.setImage({16, 16}, ImageView2D{inputFormat(), PixelType::UnsignedByte, {16, 16}, data});
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(!cache.hasPendingUpdates());
+
+    cache.setImage({64, 32}, ImageView2D{inputFormat(), PixelType::UnsignedByte, {16, 16}, data});
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(!cache.hasPendingUpdates());
+}
+
+void DistanceFieldGlyphCacheGLTest::setImageDeferred() {
+    DistanceFieldGlyphCache cache{Vector2i{128}, Vector2i{32}, 4};
+    cache.setDeferredUpdates(true);
+    CORRADE_VERIFY(cache.hasDeferredUpdates());
+
+    Containers::Array<char> data{Containers::ValueInit, 16*16};
+    for(char& i: data) i = '\xff';
+
+    cache.setImage({16, 16}, ImageView2D{inputFormat(), PixelType::UnsignedByte, {16, 16}, data});
+    cache.setImage({20, 20}, ImageView2D{inputFormat(), PixelType::UnsignedByte, {16, 16}, data});
+    cache.setImage({96, 96}, ImageView2D{inputFormat(), PixelType::UnsignedByte, {16, 16}, data});
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(cache.hasPendingUpdates());
+
+    cache.flush();
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(!cache.hasPendingUpdates());
+
+    /* Disabling deferred updates flushes the rest */
+    cache.setImage({64, 0}, ImageView2D{inputFormat(), PixelType::UnsignedByte, {16, 16}, data});
+    CORRADE_VERIFY(cache.hasPendingUpdates());
+    cache.setDeferredUpdates(false);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(!cache.hasPendingUpdates());
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Text::Test::DistanceFieldGlyphCacheGLTest)
@@ -0,0 +1,237 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <tuple>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/Image.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Text/GlyphCacheArray.h"
+
+namespace Magnum { namespace Text { namespace Test {
+
+struct GlyphCacheArrayGLTest: OpenGLTester {
+    explicit GlyphCacheArrayGLTest();
+
+    void initialize();
+    void reserve();
+    void reserveNewLayer();
+    void reserveTooLarge();
+    void insertReplace();
+    void evict();
+    void evictMarkedUsed();
+    void setImage();
+};
+
+GlyphCacheArrayGLTest::GlyphCacheArrayGLTest() {
+    addTests({&GlyphCacheArrayGLTest::initialize,
+              &GlyphCacheArrayGLTest::reserve,
+              &GlyphCacheArrayGLTest::reserveNewLayer,
+              &GlyphCacheArrayGLTest::reserveTooLarge,
+              &GlyphCacheArrayGLTest::insertReplace,
+              &GlyphCacheArrayGLTest::evict,
+              &GlyphCacheArrayGLTest::evictMarkedUsed,
+              &GlyphCacheArrayGLTest::setImage});
+}
+
+#define SKIP_IF_NOT_SUPPORTED()                                             \
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::texture_array>()) \
+        CORRADE_SKIP(Extensions::GL::EXT::texture_array::string() + std::string(" is not supported."))
+
+void GlyphCacheArrayGLTest::initialize() {
+    #ifndef MAGNUM_TARGET_GLES
+    SKIP_IF_NOT_SUPPORTED();
+    #endif
+
+    Text::GlyphCacheArray cache{{256, 128}, 8, 3};
+    MAGNUM_VERIFY_NO_ERROR();
+
+    CORRADE_COMPARE(cache.textureSize(), (Vector2i{256, 128}));
+    CORRADE_COMPARE(cache.maxLayers(), 8);
+    CORRADE_COMPARE(cache.layerCount(), 1);
+    CORRADE_COMPARE(cache.layerCapacity(), 3);
+    CORRADE_COMPARE(cache.glyphCount(), 1);
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_COMPARE(cache.texture().imageSize(0), (Vector3i{256, 128, 3}));
+    #endif
+}
+
+void GlyphCacheArrayGLTest::reserve() {
+    #ifndef MAGNUM_TARGET_GLES
+    SKIP_IF_NOT_SUPPORTED();
+    #endif
+
+    Text::GlyphCacheArray cache{Vector2i{64}, 4};
+
+    /* Everything fits into the first layer */
+    std::vector<Range2Di> ranges = cache.reserve({{32, 32}, {16, 16}});
+    CORRADE_COMPARE(ranges.size(), 2);
+    CORRADE_COMPARE(cache.layerCount(), 1);
+
+    cache.insert(1, {}, ranges[0]);
+    cache.insert(2, {}, ranges[1]);
+    CORRADE_COMPARE(cache.layer(1), 0);
+    CORRADE_COMPARE(cache.layer(2), 0);
+    CORRADE_COMPARE(cache[1].second, ranges[0]);
+}
+
+void GlyphCacheArrayGLTest::reserveNewLayer() {
+    #ifndef MAGNUM_TARGET_GLES
+    SKIP_IF_NOT_SUPPORTED();
+    #endif
+
+    Text::GlyphCacheArray cache{Vector2i{64}, 4};
+
+    std::vector<Range2Di> first = cache.reserve({{64, 48}});
+    CORRADE_COMPARE(first.size(), 1);
+    cache.insert(1, {}, first[0]);
+
+    /* Doesn't fit into the remaining space, continues in a new layer and the
+       texture grows */
+    std::vector<Range2Di> second = cache.reserve({{32, 32}});
+    CORRADE_COMPARE(second.size(), 1);
+    CORRADE_COMPARE(cache.layerCount(), 2);
+    CORRADE_COMPARE(cache.layerCapacity(), 2);
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* The returned range is relative to the layer, the stored one is in the
+       virtual atlas with layers stacked on top of each other */
+    CORRADE_COMPARE(second[0], Range2Di::fromSize({}, {32, 32}));
+    cache.insert(2, {}, second[0]);
+    CORRADE_COMPARE(cache.layer(2), 1);
+    CORRADE_COMPARE(cache[2].second, Range2Di::fromSize({0, 64}, {32, 32}));
+
+    /* Unknown glyphs fall back to glyph 0 */
+    CORRADE_COMPARE(cache.layer(3), 0);
+}
+
+void GlyphCacheArrayGLTest::reserveTooLarge() {
+    #ifndef MAGNUM_TARGET_GLES
+    SKIP_IF_NOT_SUPPORTED();
+    #endif
+
+    Text::GlyphCacheArray cache{Vector2i{64}, 4};
+
+    CORRADE_VERIFY(cache.reserve({{65, 16}}).empty());
+    CORRADE_COMPARE(cache.layerCount(), 1);
+}
+
+void GlyphCacheArrayGLTest::insertReplace() {
+    #ifndef MAGNUM_TARGET_GLES
+    SKIP_IF_NOT_SUPPORTED();
+    #endif
+
+    Text::GlyphCacheArray cache{Vector2i{64}, 4};
+
+    cache.insert(1, {}, cache.reserve({{64, 48}})[0]);
+    cache.insert(1, {3, 5}, cache.reserve({{32, 32}})[0]);
+    CORRADE_COMPARE(cache.glyphCount(), 2);
+    CORRADE_COMPARE(cache.layer(1), 1);
+    CORRADE_COMPARE(cache[1].first, (Vector2i{3, 5}));
+}
+
+void GlyphCacheArrayGLTest::evict() {
+    #ifndef MAGNUM_TARGET_GLES
+    SKIP_IF_NOT_SUPPORTED();
+    #endif
+
+    Text::GlyphCacheArray cache{Vector2i{64}, 2};
+
+    cache.insert(1, {}, cache.reserve({Vector2i{64}})[0]);
+    cache.insert(2, {}, cache.reserve({Vector2i{64}})[0]);
+    CORRADE_COMPARE(cache.layerCount(), 2);
+    CORRADE_COMPARE(cache.glyphCount(), 3);
+
+    /* No space left, the least recently used first layer gets evicted */
+    cache.insert(3, {}, cache.reserve({Vector2i{64}})[0]);
+    CORRADE_COMPARE(cache.layerCount(), 2);
+    CORRADE_COMPARE(cache.layerCapacity(), 2);
+    CORRADE_COMPARE(cache.glyphCount(), 3);
+    CORRADE_COMPARE(cache.layer(3), 0);
+    CORRADE_COMPARE(cache.layer(2), 1);
+    CORRADE_COMPARE(cache[1], cache[0]);
+}
+
+void GlyphCacheArrayGLTest::evictMarkedUsed() {
+    #ifndef MAGNUM_TARGET_GLES
+    SKIP_IF_NOT_SUPPORTED();
+    #endif
+
+    Text::GlyphCacheArray cache{Vector2i{64}, 2};
+
+    cache.insert(1, {}, cache.reserve({Vector2i{64}})[0]);
+    cache.insert(2, {}, cache.reserve({Vector2i{64}})[0]);
+
+    /* The first layer was used recently, the second gets evicted */
+    cache.markLayerUsed(0);
+    cache.insert(3, {}, cache.reserve({Vector2i{64}})[0]);
+    CORRADE_COMPARE(cache.layer(3), 1);
+    CORRADE_COMPARE(cache.layer(1), 0);
+    CORRADE_COMPARE(cache[2], cache[0]);
+}
+
+void GlyphCacheArrayGLTest::setImage() {
+    #ifndef MAGNUM_TARGET_GLES
+    SKIP_IF_NOT_SUPPORTED();
+    #endif
+
+    Text::GlyphCacheArray cache{Vector2i{4}, 4};
+
+    const UnsignedByte first[]{
+        0x11, 0x22, 0x33, 0x44,
+        0x55, 0x66, 0x77, 0x88
+    };
+    cache.insert(1, {}, cache.reserve({{4, 2}})[0]);
+    cache.setImage({}, ImageView2D{PixelFormat::Red, PixelType::UnsignedByte, {4, 2}, first});
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* Second layer makes the texture grow, the first layer gets reuploaded */
+    const UnsignedByte second[]{
+        0x99, 0xaa, 0xbb, 0xcc
+    };
+    cache.insert(2, {}, cache.reserve({{4, 4}})[0]);
+    cache.setImage({0, 1}, ImageView2D{PixelFormat::Red, PixelType::UnsignedByte, {4, 1}, second});
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(cache.layerCapacity(), 2);
+
+    #ifndef MAGNUM_TARGET_GLES
+    Image3D image = cache.texture().image(0, {PixelFormat::Red, PixelType::UnsignedByte});
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(image.size(), (Vector3i{4, 4, 2}));
+    CORRADE_COMPARE_AS((Containers::ArrayView<const UnsignedByte>{image.data<UnsignedByte>(), 8}),
+        (Containers::ArrayView<const UnsignedByte>{first}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS((Containers::ArrayView<const UnsignedByte>{image.data<UnsignedByte>() + 16 + 4, 4}),
+        (Containers::ArrayView<const UnsignedByte>{second}),
+        TestSuite::Compare::Container);
+    #endif
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Text::Test::GlyphCacheArrayGLTest)
@@ -36,12 +36,14 @@ struct GlyphCacheGLTest: OpenGLTester {
     void initialize();
     void access();
     void reserve();
+    void reserveIncremental();
 };
 
 GlyphCacheGLTest::GlyphCacheGLTest() {
     addTests({&GlyphCacheGLTest::initialize,
               &GlyphCacheGLTest::access,
-              &GlyphCacheGLTest::reserve});
+              &GlyphCacheGLTest::reserve,
+              &GlyphCacheGLTest::reserveIncremental});
 }
 
 void GlyphCacheGLTest::initialize() {
@@ -91,6 +93,26 @@ void GlyphCacheGLTest::reserve() {
     CORRADE_VERIFY(!cache.reserve({{5, 3}}).empty());
 }
 
+void GlyphCacheGLTest::reserveIncremental() {
+    Text::GlyphCache cache(Vector2i(64));
+
+    /* Nothing inserted, the space is reused */
+    CORRADE_COMPARE(cache.reserve({{64, 32}}), std::vector<Range2Di>{
+        Range2Di::fromSize({}, {64, 32})});
+    const std::vector<Range2Di> first = cache.reserve({{64, 32}});
+    CORRADE_COMPARE(first, std::vector<Range2Di>{
+        Range2Di::fromSize({}, {64, 32})});
+    cache.insert(1, {}, first[0]);
+
+    /* Non-empty cache, placed into remaining space */
+    CORRADE_COMPARE(cache.reserve({{32, 32}, {32, 32}}), (std::vector<Range2Di>{
+        Range2Di::fromSize({0, 32}, {32, 32}),
+        Range2Di::fromSize({32, 32}, {32, 32})}));
+
+    /* Full */
+    CORRADE_VERIFY(cache.reserve({{1, 1}}).empty());
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Text::Test::GlyphCacheGLTest)
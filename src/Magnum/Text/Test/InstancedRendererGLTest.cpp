@@ -0,0 +1,177 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/Text/AbstractFont.h"
+#include "Magnum/Text/InstancedRenderer.h"
+
+namespace Magnum { namespace Text { namespace Test {
+
+struct InstancedRendererGLTest: OpenGLTester {
+    explicit InstancedRendererGLTest();
+
+    void construct();
+    void render();
+    void renderCapacity();
+};
+
+InstancedRendererGLTest::InstancedRendererGLTest() {
+    addTests({&InstancedRendererGLTest::construct,
+              &InstancedRendererGLTest::render,
+              &InstancedRendererGLTest::renderCapacity});
+}
+
+namespace {
+
+class TestLayouter: public Text::AbstractLayouter {
+    public:
+        explicit TestLayouter(Float size, std::size_t glyphCount): AbstractLayouter(glyphCount), _size(size) {}
+
+    private:
+        std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(UnsignedInt i) override {
+            return std::make_tuple(
+                Range2D({}, Vector2(3.0f, 2.0f)*((i+1)*_size)),
+                Range2D::fromSize({i*6.0f, 0.0f}, {6.0f, 10.0f}),
+                (Vector2::xAxis((i+1)*3.0f)+Vector2(1.0f, -1.0f))*_size
+            );
+        }
+
+        Float _size;
+};
+
+class TestFont: public Text::AbstractFont {
+    Features doFeatures() const override { return Feature::OpenData; }
+
+    bool doIsOpened() const override { return true; }
+    void doClose() override {}
+
+    UnsignedInt doGlyphId(char32_t) override { return 0; }
+    Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+
+    std::unique_ptr<AbstractLayouter> doLayout(const GlyphCache&, const Float size, const std::string& text) override {
+        return std::unique_ptr<AbstractLayouter>(new TestLayouter(size, text.size()));
+    }
+};
+
+/* *static_cast<GlyphCache*>(nullptr) makes Clang Analyzer grumpy */
+char glyphCacheData;
+GlyphCache& nullGlyphCache = *reinterpret_cast<GlyphCache*>(&glyphCacheData);
+
+bool instancingSupported() {
+    #ifndef MAGNUM_TARGET_GLES
+    return Context::current().isExtensionSupported<Extensions::GL::ARB::instanced_arrays>();
+    #elif defined(MAGNUM_TARGET_GLES2)
+    #ifndef MAGNUM_TARGET_WEBGL
+    return Context::current().isExtensionSupported<Extensions::GL::ANGLE::instanced_arrays>() ||
+        Context::current().isExtensionSupported<Extensions::GL::EXT::instanced_arrays>() ||
+        Context::current().isExtensionSupported<Extensions::GL::NV::instanced_arrays>();
+    #else
+    return Context::current().isExtensionSupported<Extensions::GL::ANGLE::instanced_arrays>();
+    #endif
+    #else
+    return true;
+    #endif
+}
+
+}
+
+void InstancedRendererGLTest::construct() {
+    if(!instancingSupported())
+        CORRADE_SKIP("Instanced arrays are not supported");
+
+    TestFont font;
+    Text::InstancedRenderer2D renderer(font, nullGlyphCache, 0.25f);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(renderer.capacity(), 0);
+    CORRADE_COMPARE(renderer.rectangle(), Range2D());
+    CORRADE_COMPARE(renderer.mesh().count(), 6);
+    CORRADE_COMPARE(renderer.mesh().instanceCount(), 0);
+}
+
+void InstancedRendererGLTest::render() {
+    if(!instancingSupported())
+        CORRADE_SKIP("Instanced arrays are not supported");
+
+    TestFont font;
+    Text::InstancedRenderer2D renderer(font, nullGlyphCache, 0.25f, Alignment::MiddleRightIntegral);
+    renderer.reserve(4, BufferUsage::DynamicDraw);
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(renderer.capacity(), 4);
+
+    renderer.render("abc", Color4{1.0f, 0.0f, 0.0f, 1.0f});
+    MAGNUM_VERIFY_NO_ERROR();
+
+    /* One instance per glyph */
+    CORRADE_COMPARE(renderer.mesh().instanceCount(), 3);
+
+    /* Alignment offset. Y would be -0.25f if it wasn't integral */
+    const Vector2 offset{-5.0f, 0.0f};
+
+    /* Same bounds as with the non-instanced renderer */
+    CORRADE_COMPARE(renderer.rectangle(), Range2D({0.0f, -0.5f}, {5.0f, 1.0f}).translated(offset));
+
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    /* Position and texture coordinates, 8 floats, then 4 color bytes */
+    Containers::Array<Float> instances = renderer.instanceBuffer().subData<Float>(0, 27);
+    CORRADE_COMPARE((std::vector<Float>{instances[0], instances[1], instances[2], instances[3],
+                                        instances[4], instances[5], instances[6], instances[7]}),
+        (std::vector<Float>{-5.0f, 0.0f, -4.25f, 0.5f,
+                             0.0f, 0.0f,   6.0f, 10.0f}));
+    CORRADE_COMPARE((std::vector<Float>{instances[9], instances[10], instances[11], instances[12]}),
+        (std::vector<Float>{-4.0f, -0.25f, -2.5f, 0.75f}));
+    CORRADE_COMPARE((std::vector<Float>{instances[18], instances[19], instances[20], instances[21]}),
+        (std::vector<Float>{-2.25f, -0.5f, 0.0f, 1.0f}));
+
+    Containers::Array<UnsignedByte> color = renderer.instanceBuffer().subData<UnsignedByte>(32, 4);
+    CORRADE_COMPARE(Color4ub(color[0], color[1], color[2], color[3]), (Color4ub{255, 0, 0, 255}));
+    #endif
+}
+
+void InstancedRendererGLTest::renderCapacity() {
+    if(!instancingSupported())
+        CORRADE_SKIP("Instanced arrays are not supported");
+
+    TestFont font;
+    Text::InstancedRenderer2D renderer(font, nullGlyphCache, 0.25f);
+    renderer.reserve(2, BufferUsage::DynamicDraw);
+
+    /* Rendering less than capacity and then an empty text doesn't touch
+       anything it shouldn't */
+    renderer.render("ab");
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(renderer.mesh().instanceCount(), 2);
+
+    renderer.render("");
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(renderer.mesh().instanceCount(), 0);
+    CORRADE_COMPARE(renderer.rectangle(), Range2D());
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Text::Test::InstancedRendererGLTest)
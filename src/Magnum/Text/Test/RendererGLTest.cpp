@@ -28,6 +28,9 @@
 #include "Magnum/OpenGLTester.h"
 #include "Magnum/Text/AbstractFont.h"
 #include "Magnum/Text/Renderer.h"
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/Text/GlyphCacheArray.h"
+#endif
 
 namespace Magnum { namespace Text { namespace Test {
 
@@ -38,6 +41,10 @@ struct RendererGLTest: OpenGLTester {
     void renderMesh();
     void renderMeshIndexType();
     void mutableText();
+    #ifndef MAGNUM_TARGET_GLES2
+    void renderDataLayered();
+    void mutableTextLayered();
+    #endif
 
     void multiline();
 };
@@ -47,6 +54,10 @@ RendererGLTest::RendererGLTest() {
               &RendererGLTest::renderMesh,
               &RendererGLTest::renderMeshIndexType,
               &RendererGLTest::mutableText,
+              #ifndef MAGNUM_TARGET_GLES2
+              &RendererGLTest::renderDataLayered,
+              &RendererGLTest::mutableTextLayered,
+              #endif
 
               &RendererGLTest::multiline});
 }
@@ -83,6 +94,35 @@ class TestFont: public Text::AbstractFont {
     }
 };
 
+#ifndef MAGNUM_TARGET_GLES2
+/* Each glyph is in a different layer of the virtual layered atlas */
+class LayeredTestLayouter: public Text::AbstractLayouter {
+    public:
+        explicit LayeredTestLayouter(std::size_t glyphCount): AbstractLayouter(glyphCount) {}
+
+    private:
+        std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(UnsignedInt i) override {
+            return std::make_tuple(
+                Range2D({}, Vector2(1.0f)),
+                Range2D::fromSize({0.25f, i + 0.5f}, {0.5f, 0.25f}),
+                Vector2::xAxis(1.0f)
+            );
+        }
+};
+
+class LayeredTestFont: public TestFont {
+    std::unique_ptr<AbstractLayouter> doLayout(const GlyphCache&, Float, const std::string& text) override {
+        return std::unique_ptr<AbstractLayouter>(new LayeredTestLayouter(text.size()));
+    }
+};
+
+/* Fills three layers of the cache */
+void fillLayers(GlyphCacheArray& cache) {
+    for(UnsignedInt i = 1; i != 4; ++i)
+        cache.insert(i, {}, cache.reserve({cache.textureSize()})[0]);
+}
+#endif
+
 /* *static_cast<GlyphCache*>(nullptr) makes Clang Analyzer grumpy */
 char glyphCacheData;
 GlyphCache& nullGlyphCache = *reinterpret_cast<GlyphCache*>(&glyphCacheData);
@@ -325,6 +365,82 @@ void RendererGLTest::mutableText() {
     #endif
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void RendererGLTest::renderDataLayered() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::texture_array>())
+        CORRADE_SKIP(Extensions::GL::EXT::texture_array::string() + std::string(" is not supported"));
+    #endif
+
+    GlyphCacheArray cache{Vector2i{16}, 4};
+    fillLayers(cache);
+    CORRADE_COMPARE(cache.layerCount(), 3);
+
+    LayeredTestFont font;
+    std::vector<Vector2> positions;
+    std::vector<Vector3> textureCoordinates;
+    std::vector<UnsignedInt> indices;
+    Range2D bounds;
+    std::tie(positions, textureCoordinates, indices, bounds) = Text::AbstractRenderer::render(font, cache, 1.0f, "abc");
+
+    CORRADE_COMPARE(positions.size(), 12);
+    CORRADE_COMPARE(indices.size(), 18);
+
+    /* The layer is extracted from the Y coordinate */
+    CORRADE_COMPARE(textureCoordinates, (std::vector<Vector3>{
+        {0.25f, 0.75f, 0.0f},
+        {0.25f, 0.5f, 0.0f},
+        {0.75f, 0.75f, 0.0f},
+        {0.75f, 0.5f, 0.0f},
+
+        {0.25f, 0.75f, 1.0f},
+        {0.25f, 0.5f, 1.0f},
+        {0.75f, 0.75f, 1.0f},
+        {0.75f, 0.5f, 1.0f},
+
+        {0.25f, 0.75f, 2.0f},
+        {0.25f, 0.5f, 2.0f},
+        {0.75f, 0.75f, 2.0f},
+        {0.75f, 0.5f, 2.0f}
+    }));
+}
+
+void RendererGLTest::mutableTextLayered() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::texture_array>())
+        CORRADE_SKIP(Extensions::GL::EXT::texture_array::string() + std::string(" is not supported"));
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::map_buffer_range>())
+        CORRADE_SKIP(Extensions::GL::ARB::map_buffer_range::string() + std::string(" is not supported"));
+    #endif
+
+    GlyphCacheArray cache{Vector2i{16}, 4};
+    fillLayers(cache);
+
+    LayeredTestFont font;
+    Text::Renderer2D renderer(font, cache, 1.0f);
+    renderer.reserve(2, BufferUsage::DynamicDraw, BufferUsage::DynamicDraw);
+    renderer.render("ab");
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(renderer.mesh().count(), 12);
+
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    Containers::Array<Float> vertices = renderer.vertexBuffer().subData<Float>(0, 40);
+    CORRADE_COMPARE(std::vector<Float>(vertices.begin(), vertices.end()), (std::vector<Float>{
+        0.0f, 1.0f, 0.25f, 0.75f, 0.0f,
+        0.0f, 0.0f, 0.25f, 0.5f, 0.0f,
+        1.0f, 1.0f, 0.75f, 0.75f, 0.0f,
+        1.0f, 0.0f, 0.75f, 0.5f, 0.0f,
+
+        1.0f, 1.0f, 0.25f, 0.75f, 1.0f,
+        1.0f, 0.0f, 0.25f, 0.5f, 1.0f,
+        2.0f, 1.0f, 0.75f, 0.75f, 1.0f,
+        2.0f, 0.0f, 0.75f, 0.5f, 1.0f
+    }));
+    #endif
+}
+#endif
+
 void RendererGLTest::multiline() {
     class Layouter: public Text::AbstractLayouter {
         public:
@@ -0,0 +1,336 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <Corrade/Utility/Unicode.h>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/Context.h"
+#include "Magnum/Extensions.h"
+#include "Magnum/OpenGLTester.h"
+#include "Magnum/Text/AbstractFont.h"
+#include "Magnum/Text/GlyphCache.h"
+#include "Magnum/Text/Renderer.h"
+
+namespace Magnum { namespace Text { namespace Test {
+
+/* CPU time of laying out text into vertex data, of uploading the data with
+   each buffer mapping method the renderer can use and of glyph cache
+   operations. The font looks the glyphs up in the cache the same way font
+   plugins do, Latin text has mostly one-byte UTF-8 characters, CJK text
+   three-byte ones from a much larger set. */
+
+struct TextGLBenchmark: OpenGLTester {
+    explicit TextGLBenchmark();
+
+    void renderLatinShort();
+    void renderLatinLong();
+    void renderCjkShort();
+    void renderCjkLong();
+
+    void rendererUpdate();
+
+    void uploadSetSubData();
+    #ifndef MAGNUM_TARGET_WEBGL
+    void uploadMapFull();
+    #ifdef CORRADE_TARGET_NACL
+    void uploadMapSub();
+    #endif
+    void uploadMapRange();
+    #endif
+
+    void glyphCacheLookup();
+    void fillGlyphCache();
+
+    private:
+        void render(const std::string& text);
+        void upload(void*(*map)(Buffer&, GLsizeiptr), void(*unmap)(Buffer&));
+};
+
+namespace {
+
+const std::string LatinShort = "Hello World!";
+const std::string CjkShort = "你好，世界！";
+/* Characters of the CJK text, the glyph cache is filled with these and
+   the Latin alphabet */
+const std::string CjkCharacters =
+    "的一是不了人我在有他这中大来上国个到说们为子和你地出道也时年得就那要下"
+    "以生会自着去之过家学对可她里后小么心多天而能好都然没日于起还发成事只作当"
+    "想看文无开手十用主行方又如前所本见经头面公同三已老从动两长知民样现分将外"
+    "但身些与高意进把法此实回二理美点月明其种声全工己话儿者向情部正名定女问力"
+    "机给等几很业最间新什打便位因重被走电四第门相次东政海口使教西再平真听世气"
+    "信北少关并内加化由却代军产入先山五太水万市眼体别处总才场师书比住员九笑性"
+    "通目华报立马命张活难神数件安表原车白应路期叫死常提感金何更反合放做系计或"
+    "司利受光王果亲界及今京务制解各任至清物台象记边共风战干接它许八特觉望直服"
+    "毛林题建南度统色字请交爱让认算论百吃义科怎元社术结六功指思非流每青管夫连"
+    "，。！？";
+const std::string LatinCharacters =
+    "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789 .,:;!?'\"-";
+
+/* About 2000 characters each */
+std::string repeated(const std::string& text, std::size_t count) {
+    std::string out;
+    for(std::size_t i = 0; i != count; ++i) out += text;
+    return out;
+}
+
+const std::string& latinLong() {
+    static const std::string text = repeated("The quick brown fox jumps over the lazy dog. Sphinx of black quartz, judge my vow! ", 24);
+    return text;
+}
+
+const std::string& cjkLong() {
+    static const std::string text = repeated(CjkCharacters, 6);
+    return text;
+}
+
+class BenchmarkLayouter: public AbstractLayouter {
+    public:
+        explicit BenchmarkLayouter(const GlyphCache& cache, Float size, std::vector<UnsignedInt>&& glyphs): AbstractLayouter(glyphs.size()), _cache(cache), _size{size}, _glyphs{std::move(glyphs)} {}
+
+    private:
+        std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(UnsignedInt i) override {
+            Vector2i position;
+            Range2Di rectangle;
+            std::tie(position, rectangle) = _cache[_glyphs[i]];
+
+            const Range2D textureCoordinates = Range2D(rectangle).scaled(1.0f/Vector2(_cache.textureSize()));
+            const Range2D quadRectangle = Range2D(Range2Di::fromSize(position, rectangle.size())).scaled(Vector2{_size/16.0f});
+            return std::make_tuple(quadRectangle, textureCoordinates, Vector2::xAxis(_size));
+        }
+
+        const GlyphCache& _cache;
+        Float _size;
+        std::vector<UnsignedInt> _glyphs;
+};
+
+/* Glyph IDs are assigned in order of characters passed to fillGlyphCache(),
+   zero is reserved for unknown characters */
+class BenchmarkFont: public AbstractFont {
+    Features doFeatures() const override { return Feature::OpenData; }
+
+    bool doIsOpened() const override { return true; }
+    void doClose() override {}
+
+    UnsignedInt doGlyphId(const char32_t character) override {
+        auto found = _glyphIds.find(character);
+        return found == _glyphIds.end() ? 0 : found->second;
+    }
+
+    Vector2 doGlyphAdvance(UnsignedInt) override { return Vector2::xAxis(16.0f); }
+
+    void doFillGlyphCache(GlyphCache& cache, const std::u32string& characters) override {
+        const std::vector<Range2Di> rectangles = cache.reserve(std::vector<Vector2i>(characters.size(), Vector2i{16}));
+        for(std::size_t i = 0; i != characters.size(); ++i) {
+            const UnsignedInt id = _glyphIds.emplace(characters[i], _glyphIds.size() + 1).first->second;
+            cache.insert(id, {}, rectangles[i]);
+        }
+    }
+
+    std::unique_ptr<AbstractLayouter> doLayout(const GlyphCache& cache, const Float size, const std::string& text) override {
+        std::vector<UnsignedInt> glyphs;
+        glyphs.reserve(text.size());
+        for(std::size_t i = 0; i != text.size(); ) {
+            char32_t codepoint;
+            std::tie(codepoint, i) = Utility::Unicode::nextChar(text, i);
+            glyphs.push_back(doGlyphId(codepoint));
+        }
+
+        return std::unique_ptr<AbstractLayouter>(new BenchmarkLayouter(cache, size, std::move(glyphs)));
+    }
+
+    std::unordered_map<char32_t, UnsignedInt> _glyphIds;
+};
+
+#ifndef MAGNUM_TARGET_WEBGL
+void* mapFull(Buffer& buffer, GLsizeiptr) {
+    return buffer.map(Buffer::MapAccess::WriteOnly);
+}
+
+#ifdef CORRADE_TARGET_NACL
+void* mapSub(Buffer& buffer, GLsizeiptr length) {
+    return buffer.mapSub(0, length, Buffer::MapAccess::WriteOnly);
+}
+
+void unmapSub(Buffer& buffer) {
+    buffer.unmapSub();
+}
+#endif
+
+void* mapRange(Buffer& buffer, GLsizeiptr length) {
+    return buffer.map(0, length, Buffer::MapFlag::InvalidateBuffer|Buffer::MapFlag::Write);
+}
+
+void unmap(Buffer& buffer) {
+    buffer.unmap();
+}
+#endif
+
+}
+
+TextGLBenchmark::TextGLBenchmark() {
+    addBenchmarks({&TextGLBenchmark::renderLatinShort,
+                   &TextGLBenchmark::renderLatinLong,
+                   &TextGLBenchmark::renderCjkShort,
+                   &TextGLBenchmark::renderCjkLong,
+
+                   &TextGLBenchmark::rendererUpdate,
+
+                   &TextGLBenchmark::uploadSetSubData,
+                   #ifndef MAGNUM_TARGET_WEBGL
+                   &TextGLBenchmark::uploadMapFull,
+                   #ifdef CORRADE_TARGET_NACL
+                   &TextGLBenchmark::uploadMapSub,
+                   #endif
+                   &TextGLBenchmark::uploadMapRange,
+                   #endif
+
+                   &TextGLBenchmark::glyphCacheLookup,
+                   &TextGLBenchmark::fillGlyphCache}, 10);
+}
+
+void TextGLBenchmark::render(const std::string& text) {
+    BenchmarkFont font;
+    GlyphCache cache{Vector2i{1024}};
+    font.fillGlyphCache(cache, LatinCharacters + CjkCharacters);
+
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(10)
+        count += std::get<0>(AbstractRenderer::render(font, cache, 16.0f, text)).size();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(count);
+}
+
+void TextGLBenchmark::renderLatinShort() { render(LatinShort); }
+void TextGLBenchmark::renderLatinLong() { render(latinLong()); }
+void TextGLBenchmark::renderCjkShort() { render(CjkShort); }
+void TextGLBenchmark::renderCjkLong() { render(cjkLong()); }
+
+void TextGLBenchmark::rendererUpdate() {
+    BenchmarkFont font;
+    GlyphCache cache{Vector2i{1024}};
+    font.fillGlyphCache(cache, LatinCharacters + CjkCharacters);
+
+    /* Uses the buffer mapping method picked for the platform */
+    Renderer2D renderer{font, cache, 16.0f};
+    renderer.reserve(latinLong().size(), BufferUsage::DynamicDraw, BufferUsage::StaticDraw);
+
+    CORRADE_BENCHMARK(10)
+        renderer.render(latinLong());
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_COMPARE(renderer.mesh().count(), latinLong().size()*6);
+}
+
+void TextGLBenchmark::upload(void*(*map)(Buffer&, GLsizeiptr), void(*unmap)(Buffer&)) {
+    /* Vertex data of the long Latin text, four vertices with position and
+       texture coordinates per glyph */
+    const std::vector<char> data(latinLong().size()*4*sizeof(Vector2)*2, '\x7f');
+    Buffer buffer{Buffer::TargetHint::Array};
+    buffer.setData({nullptr, data.size()}, BufferUsage::DynamicDraw);
+
+    CORRADE_BENCHMARK(10) {
+        if(map) {
+            char* const mapped = static_cast<char*>(map(buffer, data.size()));
+            std::copy(data.begin(), data.end(), mapped);
+            unmap(buffer);
+        } else buffer.setSubData(0, data);
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+}
+
+void TextGLBenchmark::uploadSetSubData() {
+    upload(nullptr, nullptr);
+}
+
+#ifndef MAGNUM_TARGET_WEBGL
+void TextGLBenchmark::uploadMapFull() {
+    #ifdef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::OES::mapbuffer>())
+        CORRADE_SKIP(Extensions::GL::OES::mapbuffer::string() + std::string(" is not supported."));
+    #endif
+
+    upload(mapFull, unmap);
+}
+
+#ifdef CORRADE_TARGET_NACL
+void TextGLBenchmark::uploadMapSub() {
+    if(!Context::current().isExtensionSupported<Extensions::GL::CHROMIUM::map_sub>())
+        CORRADE_SKIP(Extensions::GL::CHROMIUM::map_sub::string() + std::string(" is not supported."));
+
+    upload(mapSub, unmapSub);
+}
+#endif
+
+void TextGLBenchmark::uploadMapRange() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::GL::ARB::map_buffer_range>())
+        CORRADE_SKIP(Extensions::GL::ARB::map_buffer_range::string() + std::string(" is not supported."));
+    #elif defined(MAGNUM_TARGET_GLES2)
+    if(!Context::current().isExtensionSupported<Extensions::GL::EXT::map_buffer_range>())
+        CORRADE_SKIP(Extensions::GL::EXT::map_buffer_range::string() + std::string(" is not supported."));
+    #endif
+
+    upload(mapRange, unmap);
+}
+#endif
+
+void TextGLBenchmark::glyphCacheLookup() {
+    BenchmarkFont font;
+    GlyphCache cache{Vector2i{1024}};
+    font.fillGlyphCache(cache, LatinCharacters + CjkCharacters);
+    const UnsignedInt glyphCount = cache.glyphCount();
+
+    Int sum = 0;
+    CORRADE_BENCHMARK(10)
+        for(UnsignedInt i = 0; i != glyphCount; ++i)
+            sum += cache[i].second.left();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(sum);
+}
+
+void TextGLBenchmark::fillGlyphCache() {
+    /* The cache can't be emptied, so this includes creation of its texture */
+    const std::string characters = LatinCharacters + CjkCharacters;
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(1) {
+        BenchmarkFont font;
+        GlyphCache cache{Vector2i{1024}};
+        font.fillGlyphCache(cache, characters);
+        count += cache.glyphCount();
+    }
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(count);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Text::Test::TextGLBenchmark)
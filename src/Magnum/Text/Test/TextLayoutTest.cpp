@@ -0,0 +1,482 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Unicode.h>
+
+#include "Magnum/Math/Range.h"
+#include "Magnum/Text/AbstractFont.h"
+#include "Magnum/Text/TextLayout.h"
+
+namespace Magnum { namespace Text { namespace Test {
+
+struct TextLayoutTest: TestSuite::Tester {
+    explicit TextLayoutTest();
+
+    void singleLine();
+    void empty();
+    void paragraphs();
+    void breakGreedy();
+    void breakOptimal();
+    void wordTooLong();
+    void alignment();
+    void kerning();
+    void styles();
+
+    void addSpanOverride();
+    void replaceSpans();
+
+    void incrementalUpdate();
+    void incrementalUpdateWidth();
+    void incrementalUpdateAlignment();
+};
+
+TextLayoutTest::TextLayoutTest() {
+    addTests({&TextLayoutTest::singleLine,
+              &TextLayoutTest::empty,
+              &TextLayoutTest::paragraphs,
+              &TextLayoutTest::breakGreedy,
+              &TextLayoutTest::breakOptimal,
+              &TextLayoutTest::wordTooLong,
+              &TextLayoutTest::alignment,
+              &TextLayoutTest::kerning,
+              &TextLayoutTest::styles,
+
+              &TextLayoutTest::addSpanOverride,
+              &TextLayoutTest::replaceSpans,
+
+              &TextLayoutTest::incrementalUpdate,
+              &TextLayoutTest::incrementalUpdateWidth,
+              &TextLayoutTest::incrementalUpdateAlignment});
+}
+
+namespace {
+
+/* Each character is a quad one unit wide and high at font size, advancing by
+   one unit */
+class UnitLayouter: public Text::AbstractLayouter {
+    public:
+        explicit UnitLayouter(Float scale, UnsignedInt glyphCount): AbstractLayouter(glyphCount), _scale(scale) {}
+
+    private:
+        std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(UnsignedInt) override {
+            return std::make_tuple(
+                Range2D({}, Vector2{_scale}),
+                Range2D({}, Vector2{1.0f}),
+                Vector2::xAxis(_scale));
+        }
+
+        Float _scale;
+};
+
+class UnitFont: public Text::AbstractFont {
+    public:
+        explicit UnitFont(Features features = {}): _features{features} {
+            openFile({}, {});
+        }
+
+        Features doFeatures() const override { return _features; }
+        bool doIsOpened() const override { return _opened; }
+        void doClose() override { _opened = false; }
+
+        Metrics doOpenFile(const std::string&, Float) override {
+            _opened = true;
+            return {2.0f, 1.5f, -0.5f, 2.5f};
+        }
+
+        UnsignedInt doGlyphId(char32_t character) override { return character; }
+
+        Vector2 doGlyphAdvance(UnsignedInt) override { return Vector2::xAxis(2.0f); }
+
+        Vector2 doGlyphKerning(UnsignedInt left, UnsignedInt right) override {
+            return left == 'A' && right == 'V' ? Vector2::xAxis(-0.5f) : Vector2{};
+        }
+
+        std::unique_ptr<AbstractLayouter> doLayout(const GlyphCache&, Float size, const std::string& text) override {
+            ++layoutCount;
+            return std::unique_ptr<AbstractLayouter>(new UnitLayouter(size*0.5f, Utility::Unicode::utf32(text).size()));
+        }
+
+        Int layoutCount = 0;
+
+    private:
+        Features _features;
+        bool _opened = false;
+};
+
+/* The cache pointer is never dereferenced */
+char glyphCacheData[1];
+const GlyphCache& glyphCache = *reinterpret_cast<const GlyphCache*>(glyphCacheData);
+
+/* Text of each line */
+std::vector<std::string> lineTexts(const TextLayout& layout) {
+    std::vector<std::string> out;
+    for(const TextLayout::Line& line: layout.lines())
+        out.push_back(layout.text().substr(line.begin, line.end - line.begin));
+    return out;
+}
+
+std::string join(const std::vector<std::string>& strings) {
+    std::string out;
+    for(const std::string& s: strings) out += '|' + s;
+    return out;
+}
+
+}
+
+void TextLayoutTest::singleLine() {
+    /* Font size 2 laid out at size 2, so each glyph is one unit */
+    UnitFont font;
+    TextLayout layout{font, glyphCache, 2.0f};
+    layout.setText("Hello")
+        .update();
+
+    CORRADE_COMPARE(layout.paragraphCount(), 1);
+    CORRADE_COMPARE(layout.glyphs().size(), 5);
+    CORRADE_COMPARE(layout.lines().size(), 1);
+
+    /* Baseline is at origin */
+    CORRADE_COMPARE(layout.glyphs()[0].position, Range2D({0.0f, 0.0f}, {1.0f, 1.0f}));
+    CORRADE_COMPARE(layout.glyphs()[4].position, Range2D({4.0f, 0.0f}, {5.0f, 1.0f}));
+    CORRADE_COMPARE(layout.glyphs()[4].textureCoordinates, Range2D({}, Vector2{1.0f}));
+    CORRADE_COMPARE(layout.glyphs()[4].offset, 4);
+    CORRADE_COMPARE(layout.glyphs()[4].style, 0);
+
+    const TextLayout::Line& line = layout.lines()[0];
+    CORRADE_COMPARE(line.begin, 0);
+    CORRADE_COMPARE(line.end, 5);
+    CORRADE_COMPARE(line.glyphBegin, 0);
+    CORRADE_COMPARE(line.glyphEnd, 5);
+    CORRADE_COMPARE(line.baseline, 0.0f);
+    CORRADE_COMPARE(line.rectangle, Range2D({0.0f, -0.5f}, {5.0f, 1.5f}));
+    CORRADE_COMPARE(layout.rectangle(), Range2D({0.0f, -0.5f}, {5.0f, 1.5f}));
+}
+
+void TextLayoutTest::empty() {
+    UnitFont font;
+    TextLayout layout{font, glyphCache, 2.0f};
+    layout.update();
+
+    /* Empty text still has one line with the metrics of the default style */
+    CORRADE_COMPARE(layout.paragraphCount(), 1);
+    CORRADE_VERIFY(layout.glyphs().empty());
+    CORRADE_COMPARE(layout.lines().size(), 1);
+    CORRADE_COMPARE(layout.lines()[0].begin, 0);
+    CORRADE_COMPARE(layout.lines()[0].end, 0);
+    CORRADE_COMPARE(layout.rectangle(), Range2D({0.0f, -0.5f}, {0.0f, 1.5f}));
+    CORRADE_COMPARE(font.layoutCount, 0);
+}
+
+void TextLayoutTest::paragraphs() {
+    UnitFont font;
+    TextLayout layout{font, glyphCache, 2.0f};
+    layout.setText("ab\n\ncde")
+        .update();
+
+    CORRADE_COMPARE(layout.paragraphCount(), 3);
+    CORRADE_COMPARE(join(lineTexts(layout)), "|ab||cde");
+    CORRADE_COMPARE(layout.glyphs().size(), 5);
+
+    /* Lines are 2.5 units apart */
+    CORRADE_COMPARE(layout.lines()[0].baseline, 0.0f);
+    CORRADE_COMPARE(layout.lines()[1].baseline, -2.5f);
+    CORRADE_COMPARE(layout.lines()[2].baseline, -5.0f);
+    CORRADE_COMPARE(layout.lines()[2].begin, 4);
+    CORRADE_COMPARE(layout.lines()[2].glyphBegin, 2);
+    CORRADE_COMPARE(layout.glyphs()[2].offset, 4);
+    CORRADE_COMPARE(layout.glyphs()[2].position, Range2D({0.0f, -5.0f}, {1.0f, -4.0f}));
+    CORRADE_COMPARE(layout.rectangle(), Range2D({0.0f, -5.5f}, {3.0f, 1.5f}));
+}
+
+void TextLayoutTest::breakGreedy() {
+    UnitFont font;
+    TextLayout layout{font, glyphCache, 2.0f};
+    layout.setWidth(6.0f)
+        .setText("aaa bb cc ddddd")
+        .update();
+
+    /* Trailing space of the first line doesn't count into the width */
+    CORRADE_COMPARE(join(lineTexts(layout)), "|aaa bb |cc |ddddd");
+    CORRADE_COMPARE(layout.lines()[0].rectangle.sizeX(), 6.0f);
+    CORRADE_COMPARE(layout.lines()[1].rectangle.sizeX(), 2.0f);
+    CORRADE_COMPARE(layout.lines()[1].glyphBegin, 7);
+    CORRADE_COMPARE(layout.glyphs()[7].position, Range2D({0.0f, -2.5f}, {1.0f, -1.5f}));
+}
+
+void TextLayoutTest::breakOptimal() {
+    UnitFont font;
+    TextLayout layout{font, glyphCache, 2.0f};
+    layout.setWidth(6.0f)
+        .setLineBreaking(TextLayout::LineBreaking::Optimal)
+        .setText("aaa bb cc ddddd")
+        .update();
+
+    /* 3*3 + 1*1 is less than 0*0 + 4*4 from the greedy variant */
+    CORRADE_COMPARE(join(lineTexts(layout)), "|aaa |bb cc |ddddd");
+}
+
+void TextLayoutTest::wordTooLong() {
+    UnitFont font;
+    TextLayout layout{font, glyphCache, 2.0f};
+    layout.setWidth(4.0f)
+        .setText("a bbbbbbb c")
+        .update();
+    CORRADE_COMPARE(join(lineTexts(layout)), "|a |bbbbbbb |c");
+    CORRADE_COMPARE(layout.lines()[1].rectangle.sizeX(), 7.0f);
+
+    layout.setLineBreaking(TextLayout::LineBreaking::Optimal)
+        .update();
+    CORRADE_COMPARE(join(lineTexts(layout)), "|a |bbbbbbb |c");
+}
+
+void TextLayoutTest::alignment() {
+    UnitFont font;
+    TextLayout layout{font, glyphCache, 2.0f};
+    layout.setText("aaaa\nbb")
+        .setAlignment(Alignment::TopRight)
+        .update();
+
+    /* Aligned to the widest line if there's no width set, top of the first
+       line at origin */
+    CORRADE_COMPARE(layout.lines()[0].rectangle, Range2D({0.0f, -2.0f}, {4.0f, 0.0f}));
+    CORRADE_COMPARE(layout.lines()[1].rectangle, Range2D({2.0f, -4.5f}, {4.0f, -2.5f}));
+    CORRADE_COMPARE(layout.glyphs()[4].position, Range2D({2.0f, -4.0f}, {3.0f, -3.0f}));
+
+    /* Aligned to the width, total height is 5 */
+    layout.setWidth(5.0f)
+        .setAlignment(Alignment::MiddleCenter)
+        .update();
+    CORRADE_COMPARE(layout.lines()[0].rectangle, Range2D({0.5f, 0.5f}, {4.5f, 2.5f}));
+    CORRADE_COMPARE(layout.lines()[1].rectangle, Range2D({1.5f, -2.0f}, {3.5f, 0.0f}));
+
+    /* Both offsets are rounded */
+    layout.setAlignment(Alignment::MiddleCenterIntegral)
+        .update();
+    CORRADE_COMPARE(layout.lines()[0].rectangle, Range2D({1.0f, 1.0f}, {5.0f, 3.0f}));
+}
+
+void TextLayoutTest::kerning() {
+    UnitFont font;
+    UnitFont kerningFont{AbstractFont::Feature::Kerning};
+
+    TextLayout layout{font, glyphCache, 2.0f};
+    layout.setText("AVA")
+        .update();
+    CORRADE_COMPARE(layout.glyphs()[1].position.left(), 1.0f);
+
+    /* Kerning in font units, scaled to the size */
+    TextLayout kerningLayout{kerningFont, glyphCache, 4.0f};
+    kerningLayout.setText("AVA")
+        .update();
+    CORRADE_COMPARE(kerningLayout.glyphs()[1].position.left(), 1.0f);
+    CORRADE_COMPARE(kerningLayout.glyphs()[2].position.left(), 3.0f);
+    CORRADE_COMPARE(kerningLayout.lines()[0].rectangle.sizeX(), 5.0f);
+}
+
+void TextLayoutTest::styles() {
+    UnitFont font, bigFont;
+    TextLayout layout{font, glyphCache, 2.0f};
+    const UnsignedInt big = layout.addStyle(bigFont, glyphCache, 4.0f);
+    CORRADE_COMPARE(big, 1);
+    CORRADE_COMPARE(layout.styleCount(), 2);
+    CORRADE_COMPARE(layout.style(big).font, &bigFont);
+    CORRADE_COMPARE(layout.style(big).size, 4.0f);
+
+    layout.setText("ab cd\nef")
+        .addSpan(1, 4, big)
+        .update();
+
+    /* Each style run is laid out separately */
+    CORRADE_COMPARE(font.layoutCount, 3);
+    CORRADE_COMPARE(bigFont.layoutCount, 2);
+
+    const std::vector<TextLayout::Glyph>& glyphs = layout.glyphs();
+    CORRADE_COMPARE(glyphs.size(), 7);
+    CORRADE_COMPARE(glyphs[0].style, 0);
+    CORRADE_COMPARE(glyphs[1].style, 1);
+    CORRADE_COMPARE(glyphs[2].style, 1);
+    CORRADE_COMPARE(glyphs[3].style, 1);
+    CORRADE_COMPARE(glyphs[4].style, 0);
+    CORRADE_COMPARE(glyphs[1].position, Range2D({1.0f, 0.0f}, {3.0f, 2.0f}));
+    CORRADE_COMPARE(glyphs[4].position, Range2D({7.0f, 0.0f}, {8.0f, 1.0f}));
+
+    /* The first line has metrics of the bigger style, the second of the
+       default one */
+    CORRADE_COMPARE(layout.lines()[0].rectangle, Range2D({0.0f, -1.0f}, {8.0f, 3.0f}));
+    CORRADE_COMPARE(layout.lines()[1].baseline, -3.5f);
+    CORRADE_COMPARE(layout.lines()[1].rectangle, Range2D({0.0f, -4.0f}, {2.0f, -2.0f}));
+}
+
+void TextLayoutTest::addSpanOverride() {
+    UnitFont font;
+    TextLayout layout{font, glyphCache, 2.0f};
+    const UnsignedInt a = layout.addStyle(font, glyphCache, 3.0f);
+    const UnsignedInt b = layout.addStyle(font, glyphCache, 4.0f);
+    layout.setText("0123456789")
+        .addSpan(1, 8, a)
+        .addSpan(3, 5, b)
+        .addSpan(7, 9, b);
+
+    CORRADE_COMPARE(layout.spans().size(), 4);
+    CORRADE_COMPARE(layout.spans()[0].begin, 1);
+    CORRADE_COMPARE(layout.spans()[0].end, 3);
+    CORRADE_COMPARE(layout.spans()[0].style, a);
+    CORRADE_COMPARE(layout.spans()[1].begin, 3);
+    CORRADE_COMPARE(layout.spans()[1].end, 5);
+    CORRADE_COMPARE(layout.spans()[1].style, b);
+    CORRADE_COMPARE(layout.spans()[2].begin, 5);
+    CORRADE_COMPARE(layout.spans()[2].end, 7);
+    CORRADE_COMPARE(layout.spans()[2].style, a);
+    CORRADE_COMPARE(layout.spans()[3].begin, 7);
+    CORRADE_COMPARE(layout.spans()[3].end, 9);
+    CORRADE_COMPARE(layout.spans()[3].style, b);
+
+    layout.clearSpans();
+    CORRADE_VERIFY(layout.spans().empty());
+}
+
+void TextLayoutTest::replaceSpans() {
+    UnitFont font;
+    TextLayout layout{font, glyphCache, 2.0f};
+    const UnsignedInt a = layout.addStyle(font, glyphCache, 3.0f);
+    layout.setText("aa bb cc dd")
+        .addSpan(3, 5, a)
+        .addSpan(9, 11, a);
+
+    /* Typing at the end of a span extends it, spans after are shifted */
+    layout.replace(5, 5, "bb");
+    CORRADE_COMPARE(layout.text(), "aa bbbb cc dd");
+    CORRADE_COMPARE(layout.spans().size(), 2);
+    CORRADE_COMPARE(layout.spans()[0].begin, 3);
+    CORRADE_COMPARE(layout.spans()[0].end, 7);
+    CORRADE_COMPARE(layout.spans()[1].begin, 11);
+    CORRADE_COMPARE(layout.spans()[1].end, 13);
+
+    /* Replacing a range covering the span removes it */
+    layout.replace(2, 8, "-");
+    CORRADE_COMPARE(layout.text(), "aa-cc dd");
+    CORRADE_COMPARE(layout.spans().size(), 1);
+    CORRADE_COMPARE(layout.spans()[0].begin, 6);
+    CORRADE_COMPARE(layout.spans()[0].end, 8);
+
+    /* Replacing a range overlapping the span begin shrinks it */
+    layout.replace(4, 7, "XY");
+    CORRADE_COMPARE(layout.text(), "aa-cXYd");
+    CORRADE_COMPARE(layout.spans().size(), 1);
+    CORRADE_COMPARE(layout.spans()[0].begin, 6);
+    CORRADE_COMPARE(layout.spans()[0].end, 7);
+
+    /* Setting the text removes all spans */
+    layout.setText("abc");
+    CORRADE_VERIFY(layout.spans().empty());
+}
+
+void TextLayoutTest::incrementalUpdate() {
+    UnitFont font;
+    TextLayout layout{font, glyphCache, 2.0f};
+    layout.setWidth(10.0f)
+        .setText("one\ntwo\nthree\none")
+        .update();
+    CORRADE_COMPARE(layout.paragraphCount(), 4);
+    /* The duplicate paragraph is laid out just once */
+    CORRADE_COMPARE(layout.laidOutParagraphCount(), 3);
+    CORRADE_COMPARE(font.layoutCount, 3);
+
+    /* Nothing changed */
+    layout.update();
+    CORRADE_COMPARE(layout.laidOutParagraphCount(), 3);
+    CORRADE_COMPARE(font.layoutCount, 3);
+
+    /* Typing in the second paragraph, only that one is laid out again */
+    layout.replace(7, 7, "o long")
+        .update();
+    CORRADE_COMPARE(layout.text(), "one\ntwoo long\nthree\none");
+    CORRADE_COMPARE(layout.laidOutParagraphCount(), 1);
+    CORRADE_COMPARE(font.layoutCount, 5);
+    CORRADE_COMPARE(join(lineTexts(layout)), "|one|twoo long|three|one");
+
+    /* Following paragraphs moved to the new place */
+    CORRADE_COMPARE(layout.lines()[2].begin, 14);
+    CORRADE_COMPARE(layout.lines()[2].glyphBegin, 12);
+    CORRADE_COMPARE(layout.glyphs()[12].offset, 14);
+
+    /* Styling a paragraph lays it out again */
+    const UnsignedInt big = layout.addStyle(font, glyphCache, 4.0f);
+    layout.addSpan(14, 19, big)
+        .update();
+    CORRADE_COMPARE(layout.laidOutParagraphCount(), 1);
+    CORRADE_COMPARE(layout.lines()[2].baseline, -6.5f);
+    CORRADE_COMPARE(layout.lines()[3].baseline, -10.0f);
+
+    /* Inserting a line break lays out both new paragraphs */
+    layout.replace(7, 7, "\n")
+        .update();
+    CORRADE_COMPARE(layout.paragraphCount(), 5);
+    CORRADE_COMPARE(layout.laidOutParagraphCount(), 2);
+    CORRADE_COMPARE(join(lineTexts(layout)), "|one|two|o long|three|one");
+}
+
+void TextLayoutTest::incrementalUpdateWidth() {
+    UnitFont font;
+    TextLayout layout{font, glyphCache, 2.0f};
+    layout.setText("one\ntwo")
+        .update();
+    CORRADE_COMPARE(layout.laidOutParagraphCount(), 2);
+
+    /* Changing the width lays out everything again */
+    layout.setWidth(2.0f)
+        .update();
+    CORRADE_COMPARE(layout.laidOutParagraphCount(), 2);
+
+    /* Setting the same value does nothing */
+    layout.setWidth(2.0f)
+        .update();
+    CORRADE_COMPARE(layout.laidOutParagraphCount(), 2);
+    CORRADE_COMPARE(font.layoutCount, 4);
+
+    layout.clearCache()
+        .update();
+    CORRADE_COMPARE(layout.laidOutParagraphCount(), 2);
+    CORRADE_COMPARE(font.layoutCount, 6);
+}
+
+void TextLayoutTest::incrementalUpdateAlignment() {
+    UnitFont font;
+    TextLayout layout{font, glyphCache, 2.0f};
+    layout.setText("one\ntwo")
+        .update();
+    CORRADE_COMPARE(font.layoutCount, 2);
+
+    /* Alignment is applied when moving the paragraphs into place */
+    layout.setAlignment(Alignment::LineRight)
+        .update();
+    CORRADE_COMPARE(layout.laidOutParagraphCount(), 0);
+    CORRADE_COMPARE(font.layoutCount, 2);
+    CORRADE_COMPARE(layout.lines()[0].rectangle.left(), 0.0f);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Text::Test::TextLayoutTest)
@@ -38,15 +38,30 @@ namespace Magnum { namespace Text {
 class AbstractFont;
 class AbstractFontConverter;
 class AbstractLayouter;
+
+template<UnsignedInt> class BatchRenderer;
+typedef BatchRenderer<2> BatchRenderer2D;
+typedef BatchRenderer<3> BatchRenderer3D;
+
 class DistanceFieldGlyphCache;
 class GlyphCache;
+#ifndef MAGNUM_TARGET_GLES2
+class GlyphCacheArray;
+#endif
 
 enum class Alignment: UnsignedByte;
 
 class AbstractRenderer;
+
+template<UnsignedInt> class InstancedRenderer;
+typedef InstancedRenderer<2> InstancedRenderer2D;
+typedef InstancedRenderer<3> InstancedRenderer3D;
+
 template<UnsignedInt> class Renderer;
 typedef Renderer<2> Renderer2D;
 typedef Renderer<3> Renderer3D;
+
+class TextLayout;
 #endif
 
 }}
@@ -0,0 +1,499 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TextLayout.h"
+
+#include <algorithm>
+#include <limits>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Unicode.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Text/AbstractFont.h"
+
+namespace Magnum { namespace Text {
+
+/* Glyph and line positions are relative to the paragraph, i.e. offsets start
+   at paragraph begin, lines start at zero horizontally and the top of the
+   paragraph is at zero vertically */
+struct TextLayout::Paragraph {
+    std::vector<Glyph> glyphs;
+    std::vector<Line> lines;
+    Float height;
+};
+
+namespace {
+
+/* Part of a paragraph between two break opportunities, i.e. a word with
+   trailing spaces */
+struct Piece {
+    std::size_t begin, end;
+    std::size_t glyphBegin, glyphEnd;
+    /* Without and with the trailing spaces */
+    Float width, fullWidth;
+    Float ascent, descent, lineHeight;
+};
+
+inline bool isSpace(const char32_t c) { return c == U' ' || c == U'\t'; }
+
+/* Vertical metrics of a style, scaled to its size */
+void styleMetrics(const TextLayout::Style& style, Float& ascent, Float& descent, Float& lineHeight) {
+    const Float scale = style.size/style.font->size();
+    ascent = Math::max(ascent, style.font->ascent()*scale);
+    descent = Math::min(descent, style.font->descent()*scale);
+    lineHeight = Math::max(lineHeight, style.font->lineHeight()*scale);
+}
+
+}
+
+TextLayout::TextLayout(AbstractFont& font, const GlyphCache& cache, const Float size): _width{0.0f}, _lineBreaking{LineBreaking::Greedy}, _alignment{Alignment::LineLeft}, _dirty{true}, _laidOutParagraphCount{0} {
+    _styles.push_back({&font, &cache, size});
+}
+
+TextLayout::~TextLayout() = default;
+
+auto TextLayout::style(const UnsignedInt id) const -> const Style& {
+    CORRADE_ASSERT(id < _styles.size(),
+        "Text::TextLayout::style(): index" << id << "out of range for" << _styles.size() << "styles", _styles.front());
+    return _styles[id];
+}
+
+UnsignedInt TextLayout::addStyle(AbstractFont& font, const GlyphCache& cache, const Float size) {
+    _styles.push_back({&font, &cache, size});
+    return _styles.size() - 1;
+}
+
+TextLayout& TextLayout::setWidth(const Float width) {
+    if(_width != width) {
+        _width = width;
+        clearCache();
+    }
+    return *this;
+}
+
+TextLayout& TextLayout::setLineBreaking(const LineBreaking breaking) {
+    if(_lineBreaking != breaking) {
+        _lineBreaking = breaking;
+        clearCache();
+    }
+    return *this;
+}
+
+TextLayout& TextLayout::setAlignment(const Alignment alignment) {
+    _alignment = alignment;
+    _dirty = true;
+    return *this;
+}
+
+TextLayout& TextLayout::setText(std::string text) {
+    _text = std::move(text);
+    _spans.clear();
+    _dirty = true;
+    return *this;
+}
+
+TextLayout& TextLayout::replace(const std::size_t begin, const std::size_t end, const std::string& text) {
+    CORRADE_ASSERT(begin <= end && end <= _text.size(),
+        "Text::TextLayout::replace(): range" << begin << end << "out of bounds for" << _text.size() << "bytes", *this);
+
+    _text.replace(begin, end - begin, text);
+
+    /* Shift the spans after the range, collapse the parts inside the range
+       and extend spans ending inside it to cover the replacement */
+    const std::size_t replacementEnd = begin + text.size();
+    std::vector<Span> spans;
+    spans.reserve(_spans.size());
+    for(Span span: _spans) {
+        if(span.begin >= end) span.begin += replacementEnd - end;
+        else if(span.begin > begin) span.begin = replacementEnd;
+
+        if(span.end >= end) span.end += replacementEnd - end;
+        else if(span.end > begin) span.end = replacementEnd;
+
+        if(span.begin < span.end) spans.push_back(span);
+    }
+    _spans = std::move(spans);
+
+    _dirty = true;
+    return *this;
+}
+
+TextLayout& TextLayout::addSpan(const std::size_t begin, const std::size_t end, const UnsignedInt style) {
+    CORRADE_ASSERT(begin <= end && end <= _text.size(),
+        "Text::TextLayout::addSpan(): range" << begin << end << "out of bounds for" << _text.size() << "bytes", *this);
+    CORRADE_ASSERT(style < _styles.size(),
+        "Text::TextLayout::addSpan(): style" << style << "out of range for" << _styles.size() << "styles", *this);
+
+    if(begin == end) return *this;
+
+    /* Cut the overlapping parts out of existing spans, keeping them sorted */
+    std::vector<Span> spans;
+    spans.reserve(_spans.size() + 2);
+    bool inserted = false;
+    for(const Span& span: _spans) {
+        if(span.begin < begin) spans.push_back({span.begin, Math::min(span.end, begin), span.style});
+        if(!inserted && span.end > begin) {
+            spans.push_back({begin, end, style});
+            inserted = true;
+        }
+        if(span.end > end) spans.push_back({Math::max(span.begin, end), span.end, span.style});
+    }
+    if(!inserted) spans.push_back({begin, end, style});
+    _spans = std::move(spans);
+
+    _dirty = true;
+    return *this;
+}
+
+TextLayout& TextLayout::clearSpans() {
+    _spans.clear();
+    _dirty = true;
+    return *this;
+}
+
+TextLayout& TextLayout::clearCache() {
+    _cache.clear();
+    _dirty = true;
+    return *this;
+}
+
+const std::vector<TextLayout::Glyph>& TextLayout::glyphs() const {
+    CORRADE_ASSERT(!_dirty, "Text::TextLayout::glyphs(): the layout is not up-to-date, call update() first", _glyphs);
+    return _glyphs;
+}
+
+auto TextLayout::lines() const -> const std::vector<Line>& {
+    CORRADE_ASSERT(!_dirty, "Text::TextLayout::lines(): the layout is not up-to-date, call update() first", _lines);
+    return _lines;
+}
+
+Range2D TextLayout::rectangle() const {
+    CORRADE_ASSERT(!_dirty, "Text::TextLayout::rectangle(): the layout is not up-to-date, call update() first", {});
+    return _rectangle;
+}
+
+TextLayout& TextLayout::update() {
+    if(!_dirty) return *this;
+
+    /* Take over paragraphs from the previous update that have the same
+       contents and styles, lay out the rest */
+    std::unordered_map<std::string, std::shared_ptr<const Paragraph>> cache;
+    _paragraphs.clear();
+    _laidOutParagraphCount = 0;
+    std::vector<std::size_t> paragraphBegins;
+    auto span = _spans.begin();
+    for(std::size_t begin = 0; ; ) {
+        std::size_t end = _text.find('\n', begin);
+        if(end == std::string::npos) end = _text.size();
+
+        /* Style runs covering the whole paragraph, relative to its begin */
+        std::vector<Span> runs;
+        std::size_t position = begin;
+        while(span != _spans.end() && span->end <= begin) ++span;
+        for(auto it = span; it != _spans.end() && it->begin < end; ++it) {
+            const std::size_t runBegin = Math::max(it->begin, begin);
+            if(position < runBegin) runs.push_back({position - begin, runBegin - begin, 0});
+            position = Math::min(it->end, end);
+            runs.push_back({runBegin - begin, position - begin, it->style});
+        }
+        if(position < end) runs.push_back({position - begin, end - begin, 0});
+
+        /* The key is the paragraph text with the runs, prefixed with its
+           size to avoid ambiguity */
+        std::string key;
+        const std::size_t size = end - begin;
+        key.append(reinterpret_cast<const char*>(&size), sizeof(size));
+        key.append(_text, begin, size);
+        for(const Span& run: runs) {
+            const std::size_t data[]{run.begin, run.end, run.style};
+            key.append(reinterpret_cast<const char*>(data), sizeof(data));
+        }
+
+        std::shared_ptr<const Paragraph> paragraph;
+        auto found = cache.find(key);
+        if(found == cache.end()) {
+            found = _cache.find(key);
+            if(found != _cache.end()) paragraph = found->second;
+            else {
+                paragraph = layoutParagraph(begin, end, runs);
+                ++_laidOutParagraphCount;
+            }
+            cache.emplace(std::move(key), paragraph);
+        } else paragraph = found->second;
+
+        _paragraphs.push_back(paragraph);
+        paragraphBegins.push_back(begin);
+
+        if(end == _text.size()) break;
+        begin = end + 1;
+    }
+    _cache = std::move(cache);
+
+    /* Width to align the lines to */
+    Float alignmentWidth = _width;
+    if(!alignmentWidth) for(const std::shared_ptr<const Paragraph>& paragraph: _paragraphs)
+        for(const Line& line: paragraph->lines)
+            alignmentWidth = Math::max(alignmentWidth, line.rectangle.sizeX());
+
+    /* Vertical alignment offset, the paragraphs are stacked from zero
+       downwards */
+    Float height = 0.0f;
+    for(const std::shared_ptr<const Paragraph>& paragraph: _paragraphs)
+        height += paragraph->height;
+    Float y = 0.0f;
+    switch(UnsignedByte(_alignment) & Implementation::AlignmentVertical) {
+        case Implementation::AlignmentLine:
+            y = -_paragraphs.front()->lines.front().baseline;
+            break;
+        case Implementation::AlignmentMiddle:
+            y = height*0.5f;
+            break;
+    }
+    if(UnsignedByte(_alignment) & Implementation::AlignmentIntegral)
+        y = Math::round(y);
+
+    /* Move the paragraphs into place */
+    _glyphs.clear();
+    _lines.clear();
+    _rectangle = {};
+    for(std::size_t i = 0; i != _paragraphs.size(); ++i) {
+        const Paragraph& paragraph = *_paragraphs[i];
+        const UnsignedInt glyphOffset = _glyphs.size();
+        for(const Line& line: paragraph.lines) {
+            Float x = 0.0f;
+            switch(UnsignedByte(_alignment) & Implementation::AlignmentHorizontal) {
+                case Implementation::AlignmentCenter:
+                    x = (alignmentWidth - line.rectangle.sizeX())*0.5f;
+                    break;
+                case Implementation::AlignmentRight:
+                    x = alignmentWidth - line.rectangle.sizeX();
+                    break;
+            }
+            if(UnsignedByte(_alignment) & Implementation::AlignmentIntegral)
+                x = Math::round(x);
+
+            const Vector2 offset{x, y};
+            for(UnsignedInt j = line.glyphBegin; j != line.glyphEnd; ++j) {
+                const Glyph& glyph = paragraph.glyphs[j];
+                _glyphs.push_back({
+                    Range2D{glyph.position.min() + offset, glyph.position.max() + offset},
+                    glyph.textureCoordinates,
+                    glyph.offset + paragraphBegins[i],
+                    glyph.style});
+            }
+
+            const Range2D rectangle{line.rectangle.min() + offset, line.rectangle.max() + offset};
+            _lines.push_back({
+                line.begin + paragraphBegins[i],
+                line.end + paragraphBegins[i],
+                line.glyphBegin + glyphOffset,
+                line.glyphEnd + glyphOffset,
+                line.baseline + y,
+                rectangle});
+            _rectangle = _lines.size() == 1 ? rectangle :
+                Range2D{Math::min(_rectangle.min(), rectangle.min()),
+                        Math::max(_rectangle.max(), rectangle.max())};
+        }
+
+        y -= paragraph.height;
+    }
+
+    _dirty = false;
+    return *this;
+}
+
+std::shared_ptr<const TextLayout::Paragraph> TextLayout::layoutParagraph(const std::size_t begin, const std::size_t end, const std::vector<Span>& runs) {
+    const std::string text = _text.substr(begin, end - begin);
+
+    /* Split the paragraph into pieces after each sequence of spaces */
+    std::vector<Piece> pieces;
+    {
+        std::size_t pieceBegin = 0;
+        bool previousSpace = false;
+        for(std::size_t i = 0; i != text.size(); ) {
+            char32_t codepoint;
+            std::size_t next;
+            std::tie(codepoint, next) = Utility::Unicode::nextChar(text, i);
+            const bool space = isSpace(codepoint);
+            if(previousSpace && !space) {
+                pieces.push_back({pieceBegin, i, 0, 0, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f});
+                pieceBegin = i;
+            }
+            previousSpace = space;
+            i = next;
+        }
+        if(pieceBegin != text.size())
+            pieces.push_back({pieceBegin, text.size(), 0, 0, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f});
+    }
+
+    /* Lay out each style run of each piece, glyph positions are relative to
+       the piece begin and the baseline */
+    std::vector<Glyph> glyphs;
+    std::vector<std::pair<char32_t, std::size_t>> codepoints;
+    auto run = runs.begin();
+    for(Piece& piece: pieces) {
+        piece.glyphBegin = glyphs.size();
+        Vector2 cursor;
+        for(; run != runs.end() && run->begin < piece.end; ++run) {
+            const std::size_t runBegin = Math::max(run->begin, piece.begin);
+            const std::size_t runEnd = Math::min(run->end, piece.end);
+            const Style& style = _styles[run->style];
+            styleMetrics(style, piece.ascent, piece.descent, piece.lineHeight);
+
+            const std::string runText = text.substr(runBegin, runEnd - runBegin);
+            codepoints.clear();
+            for(std::size_t i = 0; i != runText.size(); ) {
+                const std::size_t offset = i;
+                char32_t codepoint;
+                std::tie(codepoint, i) = Utility::Unicode::nextChar(runText, i);
+                codepoints.emplace_back(codepoint, runBegin + offset);
+            }
+
+            const std::unique_ptr<AbstractLayouter> layouter = style.font->layout(*style.cache, style.size, runText);
+            if(layouter) {
+                /* Kerning and per-character offsets make sense only if the
+                   glyphs map to characters */
+                const bool perCharacter = layouter->glyphCount() == codepoints.size();
+                const bool kerning = perCharacter && style.font->features() & AbstractFont::Feature::Kerning;
+                const Float scale = style.size/style.font->size();
+
+                Range2D rectangle;
+                UnsignedInt previousGlyphId = 0;
+                for(UnsignedInt i = 0; i != layouter->glyphCount(); ++i) {
+                    if(kerning) {
+                        const UnsignedInt glyphId = style.font->glyphId(codepoints[i].first);
+                        if(i) cursor += style.font->glyphKerning(previousGlyphId, glyphId)*scale;
+                        previousGlyphId = glyphId;
+                    }
+
+                    Range2D position, textureCoordinates;
+                    std::tie(position, textureCoordinates) = layouter->renderGlyph(i, cursor, rectangle);
+                    glyphs.push_back({position, textureCoordinates,
+                        perCharacter ? codepoints[i].second : runBegin, run->style});
+
+                    if(!perCharacter || !isSpace(codepoints[i].first))
+                        piece.width = cursor.x();
+                }
+            }
+
+            /* The run continues in the next piece */
+            if(run->end > piece.end) break;
+        }
+
+        piece.glyphEnd = glyphs.size();
+        piece.fullWidth = cursor.x();
+    }
+
+    /* Break the pieces into lines, lineEnds contain one-past-the-last piece
+       of each line */
+    std::vector<std::size_t> lineEnds;
+    if(!_width || pieces.size() <= 1) lineEnds.push_back(pieces.size());
+    else if(_lineBreaking == LineBreaking::Greedy) {
+        Float lineWidth = 0.0f;
+        for(std::size_t i = 0; i != pieces.size(); ++i) {
+            const bool lineStart = lineEnds.empty() ? i == 0 : i == lineEnds.back();
+            if(!lineStart && lineWidth + pieces[i].width > _width) {
+                lineEnds.push_back(i);
+                lineWidth = 0.0f;
+            }
+            lineWidth += pieces[i].fullWidth;
+        }
+        lineEnds.push_back(pieces.size());
+    } else {
+        /* Minimal sum of squared unused space for lines ending before each
+           piece, the last line is free */
+        const std::size_t n = pieces.size();
+        std::vector<Float> cost(n + 1, std::numeric_limits<Float>::infinity());
+        std::vector<std::size_t> lineBegin(n + 1, 0);
+        cost[0] = 0.0f;
+        for(std::size_t j = 1; j <= n; ++j) {
+            Float lineWidth = 0.0f;
+            for(std::size_t i = j; i-- > 0; ) {
+                /* Width of pieces i to j - 1 without the trailing spaces */
+                const Float width = pieces[i].width + lineWidth;
+                lineWidth += pieces[i].fullWidth;
+
+                /* A piece that doesn't fit on its own overflows the line */
+                if(width > _width && i != j - 1) break;
+                const Float unused = j == n || width > _width ? 0.0f : _width - width;
+                if(cost[i] + unused*unused < cost[j]) {
+                    cost[j] = cost[i] + unused*unused;
+                    lineBegin[j] = i;
+                }
+            }
+        }
+
+        for(std::size_t j = n; j; j = lineBegin[j]) lineEnds.push_back(j);
+        std::reverse(lineEnds.begin(), lineEnds.end());
+    }
+
+    /* Put the pieces of each line together */
+    std::shared_ptr<Paragraph> paragraph = std::make_shared<Paragraph>();
+    paragraph->glyphs.reserve(glyphs.size());
+    Float y = 0.0f;
+    std::size_t pieceBegin = 0;
+    for(const std::size_t pieceEnd: lineEnds) {
+        Float ascent = 0.0f, descent = 0.0f, lineHeight = 0.0f;
+        Float x = 0.0f, width = 0.0f;
+
+        /* Empty paragraph has a single empty line in the default style */
+        if(pieceBegin == pieceEnd) styleMetrics(_styles[0], ascent, descent, lineHeight);
+
+        for(std::size_t i = pieceBegin; i != pieceEnd; ++i) {
+            ascent = Math::max(ascent, pieces[i].ascent);
+            descent = Math::min(descent, pieces[i].descent);
+            lineHeight = Math::max(lineHeight, pieces[i].lineHeight);
+        }
+
+        const Float baseline = y - ascent;
+        const UnsignedInt glyphBegin = paragraph->glyphs.size();
+        for(std::size_t i = pieceBegin; i != pieceEnd; ++i) {
+            const Vector2 offset{x, baseline};
+            for(std::size_t j = pieces[i].glyphBegin; j != pieces[i].glyphEnd; ++j) {
+                const Glyph& glyph = glyphs[j];
+                paragraph->glyphs.push_back({
+                    Range2D{glyph.position.min() + offset, glyph.position.max() + offset},
+                    glyph.textureCoordinates, glyph.offset, glyph.style});
+            }
+
+            width = x + pieces[i].width;
+            x += pieces[i].fullWidth;
+        }
+
+        paragraph->lines.push_back({
+            pieceBegin == pieceEnd ? 0 : pieces[pieceBegin].begin,
+            pieceBegin == pieceEnd ? 0 : pieces[pieceEnd - 1].end,
+            glyphBegin, UnsignedInt(paragraph->glyphs.size()), baseline,
+            Range2D{{0.0f, baseline + descent}, {width, baseline + ascent}}});
+
+        y -= lineHeight;
+        pieceBegin = pieceEnd;
+    }
+    paragraph->height = -y;
+
+    return paragraph;
+}
+
+}}
@@ -0,0 +1,383 @@
+#ifndef Magnum_Text_TextLayout_h
+#define Magnum_Text_TextLayout_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Text::TextLayout
+ */
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Text/Alignment.h"
+#include "Magnum/Text/Text.h"
+#include "Magnum/Text/visibility.h"
+
+namespace Magnum { namespace Text {
+
+/**
+@brief Multi-line text layout
+
+Lays out UTF-8 text with multiple styles into lines of given width, applying
+kerning supplied by the font. The result is a list of positioned glyph quads
+with texture coordinates, which can be put into a vertex buffer in a single
+pass, and a list of lines, useful for example for cursor placement and
+selection highlighting.
+
+## Usage
+
+The layout is created with a default style, additional styles with different
+font, glyph cache or size can be added with @ref addStyle() and applied to
+byte ranges of the text with @ref addSpan(). Call @ref update() after changing
+the text or the layout properties to make the glyphs and lines up-to-date.
+
+@code
+std::unique_ptr<Text::AbstractFont> font, boldFont;
+Text::GlyphCache cache, boldCache;
+
+Text::TextLayout layout{*font, cache, 0.1f};
+UnsignedInt bold = layout.addStyle(*boldFont, boldCache, 0.1f);
+layout.setWidth(2.0f)
+    .setLineBreaking(Text::TextLayout::LineBreaking::Optimal)
+    .setText("Hello world!\nThis is a long paragraph of text.")
+    .addSpan(6, 11, bold)
+    .update();
+
+for(const Text::TextLayout::Glyph& glyph: layout.glyphs()) {
+    // fill the vertex data from glyph.position and glyph.textureCoordinates,
+    // batch by glyph.style
+}
+@endcode
+
+## Line breaking
+
+Lines are broken only at spaces, the trailing spaces on each line don't count
+into its width. A word which doesn't fit into the width on its own is put on
+a separate line and overflows it. The @ref LineBreaking::Greedy mode fills
+each line with as many words as possible, @ref LineBreaking::Optimal minimizes
+sum of squared unused space on all lines except the last one of each
+paragraph, which gives more even lines at the cost of more computation.
+Explicit line breaks are denoted by `\n`.
+
+## Kerning
+
+Each style run is laid out through @ref AbstractFont::layout(), so the font's
+own layout cache is used if enabled. If the font supports
+@ref AbstractFont::Feature::Kerning and its layouter produces one glyph per
+character, advances between consecutive glyphs of the same style inside a word
+are adjusted using @ref AbstractFont::glyphKerning().
+
+## Incremental updates
+
+The text is laid out per paragraph and the result of each paragraph is cached
+together with its contents and styles. On @ref update() only the paragraphs
+that changed since the previous update are laid out again, the others are just
+moved to their new position. Combined with @ref replace(), which keeps the
+spans in place, this makes editing of a long document cheap. Changing the
+width, line breaking mode or contents of a glyph cache used by one of the
+styles requires laying out everything again, in the last case call
+@ref clearCache() manually.
+
+@see @ref Renderer, @ref BatchRenderer
+*/
+class MAGNUM_TEXT_EXPORT TextLayout {
+    public:
+        /**
+         * @brief Line breaking mode
+         *
+         * @see @ref setLineBreaking()
+         */
+        enum class LineBreaking: UnsignedByte {
+            Greedy,     /**< Put as many words on each line as possible */
+            Optimal     /**< Minimize unused space on all lines */
+        };
+
+        /**
+         * @brief Style
+         *
+         * @see @ref addStyle(), @ref style()
+         */
+        struct Style {
+            AbstractFont* font;         /**< Font */
+            const GlyphCache* cache;    /**< Glyph cache */
+            Float size;                 /**< Font size */
+        };
+
+        /**
+         * @brief Styled span
+         *
+         * @see @ref addSpan(), @ref spans()
+         */
+        struct Span {
+            std::size_t begin;  /**< Begin of the span in bytes */
+            std::size_t end;    /**< End of the span in bytes */
+            UnsignedInt style;  /**< Style ID */
+        };
+
+        /**
+         * @brief Laid out glyph
+         *
+         * @see @ref glyphs()
+         */
+        struct Glyph {
+            Range2D position;           /**< Quad position */
+            Range2D textureCoordinates; /**< Quad texture coordinates */
+
+            /**
+             * Byte offset of the character in the text. If the font layouter
+             * doesn't produce one glyph per character, all glyphs of the
+             * style run have offset of the run begin.
+             */
+            std::size_t offset;
+
+            UnsignedInt style;          /**< Style ID */
+        };
+
+        /**
+         * @brief Laid out line
+         *
+         * @see @ref lines()
+         */
+        struct Line {
+            std::size_t begin;      /**< Begin of the line in bytes */
+
+            /**
+             * End of the line in bytes, including trailing spaces, excluding
+             * the `\n` character
+             */
+            std::size_t end;
+
+            UnsignedInt glyphBegin; /**< First glyph of the line */
+            UnsignedInt glyphEnd;   /**< One after the last glyph of the line */
+            Float baseline;         /**< Vertical position of the baseline */
+
+            /**
+             * Line rectangle, spanning the line width without trailing
+             * spaces horizontally and the ascent and descent of all styles
+             * used on the line vertically
+             */
+            Range2D rectangle;
+        };
+
+        /**
+         * @brief Constructor
+         * @param font      Font of the default style
+         * @param cache     Glyph cache of the default style
+         * @param size      Font size of the default style
+         *
+         * The default style has ID @cpp 0 @ce and is applied to all text not
+         * covered by any span.
+         */
+        explicit TextLayout(AbstractFont& font, const GlyphCache& cache, Float size);
+        TextLayout(AbstractFont&, GlyphCache&&, Float) = delete; /**< @overload */
+
+        ~TextLayout();
+
+        /** @brief Count of styles */
+        std::size_t styleCount() const { return _styles.size(); }
+
+        /** @brief Style */
+        const Style& style(UnsignedInt id) const;
+
+        /**
+         * @brief Add a style
+         * @return ID of the style for use in @ref addSpan()
+         */
+        UnsignedInt addStyle(AbstractFont& font, const GlyphCache& cache, Float size);
+        UnsignedInt addStyle(AbstractFont&, GlyphCache&&, Float) = delete; /**< @overload */
+
+        /** @brief Line width */
+        Float width() const { return _width; }
+
+        /**
+         * @brief Set line width
+         * @return Reference to self (for method chaining)
+         *
+         * If set to @cpp 0.0f @ce, lines are broken only at explicit line
+         * breaks. Default is @cpp 0.0f @ce. Changing the value causes all
+         * paragraphs to be laid out again.
+         */
+        TextLayout& setWidth(Float width);
+
+        /** @brief Line breaking mode */
+        LineBreaking lineBreaking() const { return _lineBreaking; }
+
+        /**
+         * @brief Set line breaking mode
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @ref LineBreaking::Greedy. Changing the value causes all
+         * paragraphs to be laid out again.
+         */
+        TextLayout& setLineBreaking(LineBreaking breaking);
+
+        /** @brief Alignment */
+        Alignment alignment() const { return _alignment; }
+
+        /**
+         * @brief Set alignment
+         * @return Reference to self (for method chaining)
+         *
+         * The horizontal alignment is done relative to the line width or, if
+         * it's zero, to the widest line. Vertically the text is aligned with
+         * its top, middle or baseline of the first line at origin. Default is
+         * @ref Alignment::LineLeft. Changing the value doesn't cause any
+         * paragraph to be laid out again.
+         */
+        TextLayout& setAlignment(Alignment alignment);
+
+        /** @brief Text */
+        const std::string& text() const { return _text; }
+
+        /**
+         * @brief Set text
+         * @return Reference to self (for method chaining)
+         *
+         * Removes all spans.
+         * @see @ref replace()
+         */
+        TextLayout& setText(std::string text);
+
+        /**
+         * @brief Replace part of the text
+         * @param begin     Begin of the replaced range in bytes
+         * @param end       End of the replaced range in bytes
+         * @param text      Replacement
+         * @return Reference to self (for method chaining)
+         *
+         * Spans after the replaced range are shifted, spans ending inside or
+         * at the end of the replaced range are extended to cover the
+         * replacement, spans fully inside the range are removed. Inserting
+         * at the end of a span thus continues in its style.
+         */
+        TextLayout& replace(std::size_t begin, std::size_t end, const std::string& text);
+
+        /**
+         * @brief Styled spans
+         *
+         * Sorted and non-overlapping.
+         */
+        const std::vector<Span>& spans() const { return _spans; }
+
+        /**
+         * @brief Apply style to a range of text
+         * @param begin     Begin of the range in bytes
+         * @param end       End of the range in bytes
+         * @param style     Style ID
+         * @return Reference to self (for method chaining)
+         *
+         * Overrides styles of previously added spans in given range.
+         */
+        TextLayout& addSpan(std::size_t begin, std::size_t end, UnsignedInt style);
+
+        /**
+         * @brief Remove all spans
+         * @return Reference to self (for method chaining)
+         */
+        TextLayout& clearSpans();
+
+        /**
+         * @brief Update the layout
+         * @return Reference to self (for method chaining)
+         *
+         * Lays out the paragraphs changed since the previous call and
+         * updates @ref glyphs(), @ref lines() and @ref rectangle(). Does
+         * nothing if nothing changed.
+         */
+        TextLayout& update();
+
+        /**
+         * @brief Discard all cached paragraphs
+         * @return Reference to self (for method chaining)
+         *
+         * Causes all paragraphs to be laid out again on next @ref update().
+         * Needs to be called when contents of any of the glyph caches
+         * change.
+         */
+        TextLayout& clearCache();
+
+        /**
+         * @brief Laid out glyphs
+         *
+         * Sorted by the line they're on. Expects that @ref update() was
+         * called after the last change.
+         */
+        const std::vector<Glyph>& glyphs() const;
+
+        /**
+         * @brief Laid out lines
+         *
+         * Expects that @ref update() was called after the last change.
+         */
+        const std::vector<Line>& lines() const;
+
+        /**
+         * @brief Rectangle spanning all lines
+         *
+         * Expects that @ref update() was called after the last change.
+         */
+        Range2D rectangle() const;
+
+        /** @brief Count of paragraphs */
+        std::size_t paragraphCount() const { return _paragraphs.size(); }
+
+        /**
+         * @brief Count of paragraphs laid out in the last update
+         *
+         * The remaining paragraphs were taken from the cache.
+         */
+        std::size_t laidOutParagraphCount() const { return _laidOutParagraphCount; }
+
+    private:
+        struct Paragraph;
+
+        MAGNUM_TEXT_LOCAL std::shared_ptr<const Paragraph> layoutParagraph(std::size_t begin, std::size_t end, const std::vector<Span>& runs);
+
+        std::vector<Style> _styles;
+        Float _width;
+        LineBreaking _lineBreaking;
+        Alignment _alignment;
+        bool _dirty;
+
+        std::string _text;
+        std::vector<Span> _spans;
+
+        std::vector<std::shared_ptr<const Paragraph>> _paragraphs;
+        std::unordered_map<std::string, std::shared_ptr<const Paragraph>> _cache;
+        std::size_t _laidOutParagraphCount;
+
+        std::vector<Glyph> _glyphs;
+        std::vector<Line> _lines;
+        Range2D _rectangle;
+};
+
+}}
+
+#endif
@@ -23,13 +23,22 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <algorithm>
+#include <sstream>
+#include <thread>
 #include <Corrade/PluginManager/Manager.h>
 #include <Corrade/Utility/Arguments.h>
+#include <Corrade/Utility/Configuration.h>
 #include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/MurmurHash2.h>
 
+#include "Magnum/Image.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/TextureFormat.h"
 #include "Magnum/Text/AbstractFont.h"
 #include "Magnum/Text/AbstractFontConverter.h"
 #include "Magnum/Text/DistanceFieldGlyphCache.h"
+#include "Magnum/TextureTools/DistanceField.h"
 #include "Magnum/Trade/AbstractImageConverter.h"
 
 #ifdef MAGNUM_TARGET_HEADLESS
@@ -66,12 +75,13 @@ namespace Magnum {
 
 @section magnum-fontconverter-usage Usage
 
-    magnum-fontconverter [--magnum-...] [-h|--help] --font FONT --converter CONVERTER [--plugin-dir DIR] [--characters CHARACTERS] [--font-size N] [--atlas-size "X Y"] [--output-size "X Y"] [--radius N] [--] input output
+    magnum-fontconverter [--magnum-...] [-h|--help] --font FONT --converter CONVERTER [--plugin-dir DIR] [--characters CHARACTERS] [--font-size N] [--atlas-size "X Y"] [--output-size "X Y"] [--radius N] [--cpu] [--threads N] [--batch] [--force] [--] input output
 
 Arguments:
 
--   `input` -- input font
--   `output` -- output filename prefix
+-   `input` -- input font or a batch manifest if `--batch` is set
+-   `output` -- output filename prefix or an output directory if `--batch` is
+    set
 -   `-h`, `--help` -- display help message and exit
 -   `--font FONT` -- font plugin
 -   `--converter CONVERTER` -- font converter plugin
@@ -84,11 +94,47 @@ Arguments:
 -   `--output-size "X Y"` -- output atlas size. If set to zero size, distance
     field computation will not be used. (default: `"256 256"`)
 -   `--radius N` -- distance field computation radius (default: `24`)
+-   `--cpu` -- compute the distance field on the CPU instead of using the
+    distance field shader. The GL context is still needed for rasterizing the
+    glyph atlas. Available only on desktop OpenGL.
+-   `--threads N` -- count of worker threads for the CPU distance field
+    computation (default: `0`, which means hardware concurrency)
+-   `--batch` -- treat `input` as a batch manifest, see
+    @ref magnum-fontconverter-batch
+-   `--force` -- in batch mode, convert also fonts which are up-to-date
 -   `--magnum-...` -- engine-specific options (see @ref Context for details)
 
 The resulting font files can be then used as specified in the documentation of
 `converter` plugin.
 
+@section magnum-fontconverter-batch Batch conversion
+
+With `--batch`, the `input` is a configuration file listing fonts to convert,
+one `font` group for each output. Values not present in the group are taken
+from the command line, paths to input fonts and character files are relative to
+the manifest and output prefixes are relative to the `output` directory:
+
+    # fonts.conf
+    [font]
+    input=DejaVuSans.ttf
+    output=dejavu-latin
+
+    [font]
+    input=DroidSansJapanese.ttf
+    output=droid-japanese
+    characters-file=japanese.txt
+    font-size=96
+    output-size=512 512
+
+For each output a `.stamp` file with a hash of the input font and all
+conversion parameters is written next to it. Fonts whose stamp matches are
+skipped on subsequent runs, unless `--force` is set.
+
+When combined with `--cpu`, glyphs of up to `--threads` fonts are rasterized
+on the main thread (the GL context can't be shared with worker threads) and the
+distance field of all of them is then computed concurrently, with the worker
+threads split among the fonts.
+
 @section magnum-fontconverter-example Example usage
 
 Making raster font from TTF file with default set of characters using
@@ -100,10 +146,33 @@ Making raster font from TTF file with default set of characters using
 According to `MagnumFontConverter` plugin documentation, this will generate
 files `myfont.conf` and `myfont.tga` in current directory. You can then load
 and use them with the @ref Text::MagnumFont "MagnumFont" plugin.
+
+Converting all fonts listed in the above manifest into the `build/fonts/`
+directory, computing the distance fields on the CPU:
+
+    magnum-fontconverter --font FreeTypeFont --converter MagnumFontConverter --cpu --batch fonts.conf build/fonts
 */
 
 namespace Text {
 
+namespace {
+
+struct Job {
+    std::string input, output, characters;
+    Float fontSize;
+    Vector2i atlasSize, outputSize;
+    Int radius;
+    std::string stamp;
+
+    std::unique_ptr<AbstractFont> font;
+    #ifndef MAGNUM_TARGET_GLES
+    std::unique_ptr<GlyphCache> sourceCache;
+    std::unique_ptr<Image2D> sourceImage, distanceFieldImage;
+    #endif
+};
+
+}
+
 class FontConverter: public Platform::WindowlessApplication {
     public:
         explicit FontConverter(const Arguments& arguments);
@@ -111,12 +180,21 @@ class FontConverter: public Platform::WindowlessApplication {
         int exec() override;
 
     private:
+        bool readManifest(std::vector<Job>& jobs) const;
+        std::string stamp(const Job& job) const;
+        bool open(PluginManager::Manager<AbstractFont>& fontManager, Job& job) const;
+        bool convert(AbstractFontConverter& converter, Job& job) const;
+        #ifndef MAGNUM_TARGET_GLES
+        bool convertOnCpu(PluginManager::Manager<AbstractFont>& fontManager, AbstractFontConverter& converter, std::vector<Job>& jobs) const;
+        #endif
+        bool save(AbstractFontConverter& converter, Job& job, GlyphCache& cache) const;
+
         Utility::Arguments args;
 };
 
 FontConverter::FontConverter(const Arguments& arguments): Platform::WindowlessApplication{arguments, NoCreate} {
-    args.addArgument("input").setHelp("input", "input font")
-        .addArgument("output").setHelp("output", "output filename prefix")
+    args.addArgument("input").setHelp("input", "input font or a batch manifest")
+        .addArgument("output").setHelp("output", "output filename prefix or an output directory in batch mode")
         .addNamedArgument("font").setHelp("font", "font plugin")
         .addNamedArgument("converter").setHelp("converter", "font converter plugin")
         .addOption("plugin-dir", Utility::Directory::join(Utility::Directory::path(Utility::Directory::executableLocation()), MAGNUM_PLUGINS_DIR)).setHelp("plugin-dir", "base plugin dir", "DIR")
@@ -127,6 +205,12 @@ FontConverter::FontConverter(const Arguments& arguments): Platform::WindowlessAp
         .addOption("atlas-size", "2048 2048").setHelp("atlas-size", "glyph atlas size", "\"X Y\"")
         .addOption("output-size", "256 256").setHelp("output-size", "output atlas size. If set to zero size, distance field computation will not be used.", "\"X Y\"")
         .addOption("radius", "24").setHelp("radius", "distance field computation radius", "N")
+        #ifndef MAGNUM_TARGET_GLES
+        .addBooleanOption("cpu").setHelp("cpu", "compute the distance field on the CPU")
+        .addOption("threads", "0").setHelp("threads", "count of worker threads for the CPU distance field computation, 0 means hardware concurrency", "N")
+        #endif
+        .addBooleanOption("batch").setHelp("batch", "treat input as a batch manifest")
+        .addBooleanOption("force").setHelp("force", "in batch mode, convert also fonts which are up-to-date")
         .addSkippedPrefix("magnum", "engine-specific options")
         .setHelp("Converts font to raster one of given atlas size.")
         .parse(arguments.argc, arguments.argv);
@@ -134,15 +218,176 @@ FontConverter::FontConverter(const Arguments& arguments): Platform::WindowlessAp
     createContext();
 }
 
+bool FontConverter::readManifest(std::vector<Job>& jobs) const {
+    const Utility::Configuration manifest{args.value("input"), Utility::Configuration::Flag::ReadOnly};
+    if(!manifest.isValid()) {
+        Error() << "Cannot read batch manifest" << args.value("input");
+        return false;
+    }
+
+    const std::string manifestPath = Utility::Directory::path(args.value("input"));
+    for(const Utility::ConfigurationGroup* group: manifest.groups("font")) {
+        if(!group->hasValue("input") || !group->hasValue("output")) {
+            Error() << "Font in batch manifest" << args.value("input") << "is missing input or output";
+            return false;
+        }
+
+        Job job;
+        job.input = Utility::Directory::join(manifestPath, group->value("input"));
+        job.output = Utility::Directory::join(args.value("output"), group->value("output"));
+        if(group->hasValue("characters-file")) {
+            const std::string charactersFile = Utility::Directory::join(manifestPath, group->value("characters-file"));
+            if(!Utility::Directory::fileExists(charactersFile)) {
+                Error() << "Cannot read characters from" << charactersFile;
+                return false;
+            }
+            job.characters = Utility::Directory::readString(charactersFile);
+        } else job.characters = group->hasValue("characters") ? group->value("characters") : args.value("characters");
+        job.fontSize = group->hasValue("font-size") ? group->value<Float>("font-size") : args.value<Float>("font-size");
+        job.atlasSize = group->hasValue("atlas-size") ? group->value<Vector2i>("atlas-size") : args.value<Vector2i>("atlas-size");
+        job.outputSize = group->hasValue("output-size") ? group->value<Vector2i>("output-size") : args.value<Vector2i>("output-size");
+        job.radius = group->hasValue("radius") ? group->value<Int>("radius") : args.value<Int>("radius");
+        jobs.push_back(std::move(job));
+    }
+
+    return true;
+}
+
+std::string FontConverter::stamp(const Job& job) const {
+    /* Everything that affects the output goes into the hash. The CPU and GPU
+       distance field computation give slightly different results. */
+    std::ostringstream parameters;
+    parameters << args.value("font") << '\n' << args.value("converter") << '\n'
+        << job.characters << '\n' << job.fontSize << '\n'
+        << job.atlasSize.x() << ' ' << job.atlasSize.y() << '\n'
+        << job.outputSize.x() << ' ' << job.outputSize.y() << '\n'
+        << job.radius << '\n'
+        #ifndef MAGNUM_TARGET_GLES
+        << args.isSet("cpu") << '\n'
+        #endif
+        << Utility::Directory::readString(job.input);
+
+    return Utility::MurmurHash2{}(parameters.str()).hexString();
+}
+
+bool FontConverter::open(PluginManager::Manager<AbstractFont>& fontManager, Job& job) const {
+    job.font = fontManager.instance(args.value("font"));
+    if(!job.font->openFile(job.input, job.fontSize)) {
+        Error() << "Cannot open font" << job.input;
+        return false;
+    }
+
+    return true;
+}
+
+bool FontConverter::convert(AbstractFontConverter& converter, Job& job) const {
+    /* Create distance field glyph cache if output size is specified */
+    std::unique_ptr<GlyphCache> cache;
+    if(!job.outputSize.isZero()) {
+        Debug() << "Populating distance field glyph cache...";
+
+        cache.reset(new DistanceFieldGlyphCache(job.atlasSize, job.outputSize, job.radius));
+
+    /* Otherwise use normal cache */
+    } else {
+        Debug() << "Zero-size distance field output specified, populating normal glyph cache...";
+
+        cache.reset(new GlyphCache(job.atlasSize));
+    }
+
+    job.font->fillGlyphCache(*cache, job.characters);
+
+    return save(converter, job, *cache);
+}
+
+#ifndef MAGNUM_TARGET_GLES
+bool FontConverter::convertOnCpu(PluginManager::Manager<AbstractFont>& fontManager, AbstractFontConverter& converter, std::vector<Job>& jobs) const {
+    UnsignedInt threadCount = args.value<UnsignedInt>("threads");
+    if(!threadCount) threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+    /* Process the fonts in chunks to avoid having tens of full-size source
+       atlases in memory at once */
+    bool success = true;
+    for(std::size_t begin = 0; begin < jobs.size(); begin += threadCount) {
+        const std::size_t end = std::min(begin + threadCount, jobs.size());
+
+        /* Rasterize the glyphs into ordinary caches with the same padding as
+           the distance field cache would use. The GL context is bound to the
+           main thread, so this can't be parallelized. */
+        std::vector<Job*> chunk;
+        for(std::size_t i = begin; i != end; ++i) {
+            Job& job = jobs[i];
+            if(!open(fontManager, job)) {
+                success = false;
+                continue;
+            }
+
+            Debug() << "Populating glyph cache for" << job.output << Debug::nospace << "...";
+
+            job.sourceCache.reset(new GlyphCache{TextureFormat::R8, job.atlasSize, job.atlasSize, Vector2i(job.radius)});
+            job.font->fillGlyphCache(*job.sourceCache, job.characters);
+            job.sourceImage.reset(new Image2D{PixelFormat::Red, PixelType::UnsignedByte});
+            job.sourceCache->texture().image(0, *job.sourceImage);
+            chunk.push_back(&job);
+        }
+
+        if(chunk.empty()) continue;
+
+        /* Compute the distance fields concurrently, splitting the available
+           threads among the fonts */
+        Debug() << "Converting" << chunk.size() << "glyph caches to distance field on the CPU...";
+        const UnsignedInt threadsPerJob = std::max(threadCount/UnsignedInt(chunk.size()), 1u);
+        std::vector<std::thread> workers;
+        workers.reserve(chunk.size());
+        for(Job* job: chunk) workers.emplace_back([job, threadsPerJob]() {
+            job->distanceFieldImage.reset(new Image2D{TextureTools::distanceField(*job->sourceImage, job->outputSize, job->radius, threadsPerJob)});
+        });
+        for(std::thread& worker: workers) worker.join();
+
+        /* Upload the results and export them, again on the main thread */
+        for(Job* job: chunk) {
+            DistanceFieldGlyphCache cache{job->atlasSize, job->outputSize, job->radius};
+            cache.setDistanceFieldImage({}, *job->distanceFieldImage);
+            for(const std::pair<UnsignedInt, std::pair<Vector2i, Range2Di>>& glyph: *job->sourceCache)
+                cache.insert(glyph.first, glyph.second.first, glyph.second.second);
+
+            if(!save(converter, *job, cache)) success = false;
+
+            /* Free the memory before the next chunk */
+            job->font = nullptr;
+            job->sourceCache = nullptr;
+            job->sourceImage = nullptr;
+            job->distanceFieldImage = nullptr;
+        }
+    }
+
+    return success;
+}
+#endif
+
+bool FontConverter::save(AbstractFontConverter& converter, Job& job, GlyphCache& cache) const {
+    Debug() << "Converting font" << job.output << Debug::nospace << "...";
+
+    if(!converter.exportFontToFile(*job.font, cache, job.output, job.characters)) {
+        Error() << "Cannot export font to" << job.output;
+        return false;
+    }
+
+    /* Remember what the output was generated from */
+    if(!job.stamp.empty() && !Utility::Directory::writeString(job.output + ".stamp", job.stamp))
+        Warning() << "Cannot write stamp file for" << job.output;
+
+    return true;
+}
+
 int FontConverter::exec() {
     /* Font converter dependencies */
     PluginManager::Manager<Trade::AbstractImageConverter> imageConverterManager(Utility::Directory::join(args.value("plugin-dir"), "imageconverters/"));
 
-    /* Load font */
+    /* Load font plugin */
     PluginManager::Manager<Text::AbstractFont> fontManager(Utility::Directory::join(args.value("plugin-dir"), "fonts/"));
     if(!(fontManager.load(args.value("font")) & PluginManager::LoadState::Loaded))
         std::exit(1);
-    std::unique_ptr<Text::AbstractFont> font = fontManager.instance(args.value("font"));
 
     /* Load font converter */
     PluginManager::Manager<Text::AbstractFontConverter> converterManager(Utility::Directory::join(args.value("plugin-dir"), "fontconverters/"));
@@ -150,40 +395,68 @@ int FontConverter::exec() {
         std::exit(1);
     std::unique_ptr<Text::AbstractFontConverter> converter = converterManager.instance(args.value("converter"));
 
-    /* Open font */
-    if(!font->openFile(args.value("input"), args.value<Float>("font-size"))) {
-        Error() << "Cannot open font" << args.value("input");
-        std::exit(1);
-    }
-
-    /* Create distance field glyph cache if radius is specified */
-    std::unique_ptr<Text::GlyphCache> cache;
-    if(!args.value<Vector2i>("output-size").isZero()) {
-        Debug() << "Populating distance field glyph cache...";
-
-        cache.reset(new Text::DistanceFieldGlyphCache(
-            args.value<Vector2i>("atlas-size"),
-            args.value<Vector2i>("output-size"),
-            args.value<Int>("radius")));
+    /* Gather the fonts to convert */
+    std::vector<Job> jobs;
+    if(args.isSet("batch")) {
+        std::vector<Job> manifestJobs;
+        if(!readManifest(manifestJobs)) std::exit(1);
+
+        /* Skip fonts that didn't change since the last run */
+        for(Job& job: manifestJobs) {
+            if(!Utility::Directory::fileExists(job.input)) {
+                Error() << "Cannot open font" << job.input;
+                std::exit(1);
+            }
+
+            job.stamp = stamp(job);
+            const std::string stampFile = job.output + ".stamp";
+            if(!args.isSet("force") && Utility::Directory::fileExists(stampFile) && Utility::Directory::readString(stampFile) == job.stamp) {
+                Debug() << "Skipping up-to-date" << job.output;
+                continue;
+            }
+
+            jobs.push_back(std::move(job));
+        }
 
-    /* Otherwise use normal cache */
     } else {
-        Debug() << "Zero-size distance field output specified, populating normal glyph cache...";
-
-        cache.reset(new Text::GlyphCache(args.value<Vector2i>("atlas-size")));
+        Job job;
+        job.input = args.value("input");
+        job.output = args.value("output");
+        job.characters = args.value("characters");
+        job.fontSize = args.value<Float>("font-size");
+        job.atlasSize = args.value<Vector2i>("atlas-size");
+        job.outputSize = args.value<Vector2i>("output-size");
+        job.radius = args.value<Int>("radius");
+        jobs.push_back(std::move(job));
     }
 
-    /* Fill the cache */
-    font->fillGlyphCache(*cache, args.value("characters"));
-
-    Debug() << "Converting font...";
-
-    /* Convert the font */
-    if(!converter->exportFontToFile(*font, *cache, args.value("output"), args.value("characters"))) {
-        Error() << "Cannot export font to" << args.value("output");
-        std::exit(1);
+    bool success = true;
+    #ifndef MAGNUM_TARGET_GLES
+    if(args.isSet("cpu")) {
+        /* Fonts with zero output size don't need any distance field */
+        std::vector<Job> cpuJobs;
+        for(Job& job: jobs) {
+            if(job.outputSize.isZero()) {
+                if(!open(fontManager, job) || !convert(*converter, job))
+                    success = false;
+                job.font = nullptr;
+            } else cpuJobs.push_back(std::move(job));
+        }
+
+        if(!convertOnCpu(fontManager, *converter, cpuJobs)) success = false;
+
+    } else
+    #endif
+    {
+        for(Job& job: jobs) {
+            if(!open(fontManager, job) || !convert(*converter, job))
+                success = false;
+            job.font = nullptr;
+        }
     }
 
+    if(!success) return 1;
+
     Debug() << "Done.";
 
     return 0;
@@ -29,11 +29,13 @@
  * @brief Class @ref Magnum::Texture, typedef @ref Magnum::Texture1D, @ref Magnum::Texture2D, @ref Magnum::Texture3D
  */
 
+#include <vector>
 #include <Corrade/Utility/Macros.h>
 
 #include "Magnum/AbstractTexture.h"
 #include "Magnum/Array.h"
 #include "Magnum/DimensionTraits.h"
+#include "Magnum/Math/Range.h"
 #include "Magnum/Math/Vector3.h"
 
 namespace Magnum {
@@ -154,6 +156,42 @@ template<UnsignedInt dimensions> class Texture: public AbstractTexture {
         static Int compressedBlockDataSize(TextureFormat format) {
             return AbstractTexture::compressedBlockDataSize(Implementation::textureTarget<dimensions>(), format);
         }
+
+        /**
+         * @brief Count of virtual page sizes for sparse textures
+         *
+         * Returns count of page sizes available for sparse textures of given
+         * @p format, zero if the format can't be used for sparse textures.
+         * @see @ref pageSize(), @ref setVirtualPageSizeIndex(),
+         *      @fn_gl{GetInternalformat} with
+         *      @def_gl{NUM_VIRTUAL_PAGE_SIZES_ARB}
+         * @requires_extension Extension @extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        static Int pageSizeCount(TextureFormat format) {
+            return AbstractTexture::pageSizeCount(Implementation::textureTarget<dimensions>(), format);
+        }
+
+        /**
+         * @brief Virtual page size for sparse textures
+         *
+         * Returns size of one page (in pixels) for given @p format and page
+         * size @p index. Expects that @p index is less than
+         * @ref pageSizeCount(). Offsets and sizes passed to
+         * @ref commitPages() and @ref uncommitPages() have to be multiples of
+         * this value.
+         * @see @fn_gl{GetInternalformat} with
+         *      @def_gl{VIRTUAL_PAGE_SIZE_X_ARB},
+         *      @def_gl{VIRTUAL_PAGE_SIZE_Y_ARB},
+         *      @def_gl{VIRTUAL_PAGE_SIZE_Z_ARB}
+         * @requires_extension Extension @extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        static VectorTypeFor<dimensions, Int> pageSize(TextureFormat format, Int index = 0) {
+            return DataHelper<dimensions>::pageSize(Implementation::textureTarget<dimensions>(), format, index);
+        }
         #endif
 
         /**
@@ -172,6 +210,24 @@ template<UnsignedInt dimensions> class Texture: public AbstractTexture {
             return Texture<dimensions>{id, flags};
         }
 
+        /**
+         * @brief Create multiple textures at once
+         *
+         * Equivalent to calling @ref Texture() @p count times, but all
+         * OpenGL objects are created with a single call, which is faster
+         * when creating a lot of textures at once, for example when loading
+         * a scene.
+         * @see @fn_gl{CreateTextures}, eventually @fn_gl{GenTextures}
+         */
+        static std::vector<Texture<dimensions>> createArray(std::size_t count) {
+            std::vector<GLuint> ids(count);
+            const ObjectFlags flags = createInternal(Implementation::textureTarget<dimensions>(), {ids.data(), ids.size()});
+            std::vector<Texture<dimensions>> textures;
+            textures.reserve(count);
+            for(const GLuint id: ids) textures.push_back(Texture<dimensions>{id, flags});
+            return textures;
+        }
+
         /**
          * @brief Constructor
          *
@@ -694,6 +750,55 @@ template<UnsignedInt dimensions> class Texture: public AbstractTexture {
         }
         #endif
 
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Make the texture sparse
+         * @return Reference to self (for method chaining)
+         *
+         * Has to be called before @ref setStorage(). The storage of a sparse
+         * texture is then only virtual and physical memory is allocated
+         * page by page using @ref commitPages(). If neither
+         * @extension{ARB,direct_state_access} (part of OpenGL 4.5) nor
+         * @extension{EXT,direct_state_access} is available, the texture is
+         * bound before the operation (if not already). Initial value is
+         * `false`.
+         * @see @ref pageSize(), @ref setVirtualPageSizeIndex(),
+         *      @fn_gl2{TextureParameter,TexParameter},
+         *      @fn_gl_extension{TextureParameter,EXT,direct_state_access},
+         *      eventually @fn_gl{ActiveTexture}, @fn_gl{BindTexture} and
+         *      @fn_gl{TexParameter} with @def_gl{TEXTURE_SPARSE_ARB}
+         * @requires_extension Extension @extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        Texture<dimensions>& setSparse(bool enabled) {
+            AbstractTexture::setSparse(enabled);
+            return *this;
+        }
+
+        /**
+         * @brief Set virtual page size index
+         * @return Reference to self (for method chaining)
+         *
+         * Selects one of the page sizes returned by @ref pageSize(). Has to
+         * be called before @ref setStorage(). If neither
+         * @extension{ARB,direct_state_access} (part of OpenGL 4.5) nor
+         * @extension{EXT,direct_state_access} is available, the texture is
+         * bound before the operation (if not already). Initial value is `0`.
+         * @see @ref setSparse(), @fn_gl2{TextureParameter,TexParameter},
+         *      @fn_gl_extension{TextureParameter,EXT,direct_state_access},
+         *      eventually @fn_gl{ActiveTexture}, @fn_gl{BindTexture} and
+         *      @fn_gl{TexParameter} with @def_gl{VIRTUAL_PAGE_SIZE_INDEX_ARB}
+         * @requires_extension Extension @extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        Texture<dimensions>& setVirtualPageSizeIndex(Int index) {
+            AbstractTexture::setVirtualPageSizeIndex(index);
+            return *this;
+        }
+        #endif
+
         /**
          * @brief Set storage
          * @param levels            Mip level count
@@ -749,6 +854,72 @@ template<UnsignedInt dimensions> class Texture: public AbstractTexture {
         }
         #endif
 
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Count of sparse levels
+         *
+         * Levels from zero up to this count can be committed page by page,
+         * the remaining levels form a *mip tail* that is committed as a
+         * whole by committing any of its levels. The result is not cached in
+         * any way. If neither @extension{ARB,direct_state_access} (part of
+         * OpenGL 4.5) nor @extension{EXT,direct_state_access} is available,
+         * the texture is bound before the operation (if not already).
+         * @see @ref setSparse(), @fn_gl2{GetTextureParameter,GetTexParameter},
+         *      @fn_gl_extension{GetTextureParameter,EXT,direct_state_access},
+         *      eventually @fn_gl{ActiveTexture}, @fn_gl{BindTexture} and
+         *      @fn_gl{GetTexParameter} with @def_gl{NUM_SPARSE_LEVELS_ARB}
+         * @requires_extension Extension @extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        Int sparseLevelCount() { return AbstractTexture::sparseLevelCount(); }
+
+        /**
+         * @brief Commit pages of a sparse texture
+         * @param level             Mip level
+         * @param range             Range to commit
+         * @return Reference to self (for method chaining)
+         *
+         * Allocates physical memory for all pages in given range. Min and
+         * size of the range have to be multiples of @ref pageSize(), except
+         * for ranges reaching to the edge of the level. Contents of newly
+         * committed pages are undefined. If @extension{EXT,direct_state_access}
+         * is not available, the texture is bound before the operation (if not
+         * already).
+         * @see @ref uncommitPages(), @ref sparseLevelCount(),
+         *      @fn_gl_extension{TexturePageCommitment,EXT,direct_state_access},
+         *      eventually @fn_gl{ActiveTexture}, @fn_gl{BindTexture} and
+         *      @fn_gl_extension{TexPageCommitment,ARB,sparse_texture}
+         * @requires_extension Extension @extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        Texture<dimensions>& commitPages(Int level, const RangeTypeFor<dimensions, Int>& range) {
+            DataHelper<dimensions>::commitPages(*this, level, range.min(), range.size(), true);
+            return *this;
+        }
+
+        /**
+         * @brief Uncommit pages of a sparse texture
+         * @param level             Mip level
+         * @param range             Range to uncommit
+         * @return Reference to self (for method chaining)
+         *
+         * Frees physical memory of all pages in given range, the same
+         * restrictions as in @ref commitPages() apply.
+         * @see @fn_gl_extension{TexturePageCommitment,EXT,direct_state_access},
+         *      eventually @fn_gl{ActiveTexture}, @fn_gl{BindTexture} and
+         *      @fn_gl_extension{TexPageCommitment,ARB,sparse_texture}
+         * @requires_extension Extension @extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        Texture<dimensions>& uncommitPages(Int level, const RangeTypeFor<dimensions, Int>& range) {
+            DataHelper<dimensions>::commitPages(*this, level, range.min(), range.size(), false);
+            return *this;
+        }
+        #endif
+
         #ifndef MAGNUM_TARGET_GLES
         /**
          * @brief Read given mip level of texture to image
@@ -26,6 +26,9 @@
 #include "TextureArray.h"
 
 #ifndef MAGNUM_TARGET_GLES2
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Buffer.h"
 #include "Magnum/Context.h"
 #include "Magnum/Extensions.h"
 
@@ -34,6 +37,7 @@
 #include "Magnum/Image.h"
 #endif
 
+#include "Implementation/imageStaging.h"
 #include "Implementation/maxTextureSize.h"
 
 namespace Magnum {
@@ -54,6 +58,29 @@ template<UnsignedInt dimensions> VectorTypeFor<dimensions+1, Int> TextureArray<d
             Implementation::maxTextureArrayLayers()};
 }
 
+template<UnsignedInt dimensions> TextureArray<dimensions>& TextureArray<dimensions>::setSubImages(const Containers::ArrayView<const LayerSubImage> images) {
+    if(images.empty()) return *this;
+
+    const ImageView<dimensions>& first = images.front().image;
+    Containers::Array<Containers::ArrayView<const char>> data{images.size()};
+    for(std::size_t i = 0; i != images.size(); ++i) {
+        const ImageView<dimensions>& image = images[i].image;
+        CORRADE_ASSERT(image.format() == first.format() && image.type() == first.type() && image.storage() == first.storage(),
+            "TextureArray::setSubImages(): expected all images to have the same format, type and pixel storage but image" << i << "differs", *this);
+        data[i] = image.data();
+    }
+
+    Buffer staging{Buffer::TargetHint::PixelUnpack};
+    const Containers::Array<GLintptr> offsets = Implementation::stageImageData(staging, data);
+    first.storage().applyUnpack();
+    for(std::size_t i = 0; i != images.size(); ++i) {
+        const LayerSubImage& image = images[i];
+        DataHelper<dimensions+1>::setSubImageFromBoundBuffer(*this, image.level, Math::Vector<dimensions+1, Int>::pad(image.offset, image.layer), Math::Vector<dimensions+1, Int>::pad(image.image.size(), 1), first.format(), first.type(), first.storage(), offsets[i]);
+    }
+
+    return *this;
+}
+
 #ifndef MAGNUM_TARGET_GLES
 template<UnsignedInt dimensions> Image<dimensions+1> TextureArray<dimensions>::image(const Int level, Image<dimensions+1>&& image) {
     this->image(level, image);
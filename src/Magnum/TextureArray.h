@@ -34,6 +34,8 @@
 #include "Magnum/AbstractTexture.h"
 #include "Magnum/Array.h"
 #include "Magnum/DimensionTraits.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/Math/Range.h"
 #include "Magnum/Math/Vector3.h"
 
 #ifndef MAGNUM_TARGET_GLES2
@@ -79,6 +81,17 @@ for(std::size_t i = 0; i != 16; ++i) {
 }
 @endcode
 
+When uploading many layers at once, @ref setSubImages() is more efficient
+--- pixel storage is applied only once and all data are uploaded through a
+single staging buffer:
+@code
+std::vector<Texture2DArray::LayerSubImage> layers;
+for(Int i = 0; i != 256; ++i)
+    layers.push_back({i, 0, {}, ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {64, 64}, data[i]}});
+
+texture.setSubImages(layers);
+@endcode
+
 In shader, the texture is used via `sampler1DArray`/`sampler2DArray`,
 `sampler1DArrayShadow`/`sampler1DArrayShadow`, `isampler1DArray`/`isampler2DArray`
 or `usampler1DArray`/`usampler2DArray`. See @ref AbstractShaderProgram
@@ -100,6 +113,18 @@ template<UnsignedInt dimensions> class TextureArray: public AbstractTexture {
             Dimensions = dimensions /**< Texture dimension count */
         };
 
+        /**
+         * @brief Layer subimage
+         *
+         * @see @ref setSubImages()
+         */
+        struct LayerSubImage {
+            Int layer;                                  /**< @brief Layer */
+            Int level;                                  /**< @brief Mip level */
+            VectorTypeFor<dimensions, Int> offset;      /**< @brief Offset in the layer */
+            ImageView<dimensions> image;                /**< @brief Image */
+        };
+
         /**
          * @brief Max supported texture array size
          *
@@ -137,6 +162,31 @@ template<UnsignedInt dimensions> class TextureArray: public AbstractTexture {
         static Int compressedBlockDataSize(TextureFormat format) {
             return AbstractTexture::compressedBlockDataSize(Implementation::textureArrayTarget<dimensions>(), format);
         }
+
+        /**
+         * @copybrief Texture::pageSizeCount()
+         *
+         * See @ref Texture::pageSizeCount() for more information.
+         * @requires_extension Extension @extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        static Int pageSizeCount(TextureFormat format) {
+            return AbstractTexture::pageSizeCount(Implementation::textureArrayTarget<dimensions>(), format);
+        }
+
+        /**
+         * @copybrief Texture::pageSize()
+         *
+         * See @ref Texture::pageSize() for more information. The last
+         * component is page size in the layer dimension.
+         * @requires_extension Extension @extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        static VectorTypeFor<dimensions+1, Int> pageSize(TextureFormat format, Int index = 0) {
+            return DataHelper<dimensions+1>::pageSize(Implementation::textureArrayTarget<dimensions>(), format, index);
+        }
         #endif
 
         /**
@@ -445,6 +495,36 @@ template<UnsignedInt dimensions> class TextureArray: public AbstractTexture {
         }
         #endif
 
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @copybrief Texture::setSparse()
+         * @return Reference to self (for method chaining)
+         *
+         * See @ref Texture::setSparse() for more information.
+         * @requires_extension Extension @extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        TextureArray<dimensions>& setSparse(bool enabled) {
+            AbstractTexture::setSparse(enabled);
+            return *this;
+        }
+
+        /**
+         * @copybrief Texture::setVirtualPageSizeIndex()
+         * @return Reference to self (for method chaining)
+         *
+         * See @ref Texture::setVirtualPageSizeIndex() for more information.
+         * @requires_extension Extension @extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        TextureArray<dimensions>& setVirtualPageSizeIndex(Int index) {
+            AbstractTexture::setVirtualPageSizeIndex(index);
+            return *this;
+        }
+        #endif
+
         /**
          * @copybrief Texture::setStorage()
          * @return Reference to self (for method chaining)
@@ -472,6 +552,46 @@ template<UnsignedInt dimensions> class TextureArray: public AbstractTexture {
         }
         #endif
 
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @copybrief Texture::sparseLevelCount()
+         *
+         * See @ref Texture::sparseLevelCount() for more information.
+         * @requires_extension Extension @extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        Int sparseLevelCount() { return AbstractTexture::sparseLevelCount(); }
+
+        /**
+         * @copybrief Texture::commitPages()
+         * @return Reference to self (for method chaining)
+         *
+         * See @ref Texture::commitPages() for more information.
+         * @requires_extension Extension @extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        TextureArray<dimensions>& commitPages(Int level, const RangeTypeFor<dimensions+1, Int>& range) {
+            DataHelper<dimensions+1>::commitPages(*this, level, range.min(), range.size(), true);
+            return *this;
+        }
+
+        /**
+         * @copybrief Texture::uncommitPages()
+         * @return Reference to self (for method chaining)
+         *
+         * See @ref Texture::uncommitPages() for more information.
+         * @requires_extension Extension @extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES and
+         *      WebGL.
+         */
+        TextureArray<dimensions>& uncommitPages(Int level, const RangeTypeFor<dimensions+1, Int>& range) {
+            DataHelper<dimensions+1>::commitPages(*this, level, range.min(), range.size(), false);
+            return *this;
+        }
+        #endif
+
         #ifndef MAGNUM_TARGET_GLES
         /**
          * @copybrief Texture::image(Int, Image&)
@@ -787,6 +907,35 @@ template<UnsignedInt dimensions> class TextureArray: public AbstractTexture {
             return setCompressedSubImage(level, offset, image);
         }
 
+        /**
+         * @brief Set subdata of multiple layers
+         * @return Reference to self (for method chaining)
+         *
+         * Equivalent to calling @ref setSubImage() for each item with
+         * @ref LayerSubImage::layer being the last offset component, but
+         * the data of all images are copied into a single temporary pixel
+         * unpack buffer and pixel storage is applied only once. Expects that
+         * all images have the same format, type and pixel storage. If neither
+         * @extension{ARB,direct_state_access} (part of OpenGL 4.5) nor
+         * @extension{EXT,direct_state_access} desktop extension is
+         * available, the texture is bound before the operation (if not
+         * already).
+         * @see @ref setStorage(), @fn_gl{BufferData}, @fn_gl{BufferSubData},
+         *      @fn_gl{PixelStore}, then
+         *      @fn_gl2{TextureSubImage2D,TexSubImage2D}/
+         *      @fn_gl2{TextureSubImage3D,TexSubImage3D},
+         *      @fn_gl_extension{TextureSubImage2D,EXT,direct_state_access}/
+         *      @fn_gl_extension{TextureSubImage3D,EXT,direct_state_access},
+         *      eventually @fn_gl{ActiveTexture}, @fn_gl{BindTexture} and
+         *      @fn_gl{TexSubImage2D}/@fn_gl{TexSubImage3D}
+         */
+        TextureArray<dimensions>& setSubImages(Containers::ArrayView<const LayerSubImage> images);
+
+        /** @overload */
+        TextureArray<dimensions>& setSubImages(std::initializer_list<LayerSubImage> images) {
+            return setSubImages({images.begin(), images.size()});
+        }
+
         /**
          * @copybrief Texture::generateMipmap()
          * @return Reference to self (for method chaining)
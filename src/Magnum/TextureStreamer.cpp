@@ -0,0 +1,245 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TextureStreamer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum {
+
+namespace {
+    /* Three buffers, so the driver can still be reading from two of them
+       while the third is being filled */
+    constexpr std::size_t PixelBufferCount = 3;
+
+    Vector2i levelSize(const Vector2i& size, const Int level) {
+        return Math::max(size/(1 << level), Vector2i{1});
+    }
+}
+
+TextureStreamer::TextureData::TextureData(const TextureFormat internalFormat, const Vector2i& size, Loader&& loader, const Int levelCount): internalFormat{internalFormat}, size{size}, loader{std::move(loader)}, levelCount{levelCount}, tailLevel{levelCount}, residentLevel{levelCount}, distance{Constants::inf()}, priority{1.0f}, pixelFormat{PixelFormat::RGBA}, pixelType{PixelType::UnsignedByte}, pixelSize{4}, levelBytes(levelCount) {}
+
+TextureStreamer::TextureStreamer(const std::size_t budget): _budget{budget} {
+    _pixelBuffers.reserve(PixelBufferCount);
+    for(std::size_t i = 0; i != PixelBufferCount; ++i)
+        _pixelBuffers.emplace_back(PixelFormat::RGBA, PixelType::UnsignedByte);
+}
+
+TextureStreamer::~TextureStreamer() = default;
+
+std::size_t TextureStreamer::requestedBytes() const {
+    std::size_t bytes = 0;
+    for(const TextureData& data: _textures)
+        for(Int level = requestedLevel(data); level != data.levelCount; ++level)
+            bytes += levelBytes(data, level);
+    return bytes;
+}
+
+UnsignedInt TextureStreamer::add(const TextureFormat internalFormat, const Vector2i& size, Loader loader, const Int tailSize) {
+    CORRADE_ASSERT(size.min() > 0, "TextureStreamer::add(): expected non-zero size, got" << size, {});
+
+    const Int levelCount = Math::log2(size.max()) + 1;
+    _textures.emplace_back(internalFormat, size, std::move(loader), levelCount);
+    TextureData& data = _textures.back();
+
+    /* Find the mip tail. The last level is always in it. */
+    data.tailLevel = levelCount - 1;
+    while(data.tailLevel && levelSize(size, data.tailLevel - 1).max() <= tailSize)
+        --data.tailLevel;
+
+    /* Nothing is resident yet, so the texture is incomplete until the first
+       level is uploaded */
+    data.texture.setMaxLevel(levelCount - 1)
+        .setBaseLevel(levelCount);
+
+    /* Upload the tail, a failed level will be retried in update() */
+    for(Int level = levelCount - 1; level >= data.tailLevel; --level)
+        if(!upload(data, level)) break;
+
+    return _textures.size() - 1;
+}
+
+Texture2D& TextureStreamer::texture(const UnsignedInt id) {
+    CORRADE_ASSERT(id < _textures.size(), "TextureStreamer::texture(): index out of range", _textures[0].texture);
+    return _textures[id].texture;
+}
+
+Int TextureStreamer::levelCount(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _textures.size(), "TextureStreamer::levelCount(): index out of range", {});
+    return _textures[id].levelCount;
+}
+
+Int TextureStreamer::tailLevel(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _textures.size(), "TextureStreamer::tailLevel(): index out of range", {});
+    return _textures[id].tailLevel;
+}
+
+Int TextureStreamer::residentLevel(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _textures.size(), "TextureStreamer::residentLevel(): index out of range", {});
+    return _textures[id].residentLevel;
+}
+
+Int TextureStreamer::requestedLevel(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _textures.size(), "TextureStreamer::requestedLevel(): index out of range", {});
+    return requestedLevel(_textures[id]);
+}
+
+TextureStreamer& TextureStreamer::setDistance(const UnsignedInt id, const Float distance) {
+    CORRADE_ASSERT(id < _textures.size(), "TextureStreamer::setDistance(): index out of range", *this);
+    _textures[id].distance = distance;
+    return *this;
+}
+
+TextureStreamer& TextureStreamer::setPriority(const UnsignedInt id, const Float priority) {
+    CORRADE_ASSERT(id < _textures.size(), "TextureStreamer::setPriority(): index out of range", *this);
+    _textures[id].priority = priority;
+    return *this;
+}
+
+TextureStreamer& TextureStreamer::update() {
+    /* Evict levels that are no longer requested */
+    for(TextureData& data: _textures) {
+        const Int requested = requestedLevel(data);
+        while(data.residentLevel < requested) evict(data);
+    }
+
+    /* Order the textures from the most important one */
+    std::vector<UnsignedInt> order(_textures.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](UnsignedInt a, UnsignedInt b) {
+        const TextureData& first = _textures[a];
+        const TextureData& second = _textures[b];
+        return first.priority/Math::max(first.distance, _fullResolutionDistance) >
+               second.priority/Math::max(second.distance, _fullResolutionDistance);
+    });
+
+    /* If the budget was lowered, evict from the least important textures
+       until it is satisfied again */
+    for(std::size_t i = order.size(); i && _residentBytes > _budget; ) {
+        TextureData& data = _textures[order[i - 1]];
+        if(data.residentLevel < data.tailLevel) evict(data);
+        else --i;
+    }
+
+    /* Stream in requested levels, starting with the most important texture */
+    std::size_t uploaded = 0;
+    for(std::size_t i = 0; i != order.size(); ++i) {
+        TextureData& data = _textures[order[i]];
+        const Int requested = requestedLevel(data);
+        while(data.residentLevel > requested) {
+            const Int level = data.residentLevel - 1;
+            const std::size_t bytes = levelBytes(data, level);
+
+            /* Upload budget exhausted, continue next time */
+            if(_uploadBudget && uploaded && uploaded + bytes > _uploadBudget)
+                return *this;
+
+            /* Make room by evicting levels of less important textures,
+               starting with the least important one. The tail levels can be
+               still missing if their upload failed, don't count those against
+               the budget. */
+            if(level < data.tailLevel) {
+                for(std::size_t j = order.size(); j > i + 1 && _residentBytes + bytes > _budget; ) {
+                    TextureData& other = _textures[order[j - 1]];
+                    if(other.residentLevel < other.tailLevel) evict(other);
+                    else --j;
+                }
+
+                /* Nothing more to evict, try the next texture, which might
+                   want a smaller level */
+                if(_residentBytes + bytes > _budget) break;
+            }
+
+            if(!upload(data, level)) break;
+            uploaded += bytes;
+        }
+    }
+
+    return *this;
+}
+
+Int TextureStreamer::requestedLevel(const TextureData& data) const {
+    /* Each doubling of the distance drops one level. Comparing the float
+       first to avoid overflow when converting infinities to an integer. */
+    const Float levels = std::log2(data.distance/_fullResolutionDistance);
+    if(!(levels > 0.0f)) return 0;
+    if(levels >= data.tailLevel) return data.tailLevel;
+    return Int(levels);
+}
+
+std::size_t TextureStreamer::levelBytes(const TextureData& data, const Int level) const {
+    if(data.levelBytes[level]) return data.levelBytes[level];
+
+    /* Not resident, estimate from the pixel size of the last upload */
+    return levelSize(data.size, level).product()*data.pixelSize;
+}
+
+bool TextureStreamer::upload(TextureData& data, const Int level) {
+    Image2D image = data.loader(level);
+    if(!image.data()) return false;
+
+    CORRADE_ASSERT(image.size() == levelSize(data.size, level),
+        "TextureStreamer: expected level" << level << "of size" << levelSize(data.size, level) << "but got" << image.size(), false);
+
+    /* Upload through a pixel buffer so the call can return before the data
+       are transferred */
+    BufferImage2D& pixelBuffer = _pixelBuffers[_nextPixelBuffer];
+    _nextPixelBuffer = (_nextPixelBuffer + 1) % _pixelBuffers.size();
+    pixelBuffer.setData(image.storage(), image.format(), image.type(), image.size(), image.data(), BufferUsage::StreamDraw);
+    data.texture.setImage(level, data.internalFormat, pixelBuffer)
+        .setBaseLevel(level);
+
+    data.pixelFormat = image.format();
+    data.pixelType = image.type();
+    data.pixelSize = image.pixelSize();
+    data.levelBytes[level] = image.data().size();
+    data.residentLevel = level;
+    _residentBytes += image.data().size();
+    return true;
+}
+
+void TextureStreamer::evict(TextureData& data) {
+    const Int level = data.residentLevel;
+    CORRADE_INTERNAL_ASSERT(level < data.tailLevel);
+
+    /* Stop sampling the level first, then free its memory by redefining it
+       with zero size */
+    data.texture.setBaseLevel(level + 1)
+        .setImage(level, data.internalFormat, ImageView2D{data.pixelFormat, data.pixelType, {}});
+
+    _residentBytes -= data.levelBytes[level];
+    data.levelBytes[level] = 0;
+    data.residentLevel = level + 1;
+}
+
+}
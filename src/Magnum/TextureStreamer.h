@@ -0,0 +1,300 @@
+#ifndef Magnum_TextureStreamer_h
+#define Magnum_TextureStreamer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MAGNUM_TARGET_GLES2
+/** @file
+ * @brief Class @ref Magnum::TextureStreamer
+ */
+#endif
+
+#include <functional>
+#include <vector>
+
+#include "Magnum/BufferImage.h"
+#include "Magnum/Image.h"
+#include "Magnum/Texture.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+namespace Magnum {
+
+/**
+@brief Texture streamer
+
+Manages a set of @ref Texture2D instances whose mip levels are made resident
+on demand under a configurable memory budget. When a texture is added using
+@ref add(), only its *mip tail* --- the levels not larger than given size ---
+is uploaded. Higher levels are then streamed in by @ref update() based on
+distance and priority set with @ref setDistance() and @ref setPriority() and
+evicted again when they are no longer needed or when the memory is required
+by more important textures. The mip tail is never evicted, so each texture
+can always be sampled.
+@code
+TextureStreamer streamer{256*1024*1024};
+streamer.setUploadBudget(4*1024*1024);
+
+UnsignedInt rock = streamer.add(TextureFormat::RGBA8, {2048, 2048}, [](Int level) {
+    return loadMipLevel("rock.dds", level); // returns Image2D
+});
+streamer.texture(rock).setMinificationFilter(Sampler::Filter::Linear, Sampler::Mipmap::Linear);
+
+// each frame
+streamer.setDistance(rock, (cameraPosition - rockPosition).length())
+    .update();
+@endcode
+
+The levels are uploaded through a small pool of @ref BufferImage2D instances
+used as pixel unpack buffers, so @ref Texture::setImage() can return before
+the data are transferred to the GPU. Use @ref setUploadBudget() to limit the
+amount of data uploaded in a single @ref update() call.
+
+Levels are allocated one by one with @ref Texture::setImage() instead of using
+immutable storage, so evicted levels can be freed by redefining them with zero
+size. The @ref Texture::setBaseLevel() "base level" and
+@ref Texture::setMaxLevel() "max level" are kept in sync with the resident
+levels, so the texture is always complete.
+
+@requires_gles30 Base level and pixel buffer objects are not available in
+    OpenGL ES 2.0.
+@requires_webgl20 Base level and pixel buffer objects are not available in
+    WebGL 1.0.
+*/
+class MAGNUM_EXPORT TextureStreamer {
+    public:
+        /**
+         * @brief Level loader
+         *
+         * Called with a mip level index, expected to return image data of
+         * that level. Return an image without any data to signal failure, the
+         * level will be retried in the next @ref update().
+         */
+        typedef std::function<Image2D(Int)> Loader;
+
+        /**
+         * @brief Constructor
+         * @param budget    Memory budget in bytes
+         *
+         * @see @ref setBudget()
+         */
+        explicit TextureStreamer(std::size_t budget);
+
+        /** @brief Copying is not allowed */
+        TextureStreamer(const TextureStreamer&) = delete;
+
+        /** @brief Moving is not allowed */
+        TextureStreamer(TextureStreamer&&) = delete;
+
+        ~TextureStreamer();
+
+        /** @brief Copying is not allowed */
+        TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+        /** @brief Moving is not allowed */
+        TextureStreamer& operator=(TextureStreamer&&) = delete;
+
+        /** @brief Memory budget in bytes */
+        std::size_t budget() const { return _budget; }
+
+        /**
+         * @brief Set memory budget
+         * @return Reference to self (for method chaining)
+         *
+         * Mip tails are not counted against the budget when evicting, so
+         * @ref residentBytes() can exceed it if the tails alone don't fit.
+         * If the budget is lowered, the levels over budget are evicted in
+         * the next @ref update().
+         */
+        TextureStreamer& setBudget(std::size_t bytes) {
+            _budget = bytes;
+            return *this;
+        }
+
+        /** @brief Upload budget in bytes */
+        std::size_t uploadBudget() const { return _uploadBudget; }
+
+        /**
+         * @brief Set upload budget
+         * @return Reference to self (for method chaining)
+         *
+         * Limits the amount of data uploaded in one @ref update() call. At
+         * least one level is always uploaded, even if it is larger. Set to
+         * `0` to disable the limit, which is the default.
+         */
+        TextureStreamer& setUploadBudget(std::size_t bytes) {
+            _uploadBudget = bytes;
+            return *this;
+        }
+
+        /** @brief Full resolution distance */
+        Float fullResolutionDistance() const { return _fullResolutionDistance; }
+
+        /**
+         * @brief Set full resolution distance
+         * @return Reference to self (for method chaining)
+         *
+         * Textures closer than given distance request all their levels.
+         * Each doubling of the distance makes the texture request one level
+         * less. Default is `1.0f`.
+         * @see @ref setDistance(), @ref requestedLevel()
+         */
+        TextureStreamer& setFullResolutionDistance(Float distance) {
+            _fullResolutionDistance = distance;
+            return *this;
+        }
+
+        /**
+         * @brief Count of bytes in resident levels
+         *
+         * Includes the mip tails.
+         */
+        std::size_t residentBytes() const { return _residentBytes; }
+
+        /**
+         * @brief Count of bytes in requested levels
+         *
+         * Sum of sizes of all levels requested by all textures, including
+         * the mip tails. If larger than @ref budget(), not all requests can
+         * be satisfied. Sizes of levels that were never uploaded are
+         * estimated from size of the mip tail pixels.
+         */
+        std::size_t requestedBytes() const;
+
+        /** @brief Texture count */
+        UnsignedInt textureCount() const { return _textures.size(); }
+
+        /**
+         * @brief Add a texture
+         * @param internalFormat    Internal texture format
+         * @param size              Size of the base level
+         * @param loader            Level loader
+         * @param tailSize          Largest dimension of levels in the mip tail
+         * @return ID of the texture
+         *
+         * Creates a texture with a full mip chain and synchronously uploads
+         * all levels that are not larger than @p tailSize in any dimension
+         * using @p loader. The levels are then requested based on
+         * @ref setDistance(), initially only the mip tail is requested.
+         */
+        UnsignedInt add(TextureFormat internalFormat, const Vector2i& size, Loader loader, Int tailSize = 64);
+
+        /**
+         * @brief Texture
+         *
+         * Set sampling parameters on the returned texture, but don't modify
+         * its images, base level or max level. The reference is invalidated
+         * by subsequent @ref add() call.
+         */
+        Texture2D& texture(UnsignedInt id);
+
+        /** @brief Level count of given texture */
+        Int levelCount(UnsignedInt id) const;
+
+        /**
+         * @brief First level of the mip tail of given texture
+         *
+         * Levels from this one to @ref levelCount() are always resident.
+         */
+        Int tailLevel(UnsignedInt id) const;
+
+        /**
+         * @brief Finest resident level of given texture
+         *
+         * Levels from this one to @ref levelCount() are resident.
+         */
+        Int residentLevel(UnsignedInt id) const;
+
+        /**
+         * @brief Finest requested level of given texture
+         *
+         * Calculated from distance set by @ref setDistance() and
+         * @ref fullResolutionDistance(), clamped to @ref tailLevel().
+         */
+        Int requestedLevel(UnsignedInt id) const;
+
+        /**
+         * @brief Set distance of given texture
+         * @return Reference to self (for method chaining)
+         *
+         * Initial value is infinity, i.e. only the mip tail is requested.
+         * @see @ref setFullResolutionDistance()
+         */
+        TextureStreamer& setDistance(UnsignedInt id, Float distance);
+
+        /**
+         * @brief Set priority of given texture
+         * @return Reference to self (for method chaining)
+         *
+         * The textures are streamed in order of priority divided by distance
+         * and evicted in reverse order. Initial value is `1.0f`.
+         */
+        TextureStreamer& setPriority(UnsignedInt id, Float priority);
+
+        /**
+         * @brief Update residency
+         * @return Reference to self (for method chaining)
+         *
+         * Evicts levels that are no longer requested, then streams in
+         * requested levels from the most important textures until
+         * @ref uploadBudget() is exhausted, evicting levels from less
+         * important textures to stay within @ref budget().
+         */
+        TextureStreamer& update();
+
+    private:
+        struct TextureData {
+            explicit TextureData(TextureFormat internalFormat, const Vector2i& size, Loader&& loader, Int levelCount);
+
+            Texture2D texture;
+            TextureFormat internalFormat;
+            Vector2i size;
+            Loader loader;
+            Int levelCount, tailLevel, residentLevel;
+            Float distance, priority;
+            PixelFormat pixelFormat;
+            PixelType pixelType;
+            std::size_t pixelSize;
+            /* Size of each resident level, zero if not resident */
+            std::vector<std::size_t> levelBytes;
+        };
+
+        MAGNUM_LOCAL Int requestedLevel(const TextureData& data) const;
+        MAGNUM_LOCAL std::size_t levelBytes(const TextureData& data, Int level) const;
+        MAGNUM_LOCAL bool upload(TextureData& data, Int level);
+        MAGNUM_LOCAL void evict(TextureData& data);
+
+        std::size_t _budget, _uploadBudget{}, _residentBytes{};
+        Float _fullResolutionDistance{1.0f};
+        std::vector<TextureData> _textures;
+        std::vector<BufferImage2D> _pixelBuffers;
+        std::size_t _nextPixelBuffer{};
+};
+
+}
+#else
+#error this header is not available in OpenGL ES 2.0 build
+#endif
+
+#endif
@@ -25,38 +25,237 @@
 
 #include "Atlas.h"
 
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <tuple>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
 #include "Magnum/Math/Functions.h"
 #include "Magnum/Math/Range.h"
 
 namespace Magnum { namespace TextureTools {
 
-std::vector<Range2Di> atlas(const Vector2i& atlasSize, const std::vector<Vector2i>& sizes, const Vector2i& padding) {
-    if(sizes.empty()) return {};
+AtlasPacker::AtlasPacker(const Vector2i& size, const Vector2i& padding): _size{size}, _padding{padding} {
+    clear();
+}
+
+void AtlasPacker::clear() {
+    _skyline.assign(1, {0, 0, _size.x()});
+}
+
+std::vector<Range2Di> AtlasPacker::add(const std::vector<Vector2i>& sizes) {
+    /* Place the tallest textures first, keep the original order for equal
+       heights so the result is deterministic */
+    std::vector<std::size_t> order(sizes.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&sizes](std::size_t a, std::size_t b) {
+        return sizes[a].y() > sizes[b].y();
+    });
+
+    /* Work on a copy so the atlas stays unchanged on failure */
+    std::vector<Segment> skyline = _skyline;
+    std::vector<Range2Di> atlas(sizes.size());
+    for(std::size_t i: order) {
+        const Vector2i paddedSize = sizes[i] + 2*_padding;
+
+        /* Nothing to place, don't waste any space */
+        if(!paddedSize.product()) {
+            atlas[i] = Range2Di::fromSize(_padding, sizes[i]);
+            continue;
+        }
+
+        /* Find the segment where the top edge will be lowest, then the
+           leftmost one */
+        std::size_t best = ~std::size_t{};
+        Int bestY{}, bestTop{};
+        for(std::size_t s = 0; s != skyline.size(); ++s) {
+            const Int x = skyline[s].x;
+            if(x + paddedSize.x() > _size.x()) break;
+
+            /* The texture lies on the highest segment it spans */
+            Int y = 0;
+            for(std::size_t t = s; t != skyline.size() && skyline[t].x < x + paddedSize.x(); ++t)
+                y = Math::max(y, skyline[t].y);
+
+            const Int top = y + paddedSize.y();
+            if(top > _size.y()) continue;
+            if(best == ~std::size_t{} || top < bestTop) {
+                best = s;
+                bestY = y;
+                bestTop = top;
+            }
+        }
+
+        if(best == ~std::size_t{}) return {};
 
-    /* Size of largest texture */
-    Vector2i maxSize;
-    for(const Vector2i& size: sizes)
-        maxSize = Math::max(maxSize, size);
+        const Int x = skyline[best].x;
+        atlas[i] = Range2Di::fromSize(Vector2i{x, bestY} + _padding, sizes[i]);
 
-    std::vector<Range2Di> atlas;
+        /* Insert new segment, cut away what's covered by it */
+        const Int end = x + paddedSize.x();
+        auto it = skyline.insert(skyline.begin() + best, Segment{x, bestTop, paddedSize.x()}) + 1;
+        while(it != skyline.end() && it->x < end) {
+            if(it->x + it->width <= end) {
+                it = skyline.erase(it);
+                continue;
+            }
 
-    /* Columns and rows */
-    const Vector2i paddedSize = maxSize+2*padding;
-    const Vector2i gridSize = atlasSize/paddedSize;
-    if(std::size_t(gridSize.product()) < sizes.size()) {
+            it->width -= end - it->x;
+            it->x = end;
+            break;
+        }
+
+        /* Merge neighbors of the same height */
+        for(std::size_t s = 1; s < skyline.size(); ++s) {
+            if(skyline[s - 1].y != skyline[s].y) continue;
+            skyline[s - 1].width += skyline[s].width;
+            skyline.erase(skyline.begin() + s);
+            --s;
+        }
+    }
+
+    _skyline = std::move(skyline);
+    return atlas;
+}
+
+std::vector<Range2Di> atlas(const Vector2i& atlasSize, const std::vector<Vector2i>& sizes, const Vector2i& padding) {
+    if(sizes.empty()) return {};
+
+    std::vector<Range2Di> atlas = AtlasPacker{atlasSize, padding}.add(sizes);
+    if(atlas.empty()) {
         Error() << "TextureTools::atlas(): requested atlas size" << atlasSize
-                << "is too small to fit" << sizes.size() << paddedSize
-                << "textures. Generated atlas will be empty.";
-        return atlas;
+                << "is too small to fit" << sizes.size() << "textures with padding"
+                << padding << Debug::nospace << ". Generated atlas will be empty.";
     }
 
-    /** @todo actual magic implementation, not this joke */
+    return atlas;
+}
+
+std::vector<Range3Di> atlasArray(const Vector2i& layerSize, const std::vector<Vector2i>& sizes, const Vector2i& padding) {
+    /* Same order as in AtlasPacker::add(), so the tallest textures get to
+       the first layers */
+    std::vector<std::size_t> order(sizes.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&sizes](std::size_t a, std::size_t b) {
+        return sizes[a].y() > sizes[b].y();
+    });
 
-    atlas.reserve(sizes.size());
-    for(std::size_t i = 0; i != sizes.size(); ++i)
-        atlas.push_back(Range2Di::fromSize(Vector2i(i%gridSize.x(), i/gridSize.x())*paddedSize+padding, sizes[i]));
+    std::vector<AtlasPacker> layers;
+    std::vector<Range3Di> atlas(sizes.size());
+    for(std::size_t i: order) {
+        /* Put the texture into the first layer it fits in */
+        std::vector<Range2Di> range;
+        std::size_t layer = 0;
+        for(; layer != layers.size(); ++layer) {
+            range = layers[layer].add({sizes[i]});
+            if(!range.empty()) break;
+        }
+
+        /* If there's none, add a new one. If it doesn't fit even there, it
+           never will. */
+        if(range.empty()) {
+            layers.emplace_back(layerSize, padding);
+            range = layers.back().add({sizes[i]});
+            if(range.empty()) {
+                Error() << "TextureTools::atlasArray(): requested layer size" << layerSize
+                        << "is too small to fit texture of size" << sizes[i] << "with padding"
+                        << padding << Debug::nospace << ". Generated atlas will be empty.";
+                return {};
+            }
+        }
+
+        atlas[i] = {{range[0].min(), Int(layer)}, {range[0].max(), Int(layer) + 1}};
+    }
 
     return atlas;
 }
 
+Matrix3 atlasTextureCoordinateTransformation(const Vector2i& atlasSize, const Range2Di& range) {
+    const Vector2 size{atlasSize};
+    return Matrix3::translation(Vector2{range.min()}/size)*
+           Matrix3::scaling(Vector2{range.size()}/size);
+}
+
+namespace {
+
+/* Copies given image into given layer of the atlas, filling the padding around
+   it with edge pixels */
+void copyImage(char* const layerData, const Vector2i& layerSize, const std::size_t rowStride, const ImageView2D& image, const Range2Di& range, const Vector2i& padding) {
+    if(!image.size().product()) return;
+
+    std::size_t dataPixelSize;
+    Math::Vector2<std::size_t> dataOffset, dataSize;
+    std::tie(dataOffset, dataSize, dataPixelSize) = image.dataProperties();
+    const std::size_t pixelSize = image.pixelSize();
+
+    /* Padded area, clipped to the layer */
+    const Vector2i min = Math::max(range.min() - padding, Vector2i{0});
+    const Vector2i max = Math::min(range.max() + padding, layerSize);
+    const std::size_t rowSize = image.size().x()*pixelSize;
+
+    for(Int y = min.y(); y != max.y(); ++y) {
+        const Int sourceY = Math::clamp(y - range.min().y(), 0, image.size().y() - 1);
+        const char* const source = image.data<char>() + dataOffset.sum() + sourceY*dataSize.x();
+        char* const destination = layerData + y*rowStride;
+
+        /* Left padding, the image row, right padding */
+        for(Int x = min.x(); x < range.min().x(); ++x)
+            std::memcpy(destination + x*pixelSize, source, pixelSize);
+        std::memcpy(destination + range.min().x()*pixelSize, source, rowSize);
+        for(Int x = range.max().x(); x < max.x(); ++x)
+            std::memcpy(destination + x*pixelSize, source + rowSize - pixelSize, pixelSize);
+    }
+}
+
+}
+
+Image3D atlasImage(const Vector2i& layerSize, const std::vector<ImageView2D>& images, const std::vector<Range3Di>& ranges, const Vector2i& padding) {
+    CORRADE_ASSERT(images.size() == ranges.size(),
+        "TextureTools::atlasImage(): expected" << images.size() << "ranges but got" << ranges.size(),
+        (Image3D{PixelFormat::RGBA, PixelType::UnsignedByte}));
+    CORRADE_ASSERT(!images.empty(),
+        "TextureTools::atlasImage(): no images passed",
+        (Image3D{PixelFormat::RGBA, PixelType::UnsignedByte}));
+
+    const PixelFormat format = images.front().format();
+    const PixelType type = images.front().type();
+    Int layerCount = 0;
+    for(std::size_t i = 0; i != images.size(); ++i) {
+        CORRADE_ASSERT(images[i].format() == format && images[i].type() == type,
+            "TextureTools::atlasImage(): expected" << format << "and" << type << "but image" << i << "has" << images[i].format() << "and" << images[i].type(),
+            (Image3D{format, type}));
+        CORRADE_ASSERT(ranges[i].size() == Vector3i(images[i].size(), 1),
+            "TextureTools::atlasImage(): image" << i << "has size" << images[i].size() << "but the range is" << ranges[i].size(),
+            (Image3D{format, type}));
+        layerCount = Math::max(layerCount, ranges[i].front());
+    }
+
+    /* Rows aligned to four bytes to match default pixel storage */
+    const std::size_t rowStride = (layerSize.x()*images.front().pixelSize() + 3)/4*4;
+    const std::size_t layerStride = rowStride*layerSize.y();
+    Containers::Array<char> data{Containers::ValueInit, layerStride*layerCount};
+
+    for(std::size_t i = 0; i != images.size(); ++i)
+        copyImage(data + ranges[i].back()*layerStride, layerSize, rowStride, images[i],
+            {ranges[i].min().xy(), ranges[i].max().xy()}, padding);
+
+    return Image3D{format, type, {layerSize, layerCount}, std::move(data)};
+}
+
+Image2D atlasImage(const Vector2i& atlasSize, const std::vector<ImageView2D>& images, const std::vector<Range2Di>& ranges, const Vector2i& padding) {
+    std::vector<Range3Di> ranges3D;
+    ranges3D.reserve(ranges.size());
+    for(const Range2Di& range: ranges)
+        ranges3D.push_back({{range.min(), 0}, {range.max(), 1}});
+
+    Image3D image = atlasImage(atlasSize, images, ranges3D, padding);
+    const PixelFormat format = image.format();
+    const PixelType type = image.type();
+    return Image2D{format, type, atlasSize, image.release()};
+}
+
 }}
@@ -26,17 +26,83 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::TextureTools::atlas()
+ * @brief Class @ref Magnum::TextureTools::AtlasPacker, function @ref Magnum::TextureTools::atlas(), @ref Magnum::TextureTools::atlasArray(), @ref Magnum::TextureTools::atlasTextureCoordinateTransformation(), @ref Magnum::TextureTools::atlasImage()
  */
 
 #include <vector>
 
 #include "Magnum/Magnum.h"
-#include "Magnum/Math/Vector2.h"
+#include "Magnum/Math/Matrix3.h"
 #include "Magnum/TextureTools/visibility.h"
 
 namespace Magnum { namespace TextureTools {
 
+/**
+@brief Incremental texture atlas packer
+
+Packs rectangles into an atlas of fixed size using the skyline bottom-left
+heuristic --- the atlas is described by a list of horizontal segments and each
+rectangle is placed at the position where its top edge ends up lowest. Unlike
+@ref atlas(), new rectangles can be added to an already populated atlas
+without moving the existing ones:
+@code
+TextureTools::AtlasPacker packer{{512, 512}, {1, 1}};
+std::vector<Range2Di> first = packer.add(sizes);
+
+// ...
+
+std::vector<Range2Di> second = packer.add(moreSizes);
+@endcode
+@see @ref Text::GlyphCache::reserve()
+*/
+class MAGNUM_TEXTURETOOLS_EXPORT AtlasPacker {
+    public:
+        /**
+         * @brief Constructor
+         * @param size      Size of the atlas
+         * @param padding   Padding around each texture
+         *
+         * Creates empty atlas.
+         */
+        explicit AtlasPacker(const Vector2i& size, const Vector2i& padding = Vector2i());
+
+        /** @brief Atlas size */
+        Vector2i size() const { return _size; }
+
+        /** @brief Padding around each texture */
+        Vector2i padding() const { return _padding; }
+
+        /**
+         * @brief Add textures into the atlas
+         * @param sizes     Sizes of the textures
+         *
+         * Returns positions of the textures in the same order as in
+         * @p sizes. Padding is added twice to each size and the textures are
+         * laid out so the padding doesn't overlap with other textures or
+         * atlas edges. Returned sizes are the same as original sizes, i.e.
+         * without the padding. The textures are placed from the tallest to
+         * the smallest for better utilization. If not all textures fit,
+         * returns empty vector and the atlas is left unchanged.
+         */
+        std::vector<Range2Di> add(const std::vector<Vector2i>& sizes);
+
+        /**
+         * @brief Clear the atlas
+         *
+         * All space previously returned from @ref add() is made available
+         * again.
+         */
+        void clear();
+
+    private:
+        struct Segment {
+            Int x, y, width;
+        };
+
+        Vector2i _size, _padding;
+        std::vector<Segment> _skyline;
+};
+
 /**
 @brief Pack textures into texture atlas
 @param atlasSize    Size of resulting atlas
@@ -48,10 +114,99 @@ into required size, empty vector is returned.
 
 Padding is added twice to each size and the atlas is laid out so the padding
 don't overlap. Returned sizes are the same as original sizes, i.e. without the
-padding.
+padding. See @ref AtlasPacker for description of the packing algorithm and
+for adding textures into existing atlas.
 */
 std::vector<Range2Di> MAGNUM_TEXTURETOOLS_EXPORT atlas(const Vector2i& atlasSize, const std::vector<Vector2i>& sizes, const Vector2i& padding = Vector2i());
 
+/**
+@brief Pack textures into texture array atlas
+@param layerSize    Size of one layer of resulting atlas
+@param sizes        Sizes of all textures in the atlas
+@param padding      Padding around each texture
+
+Like @ref atlas(), but if the textures don't fit into one layer, new layers
+are added as needed, so the result can be used with @ref Texture2DArray.
+Returned ranges are in the same order as @p sizes, the
+@ref Math::Range3D::back() "Range3Di::back()" coordinate is index of the
+layer and the depth is always `1`, so the layer count is maximum of all
+@ref Math::Range3D::front() "Range3Di::front()" values. The textures are
+placed from the tallest to the smallest and each is put into the first layer
+it fits in. If any texture with padding is larger than @p layerSize, empty
+vector is returned.
+@see @ref atlasImage(), @ref atlasTextureCoordinateTransformation()
+*/
+std::vector<Range3Di> MAGNUM_TEXTURETOOLS_EXPORT atlasArray(const Vector2i& layerSize, const std::vector<Vector2i>& sizes, const Vector2i& padding = Vector2i());
+
+/**
+@brief Texture coordinate transformation for texture in an atlas
+@param atlasSize    Size of the atlas (or one layer of it)
+@param range        Range of the texture returned from @ref atlas(),
+    @ref atlasArray() or @ref AtlasPacker::add()
+
+Returns a transformation mapping texture coordinates in range @f$ [0, 1] @f$
+of the original texture to the area it occupies in the atlas. Use it to remap
+mesh texture coordinates on the CPU, for example using
+@ref MeshTools::transformPointsInPlace() on
+@ref Trade::MeshData3D::textureCoords2D(), or pass it to the shader as a
+per-instance or per-draw texture transformation. The mapping is valid only
+for texture coordinates inside the @f$ [0, 1] @f$ range, meshes relying on
+repeated textures can't be atlased.
+*/
+MAGNUM_TEXTURETOOLS_EXPORT Matrix3 atlasTextureCoordinateTransformation(const Vector2i& atlasSize, const Range2Di& range);
+
+/**
+@brief Copy images into a texture atlas
+@param atlasSize    Size of resulting atlas
+@param images       Images to put into the atlas
+@param ranges       Ranges returned from @ref atlas() or
+    @ref AtlasPacker::add() for sizes of @p images
+@param padding      Padding used when calculating @p ranges
+
+Expects that @p images and @p ranges have the same size, all images have the
+same format and type and that each image has the same size as corresponding
+range. The padding around each image is filled with its edge pixels, so
+neighboring textures don't bleed into each other when filtering. The rest of
+the atlas is zero-filled. The returned image has default pixel storage, so it
+can be directly passed to @ref Texture::setImage():
+@code
+std::vector<Image2D> images = ...;
+std::vector<Vector2i> sizes;
+for(const Image2D& image: images) sizes.push_back(image.size());
+std::vector<Range2Di> ranges = TextureTools::atlas({1024, 1024}, sizes, {2, 2});
+
+std::vector<ImageView2D> views{images.begin(), images.end()};
+texture.setStorage(1, TextureFormat::RGBA8, {1024, 1024})
+    .setSubImage(0, {}, TextureTools::atlasImage({1024, 1024}, views, ranges, {2, 2}));
+
+// Remap texture coordinates of all meshes using the i-th image
+Matrix3 transformation = TextureTools::atlasTextureCoordinateTransformation({1024, 1024}, ranges[i]);
+MeshTools::transformPointsInPlace(transformation, mesh.textureCoords2D(0));
+@endcode
+
+Once all small textures are in one atlas, meshes that differed only in the
+texture can share the same material and thus can be merged using
+@ref MeshTools::StaticBatch or drawn together using @ref SceneGraph::InstancedDrawable3D.
+Mipmaps generated from the atlas bleed between textures once the level size
+gets below the padding, generate them for each image separately or limit the
+level count if that's an issue.
+*/
+MAGNUM_TEXTURETOOLS_EXPORT Image2D atlasImage(const Vector2i& atlasSize, const std::vector<ImageView2D>& images, const std::vector<Range2Di>& ranges, const Vector2i& padding = Vector2i());
+
+/**
+@brief Copy images into a texture array atlas
+@param layerSize    Size of one layer of resulting atlas
+@param images       Images to put into the atlas
+@param ranges       Ranges returned from @ref atlasArray() for sizes of
+    @p images
+@param padding      Padding used when calculating @p ranges
+
+Like @ref atlasImage(const Vector2i&, const std::vector<ImageView2D>&, const std::vector<Range2Di>&, const Vector2i&),
+but produces a 3D image with as many layers as needed by @p ranges, meant to
+be uploaded to @ref Texture2DArray.
+*/
+MAGNUM_TEXTURETOOLS_EXPORT Image3D atlasImage(const Vector2i& layerSize, const std::vector<ImageView2D>& images, const std::vector<Range3Di>& ranges, const Vector2i& padding = Vector2i());
+
 }}
 
 #endif
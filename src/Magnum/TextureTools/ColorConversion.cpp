@@ -0,0 +1,221 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ColorConversion.h"
+
+#include <algorithm>
+#include <tuple>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/TextureTools/Implementation/parallelFor.h"
+#include "Magnum/TextureTools/Implementation/srgb.h"
+
+namespace Magnum { namespace TextureTools {
+
+namespace {
+
+std::size_t channelCount(const ImageView2D& image) {
+    return image.type() == PixelType::Float ? image.pixelSize()/4 : image.pixelSize();
+}
+
+/* Calls function(input, output) on each row of the image, output is a new
+   image of given type with default pixel storage */
+template<class F> Image2D convertRows(const ImageView2D& image, const PixelType type, UnsignedInt threadCount, const F& function) {
+    threadCount = Implementation::threadCountOrDefault(threadCount);
+
+    const Vector2i size = image.size();
+    const std::size_t outputPixelSize = channelCount(image)*(type == PixelType::Float ? 4 : 1);
+    const std::size_t outputStride = (size.x()*outputPixelSize + 3)/4*4;
+    Containers::Array<char> data{Containers::ValueInit, outputStride*size.y()};
+
+    if(size.product()) {
+        std::size_t dataPixelSize;
+        Math::Vector2<std::size_t> dataOffset, dataSize;
+        std::tie(dataOffset, dataSize, dataPixelSize) = image.dataProperties();
+        Implementation::parallelFor(size.y(), threadCount, [&](const std::size_t begin, const std::size_t end) {
+            for(std::size_t y = begin; y != end; ++y)
+                function(image.data<char>() + dataOffset.sum() + y*dataSize.x(), data + y*outputStride);
+        });
+    }
+
+    return Image2D{image.format(), type, size, std::move(data)};
+}
+
+bool isRgb(const PixelFormat format) {
+    return format == PixelFormat::RGB || format == PixelFormat::RGBA;
+}
+
+}
+
+Image2D srgbToLinear(const ImageView2D& image, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(image.type() == PixelType::UnsignedByte || image.type() == PixelType::Float,
+        "TextureTools::srgbToLinear(): expected" << PixelType::UnsignedByte << "or" << PixelType::Float << "but got" << image.type(), (Image2D{image.format(), PixelType::Float}));
+    const std::size_t channels = channelCount(image);
+    CORRADE_ASSERT(channels >= 1 && channels <= 4,
+        "TextureTools::srgbToLinear(): unsupported format" << image.format(), (Image2D{image.format(), PixelType::Float}));
+
+    const bool alpha = Implementation::hasAlpha(image.format());
+    const std::size_t width = image.size().x();
+    const std::size_t rowSize = width*channels;
+
+    if(image.type() == PixelType::UnsignedByte) {
+        const Implementation::SrgbTable table;
+        return convertRows(image, PixelType::Float, threadCount, [&](const char* const input, char* const output) {
+            const UnsignedByte* const in = reinterpret_cast<const UnsignedByte*>(input);
+            Float* const out = reinterpret_cast<Float*>(output);
+            for(std::size_t i = 0; i != rowSize; ++i)
+                out[i] = table.toLinear[in[i]];
+            if(alpha) for(std::size_t x = channels - 1; x < rowSize; x += channels)
+                out[x] = Float(in[x])/255.0f;
+        });
+    }
+
+    return convertRows(image, PixelType::Float, threadCount, [&](const char* const input, char* const output) {
+        const Float* const in = reinterpret_cast<const Float*>(input);
+        Float* const out = reinterpret_cast<Float*>(output);
+        for(std::size_t i = 0; i != rowSize; ++i)
+            out[i] = Implementation::fastSrgbToLinear(in[i]);
+        if(alpha) for(std::size_t x = channels - 1; x < rowSize; x += channels)
+            out[x] = in[x];
+    });
+}
+
+Image2D linearToSrgb(const ImageView2D& image, const PixelType type, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(image.type() == PixelType::Float,
+        "TextureTools::linearToSrgb(): expected" << PixelType::Float << "but got" << image.type(), (Image2D{image.format(), type}));
+    CORRADE_ASSERT(type == PixelType::UnsignedByte || type == PixelType::Float,
+        "TextureTools::linearToSrgb(): can't convert to" << type, (Image2D{image.format(), type}));
+    const std::size_t channels = channelCount(image);
+    CORRADE_ASSERT(channels >= 1 && channels <= 4,
+        "TextureTools::linearToSrgb(): unsupported format" << image.format(), (Image2D{image.format(), type}));
+
+    const bool alpha = Implementation::hasAlpha(image.format());
+    const std::size_t width = image.size().x();
+    const std::size_t rowSize = width*channels;
+
+    if(type == PixelType::UnsignedByte) {
+        return convertRows(image, type, threadCount, [&](const char* const input, char* const output) {
+            const Float* const in = reinterpret_cast<const Float*>(input);
+            UnsignedByte* const out = reinterpret_cast<UnsignedByte*>(output);
+            for(std::size_t i = 0; i != rowSize; ++i)
+                out[i] = Implementation::linearToSrgb8(in[i]);
+            if(alpha) for(std::size_t x = channels - 1; x < rowSize; x += channels)
+                out[x] = UnsignedByte(Math::clamp(in[x], 0.0f, 1.0f)*255.0f + 0.5f);
+        });
+    }
+
+    return convertRows(image, type, threadCount, [&](const char* const input, char* const output) {
+        const Float* const in = reinterpret_cast<const Float*>(input);
+        Float* const out = reinterpret_cast<Float*>(output);
+        for(std::size_t i = 0; i != rowSize; ++i)
+            out[i] = Implementation::fastLinearToSrgb(in[i]);
+        if(alpha) for(std::size_t x = channels - 1; x < rowSize; x += channels)
+            out[x] = in[x];
+    });
+}
+
+Image2D rgbToHsv(const ImageView2D& image, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(image.type() == PixelType::UnsignedByte || image.type() == PixelType::Float,
+        "TextureTools::rgbToHsv(): expected" << PixelType::UnsignedByte << "or" << PixelType::Float << "but got" << image.type(), (Image2D{image.format(), PixelType::Float}));
+    CORRADE_ASSERT(isRgb(image.format()),
+        "TextureTools::rgbToHsv(): expected" << PixelFormat::RGB << "or" << PixelFormat::RGBA << "but got" << image.format(), (Image2D{image.format(), PixelType::Float}));
+
+    const bool isFloat = image.type() == PixelType::Float;
+    const std::size_t channels = channelCount(image);
+    const std::size_t width = image.size().x();
+
+    return convertRows(image, PixelType::Float, threadCount, [&](const char* const input, char* const output) {
+        Float* const out = reinterpret_cast<Float*>(output);
+
+        /* Unpack the row first so the conversion below is the same for both
+           types */
+        if(isFloat) std::copy_n(reinterpret_cast<const Float*>(input), width*channels, out);
+        else for(std::size_t i = 0; i != width*channels; ++i)
+            out[i] = Float(UnsignedByte(input[i]))/255.0f;
+
+        for(std::size_t x = 0; x != width; ++x) {
+            Float* const pixel = out + x*channels;
+            const Float r = pixel[0], g = pixel[1], b = pixel[2];
+            const Float max = Math::max(Math::max(r, g), b);
+            const Float delta = max - Math::min(Math::min(r, g), b);
+
+            Float hue = 0.0f;
+            if(delta != 0.0f) {
+                const Float deltaInv60 = 60.0f/delta;
+                if(max == r) hue = (g - b)*deltaInv60 + (g < b ? 360.0f : 0.0f);
+                else if(max == g) hue = (b - r)*deltaInv60 + 120.0f;
+                else hue = (r - g)*deltaInv60 + 240.0f;
+            }
+
+            pixel[0] = hue;
+            pixel[1] = max != 0.0f ? delta/max : 0.0f;
+            pixel[2] = max;
+        }
+    });
+}
+
+Image2D hsvToRgb(const ImageView2D& image, const PixelType type, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(image.type() == PixelType::Float,
+        "TextureTools::hsvToRgb(): expected" << PixelType::Float << "but got" << image.type(), (Image2D{image.format(), type}));
+    CORRADE_ASSERT(type == PixelType::UnsignedByte || type == PixelType::Float,
+        "TextureTools::hsvToRgb(): can't convert to" << type, (Image2D{image.format(), type}));
+    CORRADE_ASSERT(isRgb(image.format()),
+        "TextureTools::hsvToRgb(): expected" << PixelFormat::RGB << "or" << PixelFormat::RGBA << "but got" << image.format(), (Image2D{image.format(), type}));
+
+    const std::size_t channels = channelCount(image);
+    const std::size_t width = image.size().x();
+    const bool isFloat = type == PixelType::Float;
+
+    return convertRows(image, type, threadCount, [&](const char* const input, char* const output) {
+        const Float* const in = reinterpret_cast<const Float*>(input);
+        Float rgb[4];
+        for(std::size_t x = 0; x != width; ++x) {
+            const Float* const pixel = in + x*channels;
+            const Float saturation = pixel[1], value = pixel[2];
+
+            /* Hue in sextants wrapped to [0, 6), each channel is then a
+               piecewise linear function of it, which avoids a switch over
+               the sextants */
+            Float hue = pixel[0]/60.0f;
+            hue -= std::floor(hue/6.0f)*6.0f;
+            for(std::size_t c = 0; c != 3; ++c) {
+                Float k = Float(5 - 2*c) + hue;
+                k -= k >= 6.0f ? 6.0f : 0.0f;
+                rgb[c] = value - value*saturation*Math::max(0.0f, Math::min(Math::min(k, 4.0f - k), 1.0f));
+            }
+            if(channels == 4) rgb[3] = pixel[3];
+
+            if(isFloat) std::copy_n(rgb, channels, reinterpret_cast<Float*>(output) + x*channels);
+            else for(std::size_t c = 0; c != channels; ++c)
+                output[x*channels + c] = char(UnsignedByte(Math::clamp(rgb[c], 0.0f, 1.0f)*255.0f + 0.5f));
+        }
+    });
+}
+
+}}
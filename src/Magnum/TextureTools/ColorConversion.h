@@ -0,0 +1,110 @@
+#ifndef Magnum_TextureTools_ColorConversion_h
+#define Magnum_TextureTools_ColorConversion_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::TextureTools::srgbToLinear(), @ref Magnum::TextureTools::linearToSrgb(), @ref Magnum::TextureTools::rgbToHsv(), @ref Magnum::TextureTools::hsvToRgb()
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/TextureTools/visibility.h"
+
+namespace Magnum { namespace TextureTools {
+
+/**
+@brief Convert a sRGB image to linear RGB
+@param image        Image in sRGB
+@param threadCount  Count of worker threads. If `0`, the count is
+    taken from @ref std::thread::hardware_concurrency().
+@return Linear image with @ref PixelType::Float type
+
+Equivalent to calling @ref Math::Color3::fromSrgb() on every pixel, but much
+faster. The image is expected to have @ref PixelType::UnsignedByte or
+@ref PixelType::Float type, any non-integer color format with up to four
+channels is supported. The alpha channel is kept linear. 8-bit input is
+converted using a lookup table, floating-point input using a vectorizable
+approximation with relative error around @f$ 10^{-6} @f$, negative values are
+mapped to zero. The output has the same format as @p image with default pixel
+storage, rows are split between @p threadCount threads. On Emscripten the
+function is always single-threaded.
+@see @ref linearToSrgb(), @ref MipmapFlag::Srgb
+*/
+Image2D MAGNUM_TEXTURETOOLS_EXPORT srgbToLinear(const ImageView2D& image, UnsignedInt threadCount = 0);
+
+/**
+@brief Convert a linear RGB image to sRGB
+@param image        Image in linear RGB
+@param type         Output type
+@param threadCount  Count of worker threads. If `0`, the count is
+    taken from @ref std::thread::hardware_concurrency().
+@return Image in sRGB
+
+Inverse to @ref srgbToLinear(), equivalent to calling
+@ref Math::Color3::toSrgb() on every pixel. The image is expected to have
+@ref PixelType::Float type, @p type is expected to be either
+@ref PixelType::UnsignedByte or @ref PixelType::Float. When converting to
+8-bit output, the values are clamped to @f$ [0, 1] @f$ and rounded to
+nearest. The alpha channel is kept linear.
+*/
+Image2D MAGNUM_TEXTURETOOLS_EXPORT linearToSrgb(const ImageView2D& image, PixelType type = PixelType::UnsignedByte, UnsignedInt threadCount = 0);
+
+/**
+@brief Convert a RGB image to HSV
+@param image        Image in RGB
+@param threadCount  Count of worker threads. If `0`, the count is
+    taken from @ref std::thread::hardware_concurrency().
+@return Image with hue in degrees, saturation and value in the red, green
+    and blue channel and @ref PixelType::Float type
+
+Equivalent to calling @ref Math::Color3::toHsv() on every pixel. The image
+is expected to have @ref PixelFormat::RGB or @ref PixelFormat::RGBA format
+and @ref PixelType::UnsignedByte or @ref PixelType::Float type, the alpha
+channel is passed through. Rows are split between @p threadCount threads.
+@see @ref hsvToRgb()
+*/
+Image2D MAGNUM_TEXTURETOOLS_EXPORT rgbToHsv(const ImageView2D& image, UnsignedInt threadCount = 0);
+
+/**
+@brief Convert a HSV image to RGB
+@param image        Image in HSV
+@param type         Output type
+@param threadCount  Count of worker threads. If `0`, the count is
+    taken from @ref std::thread::hardware_concurrency().
+@return Image in RGB
+
+Inverse to @ref rgbToHsv(), equivalent to calling
+@ref Math::Color3::fromHsv() on every pixel. The image is expected to have
+@ref PixelFormat::RGB or @ref PixelFormat::RGBA format and
+@ref PixelType::Float type, with hue in degrees in the red channel. Hue
+outside of @f$ [0, 360) @f$ is wrapped around. @p type is expected to be
+either @ref PixelType::UnsignedByte or @ref PixelType::Float.
+*/
+Image2D MAGNUM_TEXTURETOOLS_EXPORT hsvToRgb(const ImageView2D& image, PixelType type = PixelType::Float, UnsignedInt threadCount = 0);
+
+}}
+
+#endif
@@ -25,8 +25,16 @@
 
 #include "DistanceField.h"
 
+#include <cstring>
+#include <tuple>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Utility/Resource.h>
 
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/Math/Functions.h"
 #include "Magnum/Math/Range.h"
 #include "Magnum/AbstractShaderProgram.h"
 #include "Magnum/Buffer.h"
@@ -64,6 +72,11 @@ class DistanceFieldShader: public AbstractShaderProgram {
             return *this;
         }
 
+        DistanceFieldShader& setInputOffset(const Vector2& offset) {
+            setUniform(inputOffsetUniform, offset);
+            return *this;
+        }
+
         DistanceFieldShader& setImageSizeInverted(const Vector2& size) {
             setUniform(imageSizeInvertedUniform, size);
             return *this;
@@ -79,6 +92,7 @@ class DistanceFieldShader: public AbstractShaderProgram {
 
         Int radiusUniform{0},
             scalingUniform{1},
+            inputOffsetUniform{3},
             imageSizeInvertedUniform;
 };
 
@@ -125,6 +139,7 @@ DistanceFieldShader::DistanceFieldShader() {
     {
         radiusUniform = uniformLocation("radius");
         scalingUniform = uniformLocation("scaling");
+        inputOffsetUniform = uniformLocation("inputOffset");
 
         #ifndef MAGNUM_TARGET_GLES
         if(!Context::current().isVersionSupported(Version::GL320))
@@ -144,7 +159,34 @@ DistanceFieldShader::DistanceFieldShader() {
     }
 }
 
+/* Older GLSL doesn't have gl_VertexID, vertices must be supplied explicitly */
+struct FullScreenTriangle {
+    explicit FullScreenTriangle() {
+        mesh.setPrimitive(MeshPrimitive::Triangles)
+            .setCount(3);
+
+        #ifndef MAGNUM_TARGET_GLES
+        if(!Context::current().isVersionSupported(Version::GL300))
+        #else
+        if(!Context::current().isVersionSupported(Version::GLES300))
+        #endif
+        {
+            constexpr Vector2 triangle[] = {
+                Vector2(-1.0,  1.0),
+                Vector2(-1.0, -3.0),
+                Vector2( 3.0,  1.0)
+            };
+            buffer.setData(triangle, BufferUsage::StaticDraw);
+            mesh.addVertexBuffer(buffer, 0, DistanceFieldShader::Position());
+        }
+    }
+
+    Buffer buffer;
+    Mesh mesh;
+};
+
 }
+
 #ifndef MAGNUM_TARGET_GLES
 void distanceField(Texture2D& input, Texture2D& output, const Range2Di& rectangle, const Int radius, const Vector2i&)
 #else
@@ -187,29 +229,154 @@ void distanceField(Texture2D& input, Texture2D& output, const Range2Di& rectangl
         shader.setImageSizeInverted(1.0f/Vector2(imageSize));
     }
 
-    Mesh mesh;
-    mesh.setPrimitive(MeshPrimitive::Triangles)
-        .setCount(3);
+    /* Draw the mesh */
+    FullScreenTriangle triangle;
+    triangle.mesh.draw(shader);
+}
 
-    /* Older GLSL doesn't have gl_VertexID, vertices must be supplied explicitly */
-    Buffer buffer;
+void distanceField(Texture2D& input, Texture2D& output, const std::vector<Range2Di>& rectangles, const Int radius, const Vector2i& imageSize, const Vector2i& outputSize) {
     #ifndef MAGNUM_TARGET_GLES
-    if(!Context::current().isVersionSupported(Version::GL300))
+    MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::ARB::framebuffer_object);
+    #endif
+
+    if(rectangles.empty()) return;
+
+    /* The framebuffer is not cleared, only the pixels inside the rectangles
+       are overwritten */
+    Framebuffer framebuffer({{}, outputSize});
+    framebuffer.attachTexture(Framebuffer::ColorAttachment(0), output, 0);
+    framebuffer.bind();
+
+    const Framebuffer::Status status = framebuffer.checkStatus(FramebufferTarget::Draw);
+    if(status != Framebuffer::Status::Complete) {
+        Error() << "TextureTools::distanceField(): cannot render to given output texture, unexpected framebuffer status"
+                << status;
+        return;
+    }
+
+    /* Scaling is the same for all rectangles, the shader calculates input
+       position from absolute fragment coordinates */
+    DistanceFieldShader shader;
+    shader.setRadius(radius)
+        .setScaling(Vector2(imageSize)/Vector2(outputSize))
+        .setTexture(input);
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isVersionSupported(Version::GL320))
     #else
     if(!Context::current().isVersionSupported(Version::GLES300))
     #endif
     {
-        constexpr Vector2 triangle[] = {
-            Vector2(-1.0,  1.0),
-            Vector2(-1.0, -3.0),
-            Vector2( 3.0,  1.0)
-        };
-        buffer.setData(triangle, BufferUsage::StaticDraw);
-        mesh.addVertexBuffer(buffer, 0, DistanceFieldShader::Position());
+        shader.setImageSizeInverted(1.0f/Vector2(imageSize));
     }
 
-    /* Draw the mesh */
-    mesh.draw(shader);
+    /* Restrict each draw to one rectangle using the viewport */
+    FullScreenTriangle triangle;
+    for(const Range2Di& rectangle: rectangles) {
+        framebuffer.setViewport(rectangle);
+        triangle.mesh.draw(shader);
+    }
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+Image2D distanceFieldTiled(const ImageView2D& input, const Vector2i& outputSize, const Int radius, const Vector2i& tileSize) {
+    #ifndef MAGNUM_TARGET_GLES
+    MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::ARB::framebuffer_object);
+    #endif
+
+    CORRADE_ASSERT(input.type() == PixelType::UnsignedByte,
+        "TextureTools::distanceFieldTiled(): expected" << PixelType::UnsignedByte << "but got" << input.type(), (Image2D{PixelFormat::Red, PixelType::UnsignedByte}));
+
+    const Vector2i maxTileSize = tileSize.isZero() ? Texture2D::maxSize() : tileSize;
+
+    /* Each input tile needs to contain the area covered by the output tile
+       plus the lookup radius on each side and a few more pixels for
+       rounding */
+    const Vector2 scaling = Vector2(input.size())/Vector2(outputSize);
+    const Vector2i outputTileSize = Math::min(
+        Vector2i{Math::floor(Vector2(maxTileSize - Vector2i{radius*2 + 3})/scaling)},
+        outputSize);
+    CORRADE_ASSERT(outputTileSize.min() > 0,
+        "TextureTools::distanceFieldTiled(): tile size" << maxTileSize << "is too small for radius" << radius << "and scaling" << scaling, (Image2D{PixelFormat::Red, PixelType::UnsignedByte}));
+
+    /* Output data, rows aligned to four bytes to match default pixel storage */
+    const std::size_t outputStride = (outputSize.x() + 3)/4*4;
+    Containers::Array<char> data{Containers::ValueInit, outputStride*outputSize.y()};
+
+    std::size_t pixelSize;
+    Math::Vector2<std::size_t> dataOffset, dataSize;
+    std::tie(dataOffset, dataSize, pixelSize) = input.dataProperties();
+
+    DistanceFieldShader shader;
+    shader.setRadius(radius)
+        .setScaling(scaling);
+    FullScreenTriangle triangle;
+
+    for(Int y = 0; y < outputSize.y(); y += outputTileSize.y()) {
+        for(Int x = 0; x < outputSize.x(); x += outputTileSize.x()) {
+            const Range2Di outputTile{{x, y}, Math::min(Vector2i{x, y} + outputTileSize, outputSize)};
+
+            /* Input area covered by the output tile, extended by the radius
+               and clamped to the image */
+            const Vector2 inputTileOrigin = Vector2(outputTile.min())*scaling;
+            const Range2Di inputTile{
+                Math::max(Vector2i{Math::floor(inputTileOrigin)} - Vector2i{radius}, Vector2i{}),
+                Math::min(Vector2i{Math::ceil(Vector2(outputTile.max())*scaling)} + Vector2i{radius + 1}, input.size())};
+
+            /* Copy first channel of the tile into a tightly packed image */
+            const Vector2i inputTileSize = inputTile.size();
+            const std::size_t tileStride = (inputTileSize.x() + 3)/4*4;
+            Containers::Array<char> tileData{Containers::ValueInit, tileStride*inputTileSize.y()};
+            for(Int ty = 0; ty != inputTileSize.y(); ++ty) {
+                const char* const row = input.data<char>() + dataOffset.sum() + (inputTile.min().y() + ty)*dataSize.x() + inputTile.min().x()*pixelSize;
+                char* const tileRow = tileData + ty*tileStride;
+                for(Int tx = 0; tx != inputTileSize.x(); ++tx)
+                    tileRow[tx] = row[tx*pixelSize];
+            }
+
+            Texture2D inputTexture;
+            inputTexture.setMinificationFilter(Sampler::Filter::Linear)
+                .setMagnificationFilter(Sampler::Filter::Linear)
+                .setWrapping(Sampler::Wrapping::ClampToEdge)
+                .setStorage(1, TextureFormat::R8, inputTileSize)
+                .setSubImage(0, {}, ImageView2D{PixelFormat::Red, PixelType::UnsignedByte, inputTileSize, tileData});
+
+            Texture2D outputTexture;
+            outputTexture.setStorage(1, TextureFormat::R8, outputTile.size());
+
+            Framebuffer framebuffer{Range2Di{{}, outputTile.size()}};
+            framebuffer.attachTexture(Framebuffer::ColorAttachment(0), outputTexture, 0);
+            framebuffer.bind();
+
+            const Framebuffer::Status status = framebuffer.checkStatus(FramebufferTarget::Draw);
+            if(status != Framebuffer::Status::Complete) {
+                Error() << "TextureTools::distanceFieldTiled(): cannot render to the output tile, unexpected framebuffer status"
+                        << status;
+                return Image2D{PixelFormat::Red, PixelType::UnsignedByte};
+            }
+
+            /* Fragment coordinates are relative to the tile, offset them so
+               they sample the same input pixels as in the whole image */
+            shader.setInputOffset(inputTileOrigin - Vector2(inputTile.min()))
+                .setTexture(inputTexture);
+
+            #ifndef MAGNUM_TARGET_GLES
+            if(!Context::current().isVersionSupported(Version::GL320))
+                shader.setImageSizeInverted(1.0f/Vector2(inputTileSize));
+            #endif
+
+            triangle.mesh.draw(shader);
+
+            /* Stitch the tile into the output */
+            Image2D tileImage = framebuffer.read(framebuffer.viewport(), {PixelFormat::Red, PixelType::UnsignedByte});
+            const std::size_t tileImageStride = (outputTile.sizeX() + 3)/4*4;
+            for(Int ty = 0; ty != outputTile.sizeY(); ++ty)
+                std::memcpy(data + (outputTile.min().y() + ty)*outputStride + outputTile.min().x(), tileImage.data<char>() + ty*tileImageStride, outputTile.sizeX());
+        }
+    }
+
+    return Image2D{PixelFormat::Red, PixelType::UnsignedByte, outputSize, std::move(data)};
+}
+#endif
+
 }}
@@ -26,9 +26,11 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::TextureTools::distanceField()
+ * @brief Function @ref Magnum::TextureTools::distanceField(), @ref Magnum::TextureTools::distanceFieldTiled()
  */
 
+#include <vector>
+
 #ifndef MAGNUM_TARGET_GLES
 #include "Magnum/Math/Vector2.h"
 #endif
@@ -80,7 +82,9 @@ Based on: *Chris Green - Improved Alpha-Tested Magnification for Vector Textures
 and Special Effects, SIGGRAPH 2007,
 http://www.valvesoftware.com/publications/2007/SIGGRAPH2007_AlphaTestedMagnification.pdf*
 
-@attention This is GPU-only implementation, so it expects active context.
+@attention This is GPU-only implementation, so it expects active context. See
+    @ref distanceField(const ImageView2D&, const Vector2i&, Int, UnsignedInt)
+    for an implementation running on the CPU.
 
 @note If internal format of @p output texture is not renderable, this function
     prints message to error output and does nothing. In desktop OpenGL and
@@ -99,6 +103,87 @@ void MAGNUM_TEXTURETOOLS_EXPORT distanceField(Texture2D& input, Texture2D& outpu
 void MAGNUM_TEXTURETOOLS_EXPORT distanceField(Texture2D& input, Texture2D& output, const Range2Di& rectangle, Int radius, const Vector2i& imageSize);
 #endif
 
+/**
+@brief Update signed distance field in multiple rectangles
+@param input        Input texture
+@param output       Output texture
+@param rectangles   Rectangles in output texture which to update
+@param radius       Max lookup radius in input texture
+@param imageSize    Input texture size
+@param outputSize   Output texture size
+
+Unlike @ref distanceField(Texture2D&, Texture2D&, const Range2Di&, Int, const Vector2i&),
+which processes the whole @p input into given rectangle of @p output and
+clears the rest of it, this function maps whole @p input onto whole
+@p output and recalculates only pixels inside @p rectangles, leaving the rest
+of @p output untouched. All rectangles are processed with single framebuffer
+and shader setup, which makes it suitable for incremental updates of large
+textures such as glyph caches. Overlapping rectangles are processed more than
+once, merge them beforehand to avoid redundant work.
+
+@attention This is GPU-only implementation, so it expects active context.
+@see @ref Text::DistanceFieldGlyphCache::flush()
+*/
+void MAGNUM_TEXTURETOOLS_EXPORT distanceField(Texture2D& input, Texture2D& output, const std::vector<Range2Di>& rectangles, Int radius, const Vector2i& imageSize, const Vector2i& outputSize);
+
+#ifndef MAGNUM_TARGET_GLES2
+/**
+@brief Create signed distance field from a large image in tiles
+@param input        Input image
+@param outputSize   Output image size
+@param radius       Max lookup radius in input image
+@param tileSize     Max size of input texture uploaded at once. If zero,
+    @ref Texture2D::maxSize() is used.
+
+Produces the same output as @ref distanceField(Texture2D&, Texture2D&, const Range2Di&, Int, const Vector2i&)
+but the input doesn't need to fit into a single texture. The output is split
+into tiles and for each tile only the part of @p input covered by it,
+extended by @p radius on each side, is uploaded and processed on the GPU.
+The result is then downloaded and stitched into the output image, so the
+GPU memory usage is bounded by @p tileSize regardless of the input and
+output size. Use this function for inputs that are larger than
+@ref Texture2D::maxSize() or don't fit into available video memory.
+
+The input is expected to have @ref PixelType::UnsignedByte type, only the
+first channel of each pixel is taken into account. The output image has
+@ref PixelFormat::Red format and @ref PixelType::UnsignedByte type with
+default pixel storage. The @p tileSize is expected to be larger than
+@p radius multiplied by two plus the ratio of input and output size.
+
+@attention This is GPU-only implementation, so it expects active context.
+@requires_gles30 Tiled processing is not available in OpenGL ES 2.0.
+*/
+Image2D MAGNUM_TEXTURETOOLS_EXPORT distanceFieldTiled(const ImageView2D& input, const Vector2i& outputSize, Int radius, const Vector2i& tileSize = {});
+#endif
+
+/**
+@brief Create signed distance field on the CPU
+@param input        Input image
+@param outputSize   Output image size
+@param radius       Max lookup radius in input image
+@param threadCount  Count of worker threads. If `0`, the count is
+    taken from @ref std::thread::hardware_concurrency().
+
+Produces the same output as @ref distanceField(Texture2D&, Texture2D&, const Range2Di&, Int, const Vector2i&)
+with @p rectangle spanning whole output, but doesn't need any GL context. The
+input is expected to have @ref PixelType::UnsignedByte type, only the first
+channel of each pixel is taken into account. The output image has
+@ref PixelFormat::Red format and @ref PixelType::UnsignedByte type with
+default pixel storage.
+
+Instead of searching the neighborhood of each pixel, exact Euclidean distance
+transform is calculated for the whole input in two separable passes, so the
+time complexity doesn't depend on @p radius. Both passes are distributed
+across @p threadCount threads, the column pass processes whole rows at once to
+make use of compiler auto-vectorization. On Emscripten the function is always
+single-threaded.
+
+Based on: *A. Meijster, J. B. T. M. Roerdink, W. H. Hesselink - A General
+Algorithm for Computing Distance Transforms in Linear Time, Mathematical
+Morphology and its Applications to Image and Signal Processing, 2000*
+*/
+Image2D MAGNUM_TEXTURETOOLS_EXPORT distanceField(const ImageView2D& input, const Vector2i& outputSize, Int radius, UnsignedInt threadCount = 0);
+
 }}
 
 #endif
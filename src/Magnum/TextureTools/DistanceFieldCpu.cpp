@@ -0,0 +1,205 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DistanceField.h"
+
+#include <algorithm>
+#include <tuple>
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#endif
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace TextureTools {
+
+namespace {
+
+/* Calls function(begin, end) on evenly split parts of [0, count) range in
+   parallel */
+template<class F> void parallelFor(const std::size_t count, const std::size_t threadCount, const F& function) {
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    const std::size_t partCount = std::min(threadCount, count);
+    if(partCount > 1) {
+        std::vector<std::thread> threads;
+        threads.reserve(partCount - 1);
+        for(std::size_t i = 1; i != partCount; ++i)
+            threads.emplace_back(function, count*i/partCount, count*(i + 1)/partCount);
+        function(std::size_t{0}, count/partCount);
+        for(std::thread& thread: threads) thread.join();
+        return;
+    }
+    #else
+    static_cast<void>(threadCount);
+    #endif
+
+    function(std::size_t{0}, count);
+}
+
+/* Integer division rounding towards negative infinity, divisor is positive */
+inline Int floorDivide(const Int numerator, const Int denominator) {
+    return numerator >= 0 ? numerator/denominator : -((denominator - numerator - 1)/denominator);
+}
+
+/* Second pass of the Meijster algorithm for one row -- given column distances
+   in `g`, calculates squared distances to nearest feature pixel into `out`.
+   The `s` and `t` arrays are scratch space of the same size. */
+void distanceTransformRow(const Int* const g, Int* const out, Int* const s, Int* const t, const Int width) {
+    const auto f = [g](const Int x, const Int i) {
+        return (x - i)*(x - i) + g[i]*g[i];
+    };
+    const auto separation = [g](const Int i, const Int u) {
+        return floorDivide(u*u - i*i + g[u]*g[u] - g[i]*g[i], 2*(u - i));
+    };
+
+    Int q = 0;
+    s[0] = 0;
+    t[0] = 0;
+    for(Int u = 1; u != width; ++u) {
+        while(q >= 0 && f(t[q], s[q]) > f(t[q], u)) --q;
+
+        if(q < 0) {
+            q = 0;
+            s[0] = u;
+        } else {
+            const Int w = 1 + separation(s[q], u);
+            if(w < width) {
+                ++q;
+                s[q] = u;
+                t[q] = w;
+            }
+        }
+    }
+
+    for(Int u = width - 1; u >= 0; --u) {
+        out[u] = f(u, s[q]);
+        if(u == t[q]) --q;
+    }
+}
+
+}
+
+Image2D distanceField(const ImageView2D& input, const Vector2i& outputSize, const Int radius, UnsignedInt threadCount) {
+    CORRADE_ASSERT(input.type() == PixelType::UnsignedByte,
+        "TextureTools::distanceField(): expected" << PixelType::UnsignedByte << "but got" << input.type(), (Image2D{PixelFormat::Red, PixelType::UnsignedByte}));
+
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    if(!threadCount) threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    #endif
+
+    const Vector2i size = input.size();
+    const std::size_t width = size.x();
+    const std::size_t height = size.y();
+
+    /* Threshold first channel of each pixel, the same as the shader does */
+    std::size_t pixelSize;
+    Math::Vector2<std::size_t> dataOffset, dataSize;
+    std::tie(dataOffset, dataSize, pixelSize) = input.dataProperties();
+    Containers::Array<UnsignedByte> inside{width*height};
+    for(std::size_t y = 0; y != height; ++y) {
+        const char* const row = input.data<char>() + dataOffset.sum() + y*dataSize.x();
+        for(std::size_t x = 0; x != width; ++x)
+            inside[y*width + x] = UnsignedByte(row[x*pixelSize]) > 127;
+    }
+
+    /* Distances larger than radius are clamped to radius + 1 in the output,
+       so the column distances can be capped to that value without affecting
+       the result. That also keeps the squared values small. */
+    const Int cap = radius + 1;
+
+    /* First pass -- for each pixel, vertical distance to the nearest inside
+       and outside pixel in the same column. The columns are split between
+       threads, each thread processes its part of a row at once. */
+    Containers::Array<Int> toInside{width*height};
+    Containers::Array<Int> toOutside{width*height};
+    parallelFor(width, threadCount, [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t x = begin; x != end; ++x) {
+            toInside[x] = inside[x] ? 0 : cap;
+            toOutside[x] = inside[x] ? cap : 0;
+        }
+
+        for(std::size_t y = 1; y < height; ++y) {
+            const std::size_t row = y*width;
+            const std::size_t prev = row - width;
+            for(std::size_t x = begin; x != end; ++x) {
+                toInside[row + x] = inside[row + x] ? 0 : std::min(toInside[prev + x] + 1, cap);
+                toOutside[row + x] = inside[row + x] ? std::min(toOutside[prev + x] + 1, cap) : 0;
+            }
+        }
+
+        for(std::size_t y = height - 1; y-- > 0; ) {
+            const std::size_t row = y*width;
+            const std::size_t next = row + width;
+            for(std::size_t x = begin; x != end; ++x) {
+                toInside[row + x] = std::min(toInside[row + x], toInside[next + x] + 1);
+                toOutside[row + x] = std::min(toOutside[row + x], toOutside[next + x] + 1);
+            }
+        }
+    });
+
+    /* Output data, rows aligned to four bytes to match default pixel storage */
+    const std::size_t outputWidth = outputSize.x();
+    const std::size_t outputStride = (outputWidth + 3)/4*4;
+    Containers::Array<char> data{Containers::ValueInit, outputStride*outputSize.y()};
+
+    /* Second pass -- only input rows which are sampled by the output need to
+       be processed. The output rows are split between threads. */
+    const Vector2 scaling = Vector2(size)/Vector2(outputSize);
+    const Int maxDistanceSquared = cap*cap;
+    const Float normalization = 1.0f/Float(radius*2 + 2);
+    parallelFor(outputSize.y(), threadCount, [&](const std::size_t begin, const std::size_t end) {
+        Containers::Array<Int> scratch{width*4};
+        Int* const distanceToInside = scratch;
+        Int* const distanceToOutside = scratch + width;
+
+        for(std::size_t y = begin; y != end; ++y) {
+            const std::size_t inputRow = Int(Float(y)*scaling.y())*width;
+            distanceTransformRow(toInside + inputRow, distanceToInside, scratch + width*2, scratch + width*3, width);
+            distanceTransformRow(toOutside + inputRow, distanceToOutside, scratch + width*2, scratch + width*3, width);
+
+            char* const outputRow = data + y*outputStride;
+            for(std::size_t x = 0; x != outputWidth; ++x) {
+                const std::size_t inputColumn = Int(Float(x)*scaling.x());
+                const bool isInside = inside[inputRow + inputColumn];
+                const Int distanceSquared = std::min(isInside ?
+                    distanceToOutside[inputColumn] : distanceToInside[inputColumn],
+                    maxDistanceSquared);
+
+                /* Final signed distance, normalized from [-radius-1, radius+1]
+                   to [0, 1] */
+                const Float value = (isInside ? 1.0f : -1.0f)*std::sqrt(Float(distanceSquared))*normalization + 0.5f;
+                outputRow[x] = char(UnsignedByte(value*255.0f + 0.5f));
+            }
+        }
+    });
+
+    return Image2D{PixelFormat::Red, PixelType::UnsignedByte, outputSize, std::move(data)};
+}
+
+}}
@@ -40,9 +40,11 @@
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 0) uniform int radius;
 layout(location = 1) uniform vec2 scaling;
+layout(location = 3) uniform vec2 inputOffset; /* defaults to zero */
 #else
 uniform lowp int radius;
 uniform mediump vec2 scaling;
+uniform highp vec2 inputOffset; /* defaults to zero */
 #endif
 
 #ifdef EXPLICIT_TEXTURE_LAYER
@@ -88,12 +90,12 @@ bool hasValue(const mediump vec2 position, const mediump vec2 offset) {
 void main() {
     #ifdef TEXELFETCH_USABLE
     #ifndef GL_ES
-    const mediump ivec2 position = ivec2(gl_FragCoord.xy*scaling);
+    const mediump ivec2 position = ivec2(gl_FragCoord.xy*scaling + inputOffset);
     #else
-    const mediump ivec2 position = ivec2((gl_FragCoord.xy - vec2(0.5))*scaling);
+    const mediump ivec2 position = ivec2((gl_FragCoord.xy - vec2(0.5))*scaling + inputOffset);
     #endif
     #else
-    const mediump vec2 position = (gl_FragCoord.xy - vec2(0.5))*scaling*imageSizeInverted;
+    const mediump vec2 position = ((gl_FragCoord.xy - vec2(0.5))*scaling + inputOffset)*imageSizeInverted;
     #endif
 
     /* If pixel at the position is inside (1), we are looking for nearest pixel
@@ -0,0 +1,70 @@
+#ifndef Magnum_TextureTools_Implementation_parallelFor_h
+#define Magnum_TextureTools_Implementation_parallelFor_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <cstddef>
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#include <vector>
+#endif
+
+#include "Magnum/Types.h"
+
+namespace Magnum { namespace TextureTools { namespace Implementation {
+
+/* Thread count to use if the user passed 0 */
+inline UnsignedInt threadCountOrDefault(const UnsignedInt threadCount) {
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    if(!threadCount) return std::max(std::thread::hardware_concurrency(), 1u);
+    #endif
+    return threadCount;
+}
+
+/* Calls function(begin, end) on evenly split parts of [0, count) range in
+   parallel */
+template<class F> void parallelFor(const std::size_t count, const std::size_t threadCount, const F& function) {
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    const std::size_t partCount = std::min(threadCount, count);
+    if(partCount > 1) {
+        std::vector<std::thread> threads;
+        threads.reserve(partCount - 1);
+        for(std::size_t i = 1; i != partCount; ++i)
+            threads.emplace_back(function, count*i/partCount, count*(i + 1)/partCount);
+        function(std::size_t{0}, count/partCount);
+        for(std::thread& thread: threads) thread.join();
+        return;
+    }
+    #else
+    static_cast<void>(threadCount);
+    #endif
+
+    function(std::size_t{0}, count);
+}
+
+}}}
+
+#endif
@@ -0,0 +1,301 @@
+#ifndef Magnum_TextureTools_Implementation_pixelConversion_h
+#define Magnum_TextureTools_Implementation_pixelConversion_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstddef>
+
+#include "Magnum/Types.h"
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+#ifdef __wasm_simd128__
+#include <wasm_simd128.h>
+#endif
+
+/* Header-only so the image plugins can use the kernels without linking to
+   the TextureTools library */
+
+namespace Magnum { namespace TextureTools { namespace Implementation {
+
+/* Whether bgrSwizzleSimd() does anything */
+#if defined(__SSSE3__) || defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(__wasm_simd128__)
+constexpr bool BgrSwizzleSimd = true;
+#else
+constexpr bool BgrSwizzleSimd = false;
+#endif
+
+/* Swaps first and third channel of given pixel count, `in` and `out` can
+   point to the same memory */
+template<std::size_t channels> inline void bgrSwizzleScalar(const UnsignedByte* in, UnsignedByte* out, const std::size_t count) {
+    static_assert(channels == 3 || channels == 4, "only three- and four-channel pixels are supported");
+    for(std::size_t i = 0; i != count; ++i, in += channels, out += channels) {
+        const UnsignedByte first = in[0];
+        out[0] = in[2];
+        out[1] = in[1];
+        out[2] = first;
+        if(channels == 4) out[3] = in[3];
+    }
+}
+
+/* Vectorized variant of the above. Returns count of processed pixels, the rest
+   needs to be processed with bgrSwizzleScalar(). */
+template<std::size_t channels> std::size_t bgrSwizzleSimd(const UnsignedByte* in, UnsignedByte* out, std::size_t count);
+
+template<> inline std::size_t bgrSwizzleSimd<3>(const UnsignedByte* const in, UnsignedByte* const out, const std::size_t count) {
+    std::size_t i = 0;
+
+    #if defined(__SSSE3__)
+    /* Sixteen pixels in three vectors. Pixels crossing vector boundaries are
+       assembled from two shuffles. Processing overlapping 15-byte blocks would
+       be simpler, but the overlapping loads and stores defeat store-to-load
+       forwarding when operating in-place. */
+    const __m128i a0 = _mm_setr_epi8(2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 14, 13, 12, -128);
+    const __m128i a1 = _mm_setr_epi8(-128, 15, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128);
+    const __m128i b0 = _mm_setr_epi8(-128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, 1);
+    const __m128i b1 = _mm_setr_epi8(0, -128, 4, 3, 2, 7, 6, 5, 10, 9, 8, 13, 12, 11, -128, 15);
+    const __m128i b2 = _mm_setr_epi8(14, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128);
+    const __m128i c1 = _mm_setr_epi8(-128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, 0, -128);
+    const __m128i c2 = _mm_setr_epi8(-128, 3, 2, 1, 6, 5, 4, 9, 8, 7, 12, 11, 10, 15, 14, 13);
+    for(; i + 16 <= count; i += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i*3));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i*3 + 16));
+        const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i*3 + 32));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i*3),
+            _mm_or_si128(_mm_shuffle_epi8(a, a0), _mm_shuffle_epi8(b, b0)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i*3 + 16),
+            _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(a, a1), _mm_shuffle_epi8(b, b1)), _mm_shuffle_epi8(c, c1)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i*3 + 32),
+            _mm_or_si128(_mm_shuffle_epi8(b, b2), _mm_shuffle_epi8(c, c2)));
+    }
+    #elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    /* Deinterleaving load of 16 pixels, swap the first and third plane */
+    for(; i + 16 <= count; i += 16) {
+        uint8x16x3_t pixels = vld3q_u8(in + i*3);
+        const uint8x16_t first = pixels.val[0];
+        pixels.val[0] = pixels.val[2];
+        pixels.val[2] = first;
+        vst3q_u8(out + i*3, pixels);
+    }
+    #elif defined(__wasm_simd128__)
+    /* Same blocks as with SSSE3, but the two-input shuffles need only one
+       extra step for the middle vector */
+    for(; i + 16 <= count; i += 16) {
+        const v128_t a = wasm_v128_load(in + i*3);
+        const v128_t b = wasm_v128_load(in + i*3 + 16);
+        const v128_t c = wasm_v128_load(in + i*3 + 32);
+        const v128_t bc = wasm_i8x16_shuffle(b, c, 0, 0, 4, 3, 2, 7, 6, 5, 10, 9, 8, 13, 12, 11, 16, 15);
+        wasm_v128_store(out + i*3,
+            wasm_i8x16_shuffle(a, b, 2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 14, 13, 12, 17));
+        wasm_v128_store(out + i*3 + 16,
+            wasm_i8x16_shuffle(bc, a, 0, 31, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+        wasm_v128_store(out + i*3 + 32,
+            wasm_i8x16_shuffle(b, c, 14, 19, 18, 17, 22, 21, 20, 25, 24, 23, 28, 27, 26, 31, 30, 29));
+    }
+    #else
+    static_cast<void>(in);
+    static_cast<void>(out);
+    static_cast<void>(count);
+    #endif
+
+    return i;
+}
+
+template<> inline std::size_t bgrSwizzleSimd<4>(const UnsignedByte* const in, UnsignedByte* const out, const std::size_t count) {
+    std::size_t i = 0;
+
+    #if defined(__SSSE3__)
+    const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    for(; i + 4 <= count; i += 4) {
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i*4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i*4), _mm_shuffle_epi8(pixels, shuffle));
+    }
+    #elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    for(; i + 16 <= count; i += 16) {
+        uint8x16x4_t pixels = vld4q_u8(in + i*4);
+        const uint8x16_t first = pixels.val[0];
+        pixels.val[0] = pixels.val[2];
+        pixels.val[2] = first;
+        vst4q_u8(out + i*4, pixels);
+    }
+    #elif defined(__wasm_simd128__)
+    for(; i + 4 <= count; i += 4) {
+        const v128_t pixels = wasm_v128_load(in + i*4);
+        wasm_v128_store(out + i*4, wasm_i8x16_shuffle(pixels, pixels, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15));
+    }
+    #else
+    static_cast<void>(in);
+    static_cast<void>(out);
+    static_cast<void>(count);
+    #endif
+
+    return i;
+}
+
+/* Swizzle using the vectorized variant where possible and scalar code for the
+   rest */
+template<std::size_t channels> inline void bgrSwizzle(const char* const in, char* const out, const std::size_t count) {
+    const UnsignedByte* const input = reinterpret_cast<const UnsignedByte*>(in);
+    UnsignedByte* const output = reinterpret_cast<UnsignedByte*>(out);
+    const std::size_t processed = bgrSwizzleSimd<channels>(input, output, count);
+    bgrSwizzleScalar<channels>(input + processed*channels, output + processed*channels, count - processed);
+}
+
+/* Expands three-channel pixels to four channels with opaque alpha, optionally
+   swapping the first and third channel. `in` and `out` can't overlap. */
+template<bool swap> inline void expandAlpha(const UnsignedByte* const in, UnsignedByte* const out, const std::size_t count) {
+    std::size_t i = 0;
+
+    #if defined(__SSSE3__)
+    /* Four pixels per iteration, the 16-byte load reads four bytes past the
+       twelve used, so stop early enough to stay in bounds */
+    const __m128i shuffle = swap ?
+        _mm_setr_epi8(2, 1, 0, -128, 5, 4, 3, -128, 8, 7, 6, -128, 11, 10, 9, -128) :
+        _mm_setr_epi8(0, 1, 2, -128, 3, 4, 5, -128, 6, 7, 8, -128, 9, 10, 11, -128);
+    const __m128i alpha = _mm_set1_epi32(int(0xff000000u));
+    for(; i + 6 <= count; i += 4) {
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i*3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i*4),
+            _mm_or_si128(_mm_shuffle_epi8(pixels, shuffle), alpha));
+    }
+    #elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    for(; i + 16 <= count; i += 16) {
+        const uint8x16x3_t pixels = vld3q_u8(in + i*3);
+        uint8x16x4_t expanded;
+        expanded.val[0] = pixels.val[swap ? 2 : 0];
+        expanded.val[1] = pixels.val[1];
+        expanded.val[2] = pixels.val[swap ? 0 : 2];
+        expanded.val[3] = vdupq_n_u8(255);
+        vst4q_u8(out + i*4, expanded);
+    }
+    #elif defined(__wasm_simd128__)
+    /* Same as with SSSE3, the alpha is taken from the second shuffle input */
+    const v128_t alpha = wasm_i8x16_splat(-1);
+    for(; i + 6 <= count; i += 4) {
+        const v128_t pixels = wasm_v128_load(in + i*3);
+        wasm_v128_store(out + i*4, swap ?
+            wasm_i8x16_shuffle(pixels, alpha, 2, 1, 0, 16, 5, 4, 3, 16, 8, 7, 6, 16, 11, 10, 9, 16) :
+            wasm_i8x16_shuffle(pixels, alpha, 0, 1, 2, 16, 3, 4, 5, 16, 6, 7, 8, 16, 9, 10, 11, 16));
+    }
+    #endif
+
+    for(; i != count; ++i) {
+        out[i*4 + 0] = in[i*3 + (swap ? 2 : 0)];
+        out[i*4 + 1] = in[i*3 + 1];
+        out[i*4 + 2] = in[i*3 + (swap ? 0 : 2)];
+        out[i*4 + 3] = 255;
+    }
+}
+
+/* Converts normalized 8-bit values to floats in [0, 1] */
+inline void unpackUnsignedByte(const UnsignedByte* const in, Float* const out, const std::size_t count) {
+    std::size_t i = 0;
+
+    #if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128 scale = _mm_set1_ps(1.0f/255.0f);
+    for(; i + 16 <= count; i += 16) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        const __m128i lo = _mm_unpacklo_epi8(bytes, zero);
+        const __m128i hi = _mm_unpackhi_epi8(bytes, zero);
+        _mm_storeu_ps(out + i + 0, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), scale));
+        _mm_storeu_ps(out + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), scale));
+        _mm_storeu_ps(out + i + 8, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), scale));
+        _mm_storeu_ps(out + i + 12, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), scale));
+    }
+    #elif defined(__wasm_simd128__)
+    const v128_t scale = wasm_f32x4_splat(1.0f/255.0f);
+    for(; i + 16 <= count; i += 16) {
+        const v128_t bytes = wasm_v128_load(in + i);
+        const v128_t lo = wasm_u16x8_extend_low_u8x16(bytes);
+        const v128_t hi = wasm_u16x8_extend_high_u8x16(bytes);
+        wasm_v128_store(out + i + 0, wasm_f32x4_mul(wasm_f32x4_convert_i32x4(wasm_u32x4_extend_low_u16x8(lo)), scale));
+        wasm_v128_store(out + i + 4, wasm_f32x4_mul(wasm_f32x4_convert_i32x4(wasm_u32x4_extend_high_u16x8(lo)), scale));
+        wasm_v128_store(out + i + 8, wasm_f32x4_mul(wasm_f32x4_convert_i32x4(wasm_u32x4_extend_low_u16x8(hi)), scale));
+        wasm_v128_store(out + i + 12, wasm_f32x4_mul(wasm_f32x4_convert_i32x4(wasm_u32x4_extend_high_u16x8(hi)), scale));
+    }
+    #endif
+
+    for(; i != count; ++i) out[i] = in[i]*(1.0f/255.0f);
+}
+
+/* Converts floats to normalized 8-bit values, clamping to [0, 1] and rounding
+   to nearest */
+inline UnsignedByte packUnsignedByte(const Float value) {
+    /* Written so NaN ends up as zero */
+    return UnsignedByte((value > 0.0f ? (value < 1.0f ? value : 1.0f) : 0.0f)*255.0f + 0.5f);
+}
+
+inline void packUnsignedByte(const Float* const in, UnsignedByte* const out, const std::size_t count) {
+    std::size_t i = 0;
+
+    #if defined(__SSE2__)
+    /* Clamping first as out-of-range values would convert to the integer
+       minimum, the max returns the second operand for NaN which makes it
+       zero. Rounding half up by truncating value + 0.5 to match the scalar
+       code. */
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 scale = _mm_set1_ps(255.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    __m128i v[4];
+    for(; i + 16 <= count; i += 16) {
+        for(std::size_t j = 0; j != 4; ++j) {
+            const __m128 clamped = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(in + i + j*4), zero), one);
+            v[j] = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(clamped, scale), half));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+            _mm_packus_epi16(_mm_packs_epi32(v[0], v[1]), _mm_packs_epi32(v[2], v[3])));
+    }
+    #elif defined(__wasm_simd128__)
+    /* Unlike wasm_f32x4_min() and wasm_f32x4_max(), the pseudo-min and
+       pseudo-max return the first operand for NaN, same as the SSE2
+       instructions return the second */
+    const v128_t zero = wasm_f32x4_splat(0.0f);
+    const v128_t one = wasm_f32x4_splat(1.0f);
+    const v128_t scale = wasm_f32x4_splat(255.0f);
+    const v128_t half = wasm_f32x4_splat(0.5f);
+    v128_t v[4];
+    for(; i + 16 <= count; i += 16) {
+        for(std::size_t j = 0; j != 4; ++j) {
+            const v128_t clamped = wasm_f32x4_pmin(one, wasm_f32x4_pmax(zero, wasm_v128_load(in + i + j*4)));
+            v[j] = wasm_i32x4_trunc_sat_f32x4(wasm_f32x4_add(wasm_f32x4_mul(clamped, scale), half));
+        }
+        wasm_v128_store(out + i,
+            wasm_u8x16_narrow_i16x8(wasm_i16x8_narrow_i32x4(v[0], v[1]), wasm_i16x8_narrow_i32x4(v[2], v[3])));
+    }
+    #endif
+
+    for(; i != count; ++i) out[i] = packUnsignedByte(in[i]);
+}
+
+}}}
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef Magnum_TextureTools_Implementation_srgb_h
+#define Magnum_TextureTools_Implementation_srgb_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cmath>
+#include <cstring>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/PixelFormat.h"
+
+namespace Magnum { namespace TextureTools { namespace Implementation {
+
+/* Approximations of std::log2() and std::exp2() with relative error around
+   1.0e-7 for positive normal inputs. Unlike std::pow() these don't touch
+   errno and have no branches, so loops calling them get vectorized. */
+inline Float fastLog2(const Float x) {
+    UnsignedInt bits;
+    std::memcpy(&bits, &x, sizeof(Float));
+
+    /* Split into exponent and mantissa in [sqrt(1/2), sqrt(2)) */
+    Int exponent = Int((bits >> 23) & 0xff) - 127;
+    bits = (bits & 0x007fffff) | 0x3f800000;
+    Float mantissa;
+    std::memcpy(&mantissa, &bits, sizeof(Float));
+    const bool above = mantissa > 1.41421356f;
+    mantissa = above ? mantissa*0.5f : mantissa;
+    exponent += above ? 1 : 0;
+
+    /* log2(m) = 2/ln(2)*atanh(s) for s = (m - 1)/(m + 1), |s| < 0.172 */
+    const Float s = (mantissa - 1.0f)/(mantissa + 1.0f);
+    const Float s2 = s*s;
+    return Float(exponent) + s*(2.88539008f + s2*(0.961796694f + s2*(0.577078016f + s2*0.412198583f)));
+}
+
+/* Expects the input in (-126, 127) */
+inline Float fastExp2(const Float x) {
+    /* Split into integer part and fraction in [-0.5, 0.5], truncation
+       rounds to nearest as the value is offset to be positive */
+    const Int integer = Int(x + 128.5f) - 128;
+    const Float f = x - Float(integer);
+    const Float fraction = 1.0f + f*(0.693147181f + f*(0.240226507f + f*(0.0555041087f + f*(0.00961812911f + f*(0.00133335581f + f*0.000154035304f)))));
+
+    const UnsignedInt bits = UnsignedInt(integer + 127) << 23;
+    Float scale;
+    std::memcpy(&scale, &bits, sizeof(Float));
+    return fraction*scale;
+}
+
+/* Exact conversion, used for building lookup tables */
+inline Float srgbToLinear(const Float value) {
+    return value <= 0.04045f ? value/12.92f : std::pow((value + 0.055f)/1.055f, 2.4f);
+}
+
+/* Vectorizable conversions for floating-point data. Values above one are
+   extrapolated, values below zero are mapped to zero. */
+inline Float fastSrgbToLinear(Float value) {
+    value = value > 0.0f ? value : 0.0f;
+    const Float curve = fastExp2(2.4f*fastLog2((value + 0.055f)/1.055f));
+    return value <= 0.04045f ? value/12.92f : curve;
+}
+
+inline Float fastLinearToSrgb(Float value) {
+    value = value > 0.0f ? value : 0.0f;
+    const Float curve = 1.055f*fastExp2(fastLog2(value > 1.0e-30f ? value : 1.0e-30f)/2.4f) - 0.055f;
+    return value <= 0.0031308f ? value*12.92f : curve;
+}
+
+/* Conversions for 8-bit data */
+struct SrgbTable {
+    explicit SrgbTable() {
+        for(std::size_t i = 0; i != 256; ++i)
+            toLinear[i] = srgbToLinear(Float(i)/255.0f);
+    }
+
+    Float toLinear[256];
+};
+
+inline UnsignedByte linearToSrgb8(Float value) {
+    value = fastLinearToSrgb(value);
+    return UnsignedByte((value < 1.0f ? value : 1.0f)*255.0f + 0.5f);
+}
+
+/* Whether the last channel of given format is alpha, which is always stored
+   linearly */
+inline bool hasAlpha(const PixelFormat format) {
+    return format == PixelFormat::RGBA
+        #ifndef MAGNUM_TARGET_WEBGL
+        || format == PixelFormat::BGRA
+        #endif
+        #ifdef MAGNUM_TARGET_GLES2
+        || format == PixelFormat::LuminanceAlpha
+        #endif
+        ;
+}
+
+}}}
+
+#endif
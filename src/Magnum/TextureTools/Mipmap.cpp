@@ -0,0 +1,260 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Mipmap.h"
+
+#include <algorithm>
+#include <cstring>
+#include <tuple>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/TextureTools/Implementation/parallelFor.h"
+#include "Magnum/TextureTools/Implementation/srgb.h"
+
+namespace Magnum { namespace TextureTools {
+
+namespace {
+
+Float sinc(Float x) {
+    x *= Constants::pi();
+    return std::abs(x) < 1.0e-4f ? 1.0f : std::sin(x)/x;
+}
+
+/* Zeroth-order modified Bessel function of the first kind */
+Float bessel0(const Float x) {
+    const Float quarterSquared = x*x*0.25f;
+    Float sum = 1.0f, term = 1.0f;
+    for(Int k = 1; k != 32 && term > sum*1.0e-8f; ++k) {
+        term *= quarterSquared/Float(k*k);
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr Float KaiserAlpha = 4.0f;
+
+/* Half-width of the filter, in destination pixels */
+Float filterRadius(const MipmapFilter filter) {
+    switch(filter) {
+        case MipmapFilter::Box: return 0.5f;
+        case MipmapFilter::Lanczos:
+        case MipmapFilter::Kaiser: return 3.0f;
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+/* Filter value at given distance, in destination pixels */
+Float filterValue(const MipmapFilter filter, const Float t) {
+    const Float distance = std::abs(t);
+    switch(filter) {
+        case MipmapFilter::Box:
+            /* Pixels exactly on the boundary are shared between two
+               destination pixels */
+            return distance < 0.5f ? 1.0f : distance == 0.5f ? 0.5f : 0.0f;
+        case MipmapFilter::Lanczos:
+            return distance < 3.0f ? sinc(t)*sinc(t/3.0f) : 0.0f;
+        case MipmapFilter::Kaiser: {
+            if(distance >= 3.0f) return 0.0f;
+            const Float x = t/3.0f;
+            return sinc(t)*bessel0(KaiserAlpha*std::sqrt(1.0f - x*x))/bessel0(KaiserAlpha);
+        }
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+/* Source pixel indices and weights contributing to each destination pixel,
+   taps of destination pixel i are in [offsets[i], offsets[i + 1]) */
+struct Kernel {
+    std::vector<std::size_t> offsets;
+    std::vector<std::size_t> indices;
+    std::vector<Float> weights;
+};
+
+Kernel kernel(const MipmapFilter filter, const Int sourceSize, const Int destinationSize) {
+    Kernel out;
+    out.offsets.reserve(destinationSize + 1);
+    out.offsets.push_back(0);
+
+    const Float scale = Float(sourceSize)/Float(destinationSize);
+    const Float radius = filterRadius(filter)*scale;
+    for(Int i = 0; i != destinationSize; ++i) {
+        const Float center = (Float(i) + 0.5f)*scale;
+        const std::size_t first = out.weights.size();
+        Float sum = 0.0f;
+        for(Int j = Int(std::floor(center - radius)), end = Int(std::ceil(center + radius)); j <= end; ++j) {
+            const Float weight = filterValue(filter, (Float(j) + 0.5f - center)/scale);
+            if(weight == 0.0f) continue;
+
+            /* Clamp to edge */
+            out.indices.push_back(Math::clamp(j, 0, sourceSize - 1));
+            out.weights.push_back(weight);
+            sum += weight;
+        }
+
+        for(std::size_t j = first; j != out.weights.size(); ++j)
+            out.weights[j] /= sum;
+        out.offsets.push_back(out.weights.size());
+    }
+
+    return out;
+}
+
+/* Horizontal pass over one row, the channel count is a template parameter
+   so the innermost loop gets unrolled */
+template<std::size_t channels> void filterRow(const Kernel& kernel, const Float* const source, Float* const destination, const std::size_t destinationWidth) {
+    for(std::size_t x = 0; x != destinationWidth; ++x) {
+        Float sum[channels]{};
+        for(std::size_t i = kernel.offsets[x]; i != kernel.offsets[x + 1]; ++i) {
+            const Float* const pixel = source + kernel.indices[i]*channels;
+            const Float weight = kernel.weights[i];
+            for(std::size_t c = 0; c != channels; ++c)
+                sum[c] += weight*pixel[c];
+        }
+        for(std::size_t c = 0; c != channels; ++c)
+            destination[x*channels + c] = sum[c];
+    }
+}
+
+void filterRow(const std::size_t channels, const Kernel& kernel, const Float* const source, Float* const destination, const std::size_t destinationWidth) {
+    switch(channels) {
+        case 1: return filterRow<1>(kernel, source, destination, destinationWidth);
+        case 2: return filterRow<2>(kernel, source, destination, destinationWidth);
+        case 3: return filterRow<3>(kernel, source, destination, destinationWidth);
+        case 4: return filterRow<4>(kernel, source, destination, destinationWidth);
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+}
+
+std::vector<Image2D> generateMipmaps(const ImageView2D& image, const MipmapFilter filter, const MipmapFlags flags, UnsignedInt threadCount) {
+    CORRADE_ASSERT(image.type() == PixelType::UnsignedByte || image.type() == PixelType::Float,
+        "TextureTools::generateMipmaps(): expected" << PixelType::UnsignedByte << "or" << PixelType::Float << "but got" << image.type(), {});
+
+    threadCount = Implementation::threadCountOrDefault(threadCount);
+
+    std::vector<Image2D> levels;
+    if(!image.size().product()) return levels;
+
+    const bool isFloat = image.type() == PixelType::Float;
+    const std::size_t pixelSize = image.pixelSize();
+    const std::size_t channels = isFloat ? pixelSize/4 : pixelSize;
+    CORRADE_ASSERT(channels >= 1 && channels <= 4,
+        "TextureTools::generateMipmaps(): unsupported format" << image.format(), {});
+
+    /* Channels converted from/to sRGB, alpha is always linear */
+    const bool srgb = !isFloat && (flags & MipmapFlag::Srgb);
+    const std::size_t colorChannels = srgb ? channels - (Implementation::hasAlpha(image.format()) ? 1 : 0) : 0;
+
+    /* Lookup table for conversion of 8-bit values to linear floats */
+    const Implementation::SrgbTable srgbTable;
+
+    /* Convert the base level to floats */
+    Vector2i size = image.size();
+    Containers::Array<Float> current{std::size_t(size.product())*channels};
+    {
+        std::size_t dataPixelSize;
+        Math::Vector2<std::size_t> dataOffset, dataSize;
+        std::tie(dataOffset, dataSize, dataPixelSize) = image.dataProperties();
+        const std::size_t rowSize = size.x()*channels;
+        Implementation::parallelFor(size.y(), threadCount, [&](const std::size_t begin, const std::size_t end) {
+            for(std::size_t y = begin; y != end; ++y) {
+                const char* const row = image.data<char>() + dataOffset.sum() + y*dataSize.x();
+                Float* const out = current + y*rowSize;
+                if(isFloat) {
+                    std::memcpy(out, row, rowSize*sizeof(Float));
+                    continue;
+                }
+
+                for(std::size_t i = 0; i != rowSize; ++i) {
+                    const UnsignedByte value = row[i];
+                    out[i] = i % channels < colorChannels ? srgbTable.toLinear[value] : Float(value)/255.0f;
+                }
+            }
+        });
+    }
+
+    while(size != Vector2i{1}) {
+        const Vector2i nextSize = Math::max(size/2, Vector2i{1});
+        const Kernel horizontal = kernel(filter, size.x(), nextSize.x());
+        const Kernel vertical = kernel(filter, size.y(), nextSize.y());
+        const std::size_t rowSize = nextSize.x()*channels;
+
+        /* Horizontal pass over all source rows */
+        Containers::Array<Float> filteredRows{std::size_t(size.y())*rowSize};
+        Implementation::parallelFor(size.y(), threadCount, [&](const std::size_t begin, const std::size_t end) {
+            for(std::size_t y = begin; y != end; ++y)
+                filterRow(channels, horizontal, current + y*size.x()*channels, filteredRows + y*rowSize, nextSize.x());
+        });
+
+        /* Vertical pass, accumulating whole rows at once, and conversion to
+           output. Rows aligned to four bytes to match default pixel
+           storage. */
+        const std::size_t outputStride = (nextSize.x()*pixelSize + 3)/4*4;
+        Containers::Array<char> data{Containers::ValueInit, outputStride*nextSize.y()};
+        Containers::Array<Float> next{std::size_t(nextSize.product())*channels};
+        Implementation::parallelFor(nextSize.y(), threadCount, [&](const std::size_t begin, const std::size_t end) {
+            for(std::size_t y = begin; y != end; ++y) {
+                Float* const out = next + y*rowSize;
+                std::fill_n(out, rowSize, 0.0f);
+                for(std::size_t i = vertical.offsets[y]; i != vertical.offsets[y + 1]; ++i) {
+                    const Float* const row = filteredRows + vertical.indices[i]*rowSize;
+                    const Float weight = vertical.weights[i];
+                    for(std::size_t x = 0; x != rowSize; ++x)
+                        out[x] += weight*row[x];
+                }
+
+                char* const outputRow = data + y*outputStride;
+                if(isFloat) {
+                    std::memcpy(outputRow, out, rowSize*sizeof(Float));
+                    continue;
+                }
+
+                for(std::size_t x = 0; x != rowSize; ++x) {
+                    const Float value = out[x];
+                    outputRow[x] = char(x % channels < colorChannels ?
+                        Implementation::linearToSrgb8(value) :
+                        UnsignedByte(Math::clamp(value, 0.0f, 1.0f)*255.0f + 0.5f));
+                }
+            }
+        });
+
+        levels.emplace_back(image.format(), image.type(), nextSize, std::move(data));
+        current = std::move(next);
+        size = nextSize;
+    }
+
+    return levels;
+}
+
+}}
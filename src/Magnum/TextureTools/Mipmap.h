@@ -0,0 +1,140 @@
+#ifndef Magnum_TextureTools_Mipmap_h
+#define Magnum_TextureTools_Mipmap_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::TextureTools::generateMipmaps(), enum @ref Magnum::TextureTools::MipmapFilter, @ref Magnum::TextureTools::MipmapFlag, enum set @ref Magnum::TextureTools::MipmapFlags
+ */
+
+#include <vector>
+#include <Corrade/Containers/EnumSet.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/TextureTools/visibility.h"
+
+namespace Magnum { namespace TextureTools {
+
+/**
+@brief Mipmap downsampling filter
+
+@see @ref generateMipmaps()
+*/
+enum class MipmapFilter: UnsignedByte {
+    /**
+     * Box filter, averaging 2x2 pixels for power-of-two sizes. The fastest,
+     * but blurs the result and causes aliasing for high-frequency content.
+     * Equivalent to what most drivers do in
+     * @ref Texture::generateMipmap().
+     */
+    Box,
+
+    /**
+     * Three-lobed Lanczos filter. Keeps the result sharp, but can cause
+     * ringing around hard edges.
+     */
+    Lanczos,
+
+    /**
+     * Kaiser-windowed sinc filter with @f$ \alpha = 4 @f$ and width of three
+     * pixels. Slightly softer than @ref MipmapFilter::Lanczos with less
+     * ringing, a good default for most textures.
+     */
+    Kaiser
+};
+
+/**
+@brief Mipmap generation flag
+
+@see @ref MipmapFlags, @ref generateMipmaps()
+*/
+enum class MipmapFlag: UnsignedByte {
+    /**
+     * Treat color channels of @ref PixelType::UnsignedByte images as sRGB.
+     * The pixels are converted to linear space before filtering and back
+     * after, which keeps the perceived brightness of the levels consistent.
+     * The alpha channel is always filtered linearly. Ignored for
+     * floating-point images, which are expected to be linear already ---
+     * convert sRGB floating-point images using @ref srgbToLinear() first.
+     * The conversion is the same as in @ref srgbToLinear() and
+     * @ref linearToSrgb().
+     */
+    Srgb = 1 << 0
+};
+
+/**
+@brief Mipmap generation flags
+
+@see @ref generateMipmaps()
+*/
+typedef Containers::EnumSet<MipmapFlag> MipmapFlags;
+
+CORRADE_ENUMSET_OPERATORS(MipmapFlags)
+
+/**
+@brief Generate mipmaps on the CPU
+@param image        Base level
+@param filter       Downsampling filter
+@param flags        Flags
+@param threadCount  Count of worker threads. If `0`, the count is
+    taken from @ref std::thread::hardware_concurrency().
+@return Levels from the first one (half the size of @p image) down to 1x1
+
+Unlike @ref Texture::generateMipmap(), which relies on the driver, the result
+is the same on all platforms and is filtered with a proper separable filter,
+optionally in linear space. The image is expected to have
+@ref PixelType::UnsignedByte or @ref PixelType::Float type, any
+non-integer color format is supported. The returned levels have the same
+format and type as @p image with default pixel storage, so they can be
+directly passed to @ref Texture::setSubImage() or to a block compression
+encoder such as @ref Trade::BlockCompressionImageConverter "BlockCompressionImageConverter".
+To generate mipmaps for @ref Trade::ImageData2D, pass it through its
+@ref ImageView2D conversion operator.
+
+Each level size is half of the previous level rounded down, but at least one
+pixel. Non-power-of-two sizes are handled by scaling the filter footprint, so
+no pixels are skipped. The levels are calculated from each other in a
+floating-point linear representation and quantized only on output, which
+avoids accumulation of rounding errors. The rows of each level are split
+between @p threadCount threads, the kernels process whole rows at once to
+make use of compiler auto-vectorization. On Emscripten the function is always
+single-threaded.
+
+Example usage:
+@code
+Image2D image = ...;
+std::vector<Image2D> levels = TextureTools::generateMipmaps(image, TextureTools::MipmapFilter::Kaiser, TextureTools::MipmapFlag::Srgb);
+
+texture.setStorage(levels.size() + 1, TextureFormat::SRGB8Alpha8, image.size())
+    .setSubImage(0, {}, image);
+for(std::size_t i = 0; i != levels.size(); ++i)
+    texture.setSubImage(i + 1, {}, levels[i]);
+@endcode
+*/
+std::vector<Image2D> MAGNUM_TEXTURETOOLS_EXPORT generateMipmaps(const ImageView2D& image, MipmapFilter filter = MipmapFilter::Kaiser, MipmapFlags flags = {}, UnsignedInt threadCount = 0);
+
+}}
+
+#endif
@@ -0,0 +1,247 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "PixelConversion.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <tuple>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/TextureTools/Implementation/parallelFor.h"
+#include "Magnum/TextureTools/Implementation/pixelConversion.h"
+
+namespace Magnum { namespace TextureTools {
+
+namespace {
+
+/* Channel layout of a pixel format */
+struct FormatInfo {
+    std::size_t channels;
+    /* Which of the red, green, blue and alpha components each channel is */
+    std::size_t components[4];
+    bool luminance;
+};
+
+bool formatInfo(const PixelFormat format, FormatInfo& info) {
+    switch(format) {
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        case PixelFormat::Red:
+            info = {1, {0}, false};
+            return true;
+        case PixelFormat::RG:
+            info = {2, {0, 1}, false};
+            return true;
+        #endif
+        #ifdef MAGNUM_TARGET_GLES2
+        case PixelFormat::Luminance:
+            info = {1, {0}, true};
+            return true;
+        case PixelFormat::LuminanceAlpha:
+            info = {2, {0, 3}, true};
+            return true;
+        #endif
+        case PixelFormat::RGB:
+            info = {3, {0, 1, 2}, false};
+            return true;
+        case PixelFormat::RGBA:
+            info = {4, {0, 1, 2, 3}, false};
+            return true;
+        #ifndef MAGNUM_TARGET_GLES
+        case PixelFormat::BGR:
+            info = {3, {2, 1, 0}, false};
+            return true;
+        #endif
+        #ifndef MAGNUM_TARGET_WEBGL
+        case PixelFormat::BGRA:
+            info = {4, {2, 1, 0, 3}, false};
+            return true;
+        #endif
+        default: return false;
+    }
+}
+
+std::size_t typeSize(const PixelType type) {
+    switch(type) {
+        case PixelType::UnsignedByte: return 1;
+        case PixelType::UnsignedShort: return 2;
+        case PixelType::Float: return 4;
+        default: return 0;
+    }
+}
+
+bool sameLayout(const FormatInfo& a, const FormatInfo& b) {
+    return a.channels == b.channels && a.luminance == b.luminance &&
+        std::equal(a.components, a.components + a.channels, b.components);
+}
+
+/* Whether the first three channels are color in RGB or BGR order */
+bool isRgb(const FormatInfo& info) {
+    return info.channels >= 3 && info.components[1] == 1 &&
+        ((info.components[0] == 0 && info.components[2] == 2) ||
+         (info.components[0] == 2 && info.components[2] == 0));
+}
+
+inline Float unpack(const UnsignedByte value) { return value*(1.0f/255.0f); }
+inline Float unpack(const UnsignedShort value) { return value*(1.0f/65535.0f); }
+inline Float unpack(const Float value) { return value; }
+
+template<class T> T pack(Float value);
+template<> inline UnsignedByte pack<UnsignedByte>(const Float value) {
+    return Implementation::packUnsignedByte(value);
+}
+template<> inline UnsignedShort pack<UnsignedShort>(const Float value) {
+    return UnsignedShort((value > 0.0f ? (value < 1.0f ? value : 1.0f) : 0.0f)*65535.0f + 0.5f);
+}
+template<> inline Float pack<Float>(const Float value) { return value; }
+
+/* Generic per-pixel conversion through normalized floats */
+template<class In, class Out> void convertRow(const char* const input, char* const output, const std::size_t width, const FormatInfo& in, const FormatInfo& out) {
+    const In* src = reinterpret_cast<const In*>(input);
+    Out* dst = reinterpret_cast<Out*>(output);
+    for(std::size_t x = 0; x != width; ++x, src += in.channels, dst += out.channels) {
+        Float rgba[4]{0.0f, 0.0f, 0.0f, 1.0f};
+        for(std::size_t c = 0; c != in.channels; ++c)
+            rgba[in.components[c]] = unpack(src[c]);
+        if(in.luminance) rgba[1] = rgba[2] = rgba[0];
+        for(std::size_t c = 0; c != out.channels; ++c)
+            dst[c] = pack<Out>(rgba[out.components[c]]);
+    }
+}
+
+template<class In> void convertRow(const PixelType outputType, const char* const input, char* const output, const std::size_t width, const FormatInfo& in, const FormatInfo& out) {
+    switch(outputType) {
+        case PixelType::UnsignedByte: return convertRow<In, UnsignedByte>(input, output, width, in, out);
+        case PixelType::UnsignedShort: return convertRow<In, UnsignedShort>(input, output, width, in, out);
+        case PixelType::Float: return convertRow<In, Float>(input, output, width, in, out);
+        default: CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+    }
+}
+
+}
+
+Image2D convertPixels(const ImageView2D& image, const PixelFormat format, const PixelType type, UnsignedInt threadCount) {
+    FormatInfo in, out;
+    CORRADE_ASSERT(formatInfo(image.format(), in) && typeSize(image.type()),
+        "TextureTools::convertPixels(): unsupported input format" << image.format() << image.type(), (Image2D{format, type}));
+    CORRADE_ASSERT(formatInfo(format, out) && typeSize(type),
+        "TextureTools::convertPixels(): unsupported output format" << format << type, (Image2D{format, type}));
+
+    const Vector2i size = image.size();
+    const std::size_t width = size.x();
+    const std::size_t outputStride = (width*out.channels*typeSize(type) + 3)/4*4;
+    Containers::Array<char> data{Containers::ValueInit, outputStride*size.y()};
+    if(!size.product()) return Image2D{format, type, size, std::move(data)};
+
+    /* Pick a row function, specialized ones first */
+    std::function<void(const char*, char*)> row;
+    const PixelType inputType = image.type();
+    const bool swap = isRgb(in) && isRgb(out) && in.components[0] != out.components[0];
+    if(inputType == type && sameLayout(in, out)) {
+        const std::size_t rowSize = width*in.channels*typeSize(type);
+        row = [rowSize](const char* input, char* output) {
+            std::memcpy(output, input, rowSize);
+        };
+    } else if(inputType == PixelType::UnsignedByte && type == PixelType::UnsignedByte && swap && in.channels == out.channels) {
+        if(in.channels == 3) row = [width](const char* input, char* output) {
+            Implementation::bgrSwizzle<3>(input, output, width);
+        };
+        else row = [width](const char* input, char* output) {
+            Implementation::bgrSwizzle<4>(input, output, width);
+        };
+    } else if(inputType == PixelType::UnsignedByte && type == PixelType::UnsignedByte && isRgb(in) && isRgb(out) && in.channels == 3 && out.channels == 4) {
+        if(swap) row = [width](const char* input, char* output) {
+            Implementation::expandAlpha<true>(reinterpret_cast<const UnsignedByte*>(input), reinterpret_cast<UnsignedByte*>(output), width);
+        };
+        else row = [width](const char* input, char* output) {
+            Implementation::expandAlpha<false>(reinterpret_cast<const UnsignedByte*>(input), reinterpret_cast<UnsignedByte*>(output), width);
+        };
+    } else if(inputType == PixelType::UnsignedByte && type == PixelType::Float && sameLayout(in, out)) {
+        const std::size_t count = width*in.channels;
+        row = [count](const char* input, char* output) {
+            Implementation::unpackUnsignedByte(reinterpret_cast<const UnsignedByte*>(input), reinterpret_cast<Float*>(output), count);
+        };
+    } else if(inputType == PixelType::Float && type == PixelType::UnsignedByte && sameLayout(in, out)) {
+        const std::size_t count = width*in.channels;
+        row = [count](const char* input, char* output) {
+            Implementation::packUnsignedByte(reinterpret_cast<const Float*>(input), reinterpret_cast<UnsignedByte*>(output), count);
+        };
+    } else row = [&, width, type](const char* input, char* output) {
+        switch(inputType) {
+            case PixelType::UnsignedByte: return convertRow<UnsignedByte>(type, input, output, width, in, out);
+            case PixelType::UnsignedShort: return convertRow<UnsignedShort>(type, input, output, width, in, out);
+            case PixelType::Float: return convertRow<Float>(type, input, output, width, in, out);
+            default: CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+        }
+    };
+
+    std::size_t dataPixelSize;
+    Math::Vector2<std::size_t> dataOffset, dataSize;
+    std::tie(dataOffset, dataSize, dataPixelSize) = image.dataProperties();
+    const char* const input = image.data<char>() + dataOffset.sum();
+    Implementation::parallelFor(size.y(), Implementation::threadCountOrDefault(threadCount), [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t y = begin; y != end; ++y)
+            row(input + y*dataSize.x(), data + y*outputStride);
+    });
+
+    return Image2D{format, type, size, std::move(data)};
+}
+
+Image2D flipY(const ImageView2D& image) {
+    const Vector2i size = image.size();
+    const std::size_t rowSize = size.x()*image.pixelSize();
+    const std::size_t outputStride = (rowSize + 3)/4*4;
+    Containers::Array<char> data{Containers::ValueInit, outputStride*size.y()};
+
+    if(size.product()) {
+        std::size_t dataPixelSize;
+        Math::Vector2<std::size_t> dataOffset, dataSize;
+        std::tie(dataOffset, dataSize, dataPixelSize) = image.dataProperties();
+        const char* const input = image.data<char>() + dataOffset.sum();
+        for(std::size_t y = 0, height = size.y(); y != height; ++y)
+            std::memcpy(data + (height - y - 1)*outputStride, input + y*dataSize.x(), rowSize);
+    }
+
+    return Image2D{image.format(), image.type(), size, std::move(data)};
+}
+
+void flipYInPlace(Image2D& image) {
+    const Vector2i size = image.size();
+    if(!size.product()) return;
+
+    std::size_t dataPixelSize;
+    Math::Vector2<std::size_t> dataOffset, dataSize;
+    std::tie(dataOffset, dataSize, dataPixelSize) = image.dataProperties();
+    const std::size_t rowSize = size.x()*image.pixelSize();
+    char* const data = image.data<char>() + dataOffset.sum();
+    for(std::size_t top = 0, bottom = size.y() - 1; top < bottom; ++top, --bottom)
+        std::swap_ranges(data + top*dataSize.x(), data + top*dataSize.x() + rowSize, data + bottom*dataSize.x());
+}
+
+}}
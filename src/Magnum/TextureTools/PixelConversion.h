@@ -0,0 +1,92 @@
+#ifndef Magnum_TextureTools_PixelConversion_h
+#define Magnum_TextureTools_PixelConversion_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::TextureTools::convertPixels(), @ref Magnum::TextureTools::flipY()
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/TextureTools/visibility.h"
+
+namespace Magnum { namespace TextureTools {
+
+/**
+@brief Convert an image to a different pixel format and type
+@param image        Input image
+@param format       Output format
+@param type         Output type
+@param threadCount  Count of worker threads. If `0`, the count is
+    taken from @ref std::thread::hardware_concurrency().
+@return Image in @p format and @p type with default pixel storage
+
+Supported formats are @ref PixelFormat::Red, @ref PixelFormat::RG,
+@ref PixelFormat::RGB, @ref PixelFormat::RGBA, @ref PixelFormat::BGR,
+@ref PixelFormat::BGRA and, on OpenGL ES 2.0, @ref PixelFormat::Luminance
+and @ref PixelFormat::LuminanceAlpha. Supported types are
+@ref PixelType::UnsignedByte, @ref PixelType::UnsignedShort and
+@ref PixelType::Float, integer types are treated as normalized. When
+converting to an integer type, the values are clamped to @f$ [0, 1] @f$ and
+rounded to nearest.
+
+Channels missing in the input are set to zero, alpha to one. Luminance is
+expanded to all three color channels, conversion to luminance takes the red
+channel. Channels missing in the output are dropped.
+
+Channel swizzles between RGB(A) and BGR(A), expansion of 8-bit RGB to RGBA
+and conversion between 8-bit and floating-point types in the same format are
+vectorized using SSE2, SSSE3, NEON or WebAssembly SIMD128 if the compiler
+targets them, other
+combinations use a generic per-pixel loop. Rows are split between
+@p threadCount threads, on Emscripten the function is always single-threaded.
+@see @ref flipY(), @ref srgbToLinear()
+*/
+Image2D MAGNUM_TEXTURETOOLS_EXPORT convertPixels(const ImageView2D& image, PixelFormat format, PixelType type, UnsignedInt threadCount = 0);
+
+/**
+@brief Flip an image vertically
+@param image        Input image
+@return Image with the row order reversed and default pixel storage
+
+Useful for converting between the bottom-up row order used by OpenGL and the
+top-down order of most image file formats. Works with any pixel format and
+type.
+@see @ref flipYInPlace(), @ref convertPixels()
+*/
+Image2D MAGNUM_TEXTURETOOLS_EXPORT flipY(const ImageView2D& image);
+
+/**
+@brief Flip an image vertically in-place
+
+Same as @ref flipY(), but operates directly on the image data without
+additional allocation, keeping the pixel storage.
+*/
+void MAGNUM_TEXTURETOOLS_EXPORT flipYInPlace(Image2D& image);
+
+}}
+
+#endif
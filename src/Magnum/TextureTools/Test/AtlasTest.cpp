@@ -26,6 +26,9 @@
 #include <sstream>
 #include <Corrade/TestSuite/Tester.h>
 
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
 #include "Magnum/Math/Range.h"
 #include "Magnum/TextureTools/Atlas.h"
 
@@ -38,13 +41,41 @@ struct AtlasTest: TestSuite::Tester {
     void createPadding();
     void createEmpty();
     void createTooSmall();
+    void createDense();
+
+    void packerAdd();
+    void packerAddTooLarge();
+    void packerClear();
+
+    void array();
+    void arrayTooSmall();
+
+    void textureCoordinateTransformation();
+
+    void image();
+    void imagePadding();
+    void imageArray();
 };
 
 AtlasTest::AtlasTest() {
     addTests({&AtlasTest::create,
               &AtlasTest::createPadding,
               &AtlasTest::createEmpty,
-              &AtlasTest::createTooSmall});
+              &AtlasTest::createTooSmall,
+              &AtlasTest::createDense,
+
+              &AtlasTest::packerAdd,
+              &AtlasTest::packerAddTooLarge,
+              &AtlasTest::packerClear,
+
+              &AtlasTest::array,
+              &AtlasTest::arrayTooSmall,
+
+              &AtlasTest::textureCoordinateTransformation,
+
+              &AtlasTest::image,
+              &AtlasTest::imagePadding,
+              &AtlasTest::imageArray});
 }
 
 void AtlasTest::create() {
@@ -54,11 +85,12 @@ void AtlasTest::create() {
         {23, 25}
     });
 
+    /* Placed from the tallest */
     CORRADE_COMPARE(atlas.size(), 3);
     CORRADE_COMPARE(atlas, (std::vector<Range2Di>{
-        Range2Di::fromSize({0, 0}, {12, 18}),
-        Range2Di::fromSize({32, 0}, {32, 15}),
-        Range2Di::fromSize({0, 25}, {23, 25})}));
+        Range2Di::fromSize({23, 0}, {12, 18}),
+        Range2Di::fromSize({23, 18}, {32, 15}),
+        Range2Di::fromSize({0, 0}, {23, 25})}));
 }
 
 void AtlasTest::createPadding() {
@@ -70,9 +102,9 @@ void AtlasTest::createPadding() {
 
     CORRADE_COMPARE(atlas.size(), 3);
     CORRADE_COMPARE(atlas, (std::vector<Range2Di>{
-        Range2Di::fromSize({2, 1}, {8, 16}),
-        Range2Di::fromSize({34, 1}, {28, 13}),
-        Range2Di::fromSize({2, 26}, {19, 23})}));
+        Range2Di::fromSize({25, 1}, {8, 16}),
+        Range2Di::fromSize({25, 19}, {28, 13}),
+        Range2Di::fromSize({2, 1}, {19, 23})}));
 }
 
 void AtlasTest::createEmpty() {
@@ -88,9 +120,178 @@ void AtlasTest::createTooSmall() {
         {8, 16},
         {21, 13},
         {19, 29}
-    }, {2, 1});
+    }, {2, 2});
     CORRADE_VERIFY(atlas.empty());
-    CORRADE_COMPARE(o.str(), "TextureTools::atlas(): requested atlas size Vector(64, 32) is too small to fit 3 Vector(25, 31) textures. Generated atlas will be empty.\n");
+    CORRADE_COMPARE(o.str(), "TextureTools::atlas(): requested atlas size Vector(64, 32) is too small to fit 3 textures with padding Vector(2, 2). Generated atlas will be empty.\n");
+}
+
+void AtlasTest::createDense() {
+    /* One large and many small textures, uniform grid of the largest size
+       would fit only one */
+    std::vector<Vector2i> sizes{{48, 48}};
+    for(Int i = 0; i != 24; ++i) sizes.push_back({6 + i%3, 7});
+
+    std::vector<Range2Di> atlas = TextureTools::atlas({64, 64}, sizes);
+    CORRADE_COMPARE(atlas.size(), sizes.size());
+
+    for(std::size_t i = 0; i != atlas.size(); ++i) {
+        CORRADE_COMPARE(atlas[i].size(), sizes[i]);
+        CORRADE_VERIFY((atlas[i].min() >= Vector2i{0}).all());
+        CORRADE_VERIFY((atlas[i].max() <= Vector2i{64}).all());
+        for(std::size_t j = 0; j != i; ++j)
+            CORRADE_VERIFY(!(atlas[i].min() < atlas[j].max()).all() || !(atlas[j].min() < atlas[i].max()).all());
+    }
+}
+
+void AtlasTest::packerAdd() {
+    AtlasPacker packer{{64, 64}};
+    CORRADE_COMPARE(packer.size(), (Vector2i{64, 64}));
+    CORRADE_COMPARE(packer.padding(), Vector2i{});
+
+    CORRADE_COMPARE(packer.add({{23, 25}}), std::vector<Range2Di>{
+        Range2Di::fromSize({0, 0}, {23, 25})});
+
+    /* Existing textures are kept in place */
+    CORRADE_COMPARE(packer.add({{12, 18}, {32, 15}}), (std::vector<Range2Di>{
+        Range2Di::fromSize({23, 0}, {12, 18}),
+        Range2Di::fromSize({23, 18}, {32, 15})}));
+
+    /* On the lowest part of the skyline it fits on */
+    CORRADE_COMPARE(packer.add({{20, 10}}), std::vector<Range2Di>{
+        Range2Di::fromSize({0, 25}, {20, 10})});
+}
+
+void AtlasTest::packerAddTooLarge() {
+    AtlasPacker packer{{64, 64}, {1, 1}};
+    CORRADE_COMPARE(packer.add({{30, 30}}), std::vector<Range2Di>{
+        Range2Di::fromSize({1, 1}, {30, 30})});
+
+    /* Doesn't fit, nothing is added */
+    CORRADE_VERIFY(packer.add({{30, 30}, {30, 30}, {30, 30}, {30, 30}}).empty());
+
+    CORRADE_COMPARE(packer.add({{30, 30}}), std::vector<Range2Di>{
+        Range2Di::fromSize({33, 1}, {30, 30})});
+}
+
+void AtlasTest::packerClear() {
+    AtlasPacker packer{{64, 64}};
+    CORRADE_COMPARE(packer.add({{64, 64}}), std::vector<Range2Di>{
+        Range2Di::fromSize({}, {64, 64})});
+    CORRADE_VERIFY(packer.add({{1, 1}}).empty());
+
+    packer.clear();
+    CORRADE_COMPARE(packer.add({{1, 1}}), std::vector<Range2Di>{
+        Range2Di::fromSize({}, {1, 1})});
+}
+
+void AtlasTest::array() {
+    std::vector<Range3Di> atlas = TextureTools::atlasArray({32, 32}, {
+        {20, 20},
+        {16, 30},
+        {10, 10},
+        {20, 20}
+    });
+
+    /* Placed from the tallest, each into the first layer it fits in. The
+       smallest one goes back to the first layer. */
+    CORRADE_COMPARE(atlas, (std::vector<Range3Di>{
+        Range3Di::fromSize({0, 0, 1}, {20, 20, 1}),
+        Range3Di::fromSize({0, 0, 0}, {16, 30, 1}),
+        Range3Di::fromSize({16, 0, 0}, {10, 10, 1}),
+        Range3Di::fromSize({0, 0, 2}, {20, 20, 1})}));
+}
+
+void AtlasTest::arrayTooSmall() {
+    std::ostringstream o;
+    Error redirectError{&o};
+
+    std::vector<Range3Di> atlas = TextureTools::atlasArray({32, 32}, {
+        {8, 16},
+        {30, 13}
+    }, {2, 2});
+    CORRADE_VERIFY(atlas.empty());
+    CORRADE_COMPARE(o.str(), "TextureTools::atlasArray(): requested layer size Vector(32, 32) is too small to fit texture of size Vector(30, 13) with padding Vector(2, 2). Generated atlas will be empty.\n");
+}
+
+void AtlasTest::textureCoordinateTransformation() {
+    const Matrix3 transformation = TextureTools::atlasTextureCoordinateTransformation({64, 32}, Range2Di::fromSize({16, 8}, {32, 8}));
+    CORRADE_COMPARE(transformation.transformPoint({0.0f, 0.0f}), (Vector2{0.25f, 0.25f}));
+    CORRADE_COMPARE(transformation.transformPoint({1.0f, 1.0f}), (Vector2{0.75f, 0.5f}));
+    CORRADE_COMPARE(transformation.transformPoint({0.5f, 0.5f}), (Vector2{0.5f, 0.375f}));
+}
+
+void AtlasTest::image() {
+    const char a[]{'a', 'b', 0, 0,
+                   'c', 'd', 0, 0};
+    const char b[]{'1', '2', '3', 0,
+                   '4', '5', '6', 0};
+    std::vector<ImageView2D> images{
+        ImageView2D{PixelFormat::Red, PixelType::UnsignedByte, {2, 2}, a},
+        ImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::Red, PixelType::UnsignedByte, {1, 1}, Containers::ArrayView<const char>{a + 5, 1}},
+        ImageView2D{PixelFormat::Red, PixelType::UnsignedByte, {3, 2}, b}};
+
+    Image2D atlas = TextureTools::atlasImage({6, 3}, images, {
+        Range2Di::fromSize({0, 0}, {2, 2}),
+        Range2Di::fromSize({5, 2}, {1, 1}),
+        Range2Di::fromSize({2, 0}, {3, 2})});
+
+    CORRADE_COMPARE(atlas.format(), PixelFormat::Red);
+    CORRADE_COMPARE(atlas.type(), PixelType::UnsignedByte);
+    CORRADE_COMPARE(atlas.size(), (Vector2i{6, 3}));
+
+    /* Rows are padded to four bytes */
+    const char expected[]{
+        'a', 'b', '1', '2', '3', 0, 0, 0,
+        'c', 'd', '4', '5', '6', 0, 0, 0,
+          0,   0,   0,   0,   0, 'd', 0, 0};
+    CORRADE_COMPARE(std::string(atlas.data(), atlas.data().size()),
+        std::string(expected, sizeof(expected)));
+}
+
+void AtlasTest::imagePadding() {
+    const char a[]{'a', 'b', 0, 0,
+                   'c', 'd', 0, 0};
+    std::vector<ImageView2D> images{
+        ImageView2D{PixelFormat::Red, PixelType::UnsignedByte, {2, 2}, a}};
+
+    /* The padding is filled with edge pixels, except where it goes over the
+       atlas edge */
+    Image2D atlas = TextureTools::atlasImage({5, 4}, images, {
+        Range2Di::fromSize({1, 0}, {2, 2})}, {1, 1});
+    CORRADE_COMPARE(atlas.size(), (Vector2i{5, 4}));
+    const char expected[]{
+        'a', 'a', 'b', 'b', 0, 0, 0, 0,
+        'c', 'c', 'd', 'd', 0, 0, 0, 0,
+        'c', 'c', 'd', 'd', 0, 0, 0, 0,
+          0,   0,   0,   0, 0, 0, 0, 0};
+    CORRADE_COMPARE(std::string(atlas.data(), atlas.data().size()),
+        std::string(expected, sizeof(expected)));
+}
+
+void AtlasTest::imageArray() {
+    const char a[]{'a', 'b', 'c', 'd'};
+    const char b[]{'e', 'f', 0, 0,
+                   'g', 'h', 0, 0};
+    std::vector<ImageView2D> images{
+        ImageView2D{PixelFormat::RG, PixelType::UnsignedByte, {2, 1}, a},
+        ImageView2D{PixelFormat::RG, PixelType::UnsignedByte, {1, 2}, b}};
+
+    std::vector<Range3Di> ranges = TextureTools::atlasArray({2, 2}, {{2, 1}, {1, 2}});
+    CORRADE_COMPARE(ranges, (std::vector<Range3Di>{
+        Range3Di::fromSize({0, 0, 1}, {2, 1, 1}),
+        Range3Di::fromSize({0, 0, 0}, {1, 2, 1})}));
+
+    Image3D atlas = TextureTools::atlasImage({2, 2}, images, ranges);
+    CORRADE_COMPARE(atlas.format(), PixelFormat::RG);
+    CORRADE_COMPARE(atlas.size(), (Vector3i{2, 2, 2}));
+    const char expected[]{
+        'e', 'f', 0, 0,
+        'g', 'h', 0, 0,
+
+        'a', 'b', 'c', 'd',
+          0,   0,   0,   0};
+    CORRADE_COMPARE(std::string(atlas.data(), atlas.data().size()),
+        std::string(expected, sizeof(expected)));
 }
 
 }}}
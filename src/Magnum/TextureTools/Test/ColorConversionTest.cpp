@@ -0,0 +1,222 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/TextureTools/ColorConversion.h"
+
+namespace Magnum { namespace TextureTools { namespace Test {
+
+struct ColorConversionTest: TestSuite::Tester {
+    explicit ColorConversionTest();
+
+    void srgbToLinear8();
+    void srgbToLinearFloat();
+    void linearToSrgb8();
+    void linearToSrgbFloat();
+    void roundTrip8();
+    void alpha();
+    void rowPadding();
+    void rgbToHsv();
+    void hsvToRgb();
+    void threads();
+    void empty();
+};
+
+ColorConversionTest::ColorConversionTest() {
+    addTests({&ColorConversionTest::srgbToLinear8,
+              &ColorConversionTest::srgbToLinearFloat,
+              &ColorConversionTest::linearToSrgb8,
+              &ColorConversionTest::linearToSrgbFloat,
+              &ColorConversionTest::roundTrip8,
+              &ColorConversionTest::alpha,
+              &ColorConversionTest::rowPadding,
+              &ColorConversionTest::rgbToHsv,
+              &ColorConversionTest::hsvToRgb,
+              &ColorConversionTest::threads,
+              &ColorConversionTest::empty});
+}
+
+void ColorConversionTest::srgbToLinear8() {
+    /* Two RGB pixels, padded to four bytes */
+    const UnsignedByte rgb[]{0x00, 0x33, 0x66, 0x99, 0xcc, 0xff, 0, 0};
+    Image2D out = srgbToLinear(ImageView2D{PixelFormat::RGB, PixelType::UnsignedByte, {2, 1}, rgb});
+    CORRADE_COMPARE(out.format(), PixelFormat::RGB);
+    CORRADE_COMPARE(out.type(), PixelType::Float);
+    CORRADE_COMPARE(out.size(), (Vector2i{2, 1}));
+
+    const Color3* pixels = out.data<Color3>();
+    CORRADE_COMPARE(pixels[0], Color3::fromSrgb(Math::Vector3<UnsignedByte>{0x00, 0x33, 0x66}));
+    CORRADE_COMPARE(pixels[1], Color3::fromSrgb(Math::Vector3<UnsignedByte>{0x99, 0xcc, 0xff}));
+}
+
+void ColorConversionTest::srgbToLinearFloat() {
+    Float data[101];
+    for(std::size_t i = 0; i != 101; ++i) data[i] = Float(i)/100.0f;
+    data[100] = -0.5f;
+
+    Image2D out = srgbToLinear(ImageView2D{PixelFormat::Red, PixelType::Float, {101, 1}, data});
+    CORRADE_COMPARE(out.type(), PixelType::Float);
+    const Float* pixels = out.data<Float>();
+    for(std::size_t i = 0; i != 100; ++i)
+        CORRADE_COMPARE(pixels[i], Color3::fromSrgb(Vector3{data[i]}).r());
+
+    /* Negative values are mapped to zero */
+    CORRADE_COMPARE(pixels[100], 0.0f);
+}
+
+void ColorConversionTest::linearToSrgb8() {
+    const Float data[]{0.0f, 0.002f, 0.2140411f, 1.0f, 1.5f, -0.25f};
+    Image2D out = linearToSrgb(ImageView2D{PixelFormat::RGB, PixelType::Float, {2, 1}, data});
+    CORRADE_COMPARE(out.type(), PixelType::UnsignedByte);
+
+    const Math::Vector3<UnsignedByte>* pixels = out.data<Math::Vector3<UnsignedByte>>();
+    /* Rounded to nearest, 0.002 is 6.59 and 0.2140411 is 127.49 */
+    CORRADE_COMPARE(pixels[0], (Math::Vector3<UnsignedByte>{0, 7, 127}));
+    /* Out of range values are clamped */
+    CORRADE_COMPARE(pixels[1], (Math::Vector3<UnsignedByte>{255, 255, 0}));
+}
+
+void ColorConversionTest::linearToSrgbFloat() {
+    Float data[100];
+    for(std::size_t i = 0; i != 100; ++i) data[i] = Float(i)/99.0f;
+
+    Image2D out = linearToSrgb(ImageView2D{PixelFormat::Red, PixelType::Float, {100, 1}, data}, PixelType::Float);
+    CORRADE_COMPARE(out.type(), PixelType::Float);
+    const Float* pixels = out.data<Float>();
+    for(std::size_t i = 0; i != 100; ++i)
+        CORRADE_COMPARE(pixels[i], Color3{data[i]}.toSrgb().x());
+}
+
+void ColorConversionTest::roundTrip8() {
+    /* All 8-bit values survive the round trip unchanged */
+    UnsignedByte data[256];
+    for(std::size_t i = 0; i != 256; ++i) data[i] = UnsignedByte(i);
+
+    Image2D linear = srgbToLinear(ImageView2D{PixelFormat::Red, PixelType::UnsignedByte, {256, 1}, data});
+    Image2D srgb = linearToSrgb(linear);
+    CORRADE_COMPARE(srgb.type(), PixelType::UnsignedByte);
+    for(std::size_t i = 0; i != 256; ++i)
+        CORRADE_COMPARE(Int(srgb.data<UnsignedByte>()[i]), Int(i));
+}
+
+void ColorConversionTest::alpha() {
+    const Color4ub data[]{{0x33, 0x66, 0x99, 0x33}};
+    Image2D linear = srgbToLinear(ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {1, 1}, data});
+    const Color4 pixel = *linear.data<Color4>();
+    CORRADE_COMPARE(pixel.rgb(), Color3::fromSrgb(Math::Vector3<UnsignedByte>{0x33, 0x66, 0x99}));
+    CORRADE_COMPARE(pixel.a(), 0.2f);
+
+    Image2D srgb = linearToSrgb(linear);
+    CORRADE_COMPARE(*srgb.data<Color4ub>(), data[0]);
+}
+
+void ColorConversionTest::rowPadding() {
+    /* 3x2 RGB, rows padded to four bytes both in the input and output */
+    const UnsignedByte data[]{
+        0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0xfe, 0xfe, 0xfe,
+        0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff, 0x00, 0x11, 0xfe, 0xfe, 0xfe
+    };
+
+    Image2D linear = srgbToLinear(ImageView2D{PixelFormat::RGB, PixelType::UnsignedByte, {3, 2}, data});
+    Image2D srgb = linearToSrgb(linear);
+    CORRADE_COMPARE(srgb.data().size(), 24);
+    for(std::size_t y = 0; y != 2; ++y) for(std::size_t x = 0; x != 9; ++x)
+        CORRADE_COMPARE(Int(srgb.data<UnsignedByte>()[y*12 + x]), Int(data[y*12 + x]));
+}
+
+void ColorConversionTest::rgbToHsv() {
+    const Color3 data[]{
+        {1.0f, 0.0f, 0.0f}, {0.2f, 0.8f, 0.4f},
+        {0.1f, 0.3f, 0.9f}, {0.5f, 0.5f, 0.5f},
+        {0.9f, 0.2f, 0.4f}, {0.0f, 0.0f, 0.0f}
+    };
+
+    Image2D out = TextureTools::rgbToHsv(ImageView2D{PixelFormat::RGB, PixelType::Float, {2, 3}, data});
+    CORRADE_COMPARE(out.type(), PixelType::Float);
+    for(std::size_t i = 0; i != 6; ++i) {
+        Deg hue;
+        Float saturation, value;
+        std::tie(hue, saturation, value) = data[i].toHsv();
+        CORRADE_COMPARE(out.data<Vector3>()[i], (Vector3{Float(hue), saturation, value}));
+    }
+
+    /* 8-bit input gives the same result as the integral overload */
+    const Color4ub data8[]{{0x33, 0x99, 0x66, 0x80}};
+    Image2D out8 = TextureTools::rgbToHsv(ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {1, 1}, data8});
+    Deg hue;
+    Float saturation, value;
+    std::tie(hue, saturation, value) = data8[0].rgb().toHsv();
+    CORRADE_COMPARE(*out8.data<Vector4>(), (Vector4{Float(hue), saturation, value, 0x80/255.0f}));
+}
+
+void ColorConversionTest::hsvToRgb() {
+    const Vector3 data[]{
+        {0.0f, 1.0f, 1.0f}, {27.0f, 0.5f, 0.9f},
+        {100.0f, 0.7f, 0.3f}, {200.0f, 0.2f, 0.6f},
+        {250.0f, 1.0f, 0.5f}, {-30.0f, 0.8f, 0.7f},
+        {700.0f, 0.4f, 0.8f}, {359.0f, 0.0f, 0.2f}
+    };
+
+    Image2D out = TextureTools::hsvToRgb(ImageView2D{PixelFormat::RGB, PixelType::Float, {8, 1}, data});
+    CORRADE_COMPARE(out.type(), PixelType::Float);
+    for(std::size_t i = 0; i != 8; ++i)
+        CORRADE_COMPARE(out.data<Color3>()[i], Color3::fromHsv(Deg(data[i].x()), data[i].y(), data[i].z()));
+
+    /* Round trip through 8-bit */
+    Image2D out8 = TextureTools::hsvToRgb(ImageView2D{PixelFormat::RGB, PixelType::Float, {8, 1}, data}, PixelType::UnsignedByte);
+    CORRADE_COMPARE(out8.type(), PixelType::UnsignedByte);
+    CORRADE_COMPARE(out8.data<Color3ub>()[1], (Color3ub{Color3::fromHsv(Deg(27.0f), 0.5f, 0.9f)*255.0f + Color3{0.5f}}));
+}
+
+void ColorConversionTest::threads() {
+    UnsignedByte data[64*37*4];
+    for(std::size_t i = 0; i != sizeof(data); ++i)
+        data[i] = UnsignedByte(i*7919 >> 3);
+
+    const ImageView2D image{PixelFormat::RGBA, PixelType::UnsignedByte, {64, 37}, data};
+    Image2D single = srgbToLinear(image, 1);
+    Image2D multiple = srgbToLinear(image, 5);
+    CORRADE_COMPARE(single.data().size(), multiple.data().size());
+    CORRADE_VERIFY(std::equal(single.data().begin(), single.data().end(), multiple.data().begin()));
+
+    Image2D hsvSingle = TextureTools::rgbToHsv(image, 1);
+    Image2D hsvMultiple = TextureTools::rgbToHsv(image, 5);
+    CORRADE_VERIFY(std::equal(hsvSingle.data().begin(), hsvSingle.data().end(), hsvMultiple.data().begin()));
+}
+
+void ColorConversionTest::empty() {
+    Image2D out = srgbToLinear(ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {}, nullptr});
+    CORRADE_COMPARE(out.size(), Vector2i{});
+    CORRADE_COMPARE(out.type(), PixelType::Float);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::ColorConversionTest)
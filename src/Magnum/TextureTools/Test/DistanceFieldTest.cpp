@@ -0,0 +1,155 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/TextureTools/DistanceField.h"
+
+namespace Magnum { namespace TextureTools { namespace Test {
+
+struct DistanceFieldTest: TestSuite::Tester {
+    explicit DistanceFieldTest();
+
+    void cpu();
+    void cpuScaled();
+    void cpuMultiChannel();
+    void cpuThreads();
+};
+
+DistanceFieldTest::DistanceFieldTest() {
+    addTests({&DistanceFieldTest::cpu,
+              &DistanceFieldTest::cpuScaled,
+              &DistanceFieldTest::cpuMultiChannel,
+              &DistanceFieldTest::cpuThreads});
+}
+
+namespace {
+
+/* Binary test image with a few shapes, rows padded to four bytes */
+Containers::Array<char> inputData(const Vector2i& size, const std::size_t pixelSize) {
+    const std::size_t stride = (size.x()*pixelSize + 3)/4*4;
+    Containers::Array<char> data{Containers::ValueInit, stride*size.y()};
+    for(Int y = 0; y != size.y(); ++y) for(Int x = 0; x != size.x(); ++x) {
+        const Vector2i circle = Vector2i{x, y} - size/3;
+        const bool isInside =
+            circle.dot() < size.x()*size.x()/25 ||
+            (x > size.x()*2/3 && y > size.y()/2 && x + y < size.x() + size.y()*3/4) ||
+            (x == size.x()/2 && y < size.y()/4);
+        if(isInside) data[y*stride + x*pixelSize] = '\xff';
+    }
+    return data;
+}
+
+/* Straightforward port of the lookup done in DistanceFieldShader.frag */
+Containers::Array<UnsignedByte> reference(const Containers::Array<char>& input, const Vector2i& size, const std::size_t pixelSize, const Vector2i& outputSize, const Int radius) {
+    const std::size_t stride = (size.x()*pixelSize + 3)/4*4;
+    const auto hasValue = [&](Vector2i position) {
+        position = Math::clamp(position, Vector2i{}, size - Vector2i{1});
+        return UnsignedByte(input[position.y()*stride + position.x()*pixelSize]) > 127;
+    };
+
+    const Vector2 scaling = Vector2(size)/Vector2(outputSize);
+    const std::size_t outputStride = (outputSize.x() + 3)/4*4;
+    Containers::Array<UnsignedByte> out{Containers::ValueInit, outputStride*outputSize.y()};
+    for(Int y = 0; y != outputSize.y(); ++y) for(Int x = 0; x != outputSize.x(); ++x) {
+        const Vector2i position{Vector2{Float(x), Float(y)}*scaling};
+        const bool isInside = hasValue(position);
+
+        Int minDistanceSquared = (radius + 1)*(radius + 1);
+        for(Int j = -radius; j <= radius; ++j) for(Int i = -radius; i <= radius; ++i) {
+            if(hasValue(position + Vector2i{i, j}) == isInside) continue;
+            minDistanceSquared = std::min(minDistanceSquared, i*i + j*j);
+        }
+
+        const Float value = (isInside ? 1.0f : -1.0f)*std::sqrt(Float(minDistanceSquared))/Float(radius*2 + 2) + 0.5f;
+        out[y*outputStride + x] = UnsignedByte(value*255.0f + 0.5f);
+    }
+
+    return out;
+}
+
+}
+
+void DistanceFieldTest::cpu() {
+    const Vector2i size{61, 47};
+    const Containers::Array<char> data = inputData(size, 1);
+
+    Image2D output = distanceField(ImageView2D{PixelFormat::Red, PixelType::UnsignedByte, size, data}, size, 6, 1);
+    CORRADE_COMPARE(output.format(), PixelFormat::Red);
+    CORRADE_COMPARE(output.type(), PixelType::UnsignedByte);
+    CORRADE_COMPARE(output.size(), size);
+
+    const Containers::Array<UnsignedByte> expected = reference(data, size, 1, size, 6);
+    for(std::size_t i = 0; i != expected.size(); ++i)
+        CORRADE_COMPARE(Int(UnsignedByte(output.data()[i])), Int(expected[i]));
+}
+
+void DistanceFieldTest::cpuScaled() {
+    const Vector2i size{256, 192};
+    const Containers::Array<char> data = inputData(size, 1);
+
+    Image2D output = distanceField(ImageView2D{PixelFormat::Red, PixelType::UnsignedByte, size, data}, {37, 29}, 16, 1);
+    CORRADE_COMPARE(output.size(), (Vector2i{37, 29}));
+
+    const Containers::Array<UnsignedByte> expected = reference(data, size, 1, {37, 29}, 16);
+    for(std::size_t i = 0; i != expected.size(); ++i)
+        CORRADE_COMPARE(Int(UnsignedByte(output.data()[i])), Int(expected[i]));
+}
+
+void DistanceFieldTest::cpuMultiChannel() {
+    const Vector2i size{45, 30};
+    const Containers::Array<char> data = inputData(size, 3);
+
+    Image2D output = distanceField(ImageView2D{PixelFormat::RGB, PixelType::UnsignedByte, size, data}, {15, 10}, 4, 1);
+
+    const Containers::Array<UnsignedByte> expected = reference(data, size, 3, {15, 10}, 4);
+    for(std::size_t i = 0; i != expected.size(); ++i)
+        CORRADE_COMPARE(Int(UnsignedByte(output.data()[i])), Int(expected[i]));
+}
+
+void DistanceFieldTest::cpuThreads() {
+    const Vector2i size{200, 150};
+    const Containers::Array<char> data = inputData(size, 1);
+    const ImageView2D input{PixelFormat::Red, PixelType::UnsignedByte, size, data};
+
+    Image2D single = distanceField(input, {100, 75}, 8, 1);
+    Image2D multi = distanceField(input, {100, 75}, 8, 7);
+    Image2D automatic = distanceField(input, {100, 75}, 8);
+
+    CORRADE_COMPARE(multi.data().size(), single.data().size());
+    CORRADE_COMPARE(automatic.data().size(), single.data().size());
+    CORRADE_VERIFY(std::equal(single.data().begin(), single.data().end(), multi.data().begin()));
+    CORRADE_VERIFY(std::equal(single.data().begin(), single.data().end(), automatic.data().begin()));
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::DistanceFieldTest)
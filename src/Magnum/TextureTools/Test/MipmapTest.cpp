@@ -0,0 +1,222 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/TextureTools/Mipmap.h"
+
+namespace Magnum { namespace TextureTools { namespace Test {
+
+struct MipmapTest: TestSuite::Tester {
+    explicit MipmapTest();
+
+    void box();
+    void boxSrgb();
+    void nonPowerOfTwo();
+    void constant();
+    void floatingPoint();
+    void sharpness();
+    void threads();
+    void empty();
+};
+
+MipmapTest::MipmapTest() {
+    addTests({&MipmapTest::box,
+              &MipmapTest::boxSrgb,
+              &MipmapTest::nonPowerOfTwo});
+
+    addInstancedTests({&MipmapTest::constant}, 3);
+
+    addTests({&MipmapTest::floatingPoint,
+              &MipmapTest::sharpness,
+              &MipmapTest::threads,
+              &MipmapTest::empty});
+}
+
+namespace {
+    constexpr MipmapFilter Filters[]{MipmapFilter::Box, MipmapFilter::Lanczos, MipmapFilter::Kaiser};
+    constexpr const char* FilterNames[]{"Box", "Lanczos", "Kaiser"};
+}
+
+void MipmapTest::box() {
+    /* 4x2 RGBA, the level sizes are 2x1 and 1x1 */
+    const UnsignedByte data[]{
+        0, 10, 100, 255,    40, 10, 100, 255,   255, 0, 0, 0,   255, 0, 0, 0,
+        20, 30, 100, 255,   60, 30, 100, 255,   255, 0, 0, 0,   255, 0, 0, 0
+    };
+
+    std::vector<Image2D> levels = generateMipmaps(ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {4, 2}, data}, MipmapFilter::Box);
+    CORRADE_COMPARE(levels.size(), 2);
+    CORRADE_COMPARE(levels[0].size(), (Vector2i{2, 1}));
+    CORRADE_COMPARE(levels[0].format(), PixelFormat::RGBA);
+    CORRADE_COMPARE(levels[0].type(), PixelType::UnsignedByte);
+    CORRADE_COMPARE(levels[1].size(), (Vector2i{1, 1}));
+
+    const Color4ub* first = levels[0].data<Color4ub>();
+    CORRADE_COMPARE(first[0], (Color4ub{30, 20, 100, 255}));
+    CORRADE_COMPARE(first[1], (Color4ub{255, 0, 0, 0}));
+    CORRADE_COMPARE(*levels[1].data<Color4ub>(), (Color4ub{143, 10, 50, 128}));
+}
+
+void MipmapTest::boxSrgb() {
+    /* Black and white checkerboard produces 50% gray in linear space, which
+       is 188 in sRGB. Alpha is filtered linearly. */
+    const UnsignedByte data[]{
+        0, 0, 0, 0,         255, 255, 255, 255,
+        255, 255, 255, 255, 0, 0, 0, 0
+    };
+
+    std::vector<Image2D> linear = generateMipmaps(ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {2, 2}, data}, MipmapFilter::Box);
+    std::vector<Image2D> srgb = generateMipmaps(ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {2, 2}, data}, MipmapFilter::Box, MipmapFlag::Srgb);
+    CORRADE_COMPARE(linear.size(), 1);
+    CORRADE_COMPARE(srgb.size(), 1);
+    CORRADE_COMPARE(*linear[0].data<Color4ub>(), (Color4ub{128, 128, 128, 128}));
+    CORRADE_COMPARE(*srgb[0].data<Color4ub>(), (Color4ub{188, 188, 188, 128}));
+
+    /* Without alpha all channels are converted */
+    const UnsignedByte rgb[]{
+        0, 0, 0,        255, 255, 255,  0, 0, /* padding */
+        255, 255, 255,  0, 0, 0,        0, 0
+    };
+    std::vector<Image2D> srgbRgb = generateMipmaps(ImageView2D{PixelFormat::RGB, PixelType::UnsignedByte, {2, 2}, rgb}, MipmapFilter::Box, MipmapFlag::Srgb);
+    CORRADE_COMPARE(srgbRgb.size(), 1);
+    CORRADE_COMPARE(*srgbRgb[0].data<Color3ub>(), (Color3ub{188, 188, 188}));
+}
+
+void MipmapTest::nonPowerOfTwo() {
+    /* 5x3 RGB with a vertical white line in the middle column. The padded
+       rows are respected on input and produced on output. */
+    UnsignedByte data[16*3]{};
+    for(std::size_t y = 0; y != 3; ++y)
+        for(std::size_t c = 0; c != 3; ++c) data[y*16 + 2*3 + c] = 255;
+
+    std::vector<Image2D> levels = generateMipmaps(ImageView2D{PixelFormat::RGB, PixelType::UnsignedByte, {5, 3}, data}, MipmapFilter::Box);
+    CORRADE_COMPARE(levels.size(), 2);
+    CORRADE_COMPARE(levels[0].size(), (Vector2i{2, 1}));
+    CORRADE_COMPARE(levels[1].size(), (Vector2i{1, 1}));
+    CORRADE_COMPARE(levels[0].data().size(), 8);
+
+    /* The middle column is shared by both output pixels, each gets 1/5 of
+       its value */
+    const Color3ub* first = levels[0].data<Color3ub>();
+    CORRADE_COMPARE(first[0], Color3ub{51});
+    CORRADE_COMPARE(first[1], Color3ub{51});
+    CORRADE_COMPARE(*levels[1].data<Color3ub>(), Color3ub{51});
+}
+
+void MipmapTest::constant() {
+    setTestCaseDescription(FilterNames[testCaseInstanceId()]);
+
+    std::vector<Color4ub> data(37*12, Color4ub{17, 98, 201, 240});
+    std::vector<Image2D> levels = generateMipmaps(ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {37, 12}, Containers::ArrayView<const Color4ub>{data.data(), data.size()}}, Filters[testCaseInstanceId()], MipmapFlag::Srgb);
+
+    /* 18x6, 9x3, 4x1, 2x1, 1x1 */
+    CORRADE_COMPARE(levels.size(), 5);
+    CORRADE_COMPARE(levels[2].size(), (Vector2i{4, 1}));
+    for(const Image2D& level: levels) {
+        const Color4ub* pixels = level.data<Color4ub>();
+        for(Int i = 0; i != level.size().product(); ++i)
+            CORRADE_COMPARE(pixels[i], (Color4ub{17, 98, 201, 240}));
+    }
+}
+
+void MipmapTest::floatingPoint() {
+    const Float data[]{
+        0.0f, 1.0f, 2.0f, 3.0f,
+        4.0f, 5.0f, 6.0f, -1.0f
+    };
+
+    std::vector<Image2D> levels = generateMipmaps(ImageView2D{PixelFormat::Red, PixelType::Float, {4, 2}, data}, MipmapFilter::Box, MipmapFlag::Srgb);
+    CORRADE_COMPARE(levels.size(), 2);
+    CORRADE_COMPARE(levels[0].type(), PixelType::Float);
+
+    /* Not clamped, not converted from sRGB */
+    const Float* first = levels[0].data<Float>();
+    CORRADE_COMPARE(first[0], 2.5f);
+    CORRADE_COMPARE(first[1], 2.5f);
+    CORRADE_COMPARE(*levels[1].data<Float>(), 2.5f);
+}
+
+void MipmapTest::sharpness() {
+    /* Single bright pixel in 16x16 image, box filter spreads it over the
+       whole 4x4 area at second level while the windowed sinc filters keep it
+       more concentrated */
+    Float data[16*16]{};
+    data[8*16 + 8] = 1.0f;
+
+    Float peak[3];
+    for(std::size_t i = 0; i != 3; ++i) {
+        std::vector<Image2D> levels = generateMipmaps(ImageView2D{PixelFormat::Red, PixelType::Float, {16, 16}, data}, Filters[i]);
+        CORRADE_COMPARE(levels.size(), 4);
+
+        /* Total energy is preserved */
+        const Float* pixels = levels[0].data<Float>();
+        Float sum = 0.0f;
+        for(std::size_t j = 0; j != 8*8; ++j) sum += pixels[j];
+        CORRADE_COMPARE(sum, 0.25f);
+
+        peak[i] = *std::max_element(pixels, pixels + 8*8);
+    }
+
+    CORRADE_COMPARE(peak[0], 0.25f);
+    CORRADE_VERIFY(peak[1] < peak[0]);
+    CORRADE_VERIFY(peak[2] < peak[0]);
+    CORRADE_VERIFY(peak[1] > peak[2]);
+}
+
+void MipmapTest::threads() {
+    std::vector<UnsignedByte> data;
+    for(Int y = 0; y != 61; ++y) for(Int x = 0; x != 64; ++x) {
+        data.push_back((x*x + y*7) % 256);
+        data.push_back((x*y) % 256);
+    }
+    const ImageView2D image{PixelFormat::RG, PixelType::UnsignedByte, {64, 61}, Containers::ArrayView<const UnsignedByte>{data.data(), data.size()}};
+
+    std::vector<Image2D> single = generateMipmaps(image, MipmapFilter::Lanczos, {}, 1);
+    std::vector<Image2D> multiple = generateMipmaps(image, MipmapFilter::Lanczos, {}, 7);
+    CORRADE_COMPARE(single.size(), 6);
+    CORRADE_COMPARE(multiple.size(), 6);
+    for(std::size_t i = 0; i != single.size(); ++i) {
+        CORRADE_COMPARE(single[i].size(), multiple[i].size());
+        CORRADE_VERIFY(std::equal(single[i].data().begin(), single[i].data().end(), multiple[i].data().begin()));
+    }
+}
+
+void MipmapTest::empty() {
+    CORRADE_VERIFY(generateMipmaps(ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {}, nullptr}).empty());
+
+    /* 1x1 image has no additional levels */
+    const UnsignedByte data[4]{};
+    CORRADE_VERIFY(generateMipmaps(ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {1, 1}, data}).empty());
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::MipmapTest)
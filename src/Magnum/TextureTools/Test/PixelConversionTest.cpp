@@ -0,0 +1,259 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/TextureTools/PixelConversion.h"
+
+namespace Magnum { namespace TextureTools { namespace Test {
+
+struct PixelConversionTest: TestSuite::Tester {
+    explicit PixelConversionTest();
+
+    void same();
+    #ifndef MAGNUM_TARGET_GLES
+    void swizzle3();
+    #endif
+    #ifndef MAGNUM_TARGET_WEBGL
+    void swizzle4();
+    #endif
+    void expandAlpha();
+    void dropChannels();
+    void unsignedByteToFloat();
+    void floatToUnsignedByte();
+    void unsignedByteToUnsignedShort();
+    void unsignedShortToUnsignedByte();
+    void rowPadding();
+    void threads();
+    void empty();
+
+    void flipY();
+    void flipYInPlace();
+};
+
+PixelConversionTest::PixelConversionTest() {
+    addTests({&PixelConversionTest::same,
+              #ifndef MAGNUM_TARGET_GLES
+              &PixelConversionTest::swizzle3,
+              #endif
+              #ifndef MAGNUM_TARGET_WEBGL
+              &PixelConversionTest::swizzle4,
+              #endif
+              &PixelConversionTest::expandAlpha,
+              &PixelConversionTest::dropChannels,
+              &PixelConversionTest::unsignedByteToFloat,
+              &PixelConversionTest::floatToUnsignedByte,
+              &PixelConversionTest::unsignedByteToUnsignedShort,
+              &PixelConversionTest::unsignedShortToUnsignedByte,
+              &PixelConversionTest::rowPadding,
+              &PixelConversionTest::threads,
+              &PixelConversionTest::empty,
+
+              &PixelConversionTest::flipY,
+              &PixelConversionTest::flipYInPlace});
+}
+
+typedef Math::Vector3<UnsignedByte> Vector3ub;
+typedef Math::Vector4<UnsignedByte> Vector4ub;
+
+void PixelConversionTest::same() {
+    const Color4 data[]{{0.1f, 0.2f, 0.3f, 0.4f}, {0.5f, 0.6f, 0.7f, 0.8f}};
+    Image2D out = convertPixels(ImageView2D{PixelFormat::RGBA, PixelType::Float, {2, 1}, data}, PixelFormat::RGBA, PixelType::Float);
+    CORRADE_COMPARE(out.format(), PixelFormat::RGBA);
+    CORRADE_COMPARE(out.type(), PixelType::Float);
+    CORRADE_COMPARE(out.size(), (Vector2i{2, 1}));
+    CORRADE_COMPARE(out.data<Color4>()[0], data[0]);
+    CORRADE_COMPARE(out.data<Color4>()[1], data[1]);
+}
+
+#ifndef MAGNUM_TARGET_GLES
+void PixelConversionTest::swizzle3() {
+    /* Odd count to test the scalar remainder after the vectorized code */
+    Vector3ub data[37];
+    for(std::size_t i = 0; i != 37; ++i)
+        data[i] = {UnsignedByte(i), UnsignedByte(i*2), UnsignedByte(i*3)};
+
+    Image2D out = convertPixels(ImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB, PixelType::UnsignedByte, {37, 1}, data}, PixelFormat::BGR, PixelType::UnsignedByte);
+    CORRADE_COMPARE(out.format(), PixelFormat::BGR);
+    for(std::size_t i = 0; i != 37; ++i)
+        CORRADE_COMPARE(out.data<Vector3ub>()[i], (Vector3ub{UnsignedByte(i*3), UnsignedByte(i*2), UnsignedByte(i)}));
+}
+#endif
+
+#ifndef MAGNUM_TARGET_WEBGL
+void PixelConversionTest::swizzle4() {
+    Vector4ub data[37];
+    for(std::size_t i = 0; i != 37; ++i)
+        data[i] = {UnsignedByte(i), UnsignedByte(i*2), UnsignedByte(i*3), UnsignedByte(i*4)};
+
+    Image2D out = convertPixels(ImageView2D{PixelFormat::BGRA, PixelType::UnsignedByte, {37, 1}, data}, PixelFormat::RGBA, PixelType::UnsignedByte);
+    for(std::size_t i = 0; i != 37; ++i)
+        CORRADE_COMPARE(out.data<Vector4ub>()[i], (Vector4ub{UnsignedByte(i*3), UnsignedByte(i*2), UnsignedByte(i), UnsignedByte(i*4)}));
+}
+#endif
+
+void PixelConversionTest::expandAlpha() {
+    Vector3ub data[37];
+    for(std::size_t i = 0; i != 37; ++i)
+        data[i] = {UnsignedByte(i), UnsignedByte(i*2), UnsignedByte(i*3)};
+
+    Image2D out = convertPixels(ImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB, PixelType::UnsignedByte, {37, 1}, data}, PixelFormat::RGBA, PixelType::UnsignedByte);
+    CORRADE_COMPARE(out.format(), PixelFormat::RGBA);
+    for(std::size_t i = 0; i != 37; ++i)
+        CORRADE_COMPARE(out.data<Vector4ub>()[i], (Vector4ub{UnsignedByte(i), UnsignedByte(i*2), UnsignedByte(i*3), 255}));
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    /* Swizzled expansion */
+    Image2D swizzled = convertPixels(ImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB, PixelType::UnsignedByte, {37, 1}, data}, PixelFormat::BGRA, PixelType::UnsignedByte);
+    for(std::size_t i = 0; i != 37; ++i)
+        CORRADE_COMPARE(swizzled.data<Vector4ub>()[i], (Vector4ub{UnsignedByte(i*3), UnsignedByte(i*2), UnsignedByte(i), 255}));
+    #endif
+
+    /* Generic path, missing channels are zero and alpha one */
+    #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+    const Float red[]{0.25f, 0.75f};
+    Image2D rgba = convertPixels(ImageView2D{PixelFormat::Red, PixelType::Float, {2, 1}, red}, PixelFormat::RGBA, PixelType::Float);
+    CORRADE_COMPARE(rgba.data<Color4>()[0], (Color4{0.25f, 0.0f, 0.0f, 1.0f}));
+    CORRADE_COMPARE(rgba.data<Color4>()[1], (Color4{0.75f, 0.0f, 0.0f, 1.0f}));
+    #endif
+}
+
+void PixelConversionTest::dropChannels() {
+    const Color4 data[]{{0.1f, 0.2f, 0.3f, 0.4f}, {0.5f, 0.6f, 0.7f, 0.8f}};
+    Image2D out = convertPixels(ImageView2D{PixelFormat::RGBA, PixelType::Float, {2, 1}, data}, PixelFormat::RGB, PixelType::UnsignedByte);
+    CORRADE_COMPARE(out.format(), PixelFormat::RGB);
+    CORRADE_COMPARE(out.type(), PixelType::UnsignedByte);
+    /* Rounded to nearest */
+    CORRADE_COMPARE(out.data<Vector3ub>()[0], (Vector3ub{26, 51, 77}));
+    CORRADE_COMPARE(out.data<Vector3ub>()[1], (Vector3ub{128, 153, 179}));
+}
+
+void PixelConversionTest::unsignedByteToFloat() {
+    UnsignedByte data[40];
+    for(std::size_t i = 0; i != 40; ++i) data[i] = UnsignedByte(i*6);
+
+    Image2D out = convertPixels(ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {10, 1}, data}, PixelFormat::RGBA, PixelType::Float);
+    CORRADE_COMPARE(out.type(), PixelType::Float);
+    for(std::size_t i = 0; i != 40; ++i)
+        CORRADE_COMPARE(out.data<Float>()[i], Float(i*6)/255.0f);
+}
+
+void PixelConversionTest::floatToUnsignedByte() {
+    Float data[40];
+    for(std::size_t i = 0; i != 36; ++i) data[i] = Float(i)/35.0f;
+    /* Out of range values are clamped, in the scalar remainder as well as in
+       the vectorized part */
+    data[4] = data[37] = -0.5f;
+    data[5] = data[38] = 1.0e10f;
+    data[36] = data[39] = 2.0f;
+
+    Image2D out = convertPixels(ImageView2D{PixelFormat::RGBA, PixelType::Float, {10, 1}, data}, PixelFormat::RGBA, PixelType::UnsignedByte);
+    const UnsignedByte* pixels = out.data<UnsignedByte>();
+    for(std::size_t i: {0, 1, 2, 3, 6, 17, 35})
+        CORRADE_COMPARE(pixels[i], UnsignedByte(Float(i)/35.0f*255.0f + 0.5f));
+    CORRADE_COMPARE(pixels[4], 0);
+    CORRADE_COMPARE(pixels[5], 255);
+    CORRADE_COMPARE(pixels[36], 255);
+    CORRADE_COMPARE(pixels[37], 0);
+    CORRADE_COMPARE(pixels[38], 255);
+    CORRADE_COMPARE(pixels[39], 255);
+}
+
+void PixelConversionTest::unsignedByteToUnsignedShort() {
+    const UnsignedByte data[]{0, 1, 128, 255};
+    Image2D out = convertPixels(ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {1, 1}, data}, PixelFormat::RGBA, PixelType::UnsignedShort);
+    CORRADE_COMPARE(out.type(), PixelType::UnsignedShort);
+    CORRADE_COMPARE(out.data<UnsignedShort>()[0], 0);
+    CORRADE_COMPARE(out.data<UnsignedShort>()[1], 257);
+    CORRADE_COMPARE(out.data<UnsignedShort>()[2], 32896);
+    CORRADE_COMPARE(out.data<UnsignedShort>()[3], 65535);
+}
+
+void PixelConversionTest::unsignedShortToUnsignedByte() {
+    const UnsignedShort data[]{0, 257, 32896, 65535};
+    Image2D out = convertPixels(ImageView2D{PixelFormat::RGBA, PixelType::UnsignedShort, {1, 1}, data}, PixelFormat::RGBA, PixelType::UnsignedByte);
+    CORRADE_COMPARE(out.data<UnsignedByte>()[0], 0);
+    CORRADE_COMPARE(out.data<UnsignedByte>()[1], 1);
+    CORRADE_COMPARE(out.data<UnsignedByte>()[2], 128);
+    CORRADE_COMPARE(out.data<UnsignedByte>()[3], 255);
+}
+
+void PixelConversionTest::rowPadding() {
+    /* 1x2 RGB with rows padded to four bytes */
+    const UnsignedByte data[]{1, 2, 3, 0, 4, 5, 6, 0};
+    Image2D out = convertPixels(ImageView2D{PixelFormat::RGB, PixelType::UnsignedByte, {1, 2}, data}, PixelFormat::RGBA, PixelType::UnsignedByte);
+    CORRADE_COMPARE(out.data<Vector4ub>()[0], (Vector4ub{1, 2, 3, 255}));
+    CORRADE_COMPARE(out.data<Vector4ub>()[1], (Vector4ub{4, 5, 6, 255}));
+
+    /* The output is padded as well */
+    Image2D rgb = convertPixels(out, PixelFormat::RGB, PixelType::UnsignedByte);
+    CORRADE_COMPARE(rgb.data().size(), 8);
+    CORRADE_COMPARE(rgb.data<UnsignedByte>()[4], 4);
+}
+
+void PixelConversionTest::threads() {
+    Vector3ub data[64*33];
+    for(std::size_t i = 0; i != 64*33; ++i)
+        data[i] = {UnsignedByte(i), UnsignedByte(i >> 3), UnsignedByte(i*7)};
+
+    const ImageView2D image{PixelFormat::RGB, PixelType::UnsignedByte, {64, 33}, data};
+    Image2D single = convertPixels(image, PixelFormat::RGBA, PixelType::Float, 1);
+    Image2D multiple = convertPixels(image, PixelFormat::RGBA, PixelType::Float, 5);
+    CORRADE_COMPARE(single.data().size(), multiple.data().size());
+    CORRADE_VERIFY(std::equal(single.data().begin(), single.data().end(), multiple.data().begin()));
+}
+
+void PixelConversionTest::empty() {
+    Image2D out = convertPixels(ImageView2D{PixelFormat::RGB, PixelType::UnsignedByte, {}, nullptr}, PixelFormat::RGBA, PixelType::Float);
+    CORRADE_COMPARE(out.size(), Vector2i{});
+    CORRADE_VERIFY(!out.data());
+}
+
+void PixelConversionTest::flipY() {
+    /* 1x3 RGB with rows padded to four bytes */
+    const UnsignedByte data[]{1, 2, 3, 0, 4, 5, 6, 0, 7, 8, 9, 0};
+    Image2D out = TextureTools::flipY(ImageView2D{PixelFormat::RGB, PixelType::UnsignedByte, {1, 3}, data});
+    CORRADE_COMPARE(out.format(), PixelFormat::RGB);
+    CORRADE_COMPARE(out.size(), (Vector2i{1, 3}));
+    CORRADE_COMPARE(out.data<Vector3ub>()[0], (Vector3ub{7, 8, 9}));
+    CORRADE_COMPARE(*reinterpret_cast<const Vector3ub*>(out.data<char>() + 4), (Vector3ub{4, 5, 6}));
+    CORRADE_COMPARE(*reinterpret_cast<const Vector3ub*>(out.data<char>() + 8), (Vector3ub{1, 2, 3}));
+}
+
+void PixelConversionTest::flipYInPlace() {
+    Image2D image{PixelFormat::RGBA, PixelType::UnsignedByte, {1, 3}, Containers::Array<char>{Containers::InPlaceInit, {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12}}};
+    TextureTools::flipYInPlace(image);
+    CORRADE_COMPARE(image.data<Vector4ub>()[0], (Vector4ub{9, 10, 11, 12}));
+    CORRADE_COMPARE(image.data<Vector4ub>()[1], (Vector4ub{5, 6, 7, 8}));
+    CORRADE_COMPARE(image.data<Vector4ub>()[2], (Vector4ub{1, 2, 3, 4}));
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::PixelConversionTest)
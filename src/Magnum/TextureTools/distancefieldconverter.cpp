@@ -71,7 +71,7 @@ namespace Magnum {
 
 @section magnum-distancefieldconverter-usage Usage
 
-    magnum-distancefieldconverter [--magnum-...] [-h|--help] [--importer IMPORTER] [--converter CONVERTER] [--plugin-dir DIR] --output-size "X Y" --radius N [--] input output
+    magnum-distancefieldconverter [--magnum-...] [-h|--help] [--importer IMPORTER] [--converter CONVERTER] [--plugin-dir DIR] [--cpu] [--threads N] [--tile-size "X Y"] --output-size "X Y" --radius N [--] input output
 
 Arguments:
 
@@ -84,10 +84,20 @@ Arguments:
     Magnum install location)
 -   `--output-size "X Y"` -- size of output image
 -   `--radius N` -- distance field computation radius
+-   `--cpu` -- do the conversion on the CPU, without creating any GL context
+-   `--threads N` -- count of worker threads for the CPU conversion (default:
+    `0`, which means hardware concurrency)
+-   `--tile-size "X Y"` -- process the input in tiles of at most given size
+    on the GPU (default: `0 0`, which means the whole input is processed at
+    once)
 -   `--magnum-...` -- engine-specific options (see @ref Context for details)
 
 Images with @ref PixelFormat::Red, @ref PixelFormat::RGB or @ref PixelFormat::RGBA
-are accepted on input.
+are accepted on input. With `--cpu`, any image with @ref PixelType::UnsignedByte
+is accepted and only its first channel is used, see
+@ref TextureTools::distanceField(const ImageView2D&, const Vector2i&, Int, UnsignedInt)
+for details. The same applies with `--tile-size`, see
+@ref TextureTools::distanceFieldTiled() for details.
 
 The resulting image can be then used with @ref Shaders::DistanceFieldVector
 shader. See also @ref TextureTools::distanceField() for more information about
@@ -99,7 +109,14 @@ the algorithm and parameters.
 
 This will open monochrome `logo-src.png` image using any plugin that can open
 PNG files and converts it to 256x256 distance field `logo.png` using any plugin
-that can write PNG files.
+that can write PNG files. On machines without GPU, add `--cpu` to do the
+conversion on the CPU:
+
+    magnum-distancefieldconverter --cpu --output-size "256 256" --radius 24 logo-src.png logo.png
+
+Inputs larger than the max texture size can be processed on the GPU in tiles:
+
+    magnum-distancefieldconverter --tile-size "4096 4096" --output-size "2048 2048" --radius 96 map-src.png map.png
 
 */
 
@@ -123,11 +140,14 @@ DistanceFieldConverter::DistanceFieldConverter(const Arguments& arguments): Plat
         .addOption("plugin-dir", Utility::Directory::join(Utility::Directory::path(Utility::Directory::executableLocation()), MAGNUM_PLUGINS_DIR)).setHelp("plugin-dir", "base plugin dir", "DIR")
         .addNamedArgument("output-size").setHelp("output-size", "size of output image", "\"X Y\"")
         .addNamedArgument("radius").setHelp("radius", "distance field computation radius", "N")
+        .addBooleanOption("cpu").setHelp("cpu", "do the conversion on the CPU, without creating any GL context")
+        .addOption("threads", "0").setHelp("threads", "count of worker threads for the CPU conversion, 0 means hardware concurrency", "N")
+        .addOption("tile-size", "0 0").setHelp("tile-size", "process the input in tiles of at most given size, 0 0 means the whole input at once", "\"X Y\"")
         .addSkippedPrefix("magnum", "engine-specific options")
         .setHelp("Converts red channel of an image to distance field representation.")
         .parse(arguments.argc, arguments.argv);
 
-    createContext();
+    if(!args.isSet("cpu")) createContext();
 }
 
 int DistanceFieldConverter::exec() {
@@ -150,6 +170,46 @@ int DistanceFieldConverter::exec() {
         return 1;
     }
 
+    /* Convert on the CPU, if requested */
+    if(args.isSet("cpu")) {
+        if(image->type() != PixelType::UnsignedByte) {
+            Error() << "Unsupported image type" << image->type();
+            return 1;
+        }
+
+        Debug() << "Converting image of size" << image->size() << "to distance field on the CPU...";
+        const Image2D result = TextureTools::distanceField(*image, args.value<Vector2i>("output-size"), args.value<Int>("radius"), args.value<UnsignedInt>("threads"));
+        if(!converter->exportToFile(result, args.value("output"))) {
+            Error() << "Cannot save file" << args.value("output");
+            return 1;
+        }
+
+        return 0;
+    }
+
+    /* Convert in tiles, if requested */
+    const Vector2i tileSize = args.value<Vector2i>("tile-size");
+    if(!tileSize.isZero()) {
+        if(image->type() != PixelType::UnsignedByte) {
+            Error() << "Unsupported image type" << image->type();
+            return 1;
+        }
+
+        #ifndef MAGNUM_TARGET_GLES2
+        Debug() << "Converting image of size" << image->size() << "to distance field in tiles of" << tileSize << Debug::nospace << "...";
+        const Image2D result = TextureTools::distanceFieldTiled(*image, args.value<Vector2i>("output-size"), args.value<Int>("radius"), tileSize);
+        if(!converter->exportToFile(result, args.value("output"))) {
+            Error() << "Cannot save file" << args.value("output");
+            return 1;
+        }
+
+        return 0;
+        #else
+        Error() << "Tiled conversion is not available on OpenGL ES 2.0";
+        return 1;
+        #endif
+    }
+
     /* Decide about internal format */
     TextureFormat internalFormat;
     if(image->format() == PixelFormat::Red) internalFormat = TextureFormat::R8;
@@ -112,6 +112,19 @@ class TimeQuery: public AbstractQuery {
         CORRADE_DEPRECATED("use TimeQuery(Target) instead") explicit TimeQuery() {}
         #endif
 
+        /**
+         * @brief Create multiple time queries at once
+         * @param count         Query count
+         * @param target        Query target
+         *
+         * Equivalent to constructing @p count instances using
+         * @ref TimeQuery(Target), but creates all OpenGL objects using a single
+         * @fn_gl{CreateQueries} (or @fn_gl{GenQueries}) call.
+         */
+        static std::vector<TimeQuery> createArray(std::size_t count, Target target) {
+            return createArrayInternal<TimeQuery>(count, target);
+        }
+
         /**
          * @brief Wrap existing OpenGL time query object
          * @param id            OpenGL time query ID
@@ -30,10 +30,13 @@
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/Directory.h>
 
+#include "Magnum/ArrayPool.h"
 #include "Magnum/Trade/AbstractMaterialData.h"
+#include "Magnum/Trade/AssetCache.h"
 #include "Magnum/Trade/CameraData.h"
 #include "Magnum/Trade/ImageData.h"
 #include "Magnum/Trade/LightData.h"
+#include "Magnum/Trade/MeshData.h"
 #include "Magnum/Trade/MeshData2D.h"
 #include "Magnum/Trade/MeshData3D.h"
 #include "Magnum/Trade/ObjectData2D.h"
@@ -55,6 +58,7 @@ bool AbstractImporter::openData(Containers::ArrayView<const char> data) {
 
     close();
     doOpenData(data);
+    if(isOpened()) updateCacheKey(data);
     return isOpened();
 }
 
@@ -62,9 +66,41 @@ void AbstractImporter::doOpenData(Containers::ArrayView<const char>) {
     CORRADE_ASSERT(false, "Trade::AbstractImporter::openData(): feature advertised but not implemented", );
 }
 
+bool AbstractImporter::openMemory(Containers::ArrayView<const char> memory) {
+    CORRADE_ASSERT(features() & Feature::OpenMemory,
+        "Trade::AbstractImporter::openMemory(): feature not supported", {});
+
+    close();
+    doOpenMemory(memory);
+    if(isOpened()) updateCacheKey(memory);
+    return isOpened();
+}
+
+void AbstractImporter::doOpenMemory(Containers::ArrayView<const char>) {
+    CORRADE_ASSERT(false, "Trade::AbstractImporter::openMemory(): feature advertised but not implemented", );
+}
+
+namespace {
+    void nonOwningDeleter(char*, std::size_t) {}
+}
+
+Containers::Array<char> AbstractImporter::nonOwningArray(const Containers::ArrayView<const char> memory) {
+    return Containers::Array<char>{const_cast<char*>(memory.data()), memory.size(), nonOwningDeleter};
+}
+
+Containers::Array<char> AbstractImporter::allocateData(const std::size_t size) {
+    return _arrayPool ? _arrayPool->allocate(size) : Containers::Array<char>{size};
+}
+
 bool AbstractImporter::openFile(const std::string& filename) {
     close();
     doOpenFile(filename);
+
+    /* The plugin might not read the file through openData(), so read it again
+       for the hash. Done only if there's a cache, which is expected to save
+       much more time than this takes. */
+    if(isOpened() && AssetCache::current() && Utility::Directory::fileExists(filename))
+        updateCacheKey(Utility::Directory::read(filename));
     return isOpened();
 }
 
@@ -85,6 +121,11 @@ void AbstractImporter::close() {
         doClose();
         CORRADE_INTERNAL_ASSERT(!isOpened());
     }
+    _cacheKey.clear();
+}
+
+void AbstractImporter::updateCacheKey(const Containers::ArrayView<const char> data) {
+    if(AssetCache::current()) _cacheKey = AssetCache::key(data, plugin());
 }
 
 Int AbstractImporter::defaultScene() {
@@ -304,6 +345,18 @@ std::optional<MeshData3D> AbstractImporter::mesh3D(const UnsignedInt id) {
 
 std::optional<MeshData3D> AbstractImporter::doMesh3D(UnsignedInt) { return std::nullopt; }
 
+std::optional<MeshData> AbstractImporter::interleavedMesh3D(const UnsignedInt id) {
+    CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::interleavedMesh3D(): no file opened", {});
+    CORRADE_ASSERT(id < doMesh3DCount(), "Trade::AbstractImporter::interleavedMesh3D(): index out of range", {});
+    return doInterleavedMesh3D(id);
+}
+
+std::optional<MeshData> AbstractImporter::doInterleavedMesh3D(const UnsignedInt id) {
+    std::optional<MeshData3D> data = doMesh3D(id);
+    if(!data) return std::nullopt;
+    return MeshData{*data};
+}
+
 UnsignedInt AbstractImporter::materialCount() const {
     CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::materialCount(): no file opened", {});
     return doMaterialCount();
@@ -419,7 +472,16 @@ std::string AbstractImporter::doImage2DName(UnsignedInt) { return {}; }
 std::optional<ImageData2D> AbstractImporter::image2D(const UnsignedInt id) {
     CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::image2D(): no file opened", {});
     CORRADE_ASSERT(id < doImage2DCount(), "Trade::AbstractImporter::image2D(): index out of range", {});
-    return doImage2D(id);
+
+    AssetCache* const cache = AssetCache::current();
+    if(!cache || _cacheKey.empty()) return doImage2D(id);
+
+    const std::string key = AssetCache::key({_cacheKey.data(), _cacheKey.size()}, "image2D/" + std::to_string(id));
+    if(std::optional<ImageData2D> image = cache->loadImage(key)) return image;
+
+    std::optional<ImageData2D> image = doImage2D(id);
+    if(image && !image->isCompressed()) cache->saveImage(key, *image);
+    return image;
 }
 
 std::optional<ImageData2D> AbstractImporter::doImage2D(UnsignedInt) { return std::nullopt; }
@@ -49,8 +49,9 @@ data. See @ref plugins for more information and `*Importer` classes in
 
 ## Subclassing
 
-Plugin implements function @ref doFeatures(), @ref doIsOpened(), one of or both
-@ref doOpenData() and @ref doOpenFile() functions, function @ref doClose() and
+Plugin implements function @ref doFeatures(), @ref doIsOpened(), one or more
+of @ref doOpenData(), @ref doOpenMemory() and @ref doOpenFile() functions,
+function @ref doClose() and
 one or more tuples of data access functions, based on which features are
 supported in given format.
 
@@ -66,18 +67,40 @@ checked by the implementation:
     previous file was closed, function @ref doClose() is called only if there
     is any file opened.
 -   Function @ref doOpenData() is called only if @ref Feature::OpenData is
-    supported.
+    supported, function @ref doOpenMemory() is called only if
+    @ref Feature::OpenMemory is supported.
 -   All `do*()` implementations working on opened file are called only if there
     is any file opened.
 -   All `do*()` implementations taking data ID as parameter are called only if
     the ID is from valid range.
 
+Implementations have to keep all state in the importer instance and must not
+modify any global state, so separate instances can be used concurrently, as
+described below.
+
 Plugin interface string is `"cz.mosra.magnum.Trade.AbstractImporter/0.3"`.
 
+@anchor AbstractImporter-thread-safety
+## Thread safety
+
+A single importer instance may not be used from more than one thread at a
+time. Separate instances, even of the same plugin coming from the same plugin
+manager, can be used from different threads concurrently without any locking.
+All importer plugins shipped with Magnum satisfy this guarantee. The
+@ref Corrade::PluginManager::Manager itself is however not thread-safe, use
+@ref threadSafeInstance() to create and destroy importer instances from
+multiple threads. Plugins that load other plugins while opening files use
+their manager and thus can't be used concurrently.
+
+Plugins should allocate decoded image data using @ref allocateData(), which
+takes the memory from the pool set using @ref setArrayPool(), if any.
+
 @attention @ref Corrade::Containers::Array instances returned from the plugin
     should *not* use anything else than the default deleter, otherwise this can
     cause dangling function pointer call on array destruction if the plugin
-    gets unloaded before the array is destroyed.
+    gets unloaded before the array is destroyed. Arrays referencing memory
+    passed to @ref openMemory() can be created using @ref nonOwningArray(),
+    arrays returned from @ref allocateData() are safe in this regard as well.
 
 @todo How to handle casting from std::unique_ptr<> in more convenient way?
 */
@@ -92,7 +115,13 @@ class MAGNUM_EXPORT AbstractImporter: public PluginManager::AbstractManagingPlug
          */
         enum class Feature: UnsignedByte {
             /** Opening files from raw data using @ref openData() */
-            OpenData = 1 << 0
+            OpenData = 1 << 0,
+
+            /**
+             * Opening files from memory which is kept in scope by the caller
+             * using @ref openMemory()
+             */
+            OpenMemory = 1 << 1
         };
 
         /** @brief Set of features supported by this importer */
@@ -123,6 +152,22 @@ class MAGNUM_EXPORT AbstractImporter: public PluginManager::AbstractManagingPlug
          */
         bool openData(Containers::ArrayView<const char> data);
 
+        /**
+         * @brief Open memory
+         *
+         * Closes previous file, if it was opened, and tries to open given
+         * memory. Available only if @ref Feature::OpenMemory is supported.
+         * Returns `true` on success, `false` otherwise.
+         *
+         * Unlike @ref openData(), the importer is allowed to reference the
+         * memory instead of copying it and imported data can reference it as
+         * well. The caller has to ensure the memory stays in scope and is not
+         * modified until the importer is closed and all data imported from it
+         * are destroyed.
+         * @see @ref features(), @ref openFile()
+         */
+        bool openMemory(Containers::ArrayView<const char> memory);
+
         /**
          * @brief Open file
          *
@@ -135,6 +180,35 @@ class MAGNUM_EXPORT AbstractImporter: public PluginManager::AbstractManagingPlug
         /** @brief Close file */
         void close();
 
+        /** @brief Array pool used for imported data */
+        ArrayPool* arrayPool() const { return _arrayPool; }
+
+        /**
+         * @brief Set array pool used for imported data
+         * @return Reference to self (for method chaining)
+         *
+         * If set, plugins decode image data into arrays allocated from given
+         * pool, so the memory gets reused when the data are destroyed instead
+         * of being allocated anew for each image. The pool has to outlive all
+         * data imported with it. Default is `nullptr`, meaning the data are
+         * allocated on the heap.
+         */
+        AbstractImporter& setArrayPool(ArrayPool* pool) {
+            _arrayPool = pool;
+            return *this;
+        }
+
+        /**
+         * @brief Cache key of opened data
+         *
+         * If @ref AssetCache::current() was set when the data were opened,
+         * returns @ref AssetCache::key() of the data together with plugin
+         * name, otherwise an empty string. Only the opened file is hashed,
+         * not any external files it references. Use it for caching data
+         * derived from the file, see @ref AssetCache for more information.
+         */
+        const std::string& cacheKey() const { return _cacheKey; }
+
         /** @{ @name Data accessors
          * Each function tuple provides access to given data.
          */
@@ -339,6 +413,20 @@ class MAGNUM_EXPORT AbstractImporter: public PluginManager::AbstractManagingPlug
          */
         std::optional<MeshData3D> mesh3D(UnsignedInt id);
 
+        /**
+         * @brief Three-dimensional mesh as interleaved data
+         * @param id        Mesh ID, from range [0, @ref mesh3DCount()).
+         *
+         * Returns given mesh in a single contiguous vertex array, suitable
+         * for uploading with
+         * @ref MeshTools::compile(const Trade::MeshData&, BufferUsage), or
+         * `std::nullopt` if importing failed. Importers that store the data
+         * interleaved can provide them without any intermediate copies,
+         * otherwise the result of @ref mesh3D() is converted using
+         * @ref MeshData::MeshData(const MeshData3D&).
+         */
+        std::optional<MeshData> interleavedMesh3D(UnsignedInt id);
+
         /** @brief Material count */
         UnsignedInt materialCount() const;
 
@@ -443,7 +531,11 @@ class MAGNUM_EXPORT AbstractImporter: public PluginManager::AbstractManagingPlug
          * @brief Two-dimensional image
          * @param id        Image ID, from range [0, @ref image2DCount()).
          *
-         * Returns given image or `std::nullopt` if importing failed.
+         * Returns given image or `std::nullopt` if importing failed. If
+         * @ref AssetCache::current() is set and the data were opened while it
+         * was, the image is taken from the cache if possible and saved there
+         * otherwise. Images loaded from the cache have no importer state.
+         * @see @ref cacheKey()
          */
         std::optional<ImageData2D> image2D(UnsignedInt id);
 
@@ -502,6 +594,24 @@ class MAGNUM_EXPORT AbstractImporter: public PluginManager::AbstractManagingPlug
          */
         virtual void doOpenFile(const std::string& filename);
 
+        /**
+         * @brief Create a non-owning array
+         *
+         * Returns an array referencing given memory, which doesn't delete it
+         * on destruction. Meant for returning data referencing memory passed
+         * to @ref doOpenMemory(). The deleter is implemented in the library,
+         * so the array can be safely used even after the plugin is unloaded.
+         */
+        static Containers::Array<char> nonOwningArray(Containers::ArrayView<const char> memory);
+
+        /**
+         * @brief Allocate an array for imported data
+         *
+         * Allocates from @ref arrayPool(), if set, otherwise on the heap. The
+         * contents are not initialized.
+         */
+        Containers::Array<char> allocateData(std::size_t size);
+
     #ifndef DOXYGEN_GENERATING_OUTPUT
     private:
     #else
@@ -516,6 +626,9 @@ class MAGNUM_EXPORT AbstractImporter: public PluginManager::AbstractManagingPlug
         /** @brief Implementation for @ref openData() */
         virtual void doOpenData(Containers::ArrayView<const char> data);
 
+        /** @brief Implementation for @ref openMemory() */
+        virtual void doOpenMemory(Containers::ArrayView<const char> memory);
+
         /** @brief Implementation for @ref close() */
         virtual void doClose() = 0;
 
@@ -694,6 +807,13 @@ class MAGNUM_EXPORT AbstractImporter: public PluginManager::AbstractManagingPlug
         /** @brief Implementation for @ref mesh3D() */
         virtual std::optional<MeshData3D> doMesh3D(UnsignedInt id);
 
+        /**
+         * @brief Implementation for @ref interleavedMesh3D()
+         *
+         * Default implementation converts the output of @ref doMesh3D().
+         */
+        virtual std::optional<MeshData> doInterleavedMesh3D(UnsignedInt id);
+
         /**
          * @brief Implementation for @ref materialCount()
          *
@@ -816,6 +936,12 @@ class MAGNUM_EXPORT AbstractImporter: public PluginManager::AbstractManagingPlug
 
         /** @brief Implementation for @ref importerState() */
         virtual const void* doImporterState() const;
+
+    private:
+        void MAGNUM_LOCAL updateCacheKey(Containers::ArrayView<const char> data);
+
+        std::string _cacheKey;
+        ArrayPool* _arrayPool{};
 };
 
 CORRADE_ENUMSET_OPERATORS(AbstractImporter::Features)
@@ -0,0 +1,280 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "AssetCache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <tuple>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/MurmurHash2.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Trade/ImageData.h"
+
+namespace Magnum { namespace Trade {
+
+namespace {
+
+AssetCache* currentCache = nullptr;
+
+/* Every file starts with magic, format version, user version and entry type */
+enum: std::size_t { HeaderSize = 16 };
+constexpr const char Magic[]{'M', 'A', 'C', 'E'};
+
+enum: UnsignedInt {
+    TypeData = 0,
+    TypeImage2D = 1
+};
+
+/* Image entries additionally have format, type and size */
+enum: std::size_t { ImageHeaderSize = 16 };
+
+constexpr const char IndexFilename[] = "index.txt";
+
+}
+
+AssetCache* AssetCache::current() { return currentCache; }
+
+void AssetCache::setCurrent(AssetCache* const cache) {
+    currentCache = cache;
+}
+
+std::string AssetCache::key(const Containers::ArrayView<const char> data, const std::string& pipeline) {
+    /* Two differently seeded hashes of the data to make collisions less
+       probable, size is included so truncated data are detected also in case
+       of a hash collision */
+    std::ostringstream out;
+    out << data.size() << '-';
+    for(const std::size_t seed: {std::size_t{0}, std::size_t{0x9e3779b9}}) {
+        out << Utility::MurmurHash2{seed}(data.data(), data.size()).hexString();
+        if(!pipeline.empty())
+            out << Utility::MurmurHash2{seed}(pipeline).hexString();
+    }
+    return out.str();
+}
+
+AssetCache::AssetCache(std::string directory, const UnsignedInt version, const std::size_t maxSize): _directory{std::move(directory)}, _version{version}, _maxSize{maxSize}, _size{}, _hitCount{}, _missCount{}, _indexDirty{} {
+    /* Each line of the index is `size<TAB>key`, least recently used first */
+    std::ifstream in{Utility::Directory::join(_directory, IndexFilename)};
+    std::string line;
+    while(std::getline(in, line)) {
+        const std::size_t separator = line.find('\t');
+        if(separator == std::string::npos) continue;
+        const std::size_t size = std::stoull(line.substr(0, separator));
+        _entries.emplace_back(line.substr(separator + 1), size);
+        _size += size;
+    }
+}
+
+AssetCache::~AssetCache() {
+    if(currentCache == this) currentCache = nullptr;
+
+    if(!_indexDirty || !Utility::Directory::mkpath(_directory)) return;
+    std::ofstream out{Utility::Directory::join(_directory, IndexFilename)};
+    for(const auto& entry: _entries)
+        out << entry.second << '\t' << entry.first << '\n';
+}
+
+AssetCache& AssetCache::setMaxSize(const std::size_t size) {
+    std::lock_guard<std::mutex> lock{_mutex};
+    _maxSize = size;
+    evictInternal();
+    return *this;
+}
+
+std::size_t AssetCache::size() const {
+    std::lock_guard<std::mutex> lock{_mutex};
+    return _size;
+}
+
+std::size_t AssetCache::count() const {
+    std::lock_guard<std::mutex> lock{_mutex};
+    return _entries.size();
+}
+
+std::string AssetCache::filename(const std::string& key) const {
+    return Utility::Directory::join(_directory, key + ".bin");
+}
+
+AssetCache::Iterator AssetCache::find(const std::string& key) {
+    return std::find_if(_entries.begin(), _entries.end(), [&key](const std::pair<std::string, std::size_t>& entry) {
+        return entry.first == key;
+    });
+}
+
+void AssetCache::removeInternal(const Iterator it) {
+    Utility::Directory::rm(filename(it->first));
+    _size -= it->second;
+    _entries.erase(it);
+    _indexDirty = true;
+}
+
+void AssetCache::evictInternal() {
+    if(!_maxSize) return;
+    while(_size > _maxSize && !_entries.empty())
+        removeInternal(_entries.begin());
+}
+
+Containers::Array<char> AssetCache::loadInternal(const std::string& key, const UnsignedInt type) {
+    std::lock_guard<std::mutex> lock{_mutex};
+
+    const std::string file = filename(key);
+    const Iterator found = find(key);
+    Containers::Array<char> data;
+    if(Utility::Directory::fileExists(file))
+        data = Utility::Directory::read(file);
+
+    /* Check the header, remove the file if it's of a different version or
+       otherwise invalid */
+    UnsignedInt header[3]{};
+    if(data.size() >= HeaderSize)
+        std::memcpy(header, data + sizeof(Magic), sizeof(header));
+    if(data.size() < HeaderSize || std::memcmp(data, Magic, sizeof(Magic)) != 0 || header[0] != FormatVersion || header[1] != _version || header[2] != type) {
+        if(found != _entries.end()) removeInternal(found);
+        else if(data) Utility::Directory::rm(file);
+        ++_missCount;
+        return nullptr;
+    }
+
+    /* Mark the entry as most recently used. If the file is not in the index
+       (e.g. the index was not written due to a crash), add it. */
+    if(found != _entries.end()) std::rotate(found, found + 1, _entries.end());
+    else {
+        _entries.emplace_back(key, data.size());
+        _size += data.size();
+    }
+    _indexDirty = true;
+
+    ++_hitCount;
+    Containers::Array<char> out{data.size() - HeaderSize};
+    std::copy(data + HeaderSize, data.end(), out.begin());
+    return out;
+}
+
+bool AssetCache::saveInternal(const std::string& key, const UnsignedInt type, const Containers::ArrayView<const char> header, const Containers::ArrayView<const char> data) {
+    std::lock_guard<std::mutex> lock{_mutex};
+
+    const std::size_t size = HeaderSize + header.size() + data.size();
+    if(_maxSize && size > _maxSize) return false;
+
+    const Iterator found = find(key);
+    if(found != _entries.end()) removeInternal(found);
+
+    Containers::Array<char> out{size};
+    const UnsignedInt fileHeader[]{FormatVersion, _version, type};
+    std::memcpy(out, Magic, sizeof(Magic));
+    std::memcpy(out + sizeof(Magic), fileHeader, sizeof(fileHeader));
+    std::copy(header.begin(), header.end(), out + HeaderSize);
+    std::copy(data.begin(), data.end(), out + HeaderSize + header.size());
+
+    if(!Utility::Directory::mkpath(_directory) || !Utility::Directory::write(filename(key), out))
+        return false;
+
+    _entries.emplace_back(key, size);
+    _size += size;
+    _indexDirty = true;
+    evictInternal();
+    return true;
+}
+
+Containers::Array<char> AssetCache::load(const std::string& key) {
+    return loadInternal(key, TypeData);
+}
+
+bool AssetCache::save(const std::string& key, const Containers::ArrayView<const char> data) {
+    return saveInternal(key, TypeData, nullptr, data);
+}
+
+std::optional<ImageData2D> AssetCache::loadImage(const std::string& key) {
+    Containers::Array<char> data = loadInternal(key, TypeImage2D);
+    if(data.size() < ImageHeaderSize) return std::nullopt;
+
+    UnsignedInt header[4];
+    std::memcpy(header, data, sizeof(header));
+    const PixelFormat format = PixelFormat(header[0]);
+    const PixelType type = PixelType(header[1]);
+    const Vector2i size{Int(header[2]), Int(header[3])};
+
+    /* Verify the size to not return an image with too little data if the
+       file got truncated */
+    const std::size_t rowSize = size.x()*PixelStorage::pixelSize(format, type);
+    const std::size_t dataSize = (rowSize + 3)/4*4*size.y();
+    if(data.size() - ImageHeaderSize != dataSize) return std::nullopt;
+
+    Containers::Array<char> pixels{dataSize};
+    std::copy(data + ImageHeaderSize, data.end(), pixels.begin());
+    return ImageData2D{format, type, size, std::move(pixels)};
+}
+
+bool AssetCache::saveImage(const std::string& key, const ImageView2D& image) {
+    if(!image.data()) return false;
+
+    /* Repack the rows to default pixel storage, i.e. four-byte alignment */
+    const Vector2i size = image.size();
+    const std::size_t rowSize = size.x()*image.pixelSize();
+    const std::size_t outputStride = (rowSize + 3)/4*4;
+    Containers::Array<char> data{Containers::ValueInit, outputStride*size.y()};
+    {
+        Math::Vector2<std::size_t> dataOffset, dataSize;
+        std::size_t dataPixelSize;
+        std::tie(dataOffset, dataSize, dataPixelSize) = image.dataProperties();
+        const char* const input = image.data<char>() + dataOffset.sum();
+        for(std::size_t y = 0; y != std::size_t(size.y()); ++y)
+            std::memcpy(data + y*outputStride, input + y*dataSize.x(), rowSize);
+    }
+
+    const UnsignedInt header[]{UnsignedInt(image.format()), UnsignedInt(image.type()), UnsignedInt(size.x()), UnsignedInt(size.y())};
+    static_assert(sizeof(header) == ImageHeaderSize, "wrong image header size");
+    return saveInternal(key, TypeImage2D, {reinterpret_cast<const char*>(header), sizeof(header)}, data);
+}
+
+void AssetCache::remove(const std::string& key) {
+    std::lock_guard<std::mutex> lock{_mutex};
+    const Iterator found = find(key);
+    if(found != _entries.end()) removeInternal(found);
+    else Utility::Directory::rm(filename(key));
+}
+
+void AssetCache::clear() {
+    std::lock_guard<std::mutex> lock{_mutex};
+
+    /* Remove also files that are not in the index */
+    for(const std::string& file: Utility::Directory::list(_directory, Utility::Directory::Flag::SkipDirectories|Utility::Directory::Flag::SkipDotAndDotDot)) {
+        if(file.size() > 4 && file.compare(file.size() - 4, 4, ".bin") == 0)
+            Utility::Directory::rm(Utility::Directory::join(_directory, file));
+    }
+
+    _entries.clear();
+    _size = 0;
+    _indexDirty = true;
+}
+
+}}
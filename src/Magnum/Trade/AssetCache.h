@@ -0,0 +1,233 @@
+#ifndef Magnum_Trade_AssetCache_h
+#define Magnum_Trade_AssetCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::AssetCache
+ */
+
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Trade/Trade.h"
+#include "Magnum/visibility.h"
+#include "MagnumExternal/Optional/optional.hpp"
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Disk cache of derived assets
+
+Stores results of deterministic asset processing in given directory, so they
+don't need to be computed again on next application start. Entries are keyed
+by a hash of the input data together with a name of the processing pipeline,
+see @ref key().
+
+## Usage
+
+Create the cache and make it current. All importers then transparently cache
+the decoded images in @ref AbstractImporter::image2D():
+@code
+Trade::AssetCache cache{Utility::Directory::join(Utility::Directory::configurationDir("MyApp"), "assets"), 1, 256*1024*1024};
+Trade::AssetCache::setCurrent(&cache);
+
+importer->openFile("texture.tga");
+std::optional<Trade::ImageData2D> image = importer->image2D(0); // from the cache, if possible
+@endcode
+
+Processed meshes are cached in the native @ref MeshTools::MeshBlob format
+using @ref MeshTools::cachedMeshBlob(), which runs the processing only on a
+cache miss. Custom data can be stored with @ref save() and retrieved with
+@ref load().
+
+## Versioning and eviction
+
+Every entry is stored in a separate file together with @ref FormatVersion and
+the user-supplied @ref version(). Entries with a different version are treated
+as a miss and removed, so bumping the version after changing the processing
+code invalidates the whole cache. If @ref maxSize() is non-zero, least
+recently used entries are removed on @ref save() until the total size fits
+into the limit. The usage order is kept in an index file in the cache
+directory, which is written on destruction.
+
+All functions are thread-safe, so the cache can be used from importers
+running in multiple threads, such as in @ref BatchImageConverter. Sharing one
+cache directory between multiple processes at the same time is not supported.
+*/
+class MAGNUM_EXPORT AssetCache {
+    public:
+        enum: UnsignedInt {
+            FormatVersion = 1   /**< Version of the entry file format */
+        };
+
+        /**
+         * @brief Current cache
+         *
+         * If no cache is current, returns `nullptr`.
+         * @see @ref setCurrent()
+         */
+        static AssetCache* current();
+
+        /**
+         * @brief Make a cache current
+         *
+         * Pass `nullptr` to disable caching.
+         */
+        static void setCurrent(AssetCache* cache);
+
+        /**
+         * @brief Cache key for given data
+         *
+         * Hash of @p data and their size together with @p pipeline, which
+         * should uniquely describe the processing done on the data. The
+         * returned key can be used as @p data for a nested key, for example
+         * when multiple assets are derived from the same file.
+         */
+        static std::string key(Containers::ArrayView<const char> data, const std::string& pipeline = {});
+
+        /**
+         * @brief Constructor
+         * @param directory     Directory where to store the entries. Created
+         *      on first save, if it doesn't exist.
+         * @param version       User-defined version of the processing
+         * @param maxSize       Max total size of all entries in bytes, `0`
+         *      means unlimited
+         */
+        explicit AssetCache(std::string directory, UnsignedInt version = 0, std::size_t maxSize = 0);
+
+        /** @brief Copying is not allowed */
+        AssetCache(const AssetCache&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Writes the index file. If the cache is current, the current cache
+         * is reset to `nullptr`.
+         */
+        ~AssetCache();
+
+        /** @brief Copying is not allowed */
+        AssetCache& operator=(const AssetCache&) = delete;
+
+        /** @brief Cache directory */
+        std::string directory() const { return _directory; }
+
+        /** @brief User-defined version */
+        UnsignedInt version() const { return _version; }
+
+        /** @brief Max total size of all entries */
+        std::size_t maxSize() const { return _maxSize; }
+
+        /**
+         * @brief Set max total size of all entries
+         * @return Reference to self (for method chaining)
+         *
+         * Immediately evicts the least recently used entries that don't fit
+         * into the new limit. `0` means unlimited.
+         */
+        AssetCache& setMaxSize(std::size_t size);
+
+        /** @brief Total size of all entries in bytes */
+        std::size_t size() const;
+
+        /** @brief Count of entries */
+        std::size_t count() const;
+
+        /**
+         * @brief Load an entry
+         *
+         * Returns empty array if there's no entry for given key or if it was
+         * saved with a different version.
+         */
+        Containers::Array<char> load(const std::string& key);
+
+        /**
+         * @brief Save an entry
+         * @return `true` if the entry was saved, `false` otherwise
+         *
+         * Replaces an existing entry with the same key. An entry larger than
+         * @ref maxSize() is not saved.
+         */
+        bool save(const std::string& key, Containers::ArrayView<const char> data);
+
+        /**
+         * @brief Load an image
+         *
+         * Returns @ref std::nullopt if there's no image entry for given key.
+         * The returned image has default @ref PixelStorage parameters and
+         * thus can be directly uploaded to a texture.
+         */
+        std::optional<ImageData2D> loadImage(const std::string& key);
+
+        /**
+         * @brief Save an image
+         * @return `true` if the image was saved, `false` otherwise
+         *
+         * The pixels are stored with default @ref PixelStorage parameters,
+         * regardless of what storage the image uses.
+         */
+        bool saveImage(const std::string& key, const ImageView2D& image);
+
+        /** @brief Remove an entry */
+        void remove(const std::string& key);
+
+        /** @brief Remove all entries */
+        void clear();
+
+        /** @brief Count of successful loads */
+        UnsignedInt hitCount() const { return _hitCount; }
+
+        /** @brief Count of failed loads */
+        UnsignedInt missCount() const { return _missCount; }
+
+    private:
+        typedef std::vector<std::pair<std::string, std::size_t>>::iterator Iterator;
+
+        std::string MAGNUM_LOCAL filename(const std::string& key) const;
+        MAGNUM_LOCAL Iterator find(const std::string& key);
+        void MAGNUM_LOCAL removeInternal(Iterator it);
+        void MAGNUM_LOCAL evictInternal();
+        bool MAGNUM_LOCAL saveInternal(const std::string& key, UnsignedInt type, Containers::ArrayView<const char> header, Containers::ArrayView<const char> data);
+        Containers::Array<char> MAGNUM_LOCAL loadInternal(const std::string& key, UnsignedInt type);
+
+        std::string _directory;
+        UnsignedInt _version;
+        std::size_t _maxSize, _size;
+        UnsignedInt _hitCount, _missCount;
+        bool _indexDirty;
+        mutable std::mutex _mutex;
+
+        /* Key and file size, least recently used first */
+        std::vector<std::pair<std::string, std::size_t>> _entries;
+};
+
+}}
+
+#endif
@@ -0,0 +1,231 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BatchImageConverter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/MurmurHash2.h>
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#endif
+
+#include "Magnum/Trade/AbstractImageConverter.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/ThreadSafeInstance.h"
+
+namespace Magnum { namespace Trade {
+
+namespace {
+
+typedef std::unordered_map<std::string, std::string> Cache;
+
+inline std::string cacheKey(const BatchImageConverter::Job& job) {
+    return job.input + '\t' + job.output;
+}
+
+/* Each line is `hash<TAB>input<TAB>output`, the key is the rest after the
+   first tab */
+Cache readCache(const std::string& filename) {
+    Cache cache;
+    std::ifstream in{filename};
+    std::string line;
+    while(std::getline(in, line)) {
+        const std::size_t separator = line.find('\t');
+        if(separator == std::string::npos) continue;
+        cache.emplace(line.substr(separator + 1), line.substr(0, separator));
+    }
+    return cache;
+}
+
+bool writeCache(const std::string& filename, const Cache& cache) {
+    std::ofstream out{filename};
+    for(const auto& entry: cache)
+        out << entry.second << '\t' << entry.first << '\n';
+    return out.good();
+}
+
+/* Size is included so truncated files are detected even in case of a hash
+   collision */
+std::string contentHash(const Containers::ArrayView<const char> data) {
+    std::ostringstream out;
+    out << data.size() << ':' << Utility::MurmurHash2{}(data.data(), data.size()).hexString();
+    return out.str();
+}
+
+std::size_t fileSize(const std::string& filename) {
+    std::ifstream in{filename, std::ifstream::binary|std::ifstream::ate};
+    return in ? std::size_t(in.tellg()) : 0;
+}
+
+inline Float secondsSince(const std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<Float>(std::chrono::steady_clock::now() - start).count();
+}
+
+}
+
+BatchImageConverter::BatchImageConverter(ImporterFactory importerFactory, ConverterFactory converterFactory, std::size_t threadCount): _importerFactory{std::move(importerFactory)}, _converterFactory{std::move(converterFactory)}, _threadCount{threadCount} {
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    if(!_threadCount) _threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    #else
+    _threadCount = 1;
+    #endif
+}
+
+BatchImageConverter& BatchImageConverter::setTransformation(Transformation transformation) {
+    _transformation = std::move(transformation);
+    return *this;
+}
+
+BatchImageConverter& BatchImageConverter::setCacheFile(const std::string& filename) {
+    _cacheFile = filename;
+    return *this;
+}
+
+std::vector<BatchImageConverter::Result> BatchImageConverter::convert(const std::vector<Job>& jobs) {
+    const Cache cache = _cacheFile.empty() || !Utility::Directory::fileExists(_cacheFile) ? Cache{} : readCache(_cacheFile);
+
+    std::vector<Result> results(jobs.size());
+    std::vector<std::string> hashes(jobs.size());
+    std::atomic<std::size_t> nextJob{0};
+
+    auto work = [&]() {
+        /* Created lazily, so nothing is instanced if all files are skipped */
+        std::unique_ptr<AbstractImporter> importer;
+        std::unique_ptr<AbstractImageConverter> converter;
+
+        for(std::size_t i; (i = nextJob.fetch_add(1, std::memory_order_relaxed)) < jobs.size(); ) {
+            const Job& job = jobs[i];
+            Result& result = results[i];
+            result = Result{Status::ImportFailed, 0, 0, 0.0f, 0.0f, 0.0f};
+
+            /* Read the file only once for both hashing and importing */
+            auto start = std::chrono::steady_clock::now();
+            const Containers::Array<char> data = Utility::Directory::read(job.input);
+            result.inputSize = data.size();
+            if(!data) {
+                Error() << "Trade::BatchImageConverter::convert(): cannot read file" << job.input;
+                continue;
+            }
+
+            hashes[i] = contentHash(data);
+            auto found = cache.find(cacheKey(job));
+            if(found != cache.end() && found->second == hashes[i] && Utility::Directory::fileExists(job.output)) {
+                result.status = Status::Skipped;
+                result.outputSize = fileSize(job.output);
+                continue;
+            }
+
+            if(!importer || !converter) {
+                std::lock_guard<std::mutex> lock{Implementation::pluginManagerMutex()};
+                if(!importer) importer = _importerFactory();
+                if(!converter) converter = _converterFactory();
+            }
+            if(!importer) {
+                Error() << "Trade::BatchImageConverter::convert(): cannot create importer for" << job.input;
+                continue;
+            }
+            if(!converter) {
+                Error() << "Trade::BatchImageConverter::convert(): cannot create converter for" << job.output;
+                result.status = Status::ExportFailed;
+                continue;
+            }
+
+            /* Fall back to opening the file again if the importer can't open
+               data */
+            std::optional<ImageData2D> image;
+            if(importer->features() & AbstractImporter::Feature::OpenData ? importer->openData(data) : importer->openFile(job.input))
+                image = importer->image2D(0);
+            importer->close();
+            result.importDuration = secondsSince(start);
+            if(!image) continue;
+
+            if(_transformation) {
+                start = std::chrono::steady_clock::now();
+                const bool transformed = _transformation(*image);
+                result.transformationDuration = secondsSince(start);
+                if(!transformed) {
+                    result.status = Status::TransformationFailed;
+                    continue;
+                }
+            }
+
+            start = std::chrono::steady_clock::now();
+            const bool exported = converter->exportToFile(*image, job.output);
+            result.exportDuration = secondsSince(start);
+            if(!exported) {
+                result.status = Status::ExportFailed;
+                continue;
+            }
+
+            result.status = Status::Converted;
+            result.outputSize = fileSize(job.output);
+        }
+
+        /* Destroying the instances modifies the plugin manager as well */
+        std::lock_guard<std::mutex> lock{Implementation::pluginManagerMutex()};
+        importer = nullptr;
+        converter = nullptr;
+    };
+
+    /* The calling thread takes part in the work too */
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    std::vector<std::thread> threads;
+    const std::size_t threadCount = std::min(_threadCount, jobs.size());
+    for(std::size_t i = 1; i < threadCount; ++i)
+        threads.emplace_back(work);
+    work();
+    for(std::thread& thread: threads) thread.join();
+    #else
+    work();
+    #endif
+
+    /* Update the cache, keeping entries for files not converted this time
+       and removing entries for failed files */
+    if(!_cacheFile.empty()) {
+        Cache updated = cache;
+        for(std::size_t i = 0; i != jobs.size(); ++i) {
+            if(results[i].status == Status::Converted || results[i].status == Status::Skipped)
+                updated[cacheKey(jobs[i])] = hashes[i];
+            else updated.erase(cacheKey(jobs[i]));
+        }
+
+        if(!writeCache(_cacheFile, updated))
+            Error() << "Trade::BatchImageConverter::convert(): cannot write cache file" << _cacheFile;
+    }
+
+    return results;
+}
+
+}}
@@ -0,0 +1,216 @@
+#ifndef Magnum_Trade_BatchImageConverter_h
+#define Magnum_Trade_BatchImageConverter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::BatchImageConverter
+ */
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Batch image converter
+
+Runs an importer → transformation → converter pipeline over many files
+concurrently. Each worker thread gets its own importer and converter instance,
+created using the factory functions passed in the constructor, so the plugins
+don't need to be thread-safe themselves. Example usage:
+@code
+PluginManager::Manager<Trade::AbstractImporter> importerManager;
+PluginManager::Manager<Trade::AbstractImageConverter> converterManager;
+importerManager.load("TgaImporter");
+converterManager.load("TgaImageConverter");
+
+Trade::BatchImageConverter converter{
+    [&]() { return importerManager.instance("TgaImporter"); },
+    [&]() { return converterManager.instance("TgaImageConverter"); }};
+converter.setCacheFile("textures.cache");
+
+std::vector<Trade::BatchImageConverter::Result> results = converter.convert({
+    {"brick.tga", "out/brick.tga"},
+    {"grass.tga", "out/grass.tga"}});
+@endcode
+
+## Skipping unchanged files
+
+If a cache file is set using @ref setCacheFile(), a content hash of each
+successfully converted input is saved to it. On subsequent runs, inputs with
+unchanged contents whose output still exists are not converted again and are
+reported with @ref Status::Skipped. The cache doesn't know anything about the
+importer, transformation or converter configuration, so it has to be removed if
+any of these change.
+
+## Thread safety
+
+The factory functions are called and the created instances destroyed while
+holding the same lock as @ref threadSafeInstance() uses, so it's safe to call
+@ref Corrade::PluginManager::Manager::instance() from them. The importer and
+converter instances are however used from the worker threads without any
+locking, so plugins that load other plugins while opening
+or converting files (such as `AnyImageImporter`) should be avoided for
+conversion on more than one thread. The transformation function is called
+concurrently from all worker threads.
+
+@partialsupport On @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten" all files
+    are converted on the calling thread.
+*/
+class MAGNUM_EXPORT BatchImageConverter {
+    public:
+        /** @brief Importer factory */
+        typedef std::function<std::unique_ptr<AbstractImporter>()> ImporterFactory;
+
+        /** @brief Converter factory */
+        typedef std::function<std::unique_ptr<AbstractImageConverter>()> ConverterFactory;
+
+        /**
+         * @brief Image transformation
+         *
+         * Modifies the imported image in-place before it's exported. Returns
+         * `false` if the transformation failed.
+         */
+        typedef std::function<bool(ImageData2D&)> Transformation;
+
+        /**
+         * @brief Conversion status
+         *
+         * @see @ref Result::status
+         */
+        enum class Status: UnsignedByte {
+            Converted,              /**< The file was converted */
+
+            /**
+             * The file was not converted, as neither its contents nor the
+             * output changed since the last run. See @ref setCacheFile().
+             */
+            Skipped,
+
+            /** The file can't be opened or it contains no image */
+            ImportFailed,
+
+            /** The transformation function returned `false` */
+            TransformationFailed,
+
+            /** The converter failed to export the file */
+            ExportFailed
+        };
+
+        /** @brief Conversion job */
+        struct Job {
+            std::string input;      /**< Input filename */
+            std::string output;     /**< Output filename */
+        };
+
+        /**
+         * @brief Conversion result
+         *
+         * All durations are in seconds.
+         */
+        struct Result {
+            Status status;          /**< Conversion status */
+            std::size_t inputSize;  /**< Input file size in bytes */
+            std::size_t outputSize; /**< Output file size in bytes */
+            Float importDuration;   /**< Time spent importing */
+            Float transformationDuration; /**< Time spent transforming */
+            Float exportDuration;   /**< Time spent exporting */
+        };
+
+        /**
+         * @brief Constructor
+         * @param importerFactory   Importer factory
+         * @param converterFactory  Converter factory
+         * @param threadCount       Max count of worker threads. If `0`, the
+         *      value reported by `std::thread::hardware_concurrency()` is
+         *      used.
+         */
+        explicit BatchImageConverter(ImporterFactory importerFactory, ConverterFactory converterFactory, std::size_t threadCount = 0);
+
+        /** @brief Copying is not allowed */
+        BatchImageConverter(const BatchImageConverter&) = delete;
+
+        /** @brief Moving is not allowed */
+        BatchImageConverter(BatchImageConverter&&) = delete;
+
+        /** @brief Copying is not allowed */
+        BatchImageConverter& operator=(const BatchImageConverter&) = delete;
+
+        /** @brief Moving is not allowed */
+        BatchImageConverter& operator=(BatchImageConverter&&) = delete;
+
+        /** @brief Max count of worker threads */
+        std::size_t threadCount() const { return _threadCount; }
+
+        /**
+         * @brief Set image transformation
+         * @return Reference to self (for method chaining)
+         *
+         * Default is no transformation.
+         */
+        BatchImageConverter& setTransformation(Transformation transformation);
+
+        /** @brief Cache filename */
+        std::string cacheFile() const { return _cacheFile; }
+
+        /**
+         * @brief Set cache filename
+         * @return Reference to self (for method chaining)
+         *
+         * If non-empty, the file is read at the beginning of each
+         * @ref convert() call, if it exists, and written with updated hashes
+         * at the end. Default is empty, i.e. all files are always converted.
+         * See @ref Trade-BatchImageConverter-skipping-unchanged-files
+         * "class documentation" for more information.
+         */
+        BatchImageConverter& setCacheFile(const std::string& filename);
+
+        /**
+         * @brief Convert files
+         *
+         * Converts all files in @p jobs on at most @ref threadCount() threads
+         * and blocks until everything is done. Returns conversion result for
+         * each job, in the same order.
+         */
+        std::vector<Result> convert(const std::vector<Job>& jobs);
+
+    private:
+        ImporterFactory _importerFactory;
+        ConverterFactory _converterFactory;
+        Transformation _transformation;
+        std::size_t _threadCount;
+        std::string _cacheFile;
+};
+
+}}
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef Magnum_Trade_Implementation_mapFile_h
+#define Magnum_Trade_Implementation_mapFile_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "MagnumExternal/Optional/optional.hpp"
+
+#if defined(CORRADE_TARGET_UNIX) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace Magnum { namespace Trade { namespace Implementation {
+
+#if defined(CORRADE_TARGET_UNIX) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+inline void unmapDeleter(char* const data, const std::size_t size) {
+    if(data) munmap(data, size);
+}
+#endif
+
+/* On Unix maps the file read-only into memory, falling back to reading it
+   the usual way elsewhere or if the mapping fails. Returns std::nullopt if
+   the file can't be opened. The mapping uses a custom deleter, so the data
+   can't be returned from the plugin directly. */
+inline std::optional<Containers::Array<char>> mapFile(const std::string& filename) {
+    #if defined(CORRADE_TARGET_UNIX) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    const int fd = open(filename.data(), O_RDONLY);
+    if(fd != -1) {
+        struct stat st;
+        void* data = MAP_FAILED;
+        if(fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+            data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        /* The mapping stays valid after closing the descriptor */
+        close(fd);
+        if(data != MAP_FAILED)
+            return std::optional<Containers::Array<char>>{Containers::Array<char>{static_cast<char*>(data), std::size_t(st.st_size), unmapDeleter}};
+    }
+    #endif
+
+    if(!Utility::Directory::fileExists(filename)) return std::nullopt;
+    return std::optional<Containers::Array<char>>{Utility::Directory::read(filename)};
+}
+
+}}}
+
+#endif
@@ -0,0 +1,226 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MeshData.h"
+
+#include "Magnum/Math/Color.h"
+#include "Magnum/Trade/MeshData2D.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace Trade {
+
+std::size_t meshAttributeTypeSize(const MeshAttributeType type) {
+    switch(type) {
+        case MeshAttributeType::Vector2: return sizeof(Vector2);
+        case MeshAttributeType::Vector3: return sizeof(Vector3);
+        case MeshAttributeType::Vector4: return sizeof(Vector4);
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+namespace {
+
+std::size_t indexTypeSize(const Mesh::IndexType type) {
+    switch(type) {
+        case Mesh::IndexType::UnsignedByte: return 1;
+        case Mesh::IndexType::UnsignedShort: return 2;
+        case Mesh::IndexType::UnsignedInt: return 4;
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+template<class T> void interleaveInto(char* const data, const std::size_t stride, const std::vector<T>& values) {
+    for(std::size_t i = 0; i != values.size(); ++i)
+        std::memcpy(data + i*stride, &values[i], sizeof(T));
+}
+
+Containers::Array<char> copyIndices(const std::vector<UnsignedInt>& indices) {
+    Containers::Array<char> data{indices.size()*sizeof(UnsignedInt)};
+    if(!indices.empty()) std::memcpy(data, indices.data(), data.size());
+    return data;
+}
+
+}
+
+MeshData::MeshData(const MeshPrimitive primitive, const Mesh::IndexType indexType, Containers::Array<char>&& indexData, const UnsignedInt vertexCount, Containers::Array<char>&& vertexData, std::vector<MeshAttributeData> attributes, const void* const importerState): _primitive{primitive}, _indexType{indexType}, _vertexCount{vertexCount}, _indexData{std::move(indexData)}, _vertexData{std::move(vertexData)}, _attributes{std::move(attributes)}, _importerState{importerState} {
+    CORRADE_ASSERT(_indexData.size()%indexTypeSize(_indexType) == 0,
+        "Trade::MeshData: index data size" << _indexData.size() << "is not a multiple of" << _indexType << "size", );
+    #ifndef CORRADE_NO_ASSERT
+    for(const MeshAttributeData& attribute: _attributes) {
+        CORRADE_ASSERT(!_vertexCount || attribute.offset + std::size_t(_vertexCount - 1)*attribute.stride + meshAttributeTypeSize(attribute.type) <= _vertexData.size(),
+            "Trade::MeshData:" << attribute.name << "doesn't fit into" << _vertexData.size() << "bytes of vertex data", );
+    }
+    #endif
+}
+
+MeshData::MeshData(const MeshPrimitive primitive, const UnsignedInt vertexCount, Containers::Array<char>&& vertexData, std::vector<MeshAttributeData> attributes, const void* const importerState): MeshData{primitive, Mesh::IndexType::UnsignedInt, nullptr, vertexCount, std::move(vertexData), std::move(attributes), importerState} {}
+
+MeshData::MeshData(const MeshData2D& data): _primitive{data.primitive()}, _indexType{Mesh::IndexType::UnsignedInt}, _vertexCount{UnsignedInt(data.positions(0).size())}, _indexData{data.isIndexed() ? copyIndices(data.indices()) : nullptr}, _importerState{data.importerState()} {
+    /* Calculate the layout */
+    UnsignedInt stride = 0;
+    for(UnsignedInt i = 0; i != data.positionArrayCount(); ++i, stride += sizeof(Vector2))
+        _attributes.push_back({MeshAttribute::Position, MeshAttributeType::Vector2, stride, 0});
+    for(UnsignedInt i = 0; i != data.textureCoords2DArrayCount(); ++i, stride += sizeof(Vector2))
+        _attributes.push_back({MeshAttribute::TextureCoordinates, MeshAttributeType::Vector2, stride, 0});
+    for(MeshAttributeData& attribute: _attributes) attribute.stride = stride;
+
+    /* Interleave the data */
+    _vertexData = Containers::Array<char>{Containers::ValueInit, std::size_t(_vertexCount)*stride};
+    std::size_t a = 0;
+    for(UnsignedInt i = 0; i != data.positionArrayCount(); ++i, ++a)
+        interleaveInto(_vertexData + _attributes[a].offset, stride, data.positions(i));
+    for(UnsignedInt i = 0; i != data.textureCoords2DArrayCount(); ++i, ++a)
+        interleaveInto(_vertexData + _attributes[a].offset, stride, data.textureCoords2D(i));
+}
+
+MeshData::MeshData(const MeshData3D& data): _primitive{data.primitive()}, _indexType{Mesh::IndexType::UnsignedInt}, _vertexCount{UnsignedInt(data.positions(0).size())}, _indexData{data.isIndexed() ? copyIndices(data.indices()) : nullptr}, _importerState{data.importerState()} {
+    /* Calculate the layout */
+    UnsignedInt stride = 0;
+    for(UnsignedInt i = 0; i != data.positionArrayCount(); ++i, stride += sizeof(Vector3))
+        _attributes.push_back({MeshAttribute::Position, MeshAttributeType::Vector3, stride, 0});
+    for(UnsignedInt i = 0; i != data.normalArrayCount(); ++i, stride += sizeof(Vector3))
+        _attributes.push_back({MeshAttribute::Normal, MeshAttributeType::Vector3, stride, 0});
+    for(UnsignedInt i = 0; i != data.textureCoords2DArrayCount(); ++i, stride += sizeof(Vector2))
+        _attributes.push_back({MeshAttribute::TextureCoordinates, MeshAttributeType::Vector2, stride, 0});
+    for(UnsignedInt i = 0; i != data.colorArrayCount(); ++i, stride += sizeof(Color4))
+        _attributes.push_back({MeshAttribute::Color, MeshAttributeType::Vector4, stride, 0});
+    for(MeshAttributeData& attribute: _attributes) attribute.stride = stride;
+
+    /* Interleave the data */
+    _vertexData = Containers::Array<char>{Containers::ValueInit, std::size_t(_vertexCount)*stride};
+    std::size_t a = 0;
+    for(UnsignedInt i = 0; i != data.positionArrayCount(); ++i, ++a)
+        interleaveInto(_vertexData + _attributes[a].offset, stride, data.positions(i));
+    for(UnsignedInt i = 0; i != data.normalArrayCount(); ++i, ++a)
+        interleaveInto(_vertexData + _attributes[a].offset, stride, data.normals(i));
+    for(UnsignedInt i = 0; i != data.textureCoords2DArrayCount(); ++i, ++a)
+        interleaveInto(_vertexData + _attributes[a].offset, stride, data.textureCoords2D(i));
+    for(UnsignedInt i = 0; i != data.colorArrayCount(); ++i, ++a)
+        interleaveInto(_vertexData + _attributes[a].offset, stride, data.colors(i));
+}
+
+MeshData::MeshData(MeshData&&)
+    #if !defined(__GNUC__) || __GNUC__*100 + __GNUC_MINOR__ != 409
+    noexcept
+    #endif
+    = default;
+
+MeshData::~MeshData() = default;
+
+MeshData& MeshData::operator=(MeshData&&)
+    #if !defined(__GNUC__) || __GNUC__*100 + __GNUC_MINOR__ != 409
+    noexcept
+    #endif
+    = default;
+
+Mesh::IndexType MeshData::indexType() const {
+    CORRADE_ASSERT(isIndexed(), "Trade::MeshData::indexType(): the mesh is not indexed", {});
+    return _indexType;
+}
+
+UnsignedInt MeshData::indexCount() const {
+    return _indexData.size()/indexTypeSize(_indexType);
+}
+
+std::vector<UnsignedInt> MeshData::indices() const {
+    CORRADE_ASSERT(isIndexed(), "Trade::MeshData::indices(): the mesh is not indexed", {});
+
+    std::vector<UnsignedInt> out(indexCount());
+    switch(_indexType) {
+        case Mesh::IndexType::UnsignedByte:
+            for(std::size_t i = 0; i != out.size(); ++i)
+                out[i] = reinterpret_cast<const UnsignedByte*>(_indexData.data())[i];
+            break;
+        case Mesh::IndexType::UnsignedShort:
+            for(std::size_t i = 0; i != out.size(); ++i) {
+                UnsignedShort index;
+                std::memcpy(&index, _indexData + i*2, 2);
+                out[i] = index;
+            }
+            break;
+        case Mesh::IndexType::UnsignedInt:
+            std::memcpy(out.data(), _indexData, _indexData.size());
+            break;
+    }
+
+    return out;
+}
+
+const MeshAttributeData& MeshData::attribute(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _attributes.size(),
+        "Trade::MeshData::attribute(): index" << id << "out of range for" << _attributes.size() << "attributes", _attributes[0]);
+    return _attributes[id];
+}
+
+UnsignedInt MeshData::attributeCount(const MeshAttribute name) const {
+    UnsignedInt count = 0;
+    for(const MeshAttributeData& attribute: _attributes)
+        if(attribute.name == name) ++count;
+    return count;
+}
+
+Int MeshData::attributeFor(const MeshAttribute name, UnsignedInt id) const {
+    for(std::size_t i = 0; i != _attributes.size(); ++i) {
+        if(_attributes[i].name != name) continue;
+        if(id-- == 0) return i;
+    }
+
+    return -1;
+}
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+Debug& operator<<(Debug& debug, const MeshAttribute value) {
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case MeshAttribute::value: return debug << "Trade::MeshAttribute::" #value;
+        _c(Position)
+        _c(Normal)
+        _c(TextureCoordinates)
+        _c(Color)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "Trade::MeshAttribute(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const MeshAttributeType value) {
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case MeshAttributeType::value: return debug << "Trade::MeshAttributeType::" #value;
+        _c(Vector2)
+        _c(Vector3)
+        _c(Vector4)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "Trade::MeshAttributeType(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+#endif
+
+}}
@@ -0,0 +1,294 @@
+#ifndef Magnum_Trade_MeshData_h
+#define Magnum_Trade_MeshData_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::MeshData, struct @ref Magnum::Trade::MeshAttributeData, enum @ref Magnum::Trade::MeshAttribute, @ref Magnum::Trade::MeshAttributeType
+ */
+
+#include <cstring>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Mesh attribute name
+
+@see @ref MeshAttributeData
+*/
+enum class MeshAttribute: UnsignedByte {
+    Position,           /**< Position */
+    Normal,             /**< Normal */
+    TextureCoordinates, /**< Texture coordinates */
+    Color               /**< Color */
+};
+
+/** @debugoperatorenum{Magnum::Trade::MeshAttribute} */
+MAGNUM_EXPORT Debug& operator<<(Debug& debug, MeshAttribute value);
+
+/**
+@brief Mesh attribute type
+
+All types have floating-point components.
+@see @ref MeshAttributeData, @ref meshAttributeTypeSize()
+*/
+enum class MeshAttributeType: UnsignedByte {
+    Vector2,            /**< @ref Magnum::Vector2 "Vector2" */
+    Vector3,            /**< @ref Magnum::Vector3 "Vector3" or @ref Color3 */
+    Vector4             /**< @ref Magnum::Vector4 "Vector4" or @ref Color4 */
+};
+
+/** @debugoperatorenum{Magnum::Trade::MeshAttributeType} */
+MAGNUM_EXPORT Debug& operator<<(Debug& debug, MeshAttributeType value);
+
+/** @brief Size of given mesh attribute type in bytes */
+MAGNUM_EXPORT std::size_t meshAttributeTypeSize(MeshAttributeType type);
+
+/**
+@brief Mesh attribute description
+
+@see @ref MeshData
+*/
+struct MeshAttributeData {
+    MeshAttribute name;     /**< Attribute name */
+    MeshAttributeType type; /**< Attribute type */
+    UnsignedInt offset;     /**< Offset of the first element in vertex data */
+    UnsignedInt stride;     /**< Distance between two consecutive elements */
+};
+
+/**
+@brief Interleaved mesh data
+
+Unlike @ref MeshData2D and @ref MeshData3D, which store each attribute in a
+separate @ref std::vector, this class keeps all vertex data in a single
+contiguous array and describes the attributes by offset, stride and type. The
+index data are kept in a single array as well, in a type given by
+@ref indexType(). Because no interleaving needs to be done, the data can be
+uploaded to the GPU with a single @ref Buffer::setData() call, see
+@ref MeshTools::compile(const Trade::MeshData&, BufferUsage). The arrays can
+also be non-owning, so importers can reference memory-mapped file data
+directly.
+
+Attributes can be arbitrarily interleaved or even placed in separate regions
+of the vertex array. A mesh can contain more than one attribute of the same
+name, use @ref attributeFor() to find them.
+
+Use @ref AbstractImporter::interleavedMesh3D() to get the data from an
+importer, or convert existing @ref MeshData2D or @ref MeshData3D using the
+@ref MeshData(const MeshData2D&) and @ref MeshData(const MeshData3D&)
+constructors.
+*/
+class MAGNUM_EXPORT MeshData {
+    public:
+        /**
+         * @brief Construct indexed mesh data
+         * @param primitive     Primitive
+         * @param indexType     Index type
+         * @param indexData     Index data
+         * @param vertexCount   Vertex count
+         * @param vertexData    Vertex data
+         * @param attributes    Attribute description
+         * @param importerState Importer-specific state
+         *
+         * Expects that the index data size is a multiple of index type size
+         * and that all attributes fit into the vertex data.
+         */
+        explicit MeshData(MeshPrimitive primitive, Mesh::IndexType indexType, Containers::Array<char>&& indexData, UnsignedInt vertexCount, Containers::Array<char>&& vertexData, std::vector<MeshAttributeData> attributes, const void* importerState = nullptr);
+
+        /**
+         * @brief Construct non-indexed mesh data
+         * @param primitive     Primitive
+         * @param vertexCount   Vertex count
+         * @param vertexData    Vertex data
+         * @param attributes    Attribute description
+         * @param importerState Importer-specific state
+         *
+         * Expects that all attributes fit into the vertex data.
+         */
+        explicit MeshData(MeshPrimitive primitive, UnsignedInt vertexCount, Containers::Array<char>&& vertexData, std::vector<MeshAttributeData> attributes, const void* importerState = nullptr);
+
+        /**
+         * @brief Construct from 2D mesh data
+         *
+         * Interleaves all attribute arrays into a single vertex array, in
+         * order positions, texture coordinates. Indices are stored as
+         * @ref Mesh::IndexType::UnsignedInt. The importer state is copied
+         * from @p data.
+         */
+        explicit MeshData(const MeshData2D& data);
+
+        /**
+         * @brief Construct from 3D mesh data
+         *
+         * Interleaves all attribute arrays into a single vertex array, in
+         * order positions, normals, texture coordinates, colors. Colors are
+         * stored as @ref MeshAttributeType::Vector4. Indices are stored as
+         * @ref Mesh::IndexType::UnsignedInt. The importer state is copied from
+         * @p data.
+         */
+        explicit MeshData(const MeshData3D& data);
+
+        /** @brief Copying is not allowed */
+        MeshData(const MeshData&) = delete;
+
+        /** @brief Move constructor */
+        MeshData(MeshData&&)
+            /* GCC 4.9.0 (the one from Android NDK) thinks this does not match
+               the implicit signature so it can't be defaulted. Works on 4.7,
+               5.0 and everywhere else, so I don't bother. */
+            #if !defined(__GNUC__) || __GNUC__*100 + __GNUC_MINOR__ != 409
+            noexcept
+            #endif
+            ;
+
+        ~MeshData();
+
+        /** @brief Copying is not allowed */
+        MeshData& operator=(const MeshData&) = delete;
+
+        /** @brief Move assignment */
+        MeshData& operator=(MeshData&&)
+            /* GCC 4.9.0 (the one from Android NDK) thinks this does not match
+               the implicit signature so it can't be defaulted. Works on 4.7,
+               5.0 and everywhere else, so I don't bother. */
+            #if !defined(__GNUC__) || __GNUC__*100 + __GNUC_MINOR__ != 409
+            noexcept
+            #endif
+            ;
+
+        /** @brief Primitive */
+        MeshPrimitive primitive() const { return _primitive; }
+
+        /** @brief Whether the mesh is indexed */
+        bool isIndexed() const { return !_indexData.empty(); }
+
+        /**
+         * @brief Index type
+         *
+         * Expects that the mesh is indexed.
+         */
+        Mesh::IndexType indexType() const;
+
+        /** @brief Index count */
+        UnsignedInt indexCount() const;
+
+        /**
+         * @brief Index data
+         *
+         * Empty if the mesh is not indexed.
+         */
+        Containers::ArrayView<const char> indexData() const { return _indexData; }
+
+        /**
+         * @brief Indices
+         *
+         * Expands the index data to 32-bit integers. Expects that the mesh is
+         * indexed.
+         */
+        std::vector<UnsignedInt> indices() const;
+
+        /** @brief Vertex count */
+        UnsignedInt vertexCount() const { return _vertexCount; }
+
+        /** @brief Vertex data */
+        Containers::ArrayView<char> vertexData() { return _vertexData; }
+        Containers::ArrayView<const char> vertexData() const { return _vertexData; } /**< @overload */
+
+        /** @brief Attribute count */
+        UnsignedInt attributeCount() const { return _attributes.size(); }
+
+        /**
+         * @brief Attribute description
+         *
+         * Expects that @p id is less than @ref attributeCount().
+         */
+        const MeshAttributeData& attribute(UnsignedInt id) const;
+
+        /**
+         * @brief Count of attributes with given name
+         *
+         * @see @ref attributeFor()
+         */
+        UnsignedInt attributeCount(MeshAttribute name) const;
+
+        /**
+         * @brief Find attribute with given name
+         *
+         * Returns ID of @p id-th attribute with given @p name, or `-1` if
+         * there is no such attribute.
+         * @see @ref attributeCount(MeshAttribute) const
+         */
+        Int attributeFor(MeshAttribute name, UnsignedInt id = 0) const;
+
+        /**
+         * @brief Attribute data
+         *
+         * Copies out data of attribute @p id. Expects that @p id is less than
+         * @ref attributeCount() and that size of @p T matches the attribute
+         * type.
+         */
+        template<class T> std::vector<T> attributeData(UnsignedInt id) const;
+
+        /**
+         * @brief Importer-specific state
+         *
+         * See @ref AbstractImporter::importerState() for more information.
+         */
+        const void* importerState() const { return _importerState; }
+
+    private:
+        MeshPrimitive _primitive;
+        Mesh::IndexType _indexType;
+        UnsignedInt _vertexCount;
+        Containers::Array<char> _indexData, _vertexData;
+        std::vector<MeshAttributeData> _attributes;
+        const void* _importerState;
+};
+
+template<class T> std::vector<T> MeshData::attributeData(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _attributes.size(),
+        "Trade::MeshData::attributeData(): index" << id << "out of range for" << _attributes.size() << "attributes", {});
+    const MeshAttributeData& attribute = _attributes[id];
+    CORRADE_ASSERT(sizeof(T) == meshAttributeTypeSize(attribute.type),
+        "Trade::MeshData::attributeData(): can't retrieve" << attribute.type << "as a type of size" << sizeof(T), {});
+
+    std::vector<T> out(_vertexCount);
+    const char* data = _vertexData + attribute.offset;
+    for(std::size_t i = 0; i != _vertexCount; ++i, data += attribute.stride)
+        std::memcpy(&out[i], data, sizeof(T));
+    return out;
+}
+
+}}
+
+#endif
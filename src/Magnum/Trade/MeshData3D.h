@@ -60,6 +60,27 @@ class MAGNUM_EXPORT MeshData3D {
          */
         explicit MeshData3D(MeshPrimitive primitive, std::vector<UnsignedInt> indices, std::vector<std::vector<Vector3>> positions, std::vector<std::vector<Vector3>> normals, std::vector<std::vector<Vector2>> textureCoords2D, std::vector<std::vector<Color4>> colors, const void* importerState = nullptr);
 
+        /**
+         * @brief Construct skinned mesh data
+         * @param primitive         Primitive
+         * @param indices           Index array or empty array, if the mesh is
+         *      not indexed
+         * @param positions         Position arrays. At least one position
+         *      array should be present.
+         * @param normals           Normal arrays, if present
+         * @param textureCoords2D   Two-dimensional texture coordinate arrays,
+         *      if present
+         * @param colors            Vertex color arrays, if present
+         * @param jointIds          Arrays of up to four joint indices
+         *      influencing each vertex, if present
+         * @param jointWeights      Arrays of weights corresponding to
+         *      @p jointIds. Expected to have the same count as @p jointIds.
+         * @param importerState     Importer-specific state
+         *
+         * Unused joint influences should have zero weight.
+         */
+        explicit MeshData3D(MeshPrimitive primitive, std::vector<UnsignedInt> indices, std::vector<std::vector<Vector3>> positions, std::vector<std::vector<Vector3>> normals, std::vector<std::vector<Vector2>> textureCoords2D, std::vector<std::vector<Color4>> colors, std::vector<std::vector<Vector4ui>> jointIds, std::vector<std::vector<Vector4>> jointWeights, const void* importerState = nullptr);
+
         #ifdef MAGNUM_BUILD_DEPRECATED
         /** @copybrief MeshData3D(MeshPrimitive, std::vector<UnsignedInt>, std::vector<std::vector<Vector3>>, std::vector<std::vector<Vector3>>, std::vector<std::vector<Vector2>>, std::vector<std::vector<Color4>>, const void*)
          * @deprecated Use @ref MeshData3D(MeshPrimitive, std::vector<UnsignedInt>, std::vector<std::vector<Vector3>>, std::vector<std::vector<Vector3>>, std::vector<std::vector<Vector2>>, std::vector<std::vector<Color4>>, const void*) instead.
@@ -170,6 +191,32 @@ class MAGNUM_EXPORT MeshData3D {
         std::vector<Color4>& colors(UnsignedInt id);
         const std::vector<Color4>& colors(UnsignedInt id) const; /**< @overload */
 
+        /** @brief Whether the data contain any joint influences */
+        bool hasJoints() const { return !_jointIds.empty(); }
+
+        /** @brief Count of joint index and weight arrays */
+        UnsignedInt jointArrayCount() const { return _jointIds.size(); }
+
+        /**
+         * @brief Joint indices
+         * @param id    Joint array ID
+         *
+         * Up to four indices of joints influencing each vertex.
+         * @see @ref jointArrayCount(), @ref jointWeights()
+         */
+        std::vector<Vector4ui>& jointIds(UnsignedInt id);
+        const std::vector<Vector4ui>& jointIds(UnsignedInt id) const; /**< @overload */
+
+        /**
+         * @brief Joint weights
+         * @param id    Joint array ID
+         *
+         * Weights of joints in @ref jointIds() with the same @p id.
+         * @see @ref jointArrayCount()
+         */
+        std::vector<Vector4>& jointWeights(UnsignedInt id);
+        const std::vector<Vector4>& jointWeights(UnsignedInt id) const; /**< @overload */
+
         /**
          * @brief Importer-specific state
          *
@@ -184,6 +231,8 @@ class MAGNUM_EXPORT MeshData3D {
         std::vector<std::vector<Vector3>> _normals;
         std::vector<std::vector<Vector2>> _textureCoords2D;
         std::vector<std::vector<Color4>> _colors;
+        std::vector<std::vector<Vector4ui>> _jointIds;
+        std::vector<std::vector<Vector4>> _jointWeights;
         const void* _importerState;
 };
 
@@ -0,0 +1,370 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/AssetCache.h"
+#include "Magnum/Trade/ImageData.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test {
+
+struct AssetCacheTest: TestSuite::Tester {
+    explicit AssetCacheTest();
+
+    void setup();
+
+    void current();
+    void key();
+
+    void saveLoad();
+    void loadMissing();
+    void versionMismatch();
+    void replace();
+
+    void image();
+    void imageTypeMismatch();
+
+    void evict();
+    void evictTooLarge();
+    void setMaxSize();
+    void index();
+    void remove();
+    void clear();
+
+    void importerImage();
+    void importerNoCache();
+
+    private:
+        std::string _directory;
+};
+
+AssetCacheTest::AssetCacheTest(): _directory{Utility::Directory::join(TRADE_TEST_OUTPUT_DIR, "assetcache")} {
+    addTests({&AssetCacheTest::current,
+              &AssetCacheTest::key});
+
+    addTests({&AssetCacheTest::saveLoad,
+              &AssetCacheTest::loadMissing,
+              &AssetCacheTest::versionMismatch,
+              &AssetCacheTest::replace,
+
+              &AssetCacheTest::image,
+              &AssetCacheTest::imageTypeMismatch,
+
+              &AssetCacheTest::evict,
+              &AssetCacheTest::evictTooLarge,
+              &AssetCacheTest::setMaxSize,
+              &AssetCacheTest::index,
+              &AssetCacheTest::remove,
+              &AssetCacheTest::clear,
+
+              &AssetCacheTest::importerImage,
+              &AssetCacheTest::importerNoCache}, &AssetCacheTest::setup, &AssetCacheTest::setup);
+}
+
+void AssetCacheTest::setup() {
+    AssetCache{_directory}.clear();
+}
+
+namespace {
+    constexpr const char Data[]{'h', 'e', 'l', 'l', 'o'};
+    constexpr const char OtherData[]{'w', 'o', 'r', 'l', 'd', '!'};
+
+    Containers::Array<char> array(Containers::ArrayView<const char> data) {
+        Containers::Array<char> out{data.size()};
+        std::copy(data.begin(), data.end(), out.begin());
+        return out;
+    }
+}
+
+void AssetCacheTest::current() {
+    CORRADE_VERIFY(!AssetCache::current());
+    {
+        AssetCache cache{_directory};
+        AssetCache::setCurrent(&cache);
+        CORRADE_VERIFY(AssetCache::current() == &cache);
+    }
+
+    /* Destruction resets the current cache */
+    CORRADE_VERIFY(!AssetCache::current());
+}
+
+void AssetCacheTest::key() {
+    const std::string a = AssetCache::key(Data);
+    CORRADE_COMPARE(AssetCache::key(Data), a);
+    CORRADE_VERIFY(AssetCache::key(OtherData) != a);
+    CORRADE_VERIFY(AssetCache::key(Data, "tipsify") != a);
+    CORRADE_VERIFY(AssetCache::key(Data, "tipsify") != AssetCache::key(Data, "dedup"));
+
+    /* Prefix of the data has a different key */
+    CORRADE_VERIFY(AssetCache::key(Containers::ArrayView<const char>{Data}.prefix(4)) != a);
+}
+
+void AssetCacheTest::saveLoad() {
+    AssetCache cache{_directory};
+    CORRADE_VERIFY(cache.save("a", Data));
+    CORRADE_COMPARE(cache.count(), 1);
+    CORRADE_COMPARE(cache.size(), 16 + sizeof(Data));
+
+    CORRADE_COMPARE_AS(cache.load("a"), array(Data),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(cache.hitCount(), 1);
+    CORRADE_COMPARE(cache.missCount(), 0);
+}
+
+void AssetCacheTest::loadMissing() {
+    AssetCache cache{_directory};
+    CORRADE_VERIFY(!cache.load("nonexistent"));
+    CORRADE_COMPARE(cache.hitCount(), 0);
+    CORRADE_COMPARE(cache.missCount(), 1);
+}
+
+void AssetCacheTest::versionMismatch() {
+    {
+        AssetCache cache{_directory, 1};
+        CORRADE_VERIFY(cache.save("a", Data));
+    }
+
+    AssetCache cache{_directory, 2};
+    CORRADE_COMPARE(cache.count(), 1);
+    CORRADE_VERIFY(!cache.load("a"));
+    CORRADE_COMPARE(cache.missCount(), 1);
+
+    /* The stale entry got removed */
+    CORRADE_COMPARE(cache.count(), 0);
+    CORRADE_COMPARE(cache.size(), 0);
+    CORRADE_VERIFY(!Utility::Directory::fileExists(Utility::Directory::join(_directory, "a.bin")));
+}
+
+void AssetCacheTest::replace() {
+    AssetCache cache{_directory};
+    CORRADE_VERIFY(cache.save("a", Data));
+    CORRADE_VERIFY(cache.save("a", OtherData));
+    CORRADE_COMPARE(cache.count(), 1);
+    CORRADE_COMPARE(cache.size(), 16 + sizeof(OtherData));
+    CORRADE_COMPARE_AS(cache.load("a"), array(OtherData),
+        TestSuite::Compare::Container);
+}
+
+void AssetCacheTest::image() {
+    /* Three-pixel RGB rows with one-byte alignment and one skipped row, saved
+       with four-byte alignment */
+    constexpr const char pixels[]{
+        0, 0, 0, 0, 0, 0, 0, 0, 0,
+        1, 2, 3, 4, 5, 6, 7, 8, 9,
+        10, 11, 12, 13, 14, 15, 16, 17, 18
+    };
+    const ImageView2D view{PixelStorage{}.setAlignment(1).setSkip({0, 1, 0}),
+        PixelFormat::RGB, PixelType::UnsignedByte, {3, 2}, pixels};
+
+    AssetCache cache{_directory};
+    CORRADE_VERIFY(cache.saveImage("image", view));
+
+    std::optional<ImageData2D> image = cache.loadImage("image");
+    CORRADE_VERIFY(image);
+    CORRADE_VERIFY(!image->isCompressed());
+    CORRADE_COMPARE(image->storage().alignment(), 4);
+    CORRADE_COMPARE(image->format(), PixelFormat::RGB);
+    CORRADE_COMPARE(image->type(), PixelType::UnsignedByte);
+    CORRADE_COMPARE(image->size(), (Vector2i{3, 2}));
+    CORRADE_COMPARE_AS(Containers::ArrayView<const char>{image->data()},
+        (Containers::ArrayView<const char>{"\x01\x02\x03\x04\x05\x06\x07\x08\x09\0\0\0"
+            "\x0a\x0b\x0c\x0d\x0e\x0f\x10\x11\x12\0\0\0", 24}),
+        TestSuite::Compare::Container);
+}
+
+void AssetCacheTest::imageTypeMismatch() {
+    AssetCache cache{_directory};
+    CORRADE_VERIFY(cache.save("a", Data));
+
+    /* Raw data are not an image */
+    CORRADE_VERIFY(!cache.loadImage("a"));
+    CORRADE_COMPARE(cache.missCount(), 1);
+}
+
+void AssetCacheTest::evict() {
+    /* Room for exactly two entries */
+    AssetCache cache{_directory, 0, 2*(16 + sizeof(Data))};
+    CORRADE_VERIFY(cache.save("a", Data));
+    CORRADE_VERIFY(cache.save("b", Data));
+
+    /* Using "a" makes "b" the least recently used one */
+    CORRADE_VERIFY(cache.load("a"));
+    CORRADE_VERIFY(cache.save("c", Data));
+    CORRADE_COMPARE(cache.count(), 2);
+    CORRADE_COMPARE(cache.size(), 2*(16 + sizeof(Data)));
+
+    CORRADE_VERIFY(cache.load("a"));
+    CORRADE_VERIFY(!cache.load("b"));
+    CORRADE_VERIFY(cache.load("c"));
+    CORRADE_VERIFY(!Utility::Directory::fileExists(Utility::Directory::join(_directory, "b.bin")));
+}
+
+void AssetCacheTest::evictTooLarge() {
+    AssetCache cache{_directory, 0, 16 + sizeof(Data)};
+    CORRADE_VERIFY(cache.save("a", Data));
+
+    /* Doesn't fit at all, so it's not saved and nothing is evicted */
+    CORRADE_VERIFY(!cache.save("b", OtherData));
+    CORRADE_COMPARE(cache.count(), 1);
+    CORRADE_VERIFY(cache.load("a"));
+}
+
+void AssetCacheTest::setMaxSize() {
+    AssetCache cache{_directory};
+    CORRADE_VERIFY(cache.save("a", Data));
+    CORRADE_VERIFY(cache.save("b", Data));
+    CORRADE_VERIFY(cache.save("c", Data));
+    CORRADE_COMPARE(cache.count(), 3);
+
+    cache.setMaxSize(16 + sizeof(Data));
+    CORRADE_COMPARE(cache.maxSize(), 16 + sizeof(Data));
+    CORRADE_COMPARE(cache.count(), 1);
+    CORRADE_VERIFY(cache.load("c"));
+}
+
+void AssetCacheTest::index() {
+    {
+        AssetCache cache{_directory};
+        CORRADE_VERIFY(cache.save("a", Data));
+        CORRADE_VERIFY(cache.save("b", OtherData));
+        CORRADE_VERIFY(cache.load("a"));
+    }
+
+    /* The usage order survives, so "b" gets evicted first */
+    AssetCache cache{_directory};
+    CORRADE_COMPARE(cache.count(), 2);
+    CORRADE_COMPARE(cache.size(), 32 + sizeof(Data) + sizeof(OtherData));
+    cache.setMaxSize(16 + sizeof(Data));
+    CORRADE_COMPARE(cache.count(), 1);
+    CORRADE_VERIFY(cache.load("a"));
+}
+
+void AssetCacheTest::remove() {
+    AssetCache cache{_directory};
+    CORRADE_VERIFY(cache.save("a", Data));
+    cache.remove("a");
+    CORRADE_COMPARE(cache.count(), 0);
+    CORRADE_COMPARE(cache.size(), 0);
+    CORRADE_VERIFY(!cache.load("a"));
+}
+
+void AssetCacheTest::clear() {
+    AssetCache cache{_directory};
+    CORRADE_VERIFY(cache.save("a", Data));
+    CORRADE_VERIFY(cache.save("b", Data));
+    cache.clear();
+    CORRADE_COMPARE(cache.count(), 0);
+    CORRADE_COMPARE(cache.size(), 0);
+    CORRADE_VERIFY(!Utility::Directory::fileExists(Utility::Directory::join(_directory, "a.bin")));
+    CORRADE_VERIFY(!Utility::Directory::fileExists(Utility::Directory::join(_directory, "b.bin")));
+}
+
+namespace {
+
+class ImageImporter: public AbstractImporter {
+    public:
+        explicit ImageImporter(): decodeCount{}, _opened{} {}
+
+        Int decodeCount;
+
+    private:
+        Features doFeatures() const override { return Feature::OpenData; }
+        bool doIsOpened() const override { return _opened; }
+        void doClose() override { _opened = false; }
+
+        void doOpenData(Containers::ArrayView<const char> data) override {
+            _opened = true;
+            _pixel = data[0];
+        }
+
+        UnsignedInt doImage2DCount() const override { return 1; }
+        std::optional<ImageData2D> doImage2D(UnsignedInt) override {
+            ++decodeCount;
+            Containers::Array<char> data{Containers::ValueInit, 4};
+            data[0] = _pixel;
+            return ImageData2D{PixelFormat::Red, PixelType::UnsignedByte, {1, 1}, std::move(data)};
+        }
+
+        bool _opened;
+        char _pixel;
+};
+
+}
+
+void AssetCacheTest::importerImage() {
+    AssetCache cache{_directory};
+    AssetCache::setCurrent(&cache);
+
+    ImageImporter importer;
+    CORRADE_VERIFY(importer.openData(Data));
+    CORRADE_VERIFY(!importer.cacheKey().empty());
+
+    std::optional<ImageData2D> first = importer.image2D(0);
+    CORRADE_VERIFY(first);
+    CORRADE_COMPARE(importer.decodeCount, 1);
+    CORRADE_COMPARE(cache.count(), 1);
+
+    /* Second time it's taken from the cache */
+    std::optional<ImageData2D> second = importer.image2D(0);
+    CORRADE_VERIFY(second);
+    CORRADE_COMPARE(importer.decodeCount, 1);
+    CORRADE_COMPARE(second->data()[0], 'h');
+    CORRADE_COMPARE(cache.hitCount(), 1);
+
+    /* Different data are decoded again */
+    CORRADE_VERIFY(importer.openData(OtherData));
+    std::optional<ImageData2D> third = importer.image2D(0);
+    CORRADE_VERIFY(third);
+    CORRADE_COMPARE(importer.decodeCount, 2);
+    CORRADE_COMPARE(third->data()[0], 'w');
+    CORRADE_COMPARE(cache.count(), 2);
+
+    /* Closing resets the key */
+    importer.close();
+    CORRADE_VERIFY(importer.cacheKey().empty());
+}
+
+void AssetCacheTest::importerNoCache() {
+    ImageImporter importer;
+    CORRADE_VERIFY(importer.openData(Data));
+    CORRADE_VERIFY(importer.cacheKey().empty());
+
+    CORRADE_VERIFY(importer.image2D(0));
+    CORRADE_VERIFY(importer.image2D(0));
+    CORRADE_COMPARE(importer.decodeCount, 2);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::AssetCacheTest)
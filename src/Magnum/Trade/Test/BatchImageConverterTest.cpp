@@ -0,0 +1,337 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <atomic>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/FileToString.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Trade/AbstractImageConverter.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/BatchImageConverter.h"
+#include "Magnum/Trade/ImageData.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test {
+
+class BatchImageConverterTest: public TestSuite::Tester {
+    public:
+        explicit BatchImageConverterTest();
+
+        void construct();
+
+        void convert();
+        void convertFailed();
+        void transformation();
+        void cache();
+        void cacheRemovedOutput();
+        void multipleThreads();
+
+    private:
+        std::string input(const std::string& name, const std::string& contents) const;
+        std::string output(const std::string& name) const;
+};
+
+BatchImageConverterTest::BatchImageConverterTest() {
+    addTests({&BatchImageConverterTest::construct,
+
+              &BatchImageConverterTest::convert,
+              &BatchImageConverterTest::convertFailed,
+              &BatchImageConverterTest::transformation,
+              &BatchImageConverterTest::cache,
+              &BatchImageConverterTest::cacheRemovedOutput,
+              &BatchImageConverterTest::multipleThreads});
+
+    /* Create testing dir */
+    Utility::Directory::mkpath(Utility::Directory::join(TRADE_TEST_OUTPUT_DIR, "batch"));
+}
+
+namespace {
+
+/* Imports the file contents as a row of RGBA pixels, fails on files that
+   don't have a multiple of four bytes */
+class RowImporter: public AbstractImporter {
+    public:
+        explicit RowImporter(std::atomic<std::size_t>& instanceCount) {
+            ++instanceCount;
+        }
+
+    private:
+        Features doFeatures() const override { return Feature::OpenData; }
+        bool doIsOpened() const override { return !!_data; }
+        void doClose() override { _data = nullptr; }
+
+        void doOpenData(Containers::ArrayView<const char> data) override {
+            _data = Containers::Array<char>{data.size()};
+            std::copy(data.begin(), data.end(), _data.begin());
+        }
+
+        UnsignedInt doImage2DCount() const override { return 1; }
+
+        std::optional<ImageData2D> doImage2D(UnsignedInt) override {
+            if(_data.size() % 4) return std::nullopt;
+            Containers::Array<char> data{_data.size()};
+            std::copy(_data.begin(), _data.end(), data.begin());
+            return ImageData2D{PixelFormat::RGBA, PixelType::UnsignedByte, {Int(data.size()/4), 1}, std::move(data)};
+        }
+
+        Containers::Array<char> _data;
+};
+
+/* Exports the pixel data verbatim */
+class RowConverter: public AbstractImageConverter {
+    private:
+        Features doFeatures() const override { return Feature::ConvertData; }
+
+        Containers::Array<char> doExportToData(const ImageView2D& image) override {
+            Containers::Array<char> data{image.data().size()};
+            std::copy(image.data().begin(), image.data().end(), data.begin());
+            return data;
+        }
+};
+
+}
+
+std::string BatchImageConverterTest::input(const std::string& name, const std::string& contents) const {
+    const std::string filename = Utility::Directory::join(TRADE_TEST_OUTPUT_DIR, "batch/" + name);
+    Utility::Directory::writeString(filename, contents);
+    return filename;
+}
+
+std::string BatchImageConverterTest::output(const std::string& name) const {
+    const std::string filename = Utility::Directory::join(TRADE_TEST_OUTPUT_DIR, "batch/" + name);
+    Utility::Directory::rm(filename);
+    return filename;
+}
+
+void BatchImageConverterTest::construct() {
+    BatchImageConverter converter{{}, {}};
+    CORRADE_VERIFY(converter.threadCount() >= 1);
+    CORRADE_VERIFY(converter.cacheFile().empty());
+
+    BatchImageConverter converter3{{}, {}, 3};
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    CORRADE_COMPARE(converter3.threadCount(), 3);
+    #else
+    CORRADE_COMPARE(converter3.threadCount(), 1);
+    #endif
+}
+
+void BatchImageConverterTest::convert() {
+    std::atomic<std::size_t> importerCount{0};
+    BatchImageConverter converter{
+        [&]() { return std::unique_ptr<AbstractImporter>{new RowImporter{importerCount}}; },
+        []() { return std::unique_ptr<AbstractImageConverter>{new RowConverter}; }, 1};
+
+    const std::vector<BatchImageConverter::Result> results = converter.convert({
+        {input("a.in", "abcdefgh"), output("a.out")},
+        {input("b.in", "ijkl"), output("b.out")}});
+
+    CORRADE_COMPARE(importerCount.load(), 1);
+    CORRADE_COMPARE(results.size(), 2);
+    CORRADE_VERIFY(results[0].status == BatchImageConverter::Status::Converted);
+    CORRADE_COMPARE(results[0].inputSize, 8);
+    CORRADE_COMPARE(results[0].outputSize, 8);
+    CORRADE_VERIFY(results[0].importDuration >= 0.0f);
+    CORRADE_VERIFY(results[0].exportDuration >= 0.0f);
+    CORRADE_COMPARE(results[0].transformationDuration, 0.0f);
+    CORRADE_VERIFY(results[1].status == BatchImageConverter::Status::Converted);
+    CORRADE_COMPARE(results[1].inputSize, 4);
+    CORRADE_COMPARE(results[1].outputSize, 4);
+
+    CORRADE_COMPARE_AS(Utility::Directory::join(TRADE_TEST_OUTPUT_DIR, "batch/a.out"),
+        "abcdefgh", TestSuite::Compare::FileToString);
+    CORRADE_COMPARE_AS(Utility::Directory::join(TRADE_TEST_OUTPUT_DIR, "batch/b.out"),
+        "ijkl", TestSuite::Compare::FileToString);
+}
+
+void BatchImageConverterTest::convertFailed() {
+    std::atomic<std::size_t> importerCount{0};
+    BatchImageConverter converter{
+        [&]() { return std::unique_ptr<AbstractImporter>{new RowImporter{importerCount}}; },
+        []() { return std::unique_ptr<AbstractImageConverter>{new RowConverter}; }, 1};
+
+    std::ostringstream out;
+    std::vector<BatchImageConverter::Result> results;
+    {
+        Error redirectError{&out};
+        results = converter.convert({
+            {Utility::Directory::join(TRADE_TEST_OUTPUT_DIR, "batch/nonexistent.in"), output("nonexistent.out")},
+            {input("invalid.in", "abc"), output("invalid.out")},
+            {input("valid.in", "abcd"), output("valid.out")}});
+    }
+
+    CORRADE_COMPARE(results.size(), 3);
+    CORRADE_VERIFY(results[0].status == BatchImageConverter::Status::ImportFailed);
+    CORRADE_VERIFY(results[1].status == BatchImageConverter::Status::ImportFailed);
+    CORRADE_COMPARE(results[1].inputSize, 3);
+    CORRADE_VERIFY(results[2].status == BatchImageConverter::Status::Converted);
+    CORRADE_VERIFY(!Utility::Directory::fileExists(Utility::Directory::join(TRADE_TEST_OUTPUT_DIR, "batch/invalid.out")));
+    CORRADE_COMPARE(out.str(), "Trade::BatchImageConverter::convert(): cannot read file " + Utility::Directory::join(TRADE_TEST_OUTPUT_DIR, "batch/nonexistent.in") + "\n");
+}
+
+void BatchImageConverterTest::transformation() {
+    std::atomic<std::size_t> importerCount{0};
+    BatchImageConverter converter{
+        [&]() { return std::unique_ptr<AbstractImporter>{new RowImporter{importerCount}}; },
+        []() { return std::unique_ptr<AbstractImageConverter>{new RowConverter}; }, 1};
+
+    /* Uppercase everything, fail on digits */
+    converter.setTransformation([](ImageData2D& image) {
+        for(char& c: image.data()) {
+            if(c >= '0' && c <= '9') return false;
+            if(c >= 'a' && c <= 'z') c += 'A' - 'a';
+        }
+        return true;
+    });
+
+    const std::vector<BatchImageConverter::Result> results = converter.convert({
+        {input("lower.in", "abcd"), output("lower.out")},
+        {input("digits.in", "ab12"), output("digits.out")}});
+
+    CORRADE_VERIFY(results[0].status == BatchImageConverter::Status::Converted);
+    CORRADE_COMPARE_AS(Utility::Directory::join(TRADE_TEST_OUTPUT_DIR, "batch/lower.out"),
+        "ABCD", TestSuite::Compare::FileToString);
+    CORRADE_VERIFY(results[1].status == BatchImageConverter::Status::TransformationFailed);
+    CORRADE_VERIFY(!Utility::Directory::fileExists(Utility::Directory::join(TRADE_TEST_OUTPUT_DIR, "batch/digits.out")));
+}
+
+void BatchImageConverterTest::cache() {
+    const std::string cacheFile = output("cache.txt");
+
+    std::atomic<std::size_t> importerCount{0};
+    BatchImageConverter converter{
+        [&]() { return std::unique_ptr<AbstractImporter>{new RowImporter{importerCount}}; },
+        []() { return std::unique_ptr<AbstractImageConverter>{new RowConverter}; }, 1};
+    converter.setCacheFile(cacheFile);
+    CORRADE_COMPARE(converter.cacheFile(), cacheFile);
+
+    const std::vector<BatchImageConverter::Job> jobs{
+        {input("first.in", "abcd"), output("first.out")},
+        {input("second.in", "efgh"), output("second.out")},
+        {input("broken.in", "ijk"), output("broken.out")}};
+
+    {
+        const std::vector<BatchImageConverter::Result> results = converter.convert(jobs);
+        CORRADE_VERIFY(results[0].status == BatchImageConverter::Status::Converted);
+        CORRADE_VERIFY(results[1].status == BatchImageConverter::Status::Converted);
+        CORRADE_VERIFY(results[2].status == BatchImageConverter::Status::ImportFailed);
+        CORRADE_VERIFY(Utility::Directory::fileExists(cacheFile));
+        CORRADE_COMPARE(importerCount.load(), 1);
+    }
+
+    /* Nothing changed, so only the broken file is imported again */
+    {
+        const std::vector<BatchImageConverter::Result> results = converter.convert(jobs);
+        CORRADE_VERIFY(results[0].status == BatchImageConverter::Status::Skipped);
+        CORRADE_COMPARE(results[0].inputSize, 4);
+        CORRADE_COMPARE(results[0].outputSize, 4);
+        CORRADE_VERIFY(results[1].status == BatchImageConverter::Status::Skipped);
+        CORRADE_VERIFY(results[2].status == BatchImageConverter::Status::ImportFailed);
+        CORRADE_COMPARE(importerCount.load(), 2);
+    }
+
+    /* Changing contents of one file converts it again */
+    input("second.in", "EFGH");
+    input("broken.in", "ijkl");
+    {
+        const std::vector<BatchImageConverter::Result> results = converter.convert(jobs);
+        CORRADE_VERIFY(results[0].status == BatchImageConverter::Status::Skipped);
+        CORRADE_VERIFY(results[1].status == BatchImageConverter::Status::Converted);
+        CORRADE_VERIFY(results[2].status == BatchImageConverter::Status::Converted);
+        CORRADE_COMPARE_AS(Utility::Directory::join(TRADE_TEST_OUTPUT_DIR, "batch/second.out"),
+            "EFGH", TestSuite::Compare::FileToString);
+    }
+
+    /* A new instance picks up the cache from the file and doesn't even create
+       the plugins if all files are skipped */
+    {
+        std::atomic<std::size_t> anotherImporterCount{0};
+        BatchImageConverter another{
+            [&]() { return std::unique_ptr<AbstractImporter>{new RowImporter{anotherImporterCount}}; },
+            []() { return std::unique_ptr<AbstractImageConverter>{new RowConverter}; }, 1};
+        another.setCacheFile(cacheFile);
+
+        const std::vector<BatchImageConverter::Result> results = another.convert(jobs);
+        CORRADE_VERIFY(results[0].status == BatchImageConverter::Status::Skipped);
+        CORRADE_VERIFY(results[1].status == BatchImageConverter::Status::Skipped);
+        CORRADE_VERIFY(results[2].status == BatchImageConverter::Status::Skipped);
+        CORRADE_COMPARE(anotherImporterCount.load(), 0);
+    }
+}
+
+void BatchImageConverterTest::cacheRemovedOutput() {
+    std::atomic<std::size_t> importerCount{0};
+    BatchImageConverter converter{
+        [&]() { return std::unique_ptr<AbstractImporter>{new RowImporter{importerCount}}; },
+        []() { return std::unique_ptr<AbstractImageConverter>{new RowConverter}; }, 1};
+    converter.setCacheFile(output("cacheRemovedOutput.txt"));
+
+    const std::vector<BatchImageConverter::Job> jobs{
+        {input("removed.in", "abcd"), output("removed.out")}};
+    CORRADE_VERIFY(converter.convert(jobs)[0].status == BatchImageConverter::Status::Converted);
+    CORRADE_VERIFY(converter.convert(jobs)[0].status == BatchImageConverter::Status::Skipped);
+
+    /* Output removed, the file should get converted again */
+    output("removed.out");
+    CORRADE_VERIFY(converter.convert(jobs)[0].status == BatchImageConverter::Status::Converted);
+    CORRADE_VERIFY(Utility::Directory::fileExists(Utility::Directory::join(TRADE_TEST_OUTPUT_DIR, "batch/removed.out")));
+}
+
+void BatchImageConverterTest::multipleThreads() {
+    std::atomic<std::size_t> importerCount{0};
+    BatchImageConverter converter{
+        [&]() { return std::unique_ptr<AbstractImporter>{new RowImporter{importerCount}}; },
+        []() { return std::unique_ptr<AbstractImageConverter>{new RowConverter}; }, 4};
+
+    std::vector<BatchImageConverter::Job> jobs;
+    for(std::size_t i = 0; i != 64; ++i) {
+        const std::string name = std::to_string(i);
+        jobs.push_back({input(name + ".in", std::string(4*(i + 1), 'a' + i%26)), output(name + ".out")});
+    }
+
+    const std::vector<BatchImageConverter::Result> results = converter.convert(jobs);
+    CORRADE_COMPARE(results.size(), 64);
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    CORRADE_VERIFY(importerCount >= 1 && importerCount <= 4);
+    #else
+    CORRADE_COMPARE(importerCount.load(), 1);
+    #endif
+    for(std::size_t i = 0; i != 64; ++i) {
+        CORRADE_VERIFY(results[i].status == BatchImageConverter::Status::Converted);
+        CORRADE_COMPARE(results[i].outputSize, 4*(i + 1));
+        CORRADE_COMPARE_AS(jobs[i].output, std::string(4*(i + 1), 'a' + i%26),
+            TestSuite::Compare::FileToString);
+    }
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::BatchImageConverterTest)
@@ -39,6 +39,7 @@ struct MeshData3DTest: TestSuite::Tester {
     void constructNoNormals();
     void constructNoTexCoords();
     void constructNoColors();
+    void constructJoints();
     void constructCopy();
     void constructMove();
 };
@@ -49,6 +50,7 @@ MeshData3DTest::MeshData3DTest() {
               &MeshData3DTest::constructNoNormals,
               &MeshData3DTest::constructNoTexCoords,
               &MeshData3DTest::constructNoColors,
+              &MeshData3DTest::constructJoints,
               &MeshData3DTest::constructCopy,
               &MeshData3DTest::constructMove});
 }
@@ -90,6 +92,9 @@ void MeshData3DTest::construct() {
     CORRADE_COMPARE(data.colorArrayCount(), 1);
     CORRADE_COMPARE(data.colors(0), (std::vector<Color4>{0xff98ab_rgbf, 0xff3366_rgbf}));
 
+    CORRADE_VERIFY(!data.hasJoints());
+    CORRADE_COMPARE(data.jointArrayCount(), 0);
+
     CORRADE_COMPARE(data.importerState(), &a);
 }
 
@@ -144,6 +149,23 @@ void MeshData3DTest::constructNoColors() {
     CORRADE_COMPARE(data.colorArrayCount(), 0);
 }
 
+void MeshData3DTest::constructJoints() {
+    const int a{};
+    const MeshData3D data{MeshPrimitive::Triangles, {},
+        {{{0.5f, 1.0f, 0.1f}, {-1.0f, 0.3f, -1.0f}}},
+        {{{0.0f, 1.0f, 0.0f}, {-1.0f, 0.0f, 0.0f}}},
+        {}, {},
+        {{{0, 3, 0, 0}, {1, 2, 5, 0}}},
+        {{{0.75f, 0.25f, 0.0f, 0.0f}, {0.5f, 0.25f, 0.25f, 0.0f}}},
+        &a};
+
+    CORRADE_VERIFY(data.hasJoints());
+    CORRADE_COMPARE(data.jointArrayCount(), 1);
+    CORRADE_COMPARE(data.jointIds(0), (std::vector<Vector4ui>{{0, 3, 0, 0}, {1, 2, 5, 0}}));
+    CORRADE_COMPARE(data.jointWeights(0), (std::vector<Vector4>{{0.75f, 0.25f, 0.0f, 0.0f}, {0.5f, 0.25f, 0.25f, 0.0f}}));
+    CORRADE_COMPARE(data.importerState(), &a);
+}
+
 void MeshData3DTest::constructCopy() {
     CORRADE_VERIFY(!(std::is_constructible<MeshData3D, const MeshData3D&>{}));
     CORRADE_VERIFY(!(std::is_assignable<MeshData3D, const MeshData3D&>{}));
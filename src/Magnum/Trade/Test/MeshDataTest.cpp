@@ -0,0 +1,264 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/Math/Color.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/MeshData2D.h"
+#include "Magnum/Trade/MeshData3D.h"
+
+namespace Magnum { namespace Trade { namespace Test {
+
+struct MeshDataTest: TestSuite::Tester {
+    explicit MeshDataTest();
+
+    void construct();
+    void constructNotIndexed();
+    void constructCopy();
+    void constructMove();
+    void constructMeshData2D();
+    void constructMeshData3D();
+
+    void indices();
+    void attributeFor();
+
+    void debugAttribute();
+    void debugAttributeType();
+};
+
+MeshDataTest::MeshDataTest() {
+    addTests({&MeshDataTest::construct,
+              &MeshDataTest::constructNotIndexed,
+              &MeshDataTest::constructCopy,
+              &MeshDataTest::constructMove,
+              &MeshDataTest::constructMeshData2D,
+              &MeshDataTest::constructMeshData3D,
+
+              &MeshDataTest::indices,
+              &MeshDataTest::attributeFor,
+
+              &MeshDataTest::debugAttribute,
+              &MeshDataTest::debugAttributeType});
+}
+
+namespace {
+    struct Vertex {
+        Vector3 position;
+        Vector2 textureCoords;
+    };
+
+    MeshData makeMeshData(const void* importerState) {
+        Containers::Array<char> indexData{3*sizeof(UnsignedShort)};
+        const UnsignedShort indices[]{0, 2, 1};
+        std::memcpy(indexData, indices, sizeof(indices));
+
+        Containers::Array<char> vertexData{3*sizeof(Vertex)};
+        const Vertex vertices[]{
+            {{0.1f, 0.2f, 0.3f}, {0.0f, 0.5f}},
+            {{0.4f, 0.5f, 0.6f}, {1.0f, 0.5f}},
+            {{0.7f, 0.8f, 0.9f}, {0.5f, 1.0f}}};
+        std::memcpy(vertexData, vertices, sizeof(vertices));
+
+        return MeshData{MeshPrimitive::Triangles, Mesh::IndexType::UnsignedShort, std::move(indexData), 3, std::move(vertexData), {
+            {MeshAttribute::Position, MeshAttributeType::Vector3, 0, sizeof(Vertex)},
+            {MeshAttribute::TextureCoordinates, MeshAttributeType::Vector2, sizeof(Vector3), sizeof(Vertex)}}, importerState};
+    }
+}
+
+void MeshDataTest::construct() {
+    const int a{};
+    const MeshData data = makeMeshData(&a);
+
+    CORRADE_COMPARE(data.primitive(), MeshPrimitive::Triangles);
+    CORRADE_VERIFY(data.isIndexed());
+    CORRADE_COMPARE(data.indexType(), Mesh::IndexType::UnsignedShort);
+    CORRADE_COMPARE(data.indexCount(), 3);
+    CORRADE_COMPARE(data.indexData().size(), 6);
+    CORRADE_COMPARE(data.vertexCount(), 3);
+    CORRADE_COMPARE(data.vertexData().size(), 3*sizeof(Vertex));
+    CORRADE_COMPARE(data.attributeCount(), 2);
+    CORRADE_COMPARE(data.attribute(1).name, MeshAttribute::TextureCoordinates);
+    CORRADE_COMPARE(data.attribute(1).type, MeshAttributeType::Vector2);
+    CORRADE_COMPARE(data.attribute(1).offset, sizeof(Vector3));
+    CORRADE_COMPARE(data.attribute(1).stride, sizeof(Vertex));
+    CORRADE_COMPARE_AS(data.attributeData<Vector3>(0), (std::vector<Vector3>{
+        {0.1f, 0.2f, 0.3f}, {0.4f, 0.5f, 0.6f}, {0.7f, 0.8f, 0.9f}}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(data.attributeData<Vector2>(1), (std::vector<Vector2>{
+        {0.0f, 0.5f}, {1.0f, 0.5f}, {0.5f, 1.0f}}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(data.importerState(), &a);
+}
+
+void MeshDataTest::constructNotIndexed() {
+    Containers::Array<char> vertexData{4*sizeof(Vector2)};
+    const MeshData data{MeshPrimitive::LineStrip, 4, std::move(vertexData), {
+        {MeshAttribute::Position, MeshAttributeType::Vector2, 0, sizeof(Vector2)}}};
+
+    CORRADE_COMPARE(data.primitive(), MeshPrimitive::LineStrip);
+    CORRADE_VERIFY(!data.isIndexed());
+    CORRADE_COMPARE(data.indexCount(), 0);
+    CORRADE_COMPARE(data.vertexCount(), 4);
+    CORRADE_COMPARE(data.attributeCount(), 1);
+    CORRADE_COMPARE(data.importerState(), nullptr);
+}
+
+void MeshDataTest::constructCopy() {
+    CORRADE_VERIFY(!(std::is_constructible<MeshData, const MeshData&>{}));
+    CORRADE_VERIFY(!(std::is_assignable<MeshData, const MeshData&>{}));
+}
+
+void MeshDataTest::constructMove() {
+    const int a{};
+    MeshData data = makeMeshData(&a);
+    const char* vertexData = data.vertexData().data();
+
+    MeshData b{std::move(data)};
+    CORRADE_COMPARE(b.indexCount(), 3);
+    CORRADE_COMPARE(b.vertexCount(), 3);
+    CORRADE_COMPARE(b.vertexData().data(), vertexData);
+    CORRADE_COMPARE(b.attributeCount(), 2);
+    CORRADE_COMPARE(b.importerState(), &a);
+
+    const int c{};
+    MeshData d{MeshPrimitive::Points, 0, nullptr, {}, &c};
+    d = std::move(b);
+    CORRADE_COMPARE(d.primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(d.indexCount(), 3);
+    CORRADE_COMPARE(d.vertexData().data(), vertexData);
+    CORRADE_COMPARE(d.attributeCount(), 2);
+    CORRADE_COMPARE(d.importerState(), &a);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<MeshData>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<MeshData>::value);
+}
+
+void MeshDataTest::constructMeshData2D() {
+    const int a{};
+    const MeshData2D original{MeshPrimitive::TriangleFan, {0, 1, 2, 0},
+        {{{0.0f, 1.0f}, {1.0f, 2.0f}, {2.0f, 3.0f}}},
+        {{{0.5f, 0.25f}, {0.75f, 0.0f}, {1.0f, 1.0f}}}, {}, &a};
+    const MeshData data{original};
+
+    CORRADE_COMPARE(data.primitive(), MeshPrimitive::TriangleFan);
+    CORRADE_COMPARE(data.indexType(), Mesh::IndexType::UnsignedInt);
+    CORRADE_COMPARE_AS(data.indices(), (std::vector<UnsignedInt>{0, 1, 2, 0}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(data.vertexCount(), 3);
+    CORRADE_COMPARE(data.vertexData().size(), 3*2*sizeof(Vector2));
+    CORRADE_COMPARE(data.attributeCount(), 2);
+    CORRADE_COMPARE(data.attribute(0).name, MeshAttribute::Position);
+    CORRADE_COMPARE(data.attribute(0).type, MeshAttributeType::Vector2);
+    CORRADE_COMPARE(data.attribute(1).offset, sizeof(Vector2));
+    CORRADE_COMPARE(data.attribute(1).stride, 2*sizeof(Vector2));
+    CORRADE_COMPARE_AS(data.attributeData<Vector2>(0), original.positions(0),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(data.attributeData<Vector2>(1), original.textureCoords2D(0),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(data.importerState(), &a);
+}
+
+void MeshDataTest::constructMeshData3D() {
+    const int a{};
+    const MeshData3D original{MeshPrimitive::Lines, {},
+        {{{0.0f, 1.0f, 2.0f}, {3.0f, 4.0f, 5.0f}}},
+        {{{0.0f, 0.0f, 1.0f}, {0.0f, 1.0f, 0.0f}}},
+        {{{0.5f, 0.25f}, {0.75f, 0.0f}}},
+        {{{1.0f, 0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 1.0f, 0.5f}}}, &a};
+    const MeshData data{original};
+
+    CORRADE_COMPARE(data.primitive(), MeshPrimitive::Lines);
+    CORRADE_VERIFY(!data.isIndexed());
+    CORRADE_COMPARE(data.vertexCount(), 2);
+
+    const UnsignedInt stride = 2*sizeof(Vector3) + sizeof(Vector2) + sizeof(Color4);
+    CORRADE_COMPARE(data.vertexData().size(), 2*stride);
+    CORRADE_COMPARE(data.attributeCount(), 4);
+    CORRADE_COMPARE(data.attribute(2).name, MeshAttribute::TextureCoordinates);
+    CORRADE_COMPARE(data.attribute(2).offset, 2*sizeof(Vector3));
+    CORRADE_COMPARE(data.attribute(3).name, MeshAttribute::Color);
+    CORRADE_COMPARE(data.attribute(3).type, MeshAttributeType::Vector4);
+    CORRADE_COMPARE(data.attribute(3).stride, stride);
+    CORRADE_COMPARE_AS(data.attributeData<Vector3>(0), original.positions(0),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(data.attributeData<Vector3>(1), original.normals(0),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(data.attributeData<Vector2>(2), original.textureCoords2D(0),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(data.attributeData<Color4>(3), original.colors(0),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(data.importerState(), &a);
+}
+
+void MeshDataTest::indices() {
+    const MeshData data = makeMeshData(nullptr);
+    CORRADE_COMPARE_AS(data.indices(), (std::vector<UnsignedInt>{0, 2, 1}),
+        TestSuite::Compare::Container);
+
+    Containers::Array<char> indexData{Containers::InPlaceInit, {3, 1, 2, 0}};
+    const MeshData bytes{MeshPrimitive::Points, Mesh::IndexType::UnsignedByte, std::move(indexData), 0, nullptr, {}};
+    CORRADE_COMPARE(bytes.indexCount(), 4);
+    CORRADE_COMPARE_AS(bytes.indices(), (std::vector<UnsignedInt>{3, 1, 2, 0}),
+        TestSuite::Compare::Container);
+}
+
+void MeshDataTest::attributeFor() {
+    const MeshData3D original{MeshPrimitive::Points, {},
+        {{{0.0f, 1.0f, 2.0f}}, {{3.0f, 4.0f, 5.0f}}},
+        {}, {{{0.5f, 0.25f}}}, {}, nullptr};
+    const MeshData data{original};
+
+    CORRADE_COMPARE(data.attributeCount(MeshAttribute::Position), 2);
+    CORRADE_COMPARE(data.attributeCount(MeshAttribute::TextureCoordinates), 1);
+    CORRADE_COMPARE(data.attributeCount(MeshAttribute::Normal), 0);
+    CORRADE_COMPARE(data.attributeFor(MeshAttribute::Position), 0);
+    CORRADE_COMPARE(data.attributeFor(MeshAttribute::Position, 1), 1);
+    CORRADE_COMPARE(data.attributeFor(MeshAttribute::Position, 2), -1);
+    CORRADE_COMPARE(data.attributeFor(MeshAttribute::TextureCoordinates), 2);
+    CORRADE_COMPARE(data.attributeFor(MeshAttribute::Normal), -1);
+    CORRADE_COMPARE_AS(data.attributeData<Vector3>(1), (std::vector<Vector3>{{3.0f, 4.0f, 5.0f}}),
+        TestSuite::Compare::Container);
+}
+
+void MeshDataTest::debugAttribute() {
+    std::ostringstream out;
+
+    Debug(&out) << MeshAttribute::TextureCoordinates << MeshAttribute(0xbe);
+    CORRADE_COMPARE(out.str(), "Trade::MeshAttribute::TextureCoordinates Trade::MeshAttribute(0xbe)\n");
+}
+
+void MeshDataTest::debugAttributeType() {
+    std::ostringstream out;
+
+    Debug(&out) << MeshAttributeType::Vector3 << MeshAttributeType(0xbe);
+    CORRADE_COMPARE(out.str(), "Trade::MeshAttributeType::Vector3 Trade::MeshAttributeType(0xbe)\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::MeshDataTest)
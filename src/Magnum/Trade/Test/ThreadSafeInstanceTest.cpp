@@ -0,0 +1,110 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/ThreadSafeInstance.h"
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#endif
+
+namespace Magnum { namespace Trade { namespace Test {
+
+struct ThreadSafeInstanceTest: TestSuite::Tester {
+    explicit ThreadSafeInstanceTest();
+
+    void deleter();
+    void notFound();
+    void concurrentDeletion();
+};
+
+ThreadSafeInstanceTest::ThreadSafeInstanceTest() {
+    addTests({&ThreadSafeInstanceTest::deleter,
+              &ThreadSafeInstanceTest::notFound,
+              &ThreadSafeInstanceTest::concurrentDeletion});
+}
+
+namespace {
+
+Int destructionCount = 0;
+
+class Importer: public AbstractImporter {
+    public:
+        ~Importer() { ++destructionCount; }
+
+    private:
+        Features doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return false; }
+        void doClose() override {}
+};
+
+}
+
+void ThreadSafeInstanceTest::deleter() {
+    destructionCount = 0;
+    {
+        ThreadSafePlugin<AbstractImporter> importer{new Importer};
+        CORRADE_COMPARE(destructionCount, 0);
+    }
+    CORRADE_COMPARE(destructionCount, 1);
+
+    /* The lock is released again */
+    CORRADE_VERIFY(Implementation::pluginManagerMutex().try_lock());
+    Implementation::pluginManagerMutex().unlock();
+}
+
+void ThreadSafeInstanceTest::notFound() {
+    PluginManager::Manager<AbstractImporter> manager{"nonexistent"};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!threadSafeInstance(manager, "NonexistentImporter"));
+}
+
+void ThreadSafeInstanceTest::concurrentDeletion() {
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    enum: std::size_t { ThreadCount = 4, IterationCount = 100 };
+
+    destructionCount = 0;
+    std::vector<std::thread> threads;
+    for(std::size_t i = 0; i != ThreadCount; ++i) threads.emplace_back([]() {
+        for(std::size_t j = 0; j != IterationCount; ++j)
+            ThreadSafePlugin<AbstractImporter>{new Importer};
+    });
+    for(std::thread& thread: threads) thread.join();
+
+    /* Not atomic, so this would be racy without the lock */
+    CORRADE_COMPARE(destructionCount, ThreadCount*IterationCount);
+    #else
+    CORRADE_SKIP("Threads are not available on Emscripten.");
+    #endif
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::ThreadSafeInstanceTest)
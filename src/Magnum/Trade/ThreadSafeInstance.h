@@ -0,0 +1,108 @@
+#ifndef Magnum_Trade_ThreadSafeInstance_h
+#define Magnum_Trade_ThreadSafeInstance_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Trade::threadSafeInstance(), struct @ref Magnum::Trade::ThreadSafeDeleter, typedef @ref Magnum::Trade::ThreadSafePlugin
+ */
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <Corrade/PluginManager/Manager.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum { namespace Trade {
+
+namespace Implementation {
+    /* Shared by all plugin managers, as plugins can load other plugins from
+       different managers */
+    MAGNUM_EXPORT std::mutex& pluginManagerMutex();
+}
+
+/**
+@brief Deleter of thread-safe plugin instances
+
+Destroys the plugin with the same lock that's used by
+@ref threadSafeInstance(), as destructing a plugin instance modifies its
+plugin manager.
+@see @ref ThreadSafePlugin
+*/
+struct ThreadSafeDeleter {
+    /** @brief Destroy the plugin */
+    template<class T> void operator()(T* plugin) const {
+        std::lock_guard<std::mutex> lock{Implementation::pluginManagerMutex()};
+        delete plugin;
+    }
+};
+
+/**
+@brief Thread-safe plugin instance
+
+@see @ref threadSafeInstance()
+*/
+template<class T> using ThreadSafePlugin = std::unique_ptr<T, ThreadSafeDeleter>;
+
+/**
+@brief Instantiate a plugin in a thread-safe way
+
+@ref Corrade::PluginManager::Manager is not thread-safe, so loading a plugin,
+creating its instance and destroying the instance may not be done from more
+than one thread at a time. This function loads @p plugin, if it's not already
+loaded, and instantiates it while holding a global lock, which is held also
+while destroying the returned instance. Returns `nullptr` if the plugin can't
+be loaded.
+
+Separate instances of an importer can then be used concurrently without any
+locking, see @ref AbstractImporter-thread-safety "AbstractImporter" for
+details. Example:
+@code
+PluginManager::Manager<Trade::AbstractImporter> manager;
+
+// in each worker thread
+Trade::ThreadSafePlugin<Trade::AbstractImporter> importer = Trade::threadSafeInstance(manager, "TgaImporter");
+if(importer && importer->openFile(filename)) {
+    std::optional<Trade::ImageData2D> image = importer->image2D(0);
+    // ...
+}
+@endcode
+
+All other uses of the manager, such as explicit loading and unloading of
+plugins or instantiating plugins in other ways, have to be done while no
+thread is using this function.
+*/
+template<class T> ThreadSafePlugin<T> threadSafeInstance(PluginManager::Manager<T>& manager, const std::string& plugin) {
+    std::lock_guard<std::mutex> lock{Implementation::pluginManagerMutex()};
+    if(!(manager.load(plugin) & (PluginManager::LoadState::Loaded|PluginManager::LoadState::Static)))
+        return nullptr;
+    return ThreadSafePlugin<T>{manager.instance(plugin).release()};
+}
+
+}}
+
+#endif
@@ -37,6 +37,7 @@ namespace Magnum { namespace Trade {
 class AbstractImageConverter;
 class AbstractImporter;
 class AbstractMaterialData;
+class AssetCache;
 class CameraData;
 
 template<UnsignedInt> class ImageData;
@@ -45,6 +46,8 @@ typedef ImageData<2> ImageData2D;
 typedef ImageData<3> ImageData3D;
 
 class LightData;
+class MeshData;
+struct MeshAttributeData;
 class MeshData2D;
 class MeshData3D;
 class MeshObjectData2D;
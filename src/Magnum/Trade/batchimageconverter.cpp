@@ -0,0 +1,189 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/Utility/Arguments.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/AbstractImageConverter.h"
+#include "Magnum/Trade/BatchImageConverter.h"
+
+#include "imageconverterConfigure.h"
+
+namespace Magnum {
+
+/**
+@page magnum-batchimageconverter Batch image conversion utility
+@brief Converts many images of different formats at once
+
+@section magnum-batchimageconverter-usage Usage
+
+    magnum-batchimageconverter [-h|--help] [--importer IMPORTER] [--converter CONVERTER] [--plugin-dir DIR] [--threads N] [--cache FILE] [--verbose] [--] list
+
+Arguments:
+
+-   `list` -- file listing the images to convert. Each non-empty line
+    contains input and output filename separated by a tab character, lines
+    starting with `#` are ignored.
+-   `-h`, `--help` -- display this help message and exit
+-   `--importer IMPORTER` -- image importer plugin (default:
+    @ref Trade::TgaImporter "TgaImporter")
+-   `--converter CONVERTER` -- image converter plugin (default:
+    @ref Trade::TgaImageConverter "TgaImageConverter")
+-   `--plugin-dir DIR` -- base plugin dir (defaults to plugin directory in
+    Magnum install location)
+-   `--threads N` -- max count of worker threads (default: `0`, i.e. one
+    thread per CPU core)
+-   `--cache FILE` -- file with content hashes of converted images. Images
+    that didn't change since the last run are skipped. The file needs to be
+    removed when changing the importer or converter.
+-   `--verbose` -- print timing information for each image
+
+The conversion is done using @ref Trade::BatchImageConverter. The
+`AnyImageImporter` and `AnyImageConverter` plugins load other plugins while
+converting, which is not thread-safe, so a concrete plugin needs to be
+specified when converting on more than one thread.
+
+At the end, count of converted, skipped and failed images is printed together
+with total processing time and throughput. The utility returns non-zero exit
+code if any of the images failed to convert.
+
+@section magnum-batchimageconverter-example Example usage
+
+Converting all TGA files in the `textures/` directory to `out/`, skipping
+files that didn't change since the last run:
+
+    find textures -name '*.tga' | sed 's|textures/\(.*\)|&\tout/\1|' > list.txt
+    magnum-batchimageconverter --cache list.cache list.txt
+
+*/
+
+}
+
+using namespace Magnum;
+
+namespace {
+
+std::vector<Trade::BatchImageConverter::Job> readList(const std::string& filename) {
+    std::vector<Trade::BatchImageConverter::Job> jobs;
+    std::ifstream in{filename};
+    std::string line;
+    while(std::getline(in, line)) {
+        if(line.empty() || line[0] == '#') continue;
+
+        const std::size_t separator = line.find('\t');
+        if(separator == std::string::npos) {
+            Warning() << "Ignoring line without an output filename:" << line;
+            continue;
+        }
+
+        jobs.push_back({line.substr(0, separator), line.substr(separator + 1)});
+    }
+    return jobs;
+}
+
+const char* statusString(const Trade::BatchImageConverter::Status status) {
+    switch(status) {
+        case Trade::BatchImageConverter::Status::Converted: return "converted";
+        case Trade::BatchImageConverter::Status::Skipped: return "skipped";
+        case Trade::BatchImageConverter::Status::ImportFailed: return "import failed";
+        case Trade::BatchImageConverter::Status::TransformationFailed: return "transformation failed";
+        case Trade::BatchImageConverter::Status::ExportFailed: return "export failed";
+    }
+
+    return "unknown";
+}
+
+std::string milliseconds(const Float seconds) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(2) << seconds*1000.0f << "ms";
+    return out.str();
+}
+
+}
+
+int main(int argc, char** argv) {
+    Utility::Arguments args;
+    args.addArgument("list").setHelp("list", "file listing the images to convert")
+        .addOption("importer", "TgaImporter").setHelp("importer", "image importer plugin")
+        .addOption("converter", "TgaImageConverter").setHelp("converter", "image converter plugin")
+        .addOption("plugin-dir", Utility::Directory::join(Utility::Directory::path(Utility::Directory::executableLocation()), MAGNUM_PLUGINS_DIR)).setHelp("plugin-dir", "base plugin dir", "DIR")
+        .addOption("threads", "0").setHelp("threads", "max count of worker threads", "N")
+        .addOption("cache").setHelp("cache", "file with content hashes of converted images", "FILE")
+        .addBooleanOption("verbose").setHelp("verbose", "print timing information for each image")
+        .setHelp("Converts many images of different formats at once.")
+        .parse(argc, argv);
+
+    /* Load importer plugin */
+    PluginManager::Manager<Trade::AbstractImporter> importerManager(Utility::Directory::join(args.value("plugin-dir"), "importers/"));
+    if(!(importerManager.load(args.value("importer")) & PluginManager::LoadState::Loaded))
+        return 1;
+
+    /* Load converter plugin */
+    PluginManager::Manager<Trade::AbstractImageConverter> converterManager(Utility::Directory::join(args.value("plugin-dir"), "imageconverters/"));
+    if(!(converterManager.load(args.value("converter")) & PluginManager::LoadState::Loaded))
+        return 1;
+
+    const std::vector<Trade::BatchImageConverter::Job> jobs = readList(args.value("list"));
+    if(jobs.empty()) {
+        Error() << "No images to convert in" << args.value("list");
+        return 1;
+    }
+
+    Trade::BatchImageConverter converter{
+        [&]() { return importerManager.instance(args.value("importer")); },
+        [&]() { return converterManager.instance(args.value("converter")); },
+        args.value<std::size_t>("threads")};
+    converter.setCacheFile(args.value("cache"));
+
+    const auto start = std::chrono::steady_clock::now();
+    const std::vector<Trade::BatchImageConverter::Result> results = converter.convert(jobs);
+    const Float duration = std::chrono::duration<Float>(std::chrono::steady_clock::now() - start).count();
+
+    std::size_t converted = 0, skipped = 0, failed = 0, inputSize = 0;
+    for(std::size_t i = 0; i != jobs.size(); ++i) {
+        const Trade::BatchImageConverter::Result& result = results[i];
+        if(result.status == Trade::BatchImageConverter::Status::Converted) {
+            ++converted;
+            inputSize += result.inputSize;
+        } else if(result.status == Trade::BatchImageConverter::Status::Skipped)
+            ++skipped;
+        else ++failed;
+
+        if(args.isSet("verbose") || (result.status != Trade::BatchImageConverter::Status::Converted && result.status != Trade::BatchImageConverter::Status::Skipped))
+            Debug() << jobs[i].input << "->" << jobs[i].output << Debug::nospace << ":" << statusString(result.status) << Debug::nospace << ", import" << milliseconds(result.importDuration) << Debug::nospace << ", transformation" << milliseconds(result.transformationDuration) << Debug::nospace << ", export" << milliseconds(result.exportDuration);
+    }
+
+    Debug() << "Converted" << converted << Debug::nospace << ", skipped" << skipped << "and failed" << failed << "of" << jobs.size() << "images using up to" << converter.threadCount() << "threads in" << milliseconds(duration);
+    if(converted && duration > 0.0f)
+        Debug() << "Throughput:" << converted/duration << "images/s," << inputSize/(duration*1024.0f*1024.0f) << "MB/s";
+
+    return failed ? 1 : 0;
+}
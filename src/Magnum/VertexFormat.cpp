@@ -0,0 +1,136 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "VertexFormat.h"
+
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Buffer.h"
+#include "Magnum/Context.h"
+
+#include "Implementation/BufferState.h"
+#include "Implementation/MeshState.h"
+#include "Implementation/State.h"
+
+namespace Magnum {
+
+VertexFormat::VertexFormat(): _id{0}, _dirty{true}, _indexBuffer{0} {}
+
+VertexFormat::~VertexFormat() {
+    /* Not used by any mesh yet, nothing to do */
+    if(!_id) return;
+
+    /* Remove current vao from the state */
+    GLuint& current = Context::current().state().mesh->currentVAO;
+    if(current == _id) current = 0;
+
+    glDeleteVertexArrays(1, &_id);
+}
+
+GLsizei VertexFormat::stride(const UnsignedInt binding) const {
+    CORRADE_ASSERT(binding < _bindings.size(),
+        "VertexFormat::stride(): binding" << binding << "out of range for" << _bindings.size() << "bindings", {});
+    return _bindings[binding].stride;
+}
+
+UnsignedInt VertexFormat::divisor(const UnsignedInt binding) const {
+    CORRADE_ASSERT(binding < _bindings.size(),
+        "VertexFormat::divisor(): binding" << binding << "out of range for" << _bindings.size() << "bindings", {});
+    return _bindings[binding].divisor;
+}
+
+void VertexFormat::addBindingInternal(const UnsignedInt binding, const GLsizei stride, const UnsignedInt divisor) {
+    if(binding >= _bindings.size())
+        _bindings.resize(binding + 1, Binding{0, 0, false, 0, 0});
+
+    CORRADE_ASSERT(!_bindings[binding].specified,
+        "VertexFormat::addVertexBuffer(): binding" << binding << "is already specified", );
+
+    Binding& b = _bindings[binding];
+    b.stride = stride;
+    b.divisor = divisor;
+    b.specified = true;
+    _dirty = true;
+}
+
+void VertexFormat::addAttributeInternal(const UnsignedInt binding, const GLuint location, const GLint size, const GLenum type, const Mesh::AttributeKind kind, const GLuint relativeOffset) {
+    _attributes.push_back(AttributeFormat{location, size, type, kind, relativeOffset, binding});
+}
+
+void VertexFormat::bindInternal() {
+    /* Create the VAO on first use */
+    if(!_id) glGenVertexArrays(1, &_id);
+
+    GLuint& current = Context::current().state().mesh->currentVAO;
+    if(current != _id) glBindVertexArray(current = _id);
+
+    /* (Re)specify the layout if it changed since last time */
+    if(!_dirty) return;
+
+    for(const AttributeFormat& attribute: _attributes) {
+        glEnableVertexAttribArray(attribute.location);
+
+        if(attribute.kind == Mesh::AttributeKind::Integral)
+            glVertexAttribIFormat(attribute.location, attribute.size, attribute.type, attribute.relativeOffset);
+        #ifndef MAGNUM_TARGET_GLES
+        else if(attribute.kind == Mesh::AttributeKind::Long)
+            glVertexAttribLFormat(attribute.location, attribute.size, attribute.type, attribute.relativeOffset);
+        #endif
+        else glVertexAttribFormat(attribute.location, attribute.size, attribute.type, attribute.kind == Mesh::AttributeKind::GenericNormalized, attribute.relativeOffset);
+
+        glVertexAttribBinding(attribute.location, attribute.binding);
+    }
+
+    for(std::size_t i = 0; i != _bindings.size(); ++i) {
+        glVertexBindingDivisor(i, _bindings[i].divisor);
+
+        /* Stride might have changed, force the buffer to be rebound */
+        _bindings[i].buffer = 0;
+    }
+
+    _dirty = false;
+}
+
+void VertexFormat::bindVertexBufferInternal(const UnsignedInt binding, const GLuint buffer, const GLintptr offset) {
+    Binding& b = _bindings[binding];
+    if(b.buffer == buffer && b.offset == offset) return;
+
+    glBindVertexBuffer(binding, buffer, offset, b.stride);
+    b.buffer = buffer;
+    b.offset = offset;
+}
+
+void VertexFormat::bindIndexBufferInternal(Buffer& buffer) {
+    if(_indexBuffer == buffer.id()) return;
+
+    /* Element array binding is part of VAO state, reset it to force explicit
+       glBindBuffer() call */
+    Context::current().state().buffer->bindings[Implementation::BufferState::indexForTarget(Buffer::TargetHint::ElementArray)] = 0;
+
+    buffer.bindInternal(Buffer::TargetHint::ElementArray);
+    _indexBuffer = buffer.id();
+}
+
+}
@@ -0,0 +1,268 @@
+#ifndef Magnum_VertexFormat_h
+#define Magnum_VertexFormat_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+/** @file
+ * @brief Class @ref Magnum::VertexFormat
+ */
+#endif
+
+#include <vector>
+
+#include "Magnum/Mesh.h"
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+namespace Magnum {
+
+/**
+@brief Vertex format
+
+Describes vertex attribute layout independently of the buffers the data are
+taken from. The layout is split into *bindings*, each binding corresponds to
+one buffer range with interleaved attributes. Meshes that have the same layout
+can share one format using @ref Mesh::setVertexFormat() and then specify only
+the buffers and offsets using @ref Mesh::setVertexBuffer():
+@code
+VertexFormat format;
+format.addVertexBuffer(0, Shaders::Phong::Position{}, Shaders::Phong::Normal{});
+
+Buffer vertices;
+Mesh a, b;
+a.setVertexFormat(format)
+    .setVertexBuffer(0, vertices, 0)
+    .setCount(36);
+b.setVertexFormat(format)
+    .setVertexBuffer(0, vertices, 36*24)
+    .setCount(24);
+@endcode
+
+## Performance optimizations
+
+If @extension{ARB,vertex_attrib_binding} (part of OpenGL 4.3) or OpenGL ES
+3.1 is available, the format is backed by a single vertex array object, with
+the attribute layout specified only once using @fn_gl{VertexAttribFormat} and
+@fn_gl{VertexAttribBinding}. All meshes using the format are then drawn with
+this shared VAO and drawing a mesh only calls @fn_gl{BindVertexBuffer} and
+@fn_gl{BindBuffer} for buffer ranges that differ from the previously drawn
+mesh. The per-mesh VAO is not used in that case.
+
+If the functionality is not available, @ref Mesh::setVertexBuffer() expands
+the format into per-mesh attribute specification as if
+@ref Mesh::addVertexBuffer() was called, so the code works the same on all
+targets.
+
+The format must be kept alive for as long as any mesh references it and it
+can't be copied or moved. Adding attributes to a format already used by
+meshes is possible, the new layout is then used by all of them.
+
+@requires_gles30 Not available in OpenGL ES 2.0.
+@requires_webgl20 Not available in WebGL.
+*/
+class MAGNUM_EXPORT VertexFormat {
+    friend Mesh;
+
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Creates an empty format. The underlying vertex array object is
+         * created on first use.
+         */
+        explicit VertexFormat();
+
+        /** @brief Copying is not allowed */
+        VertexFormat(const VertexFormat&) = delete;
+
+        /** @brief Moving is not allowed */
+        VertexFormat(VertexFormat&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Deletes associated vertex array object, if any.
+         * @see @fn_gl{DeleteVertexArrays}
+         */
+        ~VertexFormat();
+
+        /** @brief Copying is not allowed */
+        VertexFormat& operator=(const VertexFormat&) = delete;
+
+        /** @brief Moving is not allowed */
+        VertexFormat& operator=(VertexFormat&&) = delete;
+
+        /**
+         * @brief OpenGL vertex array ID
+         *
+         * Zero if the shared vertex array object is not created yet or if
+         * @extension{ARB,vertex_attrib_binding} is not available.
+         */
+        GLuint id() const { return _id; }
+
+        /**
+         * @brief Binding count
+         *
+         * One more than the largest binding index specified using
+         * @ref addVertexBuffer().
+         */
+        UnsignedInt bindingCount() const { return _bindings.size(); }
+
+        /**
+         * @brief Binding stride
+         *
+         * Sum of sizes of all attributes and gaps in given binding.
+         * Expects that @p binding is less than @ref bindingCount().
+         */
+        GLsizei stride(UnsignedInt binding) const;
+
+        /**
+         * @brief Binding divisor
+         *
+         * Expects that @p binding is less than @ref bindingCount().
+         * @see @ref addVertexBufferInstanced()
+         */
+        UnsignedInt divisor(UnsignedInt binding) const;
+
+        /**
+         * @brief Add interleaved attributes for given binding
+         * @param binding       Binding index
+         * @param attributes    Attribute specifications
+         * @return Reference to self (for method chaining)
+         *
+         * The attributes and gaps are specified the same way as in
+         * @ref Mesh::addVertexBuffer(), except that there is no buffer and
+         * initial offset --- these are supplied per-mesh using
+         * @ref Mesh::setVertexBuffer(). Expects that the binding wasn't
+         * specified already.
+         */
+        template<class ...T> VertexFormat& addVertexBuffer(UnsignedInt binding, const T&... attributes) {
+            addBindingInternal(binding, Mesh::strideOfInterleaved(attributes...), 0);
+            addVertexBufferInternal(binding, 0, attributes...);
+            return *this;
+        }
+
+        /**
+         * @brief Add instanced interleaved attributes for given binding
+         * @param binding       Binding index
+         * @param divisor       Divisor
+         * @param attributes    Attribute specifications
+         * @return Reference to self (for method chaining)
+         *
+         * Similar to the above function, the @p divisor parameter specifies
+         * number of instances that will pass until new data are fetched from
+         * the buffer. See @ref Mesh::addVertexBufferInstanced() for more
+         * information.
+         */
+        template<class ...T> VertexFormat& addVertexBufferInstanced(UnsignedInt binding, UnsignedInt divisor, const T&... attributes) {
+            addBindingInternal(binding, Mesh::strideOfInterleaved(attributes...), divisor);
+            addVertexBufferInternal(binding, 0, attributes...);
+            return *this;
+        }
+
+    private:
+        struct AttributeFormat {
+            GLuint location;
+            GLint size;
+            GLenum type;
+            Mesh::AttributeKind kind;
+            GLuint relativeOffset;
+            GLuint binding;
+        };
+
+        struct Binding {
+            GLsizei stride;
+            GLuint divisor;
+            bool specified;
+
+            /* Currently bound buffer range, used to avoid redundant
+               glBindVertexBuffer() calls */
+            GLuint buffer;
+            GLintptr offset;
+        };
+
+        template<UnsignedInt location, class T, class ...U> void addVertexBufferInternal(UnsignedInt binding, GLuint offset, const Attribute<location, T>& attribute, const U&... attributes) {
+            addVertexAttribute(binding, attribute, offset);
+
+            /* Add size of this attribute to offset for next attribute */
+            addVertexBufferInternal(binding, offset+attribute.vectorSize()*Attribute<location, T>::VectorCount, attributes...);
+        }
+        template<class ...T> void addVertexBufferInternal(UnsignedInt binding, GLuint offset, GLintptr gap, const T&... attributes) {
+            /* Add the gap to offset for next attribute */
+            addVertexBufferInternal(binding, offset+gap, attributes...);
+        }
+        void addVertexBufferInternal(UnsignedInt, GLuint) {}
+
+        template<UnsignedInt location, class T> void addVertexAttribute(typename std::enable_if<std::is_same<typename Implementation::Attribute<T>::ScalarType, Float>::value, UnsignedInt>::type binding, const Attribute<location, T>& attribute, GLuint offset) {
+            for(UnsignedInt i = 0; i != Attribute<location, T>::VectorCount; ++i)
+                addAttributeInternal(binding,
+                    location+i,
+                    GLint(attribute.components()),
+                    GLenum(attribute.dataType()),
+                    attribute.dataOptions() & Attribute<location, T>::DataOption::Normalized ? Mesh::AttributeKind::GenericNormalized : Mesh::AttributeKind::Generic,
+                    GLuint(offset+i*attribute.vectorSize()));
+        }
+
+        template<UnsignedInt location, class T> void addVertexAttribute(typename std::enable_if<std::is_integral<typename Implementation::Attribute<T>::ScalarType>::value, UnsignedInt>::type binding, const Attribute<location, T>& attribute, GLuint offset) {
+            addAttributeInternal(binding,
+                location,
+                GLint(attribute.components()),
+                GLenum(attribute.dataType()),
+                Mesh::AttributeKind::Integral,
+                offset);
+        }
+
+        #ifndef MAGNUM_TARGET_GLES
+        template<UnsignedInt location, class T> void addVertexAttribute(typename std::enable_if<std::is_same<typename Implementation::Attribute<T>::ScalarType, Double>::value, UnsignedInt>::type binding, const Attribute<location, T>& attribute, GLuint offset) {
+            for(UnsignedInt i = 0; i != Attribute<location, T>::VectorCount; ++i)
+                addAttributeInternal(binding,
+                    location+i,
+                    GLint(attribute.components()),
+                    GLenum(attribute.dataType()),
+                    Mesh::AttributeKind::Long,
+                    GLuint(offset+i*attribute.vectorSize()));
+        }
+        #endif
+
+        void addBindingInternal(UnsignedInt binding, GLsizei stride, UnsignedInt divisor);
+        void addAttributeInternal(UnsignedInt binding, GLuint location, GLint size, GLenum type, Mesh::AttributeKind kind, GLuint relativeOffset);
+
+        void MAGNUM_LOCAL bindInternal();
+        void MAGNUM_LOCAL bindVertexBufferInternal(UnsignedInt binding, GLuint buffer, GLintptr offset);
+        void MAGNUM_LOCAL bindIndexBufferInternal(Buffer& buffer);
+
+        GLuint _id;
+        bool _dirty;
+        GLuint _indexBuffer;
+        std::vector<AttributeFormat> _attributes;
+        std::vector<Binding> _bindings;
+};
+
+}
+#else
+#error this header is not available in OpenGL ES 2.0 and WebGL build
+#endif
+
+#endif
@@ -0,0 +1,223 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "VirtualTexture.h"
+
+#include <algorithm>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/PixelStorage.h"
+#include "Magnum/TextureFormat.h"
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum {
+
+namespace {
+    /* Page coordinates are packed into 14 bits each, level into 4 bits */
+    constexpr UnsignedInt FeedbackPageBits = 14;
+    constexpr UnsignedInt FeedbackPageMask = (1 << FeedbackPageBits) - 1;
+    constexpr UnsignedInt FeedbackLevelShift = FeedbackPageBits*2;
+    constexpr UnsignedInt FeedbackNone = 0xffffffffu;
+}
+
+UnsignedInt VirtualTexture::feedbackId(const Int level, const Vector2i& page) {
+    CORRADE_ASSERT(level >= 0 && level < 15 && (page >= Vector2i{0}).all() && (page <= Vector2i{FeedbackPageMask}).all(),
+        "VirtualTexture::feedbackId(): level" << level << "or page" << page << "out of range", {});
+    return (UnsignedInt(level) << FeedbackLevelShift)|(UnsignedInt(page.y()) << FeedbackPageBits)|UnsignedInt(page.x());
+}
+
+VirtualTexture::VirtualTexture(const TextureFormat internalFormat, const Vector2i& size, const Int levels, Loader loader, const UnsignedInt pageBudget): _loader{std::move(loader)}, _size{size}, _levelCount{levels}, _pageBudget{pageBudget} {
+    _texture.setSparse(true)
+        .setStorage(levels, internalFormat, size);
+    _pageSize = Texture2D::pageSize(internalFormat);
+    _tailLevel = Math::min(_texture.sparseLevelCount(), levels);
+
+    /* Page bookkeeping for levels that can be committed page by page */
+    _levelOffsets.reserve(_tailLevel + 1);
+    std::size_t offset = 0;
+    for(Int level = 0; level != _tailLevel; ++level) {
+        _levelOffsets.push_back(offset);
+        offset += pageCount(level).product();
+    }
+    _levelOffsets.push_back(offset);
+    _pages.resize(offset, Page{0, false, false});
+
+    /* Commit and upload the mip tail, it stays resident for the whole
+       lifetime */
+    for(Int level = _tailLevel; level != levels; ++level) {
+        const Range2Di range{{}, Math::max(size/(1 << level), Vector2i{1})};
+        _texture.commitPages(level, range);
+        Image2D image = _loader(level, range);
+        if(image.data().size()) _texture.setSubImage(level, {}, image);
+    }
+
+    _pageTable.setMinificationFilter(Sampler::Filter::Nearest)
+        .setMagnificationFilter(Sampler::Filter::Nearest)
+        .setWrapping(Sampler::Wrapping::ClampToEdge)
+        .setStorage(1, TextureFormat::R8UI, pageCount(0));
+    updatePageTable();
+}
+
+VirtualTexture::~VirtualTexture() = default;
+
+Vector2i VirtualTexture::pageCount(const Int level) const {
+    CORRADE_ASSERT(level >= 0 && level < _levelCount,
+        "VirtualTexture::pageCount(): level" << level << "out of range for" << _levelCount << "levels", {});
+    const Vector2i levelSize = Math::max(_size/(1 << level), Vector2i{1});
+    return (levelSize + _pageSize - Vector2i{1})/_pageSize;
+}
+
+std::size_t VirtualTexture::pageIndex(const Int level, const Vector2i& page) const {
+    return _levelOffsets[level] + page.y()*pageCount(level).x() + page.x();
+}
+
+Range2Di VirtualTexture::pageRange(const Int level, const Vector2i& page) const {
+    /* Pages on the right and bottom edge are cut to the level size, which is
+       allowed by the sparse texture commitment rules */
+    const Vector2i levelSize = Math::max(_size/(1 << level), Vector2i{1});
+    const Vector2i min = page*_pageSize;
+    return {min, Math::min(min + _pageSize, levelSize)};
+}
+
+bool VirtualTexture::isResident(const Int level, const Vector2i& page) const {
+    if(level >= _tailLevel) return true;
+    return _pages[pageIndex(level, page)].resident;
+}
+
+VirtualTexture& VirtualTexture::request(Int level, const Vector2i& page) {
+    if(level < 0 || level >= _tailLevel || (page < Vector2i{0}).any() || (page >= pageCount(level)).any())
+        return *this;
+
+    /* Request also all pages containing this one in coarser levels */
+    Vector2i current = page;
+    for(; level != _tailLevel; ++level) {
+        current = Math::min(current, pageCount(level) - Vector2i{1});
+        const std::size_t index = pageIndex(level, current);
+        Page& p = _pages[index];
+        p.lastRequested = _frame;
+        if(!p.requested) {
+            p.requested = true;
+            _requested.push_back(index);
+        }
+        current /= 2;
+    }
+
+    return *this;
+}
+
+VirtualTexture& VirtualTexture::addFeedback(const Containers::ArrayView<const UnsignedInt> feedback) {
+    for(const UnsignedInt id: feedback) {
+        if(id == FeedbackNone) continue;
+        request(id >> FeedbackLevelShift, {Int(id & FeedbackPageMask), Int((id >> FeedbackPageBits) & FeedbackPageMask)});
+    }
+
+    return *this;
+}
+
+bool VirtualTexture::evictLeastRecentlyUsed() {
+    /* Pages requested for the current frame are not evictable */
+    auto found = _resident.end();
+    for(auto it = _resident.begin(); it != _resident.end(); ++it) {
+        if(_pages[*it].lastRequested >= _frame) continue;
+        if(found == _resident.end() || _pages[*it].lastRequested < _pages[*found].lastRequested)
+            found = it;
+    }
+    if(found == _resident.end()) return false;
+
+    const std::size_t index = *found;
+    const Int level = std::upper_bound(_levelOffsets.begin(), _levelOffsets.end(), index) - _levelOffsets.begin() - 1;
+    const std::size_t local = index - _levelOffsets[level];
+    const Int width = pageCount(level).x();
+    _texture.uncommitPages(level, pageRange(level, {Int(local % width), Int(local/width)}));
+    _pages[index].resident = false;
+
+    *found = _resident.back();
+    _resident.pop_back();
+    _pageTableDirty = true;
+    return true;
+}
+
+VirtualTexture& VirtualTexture::update() {
+    /* Levels are stored one after another, so descending index order means
+       coarsest levels first */
+    std::sort(_requested.begin(), _requested.end(), std::greater<std::size_t>{});
+
+    UnsignedInt uploaded = 0;
+    for(const std::size_t index: _requested) {
+        Page& p = _pages[index];
+        p.requested = false;
+        if(p.resident || (_uploadBudget && uploaded == _uploadBudget))
+            continue;
+
+        /* Make room for the page, give up if everything resident is in use */
+        if(_resident.size() >= _pageBudget && !evictLeastRecentlyUsed())
+            continue;
+
+        const Int level = std::upper_bound(_levelOffsets.begin(), _levelOffsets.end(), index) - _levelOffsets.begin() - 1;
+        const std::size_t local = index - _levelOffsets[level];
+        const Int width = pageCount(level).x();
+        const Range2Di range = pageRange(level, {Int(local % width), Int(local/width)});
+
+        Image2D image = _loader(level, range);
+        if(!image.data().size()) continue;
+
+        _texture.commitPages(level, range)
+            .setSubImage(level, range.min(), image);
+        p.resident = true;
+        _resident.push_back(index);
+        _pageTableDirty = true;
+        ++uploaded;
+    }
+    _requested.clear();
+
+    /* The budget might have been lowered since last time */
+    while(_resident.size() > _pageBudget && evictLeastRecentlyUsed()) {}
+
+    if(_pageTableDirty) updatePageTable();
+    ++_frame;
+    return *this;
+}
+
+void VirtualTexture::updatePageTable() {
+    /* For every page of the base level find the finest resident level */
+    const Vector2i count = pageCount(0);
+    Containers::Array<UnsignedByte> data{std::size_t(count.product())};
+    for(Int y = 0; y != count.y(); ++y) for(Int x = 0; x != count.x(); ++x) {
+        Int level = 0;
+        for(; level != _tailLevel; ++level) {
+            const Vector2i page = Math::min(Vector2i{x, y}/(1 << level), pageCount(level) - Vector2i{1});
+            if(_pages[pageIndex(level, page)].resident) break;
+        }
+        data[y*count.x() + x] = level;
+    }
+
+    _pageTable.setSubImage(0, {}, ImageView2D{PixelStorage{}.setAlignment(1),
+        PixelFormat::RedInteger, PixelType::UnsignedByte, count, data});
+    _pageTableDirty = false;
+}
+
+}
@@ -0,0 +1,282 @@
+#ifndef Magnum_VirtualTexture_h
+#define Magnum_VirtualTexture_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef MAGNUM_TARGET_GLES
+/** @file
+ * @brief Class @ref Magnum::VirtualTexture
+ */
+#endif
+
+#include <functional>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/Texture.h"
+
+#ifndef MAGNUM_TARGET_GLES
+namespace Magnum {
+
+/**
+@brief Virtual texture
+
+Manages a sparse @ref Texture2D whose pages are made resident on demand,
+based on feedback from the GPU. Only the *mip tail* --- the levels that can't
+be committed page by page, see @ref Texture::sparseLevelCount() --- is
+uploaded in the constructor. Other pages are requested with
+@ref addFeedback() or @ref request(), then committed and uploaded in
+@ref update() and evicted again in least-recently-used order when more than
+@ref pageBudget() pages would be resident.
+@code
+VirtualTexture terrain{TextureFormat::RGBA8, {65536, 65536}, 9,
+    [](Int level, const Range2Di& range) {
+        return loadTerrainTile(level, range); // returns Image2D
+    }, 2048};
+terrain.setUploadBudget(32);
+
+// each frame, after rendering the feedback pass to a R32UI framebuffer
+Image2D feedback = feedbackFramebuffer.read(feedbackFramebuffer.viewport(),
+    {PixelFormat::RedInteger, PixelType::UnsignedInt});
+terrain.addFeedback(Containers::arrayCast<const UnsignedInt>(feedback.data()))
+    .update();
+@endcode
+
+## Feedback
+
+The feedback pass is expected to write
+@cpp (level << 28)|(page.y << 14)|page.x @ce for every sampled pixel, where
+`page` is the texel coordinate at given `level` divided by @ref pageSize().
+@ref feedbackId() calculates the same value. Pixels set to @cpp 0xffffffff @ce
+(e.g. by clearing the framebuffer) are ignored. Requesting a page implicitly
+requests also all pages containing it in coarser levels, so there's always
+a fallback to sample.
+
+## Page table
+
+As sampling a page that's not committed gives undefined results, shaders
+should clamp the sampled level using @ref pageTable(). It is a
+@ref TextureFormat::R8UI texture with one pixel for each page of the level
+`0`, containing the finest level resident for given area. The table is
+reuploaded in @ref update() if residency changed.
+
+@requires_extension Extension @extension{ARB,sparse_texture}
+@requires_gl Sparse textures are not available in OpenGL ES and WebGL.
+*/
+class MAGNUM_EXPORT VirtualTexture {
+    public:
+        /**
+         * @brief Page loader
+         *
+         * Called with a mip level index and a range in that level, expected
+         * to return image data of that range. Return an image without any
+         * data to signal failure, the page will stay non-resident and can be
+         * requested again.
+         */
+        typedef std::function<Image2D(Int, const Range2Di&)> Loader;
+
+        /**
+         * @brief Feedback ID
+         *
+         * Calculates the value written by the feedback pass for given
+         * @p level and @p page. Expects that the level is less than `15`
+         * and both page coordinates are less than `16384`.
+         * @see @ref addFeedback()
+         */
+        static UnsignedInt feedbackId(Int level, const Vector2i& page);
+
+        /**
+         * @brief Constructor
+         * @param internalFormat    Internal texture format
+         * @param size              Size of the base level
+         * @param levels            Mip level count
+         * @param loader            Page loader
+         * @param pageBudget        Max count of resident pages, not counting
+         *      the mip tail
+         *
+         * Creates a sparse texture with the first page size available for
+         * @p internalFormat, commits the mip tail and synchronously uploads
+         * it using @p loader.
+         */
+        explicit VirtualTexture(TextureFormat internalFormat, const Vector2i& size, Int levels, Loader loader, UnsignedInt pageBudget);
+
+        /** @brief Copying is not allowed */
+        VirtualTexture(const VirtualTexture&) = delete;
+
+        /** @brief Moving is not allowed */
+        VirtualTexture(VirtualTexture&&) = delete;
+
+        ~VirtualTexture();
+
+        /** @brief Copying is not allowed */
+        VirtualTexture& operator=(const VirtualTexture&) = delete;
+
+        /** @brief Moving is not allowed */
+        VirtualTexture& operator=(VirtualTexture&&) = delete;
+
+        /**
+         * @brief Texture
+         *
+         * Set sampling parameters on the returned texture, but don't commit
+         * or modify its pages.
+         */
+        Texture2D& texture() { return _texture; }
+
+        /**
+         * @brief Page table
+         *
+         * See @ref VirtualTexture-page-table "class documentation" for more
+         * information.
+         */
+        Texture2D& pageTable() { return _pageTable; }
+
+        /** @brief Size of the base level */
+        Vector2i size() const { return _size; }
+
+        /** @brief Mip level count */
+        Int levelCount() const { return _levelCount; }
+
+        /**
+         * @brief First level of the mip tail
+         *
+         * Levels from this one to @ref levelCount() are always resident.
+         * @see @ref Texture::sparseLevelCount()
+         */
+        Int tailLevel() const { return _tailLevel; }
+
+        /** @brief Page size */
+        Vector2i pageSize() const { return _pageSize; }
+
+        /**
+         * @brief Page count in given level
+         *
+         * Expects that @p level is less than @ref tailLevel().
+         */
+        Vector2i pageCount(Int level) const;
+
+        /** @brief Max count of resident pages */
+        UnsignedInt pageBudget() const { return _pageBudget; }
+
+        /**
+         * @brief Set max count of resident pages
+         * @return Reference to self (for method chaining)
+         *
+         * The mip tail is not counted against the budget. If the budget is
+         * lowered, pages over budget are evicted in the next @ref update().
+         */
+        VirtualTexture& setPageBudget(UnsignedInt pages) {
+            _pageBudget = pages;
+            return *this;
+        }
+
+        /** @brief Upload budget in pages */
+        UnsignedInt uploadBudget() const { return _uploadBudget; }
+
+        /**
+         * @brief Set upload budget
+         * @return Reference to self (for method chaining)
+         *
+         * Limits the count of pages uploaded in one @ref update() call. Set
+         * to `0` to disable the limit, which is the default.
+         */
+        VirtualTexture& setUploadBudget(UnsignedInt pages) {
+            _uploadBudget = pages;
+            return *this;
+        }
+
+        /** @brief Count of resident pages, not counting the mip tail */
+        UnsignedInt residentPageCount() const { return _resident.size(); }
+
+        /**
+         * @brief Whether given page is resident
+         *
+         * Pages in the mip tail are always resident.
+         */
+        bool isResident(Int level, const Vector2i& page) const;
+
+        /**
+         * @brief Request a page
+         * @return Reference to self (for method chaining)
+         *
+         * Requests given page and all pages containing it in coarser levels
+         * for the next @ref update(). Requests for pages outside of the
+         * texture or in the mip tail are ignored.
+         */
+        VirtualTexture& request(Int level, const Vector2i& page);
+
+        /**
+         * @brief Add GPU feedback
+         * @return Reference to self (for method chaining)
+         *
+         * Calls @ref request() for all values in @p feedback, see
+         * @ref VirtualTexture-feedback "class documentation" for details
+         * about the format.
+         */
+        VirtualTexture& addFeedback(Containers::ArrayView<const UnsignedInt> feedback);
+
+        /**
+         * @brief Update residency
+         * @return Reference to self (for method chaining)
+         *
+         * Commits and uploads requested pages, coarsest levels first, until
+         * @ref uploadBudget() is exhausted, evicting least recently requested
+         * pages to stay within @ref pageBudget(). Pages requested since last
+         * update are never evicted. Clears the requests and updates
+         * @ref pageTable() if residency changed.
+         */
+        VirtualTexture& update();
+
+    private:
+        struct Page {
+            UnsignedInt lastRequested;
+            bool resident;
+            bool requested;
+        };
+
+        MAGNUM_LOCAL std::size_t pageIndex(Int level, const Vector2i& page) const;
+        MAGNUM_LOCAL Range2Di pageRange(Int level, const Vector2i& page) const;
+        MAGNUM_LOCAL bool evictLeastRecentlyUsed();
+        MAGNUM_LOCAL void updatePageTable();
+
+        Texture2D _texture, _pageTable;
+        Loader _loader;
+        Vector2i _size, _pageSize;
+        Int _levelCount, _tailLevel;
+        UnsignedInt _pageBudget, _uploadBudget{}, _frame{1};
+        bool _pageTableDirty{true};
+        /* Offset of first page of each sparse level in _pages */
+        std::vector<std::size_t> _levelOffsets;
+        std::vector<Page> _pages;
+        /* Indices of resident and requested pages */
+        std::vector<std::size_t> _resident, _requested;
+};
+
+}
+#else
+#error this header is not available in OpenGL ES build
+#endif
+
+#endif
@@ -1350,6 +1350,13 @@ typedef khronos_ssize_t GLsizeiptr;
 #define GL_INT_SAMPLER_2D_MULTISAMPLE_ARRAY_OES 0x910C
 #define GL_UNSIGNED_INT_SAMPLER_2D_MULTISAMPLE_ARRAY_OES 0x910D
 
+/* GL_OVR_multiview */
+
+#define GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_NUM_VIEWS_OVR 0x9630
+#define GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_BASE_VIEW_INDEX_OVR 0x9632
+#define GL_MAX_VIEWS_OVR 0x9631
+#define GL_FRAMEBUFFER_INCOMPLETE_VIEW_TARGETS_OVR 0x9633
+
 /* Function prototypes */
 
 /* GL_ES_VERSION_2_0 */
@@ -2032,6 +2039,11 @@ GLAPI FLEXTGL_EXPORT void(APIENTRY *flextglMinSampleShadingOES)(GLfloat);
 GLAPI FLEXTGL_EXPORT void(APIENTRY *flextglTexStorage3DMultisampleOES)(GLenum, GLsizei, GLenum, GLsizei, GLsizei, GLsizei, GLboolean);
 #define glTexStorage3DMultisampleOES flextglTexStorage3DMultisampleOES
 
+/* GL_OVR_multiview */
+
+GLAPI FLEXTGL_EXPORT void(APIENTRY *flextglFramebufferTextureMultiviewOVR)(GLenum, GLenum, GLuint, GLint, GLint, GLsizei);
+#define glFramebufferTextureMultiviewOVR flextglFramebufferTextureMultiviewOVR
+
 #ifdef __cplusplus
 }
 #endif
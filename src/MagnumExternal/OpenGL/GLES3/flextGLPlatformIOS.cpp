@@ -181,6 +181,7 @@
 #undef glUnmapBufferOES
 #undef glMinSampleShadingOES
 #undef glTexStorage3DMultisampleOES
+#undef glFramebufferTextureMultiviewOVR
 
 #include <ES3/glext.h>
 
@@ -454,4 +455,9 @@ void flextGLInit() {
     #if GL_OES_texture_storage_multisample_2d_array
     flextglTexStorage3DMultisampleOES = reinterpret_cast<void(APIENTRY*)(GLenum, GLsizei, GLenum, GLsizei, GLsizei, GLsizei, GLboolean)>(glTexStorage3DMultisampleOES);
     #endif
+
+    /* GL_OVR_multiview */
+    #if GL_OVR_multiview
+    flextglFramebufferTextureMultiviewOVR = reinterpret_cast<void(APIENTRY*)(GLenum, GLenum, GLuint, GLint, GLint, GLsizei)>(glFramebufferTextureMultiviewOVR);
+    #endif
 }
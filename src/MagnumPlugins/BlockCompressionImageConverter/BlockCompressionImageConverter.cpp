@@ -0,0 +1,819 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BlockCompressionImageConverter.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <tuple>
+#include <vector>
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#endif
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Endianness.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector4.h"
+
+namespace Magnum { namespace Trade {
+
+namespace {
+
+typedef BlockCompressionImageConverter::Format Format;
+typedef BlockCompressionImageConverter::Quality Quality;
+
+/* Calls function(begin, end) on evenly split parts of [0, count) range in
+   parallel */
+template<class F> void parallelFor(const std::size_t count, const std::size_t threadCount, const F& function) {
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    const std::size_t partCount = std::min(threadCount, count);
+    if(partCount > 1) {
+        std::vector<std::thread> threads;
+        threads.reserve(partCount - 1);
+        for(std::size_t i = 1; i != partCount; ++i)
+            threads.emplace_back(function, count*i/partCount, count*(i + 1)/partCount);
+        function(std::size_t{0}, count/partCount);
+        for(std::thread& thread: threads) thread.join();
+        return;
+    }
+    #else
+    static_cast<void>(threadCount);
+    #endif
+
+    function(std::size_t{0}, count);
+}
+
+/* 4x4 pixels in row-major order, values in the 0-255 range. The error
+   metrics below operate on these fixed-size arrays with branchless inner
+   loops, so the compiler can vectorize them. */
+typedef Vector4 Block[16];
+
+/* Squared distance over channels enabled in the mask */
+inline Float distanceSquared(const Vector4& a, const Vector4& b, const Vector4& mask) {
+    return ((a - b)*(a - b)*mask).sum();
+}
+
+/* Assigns the nearest palette entry to each pixel, returns total error */
+Float fitPalette(const Block& pixels, const Vector4* const palette, const std::size_t paletteSize, const Vector4& mask, UnsignedByte(&indices)[16]) {
+    Float error = 0.0f;
+    for(std::size_t i = 0; i != 16; ++i) {
+        Float best = distanceSquared(pixels[i], palette[0], mask);
+        UnsignedByte bestIndex = 0;
+        for(std::size_t j = 1; j != paletteSize; ++j) {
+            const Float d = distanceSquared(pixels[i], palette[j], mask);
+            if(d < best) {
+                best = d;
+                bestIndex = j;
+            }
+        }
+        indices[i] = bestIndex;
+        error += best;
+    }
+    return error;
+}
+
+/* Endpoints of a line through the block colors. Fast quality uses the
+   bounding box with its diagonal oriented by channel correlation, the other
+   qualities use the principal axis. */
+void fitLine(const Block& pixels, const Vector4& mask, const Quality quality, Vector4& a, Vector4& b) {
+    Vector4 mean;
+    for(const Vector4& pixel: pixels) mean += pixel;
+    mean /= 16.0f;
+
+    if(quality == Quality::Fast) {
+        Vector4 min{255.0f}, max{0.0f};
+        for(const Vector4& pixel: pixels) {
+            min = Math::min(min, pixel);
+            max = Math::max(max, pixel);
+        }
+
+        /* Orient the other channels against the one with the largest range */
+        const Vector4 range = (max - min)*mask;
+        std::size_t dominant = 0;
+        for(std::size_t i = 1; i != 4; ++i)
+            if(range[i] > range[dominant]) dominant = i;
+        Vector4 covariance;
+        for(const Vector4& pixel: pixels)
+            covariance += (pixel - mean)*(pixel[dominant] - mean[dominant]);
+        a = min;
+        b = max;
+        for(std::size_t i = 0; i != 4; ++i)
+            if(covariance[i] < 0.0f) std::swap(a[i], b[i]);
+        return;
+    }
+
+    /* Covariance matrix, only the upper triangle */
+    Float covariance[4][4]{};
+    for(const Vector4& pixel: pixels) {
+        const Vector4 d = (pixel - mean)*mask;
+        for(std::size_t i = 0; i != 4; ++i)
+            for(std::size_t j = i; j != 4; ++j)
+                covariance[i][j] += d[i]*d[j];
+    }
+    for(std::size_t i = 0; i != 4; ++i)
+        for(std::size_t j = 0; j != i; ++j)
+            covariance[i][j] = covariance[j][i];
+
+    /* Principal axis using power iteration */
+    Vector4 axis{1.0f};
+    axis *= mask;
+    for(std::size_t iteration = 0; iteration != 8; ++iteration) {
+        Vector4 next;
+        for(std::size_t i = 0; i != 4; ++i)
+            for(std::size_t j = 0; j != 4; ++j)
+                next[i] += covariance[i][j]*axis[j];
+        const Float length = next.length();
+        if(length < 1.0e-6f) break;
+        axis = next/length;
+    }
+
+    Float min = std::numeric_limits<Float>::max(), max = -min;
+    for(const Vector4& pixel: pixels) {
+        const Float t = Math::dot(pixel - mean, axis);
+        min = Math::min(min, t);
+        max = Math::max(max, t);
+    }
+    a = Math::clamp(mean + axis*min, 0.0f, 255.0f);
+    b = Math::clamp(mean + axis*max, 0.0f, 255.0f);
+}
+
+/* Least-squares endpoints for given palette indices, where palette entry k
+   is a*(1 - weights[k]) + b*weights[k]. Returns false if the system is
+   singular, e.g. when all pixels use the same entry. */
+bool refineLine(const Block& pixels, const UnsignedByte(&indices)[16], const Float* const weights, Vector4& a, Vector4& b) {
+    Float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+    Vector4 ap, bp;
+    for(std::size_t i = 0; i != 16; ++i) {
+        const Float w = weights[indices[i]];
+        aa += (1.0f - w)*(1.0f - w);
+        ab += (1.0f - w)*w;
+        bb += w*w;
+        ap += pixels[i]*(1.0f - w);
+        bp += pixels[i]*w;
+    }
+
+    const Float determinant = aa*bb - ab*ab;
+    if(Math::abs(determinant) < 1.0e-6f) return false;
+    a = Math::clamp((ap*bb - bp*ab)/determinant, 0.0f, 255.0f);
+    b = Math::clamp((bp*aa - ap*ab)/determinant, 0.0f, 255.0f);
+    return true;
+}
+
+/* BC1 color block */
+
+UnsignedShort packRgb565(const Vector4& color) {
+    return (UnsignedShort(color.r()*31.0f/255.0f + 0.5f) << 11)|
+           (UnsignedShort(color.g()*63.0f/255.0f + 0.5f) << 5)|
+            UnsignedShort(color.b()*31.0f/255.0f + 0.5f);
+}
+
+Vector4 unpackRgb565(const UnsignedShort color) {
+    const UnsignedInt r = color >> 11, g = (color >> 5) & 0x3f, b = color & 0x1f;
+    return {Float((r << 3)|(r >> 2)), Float((g << 2)|(g >> 4)), Float((b << 3)|(b >> 2)), 255.0f};
+}
+
+void writeLittleEndian(char* const out, std::uint64_t value, const std::size_t size) {
+    for(std::size_t i = 0; i != size; ++i, value >>= 8)
+        out[i] = char(value & 0xff);
+}
+
+void encodeBc1(const Block& pixels, const Quality quality, char* const out) {
+    constexpr Float Weights[]{0.0f, 1.0f, 1.0f/3.0f, 2.0f/3.0f};
+    const Vector4 mask{1.0f, 1.0f, 1.0f, 0.0f};
+
+    Vector4 a, b;
+    fitLine(pixels, mask, quality, a, b);
+
+    Float bestError = std::numeric_limits<Float>::max();
+    UnsignedShort bestColors[2]{};
+    UnsignedByte bestIndices[16]{};
+    for(std::size_t iteration = 0, iterationCount = quality == Quality::High ? 3 : 1; iteration != iterationCount; ++iteration) {
+        /* Four-color mode requires color0 > color1, swap the endpoints if
+           they are the other way */
+        UnsignedShort colors[]{packRgb565(a), packRgb565(b)};
+        if(colors[0] < colors[1]) {
+            std::swap(colors[0], colors[1]);
+            std::swap(a, b);
+        }
+
+        const Vector4 c0 = unpackRgb565(colors[0]), c1 = unpackRgb565(colors[1]);
+        const Vector4 palette[]{c0, c1, (c0*2.0f + c1)/3.0f, (c0 + c1*2.0f)/3.0f};
+        UnsignedByte indices[16];
+        const Float error = fitPalette(pixels, palette, colors[0] == colors[1] ? 1 : 4, mask, indices);
+        if(error < bestError) {
+            bestError = error;
+            bestColors[0] = colors[0];
+            bestColors[1] = colors[1];
+            std::copy_n(indices, 16, bestIndices);
+        }
+
+        if(iterationCount == 1 || !refineLine(pixels, indices, Weights, a, b)) break;
+    }
+
+    UnsignedInt bits = 0;
+    for(std::size_t i = 0; i != 16; ++i) bits |= UnsignedInt(bestIndices[i]) << (2*i);
+    writeLittleEndian(out, bestColors[0], 2);
+    writeLittleEndian(out + 2, bestColors[1], 2);
+    writeLittleEndian(out + 4, bits, 4);
+}
+
+/* BC4 single-channel block, also used for BC3 alpha and BC5 */
+
+Float fitPalette(const Float(&values)[16], const Float(&palette)[8], UnsignedByte(&indices)[16]) {
+    Float error = 0.0f;
+    for(std::size_t i = 0; i != 16; ++i) {
+        Float best = (values[i] - palette[0])*(values[i] - palette[0]);
+        UnsignedByte bestIndex = 0;
+        for(std::size_t j = 1; j != 8; ++j) {
+            const Float d = (values[i] - palette[j])*(values[i] - palette[j]);
+            if(d < best) {
+                best = d;
+                bestIndex = j;
+            }
+        }
+        indices[i] = bestIndex;
+        error += best;
+    }
+    return error;
+}
+
+/* Palette for given endpoints, eight interpolated values if r0 > r1, six
+   and 0 and 255 otherwise */
+void bc4Palette(const UnsignedByte r0, const UnsignedByte r1, Float(&palette)[8]) {
+    palette[0] = r0;
+    palette[1] = r1;
+    if(r0 > r1) {
+        for(std::size_t i = 1; i != 7; ++i)
+            palette[i + 1] = ((7 - i)*r0 + i*r1)/7.0f;
+    } else {
+        for(std::size_t i = 1; i != 5; ++i)
+            palette[i + 1] = ((5 - i)*r0 + i*r1)/5.0f;
+        palette[6] = 0.0f;
+        palette[7] = 255.0f;
+    }
+}
+
+void encodeBc4(const Float(&values)[16], const Quality quality, char* const out) {
+    Float min = 255.0f, max = 0.0f;
+    for(const Float value: values) {
+        min = Math::min(min, value);
+        max = Math::max(max, value);
+    }
+
+    UnsignedByte best[]{UnsignedByte(max + 0.5f), UnsignedByte(min + 0.5f)};
+    /* Eight-value mode needs r0 > r1, the six-value mode with r0 == r1
+       gives the same result for a constant block */
+    Float palette[8];
+    bc4Palette(best[0], best[1], palette);
+    UnsignedByte bestIndices[16];
+    Float bestError = fitPalette(values, palette, bestIndices);
+
+    /* Least-squares refinement of the eight-value mode */
+    if(quality == Quality::High && best[0] > best[1]) {
+        constexpr Float Weights[]{0.0f, 1.0f, 1.0f/7.0f, 2.0f/7.0f, 3.0f/7.0f, 4.0f/7.0f, 5.0f/7.0f, 6.0f/7.0f};
+        UnsignedByte indices[16];
+        std::copy_n(bestIndices, 16, indices);
+        for(std::size_t iteration = 0; iteration != 2; ++iteration) {
+            Float aa = 0.0f, ab = 0.0f, bb = 0.0f, ap = 0.0f, bp = 0.0f;
+            for(std::size_t i = 0; i != 16; ++i) {
+                const Float w = Weights[indices[i]];
+                aa += (1.0f - w)*(1.0f - w);
+                ab += (1.0f - w)*w;
+                bb += w*w;
+                ap += values[i]*(1.0f - w);
+                bp += values[i]*w;
+            }
+            const Float determinant = aa*bb - ab*ab;
+            if(Math::abs(determinant) < 1.0e-6f) break;
+
+            const UnsignedByte r0 = UnsignedByte(Math::clamp((ap*bb - bp*ab)/determinant, 0.0f, 255.0f) + 0.5f);
+            const UnsignedByte r1 = UnsignedByte(Math::clamp((bp*aa - ap*ab)/determinant, 0.0f, 255.0f) + 0.5f);
+            if(r0 <= r1) break;
+
+            bc4Palette(r0, r1, palette);
+            const Float error = fitPalette(values, palette, indices);
+            if(error >= bestError) break;
+            bestError = error;
+            best[0] = r0;
+            best[1] = r1;
+            std::copy_n(indices, 16, bestIndices);
+        }
+    }
+
+    /* Six-value mode with explicit 0 and 255 for blocks that contain the
+       extremes */
+    if(quality != Quality::Fast && (min == 0.0f || max == 255.0f)) {
+        Float innerMin = 255.0f, innerMax = 0.0f;
+        for(const Float value: values) if(value != 0.0f && value != 255.0f) {
+            innerMin = Math::min(innerMin, value);
+            innerMax = Math::max(innerMax, value);
+        }
+
+        if(innerMin <= innerMax) {
+            const UnsignedByte r0 = UnsignedByte(innerMin + 0.5f), r1 = UnsignedByte(innerMax + 0.5f);
+            bc4Palette(r0, r1, palette);
+            UnsignedByte indices[16];
+            const Float error = fitPalette(values, palette, indices);
+            if(error < bestError) {
+                bestError = error;
+                best[0] = r0;
+                best[1] = r1;
+                std::copy_n(indices, 16, bestIndices);
+            }
+        }
+    }
+
+    std::uint64_t bits = 0;
+    for(std::size_t i = 0; i != 16; ++i) bits |= std::uint64_t(bestIndices[i]) << (3*i);
+    out[0] = char(best[0]);
+    out[1] = char(best[1]);
+    writeLittleEndian(out + 2, bits, 6);
+}
+
+void encodeBc4Channel(const Block& pixels, const std::size_t channel, const Quality quality, char* const out) {
+    Float values[16];
+    for(std::size_t i = 0; i != 16; ++i) values[i] = pixels[i][channel];
+    encodeBc4(values, quality, out);
+}
+
+/* BC7 mode 6 block -- single subset, RGBA endpoints with 7 bits and a
+   per-endpoint shared lowest bit, 4-bit indices */
+
+#ifndef MAGNUM_TARGET_GLES
+constexpr UnsignedInt Bc7Weights4[]{0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+/* Picks the shared bit that gives the lower quantization error */
+void quantizeBc7(const Vector4& endpoint, UnsignedByte(&quantized)[4], UnsignedByte& pBit) {
+    Float bestError = std::numeric_limits<Float>::max();
+    for(UnsignedByte p = 0; p != 2; ++p) {
+        UnsignedByte q[4];
+        Float error = 0.0f;
+        for(std::size_t i = 0; i != 4; ++i) {
+            q[i] = UnsignedByte(Math::clamp(Int((endpoint[i] - p)*0.5f + 0.5f), 0, 127));
+            const Float d = Float((q[i] << 1)|p) - endpoint[i];
+            error += d*d;
+        }
+        if(error < bestError) {
+            bestError = error;
+            pBit = p;
+            std::copy_n(q, 4, quantized);
+        }
+    }
+}
+
+/* LSB-first bit writer */
+void writeBits(char* const out, std::size_t& position, const UnsignedInt value, const std::size_t count) {
+    for(std::size_t i = 0; i != count; ++i, ++position)
+        if(value & (1u << i)) out[position >> 3] |= char(1 << (position & 7));
+}
+
+void encodeBc7(const Block& pixels, const Quality quality, char* const out) {
+    Float weights[16];
+    for(std::size_t i = 0; i != 16; ++i) weights[i] = Bc7Weights4[i]/64.0f;
+    const Vector4 mask{1.0f};
+
+    Vector4 a, b;
+    fitLine(pixels, mask, quality, a, b);
+
+    Float bestError = std::numeric_limits<Float>::max();
+    UnsignedByte bestEndpoints[2][4]{}, bestPBits[2]{};
+    UnsignedByte bestIndices[16]{};
+    for(std::size_t iteration = 0, iterationCount = quality == Quality::High ? 3 : 1; iteration != iterationCount; ++iteration) {
+        UnsignedByte endpoints[2][4], pBits[2];
+        quantizeBc7(a, endpoints[0], pBits[0]);
+        quantizeBc7(b, endpoints[1], pBits[1]);
+
+        Vector4 decoded[2];
+        for(std::size_t e = 0; e != 2; ++e)
+            for(std::size_t i = 0; i != 4; ++i)
+                decoded[e][i] = (endpoints[e][i] << 1)|pBits[e];
+
+        Vector4 palette[16];
+        for(std::size_t k = 0; k != 16; ++k)
+            for(std::size_t i = 0; i != 4; ++i)
+                palette[k][i] = ((64 - Bc7Weights4[k])*UnsignedInt(decoded[0][i]) + Bc7Weights4[k]*UnsignedInt(decoded[1][i]) + 32) >> 6;
+
+        UnsignedByte indices[16];
+        const Float error = fitPalette(pixels, palette, 16, mask, indices);
+        if(error < bestError) {
+            bestError = error;
+            std::memcpy(bestEndpoints, endpoints, sizeof(endpoints));
+            std::copy_n(pBits, 2, bestPBits);
+            std::copy_n(indices, 16, bestIndices);
+        }
+
+        if(iterationCount == 1 || !refineLine(pixels, indices, weights, a, b)) break;
+    }
+
+    /* The highest bit of the first index is implicitly zero, swap the
+       endpoints if it isn't */
+    if(bestIndices[0] & 0x8) {
+        for(std::size_t i = 0; i != 4; ++i)
+            std::swap(bestEndpoints[0][i], bestEndpoints[1][i]);
+        std::swap(bestPBits[0], bestPBits[1]);
+        for(UnsignedByte& index: bestIndices) index = 15 - index;
+    }
+
+    std::fill_n(out, 16, 0);
+    std::size_t position = 0;
+    writeBits(out, position, 1 << 6, 7);
+    for(std::size_t i = 0; i != 4; ++i) {
+        writeBits(out, position, bestEndpoints[0][i], 7);
+        writeBits(out, position, bestEndpoints[1][i], 7);
+    }
+    writeBits(out, position, bestPBits[0], 1);
+    writeBits(out, position, bestPBits[1], 1);
+    writeBits(out, position, bestIndices[0], 3);
+    for(std::size_t i = 1; i != 16; ++i)
+        writeBits(out, position, bestIndices[i], 4);
+}
+#endif
+
+/* ETC2 RGB block using the ETC1-compatible individual and differential
+   modes */
+
+#ifndef MAGNUM_TARGET_GLES2
+constexpr Int EtcModifiers[8][4]{
+    {2, 8, -2, -8},
+    {5, 17, -5, -17},
+    {9, 29, -9, -29},
+    {13, 42, -13, -42},
+    {18, 60, -18, -60},
+    {24, 80, -24, -80},
+    {33, 106, -33, -106},
+    {47, 183, -47, -183}
+};
+
+struct EtcSubblock {
+    Float error;
+    UnsignedByte table;
+    UnsignedByte indices[8];
+};
+
+/* Finds the best modifier table for eight pixels and a base color */
+EtcSubblock fitEtcSubblock(const Vector4(&pixels)[8], const Vector3i& base) {
+    EtcSubblock best{std::numeric_limits<Float>::max(), 0, {}};
+    for(UnsignedByte table = 0; table != 8; ++table) {
+        Vector4 palette[4];
+        for(std::size_t k = 0; k != 4; ++k)
+            palette[k] = Vector4{Vector3{Math::clamp(base + Vector3i{EtcModifiers[table][k]}, 0, 255)}, 0.0f};
+
+        EtcSubblock current{0.0f, table, {}};
+        for(std::size_t i = 0; i != 8; ++i) {
+            Float bestDistance = distanceSquared(pixels[i], palette[0], {1.0f, 1.0f, 1.0f, 0.0f});
+            for(UnsignedByte k = 1; k != 4; ++k) {
+                const Float d = distanceSquared(pixels[i], palette[k], {1.0f, 1.0f, 1.0f, 0.0f});
+                if(d < bestDistance) {
+                    bestDistance = d;
+                    current.indices[i] = k;
+                }
+            }
+            current.error += bestDistance;
+        }
+        if(current.error < best.error) best = current;
+    }
+    return best;
+}
+
+inline Vector3i extend4(const Vector3i& color) { return color*16 + color; }
+inline Vector3i extend5(const Vector3i& color) { return color*8 + color/4; }
+
+/* Best quantized base color for a subblock, searching the neighborhood of
+   the average color in High quality. The bits parameter is 4 or 5,
+   acceptable() filters out colors not representable in the differential
+   mode. */
+template<class F> std::pair<Vector3i, EtcSubblock> fitEtcBase(const Vector4(&pixels)[8], const Int bits, const Quality quality, const F& acceptable) {
+    Vector3 average;
+    for(const Vector4& pixel: pixels) average += pixel.xyz();
+    average /= 8.0f;
+
+    const Int max = (1 << bits) - 1;
+    const Vector3i center = Math::clamp(Vector3i{average*Float(max)/255.0f + Vector3{0.5f}}, 0, max);
+    const Int radius = quality == Quality::High ? 1 : 0;
+
+    std::pair<Vector3i, EtcSubblock> best{{}, {std::numeric_limits<Float>::max(), 0, {}}};
+    for(Int r = -radius; r <= radius; ++r)
+        for(Int g = -radius; g <= radius; ++g)
+            for(Int b = -radius; b <= radius; ++b) {
+                const Vector3i color = center + Vector3i{r, g, b};
+                if(color.min() < 0 || color.max() > max || !acceptable(color)) continue;
+
+                const EtcSubblock subblock = fitEtcSubblock(pixels, bits == 4 ? extend4(color) : extend5(color));
+                if(subblock.error < best.second.error) best = {color, subblock};
+            }
+    return best;
+}
+
+void encodeEtc2(const Block& pixels, const Quality quality, char* const out) {
+    Float bestError = std::numeric_limits<Float>::max();
+    UnsignedInt bestHigh = 0, bestLow = 0;
+
+    for(UnsignedInt flip = 0; flip != 2; ++flip) {
+        /* Fast quality picks the split direction along the larger color
+           difference between the halves */
+        if(quality == Quality::Fast) {
+            Vector3 left, right, top, bottom;
+            for(std::size_t y = 0; y != 4; ++y) for(std::size_t x = 0; x != 4; ++x) {
+                const Vector3 color = pixels[y*4 + x].xyz();
+                (x < 2 ? left : right) += color;
+                (y < 2 ? top : bottom) += color;
+            }
+            if(flip != UnsignedInt((top - bottom).dot() > (left - right).dot())) continue;
+        }
+
+        /* Subblock pixels, in the order of their index bits */
+        Vector4 subblockPixels[2][8];
+        UnsignedByte subblockPixelIds[2][8];
+        UnsignedByte counts[2]{};
+        for(UnsignedByte x = 0; x != 4; ++x) for(UnsignedByte y = 0; y != 4; ++y) {
+            const std::size_t subblock = flip ? y >= 2 : x >= 2;
+            subblockPixels[subblock][counts[subblock]] = pixels[y*4 + x];
+            subblockPixelIds[subblock][counts[subblock]++] = x*4 + y;
+        }
+
+        /* Differential mode if the base colors are close enough, as
+           otherwise it would be interpreted as one of the ETC2-specific
+           modes. High quality tries also the individual mode. */
+        for(UnsignedInt differential = 0; differential != 2; ++differential) {
+            std::pair<Vector3i, EtcSubblock> first, second;
+            if(differential) {
+                first = fitEtcBase(subblockPixels[0], 5, quality, [](const Vector3i&) { return true; });
+                const Vector3i base = first.first;
+                second = fitEtcBase(subblockPixels[1], 5, quality, [&base](const Vector3i& color) {
+                    const Vector3i delta = color - base;
+                    return delta.min() >= -4 && delta.max() <= 3;
+                });
+
+                /* Not representable, fall back to the individual mode */
+                if(second.second.error == std::numeric_limits<Float>::max()) continue;
+            } else {
+                if(quality != Quality::High) {
+                    /* Use the individual mode only if the differential
+                       can't represent the averages */
+                    Vector3 averages[2];
+                    for(std::size_t s = 0; s != 2; ++s) {
+                        for(const Vector4& pixel: subblockPixels[s]) averages[s] += pixel.xyz();
+                        averages[s] /= 8.0f;
+                    }
+                    const Vector3i delta = Vector3i{averages[1]*31.0f/255.0f + Vector3{0.5f}} - Vector3i{averages[0]*31.0f/255.0f + Vector3{0.5f}};
+                    if(delta.min() >= -4 && delta.max() <= 3) continue;
+                }
+
+                first = fitEtcBase(subblockPixels[0], 4, quality, [](const Vector3i&) { return true; });
+                second = fitEtcBase(subblockPixels[1], 4, quality, [](const Vector3i&) { return true; });
+            }
+
+            const Float error = first.second.error + second.second.error;
+            if(error >= bestError) continue;
+            bestError = error;
+
+            const Vector3i& c0 = first.first;
+            const Vector3i& c1 = second.first;
+            if(differential) {
+                const Vector3i delta = c1 - c0;
+                bestHigh = (UnsignedInt(c0.x()) << 27)|(UnsignedInt(delta.x() & 7) << 24)|
+                           (UnsignedInt(c0.y()) << 19)|(UnsignedInt(delta.y() & 7) << 16)|
+                           (UnsignedInt(c0.z()) << 11)|(UnsignedInt(delta.z() & 7) << 8);
+            } else {
+                bestHigh = (UnsignedInt(c0.x()) << 28)|(UnsignedInt(c1.x()) << 24)|
+                           (UnsignedInt(c0.y()) << 20)|(UnsignedInt(c1.y()) << 16)|
+                           (UnsignedInt(c0.z()) << 12)|(UnsignedInt(c1.z()) << 8);
+            }
+            bestHigh |= (first.second.table << 5)|(second.second.table << 2)|(differential << 1)|flip;
+
+            /* Index value 0 is the small positive modifier, 1 is the large
+               positive, 2 small negative and 3 large negative. The high bit
+               goes to the upper half. */
+            bestLow = 0;
+            const EtcSubblock* const subblocks[]{&first.second, &second.second};
+            for(std::size_t s = 0; s != 2; ++s)
+                for(std::size_t i = 0; i != 8; ++i) {
+                    const UnsignedInt index = subblocks[s]->indices[i];
+                    const UnsignedInt bit = subblockPixelIds[s][i];
+                    bestLow |= ((index >> 1) << (16 + bit))|((index & 1) << bit);
+                }
+        }
+    }
+
+    for(std::size_t i = 0; i != 4; ++i) {
+        out[i] = char(bestHigh >> (24 - 8*i));
+        out[4 + i] = char(bestLow >> (24 - 8*i));
+    }
+}
+#endif
+
+std::pair<CompressedPixelFormat, std::size_t> formatProperties(const Format format) {
+    switch(format) {
+        case Format::Bc1: return {CompressedPixelFormat::RGBS3tcDxt1, 8};
+        case Format::Bc3: return {CompressedPixelFormat::RGBAS3tcDxt5, 16};
+        #ifndef MAGNUM_TARGET_GLES
+        case Format::Bc4: return {CompressedPixelFormat::RedRgtc1, 8};
+        case Format::Bc5: return {CompressedPixelFormat::RGRgtc2, 16};
+        case Format::Bc7: return {CompressedPixelFormat::RGBABptcUnorm, 16};
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        case Format::Etc2: return {CompressedPixelFormat::RGB8Etc2, 8};
+        #endif
+        case Format::Automatic: break;
+    }
+
+    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+}
+
+BlockCompressionImageConverter::BlockCompressionImageConverter() = default;
+
+BlockCompressionImageConverter::BlockCompressionImageConverter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImageConverter{manager, plugin} {}
+
+auto BlockCompressionImageConverter::doFeatures() const -> Features { return Feature::ConvertCompressedImage|Feature::ConvertData; }
+
+std::optional<CompressedImage2D> BlockCompressionImageConverter::doExportToCompressedImage(const ImageView2D& image) {
+    #ifndef MAGNUM_TARGET_GLES
+    if(image.storage().swapBytes()) {
+        Error() << "Trade::BlockCompressionImageConverter::exportToCompressedImage(): pixel byte swap is not supported";
+        return std::nullopt;
+    }
+    #endif
+
+    if(image.type() != PixelType::UnsignedByte) {
+        Error() << "Trade::BlockCompressionImageConverter::exportToCompressedImage(): unsupported color type" << image.type();
+        return std::nullopt;
+    }
+
+    /* Channel count and whether the first channel is luminance */
+    std::size_t channelCount;
+    bool luminance = false;
+    switch(image.format()) {
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        case PixelFormat::Red: channelCount = 1; break;
+        case PixelFormat::RG: channelCount = 2; break;
+        #endif
+        #ifdef MAGNUM_TARGET_GLES2
+        case PixelFormat::Luminance: channelCount = 1; luminance = true; break;
+        case PixelFormat::LuminanceAlpha: channelCount = 2; luminance = true; break;
+        #endif
+        case PixelFormat::RGB: channelCount = 3; break;
+        case PixelFormat::RGBA: channelCount = 4; break;
+        default:
+            Error() << "Trade::BlockCompressionImageConverter::exportToCompressedImage(): unsupported color format" << image.format();
+            return std::nullopt;
+    }
+
+    Format format = _format;
+    if(format == Format::Automatic) {
+        #ifndef MAGNUM_TARGET_GLES
+        constexpr Format Formats[]{Format::Bc4, Format::Bc5, Format::Bc1, Format::Bc3};
+        format = Formats[channelCount - 1];
+        #elif !defined(MAGNUM_TARGET_GLES2)
+        format = Format::Etc2;
+        #else
+        format = channelCount == 1 || channelCount == 3 ? Format::Bc1 : Format::Bc3;
+        #endif
+    }
+
+    CompressedPixelFormat compressedFormat;
+    std::size_t blockDataSize;
+    std::tie(compressedFormat, blockDataSize) = formatProperties(format);
+
+    const Vector2i blockCount = (image.size() + Vector2i{3})/4;
+    Containers::Array<char> data{std::size_t(blockCount.product())*blockDataSize};
+
+    /* Image data pointer including skip */
+    const char* const imageData = image.data() + std::get<0>(image.dataProperties()).sum();
+    const std::size_t rowStride = std::get<1>(image.dataProperties()).x();
+    const Vector2i size = image.size();
+    const Quality quality = _quality;
+
+    /* Encode rows of blocks in parallel */
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    const std::size_t threadCount = _threadCount ? _threadCount : std::max(std::thread::hardware_concurrency(), 1u);
+    #else
+    const std::size_t threadCount = 1;
+    #endif
+    parallelFor(blockCount.y(), threadCount, [&](const std::size_t begin, const std::size_t end) {
+        Block pixels;
+        for(std::size_t by = begin; by != end; ++by) for(Int bx = 0; bx != blockCount.x(); ++bx) {
+            /* Gather the block, replicating edge pixels */
+            for(Int y = 0; y != 4; ++y) for(Int x = 0; x != 4; ++x) {
+                const Int py = Math::min(Int(by*4) + y, size.y() - 1);
+                const Int px = Math::min(bx*4 + x, size.x() - 1);
+                const auto* const pixel = reinterpret_cast<const UnsignedByte*>(imageData + py*rowStride + px*channelCount);
+                Vector4& out = pixels[y*4 + x];
+                out = {0.0f, 0.0f, 0.0f, 255.0f};
+                for(std::size_t i = 0; i != channelCount; ++i) out[i] = pixel[i];
+                if(luminance) {
+                    if(channelCount == 2) out.a() = out.g();
+                    out.g() = out.b() = out.r();
+                }
+            }
+
+            char* const block = data + (by*blockCount.x() + bx)*blockDataSize;
+            switch(format) {
+                case Format::Bc1:
+                    encodeBc1(pixels, quality, block);
+                    break;
+                case Format::Bc3:
+                    encodeBc4Channel(pixels, 3, quality, block);
+                    encodeBc1(pixels, quality, block + 8);
+                    break;
+                #ifndef MAGNUM_TARGET_GLES
+                case Format::Bc4:
+                    encodeBc4Channel(pixels, 0, quality, block);
+                    break;
+                case Format::Bc5:
+                    encodeBc4Channel(pixels, 0, quality, block);
+                    encodeBc4Channel(pixels, 1, quality, block + 8);
+                    break;
+                case Format::Bc7:
+                    encodeBc7(pixels, quality, block);
+                    break;
+                #endif
+                #ifndef MAGNUM_TARGET_GLES2
+                case Format::Etc2:
+                    encodeEtc2(pixels, quality, block);
+                    break;
+                #endif
+                case Format::Automatic: CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+            }
+        }
+    });
+
+    return CompressedImage2D{compressedFormat, image.size(), std::move(data)};
+}
+
+Containers::Array<char> BlockCompressionImageConverter::doExportToData(const ImageView2D& image) {
+    std::optional<CompressedImage2D> compressed = doExportToCompressedImage(image);
+    if(!compressed) return nullptr;
+
+    /* Base internal format of the compressed format */
+    UnsignedInt baseFormat;
+    switch(compressed->format()) {
+        #ifndef MAGNUM_TARGET_GLES
+        case CompressedPixelFormat::RedRgtc1: baseFormat = UnsignedInt(PixelFormat::Red); break;
+        case CompressedPixelFormat::RGRgtc2: baseFormat = UnsignedInt(PixelFormat::RG); break;
+        case CompressedPixelFormat::RGBABptcUnorm:
+        #endif
+        case CompressedPixelFormat::RGBAS3tcDxt5: baseFormat = UnsignedInt(PixelFormat::RGBA); break;
+        default: baseFormat = UnsignedInt(PixelFormat::RGB);
+    }
+
+    /* KTX 1.1 file with a single image and no key/value data. Compressed
+       formats have zero type and format. */
+    constexpr char Identifier[]{'\xab', 'K', 'T', 'X', ' ', '1', '1', '\xbb', '\r', '\n', '\x1a', '\n'};
+    const UnsignedInt header[]{
+        0x04030201,                             /* endianness */
+        0,                                      /* glType */
+        1,                                      /* glTypeSize */
+        0,                                      /* glFormat */
+        UnsignedInt(compressed->format()),      /* glInternalFormat */
+        baseFormat,                             /* glBaseInternalFormat */
+        UnsignedInt(compressed->size().x()),    /* pixelWidth */
+        UnsignedInt(compressed->size().y()),    /* pixelHeight */
+        0,                                      /* pixelDepth */
+        0,                                      /* numberOfArrayElements */
+        1,                                      /* numberOfFaces */
+        1,                                      /* numberOfMipmapLevels */
+        0,                                      /* bytesOfKeyValueData */
+        UnsignedInt(compressed->data().size())  /* imageSize */
+    };
+
+    Containers::Array<char> data{sizeof(Identifier) + sizeof(header) + compressed->data().size()};
+    std::copy_n(Identifier, sizeof(Identifier), data.begin());
+    for(std::size_t i = 0; i != sizeof(header)/sizeof(UnsignedInt); ++i) {
+        const UnsignedInt value = Utility::Endianness::littleEndian(header[i]);
+        std::memcpy(data + sizeof(Identifier) + i*4, &value, 4);
+    }
+    std::copy_n(compressed->data().begin(), compressed->data().size(), data.begin() + sizeof(Identifier) + sizeof(header));
+
+    return data;
+}
+
+}}
@@ -0,0 +1,231 @@
+#ifndef Magnum_Trade_BlockCompressionImageConverter_h
+#define Magnum_Trade_BlockCompressionImageConverter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::BlockCompressionImageConverter
+ */
+
+#include "Magnum/Trade/AbstractImageConverter.h"
+
+#include "MagnumPlugins/BlockCompressionImageConverter/configure.h"
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+#ifndef MAGNUM_BLOCKCOMPRESSIONIMAGECONVERTER_BUILD_STATIC
+    #if defined(BlockCompressionImageConverter_EXPORTS) || defined(BlockCompressionImageConverterObjects_EXPORTS)
+        #define MAGNUM_BLOCKCOMPRESSIONIMAGECONVERTER_EXPORT CORRADE_VISIBILITY_EXPORT
+    #else
+        #define MAGNUM_BLOCKCOMPRESSIONIMAGECONVERTER_EXPORT CORRADE_VISIBILITY_IMPORT
+    #endif
+#else
+    #define MAGNUM_BLOCKCOMPRESSIONIMAGECONVERTER_EXPORT CORRADE_VISIBILITY_STATIC
+#endif
+#define MAGNUM_BLOCKCOMPRESSIONIMAGECONVERTER_LOCAL CORRADE_VISIBILITY_LOCAL
+#endif
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Block compression image converter plugin
+
+Encodes images with format @ref PixelFormat::RGB, @ref PixelFormat::RGBA,
+@ref PixelFormat::RG or @ref PixelFormat::Red (or their luminance
+equivalents on OpenGL ES 2.0) and type
+@ref PixelType::UnsignedByte into one of the following block-compressed
+formats, selected with @ref setFormat():
+
+-   @ref Format::Bc1 --- @ref CompressedPixelFormat::RGBS3tcDxt1, alpha
+    channel of the input is ignored
+-   @ref Format::Bc3 --- @ref CompressedPixelFormat::RGBAS3tcDxt5
+-   @ref Format::Bc4 --- @ref CompressedPixelFormat::RedRgtc1, uses the first
+    input channel. Not available in OpenGL ES or WebGL builds.
+-   @ref Format::Bc5 --- @ref CompressedPixelFormat::RGRgtc2, uses the first
+    two input channels. Not available in OpenGL ES or WebGL builds.
+-   @ref Format::Bc7 --- @ref CompressedPixelFormat::RGBABptcUnorm. Not
+    available in OpenGL ES or WebGL builds.
+-   @ref Format::Etc2 --- @ref CompressedPixelFormat::RGB8Etc2, alpha
+    channel of the input is ignored. Not available in OpenGL ES 2.0 and
+    WebGL 1.0 builds.
+
+The default @ref Format::Automatic picks @ref Format::Bc1 for RGB,
+@ref Format::Bc3 for RGBA, @ref Format::Bc5 for RG and @ref Format::Bc4 for
+red images. On OpenGL ES 3.0 and WebGL 2.0 it picks @ref Format::Etc2 for all
+inputs, on OpenGL ES 2.0 and WebGL 1.0 @ref Format::Bc1 for RGB and luminance
+and @ref Format::Bc3 otherwise. The image is
+split into 4x4 blocks, with edge pixels replicated for sizes that are not a
+multiple of four, and rows of blocks are encoded in parallel on
+@ref setThreadCount() threads. Speed and quality of the encoding is controlled
+with @ref setQuality().
+
+@ref exportToCompressedImage() returns the encoded image, ready to be passed
+to @ref Texture::setCompressedImage(). @ref exportToData() and
+@ref exportToFile() wrap it in a Khronos KTX (`*.ktx`) container, which makes
+the plugin usable with @ref magnum-imageconverter "magnum-imageconverter":
+
+    magnum-imageconverter --converter BlockCompressionImageConverter image.png image.ktx
+
+This plugin is built if `WITH_BLOCKCOMPRESSIONIMAGECONVERTER` is enabled when
+building Magnum. To use dynamic plugin, you need to load
+`BlockCompressionImageConverter` plugin from
+`MAGNUM_PLUGINS_IMAGECONVERTER_DIR`. To use static plugin or use this as a
+dependency of another plugin, you need to request
+`BlockCompressionImageConverter` component of `Magnum` package in CMake and
+link to `Magnum::BlockCompressionImageConverter` target. See @ref building,
+@ref cmake and @ref plugins for more information.
+*/
+class MAGNUM_BLOCKCOMPRESSIONIMAGECONVERTER_EXPORT BlockCompressionImageConverter: public AbstractImageConverter {
+    public:
+        /**
+         * @brief Output format
+         *
+         * @see @ref setFormat()
+         */
+        enum class Format: UnsignedByte {
+            /** Pick the format based on input pixel format */
+            Automatic,
+
+            /** BC1 (DXT1) with 4 bits per pixel, RGB */
+            Bc1,
+
+            /** BC3 (DXT5) with 8 bits per pixel, RGBA */
+            Bc3,
+
+            #ifndef MAGNUM_TARGET_GLES
+            /**
+             * BC4 (RGTC1) with 4 bits per pixel, red
+             * @requires_gl Not available in OpenGL ES or WebGL.
+             */
+            Bc4,
+
+            /**
+             * BC5 (RGTC2) with 8 bits per pixel, red and green
+             * @requires_gl Not available in OpenGL ES or WebGL.
+             */
+            Bc5,
+
+            /**
+             * BC7 (BPTC) with 8 bits per pixel, RGBA
+             * @requires_gl Not available in OpenGL ES or WebGL.
+             */
+            Bc7,
+            #endif
+
+            #ifndef MAGNUM_TARGET_GLES2
+            /**
+             * ETC2 with 4 bits per pixel, RGB
+             * @requires_gles30 Not available in OpenGL ES 2.0.
+             * @requires_webgl20 Not available in WebGL 1.0.
+             */
+            Etc2
+            #endif
+        };
+
+        /**
+         * @brief Encoding quality
+         *
+         * @see @ref setQuality()
+         */
+        enum class Quality: UnsignedByte {
+            /**
+             * Endpoints from the bounding box of block colors. Suitable for
+             * runtime compression.
+             */
+            Fast,
+
+            /** Endpoints along the principal axis of block colors */
+            Normal,
+
+            /**
+             * Principal axis endpoints refined with least squares fitting,
+             * exhaustive search of ETC2 modes. Suitable for offline
+             * conversion.
+             */
+            High
+        };
+
+        /** @brief Default constructor */
+        explicit BlockCompressionImageConverter();
+
+        /** @brief Plugin manager constructor */
+        explicit BlockCompressionImageConverter(PluginManager::AbstractManager& manager, const std::string& plugin);
+
+        /** @brief Output format */
+        Format format() const { return _format; }
+
+        /**
+         * @brief Set output format
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @ref Format::Automatic.
+         */
+        BlockCompressionImageConverter& setFormat(Format format) {
+            _format = format;
+            return *this;
+        }
+
+        /** @brief Encoding quality */
+        Quality quality() const { return _quality; }
+
+        /**
+         * @brief Set encoding quality
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @ref Quality::Normal.
+         */
+        BlockCompressionImageConverter& setQuality(Quality quality) {
+            _quality = quality;
+            return *this;
+        }
+
+        /** @brief Thread count */
+        UnsignedInt threadCount() const { return _threadCount; }
+
+        /**
+         * @brief Set thread count
+         * @return Reference to self (for method chaining)
+         *
+         * If `0`, the count is @cpp std::thread::hardware_concurrency() @ce.
+         * Default is `0`. Ignored on Emscripten, where the encoding is always
+         * single-threaded.
+         */
+        BlockCompressionImageConverter& setThreadCount(UnsignedInt count) {
+            _threadCount = count;
+            return *this;
+        }
+
+    private:
+        Features MAGNUM_BLOCKCOMPRESSIONIMAGECONVERTER_LOCAL doFeatures() const override;
+        std::optional<CompressedImage2D> MAGNUM_BLOCKCOMPRESSIONIMAGECONVERTER_LOCAL doExportToCompressedImage(const ImageView2D& image) override;
+        Containers::Array<char> MAGNUM_BLOCKCOMPRESSIONIMAGECONVERTER_LOCAL doExportToData(const ImageView2D& image) override;
+
+        Format _format{Format::Automatic};
+        Quality _quality{Quality::Normal};
+        UnsignedInt _threadCount{};
+};
+
+}}
+
+#endif
@@ -0,0 +1,454 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstdint>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector4.h"
+#include "MagnumPlugins/BlockCompressionImageConverter/BlockCompressionImageConverter.h"
+
+namespace Magnum { namespace Trade { namespace Test {
+
+struct BlockCompressionImageConverterTest: TestSuite::Tester {
+    explicit BlockCompressionImageConverterTest();
+
+    void wrongFormat();
+    void wrongType();
+
+    void automaticFormat();
+    void nonMultipleOfFour();
+    void constant();
+    void gradient();
+    void threads();
+
+    void exportToData();
+};
+
+typedef BlockCompressionImageConverter::Format Format;
+typedef BlockCompressionImageConverter::Quality Quality;
+
+namespace {
+
+constexpr const char* QualityNames[]{"Fast", "Normal", "High"};
+
+struct {
+    const char* name;
+    Format format;
+    std::size_t blockDataSize;
+    /* Max allowed RMS error of the gradient image */
+    Float maxError;
+} FormatData[]{
+    {"BC1", Format::Bc1, 8, 7.5f},
+    {"BC3", Format::Bc3, 16, 6.5f},
+    #ifndef MAGNUM_TARGET_GLES
+    {"BC4", Format::Bc4, 8, 2.0f},
+    {"BC5", Format::Bc5, 16, 2.0f},
+    {"BC7", Format::Bc7, 16, 7.0f},
+    #endif
+    #ifndef MAGNUM_TARGET_GLES2
+    {"ETC2", Format::Etc2, 8, 12.5f}
+    #endif
+};
+
+constexpr std::size_t FormatCount = sizeof(FormatData)/sizeof(FormatData[0]);
+
+/* Reference decoders, the output is in row-major order, 0-255 range */
+typedef Vector4 Block[16];
+
+std::uint64_t readLittleEndian(const char* data, const std::size_t size) {
+    std::uint64_t value = 0;
+    for(std::size_t i = 0; i != size; ++i)
+        value |= std::uint64_t(UnsignedByte(data[i])) << (8*i);
+    return value;
+}
+
+Vector4 unpackRgb565(const UnsignedInt color) {
+    const UnsignedInt r = color >> 11, g = (color >> 5) & 0x3f, b = color & 0x1f;
+    return {Float((r << 3)|(r >> 2)), Float((g << 2)|(g >> 4)), Float((b << 3)|(b >> 2)), 255.0f};
+}
+
+void decodeBc1(const char* const data, Block& out, const bool alwaysFourColors) {
+    const UnsignedInt color0 = readLittleEndian(data, 2), color1 = readLittleEndian(data + 2, 2);
+    const Vector4 c0 = unpackRgb565(color0), c1 = unpackRgb565(color1);
+    Vector4 palette[4]{c0, c1};
+    if(color0 > color1 || alwaysFourColors) {
+        palette[2] = (c0*2.0f + c1)/3.0f;
+        palette[3] = (c0 + c1*2.0f)/3.0f;
+    } else {
+        palette[2] = (c0 + c1)/2.0f;
+        palette[3] = {};
+    }
+    const UnsignedInt bits = readLittleEndian(data + 4, 4);
+    for(std::size_t i = 0; i != 16; ++i)
+        out[i].xyz() = palette[(bits >> (2*i)) & 3].xyz();
+}
+
+void decodeBc4(const char* const data, Block& out, const std::size_t channel) {
+    const Float r0 = UnsignedByte(data[0]), r1 = UnsignedByte(data[1]);
+    Float palette[8]{r0, r1};
+    if(r0 > r1) {
+        for(std::size_t i = 1; i != 7; ++i) palette[i + 1] = ((7 - i)*r0 + i*r1)/7.0f;
+    } else {
+        for(std::size_t i = 1; i != 5; ++i) palette[i + 1] = ((5 - i)*r0 + i*r1)/5.0f;
+        palette[6] = 0.0f;
+        palette[7] = 255.0f;
+    }
+    const std::uint64_t bits = readLittleEndian(data + 2, 6);
+    for(std::size_t i = 0; i != 16; ++i)
+        out[i][channel] = palette[(bits >> (3*i)) & 7];
+}
+
+#ifndef MAGNUM_TARGET_GLES
+UnsignedInt readBits(const char* const data, std::size_t& position, const std::size_t count) {
+    UnsignedInt value = 0;
+    for(std::size_t i = 0; i != count; ++i, ++position)
+        value |= UnsignedInt((UnsignedByte(data[position >> 3]) >> (position & 7)) & 1) << i;
+    return value;
+}
+
+bool decodeBc7Mode6(const char* const data, Block& out) {
+    std::size_t position = 0;
+    if(readBits(data, position, 7) != 1 << 6) return false;
+
+    UnsignedInt endpoints[2][4];
+    for(std::size_t i = 0; i != 4; ++i) {
+        endpoints[0][i] = readBits(data, position, 7) << 1;
+        endpoints[1][i] = readBits(data, position, 7) << 1;
+    }
+    const UnsignedInt p0 = readBits(data, position, 1), p1 = readBits(data, position, 1);
+    for(std::size_t i = 0; i != 4; ++i) {
+        endpoints[0][i] |= p0;
+        endpoints[1][i] |= p1;
+    }
+
+    constexpr UnsignedInt Weights[]{0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+    for(std::size_t i = 0; i != 16; ++i) {
+        const UnsignedInt w = Weights[readBits(data, position, i ? 4 : 3)];
+        for(std::size_t c = 0; c != 4; ++c)
+            out[i][c] = ((64 - w)*endpoints[0][c] + w*endpoints[1][c] + 32) >> 6;
+    }
+    return position == 128;
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES2
+void decodeEtc1(const char* const data, Block& out) {
+    constexpr Int Modifiers[8][4]{
+        {2, 8, -2, -8}, {5, 17, -5, -17}, {9, 29, -9, -29}, {13, 42, -13, -42},
+        {18, 60, -18, -60}, {24, 80, -24, -80}, {33, 106, -33, -106}, {47, 183, -47, -183}};
+
+    UnsignedInt high = 0, low = 0;
+    for(std::size_t i = 0; i != 4; ++i) {
+        high = (high << 8)|UnsignedByte(data[i]);
+        low = (low << 8)|UnsignedByte(data[4 + i]);
+    }
+
+    const bool flip = high & 1, differential = high & 2;
+    Vector3i base[2];
+    for(std::size_t c = 0; c != 3; ++c) {
+        if(differential) {
+            const Int c0 = (high >> (27 - 8*c)) & 0x1f;
+            Int delta = (high >> (24 - 8*c)) & 0x7;
+            if(delta >= 4) delta -= 8;
+            const Int c1 = c0 + delta;
+            base[0][c] = (c0 << 3)|(c0 >> 2);
+            base[1][c] = (c1 << 3)|(c1 >> 2);
+        } else {
+            const Int c0 = (high >> (28 - 8*c)) & 0xf, c1 = (high >> (24 - 8*c)) & 0xf;
+            base[0][c] = c0*17;
+            base[1][c] = c1*17;
+        }
+    }
+    const UnsignedInt tables[]{(high >> 5) & 7, (high >> 2) & 7};
+
+    for(std::size_t y = 0; y != 4; ++y) for(std::size_t x = 0; x != 4; ++x) {
+        const std::size_t subblock = flip ? y >= 2 : x >= 2;
+        const std::size_t bit = x*4 + y;
+        const UnsignedInt index = (((low >> (16 + bit)) & 1) << 1)|((low >> bit) & 1);
+        out[y*4 + x].xyz() = Vector3{Math::clamp(base[subblock] + Vector3i{Modifiers[tables[subblock]][index]}, 0, 255)};
+    }
+}
+#endif
+
+/* Decodes the whole image into RGBA pixels */
+std::vector<Vector4> decode(const CompressedImage2D& image, const Format format) {
+    const Vector2i blockCount = (image.size() + Vector2i{3})/4;
+    std::vector<Vector4> pixels(image.size().product());
+    std::size_t blockDataSize = 0;
+    for(const auto& data: FormatData) if(data.format == format) blockDataSize = data.blockDataSize;
+
+    for(Int by = 0; by != blockCount.y(); ++by) for(Int bx = 0; bx != blockCount.x(); ++bx) {
+        const char* const data = image.data() + (by*blockCount.x() + bx)*blockDataSize;
+        Block block;
+        for(Vector4& pixel: block) pixel = {0.0f, 0.0f, 0.0f, 255.0f};
+        switch(format) {
+            case Format::Bc1: decodeBc1(data, block, false); break;
+            case Format::Bc3:
+                decodeBc4(data, block, 3);
+                decodeBc1(data + 8, block, true);
+                break;
+            #ifndef MAGNUM_TARGET_GLES
+            case Format::Bc4: decodeBc4(data, block, 0); break;
+            case Format::Bc5:
+                decodeBc4(data, block, 0);
+                decodeBc4(data + 8, block, 1);
+                break;
+            case Format::Bc7: decodeBc7Mode6(data, block); break;
+            #endif
+            #ifndef MAGNUM_TARGET_GLES2
+            case Format::Etc2: decodeEtc1(data, block); break;
+            #endif
+            case Format::Automatic: CORRADE_ASSERT_UNREACHABLE();
+        }
+
+        for(Int y = 0; y != 4; ++y) for(Int x = 0; x != 4; ++x) {
+            const Vector2i position{bx*4 + x, by*4 + y};
+            if(position.x() < image.size().x() && position.y() < image.size().y())
+                pixels[position.y()*image.size().x() + position.x()] = block[y*4 + x];
+        }
+    }
+
+    return pixels;
+}
+
+/* Channels used by each format */
+Vector4 channelMask(const Format format) {
+    switch(format) {
+        case Format::Bc1: return {1.0f, 1.0f, 1.0f, 0.0f};
+        #ifndef MAGNUM_TARGET_GLES
+        case Format::Bc4: return {1.0f, 0.0f, 0.0f, 0.0f};
+        case Format::Bc5: return {1.0f, 1.0f, 0.0f, 0.0f};
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        case Format::Etc2: return {1.0f, 1.0f, 1.0f, 0.0f};
+        #endif
+        default: return Vector4{1.0f};
+    }
+}
+
+/* RMS error per channel over channels used by given format */
+Float rmsError(const std::vector<Vector4>& a, const std::vector<UnsignedByte>& b, const Format format) {
+    const Vector4 mask = channelMask(format);
+    Float error = 0.0f;
+    for(std::size_t i = 0; i != a.size(); ++i) {
+        const Vector4 expected{Float(b[i*4]), Float(b[i*4 + 1]), Float(b[i*4 + 2]), Float(b[i*4 + 3])};
+        error += ((a[i] - expected)*(a[i] - expected)*mask).sum();
+    }
+    return std::sqrt(error/(a.size()*mask.sum()));
+}
+
+/* Smooth gradient with a diagonal edge in the middle */
+std::vector<UnsignedByte> gradient(const Vector2i& size) {
+    std::vector<UnsignedByte> data;
+    for(Int y = 0; y != size.y(); ++y) for(Int x = 0; x != size.x(); ++x) {
+        const bool edge = x > y;
+        data.push_back(UnsignedByte(x*255/(size.x() - 1)));
+        data.push_back(UnsignedByte(y*255/(size.y() - 1)));
+        data.push_back(edge ? 200 : 40);
+        data.push_back(UnsignedByte(255 - (x + y)*255/(size.sum() - 2)));
+    }
+    return data;
+}
+
+}
+
+BlockCompressionImageConverterTest::BlockCompressionImageConverterTest() {
+    addTests({&BlockCompressionImageConverterTest::wrongFormat,
+              &BlockCompressionImageConverterTest::wrongType,
+
+              &BlockCompressionImageConverterTest::automaticFormat,
+              &BlockCompressionImageConverterTest::nonMultipleOfFour});
+
+    addInstancedTests({&BlockCompressionImageConverterTest::constant,
+                       &BlockCompressionImageConverterTest::gradient},
+        FormatCount*3);
+
+    addTests({&BlockCompressionImageConverterTest::threads,
+
+              &BlockCompressionImageConverterTest::exportToData});
+}
+
+void BlockCompressionImageConverterTest::wrongFormat() {
+    ImageView2D image{PixelFormat::DepthComponent, PixelType::UnsignedByte, {}, nullptr};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!BlockCompressionImageConverter{}.exportToCompressedImage(image));
+    CORRADE_COMPARE(out.str(), "Trade::BlockCompressionImageConverter::exportToCompressedImage(): unsupported color format PixelFormat::DepthComponent\n");
+}
+
+void BlockCompressionImageConverterTest::wrongType() {
+    ImageView2D image{PixelFormat::RGBA, PixelType::Float, {}, nullptr};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!BlockCompressionImageConverter{}.exportToCompressedImage(image));
+    CORRADE_COMPARE(out.str(), "Trade::BlockCompressionImageConverter::exportToCompressedImage(): unsupported color type PixelType::Float\n");
+}
+
+void BlockCompressionImageConverterTest::automaticFormat() {
+    const char data[4*4*4]{};
+    BlockCompressionImageConverter converter;
+    CORRADE_VERIFY(converter.format() == Format::Automatic);
+
+    #ifndef MAGNUM_TARGET_GLES
+    std::optional<CompressedImage2D> rgb = converter.exportToCompressedImage(ImageView2D{PixelFormat::RGB, PixelType::UnsignedByte, {4, 4}, data});
+    std::optional<CompressedImage2D> rgba = converter.exportToCompressedImage(ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {4, 4}, data});
+    std::optional<CompressedImage2D> rg = converter.exportToCompressedImage(ImageView2D{PixelFormat::RG, PixelType::UnsignedByte, {4, 4}, data});
+    std::optional<CompressedImage2D> red = converter.exportToCompressedImage(ImageView2D{PixelFormat::Red, PixelType::UnsignedByte, {4, 4}, data});
+    CORRADE_VERIFY(rgb && rgba && rg && red);
+    CORRADE_COMPARE(rgb->format(), CompressedPixelFormat::RGBS3tcDxt1);
+    CORRADE_COMPARE(rgba->format(), CompressedPixelFormat::RGBAS3tcDxt5);
+    CORRADE_COMPARE(rg->format(), CompressedPixelFormat::RGRgtc2);
+    CORRADE_COMPARE(red->format(), CompressedPixelFormat::RedRgtc1);
+    CORRADE_COMPARE(rgb->data().size(), 8);
+    CORRADE_COMPARE(rgba->data().size(), 16);
+    #elif !defined(MAGNUM_TARGET_GLES2)
+    std::optional<CompressedImage2D> rgba = converter.exportToCompressedImage(ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {4, 4}, data});
+    CORRADE_VERIFY(rgba);
+    CORRADE_COMPARE(rgba->format(), CompressedPixelFormat::RGB8Etc2);
+    #else
+    std::optional<CompressedImage2D> rgba = converter.exportToCompressedImage(ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {4, 4}, data});
+    CORRADE_VERIFY(rgba);
+    CORRADE_COMPARE(rgba->format(), CompressedPixelFormat::RGBAS3tcDxt5);
+    #endif
+}
+
+void BlockCompressionImageConverterTest::nonMultipleOfFour() {
+    /* Padded rows, 5x3 RGB, the last column is white */
+    char data[16*3]{};
+    for(std::size_t y = 0; y != 3; ++y)
+        for(std::size_t c = 0; c != 3; ++c) data[y*16 + 4*3 + c] = '\xff';
+
+    std::optional<CompressedImage2D> image = BlockCompressionImageConverter{}
+        .setFormat(Format::Bc1)
+        .exportToCompressedImage(ImageView2D{PixelFormat::RGB, PixelType::UnsignedByte, {5, 3}, data});
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->size(), (Vector2i{5, 3}));
+    CORRADE_COMPARE(image->data().size(), 2*8);
+
+    /* The second block is just the replicated white column */
+    const std::vector<Vector4> decoded = decode(*image, Format::Bc1);
+    for(std::size_t y = 0; y != 3; ++y) {
+        CORRADE_COMPARE(decoded[y*5 + 3].xyz(), Vector3{});
+        CORRADE_COMPARE(decoded[y*5 + 4].xyz(), Vector3{255.0f});
+    }
+}
+
+void BlockCompressionImageConverterTest::constant() {
+    const auto& data = FormatData[testCaseInstanceId()/3];
+    const Quality quality = Quality(testCaseInstanceId()%3);
+    setTestCaseDescription(std::string{data.name} + ", " + QualityNames[testCaseInstanceId()%3]);
+
+    std::vector<UnsignedByte> pixels;
+    for(std::size_t i = 0; i != 8*8; ++i) pixels.insert(pixels.end(), {93, 180, 27, 201});
+
+    std::optional<CompressedImage2D> image = BlockCompressionImageConverter{}
+        .setFormat(data.format)
+        .setQuality(quality)
+        .exportToCompressedImage(ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {8, 8}, Containers::ArrayView<const UnsignedByte>{pixels.data(), pixels.size()}});
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->data().size(), 4*data.blockDataSize);
+
+    /* All blocks are the same */
+    for(std::size_t i = 1; i != 4; ++i)
+        CORRADE_VERIFY(std::equal(image->data().begin(), image->data().begin() + data.blockDataSize, image->data().begin() + i*data.blockDataSize));
+
+    /* Error is bounded by endpoint precision */
+    CORRADE_VERIFY(rmsError(decode(*image, data.format), pixels, data.format) < 4.5f);
+}
+
+void BlockCompressionImageConverterTest::gradient() {
+    const auto& data = FormatData[testCaseInstanceId()/3];
+    const Quality quality = Quality(testCaseInstanceId()%3);
+    setTestCaseDescription(std::string{data.name} + ", " + QualityNames[testCaseInstanceId()%3]);
+
+    const Vector2i size{32, 24};
+    const std::vector<UnsignedByte> pixels = Test::gradient(size);
+
+    BlockCompressionImageConverter converter;
+    converter.setFormat(data.format);
+    std::optional<CompressedImage2D> image = converter
+        .setQuality(quality)
+        .exportToCompressedImage(ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, size, Containers::ArrayView<const UnsignedByte>{pixels.data(), pixels.size()}});
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->size(), size);
+    CORRADE_COMPARE(image->data().size(), 8*6*data.blockDataSize);
+
+    const Float error = rmsError(decode(*image, data.format), pixels, data.format);
+    CORRADE_VERIFY(error < data.maxError);
+
+    /* Higher quality is never worse than Fast */
+    if(quality != Quality::Fast) {
+        std::optional<CompressedImage2D> fast = converter
+            .setQuality(Quality::Fast)
+            .exportToCompressedImage(ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, size, Containers::ArrayView<const UnsignedByte>{pixels.data(), pixels.size()}});
+        CORRADE_VERIFY(fast);
+        CORRADE_VERIFY(error <= rmsError(decode(*fast, data.format), pixels, data.format));
+    }
+}
+
+void BlockCompressionImageConverterTest::threads() {
+    const Vector2i size{64, 64};
+    const std::vector<UnsignedByte> pixels = Test::gradient(size);
+    const ImageView2D view{PixelFormat::RGBA, PixelType::UnsignedByte, size, Containers::ArrayView<const UnsignedByte>{pixels.data(), pixels.size()}};
+
+    BlockCompressionImageConverter converter;
+    converter.setFormat(Format::Bc3);
+    std::optional<CompressedImage2D> single = converter.setThreadCount(1).exportToCompressedImage(view);
+    std::optional<CompressedImage2D> multiple = converter.setThreadCount(5).exportToCompressedImage(view);
+    CORRADE_VERIFY(single && multiple);
+    CORRADE_COMPARE(single->data().size(), multiple->data().size());
+    CORRADE_VERIFY(std::equal(single->data().begin(), single->data().end(), multiple->data().begin()));
+}
+
+void BlockCompressionImageConverterTest::exportToData() {
+    const std::vector<UnsignedByte> pixels = Test::gradient({8, 4});
+
+    Containers::Array<char> data = BlockCompressionImageConverter{}
+        .setFormat(Format::Bc1)
+        .exportToData(ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, {8, 4}, Containers::ArrayView<const UnsignedByte>{pixels.data(), pixels.size()}});
+    CORRADE_COMPARE(data.size(), 12 + 14*4 + 2*8);
+    CORRADE_COMPARE(std::string(data, 12), (std::string{"\xabKTX 11\xbb\r\n\x1a\n", 12}));
+
+    auto field = [&data](std::size_t i) { return UnsignedInt(readLittleEndian(data + 12 + i*4, 4)); };
+    CORRADE_COMPARE(field(0), 0x04030201);
+    CORRADE_COMPARE(field(4), UnsignedInt(CompressedPixelFormat::RGBS3tcDxt1));
+    CORRADE_COMPARE(field(5), UnsignedInt(PixelFormat::RGB));
+    CORRADE_COMPARE(field(6), 8);
+    CORRADE_COMPARE(field(7), 4);
+    CORRADE_COMPARE(field(11), 1);
+    CORRADE_COMPARE(field(13), 16);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::BlockCompressionImageConverterTest)
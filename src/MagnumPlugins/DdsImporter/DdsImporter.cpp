@@ -0,0 +1,372 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DdsImporter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/TextureTools/Implementation/pixelConversion.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/Implementation/mapFile.h"
+
+namespace Magnum { namespace Trade {
+
+namespace {
+
+constexpr const char DdsMagic[]{'D', 'D', 'S', ' '};
+
+constexpr UnsignedInt fourCC(const char a, const char b, const char c, const char d) {
+    return UnsignedInt(a)|UnsignedInt(b) << 8|UnsignedInt(c) << 16|UnsignedInt(d) << 24;
+}
+
+/* DDS_HEADER and DDS_PIXELFORMAT, little-endian */
+struct DdsHeader {
+    UnsignedInt size;
+    UnsignedInt flags;
+    UnsignedInt height;
+    UnsignedInt width;
+    UnsignedInt pitchOrLinearSize;
+    UnsignedInt depth;
+    UnsignedInt mipMapCount;
+    UnsignedInt reserved1[11];
+    struct {
+        UnsignedInt size;
+        UnsignedInt flags;
+        UnsignedInt fourCC;
+        UnsignedInt rgbBitCount;
+        UnsignedInt rBitMask;
+        UnsignedInt gBitMask;
+        UnsignedInt bBitMask;
+        UnsignedInt aBitMask;
+    } pixelFormat;
+    UnsignedInt caps;
+    UnsignedInt caps2;
+    UnsignedInt caps3;
+    UnsignedInt caps4;
+    UnsignedInt reserved2;
+};
+
+/* DDS_HEADER_DXT10, present if the FourCC is DX10 */
+struct DdsHeaderDx10 {
+    UnsignedInt dxgiFormat;
+    UnsignedInt resourceDimension;
+    UnsignedInt miscFlag;
+    UnsignedInt arraySize;
+    UnsignedInt miscFlags2;
+};
+
+static_assert(sizeof(DdsHeader) == 124, "Improper size of DDS header struct");
+static_assert(sizeof(DdsHeaderDx10) == 20, "Improper size of DDS DX10 header struct");
+
+enum: UnsignedInt {
+    DdsFlagMipMapCount = 0x20000,
+
+    DdsPixelFormatAlphaPixels = 0x1,
+    DdsPixelFormatFourCC = 0x4,
+    DdsPixelFormatRgb = 0x40,
+
+    DdsCaps2CubeMap = 0x200,
+    DdsCaps2Volume = 0x200000,
+
+    DxgiResourceDimensionTexture2D = 3,
+    DxgiMiscTextureCube = 0x4
+};
+
+/* Returns block size in bytes or 0 if the DXGI format is not known */
+std::size_t compressedFormatForDxgi(const UnsignedInt dxgiFormat, CompressedPixelFormat& format) {
+    switch(dxgiFormat) {
+        case 71: /* DXGI_FORMAT_BC1_UNORM */
+            format = CompressedPixelFormat::RGBAS3tcDxt1;
+            return 8;
+        case 74: /* DXGI_FORMAT_BC2_UNORM */
+            format = CompressedPixelFormat::RGBAS3tcDxt3;
+            return 16;
+        case 77: /* DXGI_FORMAT_BC3_UNORM */
+            format = CompressedPixelFormat::RGBAS3tcDxt5;
+            return 16;
+        #ifndef MAGNUM_TARGET_GLES
+        case 80: /* DXGI_FORMAT_BC4_UNORM */
+            format = CompressedPixelFormat::RedRgtc1;
+            return 8;
+        case 81: /* DXGI_FORMAT_BC4_SNORM */
+            format = CompressedPixelFormat::SignedRedRgtc1;
+            return 8;
+        case 83: /* DXGI_FORMAT_BC5_UNORM */
+            format = CompressedPixelFormat::RGRgtc2;
+            return 16;
+        case 84: /* DXGI_FORMAT_BC5_SNORM */
+            format = CompressedPixelFormat::SignedRGRgtc2;
+            return 16;
+        case 95: /* DXGI_FORMAT_BC6H_UF16 */
+            format = CompressedPixelFormat::RGBBptcUnsignedFloat;
+            return 16;
+        case 96: /* DXGI_FORMAT_BC6H_SF16 */
+            format = CompressedPixelFormat::RGBBptcSignedFloat;
+            return 16;
+        case 98: /* DXGI_FORMAT_BC7_UNORM */
+            format = CompressedPixelFormat::RGBABptcUnorm;
+            return 16;
+        case 99: /* DXGI_FORMAT_BC7_UNORM_SRGB */
+            format = CompressedPixelFormat::SRGBAlphaBptcUnorm;
+            return 16;
+        #endif
+    }
+
+    return 0;
+}
+
+}
+
+struct DdsImporter::File {
+    struct Level {
+        Vector2i size;
+        std::size_t offset, dataSize;
+    };
+
+    Containers::Array<char> data;
+    bool borrowed, compressed, swizzle;
+    PixelFormat format;
+    CompressedPixelFormat compressedFormat;
+    std::size_t pixelSize;
+    std::vector<Level> levels;
+};
+
+DdsImporter::DdsImporter() = default;
+
+DdsImporter::DdsImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
+
+DdsImporter::~DdsImporter() = default;
+
+auto DdsImporter::doFeatures() const -> Features { return Feature::OpenData|Feature::OpenMemory; }
+
+bool DdsImporter::doIsOpened() const { return !!_f; }
+
+void DdsImporter::doClose() { _f = nullptr; }
+
+void DdsImporter::doOpenData(const Containers::ArrayView<const char> data) {
+    Containers::Array<char> copy{data.size()};
+    std::copy(data.begin(), data.end(), copy.begin());
+    openInternal(std::move(copy), false);
+}
+
+void DdsImporter::doOpenMemory(const Containers::ArrayView<const char> memory) {
+    openInternal(nonOwningArray(memory), true);
+}
+
+void DdsImporter::doOpenFile(const std::string& filename) {
+    /* Map the file, if possible. The mapping can't be referenced from the
+       returned images, so it's treated the same as owned data. */
+    std::optional<Containers::Array<char>> data = Implementation::mapFile(filename);
+    if(!data) {
+        Error() << "Trade::DdsImporter::openFile(): cannot open file" << filename;
+        return;
+    }
+
+    openInternal(std::move(*data), false);
+}
+
+void DdsImporter::openInternal(Containers::Array<char>&& data, const bool borrowed) {
+    if(data.size() < sizeof(DdsMagic) + sizeof(DdsHeader)) {
+        Error() << "Trade::DdsImporter::openData(): the file is too short:" << data.size() << "bytes";
+        return;
+    }
+
+    DdsHeader header;
+    std::memcpy(&header, data + sizeof(DdsMagic), sizeof(DdsHeader));
+    if(!std::equal(DdsMagic, DdsMagic + sizeof(DdsMagic), data.begin()) || header.size != sizeof(DdsHeader)) {
+        Error() << "Trade::DdsImporter::openData(): invalid file header";
+        return;
+    }
+
+    if(header.caps2 & (DdsCaps2CubeMap|DdsCaps2Volume)) {
+        Error() << "Trade::DdsImporter::openData(): cube map and volume textures are not supported";
+        return;
+    }
+
+    std::unique_ptr<File> f{new File};
+    f->borrowed = borrowed;
+    f->compressed = false;
+    f->swizzle = false;
+
+    std::size_t offset = sizeof(DdsMagic) + sizeof(DdsHeader);
+    std::size_t blockSize = 0;
+
+    /* Block-compressed formats. Only files with the DX10 header can
+       distinguish the signed variants and BC6H/BC7. */
+    if(header.pixelFormat.flags & DdsPixelFormatFourCC) {
+        switch(header.pixelFormat.fourCC) {
+            case fourCC('D', 'X', 'T', '1'):
+                f->compressedFormat = header.pixelFormat.flags & DdsPixelFormatAlphaPixels ?
+                    CompressedPixelFormat::RGBAS3tcDxt1 : CompressedPixelFormat::RGBS3tcDxt1;
+                blockSize = 8;
+                break;
+            case fourCC('D', 'X', 'T', '3'):
+                f->compressedFormat = CompressedPixelFormat::RGBAS3tcDxt3;
+                blockSize = 16;
+                break;
+            case fourCC('D', 'X', 'T', '5'):
+                f->compressedFormat = CompressedPixelFormat::RGBAS3tcDxt5;
+                blockSize = 16;
+                break;
+            #ifndef MAGNUM_TARGET_GLES
+            case fourCC('A', 'T', 'I', '1'):
+            case fourCC('B', 'C', '4', 'U'):
+                f->compressedFormat = CompressedPixelFormat::RedRgtc1;
+                blockSize = 8;
+                break;
+            case fourCC('A', 'T', 'I', '2'):
+            case fourCC('B', 'C', '5', 'U'):
+                f->compressedFormat = CompressedPixelFormat::RGRgtc2;
+                blockSize = 16;
+                break;
+            #endif
+            case fourCC('D', 'X', '1', '0'): {
+                if(data.size() < offset + sizeof(DdsHeaderDx10)) {
+                    Error() << "Trade::DdsImporter::openData(): the file is too short to contain the DX10 header";
+                    return;
+                }
+
+                DdsHeaderDx10 headerDx10;
+                std::memcpy(&headerDx10, data + offset, sizeof(DdsHeaderDx10));
+                offset += sizeof(DdsHeaderDx10);
+
+                if(headerDx10.resourceDimension != DxgiResourceDimensionTexture2D || headerDx10.arraySize > 1 || (headerDx10.miscFlag & DxgiMiscTextureCube)) {
+                    Error() << "Trade::DdsImporter::openData(): only non-array 2D textures are supported";
+                    return;
+                }
+
+                /* DXGI_FORMAT_R8G8B8A8_UNORM and DXGI_FORMAT_B8G8R8A8_UNORM */
+                if(headerDx10.dxgiFormat == 28 || headerDx10.dxgiFormat == 87) {
+                    f->format = PixelFormat::RGBA;
+                    f->pixelSize = 4;
+                    f->swizzle = headerDx10.dxgiFormat == 87;
+                    break;
+                }
+
+                if(!(blockSize = compressedFormatForDxgi(headerDx10.dxgiFormat, f->compressedFormat))) {
+                    Error() << "Trade::DdsImporter::openData(): unsupported DXGI format" << headerDx10.dxgiFormat;
+                    return;
+                }
+            } break;
+
+            default:
+                Error() << "Trade::DdsImporter::openData(): unsupported FourCC" << std::string{reinterpret_cast<const char*>(&header.pixelFormat.fourCC), 4};
+                return;
+        }
+
+        f->compressed = blockSize != 0;
+
+    /* Uncompressed 8-bit RGB(A) in either RGB or BGR order */
+    } else if(header.pixelFormat.flags & DdsPixelFormatRgb) {
+        if(header.pixelFormat.rgbBitCount == 24)
+            f->format = PixelFormat::RGB;
+        else if(header.pixelFormat.rgbBitCount == 32)
+            f->format = PixelFormat::RGBA;
+        else {
+            Error() << "Trade::DdsImporter::openData(): unsupported bits-per-pixel:" << header.pixelFormat.rgbBitCount;
+            return;
+        }
+
+        if(header.pixelFormat.rBitMask == 0x00ff0000 && header.pixelFormat.bBitMask == 0x000000ff)
+            f->swizzle = true;
+        else if(header.pixelFormat.rBitMask != 0x000000ff || header.pixelFormat.bBitMask != 0x00ff0000) {
+            Error() << "Trade::DdsImporter::openData(): unsupported channel masks";
+            return;
+        }
+
+        f->pixelSize = header.pixelFormat.rgbBitCount/8;
+
+    } else {
+        Error() << "Trade::DdsImporter::openData(): unsupported pixel format";
+        return;
+    }
+
+    const Vector2i baseSize{Int(header.width), Int(header.height)};
+    const UnsignedInt levelCount = header.flags & DdsFlagMipMapCount ? Math::max(header.mipMapCount, 1u) : 1;
+    for(UnsignedInt i = 0; i != levelCount; ++i) {
+        File::Level level;
+        level.size = Math::max(baseSize >> Int(i), Vector2i{1});
+        level.offset = offset;
+
+        /* Compressed levels consist of whole 4x4 blocks, uncompressed rows
+           are tightly packed */
+        if(f->compressed)
+            level.dataSize = std::size_t((level.size.x() + 3)/4)*((level.size.y() + 3)/4)*blockSize;
+        else
+            level.dataSize = std::size_t(level.size.product())*f->pixelSize;
+
+        offset += level.dataSize;
+        if(offset > data.size()) {
+            Error() << "Trade::DdsImporter::openData(): the file is too short to contain level" << i;
+            return;
+        }
+
+        f->levels.push_back(level);
+    }
+
+    f->data = std::move(data);
+    _f = std::move(f);
+}
+
+UnsignedInt DdsImporter::doImage2DCount() const { return _f->levels.size(); }
+
+std::optional<ImageData2D> DdsImporter::doImage2D(const UnsignedInt id) {
+    const File::Level& level = _f->levels[id];
+    const Containers::ArrayView<const char> in = _f->data.slice(level.offset, level.offset + level.dataSize);
+
+    /* Color data in BGR order need to be swizzled. Data in RGB order and
+       compressed data can reference the memory directly if the user
+       guarantees it stays in scope. */
+    Containers::Array<char> data;
+    if(_f->swizzle) {
+        data = allocateData(in.size());
+        if(_f->format == PixelFormat::RGB)
+            TextureTools::Implementation::bgrSwizzle<3>(in.data(), data, level.size.product());
+        else
+            TextureTools::Implementation::bgrSwizzle<4>(in.data(), data, level.size.product());
+    } else if(_f->borrowed) data = nonOwningArray(in);
+    else {
+        data = allocateData(in.size());
+        std::copy(in.begin(), in.end(), data.begin());
+    }
+
+    if(_f->compressed)
+        return ImageData2D{_f->compressedFormat, level.size, std::move(data)};
+
+    /* Adjust pixel storage if row size is not four byte aligned */
+    PixelStorage storage;
+    if((level.size.x()*_f->pixelSize)%4 != 0)
+        storage.setAlignment(1);
+
+    return ImageData2D{storage, _f->format, PixelType::UnsignedByte, level.size, std::move(data)};
+}
+
+}}
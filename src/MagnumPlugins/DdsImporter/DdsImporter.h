@@ -0,0 +1,118 @@
+#ifndef Magnum_Trade_DdsImporter_h
+#define Magnum_Trade_DdsImporter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::DdsImporter
+ */
+
+#include "Magnum/Trade/AbstractImporter.h"
+
+#include "MagnumPlugins/DdsImporter/configure.h"
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+#ifndef MAGNUM_DDSIMPORTER_BUILD_STATIC
+    #if defined(DdsImporter_EXPORTS) || defined(DdsImporterObjects_EXPORTS)
+        #define MAGNUM_DDSIMPORTER_EXPORT CORRADE_VISIBILITY_EXPORT
+    #else
+        #define MAGNUM_DDSIMPORTER_EXPORT CORRADE_VISIBILITY_IMPORT
+    #endif
+#else
+    #define MAGNUM_DDSIMPORTER_EXPORT CORRADE_VISIBILITY_STATIC
+#endif
+#define MAGNUM_DDSIMPORTER_LOCAL CORRADE_VISIBILITY_LOCAL
+#endif
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief DDS importer plugin
+
+Imports two-dimensional textures in the DirectDraw Surface format, including
+files with the DX10 header extension. Supported are the block-compressed BC1
+(DXT1), BC2 (DXT3) and BC3 (DXT5) formats, which are imported as
+@ref CompressedPixelFormat::RGBAS3tcDxt1 (or @ref CompressedPixelFormat::RGBS3tcDxt1
+if the file doesn't specify alpha), @ref CompressedPixelFormat::RGBAS3tcDxt3
+and @ref CompressedPixelFormat::RGBAS3tcDxt5, and on desktop GL also BC4 and
+BC5 (imported as `RedRgtc1`, `RGRgtc2` formats and their signed variants) and
+BC6H and BC7 (imported as the `Bptc` formats). Uncompressed files with 8 bits
+per channel RGB or RGBA data in either RGB or BGR order are imported with
+@ref PixelType::UnsignedByte and @ref PixelFormat::RGB or
+@ref PixelFormat::RGBA, the default @ref PixelStorage parameters except for
+alignment, which may be changed to `1` if the data require it. Cube map,
+volume and array textures are not supported.
+
+Each mip level is imported as a separate image using @ref image2D(), with ID
+@cpp 0 @ce being the base level. The compressed data are imported without any
+conversion or decoding and can be passed directly to
+@ref Texture::setCompressedSubImage().
+
+On Unix @ref openFile() memory-maps the file instead of reading it and the
+image data are copied out of the mapping on import. Compressed images and
+uncompressed images in RGB order opened using @ref openMemory() are imported
+without any copy, referencing the memory directly, which thus has to stay in
+scope until all of them are destroyed. Images in BGR order always need a BGR
+to RGB conversion and thus are copied.
+
+This plugin is built if `WITH_DDSIMPORTER` is enabled when building Magnum.
+To use dynamic plugin, you need to load `DdsImporter` plugin from
+`MAGNUM_PLUGINS_IMPORTER_DIR`. To use static plugin or use this as a
+dependency of another plugin, you need to request `DdsImporter` component of
+`Magnum` package in CMake and link to `Magnum::DdsImporter` target. See
+@ref building, @ref cmake and @ref plugins for more information.
+*/
+class MAGNUM_DDSIMPORTER_EXPORT DdsImporter: public AbstractImporter {
+    public:
+        /** @brief Default constructor */
+        explicit DdsImporter();
+
+        /** @brief Plugin manager constructor */
+        explicit DdsImporter(PluginManager::AbstractManager& manager, const std::string& plugin);
+
+        ~DdsImporter();
+
+    private:
+        struct File;
+
+        MAGNUM_DDSIMPORTER_LOCAL Features doFeatures() const override;
+
+        MAGNUM_DDSIMPORTER_LOCAL bool doIsOpened() const override;
+        MAGNUM_DDSIMPORTER_LOCAL void doOpenData(Containers::ArrayView<const char> data) override;
+        MAGNUM_DDSIMPORTER_LOCAL void doOpenMemory(Containers::ArrayView<const char> memory) override;
+        MAGNUM_DDSIMPORTER_LOCAL void doOpenFile(const std::string& filename) override;
+        MAGNUM_DDSIMPORTER_LOCAL void doClose() override;
+
+        MAGNUM_DDSIMPORTER_LOCAL UnsignedInt doImage2DCount() const override;
+        MAGNUM_DDSIMPORTER_LOCAL std::optional<ImageData2D> doImage2D(UnsignedInt id) override;
+
+        MAGNUM_DDSIMPORTER_LOCAL void openInternal(Containers::Array<char>&& data, bool borrowed);
+
+        std::unique_ptr<File> _f;
+};
+
+}}
+
+#endif
@@ -0,0 +1,279 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/Trade/ImageData.h"
+#include "MagnumPlugins/DdsImporter/DdsImporter.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test {
+
+struct DdsImporterTest: TestSuite::Tester {
+    explicit DdsImporterTest();
+
+    void openNonexistent();
+    void openShort();
+    void invalidMagic();
+    void cubeMap();
+    void unsupportedFourCC();
+    void levelTooShort();
+
+    void dxt1Mips();
+    void dxt5();
+    void bc7();
+    void rgba();
+    void bgr();
+
+    void openMemory();
+};
+
+DdsImporterTest::DdsImporterTest() {
+    addTests({&DdsImporterTest::openNonexistent,
+              &DdsImporterTest::openShort,
+              &DdsImporterTest::invalidMagic,
+              &DdsImporterTest::cubeMap,
+              &DdsImporterTest::unsupportedFourCC,
+              &DdsImporterTest::levelTooShort,
+
+              &DdsImporterTest::dxt1Mips,
+              &DdsImporterTest::dxt5,
+              &DdsImporterTest::bc7,
+              &DdsImporterTest::rgba,
+              &DdsImporterTest::bgr,
+
+              &DdsImporterTest::openMemory});
+}
+
+namespace {
+    /* Magic and the 124-byte header */
+    constexpr UnsignedInt HeaderSize = 128;
+
+    Containers::Array<char> dxt5File() {
+        return Utility::Directory::read(Utility::Directory::join(DDSIMPORTER_TEST_DIR, "dxt5.dds"));
+    }
+}
+
+void DdsImporterTest::openNonexistent() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    DdsImporter importer;
+    CORRADE_VERIFY(!importer.openFile("nonexistent.dds"));
+    CORRADE_COMPARE(out.str(), "Trade::DdsImporter::openFile(): cannot open file nonexistent.dds\n");
+}
+
+void DdsImporterTest::openShort() {
+    Containers::Array<char> data = dxt5File();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    DdsImporter importer;
+    CORRADE_VERIFY(!importer.openData(data.prefix(127)));
+    CORRADE_COMPARE(out.str(), "Trade::DdsImporter::openData(): the file is too short: 127 bytes\n");
+}
+
+void DdsImporterTest::invalidMagic() {
+    Containers::Array<char> data = dxt5File();
+    data[3] = 'X';
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    DdsImporter importer;
+    CORRADE_VERIFY(!importer.openData(data));
+    CORRADE_COMPARE(out.str(), "Trade::DdsImporter::openData(): invalid file header\n");
+}
+
+void DdsImporterTest::cubeMap() {
+    Containers::Array<char> data = dxt5File();
+    /* DDSCAPS2_CUBEMAP in the caps2 field */
+    data[4 + 108 + 1] = 0x02;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    DdsImporter importer;
+    CORRADE_VERIFY(!importer.openData(data));
+    CORRADE_COMPARE(out.str(), "Trade::DdsImporter::openData(): cube map and volume textures are not supported\n");
+}
+
+void DdsImporterTest::unsupportedFourCC() {
+    Containers::Array<char> data = dxt5File();
+    data[4 + 80 + 3] = '4';
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    DdsImporter importer;
+    CORRADE_VERIFY(!importer.openData(data));
+    CORRADE_COMPARE(out.str(), "Trade::DdsImporter::openData(): unsupported FourCC DXT4\n");
+}
+
+void DdsImporterTest::levelTooShort() {
+    Containers::Array<char> data = Utility::Directory::read(Utility::Directory::join(DDSIMPORTER_TEST_DIR, "dxt1-mips.dds"));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    DdsImporter importer;
+    CORRADE_VERIFY(!importer.openData(data.prefix(data.size() - 1)));
+    CORRADE_COMPARE(out.str(), "Trade::DdsImporter::openData(): the file is too short to contain level 2\n");
+}
+
+void DdsImporterTest::dxt1Mips() {
+    DdsImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(DDSIMPORTER_TEST_DIR, "dxt1-mips.dds")));
+    CORRADE_COMPARE(importer.image2DCount(), 3);
+
+    /* No alpha flag in the pixel format */
+    std::optional<Trade::ImageData2D> image = importer.image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_VERIFY(image->isCompressed());
+    CORRADE_COMPARE(image->compressedFormat(), CompressedPixelFormat::RGBS3tcDxt1);
+    CORRADE_COMPARE(image->size(), Vector2i(8, 4));
+    CORRADE_COMPARE(image->data().size(), 16);
+    CORRADE_COMPARE(image->data()[15], 15);
+
+    image = importer.image2D(1);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->size(), Vector2i(4, 2));
+    CORRADE_COMPARE(image->data().size(), 8);
+    CORRADE_COMPARE(image->data()[0], 16);
+
+    /* Partial blocks are rounded up */
+    image = importer.image2D(2);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->size(), Vector2i(2, 1));
+    const char level2[]{
+        24, 25, 26, 27, 28, 29, 30, 31
+    };
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView(level2),
+        TestSuite::Compare::Container);
+}
+
+void DdsImporterTest::dxt5() {
+    DdsImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(DDSIMPORTER_TEST_DIR, "dxt5.dds")));
+    CORRADE_COMPARE(importer.image2DCount(), 1);
+
+    std::optional<Trade::ImageData2D> image = importer.image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->compressedFormat(), CompressedPixelFormat::RGBAS3tcDxt5);
+    CORRADE_COMPARE(image->size(), Vector2i(4, 4));
+    CORRADE_COMPARE(image->data().size(), 16);
+}
+
+void DdsImporterTest::bc7() {
+    DdsImporter importer;
+
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(DDSIMPORTER_TEST_DIR, "bc7.dds")));
+    CORRADE_COMPARE(importer.image2DCount(), 1);
+
+    /* Data are after the DX10 header */
+    std::optional<Trade::ImageData2D> image = importer.image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->compressedFormat(), CompressedPixelFormat::RGBABptcUnorm);
+    CORRADE_COMPARE(image->size(), Vector2i(4, 4));
+    CORRADE_COMPARE(image->data().size(), 16);
+    CORRADE_COMPARE(image->data()[0], 0);
+    CORRADE_COMPARE(image->data()[15], 15);
+    #else
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    CORRADE_VERIFY(!importer.openFile(Utility::Directory::join(DDSIMPORTER_TEST_DIR, "bc7.dds")));
+    CORRADE_COMPARE(out.str(), "Trade::DdsImporter::openData(): unsupported DXGI format 98\n");
+    #endif
+}
+
+void DdsImporterTest::rgba() {
+    DdsImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(DDSIMPORTER_TEST_DIR, "rgba.dds")));
+
+    std::optional<Trade::ImageData2D> image = importer.image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_VERIFY(!image->isCompressed());
+    CORRADE_COMPARE(image->storage().alignment(), 4);
+    CORRADE_COMPARE(image->format(), PixelFormat::RGBA);
+    CORRADE_COMPARE(image->type(), PixelType::UnsignedByte);
+    CORRADE_COMPARE(image->size(), Vector2i(2, 2));
+    const char pixels[]{
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+    };
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView(pixels),
+        TestSuite::Compare::Container);
+}
+
+void DdsImporterTest::bgr() {
+    DdsImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(DDSIMPORTER_TEST_DIR, "bgr.dds")));
+
+    /* Rows are tightly packed and swizzled to RGB */
+    std::optional<Trade::ImageData2D> image = importer.image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->storage().alignment(), 1);
+    CORRADE_COMPARE(image->format(), PixelFormat::RGB);
+    CORRADE_COMPARE(image->size(), Vector2i(3, 2));
+    const char pixels[]{
+        2, 1, 0, 5, 4, 3, 8, 7, 6,
+        11, 10, 9, 14, 13, 12, 17, 16, 15
+    };
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView(pixels),
+        TestSuite::Compare::Container);
+}
+
+void DdsImporterTest::openMemory() {
+    Containers::Array<char> data = Utility::Directory::read(Utility::Directory::join(DDSIMPORTER_TEST_DIR, "dxt1-mips.dds"));
+
+    DdsImporter importer;
+    CORRADE_VERIFY(importer.openMemory(data));
+
+    /* The data should not be copied */
+    std::optional<Trade::ImageData2D> image = importer.image2D(1);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(static_cast<const void*>(image->data().data()), data + HeaderSize + 16);
+
+    /* BGR data need to be swizzled, so they are copied */
+    Containers::Array<char> bgr = Utility::Directory::read(Utility::Directory::join(DDSIMPORTER_TEST_DIR, "bgr.dds"));
+    CORRADE_VERIFY(importer.openMemory(bgr));
+    image = importer.image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_VERIFY(image->data().data() < bgr.begin() || image->data().data() >= bgr.end());
+    CORRADE_COMPARE(image->data()[0], 2);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::DdsImporterTest)
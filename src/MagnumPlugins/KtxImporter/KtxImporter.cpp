@@ -0,0 +1,277 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "KtxImporter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/PixelFormat.h"
+#include "Magnum/PixelStorage.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/Implementation/mapFile.h"
+
+namespace Magnum { namespace Trade {
+
+namespace {
+
+constexpr const char KtxIdentifier[]{'\xAB', 'K', 'T', 'X', ' ', '1', '1', '\xBB', '\r', '\n', '\x1A', '\n'};
+
+/* All fields following the identifier, in native byte order of the file */
+struct KtxHeader {
+    UnsignedInt endianness;
+    UnsignedInt glType;
+    UnsignedInt glTypeSize;
+    UnsignedInt glFormat;
+    UnsignedInt glInternalFormat;
+    UnsignedInt glBaseInternalFormat;
+    UnsignedInt pixelWidth;
+    UnsignedInt pixelHeight;
+    UnsignedInt pixelDepth;
+    UnsignedInt numberOfArrayElements;
+    UnsignedInt numberOfFaces;
+    UnsignedInt numberOfMipmapLevels;
+    UnsignedInt bytesOfKeyValueData;
+};
+
+static_assert(sizeof(KtxHeader) == 52, "Improper size of KTX header struct");
+
+constexpr UnsignedInt KtxEndianness = 0x04030201;
+
+constexpr std::size_t alignedToFour(const std::size_t size) {
+    return (size + 3) & ~std::size_t(3);
+}
+
+UnsignedInt readUnsignedInt(const char* const data) {
+    UnsignedInt value;
+    std::memcpy(&value, data, sizeof(UnsignedInt));
+    return value;
+}
+
+}
+
+struct KtxImporter::File {
+    struct Level {
+        Vector3i size;
+        /* Offset of the first face, size of a face and distance between
+           two faces. Only non-array cube maps have more than one face per
+           level, all other levels are a single contiguous chunk. */
+        std::size_t offset, faceSize, faceStride;
+        UnsignedInt faceCount;
+    };
+
+    Containers::Array<char> data;
+    bool borrowed, compressed;
+    UnsignedInt dimensions;
+    PixelFormat format;
+    PixelType type;
+    CompressedPixelFormat compressedFormat;
+    std::vector<Level> levels;
+};
+
+KtxImporter::KtxImporter() = default;
+
+KtxImporter::KtxImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
+
+KtxImporter::~KtxImporter() = default;
+
+auto KtxImporter::doFeatures() const -> Features { return Feature::OpenData|Feature::OpenMemory; }
+
+bool KtxImporter::doIsOpened() const { return !!_f; }
+
+void KtxImporter::doClose() { _f = nullptr; }
+
+void KtxImporter::doOpenData(const Containers::ArrayView<const char> data) {
+    Containers::Array<char> copy{data.size()};
+    std::copy(data.begin(), data.end(), copy.begin());
+    openInternal(std::move(copy), false);
+}
+
+void KtxImporter::doOpenMemory(const Containers::ArrayView<const char> memory) {
+    openInternal(nonOwningArray(memory), true);
+}
+
+void KtxImporter::doOpenFile(const std::string& filename) {
+    /* Map the file, if possible. The mapping can't be referenced from the
+       returned images, so it's treated the same as owned data. */
+    std::optional<Containers::Array<char>> data = Implementation::mapFile(filename);
+    if(!data) {
+        Error() << "Trade::KtxImporter::openFile(): cannot open file" << filename;
+        return;
+    }
+
+    openInternal(std::move(*data), false);
+}
+
+void KtxImporter::openInternal(Containers::Array<char>&& data, const bool borrowed) {
+    if(data.size() < sizeof(KtxIdentifier) + sizeof(KtxHeader)) {
+        Error() << "Trade::KtxImporter::openData(): the file is too short:" << data.size() << "bytes";
+        return;
+    }
+
+    if(!std::equal(KtxIdentifier, KtxIdentifier + sizeof(KtxIdentifier), data.begin())) {
+        Error() << "Trade::KtxImporter::openData(): invalid file identifier";
+        return;
+    }
+
+    KtxHeader header;
+    std::memcpy(&header, data + sizeof(KtxIdentifier), sizeof(KtxHeader));
+    if(header.endianness != KtxEndianness) {
+        Error() << "Trade::KtxImporter::openData(): files with swapped endianness are not supported";
+        return;
+    }
+
+    if(!header.pixelHeight) {
+        Error() << "Trade::KtxImporter::openData(): 1D textures are not supported";
+        return;
+    }
+
+    if(header.numberOfFaces != 1 && header.numberOfFaces != 6) {
+        Error() << "Trade::KtxImporter::openData(): invalid face count:" << header.numberOfFaces;
+        return;
+    }
+
+    if(header.pixelDepth && (header.numberOfArrayElements || header.numberOfFaces != 1)) {
+        Error() << "Trade::KtxImporter::openData(): 3D array or cube map textures are not supported";
+        return;
+    }
+
+    std::unique_ptr<File> f{new File};
+    f->borrowed = borrowed;
+
+    /* glType of zero denotes a compressed format, for which glInternalFormat
+       contains the format. The enum values are the same as in GL, so they
+       can be used directly. */
+    if(header.glType == 0) {
+        f->compressed = true;
+        f->compressedFormat = CompressedPixelFormat(header.glInternalFormat);
+    } else {
+        f->compressed = false;
+        f->format = PixelFormat(header.glFormat);
+        f->type = PixelType(header.glType);
+    }
+
+    /* Cube map faces and array layers are imported as the third dimension */
+    const bool isCubeMap = header.numberOfFaces == 6;
+    const bool isArray = header.numberOfArrayElements != 0;
+    const Int layers = Math::max(header.numberOfArrayElements, 1u)*header.numberOfFaces;
+    f->dimensions = header.pixelDepth || isArray || isCubeMap ? 3 : 2;
+
+    const Vector3i baseSize{Int(header.pixelWidth), Int(header.pixelHeight), header.pixelDepth ? Int(header.pixelDepth) : layers};
+    const UnsignedInt levelCount = Math::max(header.numberOfMipmapLevels, 1u);
+    std::size_t offset = sizeof(KtxIdentifier) + sizeof(KtxHeader) + header.bytesOfKeyValueData;
+    for(UnsignedInt i = 0; i != levelCount; ++i) {
+        if(offset + sizeof(UnsignedInt) > data.size()) {
+            Error() << "Trade::KtxImporter::openData(): the file is too short to contain level" << i;
+            return;
+        }
+
+        File::Level level;
+        level.size = Math::max(baseSize >> Int(i), Vector3i{1});
+        if(!header.pixelDepth) level.size.z() = baseSize.z();
+
+        /* For non-array cube maps the image size is size of a single face,
+           with each face padded to four bytes. Otherwise it's the size of
+           the whole level. */
+        const std::size_t imageSize = readUnsignedInt(data + offset);
+        level.offset = offset + sizeof(UnsignedInt);
+        level.faceSize = imageSize;
+        if(isCubeMap && !isArray) {
+            level.faceStride = alignedToFour(imageSize);
+            level.faceCount = 6;
+        } else {
+            level.faceStride = imageSize;
+            level.faceCount = 1;
+        }
+
+        offset = level.offset + alignedToFour(level.faceStride*level.faceCount);
+        if(level.offset + level.faceStride*(level.faceCount - 1) + level.faceSize > data.size()) {
+            Error() << "Trade::KtxImporter::openData(): the file is too short to contain level" << i;
+            return;
+        }
+
+        /* Uncompressed data have rows aligned to four bytes, verify that
+           the image size matches to avoid importing truncated images */
+        if(!f->compressed) {
+            const std::size_t faceDepth = level.faceCount == 1 ? level.size.z() : 1;
+            const std::size_t expectedSize = alignedToFour(level.size.x()*PixelStorage::pixelSize(f->format, f->type))*level.size.y()*faceDepth;
+            if(level.faceSize < expectedSize) {
+                Error() << "Trade::KtxImporter::openData(): level" << i << "has" << level.faceSize << "bytes but expected" << expectedSize;
+                return;
+            }
+        }
+
+        f->levels.push_back(level);
+    }
+
+    f->data = std::move(data);
+    _f = std::move(f);
+}
+
+UnsignedInt KtxImporter::doImage2DCount() const {
+    return _f->dimensions == 2 ? _f->levels.size() : 0;
+}
+
+std::optional<ImageData2D> KtxImporter::doImage2D(const UnsignedInt id) {
+    return image<2>(id);
+}
+
+UnsignedInt KtxImporter::doImage3DCount() const {
+    return _f->dimensions == 3 ? _f->levels.size() : 0;
+}
+
+std::optional<ImageData3D> KtxImporter::doImage3D(const UnsignedInt id) {
+    return image<3>(id);
+}
+
+template<UnsignedInt dimensions> ImageData<dimensions> KtxImporter::image(const UnsignedInt id) {
+    const File::Level& level = _f->levels[id];
+
+    /* Contiguous levels can reference the memory directly if the user
+       guarantees it stays in scope, otherwise all faces are copied into a
+       single allocation */
+    Containers::Array<char> data;
+    if(_f->borrowed && level.faceCount == 1)
+        data = nonOwningArray(_f->data.slice(level.offset, level.offset + level.faceSize));
+    else {
+        data = allocateData(level.faceSize*level.faceCount);
+        for(UnsignedInt i = 0; i != level.faceCount; ++i)
+            std::copy_n(_f->data + level.offset + i*level.faceStride, level.faceSize, data + i*level.faceSize);
+    }
+
+    const auto size = VectorTypeFor<dimensions, Int>::pad(level.size);
+    if(_f->compressed)
+        return ImageData<dimensions>{_f->compressedFormat, size, std::move(data)};
+
+    /* KTX rows are four-byte aligned, which matches the default pixel
+       storage */
+    return ImageData<dimensions>{_f->format, _f->type, size, std::move(data)};
+}
+
+}}
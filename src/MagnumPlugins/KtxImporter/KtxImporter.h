@@ -0,0 +1,128 @@
+#ifndef Magnum_Trade_KtxImporter_h
+#define Magnum_Trade_KtxImporter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::KtxImporter
+ */
+
+#include "Magnum/Trade/AbstractImporter.h"
+
+#include "MagnumPlugins/KtxImporter/configure.h"
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+#ifndef MAGNUM_KTXIMPORTER_BUILD_STATIC
+    #if defined(KtxImporter_EXPORTS) || defined(KtxImporterObjects_EXPORTS)
+        #define MAGNUM_KTXIMPORTER_EXPORT CORRADE_VISIBILITY_EXPORT
+    #else
+        #define MAGNUM_KTXIMPORTER_EXPORT CORRADE_VISIBILITY_IMPORT
+    #endif
+#else
+    #define MAGNUM_KTXIMPORTER_EXPORT CORRADE_VISIBILITY_STATIC
+#endif
+#define MAGNUM_KTXIMPORTER_LOCAL CORRADE_VISIBILITY_LOCAL
+#endif
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief KTX importer plugin
+
+Imports textures in the [Khronos Texture](https://www.khronos.org/opengles/sdk/tools/KTX/file_format_spec/)
+format, version 1.1. As the format stores OpenGL enum values directly, the
+data are imported without any conversion or decoding --- compressed images
+have @ref CompressedPixelFormat equal to the `glInternalFormat` field and can
+be passed directly to @ref Texture::setCompressedSubImage(), uncompressed
+images have @ref PixelFormat and @ref PixelType equal to the `glFormat` and
+`glType` fields and the default @ref PixelStorage.
+
+Each mip level is imported as a separate image, with ID @cpp 0 @ce being the
+base level. Two-dimensional textures are imported using @ref image2D(), 3D
+textures, 2D array textures and cube maps using @ref image3D(), with cube map
+faces and array layers in the third dimension, in the order expected by
+@ref CubeMapTexture and @ref CubeMapTextureArray. One-dimensional textures and
+files with a big-endian byte order are not supported. The key/value data are
+ignored.
+
+On Unix @ref openFile() memory-maps the file instead of reading it and the
+image data are copied out of the mapping on import. Data passed to
+@ref openMemory() are not copied at all --- the imported images (except for
+cube map levels, which need to be gathered together) reference the passed
+memory, which thus has to stay in scope until all of them are destroyed.
+Example:
+@code
+std::unique_ptr<Trade::AbstractImporter> importer = manager.instance("KtxImporter");
+importer->openFile("texture.ktx");
+
+Texture2D texture;
+texture.setStorage(importer->image2DCount(), TextureFormat::CompressedRGBAS3tcDxt5, importer->image2D(0)->size());
+for(UnsignedInt i = 0; i != importer->image2DCount(); ++i)
+    texture.setCompressedSubImage(i, {}, *importer->image2D(i));
+@endcode
+
+This plugin is built if `WITH_KTXIMPORTER` is enabled when building Magnum.
+To use dynamic plugin, you need to load `KtxImporter` plugin from
+`MAGNUM_PLUGINS_IMPORTER_DIR`. To use static plugin or use this as a
+dependency of another plugin, you need to request `KtxImporter` component of
+`Magnum` package in CMake and link to `Magnum::KtxImporter` target. See
+@ref building, @ref cmake and @ref plugins for more information.
+*/
+class MAGNUM_KTXIMPORTER_EXPORT KtxImporter: public AbstractImporter {
+    public:
+        /** @brief Default constructor */
+        explicit KtxImporter();
+
+        /** @brief Plugin manager constructor */
+        explicit KtxImporter(PluginManager::AbstractManager& manager, const std::string& plugin);
+
+        ~KtxImporter();
+
+    private:
+        struct File;
+
+        MAGNUM_KTXIMPORTER_LOCAL Features doFeatures() const override;
+
+        MAGNUM_KTXIMPORTER_LOCAL bool doIsOpened() const override;
+        MAGNUM_KTXIMPORTER_LOCAL void doOpenData(Containers::ArrayView<const char> data) override;
+        MAGNUM_KTXIMPORTER_LOCAL void doOpenMemory(Containers::ArrayView<const char> memory) override;
+        MAGNUM_KTXIMPORTER_LOCAL void doOpenFile(const std::string& filename) override;
+        MAGNUM_KTXIMPORTER_LOCAL void doClose() override;
+
+        MAGNUM_KTXIMPORTER_LOCAL UnsignedInt doImage2DCount() const override;
+        MAGNUM_KTXIMPORTER_LOCAL std::optional<ImageData2D> doImage2D(UnsignedInt id) override;
+
+        MAGNUM_KTXIMPORTER_LOCAL UnsignedInt doImage3DCount() const override;
+        MAGNUM_KTXIMPORTER_LOCAL std::optional<ImageData3D> doImage3D(UnsignedInt id) override;
+
+        MAGNUM_KTXIMPORTER_LOCAL void openInternal(Containers::Array<char>&& data, bool borrowed);
+        template<UnsignedInt dimensions> MAGNUM_KTXIMPORTER_LOCAL ImageData<dimensions> image(UnsignedInt id);
+
+        std::unique_ptr<File> _f;
+};
+
+}}
+
+#endif
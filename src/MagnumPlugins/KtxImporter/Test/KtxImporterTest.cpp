@@ -0,0 +1,294 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Trade/ImageData.h"
+#include "MagnumPlugins/KtxImporter/KtxImporter.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test {
+
+struct KtxImporterTest: TestSuite::Tester {
+    explicit KtxImporterTest();
+
+    void openNonexistent();
+    void openShort();
+    void invalidIdentifier();
+    void swappedEndianness();
+    void oneDimensional();
+    void levelTooShort();
+
+    void compressedMips();
+    void uncompressed();
+    void cubeMap();
+    void array();
+
+    void openMemory();
+    void useTwice();
+};
+
+KtxImporterTest::KtxImporterTest() {
+    addTests({&KtxImporterTest::openNonexistent,
+              &KtxImporterTest::openShort,
+              &KtxImporterTest::invalidIdentifier,
+              &KtxImporterTest::swappedEndianness,
+              &KtxImporterTest::oneDimensional,
+              &KtxImporterTest::levelTooShort,
+
+              &KtxImporterTest::compressedMips,
+              &KtxImporterTest::uncompressed,
+              &KtxImporterTest::cubeMap,
+              &KtxImporterTest::array,
+
+              &KtxImporterTest::openMemory,
+              &KtxImporterTest::useTwice});
+}
+
+namespace {
+    /* Identifier, endianness and a 2x2 RGBA8 header without key/value data,
+       followed by a single level */
+    constexpr UnsignedInt HeaderSize = 64;
+
+    Containers::Array<char> rgbaFile() {
+        Containers::Array<char> data = Utility::Directory::read(Utility::Directory::join(KTXIMPORTER_TEST_DIR, "cube.ktx"));
+        /* Reuse the cube map header, patched to a single face */
+        UnsignedInt faces = 1;
+        std::copy_n(reinterpret_cast<const char*>(&faces), 4, data + 12 + 4*10);
+        return data;
+    }
+}
+
+void KtxImporterTest::openNonexistent() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    KtxImporter importer;
+    CORRADE_VERIFY(!importer.openFile("nonexistent.ktx"));
+    CORRADE_COMPARE(out.str(), "Trade::KtxImporter::openFile(): cannot open file nonexistent.ktx\n");
+}
+
+void KtxImporterTest::openShort() {
+    const char data[]{'\xAB', 'K', 'T', 'X', ' ', '1', '1', '\xBB', '\r', '\n', '\x1A', '\n', 0, 0};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    KtxImporter importer;
+    CORRADE_VERIFY(!importer.openData(data));
+    CORRADE_COMPARE(out.str(), "Trade::KtxImporter::openData(): the file is too short: 14 bytes\n");
+}
+
+void KtxImporterTest::invalidIdentifier() {
+    Containers::Array<char> data = rgbaFile();
+    data[6] = '2';
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    KtxImporter importer;
+    CORRADE_VERIFY(!importer.openData(data));
+    CORRADE_COMPARE(out.str(), "Trade::KtxImporter::openData(): invalid file identifier\n");
+}
+
+void KtxImporterTest::swappedEndianness() {
+    Containers::Array<char> data = rgbaFile();
+    std::reverse(data + 12, data + 16);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    KtxImporter importer;
+    CORRADE_VERIFY(!importer.openData(data));
+    CORRADE_COMPARE(out.str(), "Trade::KtxImporter::openData(): files with swapped endianness are not supported\n");
+}
+
+void KtxImporterTest::oneDimensional() {
+    Containers::Array<char> data = rgbaFile();
+    std::fill_n(data + 12 + 4*7, 4, 0);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    KtxImporter importer;
+    CORRADE_VERIFY(!importer.openData(data));
+    CORRADE_COMPARE(out.str(), "Trade::KtxImporter::openData(): 1D textures are not supported\n");
+}
+
+void KtxImporterTest::levelTooShort() {
+    Containers::Array<char> data = Utility::Directory::read(Utility::Directory::join(KTXIMPORTER_TEST_DIR, "dxt1-mips.ktx"));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    KtxImporter importer;
+    CORRADE_VERIFY(!importer.openData(data.prefix(data.size() - 1)));
+    CORRADE_COMPARE(out.str(), "Trade::KtxImporter::openData(): the file is too short to contain level 2\n");
+}
+
+void KtxImporterTest::compressedMips() {
+    KtxImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(KTXIMPORTER_TEST_DIR, "dxt1-mips.ktx")));
+    CORRADE_COMPARE(importer.image2DCount(), 3);
+    CORRADE_COMPARE(importer.image3DCount(), 0);
+
+    /* The key/value data are skipped */
+    std::optional<Trade::ImageData2D> image = importer.image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_VERIFY(image->isCompressed());
+    CORRADE_COMPARE(image->compressedFormat(), CompressedPixelFormat::RGBS3tcDxt1);
+    CORRADE_COMPARE(image->size(), Vector2i(8, 4));
+    const char level0[]{
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+    };
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView(level0),
+        TestSuite::Compare::Container);
+
+    image = importer.image2D(1);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->size(), Vector2i(4, 2));
+    const char level1[]{
+        16, 17, 18, 19, 20, 21, 22, 23
+    };
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView(level1),
+        TestSuite::Compare::Container);
+
+    image = importer.image2D(2);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->size(), Vector2i(2, 1));
+    const char level2[]{
+        24, 25, 26, 27, 28, 29, 30, 31
+    };
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView(level2),
+        TestSuite::Compare::Container);
+}
+
+void KtxImporterTest::uncompressed() {
+    KtxImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(KTXIMPORTER_TEST_DIR, "rgb.ktx")));
+    CORRADE_COMPARE(importer.image2DCount(), 1);
+
+    std::optional<Trade::ImageData2D> image = importer.image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_VERIFY(!image->isCompressed());
+    CORRADE_COMPARE(image->storage().alignment(), 4);
+    CORRADE_COMPARE(image->format(), PixelFormat::RGB);
+    CORRADE_COMPARE(image->type(), PixelType::UnsignedByte);
+    CORRADE_COMPARE(image->size(), Vector2i(3, 2));
+    const char pixels[]{
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 0, 0, 0,
+        9, 10, 11, 12, 13, 14, 15, 16, 17, 0, 0, 0
+    };
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView(pixels),
+        TestSuite::Compare::Container);
+}
+
+void KtxImporterTest::cubeMap() {
+    KtxImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(KTXIMPORTER_TEST_DIR, "cube.ktx")));
+    CORRADE_COMPARE(importer.image2DCount(), 0);
+    CORRADE_COMPARE(importer.image3DCount(), 1);
+
+    /* The faces are gathered from the padded per-face chunks */
+    std::optional<Trade::ImageData3D> image = importer.image3D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->format(), PixelFormat::RGBA);
+    CORRADE_COMPARE(image->size(), Vector3i(1, 1, 6));
+    const char faces[]{
+        0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+        3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5
+    };
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView(faces),
+        TestSuite::Compare::Container);
+}
+
+void KtxImporterTest::array() {
+    KtxImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(KTXIMPORTER_TEST_DIR, "array.ktx")));
+    CORRADE_COMPARE(importer.image3DCount(), 2);
+
+    /* Layer count is not reduced with the mip level */
+    std::optional<Trade::ImageData3D> image = importer.image3D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->size(), Vector3i(2, 2, 3));
+    CORRADE_COMPARE(image->data().size(), 48);
+
+    image = importer.image3D(1);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->size(), Vector3i(1, 1, 3));
+    const char level1[]{
+        100, 101, 102, 103, 104, 105, 106, 107, 108, 109, 110, 111
+    };
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView(level1),
+        TestSuite::Compare::Container);
+}
+
+void KtxImporterTest::openMemory() {
+    Containers::Array<char> data = Utility::Directory::read(Utility::Directory::join(KTXIMPORTER_TEST_DIR, "dxt1-mips.ktx"));
+
+    KtxImporter importer;
+    CORRADE_VERIFY(importer.openMemory(data));
+
+    /* The data should not be copied */
+    std::optional<Trade::ImageData2D> image = importer.image2D(1);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(static_cast<const void*>(image->data().data()), data + HeaderSize + 8 + 4 + 16 + 4);
+
+    /* Cube map faces need to be gathered together, so they are copied */
+    Containers::Array<char> cube = Utility::Directory::read(Utility::Directory::join(KTXIMPORTER_TEST_DIR, "cube.ktx"));
+    CORRADE_VERIFY(importer.openMemory(cube));
+    std::optional<Trade::ImageData3D> cubeImage = importer.image3D(0);
+    CORRADE_VERIFY(cubeImage);
+    CORRADE_VERIFY(cubeImage->data().data() < cube.begin() || cubeImage->data().data() >= cube.end());
+    CORRADE_COMPARE(cubeImage->data()[20], 5);
+}
+
+void KtxImporterTest::useTwice() {
+    KtxImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(KTXIMPORTER_TEST_DIR, "dxt1-mips.ktx")));
+
+    /* Verify that the level data stay intact after the first import */
+    {
+        std::optional<Trade::ImageData2D> image = importer.image2D(0);
+        CORRADE_VERIFY(image);
+        CORRADE_COMPARE(image->size(), Vector2i(8, 4));
+    } {
+        std::optional<Trade::ImageData2D> image = importer.image2D(0);
+        CORRADE_VERIFY(image);
+        CORRADE_COMPARE(image->size(), Vector2i(8, 4));
+    }
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::KtxImporterTest)
@@ -25,33 +25,83 @@
 
 #include "MagnumFont.h"
 
+#include <algorithm>
+#include <cstring>
 #include <sstream>
-#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/Endianness.h>
 #include <Corrade/Utility/Unicode.h>
 
+#include "Magnum/PixelFormat.h"
 #include "Magnum/Text/GlyphCache.h"
 #include "Magnum/Trade/ImageData.h"
+#include "MagnumPlugins/MagnumFont/MagnumFontBinary.h"
 #include "MagnumPlugins/TgaImporter/TgaImporter.h"
 
 namespace Magnum { namespace Text {
 
+/* Both the text and the binary format end up in the same flat tables. The
+   character->glyph mapping is a two-level page table: the first level is
+   indexed by the upper bits of the codepoint and points to a 256-entry page
+   of glyph IDs. Page 0 is shared by all codepoint ranges without any
+   characters and maps everything to glyph 0, so the lookup is just two array
+   loads with a single bounds check. */
 struct MagnumFont::Data {
-    Utility::Configuration conf;
+    enum: UnsignedInt {
+        PageBits = 8,
+        PageSize = 1 << PageBits,
+        /* Codepoints above the Unicode range are ignored */
+        MaxCodepoint = 0x10ffff
+    };
+
+    void setCharacters(const std::vector<Implementation::MagnumFontBinaryCharacter>& characters);
+
+    UnsignedInt glyphId(const char32_t character) const {
+        const UnsignedInt page = UnsignedInt(character) >> PageBits;
+        return page < characterPages.size() ? characterGlyphs[characterPages[page]*PageSize + (UnsignedInt(character) & (PageSize - 1))] : 0;
+    }
+
     Trade::ImageData2D image;
-    std::unordered_map<char32_t, UnsignedInt> glyphId;
-    std::vector<Vector2> glyphAdvance;
+    Vector2i originalImageSize, padding;
+    std::vector<UnsignedInt> characterPages;
+    std::vector<UnsignedInt> characterGlyphs;
+    std::vector<Implementation::MagnumFontBinaryGlyph> glyphs;
 };
 
+void MagnumFont::Data::setCharacters(const std::vector<Implementation::MagnumFontBinaryCharacter>& characters) {
+    UnsignedInt pageCount = 0;
+    for(const Implementation::MagnumFontBinaryCharacter& c: characters)
+        if(c.codepoint <= MaxCodepoint)
+            pageCount = std::max(pageCount, (c.codepoint >> PageBits) + 1);
+
+    /* All pages initially point to the shared empty page */
+    characterPages.assign(pageCount, 0);
+    characterGlyphs.assign(PageSize, 0);
+
+    /* Going backwards so the first occurrence of each codepoint wins */
+    for(auto it = characters.rbegin(); it != characters.rend(); ++it) {
+        if(it->codepoint > MaxCodepoint) continue;
+
+        UnsignedInt& page = characterPages[it->codepoint >> PageBits];
+        if(!page) {
+            page = characterGlyphs.size()/PageSize;
+            characterGlyphs.resize(characterGlyphs.size() + PageSize, 0);
+        }
+
+        characterGlyphs[page*PageSize + (it->codepoint & (PageSize - 1))] = it->glyph;
+    }
+}
+
 namespace {
     class MagnumFontLayouter: public AbstractLayouter {
         public:
-            explicit MagnumFontLayouter(const std::vector<Vector2>& glyphAdvance, const GlyphCache& cache, Float fontSize, Float textSize, std::vector<UnsignedInt>&& glyphs);
+            explicit MagnumFontLayouter(const std::vector<Implementation::MagnumFontBinaryGlyph>& glyphData, const GlyphCache& cache, Float fontSize, Float textSize, std::vector<UnsignedInt>&& glyphs);
 
         private:
             std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(UnsignedInt i) override;
 
-            const std::vector<Vector2>& glyphAdvance;
+            const std::vector<Implementation::MagnumFontBinaryGlyph>& glyphData;
             const GlyphCache& cache;
             const Float fontSize, textSize;
             const std::vector<UnsignedInt> glyphs;
@@ -69,7 +119,11 @@ auto MagnumFont::doFeatures() const -> Features { return Feature::OpenData|Featu
 bool MagnumFont::doIsOpened() const { return _opened; }
 
 auto MagnumFont::doOpenData(const std::vector<std::pair<std::string, Containers::ArrayView<const char>>>& data, const Float) -> Metrics {
-    /* We need just the configuration file and image file */
+    /* The binary format is self-contained */
+    if(data.size() == 1 && isBinary(data[0].second))
+        return openBinary(data[0].second);
+
+    /* Otherwise we need just the configuration file and image file */
     if(data.size() != 2) {
         Error() << "Text::MagnumFont::openData(): wanted two files, got" << data.size();
         return {};
@@ -112,7 +166,14 @@ auto MagnumFont::doOpenData(const std::vector<std::pair<std::string, Containers:
     return openInternal(std::move(conf), std::move(*image));
 }
 
-auto MagnumFont::doOpenFile(const std::string& filename, Float) -> Metrics {
+auto MagnumFont::doOpenFile(const std::string& filename, const Float size) -> Metrics {
+    /* Binary files are detected by their signature */
+    if(Utility::Directory::fileExists(filename)) {
+        const Containers::Array<char> data = Utility::Directory::read(filename);
+        if(isBinary(data))
+            return doOpenData({{Utility::Directory::filename(filename), data}}, size);
+    }
+
     /* Open the configuration file */
     Utility::Configuration conf(filename, Utility::Configuration::Flag::ReadOnly|Utility::Configuration::Flag::SkipComments);
     if(!conf.isValid() || conf.isEmpty()) {
@@ -145,26 +206,90 @@ auto MagnumFont::doOpenFile(const std::string& filename, Float) -> Metrics {
 
 auto MagnumFont::openInternal(Utility::Configuration&& conf, Trade::ImageData2D&& image) -> Metrics {
     /* Everything okay, save the data internally */
-    _opened = new Data{std::move(conf), std::move(image), std::unordered_map<char32_t, UnsignedInt>{}, {}};
+    _opened = new Data{std::move(image), conf.value<Vector2i>("originalImageSize"), conf.value<Vector2i>("padding"), {}, {}, {}};
 
-    /* Glyph advances */
-    const std::vector<Utility::ConfigurationGroup*> glyphs = _opened->conf.groups("glyph");
-    _opened->glyphAdvance.reserve(glyphs.size());
+    /* Glyph properties */
+    const std::vector<Utility::ConfigurationGroup*> glyphs = conf.groups("glyph");
+    _opened->glyphs.reserve(glyphs.size());
     for(const Utility::ConfigurationGroup* const g: glyphs)
-        _opened->glyphAdvance.push_back(g->value<Vector2>("advance"));
-
-    /* Fill character->glyph map */
-    const std::vector<Utility::ConfigurationGroup*> chars = _opened->conf.groups("char");
+        _opened->glyphs.push_back({g->value<Vector2>("advance"),
+                                   g->value<Vector2i>("position"),
+                                   g->value<Range2Di>("rectangle")});
+
+    /* Fill character->glyph table, keep the first occurrence of each
+       codepoint */
+    const std::vector<Utility::ConfigurationGroup*> chars = conf.groups("char");
+    std::vector<Implementation::MagnumFontBinaryCharacter> characters;
+    characters.reserve(chars.size());
     for(const Utility::ConfigurationGroup* const c: chars) {
         const UnsignedInt glyphId = c->value<UnsignedInt>("glyph");
-        CORRADE_INTERNAL_ASSERT(glyphId < _opened->glyphAdvance.size());
-        _opened->glyphId.emplace(c->value<char32_t>("unicode"), glyphId);
+        CORRADE_INTERNAL_ASSERT(glyphId < _opened->glyphs.size());
+        characters.push_back({c->value<char32_t>("unicode"), glyphId});
+    }
+    _opened->setCharacters(characters);
+
+    return {conf.value<Float>("fontSize"),
+            conf.value<Float>("ascent"),
+            conf.value<Float>("descent"),
+            conf.value<Float>("lineHeight")};
+}
+
+bool MagnumFont::isBinary(const Containers::ArrayView<const char> data) {
+    return data.size() >= sizeof(Implementation::MagnumFontBinaryMagic) &&
+        std::memcmp(data, Implementation::MagnumFontBinaryMagic, sizeof(Implementation::MagnumFontBinaryMagic)) == 0;
+}
+
+auto MagnumFont::openBinary(const Containers::ArrayView<const char> data) -> Metrics {
+    if(Utility::Endianness::isBigEndian()) {
+        Error() << "Text::MagnumFont::openData(): binary files are not supported on big-endian platforms";
+        return {};
+    }
+
+    Implementation::MagnumFontBinaryHeader header;
+    if(data.size() < sizeof(header)) {
+        Error() << "Text::MagnumFont::openData(): binary file too short, expected at least" << sizeof(header) << "bytes but got" << data.size();
+        return {};
+    }
+    std::memcpy(&header, data, sizeof(header));
+
+    if(header.version != Implementation::MagnumFontBinaryVersion) {
+        Error() << "Text::MagnumFont::openData(): unsupported binary file version, expected" << UnsignedInt(Implementation::MagnumFontBinaryVersion) << "but got" << header.version;
+        return {};
+    }
+
+    /* The tables directly follow the header, the image is after them */
+    const std::size_t charactersSize = std::size_t(header.characterCount)*sizeof(Implementation::MagnumFontBinaryCharacter);
+    const std::size_t glyphsSize = std::size_t(header.glyphCount)*sizeof(Implementation::MagnumFontBinaryGlyph);
+    const Vector2i imageSize{header.imageSize[0], header.imageSize[1]};
+    if(!header.glyphCount || header.imageDataOffset != sizeof(header) + charactersSize + glyphsSize || (imageSize < Vector2i{}).any() || header.imageDataSize != Implementation::magnumFontBinaryImageDataSize(imageSize) || header.imageDataOffset > data.size() || header.imageDataSize > data.size() - header.imageDataOffset) {
+        Error() << "Text::MagnumFont::openData(): invalid binary file layout";
+        return {};
     }
 
-    return {_opened->conf.value<Float>("fontSize"),
-            _opened->conf.value<Float>("ascent"),
-            _opened->conf.value<Float>("descent"),
-            _opened->conf.value<Float>("lineHeight")};
+    std::vector<Implementation::MagnumFontBinaryCharacter> characters(header.characterCount);
+    std::vector<Implementation::MagnumFontBinaryGlyph> glyphs(header.glyphCount);
+    std::memcpy(characters.data(), data + sizeof(header), charactersSize);
+    std::memcpy(glyphs.data(), data + sizeof(header) + charactersSize, glyphsSize);
+
+    /* The table is expected to be sorted and without duplicates */
+    for(std::size_t i = 0; i != characters.size(); ++i) {
+        if(characters[i].glyph >= glyphs.size() || (i && characters[i - 1].codepoint >= characters[i].codepoint)) {
+            Error() << "Text::MagnumFont::openData(): invalid character table";
+            return {};
+        }
+    }
+
+    Containers::Array<char> imageData{header.imageDataSize};
+    std::memcpy(imageData, data + header.imageDataOffset, header.imageDataSize);
+
+    _opened = new Data{
+        Trade::ImageData2D{PixelFormat::Red, PixelType::UnsignedByte, imageSize, std::move(imageData)},
+        {header.originalImageSize[0], header.originalImageSize[1]},
+        {header.padding[0], header.padding[1]},
+        {}, {}, std::move(glyphs)};
+    _opened->setCharacters(characters);
+
+    return {header.fontSize, header.ascent, header.descent, header.lineHeight};
 }
 
 void MagnumFont::doClose() {
@@ -173,26 +298,24 @@ void MagnumFont::doClose() {
 }
 
 UnsignedInt MagnumFont::doGlyphId(const char32_t character) {
-    auto it = _opened->glyphId.find(character);
-    return it != _opened->glyphId.end() ? it->second : 0;
+    return _opened->glyphId(character);
 }
 
 Vector2 MagnumFont::doGlyphAdvance(const UnsignedInt glyph) {
-    return glyph < _opened->glyphAdvance.size() ? _opened->glyphAdvance[glyph] : Vector2();
+    return glyph < _opened->glyphs.size() ? _opened->glyphs[glyph].advance : Vector2();
 }
 
 std::unique_ptr<GlyphCache> MagnumFont::doCreateGlyphCache() {
     /* Set cache image */
     std::unique_ptr<GlyphCache> cache(new Text::GlyphCache(
-        _opened->conf.value<Vector2i>("originalImageSize"),
+        _opened->originalImageSize,
         _opened->image.size(),
-        _opened->conf.value<Vector2i>("padding")));
+        _opened->padding));
     cache->setImage({}, _opened->image);
 
     /* Fill glyph map */
-    const std::vector<Utility::ConfigurationGroup*> glyphs = _opened->conf.groups("glyph");
-    for(std::size_t i = 0; i != glyphs.size(); ++i)
-        cache->insert(i, glyphs[i]->value<Vector2i>("position"), glyphs[i]->value<Range2Di>("rectangle"));
+    for(std::size_t i = 0; i != _opened->glyphs.size(); ++i)
+        cache->insert(i, _opened->glyphs[i].position, _opened->glyphs[i].rectangle);
 
     return cache;
 }
@@ -204,16 +327,15 @@ std::unique_ptr<AbstractLayouter> MagnumFont::doLayout(const GlyphCache& cache,
     for(std::size_t i = 0; i != text.size(); ) {
         UnsignedInt codepoint;
         std::tie(codepoint, i) = Utility::Unicode::nextChar(text, i);
-        const auto it = _opened->glyphId.find(codepoint);
-        glyphs.push_back(it == _opened->glyphId.end() ? 0 : it->second);
+        glyphs.push_back(_opened->glyphId(codepoint));
     }
 
-    return std::unique_ptr<MagnumFontLayouter>(new MagnumFontLayouter(_opened->glyphAdvance, cache, this->size(), size, std::move(glyphs)));
+    return std::unique_ptr<MagnumFontLayouter>(new MagnumFontLayouter(_opened->glyphs, cache, this->size(), size, std::move(glyphs)));
 }
 
 namespace {
 
-MagnumFontLayouter::MagnumFontLayouter(const std::vector<Vector2>& glyphAdvance, const GlyphCache& cache, const Float fontSize, const Float textSize, std::vector<UnsignedInt>&& glyphs): AbstractLayouter(glyphs.size()), glyphAdvance(glyphAdvance), cache(cache), fontSize(fontSize), textSize(textSize), glyphs(std::move(glyphs)) {}
+MagnumFontLayouter::MagnumFontLayouter(const std::vector<Implementation::MagnumFontBinaryGlyph>& glyphData, const GlyphCache& cache, const Float fontSize, const Float textSize, std::vector<UnsignedInt>&& glyphs): AbstractLayouter(glyphs.size()), glyphData(glyphData), cache(cache), fontSize(fontSize), textSize(textSize), glyphs(std::move(glyphs)) {}
 
 std::tuple<Range2D, Range2D, Vector2> MagnumFontLayouter::doRenderGlyph(const UnsignedInt i) {
     /* Position of the texture in the resulting glyph, texture coordinates */
@@ -229,7 +351,7 @@ std::tuple<Range2D, Range2D, Vector2> MagnumFontLayouter::doRenderGlyph(const Un
     const auto quadRectangle = Range2D(Range2Di::fromSize(position, rectangle.size())).scaled(Vector2(textSize/fontSize));
 
     /* Advance for given glyph, denormalized to requested text size */
-    const Vector2 advance = glyphAdvance[glyphs[i]]*(textSize/fontSize);
+    const Vector2 advance = glyphData[glyphs[i]].advance*(textSize/fontSize);
 
     return std::make_tuple(quadRectangle, textureCoordinates, advance);
 }
@@ -116,6 +116,27 @@ The file syntax is as in following:
 
     # ...
 
+## Binary format
+
+Parsing the text file gets slow for fonts with many glyphs, so the font can be
+also stored in a single binary file, created by @ref MagnumFontConverter when
+the output filename ends with `.magnumfont`. The file is recognized by its
+signature in both @ref openFile() and @ref openData() (where it's then the only
+passed file) and contains flat little-endian tables that are copied into
+place without any per-glyph parsing:
+
+-   64-byte header with `MFNT` signature, format version `2`, font metrics,
+    original image size, padding, image size, character and glyph count and
+    offset and size of the image data
+-   Character table, a pair of 32-bit codepoint and glyph ID for each
+    character, sorted by codepoint
+-   Glyph table, advance, position and rectangle for each glyph, in the same
+    units and order as the `[glyph]` groups above
+-   Raw single-channel glyph cache image with rows aligned to four bytes,
+    thus the binary format doesn't depend on @ref Trade::TgaImporter "TgaImporter"
+
+The binary format can't be opened on big-endian platforms.
+
 @see @ref Trade::TgaImporter
 */
 class MAGNUM_MAGNUMFONT_EXPORT MagnumFont: public AbstractFont {
@@ -143,6 +164,8 @@ class MAGNUM_MAGNUMFONT_EXPORT MagnumFont: public AbstractFont {
         MAGNUM_MAGNUMFONT_LOCAL std::unique_ptr<AbstractLayouter> doLayout(const GlyphCache& cache, Float size, const std::string& text) override;
 
         MAGNUM_MAGNUMFONT_LOCAL Metrics openInternal(Utility::Configuration&& conf, Trade::ImageData2D&& image);
+        MAGNUM_MAGNUMFONT_LOCAL static bool isBinary(Containers::ArrayView<const char> data);
+        MAGNUM_MAGNUMFONT_LOCAL Metrics openBinary(Containers::ArrayView<const char> data);
 
         Data* _opened;
 };
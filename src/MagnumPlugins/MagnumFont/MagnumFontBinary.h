@@ -0,0 +1,91 @@
+#ifndef Magnum_Text_MagnumFontBinary_h
+#define Magnum_Text_MagnumFontBinary_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Layout of the binary MagnumFont file, shared by the MagnumFont and
+ *      MagnumFontConverter plugins
+ */
+
+#include <cstddef>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Range.h"
+
+namespace Magnum { namespace Text { namespace Implementation {
+
+/* The file starts with the header, followed by the character table sorted by
+   codepoint, the glyph table in glyph ID order and the R8 glyph cache image
+   with rows aligned to four bytes. Everything is little-endian and
+   four-byte-aligned so the tables can be used directly from a memory-mapped
+   file. */
+
+enum: UnsignedInt {
+    MagnumFontBinaryVersion = 2,
+    MagnumFontBinaryHeaderSize = 64
+};
+
+constexpr const char MagnumFontBinaryMagic[]{'M', 'F', 'N', 'T'};
+
+struct MagnumFontBinaryHeader {
+    char magic[4];
+    UnsignedInt version;
+    Float fontSize;
+    Float ascent;
+    Float descent;
+    Float lineHeight;
+    Int originalImageSize[2];
+    Int padding[2];
+    Int imageSize[2];
+    UnsignedInt characterCount;
+    UnsignedInt glyphCount;
+    UnsignedInt imageDataOffset;
+    UnsignedInt imageDataSize;
+};
+
+struct MagnumFontBinaryCharacter {
+    UnsignedInt codepoint;
+    UnsignedInt glyph;
+};
+
+struct MagnumFontBinaryGlyph {
+    Vector2 advance;
+    Vector2i position;
+    Range2Di rectangle;
+};
+
+static_assert(sizeof(MagnumFontBinaryHeader) == MagnumFontBinaryHeaderSize, "improper size of the header");
+static_assert(sizeof(MagnumFontBinaryCharacter) == 8, "improper size of the character entry");
+static_assert(sizeof(MagnumFontBinaryGlyph) == 32, "improper size of the glyph entry");
+
+/* Size of the R8 image data with rows aligned to four bytes */
+inline std::size_t magnumFontBinaryImageDataSize(const Vector2i& size) {
+    return std::size_t((size.x() + 3) & ~3)*size.y();
+}
+
+}}}
+
+#endif
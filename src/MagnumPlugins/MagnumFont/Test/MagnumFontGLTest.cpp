@@ -23,6 +23,8 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <sstream>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Utility/Directory.h>
 
 #include "Magnum/OpenGLTester.h"
@@ -39,12 +41,28 @@ struct MagnumFontGLTest: OpenGLTester {
     void properties();
     void layout();
     void createGlyphCache();
+
+    void binaryProperties();
+    void binaryOpenData();
+    void binaryLayout();
+    void binaryCreateGlyphCache();
+    void binaryInvalidVersion();
+    void binaryTooShort();
+    void binaryInvalidCharacterTable();
 };
 
 MagnumFontGLTest::MagnumFontGLTest() {
     addTests({&MagnumFontGLTest::properties,
               &MagnumFontGLTest::layout,
-              &MagnumFontGLTest::createGlyphCache});
+              &MagnumFontGLTest::createGlyphCache,
+
+              &MagnumFontGLTest::binaryProperties,
+              &MagnumFontGLTest::binaryOpenData,
+              &MagnumFontGLTest::binaryLayout,
+              &MagnumFontGLTest::binaryCreateGlyphCache,
+              &MagnumFontGLTest::binaryInvalidVersion,
+              &MagnumFontGLTest::binaryTooShort,
+              &MagnumFontGLTest::binaryInvalidCharacterTable});
 }
 
 void MagnumFontGLTest::properties() {
@@ -114,6 +132,112 @@ void MagnumFontGLTest::createGlyphCache() {
     /** @todo properly test contents */
 }
 
+void MagnumFontGLTest::binaryProperties() {
+    MagnumFont font;
+    CORRADE_VERIFY(font.openFile(Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.magnumfont"), 0.0f));
+    CORRADE_COMPARE(font.size(), 16.0f);
+    CORRADE_COMPARE(font.ascent(), 25.0f);
+    CORRADE_COMPARE(font.descent(), -10.0f);
+    CORRADE_COMPARE(font.lineHeight(), 39.7333f);
+    CORRADE_COMPARE(font.glyphId(U'W'), 2);
+    CORRADE_COMPARE(font.glyphId(U'e'), 1);
+    CORRADE_COMPARE(font.glyphId(U'X'), 0);
+    CORRADE_COMPARE(font.glyphAdvance(font.glyphId(U'W')), Vector2(23.0f, 0.0f));
+}
+
+void MagnumFontGLTest::binaryOpenData() {
+    const Containers::Array<char> data = Utility::Directory::read(Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.magnumfont"));
+
+    /* Only the single file is needed */
+    MagnumFont font;
+    CORRADE_VERIFY(font.openData({{"font.magnumfont", data}}, 0.0f));
+    CORRADE_COMPARE(font.size(), 16.0f);
+    CORRADE_COMPARE(font.glyphAdvance(font.glyphId(U'e')), Vector2(12.0f, 0.0f));
+}
+
+void MagnumFontGLTest::binaryLayout() {
+    MagnumFont font;
+    CORRADE_VERIFY(font.openFile(Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.magnumfont"), 0.0f));
+
+    /* The same as in layout() */
+    GlyphCache cache(Vector2i(256));
+    cache.insert(font.glyphId(U'W'), {25, 34}, {{0, 8}, {16, 128}});
+    cache.insert(font.glyphId(U'e'), {25, 12}, {{16, 4}, {64, 32}});
+
+    auto layouter = font.layout(cache, 0.5f, "Wave");
+    CORRADE_VERIFY(layouter);
+    CORRADE_COMPARE(layouter->glyphCount(), 4);
+
+    Range2D rectangle;
+    Range2D position;
+    Range2D textureCoordinates;
+
+    /* 'W' */
+    Vector2 cursorPosition;
+    std::tie(position, textureCoordinates) = layouter->renderGlyph(0, cursorPosition = {}, rectangle);
+    CORRADE_COMPARE(position, Range2D({0.78125f, 1.0625f}, {1.28125f, 4.8125f}));
+    CORRADE_COMPARE(textureCoordinates, Range2D({0, 0.03125f}, {0.0625f, 0.5f}));
+    CORRADE_COMPARE(cursorPosition, Vector2(0.71875f, 0.0f));
+
+    /* 'a' (not found) */
+    std::tie(position, textureCoordinates) = layouter->renderGlyph(1, cursorPosition = {}, rectangle);
+    CORRADE_COMPARE(position, Range2D());
+    CORRADE_COMPARE(cursorPosition, Vector2(0.25f, 0.0f));
+}
+
+void MagnumFontGLTest::binaryCreateGlyphCache() {
+    MagnumFont font;
+    CORRADE_VERIFY(font.openFile(Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.magnumfont"), 0.0f));
+
+    std::unique_ptr<GlyphCache> cache = font.createGlyphCache();
+
+    MAGNUM_VERIFY_NO_ERROR();
+    CORRADE_VERIFY(cache);
+    CORRADE_COMPARE(cache->glyphCount(), 3);
+    CORRADE_COMPARE(cache->textureSize(), Vector2i(1536));
+    CORRADE_COMPARE(cache->padding(), Vector2i(24));
+    CORRADE_COMPARE((*cache)[1].first, (Vector2i{25, 12}));
+    CORRADE_COMPARE((*cache)[1].second, (Range2Di{{16, 4}, {64, 32}}));
+}
+
+void MagnumFontGLTest::binaryInvalidVersion() {
+    Containers::Array<char> data = Utility::Directory::read(Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.magnumfont"));
+    data[4] = 3;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    MagnumFont font;
+    CORRADE_VERIFY(!font.openData({{"font.magnumfont", data}}, 0.0f));
+    CORRADE_COMPARE(out.str(), "Text::MagnumFont::openData(): unsupported binary file version, expected 2 but got 3\n");
+}
+
+void MagnumFontGLTest::binaryTooShort() {
+    const Containers::Array<char> data = Utility::Directory::read(Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.magnumfont"));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    /* The image data are cut off */
+    MagnumFont font;
+    CORRADE_VERIFY(!font.openData({{"font.magnumfont", data.prefix(data.size() - 1)}}, 0.0f));
+    CORRADE_COMPARE(out.str(), "Text::MagnumFont::openData(): invalid binary file layout\n");
+}
+
+void MagnumFontGLTest::binaryInvalidCharacterTable() {
+    Containers::Array<char> data = Utility::Directory::read(Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.magnumfont"));
+
+    /* Glyph ID of the first character out of range */
+    data[68] = 3;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    MagnumFont font;
+    CORRADE_VERIFY(!font.openData({{"font.magnumfont", data}}, 0.0f));
+    CORRADE_COMPARE(out.str(), "Text::MagnumFont::openData(): invalid character table\n");
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Text::Test::MagnumFontGLTest)
@@ -25,18 +25,47 @@
 
 #include "MagnumFontConverter.h"
 
+#include <algorithm>
+#include <cstring>
 #include <sstream>
+#include <unordered_map>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/String.h>
 
 #include "Magnum/Image.h"
 #include "Magnum/PixelFormat.h"
 #include "Magnum/Text/GlyphCache.h"
 #include "Magnum/Text/AbstractFont.h"
+#include "MagnumPlugins/MagnumFont/MagnumFontBinary.h"
 #include "MagnumPlugins/TgaImageConverter/TgaImageConverter.h"
 
 namespace Magnum { namespace Text {
 
+namespace {
+
+/* Compress glyph IDs so the glyphs are in consecutive array, glyph 0 should
+   stay at position 0. Returns the map from old IDs to new ones and the
+   inverse map. */
+std::pair<std::unordered_map<UnsignedInt, UnsignedInt>, std::vector<UnsignedInt>> compressGlyphIds(const GlyphCache& cache) {
+    std::unordered_map<UnsignedInt, UnsignedInt> glyphIdMap;
+    glyphIdMap.reserve(cache.glyphCount());
+    glyphIdMap.emplace(0, 0);
+    for(const std::pair<UnsignedInt, std::pair<Vector2i, Range2Di>>& glyph: cache)
+        glyphIdMap.emplace(glyph.first, glyphIdMap.size());
+
+    /** @todo Save only glyphs contained in @p characters */
+
+    /* Inverse map from new glyph IDs to old ones */
+    std::vector<UnsignedInt> inverseGlyphIdMap(glyphIdMap.size());
+    for(const std::pair<UnsignedInt, UnsignedInt>& map: glyphIdMap)
+        inverseGlyphIdMap[map.second] = map.first;
+
+    return {std::move(glyphIdMap), std::move(inverseGlyphIdMap)};
+}
+
+}
+
 MagnumFontConverter::MagnumFontConverter() = default;
 
 MagnumFontConverter::MagnumFontConverter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractFontConverter{manager, plugin} {}
@@ -46,6 +75,9 @@ auto MagnumFontConverter::doFeatures() const -> Features {
 }
 
 std::vector<std::pair<std::string, Containers::Array<char>>> MagnumFontConverter::doExportFontToData(AbstractFont& font, GlyphCache& cache, const std::string& filename, const std::u32string& characters) const {
+    if(Utility::String::endsWith(filename, ".magnumfont"))
+        return exportBinaryFontToData(font, cache, filename, characters);
+
     Utility::Configuration configuration;
 
     configuration.setValue("version", 1);
@@ -57,20 +89,9 @@ std::vector<std::pair<std::string, Containers::Array<char>>> MagnumFontConverter
     configuration.setValue("descent", font.descent());
     configuration.setValue("lineHeight", font.lineHeight());
 
-    /* Compress glyph IDs so the glyphs are in consecutive array, glyph 0
-       should stay at position 0 */
     std::unordered_map<UnsignedInt, UnsignedInt> glyphIdMap;
-    glyphIdMap.reserve(cache.glyphCount());
-    glyphIdMap.emplace(0, 0);
-    for(const std::pair<UnsignedInt, std::pair<Vector2i, Range2Di>>& glyph: cache)
-        glyphIdMap.emplace(glyph.first, glyphIdMap.size());
-
-    /** @todo Save only glyphs contained in @p characters */
-
-    /* Inverse map from new glyph IDs to old ones */
-    std::vector<UnsignedInt> inverseGlyphIdMap(glyphIdMap.size());
-    for(const std::pair<UnsignedInt, UnsignedInt>& map: glyphIdMap)
-        inverseGlyphIdMap[map.second] = map.first;
+    std::vector<UnsignedInt> inverseGlyphIdMap;
+    std::tie(glyphIdMap, inverseGlyphIdMap) = compressGlyphIds(cache);
 
     /* Character->glyph map, map glyph IDs to new ones */
     for(const char32_t c: characters) {
@@ -111,4 +132,77 @@ std::vector<std::pair<std::string, Containers::Array<char>>> MagnumFontConverter
     return out;
 }
 
+std::vector<std::pair<std::string, Containers::Array<char>>> MagnumFontConverter::exportBinaryFontToData(AbstractFont& font, GlyphCache& cache, const std::string& filename, const std::u32string& characters) const {
+    std::unordered_map<UnsignedInt, UnsignedInt> glyphIdMap;
+    std::vector<UnsignedInt> inverseGlyphIdMap;
+    std::tie(glyphIdMap, inverseGlyphIdMap) = compressGlyphIds(cache);
+
+    /* Character->glyph table sorted by codepoint, map glyph IDs to new ones
+       and if not found, map to glyph 0. Duplicate characters are saved only
+       once. */
+    std::vector<Implementation::MagnumFontBinaryCharacter> characterTable;
+    characterTable.reserve(characters.size());
+    for(const char32_t c: characters) {
+        auto found = glyphIdMap.find(font.glyphId(c));
+        characterTable.push_back({UnsignedInt(c), found == glyphIdMap.end() ? 0 : found->second});
+    }
+    std::stable_sort(characterTable.begin(), characterTable.end(),
+        [](const Implementation::MagnumFontBinaryCharacter& a, const Implementation::MagnumFontBinaryCharacter& b) {
+            return a.codepoint < b.codepoint;
+        });
+    characterTable.erase(std::unique(characterTable.begin(), characterTable.end(),
+        [](const Implementation::MagnumFontBinaryCharacter& a, const Implementation::MagnumFontBinaryCharacter& b) {
+            return a.codepoint == b.codepoint;
+        }), characterTable.end());
+
+    /* Glyph properties in order which preserves their IDs, without padding,
+       the same as in the text format */
+    std::vector<Implementation::MagnumFontBinaryGlyph> glyphTable;
+    glyphTable.reserve(inverseGlyphIdMap.size());
+    for(UnsignedInt oldGlyphId: inverseGlyphIdMap) {
+        std::pair<Vector2i, Range2Di> glyph = cache[oldGlyphId];
+        glyphTable.push_back({font.glyphAdvance(oldGlyphId),
+                              glyph.first+cache.padding(),
+                              glyph.second.padded(-cache.padding())});
+    }
+
+    /* Cache image, rows are aligned to four bytes by default */
+    Image2D image(PixelFormat::Red, PixelType::UnsignedByte);
+    cache.texture().image(0, image);
+    const std::size_t imageDataSize = Implementation::magnumFontBinaryImageDataSize(image.size());
+    CORRADE_INTERNAL_ASSERT(image.data().size() >= imageDataSize);
+
+    Implementation::MagnumFontBinaryHeader header{};
+    std::memcpy(header.magic, Implementation::MagnumFontBinaryMagic, sizeof(header.magic));
+    header.version = Implementation::MagnumFontBinaryVersion;
+    header.fontSize = font.size();
+    header.ascent = font.ascent();
+    header.descent = font.descent();
+    header.lineHeight = font.lineHeight();
+    header.originalImageSize[0] = cache.textureSize().x();
+    header.originalImageSize[1] = cache.textureSize().y();
+    header.padding[0] = cache.padding().x();
+    header.padding[1] = cache.padding().y();
+    header.imageSize[0] = image.size().x();
+    header.imageSize[1] = image.size().y();
+    header.characterCount = characterTable.size();
+    header.glyphCount = glyphTable.size();
+    header.imageDataOffset = sizeof(header) + characterTable.size()*sizeof(Implementation::MagnumFontBinaryCharacter) + glyphTable.size()*sizeof(Implementation::MagnumFontBinaryGlyph);
+    header.imageDataSize = imageDataSize;
+
+    /* Everything is a multiple of four bytes, so no padding is needed */
+    Containers::Array<char> data{header.imageDataOffset + header.imageDataSize};
+    char* it = data;
+    std::memcpy(it, &header, sizeof(header));
+    it += sizeof(header);
+    std::memcpy(it, characterTable.data(), characterTable.size()*sizeof(Implementation::MagnumFontBinaryCharacter));
+    it += characterTable.size()*sizeof(Implementation::MagnumFontBinaryCharacter);
+    std::memcpy(it, glyphTable.data(), glyphTable.size()*sizeof(Implementation::MagnumFontBinaryGlyph));
+    std::memcpy(data + header.imageDataOffset, image.data(), imageDataSize);
+
+    std::vector<std::pair<std::string, Containers::Array<char>>> out;
+    out.emplace_back(filename, std::move(data));
+    return out;
+}
+
 }}
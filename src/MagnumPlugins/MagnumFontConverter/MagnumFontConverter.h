@@ -54,6 +54,11 @@ namespace Magnum { namespace Text {
 Expects filename prefix, creates two files, `prefix.conf` and `prefix.tga`. See
 @ref MagnumFont for more information about the font.
 
+If the filename ends with `.magnumfont`, a single file in the binary MagnumFont
+format is created instead, containing flat glyph tables and the raw glyph cache
+image. It's considerably faster to load than the text variant, see
+@ref MagnumFont for details.
+
 This plugin is available only on desktop OpenGL, as it uses @ref Texture::image()
 to read back the generated data. It depends on
 @ref Trade::TgaImageConverter "TgaImageConverter" plugin and is built if
@@ -75,6 +80,7 @@ class MAGNUM_MAGNUMFONTCONVERTER_EXPORT MagnumFontConverter: public Text::Abstra
     private:
         MAGNUM_MAGNUMFONTCONVERTER_LOCAL Features doFeatures() const override;
         MAGNUM_MAGNUMFONTCONVERTER_LOCAL std::vector<std::pair<std::string, Containers::Array<char>>> doExportFontToData(AbstractFont& font, GlyphCache& cache, const std::string& filename, const std::u32string& characters) const override;
+        MAGNUM_MAGNUMFONTCONVERTER_LOCAL std::vector<std::pair<std::string, Containers::Array<char>>> exportBinaryFontToData(AbstractFont& font, GlyphCache& cache, const std::string& filename, const std::u32string& characters) const;
 };
 
 }}
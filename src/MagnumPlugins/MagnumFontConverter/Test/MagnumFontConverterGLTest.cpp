@@ -23,6 +23,8 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <cstring>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Utility/Directory.h>
 #include <Corrade/TestSuite/Compare/File.h>
 
@@ -34,6 +36,7 @@
 #include "Magnum/Text/GlyphCache.h"
 #include "Magnum/Text/AbstractFont.h"
 #include "Magnum/Trade/ImageData.h"
+#include "MagnumPlugins/MagnumFont/MagnumFontBinary.h"
 #include "MagnumPlugins/MagnumFontConverter/MagnumFontConverter.h"
 #include "MagnumPlugins/TgaImporter/TgaImporter.h"
 
@@ -46,17 +49,15 @@ struct MagnumFontConverterGLTest: OpenGLTester {
     explicit MagnumFontConverterGLTest();
 
     void exportFont();
+    void exportFontBinary();
 };
 
 MagnumFontConverterGLTest::MagnumFontConverterGLTest() {
-    addTests({&MagnumFontConverterGLTest::exportFont});
+    addTests({&MagnumFontConverterGLTest::exportFont,
+              &MagnumFontConverterGLTest::exportFontBinary});
 }
 
-void MagnumFontConverterGLTest::exportFont() {
-    /* Remove previously created files */
-    Utility::Directory::rm(Utility::Directory::join(MAGNUMFONTCONVERTER_TEST_WRITE_DIR, "font.conf"));
-    Utility::Directory::rm(Utility::Directory::join(MAGNUMFONTCONVERTER_TEST_WRITE_DIR, "font.tga"));
-
+namespace {
     /* Fake font with fake cache */
     class FakeFont: public Text::AbstractFont {
         public:
@@ -92,7 +93,15 @@ void MagnumFontConverterGLTest::exportFont() {
             }
 
             bool _opened;
-    } font;
+    };
+}
+
+void MagnumFontConverterGLTest::exportFont() {
+    /* Remove previously created files */
+    Utility::Directory::rm(Utility::Directory::join(MAGNUMFONTCONVERTER_TEST_WRITE_DIR, "font.conf"));
+    Utility::Directory::rm(Utility::Directory::join(MAGNUMFONTCONVERTER_TEST_WRITE_DIR, "font.tga"));
+
+    FakeFont font;
     font.openFile({}, {});
 
     /* Create fake cache */
@@ -121,6 +130,65 @@ void MagnumFontConverterGLTest::exportFont() {
     CORRADE_COMPARE(image->type(), PixelType::UnsignedByte);
 }
 
+void MagnumFontConverterGLTest::exportFontBinary() {
+    /* Remove previously created file */
+    const std::string filename = Utility::Directory::join(MAGNUMFONTCONVERTER_TEST_WRITE_DIR, "font.magnumfont");
+    Utility::Directory::rm(filename);
+
+    FakeFont font;
+    font.openFile({}, {});
+
+    /* Create fake cache */
+    MAGNUM_ASSERT_EXTENSION_SUPPORTED(Extensions::GL::ARB::texture_rg);
+    GlyphCache cache(TextureFormat::R8, Vector2i(1536), Vector2i(256), Vector2i(24));
+    cache.insert(font.glyphId(U'W'), {25, 34}, {{0, 8}, {16, 128}});
+    cache.insert(font.glyphId(U'e'), {25, 12}, {{16, 4}, {64, 32}});
+
+    /* Convert the file, duplicate characters are saved only once */
+    MagnumFontConverter converter;
+    CORRADE_VERIFY(converter.exportFontToFile(font, cache, filename, "Wavee"));
+    CORRADE_VERIFY(Utility::Directory::fileExists(filename));
+
+    /* Verify the header, loading is tested in MagnumFontGLTest */
+    const Containers::Array<char> data = Utility::Directory::read(filename);
+    Implementation::MagnumFontBinaryHeader header;
+    CORRADE_VERIFY(data.size() >= sizeof(header));
+    std::memcpy(&header, data, sizeof(header));
+    CORRADE_COMPARE(std::string(header.magic, 4), "MFNT");
+    CORRADE_COMPARE(header.version, 2);
+    CORRADE_COMPARE(header.fontSize, 16.0f);
+    CORRADE_COMPARE(header.lineHeight, 39.7333f);
+    CORRADE_COMPARE(header.originalImageSize[0], 1536);
+    CORRADE_COMPARE(header.padding[1], 24);
+    CORRADE_COMPARE(header.imageSize[0], 256);
+    CORRADE_COMPARE(header.imageSize[1], 256);
+    CORRADE_COMPARE(header.characterCount, 4);
+    CORRADE_COMPARE(header.glyphCount, 3);
+    CORRADE_COMPARE(header.imageDataOffset, 64 + 4*8 + 3*32);
+    CORRADE_COMPARE(header.imageDataSize, 256*256);
+    CORRADE_COMPARE(data.size(), header.imageDataOffset + header.imageDataSize);
+
+    /* Characters are sorted by codepoint, 'a' and 'v' map to glyph 0 */
+    Implementation::MagnumFontBinaryCharacter characters[4];
+    std::memcpy(characters, data + sizeof(header), sizeof(characters));
+    CORRADE_COMPARE(characters[0].codepoint, U'W');
+    CORRADE_VERIFY(characters[0].glyph != 0);
+    CORRADE_COMPARE(characters[1].codepoint, U'a');
+    CORRADE_COMPARE(characters[1].glyph, 0);
+    CORRADE_COMPARE(characters[2].codepoint, U'e');
+    CORRADE_VERIFY(characters[2].glyph != 0);
+    CORRADE_COMPARE(characters[3].codepoint, U'v');
+    CORRADE_COMPARE(characters[3].glyph, 0);
+
+    /* Padding is removed from the glyph properties */
+    Implementation::MagnumFontBinaryGlyph glyphs[3];
+    std::memcpy(glyphs, data + sizeof(header) + sizeof(characters), sizeof(glyphs));
+    CORRADE_COMPARE(glyphs[0].advance, Vector2(8.0f, 0.0f));
+    CORRADE_COMPARE(glyphs[characters[0].glyph].advance, Vector2(23.0f, 0.0f));
+    CORRADE_COMPARE(glyphs[characters[0].glyph].position, Vector2i(49, 58));
+    CORRADE_COMPARE(glyphs[characters[0].glyph].rectangle, Range2Di({24, 32}, {-8, 104}));
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Text::Test::MagnumFontConverterGLTest)
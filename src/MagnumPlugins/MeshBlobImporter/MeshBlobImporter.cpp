@@ -0,0 +1,106 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MeshBlobImporter.h"
+
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/MeshData3D.h"
+#include "Magnum/Trade/Implementation/mapFile.h"
+
+namespace Magnum { namespace Trade {
+
+MeshBlobImporter::MeshBlobImporter() = default;
+
+MeshBlobImporter::MeshBlobImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
+
+MeshBlobImporter::~MeshBlobImporter() = default;
+
+auto MeshBlobImporter::doFeatures() const -> Features { return Feature::OpenData|Feature::OpenMemory; }
+
+bool MeshBlobImporter::doIsOpened() const { return !!_blob; }
+
+void MeshBlobImporter::doClose() {
+    _blob = std::nullopt;
+    _data = nullptr;
+}
+
+void MeshBlobImporter::doOpenData(const Containers::ArrayView<const char> data) {
+    Containers::Array<char> copy{data.size()};
+    std::copy(data.begin(), data.end(), copy.begin());
+    openInternal(std::move(copy));
+}
+
+void MeshBlobImporter::doOpenMemory(const Containers::ArrayView<const char> memory) {
+    openInternal(nonOwningArray(memory));
+}
+
+void MeshBlobImporter::doOpenFile(const std::string& filename) {
+    /* Map the file, if possible */
+    std::optional<Containers::Array<char>> data = Implementation::mapFile(filename);
+    if(!data) {
+        Error() << "Trade::MeshBlobImporter::openFile(): cannot open file" << filename;
+        return;
+    }
+
+    openInternal(std::move(*data));
+}
+
+void MeshBlobImporter::openInternal(Containers::Array<char>&& data) {
+    /* MeshBlob::open() prints the error message */
+    std::optional<MeshTools::MeshBlob> blob = MeshTools::MeshBlob::open(data);
+    if(!blob) return;
+
+    _data = std::move(data);
+    _blob = std::move(blob);
+}
+
+UnsignedInt MeshBlobImporter::doMesh3DCount() const { return 1; }
+
+std::optional<MeshData3D> MeshBlobImporter::doMesh3D(UnsignedInt) {
+    return _blob->meshData(&*_blob);
+}
+
+std::optional<MeshData> MeshBlobImporter::doInterleavedMesh3D(UnsignedInt) {
+    /* The blob is already interleaved, so just copy both arrays verbatim */
+    Containers::Array<char> vertexData{_blob->vertexData().size()};
+    std::copy(_blob->vertexData().begin(), _blob->vertexData().end(), vertexData.begin());
+
+    std::vector<MeshAttributeData> attributes{{MeshAttribute::Position, MeshAttributeType::Vector3, 0, _blob->stride()}};
+    if(_blob->hasNormals())
+        attributes.push_back({MeshAttribute::Normal, MeshAttributeType::Vector3, _blob->normalOffset(), _blob->stride()});
+    if(_blob->hasTextureCoords2D())
+        attributes.push_back({MeshAttribute::TextureCoordinates, MeshAttributeType::Vector2, _blob->textureCoords2DOffset(), _blob->stride()});
+
+    if(!_blob->isIndexed())
+        return MeshData{_blob->primitive(), _blob->vertexCount(), std::move(vertexData), std::move(attributes), &*_blob};
+
+    Containers::Array<char> indexData{_blob->indexData().size()};
+    std::copy(_blob->indexData().begin(), _blob->indexData().end(), indexData.begin());
+    return MeshData{_blob->primitive(), _blob->indexType(), std::move(indexData), _blob->vertexCount(), std::move(vertexData), std::move(attributes), &*_blob};
+}
+
+const void* MeshBlobImporter::doImporterState() const { return &*_blob; }
+
+}}
@@ -0,0 +1,124 @@
+#ifndef Magnum_Trade_MeshBlobImporter_h
+#define Magnum_Trade_MeshBlobImporter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::MeshBlobImporter
+ */
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/MeshTools/MeshBlob.h"
+#include "Magnum/Trade/AbstractImporter.h"
+
+#include "MagnumPlugins/MeshBlobImporter/configure.h"
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+#ifndef MAGNUM_MESHBLOBIMPORTER_BUILD_STATIC
+    #if defined(MeshBlobImporter_EXPORTS) || defined(MeshBlobImporterObjects_EXPORTS)
+        #define MAGNUM_MESHBLOBIMPORTER_EXPORT CORRADE_VISIBILITY_EXPORT
+    #else
+        #define MAGNUM_MESHBLOBIMPORTER_EXPORT CORRADE_VISIBILITY_IMPORT
+    #endif
+#else
+    #define MAGNUM_MESHBLOBIMPORTER_EXPORT CORRADE_VISIBILITY_STATIC
+#endif
+#define MAGNUM_MESHBLOBIMPORTER_LOCAL CORRADE_VISIBILITY_LOCAL
+#endif
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Binary mesh blob importer plugin
+
+Imports files in the format described in @ref MeshTools::MeshBlob, which can
+be created from any @ref MeshData3D using @ref MeshTools::MeshBlob::serialize().
+Each file contains exactly one mesh.
+
+On Unix @ref openFile() memory-maps the file instead of reading it, data
+passed to @ref openData() are copied once and data passed to @ref openMemory()
+are not copied at all. Opening the file validates just the header. The
+@ref mesh3D() function deinterleaves the data into a @ref MeshData3D for
+compatibility with other importers, but the imported data don't need to be
+touched at all --- both @ref importerState() and
+@ref MeshData3D::importerState() point to a @ref MeshTools::MeshBlob
+instance referencing the file data, which can be passed directly to the GPU
+using @ref MeshTools::MeshBlob::compile():
+@code
+std::unique_ptr<Trade::AbstractImporter> importer = manager.instance("MeshBlobImporter");
+importer->openFile("level.blob");
+
+auto blob = static_cast<const MeshTools::MeshBlob*>(importer->importerState());
+Mesh mesh{NoCreate};
+std::unique_ptr<Buffer> vertices, indices;
+std::tie(mesh, vertices, indices) = blob->compile(BufferUsage::StaticDraw);
+@endcode
+
+The @ref MeshTools::MeshBlob instance is valid only until the file is closed.
+Alternatively, @ref interleavedMesh3D() copies the vertex and index data into
+a @ref MeshData as-is, without deinterleaving them first.
+
+This plugin is built if `WITH_MESHBLOBIMPORTER` is enabled when building
+Magnum. To use dynamic plugin, you need to load `MeshBlobImporter` plugin from
+`MAGNUM_PLUGINS_IMPORTER_DIR`. To use static plugin or use this as a
+dependency of another plugin, you need to request `MeshBlobImporter` component
+of `Magnum` package in CMake and link to `Magnum::MeshBlobImporter` target.
+See @ref building, @ref cmake and @ref plugins for more information.
+*/
+class MAGNUM_MESHBLOBIMPORTER_EXPORT MeshBlobImporter: public AbstractImporter {
+    public:
+        /** @brief Default constructor */
+        explicit MeshBlobImporter();
+
+        /** @brief Plugin manager constructor */
+        explicit MeshBlobImporter(PluginManager::AbstractManager& manager, const std::string& plugin);
+
+        ~MeshBlobImporter();
+
+    private:
+        MAGNUM_MESHBLOBIMPORTER_LOCAL Features doFeatures() const override;
+
+        MAGNUM_MESHBLOBIMPORTER_LOCAL bool doIsOpened() const override;
+        MAGNUM_MESHBLOBIMPORTER_LOCAL void doOpenData(Containers::ArrayView<const char> data) override;
+        MAGNUM_MESHBLOBIMPORTER_LOCAL void doOpenMemory(Containers::ArrayView<const char> memory) override;
+        MAGNUM_MESHBLOBIMPORTER_LOCAL void doOpenFile(const std::string& filename) override;
+        MAGNUM_MESHBLOBIMPORTER_LOCAL void doClose() override;
+
+        MAGNUM_MESHBLOBIMPORTER_LOCAL UnsignedInt doMesh3DCount() const override;
+        MAGNUM_MESHBLOBIMPORTER_LOCAL std::optional<MeshData3D> doMesh3D(UnsignedInt id) override;
+        MAGNUM_MESHBLOBIMPORTER_LOCAL std::optional<MeshData> doInterleavedMesh3D(UnsignedInt id) override;
+
+        MAGNUM_MESHBLOBIMPORTER_LOCAL const void* doImporterState() const override;
+
+        MAGNUM_MESHBLOBIMPORTER_LOCAL void openInternal(Containers::Array<char>&& data);
+
+        Containers::Array<char> _data;
+        std::optional<MeshTools::MeshBlob> _blob;
+};
+
+}}
+
+#endif
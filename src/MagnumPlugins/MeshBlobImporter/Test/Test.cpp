@@ -0,0 +1,182 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/MeshTools/MeshBlob.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/MeshData3D.h"
+#include "MagnumPlugins/MeshBlobImporter/MeshBlobImporter.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test {
+
+struct MeshBlobImporterTest: TestSuite::Tester {
+    explicit MeshBlobImporterTest();
+
+    void openFile();
+    void openFileNonexistent();
+    void openData();
+    void openMemory();
+    void openInvalid();
+
+    void meshImporterState();
+    void interleavedMesh();
+};
+
+MeshBlobImporterTest::MeshBlobImporterTest() {
+    addTests({&MeshBlobImporterTest::openFile,
+              &MeshBlobImporterTest::openFileNonexistent,
+              &MeshBlobImporterTest::openData,
+              &MeshBlobImporterTest::openMemory,
+              &MeshBlobImporterTest::openInvalid,
+
+              &MeshBlobImporterTest::meshImporterState,
+              &MeshBlobImporterTest::interleavedMesh});
+}
+
+void MeshBlobImporterTest::openFile() {
+    MeshBlobImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(MESHBLOBIMPORTER_TEST_DIR, "triangles.blob")));
+    CORRADE_COMPARE(importer.mesh3DCount(), 1);
+
+    std::optional<MeshData3D> data = importer.mesh3D(0);
+    CORRADE_VERIFY(data);
+    CORRADE_COMPARE(data->primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(data->indices(), (std::vector<UnsignedInt>{0, 1, 2, 0, 2, 3}));
+    CORRADE_COMPARE(data->positionArrayCount(), 1);
+    CORRADE_COMPARE(data->positions(0), (std::vector<Vector3>{
+        {-1.0f, -1.0f, 0.0f}, {1.0f, -1.0f, 0.0f}, {1.0f, 1.0f, 0.0f}, {-1.0f, 1.0f, 0.0f}}));
+    CORRADE_COMPARE(data->normalArrayCount(), 1);
+    CORRADE_COMPARE(data->normals(0), (std::vector<Vector3>{
+        {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 1.0f}}));
+    CORRADE_COMPARE(data->textureCoords2DArrayCount(), 1);
+    CORRADE_COMPARE(data->textureCoords2D(0), (std::vector<Vector2>{
+        {0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}}));
+
+    importer.close();
+    CORRADE_VERIFY(!importer.isOpened());
+}
+
+void MeshBlobImporterTest::openFileNonexistent() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    MeshBlobImporter importer;
+    CORRADE_VERIFY(!importer.openFile(Utility::Directory::join(MESHBLOBIMPORTER_TEST_DIR, "nonexistent.blob")));
+    CORRADE_COMPARE(out.str(), "Trade::MeshBlobImporter::openFile(): cannot open file " + Utility::Directory::join(MESHBLOBIMPORTER_TEST_DIR, "nonexistent.blob") + "\n");
+}
+
+void MeshBlobImporterTest::openData() {
+    Containers::Array<char> data = Utility::Directory::read(Utility::Directory::join(MESHBLOBIMPORTER_TEST_DIR, "triangles.blob"));
+
+    MeshBlobImporter importer;
+    CORRADE_VERIFY(importer.openData(data));
+
+    /* The data should be copied */
+    auto blob = static_cast<const MeshTools::MeshBlob*>(importer.importerState());
+    CORRADE_VERIFY(blob);
+    CORRADE_VERIFY(blob->vertexData().data() != data + MeshTools::MeshBlob::HeaderSize);
+
+    std::optional<MeshData3D> meshData = importer.mesh3D(0);
+    CORRADE_VERIFY(meshData);
+    CORRADE_COMPARE(meshData->indices().size(), 6);
+}
+
+void MeshBlobImporterTest::openMemory() {
+    Containers::Array<char> data = Utility::Directory::read(Utility::Directory::join(MESHBLOBIMPORTER_TEST_DIR, "triangles.blob"));
+
+    MeshBlobImporter importer;
+    CORRADE_VERIFY(importer.features() & AbstractImporter::Feature::OpenMemory);
+    CORRADE_VERIFY(importer.openMemory(data));
+
+    /* The data should be referenced */
+    auto blob = static_cast<const MeshTools::MeshBlob*>(importer.importerState());
+    CORRADE_VERIFY(blob);
+    CORRADE_VERIFY(blob->vertexData().data() == data + MeshTools::MeshBlob::HeaderSize);
+    CORRADE_COMPARE(blob->vertexCount(), 4);
+    CORRADE_COMPARE(blob->indexCount(), 6);
+}
+
+void MeshBlobImporterTest::openInvalid() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    MeshBlobImporter importer;
+    CORRADE_VERIFY(!importer.openData(Containers::ArrayView<const char>{"MBLB\x02", 5}));
+    CORRADE_VERIFY(!importer.isOpened());
+    CORRADE_COMPARE(out.str(), "MeshTools::MeshBlob::open(): data too short, expected at least 64 bytes but got 5\n");
+}
+
+void MeshBlobImporterTest::meshImporterState() {
+    MeshBlobImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(MESHBLOBIMPORTER_TEST_DIR, "triangles.blob")));
+
+    std::optional<MeshData3D> data = importer.mesh3D(0);
+    CORRADE_VERIFY(data);
+    CORRADE_VERIFY(data->importerState());
+    CORRADE_COMPARE(data->importerState(), importer.importerState());
+
+    auto blob = static_cast<const MeshTools::MeshBlob*>(data->importerState());
+    CORRADE_COMPARE(blob->stride(), 32);
+    CORRADE_COMPARE(blob->indexType(), Mesh::IndexType::UnsignedByte);
+    CORRADE_COMPARE(blob->vertexData().size(), 4*32);
+}
+
+void MeshBlobImporterTest::interleavedMesh() {
+    MeshBlobImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(MESHBLOBIMPORTER_TEST_DIR, "triangles.blob")));
+
+    std::optional<MeshData> data = importer.interleavedMesh3D(0);
+    CORRADE_VERIFY(data);
+    CORRADE_COMPARE(data->primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(data->indexType(), Mesh::IndexType::UnsignedByte);
+    CORRADE_COMPARE(data->indices(), (std::vector<UnsignedInt>{0, 1, 2, 0, 2, 3}));
+    CORRADE_COMPARE(data->vertexCount(), 4);
+    CORRADE_COMPARE(data->attributeCount(), 3);
+    CORRADE_COMPARE(data->attribute(1).name, MeshAttribute::Normal);
+    CORRADE_COMPARE(data->attribute(1).offset, 12);
+    CORRADE_COMPARE(data->attribute(2).name, MeshAttribute::TextureCoordinates);
+    CORRADE_COMPARE(data->attribute(2).stride, 32);
+    CORRADE_COMPARE(data->importerState(), importer.importerState());
+
+    /* The vertex data are the blob contents verbatim */
+    auto blob = static_cast<const MeshTools::MeshBlob*>(importer.importerState());
+    CORRADE_COMPARE(data->vertexData().size(), blob->vertexData().size());
+    CORRADE_VERIFY(data->vertexData().data() != blob->vertexData().data());
+    CORRADE_VERIFY(std::equal(blob->vertexData().begin(), blob->vertexData().end(), data->vertexData().begin()));
+    CORRADE_COMPARE(data->attributeData<Vector2>(2), (std::vector<Vector2>{
+        {0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}}));
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::MeshBlobImporterTest)
@@ -25,12 +25,26 @@
 
 #include "ObjImporter.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
+#include <functional>
 #include <limits>
 #include <sstream>
 #include <unordered_map>
-#include <Corrade/Containers/ArrayView.h>
-#include <Corrade/Utility/String.h>
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#endif
+#include <Corrade/Containers/Array.h>
+
+#if defined(CORRADE_TARGET_UNIX) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 #include "Magnum/Mesh.h"
 #include "Magnum/MeshTools/CombineIndexedArrays.h"
@@ -40,59 +54,188 @@
 
 namespace Magnum { namespace Trade {
 
+namespace {
+
+struct Mesh {
+    /* Byte range of the mesh in the file data */
+    std::size_t begin, end;
+
+    /* Offsets of the first vertex, texture coordinate and normal of this
+       mesh in the whole file, used for converting the indices */
+    UnsignedInt positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset;
+
+    /* Element counts gathered in the initial pass, used to reserve the
+       output arrays */
+    std::size_t positionCount, textureCoordinateCount, normalCount, indexCount;
+};
+
+}
+
 struct ObjImporter::File {
     std::unordered_map<std::string, UnsignedInt> meshesForName;
     std::vector<std::string> meshNames;
-    std::vector<std::tuple<std::streampos, std::streampos, UnsignedInt, UnsignedInt, UnsignedInt>> meshes;
-    std::unique_ptr<std::istream> in;
+    std::vector<Mesh> meshes;
+    Containers::Array<char> data;
 };
 
 namespace {
 
-void ignoreLine(std::istream& in) {
-    in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+inline bool isWhitespace(const char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
 }
 
-template<std::size_t size> Math::Vector<size, Float> extractFloatData(const std::string& str, Float* extra = nullptr) {
-    std::vector<std::string> data = Utility::String::splitWithoutEmptyParts(str, ' ');
-    if(data.size() < size || data.size() > size + (extra ? 1 : 0)) {
-        Error() << "Trade::ObjImporter::mesh3D(): invalid float array size";
-        throw 0;
+inline bool isDigit(const char c) {
+    return c >= '0' && c <= '9';
+}
+
+const char* skipWhitespace(const char* it, const char* const end) {
+    while(it != end && isWhitespace(*it)) ++it;
+    return it;
+}
+
+const char* skipToken(const char* it, const char* const end) {
+    while(it != end && !isWhitespace(*it)) ++it;
+    return it;
+}
+
+const char* trimTrailingWhitespace(const char* const begin, const char* end) {
+    while(end != begin && isWhitespace(*(end - 1))) --end;
+    return end;
+}
+
+/* Returns pointer to the newline character or to the end of the data */
+const char* findLineEnd(const char* const it, const char* const end) {
+    const void* const found = std::memchr(it, '\n', end - it);
+    return found ? static_cast<const char*>(found) : end;
+}
+
+bool equals(const char* const begin, const char* const end, const char* const string) {
+    const std::size_t size = std::strlen(string);
+    return std::size_t(end - begin) == size && std::memcmp(begin, string, size) == 0;
+}
+
+std::size_t countTokens(const char* it, const char* const end) {
+    std::size_t count = 0;
+    while((it = skipWhitespace(it, end)) != end) {
+        it = skipToken(it, end);
+        ++count;
     }
+    return count;
+}
 
-    Math::Vector<size, Float> output;
+/* Parses the whole [begin, end) range as a decimal unsigned integer */
+bool parseUnsignedInt(const char* it, const char* const end, UnsignedInt& out) {
+    if(it == end) return false;
 
-    for(std::size_t i = 0; i != size; ++i) {
-        #ifndef CORRADE_TARGET_ANDROID
-        output[i] = std::stof(data[i]);
-        #else
-        /* CRAPPY ANDROID GODDAMIT! It's also not exposed in std:: namespace,
-           unlike std::strtoul() and others. WTF! */
-        char* end{};
-        output[i] = strtof(data[i].data(), &end);
-        if(end == data[i].data() || output[i] == HUGE_VALF)
-            throw std::exception{};
-        #endif
+    std::uint64_t value = 0;
+    for(; it != end; ++it) {
+        if(!isDigit(*it)) return false;
+        value = value*10 + (*it - '0');
+        if(value > std::numeric_limits<UnsignedInt>::max()) return false;
     }
 
-    if(data.size() == size+1) {
-        /* This should be obvious from the first if, but add this just to make
-           Clang Analyzer happy */
-        CORRADE_INTERNAL_ASSERT(extra);
+    out = UnsignedInt(value);
+    return true;
+}
 
-        #ifndef CORRADE_TARGET_ANDROID
-        *extra = std::stof(data.back());
-        #else
-        /* CRAPPY ANDROID GODDAMIT! It's also not exposed in std:: namespace,
-           unlike std::strtoul() and others. WTF! */
-        char* end{};
-        *extra = strtof(data.back().data(), &end);
-        if(end == data.back().data() || *extra == HUGE_VALF)
-            throw std::exception{};
-        #endif
+/* Parses the whole [begin, end) range as a decimal floating-point number with
+   optional sign, fractional part and exponent. Accumulates the significant
+   digits in an integer and applies the exponent as a single multiplication,
+   which is more than enough precision for a 32-bit float. */
+bool parseFloat(const char* it, const char* const end, Float& out) {
+    bool negative = false;
+    if(it != end && (*it == '-' || *it == '+')) {
+        negative = *it == '-';
+        ++it;
+    }
+
+    constexpr std::uint64_t MantissaLimit = 100000000000000000ull;
+    std::uint64_t mantissa = 0;
+    Int exponent = 0;
+    bool hasDigits = false;
+
+    /* Integral part. Digits that don't fit into the mantissa only bump the
+       exponent. */
+    for(; it != end && isDigit(*it); ++it) {
+        hasDigits = true;
+        if(mantissa < MantissaLimit) mantissa = mantissa*10 + (*it - '0');
+        else ++exponent;
     }
 
-    return output;
+    /* Fractional part */
+    if(it != end && *it == '.') {
+        for(++it; it != end && isDigit(*it); ++it) {
+            hasDigits = true;
+            if(mantissa < MantissaLimit) {
+                mantissa = mantissa*10 + (*it - '0');
+                --exponent;
+            }
+        }
+    }
+
+    if(!hasDigits) return false;
+
+    /* Exponent */
+    if(it != end && (*it == 'e' || *it == 'E')) {
+        ++it;
+        bool negativeExponent = false;
+        if(it != end && (*it == '-' || *it == '+')) {
+            negativeExponent = *it == '-';
+            ++it;
+        }
+
+        if(it == end) return false;
+        Int value = 0;
+        for(; it != end && isDigit(*it); ++it)
+            if(value < 10000) value = value*10 + (*it - '0');
+
+        exponent += negativeExponent ? -value : value;
+    }
+
+    /* Trailing garbage */
+    if(it != end) return false;
+
+    static const Double powers[]{
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    constexpr Int MaxPower = sizeof(powers)/sizeof(powers[0]) - 1;
+
+    Double value = Double(mantissa);
+    if(value != 0.0 && exponent) {
+        if(exponent > 0)
+            value *= exponent <= MaxPower ? powers[exponent] : std::pow(10.0, exponent);
+        else
+            value /= -exponent <= MaxPower ? powers[-exponent] : std::pow(10.0, -exponent);
+    }
+
+    /* Out of range, consistent with what std::stof() does */
+    if(value > Double(std::numeric_limits<Float>::max())) return false;
+
+    out = Float(negative ? -value : value);
+    return true;
+}
+
+template<std::size_t size> bool extractFloatData(std::ostream& error, const char* const begin, const char* const end, Math::Vector<size, Float>& output, Float* extra = nullptr) {
+    /* Verify the count first so the error is the same regardless of whether
+       the contents are valid numbers */
+    const std::size_t count = countTokens(begin, end);
+    if(count < size || count > size + (extra ? 1 : 0)) {
+        Error{&error} << "Trade::ObjImporter::mesh3D(): invalid float array size";
+        return false;
+    }
+
+    const char* it = begin;
+    for(std::size_t i = 0; i != count; ++i) {
+        it = skipWhitespace(it, end);
+        const char* const tokenEnd = skipToken(it, end);
+        if(!parseFloat(it, tokenEnd, i < size ? output[i] : *extra)) {
+            Error{&error} << "Trade::ObjImporter::mesh3D(): error while converting numeric data";
+            return false;
+        }
+        it = tokenEnd;
+    }
+
+    return true;
 }
 
 template<class T> void reindex(const std::vector<UnsignedInt>& indices, std::vector<T>& data) {
@@ -105,14 +248,264 @@ template<class T> void reindex(const std::vector<UnsignedInt>& indices, std::vec
     data = MeshTools::duplicate(indices, data);
 }
 
+/* Data parsed from a range of lines of one mesh */
+struct ParsedLines {
+    std::optional<MeshPrimitive> primitive;
+    std::vector<Vector3> positions;
+    std::vector<Vector2> textureCoordinates;
+    std::vector<Vector3> normals;
+    std::vector<UnsignedInt> positionIndices;
+    std::vector<UnsignedInt> textureCoordinateIndices;
+    std::vector<UnsignedInt> normalIndices;
+
+    /* Error message, empty if the parsing succeeded. The offsets of the
+       erroneous line and of the first primitive line are used to report
+       the errors in the same order as if the whole mesh was parsed at once. */
+    std::string error;
+    std::size_t errorOffset, primitiveOffset;
+};
+
+/* Parses lines in [begin, end), which is a part of given mesh */
+void parseLines(const char* const fileBegin, const char* const begin, const char* const end, const Mesh& mesh, ParsedLines& out) {
+    std::ostringstream error;
+    auto fail = [&](const char* const lineBegin) {
+        out.error = error.str();
+        out.errorOffset = lineBegin - fileBegin;
+    };
+
+    for(const char* it = begin; it != end; ) {
+        /* Get the line, trimmed */
+        const char* const lineEnd = findLineEnd(it, end);
+        const char* const lineBegin = skipWhitespace(it, lineEnd);
+        const char* const contentsEnd = trimTrailingWhitespace(lineBegin, lineEnd);
+        it = lineEnd == end ? end : lineEnd + 1;
+
+        /* Ignore empty lines and comments */
+        if(lineBegin == contentsEnd || *lineBegin == '#') continue;
+
+        /* Split the line into keyword and contents */
+        const char* const keywordEnd = skipToken(lineBegin, contentsEnd);
+        const char* const contentsBegin = skipWhitespace(keywordEnd, contentsEnd);
+
+        /* Vertex position */
+        if(equals(lineBegin, keywordEnd, "v")) {
+            Float extra{1.0f};
+            Vector3 data;
+            if(!extractFloatData<3>(error, contentsBegin, contentsEnd, data, &extra))
+                return fail(lineBegin);
+            if(!Math::TypeTraits<Float>::equals(extra, 1.0f)) {
+                Error{&error} << "Trade::ObjImporter::mesh3D(): homogeneous coordinates are not supported";
+                return fail(lineBegin);
+            }
+
+            out.positions.push_back(data);
+
+        /* Texture coordinate */
+        } else if(equals(lineBegin, keywordEnd, "vt")) {
+            Float extra{0.0f};
+            Vector2 data;
+            if(!extractFloatData<2>(error, contentsBegin, contentsEnd, data, &extra))
+                return fail(lineBegin);
+            if(!Math::TypeTraits<Float>::equals(extra, 0.0f)) {
+                Error{&error} << "Trade::ObjImporter::mesh3D(): 3D texture coordinates are not supported";
+                return fail(lineBegin);
+            }
+
+            out.textureCoordinates.push_back(data);
+
+        /* Normal */
+        } else if(equals(lineBegin, keywordEnd, "vn")) {
+            Vector3 data;
+            if(!extractFloatData<3>(error, contentsBegin, contentsEnd, data))
+                return fail(lineBegin);
+
+            out.normals.push_back(data);
+
+        /* Indices */
+        } else if(equals(lineBegin, keywordEnd, "p") || equals(lineBegin, keywordEnd, "l") || equals(lineBegin, keywordEnd, "f")) {
+            const std::size_t indexTupleCount = countTokens(contentsBegin, contentsEnd);
+
+            /* Points */
+            if(*lineBegin == 'p') {
+                /* Check that we don't mix the primitives in one mesh */
+                if(out.primitive && out.primitive != MeshPrimitive::Points) {
+                    Error{&error} << "Trade::ObjImporter::mesh3D(): mixed primitive" << *out.primitive << "and" << MeshPrimitive::Points;
+                    return fail(lineBegin);
+                }
+
+                /* Check vertex count per primitive */
+                if(indexTupleCount != 1) {
+                    Error{&error} << "Trade::ObjImporter::mesh3D(): wrong index count for point";
+                    return fail(lineBegin);
+                }
+
+                if(!out.primitive) out.primitiveOffset = lineBegin - fileBegin;
+                out.primitive = MeshPrimitive::Points;
+
+            /* Lines */
+            } else if(*lineBegin == 'l') {
+                /* Check that we don't mix the primitives in one mesh */
+                if(out.primitive && out.primitive != MeshPrimitive::Lines) {
+                    Error{&error} << "Trade::ObjImporter::mesh3D(): mixed primitive" << *out.primitive << "and" << MeshPrimitive::Lines;
+                    return fail(lineBegin);
+                }
+
+                /* Check vertex count per primitive */
+                if(indexTupleCount != 2) {
+                    Error{&error} << "Trade::ObjImporter::mesh3D(): wrong index count for line";
+                    return fail(lineBegin);
+                }
+
+                if(!out.primitive) out.primitiveOffset = lineBegin - fileBegin;
+                out.primitive = MeshPrimitive::Lines;
+
+            /* Faces */
+            } else if(*lineBegin == 'f') {
+                /* Check that we don't mix the primitives in one mesh */
+                if(out.primitive && out.primitive != MeshPrimitive::Triangles) {
+                    Error{&error} << "Trade::ObjImporter::mesh3D(): mixed primitive" << *out.primitive << "and" << MeshPrimitive::Triangles;
+                    return fail(lineBegin);
+                }
+
+                /* Check vertex count per primitive */
+                if(indexTupleCount < 3) {
+                    Error{&error} << "Trade::ObjImporter::mesh3D(): wrong index count for triangle";
+                    return fail(lineBegin);
+                } else if(indexTupleCount != 3) {
+                    Error{&error} << "Trade::ObjImporter::mesh3D(): polygons are not supported";
+                    return fail(lineBegin);
+                }
+
+                if(!out.primitive) out.primitiveOffset = lineBegin - fileBegin;
+                out.primitive = MeshPrimitive::Triangles;
+
+            } else CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+
+            for(const char* tuple = contentsBegin; (tuple = skipWhitespace(tuple, contentsEnd)) != contentsEnd; ) {
+                const char* const tupleEnd = skipToken(tuple, contentsEnd);
+
+                /* Split the tuple on slashes */
+                const char* fieldBegin[3]{tuple};
+                const char* fieldEnd[3]{tupleEnd};
+                std::size_t fieldCount = 1;
+                for(const char* c = tuple; c != tupleEnd; ++c) if(*c == '/') {
+                    if(fieldCount == 3) {
+                        Error{&error} << "Trade::ObjImporter::mesh3D(): invalid index data";
+                        return fail(lineBegin);
+                    }
+                    fieldEnd[fieldCount - 1] = c;
+                    fieldBegin[fieldCount] = c + 1;
+                    fieldEnd[fieldCount] = tupleEnd;
+                    ++fieldCount;
+                }
+
+                UnsignedInt index;
+
+                /* Position indices */
+                if(!parseUnsignedInt(fieldBegin[0], fieldEnd[0], index)) {
+                    Error{&error} << "Trade::ObjImporter::mesh3D(): error while converting numeric data";
+                    return fail(lineBegin);
+                }
+                out.positionIndices.push_back(index - mesh.positionIndexOffset);
+
+                /* Texture coordinates */
+                if(fieldCount == 2 || (fieldCount == 3 && fieldBegin[1] != fieldEnd[1])) {
+                    if(!parseUnsignedInt(fieldBegin[1], fieldEnd[1], index)) {
+                        Error{&error} << "Trade::ObjImporter::mesh3D(): error while converting numeric data";
+                        return fail(lineBegin);
+                    }
+                    out.textureCoordinateIndices.push_back(index - mesh.textureCoordinateIndexOffset);
+                }
+
+                /* Normal indices */
+                if(fieldCount == 3) {
+                    if(!parseUnsignedInt(fieldBegin[2], fieldEnd[2], index)) {
+                        Error{&error} << "Trade::ObjImporter::mesh3D(): error while converting numeric data";
+                        return fail(lineBegin);
+                    }
+                    out.normalIndices.push_back(index - mesh.normalIndexOffset);
+                }
+
+                tuple = tupleEnd;
+            }
+
+        /* Ignore unsupported keywords, error out on unknown keywords */
+        } else if(![&](){
+            /* Using lambda to emulate for-else construct like in Python */
+            for(const char* expected: {"mtllib", "usemtl", "g", "s"})
+                if(equals(lineBegin, keywordEnd, expected)) return true;
+            return false;
+        }()) {
+            Error{&error} << "Trade::ObjImporter::mesh3D(): unknown keyword" << std::string{lineBegin, keywordEnd};
+            return fail(lineBegin);
+        }
+    }
+
+}
+
+/* Below this size per thread the thread startup overhead outweighs the
+   gains */
+enum: std::size_t { ParallelMinChunkSize = 1024*1024 };
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+/* Calls f(i) for all i in [0, count) in parallel, the first one on the
+   calling thread */
+template<class F> void parallelFor(const std::size_t count, const F& f) {
+    std::vector<std::thread> threads;
+    threads.reserve(count - 1);
+    for(std::size_t i = 1; i != count; ++i)
+        threads.emplace_back(f, i);
+    f(0);
+    for(std::thread& thread: threads) thread.join();
+}
+#endif
+
+/* Copies a chunk to given offset of already allocated output */
+template<class T> void copyChunk(const std::vector<T>& chunk, std::vector<T>& out, const std::size_t offset) {
+    std::copy(chunk.begin(), chunk.end(), out.begin() + offset);
+}
+
+#if defined(CORRADE_TARGET_UNIX) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+void unmapDeleter(char* const data, const std::size_t size) {
+    if(data) munmap(data, size);
 }
 
-ObjImporter::ObjImporter() = default;
+/* Maps the file read-only into memory. Returns a null array on failure,
+   letting the caller fall back to reading the file the usual way. */
+Containers::Array<char> mapFile(const std::string& filename) {
+    const int fd = open(filename.data(), O_RDONLY);
+    if(fd == -1) return nullptr;
+
+    struct stat st;
+    void* data = MAP_FAILED;
+    if(fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        /* The file is processed front-to-back */
+        if(data != MAP_FAILED)
+            madvise(data, st.st_size, MADV_SEQUENTIAL);
+    }
+
+    /* The mapping stays valid after closing the descriptor */
+    close(fd);
+    if(data == MAP_FAILED) return nullptr;
+
+    return Containers::Array<char>{static_cast<char*>(data), std::size_t(st.st_size), unmapDeleter};
+}
+#endif
 
-ObjImporter::ObjImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
+}
+
+ObjImporter::ObjImporter(): _threadCount{0} {}
+
+ObjImporter::ObjImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin}, _threadCount{0} {}
 
 ObjImporter::~ObjImporter() = default;
 
+ObjImporter& ObjImporter::setThreadCount(const UnsignedInt count) {
+    _threadCount = count;
+    return *this;
+}
+
 auto ObjImporter::doFeatures() const -> Features { return Feature::OpenData; }
 
 void ObjImporter::doClose() { _file.reset(); }
@@ -120,56 +513,76 @@ void ObjImporter::doClose() { _file.reset(); }
 bool ObjImporter::doIsOpened() const { return !!_file; }
 
 void ObjImporter::doOpenFile(const std::string& filename) {
-    std::unique_ptr<std::istream> in{new std::ifstream{filename, std::ios::binary}};
-    if(!in->good()) {
-        Error() << "Trade::ObjImporter::openFile(): cannot open file" << filename;
-        return;
+    Containers::Array<char> data;
+
+    /* Try to map the file first. The mapping fails also for empty files, for
+       which the fallback below does the right thing. */
+    #if defined(CORRADE_TARGET_UNIX) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    data = mapFile(filename);
+    #endif
+
+    if(!data) {
+        std::ifstream in{filename, std::ios::binary};
+        if(!in.good()) {
+            Error() << "Trade::ObjImporter::openFile(): cannot open file" << filename;
+            return;
+        }
+
+        in.seekg(0, std::ios::end);
+        const std::size_t size = std::size_t(in.tellg());
+        in.seekg(0, std::ios::beg);
+        data = Containers::Array<char>{size};
+        in.read(data, size);
     }
 
     _file.reset(new File);
-    _file->in = std::move(in);
+    _file->data = std::move(data);
     parseMeshNames();
 }
 
 void ObjImporter::doOpenData(Containers::ArrayView<const char> data) {
     _file.reset(new File);
-    _file->in.reset(new std::istringstream{{data.begin(), data.size()}});
+    _file->data = Containers::Array<char>{data.size()};
+    std::copy(data.begin(), data.end(), _file->data.begin());
 
     parseMeshNames();
 }
 
 void ObjImporter::parseMeshNames() {
+    const char* const begin = _file->data.begin();
+    const char* const end = _file->data.end();
+
     /* First mesh starts at the beginning, its indices start from 1. The end
        offset will be updated to proper value later. */
     UnsignedInt positionIndexOffset = 1;
     UnsignedInt normalIndexOffset = 1;
     UnsignedInt textureCoordinateIndexOffset = 1;
-    _file->meshes.emplace_back(0, 0, positionIndexOffset, normalIndexOffset, textureCoordinateIndexOffset);
+    _file->meshes.push_back({0, 0, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset, 0, 0, 0, 0});
 
     /* The first mesh doesn't have name by default but we might find it later,
        so we need to track whether there are any data before first name */
     bool thisIsFirstMeshAndItHasNoData = true;
     _file->meshNames.emplace_back();
 
-    while(_file->in->good()) {
+    for(const char* it = begin; it != end; ) {
         /* The previous object might end at the beginning of this line */
-        const std::streampos end = _file->in->tellg();
+        const char* const lineBegin = it;
+        const char* const lineEnd = findLineEnd(it, end);
+        it = lineEnd == end ? end : lineEnd + 1;
 
-        /* Comment line */
-        if(_file->in->peek() == '#') {
-            ignoreLine(*_file->in);
-            continue;
-        }
+        /* Empty and comment lines */
+        const char* const keywordBegin = skipWhitespace(lineBegin, lineEnd);
+        if(keywordBegin == lineEnd || *keywordBegin == '#') continue;
 
         /* Parse the keyword */
-        std::string keyword;
-        *_file->in >> keyword;
+        const char* const keywordEnd = skipToken(keywordBegin, lineEnd);
+        const std::size_t keywordSize = keywordEnd - keywordBegin;
+        Mesh& mesh = _file->meshes.back();
 
         /* Mesh name */
-        if(keyword == "o") {
-            std::string name;
-            std::getline(*_file->in, name);
-            name = Utility::String::trim(name);
+        if(keywordSize == 1 && *keywordBegin == 'o') {
+            const char* const nameBegin = skipWhitespace(keywordEnd, lineEnd);
+            std::string name{nameBegin, trimTrailingWhitespace(nameBegin, lineEnd)};
 
             /* This is the name of first mesh */
             if(thisIsFirstMeshAndItHasNoData) {
@@ -181,54 +594,48 @@ void ObjImporter::parseMeshNames() {
                 _file->meshNames.back() = std::move(name);
 
                 /* Update its begin offset to be more precise */
-                std::get<0>(_file->meshes.back()) = _file->in->tellg();
+                mesh.begin = it - begin;
 
             /* Otherwise this is a name of new mesh */
             } else {
                 /* Set end of the previous one */
-                std::get<1>(_file->meshes.back()) = end;
+                mesh.end = lineBegin - begin;
 
                 /* Save name and offset of the new one. The end offset will be
                    updated later. */
                 if(!name.empty())
                     _file->meshesForName.emplace(name, _file->meshes.size());
                 _file->meshNames.emplace_back(std::move(name));
-                _file->meshes.emplace_back(_file->in->tellg(), 0, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset);
+                _file->meshes.push_back({std::size_t(it - begin), 0, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset, 0, 0, 0, 0});
             }
 
-            continue;
-
         /* If there are any data/indices before the first name, it means that
            the first object is unnamed. We need to check for them. */
 
         /* Vertex data, update index offset for the following meshes */
-        } else if(keyword == "v") {
+        } else if(keywordSize == 1 && *keywordBegin == 'v') {
             ++positionIndexOffset;
+            ++mesh.positionCount;
             thisIsFirstMeshAndItHasNoData = false;
-        } else if(keyword == "vt") {
+        } else if(keywordSize == 2 && keywordBegin[0] == 'v' && keywordBegin[1] == 't') {
             ++textureCoordinateIndexOffset;
+            ++mesh.textureCoordinateCount;
             thisIsFirstMeshAndItHasNoData = false;
-        } else if(keyword == "vn") {
+        } else if(keywordSize == 2 && keywordBegin[0] == 'v' && keywordBegin[1] == 'n') {
             ++normalIndexOffset;
+            ++mesh.normalCount;
             thisIsFirstMeshAndItHasNoData = false;
 
-        /* Index data, just mark that we found something for first unnamed
-           object */
-        } else if(thisIsFirstMeshAndItHasNoData) for(const std::string& data: {"p", "l", "f"}) {
-            if(keyword == data) {
-                thisIsFirstMeshAndItHasNoData = false;
-                break;
-            }
+        /* Index data, count them for reserving the index arrays later and
+           mark that we found something for first unnamed object */
+        } else if(keywordSize == 1 && (*keywordBegin == 'p' || *keywordBegin == 'l' || *keywordBegin == 'f')) {
+            mesh.indexCount += countTokens(keywordEnd, lineEnd);
+            thisIsFirstMeshAndItHasNoData = false;
         }
-
-        /* Ignore the rest of the line */
-        ignoreLine(*_file->in);
     }
 
     /* Set end of the last object */
-    _file->in->clear();
-    _file->in->seekg(0, std::ios::end);
-    std::get<1>(_file->meshes.back()) = _file->in->tellg();
+    _file->meshes.back().end = end - begin;
 }
 
 UnsignedInt ObjImporter::doMesh3DCount() const { return _file->meshes.size(); }
@@ -243,198 +650,129 @@ std::string ObjImporter::doMesh3DName(UnsignedInt id) {
 }
 
 std::optional<MeshData3D> ObjImporter::doMesh3D(UnsignedInt id) {
-    /* Seek the file, set mesh parsing parameters */
-    std::streampos begin, end;
-    UnsignedInt positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset;
-    std::tie(begin, end, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset) = _file->meshes[id];
-    _file->in->seekg(begin);
+    const Mesh& mesh = _file->meshes[id];
+    const char* const fileBegin = _file->data.begin();
+    const char* const begin = fileBegin + mesh.begin;
+    const char* const end = fileBegin + mesh.end;
+
+    /* Split large meshes into chunks on line boundaries and parse them in
+       parallel. All indices are relative to the mesh, so the chunks are
+       independent. */
+    std::size_t chunkCount = 1;
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    const UnsignedInt threadCount = _threadCount ? _threadCount : std::max(std::thread::hardware_concurrency(), 1u);
+    chunkCount = std::max(std::min(std::size_t(threadCount), (mesh.end - mesh.begin)/ParallelMinChunkSize), std::size_t(1));
+    #endif
+    std::vector<const char*> chunkBegins{begin};
+    for(std::size_t i = 1; i < chunkCount; ++i) {
+        const char* const split = std::max(chunkBegins.back(), begin + (end - begin)*i/chunkCount);
+        const char* const lineEnd = findLineEnd(split, end);
+        if(lineEnd == end) break;
+        chunkBegins.push_back(lineEnd + 1);
+    }
+    chunkBegins.push_back(end);
+
+    std::vector<ParsedLines> chunks(chunkBegins.size() - 1);
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    if(chunks.size() > 1) {
+        parallelFor(chunks.size(), [&](const std::size_t i) {
+            parseLines(fileBegin, chunkBegins[i], chunkBegins[i + 1], mesh, chunks[i]);
+        });
+    } else
+    #endif
+    {
+        /* Reserve everything upfront using the counts gathered when opening
+           the file */
+        ParsedLines& chunk = chunks.front();
+        chunk.positions.reserve(mesh.positionCount);
+        chunk.textureCoordinates.reserve(mesh.textureCoordinateCount);
+        chunk.normals.reserve(mesh.normalCount);
+        chunk.positionIndices.reserve(mesh.indexCount);
+        if(mesh.textureCoordinateCount) chunk.textureCoordinateIndices.reserve(mesh.indexCount);
+        if(mesh.normalCount) chunk.normalIndices.reserve(mesh.indexCount);
+        parseLines(fileBegin, begin, end, mesh, chunk);
+    }
 
+    /* Check for errors and mixed primitives across the chunks, in the order
+       they would be encountered when parsing sequentially */
     std::optional<MeshPrimitive> primitive;
+    for(const ParsedLines& chunk: chunks) {
+        if(primitive && chunk.primitive && primitive != chunk.primitive && (chunk.error.empty() || chunk.primitiveOffset < chunk.errorOffset)) {
+            Error() << "Trade::ObjImporter::mesh3D(): mixed primitive" << *primitive << "and" << *chunk.primitive;
+            return std::nullopt;
+        }
+
+        if(!chunk.error.empty()) {
+            Error{Debug::Flag::NoNewlineAtTheEnd} << chunk.error;
+            return std::nullopt;
+        }
+
+        if(!primitive) primitive = chunk.primitive;
+    }
+
+    /* Take the data directly if there's just one chunk, otherwise
+       concatenate them */
     std::vector<Vector3> positions;
     std::vector<std::vector<Vector2>> textureCoordinates;
     std::vector<std::vector<Vector3>> normals;
     std::vector<UnsignedInt> positionIndices;
     std::vector<UnsignedInt> textureCoordinateIndices;
     std::vector<UnsignedInt> normalIndices;
-
-    try { while(_file->in->good() && _file->in->tellg() < end) {
-        /* Ignore comments */
-        if(_file->in->peek() == '#') {
-            ignoreLine(*_file->in);
-            continue;
-        }
-
-        /* Get the line */
-        std::string line;
-        std::getline(*_file->in, line);
-        line = Utility::String::trim(line);
-
-        /* Ignore empty lines */
-        if(line.empty()) continue;
-
-        /* Split the line into keyword and contents */
-        const std::size_t keywordEnd = line.find(' ');
-        const std::string keyword = line.substr(0, keywordEnd);
-        const std::string contents = keywordEnd != std::string::npos ?
-            Utility::String::ltrim(line.substr(keywordEnd+1)) : "";
-
-        /* Vertex position */
-        if(keyword == "v") {
-            Float extra{1.0f};
-            const Vector3 data = extractFloatData<3>(contents, &extra);
-            if(!Math::TypeTraits<Float>::equals(extra, 1.0f)) {
-                Error() << "Trade::ObjImporter::mesh3D(): homogeneous coordinates are not supported";
-                return std::nullopt;
-            }
-
-            positions.push_back(data);
-
-        /* Texture coordinate */
-        } else if(keyword == "vt") {
-            Float extra{0.0f};
-            const auto data = extractFloatData<2>(contents, &extra);
-            if(!Math::TypeTraits<Float>::equals(extra, 0.0f)) {
-                Error() << "Trade::ObjImporter::mesh3D(): 3D texture coordinates are not supported";
-                return std::nullopt;
-            }
-
-            if(textureCoordinates.empty()) textureCoordinates.emplace_back();
-            textureCoordinates.front().emplace_back(data);
-
-        /* Normal */
-        } else if(keyword == "vn") {
-            if(normals.empty()) normals.emplace_back();
-            normals.front().emplace_back(extractFloatData<3>(contents));
-
-        /* Indices */
-        } else if(keyword == "p" || keyword == "l" || keyword == "f") {
-            const std::vector<std::string> indexTuples = Utility::String::splitWithoutEmptyParts(contents, ' ');
-
-            /* Points */
-            if(keyword == "p") {
-                /* Check that we don't mix the primitives in one mesh */
-                if(primitive && primitive != MeshPrimitive::Points) {
-                    Error() << "Trade::ObjImporter::mesh3D(): mixed primitive" << *primitive << "and" << MeshPrimitive::Points;
-                    return std::nullopt;
-                }
-
-                /* Check vertex count per primitive */
-                if(indexTuples.size() != 1) {
-                    Error() << "Trade::ObjImporter::mesh3D(): wrong index count for point";
-                    return std::nullopt;
-                }
-
-                primitive = MeshPrimitive::Points;
-
-            /* Lines */
-            } else if(keyword == "l") {
-                /* Check that we don't mix the primitives in one mesh */
-                if(primitive && primitive != MeshPrimitive::Lines) {
-                    Error() << "Trade::ObjImporter::mesh3D(): mixed primitive" << *primitive << "and" << MeshPrimitive::Lines;
-                    return std::nullopt;
-                }
-
-                /* Check vertex count per primitive */
-                if(indexTuples.size() != 2) {
-                    Error() << "Trade::ObjImporter::mesh3D(): wrong index count for line";
-                    return std::nullopt;
-                }
-
-                primitive = MeshPrimitive::Lines;
-
-            /* Faces */
-            } else if(keyword == "f") {
-                /* Check that we don't mix the primitives in one mesh */
-                if(primitive && primitive != MeshPrimitive::Triangles) {
-                    Error() << "Trade::ObjImporter::mesh3D(): mixed primitive" << *primitive << "and" << MeshPrimitive::Triangles;
-                    return std::nullopt;
-                }
-
-                /* Check vertex count per primitive */
-                if(indexTuples.size() < 3) {
-                    Error() << "Trade::ObjImporter::mesh3D(): wrong index count for triangle";
-                    return std::nullopt;
-                } else if(indexTuples.size() != 3) {
-                    Error() << "Trade::ObjImporter::mesh3D(): polygons are not supported";
-                    return std::nullopt;
-                }
-
-                primitive = MeshPrimitive::Triangles;
-
-            } else CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
-
-            for(const std::string& indexTuple: indexTuples) {
-                std::vector<std::string> indices = Utility::String::split(indexTuple, '/');
-                if(indices.size() > 3) {
-                    Error() << "Trade::ObjImporter::mesh3D(): invalid index data";
-                    return std::nullopt;
-                }
-
-                #ifdef CORRADE_TARGET_ANDROID
-                char* end{};
-                #endif
-
-                /* Position indices */
-                positionIndices.push_back(
-                    #ifndef CORRADE_TARGET_ANDROID
-                    std::stoul(indices[0])
-                    #else
-                    std::strtoul(indices[0].data(), &end, 10)
-                    #endif
-                    - positionIndexOffset);
-
-                #ifdef CORRADE_TARGET_ANDROID
-                if(end == indices[0].data()) throw std::exception{};
-                #endif
-
-                /* Texture coordinates */
-                if(indices.size() == 2 || (indices.size() == 3 && !indices[1].empty())) {
-                    textureCoordinateIndices.push_back(
-                        #ifndef CORRADE_TARGET_ANDROID
-                        std::stoul(indices[1])
-                        #else
-                        std::strtoul(indices[1].data(), &end, 10)
-                        #endif
-                        - textureCoordinateIndexOffset);
-
-                    #ifdef CORRADE_TARGET_ANDROID
-                    if(end == indices[1].data()) throw std::exception{};
-                    #endif
-                }
-
-                /* Normal indices */
-                if(indices.size() == 3) {
-                    normalIndices.push_back(
-                        #ifndef CORRADE_TARGET_ANDROID
-                        std::stoul(indices[2])
-                        #else
-                        std::strtoul(indices[2].data(), &end, 10)
-                        #endif
-                        - normalIndexOffset);
-
-                    #ifdef CORRADE_TARGET_ANDROID
-                    if(end == indices[2].data()) throw std::exception{};
-                    #endif
-                }
-            }
-
-        /* Ignore unsupported keywords, error out on unknown keywords */
-        } else if(![&keyword](){
-            /* Using lambda to emulate for-else construct like in Python */
-            for(const std::string expected: {"mtllib", "usemtl", "g", "s"})
-                if(keyword == expected) return true;
-            return false;
-        }()) {
-            Error() << "Trade::ObjImporter::mesh3D(): unknown keyword" << keyword;
-            return std::nullopt;
+    if(chunks.size() == 1) {
+        ParsedLines& chunk = chunks.front();
+        positions = std::move(chunk.positions);
+        positionIndices = std::move(chunk.positionIndices);
+        textureCoordinateIndices = std::move(chunk.textureCoordinateIndices);
+        normalIndices = std::move(chunk.normalIndices);
+        if(!chunk.textureCoordinates.empty())
+            textureCoordinates.push_back(std::move(chunk.textureCoordinates));
+        if(!chunk.normals.empty())
+            normals.push_back(std::move(chunk.normals));
+    } else {
+        /* Prefix sums of the chunk sizes give the offset of each chunk in
+           the concatenated arrays, so the chunks can be copied in parallel */
+        struct Offsets {
+            std::size_t positions, textureCoordinates, normals, positionIndices, textureCoordinateIndices, normalIndices;
+        };
+        std::vector<Offsets> offsets(chunks.size() + 1);
+        for(std::size_t i = 0; i != chunks.size(); ++i) {
+            const ParsedLines& chunk = chunks[i];
+            const Offsets& prev = offsets[i];
+            offsets[i + 1] = {
+                prev.positions + chunk.positions.size(),
+                prev.textureCoordinates + chunk.textureCoordinates.size(),
+                prev.normals + chunk.normals.size(),
+                prev.positionIndices + chunk.positionIndices.size(),
+                prev.textureCoordinateIndices + chunk.textureCoordinateIndices.size(),
+                prev.normalIndices + chunk.normalIndices.size()};
         }
 
-    }} catch(std::exception) {
-        Error() << "Trade::ObjImporter::mesh3D(): error while converting numeric data";
-        return std::nullopt;
-    } catch(...) {
-        /* Error message already printed */
-        return std::nullopt;
+        const Offsets& total = offsets.back();
+        positions.resize(total.positions);
+        positionIndices.resize(total.positionIndices);
+        textureCoordinateIndices.resize(total.textureCoordinateIndices);
+        normalIndices.resize(total.normalIndices);
+        if(total.textureCoordinates)
+            textureCoordinates.emplace_back(total.textureCoordinates);
+        if(total.normals)
+            normals.emplace_back(total.normals);
+
+        const auto copy = [&](const std::size_t i) {
+            const ParsedLines& chunk = chunks[i];
+            copyChunk(chunk.positions, positions, offsets[i].positions);
+            copyChunk(chunk.positionIndices, positionIndices, offsets[i].positionIndices);
+            copyChunk(chunk.textureCoordinateIndices, textureCoordinateIndices, offsets[i].textureCoordinateIndices);
+            copyChunk(chunk.normalIndices, normalIndices, offsets[i].normalIndices);
+            if(total.textureCoordinates)
+                copyChunk(chunk.textureCoordinates, textureCoordinates.front(), offsets[i].textureCoordinates);
+            if(total.normals)
+                copyChunk(chunk.normals, normals.front(), offsets[i].normals);
+        };
+        #ifndef CORRADE_TARGET_EMSCRIPTEN
+        parallelFor(chunks.size(), copy);
+        #else
+        for(std::size_t i = 0; i != chunks.size(); ++i) copy(i);
+        #endif
     }
 
     /* There should be at least indexed position data */
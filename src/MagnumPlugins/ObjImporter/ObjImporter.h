@@ -59,6 +59,16 @@ Supported features:
 Polygons (quads etc.), automatic normal generation and material properties are
 currently not supported.
 
+The file is parsed in-place without any per-line or per-token allocations. On
+Unix @ref openFile() memory-maps the file instead of reading it, data passed
+to @ref openData() are copied once. Opening the file does a quick pass that
+finds mesh boundaries and counts vertices and indices of each mesh, so the
+output arrays are allocated just once in @ref mesh3D(). Together with the
+recorded index offsets of each mesh this serves as a global vertex index ---
+@ref mesh3D() parses only lines of given mesh, regardless of how many meshes
+are in the file. Large meshes are additionally parsed in parallel, see
+@ref setThreadCount().
+
 This plugin is built if `WITH_OBJIMPORTER` is enabled when building Magnum. To
 use dynamic plugin, you need to load `ObjImporter` plugin from
 `MAGNUM_PLUGINS_IMPORTER_DIR`. To use static plugin or use this as a dependency
@@ -76,6 +86,26 @@ class MAGNUM_OBJIMPORTER_EXPORT ObjImporter: public AbstractImporter {
 
         ~ObjImporter();
 
+        /**
+         * @brief Count of threads used for parsing one mesh
+         *
+         * If `0`, the count is `std::thread::hardware_concurrency()`. Default
+         * is `0`.
+         */
+        UnsignedInt threadCount() const { return _threadCount; }
+
+        /**
+         * @brief Set count of threads used for parsing one mesh
+         * @return Reference to self (for method chaining)
+         *
+         * Meshes larger than a megabyte per thread are split into chunks
+         * on line boundaries that are parsed in parallel. The per-chunk
+         * results are then copied in parallel to offsets given by a prefix
+         * sum of the chunk sizes. Set to `1` to parse everything on the
+         * calling thread. Ignored on Emscripten.
+         */
+        ObjImporter& setThreadCount(UnsignedInt count);
+
     private:
         struct File;
 
@@ -94,6 +124,7 @@ class MAGNUM_OBJIMPORTER_EXPORT ObjImporter: public AbstractImporter {
         MAGNUM_OBJIMPORTER_LOCAL void parseMeshNames();
 
         std::unique_ptr<File> _file;
+        UnsignedInt _threadCount;
 };
 
 }}
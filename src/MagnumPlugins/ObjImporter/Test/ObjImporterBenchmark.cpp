@@ -0,0 +1,143 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Test/AllocationCounter.h"
+#include "Magnum/Trade/MeshData3D.h"
+#include "MagnumPlugins/ObjImporter/ObjImporter.h"
+
+namespace Magnum { namespace Trade { namespace Test {
+
+struct ObjImporterBenchmark: TestSuite::Tester {
+    explicit ObjImporterBenchmark();
+
+    void positions();
+    void positionsTextureCoordinatesNormals();
+
+    void allocationsBegin();
+    std::uint64_t allocationsEnd();
+
+    private:
+        std::string _positions, _positionsTextureCoordinatesNormals;
+        std::size_t _allocationCount;
+};
+
+namespace {
+    /* Grid of 256x256 vertices, two triangles for each cell */
+    constexpr Int GridSize = 256;
+
+    std::string grid(const bool textureCoordinatesNormals) {
+        std::ostringstream out;
+        for(Int y = 0; y != GridSize; ++y) for(Int x = 0; x != GridSize; ++x)
+            out << "v " << Float(x)/GridSize << " " << Float(y)/GridSize << " " << Float(x*y % 17)/17.0f << "\n";
+
+        if(textureCoordinatesNormals) {
+            for(Int y = 0; y != GridSize; ++y) for(Int x = 0; x != GridSize; ++x)
+                out << "vt " << Float(x)/GridSize << " " << Float(y)/GridSize << "\n";
+            for(Int y = 0; y != GridSize; ++y) for(Int x = 0; x != GridSize; ++x)
+                out << "vn 0 0 1\n";
+        }
+
+        for(Int y = 0; y != GridSize - 1; ++y) for(Int x = 0; x != GridSize - 1; ++x) {
+            const Int a = y*GridSize + x + 1, b = a + 1, c = a + GridSize, d = c + 1;
+            if(textureCoordinatesNormals) {
+                out << "f " << a << "/" << a << "/" << a << " " << b << "/" << b << "/" << b << " " << d << "/" << d << "/" << d << "\n";
+                out << "f " << a << "/" << a << "/" << a << " " << d << "/" << d << "/" << d << " " << c << "/" << c << "/" << c << "\n";
+            } else {
+                out << "f " << a << " " << b << " " << d << "\n";
+                out << "f " << a << " " << d << " " << c << "\n";
+            }
+        }
+
+        return out.str();
+    }
+
+    std::string description(const std::string& data) {
+        return std::to_string(data.size()/1024) + " kB";
+    }
+}
+
+ObjImporterBenchmark::ObjImporterBenchmark() {
+    addBenchmarks({&ObjImporterBenchmark::positions,
+                   &ObjImporterBenchmark::positionsTextureCoordinatesNormals}, 5);
+
+    addCustomBenchmarks({&ObjImporterBenchmark::positions,
+                         &ObjImporterBenchmark::positionsTextureCoordinatesNormals}, 1,
+        &ObjImporterBenchmark::allocationsBegin,
+        &ObjImporterBenchmark::allocationsEnd,
+        BenchmarkUnits::Count);
+
+    _positions = grid(false);
+    _positionsTextureCoordinatesNormals = grid(true);
+}
+
+void ObjImporterBenchmark::positions() {
+    setTestCaseDescription(description(_positions));
+
+    ObjImporter importer;
+    std::optional<MeshData3D> mesh;
+    CORRADE_BENCHMARK(1) {
+        importer.openData({_positions.data(), _positions.size()});
+        mesh = importer.mesh3D(0);
+    }
+
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->positions(0).size(), GridSize*GridSize);
+    CORRADE_COMPARE(mesh->indices().size(), (GridSize - 1)*(GridSize - 1)*6);
+}
+
+void ObjImporterBenchmark::positionsTextureCoordinatesNormals() {
+    setTestCaseDescription(description(_positionsTextureCoordinatesNormals));
+
+    ObjImporter importer;
+    std::optional<MeshData3D> mesh;
+    CORRADE_BENCHMARK(1) {
+        importer.openData({_positionsTextureCoordinatesNormals.data(), _positionsTextureCoordinatesNormals.size()});
+        mesh = importer.mesh3D(0);
+    }
+
+    CORRADE_VERIFY(mesh);
+    CORRADE_VERIFY(mesh->hasTextureCoords2D());
+    CORRADE_VERIFY(mesh->hasNormals());
+    CORRADE_COMPARE(mesh->positions(0).size(), GridSize*GridSize);
+    CORRADE_COMPARE(mesh->indices().size(), (GridSize - 1)*(GridSize - 1)*6);
+}
+
+void ObjImporterBenchmark::allocationsBegin() {
+    setBenchmarkName("allocations");
+    _allocationCount = Magnum::Test::allocationCount;
+}
+
+std::uint64_t ObjImporterBenchmark::allocationsEnd() {
+    return Magnum::Test::allocationCount - _allocationCount;
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::ObjImporterBenchmark)
@@ -34,6 +34,10 @@
 
 #include "configure.h"
 
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#endif
+
 namespace Magnum { namespace Trade { namespace Test {
 
 struct ObjImporterTest: TestSuite::Tester {
@@ -55,6 +59,13 @@ struct ObjImporterTest: TestSuite::Tester {
     void moreMeshes();
     void unnamedFirstMesh();
 
+    void openData();
+    void openDataWindowsLineEndings();
+    void parallel();
+    void parallelError();
+    void parallelMixedPrimitives();
+    void floatFormats();
+
     void wrongFloat();
     void wrongInteger();
     void unmergedIndexOutOfRange();
@@ -88,6 +99,8 @@ struct ObjImporterTest: TestSuite::Tester {
 
     void unsupportedKeyword();
     void unknownKeyword();
+
+    void concurrent();
 };
 
 ObjImporterTest::ObjImporterTest() {
@@ -107,6 +120,13 @@ ObjImporterTest::ObjImporterTest() {
               &ObjImporterTest::moreMeshes,
               &ObjImporterTest::unnamedFirstMesh,
 
+              &ObjImporterTest::openData,
+              &ObjImporterTest::openDataWindowsLineEndings,
+              &ObjImporterTest::parallel,
+              &ObjImporterTest::parallelError,
+              &ObjImporterTest::parallelMixedPrimitives,
+              &ObjImporterTest::floatFormats,
+
               &ObjImporterTest::wrongFloat,
               &ObjImporterTest::wrongInteger,
               &ObjImporterTest::unmergedIndexOutOfRange,
@@ -138,7 +158,9 @@ ObjImporterTest::ObjImporterTest() {
               &ObjImporterTest::wrongNormalIndexCount,
 
               &ObjImporterTest::unsupportedKeyword,
-              &ObjImporterTest::unknownKeyword});
+              &ObjImporterTest::unknownKeyword,
+
+              &ObjImporterTest::concurrent});
 }
 
 void ObjImporterTest::pointMesh() {
@@ -398,6 +420,161 @@ void ObjImporterTest::unnamedFirstMesh() {
     CORRADE_COMPARE(importer.mesh3DForName("SecondMesh"), 1);
 }
 
+void ObjImporterTest::openData() {
+    /* No trailing newline, tabs as separators */
+    constexpr const char data[] =
+        "o First\n"
+        "v 0.5 2 3\n"
+        "v\t0 1.5\t1\n"
+        "p 2\n"
+        "\n"
+        "o Second\n"
+        "v 2 3 5.5\n"
+        "l 3 3";
+
+    ObjImporter importer;
+    CORRADE_VERIFY(importer.openData({data, sizeof(data) - 1}));
+    CORRADE_COMPARE(importer.mesh3DCount(), 2);
+    CORRADE_COMPARE(importer.mesh3DName(1), "Second");
+
+    const std::optional<MeshData3D> data1 = importer.mesh3D(0);
+    CORRADE_VERIFY(data1);
+    CORRADE_COMPARE(data1->primitive(), MeshPrimitive::Points);
+    CORRADE_COMPARE(data1->positions(0), (std::vector<Vector3>{
+        {0.5f, 2.0f, 3.0f},
+        {0.0f, 1.5f, 1.0f}
+    }));
+    CORRADE_COMPARE(data1->indices(), (std::vector<UnsignedInt>{1}));
+
+    const std::optional<MeshData3D> data2 = importer.mesh3D(1);
+    CORRADE_VERIFY(data2);
+    CORRADE_COMPARE(data2->primitive(), MeshPrimitive::Lines);
+    CORRADE_COMPARE(data2->positions(0), (std::vector<Vector3>{
+        {2.0f, 3.0f, 5.5f}
+    }));
+    CORRADE_COMPARE(data2->indices(), (std::vector<UnsignedInt>{0, 0}));
+}
+
+void ObjImporterTest::openDataWindowsLineEndings() {
+    constexpr const char data[] =
+        "# Comment\r\n"
+        "o Mesh\r\n"
+        "v 1 2 3\r\n"
+        "vn 0 0 1\r\n"
+        "vt 0.5 1\r\n"
+        "f 1/1/1 1/1/1 1/1/1\r\n";
+
+    ObjImporter importer;
+    CORRADE_VERIFY(importer.openData({data, sizeof(data) - 1}));
+    CORRADE_COMPARE(importer.mesh3DCount(), 1);
+    CORRADE_COMPARE(importer.mesh3DName(0), "Mesh");
+
+    const std::optional<MeshData3D> mesh = importer.mesh3D(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(mesh->positions(0), (std::vector<Vector3>{{1.0f, 2.0f, 3.0f}}));
+    CORRADE_COMPARE(mesh->normals(0), (std::vector<Vector3>{{0.0f, 0.0f, 1.0f}}));
+    CORRADE_COMPARE(mesh->textureCoords2D(0), (std::vector<Vector2>{{0.5f, 1.0f}}));
+    CORRADE_COMPARE(mesh->indices(), (std::vector<UnsignedInt>{0, 0, 0}));
+}
+
+namespace {
+
+/* Mesh with vertices and faces interleaved, large enough to be split into
+   four chunks when parsing in parallel. Lines at given position are
+   replaced, faces from given position on are replaced with lines. */
+std::string largeMesh(const std::size_t replaceAt = ~std::size_t{}, const std::string& replacement = {}, const std::size_t linesFrom = ~std::size_t{}) {
+    std::ostringstream out;
+    out << "o Large\n";
+    for(std::size_t i = 0; i != 80000; ++i) {
+        if(i == replaceAt) {
+            out << replacement << "\n";
+            continue;
+        }
+
+        out << "v " << i << " " << i*0.25f << " -" << i*0.5f << "\n"
+            << "vn 0 0 1\n";
+        if(i >= linesFrom) out << "l " << i << "//" << i << " " << i + 1 << "//" << i + 1 << "\n";
+        else if(i >= 2) out << "f " << i - 1 << "//" << i + 1 << " " << i << "//" << i << " " << i + 1 << "//" << i - 1 << "\n";
+    }
+    return out.str();
+}
+
+}
+
+void ObjImporterTest::parallel() {
+    const std::string data = largeMesh();
+    CORRADE_VERIFY(data.size() > 4*1024*1024);
+
+    ObjImporter importer;
+    CORRADE_COMPARE(importer.threadCount(), 0);
+    CORRADE_VERIFY(importer.openData({data.data(), data.size()}));
+
+    importer.setThreadCount(1);
+    const std::optional<MeshData3D> serial = importer.mesh3D(0);
+    CORRADE_VERIFY(serial);
+
+    importer.setThreadCount(4);
+    const std::optional<MeshData3D> parallel = importer.mesh3D(0);
+    CORRADE_VERIFY(parallel);
+
+    CORRADE_COMPARE(parallel->primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(parallel->indices().size(), 79998*3);
+    CORRADE_VERIFY(parallel->indices() == serial->indices());
+    CORRADE_VERIFY(parallel->positions(0) == serial->positions(0));
+    CORRADE_VERIFY(parallel->normals(0) == serial->normals(0));
+}
+
+void ObjImporterTest::parallelError() {
+    /* Error in the last chunk, the previous chunks are fine */
+    const std::string data = largeMesh(75000, "v 1 bleh 2");
+
+    ObjImporter importer;
+    importer.setThreadCount(4);
+    CORRADE_VERIFY(importer.openData({data.data(), data.size()}));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer.mesh3D(0));
+    CORRADE_COMPARE(out.str(), "Trade::ObjImporter::mesh3D(): error while converting numeric data\n");
+}
+
+void ObjImporterTest::parallelMixedPrimitives() {
+    /* Lines in the second half, the error in the last chunk comes after
+       that */
+    const std::string data = largeMesh(79000, "v 1 bleh 2", 40000);
+
+    ObjImporter importer;
+    importer.setThreadCount(4);
+    CORRADE_VERIFY(importer.openData({data.data(), data.size()}));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer.mesh3D(0));
+    CORRADE_COMPARE(out.str(), "Trade::ObjImporter::mesh3D(): mixed primitive MeshPrimitive::Triangles and MeshPrimitive::Lines\n");
+}
+
+void ObjImporterTest::floatFormats() {
+    constexpr const char data[] =
+        "v -1.5 +2 .25\n"
+        "v 3. 1e2 -2.5E-1\n"
+        "v 0.000123456789012345678901 12345678901234567890123 1.5e+3\n"
+        "p 1\n"
+        "p 2\n"
+        "p 3\n";
+
+    ObjImporter importer;
+    CORRADE_VERIFY(importer.openData({data, sizeof(data) - 1}));
+
+    const std::optional<MeshData3D> mesh = importer.mesh3D(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->positions(0), (std::vector<Vector3>{
+        {-1.5f, 2.0f, 0.25f},
+        {3.0f, 100.0f, -0.25f},
+        {0.000123456789f, 1.23456789e22f, 1500.0f}
+    }));
+}
+
 void ObjImporterTest::wrongFloat() {
     ObjImporter importer;
     CORRADE_VERIFY(importer.openFile(Utility::Directory::join(OBJIMPORTER_TEST_DIR, "wrongNumbers.obj")));
@@ -731,6 +908,37 @@ void ObjImporterTest::unknownKeyword() {
     CORRADE_COMPARE(out.str(), "Trade::ObjImporter::mesh3D(): unknown keyword bleh\n");
 }
 
+void ObjImporterTest::concurrent() {
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    /* Each thread has its own importer, all of them opening the same file.
+       Meant to be run under ThreadSanitizer to verify there's no shared
+       state. */
+    enum: std::size_t { ThreadCount = 4, IterationCount = 25 };
+    const std::string filename = Utility::Directory::join(OBJIMPORTER_TEST_DIR, "moreMeshes.obj");
+    std::vector<std::size_t> failures(ThreadCount);
+    std::vector<std::thread> threads;
+    for(std::size_t i = 0; i != ThreadCount; ++i) threads.emplace_back([&filename, &failures, i]() {
+        ObjImporter importer;
+        for(std::size_t j = 0; j != IterationCount; ++j) {
+            if(!importer.openFile(filename) || importer.mesh3DCount() != 3) {
+                ++failures[i];
+                continue;
+            }
+
+            for(UnsignedInt id = 0; id != 3; ++id) {
+                const std::optional<MeshData3D> data = importer.mesh3D(id);
+                if(!data || data->positions(0).size() != (id == 2 ? 3 : 2)) ++failures[i];
+            }
+        }
+    });
+    for(std::thread& thread: threads) thread.join();
+
+    CORRADE_COMPARE(failures, std::vector<std::size_t>(ThreadCount));
+    #else
+    CORRADE_SKIP("Threads are not available on Emscripten.");
+    #endif
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::ObjImporterTest)
@@ -33,8 +33,8 @@
 
 #include "Magnum/Image.h"
 #include "Magnum/PixelFormat.h"
-#include "Magnum/Math/Swizzle.h"
-#include "Magnum/Math/Vector4.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/TextureTools/Implementation/pixelConversion.h"
 #include "MagnumPlugins/TgaImporter/TgaHeader.h"
 
 namespace Magnum { namespace Trade {
@@ -108,15 +108,11 @@ Containers::Array<char> TgaImageConverter::doExportToData(const ImageView2D& ima
             std::copy_n(imageData + y*rowStride, rowSize, data.begin() + sizeof(TgaHeader) + y*rowSize);
     } else std::copy_n(imageData, pixelSize*image.size().product(), data.begin() + sizeof(TgaHeader));
 
-    if(image.format() == PixelFormat::RGB) {
-        auto pixels = reinterpret_cast<Math::Vector3<UnsignedByte>*>(data.begin()+sizeof(TgaHeader));
-        std::transform(pixels, pixels + image.size().product(), pixels,
-            [](Math::Vector3<UnsignedByte> pixel) { return Math::swizzle<'b', 'g', 'r'>(pixel); });
-    } else if(image.format() == PixelFormat::RGBA) {
-        auto pixels = reinterpret_cast<Math::Vector4<UnsignedByte>*>(data.begin()+sizeof(TgaHeader));
-        std::transform(pixels, pixels + image.size().product(), pixels,
-            [](Math::Vector4<UnsignedByte> pixel) { return Math::swizzle<'b', 'g', 'r', 'a'>(pixel); });
-    }
+    char* const pixels = data.begin() + sizeof(TgaHeader);
+    if(image.format() == PixelFormat::RGB)
+        TextureTools::Implementation::bgrSwizzle<3>(pixels, pixels, image.size().product());
+    else if(image.format() == PixelFormat::RGBA)
+        TextureTools::Implementation::bgrSwizzle<4>(pixels, pixels, image.size().product());
 
     return data;
 }
@@ -0,0 +1,163 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Endianness.h>
+
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/Test/AllocationCounter.h"
+#include "Magnum/Trade/ImageData.h"
+#include "MagnumPlugins/TgaImporter/TgaHeader.h"
+#include "MagnumPlugins/TgaImporter/TgaImporter.h"
+
+namespace Magnum { namespace Trade { namespace Test {
+
+struct TgaImporterBenchmark: TestSuite::Tester {
+    explicit TgaImporterBenchmark();
+
+    void uncompressed();
+    void uncompressedOpenMemory();
+    void rle();
+
+    void allocationsBegin();
+    std::uint64_t allocationsEnd();
+
+    private:
+        std::string _uncompressed, _rle;
+        std::size_t _allocationCount;
+};
+
+namespace {
+    constexpr Vector2i Size{2048, 2048};
+
+    std::string header(const UnsignedByte imageType) {
+        TgaHeader header{};
+        header.imageType = imageType;
+        header.width = Utility::Endianness::littleEndian<UnsignedShort>(Size.x());
+        header.height = Utility::Endianness::littleEndian<UnsignedShort>(Size.y());
+        header.bpp = 24;
+        return std::string{reinterpret_cast<const char*>(&header), sizeof(TgaHeader)};
+    }
+
+    std::string description(const std::string& data) {
+        return std::to_string(data.size()/1024) + " kB";
+    }
+}
+
+TgaImporterBenchmark::TgaImporterBenchmark() {
+    addBenchmarks({&TgaImporterBenchmark::uncompressed,
+                   &TgaImporterBenchmark::uncompressedOpenMemory,
+                   &TgaImporterBenchmark::rle}, 10);
+
+    addCustomBenchmarks({&TgaImporterBenchmark::uncompressed,
+                         &TgaImporterBenchmark::uncompressedOpenMemory,
+                         &TgaImporterBenchmark::rle}, 1,
+        &TgaImporterBenchmark::allocationsBegin,
+        &TgaImporterBenchmark::allocationsEnd,
+        BenchmarkUnits::Count);
+
+    /* Uncompressed RGB data with a smooth gradient */
+    _uncompressed = header(2);
+    _uncompressed.reserve(sizeof(TgaHeader) + Size.product()*3);
+    for(Int y = 0; y != Size.y(); ++y) for(Int x = 0; x != Size.x(); ++x) {
+        _uncompressed += char(x);
+        _uncompressed += char(y);
+        _uncompressed += char(x + y);
+    }
+
+    /* RLE data with alternating run-length and raw packets of 64 pixels each,
+       so both code paths of the decoder are exercised equally */
+    _rle = header(10);
+    for(Int y = 0; y != Size.y(); ++y) for(Int x = 0; x != Size.x(); x += 128) {
+        _rle += char(0x80|63);
+        _rle += char(x);
+        _rle += char(y);
+        _rle += char(x + y);
+
+        _rle += char(63);
+        for(Int i = 0; i != 64; ++i) {
+            _rle += char(x + i);
+            _rle += char(y);
+            _rle += char(x + y + i);
+        }
+    }
+}
+
+void TgaImporterBenchmark::uncompressed() {
+    setTestCaseDescription(description(_uncompressed));
+
+    TgaImporter importer;
+    std::optional<ImageData2D> image;
+    CORRADE_BENCHMARK(1) {
+        importer.openData({_uncompressed.data(), _uncompressed.size()});
+        image = importer.image2D(0);
+    }
+
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->size(), Size);
+}
+
+void TgaImporterBenchmark::uncompressedOpenMemory() {
+    setTestCaseDescription(description(_uncompressed));
+
+    TgaImporter importer;
+    std::optional<ImageData2D> image;
+    CORRADE_BENCHMARK(1) {
+        importer.openMemory({_uncompressed.data(), _uncompressed.size()});
+        image = importer.image2D(0);
+    }
+
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->size(), Size);
+}
+
+void TgaImporterBenchmark::rle() {
+    setTestCaseDescription(description(_rle));
+
+    TgaImporter importer;
+    std::optional<ImageData2D> image;
+    CORRADE_BENCHMARK(1) {
+        importer.openData({_rle.data(), _rle.size()});
+        image = importer.image2D(0);
+    }
+
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->size(), Size);
+}
+
+void TgaImporterBenchmark::allocationsBegin() {
+    setBenchmarkName("allocations");
+    _allocationCount = Magnum::Test::allocationCount;
+}
+
+std::uint64_t TgaImporterBenchmark::allocationsEnd() {
+    return Magnum::Test::allocationCount - _allocationCount;
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::TgaImporterBenchmark)
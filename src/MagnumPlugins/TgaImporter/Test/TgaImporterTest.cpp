@@ -24,17 +24,23 @@
 */
 
 #include <sstream>
-#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/Utility/Directory.h>
 
+#include "Magnum/ArrayPool.h"
 #include "Magnum/PixelFormat.h"
+#include "Magnum/TextureTools/Implementation/pixelConversion.h"
 #include "Magnum/Trade/ImageData.h"
 #include "MagnumPlugins/TgaImporter/TgaImporter.h"
 
 #include "configure.h"
 
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#endif
+
 namespace Magnum { namespace Trade { namespace Test {
 
 struct TgaImporterTest: TestSuite::Tester {
@@ -52,7 +58,28 @@ struct TgaImporterTest: TestSuite::Tester {
     void grayscaleBits8();
     void grayscaleBits16();
 
+    void colorBits24Rle();
+    void colorBits32Rle();
+    void grayscaleBits8Rle();
+    void rleTooShort();
+
+    void swizzle3();
+    void swizzle4();
+
+    void openMemoryColor();
+    void openMemoryGrayscale();
+    void pixelDataTooShort();
+
     void useTwice();
+    void arrayPool();
+    void concurrent();
+
+    void benchmarkSwizzle3Scalar();
+    void benchmarkSwizzle3();
+    void benchmarkSwizzle4Scalar();
+    void benchmarkSwizzle4();
+
+    Containers::Array<char> _benchmarkData;
 };
 
 TgaImporterTest::TgaImporterTest() {
@@ -67,7 +94,31 @@ TgaImporterTest::TgaImporterTest() {
               &TgaImporterTest::grayscaleBits8,
               &TgaImporterTest::grayscaleBits16,
 
-              &TgaImporterTest::useTwice});
+              &TgaImporterTest::colorBits24Rle,
+              &TgaImporterTest::colorBits32Rle,
+              &TgaImporterTest::grayscaleBits8Rle,
+              &TgaImporterTest::rleTooShort,
+
+              &TgaImporterTest::swizzle3,
+              &TgaImporterTest::swizzle4,
+
+              &TgaImporterTest::openMemoryColor,
+              &TgaImporterTest::openMemoryGrayscale,
+              &TgaImporterTest::pixelDataTooShort,
+
+              &TgaImporterTest::useTwice,
+              &TgaImporterTest::arrayPool,
+              &TgaImporterTest::concurrent});
+
+    addBenchmarks({&TgaImporterTest::benchmarkSwizzle3Scalar,
+                   &TgaImporterTest::benchmarkSwizzle3,
+                   &TgaImporterTest::benchmarkSwizzle4Scalar,
+                   &TgaImporterTest::benchmarkSwizzle4}, 10);
+
+    /* 256x256 RGBA, enough for RGB as well */
+    _benchmarkData = Containers::Array<char>{256*256*4};
+    for(std::size_t i = 0; i != _benchmarkData.size(); ++i)
+        _benchmarkData[i] = char(i*37);
 }
 
 void TgaImporterTest::openShort() {
@@ -100,7 +151,7 @@ void TgaImporterTest::compressed() {
     std::ostringstream debug;
     Error redirectError{&debug};
     CORRADE_VERIFY(!importer.image2D(0));
-    CORRADE_COMPARE(debug.str(), "Trade::TgaImporter::image2D(): unsupported (compressed?) image type: 9\n");
+    CORRADE_COMPARE(debug.str(), "Trade::TgaImporter::image2D(): unsupported image type: 9\n");
 }
 
 void TgaImporterTest::colorBits16() {
@@ -199,6 +250,203 @@ void TgaImporterTest::grayscaleBits16() {
     CORRADE_COMPARE(debug.str(), "Trade::TgaImporter::image2D(): unsupported grayscale bits-per-pixel: 16\n");
 }
 
+void TgaImporterTest::colorBits24Rle() {
+    TgaImporter importer;
+    const char data[] = {
+        0, 0, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 24, 0,
+        /* Raw packet of three pixels */
+        2, 1, 2, 3, 2, 3, 4, 3, 4, 5,
+        /* Run of two pixels */
+        '\x81', 4, 5, 6,
+        /* Raw packet of one pixel */
+        0, 6, 7, 8
+    };
+    const char pixels[] = {
+        3, 2, 1, 4, 3, 2,
+        5, 4, 3, 6, 5, 4,
+        6, 5, 4, 8, 7, 6
+    };
+    CORRADE_VERIFY(importer.openData(data));
+
+    std::optional<Trade::ImageData2D> image = importer.image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->storage().alignment(), 1);
+    CORRADE_COMPARE(image->format(), PixelFormat::RGB);
+    CORRADE_COMPARE(image->size(), Vector2i(2, 3));
+    CORRADE_COMPARE(image->type(), PixelType::UnsignedByte);
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView(pixels),
+        TestSuite::Compare::Container);
+}
+
+void TgaImporterTest::colorBits32Rle() {
+    TgaImporter importer;
+    const char data[] = {
+        0, 0, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 32, 0,
+        /* Run of four pixels */
+        '\x83', 1, 2, 3, 4,
+        /* Raw packet of two pixels */
+        1, 5, 6, 7, 8, 6, 7, 8, 9
+    };
+    const char pixels[] = {
+        3, 2, 1, 4, 3, 2, 1, 4,
+        3, 2, 1, 4, 3, 2, 1, 4,
+        7, 6, 5, 8, 8, 7, 6, 9
+    };
+    CORRADE_VERIFY(importer.openData(data));
+
+    std::optional<Trade::ImageData2D> image = importer.image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->storage().alignment(), 4);
+    CORRADE_COMPARE(image->format(), PixelFormat::RGBA);
+    CORRADE_COMPARE(image->size(), Vector2i(2, 3));
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView(pixels),
+        TestSuite::Compare::Container);
+}
+
+void TgaImporterTest::grayscaleBits8Rle() {
+    TgaImporter importer;
+    const char data[] = {
+        0, 0, 11, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 8, 0,
+        /* Run of three pixels, raw packet of three pixels */
+        '\x82', 1, 2, 2, 3, 4
+    };
+    const char pixels[] = {
+        1, 1,
+        1, 2,
+        3, 4
+    };
+    CORRADE_VERIFY(importer.openData(data));
+
+    std::optional<Trade::ImageData2D> image = importer.image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->storage().alignment(), 1);
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_COMPARE(image->format(), PixelFormat::Red);
+    #else
+    CORRADE_COMPARE(image->format(), PixelFormat::Luminance);
+    #endif
+    CORRADE_COMPARE(image->size(), Vector2i(2, 3));
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView(pixels),
+        TestSuite::Compare::Container);
+}
+
+void TgaImporterTest::rleTooShort() {
+    TgaImporter importer;
+    const char data[] = {
+        0, 0, 11, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 8, 0,
+        /* Raw packet of four pixels, but only three are present */
+        3, 1, 2, 3
+    };
+    CORRADE_VERIFY(importer.openData(data));
+
+    std::ostringstream debug;
+    Error redirectError{&debug};
+    CORRADE_VERIFY(!importer.image2D(0));
+    CORRADE_COMPARE(debug.str(), "Trade::TgaImporter::image2D(): RLE data too short\n");
+}
+
+void TgaImporterTest::swizzle3() {
+    /* Odd count to test the scalar remainder after the vectorized code */
+    UnsignedByte data[37*3];
+    UnsignedByte expected[37*3];
+    for(std::size_t i = 0; i != 37*3; ++i) data[i] = UnsignedByte(i);
+    for(std::size_t i = 0; i != 37; ++i) {
+        expected[i*3 + 0] = UnsignedByte(i*3 + 2);
+        expected[i*3 + 1] = UnsignedByte(i*3 + 1);
+        expected[i*3 + 2] = UnsignedByte(i*3 + 0);
+    }
+
+    char out[37*3];
+    TextureTools::Implementation::bgrSwizzle<3>(reinterpret_cast<const char*>(data), out, 37);
+    CORRADE_COMPARE_AS(Containers::arrayView(out), Containers::arrayView(reinterpret_cast<const char*>(expected), 37*3),
+        TestSuite::Compare::Container);
+
+    /* In-place */
+    TextureTools::Implementation::bgrSwizzle<3>(reinterpret_cast<const char*>(data), reinterpret_cast<char*>(data), 37);
+    CORRADE_COMPARE_AS(Containers::arrayView(reinterpret_cast<const char*>(data), 37*3), Containers::arrayView(reinterpret_cast<const char*>(expected), 37*3),
+        TestSuite::Compare::Container);
+}
+
+void TgaImporterTest::swizzle4() {
+    UnsignedByte data[37*4];
+    UnsignedByte expected[37*4];
+    for(std::size_t i = 0; i != 37*4; ++i) data[i] = UnsignedByte(i);
+    for(std::size_t i = 0; i != 37; ++i) {
+        expected[i*4 + 0] = UnsignedByte(i*4 + 2);
+        expected[i*4 + 1] = UnsignedByte(i*4 + 1);
+        expected[i*4 + 2] = UnsignedByte(i*4 + 0);
+        expected[i*4 + 3] = UnsignedByte(i*4 + 3);
+    }
+
+    char out[37*4];
+    TextureTools::Implementation::bgrSwizzle<4>(reinterpret_cast<const char*>(data), out, 37);
+    CORRADE_COMPARE_AS(Containers::arrayView(out), Containers::arrayView(reinterpret_cast<const char*>(expected), 37*4),
+        TestSuite::Compare::Container);
+
+    /* In-place */
+    TextureTools::Implementation::bgrSwizzle<4>(reinterpret_cast<const char*>(data), reinterpret_cast<char*>(data), 37);
+    CORRADE_COMPARE_AS(Containers::arrayView(reinterpret_cast<const char*>(data), 37*4), Containers::arrayView(reinterpret_cast<const char*>(expected), 37*4),
+        TestSuite::Compare::Container);
+}
+
+void TgaImporterTest::openMemoryColor() {
+    TgaImporter importer;
+    const char data[] = {
+        0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 24, 0,
+        1, 2, 3, 2, 3, 4,
+        3, 4, 5, 4, 5, 6,
+        5, 6, 7, 6, 7, 8
+    };
+    const char pixels[] = {
+        3, 2, 1, 4, 3, 2,
+        5, 4, 3, 6, 5, 4,
+        7, 6, 5, 8, 7, 6
+    };
+    CORRADE_VERIFY(importer.openMemory(data));
+
+    /* Color data need swizzling, so they are a copy */
+    std::optional<Trade::ImageData2D> image = importer.image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->format(), PixelFormat::RGB);
+    CORRADE_COMPARE(image->size(), Vector2i(2, 3));
+    CORRADE_VERIFY(image->data().data() != data + 18);
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView(pixels),
+        TestSuite::Compare::Container);
+}
+
+void TgaImporterTest::openMemoryGrayscale() {
+    TgaImporter importer;
+    const char data[] = {
+        0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 8, 0,
+        1, 2,
+        3, 4,
+        5, 6
+    };
+    CORRADE_VERIFY(importer.openMemory(data));
+
+    /* Grayscale data reference the memory directly */
+    std::optional<Trade::ImageData2D> image = importer.image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->size(), Vector2i(2, 3));
+    CORRADE_COMPARE(image->data().data(), data + 18);
+    CORRADE_COMPARE(image->data().size(), 6);
+}
+
+void TgaImporterTest::pixelDataTooShort() {
+    TgaImporter importer;
+    const char data[] = {
+        0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 8, 0,
+        1, 2,
+        3, 4
+    };
+    CORRADE_VERIFY(importer.openData(data));
+
+    std::ostringstream debug;
+    Error redirectError{&debug};
+    CORRADE_VERIFY(!importer.image2D(0));
+    CORRADE_COMPARE(debug.str(), "Trade::TgaImporter::image2D(): the file is too short: 22 bytes, expected 24\n");
+}
+
 void TgaImporterTest::useTwice() {
     TgaImporter importer;
     CORRADE_VERIFY(importer.openFile(Utility::Directory::join(TGAIMPORTER_TEST_DIR, "file.tga")));
@@ -215,6 +463,116 @@ void TgaImporterTest::useTwice() {
     }
 }
 
+void TgaImporterTest::arrayPool() {
+    ArrayPool pool;
+    TgaImporter importer;
+    importer.setArrayPool(&pool);
+    CORRADE_COMPARE(importer.arrayPool(), &pool);
+
+    const char data[] = {
+        0, 0, 11, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 8, 0,
+        /* Raw packet of two pixels */
+        1, 1, 2,
+        /* Run of four pixels */
+        '\x83', 3
+    };
+    const char pixels[] = { 1, 2, 3, 3, 3, 3 };
+    CORRADE_VERIFY(importer.openData(data));
+
+    /* The decoded data are allocated from the pool */
+    const char* memory;
+    {
+        std::optional<Trade::ImageData2D> image = importer.image2D(0);
+        CORRADE_VERIFY(image);
+        CORRADE_COMPARE(pool.usedCount(), 1);
+        CORRADE_COMPARE_AS(image->data(), Containers::arrayView(pixels),
+            TestSuite::Compare::Container);
+        memory = image->data().data();
+    }
+    CORRADE_COMPARE(pool.usedCount(), 0);
+    CORRADE_COMPARE(pool.freeCount(), 1);
+
+    /* Second import reuses the same memory */
+    std::optional<Trade::ImageData2D> image = importer.image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->data().data(), memory);
+    CORRADE_COMPARE(pool.freeCount(), 0);
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView(pixels),
+        TestSuite::Compare::Container);
+}
+
+void TgaImporterTest::concurrent() {
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    /* Each thread has its own importer, all of them opening the same file
+       and the same data. Meant to be run under ThreadSanitizer to verify
+       there's no shared state. */
+    enum: std::size_t { ThreadCount = 4, IterationCount = 50 };
+    const std::string filename = Utility::Directory::join(TGAIMPORTER_TEST_DIR, "file.tga");
+    const Containers::Array<char> data = Utility::Directory::read(filename);
+    std::vector<std::size_t> failures(ThreadCount);
+    std::vector<std::thread> threads;
+    for(std::size_t i = 0; i != ThreadCount; ++i) threads.emplace_back([&filename, &data, &failures, i]() {
+        TgaImporter importer;
+        for(std::size_t j = 0; j != IterationCount; ++j) {
+            if(!(j % 2 ? importer.openData(data) : importer.openFile(filename))) {
+                ++failures[i];
+                continue;
+            }
+
+            std::optional<Trade::ImageData2D> image = importer.image2D(0);
+            if(!image || image->size() != Vector2i{2, 3}) ++failures[i];
+        }
+    });
+    for(std::thread& thread: threads) thread.join();
+
+    CORRADE_COMPARE(failures, std::vector<std::size_t>(ThreadCount));
+    #else
+    CORRADE_SKIP("Threads are not available on Emscripten.");
+    #endif
+}
+
+void TgaImporterTest::benchmarkSwizzle3Scalar() {
+    UnsignedByte* const data = reinterpret_cast<UnsignedByte*>(_benchmarkData.data());
+    CORRADE_BENCHMARK(10)
+        TextureTools::Implementation::bgrSwizzleScalar<3>(data, data, 256*256);
+
+    /* To avoid optimizing things out */
+    CORRADE_VERIFY(_benchmarkData[0] || _benchmarkData[2]);
+}
+
+void TgaImporterTest::benchmarkSwizzle3() {
+    if(!TextureTools::Implementation::BgrSwizzleSimd)
+        CORRADE_SKIP("Vectorized swizzle is not available in this build.");
+
+    char* const data = _benchmarkData.data();
+    CORRADE_BENCHMARK(10)
+        TextureTools::Implementation::bgrSwizzle<3>(data, data, 256*256);
+
+    /* To avoid optimizing things out */
+    CORRADE_VERIFY(_benchmarkData[0] || _benchmarkData[2]);
+}
+
+void TgaImporterTest::benchmarkSwizzle4Scalar() {
+    UnsignedByte* const data = reinterpret_cast<UnsignedByte*>(_benchmarkData.data());
+    CORRADE_BENCHMARK(10)
+        TextureTools::Implementation::bgrSwizzleScalar<4>(data, data, 256*256);
+
+    /* To avoid optimizing things out */
+    CORRADE_VERIFY(_benchmarkData[0] || _benchmarkData[2]);
+}
+
+void TgaImporterTest::benchmarkSwizzle4() {
+    if(!TextureTools::Implementation::BgrSwizzleSimd)
+        CORRADE_SKIP("Vectorized swizzle is not available in this build.");
+
+    char* const data = _benchmarkData.data();
+    CORRADE_BENCHMARK(10)
+        TextureTools::Implementation::bgrSwizzle<4>(data, data, 256*256);
+
+    /* To avoid optimizing things out */
+    CORRADE_VERIFY(_benchmarkData[0] || _benchmarkData[2]);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::TgaImporterTest)
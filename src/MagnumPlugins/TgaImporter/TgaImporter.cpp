@@ -32,8 +32,8 @@
 #include <Corrade/Containers/ArrayView.h>
 
 #include "Magnum/PixelFormat.h"
-#include "Magnum/Math/Swizzle.h"
-#include "Magnum/Math/Vector4.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/TextureTools/Implementation/pixelConversion.h"
 #include "Magnum/Trade/ImageData.h"
 #include "MagnumPlugins/TgaImporter/TgaHeader.h"
 
@@ -44,13 +44,47 @@
 
 namespace Magnum { namespace Trade {
 
+namespace {
+
+/* Each packet starts with a byte with the highest bit denoting whether it's a
+   run of a single repeated pixel or a sequence of raw pixels, the rest being
+   the pixel count minus one. Returns false if the input is too short. */
+bool decodeRle(const Containers::ArrayView<const char> in, const Containers::ArrayView<char> out, const std::size_t pixelSize) {
+    std::size_t inOffset = 0, outOffset = 0;
+    while(outOffset < out.size()) {
+        if(inOffset >= in.size()) return false;
+        const UnsignedByte packet = in[inOffset++];
+        const std::size_t count = std::min(std::size_t(packet & 0x7f) + 1, (out.size() - outOffset)/pixelSize);
+
+        /* Run-length packet, repeat the pixel */
+        if(packet & 0x80) {
+            if(inOffset + pixelSize > in.size()) return false;
+            for(std::size_t i = 0; i != count; ++i, outOffset += pixelSize)
+                std::copy_n(in.begin() + inOffset, pixelSize, out.begin() + outOffset);
+            inOffset += pixelSize;
+
+        /* Raw packet, copy the pixels */
+        } else {
+            const std::size_t size = count*pixelSize;
+            if(inOffset + size > in.size()) return false;
+            std::copy_n(in.begin() + inOffset, size, out.begin() + outOffset);
+            inOffset += size;
+            outOffset += size;
+        }
+    }
+
+    return true;
+}
+
+}
+
 TgaImporter::TgaImporter() = default;
 
 TgaImporter::TgaImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
 
 TgaImporter::~TgaImporter() = default;
 
-auto TgaImporter::doFeatures() const -> Features { return Feature::OpenData; }
+auto TgaImporter::doFeatures() const -> Features { return Feature::OpenData|Feature::OpenMemory; }
 
 bool TgaImporter::doIsOpened() const { return _in; }
 
@@ -59,6 +93,12 @@ void TgaImporter::doClose() { _in = nullptr; }
 void TgaImporter::doOpenData(const Containers::ArrayView<const char> data) {
     _in = Containers::Array<char>{data.size()};
     std::copy(data.begin(), data.end(), _in.begin());
+    _borrowed = false;
+}
+
+void TgaImporter::doOpenMemory(const Containers::ArrayView<const char> memory) {
+    _in = nonOwningArray(memory);
+    _borrowed = true;
 }
 
 UnsignedInt TgaImporter::doImage2DCount() const { return 1; }
@@ -83,8 +123,10 @@ std::optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt) {
         return std::nullopt;
     }
 
+    const bool rle = header.imageType == 10 || header.imageType == 11;
+
     /* Color */
-    if(header.imageType == 2) {
+    if(header.imageType == 2 || header.imageType == 10) {
         switch(header.bpp) {
             case 24:
                 format = PixelFormat::RGB;
@@ -98,7 +140,7 @@ std::optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt) {
         }
 
     /* Grayscale */
-    } else if(header.imageType == 3) {
+    } else if(header.imageType == 3 || header.imageType == 11) {
         #if defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
         format = Context::hasCurrent() && Context::current().isExtensionSupported<Extensions::GL::EXT::texture_rg>() ?
             PixelFormat::Red : PixelFormat::Luminance;
@@ -112,28 +154,57 @@ std::optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt) {
             return std::nullopt;
         }
 
-    /* Compressed files */
+    /* Paletted RLE or unknown files */
     } else {
-        Error() << "Trade::TgaImporter::image2D(): unsupported (compressed?) image type:" << header.imageType;
+        Error() << "Trade::TgaImporter::image2D(): unsupported image type:" << header.imageType;
         return std::nullopt;
     }
 
-    Containers::Array<char> data{std::size_t(size.product())*header.bpp/8};
-    std::copy_n(_in + sizeof(TgaHeader), data.size(), data.begin());
+    const std::size_t pixelSize = header.bpp/8;
+    const std::size_t pixelCount = size.product();
+    const std::size_t dataSize = pixelCount*pixelSize;
+    const Containers::ArrayView<const char> in = _in.suffix(sizeof(TgaHeader));
 
     /* Adjust pixel storage if row size is not four byte aligned */
     PixelStorage storage;
-    if((size.x()*header.bpp/8)%4 != 0)
+    if((size.x()*pixelSize)%4 != 0)
         storage.setAlignment(1);
 
-    if(format == PixelFormat::RGB) {
-        auto pixels = reinterpret_cast<Math::Vector3<UnsignedByte>*>(data.data());
-        std::transform(pixels, pixels + size.product(), pixels,
-            [](Math::Vector3<UnsignedByte> pixel) { return Math::swizzle<'b', 'g', 'r'>(pixel); });
-    } else if(format == PixelFormat::RGBA) {
-        auto pixels = reinterpret_cast<Math::Vector4<UnsignedByte>*>(data.data());
-        std::transform(pixels, pixels + size.product(), pixels,
-            [](Math::Vector4<UnsignedByte> pixel) { return Math::swizzle<'b', 'g', 'r', 'a'>(pixel); });
+    Containers::Array<char> data;
+
+    /* RLE-compressed data are decoded into a new allocation */
+    if(rle) {
+        data = allocateData(dataSize);
+        if(!decodeRle(in, data, pixelSize)) {
+            Error() << "Trade::TgaImporter::image2D(): RLE data too short";
+            return std::nullopt;
+        }
+
+    /* Otherwise check that the whole uncompressed data are present */
+    } else if(in.size() < dataSize) {
+        Error() << "Trade::TgaImporter::image2D(): the file is too short:" << _in.size() << "bytes, expected" << sizeof(TgaHeader) + dataSize;
+        return std::nullopt;
+    }
+
+    /* Color data need to be swizzled. Do that directly from the input instead
+       of copying first and swizzling in-place after, RLE data are swizzled
+       in-place. */
+    if(format == PixelFormat::RGB || format == PixelFormat::RGBA) {
+        const char* const input = rle ? data.data() : in.data();
+        if(!rle) data = allocateData(dataSize);
+        if(format == PixelFormat::RGB)
+            TextureTools::Implementation::bgrSwizzle<3>(input, data, pixelCount);
+        else
+            TextureTools::Implementation::bgrSwizzle<4>(input, data, pixelCount);
+
+    /* Uncompressed grayscale data can reference the memory directly if the
+       user guarantees it stays in scope */
+    } else if(!rle) {
+        if(_borrowed) data = nonOwningArray(in.prefix(dataSize));
+        else {
+            data = allocateData(dataSize);
+            std::copy_n(in.begin(), dataSize, data.begin());
+        }
     }
 
     return ImageData2D{storage, format, PixelType::UnsignedByte, size, std::move(data)};
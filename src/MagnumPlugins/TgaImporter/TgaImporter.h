@@ -54,8 +54,9 @@ namespace Magnum { namespace Trade {
 /**
 @brief TGA importer plugin
 
-Supports Truevision TGA (`*.tga`, `*.vda`, `*.icb`, `*.vst`) uncompressed BGR,
-BGRA or grayscale images with 8 bits per channel.
+Supports Truevision TGA (`*.tga`, `*.vda`, `*.icb`, `*.vst`) uncompressed or
+RLE-compressed BGR, BGRA or grayscale images with 8 bits per channel. Paletted
+images are not supported.
 
 This plugin is built if `WITH_TGAIMPORTER` is enabled when building Magnum. To
 use dynamic plugin, you need to load `TgaImporter` plugin from
@@ -73,6 +74,12 @@ to `1` if the data require it.
 In OpenGL ES 2.0, if @extension{EXT,texture_rg} is not supported and in
 WebGL 1.0, grayscale images use @ref PixelFormat::Luminance instead of
 @ref PixelFormat::Red.
+
+The plugin supports @ref Feature::OpenMemory. Grayscale images opened using
+@ref openMemory() are imported without any copy, referencing the memory
+directly. Color images always need a BGR to RGB conversion and thus are
+copied. The conversion is done using SSSE3, NEON or WebAssembly SIMD128
+instructions, if the plugin is compiled with them enabled.
 */
 class MAGNUM_TGAIMPORTER_EXPORT TgaImporter: public AbstractImporter {
     public:
@@ -88,11 +95,13 @@ class MAGNUM_TGAIMPORTER_EXPORT TgaImporter: public AbstractImporter {
         Features MAGNUM_TGAIMPORTER_LOCAL doFeatures() const override;
         bool MAGNUM_TGAIMPORTER_LOCAL doIsOpened() const override;
         void MAGNUM_TGAIMPORTER_LOCAL doOpenData(Containers::ArrayView<const char> data) override;
+        void MAGNUM_TGAIMPORTER_LOCAL doOpenMemory(Containers::ArrayView<const char> memory) override;
         void MAGNUM_TGAIMPORTER_LOCAL doClose() override;
         UnsignedInt MAGNUM_TGAIMPORTER_LOCAL doImage2DCount() const override;
         std::optional<ImageData2D> MAGNUM_TGAIMPORTER_LOCAL doImage2D(UnsignedInt id) override;
 
         Containers::Array<char> _in;
+        bool _borrowed{};
 };
 
 }}
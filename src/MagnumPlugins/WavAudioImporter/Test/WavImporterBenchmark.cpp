@@ -0,0 +1,174 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Endianness.h>
+
+#include "Magnum/Test/AllocationCounter.h"
+#include "MagnumPlugins/WavAudioImporter/WavImporter.h"
+#include "MagnumPlugins/WavAudioImporter/WavHeader.h"
+
+namespace Magnum { namespace Audio { namespace Test {
+
+struct WavImporterBenchmark: TestSuite::Tester {
+    explicit WavImporterBenchmark();
+
+    void stereo16();
+    void stereo16OpenMemory();
+    void stereoFloat();
+
+    void allocationsBegin();
+    std::uint64_t allocationsEnd();
+
+    private:
+        std::string _stereo16, _stereoFloat;
+        std::size_t _allocationCount;
+};
+
+namespace {
+    /* A minute of 44.1 kHz stereo audio */
+    constexpr UnsignedInt SampleRate = 44100;
+    constexpr UnsignedInt FrameCount = SampleRate*60;
+
+    template<class T> std::string wav(const WavAudioFormat audioFormat, T(*sample)(UnsignedInt)) {
+        const UnsignedInt dataSize = FrameCount*2*sizeof(T);
+
+        WavHeaderChunk header;
+        std::copy_n("RIFF", 4, header.chunk.chunkId);
+        header.chunk.chunkSize = Utility::Endianness::littleEndian<UnsignedInt>(sizeof(WavHeaderChunk) - sizeof(RiffChunk) + sizeof(WavFormatChunk) + sizeof(RiffChunk) + dataSize);
+        std::copy_n("WAVE", 4, header.format);
+
+        WavFormatChunk format;
+        std::copy_n("fmt ", 4, format.chunk.chunkId);
+        format.chunk.chunkSize = Utility::Endianness::littleEndian<UnsignedInt>(sizeof(WavFormatChunk) - sizeof(RiffChunk));
+        format.audioFormat = WavAudioFormat(Utility::Endianness::littleEndian(UnsignedShort(audioFormat)));
+        format.numChannels = Utility::Endianness::littleEndian<UnsignedShort>(2);
+        format.sampleRate = Utility::Endianness::littleEndian(SampleRate);
+        format.byteRate = Utility::Endianness::littleEndian<UnsignedInt>(SampleRate*2*sizeof(T));
+        format.blockAlign = Utility::Endianness::littleEndian<UnsignedShort>(2*sizeof(T));
+        format.bitsPerSample = Utility::Endianness::littleEndian<UnsignedShort>(8*sizeof(T));
+
+        RiffChunk data;
+        std::copy_n("data", 4, data.chunkId);
+        data.chunkSize = Utility::Endianness::littleEndian(dataSize);
+
+        std::string out;
+        out.reserve(sizeof(WavHeaderChunk) + sizeof(WavFormatChunk) + sizeof(RiffChunk) + dataSize);
+        out.append(reinterpret_cast<const char*>(&header), sizeof(WavHeaderChunk));
+        out.append(reinterpret_cast<const char*>(&format), sizeof(WavFormatChunk));
+        out.append(reinterpret_cast<const char*>(&data), sizeof(RiffChunk));
+        for(UnsignedInt i = 0; i != FrameCount*2; ++i) {
+            const T value = Utility::Endianness::littleEndian(sample(i));
+            out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        return out;
+    }
+
+    std::string description(const std::string& data) {
+        return std::to_string(data.size()/1024) + " kB";
+    }
+}
+
+WavImporterBenchmark::WavImporterBenchmark() {
+    addBenchmarks({&WavImporterBenchmark::stereo16,
+                   &WavImporterBenchmark::stereo16OpenMemory,
+                   &WavImporterBenchmark::stereoFloat}, 10);
+
+    addCustomBenchmarks({&WavImporterBenchmark::stereo16,
+                         &WavImporterBenchmark::stereo16OpenMemory,
+                         &WavImporterBenchmark::stereoFloat}, 1,
+        &WavImporterBenchmark::allocationsBegin,
+        &WavImporterBenchmark::allocationsEnd,
+        BenchmarkUnits::Count);
+
+    /* Sawtooth waves */
+    _stereo16 = wav<Short>(WavAudioFormat::Pcm, [](UnsignedInt i) {
+        return Short(i*97);
+    });
+    _stereoFloat = wav<Float>(WavAudioFormat::IeeeFloat, [](UnsignedInt i) {
+        return Float(i % 512)/256.0f - 1.0f;
+    });
+}
+
+void WavImporterBenchmark::stereo16() {
+    setTestCaseDescription(description(_stereo16));
+
+    WavImporter importer;
+    Containers::Array<char> data;
+    CORRADE_BENCHMARK(1) {
+        importer.openData({_stereo16.data(), _stereo16.size()});
+        data = importer.data();
+    }
+
+    CORRADE_COMPARE(importer.format(), Buffer::Format::Stereo16);
+    CORRADE_COMPARE(importer.frequency(), SampleRate);
+    CORRADE_COMPARE(data.size(), FrameCount*2*2);
+}
+
+void WavImporterBenchmark::stereo16OpenMemory() {
+    setTestCaseDescription(description(_stereo16));
+
+    WavImporter importer;
+    Containers::Array<char> data;
+    CORRADE_BENCHMARK(1) {
+        importer.openMemory({_stereo16.data(), _stereo16.size()});
+        data = importer.data();
+    }
+
+    CORRADE_COMPARE(importer.format(), Buffer::Format::Stereo16);
+    CORRADE_COMPARE(importer.frequency(), SampleRate);
+    CORRADE_COMPARE(data.size(), FrameCount*2*2);
+}
+
+void WavImporterBenchmark::stereoFloat() {
+    setTestCaseDescription(description(_stereoFloat));
+
+    WavImporter importer;
+    Containers::Array<char> data;
+    CORRADE_BENCHMARK(1) {
+        importer.openData({_stereoFloat.data(), _stereoFloat.size()});
+        data = importer.data();
+    }
+
+    CORRADE_COMPARE(importer.format(), Buffer::Format::StereoFloat);
+    CORRADE_COMPARE(importer.frequency(), SampleRate);
+    CORRADE_COMPARE(data.size(), FrameCount*2*4);
+}
+
+void WavImporterBenchmark::allocationsBegin() {
+    setBenchmarkName("allocations");
+    _allocationCount = Magnum::Test::allocationCount;
+}
+
+std::uint64_t WavImporterBenchmark::allocationsEnd() {
+    return Magnum::Test::allocationCount - _allocationCount;
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Audio::Test::WavImporterBenchmark)
@@ -70,9 +70,19 @@ struct WavImporterTest: TestSuite::Tester {
     void stereo32f();
     void stereo64f();
 
+    void monoImaAdPcm();
+    void stereoImaAdPcm();
+
     void surround51Channel16();
     void surround71Channel24();
 
+    void openMemory();
+
+    void stream();
+    void streamFile();
+    void streamBufferTooSmall();
+    void streamImaAdPcm();
+
     void debugAudioFormat();
 };
 
@@ -107,9 +117,19 @@ WavImporterTest::WavImporterTest() {
               &WavImporterTest::stereo32f,
               &WavImporterTest::stereo64f,
 
+              &WavImporterTest::monoImaAdPcm,
+              &WavImporterTest::stereoImaAdPcm,
+
               &WavImporterTest::surround51Channel16,
               &WavImporterTest::surround71Channel24,
 
+              &WavImporterTest::openMemory,
+
+              &WavImporterTest::stream,
+              &WavImporterTest::streamFile,
+              &WavImporterTest::streamBufferTooSmall,
+              &WavImporterTest::streamImaAdPcm,
+
               &WavImporterTest::debugAudioFormat});
 }
 
@@ -402,6 +422,45 @@ void WavImporterTest::stereo64f() {
         TestSuite::Compare::Container<Containers::ArrayView<const char>>);
 }
 
+void WavImporterTest::monoImaAdPcm() {
+    WavImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "monoImaAdPcm.wav")));
+
+    CORRADE_COMPARE(importer.format(), Buffer::Format::Mono16);
+    CORRADE_COMPARE(importer.frequency(), 22050);
+
+    /* Two full blocks of 505 samples and one partial of 185 samples */
+    const Containers::Array<char> data = importer.data();
+    CORRADE_COMPARE(data.size(), 2390);
+    CORRADE_COMPARE_AS((Containers::ArrayView<const Short>{reinterpret_cast<const Short*>(data.data()), 8}),
+        (Containers::Array<Short>{Containers::InPlaceInit, {
+            0, 11, 41, 104, 240, 533, 1164, 2521}}),
+        TestSuite::Compare::Container<Containers::ArrayView<const Short>>);
+    CORRADE_COMPARE_AS((Containers::ArrayView<const Short>{reinterpret_cast<const Short*>(data.end()) - 4, 4}),
+        (Containers::Array<Short>{Containers::InPlaceInit, {
+            11472, 11812, 11873, 12041}}),
+        TestSuite::Compare::Container<Containers::ArrayView<const Short>>);
+}
+
+void WavImporterTest::stereoImaAdPcm() {
+    WavImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "stereoImaAdPcm.wav")));
+
+    CORRADE_COMPARE(importer.format(), Buffer::Format::Stereo16);
+    CORRADE_COMPARE(importer.frequency(), 44100);
+
+    const Containers::Array<char> data = importer.data();
+    CORRADE_COMPARE(data.size(), 16000);
+    CORRADE_COMPARE_AS((Containers::ArrayView<const Short>{reinterpret_cast<const Short*>(data.data()), 8}),
+        (Containers::Array<Short>{Containers::InPlaceInit, {
+            0, 0, 11, 11, 41, 41, 104, 104}}),
+        TestSuite::Compare::Container<Containers::ArrayView<const Short>>);
+    CORRADE_COMPARE_AS((Containers::ArrayView<const Short>{reinterpret_cast<const Short*>(data.end()) - 4, 4}),
+        (Containers::Array<Short>{Containers::InPlaceInit, {
+            11369, 10587, 11499, 10128}}),
+        TestSuite::Compare::Container<Containers::ArrayView<const Short>>);
+}
+
 void WavImporterTest::surround51Channel16() {
     std::ostringstream out;
     Error redirectError{&out};
@@ -422,6 +481,111 @@ void WavImporterTest::surround71Channel24() {
     CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): unsupported format Audio::WavAudioFormat::Extensible\n");
 }
 
+void WavImporterTest::openMemory() {
+    const Containers::Array<char> memory = Utility::Directory::read(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "mono8.wav"));
+
+    WavImporter importer;
+    CORRADE_VERIFY(importer.openMemory(memory));
+
+    CORRADE_COMPARE(importer.format(), Buffer::Format::Mono8);
+    CORRADE_COMPARE(importer.frequency(), 22050);
+
+    /* The data should reference the memory instead of being a copy */
+    const Containers::Array<char> data = importer.data();
+    CORRADE_COMPARE(data.size(), 2136);
+    CORRADE_VERIFY(data.begin() >= memory.begin());
+    CORRADE_VERIFY(data.end() <= memory.end());
+    CORRADE_COMPARE_AS(data.prefix(4),
+        (Containers::Array<char>{Containers::InPlaceInit, {127, 127, 127, 127}}),
+        TestSuite::Compare::Container<Containers::ArrayView<const char>>);
+}
+
+void WavImporterTest::stream() {
+    const Containers::Array<char> memory = Utility::Directory::read(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "mono32f.wav"));
+
+    WavImporter importer;
+    CORRADE_VERIFY(importer.openData(memory));
+    CORRADE_VERIFY(importer.features() & AbstractImporter::Feature::Streaming);
+    const Containers::Array<char> data = importer.data();
+
+    /* Odd buffer size to verify that only whole frames are written */
+    std::string streamed;
+    char buffer[1001];
+    std::size_t size;
+    while((size = importer.streamData(buffer))) {
+        CORRADE_COMPARE(size % 4, 0);
+        streamed.append(buffer, size);
+    }
+    CORRADE_COMPARE(streamed.size(), data.size());
+    CORRADE_VERIFY(std::equal(data.begin(), data.end(), streamed.begin()));
+
+    /* After reset it starts from the beginning */
+    importer.resetStream();
+    CORRADE_COMPARE(importer.streamData(buffer), 1000);
+    CORRADE_VERIFY(std::equal(buffer, buffer + 1000, data.begin()));
+}
+
+void WavImporterTest::streamFile() {
+    /* This file is big enough to be streamed from the file instead of being
+       read whole */
+    WavImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "stereo64f.wav")));
+    CORRADE_COMPARE(importer.format(), Buffer::Format::StereoDouble);
+    const Containers::Array<char> data = importer.data();
+    CORRADE_COMPARE(data.size(), 375888);
+
+    std::string streamed;
+    char buffer[65536];
+    std::size_t size;
+    while((size = importer.streamData(buffer))) {
+        CORRADE_COMPARE(size % 16, 0);
+        streamed.append(buffer, size);
+
+        /* Accessing the whole data in between doesn't affect the stream */
+        if(streamed.size() == 65536) CORRADE_COMPARE(importer.data().size(), 375888);
+    }
+    CORRADE_COMPARE(streamed.size(), data.size());
+    CORRADE_VERIFY(std::equal(data.begin(), data.end(), streamed.begin()));
+
+    importer.resetStream();
+    CORRADE_COMPARE(importer.streamData(buffer), 65536);
+    CORRADE_VERIFY(std::equal(buffer, buffer + 65536, data.begin()));
+}
+
+void WavImporterTest::streamBufferTooSmall() {
+    WavImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "stereo16.wav")));
+
+    /* Not enough for a single frame */
+    char buffer[3];
+    CORRADE_COMPARE(importer.streamData(buffer), 0);
+}
+
+void WavImporterTest::streamImaAdPcm() {
+    /* This file is big enough to be streamed from the file, the blocks are
+       decoded on the fly */
+    WavImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "stereoImaAdPcm.wav")));
+    const Containers::Array<char> data = importer.data();
+    CORRADE_COMPARE(data.size(), 16000);
+
+    /* Odd buffer size smaller than a decoded block to verify that only whole
+       frames are written and blocks are split correctly */
+    std::string streamed;
+    char buffer[1001];
+    std::size_t size;
+    while((size = importer.streamData(buffer))) {
+        CORRADE_COMPARE(size % 4, 0);
+        streamed.append(buffer, size);
+    }
+    CORRADE_COMPARE(streamed.size(), data.size());
+    CORRADE_VERIFY(std::equal(data.begin(), data.end(), streamed.begin()));
+
+    importer.resetStream();
+    CORRADE_COMPARE(importer.streamData(buffer), 1000);
+    CORRADE_VERIFY(std::equal(buffer, buffer + 1000, data.begin()));
+}
+
 void WavImporterTest::debugAudioFormat() {
     std::ostringstream out;
 
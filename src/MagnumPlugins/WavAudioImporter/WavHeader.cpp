@@ -45,6 +45,7 @@ Debug& operator<<(Debug& debug, const WavAudioFormat value) {
         _c(IeeeFloat)
         _c(ALaw)
         _c(MuLaw)
+        _c(ImaAdPcm)
         _c(Extensible)
         #undef _c
         /* LCOV_EXCL_STOP */
@@ -42,6 +42,7 @@ enum class WavAudioFormat: UnsignedShort {
     IeeeFloat = 0x0003,     /**< IEEE Float */
     ALaw = 0x0006,          /**< A-Law */
     MuLaw = 0x0007,         /**< μ-Law */
+    ImaAdPcm = 0x0011,      /**< IMA ADPCM */
     Extensible = 0xfffe     /**< Extensible */
 };
 
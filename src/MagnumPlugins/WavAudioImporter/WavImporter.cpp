@@ -26,27 +26,139 @@
 
 #include "WavImporter.h"
 
+#include <cstring>
+#include <fstream>
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/Debug.h>
+#include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/Endianness.h>
 
+#include "Magnum/Math/Functions.h"
 #include "MagnumPlugins/WavAudioImporter/WavHeader.h"
 
 namespace Magnum { namespace Audio {
 
+namespace {
+    /* How much of the file is read upfront when streaming from a file. Should
+       be enough to contain everything before the data chunk in all sane
+       files. */
+    constexpr std::size_t StreamHeaderSize = 4096;
+
+    constexpr Int ImaIndexTable[]{-1, -1, -1, -1, 2, 4, 6, 8};
+
+    constexpr Int ImaStepTable[]{
+        7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37,
+        41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173,
+        190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658,
+        724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+        2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484,
+        7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899, 15289, 16818,
+        18500, 20350, 22385, 24623, 27086, 29794, 32767};
+
+    inline Short decodeImaNibble(const UnsignedByte nibble, Int& predictor, Int& index) {
+        const Int step = ImaStepTable[index];
+        Int difference = step >> 3;
+        if(nibble & 1) difference += step >> 2;
+        if(nibble & 2) difference += step >> 1;
+        if(nibble & 4) difference += step;
+        predictor = Math::clamp(nibble & 8 ? predictor - difference : predictor + difference, -32768, 32767);
+        index = Math::clamp(index + ImaIndexTable[nibble & 7], 0, 88);
+        return Short(predictor);
+    }
+
+    /* Each block starts with a four-byte header for each channel, containing
+       the first sample and the step index. It's followed by groups of eight
+       four-bit samples, four bytes for each channel. */
+    UnsignedInt imaAdPcmFrameCount(const std::size_t blockSize, const UnsignedInt channelCount) {
+        const std::size_t groupSize = 4*channelCount;
+        return blockSize < groupSize ? 0 : (blockSize - groupSize)/groupSize*8 + 1;
+    }
+
+    UnsignedInt decodeImaAdPcmBlock(const Containers::ArrayView<const char> block, const UnsignedInt channelCount, Short* const out) {
+        const UnsignedInt frameCount = imaAdPcmFrameCount(block.size(), channelCount);
+        if(!frameCount) return 0;
+
+        const auto* data = reinterpret_cast<const UnsignedByte*>(block.data());
+        const UnsignedInt groupCount = (frameCount - 1)/8;
+        for(UnsignedInt c = 0; c != channelCount; ++c) {
+            const UnsignedByte* header = data + 4*c;
+            Int predictor = Short(header[0]|(header[1] << 8));
+            Int index = Math::min(Int(header[2]), 88);
+            out[c] = Short(predictor);
+
+            for(UnsignedInt g = 0; g != groupCount; ++g) {
+                const UnsignedByte* group = data + 4*channelCount*(g + 1) + 4*c;
+                Short* groupOut = out + (1 + 8*g)*channelCount + c;
+                for(UnsignedInt i = 0; i != 4; ++i) {
+                    groupOut[2*i*channelCount] = decodeImaNibble(group[i] & 0x0f, predictor, index);
+                    groupOut[(2*i + 1)*channelCount] = decodeImaNibble(group[i] >> 4, predictor, index);
+                }
+            }
+        }
+
+        return frameCount;
+    }
+}
+
 WavImporter::WavImporter() = default;
 
 WavImporter::WavImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
 
-auto WavImporter::doFeatures() const -> Features { return Feature::OpenData; }
+WavImporter::~WavImporter() = default;
 
-bool WavImporter::doIsOpened() const { return _data; }
+auto WavImporter::doFeatures() const -> Features { return Feature::OpenData|Feature::OpenMemory|Feature::Streaming; }
+
+bool WavImporter::doIsOpened() const { return _data || _file; }
 
 void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
+    openInternal(data, data.size(), false, false);
+}
+
+void WavImporter::doOpenMemory(Containers::ArrayView<const char> memory) {
+    openInternal(memory, memory.size(), true, false);
+}
+
+void WavImporter::doOpenFile(const std::string& filename) {
+    std::unique_ptr<std::ifstream> file{new std::ifstream{filename, std::ifstream::binary}};
+    if(!*file) {
+        Error() << "Audio::WavImporter::openFile(): cannot open file" << filename;
+        return;
+    }
+
+    file->seekg(0, std::ios::end);
+    const std::size_t fileSize = file->tellg();
+    file->seekg(0, std::ios::beg);
+
+    /* Small files are read whole, as there's no point in streaming them */
+    if(fileSize <= StreamHeaderSize) {
+        doOpenData(Utility::Directory::read(filename));
+        return;
+    }
+
+    /* Read just the beginning of the file. If the data chunk isn't there,
+       fall back to reading the whole file. */
+    Containers::Array<char> header{StreamHeaderSize};
+    file->read(header, header.size());
+    if(!openInternal(header, fileSize, false, true)) {
+        doOpenData(Utility::Directory::read(filename));
+        return;
+    }
+
+    /* Opening succeeded, stream the data from the file */
+    if(_fileDataSize) _file = std::move(file);
+}
+
+bool WavImporter::openInternal(Containers::ArrayView<const char> data, const std::size_t fileSize, const bool borrow, const bool stream) {
+    /* Reset the streaming state. Zero data size in streaming mode means the
+       file failed to open. */
+    _fileDataSize = 0;
+    _streamOffset = 0;
+    _samplesPerBlock = 0;
+
     /* Check file size */
     if(data.size() < sizeof(WavHeaderChunk) + sizeof(WavFormatChunk) + sizeof(RiffChunk)) {
         Error() << "Audio::WavImporter::openData(): the file is too short:" << data.size() << "bytes";
-        return;
+        return true;
     }
 
     /* Get the RIFF/WAV header */
@@ -56,16 +168,16 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
     if(std::strncmp(header.chunk.chunkId, "RIFF", 4) != 0 ||
        std::strncmp(header.format, "WAVE", 4) != 0) {
         Error() << "Audio::WavImporter::openData(): the file signature is invalid";
-        return;
+        return true;
     }
 
     Utility::Endianness::littleEndianInPlace(header.chunk.chunkSize);
 
     /* Check file size */
-    if(header.chunk.chunkSize < 36 || header.chunk.chunkSize + 8 != data.size()) {
+    if(header.chunk.chunkSize < 36 || header.chunk.chunkSize + 8 != fileSize) {
         Error() << "Audio::WavImporter::openData(): the file has improper size, expected"
-                << header.chunk.chunkSize + 8 << "but got" << data.size();
-        return;
+                << header.chunk.chunkSize + 8 << "but got" << fileSize;
+        return true;
     }
 
     const RiffChunk* dataChunk = nullptr;
@@ -77,21 +189,30 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
 
     /* Skip any chunks that aren't the format or data chunk */
     while(headerSize + offset <= header.chunk.chunkSize) {
+        /* When streaming, only the beginning of the file is available. Tell
+           the caller to read all of it if it's not enough. */
+        if(headerSize + offset + sizeof(RiffChunk) > data.size()) {
+            if(stream) return false;
+            break;
+        }
+
         const RiffChunk* currChunk = reinterpret_cast<const RiffChunk*>(data.begin() + headerSize + offset);
         offset += Utility::Endianness::littleEndian(currChunk->chunkSize) + sizeof(RiffChunk);
 
         if(std::strncmp(currChunk->chunkId, "fmt ", 4) == 0) {
             if(formatChunk != nullptr) {
                 Error() << "Audio::WavImporter::openData(): the file contains too many format chunks";
-                return;
+                return true;
             }
 
             formatChunk = reinterpret_cast<const WavFormatChunk*>(currChunk);
+            if(stream && reinterpret_cast<const char*>(formatChunk + 1) > data.end())
+                return false;
 
         } else if(std::strncmp(currChunk->chunkId, "data", 4) == 0) {
             if(dataChunk != nullptr) {
                 Error() << "Audio::WavImporter::openData(): the file contains too many data chunks";
-                return;
+                return true;
             }
 
             dataChunk = currChunk;
@@ -104,13 +225,13 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
     /* Make sure we actually got a format chunk */
     if(formatChunk == nullptr) {
         Error() << "Audio::WavImporter::openData(): the file contains no format chunk";
-        return;
+        return true;
     }
 
     /* Make sure we actually got a data chunk */
     if(dataChunk == nullptr) {
         Error() << "Audio::WavImporter::openData(): the file contains no data chunk";
-        return;
+        return true;
     }
 
     /* Fix endianness on Format chunk */
@@ -134,7 +255,7 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
             Error() << "Audio::WavImporter::openData(): PCM with unsupported channel count"
                     << formatChunk->numChannels << "with" << formatChunk->bitsPerSample
                     << "bits per sample";
-            return;
+            return true;
         }
 
     /* Check IEEE Float format */
@@ -151,7 +272,7 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
             Error() << "Audio::WavImporter::openData(): IEEE with unsupported channel count"
                     << formatChunk->numChannels << "with" << formatChunk->bitsPerSample
                     << "bits per sample";
-            return;
+            return true;
         }
 
     /* Check A-Law format */
@@ -164,7 +285,7 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
             Error() << "Audio::WavImporter::openData(): ALaw with unsupported channel count"
                     << formatChunk->numChannels << "with" << formatChunk->bitsPerSample
                     << "bits per sample";
-            return;
+            return true;
         }
 
     /* Check μ-Law format */
@@ -177,51 +298,180 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
             Error() << "Audio::WavImporter::openData(): MuLaw with unsupported channel count"
                     << formatChunk->numChannels << "with" << formatChunk->bitsPerSample
                     << "bits per sample";
-            return;
+            return true;
+        }
+
+    /* Check IMA ADPCM format, decoded to 16-bit PCM */
+    } else if(formatChunk->audioFormat == WavAudioFormat::ImaAdPcm) {
+        if(formatChunk->numChannels == 1 && formatChunk->bitsPerSample == 4)
+            _format = Buffer::Format::Mono16;
+        else if(formatChunk->numChannels == 2 && formatChunk->bitsPerSample == 4)
+            _format = Buffer::Format::Stereo16;
+        else {
+            Error() << "Audio::WavImporter::openData(): IMA ADPCM with unsupported channel count"
+                    << formatChunk->numChannels << "with" << formatChunk->bitsPerSample
+                    << "bits per sample";
+            return true;
         }
 
     /* Unknown/unimplemented format */
     } else {
         Error() << "Audio::WavImporter::openData(): unsupported format" << formatChunk->audioFormat;
-        return;
+        return true;
     }
 
     /* Size sanity checks */
-    if(headerSize + offset > data.size()) {
+    if(headerSize + offset > fileSize) {
         Error() << "Audio::WavImporter::openData(): file size doesn't match computed size";
-        return;
+        return true;
     }
 
-    /* Format sanity checks */
-    if(formatChunk->blockAlign != formatChunk->numChannels * formatChunk->bitsPerSample / 8 ||
+    /* Format sanity checks. ADPCM blocks consist of a header and whole
+       groups of samples for each channel, byte rate is only an estimate. */
+    if(formatChunk->audioFormat == WavAudioFormat::ImaAdPcm) {
+        const UnsignedInt groupSize = 4*formatChunk->numChannels;
+        if(formatChunk->blockAlign <= groupSize || formatChunk->blockAlign % groupSize) {
+            Error() << "Audio::WavImporter::openData(): the file is corrupted";
+            return true;
+        }
+
+        _channelCount = formatChunk->numChannels;
+        _samplesPerBlock = imaAdPcmFrameCount(formatChunk->blockAlign, _channelCount);
+        _decodedBlock = Containers::Array<Short>(_samplesPerBlock*_channelCount);
+        _decodedBlockIndex = ~std::size_t{};
+        if(stream) _adPcmBlock = Containers::Array<char>(formatChunk->blockAlign);
+
+    } else if(formatChunk->blockAlign != formatChunk->numChannels * formatChunk->bitsPerSample / 8 ||
        formatChunk->byteRate != formatChunk->sampleRate * formatChunk->blockAlign) {
         Error() << "Audio::WavImporter::openData(): the file is corrupted";
-        return;
+        return true;
     }
 
-    /* Save frequency */
+    /* Save frequency and frame size */
     _frequency = formatChunk->sampleRate;
+    _blockAlign = formatChunk->blockAlign;
 
     /** @todo Convert the data from little endian too */
     CORRADE_INTERNAL_ASSERT(!Utility::Endianness::isBigEndian());
 
-    /* Copy the data */
+    /* Reference the data if the user guarantees they stay in scope, copy them
+       otherwise */
     const char* dataChunkPtr = reinterpret_cast<const char*>(dataChunk + 1);
-    _data = Containers::Array<char>(dataChunkSize);
-    std::copy(dataChunkPtr, dataChunkPtr+dataChunkSize, _data.begin());
-    return;
+    if(stream) {
+        /* The data will be read from the file. Empty data chunk is treated
+           as failure by the caller, so read whole file in that case. */
+        if(!dataChunkSize) return false;
+        _fileDataOffset = dataChunkPtr - data.begin();
+        _fileDataSize = dataChunkSize;
+        return true;
+    }
+    if(borrow) _data = nonOwningArray({dataChunkPtr, dataChunkSize});
+    else {
+        _data = Containers::Array<char>(dataChunkSize);
+        std::copy(dataChunkPtr, dataChunkPtr+dataChunkSize, _data.begin());
+    }
+    _borrowed = borrow;
+    return true;
 }
 
-void WavImporter::doClose() { _data = nullptr; }
+void WavImporter::doClose() {
+    _data = nullptr;
+    _file = nullptr;
+}
 
 Buffer::Format WavImporter::doFormat() const { return _format; }
 
 UnsignedInt WavImporter::doFrequency() const { return _frequency; }
 
+Containers::ArrayView<const char> WavImporter::adPcmBlock(const std::size_t block) {
+    const std::size_t dataSize = _file ? _fileDataSize : _data.size();
+    const std::size_t offset = block*_blockAlign;
+    const std::size_t size = std::min(std::size_t(_blockAlign), dataSize - offset);
+
+    if(_file) {
+        _file->clear();
+        _file->seekg(_fileDataOffset + offset);
+        _file->read(_adPcmBlock, size);
+        return _adPcmBlock.prefix(size);
+    }
+
+    return _data.slice(offset, offset + size);
+}
+
+std::size_t WavImporter::adPcmDataSize() const {
+    /* All blocks except the last one are full */
+    const std::size_t dataSize = _file ? _fileDataSize : _data.size();
+    return (dataSize/_blockAlign*_samplesPerBlock + imaAdPcmFrameCount(dataSize%_blockAlign, _channelCount))*2*_channelCount;
+}
+
 Containers::Array<char> WavImporter::doData() {
-    Containers::Array<char> copy(_data.size());
+    /* Decode all ADPCM blocks */
+    if(_samplesPerBlock) {
+        Containers::Array<char> data = allocateData(adPcmDataSize());
+        const std::size_t blockCount = ((_file ? _fileDataSize : _data.size()) + _blockAlign - 1)/_blockAlign;
+        Short* out = reinterpret_cast<Short*>(data.data());
+        for(std::size_t i = 0; i != blockCount; ++i)
+            out += decodeImaAdPcmBlock(adPcmBlock(i), _channelCount, out)*_channelCount;
+        return data;
+    }
+
+    /* Read all data from the file, if streaming from it */
+    if(_file) {
+        Containers::Array<char> data = allocateData(_fileDataSize);
+        _file->clear();
+        _file->seekg(_fileDataOffset);
+        _file->read(data, data.size());
+        return data;
+    }
+
+    /* No need to copy borrowed memory */
+    if(_borrowed) return nonOwningArray(_data);
+
+    Containers::Array<char> copy = allocateData(_data.size());
     std::copy(_data.begin(), _data.end(), copy.begin());
     return copy;
 }
 
+std::size_t WavImporter::doStreamData(const Containers::ArrayView<char> buffer) {
+    /* Decode ADPCM blocks as needed, again writing only whole frames */
+    if(_samplesPerBlock) {
+        const std::size_t frameSize = 2*_channelCount;
+        const std::size_t blockSize = _samplesPerBlock*frameSize;
+        const std::size_t size = std::min(buffer.size()/frameSize*frameSize, adPcmDataSize() - _streamOffset);
+
+        for(std::size_t written = 0; written != size; ) {
+            const std::size_t block = _streamOffset/blockSize;
+            if(block != _decodedBlockIndex) {
+                decodeImaAdPcmBlock(adPcmBlock(block), _channelCount, _decodedBlock);
+                _decodedBlockIndex = block;
+            }
+
+            const std::size_t blockOffset = _streamOffset - block*blockSize;
+            const std::size_t count = std::min(size - written, blockSize - blockOffset);
+            const char* decoded = reinterpret_cast<const char*>(_decodedBlock.data()) + blockOffset;
+            std::copy(decoded, decoded + count, buffer.begin() + written);
+            written += count;
+            _streamOffset += count;
+        }
+
+        return size;
+    }
+
+    /* Write only whole frames */
+    const std::size_t dataSize = _file ? _fileDataSize : _data.size();
+    const std::size_t size = std::min(buffer.size()/_blockAlign*_blockAlign, dataSize - _streamOffset);
+    if(!size) return 0;
+
+    if(_file) {
+        _file->clear();
+        _file->seekg(_fileDataOffset + _streamOffset);
+        _file->read(buffer, size);
+    } else std::copy(_data.begin() + _streamOffset, _data.begin() + _streamOffset + size, buffer.begin());
+
+    _streamOffset += size;
+    return size;
+}
+
+void WavImporter::doResetStream() { _streamOffset = 0; }
+
 }}
@@ -30,6 +30,8 @@
  * @brief Class @ref Magnum::Audio::WavImporter
  */
 
+#include <iosfwd>
+#include <memory>
 #include <Corrade/Containers/Array.h>
 
 #include "Magnum/Audio/AbstractImporter.h"
@@ -62,9 +64,25 @@ Supports mono and stereo files of the following formats:
 -   64-bit IEEE Float, imported as @ref Buffer::Format::MonoDouble / @ref Buffer::Format::StereoDouble
 -   A-Law, imported as @ref Buffer::Format::MonoALaw / @ref Buffer::Format::StereoALaw
 -   μ-Law, imported as @ref Buffer::Format::MonoMuLaw / @ref Buffer::Format::StereoMuLaw
+-   4-bit IMA ADPCM, decoded to @ref Buffer::Format::Mono16 / @ref Buffer::Format::Stereo16
 
 Multi-channel formats are not supported.
 
+IMA ADPCM data are kept compressed in the importer and decoded block by block
+only when requested. Calling @ref data() returns the whole decoded stream,
+which is four times larger than the file. Using @ref streamData(), for example
+through @ref Stream, decodes just the part being played. Combined with
+@ref openMemory() or @ref openFile(), only the compressed data are in memory.
+
+The plugin supports @ref Feature::OpenMemory, in which case the sample data
+are not copied and @ref data() returns an array referencing the memory passed
+to @ref openMemory().
+
+The plugin supports also @ref Feature::Streaming. If the file is opened using
+@ref openFile(), only the header is read upfront and @ref streamData() reads
+the sample data directly from the file, in which case the memory use doesn't
+depend on the file length.
+
 This plugin is built if `WITH_WAVAUDIOIMPORTER` is enabled when building
 Magnum. To use dynamic plugin, you need to load `WavAudioImporter` plugin
 from `MAGNUM_PLUGINS_AUDIOIMPORTER_DIR`. To use static plugin or use this as a
@@ -80,17 +98,40 @@ class MAGNUM_WAVAUDIOIMPORTER_EXPORT WavImporter: public AbstractImporter {
         /** @brief Plugin manager constructor */
         explicit WavImporter(PluginManager::AbstractManager& manager, const std::string& plugin);
 
+        ~WavImporter();
+
     private:
         MAGNUM_WAVAUDIOIMPORTER_LOCAL Features doFeatures() const override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL bool doIsOpened() const override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL void doOpenData(Containers::ArrayView<const char> data) override;
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL void doOpenMemory(Containers::ArrayView<const char> memory) override;
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL void doOpenFile(const std::string& filename) override;
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL bool openInternal(Containers::ArrayView<const char> data, std::size_t fileSize, bool borrow, bool stream);
         MAGNUM_WAVAUDIOIMPORTER_LOCAL void doClose() override;
 
         MAGNUM_WAVAUDIOIMPORTER_LOCAL Buffer::Format doFormat() const override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL UnsignedInt doFrequency() const override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL Containers::Array<char> doData() override;
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL std::size_t doStreamData(Containers::ArrayView<char> buffer) override;
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL void doResetStream() override;
+
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL Containers::ArrayView<const char> adPcmBlock(std::size_t block);
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL std::size_t adPcmDataSize() const;
 
         Containers::Array<char> _data;
+        bool _borrowed{};
+        /* Used instead of _data if streaming directly from a file */
+        std::unique_ptr<std::ifstream> _file;
+        std::size_t _fileDataOffset, _fileDataSize;
+        std::size_t _streamOffset{};
+        UnsignedInt _blockAlign;
+        /* Non-zero if the data are IMA ADPCM to be decoded on the fly. The
+           last decoded block together with its index is cached for
+           streaming into small buffers. */
+        UnsignedInt _samplesPerBlock{}, _channelCount;
+        Containers::Array<char> _adPcmBlock;
+        Containers::Array<Short> _decodedBlock;
+        std::size_t _decodedBlockIndex;
         Buffer::Format _format;
         UnsignedInt _frequency;
 };